@@ -35,10 +35,20 @@
 #include "contour_generator.h"
 #include "segment_merger.h"
 
+#include <algorithm>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "gdal.h"
 #include "gdal_alg.h"
+#include "gdal_thread_pool.h"
 #include "cpl_conv.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_srs_api.h"
 #include "ogr_geometry.h"
@@ -208,6 +218,319 @@ struct GDALRingAppender
     void *data_;
 };
 
+/************************************************************************/
+/*                   Multi-threaded line contouring                     */
+/*                                                                      */
+/*      The raster is split into horizontal strips that are contoured   */
+/*      concurrently, each by its own SegmentMerger. The lines that end */
+/*      on the seam between two strips are then joined, in strip order, */
+/*      by the calling thread, which also does all raster reads and     */
+/*      layer writes.                                                   */
+/************************************************************************/
+
+namespace
+{
+
+struct GDALContourLine
+{
+    double level = 0;
+    marching_squares::LineString ls{};
+};
+
+// Line writer of the SegmentMerger of a strip, which keeps the lines for
+// them to be joined at seams and written by the calling thread.
+struct GDALContourLineCollector
+{
+    std::vector<GDALContourLine> lines{};
+
+    void addLine(double level, marching_squares::LineString &ls,
+                 bool /*closed*/)
+    {
+        lines.push_back(GDALContourLine());
+        lines.back().level = level;
+        lines.back().ls = std::move(ls);
+    }
+};
+
+template <class LevelGenerator> struct GDALContourStripJob
+{
+    LevelGenerator *poLevels = nullptr;
+    size_t nWidth = 0;
+    size_t nHeight = 0;
+    bool bUseNoData = false;
+    double dfNoDataValue = 0;
+    // First line of the strip, and number of lines
+    int nYOff = 0;
+    int nLines = 0;
+    // Line above the strip, if any, followed by the lines of the strip
+    std::vector<double> adfData{};
+    GDALContourLineCollector oCollector{};
+    std::string osError{};
+
+    static void Run(void *pData)
+    {
+        auto psJob = static_cast<GDALContourStripJob *>(pData);
+        try
+        {
+            using namespace marching_squares;
+            SegmentMerger<GDALContourLineCollector, LevelGenerator> merger(
+                psJob->oCollector, *psJob->poLevels, /* polygonize */ false);
+            ContourGenerator<decltype(merger), LevelGenerator> cg(
+                psJob->nWidth, psJob->nHeight, psJob->bUseNoData,
+                psJob->dfNoDataValue, merger, *psJob->poLevels);
+            const double *padfLine = psJob->adfData.data();
+            if (psJob->nYOff > 0)
+            {
+                cg.setStartLine(psJob->nYOff, padfLine);
+                padfLine += psJob->nWidth;
+            }
+            for (int i = 0; i < psJob->nLines; i++, padfLine += psJob->nWidth)
+                cg.feedLine(padfLine);
+        }
+        catch (const std::exception &e)
+        {
+            psJob->osError = e.what();
+        }
+        psJob->adfData.clear();
+        psJob->adfData.shrink_to_fit();
+    }
+};
+
+// Joins lines that end at the same point of a seam, i.e. a horizontal line
+// of pixel centers shared by two strips.
+class GDALContourSeamJoiner
+{
+    const double dfSeamY_;
+    std::list<GDALContourLine> aoLines_{};
+    std::map<std::pair<double, double>, std::list<GDALContourLine>::iterator>
+        oMapEnds_{};
+
+    void index(std::list<GDALContourLine>::iterator it, bool bInsert)
+    {
+        for (const auto &oPoint : {it->ls.front(), it->ls.back()})
+        {
+            if (oPoint.y != dfSeamY_)
+                continue;
+            const auto oKey = std::make_pair(it->level, oPoint.x);
+            if (bInsert)
+                oMapEnds_[oKey] = it;
+            else
+            {
+                auto oIter = oMapEnds_.find(oKey);
+                if (oIter != oMapEnds_.end() && oIter->second == it)
+                    oMapEnds_.erase(oIter);
+            }
+        }
+    }
+
+  public:
+    explicit GDALContourSeamJoiner(double dfSeamY) : dfSeamY_(dfSeamY)
+    {
+    }
+
+    bool touches(const GDALContourLine &oLine) const
+    {
+        return oLine.ls.front().y == dfSeamY_ || oLine.ls.back().y == dfSeamY_;
+    }
+
+    void add(GDALContourLine &&oLineIn)
+    {
+        GDALContourLine oLine(std::move(oLineIn));
+        auto &ls = oLine.ls;
+        while (!(ls.front() == ls.back()))
+        {
+            // Find a line ending where this one ends or starts
+            auto oIter = oMapEnds_.end();
+            bool bBack = true;
+            if (ls.back().y == dfSeamY_)
+                oIter =
+                    oMapEnds_.find(std::make_pair(oLine.level, ls.back().x));
+            if (oIter == oMapEnds_.end() && ls.front().y == dfSeamY_)
+            {
+                bBack = false;
+                oIter =
+                    oMapEnds_.find(std::make_pair(oLine.level, ls.front().x));
+            }
+            if (oIter == oMapEnds_.end())
+                break;
+
+            const marching_squares::Point oPoint =
+                bBack ? ls.back() : ls.front();
+            auto itOther = oIter->second;
+            index(itOther, false);
+            auto &other = itOther->ls;
+            if (bBack)
+            {
+                if (other.front() == oPoint)
+                {
+                    other.pop_front();
+                    ls.splice(ls.end(), other);
+                }
+                else
+                {
+                    other.pop_back();
+                    ls.insert(ls.end(), other.rbegin(), other.rend());
+                }
+            }
+            else
+            {
+                if (other.back() == oPoint)
+                {
+                    other.pop_back();
+                    ls.splice(ls.begin(), other);
+                }
+                else
+                {
+                    other.pop_front();
+                    for (const auto &oOtherPoint : other)
+                        ls.push_front(oOtherPoint);
+                }
+            }
+            aoLines_.erase(itOther);
+        }
+        const bool bClosed = ls.front() == ls.back();
+        aoLines_.push_back(std::move(oLine));
+        if (!bClosed)
+            index(std::prev(aoLines_.end()), true);
+    }
+
+    std::list<GDALContourLine> &lines()
+    {
+        return aoLines_;
+    }
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                     GDALContourGenerateMulti()                       */
+/************************************************************************/
+
+template <class LevelGenerator>
+static bool GDALContourGenerateMulti(GDALRasterBandH hBand, bool useNoData,
+                                     double noDataValue,
+                                     LevelGenerator &levels,
+                                     GDALRingAppender &appender, int nThreads,
+                                     GDALProgressFunc pfnProgress,
+                                     void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hBand);
+    const int nYSize = GDALGetRasterBandYSize(hBand);
+
+    // Strips of at most 32 MB, so that a wave of strips bounds the memory
+    // used by the raster lines and by the lines of the merger.
+    const int nStripLines = std::max(
+        1, std::min((nYSize + nThreads - 1) / nThreads,
+                    static_cast<int>(4 * 1024 * 1024 / nXSize)));
+
+    auto poPool = GDALGetGlobalThreadPool(nThreads);
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+
+    // Lines of the previous strip that end on its bottom seam
+    std::vector<GDALContourLine> aoPending;
+
+    for (int nWaveYOff = 0; nWaveYOff < nYSize;)
+    {
+        if (!pfnProgress(static_cast<double>(nWaveYOff) / nYSize,
+                         "Processing line", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return false;
+        }
+
+        std::vector<std::unique_ptr<GDALContourStripJob<LevelGenerator>>>
+            apoJobs;
+        for (int i = 0; i < nThreads && nWaveYOff < nYSize; i++)
+        {
+            auto poJob =
+                std::unique_ptr<GDALContourStripJob<LevelGenerator>>(
+                    new GDALContourStripJob<LevelGenerator>());
+            poJob->poLevels = &levels;
+            poJob->nWidth = nXSize;
+            poJob->nHeight = nYSize;
+            poJob->bUseNoData = useNoData;
+            poJob->dfNoDataValue = noDataValue;
+            poJob->nYOff = nWaveYOff;
+            poJob->nLines = std::min(nStripLines, nYSize - nWaveYOff);
+            const int nReadYOff = std::max(0, nWaveYOff - 1);
+            const int nReadLines = nWaveYOff + poJob->nLines - nReadYOff;
+            try
+            {
+                poJob->adfData.resize(static_cast<size_t>(nXSize) *
+                                      nReadLines);
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate strip of %d lines", nReadLines);
+                return false;
+            }
+            if (GDALRasterIO(hBand, GF_Read, 0, nReadYOff, nXSize, nReadLines,
+                             poJob->adfData.data(), nXSize, nReadLines,
+                             GDT_Float64, 0, 0) != CE_None)
+            {
+                CPLDebug("CONTOUR", "failed fetch %d %d", nReadYOff, nXSize);
+                return false;
+            }
+            if (poQueue)
+                poQueue->SubmitJob(GDALContourStripJob<LevelGenerator>::Run,
+                                   poJob.get());
+            else
+                GDALContourStripJob<LevelGenerator>::Run(poJob.get());
+            nWaveYOff += poJob->nLines;
+            apoJobs.push_back(std::move(poJob));
+        }
+        if (poQueue)
+            poQueue->WaitCompletion();
+
+        for (auto &poJob : apoJobs)
+        {
+            if (!poJob->osError.empty())
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                         poJob->osError.c_str());
+                return false;
+            }
+
+            // Join the lines of the strip with the ones of the previous
+            // strips at their common seam.
+            GDALContourSeamJoiner oTopSeam(poJob->nYOff - 0.5);
+            for (auto &oLine : aoPending)
+                oTopSeam.add(std::move(oLine));
+            aoPending.clear();
+
+            // Keep the lines ending on the bottom seam for the next strip,
+            // and write the other ones.
+            const bool bHasBottomSeam =
+                poJob->nYOff + poJob->nLines < nYSize;
+            const GDALContourSeamJoiner oBottomSeam(
+                poJob->nYOff + poJob->nLines - 0.5);
+            const auto processLine = [&](GDALContourLine &oLine)
+            {
+                if (bHasBottomSeam && oBottomSeam.touches(oLine))
+                    aoPending.push_back(std::move(oLine));
+                else
+                    appender.addLine(oLine.level, oLine.ls,
+                                     /* closed */ false);
+            };
+            for (auto &oLine : poJob->oCollector.lines)
+            {
+                if (poJob->nYOff > 0 && oTopSeam.touches(oLine))
+                    oTopSeam.add(std::move(oLine));
+                else
+                    processLine(oLine);
+            }
+            for (auto &oLine : oTopSeam.lines())
+                processLine(oLine);
+            poJob.reset();
+        }
+    }
+    CPLAssert(aoPending.empty());
+
+    pfnProgress(1.0, "", pProgressArg);
+    return true;
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                   Additional C Callable Functions                    */
@@ -543,6 +866,14 @@ mode.
  *
  * If YES, contour polygons will be created, rather than polygon lines.
  *
+ *   NUM_THREADS=number_of_threads|ALL_CPUS (GDAL >= 3.9)
+ *
+ * Number of threads used to generate contour lines. Defaults to the
+ * GDAL_NUM_THREADS configuration option, or 1. When greater than 1, the
+ * raster is split into horizontal strips that are contoured concurrently, and
+ * the lines are joined where they cross strips. Lines are then written in a
+ * different order than with a single thread. Ignored if POLYGONIZE=YES.
+ *
  *
  * @return CE_None on success or CE_Failure if an error occurs.
  */
@@ -635,6 +966,12 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
 
     bool polygonize = CPLFetchBool(options, "POLYGONIZE", false);
 
+    opt = CSLFetchNameValue(options, "NUM_THREADS");
+    if (opt == nullptr)
+        opt = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(opt, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(opt)));
+
     using namespace marching_squares;
 
     OGRContourWriterInfo oCWI;
@@ -704,32 +1041,60 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
             {
                 FixedLevelRangeIterator levels(&fixedLevels[0],
                                                fixedLevels.size());
-                SegmentMerger<GDALRingAppender, FixedLevelRangeIterator> writer(
-                    appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           FixedLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                if (nThreads > 1)
+                {
+                    ok = GDALContourGenerateMulti(
+                        hBand, useNoData, noDataValue, levels, appender,
+                        nThreads, pfnProgress, pProgressArg);
+                }
+                else
+                {
+                    SegmentMerger<GDALRingAppender, FixedLevelRangeIterator>
+                        writer(appender, levels, /* polygonize */ false);
+                    ContourGeneratorFromRaster<decltype(writer),
+                                               FixedLevelRangeIterator>
+                        cg(hBand, useNoData, noDataValue, writer, levels);
+                    ok = cg.process(pfnProgress, pProgressArg);
+                }
             }
             else if (expBase > 0.0)
             {
                 ExponentialLevelRangeIterator levels(expBase);
-                SegmentMerger<GDALRingAppender, ExponentialLevelRangeIterator>
-                    writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           ExponentialLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                if (nThreads > 1)
+                {
+                    ok = GDALContourGenerateMulti(
+                        hBand, useNoData, noDataValue, levels, appender,
+                        nThreads, pfnProgress, pProgressArg);
+                }
+                else
+                {
+                    SegmentMerger<GDALRingAppender,
+                                  ExponentialLevelRangeIterator>
+                        writer(appender, levels, /* polygonize */ false);
+                    ContourGeneratorFromRaster<decltype(writer),
+                                               ExponentialLevelRangeIterator>
+                        cg(hBand, useNoData, noDataValue, writer, levels);
+                    ok = cg.process(pfnProgress, pProgressArg);
+                }
             }
             else
             {
                 IntervalLevelRangeIterator levels(contourBase, contourInterval);
-                SegmentMerger<GDALRingAppender, IntervalLevelRangeIterator>
-                    writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           IntervalLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                if (nThreads > 1)
+                {
+                    ok = GDALContourGenerateMulti(
+                        hBand, useNoData, noDataValue, levels, appender,
+                        nThreads, pfnProgress, pProgressArg);
+                }
+                else
+                {
+                    SegmentMerger<GDALRingAppender, IntervalLevelRangeIterator>
+                        writer(appender, levels, /* polygonize */ false);
+                    ContourGeneratorFromRaster<decltype(writer),
+                                               IntervalLevelRangeIterator>
+                        cg(hBand, useNoData, noDataValue, writer, levels);
+                    ok = cg.process(pfnProgress, pProgressArg);
+                }
             }
         }
     }
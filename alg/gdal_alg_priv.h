@@ -197,6 +197,16 @@ bool GDALTransformIsTranslationOnPixelBoundaries(
 bool GDALTransformIsAffineNoRotation(GDALTransformerFunc pfnTransformer,
                                      void *pTransformerArg);
 
+struct GDALWarpPreparedCutline;
+
+GDALWarpPreparedCutline *GDALWarpPrepareCutline(OGRGeometryH hCutline);
+void GDALWarpDestroyPreparedCutline(GDALWarpPreparedCutline *psPrepared);
+CPLErr GDALWarpCutlineMaskerPrepared(
+    GDALWarpPreparedCutline *psPrepared, void *pMaskFuncArg, int nBandCount,
+    GDALDataType eType, int nXOff, int nYOff, int nXSize, int nYSize,
+    GByte **ppImageData, int bMaskIsFloat, void *pValidityMask,
+    int *pnValidityFlag);
+
 typedef struct _CPLQuadTree CPLQuadTree;
 
 typedef struct
@@ -249,6 +259,9 @@ typedef struct
 
     char **papszGeolocationInfo;
 
+    // Directory where backmaps are cached, or nullptr.
+    char *pszBackMapCacheDir;
+
 } GDALGeoLocTransformInfo;
 
 /************************************************************************/
@@ -27,6 +27,12 @@
 
 #include "gdal_simplesurf.h"
 
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
+
+#include <algorithm>
+#include <vector>
+
 /************************************************************************/
 /* ==================================================================== */
 /*                          GDALIntegralImage                           */
@@ -253,11 +259,45 @@ GDALOctaveMap::GDALOctaveMap(int nOctaveStartIn, int nOctaveEndIn)
             pMap[oct - 1][i - 1] = new GDALOctaveLayer(oct, i);
 }
 
+namespace
+{
+struct GDALOctaveLayerJob
+{
+    GDALOctaveLayer *poLayer = nullptr;
+    GDALIntegralImage *poImg = nullptr;
+};
+}  // namespace
+
+static void GDALOctaveLayerJobFunc(void *pData)
+{
+    auto psJob = static_cast<GDALOctaveLayerJob *>(pData);
+    psJob->poLayer->ComputeLayer(psJob->poImg);
+}
+
 void GDALOctaveMap::ComputeMap(GDALIntegralImage *poImg)
 {
+    // Octave layers only read the integral image and can be computed in
+    // parallel.
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads =
+        std::max(1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                                      ? CPLGetNumCPUs()
+                                      : atoi(pszNumThreads)));
+    auto poPool = nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+
+    std::vector<GDALOctaveLayerJob> asJobs;
     for (int oct = octaveStart; oct <= octaveEnd; oct++)
         for (int i = 1; i <= INTERVALS; i++)
-            pMap[oct - 1][i - 1]->ComputeLayer(poImg);
+            asJobs.push_back({pMap[oct - 1][i - 1], poImg});
+
+    for (auto &sJob : asJobs)
+    {
+        if (!poQueue || !poQueue->SubmitJob(GDALOctaveLayerJobFunc, &sJob))
+            GDALOctaveLayerJobFunc(&sJob);
+    }
+    if (poQueue)
+        poQueue->WaitCompletion();
 }
 
 bool GDALOctaveMap::PointIsExtremum(int row, int col, GDALOctaveLayer *bot,
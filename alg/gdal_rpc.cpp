@@ -36,8 +36,12 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -236,6 +240,18 @@ typedef enum
     /*! Cubic Convolution Approximation (4x4 kernel) */ DRA_Cubic = 2
 } DEMResampleAlg;
 
+// Cache of DEM blocks. It is shared, with a reference count, by a transformer
+// and the transformers created from it by GDALCreateSimilarRPCTransformer(),
+// typically one per warping thread, which only read the DEM blocks missing
+// from it through their own DEM dataset.
+struct GDALRPCDEMCache
+{
+    // the key is (nYBlock << 32) | nXBlock)
+    lru11::Cache<uint64_t, std::shared_ptr<std::vector<double>>, std::mutex>
+        oCache{256};
+    std::atomic<int> nRefCount{1};
+};
+
 typedef struct
 {
 
@@ -264,8 +280,7 @@ typedef struct
     int bApplyDEMVDatumShift;
 
     GDALDataset *poDS;
-    // the key is (nYBlock << 32) | nXBlock)
-    lru11::Cache<uint64_t, std::shared_ptr<std::vector<double>>> *poCacheDEM;
+    GDALRPCDEMCache *poCacheDEM;
 
     OGRCoordinateTransformation *poCT;
 
@@ -540,6 +555,17 @@ static void *GDALCreateSimilarRPCTransformer(void *hTransformArg,
             &sRPC, psInfo->bReversed, psInfo->dfPixErrThreshold, papszOptions));
     CSLDestroy(papszOptions);
 
+    // Share the cache of DEM blocks, which does not depend on the RPC
+    // coefficients.
+    if (psNewInfo != nullptr && psNewInfo->poDS != nullptr)
+    {
+        if (psInfo->poCacheDEM == nullptr)
+            psInfo->poCacheDEM = new GDALRPCDEMCache();
+        delete psNewInfo->poCacheDEM;
+        psNewInfo->poCacheDEM = psInfo->poCacheDEM;
+        ++psNewInfo->poCacheDEM->nRefCount;
+    }
+
     return psNewInfo;
 }
 
@@ -1106,7 +1132,8 @@ void GDALDestroyRPCTransformer(void *pTransformAlg)
 
     if (psTransform->poDS)
         GDALClose(psTransform->poDS);
-    delete psTransform->poCacheDEM;
+    if (psTransform->poCacheDEM && --psTransform->poCacheDEM->nRefCount == 0)
+        delete psTransform->poCacheDEM;
     if (psTransform->poCT)
         OCTDestroyCoordinateTransformation(
             reinterpret_cast<OGRCoordinateTransformationH>(psTransform->poCT));
@@ -1123,10 +1150,14 @@ void GDALDestroyRPCTransformer(void *pTransformAlg)
 /*                      RPCInverseTransformPoint()                      */
 /************************************************************************/
 
+// If padfInitialGuess is not null, the iterations start from the (pixel, line,
+// long, lat) point it points to, typically the result for a neighbouring
+// point, rather than from the reference point of the transformer.
 static bool RPCInverseTransformPoint(GDALRPCTransformInfo *psTransform,
                                      double dfPixel, double dfLine,
                                      double dfUserHeight, double *pdfLong,
-                                     double *pdfLat)
+                                     double *pdfLat,
+                                     const double *padfInitialGuess = nullptr)
 
 {
     // Memo:
@@ -1135,7 +1166,8 @@ static bool RPCInverseTransformPoint(GDALRPCTransformInfo *psTransform,
 
     /* -------------------------------------------------------------------- */
     /*      Compute an initial approximation based on linear                */
-    /*      interpolation from our reference point.                         */
+    /*      interpolation from our reference point, or from the provided    */
+    /*      initial guess.                                                  */
     /* -------------------------------------------------------------------- */
     double dfResultX = psTransform->adfPLToLatLongGeoTransform[0] +
                        psTransform->adfPLToLatLongGeoTransform[1] * dfPixel +
@@ -1145,6 +1177,18 @@ static bool RPCInverseTransformPoint(GDALRPCTransformInfo *psTransform,
                        psTransform->adfPLToLatLongGeoTransform[4] * dfPixel +
                        psTransform->adfPLToLatLongGeoTransform[5] * dfLine;
 
+    if (padfInitialGuess)
+    {
+        const double dfDeltaPixel = dfPixel - padfInitialGuess[0];
+        const double dfDeltaLine = dfLine - padfInitialGuess[1];
+        dfResultX = padfInitialGuess[2] +
+                    psTransform->adfPLToLatLongGeoTransform[1] * dfDeltaPixel +
+                    psTransform->adfPLToLatLongGeoTransform[2] * dfDeltaLine;
+        dfResultY = padfInitialGuess[3] +
+                    psTransform->adfPLToLatLongGeoTransform[4] * dfDeltaPixel +
+                    psTransform->adfPLToLatLongGeoTransform[5] * dfDeltaLine;
+    }
+
     if (psTransform->bRPCInverseVerbose)
     {
         CPLDebug("RPC", "Computing inverse transform for (pixel,line)=(%f,%f)",
@@ -1397,8 +1441,8 @@ static bool GDALRPCExtractDEMWindow(GDALRPCTransformInfo *psTransform, int nX,
     // Request the DEM by blocks of BLOCK_SIZE * BLOCK_SIZE and put them
     // in poCacheDEM
     if (psTransform->poCacheDEM == nullptr)
-        psTransform->poCacheDEM =
-            new lru11::Cache<uint64_t, std::shared_ptr<std::vector<double>>>();
+        psTransform->poCacheDEM = new GDALRPCDEMCache();
+    auto &oCacheDEM = psTransform->poCacheDEM->oCache;
 
     const int nXIters = (nX + nWidth - 1) / BLOCK_SIZE - nX / BLOCK_SIZE + 1;
     const int nYIters = (nY + nHeight - 1) / BLOCK_SIZE - nY / BLOCK_SIZE + 1;
@@ -1445,7 +1489,7 @@ static bool GDALRPCExtractDEMWindow(GDALRPCTransformInfo *psTransform, int nX,
 #endif
 
             std::shared_ptr<std::vector<double>> poValue;
-            if (!psTransform->poCacheDEM->tryGet(nKey, poValue))
+            if (!oCacheDEM.tryGet(nKey, poValue))
             {
                 poValue = std::make_shared<std::vector<double>>(nReqXSize *
                                                                 nReqYSize);
@@ -1457,7 +1501,7 @@ static bool GDALRPCExtractDEMWindow(GDALRPCTransformInfo *psTransform, int nX,
                 {
                     return false;
                 }
-                psTransform->poCacheDEM->insert(nKey, poValue);
+                oCacheDEM.insert(nKey, poValue);
             }
 
             // Compose the cached block to the final buffer
@@ -1660,7 +1704,7 @@ static bool RPCIsValidLongLat(const GDALRPCTransformInfo *psTransform,
 /************************************************************************/
 
 static int
-GDALRPCTransformWholeLineWithDEM(const GDALRPCTransformInfo *psTransform,
+GDALRPCTransformWholeLineWithDEM(GDALRPCTransformInfo *psTransform,
                                  int nPointCount, double *padfX, double *padfY,
                                  double *padfZ, int *panSuccess, int nXLeft,
                                  int nXWidth, int nYTop, int nYHeight)
@@ -1673,10 +1717,8 @@ GDALRPCTransformWholeLineWithDEM(const GDALRPCTransformInfo *psTransform,
             panSuccess[i] = FALSE;
         return FALSE;
     }
-    CPLErr eErr = psTransform->poDS->GetRasterBand(1)->RasterIO(
-        GF_Read, nXLeft, nYTop, nXWidth, nYHeight, padfDEMBuffer, nXWidth,
-        nYHeight, GDT_Float64, 0, 0, nullptr);
-    if (eErr != CE_None)
+    if (!GDALRPCExtractDEMWindow(psTransform, nXLeft, nYTop, nXWidth, nYHeight,
+                                 padfDEMBuffer))
     {
         for (int i = 0; i < nPointCount; i++)
             panSuccess[i] = FALSE;
@@ -2184,14 +2226,29 @@ int GDALRPCTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
     /* -------------------------------------------------------------------- */
     /*      Compute the inverse (pixel/line/height to lat/long).  This      */
     /*      function uses an iterative method from an initial linear        */
-    /*      approximation.                                                  */
+    /*      approximation.  Consecutive points being generally close to     */
+    /*      each other, the result of the previous point, when it has the   */
+    /*      same height, is used as the starting point, which saves         */
+    /*      iterations.  If that does not converge, we retry from the       */
+    /*      reference point.                                                */
     /* -------------------------------------------------------------------- */
+    // (pixel, line, long, lat) of the previous point
+    double adfPrevious[4] = {0, 0, 0, 0};
+    bool bPreviousValid = false;
+    double dfPreviousZ = 0;
     for (int i = 0; i < nPointCount; i++)
     {
         double dfResultX = 0.0;
         double dfResultY = 0.0;
 
-        if (!RPCInverseTransformPoint(psTransform, padfX[i], padfY[i], padfZ[i],
+        const double dfPixel = padfX[i];
+        const double dfLine = padfY[i];
+        const bool bUsePrevious = bPreviousValid && padfZ[i] == dfPreviousZ;
+        bPreviousValid = false;
+        if (!(bUsePrevious &&
+              RPCInverseTransformPoint(psTransform, dfPixel, dfLine, padfZ[i],
+                                       &dfResultX, &dfResultY, adfPrevious)) &&
+            !RPCInverseTransformPoint(psTransform, dfPixel, dfLine, padfZ[i],
                                       &dfResultX, &dfResultY))
         {
             panSuccess[i] = FALSE;
@@ -2211,6 +2268,13 @@ int GDALRPCTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
         padfY[i] = dfResultY;
 
         panSuccess[i] = TRUE;
+
+        adfPrevious[0] = dfPixel;
+        adfPrevious[1] = dfLine;
+        adfPrevious[2] = dfResultX;
+        adfPrevious[3] = dfResultY;
+        dfPreviousZ = padfZ[i];
+        bPreviousValid = true;
     }
 
     return TRUE;
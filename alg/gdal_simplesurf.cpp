@@ -27,7 +27,11 @@
 
 #include "gdal_simplesurf.h"
 
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
+
 #include <algorithm>
+#include <limits>
 
 /************************************************************************/
 /* ==================================================================== */
@@ -227,6 +231,21 @@ CPLErr GDALSimpleSURF::ConvertRGBToLuminosity(GDALRasterBand *red,
     return eErr;
 }
 
+namespace
+{
+// Search of the feature points of the middle layer of three consecutive
+// layers of an octave.
+struct GDALSimpleSURFExtractJob
+{
+    GDALOctaveLayer *bot = nullptr;
+    GDALOctaveLayer *mid = nullptr;
+    GDALOctaveLayer *top = nullptr;
+    GDALIntegralImage *poImg = nullptr;
+    double dfThreshold = 0;
+    std::vector<GDALFeaturePoint> aoPoints{};
+};
+}  // namespace
+
 std::vector<GDALFeaturePoint> *
 GDALSimpleSURF::ExtractFeaturePoints(GDALIntegralImage *poImg,
                                      double dfThreshold)
@@ -237,30 +256,64 @@ GDALSimpleSURF::ExtractFeaturePoints(GDALIntegralImage *poImg,
     // Calc Hessian values for layers.
     poOctMap->ComputeMap(poImg);
 
-    // Search for extremum points.
+    // Search for extremum points, in parallel for each interval of each
+    // octave. Points are collected in the same order as sequentially.
+    std::vector<GDALSimpleSURFExtractJob> asJobs;
     for (int oct = octaveStart; oct <= octaveEnd; oct++)
     {
         for (int k = 0; k < GDALOctaveMap::INTERVALS - 2; k++)
         {
-            GDALOctaveLayer *bot = poOctMap->pMap[oct - 1][k];
-            GDALOctaveLayer *mid = poOctMap->pMap[oct - 1][k + 1];
-            GDALOctaveLayer *top = poOctMap->pMap[oct - 1][k + 2];
+            GDALSimpleSURFExtractJob sJob;
+            sJob.bot = poOctMap->pMap[oct - 1][k];
+            sJob.mid = poOctMap->pMap[oct - 1][k + 1];
+            sJob.top = poOctMap->pMap[oct - 1][k + 2];
+            sJob.poImg = poImg;
+            sJob.dfThreshold = dfThreshold;
+            asJobs.push_back(std::move(sJob));
+        }
+    }
+
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads =
+        std::max(1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                                      ? CPLGetNumCPUs()
+                                      : atoi(pszNumThreads)));
+    auto poPool = nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
 
-            for (int i = 0; i < mid->height; i++)
+    const auto JobFunc = [](void *pData)
+    {
+        auto psJob = static_cast<GDALSimpleSURFExtractJob *>(pData);
+        const GDALOctaveLayer *mid = psJob->mid;
+        for (int i = 0; i < mid->height; i++)
+        {
+            for (int j = 0; j < mid->width; j++)
             {
-                for (int j = 0; j < mid->width; j++)
+                if (GDALOctaveMap::PointIsExtremum(i, j, psJob->bot,
+                                                   psJob->mid, psJob->top,
+                                                   psJob->dfThreshold))
                 {
-                    if (poOctMap->PointIsExtremum(i, j, bot, mid, top,
-                                                  dfThreshold))
-                    {
-                        GDALFeaturePoint oFP(j, i, mid->scale, mid->radius,
-                                             mid->signs[i][j]);
-                        SetDescriptor(&oFP, poImg);
-                        poCollection->push_back(oFP);
-                    }
+                    GDALFeaturePoint oFP(j, i, mid->scale, mid->radius,
+                                         mid->signs[i][j]);
+                    SetDescriptor(&oFP, psJob->poImg);
+                    psJob->aoPoints.push_back(oFP);
                 }
             }
         }
+    };
+
+    for (auto &sJob : asJobs)
+    {
+        if (!poQueue || !poQueue->SubmitJob(JobFunc, &sJob))
+            JobFunc(&sJob);
+    }
+    if (poQueue)
+        poQueue->WaitCompletion();
+
+    for (auto &sJob : asJobs)
+    {
+        poCollection->insert(poCollection->end(), sJob.aoPoints.begin(),
+                             sJob.aoPoints.end());
     }
 
     return poCollection;
@@ -424,8 +477,24 @@ CPLErr GDALSimpleSURF::MatchFeaturePoints(
     for (int i = 0; i < len_2; i++)
         alreadyMatched[i] = false;
 
+    // Contiguous copy of the descriptors of the 2nd collection, for a faster
+    // scan.
+    constexpr int DESC_SIZE = GDALFeaturePoint::DESC_SIZE;
+    std::vector<double> adfDescriptors_2(static_cast<size_t>(len_2) *
+                                         DESC_SIZE);
+    for (int j = 0; j < len_2; j++)
+    {
+        for (int k = 0; k < DESC_SIZE; k++)
+            adfDescriptors_2[static_cast<size_t>(j) * DESC_SIZE + k] =
+                p_2->at(j)[k];
+    }
+
+    double adfDescriptor_1[DESC_SIZE];
     for (int i = 0; i < len_1; i++)
     {
+        for (int k = 0; k < DESC_SIZE; k++)
+            adfDescriptor_1[k] = p_1->at(i)[k];
+
         // Distance to the nearest point.
         double bestDist = -1;
         // Index of the nearest point in p_2 collection.
@@ -434,14 +503,39 @@ CPLErr GDALSimpleSURF::MatchFeaturePoints(
         // Distance to the 2nd nearest point.
         double bestDist_2 = -1;
 
+        // Points that are not nearer than bestDist_2 (which is never less
+        // than bestDist) cannot change bestDist nor bestDist_2, so the
+        // computation of their distance is abandoned as soon as the partial
+        // sum of squares exceeds that bound. The bound is slightly enlarged so
+        // that the result is exactly the same as with the full computation.
+        double dfMaxSumSq = std::numeric_limits<double>::infinity();
+
         // Find the nearest and 2nd nearest points.
         for (int j = 0; j < len_2; j++)
             if (!alreadyMatched[j])
                 if (p_1->at(i).GetSign() == p_2->at(j).GetSign())
                 {
+                    const double *padfDescriptor_2 =
+                        adfDescriptors_2.data() +
+                        static_cast<size_t>(j) * DESC_SIZE;
+                    double sum = 0.0;
+                    int k = 0;
+                    for (; k < DESC_SIZE; k += 8)
+                    {
+                        for (int l = k; l < k + 8; l++)
+                        {
+                            const double diff =
+                                adfDescriptor_1[l] - padfDescriptor_2[l];
+                            sum += diff * diff;
+                        }
+                        if (sum > dfMaxSumSq)
+                            break;
+                    }
+                    if (k < DESC_SIZE)
+                        continue;
+
                     // Get distance between two feature points.
-                    double curDist =
-                        GetEuclideanDistance(p_1->at(i), p_2->at(j));
+                    double curDist = sqrt(sum);
 
                     if (bestDist == -1)
                     {
@@ -462,6 +556,8 @@ CPLErr GDALSimpleSURF::MatchFeaturePoints(
                         bestDist_2 = curDist;
                     else if (curDist > bestDist && curDist < bestDist_2)
                         bestDist_2 = curDist;
+
+                    dfMaxSumSq = bestDist_2 * bestDist_2 * (1 + 1e-10);
                 }
         /* --------------------------------------------------------------------
          */
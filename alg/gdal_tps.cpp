@@ -32,8 +32,12 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include <map>
+#include <system_error>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "cpl_atomic_ops.h"
 #include "cpl_conv.h"
@@ -67,10 +71,18 @@ typedef struct
     int nGCPCount;
     GDAL_GCP *pasGCPList;
 
+    // Maximum number of threads used to solve the splines and to
+    // transform large batches of points.
+    int nThreads;
+
     volatile int nRefCount;
 
 } TPSTransformInfo;
 
+// Minimum number of spline basis function evaluations (points x GCPs) per
+// thread in GDALTPSTransform().
+constexpr GIntBig TPS_MIN_EVALS_PER_THREAD = 10 * 1000 * 1000;
+
 /************************************************************************/
 /*                   GDALCreateSimilarTPSTransformer()                  */
 /************************************************************************/
@@ -98,8 +110,16 @@ static void *GDALCreateSimilarTPSTransformer(void *hTransformArg,
             pasGCPList[i].dfGCPPixel /= dfRatioX;
             pasGCPList[i].dfGCPLine /= dfRatioY;
         }
-        psInfo = static_cast<TPSTransformInfo *>(GDALCreateTPSTransformer(
-            psInfo->nGCPCount, pasGCPList, psInfo->bReversed));
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("NUM_THREADS",
+                                CPLSPrintf("%d", psInfo->nThreads));
+        if (psInfo->dfSrcApproxErrorReverse > 0)
+            aosOptions.SetNameValue(
+                "SRC_APPROX_ERROR_IN_PIXEL",
+                CPLSPrintf("%.17g", psInfo->dfSrcApproxErrorReverse));
+        psInfo = static_cast<TPSTransformInfo *>(GDALCreateTPSTransformerInt(
+            psInfo->nGCPCount, pasGCPList, psInfo->bReversed,
+            aosOptions.List()));
         GDALDeinitGCPs(psInfo->nGCPCount, pasGCPList);
         CPLFree(pasGCPList);
     }
@@ -150,7 +170,7 @@ void *GDALCreateTPSTransformer(int nGCPCount, const GDAL_GCP *pasGCPList,
 static void GDALTPSComputeForwardInThread(void *pData)
 {
     TPSTransformInfo *psInfo = static_cast<TPSTransformInfo *>(pData);
-    psInfo->bForwardSolved = psInfo->poForward->solve() != 0;
+    psInfo->bForwardSolved = psInfo->poForward->solve(psInfo->nThreads) != 0;
 }
 
 void *GDALCreateTPSTransformerInt(int nGCPCount, const GDAL_GCP *pasGCPList,
@@ -267,16 +287,21 @@ void *GDALCreateTPSTransformerInt(int nGCPCount, const GDAL_GCP *pasGCPList,
             nThreads = atoi(pszWarpThreads);
     }
 
+    psInfo->nThreads = std::max(1, std::min(nThreads, 128));
+
     if (nThreads > 1)
     {
-        // Compute direct and reverse transforms in parallel.
+        // Compute direct and reverse transforms in parallel, each of them
+        // also using several threads for large numbers of GCPs.
         CPLJoinableThread *hThread =
             CPLCreateJoinableThread(GDALTPSComputeForwardInThread, psInfo);
-        psInfo->bReverseSolved = psInfo->poReverse->solve() != 0;
+        psInfo->bReverseSolved =
+            psInfo->poReverse->solve(psInfo->nThreads) != 0;
         if (hThread != nullptr)
             CPLJoinThread(hThread);
         else
-            psInfo->bForwardSolved = psInfo->poForward->solve() != 0;
+            psInfo->bForwardSolved =
+                psInfo->poForward->solve(psInfo->nThreads) != 0;
     }
     else
     {
@@ -328,38 +353,13 @@ void GDALDestroyTPSTransformer(void *pTransformArg)
 }
 
 /************************************************************************/
-/*                          GDALTPSTransform()                          */
+/*                       GDALTPSTransformPoints()                       */
 /************************************************************************/
 
-/**
- * Transforms point based on GCP derived polynomial model.
- *
- * This function matches the GDALTransformerFunc signature, and can be
- * used to transform one or more points from pixel/line coordinates to
- * georeferenced coordinates (SrcToDst) or vice versa (DstToSrc).
- *
- * @param pTransformArg return value from GDALCreateTPSTransformer().
- * @param bDstToSrc TRUE if transformation is from the destination
- * (georeferenced) coordinates to pixel/line or FALSE when transforming
- * from pixel/line to georeferenced coordinates.
- * @param nPointCount the number of values in the x, y and z arrays.
- * @param x array containing the X values to be transformed.
- * @param y array containing the Y values to be transformed.
- * @param z array containing the Z values to be transformed.
- * @param panSuccess array in which a flag indicating success (TRUE) or
- * failure (FALSE) of the transformation are placed.
- *
- * @return TRUE.
- */
-
-int GDALTPSTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
-                     double *x, double *y, CPL_UNUSED double *z,
-                     int *panSuccess)
+static void GDALTPSTransformPoints(TPSTransformInfo *psInfo, int bDstToSrc,
+                                   int nPointCount, double *x, double *y,
+                                   int *panSuccess)
 {
-    VALIDATE_POINTER1(pTransformArg, "GDALTPSTransform", 0);
-
-    TPSTransformInfo *psInfo = static_cast<TPSTransformInfo *>(pTransformArg);
-
     for (int i = 0; i < nPointCount; i++)
     {
         double xy_out[2] = {0.0, 0.0};
@@ -400,6 +400,76 @@ int GDALTPSTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
         }
         panSuccess[i] = TRUE;
     }
+}
+
+/************************************************************************/
+/*                          GDALTPSTransform()                          */
+/************************************************************************/
+
+/**
+ * Transforms point based on GCP derived polynomial model.
+ *
+ * This function matches the GDALTransformerFunc signature, and can be
+ * used to transform one or more points from pixel/line coordinates to
+ * georeferenced coordinates (SrcToDst) or vice versa (DstToSrc).
+ *
+ * @param pTransformArg return value from GDALCreateTPSTransformer().
+ * @param bDstToSrc TRUE if transformation is from the destination
+ * (georeferenced) coordinates to pixel/line or FALSE when transforming
+ * from pixel/line to georeferenced coordinates.
+ * @param nPointCount the number of values in the x, y and z arrays.
+ * @param x array containing the X values to be transformed.
+ * @param y array containing the Y values to be transformed.
+ * @param z array containing the Z values to be transformed.
+ * @param panSuccess array in which a flag indicating success (TRUE) or
+ * failure (FALSE) of the transformation are placed.
+ *
+ * @return TRUE.
+ */
+
+int GDALTPSTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
+                     double *x, double *y, CPL_UNUSED double *z,
+                     int *panSuccess)
+{
+    VALIDATE_POINTER1(pTransformArg, "GDALTPSTransform", 0);
+
+    TPSTransformInfo *psInfo = static_cast<TPSTransformInfo *>(pTransformArg);
+
+    // Evaluating the spline costs one basis function per GCP, so split
+    // large batches of points among several threads.
+    const int nJobs = static_cast<int>(std::min<GIntBig>(
+        std::min(psInfo->nThreads, nPointCount),
+        static_cast<GIntBig>(nPointCount) * psInfo->nGCPCount /
+            TPS_MIN_EVALS_PER_THREAD));
+    if (nJobs <= 1)
+    {
+        GDALTPSTransformPoints(psInfo, bDstToSrc, nPointCount, x, y,
+                               panSuccess);
+        return TRUE;
+    }
+
+    std::vector<std::thread> aoThreads;
+    int iStart = 0;
+    for (int iJob = 0; iJob < nJobs; iJob++)
+    {
+        const int iEnd = static_cast<int>(static_cast<GIntBig>(nPointCount) *
+                                          (iJob + 1) / nJobs);
+        try
+        {
+            aoThreads.emplace_back(GDALTPSTransformPoints, psInfo, bDstToSrc,
+                                   iEnd - iStart, x + iStart, y + iStart,
+                                   panSuccess + iStart);
+        }
+        catch (const std::system_error &)
+        {
+            GDALTPSTransformPoints(psInfo, bDstToSrc, iEnd - iStart,
+                                   x + iStart, y + iStart,
+                                   panSuccess + iStart);
+        }
+        iStart = iEnd;
+    }
+    for (auto &oThread : aoThreads)
+        oThread.join();
 
     return TRUE;
 }
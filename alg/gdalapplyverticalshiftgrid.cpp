@@ -27,10 +27,12 @@
  ****************************************************************************/
 
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "gdal_alg_priv.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "gdal_utils.h"
 #include "gdalwarper.h"
 #include "vrtdataset.h"
@@ -38,7 +40,9 @@
 
 #include "proj.h"
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 /************************************************************************/
 /*                        GDALApplyVSGDataset                           */
@@ -69,6 +73,9 @@ class GDALApplyVSGDataset final : public GDALDataset
     virtual const OGRSpatialReference *GetSpatialRef() const override;
 
     bool IsInitOK();
+
+    int ShiftLine(float *pafSrcData, const float *pafGridData, int nCount,
+                  bool bHasNoData, float fNoDataValue) const;
 };
 
 /************************************************************************/
@@ -90,6 +97,9 @@ class GDALApplyVSGRasterBand final : public GDALRasterBand
 
     virtual CPLErr IReadBlock(int nBlockXOff, int nBlockYOff,
                               void *pData) override;
+    virtual CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
+                             GDALDataType, GSpacing, GSpacing,
+                             GDALRasterIOExtraArg *psExtraArg) override;
     virtual double GetNoDataValue(int *pbSuccess) override;
 };
 
@@ -214,6 +224,41 @@ double GDALApplyVSGRasterBand::GetNoDataValue(int *pbSuccess)
     return poGDS->m_poSrcDataset->GetRasterBand(1)->GetNoDataValue(pbSuccess);
 }
 
+/************************************************************************/
+/*                             ShiftLine()                              */
+/************************************************************************/
+
+// Apply the vertical shift of pafGridData to pafSrcData in place. Returns the
+// index of the first pixel with a missing grid value, or -1.
+int GDALApplyVSGDataset::ShiftLine(float *pafSrcData, const float *pafGridData,
+                                   int nCount, bool bHasNoData,
+                                   float fNoDataValue) const
+{
+    for (int iX = 0; iX < nCount; iX++)
+    {
+        const float fSrcVal = pafSrcData[iX];
+        const float fGridVal = pafGridData[iX];
+        if (bHasNoData && fSrcVal == fNoDataValue)
+        {
+        }
+        else if (CPLIsInf(fGridVal))
+        {
+            return iX;
+        }
+        else if (m_bInverse)
+        {
+            pafSrcData[iX] = static_cast<float>(
+                (fSrcVal * m_dfSrcUnitToMeter - fGridVal) / m_dfDstUnitToMeter);
+        }
+        else
+        {
+            pafSrcData[iX] = static_cast<float>(
+                (fSrcVal * m_dfSrcUnitToMeter + fGridVal) / m_dfDstUnitToMeter);
+        }
+    }
+    return -1;
+}
+
 /************************************************************************/
 /*                              IReadBlock()                            */
 /************************************************************************/
@@ -248,32 +293,16 @@ CPLErr GDALApplyVSGRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff,
         float fNoDataValue = static_cast<float>(GetNoDataValue(&bHasNoData));
         for (int iY = 0; iY < nReqYSize; iY++)
         {
-            for (int iX = 0; iX < nReqXSize; iX++)
+            const int iX = poGDS->ShiftLine(
+                m_pafSrcData + iY * nBlockXSize,
+                m_pafGridData + iY * nBlockXSize, nReqXSize,
+                CPL_TO_BOOL(bHasNoData), fNoDataValue);
+            if (iX >= 0)
             {
-                const float fSrcVal = m_pafSrcData[iY * nBlockXSize + iX];
-                const float fGridVal = m_pafGridData[iY * nBlockXSize + iX];
-                if (bHasNoData && fSrcVal == fNoDataValue)
-                {
-                }
-                else if (CPLIsInf(fGridVal))
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "Missing vertical grid value at source (%d,%d)",
-                             nXOff + iX, nYOff + iY);
-                    return CE_Failure;
-                }
-                else if (poGDS->m_bInverse)
-                {
-                    m_pafSrcData[iY * nBlockXSize + iX] = static_cast<float>(
-                        (fSrcVal * poGDS->m_dfSrcUnitToMeter - fGridVal) /
-                        poGDS->m_dfDstUnitToMeter);
-                }
-                else
-                {
-                    m_pafSrcData[iY * nBlockXSize + iX] = static_cast<float>(
-                        (fSrcVal * poGDS->m_dfSrcUnitToMeter + fGridVal) /
-                        poGDS->m_dfDstUnitToMeter);
-                }
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Missing vertical grid value at source (%d,%d)",
+                         nXOff + iX, nYOff + iY);
+                return CE_Failure;
             }
             GDALCopyWords(
                 m_pafSrcData + iY * nBlockXSize, GDT_Float32, sizeof(float),
@@ -285,6 +314,178 @@ CPLErr GDALApplyVSGRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff,
     return eErr;
 }
 
+/************************************************************************/
+/*                              IRasterIO()                             */
+/************************************************************************/
+
+namespace
+{
+// Lines of a GDALApplyVSGRasterBand::IRasterIO() request processed by a job.
+struct GDALApplyVSGJob
+{
+    GDALApplyVSGDataset *poGDS = nullptr;
+    float *pafSrcData = nullptr;
+    const float *pafGridData = nullptr;
+    int nXSize = 0;
+    int iYStart = 0;
+    int iYEnd = 0;
+    bool bHasNoData = false;
+    float fNoDataValue = 0;
+    GDALDataType eDataType = GDT_Unknown;
+    GByte *pabyData = nullptr;
+    GDALDataType eBufType = GDT_Unknown;
+    GSpacing nPixelSpace = 0;
+    GSpacing nLineSpace = 0;
+    // First pixel with a missing grid value, if any.
+    int iXMissing = -1;
+    int iYMissing = -1;
+};
+}  // namespace
+
+static void GDALApplyVSGJobFunc(void *pData)
+{
+    auto psJob = static_cast<GDALApplyVSGJob *>(pData);
+    // Shifted values are converted to the band data type, before the buffer
+    // data type, as in IReadBlock().
+    const int nDTSize = GDALGetDataTypeSizeBytes(psJob->eDataType);
+    std::vector<GByte> abyLine;
+    if (psJob->eDataType != GDT_Float32)
+        abyLine.resize(static_cast<size_t>(psJob->nXSize) * nDTSize);
+    for (int iY = psJob->iYStart; iY < psJob->iYEnd; iY++)
+    {
+        float *pafSrcLine =
+            psJob->pafSrcData + static_cast<size_t>(iY) * psJob->nXSize;
+        const int iX = psJob->poGDS->ShiftLine(
+            pafSrcLine,
+            psJob->pafGridData + static_cast<size_t>(iY) * psJob->nXSize,
+            psJob->nXSize, psJob->bHasNoData, psJob->fNoDataValue);
+        if (iX >= 0)
+        {
+            psJob->iXMissing = iX;
+            psJob->iYMissing = iY;
+            return;
+        }
+        GByte *pabyDstLine = psJob->pabyData + iY * psJob->nLineSpace;
+        if (abyLine.empty())
+        {
+            GDALCopyWords64(pafSrcLine, GDT_Float32, sizeof(float),
+                            pabyDstLine, psJob->eBufType,
+                            static_cast<int>(psJob->nPixelSpace),
+                            psJob->nXSize);
+        }
+        else
+        {
+            GDALCopyWords64(pafSrcLine, GDT_Float32, sizeof(float),
+                            abyLine.data(), psJob->eDataType, nDTSize,
+                            psJob->nXSize);
+            GDALCopyWords64(abyLine.data(), psJob->eDataType, nDTSize,
+                            pabyDstLine, psJob->eBufType,
+                            static_cast<int>(psJob->nPixelSpace),
+                            psJob->nXSize);
+        }
+    }
+}
+
+CPLErr GDALApplyVSGRasterBand::IRasterIO(
+    GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+    void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    GSpacing nPixelSpace, GSpacing nLineSpace, GDALRasterIOExtraArg *psExtraArg)
+{
+    // Requests spanning several blocks are processed at once when
+    // GDAL_NUM_THREADS is set: the reprojected grid is then warped by regions
+    // of several blocks in parallel, and the shift is applied to groups of
+    // lines in parallel.
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads =
+        std::max(1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                                      ? CPLGetNumCPUs()
+                                      : atoi(pszNumThreads)));
+    if (eRWFlag != GF_Read || nThreads == 1 || nXSize != nBufXSize ||
+        nYSize != nBufYSize ||
+        (nXSize <= nBlockXSize && nYSize <= nBlockYSize) ||
+        nPixelSpace > INT_MAX ||
+        2 * sizeof(float) * static_cast<double>(nXSize) * nYSize >
+            static_cast<double>(GDALGetCacheMax64()) / 4)
+    {
+        return GDALRasterBand::IRasterIO(
+            eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+            eBufType, nPixelSpace, nLineSpace, psExtraArg);
+    }
+
+    GDALApplyVSGDataset *poGDS = reinterpret_cast<GDALApplyVSGDataset *>(poDS);
+    std::vector<float> afSrcData;
+    std::vector<float> afGridData;
+    try
+    {
+        afSrcData.resize(static_cast<size_t>(nXSize) * nYSize);
+        afGridData.resize(static_cast<size_t>(nXSize) * nYSize);
+    }
+    catch (const std::exception &)
+    {
+        return GDALRasterBand::IRasterIO(
+            eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+            eBufType, nPixelSpace, nLineSpace, psExtraArg);
+    }
+
+    CPLErr eErr = poGDS->m_poSrcDataset->GetRasterBand(1)->RasterIO(
+        GF_Read, nXOff, nYOff, nXSize, nYSize, afSrcData.data(), nXSize,
+        nYSize, GDT_Float32, 0, 0, nullptr);
+    if (eErr == CE_None)
+        eErr = poGDS->m_poReprojectedGrid->GetRasterBand(1)->RasterIO(
+            GF_Read, nXOff, nYOff, nXSize, nYSize, afGridData.data(), nXSize,
+            nYSize, GDT_Float32, 0, 0, nullptr);
+    if (eErr != CE_None)
+        return eErr;
+
+    int bHasNoData = FALSE;
+    const float fNoDataValue = static_cast<float>(GetNoDataValue(&bHasNoData));
+
+    const int nJobs = std::min(nThreads, nYSize);
+    std::vector<GDALApplyVSGJob> asJobs(nJobs);
+    for (int i = 0; i < nJobs; i++)
+    {
+        auto &sJob = asJobs[i];
+        sJob.poGDS = poGDS;
+        sJob.pafSrcData = afSrcData.data();
+        sJob.pafGridData = afGridData.data();
+        sJob.nXSize = nXSize;
+        sJob.iYStart =
+            static_cast<int>(static_cast<GIntBig>(nYSize) * i / nJobs);
+        sJob.iYEnd =
+            static_cast<int>(static_cast<GIntBig>(nYSize) * (i + 1) / nJobs);
+        sJob.bHasNoData = CPL_TO_BOOL(bHasNoData);
+        sJob.fNoDataValue = fNoDataValue;
+        sJob.eDataType = eDataType;
+        sJob.pabyData = static_cast<GByte *>(pData);
+        sJob.eBufType = eBufType;
+        sJob.nPixelSpace = nPixelSpace;
+        sJob.nLineSpace = nLineSpace;
+    }
+
+    auto poPool = GDALGetGlobalThreadPool(nThreads);
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    for (auto &sJob : asJobs)
+    {
+        if (!poQueue || !poQueue->SubmitJob(GDALApplyVSGJobFunc, &sJob))
+            GDALApplyVSGJobFunc(&sJob);
+    }
+    if (poQueue)
+        poQueue->WaitCompletion();
+
+    for (const auto &sJob : asJobs)
+    {
+        if (sJob.iXMissing >= 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Missing vertical grid value at source (%d,%d)",
+                     nXOff + sJob.iXMissing, nYOff + sJob.iYMissing);
+            return CE_Failure;
+        }
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                      GDALApplyVerticalShiftGrid()                    */
 /************************************************************************/
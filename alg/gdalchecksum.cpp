@@ -33,12 +33,122 @@
 #include <cmath>
 #include <cstddef>
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
+
+static const int anPrimes[11] = {7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43};
+
+/************************************************************************/
+/*                        GDALChecksumValue()                           */
+/************************************************************************/
+
+static inline int GDALChecksumValue(int nVal)
+{
+    return nVal;
+}
+
+static inline int GDALChecksumValue(double dfVal)
+{
+    if (CPLIsNan(dfVal) || CPLIsInf(dfVal))
+    {
+        // Most compilers seem to cast NaN or Inf to 0x80000000.
+        // but VC7 is an exception. So we force the result
+        // of such a cast.
+        return 0x80000000;
+    }
+
+    // Standard behavior of GDALCopyWords when converting
+    // from floating point to Int32.
+    dfVal += 0.5;
+
+    if (dfVal < -2147483647.0)
+        return -2147483647;
+    else if (dfVal > 2147483647)
+        return 2147483647;
+    else
+        return static_cast<GInt32>(floor(dfVal));
+}
+
+/************************************************************************/
+/*                        GDALChecksumChunk()                           */
+/************************************************************************/
+
+// Return the checksum contribution of a chunk of nChunkXSize x nChunkYSize
+// pixels starting at (iXStart, iYStart) of a window of width nXSize.
+// As the checksum is a sum modulo 65536 of terms that only depend on the
+// value and its position in the window, the contributions of the chunks can
+// be summed in any order.
+template <class T>
+static int GDALChecksumChunk(const T *paData, int nXSize, int iXStart,
+                             int iYStart, int nChunkXSize, int nChunkYSize,
+                             int nValsPerIter)
+{
+    int nChecksum = 0;
+    const size_t xIters = static_cast<size_t>(nValsPerIter) * nChunkXSize;
+    for (int iY = 0; iY < nChunkYSize; ++iY)
+    {
+        // Initialize iPrime so that it is consistent with a
+        // per full line iteration strategy
+        int iPrime = static_cast<int>(
+            (nValsPerIter *
+             (static_cast<int64_t>(iYStart + iY) * nXSize + iXStart)) %
+            11);
+        const T *paLine = paData + static_cast<size_t>(iY) * xIters;
+        for (size_t i = 0; i < xIters; ++i)
+        {
+            nChecksum += GDALChecksumValue(paLine[i]) % anPrimes[iPrime++];
+            if (iPrime > 10)
+                iPrime = 0;
+        }
+        nChecksum &= 0xffff;
+    }
+    return nChecksum;
+}
+
+namespace
+{
+// Chunk read by the main thread, whose checksum contribution is computed
+// by a worker thread.
+struct GDALChecksumChunkJob
+{
+    std::vector<GByte> abyData{};
+    bool bFloatingPoint = false;
+    int nXSize = 0;
+    int iXStart = 0;
+    int iYStart = 0;
+    int nChunkXSize = 0;
+    int nChunkYSize = 0;
+    int nValsPerIter = 1;
+    std::atomic<GUInt32> *pnChecksum = nullptr;
+};
+}  // namespace
+
+static void GDALChecksumChunkJobFunc(void *pData)
+{
+    std::unique_ptr<GDALChecksumChunkJob> psJob(
+        static_cast<GDALChecksumChunkJob *>(pData));
+    const int nChecksum =
+        psJob->bFloatingPoint
+            ? GDALChecksumChunk(
+                  reinterpret_cast<const double *>(psJob->abyData.data()),
+                  psJob->nXSize, psJob->iXStart, psJob->iYStart,
+                  psJob->nChunkXSize, psJob->nChunkYSize, psJob->nValsPerIter)
+            : GDALChecksumChunk(
+                  reinterpret_cast<const int *>(psJob->abyData.data()),
+                  psJob->nXSize, psJob->iXStart, psJob->iYStart,
+                  psJob->nChunkXSize, psJob->nChunkYSize, psJob->nValsPerIter);
+    *(psJob->pnChecksum) += static_cast<GUInt32>(nChecksum);
+}
 
 /************************************************************************/
 /*                         GDALChecksumImage()                          */
@@ -52,6 +162,12 @@
  * so decimal portions of such raster data will not affect the checksum.
  * Real and Imaginary components of complex bands influence the result.
  *
+ * Starting with GDAL 3.9, when the window is the whole band, the checksum
+ * of the chunks read from the band can be computed by several threads,
+ * according to the GDAL_NUM_THREADS configuration option (an integer or
+ * ALL_CPUS), while the next chunks are read. The result does not depend on
+ * the number of threads.
+ *
  * @param hBand the raster band to read from.
  * @param nXOff pixel offset of window to read.
  * @param nYOff line offset of window to read.
@@ -67,78 +183,19 @@ int CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff, int nYOff,
 {
     VALIDATE_POINTER1(hBand, "GDALChecksumImage", 0);
 
-    const static int anPrimes[11] = {7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43};
-
     int nChecksum = 0;
     int iPrime = 0;
     const GDALDataType eDataType = GDALGetRasterDataType(hBand);
     const bool bComplex = CPL_TO_BOOL(GDALDataTypeIsComplex(eDataType));
+    const bool bFloatingPoint =
+        (eDataType == GDT_Float32 || eDataType == GDT_Float64 ||
+         eDataType == GDT_CFloat32 || eDataType == GDT_CFloat64);
 
-    if (eDataType == GDT_Float32 || eDataType == GDT_Float64 ||
-        eDataType == GDT_CFloat32 || eDataType == GDT_CFloat64)
+    if (nXOff == 0 && nYOff == 0)
     {
-        const GDALDataType eDstDataType = bComplex ? GDT_CFloat64 : GDT_Float64;
-
-        double *padfLineData = static_cast<double *>(VSI_MALLOC2_VERBOSE(
-            nXSize, GDALGetDataTypeSizeBytes(eDstDataType)));
-        if (padfLineData == nullptr)
-        {
-            return -1;
-        }
-
-        for (int iLine = nYOff; iLine < nYOff + nYSize; iLine++)
-        {
-            if (GDALRasterIO(hBand, GF_Read, nXOff, iLine, nXSize, 1,
-                             padfLineData, nXSize, 1, eDstDataType, 0,
-                             0) != CE_None)
-            {
-                CPLError(CE_Failure, CPLE_FileIO,
-                         "Checksum value couldn't be computed due to "
-                         "I/O read error.");
-                nChecksum = -1;
-                break;
-            }
-            const size_t nCount = bComplex ? static_cast<size_t>(nXSize) * 2
-                                           : static_cast<size_t>(nXSize);
-
-            for (size_t i = 0; i < nCount; i++)
-            {
-                double dfVal = padfLineData[i];
-                int nVal;
-                if (CPLIsNan(dfVal) || CPLIsInf(dfVal))
-                {
-                    // Most compilers seem to cast NaN or Inf to 0x80000000.
-                    // but VC7 is an exception. So we force the result
-                    // of such a cast.
-                    nVal = 0x80000000;
-                }
-                else
-                {
-                    // Standard behavior of GDALCopyWords when converting
-                    // from floating point to Int32.
-                    dfVal += 0.5;
-
-                    if (dfVal < -2147483647.0)
-                        nVal = -2147483647;
-                    else if (dfVal > 2147483647)
-                        nVal = 2147483647;
-                    else
-                        nVal = static_cast<GInt32>(floor(dfVal));
-                }
-
-                nChecksum += nVal % anPrimes[iPrime++];
-                if (iPrime > 10)
-                    iPrime = 0;
-
-                nChecksum &= 0xffff;
-            }
-        }
-
-        CPLFree(padfLineData);
-    }
-    else if (nXOff == 0 && nYOff == 0)
-    {
-        const GDALDataType eDstDataType = bComplex ? GDT_CInt32 : GDT_Int32;
+        const GDALDataType eDstDataType =
+            bFloatingPoint ? (bComplex ? GDT_CFloat64 : GDT_Float64)
+                           : (bComplex ? GDT_CInt32 : GDT_Int32);
         int nBlockXSize = 0;
         int nBlockYSize = 0;
         GDALGetBlockSize(hBand, &nBlockXSize, &nBlockYSize);
@@ -171,16 +228,35 @@ int CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff, int nYOff,
             }
         }
 
-        int *panChunkData = static_cast<GInt32 *>(
-            VSI_MALLOC3_VERBOSE(nChunkXSize, nChunkYSize, nDstDataTypeSize));
-        if (panChunkData == nullptr)
-        {
-            return -1;
-        }
         const int nValsPerIter = bComplex ? 2 : 1;
-
         const int nYBlocks = DIV_ROUND_UP(nYSize, nChunkYSize);
         const int nXBlocks = DIV_ROUND_UP(nXSize, nChunkXSize);
+
+        const char *pszNumThreads =
+            CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+        const int nThreads =
+            std::max(1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                                          ? CPLGetNumCPUs()
+                                          : atoi(pszNumThreads)));
+        auto poPool = (nThreads > 1 && static_cast<GIntBig>(nYBlocks) *
+                                               nXBlocks >
+                                           1)
+                          ? GDALGetGlobalThreadPool(nThreads)
+                          : nullptr;
+        auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+        std::atomic<GUInt32> nChecksumMT{0};
+
+        GByte *pabyChunkData = nullptr;
+        if (!poQueue)
+        {
+            pabyChunkData = static_cast<GByte *>(VSI_MALLOC3_VERBOSE(
+                nChunkXSize, nChunkYSize, nDstDataTypeSize));
+            if (pabyChunkData == nullptr)
+            {
+                return -1;
+            }
+        }
+
         for (int iYBlock = 0; iYBlock < nYBlocks; ++iYBlock)
         {
             const int iYStart = iYBlock * nChunkYSize;
@@ -193,9 +269,35 @@ int CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff, int nYOff,
                 const int iXEnd =
                     iXBlock == nXBlocks - 1 ? nXSize : iXStart + nChunkXSize;
                 const int nChunkActualXSize = iXEnd - iXStart;
+
+                // In multi-threaded mode, each chunk gets its own buffer,
+                // released by the job computing its checksum. Limit the
+                // number of pending jobs to bound memory usage.
+                std::unique_ptr<GDALChecksumChunkJob> psJob;
+                if (poQueue)
+                {
+                    poQueue->WaitCompletion(nThreads);
+                    try
+                    {
+                        psJob = std::make_unique<GDALChecksumChunkJob>();
+                        psJob->abyData.resize(
+                            static_cast<size_t>(nChunkActualXSize) *
+                            nChunkActualHeight * nDstDataTypeSize);
+                    }
+                    catch (const std::exception &)
+                    {
+                        CPLError(CE_Failure, CPLE_OutOfMemory,
+                                 "Cannot allocate checksum chunk buffer");
+                        nChecksum = -1;
+                        iYBlock = nYBlocks;
+                        break;
+                    }
+                    pabyChunkData = psJob->abyData.data();
+                }
+
                 if (GDALRasterIO(
                         hBand, GF_Read, iXStart, iYStart, nChunkActualXSize,
-                        nChunkActualHeight, panChunkData, nChunkActualXSize,
+                        nChunkActualHeight, pabyChunkData, nChunkActualXSize,
                         nChunkActualHeight, eDstDataType, 0, 0) != CE_None)
                 {
                     CPLError(CE_Failure, CPLE_FileIO,
@@ -205,31 +307,86 @@ int CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff, int nYOff,
                     iYBlock = nYBlocks;
                     break;
                 }
-                const size_t xIters =
-                    static_cast<size_t>(nValsPerIter) * nChunkActualXSize;
-                for (int iY = iYStart; iY < iYEnd; ++iY)
+
+                if (psJob)
                 {
-                    // Initialize iPrime so that it is consistent with a
-                    // per full line iteration strategy
-                    iPrime = (nValsPerIter *
-                              (static_cast<int64_t>(iY) * nXSize + iXStart)) %
-                             11;
-                    const size_t nOffset = nValsPerIter *
-                                           static_cast<size_t>(iY - iYStart) *
-                                           nChunkActualXSize;
-                    for (size_t i = 0; i < xIters; ++i)
-                    {
-                        nChecksum +=
-                            panChunkData[nOffset + i] % anPrimes[iPrime++];
-                        if (iPrime > 10)
-                            iPrime = 0;
-                    }
-                    nChecksum &= 0xffff;
+                    psJob->bFloatingPoint = bFloatingPoint;
+                    psJob->nXSize = nXSize;
+                    psJob->iXStart = iXStart;
+                    psJob->iYStart = iYStart;
+                    psJob->nChunkXSize = nChunkActualXSize;
+                    psJob->nChunkYSize = nChunkActualHeight;
+                    psJob->nValsPerIter = nValsPerIter;
+                    psJob->pnChecksum = &nChecksumMT;
+                    poQueue->SubmitJob(GDALChecksumChunkJobFunc,
+                                       psJob.release());
+                }
+                else
+                {
+                    const int nChunkChecksum =
+                        bFloatingPoint
+                            ? GDALChecksumChunk(
+                                  reinterpret_cast<double *>(pabyChunkData),
+                                  nXSize, iXStart, iYStart, nChunkActualXSize,
+                                  nChunkActualHeight, nValsPerIter)
+                            : GDALChecksumChunk(
+                                  reinterpret_cast<int *>(pabyChunkData),
+                                  nXSize, iXStart, iYStart, nChunkActualXSize,
+                                  nChunkActualHeight, nValsPerIter);
+                    nChecksum = (nChecksum + nChunkChecksum) & 0xffff;
                 }
             }
         }
 
-        CPLFree(panChunkData);
+        if (poQueue)
+        {
+            poQueue->WaitCompletion();
+            if (nChecksum != -1)
+                nChecksum = static_cast<int>(nChecksumMT.load() & 0xffff);
+        }
+        else
+        {
+            CPLFree(pabyChunkData);
+        }
+    }
+    else if (bFloatingPoint)
+    {
+        const GDALDataType eDstDataType = bComplex ? GDT_CFloat64 : GDT_Float64;
+
+        double *padfLineData = static_cast<double *>(VSI_MALLOC2_VERBOSE(
+            nXSize, GDALGetDataTypeSizeBytes(eDstDataType)));
+        if (padfLineData == nullptr)
+        {
+            return -1;
+        }
+
+        for (int iLine = nYOff; iLine < nYOff + nYSize; iLine++)
+        {
+            if (GDALRasterIO(hBand, GF_Read, nXOff, iLine, nXSize, 1,
+                             padfLineData, nXSize, 1, eDstDataType, 0,
+                             0) != CE_None)
+            {
+                CPLError(CE_Failure, CPLE_FileIO,
+                         "Checksum value couldn't be computed due to "
+                         "I/O read error.");
+                nChecksum = -1;
+                break;
+            }
+            const size_t nCount = bComplex ? static_cast<size_t>(nXSize) * 2
+                                           : static_cast<size_t>(nXSize);
+
+            for (size_t i = 0; i < nCount; i++)
+            {
+                nChecksum +=
+                    GDALChecksumValue(padfLineData[i]) % anPrimes[iPrime++];
+                if (iPrime > 10)
+                    iPrime = 0;
+
+                nChecksum &= 0xffff;
+            }
+        }
+
+        CPLFree(padfLineData);
     }
     else
     {
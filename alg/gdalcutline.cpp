@@ -34,12 +34,15 @@
 #include <cstdio>
 #include <cstring>
 #include <algorithm>
+#include <memory>
+#include <mutex>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_string.h"
 #include "gdal.h"
 #include "gdal_alg.h"
+#include "gdal_alg_priv.h"
 #include "gdal_priv.h"
 #include "memdataset.h"
 #include "ogr_api.h"
@@ -230,6 +233,77 @@ static int CutlineTransformer(void *pTransformArg, int bDstToSrc,
     return TRUE;
 }
 
+/************************************************************************/
+/*                       GDALWarpPreparedCutline                        */
+/************************************************************************/
+
+// GEOS version of a cutline, with a prepared geometry to quickly classify
+// the chunks of a warp operation. GEOS objects are not thread-safe, hence
+// the mutex, as chunks may be warped by several threads.
+struct GDALWarpPreparedCutline
+{
+#ifdef HAVE_GEOS
+    std::mutex oMutex{};
+    GEOSContextHandle_t hGEOSCtxt = nullptr;
+    GEOSGeom hGEOSCutline = nullptr;
+    const GEOSPreparedGeometry *hPreparedCutline = nullptr;
+
+    ~GDALWarpPreparedCutline()
+    {
+        if (hPreparedCutline)
+            GEOSPreparedGeom_destroy_r(hGEOSCtxt, hPreparedCutline);
+        if (hGEOSCutline)
+            GEOSGeom_destroy_r(hGEOSCtxt, hGEOSCutline);
+        if (hGEOSCtxt)
+            OGRGeometry::freeGEOSContext(hGEOSCtxt);
+    }
+#endif
+};
+
+/************************************************************************/
+/*                       GDALWarpPrepareCutline()                       */
+/************************************************************************/
+
+/** Prepares a cutline once for all the chunks of a warp operation.
+ *
+ * @param hCutline Cutline polygon, in source pixel coordinates.
+ * @return an object to pass to GDALWarpCutlineMaskerPrepared() and to free
+ * with GDALWarpDestroyPreparedCutline(), or nullptr if GEOS is not
+ * available.
+ */
+GDALWarpPreparedCutline *
+GDALWarpPrepareCutline(CPL_UNUSED OGRGeometryH hCutline)
+{
+#ifdef HAVE_GEOS
+    if (!OGRGeometryFactory::haveGEOS())
+        return nullptr;
+
+    auto psPrepared = std::make_unique<GDALWarpPreparedCutline>();
+    psPrepared->hGEOSCtxt = OGRGeometry::createGEOSContext();
+    psPrepared->hGEOSCutline = OGRGeometry::FromHandle(hCutline)->exportToGEOS(
+        psPrepared->hGEOSCtxt);
+    if (psPrepared->hGEOSCutline == nullptr)
+        return nullptr;
+    psPrepared->hPreparedCutline =
+        GEOSPrepare_r(psPrepared->hGEOSCtxt, psPrepared->hGEOSCutline);
+    if (psPrepared->hPreparedCutline == nullptr)
+        return nullptr;
+    return psPrepared.release();
+#else
+    return nullptr;
+#endif
+}
+
+/************************************************************************/
+/*                   GDALWarpDestroyPreparedCutline()                   */
+/************************************************************************/
+
+/** Destroys an object returned by GDALWarpPrepareCutline(). */
+void GDALWarpDestroyPreparedCutline(GDALWarpPreparedCutline *psPrepared)
+{
+    delete psPrepared;
+}
+
 /************************************************************************/
 /*                       GDALWarpCutlineMasker()                        */
 /*                                                                      */
@@ -248,11 +322,34 @@ CPLErr GDALWarpCutlineMasker(void *pMaskFuncArg, int nBandCount,
                                    bMaskIsFloat, pValidityMask, nullptr);
 }
 
-CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
-                               GDALDataType /* eType */, int nXOff, int nYOff,
-                               int nXSize, int nYSize,
-                               GByte ** /*ppImageData */, int bMaskIsFloat,
-                               void *pValidityMask, int *pnValidityFlag)
+CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int nBandCount,
+                               GDALDataType eType, int nXOff, int nYOff,
+                               int nXSize, int nYSize, GByte **ppImageData,
+                               int bMaskIsFloat, void *pValidityMask,
+                               int *pnValidityFlag)
+
+{
+    return GDALWarpCutlineMaskerPrepared(
+        nullptr, pMaskFuncArg, nBandCount, eType, nXOff, nYOff, nXSize, nYSize,
+        ppImageData, bMaskIsFloat, pValidityMask, pnValidityFlag);
+}
+
+/************************************************************************/
+/*                   GDALWarpCutlineMaskerPrepared()                    */
+/************************************************************************/
+
+/** Same as GDALWarpCutlineMaskerEx(), using the cutline prepared by
+ * GDALWarpPrepareCutline() if psPrepared is not null.
+ *
+ * The prepared cutline is used to detect chunks that do not intersect the
+ * cutline, even if they are within its bounding box, and to clip the
+ * cutline to the chunk before rasterizing it.
+ */
+CPLErr GDALWarpCutlineMaskerPrepared(
+    CPL_UNUSED GDALWarpPreparedCutline *psPrepared, void *pMaskFuncArg,
+    int /* nBandCount */, GDALDataType /* eType */, int nXOff, int nYOff,
+    int nXSize, int nYSize, GByte ** /*ppImageData */, int bMaskIsFloat,
+    void *pValidityMask, int *pnValidityFlag)
 
 {
     if (pnValidityFlag)
@@ -320,7 +417,7 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
     }
 
     // And now check if the chunk to warp is fully contained within the cutline
-    // to save rasterization.
+    // to save rasterization, or, with a prepared cutline, fully outside of it.
     if (OGRGeometryFactory::haveGEOS()
 #ifdef DEBUG
         // Env var just for debugging purposes
@@ -344,8 +441,38 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
         oChunkFootprint.addRingDirectly(poRing);
         OGREnvelope sChunkEnvelope;
         oChunkFootprint.getEnvelope(&sChunkEnvelope);
-        if (sEnvelope.Contains(sChunkEnvelope) &&
-            OGRGeometry::FromHandle(hPolygon)->Contains(&oChunkFootprint))
+
+        bool bContains = false;
+        bool bIntersects = true;
+#ifdef HAVE_GEOS
+        if (psPrepared)
+        {
+            std::lock_guard<std::mutex> oLock(psPrepared->oMutex);
+            GEOSGeom hGEOSChunk =
+                oChunkFootprint.exportToGEOS(psPrepared->hGEOSCtxt);
+            if (hGEOSChunk)
+            {
+                bContains = sEnvelope.Contains(sChunkEnvelope) &&
+                            GEOSPreparedContains_r(
+                                psPrepared->hGEOSCtxt,
+                                psPrepared->hPreparedCutline, hGEOSChunk) == 1;
+                bIntersects = bContains ||
+                              GEOSPreparedIntersects_r(
+                                  psPrepared->hGEOSCtxt,
+                                  psPrepared->hPreparedCutline,
+                                  hGEOSChunk) != 0;
+                GEOSGeom_destroy_r(psPrepared->hGEOSCtxt, hGEOSChunk);
+            }
+        }
+        else
+#endif
+        {
+            bContains =
+                sEnvelope.Contains(sChunkEnvelope) &&
+                OGRGeometry::FromHandle(hPolygon)->Contains(&oChunkFootprint);
+        }
+
+        if (bContains)
         {
             if (pnValidityFlag)
                 *pnValidityFlag = GCMVF_CHUNK_FULLY_WITHIN_CUTLINE;
@@ -353,7 +480,54 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
             CPLDebug("WARP", "Source chunk fully contained within cutline.");
             return CE_None;
         }
+
+        if (!bIntersects)
+        {
+            if (pnValidityFlag)
+                *pnValidityFlag = GCMVF_NO_INTERSECTION;
+
+            CPLDebug("WARP", "Source chunk fully outside of cutline.");
+            memset(pafMask, 0, sizeof(float) * nXSize * nYSize);
+            return CE_None;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      With a prepared cutline, clip it to the chunk so that the       */
+    /*      rasterization does not have to go through all its vertices.     */
+    /*      The clipping rectangle has a margin of a few pixels, so that    */
+    /*      the edges it adds do not change the burnt pixels.               */
+    /* -------------------------------------------------------------------- */
+    OGRGeometryH hPolygonToBurn = hPolygon;
+    std::unique_ptr<OGRGeometry> poClippedCutline;
+#ifdef HAVE_GEOS
+    constexpr double CLIP_MARGIN = 2.0;
+    if (psPrepared && (sEnvelope.MinX < nXOff - CLIP_MARGIN ||
+                       sEnvelope.MinY < nYOff - CLIP_MARGIN ||
+                       sEnvelope.MaxX > nXOff + nXSize + CLIP_MARGIN ||
+                       sEnvelope.MaxY > nYOff + nYSize + CLIP_MARGIN))
+    {
+        std::lock_guard<std::mutex> oLock(psPrepared->oMutex);
+        GEOSGeom hGEOSClipped = GEOSClipByRect_r(
+            psPrepared->hGEOSCtxt, psPrepared->hGEOSCutline,
+            nXOff - CLIP_MARGIN, nYOff - CLIP_MARGIN,
+            nXOff + nXSize + CLIP_MARGIN, nYOff + nYSize + CLIP_MARGIN);
+        if (hGEOSClipped)
+        {
+            poClippedCutline.reset(OGRGeometryFactory::createFromGEOS(
+                psPrepared->hGEOSCtxt, hGEOSClipped));
+            GEOSGeom_destroy_r(psPrepared->hGEOSCtxt, hGEOSClipped);
+        }
     }
+    // Clipping may produce lower dimension parts if the cutline only touches
+    // the clipping rectangle: keep the full cutline in that case.
+    if (poClippedCutline &&
+        (wkbFlatten(poClippedCutline->getGeometryType()) == wkbPolygon ||
+         wkbFlatten(poClippedCutline->getGeometryType()) == wkbMultiPolygon))
+    {
+        hPolygonToBurn = OGRGeometry::ToHandle(poClippedCutline.get());
+    }
+#endif
 
     /* -------------------------------------------------------------------- */
     /*      Create a byte buffer into which we can burn the                 */
@@ -385,8 +559,8 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
     int anXYOff[2] = {nXOff, nYOff};
 
     CPLErr eErr = GDALRasterizeGeometries(
-        hMemDS, 1, &nTargetBand, 1, &hPolygon, CutlineTransformer, anXYOff,
-        &dfBurnValue, papszRasterizeOptions, nullptr, nullptr);
+        hMemDS, 1, &nTargetBand, 1, &hPolygonToBurn, CutlineTransformer,
+        anXYOff, &dfBurnValue, papszRasterizeOptions, nullptr, nullptr);
 
     CSLDestroy(papszRasterizeOptions);
 
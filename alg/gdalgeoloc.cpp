@@ -43,11 +43,15 @@
 
 #include <algorithm>
 #include <limits>
+#include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_minixml.h"
+#include "cpl_multiproc.h"
 #include "cpl_quad_tree.h"
+#include "cpl_sha256.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
@@ -1005,6 +1009,254 @@ void GDALInverseBilinearInterpolation(const double x, const double y,
     j += s;
 }
 
+/************************************************************************/
+/*                 GDALGeoLocGetBackMapCacheFilename()                  */
+/************************************************************************/
+
+constexpr const char BACKMAP_CACHE_MAGIC[] = "GDALBMP1";
+constexpr int BACKMAP_CACHE_MAGIC_SIZE = 8;
+constexpr int BACKMAP_CACHE_HEADER_SIZE =
+    BACKMAP_CACHE_MAGIC_SIZE + 2 * static_cast<int>(sizeof(GInt32)) +
+    6 * static_cast<int>(sizeof(double));
+
+// Returns the name of the file into which the backmap of psTransform is
+// cached, or an empty string if it cannot be determined. The name is a hash
+// of the parameters that affect the backmap and of the content of the
+// geolocation arrays, so that a modified geolocation array never hits a
+// stale cache entry.
+static std::string
+GDALGeoLocGetBackMapCacheFilename(const GDALGeoLocTransformInfo *psTransform)
+{
+    CPL_SHA256Context sContext;
+    CPL_SHA256Init(&sContext);
+
+    const std::string osParams(CPLSPrintf(
+        "magic=%s,lsb=%d,size=%dx%d,pixel_offset=%.17g,pixel_step=%.17g,"
+        "line_offset=%.17g,line_step=%.17g,oversample=%.17g,top_left=%d,"
+        "has_nodata=%d,nodata=%.17g,swap_xy=%d,geographic_180=%d",
+        BACKMAP_CACHE_MAGIC, CPL_IS_LSB, psTransform->nGeoLocXSize,
+        psTransform->nGeoLocYSize, psTransform->dfPIXEL_OFFSET,
+        psTransform->dfPIXEL_STEP, psTransform->dfLINE_OFFSET,
+        psTransform->dfLINE_STEP, psTransform->dfOversampleFactor,
+        static_cast<int>(psTransform->bOriginIsTopLeftCorner),
+        psTransform->bHasNoData, psTransform->dfNoDataX, psTransform->bSwapXY,
+        static_cast<int>(
+            psTransform->bGeographicSRSWithMinus180Plus180LongRange)));
+    CPL_SHA256Update(&sContext, osParams.data(), osParams.size());
+
+    for (GDALRasterBandH hBand : {psTransform->hBand_X, psTransform->hBand_Y})
+    {
+        const int nBandXSize = GDALGetRasterBandXSize(hBand);
+        const int nBandYSize = GDALGetRasterBandYSize(hBand);
+        const int nLinesPerChunk =
+            std::max(1, std::min(nBandYSize, 1024 * 1024 / nBandXSize));
+        std::vector<double> adfValues;
+        try
+        {
+            adfValues.resize(static_cast<size_t>(nBandXSize) * nLinesPerChunk);
+        }
+        catch (const std::exception &)
+        {
+            return std::string();
+        }
+        for (int iY = 0; iY < nBandYSize; iY += nLinesPerChunk)
+        {
+            const int nLines = std::min(nLinesPerChunk, nBandYSize - iY);
+            if (GDALRasterIO(hBand, GF_Read, 0, iY, nBandXSize, nLines,
+                             adfValues.data(), nBandXSize, nLines, GDT_Float64,
+                             0, 0) != CE_None)
+            {
+                return std::string();
+            }
+            CPL_SHA256Update(&sContext, adfValues.data(),
+                             static_cast<size_t>(nBandXSize) * nLines *
+                                 sizeof(double));
+        }
+    }
+
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256Final(&sContext, abyHash);
+    char *pszHex = CPLBinaryToHex(CPL_SHA256_HASH_SIZE, abyHash);
+    const std::string osFilename(
+        CPLFormFilename(psTransform->pszBackMapCacheDir,
+                        CPLSPrintf("geoloc_backmap_%s", pszHex), "bin"));
+    CPLFree(pszHex);
+    return osFilename;
+}
+
+/************************************************************************/
+/*                  GDALGeoLocOpenBackMapCacheFile()                    */
+/************************************************************************/
+
+// Opens a cached backmap and checks that its header and size are consistent
+// with the backmap dimensions and geotransform already computed in
+// psTransform. On success, the returned file is positioned at the start of
+// the backmap values.
+static VSILFILE *
+GDALGeoLocOpenBackMapCacheFile(const GDALGeoLocTransformInfo *psTransform,
+                               const std::string &osFilename)
+{
+    VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "rb");
+    if (fp == nullptr)
+        return nullptr;
+
+    char achMagic[BACKMAP_CACHE_MAGIC_SIZE] = {};
+    GInt32 anSize[2] = {0, 0};
+    double adfGeoTransform[6] = {0, 0, 0, 0, 0, 0};
+    bool bOK = VSIFReadL(achMagic, sizeof(achMagic), 1, fp) == 1 &&
+               VSIFReadL(anSize, sizeof(anSize), 1, fp) == 1 &&
+               VSIFReadL(adfGeoTransform, sizeof(adfGeoTransform), 1, fp) == 1;
+    bOK = bOK &&
+          memcmp(achMagic, BACKMAP_CACHE_MAGIC, BACKMAP_CACHE_MAGIC_SIZE) ==
+              0 &&
+          anSize[0] == psTransform->nBackMapWidth &&
+          anSize[1] == psTransform->nBackMapHeight &&
+          memcmp(adfGeoTransform, psTransform->adfBackMapGeoTransform,
+                 sizeof(adfGeoTransform)) == 0;
+    if (bOK)
+    {
+        const vsi_l_offset nExpectedSize =
+            BACKMAP_CACHE_HEADER_SIZE +
+            2 * static_cast<vsi_l_offset>(anSize[0]) * anSize[1] *
+                sizeof(float);
+        bOK = VSIFSeekL(fp, 0, SEEK_END) == 0 &&
+              VSIFTellL(fp) == nExpectedSize &&
+              VSIFSeekL(fp, BACKMAP_CACHE_HEADER_SIZE, SEEK_SET) == 0;
+    }
+    if (!bOK)
+    {
+        CPLDebug("GEOLOC", "Ignoring invalid backmap cache file %s",
+                 osFilename.c_str());
+        VSIFCloseL(fp);
+        return nullptr;
+    }
+    return fp;
+}
+
+/************************************************************************/
+/*                        LoadBackMapFromCache()                        */
+/************************************************************************/
+
+template <class Accessors>
+bool GDALGeoLoc<Accessors>::LoadBackMapFromCache(
+    GDALGeoLocTransformInfo *psTransform, VSILFILE *fp)
+{
+    auto pAccessors = static_cast<Accessors *>(psTransform->pAccessors);
+    if (!pAccessors->AllocateBackMap())
+        return false;
+    pAccessors->FreeWghtsBackMap();
+
+    const int nBMXSize = psTransform->nBackMapWidth;
+    const int nBMYSize = psTransform->nBackMapHeight;
+    const int nLinesPerChunk =
+        std::max(1, std::min(nBMYSize, 1024 * 1024 / nBMXSize));
+    std::vector<float> afValues;
+    try
+    {
+        afValues.resize(static_cast<size_t>(nBMXSize) * nLinesPerChunk);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory while loading cached backmap");
+        return false;
+    }
+
+    auto poBackmapDS = pAccessors->GetBackmapDataset();
+    bool bOK = true;
+    for (int i = 1; bOK && i <= 2; i++)
+    {
+        auto poBand = poBackmapDS->GetRasterBand(i);
+        for (int iY = 0; bOK && iY < nBMYSize; iY += nLinesPerChunk)
+        {
+            const int nLines = std::min(nLinesPerChunk, nBMYSize - iY);
+            const size_t nCount = static_cast<size_t>(nBMXSize) * nLines;
+            bOK = VSIFReadL(afValues.data(), sizeof(float), nCount, fp) ==
+                      nCount &&
+                  poBand->RasterIO(GF_Write, 0, iY, nBMXSize, nLines,
+                                   afValues.data(), nBMXSize, nLines,
+                                   GDT_Float32, 0, 0, nullptr) == CE_None;
+        }
+    }
+    pAccessors->ReleaseBackmapDataset(poBackmapDS);
+
+    if (!bOK)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot read cached backmap");
+    }
+    return bOK;
+}
+
+/************************************************************************/
+/*                         SaveBackMapToCache()                         */
+/************************************************************************/
+
+template <class Accessors>
+void GDALGeoLoc<Accessors>::SaveBackMapToCache(
+    const GDALGeoLocTransformInfo *psTransform, GDALDataset *poBackmapDS,
+    const std::string &osFilename)
+{
+    // Write into a temporary file that is renamed at the end, so that
+    // concurrent readers never see a partially written cache file.
+    const std::string osTmpFilename(
+        CPLSPrintf("%s." CPL_FRMT_GIB ".%p.tmp", osFilename.c_str(),
+                   CPLGetPID(), psTransform));
+    VSILFILE *fp = VSIFOpenL(osTmpFilename.c_str(), "wb");
+    if (fp == nullptr)
+    {
+        CPLDebug("GEOLOC", "Cannot create %s", osTmpFilename.c_str());
+        return;
+    }
+
+    const int nBMXSize = psTransform->nBackMapWidth;
+    const int nBMYSize = psTransform->nBackMapHeight;
+    const GInt32 anSize[2] = {nBMXSize, nBMYSize};
+    bool bOK =
+        VSIFWriteL(BACKMAP_CACHE_MAGIC, BACKMAP_CACHE_MAGIC_SIZE, 1, fp) == 1 &&
+        VSIFWriteL(anSize, sizeof(anSize), 1, fp) == 1 &&
+        VSIFWriteL(psTransform->adfBackMapGeoTransform,
+                   sizeof(psTransform->adfBackMapGeoTransform), 1, fp) == 1;
+
+    const int nLinesPerChunk =
+        std::max(1, std::min(nBMYSize, 1024 * 1024 / nBMXSize));
+    std::vector<float> afValues;
+    try
+    {
+        afValues.resize(static_cast<size_t>(nBMXSize) * nLinesPerChunk);
+    }
+    catch (const std::exception &)
+    {
+        bOK = false;
+    }
+    for (int i = 1; bOK && i <= 2; i++)
+    {
+        auto poBand = poBackmapDS->GetRasterBand(i);
+        for (int iY = 0; bOK && iY < nBMYSize; iY += nLinesPerChunk)
+        {
+            const int nLines = std::min(nLinesPerChunk, nBMYSize - iY);
+            const size_t nCount = static_cast<size_t>(nBMXSize) * nLines;
+            bOK = poBand->RasterIO(GF_Read, 0, iY, nBMXSize, nLines,
+                                   afValues.data(), nBMXSize, nLines,
+                                   GDT_Float32, 0, 0, nullptr) == CE_None &&
+                  VSIFWriteL(afValues.data(), sizeof(float), nCount, fp) ==
+                      nCount;
+        }
+    }
+    bOK = VSIFCloseL(fp) == 0 && bOK;
+
+    if (bOK && VSIRename(osTmpFilename.c_str(), osFilename.c_str()) == 0)
+    {
+        CPLDebug("GEOLOC", "Backmap saved in cache file %s",
+                 osFilename.c_str());
+    }
+    else
+    {
+        CPLDebug("GEOLOC", "Cannot write backmap cache file %s",
+                 osFilename.c_str());
+        VSIUnlink(osTmpFilename.c_str());
+    }
+}
+
 /************************************************************************/
 /*                       GeoLocGenerateBackMap()                        */
 /************************************************************************/
@@ -1082,6 +1334,27 @@ bool GDALGeoLoc<Accessors>::GenerateBackMap(
     psTransform->adfBackMapGeoTransform[4] = 0.0;
     psTransform->adfBackMapGeoTransform[5] = -dfPixelYSize;
 
+    /* -------------------------------------------------------------------- */
+    /*      Reuse a previously computed backmap if a cache is enabled.      */
+    /* -------------------------------------------------------------------- */
+    std::string osCacheFilename;
+    if (psTransform->pszBackMapCacheDir)
+    {
+        osCacheFilename = GDALGeoLocGetBackMapCacheFilename(psTransform);
+        VSILFILE *fpCache =
+            osCacheFilename.empty()
+                ? nullptr
+                : GDALGeoLocOpenBackMapCacheFile(psTransform, osCacheFilename);
+        if (fpCache)
+        {
+            CPLDebug("GEOLOC", "Loading backmap from cache file %s",
+                     osCacheFilename.c_str());
+            const bool bRet = LoadBackMapFromCache(psTransform, fpCache);
+            VSIFCloseL(fpCache);
+            return bRet;
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate backmap.                                               */
     /* -------------------------------------------------------------------- */
@@ -1572,6 +1845,12 @@ bool GDALGeoLoc<Accessors>::GenerateBackMap(
     }
 #endif
 
+    if (!osCacheFilename.empty())
+    {
+        pAccessors->FlushBackmapCaches();
+        SaveBackMapToCache(psTransform, poBackmapDS, osCacheFilename);
+    }
+
     pAccessors->ReleaseBackmapDataset(poBackmapDS);
     CPLDebug("GEOLOC", "Ending backmap generation");
 
@@ -1620,10 +1899,18 @@ static void *GDALCreateSimilarGeoLocTransformer(void *hTransformArg,
                           1.0);
     }
 
-    auto psInfoNew =
-        static_cast<GDALGeoLocTransformInfo *>(GDALCreateGeoLocTransformer(
-            nullptr, papszGeolocationInfo, psInfo->bReversed));
-    psInfoNew->dfOversampleFactor = psInfo->dfOversampleFactor;
+    CPLStringList aosTransformOptions;
+    aosTransformOptions.SetNameValue(
+        "GEOLOC_BACKMAP_OVERSAMPLE_FACTOR",
+        CPLSPrintf("%.17g", psInfo->dfOversampleFactor));
+    if (psInfo->pszBackMapCacheDir)
+        aosTransformOptions.SetNameValue("GEOLOC_BACKMAP_CACHE_DIR",
+                                         psInfo->pszBackMapCacheDir);
+
+    auto psInfoNew = static_cast<GDALGeoLocTransformInfo *>(
+        GDALCreateGeoLocTransformerEx(nullptr, papszGeolocationInfo,
+                                      psInfo->bReversed, nullptr,
+                                      aosTransformOptions.List()));
 
     CSLDestroy(papszGeolocationInfo);
 
@@ -1792,6 +2079,12 @@ void *GDALCreateGeoLocTransformerEx(GDALDatasetH hBaseDS,
                      CPLGetConfigOption("GDAL_GEOLOC_BACKMAP_OVERSAMPLE_FACTOR",
                                         "1.3")))));
 
+    const char *pszBackMapCacheDir = CSLFetchNameValueDef(
+        papszTransformOptions, "GEOLOC_BACKMAP_CACHE_DIR",
+        CPLGetConfigOption("GDAL_GEOLOC_BACKMAP_CACHE_DIR", nullptr));
+    if (pszBackMapCacheDir && pszBackMapCacheDir[0])
+        psTransform->pszBackMapCacheDir = CPLStrdup(pszBackMapCacheDir);
+
     memcpy(psTransform->sTI.abySignature, GDAL_GTI2_SIGNATURE,
            strlen(GDAL_GTI2_SIGNATURE));
     psTransform->sTI.pszClassName = "GDALGeoLocTransformer";
@@ -2063,6 +2356,7 @@ void GDALDestroyGeoLocTransformer(void *pTransformAlg)
         static_cast<GDALGeoLocTransformInfo *>(pTransformAlg);
 
     CSLDestroy(psTransform->papszGeolocationInfo);
+    CPLFree(psTransform->pszBackMapCacheDir);
 
     if (psTransform->bUseArray)
         delete static_cast<GDALGeoLocCArrayAccessors *>(
@@ -30,6 +30,11 @@
 #define GDALGEOLOC_H
 
 #include "gdal_alg_priv.h"
+#include "cpl_vsi.h"
+
+#include <string>
+
+class GDALDataset;
 
 /************************************************************************/
 /*                           GDALGeoLoc                                 */
@@ -43,6 +48,13 @@ template <class Accessors> struct GDALGeoLoc
 
     static bool GenerateBackMap(GDALGeoLocTransformInfo *psTransform);
 
+    static bool LoadBackMapFromCache(GDALGeoLocTransformInfo *psTransform,
+                                     VSILFILE *fp);
+
+    static void SaveBackMapToCache(const GDALGeoLocTransformInfo *psTransform,
+                                   GDALDataset *poBackmapDS,
+                                   const std::string &osFilename);
+
     static bool PixelLineToXY(const GDALGeoLocTransformInfo *psTransform,
                               const int nGeoLocPixel, const int nGeoLocLine,
                               double &dfX, double &dfY);
@@ -41,6 +41,7 @@
 #include <map>
 #include <utility>
 #include <algorithm>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_cpu_features.h"
@@ -72,6 +73,108 @@ static void GDALGridGetPointBounds(const void *hFeature, CPLRectObj *pBounds)
     pBounds->maxy = dfY;
 }
 
+/************************************************************************/
+/*                        GDALGridBatchSearch                           */
+/************************************************************************/
+
+// Consecutive grid nodes of a line have largely overlapping search
+// rectangles. Rather than walking the quadtree for each node, a single search
+// is done for a rectangle extended along the line, and the points of each
+// node are then filtered from that batch. As CPLQuadTreeSearch() returns
+// points in the order of a depth-first traversal of the tree, filtering a
+// larger search preserves that order, so results are unchanged.
+struct GDALGridBatchSearch
+{
+    // X of the last grid node of the line being processed.
+    double dfLineLastX = 0;
+    bool bValid = false;
+    CPLRectObj sAoi{0, 0, 0, 0};
+
+    struct BatchPoint
+    {
+        double dfX;
+        double dfY;
+        GDALGridPoint *psPoint;
+    };
+
+    std::vector<BatchPoint> asBatchPoints{};
+    std::vector<GDALGridPoint *> apsPoints{};
+};
+
+/************************************************************************/
+/*                       GDALGridQuadTreeSearch()                       */
+/************************************************************************/
+
+// Same as CPLQuadTreeSearch(), using the batched search if available.
+// The result must be released with GDALGridQuadTreeSearchFree().
+static void **GDALGridQuadTreeSearch(GDALGridExtraParameters *psExtraParams,
+                                     const CPLRectObj *psAoi,
+                                     int *pnFeatureCount)
+{
+    GDALGridBatchSearch *psBatch = psExtraParams->psBatchSearch;
+    if (psBatch == nullptr)
+        return CPLQuadTreeSearch(psExtraParams->hQuadTree, psAoi,
+                                 pnFeatureCount);
+
+    if (!psBatch->bValid || psAoi->minx < psBatch->sAoi.minx ||
+        psAoi->maxx > psBatch->sAoi.maxx || psAoi->miny < psBatch->sAoi.miny ||
+        psAoi->maxy > psBatch->sAoi.maxy)
+    {
+        // Extend the rectangle towards the end of the line, by its own width,
+        // so that it covers the search rectangles of the next nodes.
+        psBatch->sAoi = *psAoi;
+        const double dfWidth = psAoi->maxx - psAoi->minx;
+        const double dfCenterX = (psAoi->minx + psAoi->maxx) / 2;
+        if (psBatch->dfLineLastX >= dfCenterX)
+            psBatch->sAoi.maxx +=
+                std::min(dfWidth, psBatch->dfLineLastX - dfCenterX);
+        else
+            psBatch->sAoi.minx -=
+                std::min(dfWidth, dfCenterX - psBatch->dfLineLastX);
+
+        int nBatchCount = 0;
+        GDALGridPoint **papsBatchPoints = reinterpret_cast<GDALGridPoint **>(
+            CPLQuadTreeSearch(psExtraParams->hQuadTree, &psBatch->sAoi,
+                              &nBatchCount));
+        psBatch->asBatchPoints.resize(nBatchCount);
+        for (int i = 0; i < nBatchCount; i++)
+        {
+            GDALGridPoint *psPoint = papsBatchPoints[i];
+            psBatch->asBatchPoints[i].dfX =
+                psPoint->psXYArrays->padfX[psPoint->i];
+            psBatch->asBatchPoints[i].dfY =
+                psPoint->psXYArrays->padfY[psPoint->i];
+            psBatch->asBatchPoints[i].psPoint = psPoint;
+        }
+        CPLFree(papsBatchPoints);
+        psBatch->bValid = true;
+    }
+
+    psBatch->apsPoints.clear();
+    for (const auto &sBatchPoint : psBatch->asBatchPoints)
+    {
+        // Same test as CPLQuadTreeSearch() with GDALGridGetPointBounds()
+        if (sBatchPoint.dfX >= psAoi->minx && sBatchPoint.dfX <= psAoi->maxx &&
+            sBatchPoint.dfY >= psAoi->miny && sBatchPoint.dfY <= psAoi->maxy)
+        {
+            psBatch->apsPoints.push_back(sBatchPoint.psPoint);
+        }
+    }
+    *pnFeatureCount = static_cast<int>(psBatch->apsPoints.size());
+    return reinterpret_cast<void **>(psBatch->apsPoints.data());
+}
+
+/************************************************************************/
+/*                     GDALGridQuadTreeSearchFree()                     */
+/************************************************************************/
+
+static void GDALGridQuadTreeSearchFree(GDALGridExtraParameters *psExtraParams,
+                                       void *papsPoints)
+{
+    if (psExtraParams->psBatchSearch == nullptr)
+        GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
+}
+
 /************************************************************************/
 /*                   GDALGridInverseDistanceToAPower()                  */
 /************************************************************************/
@@ -273,13 +376,12 @@ CPLErr GDALGridInverseDistanceToAPowerNearestNeighbor(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->hQuadTree);
 
     const double dfRPower2 = psExtraParams->dfRadiusPower2PreComp;
     const double dfPowerDiv2 = psExtraParams->dfPowerDiv2PreComp;
 
-    std::multimap<double, double> oMapDistanceToZValues;
+    std::vector<std::pair<double, double>> aoDistanceAndZValues;
 
     const double dfSearchRadius = dfRadius;
     CPLRectObj sAoi;
@@ -289,7 +391,7 @@ CPLErr GDALGridInverseDistanceToAPowerNearestNeighbor(
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
     GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount));
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
@@ -304,33 +406,35 @@ CPLErr GDALGridInverseDistanceToAPowerNearestNeighbor(
             if (dfRsmoothed2 < 0.0000000000001)
             {
                 *pdfValue = padfZ[i];
-                CPLFree(papsPoints);
+                GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
                 return CE_None;
             }
             // is point within real distance?
             if (dfR2 <= dfRPower2)
             {
-                oMapDistanceToZValues.insert(
-                    std::make_pair(dfRsmoothed2, padfZ[i]));
+                aoDistanceAndZValues.emplace_back(dfRsmoothed2, padfZ[i]);
             }
         }
     }
-    CPLFree(papsPoints);
+    GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
+
+    // Sort by distance. A stable sort keeps points at the same distance in
+    // the order of the search, as a std::multimap would.
+    std::stable_sort(aoDistanceAndZValues.begin(), aoDistanceAndZValues.end(),
+                     [](const std::pair<double, double> &a,
+                        const std::pair<double, double> &b)
+                     { return a.first < b.first; });
 
     double dfNominator = 0.0;
     double dfDenominator = 0.0;
     GUInt32 n = 0;
 
-    // Examine all "neighbors" within the radius (sorted by distance via the
-    // multimap), and use the closest n points based on distance until the max
-    // is reached.
-    for (std::multimap<double, double>::iterator oMapDistanceToZValuesIter =
-             oMapDistanceToZValues.begin();
-         oMapDistanceToZValuesIter != oMapDistanceToZValues.end();
-         ++oMapDistanceToZValuesIter)
+    // Examine all "neighbors" within the radius (sorted by distance), and use
+    // the closest n points based on distance until the max is reached.
+    for (const auto &oDistanceAndZValue : aoDistanceAndZValues)
     {
-        const double dfR2 = oMapDistanceToZValuesIter->first;
-        const double dfZ = oMapDistanceToZValuesIter->second;
+        const double dfR2 = oDistanceAndZValue.first;
+        const double dfZ = oDistanceAndZValue.second;
 
         const double dfW = pow(dfR2, dfPowerDiv2);
         const double dfInvW = 1.0 / dfW;
@@ -382,8 +486,7 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->hQuadTree);
 
     const double dfRPower2 = psExtraParams->dfRadiusPower2PreComp;
     const double dfPowerDiv2 = psExtraParams->dfPowerDiv2PreComp;
@@ -397,7 +500,7 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
     GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount));
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
@@ -412,7 +515,7 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
             if (dfRsmoothed2 < 0.0000000000001)
             {
                 *pdfValue = padfZ[i];
-                CPLFree(papsPoints);
+                GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
                 return CE_None;
             }
             // is point within real distance?
@@ -425,7 +528,7 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
+    GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -683,7 +786,7 @@ CPLErr GDALGridMovingAverage(const void *poOptionsIn, GUInt32 nPoints,
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
         GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+            GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount));
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
@@ -701,7 +804,7 @@ CPLErr GDALGridMovingAverage(const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-        CPLFree(papsPoints);
+        GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
     }
     else
     {
@@ -765,8 +868,7 @@ static CPLErr GDALGridMovingAveragePerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->hQuadTree);
 
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
@@ -779,7 +881,7 @@ static CPLErr GDALGridMovingAveragePerQuadrant(
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
     GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount));
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
@@ -800,7 +902,7 @@ static CPLErr GDALGridMovingAveragePerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
+    GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -936,7 +1038,7 @@ CPLErr GDALGridNearestNeighbor(const void *poOptionsIn, GUInt32 nPoints,
             sAoi.maxy = dfYPoint + dfSearchRadius;
             int nFeatureCount = 0;
             GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-                CPLQuadTreeSearch(hQuadTree, &sAoi, &nFeatureCount));
+                GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount));
             if (nFeatureCount != 0)
             {
                 // Nearest distance will be initialized with the distance to the
@@ -956,11 +1058,11 @@ CPLErr GDALGridNearestNeighbor(const void *poOptionsIn, GUInt32 nPoints,
                     }
                 }
 
-                CPLFree(papsPoints);
+                GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
                 break;
             }
 
-            CPLFree(papsPoints);
+            GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
             if (poOptions->dfRadius1 > 0 || poOptions->dfRadius2 > 0)
                 break;
             dfSearchRadius *= 2;
@@ -1086,7 +1188,7 @@ CPLErr GDALGridDataMetricMinimum(const void *poOptionsIn, GUInt32 nPoints,
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
         GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+            GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount));
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
@@ -1105,7 +1207,7 @@ CPLErr GDALGridDataMetricMinimum(const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-        CPLFree(papsPoints);
+        GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
     }
     else
     {
@@ -1179,8 +1281,7 @@ static CPLErr GDALGridDataMetricMinimumOrMaximumPerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->hQuadTree);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
@@ -1189,7 +1290,7 @@ static CPLErr GDALGridDataMetricMinimumOrMaximumPerQuadrant(
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
     GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount));
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
@@ -1212,7 +1313,7 @@ static CPLErr GDALGridDataMetricMinimumOrMaximumPerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
+    GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -1380,7 +1481,7 @@ CPLErr GDALGridDataMetricMaximum(const void *poOptionsIn, GUInt32 nPoints,
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
         GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+            GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount));
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
@@ -1399,7 +1500,7 @@ CPLErr GDALGridDataMetricMaximum(const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-        CPLFree(papsPoints);
+        GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
     }
     else
     {
@@ -1537,7 +1638,7 @@ CPLErr GDALGridDataMetricRange(const void *poOptionsIn, GUInt32 nPoints,
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
         GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+            GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount));
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
@@ -1558,7 +1659,7 @@ CPLErr GDALGridDataMetricRange(const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-        CPLFree(papsPoints);
+        GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
     }
     else
     {
@@ -1632,8 +1733,7 @@ static CPLErr GDALGridDataMetricRangePerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->hQuadTree);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
@@ -1642,7 +1742,7 @@ static CPLErr GDALGridDataMetricRangePerQuadrant(
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
     GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount));
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
@@ -1665,7 +1765,7 @@ static CPLErr GDALGridDataMetricRangePerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
+    GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -1807,7 +1907,7 @@ CPLErr GDALGridDataMetricCount(const void *poOptionsIn, GUInt32 nPoints,
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
         GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+            GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount));
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
@@ -1824,7 +1924,7 @@ CPLErr GDALGridDataMetricCount(const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-        CPLFree(papsPoints);
+        GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
     }
     else
     {
@@ -1894,8 +1994,7 @@ static CPLErr GDALGridDataMetricCountPerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->hQuadTree);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
@@ -1904,7 +2003,7 @@ static CPLErr GDALGridDataMetricCountPerQuadrant(
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
     GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount));
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
@@ -1927,7 +2026,7 @@ static CPLErr GDALGridDataMetricCountPerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
+    GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -2068,7 +2167,7 @@ CPLErr GDALGridDataMetricAverageDistance(const void *poOptionsIn,
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
         GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+            GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount));
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
@@ -2086,7 +2185,7 @@ CPLErr GDALGridDataMetricAverageDistance(const void *poOptionsIn,
                 }
             }
         }
-        CPLFree(papsPoints);
+        GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
     }
     else
     {
@@ -2158,8 +2257,7 @@ static CPLErr GDALGridDataMetricAverageDistancePerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->hQuadTree);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
@@ -2168,7 +2266,7 @@ static CPLErr GDALGridDataMetricAverageDistancePerQuadrant(
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
     GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount));
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
@@ -2191,7 +2289,7 @@ static CPLErr GDALGridDataMetricAverageDistancePerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
+    GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -2334,7 +2432,7 @@ CPLErr GDALGridDataMetricAverageDistancePts(
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
         GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+            GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount));
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount - 1; k++)
@@ -2369,7 +2467,7 @@ CPLErr GDALGridDataMetricAverageDistancePts(
                 }
             }
         }
-        CPLFree(papsPoints);
+        GDALGridQuadTreeSearchFree(psExtraParams, papsPoints);
     }
     else
     {
@@ -2660,9 +2758,15 @@ static void GDALGridJobProcess(void *user_data)
     const int nDataTypeSize = GDALGetDataTypeSizeBytes(eType);
     const int nLineSpace = nXSize * nDataTypeSize;
 
+    GDALGridBatchSearch sBatchSearch;
+    if (sExtraParameters.hQuadTree != nullptr)
+        sExtraParameters.psBatchSearch = &sBatchSearch;
+
     for (GUInt32 nYPoint = nYStart; nYPoint < nYSize; nYPoint += nYStep)
     {
         const double dfYPoint = dfYMin + (nYPoint + 0.5) * dfDeltaY;
+        sBatchSearch.dfLineLastX = dfXMin + (nXSize - 1 + 0.5) * dfDeltaX;
+        sBatchSearch.bValid = false;
 
         for (GUInt32 nXPoint = 0; nXPoint < nXSize; nXPoint++)
         {
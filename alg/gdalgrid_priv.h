@@ -49,6 +49,8 @@ typedef struct
     int i;
 } GDALGridPoint;
 
+struct GDALGridBatchSearch;
+
 typedef struct
 {
     CPLQuadTree *hQuadTree;
@@ -62,6 +64,9 @@ typedef struct
     double dfPowerDiv2PreComp;
     /*! The radius of search circle squared (pre-computation). */
     double dfRadiusPower2PreComp;
+    /*! State of the quadtree searches batched along a line of grid nodes
+     *  (owned by GDALGridJobProcess()), or NULL. */
+    GDALGridBatchSearch *psBatchSearch;
 } GDALGridExtraParameters;
 
 #ifdef HAVE_SSE_AT_COMPILE_TIME
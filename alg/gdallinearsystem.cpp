@@ -45,13 +45,52 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <functional>
+#include <system_error>
+#include <thread>
 
 #ifndef HAVE_ARMADILLO
 namespace
 {
+// Number of columns factorized at once before the trailing columns are
+// updated.
+constexpr int LU_BLOCK_SIZE = 64;
+
+// Minimum number of matrix elements in the trailing part for the update to
+// be split among several threads.
+constexpr double LU_MIN_ELTS_PER_THREAD = 1024.0 * 1024;
+
+// Applies to columns [iColStart, iColEnd[ the elimination steps
+// [stepStart, stepEnd[ of the LU decomposition, in the same order as if
+// each step had been applied to the whole matrix.
+void applySteps(GDALMatrix &A, int stepStart, int stepEnd, int iColStart,
+                int iColEnd)
+{
+    const int m = A.getNumRows();
+    for (int iCol = iColStart; iCol < iColEnd; ++iCol)
+    {
+        // Matrix is stored in column major order
+        double *padfCol = &A(0, iCol);
+        for (int step = stepStart; step < stepEnd; ++step)
+        {
+            const double *padfL = &A(0, step);
+            const double dfU = padfCol[step];
+            for (int iRow = step + 1; iRow < m; ++iRow)
+            {
+                padfCol[iRow] -= padfL[iRow] * dfU;
+            }
+        }
+    }
+}
+
 // LU decomposition of the quadratic matrix A
 // see https://en.wikipedia.org/wiki/LU_decomposition#C_code_examples
-bool solve(GDALMatrix &A, GDALMatrix &RHS, GDALMatrix &X, double eps)
+// The elimination is done by blocks of LU_BLOCK_SIZE columns, so that the
+// update of the trailing columns, which dominates the computation time, is
+// cache friendly and can be split among several threads. The result is
+// identical to the unblocked algorithm.
+bool solve(GDALMatrix &A, GDALMatrix &RHS, GDALMatrix &X, double eps,
+           int nThreads)
 {
     assert(A.getNumRows() == A.getNumCols());
     if (eps < 0)
@@ -63,44 +102,79 @@ bool solve(GDALMatrix &A, GDALMatrix &RHS, GDALMatrix &X, double eps)
     for (int iRow = 0; iRow < m; ++iRow)
         perm[iRow] = iRow;
 
-    for (int step = 0; step < m - 1; ++step)
+    for (int blockStart = 0; blockStart < m - 1; blockStart += LU_BLOCK_SIZE)
     {
-        // determine pivot element
-        int iMax = step;
-        double dMax = std::abs(A(step, step));
-        for (int i = step + 1; i < m; ++i)
+        const int blockEnd = std::min(blockStart + LU_BLOCK_SIZE, m - 1);
+        for (int step = blockStart; step < blockEnd; ++step)
         {
-            if (std::abs(A(i, step)) > dMax)
+            // determine pivot element
+            int iMax = step;
+            double dMax = std::abs(A(step, step));
+            for (int i = step + 1; i < m; ++i)
             {
-                iMax = i;
-                dMax = std::abs(A(i, step));
+                if (std::abs(A(i, step)) > dMax)
+                {
+                    iMax = i;
+                    dMax = std::abs(A(i, step));
+                }
             }
-        }
-        if (dMax <= eps)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "GDALLinearSystemSolve: matrix not invertible");
-            return false;
-        }
-        // swap rows
-        if (iMax != step)
-        {
-            std::swap(perm[iMax], perm[step]);
-            for (int iCol = 0; iCol < m; ++iCol)
+            if (dMax <= eps)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "GDALLinearSystemSolve: matrix not invertible");
+                return false;
+            }
+            // swap rows
+            if (iMax != step)
             {
-                std::swap(A(iMax, iCol), A(step, iCol));
+                std::swap(perm[iMax], perm[step]);
+                for (int iCol = 0; iCol < m; ++iCol)
+                {
+                    std::swap(A(iMax, iCol), A(step, iCol));
+                }
             }
+            for (int iRow = step + 1; iRow < m; ++iRow)
+            {
+                A(iRow, step) /= A(step, step);
+            }
+            // update the remaining columns of the current block
+            applySteps(A, step, step + 1, step + 1, blockEnd);
         }
-        for (int iRow = step + 1; iRow < m; ++iRow)
+
+        // update the trailing columns with the steps of the current block
+        const int nTrailingCols = m - blockEnd;
+        const double dfTrailingElts =
+            static_cast<double>(nTrailingCols) * (m - blockStart);
+        const int nJobs = static_cast<int>(
+            std::min(static_cast<double>(std::min(nThreads, nTrailingCols)),
+                     dfTrailingElts / LU_MIN_ELTS_PER_THREAD));
+        if (nJobs <= 1)
         {
-            A(iRow, step) /= A(step, step);
+            applySteps(A, blockStart, blockEnd, blockEnd, m);
         }
-        for (int iCol = step + 1; iCol < m; ++iCol)
+        else
         {
-            for (int iRow = step + 1; iRow < m; ++iRow)
+            std::vector<std::thread> aoThreads;
+            int iColStart = blockEnd;
+            for (int iJob = 0; iJob < nJobs; ++iJob)
             {
-                A(iRow, iCol) -= A(iRow, step) * A(step, iCol);
+                const int iColEnd =
+                    blockEnd + (nTrailingCols / nJobs) * (iJob + 1) +
+                    std::min(nTrailingCols % nJobs, iJob + 1);
+                try
+                {
+                    aoThreads.emplace_back(applySteps, std::ref(A),
+                                           blockStart, blockEnd, iColStart,
+                                           iColEnd);
+                }
+                catch (const std::system_error &)
+                {
+                    applySteps(A, blockStart, blockEnd, iColStart, iColEnd);
+                }
+                iColStart = iColEnd;
             }
+            for (auto &oThread : aoThreads)
+                oThread.join();
         }
     }
 
@@ -133,8 +207,12 @@ bool solve(GDALMatrix &A, GDALMatrix &RHS, GDALMatrix &X, double eps)
 /*                                                                      */
 /*   Solves the linear system A*X_i = RHS_i for each column i           */
 /*   where A is a square matrix.                                        */
+/*                                                                      */
+/*   nThreads is the maximum number of threads that may be used by the  */
+/*   built-in LU decomposition, when GDAL is not built with Armadillo.  */
 /************************************************************************/
-bool GDALLinearSystemSolve(GDALMatrix &A, GDALMatrix &RHS, GDALMatrix &X)
+bool GDALLinearSystemSolve(GDALMatrix &A, GDALMatrix &RHS, GDALMatrix &X,
+                           int nThreads)
 {
     assert(A.getNumRows() == RHS.getNumRows());
     assert(A.getNumCols() == X.getNumRows());
@@ -146,6 +224,7 @@ bool GDALLinearSystemSolve(GDALMatrix &A, GDALMatrix &RHS, GDALMatrix &X)
         arma::mat matRHS(RHS.data(), RHS.getNumRows(), RHS.getNumCols(), false,
                          true);
         arma::mat matOut(X.data(), X.getNumRows(), X.getNumCols(), false, true);
+        CPL_IGNORE_RET_VAL(nThreads);
 #if ARMA_VERSION_MAJOR > 6 ||                                                  \
     (ARMA_VERSION_MAJOR == 6 && ARMA_VERSION_MINOR >= 500)
         // Perhaps available in earlier versions, but didn't check
@@ -157,7 +236,7 @@ bool GDALLinearSystemSolve(GDALMatrix &A, GDALMatrix &RHS, GDALMatrix &X)
 #endif
 
 #else  // HAVE_ARMADILLO
-        return solve(A, RHS, X, 0);
+        return solve(A, RHS, X, 0, nThreads);
 #endif
     }
     catch (std::exception const &e)
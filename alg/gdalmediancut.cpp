@@ -44,14 +44,19 @@
 #include <cstring>
 
 #include <algorithm>
+#include <exception>
 #include <limits>
+#include <mutex>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 template <typename T> static T *HISTOGRAM(T *h, int n, int r, int g, int b)
 {
@@ -138,6 +143,11 @@ static Colorbox *largest_box(Colorbox *usedboxes);
  * GDALProgressFunc() semantics.  May be NULL.
  * @param pProgressArg callback argument passed to pfnProgress.
  *
+ * Starting with GDAL 3.9, the histogram of the image can be collected by
+ * several threads, according to the GDAL_NUM_THREADS configuration option
+ * (an integer or ALL_CPUS). The resulting color table does not depend on the
+ * number of threads.
+ *
  * @return returns CE_None on success or CE_Failure if an error occurs.
  */
 
@@ -275,6 +285,227 @@ static inline int *FindAndInsertColorCount(HashHistogram *psHashHistogram,
     }
 }
 
+namespace
+{
+// State shared by the jobs of GDALMedianCutHistogramMultiThreaded().
+struct GDALMedianCutContext
+{
+    GDALRasterBandH hRed = nullptr;
+    GDALRasterBandH hGreen = nullptr;
+    GDALRasterBandH hBlue = nullptr;
+    int nXSize = 0;
+    int nYSize = 0;
+    int nColorShift = 0;
+    int nCLevels = 0;
+
+    // Protects the I/O on the bands, and the progress.
+    std::mutex oMutex{};
+    GDALProgressFunc pfnProgress = nullptr;
+    void *pProgressArg = nullptr;
+    int nLinesDone = 0;
+    bool bInterrupted = false;
+};
+
+// Horizontal strip of the image, with its own histogram and color bounds.
+template <class T> struct GDALMedianCutStrip
+{
+    GDALMedianCutContext *psContext = nullptr;
+    int nYOff = 0;
+    int nYSize = 0;
+    T *panHistogram = nullptr;
+    int rmin = 999;
+    int gmin = 999;
+    int bmin = 999;
+    int rmax = -1;
+    int gmax = -1;
+    int bmax = -1;
+    CPLErr eErr = CE_None;
+};
+}  // namespace
+
+/************************************************************************/
+/*                     GDALMedianCutStripJobFunc()                      */
+/************************************************************************/
+
+template <class T> static void GDALMedianCutStripJobFunc(void *pData)
+{
+    auto psStrip = static_cast<GDALMedianCutStrip<T> *>(pData);
+    GDALMedianCutContext *psContext = psStrip->psContext;
+    const int nXSize = psContext->nXSize;
+    const int nColorShift = psContext->nColorShift;
+    const int nCLevels = psContext->nCLevels;
+
+    // Read several lines at once to limit the time spent holding the mutex.
+    const int nChunkLines =
+        std::max(1, std::min(psStrip->nYSize, 1024 * 1024 / nXSize));
+    std::vector<GByte> abyRGB;
+    try
+    {
+        abyRGB.resize(static_cast<size_t>(nXSize) * nChunkLines * 3);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate histogram buffer");
+        psStrip->eErr = CE_Failure;
+        return;
+    }
+
+    for (int iLine = 0; iLine < psStrip->nYSize; iLine += nChunkLines)
+    {
+        const int nLines = std::min(nChunkLines, psStrip->nYSize - iLine);
+        const size_t nCount = static_cast<size_t>(nXSize) * nLines;
+        GByte *pabyRed = abyRGB.data();
+        GByte *pabyGreen = pabyRed + nCount;
+        GByte *pabyBlue = pabyGreen + nCount;
+        {
+            std::lock_guard<std::mutex> oLock(psContext->oMutex);
+            if (psContext->bInterrupted)
+            {
+                psStrip->eErr = CE_Failure;
+                return;
+            }
+            const int nYOff = psStrip->nYOff + iLine;
+            psStrip->eErr =
+                GDALRasterIO(psContext->hRed, GF_Read, 0, nYOff, nXSize,
+                             nLines, pabyRed, nXSize, nLines, GDT_Byte, 0, 0);
+            if (psStrip->eErr == CE_None)
+                psStrip->eErr = GDALRasterIO(psContext->hGreen, GF_Read, 0,
+                                             nYOff, nXSize, nLines, pabyGreen,
+                                             nXSize, nLines, GDT_Byte, 0, 0);
+            if (psStrip->eErr == CE_None)
+                psStrip->eErr = GDALRasterIO(psContext->hBlue, GF_Read, 0,
+                                             nYOff, nXSize, nLines, pabyBlue,
+                                             nXSize, nLines, GDT_Byte, 0, 0);
+            if (psStrip->eErr != CE_None)
+                return;
+        }
+
+        for (size_t i = 0; i < nCount; i++)
+        {
+            const int nRed = pabyRed[i] >> nColorShift;
+            const int nGreen = pabyGreen[i] >> nColorShift;
+            const int nBlue = pabyBlue[i] >> nColorShift;
+
+            psStrip->rmin = std::min(psStrip->rmin, nRed);
+            psStrip->gmin = std::min(psStrip->gmin, nGreen);
+            psStrip->bmin = std::min(psStrip->bmin, nBlue);
+            psStrip->rmax = std::max(psStrip->rmax, nRed);
+            psStrip->gmax = std::max(psStrip->gmax, nGreen);
+            psStrip->bmax = std::max(psStrip->bmax, nBlue);
+
+            (*HISTOGRAM(psStrip->panHistogram, nCLevels, nRed, nGreen,
+                        nBlue))++;
+        }
+
+        std::lock_guard<std::mutex> oLock(psContext->oMutex);
+        psContext->nLinesDone += nLines;
+        if (!psContext->bInterrupted &&
+            !psContext->pfnProgress(psContext->nLinesDone /
+                                        static_cast<double>(psContext->nYSize),
+                                    "Generating Histogram",
+                                    psContext->pProgressArg))
+        {
+            psContext->bInterrupted = true;
+        }
+    }
+}
+
+/************************************************************************/
+/*                 GDALMedianCutHistogramMultiThreaded()                */
+/************************************************************************/
+
+// Collect the histogram and the color bounds of the image by splitting it
+// into horizontal strips processed by nThreads threads, each one with its
+// own histogram. The strip histograms are then summed, so the result is the
+// same as the single-threaded collection.
+template <class T>
+static CPLErr GDALMedianCutHistogramMultiThreaded(
+    GDALRasterBandH hRed, GDALRasterBandH hGreen, GDALRasterBandH hBlue,
+    int nBits, int nThreads, T *histogram, Colorbox *box,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    GDALMedianCutContext sContext;
+    sContext.hRed = hRed;
+    sContext.hGreen = hGreen;
+    sContext.hBlue = hBlue;
+    sContext.nXSize = GDALGetRasterBandXSize(hRed);
+    sContext.nYSize = GDALGetRasterBandYSize(hRed);
+    sContext.nColorShift = 8 - nBits;
+    sContext.nCLevels = 1 << nBits;
+    sContext.pfnProgress = pfnProgress;
+    sContext.pProgressArg = pProgressArg;
+
+    const size_t nHistogramSize = static_cast<size_t>(sContext.nCLevels) *
+                                  sContext.nCLevels * sContext.nCLevels;
+    const int nStrips = std::min(nThreads, sContext.nYSize);
+    std::vector<GDALMedianCutStrip<T>> asStrips(nStrips);
+    std::vector<std::vector<T>> aanHistograms;
+    try
+    {
+        aanHistograms.resize(nStrips - 1);
+        for (auto &anHistogram : aanHistograms)
+            anHistogram.resize(nHistogramSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate per-thread histograms");
+        return CE_Failure;
+    }
+
+    for (int iStrip = 0; iStrip < nStrips; iStrip++)
+    {
+        auto &sStrip = asStrips[iStrip];
+        sStrip.psContext = &sContext;
+        sStrip.nYOff = static_cast<int>(static_cast<GIntBig>(sContext.nYSize) *
+                                        iStrip / nStrips);
+        sStrip.nYSize = static_cast<int>(static_cast<GIntBig>(sContext.nYSize) *
+                                         (iStrip + 1) / nStrips) -
+                        sStrip.nYOff;
+        sStrip.panHistogram =
+            iStrip == 0 ? histogram : aanHistograms[iStrip - 1].data();
+    }
+
+    auto poPool = GDALGetGlobalThreadPool(nThreads);
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    for (auto &sStrip : asStrips)
+    {
+        if (poQueue)
+            poQueue->SubmitJob(GDALMedianCutStripJobFunc<T>, &sStrip);
+        else
+            GDALMedianCutStripJobFunc<T>(&sStrip);
+    }
+    if (poQueue)
+        poQueue->WaitCompletion();
+
+    if (sContext.bInterrupted)
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User Terminated");
+        return CE_Failure;
+    }
+
+    for (int iStrip = 0; iStrip < nStrips; iStrip++)
+    {
+        const auto &sStrip = asStrips[iStrip];
+        if (sStrip.eErr != CE_None)
+            return CE_Failure;
+        box->rmin = std::min(box->rmin, sStrip.rmin);
+        box->gmin = std::min(box->gmin, sStrip.gmin);
+        box->bmin = std::min(box->bmin, sStrip.bmin);
+        box->rmax = std::max(box->rmax, sStrip.rmax);
+        box->gmax = std::max(box->gmax, sStrip.gmax);
+        box->bmax = std::max(box->bmax, sStrip.bmax);
+        if (iStrip > 0)
+        {
+            for (size_t i = 0; i < nHistogramSize; i++)
+                histogram[i] += sStrip.panHistogram[i];
+        }
+    }
+
+    return CE_None;
+}
+
 template <class T>
 int GDALComputeMedianCutPCTInternal(
     GDALRasterBandH hRed, GDALRasterBandH hGreen, GDALRasterBandH hBlue,
@@ -446,6 +677,28 @@ int GDALComputeMedianCutPCTInternal(
         goto end_and_cleanup;
     }
 
+    // The full table histogram can be collected by several threads, when
+    // colors are downsampled (otherwise each thread would need its own
+    // 2^24 entries table, and the order in which colors are found matters).
+    if (histogram != nullptr && nColorShift != 0 && nYSize > 1)
+    {
+        const char *pszNumThreads =
+            CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+        const int nThreads =
+            std::max(1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                                          ? CPLGetNumCPUs()
+                                          : atoi(pszNumThreads)));
+        if (nThreads > 1)
+        {
+            err = GDALMedianCutHistogramMultiThreaded(
+                hRed, hGreen, hBlue, nBits, nThreads, histogram, usedboxes,
+                pfnProgress, pProgressArg);
+            if (err != CE_None)
+                goto end_and_cleanup;
+            goto histogram_collected;
+        }
+    }
+
     for (int iLine = 0; iLine < nYSize; iLine++)
     {
         if (!pfnProgress(iLine / static_cast<double>(nYSize),
@@ -508,6 +761,7 @@ int GDALComputeMedianCutPCTInternal(
         }
     }
 
+histogram_collected:
     if (!pfnProgress(1.0, "Generating Histogram", pProgressArg))
     {
         CPLError(CE_Failure, CPLE_UserInterrupt, "User Terminated");
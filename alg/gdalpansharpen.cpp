@@ -1142,6 +1142,61 @@ static void ClampValues(T *panBuffer, size_t nValues, T nMaxVal)
     }
 }
 
+/************************************************************************/
+/*                       ClampUpsampledValues()                         */
+/************************************************************************/
+
+// In case NBITS was not set on the spectral bands, clamp the nValues values
+// of each band of pUpsampledSpectralBuffer (whose values are nBandValues
+// apart) if overshoot might have occurred.
+void GDALPansharpenOperation::ClampUpsampledValues(
+    GDALDataType eWorkDataType, void *pUpsampledSpectralBuffer, size_t nValues,
+    size_t nBandValues) const
+{
+    const GDALRIOResampleAlg eResampleAlg = psOptions->eResampleAlg;
+    const int nBitDepth = psOptions->nBitDepth;
+    if (nBitDepth &&
+        (eResampleAlg == GRIORA_Cubic || eResampleAlg == GRIORA_CubicSpline ||
+         eResampleAlg == GRIORA_Lanczos))
+    {
+        for (int i = 0; i < psOptions->nInputSpectralBands; i++)
+        {
+            GDALRasterBand *poBand = aMSBands[i];
+            int nBandBitDepth = 0;
+            const char *pszNBITS =
+                poBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
+            if (pszNBITS)
+                nBandBitDepth = atoi(pszNBITS);
+            if (nBandBitDepth < nBitDepth)
+            {
+                if (eWorkDataType == GDT_Byte)
+                {
+                    ClampValues(
+                        static_cast<GByte *>(pUpsampledSpectralBuffer) +
+                            static_cast<size_t>(i) * nBandValues,
+                        nValues, static_cast<GByte>((1 << nBitDepth) - 1));
+                }
+                else if (eWorkDataType == GDT_UInt16)
+                {
+                    ClampValues(
+                        static_cast<GUInt16 *>(pUpsampledSpectralBuffer) +
+                            static_cast<size_t>(i) * nBandValues,
+                        nValues, static_cast<GUInt16>((1 << nBitDepth) - 1));
+                }
+#ifndef LIMIT_TYPES
+                else if (eWorkDataType == GDT_UInt32)
+                {
+                    ClampValues(static_cast<GUInt32*>(pUpsampledSpectralBuffer) +
+                                static_cast<size_t>(i) * nBandValues,
+                                nValues,
+                                (static_cast<GUInt32>((1 << nBitDepth)-1));
+                }
+#endif
+            }
+        }
+    }
+}
+
 /************************************************************************/
 /*                         ProcessRegion()                              */
 /************************************************************************/
@@ -1238,6 +1293,20 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
     if (nSpectralYSize == 0)
         nSpectralYSize = 1;
 
+    // Wrapper of the multispectral data extracted at full resolution, when
+    // upsampling.
+    MEMDataset *poMEMDS = nullptr;
+    GByte *pSpectralBuffer = nullptr;
+    std::vector<GDALPansharpenResampleJob> asResampleJobs;
+    const auto FreeBuffers = [&]()
+    {
+        if (poMEMDS)
+            GDALClose(poMEMDS);
+        VSIFree(pSpectralBuffer);
+        VSIFree(pUpsampledSpectralBuffer);
+        VSIFree(pPanBuffer);
+    };
+
     // When upsampling, extract the multispectral data at
     // full resolution in a temp buffer, and then do the upsampling.
     if (nSpectralXSize < nXSize && nSpectralYSize < nYSize &&
@@ -1264,13 +1333,12 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
         if (nYOffExtract + nYSizeExtract > aMSBands[0]->GetYSize())
             nYSizeExtract = aMSBands[0]->GetYSize() - nYOffExtract;
 
-        GByte *pSpectralBuffer = static_cast<GByte *>(VSI_MALLOC3_VERBOSE(
+        pSpectralBuffer = static_cast<GByte *>(VSI_MALLOC3_VERBOSE(
             nXSizeExtract, nYSizeExtract,
             psOptions->nInputSpectralBands * nDataTypeSize));
         if (pSpectralBuffer == nullptr)
         {
-            VSIFree(pUpsampledSpectralBuffer);
-            VSIFree(pPanBuffer);
+            FreeBuffers();
             return CE_Failure;
         }
 
@@ -1298,15 +1366,13 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
         }
         if (eErr != CE_None)
         {
-            VSIFree(pSpectralBuffer);
-            VSIFree(pUpsampledSpectralBuffer);
-            VSIFree(pPanBuffer);
+            FreeBuffers();
             return CE_Failure;
         }
 
         // Create a MEM dataset that wraps the input buffer.
-        auto poMEMDS = MEMDataset::Create("", nXSizeExtract, nYSizeExtract, 0,
-                                          eWorkDataType, nullptr);
+        poMEMDS = MEMDataset::Create("", nXSizeExtract, nYSizeExtract, 0,
+                                     eWorkDataType, nullptr);
 
         for (int i = 0; i < psOptions->nInputSpectralBands; i++)
         {
@@ -1354,16 +1420,11 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
                 poMEMDS->GetRasterBand(i + 1)->GetMaskFlags();
             }
 
-            std::vector<GDALPansharpenResampleJob> asJobs;
-            asJobs.resize(nTasks);
-            GDALPansharpenResampleJob *pasJobs = &(asJobs[0]);
+            // The resampling is done by the pansharpening jobs themselves,
+            // on the lines they process.
+            asResampleJobs.resize(nTasks);
+            GDALPansharpenResampleJob *pasJobs = &(asResampleJobs[0]);
             {
-                std::vector<void *> ahJobData;
-                ahJobData.resize(nTasks);
-
-#ifdef DEBUG_TIMING
-                struct timeval tv;
-#endif
                 for (int i = 0; i < nTasks; i++)
                 {
                     const size_t iStartLine =
@@ -1411,23 +1472,9 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
                     pasJobs[i].nBandCount = psOptions->nInputSpectralBands;
                     pasJobs[i].nBandSpace =
                         static_cast<GSpacing>(nXSize) * nYSize * nDataTypeSize;
-#ifdef DEBUG_TIMING
-                    pasJobs[i].ptv = &tv;
-#endif
-                    ahJobData[i] = &(pasJobs[i]);
                 }
-#ifdef DEBUG_TIMING
-                gettimeofday(&tv, nullptr);
-#endif
-                poThreadPool->SubmitJobs(PansharpenResampleJobThreadFunc,
-                                         ahJobData);
-                poThreadPool->WaitCompletion();
             }
         }
-
-        GDALClose(poMEMDS);
-
-        VSIFree(pSpectralBuffer);
     }
     else
     {
@@ -1462,51 +1509,16 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
     }
 
     // In case NBITS was not set on the spectral bands, clamp the values
-    // if overshoot might have occurred.
-    int nBitDepth = psOptions->nBitDepth;
-    if (nBitDepth &&
-        (eResampleAlg == GRIORA_Cubic || eResampleAlg == GRIORA_CubicSpline ||
-         eResampleAlg == GRIORA_Lanczos))
+    // if overshoot might have occurred. When the resampling is deferred to
+    // the pansharpening jobs, they do it themselves.
+    if (asResampleJobs.empty())
     {
-        for (int i = 0; i < psOptions->nInputSpectralBands; i++)
-        {
-            GDALRasterBand *poBand = aMSBands[i];
-            int nBandBitDepth = 0;
-            const char *pszNBITS =
-                poBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
-            if (pszNBITS)
-                nBandBitDepth = atoi(pszNBITS);
-            if (nBandBitDepth < nBitDepth)
-            {
-                if (eWorkDataType == GDT_Byte)
-                {
-                    ClampValues(
-                        reinterpret_cast<GByte *>(pUpsampledSpectralBuffer) +
-                            static_cast<size_t>(i) * nXSize * nYSize,
-                        static_cast<size_t>(nXSize) * nYSize,
-                        static_cast<GByte>((1 << nBitDepth) - 1));
-                }
-                else if (eWorkDataType == GDT_UInt16)
-                {
-                    ClampValues(
-                        reinterpret_cast<GUInt16 *>(pUpsampledSpectralBuffer) +
-                            static_cast<size_t>(i) * nXSize * nYSize,
-                        static_cast<size_t>(nXSize) * nYSize,
-                        static_cast<GUInt16>((1 << nBitDepth) - 1));
-                }
-#ifndef LIMIT_TYPES
-                else if (eWorkDataType == GDT_UInt32)
-                {
-                    ClampValues(reinterpret_cast<GUInt32*>(pUpsampledSpectralBuffer) +
-                                static_cast<size_t>(i) * nXSize * nYSize,
-                                static_cast<size_t>(nXSize)*nYSize,
-                                (static_cast<GUInt32>((1 << nBitDepth)-1));
-                }
-#endif
-            }
-        }
+        ClampUpsampledValues(eWorkDataType, pUpsampledSpectralBuffer,
+                             static_cast<size_t>(nXSize) * nYSize,
+                             static_cast<size_t>(nXSize) * nYSize);
     }
 
+    const int nBitDepth = psOptions->nBitDepth;
     GUInt32 nMaxValue = (1 << nBitDepth) - 1;
 
     double *padfTempBuffer = nullptr;
@@ -1523,8 +1535,7 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
             nXSize, nYSize, psOptions->nOutPansharpenedBands * sizeof(double)));
         if (padfTempBuffer == nullptr)
         {
-            VSIFree(pUpsampledSpectralBuffer);
-            VSIFree(pPanBuffer);
+            FreeBuffers();
             return CE_Failure;
         }
         pDataBuf = padfTempBuffer;
@@ -1563,8 +1574,19 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
                 pasJobs[i].nValues = (iNextStartLine - iStartLine) * nXSize;
                 pasJobs[i].nBandValues = static_cast<size_t>(nXSize) * nYSize;
                 pasJobs[i].nMaxValue = nMaxValue;
+                pasJobs[i].psResampleJob =
+                    asResampleJobs.empty() ? nullptr : &asResampleJobs[i];
+                pasJobs[i].pFinalDataBuf =
+                    padfTempBuffer
+                        ? static_cast<GByte *>(pDataBufOri) +
+                              iStartLine * nXSize *
+                                  GDALGetDataTypeSizeBytes(eBufDataTypeOri)
+                        : nullptr;
+                pasJobs[i].eFinalDataType = eBufDataTypeOri;
 #ifdef DEBUG_TIMING
                 pasJobs[i].ptv = &tv;
+                if (pasJobs[i].psResampleJob)
+                    pasJobs[i].psResampleJob->ptv = &tv;
 #endif
                 ahJobData[i] = &(pasJobs[i]);
             }
@@ -1592,16 +1614,19 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
 
     if (padfTempBuffer)
     {
-        GDALCopyWords64(padfTempBuffer, GDT_Float64, sizeof(double),
-                        pDataBufOri, eBufDataTypeOri,
-                        GDALGetDataTypeSizeBytes(eBufDataTypeOri),
-                        static_cast<size_t>(nXSize) * nYSize *
-                            psOptions->nOutPansharpenedBands);
+        // Already converted by the jobs in the multi-threaded case.
+        if (nTasks <= 1)
+        {
+            GDALCopyWords64(padfTempBuffer, GDT_Float64, sizeof(double),
+                            pDataBufOri, eBufDataTypeOri,
+                            GDALGetDataTypeSizeBytes(eBufDataTypeOri),
+                            static_cast<size_t>(nXSize) * nYSize *
+                                psOptions->nOutPansharpenedBands);
+        }
         VSIFree(padfTempBuffer);
     }
 
-    VSIFree(pUpsampledSpectralBuffer);
-    VSIFree(pPanBuffer);
+    FreeBuffers();
 
     return eErr;
 }
@@ -1682,10 +1707,41 @@ void GDALPansharpenOperation::PansharpenJobThreadFunc(void *pUserData)
         acc += i * i;
     psJob->eErr = CE_None;
 #else
+    // Upsample the spectral bands for our lines, while they are hot in the
+    // cache of this thread, and pansharpen them right after.
+    if (psJob->psResampleJob)
+    {
+        PansharpenResampleJobThreadFunc(psJob->psResampleJob);
+        psJob->poPansharpenOperation->ClampUpsampledValues(
+            psJob->eWorkDataType, psJob->psResampleJob->pBuffer,
+            psJob->nValues, psJob->nBandValues);
+    }
+
     psJob->eErr = psJob->poPansharpenOperation->PansharpenChunk(
         psJob->eWorkDataType, psJob->eBufDataType, psJob->pPanBuffer,
         psJob->pUpsampledSpectralBuffer, psJob->pDataBuf, psJob->nValues,
         psJob->nBandValues, psJob->nMaxValue);
+
+    if (psJob->eErr == CE_None && psJob->pFinalDataBuf)
+    {
+        // Convert from the Float64 working output buffer to the type
+        // requested by the caller.
+        CPLAssert(psJob->eBufDataType == GDT_Float64);
+        const int nFinalDTSize =
+            GDALGetDataTypeSizeBytes(psJob->eFinalDataType);
+        const int nOutBands =
+            psJob->poPansharpenOperation->psOptions->nOutPansharpenedBands;
+        for (int i = 0; i < nOutBands; i++)
+        {
+            GDALCopyWords64(static_cast<const double *>(psJob->pDataBuf) +
+                                i * psJob->nBandValues,
+                            GDT_Float64, sizeof(double),
+                            static_cast<GByte *>(psJob->pFinalDataBuf) +
+                                i * psJob->nBandValues * nFinalDTSize,
+                            psJob->eFinalDataType, nFinalDTSize,
+                            psJob->nValues);
+        }
+    }
 #endif
 
 #ifdef DEBUG_TIMING
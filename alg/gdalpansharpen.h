@@ -137,25 +137,6 @@ CPL_C_END
 class GDALPansharpenOperation;
 
 //! @cond Doxygen_Suppress
-typedef struct
-{
-    GDALPansharpenOperation *poPansharpenOperation;
-    GDALDataType eWorkDataType;
-    GDALDataType eBufDataType;
-    const void *pPanBuffer;
-    const void *pUpsampledSpectralBuffer;
-    void *pDataBuf;
-    size_t nValues;
-    size_t nBandValues;
-    GUInt32 nMaxValue;
-
-#ifdef DEBUG_TIMING
-    struct timeval *ptv;
-#endif
-
-    CPLErr eErr;
-} GDALPansharpenJob;
-
 typedef struct
 {
     GDALDataset *poMEMDS;
@@ -180,6 +161,34 @@ typedef struct
 #endif
 } GDALPansharpenResampleJob;
 
+typedef struct
+{
+    GDALPansharpenOperation *poPansharpenOperation;
+    GDALDataType eWorkDataType;
+    GDALDataType eBufDataType;
+    const void *pPanBuffer;
+    const void *pUpsampledSpectralBuffer;
+    void *pDataBuf;
+    size_t nValues;
+    size_t nBandValues;
+    GUInt32 nMaxValue;
+
+    // If not null, resampling of the spectral bands for the lines of this
+    // job, to be done before pansharpening them.
+    GDALPansharpenResampleJob *psResampleJob;
+
+    // If not null, buffer into which pDataBuf, of type GDT_Float64, must be
+    // converted to eFinalDataType after pansharpening.
+    void *pFinalDataBuf;
+    GDALDataType eFinalDataType;
+
+#ifdef DEBUG_TIMING
+    struct timeval *ptv;
+#endif
+
+    CPLErr eErr;
+} GDALPansharpenJob;
+
 class CPLWorkerThreadPool;
 //! @endcond
 
@@ -251,6 +260,10 @@ class GDALPansharpenOperation
                                      T *pDataBuf, size_t nValues,
                                      size_t nBandValues, T nMaxValue) const;
 
+    void ClampUpsampledValues(GDALDataType eWorkDataType,
+                              void *pUpsampledSpectralBuffer, size_t nValues,
+                              size_t nBandValues) const;
+
     // cppcheck-suppress functionStatic
     CPLErr PansharpenChunk(GDALDataType eWorkDataType,
                            GDALDataType eBufDataType, const void *pPanBuffer,
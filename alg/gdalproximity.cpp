@@ -34,13 +34,17 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <limits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 
 static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    int *panNearY, int bForward, int iLine,
@@ -49,6 +53,13 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    double *pdfSrcNoDataValue, int nTargetValues,
                                    int *panTargetValues);
 
+static CPLErr ComputeProximityEDT(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hWorkProximityBand,
+    GDALRasterBandH hProximityBand, double dfMaxDist, double dfDistMult,
+    double *pdfSrcNoDataValue, int nTargetValues, int *panTargetValues,
+    float fNoDataValue, bool bFixedBufVal, double dfFixedBufVal, int nThreads,
+    GDALProgressFunc pfnProgress, void *pProgressArg);
+
 /************************************************************************/
 /*                        GDALComputeProximity()                        */
 /************************************************************************/
@@ -105,6 +116,20 @@ the proximity output.
 
 If this option is set, all pixels within the MAXDIST threadhold are
 set to this fixed value instead of to a proximity distance.
+
+  ALGORITHM=[SCANLINE]/EDT
+
+(GDAL >= 3.9) Algorithm used to compute distances. SCANLINE, the default,
+propagates the nearest target pixel along scanlines, which is fast but may
+slightly overestimate some distances. EDT computes the exact Euclidean
+distance transform, in linear time, with a separable algorithm
+(Meijster et al., Felzenszwalb and Huttenlocher) that only keeps a bounded
+number of lines in memory.
+
+  NUM_THREADS=n/ALL_CPUS
+
+(GDAL >= 3.9) Number of threads used with ALGORITHM=EDT. Defaults to the
+GDAL_NUM_THREADS configuration option, or 1.
 */
 
 CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
@@ -241,6 +266,33 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         CSLDestroy(papszValuesTokens);
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Which algorithm, with how many threads?                         */
+    /* -------------------------------------------------------------------- */
+    bool bExactEDT = false;
+    pszOpt = CSLFetchNameValue(papszOptions, "ALGORITHM");
+    if (pszOpt)
+    {
+        if (EQUAL(pszOpt, "EDT"))
+            bExactEDT = true;
+        else if (!EQUAL(pszOpt, "SCANLINE"))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Unrecognized ALGORITHM value '%s', should be SCANLINE or "
+                     "EDT.",
+                     pszOpt);
+            CPLFree(panTargetValues);
+            return CE_Failure;
+        }
+    }
+
+    pszOpt = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszOpt == nullptr)
+        pszOpt = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszOpt, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                   : atoi(pszOpt)));
+
     /* -------------------------------------------------------------------- */
     /*      Initialize progress counter.                                    */
     /* -------------------------------------------------------------------- */
@@ -254,7 +306,8 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
     /* -------------------------------------------------------------------- */
     /*      We need a signed type for the working proximity values kept     */
     /*      on disk.  If our proximity band is not signed, then create a    */
-    /*      temporary file for this purpose.                                */
+    /*      temporary file for this purpose. The EDT algorithm keeps        */
+    /*      distances in lines there, that may not fit in small types.      */
     /* -------------------------------------------------------------------- */
     GDALRasterBandH hWorkProximityBand = hProximityBand;
     GDALDatasetH hWorkProximityDS = nullptr;
@@ -269,7 +322,8 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
     bool bTempFileAlreadyDeleted = false;
 
     if (eProxType == GDT_Byte || eProxType == GDT_UInt16 ||
-        eProxType == GDT_UInt32)
+        eProxType == GDT_UInt32 ||
+        (bExactEDT && (eProxType == GDT_Int8 || eProxType == GDT_Int16)))
     {
         GDALDriverH hDriver = GDALGetDriverByName("GTiff");
         if (hDriver == nullptr)
@@ -294,6 +348,16 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         hWorkProximityBand = GDALGetRasterBand(hWorkProximityDS, 1);
     }
 
+    if (bExactEDT)
+    {
+        eErr = ComputeProximityEDT(
+            hSrcBand, hWorkProximityBand, hProximityBand, dfMaxDist,
+            dfDistMult, pdfSrcNoData, nTargetValues, panTargetValues,
+            fNoDataValue, bFixedBufVal, dfFixedBufVal, nThreads, pfnProgress,
+            pProgressArg);
+        goto end;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate buffer for two scanlines of distances as floats        */
     /*      (the current and last line).                                    */
@@ -588,3 +652,303 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
 
     return CE_None;
 }
+
+/************************************************************************/
+/*                          IsTargetPixel()                             */
+/************************************************************************/
+
+static bool IsTargetPixel(GInt32 nValue, int nTargetValues,
+                          const int *panTargetValues)
+{
+    if (nTargetValues == 0)
+        return nValue != 0;
+    for (int i = 0; i < nTargetValues; i++)
+    {
+        if (nValue == panTargetValues[i])
+            return true;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                         ProximityEDTLine()                           */
+/************************************************************************/
+
+// Compute in padfDistSq the squared distance of each pixel of a line to the
+// nearest target pixel, given in padfColDistSq the squared distance of each
+// pixel to the nearest target pixel of its column (infinite if none). This is
+// the lower envelope of parabolas of Felzenszwalb and Huttenlocher.
+// panV and padfZ are work buffers of nXSize and nXSize + 1 elements.
+static void ProximityEDTLine(const double *padfColDistSq, int nXSize,
+                             double *padfDistSq, int *panV, double *padfZ)
+{
+    constexpr double dfInf = std::numeric_limits<double>::infinity();
+
+    int k = -1;
+    for (int q = 0; q < nXSize; q++)
+    {
+        if (padfColDistSq[q] == dfInf)
+            continue;
+        const double dfQ = padfColDistSq[q] + static_cast<double>(q) * q;
+        double dfS = -dfInf;
+        while (k >= 0)
+        {
+            const int v = panV[k];
+            dfS = (dfQ - (padfColDistSq[v] + static_cast<double>(v) * v)) /
+                  (2.0 * (q - v));
+            if (dfS > padfZ[k])
+                break;
+            k--;
+        }
+        if (k < 0)
+            dfS = -dfInf;
+        k++;
+        panV[k] = q;
+        padfZ[k] = dfS;
+        padfZ[k + 1] = dfInf;
+    }
+
+    if (k < 0)
+    {
+        std::fill(padfDistSq, padfDistSq + nXSize, dfInf);
+        return;
+    }
+
+    k = 0;
+    for (int x = 0; x < nXSize; x++)
+    {
+        while (padfZ[k + 1] < x)
+            k++;
+        const double dfDX = static_cast<double>(x - panV[k]);
+        padfDistSq[x] = dfDX * dfDX + padfColDistSq[panV[k]];
+    }
+}
+
+/************************************************************************/
+/*                        ComputeProximityEDT()                         */
+/************************************************************************/
+
+namespace
+{
+constexpr GByte EDT_TARGET = 1;
+constexpr GByte EDT_NODATA = 2;
+
+struct ProximityEDTJob
+{
+    int nXSize = 0;
+    int nLines = 0;
+    const double *padfColDistSq = nullptr;
+    const GByte *pabyFlags = nullptr;
+    float *pafProximity = nullptr;
+    double dfMaxDist = 0;
+    double dfDistMult = 0;
+    float fNoDataValue = 0;
+    bool bFixedBufVal = false;
+    double dfFixedBufVal = 0;
+};
+}  // namespace
+
+static void ProximityEDTJobFunc(void *pData)
+{
+    const auto psJob = static_cast<const ProximityEDTJob *>(pData);
+    const int nXSize = psJob->nXSize;
+    std::vector<double> adfDistSq(nXSize);
+    std::vector<int> anV(nXSize);
+    std::vector<double> adfZ(static_cast<size_t>(nXSize) + 1);
+    const double dfMaxDistSq = psJob->dfMaxDist * psJob->dfMaxDist;
+
+    for (int iLine = 0; iLine < psJob->nLines; iLine++)
+    {
+        const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+        ProximityEDTLine(psJob->padfColDistSq + nOffset, nXSize,
+                         adfDistSq.data(), anV.data(), adfZ.data());
+        const GByte *pabyFlags = psJob->pabyFlags + nOffset;
+        float *pafProximity = psJob->pafProximity + nOffset;
+        for (int i = 0; i < nXSize; i++)
+        {
+            if (pabyFlags[i] & EDT_TARGET)
+                pafProximity[i] = 0.0f;
+            else if ((pabyFlags[i] & EDT_NODATA) ||
+                     !(adfDistSq[i] <= dfMaxDistSq))
+                pafProximity[i] = psJob->fNoDataValue;
+            else if (psJob->bFixedBufVal)
+                pafProximity[i] = static_cast<float>(psJob->dfFixedBufVal);
+            else
+                pafProximity[i] = static_cast<float>(sqrt(adfDistSq[i]) *
+                                                     psJob->dfDistMult);
+        }
+    }
+}
+
+// Exact Euclidean distance transform. It is separable: a first pass, from
+// top to bottom, stores in hWorkProximityBand the distance of each pixel to
+// the nearest target pixel above it in its column. A second pass, from bottom
+// to top, combines it with the distance to the nearest target pixel below,
+// and computes the distance transform of lines by batches, which are
+// processed in parallel.
+static CPLErr ComputeProximityEDT(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hWorkProximityBand,
+    GDALRasterBandH hProximityBand, double dfMaxDist, double dfDistMult,
+    double *pdfSrcNoDataValue, int nTargetValues, int *panTargetValues,
+    float fNoDataValue, bool bFixedBufVal, double dfFixedBufVal, int nThreads,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+    constexpr double dfInf = std::numeric_limits<double>::infinity();
+
+    // Batches of about 4 million pixels
+    const int nBatchLines =
+        std::max(1, std::min(nYSize, 4 * 1024 * 1024 / nXSize));
+
+    std::vector<GInt32> anSrcScanline;
+    std::vector<float> afColDist;
+    std::vector<int> anColDist;
+    std::vector<double> adfColDistSq;
+    std::vector<GByte> abyFlags;
+    std::vector<float> afProximity;
+    try
+    {
+        anSrcScanline.resize(nXSize);
+        afColDist.resize(nXSize);
+        anColDist.resize(nXSize, -1);
+        const size_t nBatchPixels = static_cast<size_t>(nXSize) * nBatchLines;
+        adfColDistSq.resize(nBatchPixels);
+        abyFlags.resize(nBatchPixels);
+        afProximity.resize(nBatchPixels);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate working buffers");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Distance to the nearest target above, from top to bottom.       */
+    /* -------------------------------------------------------------------- */
+    for (int iLine = 0; iLine < nYSize; iLine++)
+    {
+        if (GDALRasterIO(hSrcBand, GF_Read, 0, iLine, nXSize, 1,
+                         anSrcScanline.data(), nXSize, 1, GDT_Int32, 0,
+                         0) != CE_None)
+            return CE_Failure;
+
+        for (int i = 0; i < nXSize; i++)
+        {
+            if (IsTargetPixel(anSrcScanline[i], nTargetValues, panTargetValues))
+                anColDist[i] = 0;
+            else if (anColDist[i] >= 0)
+                anColDist[i]++;
+            afColDist[i] = static_cast<float>(anColDist[i]);
+        }
+
+        if (GDALRasterIO(hWorkProximityBand, GF_Write, 0, iLine, nXSize, 1,
+                         afColDist.data(), nXSize, 1, GDT_Float32, 0,
+                         0) != CE_None)
+            return CE_Failure;
+
+        if (!pfnProgress(0.5 * (iLine + 1) / static_cast<double>(nYSize), "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Distance to the nearest target below, and distance transform    */
+    /*      of lines, from bottom to top.                                   */
+    /* -------------------------------------------------------------------- */
+    auto poPool = nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    std::vector<ProximityEDTJob> asJobs(nThreads);
+
+    std::fill(anColDist.begin(), anColDist.end(), -1);
+    for (int iBatchEnd = nYSize; iBatchEnd > 0;)
+    {
+        const int iBatchStart = std::max(0, iBatchEnd - nBatchLines);
+        const int nLines = iBatchEnd - iBatchStart;
+        for (int iLine = iBatchEnd - 1; iLine >= iBatchStart; iLine--)
+        {
+            if (GDALRasterIO(hWorkProximityBand, GF_Read, 0, iLine, nXSize, 1,
+                             afColDist.data(), nXSize, 1, GDT_Float32, 0,
+                             0) != CE_None ||
+                GDALRasterIO(hSrcBand, GF_Read, 0, iLine, nXSize, 1,
+                             anSrcScanline.data(), nXSize, 1, GDT_Int32, 0,
+                             0) != CE_None)
+                return CE_Failure;
+
+            const size_t nOffset =
+                static_cast<size_t>(iLine - iBatchStart) * nXSize;
+            for (int i = 0; i < nXSize; i++)
+            {
+                GByte nFlags = 0;
+                if (IsTargetPixel(anSrcScanline[i], nTargetValues,
+                                  panTargetValues))
+                {
+                    nFlags = EDT_TARGET;
+                    anColDist[i] = 0;
+                }
+                else
+                {
+                    if (anColDist[i] >= 0)
+                        anColDist[i]++;
+                    if (pdfSrcNoDataValue != nullptr &&
+                        anSrcScanline[i] == *pdfSrcNoDataValue)
+                        nFlags = EDT_NODATA;
+                }
+                abyFlags[nOffset + i] = nFlags;
+
+                double dfColDist = afColDist[i] >= 0 ? afColDist[i] : dfInf;
+                if (anColDist[i] >= 0 && anColDist[i] < dfColDist)
+                    dfColDist = anColDist[i];
+                adfColDistSq[nOffset + i] = dfColDist * dfColDist;
+            }
+        }
+
+        // Split the lines of the batch among jobs.
+        const int nJobs = std::min(nThreads, nLines);
+        for (int iJob = 0; iJob < nJobs; iJob++)
+        {
+            const int iJobStart = static_cast<int>(
+                static_cast<GIntBig>(nLines) * iJob / nJobs);
+            const int iJobEnd = static_cast<int>(
+                static_cast<GIntBig>(nLines) * (iJob + 1) / nJobs);
+            const size_t nOffset = static_cast<size_t>(iJobStart) * nXSize;
+            ProximityEDTJob &sJob = asJobs[iJob];
+            sJob.nXSize = nXSize;
+            sJob.nLines = iJobEnd - iJobStart;
+            sJob.padfColDistSq = adfColDistSq.data() + nOffset;
+            sJob.pabyFlags = abyFlags.data() + nOffset;
+            sJob.pafProximity = afProximity.data() + nOffset;
+            sJob.dfMaxDist = dfMaxDist;
+            sJob.dfDistMult = dfDistMult;
+            sJob.fNoDataValue = fNoDataValue;
+            sJob.bFixedBufVal = bFixedBufVal;
+            sJob.dfFixedBufVal = dfFixedBufVal;
+            if (poQueue)
+                poQueue->SubmitJob(ProximityEDTJobFunc, &sJob);
+            else
+                ProximityEDTJobFunc(&sJob);
+        }
+        if (poQueue)
+            poQueue->WaitCompletion();
+
+        if (GDALRasterIO(hProximityBand, GF_Write, 0, iBatchStart, nXSize,
+                         nLines, afProximity.data(), nXSize, nLines,
+                         GDT_Float32, 0, 0) != CE_None)
+            return CE_Failure;
+
+        iBatchEnd = iBatchStart;
+        if (!pfnProgress(0.5 + 0.5 * (nYSize - iBatchEnd) /
+                                   static_cast<double>(nYSize),
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+
+    return CE_None;
+}
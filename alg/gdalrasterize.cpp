@@ -32,11 +32,15 @@
 #include "gdal_alg_priv.h"
 
 #include <climits>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <cfloat>
+#include <condition_variable>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <algorithm>
 
@@ -45,9 +49,11 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -829,6 +835,395 @@ static CPLErr GDALRasterizeOptions(CSLConstList papszOptions, int *pbAllTouched,
     return CE_None;
 }
 
+/************************************************************************/
+/*                     GDALRasterizeGetNumThreads()                     */
+/************************************************************************/
+
+// Number of threads requested with the NUM_THREADS option, or the
+// GDAL_NUM_THREADS configuration option.
+static int GDALRasterizeGetNumThreads(CSLConstList papszOptions)
+{
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads == nullptr)
+        pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads);
+    return std::max(1, std::min(128, nThreads));
+}
+
+/************************************************************************/
+/*                     GDALRasterizeGetGeometryRows()                   */
+/************************************************************************/
+
+// Compute the range of rows of the raster that rasterizing a geometry may
+// modify, with a margin of one row for ALL_TOUCHED and rounding. The range is
+// empty for geometries that burn nothing. Returns false if it cannot be
+// determined, in which case the geometry must be burnt in all chunks.
+static bool GDALRasterizeGetGeometryRows(const OGRGeometry *poGeometry,
+                                         GDALTransformerFunc pfnTransformer,
+                                         void *pTransformArg,
+                                         bool bAffineNoRotation, int nYSize,
+                                         int &nMinRow, int &nMaxRow)
+{
+    nMinRow = 0;
+    nMaxRow = -1;
+    if (poGeometry == nullptr || poGeometry->IsEmpty())
+        return true;
+
+    std::vector<double> adfX;
+    std::vector<double> adfY;
+    if (bAffineNoRotation)
+    {
+        // The transformation of the envelope is the envelope of the
+        // transformed geometry.
+        OGREnvelope sEnvelope;
+        poGeometry->getEnvelope(&sEnvelope);
+        adfX = {sEnvelope.MinX, sEnvelope.MaxX};
+        adfY = {sEnvelope.MinY, sEnvelope.MaxY};
+    }
+    else
+    {
+        std::vector<double> adfVariant;
+        std::vector<int> anPartSize;
+        GDALCollectRingsFromGeometry(poGeometry, adfX, adfY, adfVariant,
+                                     anPartSize, GBV_UserBurnValue);
+        if (adfX.empty())
+            return true;
+    }
+
+    std::vector<int> abSuccess(adfX.size());
+    if (!pfnTransformer(pTransformArg, FALSE, static_cast<int>(adfX.size()),
+                        adfX.data(), adfY.data(), nullptr, abSuccess.data()))
+    {
+        return false;
+    }
+
+    double dfMinY = std::numeric_limits<double>::infinity();
+    double dfMaxY = -std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < adfY.size(); ++i)
+    {
+        if (!abSuccess[i] || !std::isfinite(adfY[i]))
+            return false;
+        dfMinY = std::min(dfMinY, adfY[i]);
+        dfMaxY = std::max(dfMaxY, adfY[i]);
+    }
+    nMinRow = static_cast<int>(
+        std::max(-1.0, std::min(static_cast<double>(nYSize),
+                                std::floor(dfMinY) - 1)));
+    nMaxRow = static_cast<int>(
+        std::max(-1.0, std::min(static_cast<double>(nYSize),
+                                std::floor(dfMaxY) + 1)));
+    return true;
+}
+
+/************************************************************************/
+/*                      GDALRasterizeGetChunkRange()                    */
+/************************************************************************/
+
+// Compute the range of chunks of nYChunkSize rows intersecting the range of
+// rows returned by GDALRasterizeGetGeometryRows(). Returns false if the
+// geometry does not intersect any chunk.
+static bool GDALRasterizeGetChunkRange(int nMinRow, int nMaxRow, int nYSize,
+                                       int nYChunkSize, int &iFirstChunk,
+                                       int &iLastChunk)
+{
+    nMinRow = std::max(0, nMinRow);
+    nMaxRow = std::min(nYSize - 1, nMaxRow);
+    if (nMinRow > nMaxRow)
+        return false;
+    iFirstChunk = nMinRow / nYChunkSize;
+    iLastChunk = nMaxRow / nYChunkSize;
+    return true;
+}
+
+/************************************************************************/
+/*                    GDALRasterizeGeometriesMulti()                    */
+/************************************************************************/
+
+namespace
+{
+// State shared by the jobs of GDALRasterizeGeometriesMulti().
+struct GDALRasterizeMultiContext
+{
+    GDALDataset *poDS = nullptr;
+    int nBandCount = 0;
+    const int *panBandList = nullptr;
+    int nGeomCount = 0;
+    const OGRGeometryH *pahGeometries = nullptr;
+    GDALTransformerFunc pfnTransformer = nullptr;
+    bool bAffineNoRotation = false;
+    GDALDataType eBurnValueType = GDT_Float64;
+    const double *padfGeomBurnValues = nullptr;
+    const int64_t *panGeomBurnValues = nullptr;
+    int bAllTouched = FALSE;
+    GDALBurnValueSrc eBurnValueSource = GBV_UserBurnValue;
+    GDALRasterMergeAlg eMergeAlg = GRMA_Replace;
+    GDALDataType eType = GDT_Byte;
+    int nScanlineBytes = 0;
+    int nYChunkSize = 0;
+    int nChunks = 0;
+
+    // Row ranges of the geometries, and the geometries to burn in each
+    // chunk, in their original order.
+    std::vector<int> anMinRow{};
+    std::vector<int> anMaxRow{};
+    std::vector<std::vector<int>> aanChunkGeoms{};
+
+    // Serializes the reading and writing of the chunks.
+    std::mutex oIOMutex{};
+
+    std::mutex oMutex{};
+    std::condition_variable oCond{};
+    int nNextChunk = 0;
+    int nChunksDone = 0;
+    bool bStop = false;
+    CPLErr eErr = CE_None;
+};
+
+struct GDALRasterizeMultiJob
+{
+    GDALRasterizeMultiContext *psContext = nullptr;
+    void *pTransformArg = nullptr;
+    int iFirstGeom = 0;
+    int iLastGeom = 0;
+};
+}  // namespace
+
+// Compute the row ranges of a slice of the geometries.
+static void GDALRasterizeGetRowsJob(void *pData)
+{
+    auto psJob = static_cast<GDALRasterizeMultiJob *>(pData);
+    GDALRasterizeMultiContext *psContext = psJob->psContext;
+    const int nYSize = psContext->poDS->GetRasterYSize();
+    for (int iShape = psJob->iFirstGeom; iShape < psJob->iLastGeom; ++iShape)
+    {
+        if (!GDALRasterizeGetGeometryRows(
+                OGRGeometry::FromHandle(psContext->pahGeometries[iShape]),
+                psContext->pfnTransformer, psJob->pTransformArg,
+                psContext->bAffineNoRotation, nYSize,
+                psContext->anMinRow[iShape], psContext->anMaxRow[iShape]))
+        {
+            psContext->anMinRow[iShape] = 0;
+            psContext->anMaxRow[iShape] = nYSize - 1;
+        }
+    }
+}
+
+// Burn the geometries of the chunks not yet processed by another job.
+static void GDALRasterizeChunksJob(void *pData)
+{
+    auto psJob = static_cast<GDALRasterizeMultiJob *>(pData);
+    GDALRasterizeMultiContext *psContext = psJob->psContext;
+    GDALDataset *poDS = psContext->poDS;
+    const int nXSize = poDS->GetRasterXSize();
+    const int nYSize = poDS->GetRasterYSize();
+    const int nBandCount = psContext->nBandCount;
+    int *panBandList = const_cast<int *>(psContext->panBandList);
+
+    unsigned char *pabyChunkBuf = static_cast<unsigned char *>(
+        VSI_MALLOC2_VERBOSE(psContext->nYChunkSize, psContext->nScanlineBytes));
+
+    while (true)
+    {
+        int iChunk;
+        {
+            std::lock_guard<std::mutex> oLock(psContext->oMutex);
+            if (pabyChunkBuf == nullptr)
+            {
+                psContext->eErr = CE_Failure;
+                psContext->bStop = true;
+            }
+            if (psContext->bStop || psContext->nNextChunk == psContext->nChunks)
+                break;
+            iChunk = psContext->nNextChunk++;
+        }
+
+        const int iY = iChunk * psContext->nYChunkSize;
+        const int nThisYChunkSize =
+            std::min(psContext->nYChunkSize, nYSize - iY);
+
+        CPLErr eErr;
+        {
+            std::lock_guard<std::mutex> oLock(psContext->oIOMutex);
+            eErr = poDS->RasterIO(GF_Read, 0, iY, nXSize, nThisYChunkSize,
+                                  pabyChunkBuf, nXSize, nThisYChunkSize,
+                                  psContext->eType, nBandCount, panBandList, 0,
+                                  0, 0, nullptr);
+        }
+
+        if (eErr == CE_None)
+        {
+            for (const int iShape : psContext->aanChunkGeoms[iChunk])
+            {
+                gv_rasterize_one_shape(
+                    pabyChunkBuf, 0, iY, nXSize, nThisYChunkSize, nBandCount,
+                    psContext->eType, 0, 0, 0, psContext->bAllTouched,
+                    OGRGeometry::FromHandle(psContext->pahGeometries[iShape]),
+                    psContext->eBurnValueType,
+                    psContext->padfGeomBurnValues
+                        ? psContext->padfGeomBurnValues + iShape * nBandCount
+                        : nullptr,
+                    psContext->panGeomBurnValues
+                        ? psContext->panGeomBurnValues + iShape * nBandCount
+                        : nullptr,
+                    psContext->eBurnValueSource, psContext->eMergeAlg,
+                    psContext->pfnTransformer, psJob->pTransformArg);
+            }
+
+            std::lock_guard<std::mutex> oLock(psContext->oIOMutex);
+            eErr = poDS->RasterIO(GF_Write, 0, iY, nXSize, nThisYChunkSize,
+                                  pabyChunkBuf, nXSize, nThisYChunkSize,
+                                  psContext->eType, nBandCount, panBandList, 0,
+                                  0, 0, nullptr);
+        }
+
+        {
+            std::lock_guard<std::mutex> oLock(psContext->oMutex);
+            psContext->nChunksDone++;
+            if (eErr != CE_None)
+            {
+                psContext->eErr = eErr;
+                psContext->bStop = true;
+            }
+        }
+        psContext->oCond.notify_one();
+    }
+
+    VSIFree(pabyChunkBuf);
+    psContext->oCond.notify_one();
+}
+
+// Multi-threaded version of the OPTIM=RASTER mode of
+// GDALRasterizeGeometriesInternal(). The row range of each geometry is
+// computed once, so that each chunk only burns the geometries that intersect
+// it, and chunks are burnt concurrently. Each pixel belongs to a single
+// chunk, in which geometries are burnt in their original order, so the
+// result is the same as with a single thread for all merge algorithms.
+// Returns CE_Warning if the transformer cannot be cloned, in which case
+// nothing has been done.
+static CPLErr GDALRasterizeGeometriesMulti(
+    GDALDataset *poDS, int nBandCount, const int *panBandList, int nGeomCount,
+    const OGRGeometryH *pahGeometries, GDALTransformerFunc pfnTransformer,
+    void *pTransformArg, GDALDataType eBurnValueType,
+    const double *padfGeomBurnValues, const int64_t *panGeomBurnValues,
+    int bAllTouched, GDALBurnValueSrc eBurnValueSource,
+    GDALRasterMergeAlg eMergeAlg, GDALDataType eType, int nScanlineBytes,
+    int nYChunkSize, int nThreads, GDALProgressFunc pfnProgress,
+    void *pProgressArg)
+{
+    // Only transformers known to be GTI2 ones can be cloned.
+    if (pfnTransformer != GDALGenImgProjTransform)
+        return CE_Warning;
+
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nThreads);
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    if (!poQueue)
+        return CE_Warning;
+
+    // The first job uses the transformer of the caller, the other ones a
+    // clone of it.
+    std::vector<GDALRasterizeMultiJob> asJobs(nThreads);
+    asJobs[0].pTransformArg = pTransformArg;
+    for (int i = 1; i < nThreads; ++i)
+    {
+        asJobs[i].pTransformArg = GDALCloneTransformer(pTransformArg);
+        if (asJobs[i].pTransformArg == nullptr)
+        {
+            for (int j = 1; j < i; ++j)
+                GDALDestroyTransformer(asJobs[j].pTransformArg);
+            return CE_Warning;
+        }
+    }
+
+    const int nYSize = poDS->GetRasterYSize();
+    GDALRasterizeMultiContext sContext;
+    sContext.poDS = poDS;
+    sContext.nBandCount = nBandCount;
+    sContext.panBandList = panBandList;
+    sContext.nGeomCount = nGeomCount;
+    sContext.pahGeometries = pahGeometries;
+    sContext.pfnTransformer = pfnTransformer;
+    sContext.bAffineNoRotation =
+        GDALTransformIsAffineNoRotation(pfnTransformer, pTransformArg);
+    sContext.eBurnValueType = eBurnValueType;
+    sContext.padfGeomBurnValues = padfGeomBurnValues;
+    sContext.panGeomBurnValues = panGeomBurnValues;
+    sContext.bAllTouched = bAllTouched;
+    sContext.eBurnValueSource = eBurnValueSource;
+    sContext.eMergeAlg = eMergeAlg;
+    sContext.eType = eType;
+    sContext.nScanlineBytes = nScanlineBytes;
+    sContext.nYChunkSize = nYChunkSize;
+    sContext.nChunks = (nYSize + nYChunkSize - 1) / nYChunkSize;
+    sContext.anMinRow.resize(nGeomCount);
+    sContext.anMaxRow.resize(nGeomCount);
+
+    CPLDebug("GDAL",
+             "Rasterizer operating on %d swaths of %d scanlines "
+             "with %d threads.",
+             sContext.nChunks, nYChunkSize, nThreads);
+
+    pfnProgress(0.0, nullptr, pProgressArg);
+
+    /* -------------------------------------------------------------------- */
+    /*      Compute the row range of each geometry, and bin the             */
+    /*      geometries by chunk.                                            */
+    /* -------------------------------------------------------------------- */
+    for (int i = 0; i < nThreads; ++i)
+    {
+        asJobs[i].psContext = &sContext;
+        asJobs[i].iFirstGeom =
+            static_cast<int>(static_cast<int64_t>(i) * nGeomCount / nThreads);
+        asJobs[i].iLastGeom = static_cast<int>(static_cast<int64_t>(i + 1) *
+                                               nGeomCount / nThreads);
+        poQueue->SubmitJob(GDALRasterizeGetRowsJob, &asJobs[i]);
+    }
+    poQueue->WaitCompletion();
+
+    sContext.aanChunkGeoms.resize(sContext.nChunks);
+    for (int iShape = 0; iShape < nGeomCount; ++iShape)
+    {
+        int iFirstChunk = 0;
+        int iLastChunk = -1;
+        GDALRasterizeGetChunkRange(sContext.anMinRow[iShape],
+                                   sContext.anMaxRow[iShape], nYSize,
+                                   nYChunkSize, iFirstChunk, iLastChunk);
+        for (int iChunk = iFirstChunk; iChunk <= iLastChunk; ++iChunk)
+        {
+            sContext.aanChunkGeoms[iChunk].push_back(iShape);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Burn the chunks.                                                */
+    /* -------------------------------------------------------------------- */
+    for (int i = 0; i < nThreads; ++i)
+        poQueue->SubmitJob(GDALRasterizeChunksJob, &asJobs[i]);
+
+    {
+        std::unique_lock<std::mutex> oLock(sContext.oMutex);
+        while (sContext.nChunksDone < sContext.nChunks && !sContext.bStop)
+        {
+            sContext.oCond.wait(oLock);
+            if (!pfnProgress(sContext.nChunksDone /
+                                 static_cast<double>(sContext.nChunks),
+                             "", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                sContext.eErr = CE_Failure;
+                sContext.bStop = true;
+            }
+        }
+    }
+    poQueue->WaitCompletion();
+
+    for (int i = 1; i < nThreads; ++i)
+        GDALDestroyTransformer(asJobs[i].pTransformArg);
+
+    return sContext.eErr;
+}
+
 /************************************************************************/
 /*                      GDALRasterizeGeometries()                       */
 /************************************************************************/
@@ -889,6 +1284,20 @@ static CPLErr GDALRasterizeGeometriesInternal(
  * used. Default size will be estimated based on the GDAL cache buffer size
  * using formula: cache_size_bytes/scanline_size_bytes, so the chunk will
  * not exceed the cache. Not used in OPTIM=RASTER mode.</li>
+ * <li>"OPTIM": May be set to "AUTO", "RASTER", "VECTOR". Force the algorithm
+ * used (results are identical). The raster mode is used in most cases and
+ * optimise read/write operations. The vector mode is useful with a decent
+ * amount of input features and optimise the CPU use. That mode has to be used
+ * with tiled images to be efficient. The auto mode (the default) will chose
+ * the algorithm based on input and output properties.</li>
+ * <li>"NUM_THREADS": (GDAL >= 3.9) Number of threads, or ALL_CPUS, used to
+ * burn the chunks of the raster mode concurrently. Defaults to the value of
+ * the GDAL_NUM_THREADS configuration option, or 1. When several threads are
+ * used, the row range of each geometry is computed once, so that each chunk
+ * only processes the geometries that intersect it, and the raster mode is
+ * also selected by the auto mode for large numbers of geometries. The result
+ * is the same as with a single thread, whatever MERGE_ALG. This requires the
+ * transformer to be a GDALGenImgProjTransform() one, or the default one.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1078,12 +1487,16 @@ static CPLErr GDALRasterizeGeometriesInternal(
     int nXBlockSize, nYBlockSize;
     poBand->GetBlockSize(&nXBlockSize, &nYBlockSize);
 
+    // The multi-threaded mode only applies to OPTIM=RASTER, which it
+    // makes suitable for large numbers of geometries too.
+    const int nThreads = GDALRasterizeGetNumThreads(papszOptions);
+
     if (eOptim == GRO_Auto)
     {
         eOptim = GRO_Raster;
         // TODO make more tests with various inputs/outputs to adjust the
         // parameters
-        if (nYBlockSize > 1 && nGeomCount > 10000 &&
+        if (nThreads == 1 && nYBlockSize > 1 && nGeomCount > 10000 &&
             (poBand->GetXSize() * static_cast<long long>(poBand->GetYSize()) /
                  nGeomCount >
              50))
@@ -1133,6 +1546,35 @@ static CPLErr GDALRasterizeGeometriesInternal(
         if (nYChunkSize > poDS->GetRasterYSize())
             nYChunkSize = poDS->GetRasterYSize();
 
+        if (nThreads > 1)
+        {
+            // Each thread has its own chunk buffer, and there are several
+            // chunks per thread to balance the load.
+            int nYChunkSizeMulti = nYChunkSize;
+            if (pszYChunkSize == nullptr || atoi(pszYChunkSize) == 0)
+            {
+                nYChunkSizeMulti = std::max(
+                    1, std::min(nYChunkSize / nThreads,
+                                (poDS->GetRasterYSize() + 4 * nThreads - 1) /
+                                    (4 * nThreads)));
+            }
+            eErr = GDALRasterizeGeometriesMulti(
+                poDS, nBandCount, panBandList, nGeomCount, pahGeometries,
+                pfnTransformer, pTransformArg, eBurnValueType,
+                padfGeomBurnValues, panGeomBurnValues, bAllTouched,
+                eBurnValueSource, eMergeAlg, eType, nScanlineBytes,
+                nYChunkSizeMulti, nThreads, pfnProgress, pProgressArg);
+            if (eErr != CE_Warning)
+            {
+                if (bNeedToFreeTransformer)
+                    GDALDestroyTransformer(pTransformArg);
+                return eErr;
+            }
+            CPLDebug("GDAL", "Rasterizer cannot use several threads with "
+                             "this transformer");
+            eErr = CE_None;
+        }
+
         CPLDebug("GDAL", "Rasterizer operating on %d swaths of %d scanlines.",
                  (poDS->GetRasterYSize() + nYChunkSize - 1) / nYChunkSize,
                  nYChunkSize);
@@ -1146,6 +1588,43 @@ static CPLErr GDALRasterizeGeometriesInternal(
             return CE_Failure;
         }
 
+        /* ====================================================================
+         */
+        /*      When there are several chunks, bin the geometries by the */
+        /*      chunks they intersect, so that each chunk only goes */
+        /*      through the geometries it needs. */
+        /* ====================================================================
+         */
+        const int nYSize = poDS->GetRasterYSize();
+        const int nChunks = (nYSize + nYChunkSize - 1) / nYChunkSize;
+        std::vector<std::vector<int>> aanChunkGeoms;
+        if (nChunks > 1)
+        {
+            const bool bAffineNoRotation =
+                GDALTransformIsAffineNoRotation(pfnTransformer, pTransformArg);
+            aanChunkGeoms.resize(nChunks);
+            for (int iShape = 0; iShape < nGeomCount; iShape++)
+            {
+                int nMinRow = 0;
+                int nMaxRow = nYSize - 1;
+                if (!GDALRasterizeGetGeometryRows(
+                        OGRGeometry::FromHandle(pahGeometries[iShape]),
+                        pfnTransformer, pTransformArg, bAffineNoRotation,
+                        nYSize, nMinRow, nMaxRow))
+                {
+                    nMinRow = 0;
+                    nMaxRow = nYSize - 1;
+                }
+                int iFirstChunk = 0;
+                int iLastChunk = -1;
+                GDALRasterizeGetChunkRange(nMinRow, nMaxRow, nYSize,
+                                           nYChunkSize, iFirstChunk,
+                                           iLastChunk);
+                for (int iChunk = iFirstChunk; iChunk <= iLastChunk; ++iChunk)
+                    aanChunkGeoms[iChunk].push_back(iShape);
+            }
+        }
+
         /* ====================================================================
          */
         /*      Loop over image in designated chunks. */
@@ -1167,8 +1646,14 @@ static CPLErr GDALRasterizeGeometriesInternal(
             if (eErr != CE_None)
                 break;
 
-            for (int iShape = 0; iShape < nGeomCount; iShape++)
+            const int nShapesInChunk =
+                nChunks > 1
+                    ? static_cast<int>(aanChunkGeoms[iY / nYChunkSize].size())
+                    : nGeomCount;
+            for (int i = 0; i < nShapesInChunk; i++)
             {
+                const int iShape =
+                    nChunks > 1 ? aanChunkGeoms[iY / nYChunkSize][i] : i;
                 gv_rasterize_one_shape(
                     pabyChunkBuf, 0, iY, poDS->GetRasterXSize(),
                     nThisYChunkSize, nBandCount, eType, 0, 0, 0, bAllTouched,
@@ -1388,6 +1873,191 @@ static CPLErr GDALRasterizeGeometriesInternal(
     return eErr;
 }
 
+/************************************************************************/
+/*                    GDALRasterizeLayerByChunkBins()                   */
+/************************************************************************/
+
+// Version of the chunk loop of GDALRasterizeLayers() that reads the layer
+// only once, instead of once per chunk. The features are first written to a
+// temporary file, as their burn value and WKB geometry, and the offsets of
+// these records are binned by the chunks the geometry intersects. Each chunk
+// is then burnt from its bin, in the original order of the features, so only
+// the bins stay in memory. Returns CE_Warning if the temporary file cannot be
+// created, in which case nothing has been done.
+static CPLErr GDALRasterizeLayerByChunkBins(
+    GDALDataset *poDS, OGRLayer *poLayer, int nBandCount, int *panBandList,
+    GDALDataType eType, unsigned char *pabyChunkBuf, int nYChunkSize,
+    int iBurnField, const double *padfBurnValues, int bAllTouched,
+    GDALBurnValueSrc eBurnValueSource, GDALRasterMergeAlg eMergeAlg,
+    GDALTransformerFunc pfnTransformer, void *pTransformArg,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const CPLString osTmpFile = CPLGenerateTempFilename("rasterize");
+    VSILFILE *fp = VSIFOpenL(osTmpFile, "wb+");
+    if (fp == nullptr)
+        return CE_Warning;
+    // On Unix, attempt at deleting the temporary file now, so that
+    // if the process gets interrupted, it is automatically destroyed
+    // by the operating system.
+    const bool bTempFileAlreadyDeleted = VSIUnlink(osTmpFile) == 0;
+
+    const int nXSize = poDS->GetRasterXSize();
+    const int nYSize = poDS->GetRasterYSize();
+    const int nChunks = (nYSize + nYChunkSize - 1) / nYChunkSize;
+    const bool bAffineNoRotation =
+        GDALTransformIsAffineNoRotation(pfnTransformer, pTransformArg);
+
+    CPLDebug("GDAL",
+             "Rasterizer binning features of layer %s into %d swaths of "
+             "%d scanlines.",
+             poLayer->GetName(), nChunks, nYChunkSize);
+
+    /* -------------------------------------------------------------------- */
+    /*      Write the features in the temporary file, and bin them.         */
+    /* -------------------------------------------------------------------- */
+    CPLErr eErr = CE_None;
+    std::vector<std::vector<vsi_l_offset>> aanChunkRecords(nChunks);
+    std::vector<GByte> abyWKB;
+    vsi_l_offset nOffset = 0;
+    poLayer->ResetReading();
+    for (auto &poFeat : poLayer)
+    {
+        const OGRGeometry *poGeom = poFeat->GetGeometryRef();
+        if (poGeom == nullptr || poGeom->IsEmpty())
+            continue;
+
+        int nMinRow = 0;
+        int nMaxRow = nYSize - 1;
+        if (!GDALRasterizeGetGeometryRows(poGeom, pfnTransformer,
+                                          pTransformArg, bAffineNoRotation,
+                                          nYSize, nMinRow, nMaxRow))
+        {
+            nMinRow = 0;
+            nMaxRow = nYSize - 1;
+        }
+        int iFirstChunk = 0;
+        int iLastChunk = -1;
+        if (!GDALRasterizeGetChunkRange(nMinRow, nMaxRow, nYSize, nYChunkSize,
+                                        iFirstChunk, iLastChunk))
+        {
+            continue;
+        }
+
+        const double dfAttrValue =
+            iBurnField >= 0 ? poFeat->GetFieldAsDouble(iBurnField) : 0.0;
+        const size_t nWKBSize = poGeom->WkbSize();
+        if (nWKBSize > std::numeric_limits<uint32_t>::max())
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Too large geometry for feature " CPL_FRMT_GIB,
+                     static_cast<GIntBig>(poFeat->GetFID()));
+            eErr = CE_Failure;
+            break;
+        }
+        const uint32_t nWKBSize32 = static_cast<uint32_t>(nWKBSize);
+        abyWKB.resize(nWKBSize);
+        if (poGeom->exportToWkb(wkbNDR, abyWKB.data(), wkbVariantIso) !=
+                OGRERR_NONE ||
+            VSIFWriteL(&dfAttrValue, sizeof(dfAttrValue), 1, fp) != 1 ||
+            VSIFWriteL(&nWKBSize32, sizeof(nWKBSize32), 1, fp) != 1 ||
+            VSIFWriteL(abyWKB.data(), 1, nWKBSize, fp) != nWKBSize)
+        {
+            CPLError(CE_Failure, CPLE_FileIO,
+                     "Cannot write feature " CPL_FRMT_GIB
+                     " in temporary file %s",
+                     static_cast<GIntBig>(poFeat->GetFID()),
+                     osTmpFile.c_str());
+            eErr = CE_Failure;
+            break;
+        }
+
+        for (int iChunk = iFirstChunk; iChunk <= iLastChunk; ++iChunk)
+            aanChunkRecords[iChunk].push_back(nOffset);
+        nOffset += sizeof(dfAttrValue) + sizeof(nWKBSize32) + nWKBSize;
+    }
+    poLayer->ResetReading();
+
+    /* -------------------------------------------------------------------- */
+    /*      Burn each chunk from its bin.                                   */
+    /* -------------------------------------------------------------------- */
+    std::vector<double> adfAttrValues(nBandCount);
+    for (int iChunk = 0; iChunk < nChunks && eErr == CE_None; ++iChunk)
+    {
+        const int iY = iChunk * nYChunkSize;
+        const int nThisYChunkSize = std::min(nYChunkSize, nYSize - iY);
+
+        eErr = poDS->RasterIO(GF_Read, 0, iY, nXSize, nThisYChunkSize,
+                              pabyChunkBuf, nXSize, nThisYChunkSize, eType,
+                              nBandCount, panBandList, 0, 0, 0, nullptr);
+        if (eErr != CE_None)
+            break;
+
+        for (const vsi_l_offset nRecordOffset : aanChunkRecords[iChunk])
+        {
+            double dfAttrValue = 0;
+            uint32_t nWKBSize32 = 0;
+            if (VSIFSeekL(fp, nRecordOffset, SEEK_SET) != 0 ||
+                VSIFReadL(&dfAttrValue, sizeof(dfAttrValue), 1, fp) != 1 ||
+                VSIFReadL(&nWKBSize32, sizeof(nWKBSize32), 1, fp) != 1)
+            {
+                eErr = CE_Failure;
+            }
+            else
+            {
+                abyWKB.resize(nWKBSize32);
+                if (VSIFReadL(abyWKB.data(), 1, nWKBSize32, fp) != nWKBSize32)
+                    eErr = CE_Failure;
+            }
+            OGRGeometry *poGeom = nullptr;
+            if (eErr != CE_None ||
+                OGRGeometryFactory::createFromWkb(abyWKB.data(), nullptr,
+                                                  &poGeom, nWKBSize32,
+                                                  wkbVariantIso) != OGRERR_NONE)
+            {
+                CPLError(CE_Failure, CPLE_FileIO,
+                         "Cannot read feature from temporary file %s",
+                         osTmpFile.c_str());
+                eErr = CE_Failure;
+                break;
+            }
+            std::unique_ptr<OGRGeometry> poGeomHolder(poGeom);
+
+            const double *padfValues = padfBurnValues;
+            if (iBurnField >= 0)
+            {
+                std::fill(adfAttrValues.begin(), adfAttrValues.end(),
+                          dfAttrValue);
+                padfValues = adfAttrValues.data();
+            }
+
+            gv_rasterize_one_shape(pabyChunkBuf, 0, iY, nXSize,
+                                   nThisYChunkSize, nBandCount, eType, 0, 0, 0,
+                                   bAllTouched, poGeom, GDT_Float64, padfValues,
+                                   nullptr, eBurnValueSource, eMergeAlg,
+                                   pfnTransformer, pTransformArg);
+        }
+        if (eErr != CE_None)
+            break;
+
+        eErr = poDS->RasterIO(GF_Write, 0, iY, nXSize, nThisYChunkSize,
+                              pabyChunkBuf, nXSize, nThisYChunkSize, eType,
+                              nBandCount, panBandList, 0, 0, 0, nullptr);
+
+        if (!pfnProgress((iY + nThisYChunkSize) / static_cast<double>(nYSize),
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    VSIFCloseL(fp);
+    if (!bTempFileAlreadyDeleted)
+        VSIUnlink(osTmpFile);
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                        GDALRasterizeLayers()                         */
 /************************************************************************/
@@ -1425,11 +2095,14 @@ static CPLErr GDALRasterizeGeometriesInternal(
  * bands. If specified, padfLayerBurnValues will not be used and can be a NULL
  * pointer.</li>
  * <li>"CHUNKYSIZE": The height in lines of the chunk to operate on.
- * The larger the chunk size the less times we need to make a pass through all
- * the shapes. If it is not set or set to zero the default chunk size will be
+ * If it is not set or set to zero the default chunk size will be
  * used. Default size will be estimated based on the GDAL cache buffer size
  * using formula: cache_size_bytes/scanline_size_bytes, so the chunk will
- * not exceed the cache.</li>
+ * not exceed the cache. Starting with GDAL 3.9, when several chunks are
+ * needed, each layer is read only once: its features are binned by chunk
+ * in a temporary file (in the directory pointed by the CPL_TMPDIR
+ * configuration option, or the current directory), from which each chunk
+ * is then burnt.</li>
  * <li>"ALL_TOUCHED": May be set to TRUE to set all pixels touched
  * by the line or polygons, not just those whose center is within the polygon
  * or that are selected by brezenhams line algorithm.  Defaults to FALSE.
@@ -1658,7 +2331,31 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
         if (padfAttrValues == nullptr)
             eErr = CE_Failure;
 
-        for (int iY = 0; iY < poDS->GetRasterYSize() && eErr == CE_None;
+        // With several chunks, read the layer only once, unless the
+        // temporary file needed for that cannot be created.
+        bool bBinned = false;
+        if (eErr == CE_None && nYChunkSize < poDS->GetRasterYSize())
+        {
+            eErr = GDALRasterizeLayerByChunkBins(
+                poDS, poLayer, nBandCount, panBandList, eType, pabyChunkBuf,
+                nYChunkSize, iBurnField, padfBurnValues, bAllTouched,
+                eBurnValueSource, eMergeAlg, pfnTransformer, pTransformArg,
+                pfnProgress, pProgressArg);
+            if (eErr == CE_Warning)
+            {
+                CPLDebug("GDAL", "Rasterizer cannot create a temporary file "
+                                 "to bin features: reading the layer for "
+                                 "each swath.");
+                eErr = CE_None;
+            }
+            else
+            {
+                bBinned = true;
+            }
+        }
+
+        for (int iY = 0;
+             !bBinned && iY < poDS->GetRasterYSize() && eErr == CE_None;
              iY += nYChunkSize)
         {
             int nThisYChunkSize = nYChunkSize;
@@ -34,16 +34,23 @@
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg_priv.h"
+#include "gdal_thread_pool.h"
 
 #define MY_MAX_INT 2147483647
 
@@ -142,6 +149,665 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
         anBigNeighbour[nPolyId2] = nPolyId1;
 }
 
+/************************************************************************/
+/*                          GPResolveMerges()                           */
+/*                                                                      */
+/*      If our biggest neighbour is still smaller than the              */
+/*      threshold, then try tracking to that polygons biggest           */
+/*      neighbour, and so forth.                                        */
+/************************************************************************/
+
+static void GPResolveMerges(const GInt32 *panPolyIdMap,
+                            const std::int64_t *panPolyValue,
+                            const std::vector<int> &anPolySizes,
+                            std::vector<int> &anBigNeighbour,
+                            int nSizeThreshold)
+{
+    int nFailedMerges = 0;
+    int nIsolatedSmall = 0;
+    int nSieveTargets = 0;
+
+    for (int iPoly = 0; iPoly < static_cast<int>(anPolySizes.size()); iPoly++)
+    {
+        if (panPolyIdMap[iPoly] != iPoly)
+            continue;
+
+        // Ignore nodata polygons.
+        if (panPolyValue[iPoly] == GP_NODATA_MARKER)
+            continue;
+
+        // Don't try to merge polygons larger than the threshold.
+        if (anPolySizes[iPoly] >= nSizeThreshold)
+        {
+            anBigNeighbour[iPoly] = -1;
+            continue;
+        }
+
+        nSieveTargets++;
+
+        // if we have no neighbours but we are small, what shall we do?
+        if (anBigNeighbour[iPoly] == -1)
+        {
+            nIsolatedSmall++;
+            continue;
+        }
+
+        std::set<int> oSetVisitedPoly;
+        oSetVisitedPoly.insert(iPoly);
+
+        // Walk through our neighbours until we find a polygon large enough.
+        int iFinalId = iPoly;
+        bool bFoundBigEnoughPoly = false;
+        while (true)
+        {
+            iFinalId = anBigNeighbour[iFinalId];
+            if (iFinalId < 0)
+            {
+                break;
+            }
+            // If the biggest neighbour is larger than the threshold
+            // then we are golden.
+            if (anPolySizes[iFinalId] >= nSizeThreshold)
+            {
+                bFoundBigEnoughPoly = true;
+                break;
+            }
+            // Check that we don't cycle on an already visited polygon.
+            if (oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end())
+                break;
+            oSetVisitedPoly.insert(iFinalId);
+        }
+
+        if (!bFoundBigEnoughPoly)
+        {
+            nFailedMerges++;
+            anBigNeighbour[iPoly] = -1;
+            continue;
+        }
+
+        // Map the whole intermediate chain to it.
+        int iPolyCur = iPoly;
+        while (anBigNeighbour[iPolyCur] != iFinalId)
+        {
+            int iNextPoly = anBigNeighbour[iPolyCur];
+            anBigNeighbour[iPolyCur] = iFinalId;
+            iPolyCur = iNextPoly;
+        }
+    }
+
+    CPLDebug("GDALSieveFilter",
+             "Small Polygons: %d, Isolated: %d, Unmergable: %d", nSieveTargets,
+             nIsolatedSmall, nFailedMerges);
+}
+
+/************************************************************************/
+/*                       GPSieveStripJobFunc()                          */
+/************************************************************************/
+
+namespace
+{
+// State shared by the jobs of GPSieveFilterMultiThreaded().
+struct GPSieveContext
+{
+    GDALRasterBandH hSrcBand = nullptr;
+    GDALRasterBandH hMaskBand = nullptr;
+    GDALRasterBandH hDstBand = nullptr;
+    int nXSize = 0;
+    int nYSize = 0;
+    int nConnectedness = 4;
+    int nPass = 0;
+
+    // Protects the I/O on the bands, and the progress.
+    std::mutex oMutex{};
+    GDALProgressFunc pfnProgress = nullptr;
+    void *pProgressArg = nullptr;
+    double dfProgressStart = 0;
+    int nLinesDone = 0;
+    bool bInterrupted = false;
+
+    // Indexed by global polygon fragment id, once all strips are enumerated.
+    std::vector<GInt32> anRootId{};
+    std::vector<std::int64_t> anPolyValue{};
+    // Indexed by root id.
+    std::vector<int> anPolySizes{};
+    std::vector<int> anBigNeighbour{};
+};
+
+// Horizontal strip of the raster, whose polygons are enumerated
+// independently of the other strips.
+struct GPSieveStrip
+{
+    GPSieveContext *psContext = nullptr;
+    int nYOff = 0;
+    int nYSize = 0;
+    CPLErr eErr = CE_None;
+
+    // Pass 1
+    std::unique_ptr<GDALRasterPolygonEnumerator> poEnum{};
+    std::vector<int> anPolySizes{};
+    std::vector<std::int64_t> anFirstLineVal{};
+    std::vector<GInt32> anFirstLineId{};
+    std::vector<std::int64_t> anLastLineVal{};
+    std::vector<GInt32> anLastLineId{};
+
+    // Global id of the local polygon fragment 0.
+    int nIdOffset = 0;
+
+    // Pass 2: root ids of the line above the strip (empty for the first
+    // strip), and biggest neighbour of the polygons touching the strip,
+    // in the order they are met.
+    std::vector<GInt32> anLineAboveRootId{};
+    std::unordered_map<int, int> oMapBigNeighbour{};
+};
+}  // namespace
+
+// Read nLines lines of the source band, with pixels masked out by the mask
+// band set to GP_NODATA_MARKER. panUnmaskedVal, if not NULL, receives the
+// values before masking.
+static CPLErr GPSieveReadLines(GPSieveContext *psContext, int nYOff,
+                               int nLines, std::int64_t *panVal,
+                               std::int64_t *panUnmaskedVal,
+                               std::vector<GByte> &abyMask)
+{
+    const int nXSize = psContext->nXSize;
+    const size_t nCount = static_cast<size_t>(nXSize) * nLines;
+    std::lock_guard<std::mutex> oLock(psContext->oMutex);
+    CPLErr eErr =
+        GDALRasterIO(psContext->hSrcBand, GF_Read, 0, nYOff, nXSize, nLines,
+                     panVal, nXSize, nLines, GDT_Int64, 0, 0);
+    if (eErr == CE_None && panUnmaskedVal != nullptr)
+        memcpy(panUnmaskedVal, panVal, sizeof(panVal[0]) * nCount);
+    if (eErr == CE_None && psContext->hMaskBand != nullptr)
+    {
+        abyMask.resize(nCount);
+        eErr = GDALRasterIO(psContext->hMaskBand, GF_Read, 0, nYOff, nXSize,
+                            nLines, abyMask.data(), nXSize, nLines, GDT_Byte, 0,
+                            0);
+        if (eErr == CE_None)
+        {
+            for (size_t i = 0; i < nCount; i++)
+            {
+                if (abyMask[i] == 0)
+                    panVal[i] = GP_NODATA_MARKER;
+            }
+        }
+    }
+    return eErr;
+}
+
+// Account for nLines processed lines, and report progress.
+static bool GPSieveProgress(GPSieveContext *psContext, int nLines)
+{
+    std::lock_guard<std::mutex> oLock(psContext->oMutex);
+    psContext->nLinesDone += nLines;
+    if (!psContext->bInterrupted &&
+        !psContext->pfnProgress(
+            psContext->dfProgressStart +
+                (psContext->nPass == 3 ? 0.5 : 0.25) * psContext->nLinesDone /
+                    psContext->nYSize,
+            "", psContext->pProgressArg))
+    {
+        psContext->bInterrupted = true;
+    }
+    return !psContext->bInterrupted;
+}
+
+static inline void GPCompareNeighbourRoots(int nPolyId1, int nPolyId2,
+                                           const std::vector<int> &anPolySizes,
+                                           std::unordered_map<int, int> &oMap)
+{
+    if (nPolyId1 < 0 || nPolyId2 < 0 || nPolyId1 == nPolyId2)
+        return;
+
+    int &nBigNeighbour1 = oMap.emplace(nPolyId1, -1).first->second;
+    if (nBigNeighbour1 == -1 ||
+        anPolySizes[nBigNeighbour1] < anPolySizes[nPolyId2])
+        nBigNeighbour1 = nPolyId2;
+
+    int &nBigNeighbour2 = oMap.emplace(nPolyId2, -1).first->second;
+    if (nBigNeighbour2 == -1 ||
+        anPolySizes[nBigNeighbour2] < anPolySizes[nPolyId1])
+        nBigNeighbour2 = nPolyId1;
+}
+
+// Process a strip for the pass psContext->nPass:
+// 1) enumerate its polygons and accumulate their sizes,
+// 2) identify the largest neighbour of each polygon,
+// 3) apply the merges.
+// The polygon enumeration of passes 2 and 3 gives the same local ids as
+// pass 1.
+static void GPSieveStripJobFunc(void *pData)
+{
+    GPSieveStrip *psStrip = static_cast<GPSieveStrip *>(pData);
+    GPSieveContext *psContext = psStrip->psContext;
+    const int nXSize = psContext->nXSize;
+    const int nPass = psContext->nPass;
+    const int nChunkLines =
+        std::max(1, std::min(psStrip->nYSize, 1024 * 1024 / nXSize));
+
+    // Each buffer has the last line of the previous chunk, followed by the
+    // lines of the current chunk.
+    std::vector<std::int64_t> anVal;
+    std::vector<std::int64_t> anWriteVal;
+    std::vector<GInt32> anId;
+    std::vector<GInt32> anRootId;
+    std::vector<GByte> abyMask;
+    try
+    {
+        anVal.resize(static_cast<size_t>(nChunkLines + 1) * nXSize);
+        anId.resize(static_cast<size_t>(nChunkLines + 1) * nXSize);
+        if (nPass == 2)
+            anRootId.resize(2 * static_cast<size_t>(nXSize));
+        if (nPass == 3)
+            anWriteVal.resize(static_cast<size_t>(nChunkLines) * nXSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate working buffers");
+        psStrip->eErr = CE_Failure;
+        return;
+    }
+
+    GDALRasterPolygonEnumerator oLocalEnum(psContext->nConnectedness);
+    GDALRasterPolygonEnumerator &oEnum =
+        nPass == 1 ? *(psStrip->poEnum) : oLocalEnum;
+    GInt32 *panLastRootId = anRootId.data();
+    GInt32 *panThisRootId = anRootId.data() + nXSize;
+    if (nPass == 2 && !psStrip->anLineAboveRootId.empty())
+    {
+        memcpy(panLastRootId, psStrip->anLineAboveRootId.data(),
+               sizeof(GInt32) * nXSize);
+    }
+
+    for (int iChunk = 0; iChunk < psStrip->nYSize; iChunk += nChunkLines)
+    {
+        const int nLines = std::min(nChunkLines, psStrip->nYSize - iChunk);
+        if (iChunk > 0)
+        {
+            memcpy(anVal.data(),
+                   anVal.data() + static_cast<size_t>(nChunkLines) * nXSize,
+                   sizeof(anVal[0]) * nXSize);
+            memcpy(anId.data(),
+                   anId.data() + static_cast<size_t>(nChunkLines) * nXSize,
+                   sizeof(anId[0]) * nXSize);
+        }
+        psStrip->eErr = GPSieveReadLines(
+            psContext, psStrip->nYOff + iChunk, nLines, anVal.data() + nXSize,
+            nPass == 3 ? anWriteVal.data() : nullptr, abyMask);
+        if (psStrip->eErr != CE_None)
+            return;
+
+        for (int iLine = 1; iLine <= nLines; iLine++)
+        {
+            const int iY = iChunk + iLine - 1;
+            std::int64_t *panThisLineVal =
+                anVal.data() + static_cast<size_t>(iLine) * nXSize;
+            GInt32 *panThisLineId =
+                anId.data() + static_cast<size_t>(iLine) * nXSize;
+            if (!oEnum.ProcessLine(iY == 0 ? nullptr : panThisLineVal - nXSize,
+                                   panThisLineVal,
+                                   iY == 0 ? nullptr : panThisLineId - nXSize,
+                                   panThisLineId, nXSize))
+            {
+                psStrip->eErr = CE_Failure;
+                return;
+            }
+
+            if (nPass == 1)
+            {
+                if (oEnum.nNextPolygonId >
+                    static_cast<int>(psStrip->anPolySizes.size()))
+                    psStrip->anPolySizes.resize(oEnum.nNextPolygonId);
+
+                for (int iX = 0; iX < nXSize; iX++)
+                {
+                    const int iPoly = panThisLineId[iX];
+
+                    if (iPoly >= 0 && psStrip->anPolySizes[iPoly] < MY_MAX_INT)
+                        psStrip->anPolySizes[iPoly] += 1;
+                }
+
+                if (iY == 0)
+                {
+                    psStrip->anFirstLineVal.assign(panThisLineVal,
+                                                   panThisLineVal + nXSize);
+                    psStrip->anFirstLineId.assign(panThisLineId,
+                                                  panThisLineId + nXSize);
+                }
+                if (iY == psStrip->nYSize - 1)
+                {
+                    psStrip->anLastLineVal.assign(panThisLineVal,
+                                                  panThisLineVal + nXSize);
+                    psStrip->anLastLineId.assign(panThisLineId,
+                                                 panThisLineId + nXSize);
+                }
+            }
+            else if (nPass == 2)
+            {
+                for (int iX = 0; iX < nXSize; iX++)
+                {
+                    const int iPoly = panThisLineId[iX];
+                    panThisRootId[iX] =
+                        iPoly >= 0
+                            ? psContext->anRootId[psStrip->nIdOffset + iPoly]
+                            : -1;
+                }
+
+                const bool bHasLastLine =
+                    iY > 0 || !psStrip->anLineAboveRootId.empty();
+                const auto &anPolySizes = psContext->anPolySizes;
+                auto &oMap = psStrip->oMapBigNeighbour;
+                for (int iX = 0; iX < nXSize; iX++)
+                {
+                    if (bHasLastLine)
+                    {
+                        GPCompareNeighbourRoots(panThisRootId[iX],
+                                                panLastRootId[iX], anPolySizes,
+                                                oMap);
+
+                        if (iX > 0 && psContext->nConnectedness == 8)
+                            GPCompareNeighbourRoots(panThisRootId[iX],
+                                                    panLastRootId[iX - 1],
+                                                    anPolySizes, oMap);
+
+                        if (iX < nXSize - 1 && psContext->nConnectedness == 8)
+                            GPCompareNeighbourRoots(panThisRootId[iX],
+                                                    panLastRootId[iX + 1],
+                                                    anPolySizes, oMap);
+                    }
+
+                    if (iX > 0)
+                        GPCompareNeighbourRoots(panThisRootId[iX],
+                                                panThisRootId[iX - 1],
+                                                anPolySizes, oMap);
+                }
+                std::swap(panLastRootId, panThisRootId);
+            }
+            else
+            {
+                std::int64_t *panThisLineWriteVal =
+                    anWriteVal.data() + static_cast<size_t>(iLine - 1) * nXSize;
+                for (int iX = 0; iX < nXSize; iX++)
+                {
+                    const int iPoly = panThisLineId[iX];
+                    if (iPoly >= 0)
+                    {
+                        const int iThisPoly =
+                            psContext->anRootId[psStrip->nIdOffset + iPoly];
+                        const int iBigNeighbour =
+                            psContext->anBigNeighbour[iThisPoly];
+                        if (iBigNeighbour != -1)
+                        {
+                            panThisLineWriteVal[iX] =
+                                psContext->anPolyValue[iBigNeighbour];
+                        }
+                    }
+                }
+            }
+        }
+
+        if (nPass == 3)
+        {
+            std::lock_guard<std::mutex> oLock(psContext->oMutex);
+            psStrip->eErr = GDALRasterIO(
+                psContext->hDstBand, GF_Write, 0, psStrip->nYOff + iChunk,
+                nXSize, nLines, anWriteVal.data(), nXSize, nLines, GDT_Int64,
+                0, 0);
+            if (psStrip->eErr != CE_None)
+                return;
+        }
+
+        if (!GPSieveProgress(psContext, nLines))
+        {
+            psStrip->eErr = CE_Failure;
+            return;
+        }
+    }
+
+    if (nPass == 1)
+        oEnum.CompleteMerges();
+}
+
+/************************************************************************/
+/*                          GPSieveFindRoot()                           */
+/************************************************************************/
+
+static int GPSieveFindRoot(std::vector<GInt32> &anParent, int iPoly)
+{
+    while (anParent[iPoly] != iPoly)
+    {
+        anParent[iPoly] = anParent[anParent[iPoly]];
+        iPoly = anParent[iPoly];
+    }
+    return iPoly;
+}
+
+/************************************************************************/
+/*                     GPSieveFilterMultiThreaded()                     */
+/************************************************************************/
+
+// Same algorithm as GDALSieveFilter(), but with the passes run on
+// horizontal strips in parallel. The polygons of the strips are enumerated
+// independently, and then the fragments of polygons crossing strip
+// boundaries are united. The largest neighbours found in each strip are
+// combined in the order of the strips, so that the result is the same as
+// the single-threaded one.
+static CPLErr GPSieveFilterMultiThreaded(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
+    GDALRasterBandH hDstBand, int nSizeThreshold, int nConnectedness,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    GPSieveContext sContext;
+    sContext.hSrcBand = hSrcBand;
+    sContext.hMaskBand = hMaskBand;
+    sContext.hDstBand = hDstBand;
+    sContext.nXSize = GDALGetRasterBandXSize(hSrcBand);
+    sContext.nYSize = GDALGetRasterBandYSize(hSrcBand);
+    sContext.nConnectedness = nConnectedness;
+    sContext.pfnProgress = pfnProgress;
+    sContext.pProgressArg = pProgressArg;
+
+    const int nStrips = std::min(nThreads, sContext.nYSize);
+    std::vector<GPSieveStrip> asStrips(nStrips);
+    for (int iStrip = 0; iStrip < nStrips; iStrip++)
+    {
+        GPSieveStrip &sStrip = asStrips[iStrip];
+        sStrip.psContext = &sContext;
+        sStrip.nYOff = static_cast<int>(static_cast<GIntBig>(sContext.nYSize) *
+                                        iStrip / nStrips);
+        sStrip.nYSize = static_cast<int>(static_cast<GIntBig>(sContext.nYSize) *
+                                         (iStrip + 1) / nStrips) -
+                        sStrip.nYOff;
+    }
+
+    auto poPool = GDALGetGlobalThreadPool(nThreads);
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    const auto RunPass = [&sContext, &asStrips, &poQueue](int nPass,
+                                                          double dfStart)
+    {
+        sContext.nPass = nPass;
+        sContext.dfProgressStart = dfStart;
+        sContext.nLinesDone = 0;
+        for (auto &sStrip : asStrips)
+        {
+            if (poQueue)
+                poQueue->SubmitJob(GPSieveStripJobFunc, &sStrip);
+            else
+                GPSieveStripJobFunc(&sStrip);
+        }
+        if (poQueue)
+            poQueue->WaitCompletion();
+
+        if (sContext.bInterrupted)
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return false;
+        }
+        for (const auto &sStrip : asStrips)
+        {
+            if (sStrip.eErr != CE_None)
+                return false;
+        }
+        return true;
+    };
+
+    /* -------------------------------------------------------------------- */
+    /*      First pass: enumerate the polygons of each strip.               */
+    /* -------------------------------------------------------------------- */
+    for (auto &sStrip : asStrips)
+    {
+        sStrip.poEnum =
+            std::make_unique<GDALRasterPolygonEnumerator>(nConnectedness);
+    }
+    if (!RunPass(1, 0.0))
+        return CE_Failure;
+
+    /* -------------------------------------------------------------------- */
+    /*      Concatenate the polygon maps of the strips, and unite the       */
+    /*      fragments touching each other at the strip boundaries.          */
+    /* -------------------------------------------------------------------- */
+    auto &anRootId = sContext.anRootId;
+    auto &anPolyValue = sContext.anPolyValue;
+    auto &anPolySizes = sContext.anPolySizes;
+    std::vector<int> anFragmentSizes;
+    try
+    {
+        GIntBig nPolyCount = 0;
+        for (const auto &sStrip : asStrips)
+            nPolyCount += sStrip.poEnum->nNextPolygonId;
+        if (nPolyCount > std::numeric_limits<int>::max())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "GDALSieveFilter(): maximum number of polygons reached");
+            return CE_Failure;
+        }
+
+        for (auto &sStrip : asStrips)
+        {
+            sStrip.nIdOffset = static_cast<int>(anRootId.size());
+            const auto poEnum = sStrip.poEnum.get();
+            for (int iPoly = 0; iPoly < poEnum->nNextPolygonId; iPoly++)
+            {
+                anRootId.push_back(sStrip.nIdOffset +
+                                   poEnum->panPolyIdMap[iPoly]);
+                anPolyValue.push_back(poEnum->panPolyValue[iPoly]);
+            }
+            sStrip.anPolySizes.resize(poEnum->nNextPolygonId);
+            anFragmentSizes.insert(anFragmentSizes.end(),
+                                   sStrip.anPolySizes.begin(),
+                                   sStrip.anPolySizes.end());
+            sStrip.anPolySizes = std::vector<int>();
+            sStrip.poEnum.reset();
+        }
+
+        const int nXSize = sContext.nXSize;
+        for (int iStrip = 1; iStrip < nStrips; iStrip++)
+        {
+            const GPSieveStrip &sAbove = asStrips[iStrip - 1];
+            const GPSieveStrip &sBelow = asStrips[iStrip];
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                if (sBelow.anFirstLineId[iX] < 0)
+                    continue;
+                const std::int64_t nVal = sBelow.anFirstLineVal[iX];
+                int iPoly = GPSieveFindRoot(
+                    anRootId, sBelow.nIdOffset + sBelow.anFirstLineId[iX]);
+                for (int iDX = -1; iDX <= 1; iDX++)
+                {
+                    const int iXAbove = iX + iDX;
+                    if ((iDX != 0 && nConnectedness != 8) || iXAbove < 0 ||
+                        iXAbove >= nXSize ||
+                        sAbove.anLastLineVal[iXAbove] != nVal)
+                        continue;
+                    const int iPolyAbove = GPSieveFindRoot(
+                        anRootId,
+                        sAbove.nIdOffset + sAbove.anLastLineId[iXAbove]);
+                    if (iPolyAbove != iPoly)
+                    {
+                        anRootId[std::max(iPoly, iPolyAbove)] =
+                            std::min(iPoly, iPolyAbove);
+                        iPoly = std::min(iPoly, iPolyAbove);
+                    }
+                }
+            }
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Make every fragment point to its root, and push the sizes   */
+        /*      of the fragments into their root's count.                   */
+        /* ---------------------------------------------------------------- */
+        const int nPolyCountInt = static_cast<int>(nPolyCount);
+        anPolySizes.resize(nPolyCountInt);
+        for (int iPoly = 0; iPoly < nPolyCountInt; iPoly++)
+        {
+            const int iRoot = GPSieveFindRoot(anRootId, iPoly);
+            anRootId[iPoly] = iRoot;
+            const GIntBig nSize = static_cast<GIntBig>(anPolySizes[iRoot]) +
+                                  anFragmentSizes[iPoly];
+            anPolySizes[iRoot] =
+                static_cast<int>(std::min<GIntBig>(nSize, MY_MAX_INT));
+        }
+        anFragmentSizes = std::vector<int>();
+        sContext.anBigNeighbour.resize(nPolyCountInt, -1);
+
+        for (int iStrip = 1; iStrip < nStrips; iStrip++)
+        {
+            const GPSieveStrip &sAbove = asStrips[iStrip - 1];
+            GPSieveStrip &sBelow = asStrips[iStrip];
+            sBelow.anLineAboveRootId.resize(nXSize);
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                const int iPoly = sAbove.anLastLineId[iX];
+                sBelow.anLineAboveRootId[iX] =
+                    iPoly >= 0 ? anRootId[sAbove.nIdOffset + iPoly] : -1;
+            }
+        }
+        for (auto &sStrip : asStrips)
+        {
+            sStrip.anFirstLineVal = std::vector<std::int64_t>();
+            sStrip.anFirstLineId = std::vector<GInt32>();
+            sStrip.anLastLineVal = std::vector<std::int64_t>();
+            sStrip.anLastLineId = std::vector<GInt32>();
+        }
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate polygon maps");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Second pass: identify the largest neighbour of each polygon.    */
+    /* -------------------------------------------------------------------- */
+    if (!RunPass(2, 0.25))
+        return CE_Failure;
+
+    for (auto &sStrip : asStrips)
+    {
+        for (const auto &oIter : sStrip.oMapBigNeighbour)
+        {
+            int &nBigNeighbour = sContext.anBigNeighbour[oIter.first];
+            if (nBigNeighbour == -1 ||
+                anPolySizes[nBigNeighbour] < anPolySizes[oIter.second])
+                nBigNeighbour = oIter.second;
+        }
+        sStrip.oMapBigNeighbour = std::unordered_map<int, int>();
+    }
+
+    GPResolveMerges(anRootId.data(), anPolyValue.data(), anPolySizes,
+                    sContext.anBigNeighbour, nSizeThreshold);
+
+    /* -------------------------------------------------------------------- */
+    /*      Third pass: apply the merges.                                   */
+    /* -------------------------------------------------------------------- */
+    if (!RunPass(3, 0.5))
+        return CE_Failure;
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                          GDALSieveFilter()                           */
 /************************************************************************/
@@ -183,8 +849,14 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
  * @param nConnectedness either 4 indicating that diagonal pixels are not
  * considered directly adjacent for polygon membership purposes or 8
  * indicating they are.
- * @param papszOptions algorithm options in name=value list form.  None
- * currently supported.
+ * @param papszOptions algorithm options in name=value list form. The
+ * following option is supported:
+ * <ul>
+ * <li>NUM_THREADS=n/ALL_CPUS (GDAL >= 3.9). Number of threads used to process
+ * horizontal strips of the raster in parallel. Defaults to the
+ * GDAL_NUM_THREADS configuration option, or 1. The result does not depend on
+ * the number of threads.</li>
+ * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
  * @param pProgressArg callback argument passed to pfnProgress.
@@ -196,7 +868,7 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
                                    GDALRasterBandH hMaskBand,
                                    GDALRasterBandH hDstBand, int nSizeThreshold,
                                    int nConnectedness,
-                                   CPL_UNUSED char **papszOptions,
+                                   char **papszOptions,
                                    GDALProgressFunc pfnProgress,
                                    void *pProgressArg)
 {
@@ -206,11 +878,26 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
 
+    int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads == nullptr)
+        pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads =
+        std::max(1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                                      ? CPLGetNumCPUs()
+                                      : atoi(pszNumThreads)));
+    if (nThreads > 1 && nYSize > 1)
+    {
+        return GPSieveFilterMultiThreaded(hSrcBand, hMaskBand, hDstBand,
+                                          nSizeThreshold, nConnectedness,
+                                          nThreads, pfnProgress, pProgressArg);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate working buffers.                                       */
     /* -------------------------------------------------------------------- */
-    int nXSize = GDALGetRasterBandXSize(hSrcBand);
-    int nYSize = GDALGetRasterBandYSize(hSrcBand);
     auto *panLastLineVal = static_cast<std::int64_t *>(
         VSI_MALLOC2_VERBOSE(sizeof(std::int64_t), nXSize));
     auto *panThisLineVal = static_cast<std::int64_t *>(
@@ -457,81 +1144,8 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
     /*      threshold, then try tracking to that polygons biggest           */
     /*      neighbour, and so forth.                                        */
     /* -------------------------------------------------------------------- */
-    int nFailedMerges = 0;
-    int nIsolatedSmall = 0;
-    int nSieveTargets = 0;
-
-    for (int iPoly = 0; iPoly < static_cast<int>(anPolySizes.size()); iPoly++)
-    {
-        if (oFirstEnum.panPolyIdMap[iPoly] != iPoly)
-            continue;
-
-        // Ignore nodata polygons.
-        if (oFirstEnum.panPolyValue[iPoly] == GP_NODATA_MARKER)
-            continue;
-
-        // Don't try to merge polygons larger than the threshold.
-        if (anPolySizes[iPoly] >= nSizeThreshold)
-        {
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
-
-        nSieveTargets++;
-
-        // if we have no neighbours but we are small, what shall we do?
-        if (anBigNeighbour[iPoly] == -1)
-        {
-            nIsolatedSmall++;
-            continue;
-        }
-
-        std::set<int> oSetVisitedPoly;
-        oSetVisitedPoly.insert(iPoly);
-
-        // Walk through our neighbours until we find a polygon large enough.
-        int iFinalId = iPoly;
-        bool bFoundBigEnoughPoly = false;
-        while (true)
-        {
-            iFinalId = anBigNeighbour[iFinalId];
-            if (iFinalId < 0)
-            {
-                break;
-            }
-            // If the biggest neighbour is larger than the threshold
-            // then we are golden.
-            if (anPolySizes[iFinalId] >= nSizeThreshold)
-            {
-                bFoundBigEnoughPoly = true;
-                break;
-            }
-            // Check that we don't cycle on an already visited polygon.
-            if (oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end())
-                break;
-            oSetVisitedPoly.insert(iFinalId);
-        }
-
-        if (!bFoundBigEnoughPoly)
-        {
-            nFailedMerges++;
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
-
-        // Map the whole intermediate chain to it.
-        int iPolyCur = iPoly;
-        while (anBigNeighbour[iPolyCur] != iFinalId)
-        {
-            int iNextPoly = anBigNeighbour[iPolyCur];
-            anBigNeighbour[iPolyCur] = iFinalId;
-            iPolyCur = iNextPoly;
-        }
-    }
-
-    CPLDebug("GDALSieveFilter",
-             "Small Polygons: %d, Isolated: %d, Unmergable: %d", nSieveTargets,
-             nIsolatedSmall, nFailedMerges);
+    GPResolveMerges(oFirstEnum.panPolyIdMap, oFirstEnum.panPolyValue,
+                    anPolySizes, anBigNeighbour, nSizeThreshold);
 
     /* ==================================================================== */
     /*      Make a third pass over the image, actually applying the         */
@@ -53,6 +53,10 @@
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#if defined(__x86_64) || defined(_M_X64)
+#define USE_SSE2_OPTIM
+#include "gdalsse_priv.h"
+#endif
 #include "ogr_core.h"
 #include "ogr_spatialref.h"
 #include "ogr_srs_api.h"
@@ -1723,6 +1727,11 @@ static void GDALGCPAntimeridianUnwrap(int nGCPCount, GDAL_GCP *pasGCPList,
  * possible.  The default is to autoselect based on the number of GCPs.
  * A value of -1 triggers use of Thin Plate Spline instead of polynomials.
  * </li>
+ * <li> NUM_THREADS=number_of_threads or ALL_CPUS. (GDAL &gt;= 3.9) Number of
+ * threads used by the Thin Plate Spline transformer, when there are more than
+ * 100 GCPs, to solve its equations and to transform large batches of points.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option.
+ * </li>
  * <li>GCP_ANTIMERIDIAN_UNWRAP=AUTO/YES/NO. (GDAL &gt;= 3.8) Whether to
  * "unwrap" longitudes of ground control points that span the antimeridian.
  * For datasets with GCPs in longitude/latitude coordinate space spanning the
@@ -1804,6 +1813,13 @@ static void GDALGCPAntimeridianUnwrap(int nGCPCount, GDAL_GCP *pasGCPList,
  * the backmap. The default is NO, that is to use in-memory arrays, unless the
  * number of pixels of the geolocation array is greater than 16 megapixels.
  * </li>
+ * <li> GEOLOC_BACKMAP_CACHE_DIR=directory. (GDAL &gt;= 3.9) Directory where
+ * the "backmap" of geolocation array transformers is saved once computed, and
+ * reloaded from when the same geolocation arrays are used again. The cache
+ * key is a hash of the content of the geolocation arrays and of the
+ * parameters affecting the backmap. May also be set with the
+ * GDAL_GEOLOC_BACKMAP_CACHE_DIR configuration option. Disabled by default.
+ * </li>
  * <li>
  * GEOLOC_ARRAY/SRC_GEOLOC_ARRAY=filename. (GDAL &gt;= 3.5.2) Name of a GDAL
  * dataset containing a geolocation array and associated metadata. This is an
@@ -2760,6 +2776,64 @@ void GDALDestroyGenImgProjTransformer(void *hTransformArg)
     CPLFree(psInfo);
 }
 
+/************************************************************************/
+/*                      GDALApplyGeoTransformToPoints()                 */
+/************************************************************************/
+
+// Apply a geotransform to the points whose transformation has succeeded so
+// far, two at a time with SSE2 when available.
+static void GDALApplyGeoTransformToPoints(const double *padfGeoTransform,
+                                          int nPointCount, double *padfX,
+                                          double *padfY, const int *panSuccess)
+{
+    const auto ApplyToPoint = [padfGeoTransform, padfX, padfY](int i)
+    {
+        const double dfNewX = padfGeoTransform[0] +
+                              padfX[i] * padfGeoTransform[1] +
+                              padfY[i] * padfGeoTransform[2];
+        const double dfNewY = padfGeoTransform[3] +
+                              padfX[i] * padfGeoTransform[4] +
+                              padfY[i] * padfGeoTransform[5];
+
+        padfX[i] = dfNewX;
+        padfY[i] = dfNewY;
+    };
+
+    int i = 0;
+#ifdef USE_SSE2_OPTIM
+    const auto gt0 = XMMReg2Double::Load1ValHighAndLow(padfGeoTransform + 0);
+    const auto gt1 = XMMReg2Double::Load1ValHighAndLow(padfGeoTransform + 1);
+    const auto gt2 = XMMReg2Double::Load1ValHighAndLow(padfGeoTransform + 2);
+    const auto gt3 = XMMReg2Double::Load1ValHighAndLow(padfGeoTransform + 3);
+    const auto gt4 = XMMReg2Double::Load1ValHighAndLow(padfGeoTransform + 4);
+    const auto gt5 = XMMReg2Double::Load1ValHighAndLow(padfGeoTransform + 5);
+    for (; i + 1 < nPointCount; i += 2)
+    {
+        if (panSuccess[i] && panSuccess[i + 1])
+        {
+            const auto x = XMMReg2Double::Load2Val(padfX + i);
+            const auto y = XMMReg2Double::Load2Val(padfY + i);
+            const auto newX = gt0 + x * gt1 + y * gt2;
+            const auto newY = gt3 + x * gt4 + y * gt5;
+            newX.Store2Val(padfX + i);
+            newY.Store2Val(padfY + i);
+        }
+        else
+        {
+            if (panSuccess[i])
+                ApplyToPoint(i);
+            if (panSuccess[i + 1])
+                ApplyToPoint(i + 1);
+        }
+    }
+#endif
+    for (; i < nPointCount; i++)
+    {
+        if (panSuccess[i])
+            ApplyToPoint(i);
+    }
+}
+
 /************************************************************************/
 /*                      GDALGenImgProjTransform()                       */
 /************************************************************************/
@@ -2822,21 +2896,8 @@ int GDALGenImgProjTransform(void *pTransformArgIn, int bDstToSrc,
     }
     else
     {
-        for (int i = 0; i < nPointCount; i++)
-        {
-            if (!panSuccess[i])
-                continue;
-
-            const double dfNewX = padfGeoTransform[0] +
-                                  padfX[i] * padfGeoTransform[1] +
-                                  padfY[i] * padfGeoTransform[2];
-            const double dfNewY = padfGeoTransform[3] +
-                                  padfX[i] * padfGeoTransform[4] +
-                                  padfY[i] * padfGeoTransform[5];
-
-            padfX[i] = dfNewX;
-            padfY[i] = dfNewY;
-        }
+        GDALApplyGeoTransformToPoints(padfGeoTransform, nPointCount, padfX,
+                                      padfY, panSuccess);
     }
 
     /* -------------------------------------------------------------------- */
@@ -2873,21 +2934,8 @@ int GDALGenImgProjTransform(void *pTransformArgIn, int bDstToSrc,
     }
     else
     {
-        for (int i = 0; i < nPointCount; i++)
-        {
-            if (!panSuccess[i])
-                continue;
-
-            const double dfNewX = padfGeoTransform[0] +
-                                  padfX[i] * padfGeoTransform[1] +
-                                  padfY[i] * padfGeoTransform[2];
-            const double dfNewY = padfGeoTransform[3] +
-                                  padfX[i] * padfGeoTransform[4] +
-                                  padfY[i] * padfGeoTransform[5];
-
-            padfX[i] = dfNewX;
-            padfY[i] = dfNewY;
-        }
+        GDALApplyGeoTransformToPoints(padfGeoTransform, nPointCount, padfX,
+                                      padfY, panSuccess);
     }
 
     return TRUE;
@@ -4077,7 +4125,34 @@ static int GDALApproxTransformInternal(void *pCBData, int bDstToSrc,
     /*      NOTE: the above comment is not true: gdalwarp uses approximator */
     /*      also to compute the source pixel of each target pixel.          */
     /* -------------------------------------------------------------------- */
-    for (int i = nPoints - 1; i >= 0; i--)
+    int iFirst = nPoints - 1;
+#if defined(USE_SSE2_OPTIM) && !defined(check_error)
+    {
+        const auto x0 = XMMReg2Double::Load1ValHighAndLow(x);
+        const auto xStart =
+            XMMReg2Double::Load1ValHighAndLow(xSMETransformed + 0);
+        const auto yStart =
+            XMMReg2Double::Load1ValHighAndLow(ySMETransformed + 0);
+        const auto zStart =
+            XMMReg2Double::Load1ValHighAndLow(zSMETransformed + 0);
+        const auto deltaX = XMMReg2Double::Load1ValHighAndLow(&dfDeltaX);
+        const auto deltaY = XMMReg2Double::Load1ValHighAndLow(&dfDeltaY);
+        const auto deltaZ = XMMReg2Double::Load1ValHighAndLow(&dfDeltaZ);
+        // x[0] is used by all points, so it is overwritten last, by the
+        // scalar loop below.
+        for (int i = nPoints - 2; i >= 1; i -= 2)
+        {
+            const auto dist = XMMReg2Double::Load2Val(x + i) - x0;
+            (xStart + deltaX * dist).Store2Val(x + i);
+            (yStart + deltaY * dist).Store2Val(y + i);
+            (zStart + deltaZ * dist).Store2Val(z + i);
+            panSuccess[i] = TRUE;
+            panSuccess[i + 1] = TRUE;
+        }
+        iFirst = (nPoints % 2) == 0 ? 1 : 0;
+    }
+#endif
+    for (int i = iFirst; i >= 0; i--)
     {
 #ifdef check_error
         double xtemp = x[i];
@@ -1102,6 +1102,14 @@ CPLErr GDALWarpDstAlphaMasker(void *pMaskFuncArg, int nBandCount,
  * situations. Starting with GDAL 2.4, gdalwarp will automatically enable this
  * option when it is assumed to be safe to do so.</li>
  *
+ * <li>SKIP_EMPTY_SOURCE=YES/NO: (GDAL >= 3.9) Whether to skip the reading
+ * and warping of chunks whose source window only contains pixels at the source
+ * nodata value, according to GDALGetDataCoverageStatus(), such as missing
+ * blocks of sparse files or areas of VRT mosaics without sources. This is
+ * only done when the nodata value of the source bands is the one used by the
+ * warper. Such chunks are dropped when SKIP_NOSOURCE=YES, and otherwise their
+ * destination is just initialized and written. Defaults to YES.</li>
+ *
  * <li>UNIFIED_SRC_NODATA=YES/NO/PARTIAL: This setting determines
  * how to take into account nodata values when there are several input bands.
  * <ul>
@@ -1210,6 +1218,22 @@ CPLErr GDALWarpDstAlphaMasker(void *pMaskFuncArg, int nBandCount,
  * metadata item, it is used to set DST_ALPHA_MAX = 2^NBITS-1. Otherwise, if the
  * value is not set and the alpha band is of type UInt16 (resp Int16), 65535
  * (resp 32767) is used. Otherwise, 255 is used.</li>
+ *
+ * <li>USE_OPENCL=YES/NO, or its alias USE_GPU=YES/NO: (USE_GPU since
+ * GDAL 3.9) Whether to use the OpenCL warping kernel, which runs on the GPU
+ * when one is available, in builds with OpenCL support. Defaults to the
+ * value of the GDAL_USE_OPENCL configuration option, or NO. It is only used
+ * for Byte, Int16, UInt16, Float32, CInt16 and CFloat32 working data types,
+ * bilinear, cubic, cubicspline and lanczos resampling, without vertical
+ * shift, source density mask (cutline or source alpha band). The CPU kernels
+ * are used otherwise, and the reason is reported as a debug message.</li>
+ *
+ * <li>PREFETCH_CHUNKS=AUTO/NO/number: (GDAL >= 3.9) Maximum number of chunks
+ * whose source window is read ahead, concurrently, by
+ * GDALWarpOperation::ChunkAndWarpMulti() while the current chunk is warped.
+ * Only used when the source dataset is opened in read-only mode by a driver
+ * declaring GDAL_DCAP_PARALLEL_CLONE_READ. The buffers read ahead and not yet
+ * warped are limited to dfWarpMemoryLimit. AUTO, the default, is 4.</li>
  * </ul>
  *
  * Normally when computing the source raster data to
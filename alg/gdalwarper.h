@@ -291,6 +291,45 @@ GDALSerializeWarpOptions(const GDALWarpOptions *);
 GDALWarpOptions CPL_DLL *CPL_STDCALL GDALDeserializeWarpOptions(CPLXMLNode *);
 /*! @endcond */
 
+/************************************************************************/
+/*                          GDALWarpStatistics                          */
+/************************************************************************/
+
+/** Counters cumulated by a warp operation over the chunks it processes.
+ *
+ * Times are in seconds. When several threads are involved, they are summed
+ * over the threads, and can thus exceed the elapsed time. Comparing the
+ * reading and writing times with the other ones tells whether the operation
+ * is I/O bound or CPU bound.
+ *
+ * @since GDAL 3.9
+ */
+typedef struct
+{
+    /** Time spent reading source windows, including read-ahead */
+    double dfSrcReadTime;
+    /** Time spent computing validity and density masks, cutline included */
+    double dfMaskTime;
+    /** Time spent transforming coordinates, to compute source windows and
+     * in the warp kernel */
+    double dfTransformTime;
+    /** Time spent in the warp kernel, transformations excluded */
+    double dfKernelTime;
+    /** Time spent reading destination windows, when they are not
+     * initialized with INIT_DEST */
+    double dfDstReadTime;
+    /** Time spent writing destination windows */
+    double dfDstWriteTime;
+    /** Number of bytes of source windows read, in the working data type */
+    GIntBig nSrcBytesRead;
+    /** Number of bytes of destination windows written, in the working data
+     * type */
+    GIntBig nDstBytesWritten;
+    /** Number of chunks processed, including those skipped because their
+     * source window is empty */
+    int nChunksProcessed;
+} GDALWarpStatistics;
+
 /************************************************************************/
 /*                         GDALReprojectImage()                         */
 /************************************************************************/
@@ -460,6 +499,11 @@ class CPL_DLL GDALWarpKernel
     bool bApplyVerticalShift = false;
 
     double dfMultFactorVerticalShift = 1.0;
+
+    // Time spent in the resampling functions, and in transforming
+    // destination rows within them, cumulated over threads, in seconds.
+    double dfRunTime = 0;
+    double dfTransformTime = 0;
     /*! @endcond */
 
     GDALWarpKernel();
@@ -554,6 +598,8 @@ class CPL_DLL GDALWarpOperation
 
     const GDALWarpOptions *GetOptions();
 
+    void GetStatistics(GDALWarpStatistics *psStatistics);
+
     CPLErr ChunkAndWarpImage(int nDstXOff, int nDstYOff, int nDstXSize,
                              int nDstYSize);
     CPLErr ChunkAndWarpMulti(int nDstXOff, int nDstYOff, int nDstXSize,
@@ -595,6 +641,7 @@ CPLErr CPL_DLL GDALWarpRegion(GDALWarpOperationH, int, int, int, int, int, int,
                               int, int);
 CPLErr CPL_DLL GDALWarpRegionToBuffer(GDALWarpOperationH, int, int, int, int,
                                       void *, GDALDataType, int, int, int, int);
+void CPL_DLL GDALWarpGetStatistics(GDALWarpOperationH, GDALWarpStatistics *);
 
 /************************************************************************/
 /*      Warping kernel functions                                        */
@@ -39,9 +39,15 @@
 #include <cstring>
 
 #include <algorithm>
+#include <chrono>
 #include <limits>
+#include <list>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <new>
+#include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -205,6 +211,127 @@ static CPLErr GWKCubicNoMasksOrDstDensityOnlyUShort(GDALWarpKernel *);
 static CPLErr GWKCubicSplineNoMasksOrDstDensityOnlyUShort(GDALWarpKernel *);
 static CPLErr GWKBilinearNoMasksOrDstDensityOnlyUShort(GDALWarpKernel *);
 
+/************************************************************************/
+/*                          GWKTransformCache                           */
+/************************************************************************/
+
+// Source pixel/line coordinates of the centers of a row of destination pixels.
+struct GWKTransformedRow
+{
+    std::vector<double> adfX{};
+    std::vector<double> adfY{};
+    std::vector<double> adfZ{};
+    std::vector<int> abSuccess{};
+};
+
+// Rows transformed by one transformer, indexed by destination X offset,
+// X size and row.
+struct GWKTransformCache
+{
+    std::map<std::tuple<int, int, int>,
+             std::shared_ptr<const GWKTransformedRow>>
+        oMapRows{};
+    size_t nBytes = 0;
+    bool bEvicted = false;
+};
+
+// Caches of the process, indexed by the serialization of their transformer,
+// most recently used first, when GDAL_WARP_TRANSFORM_CACHE_MAX is set.
+static std::mutex gMutexTransformCache{};
+static std::list<std::pair<std::string, std::shared_ptr<GWKTransformCache>>>
+    gTransformCaches{};
+static size_t gnTransformCacheBytes = 0;
+
+static size_t GWKGetTransformCacheMax()
+{
+    const char *pszMax =
+        CPLGetConfigOption("GDAL_WARP_TRANSFORM_CACHE_MAX", "0");
+    GIntBig nMax = CPLAtoGIntBig(pszMax);
+    // Small values are in megabytes, like GDAL_CACHEMAX.
+    if (nMax < 100000)
+        nMax *= 1024 * 1024;
+    return nMax > 0 ? static_cast<size_t>(std::min<GUIntBig>(
+                          nMax, std::numeric_limits<size_t>::max()))
+                    : 0;
+}
+
+// Return the cache of the transformer of the warp kernel, or nullptr if
+// caching is disabled or the transformer cannot be serialized.
+static std::shared_ptr<GWKTransformCache>
+GWKGetTransformCache(const GDALWarpKernel *poWK)
+{
+    if (GWKGetTransformCacheMax() == 0 || poWK->pTransformerArg == nullptr)
+        return nullptr;
+
+    CPLXMLNode *psTree =
+        GDALSerializeTransformer(poWK->pfnTransformer, poWK->pTransformerArg);
+    if (psTree == nullptr)
+        return nullptr;
+    char *pszXML = CPLSerializeXMLTree(psTree);
+    CPLDestroyXMLNode(psTree);
+    if (pszXML == nullptr)
+        return nullptr;
+    const std::string osKey(pszXML);
+    CPLFree(pszXML);
+
+    std::lock_guard<std::mutex> oLock(gMutexTransformCache);
+    for (auto oIter = gTransformCaches.begin();
+         oIter != gTransformCaches.end(); ++oIter)
+    {
+        if (oIter->first == osKey)
+        {
+            gTransformCaches.splice(gTransformCaches.begin(), gTransformCaches,
+                                    oIter);
+            return gTransformCaches.front().second;
+        }
+    }
+    gTransformCaches.emplace_front(osKey,
+                                   std::make_shared<GWKTransformCache>());
+    return gTransformCaches.front().second;
+}
+
+static std::shared_ptr<const GWKTransformedRow>
+GWKGetTransformedRow(GWKTransformCache *poCache, int nDstXOff, int nDstXSize,
+                     int nDstY)
+{
+    std::lock_guard<std::mutex> oLock(gMutexTransformCache);
+    auto oIter =
+        poCache->oMapRows.find(std::make_tuple(nDstXOff, nDstXSize, nDstY));
+    if (oIter == poCache->oMapRows.end())
+        return nullptr;
+    return oIter->second;
+}
+
+static void
+GWKStoreTransformedRow(GWKTransformCache *poCache, int nDstXOff, int nDstXSize,
+                       int nDstY, std::shared_ptr<const GWKTransformedRow> poRow)
+{
+    const size_t nRowBytes =
+        static_cast<size_t>(nDstXSize) * (3 * sizeof(double) + sizeof(int));
+    const size_t nMax = GWKGetTransformCacheMax();
+
+    std::lock_guard<std::mutex> oLock(gMutexTransformCache);
+    // Evict the least recently used caches of other transformers.
+    while (gnTransformCacheBytes + nRowBytes > nMax &&
+           gTransformCaches.size() > 1 &&
+           gTransformCaches.back().second.get() != poCache)
+    {
+        gnTransformCacheBytes -= gTransformCaches.back().second->nBytes;
+        gTransformCaches.back().second->bEvicted = true;
+        gTransformCaches.pop_back();
+    }
+    if (poCache->bEvicted || gnTransformCacheBytes + nRowBytes > nMax)
+        return;
+    if (poCache->oMapRows
+            .emplace(std::make_tuple(nDstXOff, nDstXSize, nDstY),
+                     std::move(poRow))
+            .second)
+    {
+        poCache->nBytes += nRowBytes;
+        gnTransformCacheBytes += nRowBytes;
+    }
+}
+
 /************************************************************************/
 /*                           GWKJobStruct                               */
 /************************************************************************/
@@ -222,6 +349,11 @@ struct GWKJobStruct
     void *pTransformerArg;
     void (*pfnFunc)(
         void *);  // used by GWKRun() to assign the proper pTransformerArg
+    std::shared_ptr<GWKTransformCache> poTransformCache{};
+    // Time spent in pfnFunc, and in GWKTransformDstRow() calling the
+    // transformer, in seconds
+    double dfRunTime = 0;
+    double dfTransformTime = 0;
 
     GWKJobStruct(std::mutex &mutex_, std::condition_variable &cv_,
                  int &counter_, bool &stopFlag_)
@@ -232,6 +364,54 @@ struct GWKJobStruct
     }
 };
 
+/************************************************************************/
+/*                         GWKTransformDstRow()                         */
+/************************************************************************/
+
+// Transform the centers of the row iDstY of destination pixels, set in
+// padfX, padfY and padfZ, to source pixel/line coordinates, reusing the
+// result of a previous warp with the same transformer if it is cached.
+static void GWKTransformDstRow(GWKJobStruct *psJob, int iDstY, double *padfX,
+                               double *padfY, double *padfZ, int *pabSuccess)
+{
+    GDALWarpKernel *poWK = psJob->poWK;
+    const int nDstXSize = poWK->nDstXSize;
+    const int nDstY = iDstY + poWK->nDstYOff;
+    GWKTransformCache *poCache = psJob->poTransformCache.get();
+    if (poCache != nullptr)
+    {
+        const auto poRow =
+            GWKGetTransformedRow(poCache, poWK->nDstXOff, nDstXSize, nDstY);
+        if (poRow != nullptr)
+        {
+            memcpy(padfX, poRow->adfX.data(), sizeof(double) * nDstXSize);
+            memcpy(padfY, poRow->adfY.data(), sizeof(double) * nDstXSize);
+            memcpy(padfZ, poRow->adfZ.data(), sizeof(double) * nDstXSize);
+            memcpy(pabSuccess, poRow->abSuccess.data(),
+                   sizeof(int) * nDstXSize);
+            return;
+        }
+    }
+
+    const auto tStart = std::chrono::steady_clock::now();
+    poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX,
+                         padfY, padfZ, pabSuccess);
+    psJob->dfTransformTime += std::chrono::duration<double>(
+                                  std::chrono::steady_clock::now() - tStart)
+                                  .count();
+
+    if (poCache != nullptr)
+    {
+        auto poRow = std::make_shared<GWKTransformedRow>();
+        poRow->adfX.assign(padfX, padfX + nDstXSize);
+        poRow->adfY.assign(padfY, padfY + nDstXSize);
+        poRow->adfZ.assign(padfZ, padfZ + nDstXSize);
+        poRow->abSuccess.assign(pabSuccess, pabSuccess + nDstXSize);
+        GWKStoreTransformedRow(poCache, poWK->nDstXOff, nDstXSize, nDstY,
+                               std::move(poRow));
+    }
+}
+
 struct GWKThreadData
 {
     std::unique_ptr<CPLJobQueue> poJobQueue{};
@@ -292,8 +472,9 @@ static int GWKProgressMonoThread(GWKJobStruct *psJob)
 /*                       GWKGenericMonoThread()                         */
 /************************************************************************/
 
-static CPLErr GWKGenericMonoThread(GDALWarpKernel *poWK,
-                                   void (*pfnFunc)(void *pUserData))
+static CPLErr
+GWKGenericMonoThread(GDALWarpKernel *poWK, void (*pfnFunc)(void *pUserData),
+                     std::shared_ptr<GWKTransformCache> poTransformCache)
 {
     GWKThreadData td;
 
@@ -304,7 +485,13 @@ static CPLErr GWKGenericMonoThread(GDALWarpKernel *poWK,
     job.iYMax = poWK->nDstYSize;
     job.pfnProgress = GWKProgressMonoThread;
     job.pTransformerArg = poWK->pTransformerArg;
+    job.poTransformCache = std::move(poTransformCache);
+    const auto tStart = std::chrono::steady_clock::now();
     pfnFunc(&job);
+    poWK->dfRunTime += std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - tStart)
+                           .count();
+    poWK->dfTransformTime += job.dfTransformTime;
 
     return td.stopFlag ? CE_Failure : CE_None;
 }
@@ -433,7 +620,11 @@ static void ThreadFuncAdapter(void *pData)
     }
 
     psJob->pTransformerArg = pTransformerArg;
+    const auto tStart = std::chrono::steady_clock::now();
     psJob->pfnFunc(pData);
+    psJob->dfRunTime = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - tStart)
+                           .count();
 
     // Give back original transformer, if borrowed.
     {
@@ -471,11 +662,13 @@ static CPLErr GWKRun(GDALWarpKernel *poWK, const char *pszFuncName,
         return CE_Failure;
     }
 
+    auto poTransformCache = GWKGetTransformCache(poWK);
+
     GWKThreadData *psThreadData =
         static_cast<GWKThreadData *>(poWK->psThreadData);
     if (psThreadData == nullptr || psThreadData->poJobQueue == nullptr)
     {
-        return GWKGenericMonoThread(poWK, pfnFunc);
+        return GWKGenericMonoThread(poWK, pfnFunc, std::move(poTransformCache));
     }
 
     int nThreads = std::min(psThreadData->nMaxThreads, nDstYSize / 2);
@@ -509,6 +702,9 @@ static CPLErr GWKRun(GDALWarpKernel *poWK, const char *pszFuncName,
         if (poWK->pfnProgress != GDALDummyProgress)
             job.pfnProgress = GWKProgressThread;
         job.pfnFunc = pfnFunc;
+        job.poTransformCache = poTransformCache;
+        job.dfRunTime = 0;
+        job.dfTransformTime = 0;
     }
 
     {
@@ -556,6 +752,12 @@ static CPLErr GWKRun(GDALWarpKernel *poWK, const char *pszFuncName,
     /* -------------------------------------------------------------------- */
     psThreadData->poJobQueue->WaitCompletion();
 
+    for (int i = 0; i < nThreads; ++i)
+    {
+        poWK->dfRunTime += jobs[i].dfRunTime;
+        poWK->dfTransformTime += jobs[i].dfTransformTime;
+    }
+
     return psThreadData->stopFlag ? CE_Failure : CE_None;
 }
 
@@ -1206,18 +1408,43 @@ CPLErr GDALWarpKernel::PerformWarp()
     if (CPLFetchBool(papszWarpOptions, "USE_GENERAL_CASE", false))
         return GWKGeneralCase(this);
 
+    // USE_GPU is an alias of USE_OPENCL, OpenCL being the GPU backend of
+    // the warper.
+    const char *pszUseOpenCL =
+        CSLFetchNameValue(papszWarpOptions, "USE_OPENCL");
+    if (pszUseOpenCL == nullptr)
+        pszUseOpenCL = CSLFetchNameValue(papszWarpOptions, "USE_GPU");
+    if (pszUseOpenCL == nullptr)
+        pszUseOpenCL = CPLGetConfigOption("GDAL_USE_OPENCL", "NO");
+    // OpenCL warping gives different results than the ones expected by
+    // autotest, so disable it by default even if found.
+    const bool bUseOpenCL = CPLTestBool(pszUseOpenCL);
 #if defined(HAVE_OPENCL)
-    if ((eWorkingDataType == GDT_Byte || eWorkingDataType == GDT_CInt16 ||
-         eWorkingDataType == GDT_UInt16 || eWorkingDataType == GDT_Int16 ||
-         eWorkingDataType == GDT_CFloat32 || eWorkingDataType == GDT_Float32) &&
-        (eResample == GRA_Bilinear || eResample == GRA_Cubic ||
-         eResample == GRA_CubicSpline || eResample == GRA_Lanczos) &&
-        !bApplyVerticalShift &&
-        // OpenCL warping gives different results than the ones expected by autotest,
-        // so disable it by default even if found.
-        CPLTestBool(
-            CSLFetchNameValueDef(papszWarpOptions, "USE_OPENCL",
-                                 CPLGetConfigOption("GDAL_USE_OPENCL", "NO"))))
+    if (!bUseOpenCL)
+    {
+        // CPU based methods.
+    }
+    else if (!(eWorkingDataType == GDT_Byte || eWorkingDataType == GDT_CInt16 ||
+               eWorkingDataType == GDT_UInt16 ||
+               eWorkingDataType == GDT_Int16 ||
+               eWorkingDataType == GDT_CFloat32 ||
+               eWorkingDataType == GDT_Float32))
+    {
+        CPLDebug("WARP", "OpenCL warper not used: unsupported data type %s",
+                 GDALGetDataTypeName(eWorkingDataType));
+    }
+    else if (!(eResample == GRA_Bilinear || eResample == GRA_Cubic ||
+               eResample == GRA_CubicSpline || eResample == GRA_Lanczos))
+    {
+        CPLDebug("WARP",
+                 "OpenCL warper not used: unsupported resampling method %d",
+                 static_cast<int>(eResample));
+    }
+    else if (bApplyVerticalShift)
+    {
+        CPLDebug("WARP", "OpenCL warper not used: vertical shift requested");
+    }
+    else
     {
         if (pafUnifiedSrcDensity != nullptr)
         {
@@ -1261,6 +1488,16 @@ CPLErr GDALWarpKernel::PerformWarp()
                 return eResult;
         }
     }
+#else
+    if (bUseOpenCL)
+    {
+        static bool bHasWarned = false;
+        if (!bHasWarned)
+        {
+            bHasWarned = true;
+            CPLDebug("WARP", "OpenCL warper not available in this build");
+        }
+    }
 #endif  // defined HAVE_OPENCL
 
     const bool bNoMasksOrDstDensityOnly =
@@ -3499,11 +3736,20 @@ struct _GWKResampleWrkStruct
     double *padfWeightsX;
     bool *pabCalcX;
 
-    double *padfWeightsY;  // Only used by GWKResampleOptimizedLanczos.
-    int iLastSrcX;         // Only used by GWKResampleOptimizedLanczos.
-    int iLastSrcY;         // Only used by GWKResampleOptimizedLanczos.
-    double dfLastDeltaX;   // Only used by GWKResampleOptimizedLanczos.
-    double dfLastDeltaY;   // Only used by GWKResampleOptimizedLanczos.
+    double *padfWeightsY;
+    int iLastSrcX;        // Only used by GWKResampleOptimizedLanczos.
+    int iLastSrcY;        // Used by GWKResample if padfColWeightsX != nullptr
+    double dfLastDeltaX;  // Only used by GWKResampleOptimizedLanczos.
+    double dfLastDeltaY;  // Used by GWKResample if padfColWeightsX != nullptr
+
+    // When the source X coordinate only depends on the target column
+    // (affine transformation without rotation), X weights are computed once
+    // per target column, and Y weights once per target line.
+    // padfColWeightsX has (nXRadius + 1) * 2 weights per target column,
+    // computed for the source X coordinate saved in padfColSrcX.
+    double *padfColWeightsX;
+    double *padfColSrcX;
+    int iDstX;  // Target column being processed, set by the caller.
 
     // Space for saving a row of pixels.
     double *padfRowDensity;
@@ -3533,6 +3779,48 @@ static GWKResampleWrkStruct *GWKResampleCreateWrkStruct(GDALWarpKernel *poWK)
     GWKResampleWrkStruct *psWrkStruct = static_cast<GWKResampleWrkStruct *>(
         CPLMalloc(sizeof(GWKResampleWrkStruct)));
 
+    // With an affine transformation without rotation, the source X
+    // coordinate of a target column is the same for all target lines, so
+    // its weights can be computed once. Lanczos X weights do not depend on
+    // the source coordinate when the scale is below 1.
+    // Cap the cache to 8 MB per thread for large downsampling factors.
+    constexpr size_t MAX_COL_WEIGHTS_CACHE_SIZE = 8 * 1024 * 1024;
+    const bool bCacheColWeights =
+        (poWK->eResample != GRA_Lanczos || poWK->dfXScale >= 1.0) &&
+        static_cast<size_t>(poWK->nDstXSize) * nXDist * sizeof(double) <=
+            MAX_COL_WEIGHTS_CACHE_SIZE &&
+        GDALTransformIsAffineNoRotation(poWK->pfnTransformer,
+                                        poWK->pTransformerArg) &&
+        // for debug/testing purposes
+        CPLTestBool(
+            CPLGetConfigOption("GDAL_WARP_USE_AFFINE_OPTIMIZATION", "YES"));
+    psWrkStruct->padfColWeightsX = nullptr;
+    psWrkStruct->padfColSrcX = nullptr;
+    psWrkStruct->iDstX = -1;
+    if (bCacheColWeights)
+    {
+        psWrkStruct->padfColWeightsX = static_cast<double *>(
+            VSI_MALLOC3_VERBOSE(poWK->nDstXSize, nXDist, sizeof(double)));
+        psWrkStruct->padfColSrcX = static_cast<double *>(
+            VSI_MALLOC2_VERBOSE(poWK->nDstXSize, sizeof(double)));
+        if (psWrkStruct->padfColWeightsX == nullptr ||
+            psWrkStruct->padfColSrcX == nullptr)
+        {
+            VSIFree(psWrkStruct->padfColWeightsX);
+            VSIFree(psWrkStruct->padfColSrcX);
+            psWrkStruct->padfColWeightsX = nullptr;
+            psWrkStruct->padfColSrcX = nullptr;
+        }
+        else
+        {
+            // NaN never compares equal, so that weights get computed on
+            // first use.
+            for (int i = 0; i < poWK->nDstXSize; ++i)
+                psWrkStruct->padfColSrcX[i] =
+                    std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
     // Alloc space for saved X weights.
     psWrkStruct->padfWeightsX =
         static_cast<double *>(CPLCalloc(nXDist, sizeof(double)));
@@ -3619,6 +3907,8 @@ static void GWKResampleDeleteWrkStruct(GWKResampleWrkStruct *psWrkStruct)
     CPLFree(psWrkStruct->padfRowDensity);
     CPLFree(psWrkStruct->padfRowReal);
     CPLFree(psWrkStruct->padfRowImag);
+    VSIFree(psWrkStruct->padfColWeightsX);
+    VSIFree(psWrkStruct->padfColSrcX);
     CPLFree(psWrkStruct);
 }
 
@@ -3660,13 +3950,53 @@ static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
     double *padfRowReal = psWrkStruct->padfRowReal;
     double *padfRowImag = psWrkStruct->padfRowImag;
 
-    // Mark as needing calculation (don't calculate the weights yet,
-    // because a mask may render it unnecessary).
-    memset(pabCalcX, false, nXDist * sizeof(bool));
-
     FilterFuncType pfnGetWeight = apfGWKFilter[poWK->eResample];
     CPLAssert(pfnGetWeight);
 
+    const int bXScaleBelow1 = (dfXScale < 1.0);
+    const int bYScaleBelow1 = (dfYScale < 1.0);
+
+    // Weights cached for the target column and line, if any.
+    const double *padfColWeightsX = nullptr;
+    const double *padfWeightsY = nullptr;
+    if (psWrkStruct->padfColWeightsX != nullptr)
+    {
+        const int iDstX = psWrkStruct->iDstX;
+        double *padfWeightsXOfCol =
+            psWrkStruct->padfColWeightsX + static_cast<size_t>(iDstX) * nXDist;
+        if (psWrkStruct->padfColSrcX[iDstX] != dfSrcX)
+        {
+            for (int i = poWK->nFiltInitX; i <= poWK->nXRadius; ++i)
+            {
+                padfWeightsXOfCol[i - poWK->nFiltInitX] =
+                    (bXScaleBelow1) ? pfnGetWeight((i - dfDeltaX) * dfXScale)
+                                    : pfnGetWeight(i - dfDeltaX);
+            }
+            psWrkStruct->padfColSrcX[iDstX] = dfSrcX;
+        }
+        padfColWeightsX = padfWeightsXOfCol;
+
+        if (iSrcY != psWrkStruct->iLastSrcY ||
+            dfDeltaY != psWrkStruct->dfLastDeltaY)
+        {
+            for (int j = poWK->nFiltInitY; j <= poWK->nYRadius; ++j)
+            {
+                psWrkStruct->padfWeightsY[j - poWK->nFiltInitY] =
+                    (bYScaleBelow1) ? pfnGetWeight((j - dfDeltaY) * dfYScale)
+                                    : pfnGetWeight(j - dfDeltaY);
+            }
+            psWrkStruct->iLastSrcY = iSrcY;
+            psWrkStruct->dfLastDeltaY = dfDeltaY;
+        }
+        padfWeightsY = psWrkStruct->padfWeightsY;
+    }
+    else
+    {
+        // Mark as needing calculation (don't calculate the weights yet,
+        // because a mask may render it unnecessary).
+        memset(pabCalcX, false, nXDist * sizeof(bool));
+    }
+
     // Skip sampling over edge of image.
     int j = poWK->nFiltInitY;
     int jMax = poWK->nYRadius;
@@ -3682,9 +4012,6 @@ static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
     if (iSrcX + iMax >= nSrcXSize)
         iMax = nSrcXSize - iSrcX - 1;
 
-    const int bXScaleBelow1 = (dfXScale < 1.0);
-    const int bYScaleBelow1 = (dfYScale < 1.0);
-
     GPtrDiff_t iRowOffset =
         iSrcOffset + static_cast<GPtrDiff_t>(j - 1) * nSrcXSize + iMin;
 
@@ -3703,9 +4030,10 @@ static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
             continue;
 
         // Calculate the Y weight.
-        double dfWeight1 = (bYScaleBelow1)
-                               ? pfnGetWeight((j - dfDeltaY) * dfYScale)
-                               : pfnGetWeight(j - dfDeltaY);
+        const double dfWeight1 =
+            (padfWeightsY != nullptr) ? padfWeightsY[j - poWK->nFiltInitY]
+            : (bYScaleBelow1)         ? pfnGetWeight((j - dfDeltaY) * dfYScale)
+                                      : pfnGetWeight(j - dfDeltaY);
 
         // Iterate over pixels in row.
         double dfAccumulatorRealLocal = 0.0;
@@ -3723,7 +4051,11 @@ static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
             double dfWeight2 = 0.0;
 
             // Make or use a cached set of weights for this row.
-            if (pabCalcX[i - iMin])
+            if (padfColWeightsX != nullptr)
+            {
+                dfWeight2 = padfColWeightsX[i - poWK->nFiltInitX];
+            }
+            else if (pabCalcX[i - iMin])
             {
                 // Use saved weight value instead of recomputing it.
                 dfWeight2 = padfWeightsX[i - iMin];
@@ -3783,6 +4115,66 @@ static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
     return true;
 }
 
+/************************************************************************/
+/*                     GWKComputeLanczos3Weights()                      */
+/************************************************************************/
+
+// Computes GWKLanczosSinc(i - dfDelta) for i in [iMin, iMax] into
+// padfWeights[i - iFiltInit].
+static void GWKComputeLanczos3Weights(double dfDelta, int iMin, int iMax,
+                                      int iFiltInit, double *padfWeights)
+{
+    // Optimisation of GWKLanczosSinc(i - dfDelta) based on the
+    // following trigonometric formulas.
+
+    // TODO(schwehr): Move this somewhere where it can be rendered at LaTeX.
+    // sin(M_PI * (dfBase + k)) = sin(M_PI * dfBase) * cos(M_PI * k) +
+    // cos(M_PI * dfBase) * sin(M_PI * k)
+    // sin(M_PI * (dfBase + k)) = dfSinPIBase * cos(M_PI * k) + dfCosPIBase *
+    // sin(M_PI * k)
+    // sin(M_PI * (dfBase + k)) = dfSinPIBase * cos(M_PI * k)
+    // sin(M_PI * (dfBase + k)) = dfSinPIBase * (((k % 2) == 0) ? 1 : -1)
+
+    // sin(M_PI / dfR * (dfBase + k)) = sin(M_PI / dfR * dfBase) *
+    // cos(M_PI / dfR * k) + cos(M_PI / dfR * dfBase) * sin(M_PI / dfR * k)
+    // sin(M_PI / dfR * (dfBase + k)) = dfSinPIBaseOverR * cos(M_PI / dfR * k)
+    // + dfCosPIBaseOverR * sin(M_PI / dfR * k)
+
+    const double dfSinPIDeltaOver3 = sin((-M_PI / 3.0) * dfDelta);
+    const double dfSin2PIDeltaOver3 = dfSinPIDeltaOver3 * dfSinPIDeltaOver3;
+    // Ok to use sqrt(1-sin^2) since M_PI / 3 * dfDelta < PI/2.
+    const double dfCosPIDeltaOver3 = sqrt(1.0 - dfSin2PIDeltaOver3);
+    const double dfSinPIDelta =
+        (3.0 - 4 * dfSin2PIDeltaOver3) * dfSinPIDeltaOver3;
+    const double dfInvPI2Over3 = 3.0 / (M_PI * M_PI);
+    const double dfInvPI2Over3xSinPIDelta = dfInvPI2Over3 * dfSinPIDelta;
+    const double dfInvPI2Over3xSinPIDeltaxm0d5SinPIDeltaOver3 =
+        -0.5 * dfInvPI2Over3xSinPIDelta * dfSinPIDeltaOver3;
+    const double dfSinPIOver3 = 0.8660254037844386;
+    const double dfInvPI2Over3xSinPIDeltaxSinPIOver3xCosPIDeltaOver3 =
+        dfSinPIOver3 * dfInvPI2Over3xSinPIDelta * dfCosPIDeltaOver3;
+    const double padfCst[] = {
+        dfInvPI2Over3xSinPIDelta * dfSinPIDeltaOver3,
+        dfInvPI2Over3xSinPIDeltaxm0d5SinPIDeltaOver3 -
+            dfInvPI2Over3xSinPIDeltaxSinPIOver3xCosPIDeltaOver3,
+        dfInvPI2Over3xSinPIDeltaxm0d5SinPIDeltaOver3 +
+            dfInvPI2Over3xSinPIDeltaxSinPIOver3xCosPIDeltaOver3};
+
+    for (int i = iMin; i <= iMax; ++i)
+    {
+        const double dfVal = i - dfDelta;
+        if (dfVal == 0.0)
+            padfWeights[i - iFiltInit] = 1.0;
+        else
+            padfWeights[i - iFiltInit] = padfCst[(i + 3) % 3] / (dfVal * dfVal);
+#if DEBUG_VERBOSE
+            // TODO(schwehr): AlmostEqual.
+            // CPLAssert(fabs(padfWeights[i-iFiltInit] -
+            //               GWKLanczosSinc(dfVal, 3.0)) < 1e-10);
+#endif
+    }
+}
+
 /************************************************************************/
 /*                      GWKResampleOptimizedLanczos()                   */
 /************************************************************************/
@@ -3851,62 +4243,32 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
         while (iMax - dfDeltaX > 3.0)
             iMax--;
 
-        if (iSrcX != psWrkStruct->iLastSrcX ||
-            dfDeltaX != psWrkStruct->dfLastDeltaX)
+        if (psWrkStruct->padfColWeightsX != nullptr)
         {
-            // Optimisation of GWKLanczosSinc(i - dfDeltaX) based on the
-            // following trigonometric formulas.
-
-            // TODO(schwehr): Move this somewhere where it can be rendered at
-            // LaTeX. sin(M_PI * (dfBase + k)) = sin(M_PI * dfBase) * cos(M_PI *
-            // k) + cos(M_PI * dfBase) * sin(M_PI * k) sin(M_PI * (dfBase + k))
-            // = dfSinPIBase * cos(M_PI * k) + dfCosPIBase * sin(M_PI * k)
-            // sin(M_PI * (dfBase + k)) = dfSinPIBase * cos(M_PI * k)
-            // sin(M_PI * (dfBase + k)) = dfSinPIBase * (((k % 2) == 0) ? 1 :
-            // -1)
-
-            // sin(M_PI / dfR * (dfBase + k)) = sin(M_PI / dfR * dfBase) *
-            // cos(M_PI / dfR * k) + cos(M_PI / dfR * dfBase) * sin(M_PI / dfR *
-            // k) sin(M_PI / dfR * (dfBase + k)) = dfSinPIBaseOverR * cos(M_PI /
-            // dfR * k) + dfCosPIBaseOverR * sin(M_PI / dfR * k)
-
-            const double dfSinPIDeltaXOver3 = sin((-M_PI / 3.0) * dfDeltaX);
-            const double dfSin2PIDeltaXOver3 =
-                dfSinPIDeltaXOver3 * dfSinPIDeltaXOver3;
-            // Ok to use sqrt(1-sin^2) since M_PI / 3 * dfDeltaX < PI/2.
-            const double dfCosPIDeltaXOver3 = sqrt(1.0 - dfSin2PIDeltaXOver3);
-            const double dfSinPIDeltaX =
-                (3.0 - 4 * dfSin2PIDeltaXOver3) * dfSinPIDeltaXOver3;
-            const double dfInvPI2Over3 = 3.0 / (M_PI * M_PI);
-            const double dfInvPI2Over3xSinPIDeltaX =
-                dfInvPI2Over3 * dfSinPIDeltaX;
-            const double dfInvPI2Over3xSinPIDeltaXxm0d5SinPIDeltaXOver3 =
-                -0.5 * dfInvPI2Over3xSinPIDeltaX * dfSinPIDeltaXOver3;
-            const double dfSinPIOver3 = 0.8660254037844386;
-            const double dfInvPI2Over3xSinPIDeltaXxSinPIOver3xCosPIDeltaXOver3 =
-                dfSinPIOver3 * dfInvPI2Over3xSinPIDeltaX * dfCosPIDeltaXOver3;
-            const double padfCst[] = {
-                dfInvPI2Over3xSinPIDeltaX * dfSinPIDeltaXOver3,
-                dfInvPI2Over3xSinPIDeltaXxm0d5SinPIDeltaXOver3 -
-                    dfInvPI2Over3xSinPIDeltaXxSinPIOver3xCosPIDeltaXOver3,
-                dfInvPI2Over3xSinPIDeltaXxm0d5SinPIDeltaXOver3 +
-                    dfInvPI2Over3xSinPIDeltaXxSinPIOver3xCosPIDeltaXOver3};
-
-            for (int i = iMin; i <= iMax; ++i)
+            // Weights cached for the target column, computed over the whole
+            // kernel so that they can be used whatever the source edges.
+            const int iDstX = psWrkStruct->iDstX;
+            padfWeightsX =
+                psWrkStruct->padfColWeightsX +
+                static_cast<size_t>(iDstX) * (poWK->nXRadius + 1) * 2;
+            if (psWrkStruct->padfColSrcX[iDstX] != dfSrcX)
             {
-                const double dfX = i - dfDeltaX;
-                if (dfX == 0.0)
-                    padfWeightsX[i - poWK->nFiltInitX] = 1.0;
-                else
-                    padfWeightsX[i - poWK->nFiltInitX] =
-                        padfCst[(i + 3) % 3] / (dfX * dfX);
-#if DEBUG_VERBOSE
-                    // TODO(schwehr): AlmostEqual.
-                    // CPLAssert(fabs(padfWeightsX[i-poWK->nFiltInitX] -
-                    //               GWKLanczosSinc(dfX, 3.0)) < 1e-10);
-#endif
+                int iMinCol = poWK->nFiltInitX;
+                int iMaxCol = poWK->nXRadius;
+                while (iMinCol - dfDeltaX < -3.0)
+                    iMinCol++;
+                while (iMaxCol - dfDeltaX > 3.0)
+                    iMaxCol--;
+                GWKComputeLanczos3Weights(dfDeltaX, iMinCol, iMaxCol,
+                                          poWK->nFiltInitX, padfWeightsX);
+                psWrkStruct->padfColSrcX[iDstX] = dfSrcX;
             }
-
+        }
+        else if (iSrcX != psWrkStruct->iLastSrcX ||
+                 dfDeltaX != psWrkStruct->dfLastDeltaX)
+        {
+            GWKComputeLanczos3Weights(dfDeltaX, iMin, iMax, poWK->nFiltInitX,
+                                      padfWeightsX);
             psWrkStruct->iLastSrcX = iSrcX;
             psWrkStruct->dfLastDeltaX = dfDeltaX;
         }
@@ -3930,43 +4292,8 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
         if (iSrcY != psWrkStruct->iLastSrcY ||
             dfDeltaY != psWrkStruct->dfLastDeltaY)
         {
-            const double dfSinPIDeltaYOver3 = sin((-M_PI / 3.0) * dfDeltaY);
-            const double dfSin2PIDeltaYOver3 =
-                dfSinPIDeltaYOver3 * dfSinPIDeltaYOver3;
-            // Ok to use sqrt(1-sin^2) since M_PI / 3 * dfDeltaY < PI/2.
-            const double dfCosPIDeltaYOver3 = sqrt(1.0 - dfSin2PIDeltaYOver3);
-            const double dfSinPIDeltaY =
-                (3.0 - 4.0 * dfSin2PIDeltaYOver3) * dfSinPIDeltaYOver3;
-            const double dfInvPI2Over3 = 3.0 / (M_PI * M_PI);
-            const double dfInvPI2Over3xSinPIDeltaY =
-                dfInvPI2Over3 * dfSinPIDeltaY;
-            const double dfInvPI2Over3xSinPIDeltaYxm0d5SinPIDeltaYOver3 =
-                -0.5 * dfInvPI2Over3xSinPIDeltaY * dfSinPIDeltaYOver3;
-            const double dfSinPIOver3 = 0.8660254037844386;
-            const double dfInvPI2Over3xSinPIDeltaYxSinPIOver3xCosPIDeltaYOver3 =
-                dfSinPIOver3 * dfInvPI2Over3xSinPIDeltaY * dfCosPIDeltaYOver3;
-            const double padfCst[] = {
-                dfInvPI2Over3xSinPIDeltaY * dfSinPIDeltaYOver3,
-                dfInvPI2Over3xSinPIDeltaYxm0d5SinPIDeltaYOver3 -
-                    dfInvPI2Over3xSinPIDeltaYxSinPIOver3xCosPIDeltaYOver3,
-                dfInvPI2Over3xSinPIDeltaYxm0d5SinPIDeltaYOver3 +
-                    dfInvPI2Over3xSinPIDeltaYxSinPIOver3xCosPIDeltaYOver3};
-
-            for (int j = jMin; j <= jMax; ++j)
-            {
-                const double dfY = j - dfDeltaY;
-                if (dfY == 0.0)
-                    padfWeightsY[j - poWK->nFiltInitY] = 1.0;
-                else
-                    padfWeightsY[j - poWK->nFiltInitY] =
-                        padfCst[(j + 3) % 3] / (dfY * dfY);
-#if DEBUG_VERBOSE
-                    // TODO(schwehr): AlmostEqual.
-                    // CPLAssert(fabs(padfWeightsY[j-poWK->nFiltInitY] -
-                    //               GWKLanczosSinc(dfY, 3.0)) < 1e-10);
-#endif
-            }
-
+            GWKComputeLanczos3Weights(dfDeltaY, jMin, jMax, poWK->nFiltInitY,
+                                      padfWeightsY);
             psWrkStruct->iLastSrcY = iSrcY;
             psWrkStruct->dfLastDeltaY = dfDeltaY;
         }
@@ -5145,8 +5472,7 @@ static void GWKGeneralCaseThread(void *pData)
         /*      to source pixel/line coordinates. */
         /* --------------------------------------------------------------------
          */
-        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX,
-                             padfY, padfZ, pabSuccess);
+        GWKTransformDstRow(psJob, iDstY, padfX, padfY, padfZ, pabSuccess);
         if (dfSrcCoordPrecision > 0.0)
         {
             GWKRoundSourceCoordinates(
@@ -5239,6 +5565,7 @@ static void GWKGeneralCaseThread(void *pData)
                     if (psWrkStruct != nullptr)
 #endif
                     {
+                        psWrkStruct->iDstX = iDstX;
                         psWrkStruct->pfnGWKResample(
                             poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
                             padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
@@ -5395,8 +5722,7 @@ static void GWKRealCaseThread(void *pData)
         /*      to source pixel/line coordinates. */
         /* --------------------------------------------------------------------
          */
-        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX,
-                             padfY, padfZ, pabSuccess);
+        GWKTransformDstRow(psJob, iDstY, padfX, padfY, padfZ, pabSuccess);
         if (dfSrcCoordPrecision > 0.0)
         {
             GWKRoundSourceCoordinates(
@@ -5518,6 +5844,7 @@ static void GWKRealCaseThread(void *pData)
 #endif
                     {
                         double dfValueImagIgnored = 0.0;
+                        psWrkStruct->iDstX = iDstX;
                         psWrkStruct->pfnGWKResample(
                             poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
                             padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
@@ -5664,8 +5991,7 @@ static void GWKResampleNoMasksOrDstDensityOnlyThreadInternal(void *pData)
         /*      to source pixel/line coordinates. */
         /* --------------------------------------------------------------------
          */
-        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX,
-                             padfY, padfZ, pabSuccess);
+        GWKTransformDstRow(psJob, iDstY, padfX, padfY, padfZ, pabSuccess);
         if (dfSrcCoordPrecision > 0.0)
         {
             GWKRoundSourceCoordinates(
@@ -5901,8 +6227,7 @@ template <class T> static void GWKNearestThread(void *pData)
         /*      to source pixel/line coordinates. */
         /* --------------------------------------------------------------------
          */
-        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX,
-                             padfY, padfZ, pabSuccess);
+        GWKTransformDstRow(psJob, iDstY, padfX, padfY, padfZ, pabSuccess);
         if (dfSrcCoordPrecision > 0.0)
         {
             GWKRoundSourceCoordinates(
@@ -6132,6 +6457,12 @@ static CPLErr GWKNearestFloat(GDALWarpKernel *poWK)
 
 static void GWKAverageOrModeThread(void *pData);
 
+static void GWKAverageNoMasks(const GDALWarpKernel *poWK, int iBand,
+                              int iSrcXMin, int iSrcXMax, int iSrcYMin,
+                              int iSrcYMax, double dfXMin, double dfXMax,
+                              double dfYMin, double dfYMax,
+                              double &dfValueReal, double &dfTotalWeight);
+
 static CPLErr GWKAverageOrMode(GDALWarpKernel *poWK)
 {
     return GWKRun(poWK, "GWKAverageOrMode", GWKAverageOrModeThread);
@@ -6281,6 +6612,21 @@ static void GWKAverageOrModeThread(void *pData)
     CPLDebug("GDAL", "GDALWarpKernel():GWKAverageOrModeThread() using algo %d",
              nAlgo);
 
+    // When there is no mask nor density, the average can read the source
+    // buffer directly with its native type instead of going through
+    // GWKGetPixelValue() for each pixel.
+    const bool bAverageNoMasks =
+        nAlgo == GWKAOM_Average && !bIsComplex &&
+        poWK->panUnifiedSrcValid == nullptr &&
+        poWK->papanBandSrcValid == nullptr &&
+        poWK->pafUnifiedSrcDensity == nullptr;
+
+    // For Byte data, quantiles are computed from a histogram rather than
+    // by sorting the values of each target pixel.
+    std::vector<int> anQuantHistogram;
+    if (nAlgo == GWKAOM_Quant && poWK->eWorkingDataType == GDT_Byte)
+        anQuantHistogram.resize(256);
+
     /* -------------------------------------------------------------------- */
     /*      Allocate x,y,z coordinate arrays for transformation ... two     */
     /*      scanlines worth of positions.                                   */
@@ -6486,48 +6832,61 @@ static void GWKAverageOrModeThread(void *pData)
                 {
                     double dfTotalWeight = 0.0;
 
-                    // This code adapted from GDALDownsampleChunk32R_AverageT()
-                    // in gcore/overview.cpp.
-                    for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++)
+                    if (bAverageNoMasks && !bWrapOverX)
                     {
-                        const double dfWeightY = COMPUTE_WEIGHT_Y(iSrcY);
-                        iSrcOffset = iSrcXMin +
-                                     static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
-                        for (int iSrcX = iSrcXMin; iSrcX < iSrcXMax;
-                             iSrcX++, iSrcOffset++)
+                        GWKAverageNoMasks(poWK, iBand, iSrcXMin, iSrcXMax,
+                                          iSrcYMin, iSrcYMax, dfXMin, dfXMax,
+                                          dfYMin, dfYMax, dfValueReal,
+                                          dfTotalWeight);
+                    }
+                    else
+                    {
+                        // This code adapted from
+                        // GDALDownsampleChunk32R_AverageT() in
+                        // gcore/overview.cpp.
+                        for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++)
                         {
-                            if (bWrapOverX)
-                                iSrcOffset =
-                                    (iSrcX % nSrcXSize) +
-                                    static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
-
-                            if (poWK->panUnifiedSrcValid != nullptr &&
-                                !CPLMaskGet(poWK->panUnifiedSrcValid,
-                                            iSrcOffset))
+                            const double dfWeightY = COMPUTE_WEIGHT_Y(iSrcY);
+                            iSrcOffset =
+                                iSrcXMin +
+                                static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+                            for (int iSrcX = iSrcXMin; iSrcX < iSrcXMax;
+                                 iSrcX++, iSrcOffset++)
                             {
-                                continue;
-                            }
+                                if (bWrapOverX)
+                                    iSrcOffset =
+                                        (iSrcX % nSrcXSize) +
+                                        static_cast<GPtrDiff_t>(iSrcY) *
+                                            nSrcXSize;
 
-                            if (GWKGetPixelValue(
-                                    poWK, iBand, iSrcOffset, &dfBandDensity,
-                                    &dfValueRealTmp, &dfValueImagTmp) &&
-                                dfBandDensity > BAND_DENSITY_THRESHOLD)
-                            {
-                                const double dfWeight =
-                                    COMPUTE_WEIGHT(iSrcX, dfWeightY);
-                                if (dfWeight > 0)
+                                if (poWK->panUnifiedSrcValid != nullptr &&
+                                    !CPLMaskGet(poWK->panUnifiedSrcValid,
+                                                iSrcOffset))
+                                {
+                                    continue;
+                                }
+
+                                if (GWKGetPixelValue(
+                                        poWK, iBand, iSrcOffset, &dfBandDensity,
+                                        &dfValueRealTmp, &dfValueImagTmp) &&
+                                    dfBandDensity > BAND_DENSITY_THRESHOLD)
                                 {
-                                    // Weighted incremental algorithm mean
-                                    // Cf https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Weighted_incremental_algorithm
-                                    dfTotalWeight += dfWeight;
-                                    dfValueReal +=
-                                        (dfWeight / dfTotalWeight) *
-                                        (dfValueRealTmp - dfValueReal);
-                                    if (bIsComplex)
+                                    const double dfWeight =
+                                        COMPUTE_WEIGHT(iSrcX, dfWeightY);
+                                    if (dfWeight > 0)
                                     {
-                                        dfValueImag +=
+                                        // Weighted incremental algorithm mean
+                                        // Cf https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Weighted_incremental_algorithm
+                                        dfTotalWeight += dfWeight;
+                                        dfValueReal +=
                                             (dfWeight / dfTotalWeight) *
-                                            (dfValueImagTmp - dfValueImag);
+                                            (dfValueRealTmp - dfValueReal);
+                                        if (bIsComplex)
+                                        {
+                                            dfValueImag +=
+                                                (dfWeight / dfTotalWeight) *
+                                                (dfValueImagTmp - dfValueImag);
+                                        }
                                     }
                                 }
                             }
@@ -6969,6 +7328,8 @@ static void GWKAverageOrModeThread(void *pData)
                 {
                     bool bFoundValid = false;
                     std::vector<double> dfRealValuesTmp;
+                    const bool bUseHistogram = !anQuantHistogram.empty();
+                    int nValidCount = 0;
 
                     // This code adapted from nAlgo 1 method, GRA_Average.
                     for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++)
@@ -6997,18 +7358,48 @@ static void GWKAverageOrModeThread(void *pData)
                                 dfBandDensity > BAND_DENSITY_THRESHOLD)
                             {
                                 bFoundValid = true;
-                                dfRealValuesTmp.push_back(dfValueRealTmp);
+                                if (bUseHistogram)
+                                {
+                                    ++anQuantHistogram[static_cast<int>(
+                                        dfValueRealTmp)];
+                                    ++nValidCount;
+                                }
+                                else
+                                {
+                                    dfRealValuesTmp.push_back(dfValueRealTmp);
+                                }
                             }
                         }
                     }
 
                     if (bFoundValid)
                     {
-                        std::sort(dfRealValuesTmp.begin(),
-                                  dfRealValuesTmp.end());
-                        int quantIdx = static_cast<int>(
-                            std::ceil(quant * dfRealValuesTmp.size() - 1));
-                        dfValueReal = dfRealValuesTmp[quantIdx];
+                        if (bUseHistogram)
+                        {
+                            // Same selection as the sorting code below: the
+                            // value of rank quantIdx in ascending order.
+                            const int quantIdx = static_cast<int>(
+                                std::ceil(quant * nValidCount - 1));
+                            int nCumCount = 0;
+                            int iVal = 0;
+                            for (; iVal < 255; ++iVal)
+                            {
+                                nCumCount += anQuantHistogram[iVal];
+                                if (nCumCount > quantIdx)
+                                    break;
+                            }
+                            dfValueReal = iVal;
+                            std::fill(anQuantHistogram.begin(),
+                                      anQuantHistogram.end(), 0);
+                        }
+                        else
+                        {
+                            std::sort(dfRealValuesTmp.begin(),
+                                      dfRealValuesTmp.end());
+                            int quantIdx = static_cast<int>(
+                                std::ceil(quant * dfRealValuesTmp.size() - 1));
+                            dfValueReal = dfRealValuesTmp[quantIdx];
+                        }
 
                         if (poWK->bApplyVerticalShift)
                         {
@@ -7095,6 +7486,97 @@ static void GWKAverageOrModeThread(void *pData)
     }
 }
 
+/************************************************************************/
+/*                         GWKAverageNoMasks()                          */
+/************************************************************************/
+
+// Weighted average of the source window of a target pixel, for real data
+// types without validity mask nor density. Must give the same result as the
+// generic code path of GWKAverageOrModeThread().
+template <class T>
+static void GWKAverageNoMasksT(const T *pSrc, int nSrcXSize, int iSrcXMin,
+                               int iSrcXMax, int iSrcYMin, int iSrcYMax,
+                               double dfXMin, double dfXMax, double dfYMin,
+                               double dfYMax, double &dfValueReal,
+                               double &dfTotalWeight)
+{
+    for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++)
+    {
+        const double dfWeightY = COMPUTE_WEIGHT_Y(iSrcY);
+        const T *pSrcLine = pSrc + static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+        for (int iSrcX = iSrcXMin; iSrcX < iSrcXMax; iSrcX++)
+        {
+            const double dfWeight = COMPUTE_WEIGHT(iSrcX, dfWeightY);
+            if (dfWeight > 0)
+            {
+                dfTotalWeight += dfWeight;
+                dfValueReal += (dfWeight / dfTotalWeight) *
+                               (static_cast<double>(pSrcLine[iSrcX]) -
+                                dfValueReal);
+            }
+        }
+    }
+}
+
+static void GWKAverageNoMasks(const GDALWarpKernel *poWK, int iBand,
+                              int iSrcXMin, int iSrcXMax, int iSrcYMin,
+                              int iSrcYMax, double dfXMin, double dfXMax,
+                              double dfYMin, double dfYMax,
+                              double &dfValueReal, double &dfTotalWeight)
+{
+    const GByte *pabySrc = poWK->papabySrcImage[iBand];
+    const int nSrcXSize = poWK->nSrcXSize;
+
+#define CALL_GWKAverageNoMasksT(T)                                             \
+    GWKAverageNoMasksT(reinterpret_cast<const T *>(pabySrc), nSrcXSize,        \
+                       iSrcXMin, iSrcXMax, iSrcYMin, iSrcYMax, dfXMin, dfXMax, \
+                       dfYMin, dfYMax, dfValueReal, dfTotalWeight)
+
+    switch (poWK->eWorkingDataType)
+    {
+        case GDT_Byte:
+            CALL_GWKAverageNoMasksT(GByte);
+            break;
+        case GDT_Int8:
+            CALL_GWKAverageNoMasksT(GInt8);
+            break;
+        case GDT_Int16:
+            CALL_GWKAverageNoMasksT(GInt16);
+            break;
+        case GDT_UInt16:
+            CALL_GWKAverageNoMasksT(GUInt16);
+            break;
+        case GDT_Int32:
+            CALL_GWKAverageNoMasksT(GInt32);
+            break;
+        case GDT_UInt32:
+            CALL_GWKAverageNoMasksT(GUInt32);
+            break;
+        case GDT_Int64:
+            CALL_GWKAverageNoMasksT(std::int64_t);
+            break;
+        case GDT_UInt64:
+            CALL_GWKAverageNoMasksT(std::uint64_t);
+            break;
+        case GDT_Float32:
+            CALL_GWKAverageNoMasksT(float);
+            break;
+        case GDT_Float64:
+            CALL_GWKAverageNoMasksT(double);
+            break;
+        case GDT_CInt16:
+        case GDT_CInt32:
+        case GDT_CFloat32:
+        case GDT_CFloat64:
+        case GDT_Unknown:
+        case GDT_TypeCount:
+            CPLAssert(false);
+            break;
+    }
+
+#undef CALL_GWKAverageNoMasksT
+}
+
 /************************************************************************/
 /*                         getOrientation()                             */
 /************************************************************************/
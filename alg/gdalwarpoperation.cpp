@@ -37,10 +37,14 @@
 #include <cstring>
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
+#include <tuple>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
@@ -48,10 +52,12 @@
 #include "cpl_mask.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_alg_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 
@@ -62,12 +68,66 @@ struct _GDALWarpChunk
     double sExtraSx, sExtraSy;
 };
 
+// Source window of a chunk read ahead by ChunkAndWarpMulti().
+struct GDALWarpPrefetchedChunk
+{
+    int nSrcXOff = 0;
+    int nSrcYOff = 0;
+    int nSrcXSize = 0;
+    int nSrcYSize = 0;
+    GByte *pabyData = nullptr;
+    size_t nSize = 0;
+    bool bDone = false;
+    bool bSuccess = false;
+};
+
 struct GDALWarpPrivateData
 {
     int nStepCount = 0;
     std::vector<int> abSuccess{};
     std::vector<double> adfDstX{};
     std::vector<double> adfDstY{};
+
+    // Chunks being read ahead, indexed by their destination offset.
+    std::mutex oPrefetchMutex{};
+    std::condition_variable oPrefetchCond{};
+    std::map<std::pair<int, int>, std::unique_ptr<GDALWarpPrefetchedChunk>>
+        oMapPrefetchedChunks{};
+    size_t nPrefetchedBytes = 0;
+
+    // Source window of the last chunk warped by ChunkAndWarpImage() or
+    // ChunkAndWarpMulti(), whose overlap with the source window of the next
+    // chunk is not read again.
+    std::mutex oLastSrcWindowMutex{};
+    bool bReuseSrcWindows = false;
+    int nLastSrcXOff = 0;
+    int nLastSrcYOff = 0;
+    int nLastSrcXSize = 0;
+    int nLastSrcYSize = 0;
+    GByte *pabyLastSrcData = nullptr;
+
+    // Chunks of the chunk list whose source window only contains nodata
+    // pixels, as (dstXOff, dstYOff, srcXOff, srcYOff, srcXSize, srcYSize).
+    std::mutex oEmptySrcChunksMutex{};
+    std::set<std::tuple<int, int, int, int, int, int>> oSetEmptySrcChunks{};
+
+    // Cutline prepared once for all chunks, and the cutline it comes from.
+    std::mutex oCutlineMutex{};
+    void *hPreparedCutlineSource = nullptr;
+    GDALWarpPreparedCutline *psPreparedCutline = nullptr;
+
+    // Counters returned by GetStatistics().
+    std::mutex oStatisticsMutex{};
+    GDALWarpStatistics sStatistics{};
+
+    GDALWarpPrivateData() = default;
+
+    ~GDALWarpPrivateData()
+    {
+        GDALWarpDestroyPreparedCutline(psPreparedCutline);
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALWarpPrivateData)
 };
 
 static std::mutex gMutex{};
@@ -91,6 +151,124 @@ GetWarpPrivateData(GDALWarpOperation *poWarpOperation)
     }
 }
 
+/************************************************************************/
+/*                      DiscardLastSourceWindow()                       */
+/************************************************************************/
+
+// Stop reusing source windows between chunks, at the end of
+// ChunkAndWarpImage() and ChunkAndWarpMulti(), so that changes made to the
+// source dataset afterwards are taken into account.
+static void DiscardLastSourceWindow(GDALWarpPrivateData *psPrivate)
+{
+    std::lock_guard<std::mutex> oLock(psPrivate->oLastSrcWindowMutex);
+    psPrivate->bReuseSrcWindows = false;
+    VSIFree(psPrivate->pabyLastSrcData);
+    psPrivate->pabyLastSrcData = nullptr;
+}
+
+/************************************************************************/
+/*                          GetElapsedTime()                            */
+/************************************************************************/
+
+static double GetElapsedTime(std::chrono::steady_clock::time_point tStart)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         tStart)
+        .count();
+}
+
+/************************************************************************/
+/*                           AddStatistics()                            */
+/************************************************************************/
+
+// Add the counters of a chunk, or of a read-ahead job, to the ones of the
+// warp operation.
+static void AddStatistics(GDALWarpPrivateData *psPrivate,
+                          const GDALWarpStatistics &sStats)
+{
+    std::lock_guard<std::mutex> oLock(psPrivate->oStatisticsMutex);
+    GDALWarpStatistics &sTotal = psPrivate->sStatistics;
+    sTotal.dfSrcReadTime += sStats.dfSrcReadTime;
+    sTotal.dfMaskTime += sStats.dfMaskTime;
+    sTotal.dfTransformTime += sStats.dfTransformTime;
+    sTotal.dfKernelTime += sStats.dfKernelTime;
+    sTotal.dfDstReadTime += sStats.dfDstReadTime;
+    sTotal.dfDstWriteTime += sStats.dfDstWriteTime;
+    sTotal.nSrcBytesRead += sStats.nSrcBytesRead;
+    sTotal.nDstBytesWritten += sStats.nDstBytesWritten;
+    sTotal.nChunksProcessed += sStats.nChunksProcessed;
+}
+
+/************************************************************************/
+/*                          ReportStatistics()                          */
+/************************************************************************/
+
+// Emit the counters of the warp operation, when REPORT_TIMINGS is set.
+static void ReportStatistics(GDALWarpPrivateData *psPrivate)
+{
+    std::lock_guard<std::mutex> oLock(psPrivate->oStatisticsMutex);
+    const GDALWarpStatistics &sStats = psPrivate->sStatistics;
+    CPLDebug("WARP_TIMING",
+             "%d chunks: source read %.3f s (" CPL_FRMT_GIB " bytes), "
+             "masks %.3f s, transformation %.3f s, kernel %.3f s, "
+             "destination read %.3f s, destination write %.3f s "
+             "(" CPL_FRMT_GIB " bytes)",
+             sStats.nChunksProcessed, sStats.dfSrcReadTime,
+             sStats.nSrcBytesRead, sStats.dfMaskTime, sStats.dfTransformTime,
+             sStats.dfKernelTime, sStats.dfDstReadTime, sStats.dfDstWriteTime,
+             sStats.nDstBytesWritten);
+}
+
+/************************************************************************/
+/*                        IsSourceWindowEmpty()                         */
+/************************************************************************/
+
+// Returns whether the source window only contains pixels at the source
+// nodata value, according to GDALGetDataCoverageStatus(). This is the case
+// of missing blocks of sparse files, or of areas of a VRT without any
+// source, provided that the nodata value of the source bands is the one
+// used by the warper, since they are then filled with it.
+static bool IsSourceWindowEmpty(const GDALWarpOptions *psOptions, int nSrcXOff,
+                                int nSrcYOff, int nSrcXSize, int nSrcYSize)
+{
+    if (psOptions->padfSrcNoDataReal == nullptr || psOptions->nBandCount == 0 ||
+        nSrcXSize <= 0 || nSrcYSize <= 0 ||
+        !CPLFetchBool(psOptions->papszWarpOptions, "SKIP_EMPTY_SOURCE", true))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < psOptions->nBandCount; i++)
+    {
+        GDALRasterBandH hBand =
+            GDALGetRasterBand(psOptions->hSrcDS, psOptions->panSrcBands[i]);
+        if (hBand == nullptr)
+            return false;
+
+        int bHasNoData = FALSE;
+        const double dfNoData = GDALGetRasterNoDataValue(hBand, &bHasNoData);
+        const double dfWarpNoData = psOptions->padfSrcNoDataReal[i];
+        if (!bHasNoData ||
+            !(dfNoData == dfWarpNoData ||
+              (std::isnan(dfNoData) && std::isnan(dfWarpNoData))) ||
+            (psOptions->padfSrcNoDataImag != nullptr &&
+             psOptions->padfSrcNoDataImag[i] != 0))
+        {
+            return false;
+        }
+
+        if (GDALGetDataCoverageStatus(hBand, nSrcXOff, nSrcYOff, nSrcXSize,
+                                      nSrcYSize, GDAL_DATA_COVERAGE_STATUS_DATA,
+                                      nullptr) &
+            GDAL_DATA_COVERAGE_STATUS_DATA)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                          GDALWarpOperation                           */
@@ -215,6 +393,48 @@ const GDALWarpOptions *GDALWarpOperation::GetOptions()
     return psOptions;
 }
 
+/************************************************************************/
+/*                           GetStatistics()                            */
+/************************************************************************/
+
+/**
+ * Return the counters cumulated over the chunks processed since the
+ * creation of the warp operation.
+ *
+ * They are meant to tell at a glance whether a warp operation is I/O bound
+ * or CPU bound, and can be fetched while it is running.
+ *
+ * @param psStatistics structure filled with the counters.
+ *
+ * @since GDAL 3.9
+ */
+void GDALWarpOperation::GetStatistics(GDALWarpStatistics *psStatistics)
+
+{
+    GDALWarpPrivateData *psPrivate = GetWarpPrivateData(this);
+    std::lock_guard<std::mutex> oLock(psPrivate->oStatisticsMutex);
+    *psStatistics = psPrivate->sStatistics;
+}
+
+/************************************************************************/
+/*                        GDALWarpGetStatistics()                       */
+/************************************************************************/
+
+/**
+ * @see GDALWarpOperation::GetStatistics()
+ * @since GDAL 3.9
+ */
+
+void GDALWarpGetStatistics(GDALWarpOperationH hOperation,
+                           GDALWarpStatistics *psStatistics)
+{
+    VALIDATE_POINTER0(hOperation, "GDALWarpGetStatistics");
+    VALIDATE_POINTER0(psStatistics, "GDALWarpGetStatistics");
+
+    reinterpret_cast<GDALWarpOperation *>(hOperation)
+        ->GetStatistics(psStatistics);
+}
+
 /************************************************************************/
 /*                            WipeOptions()                             */
 /************************************************************************/
@@ -519,8 +739,17 @@ CPLErr GDALWarpOperation::Initialize(const GDALWarpOptions *psNewOptions)
     /*      Copy the passed in options.                                     */
     /* -------------------------------------------------------------------- */
     if (psOptions != nullptr)
+    {
         WipeOptions();
 
+        // The cutline prepared from the previous options is obsolete.
+        GDALWarpPrivateData *psPrivate = GetWarpPrivateData(this);
+        std::lock_guard<std::mutex> oLock(psPrivate->oCutlineMutex);
+        GDALWarpDestroyPreparedCutline(psPrivate->psPreparedCutline);
+        psPrivate->psPreparedCutline = nullptr;
+        psPrivate->hPreparedCutlineSource = nullptr;
+    }
+
     psOptions = GDALCloneWarpOptions(psNewOptions);
     psOptions->papszWarpOptions =
         CSLSetNameValue(psOptions->papszWarpOptions, "EXTRA_ELTS",
@@ -853,6 +1082,11 @@ void GDALWarpOperation::CollectChunkList(int nDstXOff, int nDstYOff,
     /*      Collect the list of chunks to operate on.                       */
     /* -------------------------------------------------------------------- */
     WipeChunkList();
+    {
+        GDALWarpPrivateData *psPrivate = GetWarpPrivateData(this);
+        std::lock_guard<std::mutex> oLock(psPrivate->oEmptySrcChunksMutex);
+        psPrivate->oSetEmptySrcChunks.clear();
+    }
     CollectChunkListInternal(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
 
     // Sort chunks from top to bottom, and for equal y, from left to right.
@@ -918,6 +1152,10 @@ void GDALWarpOperation::CollectChunkList(int nDstXOff, int nDstYOff,
  * Once an appropriate region is selected GDALWarpOperation::WarpRegion()
  * is invoked to do the actual work.
  *
+ * The source buffer of each chunk is kept until the next chunk is processed,
+ * so that the part of the source window of the next chunk overlapping it is
+ * not read again.
+ *
  * @param nDstXOff X offset to window of destination data to be produced.
  * @param nDstYOff Y offset to window of destination data to be produced.
  * @param nDstXSize Width of output window on destination file to be produced.
@@ -954,6 +1192,8 @@ CPLErr GDALWarpOperation::ChunkAndWarpImage(int nDstXOff, int nDstYOff,
     /*      Process them one at a time, updating the progress               */
     /*      information for each region.                                    */
     /* -------------------------------------------------------------------- */
+    GDALWarpPrivateData *psPrivate = GetWarpPrivateData(this);
+    psPrivate->bReuseSrcWindows = true;
     double dfPixelsProcessed = 0.0;
 
     for (int iChunk = 0; pasChunkList != nullptr && iChunk < nChunkListCount;
@@ -973,12 +1213,18 @@ CPLErr GDALWarpOperation::ChunkAndWarpImage(int nDstXOff, int nDstYOff,
             pasThisChunk->sExtraSy, dfProgressBase, dfProgressScale);
 
         if (eErr != CE_None)
+        {
+            DiscardLastSourceWindow(psPrivate);
             return eErr;
+        }
 
         dfPixelsProcessed += dfChunkPixels;
     }
 
+    DiscardLastSourceWindow(psPrivate);
     WipeChunkList();
+    if (bReportTimings)
+        ReportStatistics(psPrivate);
 
     psOptions->pfnProgress(1.0, "", psOptions->pProgressArg);
 
@@ -1002,6 +1248,246 @@ CPLErr GDALChunkAndWarpImage(GDALWarpOperationH hOperation, int nDstXOff,
         ->ChunkAndWarpImage(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
 }
 
+/************************************************************************/
+/*                          ReadSourceWindow()                          */
+/************************************************************************/
+
+// Read the nReadXOff, nReadYOff, nReadXSize, nReadYSize part of a window of
+// the source bands in the working data type, laid out as expected by
+// GDALWarpKernel::papabySrcImage. The number of bytes read is added to
+// *pnBytesRead.
+static CPLErr ReadSourceWindow(GDALDataset *poSrcDS,
+                               const GDALWarpOptions *psOptions, int nSrcXOff,
+                               int nSrcYOff, int nSrcXSize, int nSrcYSize,
+                               GByte *pabyData, int nReadXOff, int nReadYOff,
+                               int nReadXSize, int nReadYSize,
+                               GIntBig *pnBytesRead)
+{
+    const int nWordSize = GDALGetDataTypeSizeBytes(psOptions->eWorkingDataType);
+    const GSpacing nLineSpace = static_cast<GSpacing>(nWordSize) * nSrcXSize;
+    GByte *pabyDst = pabyData +
+                     (nReadYOff - nSrcYOff) * nLineSpace +
+                     static_cast<GPtrDiff_t>(nReadXOff - nSrcXOff) * nWordSize;
+    *pnBytesRead += static_cast<GIntBig>(nReadXSize) * nReadYSize * nWordSize *
+                    psOptions->nBandCount;
+    if (psOptions->nBandCount == 1)
+    {
+        // Particular case to simplify the stack a bit.
+        return poSrcDS->GetRasterBand(psOptions->panSrcBands[0])
+            ->RasterIO(GF_Read, nReadXOff, nReadYOff, nReadXSize, nReadYSize,
+                       pabyDst, nReadXSize, nReadYSize,
+                       psOptions->eWorkingDataType, nWordSize, nLineSpace,
+                       nullptr);
+    }
+    return poSrcDS->RasterIO(
+        GF_Read, nReadXOff, nReadYOff, nReadXSize, nReadYSize, pabyDst,
+        nReadXSize, nReadYSize, psOptions->eWorkingDataType,
+        psOptions->nBandCount, psOptions->panSrcBands, nWordSize, nLineSpace,
+        nWordSize *
+            (static_cast<GPtrDiff_t>(nSrcXSize) * nSrcYSize + WARP_EXTRA_ELTS),
+        nullptr);
+}
+
+static CPLErr ReadSourceWindow(GDALDataset *poSrcDS,
+                               const GDALWarpOptions *psOptions, int nSrcXOff,
+                               int nSrcYOff, int nSrcXSize, int nSrcYSize,
+                               GByte *pabyData, GIntBig *pnBytesRead)
+{
+    return ReadSourceWindow(poSrcDS, psOptions, nSrcXOff, nSrcYOff, nSrcXSize,
+                            nSrcYSize, pabyData, nSrcXOff, nSrcYOff, nSrcXSize,
+                            nSrcYSize, pnBytesRead);
+}
+
+/************************************************************************/
+/*                     ReadSourceWindowReusingLast()                    */
+/************************************************************************/
+
+// Read a window of the source bands, copying its overlap with the source
+// window of the previous chunk from the buffer of that chunk, and reading
+// only the rows above and below the overlap, and the columns on its left and
+// right.
+static CPLErr ReadSourceWindowReusingLast(GDALWarpPrivateData *psPrivate,
+                                          GDALDataset *poSrcDS,
+                                          const GDALWarpOptions *psOptions,
+                                          int nSrcXOff, int nSrcYOff,
+                                          int nSrcXSize, int nSrcYSize,
+                                          GByte *pabyData,
+                                          GIntBig *pnBytesRead)
+{
+    std::lock_guard<std::mutex> oLock(psPrivate->oLastSrcWindowMutex);
+
+    const int nIntXOff = std::max(nSrcXOff, psPrivate->nLastSrcXOff);
+    const int nIntYOff = std::max(nSrcYOff, psPrivate->nLastSrcYOff);
+    const int nIntXEnd =
+        std::min(nSrcXOff + nSrcXSize,
+                 psPrivate->nLastSrcXOff + psPrivate->nLastSrcXSize);
+    const int nIntYEnd =
+        std::min(nSrcYOff + nSrcYSize,
+                 psPrivate->nLastSrcYOff + psPrivate->nLastSrcYSize);
+    if (psPrivate->pabyLastSrcData == nullptr || nIntXOff >= nIntXEnd ||
+        nIntYOff >= nIntYEnd)
+    {
+        return ReadSourceWindow(poSrcDS, psOptions, nSrcXOff, nSrcYOff,
+                                nSrcXSize, nSrcYSize, pabyData, pnBytesRead);
+    }
+
+    const int nWordSize = GDALGetDataTypeSizeBytes(psOptions->eWorkingDataType);
+    const size_t nBandSize =
+        nWordSize *
+        (static_cast<size_t>(nSrcXSize) * nSrcYSize + WARP_EXTRA_ELTS);
+    const size_t nLastBandSize =
+        nWordSize * (static_cast<size_t>(psPrivate->nLastSrcXSize) *
+                         psPrivate->nLastSrcYSize +
+                     WARP_EXTRA_ELTS);
+    const size_t nRowBytes = static_cast<size_t>(nIntXEnd - nIntXOff) *
+                             nWordSize;
+    for (int iBand = 0; iBand < psOptions->nBandCount; ++iBand)
+    {
+        for (int iY = nIntYOff; iY < nIntYEnd; ++iY)
+        {
+            memcpy(pabyData + iBand * nBandSize +
+                       (static_cast<size_t>(iY - nSrcYOff) * nSrcXSize +
+                        (nIntXOff - nSrcXOff)) *
+                           nWordSize,
+                   psPrivate->pabyLastSrcData + iBand * nLastBandSize +
+                       (static_cast<size_t>(iY - psPrivate->nLastSrcYOff) *
+                            psPrivate->nLastSrcXSize +
+                        (nIntXOff - psPrivate->nLastSrcXOff)) *
+                           nWordSize,
+                   nRowBytes);
+        }
+    }
+
+    CPLErr eErr = CE_None;
+    if (nIntYOff > nSrcYOff)
+    {
+        eErr = ReadSourceWindow(poSrcDS, psOptions, nSrcXOff, nSrcYOff,
+                                nSrcXSize, nSrcYSize, pabyData, nSrcXOff,
+                                nSrcYOff, nSrcXSize, nIntYOff - nSrcYOff,
+                                pnBytesRead);
+    }
+    if (eErr == CE_None && nIntYEnd < nSrcYOff + nSrcYSize)
+    {
+        eErr = ReadSourceWindow(poSrcDS, psOptions, nSrcXOff, nSrcYOff,
+                                nSrcXSize, nSrcYSize, pabyData, nSrcXOff,
+                                nIntYEnd, nSrcXSize,
+                                nSrcYOff + nSrcYSize - nIntYEnd, pnBytesRead);
+    }
+    if (eErr == CE_None && nIntXOff > nSrcXOff)
+    {
+        eErr = ReadSourceWindow(poSrcDS, psOptions, nSrcXOff, nSrcYOff,
+                                nSrcXSize, nSrcYSize, pabyData, nSrcXOff,
+                                nIntYOff, nIntXOff - nSrcXOff,
+                                nIntYEnd - nIntYOff, pnBytesRead);
+    }
+    if (eErr == CE_None && nIntXEnd < nSrcXOff + nSrcXSize)
+    {
+        eErr = ReadSourceWindow(poSrcDS, psOptions, nSrcXOff, nSrcYOff,
+                                nSrcXSize, nSrcYSize, pabyData, nIntXEnd,
+                                nIntYOff, nSrcXOff + nSrcXSize - nIntXEnd,
+                                nIntYEnd - nIntYOff, pnBytesRead);
+    }
+    return eErr;
+}
+
+/************************************************************************/
+/*                        KeepLastSourceWindow()                        */
+/************************************************************************/
+
+// Keep the source buffer of a chunk for the next one, or free it.
+static void KeepLastSourceWindow(GDALWarpPrivateData *psPrivate, int nSrcXOff,
+                                 int nSrcYOff, int nSrcXSize, int nSrcYSize,
+                                 GByte *pabyData)
+{
+    std::lock_guard<std::mutex> oLock(psPrivate->oLastSrcWindowMutex);
+    VSIFree(psPrivate->pabyLastSrcData);
+    psPrivate->pabyLastSrcData = pabyData;
+    psPrivate->nLastSrcXOff = nSrcXOff;
+    psPrivate->nLastSrcYOff = nSrcYOff;
+    psPrivate->nLastSrcXSize = nSrcXSize;
+    psPrivate->nLastSrcYSize = nSrcYSize;
+}
+
+/************************************************************************/
+/*                          PrefetchChunkJob()                          */
+/************************************************************************/
+
+typedef struct
+{
+    GDALDataset *poSrcDS;
+    const GDALWarpOptions *psOptions;
+    GDALWarpPrivateData *psPrivate;
+    GDALWarpPrefetchedChunk *psChunk;
+} PrefetchChunkJobData;
+
+static void PrefetchChunkJob(void *pData)
+{
+    const auto psJob = static_cast<const PrefetchChunkJobData *>(pData);
+    GDALWarpPrefetchedChunk *psChunk = psJob->psChunk;
+
+    bool bSuccess = false;
+    GDALWarpStatistics sStats{};
+    const auto tStart = std::chrono::steady_clock::now();
+    GDALDataset *poClone = psJob->poSrcDS->AcquireParallelReadClone();
+    if (poClone != nullptr)
+    {
+        // Running in a thread of the global thread pool: do not submit jobs
+        // to it.
+        CPLConfigOptionSetter oNumThreadsSetter("GDAL_NUM_THREADS", "1", true);
+        // Errors are reported when the chunk is read again by WarpRegion().
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        CPLErrorStateBackuper oErrorStateBackuper;
+        bSuccess = ReadSourceWindow(poClone, psJob->psOptions,
+                                    psChunk->nSrcXOff, psChunk->nSrcYOff,
+                                    psChunk->nSrcXSize, psChunk->nSrcYSize,
+                                    psChunk->pabyData,
+                                    &sStats.nSrcBytesRead) == CE_None;
+        psJob->poSrcDS->ReleaseParallelReadClone(poClone);
+    }
+    sStats.dfSrcReadTime = GetElapsedTime(tStart);
+    AddStatistics(psJob->psPrivate, sStats);
+
+    {
+        std::lock_guard<std::mutex> oLock(psJob->psPrivate->oPrefetchMutex);
+        psChunk->bSuccess = bSuccess;
+        psChunk->bDone = true;
+    }
+    psJob->psPrivate->oPrefetchCond.notify_all();
+}
+
+/************************************************************************/
+/*                     TakePrefetchedSourceWindow()                     */
+/************************************************************************/
+
+// Return the buffer read ahead for the chunk at the given destination offset,
+// waiting for its read to complete, or nullptr if it has not been read ahead
+// with the same source window. The caller takes ownership of the buffer.
+static GByte *TakePrefetchedSourceWindow(GDALWarpPrivateData *psPrivate,
+                                         int nDstXOff, int nDstYOff,
+                                         int nSrcXOff, int nSrcYOff,
+                                         int nSrcXSize, int nSrcYSize)
+{
+    std::unique_lock<std::mutex> oLock(psPrivate->oPrefetchMutex);
+    auto oIter = psPrivate->oMapPrefetchedChunks.find(
+        std::pair<int, int>(nDstXOff, nDstYOff));
+    if (oIter == psPrivate->oMapPrefetchedChunks.end())
+        return nullptr;
+    auto psChunk = std::move(oIter->second);
+    psPrivate->oMapPrefetchedChunks.erase(oIter);
+
+    psPrivate->oPrefetchCond.wait(oLock, [&psChunk] { return psChunk->bDone; });
+    psPrivate->nPrefetchedBytes -= psChunk->nSize;
+
+    if (!psChunk->bSuccess || psChunk->nSrcXOff != nSrcXOff ||
+        psChunk->nSrcYOff != nSrcYOff || psChunk->nSrcXSize != nSrcXSize ||
+        psChunk->nSrcYSize != nSrcYSize)
+    {
+        VSIFree(psChunk->pabyData);
+        return nullptr;
+    }
+    return psChunk->pabyData;
+}
+
 /************************************************************************/
 /*                          ChunkThreadMain()                           */
 /************************************************************************/
@@ -1079,6 +1565,8 @@ static void ChunkThreadMain(void *pThreadData)
  * Externally this method operates the same as ChunkAndWarpImage(), but
  * internally this method uses multiple threads to interleave input/output
  * for one region while the processing is being done for another.
+ * The source windows of the next chunks may also be read concurrently, from
+ * clones of the source dataset (see the PREFETCH_CHUNKS warp option).
  *
  * @param nDstXOff X offset to window of destination data to be produced.
  * @param nDstYOff Y offset to window of destination data to be produced.
@@ -1107,6 +1595,113 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(int nDstXOff, int nDstYOff,
     /* -------------------------------------------------------------------- */
     CollectChunkList(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
 
+    /* -------------------------------------------------------------------- */
+    /*      Read ahead the source windows of the next chunks, from clones   */
+    /*      of the source dataset, while previous chunks are warped.        */
+    /* -------------------------------------------------------------------- */
+    GDALWarpPrivateData *psPrivate = GetWarpPrivateData(this);
+    GDALDataset *poSrcDS = GDALDataset::FromHandle(psOptions->hSrcDS);
+    const char *pszPrefetchChunks = CSLFetchNameValueDef(
+        psOptions->papszWarpOptions, "PREFETCH_CHUNKS", "AUTO");
+    int nPrefetchChunks =
+        EQUAL(pszPrefetchChunks, "AUTO")
+            ? 4
+            : std::max(0, std::min(64, atoi(pszPrefetchChunks)));
+    if (nPrefetchChunks > 0 && nChunkListCount > 2 && poSrcDS != nullptr)
+    {
+        GDALDataset *poClone = poSrcDS->AcquireParallelReadClone();
+        if (poClone != nullptr)
+            poSrcDS->ReleaseParallelReadClone(poClone);
+        else
+            nPrefetchChunks = 0;
+    }
+    else
+    {
+        nPrefetchChunks = 0;
+    }
+
+    std::vector<PrefetchChunkJobData> asPrefetchJobs;
+    std::unique_ptr<CPLJobQueue> poPrefetchQueue;
+    if (nPrefetchChunks > 0)
+    {
+        CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nPrefetchChunks);
+        if (poPool != nullptr)
+            poPrefetchQueue = poPool->CreateJobQueue();
+        asPrefetchJobs.resize(nChunkListCount);
+        CPLDebug("WARP", "Reading ahead up to %d chunks", nPrefetchChunks);
+    }
+
+    psPrivate->bReuseSrcWindows = true;
+
+    // Submit the reads of the chunks up to iLastChunk, as long as the
+    // buffers read ahead and not yet warped fit in the warp memory limit.
+    int iNextPrefetchedChunk = 0;
+    const auto PrefetchChunks = [this, psPrivate, poSrcDS, &poPrefetchQueue,
+                                 &asPrefetchJobs,
+                                 &iNextPrefetchedChunk](int iLastChunk)
+    {
+        const int nWordSize =
+            GDALGetDataTypeSizeBytes(psOptions->eWorkingDataType);
+        iLastChunk = std::min(iLastChunk, nChunkListCount - 1);
+        for (; iNextPrefetchedChunk <= iLastChunk; ++iNextPrefetchedChunk)
+        {
+            const GDALWarpChunk *psChunkInfo =
+                pasChunkList + iNextPrefetchedChunk;
+            if (psChunkInfo->ssx <= 0 || psChunkInfo->ssy <= 0)
+                continue;
+            {
+                std::lock_guard<std::mutex> oLock(
+                    psPrivate->oEmptySrcChunksMutex);
+                if (psPrivate->oSetEmptySrcChunks.count(std::make_tuple(
+                        psChunkInfo->dx, psChunkInfo->dy, psChunkInfo->sx,
+                        psChunkInfo->sy, psChunkInfo->ssx, psChunkInfo->ssy)))
+                    continue;
+            }
+            const double dfSize =
+                static_cast<double>(nWordSize) *
+                (static_cast<double>(psChunkInfo->ssx) * psChunkInfo->ssy +
+                 WARP_EXTRA_ELTS) *
+                psOptions->nBandCount;
+            if (dfSize > static_cast<double>(
+                             std::numeric_limits<size_t>::max() / 2))
+                continue;
+            const size_t nSize = static_cast<size_t>(dfSize);
+
+            std::lock_guard<std::mutex> oLock(psPrivate->oPrefetchMutex);
+            if (psPrivate->nPrefetchedBytes > 0 &&
+                static_cast<double>(psPrivate->nPrefetchedBytes) + dfSize >
+                    psOptions->dfWarpMemoryLimit)
+            {
+                // Retried once previously read chunks have been warped.
+                break;
+            }
+
+            auto psChunk = std::make_unique<GDALWarpPrefetchedChunk>();
+            psChunk->nSrcXOff = psChunkInfo->sx;
+            psChunk->nSrcYOff = psChunkInfo->sy;
+            psChunk->nSrcXSize = psChunkInfo->ssx;
+            psChunk->nSrcYSize = psChunkInfo->ssy;
+            psChunk->nSize = nSize;
+            psChunk->pabyData = static_cast<GByte *>(VSIMalloc(nSize));
+            if (psChunk->pabyData == nullptr)
+                break;
+
+            PrefetchChunkJobData &sJob = asPrefetchJobs[iNextPrefetchedChunk];
+            sJob.poSrcDS = poSrcDS;
+            sJob.psOptions = psOptions;
+            sJob.psPrivate = psPrivate;
+            sJob.psChunk = psChunk.get();
+            if (!poPrefetchQueue->SubmitJob(PrefetchChunkJob, &sJob))
+            {
+                VSIFree(psChunk->pabyData);
+                break;
+            }
+            psPrivate->nPrefetchedBytes += nSize;
+            psPrivate->oMapPrefetchedChunks[std::pair<int, int>(
+                psChunkInfo->dx, psChunkInfo->dy)] = std::move(psChunk);
+        }
+    };
+
     /* -------------------------------------------------------------------- */
     /*      Process them one at a time, updating the progress               */
     /*      information for each region.                                    */
@@ -1135,6 +1730,15 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(int nDstXOff, int nDstYOff,
          */
         if (pasChunkList != nullptr && iChunk < nChunkListCount)
         {
+            if (poPrefetchQueue)
+            {
+                // The chunk launched now reads its source window itself if
+                // it has not been read ahead yet.
+                iNextPrefetchedChunk =
+                    std::max(iNextPrefetchedChunk, iChunk + 1);
+                PrefetchChunks(iChunk + nPrefetchChunks);
+            }
+
             GDALWarpChunk *pasThisChunk = pasChunkList + iChunk;
             const double dfChunkPixels =
                 pasThisChunk->dsx * static_cast<double>(pasThisChunk->dsy);
@@ -1217,10 +1821,24 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(int nDstXOff, int nDstYOff,
             CPLJoinThread(asThreadData[iThread].hThreadHandle);
     }
 
+    // Discard the chunks read ahead but not warped, after an error.
+    if (poPrefetchQueue)
+    {
+        poPrefetchQueue->WaitCompletion();
+        std::lock_guard<std::mutex> oLock(psPrivate->oPrefetchMutex);
+        for (auto &oIter : psPrivate->oMapPrefetchedChunks)
+            VSIFree(oIter.second->pabyData);
+        psPrivate->oMapPrefetchedChunks.clear();
+        psPrivate->nPrefetchedBytes = 0;
+    }
+    DiscardLastSourceWindow(psPrivate);
+
     CPLDestroyCond(hCond);
     CPLDestroyMutex(hCondMutex);
 
     WipeChunkList();
+    if (bReportTimings)
+        ReportStatistics(psPrivate);
 
     psOptions->pfnProgress(1.0, "", psOptions->pProgressArg);
 
@@ -1276,10 +1894,16 @@ CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
     double dfSrcXExtraSize = 0.0;
     double dfSrcYExtraSize = 0.0;
     double dfSrcFillRatio = 0.0;
+    const auto tStart = std::chrono::steady_clock::now();
     CPLErr eErr =
         ComputeSourceWindow(nDstXOff, nDstYOff, nDstXSize, nDstYSize, &nSrcXOff,
                             &nSrcYOff, &nSrcXSize, &nSrcYSize, &dfSrcXExtraSize,
                             &dfSrcYExtraSize, &dfSrcFillRatio);
+    {
+        GDALWarpStatistics sStats{};
+        sStats.dfTransformTime = GetElapsedTime(tStart);
+        AddStatistics(GetWarpPrivateData(this), sStats);
+    }
 
     if (eErr != CE_None)
     {
@@ -1294,10 +1918,25 @@ CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
     /*      If we are allowed to drop no-source regions, do so now if       */
     /*      appropriate.                                                    */
     /* -------------------------------------------------------------------- */
-    if ((nSrcXSize == 0 || nSrcYSize == 0) &&
-        CPLFetchBool(psOptions->papszWarpOptions, "SKIP_NOSOURCE", false))
+    const bool bSkipNoSource =
+        CPLFetchBool(psOptions->papszWarpOptions, "SKIP_NOSOURCE", false);
+    if ((nSrcXSize == 0 || nSrcYSize == 0) && bSkipNoSource)
         return CE_None;
 
+    // Same if the source window only contains nodata pixels, as in the
+    // holes of sparse mosaics.
+    if (bSkipNoSource &&
+        IsSourceWindowEmpty(psOptions, nSrcXOff, nSrcYOff, nSrcXSize,
+                            nSrcYSize))
+    {
+        CPLDebug("WARP",
+                 "Skipping chunk dst=(%d,%d,%d,%d) whose source window "
+                 "src=(%d,%d,%d,%d) is empty",
+                 nDstXOff, nDstYOff, nDstXSize, nDstYSize, nSrcXOff, nSrcYOff,
+                 nSrcXSize, nSrcYSize);
+        return CE_None;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Based on the types of masks in use, how many bits will each     */
     /*      source pixel cost us?                                           */
@@ -1484,6 +2123,18 @@ CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
 
     nChunkListCount++;
 
+    // Without SKIP_NOSOURCE, the destination of a chunk whose source window
+    // is empty must still be initialized and written, but reading the source
+    // and running the warp kernel can be avoided.
+    if (!bSkipNoSource && IsSourceWindowEmpty(psOptions, nSrcXOff, nSrcYOff,
+                                              nSrcXSize, nSrcYSize))
+    {
+        GDALWarpPrivateData *psPrivate = GetWarpPrivateData(this);
+        std::lock_guard<std::mutex> oLock(psPrivate->oEmptySrcChunksMutex);
+        psPrivate->oSetEmptySrcChunks.insert(std::make_tuple(
+            nDstXOff, nDstYOff, nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize));
+    }
+
     return CE_None;
 }
 
@@ -1570,6 +2221,15 @@ CPLErr GDALWarpOperation::WarpRegion(
     double dfSrcYExtraSize, double dfProgressBase, double dfProgressScale)
 
 {
+    CPLTraceSpan oTraceSpan("GDALWarpOperation::WarpRegion");
+    if (oTraceSpan.IsEnabled())
+    {
+        oTraceSpan.SetAttribute("x", static_cast<GIntBig>(nDstXOff));
+        oTraceSpan.SetAttribute("y", static_cast<GIntBig>(nDstYOff));
+        oTraceSpan.SetAttribute("width", static_cast<GIntBig>(nDstXSize));
+        oTraceSpan.SetAttribute("height", static_cast<GIntBig>(nDstYSize));
+    }
+
     ReportTiming(nullptr);
 
     /* -------------------------------------------------------------------- */
@@ -1587,9 +2247,11 @@ CPLErr GDALWarpOperation::WarpRegion(
     /*      If we aren't doing fixed initialization of the output buffer    */
     /*      then read it from disk so we can overlay on existing imagery.   */
     /* -------------------------------------------------------------------- */
+    GDALWarpStatistics sStats{};
     GDALDataset *poDstDS = GDALDataset::FromHandle(psOptions->hDstDS);
     if (!bDstBufferInitialized)
     {
+        const auto tStart = std::chrono::steady_clock::now();
         CPLErr eErr = CE_None;
         if (psOptions->nBandCount == 1)
         {
@@ -1609,9 +2271,11 @@ CPLErr GDALWarpOperation::WarpRegion(
                                      psOptions->panDstBands, 0, 0, 0, nullptr);
         }
 
+        sStats.dfDstReadTime = GetElapsedTime(tStart);
         if (eErr != CE_None)
         {
             DestroyDestinationBuffer(pDstBuffer);
+            AddStatistics(GetWarpPrivateData(this), sStats);
             return eErr;
         }
 
@@ -1631,6 +2295,7 @@ CPLErr GDALWarpOperation::WarpRegion(
     /* -------------------------------------------------------------------- */
     if (eErr == CE_None)
     {
+        const auto tStart = std::chrono::steady_clock::now();
         if (psOptions->nBandCount == 1)
         {
             // Particular case to simplify the stack a bit.
@@ -1659,6 +2324,11 @@ CPLErr GDALWarpOperation::WarpRegion(
                 osLastErrMsg.compare(CPLGetLastErrorMsg()) != 0)
                 eErr = CE_Failure;
         }
+        sStats.dfDstWriteTime = GetElapsedTime(tStart);
+        sStats.nDstBytesWritten =
+            static_cast<GIntBig>(nDstXSize) * nDstYSize *
+            GDALGetDataTypeSizeBytes(psOptions->eWorkingDataType) *
+            psOptions->nBandCount;
         ReportTiming("Output buffer write");
     }
 
@@ -1666,6 +2336,7 @@ CPLErr GDALWarpOperation::WarpRegion(
     /*      Cleanup and return.                                             */
     /* -------------------------------------------------------------------- */
     DestroyDestinationBuffer(pDstBuffer);
+    AddStatistics(GetWarpPrivateData(this), sStats);
 
     return eErr;
 }
@@ -1777,6 +2448,9 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 
     CPLAssert(eBufDataType == psOptions->eWorkingDataType);
 
+    GDALWarpStatistics sStats{};
+    sStats.nChunksProcessed = 1;
+
     /* -------------------------------------------------------------------- */
     /*      If not given a corresponding source window compute one now.     */
     /* -------------------------------------------------------------------- */
@@ -1791,10 +2465,12 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
                      "Failed to acquire WarpMutex in WarpRegion().");
             return CE_Failure;
         }
+        const auto tStart = std::chrono::steady_clock::now();
         const CPLErr eErr =
             ComputeSourceWindow(nDstXOff, nDstYOff, nDstXSize, nDstYSize,
                                 &nSrcXOff, &nSrcYOff, &nSrcXSize, &nSrcYSize,
                                 &dfSrcXExtraSize, &dfSrcYExtraSize, nullptr);
+        sStats.dfTransformTime = GetElapsedTime(tStart);
         if (hWarpMutex != nullptr)
             CPLReleaseMutex(hWarpMutex);
         if (eErr != CE_None)
@@ -1808,6 +2484,34 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Nothing to do if the source window was found to only contain    */
+    /*      nodata pixels when collecting the chunk list: the destination   */
+    /*      buffer is left as initialized by the caller.                    */
+    /* -------------------------------------------------------------------- */
+    {
+        GDALWarpPrivateData *psPrivate = GetWarpPrivateData(this);
+        std::lock_guard<std::mutex> oLock(psPrivate->oEmptySrcChunksMutex);
+        if (psPrivate->oSetEmptySrcChunks.erase(
+                std::make_tuple(nDstXOff, nDstYOff, nSrcXOff, nSrcYOff,
+                                nSrcXSize, nSrcYSize)) > 0)
+        {
+            CPLDebug("WARP",
+                     "Source window src=(%d,%d,%d,%d) is empty: "
+                     "skipping its reading and warping",
+                     nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize);
+            AddStatistics(psPrivate, sStats);
+            if (psOptions->pfnProgress != nullptr &&
+                !psOptions->pfnProgress(dfProgressBase + dfProgressScale, "",
+                                        psOptions->pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                return CE_Failure;
+            }
+            return CE_None;
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Prepare a WarpKernel object to match this operation.            */
     /* -------------------------------------------------------------------- */
@@ -1858,10 +2562,22 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     }
 #endif
 
+    // Source window possibly already read by ChunkAndWarpMulti().
+    auto tStart = std::chrono::steady_clock::now();
+    GByte *pabyPrefetched = nullptr;
+    if (nSrcXSize > 0 && nSrcYSize > 0)
+    {
+        pabyPrefetched = TakePrefetchedSourceWindow(
+            GetWarpPrivateData(this), nDstXOff, nDstYOff, nSrcXOff, nSrcYOff,
+            nSrcXSize, nSrcYSize);
+    }
+
     oWK.papabySrcImage = static_cast<GByte **>(
         CPLCalloc(sizeof(GByte *), psOptions->nBandCount));
     oWK.papabySrcImage[0] =
-        static_cast<GByte *>(VSI_MALLOC_VERBOSE(static_cast<size_t>(nAlloc64)));
+        pabyPrefetched ? pabyPrefetched
+                       : static_cast<GByte *>(
+                             VSI_MALLOC_VERBOSE(static_cast<size_t>(nAlloc64)));
 
     CPLErr eErr =
         nSrcXSize != 0 && nSrcYSize != 0 && oWK.papabySrcImage[0] == nullptr
@@ -1876,32 +2592,30 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
                  WARP_EXTRA_ELTS) *
                 i;
 
-    if (eErr == CE_None && nSrcXSize > 0 && nSrcYSize > 0)
+    GDALWarpPrivateData *psPrivate = GetWarpPrivateData(this);
+    const bool bReuseSrcWindow =
+        psPrivate->bReuseSrcWindows && psOptions->hSrcDS != psOptions->hDstDS;
+    if (eErr == CE_None && nSrcXSize > 0 && nSrcYSize > 0 &&
+        pabyPrefetched == nullptr)
     {
         GDALDataset *poSrcDS = GDALDataset::FromHandle(psOptions->hSrcDS);
-        if (psOptions->nBandCount == 1)
+        if (bReuseSrcWindow)
         {
-            // Particular case to simplify the stack a bit.
-            eErr = poSrcDS->GetRasterBand(psOptions->panSrcBands[0])
-                       ->RasterIO(GF_Read, nSrcXOff, nSrcYOff, nSrcXSize,
-                                  nSrcYSize, oWK.papabySrcImage[0], nSrcXSize,
-                                  nSrcYSize, psOptions->eWorkingDataType, 0, 0,
-                                  nullptr);
+            eErr = ReadSourceWindowReusingLast(
+                psPrivate, poSrcDS, psOptions, nSrcXOff, nSrcYOff, nSrcXSize,
+                nSrcYSize, oWK.papabySrcImage[0], &sStats.nSrcBytesRead);
         }
         else
         {
-            eErr = poSrcDS->RasterIO(
-                GF_Read, nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize,
-                oWK.papabySrcImage[0], nSrcXSize, nSrcYSize,
-                psOptions->eWorkingDataType, psOptions->nBandCount,
-                psOptions->panSrcBands, 0, 0,
-                nWordSize * (static_cast<GPtrDiff_t>(nSrcXSize) * nSrcYSize +
-                             WARP_EXTRA_ELTS),
-                nullptr);
+            eErr = ReadSourceWindow(
+                poSrcDS, psOptions, nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize,
+                oWK.papabySrcImage[0], &sStats.nSrcBytesRead);
         }
     }
 
+    sStats.dfSrcReadTime = GetElapsedTime(tStart);
     ReportTiming("Input buffer read");
+    tStart = std::chrono::steady_clock::now();
 
     /* -------------------------------------------------------------------- */
     /*      Initialize destination buffer.                                  */
@@ -1981,13 +2695,29 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
             }
         }
 
+        // Prepare the cutline on the first chunk, to speed up the
+        // processing of the following ones.
+        GDALWarpPreparedCutline *psPreparedCutline = nullptr;
+        {
+            GDALWarpPrivateData *psPrivate = GetWarpPrivateData(this);
+            std::lock_guard<std::mutex> oLock(psPrivate->oCutlineMutex);
+            if (psPrivate->hPreparedCutlineSource != psOptions->hCutline)
+            {
+                GDALWarpDestroyPreparedCutline(psPrivate->psPreparedCutline);
+                psPrivate->psPreparedCutline = GDALWarpPrepareCutline(
+                    static_cast<OGRGeometryH>(psOptions->hCutline));
+                psPrivate->hPreparedCutlineSource = psOptions->hCutline;
+            }
+            psPreparedCutline = psPrivate->psPreparedCutline;
+        }
+
         int nValidityFlag = 0;
         if (eErr == CE_None)
-            eErr = GDALWarpCutlineMaskerEx(
-                psOptions, psOptions->nBandCount, psOptions->eWorkingDataType,
-                oWK.nSrcXOff, oWK.nSrcYOff, oWK.nSrcXSize, oWK.nSrcYSize,
-                oWK.papabySrcImage, TRUE, oWK.pafUnifiedSrcDensity,
-                &nValidityFlag);
+            eErr = GDALWarpCutlineMaskerPrepared(
+                psPreparedCutline, psOptions, psOptions->nBandCount,
+                psOptions->eWorkingDataType, oWK.nSrcXOff, oWK.nSrcYOff,
+                oWK.nSrcXSize, oWK.nSrcYSize, oWK.papabySrcImage, TRUE,
+                oWK.pafUnifiedSrcDensity, &nValidityFlag);
         if (nValidityFlag == GCMVF_CHUNK_FULLY_WITHIN_CUTLINE &&
             bUnifiedSrcDensityJustCreated)
         {
@@ -2216,6 +2946,8 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
         }
     }
 
+    sStats.dfMaskTime = GetElapsedTime(tStart);
+
     /* -------------------------------------------------------------------- */
     /*      Release IO Mutex, and acquire warper mutex.                     */
     /* -------------------------------------------------------------------- */
@@ -2242,7 +2974,15 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     /* -------------------------------------------------------------------- */
     if (eErr == CE_None)
     {
+        tStart = std::chrono::steady_clock::now();
         eErr = oWK.PerformWarp();
+        // Kernels not run by GWKRun(), like the OpenCL one, only report
+        // their elapsed time.
+        const double dfKernelTime =
+            oWK.dfRunTime > 0 ? oWK.dfRunTime : GetElapsedTime(tStart);
+        sStats.dfTransformTime += oWK.dfTransformTime;
+        sStats.dfKernelTime =
+            std::max(0.0, dfKernelTime - oWK.dfTransformTime);
         ReportTiming("In memory warp operation");
     }
 
@@ -2272,16 +3012,26 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     /* -------------------------------------------------------------------- */
     if (eErr == CE_None && psOptions->nDstAlphaBand > 0)
     {
+        tStart = std::chrono::steady_clock::now();
         eErr = GDALWarpDstAlphaMasker(
             psOptions, -psOptions->nBandCount, psOptions->eWorkingDataType,
             oWK.nDstXOff, oWK.nDstYOff, oWK.nDstXSize, oWK.nDstYSize,
             oWK.papabyDstImage, TRUE, oWK.pafDstDensity);
+        sStats.dfMaskTime += GetElapsedTime(tStart);
     }
 
     /* -------------------------------------------------------------------- */
     /*      Cleanup.                                                        */
     /* -------------------------------------------------------------------- */
-    CPLFree(oWK.papabySrcImage[0]);
+    if (bReuseSrcWindow && eErr == CE_None && nSrcXSize > 0 && nSrcYSize > 0)
+    {
+        KeepLastSourceWindow(psPrivate, nSrcXOff, nSrcYOff, nSrcXSize,
+                             nSrcYSize, oWK.papabySrcImage[0]);
+    }
+    else
+    {
+        CPLFree(oWK.papabySrcImage[0]);
+    }
     CPLFree(oWK.papabySrcImage);
     CPLFree(oWK.papabyDstImage);
 
@@ -2296,6 +3046,10 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     CPLFree(oWK.panDstValid);
     CPLFree(oWK.pafDstDensity);
 
+    if (eErr != CE_None)
+        sStats.nChunksProcessed = 0;
+    AddStatistics(psPrivate, sStats);
+
     return eErr;
 }
 
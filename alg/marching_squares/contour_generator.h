@@ -69,6 +69,17 @@ class ContourGenerator
         return CE_None;
     }
 
+    // Start at line lineIdx, the line above it being previousLine, so that a
+    // horizontal strip of the raster can be processed on its own. The last
+    // line of the raster is only closed if the strip reaches it.
+    void setStartLine(size_t lineIdx, const double *previousLine)
+    {
+        lineIdx_ = lineIdx;
+        if (previousLine != nullptr)
+            std::copy(previousLine, previousLine + width_,
+                      previousLine_.begin());
+    }
+
   private:
     size_t width_;
     size_t height_;
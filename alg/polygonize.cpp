@@ -50,36 +50,162 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_priv.h"
+#include "gdal_thread_pool.h"
+#include "ogrsf_frmts.h"
 
 #include "polygonize_polygonizer.h"
 
 using namespace gdal::polygonizer;
 
 /************************************************************************/
-/*                          GPMaskImageData()                           */
+/*                            GPStripReader                             */
 /*                                                                      */
-/*      Mask out image pixels to a special nodata value if the mask     */
-/*      band is zero.                                                   */
+/*      Read the lines of the source band, masked by the mask band,     */
+/*      by strips of several lines. When a job queue is provided, the   */
+/*      next strip is read by a job while the current one is processed. */
 /************************************************************************/
 
-template <class DataType>
-static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
-                              int iY, int nXSize, DataType *panImageLine)
-
+namespace
+{
+template <class DataType> class GPStripReader
 {
-    const CPLErr eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, 1,
-                                     pabyMaskLine, nXSize, 1, GDT_Byte, 0, 0);
-    if (eErr != CE_None)
-        return eErr;
+    struct Strip
+    {
+        GPStripReader *poReader = nullptr;
+        int iYOff = -1;
+        int nLines = 0;
+        std::vector<DataType> aVal{};
+        std::vector<GByte> abyMask{};
+        CPLErr eErr = CE_None;
+    };
+
+    GDALRasterBandH hSrcBand_;
+    GDALRasterBandH hMaskBand_;
+    GDALDataType eDT_;
+    int nXSize_;
+    int nYSize_;
+    int nStripLines_ = 1;
+    CPLJobQueue *poJobQueue_;
+    Strip asStrips_[2]{};
+    int iCurStrip_ = 0;
+
+    static void ReadStripJob(void *pData)
+    {
+        auto psStrip = static_cast<Strip *>(pData);
+        psStrip->poReader->ReadStrip(*psStrip);
+    }
 
-    for (int i = 0; i < nXSize; i++)
+    void ReadStrip(Strip &oStrip)
     {
-        if (pabyMaskLine[i] == 0)
-            panImageLine[i] = GP_NODATA_MARKER;
+        oStrip.nLines = std::min(nStripLines_, nYSize_ - oStrip.iYOff);
+        oStrip.eErr = GDALRasterIO(hSrcBand_, GF_Read, 0, oStrip.iYOff,
+                                   nXSize_, oStrip.nLines, oStrip.aVal.data(),
+                                   nXSize_, oStrip.nLines, eDT_, 0, 0);
+        if (oStrip.eErr == CE_None && hMaskBand_ != nullptr)
+        {
+            oStrip.eErr = GDALRasterIO(
+                hMaskBand_, GF_Read, 0, oStrip.iYOff, nXSize_, oStrip.nLines,
+                oStrip.abyMask.data(), nXSize_, oStrip.nLines, GDT_Byte, 0, 0);
+            const size_t nPixels = static_cast<size_t>(nXSize_) * oStrip.nLines;
+            for (size_t i = 0; oStrip.eErr == CE_None && i < nPixels; i++)
+            {
+                if (oStrip.abyMask[i] == 0)
+                    oStrip.aVal[i] = GP_NODATA_MARKER;
+            }
+        }
     }
 
-    return CE_None;
-}
+    CPL_DISALLOW_COPY_ASSIGN(GPStripReader)
+
+  public:
+    GPStripReader(GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
+                  GDALDataType eDT, CPLJobQueue *poJobQueue)
+        : hSrcBand_(hSrcBand), hMaskBand_(hMaskBand), eDT_(eDT),
+          nXSize_(GDALGetRasterBandXSize(hSrcBand)),
+          nYSize_(GDALGetRasterBandYSize(hSrcBand)), poJobQueue_(poJobQueue)
+    {
+    }
+
+    ~GPStripReader()
+    {
+        if (poJobQueue_)
+            poJobQueue_->WaitCompletion();
+    }
+
+    // Allocate strips of about 4 MB, in whole blocks if possible.
+    bool Init()
+    {
+        int nBlockYSize = 1;
+        GDALGetBlockSize(hSrcBand_, nullptr, &nBlockYSize);
+        nStripLines_ = static_cast<int>(std::max<size_t>(
+            1, std::min<size_t>(nYSize_, 4 * 1024 * 1024 /
+                                             (sizeof(DataType) * nXSize_))));
+        if (nBlockYSize > 1 && nStripLines_ >= nBlockYSize)
+            nStripLines_ = nStripLines_ / nBlockYSize * nBlockYSize;
+
+        const size_t nPixels = static_cast<size_t>(nXSize_) * nStripLines_;
+        try
+        {
+            for (auto &oStrip : asStrips_)
+            {
+                oStrip.poReader = this;
+                oStrip.aVal.resize(nPixels);
+                if (hMaskBand_ != nullptr)
+                    oStrip.abyMask.resize(nPixels);
+            }
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate strips of %d lines", nStripLines_);
+            return false;
+        }
+        return true;
+    }
+
+    CPLErr ReadLine(int iY, DataType *panLine)
+    {
+        Strip *psStrip = &asStrips_[iCurStrip_];
+        if (iY < psStrip->iYOff || iY >= psStrip->iYOff + psStrip->nLines)
+        {
+            // Switch to the other strip, which is normally the one read
+            // ahead.
+            if (poJobQueue_)
+                poJobQueue_->WaitCompletion();
+            iCurStrip_ = 1 - iCurStrip_;
+            psStrip = &asStrips_[iCurStrip_];
+            const int iYOff = iY / nStripLines_ * nStripLines_;
+            if (psStrip->iYOff != iYOff)
+            {
+                psStrip->iYOff = iYOff;
+                ReadStrip(*psStrip);
+            }
+            if (psStrip->eErr != CE_None)
+            {
+                psStrip->iYOff = -1;
+                return CE_Failure;
+            }
+
+            Strip &oNextStrip = asStrips_[1 - iCurStrip_];
+            oNextStrip.iYOff = -1;
+            oNextStrip.nLines = 0;
+            if (poJobQueue_ && iYOff + nStripLines_ < nYSize_)
+            {
+                oNextStrip.iYOff = iYOff + nStripLines_;
+                poJobQueue_->SubmitJob(ReadStripJob, &oNextStrip);
+            }
+        }
+
+        memcpy(panLine,
+               psStrip->aVal.data() +
+                   static_cast<size_t>(iY - psStrip->iYOff) * nXSize_,
+               sizeof(DataType) * nXSize_);
+        return CE_None;
+    }
+};
+}  // namespace
 
 /************************************************************************/
 /*                           GDALPolygonizeT()                          */
@@ -133,17 +259,47 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
     GInt32 *panThisLineId =
         static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
 
-    GByte *pabyMaskLine = static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize));
+    /* -------------------------------------------------------------------- */
+    /*      Read the raster and write the features in other threads than    */
+    /*      the one tracing polygons, if requested and if the output layer  */
+    /*      is known not to belong to the source dataset.                   */
+    /* -------------------------------------------------------------------- */
+    std::unique_ptr<CPLJobQueue> poReadQueue;
+    std::unique_ptr<CPLJobQueue> poWriteQueue;
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads == nullptr)
+        pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads);
+    if (nThreads > 1)
+    {
+        const GDALDatasetH hOutDS = GDALDataset::ToHandle(
+            OGRLayer::FromHandle(hOutLayer)->GetDataset());
+        if (hOutDS == nullptr || hOutDS == GDALGetBandDataset(hSrcBand) ||
+            (hMaskBand != nullptr && hOutDS == GDALGetBandDataset(hMaskBand)))
+        {
+            CPLDebug("GDAL", "GDALPolygonize(): not using threads, as the "
+                             "output layer might belong to the source dataset");
+        }
+        else if (auto poPool = GDALGetGlobalThreadPool(std::min(nThreads, 2)))
+        {
+            poReadQueue = poPool->CreateJobQueue();
+            poWriteQueue = poPool->CreateJobQueue();
+        }
+    }
+
+    GPStripReader<DataType> oReader(hSrcBand, hMaskBand, eDT,
+                                    poReadQueue.get());
 
     if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
         panLastLineId == nullptr || panThisLineId == nullptr ||
-        pabyMaskLine == nullptr)
+        !oReader.Init())
     {
         CPLFree(panThisLineId);
         CPLFree(panLastLineId);
         CPLFree(panThisLineVal);
         CPLFree(panLastLineVal);
-        CPLFree(pabyMaskLine);
         return CE_Failure;
     }
 
@@ -194,13 +350,7 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
 
     for (int iY = 0; eErr == CE_None && iY < nYSize; iY++)
     {
-        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iY, nXSize, 1, panThisLineVal,
-                            nXSize, 1, eDT, 0, 0);
-
-        if (eErr == CE_None && hMaskBand != nullptr)
-            eErr = GPMaskImageData(hMaskBand, pabyMaskLine, iY, nXSize,
-                                   panThisLineVal);
-
+        eErr = oReader.ReadLine(iY, panThisLineVal);
         if (eErr != CE_None)
             break;
 
@@ -252,6 +402,7 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
 
     OGRPolygonWriter<DataType> oPolygonWriter{hOutLayer, iPixValField,
                                               adfGeoTransform};
+    oPolygonWriter.setJobQueue(poWriteQueue.get());
     Polygonizer<GInt32, DataType> oPolygonizer{-1, &oPolygonWriter};
     TwoArm *paoLastLineArm =
         static_cast<TwoArm *>(VSI_CALLOC_VERBOSE(sizeof(TwoArm), nXSize + 2));
@@ -283,11 +434,7 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
          */
         if (iY < nYSize)
         {
-            eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iY, nXSize, 1,
-                                panThisLineVal, nXSize, 1, eDT, 0, 0);
-            if (eErr == CE_None && hMaskBand != nullptr)
-                eErr = GPMaskImageData(hMaskBand, pabyMaskLine, iY, nXSize,
-                                       panThisLineVal);
+            eErr = oReader.ReadLine(iY, panThisLineVal);
         }
 
         if (eErr != CE_None)
@@ -375,6 +522,10 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         }
     }
 
+    oPolygonWriter.flush();
+    if (eErr == CE_None)
+        eErr = oPolygonWriter.getErr();
+
     /* -------------------------------------------------------------------- */
     /*      Cleanup                                                         */
     /* -------------------------------------------------------------------- */
@@ -384,7 +535,6 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
     CPLFree(panLastLineVal);
     CPLFree(paoThisLineArm);
     CPLFree(paoLastLineArm);
-    CPLFree(pabyMaskLine);
 
     return eErr;
 }
@@ -491,6 +641,12 @@ GBool GDALFloatEquals(float A, float B)
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=number_of_threads or ALL_CPUS: (GDAL >= 3.9) When set to
+ * a value greater than 1, the source raster is read ahead by strips, and
+ * features are written by batches, in worker threads, while polygons are
+ * traced in the calling thread. The output is unchanged. Only used if the
+ * output layer belongs to a dataset distinct from the source one. Defaults
+ * to the GDAL_NUM_THREADS configuration option, or 1.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -565,6 +721,12 @@ CPLErr CPL_STDCALL GDALPolygonize(GDALRasterBandH hSrcBand,
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=number_of_threads or ALL_CPUS: (GDAL >= 3.9) When set to
+ * a value greater than 1, the source raster is read ahead by strips, and
+ * features are written by batches, in worker threads, while polygons are
+ * traced in the calling thread. The output is unchanged. Only used if the
+ * output layer belongs to a dataset distinct from the source one. Defaults
+ * to the GDAL_NUM_THREADS configuration option, or 1.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -457,10 +457,66 @@ OGRPolygonWriter<DataType>::OGRPolygonWriter(OGRLayerH hOutLayer,
                                              int iPixValField,
                                              double *padfGeoTransform)
     : PolygonReceiver<DataType>(), hOutLayer_(hOutLayer),
+      hFeatureDefn_(OGR_L_GetLayerDefn(hOutLayer)),
       iPixValField_(iPixValField), padfGeoTransform_(padfGeoTransform)
 {
 }
 
+template <typename DataType> OGRPolygonWriter<DataType>::~OGRPolygonWriter()
+{
+    if (poJobQueue_)
+        poJobQueue_->WaitCompletion();
+    for (OGRFeatureH hFeat : ahPendingFeatures_)
+        OGR_F_Destroy(hFeat);
+}
+
+template <typename DataType>
+void OGRPolygonWriter<DataType>::writeFeaturesJob(void *pData)
+{
+    auto poWriter = static_cast<OGRPolygonWriter<DataType> *>(pData);
+    for (OGRFeatureH hFeat : poWriter->ahWritingFeatures_)
+    {
+        if (!poWriter->bWriteFailed_ &&
+            OGR_L_CreateFeature(poWriter->hOutLayer_, hFeat) != OGRERR_NONE)
+        {
+            poWriter->bWriteFailed_ = true;
+        }
+        OGR_F_Destroy(hFeat);
+    }
+    poWriter->ahWritingFeatures_.clear();
+}
+
+template <typename DataType> void OGRPolygonWriter<DataType>::waitWriting()
+{
+    poJobQueue_->WaitCompletion();
+    if (bWriteFailed_)
+        eErr_ = CE_Failure;
+}
+
+template <typename DataType>
+void OGRPolygonWriter<DataType>::writePendingFeatures()
+{
+    waitWriting();
+    if (eErr_ != CE_None)
+    {
+        for (OGRFeatureH hFeat : ahPendingFeatures_)
+            OGR_F_Destroy(hFeat);
+        ahPendingFeatures_.clear();
+        return;
+    }
+    std::swap(ahPendingFeatures_, ahWritingFeatures_);
+    poJobQueue_->SubmitJob(writeFeaturesJob, this);
+}
+
+template <typename DataType> void OGRPolygonWriter<DataType>::flush()
+{
+    if (poJobQueue_ == nullptr)
+        return;
+    if (!ahPendingFeatures_.empty())
+        writePendingFeatures();
+    waitWriting();
+}
+
 template <typename DataType>
 void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
                                          DataType nPolygonCellValue)
@@ -525,7 +581,7 @@ void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
     }
 
     // Create the feature object
-    OGRFeatureH hFeat = OGR_F_Create(OGR_L_GetLayerDefn(hOutLayer_));
+    OGRFeatureH hFeat = OGR_F_Create(hFeatureDefn_);
 
     OGR_F_SetGeometryDirectly(hFeat, hPolygon);
 
@@ -533,6 +589,15 @@ void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
         OGR_F_SetFieldDouble(hFeat, iPixValField_,
                              static_cast<double>(nPolygonCellValue));
 
+    // Leave the writing to the job queue, if any.
+    if (poJobQueue_)
+    {
+        ahPendingFeatures_.push_back(hFeat);
+        if (ahPendingFeatures_.size() == WRITE_BATCH_SIZE)
+            writePendingFeatures();
+        return;
+    }
+
     // Write the to the layer.
     if (OGR_L_CreateFeature(hOutLayer_, hFeat) != OGRERR_NONE)
         eErr_ = CE_Failure;
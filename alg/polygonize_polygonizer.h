@@ -40,6 +40,7 @@
 #include <map>
 
 #include "cpl_error.h"
+#include "cpl_worker_thread_pool.h"
 #include "ogr_api.h"
 
 namespace gdal
@@ -186,25 +187,55 @@ template <typename PolyIdType, typename DataType> class Polygonizer
 template <typename DataType>
 class OGRPolygonWriter : public PolygonReceiver<DataType>
 {
+    static constexpr std::size_t WRITE_BATCH_SIZE = 1000;
+
     OGRLayerH hOutLayer_;
+    OGRFeatureDefnH hFeatureDefn_;
     int iPixValField_;
     double *padfGeoTransform_;
 
     CPLErr eErr_{CE_None};
 
+    // When set, features are written to the layer by batches, by jobs of
+    // this queue, while the next polygons are traced.
+    CPLJobQueue *poJobQueue_{nullptr};
+    std::vector<OGRFeatureH> ahPendingFeatures_{};
+    std::vector<OGRFeatureH> ahWritingFeatures_{};
+    bool bWriteFailed_{false};
+
+    static void writeFeaturesJob(void *pData);
+
+    void waitWriting();
+
+    void writePendingFeatures();
+
   public:
     OGRPolygonWriter(OGRLayerH hOutLayer, int iPixValField,
                      double *padfGeoTransform);
 
     OGRPolygonWriter(const OGRPolygonWriter<DataType> &) = delete;
 
-    ~OGRPolygonWriter() = default;
+    ~OGRPolygonWriter();
 
     OGRPolygonWriter<DataType> &
     operator=(const OGRPolygonWriter<DataType> &) = delete;
 
     void receive(RPolygon *poPolygon, DataType nPolygonCellValue) override;
 
+    /**
+     * write features with jobs of poJobQueue. The layer must not be used
+     * by anything else until flush() has been called.
+     */
+    void setJobQueue(CPLJobQueue *poJobQueue)
+    {
+        poJobQueue_ = poJobQueue;
+    }
+
+    /**
+     * write the features not written yet by the jobs
+     */
+    void flush();
+
     inline CPLErr getErr()
     {
         return eErr_;
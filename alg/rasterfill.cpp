@@ -32,19 +32,24 @@
 #include "gdal_alg.h"
 
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 
 #include <algorithm>
+#include <limits>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALFilterLine()                           */
@@ -360,6 +365,610 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
     }
 }
 
+/************************************************************************/
+/*                   GDALFillNodataInterpolateLine()                    */
+/*                                                                      */
+/*      Interpolate the nodata pixels of a line from the nearest        */
+/*      valid pixels of each quadrant, found in the top to bottom       */
+/*      (TopDown) and bottom to top (Last) search information.          */
+/************************************************************************/
+
+static void GDALFillNodataInterpolateLine(
+    int iY, int nXSize, double dfMaxSearchDist, GUInt32 nNoDataVal,
+    const GUInt32 *panTopDownY, const float *pafTopDownValue,
+    const GUInt32 *panLastY, const float *pafLastValue, bool bHasNoData,
+    float fNoData, float *pafScanline, GByte *pabyMask, GByte *pabyFiltMask)
+{
+    const int nMaxSearchDist = static_cast<int>(floor(dfMaxSearchDist));
+
+    memset(pabyFiltMask, 0, nXSize);
+    for (int iX = 0; iX < nXSize; iX++)
+    {
+        int nThisMaxSearchDist = nMaxSearchDist;
+
+        // If this was a valid target - no change.
+        if (pabyMask[iX])
+            continue;
+
+        // Quadrants 0:topleft, 1:bottomleft, 2:topright, 3:bottomright
+        double adfQuadDist[4] = {};
+        float fQuadValue[4] = {};
+
+        for (int iQuad = 0; iQuad < 4; iQuad++)
+        {
+            adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
+            fQuadValue[iQuad] = 0.0;
+        }
+
+        // Step left and right by one pixel searching for the closest
+        // target value for each quadrant.
+        for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
+        {
+            const int iLeftX = std::max(0, iX - iStep);
+            const int iRightX = std::min(nXSize - 1, iX + iStep);
+
+            // Top left includes current line.
+            QUAD_CHECK(adfQuadDist[0], fQuadValue[0], iLeftX,
+                       panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
+                       nNoDataVal);
+
+            // Bottom left.
+            QUAD_CHECK(adfQuadDist[1], fQuadValue[1], iLeftX, panLastY[iLeftX],
+                       iX, iY, pafLastValue[iLeftX], nNoDataVal);
+
+            // Top right and bottom right do no include center pixel.
+            if (iStep == 0)
+                continue;
+
+            // Top right includes current line.
+            QUAD_CHECK(adfQuadDist[2], fQuadValue[2], iRightX,
+                       panTopDownY[iRightX], iX, iY, pafTopDownValue[iRightX],
+                       nNoDataVal);
+
+            // Bottom right.
+            QUAD_CHECK(adfQuadDist[3], fQuadValue[3], iRightX,
+                       panLastY[iRightX], iX, iY, pafLastValue[iRightX],
+                       nNoDataVal);
+
+            // Every four steps, recompute maximum distance.
+            if ((iStep & 0x3) == 0)
+                nThisMaxSearchDist = static_cast<int>(floor(
+                    std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
+                             std::max(adfQuadDist[2], adfQuadDist[3]))));
+        }
+
+        double dfWeightSum = 0.0;
+        double dfValueSum = 0.0;
+        bool bHasSrcValues = false;
+
+        for (int iQuad = 0; iQuad < 4; iQuad++)
+        {
+            if (adfQuadDist[iQuad] <= dfMaxSearchDist)
+            {
+                bHasSrcValues = true;
+                if (!bHasNoData || fQuadValue[iQuad] != fNoData)
+                {
+                    const double dfWeight = 1.0 / adfQuadDist[iQuad];
+                    dfWeightSum += dfWeight;
+                    dfValueSum += fQuadValue[iQuad] * dfWeight;
+                }
+            }
+        }
+
+        if (bHasSrcValues)
+        {
+            pabyFiltMask[iX] = 255;
+            if (dfWeightSum > 0.0)
+            {
+                pabyMask[iX] = 255;
+                pafScanline[iX] = static_cast<float>(dfValueSum / dfWeightSum);
+            }
+            else
+                pafScanline[iX] = fNoData;
+        }
+    }
+}
+
+/************************************************************************/
+/*                     GDALFillNodataLinesJobFunc()                     */
+/************************************************************************/
+
+namespace
+{
+// Consecutive lines interpolated by a job. Buffers point to the first line.
+struct GDALFillNodataLinesJob
+{
+    int iYStart = 0;
+    int nLines = 0;
+    int nXSize = 0;
+    double dfMaxSearchDist = 0;
+    GUInt32 nNoDataVal = 0;
+    bool bHasNoData = false;
+    float fNoData = 0;
+    const GUInt32 *panTopDownY = nullptr;
+    const float *pafTopDownValue = nullptr;
+    const GUInt32 *panLastY = nullptr;
+    const float *pafLastValue = nullptr;
+    float *pafScanline = nullptr;
+    GByte *pabyMask = nullptr;
+    GByte *pabyFiltMask = nullptr;
+};
+}  // namespace
+
+static void GDALFillNodataLinesJobFunc(void *pData)
+{
+    const auto psJob = static_cast<const GDALFillNodataLinesJob *>(pData);
+    for (int i = 0; i < psJob->nLines; i++)
+    {
+        const size_t nOffset = static_cast<size_t>(i) * psJob->nXSize;
+        GDALFillNodataInterpolateLine(
+            psJob->iYStart + i, psJob->nXSize, psJob->dfMaxSearchDist,
+            psJob->nNoDataVal, psJob->panTopDownY + nOffset,
+            psJob->pafTopDownValue + nOffset, psJob->panLastY + nOffset,
+            psJob->pafLastValue + nOffset, psJob->bHasNoData, psJob->fNoData,
+            psJob->pafScanline + nOffset, psJob->pabyMask + nOffset,
+            psJob->pabyFiltMask + nOffset);
+    }
+}
+
+/************************************************************************/
+/*                        GDALFillNodataPyramid()                       */
+/*                                                                      */
+/*      Push-pull interpolation: valid pixels are averaged into a       */
+/*      pyramid of levels of half resolution (push), then the holes     */
+/*      of each level are filled by bilinear interpolation of the       */
+/*      coarser level, from the coarsest one down to the full           */
+/*      resolution (pull). The full resolution is processed line by     */
+/*      line, and only coarser levels are kept in memory.               */
+/************************************************************************/
+
+namespace
+{
+struct GDALFillNodataLevel
+{
+    int nXSize = 0;
+    int nYSize = 0;
+    // Average of the valid pixels, NaN where there is none.
+    std::vector<float> afValues{};
+};
+}  // namespace
+
+// Average the valid pixels of one or two lines into a line of half the
+// resolution.
+static void GDALFillNodataPushLines(const float *pafLine0,
+                                    const float *pafLine1, int nXSize,
+                                    float *pafCoarseLine, int nCoarseXSize)
+{
+    for (int i = 0; i < nCoarseXSize; i++)
+    {
+        double dfSum = 0;
+        int nCount = 0;
+        for (int iX = 2 * i; iX < std::min(2 * i + 2, nXSize); iX++)
+        {
+            for (const float *pafLine : {pafLine0, pafLine1})
+            {
+                if (pafLine != nullptr && !std::isnan(pafLine[iX]))
+                {
+                    dfSum += pafLine[iX];
+                    nCount++;
+                }
+            }
+        }
+        pafCoarseLine[i] = nCount > 0
+                               ? static_cast<float>(dfSum / nCount)
+                               : std::numeric_limits<float>::quiet_NaN();
+    }
+}
+
+// Bilinear interpolation of the valid pixels of the coarser level at the
+// center of a pixel. NaN if there is none.
+static float GDALFillNodataPullValue(const GDALFillNodataLevel &oCoarse,
+                                     int iX, int iY)
+{
+    const double dfX = 0.5 * iX - 0.25;
+    const double dfY = 0.5 * iY - 0.25;
+    const int iX0 = static_cast<int>(floor(dfX));
+    const int iY0 = static_cast<int>(floor(dfY));
+    double dfSum = 0;
+    double dfWeightSum = 0;
+    for (int j = 0; j < 2; j++)
+    {
+        const int iYC = std::min(std::max(iY0 + j, 0), oCoarse.nYSize - 1);
+        const double dfWeightY = j == 0 ? 1 - (dfY - iY0) : dfY - iY0;
+        for (int i = 0; i < 2; i++)
+        {
+            const int iXC =
+                std::min(std::max(iX0 + i, 0), oCoarse.nXSize - 1);
+            const double dfWeight =
+                dfWeightY * (i == 0 ? 1 - (dfX - iX0) : dfX - iX0);
+            const float fValue =
+                oCoarse
+                    .afValues[static_cast<size_t>(iYC) * oCoarse.nXSize + iXC];
+            if (!std::isnan(fValue))
+            {
+                dfSum += dfWeight * fValue;
+                dfWeightSum += dfWeight;
+            }
+        }
+    }
+    return dfWeightSum > 0 ? static_cast<float>(dfSum / dfWeightSum)
+                           : std::numeric_limits<float>::quiet_NaN();
+}
+
+static CPLErr GDALFillNodataPyramid(GDALRasterBandH hTargetBand,
+                                    GDALRasterBandH hMaskBand,
+                                    bool bUpdateMask,
+                                    GDALRasterBandH hFiltMaskBand,
+                                    double dfMaxSearchDist, bool bHasNoData,
+                                    float fNoData, GDALProgressFunc pfnProgress,
+                                    void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hTargetBand);
+    const int nYSize = GDALGetRasterBandYSize(hTargetBand);
+
+    // Levels of half resolution, until their pixels span the maximum search
+    // distance, or the whole raster.
+    std::vector<GDALFillNodataLevel> aoLevels;
+    std::vector<float> afLines;
+    std::vector<GByte> abyMask;
+    std::vector<GByte> abyFiltMask;
+    try
+    {
+        int nLevelXSize = nXSize;
+        int nLevelYSize = nYSize;
+        double dfLevelPixelSize = 1;
+        do
+        {
+            nLevelXSize = (nLevelXSize + 1) / 2;
+            nLevelYSize = (nLevelYSize + 1) / 2;
+            dfLevelPixelSize *= 2;
+            aoLevels.resize(aoLevels.size() + 1);
+            aoLevels.back().nXSize = nLevelXSize;
+            aoLevels.back().nYSize = nLevelYSize;
+            aoLevels.back().afValues.resize(static_cast<size_t>(nLevelXSize) *
+                                            nLevelYSize);
+        } while ((nLevelXSize > 1 || nLevelYSize > 1) &&
+                 dfLevelPixelSize < dfMaxSearchDist);
+
+        afLines.resize(2 * static_cast<size_t>(nXSize));
+        abyMask.resize(2 * static_cast<size_t>(nXSize));
+        abyFiltMask.resize(nXSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate pyramid for INTERPOLATION=PYRAMID");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Push the full resolution into the first level.                  */
+    /* -------------------------------------------------------------------- */
+    GDALFillNodataLevel &oFirstLevel = aoLevels.front();
+    for (int iY = 0; iY < nYSize; iY += 2)
+    {
+        const int nLines = std::min(2, nYSize - iY);
+        if (GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, nLines,
+                         abyMask.data(), nXSize, nLines, GDT_Byte, 0,
+                         0) != CE_None ||
+            GDALRasterIO(hTargetBand, GF_Read, 0, iY, nXSize, nLines,
+                         afLines.data(), nXSize, nLines, GDT_Float32, 0,
+                         0) != CE_None)
+        {
+            return CE_Failure;
+        }
+
+        for (size_t i = 0; i < static_cast<size_t>(nLines) * nXSize; i++)
+        {
+            if (!abyMask[i] || (bHasNoData && afLines[i] == fNoData))
+                afLines[i] = std::numeric_limits<float>::quiet_NaN();
+        }
+        GDALFillNodataPushLines(
+            afLines.data(), nLines == 2 ? afLines.data() + nXSize : nullptr,
+            nXSize,
+            oFirstLevel.afValues.data() +
+                static_cast<size_t>(iY / 2) * oFirstLevel.nXSize,
+            oFirstLevel.nXSize);
+
+        if (!pfnProgress(0.5 * (iY + nLines) / nYSize, "Filling...",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Push each level into the next one, and pull them back.          */
+    /* -------------------------------------------------------------------- */
+    for (size_t iLevel = 1; iLevel < aoLevels.size(); iLevel++)
+    {
+        const GDALFillNodataLevel &oFine = aoLevels[iLevel - 1];
+        GDALFillNodataLevel &oCoarse = aoLevels[iLevel];
+        for (int iY = 0; iY < oCoarse.nYSize; iY++)
+        {
+            const float *pafLine0 = oFine.afValues.data() +
+                                    static_cast<size_t>(2 * iY) * oFine.nXSize;
+            GDALFillNodataPushLines(
+                pafLine0,
+                2 * iY + 1 < oFine.nYSize ? pafLine0 + oFine.nXSize : nullptr,
+                oFine.nXSize,
+                oCoarse.afValues.data() +
+                    static_cast<size_t>(iY) * oCoarse.nXSize,
+                oCoarse.nXSize);
+        }
+    }
+
+    for (size_t iLevel = aoLevels.size() - 1; iLevel > 0; iLevel--)
+    {
+        const GDALFillNodataLevel &oCoarse = aoLevels[iLevel];
+        GDALFillNodataLevel &oFine = aoLevels[iLevel - 1];
+        for (int iY = 0; iY < oFine.nYSize; iY++)
+        {
+            float *pafLine =
+                oFine.afValues.data() + static_cast<size_t>(iY) * oFine.nXSize;
+            for (int iX = 0; iX < oFine.nXSize; iX++)
+            {
+                if (std::isnan(pafLine[iX]))
+                    pafLine[iX] = GDALFillNodataPullValue(oCoarse, iX, iY);
+            }
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Pull the first level into the nodata pixels of the full         */
+    /*      resolution.                                                     */
+    /* -------------------------------------------------------------------- */
+    for (int iY = 0; iY < nYSize; iY++)
+    {
+        if (GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, 1, abyMask.data(),
+                         nXSize, 1, GDT_Byte, 0, 0) != CE_None ||
+            GDALRasterIO(hTargetBand, GF_Read, 0, iY, nXSize, 1,
+                         afLines.data(), nXSize, 1, GDT_Float32, 0,
+                         0) != CE_None)
+        {
+            return CE_Failure;
+        }
+
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            abyFiltMask[iX] = 0;
+            if (abyMask[iX])
+                continue;
+            const float fValue =
+                GDALFillNodataPullValue(oFirstLevel, iX, iY);
+            if (!std::isnan(fValue))
+            {
+                afLines[iX] = fValue;
+                abyMask[iX] = 255;
+                abyFiltMask[iX] = 255;
+            }
+        }
+
+        if (GDALRasterIO(hTargetBand, GF_Write, 0, iY, nXSize, 1,
+                         afLines.data(), nXSize, 1, GDT_Float32, 0,
+                         0) != CE_None ||
+            (bUpdateMask &&
+             GDALRasterIO(hMaskBand, GF_Write, 0, iY, nXSize, 1,
+                          abyMask.data(), nXSize, 1, GDT_Byte, 0,
+                          0) != CE_None) ||
+            GDALRasterIO(hFiltMaskBand, GF_Write, 0, iY, nXSize, 1,
+                         abyFiltMask.data(), nXSize, 1, GDT_Byte, 0,
+                         0) != CE_None)
+        {
+            return CE_Failure;
+        }
+
+        if (!pfnProgress(0.5 + 0.5 * (iY + 1) / nYSize, "Filling...",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                        GDALFillNodataSmooth()                        */
+/*                                                                      */
+/*      Iterative average filters over the interpolated values to       */
+/*      smooth things out and make linear artifacts less obvious.       */
+/************************************************************************/
+
+static CPLErr GDALFillNodataSmooth(GDALRasterBandH hTargetBand,
+                                   GDALRasterBandH hMaskBand,
+                                   bool bFlushMask,
+                                   GDALRasterBandH hFiltMaskBand,
+                                   int nSmoothingIterations,
+                                   double dfProgressRatio,
+                                   GDALProgressFunc pfnProgress,
+                                   void *pProgressArg)
+{
+    if (bFlushMask)
+    {
+        // Force masks to be to flushed and recomputed when the user
+        // didn't pass a user-provided hMaskBand, and we assigned it
+        // to be the mask band of hTargetBand.
+        GDALFlushRasterCache(hMaskBand);
+    }
+
+    void *pScaledProgress = GDALCreateScaledProgress(dfProgressRatio, 1.0,
+                                                     pfnProgress, pProgressArg);
+
+    const CPLErr eErr = GDALMultiFilter(hTargetBand, hMaskBand, hFiltMaskBand,
+                                        nSmoothingIterations,
+                                        GDALScaledProgress, pScaledProgress);
+
+    GDALDestroyScaledProgress(pScaledProgress);
+    return eErr;
+}
+
+/************************************************************************/
+/*                       GDALFillNodataBottomUp()                       */
+/*                                                                      */
+/*      Collect the this/last information from bottom to top and use    */
+/*      it in combination with the top to bottom search info to         */
+/*      interpolate. Lines are processed by batches: the column         */
+/*      information is propagated sequentially, and the interpolation   */
+/*      of the lines of a batch is split among threads.                 */
+/************************************************************************/
+
+static CPLErr GDALFillNodataBottomUp(
+    GDALRasterBandH hTargetBand, GDALRasterBandH hMaskBand, bool bUpdateMask,
+    GDALRasterBandH hFiltMaskBand, GDALRasterBandH hYBand,
+    GDALRasterBandH hValBand, double dfMaxSearchDist, GUInt32 nNoDataVal,
+    bool bHasNoData, float fNoData, int nThreads, double dfProgressRatio,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hTargetBand);
+    const int nYSize = GDALGetRasterBandYSize(hTargetBand);
+
+    // Batches of about 1 million pixels, and at least one line per thread.
+    const int nBatchLines =
+        std::max(std::min(nThreads, nYSize),
+                 std::min(nYSize, std::max(1, 1024 * 1024 / nXSize)));
+    const size_t nBatchSize = static_cast<size_t>(nBatchLines) * nXSize;
+
+    std::vector<GUInt32> anTopDownY;
+    std::vector<float> afTopDownValue;
+    std::vector<GUInt32> anLastY;
+    std::vector<float> afLastValue;
+    std::vector<float> afScanline;
+    std::vector<GByte> abyMask;
+    std::vector<GByte> abyFiltMask;
+    std::vector<GUInt32> anThisY;
+    std::vector<float> afThisValue;
+    try
+    {
+        anTopDownY.resize(nBatchSize);
+        afTopDownValue.resize(nBatchSize);
+        anLastY.resize(nBatchSize);
+        afLastValue.resize(nBatchSize);
+        afScanline.resize(nBatchSize);
+        abyMask.resize(nBatchSize);
+        abyFiltMask.resize(nBatchSize);
+        anThisY.resize(nXSize, nNoDataVal);
+        afThisValue.resize(nXSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate working buffers");
+        return CE_Failure;
+    }
+
+    auto poPool = nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    std::vector<GDALFillNodataLinesJob> asJobs(nThreads);
+
+    for (int iBatchEnd = nYSize; iBatchEnd > 0;)
+    {
+        const int iBatchStart = std::max(0, iBatchEnd - nBatchLines);
+        const int nLines = iBatchEnd - iBatchStart;
+        if (GDALRasterIO(hMaskBand, GF_Read, 0, iBatchStart, nXSize, nLines,
+                         abyMask.data(), nXSize, nLines, GDT_Byte, 0,
+                         0) != CE_None ||
+            GDALRasterIO(hTargetBand, GF_Read, 0, iBatchStart, nXSize, nLines,
+                         afScanline.data(), nXSize, nLines, GDT_Float32, 0,
+                         0) != CE_None ||
+            GDALRasterIO(hYBand, GF_Read, 0, iBatchStart, nXSize, nLines,
+                         anTopDownY.data(), nXSize, nLines, GDT_UInt32, 0,
+                         0) != CE_None ||
+            GDALRasterIO(hValBand, GF_Read, 0, iBatchStart, nXSize, nLines,
+                         afTopDownValue.data(), nXSize, nLines, GDT_Float32, 0,
+                         0) != CE_None)
+        {
+            return CE_Failure;
+        }
+
+        // Figure out the most recent pixel for each column, keeping the one
+        // of the line below each line of the batch.
+        for (int iY = iBatchEnd - 1; iY >= iBatchStart; iY--)
+        {
+            const size_t nOffset =
+                static_cast<size_t>(iY - iBatchStart) * nXSize;
+            memcpy(anLastY.data() + nOffset, anThisY.data(),
+                   nXSize * sizeof(GUInt32));
+            memcpy(afLastValue.data() + nOffset, afThisValue.data(),
+                   nXSize * sizeof(float));
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                if (abyMask[nOffset + iX])
+                {
+                    afThisValue[iX] = afScanline[nOffset + iX];
+                    anThisY[iX] = iY;
+                }
+                else if (anThisY[iX] - iY > dfMaxSearchDist)
+                {
+                    anThisY[iX] = nNoDataVal;
+                }
+            }
+        }
+
+        // Split the lines of the batch among jobs.
+        const int nJobs = std::min(nThreads, nLines);
+        for (int iJob = 0; iJob < nJobs; iJob++)
+        {
+            const int iJobStart = static_cast<int>(
+                static_cast<GIntBig>(nLines) * iJob / nJobs);
+            const int iJobEnd = static_cast<int>(
+                static_cast<GIntBig>(nLines) * (iJob + 1) / nJobs);
+            const size_t nOffset = static_cast<size_t>(iJobStart) * nXSize;
+            GDALFillNodataLinesJob &sJob = asJobs[iJob];
+            sJob.iYStart = iBatchStart + iJobStart;
+            sJob.nLines = iJobEnd - iJobStart;
+            sJob.nXSize = nXSize;
+            sJob.dfMaxSearchDist = dfMaxSearchDist;
+            sJob.nNoDataVal = nNoDataVal;
+            sJob.bHasNoData = bHasNoData;
+            sJob.fNoData = fNoData;
+            sJob.panTopDownY = anTopDownY.data() + nOffset;
+            sJob.pafTopDownValue = afTopDownValue.data() + nOffset;
+            sJob.panLastY = anLastY.data() + nOffset;
+            sJob.pafLastValue = afLastValue.data() + nOffset;
+            sJob.pafScanline = afScanline.data() + nOffset;
+            sJob.pabyMask = abyMask.data() + nOffset;
+            sJob.pabyFiltMask = abyFiltMask.data() + nOffset;
+            if (poQueue)
+                poQueue->SubmitJob(GDALFillNodataLinesJobFunc, &sJob);
+            else
+                GDALFillNodataLinesJobFunc(&sJob);
+        }
+        if (poQueue)
+            poQueue->WaitCompletion();
+
+        // Write out the updated data and mask information. The (copy of the)
+        // mask band is only updated when it has been provided by the user.
+        if (GDALRasterIO(hTargetBand, GF_Write, 0, iBatchStart, nXSize, nLines,
+                         afScanline.data(), nXSize, nLines, GDT_Float32, 0,
+                         0) != CE_None ||
+            (bUpdateMask &&
+             GDALRasterIO(hMaskBand, GF_Write, 0, iBatchStart, nXSize, nLines,
+                          abyMask.data(), nXSize, nLines, GDT_Byte, 0,
+                          0) != CE_None) ||
+            GDALRasterIO(hFiltMaskBand, GF_Write, 0, iBatchStart, nXSize,
+                         nLines, abyFiltMask.data(), nXSize, nLines, GDT_Byte,
+                         0, 0) != CE_None)
+        {
+            return CE_Failure;
+        }
+
+        iBatchEnd = iBatchStart;
+        if (!pfnProgress(dfProgressRatio *
+                             (0.5 + 0.5 * (nYSize - iBatchEnd) /
+                                        static_cast<double>(nYSize)),
+                         "Filling...", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                           GDALFillNodata()                           */
 /************************************************************************/
@@ -397,6 +1006,16 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
  * <li>NODATA=value (starting with GDAL 2.4).
  * Source pixels at that value will be ignored by the interpolator. Warning:
  * currently this will not be honored by smoothing passes.</li>
+ * <li>INTERPOLATION=INV_DIST/PYRAMID (GDAL >= 3.9). Defaults to INV_DIST,
+ * the four direction inverse distance weighting described above. PYRAMID
+ * averages valid pixels into successive levels of half resolution, up to
+ * dfMaxSearchDist, and fills nodata pixels by bilinear interpolation of
+ * the coarser levels. It is much faster on large holes, and only keeps the
+ * reduced levels in memory (about a third of the raster size as Float32).
+ * </li>
+ * <li>NUM_THREADS=n/ALL_CPUS (GDAL >= 3.9). Number of threads used to
+ * interpolate lines with INTERPOLATION=INV_DIST. Defaults to the
+ * GDAL_NUM_THREADS configuration option, or 1.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -421,8 +1040,6 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     if (dfMaxSearchDist == 0.0)
         dfMaxSearchDist = std::max(nXSize, nYSize) + 1;
 
-    const int nMaxSearchDist = static_cast<int>(floor(dfMaxSearchDist));
-
     // Special "x" pixel values identifying pixels as special.
     GDALDataType eType = GDT_UInt16;
     GUInt32 nNoDataVal = 65535;
@@ -511,6 +1128,24 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         fNoData = static_cast<float>(CPLAtof(pszNoData));
     }
 
+    const char *pszInterpolation =
+        CSLFetchNameValueDef(papszOptions, "INTERPOLATION", "INV_DIST");
+    const bool bPyramid = EQUAL(pszInterpolation, "PYRAMID");
+    if (!bPyramid && !EQUAL(pszInterpolation, "INV_DIST"))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Unsupported value for INTERPOLATION: %s", pszInterpolation);
+        return CE_Failure;
+    }
+
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads == nullptr)
+        pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads =
+        std::max(1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                                      ? CPLGetNumCPUs()
+                                      : atoi(pszNumThreads)));
+
     /* -------------------------------------------------------------------- */
     /*      Initialize progress counter.                                    */
     /* -------------------------------------------------------------------- */
@@ -523,6 +1158,50 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         return CE_Failure;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Create a mask file to make it clear what pixels can be filtered */
+    /*      on the filtering pass.                                          */
+    /* -------------------------------------------------------------------- */
+    const CPLString osFiltMaskTmpFile = osTmpFile + "fill_filtmask_work.tif";
+
+    auto poFiltMaskDS = std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(
+        GDALCreate(hDriver, osFiltMaskTmpFile, nXSize, nYSize, 1, GDT_Byte,
+                   aosWorkFileOptions.List())));
+
+    if (poFiltMaskDS == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Could not create mask work file. Check driver capabilities.");
+        return CE_Failure;
+    }
+    poFiltMaskDS->MarkSuppressOnClose();
+
+    GDALRasterBandH hFiltMaskBand =
+        GDALRasterBand::FromHandle(poFiltMaskDS->GetRasterBand(1));
+
+    /* -------------------------------------------------------------------- */
+    /*      Pyramid interpolation, and optional smoothing.                  */
+    /* -------------------------------------------------------------------- */
+    if (bPyramid)
+    {
+        void *pScaledProgress = GDALCreateScaledProgress(
+            0.0, dfProgressRatio, pfnProgress, pProgressArg);
+        CPLErr eErr = GDALFillNodataPyramid(
+            hTargetBand, hMaskBand, poTmpMaskDS != nullptr, hFiltMaskBand,
+            dfMaxSearchDist, bHasNoData, fNoData, GDALScaledProgress,
+            pScaledProgress);
+        GDALDestroyScaledProgress(pScaledProgress);
+
+        if (eErr == CE_None && nSmoothingIterations > 0)
+        {
+            eErr = GDALFillNodataSmooth(
+                hTargetBand, hMaskBand, poTmpMaskDS == nullptr, hFiltMaskBand,
+                nSmoothingIterations, dfProgressRatio, pfnProgress,
+                pProgressArg);
+        }
+        return eErr;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Create a work file to hold the Y "last value" indices.          */
     /* -------------------------------------------------------------------- */
@@ -567,27 +1246,6 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     GDALRasterBandH hValBand =
         GDALRasterBand::FromHandle(poValDS->GetRasterBand(1));
 
-    /* -------------------------------------------------------------------- */
-    /*      Create a mask file to make it clear what pixels can be filtered */
-    /*      on the filtering pass.                                          */
-    /* -------------------------------------------------------------------- */
-    const CPLString osFiltMaskTmpFile = osTmpFile + "fill_filtmask_work.tif";
-
-    auto poFiltMaskDS = std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(
-        GDALCreate(hDriver, osFiltMaskTmpFile, nXSize, nYSize, 1, GDT_Byte,
-                   aosWorkFileOptions.List())));
-
-    if (poFiltMaskDS == nullptr)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "Could not create mask work file. Check driver capabilities.");
-        return CE_Failure;
-    }
-    poFiltMaskDS->MarkSuppressOnClose();
-
-    GDALRasterBandH hFiltMaskBand =
-        GDALRasterBand::FromHandle(poFiltMaskDS->GetRasterBand(1));
-
     /* -------------------------------------------------------------------- */
     /*      Allocate buffers for last scanline and this scanline.           */
     /* -------------------------------------------------------------------- */
@@ -596,25 +1254,19 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
     GUInt32 *panThisY =
         static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
-    GUInt32 *panTopDownY =
-        static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
     float *pafLastValue =
         static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
     float *pafThisValue =
         static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
-    float *pafTopDownValue =
-        static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
     float *pafScanline =
         static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
     GByte *pabyMask = static_cast<GByte *>(VSI_CALLOC_VERBOSE(nXSize, 1));
-    GByte *pabyFiltMask = static_cast<GByte *>(VSI_CALLOC_VERBOSE(nXSize, 1));
 
     CPLErr eErr = CE_None;
 
-    if (panLastY == nullptr || panThisY == nullptr || panTopDownY == nullptr ||
+    if (panLastY == nullptr || panThisY == nullptr ||
         pafLastValue == nullptr || pafThisValue == nullptr ||
-        pafTopDownValue == nullptr || pafScanline == nullptr ||
-        pabyMask == nullptr || pabyFiltMask == nullptr)
+        pafScanline == nullptr || pabyMask == nullptr)
     {
         eErr = CE_Failure;
         goto end;
@@ -711,215 +1363,17 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         }
     }
 
-    for (int iX = 0; iX < nXSize; iX++)
-    {
-        panLastY[iX] = nNoDataVal;
-    }
-
     /* ==================================================================== */
     /*      Now we will do collect similar this/last information from       */
     /*      bottom to top and use it in combination with the top to         */
     /*      bottom search info to interpolate.                              */
     /* ==================================================================== */
-    for (int iY = nYSize - 1; iY >= 0 && eErr == CE_None; iY--)
+    if (eErr == CE_None)
     {
-        eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, 1, pabyMask,
-                            nXSize, 1, GDT_Byte, 0, 0);
-
-        if (eErr != CE_None)
-            break;
-
-        eErr = GDALRasterIO(hTargetBand, GF_Read, 0, iY, nXSize, 1, pafScanline,
-                            nXSize, 1, GDT_Float32, 0, 0);
-
-        if (eErr != CE_None)
-            break;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Figure out the most recent pixel for each column. */
-        /* --------------------------------------------------------------------
-         */
-
-        for (int iX = 0; iX < nXSize; iX++)
-        {
-            if (pabyMask[iX])
-            {
-                pafThisValue[iX] = pafScanline[iX];
-                panThisY[iX] = iY;
-            }
-            else if (panLastY[iX] - iY <= dfMaxSearchDist)
-            {
-                pafThisValue[iX] = pafLastValue[iX];
-                panThisY[iX] = panLastY[iX];
-            }
-            else
-            {
-                panThisY[iX] = nNoDataVal;
-            }
-        }
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Load the last y and corresponding value from the top down pass.
-         */
-        /* --------------------------------------------------------------------
-         */
-        eErr = GDALRasterIO(hYBand, GF_Read, 0, iY, nXSize, 1, panTopDownY,
-                            nXSize, 1, GDT_UInt32, 0, 0);
-
-        if (eErr != CE_None)
-            break;
-
-        eErr = GDALRasterIO(hValBand, GF_Read, 0, iY, nXSize, 1,
-                            pafTopDownValue, nXSize, 1, GDT_Float32, 0, 0);
-
-        if (eErr != CE_None)
-            break;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Attempt to interpolate any pixels that are nodata. */
-        /* --------------------------------------------------------------------
-         */
-        memset(pabyFiltMask, 0, nXSize);
-        for (int iX = 0; iX < nXSize; iX++)
-        {
-            int nThisMaxSearchDist = nMaxSearchDist;
-
-            // If this was a valid target - no change.
-            if (pabyMask[iX])
-                continue;
-
-            // Quadrants 0:topleft, 1:bottomleft, 2:topright, 3:bottomright
-            double adfQuadDist[4] = {};
-            float fQuadValue[4] = {};
-
-            for (int iQuad = 0; iQuad < 4; iQuad++)
-            {
-                adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
-                fQuadValue[iQuad] = 0.0;
-            }
-
-            // Step left and right by one pixel searching for the closest
-            // target value for each quadrant.
-            for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
-            {
-                const int iLeftX = std::max(0, iX - iStep);
-                const int iRightX = std::min(nXSize - 1, iX + iStep);
-
-                // Top left includes current line.
-                QUAD_CHECK(adfQuadDist[0], fQuadValue[0], iLeftX,
-                           panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
-                           nNoDataVal);
-
-                // Bottom left.
-                QUAD_CHECK(adfQuadDist[1], fQuadValue[1], iLeftX,
-                           panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
-                           nNoDataVal);
-
-                // Top right and bottom right do no include center pixel.
-                if (iStep == 0)
-                    continue;
-
-                // Top right includes current line.
-                QUAD_CHECK(adfQuadDist[2], fQuadValue[2], iRightX,
-                           panTopDownY[iRightX], iX, iY,
-                           pafTopDownValue[iRightX], nNoDataVal);
-
-                // Bottom right.
-                QUAD_CHECK(adfQuadDist[3], fQuadValue[3], iRightX,
-                           panLastY[iRightX], iX, iY, pafLastValue[iRightX],
-                           nNoDataVal);
-
-                // Every four steps, recompute maximum distance.
-                if ((iStep & 0x3) == 0)
-                    nThisMaxSearchDist = static_cast<int>(floor(
-                        std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
-                                 std::max(adfQuadDist[2], adfQuadDist[3]))));
-            }
-
-            double dfWeightSum = 0.0;
-            double dfValueSum = 0.0;
-            bool bHasSrcValues = false;
-
-            for (int iQuad = 0; iQuad < 4; iQuad++)
-            {
-                if (adfQuadDist[iQuad] <= dfMaxSearchDist)
-                {
-                    bHasSrcValues = true;
-                    if (!bHasNoData || fQuadValue[iQuad] != fNoData)
-                    {
-                        const double dfWeight = 1.0 / adfQuadDist[iQuad];
-                        dfWeightSum += dfWeight;
-                        dfValueSum += fQuadValue[iQuad] * dfWeight;
-                    }
-                }
-            }
-
-            if (bHasSrcValues)
-            {
-                pabyFiltMask[iX] = 255;
-                if (dfWeightSum > 0.0)
-                {
-                    pabyMask[iX] = 255;
-                    pafScanline[iX] =
-                        static_cast<float>(dfValueSum / dfWeightSum);
-                }
-                else
-                    pafScanline[iX] = fNoData;
-            }
-        }
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Write out the updated data and mask information. */
-        /* --------------------------------------------------------------------
-         */
-        eErr = GDALRasterIO(hTargetBand, GF_Write, 0, iY, nXSize, 1,
-                            pafScanline, nXSize, 1, GDT_Float32, 0, 0);
-
-        if (eErr != CE_None)
-            break;
-
-        if (poTmpMaskDS != nullptr)
-        {
-            // Update (copy of) mask band when it has been provided by the
-            // user
-            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iY, nXSize, 1, pabyMask,
-                                nXSize, 1, GDT_Byte, 0, 0);
-
-            if (eErr != CE_None)
-                break;
-        }
-
-        eErr = GDALRasterIO(hFiltMaskBand, GF_Write, 0, iY, nXSize, 1,
-                            pabyFiltMask, nXSize, 1, GDT_Byte, 0, 0);
-
-        if (eErr != CE_None)
-            break;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Flip this/last buffers. */
-        /* --------------------------------------------------------------------
-         */
-        std::swap(pafThisValue, pafLastValue);
-        std::swap(panThisY, panLastY);
-
-        /* --------------------------------------------------------------------
-         */
-        /*      report progress. */
-        /* --------------------------------------------------------------------
-         */
-        if (!pfnProgress(
-                dfProgressRatio *
-                    (0.5 + 0.5 * (nYSize - iY) / static_cast<double>(nYSize)),
-                "Filling...", pProgressArg))
-        {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            eErr = CE_Failure;
-        }
+        eErr = GDALFillNodataBottomUp(
+            hTargetBand, hMaskBand, poTmpMaskDS != nullptr, hFiltMaskBand,
+            hYBand, hValBand, dfMaxSearchDist, nNoDataVal, bHasNoData, fNoData,
+            nThreads, dfProgressRatio, pfnProgress, pProgressArg);
     }
 
     /* ==================================================================== */
@@ -929,22 +1383,10 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     /* ==================================================================== */
     if (eErr == CE_None && nSmoothingIterations > 0)
     {
-        if (poTmpMaskDS == nullptr)
-        {
-            // Force masks to be to flushed and recomputed when the user
-            // didn't pass a user-provided hMaskBand, and we assigned it
-            // to be the mask band of hTargetBand.
-            GDALFlushRasterCache(hMaskBand);
-        }
-
-        void *pScaledProgress = GDALCreateScaledProgress(
-            dfProgressRatio, 1.0, pfnProgress, pProgressArg);
-
-        eErr = GDALMultiFilter(hTargetBand, hMaskBand, hFiltMaskBand,
-                               nSmoothingIterations, GDALScaledProgress,
-                               pScaledProgress);
-
-        GDALDestroyScaledProgress(pScaledProgress);
+        eErr = GDALFillNodataSmooth(hTargetBand, hMaskBand,
+                                    poTmpMaskDS == nullptr, hFiltMaskBand,
+                                    nSmoothingIterations, dfProgressRatio,
+                                    pfnProgress, pProgressArg);
     }
 
 /* -------------------------------------------------------------------- */
@@ -953,13 +1395,10 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
 end:
     CPLFree(panLastY);
     CPLFree(panThisY);
-    CPLFree(panTopDownY);
     CPLFree(pafLastValue);
     CPLFree(pafThisValue);
-    CPLFree(pafTopDownValue);
     CPLFree(pafScanline);
     CPLFree(pabyMask);
-    CPLFree(pabyFiltMask);
 
     return eErr;
 }
@@ -42,7 +42,10 @@
 
 #include <algorithm>
 #include <limits>
+#include <system_error>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "cpl_error.h"
 #include "cpl_vsi.h"
@@ -53,6 +56,9 @@
 
 // #define VIZ_GEOREF_SPLINE_DEBUG 0
 
+// Minimum number of matrix elements to compute per thread.
+constexpr GIntBig TPS_MIN_ELTS_PER_THREAD = 1024 * 1024;
+
 bool VizGeorefSpline2D::grow_points()
 
 {
@@ -435,7 +441,7 @@ static void VizGeorefSpline2DBase_func4(double *res, const double *pxy,
 }
 #endif  // defined(USE_OPTIMIZED_VizGeorefSpline2DBase_func4)
 
-int VizGeorefSpline2D::solve()
+int VizGeorefSpline2D::solve(int nThreads)
 {
     // No points at all.
     if (_nof_points < 1)
@@ -584,14 +590,47 @@ int VizGeorefSpline2D::solve()
         A(c + 3, 2) = y[c];
     }
 
-    for (int r = 0; r < _nof_points; r++)
-        for (int c = r; c < _nof_points; c++)
+    // Compute the lower triangle of the symmetric part of the matrix, by
+    // columns, which are contiguous in memory. Columns are interleaved among
+    // threads to balance their workload.
+    const auto ComputeColumns = [this, &A](int iStart, int nStep)
+    {
+        for (int c = iStart; c < _nof_points; c += nStep)
         {
-            A(r + 3, c + 3) =
-                VizGeorefSpline2DBase_func(x[r], y[r], x[c], y[c]);
-            if (r != c)
-                A(c + 3, r + 3) = A(r + 3, c + 3);
+            for (int r = c; r < _nof_points; r++)
+            {
+                A(r + 3, c + 3) =
+                    VizGeorefSpline2DBase_func(x[r], y[r], x[c], y[c]);
+            }
         }
+    };
+    const int nJobs = static_cast<int>(std::min<GIntBig>(
+        nThreads, static_cast<GIntBig>(_nof_points) * _nof_points /
+                      (2 * TPS_MIN_ELTS_PER_THREAD)));
+    if (nJobs <= 1)
+    {
+        ComputeColumns(0, 1);
+    }
+    else
+    {
+        std::vector<std::thread> aoThreads;
+        for (int iJob = 0; iJob < nJobs; iJob++)
+        {
+            try
+            {
+                aoThreads.emplace_back(ComputeColumns, iJob, nJobs);
+            }
+            catch (const std::system_error &)
+            {
+                ComputeColumns(iJob, nJobs);
+            }
+        }
+        for (auto &oThread : aoThreads)
+            oThread.join();
+    }
+    for (int c = 0; c < _nof_points; c++)
+        for (int r = c + 1; r < _nof_points; r++)
+            A(c + 3, r + 3) = A(r + 3, c + 3);
 
 #if VIZ_GEOREF_SPLINE_DEBUG
 
@@ -611,7 +650,7 @@ int VizGeorefSpline2D::solve()
 
     GDALMatrix Coef(_nof_eqs, _nof_vars);
 
-    if (!GDALLinearSystemSolve(A, RHS, Coef))
+    if (!GDALLinearSystemSolve(A, RHS, Coef, nThreads))
     {
         return 0;
     }
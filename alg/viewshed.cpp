@@ -29,18 +29,23 @@
 #include "gdal_alg.h"
 
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <array>
 #include <limits>
 #include <algorithm>
+#include <mutex>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_spatialref.h"
 #include "ogr_core.h"
@@ -118,206 +123,117 @@ inline static double CalcHeight(double dfZ, double dfZ2, GDALViewshedMode eMode)
 }
 
 /************************************************************************/
-/*                        GDALViewshedGenerate()                         */
+/*                       GetViewshedSphereDiameter()                    */
 /************************************************************************/
 
-/**
- * Create viewshed from raster DEM.
- *
- * This algorithm will generate a viewshed raster from an input DEM raster
- * by using a modified algorithm of "Generating Viewsheds without Using
- * Sightlines" published at
- * https://www.asprs.org/wp-content/uploads/pers/2000journal/january/2000_jan_87-90.pdf
- * This appoach provides a relatively fast calculation, since the output raster
- * is generated in a single scan. The gdal/apps/gdal_viewshed.cpp mainline can
- * be used as an example of how to use this function. The output raster will be
- * of type Byte or Float64.
- *
- * \note The algorithm as implemented currently will only output meaningful
- * results if the georeferencing is in a projected coordinate reference system.
- *
- * @param hBand The band to read the DEM data from. Only the part of the raster
- * within the specified maxdistance around the observer point is processed.
- *
- * @param pszDriverName Driver name (GTiff if set to NULL)
- *
- * @param pszTargetRasterName The name of the target raster to be generated.
- * Must not be NULL
- *
- * @param papszCreationOptions creation options.
- *
- * @param dfObserverX observer X value (in SRS units)
- *
- * @param dfObserverY observer Y value (in SRS units)
- *
- * @param dfObserverHeight The height of the observer above the DEM surface.
- *
- * @param dfTargetHeight The height of the target above the DEM surface.
- * (default 0)
- *
- * @param dfVisibleVal pixel value for visibility (default 255)
- *
- * @param dfInvisibleVal pixel value for invisibility (default 0)
- *
- * @param dfOutOfRangeVal The value to be set for the cells that fall outside of
- * the range specified by dfMaxDistance.
- *
- * @param dfNoDataVal The value to be set for the cells that have no data.
- *                    If set to a negative value, nodata is not set.
- *                    Note: currently, no special processing of input cells at a
- * nodata value is done (which may result in erroneous results).
- *
- * @param dfCurvCoeff Coefficient to consider the effect of the curvature and
- * refraction. The height of the DEM is corrected according to the following
- * formula: [Height] -= dfCurvCoeff * [Target Distance]^2 / [Earth Diameter] For
- * the effect of the atmospheric refraction we can use 0.85714.
- *
- * @param eMode The mode of the viewshed calculation.
- * Possible values GVM_Diagonal = 1, GVM_Edge = 2 (default), GVM_Max = 3,
- * GVM_Min = 4.
- *
- * @param dfMaxDistance maximum distance range to compute viewshed.
- *                      It is also used to clamp the extent of the output
- * raster. If set to 0, then unlimited range is assumed, that is to say the
- *                      computation is performed on the extent of the whole
- * raster.
- *
- * @param pfnProgress A GDALProgressFunc that may be used to report progress
- * to the user, or to interrupt the algorithm.  May be NULL if not required.
- *
- * @param pProgressArg The callback data for the pfnProgress function.
- *
- * @param heightMode Type of information contained in output raster. Possible
- * values GVOT_NORMAL = 1 (default), GVOT_MIN_TARGET_HEIGHT_FROM_DEM = 2,
- *                   GVOT_MIN_TARGET_HEIGHT_FROM_GROUND = 3
- *
- *                   GVOT_NORMAL returns a raster of type Byte containing
- * visible locations.
- *
- *                   GVOT_MIN_TARGET_HEIGHT_FROM_DEM and
- * GVOT_MIN_TARGET_HEIGHT_FROM_GROUND will return a raster of type Float64
- * containing the minimum target height for target to be visible from the DEM
- * surface or ground level respectively. Parameters dfTargetHeight, dfVisibleVal
- * and dfInvisibleVal will be ignored.
- *
- *
- * @param papszExtraOptions Future extra options. Must be set to NULL currently.
- *
- * @return not NULL output dataset on success (to be closed with GDALClose()) or
- * NULL if an error occurs.
- *
- * @since GDAL 3.1
- */
-
-GDALDatasetH GDALViewshedGenerate(
-    GDALRasterBandH hBand, const char *pszDriverName,
-    const char *pszTargetRasterName, CSLConstList papszCreationOptions,
-    double dfObserverX, double dfObserverY, double dfObserverHeight,
-    double dfTargetHeight, double dfVisibleVal, double dfInvisibleVal,
-    double dfOutOfRangeVal, double dfNoDataVal, double dfCurvCoeff,
-    GDALViewshedMode eMode, double dfMaxDistance, GDALProgressFunc pfnProgress,
-    void *pProgressArg, GDALViewshedOutputType heightMode,
-    CSLConstList papszExtraOptions)
-
+static double GetViewshedSphereDiameter(const OGRSpatialReference *poSRS)
 {
-    VALIDATE_POINTER1(hBand, "GDALViewshedGenerate", nullptr);
-    VALIDATE_POINTER1(pszTargetRasterName, "GDALViewshedGenerate", nullptr);
-
-    CPL_IGNORE_RET_VAL(papszExtraOptions);
-
-    if (pfnProgress == nullptr)
-        pfnProgress = GDALDummyProgress;
-
-    if (!pfnProgress(0.0, "", pProgressArg))
+    /* If we can't get a SemiMajor axis from the SRS, it will be
+     * SRS_WGS84_SEMIMAJOR
+     */
+    double dfSphereDiameter(std::numeric_limits<double>::infinity());
+    if (poSRS)
     {
-        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-        return nullptr;
-    }
-
-    const GByte byNoDataVal = dfNoDataVal >= 0 && dfNoDataVal <= 255
-                                  ? static_cast<GByte>(dfNoDataVal)
-                                  : 0;
-    const GByte byVisibleVal = dfVisibleVal >= 0 && dfVisibleVal <= 255
-                                   ? static_cast<GByte>(dfVisibleVal)
-                                   : 255;
-    const GByte byInvisibleVal = dfInvisibleVal >= 0 && dfInvisibleVal <= 255
-                                     ? static_cast<GByte>(dfInvisibleVal)
-                                     : 0;
-    const GByte byOutOfRangeVal = dfOutOfRangeVal >= 0 && dfOutOfRangeVal <= 255
-                                      ? static_cast<GByte>(dfOutOfRangeVal)
-                                      : 0;
-
-    if (heightMode != GVOT_MIN_TARGET_HEIGHT_FROM_DEM &&
-        heightMode != GVOT_MIN_TARGET_HEIGHT_FROM_GROUND)
-        heightMode = GVOT_NORMAL;
-
-    /* set up geotransformation */
-    std::array<double, 6> adfGeoTransform{{0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
-    GDALDatasetH hSrcDS = GDALGetBandDataset(hBand);
-    if (hSrcDS != nullptr)
-        GDALGetGeoTransform(hSrcDS, adfGeoTransform.data());
+        OGRErr eSRSerr;
+        double dfSemiMajor = poSRS->GetSemiMajor(&eSRSerr);
 
-    double adfInvGeoTransform[6];
-    if (!GDALInvGeoTransform(adfGeoTransform.data(), adfInvGeoTransform))
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Cannot invert geotransform");
-        return nullptr;
+        /* If we fetched the axis from the SRS, use it */
+        if (eSRSerr != OGRERR_FAILURE)
+            dfSphereDiameter = dfSemiMajor * 2.0;
+        else
+            CPLDebug("GDALViewshedGenerate",
+                     "Unable to fetch SemiMajor axis from spatial reference");
     }
+    return dfSphereDiameter;
+}
 
-    /* calculate observer position */
-    double dfX, dfY;
-    GDALApplyGeoTransform(adfInvGeoTransform, dfObserverX, dfObserverY, &dfX,
-                          &dfY);
-    int nX = static_cast<int>(dfX);
-    int nY = static_cast<int>(dfY);
-
-    int nXSize = GDALGetRasterBandXSize(hBand);
-    int nYSize = GDALGetRasterBandYSize(hBand);
-
-    if (nX < 0 || nX > nXSize || nY < 0 || nY > nYSize)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "The observer location falls outside of the DEM area");
-        return nullptr;
-    }
+/************************************************************************/
+/*                          GetViewshedWindow()                         */
+/*                                                                      */
+/*      Compute the area of interest around an observer, that is        */
+/*      the part of the DEM within dfMaxDistance, or the whole DEM.     */
+/************************************************************************/
 
-    /* calculate the area of interest */
-    int nXStart =
+static void GetViewshedWindow(const double *adfInvGeoTransform, int nX, int nY,
+                              int nXSize, int nYSize, double dfMaxDistance,
+                              int &nXStart, int &nXStop, int &nYStart,
+                              int &nYStop)
+{
+    nXStart =
         dfMaxDistance > 0
             ? (std::max)(0, static_cast<int>(std::floor(
                                 nX - adfInvGeoTransform[1] * dfMaxDistance)))
             : 0;
-    int nXStop =
+    nXStop =
         dfMaxDistance > 0
             ? (std::min)(nXSize,
                          static_cast<int>(std::ceil(nX + adfInvGeoTransform[1] *
                                                              dfMaxDistance) +
                                           1))
             : nXSize;
-    int nYStart =
+    nYStart =
         dfMaxDistance > 0
             ? (std::max)(0, static_cast<int>(std::floor(
                                 nY + adfInvGeoTransform[5] * dfMaxDistance)))
             : 0;
-    int nYStop =
+    nYStop =
         dfMaxDistance > 0
             ? (std::min)(nYSize,
                          static_cast<int>(std::ceil(nY - adfInvGeoTransform[5] *
                                                              dfMaxDistance) +
                                           1))
             : nYSize;
+}
 
-    /* normalize horizontal index (0 - nXSize) */
-    nXSize = nXStop - nXStart;
-    nX -= nXStart;
+namespace
+{
+// Parameters of the computation of the viewshed of an observer.
+struct GDALViewshedParams
+{
+    const double *adfGeoTransform = nullptr;
+    double dfObserverHeight = 0;
+    double dfTargetHeight = 0;
+    double dfMaxDistance = 0;
+    double dfCurvCoeff = 0;
+    double dfSphereDiameter = 0;
+    GDALViewshedMode eMode = GVM_Edge;
+    GDALViewshedOutputType heightMode = GVOT_NORMAL;
+    GByte byVisibleVal = 255;
+    GByte byInvisibleVal = 0;
+    GByte byOutOfRangeVal = 0;
+    double dfOutOfRangeVal = 0;
+};
+}  // namespace
 
-    nYSize = nYStop - nYStart;
+/************************************************************************/
+/*                            ViewshedScan()                            */
+/*                                                                      */
+/*      Compute the viewshed of the observer at pixel nX of line nY     */
+/*      of a window of nXSize pixels, from the observer line up to      */
+/*      nYStart, then down to nYStop (excluded). readLine(iLine, buf)   */
+/*      fetches the DEM values of a line, and writeLine(iLine,          */
+/*      pabyResult, padfHeightResult) stores its result.                */
+/************************************************************************/
 
-    if (nXSize == 0 || nYSize == 0)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Invalid target raster size");
-        return nullptr;
-    }
+template <class ReadLine, class WriteLine>
+static bool ViewshedScan(const GDALViewshedParams &sParams, int nXSize, int nX,
+                         int nY, int nYStart, int nYStop, ReadLine readLine,
+                         WriteLine writeLine, GDALProgressFunc pfnProgress,
+                         void *pProgressArg)
+{
+    const double *adfGeoTransform = sParams.adfGeoTransform;
+    const double dfObserverHeight = sParams.dfObserverHeight;
+    const double dfTargetHeight = sParams.dfTargetHeight;
+    const double dfMaxDistance = sParams.dfMaxDistance;
+    const double dfCurvCoeff = sParams.dfCurvCoeff;
+    const double dfSphereDiameter = sParams.dfSphereDiameter;
+    const GDALViewshedMode eMode = sParams.eMode;
+    const GDALViewshedOutputType heightMode = sParams.heightMode;
+    const GByte byVisibleVal = sParams.byVisibleVal;
+    const GByte byInvisibleVal = sParams.byInvisibleVal;
+    const GByte byOutOfRangeVal = sParams.byOutOfRangeVal;
+    const double dfOutOfRangeVal = sParams.dfOutOfRangeVal;
+    const int nYSize = nYStop - nYStart;
 
     std::vector<double> vFirstLineVal;
     std::vector<double> vLastLineVal;
@@ -339,7 +255,7 @@ GDALDatasetH GDALViewshedGenerate(
     {
         CPLError(CE_Failure, CPLE_AppDefined,
                  "Cannot allocate vectors for viewshed");
-        return nullptr;
+        return false;
     }
 
     double *padfFirstLineVal = vFirstLineVal.data();
@@ -348,87 +264,14 @@ GDALDatasetH GDALViewshedGenerate(
     GByte *pabyResult = vResult.data();
     double *dfHeightResult = vHeightResult.data();
 
-    GDALDriverManager *hMgr = GetGDALDriverManager();
-    GDALDriver *hDriver =
-        hMgr->GetDriverByName(pszDriverName ? pszDriverName : "GTiff");
-    if (!hDriver)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get driver");
-        return nullptr;
-    }
-
-    /* create output raster */
-    auto poDstDS = std::unique_ptr<GDALDataset>(
-        hDriver->Create(pszTargetRasterName, nXSize, nYStop - nYStart, 1,
-                        heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte,
-                        const_cast<char **>(papszCreationOptions)));
-    if (!poDstDS)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create dataset for %s",
-                 pszTargetRasterName);
-        return nullptr;
-    }
-    /* copy srs */
-    if (hSrcDS)
-        poDstDS->SetSpatialRef(
-            GDALDataset::FromHandle(hSrcDS)->GetSpatialRef());
-
-    std::array<double, 6> adfDstGeoTransform;
-    adfDstGeoTransform[0] = adfGeoTransform[0] + adfGeoTransform[1] * nXStart +
-                            adfGeoTransform[2] * nYStart;
-    adfDstGeoTransform[1] = adfGeoTransform[1];
-    adfDstGeoTransform[2] = adfGeoTransform[2];
-    adfDstGeoTransform[3] = adfGeoTransform[3] + adfGeoTransform[4] * nXStart +
-                            adfGeoTransform[5] * nYStart;
-    adfDstGeoTransform[4] = adfGeoTransform[4];
-    adfDstGeoTransform[5] = adfGeoTransform[5];
-    poDstDS->SetGeoTransform(adfDstGeoTransform.data());
-
-    auto hTargetBand = poDstDS->GetRasterBand(1);
-    if (hTargetBand == nullptr)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get band for %s",
-                 pszTargetRasterName);
-        return nullptr;
-    }
-
-    if (dfNoDataVal >= 0)
-        GDALSetRasterNoDataValue(
-            hTargetBand, heightMode != GVOT_NORMAL ? dfNoDataVal : byNoDataVal);
-
     /* process first line */
-    if (GDALRasterIO(hBand, GF_Read, nXStart, nY, nXSize, 1, padfFirstLineVal,
-                     nXSize, 1, GDT_Float64, 0, 0))
-    {
-        CPLError(
-            CE_Failure, CPLE_AppDefined,
-            "RasterIO error when reading DEM at position(%d, %d), size(%d, %d)",
-            nXStart, nY, nXSize, 1);
-        return nullptr;
-    }
+    if (!readLine(nY, padfFirstLineVal))
+        return false;
 
     const double dfZObserver = dfObserverHeight + padfFirstLineVal[nX];
     double dfZ = 0.0;
     const double dfDistance2 = dfMaxDistance * dfMaxDistance;
 
-    /* If we can't get a SemiMajor axis from the SRS, it will be
-     * SRS_WGS84_SEMIMAJOR
-     */
-    double dfSphereDiameter(std::numeric_limits<double>::infinity());
-    const OGRSpatialReference *poDstSRS = poDstDS->GetSpatialRef();
-    if (poDstSRS)
-    {
-        OGRErr eSRSerr;
-        double dfSemiMajor = poDstSRS->GetSemiMajor(&eSRSerr);
-
-        /* If we fetched the axis from the SRS, use it */
-        if (eSRSerr != OGRERR_FAILURE)
-            dfSphereDiameter = dfSemiMajor * 2.0;
-        else
-            CPLDebug("GDALViewshedGenerate",
-                     "Unable to fetch SemiMajor axis from spatial reference");
-    }
-
     /* mark the observer point as visible */
     double dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
                                ? padfFirstLineVal[nX]
@@ -443,7 +286,7 @@ GDALDatasetH GDALViewshedGenerate(
                             ? padfFirstLineVal[nX - 1]
                             : 0.0;
         CPL_IGNORE_RET_VAL(AdjustHeightInRange(
-            adfGeoTransform.data(), 1, 0, padfFirstLineVal[nX - 1], dfDistance2,
+            adfGeoTransform, 1, 0, padfFirstLineVal[nX - 1], dfDistance2,
             dfCurvCoeff, dfSphereDiameter));
         pabyResult[nX - 1] = byVisibleVal;
         if (heightMode != GVOT_NORMAL)
@@ -455,7 +298,7 @@ GDALDatasetH GDALViewshedGenerate(
                             ? padfFirstLineVal[nX + 1]
                             : 0.0;
         CPL_IGNORE_RET_VAL(AdjustHeightInRange(
-            adfGeoTransform.data(), 1, 0, padfFirstLineVal[nX + 1], dfDistance2,
+            adfGeoTransform, 1, 0, padfFirstLineVal[nX + 1], dfDistance2,
             dfCurvCoeff, dfSphereDiameter));
         pabyResult[nX + 1] = byVisibleVal;
         if (heightMode != GVOT_NORMAL)
@@ -469,7 +312,7 @@ GDALDatasetH GDALViewshedGenerate(
                             ? padfFirstLineVal[iPixel]
                             : 0.0;
         bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), nX - iPixel, 0, padfFirstLineVal[iPixel],
+            adfGeoTransform, nX - iPixel, 0, padfFirstLineVal[iPixel],
             dfDistance2, dfCurvCoeff, dfSphereDiameter);
         if (adjusted)
         {
@@ -500,7 +343,7 @@ GDALDatasetH GDALViewshedGenerate(
                             ? padfFirstLineVal[iPixel]
                             : 0.0;
         bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), iPixel - nX, 0, padfFirstLineVal[iPixel],
+            adfGeoTransform, iPixel - nX, 0, padfFirstLineVal[iPixel],
             dfDistance2, dfCurvCoeff, dfSphereDiameter);
         if (adjusted)
         {
@@ -526,40 +369,22 @@ GDALDatasetH GDALViewshedGenerate(
     }
     /* write result line */
 
-    if (GDALRasterIO(hTargetBand, GF_Write, 0, nY - nYStart, nXSize, 1,
-                     heightMode != GVOT_NORMAL
-                         ? static_cast<void *>(dfHeightResult)
-                         : static_cast<void *>(pabyResult),
-                     nXSize, 1,
-                     heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte, 0, 0))
-    {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "RasterIO error when writing target raster at position "
-                 "(%d,%d), size (%d,%d)",
-                 0, nY - nYStart, nXSize, 1);
-        return nullptr;
-    }
+    if (!writeLine(nY, pabyResult, dfHeightResult))
+        return false;
 
     /* scan upwards */
     std::copy(vFirstLineVal.begin(), vFirstLineVal.end(), vLastLineVal.begin());
     for (int iLine = nY - 1; iLine >= nYStart; iLine--)
     {
-        if (GDALRasterIO(hBand, GF_Read, nXStart, iLine, nXSize, 1,
-                         padfThisLineVal, nXSize, 1, GDT_Float64, 0, 0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when reading DEM at position (%d,%d), "
-                     "size (%d,%d)",
-                     nXStart, iLine, nXSize, 1);
-            return nullptr;
-        }
+        if (!readLine(iLine, padfThisLineVal))
+            return false;
 
         /* set up initial point on the scanline */
         dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
                             ? padfThisLineVal[nX]
                             : 0.0;
         bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), 0, nY - iLine, padfThisLineVal[nX],
+            adfGeoTransform, 0, nY - iLine, padfThisLineVal[nX],
             dfDistance2, dfCurvCoeff, dfSphereDiameter);
         if (adjusted)
         {
@@ -586,7 +411,7 @@ GDALDatasetH GDALViewshedGenerate(
                                 ? padfThisLineVal[iPixel]
                                 : 0.0;
             bool left_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), nX - iPixel,
+                AdjustHeightInRange(adfGeoTransform, nX - iPixel,
                                     nY - iLine, padfThisLineVal[iPixel],
                                     dfDistance2, dfCurvCoeff, dfSphereDiameter);
             if (left_adjusted)
@@ -635,7 +460,7 @@ GDALDatasetH GDALViewshedGenerate(
                                 ? padfThisLineVal[iPixel]
                                 : 0.0;
             bool right_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), iPixel - nX,
+                AdjustHeightInRange(adfGeoTransform, iPixel - nX,
                                     nY - iLine, padfThisLineVal[iPixel],
                                     dfDistance2, dfCurvCoeff, dfSphereDiameter);
             if (right_adjusted)
@@ -679,19 +504,8 @@ GDALDatasetH GDALViewshedGenerate(
         }
 
         /* write result line */
-        if (GDALRasterIO(
-                hTargetBand, GF_Write, 0, iLine - nYStart, nXSize, 1,
-                heightMode != GVOT_NORMAL ? static_cast<void *>(dfHeightResult)
-                                          : static_cast<void *>(pabyResult),
-                nXSize, 1, heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte,
-                0, 0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when writing target raster at position "
-                     "(%d,%d), size (%d,%d)",
-                     0, iLine - nYStart, nXSize, 1);
-            return nullptr;
-        }
+        if (!writeLine(iLine, pabyResult, dfHeightResult))
+            return false;
 
         std::swap(padfLastLineVal, padfThisLineVal);
 
@@ -699,30 +513,22 @@ GDALDatasetH GDALViewshedGenerate(
                          pProgressArg))
         {
             CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            return nullptr;
+            return false;
         }
     }
     /* scan downwards */
     memcpy(padfLastLineVal, padfFirstLineVal, nXSize * sizeof(double));
     for (int iLine = nY + 1; iLine < nYStop; iLine++)
     {
-        if (GDALRasterIO(hBand, GF_Read, nXStart, iLine, nXStop - nXStart, 1,
-                         padfThisLineVal, nXStop - nXStart, 1, GDT_Float64, 0,
-                         0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when reading DEM at position (%d,%d), "
-                     "size (%d,%d)",
-                     nXStart, iLine, nXStop - nXStart, 1);
-            return nullptr;
-        }
+        if (!readLine(iLine, padfThisLineVal))
+            return false;
 
         /* set up initial point on the scanline */
         dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
                             ? padfThisLineVal[nX]
                             : 0.0;
         bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), 0, iLine - nY, padfThisLineVal[nX],
+            adfGeoTransform, 0, iLine - nY, padfThisLineVal[nX],
             dfDistance2, dfCurvCoeff, dfSphereDiameter);
         if (adjusted)
         {
@@ -749,7 +555,7 @@ GDALDatasetH GDALViewshedGenerate(
                                 ? padfThisLineVal[iPixel]
                                 : 0.0;
             bool left_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), nX - iPixel,
+                AdjustHeightInRange(adfGeoTransform, nX - iPixel,
                                     iLine - nY, padfThisLineVal[iPixel],
                                     dfDistance2, dfCurvCoeff, dfSphereDiameter);
             if (left_adjusted)
@@ -798,7 +604,7 @@ GDALDatasetH GDALViewshedGenerate(
                                 ? padfThisLineVal[iPixel]
                                 : 0.0;
             bool right_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), iPixel - nX,
+                AdjustHeightInRange(adfGeoTransform, iPixel - nX,
                                     iLine - nY, padfThisLineVal[iPixel],
                                     dfDistance2, dfCurvCoeff, dfSphereDiameter);
             if (right_adjusted)
@@ -842,28 +648,699 @@ GDALDatasetH GDALViewshedGenerate(
         }
 
         /* write result line */
-        if (GDALRasterIO(
-                hTargetBand, GF_Write, 0, iLine - nYStart, nXSize, 1,
-                heightMode != GVOT_NORMAL ? static_cast<void *>(dfHeightResult)
-                                          : static_cast<void *>(pabyResult),
-                nXSize, 1, heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte,
-                0, 0))
+        if (!writeLine(iLine, pabyResult, dfHeightResult))
+            return false;
+
+        std::swap(padfLastLineVal, padfThisLineVal);
+
+        if (!pfnProgress((iLine - nYStart) / static_cast<double>(nYSize), "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                        GDALViewshedGenerate()                         */
+/************************************************************************/
+
+/**
+ * Create viewshed from raster DEM.
+ *
+ * This algorithm will generate a viewshed raster from an input DEM raster
+ * by using a modified algorithm of "Generating Viewsheds without Using
+ * Sightlines" published at
+ * https://www.asprs.org/wp-content/uploads/pers/2000journal/january/2000_jan_87-90.pdf
+ * This appoach provides a relatively fast calculation, since the output raster
+ * is generated in a single scan. The gdal/apps/gdal_viewshed.cpp mainline can
+ * be used as an example of how to use this function. The output raster will be
+ * of type Byte or Float64.
+ *
+ * \note The algorithm as implemented currently will only output meaningful
+ * results if the georeferencing is in a projected coordinate reference system.
+ *
+ * @param hBand The band to read the DEM data from. Only the part of the raster
+ * within the specified maxdistance around the observer point is processed.
+ *
+ * @param pszDriverName Driver name (GTiff if set to NULL)
+ *
+ * @param pszTargetRasterName The name of the target raster to be generated.
+ * Must not be NULL
+ *
+ * @param papszCreationOptions creation options.
+ *
+ * @param dfObserverX observer X value (in SRS units)
+ *
+ * @param dfObserverY observer Y value (in SRS units)
+ *
+ * @param dfObserverHeight The height of the observer above the DEM surface.
+ *
+ * @param dfTargetHeight The height of the target above the DEM surface.
+ * (default 0)
+ *
+ * @param dfVisibleVal pixel value for visibility (default 255)
+ *
+ * @param dfInvisibleVal pixel value for invisibility (default 0)
+ *
+ * @param dfOutOfRangeVal The value to be set for the cells that fall outside of
+ * the range specified by dfMaxDistance.
+ *
+ * @param dfNoDataVal The value to be set for the cells that have no data.
+ *                    If set to a negative value, nodata is not set.
+ *                    Note: currently, no special processing of input cells at a
+ * nodata value is done (which may result in erroneous results).
+ *
+ * @param dfCurvCoeff Coefficient to consider the effect of the curvature and
+ * refraction. The height of the DEM is corrected according to the following
+ * formula: [Height] -= dfCurvCoeff * [Target Distance]^2 / [Earth Diameter] For
+ * the effect of the atmospheric refraction we can use 0.85714.
+ *
+ * @param eMode The mode of the viewshed calculation.
+ * Possible values GVM_Diagonal = 1, GVM_Edge = 2 (default), GVM_Max = 3,
+ * GVM_Min = 4.
+ *
+ * @param dfMaxDistance maximum distance range to compute viewshed.
+ *                      It is also used to clamp the extent of the output
+ * raster. If set to 0, then unlimited range is assumed, that is to say the
+ *                      computation is performed on the extent of the whole
+ * raster.
+ *
+ * @param pfnProgress A GDALProgressFunc that may be used to report progress
+ * to the user, or to interrupt the algorithm.  May be NULL if not required.
+ *
+ * @param pProgressArg The callback data for the pfnProgress function.
+ *
+ * @param heightMode Type of information contained in output raster. Possible
+ * values GVOT_NORMAL = 1 (default), GVOT_MIN_TARGET_HEIGHT_FROM_DEM = 2,
+ *                   GVOT_MIN_TARGET_HEIGHT_FROM_GROUND = 3
+ *
+ *                   GVOT_NORMAL returns a raster of type Byte containing
+ * visible locations.
+ *
+ *                   GVOT_MIN_TARGET_HEIGHT_FROM_DEM and
+ * GVOT_MIN_TARGET_HEIGHT_FROM_GROUND will return a raster of type Float64
+ * containing the minimum target height for target to be visible from the DEM
+ * surface or ground level respectively. Parameters dfTargetHeight, dfVisibleVal
+ * and dfInvisibleVal will be ignored.
+ *
+ *
+ * @param papszExtraOptions Future extra options. Must be set to NULL currently.
+ *
+ * @return not NULL output dataset on success (to be closed with GDALClose()) or
+ * NULL if an error occurs.
+ *
+ * @since GDAL 3.1
+ */
+
+GDALDatasetH GDALViewshedGenerate(
+    GDALRasterBandH hBand, const char *pszDriverName,
+    const char *pszTargetRasterName, CSLConstList papszCreationOptions,
+    double dfObserverX, double dfObserverY, double dfObserverHeight,
+    double dfTargetHeight, double dfVisibleVal, double dfInvisibleVal,
+    double dfOutOfRangeVal, double dfNoDataVal, double dfCurvCoeff,
+    GDALViewshedMode eMode, double dfMaxDistance, GDALProgressFunc pfnProgress,
+    void *pProgressArg, GDALViewshedOutputType heightMode,
+    CSLConstList papszExtraOptions)
+
+{
+    VALIDATE_POINTER1(hBand, "GDALViewshedGenerate", nullptr);
+    VALIDATE_POINTER1(pszTargetRasterName, "GDALViewshedGenerate", nullptr);
+
+    CPL_IGNORE_RET_VAL(papszExtraOptions);
+
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    if (!pfnProgress(0.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
+
+    const GByte byNoDataVal = dfNoDataVal >= 0 && dfNoDataVal <= 255
+                                  ? static_cast<GByte>(dfNoDataVal)
+                                  : 0;
+    const GByte byVisibleVal = dfVisibleVal >= 0 && dfVisibleVal <= 255
+                                   ? static_cast<GByte>(dfVisibleVal)
+                                   : 255;
+    const GByte byInvisibleVal = dfInvisibleVal >= 0 && dfInvisibleVal <= 255
+                                     ? static_cast<GByte>(dfInvisibleVal)
+                                     : 0;
+    const GByte byOutOfRangeVal = dfOutOfRangeVal >= 0 && dfOutOfRangeVal <= 255
+                                      ? static_cast<GByte>(dfOutOfRangeVal)
+                                      : 0;
+
+    if (heightMode != GVOT_MIN_TARGET_HEIGHT_FROM_DEM &&
+        heightMode != GVOT_MIN_TARGET_HEIGHT_FROM_GROUND)
+        heightMode = GVOT_NORMAL;
+
+    /* set up geotransformation */
+    std::array<double, 6> adfGeoTransform{{0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
+    GDALDatasetH hSrcDS = GDALGetBandDataset(hBand);
+    if (hSrcDS != nullptr)
+        GDALGetGeoTransform(hSrcDS, adfGeoTransform.data());
+
+    double adfInvGeoTransform[6];
+    if (!GDALInvGeoTransform(adfGeoTransform.data(), adfInvGeoTransform))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot invert geotransform");
+        return nullptr;
+    }
+
+    /* calculate observer position */
+    double dfX, dfY;
+    GDALApplyGeoTransform(adfInvGeoTransform, dfObserverX, dfObserverY, &dfX,
+                          &dfY);
+    int nX = static_cast<int>(dfX);
+    int nY = static_cast<int>(dfY);
+
+    int nXSize = GDALGetRasterBandXSize(hBand);
+    int nYSize = GDALGetRasterBandYSize(hBand);
+
+    if (nX < 0 || nX > nXSize || nY < 0 || nY > nYSize)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "The observer location falls outside of the DEM area");
+        return nullptr;
+    }
+
+    /* calculate the area of interest */
+    int nXStart = 0;
+    int nXStop = 0;
+    int nYStart = 0;
+    int nYStop = 0;
+    GetViewshedWindow(adfInvGeoTransform, nX, nY, nXSize, nYSize, dfMaxDistance,
+                      nXStart, nXStop, nYStart, nYStop);
+
+    /* normalize horizontal index (0 - nXSize) */
+    nXSize = nXStop - nXStart;
+    nX -= nXStart;
+
+    nYSize = nYStop - nYStart;
+
+    if (nXSize == 0 || nYSize == 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Invalid target raster size");
+        return nullptr;
+    }
+
+    GDALDriverManager *hMgr = GetGDALDriverManager();
+    GDALDriver *hDriver =
+        hMgr->GetDriverByName(pszDriverName ? pszDriverName : "GTiff");
+    if (!hDriver)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get driver");
+        return nullptr;
+    }
+
+    /* create output raster */
+    auto poDstDS = std::unique_ptr<GDALDataset>(
+        hDriver->Create(pszTargetRasterName, nXSize, nYStop - nYStart, 1,
+                        heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte,
+                        const_cast<char **>(papszCreationOptions)));
+    if (!poDstDS)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create dataset for %s",
+                 pszTargetRasterName);
+        return nullptr;
+    }
+    /* copy srs */
+    if (hSrcDS)
+        poDstDS->SetSpatialRef(
+            GDALDataset::FromHandle(hSrcDS)->GetSpatialRef());
+
+    std::array<double, 6> adfDstGeoTransform;
+    adfDstGeoTransform[0] = adfGeoTransform[0] + adfGeoTransform[1] * nXStart +
+                            adfGeoTransform[2] * nYStart;
+    adfDstGeoTransform[1] = adfGeoTransform[1];
+    adfDstGeoTransform[2] = adfGeoTransform[2];
+    adfDstGeoTransform[3] = adfGeoTransform[3] + adfGeoTransform[4] * nXStart +
+                            adfGeoTransform[5] * nYStart;
+    adfDstGeoTransform[4] = adfGeoTransform[4];
+    adfDstGeoTransform[5] = adfGeoTransform[5];
+    poDstDS->SetGeoTransform(adfDstGeoTransform.data());
+
+    auto hTargetBand = poDstDS->GetRasterBand(1);
+    if (hTargetBand == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get band for %s",
+                 pszTargetRasterName);
+        return nullptr;
+    }
+
+    if (dfNoDataVal >= 0)
+        GDALSetRasterNoDataValue(
+            hTargetBand, heightMode != GVOT_NORMAL ? dfNoDataVal : byNoDataVal);
+
+    GDALViewshedParams sParams;
+    sParams.adfGeoTransform = adfGeoTransform.data();
+    sParams.dfObserverHeight = dfObserverHeight;
+    sParams.dfTargetHeight = dfTargetHeight;
+    sParams.dfMaxDistance = dfMaxDistance;
+    sParams.dfCurvCoeff = dfCurvCoeff;
+    sParams.dfSphereDiameter =
+        GetViewshedSphereDiameter(poDstDS->GetSpatialRef());
+    sParams.eMode = eMode;
+    sParams.heightMode = heightMode;
+    sParams.byVisibleVal = byVisibleVal;
+    sParams.byInvisibleVal = byInvisibleVal;
+    sParams.byOutOfRangeVal = byOutOfRangeVal;
+    sParams.dfOutOfRangeVal = dfOutOfRangeVal;
+
+    const auto readLine = [hBand, nXStart, nXSize](int iLine, double *padfLine)
+    {
+        if (GDALRasterIO(hBand, GF_Read, nXStart, iLine, nXSize, 1, padfLine,
+                         nXSize, 1, GDT_Float64, 0, 0))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "RasterIO error when reading DEM at position (%d,%d), "
+                     "size (%d,%d)",
+                     nXStart, iLine, nXSize, 1);
+            return false;
+        }
+        return true;
+    };
+
+    const auto writeLine = [hTargetBand, nYStart, nXSize,
+                            heightMode](int iLine, GByte *pabyResult,
+                                        double *padfHeightResult)
+    {
+        if (GDALRasterIO(hTargetBand, GF_Write, 0, iLine - nYStart, nXSize, 1,
+                         heightMode != GVOT_NORMAL
+                             ? static_cast<void *>(padfHeightResult)
+                             : static_cast<void *>(pabyResult),
+                         nXSize, 1,
+                         heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte, 0,
+                         0))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
                      "RasterIO error when writing target raster at position "
                      "(%d,%d), size (%d,%d)",
                      0, iLine - nYStart, nXSize, 1);
-            return nullptr;
+            return false;
         }
+        return true;
+    };
 
-        std::swap(padfLastLineVal, padfThisLineVal);
+    if (!ViewshedScan(sParams, nXSize, nX, nY, nYStart, nYStop, readLine,
+                      writeLine, pfnProgress, pProgressArg))
+        return nullptr;
 
-        if (!pfnProgress((iLine - nYStart) / static_cast<double>(nYSize), "",
-                         pProgressArg))
+    if (!pfnProgress(1.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
+
+    return GDALDataset::FromHandle(poDstDS.release());
+}
+
+/************************************************************************/
+/*                     ViewshedCumulativeJobFunc()                      */
+/************************************************************************/
+
+namespace
+{
+// State shared by the jobs of GDALViewshedGenerateCumulative().
+struct ViewshedCumulativeContext
+{
+    GDALViewshedParams sParams{};
+    int nXSize = 0;
+    std::vector<double> adfDEM{};
+    std::vector<GUInt32> anCount{};
+    std::mutex oMutex{};
+    bool bError = false;
+};
+
+// Viewshed of one observer, on its window of the shared DEM.
+struct ViewshedCumulativeJob
+{
+    ViewshedCumulativeContext *psContext = nullptr;
+    int nXOff = 0;
+    int nXSize = 0;
+    int nX = 0;
+    int nY = 0;
+    int nYStart = 0;
+    int nYStop = 0;
+};
+}  // namespace
+
+static void ViewshedCumulativeJobFunc(void *pData)
+{
+    const auto psJob = static_cast<const ViewshedCumulativeJob *>(pData);
+    ViewshedCumulativeContext *psContext = psJob->psContext;
+    const int nXSize = psJob->nXSize;
+    const int nYStart = psJob->nYStart;
+
+    std::vector<GByte> abyVisible;
+    try
+    {
+        abyVisible.resize(static_cast<size_t>(nXSize) *
+                          (psJob->nYStop - nYStart));
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate vectors for viewshed");
+        std::lock_guard<std::mutex> oLock(psContext->oMutex);
+        psContext->bError = true;
+        return;
+    }
+
+    const auto readLine = [psContext, psJob](int iLine, double *padfLine)
+    {
+        memcpy(padfLine,
+               psContext->adfDEM.data() +
+                   static_cast<size_t>(iLine) * psContext->nXSize +
+                   psJob->nXOff,
+               psJob->nXSize * sizeof(double));
+        return true;
+    };
+
+    const auto writeLine = [&abyVisible, nXSize, nYStart](
+                               int iLine, GByte *pabyResult, double *)
+    {
+        memcpy(abyVisible.data() +
+                   static_cast<size_t>(iLine - nYStart) * nXSize,
+               pabyResult, nXSize);
+        return true;
+    };
+
+    const bool bOK =
+        ViewshedScan(psContext->sParams, nXSize, psJob->nX, psJob->nY, nYStart,
+                     psJob->nYStop, readLine, writeLine, GDALDummyProgress,
+                     nullptr);
+
+    std::lock_guard<std::mutex> oLock(psContext->oMutex);
+    if (!bOK)
+    {
+        psContext->bError = true;
+        return;
+    }
+    for (int iLine = nYStart; iLine < psJob->nYStop; iLine++)
+    {
+        const GByte *pabyLine =
+            abyVisible.data() + static_cast<size_t>(iLine - nYStart) * nXSize;
+        GUInt32 *panCount = psContext->anCount.data() +
+                            static_cast<size_t>(iLine) * psContext->nXSize +
+                            psJob->nXOff;
+        for (int i = 0; i < nXSize; i++)
+            panCount[i] += pabyLine[i];
+    }
+}
+
+/************************************************************************/
+/*                   GDALViewshedGenerateCumulative()                   */
+/************************************************************************/
+
+/**
+ * Create cumulative viewshed from raster DEM.
+ *
+ * This computes the viewshed of each of several observers, with the same
+ * algorithm as GDALViewshedGenerate(), and generates a UInt32 raster counting
+ * for each cell the number of observers from which it is visible.
+ *
+ * The part of the DEM that is within dfMaxDistance of at least one observer is
+ * read once in memory (as Float64 values), and shared by all observers, whose
+ * viewsheds may be computed in parallel. The output raster covers that part of
+ * the DEM.
+ *
+ * @param hBand The band to read the DEM data from.
+ *
+ * @param pszDriverName Driver name (GTiff if set to NULL)
+ *
+ * @param pszTargetRasterName The name of the target raster to be generated.
+ * Must not be NULL
+ *
+ * @param papszCreationOptions creation options.
+ *
+ * @param nObserverCount number of observers.
+ *
+ * @param padfObserverX observer X values (in SRS units), nObserverCount values.
+ *
+ * @param padfObserverY observer Y values (in SRS units), nObserverCount values.
+ *
+ * @param dfObserverHeight The height of the observers above the DEM surface.
+ *
+ * @param dfTargetHeight The height of the target above the DEM surface.
+ *
+ * @param dfCurvCoeff Coefficient to consider the effect of the curvature and
+ * refraction. See GDALViewshedGenerate().
+ *
+ * @param eMode The mode of the viewshed calculation.
+ * Possible values GVM_Diagonal = 1, GVM_Edge = 2, GVM_Max = 3, GVM_Min = 4.
+ *
+ * @param dfMaxDistance maximum distance range to compute viewsheds.
+ * If set to 0, then unlimited range is assumed.
+ *
+ * @param pfnProgress A GDALProgressFunc that may be used to report progress
+ * to the user, or to interrupt the algorithm.  May be NULL if not required.
+ *
+ * @param pProgressArg The callback data for the pfnProgress function.
+ *
+ * @param papszOptions NULL terminated list of options, or NULL:
+ * <ul>
+ * <li>NUM_THREADS=n/ALL_CPUS: number of threads computing viewsheds.
+ * Defaults to the GDAL_NUM_THREADS configuration option, or 1.</li>
+ * </ul>
+ *
+ * @return not NULL output dataset on success (to be closed with GDALClose()) or
+ * NULL if an error occurs.
+ *
+ * @since GDAL 3.9
+ */
+
+GDALDatasetH GDALViewshedGenerateCumulative(
+    GDALRasterBandH hBand, const char *pszDriverName,
+    const char *pszTargetRasterName, CSLConstList papszCreationOptions,
+    int nObserverCount, const double *padfObserverX,
+    const double *padfObserverY, double dfObserverHeight,
+    double dfTargetHeight, double dfCurvCoeff, GDALViewshedMode eMode,
+    double dfMaxDistance, GDALProgressFunc pfnProgress, void *pProgressArg,
+    CSLConstList papszOptions)
+
+{
+    VALIDATE_POINTER1(hBand, "GDALViewshedGenerateCumulative", nullptr);
+    VALIDATE_POINTER1(pszTargetRasterName, "GDALViewshedGenerateCumulative",
+                      nullptr);
+
+    if (nObserverCount <= 0 || padfObserverX == nullptr ||
+        padfObserverY == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "No observer");
+        return nullptr;
+    }
+
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    if (!pfnProgress(0.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
+
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads == nullptr)
+        pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads =
+        std::max(1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                                      ? CPLGetNumCPUs()
+                                      : atoi(pszNumThreads)));
+
+    /* set up geotransformation */
+    std::array<double, 6> adfGeoTransform{{0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
+    GDALDatasetH hSrcDS = GDALGetBandDataset(hBand);
+    if (hSrcDS != nullptr)
+        GDALGetGeoTransform(hSrcDS, adfGeoTransform.data());
+
+    double adfInvGeoTransform[6];
+    if (!GDALInvGeoTransform(adfGeoTransform.data(), adfInvGeoTransform))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot invert geotransform");
+        return nullptr;
+    }
+
+    const int nRasterXSize = GDALGetRasterBandXSize(hBand);
+    const int nRasterYSize = GDALGetRasterBandYSize(hBand);
+
+    /* calculate the observer positions, and the union of their areas of
+     * interest */
+    std::vector<ViewshedCumulativeJob> asJobs(nObserverCount);
+    int nXStart = nRasterXSize;
+    int nXStop = 0;
+    int nYStart = nRasterYSize;
+    int nYStop = 0;
+    for (int i = 0; i < nObserverCount; i++)
+    {
+        double dfX, dfY;
+        GDALApplyGeoTransform(adfInvGeoTransform, padfObserverX[i],
+                              padfObserverY[i], &dfX, &dfY);
+        if (!(dfX >= 0 && dfX < nRasterXSize && dfY >= 0 &&
+              dfY < nRasterYSize))
         {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "The location of observer %d falls outside of the DEM "
+                     "area",
+                     i + 1);
             return nullptr;
         }
+        ViewshedCumulativeJob &sJob = asJobs[i];
+        sJob.nX = static_cast<int>(dfX);
+        sJob.nY = static_cast<int>(dfY);
+        int nObsXStop = 0;
+        GetViewshedWindow(adfInvGeoTransform, sJob.nX, sJob.nY, nRasterXSize,
+                          nRasterYSize, dfMaxDistance, sJob.nXOff, nObsXStop,
+                          sJob.nYStart, sJob.nYStop);
+        sJob.nXSize = nObsXStop - sJob.nXOff;
+        if (sJob.nXSize <= 0 || sJob.nYStop <= sJob.nYStart)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Invalid target raster size");
+            return nullptr;
+        }
+        nXStart = std::min(nXStart, sJob.nXOff);
+        nXStop = std::max(nXStop, nObsXStop);
+        nYStart = std::min(nYStart, sJob.nYStart);
+        nYStop = std::max(nYStop, sJob.nYStop);
+    }
+    const int nXSize = nXStop - nXStart;
+    const int nYSize = nYStop - nYStart;
+
+    /* read the DEM once */
+    ViewshedCumulativeContext sContext;
+    sContext.nXSize = nXSize;
+    try
+    {
+        sContext.adfDEM.resize(static_cast<size_t>(nXSize) * nYSize);
+        sContext.anCount.resize(static_cast<size_t>(nXSize) * nYSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate %d x %d DEM for cumulative viewshed", nXSize,
+                 nYSize);
+        return nullptr;
+    }
+
+    GDALDriver *hDriver = GetGDALDriverManager()->GetDriverByName(
+        pszDriverName ? pszDriverName : "GTiff");
+    if (!hDriver)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get driver");
+        return nullptr;
+    }
+
+    /* create output raster */
+    auto poDstDS = std::unique_ptr<GDALDataset>(hDriver->Create(
+        pszTargetRasterName, nXSize, nYSize, 1, GDT_UInt32,
+        const_cast<char **>(papszCreationOptions)));
+    if (!poDstDS)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create dataset for %s",
+                 pszTargetRasterName);
+        return nullptr;
+    }
+    /* copy srs */
+    if (hSrcDS)
+        poDstDS->SetSpatialRef(
+            GDALDataset::FromHandle(hSrcDS)->GetSpatialRef());
+
+    std::array<double, 6> adfDstGeoTransform = adfGeoTransform;
+    adfDstGeoTransform[0] = adfGeoTransform[0] + adfGeoTransform[1] * nXStart +
+                            adfGeoTransform[2] * nYStart;
+    adfDstGeoTransform[3] = adfGeoTransform[3] + adfGeoTransform[4] * nXStart +
+                            adfGeoTransform[5] * nYStart;
+    poDstDS->SetGeoTransform(adfDstGeoTransform.data());
+
+    if (GDALRasterIO(hBand, GF_Read, nXStart, nYStart, nXSize, nYSize,
+                     sContext.adfDEM.data(), nXSize, nYSize, GDT_Float64, 0,
+                     0) != CE_None)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "RasterIO error when reading DEM at position (%d,%d), "
+                 "size (%d,%d)",
+                 nXStart, nYStart, nXSize, nYSize);
+        return nullptr;
+    }
+
+    GDALViewshedParams &sParams = sContext.sParams;
+    sParams.adfGeoTransform = adfGeoTransform.data();
+    sParams.dfObserverHeight = dfObserverHeight;
+    sParams.dfTargetHeight = dfTargetHeight;
+    sParams.dfMaxDistance = dfMaxDistance;
+    sParams.dfCurvCoeff = dfCurvCoeff;
+    sParams.dfSphereDiameter =
+        GetViewshedSphereDiameter(poDstDS->GetSpatialRef());
+    sParams.eMode = eMode;
+    sParams.heightMode = GVOT_NORMAL;
+    sParams.byVisibleVal = 1;
+    sParams.byInvisibleVal = 0;
+    sParams.byOutOfRangeVal = 0;
+
+    /* compute the viewsheds of observers, in the union window */
+    auto poPool = nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    for (auto &sJob : asJobs)
+    {
+        sJob.psContext = &sContext;
+        sJob.nX -= sJob.nXOff;
+        sJob.nXOff -= nXStart;
+        sJob.nY -= nYStart;
+        sJob.nYStart -= nYStart;
+        sJob.nYStop -= nYStart;
+    }
+
+    bool bUserTerminated = false;
+    for (int i = 0; i < nObserverCount && !bUserTerminated; i++)
+    {
+        if (poQueue)
+        {
+            poQueue->SubmitJob(ViewshedCumulativeJobFunc, &asJobs[i]);
+            continue;
+        }
+        ViewshedCumulativeJobFunc(&asJobs[i]);
+        bUserTerminated = !pfnProgress((i + 1) / static_cast<double>(
+                                                     nObserverCount + 1),
+                                       "", pProgressArg);
+    }
+    if (poQueue)
+    {
+        for (int nRemaining = nObserverCount - 1; nRemaining >= 0;
+             nRemaining--)
+        {
+            poQueue->WaitCompletion(nRemaining);
+            if (!bUserTerminated &&
+                !pfnProgress((nObserverCount - nRemaining) /
+                                 static_cast<double>(nObserverCount + 1),
+                             "", pProgressArg))
+            {
+                // Remaining jobs still have to complete, as they use
+                // sContext.
+                bUserTerminated = true;
+            }
+        }
+    }
+    if (bUserTerminated)
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
+    if (sContext.bError)
+        return nullptr;
+
+    /* write result */
+    if (GDALRasterIO(GDALRasterBand::ToHandle(poDstDS->GetRasterBand(1)),
+                     GF_Write, 0, 0, nXSize, nYSize,
+                     sContext.anCount.data(), nXSize, nYSize, GDT_UInt32, 0,
+                     0) != CE_None)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "RasterIO error when writing target raster");
+        return nullptr;
     }
 
     if (!pfnProgress(1.0, "", pProgressArg))
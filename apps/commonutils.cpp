@@ -28,14 +28,20 @@
 
 #include "commonutils.h"
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <mutex>
 
 #include <string>
 
 #include "cpl_conv.h"
+#include "cpl_error_internal.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 
 /* -------------------------------------------------------------------- */
 /*                   DoesDriverHandleExtension()                        */
@@ -275,3 +281,184 @@ int ArgIsNumeric(const char *pszArg)
 {
     return CPLGetValueType(pszArg) != CPL_VALUE_STRING;
 }
+
+/************************************************************************/
+/*                      GDALDatasetOpenPrefetcher                       */
+/************************************************************************/
+
+struct GDALDatasetOpenPrefetcher::Private
+{
+    struct Slot
+    {
+        Private *poPrivate = nullptr;
+        std::string osFilename{};
+        GDALDatasetH hDS = nullptr;
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+        bool bSubmitted = false;
+        bool bReady = false;
+    };
+
+    unsigned int nOpenFlags = 0;
+    CPLStringList aosOpenOptions{};
+    std::vector<Slot> asSlots{};
+    size_t nSubmitted = 0;
+    size_t nWindow = 0;
+    std::unique_ptr<CPLJobQueue> poQueue{};
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+
+    static void OpenFunc(void *pData);
+    void SubmitUpTo(size_t nCount);
+};
+
+/************************************************************************/
+/*                              OpenFunc()                              */
+/************************************************************************/
+
+void GDALDatasetOpenPrefetcher::Private::OpenFunc(void *pData)
+{
+    Slot *psSlot = static_cast<Slot *>(pData);
+    Private *poPrivate = psSlot->poPrivate;
+
+    CPLInstallErrorHandlerAccumulator(psSlot->aoErrors);
+    GDALDatasetH hDS =
+        GDALOpenEx(psSlot->osFilename.c_str(), poPrivate->nOpenFlags, nullptr,
+                   poPrivate->aosOpenOptions.List(), nullptr);
+    if (hDS)
+    {
+        // Read metadata that drivers may load lazily
+        double adfGeoTransform[6];
+        CPL_IGNORE_RET_VAL(GDALGetGeoTransform(hDS, adfGeoTransform));
+        CPL_IGNORE_RET_VAL(GDALGetSpatialRef(hDS));
+        if (GDALGetRasterCount(hDS) > 0)
+        {
+            GDALRasterBandH hBand = GDALGetRasterBand(hDS, 1);
+            CPL_IGNORE_RET_VAL(GDALGetMaskFlags(hBand));
+            CPL_IGNORE_RET_VAL(GDALGetOverviewCount(hBand));
+        }
+    }
+    CPLUninstallErrorHandlerAccumulator();
+
+    std::lock_guard<std::mutex> oLock(poPrivate->oMutex);
+    psSlot->hDS = hDS;
+    psSlot->bReady = true;
+    poPrivate->oCV.notify_all();
+}
+
+/************************************************************************/
+/*                             SubmitUpTo()                             */
+/************************************************************************/
+
+void GDALDatasetOpenPrefetcher::Private::SubmitUpTo(size_t nCount)
+{
+    nCount = std::min(nCount, asSlots.size());
+    for (; nSubmitted < nCount; ++nSubmitted)
+    {
+        Slot &sSlot = asSlots[nSubmitted];
+        sSlot.bSubmitted = poQueue && poQueue->SubmitJob(OpenFunc, &sSlot);
+    }
+}
+
+/************************************************************************/
+/*                      GDALDatasetOpenPrefetcher()                     */
+/************************************************************************/
+
+/** Constructor.
+ *
+ * @param aosFilenames Names of the datasets to open.
+ * @param nOpenFlags Flags passed to GDALOpenEx().
+ * @param papszOpenOptions Open options passed to GDALOpenEx(), or nullptr.
+ * @param nThreads Number of datasets opened concurrently.
+ */
+GDALDatasetOpenPrefetcher::GDALDatasetOpenPrefetcher(
+    const std::vector<std::string> &aosFilenames, unsigned int nOpenFlags,
+    CSLConstList papszOpenOptions, int nThreads)
+    : m_poPrivate(std::make_unique<Private>())
+{
+    m_poPrivate->nOpenFlags = nOpenFlags;
+    m_poPrivate->aosOpenOptions = CSLDuplicate(papszOpenOptions);
+    m_poPrivate->asSlots.resize(aosFilenames.size());
+    for (size_t i = 0; i < aosFilenames.size(); ++i)
+    {
+        m_poPrivate->asSlots[i].poPrivate = m_poPrivate.get();
+        m_poPrivate->asSlots[i].osFilename = aosFilenames[i];
+    }
+
+    // Do not open too many datasets ahead of their use, as they keep
+    // file handles and memory.
+    m_poPrivate->nWindow = 2 * static_cast<size_t>(std::max(1, nThreads));
+    auto poThreadPool = GDALGetGlobalThreadPool(std::max(1, nThreads));
+    if (poThreadPool)
+        m_poPrivate->poQueue = poThreadPool->CreateJobQueue();
+    m_poPrivate->SubmitUpTo(m_poPrivate->nWindow);
+}
+
+/************************************************************************/
+/*                     ~GDALDatasetOpenPrefetcher()                     */
+/************************************************************************/
+
+/** Destructor. Closes the datasets that have not been retrieved. */
+GDALDatasetOpenPrefetcher::~GDALDatasetOpenPrefetcher()
+{
+    if (m_poPrivate->poQueue)
+        m_poPrivate->poQueue->WaitCompletion();
+    for (auto &sSlot : m_poPrivate->asSlots)
+    {
+        if (sSlot.hDS)
+            GDALClose(sSlot.hDS);
+    }
+}
+
+/************************************************************************/
+/*                                 Get()                                */
+/************************************************************************/
+
+/** Returns the dataset of index iDataset, or nullptr if it cannot be opened.
+ *
+ * Ownership of the dataset is transferred to the caller.
+ * This method must be called with increasing values of iDataset.
+ */
+GDALDatasetH GDALDatasetOpenPrefetcher::Get(size_t iDataset)
+{
+    if (iDataset >= m_poPrivate->asSlots.size())
+        return nullptr;
+    m_poPrivate->SubmitUpTo(iDataset + 1 + m_poPrivate->nWindow);
+
+    auto &sSlot = m_poPrivate->asSlots[iDataset];
+    if (!sSlot.bSubmitted)
+    {
+        // Could not be submitted to the thread pool: open it in this thread
+        return GDALOpenEx(sSlot.osFilename.c_str(), m_poPrivate->nOpenFlags,
+                          nullptr, m_poPrivate->aosOpenOptions.List(), nullptr);
+    }
+
+    GDALDatasetH hDS = nullptr;
+    {
+        std::unique_lock<std::mutex> oLock(m_poPrivate->oMutex);
+        m_poPrivate->oCV.wait(oLock, [&sSlot] { return sSlot.bReady; });
+        hDS = sSlot.hDS;
+        sSlot.hDS = nullptr;
+    }
+    for (const auto &sError : sSlot.aoErrors)
+    {
+        CPLError(sError.type, sError.no, "%s", sError.msg.c_str());
+    }
+    sSlot.aoErrors.clear();
+    return hDS;
+}
+
+/************************************************************************/
+/*                           GetThreadCount()                           */
+/************************************************************************/
+
+/** Returns the number of threads that can be used to open datasets ahead,
+ * from the GDAL_NUM_THREADS configuration option.
+ */
+int GDALDatasetOpenPrefetcher::GetThreadCount()
+{
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads);
+    return std::max(1, std::min(nThreads, 128));
+}
@@ -91,6 +91,10 @@ CPL_C_END
 #ifdef __cplusplus
 
 #include "cpl_string.h"
+#include "gdal.h"
+
+#include <memory>
+#include <string>
 #include <vector>
 
 std::vector<CPLString> CPL_DLL GetOutputDriversFor(const char *pszDestFilename,
@@ -101,6 +105,33 @@ std::string GDALRemoveSQLComments(const std::string &osInput);
 
 int ArgIsNumeric(const char *pszArg);
 
+/** Opens datasets, and reads their main metadata, in the global thread pool
+ * ahead of their sequential use, to hide the latency of opening files (in
+ * particular network ones). Datasets must be retrieved with Get() in
+ * increasing index order, in a single thread. Errors emitted while opening a
+ * dataset are re-emitted by Get(), in the calling thread.
+ */
+class CPL_DLL GDALDatasetOpenPrefetcher
+{
+  public:
+    GDALDatasetOpenPrefetcher(const std::vector<std::string> &aosFilenames,
+                              unsigned int nOpenFlags,
+                              CSLConstList papszOpenOptions, int nThreads);
+    ~GDALDatasetOpenPrefetcher();
+
+    GDALDatasetH Get(size_t iDataset);
+
+    static int GetThreadCount();
+
+  private:
+    struct Private;
+    std::unique_ptr<Private> m_poPrivate;
+
+    GDALDatasetOpenPrefetcher(const GDALDatasetOpenPrefetcher &) = delete;
+    GDALDatasetOpenPrefetcher &
+    operator=(const GDALDatasetOpenPrefetcher &) = delete;
+};
+
 // those values shouldn't be changed, because overview levels >= 0 are meant
 // to be overview indices, and ovr_level < OVR_LEVEL_AUTO mean overview level
 // automatically selected minus (OVR_LEVEL_AUTO - ovr_level)
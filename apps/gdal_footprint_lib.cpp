@@ -37,6 +37,8 @@
 #include <cstring>
 #include <algorithm>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "commonutils.h"
@@ -44,9 +46,11 @@
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_mem.h"
@@ -561,6 +565,206 @@ class GeoTransformCoordinateTransformation final
     }
 };
 
+/************************************************************************/
+/*                       GDALFootprintStripBand                         */
+/************************************************************************/
+
+// Horizontal strip of a band, whose I/O are serialized by a mutex shared by
+// all the strips of the band, so that they can be polygonized in parallel.
+class GDALFootprintStripBand final : public GDALRasterBand
+{
+    GDALRasterBand *m_poSrcBand = nullptr;
+    int m_nYOff = 0;
+    std::mutex &m_oMutex;
+
+  public:
+    GDALFootprintStripBand(GDALRasterBand *poSrcBand, int nYOff, int nYSize,
+                           std::mutex &oMutex)
+        : m_poSrcBand(poSrcBand), m_nYOff(nYOff), m_oMutex(oMutex)
+    {
+        nRasterXSize = m_poSrcBand->GetXSize();
+        nRasterYSize = nYSize;
+        eDataType = m_poSrcBand->GetRasterDataType();
+        nBlockXSize = nRasterXSize;
+        nBlockYSize = 1;
+    }
+
+  protected:
+    CPLErr IReadBlock(int /* nBlockXOff */, int nBlockYOff,
+                      void *pData) override
+    {
+        GDALRasterIOExtraArg sExtraArg;
+        INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+        const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+        return IRasterIO(GF_Read, 0, nBlockYOff, nBlockXSize, 1, pData,
+                         nBlockXSize, 1, eDataType, nDTSize,
+                         static_cast<GSpacing>(nDTSize) * nBlockXSize,
+                         &sExtraArg);
+    }
+
+    CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize,
+                     int nYSize, void *pData, int nBufXSize, int nBufYSize,
+                     GDALDataType eBufType, GSpacing nPixelSpace,
+                     GSpacing nLineSpace,
+                     GDALRasterIOExtraArg *psExtraArg) override
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        return m_poSrcBand->RasterIO(eRWFlag, nXOff, m_nYOff + nYOff, nXSize,
+                                     nYSize, pData, nBufXSize, nBufYSize,
+                                     eBufType, nPixelSpace, nLineSpace,
+                                     psExtraArg);
+    }
+};
+
+/************************************************************************/
+/*                        RemoveCollinearPoints()                       */
+/************************************************************************/
+
+// Remove the intermediate points of the horizontal and vertical segments of
+// a closed ring.
+static void RemoveCollinearPoints(OGRLinearRing *poRing)
+{
+    const int nPoints = poRing->getNumPoints() - 1;
+    if (nPoints < 4)
+        return;
+    std::vector<OGRRawPoint> aoPoints;
+    for (int i = 0; i < nPoints; ++i)
+    {
+        const int iPrev = (i + nPoints - 1) % nPoints;
+        const int iNext = (i + 1) % nPoints;
+        const double dfX = poRing->getX(i);
+        const double dfY = poRing->getY(i);
+        if ((poRing->getX(iPrev) == dfX && dfX == poRing->getX(iNext)) ||
+            (poRing->getY(iPrev) == dfY && dfY == poRing->getY(iNext)))
+        {
+            continue;
+        }
+        aoPoints.emplace_back(dfX, dfY);
+    }
+    if (aoPoints.size() < 3)
+        return;
+    aoPoints.push_back(aoPoints[0]);
+    poRing->setPoints(static_cast<int>(aoPoints.size()), aoPoints.data());
+}
+
+/************************************************************************/
+/*                 GDALFootprintPolygonizeMultiThreaded()               */
+/************************************************************************/
+
+namespace
+{
+// Horizontal strip of the mask band, polygonized by a job of
+// GDALFootprintPolygonizeMultiThreaded().
+struct GDALFootprintStrip
+{
+    std::unique_ptr<GDALFootprintStripBand> poBand{};
+    std::unique_ptr<OGRMemLayer> poLayer{};
+    int nYOff = 0;
+    CPLErr eErr = CE_None;
+};
+}  // namespace
+
+static void GDALFootprintPolygonizeStripJobFunc(void *pData)
+{
+    auto psStrip = static_cast<GDALFootprintStrip *>(pData);
+    auto hBand = GDALRasterBand::ToHandle(psStrip->poBand.get());
+    psStrip->eErr =
+        GDALPolygonize(hBand, hBand, OGRLayer::ToHandle(psStrip->poLayer.get()),
+                       /* iPixValField = */ -1,
+                       /* papszOptions = */ nullptr, nullptr, nullptr);
+}
+
+// Polygonize the mask band by horizontal strips processed in parallel, and
+// union the polygons of the strips into poMemLayer.
+static bool GDALFootprintPolygonizeMultiThreaded(
+    GDALRasterBand *poMaskBand, OGRMemLayer *poMemLayer, int nStrips,
+    const GDALFootprintOptions *psOptions)
+{
+    const int nYSize = poMaskBand->GetYSize();
+    std::mutex oMutex;
+    std::vector<GDALFootprintStrip> asStrips(nStrips);
+    for (int iStrip = 0; iStrip < nStrips; ++iStrip)
+    {
+        auto &sStrip = asStrips[iStrip];
+        sStrip.nYOff =
+            static_cast<int>(static_cast<GIntBig>(nYSize) * iStrip / nStrips);
+        const int nStripYSize =
+            static_cast<int>(static_cast<GIntBig>(nYSize) * (iStrip + 1) /
+                             nStrips) -
+            sStrip.nYOff;
+        sStrip.poBand = std::make_unique<GDALFootprintStripBand>(
+            poMaskBand, sStrip.nYOff, nStripYSize, oMutex);
+        sStrip.poLayer =
+            std::make_unique<OGRMemLayer>("", nullptr, wkbUnknown);
+    }
+
+    auto poPool = GDALGetGlobalThreadPool(nStrips);
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    for (auto &sStrip : asStrips)
+    {
+        if (poQueue)
+            poQueue->SubmitJob(GDALFootprintPolygonizeStripJobFunc, &sStrip);
+        else
+            GDALFootprintPolygonizeStripJobFunc(&sStrip);
+    }
+    if (poQueue)
+        poQueue->WaitCompletion();
+
+    if (!psOptions->pfnProgress(0.5, "", psOptions->pProgressData))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return false;
+    }
+
+    // Shift the polygons of each strip to their location in the band, and
+    // union them to merge the polygons crossing strip boundaries.
+    auto poMP = std::make_unique<OGRMultiPolygon>();
+    for (auto &sStrip : asStrips)
+    {
+        if (sStrip.eErr != CE_None)
+            return false;
+        GeoTransformCoordinateTransformation oCT(
+            std::array<double, 6>{{0.0, 1.0, 0.0, double(sStrip.nYOff), 0.0,
+                                   1.0}});
+        for (auto &&poFeature : sStrip.poLayer.get())
+        {
+            auto poGeom =
+                std::unique_ptr<OGRGeometry>(poFeature->StealGeometry());
+            if (poGeom && poGeom->getGeometryType() == wkbPolygon &&
+                poGeom->transform(&oCT) == OGRERR_NONE)
+            {
+                poMP->addGeometryDirectly(poGeom.release());
+            }
+        }
+        sStrip.poLayer.reset();
+    }
+
+    std::unique_ptr<OGRGeometry> poUnion;
+    if (!poMP->IsEmpty())
+    {
+        poUnion.reset(poMP->UnionCascaded());
+        if (!poUnion)
+            return false;
+        poUnion.reset(
+            OGRGeometryFactory::forceToMultiPolygon(poUnion.release()));
+    }
+
+    if (poUnion && poUnion->getGeometryType() == wkbMultiPolygon)
+    {
+        for (auto *poPoly : poUnion->toMultiPolygon())
+        {
+            for (auto *poRing : poPoly)
+                RemoveCollinearPoints(poRing);
+            auto poFeature =
+                std::make_unique<OGRFeature>(poMemLayer->GetLayerDefn());
+            poFeature->SetGeometry(poPoly);
+            CPL_IGNORE_RET_VAL(poMemLayer->CreateFeature(poFeature.get()));
+        }
+    }
+
+    return psOptions->pfnProgress(1.0, "", psOptions->pProgressData) != FALSE;
+}
+
 /************************************************************************/
 /*                             CountPoints()                            */
 /************************************************************************/
@@ -841,16 +1045,38 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
             apoSrcMaskBands, psOptions->bCombineBandsUnion);
     }
 
-    auto hBand = GDALRasterBand::ToHandle(poMaskForRasterize.get());
+    // Polygonize by horizontal strips of at least 256 lines in parallel if
+    // GDAL_NUM_THREADS is set. The union of the polygons of the strips
+    // requires GEOS.
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads =
+        std::max(1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                                      ? CPLGetNumCPUs()
+                                      : atoi(pszNumThreads)));
+    const int nStrips =
+        std::min(nThreads, poMaskForRasterize->GetYSize() / 256);
+
     auto poMemLayer = std::make_unique<OGRMemLayer>("", nullptr, wkbUnknown);
-    const CPLErr eErr =
-        GDALPolygonize(hBand, hBand, OGRLayer::ToHandle(poMemLayer.get()),
-                       /* iPixValField = */ -1,
-                       /* papszOptions = */ nullptr, psOptions->pfnProgress,
-                       psOptions->pProgressData);
-    if (eErr != CE_None)
+    if (nStrips > 1 && OGRGeometryFactory::haveGEOS())
     {
-        return false;
+        if (!GDALFootprintPolygonizeMultiThreaded(
+                poMaskForRasterize.get(), poMemLayer.get(), nStrips, psOptions))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        auto hBand = GDALRasterBand::ToHandle(poMaskForRasterize.get());
+        const CPLErr eErr =
+            GDALPolygonize(hBand, hBand, OGRLayer::ToHandle(poMemLayer.get()),
+                           /* iPixValField = */ -1,
+                           /* papszOptions = */ nullptr, psOptions->pfnProgress,
+                           psOptions->pProgressData);
+        if (eErr != CE_None)
+        {
+            return false;
+        }
     }
 
     if (!psOptions->bSplitPolys)
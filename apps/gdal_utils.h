@@ -149,6 +149,12 @@ GDALDEMProcessing(const char *pszDestFilename, GDALDatasetH hSrcDataset,
                   const char *pszProcessing, const char *pszColorFilename,
                   const GDALDEMProcessingOptions *psOptions, int *pbUsageError);
 
+int CPL_DLL GDALDEMProcessingMulti(
+    int nCount, const char *const *papszDests, GDALDatasetH hSrcDataset,
+    const char *const *papszProcessings, const char *const *papszColorFilenames,
+    const GDALDEMProcessingOptions *const *papsOptions,
+    GDALDatasetH *pahDstDatasets, int *pbUsageError);
+
 /*! Options for GDALNearblack(). Opaque type */
 typedef struct GDALNearblackOptions GDALNearblackOptions;
 
@@ -25,6 +25,8 @@
  * DEALINGS IN THE SOFTWARE.
  ****************************************************************************/
 
+#include <vector>
+
 #include "cpl_conv.h"
 #include "cpl_string.h"
 #include "gdal_version.h"
@@ -50,7 +52,7 @@ static void Usage(bool bIsError, const char *pszErrorMsg = nullptr)
         "                     [-a_nodata <value>] [-f <formatname>]\n"
         "                     [-oz <observer_height>] [-tz <target_height>] "
         "[-md <max_distance>]\n"
-        "                     -ox <observer_x> -oy <observer_y>\n"
+        "                     -ox <observer_x> -oy <observer_y>...\n"
         "                     [-vv <visibility>] [-iv <invisibility>]\n"
         "                     [-ov <out_of_range>] [-cc <curvature_coef>]\n"
         "                     [-co <NAME>=<VALUE>]...\n"
@@ -88,10 +90,8 @@ MAIN_START(argc, argv)
     double dfObserverHeight = 2.0;
     double dfTargetHeight = 0.0;
     double dfMaxDistance = 0.0;
-    bool bObserverXSpecified = false;
-    double dfObserverX = 0.0;
-    bool bObserverYSpecified = false;
-    double dfObserverY = 0.0;
+    std::vector<double> adfObserverX;
+    std::vector<double> adfObserverY;
     double dfVisibleVal = 255.0;
     double dfInvisibleVal = 0.0;
     double dfOutOfRangeVal = 0.0;
@@ -135,14 +135,12 @@ MAIN_START(argc, argv)
         else if (EQUAL(argv[i], "-ox"))
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
-            bObserverXSpecified = true;
-            dfObserverX = CPLAtofTaintedSuppressed(argv[++i]);
+            adfObserverX.push_back(CPLAtofTaintedSuppressed(argv[++i]));
         }
         else if (EQUAL(argv[i], "-oy"))
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
-            bObserverYSpecified = true;
-            dfObserverY = CPLAtofTaintedSuppressed(argv[++i]);
+            adfObserverY.push_back(CPLAtofTaintedSuppressed(argv[++i]));
         }
         else if (EQUAL(argv[i], "-oz"))
         {
@@ -227,16 +225,21 @@ MAIN_START(argc, argv)
         Usage(true, "Missing destination filename.");
     }
 
-    if (!bObserverXSpecified)
+    if (adfObserverX.empty())
     {
         Usage(true, "Missing -ox.");
     }
 
-    if (!bObserverYSpecified)
+    if (adfObserverY.empty())
     {
         Usage(true, "Missing -oy.");
     }
 
+    if (adfObserverX.size() != adfObserverY.size())
+    {
+        Usage(true, "-ox and -oy must be specified the same number of times.");
+    }
+
     if (!bQuiet)
         pfnProgress = GDALTermProgress;
 
@@ -270,6 +273,11 @@ MAIN_START(argc, argv)
         }
     }
 
+    if (adfObserverX.size() > 1 && outputMode != GVOT_NORMAL)
+    {
+        Usage(true, "-om must be NORMAL with several observers");
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Open source raster file.                                        */
     /* -------------------------------------------------------------------- */
@@ -307,12 +315,27 @@ MAIN_START(argc, argv)
     /* -------------------------------------------------------------------- */
     /*      Invoke.                                                         */
     /* -------------------------------------------------------------------- */
-    GDALDatasetH hDstDS = GDALViewshedGenerate(
-        hBand, pszDriverName ? pszDriverName : osFormat.c_str(), pszDstFilename,
-        papszCreateOptions, dfObserverX, dfObserverY, dfObserverHeight,
-        dfTargetHeight, dfVisibleVal, dfInvisibleVal, dfOutOfRangeVal,
-        dfNoDataVal, dfCurvCoeff, GVM_Edge, dfMaxDistance, pfnProgress, nullptr,
-        outputMode, nullptr);
+    GDALDatasetH hDstDS;
+    if (adfObserverX.size() > 1)
+    {
+        // Cumulative viewshed: count of observers from which cells are
+        // visible.
+        hDstDS = GDALViewshedGenerateCumulative(
+            hBand, pszDriverName ? pszDriverName : osFormat.c_str(),
+            pszDstFilename, papszCreateOptions,
+            static_cast<int>(adfObserverX.size()), adfObserverX.data(),
+            adfObserverY.data(), dfObserverHeight, dfTargetHeight, dfCurvCoeff,
+            GVM_Edge, dfMaxDistance, pfnProgress, nullptr, nullptr);
+    }
+    else
+    {
+        hDstDS = GDALViewshedGenerate(
+            hBand, pszDriverName ? pszDriverName : osFormat.c_str(),
+            pszDstFilename, papszCreateOptions, adfObserverX[0],
+            adfObserverY[0], dfObserverHeight, dfTargetHeight, dfVisibleVal,
+            dfInvisibleVal, dfOutOfRangeVal, dfNoDataVal, dfCurvCoeff, GVM_Edge,
+            dfMaxDistance, pfnProgress, nullptr, outputMode, nullptr);
+    }
     bool bSuccess = hDstDS != nullptr;
     GDALClose(hSrcDS);
     if (GDALClose(hDstDS) != CE_None)
@@ -34,6 +34,10 @@
 #include "vrtdataset.h"
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 /************************************************************************/
 /*                               Usage()                                */
@@ -55,7 +59,7 @@ static void Usage(bool bIsError, const char *pszErrorMsg = nullptr)
         "<lry>]\n"
         "                [--partial-refresh-from-source-extent "
         "<filename1>[,<filenameN>]...]\n"
-        "                <filename> [<levels>]...\n"
+        "                <filename>... [<levels>]...\n"
         "\n"
         "  -r : choice of resampling method (default: nearest)\n"
         "  -ro : open the dataset in read-only mode, in order to generate\n"
@@ -64,14 +68,16 @@ static void Usage(bool bIsError, const char *pszErrorMsg = nullptr)
         "  -q : turn off progress display\n"
         "  -b : band to create overview (if not set overviews will be created "
         "for all bands)\n"
-        "  filename: The file to build overviews for (or whose overviews must "
-        "be removed).\n"
+        "  filename: The file(s) to build overviews for (or whose overviews "
+        "must be removed).\n"
         "  levels: A list of integral overview levels to build. Ignored with "
         "-clean option.\n"
         "\n"
         "Useful configuration variables :\n"
         "  --config USE_RRD YES : Use Erdas Imagine format (.aux) as overview "
         "format.\n"
+        "  --config GDAL_NUM_THREADS {<n>|ALL_CPUS} : number of threads, "
+        "shared among files\n"
         "Below, only for external overviews in GeoTIFF format:\n"
         "  --config COMPRESS_OVERVIEW {JPEG,LZW,PACKBITS,DEFLATE} : TIFF "
         "compression\n"
@@ -112,12 +118,12 @@ class GDALError
     }
 };
 
-std::vector<GDALError> aoErrors;
-
 static void CPL_STDCALL GDALAddoErrorHandler(CPLErr eErr, CPLErrorNum errNum,
                                              const char *pszMsg)
 {
-    aoErrors.push_back(GDALError(eErr, errNum, pszMsg));
+    auto paoErrors =
+        static_cast<std::vector<GDALError> *>(CPLGetErrorHandlerUserData());
+    paoErrors->push_back(GDALError(eErr, errNum, pszMsg));
 }
 
 /************************************************************************/
@@ -603,6 +609,266 @@ static bool PartialRefreshFromProjWin(
                           pfnProgress, pProgressArg);
 }
 
+/************************************************************************/
+/*                            GDALAddoOptions                           */
+/************************************************************************/
+
+struct GDALAddoOptions
+{
+    const char *pszResampling = "nearest";
+    std::vector<int> anLevels{};
+    bool bReadOnly = false;
+    bool bClean = false;
+    std::vector<int> anBandList{};
+    CPLStringList aosOpenOptions{};
+    bool bMinSizeSpecified = false;
+    int nMinSize = 256;
+    bool bPartialRefreshFromSourceTimestamp = false;
+    bool bPartialRefreshFromProjWin = false;
+    double dfULX = 0;
+    double dfULY = 0;
+    double dfLRX = 0;
+    double dfLRY = 0;
+    bool bPartialRefreshFromSourceExtent = false;
+    CPLStringList aosSources{};
+};
+
+/************************************************************************/
+/*                           ProcessDataset()                           */
+/************************************************************************/
+
+// Builds, refreshes or cleans the overviews of a dataset, and returns the
+// exit status of the program for it.
+static int ProcessDataset(const char *pszFilename,
+                          const GDALAddoOptions &sOptions,
+                          GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const char *pszResampling = sOptions.pszResampling;
+    std::vector<int> anLevels(sOptions.anLevels);
+    const int nBandCount = static_cast<int>(sOptions.anBandList.size());
+    const int *panBandList = sOptions.anBandList.data();
+    int nResultStatus = 0;
+
+    /* -------------------------------------------------------------------- */
+    /*      Open data file.                                                 */
+    /* -------------------------------------------------------------------- */
+    GDALDatasetH hDataset = nullptr;
+    if (!sOptions.bReadOnly)
+    {
+        std::vector<GDALError> aoErrors;
+        CPLPushErrorHandlerEx(GDALAddoErrorHandler, &aoErrors);
+        CPLSetCurrentErrorHandlerCatchDebug(FALSE);
+        hDataset = GDALOpenEx(pszFilename, GDAL_OF_RASTER | GDAL_OF_UPDATE,
+                              nullptr, sOptions.aosOpenOptions.List(), nullptr);
+        CPLPopErrorHandler();
+        if (hDataset != nullptr)
+        {
+            for (size_t i = 0; i < aoErrors.size(); i++)
+            {
+                CPLError(aoErrors[i].m_eErr, aoErrors[i].m_errNum, "%s",
+                         aoErrors[i].m_osMsg.c_str());
+            }
+        }
+    }
+
+    if (hDataset == nullptr)
+        hDataset =
+            GDALOpenEx(pszFilename, GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
+                       nullptr, sOptions.aosOpenOptions.List(), nullptr);
+
+    if (hDataset == nullptr)
+        return 2;
+
+    /* -------------------------------------------------------------------- */
+    /*      Clean overviews.                                                */
+    /* -------------------------------------------------------------------- */
+    if (sOptions.bClean)
+    {
+        if (GDALBuildOverviews(hDataset, pszResampling, 0, nullptr, 0, nullptr,
+                               pfnProgress, pProgressArg) != CE_None)
+        {
+            printf("Cleaning overviews failed.\n");
+            nResultStatus = 200;
+        }
+    }
+    else if (sOptions.bPartialRefreshFromSourceTimestamp)
+    {
+        if (!PartialRefreshFromSourceTimestamp(
+                GDALDataset::FromHandle(hDataset), pszResampling,
+                static_cast<int>(anLevels.size()), anLevels.data(), nBandCount,
+                panBandList, sOptions.bMinSizeSpecified, sOptions.nMinSize,
+                pfnProgress, pProgressArg))
+        {
+            nResultStatus = 1;
+        }
+    }
+    else if (sOptions.bPartialRefreshFromProjWin)
+    {
+        if (!PartialRefreshFromProjWin(
+                GDALDataset::FromHandle(hDataset), sOptions.dfULX,
+                sOptions.dfULY, sOptions.dfLRX, sOptions.dfLRY, pszResampling,
+                static_cast<int>(anLevels.size()), anLevels.data(), nBandCount,
+                panBandList, sOptions.bMinSizeSpecified, sOptions.nMinSize,
+                pfnProgress, pProgressArg))
+        {
+            nResultStatus = 1;
+        }
+    }
+    else if (sOptions.bPartialRefreshFromSourceExtent)
+    {
+        if (!PartialRefreshFromSourceExtent(
+                GDALDataset::FromHandle(hDataset), sOptions.aosSources,
+                pszResampling, static_cast<int>(anLevels.size()),
+                anLevels.data(), nBandCount, panBandList,
+                sOptions.bMinSizeSpecified, sOptions.nMinSize, pfnProgress,
+                pProgressArg))
+        {
+            nResultStatus = 1;
+        }
+    }
+    else
+    {
+        /* --------------------------------------------------------------------
+         */
+        /*      Generate overviews. */
+        /* --------------------------------------------------------------------
+         */
+
+        if (anLevels.empty())
+        {
+            const int nXSize = GDALGetRasterXSize(hDataset);
+            const int nYSize = GDALGetRasterYSize(hDataset);
+            int nOvrFactor = 1;
+            while (DIV_ROUND_UP(nXSize, nOvrFactor) > sOptions.nMinSize ||
+                   DIV_ROUND_UP(nYSize, nOvrFactor) > sOptions.nMinSize)
+            {
+                nOvrFactor *= 2;
+                anLevels.push_back(nOvrFactor);
+            }
+        }
+
+        // Only HFA supports selected layers
+        if (nBandCount > 0)
+            CPLSetConfigOption("USE_RRD", "YES");
+
+        if (!anLevels.empty() &&
+            GDALBuildOverviews(hDataset, pszResampling,
+                               static_cast<int>(anLevels.size()),
+                               anLevels.data(), nBandCount, panBandList,
+                               pfnProgress, pProgressArg) != CE_None)
+        {
+            printf("Overview building failed.\n");
+            nResultStatus = 100;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Cleanup                                                         */
+    /* -------------------------------------------------------------------- */
+    if (GDALClose(hDataset) != CE_None)
+    {
+        if (nResultStatus == 0)
+            nResultStatus = 1;
+    }
+
+    return nResultStatus;
+}
+
+/************************************************************************/
+/*                          ProcessDatasets()                           */
+/************************************************************************/
+
+// Processes several datasets concurrently. The GDAL_NUM_THREADS budget is
+// shared between the worker threads, each processing one dataset at a
+// time, and the threads used by each of them to compute overviews.
+// The memory allocated for overview computation chunks is also divided
+// among the workers, whereas the block cache is shared. Returns the highest
+// exit status.
+static int ProcessDatasets(const CPLStringList &aosFilenames,
+                           const GDALAddoOptions &sOptions,
+                           GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nFiles = aosFilenames.size();
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(1, EQUAL(pszNumThreads, "ALL_CPUS")
+                                         ? CPLGetNumCPUs()
+                                         : atoi(pszNumThreads));
+    const int nWorkers = std::min(nThreads, nFiles);
+
+    if (nWorkers <= 1)
+    {
+        int nResultStatus = 0;
+        for (int i = 0; i < nFiles; ++i)
+        {
+            void *pScaledProgress = GDALCreateScaledProgress(
+                static_cast<double>(i) / nFiles,
+                static_cast<double>(i + 1) / nFiles, pfnProgress,
+                pProgressArg);
+            nResultStatus =
+                std::max(nResultStatus,
+                         ProcessDataset(aosFilenames[i], sOptions,
+                                        pScaledProgress ? GDALScaledProgress
+                                                        : GDALDummyProgress,
+                                        pScaledProgress));
+            GDALDestroyScaledProgress(pScaledProgress);
+        }
+        return nResultStatus;
+    }
+
+    const std::string osThreadsPerWorker =
+        std::to_string(std::max(1, nThreads / nWorkers));
+    const std::string osChunkMaxSize = std::to_string(
+        std::max(1024 * 1024, atoi(CPLGetConfigOption(
+                                  "GDAL_OVR_CHUNK_MAX_SIZE", "10485760")) /
+                                  nWorkers));
+
+    std::atomic<int> nNextFile{0};
+    std::mutex oMutex;
+    int nFilesDone = 0;
+    int nResultStatus = 0;
+    bool bInterrupted = false;
+
+    // Progress is reported by file completed, as per-file progress of
+    // concurrent workers cannot be combined.
+    const auto WorkerFunc = [&]()
+    {
+        CPLConfigOptionSetter oNumThreadsSetter(
+            "GDAL_NUM_THREADS", osThreadsPerWorker.c_str(), false);
+        CPLConfigOptionSetter oChunkMaxSizeSetter(
+            "GDAL_OVR_CHUNK_MAX_SIZE", osChunkMaxSize.c_str(), false);
+        while (true)
+        {
+            const int iFile = nNextFile++;
+            if (iFile >= nFiles)
+                break;
+            {
+                std::lock_guard<std::mutex> oLock(oMutex);
+                if (bInterrupted)
+                    break;
+            }
+            const int nStatus = ProcessDataset(aosFilenames[iFile], sOptions,
+                                               GDALDummyProgress, nullptr);
+            std::lock_guard<std::mutex> oLock(oMutex);
+            nResultStatus = std::max(nResultStatus, nStatus);
+            ++nFilesDone;
+            if (!pfnProgress(static_cast<double>(nFilesDone) / nFiles, "",
+                             pProgressArg))
+            {
+                bInterrupted = true;
+                nResultStatus = std::max(nResultStatus, 1);
+            }
+        }
+    };
+
+    std::vector<std::thread> aoThreads;
+    for (int i = 0; i < nWorkers; ++i)
+        aoThreads.emplace_back(WorkerFunc);
+    for (auto &oThread : aoThreads)
+        oThread.join();
+
+    return nResultStatus;
+}
+
 /************************************************************************/
 /*                                main()                                */
 /************************************************************************/
@@ -635,28 +901,10 @@ MAIN_START(nArgc, papszArgv)
     if (nArgc < 1)
         exit(-nArgc);
 
-    const char *pszResampling = "nearest";
-    const char *pszFilename = nullptr;
-    int anLevels[1024] = {};
-    int nLevelCount = 0;
-    int nResultStatus = 0;
-    bool bReadOnly = false;
-    bool bClean = false;
+    GDALAddoOptions sOptions;
+    CPLStringList aosFilenames;
     GDALProgressFunc pfnProgress = GDALTermProgress;
     void *pProgressArg = nullptr;
-    int *panBandList = nullptr;
-    int nBandCount = 0;
-    char **papszOpenOptions = nullptr;
-    bool bMinSizeSpecified = false;
-    int nMinSize = 256;
-    bool bPartialRefreshFromSourceTimestamp = false;
-    bool bPartialRefreshFromProjWin = false;
-    double dfULX = 0;
-    double dfULY = 0;
-    double dfLRX = 0;
-    double dfLRY = 0;
-    bool bPartialRefreshFromSourceExtent = false;
-    CPLStringList aosSources;
 
     /* -------------------------------------------------------------------- */
     /*      Parse command line.                                              */
@@ -679,15 +927,15 @@ MAIN_START(nArgc, papszArgv)
         else if (EQUAL(papszArgv[iArg], "-r"))
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
-            pszResampling = papszArgv[++iArg];
+            sOptions.pszResampling = papszArgv[++iArg];
         }
         else if (EQUAL(papszArgv[iArg], "-ro"))
         {
-            bReadOnly = true;
+            sOptions.bReadOnly = true;
         }
         else if (EQUAL(papszArgv[iArg], "-clean"))
         {
-            bClean = true;
+            sOptions.bClean = true;
         }
         else if (EQUAL(papszArgv[iArg], "-q") ||
                  EQUAL(papszArgv[iArg], "-quiet"))
@@ -706,57 +954,57 @@ MAIN_START(nArgc, papszArgv)
             }
             iArg++;
 
-            nBandCount++;
-            panBandList = static_cast<int *>(
-                CPLRealloc(panBandList, sizeof(int) * nBandCount));
-            panBandList[nBandCount - 1] = nBand;
+            sOptions.anBandList.push_back(nBand);
         }
         else if (EQUAL(papszArgv[iArg], "-oo"))
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
-            papszOpenOptions =
-                CSLAddString(papszOpenOptions, papszArgv[++iArg]);
+            sOptions.aosOpenOptions.AddString(papszArgv[++iArg]);
         }
         else if (EQUAL(papszArgv[iArg], "-minsize"))
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
-            nMinSize = atoi(papszArgv[++iArg]);
-            bMinSizeSpecified = true;
+            sOptions.nMinSize = atoi(papszArgv[++iArg]);
+            sOptions.bMinSizeSpecified = true;
         }
         else if (EQUAL(papszArgv[iArg],
                        "--partial-refresh-from-source-timestamp"))
         {
-            bPartialRefreshFromSourceTimestamp = true;
+            sOptions.bPartialRefreshFromSourceTimestamp = true;
         }
         else if (EQUAL(papszArgv[iArg], "--partial-refresh-from-projwin"))
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(4);
-            bPartialRefreshFromProjWin = true;
-            dfULX = CPLAtof(papszArgv[++iArg]);
-            dfULY = CPLAtof(papszArgv[++iArg]);
-            dfLRX = CPLAtof(papszArgv[++iArg]);
-            dfLRY = CPLAtof(papszArgv[++iArg]);
+            sOptions.bPartialRefreshFromProjWin = true;
+            sOptions.dfULX = CPLAtof(papszArgv[++iArg]);
+            sOptions.dfULY = CPLAtof(papszArgv[++iArg]);
+            sOptions.dfLRX = CPLAtof(papszArgv[++iArg]);
+            sOptions.dfLRY = CPLAtof(papszArgv[++iArg]);
         }
         else if (EQUAL(papszArgv[iArg], "--partial-refresh-from-source-extent"))
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
-            bPartialRefreshFromSourceExtent = true;
-            aosSources = CSLTokenizeString2(papszArgv[++iArg], ",", 0);
+            sOptions.bPartialRefreshFromSourceExtent = true;
+            sOptions.aosSources =
+                CSLTokenizeString2(papszArgv[++iArg], ",", 0);
         }
         else if (papszArgv[iArg][0] == '-')
         {
             Usage(true,
                   CPLSPrintf("Unknown option name '%s'", papszArgv[iArg]));
         }
-        else if (pszFilename == nullptr)
+        else if (aosFilenames.empty() ||
+                 (sOptions.anLevels.empty() &&
+                  !(CPLGetValueType(papszArgv[iArg]) == CPL_VALUE_INTEGER &&
+                    atoi(papszArgv[iArg]) > 0)))
         {
-            pszFilename = papszArgv[iArg];
+            // Filenames are before the first level
+            aosFilenames.AddString(papszArgv[iArg]);
         }
-        else if (atoi(papszArgv[iArg]) > 0 &&
-                 static_cast<size_t>(nLevelCount) < CPL_ARRAYSIZE(anLevels))
+        else if (atoi(papszArgv[iArg]) > 0 && sOptions.anLevels.size() < 1024)
         {
-            anLevels[nLevelCount++] = atoi(papszArgv[iArg]);
-            if (anLevels[nLevelCount - 1] == 1)
+            sOptions.anLevels.push_back(atoi(papszArgv[iArg]));
+            if (sOptions.anLevels.back() == 1)
             {
                 printf(
                     "Warning: Overview with subsampling factor of 1 requested. "
@@ -770,137 +1018,26 @@ MAIN_START(nArgc, papszArgv)
         }
     }
 
-    if (pszFilename == nullptr)
+    if (aosFilenames.empty())
         Usage(true, "No datasource specified.");
 
-    if (((bClean) ? 1 : 0) + ((bPartialRefreshFromSourceTimestamp) ? 1 : 0) +
-            ((bPartialRefreshFromProjWin) ? 1 : 0) +
-            ((bPartialRefreshFromSourceExtent) ? 1 : 0) >
+    if (((sOptions.bClean) ? 1 : 0) +
+            ((sOptions.bPartialRefreshFromSourceTimestamp) ? 1 : 0) +
+            ((sOptions.bPartialRefreshFromProjWin) ? 1 : 0) +
+            ((sOptions.bPartialRefreshFromSourceExtent) ? 1 : 0) >
         1)
     {
         Usage(true, "Mutually exclusive options used");
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      Open data file.                                                 */
-    /* -------------------------------------------------------------------- */
-    GDALDatasetH hDataset = nullptr;
-    if (!bReadOnly)
-    {
-        CPLPushErrorHandler(GDALAddoErrorHandler);
-        CPLSetCurrentErrorHandlerCatchDebug(FALSE);
-        hDataset = GDALOpenEx(pszFilename, GDAL_OF_RASTER | GDAL_OF_UPDATE,
-                              nullptr, papszOpenOptions, nullptr);
-        CPLPopErrorHandler();
-        if (hDataset != nullptr)
-        {
-            for (size_t i = 0; i < aoErrors.size(); i++)
-            {
-                CPLError(aoErrors[i].m_eErr, aoErrors[i].m_errNum, "%s",
-                         aoErrors[i].m_osMsg.c_str());
-            }
-        }
-    }
-
-    if (hDataset == nullptr)
-        hDataset =
-            GDALOpenEx(pszFilename, GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
-                       nullptr, papszOpenOptions, nullptr);
-
-    CSLDestroy(papszOpenOptions);
-    papszOpenOptions = nullptr;
-
-    if (hDataset == nullptr)
-        exit(2);
-
-    /* -------------------------------------------------------------------- */
-    /*      Clean overviews.                                                */
-    /* -------------------------------------------------------------------- */
-    if (bClean)
-    {
-        if (GDALBuildOverviews(hDataset, pszResampling, 0, nullptr, 0, nullptr,
-                               pfnProgress, pProgressArg) != CE_None)
-        {
-            printf("Cleaning overviews failed.\n");
-            nResultStatus = 200;
-        }
-    }
-    else if (bPartialRefreshFromSourceTimestamp)
-    {
-        if (!PartialRefreshFromSourceTimestamp(
-                GDALDataset::FromHandle(hDataset), pszResampling, nLevelCount,
-                anLevels, nBandCount, panBandList, bMinSizeSpecified, nMinSize,
-                pfnProgress, pProgressArg))
-        {
-            nResultStatus = 1;
-        }
-    }
-    else if (bPartialRefreshFromProjWin)
-    {
-        if (!PartialRefreshFromProjWin(
-                GDALDataset::FromHandle(hDataset), dfULX, dfULY, dfLRX, dfLRY,
-                pszResampling, nLevelCount, anLevels, nBandCount, panBandList,
-                bMinSizeSpecified, nMinSize, pfnProgress, pProgressArg))
-        {
-            nResultStatus = 1;
-        }
-    }
-    else if (bPartialRefreshFromSourceExtent)
-    {
-        if (!PartialRefreshFromSourceExtent(
-                GDALDataset::FromHandle(hDataset), aosSources, pszResampling,
-                nLevelCount, anLevels, nBandCount, panBandList,
-                bMinSizeSpecified, nMinSize, pfnProgress, pProgressArg))
-        {
-            nResultStatus = 1;
-        }
-    }
-    else
-    {
-        /* --------------------------------------------------------------------
-         */
-        /*      Generate overviews. */
-        /* --------------------------------------------------------------------
-         */
-
-        if (nLevelCount == 0)
-        {
-            const int nXSize = GDALGetRasterXSize(hDataset);
-            const int nYSize = GDALGetRasterYSize(hDataset);
-            int nOvrFactor = 1;
-            while (DIV_ROUND_UP(nXSize, nOvrFactor) > nMinSize ||
-                   DIV_ROUND_UP(nYSize, nOvrFactor) > nMinSize)
-            {
-                nOvrFactor *= 2;
-                anLevels[nLevelCount++] = nOvrFactor;
-            }
-        }
-
-        // Only HFA supports selected layers
-        if (nBandCount > 0)
-            CPLSetConfigOption("USE_RRD", "YES");
-
-        if (nLevelCount > 0 &&
-            GDALBuildOverviews(hDataset, pszResampling, nLevelCount, anLevels,
-                               nBandCount, panBandList, pfnProgress,
-                               pProgressArg) != CE_None)
-        {
-            printf("Overview building failed.\n");
-            nResultStatus = 100;
-        }
-    }
-
-    /* -------------------------------------------------------------------- */
-    /*      Cleanup                                                         */
-    /* -------------------------------------------------------------------- */
-    if (GDALClose(hDataset) != CE_None)
-    {
-        if (nResultStatus == 0)
-            nResultStatus = 1;
-    }
+    const int nResultStatus =
+        aosFilenames.size() == 1
+            ? ProcessDataset(aosFilenames[0], sOptions, pfnProgress,
+                             pProgressArg)
+            : ProcessDatasets(aosFilenames, sOptions, pfnProgress,
+                              pProgressArg);
 
     CSLDestroy(papszArgv);
-    CPLFree(panBandList);
     GDALDestroyDriverManager();
 
     return nResultStatus;
@@ -55,7 +55,7 @@ static void Usage(bool bIsError, const char *pszErrorMsg)
         "                    [-addalpha] [-hidenodata]\n"
         "                    [-srcnodata \"<value>[ <value>]...\"] [-vrtnodata "
         "\"<value>[ <value>]...\"\n"
-        "                    [-ignore_srcmaskband]\n"
+        "                    [-ignore_srcmaskband] [-footprint]\n"
         "                    [-a_srs <srs_def>]\n"
         "                    [-r "
         "{nearest|bilinear|cubic|cubicspline|lanczos|average|mode}]\n"
@@ -42,6 +42,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
 #include <vector>
 #include <set>
 
@@ -249,6 +250,7 @@ class VRTBuilder
     char *pszResampling = nullptr;
     char **papszOpenOptions = nullptr;
     bool bUseSrcMaskBand = true;
+    bool bWriteFootprints = false;
 
     /* Internal variables */
     char *pszProjectionRef = nullptr;
@@ -274,6 +276,10 @@ class VRTBuilder
     void CreateVRTSeparate(VRTDatasetH hVRTDS);
     void CreateVRTNonSeparate(VRTDatasetH hVRTDS);
 
+    std::unique_ptr<OGRGeometry>
+    ComputeFootprint(GDALDatasetH hSourceDS,
+                     const DatasetProperty *psDatasetProperties);
+
   public:
     VRTBuilder(bool bStrictIn, const char *pszOutputFilename, int nInputFiles,
                const char *const *ppszInputFilenames, GDALDatasetH *pahSrcDSIn,
@@ -285,7 +291,7 @@ class VRTBuilder
                int nSubdataset, const char *pszSrcNoData,
                const char *pszVRTNoData, bool bUseSrcMaskBand,
                const char *pszOutputSRS, const char *pszResampling,
-               const char *const *papszOpenOptionsIn);
+               const char *const *papszOpenOptionsIn, bool bWriteFootprints);
 
     ~VRTBuilder();
 
@@ -306,7 +312,8 @@ VRTBuilder::VRTBuilder(
     int bAddAlphaIn, int bHideNoDataIn, int nSubdatasetIn,
     const char *pszSrcNoDataIn, const char *pszVRTNoDataIn,
     bool bUseSrcMaskBandIn, const char *pszOutputSRSIn,
-    const char *pszResamplingIn, const char *const *papszOpenOptionsIn)
+    const char *pszResamplingIn, const char *const *papszOpenOptionsIn,
+    bool bWriteFootprintsIn)
     : bStrict(bStrictIn)
 {
     pszOutputFilename = CPLStrdup(pszOutputFilenameIn);
@@ -365,6 +372,7 @@ VRTBuilder::VRTBuilder(
     pszOutputSRS = (pszOutputSRSIn) ? CPLStrdup(pszOutputSRSIn) : nullptr;
     pszResampling = (pszResamplingIn) ? CPLStrdup(pszResamplingIn) : nullptr;
     bUseSrcMaskBand = bUseSrcMaskBandIn;
+    bWriteFootprints = bWriteFootprintsIn;
 }
 
 /************************************************************************/
@@ -1138,6 +1146,83 @@ void VRTBuilder::CreateVRTSeparate(VRTDatasetH hVRTDS)
     }
 }
 
+/************************************************************************/
+/*                         ComputeFootprint()                           */
+/************************************************************************/
+
+/* Compute the footprint of the valid data of a source dataset, in its */
+/* pixel/line coordinates, as the convex hull of the polygonized mask */
+/* of the selected bands. Only done when all the selected bands are */
+/* composited with the same kind of masking (nodata or mask band), since */
+/* the footprint must cover all pixels that the sources let through. */
+std::unique_ptr<OGRGeometry>
+VRTBuilder::ComputeFootprint(GDALDatasetH hSourceDS,
+                             const DatasetProperty *psDatasetProperties)
+{
+    CPLStringList aosArgv;
+    aosArgv.AddString("-of");
+    aosArgv.AddString("Memory");
+    aosArgv.AddString("-t_cs");
+    aosArgv.AddString("pixel");
+    aosArgv.AddString("-max_points");
+    aosArgv.AddString("unlimited");
+
+    bool bAllNoData = bAllowSrcNoData != FALSE;
+    bool bAllMaskBand = bUseSrcMaskBand;
+    std::string osSrcNoData;
+    for (int j = 0; j < nSelectedBands; j++)
+    {
+        const int nSelBand = panSelectedBandList[j];
+        aosArgv.AddString("-b");
+        aosArgv.AddString(CPLSPrintf("%d", nSelBand));
+        if (bAllowSrcNoData && psDatasetProperties->abHasNoData[nSelBand - 1])
+        {
+            bAllMaskBand = false;
+            if (!osSrcNoData.empty())
+                osSrcNoData += ' ';
+            osSrcNoData += CPLSPrintf(
+                "%.17g", psDatasetProperties->adfNoDataValues[nSelBand - 1]);
+        }
+        else
+        {
+            bAllNoData = false;
+            if (!psDatasetProperties->abHasMaskBand[nSelBand - 1])
+                bAllMaskBand = false;
+        }
+    }
+    if (bAllNoData)
+    {
+        aosArgv.AddString("-srcnodata");
+        aosArgv.AddString(osSrcNoData.c_str());
+    }
+    else if (!bAllMaskBand)
+    {
+        return nullptr;
+    }
+    aosArgv.AddString("-convex_hull");
+
+    GDALFootprintOptions *psOptions =
+        GDALFootprintOptionsNew(aosArgv.List(), nullptr);
+    if (!psOptions)
+        return nullptr;
+    std::unique_ptr<GDALDataset> poFootprintDS;
+    {
+        CPLErrorHandlerPusher oQuietErrors(CPLQuietErrorHandler);
+        CPLErrorStateBackuper oErrorStateBackuper;
+        poFootprintDS.reset(GDALDataset::FromHandle(
+            GDALFootprint("", nullptr, hSourceDS, psOptions, nullptr)));
+    }
+    GDALFootprintOptionsFree(psOptions);
+    if (!poFootprintDS || poFootprintDS->GetLayerCount() != 1)
+        return nullptr;
+
+    std::unique_ptr<OGRFeature> poFeature(
+        poFootprintDS->GetLayer(0)->GetNextFeature());
+    if (!poFeature || !poFeature->GetGeometryRef())
+        return nullptr;
+    return std::unique_ptr<OGRGeometry>(poFeature->StealGeometry());
+}
+
 /************************************************************************/
 /*                       CreateVRTNonSeparate()                         */
 /************************************************************************/
@@ -1280,6 +1365,17 @@ void VRTBuilder::CreateVRTNonSeparate(VRTDatasetH hVRTDS)
             hSourceDS = static_cast<GDALDatasetH>(hProxyDS);
         }
 
+        std::unique_ptr<OGRGeometry> poFootprint;
+        if (bWriteFootprints)
+        {
+            poFootprint = ComputeFootprint(hSourceDS, psDatasetProperties);
+            if (!poFootprint)
+            {
+                CPLDebug("BuildVRT", "Cannot compute footprint of %s",
+                         dsFileName);
+            }
+        }
+
         for (int j = 0;
              j <
              nSelectedBands +
@@ -1321,6 +1417,11 @@ void VRTBuilder::CreateVRTNonSeparate(VRTDatasetH hVRTDS)
                                        dfSrcXOff, dfSrcYOff, dfSrcXSize,
                                        dfSrcYSize, dfDstXOff, dfDstYOff,
                                        dfDstXSize, dfDstYSize);
+            if (poFootprint && j < nSelectedBands)
+            {
+                poSimpleSource->SetFootprint(
+                    std::unique_ptr<OGRGeometry>(poFootprint->clone()));
+            }
 
             poVRTBand->AddSource(poSimpleSource);
         }
@@ -1514,6 +1615,21 @@ GDALDataset *VRTBuilder::Build(GDALProgressFunc pfnProgress,
         }
     }
 
+    // Open the input files concurrently ahead of their analysis, which must
+    // be done sequentially. Subdatasets added by AnalyseRaster() are opened
+    // in the loop.
+    std::unique_ptr<GDALDatasetOpenPrefetcher> poPrefetcher;
+    const int nPrefetchedFiles = nInputFiles;
+    const int nThreads = GDALDatasetOpenPrefetcher::GetThreadCount();
+    if (pahSrcDS == nullptr && ppszInputFilenames != nullptr &&
+        nThreads > 1 && nInputFiles > 1)
+    {
+        std::vector<std::string> aosFilenames(
+            ppszInputFilenames, ppszInputFilenames + nInputFiles);
+        poPrefetcher = std::make_unique<GDALDatasetOpenPrefetcher>(
+            aosFilenames, GDAL_OF_RASTER, papszOpenOptions, nThreads);
+    }
+
     bool bFoundValid = false;
     for (int i = 0; ppszInputFilenames != nullptr && i < nInputFiles; i++)
     {
@@ -1524,10 +1640,12 @@ GDALDataset *VRTBuilder::Build(GDALProgressFunc pfnProgress,
             return nullptr;
         }
 
-        GDALDatasetH hDS = (pahSrcDS)
-                               ? pahSrcDS[i]
-                               : GDALOpenEx(dsFileName, GDAL_OF_RASTER, nullptr,
-                                            papszOpenOptions, nullptr);
+        GDALDatasetH hDS =
+            (pahSrcDS) ? pahSrcDS[i]
+            : (poPrefetcher && i < nPrefetchedFiles)
+                ? poPrefetcher->Get(i)
+                : GDALOpenEx(dsFileName, GDAL_OF_RASTER, nullptr,
+                             papszOpenOptions, nullptr);
         asDatasetProperties[i].isFileOK = FALSE;
 
         if (hDS)
@@ -1745,6 +1863,7 @@ struct GDALBuildVRTOptions
     char *pszResampling;
     char **papszOpenOptions;
     bool bUseSrcMaskBand;
+    bool bWriteFootprints;
 
     /*! allow or suppress progress monitor and other non-error output */
     int bQuiet;
@@ -1917,7 +2036,8 @@ GDALDatasetH GDALBuildVRT(const char *pszDest, int nSrcCount,
         psOptions->bAddAlpha, psOptions->bHideNoData, psOptions->nSubdataset,
         psOptions->pszSrcNoData, psOptions->pszVRTNoData,
         psOptions->bUseSrcMaskBand, psOptions->pszOutputSRS,
-        psOptions->pszResampling, psOptions->papszOpenOptions);
+        psOptions->pszResampling, psOptions->papszOpenOptions,
+        psOptions->bWriteFootprints);
 
     GDALDatasetH hDstDS = static_cast<GDALDatasetH>(
         oBuilder.Build(psOptions->pfnProgress, psOptions->pProgressData));
@@ -2173,6 +2293,10 @@ GDALBuildVRTOptionsNew(char **papszArgv,
         {
             psOptions->bUseSrcMaskBand = false;
         }
+        else if (EQUAL(papszArgv[iArg], "-footprint"))
+        {
+            psOptions->bWriteFootprints = true;
+        }
         else if (papszArgv[iArg][0] == '-')
         {
             CPLError(CE_Failure, CPLE_NotSupported, "Unknown option name '%s'",
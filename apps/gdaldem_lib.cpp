@@ -109,14 +109,20 @@
 #endif
 
 #include <algorithm>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 #if defined(__SSE2__) || defined(_M_X64)
 #define HAVE_16_SSE_REG
@@ -196,8 +202,8 @@ template <class T> struct GDALGeneric3x3ProcessingAlg
 template <class T> struct GDALGeneric3x3ProcessingAlg_multisample
 {
     typedef int (*type)(const T *pafThreeLineWin, int nLine1Off, int nLine2Off,
-                        int nLine3Off, int nXSize, void *pData,
-                        float *pafOutputBuf);
+                        int nLine3Off, int nXSize, float fDstNoDataValue,
+                        void *pData, float *pafOutputBuf);
 };
 
 template <class T>
@@ -292,18 +298,213 @@ GInt32 INTERPOL(GInt32 a, GInt32 b, int bSrcHasNoData, GInt32 fSrcNoDataValue)
     return nVal;
 }
 
+/************************************************************************/
+/*                    GDALGeneric3x3ProcessingJob()                     */
+/************************************************************************/
+
+// Lines of the interior of the raster processed by a job.
+template <class T> struct GDALGeneric3x3ProcessingJob
+{
+    // nLines + 2 source lines, the first and last ones being the lines
+    // above and below the processed ones.
+    const T *pafLines = nullptr;
+    // nLines output lines.
+    float *pafOutput = nullptr;
+    int nXSize = 0;
+    int nLines = 0;
+    bool bSrcHasNoData = false;
+    T fSrcNoDataValue = 0;
+    bool bIsSrcNoDataNan = false;
+    float fDstNoDataValue = 0;
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg = nullptr;
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+        pfnAlg_multisample = nullptr;
+    void *pData = nullptr;
+    bool bComputeAtEdges = false;
+};
+
+template <class T> static void GDALGeneric3x3ProcessingJobFunc(void *pJobData)
+{
+    const auto psJob =
+        static_cast<const GDALGeneric3x3ProcessingJob<T> *>(pJobData);
+    const T *pafThreeLineWin = psJob->pafLines;
+    const int nXSize = psJob->nXSize;
+    const bool bSrcHasNoData = psJob->bSrcHasNoData;
+    const T fSrcNoDataValue = psJob->fSrcNoDataValue;
+    const bool bIsSrcNoDataNan = psJob->bIsSrcNoDataNan;
+    const float fDstNoDataValue = psJob->fDstNoDataValue;
+    const auto pfnAlg = psJob->pfnAlg;
+    const auto pfnAlg_multisample = psJob->pfnAlg_multisample;
+    void *pData = psJob->pData;
+    const bool bComputeAtEdges = psJob->bComputeAtEdges;
+
+    // In case none of the 3 lines have nodata values, then no need to
+    // check it in ComputeVal()
+    std::vector<bool> abLineHasNoDataValue(psJob->nLines + 2, bSrcHasNoData);
+    if (std::numeric_limits<T>::is_integer && bSrcHasNoData)
+    {
+        for (int iLine = 0; iLine < psJob->nLines + 2; iLine++)
+        {
+            const T *pafLine =
+                pafThreeLineWin + static_cast<size_t>(iLine) * nXSize;
+            bool bLineHasNoDataValue = false;
+            int iX = 0;
+            for (; iX + 3 < nXSize; iX += 4)
+            {
+                if (pafLine[iX] == fSrcNoDataValue ||
+                    pafLine[iX + 1] == fSrcNoDataValue ||
+                    pafLine[iX + 2] == fSrcNoDataValue ||
+                    pafLine[iX + 3] == fSrcNoDataValue)
+                {
+                    bLineHasNoDataValue = true;
+                    break;
+                }
+            }
+            if (!bLineHasNoDataValue)
+            {
+                for (; iX < nXSize; iX++)
+                {
+                    if (pafLine[iX] == fSrcNoDataValue)
+                    {
+                        bLineHasNoDataValue = true;
+                    }
+                }
+            }
+            abLineHasNoDataValue[iLine] = bLineHasNoDataValue;
+        }
+    }
+
+    for (int iLine = 0; iLine < psJob->nLines; iLine++)
+    {
+        const size_t nLine1Off = static_cast<size_t>(iLine) * nXSize;
+        const size_t nLine2Off = nLine1Off + nXSize;
+        const size_t nLine3Off = nLine2Off + nXSize;
+        float *pafOutputBuf =
+            psJob->pafOutput + static_cast<size_t>(iLine) * nXSize;
+
+        const bool bOneOfThreeLinesHasNoData =
+            abLineHasNoDataValue[iLine] || abLineHasNoDataValue[iLine + 1] ||
+            abLineHasNoDataValue[iLine + 2];
+
+        if (bComputeAtEdges && nXSize >= 2)
+        {
+            int j = 0;
+            T afWin[9] = {INTERPOL(pafThreeLineWin[nLine1Off + j],
+                                   pafThreeLineWin[nLine1Off + j + 1],
+                                   bSrcHasNoData, fSrcNoDataValue),
+                          pafThreeLineWin[nLine1Off + j],
+                          pafThreeLineWin[nLine1Off + j + 1],
+                          INTERPOL(pafThreeLineWin[nLine2Off + j],
+                                   pafThreeLineWin[nLine2Off + j + 1],
+                                   bSrcHasNoData, fSrcNoDataValue),
+                          pafThreeLineWin[nLine2Off + j],
+                          pafThreeLineWin[nLine2Off + j + 1],
+                          INTERPOL(pafThreeLineWin[nLine3Off + j],
+                                   pafThreeLineWin[nLine3Off + j + 1],
+                                   bSrcHasNoData, fSrcNoDataValue),
+                          pafThreeLineWin[nLine3Off + j],
+                          pafThreeLineWin[nLine3Off + j + 1]};
+
+            pafOutputBuf[j] =
+                ComputeVal(bOneOfThreeLinesHasNoData, fSrcNoDataValue,
+                           bIsSrcNoDataNan, afWin, fDstNoDataValue, pfnAlg,
+                           pData, bComputeAtEdges);
+        }
+        else
+        {
+            // Exclude the edges
+            pafOutputBuf[0] = fDstNoDataValue;
+        }
+
+        int j = 1;
+        if (pfnAlg_multisample && !bOneOfThreeLinesHasNoData)
+        {
+            j = pfnAlg_multisample(pafThreeLineWin + nLine1Off, 0, nXSize,
+                                   2 * nXSize, nXSize, fDstNoDataValue, pData,
+                                   pafOutputBuf);
+        }
+
+        for (; j < nXSize - 1; j++)
+        {
+            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
+                          pafThreeLineWin[nLine1Off + j],
+                          pafThreeLineWin[nLine1Off + j + 1],
+                          pafThreeLineWin[nLine2Off + j - 1],
+                          pafThreeLineWin[nLine2Off + j],
+                          pafThreeLineWin[nLine2Off + j + 1],
+                          pafThreeLineWin[nLine3Off + j - 1],
+                          pafThreeLineWin[nLine3Off + j],
+                          pafThreeLineWin[nLine3Off + j + 1]};
+
+            pafOutputBuf[j] =
+                ComputeVal(bOneOfThreeLinesHasNoData, fSrcNoDataValue,
+                           bIsSrcNoDataNan, afWin, fDstNoDataValue, pfnAlg,
+                           pData, bComputeAtEdges);
+        }
+
+        if (bComputeAtEdges && nXSize >= 2)
+        {
+            j = nXSize - 1;
+
+            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
+                          pafThreeLineWin[nLine1Off + j],
+                          INTERPOL(pafThreeLineWin[nLine1Off + j],
+                                   pafThreeLineWin[nLine1Off + j - 1],
+                                   bSrcHasNoData, fSrcNoDataValue),
+                          pafThreeLineWin[nLine2Off + j - 1],
+                          pafThreeLineWin[nLine2Off + j],
+                          INTERPOL(pafThreeLineWin[nLine2Off + j],
+                                   pafThreeLineWin[nLine2Off + j - 1],
+                                   bSrcHasNoData, fSrcNoDataValue),
+                          pafThreeLineWin[nLine3Off + j - 1],
+                          pafThreeLineWin[nLine3Off + j],
+                          INTERPOL(pafThreeLineWin[nLine3Off + j],
+                                   pafThreeLineWin[nLine3Off + j - 1],
+                                   bSrcHasNoData, fSrcNoDataValue)};
+
+            pafOutputBuf[j] =
+                ComputeVal(bOneOfThreeLinesHasNoData, fSrcNoDataValue,
+                           bIsSrcNoDataNan, afWin, fDstNoDataValue, pfnAlg,
+                           pData, bComputeAtEdges);
+        }
+        else
+        {
+            // Exclude the edges
+            if (nXSize > 1)
+                pafOutputBuf[nXSize - 1] = fDstNoDataValue;
+        }
+    }
+}
+
+/************************************************************************/
+/*                  GDALGeneric3x3ProcessingOutput                      */
+/************************************************************************/
+
+// Output computed by GDALGeneric3x3Processing(): either the result of a 3x3
+// algorithm written into hDstBand, or a function called on each batch of
+// source lines (starting at line nYOff) read for the other outputs.
+template <class T> struct GDALGeneric3x3ProcessingOutput
+{
+    GDALRasterBandH hDstBand = nullptr;
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg = nullptr;
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+        pfnAlg_multisample = nullptr;
+    void *pData = nullptr;
+    bool bComputeAtEdges = false;
+    std::function<CPLErr(const T *pafLines, int nYOff, int nLines)>
+        pfnLinesFunc{};
+};
+
 /************************************************************************/
 /*                  GDALGeneric3x3Processing()                          */
 /************************************************************************/
 
+// Compute several outputs from a single read of hSrcBand.
 template <class T>
 static CPLErr GDALGeneric3x3Processing(
-    GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand,
-    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg,
-    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
-        pfnAlg_multisample,
-    void *pData, bool bComputeAtEdges, GDALProgressFunc pfnProgress,
-    void *pProgressData)
+    GDALRasterBandH hSrcBand,
+    const std::vector<GDALGeneric3x3ProcessingOutput<T>> &aoOutputs,
+    GDALProgressFunc pfnProgress, void *pProgressData)
 {
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
@@ -321,17 +522,22 @@ static CPLErr GDALGeneric3x3Processing(
     const int nYSize = GDALGetRasterBandYSize(hSrcBand);
 
     // 1 line destination buffer.
-    float *pafOutputBuf =
-        static_cast<float *>(VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
-    // 3 line rotating source buffer.
-    T *pafThreeLineWin =
-        static_cast<T *>(VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize + 1));
-    if (pafOutputBuf == nullptr || pafThreeLineWin == nullptr)
-    {
-        VSIFree(pafOutputBuf);
-        VSIFree(pafThreeLineWin);
+    std::vector<float> afOutputBuf;
+    // 3 line source buffer, used for the top and bottom edges.
+    std::vector<T> afThreeLineWin;
+    try
+    {
+        afOutputBuf.resize(nXSize);
+        afThreeLineWin.resize(3 * (static_cast<size_t>(nXSize) + 1));
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate working buffers");
         return CE_Failure;
     }
+    float *pafOutputBuf = afOutputBuf.data();
+    T *pafThreeLineWin = afThreeLineWin.data();
 
     GDALDataType eReadDT;
     int bSrcHasNoData = FALSE;
@@ -373,15 +579,20 @@ static CPLErr GDALGeneric3x3Processing(
         bIsSrcNoDataNan = bSrcHasNoData && CPLIsNan(dfNoDataValue);
     }
 
-    int bDstHasNoData = FALSE;
-    float fDstNoDataValue =
-        static_cast<float>(GDALGetRasterNoDataValue(hDstBand, &bDstHasNoData));
-    if (!bDstHasNoData)
-        fDstNoDataValue = 0.0;
-
-    int nLine1Off = 0;
-    int nLine2Off = nXSize;
-    int nLine3Off = 2 * nXSize;
+    std::vector<float> afDstNoDataValue;
+    for (const auto &oOutput : aoOutputs)
+    {
+        int bDstHasNoData = FALSE;
+        float fDstNoDataValue = 0.0;
+        if (oOutput.hDstBand)
+        {
+            fDstNoDataValue = static_cast<float>(
+                GDALGetRasterNoDataValue(oOutput.hDstBand, &bDstHasNoData));
+            if (!bDstHasNoData)
+                fDstNoDataValue = 0.0;
+        }
+        afDstNoDataValue.push_back(fDstNoDataValue);
+    }
 
     // Move a 3x3 pafWindow over each cell
     // (where the cell in question is #4)
@@ -392,10 +603,6 @@ static CPLErr GDALGeneric3x3Processing(
 
     /* Preload the first 2 lines */
 
-    bool abLineHasNoDataValue[3] = {CPL_TO_BOOL(bSrcHasNoData),
-                                    CPL_TO_BOOL(bSrcHasNoData),
-                                    CPL_TO_BOOL(bSrcHasNoData)};
-
     // Create an extra scope for VC12 to ignore i.
     {
         for (int i = 0; i < 2 && i < nYSize; i++)
@@ -404,294 +611,266 @@ static CPLErr GDALGeneric3x3Processing(
                              pafThreeLineWin + i * nXSize, nXSize, 1, eReadDT,
                              0, 0) != CE_None)
             {
-                CPLFree(pafOutputBuf);
-                CPLFree(pafThreeLineWin);
-
                 return CE_Failure;
             }
-            if (std::numeric_limits<T>::is_integer && bSrcHasNoData)
-            {
-                abLineHasNoDataValue[i] = false;
-                for (int iX = 0; iX < nXSize; iX++)
-                {
-                    if (pafThreeLineWin[i * nXSize + iX] == fSrcNoDataValue)
-                    {
-                        abLineHasNoDataValue[i] = true;
-                        break;
-                    }
-                }
-            }
         }
     }  // End extra scope for VC12
 
     CPLErr eErr = CE_None;
-    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
-    {
-        for (int j = 0; j < nXSize; j++)
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                INTERPOL(pafThreeLineWin[jmin], pafThreeLineWin[nXSize + jmin],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[j], pafThreeLineWin[nXSize + j],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[jmax], pafThreeLineWin[nXSize + jmax],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[jmin],
-                pafThreeLineWin[j],
-                pafThreeLineWin[jmax],
-                pafThreeLineWin[nXSize + jmin],
-                pafThreeLineWin[nXSize + j],
-                pafThreeLineWin[nXSize + jmax]};
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue,
-                           CPL_TO_BOOL(bIsSrcNoDataNan), afWin, fDstNoDataValue,
-                           pfnAlg, pData, bComputeAtEdges);
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-    }
-    else
+    for (size_t iOutput = 0; iOutput < aoOutputs.size(); iOutput++)
     {
-        // Exclude the edges
-        for (int j = 0; j < nXSize; j++)
+        const auto &oOutput = aoOutputs[iOutput];
+        const GDALRasterBandH hDstBand = oOutput.hDstBand;
+        const float fDstNoDataValue = afDstNoDataValue[iOutput];
+        const auto pfnAlg = oOutput.pfnAlg;
+        void *pData = oOutput.pData;
+        const bool bComputeAtEdges = oOutput.bComputeAtEdges;
+
+        if (oOutput.pfnLinesFunc)
         {
-            pafOutputBuf[j] = fDstNoDataValue;
+            eErr = oOutput.pfnLinesFunc(pafThreeLineWin, 0, 1);
         }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
+        else if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
+        {
+            for (int j = 0; j < nXSize; j++)
+            {
+                int jmin = (j == 0) ? j : j - 1;
+                int jmax = (j == nXSize - 1) ? j : j + 1;
 
-        if (eErr == CE_None && nYSize > 1)
+                T afWin[9] = {INTERPOL(pafThreeLineWin[jmin],
+                                       pafThreeLineWin[nXSize + jmin],
+                                       bSrcHasNoData, fSrcNoDataValue),
+                              INTERPOL(pafThreeLineWin[j],
+                                       pafThreeLineWin[nXSize + j],
+                                       bSrcHasNoData, fSrcNoDataValue),
+                              INTERPOL(pafThreeLineWin[jmax],
+                                       pafThreeLineWin[nXSize + jmax],
+                                       bSrcHasNoData, fSrcNoDataValue),
+                              pafThreeLineWin[jmin],
+                              pafThreeLineWin[j],
+                              pafThreeLineWin[jmax],
+                              pafThreeLineWin[nXSize + jmin],
+                              pafThreeLineWin[nXSize + j],
+                              pafThreeLineWin[nXSize + jmax]};
+                pafOutputBuf[j] = ComputeVal(
+                    CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue,
+                    CPL_TO_BOOL(bIsSrcNoDataNan), afWin, fDstNoDataValue,
+                    pfnAlg, pData, bComputeAtEdges);
+            }
+            eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1,
+                                pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
+        }
+        else
         {
-            eErr = GDALRasterIO(hDstBand, GF_Write, 0, nYSize - 1, nXSize, 1,
+            // Exclude the edges
+            for (int j = 0; j < nXSize; j++)
+            {
+                pafOutputBuf[j] = fDstNoDataValue;
+            }
+            eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1,
                                 pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
+
+            if (eErr == CE_None && nYSize > 1)
+            {
+                eErr = GDALRasterIO(hDstBand, GF_Write, 0, nYSize - 1, nXSize,
+                                    1, pafOutputBuf, nXSize, 1, GDT_Float32, 0,
+                                    0);
+            }
         }
+        if (eErr != CE_None)
+            return eErr;
     }
-    if (eErr != CE_None)
-    {
-        CPLFree(pafOutputBuf);
-        CPLFree(pafThreeLineWin);
 
-        return eErr;
+    /* -------------------------------------------------------------------- */
+    /*      Process the interior lines by batches, each one being read      */
+    /*      with the lines above and below it, and split among jobs.        */
+    /* -------------------------------------------------------------------- */
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads =
+        std::max(1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                                      ? CPLGetNumCPUs()
+                                      : atoi(pszNumThreads)));
+    const int nBatchLines = std::max(
+        1, std::min(std::max(nYSize - 2, 1),
+                    std::max(nThreads, 1024 * 1024 / std::max(1, nXSize))));
+
+    std::vector<T> afBatchLines;
+    std::vector<float> afBatchOutput;
+    try
+    {
+        if (nYSize > 2)
+        {
+            // One extra value for SIMD loads at the end of the last line.
+            afBatchLines.resize(static_cast<size_t>(nBatchLines + 2) * nXSize +
+                                1);
+            afBatchOutput.resize(static_cast<size_t>(nBatchLines) * nXSize);
+        }
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate working buffers");
+        return CE_Failure;
     }
 
-    int i = 1;  // Used after for.
-    for (; i < nYSize - 1; i++)
+    auto poPool = nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    std::vector<GDALGeneric3x3ProcessingJob<T>> asJobs(nThreads);
+
+    for (int iStart = 1; iStart < nYSize - 1;)
     {
-        /* Read third line of the line buffer */
-        eErr =
-            GDALRasterIO(hSrcBand, GF_Read, 0, i + 1, nXSize, 1,
-                         pafThreeLineWin + nLine3Off, nXSize, 1, eReadDT, 0, 0);
+        const int nLines = std::min(nBatchLines, nYSize - 1 - iStart);
+        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iStart - 1, nXSize,
+                            nLines + 2, afBatchLines.data(), nXSize,
+                            nLines + 2, eReadDT, 0, 0);
         if (eErr != CE_None)
-        {
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
-
             return eErr;
-        }
 
-        // In case none of the 3 lines have nodata values, then no need to
-        // check it in ComputeVal()
-        bool bOneOfThreeLinesHasNoData = CPL_TO_BOOL(bSrcHasNoData);
-        if (std::numeric_limits<T>::is_integer && bSrcHasNoData)
+        for (size_t iOutput = 0; iOutput < aoOutputs.size(); iOutput++)
         {
-            bool bLastLineHasNoDataValue = false;
-            int iX = 0;
-            for (; iX + 3 < nXSize; iX += 4)
+            const auto &oOutput = aoOutputs[iOutput];
+            if (oOutput.pfnLinesFunc)
             {
-                if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 1] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 2] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 3] == fSrcNoDataValue)
-                {
-                    bLastLineHasNoDataValue = true;
-                    break;
-                }
+                eErr = oOutput.pfnLinesFunc(afBatchLines.data() + nXSize,
+                                            iStart, nLines);
+                if (eErr != CE_None)
+                    return eErr;
+                continue;
             }
-            if (!bLastLineHasNoDataValue)
+
+            const int nJobs = std::min(nThreads, nLines);
+            for (int iJob = 0; iJob < nJobs; iJob++)
             {
-                for (; iX < nXSize; iX++)
-                {
-                    if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue)
-                    {
-                        bLastLineHasNoDataValue = true;
-                    }
-                }
+                const int iJobStart = static_cast<int>(
+                    static_cast<GIntBig>(nLines) * iJob / nJobs);
+                const int iJobEnd = static_cast<int>(
+                    static_cast<GIntBig>(nLines) * (iJob + 1) / nJobs);
+                const size_t nOffset = static_cast<size_t>(iJobStart) * nXSize;
+                GDALGeneric3x3ProcessingJob<T> &sJob = asJobs[iJob];
+                sJob.pafLines = afBatchLines.data() + nOffset;
+                sJob.pafOutput = afBatchOutput.data() + nOffset;
+                sJob.nXSize = nXSize;
+                sJob.nLines = iJobEnd - iJobStart;
+                sJob.bSrcHasNoData = CPL_TO_BOOL(bSrcHasNoData);
+                sJob.fSrcNoDataValue = fSrcNoDataValue;
+                sJob.bIsSrcNoDataNan = CPL_TO_BOOL(bIsSrcNoDataNan);
+                sJob.fDstNoDataValue = afDstNoDataValue[iOutput];
+                sJob.pfnAlg = oOutput.pfnAlg;
+                sJob.pfnAlg_multisample = oOutput.pfnAlg_multisample;
+                sJob.pData = oOutput.pData;
+                sJob.bComputeAtEdges = oOutput.bComputeAtEdges;
+                if (poQueue)
+                    poQueue->SubmitJob(GDALGeneric3x3ProcessingJobFunc<T>,
+                                       &sJob);
+                else
+                    GDALGeneric3x3ProcessingJobFunc<T>(&sJob);
             }
-            abLineHasNoDataValue[nLine3Off / nXSize] = bLastLineHasNoDataValue;
-
-            bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
-                                        abLineHasNoDataValue[1] ||
-                                        abLineHasNoDataValue[2];
-        }
-
-        if (bComputeAtEdges && nXSize >= 2)
-        {
-            int j = 0;
-            T afWin[9] = {INTERPOL(pafThreeLineWin[nLine1Off + j],
-                                   pafThreeLineWin[nLine1Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine1Off + j],
-                          pafThreeLineWin[nLine1Off + j + 1],
-                          INTERPOL(pafThreeLineWin[nLine2Off + j],
-                                   pafThreeLineWin[nLine2Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine2Off + j],
-                          pafThreeLineWin[nLine2Off + j + 1],
-                          INTERPOL(pafThreeLineWin[nLine3Off + j],
-                                   pafThreeLineWin[nLine3Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine3Off + j],
-                          pafThreeLineWin[nLine3Off + j + 1]};
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            pafOutputBuf[0] = fDstNoDataValue;
-        }
-
-        int j = 1;
-        if (pfnAlg_multisample && !bOneOfThreeLinesHasNoData)
-        {
-            j = pfnAlg_multisample(pafThreeLineWin, nLine1Off, nLine2Off,
-                                   nLine3Off, nXSize, pData, pafOutputBuf);
+            if (poQueue)
+                poQueue->WaitCompletion();
+
+            /* -----------------------------------------
+             * Write Lines to Raster
+             */
+            eErr = GDALRasterIO(oOutput.hDstBand, GF_Write, 0, iStart, nXSize,
+                                nLines, afBatchOutput.data(), nXSize, nLines,
+                                GDT_Float32, 0, 0);
+            if (eErr != CE_None)
+                return eErr;
         }
 
-        for (; j < nXSize - 1; j++)
+        iStart += nLines;
+        if (!pfnProgress(1.0 * iStart / nYSize, nullptr, pProgressData))
         {
-            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
-                          pafThreeLineWin[nLine1Off + j],
-                          pafThreeLineWin[nLine1Off + j + 1],
-                          pafThreeLineWin[nLine2Off + j - 1],
-                          pafThreeLineWin[nLine2Off + j],
-                          pafThreeLineWin[nLine2Off + j + 1],
-                          pafThreeLineWin[nLine3Off + j - 1],
-                          pafThreeLineWin[nLine3Off + j],
-                          pafThreeLineWin[nLine3Off + j + 1]};
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
         }
 
-        if (bComputeAtEdges && nXSize >= 2)
+        if (iStart == nYSize - 1)
         {
-            j = nXSize - 1;
-
-            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
-                          pafThreeLineWin[nLine1Off + j],
-                          INTERPOL(pafThreeLineWin[nLine1Off + j],
-                                   pafThreeLineWin[nLine1Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine2Off + j - 1],
-                          pafThreeLineWin[nLine2Off + j],
-                          INTERPOL(pafThreeLineWin[nLine2Off + j],
-                                   pafThreeLineWin[nLine2Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine3Off + j - 1],
-                          pafThreeLineWin[nLine3Off + j],
-                          INTERPOL(pafThreeLineWin[nLine3Off + j],
-                                   pafThreeLineWin[nLine3Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue)};
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
+            // Keep the last two lines for the bottom edge.
+            memcpy(pafThreeLineWin,
+                   afBatchLines.data() + static_cast<size_t>(nLines) * nXSize,
+                   2 * nXSize * sizeof(T));
         }
-        else
-        {
-            // Exclude the edges
-            if (nXSize > 1)
-                pafOutputBuf[nXSize - 1] = fDstNoDataValue;
-        }
-
-        /* -----------------------------------------
-         * Write Line to Raster
-         */
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, i, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-        if (eErr != CE_None)
-        {
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
+    }
 
-            return eErr;
-        }
+    const int nLine1Off = 0;
+    const int nLine2Off = nXSize;
+    const int i = nYSize - 1;
 
-        if (!pfnProgress(1.0 * (i + 1) / nYSize, nullptr, pProgressData))
+    for (size_t iOutput = 0; iOutput < aoOutputs.size(); iOutput++)
+    {
+        const auto &oOutput = aoOutputs[iOutput];
+        const GDALRasterBandH hDstBand = oOutput.hDstBand;
+        const float fDstNoDataValue = afDstNoDataValue[iOutput];
+        const auto pfnAlg = oOutput.pfnAlg;
+        void *pData = oOutput.pData;
+        const bool bComputeAtEdges = oOutput.bComputeAtEdges;
+
+        if (oOutput.pfnLinesFunc)
         {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            eErr = CE_Failure;
-
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
-
-            return eErr;
+            if (nYSize >= 2)
+                eErr = oOutput.pfnLinesFunc(pafThreeLineWin + nLine2Off, i, 1);
         }
-
-        const int nTemp = nLine1Off;
-        nLine1Off = nLine2Off;
-        nLine2Off = nLine3Off;
-        nLine3Off = nTemp;
-    }
-
-    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
-    {
-        for (int j = 0; j < nXSize; j++)
+        else if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
         {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + jmin],
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + jmax],
-                pafThreeLineWin[nLine2Off + jmin],
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + jmax],
-                INTERPOL(pafThreeLineWin[nLine2Off + jmin],
-                         pafThreeLineWin[nLine1Off + jmin], bSrcHasNoData,
-                         fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine1Off + j], bSrcHasNoData,
-                         fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + jmax],
-                         pafThreeLineWin[nLine1Off + jmax], bSrcHasNoData,
-                         fSrcNoDataValue),
-            };
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue,
-                           CPL_TO_BOOL(bIsSrcNoDataNan), afWin, fDstNoDataValue,
-                           pfnAlg, pData, bComputeAtEdges);
+            for (int j = 0; j < nXSize; j++)
+            {
+                int jmin = (j == 0) ? j : j - 1;
+                int jmax = (j == nXSize - 1) ? j : j + 1;
+
+                T afWin[9] = {
+                    pafThreeLineWin[nLine1Off + jmin],
+                    pafThreeLineWin[nLine1Off + j],
+                    pafThreeLineWin[nLine1Off + jmax],
+                    pafThreeLineWin[nLine2Off + jmin],
+                    pafThreeLineWin[nLine2Off + j],
+                    pafThreeLineWin[nLine2Off + jmax],
+                    INTERPOL(pafThreeLineWin[nLine2Off + jmin],
+                             pafThreeLineWin[nLine1Off + jmin], bSrcHasNoData,
+                             fSrcNoDataValue),
+                    INTERPOL(pafThreeLineWin[nLine2Off + j],
+                             pafThreeLineWin[nLine1Off + j], bSrcHasNoData,
+                             fSrcNoDataValue),
+                    INTERPOL(pafThreeLineWin[nLine2Off + jmax],
+                             pafThreeLineWin[nLine1Off + jmax], bSrcHasNoData,
+                             fSrcNoDataValue),
+                };
+
+                pafOutputBuf[j] = ComputeVal(
+                    CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue,
+                    CPL_TO_BOOL(bIsSrcNoDataNan), afWin, fDstNoDataValue,
+                    pfnAlg, pData, bComputeAtEdges);
+            }
+            eErr = GDALRasterIO(hDstBand, GF_Write, 0, i, nXSize, 1,
+                                pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
         }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, i, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
         if (eErr != CE_None)
-        {
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
-
             return eErr;
-        }
     }
 
     pfnProgress(1.0, nullptr, pProgressData);
-    eErr = CE_None;
 
-    CPLFree(pafOutputBuf);
-    CPLFree(pafThreeLineWin);
+    return CE_None;
+}
 
-    return eErr;
+template <class T>
+static CPLErr GDALGeneric3x3Processing(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand,
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg,
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+        pfnAlg_multisample,
+    void *pData, bool bComputeAtEdges, GDALProgressFunc pfnProgress,
+    void *pProgressData)
+{
+    std::vector<GDALGeneric3x3ProcessingOutput<T>> aoOutputs(1);
+    aoOutputs[0].hDstBand = hDstBand;
+    aoOutputs[0].pfnAlg = pfnAlg;
+    aoOutputs[0].pfnAlg_multisample = pfnAlg_multisample;
+    aoOutputs[0].pData = pData;
+    aoOutputs[0].bComputeAtEdges = bComputeAtEdges;
+    return GDALGeneric3x3Processing<T>(hSrcBand, aoOutputs, pfnProgress,
+                                       pProgressData);
 }
 
 /************************************************************************/
@@ -978,7 +1157,8 @@ template <class T>
 static int
 GDALHillshadeAlg_same_res_multisample(const T *pafThreeLineWin, int nLine1Off,
                                       int nLine2Off, int nLine3Off, int nXSize,
-                                      void *pData, float *pafOutputBuf)
+                                      float /*fDstNoDataValue*/, void *pData,
+                                      float *pafOutputBuf)
 {
     // Only valid for T == int
 
@@ -1322,27 +1502,135 @@ static void *GDALCreateSlopeData(double *adfGeoTransform, double scale,
     return pData;
 }
 
+#ifdef HAVE_16_SSE_REG
 /************************************************************************/
-/*                         GDALAspect()                                 */
+/*                          GDALGradient4Int32()                        */
+/*                                                                      */
+/*      (left - right) and (bottom - top) differences of the Horn or    */
+/*      Zevenbergen-Thorne gradients of 4 consecutive pixels, whose     */
+/*      left neighbours are at the start of the 3 lines.                */
 /************************************************************************/
 
-typedef struct
+template <GradientAlg alg>
+static inline void GDALGradient4Int32(const GInt32 *firstLine,
+                                      const GInt32 *secondLine,
+                                      const GInt32 *thirdLine, __m128i &accX,
+                                      __m128i &accY)
 {
-    bool bAngleAsAzimuth;
-} GDALAspectAlgData;
+    const __m128i firstLine1 =
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(firstLine + 1));
+    const __m128i thirdLine1 =
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(thirdLine + 1));
+    const __m128i secondLine0 =
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(secondLine));
+    const __m128i secondLine2 =
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(secondLine + 2));
+    if (alg == GradientAlg::HORN)
+    {
+        const __m128i firstLine0 =
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(firstLine));
+        const __m128i firstLine2 =
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(firstLine + 2));
+        const __m128i thirdLine0 =
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(thirdLine));
+        const __m128i thirdLine2 =
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(thirdLine + 2));
+        // (0 + 3 + 3 + 6) - (2 + 5 + 5 + 8)
+        accX = _mm_sub_epi32(
+            _mm_add_epi32(_mm_add_epi32(firstLine0, thirdLine0),
+                          _mm_add_epi32(secondLine0, secondLine0)),
+            _mm_add_epi32(_mm_add_epi32(firstLine2, thirdLine2),
+                          _mm_add_epi32(secondLine2, secondLine2)));
+        // (6 + 7 + 7 + 8) - (0 + 1 + 1 + 2)
+        accY = _mm_sub_epi32(
+            _mm_add_epi32(_mm_add_epi32(thirdLine0, thirdLine2),
+                          _mm_add_epi32(thirdLine1, thirdLine1)),
+            _mm_add_epi32(_mm_add_epi32(firstLine0, firstLine2),
+                          _mm_add_epi32(firstLine1, firstLine1)));
+    }
+    else
+    {
+        // 3 - 5 and 7 - 1
+        accX = _mm_sub_epi32(secondLine0, secondLine2);
+        accY = _mm_sub_epi32(thirdLine1, firstLine1);
+    }
+}
 
-template <class T>
-static float GDALAspectAlg(const T *afWin, float fDstNoDataValue, void *pData)
+template <class T, GradientAlg alg>
+static int GDALSlopeAlg_multisample(const T *pafThreeLineWin, int nLine1Off,
+                                    int nLine2Off, int nLine3Off, int nXSize,
+                                    float /*fDstNoDataValue*/, void *pData,
+                                    float *pafOutputBuf)
 {
-    const GDALAspectAlgData *psData =
-        static_cast<const GDALAspectAlgData *>(pData);
+    // Only valid for T == int
 
-    const double dx = ((afWin[2] + afWin[5] + afWin[5] + afWin[8]) -
-                       (afWin[0] + afWin[3] + afWin[3] + afWin[6]));
+    const GDALSlopeAlgData *psData =
+        static_cast<const GDALSlopeAlgData *>(pData);
+    const __m128d reg_ewres = _mm_set1_pd(psData->ewres);
+    const __m128d reg_nsres = _mm_set1_pd(psData->nsres);
+    const double dfDivisor =
+        (alg == GradientAlg::HORN ? 8 : 2) * psData->scale;
+    const __m128d reg_divisor = _mm_set1_pd(dfDivisor);
+    const __m128d reg_hundred = _mm_set1_pd(100);
 
-    const double dy = ((afWin[6] + afWin[7] + afWin[7] + afWin[8]) -
-                       (afWin[0] + afWin[1] + afWin[1] + afWin[2]));
+    int j = 1;  // Used after for.
+    for (; j < nXSize - 4; j += 4)
+    {
+        __m128i accX, accY;
+        GDALGradient4Int32<alg>(pafThreeLineWin + nLine1Off + j - 1,
+                                pafThreeLineWin + nLine2Off + j - 1,
+                                pafThreeLineWin + nLine3Off + j - 1, accX,
+                                accY);
+
+        const __m128d reg_x0 = _mm_div_pd(_mm_cvtepi32_pd(accX), reg_ewres);
+        const __m128d reg_x1 =
+            _mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(accX, 8)), reg_ewres);
+        const __m128d reg_y0 = _mm_div_pd(_mm_cvtepi32_pd(accY), reg_nsres);
+        const __m128d reg_y1 =
+            _mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(accY, 8)), reg_nsres);
+        const __m128d reg_sqrt_key0 = _mm_sqrt_pd(
+            _mm_add_pd(_mm_mul_pd(reg_x0, reg_x0), _mm_mul_pd(reg_y0, reg_y0)));
+        const __m128d reg_sqrt_key1 = _mm_sqrt_pd(
+            _mm_add_pd(_mm_mul_pd(reg_x1, reg_x1), _mm_mul_pd(reg_y1, reg_y1)));
+
+        if (psData->slopeFormat == 1)
+        {
+            double adfSqrtKey[4];
+            _mm_storeu_pd(adfSqrtKey, reg_sqrt_key0);
+            _mm_storeu_pd(adfSqrtKey + 2, reg_sqrt_key1);
+            for (int k = 0; k < 4; k++)
+            {
+                pafOutputBuf[j + k] =
+                    static_cast<float>(atan(adfSqrtKey[k] / dfDivisor) *
+                                       kdfRadiansToDegrees);
+            }
+        }
+        else
+        {
+            const __m128 res = _mm_castsi128_ps(_mm_unpacklo_epi64(
+                _mm_castps_si128(_mm_cvtpd_ps(_mm_mul_pd(
+                    reg_hundred, _mm_div_pd(reg_sqrt_key0, reg_divisor)))),
+                _mm_castps_si128(_mm_cvtpd_ps(_mm_mul_pd(
+                    reg_hundred, _mm_div_pd(reg_sqrt_key1, reg_divisor))))));
+            _mm_storeu_ps(pafOutputBuf + j, res);
+        }
+    }
+    return j;
+}
+#endif
+
+/************************************************************************/
+/*                         GDALAspect()                                 */
+/************************************************************************/
+
+typedef struct
+{
+    bool bAngleAsAzimuth;
+} GDALAspectAlgData;
 
+static float GDALAspectFromGradient(double dx, double dy, float fDstNoDataValue,
+                                    bool bAngleAsAzimuth)
+{
     float aspect = static_cast<float>(atan2(dy, -dx) / kdfDegreesToRadians);
 
     if (dx == 0 && dy == 0)
@@ -1350,7 +1638,7 @@ static float GDALAspectAlg(const T *afWin, float fDstNoDataValue, void *pData)
         /* Flat area */
         aspect = fDstNoDataValue;
     }
-    else if (psData->bAngleAsAzimuth)
+    else if (bAngleAsAzimuth)
     {
         if (aspect > 90.0f)
             aspect = 450.0f - aspect;
@@ -1369,6 +1657,22 @@ static float GDALAspectAlg(const T *afWin, float fDstNoDataValue, void *pData)
     return aspect;
 }
 
+template <class T>
+static float GDALAspectAlg(const T *afWin, float fDstNoDataValue, void *pData)
+{
+    const GDALAspectAlgData *psData =
+        static_cast<const GDALAspectAlgData *>(pData);
+
+    const double dx = ((afWin[2] + afWin[5] + afWin[5] + afWin[8]) -
+                       (afWin[0] + afWin[3] + afWin[3] + afWin[6]));
+
+    const double dy = ((afWin[6] + afWin[7] + afWin[7] + afWin[8]) -
+                       (afWin[0] + afWin[1] + afWin[1] + afWin[2]));
+
+    return GDALAspectFromGradient(dx, dy, fDstNoDataValue,
+                                  psData->bAngleAsAzimuth);
+}
+
 template <class T>
 static float GDALAspectZevenbergenThorneAlg(const T *afWin,
                                             float fDstNoDataValue, void *pData)
@@ -1378,30 +1682,43 @@ static float GDALAspectZevenbergenThorneAlg(const T *afWin,
 
     const double dx = afWin[5] - afWin[3];
     const double dy = afWin[7] - afWin[1];
-    float aspect = static_cast<float>(atan2(dy, -dx) / kdfDegreesToRadians);
-    if (dx == 0 && dy == 0)
-    {
-        /* Flat area */
-        aspect = fDstNoDataValue;
-    }
-    else if (psData->bAngleAsAzimuth)
-    {
-        if (aspect > 90.0f)
-            aspect = 450.0f - aspect;
-        else
-            aspect = 90.0f - aspect;
-    }
-    else
-    {
-        if (aspect < 0)
-            aspect += 360.0f;
-    }
+    return GDALAspectFromGradient(dx, dy, fDstNoDataValue,
+                                  psData->bAngleAsAzimuth);
+}
 
-    if (aspect == 360.0f)
-        aspect = 0.0;
+#ifdef HAVE_16_SSE_REG
+template <class T, GradientAlg alg>
+static int GDALAspectAlg_multisample(const T *pafThreeLineWin, int nLine1Off,
+                                     int nLine2Off, int nLine3Off, int nXSize,
+                                     float fDstNoDataValue, void *pData,
+                                     float *pafOutputBuf)
+{
+    // Only valid for T == int
 
-    return aspect;
+    const GDALAspectAlgData *psData =
+        static_cast<const GDALAspectAlgData *>(pData);
+
+    int j = 1;  // Used after for.
+    for (; j < nXSize - 4; j += 4)
+    {
+        __m128i accX, accY;
+        GDALGradient4Int32<alg>(pafThreeLineWin + nLine1Off + j - 1,
+                                pafThreeLineWin + nLine2Off + j - 1,
+                                pafThreeLineWin + nLine3Off + j - 1, accX,
+                                accY);
+        GInt32 anX[4];
+        GInt32 anY[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(anX), accX);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(anY), accY);
+        for (int k = 0; k < 4; k++)
+        {
+            pafOutputBuf[j + k] = GDALAspectFromGradient(
+                -anX[k], anY[k], fDstNoDataValue, psData->bAngleAsAzimuth);
+        }
+    }
+    return j;
 }
+#endif
 
 static void *GDALCreateAspectData(bool bAngleAsAzimuth)
 {
@@ -2412,6 +2729,114 @@ GDALColorRelief(GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand1,
     return CE_None;
 }
 
+/************************************************************************/
+/*                     GDALColorReliefLinesWriter                       */
+/************************************************************************/
+
+// Computes the color-relief of batches of source lines read by
+// GDALGeneric3x3Processing() for other outputs, so that the source is read
+// only once.
+class GDALColorReliefLinesWriter
+{
+    GDALDatasetH m_hDstDS = nullptr;
+    int m_nDstBands = 0;
+    ColorAssociation *m_pasColorAssociation = nullptr;
+    int m_nColorAssociation = 0;
+    ColorSelectionMode m_eColorSelectionMode = COLOR_SELECTION_INTERPOLATE;
+    GByte *m_pabyPrecomputed = nullptr;
+    int m_nIndexOffset = 0;
+    std::vector<GByte> m_abyBuffer{};
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALColorReliefLinesWriter)
+
+  public:
+    GDALColorReliefLinesWriter() = default;
+    ~GDALColorReliefLinesWriter();
+
+    bool Init(GDALRasterBandH hSrcBand, GDALDatasetH hDstDS,
+              const char *pszColorFilename,
+              ColorSelectionMode eColorSelectionMode);
+
+    template <class T>
+    CPLErr Process(const T *pafLines, int nYOff, int nLines);
+};
+
+GDALColorReliefLinesWriter::~GDALColorReliefLinesWriter()
+{
+    VSIFree(m_pabyPrecomputed);
+    CPLFree(m_pasColorAssociation);
+}
+
+bool GDALColorReliefLinesWriter::Init(GDALRasterBandH hSrcBand,
+                                      GDALDatasetH hDstDS,
+                                      const char *pszColorFilename,
+                                      ColorSelectionMode eColorSelectionMode)
+{
+    m_hDstDS = hDstDS;
+    m_nDstBands = GDALGetRasterCount(hDstDS);
+    m_eColorSelectionMode = eColorSelectionMode;
+    m_pasColorAssociation = GDALColorReliefParseColorFile(
+        hSrcBand, pszColorFilename, &m_nColorAssociation);
+    if (m_pasColorAssociation == nullptr)
+        return false;
+    m_pabyPrecomputed = GDALColorReliefPrecompute(
+        hSrcBand, m_pasColorAssociation, m_nColorAssociation,
+        m_eColorSelectionMode, &m_nIndexOffset);
+    return true;
+}
+
+template <class T>
+CPLErr GDALColorReliefLinesWriter::Process(const T *pafLines, int nYOff,
+                                           int nLines)
+{
+    const int nXSize = GDALGetRasterXSize(m_hDstDS);
+    const size_t nBandSize = static_cast<size_t>(nXSize) * nLines;
+    try
+    {
+        m_abyBuffer.resize(4 * nBandSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate working buffer");
+        return CE_Failure;
+    }
+
+    GByte *pabyDestBuf1 = m_abyBuffer.data();
+    GByte *pabyDestBuf2 = pabyDestBuf1 + nBandSize;
+    GByte *pabyDestBuf3 = pabyDestBuf2 + nBandSize;
+    GByte *pabyDestBuf4 = pabyDestBuf3 + nBandSize;
+    for (size_t j = 0; j < nBandSize; j++)
+    {
+        if (m_pabyPrecomputed)
+        {
+            const int nIndex = static_cast<int>(pafLines[j]) + m_nIndexOffset;
+            pabyDestBuf1[j] = m_pabyPrecomputed[4 * nIndex];
+            pabyDestBuf2[j] = m_pabyPrecomputed[4 * nIndex + 1];
+            pabyDestBuf3[j] = m_pabyPrecomputed[4 * nIndex + 2];
+            pabyDestBuf4[j] = m_pabyPrecomputed[4 * nIndex + 3];
+        }
+        else
+        {
+            int nR = 0;
+            int nG = 0;
+            int nB = 0;
+            int nA = 0;
+            GDALColorReliefGetRGBA(m_pasColorAssociation, m_nColorAssociation,
+                                   static_cast<float>(pafLines[j]),
+                                   m_eColorSelectionMode, &nR, &nG, &nB, &nA);
+            pabyDestBuf1[j] = static_cast<GByte>(nR);
+            pabyDestBuf2[j] = static_cast<GByte>(nG);
+            pabyDestBuf3[j] = static_cast<GByte>(nB);
+            pabyDestBuf4[j] = static_cast<GByte>(nA);
+        }
+    }
+
+    return GDALDatasetRasterIO(m_hDstDS, GF_Write, 0, nYOff, nXSize, nLines,
+                               m_abyBuffer.data(), nXSize, nLines, GDT_Byte,
+                               m_nDstBands, nullptr, 0, 0, 0);
+}
+
 /************************************************************************/
 /*                     GDALGenerateVRTColorRelief()                     */
 /************************************************************************/
@@ -3170,40 +3595,41 @@ static Algorithm GetAlgorithm(const char *pszProcessing)
 }
 
 /************************************************************************/
-/*                            GDALDEMProcessing()                       */
+/*                      GDALDEMDeferredProcessing                       */
 /************************************************************************/
 
-/**
- * Apply a DEM processing.
- *
- * This is the equivalent of the <a href="/programs/gdaldem.html">gdaldem</a>
- * utility.
- *
- * GDALDEMProcessingOptions* must be allocated and freed with
- * GDALDEMProcessingOptionsNew() and GDALDEMProcessingOptionsFree()
- * respectively.
- *
- * @param pszDest the destination dataset path.
- * @param hSrcDataset the source dataset handle.
- * @param pszProcessing the processing to apply (one of "hillshade", "slope",
- * "aspect", "color-relief", "TRI", "TPI", "Roughness")
- * @param pszColorFilename color file (mandatory for "color-relief" processing,
- * should be NULL otherwise)
- * @param psOptionsIn the options struct returned by
- * GDALDEMProcessingOptionsNew() or NULL.
- * @param pbUsageError pointer to a integer output variable to store if any
- * usage error has occurred or NULL.
- * @return the output dataset (new dataset that must be closed using
- * GDALClose()) or NULL in case of error.
- *
- * @since GDAL 2.1
- */
+// Output dataset created by GDALDEMProcessingInternal(), whose values are
+// not computed yet, so that GDALDEMProcessingMulti() can compute it together
+// with other outputs from a single read of the source band.
+struct GDALDEMDeferredProcessing
+{
+    bool bDeferred = false;
+    Algorithm eUtilityMode = INVALID;
+    GDALDatasetH hDstDataset = nullptr;
+    GDALGeneric3x3ProcessingAlg<float>::type pfnAlgFloat = nullptr;
+    GDALGeneric3x3ProcessingAlg<GInt32>::type pfnAlgInt32 = nullptr;
+    GDALGeneric3x3ProcessingAlg_multisample<GInt32>::type
+        pfnAlgInt32_multisample = nullptr;
+    void *pData = nullptr;  // Owned.
+    bool bComputeAtEdges = false;
+    std::string osColorFilename{};
+    ColorSelectionMode eColorSelectionMode = COLOR_SELECTION_INTERPOLATE;
+};
 
-GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
-                               const char *pszProcessing,
-                               const char *pszColorFilename,
-                               const GDALDEMProcessingOptions *psOptionsIn,
-                               int *pbUsageError)
+/************************************************************************/
+/*                      GDALDEMProcessingInternal()                     */
+/************************************************************************/
+
+// If psDeferred is not NULL and the output dataset is directly created
+// (not through CreateCopy()), the processing is not run, but described in
+// *psDeferred.
+static GDALDatasetH
+GDALDEMProcessingInternal(const char *pszDest, GDALDatasetH hSrcDataset,
+                          const char *pszProcessing,
+                          const char *pszColorFilename,
+                          const GDALDEMProcessingOptions *psOptionsIn,
+                          int *pbUsageError,
+                          GDALDEMDeferredProcessing *psDeferred)
 {
     if (hSrcDataset == nullptr)
     {
@@ -3485,11 +3911,19 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
         {
             pfnAlgFloat = GDALSlopeZevenbergenThorneAlg<float>;
             pfnAlgInt32 = GDALSlopeZevenbergenThorneAlg<GInt32>;
+#ifdef HAVE_16_SSE_REG
+            pfnAlgInt32_multisample = GDALSlopeAlg_multisample<
+                GInt32, GradientAlg::ZEVENBERGEN_THORNE>;
+#endif
         }
         else
         {
             pfnAlgFloat = GDALSlopeHornAlg<float>;
             pfnAlgInt32 = GDALSlopeHornAlg<GInt32>;
+#ifdef HAVE_16_SSE_REG
+            pfnAlgInt32_multisample =
+                GDALSlopeAlg_multisample<GInt32, GradientAlg::HORN>;
+#endif
         }
     }
 
@@ -3506,11 +3940,19 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
         {
             pfnAlgFloat = GDALAspectZevenbergenThorneAlg<float>;
             pfnAlgInt32 = GDALAspectZevenbergenThorneAlg<GInt32>;
+#ifdef HAVE_16_SSE_REG
+            pfnAlgInt32_multisample = GDALAspectAlg_multisample<
+                GInt32, GradientAlg::ZEVENBERGEN_THORNE>;
+#endif
         }
         else
         {
             pfnAlgFloat = GDALAspectAlg<float>;
             pfnAlgInt32 = GDALAspectAlg<GInt32>;
+#ifdef HAVE_16_SSE_REG
+            pfnAlgInt32_multisample =
+                GDALAspectAlg_multisample<GInt32, GradientAlg::HORN>;
+#endif
         }
     }
     else if (eUtilityMode == TRI)
@@ -3703,6 +4145,27 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
     GDALSetGeoTransform(hDstDataset, adfGeoTransform);
     GDALSetProjection(hDstDataset, GDALGetProjectionRef(hSrcDataset));
 
+    if (eUtilityMode != COLOR_RELIEF && bDstHasNoData)
+        GDALSetRasterNoDataValue(hDstBand, dfDstNoDataValue);
+
+    if (psDeferred)
+    {
+        psDeferred->bDeferred = true;
+        psDeferred->eUtilityMode = eUtilityMode;
+        psDeferred->hDstDataset = hDstDataset;
+        psDeferred->pfnAlgFloat = pfnAlgFloat;
+        psDeferred->pfnAlgInt32 = pfnAlgInt32;
+        psDeferred->pfnAlgInt32_multisample = pfnAlgInt32_multisample;
+        psDeferred->pData = pData;
+        psDeferred->bComputeAtEdges = psOptions->bComputeAtEdges;
+        if (pszColorFilename)
+            psDeferred->osColorFilename = pszColorFilename;
+        psDeferred->eColorSelectionMode = psOptions->eColorSelectionMode;
+
+        GDALDEMProcessingOptionsFree(psOptionsToFree);
+        return hDstDataset;
+    }
+
     if (eUtilityMode == COLOR_RELIEF)
     {
         GDALColorRelief(hSrcBand, GDALGetRasterBand(hDstDataset, 1),
@@ -3715,9 +4178,6 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
     }
     else
     {
-        if (bDstHasNoData)
-            GDALSetRasterNoDataValue(hDstBand, dfDstNoDataValue);
-
         if (eSrcDT == GDT_Byte || eSrcDT == GDT_Int16 || eSrcDT == GDT_UInt16)
         {
             GDALGeneric3x3Processing<GInt32>(
@@ -3738,6 +4198,223 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
     return hDstDataset;
 }
 
+/************************************************************************/
+/*                            GDALDEMProcessing()                       */
+/************************************************************************/
+
+/**
+ * Apply a DEM processing.
+ *
+ * This is the equivalent of the <a href="/programs/gdaldem.html">gdaldem</a>
+ * utility.
+ *
+ * GDALDEMProcessingOptions* must be allocated and freed with
+ * GDALDEMProcessingOptionsNew() and GDALDEMProcessingOptionsFree()
+ * respectively.
+ *
+ * @param pszDest the destination dataset path.
+ * @param hSrcDataset the source dataset handle.
+ * @param pszProcessing the processing to apply (one of "hillshade", "slope",
+ * "aspect", "color-relief", "TRI", "TPI", "Roughness")
+ * @param pszColorFilename color file (mandatory for "color-relief" processing,
+ * should be NULL otherwise)
+ * @param psOptionsIn the options struct returned by
+ * GDALDEMProcessingOptionsNew() or NULL.
+ * @param pbUsageError pointer to a integer output variable to store if any
+ * usage error has occurred or NULL.
+ * @return the output dataset (new dataset that must be closed using
+ * GDALClose()) or NULL in case of error.
+ *
+ * @since GDAL 2.1
+ */
+
+GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
+                               const char *pszProcessing,
+                               const char *pszColorFilename,
+                               const GDALDEMProcessingOptions *psOptionsIn,
+                               int *pbUsageError)
+{
+    return GDALDEMProcessingInternal(pszDest, hSrcDataset, pszProcessing,
+                                     pszColorFilename, psOptionsIn,
+                                     pbUsageError, nullptr);
+}
+
+/************************************************************************/
+/*                     GDALDEMRunDeferredProcessings()                  */
+/************************************************************************/
+
+static void GDALDEMSetAlg(GDALGeneric3x3ProcessingOutput<GInt32> &oOutput,
+                          const GDALDEMDeferredProcessing &sDeferred)
+{
+    oOutput.pfnAlg = sDeferred.pfnAlgInt32;
+    oOutput.pfnAlg_multisample = sDeferred.pfnAlgInt32_multisample;
+}
+
+static void GDALDEMSetAlg(GDALGeneric3x3ProcessingOutput<float> &oOutput,
+                          const GDALDEMDeferredProcessing &sDeferred)
+{
+    oOutput.pfnAlg = sDeferred.pfnAlgFloat;
+}
+
+template <class T>
+static CPLErr GDALDEMRunDeferredProcessings(
+    GDALRasterBandH hSrcBand,
+    const std::vector<GDALDEMDeferredProcessing> &asDeferred,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    std::vector<std::unique_ptr<GDALColorReliefLinesWriter>> apoColorRelief;
+    std::vector<GDALGeneric3x3ProcessingOutput<T>> aoOutputs;
+    for (const auto &sDeferred : asDeferred)
+    {
+        if (!sDeferred.bDeferred)
+            continue;
+        GDALGeneric3x3ProcessingOutput<T> oOutput;
+        if (sDeferred.eUtilityMode == COLOR_RELIEF)
+        {
+            auto poWriter = std::make_unique<GDALColorReliefLinesWriter>();
+            if (!poWriter->Init(hSrcBand, sDeferred.hDstDataset,
+                                sDeferred.osColorFilename.c_str(),
+                                sDeferred.eColorSelectionMode))
+            {
+                return CE_Failure;
+            }
+            auto poWriterPtr = poWriter.get();
+            oOutput.pfnLinesFunc =
+                [poWriterPtr](const T *pafLines, int nYOff, int nLines)
+            { return poWriterPtr->Process(pafLines, nYOff, nLines); };
+            apoColorRelief.push_back(std::move(poWriter));
+        }
+        else
+        {
+            oOutput.hDstBand = GDALGetRasterBand(sDeferred.hDstDataset, 1);
+            GDALDEMSetAlg(oOutput, sDeferred);
+            oOutput.pData = sDeferred.pData;
+            oOutput.bComputeAtEdges = sDeferred.bComputeAtEdges;
+        }
+        aoOutputs.push_back(std::move(oOutput));
+    }
+    if (aoOutputs.empty())
+        return CE_None;
+    return GDALGeneric3x3Processing<T>(hSrcBand, aoOutputs, pfnProgress,
+                                       pProgressData);
+}
+
+/************************************************************************/
+/*                        GDALDEMProcessingMulti()                      */
+/************************************************************************/
+
+/**
+ * Apply several DEM processings to the same source.
+ *
+ * This is equivalent to calling GDALDEMProcessing() for each processing,
+ * except that the outputs that are directly created by their driver (that
+ * is not through CreateCopy(), nor as VRT) are computed together, from a
+ * single read of the source band.
+ *
+ * All options must select the same source band. The progress function of
+ * the first options is used for the computation of the outputs.
+ *
+ * @param nCount number of processings.
+ * @param papszDests array of nCount destination dataset paths.
+ * @param hSrcDataset the source dataset handle.
+ * @param papszProcessings array of nCount processings, with the values
+ * accepted by GDALDEMProcessing().
+ * @param papszColorFilenames array of nCount color files (the ones of the
+ * processings that are not "color-relief" being NULL), or NULL if there is no
+ * "color-relief" processing.
+ * @param papsOptions array of nCount options structs returned by
+ * GDALDEMProcessingOptionsNew() (or NULL), or NULL.
+ * @param pahDstDatasets (output) array of nCount dataset handles, set to the
+ * output datasets (new datasets that must be closed using GDALClose()) in
+ * case of success, and to NULL otherwise.
+ * @param pbUsageError pointer to a integer output variable to store if any
+ * usage error has occurred or NULL.
+ * @return TRUE in case of success.
+ *
+ * @since GDAL 3.9
+ */
+
+int GDALDEMProcessingMulti(int nCount, const char *const *papszDests,
+                           GDALDatasetH hSrcDataset,
+                           const char *const *papszProcessings,
+                           const char *const *papszColorFilenames,
+                           const GDALDEMProcessingOptions *const *papsOptions,
+                           GDALDatasetH *pahDstDatasets, int *pbUsageError)
+{
+    if (nCount <= 0 || papszDests == nullptr || papszProcessings == nullptr ||
+        pahDstDatasets == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Invalid arguments.");
+
+        if (pbUsageError)
+            *pbUsageError = TRUE;
+        return FALSE;
+    }
+
+    const auto GetOptions = [papsOptions](int i)
+    { return papsOptions ? papsOptions[i] : nullptr; };
+
+    const int nBand = GetOptions(0) ? GetOptions(0)->nBand : 1;
+    for (int i = 0; i < nCount; i++)
+    {
+        pahDstDatasets[i] = nullptr;
+        if ((GetOptions(i) ? GetOptions(i)->nBand : 1) != nBand)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "All processings must use the same source band");
+
+            if (pbUsageError)
+                *pbUsageError = TRUE;
+            return FALSE;
+        }
+    }
+
+    std::vector<GDALDEMDeferredProcessing> asDeferred(nCount);
+    bool bOK = true;
+    for (int i = 0; bOK && i < nCount; i++)
+    {
+        pahDstDatasets[i] = GDALDEMProcessingInternal(
+            papszDests[i], hSrcDataset, papszProcessings[i],
+            papszColorFilenames ? papszColorFilenames[i] : nullptr,
+            GetOptions(i), pbUsageError, &asDeferred[i]);
+        bOK = pahDstDatasets[i] != nullptr;
+    }
+
+    if (bOK)
+    {
+        GDALProgressFunc pfnProgress =
+            GetOptions(0) ? GetOptions(0)->pfnProgress : nullptr;
+        void *pProgressData =
+            GetOptions(0) ? GetOptions(0)->pProgressData : nullptr;
+        GDALRasterBandH hSrcBand = GDALGetRasterBand(hSrcDataset, nBand);
+        const GDALDataType eSrcDT = GDALGetRasterDataType(hSrcBand);
+        if (eSrcDT == GDT_Byte || eSrcDT == GDT_Int16 || eSrcDT == GDT_UInt16)
+        {
+            bOK = GDALDEMRunDeferredProcessings<GInt32>(
+                      hSrcBand, asDeferred, pfnProgress, pProgressData) ==
+                  CE_None;
+        }
+        else
+        {
+            bOK = GDALDEMRunDeferredProcessings<float>(
+                      hSrcBand, asDeferred, pfnProgress, pProgressData) ==
+                  CE_None;
+        }
+    }
+
+    for (int i = 0; i < nCount; i++)
+    {
+        CPLFree(asDeferred[i].pData);
+        if (!bOK && pahDstDatasets[i])
+        {
+            GDALClose(pahDstDatasets[i]);
+            pahDstDatasets[i] = nullptr;
+        }
+    }
+
+    return bOK;
+}
+
 /************************************************************************/
 /*                           GDALDEMProcessingOptionsNew()              */
 /************************************************************************/
@@ -37,6 +37,9 @@
 #include "commonutils.h"
 
 #include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
 
 /************************************************************************/
 /*                               Usage()                                */
@@ -459,23 +462,27 @@ MAIN_START(argc, argv)
     int nRetCode = 0;
 
     /* -------------------------------------------------------------------- */
-    /*      loop over GDAL files, processing.                               */
+    /*      Compute the names of files to write, and skip the ones already  */
+    /*      in the tileindex.                                               */
     /* -------------------------------------------------------------------- */
-    for (; nRetCode == 0 && iArg < argc; iArg++)
+    std::vector<int> anArgsToProcess;
+    std::vector<std::string> aosFilesToOpen;
+    std::vector<std::string> aosFileNamesToWrite;
+    for (; iArg < argc; iArg++)
     {
-        char *fileNameToWrite = nullptr;
+        std::string osFileNameToWrite;
         VSIStatBuf sStatBuf;
 
         // Make sure it is a file before building absolute path name.
         if (write_absolute_path && CPLIsFilenameRelative(argv[iArg]) &&
             VSIStat(argv[iArg], &sStatBuf) == 0)
         {
-            fileNameToWrite =
-                CPLStrdup(CPLProjectRelativeFilename(current_path, argv[iArg]));
+            osFileNameToWrite =
+                CPLProjectRelativeFilename(current_path, argv[iArg]);
         }
         else
         {
-            fileNameToWrite = CPLStrdup(argv[iArg]);
+            osFileNameToWrite = argv[iArg];
         }
 
         // Checks that file is not already in tileindex.
@@ -483,22 +490,47 @@ MAIN_START(argc, argv)
             int i = 0;  // Used after for.
             for (; i < nExistingFiles; i++)
             {
-                if (EQUAL(fileNameToWrite, existingFilesTab[i]))
+                if (EQUAL(osFileNameToWrite.c_str(), existingFilesTab[i]))
                 {
                     fprintf(stderr,
                             "File %s is already in tileindex. Skipping it.\n",
-                            fileNameToWrite);
+                            osFileNameToWrite.c_str());
                     break;
                 }
             }
             if (i != nExistingFiles)
             {
-                CPLFree(fileNameToWrite);
                 continue;
             }
         }
 
-        GDALDatasetH hDS = GDALOpen(argv[iArg], GA_ReadOnly);
+        anArgsToProcess.push_back(iArg);
+        aosFilesToOpen.push_back(argv[iArg]);
+        aosFileNamesToWrite.push_back(std::move(osFileNameToWrite));
+    }
+
+    // Open the files concurrently ahead of their processing, with
+    // GDAL_NUM_THREADS > 1.
+    std::unique_ptr<GDALDatasetOpenPrefetcher> poPrefetcher;
+    const int nThreads = GDALDatasetOpenPrefetcher::GetThreadCount();
+    if (nThreads > 1 && aosFilesToOpen.size() > 1)
+    {
+        poPrefetcher = std::make_unique<GDALDatasetOpenPrefetcher>(
+            aosFilesToOpen, GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR, nullptr,
+            nThreads);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      loop over GDAL files, processing.                               */
+    /* -------------------------------------------------------------------- */
+    for (size_t iFile = 0; nRetCode == 0 && iFile < anArgsToProcess.size();
+         iFile++)
+    {
+        iArg = anArgsToProcess[iFile];
+        char *fileNameToWrite = CPLStrdup(aosFileNamesToWrite[iFile].c_str());
+
+        GDALDatasetH hDS = poPrefetcher ? poPrefetcher->Get(iFile)
+                                        : GDALOpen(argv[iArg], GA_ReadOnly);
         if (hDS == nullptr)
         {
             fprintf(stderr, "Unable to open %s, skipping.\n", argv[iArg]);
@@ -44,17 +44,24 @@
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 #include "nearblack_lib.h"
 
-static void ProcessLine(GByte *pabyLine, GByte *pabyMask, int iStart, int iEnd,
-                        int nSrcBands, int nDstBands, int nNearDist,
-                        int nMaxNonBlack, bool bNearWhite,
-                        const Colors &oColors, int *panLastLineCounts,
-                        bool bDoHorizontalCheck, bool bDoVerticalCheck,
-                        bool bBottomUp, int iLineFromTopOrBottom);
+static void ProcessLineVertical(GByte *pabyLine, GByte *pabyMask, int iStart,
+                                int iEnd, int nSrcBands, int nDstBands,
+                                int nNearDist, int nMaxNonBlack,
+                                bool bNearWhite, const Colors &oColors,
+                                int *panLastLineCounts,
+                                int iLineFromTopOrBottom);
+static void ProcessLineHorizontal(GByte *pabyLine, GByte *pabyMask, int iStart,
+                                  int iEnd, int nSrcBands, int nDstBands,
+                                  int nNearDist, int nMaxNonBlack,
+                                  bool bNearWhite, const Colors &oColors,
+                                  const int *panLastLineCounts, bool bBottomUp);
 
 /************************************************************************/
 /*                            GDALNearblack()                           */
@@ -333,6 +340,136 @@ GDALDatasetH CPL_DLL GDALNearblack(const char *pszDest, GDALDatasetH hDstDS,
     return hDstDS;
 }
 
+/************************************************************************/
+/*                       NearblackProcessChunk()                        */
+/************************************************************************/
+
+namespace
+{
+// Chunk of consecutive lines processed together by a pass of
+// GDALNearblackTwoPassesAlgorithm().
+struct NearblackChunk
+{
+    const GDALNearblackOptions *psOptions = nullptr;
+    const Colors *poColors = nullptr;
+    int nXSize = 0;
+    int nSrcBands = 0;
+    int nDstBands = 0;
+    bool bBottomUp = false;
+
+    int nLines = 0;
+    // Index of the first processed line, counted from the top for the
+    // top-to-bottom pass, and from the bottom for the bottom-to-top one.
+    int iFirstLineFromTopOrBottom = 0;
+    GByte *pabyLines = nullptr;
+    GByte *pabyMask = nullptr;
+    int *panLastLineCounts = nullptr;
+    // Content of panLastLineCounts after the vertical check of each line.
+    int *panLineCounts = nullptr;
+};
+
+// Range of columns (vertical checks) or of lines (horizontal checks) of a
+// chunk, processed by a job.
+struct NearblackJob
+{
+    const NearblackChunk *psChunk = nullptr;
+    int iStart = 0;
+    int iEnd = 0;
+};
+}  // namespace
+
+// Index in the chunk buffers of the k-th processed line of the chunk.
+static int NearblackGetLineIdx(const NearblackChunk *psChunk, int k)
+{
+    return psChunk->bBottomUp ? psChunk->nLines - 1 - k : k;
+}
+
+static void NearblackVerticalJobFunc(void *pData)
+{
+    const auto psJob = static_cast<const NearblackJob *>(pData);
+    const NearblackChunk *psChunk = psJob->psChunk;
+    const GDALNearblackOptions *psOptions = psChunk->psOptions;
+    const size_t nXSize = psChunk->nXSize;
+    for (int k = 0; k < psChunk->nLines; k++)
+    {
+        const int iLine = NearblackGetLineIdx(psChunk, k);
+        ProcessLineVertical(
+            psChunk->pabyLines + iLine * nXSize * psChunk->nDstBands,
+            psChunk->pabyMask ? psChunk->pabyMask + iLine * nXSize : nullptr,
+            psJob->iStart, psJob->iEnd, psChunk->nSrcBands,
+            psChunk->nDstBands, psOptions->nNearDist, psOptions->nMaxNonBlack,
+            psOptions->bNearWhite, *(psChunk->poColors),
+            psChunk->panLastLineCounts, psChunk->iFirstLineFromTopOrBottom + k);
+        memcpy(psChunk->panLineCounts + iLine * nXSize + psJob->iStart,
+               psChunk->panLastLineCounts + psJob->iStart,
+               sizeof(int) * (psJob->iEnd - psJob->iStart));
+    }
+}
+
+static void NearblackHorizontalJobFunc(void *pData)
+{
+    const auto psJob = static_cast<const NearblackJob *>(pData);
+    const NearblackChunk *psChunk = psJob->psChunk;
+    const GDALNearblackOptions *psOptions = psChunk->psOptions;
+    const int nXSize = psChunk->nXSize;
+    for (int iLine = psJob->iStart; iLine < psJob->iEnd; iLine++)
+    {
+        GByte *pabyLine = psChunk->pabyLines + static_cast<size_t>(iLine) *
+                                                   nXSize * psChunk->nDstBands;
+        GByte *pabyMask =
+            psChunk->pabyMask
+                ? psChunk->pabyMask + static_cast<size_t>(iLine) * nXSize
+                : nullptr;
+        const int *panLineCounts =
+            psChunk->panLineCounts + static_cast<size_t>(iLine) * nXSize;
+        ProcessLineHorizontal(pabyLine, pabyMask, 0, nXSize - 1,
+                              psChunk->nSrcBands, psChunk->nDstBands,
+                              psOptions->nNearDist, psOptions->nMaxNonBlack,
+                              psOptions->bNearWhite, *(psChunk->poColors),
+                              panLineCounts, psChunk->bBottomUp);
+        ProcessLineHorizontal(pabyLine, pabyMask, nXSize - 1, 0,
+                              psChunk->nSrcBands, psChunk->nDstBands,
+                              psOptions->nNearDist, psOptions->nMaxNonBlack,
+                              psOptions->bNearWhite, *(psChunk->poColors),
+                              panLineCounts, psChunk->bBottomUp);
+    }
+}
+
+// Run the vertical checks of the lines of the chunk, in processing order but
+// split by ranges of columns, and then their horizontal checks, split by
+// ranges of lines. The vertical check of a line only depends on the
+// previous lines through panLastLineCounts, and the horizontal checks only
+// modify their own line, so the result is the same as processing the lines
+// one after the other.
+static void NearblackProcessChunk(const NearblackChunk &sChunk,
+                                  CPLJobQueue *poQueue, int nThreads)
+{
+    const auto RunJobs = [poQueue, nThreads](CPLThreadFunc pfnFunc,
+                                             const NearblackChunk &sChunkIn,
+                                             int nSize)
+    {
+        const int nJobs = std::max(1, std::min(nThreads, nSize));
+        std::vector<NearblackJob> asJobs(nJobs);
+        for (int i = 0; i < nJobs; i++)
+        {
+            asJobs[i].psChunk = &sChunkIn;
+            asJobs[i].iStart =
+                static_cast<int>(static_cast<GIntBig>(nSize) * i / nJobs);
+            asJobs[i].iEnd =
+                static_cast<int>(static_cast<GIntBig>(nSize) * (i + 1) / nJobs);
+            if (poQueue)
+                poQueue->SubmitJob(pfnFunc, &asJobs[i]);
+            else
+                pfnFunc(&asJobs[i]);
+        }
+        if (poQueue)
+            poQueue->WaitCompletion();
+    };
+
+    RunJobs(NearblackVerticalJobFunc, sChunk, sChunk.nXSize);
+    RunJobs(NearblackHorizontalJobFunc, sChunk, sChunk.nLines);
+}
+
 /************************************************************************/
 /*                   GDALNearblackTwoPassesAlgorithm()                  */
 /*                                                                      */
@@ -349,90 +486,108 @@ bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
     const int nXSize = GDALGetRasterXSize(hSrcDataset);
     const int nYSize = GDALGetRasterYSize(hSrcDataset);
 
-    const int nMaxNonBlack = psOptions->nMaxNonBlack;
-    const int nNearDist = psOptions->nNearDist;
-    const bool bNearWhite = psOptions->bNearWhite;
     const bool bSetAlpha = psOptions->bSetAlpha;
 
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads =
+        std::max(1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                                      ? CPLGetNumCPUs()
+                                      : atoi(pszNumThreads)));
+    auto poPool = nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+
     /* -------------------------------------------------------------------- */
-    /*      Allocate a line buffer.                                         */
+    /*      Allocate buffers for a chunk of lines. Lines are processed one  */
+    /*      at a time, unless several threads are used.                     */
     /* -------------------------------------------------------------------- */
+    int nChunkLines = 1;
+    if (poQueue)
+    {
+        // At most 256 lines, and about 64 MB.
+        const size_t nBytesPerLine =
+            static_cast<size_t>(nXSize) * (nDstBands + 1 + sizeof(int));
+        nChunkLines = static_cast<int>(std::max<size_t>(
+            1, std::min<size_t>({256, static_cast<size_t>(nYSize),
+                                 64 * 1024 * 1024 / nBytesPerLine})));
+    }
 
-    std::vector<GByte> abyLine(nXSize * nDstBands);
-    GByte *pabyLine = abyLine.data();
+    std::vector<GByte> abyLines(static_cast<size_t>(nXSize) * nDstBands *
+                                nChunkLines);
+    GByte *pabyLines = abyLines.data();
+    const int nLineSpace = nXSize * nDstBands;
 
     std::vector<GByte> abyMask;
     GByte *pabyMask = nullptr;
     if (bSetMask)
     {
-        abyMask.resize(nXSize);
+        abyMask.resize(static_cast<size_t>(nXSize) * nChunkLines);
         pabyMask = abyMask.data();
     }
 
     std::vector<int> anLastLineCounts(nXSize);
     int *panLastLineCounts = anLastLineCounts.data();
+    std::vector<int> anLineCounts(static_cast<size_t>(nXSize) * nChunkLines);
+
+    NearblackChunk sChunk;
+    sChunk.psOptions = psOptions;
+    sChunk.poColors = &oColors;
+    sChunk.nXSize = nXSize;
+    sChunk.nSrcBands = nBands;
+    sChunk.nDstBands = nDstBands;
+    sChunk.pabyLines = pabyLines;
+    sChunk.pabyMask = pabyMask;
+    sChunk.panLastLineCounts = panLastLineCounts;
+    sChunk.panLineCounts = anLineCounts.data();
 
     /* -------------------------------------------------------------------- */
-    /*      Processing data one line at a time.                             */
+    /*      Processing data one chunk of lines at a time.                   */
     /* -------------------------------------------------------------------- */
-    int iLine;
-
-    for (iLine = 0; iLine < nYSize; iLine++)
+    for (int iLine = 0; iLine < nYSize; iLine += nChunkLines)
     {
+        const int nLines = std::min(nChunkLines, nYSize - iLine);
         CPLErr eErr = GDALDatasetRasterIO(
-            hSrcDataset, GF_Read, 0, iLine, nXSize, 1, pabyLine, nXSize, 1,
-            GDT_Byte, nBands, nullptr, nDstBands, nXSize * nDstBands, 1);
+            hSrcDataset, GF_Read, 0, iLine, nXSize, nLines, pabyLines, nXSize,
+            nLines, GDT_Byte, nBands, nullptr, nDstBands, nLineSpace, 1);
         if (eErr != CE_None)
         {
             return false;
         }
 
+        const size_t nPixels = static_cast<size_t>(nXSize) * nLines;
         if (bSetAlpha)
         {
-            for (int iCol = 0; iCol < nXSize; iCol++)
+            for (size_t i = 0; i < nPixels; i++)
             {
-                pabyLine[iCol * nDstBands + nDstBands - 1] = 255;
+                pabyLines[i * nDstBands + nDstBands - 1] = 255;
             }
         }
 
         if (bSetMask)
         {
-            for (int iCol = 0; iCol < nXSize; iCol++)
-            {
-                pabyMask[iCol] = 255;
-            }
+            memset(pabyMask, 255, nPixels);
         }
 
-        ProcessLine(pabyLine, pabyMask, 0, nXSize - 1, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,   // bDoHorizontalCheck
-                    true,   // bDoVerticalCheck
-                    false,  // bBottomUp
-                    iLine);
-        ProcessLine(pabyLine, pabyMask, nXSize - 1, 0, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,   // bDoHorizontalCheck
-                    false,  // bDoVerticalCheck
-                    false,  // bBottomUp
-                    iLine);
-
-        eErr = GDALDatasetRasterIO(hDstDS, GF_Write, 0, iLine, nXSize, 1,
-                                   pabyLine, nXSize, 1, GDT_Byte, nDstBands,
-                                   nullptr, nDstBands, nXSize * nDstBands, 1);
+        sChunk.bBottomUp = false;
+        sChunk.nLines = nLines;
+        sChunk.iFirstLineFromTopOrBottom = iLine;
+        NearblackProcessChunk(sChunk, poQueue.get(), nThreads);
+
+        eErr = GDALDatasetRasterIO(hDstDS, GF_Write, 0, iLine, nXSize, nLines,
+                                   pabyLines, nXSize, nLines, GDT_Byte,
+                                   nDstBands, nullptr, nDstBands, nLineSpace,
+                                   1);
 
         if (eErr != CE_None)
         {
             return false;
         }
 
-        /***** write out the mask band line *****/
+        /***** write out the mask band lines *****/
 
         if (bSetMask)
         {
-            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iLine, nXSize, 1,
-                                pabyMask, nXSize, 1, GDT_Byte, 0, 0);
+            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iLine, nXSize, nLines,
+                                pabyMask, nXSize, nLines, GDT_Byte, 0, 0);
             if (eErr != CE_None)
             {
                 CPLError(CE_Warning, CPLE_AppDefined,
@@ -442,8 +597,8 @@ bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
         }
 
         if (!(psOptions->pfnProgress(
-                0.5 * ((iLine + 1) / static_cast<double>(nYSize)), nullptr,
-                psOptions->pProgressData)))
+                0.5 * ((iLine + nLines) / static_cast<double>(nYSize)),
+                nullptr, psOptions->pProgressData)))
         {
             return false;
         }
@@ -454,57 +609,51 @@ bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
     /* -------------------------------------------------------------------- */
     memset(panLastLineCounts, 0, sizeof(int) * nXSize);
 
-    for (iLine = nYSize - 1; hDstDS != nullptr && iLine >= 0; iLine--)
+    for (int iLineEnd = nYSize; hDstDS != nullptr && iLineEnd > 0;
+         iLineEnd -= nChunkLines)
     {
+        const int nLines = std::min(nChunkLines, iLineEnd);
+        const int iLine = iLineEnd - nLines;
         CPLErr eErr = GDALDatasetRasterIO(
-            hDstDS, GF_Read, 0, iLine, nXSize, 1, pabyLine, nXSize, 1, GDT_Byte,
-            nDstBands, nullptr, nDstBands, nXSize * nDstBands, 1);
+            hDstDS, GF_Read, 0, iLine, nXSize, nLines, pabyLines, nXSize,
+            nLines, GDT_Byte, nDstBands, nullptr, nDstBands, nLineSpace, 1);
         if (eErr != CE_None)
         {
             return false;
         }
 
-        /***** read the mask band line back in *****/
+        /***** read the mask band lines back in *****/
 
         if (bSetMask)
         {
-            eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iLine, nXSize, 1,
-                                pabyMask, nXSize, 1, GDT_Byte, 0, 0);
+            eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iLine, nXSize, nLines,
+                                pabyMask, nXSize, nLines, GDT_Byte, 0, 0);
             if (eErr != CE_None)
             {
                 return false;
             }
         }
 
-        ProcessLine(pabyLine, pabyMask, 0, nXSize - 1, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,  // bDoHorizontalCheck
-                    true,  // bDoVerticalCheck
-                    true,  // bBottomUp
-                    nYSize - 1 - iLine);
-        ProcessLine(pabyLine, pabyMask, nXSize - 1, 0, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,   // bDoHorizontalCheck
-                    false,  // bDoVerticalCheck
-                    true,   // bBottomUp
-                    nYSize - 1 - iLine);
-
-        eErr = GDALDatasetRasterIO(hDstDS, GF_Write, 0, iLine, nXSize, 1,
-                                   pabyLine, nXSize, 1, GDT_Byte, nDstBands,
-                                   nullptr, nDstBands, nXSize * nDstBands, 1);
+        sChunk.bBottomUp = true;
+        sChunk.nLines = nLines;
+        sChunk.iFirstLineFromTopOrBottom = nYSize - iLineEnd;
+        NearblackProcessChunk(sChunk, poQueue.get(), nThreads);
+
+        eErr = GDALDatasetRasterIO(hDstDS, GF_Write, 0, iLine, nXSize, nLines,
+                                   pabyLines, nXSize, nLines, GDT_Byte,
+                                   nDstBands, nullptr, nDstBands, nLineSpace,
+                                   1);
         if (eErr != CE_None)
         {
             return false;
         }
 
-        /***** write out the mask band line *****/
+        /***** write out the mask band lines *****/
 
         if (bSetMask)
         {
-            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iLine, nXSize, 1,
-                                pabyMask, nXSize, 1, GDT_Byte, 0, 0);
+            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iLine, nXSize, nLines,
+                                pabyMask, nXSize, nLines, GDT_Byte, 0, 0);
             if (eErr != CE_None)
             {
                 return false;
@@ -523,34 +672,123 @@ bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
 }
 
 /************************************************************************/
-/*                            ProcessLine()                             */
+/*                        ProcessLineVertical()                         */
 /*                                                                      */
-/*      Process a single scanline of image data.                        */
+/*      Vertical check of columns [iStart, iEnd[ of a single scanline   */
+/*      of image data.                                                  */
 /************************************************************************/
 
-static void ProcessLine(GByte *pabyLine, GByte *pabyMask, int iStart, int iEnd,
-                        int nSrcBands, int nDstBands, int nNearDist,
-                        int nMaxNonBlack, bool bNearWhite,
-                        const Colors &oColors, int *panLastLineCounts,
-                        bool bDoHorizontalCheck, bool bDoVerticalCheck,
-                        bool bBottomUp, int iLineFromTopOrBottom)
+static void ProcessLineVertical(GByte *pabyLine, GByte *pabyMask, int iStart,
+                                int iEnd, int nSrcBands, int nDstBands,
+                                int nNearDist, int nMaxNonBlack,
+                                bool bNearWhite, const Colors &oColors,
+                                int *panLastLineCounts,
+                                int iLineFromTopOrBottom)
 {
     const GByte nReplacevalue = bNearWhite ? 255 : 0;
 
-    /* -------------------------------------------------------------------- */
-    /*      Vertical checking.                                              */
-    /* -------------------------------------------------------------------- */
-
-    if (bDoVerticalCheck)
+    for (int i = iStart; i < iEnd; i++)
     {
-        const int nXSize = std::max(iStart + 1, iEnd + 1);
+        // are we already terminated for this column?
+        if (panLastLineCounts[i] > nMaxNonBlack)
+            continue;
+
+        /***** is the pixel valid data? ****/
+
+        bool bIsNonBlack = false;
+
+        /***** loop over the colors *****/
+
+        for (int iColor = 0; iColor < static_cast<int>(oColors.size());
+             iColor++)
+        {
+
+            const Color &oColor = oColors[iColor];
+
+            bIsNonBlack = false;
+
+            /***** loop over the bands *****/
+
+            for (int iBand = 0; iBand < nSrcBands; iBand++)
+            {
+                const int nPix = pabyLine[i * nDstBands + iBand];
+
+                if (oColor[iBand] - nPix > nNearDist ||
+                    nPix > nNearDist + oColor[iBand])
+                {
+                    bIsNonBlack = true;
+                    break;
+                }
+            }
 
-        for (int i = 0; i < nXSize; i++)
+            if (!bIsNonBlack)
+                break;
+        }
+
+        if (bIsNonBlack)
         {
-            // are we already terminated for this column?
+            panLastLineCounts[i]++;
+
             if (panLastLineCounts[i] > nMaxNonBlack)
                 continue;
 
+            if (iLineFromTopOrBottom == 0 && nMaxNonBlack > 0)
+            {
+                // if there's a valid value just at the top or bottom
+                // of the raster, then ignore the nMaxNonBlack setting
+                panLastLineCounts[i] = nMaxNonBlack + 1;
+                continue;
+            }
+        }
+        // else
+        //   panLastLineCounts[i] = 0; // not sure this even makes sense
+
+        /***** replace the pixel values *****/
+        for (int iBand = 0; iBand < nSrcBands; iBand++)
+            pabyLine[i * nDstBands + iBand] = nReplacevalue;
+
+        /***** alpha *****/
+        if (nDstBands > nSrcBands)
+            pabyLine[i * nDstBands + nDstBands - 1] = 0;
+
+        /***** mask *****/
+        if (pabyMask != nullptr)
+            pabyMask[i] = 0;
+    }
+}
+
+/************************************************************************/
+/*                       ProcessLineHorizontal()                        */
+/*                                                                      */
+/*      Horizontal check of a single scanline of image data, from       */
+/*      iStart to iEnd.                                                 */
+/************************************************************************/
+
+static void ProcessLineHorizontal(GByte *pabyLine, GByte *pabyMask, int iStart,
+                                  int iEnd, int nSrcBands, int nDstBands,
+                                  int nNearDist, int nMaxNonBlack,
+                                  bool bNearWhite, const Colors &oColors,
+                                  const int *panLastLineCounts, bool bBottomUp)
+{
+    const GByte nReplacevalue = bNearWhite ? 255 : 0;
+
+    int nNonBlackPixels = 0;
+
+    /***** on a bottom up pass assume nMaxNonBlack is 0 *****/
+
+    if (bBottomUp)
+        nMaxNonBlack = 0;
+
+    const int iDir = iStart < iEnd ? 1 : -1;
+
+    bool bDoTest = TRUE;
+
+    for (int i = iStart; i != iEnd; i += iDir)
+    {
+        /***** not seen any valid data? *****/
+
+        if (bDoTest)
+        {
             /***** is the pixel valid data? ****/
 
             bool bIsNonBlack = false;
@@ -579,146 +817,58 @@ static void ProcessLine(GByte *pabyLine, GByte *pabyMask, int iStart, int iEnd,
                     }
                 }
 
-                if (!bIsNonBlack)
+                if (bIsNonBlack == false)
                     break;
             }
 
             if (bIsNonBlack)
             {
-                panLastLineCounts[i]++;
+                /***** use nNonBlackPixels in grey areas  *****/
+                /***** from the vertical pass's grey areas ****/
 
-                if (panLastLineCounts[i] > nMaxNonBlack)
-                    continue;
+                if (panLastLineCounts[i] <= nMaxNonBlack)
+                    nNonBlackPixels = panLastLineCounts[i];
+                else
+                    nNonBlackPixels++;
+            }
 
-                if (iLineFromTopOrBottom == 0 && nMaxNonBlack > 0)
-                {
-                    // if there's a valid value just at the top or bottom
-                    // of the raster, then ignore the nMaxNonBlack setting
-                    panLastLineCounts[i] = nMaxNonBlack + 1;
-                    continue;
-                }
+            if (nNonBlackPixels > nMaxNonBlack)
+            {
+                bDoTest = false;
+                continue;
+            }
+
+            if (bIsNonBlack && nMaxNonBlack > 0 && i == iStart)
+            {
+                // if there's a valid value just at the left or right
+                // of the raster, then ignore the nMaxNonBlack setting
+                bDoTest = false;
+                continue;
             }
-            // else
-            //   panLastLineCounts[i] = 0; // not sure this even makes sense
 
             /***** replace the pixel values *****/
+
             for (int iBand = 0; iBand < nSrcBands; iBand++)
                 pabyLine[i * nDstBands + iBand] = nReplacevalue;
 
             /***** alpha *****/
+
             if (nDstBands > nSrcBands)
                 pabyLine[i * nDstBands + nDstBands - 1] = 0;
 
             /***** mask *****/
+
             if (pabyMask != nullptr)
                 pabyMask[i] = 0;
         }
-    }
-
-    /* -------------------------------------------------------------------- */
-    /*      Horizontal Checking.                                            */
-    /* -------------------------------------------------------------------- */
-
-    if (bDoHorizontalCheck)
-    {
-        int nNonBlackPixels = 0;
-
-        /***** on a bottom up pass assume nMaxNonBlack is 0 *****/
 
-        if (bBottomUp)
-            nMaxNonBlack = 0;
+        /***** seen valid data but test if the *****/
+        /***** vertical pass saw any non valid data *****/
 
-        const int iDir = iStart < iEnd ? 1 : -1;
-
-        bool bDoTest = TRUE;
-
-        for (int i = iStart; i != iEnd; i += iDir)
+        else if (panLastLineCounts[i] == 0)
         {
-            /***** not seen any valid data? *****/
-
-            if (bDoTest)
-            {
-                /***** is the pixel valid data? ****/
-
-                bool bIsNonBlack = false;
-
-                /***** loop over the colors *****/
-
-                for (int iColor = 0; iColor < static_cast<int>(oColors.size());
-                     iColor++)
-                {
-
-                    const Color &oColor = oColors[iColor];
-
-                    bIsNonBlack = false;
-
-                    /***** loop over the bands *****/
-
-                    for (int iBand = 0; iBand < nSrcBands; iBand++)
-                    {
-                        const int nPix = pabyLine[i * nDstBands + iBand];
-
-                        if (oColor[iBand] - nPix > nNearDist ||
-                            nPix > nNearDist + oColor[iBand])
-                        {
-                            bIsNonBlack = true;
-                            break;
-                        }
-                    }
-
-                    if (bIsNonBlack == false)
-                        break;
-                }
-
-                if (bIsNonBlack)
-                {
-                    /***** use nNonBlackPixels in grey areas  *****/
-                    /***** from the vertical pass's grey areas ****/
-
-                    if (panLastLineCounts[i] <= nMaxNonBlack)
-                        nNonBlackPixels = panLastLineCounts[i];
-                    else
-                        nNonBlackPixels++;
-                }
-
-                if (nNonBlackPixels > nMaxNonBlack)
-                {
-                    bDoTest = false;
-                    continue;
-                }
-
-                if (bIsNonBlack && nMaxNonBlack > 0 && i == iStart)
-                {
-                    // if there's a valid value just at the left or right
-                    // of the raster, then ignore the nMaxNonBlack setting
-                    bDoTest = false;
-                    continue;
-                }
-
-                /***** replace the pixel values *****/
-
-                for (int iBand = 0; iBand < nSrcBands; iBand++)
-                    pabyLine[i * nDstBands + iBand] = nReplacevalue;
-
-                /***** alpha *****/
-
-                if (nDstBands > nSrcBands)
-                    pabyLine[i * nDstBands + nDstBands - 1] = 0;
-
-                /***** mask *****/
-
-                if (pabyMask != nullptr)
-                    pabyMask[i] = 0;
-            }
-
-            /***** seen valid data but test if the *****/
-            /***** vertical pass saw any non valid data *****/
-
-            else if (panLastLineCounts[i] == 0)
-            {
-                bDoTest = true;
-                nNonBlackPixels = 0;
-            }
+            bDoTest = true;
+            nNonBlackPixels = 0;
         }
     }
 }
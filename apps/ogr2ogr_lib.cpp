@@ -58,6 +58,7 @@
 #include "gdal_alg.h"
 #include "gdal_alg_priv.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -66,6 +67,7 @@
 #include "ogr_p.h"
 #include "ogr_recordbatch.h"
 #include "ogr_spatialref.h"
+#include "ogrlayerarrow.h"
 #include "ogrlayerdecorator.h"
 #include "ogrsf_frmts.h"
 
@@ -495,11 +497,17 @@ class SetupTargetLayer
                                const GDALVectorTranslateOptions *psOptions,
                                bool &bError);
 
+    bool CanTransformArrowBatch(OGRLayer *poSrcLayer,
+                                const GDALVectorTranslateOptions *psOptions);
+
+    bool SetupArrowFieldSelection(OGRLayer *poSrcLayer, bool bJustCreatedLayer);
+
   public:
     GDALDataset *m_poSrcDS;
     GDALDataset *m_poDstDS;
     char **m_papszLCO;
     OGRSpatialReference *m_poOutputSRS;
+    const OGRSpatialReference *m_poUserSourceSRS = nullptr;
     bool m_bTransform = false;
     bool m_bNullifyOutputSRS;
     bool m_bSelFieldsSet = false;
@@ -536,11 +544,10 @@ class SetupTargetLayer
 
 class LayerTranslator
 {
-    static bool TranslateArrow(const TargetLayerInfo *psInfo,
-                               GIntBig nCountLayerFeatures,
-                               GIntBig *pnReadFeatureCount,
-                               GDALProgressFunc pfnProgress, void *pProgressArg,
-                               const GDALVectorTranslateOptions *psOptions);
+    bool TranslateArrow(TargetLayerInfo *psInfo, GIntBig nCountLayerFeatures,
+                        GIntBig *pnReadFeatureCount,
+                        GDALProgressFunc pfnProgress, void *pProgressArg,
+                        const GDALVectorTranslateOptions *psOptions);
 
   public:
     GDALDataset *m_poSrcDS = nullptr;
@@ -578,8 +585,63 @@ class LayerTranslator
                    const GDALVectorTranslateOptions *psOptions);
 
   private:
+    // Outcome of a step of the translation of a feature
+    enum class StepResult
+    {
+        OK,
+        SKIP_FEATURE,  // the feature must not be written
+        ABORT,         // the translation must be stopped
+    };
+
+    bool UpdateGroupTransactions(OGRLayer *poDstLayer,
+                                 int &nFeaturesInTransaction,
+                                 GIntBig &nTotalEventsDone,
+                                 const GDALVectorTranslateOptions *psOptions);
+    StepResult PrepareDstFeature(TargetLayerInfo *psInfo,
+                                 std::unique_ptr<OGRFeature> &poFeature,
+                                 std::unique_ptr<OGRFeature> &poDstFeature,
+                                 int nIters, GIntBig nSrcFID,
+                                 GIntBig nDesiredFID,
+                                 const GDALVectorTranslateOptions *psOptions);
+    StepResult TransformGeometry(OGRGeometry *&poDstGeometry, int iGeom,
+                                 OGRCoordinateTransformation *poCT,
+                                 TargetLayerInfo *psInfo,
+                                 const OGRSpatialReference *poOutputSRS,
+                                 bool bSetZ, double dfZ, GIntBig nSrcFID,
+                                 bool bSkipFailures, bool &bReprojectionFailed);
+    static bool
+    ReportReprojectionFailure(TargetLayerInfo *psInfo, GIntBig nSrcFID,
+                              const GDALVectorTranslateOptions *psOptions);
+    bool WriteFeature(TargetLayerInfo *psInfo, OGRFeature *poDstFeature,
+                      GIntBig nSrcFID, GIntBig nDesiredFID,
+                      GIntBig &nFeaturesWritten,
+                      const GDALVectorTranslateOptions *psOptions);
+    int GetParallelThreadCount(const TargetLayerInfo *psInfo,
+                               const OGRFeature *poFeatureIn,
+                               const GDALVectorTranslateOptions *psOptions);
+    bool TranslateParallel(TargetLayerInfo *psInfo, int nThreads,
+                           const OGRSpatialReference *poOutputSRS,
+                           bool bSetupCTOK, GIntBig nCountLayerFeatures,
+                           GIntBig *pnReadFeatureCount,
+                           GIntBig &nTotalEventsDone,
+                           GDALProgressFunc pfnProgress, void *pProgressArg,
+                           const GDALVectorTranslateOptions *psOptions,
+                           bool &bRet, GIntBig &nFeaturesWritten);
+
+    // Prepared versions of the current source and destination clip
+    // geometries, used to quickly discard features that do not intersect
+    // them.
+    OGRPreparedGeometryUniquePtr m_poClipSrcPrepared{};
+    const OGRGeometry *m_poClipSrcPreparedFrom = nullptr;
+    OGRPreparedGeometryUniquePtr m_poClipDstPrepared{};
+    const OGRGeometry *m_poClipDstPreparedFrom = nullptr;
+
     const OGRGeometry *GetDstClipGeom(const OGRSpatialReference *poGeomSRS);
     const OGRGeometry *GetSrcClipGeom(const OGRSpatialReference *poGeomSRS);
+    static bool ClipGeomIntersects(const OGRGeometry *poClipGeom,
+                                   OGRPreparedGeometryUniquePtr &poPrepared,
+                                   const OGRGeometry *&poPreparedFrom,
+                                   const OGRGeometry *poGeom);
 };
 
 static OGRLayer *GetLayerAndOverwriteIfNecessary(GDALDataset *poDstDS,
@@ -2756,6 +2818,7 @@ GDALDatasetH GDALVectorTranslate(const char *pszDest, GDALDatasetH hDstDS,
     oSetup.m_poDstDS = poODS;
     oSetup.m_papszLCO = psOptions->aosLCO.List();
     oSetup.m_poOutputSRS = oOutputSRSHolder.get();
+    oSetup.m_poUserSourceSRS = poSourceSRS;
     oSetup.m_bTransform = psOptions->bTransform;
     oSetup.m_bNullifyOutputSRS = psOptions->bNullifyOutputSRS;
     oSetup.m_bSelFieldsSet = psOptions->bSelFieldsSet;
@@ -3834,6 +3897,128 @@ static void DoFieldTypeConversion(GDALDataset *poDstDS,
     }
 }
 
+/************************************************************************/
+/*                SetupTargetLayer::CanTransformArrowBatch()            */
+/************************************************************************/
+
+// Whether reprojection can be done on Arrow batches, that is when it
+// only involves a plain coordinate transformation, which is then applied
+// to all the geometries of a batch at once by OGRTransformArrowWKBArray().
+bool SetupTargetLayer::CanTransformArrowBatch(
+    OGRLayer *poSrcLayer, const GDALVectorTranslateOptions *psOptions)
+{
+    if (psOptions->bWrapDateline || psOptions->oGCPs.nGCPCount > 0 ||
+        (m_poOutputSRS == nullptr && m_pszCTPipeline == nullptr))
+    {
+        return false;
+    }
+
+    const auto poSrcFDefn = poSrcLayer->GetLayerDefn();
+    for (int i = 0; i < poSrcFDefn->GetGeomFieldCount(); ++i)
+    {
+        const OGRSpatialReference *poSourceSRS = m_poUserSourceSRS;
+        if (poSourceSRS == nullptr)
+            poSourceSRS = poSrcFDefn->GetGeomFieldDefn(i)->GetSpatialRef();
+        // A missing source SRS would require a per-feature coordinate
+        // transformation.
+        // And OGRGeometryFactory::transformWithOptions() has special
+        // processing for polar and antimeridian crossing geometries when
+        // going from a projected SRS to a geographic one.
+        if (poSourceSRS == nullptr ||
+            (m_poOutputSRS && poSourceSRS->IsProjected() &&
+             m_poOutputSRS->IsGeographic()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                  ArrowSchemaMatchesFieldSelection()                  */
+/************************************************************************/
+
+// Checks that the attribute columns of an Arrow stream schema are the
+// selected fields, which is not the case if the GetArrowStream()
+// implementation of the source layer does not honor ignored fields.
+static bool ArrowSchemaMatchesFieldSelection(const struct ArrowSchema *schema,
+                                             const OGRFeatureDefn *poSrcFDefn,
+                                             CSLConstList papszSelFields,
+                                             bool bSelFieldsSet)
+{
+    if (!bSelFieldsSet)
+        return true;
+    for (int i = 0; i < static_cast<int>(schema->n_children); ++i)
+    {
+        const char *pszName = schema->children[i]->name;
+        if (poSrcFDefn->GetFieldIndex(pszName) >= 0 &&
+            CSLFindString(papszSelFields, pszName) < 0)
+        {
+            CPLDebug("OGR2OGR",
+                     "Cannot use WriteArrowBatch() because Arrow stream of "
+                     "source layer has non-selected field %s",
+                     pszName);
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*               SetupTargetLayer::SetupArrowFieldSelection()           */
+/************************************************************************/
+
+// Whether the -select field list can be applied on Arrow batches, in which
+// case the non-selected fields are set as ignored on the source layer, so
+// that they are not part of its Arrow stream.
+bool SetupTargetLayer::SetupArrowFieldSelection(OGRLayer *poSrcLayer,
+                                                bool bJustCreatedLayer)
+{
+    if (!m_bSelFieldsSet)
+        return true;
+    if (!bJustCreatedLayer || !poSrcLayer->TestCapability(OLCIgnoreFields))
+        return false;
+
+    // Only attribute fields can be selected: geometry field selection
+    // requires the per-feature path.
+    const auto poSrcFDefn = poSrcLayer->GetLayerDefn();
+    for (int iField = 0; m_papszSelFields && m_papszSelFields[iField];
+         iField++)
+    {
+        if (poSrcFDefn->GetFieldIndex(m_papszSelFields[iField]) < 0)
+            return false;
+    }
+
+    // Fields used by -where cannot be ignored, and would be written.
+    if (m_pszWHERE)
+    {
+        OGRFeatureQuery oFeatureQuery;
+        if (oFeatureQuery.Compile(poSrcFDefn, m_pszWHERE, FALSE, nullptr) !=
+            OGRERR_NONE)
+        {
+            return false;
+        }
+        const CPLStringList aosWHEREUsedFields(oFeatureQuery.GetUsedFields());
+        for (const char *pszFieldName : aosWHEREUsedFields)
+        {
+            if (CSLFindString(m_papszSelFields, pszFieldName) < 0)
+                return false;
+        }
+    }
+
+    CPLStringList aosIgnoredFields;
+    for (int iSrcField = 0; iSrcField < poSrcFDefn->GetFieldCount();
+         iSrcField++)
+    {
+        const char *pszFieldName =
+            poSrcFDefn->GetFieldDefn(iSrcField)->GetNameRef();
+        if (CSLFindString(m_papszSelFields, pszFieldName) < 0)
+            aosIgnoredFields.AddString(pszFieldName);
+    }
+    return poSrcLayer->SetIgnoredFields(const_cast<const char **>(
+               aosIgnoredFields.List())) == OGRERR_NONE;
+}
+
 /************************************************************************/
 /*                 SetupTargetLayer::CanUseWriteArrowBatch()            */
 /************************************************************************/
@@ -3848,7 +4033,8 @@ bool SetupTargetLayer::CanUseWriteArrowBatch(
     // as it will be faster if the input driver has a fast
     // implementation of GetArrowStream().
     // We also can only do that only if using ogr2ogr without options that
-    // alter features.
+    // alter features, except reprojection and field selection (-where and
+    // -spat are applied by the source layer on its Arrow stream).
     // OGR2OGR_USE_ARROW_API config option is mostly for testing purposes
     // or as a safety belt if things turned bad...
     bool bUseWriteArrowBatch = false;
@@ -3861,15 +4047,18 @@ bool SetupTargetLayer::CanUseWriteArrowBatch(
           !psOptions->aosLCO.FetchNameValue("BATCH_SIZE") &&
           CPLTestBool(CPLGetConfigOption("OGR2OGR_USE_ARROW_API", "YES"))) ||
          CPLTestBool(CPLGetConfigOption("OGR2OGR_USE_ARROW_API", "NO"))) &&
-        !psOptions->bSkipFailures && !psOptions->bTransform &&
-        !m_papszSelFields && !m_bAddMissingFields &&
-        m_eGType == GEOMTYPE_UNCHANGED && psOptions->eGeomOp == GEOMOP_NONE &&
+        !psOptions->bSkipFailures &&
+        (!psOptions->bTransform ||
+         CanTransformArrowBatch(poSrcLayer, psOptions)) &&
+        !m_bAddMissingFields && m_eGType == GEOMTYPE_UNCHANGED &&
+        psOptions->eGeomOp == GEOMOP_NONE &&
         m_eGeomTypeConversion == GTC_DEFAULT && m_nCoordDim < 0 &&
         !m_papszFieldTypesToString && !m_papszMapFieldType &&
         !m_bUnsetFieldWidth && !m_bExplodeCollections && !m_pszZField &&
         m_bExactFieldNameMatch && !m_bForceNullable && !m_bResolveDomains &&
         !m_bUnsetDefault && psOptions->nFIDToFetch == OGRNullFID &&
-        !psOptions->bMakeValid)
+        !psOptions->bMakeValid &&
+        SetupArrowFieldSelection(poSrcLayer, bJustCreatedLayer))
     {
         struct ArrowArrayStream streamSrc;
         if (poSrcLayer->GetArrowStream(&streamSrc, nullptr))
@@ -3888,10 +4077,38 @@ bool SetupTargetLayer::CanUseWriteArrowBatch(
                     if (bJustCreatedLayer && poDstFDefn &&
                         poDstFDefn->GetFieldCount() == 0 &&
                         poDstFDefn->GetGeomFieldCount() ==
-                            poSrcFDefn->GetGeomFieldCount())
+                            poSrcFDefn->GetGeomFieldCount() &&
+                        ArrowSchemaMatchesFieldSelection(
+                            &schemaSrc, poSrcFDefn, m_papszSelFields,
+                            m_bSelFieldsSet))
                     {
-                        // Create output fields using CreateFieldFromArrowSchema()
+                        // Create output fields using
+                        // CreateFieldFromArrowSchema(), in the -select order
+                        // if specified.
+                        std::vector<int> anChildOrder;
+                        for (int iField = 0;
+                             m_papszSelFields && m_papszSelFields[iField];
+                             iField++)
+                        {
+                            for (int i = 0; i < schemaSrc.n_children; ++i)
+                            {
+                                if (EQUAL(schemaSrc.children[i]->name,
+                                          m_papszSelFields[iField]))
+                                {
+                                    anChildOrder.push_back(i);
+                                    break;
+                                }
+                            }
+                        }
                         for (int i = 0; i < schemaSrc.n_children; ++i)
+                        {
+                            if (std::find(anChildOrder.begin(),
+                                          anChildOrder.end(),
+                                          i) == anChildOrder.end())
+                                anChildOrder.push_back(i);
+                        }
+
+                        for (const int i : anChildOrder)
                         {
                             const char *pszFieldName =
                                 schemaSrc.children[i]->name;
@@ -3942,14 +4159,39 @@ bool SetupTargetLayer::CanUseWriteArrowBatch(
                                 }
                             }
 
+                            // The width and precision of numeric fields
+                            // are not conveyed by the Arrow schema, so
+                            // use the source field definition to create
+                            // such fields.
+                            const OGRFieldDefn *poSrcNumericFieldDefn =
+                                nullptr;
+                            if (iSrcField >= 0)
+                            {
+                                const auto poSrcFieldDefn =
+                                    poSrcFDefn->GetFieldDefn(iSrcField);
+                                const auto eSrcType = poSrcFieldDefn->GetType();
+                                if ((eSrcType == OFTInteger ||
+                                     eSrcType == OFTInteger64 ||
+                                     eSrcType == OFTReal) &&
+                                    (poSrcFieldDefn->GetWidth() > 0 ||
+                                     poSrcFieldDefn->GetPrecision() > 0))
+                                {
+                                    poSrcNumericFieldDefn = poSrcFieldDefn;
+                                }
+                            }
+
                             if (!EQUAL(pszFieldName, "OGC_FID") &&
                                 !EQUAL(pszFieldName, "wkb_geometry") &&
                                 !EQUAL(pszFieldName,
                                        poSrcLayer->GetFIDColumn()) &&
                                 poSrcFDefn->GetGeomFieldIndex(pszFieldName) <
                                     0 &&
-                                !poDstLayer->CreateFieldFromArrowSchema(
-                                    schemaSrc.children[i], nullptr))
+                                !(poSrcNumericFieldDefn
+                                      ? poDstLayer->CreateField(
+                                            poSrcNumericFieldDefn) ==
+                                            OGRERR_NONE
+                                      : poDstLayer->CreateFieldFromArrowSchema(
+                                            schemaSrc.children[i], nullptr)))
                             {
                                 CPLError(CE_Failure, CPLE_AppDefined,
                                          "Cannot create field %s",
@@ -4000,6 +4242,12 @@ bool SetupTargetLayer::CanUseWriteArrowBatch(
             }
             streamSrc.release(&streamSrc);
         }
+
+        if (!bUseWriteArrowBatch && m_bSelFieldsSet)
+        {
+            // Restore the source fields ignored by SetupArrowFieldSelection()
+            poSrcLayer->SetIgnoredFields(nullptr);
+        }
     }
     return bUseWriteArrowBatch;
 }
@@ -5446,7 +5694,7 @@ SetupCT(TargetLayerInfo *psInfo, OGRLayer *poSrcLayer, bool bTransform,
 /************************************************************************/
 
 bool LayerTranslator::TranslateArrow(
-    const TargetLayerInfo *psInfo, GIntBig nCountLayerFeatures,
+    TargetLayerInfo *psInfo, GIntBig nCountLayerFeatures,
     GIntBig *pnReadFeatureCount, GDALProgressFunc pfnProgress,
     void *pProgressArg, const GDALVectorTranslateOptions *psOptions)
 {
@@ -5470,6 +5718,15 @@ bool LayerTranslator::TranslateArrow(
             "MAX_FEATURES_IN_BATCH",
             CPLSPrintf("%d", psOptions->nGroupTransactions));
     }
+    // Done before GetArrowStream() as it may change the active SRS of the
+    // source layer.
+    if (m_bTransform &&
+        !SetupCT(psInfo, psInfo->m_poSrcLayer, m_bTransform, m_bWrapDateline,
+                 m_osDateLineOffset, m_poUserSourceSRS, nullptr, m_poOutputSRS,
+                 m_poGCPCoordTrans, true))
+    {
+        return false;
+    }
     if (psInfo->m_poSrcLayer->GetArrowStream(&stream,
                                              aosOptionsGetArrowStream.List()))
     {
@@ -5486,6 +5743,46 @@ bool LayerTranslator::TranslateArrow(
         return false;
     }
 
+    // Index of the geometry columns of the schema to reproject, and their
+    // coordinate transformation.
+    std::vector<std::pair<int, OGRCoordinateTransformation *>> aoGeomCT;
+    if (m_bTransform)
+    {
+        const auto poSrcFDefn = psInfo->m_poSrcLayer->GetLayerDefn();
+        const auto poDstFDefn = psInfo->m_poDstLayer->GetLayerDefn();
+        const int nDstGeomFieldCount = poDstFDefn->GetGeomFieldCount();
+        for (int iGeom = 0; iGeom < nDstGeomFieldCount; ++iGeom)
+        {
+            auto poCT = psInfo->m_aoReprojectionInfo[iGeom].m_poCT.get();
+            if (poCT == nullptr)
+                continue;
+            // Same logic as in SetupCT()
+            int iSrcGeomField = poSrcFDefn->GetGeomFieldIndex(
+                poDstFDefn->GetGeomFieldDefn(iGeom)->GetNameRef());
+            if (iSrcGeomField < 0)
+            {
+                if (nDstGeomFieldCount == 1 &&
+                    poSrcFDefn->GetGeomFieldCount() > 0)
+                    iSrcGeomField = 0;
+                else
+                    continue;
+            }
+            const char *pszSrcGeomFieldName =
+                poSrcFDefn->GetGeomFieldDefn(iSrcGeomField)->GetNameRef();
+            if (pszSrcGeomFieldName[0] == '\0')
+                pszSrcGeomFieldName = OGRLayer::DEFAULT_ARROW_GEOMETRY_NAME;
+            for (int i = 0; i < static_cast<int>(schema.n_children); ++i)
+            {
+                if (strcmp(schema.children[i]->name, pszSrcGeomFieldName) ==
+                    0)
+                {
+                    aoGeomCT.emplace_back(i, poCT);
+                    break;
+                }
+            }
+        }
+    }
+
     bool bRet = true;
 
     GIntBig nCount = 0;
@@ -5525,6 +5822,24 @@ bool LayerTranslator::TranslateArrow(
             nCount += array.length;
         }
 
+        // Reproject geometry columns
+        for (const auto &oGeomCT : aoGeomCT)
+        {
+            if (!OGRTransformArrowWKBArray(schema.children[oGeomCT.first],
+                                           array.children[oGeomCT.first],
+                                           oGeomCT.second,
+                                           /* bSetNullOnFailure = */ false))
+            {
+                bRet = false;
+                break;
+            }
+        }
+        if (!bRet)
+        {
+            array.release(&array);
+            break;
+        }
+
         // Write batch to target layer
         if (!psInfo->m_poDstLayer->WriteArrowBatch(
                 &schema, &array, aosOptionsWriteArrowBatch.List()))
@@ -5577,12 +5892,10 @@ bool LayerTranslator::Translate(
                               pfnProgress, pProgressArg, psOptions);
     }
 
-    const int eGType = m_eGType;
     const OGRSpatialReference *poOutputSRS = m_poOutputSRS;
 
     OGRLayer *poSrcLayer = psInfo->m_poSrcLayer;
     OGRLayer *poDstLayer = psInfo->m_poDstLayer;
-    const int *const panMap = psInfo->m_anMap.data();
     const int iSrcZField = psInfo->m_iSrcZField;
     const bool bPreserveFID = psInfo->m_bPreserveFID;
     const auto poSrcFDefn = poSrcLayer->GetLayerDefn();
@@ -5640,7 +5953,19 @@ bool LayerTranslator::Translate(
                              poOutputSRS, m_poGCPCoordTrans, false);
     }
 
-    while (true)
+    // When the geometries are translated in parallel, the loop below is
+    // skipped.
+    const int nThreads = GetParallelThreadCount(psInfo, poFeatureIn, psOptions);
+    if (nThreads > 1 &&
+        !TranslateParallel(psInfo, nThreads, poOutputSRS, bSetupCTOK,
+                           nCountLayerFeatures, pnReadFeatureCount,
+                           nTotalEventsDone, pfnProgress, pProgressArg,
+                           psOptions, bRet, nFeaturesWritten))
+    {
+        return false;
+    }
+
+    while (nThreads <= 1)
     {
         if (m_nLimit >= 0 && psInfo->m_nFeaturesRead >= m_nLimit)
         {
@@ -5717,192 +6042,21 @@ bool LayerTranslator::Translate(
 
         for (int iPart = 0; iPart < nIters; iPart++)
         {
-            if (psOptions->nLayerTransaction &&
-                ++nFeaturesInTransaction == psOptions->nGroupTransactions)
-            {
-                if (poDstLayer->CommitTransaction() == OGRERR_FAILURE ||
-                    poDstLayer->StartTransaction() == OGRERR_FAILURE)
-                {
-                    return false;
-                }
-                nFeaturesInTransaction = 0;
-            }
-            else if (!psOptions->nLayerTransaction &&
-                     psOptions->nGroupTransactions > 0 &&
-                     ++nTotalEventsDone >= psOptions->nGroupTransactions)
-            {
-                if (m_poODS->CommitTransaction() == OGRERR_FAILURE ||
-                    m_poODS->StartTransaction(psOptions->bForceTransaction) ==
-                        OGRERR_FAILURE)
-                {
-                    return false;
-                }
-                nTotalEventsDone = 0;
-            }
-
-            CPLErrorReset();
-            if (psInfo->m_bCanAvoidSetFrom)
-            {
-                poDstFeature = std::move(poFeature);
-                // From now on, poFeature is null !
-                poDstFeature->SetFDefnUnsafe(poDstFDefn);
-                poDstFeature->SetFID(nDesiredFID);
-            }
-            else
-            {
-                /* Optimization to avoid duplicating the source geometry in the
-                 */
-                /* target feature : we steal it from the source feature for
-                 * now... */
-                std::unique_ptr<OGRGeometry> poStolenGeometry;
-                if (!bExplodeCollections && nSrcGeomFieldCount == 1 &&
-                    (nDstGeomFieldCount == 1 ||
-                     (nDstGeomFieldCount == 0 && m_poClipSrcOri)))
-                {
-                    poStolenGeometry.reset(poFeature->StealGeometry());
-                }
-                else if (!bExplodeCollections && iRequestedSrcGeomField >= 0)
-                {
-                    poStolenGeometry.reset(
-                        poFeature->StealGeometry(iRequestedSrcGeomField));
-                }
-
-                if (nDstGeomFieldCount == 0 && poStolenGeometry &&
-                    m_poClipSrcOri)
-                {
-                    const OGRGeometry *poClipGeom =
-                        GetSrcClipGeom(poStolenGeometry->getSpatialReference());
-
-                    if (poClipGeom != nullptr &&
-                        !poClipGeom->Intersects(poStolenGeometry.get()))
-                    {
-                        goto end_loop;
-                    }
-                }
-
-                poDstFeature->Reset();
-                if (poDstFeature->SetFrom(poFeature.get(), panMap, TRUE) !=
-                    OGRERR_NONE)
-                {
-                    if (psOptions->nGroupTransactions)
-                    {
-                        if (psOptions->nLayerTransaction)
-                        {
-                            if (poDstLayer->CommitTransaction() != OGRERR_NONE)
-                            {
-                                return false;
-                            }
-                        }
-                    }
-
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "Unable to translate feature " CPL_FRMT_GIB
-                             " from layer %s.",
-                             nSrcFID, poSrcLayer->GetName());
-
-                    return false;
-                }
-
-                /* ... and now we can attach the stolen geometry */
-                if (poStolenGeometry)
-                {
-                    poDstFeature->SetGeometryDirectly(
-                        poStolenGeometry.release());
-                }
-
-                if (!psInfo->m_oMapResolved.empty())
-                {
-                    for (const auto &kv : psInfo->m_oMapResolved)
-                    {
-                        const int nDstField = kv.first;
-                        const int nSrcField = kv.second.nSrcField;
-                        if (poFeature->IsFieldSetAndNotNull(nSrcField))
-                        {
-                            const auto poDomain = kv.second.poDomain;
-                            const auto &oMapKV =
-                                psInfo->m_oMapDomainToKV[poDomain];
-                            const auto iter = oMapKV.find(
-                                poFeature->GetFieldAsString(nSrcField));
-                            if (iter != oMapKV.end())
-                            {
-                                poDstFeature->SetField(nDstField,
-                                                       iter->second.c_str());
-                            }
-                        }
-                    }
-                }
-
-                if (nDesiredFID != OGRNullFID)
-                    poDstFeature->SetFID(nDesiredFID);
-            }
-
-            if (psOptions->bEmptyStrAsNull)
-            {
-                for (int i = 0; i < poDstFeature->GetFieldCount(); i++)
-                {
-                    if (!poDstFeature->IsFieldSetAndNotNull(i))
-                        continue;
-                    auto fieldDef = poDstFeature->GetFieldDefnRef(i);
-                    if (fieldDef->GetType() != OGRFieldType::OFTString)
-                        continue;
-                    auto str = poDstFeature->GetFieldAsString(i);
-                    if (strcmp(str, "") == 0)
-                        poDstFeature->SetFieldNull(i);
-                }
-            }
-
-            if (!psInfo->m_anDateTimeFieldIdx.empty())
+            if (!UpdateGroupTransactions(poDstLayer, nFeaturesInTransaction,
+                                         nTotalEventsDone, psOptions))
             {
-                for (int i : psInfo->m_anDateTimeFieldIdx)
-                {
-                    if (!poDstFeature->IsFieldSetAndNotNull(i))
-                        continue;
-                    auto psField = poDstFeature->GetRawFieldRef(i);
-                    if (psField->Date.TZFlag == 0 || psField->Date.TZFlag == 1)
-                        continue;
-
-                    const int nTZOffsetInSec =
-                        (psField->Date.TZFlag - 100) * 15 * 60;
-                    if (nTZOffsetInSec == psOptions->nTZOffsetInSec)
-                        continue;
-
-                    struct tm brokendowntime;
-                    memset(&brokendowntime, 0, sizeof(brokendowntime));
-                    brokendowntime.tm_year = psField->Date.Year - 1900;
-                    brokendowntime.tm_mon = psField->Date.Month - 1;
-                    brokendowntime.tm_mday = psField->Date.Day;
-                    GIntBig nUnixTime = CPLYMDHMSToUnixTime(&brokendowntime);
-                    int nSec = psField->Date.Hour * 3600 +
-                               psField->Date.Minute * 60 +
-                               static_cast<int>(psField->Date.Second);
-                    nSec += psOptions->nTZOffsetInSec - nTZOffsetInSec;
-                    nUnixTime += nSec;
-                    CPLUnixTimeToYMDHMS(nUnixTime, &brokendowntime);
-
-                    psField->Date.Year =
-                        static_cast<GInt16>(brokendowntime.tm_year + 1900);
-                    psField->Date.Month =
-                        static_cast<GByte>(brokendowntime.tm_mon + 1);
-                    psField->Date.Day =
-                        static_cast<GByte>(brokendowntime.tm_mday);
-                    psField->Date.Hour =
-                        static_cast<GByte>(brokendowntime.tm_hour);
-                    psField->Date.Minute =
-                        static_cast<GByte>(brokendowntime.tm_min);
-                    psField->Date.Second = static_cast<float>(
-                        brokendowntime.tm_sec + fmod(psField->Date.Second, 1));
-                    psField->Date.TZFlag = static_cast<GByte>(
-                        100 + psOptions->nTZOffsetInSec / (15 * 60));
-                }
+                return false;
             }
 
-            /* Erase native data if asked explicitly */
-            if (!m_bNativeData)
-            {
-                poDstFeature->SetNativeData(nullptr);
-                poDstFeature->SetNativeMediaType(nullptr);
-            }
+            const StepResult eResult =
+                PrepareDstFeature(psInfo, poFeature, poDstFeature, nIters,
+                                  nSrcFID, nDesiredFID, psOptions);
+            if (eResult == StepResult::ABORT)
+                return false;
+            if (eResult == StepResult::SKIP_FEATURE)
+                continue;
 
+            bool bSkipFeature = false;
             for (int iGeom = 0; iGeom < nDstGeomFieldCount; iGeom++)
             {
                 OGRGeometry *poDstGeometry;
@@ -5923,434 +6077,1128 @@ bool LayerTranslator::Translate(
 
                 // poFeature hasn't been moved if iSrcZField != -1
                 // cppcheck-suppress accessMoved
-                if (iSrcZField != -1 && poFeature != nullptr)
+                const bool bSetZ = iSrcZField != -1 && poFeature != nullptr;
+                bool bReprojectionFailed = false;
+                const StepResult eGeomResult = TransformGeometry(
+                    poDstGeometry, iGeom,
+                    psInfo->m_aoReprojectionInfo[iGeom].m_poCT.get(), psInfo,
+                    poOutputSRS, bSetZ,
+                    bSetZ ? poFeature->GetFieldAsDouble(iSrcZField) : 0.0,
+                    nSrcFID, psOptions->bSkipFailures, bReprojectionFailed);
+                if (bReprojectionFailed &&
+                    !ReportReprojectionFailure(psInfo, nSrcFID, psOptions))
                 {
-                    SetZ(poDstGeometry,
-                         poFeature->GetFieldAsDouble(iSrcZField));
-                    /* This will correct the coordinate dimension to 3 */
-                    OGRGeometry *poDupGeometry = poDstGeometry->clone();
                     delete poDstGeometry;
-                    poDstGeometry = poDupGeometry;
-                }
-
-                if (m_nCoordDim == 2 || m_nCoordDim == 3)
-                {
-                    poDstGeometry->setCoordinateDimension(m_nCoordDim);
-                }
-                else if (m_nCoordDim == 4)
-                {
-                    poDstGeometry->set3D(TRUE);
-                    poDstGeometry->setMeasured(TRUE);
-                }
-                else if (m_nCoordDim == COORD_DIM_XYM)
-                {
-                    poDstGeometry->set3D(FALSE);
-                    poDstGeometry->setMeasured(TRUE);
-                }
-                else if (m_nCoordDim == COORD_DIM_LAYER_DIM)
-                {
-                    const OGRwkbGeometryType eDstLayerGeomType =
-                        poDstLayer->GetLayerDefn()
-                            ->GetGeomFieldDefn(iGeom)
-                            ->GetType();
-                    poDstGeometry->set3D(wkbHasZ(eDstLayerGeomType));
-                    poDstGeometry->setMeasured(wkbHasM(eDstLayerGeomType));
-                }
-
-                if (m_eGeomOp == GEOMOP_SEGMENTIZE)
-                {
-                    if (m_dfGeomOpParam > 0)
-                        poDstGeometry->segmentize(m_dfGeomOpParam);
+                    return false;
                 }
-                else if (m_eGeomOp == GEOMOP_SIMPLIFY_PRESERVE_TOPOLOGY)
+                if (eGeomResult == StepResult::ABORT)
+                    return false;
+                if (eGeomResult == StepResult::SKIP_FEATURE)
                 {
-                    if (m_dfGeomOpParam > 0)
-                    {
-                        OGRGeometry *poNewGeom =
-                            poDstGeometry->SimplifyPreserveTopology(
-                                m_dfGeomOpParam);
-                        if (poNewGeom)
-                        {
-                            delete poDstGeometry;
-                            poDstGeometry = poNewGeom;
-                        }
-                    }
+                    bSkipFeature = true;
+                    break;
                 }
 
-                if (m_poClipSrcOri)
-                {
-
-                    const OGRGeometry *poClipGeom =
-                        GetSrcClipGeom(poDstGeometry->getSpatialReference());
+                poDstFeature->SetGeomFieldDirectly(iGeom, poDstGeometry);
+            }
+            if (bSkipFeature)
+                continue;
 
-                    std::unique_ptr<OGRGeometry> poClipped;
-                    if (poClipGeom != nullptr)
-                    {
-                        OGREnvelope oClipEnv;
-                        OGREnvelope oDstEnv;
+            if (!WriteFeature(psInfo, poDstFeature.get(), nSrcFID,
+                              nDesiredFID, nFeaturesWritten, psOptions))
+            {
+                return false;
+            }
+        }
 
-                        poClipGeom->getEnvelope(&oClipEnv);
-                        poDstGeometry->getEnvelope(&oDstEnv);
+        /* Report progress */
+        nCount++;
+        bool bGoOn = true;
+        if (pfnProgress)
+        {
+            bGoOn = pfnProgress(nCountLayerFeatures
+                                    ? nCount * 1.0 / nCountLayerFeatures
+                                    : 1.0,
+                                "", pProgressArg) != FALSE;
+        }
+        if (!bGoOn)
+        {
+            bRet = false;
+            break;
+        }
 
-                        if (oClipEnv.Intersects(oDstEnv))
-                        {
-                            poClipped.reset(
-                                poClipGeom->Intersection(poDstGeometry));
-                        }
-                    }
+        if (pnReadFeatureCount)
+            *pnReadFeatureCount = nCount;
 
-                    if (poClipped == nullptr || poClipped->IsEmpty())
-                    {
-                        delete poDstGeometry;
-                        goto end_loop;
-                    }
+        if (psOptions->nFIDToFetch != OGRNullFID)
+            break;
+        if (poFeatureIn != nullptr)
+            break;
+    }
 
-                    const int nDim = poDstGeometry->getDimension();
-                    if (poClipped->getDimension() < nDim &&
-                        wkbFlatten(
-                            poDstFDefn->GetGeomFieldDefn(iGeom)->GetType()) !=
-                            wkbUnknown)
-                    {
-                        CPLDebug(
-                            "OGR2OGR",
-                            "Discarding feature " CPL_FRMT_GIB " of layer %s, "
-                            "as its intersection with -clipsrc is a %s "
-                            "whereas the input is a %s",
-                            nSrcFID, poSrcLayer->GetName(),
-                            OGRToOGCGeomType(poClipped->getGeometryType()),
-                            OGRToOGCGeomType(poDstGeometry->getGeometryType()));
-                        delete poDstGeometry;
-                        goto end_loop;
-                    }
+    if (psOptions->nGroupTransactions)
+    {
+        if (psOptions->nLayerTransaction)
+        {
+            if (poDstLayer->CommitTransaction() != OGRERR_NONE)
+                bRet = false;
+        }
+    }
 
-                    delete poDstGeometry;
-                    poDstGeometry = poClipped.release();
-                }
+    if (poFeatureIn == nullptr)
+    {
+        CPLDebug("GDALVectorTranslate",
+                 CPL_FRMT_GIB " features written in layer '%s'",
+                 nFeaturesWritten, poDstLayer->GetName());
+    }
 
-                OGRCoordinateTransformation *const poCT =
-                    psInfo->m_aoReprojectionInfo[iGeom].m_poCT.get();
-                char **const papszTransformOptions =
-                    psInfo->m_aoReprojectionInfo[iGeom]
-                        .m_aosTransformOptions.List();
-                const bool bReprojCanInvalidateValidity =
-                    psInfo->m_aoReprojectionInfo[iGeom]
-                        .m_bCanInvalidateValidity;
+    return bRet;
+}
 
-                if (poCT != nullptr || papszTransformOptions != nullptr)
-                {
-                    // If we need to change the geometry type to linear, and
-                    // we have a geometry with curves, then convert it to
-                    // linear first, to avoid invalidities due to the fact
-                    // that validity of arc portions isn't always kept while
-                    // reprojecting and then discretizing.
-                    if (bReprojCanInvalidateValidity &&
-                        (!psInfo->m_bSupportCurves ||
-                         m_eGeomTypeConversion == GTC_CONVERT_TO_LINEAR ||
-                         m_eGeomTypeConversion ==
-                             GTC_PROMOTE_TO_MULTI_AND_CONVERT_TO_LINEAR))
-                    {
-                        if (poDstGeometry->hasCurveGeometry(TRUE))
-                        {
-                            OGRwkbGeometryType eTargetType = OGR_GT_GetLinear(
-                                poDstGeometry->getGeometryType());
-                            poDstGeometry = OGRGeometryFactory::forceTo(
-                                poDstGeometry, eTargetType);
-                        }
-                    }
-                    else if (bReprojCanInvalidateValidity &&
-                             eGType != GEOMTYPE_UNCHANGED &&
-                             !OGR_GT_IsNonLinear(
-                                 static_cast<OGRwkbGeometryType>(eGType)) &&
-                             poDstGeometry->hasCurveGeometry(TRUE))
-                    {
-                        poDstGeometry = OGRGeometryFactory::forceTo(
-                            poDstGeometry,
-                            static_cast<OGRwkbGeometryType>(eGType));
-                    }
+/************************************************************************/
+/*              LayerTranslator::GetParallelThreadCount()               */
+/************************************************************************/
 
-                    for (int iIter = 0; iIter < 2; ++iIter)
-                    {
-                        auto poReprojectedGeom = std::unique_ptr<OGRGeometry>(
-                            OGRGeometryFactory::transformWithOptions(
-                                poDstGeometry, poCT, papszTransformOptions,
-                                m_transformWithOptionsCache));
-                        if (poReprojectedGeom == nullptr)
-                        {
-                            if (psOptions->nGroupTransactions)
-                            {
-                                if (psOptions->nLayerTransaction)
-                                {
-                                    if (poDstLayer->CommitTransaction() !=
-                                            OGRERR_NONE &&
-                                        !psOptions->bSkipFailures)
-                                    {
-                                        delete poDstGeometry;
-                                        return false;
-                                    }
-                                }
-                            }
+// Returns the number of threads among which the geometry operations of
+// Translate() are distributed, according to the GDAL_NUM_THREADS
+// configuration option, or 1 if they must be done sequentially.
+int LayerTranslator::GetParallelThreadCount(
+    const TargetLayerInfo *psInfo, const OGRFeature *poFeatureIn,
+    const GDALVectorTranslateOptions *psOptions)
+{
+    const int nDstGeomFieldCount =
+        psInfo->m_poDstLayer->GetLayerDefn()->GetGeomFieldCount();
+    // Only worth it if there are costly geometry operations
+    if (poFeatureIn != nullptr || psOptions->nFIDToFetch != OGRNullFID ||
+        nDstGeomFieldCount == 0 || psInfo->m_bPerFeatureCT ||
+        (m_bExplodeCollections && nDstGeomFieldCount <= 1) ||
+        !(m_bTransform || m_bWrapDateline || m_poClipSrcOri ||
+          m_poClipDstOri || m_eGeomOp != GEOMOP_NONE || m_bMakeValid))
+    {
+        return 1;
+    }
+
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads);
+    return std::max(1, std::min(nThreads, 128));
+}
 
-                            CPLError(CE_Failure, CPLE_AppDefined,
-                                     "Failed to reproject feature " CPL_FRMT_GIB
-                                     " (geometry probably out of source or "
-                                     "destination SRS).",
-                                     nSrcFID);
-                            if (!psOptions->bSkipFailures)
-                            {
-                                delete poDstGeometry;
-                                return false;
-                            }
-                        }
+/************************************************************************/
+/*                 LayerTranslator::TranslateParallel()                 */
+/************************************************************************/
 
-                        // Check if a curve geometry is no longer valid after
-                        // reprojection
-                        const auto eType = poDstGeometry->getGeometryType();
-                        const auto eFlatType = wkbFlatten(eType);
+// Variant of the loop of Translate() where the geometry operations are run
+// on the global thread pool. Features are read and prepared by batches in
+// the calling thread. The geometries of a batch are transformed by nThreads
+// jobs, each with its own LayerTranslator and coordinate transformations,
+// while the next batch is read, and the features are then written in their
+// original order. At most two batches are in memory.
+// Returns false if the translation must be aborted.
+bool LayerTranslator::TranslateParallel(
+    TargetLayerInfo *psInfo, int nThreads,
+    const OGRSpatialReference *poOutputSRS, bool bSetupCTOK,
+    GIntBig nCountLayerFeatures, GIntBig *pnReadFeatureCount,
+    GIntBig &nTotalEventsDone, GDALProgressFunc pfnProgress,
+    void *pProgressArg, const GDALVectorTranslateOptions *psOptions,
+    bool &bRet, GIntBig &nFeaturesWritten)
+{
+    OGRLayer *poSrcLayer = psInfo->m_poSrcLayer;
+    OGRLayer *poDstLayer = psInfo->m_poDstLayer;
+    const auto poDstFDefn = poDstLayer->GetLayerDefn();
+    const int iSrcZField = psInfo->m_iSrcZField;
+    const bool bPreserveFID = psInfo->m_bPreserveFID;
 
-                        const auto IsValid = [](const OGRGeometry *poGeom)
-                        {
-                            CPLErrorHandlerPusher oErrorHandler(
-                                CPLQuietErrorHandler);
-                            return poGeom->IsValid();
-                        };
-
-                        if (iIter == 0 && bReprojCanInvalidateValidity &&
-                            OGRGeometryFactory::haveGEOS() &&
-                            (eFlatType == wkbCurvePolygon ||
-                             eFlatType == wkbCompoundCurve ||
-                             eFlatType == wkbMultiCurve ||
-                             eFlatType == wkbMultiSurface) &&
-                            poDstGeometry->hasCurveGeometry(TRUE) &&
-                            IsValid(poDstGeometry))
-                        {
-                            OGRwkbGeometryType eTargetType = OGR_GT_GetLinear(
-                                poDstGeometry->getGeometryType());
-                            auto poDstGeometryTmp =
-                                std::unique_ptr<OGRGeometry>(
-                                    OGRGeometryFactory::forceTo(
-                                        poReprojectedGeom->clone(),
-                                        eTargetType));
-                            if (!IsValid(poDstGeometryTmp.get()))
-                            {
-                                CPLDebug("OGR2OGR",
-                                         "Curve geometry no longer valid after "
-                                         "reprojection: transforming it into "
-                                         "linear one before reprojecting");
-                                poDstGeometry = OGRGeometryFactory::forceTo(
-                                    poDstGeometry, eTargetType);
-                                poDstGeometry = OGRGeometryFactory::forceTo(
-                                    poDstGeometry, eType);
-                            }
-                            else
-                            {
-                                delete poDstGeometry;
-                                poDstGeometry = poReprojectedGeom.release();
-                                break;
-                            }
-                        }
-                        else
-                        {
-                            delete poDstGeometry;
-                            poDstGeometry = poReprojectedGeom.release();
-                            break;
-                        }
-                    }
+    struct PendingFeature
+    {
+        std::unique_ptr<OGRFeature> poDstFeature{};
+        GIntBig nSrcFID = OGRNullFID;
+        GIntBig nDesiredFID = OGRNullFID;
+        bool bSetZ = false;
+        double dfZ = 0;
+        StepResult eResult = StepResult::OK;
+        bool bReprojectionFailed = false;
+    };
+
+    struct Job
+    {
+        LayerTranslator *poTranslator = nullptr;
+        std::vector<OGRCoordinateTransformation *> apoCT{};
+        TargetLayerInfo *psInfo = nullptr;
+        const OGRSpatialReference *poOutputSRS = nullptr;
+        bool bSkipFailures = false;
+        PendingFeature *pasFeatures = nullptr;
+        size_t nFeatures = 0;
+    };
+
+    struct Batch
+    {
+        std::vector<PendingFeature> asFeatures{};
+        std::vector<Job> asJobs{};
+        std::vector<std::unique_ptr<LayerTranslator>> apoTranslators{};
+        std::vector<std::vector<std::unique_ptr<OGRCoordinateTransformation>>>
+            aapoCT{};
+        std::unique_ptr<CPLJobQueue> poQueue{};
+    };
+
+    const auto JobFunc = [](void *pData)
+    {
+        auto psJob = static_cast<Job *>(pData);
+        for (size_t i = 0; i < psJob->nFeatures; ++i)
+        {
+            auto &sFeature = psJob->pasFeatures[i];
+            if (sFeature.eResult != StepResult::OK)
+                continue;
+            OGRFeature *poDstFeature = sFeature.poDstFeature.get();
+            const int nGeomFieldCount = poDstFeature->GetGeomFieldCount();
+            for (int iGeom = 0; iGeom < nGeomFieldCount; iGeom++)
+            {
+                OGRGeometry *poDstGeometry = poDstFeature->StealGeometry(iGeom);
+                if (poDstGeometry == nullptr)
+                    continue;
+                sFeature.eResult = psJob->poTranslator->TransformGeometry(
+                    poDstGeometry, iGeom, psJob->apoCT[iGeom], psJob->psInfo,
+                    psJob->poOutputSRS, sFeature.bSetZ, sFeature.dfZ,
+                    sFeature.nSrcFID, psJob->bSkipFailures,
+                    sFeature.bReprojectionFailed);
+                if (sFeature.eResult != StepResult::OK)
+                    break;
+                poDstFeature->SetGeomFieldDirectly(iGeom, poDstGeometry);
+            }
+        }
+    };
+
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nThreads);
+    Batch aoBatches[2];
+    if (poPool)
+    {
+        for (auto &oBatch : aoBatches)
+            oBatch.poQueue = poPool->CreateJobQueue();
+    }
+
+    // Creates the translators and coordinate transformations of the jobs of
+    // a batch. Returns false if that is not possible, in which case the jobs
+    // are run in this thread.
+    const auto InitBatchJobs = [this, psInfo, nThreads](Batch &oBatch)
+    {
+        if (!oBatch.poQueue || psInfo->m_bPerFeatureCT)
+            return false;
+        if (!oBatch.apoTranslators.empty())
+            return true;
+        for (int i = 0; i < nThreads; ++i)
+        {
+            std::vector<std::unique_ptr<OGRCoordinateTransformation>> apoCT;
+            for (const auto &oReprojectionInfo : psInfo->m_aoReprojectionInfo)
+            {
+                apoCT.emplace_back(oReprojectionInfo.m_poCT
+                                       ? oReprojectionInfo.m_poCT->Clone()
+                                       : nullptr);
+                if (oReprojectionInfo.m_poCT && !apoCT.back())
+                {
+                    CPLDebug("GDALVectorTranslate",
+                             "Cannot clone coordinate transformation: "
+                             "geometries will not be processed in parallel");
+                    oBatch.apoTranslators.clear();
+                    oBatch.aapoCT.clear();
+                    return false;
                 }
-                else if (poOutputSRS != nullptr)
+            }
+            oBatch.aapoCT.push_back(std::move(apoCT));
+
+            auto poTranslator = std::make_unique<LayerTranslator>();
+            poTranslator->m_eGType = m_eGType;
+            poTranslator->m_eGeomTypeConversion = m_eGeomTypeConversion;
+            poTranslator->m_bMakeValid = m_bMakeValid;
+            poTranslator->m_nCoordDim = m_nCoordDim;
+            poTranslator->m_eGeomOp = m_eGeomOp;
+            poTranslator->m_dfGeomOpParam = m_dfGeomOpParam;
+            poTranslator->m_poClipSrcOri = m_poClipSrcOri;
+            poTranslator->m_bWarnedClipSrcSRS = m_bWarnedClipSrcSRS;
+            poTranslator->m_poClipDstOri = m_poClipDstOri;
+            poTranslator->m_bWarnedClipDstSRS = m_bWarnedClipDstSRS;
+            oBatch.apoTranslators.push_back(std::move(poTranslator));
+        }
+        return true;
+    };
+
+    // Reads the next features into oBatch. A feature whose reading failed
+    // is queued with a StepResult::ABORT status.
+    bool bEOF = false;
+    const size_t nBatchSize = static_cast<size_t>(nThreads) * 100;
+    const auto ReadBatch = [&](Batch &oBatch)
+    {
+        oBatch.asFeatures.clear();
+        while (!bEOF && oBatch.asFeatures.size() < nBatchSize)
+        {
+            if (m_nLimit >= 0 && psInfo->m_nFeaturesRead >= m_nLimit)
+            {
+                bEOF = true;
+                break;
+            }
+
+            CPLErrorReset();
+            std::unique_ptr<OGRFeature> poFeature(poSrcLayer->GetNextFeature());
+            if (poFeature == nullptr)
+            {
+                if (CPLGetLastErrorType() == CE_Failure)
                 {
-                    poDstGeometry->assignSpatialReference(poOutputSRS);
+                    bRet = false;
                 }
+                bEOF = true;
+                break;
+            }
 
-                if (poDstGeometry != nullptr)
+            PendingFeature sFeature;
+            if (!bSetupCTOK &&
+                (psInfo->m_nFeaturesRead == 0 || psInfo->m_bPerFeatureCT))
+            {
+                if (!SetupCT(psInfo, poSrcLayer, m_bTransform, m_bWrapDateline,
+                             m_osDateLineOffset, m_poUserSourceSRS,
+                             poFeature.get(), poOutputSRS, m_poGCPCoordTrans,
+                             true))
                 {
-                    if (m_poClipDstOri)
-                    {
-                        const OGRGeometry *poClipGeom = GetDstClipGeom(
-                            poDstGeometry->getSpatialReference());
-                        if (poClipGeom == nullptr)
-                        {
-                            delete poDstGeometry;
-                            goto end_loop;
-                        }
+                    sFeature.eResult = StepResult::ABORT;
+                    oBatch.asFeatures.push_back(std::move(sFeature));
+                    bEOF = true;
+                    break;
+                }
+            }
 
-                        std::unique_ptr<OGRGeometry> poClipped;
+            psInfo->m_nFeaturesRead++;
+
+            sFeature.nSrcFID = poFeature->GetFID();
+            if (bPreserveFID)
+                sFeature.nDesiredFID = sFeature.nSrcFID;
+            else if (psInfo->m_iSrcFIDField >= 0 &&
+                     poFeature->IsFieldSetAndNotNull(psInfo->m_iSrcFIDField))
+                sFeature.nDesiredFID =
+                    poFeature->GetFieldAsInteger64(psInfo->m_iSrcFIDField);
+            // poFeature is moved by PrepareDstFeature() if
+            // m_bCanAvoidSetFrom is set
+            sFeature.bSetZ = iSrcZField != -1 && !psInfo->m_bCanAvoidSetFrom;
+            if (sFeature.bSetZ)
+                sFeature.dfZ = poFeature->GetFieldAsDouble(iSrcZField);
+
+            sFeature.poDstFeature.reset(new OGRFeature(poDstFDefn));
+            sFeature.eResult = PrepareDstFeature(
+                psInfo, poFeature, sFeature.poDstFeature, 1, sFeature.nSrcFID,
+                sFeature.nDesiredFID, psOptions);
+            const bool bAbort = sFeature.eResult == StepResult::ABORT;
+            oBatch.asFeatures.push_back(std::move(sFeature));
+            if (bAbort)
+            {
+                bEOF = true;
+                break;
+            }
 
-                        OGREnvelope oClipEnv;
-                        OGREnvelope oDstEnv;
+            // The coordinate transformation may change with the next
+            // feature: this one must be processed first.
+            if (psInfo->m_bPerFeatureCT)
+                break;
+        }
+    };
 
-                        poClipGeom->getEnvelope(&oClipEnv);
-                        poDstGeometry->getEnvelope(&oDstEnv);
+    // Transforms the geometries of the features of oBatch, in the global
+    // thread pool if possible.
+    const auto SubmitBatch = [&](Batch &oBatch)
+    {
+        const bool bParallel = InitBatchJobs(oBatch);
+        const size_t nJobs = bParallel ? oBatch.apoTranslators.size() : 1;
+        const size_t nFeatures = oBatch.asFeatures.size();
+        oBatch.asJobs.clear();
+        oBatch.asJobs.resize(nJobs);
+        for (size_t i = 0; i < nJobs; ++i)
+        {
+            auto &sJob = oBatch.asJobs[i];
+            if (bParallel)
+            {
+                sJob.poTranslator = oBatch.apoTranslators[i].get();
+                for (const auto &poCT : oBatch.aapoCT[i])
+                    sJob.apoCT.push_back(poCT.get());
+            }
+            else
+            {
+                sJob.poTranslator = this;
+                for (const auto &oReprojectionInfo :
+                     psInfo->m_aoReprojectionInfo)
+                    sJob.apoCT.push_back(oReprojectionInfo.m_poCT.get());
+            }
+            sJob.psInfo = psInfo;
+            sJob.poOutputSRS = poOutputSRS;
+            sJob.bSkipFailures = CPL_TO_BOOL(psOptions->bSkipFailures);
+            const size_t iStart = i * nFeatures / nJobs;
+            sJob.pasFeatures = oBatch.asFeatures.data() + iStart;
+            sJob.nFeatures = (i + 1) * nFeatures / nJobs - iStart;
+            if (!bParallel || !oBatch.poQueue->SubmitJob(JobFunc, &sJob))
+            {
+                JobFunc(&sJob);
+            }
+        }
+    };
 
-                        if (oClipEnv.Intersects(oDstEnv))
-                        {
-                            poClipped.reset(
-                                poClipGeom->Intersection(poDstGeometry));
-                        }
+    // Writes the features of oBatch, once transformed.
+    // Returns false if the translation must be aborted.
+    int nFeaturesInTransaction = 0;
+    GIntBig nCount = 0; /* written + failed */
+    bool bStop = false;
+    const auto WriteBatch = [&](Batch &oBatch)
+    {
+        if (oBatch.poQueue)
+            oBatch.poQueue->WaitCompletion();
+        for (auto &sFeature : oBatch.asFeatures)
+        {
+            if (sFeature.eResult == StepResult::ABORT &&
+                !sFeature.bReprojectionFailed)
+            {
+                return false;
+            }
+            if (!UpdateGroupTransactions(poDstLayer, nFeaturesInTransaction,
+                                         nTotalEventsDone, psOptions))
+            {
+                return false;
+            }
+            if (sFeature.bReprojectionFailed &&
+                !ReportReprojectionFailure(psInfo, sFeature.nSrcFID,
+                                           psOptions))
+            {
+                return false;
+            }
+            if (sFeature.eResult == StepResult::ABORT)
+                return false;
+            if (sFeature.eResult == StepResult::OK &&
+                !WriteFeature(psInfo, sFeature.poDstFeature.get(),
+                              sFeature.nSrcFID, sFeature.nDesiredFID,
+                              nFeaturesWritten, psOptions))
+            {
+                return false;
+            }
+            sFeature.poDstFeature.reset();
 
-                        if (poClipped == nullptr || poClipped->IsEmpty())
-                        {
-                            delete poDstGeometry;
-                            goto end_loop;
-                        }
+            /* Report progress */
+            nCount++;
+            if (pfnProgress &&
+                !pfnProgress(nCountLayerFeatures
+                                 ? nCount * 1.0 / nCountLayerFeatures
+                                 : 1.0,
+                             "", pProgressArg))
+            {
+                bRet = false;
+                bStop = true;
+                break;
+            }
 
-                        const int nDim = poDstGeometry->getDimension();
-                        if (poClipped->getDimension() < nDim &&
-                            wkbFlatten(poDstFDefn->GetGeomFieldDefn(iGeom)
-                                           ->GetType()) != wkbUnknown)
-                        {
-                            CPLDebug(
-                                "OGR2OGR",
-                                "Discarding feature " CPL_FRMT_GIB
-                                " of layer %s, "
-                                "as its intersection with -clipdst is a %s "
-                                "whereas the input is a %s",
-                                nSrcFID, poSrcLayer->GetName(),
-                                OGRToOGCGeomType(poClipped->getGeometryType()),
-                                OGRToOGCGeomType(
-                                    poDstGeometry->getGeometryType()));
-                            delete poDstGeometry;
-                            goto end_loop;
-                        }
+            if (pnReadFeatureCount)
+                *pnReadFeatureCount = nCount;
+        }
+        return true;
+    };
 
-                        delete poDstGeometry;
-                        poDstGeometry = poClipped.release();
-                    }
+    bool bSuccess = true;
+    int iCurBatch = 0;
+    ReadBatch(aoBatches[0]);
+    SubmitBatch(aoBatches[0]);
+    while (!aoBatches[iCurBatch].asFeatures.empty())
+    {
+        // Read the next batch while the current one is transformed
+        Batch &oNextBatch = aoBatches[1 - iCurBatch];
+        oNextBatch.asFeatures.clear();
+        if (!bEOF)
+        {
+            ReadBatch(oNextBatch);
+            SubmitBatch(oNextBatch);
+        }
 
-                    if (m_bMakeValid)
-                    {
-                        const bool bIsGeomCollection =
-                            wkbFlatten(poDstGeometry->getGeometryType()) ==
-                            wkbGeometryCollection;
-                        OGRGeometry *poValidGeom = poDstGeometry->MakeValid();
-                        delete poDstGeometry;
-                        poDstGeometry = poValidGeom;
-                        if (poDstGeometry == nullptr)
-                            goto end_loop;
-                        if (!bIsGeomCollection)
-                        {
-                            OGRGeometry *poCleanedGeom = OGRGeometryFactory::
-                                removeLowerDimensionSubGeoms(poDstGeometry);
-                            delete poDstGeometry;
-                            poDstGeometry = poCleanedGeom;
-                        }
-                    }
+        if (!WriteBatch(aoBatches[iCurBatch]))
+        {
+            bSuccess = false;
+            break;
+        }
+        if (bStop)
+            break;
+        iCurBatch = 1 - iCurBatch;
+    }
+
+    for (auto &oBatch : aoBatches)
+    {
+        if (oBatch.poQueue)
+            oBatch.poQueue->WaitCompletion();
+    }
+
+    return bSuccess;
+}
+
+/************************************************************************/
+/*               LayerTranslator::UpdateGroupTransactions()             */
+/************************************************************************/
+
+// Commits the current transaction and starts a new one every
+// psOptions->nGroupTransactions features.
+// Returns false if the translation must be aborted.
+bool LayerTranslator::UpdateGroupTransactions(
+    OGRLayer *poDstLayer, int &nFeaturesInTransaction,
+    GIntBig &nTotalEventsDone, const GDALVectorTranslateOptions *psOptions)
+{
+    if (psOptions->nLayerTransaction &&
+        ++nFeaturesInTransaction == psOptions->nGroupTransactions)
+    {
+        if (poDstLayer->CommitTransaction() == OGRERR_FAILURE ||
+            poDstLayer->StartTransaction() == OGRERR_FAILURE)
+        {
+            return false;
+        }
+        nFeaturesInTransaction = 0;
+    }
+    else if (!psOptions->nLayerTransaction &&
+             psOptions->nGroupTransactions > 0 &&
+             ++nTotalEventsDone >= psOptions->nGroupTransactions)
+    {
+        if (m_poODS->CommitTransaction() == OGRERR_FAILURE ||
+            m_poODS->StartTransaction(psOptions->bForceTransaction) ==
+                OGRERR_FAILURE)
+        {
+            return false;
+        }
+        nTotalEventsDone = 0;
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                 LayerTranslator::PrepareDstFeature()                 */
+/************************************************************************/
+
+// Sets poDstFeature from the attributes of the source feature poFeature,
+// with its geometries, yet to be transformed by TransformGeometry().
+LayerTranslator::StepResult LayerTranslator::PrepareDstFeature(
+    TargetLayerInfo *psInfo, std::unique_ptr<OGRFeature> &poFeature,
+    std::unique_ptr<OGRFeature> &poDstFeature, int nIters, GIntBig nSrcFID,
+    GIntBig nDesiredFID, const GDALVectorTranslateOptions *psOptions)
+{
+    OGRLayer *poSrcLayer = psInfo->m_poSrcLayer;
+    OGRLayer *poDstLayer = psInfo->m_poDstLayer;
+    const int *const panMap = psInfo->m_anMap.data();
+    const int iSrcZField = psInfo->m_iSrcZField;
+    const auto poDstFDefn = poDstLayer->GetLayerDefn();
+    const int nSrcGeomFieldCount =
+        poSrcLayer->GetLayerDefn()->GetGeomFieldCount();
+    const int nDstGeomFieldCount = poDstFDefn->GetGeomFieldCount();
+    const bool bExplodeCollections =
+        m_bExplodeCollections && nDstGeomFieldCount <= 1;
+    const int iRequestedSrcGeomField = psInfo->m_iRequestedSrcGeomField;
 
-                    if (m_eGeomTypeConversion != GTC_DEFAULT)
+    CPLErrorReset();
+    if (psInfo->m_bCanAvoidSetFrom)
+    {
+        poDstFeature = std::move(poFeature);
+        // From now on, poFeature is null !
+        poDstFeature->SetFDefnUnsafe(poDstFDefn);
+        poDstFeature->SetFID(nDesiredFID);
+    }
+    else
+    {
+        /* Optimization to avoid duplicating the source geometry in the
+         */
+        /* target feature : we steal it from the source feature for
+         * now... */
+        std::unique_ptr<OGRGeometry> poStolenGeometry;
+        if (!bExplodeCollections && nSrcGeomFieldCount == 1 &&
+            (nDstGeomFieldCount == 1 ||
+             (nDstGeomFieldCount == 0 && m_poClipSrcOri)))
+        {
+            poStolenGeometry.reset(poFeature->StealGeometry());
+        }
+        else if (!bExplodeCollections && iRequestedSrcGeomField >= 0)
+        {
+            poStolenGeometry.reset(
+                poFeature->StealGeometry(iRequestedSrcGeomField));
+        }
+
+        if (nDstGeomFieldCount == 0 && poStolenGeometry &&
+            m_poClipSrcOri)
+        {
+            const OGRGeometry *poClipGeom =
+                GetSrcClipGeom(poStolenGeometry->getSpatialReference());
+
+            if (poClipGeom != nullptr &&
+                !ClipGeomIntersects(poClipGeom, m_poClipSrcPrepared,
+                                    m_poClipSrcPreparedFrom,
+                                    poStolenGeometry.get()))
+            {
+                return StepResult::SKIP_FEATURE;
+            }
+        }
+
+        // If the source feature is no longer needed after that
+        // point, transfer its values instead of copying them.
+        const bool bCanStealFromSrc = nIters == 1 &&
+                                      psInfo->m_oMapResolved.empty() &&
+                                      iSrcZField == -1;
+        poDstFeature->Reset();
+        if ((bCanStealFromSrc
+                 ? poDstFeature->SetFromStealing(poFeature.get(),
+                                                 panMap, TRUE)
+                 : poDstFeature->SetFrom(poFeature.get(), panMap,
+                                         TRUE)) != OGRERR_NONE)
+        {
+            if (psOptions->nGroupTransactions)
+            {
+                if (psOptions->nLayerTransaction)
+                {
+                    if (poDstLayer->CommitTransaction() != OGRERR_NONE)
                     {
-                        OGRwkbGeometryType eTargetType =
-                            poDstGeometry->getGeometryType();
-                        eTargetType =
-                            ConvertType(m_eGeomTypeConversion, eTargetType);
-                        poDstGeometry = OGRGeometryFactory::forceTo(
-                            poDstGeometry, eTargetType);
+                        return StepResult::ABORT;
                     }
-                    else if (eGType != GEOMTYPE_UNCHANGED)
+                }
+            }
+
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Unable to translate feature " CPL_FRMT_GIB
+                     " from layer %s.",
+                     nSrcFID, poSrcLayer->GetName());
+
+            return StepResult::ABORT;
+        }
+
+        /* ... and now we can attach the stolen geometry */
+        if (poStolenGeometry)
+        {
+            poDstFeature->SetGeometryDirectly(
+                poStolenGeometry.release());
+        }
+
+        if (!psInfo->m_oMapResolved.empty())
+        {
+            for (const auto &kv : psInfo->m_oMapResolved)
+            {
+                const int nDstField = kv.first;
+                const int nSrcField = kv.second.nSrcField;
+                if (poFeature->IsFieldSetAndNotNull(nSrcField))
+                {
+                    const auto poDomain = kv.second.poDomain;
+                    const auto &oMapKV =
+                        psInfo->m_oMapDomainToKV[poDomain];
+                    const auto iter = oMapKV.find(
+                        poFeature->GetFieldAsString(nSrcField));
+                    if (iter != oMapKV.end())
                     {
-                        poDstGeometry = OGRGeometryFactory::forceTo(
-                            poDstGeometry,
-                            static_cast<OGRwkbGeometryType>(eGType));
+                        poDstFeature->SetField(nDstField,
+                                               iter->second.c_str());
                     }
                 }
+            }
+        }
 
-                poDstFeature->SetGeomFieldDirectly(iGeom, poDstGeometry);
+        if (nDesiredFID != OGRNullFID)
+            poDstFeature->SetFID(nDesiredFID);
+    }
+
+    if (psOptions->bEmptyStrAsNull)
+    {
+        for (int i = 0; i < poDstFeature->GetFieldCount(); i++)
+        {
+            if (!poDstFeature->IsFieldSetAndNotNull(i))
+                continue;
+            auto fieldDef = poDstFeature->GetFieldDefnRef(i);
+            if (fieldDef->GetType() != OGRFieldType::OFTString)
+                continue;
+            auto str = poDstFeature->GetFieldAsString(i);
+            if (strcmp(str, "") == 0)
+                poDstFeature->SetFieldNull(i);
+        }
+    }
+
+    if (!psInfo->m_anDateTimeFieldIdx.empty())
+    {
+        for (int i : psInfo->m_anDateTimeFieldIdx)
+        {
+            if (!poDstFeature->IsFieldSetAndNotNull(i))
+                continue;
+            auto psField = poDstFeature->GetRawFieldRef(i);
+            if (psField->Date.TZFlag == 0 || psField->Date.TZFlag == 1)
+                continue;
+
+            const int nTZOffsetInSec =
+                (psField->Date.TZFlag - 100) * 15 * 60;
+            if (nTZOffsetInSec == psOptions->nTZOffsetInSec)
+                continue;
+
+            struct tm brokendowntime;
+            memset(&brokendowntime, 0, sizeof(brokendowntime));
+            brokendowntime.tm_year = psField->Date.Year - 1900;
+            brokendowntime.tm_mon = psField->Date.Month - 1;
+            brokendowntime.tm_mday = psField->Date.Day;
+            GIntBig nUnixTime = CPLYMDHMSToUnixTime(&brokendowntime);
+            int nSec = psField->Date.Hour * 3600 +
+                       psField->Date.Minute * 60 +
+                       static_cast<int>(psField->Date.Second);
+            nSec += psOptions->nTZOffsetInSec - nTZOffsetInSec;
+            nUnixTime += nSec;
+            CPLUnixTimeToYMDHMS(nUnixTime, &brokendowntime);
+
+            psField->Date.Year =
+                static_cast<GInt16>(brokendowntime.tm_year + 1900);
+            psField->Date.Month =
+                static_cast<GByte>(brokendowntime.tm_mon + 1);
+            psField->Date.Day =
+                static_cast<GByte>(brokendowntime.tm_mday);
+            psField->Date.Hour =
+                static_cast<GByte>(brokendowntime.tm_hour);
+            psField->Date.Minute =
+                static_cast<GByte>(brokendowntime.tm_min);
+            psField->Date.Second = static_cast<float>(
+                brokendowntime.tm_sec + fmod(psField->Date.Second, 1));
+            psField->Date.TZFlag = static_cast<GByte>(
+                100 + psOptions->nTZOffsetInSec / (15 * 60));
+        }
+    }
+
+    /* Erase native data if asked explicitly */
+    if (!m_bNativeData)
+    {
+        poDstFeature->SetNativeData(nullptr);
+        poDstFeature->SetNativeMediaType(nullptr);
+    }
+
+    return StepResult::OK;
+}
+
+/************************************************************************/
+/*                 LayerTranslator::TransformGeometry()                 */
+/************************************************************************/
+
+// Applies the geometry operations (Z setting, coordinate dimension change,
+// simplification, clipping, reprojection with poCT, validity fixing, type
+// conversion) to poDstGeometry, the iGeom-th geometry of a feature. It may
+// be called from worker threads, on distinct LayerTranslator instances
+// and coordinate transformations.
+LayerTranslator::StepResult LayerTranslator::TransformGeometry(
+    OGRGeometry *&poDstGeometry, int iGeom, OGRCoordinateTransformation *poCT,
+    TargetLayerInfo *psInfo, const OGRSpatialReference *poOutputSRS,
+    bool bSetZ, double dfZ, GIntBig nSrcFID, bool bSkipFailures,
+    bool &bReprojectionFailed)
+{
+    const int eGType = m_eGType;
+    const auto poDstFDefn = psInfo->m_poDstLayer->GetLayerDefn();
+
+    if (bSetZ)
+    {
+        SetZ(poDstGeometry, dfZ);
+        /* This will correct the coordinate dimension to 3 */
+        OGRGeometry *poDupGeometry = poDstGeometry->clone();
+        delete poDstGeometry;
+        poDstGeometry = poDupGeometry;
+    }
+
+    if (m_nCoordDim == 2 || m_nCoordDim == 3)
+    {
+        poDstGeometry->setCoordinateDimension(m_nCoordDim);
+    }
+    else if (m_nCoordDim == 4)
+    {
+        poDstGeometry->set3D(TRUE);
+        poDstGeometry->setMeasured(TRUE);
+    }
+    else if (m_nCoordDim == COORD_DIM_XYM)
+    {
+        poDstGeometry->set3D(FALSE);
+        poDstGeometry->setMeasured(TRUE);
+    }
+    else if (m_nCoordDim == COORD_DIM_LAYER_DIM)
+    {
+        const OGRwkbGeometryType eDstLayerGeomType =
+            poDstFDefn->GetGeomFieldDefn(iGeom)->GetType();
+        poDstGeometry->set3D(wkbHasZ(eDstLayerGeomType));
+        poDstGeometry->setMeasured(wkbHasM(eDstLayerGeomType));
+    }
+
+    if (m_eGeomOp == GEOMOP_SEGMENTIZE)
+    {
+        if (m_dfGeomOpParam > 0)
+            poDstGeometry->segmentize(m_dfGeomOpParam);
+    }
+    else if (m_eGeomOp == GEOMOP_SIMPLIFY_PRESERVE_TOPOLOGY)
+    {
+        if (m_dfGeomOpParam > 0)
+        {
+            OGRGeometry *poNewGeom =
+                poDstGeometry->SimplifyPreserveTopology(
+                    m_dfGeomOpParam);
+            if (poNewGeom)
+            {
+                delete poDstGeometry;
+                poDstGeometry = poNewGeom;
+            }
+        }
+    }
+
+    if (m_poClipSrcOri)
+    {
+
+        const OGRGeometry *poClipGeom =
+            GetSrcClipGeom(poDstGeometry->getSpatialReference());
+
+        std::unique_ptr<OGRGeometry> poClipped;
+        if (poClipGeom != nullptr)
+        {
+            OGREnvelope oClipEnv;
+            OGREnvelope oDstEnv;
+
+            poClipGeom->getEnvelope(&oClipEnv);
+            poDstGeometry->getEnvelope(&oDstEnv);
+
+            if (oClipEnv.Intersects(oDstEnv) &&
+                ClipGeomIntersects(poClipGeom, m_poClipSrcPrepared,
+                                   m_poClipSrcPreparedFrom,
+                                   poDstGeometry))
+            {
+                poClipped.reset(
+                    poClipGeom->Intersection(poDstGeometry));
             }
+        }
 
-            CPLErrorReset();
-            if ((psOptions->bUpsert
-                     ? poDstLayer->UpsertFeature(poDstFeature.get())
-                     : poDstLayer->CreateFeature(poDstFeature.get())) ==
-                OGRERR_NONE)
+        if (poClipped == nullptr || poClipped->IsEmpty())
+        {
+            delete poDstGeometry;
+            poDstGeometry = nullptr;
+            return StepResult::SKIP_FEATURE;
+        }
+
+        const int nDim = poDstGeometry->getDimension();
+        if (poClipped->getDimension() < nDim &&
+            wkbFlatten(
+                poDstFDefn->GetGeomFieldDefn(iGeom)->GetType()) !=
+                wkbUnknown)
+        {
+            CPLDebug(
+                "OGR2OGR",
+                "Discarding feature " CPL_FRMT_GIB " of layer %s, "
+                "as its intersection with -clipsrc is a %s "
+                "whereas the input is a %s",
+                nSrcFID, psInfo->m_poSrcLayer->GetName(),
+                OGRToOGCGeomType(poClipped->getGeometryType()),
+                OGRToOGCGeomType(poDstGeometry->getGeometryType()));
+            delete poDstGeometry;
+            poDstGeometry = nullptr;
+            return StepResult::SKIP_FEATURE;
+        }
+
+        delete poDstGeometry;
+        poDstGeometry = poClipped.release();
+    }
+
+    char **const papszTransformOptions =
+        psInfo->m_aoReprojectionInfo[iGeom]
+            .m_aosTransformOptions.List();
+    const bool bReprojCanInvalidateValidity =
+        psInfo->m_aoReprojectionInfo[iGeom]
+            .m_bCanInvalidateValidity;
+
+    if (poCT != nullptr || papszTransformOptions != nullptr)
+    {
+        // If we need to change the geometry type to linear, and
+        // we have a geometry with curves, then convert it to
+        // linear first, to avoid invalidities due to the fact
+        // that validity of arc portions isn't always kept while
+        // reprojecting and then discretizing.
+        if (bReprojCanInvalidateValidity &&
+            (!psInfo->m_bSupportCurves ||
+             m_eGeomTypeConversion == GTC_CONVERT_TO_LINEAR ||
+             m_eGeomTypeConversion ==
+                 GTC_PROMOTE_TO_MULTI_AND_CONVERT_TO_LINEAR))
+        {
+            if (poDstGeometry->hasCurveGeometry(TRUE))
+            {
+                OGRwkbGeometryType eTargetType = OGR_GT_GetLinear(
+                    poDstGeometry->getGeometryType());
+                poDstGeometry = OGRGeometryFactory::forceTo(
+                    poDstGeometry, eTargetType);
+            }
+        }
+        else if (bReprojCanInvalidateValidity &&
+                 eGType != GEOMTYPE_UNCHANGED &&
+                 !OGR_GT_IsNonLinear(
+                     static_cast<OGRwkbGeometryType>(eGType)) &&
+                 poDstGeometry->hasCurveGeometry(TRUE))
+        {
+            poDstGeometry = OGRGeometryFactory::forceTo(
+                poDstGeometry,
+                static_cast<OGRwkbGeometryType>(eGType));
+        }
+
+        for (int iIter = 0; iIter < 2; ++iIter)
+        {
+            auto poReprojectedGeom = std::unique_ptr<OGRGeometry>(
+                OGRGeometryFactory::transformWithOptions(
+                    poDstGeometry, poCT, papszTransformOptions,
+                    m_transformWithOptionsCache));
+            if (poReprojectedGeom == nullptr)
             {
-                nFeaturesWritten++;
-                if (nDesiredFID != OGRNullFID &&
-                    poDstFeature->GetFID() != nDesiredFID)
+                // Reported by the caller with ReportReprojectionFailure()
+                bReprojectionFailed = true;
+                if (!bSkipFailures)
                 {
-                    CPLError(CE_Warning, CPLE_AppDefined,
-                             "Feature id " CPL_FRMT_GIB " not preserved",
-                             nDesiredFID);
+                    delete poDstGeometry;
+                    poDstGeometry = nullptr;
+                    return StepResult::ABORT;
                 }
             }
-            else if (!psOptions->bSkipFailures)
-            {
-                if (psOptions->nGroupTransactions)
+
+            // Check if a curve geometry is no longer valid after
+            // reprojection
+            const auto eType = poDstGeometry->getGeometryType();
+            const auto eFlatType = wkbFlatten(eType);
+
+            const auto IsValid = [](const OGRGeometry *poGeom)
+            {
+                CPLErrorHandlerPusher oErrorHandler(
+                    CPLQuietErrorHandler);
+                return poGeom->IsValid();
+            };
+
+            if (iIter == 0 && bReprojCanInvalidateValidity &&
+                OGRGeometryFactory::haveGEOS() &&
+                (eFlatType == wkbCurvePolygon ||
+                 eFlatType == wkbCompoundCurve ||
+                 eFlatType == wkbMultiCurve ||
+                 eFlatType == wkbMultiSurface) &&
+                poDstGeometry->hasCurveGeometry(TRUE) &&
+                IsValid(poDstGeometry))
+            {
+                OGRwkbGeometryType eTargetType = OGR_GT_GetLinear(
+                    poDstGeometry->getGeometryType());
+                auto poDstGeometryTmp =
+                    std::unique_ptr<OGRGeometry>(
+                        OGRGeometryFactory::forceTo(
+                            poReprojectedGeom->clone(),
+                            eTargetType));
+                if (!IsValid(poDstGeometryTmp.get()))
                 {
-                    if (psOptions->nLayerTransaction)
-                        poDstLayer->RollbackTransaction();
+                    CPLDebug("OGR2OGR",
+                             "Curve geometry no longer valid after "
+                             "reprojection: transforming it into "
+                             "linear one before reprojecting");
+                    poDstGeometry = OGRGeometryFactory::forceTo(
+                        poDstGeometry, eTargetType);
+                    poDstGeometry = OGRGeometryFactory::forceTo(
+                        poDstGeometry, eType);
                 }
+                else
+                {
+                    delete poDstGeometry;
+                    poDstGeometry = poReprojectedGeom.release();
+                    break;
+                }
+            }
+            else
+            {
+                delete poDstGeometry;
+                poDstGeometry = poReprojectedGeom.release();
+                break;
+            }
+        }
+    }
+    else if (poOutputSRS != nullptr)
+    {
+        poDstGeometry->assignSpatialReference(poOutputSRS);
+    }
 
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "Unable to write feature " CPL_FRMT_GIB
-                         " from layer %s.",
-                         nSrcFID, poSrcLayer->GetName());
+    if (poDstGeometry != nullptr)
+    {
+        if (m_poClipDstOri)
+        {
+            const OGRGeometry *poClipGeom = GetDstClipGeom(
+                poDstGeometry->getSpatialReference());
+            if (poClipGeom == nullptr)
+            {
+                delete poDstGeometry;
+                poDstGeometry = nullptr;
+                return StepResult::SKIP_FEATURE;
+            }
 
-                return false;
+            std::unique_ptr<OGRGeometry> poClipped;
+
+            OGREnvelope oClipEnv;
+            OGREnvelope oDstEnv;
+
+            poClipGeom->getEnvelope(&oClipEnv);
+            poDstGeometry->getEnvelope(&oDstEnv);
+
+            if (oClipEnv.Intersects(oDstEnv) &&
+                ClipGeomIntersects(
+                    poClipGeom, m_poClipDstPrepared,
+                    m_poClipDstPreparedFrom, poDstGeometry))
+            {
+                poClipped.reset(
+                    poClipGeom->Intersection(poDstGeometry));
             }
-            else
+
+            if (poClipped == nullptr || poClipped->IsEmpty())
             {
-                CPLDebug("GDALVectorTranslate",
-                         "Unable to write feature " CPL_FRMT_GIB
-                         " into layer %s.",
-                         nSrcFID, poSrcLayer->GetName());
-                if (psOptions->nGroupTransactions)
-                {
-                    if (psOptions->nLayerTransaction)
-                    {
-                        poDstLayer->RollbackTransaction();
-                        CPL_IGNORE_RET_VAL(poDstLayer->StartTransaction());
-                    }
-                    else
-                    {
-                        m_poODS->RollbackTransaction();
-                        m_poODS->StartTransaction(psOptions->bForceTransaction);
-                    }
-                }
+                delete poDstGeometry;
+                poDstGeometry = nullptr;
+                return StepResult::SKIP_FEATURE;
             }
 
-        end_loop:;  // nothing
+            const int nDim = poDstGeometry->getDimension();
+            if (poClipped->getDimension() < nDim &&
+                wkbFlatten(poDstFDefn->GetGeomFieldDefn(iGeom)
+                               ->GetType()) != wkbUnknown)
+            {
+                CPLDebug(
+                    "OGR2OGR",
+                    "Discarding feature " CPL_FRMT_GIB
+                    " of layer %s, "
+                    "as its intersection with -clipdst is a %s "
+                    "whereas the input is a %s",
+                    nSrcFID, psInfo->m_poSrcLayer->GetName(),
+                    OGRToOGCGeomType(poClipped->getGeometryType()),
+                    OGRToOGCGeomType(
+                        poDstGeometry->getGeometryType()));
+                delete poDstGeometry;
+                poDstGeometry = nullptr;
+                return StepResult::SKIP_FEATURE;
+            }
+
+            delete poDstGeometry;
+            poDstGeometry = poClipped.release();
         }
 
-        /* Report progress */
-        nCount++;
-        bool bGoOn = true;
-        if (pfnProgress)
+        if (m_bMakeValid)
         {
-            bGoOn = pfnProgress(nCountLayerFeatures
-                                    ? nCount * 1.0 / nCountLayerFeatures
-                                    : 1.0,
-                                "", pProgressArg) != FALSE;
+            const bool bIsGeomCollection =
+                wkbFlatten(poDstGeometry->getGeometryType()) ==
+                wkbGeometryCollection;
+            OGRGeometry *poValidGeom = poDstGeometry->MakeValid();
+            delete poDstGeometry;
+            poDstGeometry = poValidGeom;
+            if (poDstGeometry == nullptr)
+                return StepResult::SKIP_FEATURE;
+            if (!bIsGeomCollection)
+            {
+                OGRGeometry *poCleanedGeom = OGRGeometryFactory::
+                    removeLowerDimensionSubGeoms(poDstGeometry);
+                delete poDstGeometry;
+                poDstGeometry = poCleanedGeom;
+            }
         }
-        if (!bGoOn)
+
+        if (m_eGeomTypeConversion != GTC_DEFAULT)
         {
-            bRet = false;
-            break;
+            OGRwkbGeometryType eTargetType =
+                poDstGeometry->getGeometryType();
+            eTargetType =
+                ConvertType(m_eGeomTypeConversion, eTargetType);
+            poDstGeometry = OGRGeometryFactory::forceTo(
+                poDstGeometry, eTargetType);
         }
+        else if (eGType != GEOMTYPE_UNCHANGED)
+        {
+            poDstGeometry = OGRGeometryFactory::forceTo(
+                poDstGeometry,
+                static_cast<OGRwkbGeometryType>(eGType));
+        }
+    }
 
-        if (pnReadFeatureCount)
-            *pnReadFeatureCount = nCount;
+    return StepResult::OK;
+}
 
-        if (psOptions->nFIDToFetch != OGRNullFID)
-            break;
-        if (poFeatureIn != nullptr)
-            break;
-    }
+/************************************************************************/
+/*             LayerTranslator::ReportReprojectionFailure()             */
+/************************************************************************/
 
+// Returns false if the translation must be aborted.
+bool LayerTranslator::ReportReprojectionFailure(
+    TargetLayerInfo *psInfo, GIntBig nSrcFID,
+    const GDALVectorTranslateOptions *psOptions)
+{
     if (psOptions->nGroupTransactions)
     {
         if (psOptions->nLayerTransaction)
         {
-            if (poDstLayer->CommitTransaction() != OGRERR_NONE)
-                bRet = false;
+            if (psInfo->m_poDstLayer->CommitTransaction() != OGRERR_NONE &&
+                !psOptions->bSkipFailures)
+            {
+                return false;
+            }
         }
     }
 
-    if (poFeatureIn == nullptr)
+    CPLError(CE_Failure, CPLE_AppDefined,
+             "Failed to reproject feature " CPL_FRMT_GIB
+             " (geometry probably out of source or "
+             "destination SRS).",
+             nSrcFID);
+    return psOptions->bSkipFailures;
+}
+
+/************************************************************************/
+/*                    LayerTranslator::WriteFeature()                   */
+/************************************************************************/
+
+// Returns false if the translation must be aborted.
+bool LayerTranslator::WriteFeature(TargetLayerInfo *psInfo,
+                                   OGRFeature *poDstFeature, GIntBig nSrcFID,
+                                   GIntBig nDesiredFID,
+                                   GIntBig &nFeaturesWritten,
+                                   const GDALVectorTranslateOptions *psOptions)
+{
+    OGRLayer *poSrcLayer = psInfo->m_poSrcLayer;
+    OGRLayer *poDstLayer = psInfo->m_poDstLayer;
+
+    CPLErrorReset();
+    if ((psOptions->bUpsert
+             ? poDstLayer->UpsertFeature(poDstFeature)
+             : poDstLayer->CreateFeature(poDstFeature)) ==
+        OGRERR_NONE)
+    {
+        nFeaturesWritten++;
+        if (nDesiredFID != OGRNullFID &&
+            poDstFeature->GetFID() != nDesiredFID)
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Feature id " CPL_FRMT_GIB " not preserved",
+                     nDesiredFID);
+        }
+    }
+    else if (!psOptions->bSkipFailures)
+    {
+        if (psOptions->nGroupTransactions)
+        {
+            if (psOptions->nLayerTransaction)
+                poDstLayer->RollbackTransaction();
+        }
+
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Unable to write feature " CPL_FRMT_GIB
+                 " from layer %s.",
+                 nSrcFID, poSrcLayer->GetName());
+
+        return false;
+    }
+    else
     {
         CPLDebug("GDALVectorTranslate",
-                 CPL_FRMT_GIB " features written in layer '%s'",
-                 nFeaturesWritten, poDstLayer->GetName());
+                 "Unable to write feature " CPL_FRMT_GIB
+                 " into layer %s.",
+                 nSrcFID, poSrcLayer->GetName());
+        if (psOptions->nGroupTransactions)
+        {
+            if (psOptions->nLayerTransaction)
+            {
+                poDstLayer->RollbackTransaction();
+                CPL_IGNORE_RET_VAL(poDstLayer->StartTransaction());
+            }
+            else
+            {
+                m_poODS->RollbackTransaction();
+                m_poODS->StartTransaction(psOptions->bForceTransaction);
+            }
+        }
     }
 
-    return bRet;
+    return true;
 }
 
 /************************************************************************/
@@ -6366,6 +7214,8 @@ LayerTranslator::GetDstClipGeom(const OGRSpatialReference *poGeomSRS)
         if (poClipDstSRS && poGeomSRS && !poClipDstSRS->IsSame(poGeomSRS))
         {
             // Transform clip geom to geometry SRS
+            m_poClipDstPrepared.reset();
+            m_poClipDstPreparedFrom = nullptr;
             m_poClipDstReprojectedToDstSRS.reset(m_poClipDstOri->clone());
             if (m_poClipDstReprojectedToDstSRS->transformTo(poGeomSRS) !=
                 OGRERR_NONE)
@@ -6406,6 +7256,8 @@ LayerTranslator::GetSrcClipGeom(const OGRSpatialReference *poGeomSRS)
         if (poClipSrcSRS && poGeomSRS && !poClipSrcSRS->IsSame(poGeomSRS))
         {
             // Transform clip geom to geometry SRS
+            m_poClipSrcPrepared.reset();
+            m_poClipSrcPreparedFrom = nullptr;
             m_poClipSrcReprojectedToSrcSRS.reset(m_poClipSrcOri->clone());
             if (m_poClipSrcReprojectedToSrcSRS->transformTo(poGeomSRS) !=
                 OGRERR_NONE)
@@ -6432,6 +7284,32 @@ LayerTranslator::GetSrcClipGeom(const OGRSpatialReference *poGeomSRS)
                                           : m_poClipSrcOri;
 }
 
+/************************************************************************/
+/*               LayerTranslator::ClipGeomIntersects()                  */
+/************************************************************************/
+
+/* Returns whether poGeom intersects poClipGeom, using (and lazily
+ * creating) a prepared version of poClipGeom, which is much faster when
+ * the clip geometry is complex. */
+bool LayerTranslator::ClipGeomIntersects(
+    const OGRGeometry *poClipGeom, OGRPreparedGeometryUniquePtr &poPrepared,
+    const OGRGeometry *&poPreparedFrom, const OGRGeometry *poGeom)
+{
+    if (poPreparedFrom != poClipGeom)
+    {
+        poPrepared.reset(OGRCreatePreparedGeometry(
+            OGRGeometry::ToHandle(const_cast<OGRGeometry *>(poClipGeom))));
+        poPreparedFrom = poClipGeom;
+    }
+    if (poPrepared)
+    {
+        return CPL_TO_BOOL(OGRPreparedGeometryIntersects(
+            poPrepared.get(),
+            OGRGeometry::ToHandle(const_cast<OGRGeometry *>(poGeom))));
+    }
+    return CPL_TO_BOOL(poClipGeom->Intersects(poGeom));
+}
+
 /************************************************************************/
 /*                   CHECK_HAS_ENOUGH_ADDITIONAL_ARGS()                 */
 /************************************************************************/
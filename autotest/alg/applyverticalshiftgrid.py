@@ -355,3 +355,36 @@ def test_applyverticalshiftgrid_7():
     assert cs == 4783
 
     gdal.Unlink("tmp/applyverticalshiftgrid_7.gtx")
+
+
+###############################################################################
+# Test multi-threaded processing of requests spanning several blocks
+
+
+def test_applyverticalshiftgrid_num_threads():
+
+    src_ds = gdal.Open("../gcore/data/byte.tif")
+    grid_ds = gdal.Warp(
+        "", src_ds, format="MEM", dstSRS="EPSG:4326", width=40, height=40
+    )
+    options = ["RESAMPLING=BILINEAR", "MAX_ERROR=0", "BLOCKSIZE=8"]
+    out_ds = gdal.ApplyVerticalShiftGrid(src_ds, grid_ds, options=options)
+    expected_data = out_ds.GetRasterBand(1).ReadRaster(buf_type=gdal.GDT_Float32)
+
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        out_ds = gdal.ApplyVerticalShiftGrid(src_ds, grid_ds, options=options)
+        assert (
+            out_ds.GetRasterBand(1).ReadRaster(buf_type=gdal.GDT_Float32)
+            == expected_data
+        )
+
+    # Missing grid values
+    grid_ds = gdal.GetDriverByName("MEM").Create("", 1, 1)
+    grid_ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+    grid_ds.SetProjection(src_ds.GetProjectionRef())
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        out_ds = gdal.ApplyVerticalShiftGrid(
+            src_ds, grid_ds, options=options + ["ERROR_ON_MISSING_VERT_SHIFT=YES"]
+        )
+        with pytest.raises(Exception, match="Missing vertical grid value"):
+            out_ds.GetRasterBand(1).ReadRaster()
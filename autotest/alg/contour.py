@@ -28,6 +28,7 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import math
 import struct
 
 import gdaltest
@@ -400,3 +401,51 @@ def test_contour_raster_acquisition_error():
         gdal.ContourGenerateEx(
             ds.GetRasterBand(1), ogr_lyr, options=["LEVEL_INTERVAL=1", "ID_FIELD=0"]
         )
+
+
+###############################################################################
+# Test that NUM_THREADS generates the same lines as a single thread, although
+# in a different order
+
+
+@pytest.mark.parametrize("nodata", [None, -9999])
+def test_contour_num_threads(nodata):
+
+    xsize = 137
+    ysize = 251
+    src_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, 1, gdal.GDT_Float64)
+    values = []
+    for y in range(ysize):
+        for x in range(xsize):
+            if nodata is not None and (x // 7 + y // 5) % 11 == 0:
+                values.append(nodata)
+            else:
+                values.append(
+                    50 * math.sin(x * 0.07) * math.cos(y * 0.05) + (x * y % 17) * 0.3
+                )
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, xsize, ysize, struct.pack("d" * len(values), *values)
+    )
+
+    def get_stats(num_threads):
+        ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+        ogr_lyr = ogr_ds.CreateLayer("contour", geom_type=ogr.wkbLineString)
+        ogr_lyr.CreateField(ogr.FieldDefn("ID", ogr.OFTInteger))
+        ogr_lyr.CreateField(ogr.FieldDefn("elev", ogr.OFTReal))
+        options = ["LEVEL_INTERVAL=7", "ID_FIELD=0", "ELEV_FIELD=1"]
+        options.append("NUM_THREADS=" + str(num_threads))
+        if nodata is not None:
+            options.append("NODATA=" + str(nodata))
+        gdal.ContourGenerateEx(src_ds.GetRasterBand(1), ogr_lyr, options=options)
+        stats = {}
+        for f in ogr_lyr:
+            count, length = stats.get(f["elev"], (0, 0))
+            stats[f["elev"]] = (count + 1, length + f.GetGeometryRef().Length())
+        return stats
+
+    ref_stats = get_stats(1)
+    stats = get_stats(4)
+    assert stats.keys() == ref_stats.keys()
+    for elev in ref_stats:
+        assert stats[elev][0] == ref_stats[elev][0], elev
+        assert stats[elev][1] == pytest.approx(ref_stats[elev][1], rel=1e-10), elev
@@ -116,3 +116,37 @@ def test_cutline_4():
 
 
 ###############################################################################
+
+
+@pytest.mark.require_geos
+@pytest.mark.parametrize("blend_dist", [0, 3])
+def test_cutline_prepared_many_chunks(blend_dist):
+
+    # Ring-shaped cutline with many vertices, so that some chunks are fully
+    # inside, some fully outside (in the hole), and others are partially
+    # covered by the cutline.
+    import math
+
+    def ring(radius):
+        return ",".join(
+            "%f %f"
+            % (
+                50 + radius * math.cos(2 * math.pi * i / 1000),
+                50 + radius * math.sin(2 * math.pi * i / 1000),
+            )
+            for i in range(1001)
+        )
+
+    options = {
+        "format": "MEM",
+        "warpOptions": [
+            "CUTLINE=POLYGON((%s),(%s))" % (ring(45), ring(20)),
+            "CUTLINE_BLEND_DIST=%d" % blend_dist,
+        ],
+    }
+
+    src_ds = gdal.Open("../gcore/data/utmsmall.tif")
+    ref_ds = gdal.Warp("", src_ds, **options)
+    # Warp memory limit of 10000 bytes, to force many chunks
+    out_ds = gdal.Warp("", src_ds, warpMemoryLimit=10000, **options)
+    assert out_ds.ReadRaster() == ref_ds.ReadRaster()
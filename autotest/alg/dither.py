@@ -98,3 +98,25 @@ def test_dither_1():
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test that the color table computed with a multi-threaded histogram is the
+# same as the single-threaded one
+
+
+def test_dither_median_cut_num_threads():
+
+    src_ds = gdal.Open("../gdrivers/data/rgbsmall.tif")
+    bands = [src_ds.GetRasterBand(i + 1) for i in range(3)]
+
+    ref_ct = gdal.ColorTable()
+    gdal.ComputeMedianCutPCT(bands[0], bands[1], bands[2], 16, ref_ct)
+
+    ct = gdal.ColorTable()
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        gdal.ComputeMedianCutPCT(bands[0], bands[1], bands[2], 16, ct)
+
+    assert [ct.GetColorEntry(i) for i in range(ct.GetCount())] == [
+        ref_ct.GetColorEntry(i) for i in range(ref_ct.GetCount())
+    ]
@@ -256,3 +256,94 @@ def test_fillnodata_user_provided_mask_with_smoothing():
     )
     got = [x for x in struct.unpack("f" * (5 * 5), targetBand.ReadRaster())]
     assert got == pytest.approx(expected, 1e-5)
+
+
+###############################################################################
+# Test that NUM_THREADS gives the same result as a single thread
+
+
+def test_fillnodata_num_threads():
+
+    width = 200
+    height = 150
+    ar = []
+    for j in range(height):
+        for i in range(width):
+            if (i // 20 + j // 15) % 3 == 0:
+                ar.append(0)
+            else:
+                ar.append(1 + (i * 7 + j * 13) % 250)
+    ar = struct.pack("B" * (width * height), *ar)
+
+    res = []
+    for num_threads in (1, 4):
+        ds = gdal.GetDriverByName("MEM").Create("", width, height)
+        ds.GetRasterBand(1).SetNoDataValue(0)
+        ds.WriteRaster(0, 0, width, height, ar)
+        gdal.FillNodata(
+            targetBand=ds.GetRasterBand(1),
+            maskBand=None,
+            maxSearchDist=10,
+            smoothingIterations=0,
+            options=["NUM_THREADS=%d" % num_threads],
+        )
+        res.append(ds.ReadRaster())
+    assert res[0] == res[1]
+
+
+###############################################################################
+# Test INTERPOLATION=PYRAMID
+
+
+def test_fillnodata_pyramid():
+
+    ds = gdal.GetDriverByName("MEM").Create("", 20, 10, 1, gdal.GDT_Float32)
+    band = ds.GetRasterBand(1)
+    band.SetNoDataValue(0)
+    band.Fill(5)
+    band.WriteRaster(3, 2, 10, 6, struct.pack("f" * 60, *([0] * 60)))
+    gdal.FillNodata(
+        targetBand=band,
+        maskBand=None,
+        maxSearchDist=100,
+        smoothingIterations=0,
+        options=["INTERPOLATION=PYRAMID"],
+    )
+    assert struct.unpack("f" * 200, band.ReadRaster()) == pytest.approx(
+        [5] * 200, abs=1e-5
+    )
+
+    # Linear ramp with a hole: filled values stay within the range of the
+    # valid ones
+    ds = gdal.GetDriverByName("MEM").Create("", 20, 10, 1, gdal.GDT_Float32)
+    band = ds.GetRasterBand(1)
+    band.SetNoDataValue(0)
+    ar = [1 + i for j in range(10) for i in range(20)]
+    for j in range(2, 8):
+        for i in range(3, 13):
+            ar[j * 20 + i] = 0
+    band.WriteRaster(0, 0, 20, 10, struct.pack("f" * 200, *ar))
+    gdal.FillNodata(
+        targetBand=band,
+        maskBand=None,
+        maxSearchDist=100,
+        smoothingIterations=2,
+        options=["INTERPOLATION=PYRAMID"],
+    )
+    got = struct.unpack("f" * 200, band.ReadRaster())
+    assert min(got) >= 1
+    assert max(got) <= 20
+    assert got[5 * 20 + 4] < got[5 * 20 + 11]
+
+
+def test_fillnodata_invalid_interpolation():
+
+    ds = gdal.GetDriverByName("MEM").Create("", 2, 2)
+    with pytest.raises(Exception, match="INTERPOLATION"):
+        gdal.FillNodata(
+            targetBand=ds.GetRasterBand(1),
+            maskBand=None,
+            maxSearchDist=10,
+            smoothingIterations=0,
+            options=["INTERPOLATION=INVALID"],
+        )
@@ -448,3 +448,52 @@ def test_polygonize_8():
         wkt
         == "POLYGON ((1 4,1 3,0 3,0 1,1 1,1 0,3 0,3 1,4 1,4 3,3 3,3 4,1 4),(1 3,3 3,3 1,1 1,1 3))"
     )
+
+
+###############################################################################
+# Test that NUM_THREADS produces the same output as the single threaded
+# code path, on a raster spanning several strips and many features.
+
+
+@pytest.mark.parametrize("is_int_polygonize", [True, False])
+def test_polygonize_num_threads(is_int_polygonize):
+
+    xsize = 500
+    ysize = 5000
+    src_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize)
+    src_band = src_ds.GetRasterBand(1)
+    src_band.SetNoDataValue(0)
+    src_band.WriteRaster(
+        0,
+        0,
+        xsize,
+        ysize,
+        bytes(
+            ((x // 3) * 7 + (y // 2) * 13) % 5
+            for y in range(ysize)
+            for x in range(xsize)
+        ),
+    )
+
+    mem_ds = ogr.GetDriverByName("Memory").CreateDataSource("out")
+
+    def polygonize(num_threads):
+        lyr = mem_ds.CreateLayer("poly_" + num_threads, None, ogr.wkbPolygon)
+        lyr.CreateField(ogr.FieldDefn("DN", ogr.OFTInteger))
+        options = ["NUM_THREADS=" + num_threads]
+        mask_band = src_band.GetMaskBand()
+        if is_int_polygonize:
+            result = gdal.Polygonize(src_band, mask_band, lyr, 0, options)
+        else:
+            result = gdal.FPolygonize(src_band, mask_band, lyr, 0, options)
+        assert result == 0, "Polygonize failed"
+        return lyr
+
+    ref_lyr = polygonize("1")
+    lyr = polygonize("2")
+
+    assert ref_lyr.GetFeatureCount() > 1000
+    assert lyr.GetFeatureCount() == ref_lyr.GetFeatureCount()
+    for ref_f, f in zip(ref_lyr, lyr):
+        assert f.GetField("DN") == ref_f.GetField("DN")
+        assert f.GetGeometryRef().Equals(ref_f.GetGeometryRef())
@@ -29,6 +29,9 @@
 ###############################################################################
 
 
+import math
+import struct
+
 import pytest
 
 from osgeo import gdal
@@ -126,3 +129,58 @@ def test_proximity_3():
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test the exact Euclidean distance transform against a brute force
+# computation
+
+
+@pytest.mark.parametrize("num_threads", [1, 3])
+def test_proximity_edt(num_threads):
+
+    src_ds = gdal.Open("data/pat.tif")
+    src_band = src_ds.GetRasterBand(1)
+    xsize = src_ds.RasterXSize
+    ysize = src_ds.RasterYSize
+
+    dst_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, 1, gdal.GDT_Float32)
+    dst_band = dst_ds.GetRasterBand(1)
+
+    gdal.ComputeProximity(
+        src_band,
+        dst_band,
+        options=[
+            "VALUES=65,64",
+            "MAXDIST=12",
+            "NODATA=-1",
+            "ALGORITHM=EDT",
+            "NUM_THREADS=%d" % num_threads,
+        ],
+    )
+
+    src_values = struct.unpack(
+        "i" * (xsize * ysize), src_band.ReadRaster(buf_type=gdal.GDT_Int32)
+    )
+    targets = [
+        (i % xsize, i // xsize) for i, v in enumerate(src_values) if v in (64, 65)
+    ]
+    assert targets
+    got = struct.unpack("f" * (xsize * ysize), dst_band.ReadRaster())
+    for y in range(ysize):
+        for x in range(xsize):
+            dist = min(math.hypot(x - tx, y - ty) for tx, ty in targets)
+            expected = dist if dist <= 12 else -1
+            assert got[y * xsize + x] == pytest.approx(expected, abs=1e-5), (x, y)
+
+
+def test_proximity_invalid_algorithm():
+
+    src_ds = gdal.Open("data/pat.tif")
+    dst_ds = gdal.GetDriverByName("MEM").Create("", 25, 25, 1, gdal.GDT_Float32)
+    with pytest.raises(Exception, match="Unrecognized ALGORITHM"):
+        gdal.ComputeProximity(
+            src_ds.GetRasterBand(1),
+            dst_ds.GetRasterBand(1),
+            options=["ALGORITHM=FOO"],
+        )
@@ -1011,3 +1011,59 @@ def test_rasterize_bugfix_gh8918(wkt):
     )
 
     assert target_ds.GetRasterBand(1).Checksum() == 36
+
+
+###############################################################################
+# Test that rasterizing a layer by several chunks, where features are binned
+# by chunk in a temporary file, gives the same result as with a single chunk
+
+
+@pytest.mark.parametrize(
+    "options",
+    [
+        [],
+        ["ALL_TOUCHED=YES"],
+        ["MERGE_ALG=ADD"],
+        ["ATTRIBUTE=val"],
+    ],
+)
+def test_rasterize_layer_several_chunks(options):
+
+    sr_wkt = 'LOCAL_CS["arbitrary"]'
+    sr = osr.SpatialReference(sr_wkt)
+
+    rast_ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("wrk")
+    lyr = rast_ogr_ds.CreateLayer("lyr", srs=sr)
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTReal))
+    for val, wkt in [
+        (10, "POLYGON((2 3,2 95,40 95,40 3,2 3))"),
+        (20, "POLYGON((30 40,30 60,80 60,80 40,30 40))"),
+        (30, "LINESTRING(0 0,99 99)"),
+        (40, "MULTIPOINT(5 5,50 50,95 95)"),
+        (50, "POLYGON((60 70,60 71,61 71,61 70,60 70))"),
+        (60, None),
+        (70, "POLYGON((200 200,200 300,300 300,300 200,200 200))"),
+    ]:
+        feat = ogr.Feature(lyr.GetLayerDefn())
+        feat["val"] = val
+        if wkt:
+            feat.SetGeometryDirectly(ogr.Geometry(wkt=wkt))
+        lyr.CreateFeature(feat)
+
+    def rasterize(chunkysize):
+        ds = gdal.GetDriverByName("MEM").Create("", 100, 100, 1, gdal.GDT_Byte)
+        ds.SetGeoTransform((0, 1, 0, 0, 0, 1))
+        ds.SetProjection(sr_wkt)
+        gdal.RasterizeLayer(
+            ds,
+            [1],
+            lyr,
+            burn_values=[] if "ATTRIBUTE=val" in options else [5],
+            options=options + ["CHUNKYSIZE=%d" % chunkysize],
+        )
+        return ds.GetRasterBand(1).ReadRaster()
+
+    expected = rasterize(100)
+    assert expected != b"\x00" * (100 * 100)
+    assert rasterize(7) == expected
+    assert rasterize(1) == expected
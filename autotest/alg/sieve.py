@@ -328,3 +328,40 @@ cellsize     60.000000000000
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test that multi-threaded processing gives the same result as single-threaded
+
+
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize("use_mask", [False, True])
+def test_sieve_num_threads(connectedness, use_mask):
+
+    numpy = pytest.importorskip("numpy")
+
+    numpy.random.seed(0)
+    ar = numpy.random.randint(0, 4, size=(257, 301)).astype(numpy.uint8)
+    src_ds = gdal.GetDriverByName("MEM").Create("", 301, 257)
+    src_ds.GetRasterBand(1).WriteArray(ar)
+    mask_band = None
+    if use_mask:
+        src_ds.GetRasterBand(1).SetNoDataValue(0)
+        mask_band = src_ds.GetRasterBand(1).GetMaskBand()
+
+    def run(options):
+        dst_ds = gdal.GetDriverByName("MEM").Create("", 301, 257)
+        gdal.SieveFilter(
+            src_ds.GetRasterBand(1),
+            mask_band,
+            dst_ds.GetRasterBand(1),
+            5,
+            connectedness,
+            options=options,
+        )
+        return dst_ds.GetRasterBand(1).ReadAsArray()
+
+    ref = run([])
+    for num_threads in ("2", "4", "ALL_CPUS"):
+        got = run(["NUM_THREADS=" + num_threads])
+        assert numpy.array_equal(got, ref), num_threads
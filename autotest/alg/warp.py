@@ -1669,3 +1669,191 @@ def test_warp_average_oversampling():
             assert math.isnan(got_data[(y + 4) * 14 + (14 - 1 - x)])
         for x in range(6):
             assert got_data[(y + 4) * 14 + (x + 4)] == 3.0
+
+
+###############################################################################
+# Test reading ahead the source windows of chunks with ChunkAndWarpMulti()
+
+
+@pytest.mark.parametrize("prefetch_chunks", ["AUTO", "2", "NO"])
+def test_warp_multi_prefetch_chunks(tmp_vsimem, prefetch_chunks):
+
+    src_filename = str(tmp_vsimem / "src.tif")
+    src_ds = gdal.Translate(
+        src_filename,
+        "../gcore/data/byte.tif",
+        options="-outsize 1000 1000 -co TILED=YES -co BLOCKXSIZE=64 -co BLOCKYSIZE=64",
+    )
+    src_ds = None
+
+    ref_ds = gdal.Warp(
+        "", src_filename, format="MEM", dstSRS="EPSG:4326", warpMemoryLimit=100000
+    )
+
+    src_ds = gdal.Open(src_filename)
+    out_ds = gdal.Warp(
+        "",
+        src_ds,
+        format="MEM",
+        dstSRS="EPSG:4326",
+        warpMemoryLimit=100000,
+        multithread=True,
+        warpOptions=["PREFETCH_CHUNKS=" + prefetch_chunks],
+    )
+    assert out_ds.GetRasterBand(1).Checksum() == ref_ds.GetRasterBand(1).Checksum()
+
+
+###############################################################################
+# Test that reusing the overlap of the source windows of consecutive chunks
+# gives the same result as warping in a single chunk
+
+
+@pytest.mark.parametrize("multithread", [False, True])
+def test_warp_reuse_source_window_of_previous_chunk(tmp_vsimem, multithread):
+
+    src_filename = str(tmp_vsimem / "src.tif")
+    gdal.Translate(
+        src_filename, "../gcore/data/byte.tif", options="-outsize 1000 1000"
+    )
+
+    ref_ds = gdal.Warp(
+        "",
+        src_filename,
+        format="MEM",
+        dstSRS="EPSG:32611",
+        resampleAlg="cubic",
+        errorThreshold=0,
+    )
+
+    out_ds = gdal.Warp(
+        "",
+        src_filename,
+        format="MEM",
+        dstSRS="EPSG:32611",
+        resampleAlg="cubic",
+        errorThreshold=0,
+        warpMemoryLimit=100000,
+        multithread=multithread,
+    )
+    assert out_ds.GetRasterBand(1).Checksum() == ref_ds.GetRasterBand(1).Checksum()
+
+
+###############################################################################
+# Test GDAL_WARP_TRANSFORM_CACHE_MAX
+
+
+def test_warp_transform_cache():
+
+    src_ds = gdal.Open("../gcore/data/byte.tif")
+    ref_cs = {}
+    for srs in ("EPSG:4326", "EPSG:32611"):
+        ref_ds = gdal.Warp("", src_ds, format="MEM", dstSRS=srs)
+        ref_cs[srs] = ref_ds.GetRasterBand(1).Checksum()
+
+    with gdal.config_option("GDAL_WARP_TRANSFORM_CACHE_MAX", "10"):
+        # Second warps with each transformer are served from the cache
+        for i in range(2):
+            for srs in ("EPSG:4326", "EPSG:32611"):
+                out_ds = gdal.Warp("", src_ds, format="MEM", dstSRS=srs)
+                assert out_ds.GetRasterBand(1).Checksum() == ref_cs[srs]
+
+
+###############################################################################
+# Test that the no-mask average and Byte quantile code paths give the same
+# results as the generic ones
+
+
+@pytest.mark.parametrize("resampling", ["average", "med", "q1", "q3"])
+def test_warp_average_quantile_fast_paths(resampling):
+
+    src_ds = gdal.Open("../gcore/data/byte.tif")
+
+    out_ds = gdal.Warp(
+        "", src_ds, format="MEM", width=7, height=7, resampleAlg=resampling
+    )
+    # A nodata value absent from the source forces the masked code path,
+    # and a Float32 working type forces the sorting of the values for quantiles.
+    ref_ds = gdal.Warp(
+        "",
+        src_ds,
+        format="MEM",
+        width=7,
+        height=7,
+        resampleAlg=resampling,
+        srcNodata=1,
+        dstNodata=1,
+        workingType=gdal.GDT_Byte if resampling == "average" else gdal.GDT_Float32,
+    )
+    assert out_ds.ReadRaster() == ref_ds.ReadRaster()
+
+
+###############################################################################
+# Test that caching the resampling weights of target columns with an affine
+# transformation without rotation does not change the results
+
+
+@pytest.mark.parametrize("resampling", ["cubic", "cubicspline", "lanczos"])
+@pytest.mark.parametrize("size", [7, 31])
+def test_warp_affine_no_rotation_cached_weights(resampling, size):
+
+    src_ds = gdal.Open("../gcore/data/byte.tif")
+
+    def warp():
+        # srcNodata forces the general case of the warp kernel
+        return gdal.Warp(
+            "",
+            src_ds,
+            format="MEM",
+            width=size,
+            height=size,
+            resampleAlg=resampling,
+            srcNodata=0,
+            outputType=gdal.GDT_Float32,
+        ).ReadRaster()
+
+    with gdal.config_option("GDAL_WARP_USE_AFFINE_OPTIMIZATION", "NO"):
+        ref_data = warp()
+    assert warp() == ref_data
+
+
+###############################################################################
+# Test that chunks whose source window only has missing blocks are skipped
+# without changing the result
+
+
+@pytest.mark.parametrize("skip_nosource", ["YES", "NO"])
+def test_warp_skip_empty_source(tmp_vsimem, skip_nosource):
+
+    src_filename = str(tmp_vsimem / "sparse.tif")
+    src_ds = gdal.GetDriverByName("GTiff").Create(
+        src_filename,
+        256,
+        256,
+        1,
+        options=["SPARSE_OK=YES", "TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=32"],
+    )
+    src_ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).WriteRaster(
+        40, 40, 20, 20, b"".join(bytes([i + 1] * 20) for i in range(20))
+    )
+    src_ds = None
+
+    def warp(skip_empty_source):
+        return gdal.Warp(
+            "",
+            src_filename,
+            format="MEM",
+            outputBounds=[-8, -264, 264, 8],
+            xRes=1,
+            yRes=1,
+            warpMemoryLimit=10000,
+            warpOptions=[
+                # SKIP_NOSOURCE=YES does not initialize the skipped chunks
+                "INIT_DEST=" + ("NO_DATA" if skip_nosource == "YES" else "255"),
+                "SKIP_NOSOURCE=" + skip_nosource,
+                "SKIP_EMPTY_SOURCE=" + skip_empty_source,
+            ],
+        ).ReadRaster()
+
+    assert warp("YES") == warp("NO")
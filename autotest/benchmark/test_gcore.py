@@ -0,0 +1,154 @@
+#!/usr/bin/env pytest
+# -*- coding: utf-8 -*-
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Benchmarking of raster core (block cache, RasterIO)
+# Author:   Even Rouault <even dot rouault at spatialys.com>
+#
+###############################################################################
+# Copyright (c) 2024, Even Rouault <even dot rouault at spatialys.com>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import array
+from threading import Thread
+
+import gdaltest
+import pytest
+
+from osgeo import gdal
+
+# Must be set to run the test_XXX functions under the benchmark fixture
+pytestmark = pytest.mark.usefixtures("decorate_with_benchmark")
+
+
+def get_size():
+    if "debug" in gdal.VersionInfo(""):
+        return 512
+    return 2048
+
+
+@pytest.fixture()
+def source_ds_filename(tmp_vsimem):
+    filename = str(tmp_vsimem / "source.tif")
+    size = get_size()
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename,
+        size,
+        size,
+        1,
+        options=["TILED=YES", "BLOCKXSIZE=256", "BLOCKYSIZE=256"],
+    )
+    ds.GetRasterBand(1).WriteRaster(
+        0, 0, size, size, array.array("B", [i % 251 for i in range(size * size)])
+    )
+    ds = None
+    return filename
+
+
+@pytest.mark.parametrize("num_threads", [1, 4, 16])
+def test_block_cache_contention(source_ds_filename, num_threads):
+    size = get_size()
+    nloops = 16 // num_threads
+
+    def thread_function():
+        ds = gdal.Open(source_ds_filename)
+        band = ds.GetRasterBand(1)
+        for i in range(nloops):
+            # Go through the block cache, line of blocks per line of blocks
+            for y in range(0, size, 256):
+                band.ReadRaster(0, y, size, 256)
+            band.FlushCache()
+
+    # Cache smaller than the raster, so that blocks are evicted concurrently
+    with gdaltest.SetCacheMax(size * size // 4):
+        threads_array = []
+        for i in range(num_threads):
+            t = Thread(target=thread_function)
+            t.start()
+            threads_array.append(t)
+        for t in threads_array:
+            t.join()
+
+
+@pytest.mark.parametrize(
+    "resample_alg",
+    [
+        gdal.GRIORA_NearestNeighbour,
+        gdal.GRIORA_Bilinear,
+        gdal.GRIORA_Cubic,
+        gdal.GRIORA_CubicSpline,
+        gdal.GRIORA_Lanczos,
+        gdal.GRIORA_Average,
+        gdal.GRIORA_Mode,
+        gdal.GRIORA_Gauss,
+    ],
+    ids=[
+        "near",
+        "bilinear",
+        "cubic",
+        "cubicspline",
+        "lanczos",
+        "average",
+        "mode",
+        "gauss",
+    ],
+)
+@pytest.mark.parametrize("factor", [3, 0.75], ids=["downsampling", "upsampling"])
+def test_rasterio_resampling(source_ds_filename, resample_alg, factor):
+    size = get_size()
+    ds = gdal.Open(source_ds_filename)
+    ds.GetRasterBand(1).ReadRaster(
+        buf_xsize=int(size / factor),
+        buf_ysize=int(size / factor),
+        resample_alg=resample_alg,
+    )
+
+
+@pytest.mark.parametrize(
+    "src_type,dst_type",
+    [
+        (gdal.GDT_Byte, gdal.GDT_Byte),
+        (gdal.GDT_Byte, gdal.GDT_UInt16),
+        (gdal.GDT_Byte, gdal.GDT_Float32),
+        (gdal.GDT_UInt16, gdal.GDT_Byte),
+        (gdal.GDT_Int16, gdal.GDT_Float32),
+        (gdal.GDT_Float32, gdal.GDT_Byte),
+        (gdal.GDT_Float32, gdal.GDT_Int16),
+        (gdal.GDT_Float64, gdal.GDT_Float32),
+    ],
+    ids=lambda x: gdal.GetDataTypeName(x),
+)
+@pytest.mark.parametrize("interleave", ["BAND", "PIXEL"])
+def test_rasterio_copywords(src_type, dst_type, interleave):
+    # Exercises GDALCopyWords() through data type conversions and
+    # (de)interleaving
+    size = get_size()
+    ds = gdal.GetDriverByName("MEM").Create(
+        "", size, size, 3, src_type, options=["INTERLEAVE=" + interleave]
+    )
+    ds.ReadRaster(buf_type=dst_type)
+    ds.ReadRaster(
+        buf_type=dst_type,
+        buf_pixel_space=3 * gdal.GetDataTypeSize(dst_type) // 8,
+        buf_band_space=gdal.GetDataTypeSize(dst_type) // 8,
+    )
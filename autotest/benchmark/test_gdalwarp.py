@@ -71,3 +71,31 @@ def test_gdalwarp(tmp_vsimem, source_ds_filename, num_threads, resample_alg):
             source_ds_filename,
             options=f"-co TILED=YES -r {resample_alg} -t_srs EPSG:4326",
         )
+
+
+@pytest.mark.parametrize(
+    "resample_alg",
+    [
+        "near",
+        "bilinear",
+        "cubic",
+        "cubicspline",
+        "lanczos",
+        "average",
+        "rms",
+        "mode",
+        "min",
+        "max",
+        "med",
+        "sum",
+    ],
+)
+def test_gdalwarp_kernel(source_ds_filename, resample_alg):
+    # Single-threaded warping to a MEM dataset, so that the timing is
+    # dominated by the warp kernel of each resampling method
+    with gdaltest.config_option("GDAL_NUM_THREADS", "1"):
+        gdal.Warp(
+            "",
+            source_ds_filename,
+            options=f"-of MEM -r {resample_alg} -t_srs EPSG:32631 -tr 1.5 1.5",
+        )
@@ -181,3 +181,62 @@ def test_gtiff_build_overviews(tmp_vsimem, source_ds_2048x2048_filename, ovr_alg
     ds = gdal.Open(filename, gdal.GA_Update)
     ds.BuildOverviews(ovr_alg, [2, 4, 8])
     ds.Close()
+
+
+def get_codec_data(width, height):
+    # Smooth gradient with some noise, to get realistic compression ratios
+    return array.array(
+        "B",
+        [
+            ((x + y) // 16 + (x * 7919 + y * 104729) % 5) % 256
+            for y in range(height)
+            for x in range(width)
+        ],
+    )
+
+
+codecs = ["NONE", "LZW", "DEFLATE", "PACKBITS", "ZSTD", "LZMA", "LERC", "WEBP", "JPEG"]
+
+
+def require_codec(codec):
+    if codec == "NONE":
+        return
+    if codec not in gdal.GetDriverByName("GTiff").GetMetadataItem(
+        "DMD_CREATIONOPTIONLIST"
+    ):
+        pytest.skip(f"{codec} codec not available")
+
+
+@pytest.mark.parametrize("codec", codecs)
+def test_gtiff_codec_write(tmp_vsimem, codec):
+    require_codec(codec)
+    width = 1024
+    height = 1024
+    data = get_codec_data(width, height)
+    filename = str(tmp_vsimem / "test.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename, width, height, 1, options=["TILED=YES", "COMPRESS=" + codec]
+    )
+    ds.GetRasterBand(1).WriteRaster(0, 0, width, height, data)
+    ds.Close()
+
+
+@pytest.fixture()
+def codec_ds_filename(tmp_vsimem, request):
+    codec = request.param
+    require_codec(codec)
+    width = 1024
+    height = 1024
+    filename = str(tmp_vsimem / "source.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename, width, height, 1, options=["TILED=YES", "COMPRESS=" + codec]
+    )
+    ds.GetRasterBand(1).WriteRaster(0, 0, width, height, get_codec_data(width, height))
+    ds.Close()
+    return filename
+
+
+@pytest.mark.parametrize("codec_ds_filename", codecs, indirect=True)
+def test_gtiff_codec_read(codec_ds_filename):
+    ds = gdal.Open(codec_ds_filename)
+    ds.GetRasterBand(1).ReadRaster()
@@ -78,3 +78,25 @@ def test_ogr_gpkg_spatial_index(source_file):
     for f in lyr:
         count += 1
     assert count == 10000 - 1000 + 1
+
+
+def test_ogr_gpkg_read_features(source_file):
+    ds = ogr.Open(source_file)
+    lyr = ds.GetLayer(0)
+    count = 0
+    for f in lyr:
+        count += 1
+    assert count == 50000
+
+
+def test_ogr_gpkg_read_arrow(source_file):
+    ds = ogr.Open(source_file)
+    lyr = ds.GetLayer(0)
+    stream = lyr.GetArrowStream()
+    count = 0
+    while True:
+        batch = stream.GetNextRecordBatch()
+        if batch is None:
+            break
+        count += batch.GetLength()
+    assert count == 50000
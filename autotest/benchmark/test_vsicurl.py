@@ -0,0 +1,111 @@
+#!/usr/bin/env pytest
+# -*- coding: utf-8 -*-
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Benchmarking of /vsicurl/ against a local HTTP server
+# Author:   Even Rouault <even dot rouault at spatialys.com>
+#
+###############################################################################
+# Copyright (c) 2024, Even Rouault <even dot rouault at spatialys.com>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import array
+
+import gdaltest
+import pytest
+import webserver
+
+from osgeo import gdal
+
+# Must be set to run the test_XXX functions under the benchmark fixture
+pytestmark = [
+    pytest.mark.require_curl(),
+    pytest.mark.usefixtures("decorate_with_benchmark"),
+]
+
+
+@pytest.fixture(scope="module")
+def server():
+
+    process, port = webserver.launch(handler=webserver.DispatcherHttpHandler)
+    if port == 0:
+        pytest.skip()
+
+    import collections
+
+    WebServer = collections.namedtuple("WebServer", "process port")
+
+    yield WebServer(process, port)
+
+    # Clearcache needed to close all connections, since the Python server
+    # can only handle one connection at a time
+    gdal.VSICurlClearCache()
+
+    webserver.server_stop(process, port)
+
+
+@pytest.fixture(scope="module")
+def files():
+    size = 1024
+    filename = "/vsimem/test_vsicurl_benchmark.tif"
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename, size, size, 1, options=["TILED=YES", "COMPRESS=DEFLATE"]
+    )
+    ds.GetRasterBand(1).WriteRaster(
+        0, 0, size, size, array.array("B", [i % 251 for i in range(size * size)])
+    )
+    ds.Close()
+    f = gdal.VSIFOpenL(filename, "rb")
+    tif_data = gdal.VSIFReadL(1, gdal.VSIStatL(filename).size, f)
+    gdal.VSIFCloseL(f)
+    gdal.Unlink(filename)
+
+    return {"/test.bin": b"x" * (20 * 1024 * 1024), "/test.tif": tif_data}
+
+
+@pytest.mark.parametrize("chunk_size", [16384, 1024 * 1024])
+def test_vsicurl_sequential_read(server, files, chunk_size):
+    gdal.VSICurlClearCache()
+    handler = webserver.FileHandler(files)
+    with webserver.install_http_handler(handler), gdaltest.config_option(
+        "GDAL_DISABLE_READDIR_ON_OPEN", "EMPTY_DIR"
+    ):
+        f = gdal.VSIFOpenL(f"/vsicurl/http://localhost:{server.port}/test.bin", "rb")
+        assert f
+        try:
+            while gdal.VSIFReadL(1, chunk_size, f):
+                pass
+        finally:
+            gdal.VSIFCloseL(f)
+
+
+def test_vsicurl_gtiff_windowed_read(server, files):
+    gdal.VSICurlClearCache()
+    handler = webserver.FileHandler(files)
+    with webserver.install_http_handler(handler), gdaltest.config_option(
+        "GDAL_DISABLE_READDIR_ON_OPEN", "EMPTY_DIR"
+    ):
+        ds = gdal.Open(f"/vsicurl/http://localhost:{server.port}/test.tif")
+        band = ds.GetRasterBand(1)
+        for i in range(16):
+            band.ReadRaster((i * 389) % 768, (i * 241) % 768, 256, 256)
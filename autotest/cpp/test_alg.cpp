@@ -273,4 +273,50 @@ TEST_F(test_alg, GDALAutoCreateWarpedVRT_alpha_band)
     GDALClose(hWarpedVRT);
 }
 
+// Test GDALWarpGetStatistics()
+TEST_F(test_alg, GDALWarpGetStatistics)
+{
+    auto poDriver = GDALDriver::FromHandle(GDALGetDriverByName("MEM"));
+    GDALDatasetUniquePtr poSrcDS(
+        poDriver->Create("", 20, 20, 1, GDT_Byte, nullptr));
+    double adfGeoTransform[6] = {10, 1, 0, 20, 0, -1};
+    poSrcDS->SetGeoTransform(adfGeoTransform);
+    GDALDatasetUniquePtr poDstDS(
+        poDriver->Create("", 10, 10, 1, GDT_Byte, nullptr));
+    adfGeoTransform[1] = 2;
+    adfGeoTransform[5] = -2;
+    poDstDS->SetGeoTransform(adfGeoTransform);
+
+    GDALWarpOptions *psOptions = GDALCreateWarpOptions();
+    psOptions->hSrcDS = GDALDataset::ToHandle(poSrcDS.get());
+    psOptions->hDstDS = GDALDataset::ToHandle(poDstDS.get());
+    psOptions->pfnTransformer = GDALGenImgProjTransform;
+    psOptions->pTransformerArg = GDALCreateGenImgProjTransformer2(
+        psOptions->hSrcDS, psOptions->hDstDS, nullptr);
+    ASSERT_TRUE(psOptions->pTransformerArg != nullptr);
+    // Force one chunk per destination line
+    psOptions->dfWarpMemoryLimit = 300;
+
+    GDALWarpOperationH hOperation = GDALCreateWarpOperation(psOptions);
+    ASSERT_TRUE(hOperation != nullptr);
+
+    GDALWarpStatistics sStats;
+    GDALWarpGetStatistics(hOperation, &sStats);
+    EXPECT_EQ(sStats.nChunksProcessed, 0);
+    EXPECT_EQ(sStats.nSrcBytesRead, 0);
+
+    EXPECT_EQ(GDALChunkAndWarpImage(hOperation, 0, 0, 10, 10), CE_None);
+    GDALWarpGetStatistics(hOperation, &sStats);
+    EXPECT_GT(sStats.nChunksProcessed, 1);
+    EXPECT_GE(sStats.nSrcBytesRead, 20 * 20);
+    EXPECT_EQ(sStats.nDstBytesWritten, 10 * 10);
+    EXPECT_GE(sStats.dfSrcReadTime, 0);
+    EXPECT_GE(sStats.dfTransformTime, 0);
+    EXPECT_GE(sStats.dfKernelTime, 0);
+
+    GDALDestroyWarpOperation(hOperation);
+    GDALDestroyGenImgProjTransformer(psOptions->pTransformerArg);
+    GDALDestroyWarpOptions(psOptions);
+}
+
 }  // namespace
@@ -44,6 +44,7 @@
 #include "cpl_string.h"
 #include "cpl_safemaths.hpp"
 #include "cpl_time.h"
+#include "cpl_trace.h"
 #include "cpl_json.h"
 #include "cpl_json_streaming_parser.h"
 #include "cpl_json_streaming_writer.h"
@@ -1180,6 +1181,68 @@ TEST_F(test_cpl, CPLGetConfigOptions)
     CSLDestroy(options);
 }
 
+/************************************************************************/
+/*       CPLGetConfigOption() concurrent with CPLSetConfigOption()      */
+/************************************************************************/
+TEST_F(test_cpl, CPLGetConfigOption_concurrent_set)
+{
+    CPLSetConfigOption("CPL_TEST_STABLE_KEY", "stable");
+    EXPECT_STREQ(CPLGetConfigOption("cpl_test_stable_key", nullptr),
+                 "stable");
+
+    struct Context
+    {
+        std::atomic<bool> bStop{false};
+        std::atomic<bool> bOK{true};
+
+        static void ReaderFunc(void *pData)
+        {
+            auto psCtxt = static_cast<Context *>(pData);
+            while (!psCtxt->bStop)
+            {
+                const char *pszVal =
+                    CPLGetConfigOption("CPL_TEST_STABLE_KEY", nullptr);
+                if (pszVal == nullptr || strcmp(pszVal, "stable") != 0)
+                    psCtxt->bOK = false;
+                CPLGetConfigOption("CPL_TEST_CHANGING_KEY", nullptr);
+            }
+        }
+    };
+
+    Context sCtxt;
+    std::vector<CPLJoinableThread *> apoThreads;
+    for (int i = 0; i < 4; ++i)
+        apoThreads.push_back(
+            CPLCreateJoinableThread(Context::ReaderFunc, &sCtxt));
+    for (int i = 0; i < 1000; ++i)
+    {
+        CPLSetConfigOption("CPL_TEST_CHANGING_KEY",
+                           (i % 2) == 0 ? CPLSPrintf("%d", i) : nullptr);
+    }
+    sCtxt.bStop = true;
+    for (auto hThread : apoThreads)
+        CPLJoinThread(hThread);
+    EXPECT_TRUE(sCtxt.bOK);
+
+    // Changes made in the main thread are visible from other threads
+    CPLSetConfigOption("CPL_TEST_CHANGING_KEY", "final");
+    struct Checker
+    {
+        static void Func(void *pData)
+        {
+            *static_cast<std::string *>(pData) =
+                CPLGetConfigOption("CPL_TEST_CHANGING_KEY", "");
+        }
+    };
+    std::string osVal;
+    CPLJoinThread(CPLCreateJoinableThread(Checker::Func, &osVal));
+    EXPECT_STREQ(osVal.c_str(), "final");
+
+    CPLSetConfigOption("CPL_TEST_CHANGING_KEY", nullptr);
+    CPLSetConfigOption("CPL_TEST_STABLE_KEY", nullptr);
+    EXPECT_EQ(CPLGetConfigOption("CPL_TEST_STABLE_KEY", nullptr), nullptr);
+}
+
 /************************************************************************/
 /*  CPLGetThreadLocalConfigOptions() / CPLSetThreadLocalConfigOptions() */
 /************************************************************************/
@@ -2340,6 +2403,33 @@ TEST_F(test_cpl, CPLJSonStreamingParser)
         ASSERT_TRUE(!oParser.Parse(sText, strlen(sText), true));
         ASSERT_TRUE(!oParser.GetException().empty());
     }
+    // Long strings and numbers split at all possible chunk boundaries
+    {
+        const char sText[] = "{\"some key\": [\"a long string value\\n"
+                             "with escapes \\u00e9\", -1.2345678901e+10]}";
+        const char sExpected[] = "{\"some key\": [\"a long string value\\n"
+                                 "with escapes \xc3\xa9\", -1.2345678901e+10]}";
+        const size_t nLen = strlen(sText);
+        for (size_t nChunkSize = 1; nChunkSize <= nLen; ++nChunkSize)
+        {
+            CPLJSonStreamingParserDump oParser;
+            for (size_t i = 0; i < nLen; i += nChunkSize)
+            {
+                const size_t nToParse = std::min(nChunkSize, nLen - i);
+                ASSERT_TRUE(oParser.Parse(sText + i, nToParse,
+                                          i + nToParse == nLen));
+            }
+            ASSERT_EQ(oParser.GetSerialized(), sExpected) << nChunkSize;
+        }
+    }
+    // Check that line and character counters are still correct
+    {
+        CPLJSonStreamingParserDump oParser;
+        const char sText[] = "[\"abc\",\n 12345, \"defgh\" x]";
+        ASSERT_TRUE(!oParser.Parse(sText, strlen(sText), true));
+        ASSERT_EQ(oParser.GetException(),
+                  "At line 2, character 17: Unexpected character (x)");
+    }
 }
 
 // Test cpl_mem_cache
@@ -3132,6 +3222,57 @@ TEST_F(test_cpl, cpl_minixml)
     CPLFree(str);
 }
 
+// Test cpl_minixml parsing and serialization round trip
+TEST_F(test_cpl, cpl_minixml_round_trip)
+{
+    const char *pszXML = "<?xml version=\"1.0\"?>\n"
+                         "<Root a=\"x &amp; y\" b='say \"hi\"'>\n"
+                         "  <!-- comment -->\n"
+                         "  <Elt>1 &lt; 2\nand 3 &gt; 2</Elt>\n"
+                         "  <Empty/>\n"
+                         "  <Mixed>before<Sub>in</Sub></Mixed>\n"
+                         "</Root>";
+    CPLXMLTreeCloser oTree(CPLParseXMLString(pszXML));
+    ASSERT_TRUE(oTree.get() != nullptr);
+    const CPLXMLNode *psRoot = CPLGetXMLNode(oTree.get(), "=Root");
+    ASSERT_TRUE(psRoot != nullptr);
+    EXPECT_STREQ(CPLGetXMLValue(psRoot, "a", ""), "x & y");
+    EXPECT_STREQ(CPLGetXMLValue(psRoot, "b", ""), "say \"hi\"");
+    EXPECT_STREQ(CPLGetXMLValue(psRoot, "Elt", ""), "1 < 2\nand 3 > 2");
+
+    const char *pszExpected =
+        "<?xml version=\"1.0\"?>\n"
+        "<Root a=\"x &amp; y\" b=\"say &quot;hi&quot;\">\n"
+        "  <!-- comment -->\n"
+        "  <Elt>1 &lt; 2\n"
+        "and 3 &gt; 2</Elt>\n"
+        "  <Empty />\n"
+        "  <Mixed>before\n"
+        "    <Sub>in</Sub>\n"
+        "  </Mixed>\n"
+        "</Root>\n";
+    char *pszSerialized = CPLSerializeXMLTree(oTree.get());
+    ASSERT_TRUE(pszSerialized != nullptr);
+    EXPECT_STREQ(pszSerialized, pszExpected);
+
+    // Re-parsing the serialized output must give back the same document
+    CPLXMLTreeCloser oTree2(CPLParseXMLString(pszSerialized));
+    CPLFree(pszSerialized);
+    ASSERT_TRUE(oTree2.get() != nullptr);
+    pszSerialized = CPLSerializeXMLTree(oTree2.get());
+    EXPECT_STREQ(pszSerialized, pszExpected);
+    CPLFree(pszSerialized);
+
+    // Line numbers of errors must still be reported after multi-line tokens
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    CPLXMLTreeCloser oTree3(
+        CPLParseXMLString("<a>\n<b c=\"x\ny\">\ntext\nmore</b>\n</c>"));
+    CPLPopErrorHandler();
+    EXPECT_TRUE(oTree3.get() == nullptr);
+    EXPECT_STREQ(CPLGetLastErrorMsg(),
+                 "Line 5: </c> doesn't have matching <c>.");
+}
+
 // Test CPLCharUniquePtr
 TEST_F(test_cpl, CPLCharUniquePtr)
 {
@@ -3400,6 +3541,94 @@ TEST_F(test_cpl, CPLWorkerThreadPool)
     }
 }
 
+// Test nested submission of jobs to a CPLWorkerThreadPool through job queues
+TEST_F(test_cpl, CPLWorkerThreadPool_nested_job_queues)
+{
+    struct Context
+    {
+        CPLWorkerThreadPool oPool{};
+        std::atomic<int> nCounter{0};
+    };
+
+    Context sContext;
+    ASSERT_TRUE(sContext.oPool.Setup(2, nullptr, nullptr, false));
+
+    // Each outer job waits for inner jobs submitted to the same pool, which
+    // would deadlock if the waiting threads did not run them.
+    const auto outerJob = [](void *pData)
+    {
+        auto psContext = static_cast<Context *>(pData);
+        auto poQueue = psContext->oPool.CreateJobQueue();
+        for (int i = 0; i < 100; i++)
+        {
+            poQueue->SubmitJob(
+                [](void *pDataInner)
+                { static_cast<Context *>(pDataInner)->nCounter++; },
+                psContext);
+        }
+        poQueue->WaitCompletion();
+    };
+
+    auto poQueue = sContext.oPool.CreateJobQueue();
+    for (int i = 0; i < 8; i++)
+        poQueue->SubmitJob(outerJob, &sContext);
+    poQueue->WaitCompletion();
+    ASSERT_EQ(sContext.nCounter.load(), 800);
+}
+
+// Test CPLSetMaxConcurrentJobs()
+TEST_F(test_cpl, CPLSetMaxConcurrentJobs)
+{
+    struct Context
+    {
+        CPLWorkerThreadPool oPool{};
+        std::atomic<int> nActive{0};
+        std::atomic<int> nMaxActive{0};
+        std::atomic<int> nCounter{0};
+
+        static void InnerJob(void *pData)
+        {
+            auto psContext = static_cast<Context *>(pData);
+            const int nActiveJobs = ++psContext->nActive;
+            int nMaxActiveJobs = psContext->nMaxActive;
+            while (nActiveJobs > nMaxActiveJobs &&
+                   !psContext->nMaxActive.compare_exchange_weak(nMaxActiveJobs,
+                                                                nActiveJobs))
+            {
+            }
+            CPLSleep(0.001);
+            psContext->nCounter++;
+            psContext->nActive--;
+        }
+
+        // Waits for inner jobs: the token of the waiting job must be
+        // released to avoid a deadlock.
+        static void OuterJob(void *pData)
+        {
+            auto psContext = static_cast<Context *>(pData);
+            auto poQueue = psContext->oPool.CreateJobQueue();
+            for (int i = 0; i < 10; i++)
+                poQueue->SubmitJob(InnerJob, psContext);
+            poQueue->WaitCompletion();
+        }
+    };
+
+    const int nMaxConcurrentJobsBackup = CPLGetMaxConcurrentJobs();
+    CPLSetMaxConcurrentJobs(2);
+    {
+        Context sContext;
+        ASSERT_TRUE(sContext.oPool.Setup(4, nullptr, nullptr, false));
+
+        auto poQueue = sContext.oPool.CreateJobQueue();
+        for (int i = 0; i < 8; i++)
+            poQueue->SubmitJob(Context::OuterJob, &sContext);
+        poQueue->WaitCompletion();
+        EXPECT_EQ(sContext.nCounter.load(), 80);
+        EXPECT_LE(sContext.nMaxActive.load(), 2);
+    }
+    CPLSetMaxConcurrentJobs(nMaxConcurrentJobsBackup);
+}
+
 // Test CPLHTTPFetch
 TEST_F(test_cpl, CPLHTTPFetch)
 {
@@ -4538,6 +4767,113 @@ TEST_F(test_cpl, vsimem_pread)
     VSIFCloseL(fp);
 }
 
+// Test concurrent creation, stat and reading of /vsimem/ files
+TEST_F(test_cpl, vsimem_concurrent_access)
+{
+    CPLWorkerThreadPool oPool;
+    ASSERT_TRUE(oPool.Setup(8, nullptr, nullptr));
+
+    struct Job
+    {
+        int nIdx = 0;
+        bool bOK = false;
+
+        static void Func(void *pData)
+        {
+            auto psJob = static_cast<Job *>(pData);
+            const int i = psJob->nIdx;
+            const std::string osFilename = CPLSPrintf(
+                "/vsimem/vsimem_concurrent_access/%d/%d.bin", i % 10, i);
+            VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "wb");
+            if (!fp)
+                return;
+            VSIFWriteL(&i, sizeof(i), 1, fp);
+            VSIFCloseL(fp);
+
+            VSIStatBufL sStat;
+            if (VSIStatL(osFilename.c_str(), &sStat) != 0 ||
+                sStat.st_size != static_cast<int>(sizeof(i)))
+                return;
+
+            fp = VSIFOpenL(osFilename.c_str(), "rb");
+            if (!fp)
+                return;
+            int nVal = -1;
+            psJob->bOK = VSIFReadL(&nVal, sizeof(nVal), 1, fp) == 1 &&
+                         nVal == i;
+            VSIFCloseL(fp);
+        }
+    };
+
+    constexpr int N_FILES = 200;
+    std::vector<Job> asJobs(N_FILES);
+    for (int i = 0; i < N_FILES; ++i)
+    {
+        asJobs[i].nIdx = i;
+        oPool.SubmitJob(Job::Func, &asJobs[i]);
+    }
+    oPool.WaitCompletion();
+    for (const auto &sJob : asJobs)
+        EXPECT_TRUE(sJob.bOK) << sJob.nIdx;
+
+    int nCount = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        const CPLStringList aosFiles(VSIReadDir(
+            CPLSPrintf("/vsimem/vsimem_concurrent_access/%d", i)));
+        nCount += aosFiles.size();
+    }
+    EXPECT_EQ(nCount, N_FILES);
+
+    VSIRmdirRecursive("/vsimem/vsimem_concurrent_access");
+}
+
+// Test the CPL_VSIL_LOCAL_CACHE_TTL stat/readdir cache of local files
+TEST_F(test_cpl, local_file_system_stat_cache)
+{
+#ifdef WIN32
+    GTEST_SKIP() << "Only implemented for POSIX file systems";
+#else
+    const std::string osDir =
+        CPLGenerateTempFilename("test_cpl_local_stat_cache");
+    ASSERT_EQ(VSIMkdir(osDir.c_str(), 0755), 0);
+    const std::string osFilename =
+        CPLFormFilename(osDir.c_str(), "foo.bin", nullptr);
+    VSIStatBufL sStat;
+
+    CPLSetConfigOption("CPL_VSIL_LOCAL_CACHE_TTL", "3600");
+
+    // Negative results are cached too
+    EXPECT_NE(VSIStatL(osFilename.c_str(), &sStat), 0);
+    EXPECT_EQ(CPLStringList(VSIReadDir(osDir.c_str())).FindString("foo.bin"),
+              -1);
+
+    // Files created behind our back are not seen until the TTL elapses
+    FILE *f = fopen(osFilename.c_str(), "wb");
+    ASSERT_TRUE(f != nullptr);
+    fclose(f);
+    EXPECT_NE(VSIStatL(osFilename.c_str(), &sStat), 0);
+    EXPECT_EQ(CPLStringList(VSIReadDir(osDir.c_str())).FindString("foo.bin"),
+              -1);
+
+    // But writing through VSI invalidates the cache
+    VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "wb");
+    ASSERT_TRUE(fp != nullptr);
+    VSIFWriteL("abc", 1, 3, fp);
+    VSIFCloseL(fp);
+    EXPECT_EQ(VSIStatL(osFilename.c_str(), &sStat), 0);
+    EXPECT_EQ(sStat.st_size, 3);
+    EXPECT_GE(CPLStringList(VSIReadDir(osDir.c_str())).FindString("foo.bin"),
+              0);
+
+    EXPECT_EQ(VSIUnlink(osFilename.c_str()), 0);
+    EXPECT_NE(VSIStatL(osFilename.c_str(), &sStat), 0);
+
+    CPLSetConfigOption("CPL_VSIL_LOCAL_CACHE_TTL", nullptr);
+    VSIRmdir(osDir.c_str());
+#endif
+}
+
 // Test regular file system PRead() implementation
 TEST_F(test_cpl, file_system_pread)
 {
@@ -4569,6 +4905,135 @@ TEST_F(test_cpl, file_system_pread)
     VSIUnlink("temp_test_64.bin");
 }
 
+// Test regular file system ReadMultiRange() implementation
+TEST_F(test_cpl, file_system_read_multi_range)
+{
+    VSILFILE *fp = VSIFOpenL("temp_test_multi_range.bin", "wb+");
+    if (fp == nullptr)
+        return;
+    VSIVirtualHandle *poHandle = reinterpret_cast<VSIVirtualHandle *>(fp);
+    ASSERT_EQ(poHandle->Write("abcdefgh", 8, 1), 1U);
+    ASSERT_EQ(poHandle->Seek(1, SEEK_SET), 0);
+    {
+        char szBuffer1[3] = {0};
+        char szBuffer2[4] = {0};
+        void *apData[] = {szBuffer1, szBuffer2};
+        const vsi_l_offset anOffsets[] = {6, 0};
+        const size_t anSizes[] = {2, 3};
+        poHandle->AdviseRead(2, anOffsets, anSizes);
+        ASSERT_EQ(poHandle->ReadMultiRange(2, apData, anOffsets, anSizes), 0);
+        ASSERT_EQ(std::string(szBuffer1), std::string("gh"));
+        ASSERT_EQ(std::string(szBuffer2), std::string("abc"));
+    }
+    {
+        // Range beyond end of file
+        char szBuffer[4] = {0};
+        void *apData[] = {szBuffer};
+        const vsi_l_offset anOffsets[] = {6};
+        const size_t anSizes[] = {3};
+        ASSERT_EQ(poHandle->ReadMultiRange(1, apData, anOffsets, anSizes), -1);
+    }
+    ASSERT_EQ(poHandle->Tell(), 1U);
+    VSIFCloseL(fp);
+    VSIUnlink("temp_test_multi_range.bin");
+}
+
+// Test VSIVirtualHandle::ReadAsync()
+TEST_F(test_cpl, ReadAsync)
+{
+    char szContent[] = "abcd";
+    VSILFILE *fp = VSIFileFromMemBuffer(
+        "", reinterpret_cast<GByte *>(szContent), 4, FALSE);
+    VSIVirtualHandle *poHandle = reinterpret_cast<VSIVirtualHandle *>(fp);
+    {
+        char szBuffer1[5] = {0};
+        char szBuffer2[5] = {0};
+        auto oFuture1 = poHandle->ReadAsync(szBuffer1, 2, 1);
+        auto oFuture2 = poHandle->ReadAsync(szBuffer2, 4, 2);
+        ASSERT_EQ(oFuture1.get(), 2U);
+        ASSERT_EQ(oFuture2.get(), 2U);
+        ASSERT_EQ(std::string(szBuffer1), std::string("bc"));
+        ASSERT_EQ(std::string(szBuffer2), std::string("cd"));
+    }
+    {
+        char szBuffer[5] = {0};
+        ASSERT_EQ(poHandle->ReadAsync(szBuffer, 1, 4).get(), 0U);
+        ASSERT_EQ(std::string(szBuffer), std::string());
+    }
+    // File offset is not affected
+    ASSERT_EQ(VSIFTellL(fp), 0U);
+    VSIFCloseL(fp);
+}
+
+// Test VSIVirtualHandle::MapRegion()
+TEST_F(test_cpl, MapRegion)
+{
+    {
+        VSILFILE *fp = VSIFOpenL("/vsimem/map_region.bin", "wb");
+        ASSERT_TRUE(fp != nullptr);
+        VSIFWriteL("abcdefgh", 1, 8, fp);
+        VSIVirtualHandle *poHandle = reinterpret_cast<VSIVirtualHandle *>(fp);
+        // Not available on files opened in update mode
+        EXPECT_EQ(poHandle->MapRegion(0, 8), nullptr);
+        VSIFCloseL(fp);
+    }
+    {
+        VSILFILE *fp = VSIFOpenL("/vsimem/map_region.bin", "rb");
+        ASSERT_TRUE(fp != nullptr);
+        VSIVirtualHandle *poHandle = reinterpret_cast<VSIVirtualHandle *>(fp);
+        auto pabyMapped = poHandle->MapRegion(2, 3);
+        ASSERT_TRUE(pabyMapped != nullptr);
+        EXPECT_EQ(std::string(reinterpret_cast<const char *>(pabyMapped.get()),
+                              3),
+                  "cde");
+        EXPECT_EQ(poHandle->MapRegion(6, 3), nullptr);
+        VSIFCloseL(fp);
+        // Mapping is still valid after the file has been closed
+        EXPECT_EQ(pabyMapped.get()[0], 'c');
+    }
+    {
+        VSILFILE *fp = VSIFOpenL(
+            "/vsisubfile/1_4,/vsimem/map_region.bin", "rb");
+        ASSERT_TRUE(fp != nullptr);
+        VSIVirtualHandle *poHandle = reinterpret_cast<VSIVirtualHandle *>(fp);
+        auto pabyMapped = poHandle->MapRegion(1, 3);
+        ASSERT_TRUE(pabyMapped != nullptr);
+        EXPECT_EQ(std::string(reinterpret_cast<const char *>(pabyMapped.get()),
+                              3),
+                  "cde");
+        EXPECT_EQ(poHandle->MapRegion(2, 3), nullptr);
+        VSIFCloseL(fp);
+    }
+    VSIUnlink("/vsimem/map_region.bin");
+
+#ifndef _WIN32
+    {
+        const std::string osTmpFile =
+            CPLGenerateTempFilename("test_cpl_map_region");
+        VSILFILE *fp = VSIFOpenL(osTmpFile.c_str(), "wb");
+        ASSERT_TRUE(fp != nullptr);
+        VSIFWriteL("abcdefgh", 1, 8, fp);
+        VSIFCloseL(fp);
+        fp = VSIFOpenL(osTmpFile.c_str(), "rb");
+        ASSERT_TRUE(fp != nullptr);
+        VSIVirtualHandle *poHandle = reinterpret_cast<VSIVirtualHandle *>(fp);
+        auto pabyMapped = poHandle->MapRegion(5, 3);
+        // mmap() may not be available
+        if (pabyMapped)
+        {
+            EXPECT_EQ(
+                std::string(reinterpret_cast<const char *>(pabyMapped.get()),
+                            3),
+                "fgh");
+        }
+        EXPECT_EQ(poHandle->MapRegion(5, 4), nullptr);
+        VSIFCloseL(fp);
+        pabyMapped.reset();
+        VSIUnlink(osTmpFile.c_str());
+    }
+#endif
+}
+
 // Test CPLMask implementation
 TEST_F(test_cpl, CPLMask)
 {
@@ -4886,4 +5351,94 @@ TEST_F(test_cpl, VSIGetCanonicalFilename)
     VSIUnlink(osLC.c_str());
 }
 
+// Test CPLTraceSpan
+TEST_F(test_cpl, CPLTraceSpan)
+{
+    struct Span
+    {
+        std::string osName{};
+        GIntBig nThreadId = 0;
+        std::string osParent{};
+        CPLStringList aosAttributes{};
+        bool bEnded = false;
+    };
+
+    struct Tracer
+    {
+        std::vector<std::unique_ptr<Span>> apoSpans{};
+        std::vector<Span *> apoStack{};
+
+        static void *Begin(void *pUserData, const char *pszName,
+                           GIntBig nThreadId)
+        {
+            auto poTracer = static_cast<Tracer *>(pUserData);
+            auto poSpan = std::make_unique<Span>();
+            poSpan->osName = pszName;
+            poSpan->nThreadId = nThreadId;
+            if (!poTracer->apoStack.empty())
+                poSpan->osParent = poTracer->apoStack.back()->osName;
+            poTracer->apoStack.push_back(poSpan.get());
+            poTracer->apoSpans.push_back(std::move(poSpan));
+            return poTracer->apoStack.back();
+        }
+
+        static void End(void *pUserData, void *pSpan,
+                        CSLConstList papszAttributes)
+        {
+            auto poTracer = static_cast<Tracer *>(pUserData);
+            auto poSpan = static_cast<Span *>(pSpan);
+            EXPECT_EQ(poTracer->apoStack.back(), poSpan);
+            poTracer->apoStack.pop_back();
+            poSpan->aosAttributes = CPLStringList(papszAttributes);
+            poSpan->bEnded = true;
+        }
+    };
+
+    EXPECT_FALSE(CPLIsTraceSpanEnabled());
+    {
+        CPLTraceSpan oSpan("not_traced");
+        EXPECT_FALSE(oSpan.IsEnabled());
+        oSpan.SetAttribute("foo", "bar");
+    }
+
+    Tracer oTracer;
+    CPLSetTraceSpanHooks(Tracer::Begin, Tracer::End, &oTracer);
+    EXPECT_TRUE(CPLIsTraceSpanEnabled());
+    {
+        CPLTraceSpan oOuter("outer");
+        EXPECT_TRUE(oOuter.IsEnabled());
+        oOuter.SetAttribute("filename", "foo.tif");
+        {
+            CPLTraceSpan oInner("inner");
+            oInner.SetAttribute("bytes", static_cast<GIntBig>(1234));
+            oInner.SetAttribute("bytes", static_cast<GIntBig>(5678));
+            oInner.SetAttribute("null", static_cast<const char *>(nullptr));
+        }
+    }
+    CPLSetTraceSpanHooks(nullptr, nullptr, nullptr);
+    EXPECT_FALSE(CPLIsTraceSpanEnabled());
+    {
+        CPLTraceSpan oSpan("not_traced");
+        EXPECT_FALSE(oSpan.IsEnabled());
+    }
+
+    ASSERT_EQ(oTracer.apoSpans.size(), 2U);
+    EXPECT_TRUE(oTracer.apoStack.empty());
+
+    const auto &oOuter = *(oTracer.apoSpans[0]);
+    EXPECT_STREQ(oOuter.osName.c_str(), "outer");
+    EXPECT_TRUE(oOuter.osParent.empty());
+    EXPECT_EQ(oOuter.nThreadId, CPLGetPID());
+    EXPECT_TRUE(oOuter.bEnded);
+    EXPECT_EQ(oOuter.aosAttributes.size(), 1);
+    EXPECT_STREQ(oOuter.aosAttributes.FetchNameValue("filename"), "foo.tif");
+
+    const auto &oInner = *(oTracer.apoSpans[1]);
+    EXPECT_STREQ(oInner.osName.c_str(), "inner");
+    EXPECT_STREQ(oInner.osParent.c_str(), "outer");
+    EXPECT_TRUE(oInner.bEnded);
+    EXPECT_EQ(oInner.aosAttributes.size(), 1);
+    EXPECT_STREQ(oInner.aosAttributes.FetchNameValue("bytes"), "5678");
+}
+
 }  // namespace
@@ -30,6 +30,7 @@
 
 #include "gdal_alg.h"
 #include "gdal_priv.h"
+#include "gdal_rat.h"
 #include "gdal_utils.h"
 #include "gdal_priv_templates.hpp"
 #include "gdal.h"
@@ -37,6 +38,8 @@
 #include "gdalcachedpixelaccessor.h"
 
 #include <limits>
+#include <map>
+#include <mutex>
 #include <string>
 
 #include "test_data.h"
@@ -2882,6 +2885,54 @@ TEST_F(test_gdal, GDALDeinterleave4ComponentsUInt16)
     VSIFree(panDest3);
 }
 
+// Test GDALDeinterleave() and GDALInterleave() with many components
+TEST_F(test_gdal, GDALDeinterleaveManyComponents)
+{
+    for (const GDALDataType eDT :
+         {GDT_Byte, GDT_Int16, GDT_UInt16, GDT_Float32, GDT_Float64})
+    {
+        const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+        for (const int nComponents : {5, 8, 17, 200})
+        {
+            for (const size_t nIters : {1, 7, 33, 257})
+            {
+                std::vector<GByte> abySrc(nIters * nComponents * nDTSize);
+                for (size_t i = 0; i < abySrc.size(); ++i)
+                    abySrc[i] = static_cast<GByte>(i * 7 + i / 251);
+                std::vector<std::vector<GByte>> aabyDest(
+                    nComponents, std::vector<GByte>(nIters * nDTSize));
+                std::vector<void *> apDest;
+                for (auto &abyDest : aabyDest)
+                    apDest.push_back(abyDest.data());
+
+                GDALDeinterleave(abySrc.data(), eDT, nComponents,
+                                 apDest.data(), eDT, nIters);
+                for (int iComp = 0; iComp < nComponents; ++iComp)
+                {
+                    for (size_t i = 0; i < nIters; ++i)
+                    {
+                        ASSERT_EQ(memcmp(aabyDest[iComp].data() + i * nDTSize,
+                                         abySrc.data() +
+                                             (i * nComponents + iComp) *
+                                                 nDTSize,
+                                         nDTSize),
+                                  0)
+                            << GDALGetDataTypeName(eDT) << " " << nComponents
+                            << " " << nIters;
+                    }
+                }
+
+                std::vector<GByte> abyInterleaved(abySrc.size());
+                GDALInterleave(apDest.data(), eDT, nComponents,
+                               abyInterleaved.data(), eDT, nIters);
+                ASSERT_EQ(abyInterleaved, abySrc)
+                    << GDALGetDataTypeName(eDT) << " " << nComponents << " "
+                    << nIters;
+            }
+        }
+    }
+}
+
 // Test GDALDataset::ReportError()
 TEST_F(test_gdal, GDALDatasetReportError)
 {
@@ -3491,4 +3542,1890 @@ TEST_F(test_gdal, open_shared_open_options)
     }
 }
 
+// Test block cache priority and budget of datasets
+TEST_F(test_gdal, block_cache_priority_and_budget)
+{
+    auto poDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (poDrv == nullptr)
+    {
+        GTEST_SKIP() << "GTIFF driver missing";
+    }
+
+    const char *const apszOptions[] = {"TILED=YES", "BLOCKXSIZE=64",
+                                       "BLOCKYSIZE=64", nullptr};
+    const auto CreateFile = [poDrv, &apszOptions](const char *pszName, int nSize)
+    {
+        std::unique_ptr<GDALDataset> poDS(poDrv->Create(
+            pszName, nSize, nSize, 1, GDT_Byte, const_cast<char **>(apszOptions)));
+        ASSERT_TRUE(poDS != nullptr);
+        poDS->GetRasterBand(1)->Fill(1);
+    };
+    CreateFile("/vsimem/block_cache_hot.tif", 256);
+    CreateFile("/vsimem/block_cache_cold.tif", 1024);
+
+    const GIntBig nOldCacheMax = GDALGetCacheMax64();
+    GDALSetCacheMax64(200 * 1000);
+
+    for (const char *pszPriority : {"NORMAL", "HIGH"})
+    {
+        CPLStringList aosOpenOptions;
+        aosOpenOptions.SetNameValue("BLOCK_CACHE_PRIORITY", pszPriority);
+        std::unique_ptr<GDALDataset> poHotDS(
+            GDALDataset::Open("/vsimem/block_cache_hot.tif", GDAL_OF_RASTER,
+                              nullptr, aosOpenOptions.List()));
+        ASSERT_TRUE(poHotDS != nullptr);
+        EXPECT_EQ(poHotDS->GetBlockCachePriority(),
+                  EQUAL(pszPriority, "HIGH") ? GBCP_High : GBCP_Normal);
+
+        std::vector<GByte> abyBuffer(1024 * 1024);
+        ASSERT_EQ(poHotDS->GetRasterBand(1)->RasterIO(
+                      GF_Read, 0, 0, 256, 256, abyBuffer.data(), 256, 256,
+                      GDT_Byte, 0, 0, nullptr),
+                  CE_None);
+        const GIntBig nHotUsed = poHotDS->GetBlockCacheUsed();
+        EXPECT_GE(nHotUsed, 16 * 64 * 64);
+
+        std::unique_ptr<GDALDataset> poColdDS(GDALDataset::Open(
+            "/vsimem/block_cache_cold.tif", GDAL_OF_RASTER));
+        ASSERT_TRUE(poColdDS != nullptr);
+        ASSERT_EQ(poColdDS->GetRasterBand(1)->RasterIO(
+                      GF_Read, 0, 0, 1024, 1024, abyBuffer.data(), 1024, 1024,
+                      GDT_Byte, 0, 0, nullptr),
+                  CE_None);
+        EXPECT_LE(GDALGetCacheUsed64(), 200 * 1000);
+
+        if (EQUAL(pszPriority, "HIGH"))
+            EXPECT_EQ(poHotDS->GetBlockCacheUsed(), nHotUsed);
+        else
+            EXPECT_LT(poHotDS->GetBlockCacheUsed(), nHotUsed);
+    }
+
+    // Budget: half of the blocks of the hot dataset are protected
+    {
+        std::unique_ptr<GDALDataset> poHotDS(GDALDataset::Open(
+            "/vsimem/block_cache_hot.tif", GDAL_OF_RASTER));
+        ASSERT_TRUE(poHotDS != nullptr);
+        poHotDS->SetBlockCacheBudget(8 * 64 * 64);
+        EXPECT_EQ(poHotDS->GetBlockCacheBudget(), 8 * 64 * 64);
+
+        std::vector<GByte> abyBuffer(1024 * 1024);
+        ASSERT_EQ(poHotDS->GetRasterBand(1)->RasterIO(
+                      GF_Read, 0, 0, 256, 256, abyBuffer.data(), 256, 256,
+                      GDT_Byte, 0, 0, nullptr),
+                  CE_None);
+
+        std::unique_ptr<GDALDataset> poColdDS(GDALDataset::Open(
+            "/vsimem/block_cache_cold.tif", GDAL_OF_RASTER));
+        ASSERT_TRUE(poColdDS != nullptr);
+        ASSERT_EQ(poColdDS->GetRasterBand(1)->RasterIO(
+                      GF_Read, 0, 0, 1024, 1024, abyBuffer.data(), 1024, 1024,
+                      GDT_Byte, 0, 0, nullptr),
+                  CE_None);
+        EXPECT_GT(poHotDS->GetBlockCacheUsed(), 0);
+        EXPECT_LE(poHotDS->GetBlockCacheUsed(), 8 * 64 * 64 + 8192);
+    }
+
+    GDALSetCacheMax64(nOldCacheMax);
+    VSIUnlink("/vsimem/block_cache_hot.tif");
+    VSIUnlink("/vsimem/block_cache_cold.tif");
+}
+
+// Test GDALRasterIOExtraArg::bStreaming
+TEST_F(test_gdal, block_cache_streaming_read)
+{
+    auto poDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (poDrv == nullptr)
+    {
+        GTEST_SKIP() << "GTIFF driver missing";
+    }
+
+    const char *const apszOptions[] = {"TILED=YES", "BLOCKXSIZE=64",
+                                       "BLOCKYSIZE=64", nullptr};
+    const auto CreateFile = [poDrv, &apszOptions](const char *pszName, int nSize)
+    {
+        std::unique_ptr<GDALDataset> poDS(poDrv->Create(
+            pszName, nSize, nSize, 1, GDT_Byte, const_cast<char **>(apszOptions)));
+        ASSERT_TRUE(poDS != nullptr);
+        poDS->GetRasterBand(1)->Fill(1);
+    };
+    CreateFile("/vsimem/block_cache_streaming_hot.tif", 256);
+    CreateFile("/vsimem/block_cache_streaming_cold.tif", 1024);
+
+    const GIntBig nOldCacheMax = GDALGetCacheMax64();
+    GDALSetCacheMax64(200 * 1000);
+
+    {
+        std::unique_ptr<GDALDataset> poHotDS(GDALDataset::Open(
+            "/vsimem/block_cache_streaming_hot.tif", GDAL_OF_RASTER));
+        ASSERT_TRUE(poHotDS != nullptr);
+        // Only to enable the accounting of the cached blocks of the dataset
+        poHotDS->SetBlockCachePriority(GBCP_Normal);
+
+        std::vector<GByte> abyBuffer(1024 * 1024);
+        ASSERT_EQ(poHotDS->GetRasterBand(1)->RasterIO(
+                      GF_Read, 0, 0, 256, 256, abyBuffer.data(), 256, 256,
+                      GDT_Byte, 0, 0, nullptr),
+                  CE_None);
+        const GIntBig nHotUsed = poHotDS->GetBlockCacheUsed();
+        EXPECT_GE(nHotUsed, 16 * 64 * 64);
+
+        std::unique_ptr<GDALDataset> poColdDS(GDALDataset::Open(
+            "/vsimem/block_cache_streaming_cold.tif", GDAL_OF_RASTER));
+        ASSERT_TRUE(poColdDS != nullptr);
+        GDALRasterIOExtraArg sExtraArg;
+        INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+        sExtraArg.bStreaming = TRUE;
+        ASSERT_EQ(poColdDS->GetRasterBand(1)->RasterIO(
+                      GF_Read, 0, 0, 1024, 1024, abyBuffer.data(), 1024, 1024,
+                      GDT_Byte, 0, 0, &sExtraArg),
+                  CE_None);
+        EXPECT_EQ(abyBuffer[1024 * 1024 - 1], 1);
+        EXPECT_LE(GDALGetCacheUsed64(), 200 * 1000);
+        EXPECT_EQ(poHotDS->GetBlockCacheUsed(), nHotUsed);
+
+        // Version 1 of the structure is still accepted
+        sExtraArg.nVersion = 1;
+        EXPECT_EQ(poColdDS->GetRasterBand(1)->RasterIO(
+                      GF_Read, 0, 0, 64, 64, abyBuffer.data(), 64, 64,
+                      GDT_Byte, 0, 0, &sExtraArg),
+                  CE_None);
+    }
+
+    GDALSetCacheMax64(nOldCacheMax);
+    VSIUnlink("/vsimem/block_cache_streaming_hot.tif");
+    VSIUnlink("/vsimem/block_cache_streaming_cold.tif");
+}
+
+// Test the compressed tier of the block cache
+TEST_F(test_gdal, block_cache_compressed_tier)
+{
+    auto poDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (poDrv == nullptr)
+    {
+        GTEST_SKIP() << "GTIFF driver missing";
+    }
+
+    constexpr int SIZE = 512;
+    std::vector<float> afRef(SIZE * SIZE);
+    for (int i = 0; i < SIZE * SIZE; ++i)
+        afRef[i] = static_cast<float>(i % 251);
+    {
+        const char *const apszOptions[] = {"TILED=YES", "BLOCKXSIZE=64",
+                                           "BLOCKYSIZE=64", nullptr};
+        std::unique_ptr<GDALDataset> poDS(
+            poDrv->Create("/vsimem/block_cache_compressed.tif", SIZE, SIZE, 1,
+                          GDT_Float32, const_cast<char **>(apszOptions)));
+        ASSERT_TRUE(poDS != nullptr);
+        ASSERT_EQ(poDS->GetRasterBand(1)->RasterIO(
+                      GF_Write, 0, 0, SIZE, SIZE, afRef.data(), SIZE, SIZE,
+                      GDT_Float32, 0, 0, nullptr),
+                  CE_None);
+    }
+
+    const GIntBig nOldCacheMax = GDALGetCacheMax64();
+    GDALSetCacheMax64(200 * 1000);
+    CPLSetConfigOption("GDAL_BLOCK_CACHE_COMPRESSED_SIZE", "10MB");
+
+    for (const char *pszCompression : {"", "zlib"})
+    {
+        if (pszCompression[0])
+            CPLSetConfigOption("GDAL_BLOCK_CACHE_COMPRESSION", pszCompression);
+        std::unique_ptr<GDALDataset> poDS(GDALDataset::Open(
+            "/vsimem/block_cache_compressed.tif", GDAL_OF_RASTER));
+        ASSERT_TRUE(poDS != nullptr);
+        for (int iIter = 0; iIter < 3; ++iIter)
+        {
+            std::vector<float> afData(SIZE * SIZE);
+            ASSERT_EQ(poDS->GetRasterBand(1)->RasterIO(
+                          GF_Read, 0, 0, SIZE, SIZE, afData.data(), SIZE, SIZE,
+                          GDT_Float32, 0, 0, nullptr),
+                      CE_None);
+            EXPECT_EQ(afData, afRef);
+        }
+        CPLSetConfigOption("GDAL_BLOCK_CACHE_COMPRESSION", nullptr);
+    }
+
+    CPLSetConfigOption("GDAL_BLOCK_CACHE_COMPRESSED_SIZE", nullptr);
+    GDALSetCacheMax64(nOldCacheMax);
+    VSIUnlink("/vsimem/block_cache_compressed.tif");
+}
+
+// Test the on-disk tier of the block cache
+TEST_F(test_gdal, block_cache_disk_tier)
+{
+    auto poDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (poDrv == nullptr)
+    {
+        GTEST_SKIP() << "GTIFF driver missing";
+    }
+
+    constexpr int SIZE = 256;
+    std::vector<GByte> abyRef(SIZE * SIZE);
+    for (int i = 0; i < SIZE * SIZE; ++i)
+        abyRef[i] = static_cast<GByte>(i % 251);
+    {
+        const char *const apszOptions[] = {"TILED=YES", "BLOCKXSIZE=64",
+                                           "BLOCKYSIZE=64", nullptr};
+        std::unique_ptr<GDALDataset> poDS(
+            poDrv->Create("/vsimem/block_cache_disk.tif", SIZE, SIZE, 1,
+                          GDT_Byte, const_cast<char **>(apszOptions)));
+        ASSERT_TRUE(poDS != nullptr);
+        ASSERT_EQ(poDS->GetRasterBand(1)->RasterIO(
+                      GF_Write, 0, 0, SIZE, SIZE, abyRef.data(), SIZE, SIZE,
+                      GDT_Byte, 0, 0, nullptr),
+                  CE_None);
+    }
+
+    CPLSetConfigOption("GDAL_BLOCK_CACHE_DISK_DIR", "/vsimem/block_cache_dir");
+    for (int iIter = 0; iIter < 2; ++iIter)
+    {
+        std::unique_ptr<GDALDataset> poDS(
+            GDALDataset::Open("/vsimem/block_cache_disk.tif", GDAL_OF_RASTER));
+        ASSERT_TRUE(poDS != nullptr);
+        std::vector<GByte> abyData(SIZE * SIZE);
+        ASSERT_EQ(poDS->GetRasterBand(1)->RasterIO(
+                      GF_Read, 0, 0, SIZE, SIZE, abyData.data(), SIZE, SIZE,
+                      GDT_Byte, 0, 0, nullptr),
+                  CE_None);
+        EXPECT_EQ(abyData, abyRef);
+
+        int nBlockFiles = 0;
+        const CPLStringList aosFiles(
+            VSIReadDirRecursive("/vsimem/block_cache_dir"));
+        for (const char *pszFile : aosFiles)
+        {
+            if (EQUAL(CPLGetExtension(pszFile), "blk"))
+                ++nBlockFiles;
+        }
+        EXPECT_EQ(nBlockFiles, 16);
+    }
+    CPLSetConfigOption("GDAL_BLOCK_CACHE_DISK_DIR", nullptr);
+
+    VSIRmdirRecursive("/vsimem/block_cache_dir");
+    VSIUnlink("/vsimem/block_cache_disk.tif");
+}
+
+// Test GDALGetBlockCacheStatistics() and GDALRasterBand::GetBlockCacheStatistics()
+TEST_F(test_gdal, block_cache_statistics)
+{
+    const GIntBig nOldCacheMax = GDALGetCacheMax64();
+    GDALSetCacheMax64(200 * 1000);
+
+    {
+        std::unique_ptr<GDALDataset> poDS(
+            GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+                ->Create("", 1024, 1024, 1, GDT_Byte, nullptr));
+        ASSERT_TRUE(poDS != nullptr);
+        GDALRasterBand *poBand = poDS->GetRasterBand(1);
+
+        GDALBlockCacheStatistics sGlobalStatsBefore;
+        GDALGetBlockCacheStatistics(&sGlobalStatsBefore);
+
+        // Go through the block cache, whose size can hold 195 blocks
+        for (int iY = 0; iY < 1024; ++iY)
+        {
+            GDALRasterBlock *poBlock = poBand->GetLockedBlockRef(0, iY, TRUE);
+            ASSERT_TRUE(poBlock != nullptr);
+            poBlock->DropLock();
+        }
+
+        GDALBlockCacheStatistics sStats;
+        poBand->GetBlockCacheStatistics(&sStats);
+        EXPECT_GT(sStats.nEvictions, 0);
+        EXPECT_EQ(sStats.nDirtyBlockFlushes, 0);
+        EXPECT_GT(sStats.nCacheUsed, 0);
+        EXPECT_LE(sStats.nCacheUsed, 200 * 1000);
+        EXPECT_EQ(sStats.dfLockWaitTime, 0.0);
+
+        GDALBlockCacheStatistics sDSStats;
+        poDS->GetBlockCacheStatistics(&sDSStats);
+        EXPECT_EQ(sDSStats.nEvictions, sStats.nEvictions);
+        EXPECT_EQ(sDSStats.nCacheUsed, sStats.nCacheUsed);
+
+        GDALBlockCacheStatistics sGlobalStats;
+        GDALGetBlockCacheStatistics(&sGlobalStats);
+        EXPECT_GE(sGlobalStats.nEvictions - sGlobalStatsBefore.nEvictions,
+                  sStats.nEvictions);
+        EXPECT_EQ(sGlobalStats.nCacheUsed, GDALGetCacheUsed64());
+
+        poBand->FlushCache(false);
+        poBand->GetBlockCacheStatistics(&sStats);
+        EXPECT_EQ(sStats.nCacheUsed, 0);
+    }
+
+    GDALResetBlockCacheStatistics();
+    GDALBlockCacheStatistics sGlobalStats;
+    GDALGetBlockCacheStatistics(&sGlobalStats);
+    EXPECT_EQ(sGlobalStats.nEvictions, 0);
+    EXPECT_EQ(sGlobalStats.nDirtyBlockFlushes, 0);
+
+    GDALSetCacheMax64(nOldCacheMax);
+}
+
+// Test GDALDataset::GetCodecStatistics() and GDALGetThreadCodecStatistics()
+TEST_F(test_gdal, codec_statistics)
+{
+    auto poDrv = GDALDriver::FromHandle(GDALGetDriverByName("GTiff"));
+    if (poDrv == nullptr)
+        GTEST_SKIP() << "GTiff driver missing";
+
+    const char *pszFilename = "/vsimem/codec_statistics.tif";
+    constexpr int nSize = 256;
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("TILED", "YES");
+        aosOptions.SetNameValue("BLOCKXSIZE", "128");
+        aosOptions.SetNameValue("BLOCKYSIZE", "128");
+        aosOptions.SetNameValue("COMPRESS", "DEFLATE");
+        GDALDatasetUniquePtr poDS(poDrv->Create(pszFilename, nSize, nSize, 1,
+                                                GDT_Byte, aosOptions.List()));
+        ASSERT_TRUE(poDS != nullptr);
+        std::vector<GByte> abyData(nSize * nSize);
+        for (size_t i = 0; i < abyData.size(); ++i)
+            abyData[i] = static_cast<GByte>(i % 7);
+        GDALResetThreadCodecStatistics();
+        EXPECT_EQ(poDS->GetRasterBand(1)->RasterIO(
+                      GF_Write, 0, 0, nSize, nSize, abyData.data(), nSize,
+                      nSize, GDT_Byte, 0, 0, nullptr),
+                  CE_None);
+        EXPECT_EQ(poDS->FlushCache(false), CE_None);
+
+        GDALCodecStatistics sStats;
+        poDS->GetCodecStatistics(&sStats);
+        EXPECT_EQ(sStats.nBlocksEncoded, 4);
+        EXPECT_EQ(sStats.nBytesToEncode, nSize * nSize);
+        EXPECT_GT(sStats.nBytesEncoded, 0);
+        EXPECT_LT(sStats.nBytesEncoded, nSize * nSize);
+        EXPECT_GE(sStats.dfEncodeTime, 0.0);
+        EXPECT_EQ(sStats.nBlocksDecoded, 0);
+
+        GDALCodecStatistics sThreadStats;
+        GDALGetThreadCodecStatistics(&sThreadStats);
+        EXPECT_EQ(sThreadStats.nBlocksEncoded, 4);
+        EXPECT_EQ(sThreadStats.nBytesEncoded, sStats.nBytesEncoded);
+    }
+
+    {
+        GDALDatasetUniquePtr poDS(GDALDataset::Open(pszFilename));
+        ASSERT_TRUE(poDS != nullptr);
+        GDALResetThreadCodecStatistics();
+        std::vector<GByte> abyData(nSize * nSize);
+        EXPECT_EQ(poDS->GetRasterBand(1)->RasterIO(
+                      GF_Read, 0, 0, nSize, nSize, abyData.data(), nSize,
+                      nSize, GDT_Byte, 0, 0, nullptr),
+                  CE_None);
+
+        GDALCodecStatistics sStats;
+        GDALDatasetGetCodecStatistics(GDALDataset::ToHandle(poDS.get()),
+                                      &sStats);
+        EXPECT_EQ(sStats.nBlocksDecoded, 4);
+        EXPECT_GT(sStats.nBytesFetched, 0);
+        EXPECT_LT(sStats.nBytesFetched, nSize * nSize);
+        EXPECT_EQ(sStats.nBytesDecoded, nSize * nSize);
+        EXPECT_GE(sStats.dfDecodeTime, 0.0);
+        EXPECT_EQ(sStats.nBlocksEncoded, 0);
+
+        GDALCodecStatistics sThreadStats;
+        GDALGetThreadCodecStatistics(&sThreadStats);
+        EXPECT_EQ(sThreadStats.nBlocksDecoded, 4);
+        EXPECT_EQ(sThreadStats.nBytesFetched, sStats.nBytesFetched);
+
+        GDALDatasetResetCodecStatistics(GDALDataset::ToHandle(poDS.get()));
+        poDS->GetCodecStatistics(&sStats);
+        EXPECT_EQ(sStats.nBlocksDecoded, 0);
+        EXPECT_EQ(sStats.nBytesFetched, 0);
+        EXPECT_EQ(sStats.dfDecodeTime, 0.0);
+
+        GDALResetThreadCodecStatistics();
+        GDALGetThreadCodecStatistics(&sThreadStats);
+        EXPECT_EQ(sThreadStats.nBlocksDecoded, 0);
+    }
+
+    VSIUnlink(pszFilename);
+}
+
+// Test resampled RasterIO() into a buffer whose data type is not the band one
+TEST_F(test_gdal, RasterIOResampledOtherBufferType)
+{
+    constexpr int nSize = 100;
+    GDALDatasetUniquePtr poDS(
+        GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+            ->Create("", nSize, nSize, 1, GDT_Byte, nullptr));
+    std::vector<GByte> abySrc(nSize * nSize);
+    for (int i = 0; i < nSize * nSize; ++i)
+        abySrc[i] = static_cast<GByte>((i * 7) % 251);
+    auto poBand = poDS->GetRasterBand(1);
+    ASSERT_EQ(poBand->RasterIO(GF_Write, 0, 0, nSize, nSize, abySrc.data(),
+                               nSize, nSize, GDT_Byte, 0, 0, nullptr),
+              CE_None);
+
+    for (const auto eResampleAlg :
+         {GRIORA_Average, GRIORA_Bilinear, GRIORA_Cubic})
+    {
+        GDALRasterIOExtraArg sExtraArg;
+        INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+        sExtraArg.eResampleAlg = eResampleAlg;
+
+        constexpr int nBufSize = 33;
+        std::vector<GByte> abyRef(nBufSize * nBufSize);
+        ASSERT_EQ(poBand->RasterIO(GF_Read, 0, 0, nSize, nSize, abyRef.data(),
+                                   nBufSize, nBufSize, GDT_Byte, 0, 0,
+                                   &sExtraArg),
+                  CE_None);
+
+        // Interleaved with another component, to check the spacings
+        std::vector<float> afBuf(2 * nBufSize * nBufSize, -1.0f);
+        ASSERT_EQ(poBand->RasterIO(GF_Read, 0, 0, nSize, nSize, afBuf.data(),
+                                   nBufSize, nBufSize, GDT_Float32,
+                                   2 * sizeof(float),
+                                   2 * sizeof(float) * nBufSize, &sExtraArg),
+                  CE_None);
+        for (int i = 0; i < nBufSize * nBufSize; ++i)
+        {
+            ASSERT_EQ(afBuf[2 * i], abyRef[i]) << eResampleAlg << " " << i;
+            ASSERT_EQ(afBuf[2 * i + 1], -1.0f);
+        }
+    }
+}
+
+// Test parallel reads of GDALDataset::BlockBasedRasterIO() through clones
+TEST_F(test_gdal, BlockBasedRasterIOParallelRead)
+{
+    auto poDrv = GetGDALDriverManager()->GetDriverByName("GPKG");
+    if (poDrv == nullptr)
+    {
+        GTEST_SKIP() << "GPKG driver missing";
+    }
+    EXPECT_TRUE(poDrv->GetMetadataItem(GDAL_DCAP_PARALLEL_CLONE_READ) !=
+                nullptr);
+
+    constexpr int nSize = 1000;
+    constexpr int nBands = 3;
+    const char *pszFilename = "/vsimem/parallel_read.gpkg";
+    std::vector<GByte> abySrc(nSize * nSize * nBands);
+    for (size_t i = 0; i < abySrc.size(); ++i)
+        abySrc[i] = static_cast<GByte>((i * 13) % 255);
+    {
+        const char *const apszOptions[] = {"TILE_FORMAT=PNG", nullptr};
+        std::unique_ptr<GDALDataset> poDS(
+            poDrv->Create(pszFilename, nSize, nSize, nBands, GDT_Byte,
+                          const_cast<char **>(apszOptions)));
+        ASSERT_TRUE(poDS != nullptr);
+        ASSERT_EQ(poDS->RasterIO(GF_Write, 0, 0, nSize, nSize, abySrc.data(),
+                                 nSize, nSize, GDT_Byte, nBands, nullptr,
+                                 nBands, nBands * nSize, 1, nullptr),
+                  CE_None);
+    }
+
+    {
+        CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", "4", false);
+        std::unique_ptr<GDALDataset> poDS(
+            GDALDataset::Open(pszFilename, GDAL_OF_RASTER));
+        ASSERT_TRUE(poDS != nullptr);
+        // Done twice to check that clones are reused
+        for (int iIter = 0; iIter < 2; ++iIter)
+        {
+            std::vector<GByte> abyBuffer(abySrc.size());
+            ASSERT_EQ(poDS->RasterIO(GF_Read, 0, 0, nSize, nSize,
+                                     abyBuffer.data(), nSize, nSize, GDT_Byte,
+                                     nBands, nullptr, nBands, nBands * nSize,
+                                     1, nullptr),
+                      CE_None);
+            EXPECT_EQ(abyBuffer, abySrc);
+        }
+        // Window not aligned on block boundaries
+        std::vector<GByte> abyBuffer(nBands * 601 * 777);
+        ASSERT_EQ(poDS->RasterIO(GF_Read, 123, 45, 601, 777, abyBuffer.data(),
+                                 601, 777, GDT_Byte, nBands, nullptr, nBands,
+                                 nBands * 601, 1, nullptr),
+                  CE_None);
+        for (int iY = 0; iY < 777; ++iY)
+        {
+            ASSERT_EQ(memcmp(abyBuffer.data() + iY * nBands * 601,
+                             abySrc.data() +
+                                 ((iY + 45) * nSize + 123) * nBands,
+                             nBands * 601),
+                      0)
+                << iY;
+        }
+    }
+
+    VSIUnlink(pszFilename);
+}
+
+// Test GDALRasterBand::GetBlockView()
+TEST_F(test_gdal, GetBlockView)
+{
+    GDALDatasetUniquePtr poDS(
+        GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+            ->Create("", 100, 50, 1, GDT_UInt16, nullptr));
+    auto poBand = poDS->GetRasterBand(1);
+    ASSERT_EQ(poBand->Fill(1234), CE_None);
+
+    GDALRasterBlockView oEmptyView;
+    EXPECT_FALSE(oEmptyView);
+    EXPECT_EQ(oEmptyView.data(), nullptr);
+    EXPECT_EQ(oEmptyView.size(), 0U);
+
+    {
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        EXPECT_FALSE(poBand->GetBlockView(0, 50));
+    }
+
+    GDALRasterBlockView oView = poBand->GetBlockView(0, 10);
+    ASSERT_TRUE(oView);
+    EXPECT_EQ(oView.GetDataType(), GDT_UInt16);
+    EXPECT_EQ(oView.GetXSize(), 100);
+    EXPECT_EQ(oView.GetYSize(), 1);
+    EXPECT_EQ(oView.size(), 100 * sizeof(GUInt16));
+    EXPECT_EQ(static_cast<const GUInt16 *>(oView.data())[99], 1234);
+
+    GDALRasterBlock *poBlock = poBand->TryGetLockedBlockRef(0, 10);
+    ASSERT_TRUE(poBlock != nullptr);
+    EXPECT_EQ(poBlock->GetDataRef(), oView.data());
+    {
+        // Copies share the lock on the block
+        GDALRasterBlockView oCopy(oView);
+        EXPECT_EQ(oCopy.data(), oView.data());
+        EXPECT_EQ(poBlock->DropLock(), 2);
+        poBlock->AddLock();
+
+        GDALRasterBlockView oMoved(std::move(oCopy));
+        EXPECT_FALSE(oCopy);
+        EXPECT_EQ(oMoved.data(), oView.data());
+        EXPECT_EQ(poBlock->DropLock(), 2);
+        poBlock->AddLock();
+    }
+    EXPECT_EQ(poBlock->DropLock(), 1);
+    oView.reset();
+    EXPECT_FALSE(oView);
+    EXPECT_EQ(poBlock->AddLock(), 1);
+    poBlock->DropLock();
+}
+
+// Test GDALDataset::MultiRasterIO()
+TEST_F(test_gdal, MultiRasterIO)
+{
+    auto poDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (poDrv == nullptr)
+    {
+        GTEST_SKIP() << "GTIFF driver missing";
+    }
+
+    constexpr int nSize = 512;
+    const char *pszFilename = "/vsimem/multirasterio.tif";
+    {
+        const char *const apszOptions[] = {"TILED=YES", "BLOCKXSIZE=64",
+                                           "BLOCKYSIZE=64", nullptr};
+        std::unique_ptr<GDALDataset> poDS(
+            poDrv->Create(pszFilename, nSize, nSize, 2, GDT_UInt16,
+                          const_cast<char **>(apszOptions)));
+        ASSERT_TRUE(poDS != nullptr);
+        std::vector<GUInt16> anValues(nSize * nSize * 2);
+        for (size_t i = 0; i < anValues.size(); ++i)
+            anValues[i] = static_cast<GUInt16>(i * 7);
+        ASSERT_EQ(poDS->RasterIO(GF_Write, 0, 0, nSize, nSize,
+                                 anValues.data(), nSize, nSize, GDT_UInt16, 2,
+                                 nullptr, 0, 0, 0, nullptr),
+                  CE_None);
+    }
+
+    std::unique_ptr<GDALDataset> poDS(
+        GDALDataset::Open(pszFilename, GDAL_OF_RASTER));
+    ASSERT_TRUE(poDS != nullptr);
+
+    constexpr int nWindows = 200;
+    std::vector<GDALRasterIOWindow> asWindows(nWindows);
+    std::vector<std::vector<GUInt16>> aanBuffers(nWindows);
+    for (int i = 0; i < nWindows; ++i)
+    {
+        auto &sWindow = asWindows[i];
+        // Pseudo random windows, including some resampled ones
+        sWindow.nXOff = (i * 149) % (nSize - 40);
+        sWindow.nYOff = (i * 263) % (nSize - 40);
+        sWindow.nXSize = 1 + (i * 11) % 40;
+        sWindow.nYSize = 1 + (i * 17) % 40;
+        sWindow.nBufXSize = (i % 10) == 0 ? 3 : sWindow.nXSize;
+        sWindow.nBufYSize = (i % 10) == 0 ? 2 : sWindow.nYSize;
+        aanBuffers[i].resize(2 * sWindow.nBufXSize * sWindow.nBufYSize);
+        sWindow.pData = aanBuffers[i].data();
+        sWindow.eErr = CE_Failure;
+    }
+    int anBandMap[] = {2, 1};
+    EXPECT_EQ(poDS->MultiRasterIO(nWindows, asWindows.data(), GDT_UInt16, 2,
+                                  anBandMap, 0, 0, 0),
+              CE_None);
+    for (int i = 0; i < nWindows; ++i)
+    {
+        const auto &sWindow = asWindows[i];
+        EXPECT_EQ(sWindow.eErr, CE_None);
+        std::vector<GUInt16> anExpected(aanBuffers[i].size());
+        ASSERT_EQ(poDS->RasterIO(GF_Read, sWindow.nXOff, sWindow.nYOff,
+                                 sWindow.nXSize, sWindow.nYSize,
+                                 anExpected.data(), sWindow.nBufXSize,
+                                 sWindow.nBufYSize, GDT_UInt16, 2, anBandMap,
+                                 0, 0, 0, nullptr),
+                  CE_None);
+        EXPECT_EQ(aanBuffers[i], anExpected) << i;
+    }
+
+    // Invalid window
+    std::vector<GUInt16> anBuffer(4);
+    GDALRasterIOWindow asBadWindows[2] = {
+        {0, 0, 2, 2, anBuffer.data(), 2, 2, CE_Failure},
+        {nSize - 1, 0, 2, 2, anBuffer.data(), 2, 2, CE_None}};
+    {
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        EXPECT_EQ(poDS->MultiRasterIO(2, asBadWindows, GDT_UInt16, 1, nullptr,
+                                      0, 0, 0),
+                  CE_Failure);
+    }
+    EXPECT_EQ(asBadWindows[0].eErr, CE_None);
+    EXPECT_EQ(asBadWindows[1].eErr, CE_Failure);
+
+    poDS.reset();
+    VSIUnlink(pszFilename);
+}
+
+// Test GDALRasterBand::InterpolateAtPoints()
+TEST_F(test_gdal, InterpolateAtPoints)
+{
+    constexpr int nSize = 50;
+    const char *const apszOptions[] = {"BLOCKXSIZE=16", "BLOCKYSIZE=16",
+                                       nullptr};
+    auto poDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (poDrv == nullptr)
+    {
+        GTEST_SKIP() << "GTIFF driver missing";
+    }
+    std::unique_ptr<GDALDataset> poDS(
+        poDrv->Create("/vsimem/interpolateatpoints.tif", nSize, nSize, 1,
+                      GDT_Float32, const_cast<char **>(apszOptions)));
+    ASSERT_TRUE(poDS != nullptr);
+    auto poBand = poDS->GetRasterBand(1);
+    // Value at the center of pixel (i, j) is i + 2 * j
+    std::vector<float> afValues(nSize * nSize);
+    for (int j = 0; j < nSize; ++j)
+        for (int i = 0; i < nSize; ++i)
+            afValues[j * nSize + i] = static_cast<float>(i + 2 * j);
+    ASSERT_EQ(poBand->RasterIO(GF_Write, 0, 0, nSize, nSize, afValues.data(),
+                               nSize, nSize, GDT_Float32, 0, 0, nullptr),
+              CE_None);
+
+    // Points spread over several blocks, in random order
+    std::vector<double> adfPixel;
+    std::vector<double> adfLine;
+    for (int i = 0; i < 500; ++i)
+    {
+        adfPixel.push_back(2 + ((i * 37) % 450) / 10.0);
+        adfLine.push_back(2 + ((i * 53) % 450) / 10.0);
+    }
+    // Outside of the raster
+    adfPixel.push_back(-1);
+    adfLine.push_back(1);
+    adfPixel.push_back(1);
+    adfLine.push_back(nSize + 1);
+    const int nPoints = static_cast<int>(adfPixel.size());
+
+    std::vector<double> adfResult(nPoints);
+    std::vector<int> abSuccess(nPoints);
+    for (const auto eResampleAlg :
+         {GRIORA_NearestNeighbour, GRIORA_Bilinear, GRIORA_Cubic})
+    {
+        ASSERT_EQ(poBand->InterpolateAtPoints(
+                      nPoints, adfPixel.data(), adfLine.data(), eResampleAlg,
+                      adfResult.data(), abSuccess.data()),
+                  CE_None);
+        for (int i = 0; i < nPoints - 2; ++i)
+        {
+            ASSERT_TRUE(abSuccess[i]) << i;
+            const double dfExpected =
+                eResampleAlg == GRIORA_NearestNeighbour
+                    ? std::floor(adfPixel[i]) + 2 * std::floor(adfLine[i])
+                    : (adfPixel[i] - 0.5) + 2 * (adfLine[i] - 0.5);
+            EXPECT_NEAR(adfResult[i], dfExpected, 1e-5)
+                << eResampleAlg << " " << i;
+        }
+        EXPECT_FALSE(abSuccess[nPoints - 2]);
+        EXPECT_TRUE(std::isnan(adfResult[nPoints - 2]));
+        EXPECT_FALSE(abSuccess[nPoints - 1]);
+    }
+
+    // Nodata pixels are ignored by bilinear interpolation
+    poBand->SetNoDataValue(-1);
+    float fNoData = -1;
+    ASSERT_EQ(poBand->RasterIO(GF_Write, 10, 10, 1, 1, &fNoData, 1, 1,
+                               GDT_Float32, 0, 0, nullptr),
+              CE_None);
+    double dfPixel = 11;
+    double dfLine = 11;
+    double dfValue = 0;
+    for (const auto eResampleAlg : {GRIORA_Bilinear, GRIORA_Cubic})
+    {
+        ASSERT_EQ(poBand->InterpolateAtPoints(1, &dfPixel, &dfLine,
+                                              eResampleAlg, &dfValue, nullptr),
+                  CE_None);
+        // Average of (11, 10), (10, 11) and (11, 11)
+        EXPECT_NEAR(dfValue, (31 + 32 + 33) / 3.0, 1e-5);
+    }
+    dfPixel = 10.5;
+    dfLine = 10.5;
+    ASSERT_EQ(poBand->InterpolateAtPoints(1, &dfPixel, &dfLine,
+                                          GRIORA_NearestNeighbour, &dfValue,
+                                          nullptr),
+              CE_None);
+    EXPECT_EQ(dfValue, -1);
+
+    {
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        EXPECT_EQ(poBand->InterpolateAtPoints(1, &dfPixel, &dfLine,
+                                              GRIORA_Mode, &dfValue, nullptr),
+                  CE_Failure);
+    }
+
+    poDS.reset();
+    VSIUnlink("/vsimem/interpolateatpoints.tif");
+}
+
+// Test GDALRegenerateOverviewsMultiBand() with multi-threading and cascading
+// of overview levels in memory
+TEST_F(test_gdal, GDALRegenerateOverviewsMultiBand_threaded)
+{
+    GDALDriver *poGTiffDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+    GDALDriver *poMEMDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (poGTiffDrv == nullptr || poMEMDrv == nullptr)
+    {
+        GTEST_SKIP() << "GTiff or MEM driver missing";
+    }
+
+    constexpr int nBands = 3;
+    constexpr int nXSize = 257;
+    constexpr int nYSize = 263;
+    const char *pszFilename = "/vsimem/regenerateoverviewsmultiband.tif";
+    {
+        auto poDS = std::unique_ptr<GDALDataset>(poGTiffDrv->Create(
+            pszFilename, nXSize, nYSize, nBands, GDT_Byte, nullptr));
+        ASSERT_TRUE(poDS != nullptr);
+        std::vector<GByte> abyValues(nXSize * nYSize);
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            for (int i = 0; i < nXSize * nYSize; ++i)
+                abyValues[i] = static_cast<GByte>((i * (iBand + 7)) % 251);
+            auto poBand = poDS->GetRasterBand(iBand + 1);
+            poBand->SetNoDataValue(0);
+            ASSERT_EQ(poBand->RasterIO(GF_Write, 0, 0, nXSize, nYSize,
+                                       abyValues.data(), nXSize, nYSize,
+                                       GDT_Byte, 0, 0, nullptr),
+                      CE_None);
+        }
+    }
+    auto poSrcDS = std::unique_ptr<GDALDataset>(
+        GDALDataset::Open(pszFilename, GDAL_OF_RASTER));
+    ASSERT_TRUE(poSrcDS != nullptr);
+
+    const auto ComputeOverviews = [&poSrcDS, poMEMDrv](const char *pszThreads,
+                                                       const char *pszCascade)
+    {
+        CPLConfigOptionSetter oThreads("GDAL_NUM_THREADS", pszThreads, false);
+        CPLConfigOptionSetter oCascade("GDAL_OVR_CASCADE_MAX_SIZE", pszCascade,
+                                       false);
+        CPLConfigOptionSetter oChunk("GDAL_OVR_CHUNK_MAX_SIZE", "1000", false);
+
+        std::vector<std::unique_ptr<GDALDataset>> apoOvrDS;
+        std::vector<GDALRasterBand *> apoSrcBands;
+        std::vector<std::vector<GDALRasterBand *>> aapoOvrBands(nBands);
+        for (int iBand = 0; iBand < nBands; ++iBand)
+            apoSrcBands.push_back(poSrcDS->GetRasterBand(iBand + 1));
+        for (int nFactor : {2, 4, 8})
+        {
+            apoOvrDS.emplace_back(poMEMDrv->Create(
+                "", (nXSize + nFactor - 1) / nFactor,
+                (nYSize + nFactor - 1) / nFactor, nBands, GDT_Byte, nullptr));
+            for (int iBand = 0; iBand < nBands; ++iBand)
+            {
+                auto poOvrBand = apoOvrDS.back()->GetRasterBand(iBand + 1);
+                poOvrBand->SetNoDataValue(0);
+                aapoOvrBands[iBand].push_back(poOvrBand);
+            }
+        }
+        std::vector<GDALRasterBand **> apapoOvrBands;
+        for (int iBand = 0; iBand < nBands; ++iBand)
+            apapoOvrBands.push_back(aapoOvrBands[iBand].data());
+
+        std::vector<int> anChecksums;
+        if (GDALRegenerateOverviewsMultiBand(
+                nBands, apoSrcBands.data(), 3, apapoOvrBands.data(), "AVERAGE",
+                nullptr, nullptr, nullptr) == CE_None)
+        {
+            for (auto &poOvrDS : apoOvrDS)
+            {
+                for (int iBand = 0; iBand < nBands; ++iBand)
+                {
+                    anChecksums.push_back(GDALChecksumImage(
+                        poOvrDS->GetRasterBand(iBand + 1), 0, 0,
+                        poOvrDS->GetRasterXSize(), poOvrDS->GetRasterYSize()));
+                }
+            }
+        }
+        return anChecksums;
+    };
+
+    const auto anExpected = ComputeOverviews("1", "0");
+    ASSERT_EQ(anExpected.size(), static_cast<size_t>(3 * nBands));
+    EXPECT_EQ(ComputeOverviews("1", "104857600"), anExpected);
+    EXPECT_EQ(ComputeOverviews("4", "0"), anExpected);
+    EXPECT_EQ(ComputeOverviews("4", "104857600"), anExpected);
+
+    poSrcDS.reset();
+    VSIUnlink(pszFilename);
+}
+
+// Test the MODE and GAUSS overview resampling kernels
+TEST_F(test_gdal, GDALRegenerateOverviews_mode_gauss)
+{
+    GDALDriver *poMEMDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (poMEMDrv == nullptr)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+
+    constexpr int nSize = 64;
+    for (const GDALDataType eDT : {GDT_Byte, GDT_UInt16})
+    {
+        auto poSrcDS = std::unique_ptr<GDALDataset>(
+            poMEMDrv->Create("", nSize, nSize, 1, eDT, nullptr));
+        std::vector<GUInt16> anValues(nSize * nSize);
+        for (int i = 0; i < nSize * nSize; ++i)
+            anValues[i] = static_cast<GUInt16>(((i * 7919) % 13 % 5) * 50);
+        auto poSrcBand = poSrcDS->GetRasterBand(1);
+        ASSERT_EQ(poSrcBand->RasterIO(GF_Write, 0, 0, nSize, nSize,
+                                      anValues.data(), nSize, nSize,
+                                      GDT_UInt16, 0, 0, nullptr),
+                  CE_None);
+
+        for (int nFactor : {2, 4, 8})
+        {
+            const int nOvrSize = nSize / nFactor;
+            auto poOvrDS = std::unique_ptr<GDALDataset>(
+                poMEMDrv->Create("", nOvrSize, nOvrSize, 1, eDT, nullptr));
+            GDALRasterBandH hOvrBand =
+                GDALRasterBand::ToHandle(poOvrDS->GetRasterBand(1));
+            ASSERT_EQ(GDALRegenerateOverviews(
+                          GDALRasterBand::ToHandle(poSrcBand), 1, &hOvrBand,
+                          "MODE", nullptr, nullptr),
+                      CE_None);
+            std::vector<GUInt16> anOvr(nOvrSize * nOvrSize);
+            ASSERT_EQ(poOvrDS->GetRasterBand(1)->RasterIO(
+                          GF_Read, 0, 0, nOvrSize, nOvrSize, anOvr.data(),
+                          nOvrSize, nOvrSize, GDT_UInt16, 0, 0, nullptr),
+                      CE_None);
+            for (int iY = 0; iY < nOvrSize; ++iY)
+            {
+                for (int iX = 0; iX < nOvrSize; ++iX)
+                {
+                    // The first value to reach the highest count wins
+                    std::map<int, int> oCounts;
+                    int nMaxCount = 0;
+                    int nExpected = 0;
+                    for (int j = 0; j < nFactor; ++j)
+                    {
+                        for (int i = 0; i < nFactor; ++i)
+                        {
+                            const int nVal =
+                                anValues[(iY * nFactor + j) * nSize +
+                                         iX * nFactor + i];
+                            if (++oCounts[nVal] > nMaxCount)
+                            {
+                                nMaxCount = oCounts[nVal];
+                                nExpected = nVal;
+                            }
+                        }
+                    }
+                    ASSERT_EQ(anOvr[iY * nOvrSize + iX], nExpected)
+                        << eDT << " " << nFactor << " " << iX << " " << iY;
+                }
+            }
+        }
+
+        // Interior pixels of a constant area are unchanged by GAUSS
+        ASSERT_EQ(poSrcBand->Fill(100), CE_None);
+        auto poOvrDS = std::unique_ptr<GDALDataset>(
+            poMEMDrv->Create("", nSize / 2, nSize / 2, 1, eDT, nullptr));
+        GDALRasterBandH hOvrBand =
+            GDALRasterBand::ToHandle(poOvrDS->GetRasterBand(1));
+        ASSERT_EQ(GDALRegenerateOverviews(GDALRasterBand::ToHandle(poSrcBand),
+                                          1, &hOvrBand, "GAUSS", nullptr,
+                                          nullptr),
+                  CE_None);
+        double adfMinMax[2] = {0, 0};
+        ASSERT_EQ(poOvrDS->GetRasterBand(1)->ComputeRasterMinMax(false,
+                                                                 adfMinMax),
+                  CE_None);
+        EXPECT_EQ(adfMinMax[0], 100);
+        EXPECT_EQ(adfMinMax[1], 100);
+    }
+}
+
+// Test convolution overview resampling with a power-of-two factor
+TEST_F(test_gdal, GDALRegenerateOverviews_bilinear_factor_2)
+{
+    GDALDriver *poMEMDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (poMEMDrv == nullptr)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+
+    constexpr int nSize = 64;
+    constexpr int nOvrSize = nSize / 2;
+    auto poSrcDS = std::unique_ptr<GDALDataset>(
+        poMEMDrv->Create("", nSize, nSize, 1, GDT_Float32, nullptr));
+    std::vector<float> afValues(nSize * nSize);
+    for (int i = 0; i < nSize * nSize; ++i)
+        afValues[i] = static_cast<float>((i * 7919) % 101);
+    auto poSrcBand = poSrcDS->GetRasterBand(1);
+    ASSERT_EQ(poSrcBand->RasterIO(GF_Write, 0, 0, nSize, nSize,
+                                  afValues.data(), nSize, nSize, GDT_Float32,
+                                  0, 0, nullptr),
+              CE_None);
+
+    auto poOvrDS = std::unique_ptr<GDALDataset>(
+        poMEMDrv->Create("", nOvrSize, nOvrSize, 1, GDT_Float32, nullptr));
+    GDALRasterBandH hOvrBand =
+        GDALRasterBand::ToHandle(poOvrDS->GetRasterBand(1));
+    ASSERT_EQ(GDALRegenerateOverviews(GDALRasterBand::ToHandle(poSrcBand), 1,
+                                      &hOvrBand, "BILINEAR", nullptr, nullptr),
+              CE_None);
+    std::vector<float> afOvr(nOvrSize * nOvrSize);
+    ASSERT_EQ(poOvrDS->GetRasterBand(1)->RasterIO(
+                  GF_Read, 0, 0, nOvrSize, nOvrSize, afOvr.data(), nOvrSize,
+                  nOvrSize, GDT_Float32, 0, 0, nullptr),
+              CE_None);
+
+    // Separable weights of the 4x4 source pixels of interior pixels
+    constexpr double adfWeights[] = {1. / 8, 3. / 8, 3. / 8, 1. / 8};
+    for (int iY = 1; iY < nOvrSize - 1; ++iY)
+    {
+        for (int iX = 1; iX < nOvrSize - 1; ++iX)
+        {
+            double dfExpected = 0;
+            for (int j = 0; j < 4; ++j)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    dfExpected += adfWeights[j] * adfWeights[i] *
+                                  afValues[(2 * iY - 1 + j) * nSize +
+                                           2 * iX - 1 + i];
+                }
+            }
+            ASSERT_NEAR(afOvr[iY * nOvrSize + iX], dfExpected, 1e-3)
+                << iX << " " << iY;
+        }
+    }
+}
+
+// Test that ComputeStatistics(), ComputeRasterMinMax() and GetHistogram()
+// give the same results with GDAL_NUM_THREADS
+TEST_F(test_gdal, ComputeStatistics_threaded)
+{
+    GDALDriver *poGTiffDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (poGTiffDrv == nullptr)
+    {
+        GTEST_SKIP() << "GTiff driver missing";
+    }
+
+    constexpr int nSize = 250;
+    for (GDALDataType eDT : {GDT_UInt16, GDT_Float32})
+    {
+        const char *pszFilename = "/vsimem/computestatistics_threaded.tif";
+        {
+            CPLStringList aosOptions;
+            aosOptions.SetNameValue("TILED", "YES");
+            aosOptions.SetNameValue("BLOCKXSIZE", "32");
+            aosOptions.SetNameValue("BLOCKYSIZE", "32");
+            auto poDS = std::unique_ptr<GDALDataset>(poGTiffDrv->Create(
+                pszFilename, nSize, nSize, 1, eDT, aosOptions.List()));
+            ASSERT_TRUE(poDS != nullptr);
+            std::vector<double> adfValues(nSize * nSize);
+            for (int i = 0; i < nSize * nSize; ++i)
+                adfValues[i] = (i * 37) % 1009 + (i % 7) * 0.25;
+            auto poBand = poDS->GetRasterBand(1);
+            poBand->SetNoDataValue(0);
+            ASSERT_EQ(poBand->RasterIO(GF_Write, 0, 0, nSize, nSize,
+                                       adfValues.data(), nSize, nSize,
+                                       GDT_Float64, 0, 0, nullptr),
+                      CE_None);
+        }
+
+        const auto Compute =
+            [pszFilename](const char *pszThreads, double adfStats[4],
+                          double adfMinMax[2], std::vector<GUIntBig> &anHist)
+        {
+            CPLConfigOptionSetter oThreads("GDAL_NUM_THREADS", pszThreads,
+                                           false);
+            auto poDS = std::unique_ptr<GDALDataset>(
+                GDALDataset::Open(pszFilename, GDAL_OF_RASTER));
+            ASSERT_TRUE(poDS != nullptr);
+            auto poBand = poDS->GetRasterBand(1);
+            ASSERT_EQ(poBand->ComputeStatistics(false, &adfStats[0],
+                                                &adfStats[1], &adfStats[2],
+                                                &adfStats[3], nullptr, nullptr),
+                      CE_None);
+            ASSERT_EQ(poBand->ComputeRasterMinMax(false, adfMinMax), CE_None);
+            anHist.resize(100);
+            ASSERT_EQ(poBand->GetHistogram(-0.5, 1009.5, 100, anHist.data(),
+                                           false, false, nullptr, nullptr),
+                      CE_None);
+        };
+
+        double adfStats1[4] = {0};
+        double adfMinMax1[2] = {0};
+        std::vector<GUIntBig> anHist1;
+        Compute("1", adfStats1, adfMinMax1, anHist1);
+
+        double adfStats4[4] = {0};
+        double adfMinMax4[2] = {0};
+        std::vector<GUIntBig> anHist4;
+        Compute("4", adfStats4, adfMinMax4, anHist4);
+
+        EXPECT_EQ(adfStats4[0], adfStats1[0]);
+        EXPECT_EQ(adfStats4[1], adfStats1[1]);
+        EXPECT_NEAR(adfStats4[2], adfStats1[2], 1e-10 * adfStats1[2]);
+        EXPECT_NEAR(adfStats4[3], adfStats1[3], 1e-10 * adfStats1[3]);
+        EXPECT_EQ(adfMinMax4[0], adfMinMax1[0]);
+        EXPECT_EQ(adfMinMax4[1], adfMinMax1[1]);
+        EXPECT_EQ(anHist4, anHist1);
+
+        poGTiffDrv->Delete(pszFilename);
+    }
+}
+
+// Test the vectorized statistics kernels against a direct computation
+TEST_F(test_gdal, ComputeStatistics_float_int16_nodata)
+{
+    GDALDriver *poMEMDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (poMEMDrv == nullptr)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+
+    constexpr int nXSize = 61;
+    constexpr int nYSize = 17;
+    constexpr double dfNoData = -9999;
+    for (GDALDataType eDT : {GDT_Int16, GDT_Float32, GDT_Float64})
+    {
+        auto poDS = std::unique_ptr<GDALDataset>(
+            poMEMDrv->Create("", nXSize, nYSize, 1, eDT, nullptr));
+        auto poBand = poDS->GetRasterBand(1);
+        poBand->SetNoDataValue(dfNoData);
+        std::vector<double> adfValues(nXSize * nYSize);
+        double dfMin = std::numeric_limits<double>::max();
+        double dfMax = -std::numeric_limits<double>::max();
+        double dfSum = 0;
+        int nValid = 0;
+        for (int i = 0; i < nXSize * nYSize; ++i)
+        {
+            if ((i % 11) == 0)
+                adfValues[i] = dfNoData;
+            else if ((i % 13) == 0 && eDT != GDT_Int16)
+                adfValues[i] = std::numeric_limits<double>::quiet_NaN();
+            else
+            {
+                adfValues[i] = (i * 7919) % 3001 - 1500;
+                if (eDT != GDT_Int16)
+                    adfValues[i] += 0.5;
+                dfMin = std::min(dfMin, adfValues[i]);
+                dfMax = std::max(dfMax, adfValues[i]);
+                dfSum += adfValues[i];
+                ++nValid;
+            }
+        }
+        const double dfMean = dfSum / nValid;
+        double dfM2 = 0;
+        for (double dfVal : adfValues)
+        {
+            if (dfVal != dfNoData && !std::isnan(dfVal))
+                dfM2 += (dfVal - dfMean) * (dfVal - dfMean);
+        }
+        ASSERT_EQ(poBand->RasterIO(GF_Write, 0, 0, nXSize, nYSize,
+                                   adfValues.data(), nXSize, nYSize,
+                                   GDT_Float64, 0, 0, nullptr),
+                  CE_None);
+
+        double dfStatsMin = 0, dfStatsMax = 0, dfStatsMean = 0,
+               dfStatsStdDev = 0;
+        ASSERT_EQ(poBand->ComputeStatistics(false, &dfStatsMin, &dfStatsMax,
+                                            &dfStatsMean, &dfStatsStdDev,
+                                            nullptr, nullptr),
+                  CE_None);
+        EXPECT_EQ(dfStatsMin, dfMin);
+        EXPECT_EQ(dfStatsMax, dfMax);
+        EXPECT_NEAR(dfStatsMean, dfMean, 1e-10);
+        EXPECT_NEAR(dfStatsStdDev, sqrt(dfM2 / nValid), 1e-10);
+
+        double adfMinMax[2] = {0, 0};
+        ASSERT_EQ(poBand->ComputeRasterMinMax(false, adfMinMax), CE_None);
+        EXPECT_EQ(adfMinMax[0], dfMin);
+        EXPECT_EQ(adfMinMax[1], dfMax);
+    }
+}
+
+// Test GDALRasterBand::ComputeStatisticsAndHistogram()
+TEST_F(test_gdal, ComputeStatisticsAndHistogram)
+{
+    GDALDriver *poMEMDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (poMEMDrv == nullptr)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+
+    constexpr int nXSize = 101;
+    constexpr int nYSize = 53;
+    constexpr double dfNoData = 0;
+    const double adfQuantiles[] = {0, 0.01, 0.25, 0.5, 0.75, 0.99, 1};
+    constexpr int nQuantiles = static_cast<int>(CPL_ARRAYSIZE(adfQuantiles));
+    for (GDALDataType eDT : {GDT_Byte, GDT_UInt16, GDT_Float32})
+    {
+        auto poDS = std::unique_ptr<GDALDataset>(
+            poMEMDrv->Create("", nXSize, nYSize, 1, eDT, nullptr));
+        auto poBand = poDS->GetRasterBand(1);
+        poBand->SetNoDataValue(dfNoData);
+        std::vector<double> adfValues(nXSize * nYSize);
+        std::vector<double> adfValidValues;
+        for (int i = 0; i < nXSize * nYSize; ++i)
+        {
+            adfValues[i] = (i % 17) == 0 ? dfNoData : 1 + (i * 7919) % 251;
+            if (eDT == GDT_Float32 && adfValues[i] != dfNoData)
+                adfValues[i] += 0.25;
+            if (adfValues[i] != dfNoData)
+                adfValidValues.push_back(adfValues[i]);
+        }
+        std::sort(adfValidValues.begin(), adfValidValues.end());
+        const int nValid = static_cast<int>(adfValidValues.size());
+        ASSERT_EQ(poBand->RasterIO(GF_Write, 0, 0, nXSize, nYSize,
+                                   adfValues.data(), nXSize, nYSize,
+                                   GDT_Float64, 0, 0, nullptr),
+                  CE_None);
+
+        double dfMin = 0, dfMax = 0, dfMean = 0, dfStdDev = 0;
+        GUIntBig nValidCount = 0;
+        double dfHistMin = 0, dfHistMax = 0;
+        int nBuckets = 0;
+        GUIntBig *panHistogram = nullptr;
+        double adfQuantileValues[nQuantiles] = {};
+        ASSERT_EQ(poBand->ComputeStatisticsAndHistogram(
+                      false, &dfMin, &dfMax, &dfMean, &dfStdDev, &nValidCount,
+                      &dfHistMin, &dfHistMax, &nBuckets, &panHistogram,
+                      nQuantiles, adfQuantiles, adfQuantileValues, nullptr,
+                      nullptr),
+                  CE_None);
+        EXPECT_EQ(nValidCount, static_cast<GUIntBig>(nValid));
+
+        // Same results as the separate computations.
+        double dfStatsMin = 0, dfStatsMax = 0, dfStatsMean = 0,
+               dfStatsStdDev = 0;
+        ASSERT_EQ(poBand->ComputeStatistics(false, &dfStatsMin, &dfStatsMax,
+                                            &dfStatsMean, &dfStatsStdDev,
+                                            nullptr, nullptr),
+                  CE_None);
+        EXPECT_EQ(dfMin, dfStatsMin);
+        EXPECT_EQ(dfMax, dfStatsMax);
+        EXPECT_NEAR(dfMean, dfStatsMean, 1e-10);
+        EXPECT_NEAR(dfStdDev, dfStatsStdDev, 1e-10);
+
+        ASSERT_EQ(nBuckets, 256);
+        std::vector<GUIntBig> anHistogram(nBuckets);
+        ASSERT_EQ(poBand->GetHistogram(dfHistMin, dfHistMax, nBuckets,
+                                       anHistogram.data(), true, false,
+                                       nullptr, nullptr),
+                  CE_None);
+        GUIntBig nHistogramTotal = 0;
+        for (int i = 0; i < nBuckets; ++i)
+        {
+            nHistogramTotal += panHistogram[i];
+            if (eDT != GDT_Float32)
+            {
+                EXPECT_EQ(panHistogram[i], anHistogram[i]) << i;
+            }
+        }
+        EXPECT_EQ(nHistogramTotal, nValidCount);
+        VSIFree(panHistogram);
+
+        for (int i = 0; i < nQuantiles; ++i)
+        {
+            const int nRank = std::max(
+                1, static_cast<int>(std::ceil(adfQuantiles[i] * nValid)));
+            const double dfExpected = adfValidValues[nRank - 1];
+            if (eDT != GDT_Float32)
+            {
+                EXPECT_EQ(adfQuantileValues[i], dfExpected) << i;
+            }
+            else
+            {
+                EXPECT_NEAR(adfQuantileValues[i], dfExpected, 1.0) << i;
+            }
+        }
+        const char *pszMedian =
+            poBand->GetMetadataItem("STATISTICS_QUANTILE_0.5");
+        ASSERT_NE(pszMedian, nullptr);
+        EXPECT_EQ(CPLAtof(pszMedian), adfQuantileValues[3]);
+
+        // Histogram on requested bounds.
+        dfHistMin = 10;
+        dfHistMax = 20;
+        nBuckets = 10;
+        GUIntBig *panHistogram2 = nullptr;
+        ASSERT_EQ(poBand->ComputeStatisticsAndHistogram(
+                      false, nullptr, nullptr, nullptr, nullptr, nullptr,
+                      &dfHistMin, &dfHistMax, &nBuckets, &panHistogram2, 0,
+                      nullptr, nullptr, nullptr, nullptr),
+                  CE_None);
+        ASSERT_EQ(nBuckets, 10);
+        ASSERT_EQ(poBand->GetHistogram(10, 20, 10, anHistogram.data(), true,
+                                       false, nullptr, nullptr),
+                  CE_None);
+        for (int i = 0; i < nBuckets; ++i)
+            EXPECT_EQ(panHistogram2[i], anHistogram[i]) << i;
+        VSIFree(panHistogram2);
+    }
+
+    // Invalid quantile
+    auto poDS = std::unique_ptr<GDALDataset>(
+        poMEMDrv->Create("", 1, 1, 1, GDT_Byte, nullptr));
+    const double dfInvalidQuantile = 1.5;
+    double dfQuantileValue = 0;
+    CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+    EXPECT_EQ(poDS->GetRasterBand(1)->ComputeStatisticsAndHistogram(
+                  false, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                  nullptr, nullptr, nullptr, 1, &dfInvalidQuantile,
+                  &dfQuantileValue, nullptr, nullptr),
+              CE_Failure);
+}
+
+// Test the BLOCK_STATISTICS option of the GTiff driver
+TEST_F(test_gdal, GTiff_BLOCK_STATISTICS)
+{
+    GDALDriver *poGTiffDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (poGTiffDrv == nullptr)
+    {
+        GTEST_SKIP() << "GTiff driver missing";
+    }
+
+    constexpr int nXSize = 100;
+    constexpr int nYSize = 70;
+    std::vector<uint16_t> anValues(nXSize * nYSize);
+    for (int i = 0; i < nXSize * nYSize; ++i)
+        anValues[i] = static_cast<uint16_t>((i * 37) % 1009);
+
+    const char *pszRefFilename = "/vsimem/gtiff_block_statistics_ref.tif";
+    const char *pszFilename = "/vsimem/gtiff_block_statistics.tif";
+    const std::string osBlockStatsFilename =
+        std::string(pszFilename) + ".blockstats";
+    for (const char *pszBlockStats : {"NO", "YES"})
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("TILED", "YES");
+        aosOptions.SetNameValue("BLOCKXSIZE", "32");
+        aosOptions.SetNameValue("BLOCKYSIZE", "32");
+        aosOptions.SetNameValue("BLOCK_STATISTICS", pszBlockStats);
+        auto poDS = std::unique_ptr<GDALDataset>(poGTiffDrv->Create(
+            EQUAL(pszBlockStats, "YES") ? pszFilename : pszRefFilename, nXSize,
+            nYSize, 1, GDT_UInt16, aosOptions.List()));
+        ASSERT_TRUE(poDS != nullptr);
+        auto poBand = poDS->GetRasterBand(1);
+        poBand->SetNoDataValue(0);
+        ASSERT_EQ(poBand->RasterIO(GF_Write, 0, 0, nXSize, nYSize,
+                                   anValues.data(), nXSize, nYSize, GDT_UInt16,
+                                   0, 0, nullptr),
+                  CE_None);
+    }
+
+    VSIStatBufL sStat;
+    EXPECT_EQ(VSIStatL(osBlockStatsFilename.c_str(), &sStat), 0);
+
+    const auto CheckSameStatistics = [pszRefFilename, pszFilename]()
+    {
+        double adfRef[4] = {0};
+        {
+            auto poDS = std::unique_ptr<GDALDataset>(
+                GDALDataset::Open(pszRefFilename, GDAL_OF_RASTER));
+            ASSERT_TRUE(poDS != nullptr);
+            ASSERT_EQ(poDS->GetRasterBand(1)->ComputeStatistics(
+                          false, &adfRef[0], &adfRef[1], &adfRef[2],
+                          &adfRef[3], nullptr, nullptr),
+                      CE_None);
+        }
+        double adfStats[4] = {0};
+        {
+            auto poDS = std::unique_ptr<GDALDataset>(
+                GDALDataset::Open(pszFilename, GDAL_OF_RASTER));
+            ASSERT_TRUE(poDS != nullptr);
+            ASSERT_EQ(poDS->GetRasterBand(1)->ComputeStatistics(
+                          false, &adfStats[0], &adfStats[1], &adfStats[2],
+                          &adfStats[3], nullptr, nullptr),
+                      CE_None);
+        }
+        EXPECT_EQ(adfStats[0], adfRef[0]);
+        EXPECT_EQ(adfStats[1], adfRef[1]);
+        EXPECT_NEAR(adfStats[2], adfRef[2], 1e-10 * adfRef[2]);
+        EXPECT_NEAR(adfStats[3], adfRef[3], 1e-10 * adfRef[3]);
+    };
+    CheckSameStatistics();
+
+    // Update a region overlapping several blocks of both files: the
+    // statistics stored in the file with block statistics must be refreshed
+    // at flush time.
+    std::vector<uint16_t> anPatch(40 * 30, 2000);
+    for (const char *pszName : {pszRefFilename, pszFilename})
+    {
+        auto poDS = std::unique_ptr<GDALDataset>(
+            GDALDataset::Open(pszName, GDAL_OF_RASTER | GDAL_OF_UPDATE));
+        ASSERT_TRUE(poDS != nullptr);
+        ASSERT_EQ(poDS->GetRasterBand(1)->RasterIO(
+                      GF_Write, 20, 10, 40, 30, anPatch.data(), 40, 30,
+                      GDT_UInt16, 0, 0, nullptr),
+                  CE_None);
+    }
+    {
+        auto poDS = std::unique_ptr<GDALDataset>(
+            GDALDataset::Open(pszFilename, GDAL_OF_RASTER));
+        ASSERT_TRUE(poDS != nullptr);
+        const char *pszMax =
+            poDS->GetRasterBand(1)->GetMetadataItem("STATISTICS_MAXIMUM");
+        ASSERT_TRUE(pszMax != nullptr);
+        EXPECT_EQ(CPLAtof(pszMax), 2000.0);
+    }
+    CheckSameStatistics();
+
+    poGTiffDrv->Delete(pszRefFilename);
+    poGTiffDrv->Delete(pszFilename);
+    EXPECT_NE(VSIStatL(osBlockStatsFilename.c_str(), &sStat), 0);
+}
+
+// Test that GDALMDArray::Read() splits requests on arrays declaring
+// IsReadThreadSafe() along chunk boundaries with GDAL_NUM_THREADS
+TEST_F(test_gdal, GDALMDArray_Read_threaded)
+{
+    class ChunkedArray : public GDALMDArray
+    {
+        GDALExtendedDataType m_dt = GDALExtendedDataType::Create(GDT_Float64);
+        std::vector<std::shared_ptr<GDALDimension>> m_dims{};
+        const std::string m_osEmptyFilename{};
+
+      protected:
+        bool IRead(const GUInt64 *arrayStartIdx, const size_t *count,
+                   const GInt64 *arrayStep, const GPtrDiff_t *bufferStride,
+                   const GDALExtendedDataType &bufferDataType,
+                   void *pDstBuffer) const override
+        {
+            {
+                std::lock_guard<std::mutex> oLock(m_oMutex);
+                m_anReadStarts.push_back(arrayStartIdx[0]);
+            }
+            for (size_t i = 0; i < count[0]; ++i)
+            {
+                for (size_t j = 0; j < count[1]; ++j)
+                {
+                    for (size_t k = 0; k < count[2]; ++k)
+                    {
+                        const double dfVal = static_cast<double>(
+                            (arrayStartIdx[0] + i * arrayStep[0]) * 10000 +
+                            (arrayStartIdx[1] + j * arrayStep[1]) * 100 +
+                            (arrayStartIdx[2] + k * arrayStep[2]));
+                        GDALExtendedDataType::CopyValue(
+                            &dfVal, m_dt,
+                            static_cast<GByte *>(pDstBuffer) +
+                                (i * bufferStride[0] + j * bufferStride[1] +
+                                 k * bufferStride[2]) *
+                                    bufferDataType.GetSize(),
+                            bufferDataType);
+                    }
+                }
+            }
+            return true;
+        }
+
+      public:
+        mutable std::mutex m_oMutex{};
+        mutable std::vector<GUInt64> m_anReadStarts{};
+
+        ChunkedArray()
+            : GDALAbstractMDArray("", "array"), GDALMDArray("", "array")
+        {
+            for (const GUInt64 nSize : {100, 60, 50})
+            {
+                m_dims.emplace_back(
+                    std::make_shared<GDALDimension>("", "", "", "", nSize));
+            }
+        }
+
+        static std::shared_ptr<ChunkedArray> Create()
+        {
+            auto ar(std::make_shared<ChunkedArray>());
+            ar->SetSelf(ar);
+            return ar;
+        }
+
+        bool IsWritable() const override
+        {
+            return false;
+        }
+
+        bool IsReadThreadSafe() const override
+        {
+            return true;
+        }
+
+        const std::string &GetFilename() const override
+        {
+            return m_osEmptyFilename;
+        }
+
+        const std::vector<std::shared_ptr<GDALDimension>> &
+        GetDimensions() const override
+        {
+            return m_dims;
+        }
+
+        const GDALExtendedDataType &GetDataType() const override
+        {
+            return m_dt;
+        }
+
+        std::vector<GUInt64> GetBlockSize() const override
+        {
+            return {7, 60, 50};
+        }
+    };
+
+    auto poArray = ChunkedArray::Create();
+
+    const auto Read =
+        [&poArray](const char *pszThreads, const GUInt64 *anStart,
+                   const size_t *anCount, const GInt64 *anStep,
+                   const GPtrDiff_t *anStride, std::vector<double> &adfOut)
+    {
+        CPLConfigOptionSetter oThreads("GDAL_NUM_THREADS", pszThreads, false);
+        adfOut.resize(anCount[0] * anCount[1] * anCount[2]);
+        GByte *pabyDst = reinterpret_cast<GByte *>(adfOut.data());
+        if (anStride && anStride[1] < 0)
+            pabyDst += (anCount[1] - 1) * anCount[2] * sizeof(double);
+        poArray->m_anReadStarts.clear();
+        EXPECT_TRUE(poArray->Read(anStart, anCount, anStep, anStride,
+                                  GDALExtendedDataType::Create(GDT_Float64),
+                                  pabyDst));
+    };
+
+    // Full array, and a strided request with rows in reverse order.
+    const GUInt64 anFullStart[] = {0, 0, 0};
+    const size_t anFullCount[] = {100, 60, 50};
+    const GUInt64 anSubStart[] = {3, 59, 1};
+    const size_t anSubCount[] = {48, 60, 49};
+    const GInt64 anSubStep[] = {2, -1, 1};
+    const GPtrDiff_t anSubStride[] = {60 * 49, -49, 1};
+    for (int iTest = 0; iTest < 2; ++iTest)
+    {
+        const GUInt64 *anStart = iTest == 0 ? anFullStart : anSubStart;
+        const size_t *anCount = iTest == 0 ? anFullCount : anSubCount;
+        const GInt64 *anStep = iTest == 0 ? nullptr : anSubStep;
+        const GPtrDiff_t *anStride = iTest == 0 ? nullptr : anSubStride;
+
+        std::vector<double> adfRef;
+        Read(nullptr, anStart, anCount, anStep, anStride, adfRef);
+        EXPECT_EQ(poArray->m_anReadStarts.size(), 1U);
+
+        std::vector<double> adfThreaded;
+        Read("4", anStart, anCount, anStep, anStride, adfThreaded);
+        EXPECT_EQ(adfThreaded, adfRef);
+        EXPECT_EQ(poArray->m_anReadStarts.size(), 4U);
+        // Each job must start in a different chunk than the last element
+        // of the previous one.
+        const GUInt64 nStep = anStep ? anStep[0] : 1;
+        for (const GUInt64 nStart : poArray->m_anReadStarts)
+        {
+            if (nStart != anStart[0])
+            {
+                EXPECT_NE((nStart - nStep) / 7, nStart / 7);
+            }
+        }
+    }
+}
+
+// Test the chunk cache used by GDALMDArray::Read()
+TEST_F(test_gdal, GDALMDArray_Read_chunk_cache)
+{
+    class CountingArray : public GDALMDArray
+    {
+        GDALExtendedDataType m_dt = GDALExtendedDataType::Create(GDT_Int32);
+        std::vector<std::shared_ptr<GDALDimension>> m_dims{};
+        const std::string m_osEmptyFilename{};
+
+      protected:
+        bool IRead(const GUInt64 *arrayStartIdx, const size_t *count,
+                   const GInt64 *arrayStep, const GPtrDiff_t *bufferStride,
+                   const GDALExtendedDataType &bufferDataType,
+                   void *pDstBuffer) const override
+        {
+            ++m_nIReadCount;
+            for (size_t i = 0; i < count[0]; ++i)
+            {
+                for (size_t j = 0; j < count[1]; ++j)
+                {
+                    for (size_t k = 0; k < count[2]; ++k)
+                    {
+                        const int nVal = static_cast<int>(
+                            (arrayStartIdx[0] + i * arrayStep[0]) * 10000 +
+                            (arrayStartIdx[1] + j * arrayStep[1]) * 100 +
+                            (arrayStartIdx[2] + k * arrayStep[2]));
+                        GDALExtendedDataType::CopyValue(
+                            &nVal, m_dt,
+                            static_cast<GByte *>(pDstBuffer) +
+                                (i * bufferStride[0] + j * bufferStride[1] +
+                                 k * bufferStride[2]) *
+                                    bufferDataType.GetSize(),
+                            bufferDataType);
+                    }
+                }
+            }
+            return true;
+        }
+
+        bool CanUseChunkCache() const override
+        {
+            return true;
+        }
+
+      public:
+        mutable int m_nIReadCount = 0;
+
+        CountingArray()
+            : GDALAbstractMDArray("", "array"), GDALMDArray("", "array")
+        {
+            for (const GUInt64 nSize : {20, 30, 40})
+            {
+                m_dims.emplace_back(
+                    std::make_shared<GDALDimension>("", "", "", "", nSize));
+            }
+        }
+
+        static std::shared_ptr<CountingArray> Create()
+        {
+            auto ar(std::make_shared<CountingArray>());
+            ar->SetSelf(ar);
+            return ar;
+        }
+
+        bool IsWritable() const override
+        {
+            return false;
+        }
+
+        const std::string &GetFilename() const override
+        {
+            return m_osEmptyFilename;
+        }
+
+        const std::vector<std::shared_ptr<GDALDimension>> &
+        GetDimensions() const override
+        {
+            return m_dims;
+        }
+
+        const GDALExtendedDataType &GetDataType() const override
+        {
+            return m_dt;
+        }
+
+        std::vector<GUInt64> GetBlockSize() const override
+        {
+            return {8, 16, 16};
+        }
+    };
+
+    CPLConfigOptionSetter oCacheSize("GDAL_MDARRAY_CHUNK_CACHE_SIZE", "10",
+                                     false);
+    auto poArray = CountingArray::Create();
+
+    // Time series at a point, in reverse order, read as Float64.
+    const GUInt64 anStart[] = {19, 17, 33};
+    const size_t anCount[] = {20, 1, 1};
+    const GInt64 anStep[] = {-1, 1, 1};
+    const auto ReadAndCheck = [&poArray, &anStart, &anCount, &anStep]()
+    {
+        std::vector<double> adfValues(20);
+        EXPECT_TRUE(poArray->Read(anStart, anCount, anStep, nullptr,
+                                  GDALExtendedDataType::Create(GDT_Float64),
+                                  adfValues.data()));
+        for (int i = 0; i < 20; ++i)
+        {
+            EXPECT_EQ(adfValues[i], (19 - i) * 10000 + 17 * 100 + 33);
+        }
+    };
+
+    ReadAndCheck();
+    // 3 chunks along the time dimension.
+    EXPECT_EQ(poArray->m_nIReadCount, 3);
+    ReadAndCheck();
+    EXPECT_EQ(poArray->m_nIReadCount, 3);
+
+    // Neighbouring point in the same chunks, through a view.
+    {
+        auto poView = poArray->GetView("[:,17,34]");
+        ASSERT_TRUE(poView != nullptr);
+        std::vector<int> anValues(20);
+        const GUInt64 nStart = 0;
+        const size_t nCount = 20;
+        EXPECT_TRUE(poView->Read(&nStart, &nCount, nullptr, nullptr,
+                                 GDALExtendedDataType::Create(GDT_Int32),
+                                 anValues.data()));
+        for (int i = 0; i < 20; ++i)
+        {
+            EXPECT_EQ(anValues[i], i * 10000 + 17 * 100 + 34);
+        }
+        EXPECT_EQ(poArray->m_nIReadCount, 3);
+    }
+
+    poArray->ClearChunkCache();
+    ReadAndCheck();
+    EXPECT_EQ(poArray->m_nIReadCount, 6);
+
+    // Strided request spanning several chunks in all dimensions
+    {
+        const GUInt64 anSubStart[] = {1, 2, 39};
+        const size_t anSubCount[] = {7, 10, 13};
+        const GInt64 anSubStep[] = {3, 3, -3};
+        std::vector<int> anValues(7 * 10 * 13);
+        EXPECT_TRUE(poArray->Read(anSubStart, anSubCount, anSubStep, nullptr,
+                                  GDALExtendedDataType::Create(GDT_Int32),
+                                  anValues.data()));
+        int nErrors = 0;
+        for (int i = 0; i < 7; ++i)
+        {
+            for (int j = 0; j < 10; ++j)
+            {
+                for (int k = 0; k < 13; ++k)
+                {
+                    const int nExpected =
+                        (1 + 3 * i) * 10000 + (2 + 3 * j) * 100 + 39 - 3 * k;
+                    if (anValues[(i * 10 + j) * 13 + k] != nExpected)
+                        ++nErrors;
+                }
+            }
+        }
+        EXPECT_EQ(nErrors, 0);
+    }
+
+    // Disabled cache
+    {
+        CPLConfigOptionSetter oNoCache("GDAL_MDARRAY_CHUNK_CACHE_SIZE", "0",
+                                       false);
+        const int nIReadCountBefore = poArray->m_nIReadCount;
+        ReadAndCheck();
+        EXPECT_EQ(poArray->m_nIReadCount, nIReadCountBefore + 1);
+    }
+}
+
+// Test GDALMDArray::GetUnscaled() reading into output types that can hold
+// the raw values in place
+TEST_F(test_gdal, GDALMDArray_GetUnscaled_in_place)
+{
+    GDALDriver *poMEMDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (poMEMDrv == nullptr)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+    auto poDS = std::unique_ptr<GDALDataset>(
+        poMEMDrv->CreateMultiDimensional("", nullptr, nullptr));
+    ASSERT_TRUE(poDS != nullptr);
+    auto poRG = poDS->GetRootGroup();
+    auto poDimY = poRG->CreateDimension("y", std::string(), std::string(), 7);
+    auto poDimX = poRG->CreateDimension("x", std::string(), std::string(), 11);
+    auto poArray = poRG->CreateMDArray(
+        "ar", {poDimY, poDimX}, GDALExtendedDataType::Create(GDT_Int16));
+    ASSERT_TRUE(poArray != nullptr);
+    std::vector<GInt16> anRaw(7 * 11);
+    for (int i = 0; i < 7 * 11; ++i)
+        anRaw[i] = static_cast<GInt16>(i % 13 == 0 ? -1 : i * 3 - 100);
+    const GUInt64 anStart[] = {0, 0};
+    const size_t anCount[] = {7, 11};
+    ASSERT_TRUE(poArray->Write(anStart, anCount, nullptr, nullptr,
+                               GDALExtendedDataType::Create(GDT_Int16),
+                               anRaw.data()));
+    ASSERT_TRUE(poArray->SetNoDataValue(-1.0));
+    ASSERT_TRUE(poArray->SetScale(0.5));
+    ASSERT_TRUE(poArray->SetOffset(10));
+    auto poUnscaled =
+        poArray->GetUnscaled(std::numeric_limits<double>::quiet_NaN(),
+                             std::numeric_limits<double>::quiet_NaN(), -9999.0);
+    ASSERT_TRUE(poUnscaled != nullptr);
+
+    const auto Expected = [&anRaw](size_t iY, size_t iX)
+    {
+        const GInt16 nRaw = anRaw[iY * 11 + iX];
+        return nRaw == -1 ? -9999.0 : nRaw * 0.5 + 10;
+    };
+
+    // Contiguous, transposed and reversed requests, into types of several
+    // sizes.
+    const GInt64 anReverseStep[] = {-1, 1};
+    const GPtrDiff_t anTransposedStride[] = {1, 7};
+    for (const GDALDataType eDT : {GDT_Float32, GDT_Float64, GDT_Int32,
+                                   GDT_Int16, GDT_Byte})
+    {
+        const auto oDT = GDALExtendedDataType::Create(eDT);
+        for (int iTest = 0; iTest < 3; ++iTest)
+        {
+            const GUInt64 anReqStart[] = {iTest == 1 ? 6U : 0U, 0};
+            std::vector<double> adfValues(7 * 11);
+            std::vector<GByte> abyBuffer(7 * 11 * oDT.GetSize());
+            EXPECT_TRUE(poUnscaled->Read(
+                anReqStart, anCount, iTest == 1 ? anReverseStep : nullptr,
+                iTest == 2 ? anTransposedStride : nullptr, oDT,
+                abyBuffer.data()));
+            GDALCopyWords(abyBuffer.data(), eDT,
+                          static_cast<int>(oDT.GetSize()), adfValues.data(),
+                          GDT_Float64, static_cast<int>(sizeof(double)),
+                          7 * 11);
+            int nErrors = 0;
+            for (size_t iY = 0; iY < 7; ++iY)
+            {
+                for (size_t iX = 0; iX < 11; ++iX)
+                {
+                    const size_t iSrcY = iTest == 1 ? 6 - iY : iY;
+                    const size_t iBuf = iTest == 2 ? iX * 7 + iY : iY * 11 + iX;
+                    // Expected value, converted to eDT and back.
+                    const double dfExpected = Expected(iSrcY, iX);
+                    GByte abyExpected[8];
+                    GDALCopyWords(&dfExpected, GDT_Float64, 0, abyExpected,
+                                  eDT, 0, 1);
+                    double dfConvertedExpected = 0;
+                    GDALCopyWords(abyExpected, eDT, 0, &dfConvertedExpected,
+                                  GDT_Float64, 0, 1);
+                    if (adfValues[iBuf] != dfConvertedExpected)
+                        ++nErrors;
+                }
+            }
+            EXPECT_EQ(nErrors, 0) << GDALGetDataTypeName(eDT) << " " << iTest;
+        }
+    }
+}
+
+// Test GDALMDArray::ComputeStatistics() with GDAL_NUM_THREADS
+TEST_F(test_gdal, GDALMDArray_ComputeStatistics_threaded)
+{
+    GDALDriver *poMEMDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (poMEMDrv == nullptr)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+    auto poDS = std::unique_ptr<GDALDataset>(
+        poMEMDrv->CreateMultiDimensional("", nullptr, nullptr));
+    ASSERT_TRUE(poDS != nullptr);
+    auto poRG = poDS->GetRootGroup();
+    auto poDimZ = poRG->CreateDimension("z", std::string(), std::string(), 20);
+    auto poDimY = poRG->CreateDimension("y", std::string(), std::string(), 30);
+    auto poDimX = poRG->CreateDimension("x", std::string(), std::string(), 40);
+    auto poArray =
+        poRG->CreateMDArray("ar", {poDimZ, poDimY, poDimX},
+                            GDALExtendedDataType::Create(GDT_Float32));
+    ASSERT_TRUE(poArray != nullptr);
+    std::vector<float> afValues(20 * 30 * 40);
+    for (size_t i = 0; i < afValues.size(); ++i)
+        afValues[i] = (i % 17 == 0) ? -1.0f : static_cast<float>(i % 1001);
+    const GUInt64 anStart[] = {0, 0, 0};
+    const size_t anCount[] = {20, 30, 40};
+    ASSERT_TRUE(poArray->Write(anStart, anCount, nullptr, nullptr,
+                               GDALExtendedDataType::Create(GDT_Float32),
+                               afValues.data()));
+    ASSERT_TRUE(poArray->SetNoDataValue(-1.0));
+
+    struct Stats
+    {
+        double dfMin = 0;
+        double dfMax = 0;
+        double dfMean = 0;
+        double dfStdDev = 0;
+        GUInt64 nValidCount = 0;
+        double dfLastProgress = 0;
+        bool bProgressMonotonic = true;
+    };
+
+    const auto Compute = [&poArray](const char *pszThreads, Stats &sStats)
+    {
+        CPLConfigOptionSetter oThreads("GDAL_NUM_THREADS", pszThreads, false);
+        // Small chunks, so that there are many of them
+        CPLConfigOptionSetter oSwath("GDAL_SWATH_SIZE", "4000", false);
+        const auto Progress = [](double dfComplete, const char *, void *pData)
+        {
+            auto psStats = static_cast<Stats *>(pData);
+            if (dfComplete < psStats->dfLastProgress)
+                psStats->bProgressMonotonic = false;
+            psStats->dfLastProgress = dfComplete;
+            return TRUE;
+        };
+        EXPECT_TRUE(poArray->ComputeStatistics(
+            false, &sStats.dfMin, &sStats.dfMax, &sStats.dfMean,
+            &sStats.dfStdDev, &sStats.nValidCount, Progress, &sStats,
+            nullptr));
+    };
+
+    Stats sRef;
+    Compute(nullptr, sRef);
+    EXPECT_EQ(sRef.dfMin, 0.0);
+    EXPECT_EQ(sRef.dfMax, 1000.0);
+    EXPECT_EQ(sRef.nValidCount, 24000U - (24000U + 16) / 17);
+
+    Stats sThreaded;
+    Compute("4", sThreaded);
+    EXPECT_EQ(sThreaded.dfMin, sRef.dfMin);
+    EXPECT_EQ(sThreaded.dfMax, sRef.dfMax);
+    EXPECT_NEAR(sThreaded.dfMean, sRef.dfMean, 1e-8 * sRef.dfMean);
+    EXPECT_NEAR(sThreaded.dfStdDev, sRef.dfStdDev, 1e-8 * sRef.dfStdDev);
+    EXPECT_EQ(sThreaded.nValidCount, sRef.nValidCount);
+    EXPECT_TRUE(sThreaded.bProgressMonotonic);
+    EXPECT_EQ(sThreaded.dfLastProgress, 1.0);
+}
+
+// Test GDALDefaultRasterAttributeTable::GetRowsOfValues()
+TEST_F(test_gdal, GDALDefaultRasterAttributeTable_GetRowsOfValues)
+{
+    GDALDefaultRasterAttributeTable oRAT;
+    oRAT.CreateColumn("min", GFT_Real, GFU_Min);
+    oRAT.CreateColumn("max", GFT_Real, GFU_Max);
+    constexpr int ROW_COUNT = 1000;
+    oRAT.SetRowCount(ROW_COUNT);
+    for (int i = 0; i < ROW_COUNT; ++i)
+    {
+        oRAT.SetValue(i, 0, 10.0 * i);
+        oRAT.SetValue(i, 1, 10.0 * i + 9.5);
+    }
+
+    const std::vector<GInt16> anValues{-1, 0, 9, 15, 9999, 10000, 15, 15};
+    std::vector<int> anRows(anValues.size());
+    EXPECT_EQ(oRAT.GetRowsOfValues(anValues.data(), GDT_Int16, anValues.size(),
+                                   anRows.data()),
+              CE_None);
+    EXPECT_EQ(anRows, std::vector<int>({-1, 0, 0, 1, ROW_COUNT - 1, -1, 1, 1}));
+
+    const std::vector<double> adfValues{9.5, 9.75, 10.0, 9989.5, 9989.6};
+    anRows.resize(adfValues.size());
+    EXPECT_EQ(oRAT.GetRowsOfValues(adfValues.data(), GDT_Float64,
+                                   adfValues.size(), anRows.data()),
+              CE_None);
+    EXPECT_EQ(anRows, std::vector<int>({0, -1, 1, ROW_COUNT - 2, -1}));
+
+    // The lookup index is updated after changes
+    oRAT.SetValue(1, 1, 20.0);
+    EXPECT_EQ(oRAT.GetRowOfValue(20.0), 1);
+
+    // Overlapping ranges: the first row applies
+    oRAT.SetValue(2, 0, 5.0);
+    EXPECT_EQ(oRAT.GetRowOfValue(7.0), 0);
+    EXPECT_EQ(oRAT.GetRowOfValue(9.75), 2);
+
+    const GInt16 anComplex[] = {0, 0};
+    CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+    EXPECT_EQ(oRAT.GetRowsOfValues(anComplex, GDT_CInt16, 1, anRows.data()),
+              CE_Failure);
+}
+
 }  // namespace
@@ -2350,6 +2350,88 @@ TEST_F(test_ogr, feature_defn_geomfields_iterator)
     EXPECT_EQ(i, oFDefn.GetGeomFieldCount());
 }
 
+// Test OGRFeature::SetFromStealing()
+TEST_F(test_ogr, feature_SetFromStealing)
+{
+    OGRFeatureDefn *poSrcDefn = new OGRFeatureDefn();
+    poSrcDefn->Reference();
+    {
+        OGRFieldDefn oFieldDefn("str", OFTString);
+        poSrcDefn->AddFieldDefn(&oFieldDefn);
+    }
+    {
+        OGRFieldDefn oFieldDefn("int", OFTInteger);
+        poSrcDefn->AddFieldDefn(&oFieldDefn);
+    }
+    {
+        OGRFieldDefn oFieldDefn("real_list", OFTRealList);
+        poSrcDefn->AddFieldDefn(&oFieldDefn);
+    }
+    {
+        OGRFieldDefn oFieldDefn("str_to_int", OFTString);
+        poSrcDefn->AddFieldDefn(&oFieldDefn);
+    }
+
+    OGRFeatureDefn *poDstDefn = new OGRFeatureDefn();
+    poDstDefn->Reference();
+    {
+        OGRFieldDefn oFieldDefn("int", OFTInteger);
+        poDstDefn->AddFieldDefn(&oFieldDefn);
+    }
+    {
+        OGRFieldDefn oFieldDefn("str", OFTString);
+        poDstDefn->AddFieldDefn(&oFieldDefn);
+    }
+    {
+        OGRFieldDefn oFieldDefn("real_list", OFTRealList);
+        poDstDefn->AddFieldDefn(&oFieldDefn);
+    }
+    {
+        OGRFieldDefn oFieldDefn("str_to_int", OFTInteger);
+        poDstDefn->AddFieldDefn(&oFieldDefn);
+    }
+
+    {
+        OGRFeature oSrc(poSrcDefn);
+        oSrc.SetField(0, "foo");
+        oSrc.SetField(1, 123);
+        const double adfVals[] = {1.5, 2.5};
+        oSrc.SetField(2, 2, adfVals);
+        oSrc.SetField(3, "456");
+        oSrc.SetGeometryDirectly(new OGRPoint(1, 2));
+        const char *pszSrcStr = oSrc.GetFieldAsString(0);
+
+        OGRFeature oDst(poDstDefn);
+        oDst.SetField(1, "to be replaced");
+        const int anMap[] = {1, 0, 2, 3};
+        EXPECT_EQ(oDst.SetFromStealing(&oSrc, anMap), OGRERR_NONE);
+
+        // Values of same type fields owning memory are transferred
+        EXPECT_STREQ(oDst.GetFieldAsString(1), "foo");
+        EXPECT_EQ(oDst.GetFieldAsString(1), pszSrcStr);
+        EXPECT_FALSE(oSrc.IsFieldSet(0));
+        int nCount = 0;
+        const double *padfVals = oDst.GetFieldAsDoubleList(2, &nCount);
+        ASSERT_EQ(nCount, 2);
+        EXPECT_EQ(padfVals[0], 1.5);
+        EXPECT_EQ(padfVals[1], 2.5);
+        EXPECT_FALSE(oSrc.IsFieldSet(2));
+
+        // Others are copied
+        EXPECT_EQ(oDst.GetFieldAsInteger(0), 123);
+        EXPECT_TRUE(oSrc.IsFieldSet(1));
+        EXPECT_EQ(oDst.GetFieldAsInteger(3), 456);
+        EXPECT_TRUE(oSrc.IsFieldSet(3));
+
+        ASSERT_NE(oDst.GetGeometryRef(), nullptr);
+        EXPECT_EQ(oDst.GetGeometryRef()->toPoint()->getY(), 2.0);
+        EXPECT_EQ(oSrc.GetGeometryRef(), nullptr);
+    }
+
+    poSrcDefn->Release();
+    poDstDefn->Release();
+}
+
 // Test GDALDataset QueryLoggerFunc callback
 TEST_F(test_ogr, GDALDatasetSetQueryLoggerFunc)
 {
@@ -29,6 +29,7 @@
 #include "gdal_unit_test.h"
 
 #include "ogr_geometry.h"
+#include "ogr_spatialref.h"
 #include "ogr_wkb.h"
 
 #include "gtest_include.h"
@@ -109,4 +110,416 @@ INSTANTIATE_TEST_SUITE_P(
         OGRWKBFixupCounterClockWiseExternalRingFixture::ParamType> &l_info)
     { return std::get<2>(l_info.param); });
 
+TEST_F(test_ogr_wkb, OGRWKBPolygonColumnarBuffer)
+{
+    const char *const apszWKT[] = {
+        "POLYGON ((0 0,0 10,10 10,10 0,0 0),(1 1,1 2,2 2,2 1,1 1))",
+        "MULTIPOLYGON (((0 0,0 1,1 1,0 0)),((10 10,10 12,12 12,12 10,10 10)))",
+        "POLYGON EMPTY",
+        "MULTIPOLYGON EMPTY",
+        "POLYGON Z ((0 0 5,0 1 6,1 1 7,0 0 5))",
+        "POLYGON M ((0 0 5,0 1 6,1 1 7,0 0 5))",
+    };
+    for (bool bHasZ : {false, true})
+    {
+        for (bool bFloat32 : {false, true})
+        {
+            OGRWKBPolygonColumnarBuffer oBuffer(bHasZ, bFloat32);
+            EXPECT_EQ(oBuffer.HasZ(), bHasZ);
+            EXPECT_EQ(oBuffer.IsFloat32(), bFloat32);
+            for (int iIter = 0; iIter < 2; ++iIter)
+            {
+                oBuffer.Clear();
+                for (const char *pszWKT : apszWKT)
+                {
+                    OGRGeometry *poGeom = nullptr;
+                    OGRGeometryFactory::createFromWkt(pszWKT, nullptr,
+                                                      &poGeom);
+                    ASSERT_TRUE(poGeom != nullptr);
+                    // Alternate byte orders
+                    const auto eByteOrder =
+                        oBuffer.GetGeometryCount() % 2 ? wkbXDR : wkbNDR;
+                    std::vector<GByte> abyWkb(poGeom->WkbSize());
+                    poGeom->exportToWkb(eByteOrder, abyWkb.data(),
+                                        wkbVariantIso);
+                    ASSERT_TRUE(oBuffer.AppendWKB(abyWkb.data(), abyWkb.size()))
+                        << pszWKT;
+                    // Truncated WKB must be rejected without altering the
+                    // buffer
+                    const size_t nPointCount = oBuffer.GetPointCount();
+                    EXPECT_FALSE(
+                        oBuffer.AppendWKB(abyWkb.data(), abyWkb.size() - 1));
+                    EXPECT_EQ(oBuffer.GetPointCount(), nPointCount);
+                    delete poGeom;
+                }
+                ASSERT_EQ(oBuffer.GetGeometryCount(), CPL_ARRAYSIZE(apszWKT));
+                EXPECT_EQ(oBuffer.GetPointCount(), 5 + 5 + 4 + 5 + 4 + 4);
+                EXPECT_EQ(oBuffer.GetGeometryOffsets().size(),
+                          oBuffer.GetGeometryCount() + 1);
+                EXPECT_EQ(oBuffer.GetRingOffsets().back(),
+                          static_cast<int32_t>(oBuffer.GetPointCount()));
+                EXPECT_EQ(oBuffer.GetCoordinatesFloat64() == nullptr,
+                          bFloat32);
+                EXPECT_EQ(oBuffer.GetCoordinatesFloat32() == nullptr,
+                          !bFloat32);
+
+                EXPECT_EQ(oBuffer.GetArea(0), 100 - 1);
+                EXPECT_EQ(oBuffer.GetArea(1), 0.5 + 4);
+                EXPECT_EQ(oBuffer.GetArea(2), 0);
+                EXPECT_EQ(oBuffer.GetArea(CPL_ARRAYSIZE(apszWKT)), 0);
+
+                OGREnvelope sEnvelope;
+                EXPECT_TRUE(oBuffer.GetEnvelope(1, sEnvelope));
+                EXPECT_EQ(sEnvelope.MinX, 0);
+                EXPECT_EQ(sEnvelope.MinY, 0);
+                EXPECT_EQ(sEnvelope.MaxX, 12);
+                EXPECT_EQ(sEnvelope.MaxY, 12);
+                EXPECT_FALSE(oBuffer.GetEnvelope(2, sEnvelope));
+                EXPECT_FALSE(
+                    oBuffer.GetEnvelope(CPL_ARRAYSIZE(apszWKT), sEnvelope));
+
+                for (size_t i = 0; i < CPL_ARRAYSIZE(apszWKT); ++i)
+                {
+                    std::string osExpected(apszWKT[i]);
+                    if (i == 4 && !bHasZ)
+                        osExpected = "POLYGON ((0 0,0 1,1 1,0 0))";
+                    else if (i == 5 && bHasZ)
+                        osExpected = "POLYGON Z ((0 0 0,0 1 0,1 1 0,0 0 0))";
+                    else if (i == 5)
+                        osExpected = "POLYGON ((0 0,0 1,1 1,0 0))";
+                    else if (bHasZ && i == 0)
+                        osExpected = "POLYGON Z ((0 0 0,0 10 0,10 10 0,10 0 "
+                                     "0,0 0 0),(1 1 0,1 2 0,2 2 0,2 1 0,1 1 "
+                                     "0))";
+                    else if (bHasZ && i == 1)
+                        osExpected = "MULTIPOLYGON Z (((0 0 0,0 1 0,1 1 0,0 0 "
+                                     "0)),((10 10 0,10 12 0,12 12 0,12 10 "
+                                     "0,10 10 0)))";
+                    else if (bHasZ && i == 2)
+                        osExpected = "POLYGON Z EMPTY";
+                    else if (bHasZ && i == 3)
+                        osExpected = "MULTIPOLYGON Z EMPTY";
+                    std::unique_ptr<OGRGeometry> poGeom(oBuffer.GetGeometry(i));
+                    ASSERT_TRUE(poGeom != nullptr);
+                    char *pszWKT = nullptr;
+                    poGeom->exportToWkt(&pszWKT, wkbVariantIso);
+                    EXPECT_STREQ(pszWKT, osExpected.c_str());
+                    CPLFree(pszWKT);
+                }
+                EXPECT_TRUE(oBuffer.GetGeometry(CPL_ARRAYSIZE(apszWKT)) ==
+                            nullptr);
+            }
+        }
+    }
+
+    OGRWKBPolygonColumnarBuffer oBuffer;
+    OGRPoint oPoint(1, 2);
+    std::vector<GByte> abyWkb(oPoint.WkbSize());
+    oPoint.exportToWkb(wkbNDR, abyWkb.data());
+    EXPECT_FALSE(oBuffer.AppendWKB(abyWkb.data(), abyWkb.size()));
+    EXPECT_EQ(oBuffer.GetGeometryCount(), 0U);
+}
+
+class OGRWKBIntersectsEnvelopeFixture
+    : public test_ogr_wkb,
+      public ::testing::WithParamInterface<
+          std::tuple<const char *, double, double, double, double, bool,
+                     const char *>>
+{
+  public:
+    static std::vector<std::tuple<const char *, double, double, double,
+                                  double, bool, const char *>>
+    GetTupleValues()
+    {
+        return {
+            std::make_tuple("POINT (1 2)", 0, 0, 10, 10, true, "POINT_IN"),
+            std::make_tuple("POINT (1 2)", 2, 2, 10, 10, false, "POINT_OUT"),
+            std::make_tuple("POINT EMPTY", 0, 0, 10, 10, false, "POINT_EMPTY"),
+            std::make_tuple("LINESTRING (-1 5,11 5)", 0, 0, 10, 10, true,
+                            "LINESTRING_CROSSING"),
+            std::make_tuple("LINESTRING (-1 0,0 -1)", 0, 0, 10, 10, false,
+                            "LINESTRING_NEAR_CORNER"),
+            std::make_tuple("LINESTRING (-1 1,1 -1)", 0, 0, 10, 10, true,
+                            "LINESTRING_TOUCHING_CORNER"),
+            std::make_tuple("MULTILINESTRING ((20 20,30 30),(5 -1,5 11))", 0,
+                            0, 10, 10, true, "MULTILINESTRING"),
+            std::make_tuple("POLYGON ((-1 -1,-1 11,11 11,11 -1,-1 -1))", 0, 0,
+                            10, 10, true, "POLYGON_CONTAINING"),
+            std::make_tuple("POLYGON ((-1 -1,-1 11,11 11,11 -1,-1 -1),(-0.5 "
+                            "-0.5,10.5 -0.5,10.5 10.5,-0.5 10.5,-0.5 -0.5))",
+                            0, 0, 10, 10, false, "POLYGON_HOLE_CONTAINING"),
+            std::make_tuple("POLYGON ((-1 -1,-1 11,11 11,11 -1,-1 -1),(1 "
+                            "1,9 1,9 9,1 9,1 1))",
+                            0, 0, 10, 10, true, "POLYGON_HOLE_INSIDE"),
+            std::make_tuple("POLYGON ((11 0,20 0,20 10,11 0))", 0, 0, 10, 10,
+                            false, "POLYGON_OUTSIDE"),
+            std::make_tuple("POLYGON ((20 -20,20 20,-20 20,20 -20))", 0, 0, 10,
+                            10, true, "POLYGON_CROSSING_NO_VERTEX_INSIDE"),
+            std::make_tuple("MULTIPOLYGON (((11 0,20 0,20 10,11 0)),((-1 "
+                            "-1,-1 11,11 11,11 -1,-1 -1)))",
+                            0, 0, 10, 10, true, "MULTIPOLYGON"),
+            std::make_tuple("GEOMETRYCOLLECTION (POINT (20 20),LINESTRING (-1 "
+                            "5,11 5))",
+                            0, 0, 10, 10, true, "GEOMETRYCOLLECTION"),
+        };
+    }
+};
+
+TEST_P(OGRWKBIntersectsEnvelopeFixture, test)
+{
+    const char *pszInput = std::get<0>(GetParam());
+    OGREnvelope sEnvelope;
+    sEnvelope.MinX = std::get<1>(GetParam());
+    sEnvelope.MinY = std::get<2>(GetParam());
+    sEnvelope.MaxX = std::get<3>(GetParam());
+    sEnvelope.MaxY = std::get<4>(GetParam());
+    const bool bExpected = std::get<5>(GetParam());
+
+    OGRGeometry *poGeom = nullptr;
+    OGRGeometryFactory::createFromWkt(pszInput, nullptr, &poGeom);
+    ASSERT_TRUE(poGeom != nullptr);
+    for (const auto eByteOrder : {wkbNDR, wkbXDR})
+    {
+        std::vector<GByte> abyWkb(poGeom->WkbSize());
+        poGeom->exportToWkb(eByteOrder, abyWkb.data(), wkbVariantIso);
+        bool bIntersects = !bExpected;
+        EXPECT_TRUE(OGRWKBIntersectsEnvelope(abyWkb.data(), abyWkb.size(),
+                                             sEnvelope, bIntersects));
+        EXPECT_EQ(bIntersects, bExpected);
+        EXPECT_FALSE(OGRWKBIntersectsEnvelope(
+            abyWkb.data(), abyWkb.size() - 1, sEnvelope, bIntersects));
+    }
+    delete poGeom;
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    test_ogr_wkb, OGRWKBIntersectsEnvelopeFixture,
+    ::testing::ValuesIn(OGRWKBIntersectsEnvelopeFixture::GetTupleValues()),
+    [](const ::testing::TestParamInfo<
+        OGRWKBIntersectsEnvelopeFixture::ParamType> &l_info)
+    { return std::get<6>(l_info.param); });
+
+TEST_F(test_ogr_wkb, OGRWKBGetLengthAreaCentroid)
+{
+    const struct
+    {
+        const char *pszWKT;
+        double dfLength;
+        double dfArea;
+        double dfCentroidX;
+        double dfCentroidY;
+    } asTests[] = {
+        {"POINT (1 2)", 0, 0, 1, 2},
+        {"MULTIPOINT ((0 0),(2 4))", 0, 0, 1, 2},
+        {"LINESTRING (0 0,3 4,3 10)", 11, 0, 25.5 / 11, 52. / 11},
+        {"POLYGON ((0 0,0 10,10 10,10 0,0 0),(0 0,0 5,5 5,5 0,0 0))", 0, 75,
+         35. / 6, 35. / 6},
+        {"MULTIPOLYGON Z (((0 0 1,10 0 1,10 10 1,0 10 1,0 0 1)),((20 0 "
+         "1,30 0 1,30 10 1,20 10 1,20 0 1)))",
+         0, 200, 15, 5},
+        {"GEOMETRYCOLLECTION (LINESTRING (0 0,2 0),POLYGON ((0 0,0 2,2 2,2 "
+         "0,0 0)))",
+         2, 4, 1, 1},
+    };
+    for (const auto &sTest : asTests)
+    {
+        OGRGeometry *poGeom = nullptr;
+        OGRGeometryFactory::createFromWkt(sTest.pszWKT, nullptr, &poGeom);
+        ASSERT_TRUE(poGeom != nullptr);
+        for (const auto eByteOrder : {wkbNDR, wkbXDR})
+        {
+            std::vector<GByte> abyWkb(poGeom->WkbSize());
+            poGeom->exportToWkb(eByteOrder, abyWkb.data(), wkbVariantIso);
+            double dfLength = -1;
+            EXPECT_TRUE(
+                OGRWKBGetLength(abyWkb.data(), abyWkb.size(), dfLength));
+            EXPECT_NEAR(dfLength, sTest.dfLength, 1e-10) << sTest.pszWKT;
+            double dfArea = -1;
+            EXPECT_TRUE(OGRWKBGetArea(abyWkb.data(), abyWkb.size(), dfArea));
+            EXPECT_NEAR(dfArea, sTest.dfArea, 1e-10) << sTest.pszWKT;
+            double dfX = 0;
+            double dfY = 0;
+            EXPECT_TRUE(
+                OGRWKBGetCentroid(abyWkb.data(), abyWkb.size(), dfX, dfY));
+            EXPECT_NEAR(dfX, sTest.dfCentroidX, 1e-10) << sTest.pszWKT;
+            EXPECT_NEAR(dfY, sTest.dfCentroidY, 1e-10) << sTest.pszWKT;
+        }
+        delete poGeom;
+    }
+
+    {
+        OGRGeometry *poGeom = nullptr;
+        OGRGeometryFactory::createFromWkt("CIRCULARSTRING (0 0,1 1,2 0)",
+                                          nullptr, &poGeom);
+        ASSERT_TRUE(poGeom != nullptr);
+        std::vector<GByte> abyWkb(poGeom->WkbSize());
+        poGeom->exportToWkb(wkbNDR, abyWkb.data(), wkbVariantIso);
+        double dfLength = 0;
+        EXPECT_FALSE(OGRWKBGetLength(abyWkb.data(), abyWkb.size(), dfLength));
+        delete poGeom;
+    }
+}
+
+class OffsetCoordinateTransformation final
+    : public OGRCoordinateTransformation
+{
+  public:
+    const OGRSpatialReference *GetSourceCS() const override
+    {
+        return nullptr;
+    }
+
+    const OGRSpatialReference *GetTargetCS() const override
+    {
+        return nullptr;
+    }
+
+    int m_nCalls = 0;
+
+    // Points whose X is FAILING_X fail to transform
+    static constexpr double FAILING_X = -999;
+
+    int Transform(int nCount, double *x, double *y, double *z,
+                  double * /* t */, int *pabSuccess) override
+    {
+        ++m_nCalls;
+        int bRet = TRUE;
+        for (int i = 0; i < nCount; ++i)
+        {
+            const bool bOK = x[i] != FAILING_X;
+            if (bOK)
+            {
+                x[i] += 100;
+                y[i] += 200;
+                if (z)
+                    z[i] += 300;
+            }
+            else
+            {
+                bRet = FALSE;
+            }
+            if (pabSuccess)
+                pabSuccess[i] = bOK;
+        }
+        return bRet;
+    }
+
+    OGRCoordinateTransformation *Clone() const override
+    {
+        return new OffsetCoordinateTransformation();
+    }
+
+    OGRCoordinateTransformation *GetInverse() const override
+    {
+        return nullptr;
+    }
+};
+
+TEST_F(test_ogr_wkb, OGRWKBTransform)
+{
+    const char *const apszWKT[] = {
+        "POINT (1 2)",
+        "POINT EMPTY",
+        "LINESTRING M (1 2 3,4 5 6)",
+        "POLYGON ZM ((0 0 1 2,0 1 1 2,1 1 1 2,0 0 1 2))",
+        "GEOMETRYCOLLECTION (MULTIPOINT ((1 2)),MULTILINESTRING ((1 2,3 "
+        "4)),MULTIPOLYGON (((0 0,0 1,1 1,0 0))))",
+    };
+    OffsetCoordinateTransformation oCT;
+    for (const char *pszWKT : apszWKT)
+    {
+        OGRGeometry *poGeom = nullptr;
+        OGRGeometryFactory::createFromWkt(pszWKT, nullptr, &poGeom);
+        ASSERT_TRUE(poGeom != nullptr);
+        for (const auto eByteOrder : {wkbNDR, wkbXDR})
+        {
+            std::vector<GByte> abyWkb(poGeom->WkbSize());
+            poGeom->exportToWkb(eByteOrder, abyWkb.data(), wkbVariantIso);
+            EXPECT_TRUE(OGRWKBTransform(abyWkb.data(), abyWkb.size(), &oCT));
+
+            std::unique_ptr<OGRGeometry> poExpected(poGeom->clone());
+            poExpected->transform(&oCT);
+            OGRGeometry *poGot = nullptr;
+            OGRGeometryFactory::createFromWkb(abyWkb.data(), nullptr, &poGot);
+            ASSERT_TRUE(poGot != nullptr);
+            char *pszGot = nullptr;
+            poGot->exportToWkt(&pszGot, wkbVariantIso);
+            char *pszExpected = nullptr;
+            poExpected->exportToWkt(&pszExpected, wkbVariantIso);
+            EXPECT_STREQ(pszGot, pszExpected);
+            CPLFree(pszGot);
+            CPLFree(pszExpected);
+            delete poGot;
+        }
+        delete poGeom;
+    }
+}
+
+TEST_F(test_ogr_wkb, OGRWKBTransformBatch)
+{
+    const char *const apszWKT[] = {
+        "POINT (1 2)",
+        nullptr,
+        "LINESTRING Z (1 2 3,4 5 6)",
+        "CIRCULARSTRING (0 0,1 1,2 0)",
+        "LINESTRING (1 2,-999 5)",
+        "POLYGON ((0 0,0 1,1 1,0 0))",
+    };
+    constexpr size_t N = CPL_ARRAYSIZE(apszWKT);
+    const int abExpectedSuccess[N] = {TRUE, TRUE, TRUE, FALSE, FALSE, TRUE};
+    std::vector<std::unique_ptr<OGRGeometry>> apoGeoms;
+    std::vector<std::vector<GByte>> aabyWkb;
+    std::vector<GByte *> apabyWkb;
+    std::vector<size_t> anWKBSize;
+    for (size_t i = 0; i < N; ++i)
+    {
+        OGRGeometry *poGeom = nullptr;
+        if (apszWKT[i])
+        {
+            OGRGeometryFactory::createFromWkt(apszWKT[i], nullptr, &poGeom);
+            ASSERT_TRUE(poGeom != nullptr);
+        }
+        apoGeoms.emplace_back(poGeom);
+        aabyWkb.emplace_back(poGeom ? poGeom->WkbSize() : 0);
+        if (poGeom)
+            poGeom->exportToWkb((i % 2) == 0 ? wkbNDR : wkbXDR,
+                                aabyWkb.back().data(), wkbVariantIso);
+    }
+    for (auto &abyWkb : aabyWkb)
+    {
+        apabyWkb.push_back(abyWkb.empty() ? nullptr : abyWkb.data());
+        anWKBSize.push_back(abyWkb.size());
+    }
+
+    OffsetCoordinateTransformation oCT;
+    int abSuccess[N] = {0};
+    EXPECT_TRUE(OGRWKBTransformBatch(apabyWkb.data(), anWKBSize.data(), N,
+                                     &oCT, abSuccess));
+    EXPECT_EQ(oCT.m_nCalls, 1);
+    for (size_t i = 0; i < N; ++i)
+    {
+        EXPECT_EQ(abSuccess[i], abExpectedSuccess[i]) << i;
+        if (!apoGeoms[i])
+            continue;
+        std::unique_ptr<OGRGeometry> poExpected(apoGeoms[i]->clone());
+        if (abExpectedSuccess[i])
+            poExpected->transform(&oCT);
+        OGRGeometry *poGot = nullptr;
+        OGRGeometryFactory::createFromWkb(apabyWkb[i], nullptr, &poGot);
+        ASSERT_TRUE(poGot != nullptr);
+        char *pszGot = nullptr;
+        poGot->exportToWkt(&pszGot, wkbVariantIso);
+        char *pszExpected = nullptr;
+        poExpected->exportToWkt(&pszExpected, wkbVariantIso);
+        EXPECT_STREQ(pszGot, pszExpected);
+        CPLFree(pszGot);
+        CPLFree(pszExpected);
+        delete poGot;
+    }
+
+    // Without pabSuccess, failure of one geometry is a global failure
+    EXPECT_FALSE(OGRWKBTransformBatch(apabyWkb.data(), anWKBSize.data(), N,
+                                      &oCT, nullptr));
+}
+
 }  // namespace
@@ -30,11 +30,16 @@
 
 #include "cpl_error.h"
 #include "cpl_string.h"
+#include "gdal_alg.h"
 #include "gdal_priv.h"
 #include "gdal_utils.h"
 
 #include "gtest_include.h"
 
+#include <cstring>
+#include <memory>
+#include <vector>
+
 namespace
 {
 
@@ -108,4 +113,101 @@ TEST_F(test_utilities, GDALFootprint)
     }
 }
 
+TEST_F(test_utilities, GDALDEMProcessingMulti)
+{
+    auto poMemDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!poMemDrv)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+
+    constexpr int nXSize = 67;
+    constexpr int nYSize = 45;
+    auto poSrcDS = std::unique_ptr<GDALDataset>(
+        poMemDrv->Create("", nXSize, nYSize, 1, GDT_Int16, nullptr));
+    double adfGeoTransform[6] = {0, 10, 0, 0, 0, -10};
+    poSrcDS->SetGeoTransform(adfGeoTransform);
+    std::vector<GInt16> anValues(nXSize * nYSize);
+    for (int i = 0; i < nYSize; i++)
+    {
+        for (int j = 0; j < nXSize; j++)
+        {
+            anValues[i * nXSize + j] =
+                static_cast<GInt16>((i * 37 + j * 11 + i * j) % 500);
+        }
+    }
+    anValues[10 * nXSize + 20] = -32768;
+    poSrcDS->GetRasterBand(1)->SetNoDataValue(-32768);
+    ASSERT_EQ(poSrcDS->GetRasterBand(1)->RasterIO(
+                  GF_Write, 0, 0, nXSize, nYSize, anValues.data(), nXSize,
+                  nYSize, GDT_Int16, 0, 0, nullptr),
+              CE_None);
+
+    const char *pszColorFile = "/vsimem/test_gdaldem_multi.txt";
+    const char *pszColors = "nv 0 0 0 0\n0 0 0 255\n250 0 255 0\n500 255 0 0\n";
+    VSIFCloseL(VSIFileFromMemBuffer(
+        pszColorFile,
+        reinterpret_cast<GByte *>(const_cast<char *>(pszColors)),
+        strlen(pszColors), false));
+
+    CPLStringList aosArgv;
+    aosArgv.AddString("-of");
+    aosArgv.AddString("MEM");
+    aosArgv.AddString("-compute_edges");
+    auto psOptions = GDALDEMProcessingOptionsNew(aosArgv.List(), nullptr);
+    const char *const apszDests[] = {"", "", "", ""};
+    const char *const apszProcessings[] = {"hillshade", "slope", "color-relief",
+                                           "aspect"};
+    const char *const apszColorFiles[] = {nullptr, nullptr, pszColorFile,
+                                          nullptr};
+    const GDALDEMProcessingOptions *const apsOptions[] = {
+        psOptions, psOptions, psOptions, psOptions};
+    GDALDatasetH ahDstDS[4] = {nullptr, nullptr, nullptr, nullptr};
+    EXPECT_TRUE(GDALDEMProcessingMulti(
+        4, apszDests, GDALDataset::ToHandle(poSrcDS.get()), apszProcessings,
+        apszColorFiles, apsOptions, ahDstDS, nullptr));
+
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_NE(ahDstDS[i], nullptr);
+        GDALDatasetH hExpectedDS = GDALDEMProcessing(
+            "", GDALDataset::ToHandle(poSrcDS.get()), apszProcessings[i],
+            apszColorFiles[i], psOptions, nullptr);
+        ASSERT_NE(hExpectedDS, nullptr);
+        ASSERT_EQ(GDALGetRasterCount(ahDstDS[i]),
+                  GDALGetRasterCount(hExpectedDS));
+        for (int iBand = 1; iBand <= GDALGetRasterCount(hExpectedDS); iBand++)
+        {
+            EXPECT_EQ(GDALChecksumImage(GDALGetRasterBand(ahDstDS[i], iBand),
+                                        0, 0, nXSize, nYSize),
+                      GDALChecksumImage(GDALGetRasterBand(hExpectedDS, iBand),
+                                        0, 0, nXSize, nYSize))
+                << apszProcessings[i] << " band " << iBand;
+        }
+        GDALClose(hExpectedDS);
+        GDALClose(ahDstDS[i]);
+    }
+
+    // Processings using different bands are not supported
+    {
+        CPLStringList aosArgv2;
+        aosArgv2.AddString("-b");
+        aosArgv2.AddString("2");
+        auto psOptions2 = GDALDEMProcessingOptionsNew(aosArgv2.List(), nullptr);
+        const GDALDEMProcessingOptions *const apsOptions2[] = {psOptions,
+                                                               psOptions2};
+        CPLErrorHandlerPusher oQuietErrors(CPLQuietErrorHandler);
+        int bUsageError = FALSE;
+        EXPECT_FALSE(GDALDEMProcessingMulti(
+            2, apszDests, GDALDataset::ToHandle(poSrcDS.get()),
+            apszProcessings, nullptr, apsOptions2, ahDstDS, &bUsageError));
+        EXPECT_TRUE(bUsageError);
+        EXPECT_EQ(ahDstDS[0], nullptr);
+        GDALDEMProcessingOptionsFree(psOptions2);
+    }
+
+    GDALDEMProcessingOptionsFree(psOptions);
+    VSIUnlink(pszColorFile);
+}
+
 }  // namespace
@@ -32,6 +32,7 @@
 
 #include <cstdint>
 #include <iostream>
+#include <limits>
 
 #include "gtest_include.h"
 
@@ -788,6 +789,55 @@ void CheckPacked<GUInt16, GInt16>(GDALDataType eIn, GDALDataType eOut)
     }
 }
 
+template <>
+void CheckPacked<float, GByte>(GDALDataType eIn, GDALDataType eOut)
+{
+    CheckPackedGeneric<float, GByte>(eIn, eOut);
+
+    const int N = 64 + 7;
+    float arrayIn[N] = {0};
+    GByte arrayOut[N] = {0};
+    for (int i = 0; i < N; i++)
+    {
+        arrayIn[i] = (i % 6) == 0   ? -1.5f
+                     : (i % 6) == 1 ? 0.49f
+                     : (i % 6) == 2 ? 1.5f
+                     : (i % 6) == 3 ? 254.5f
+                     : (i % 6) == 4 ? 1e10f
+                                    : std::numeric_limits<float>::quiet_NaN();
+    }
+    GDALCopyWords(arrayIn, eIn, GDALGetDataTypeSizeBytes(eIn), arrayOut, eOut,
+                  GDALGetDataTypeSizeBytes(eOut), N);
+    for (int i = 0; i < N; i++)
+    {
+        const int expected = (i % 6) == 2   ? 2
+                             : (i % 6) == 3 ? 255
+                             : (i % 6) == 4 ? 255
+                                            : 0;
+        EXPECT_EQ(arrayOut[i], expected) << "i=" << i;
+    }
+}
+
+template <>
+void CheckPacked<GInt16, float>(GDALDataType eIn, GDALDataType eOut)
+{
+    CheckPackedGeneric<GInt16, float>(eIn, eOut);
+
+    const int N = 64 + 7;
+    GInt16 arrayIn[N] = {0};
+    float arrayOut[N] = {0};
+    for (int i = 0; i < N; i++)
+    {
+        arrayIn[i] = static_cast<GInt16>((i % 2) == 0 ? -32768 + i : -i);
+    }
+    GDALCopyWords(arrayIn, eIn, GDALGetDataTypeSizeBytes(eIn), arrayOut, eOut,
+                  GDALGetDataTypeSizeBytes(eOut), N);
+    for (int i = 0; i < N; i++)
+    {
+        EXPECT_EQ(arrayOut[i], static_cast<float>(arrayIn[i])) << "i=" << i;
+    }
+}
+
 template <class Tin> void CheckPacked(GDALDataType eIn, GDALDataType eOut)
 {
     switch (eOut)
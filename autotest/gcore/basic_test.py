@@ -917,7 +917,65 @@ def test_checksum_more_than_2billion_pixels():
     gdal.Unlink(filename)
 
 
+@pytest.mark.parametrize(
+    "dt", [gdal.GDT_Byte, gdal.GDT_Int16, gdal.GDT_Float32, gdal.GDT_CFloat64]
+)
+def test_checksum_num_threads(dt):
+
+    src_ds = gdal.Open("data/byte.tif")
+    ds = gdal.Translate(
+        "", src_ds, format="MEM", outputType=dt, scaleParams=[[0, 255, -1000, 1000]]
+    )
+    # Blocks of 7 lines, so that several chunks are processed
+    ds = gdal.Translate(
+        "/vsimem/test_checksum_num_threads.tif",
+        ds,
+        creationOptions=["BLOCKYSIZE=7"],
+    )
+    ref_cs = [
+        ds.GetRasterBand(1).Checksum(),
+        ds.GetRasterBand(1).Checksum(1, 2, 15, 17),
+    ]
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        assert [
+            ds.GetRasterBand(1).Checksum(),
+            ds.GetRasterBand(1).Checksum(1, 2, 15, 17),
+        ] == ref_cs
+    ds = None
+    gdal.Unlink("/vsimem/test_checksum_num_threads.tif")
+
+
 def test_tmp_vsimem(tmp_vsimem):
     assert isinstance(tmp_vsimem, os.PathLike)
 
     assert gdal.VSIStatL(tmp_vsimem) is not None
+
+
+###############################################################################
+# Test GDAL_OPEN_EXTENSION_FAST_PATH
+
+
+@pytest.mark.require_driver("ESRI Shapefile")
+def test_basic_test_open_extension_fast_path(tmp_vsimem):
+
+    with gdal.config_option("GDAL_OPEN_EXTENSION_FAST_PATH", "YES"):
+        ds = gdal.Open("data/byte.tif")
+        assert ds.GetDriver().ShortName == "GTiff"
+
+        ds = gdal.OpenEx("../ogr/data/poly.shp", gdal.OF_VECTOR)
+        assert ds.GetDriver().ShortName == "ESRI Shapefile"
+
+        # File whose extension does not match its content
+        gdal.FileFromMemBuffer(
+            tmp_vsimem / "byte.shp", open("data/byte.tif", "rb").read()
+        )
+        ds = gdal.Open(tmp_vsimem / "byte.shp")
+        assert ds.GetDriver().ShortName == "GTiff"
+
+        # Allowed drivers are honoured
+        assert (
+            gdal.OpenEx(
+                "../ogr/data/poly.shp", gdal.OF_VECTOR, allowed_drivers=["GPKG"]
+            )
+            is None
+        )
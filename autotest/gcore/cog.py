@@ -29,6 +29,7 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import os
 import struct
 import sys
 
@@ -408,6 +409,84 @@ def test_cog_creation_of_overviews_with_mask():
     gdal.Unlink(directory)
 
 
+###############################################################################
+# Test creation of temporary files in memory with COG_TMP_MEMORY_MAX_SIZE
+
+
+@pytest.mark.parametrize("max_size,expect_tmp_on_disk", [("0", True), ("1e9", False)])
+def test_cog_tmp_memory_max_size(tmp_path, max_size, expect_tmp_on_disk):
+
+    filename = str(tmp_path / "cog.tif")
+    src_ds = gdal.Translate("", "data/byte.tif", options="-of MEM -outsize 2048 300")
+    src_ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+    src_ds.GetRasterBand(1).GetMaskBand().WriteRaster(
+        0, 0, 1024, 300, b"\xFF", buf_xsize=1, buf_ysize=1
+    )
+
+    tmp_files_seen = set()
+
+    def my_cbk(pct, _, arg):
+        for f in os.listdir(tmp_path):
+            if f.endswith(".tmp"):
+                tmp_files_seen.add(f)
+        return 1
+
+    with gdaltest.config_option("COG_TMP_MEMORY_MAX_SIZE", max_size):
+        ds = gdal.GetDriverByName("COG").CreateCopy(filename, src_ds, callback=my_cbk)
+    assert ds
+    assert (len(tmp_files_seen) != 0) == expect_tmp_on_disk
+    assert os.listdir(tmp_path) == ["cog.tif"]
+
+    ds = None
+    ds = gdal.Open(filename)
+    assert ds.GetRasterBand(1).Checksum() == src_ds.GetRasterBand(1).Checksum()
+    assert ds.GetRasterBand(1).GetOverviewCount() == 2
+    assert ds.GetRasterBand(1).GetMaskBand().GetOverviewCount() == 2
+    ds = None
+    _check_cog(filename)
+
+
+###############################################################################
+# Test that multi-threaded creation gives the same result as the
+# single-threaded one
+
+
+def test_cog_num_threads_same_result(tmp_vsimem):
+
+    src_ds = gdal.Translate(
+        "", "data/rgbsmall.tif", options="-of MEM -outsize 1500 700 -r bilinear"
+    )
+    src_ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+    src_ds.GetRasterBand(1).GetMaskBand().WriteRaster(
+        0, 0, 1000, 700, b"\xFF", buf_xsize=1, buf_ysize=1
+    )
+
+    def get_checksums(filename):
+        ds = gdal.Open(filename)
+        ret = []
+        for i in range(ds.RasterCount):
+            band = ds.GetRasterBand(i + 1)
+            ret.append(band.Checksum())
+            ret.append(band.GetMaskBand().Checksum())
+            for j in range(band.GetOverviewCount()):
+                ret.append(band.GetOverview(j).Checksum())
+                ret.append(band.GetOverview(j).GetMaskBand().Checksum())
+        return ret
+
+    ref_filename = str(tmp_vsimem / "ref.tif")
+    gdal.GetDriverByName("COG").CreateCopy(
+        ref_filename, src_ds, options=["COMPRESS=DEFLATE", "BLOCKSIZE=256"]
+    )
+    filename = str(tmp_vsimem / "test.tif")
+    gdal.GetDriverByName("COG").CreateCopy(
+        filename,
+        src_ds,
+        options=["COMPRESS=DEFLATE", "BLOCKSIZE=256", "NUM_THREADS=4"],
+    )
+    _check_cog(filename)
+    assert get_checksums(filename) == get_checksums(ref_filename)
+
+
 ###############################################################################
 # Test MAX_Z_ERROR_OVERVIEW creation option
 
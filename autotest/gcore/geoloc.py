@@ -137,6 +137,65 @@ def test_geoloc_fill_line(use_temp_datasets):
         )  # 22336 with Intel(R) oneAPI DPC++/C++ Compiler 2022.1.0
 
 
+###############################################################################
+# Test GDAL_GEOLOC_BACKMAP_CACHE_DIR
+
+
+@pytest.mark.parametrize("use_temp_datasets", ["YES", "NO"])
+def test_geoloc_backmap_cache_dir(use_temp_datasets):
+
+    ds = gdal.GetDriverByName("MEM").Create("", 200, 372)
+    md = {
+        "LINE_OFFSET": "0",
+        "LINE_STEP": "1",
+        "PIXEL_OFFSET": "0",
+        "PIXEL_STEP": "1",
+        "X_DATASET": "../alg/data/geoloc/longitude_including_pole.tif",
+        "X_BAND": "1",
+        "Y_DATASET": "../alg/data/geoloc/latitude_including_pole.tif",
+        "Y_BAND": "1",
+    }
+    ds.SetMetadata(md, "GEOLOCATION")
+    ds.GetRasterBand(1).Fill(1)
+
+    with gdaltest.config_option("GDAL_GEOLOC_USE_TEMP_DATASETS", use_temp_datasets):
+        ref_cs = gdal.Warp("", ds, format="MEM").GetRasterBand(1).Checksum()
+
+    cache_dir = "/vsimem/test_geoloc_backmap_cache_dir"
+    gdal.Mkdir(cache_dir, 0o755)
+    try:
+        with gdaltest.config_options(
+            {
+                "GDAL_GEOLOC_USE_TEMP_DATASETS": use_temp_datasets,
+                "GDAL_GEOLOC_BACKMAP_CACHE_DIR": cache_dir,
+            }
+        ):
+            # Creates the cache file
+            warped_ds = gdal.Warp("", ds, format="MEM")
+            assert warped_ds.GetRasterBand(1).Checksum() == ref_cs
+            files = gdal.ReadDir(cache_dir)
+            assert len(files) == 1
+            assert files[0].startswith("geoloc_backmap_")
+            assert files[0].endswith(".bin")
+            cache_filename = cache_dir + "/" + files[0]
+            cache_size = gdal.VSIStatL(cache_filename).size
+
+            # Uses the cache file
+            warped_ds = gdal.Warp("", ds, format="MEM")
+            assert warped_ds.GetRasterBand(1).Checksum() == ref_cs
+
+            # Truncated cache file is ignored and rewritten
+            f = gdal.VSIFOpenL(cache_filename, "rb+")
+            gdal.VSIFTruncateL(f, cache_size // 2)
+            gdal.VSIFCloseL(f)
+            warped_ds = gdal.Warp("", ds, format="MEM")
+            assert warped_ds.GetRasterBand(1).Checksum() == ref_cs
+            assert gdal.ReadDir(cache_dir) == files
+            assert gdal.VSIStatL(cache_filename).size == cache_size
+    finally:
+        gdal.RmdirRecursive(cache_dir)
+
+
 ###############################################################################
 # Test warping from rectified to referenced-by-geoloc
 
@@ -29,6 +29,7 @@
 ###############################################################################
 
 import math
+import re
 
 import gdaltest
 import pytest
@@ -1464,4 +1465,163 @@ def test_pixfun_max_no_nodata():
     assert ar[10][12] == 255
 
 
+###############################################################################
+# Verify the expression pixel function
+
+
+def expression_vrt(expression, filename="data/float32.tif", size=20):
+
+    sources = "".join(
+        f"""
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">{filename}</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="0" yOff="0" xSize="{size - i}" ySize="{size}" />
+      <DstRect xOff="{i}" yOff="0" xSize="{size - i}" ySize="{size}" />
+    </SimpleSource>"""
+        for i in range(2)
+    )
+    return f"""<VRTDataset rasterXSize="{size}" rasterYSize="{size}">
+  <VRTRasterBand dataType="Float64" band="1" subClass="VRTDerivedRasterBand">
+    <PixelFunctionType>expression</PixelFunctionType>
+    <PixelFunctionArguments expression="{expression}" />
+    <SourceTransferType>Float64</SourceTransferType>{sources}
+  </VRTRasterBand>
+</VRTDataset>"""
+
+
+def expression_ref_data(filename="data/float32.tif"):
+
+    ref = gdal.Open(filename).GetRasterBand(1).ReadAsArray().astype("float64")
+    b2 = numpy.zeros(ref.shape)
+    b2[:, 1:] = ref[:, :-1]
+    return ref, b2
+
+
+@pytest.mark.parametrize(
+    "expression,func",
+    [
+        ("(B1 - B2) / (B1 + B2)", lambda b1, b2: (b1 - b2) / (b1 + b2)),
+        ("B1 * 2.5 + -B2 ^ 2", lambda b1, b2: b1 * 2.5 - b2**2),
+        ("B1 &gt; 130 ? B1 : B2", lambda b1, b2: numpy.where(b1 > 130, b1, b2)),
+        (
+            "(B1 &lt;= B2) &amp;&amp; !(B2 == 0)",
+            lambda b1, b2: (b1 <= b2) & (b2 != 0),
+        ),
+        (
+            "sqrt(abs(B1 - B2)) + min(B1, B2, 140)",
+            lambda b1, b2: numpy.sqrt(numpy.abs(b1 - b2))
+            + numpy.minimum(numpy.minimum(b1, b2), 140),
+        ),
+        (
+            "atan2(B2, B1) * 180 / pi",
+            lambda b1, b2: numpy.degrees(numpy.arctan2(b2, b1)),
+        ),
+        ("B2 % 7", lambda b1, b2: numpy.fmod(b2, 7)),
+        ("2 * 3 + 1", lambda b1, b2: numpy.full(b1.shape, 7.0)),
+    ],
+)
+def test_pixfun_expression(expression, func):
+
+    ds = gdal.Open(expression_vrt(expression))
+    with numpy.errstate(divide="ignore", invalid="ignore"):
+        ref = func(*expression_ref_data())
+    assert numpy.allclose(ds.GetRasterBand(1).ReadAsArray(), ref, equal_nan=True)
+
+
+def test_pixfun_expression_multithreaded(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "src.tif")
+    src_ds = gdal.GetDriverByName("GTiff").Create(filename, 512, 512)
+    src_ds.GetRasterBand(1).WriteArray(
+        numpy.arange(512 * 512, dtype=numpy.uint8).reshape(512, 512)
+    )
+    src_ds = None
+
+    ds = gdal.Open(expression_vrt("B1 * B2 - B1", filename=filename, size=512))
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        data = ds.GetRasterBand(1).ReadAsArray()
+    b1, b2 = expression_ref_data(filename)
+    assert numpy.array_equal(data, b1 * b2 - b1)
+
+
+@pytest.mark.parametrize(
+    "expression,error",
+    [
+        ("B1 +", "Unexpected end"),
+        ("B1 $ B2", "Unexpected character"),
+        ("foo(B1)", "Unknown identifier"),
+        ("sqrt(B1, B2)", "Wrong number of arguments for sqrt()"),
+        ("(B1", "Expected ')'"),
+        ("B3", "references B3, but there are only 2 sources"),
+    ],
+)
+def test_pixfun_expression_errors(expression, error):
+
+    ds = gdal.Open(expression_vrt(expression))
+    with pytest.raises(Exception, match=re.escape(error)):
+        ds.GetRasterBand(1).ReadAsArray()
+
+
+###############################################################################
+# Verify built-in pixel functions on the various real source data types, and
+# when their evaluation is split in groups of lines evaluated concurrently
+
+
+@pytest.mark.parametrize(
+    "src_type", ["Byte", "Int8", "UInt16", "Int16", "UInt32", "Float32", "Float64"]
+)
+@pytest.mark.parametrize("num_threads", [None, "4"])
+@pytest.mark.parametrize(
+    "pixfn,args,func",
+    [
+        ("sum", 'k="1.5"', lambda a, b: a + b + 1.5),
+        ("mul", "", lambda a, b: a * b),
+        ("mod", None, lambda a, b: numpy.abs(a)),
+        ("pow", 'power="0.5"', lambda a, b: numpy.sqrt(a)),
+        ("scale", "", lambda a, b: a * 2 + 3),
+        (
+            "interpolate_linear",
+            't0="0" dt="1" t="0.25"',
+            lambda a, b: a + 0.25 * (b - a),
+        ),
+    ],
+)
+def test_pixfun_real_types(tmp_vsimem, src_type, num_threads, pixfn, args, func):
+
+    size = 512
+    filename = str(tmp_vsimem / "src.tif")
+    src_ds = gdal.GetDriverByName("GTiff").Create(
+        filename, size, size, 2, gdal.GetDataTypeByName(src_type)
+    )
+    a = numpy.arange(size * size).reshape(size, size) % 101
+    src_ds.GetRasterBand(1).WriteArray(a)
+    src_ds.GetRasterBand(2).WriteArray(a[::-1])
+    src_ds = None
+
+    nsources = 1 if pixfn in ("mod", "pow", "scale") else 2
+    sources = "".join(
+        f"""
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">{filename}</SourceFilename>
+      <SourceBand>{i + 1}</SourceBand>
+    </SimpleSource>"""
+        for i in range(nsources)
+    )
+    vrt_ds = gdal.Open(
+        f"""<VRTDataset rasterXSize="{size}" rasterYSize="{size}">
+  <VRTRasterBand dataType="Float64" band="1" subClass="VRTDerivedRasterBand">
+    <PixelFunctionType>{pixfn}</PixelFunctionType>
+    {"<PixelFunctionArguments %s />" % args if args else ""}
+    <SourceTransferType>{src_type}</SourceTransferType>
+    <Scale>2</Scale>
+    <Offset>3</Offset>{sources}
+  </VRTRasterBand>
+</VRTDataset>"""
+    )
+    with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+        data = vrt_ds.GetRasterBand(1).ReadAsArray()
+    assert numpy.allclose(data, func(a.astype("float64"), a[::-1].astype("float64")))
+
+
 ###############################################################################
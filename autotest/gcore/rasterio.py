@@ -3189,3 +3189,46 @@ def test_rasterio_constant_value(resample_alg, dt, struct_type, val):
     assert struct.unpack(struct_type * (2 * 2), data) == pytest.approx(
         (val, val, val, val), rel=1e-14
     )
+
+
+###############################################################################
+# Test GDALDatasetCopyWholeRaster() reading swaths in parallel
+
+
+@pytest.mark.require_driver("GTiff")
+@pytest.mark.parametrize("interleave", ["BAND", "PIXEL"])
+def test_rasterio_copy_whole_raster_parallel(tmp_vsimem, interleave):
+
+    src_filename = str(tmp_vsimem / "src.tif")
+    src_ds = gdal.Translate(
+        src_filename,
+        "data/rgbsmall.tif",
+        width=2000,
+        height=2000,
+        creationOptions=["TILED=YES", "INTERLEAVE=" + interleave],
+    )
+    expected_cs = [src_ds.GetRasterBand(i + 1).Checksum() for i in range(3)]
+    src_ds = None
+
+    src_ds = gdal.Open(src_filename)
+    with gdaltest.config_options(
+        {"GDAL_NUM_THREADS": "4", "GDAL_SWATH_SIZE": "4000000"}
+    ):
+        tab_pct = [0]
+
+        def progress(pct, msg, user_data):
+            tab_pct[0] = pct
+            return 1
+
+        out_ds = gdal.GetDriverByName("MEM").CreateCopy("", src_ds, callback=progress)
+    assert [out_ds.GetRasterBand(i + 1).Checksum() for i in range(3)] == expected_cs
+    assert tab_pct[0] == 1.0
+
+    # Interruption by the progress callback
+    with gdaltest.config_options(
+        {"GDAL_NUM_THREADS": "4", "GDAL_SWATH_SIZE": "4000000"}
+    ):
+        with pytest.raises(Exception, match="User terminated"):
+            gdal.GetDriverByName("MEM").CreateCopy(
+                "", src_ds, callback=lambda pct, msg, user_data: pct < 0.5
+            )
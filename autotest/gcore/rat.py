@@ -178,3 +178,28 @@ def test_rat_4():
 
 
 ##############################################################################
+
+
+###############################################################################
+# Test GetRowOfValue() on a large table with a MinMax column
+
+
+def test_rat_get_row_of_value_minmax():
+
+    rat = gdal.RasterAttributeTable()
+    rat.CreateColumn("VALUE", gdal.GFT_Integer, gdal.GFU_MinMax)
+    rat.SetRowCount(10000)
+    for i in range(10000):
+        rat.SetValueAsInt(i, 0, 2 * i)
+    rat.SetValueAsInt(5000, 0, 2)
+
+    assert rat.GetRowOfValue(0) == 0
+    assert rat.GetRowOfValue(1) == -1
+    assert rat.GetRowOfValue(2) == 1
+    assert rat.GetRowOfValue(19998) == 9999
+    assert rat.GetRowOfValue(10000) == -1
+
+    # Check that the lookup takes into account later changes
+    rat.SetValueAsInt(0, 0, 10000)
+    assert rat.GetRowOfValue(0) == -1
+    assert rat.GetRowOfValue(10000) == 0
@@ -75,3 +75,84 @@ def test_thread_test_1():
             ret = False
 
     assert ret
+
+
+###############################################################################
+# Test reading a dataset opened with GDAL_OF_THREAD_SAFE from several threads
+
+
+@pytest.mark.parametrize(
+    "filename", ["data/byte.tif", "data/byte.vrt", "data/rgbsmall.tif"]
+)
+def test_thread_test_thread_safe_dataset(filename):
+
+    ref_ds = gdal.Open(filename)
+    expected = [
+        ref_ds.GetRasterBand(i + 1).Checksum() for i in range(ref_ds.RasterCount)
+    ]
+    ref_ds = None
+
+    ds = gdal.OpenEx(filename, gdal.OF_RASTER | gdal.OF_THREAD_SAFE)
+    assert ds.IsThreadSafe()
+    assert ds.RasterCount == len(expected)
+
+    def worker(args_dict):
+        for i in range(100):
+            for iBand in range(ds.RasterCount):
+                if ds.GetRasterBand(iBand + 1).Checksum() != expected[iBand]:
+                    args_dict["ret"] = False
+
+    threads = []
+    args_array = []
+    for i in range(4):
+        args_dict = {"ret": True}
+        t = threading.Thread(target=worker, args=(args_dict,))
+        args_array.append(args_dict)
+        threads.append(t)
+        t.start()
+
+    for i in range(4):
+        threads[i].join()
+        assert args_array[i]["ret"]
+
+
+###############################################################################
+# Test overviews and mask bands of a dataset opened with GDAL_OF_THREAD_SAFE
+
+
+def test_thread_test_thread_safe_dataset_ovr_mask(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.tif")
+    src_ds = gdal.Translate(filename, "data/byte.tif")
+    src_ds.BuildOverviews("NEAR", [2])
+    src_ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+    src_ds.GetRasterBand(1).GetMaskBand().Fill(255)
+    src_ds = None
+
+    with gdal.Open(filename) as ref_ds:
+        ref_band = ref_ds.GetRasterBand(1)
+        expected_ovr_cs = ref_band.GetOverview(0).Checksum()
+        expected_mask_cs = ref_band.GetMaskBand().Checksum()
+
+    with gdal.OpenEx(filename, gdal.OF_RASTER | gdal.OF_THREAD_SAFE) as ds:
+        band = ds.GetRasterBand(1)
+        assert band.GetOverviewCount() == 1
+        assert band.GetOverview(0).XSize == 10
+        assert band.GetOverview(0).Checksum() == expected_ovr_cs
+        assert band.GetMaskFlags() == gdal.GMF_PER_DATASET
+        assert band.GetMaskBand().Checksum() == expected_mask_cs
+
+
+###############################################################################
+# Test invalid uses of GDAL_OF_THREAD_SAFE
+
+
+def test_thread_test_thread_safe_dataset_errors():
+
+    with pytest.raises(Exception, match="GDAL_OF_THREAD_SAFE"):
+        gdal.OpenEx(
+            "data/byte.tif", gdal.OF_RASTER | gdal.OF_THREAD_SAFE | gdal.OF_UPDATE
+        )
+
+    with pytest.raises(Exception, match="GDAL_OF_THREAD_SAFE"):
+        gdal.OpenEx("data/byte.tif", gdal.OF_VECTOR | gdal.OF_THREAD_SAFE)
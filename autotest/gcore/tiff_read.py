@@ -33,6 +33,7 @@ import platform
 import shutil
 import struct
 import sys
+import time
 
 import gdaltest
 import pytest
@@ -5043,6 +5044,382 @@ def test_tiff_read_multi_threaded_vsicurl_window_not_aligned_on_blocks():
         gdal.VSICurlClearCache()
 
 
+###############################################################################
+# Test that a multi-threaded read of a COG with a mask interleaved with the
+# imagery fetches the mask tiles in the same request as the imagery ones
+
+
+@pytest.mark.require_driver("COG")
+def test_tiff_read_multi_threaded_vsicurl_cog_interleaved_mask(tmp_path):
+
+    webserver_process = None
+    webserver_port = 0
+
+    (webserver_process, webserver_port) = webserver.launch(
+        handler=webserver.DispatcherHttpHandler
+    )
+    if webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    try:
+        ref_filename = str(tmp_path / "cog_with_mask.tif")
+        src_ds = gdal.Translate("", "data/byte.tif", format="MEM", width=512)
+        src_ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+        src_ds.GetRasterBand(1).GetMaskBand().WriteRaster(
+            0, 0, 512, 512, b"\xff" * (512 * 256) + b"\x00" * (512 * 256)
+        )
+        gdal.GetDriverByName("COG").CreateCopy(
+            ref_filename,
+            src_ds,
+            options=["COMPRESS=NONE", "BLOCKSIZE=256", "OVERVIEWS=NONE"],
+        )
+        src_ds = None
+        ref_ds = gdal.Open(ref_filename)
+
+        filesize = gdal.VSIStatL(ref_filename).size
+        handler = webserver.SequentialHandler()
+        handler.add("HEAD", "/cog.tif", 200, {"Content-Length": "%d" % filesize})
+
+        def method(request):
+            if request.headers["Range"].startswith("bytes="):
+                rng = request.headers["Range"][len("bytes=") :]
+                assert len(rng.split("-")) == 2
+                start = int(rng.split("-")[0])
+                end = int(rng.split("-")[1])
+
+                request.protocol_version = "HTTP/1.1"
+                request.send_response(206)
+                request.send_header("Content-type", "application/octet-stream")
+                request.send_header(
+                    "Content-Range", "bytes %d-%d/%d" % (start, end, filesize)
+                )
+                request.send_header("Content-Length", end - start + 1)
+                request.send_header("Connection", "close")
+                request.end_headers()
+                with open(ref_filename, "rb") as f:
+                    f.seek(start, 0)
+                    request.wfile.write(f.read(end - start + 1))
+
+        # One request for the header, and one for the 2 imagery tiles and
+        # their mask tiles
+        for i in range(2):
+            handler.add("GET", "/cog.tif", custom_method=method)
+
+        with gdaltest.config_options(
+            {
+                "GDAL_NUM_THREADS": "2",
+                "CPL_VSIL_CURL_ALLOWED_EXTENSIONS": ".tif",
+                "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+            }
+        ):
+            with webserver.install_http_handler(handler):
+                ds = gdal.Open("/vsicurl/http://127.0.0.1:%d/cog.tif" % webserver_port)
+                assert ds is not None, "could not open dataset"
+
+                data = ds.GetRasterBand(1).ReadRaster(0, 0, 512, 256)
+                assert data == ref_ds.GetRasterBand(1).ReadRaster(0, 0, 512, 256)
+
+            # Mask tiles already in cache: no network access
+            data = ds.GetRasterBand(1).GetMaskBand().ReadRaster(0, 0, 512, 256)
+            assert data == b"\xff" * (512 * 256)
+
+    finally:
+        webserver.server_stop(webserver_process, webserver_port)
+
+        gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test prefetching of the blocks ahead of a panning access pattern on /vsicurl
+
+
+@pytest.mark.parametrize("prefetch_blocks", ["0", "1"])
+def test_tiff_read_vsicurl_prefetch_blocks(tmp_path, prefetch_blocks):
+
+    webserver_process = None
+    webserver_port = 0
+
+    (webserver_process, webserver_port) = webserver.launch(
+        handler=webserver.DispatcherHttpHandler
+    )
+    if webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    try:
+        ref_filename = str(tmp_path / "tiled.tif")
+        ref_ds = gdal.GetDriverByName("GTiff").Create(
+            ref_filename,
+            768,
+            256,
+            options=["TILED=YES", "BLOCKXSIZE=256", "BLOCKYSIZE=256"],
+        )
+        for i in range(3):
+            ref_ds.GetRasterBand(1).WriteRaster(
+                i * 256, 0, 256, 256, bytes([i + 1]) * (256 * 256)
+            )
+        ref_ds = None
+        ref_ds = gdal.Open(ref_filename)
+        tile2_offset = int(
+            ref_ds.GetRasterBand(1).GetMetadataItem("BLOCK_OFFSET_2_0", "TIFF")
+        )
+        filesize = gdal.VSIStatL(ref_filename).size
+
+        class RangeHandler:
+            def __init__(self):
+                self.range_starts = []
+
+            def final_check(self):
+                pass
+
+            def do_HEAD(self, request):
+                request.send_response(200)
+                request.send_header("Content-Length", filesize)
+                request.end_headers()
+
+            def do_GET(self, request):
+                rng = request.headers["Range"][len("bytes=") :]
+                start = int(rng.split("-")[0])
+                end = min(int(rng.split("-")[1]), filesize - 1)
+                self.range_starts.append(start)
+
+                request.protocol_version = "HTTP/1.1"
+                request.send_response(206)
+                request.send_header("Content-type", "application/octet-stream")
+                request.send_header(
+                    "Content-Range", "bytes %d-%d/%d" % (start, end, filesize)
+                )
+                request.send_header("Content-Length", end - start + 1)
+                request.send_header("Connection", "close")
+                request.end_headers()
+                with open(ref_filename, "rb") as f:
+                    f.seek(start, 0)
+                    request.wfile.write(f.read(end - start + 1))
+
+        handler = RangeHandler()
+        with gdaltest.config_options(
+            {
+                "GTIFF_PREFETCH_BLOCKS": prefetch_blocks,
+                "CPL_VSIL_CURL_ALLOWED_EXTENSIONS": ".tif",
+                "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+            }
+        ):
+            with webserver.install_http_handler(handler):
+                ds = gdal.Open(
+                    "/vsicurl/http://127.0.0.1:%d/tiled.tif" % webserver_port
+                )
+                assert ds is not None, "could not open dataset"
+
+                # Read the first two tiles: the third (and last) one is
+                # predicted
+                for i in range(2):
+                    data = ds.GetRasterBand(1).ReadRaster(i * 256, 0, 256, 256)
+                    assert data == bytes([i + 1]) * (256 * 256)
+
+                if prefetch_blocks != "0":
+                    # Wait for the asynchronous fetch of the third tile
+                    for i in range(100):
+                        if tile2_offset in handler.range_starts:
+                            break
+                        time.sleep(0.05)
+                    assert tile2_offset in handler.range_starts
+
+            # No handler installed: only prefetched data can be read
+            with gdal.quiet_errors():
+                data = ds.GetRasterBand(1).ReadRaster(512, 0, 256, 256)
+            if prefetch_blocks != "0":
+                assert data == bytes([3]) * (256 * 256)
+            else:
+                assert data is None
+            ds = None
+
+    finally:
+        webserver.server_stop(webserver_process, webserver_port)
+
+        gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test decoding of blocks by anticipation when ReadBlock() is called
+# sequentially
+
+
+@pytest.mark.parametrize("read_ahead_blocks,expected_cached_blocks", [(0, 2), (3, 5)])
+def test_tiff_read_multi_threaded_read_ahead(
+    tmp_vsimem, read_ahead_blocks, expected_cached_blocks
+):
+
+    tmpfile = str(tmp_vsimem / "test_tiff_read_multi_threaded_read_ahead.tif")
+    src_ds = gdal.Translate(
+        tmpfile,
+        "data/byte.tif",
+        width=128,
+        height=32,
+        creationOptions=[
+            "TILED=YES",
+            "BLOCKXSIZE=16",
+            "BLOCKYSIZE=16",
+            "COMPRESS=DEFLATE",
+        ],
+    )
+    src_ds = None
+    ref_ds = gdal.Open(tmpfile)
+    ref_band = ref_ds.GetRasterBand(1)
+
+    with gdaltest.config_option("GTIFF_READ_AHEAD_BLOCKS", str(read_ahead_blocks)):
+        ds = gdal.OpenEx(tmpfile, open_options=["NUM_THREADS=2"])
+    band = ds.GetRasterBand(1)
+
+    cache_used = gdal.GetCacheUsed()
+    band.ReadBlock(0, 0)
+    band.ReadBlock(1, 0)
+    assert gdal.GetCacheUsed() - cache_used == expected_cached_blocks * 16 * 16
+
+    for y in range(2):
+        for x in range(8):
+            assert band.ReadBlock(x, y) == ref_band.ReadBlock(x, y)
+
+
+###############################################################################
+# Test multi-threaded decoding of DEFLATE/ZSTD striles without libtiff
+
+
+@pytest.mark.parametrize("compress", ["DEFLATE", "ZSTD"])
+@pytest.mark.parametrize("predictor", [1, 2])
+@pytest.mark.parametrize(
+    "dtype", [gdal.GDT_Byte, gdal.GDT_Int16, gdal.GDT_UInt32, gdal.GDT_UInt64]
+)
+@pytest.mark.parametrize("interleave", ["PIXEL", "BAND"])
+@pytest.mark.parametrize("tiled", ["YES", "NO"])
+def test_tiff_read_multi_threaded_direct_decoding(
+    tmp_vsimem, compress, predictor, dtype, interleave, tiled
+):
+
+    if compress not in gdal.GetDriverByName("GTiff").GetMetadataItem(
+        "DMD_CREATIONOPTIONLIST"
+    ):
+        pytest.skip(f"Compression method {compress} not supported in this build")
+
+    src_ds = gdal.Translate(
+        "", "data/byte.tif", format="MEM", width=50, height=45, outputType=dtype
+    )
+    src_ds.AddBand(dtype)
+    src_ds.GetRasterBand(2).WriteRaster(
+        0, 0, 50, 45, src_ds.GetRasterBand(1).ReadRaster()
+    )
+
+    tmpfile = str(tmp_vsimem / "test_tiff_read_multi_threaded_direct_decoding.tif")
+    gdal.Translate(
+        tmpfile,
+        src_ds,
+        creationOptions=[
+            "COMPRESS=" + compress,
+            "PREDICTOR=%d" % predictor,
+            "INTERLEAVE=" + interleave,
+            "TILED=" + tiled,
+            "BLOCKXSIZE=16",
+            "BLOCKYSIZE=16",
+        ],
+    )
+
+    ds = gdal.OpenEx(tmpfile, open_options=["NUM_THREADS=4"])
+    assert ds.ReadRaster() == src_ds.ReadRaster()
+    expected = src_ds.GetRasterBand(2).ReadRaster(1, 2, 40, 43)
+    assert ds.GetRasterBand(2).ReadRaster(1, 2, 40, 43) == expected
+
+
+###############################################################################
+# Test multi-threaded decoding of JXL striles without libtiff
+
+
+@pytest.mark.parametrize("dtype", [gdal.GDT_Byte, gdal.GDT_UInt16])
+@pytest.mark.parametrize("nbands", [1, 3, 4])
+@pytest.mark.parametrize("interleave", ["PIXEL", "BAND"])
+@pytest.mark.parametrize("tiled", ["YES", "NO"])
+def test_tiff_read_multi_threaded_direct_decoding_jxl(
+    tmp_vsimem, dtype, nbands, interleave, tiled
+):
+
+    if "JXL" not in gdal.GetDriverByName("GTiff").GetMetadataItem(
+        "DMD_CREATIONOPTIONLIST"
+    ):
+        pytest.skip("JXL compression not supported in this build")
+
+    src_ds = gdal.Translate(
+        "",
+        "data/byte.tif",
+        format="MEM",
+        width=50,
+        height=45,
+        outputType=dtype,
+        bandList=[1] * nbands,
+    )
+
+    tmpfile = str(
+        tmp_vsimem / "test_tiff_read_multi_threaded_direct_decoding_jxl.tif"
+    )
+    gdal.Translate(
+        tmpfile,
+        src_ds,
+        creationOptions=[
+            "COMPRESS=JXL",
+            "JXL_LOSSLESS=YES",
+            "INTERLEAVE=" + interleave,
+            "TILED=" + tiled,
+            "BLOCKXSIZE=16",
+            "BLOCKYSIZE=16",
+        ]
+        + (["ALPHA=YES"] if nbands == 4 else []),
+    )
+
+    ds = gdal.OpenEx(tmpfile, open_options=["NUM_THREADS=4"])
+    assert ds.ReadRaster() == src_ds.ReadRaster()
+    expected = src_ds.GetRasterBand(nbands).ReadRaster(1, 2, 40, 43)
+    assert ds.GetRasterBand(nbands).ReadRaster(1, 2, 40, 43) == expected
+
+
+###############################################################################
+# Test reading Strip/TileOffsets and Strip/TileByteCounts arrays by pages
+
+
+@pytest.mark.parametrize(
+    "creation_options",
+    [
+        ["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16", "SPARSE_OK=YES"],
+        ["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16", "BIGTIFF=YES"],
+        ["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16", "ENDIANNESS=BIG"],
+        ["BLOCKYSIZE=1", "COMPRESS=DEFLATE"],
+        ["BLOCKYSIZE=2000"],
+    ],
+)
+def test_tiff_read_paged_strile_arrays(tmp_vsimem, creation_options):
+
+    tmpfile = str(tmp_vsimem / "test_tiff_read_paged_strile_arrays.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(
+        tmpfile, 1040, 1040, 1, options=creation_options
+    )
+    # Leave the first row of blocks sparse, if SPARSE_OK=YES
+    data = (bytes(range(251)) * (1040 * 1024 // 251 + 1))[0 : 1040 * 1024]
+    ds.GetRasterBand(1).WriteRaster(0, 16, 1040, 1024, data)
+    ds = None
+
+    ds = gdal.Open(tmpfile)
+    expected = ds.ReadRaster()
+    expected_window = ds.ReadRaster(1030, 1030, 10, 10)
+    ds = None
+
+    with gdaltest.config_option("GTIFF_PAGED_STRILE_ARRAYS", "YES"):
+        ds = gdal.Open(tmpfile)
+        assert ds.ReadRaster(1030, 1030, 10, 10) == expected_window
+        assert ds.ReadRaster() == expected
+        with gdaltest.config_option("GDAL_NUM_THREADS", "2"):
+            ds = gdal.Open(tmpfile)
+            assert ds.ReadRaster() == expected
+
+
 ###############################################################################
 # Test that a user receives a warning when it queries
 # GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE")
@@ -1424,3 +1424,40 @@ def test_tiff_srs_build_compd_crs_name_without_citation():
 
     ds = gdal.Open("data/gtiff/compdcrs_no_citation.tif")
     assert ds.GetSpatialRef().GetName() == "WGS 84 / UTM zone 17N + EGM2008 height"
+
+
+###############################################################################
+# Test the process-wide cache of SRS built from GeoTIFF keys
+
+
+@pytest.mark.parametrize("srs_cache", ["YES", "NO"])
+def test_tiff_srs_cache(tmp_vsimem, srs_cache):
+
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+    srs_compd = osr.SpatialReference()
+    srs_compd.SetFromUserInput("EPSG:4326+5773")
+
+    for i in range(2):
+        ds = gdal.GetDriverByName("GTiff").Create(
+            tmp_vsimem / f"test{i}.tif", 1, 1
+        )
+        ds.SetSpatialRef(srs_compd)
+        ds.SetGeoTransform([2, 1, 0, 49, 0, -1])
+        ds = None
+
+    with gdal.config_option("GTIFF_SRS_CACHE", srs_cache):
+        for i in range(2):
+            ds = gdal.Open(tmp_vsimem / f"test{i}.tif")
+            assert ds.GetSpatialRef().IsSame(srs_compd)
+
+        # Configuration options affecting the SRS are taken into account
+        with gdal.config_option("GTIFF_REPORT_COMPD_CS", "NO"):
+            ds = gdal.Open(tmp_vsimem / "test0.tif")
+            assert ds.GetSpatialRef().IsSame(srs)
+
+        # Modifying the returned SRS does not affect the cached one
+        ds = gdal.Open(tmp_vsimem / "test0.tif")
+        ds.GetSpatialRef().StripVertical()
+        ds = gdal.Open(tmp_vsimem / "test1.tif")
+        assert ds.GetSpatialRef().IsSame(srs_compd)
@@ -6460,6 +6460,96 @@ def test_tiff_write_134():
     assert gdal.GetLastErrorMsg() != ""
 
 
+###############################################################################
+# Test that DISCARD_LSB combined with NUM_THREADS (DISCARD_LSB applied in worker
+# threads, possibly out-of-order writing of striles) gives the same result as
+# single-threaded compression
+
+
+@pytest.mark.parametrize("interleave", ["BAND", "PIXEL"])
+@pytest.mark.parametrize(
+    "compress_options",
+    [["COMPRESS=DEFLATE", "PREDICTOR=2"], ["COMPRESS=LZW", "PREDICTOR=2"]],
+)
+def test_tiff_write_discard_lsb_threads(tmp_vsimem, interleave, compress_options):
+
+    src_ds = gdal.Translate("", "data/byte.tif", format="MEM", width=200, height=200)
+    src_ds.AddBand(gdal.GDT_Byte)
+    src_ds.GetRasterBand(2).WriteRaster(
+        0, 0, 200, 200, src_ds.GetRasterBand(1).ReadRaster()
+    )
+    options = [
+        "TILED=YES",
+        "BLOCKXSIZE=16",
+        "BLOCKYSIZE=16",
+        "DISCARD_LSB=2,3",
+        "INTERLEAVE=" + interleave,
+    ] + compress_options
+
+    ref_filename = str(tmp_vsimem / "ref.tif")
+    gdal.Translate(ref_filename, src_ds, creationOptions=options)
+    ref_ds = gdal.Open(ref_filename)
+
+    filename = str(tmp_vsimem / "test.tif")
+    gdal.Translate(filename, src_ds, creationOptions=options + ["NUM_THREADS=4"])
+    ds = gdal.Open(filename)
+    assert ds.ReadRaster() == ref_ds.ReadRaster()
+    assert ds.ReadRaster() != src_ds.ReadRaster()
+
+
+###############################################################################
+# Test that STRILE_RESERVE enables in-place rewriting of tiles
+
+
+@pytest.mark.parametrize("compress", ["DEFLATE", "LZW", "ZSTD"])
+@pytest.mark.parametrize("num_threads", [None, "2"])
+@pytest.mark.parametrize("strile_reserve", ["0", "20"])
+def test_tiff_write_strile_reserve(tmp_vsimem, compress, num_threads, strile_reserve):
+
+    if compress not in gdal.GetDriverByName("GTiff").GetMetadataItem(
+        "DMD_CREATIONOPTIONLIST"
+    ):
+        pytest.skip(f"{compress} not available")
+
+    filename = str(tmp_vsimem / "test_tiff_write_strile_reserve.tif")
+    options = [
+        "TILED=YES",
+        "BLOCKXSIZE=64",
+        "BLOCKYSIZE=64",
+        "COMPRESS=" + compress,
+        "STRILE_RESERVE=" + strile_reserve,
+    ]
+    if num_threads:
+        options.append("NUM_THREADS=" + num_threads)
+    ds = gdal.GetDriverByName("GTiff").Create(filename, 128, 128, options=options)
+    data = bytes((i * 7 + (i // 64) * 13) % 256 for i in range(128 * 128))
+    ds.WriteRaster(0, 0, 128, 128, data)
+    ds = None
+    initial_size = gdal.VSIStatL(filename).size
+
+    open_options = ["STRILE_RESERVE=" + strile_reserve]
+    if num_threads:
+        open_options.append("NUM_THREADS=" + num_threads)
+    ds = gdal.OpenEx(filename, gdal.OF_UPDATE, open_options=open_options)
+    # Rewrite a tile with a more compressible content, then with its
+    # initial content, which needs more room.
+    ds.WriteRaster(0, 0, 64, 64, b"\x01" * (64 * 64))
+    ds.FlushCache()
+    ds.WriteRaster(0, 0, 128, 128, data)
+    ds = None
+
+    if strile_reserve == "0":
+        assert gdal.VSIStatL(filename).size > initial_size
+    else:
+        assert gdal.VSIStatL(filename).size == initial_size
+
+    ds = gdal.Open(filename)
+    assert ds.ReadRaster() == data
+    with gdaltest.config_option("GDAL_NUM_THREADS", "2"):
+        ds = gdal.Open(filename)
+        assert ds.ReadRaster() == data
+
+
 ###############################################################################
 # Test clearing GCPs (#5945)
 
@@ -32,6 +32,7 @@
 
 
 import math
+import struct
 
 import gdaltest
 import pytest
@@ -360,6 +361,44 @@ def test_transformer_5():
     gdal.Unlink("/vsimem/dem.tif")
 
 
+###############################################################################
+# Test RPC inverse transformation of several points at once, where each point
+# starts its iterations from the result of the previous one.
+
+
+@pytest.mark.parametrize("with_dem", [False, True])
+def test_transformer_rpc_inverse_several_points(with_dem):
+
+    ds = gdal.Open("data/rpc.vrt")
+    options = ["METHOD=RPC", "RPC_PIXEL_ERROR_THRESHOLD=0.05"]
+    if with_dem:
+        ds_dem = gdal.GetDriverByName("GTiff").Create(
+            "/vsimem/dem_several_points.tif", 100, 100, 1, gdal.GDT_Float32
+        )
+        sr = osr.SpatialReference()
+        sr.ImportFromEPSG(32652)
+        ds_dem.SetProjection(sr.ExportToWkt())
+        ds_dem.SetGeoTransform([213300, 200, 0, 4418700, 0, -200])
+        ds_dem.GetRasterBand(1).WriteRaster(
+            0, 0, 100, 100, struct.pack("f" * 10000, *[i % 50 for i in range(10000)])
+        )
+        ds_dem = None
+        options.append("RPC_DEM=/vsimem/dem_several_points.tif")
+    tr = gdal.Transformer(ds, None, options)
+
+    points = [(20.5 + i, 10.5 + i / 2, 0) for i in range(20)]
+    (pnts, success) = tr.TransformPoints(0, points)
+    assert success == [1] * len(points)
+    (back_pnts, success) = tr.TransformPoints(1, pnts)
+    assert success == [1] * len(points)
+    for i in range(len(points)):
+        assert back_pnts[i][0] == pytest.approx(points[i][0], abs=0.05)
+        assert back_pnts[i][1] == pytest.approx(points[i][1], abs=0.05)
+
+    tr = None
+    gdal.Unlink("/vsimem/dem_several_points.tif")
+
+
 ###############################################################################
 # Test RPC convergence bug (bug # 5395)
 
@@ -1076,6 +1115,35 @@ def test_transformer_tps_precision():
     assert maxDiffResult < 1e-3, "at least one transformation exceeds the error bound"
 
 
+###############################################################################
+# Test that multi-threaded solving and evaluation of thin plate splines give
+# the same results as the single-threaded code path.
+
+
+def test_transformer_tps_num_threads():
+
+    ds = gdal.Open("data/gcps_2115.vrt")
+    tr = gdal.Transformer(ds, None, ["METHOD=GCP_TPS", "NUM_THREADS=1"])
+    assert tr
+    tr_mt = gdal.Transformer(ds, None, ["METHOD=GCP_TPS", "NUM_THREADS=4"])
+    assert tr_mt
+
+    points = [
+        (x * ds.RasterXSize / 99.0, y * ds.RasterYSize / 99.0)
+        for y in range(100)
+        for x in range(100)
+    ]
+    pnts, success = tr.TransformPoints(0, points)
+    pnts_mt, success_mt = tr_mt.TransformPoints(0, points)
+    assert success_mt == success
+    assert pnts_mt == pnts
+
+    back_pnts, success = tr.TransformPoints(1, pnts)
+    back_pnts_mt, success_mt = tr_mt.TransformPoints(1, pnts)
+    assert success_mt == success
+    assert back_pnts_mt == back_pnts
+
+
 ###############################################################################
 def test_transformer_image_no_srs():
 
@@ -39,6 +39,7 @@ import struct
 import gdaltest
 import pytest
 import test_cli_utilities
+import webserver
 
 from osgeo import gdal
 
@@ -2220,6 +2221,149 @@ def test_vrt_read_compute_statistics_mosaic_optimization(
         assert vrt_ds.GetRasterBand(1).GetMetadataItem("STATISTICS_MAXIMUM") == "255"
 
 
+###############################################################################
+# Test multi-threaded reading of the sources of a mosaic
+
+
+@pytest.mark.parametrize("overlapping", [False, True])
+def test_vrt_read_mosaic_multithreaded(overlapping):
+
+    src_ds = gdal.Translate("", gdal.Open("data/byte.tif"), format="MEM")
+    srcwins = ["0 0 8 10", "8 0 12 10", "0 10 8 10", "8 10 12 10"]
+    if overlapping:
+        srcwins.append("5 5 10 10")
+    tiles = [
+        gdal.Translate("", src_ds, options="-of MEM -srcwin " + srcwin)
+        for srcwin in srcwins
+    ]
+    if overlapping:
+        # Make the overlapping tile distinguishable from the other ones
+        tiles[-1].GetRasterBand(1).Fill(1)
+    vrt_ds = gdal.BuildVRT("", tiles)
+    expected = vrt_ds.ReadRaster()
+    expected_window = vrt_ds.ReadRaster(2, 3, 15, 12)
+    if not overlapping:
+        assert expected == src_ds.ReadRaster()
+
+    def callback(pct, message, user_data):
+        user_data[0] = pct
+        return 1  # 1 to continue, 0 to stop
+
+    user_data = [0]
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        assert (
+            vrt_ds.GetRasterBand(1).ReadRaster(
+                callback=callback, callback_data=user_data
+            )
+            == expected
+        )
+        assert user_data[0] == 1.0
+        assert vrt_ds.ReadRaster(2, 3, 15, 12) == expected_window
+
+
+###############################################################################
+# Test reading a mosaic with enough sources to use the spatial index of sources
+
+
+def test_vrt_read_mosaic_many_sources(tmp_vsimem):
+
+    src_ds = gdal.Translate(
+        "", gdal.Open("data/byte.tif"), format="MEM", width=160, height=160
+    )
+    tiles = [
+        gdal.Translate("", src_ds, options=f"-of MEM -srcwin {x} {y} 10 10")
+        for y in range(0, 160, 10)
+        for x in range(0, 160, 10)
+    ]
+    vrt_ds = gdal.BuildVRT("", tiles)
+    band = vrt_ds.GetRasterBand(1)
+    src_band = src_ds.GetRasterBand(1)
+
+    for window in [
+        (0, 0, 160, 160),
+        (5, 7, 1, 1),
+        (15, 25, 40, 3),
+        (150, 150, 10, 10),
+    ]:
+        assert vrt_ds.ReadRaster(*window) == src_ds.ReadRaster(*window)
+        assert band.ReadRaster(*window) == src_band.ReadRaster(*window)
+
+    # Sources added after the first read must be taken into account
+    tile_filename = str(tmp_vsimem / "tile.tif")
+    tile_ds = gdal.GetDriverByName("GTiff").Create(tile_filename, 10, 10)
+    tile_ds.GetRasterBand(1).Fill(1)
+    tile_ds = None
+    band.SetMetadataItem(
+        "source_0",
+        f"""<SimpleSource>
+              <SourceFilename>{tile_filename}</SourceFilename>
+              <SourceBand>1</SourceBand>
+              <SrcRect xOff="0" yOff="0" xSize="10" ySize="10"/>
+              <DstRect xOff="20" yOff="30" xSize="10" ySize="10"/>
+            </SimpleSource>""",
+        "new_vrt_sources",
+    )
+    assert band.ReadRaster(20, 30, 10, 10) == b"\x01" * 100
+    assert band.ReadRaster(30, 30, 10, 10) == src_band.ReadRaster(30, 30, 10, 10)
+
+
+###############################################################################
+# Test prefetching the headers of network sources before opening them
+
+
+@pytest.mark.require_curl()
+def test_vrt_read_mosaic_network_sources_prefetch(tmp_vsimem):
+
+    webserver_process = None
+    webserver_port = 0
+
+    (webserver_process, webserver_port) = webserver.launch(
+        handler=webserver.DispatcherHttpHandler
+    )
+    if webserver_port == 0:
+        pytest.skip()
+
+    try:
+        src_ds = gdal.Open("data/byte.tif")
+        files = {}
+        sources = ""
+        for i in range(2):
+            filename = str(tmp_vsimem / f"tile{i}.tif")
+            gdal.Translate(filename, src_ds, options=f"-srcwin {10 * i} 0 10 20")
+            files[f"/tile{i}.tif"] = open_file_content(filename)
+            sources += f"""<SimpleSource>
+              <SourceFilename>/vsicurl/http://localhost:{webserver_port}/tile{i}.tif</SourceFilename>
+              <SourceBand>1</SourceBand>
+              <SrcRect xOff="0" yOff="0" xSize="10" ySize="20"/>
+              <DstRect xOff="{10 * i}" yOff="0" xSize="10" ySize="20"/>
+            </SimpleSource>"""
+        vrt_content = f"""<VRTDataset rasterXSize="20" rasterYSize="20">
+          <VRTRasterBand dataType="Byte" band="1">
+            {sources}
+          </VRTRasterBand>
+        </VRTDataset>"""
+
+        gdal.VSICurlClearCache()
+        handler = webserver.FileHandler(files)
+        with webserver.install_http_handler(handler), gdaltest.config_options(
+            {"GDAL_NUM_THREADS": "2", "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR"}
+        ):
+            ds = gdal.Open(vrt_content)
+            assert ds.GetRasterBand(1).Checksum() == 4672
+    finally:
+        gdal.VSICurlClearCache()
+        webserver.server_stop(webserver_process, webserver_port)
+
+
+def open_file_content(filename):
+    f = gdal.VSIFOpenL(filename, "rb")
+    assert f
+    try:
+        return gdal.VSIFReadL(1, gdal.VSIStatL(filename).size, f)
+    finally:
+        gdal.VSIFCloseL(f)
+
+
 ###############################################################################
 # Test ComputeStatistics() mosaic optimization with nodata at VRT band
 
@@ -2559,6 +2703,45 @@ def test_vrt_read_complex_source_nodata_out_of_range(tmp_vsimem, data_type):
     assert got_data == (1,)
 
 
+###############################################################################
+# Test the table-based processing of Byte and UInt16 complex sources with
+# nodata, scaling and LUT
+
+
+@pytest.mark.parametrize("data_type", [gdal.GDT_Byte, gdal.GDT_UInt16])
+@pytest.mark.parametrize("request_type", [gdal.GDT_Byte, gdal.GDT_UInt16])
+def test_vrt_read_complex_source_table_processing(
+    tmp_vsimem, data_type, request_type
+):
+
+    input_data = array.array(
+        "H", [(x + y) % 100 + 1 for y in range(256) for x in range(256)]
+    )
+    input_filename = str(tmp_vsimem / "source.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(input_filename, 256, 256, 1, data_type)
+    ds.WriteRaster(0, 0, 256, 256, input_data, buf_type=gdal.GDT_UInt16)
+    ds.Close()
+    complex_xml = f"""<VRTDataset rasterXSize="256" rasterYSize="256">
+  <VRTRasterBand dataType="Byte" band="1">
+    <NoDataValue>255</NoDataValue>
+    <ComplexSource>
+      <SourceFilename relativeToVRT="0">{input_filename}</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <NODATA>50</NODATA>
+      <ScaleOffset>10</ScaleOffset>
+      <ScaleRatio>2</ScaleRatio>
+      <LUT>0:0,1000:500</LUT>
+    </ComplexSource>
+  </VRTRasterBand>
+</VRTDataset>
+"""
+    vrt_ds = gdal.Open(complex_xml)
+    got_data = vrt_ds.ReadRaster(buf_type=request_type)
+    array_request_type = "B" if request_type == gdal.GDT_Byte else "H"
+    got_data = struct.unpack(array_request_type * (256 * 256), got_data)
+    assert got_data == tuple(255 if v == 50 else v + 5 for v in input_data)
+
+
 ###############################################################################
 # Test serialization of approximate ComputeStatistics() when there is
 # external overview
@@ -2586,3 +2769,125 @@ def test_vrt_read_compute_statistics_approximate(tmp_vsimem):
     assert "STATISTICS_MEAN" in md
     assert "STATISTICS_STDDEV" in md
     assert md["STATISTICS_VALID_PERCENT"] == "100"
+
+
+###############################################################################
+# Test that sources whose Footprint does not intersect the request are skipped
+# without being opened
+
+
+def test_vrt_read_source_footprint(tmp_vsimem):
+
+    vrt_filename = str(tmp_vsimem / "footprint.vrt")
+    gdal.FileFromMemBuffer(
+        vrt_filename,
+        """<VRTDataset rasterXSize="20" rasterYSize="20">
+  <VRTRasterBand dataType="Byte" band="1">
+    <ComplexSource>
+      <SourceFilename>/vsimem/i_do_not_exist.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="0" yOff="0" xSize="20" ySize="20"/>
+      <DstRect xOff="0" yOff="0" xSize="20" ySize="20"/>
+      <Footprint>POLYGON ((0 0,10 0,10 10,0 10,0 0))</Footprint>
+      <NODATA>0</NODATA>
+    </ComplexSource>
+  </VRTRasterBand>
+</VRTDataset>""",
+    )
+
+    ds = gdal.Open(vrt_filename)
+    assert ds.ReadRaster(15, 15, 5, 5) == b"\x00" * 25
+    with pytest.raises(Exception):
+        ds.ReadRaster(5, 5, 5, 5)
+    # The window is enlarged by the resampling kernel radius
+    with pytest.raises(Exception):
+        ds.ReadRaster(12, 12, 5, 5)
+
+    ds.GetRasterBand(1).SetDescription("foo")
+    ds = None
+    ds = gdal.Open(vrt_filename)
+    assert (
+        "<Footprint>POLYGON ((0 0,10 0,10 10,0 10,0 0))</Footprint>"
+        in ds.GetMetadata("xml:VRT")[0]
+    )
+
+
+@pytest.mark.require_geos
+def test_vrt_read_source_footprint_non_rectangular():
+
+    ds = gdal.Open(
+        """<VRTDataset rasterXSize="20" rasterYSize="20">
+  <VRTRasterBand dataType="Byte" band="1">
+    <ComplexSource>
+      <SourceFilename>/vsimem/i_do_not_exist.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="0" yOff="0" xSize="20" ySize="20"/>
+      <DstRect xOff="0" yOff="0" xSize="20" ySize="20"/>
+      <Footprint>POLYGON ((0 0,20 0,0 20,0 0))</Footprint>
+      <NODATA>0</NODATA>
+    </ComplexSource>
+  </VRTRasterBand>
+</VRTDataset>"""
+    )
+    # Intersects the bounding box of the footprint, but not the footprint
+    assert ds.ReadRaster(14, 14, 6, 6) == b"\x00" * 36
+
+
+###############################################################################
+# Test opening a VRT through its source index sidecar
+
+
+def test_vrt_read_source_index(tmp_path):
+
+    src_filename = str(tmp_path / "src.tif")
+    src_ds = gdal.GetDriverByName("GTiff").Create(src_filename, 160, 160)
+    src_ds.WriteRaster(0, 0, 160, 160, bytes(i % 251 for i in range(160 * 160)))
+    ref_cs = src_ds.GetRasterBand(1).Checksum()
+    ref_data = src_ds.ReadRaster(35, 45, 20, 10)
+    src_ds = None
+
+    sources = ""
+    for y in range(0, 160, 10):
+        for x in range(0, 160, 10):
+            sources += f"""
+    <SimpleSource>
+      <SourceFilename relativeToVRT="1">src.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="{x}" yOff="{y}" xSize="10" ySize="10"/>
+      <DstRect xOff="{x}" yOff="{y}" xSize="10" ySize="10"/>
+    </SimpleSource>"""
+    vrt_filename = str(tmp_path / "test.vrt")
+    with open(vrt_filename, "wt") as f:
+        f.write(
+            f"""<VRTDataset rasterXSize="160" rasterYSize="160">
+  <VRTRasterBand dataType="Byte" band="1">{sources}
+  </VRTRasterBand>
+</VRTDataset>"""
+        )
+    index_filename = vrt_filename + ".srcidx"
+
+    with gdaltest.config_option("VRT_SOURCE_INDEX", "YES"):
+        ds = gdal.Open(vrt_filename)
+    assert ds.GetRasterBand(1).Checksum() == ref_cs
+    ds = None
+    assert os.path.exists(index_filename)
+
+    ds = gdal.Open(vrt_filename)
+    assert index_filename in ds.GetFileList()
+    assert ds.ReadRaster(35, 45, 20, 10) == ref_data
+    assert ds.GetRasterBand(1).Checksum() == ref_cs
+    assert ds.GetMetadata("xml:VRT")[0].count("<SimpleSource") == 256
+    ds = None
+
+    with gdaltest.config_option("VRT_SOURCE_INDEX", "NO"):
+        ds = gdal.Open(vrt_filename)
+    assert index_filename not in ds.GetFileList()
+    ds = None
+
+    # Rewriting the VRT invalidates the sidecar
+    ds = gdal.Open(vrt_filename, gdal.GA_Update)
+    ds.GetRasterBand(1).SetDescription("foo")
+    ds = None
+    assert not os.path.exists(index_filename)
+    ds = gdal.Open(vrt_filename)
+    assert ds.GetRasterBand(1).Checksum() == ref_cs
@@ -547,6 +547,38 @@ def test_vsicrypt_4():
     gdal.Unlink(ref_file)
 
 
+###############################################################################
+# Test multi-threaded processing of large reads and writes
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_vsicrypt_large_read_write(num_threads):
+
+    test_file = "/vsicrypt/key=DONT_USE_IN_PROD,file=/vsimem/file_enc.bin"
+
+    import random
+
+    random.seed(0)
+    content = bytes(random.randint(0, 255) for _ in range(1000 * 1000 + 7))
+
+    with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+        f = gdal.VSIFOpenL(test_file, "wb+")
+        assert gdal.VSIFWriteL(content[0:100], 1, 100, f) == 100
+        assert (
+            gdal.VSIFWriteL(content[100:], 1, len(content) - 100, f)
+            == len(content) - 100
+        )
+        gdal.VSIFCloseL(f)
+
+        f = gdal.VSIFOpenL(test_file, "rb")
+        assert gdal.VSIFReadL(1, len(content) + 1, f) == content
+        gdal.VSIFSeekL(f, 1000, 0)
+        assert gdal.VSIFReadL(1, 500000, f) == content[1000:501000]
+        gdal.VSIFCloseL(f)
+
+    gdal.Unlink(test_file)
+
+
 ###############################################################################
 # Test random filling of last sector
 
@@ -701,6 +701,70 @@ def test_vsicurl_no_size_in_HEAD(server):
     assert statres.size == 10
 
 
+###############################################################################
+# Test CPL_VSIL_CURL_DISK_CACHE_DIR
+
+
+def test_vsicurl_disk_cache(server, tmp_path):
+
+    gdal.VSICurlClearCache()
+
+    filename = "/vsicurl/http://localhost:%d/test_vsicurl_disk_cache.bin" % server.port
+
+    def read_file():
+        f = gdal.VSIFOpenL(filename, "rb")
+        assert f is not None
+        data = gdal.VSIFReadL(1, 3, f)
+        gdal.VSIFCloseL(f)
+        return data
+
+    with gdal.config_option("CPL_VSIL_CURL_DISK_CACHE_DIR", str(tmp_path)):
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "HEAD",
+            "/test_vsicurl_disk_cache.bin",
+            200,
+            {"Content-Length": "3", "ETag": '"first_etag"'},
+        )
+        handler.add("GET", "/test_vsicurl_disk_cache.bin", 200, {}, "foo")
+        with webserver.install_http_handler(handler):
+            assert read_file() == b"foo"
+
+        # Data is served from the disk cache after validation of the ETag
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "HEAD",
+            "/test_vsicurl_disk_cache.bin",
+            200,
+            {"Content-Length": "3", "ETag": '"first_etag"'},
+        )
+        with webserver.install_http_handler(handler):
+            assert read_file() == b"foo"
+
+        # The remote file has changed
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "HEAD",
+            "/test_vsicurl_disk_cache.bin",
+            200,
+            {"Content-Length": "3", "ETag": '"second_etag"'},
+        )
+        handler.add("GET", "/test_vsicurl_disk_cache.bin", 200, {}, "bar")
+        with webserver.install_http_handler(handler):
+            assert read_file() == b"bar"
+
+        # File properties are also reused from the disk cache
+        gdal.VSICurlClearCache()
+        with gdal.config_option("CPL_VSIL_CURL_DISK_CACHE_FILE_PROP_TTL", "3600"):
+            handler = webserver.SequentialHandler()
+            with webserver.install_http_handler(handler):
+                assert read_file() == b"bar"
+
+    gdal.VSICurlClearCache()
+
+
 ###############################################################################
 
 
@@ -540,6 +540,54 @@ abc***NEWFILE***:""",
     gdal.Unlink("/vsimem/vsifile_10.tar")
 
 
+###############################################################################
+# Test partial listing of /vsitar/ archives and CPL_VSIL_TAR_INDEX_DIR
+
+
+def test_vsifile_vsitar_lazy_listing_and_index(tmp_path):
+    import io
+    import tarfile
+
+    tar_filename = str(tmp_path / "test.tar")
+    with tarfile.open(tar_filename, "w", format=tarfile.USTAR_FORMAT) as tar:
+        for name, content in [
+            ("first.txt", b"abc"),
+            ("subdir/second.txt", b"defgh"),
+            ("last.txt", b"ij"),
+        ]:
+            info = tarfile.TarInfo(name)
+            info.size = len(content)
+            tar.addfile(info, io.BytesIO(content))
+
+    index_dir = tmp_path / "index"
+    index_dir.mkdir()
+    with gdal.config_option("CPL_VSIL_TAR_INDEX_DIR", str(index_dir)):
+        prefix = "/vsitar/" + tar_filename
+
+        f = gdal.VSIFOpenL(prefix + "/subdir/second.txt", "rb")
+        assert f
+        assert gdal.VSIFReadL(1, 5, f) == b"defgh"
+        gdal.VSIFCloseL(f)
+
+        assert gdal.VSIStatL(prefix + "/subdir").IsDirectory()
+        assert gdal.VSIStatL(prefix + "/first.txt").size == 3
+
+        # Only the headers up to the requested file have been read so far
+        assert os.listdir(index_dir) == []
+
+        assert gdal.VSIStatL(prefix + "/last.txt").size == 2
+        assert gdal.VSIStatL(prefix + "/i_do_not_exist.txt") is None
+
+        # The whole archive has now been read, and its index saved
+        assert len(os.listdir(index_dir)) == 1
+
+        assert set(gdal.ReadDir(prefix)) == set(["first.txt", "subdir", "last.txt"])
+        f = gdal.VSIFOpenL(prefix + "/last.txt", "rb")
+        assert f
+        assert gdal.VSIFReadL(1, 2, f) == b"ij"
+        gdal.VSIFCloseL(f)
+
+
 ###############################################################################
 # Test generic Truncate implementation for file extension
 
@@ -837,6 +885,86 @@ def test_vsigzip_multi_thread():
         pytest.fail()
 
 
+###############################################################################
+# Test decompression in a worker thread
+
+
+def test_vsigzip_read_ahead():
+
+    filename = "/vsimem/vsigzip_read_ahead.gz"
+    expected = b"".join(b"%08d" % i for i in range(500000))
+    try:
+        f = gdal.VSIFOpenL("/vsigzip/" + filename, "wb")
+        gdal.VSIFWriteL(expected, 1, len(expected), f)
+        gdal.VSIFCloseL(f)
+
+        with gdaltest.config_option("GDAL_NUM_THREADS", "2"):
+            f = gdal.VSIFOpenL("/vsigzip/" + filename, "rb")
+        assert f
+        try:
+            data = b""
+            while True:
+                chunk = gdal.VSIFReadL(1, 100000, f)
+                data += chunk
+                if len(chunk) < 100000:
+                    break
+            assert data == expected
+            assert gdal.VSIFEofL(f)
+
+            assert gdal.VSIFSeekL(f, 3000000, 0) == 0
+            assert gdal.VSIFReadL(1, 16, f) == expected[3000000:3000016]
+            assert gdal.VSIFSeekL(f, 8, 0) == 0
+            assert gdal.VSIFReadL(1, 16, f) == expected[8:24]
+            assert gdal.VSIFSeekL(f, 0, 2) == 0
+            assert gdal.VSIFTellL(f) == len(expected)
+        finally:
+            gdal.VSIFCloseL(f)
+    finally:
+        gdal.Unlink(filename)
+        gdal.Unlink(filename + ".properties")
+
+
+###############################################################################
+# Test that snapshots of several files are kept across opens, and discarded
+# when the file changes
+
+
+def test_vsigzip_handle_cache():
+
+    filenames = ["/vsimem/vsigzip_handle_cache_%d.gz" % i for i in range(2)]
+    try:
+        for i, filename in enumerate(filenames):
+            f = gdal.VSIFOpenL("/vsigzip/" + filename, "wb")
+            gdal.VSIFWriteL(("%d" % i) * 100000, 1, 100000, f)
+            gdal.VSIFCloseL(f)
+
+        with gdaltest.config_option("CPL_VSIL_GZIP_SNAPSHOT_COUNT", "1000"):
+            for _ in range(2):
+                for i, filename in enumerate(filenames):
+                    f = gdal.VSIFOpenL("/vsigzip/" + filename, "rb")
+                    gdal.VSIFSeekL(f, 99990, 0)
+                    assert gdal.VSIFReadL(1, 10, f).decode("ascii") == (
+                        "%d" % i
+                    ) * 10
+                    gdal.VSIFCloseL(f)
+
+        assert gdal.VSIStatL("/vsigzip/" + filenames[0]).size == 100000
+
+        # Overwrite with a file of different size
+        f = gdal.VSIFOpenL("/vsigzip/" + filenames[0], "wb")
+        gdal.VSIFWriteL("a" * 1000, 1, 1000, f)
+        gdal.VSIFCloseL(f)
+
+        assert gdal.VSIStatL("/vsigzip/" + filenames[0]).size == 1000
+        f = gdal.VSIFOpenL("/vsigzip/" + filenames[0], "rb")
+        assert gdal.VSIFReadL(1, 1000, f).decode("ascii") == "a" * 1000
+        gdal.VSIFCloseL(f)
+    finally:
+        for filename in filenames:
+            gdal.Unlink(filename)
+            gdal.Unlink(filename + ".properties")
+
+
 ###############################################################################
 # Test vsisync()
 
@@ -2983,6 +2983,67 @@ def test_vsis3_write_multipart_retry(aws_test_config, webserver_port):
                 gdal.VSIFCloseL(f)
 
 
+###############################################################################
+# Test multipart upload with parts uploaded in background threads
+
+
+@pytest.mark.skipif(
+    gdaltest.is_travis_branch("macos_build"), reason="randomly fails on macos"
+)
+def test_vsis3_write_multipart_upload_num_threads(aws_test_config, webserver_port):
+
+    with gdaltest.config_options(
+        {"VSIS3_CHUNK_SIZE_BYTES": "3", "VSIS3_UPLOAD_NUM_THREADS": "2"},
+        thread_local=False,
+    ):
+        with webserver.install_http_handler(webserver.SequentialHandler()):
+            f = gdal.VSIFOpenL("/vsis3/s3_fake_bucket4/large_file.tif", "wb")
+    assert f is not None
+
+    handler = webserver.SequentialHandler()
+    response = """<?xml version="1.0" encoding="UTF-8"?>
+    <InitiateMultipartUploadResult>
+    <UploadId>my_id</UploadId>
+    </InitiateMultipartUploadResult>"""
+    handler.add(
+        "POST",
+        "/s3_fake_bucket4/large_file.tif?uploads",
+        200,
+        {"Content-type": "application/xml", "Content-Length": len(response)},
+        response,
+    )
+    # Parts may be uploaded in any order
+    for part_number, content in ((1, b"abc"), (2, b"def"), (3, b"g")):
+        handler.add_unordered(
+            "PUT",
+            "/s3_fake_bucket4/large_file.tif?partNumber=%d&uploadId=my_id"
+            % part_number,
+            200,
+            {"ETag": '"etag_%d"' % part_number},
+            expected_body=content,
+        )
+    handler.add_unordered(
+        "POST",
+        "/s3_fake_bucket4/large_file.tif?uploadId=my_id",
+        200,
+        expected_body=b"""<CompleteMultipartUpload>
+<Part>
+<PartNumber>1</PartNumber><ETag>"etag_1"</ETag></Part>
+<Part>
+<PartNumber>2</PartNumber><ETag>"etag_2"</ETag></Part>
+<Part>
+<PartNumber>3</PartNumber><ETag>"etag_3"</ETag></Part>
+</CompleteMultipartUpload>
+""",
+    )
+
+    gdal.ErrorReset()
+    with webserver.install_http_handler(handler):
+        assert gdal.VSIFWriteL("abcdefg", 1, 7, f) == 7
+        gdal.VSIFCloseL(f)
+    assert gdal.GetLastErrorMsg() == ""
+
+
 ###############################################################################
 # Test abort pending multipart uploads
 
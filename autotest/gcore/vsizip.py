@@ -938,6 +938,45 @@ def test_vsizip_byte_sozip():
         gdal.Unlink(zipfilename)
 
 
+###############################################################################
+# Test multi-threaded decompression of a SOZip file
+
+
+@pytest.mark.parametrize("read_size", [1, 100, 1000, 100000])
+def test_vsizip_sozip_multi_thread_read(read_size):
+
+    zipfilename = "/vsimem/test_vsizip_sozip_multi_thread_read.zip"
+    dstfilename = f"/vsizip/{zipfilename}/test.tif"
+    try:
+        options = ["SOZIP_ENABLED=YES", "SOZIP_CHUNK_SIZE=128"]
+        assert gdal.CopyFile("data/byte.tif", dstfilename, options=options) == 0
+        with open("data/byte.tif", "rb") as f:
+            expected = f.read()
+
+        with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+            f = gdal.VSIFOpenL(dstfilename, "rb")
+            assert f
+            try:
+                data = b""
+                while True:
+                    chunk = gdal.VSIFReadL(1, read_size, f)
+                    data += chunk
+                    if len(chunk) < read_size:
+                        break
+                assert data == expected
+
+                # Random access
+                assert gdal.VSIFSeekL(f, 500, 0) == 0
+                assert gdal.VSIFReadL(1, 10, f) == expected[500:510]
+                assert gdal.VSIFSeekL(f, 100, 0) == 0
+                assert gdal.VSIFReadL(1, 300, f) == expected[100:400]
+            finally:
+                gdal.VSIFCloseL(f)
+
+    finally:
+        gdal.Unlink(zipfilename)
+
+
 ###############################################################################
 
 
@@ -4109,6 +4109,50 @@ def test_gpkg_byte_nodata_value(band_count):
     gdal.Unlink(filename)
 
 
+###############################################################################
+# Test multi-threaded encoding of tiles
+
+
+@pytest.mark.parametrize("tile_format", ["PNG", "JPEG", "PNG8"])
+def test_gpkg_write_num_threads(tmp_vsimem, tile_format):
+
+    tile_drv_name = "PNG" if tile_format == "PNG8" else tile_format
+    if gdal.GetDriverByName(tile_drv_name) is None:
+        pytest.skip(f"{tile_drv_name} driver missing")
+
+    src_ds = gdal.Translate(
+        "", "data/rgbsmall.tif", format="MEM", width=1000, height=900
+    )
+
+    def write(filename, num_threads):
+        ds = gdal.Translate(
+            filename,
+            src_ds,
+            format="GPKG",
+            creationOptions=[
+                "RASTER_TABLE=tiles",
+                "TILE_FORMAT=" + tile_format,
+                "NUM_THREADS=" + str(num_threads),
+            ],
+        )
+        ds.BuildOverviews("NEAR", [2, 4])
+        ds = None
+        ds = gdal.Open(filename)
+        cs = [ds.GetRasterBand(i + 1).Checksum() for i in range(ds.RasterCount)]
+        cs_ovr = [
+            ds.GetRasterBand(i + 1).GetOverview(0).Checksum()
+            for i in range(ds.RasterCount)
+        ]
+        sql_lyr = ds.ExecuteSQL("SELECT COUNT(*) FROM tiles")
+        tile_count = sql_lyr.GetNextFeature().GetField(0)
+        ds.ReleaseResultSet(sql_lyr)
+        return cs, cs_ovr, tile_count
+
+    ref = write(tmp_vsimem / "st.gpkg", 1)
+    assert ref[2] > 4
+    assert write(tmp_vsimem / "mt.gpkg", 4) == ref
+
+
 ###############################################################################
 # Test gdal subdataset informational functions
 
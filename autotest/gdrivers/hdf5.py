@@ -1316,3 +1316,55 @@ def test_gdal_subdataset_bogus(bogus):
     """Test it doesn't crash"""
 
     gdal.GetSubdatasetInfo(bogus)
+
+
+###############################################################################
+# Test direct chunk reading of a deflate+shuffle compressed dataset
+
+
+@pytest.mark.require_driver("netCDF")
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_hdf5_direct_chunk_read(tmp_path, num_threads):
+
+    filename = str(tmp_path / "test_hdf5_direct_chunk_read.nc")
+    ds = gdal.GetDriverByName("netCDF").CreateMultiDimensional(
+        filename, options=["FORMAT=NC4"]
+    )
+    rg = ds.GetRootGroup()
+    dim_b = rg.CreateDimension("band", None, None, 2)
+    dim_y = rg.CreateDimension("y", None, None, 25)
+    dim_x = rg.CreateDimension("x", None, None, 35)
+    var = rg.CreateMDArray(
+        "var",
+        [dim_b, dim_y, dim_x],
+        gdal.ExtendedDataType.Create(gdal.GDT_UInt16),
+        ["BLOCKSIZE=1,10,10", "COMPRESS=DEFLATE"],
+    )
+    data = array.array("H", [(i * 37) % 65521 for i in range(2 * 25 * 35)])
+    assert var.Write(data.tobytes()) == gdal.CE_None
+    ds = None
+
+    def read():
+        ds = gdal.Open(f'HDF5:"{filename}"://var')
+        assert ds.GetRasterBand(1).GetBlockSize() == [10, 10]
+        return (
+            ds.ReadRaster(),
+            ds.ReadRaster(3, 4, 27, 19, buf_type=gdal.GDT_UInt16),
+            ds.ReadRaster(buf_pixel_space=4, buf_band_space=2),
+            ds.GetRasterBand(2).ReadBlock(3, 2),
+            ds.GetRasterBand(1).Checksum(),
+        )
+
+    with gdaltest.config_option("GDAL_HDF5_DIRECT_CHUNK_READ", "NO"):
+        ref = read()
+    assert ref[0] == data.tobytes()
+    with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+        assert read() == ref
+
+    ds = gdal.Open(f'HDF5:"{filename}"://var')
+    band = ds.GetRasterBand(2)
+    offset = int(band.GetMetadataItem("BLOCK_OFFSET_3_2", "HDF5"))
+    size = int(band.GetMetadataItem("BLOCK_SIZE_3_2", "HDF5"))
+    assert offset > 0
+    assert size > 0
+    assert band.GetMetadataItem("BLOCK_OFFSET_4_0", "HDF5") is None
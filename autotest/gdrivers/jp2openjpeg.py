@@ -3850,3 +3850,24 @@ def test_jp2openjpeg_vrt_protocol():
         webserver.server_stop(webserver_process, webserver_port)
 
         gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test multi-threaded decoding of tiles requested by one RasterIO()
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_jp2openjpeg_multithreaded_tile_decoding(tmp_vsimem, num_threads):
+
+    src_ds = gdal.Open("data/byte.tif")
+    filename = str(tmp_vsimem / "out.jp2")
+    gdal.GetDriverByName("JP2OpenJPEG").CreateCopy(
+        filename,
+        src_ds,
+        options=["BLOCKXSIZE=8", "BLOCKYSIZE=8", "REVERSIBLE=YES", "QUALITY=100"],
+    )
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+        ds = gdal.Open(filename)
+        assert ds.GetRasterBand(1).GetBlockSize() == [8, 8]
+        assert ds.ReadRaster() == src_ds.ReadRaster()
@@ -845,3 +845,53 @@ def test_jpegxl_identify_raw_codestream():
         f"{gdalmanage_path} identify data/jpegxl/test.jxl.bin"
     )
     assert "JPEGXL" in out
+
+
+###############################################################################
+# Test the overview exposing the DC (1:8) image of lossy codestreams
+
+
+def test_jpegxl_dc_overview(tmp_vsimem):
+
+    src_ds = gdal.Translate(
+        "", "data/rgbsmall.tif", format="MEM", width=1024, height=520
+    )
+    filename = str(tmp_vsimem / "test_jpegxl_dc_overview.jxl")
+    gdal.GetDriverByName("JPEGXL").CreateCopy(
+        filename, src_ds, options=["LOSSLESS=NO"]
+    )
+
+    ds = gdal.Open(filename)
+    if ds.GetRasterBand(1).GetOverviewCount() == 0:
+        pytest.skip("libjxl too old to expose the DC image as an overview")
+    assert ds.GetRasterBand(1).GetOverviewCount() == 1
+    ovr_band = ds.GetRasterBand(1).GetOverview(0)
+    assert ovr_band.XSize == 128
+    assert ovr_band.YSize == 65
+
+    # Compare with the full resolution image downsampled with the same
+    # algorithm
+    for i in range(3):
+        ovr_band = ds.GetRasterBand(i + 1).GetOverview(0)
+        ref_band = src_ds.GetRasterBand(i + 1)
+        ref_data = ref_band.ReadRaster(
+            buf_xsize=128, buf_ysize=65, resample_alg=gdal.GRIORA_Average
+        )
+        ovr_data = ovr_band.ReadRaster()
+        assert len(ovr_data) == len(ref_data)
+        diff = sum(abs(a - b) for a, b in zip(ovr_data, ref_data)) / len(ref_data)
+        assert diff < 10
+
+    ds = None
+
+    with gdal.config_option("GDAL_JPEGXL_DC_OVERVIEW", "NO"):
+        ds = gdal.Open(filename)
+        assert ds.GetRasterBand(1).GetOverviewCount() == 0
+    ds = None
+
+    # No overview for lossless codestreams
+    gdal.GetDriverByName("JPEGXL").CreateCopy(
+        filename, src_ds, options=["LOSSLESS=YES"]
+    )
+    ds = gdal.Open(filename)
+    assert ds.GetRasterBand(1).GetOverviewCount() == 0
@@ -30,12 +30,14 @@
 ###############################################################################
 
 import ctypes
+import os
 import struct
+import sys
 
 import gdaltest
 import pytest
 
-from osgeo import gdal
+from osgeo import gdal, osr
 
 
 @pytest.fixture
@@ -787,5 +789,59 @@ def test_mem_alpha_ismaskband():
 # cleanup
 
 
+###############################################################################
+# Test SHARED_MEMORY_FILE creation option and MEM:::SHARED_MEMORY_FILE= syntax
+
+
+@pytest.mark.skipif(
+    not sys.platform.startswith("linux"), reason="requires /dev/shm"
+)
+@pytest.mark.parametrize("interleave", ["BAND", "PIXEL"])
+def test_mem_shared_memory_file(interleave):
+
+    filename = "/dev/shm/test_mem_shared_memory_file_%d" % os.getpid()
+    try:
+        ds = gdal.GetDriverByName("MEM").Create(
+            "",
+            3,
+            2,
+            2,
+            gdal.GDT_Int16,
+            options=["SHARED_MEMORY_FILE=" + filename, "INTERLEAVE=" + interleave],
+        )
+        ds.SetGeoTransform([2, 1, 0, 49, 0, -1])
+        ds.SetSpatialRef(osr.SpatialReference(epsg=4326))
+        ds.GetRasterBand(2).Fill(123)
+
+        ds2 = gdal.Open("MEM:::SHARED_MEMORY_FILE=" + filename)
+        assert ds2.RasterXSize == 3
+        assert ds2.RasterYSize == 2
+        assert ds2.RasterCount == 2
+        assert ds2.GetRasterBand(1).DataType == gdal.GDT_Int16
+        assert ds2.GetGeoTransform() == (2, 1, 0, 49, 0, -1)
+        assert ds2.GetSpatialRef().GetAuthorityCode(None) == "4326"
+        assert ds2.GetRasterBand(1).Checksum() == 0
+        assert ds2.GetRasterBand(2).ComputeRasterMinMax() == (123, 123)
+
+        # Changes made through the first dataset are visible without reopening
+        ds.GetRasterBand(1).Fill(1)
+        assert ds2.GetRasterBand(1).ComputeRasterMinMax() == (1, 1)
+
+        with pytest.raises(Exception):
+            ds2.GetRasterBand(1).Fill(2)
+
+        ds2 = gdal.OpenEx("MEM:::SHARED_MEMORY_FILE=" + filename, gdal.OF_UPDATE)
+        ds2.GetRasterBand(1).Fill(3)
+        ds2 = None
+        assert ds.GetRasterBand(1).ComputeRasterMinMax() == (3, 3)
+        ds = None
+
+        with pytest.raises(Exception):
+            gdal.Open("MEM:::SHARED_MEMORY_FILE=/i_do/not/exist")
+    finally:
+        if os.path.exists(filename):
+            os.unlink(filename)
+
+
 def test_mem_cleanup():
     gdaltest.mem_ds = None
@@ -645,6 +645,73 @@ def test_mrf_setspatialref():
     gdal.GetDriverByName("MRF").Delete(filename)
 
 
+###############################################################################
+# Test concurrent page encoding and decoding with NUM_THREADS
+
+
+@pytest.mark.parametrize(
+    "compress,options",
+    [
+        ("LERC", []),
+        ("LERC", ["OPTIONS=V1:YES"]),
+        ("QB3", []),
+        ("DEFLATE", []),
+        ("ZSTD", []),
+        ("NONE", ["OPTIONS=DEFLATE:ON"]),
+        # Not reentrant, uses the single threaded code
+        ("PNG", []),
+    ],
+)
+def test_mrf_num_threads(compress, options):
+
+    if compress not in gdal.GetDriverByName("MRF").GetMetadataItem(
+        "DMD_CREATIONOPTIONLIST"
+    ):
+        pytest.skip(f"{compress} compression not available")
+
+    src_ds = gdal.Translate(
+        "", "data/small_world.tif", format="MEM", width=1000, height=500
+    )
+    co = [f"COMPRESS={compress}", "INTERLEAVE=BAND", "BLOCKSIZE=128"] + options
+
+    def create(filename, num_threads):
+        gdal.Translate(
+            filename,
+            src_ds,
+            format="MRF",
+            creationOptions=co + [f"NUM_THREADS={num_threads}"],
+        )
+        f = gdal.VSIFOpenL(filename[:-3] + "idx", "rb")
+        idx = gdal.VSIFReadL(1, 1000000, f)
+        gdal.VSIFCloseL(f)
+        return idx
+
+    # Same index, so same data file layout
+    ref = create("/vsimem/ref.mrf", 1)
+    assert create("/vsimem/out.mrf", 4) == ref
+
+    ref_ds = gdal.Open("/vsimem/ref.mrf")
+    ds = gdal.OpenEx("/vsimem/out.mrf", open_options=["NUM_THREADS=4"])
+    for i in range(3):
+        assert (
+            ds.GetRasterBand(i + 1).ReadRaster()
+            == ref_ds.GetRasterBand(i + 1).ReadRaster()
+        )
+    assert ds.ReadRaster(100, 50, 700, 300) == ref_ds.ReadRaster(100, 50, 700, 300)
+    ds = None
+    ref_ds = None
+
+    # All these compressions are lossless for Byte
+    ds = gdal.OpenEx("/vsimem/out.mrf", open_options=["NUM_THREADS=ALL_CPUS"])
+    assert [ds.GetRasterBand(i + 1).Checksum() for i in range(3)] == [
+        src_ds.GetRasterBand(i + 1).Checksum() for i in range(3)
+    ]
+    ds = None
+
+    cleanup("/vsimem/ref.")
+    cleanup()
+
+
 def test_mrf_cleanup():
 
     files = (
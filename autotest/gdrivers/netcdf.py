@@ -5595,6 +5595,45 @@ def test_netcdf_chunked_not_multiple():
     assert ds.GetRasterBand(1).Checksum() == 4672
 
 
+###############################################################################
+# Test reading a variable whose chunks span several bands, with the chunk
+# cache enlarged to a 2D slice, or disabled
+
+
+def test_netcdf_chunked_across_bands(tmp_path):
+
+    filename = str(tmp_path / "test_netcdf_chunked_across_bands.nc")
+    ds = gdal.GetDriverByName("netCDF").CreateMultiDimensional(filename)
+    rg = ds.GetRootGroup()
+    dim_t = rg.CreateDimension("time", None, None, 4)
+    dim_y = rg.CreateDimension("y", None, None, 20)
+    dim_x = rg.CreateDimension("x", None, None, 30)
+    var = rg.CreateMDArray(
+        "var",
+        [dim_t, dim_y, dim_x],
+        gdal.ExtendedDataType.Create(gdal.GDT_Byte),
+        ["BLOCKSIZE=4,10,10", "COMPRESS=DEFLATE"],
+    )
+    data = bytes([i % 251 for i in range(4 * 20 * 30)])
+    assert var.Write(data) == gdal.CE_None
+    ds = None
+
+    def read():
+        ds = gdal.Open(filename)
+        assert ds.RasterCount == 4
+        assert ds.GetRasterBand(1).GetBlockSize() == [10, 10]
+        return [
+            ds.GetRasterBand(i + 1).ReadRaster() for i in range(ds.RasterCount)
+        ]
+
+    with gdaltest.config_option("GDAL_NETCDF_CHUNK_CACHE_SIZE", "0"):
+        ref = read()
+    # Rows may be flipped depending on the bottom-up detection
+    for i in range(4):
+        assert sorted(ref[i]) == sorted(data[i * 600 : (i + 1) * 600])
+    assert read() == ref
+
+
 def test_netcdf_create():
 
     ds = gdaltest.netcdf_drv.Create("tmp/test_create.nc", 2, 2)
@@ -488,3 +488,47 @@ def test_png_copy_mdd():
     ds = None
 
     gdal.Unlink(filename)
+
+
+###############################################################################
+# Test multi-threaded compression
+
+
+@pytest.mark.parametrize(
+    "src_filename,output_type",
+    [
+        ("data/rgbsmall.tif", gdal.GDT_Byte),
+        ("data/rgbsmall.tif", gdal.GDT_UInt16),
+        ("../gcore/data/byte.tif", gdal.GDT_Byte),
+        ("../gcore/data/8bit_pal.bmp", gdal.GDT_Byte),
+    ],
+)
+def test_png_create_copy_num_threads(tmp_vsimem, src_filename, output_type):
+
+    src_ds = gdal.Translate(
+        "",
+        src_filename,
+        format="MEM",
+        width=1000,
+        height=1500,
+        outputType=output_type,
+    )
+    filename = str(tmp_vsimem / "test.png")
+    out_ds = gdal.GetDriverByName("PNG").CreateCopy(
+        filename, src_ds, options=["NUM_THREADS=4", "ZLEVEL=1"]
+    )
+    assert out_ds.RasterCount == src_ds.RasterCount
+    for i in range(src_ds.RasterCount):
+        assert out_ds.GetRasterBand(i + 1).DataType == output_type
+        assert (
+            out_ds.GetRasterBand(i + 1).Checksum()
+            == src_ds.GetRasterBand(i + 1).Checksum()
+        )
+    if src_ds.GetRasterBand(1).GetColorTable():
+        assert out_ds.GetRasterBand(1).GetColorTable() is not None
+    out_ds = None
+
+    # Compare with the size of the single-threaded output
+    st_filename = str(tmp_vsimem / "test_st.png")
+    gdal.GetDriverByName("PNG").CreateCopy(st_filename, src_ds, options=["ZLEVEL=1"])
+    assert gdal.VSIStatL(filename).size < 1.1 * gdal.VSIStatL(st_filename).size
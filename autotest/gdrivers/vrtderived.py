@@ -1023,6 +1023,74 @@ def identity(in_ar, out_ar, xoff, yoff, xsize, ysize, raster_xsize, raster_ysize
     _validate(xml)
 
 
+###############################################################################
+# Check that a derived band used several times by another derived band is
+# only evaluated once per block
+
+
+@pytest.mark.parametrize("block_cache", ["YES", "NO"])
+def test_vrtderived_chained_block_cache(tmp_path, block_cache):
+
+    try:
+        import numpy
+
+        numpy.ones
+    except (ImportError, AttributeError):
+        pytest.skip()
+
+    trace_filename = str(tmp_path / "trace.txt")
+    intermediate_filename = str(tmp_path / "intermediate.vrt")
+    open(intermediate_filename, "wt").write(
+        f"""<VRTDataset rasterXSize="20" rasterYSize="20">
+  <VRTRasterBand dataType="Byte" band="1" subClass="VRTDerivedRasterBand">
+    <PixelFunctionType>double</PixelFunctionType>
+    <PixelFunctionLanguage>Python</PixelFunctionLanguage>
+    <PixelFunctionCode><![CDATA[
+def double(in_ar, out_ar, xoff, yoff, xsize, ysize, raster_xsize, raster_ysize, r, gt, **kwargs):
+    open({trace_filename!r}, "at").write("x")
+    out_ar[:] = in_ar[0] // 2 * 2
+]]>
+    </PixelFunctionCode>
+    <SimpleSource>
+      <SourceFilename>{os.path.join(os.getcwd(), "data", "byte.tif")}</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>"""
+    )
+
+    ds = gdal.Open(
+        f"""<VRTDataset rasterXSize="20" rasterYSize="20">
+  <VRTRasterBand dataType="UInt16" band="1" subClass="VRTDerivedRasterBand">
+    <PixelFunctionType>sum</PixelFunctionType>
+    <SimpleSource>
+      <SourceFilename>{intermediate_filename}</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+    <SimpleSource>
+      <SourceFilename>{intermediate_filename}</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>"""
+    )
+
+    with gdaltest.config_options(
+        {"GDAL_VRT_ENABLE_PYTHON": "YES", "VRT_DERIVED_BAND_BLOCK_CACHE": block_cache}
+    ):
+        data = ds.GetRasterBand(1).ReadAsArray()
+        assert ds.GetRasterBand(1).ReadAsArray(0, 0, 10, 10) is not None
+
+    ref = gdal.Open("data/byte.tif").ReadAsArray()
+    assert numpy.array_equal(data, ref // 2 * 2 * 2)
+
+    # With the block cache, the 20x20 intermediate band has a single block,
+    # computed once for both sources and both reads.
+    assert len(open(trace_filename, "rt").read()) == (
+        1 if block_cache == "YES" else 4
+    )
+
+
 ###############################################################################
 # Cleanup.
 
@@ -2304,3 +2304,65 @@ def test_vrtpansharpen_out_of_order_input_bands_and_nodata():
     cs2 = [vrt_ds.GetRasterBand(i + 1).Checksum() for i in range(vrt_ds.RasterCount)]
 
     assert cs2 == cs[::-1]
+
+
+###############################################################################
+# Check that multi-threaded processing and pixel-interleaved requests give the
+# same result as the single-threaded band-sequential path, for various data
+# types
+
+
+@pytest.mark.parametrize(
+    "dt", [gdal.GDT_Byte, gdal.GDT_UInt16, gdal.GDT_Int32, gdal.GDT_Float64]
+)
+def test_vrtpansharpen_num_threads_and_pixel_interleaving(dt):
+
+    def get_vrt_ds(num_threads):
+        return gdal.Open(
+            """<VRTDataset subClass="VRTPansharpenedDataset">
+    <PansharpeningOptions>
+        <Resampling>Cubic</Resampling>
+        <NumThreads>%s</NumThreads>
+        <PanchroBand>
+                <SourceFilename relativeToVRT="1">tmp/small_world_pan.tif</SourceFilename>
+                <SourceBand>1</SourceBand>
+        </PanchroBand>
+        <SpectralBand dstBand="1">
+                <SourceFilename relativeToVRT="1">data/small_world.tif</SourceFilename>
+                <SourceBand>1</SourceBand>
+        </SpectralBand>
+        <SpectralBand dstBand="2">
+                <SourceFilename relativeToVRT="1">data/small_world.tif</SourceFilename>
+                <SourceBand>2</SourceBand>
+        </SpectralBand>
+        <SpectralBand dstBand="3">
+                <SourceFilename relativeToVRT="1">data/small_world.tif</SourceFilename>
+                <SourceBand>3</SourceBand>
+        </SpectralBand>
+    </PansharpeningOptions>
+</VRTDataset>"""
+            % num_threads
+        )
+
+    vrt_ds = get_vrt_ds("1")
+    assert vrt_ds is not None
+    ref_data = vrt_ds.ReadRaster(buf_type=dt)
+
+    vrt_ds = get_vrt_ds("4")
+    assert vrt_ds.ReadRaster(buf_type=dt) == ref_data
+
+    dt_size = gdal.GetDataTypeSizeBytes(dt)
+    pixel_interleaved_data = vrt_ds.ReadRaster(
+        buf_type=dt, buf_pixel_space=3 * dt_size, buf_band_space=dt_size
+    )
+    tmp_ds = gdal.GetDriverByName("MEM").Create("", 800, 400, 3, dt)
+    tmp_ds.WriteRaster(
+        0,
+        0,
+        800,
+        400,
+        pixel_interleaved_data,
+        buf_pixel_space=3 * dt_size,
+        buf_band_space=dt_size,
+    )
+    assert tmp_ds.ReadRaster() == ref_data
@@ -670,3 +670,45 @@ def test_vrtwarp_float32_max_nodata(nodata):
     finally:
         gdal.Unlink(in_filename)
         gdal.Unlink(out_filename)
+
+
+###############################################################################
+# Test that a read request spanning several blocks gives the same result
+# when the blocks are warped together by a multi-threaded warping kernel
+
+
+@pytest.mark.parametrize("dataset_level", [True, False])
+@pytest.mark.parametrize("warp_memory_limit", [None, 100000])
+def test_vrtwarp_multithreaded_multiple_blocks(
+    tmp_vsimem, dataset_level, warp_memory_limit
+):
+
+    vrt_filename = str(tmp_vsimem / "out.vrt")
+    # With a warp memory limit of 100000 bytes, each warped region is
+    # restricted to a single row of blocks
+    gdal.Warp(
+        vrt_filename,
+        "data/rgbsmall.tif",
+        format="VRT",
+        width=300,
+        height=300,
+        resampleAlg=gdal.GRIORA_Bilinear,
+        warpMemoryLimit=warp_memory_limit,
+        creationOptions=["BLOCKXSIZE=64", "BLOCKYSIZE=32"],
+    )
+
+    def read(ds):
+        if dataset_level:
+            return ds.ReadRaster(10, 5, 250, 270)
+        return ds.GetRasterBand(2).ReadRaster(10, 5, 250, 270)
+
+    ds = gdal.Open(vrt_filename)
+    ref = read(ds)
+    ds = None
+
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        ds = gdal.Open(vrt_filename)
+        assert read(ds) == ref
+        # Blocks are now cached: re-reading them should not change anything
+        assert read(ds) == ref
+        ds = None
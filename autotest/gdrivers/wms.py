@@ -1032,3 +1032,64 @@ def test_gdal_subdataset_modify_filename(filename):
             )
             == "WMS:https://xxxx/?SERVICE=WMS&VERSION=1.1.1&REQUEST=GetMap&LAYERS=MODIS_Aqua_L3_Land_Surface_Temp_Monthly_CMG_Night_TES"
         )
+
+
+###############################################################################
+# Test that missing tiles are recorded in the cache and not requested again
+
+
+def test_wms_negative_cache(tmp_vsimem):
+
+    tms = f"""<GDAL_WMS>
+    <Service name="TMS">
+        <ServerUrl>{tmp_vsimem}/tms/${{z}}/${{x}}/${{y}}.png</ServerUrl>
+    </Service>
+    <DataWindow>
+        <UpperLeftX>-20037508.34</UpperLeftX>
+        <UpperLeftY>20037508.34</UpperLeftY>
+        <LowerRightX>20037508.34</LowerRightX>
+        <LowerRightY>-20037508.34</LowerRightY>
+        <TileLevel>0</TileLevel>
+        <TileCountX>1</TileCountX>
+        <TileCountY>1</TileCountY>
+        <YOrigin>top</YOrigin>
+    </DataWindow>
+    <Projection>EPSG:3857</Projection>
+    <BlockSizeX>256</BlockSizeX>
+    <BlockSizeY>256</BlockSizeY>
+    <BandsCount>1</BandsCount>
+    <ZeroBlockHttpCodes>404</ZeroBlockHttpCodes>
+    <Cache><Path>{tmp_vsimem}/cache</Path></Cache>
+</GDAL_WMS>"""
+
+    def cache_file_sizes():
+        files = gdal.ReadDirRecursive(f"{tmp_vsimem}/cache") or []
+        return [
+            gdal.VSIStatL(f"{tmp_vsimem}/cache/{f}").size
+            for f in files
+            if not f.endswith("/")
+        ]
+
+    with gdaltest.config_option("CPL_CURL_ENABLE_VSIMEM", "YES"):
+        with gdaltest.error_handler():
+            ds = gdal.Open(tms)
+            assert ds.GetRasterBand(1).Checksum() == 0
+        ds = None
+        assert cache_file_sizes() == [0]
+
+        src_ds = gdal.GetDriverByName("MEM").Create("", 256, 256)
+        src_ds.GetRasterBand(1).Fill(255)
+        gdal.GetDriverByName("PNG").CreateCopy(f"{tmp_vsimem}/tms/0/0/0.png", src_ds)
+
+        # The tile is known to be missing: it is not requested again
+        ds = gdal.Open(tms)
+        assert ds.GetRasterBand(1).Checksum() == 0
+        ds = None
+
+        tms_no_negative_cache = tms.replace(
+            "</Path>", "</Path><NegativeCache>false</NegativeCache>"
+        )
+        gdal.RmdirRecursive(f"{tmp_vsimem}/cache")
+        ds = gdal.Open(tms_no_negative_cache)
+        assert ds.GetRasterBand(1).Checksum() != 0
+        ds = None
@@ -5442,3 +5442,180 @@ def test_zarr_multidim_compute_statistics_update_metadata():
     finally:
         if gdal.VSIStatL(filename):
             gdal.RmdirRecursive(filename)
+
+
+###############################################################################
+
+
+def _crc32c(data):
+    crc = 0xFFFFFFFF
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0x82F63B78 if crc & 1 else crc >> 1
+    return crc ^ 0xFFFFFFFF
+
+
+@pytest.mark.parametrize("index_location", ["start", "end"])
+@pytest.mark.parametrize("advise_read", [False, True])
+def test_zarr_read_v3_sharding(index_location, advise_read):
+
+    import gzip
+
+    filename = "/vsimem/test_zarr_read_v3_sharding.zarr"
+    height, width = 6, 8
+    shard_size = 4
+    inner_size = 2
+
+    j = {
+        "zarr_format": 3,
+        "node_type": "array",
+        "shape": [height, width],
+        "data_type": "uint16",
+        "chunk_grid": {
+            "name": "regular",
+            "configuration": {"chunk_shape": [shard_size, shard_size]},
+        },
+        "chunk_key_encoding": {"name": "default"},
+        "fill_value": 0,
+        "codecs": [
+            {
+                "name": "sharding_indexed",
+                "configuration": {
+                    "chunk_shape": [inner_size, inner_size],
+                    "codecs": [
+                        {"name": "bytes", "configuration": {"endian": "little"}},
+                        {"name": "gzip", "configuration": {"level": 1}},
+                    ],
+                    "index_codecs": [
+                        {"name": "bytes", "configuration": {"endian": "little"}},
+                        {"name": "crc32c"},
+                    ],
+                    "index_location": index_location,
+                },
+            }
+        ],
+    }
+
+    def value(y, x):
+        return y * width + x + 1
+
+    # Shard (1, 1) is missing, as well as inner chunk (0, 1) of shard (0, 0)
+    def is_missing(y, x):
+        return (y >= shard_size and x >= shard_size) or (
+            y < inner_size and inner_size <= x < 2 * inner_size
+        )
+
+    nb_inner = shard_size // inner_size
+    index_size = nb_inner * nb_inner * 16 + 4
+
+    try:
+        gdal.Mkdir(filename, 0)
+        gdal.FileFromMemBuffer(
+            filename + "/zarr.json",
+            json.dumps({"zarr_format": 3, "node_type": "group"}),
+        )
+        gdal.Mkdir(filename + "/ar", 0)
+        gdal.FileFromMemBuffer(filename + "/ar/zarr.json", json.dumps(j))
+
+        for shard_y in range(2):
+            for shard_x in range(2):
+                if shard_y == 1 and shard_x == 1:
+                    continue
+                chunks = b""
+                index = []
+                offset = index_size if index_location == "start" else 0
+                for inner_y in range(nb_inner):
+                    for inner_x in range(nb_inner):
+                        y0 = shard_y * shard_size + inner_y * inner_size
+                        x0 = shard_x * shard_size + inner_x * inner_size
+                        if is_missing(y0, x0):
+                            index += [0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF]
+                            continue
+                        raw = b"".join(
+                            struct.pack("<H", value(y, x))
+                            for y in range(y0, y0 + inner_size)
+                            for x in range(x0, x0 + inner_size)
+                        )
+                        compressed = gzip.compress(raw)
+                        index += [offset + len(chunks), len(compressed)]
+                        chunks += compressed
+                index_bytes = struct.pack("<" + "Q" * len(index), *index)
+                index_bytes += struct.pack("<I", _crc32c(index_bytes))
+                assert len(index_bytes) == index_size
+                gdal.Mkdir(filename + "/ar/c", 0)
+                gdal.Mkdir(filename + "/ar/c/%d" % shard_y, 0)
+                gdal.FileFromMemBuffer(
+                    filename + "/ar/c/%d/%d" % (shard_y, shard_x),
+                    index_bytes + chunks
+                    if index_location == "start"
+                    else chunks + index_bytes,
+                )
+
+        ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER | gdal.OF_UPDATE)
+        assert ds
+        ar = ds.GetRootGroup().OpenMDArray("ar")
+        assert ar
+        assert ar.GetBlockSize() == [inner_size, inner_size]
+
+        if advise_read:
+            with gdaltest.config_option("GDAL_NUM_THREADS", "2"):
+                assert ar.AdviseRead() == gdal.CE_None
+
+        expected = b"".join(
+            struct.pack("<H", 0 if is_missing(y, x) else value(y, x))
+            for y in range(height)
+            for x in range(width)
+        )
+        assert ar.Read() == expected
+
+        with gdal.quiet_errors():
+            assert ar.Write(expected) != gdal.CE_None
+        assert "sharded" in gdal.GetLastErrorMsg()
+    finally:
+        gdal.RmdirRecursive(filename)
+
+
+def test_zarr_read_v3_sharding_wrong_index_checksum():
+
+    filename = "/vsimem/test_zarr_read_v3_sharding_wrong_index_checksum.zarr"
+
+    j = {
+        "zarr_format": 3,
+        "node_type": "array",
+        "shape": [2],
+        "data_type": "uint8",
+        "chunk_grid": {"name": "regular", "configuration": {"chunk_shape": [2]}},
+        "chunk_key_encoding": {"name": "default"},
+        "fill_value": 0,
+        "codecs": [
+            {
+                "name": "sharding_indexed",
+                "configuration": {
+                    "chunk_shape": [1],
+                    "codecs": [{"name": "bytes"}],
+                    "index_codecs": [
+                        {"name": "bytes", "configuration": {"endian": "little"}},
+                        {"name": "crc32c"},
+                    ],
+                },
+            }
+        ],
+    }
+
+    try:
+        gdal.Mkdir(filename, 0)
+        gdal.FileFromMemBuffer(filename + "/zarr.json", json.dumps(j))
+        gdal.Mkdir(filename + "/c", 0)
+        gdal.FileFromMemBuffer(
+            filename + "/c/0",
+            b"\x01\x02" + struct.pack("<QQQQI", 0, 1, 1, 1, 0),
+        )
+        ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+        assert ds
+        ar = ds.GetRootGroup().OpenMDArray(ds.GetRootGroup().GetMDArrayNames()[0])
+        with gdal.quiet_errors():
+            assert ar.Read() is None
+        assert "Checksum of index of shard" in gdal.GetLastErrorMsg()
+    finally:
+        gdal.RmdirRecursive(filename)
@@ -163,6 +163,50 @@ def test_gnm_graph_dijkstra():
     dn = None
 
 
+###############################################################################
+# Bidirectional Dijkstra and A* shortest paths
+
+
+@pytest.mark.parametrize("path_search", ["BIDIRECTIONAL", "ASTAR"])
+def test_gnm_graph_path_search(path_search):
+
+    ds = gdal.OpenEx("tmp/test_gnm")
+    dn = gnm.CastToNetwork(ds)
+    assert dn is not None, "cast to GNMNetwork failed"
+
+    lyr = dn.GetPath(61, 50, gnm.GATDijkstraShortestPath)
+    assert lyr is not None, "failed to get path"
+    expected_count = lyr.GetFeatureCount()
+    dn.ReleaseResultSet(lyr)
+    assert expected_count > 0
+
+    lyr = dn.GetPath(
+        61,
+        50,
+        gnm.GATDijkstraShortestPath,
+        options=["path_search=" + path_search],
+    )
+    assert lyr is not None, "failed to get path"
+
+    # Best paths have the same number of vertices and edges
+    assert lyr.GetFeatureCount() == expected_count
+
+    dn.ReleaseResultSet(lyr)
+
+    # Path from a vertex to itself
+    lyr = dn.GetPath(
+        61,
+        61,
+        gnm.GATDijkstraShortestPath,
+        options=["path_search=" + path_search],
+    )
+    assert lyr is not None, "failed to get path"
+    assert lyr.GetFeatureCount() == 1
+    dn.ReleaseResultSet(lyr)
+
+    dn = None
+
+
 ###############################################################################
 # KShortest Paths
 
@@ -2985,6 +2985,82 @@ def test_ogr_csv_getextent3d(tmp_vsimem):
     assert ext3d == (1.0, 2.0, 1.0, 2.0, 1.0, 1.0)
 
 
+###############################################################################
+# Test the native GetNextArrowArray() implementation against the generic one
+
+
+@pytest.mark.parametrize(
+    "open_options,spatial_filter",
+    [
+        ([], None),
+        (["X_POSSIBLE_NAMES=x", "Y_POSSIBLE_NAMES=y"], None),
+        (["X_POSSIBLE_NAMES=x", "Y_POSSIBLE_NAMES=y"], (0.5, 0.5, 10.5, 10.5)),
+        (["GEOM_POSSIBLE_NAMES=wkt", "KEEP_GEOM_COLUMNS=NO"], (0, 0, 1, 1)),
+        (["EMPTY_STRING_AS_NULL=YES", "MERGE_SEPARATOR=YES"], None),
+    ],
+)
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+@gdaltest.enable_exceptions()
+def test_ogr_csv_arrow_stream_native_vs_base(
+    tmp_vsimem, open_options, spatial_filter, num_threads
+):
+
+    pytest.importorskip("osgeo.gdal_array")
+    numpy = pytest.importorskip("numpy")
+
+    filename = tmp_vsimem / "test_ogr_csv_arrow_stream_native_vs_base.csv"
+    content = "int,str,int64,real,x,y,wkt\r\n"
+    for i in range(3000):
+        if i % 100 == 7:
+            content += "\n"
+        elif i % 100 == 13:
+            content += ",,,,,,\r\n"
+        else:
+            content += '%d,"%s",%d,%s,%d,%d,"POINT (%d %d)"\n' % (
+                i,
+                'multi\nline ""quoted"", text' if i % 3 == 0 else "foo%d" % i,
+                1234567890123 * i,
+                '"1,5"' if i % 5 == 0 else str(i / 4),
+                i % 20,
+                i % 30,
+                i % 2,
+                i % 3,
+            )
+    gdal.FileFromMemBuffer(filename, content)
+    gdal.FileFromMemBuffer(
+        str(filename)[0:-3] + "csvt", "Integer,String,Integer64,Real,Real,Real,WKT"
+    )
+
+    def get_batches():
+        ds = gdal.OpenEx(filename, gdal.OF_VECTOR, open_options=open_options)
+        lyr = ds.GetLayer(0)
+        if spatial_filter:
+            lyr.SetSpatialFilterRect(*spatial_filter)
+        stream = lyr.GetArrowStreamAsNumPy(
+            options=["USE_MASKED_ARRAYS=NO", "MAX_FEATURES_IN_BATCH=1000"]
+        )
+        ret = []
+        for batch in stream:
+            ret.append(
+                {
+                    k: [
+                        x.tobytes() if isinstance(x, numpy.ndarray) else str(x)
+                        for x in v
+                    ]
+                    for k, v in batch.items()
+                }
+            )
+        return ret
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+        native_batches = get_batches()
+    with gdaltest.config_option("OGR_CSV_STREAM_BASE_IMPL", "YES"):
+        base_batches = get_batches()
+    assert native_batches == base_batches
+    if spatial_filter is None:
+        assert sum(len(batch["OGC_FID"]) for batch in native_batches) == 2970
+
+
 ###############################################################################
 
 
@@ -1257,3 +1257,124 @@ def test_ogr_flatgeobuf_title_description_metadata(tmp_vsimem):
         "foo": "bar",
         "bar": "baz",
     }
+
+
+###############################################################################
+# Test that reading features by batches, with or without worker threads,
+# returns the same result as reading them one by one
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+@pytest.mark.parametrize("spatial_index", ["YES", "NO"])
+def test_ogr_flatgeobuf_read_num_threads(tmp_vsimem, num_threads, spatial_index):
+
+    filename = str(tmp_vsimem / "test.fgb")
+    ds = ogr.GetDriverByName("FlatGeobuf").CreateDataSource(filename)
+    lyr = ds.CreateLayer(
+        "test", geom_type=ogr.wkbLineString, options=["SPATIAL_INDEX=" + spatial_index]
+    )
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    # More features than a batch, and some features larger than others
+    for i in range(2500):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["str"] = "x" * (i % 100)
+        npoints = 2 + (1000 if (i % 500) == 0 else i % 10)
+        f.SetGeometry(
+            ogr.CreateGeometryFromWkt(
+                "LINESTRING ("
+                + ",".join("%d %d" % (i % 50 + j, i // 50) for j in range(npoints))
+                + ")"
+            )
+        )
+        lyr.CreateFeature(f)
+    ds = None
+
+    def read_features(lyr):
+        return [
+            (f.GetFID(), f["str"], f.GetGeometryRef().ExportToWkt()) for f in lyr
+        ]
+
+    with gdal.config_option("GDAL_NUM_THREADS", "1"):
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        ref_all = read_features(lyr)
+        lyr.SetSpatialFilterRect(10, 10, 20, 20)
+        ref_filtered = read_features(lyr)
+        ref_fid = lyr.GetFeature(1234).GetGeometryRef().ExportToWkt()
+        ds = None
+    assert len(ref_all) == 2500
+    assert len(ref_filtered) > 0
+
+    with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        assert sorted(read_features(lyr)) == sorted(ref_all)
+        lyr.SetSpatialFilterRect(10, 10, 20, 20)
+        assert sorted(read_features(lyr)) == sorted(ref_filtered)
+        assert lyr.GetFeature(1234).GetGeometryRef().ExportToWkt() == ref_fid
+
+        # Arrow stream
+        try:
+            from osgeo import gdal_array  # NOQA
+
+            has_gdal_array = True
+        except ImportError:
+            has_gdal_array = False
+        if has_gdal_array:
+            lyr.SetSpatialFilterRect(10, 10, 20, 20)
+            stream = lyr.GetArrowStreamAsNumPy(["MAX_FEATURES_IN_BATCH=100"])
+            fids = []
+            for batch in stream:
+                fids += [fid for fid in batch["OGC_FID"]]
+            assert sorted(fids) == sorted(x[0] for x in ref_filtered)
+        ds = None
+
+
+###############################################################################
+# Test creating a file with a spatial index, with feature items that do not
+# fit in OGR_FLATGEOBUF_SORT_MAX_RAM
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+@pytest.mark.parametrize("max_ram", ["0.0001", "0.2"])
+@pytest.mark.parametrize("feature_count", [1, 17, 5000])
+def test_ogr_flatgeobuf_write_spatial_index_external_sort(
+    tmp_vsimem, num_threads, max_ram, feature_count
+):
+    def create(filename):
+        ds = ogr.GetDriverByName("FlatGeobuf").CreateDataSource(filename)
+        lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+        lyr.CreateField(ogr.FieldDefn("i", ogr.OFTInteger))
+        for i in range(feature_count):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["i"] = i
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt("POINT (%d %d)" % (i % 50, i // 50))
+            )
+            lyr.CreateFeature(f)
+        ds = None
+
+    ref_filename = str(tmp_vsimem / "ref.fgb")
+    create(ref_filename)
+
+    filename = str(tmp_vsimem / "test.fgb")
+    with gdal.config_options(
+        {"OGR_FLATGEOBUF_SORT_MAX_RAM": max_ram, "GDAL_NUM_THREADS": num_threads}
+    ):
+        create(filename)
+
+    def read_file(filename):
+        f = gdal.VSIFOpenL(filename, "rb")
+        assert f
+        try:
+            return gdal.VSIFReadL(1, gdal.VSIStatL(filename).size, f)
+        finally:
+            gdal.VSIFCloseL(f)
+
+    assert read_file(filename) == read_file(ref_filename)
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == feature_count
+    lyr.SetSpatialFilterRect(9.5, -0.5, 10.5, 0.5)
+    assert [f["i"] for f in lyr] == ([10] if feature_count > 10 else [])
@@ -396,3 +396,42 @@ def test_ogr_geojsonseq_vsigzip():
     ds = None
 
     gdal.Unlink(filename)
+
+
+###############################################################################
+# Test that multithreaded serialization gives the same output as the
+# sequential one
+
+
+def test_ogr_geojsonseq_write_multithreaded(tmp_vsimem):
+    def write(num_threads):
+        filename = str(tmp_vsimem / f"test_ogr_geojsonseq_write_mt_{num_threads}.json")
+        srs = osr.SpatialReference()
+        srs.ImportFromEPSG(32631)
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            ds = ogr.GetDriverByName("GeoJSONSeq").CreateDataSource(filename)
+            lyr = ds.CreateLayer("test", srs=srs)
+        lyr.CreateField(ogr.FieldDefn("str"))
+        for i in range(2500):
+            if i == 1234:
+                # Pending features must be written before the new field
+                # is taken into account
+                lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["str"] = "val%d" % i
+            if i >= 1234:
+                f["real"] = i / 7.0
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt("POINT(%f %f)" % (450000 + i, 5000000 + i))
+            )
+            assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+        assert lyr.GetFeatureCount() == 2500
+        ds = None
+        f = gdal.VSIFOpenL(filename, "rb")
+        data = gdal.VSIFReadL(1, 10 * 1000 * 1000, f)
+        gdal.VSIFCloseL(f)
+        return data
+
+    ref = write("1")
+    assert ref.count(b"\n") == 2500
+    assert write("4") == ref
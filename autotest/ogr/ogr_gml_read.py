@@ -4242,3 +4242,71 @@ def test_ogr_gml_ignore_old_gfs(tmp_path):
         width = defn.GetFieldDefn(1).GetWidth()
 
         assert width == 10
+
+
+###############################################################################
+# Test that building geometries in worker threads gives the same result as
+# the sequential code path
+
+
+@pytest.mark.parametrize("two_layers", [False, True])
+@pytest.mark.parametrize("spatial_filter", [False, True])
+def test_ogr_gml_read_multithreaded_geometry_building(
+    tmp_vsimem, two_layers, spatial_filter
+):
+
+    filename = tmp_vsimem / "test_ogr_gml_read_multithreaded_geometry_building.gml"
+    members = []
+    for i in range(1500):
+        layer = "layer2" if two_layers and i >= 1000 else "layer1"
+        if i == 777:
+            geom = "<gml:Polygon><gml:outerBoundaryIs/></gml:Polygon>"
+        else:
+            x = i % 50
+            y = i // 50
+            geom = (
+                '<gml:Polygon srsName="EPSG:4326"><gml:outerBoundaryIs>'
+                "<gml:LinearRing><gml:coordinates>"
+                f"{x},{y} {x},{y+1} {x+1},{y+1} {x+1},{y} {x},{y}"
+                "</gml:coordinates></gml:LinearRing></gml:outerBoundaryIs>"
+                "</gml:Polygon>"
+            )
+        members.append(
+            f'<gml:featureMember><{layer} fid="{layer}.{i}">'
+            f"<geometry>{geom}</geometry><val>{i}</val>"
+            f"</{layer}></gml:featureMember>"
+        )
+    gdal.FileFromMemBuffer(
+        filename,
+        '<FeatureCollection xmlns:gml="http://www.opengis.net/gml">'
+        + "\n".join(members)
+        + "</FeatureCollection>",
+    )
+
+    def read(num_threads):
+        ret = []
+        with gdal.config_options(
+            {"GDAL_NUM_THREADS": num_threads, "GML_SKIP_CORRUPTED_FEATURES": "YES"}
+        ):
+            ds = ogr.Open(filename)
+            for lyr in ds:
+                if spatial_filter:
+                    lyr.SetSpatialFilterRect(10.5, 3.5, 20.5, 25.5)
+                with gdal.quiet_errors():
+                    for f in lyr:
+                        ret.append(
+                            (
+                                lyr.GetName(),
+                                f.GetFID(),
+                                f["val"],
+                                f.GetGeometryRef().ExportToIsoWkt(),
+                            )
+                        )
+        return ret
+
+    ref = read("1")
+    if spatial_filter:
+        assert len(ref) == 11 * 23
+    else:
+        assert len(ref) == 1499
+    assert read("4") == ref
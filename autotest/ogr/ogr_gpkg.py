@@ -8690,6 +8690,140 @@ def test_ogr_gpkg_background_rtree_build(
     ds = None
 
 
+###############################################################################
+# Test SPATIAL_INDEX_PACKED=YES
+
+
+@pytest.mark.parametrize(
+    "method", ["at_closing", "threaded", "sql_function", "config_option"]
+)
+def test_ogr_gpkg_spatial_index_packed(tmp_vsimem, method):
+    def create(filename, packed):
+        ds = gdaltest.gpkg_dr.CreateDataSource(filename)
+        options = []
+        if method != "config_option":
+            options.append("SPATIAL_INDEX_PACKED=" + packed)
+        if method in ("sql_function", "config_option"):
+            options.append("SPATIAL_INDEX=NO")
+        with gdaltest.config_option(
+            "OGR_GPKG_THREADED_RTREE_AT_FIRST_FEATURE",
+            "YES" if method == "threaded" else None,
+        ):
+            lyr = ds.CreateLayer("foo", options=options)
+        lyr.StartTransaction()
+        # Insertion in scan order, which is unfavorable to the R*Tree insertion
+        # algorithm
+        for i in range(10000):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f.SetGeometryDirectly(
+                ogr.CreateGeometryFromWkt("POINT(%d %d)" % (i % 100, i // 100))
+            )
+            assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+        lyr.CommitTransaction()
+        if method in ("sql_function", "config_option"):
+            with gdaltest.config_option(
+                "OGR_GPKG_SPATIAL_INDEX_PACKED",
+                packed if method == "config_option" else None,
+            ):
+                with ds.ExecuteSQL(
+                    "SELECT CreateSpatialIndex('foo', 'geom')"
+                ) as sql_lyr:
+                    f = sql_lyr.GetNextFeature()
+                    assert f.GetField(0) == 1
+        ds.Close()
+
+        ds = ogr.Open(filename)
+        with ds.ExecuteSQL("SELECT rtreecheck('rtree_foo_geom')") as sql_lyr:
+            f = sql_lyr.GetNextFeature()
+            assert f.GetField(0) == "ok"
+        with ds.ExecuteSQL("SELECT COUNT(*) FROM rtree_foo_geom") as sql_lyr:
+            f = sql_lyr.GetNextFeature()
+            assert f.GetField(0) == 10000
+        lyr = ds.GetLayer(0)
+        for x, y in [(0, 0), (99, 99), (50, 23), (13, 87)]:
+            lyr.SetSpatialFilterRect(x - 1.5, y - 1.5, x + 1.5, y + 1.5)
+            assert lyr.GetFeatureCount() == (
+                (min(x + 1, 99) - max(x - 1, 0) + 1)
+                * (min(y + 1, 99) - max(y - 1, 0) + 1)
+            )
+        with ds.ExecuteSQL("SELECT COUNT(*) FROM rtree_foo_geom_node") as sql_lyr:
+            f = sql_lyr.GetNextFeature()
+            node_count = f.GetField(0)
+        ds.Close()
+        return node_count
+
+    node_count_not_packed = create(tmp_vsimem / "not_packed.gpkg", "NO")
+    node_count_packed = create(tmp_vsimem / "packed.gpkg", "YES")
+    # 10000 / 51 entries per leaf node = 197 leaf nodes, plus 4 branch nodes
+    # and the root node
+    assert node_count_packed == 202
+    assert node_count_packed < node_count_not_packed
+
+
+###############################################################################
+# Test OGR_GPKG_PREFETCH_FEATURES=YES
+
+
+@pytest.mark.parametrize(
+    "filter", [None, "attribute", "spatial", "ignored_fields", "no_result"]
+)
+@pytest.mark.parametrize("interrupt", [None, "reset", "set_next_by_index", "arrow"])
+def test_ogr_gpkg_prefetch_features(tmp_vsimem, filter, interrupt):
+
+    if interrupt == "arrow":
+        pytest.importorskip("osgeo.gdal_array")
+        pytest.importorskip("numpy")
+
+    filename = str(tmp_vsimem / "test_ogr_gpkg_prefetch_features.gpkg")
+    ds = gdaltest.gpkg_dr.CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    lyr.CreateField(ogr.FieldDefn("i", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("s", ogr.OFTString))
+    lyr.StartTransaction()
+    # More than one batch of prefetched features
+    for i in range(2500):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["i"] = i
+        f["s"] = "s%d" % i
+        f.SetGeometryDirectly(
+            ogr.CreateGeometryFromWkt("POINT(%d %d)" % (i % 50, i // 50))
+        )
+        lyr.CreateFeature(f)
+    lyr.CommitTransaction()
+    ds.Close()
+
+    def read(prefetch):
+        with gdaltest.config_option("OGR_GPKG_PREFETCH_FEATURES", prefetch):
+            ds = ogr.Open(filename)
+            lyr = ds.GetLayer(0)
+            if filter == "attribute":
+                lyr.SetAttributeFilter("i % 3 = 0")
+            elif filter == "spatial":
+                lyr.SetSpatialFilterRect(10, 10, 30, 40)
+            elif filter == "ignored_fields":
+                lyr.SetIgnoredFields(["s"])
+            elif filter == "no_result":
+                lyr.SetAttributeFilter("i < 0")
+            ret = []
+            for _ in range(2):
+                for f in lyr:
+                    ret.append(f.DumpReadableAsString())
+                    if len(ret) == 1200:
+                        if interrupt == "reset":
+                            lyr.ResetReading()
+                        elif interrupt == "set_next_by_index":
+                            lyr.SetNextByIndex(2000)
+                        elif interrupt == "arrow":
+                            stream = lyr.GetArrowStreamAsNumPy()
+                            ret += [str(len(batch["i"])) for batch in stream]
+                            break
+                ret.append(lyr.GetFeaturesRead())
+                lyr.ResetReading()
+            return ret
+
+    assert read("YES") == read("NO")
+
+
 ###############################################################################
 
 
@@ -9603,6 +9737,112 @@ def test_ogr_gpkg_write_arrow_fallback_types(tmp_vsimem):
     assert f.GetGeometryRef().ExportToIsoWkt() == "POINT (1 2)"
 
 
+###############################################################################
+# Test that the native WriteArrowBatch() implementation gives the same result
+# as the generic one
+
+
+@gdaltest.enable_exceptions()
+@pytest.mark.parametrize("spatial_index", ["YES", "NO"])
+def test_ogr_gpkg_write_arrow_native_vs_base(tmp_vsimem, spatial_index):
+
+    src_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    src_lyr = src_ds.CreateLayer("test")
+    fld_defn = ogr.FieldDefn("bool", ogr.OFTInteger)
+    fld_defn.SetSubType(ogr.OFSTBoolean)
+    src_lyr.CreateField(fld_defn)
+    fld_defn = ogr.FieldDefn("int16", ogr.OFTInteger)
+    fld_defn.SetSubType(ogr.OFSTInt16)
+    src_lyr.CreateField(fld_defn)
+    src_lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+    src_lyr.CreateField(ogr.FieldDefn("int64", ogr.OFTInteger64))
+    fld_defn = ogr.FieldDefn("float32", ogr.OFTReal)
+    fld_defn.SetSubType(ogr.OFSTFloat32)
+    src_lyr.CreateField(fld_defn)
+    src_lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    src_lyr.CreateField(ogr.FieldDefn("string", ogr.OFTString))
+    src_lyr.CreateField(ogr.FieldDefn("binary", ogr.OFTBinary))
+    src_lyr.CreateField(ogr.FieldDefn("date", ogr.OFTDate))
+    wkts = [
+        "POINT (1 2)",
+        "LINESTRING (1 2,3 4,-5 6)",
+        "POLYGON ((0 0,0 1,1 1,0 0),(0.1 0.1,0.1 0.2,0.2 0.2,0.1 0.1))",
+        "MULTIPOINT ((1 2),(3 4))",
+        "MULTILINESTRING ((1 2,3 4),(5 6,7 8))",
+        "MULTIPOLYGON (((0 0,0 1,1 1,0 0)),((10 10,10 11,11 11,10 10)))",
+        None,
+        "POINT EMPTY",
+        "POLYGON EMPTY",
+        "POINT Z (1 2 3)",
+        "LINESTRING M (1 2 3,4 5 6)",
+        "CIRCULARSTRING (0 0,1 1,2 0)",
+        "GEOMETRYCOLLECTION (POINT (1 2))",
+    ]
+    for i in range(150):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        if i % 7 != 3:
+            f["bool"] = i % 2
+            f["int16"] = -i
+            f["int"] = i * 1000
+            f["int64"] = i * 10000000000
+            f["float32"] = i * 0.25
+            f["real"] = i * 1.5
+            f["string"] = "str%d\xe9" % i
+            f.SetField("binary", b"\x01\x00\xff")
+            f["date"] = "%04d/%02d/%02d" % (1970 + i, 1 + i % 12, 1 + i % 28)
+        else:
+            f.SetFieldNull("int")
+        wkt = wkts[i % len(wkts)]
+        if wkt:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        src_lyr.CreateFeature(f)
+
+    def write(filename, base_impl):
+        ds = gdal.GetDriverByName("GPKG").Create(filename, 0, 0, 0, gdal.GDT_Unknown)
+        lyr = ds.CreateLayer("test", options=["SPATIAL_INDEX=" + spatial_index])
+        assert lyr.TestCapability("FastWriteArrowBatch")
+
+        stream = src_lyr.GetArrowStream(["MAX_FEATURES_IN_BATCH=37"])
+        schema = stream.GetSchema()
+        for i in range(schema.GetChildrenCount()):
+            if schema.GetChild(i).GetName() not in ("wkb_geometry", "OGC_FID"):
+                lyr.CreateFieldFromArrowSchema(schema.GetChild(i))
+
+        with gdaltest.config_option(
+            "OGR_GPKG_WRITE_ARROW_BATCH_BASE_IMPL", base_impl
+        ):
+            while True:
+                array = stream.GetNextRecordBatch()
+                if array is None:
+                    break
+                lyr.WriteArrowBatch(
+                    schema, array, ["FID=OGC_FID", "GEOMETRY_NAME=wkb_geometry"]
+                )
+        ds = None
+
+        ret = []
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        for f in lyr:
+            ret.append(f.DumpReadableAsString())
+        ret.append(lyr.GetExtent())
+        for sql in [
+            "SELECT fid, hex(geom) FROM test",
+            "SELECT z, m FROM gpkg_geometry_columns",
+            "SELECT extension_name FROM gpkg_extensions ORDER BY 1",
+            "SELECT feature_count FROM gpkg_ogr_contents",
+        ] + (["SELECT * FROM rtree_test_geom"] if spatial_index == "YES" else []):
+            with ds.ExecuteSQL(sql) as sql_lyr:
+                for f in sql_lyr:
+                    ret.append([f.GetField(i) for i in range(f.GetFieldCount())])
+        return ret
+
+    native = write(tmp_vsimem / "native.gpkg", "NO")
+    base = write(tmp_vsimem / "base.gpkg", "YES")
+    assert len(native) > 150
+    assert native == base
+
+
 ###############################################################################
 # Test a SQL request with the geometry in the first row being null
 
@@ -481,3 +481,48 @@ def test_ogr_join_23():
     ds.ReleaseResultSet(sql_lyr)
 
     ds = None
+
+
+###############################################################################
+# Test join with the in-memory hash table of the joined layer, and with the
+# fallback to attribute filters
+
+
+@pytest.mark.parametrize("max_memory", [None, "0", "1000"])
+def test_ogr_join_hash_table(max_memory):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("first")
+    lyr.CreateField(ogr.FieldDefn("int_key", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("str_key", ogr.OFTString))
+    for i in range(20):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if i != 4:
+            f["int_key"] = i
+            f["str_key"] = "Key%d" % i
+        lyr.CreateFeature(f)
+
+    lyr = ds.CreateLayer("second")
+    lyr.CreateField(ogr.FieldDefn("int_key", ogr.OFTInteger64))
+    lyr.CreateField(ogr.FieldDefn("str_key", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTString))
+    for i in range(0, 20, 2):
+        for j in range(2):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["int_key"] = i
+            f["str_key"] = "KEY%d" % i
+            f["val"] = "val%d_%d" % (i, j)
+            lyr.CreateFeature(f)
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f["val"] = "null_key"
+    lyr.CreateFeature(f)
+
+    with gdal.config_option("OGR_SQL_JOIN_HASH_MAX_MEMORY", max_memory):
+        for key in ("int_key", "str_key"):
+            with ds.ExecuteSQL(
+                f"SELECT val FROM first JOIN second ON first.{key} = second.{key}"
+            ) as sql_lyr:
+                vals = [f["val"] for f in sql_lyr]
+            assert vals == [
+                "val%d_0" % i if i % 2 == 0 and i != 4 else None for i in range(20)
+            ]
@@ -1740,5 +1740,121 @@ def test_ogr_mvt_write_reuse_temp_db():
     gdal.Unlink("/vsimem/out.temp.db")
 
 
+###############################################################################
+# Test TEMPORARY_STORAGE=FILES, which must produce the same tiles as the
+# temporary SQLite database
+
+
+@pytest.mark.require_driver("SQLite")
+@pytest.mark.require_geos
+@pytest.mark.parametrize("sort_max_ram", [None, "0"])
+@pytest.mark.parametrize("num_threads", [None, "1"])
+def test_ogr_mvt_write_temporary_storage_files(
+    tmp_vsimem, sort_max_ram, num_threads
+):
+
+    src_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    for lyr_name in ("lyr_b", "lyr_a"):
+        lyr = src_ds.CreateLayer(lyr_name)
+        lyr.CreateField(ogr.FieldDefn("str"))
+        lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+        for i in range(20):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["str"] = "val%d" % (i % 3)
+            f["int"] = i
+            x = 100000 * i
+            if i % 2 == 0:
+                f.SetGeometry(ogr.CreateGeometryFromWkt("POINT(%d %d)" % (x, x)))
+            else:
+                f.SetGeometry(
+                    ogr.CreateGeometryFromWkt(
+                        "POLYGON((%d %d,%d %d,%d %d,%d %d))"
+                        % (x, 0, x + 50000, 0, x + 50000, 50000, x, 0)
+                    )
+                )
+            lyr.CreateFeature(f)
+
+    ref_dir = str(tmp_vsimem / "ref")
+    out_dir = str(tmp_vsimem / "out")
+    with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+        gdal.VectorTranslate(ref_dir, src_ds, format="MVT")
+        with gdaltest.config_options(
+            {
+                "OGR_MVT_SORT_MAX_RAM": sort_max_ram,
+                "OGR_MVT_REMOVE_TEMP_FILE": "NO",
+            }
+        ):
+            gdal.VectorTranslate(
+                out_dir,
+                src_ds,
+                format="MVT",
+                datasetCreationOptions=["TEMPORARY_STORAGE=FILES"],
+            )
+
+    # No temporary database must have been created
+    assert gdal.VSIStatL(ref_dir + ".temp.db") is None
+    if sort_max_ram == "0":
+        assert gdal.VSIStatL(out_dir + ".temp.db") is not None
+    else:
+        assert gdal.VSIStatL(out_dir + ".temp.db") is None
+
+    ref_files = sorted(gdal.ReadDirRecursive(ref_dir))
+    assert len(ref_files) > 10
+    assert sorted(gdal.ReadDirRecursive(out_dir)) == ref_files
+    for filename in ref_files:
+        if filename.endswith("/"):
+            continue
+        ref_f = gdal.VSIFOpenL(ref_dir + "/" + filename, "rb")
+        ref_data = gdal.VSIFReadL(1, 10000000, ref_f)
+        gdal.VSIFCloseL(ref_f)
+        out_f = gdal.VSIFOpenL(out_dir + "/" + filename, "rb")
+        out_data = gdal.VSIFReadL(1, 10000000, out_f)
+        gdal.VSIFCloseL(out_f)
+        assert out_data == ref_data, filename
+
+
+###############################################################################
+# Test TEMPORARY_STORAGE=FILES with the MBTiles output
+
+
+@pytest.mark.require_driver("SQLite")
+@pytest.mark.require_geos
+def test_ogr_mvt_write_temporary_storage_files_mbtiles(tmp_vsimem):
+
+    src_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    lyr = src_ds.CreateLayer("mylayer")
+
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f.SetGeometry(ogr.CreateGeometryFromWkt("POINT(500000 1000000)"))
+    lyr.CreateFeature(f)
+
+    out_filename = str(tmp_vsimem / "out.mbtiles")
+    with gdaltest.config_option("OGR_MVT_SORT_MAX_RAM", "0"):
+        out_ds = gdal.VectorTranslate(
+            out_filename, src_ds, datasetCreationOptions=["TEMPORARY_STORAGE=FILES"]
+        )
+    assert out_ds is not None
+    out_ds = None
+
+    assert gdal.VSIStatL(out_filename + ".temp.db") is None
+
+    out_ds = ogr.Open(out_filename)
+    assert out_ds is not None
+    out_lyr = out_ds.GetLayerByName("mylayer")
+    out_f = out_lyr.GetNextFeature()
+    ogrtest.check_feature_geometry(
+        out_f, "MULTIPOINT ((499898.164985053 1000102.07808325))"
+    )
+    out_ds = None
+
+    with gdaltest.config_option("OGR_MVT_REUSE_TEMP_FILE", "YES"):
+        with pytest.raises(Exception, match="not compatible"):
+            gdal.VectorTranslate(
+                str(tmp_vsimem / "out2.mbtiles"),
+                src_ds,
+                datasetCreationOptions=["TEMPORARY_STORAGE=FILES"],
+            )
+
+
 ###############################################################################
 #
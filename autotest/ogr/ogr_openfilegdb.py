@@ -2653,6 +2653,114 @@ def test_ogr_openfilegdb_read_new_datetime_types():
         assert f["MAX_timestamp_offset"] == "2023/12/30 14:01:01"
 
 
+###############################################################################
+# Test the native GetNextArrowArray() implementation against the generic one
+
+
+@pytest.mark.parametrize(
+    "spatial_filter,attr_filter",
+    [
+        (None, None),
+        ((0.5, 0.5, 10.5, 10.5), None),
+        (None, "int >= 5"),
+        ((0.5, 0.5, 10.5, 10.5), "int >= 5"),
+        ((100, 100, 101, 101), None),
+        (None, "str = 'foo8'"),
+    ],
+)
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+@gdaltest.enable_exceptions()
+def test_ogr_openfilegdb_arrow_stream_native_vs_base(
+    tmp_vsimem, spatial_filter, attr_filter, num_threads
+):
+
+    pytest.importorskip("osgeo.gdal_array")
+    numpy = pytest.importorskip("numpy")
+
+    filename = str(tmp_vsimem / "test_ogr_openfilegdb_arrow_stream.gdb")
+    ds = gdal.GetDriverByName("OpenFileGDB").Create(
+        filename, 0, 0, 0, gdal.GDT_Unknown
+    )
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbLineString25D)
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+    fld_defn = ogr.FieldDefn("int16", ogr.OFTInteger)
+    fld_defn.SetSubType(ogr.OFSTInt16)
+    lyr.CreateField(fld_defn)
+    fld_defn = ogr.FieldDefn("float32", ogr.OFTReal)
+    fld_defn.SetSubType(ogr.OFSTFloat32)
+    lyr.CreateField(fld_defn)
+    lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    lyr.CreateField(ogr.FieldDefn("binary", ogr.OFTBinary))
+    lyr.CreateField(ogr.FieldDefn("datetime", ogr.OFTDateTime))
+    for i in range(20):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if i != 3:
+            f["str"] = "foo%d" % i
+            f["int"] = i
+            f["int16"] = -i
+            f["float32"] = 0.5 * i
+            f["real"] = 1.5 * i
+            f.SetField("binary", b"\x01\x23" * i)
+            f["datetime"] = "2024/01/%02d 12:34:%02d" % (i + 1, i)
+        if i == 5:
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt("MULTILINESTRING ((0 0,1 1),(2 2,3 3))")
+            )
+        elif i != 7:
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt(
+                    "LINESTRING Z (%d %d %d,%d %d %d)" % (i, i, i, i + 1, i, i)
+                )
+            )
+        lyr.CreateFeature(f)
+    lyr.DeleteFeature(2)
+    lyr.DeleteFeature(12)
+    ds.ExecuteSQL("CREATE INDEX idx_int ON test(int)")
+    ds.ExecuteSQL("CREATE INDEX idx_str ON test(str)")
+    ds.Close()
+
+    def get_batches():
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        if spatial_filter:
+            lyr.SetSpatialFilterRect(*spatial_filter)
+        if attr_filter:
+            lyr.SetAttributeFilter(attr_filter)
+        stream = lyr.GetArrowStreamAsNumPy(
+            options=["USE_MASKED_ARRAYS=NO", "MAX_FEATURES_IN_BATCH=3"]
+        )
+        ret = []
+        for batch in stream:
+            ret.append(
+                {
+                    k: [
+                        x.tobytes() if isinstance(x, numpy.ndarray) else str(x)
+                        for x in v
+                    ]
+                    for k, v in batch.items()
+                }
+            )
+        return lyr.TestCapability(ogr.OLCFastGetArrowStream), ret
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+        fast_arrow_stream, native_batches = get_batches()
+        assert fast_arrow_stream
+        with gdaltest.config_option("OGR_OPENFILEGDB_STREAM_BASE_IMPL", "YES"):
+            _, base_batches = get_batches()
+
+    # Batches are not necessarily cut at the same rows
+    def concat(batches):
+        return {
+            k: [x for batch in batches for x in batch[k]]
+            for k in (batches[0].keys() if batches else [])
+        }
+
+    assert concat(native_batches) == concat(base_batches)
+    if spatial_filter is None and attr_filter is None:
+        assert len(concat(native_batches)["OBJECTID"]) == 18
+
+
 ###############################################################################
 # Cleanup
 
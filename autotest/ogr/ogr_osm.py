@@ -324,6 +324,16 @@ def test_ogr_osm_3_custom_compress_nodes():
         test_ogr_osm_3()
 
 
+###############################################################################
+# Test ogr2ogr with --config OSM_MAP_NODES_FILE NO and single-threaded
+# node resolution
+
+
+def test_ogr_osm_3_no_nodes_file_view_single_thread():
+    with gdal.config_options({"OSM_MAP_NODES_FILE": "NO", "GDAL_NUM_THREADS": "1"}):
+        test_ogr_osm_3()
+
+
 ###############################################################################
 # Test ogr2ogr with all layers
 
@@ -3065,6 +3065,161 @@ def test_ogr_parquet_bbox_minx_miny_maxx_maxy(tmp_vsimem):
         ds = None
 
 
+###############################################################################
+# Test GeoParquet 1.1 bounding box "covering" column
+
+
+def test_ogr_parquet_bbox_covering(tmp_path):
+
+    pa = pytest.importorskip("pyarrow")
+    pq = pytest.importorskip("pyarrow.parquet")
+
+    outfilename = str(tmp_path / "test_ogr_parquet_bbox_covering.parquet")
+    wkb = []
+    bbox = []
+    for wkt in ["LINESTRING(1 2,3 4)", "LINESTRING(-1 0,1 10)", "POINT(100 100)"]:
+        g = ogr.CreateGeometryFromWkt(wkt)
+        wkb.append(bytes(g.ExportToIsoWkb()))
+        minx, maxx, miny, maxy = g.GetEnvelope()
+        bbox.append({"xmin": minx, "ymin": miny, "xmax": maxx, "ymax": maxy})
+    geo = {
+        "version": "1.1.0",
+        "primary_column": "geometry",
+        "columns": {
+            "geometry": {
+                "encoding": "WKB",
+                "geometry_types": [],
+                "covering": {
+                    "bbox": {
+                        "xmin": ["bbox", "xmin"],
+                        "ymin": ["bbox", "ymin"],
+                        "xmax": ["bbox", "xmax"],
+                        "ymax": ["bbox", "ymax"],
+                    }
+                },
+            }
+        },
+    }
+    table = pa.table({"id": [0, 1, 2], "geometry": wkb, "bbox": bbox})
+    table = table.replace_schema_metadata({"geo": json.dumps(geo)})
+    pq.write_table(table, outfilename, row_group_size=1)
+
+    ds = ogr.Open(outfilename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetGeometryColumn() == "geometry"
+    assert lyr.GetLayerDefn().GetFieldIndex("bbox.xmin") >= 0
+    # Extent computed from the statistics of the bbox.xxxx columns
+    assert lyr.TestCapability(ogr.OLCFastGetExtent) == 1
+    minx, maxx, miny, maxy = lyr.GetExtent()
+    assert (minx, miny, maxx, maxy) == (-1.0, 0.0, 100.0, 100.0)
+
+    with ogrtest.spatial_filter(lyr, 99, 99, 101, 101):
+        assert [f["id"] for f in lyr] == [2]
+
+    with ogrtest.spatial_filter(lyr, -0.5, 2, 0.5, 9):
+        assert [f["id"] for f in lyr] == [1]
+
+    lyr.SetIgnoredFields(["bbox.ymin"])
+    with ogrtest.spatial_filter(lyr, 1, 2, 1, 2):
+        assert [f["id"] for f in lyr] == [0]
+    ds = None
+
+    with gdaltest.config_option("OGR_PARQUET_USE_BBOX", "NO"):
+        ds = ogr.Open(outfilename)
+        lyr = ds.GetLayer(0)
+        assert lyr.TestCapability(ogr.OLCFastGetExtent) == 0
+        with ogrtest.spatial_filter(lyr, 99, 99, 101, 101):
+            assert [f["id"] for f in lyr] == [2]
+        ds = None
+
+
+###############################################################################
+# Test writing row groups in a background thread, or not
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_ogr_parquet_write_row_groups_num_threads(tmp_vsimem, num_threads):
+
+    outfilename = str(tmp_vsimem / "test_ogr_parquet_write_num_threads.parquet")
+    with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+        ds = ogr.GetDriverByName("Parquet").CreateDataSource(outfilename)
+        lyr = ds.CreateLayer("test", options=["ROW_GROUP_SIZE=3"])
+        lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+        for i in range(10):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["id"] = i
+            f.SetGeometry(ogr.CreateGeometryFromWkt("POINT(%d %d)" % (i, i)))
+            lyr.CreateFeature(f)
+        ds = None
+
+    ds = ogr.Open(outfilename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetMetadataItem("NUM_ROW_GROUPS", "_PARQUET_") == "4"
+    assert [f["id"] for f in lyr] == list(range(10))
+    assert lyr.GetExtent() == (0, 9, 0, 9)
+    ds = None
+
+
+###############################################################################
+# Test SORT_BY_BBOX=YES
+
+
+def test_ogr_parquet_write_sort_by_bbox(tmp_vsimem):
+
+    outfilename = str(tmp_vsimem / "test_ogr_parquet_write_sort_by_bbox.parquet")
+    ds = ogr.GetDriverByName("Parquet").CreateDataSource(outfilename)
+    lyr = ds.CreateLayer(
+        "test", options=["SORT_BY_BBOX=YES", "ROW_GROUP_SIZE=4", "FID=fid"]
+    )
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("dt", ogr.OFTDateTime))
+    lyr.CreateField(ogr.FieldDefn("strlist", ogr.OFTStringList))
+    assert lyr.TestCapability(ogr.OLCFastWriteArrowBatch) == 0
+
+    # Interleave points of 4 clusters
+    wkts = []
+    for i in range(4):
+        for (x, y) in [(0, 0), (100, 0), (0, 100), (100, 100)]:
+            wkts.append("POINT(%d %d)" % (x + i, y + i))
+    wkts.append(None)
+    for i, wkt in enumerate(wkts):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["id"] = i
+        f["dt"] = "2022/05/31 12:34:%02d.789+02" % i
+        f["strlist"] = ["a,b", str(i)]
+        if wkt:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    assert lyr.GetFeatureCount() == len(wkts)
+    with gdal.quiet_errors():
+        assert lyr.CreateField(ogr.FieldDefn("other", ogr.OFTInteger)) != 0
+    ds = None
+
+    ds = ogr.Open(outfilename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == len(wkts)
+    assert lyr.GetMetadataItem("NUM_ROW_GROUPS", "_PARQUET_") == "5"
+    got_ids = []
+    for f in lyr:
+        i = f["id"]
+        got_ids.append(i)
+        assert f.GetFID() == i
+        assert f["dt"] == "2022/05/31 12:34:%02d.789+02" % i
+        assert f["strlist"] == ["a,b", str(i)]
+        if wkts[i]:
+            ogrtest.check_feature_geometry(f, wkts[i])
+        else:
+            assert f.GetGeometryRef() is None
+    assert sorted(got_ids) == list(range(len(wkts)))
+    # Each of the 4 first row groups contains a single cluster
+    for i in range(4):
+        cluster = set((got_ids[j] % 4) for j in range(4 * i, 4 * i + 4))
+        assert len(cluster) == 1
+    # Feature without geometry is written last
+    assert got_ids[-1] == len(wkts) - 1
+    ds = None
+
+
 ###############################################################################
 
 
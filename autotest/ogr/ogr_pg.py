@@ -5835,3 +5835,86 @@ def test_ogr_pg_long_identifiers(pg_ds):
     got_lyr = pg_ds.GetLayerByName(long_name)
     assert got_lyr
     assert got_lyr.GetName() == short_name
+
+
+###############################################################################
+# Test binary COPY, binary cursors and prefetching of cursor pages
+
+
+@pytest.mark.parametrize("binary", ("YES", "NO"))
+def test_ogr_pg_binary_copy_and_cursor(pg_ds, use_postgis, binary):
+
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+    with gdal.config_options(
+        {"PG_USE_BINARY_COPY": binary, "PG_USE_BINARY_CURSOR": binary}
+    ):
+        lyr = pg_ds.CreateLayer(
+            "test_ogr_pg_binary", geom_type=ogr.wkbPoint, srs=srs
+        )
+        fld_defn = ogr.FieldDefn("bool", ogr.OFTInteger)
+        fld_defn.SetSubType(ogr.OFSTBoolean)
+        lyr.CreateField(fld_defn)
+        lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+        lyr.CreateField(ogr.FieldDefn("int64", ogr.OFTInteger64))
+        lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+        fld_defn = ogr.FieldDefn("str", ogr.OFTString)
+        fld_defn.SetWidth(5)
+        lyr.CreateField(fld_defn)
+        lyr.CreateField(ogr.FieldDefn("date", ogr.OFTDate))
+        lyr.CreateField(ogr.FieldDefn("bin", ogr.OFTBinary))
+
+        for i in range(1203):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            if i % 10 != 0:
+                f["bool"] = i % 2
+                f["int"] = -i
+                f["int64"] = 1234567890123 * i
+                f["real"] = i + 0.5
+                f["str"] = "éa\t\\" + str(i)
+                f["date"] = "%04d/02/%02d" % (1900 + i % 200, 1 + i % 28)
+                f.SetFieldBinaryFromHexString("bin", "00FF%04X" % i)
+                f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT ({i} {-i})"))
+            assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+
+    with gdal.config_options(
+        {"PG_USE_BINARY_CURSOR": binary, "OGR_PG_CURSOR_PAGE": "100"}
+    ):
+        ds = reconnect(pg_ds, update=0)
+        lyr = ds.GetLayerByName("test_ogr_pg_binary")
+
+        count = 0
+        for f in lyr:
+            i = f.GetFID() - 1
+            if i % 10 == 0:
+                assert f.GetGeometryRef() is None
+                assert not f.IsFieldSet("int")
+            else:
+                assert f["bool"] == i % 2
+                assert f["int"] == -i
+                assert f["int64"] == 1234567890123 * i
+                assert f["real"] == i + 0.5
+                assert f["str"] == ("éa\t\\" + str(i))[0:5]
+                assert f["date"] == "%04d/02/%02d" % (1900 + i % 200, 1 + i % 28)
+                assert f.GetFieldAsBinary("bin") == bytes.fromhex("00FF%04X" % i)
+                geom = f.GetGeometryRef()
+                assert geom.ExportToWkt() == f"POINT ({i} {-i})"
+                if use_postgis:
+                    assert geom.GetSpatialReference().GetAuthorityCode(None) == "4326"
+
+            # Interleave commands on the connection while the next page
+            # may be pending
+            if count == 150:
+                assert lyr.GetFeature(5)["int"] == -4
+                with ds.ExecuteSQL(
+                    'SELECT COUNT(*) FROM test_ogr_pg_binary WHERE "int" IS NOT NULL'
+                ) as sql_lyr:
+                    assert sql_lyr.GetNextFeature().GetField(0) == 1082
+            count += 1
+        assert count == 1203
+
+        assert lyr.SetNextByIndex(1101) == ogr.OGRERR_NONE
+        assert lyr.GetNextFeature().GetFID() == 1102
+        assert lyr.GetNextFeature().GetFID() == 1103
+
+    pg_ds.ExecuteSQL("DELLAYER:test_ogr_pg_binary")
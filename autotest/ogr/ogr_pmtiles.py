@@ -585,6 +585,68 @@ def test_ogr_pmtiles_write():
             gdal.Unlink(filename)
 
 
+###############################################################################
+# Test that tiles are directly written in clustered mode, with deduplication
+
+
+@pytest.mark.require_driver("MBTiles")
+# MBTiles vector writing mode requires SQLite and GEOS
+@pytest.mark.require_driver("SQLite")
+@pytest.mark.require_geos
+@pytest.mark.parametrize("in_vsimem", [True, False])
+def test_ogr_pmtiles_write_direct_clustered_deduplication(tmp_path, in_vsimem):
+
+    if in_vsimem:
+        filename = "/vsimem/test_ogr_pmtiles_write_direct.pmtiles"
+    else:
+        filename = str(tmp_path / "test_ogr_pmtiles_write_direct.pmtiles")
+    try:
+        ds = ogr.GetDriverByName("PMTiles").CreateDataSource(
+            filename, options=["MINZOOM=2", "MAXZOOM=2"]
+        )
+        lyr = ds.CreateLayer("test")
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometry(
+            ogr.CreateGeometryFromWkt(
+                "POLYGON((-20000000 -20000000,-20000000 20000000,20000000 20000000,20000000 -20000000,-20000000 -20000000))"
+            )
+        )
+        lyr.CreateFeature(f)
+        ds = None
+
+        # No intermediate MBTiles file must be left behind
+        assert gdal.VSIStatL(filename + ".tmp.mbtiles") is None
+
+        f = gdal.VSIFOpenL(f"/vsipmtiles/{filename}/pmtiles_header.json", "rb")
+        assert f
+        try:
+            data = gdal.VSIFReadL(1, 10000, f)
+        finally:
+            gdal.VSIFCloseL(f)
+        got = json.loads(data)
+
+        expected = {
+            "clustered": True,
+            "addressed_tiles_count": 16,
+            "tile_contents_count": 9,
+            "tile_entries_count": 13,
+        }
+
+        for key in expected:
+            assert got[key] == expected[key], (key, got)
+
+        ds = ogr.Open(filename)
+        assert ds.GetLayerCount() == 1
+        assert ds.GetMetadataItem("ZOOM_LEVEL") == "2"
+        lyr = ds.GetLayer(0)
+        assert lyr.GetFeatureCount() > 0
+        ds = None
+
+    finally:
+        if gdal.VSIStatL(filename):
+            gdal.Unlink(filename)
+
+
 ###############################################################################
 
 
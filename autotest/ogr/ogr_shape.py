@@ -5856,3 +5856,107 @@ def test_ogr_shape_write_date_0000_00_00(tmp_vsimem):
     lyr = ds.GetLayer(0)
     f = lyr.GetNextFeature()
     assert f.IsFieldNull("date")
+
+
+###############################################################################
+# Test the native GetNextArrowArray() implementation against the generic one
+
+
+@pytest.mark.parametrize(
+    "spatial_filter", [None, (0.5, 0.5, 2.5, 2.5), (100, 100, 101, 101)]
+)
+@gdaltest.enable_exceptions()
+def test_ogr_shape_arrow_stream_native_vs_base(tmp_vsimem, spatial_filter):
+
+    pytest.importorskip("osgeo.gdal_array")
+    numpy = pytest.importorskip("numpy")
+
+    filename = tmp_vsimem / "test_ogr_shape_arrow_stream_native_vs_base.shp"
+    ds = gdal.GetDriverByName("ESRI Shapefile").Create(
+        filename, 0, 0, 0, gdal.GDT_Unknown
+    )
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbLineString25D)
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+    fld_defn = ogr.FieldDefn("int64", ogr.OFTInteger64)
+    fld_defn.SetWidth(18)
+    lyr.CreateField(fld_defn)
+    lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    lyr.CreateField(ogr.FieldDefn("date", ogr.OFTDate))
+    for i in range(10):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if i != 3:
+            f["str"] = "foo%d" % i
+            f["int"] = i
+            f["int64"] = 1234567890123 * i
+            f["real"] = 1.5 * i
+            f["date"] = "2024/01/%02d" % (i + 1)
+        if i == 5:
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt("MULTILINESTRING ((0 0,1 1),(2 2,3 3))")
+            )
+        elif i != 7:
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt(
+                    "LINESTRING Z (%d %d %d,%d %d %d)" % (i, i, i, i + 1, i, i)
+                )
+            )
+        lyr.CreateFeature(f)
+    lyr.DeleteFeature(1)
+    ds.Close()
+
+    def get_batches():
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        if spatial_filter:
+            lyr.SetSpatialFilterRect(*spatial_filter)
+        stream = lyr.GetArrowStreamAsNumPy(
+            options=["USE_MASKED_ARRAYS=NO", "MAX_FEATURES_IN_BATCH=3"]
+        )
+        ret = []
+        for batch in stream:
+            ret.append(
+                {
+                    k: [
+                        x.tobytes() if isinstance(x, numpy.ndarray) else str(x)
+                        for x in v
+                    ]
+                    for k, v in batch.items()
+                }
+            )
+        return ret
+
+    native_batches = get_batches()
+    with gdaltest.config_option("OGR_SHAPE_STREAM_BASE_IMPL", "YES"):
+        base_batches = get_batches()
+    assert native_batches == base_batches
+    if spatial_filter is None:
+        assert sum(len(batch["OGC_FID"]) for batch in native_batches) == 9
+
+
+###############################################################################
+# Test reading a .qix spatial index ingested in memory
+
+
+def test_ogr_shape_spatial_index_in_memory(tmp_path):
+
+    for ext in ("shp", "shx", "dbf"):
+        shutil.copy(f"data/poly.{ext}", tmp_path / f"poly.{ext}")
+    with ogr.Open(tmp_path / "poly.shp", update=1) as ds:
+        ds.ExecuteSQL("CREATE SPATIAL INDEX ON poly")
+    assert (tmp_path / "poly.qix").exists()
+
+    def get_fids():
+        with ogr.Open(tmp_path / "poly.shp") as ds:
+            lyr = ds.GetLayer(0)
+            lyr.SetSpatialFilterRect(479750, 4764000, 480000, 4765000)
+            return [f.GetFID() for f in lyr]
+
+    with gdaltest.config_option("SHAPE_SPATIAL_INDEX_IN_MEMORY", "NO"):
+        ref_fids = get_fids()
+    assert 0 < len(ref_fids) < 10
+    with gdaltest.config_option("SHAPE_SPATIAL_INDEX_IN_MEMORY", "YES"):
+        assert get_fids() == ref_fids
+        assert gdal.ReadDir("/vsimem/") is None or not [
+            x for x in gdal.ReadDir("/vsimem/") if x.startswith("shape_")
+        ]
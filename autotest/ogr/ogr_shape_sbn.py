@@ -142,3 +142,15 @@ def test_ogr_shape_sbn_2():
     ds = ogr.Open("data/shp/CoHI_GCS12.shp")
     lyr = ds.GetLayer(0)
     return search_all_features(lyr)
+
+
+###############################################################################
+# Test with the .sbn file ingested in memory
+
+
+def test_ogr_shape_sbn_in_memory():
+
+    with gdaltest.config_option("SHAPE_SPATIAL_INDEX_IN_MEMORY", "YES"):
+        ds = ogr.Open("data/shp/CoHI_GCS12.shp")
+        lyr = ds.GetLayer(0)
+        search_all_features(lyr)
@@ -2477,3 +2477,75 @@ def test_ogr_sql_sqlite_like_utf8():
         dialect="SQLite",
     ) as sql_lyr:
         assert sql_lyr.GetFeatureCount() == 0
+
+
+###############################################################################
+# Test reading a layer with a fast GetArrowStream() implementation through its
+# ArrowArrayStream
+
+
+@pytest.mark.require_driver("GPKG")
+def test_ogr_sql_sqlite_arrow_stream(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test_ogr_sql_sqlite_arrow_stream.gpkg")
+    ds = ogr.GetDriverByName("GPKG").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+    fld_defn = ogr.FieldDefn("bool", ogr.OFTInteger)
+    fld_defn.SetSubType(ogr.OFSTBoolean)
+    lyr.CreateField(fld_defn)
+    lyr.CreateField(ogr.FieldDefn("int64", ogr.OFTInteger64))
+    lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("bin", ogr.OFTBinary))
+    lyr.CreateField(ogr.FieldDefn("date", ogr.OFTDate))
+    for i in range(100):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if i % 7 != 0:
+            f["int"] = i * 3 - 100
+        f["bool"] = i % 2
+        if i % 5 != 0:
+            f["int64"] = i * 10000000000
+        f["real"] = i / 7
+        if i % 4 != 0:
+            f["str"] = "val%d" % (i % 13)
+        if i % 3 == 0:
+            f.SetFieldBinaryFromHexString("bin", "%02X00FF" % i)
+        if i % 6 != 0:
+            f["date"] = "%04d/%02d/%02d" % (1950 + i, 1 + i % 12, 1 + i % 28)
+        if i % 9 != 0:
+            f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (%d %d)" % (i, -i)))
+        lyr.CreateFeature(f)
+    ds = None
+
+    ds = ogr.Open(filename)
+
+    def get_result(sql, use_arrow_stream):
+        with gdal.config_option(
+            "OGR_SQLITE_DIALECT_USE_ARROW_STREAM", use_arrow_stream
+        ):
+            with ds.ExecuteSQL(sql, dialect="INDIRECT_SQLITE") as sql_lyr:
+                return [
+                    (
+                        [f.GetField(i) for i in range(f.GetFieldCount())],
+                        f.GetGeometryRef().ExportToIsoWkt()
+                        if f.GetGeometryRef()
+                        else None,
+                    )
+                    for f in sql_lyr
+                ]
+
+    for sql in [
+        "SELECT * FROM test",
+        "SELECT * FROM test WHERE int > 50 AND str = 'val3'",
+        "SELECT fid, int, geom FROM test WHERE int64 IS NULL",
+        "SELECT COUNT(*), SUM(int), MAX(str), MIN(date) FROM test",
+        "SELECT str, COUNT(*), AVG(real) FROM test GROUP BY str ORDER BY str",
+        "SELECT hex(bin), bool FROM test WHERE bin IS NOT NULL",
+        "SELECT OGR_STYLE, int FROM test",
+    ]:
+        assert get_result(sql, "YES") == get_result(sql, "NO"), sql
+
+    assert get_result("SELECT date FROM test WHERE fid = 2", "YES") == [
+        (["1951/02/02"], None)
+    ]
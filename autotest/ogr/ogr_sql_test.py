@@ -1858,3 +1858,223 @@ def test_ogr_sql_ilike_utf8():
 
     lyr.SetAttributeFilter("'éven' ILIKE '%xen'")
     assert lyr.GetFeatureCount() == 0
+
+
+###############################################################################
+# Check that the flat evaluation of simple attribute filters gives the same
+# result as the generic evaluation
+
+
+@pytest.mark.parametrize(
+    "where",
+    [
+        "i = 3",
+        "i <> 3",
+        "i < 3",
+        "i <= 3.5",
+        "i >= 2.5",
+        "3 < i",
+        "i BETWEEN -2 AND 4",
+        "i IN (1, 2, 3)",
+        "i IN (1.5, 2)",
+        "i IS NULL",
+        "i IS NOT NULL",
+        "NOT (i = 3)",
+        "i = 3 OR i = 4 OR r > 2",
+        "i > 0 AND r < 0 AND s = 'a'",
+        "i64 = 1099511627776",
+        "i64 < 2.5",
+        "i64 IN (1, -3)",
+        "r = 1.25",
+        "r BETWEEN -1 AND 1.5",
+        "r IN (1, 2.5)",
+        "s = 'abc'",
+        "s <> 'ABC'",
+        "s < 'b'",
+        "s IN ('a', 'zz')",
+        "s BETWEEN 'a' AND 'b'",
+        "s = ''",
+        "s IS NULL",
+        "FID < 20 OR FID > 90",
+        "FID IN (1, 2, 3)",
+        "10 = FID",
+        "dt IS NULL",
+        "NOT (i IS NULL OR s IS NULL)",
+        "(i = 1 OR i = 2) AND NOT (r > 0 OR s = 'a')",
+        "i + 1 = 3",
+        "s LIKE 'a%'",
+    ],
+)
+def test_ogr_sql_attribute_filter_compiled(where):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("i", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("i64", ogr.OFTInteger64))
+    lyr.CreateField(ogr.FieldDefn("r", ogr.OFTReal))
+    lyr.CreateField(ogr.FieldDefn("s", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("dt", ogr.OFTDateTime))
+    strings = ["a", "B", "abc", "ABC", "10", "2", "", "zz"]
+    for k in range(100):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetFID(k)
+        if k % 7 != 0:
+            f["i"] = (k * 7) % 21 - 10
+        if k % 5 != 0:
+            f["i64"] = (k * 3) % 21 - 10 + ((1 << 40) if k % 9 == 0 else 0)
+        if k % 6 != 0:
+            f["r"] = ((k * 11) % 41 - 20) / 4.0
+        if k % 4 != 0:
+            f["s"] = strings[k % len(strings)]
+        if k % 3 != 0:
+            f["dt"] = "2020/01/02 03:04:05"
+        lyr.CreateFeature(f)
+
+    def get_fids():
+        lyr.SetAttributeFilter(where)
+        return [f.GetFID() for f in lyr]
+
+    with gdal.config_option("OGR_FEATURE_QUERY_COMPILE", "NO"):
+        expected = get_fids()
+    assert get_fids() == expected
+
+
+###############################################################################
+# Test ORDER BY on a layer without efficient random read, with the features
+# sorted in memory, or through sorted runs in a temporary file
+
+
+@pytest.mark.parametrize("max_memory", [None, "1000", "0"])
+@pytest.mark.parametrize(
+    "sql",
+    [
+        "SELECT * FROM test ORDER BY i",
+        "SELECT * FROM test ORDER BY i DESC, s",
+        "SELECT * FROM test ORDER BY s LIMIT 1",
+        "SELECT * FROM test ORDER BY i LIMIT 5 OFFSET 10",
+        "SELECT i, s FROM test WHERE i > 3 ORDER BY r DESC, FID",
+    ],
+)
+def test_ogr_sql_order_by_sort_features(tmp_vsimem, max_memory, sql):
+
+    mem_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    mem_lyr = mem_ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    mem_lyr.CreateField(ogr.FieldDefn("i", ogr.OFTInteger))
+    mem_lyr.CreateField(ogr.FieldDefn("s", ogr.OFTString))
+    mem_lyr.CreateField(ogr.FieldDefn("r", ogr.OFTReal))
+    for k in range(50):
+        f = ogr.Feature(mem_lyr.GetLayerDefn())
+        if k % 7 != 0:
+            f["i"] = (k * 7) % 11
+        f["s"] = "val%d" % ((k * 3) % 13)
+        f["r"] = ((k * 11) % 17) / 4.0
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (%d %d)" % (k, -k)))
+        mem_lyr.CreateFeature(f)
+
+    filename = str(tmp_vsimem / "test.csv")
+    gdal.VectorTranslate(
+        filename, mem_ds, options="-lco GEOMETRY=AS_WKT -lco CREATE_CSVT=YES"
+    )
+    csv_ds = ogr.Open(filename)
+    assert not csv_ds.GetLayer(0).TestCapability(ogr.OLCRandomRead)
+
+    def get_rows(ds):
+        sql_lyr = ds.ExecuteSQL(sql)
+        try:
+            return [
+                (f["i"], f["s"], f.GetGeometryRef().ExportToWkt()) for f in sql_lyr
+            ]
+        finally:
+            ds.ReleaseResultSet(sql_lyr)
+
+    expected = get_rows(mem_ds)
+    with gdal.config_option("OGR_SQL_ORDER_BY_MAX_MEMORY", max_memory):
+        assert get_rows(csv_ds) == expected
+
+
+###############################################################################
+# Test GROUP BY
+
+
+def test_ogr_sql_group_by():
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    lyr.CreateField(ogr.FieldDefn("i", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("s", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("r", ogr.OFTReal))
+    for k in range(50):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if k % 7 != 0:
+            f["i"] = k % 3
+        f["s"] = "val%d" % (k % 2)
+        f["r"] = k / 4.0
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (%d %d)" % (k, -k)))
+        lyr.CreateFeature(f)
+
+    def expected_row(i):
+        ks = [k for k in range(50) if (None if k % 7 == 0 else k % 3) == i]
+        vals = [k / 4.0 for k in ks]
+        return (i, len(ks), sum(vals), min(vals), max(vals), sum(vals) / len(ks))
+
+    with ds.ExecuteSQL(
+        "SELECT i, COUNT(*), SUM(r), MIN(r), MAX(r), AVG(r) FROM test "
+        "GROUP BY i ORDER BY i"
+    ) as sql_lyr:
+        assert sql_lyr.GetLayerDefn().GetFieldDefn(1).GetType() == ogr.OFTInteger
+        assert sql_lyr.GetGeomType() == ogr.wkbNone
+        assert sql_lyr.GetFeatureCount() == 4
+        rows = [tuple(f.GetField(j) for j in range(6)) for f in sql_lyr]
+        assert rows == [expected_row(i) for i in (None, 0, 1, 2)]
+
+    with ds.ExecuteSQL(
+        "SELECT i, COUNT(*) FROM test GROUP BY i ORDER BY i DESC LIMIT 2 OFFSET 1"
+    ) as sql_lyr:
+        assert [(f["i"], f["COUNT_*"]) for f in sql_lyr] == [
+            (1, expected_row(1)[1]),
+            (0, expected_row(0)[1]),
+        ]
+
+    # Groups are returned in the order in which they are first met
+    with ds.ExecuteSQL(
+        "SELECT s, i, COUNT(r) AS cnt FROM test WHERE i IS NOT NULL GROUP BY s, i"
+    ) as sql_lyr:
+        rows = [(f["s"], f["i"], f["cnt"]) for f in sql_lyr]
+        keys = []
+        for k in range(50):
+            if k % 7 != 0 and ("val%d" % (k % 2), k % 3) not in keys:
+                keys.append(("val%d" % (k % 2), k % 3))
+        assert [(s, i) for s, i, _ in rows] == keys
+        assert sum(cnt for _, _, cnt in rows) == len(
+            [k for k in range(50) if k % 7 != 0]
+        )
+
+    with ds.ExecuteSQL(
+        "SELECT s, COUNT(DISTINCT i) FROM test GROUP BY s ORDER BY s"
+    ) as sql_lyr:
+        assert [(f.GetField(0), f.GetField(1)) for f in sql_lyr] == [
+            ("val0", 3),
+            ("val1", 3),
+        ]
+
+
+@pytest.mark.parametrize(
+    "sql",
+    [
+        "SELECT i, s FROM test GROUP BY i",
+        "SELECT i + 1, COUNT(*) FROM test GROUP BY i",
+        "SELECT DISTINCT i FROM test GROUP BY i",
+        "SELECT i, COUNT(*) FROM test GROUP BY i ORDER BY s",
+        "SELECT COUNT(*) FROM test GROUP BY non_existing",
+        'SELECT COUNT(*) FROM test GROUP BY "_ogr_geometry_"',
+    ],
+)
+def test_ogr_sql_group_by_errors(sql):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    lyr.CreateField(ogr.FieldDefn("i", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("s", ogr.OFTString))
+
+    with gdal.quiet_errors():
+        assert ds.ExecuteSQL(sql) is None
@@ -1643,6 +1643,77 @@ def test_ogr_vrt_29(tmp_path):
         assert ret.find("INFO") != -1 and ret.find("ERROR") == -1
 
 
+###############################################################################
+# Test OGRVRTWarpedLayer::GetArrowStream(), which reprojects whole batches
+
+
+@pytest.mark.require_driver("GPKG")
+def test_ogr_vrt_warped_arrow_stream(tmp_path):
+    pytest.importorskip("osgeo.gdal_array")
+    pytest.importorskip("numpy")
+
+    ds = ogr.GetDriverByName("GPKG").CreateDataSource(tmp_path / "warped_arrow.gpkg")
+    sr = osr.SpatialReference()
+    sr.ImportFromEPSG(4326)
+    lyr = ds.CreateLayer("warped_arrow", srs=sr)
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    for i, wkt in enumerate(
+        [
+            "POINT (2 49)",
+            None,
+            "LINESTRING (2 49,3 50)",
+            "POLYGON ((2 49,2 50,3 50,2 49))",
+            "POINT (-180 91)",  # reprojection will fail
+        ]
+    ):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["id"] = i
+        if wkt:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    ds = None
+
+    ds = ogr.Open(
+        f"""<OGRVRTDataSource>
+        <OGRVRTWarpedLayer>
+            <OGRVRTLayer name="warped_arrow">
+                <SrcDataSource>{tmp_path}/warped_arrow.gpkg</SrcDataSource>
+            </OGRVRTLayer>
+            <TargetSRS>EPSG:32631</TargetSRS>
+        </OGRVRTWarpedLayer>
+    </OGRVRTDataSource>"""
+    )
+    lyr = ds.GetLayer(0)
+
+    with gdal.quiet_errors():
+        expected = [
+            (f["id"], f.GetGeometryRef().Clone() if f.GetGeometryRef() else None)
+            for f in lyr
+        ]
+
+    stream = lyr.GetArrowStreamAsNumPy(options=["USE_MASKED_ARRAYS=NO"])
+    with gdal.quiet_errors():
+        batches = [batch for batch in stream]
+    got = []
+    for batch in batches:
+        for id, wkb in zip(batch["id"], batch["geom"]):
+            got.append((id, ogr.CreateGeometryFromWkb(wkb) if wkb else None))
+
+    assert len(got) == len(expected)
+    for (got_id, got_geom), (exp_id, exp_geom) in zip(got, expected):
+        assert got_id == exp_id
+        if exp_geom is None:
+            assert got_geom is None
+        else:
+            ogrtest.check_feature_geometry(got_geom, exp_geom)
+
+    # Spatial filter: fallback to the generic implementation
+    lyr.SetSpatialFilterRect(400000, 5400000, 500000, 5500000)
+    stream = lyr.GetArrowStreamAsNumPy(options=["USE_MASKED_ARRAYS=NO"])
+    batches = [batch for batch in stream]
+    assert sum(len(batch["id"]) for batch in batches) == lyr.GetFeatureCount()
+
+
 ###############################################################################
 # Test OGRVRTUnionLayer
 
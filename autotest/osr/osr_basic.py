@@ -2472,3 +2472,77 @@ def test_osr_basic_has_point_motion_operation():
     srs = osr.SpatialReference()
     srs.ImportFromEPSG(8255)  # NAD83(CSRS)v7
     assert srs.HasPointMotionOperation()
+
+
+###############################################################################
+# Test that IsSame() shortcuts and cached results do not survive modifications
+
+
+def test_osr_basic_is_same_after_modification():
+
+    for i in range(2):
+        srs1 = osr.SpatialReference()
+        srs1.ImportFromEPSG(32631)
+        srs2 = osr.SpatialReference()
+        srs2.SetFromUserInput(srs1.ExportToWkt())
+        assert srs1.IsSame(srs2)
+        assert srs1.Clone().IsSame(srs2)
+
+        srs2.SetProjParm(osr.SRS_PP_FALSE_EASTING, 1)
+        assert not srs1.IsSame(srs2)
+
+        srs3 = osr.SpatialReference()
+        srs3.ImportFromEPSG(32631)
+        srs3.SetLinearUnits("foot", 0.3048)
+        assert not srs1.IsSame(srs3)
+
+        srs4 = osr.SpatialReference()
+        srs4.ImportFromEPSG(4326)
+        srs5 = osr.SpatialReference()
+        srs5.ImportFromEPSG(4258)
+        assert not srs4.IsSame(srs5)
+        assert srs4.IsSame(srs5, ["CRITERION=EQUIVALENT"]) == srs4.IsSame(
+            srs5, ["CRITERION=EQUIVALENT"]
+        )
+
+        srs6 = osr.SpatialReference()
+        srs6.SetFromUserInput("EPSG:4326+5773")
+        srs7 = osr.SpatialReference()
+        srs7.SetFromUserInput("EPSG:4326+5773")
+        assert srs6.IsSame(srs7)
+        srs7.StripVertical()
+        assert not srs6.IsSame(srs7)
+        assert srs7.IsSame(srs4)
+
+
+###############################################################################
+# Test State Plane lookups from several threads, with the CSV tables preloaded
+# into the process-wide cache
+
+
+def test_osr_basic_state_plane_shared_csv_cache():
+
+    with gdal.config_option("GDAL_PRELOAD_CSV_TABLES", "YES"):
+        gdal.AllRegister()
+
+    errors = []
+
+    def check():
+        for _ in range(10):
+            srs = osr.SpatialReference()
+            srs.SetStatePlane(403, 1)  # California III NAD83.
+            if srs.GetProjParm(osr.SRS_PP_FALSE_EASTING, -1111) != 2000000.0:
+                errors.append(srs.ExportToWkt())
+
+    threads = [Thread(target=check) for _ in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert not errors
+
+    with gdal.config_option("CPL_CSV_SHARED_CACHE", "NO"):
+        t = Thread(target=check)
+        t.start()
+        t.join()
+    assert not errors
@@ -241,6 +241,37 @@ def test_rgb2pct_3(script_path, tmp_path, rgb2pct2_tif):
     ds = None
 
 
+###############################################################################
+# Test rgb2pct -ovr option
+
+
+def test_rgb2pct_ovr(script_path, tmp_path):
+
+    src_tif = str(tmp_path / "rgbsmall_with_ovr.tif")
+    output_tif = str(tmp_path / "test_rgb2pct_ovr.tif")
+
+    gdal.Translate(src_tif, test_py_scripts.get_data_path("gcore") + "rgbsmall.tif")
+    with gdal.Open(src_tif, gdal.GA_Update) as ds:
+        ds.BuildOverviews("NEAR", [2])
+        ovr_bands = [ds.GetRasterBand(i + 1).GetOverview(0) for i in range(3)]
+        expected_ct = gdal.ColorTable()
+        gdal.ComputeMedianCutPCT(
+            ovr_bands[0], ovr_bands[1], ovr_bands[2], 16, expected_ct
+        )
+        ovr_bands = None
+
+    test_py_scripts.run_py_script(
+        script_path, "rgb2pct", f"-n 16 -ovr 0 {src_tif} {output_tif}"
+    )
+
+    with gdal.Open(output_tif) as ds:
+        assert ds.RasterXSize == 50
+        ct = ds.GetRasterBand(1).GetRasterColorTable()
+        assert [ct.GetColorEntry(i) for i in range(16)] == [
+            expected_ct.GetColorEntry(i) for i in range(16)
+        ]
+
+
 ###############################################################################
 # Test pct2rgb with big CT (>256 entries)
 
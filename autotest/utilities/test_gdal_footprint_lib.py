@@ -722,3 +722,38 @@ def test_gdal_footprint_lib_srcNodata_and_ovr_mutually_exclusive():
         gdal.Footprint(
             "", "../gcore/data/byte.tif", format="Memory", srcNodata=0, ovr=0
         )
+
+
+###############################################################################
+#
+
+
+@pytest.mark.parametrize("split_polys", [False, True])
+def test_gdal_footprint_lib_num_threads(split_polys):
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 300, 1000)
+    src_ds.SetGeoTransform([2, 1, 0, 49, 0, -1])
+    # Polygons crossing, and not crossing, the boundaries of the strips, with
+    # holes and concave shapes
+    src_ds.GetRasterBand(1).WriteRaster(10, 10, 100, 900, b"\xff" * (100 * 900))
+    src_ds.GetRasterBand(1).WriteRaster(30, 30, 20, 700, b"\x00" * (20 * 700))
+    src_ds.GetRasterBand(1).WriteRaster(110, 240, 50, 40, b"\xff" * (50 * 40))
+    src_ds.GetRasterBand(1).WriteRaster(200, 10, 50, 300, b"\xff" * (50 * 300))
+    src_ds.GetRasterBand(1).WriteRaster(200, 500, 80, 480, b"\xff" * (80 * 480))
+    src_ds.GetRasterBand(1).WriteRaster(220, 600, 20, 300, b"\x00" * (20 * 300))
+
+    ds = gdal.Footprint("", src_ds, format="Memory", splitPolys=split_polys)
+    lyr = ds.GetLayer(0)
+    expected_geoms = [f.GetGeometryRef().Clone() for f in lyr]
+
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        ds = gdal.Footprint("", src_ds, format="Memory", splitPolys=split_polys)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == len(expected_geoms)
+    got_geoms = [f.GetGeometryRef().Clone() for f in lyr]
+    if split_polys:
+        got_geoms.sort(key=lambda g: g.GetEnvelope())
+        expected_geoms.sort(key=lambda g: g.GetEnvelope())
+    for got_geom, expected_geom in zip(got_geoms, expected_geoms):
+        assert got_geom.GetGeometryCount() == expected_geom.GetGeometryCount()
+        assert got_geom.Equals(expected_geom)
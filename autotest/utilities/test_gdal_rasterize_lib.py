@@ -790,3 +790,53 @@ def test_gdal_rasterize_lib_dict_arguments():
     ind = opt.index("-co")
 
     assert opt[ind : ind + 4] == ["-co", "COMPRESS=DEFLATE", "-co", "LEVEL=4"]
+
+
+###############################################################################
+# Test that using several threads gives the same result as a single one
+
+
+@pytest.mark.parametrize("add", [False, True])
+@pytest.mark.parametrize("all_touched", [False, True])
+def test_gdal_rasterize_lib_num_threads(add, all_touched):
+
+    vector_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0)
+    layer = vector_ds.CreateLayer("layer")
+    layer.CreateField(ogr.FieldDefn("val", ogr.OFTReal))
+    for i in range(200):
+        x = (i * 37) % 190
+        y = (i * 53) % 190
+        size = 2 + (i * 7) % 30
+        if i % 3 == 0:
+            wkt = f"LINESTRING ({x} {y},{x + size} {y + size / 2})"
+        elif i % 3 == 1:
+            wkt = f"MULTIPOINT (({x + 0.5} {y + 0.5}),({x + 1.5} {y + 5.5}))"
+        else:
+            wkt = (
+                f"POLYGON (({x} {y},{x} {y + size},{x + size} {y + size},"
+                + f"{x + size} {y},{x} {y}))"
+            )
+        feature = ogr.Feature(layer.GetLayerDefn())
+        feature.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        feature["val"] = i + 1
+        layer.CreateFeature(feature)
+
+    def rasterize(num_threads):
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            ds = gdal.Rasterize(
+                "",
+                vector_ds,
+                format="MEM",
+                outputType=gdal.GDT_Float64,
+                outputBounds=[0, 0, 200, 220],
+                width=200,
+                height=220,
+                attribute="val",
+                add=add,
+                allTouched=all_touched,
+            )
+        return ds.GetRasterBand(1).ReadRaster()
+
+    ref = rasterize("1")
+    assert ref != b"\x00" * len(ref)
+    assert rasterize("4") == ref
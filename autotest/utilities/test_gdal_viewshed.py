@@ -29,6 +29,8 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import struct
+
 import gdaltest
 import pytest
 import test_cli_utilities
@@ -159,6 +161,54 @@ def test_gdal_viewshed_alternative_modes(gdal_viewshed_path, tmp_path, viewshed_
     assert nodata is None
 
 
+###############################################################################
+# Test cumulative viewshed from several observers
+
+
+@pytest.mark.parametrize("num_threads", [1, 2])
+def test_gdal_viewshed_cumulative(
+    gdal_viewshed_path, tmp_path, viewshed_input, num_threads
+):
+
+    observers = [(ox[0], oy[0]), (ox[0] + 3000, oy[0] - 2000)]
+
+    expected = None
+    for i, (x, y) in enumerate(observers):
+        viewshed_out = str(tmp_path / f"test_gdal_viewshed_out_{i}.tif")
+        _, err = gdaltest.runexternal_out_and_err(
+            gdal_viewshed_path
+            + " -vv 1 -oz {} -ox {} -oy {} {} {}".format(
+                oz[0], x, y, viewshed_input, viewshed_out
+            )
+        )
+        assert err is None or err == ""
+        ds = gdal.Open(viewshed_out)
+        ar = ds.GetRasterBand(1).ReadRaster(buf_type=gdal.GDT_UInt32)
+        ds = None
+        ar = struct.unpack("I" * (len(ar) // 4), ar)
+        expected = ar if expected is None else [a + b for a, b in zip(expected, ar)]
+
+    viewshed_out = str(tmp_path / "test_gdal_viewshed_out.tif")
+    _, err = gdaltest.runexternal_out_and_err(
+        gdal_viewshed_path
+        + " --config GDAL_NUM_THREADS {} -oz {} {} {} {}".format(
+            num_threads,
+            oz[0],
+            " ".join("-ox {} -oy {}".format(x, y) for x, y in observers),
+            viewshed_input,
+            viewshed_out,
+        )
+    )
+    assert err is None or err == ""
+    ds = gdal.Open(viewshed_out)
+    assert ds.GetRasterBand(1).DataType == gdal.GDT_UInt32
+    ar = ds.GetRasterBand(1).ReadRaster()
+    ds = None
+    got = struct.unpack("I" * (len(ar) // 4), ar)
+    assert list(got) == list(expected)
+    assert max(got) == 2
+
+
 ###############################################################################
 
 
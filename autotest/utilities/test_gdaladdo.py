@@ -324,3 +324,42 @@ def test_gdaladdo_partial_refresh_from_source_extent(gdaladdo_path, tmp_path):
             ovr_data_refreshed[idx] = ovr_data_ori[idx]
     assert ovr_data_refreshed == ovr_data_ori
     ds = None
+
+
+###############################################################################
+# Test processing several files, sequentially and concurrently
+
+
+@pytest.mark.parametrize("num_threads", ["1", "2"])
+def test_gdaladdo_several_files(gdaladdo_path, tmp_path, num_threads):
+
+    filenames = []
+    for i in range(3):
+        filename = str(tmp_path / f"test_gdaladdo_several_files_{i}.tif")
+        shutil.copyfile("../gcore/data/nodata_byte.tif", filename)
+        filenames.append(filename)
+
+    _, err = gdaltest.runexternal_out_and_err(
+        f"{gdaladdo_path} --config GDAL_NUM_THREADS {num_threads} -r average "
+        + " ".join(filenames)
+        + " 2 4"
+    )
+    assert "ERROR" not in err
+
+    for filename in filenames:
+        ds = gdal.Open(filename)
+        assert ds.GetRasterBand(1).GetOverviewCount() == 2
+        assert ds.GetRasterBand(1).GetOverview(0).Checksum() == 1130
+
+    # Non-existing file
+    _, err = gdaltest.runexternal_out_and_err(
+        f"{gdaladdo_path} --config GDAL_NUM_THREADS {num_threads} -clean "
+        + filenames[0]
+        + " "
+        + str(tmp_path / "non_existing.tif")
+        + " "
+        + filenames[1]
+    )
+    assert "non_existing.tif" in err
+    assert gdal.Open(filenames[0]).GetRasterBand(1).GetOverviewCount() == 0
+    assert gdal.Open(filenames[1]).GetRasterBand(1).GetOverviewCount() == 0
@@ -35,7 +35,7 @@ import struct
 import gdaltest
 import pytest
 
-from osgeo import gdal
+from osgeo import gdal, ogr
 
 ###############################################################################
 # Simple test
@@ -748,3 +748,70 @@ def test_gdalbuildvrt_lib_stable_average():
     vrt_gt = vrt_ds.GetGeoTransform()
 
     assert vrt_gt == gt
+
+
+###############################################################################
+# Test -footprint
+
+
+@pytest.mark.require_geos
+def test_gdalbuildvrt_lib_footprint(tmp_vsimem):
+
+    src1_filename = str(tmp_vsimem / "src1.tif")
+    src_ds = gdal.GetDriverByName("GTiff").Create(src1_filename, 20, 20)
+    src_ds.SetGeoTransform([0, 1, 0, 20, 0, -1])
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).WriteRaster(0, 0, 10, 10, b"\x01" * 100)
+    src_ds = None
+
+    src2_filename = str(tmp_vsimem / "src2.tif")
+    src_ds = gdal.GetDriverByName("GTiff").Create(src2_filename, 20, 20)
+    src_ds.SetGeoTransform([0, 1, 0, 20, 0, -1])
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).WriteRaster(10, 10, 10, 10, b"\x02" * 100)
+    src_ds = None
+
+    ref_ds = gdal.BuildVRT("", [src1_filename, src2_filename])
+
+    vrt_filename = str(tmp_vsimem / "out.vrt")
+    gdal.BuildVRT(vrt_filename, [src1_filename, src2_filename], options="-footprint")
+    ds = gdal.Open(vrt_filename)
+    xml = ds.GetMetadata("xml:VRT")[0]
+    footprints = [
+        ogr.CreateGeometryFromWkt(x.split("</Footprint>")[0]).GetEnvelope()
+        for x in xml.split("<Footprint>")[1:]
+    ]
+    assert footprints == [(0, 10, 0, 10), (10, 20, 10, 20)]
+    assert ds.ReadRaster() == ref_ds.ReadRaster()
+    assert ds.ReadRaster(2, 2, 3, 3) == ref_ds.ReadRaster(2, 2, 3, 3)
+
+
+###############################################################################
+# Test opening sources concurrently
+
+
+def test_gdalbuildvrt_lib_num_threads(tmp_vsimem):
+
+    filenames = []
+    for i in range(10):
+        filename = str(tmp_vsimem / f"src_{i}.tif")
+        ds = gdal.GetDriverByName("GTiff").Create(filename, 10, 10)
+        ds.SetGeoTransform([2 + i, 0.1, 0, 49 + (i % 3), 0, -0.1])
+        ds.GetRasterBand(1).Fill(i + 1)
+        ds = None
+        filenames.append(filename)
+    filenames.insert(5, str(tmp_vsimem / "i_dont_exist.tif"))
+
+    ref_ds = gdal.BuildVRT("", filenames)
+    with gdal.config_option("GDAL_NUM_THREADS", "4"), gdaltest.error_handler():
+        ds = gdal.BuildVRT("", filenames)
+        assert "i_dont_exist.tif" in gdal.GetLastErrorMsg()
+    assert ds.GetGeoTransform() == ref_ds.GetGeoTransform()
+    assert ds.RasterXSize == ref_ds.RasterXSize
+    assert ds.RasterYSize == ref_ds.RasterYSize
+    assert ds.GetMetadata("xml:VRT")[0] == ref_ds.GetMetadata("xml:VRT")[0]
+    assert ds.GetRasterBand(1).Checksum() == ref_ds.GetRasterBand(1).Checksum()
+
+    with gdal.config_option("GDAL_NUM_THREADS", "4"), gdal.ExceptionMgr():
+        with pytest.raises(Exception, match="i_dont_exist.tif"):
+            gdal.BuildVRT("", filenames, strict=True)
@@ -715,3 +715,38 @@ def test_gdaldem_lib_dict_arguments():
     ind = opt.index("-co")
 
     assert opt[ind : ind + 4] == ["-co", "COMPRESS=DEFLATE", "-co", "LEVEL=4"]
+
+
+###############################################################################
+# Test that multi-threaded processing gives the same result as single-threaded
+
+
+@pytest.mark.parametrize(
+    "processing,options",
+    [
+        ("hillshade", {}),
+        ("slope", {}),
+        ("slope", {"alg": "ZevenbergenThorne", "slopeFormat": "percent"}),
+        ("aspect", {}),
+        ("aspect", {"alg": "ZevenbergenThorne", "trigonometric": True}),
+        ("roughness", {"computeEdges": True}),
+    ],
+)
+@pytest.mark.parametrize("src_type", [gdal.GDT_Int16, gdal.GDT_Float32])
+def test_gdaldem_lib_num_threads(processing, options, src_type):
+
+    src_ds = gdal.Translate(
+        "", "../gdrivers/data/n43.tif", format="MEM", outputType=src_type
+    )
+
+    with gdal.config_option("GDAL_NUM_THREADS", "1"):
+        ds = gdal.DEMProcessing(
+            "", src_ds, processing, format="MEM", scale=111120, **options
+        )
+    expected_data = ds.GetRasterBand(1).ReadRaster()
+
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        ds = gdal.DEMProcessing(
+            "", src_ds, processing, format="MEM", scale=111120, **options
+        )
+    assert ds.GetRasterBand(1).ReadRaster() == expected_data
@@ -277,3 +277,23 @@ def test_gdaltindex_6(gdaltindex_path, tmp_path, four_tiles, option):
         "got %d features, expecting 1" % lyr.GetFeatureCount()
     )
     ds = None
+
+
+###############################################################################
+# Test opening files concurrently
+
+
+def test_gdaltindex_num_threads(gdaltindex_path, tmp_path, four_tiles):
+
+    index_filename = str(tmp_path / "test_gdaltindex_num_threads.shp")
+    (_, err) = gdaltest.runexternal_out_and_err(
+        f"{gdaltindex_path} --config GDAL_NUM_THREADS 4 {index_filename} "
+        + " ".join(four_tiles[0:2])
+        + f" {tmp_path}/i_dont_exist.tif "
+        + " ".join(four_tiles[2:4])
+    )
+    assert "i_dont_exist.tif" in err
+
+    ds = ogr.Open(index_filename)
+    lyr = ds.GetLayer(0)
+    assert [f.GetField(0) for f in lyr] == four_tiles
@@ -572,3 +572,37 @@ def test_nearblack_lib_dict_arguments():
     ind = opt.index("-co")
 
     assert opt[ind : ind + 4] == ["-co", "COMPRESS=DEFLATE", "-co", "LEVEL=4"]
+
+
+###############################################################################
+# Test that the multi-threaded two passes algorithm gives the same result as
+# the single-threaded one
+
+
+@pytest.mark.parametrize("maxNonBlack", [0, 2])
+def test_nearblack_lib_twopasses_num_threads(maxNonBlack):
+
+    src_ds = gdal.Warp(
+        "",
+        "../gdrivers/data/rgbsmall.tif",
+        format="MEM",
+        warpOptions=["INIT_DEST=0"],
+        srcNodata=0,
+        width=80,
+        height=60,
+    )
+
+    def get_checksums():
+        ds = gdal.Nearblack(
+            "",
+            src_ds,
+            format="MEM",
+            maxNonBlack=maxNonBlack,
+            setAlpha=True,
+            alg="twopasses",
+        )
+        return [ds.GetRasterBand(i + 1).Checksum() for i in range(ds.RasterCount)]
+
+    ref_cs = get_checksums()
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        assert get_checksums() == ref_cs
@@ -31,6 +31,7 @@
 
 import collections
 import json
+import math
 import pathlib
 import tempfile
 
@@ -1165,6 +1166,50 @@ def test_ogr2ogr_lib_clipsrc_discard_lower_dimensionality():
     ds = None
 
 
+###############################################################################
+# Test spatial filter and -clipsrc with a complex clip polygon, that gets
+# subdivided internally by the prepared geometry logic
+
+
+@pytest.mark.require_geos
+def test_ogr2ogr_lib_clipsrc_complex_polygon():
+
+    # Star-shaped polygon with 4000 vertices
+    ring = ogr.Geometry(ogr.wkbLinearRing)
+    N = 4000
+    for i in range(N + 1):
+        angle = 2 * math.pi * (i % N) / N
+        radius = 10 if (i % 2) == 0 else 9
+        ring.AddPoint_2D(radius * math.cos(angle), radius * math.sin(angle))
+    clip_geom = ogr.Geometry(ogr.wkbPolygon)
+    clip_geom.AddGeometry(ring)
+
+    srcDS = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    srcLayer = srcDS.CreateLayer("test", geom_type=ogr.wkbPoint)
+    srcLayer.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    expected_ids = set()
+    for i in range(-24, 25):
+        for j in range(-24, 25):
+            f = ogr.Feature(srcLayer.GetLayerDefn())
+            f["id"] = 1000 * (i + 100) + j + 100
+            g = ogr.CreateGeometryFromWkt("POINT(%f %f)" % (i * 0.5, j * 0.5))
+            f.SetGeometry(g)
+            srcLayer.CreateFeature(f)
+            if clip_geom.Intersects(g):
+                expected_ids.add(f["id"])
+    assert expected_ids
+
+    srcLayer.SetSpatialFilter(clip_geom)
+    assert set(f["id"] for f in srcLayer) == expected_ids
+    srcLayer.SetSpatialFilter(None)
+
+    ds = gdal.VectorTranslate(
+        "", srcDS, format="Memory", clipSrc=clip_geom.ExportToWkt()
+    )
+    lyr = ds.GetLayer(0)
+    assert set(f["id"] for f in lyr) == expected_ids
+
+
 ###############################################################################
 # Test -clipsrc with a clip layer with an invalid polygon
 
@@ -2232,6 +2277,130 @@ def test_ogr2ogr_lib_OGR2OGR_USE_ARROW_API_YES(limit):
     )
 
 
+###############################################################################
+# Test reprojection with the Arrow interface
+
+
+def test_ogr2ogr_lib_OGR2OGR_USE_ARROW_API_YES_reproject():
+
+    src_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+    srs.SetAxisMappingStrategy(osr.OAMS_TRADITIONAL_GIS_ORDER)
+    src_lyr = src_ds.CreateLayer("test", srs=srs)
+    for wkt in [
+        "POINT (2 49)",
+        None,
+        "LINESTRING Z (2 49 10,3 50 20)",
+        "CIRCULARSTRING (2 49,2.5 49.5,3 49)",
+        "MULTIPOLYGON (((2 49,2 50,3 50,2 49)))",
+    ]:
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        if wkt:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        src_lyr.CreateFeature(f)
+
+    def translate(use_arrow_api):
+        got_msg = []
+
+        def my_handler(errorClass, errno, msg):
+            got_msg.append(msg)
+            return
+
+        with gdaltest.error_handler(my_handler), gdaltest.config_options(
+            {"CPL_DEBUG": "ON", "OGR2OGR_USE_ARROW_API": use_arrow_api}
+        ):
+            out_ds = gdal.VectorTranslate(
+                "", src_ds, format="Memory", dstSRS="EPSG:32631", reproject=True
+            )
+        assert ("OGR2OGR: Using WriteArrowBatch()" in got_msg) == (
+            use_arrow_api == "YES"
+        )
+        return out_ds
+
+    out_ds = translate("YES")
+    ref_ds = translate("NO")
+    out_lyr = out_ds.GetLayer(0)
+    ref_lyr = ref_ds.GetLayer(0)
+    assert out_lyr.GetSpatialRef().GetAuthorityCode(None) == "32631"
+    assert out_lyr.GetFeatureCount() == ref_lyr.GetFeatureCount()
+    for f, f_ref in zip(out_lyr, ref_lyr):
+        if f_ref.GetGeometryRef() is None:
+            assert f.GetGeometryRef() is None
+        else:
+            ogrtest.check_feature_geometry(f, f_ref.GetGeometryRef())
+
+
+###############################################################################
+# Test -select, -where and -spat with the Arrow interface
+
+
+@pytest.mark.require_driver("GPKG")
+@pytest.mark.parametrize(
+    "where,expected_arrow", [(None, True), ("a >= 2", True), ("b = 'b3'", False)]
+)
+def test_ogr2ogr_lib_OGR2OGR_USE_ARROW_API_YES_select(
+    tmp_vsimem, where, expected_arrow
+):
+
+    src_filename = str(tmp_vsimem / "src.gpkg")
+    src_ds = gdal.GetDriverByName("GPKG").Create(
+        src_filename, 0, 0, 0, gdal.GDT_Unknown
+    )
+    src_lyr = src_ds.CreateLayer("test")
+    src_lyr.CreateField(ogr.FieldDefn("a", ogr.OFTInteger))
+    src_lyr.CreateField(ogr.FieldDefn("b"))
+    src_lyr.CreateField(ogr.FieldDefn("c", ogr.OFTReal))
+    for i in range(5):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f["a"] = i
+        f["b"] = "b%d" % i
+        f["c"] = i + 0.5
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (%d %d)" % (i, i)))
+        src_lyr.CreateFeature(f)
+    src_ds.Close()
+
+    src_ds = gdal.OpenEx(src_filename)
+
+    def translate(use_arrow_api):
+        got_msg = []
+
+        def my_handler(errorClass, errno, msg):
+            got_msg.append(msg)
+            return
+
+        with gdaltest.error_handler(my_handler), gdaltest.config_options(
+            {"CPL_DEBUG": "ON", "OGR2OGR_USE_ARROW_API": use_arrow_api}
+        ):
+            out_ds = gdal.VectorTranslate(
+                "",
+                src_ds,
+                format="Memory",
+                selectFields=["c", "a"],
+                where=where,
+                spatFilter=[0.5, 0.5, 3.5, 3.5],
+            )
+        assert ("OGR2OGR: Using WriteArrowBatch()" in got_msg) == (
+            use_arrow_api == "YES" and expected_arrow
+        )
+        return out_ds
+
+    out_ds = translate("YES")
+    ref_ds = translate("NO")
+    out_lyr = out_ds.GetLayer(0)
+    ref_lyr = ref_ds.GetLayer(0)
+    out_defn = out_lyr.GetLayerDefn()
+    assert [
+        out_defn.GetFieldDefn(i).GetName() for i in range(out_defn.GetFieldCount())
+    ] == ["c", "a"]
+    assert out_lyr.GetFeatureCount() == ref_lyr.GetFeatureCount()
+    assert out_lyr.GetFeatureCount() > 0
+    for f, f_ref in zip(out_lyr, ref_lyr):
+        assert f["a"] == f_ref["a"]
+        assert f["c"] == f_ref["c"]
+        ogrtest.check_feature_geometry(f, f_ref.GetGeometryRef())
+
+
 ###############################################################################
 # Test JSON types roundtrip
 
@@ -2446,3 +2615,58 @@ def test_ogr2ogr_lib_gpkg_to_shp_truncated_field_names(tmp_vsimem):
     f = out_lyr.GetNextFeature()
     assert f["shortname"] == "foo"
     assert f["too_long_f"] == "bar"
+
+
+###############################################################################
+# Test that geometry operations done in parallel give the same result as
+# sequentially
+
+
+@pytest.mark.require_geos
+@pytest.mark.parametrize("num_threads", ["2", "ALL_CPUS"])
+def test_ogr2ogr_lib_geometry_operations_multithreaded(num_threads):
+
+    src_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+    src_lyr = src_ds.CreateLayer("test", srs=srs)
+    src_lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    for i in range(2500):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f["id"] = i
+        x = (i % 50) * 0.1
+        y = (i // 50) * 0.1
+        f.SetGeometry(
+            ogr.CreateGeometryFromWkt(
+                f"POLYGON(({x} {y},{x} {y + 0.15},{x + 0.15} {y + 0.15},"
+                f"{x + 0.15} {y},{x} {y}))"
+            )
+        )
+        src_lyr.CreateFeature(f)
+
+    def translate(**kwargs):
+        return gdal.VectorTranslate(
+            "",
+            src_ds,
+            format="Memory",
+            dstSRS="EPSG:32631",
+            clipSrc=[0.5, 0.5, 4.5, 4.5],
+            **kwargs,
+        )
+
+    ref_ds = translate()
+    with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+        out_ds = translate()
+
+    ref_lyr = ref_ds.GetLayer(0)
+    out_lyr = out_ds.GetLayer(0)
+    assert out_lyr.GetFeatureCount() == ref_lyr.GetFeatureCount()
+    assert out_lyr.GetFeatureCount() > 0
+    for ref_f, out_f in zip(ref_lyr, out_lyr):
+        assert out_f["id"] == ref_f["id"]
+        assert out_f.GetGeometryRef().Equals(ref_f.GetGeometryRef())
+
+    # Test -limit
+    with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+        out_ds = translate(limit=1500)
+    assert out_ds.GetLayer(0).GetFeatureCount() < ref_lyr.GetFeatureCount()
@@ -237,6 +237,8 @@ else ()
 
   check_function_exists(pread64 HAVE_PREAD64)
 
+  check_function_exists(posix_fadvise HAVE_POSIX_FADVISE)
+
   check_function_exists(ftruncate64 HAVE_FTRUNCATE64)
   if (HAVE_FTRUNCATE64)
     set(VSI_FTRUNCATE64 "ftruncate64")
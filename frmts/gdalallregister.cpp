@@ -30,6 +30,7 @@
 #include "gdal_priv.h"
 #include "gdal_frmts.h"
 #include "ogrsf_frmts.h"
+#include "cpl_csv.h"
 
 #ifdef GNM_ENABLED
 #include "gnm_frmts.h"
@@ -107,6 +108,34 @@ void CPL_DLL GDALRegisterPlugins(void)
     poDriverManager->ReorderDrivers();
 }
 
+/************************************************************************/
+/*                        GDALPreloadCSVTables()                        */
+/*                                                                      */
+/*      Ingest the CSV files of the GDAL data directory into the        */
+/*      process-wide cache of CSV tables.                               */
+/************************************************************************/
+
+static void GDALPreloadCSVTables()
+
+{
+    const std::string osDataDir = CPLGetPath(CSVFilename("stateplane.csv"));
+    if (osDataDir.empty())
+        return;
+
+    const CPLStringList aosFiles(VSIReadDir(osDataDir.c_str()));
+    int nPreloaded = 0;
+    for (const char *pszFile : aosFiles)
+    {
+        if (EQUAL(CPLGetExtension(pszFile), "csv") &&
+            CSVPreload(CPLFormFilename(osDataDir.c_str(), pszFile, nullptr)))
+        {
+            nPreloaded++;
+        }
+    }
+    CPLDebug("GDAL", "%d CSV tables preloaded from %s", nPreloaded,
+             osDataDir.c_str());
+}
+
 /************************************************************************/
 /*                          GDALAllRegister()                           */
 /*                                                                      */
@@ -122,6 +151,10 @@ void CPL_DLL GDALRegisterPlugins(void)
  *
  * This function should generally be called once at the beginning of the
  * application.
+ *
+ * Starting with GDAL 3.9, if the GDAL_PRELOAD_CSV_TABLES configuration option
+ * is set to YES, the CSV tables of the GDAL data directory are also ingested
+ * into memory, so that processes forked afterwards share them.
  */
 
 void CPL_STDCALL GDALAllRegister()
@@ -832,4 +865,7 @@ void CPL_STDCALL GDALAllRegister()
     poDriverManager->AutoSkipDrivers();
 
     poDriverManager->ReorderDrivers();
+
+    if (CPLTestBool(CPLGetConfigOption("GDAL_PRELOAD_CSV_TABLES", "NO")))
+        GDALPreloadCSVTables();
 }
@@ -70,13 +70,27 @@ static bool HasZSTDCompression()
 /*                           GetTmpFilename()                           */
 /************************************************************************/
 
-static CPLString GetTmpFilename(const char *pszFilename, const char *pszExt)
+// dfUncompressedSize is the estimated uncompressed size of the content of the
+// temporary file. If it is not greater than the COG_TMP_MEMORY_MAX_SIZE
+// configuration option, the temporary file is created in /vsimem/, which
+// avoids any disk I/O and scratch space needs for it.
+static CPLString GetTmpFilename(const char *pszFilename, const char *pszExt,
+                                double dfUncompressedSize)
 {
+    const double dfMaxMemorySize =
+        CPLAtof(CPLGetConfigOption("COG_TMP_MEMORY_MAX_SIZE", "0"));
     const bool bSupportsRandomWrite =
         VSISupportsRandomWrite(pszFilename, false);
     CPLString osTmpFilename;
-    if (!bSupportsRandomWrite ||
-        CPLGetConfigOption("CPL_TMPDIR", nullptr) != nullptr)
+    if (dfUncompressedSize <= dfMaxMemorySize)
+    {
+        osTmpFilename = "/vsimem/";
+        osTmpFilename += CPLGetFilename(
+            CPLGenerateTempFilename(CPLGetBasename(pszFilename)));
+        CPLDebug("COG", "Using in-memory temporary file for %s", pszExt);
+    }
+    else if (!bSupportsRandomWrite ||
+             CPLGetConfigOption("CPL_TMPDIR", nullptr) != nullptr)
     {
         osTmpFilename = CPLGenerateTempFilename(CPLGetBasename(pszFilename));
     }
@@ -643,8 +657,10 @@ static std::unique_ptr<GDALDataset> CreateReprojectedDS(
 
     int bHasNoData = FALSE;
     poSrcDS->GetRasterBand(1)->GetNoDataValue(&bHasNoData);
-    if (!bHasNoData &&
-        CPLTestBool(CSLFetchNameValueDef(papszOptions, "ADD_ALPHA", "YES")))
+    const bool bAddAlpha =
+        !bHasNoData &&
+        CPLTestBool(CSLFetchNameValueDef(papszOptions, "ADD_ALPHA", "YES"));
+    if (bAddAlpha)
     {
         papszArg = CSLAddString(papszArg, "-dstalpha");
     }
@@ -689,7 +705,10 @@ static std::unique_ptr<GDALDataset> CreateReprojectedDS(
     CPLDebug("COG", "Reprojecting source dataset: start");
     GDALWarpAppOptionsSetProgress(psOptions, GDALScaledProgress,
                                   pScaledProgress);
-    CPLString osTmpFile(GetTmpFilename(pszDstFilename, "warped.tif.tmp"));
+    CPLString osTmpFile(GetTmpFilename(
+        pszDstFilename, "warped.tif.tmp",
+        double(nXSize) * nYSize * (nBands + (bAddAlpha ? 1 : 0)) *
+            GDALGetDataTypeSizeBytes(poFirstBand->GetRasterDataType())));
     auto hSrcDS = GDALDataset::ToHandle(poSrcDS);
 
     std::unique_ptr<CPLConfigOptionSetter> poWarpThreadSetter;
@@ -1118,10 +1137,15 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     aosOverviewOptions.SetNameValue("BIGTIFF", "YES");
     aosOverviewOptions.SetNameValue("SPARSE_OK", "YES");
 
+    double dfOverviewPixels = 0;
+    for (const auto &oOvrDim : asOverviewDims)
+        dfOverviewPixels += double(oOvrDim.first) * oOvrDim.second;
+
     if (bGenerateMskOvr)
     {
         CPLDebug("COG", "Generating overviews of the mask: start");
-        m_osTmpMskOverviewFilename = GetTmpFilename(pszFilename, "msk.ovr.tmp");
+        m_osTmpMskOverviewFilename =
+            GetTmpFilename(pszFilename, "msk.ovr.tmp", dfOverviewPixels);
         GDALRasterBand *poSrcMask = poFirstBand->GetMaskBand();
         const char *pszResampling = CSLFetchNameValueDef(
             papszOptions, "OVERVIEW_RESAMPLING",
@@ -1151,7 +1175,10 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     if (bGenerateOvr)
     {
         CPLDebug("COG", "Generating overviews of the imagery: start");
-        m_osTmpOverviewFilename = GetTmpFilename(pszFilename, "ovr.tmp");
+        m_osTmpOverviewFilename = GetTmpFilename(
+            pszFilename, "ovr.tmp",
+            dfOverviewPixels * nBands *
+                GDALGetDataTypeSizeBytes(poFirstBand->GetRasterDataType()));
         std::vector<GDALRasterBand *> apoSrcBands;
         for (int i = 0; i < nBands; i++)
             apoSrcBands.push_back(poCurDS->GetRasterBand(i + 1));
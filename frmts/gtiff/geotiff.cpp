@@ -936,6 +936,8 @@ void GTiffOneTimeInit()
 static void GDALDeregister_GTiff(GDALDriver *)
 
 {
+    GTiffDataset::ClearSRSCache();
+
 #ifdef HAVE_JXL
     if (pJXLCodec)
         TIFFUnRegisterCODEC(pJXLCodec);
@@ -1371,6 +1373,13 @@ void GDALRegister_GTiff()
         "   </Option>"
         "   <Option name='SPARSE_OK' type='boolean' description='Should empty "
         "blocks be omitted on disk?' default='FALSE'/>"
+        "   <Option name='BLOCK_STATISTICS' type='boolean' "
+        "description='Whether statistics of each block should be maintained "
+        "in a .blockstats file' default='NO'/>"
+        "   <Option name='STRILE_RESERVE' type='int' min='0' "
+        "description='Percentage of extra space reserved after each "
+        "compressed tile/strip, to allow rewriting it in place later' "
+        "default='0'/>"
         "   <Option name='ALPHA' type='string-select' description='Mark first "
         "extrasample as being alpha'>"
         "       <Value>NON-PREMULTIPLIED</Value>"
@@ -1450,6 +1459,7 @@ void GDALRegister_GTiff()
     /* -------------------------------------------------------------------- */
     poDriver->SetDescription("GTiff");
     poDriver->SetMetadataItem(GDAL_DCAP_RASTER, "YES");
+    poDriver->SetMetadataItem(GDAL_DCAP_PARALLEL_CLONE_READ, "YES");
     poDriver->SetMetadataItem(GDAL_DMD_LONGNAME, "GeoTIFF");
     poDriver->SetMetadataItem(GDAL_DMD_HELPTOPIC, "drivers/raster/gtiff.html");
     poDriver->SetMetadataItem(GDAL_DMD_MIMETYPE, "image/tiff");
@@ -1480,6 +1490,13 @@ void GDALRegister_GTiff()
         "   <Option name='IGNORE_COG_LAYOUT_BREAK' type='boolean' "
         "description='Allow update mode on files with COG structure' "
         "default='FALSE'/>"
+        "   <Option name='BLOCK_STATISTICS' type='boolean' "
+        "description='Whether statistics of each block should be maintained "
+        "in a .blockstats file' default='NO'/>"
+        "   <Option name='STRILE_RESERVE' type='int' min='0' "
+        "description='Percentage of extra space reserved after each "
+        "compressed tile/strip, to allow rewriting it in place later' "
+        "default='0'/>"
         "</OpenOptionList>");
     poDriver->SetMetadataItem(GDAL_DMD_SUBDATASETS, "YES");
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
@@ -533,9 +533,12 @@ CPLErr GTiffDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
     }
     else if (bCanUseMultiThreadedRead)
     {
-        return MultiThreadedRead(nXOff, nYOff, nXSize, nYSize, pData, eBufType,
-                                 nBandCount, panBandMap, nPixelSpace,
-                                 nLineSpace, nBandSpace);
+        const CPLErr eErr = MultiThreadedRead(
+            nXOff, nYOff, nXSize, nYSize, pData, eBufType, nBandCount,
+            panBandMap, nPixelSpace, nLineSpace, nBandSpace);
+        if (eErr == CE_None)
+            PrefetchNeighbourBlocks(nXOff, nYOff, nXSize, nYSize);
+        return eErr;
     }
 
     // Write optimization when writing whole blocks, by-passing the block cache.
@@ -699,6 +702,9 @@ CPLErr GTiffDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                                 nullptr);
     }
 
+    if (eRWFlag == GF_Read && eErr == CE_None)
+        PrefetchNeighbourBlocks(nXOff, nYOff, nXSize, nYSize);
+
     return eErr;
 }
 
@@ -741,6 +747,12 @@ void GTiffDataset::InitCreationOrOpenOptions(bool bUpdateMode,
 
     m_eGeoTIFFKeysFlavor = GetGTIFFKeysFlavor(papszOptions);
     m_eGeoTIFFVersion = GetGeoTIFFVersion(papszOptions);
+
+    m_bBlockStatisticsRequested =
+        CPLFetchBool(papszOptions, "BLOCK_STATISTICS", false);
+
+    m_nStrileReservePct = std::max(
+        0, atoi(CSLFetchNameValueDef(papszOptions, "STRILE_RESERVE", "0")));
 }
 
 /************************************************************************/
@@ -774,6 +786,25 @@ bool GTiffDataset::IsBlockAvailable(int nBlockId, vsi_l_offset *pnOffset,
     // Strip/TileOffsets arrays.
     if (eAccess == GA_ReadOnly && !m_bStreamingIn)
     {
+        if (m_nPagedStrileArraysState == 0)
+            m_nPagedStrileArraysState = InitPagedStrileArrays() ? 1 : -1;
+        if (m_nPagedStrileArraysState > 0)
+        {
+            vsi_l_offset nOffset = 0;
+            vsi_l_offset nSize = 0;
+            if (!GetStrileFromPagedArrays(nBlockId, nOffset, nSize))
+            {
+                if (pbErrOccurred)
+                    *pbErrOccurred = true;
+                return false;
+            }
+            if (pnOffset)
+                *pnOffset = nOffset;
+            if (pnSize)
+                *pnSize = nSize;
+            return nSize != 0;
+        }
+
         int nErrOccurred = 0;
         auto bytecount =
             TIFFGetStrileByteCountWithErr(m_hTIFF, nBlockId, &nErrOccurred);
@@ -835,6 +866,207 @@ bool GTiffDataset::IsBlockAvailable(int nBlockId, vsi_l_offset *pnOffset,
     return false;
 }
 
+/************************************************************************/
+/*                        InitPagedStrileArrays()                       */
+/************************************************************************/
+
+// Locate the Strip/TileOffsets and Strip/TileByteCounts arrays in the IFD,
+// so that they can be read by pages of GTIFF_STRILE_ARRAY_PAGE_SIZE values
+// by GetStrileFromPagedArrays(). libtiff on-demand loading of those arrays
+// reads them by small increments, and allocates them for the whole number
+// of striles, which is costly for files with millions of tiles.
+// This is done by default only for files with at least one million striles
+// (GTIFF_PAGED_STRILE_ARRAYS=AUTO), and can be forced with YES or disabled
+// with NO.
+
+constexpr int GTIFF_STRILE_ARRAY_PAGE_SIZE = 4096;
+
+static uint64_t GTiffDecodeUInt(const GByte *pabyData, int nSize, bool bSwap)
+{
+    switch (nSize)
+    {
+        case 2:
+        {
+            uint16_t nVal;
+            memcpy(&nVal, pabyData, sizeof(nVal));
+            if (bSwap)
+                CPL_SWAP16PTR(&nVal);
+            return nVal;
+        }
+        case 4:
+        {
+            uint32_t nVal;
+            memcpy(&nVal, pabyData, sizeof(nVal));
+            if (bSwap)
+                CPL_SWAP32PTR(&nVal);
+            return nVal;
+        }
+        default:
+        {
+            CPLAssert(nSize == 8);
+            uint64_t nVal;
+            memcpy(&nVal, pabyData, sizeof(nVal));
+            if (bSwap)
+                CPL_SWAP64PTR(&nVal);
+            return nVal;
+        }
+    }
+}
+
+bool GTiffDataset::InitPagedStrileArrays()
+{
+    const bool bIsTiled = CPL_TO_BOOL(TIFFIsTiled(m_hTIFF));
+    const uint64_t nStriles =
+        bIsTiled ? TIFFNumberOfTiles(m_hTIFF) : TIFFNumberOfStrips(m_hTIFF);
+
+    const char *pszPaged =
+        CPLGetConfigOption("GTIFF_PAGED_STRILE_ARRAYS", "AUTO");
+    if (EQUAL(pszPaged, "AUTO"))
+    {
+        if (nStriles < 1024 * 1024)
+            return false;
+    }
+    else if (!CPLTestBool(pszPaged))
+    {
+        return false;
+    }
+
+    const bool bBigTIFF = CPL_TO_BOOL(TIFFIsBigTIFF(m_hTIFF));
+    const bool bSwap = CPL_TO_BOOL(TIFFIsByteSwapped(m_hTIFF));
+    const int nCountSize = bBigTIFF ? 8 : 2;
+    const int nEntrySize = bBigTIFF ? 20 : 12;
+    const int nValueFieldSize = bBigTIFF ? 8 : 4;
+    VSILFILE *fp = VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF));
+
+    GByte abyCount[8];
+    if (VSIFSeekL(fp, m_nDirOffset, SEEK_SET) != 0 ||
+        VSIFReadL(abyCount, nCountSize, 1, fp) != 1)
+    {
+        return false;
+    }
+    const uint64_t nEntries = GTiffDecodeUInt(abyCount, nCountSize, bSwap);
+    if (nEntries == 0 || nEntries > 65535)
+        return false;
+    std::vector<GByte> abyEntries(static_cast<size_t>(nEntries) * nEntrySize);
+    if (VSIFReadL(abyEntries.data(), abyEntries.size(), 1, fp) != 1)
+        return false;
+
+    const uint16_t anTags[2] = {
+        static_cast<uint16_t>(bIsTiled ? TIFFTAG_TILEOFFSETS
+                                       : TIFFTAG_STRIPOFFSETS),
+        static_cast<uint16_t>(bIsTiled ? TIFFTAG_TILEBYTECOUNTS
+                                       : TIFFTAG_STRIPBYTECOUNTS)};
+    bool abFound[2] = {false, false};
+    for (size_t i = 0; i < static_cast<size_t>(nEntries); ++i)
+    {
+        const GByte *pabyEntry = abyEntries.data() + i * nEntrySize;
+        const auto nTag =
+            static_cast<uint16_t>(GTiffDecodeUInt(pabyEntry, 2, bSwap));
+        const auto nType =
+            static_cast<int>(GTiffDecodeUInt(pabyEntry + 2, 2, bSwap));
+        for (int iArray = 0; iArray < 2; ++iArray)
+        {
+            if (nTag != anTags[iArray])
+                continue;
+            const int nValueSize = nType == TIFF_SHORT   ? 2
+                                   : nType == TIFF_LONG  ? 4
+                                   : nType == TIFF_LONG8 ? 8
+                                                         : 0;
+            const uint64_t nCount = GTiffDecodeUInt(
+                pabyEntry + 4, bBigTIFF ? 8 : 4, bSwap);
+            if (nValueSize == 0 || nCount != nStriles)
+                return false;
+            auto &sLocation = m_asStrileArrayLocation[iArray];
+            sLocation.nValueSize = nValueSize;
+            const vsi_l_offset nValueFieldOffset =
+                m_nDirOffset + nCountSize + i * nEntrySize +
+                (bBigTIFF ? 12 : 8);
+            if (nCount * nValueSize <= static_cast<uint64_t>(nValueFieldSize))
+            {
+                // Values stored inline in the IFD entry
+                sLocation.nFileOffset = nValueFieldOffset;
+            }
+            else
+            {
+                sLocation.nFileOffset = GTiffDecodeUInt(
+                    pabyEntry + (bBigTIFF ? 12 : 8), nValueFieldSize, bSwap);
+            }
+            abFound[iArray] = true;
+        }
+    }
+    if (!abFound[0] || !abFound[1])
+        return false;
+
+    m_nPagedStrileCount = nStriles;
+    CPLDebug("GTiff",
+             "Reading Strip/TileOffsets and Strip/TileByteCounts arrays by "
+             "pages");
+    return true;
+}
+
+/************************************************************************/
+/*                      GetStrileFromPagedArrays()                      */
+/************************************************************************/
+
+bool GTiffDataset::GetStrileFromPagedArrays(int nBlockId,
+                                            vsi_l_offset &nOffset,
+                                            vsi_l_offset &nSize)
+{
+    if (nBlockId < 0 || static_cast<uint64_t>(nBlockId) >= m_nPagedStrileCount)
+    {
+        ReportError(CE_Failure, CPLE_AppDefined, "Invalid block id %d",
+                    nBlockId);
+        return false;
+    }
+
+    const uint64_t nPage =
+        static_cast<uint64_t>(nBlockId) / GTIFF_STRILE_ARRAY_PAGE_SIZE;
+    const int nIdxInPage =
+        static_cast<int>(nBlockId - nPage * GTIFF_STRILE_ARRAY_PAGE_SIZE);
+    const bool bSwap = CPL_TO_BOOL(TIFFIsByteSwapped(m_hTIFF));
+    VSILFILE *fp = VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF));
+
+    uint64_t anValues[2] = {0, 0};
+    for (int iArray = 0; iArray < 2; ++iArray)
+    {
+        const uint64_t nKey = nPage * 2 + iArray;
+        std::shared_ptr<std::vector<uint64_t>> panPage;
+        if (!m_oCacheStrileArrayPages.tryGet(nKey, panPage))
+        {
+            const auto &sLocation = m_asStrileArrayLocation[iArray];
+            const uint64_t nFirst = nPage * GTIFF_STRILE_ARRAY_PAGE_SIZE;
+            const size_t nValues = static_cast<size_t>(
+                std::min<uint64_t>(GTIFF_STRILE_ARRAY_PAGE_SIZE,
+                                   m_nPagedStrileCount - nFirst));
+            std::vector<GByte> abyRaw(nValues * sLocation.nValueSize);
+            if (VSIFSeekL(fp,
+                          sLocation.nFileOffset +
+                              nFirst * sLocation.nValueSize,
+                          SEEK_SET) != 0 ||
+                VSIFReadL(abyRaw.data(), abyRaw.size(), 1, fp) != 1)
+            {
+                ReportError(CE_Failure, CPLE_FileIO, "Cannot read %s array",
+                            iArray == 0 ? "Strip/TileOffsets"
+                                        : "Strip/TileByteCounts");
+                return false;
+            }
+            panPage = std::make_shared<std::vector<uint64_t>>(nValues);
+            for (size_t i = 0; i < nValues; ++i)
+            {
+                (*panPage)[i] =
+                    GTiffDecodeUInt(abyRaw.data() + i * sLocation.nValueSize,
+                                    sLocation.nValueSize, bSwap);
+            }
+            m_oCacheStrileArrayPages.insert(nKey, panPage);
+        }
+        anValues[iArray] = (*panPage)[nIdxInPage];
+    }
+
+    nOffset = anValues[0];
+    nSize = anValues[1];
+    return true;
+}
+
 /************************************************************************/
 /*                           ReloadDirectory()                          */
 /************************************************************************/
@@ -1432,6 +1664,17 @@ char **GTiffDataset::GetFileList()
         papszFileList = CSLAddString(papszFileList, m_pszGeorefFilename);
     }
 
+    if (m_poBaseDS == nullptr && m_poImageryDS == nullptr &&
+        HasBlockStatisticsFile())
+    {
+        const std::string osBlockStatsFilename = GetBlockStatisticsFilename();
+        if (CSLFindString(papszFileList, osBlockStatsFilename.c_str()) == -1)
+        {
+            papszFileList =
+                CSLAddString(papszFileList, osBlockStatsFilename.c_str());
+        }
+    }
+
     if (m_nXMLGeorefSrcIndex >= 0)
         LookForProjection();
 
@@ -32,7 +32,8 @@
 
 #include "gdal_pam.h"
 
-#include <queue>
+#include <deque>
+#include <map>
 
 #include "cpl_mem_cache.h"
 #include "cpl_worker_thread_pool.h"  // CPLJobQueue, CPLWorkerThreadPool
@@ -110,6 +111,18 @@ class GTiffDataset final : public GDALPamDataset
         uint64_t nRoundUpBitTest;
     };
 
+    // Summary of the valid values of a block of a band, maintained with the
+    // BLOCK_STATISTICS creation or open option.
+    struct BlockStatistics
+    {
+        uint64_t nSampleCount = 0;  // 0 if the block has no summary
+        uint64_t nValidCount = 0;
+        double dfMin = 0;
+        double dfMax = 0;
+        double dfMean = 0;
+        double dfM2 = 0;  // Sum of squared differences to the mean
+    };
+
   private:
     CPL_DISALLOW_COPY_ASSIGN(GTiffDataset)
 
@@ -162,6 +175,25 @@ class GTiffDataset final : public GDALPamDataset
     lru11::Cache<int, std::pair<vsi_l_offset, vsi_l_offset>>
         m_oCacheStrileToOffsetByteCount{1024};
 
+    // Location in the file of the TileOffsets/TileByteCounts (or
+    // StripOffsets/StripByteCounts) arrays, when they are read by pages by
+    // GetStrileFromPagedArrays() rather than by libtiff.
+    struct StrileArrayLocation
+    {
+        vsi_l_offset nFileOffset = 0;
+        int nValueSize = 0;
+    };
+
+    StrileArrayLocation m_asStrileArrayLocation[2]{};
+    uint64_t m_nPagedStrileCount = 0;
+    lru11::Cache<uint64_t, std::shared_ptr<std::vector<uint64_t>>>
+        m_oCacheStrileArrayPages{128};
+
+    // Striles whose byte range has been passed to AdviseRead() by
+    // PrefetchNeighbourBlocks(), and not yet consumed by ReadStrile().
+    std::map<int, std::pair<vsi_l_offset, vsi_l_offset>>
+        m_oMapPrefetchedStriles{};
+
     MaskOffset *m_panMaskOffsetLsb = nullptr;
     char *m_pszVertUnit = nullptr;
     char *m_pszFilename = nullptr;
@@ -197,6 +229,10 @@ class GTiffDataset final : public GDALPamDataset
     int m_nRefBaseMapping = 0;
     int m_nGCPCount = 0;
     int m_nDisableMultiThreadedRead = 0;
+    int m_nReadAheadBlocks = 0;  // Blocks decoded ahead of IReadBlock()
+    int m_nPagedStrileArraysState = 0;  // 0: unknown, 1: in use, -1: unused
+    int m_nPrefetchBlocks = -1;         // -1: not initialized yet
+    int m_anLastReadBlockWindow[4] = {-1, -1, -1, -1};  // x1, y1, x2, y2
 
     GTIFFKeysFlavorEnum m_eGeoTIFFKeysFlavor = GEOTIFF_KEYS_STANDARD;
     GeoTIFFVersionEnum m_eGeoTIFFVersion = GEOTIFF_VERSION_AUTO;
@@ -247,8 +283,30 @@ class GTiffDataset final : public GDALPamDataset
 
     GDALMultiDomainMetadata m_oGTiffMDMD{};
 
+    struct BandBlockStatistics
+    {
+        // Nodata value taken into account by the summaries.
+        bool bNoDataSet = false;
+        double dfNoDataValue = 0;
+        // Whether a summary has changed since the band statistics have been
+        // derived.
+        bool bChanged = false;
+        std::vector<BlockStatistics> asBlocks{};  // m_nBlocksPerBand items
+    };
+
+    // Empty if block statistics are not maintained.
+    std::vector<BandBlockStatistics> m_aoBlockStatistics{};
+    bool m_bBlockStatisticsRequested = false;
+    bool m_bBlockStatisticsInitialized = false;
+    bool m_bBlockStatisticsDirty = false;
+
+    // Percentage of extra room reserved after compressed striles, so that
+    // they can be later rewritten in place with a larger size (STRILE_RESERVE
+    // creation/open option).
+    int m_nStrileReservePct = 0;
+
     std::vector<GTiffCompressionJob> m_asCompressionJobs{};
-    std::queue<int> m_asQueueJobIdx{};  // queue of index of m_asCompressionJobs
+    std::deque<int> m_asQueueJobIdx{};  // queue of index of m_asCompressionJobs
                                         // being compressed in worker threads
 
     bool m_bStreamingIn : 1;
@@ -331,6 +389,9 @@ class GTiffDataset final : public GDALPamDataset
     bool IsBlockAvailable(int nBlockId, vsi_l_offset *pnOffset = nullptr,
                           vsi_l_offset *pnSize = nullptr,
                           bool *pbErrOccurred = nullptr);
+    bool InitPagedStrileArrays();
+    bool GetStrileFromPagedArrays(int nBlockId, vsi_l_offset &nOffset,
+                                  vsi_l_offset &nSize);
 
     void ApplyPamInfo();
     void PushMetadataToPam();
@@ -369,6 +430,7 @@ class GTiffDataset final : public GDALPamDataset
     static void ThreadCompressionFunc(void *pData);
     void WaitCompletionForJobIdx(int i);
     void WaitCompletionForBlock(int nBlockId);
+    bool HasStrileReserve() const;
     void WriteRawStripOrTile(int nStripOrTile, GByte *pabyCompressedBuffer,
                              GPtrDiff_t nCompressedBufferSize);
     bool SubmitCompressionJob(int nStripOrTile, GByte *pabyData, GPtrDiff_t cc,
@@ -416,6 +478,22 @@ class GTiffDataset final : public GDALPamDataset
     void IdentifyAuthorizedGeoreferencingSources();
 
     CPLErr FlushCacheInternal(bool bAtClosing, bool bFlushDirectory);
+
+    std::string GetBlockStatisticsFilename() const;
+    bool HasBlockStatisticsFile();
+    bool IsBlockStatisticsCompatible();
+    bool InitBlockStatistics();
+    void DisableBlockStatistics();
+    BandBlockStatistics *GetBandBlockStatistics(int iBand);
+    void SummarizeBlock(int iBand, int iBlock, const void *pData,
+                        int nPixelStride, int nLineStride);
+    void UpdateBlockStatistics(uint32_t nBlockId, const void *pData);
+    bool DeriveBandStatistics(int iBand, BlockStatistics &sStats);
+    void SetStatisticsFromBlockStatistics(int iBand,
+                                          const BlockStatistics &sStats);
+    void RefreshStatisticsFromBlockStatistics();
+    bool ReadBlockStatistics();
+    bool WriteBlockStatistics();
     bool HasOptimizedReadMultiRange();
 
     bool AssociateExternalMask();
@@ -441,6 +519,10 @@ class GTiffDataset final : public GDALPamDataset
 
     static GTIF *GTIFNew(TIFF *hTIFF);
 
+    bool LookForProjectionFromSRSCache(const std::string &osCacheKey);
+    void InsertIntoSRSCache(const std::string &osCacheKey,
+                            bool bGotSRS) const;
+
   protected:
     virtual int CloseDependentDatasets() override;
 
@@ -448,6 +530,8 @@ class GTiffDataset final : public GDALPamDataset
     GTiffDataset();
     virtual ~GTiffDataset();
 
+    static void ClearSRSCache();
+
     CPLErr Close() override;
 
     const OGRSpatialReference *GetSpatialRef() const override;
@@ -463,6 +547,7 @@ class GTiffDataset final : public GDALPamDataset
                    const OGRSpatialReference *poSRS) override;
 
     bool IsMultiThreadedReadCompatible() const;
+    void PrefetchNeighbourBlocks(int nXOff, int nYOff, int nXSize, int nYSize);
     CPLErr MultiThreadedRead(int nXOff, int nYOff, int nXSize, int nYSize,
                              void *pData, GDALDataType eBufType, int nBandCount,
                              const int *panBandMap, GSpacing nPixelSpace,
@@ -37,6 +37,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
 #include <limits>
 #include <memory>
 #include <mutex>
@@ -46,6 +47,7 @@
 #include <tuple>
 #include <utility>
 
+#include "cpl_compressor.h"
 #include "cpl_error.h"
 #include "cpl_error_internal.h"  // CPLErrorHandlerAccumulatorStruct
 #include "cpl_vsi.h"
@@ -59,6 +61,10 @@
 #include "tifvsi.h"
 #include "xtiffio.h"
 
+#ifdef HAVE_JXL
+#include <jxl/decode.h>
+#endif
+
 /************************************************************************/
 /*                        GetJPEGOverviewCount()                        */
 /************************************************************************/
@@ -385,6 +391,10 @@ struct GTiffDecompressContext
 
     uint16_t nPredictor = 0;
 
+    // Set when striles can be decoded without libtiff
+    const CPLCompressor *psDirectDecompressor = nullptr;
+    bool bDirectJXLDecoding = false;
+
     uint32_t nJPEGTableSize = 0;
     void *pJPEGTable = nullptr;
     uint16_t nYCrbCrSubSampling0 = 2;
@@ -407,6 +417,170 @@ struct GTiffDecompressJob
     vsi_l_offset nSize = 0;
 };
 
+/************************************************************************/
+/*                  GTiffUndoHorizontalDifferencing()                   */
+/************************************************************************/
+
+template <class T>
+static void GTiffUndoHorizontalDifferencing(T *panData, int nXSize, int nYSize,
+                                            int nComponents)
+{
+    const size_t nValuesPerLine = static_cast<size_t>(nXSize) * nComponents;
+    for (int y = 0; y < nYSize; ++y, panData += nValuesPerLine)
+    {
+        for (size_t i = nComponents; i < nValuesPerLine; ++i)
+        {
+            panData[i] = static_cast<T>(panData[i] + panData[i - nComponents]);
+        }
+    }
+}
+
+/************************************************************************/
+/*                      GTiffDecodeStrileDirectly()                     */
+/************************************************************************/
+
+// Decode a DEFLATE or ZSTD compressed strile, and undo horizontal
+// differencing, without going through libtiff and the creation of a
+// temporary TIFF file. Returns false if the strile could not be decoded
+// to exactly nOutputSize bytes, in which case the caller should use libtiff.
+static bool GTiffDecodeStrileDirectly(const CPLCompressor *psDecompressor,
+                                      int nPredictor, const GByte *pabyInput,
+                                      size_t nInputSize, GByte *pabyOutput,
+                                      size_t nOutputSize, int nXSize,
+                                      int nYSize, int nComponents, int nDTSize)
+{
+    void *pOutput = pabyOutput;
+    size_t nDecodedSize = nOutputSize;
+    if (!psDecompressor->pfnFunc(pabyInput, nInputSize, &pOutput,
+                                 &nDecodedSize, nullptr,
+                                 psDecompressor->user_data) ||
+        nDecodedSize != nOutputSize)
+    {
+        return false;
+    }
+
+    if (nPredictor == PREDICTOR_HORIZONTAL)
+    {
+        switch (nDTSize)
+        {
+            case 1:
+                GTiffUndoHorizontalDifferencing(pabyOutput, nXSize, nYSize,
+                                                nComponents);
+                break;
+            case 2:
+                GTiffUndoHorizontalDifferencing(
+                    reinterpret_cast<uint16_t *>(pabyOutput), nXSize, nYSize,
+                    nComponents);
+                break;
+            case 4:
+                GTiffUndoHorizontalDifferencing(
+                    reinterpret_cast<uint32_t *>(pabyOutput), nXSize, nYSize,
+                    nComponents);
+                break;
+            case 8:
+                GTiffUndoHorizontalDifferencing(
+                    reinterpret_cast<uint64_t *>(pabyOutput), nXSize, nYSize,
+                    nComponents);
+                break;
+            default:
+                CPLAssert(false);
+                return false;
+        }
+    }
+    return true;
+}
+
+#ifdef HAVE_JXL
+
+/************************************************************************/
+/*                    GTiffDecodeJXLStrileDirectly()                    */
+/************************************************************************/
+
+namespace
+{
+struct JxlDecoderDeleter
+{
+    void operator()(JxlDecoder *decoder) const
+    {
+        JxlDecoderDestroy(decoder);
+    }
+};
+}  // namespace
+
+// Decoders are reused by the successive calls made by a thread, instead of
+// being created for each strile by the libtiff codec of a temporary TIFF file.
+static JxlDecoder *GTiffGetThreadJxlDecoder()
+{
+    static thread_local std::unique_ptr<JxlDecoder, JxlDecoderDeleter> decoder;
+    if (!decoder)
+        decoder.reset(JxlDecoderCreate(nullptr));
+    else
+        JxlDecoderReset(decoder.get());
+    return decoder.get();
+}
+
+// Decode a JXL compressed strile whose channels are all interleaved in the
+// main image (color channels, and optionally an alpha channel), without going
+// through libtiff. Returns false if the strile could not be decoded to
+// exactly nOutputSize bytes, or uses other extra channels, in which case the
+// caller should use libtiff.
+static bool GTiffDecodeJXLStrileDirectly(const GByte *pabyInput,
+                                         size_t nInputSize, GByte *pabyOutput,
+                                         size_t nOutputSize, int nXSize,
+                                         int nYSize, int nComponents,
+                                         GDALDataType eDT)
+{
+    JxlDecoder *decoder = GTiffGetThreadJxlDecoder();
+    if (!decoder ||
+        JxlDecoderSubscribeEvents(decoder, JXL_DEC_BASIC_INFO |
+                                               JXL_DEC_FULL_IMAGE) !=
+            JXL_DEC_SUCCESS ||
+        JxlDecoderSetInput(decoder, pabyInput, nInputSize) != JXL_DEC_SUCCESS)
+    {
+        return false;
+    }
+
+    JxlBasicInfo info;
+    memset(&info, 0, sizeof(info));
+    if (JxlDecoderProcessInput(decoder) != JXL_DEC_BASIC_INFO ||
+        JxlDecoderGetBasicInfo(decoder, &info) != JXL_DEC_SUCCESS ||
+        info.xsize != static_cast<uint32_t>(nXSize) ||
+        info.ysize != static_cast<uint32_t>(nYSize) ||
+        static_cast<int>(info.bits_per_sample) !=
+            GDALGetDataTypeSizeBits(eDT) ||
+        static_cast<int>(info.num_color_channels + info.num_extra_channels) !=
+            nComponents ||
+        !(info.num_extra_channels == 0 ||
+          (info.num_extra_channels == 1 && info.alpha_bits != 0)))
+    {
+        JxlDecoderReleaseInput(decoder);
+        return false;
+    }
+
+    JxlPixelFormat format;
+    memset(&format, 0, sizeof(format));
+    format.num_channels = static_cast<uint32_t>(nComponents);
+    format.data_type = eDT == GDT_Byte     ? JXL_TYPE_UINT8
+                       : eDT == GDT_UInt16 ? JXL_TYPE_UINT16
+                                           : JXL_TYPE_FLOAT;
+    format.endianness = JXL_NATIVE_ENDIAN;
+    format.align = 0;
+
+    size_t nBufferSize = 0;
+    bool bRet =
+        JxlDecoderProcessInput(decoder) == JXL_DEC_NEED_IMAGE_OUT_BUFFER &&
+        JxlDecoderImageOutBufferSize(decoder, &format, &nBufferSize) ==
+            JXL_DEC_SUCCESS &&
+        nBufferSize == nOutputSize &&
+        JxlDecoderSetImageOutBuffer(decoder, &format, pabyOutput,
+                                    nOutputSize) == JXL_DEC_SUCCESS &&
+        JxlDecoderProcessInput(decoder) == JXL_DEC_FULL_IMAGE;
+    JxlDecoderReleaseInput(decoder);
+    return bRet;
+}
+
+#endif  // HAVE_JXL
+
 /************************************************************************/
 /*                  ThreadDecompressionFuncErrorHandler()               */
 /************************************************************************/
@@ -696,15 +870,6 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
 
     if (nAlreadyLoadedBlocks != nBandsToCache)
     {
-        // Generate a dummy in-memory TIFF file that has all the needed tags
-        // from the original file
-        CPLString osTmpFilename;
-        osTmpFilename.Printf("/vsimem/decompress_%p.tif", psJob);
-        VSILFILE *fpTmp = VSIFOpenL(osTmpFilename.c_str(), "wb+");
-        TIFF *hTIFFTmp =
-            VSI_TIFFOpen(osTmpFilename.c_str(),
-                         psContext->bTIFFIsBigEndian ? "wb+" : "wl+", fpTmp);
-        CPLAssert(hTIFFTmp != nullptr);
         const int nBlockYSize =
             (psContext->bIsTiled ||
              psJob->nYBlock < poDS->m_nBlocksPerColumn - 1)
@@ -712,55 +877,7 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
             : (poDS->nRasterYSize % poDS->m_nBlockYSize) == 0
                 ? poDS->m_nBlockYSize
                 : poDS->nRasterYSize % poDS->m_nBlockYSize;
-        TIFFSetField(hTIFFTmp, TIFFTAG_IMAGEWIDTH, poDS->m_nBlockXSize);
-        TIFFSetField(hTIFFTmp, TIFFTAG_IMAGELENGTH, nBlockYSize);
-        TIFFSetField(hTIFFTmp, TIFFTAG_BITSPERSAMPLE, poDS->m_nBitsPerSample);
-        TIFFSetField(hTIFFTmp, TIFFTAG_COMPRESSION, poDS->m_nCompression);
-        TIFFSetField(hTIFFTmp, TIFFTAG_PHOTOMETRIC, poDS->m_nPhotometric);
-        TIFFSetField(hTIFFTmp, TIFFTAG_SAMPLEFORMAT, poDS->m_nSampleFormat);
-        TIFFSetField(hTIFFTmp, TIFFTAG_SAMPLESPERPIXEL,
-                     poDS->m_nPlanarConfig == PLANARCONFIG_CONTIG
-                         ? poDS->m_nSamplesPerPixel
-                         : 1);
-        TIFFSetField(hTIFFTmp, TIFFTAG_ROWSPERSTRIP, nBlockYSize);
-        TIFFSetField(hTIFFTmp, TIFFTAG_PLANARCONFIG, poDS->m_nPlanarConfig);
-        if (psContext->nPredictor != PREDICTOR_NONE)
-            TIFFSetField(hTIFFTmp, TIFFTAG_PREDICTOR, psContext->nPredictor);
-        if (poDS->m_nCompression == COMPRESSION_LERC)
-        {
-            TIFFSetField(hTIFFTmp, TIFFTAG_LERC_PARAMETERS, 2,
-                         poDS->m_anLercAddCompressionAndVersion);
-        }
-        else if (poDS->m_nCompression == COMPRESSION_JPEG)
-        {
-            if (psContext->pJPEGTable)
-            {
-                TIFFSetField(hTIFFTmp, TIFFTAG_JPEGTABLES,
-                             psContext->nJPEGTableSize, psContext->pJPEGTable);
-            }
-            if (poDS->m_nPhotometric == PHOTOMETRIC_YCBCR)
-            {
-                TIFFSetField(hTIFFTmp, TIFFTAG_YCBCRSUBSAMPLING,
-                             psContext->nYCrbCrSubSampling0,
-                             psContext->nYCrbCrSubSampling1);
-            }
-        }
-        if (psContext->pExtraSamples)
-        {
-            TIFFSetField(hTIFFTmp, TIFFTAG_EXTRASAMPLES,
-                         psContext->nExtraSampleCount,
-                         psContext->pExtraSamples);
-        }
-        TIFFWriteCheck(hTIFFTmp, FALSE, "ThreadDecompressionFunc");
-        TIFFWriteDirectory(hTIFFTmp);
-        XTIFFClose(hTIFFTmp);
 
-        // Re-open file
-        hTIFFTmp = VSI_TIFFOpen(osTmpFilename.c_str(), "r", fpTmp);
-        CPLAssert(hTIFFTmp != nullptr);
-        poDS->RestoreVolatileParameters(hTIFFTmp);
-
-        bool bRet = true;
         // Request m_nBlockYSize line in the block, except on the bottom-most
         // tile/strip.
         const int nBlockReqYSize =
@@ -773,8 +890,91 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
         const size_t nReqSize = static_cast<size_t>(poDS->m_nBlockXSize) *
                                 nBlockReqYSize * nBandsPerStrile * nDTSize;
 
-        GByte *pabyOutput;
+        // Size of the whole decoded strile, which may be larger than
+        // nReqSize for the bottom-most tiles.
+        const size_t nDecodedSize = static_cast<size_t>(poDS->m_nBlockXSize) *
+                                    nBlockYSize * nBandsPerStrile * nDTSize;
+
+        bool bRet = true;
+        GByte *pabyOutput = nullptr;
         std::vector<GByte> abyOutput;
+
+        const auto DecodeStrileWithLibTIFF = [&]()
+        {
+            // Generate a dummy in-memory TIFF file that has all the needed tags
+            // from the original file
+            CPLString osTmpFilename;
+            osTmpFilename.Printf("/vsimem/decompress_%p.tif", psJob);
+            VSILFILE *fpTmp = VSIFOpenL(osTmpFilename.c_str(), "wb+");
+            TIFF *hTIFFTmp = VSI_TIFFOpen(
+                osTmpFilename.c_str(),
+                psContext->bTIFFIsBigEndian ? "wb+" : "wl+", fpTmp);
+            CPLAssert(hTIFFTmp != nullptr);
+            TIFFSetField(hTIFFTmp, TIFFTAG_IMAGEWIDTH, poDS->m_nBlockXSize);
+            TIFFSetField(hTIFFTmp, TIFFTAG_IMAGELENGTH, nBlockYSize);
+            TIFFSetField(hTIFFTmp, TIFFTAG_BITSPERSAMPLE,
+                         poDS->m_nBitsPerSample);
+            TIFFSetField(hTIFFTmp, TIFFTAG_COMPRESSION, poDS->m_nCompression);
+            TIFFSetField(hTIFFTmp, TIFFTAG_PHOTOMETRIC, poDS->m_nPhotometric);
+            TIFFSetField(hTIFFTmp, TIFFTAG_SAMPLEFORMAT, poDS->m_nSampleFormat);
+            TIFFSetField(hTIFFTmp, TIFFTAG_SAMPLESPERPIXEL,
+                         poDS->m_nPlanarConfig == PLANARCONFIG_CONTIG
+                             ? poDS->m_nSamplesPerPixel
+                             : 1);
+            TIFFSetField(hTIFFTmp, TIFFTAG_ROWSPERSTRIP, nBlockYSize);
+            TIFFSetField(hTIFFTmp, TIFFTAG_PLANARCONFIG, poDS->m_nPlanarConfig);
+            if (psContext->nPredictor != PREDICTOR_NONE)
+                TIFFSetField(hTIFFTmp, TIFFTAG_PREDICTOR,
+                             psContext->nPredictor);
+            if (poDS->m_nCompression == COMPRESSION_LERC)
+            {
+                TIFFSetField(hTIFFTmp, TIFFTAG_LERC_PARAMETERS, 2,
+                             poDS->m_anLercAddCompressionAndVersion);
+            }
+            else if (poDS->m_nCompression == COMPRESSION_JPEG)
+            {
+                if (psContext->pJPEGTable)
+                {
+                    TIFFSetField(hTIFFTmp, TIFFTAG_JPEGTABLES,
+                                 psContext->nJPEGTableSize,
+                                 psContext->pJPEGTable);
+                }
+                if (poDS->m_nPhotometric == PHOTOMETRIC_YCBCR)
+                {
+                    TIFFSetField(hTIFFTmp, TIFFTAG_YCBCRSUBSAMPLING,
+                                 psContext->nYCrbCrSubSampling0,
+                                 psContext->nYCrbCrSubSampling1);
+                }
+            }
+            if (psContext->pExtraSamples)
+            {
+                TIFFSetField(hTIFFTmp, TIFFTAG_EXTRASAMPLES,
+                             psContext->nExtraSampleCount,
+                             psContext->pExtraSamples);
+            }
+            TIFFWriteCheck(hTIFFTmp, FALSE, "ThreadDecompressionFunc");
+            TIFFWriteDirectory(hTIFFTmp);
+            XTIFFClose(hTIFFTmp);
+
+            // Re-open file
+            hTIFFTmp = VSI_TIFFOpen(osTmpFilename.c_str(), "r", fpTmp);
+            CPLAssert(hTIFFTmp != nullptr);
+            poDS->RestoreVolatileParameters(hTIFFTmp);
+
+            bool bOK = true;
+            if (!TIFFReadFromUserBuffer(hTIFFTmp, 0, abyInput.data(),
+                                        abyInput.size(), pabyOutput,
+                                        nReqSize) &&
+                !poDS->m_bIgnoreReadErrors)
+            {
+                bOK = false;
+            }
+            XTIFFClose(hTIFFTmp);
+            CPL_IGNORE_RET_VAL(VSIFCloseL(fpTmp));
+            VSIUnlink(osTmpFilename.c_str());
+            return bOK;
+        };
+
         if (poDS->m_nCompression == COMPRESSION_NONE &&
             !TIFFIsByteSwapped(poDS->m_hTIFF) && abyInput.size() >= nReqSize &&
             (psContext->bSkipBlockCache || nBandsPerStrile > 1))
@@ -785,24 +985,43 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
         {
             if (psContext->bSkipBlockCache || nBandsPerStrile > 1)
             {
-                abyOutput.resize(nReqSize);
+                abyOutput.resize((psContext->psDirectDecompressor ||
+                                  psContext->bDirectJXLDecoding)
+                                     ? nDecodedSize
+                                     : nReqSize);
                 pabyOutput = abyOutput.data();
             }
             else
             {
                 pabyOutput = static_cast<GByte *>(apoBlocks[0]->GetDataRef());
             }
-            if (!TIFFReadFromUserBuffer(hTIFFTmp, 0, abyInput.data(),
-                                        abyInput.size(), pabyOutput,
-                                        nReqSize) &&
-                !poDS->m_bIgnoreReadErrors)
+            GDALCodecStatisticsRecorder oRecorder(
+                poDS, GDALCodecStatisticsRecorder::Operation::DECODE);
+            oRecorder.SetEncodedSize(static_cast<GIntBig>(abyInput.size()));
+            oRecorder.SetDecodedSize(static_cast<GIntBig>(nReqSize));
+            bool bDecoded = false;
+            if (psContext->psDirectDecompressor)
+            {
+                bDecoded = GTiffDecodeStrileDirectly(
+                    psContext->psDirectDecompressor, psContext->nPredictor,
+                    abyInput.data(), abyInput.size(), pabyOutput, nDecodedSize,
+                    poDS->m_nBlockXSize, nBlockYSize, nBandsPerStrile,
+                    nDTSize);
+            }
+#ifdef HAVE_JXL
+            else if (psContext->bDirectJXLDecoding)
+            {
+                bDecoded = GTiffDecodeJXLStrileDirectly(
+                    abyInput.data(), abyInput.size(), pabyOutput, nDecodedSize,
+                    poDS->m_nBlockXSize, nBlockYSize, nBandsPerStrile,
+                    psContext->eDT);
+            }
+#endif
+            if (!bDecoded)
             {
-                bRet = false;
+                bRet = DecodeStrileWithLibTIFF();
             }
         }
-        XTIFFClose(hTIFFTmp);
-        CPL_IGNORE_RET_VAL(VSIFCloseL(fpTmp));
-        VSIUnlink(osTmpFilename.c_str());
 
         if (!bRet)
         {
@@ -1261,11 +1480,70 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
                      &sContext.pExtraSamples);
     }
 
+    // For DEFLATE and ZSTD, with no predictor or horizontal differencing on
+    // whole bytes samples in native byte order, striles can be decoded
+    // directly with the CPL decompressors, that use per-thread contexts.
+    if ((m_nCompression == COMPRESSION_ADOBE_DEFLATE ||
+         m_nCompression == COMPRESSION_ZSTD) &&
+        !TIFFIsByteSwapped(m_hTIFF) &&
+        m_nBitsPerSample == GDALGetDataTypeSizeBits(sContext.eDT) &&
+        (sContext.nPredictor == PREDICTOR_NONE ||
+         (sContext.nPredictor == PREDICTOR_HORIZONTAL &&
+          !GDALDataTypeIsComplex(sContext.eDT)))
+#ifdef DEBUG
+        && CPLTestBool(CPLGetConfigOption("GTIFF_ALLOW_DIRECT_DECODING", "YES"))
+#endif
+    )
+    {
+        sContext.psDirectDecompressor = CPLGetDecompressor(
+            m_nCompression == COMPRESSION_ZSTD ? "zstd" : "zlib");
+    }
+#ifdef HAVE_JXL
+    // Similarly, JXL striles of Byte, UInt16 or Float32 data can be decoded
+    // with a per-thread decoder, reset between striles.
+    else if (m_nCompression == COMPRESSION_JXL &&
+             (sContext.eDT == GDT_Byte || sContext.eDT == GDT_UInt16 ||
+              sContext.eDT == GDT_Float32) &&
+             m_nBitsPerSample == GDALGetDataTypeSizeBits(sContext.eDT)
+#ifdef DEBUG
+             && CPLTestBool(
+                    CPLGetConfigOption("GTIFF_ALLOW_DIRECT_DECODING", "YES"))
+#endif
+    )
+    {
+        sContext.bDirectJXLDecoding = true;
+    }
+#endif
+
+    // When the mask is interleaved with the imagery (COG layout), request
+    // the mask striles together with the imagery ones, so that the
+    // AdviseRead() implementation can merge them in a single range.
+    GTiffRasterBand *poMaskBand = nullptr;
+    if (sContext.bHasPRead && nStrilePerBlock == 1 &&
+        m_bMaskInterleavedWithImagery && GetRasterBand(1)->GetMaskBand() &&
+        m_poMaskDS &&
+        m_poMaskDS->m_nBlockXSize == m_nBlockXSize &&
+        m_poMaskDS->m_nBlockYSize == m_nBlockYSize &&
+        !VSI_TIFFHasCachedRanges(TIFFClientdata(m_hTIFF)))
+    {
+        poMaskBand =
+            cpl::down_cast<GTiffRasterBand *>(m_poMaskDS->GetRasterBand(1));
+    }
+    struct MaskStrile
+    {
+        int nBlockId;
+        int nXBlock;
+        int nYBlock;
+        vsi_l_offset nOffset;
+        size_t nSize;
+    };
+    std::vector<MaskStrile> asMaskStriles;
+
     // Create one job per tile/strip
     vsi_l_offset nFileSize = 0;
     std::vector<GTiffDecompressJob> asJobs(nBlocks);
-    std::vector<vsi_l_offset> anOffsets(nBlocks);
-    std::vector<size_t> anSizes(nBlocks);
+    std::vector<vsi_l_offset> anOffsets(poMaskBand ? 2 * nBlocks : nBlocks);
+    std::vector<size_t> anSizes(anOffsets.size());
     int iJob = 0;
     int nAdviseReadRanges = 0;
     for (int y = 0; y < nYBlocks; ++y)
@@ -1377,6 +1655,37 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
                     ++nAdviseReadRanges;
                 }
 
+                if (poMaskBand)
+                {
+                    auto poBlock = poMaskBand->TryGetLockedBlockRef(
+                        asJobs[iJob].nXBlock, asJobs[iJob].nYBlock);
+                    if (poBlock)
+                    {
+                        poBlock->DropLock();
+                    }
+                    else
+                    {
+                        vsi_l_offset nMaskOffset = 0;
+                        vsi_l_offset nMaskSize = 0;
+                        if (m_poMaskDS->IsBlockAvailable(nBlockId, &nMaskOffset,
+                                                         &nMaskSize) &&
+                            nMaskSize > 0 && nMaskSize <= 100U * 1024 * 1024)
+                        {
+                            MaskStrile sStrile;
+                            sStrile.nBlockId = nBlockId;
+                            sStrile.nXBlock = asJobs[iJob].nXBlock;
+                            sStrile.nYBlock = asJobs[iJob].nYBlock;
+                            sStrile.nOffset = nMaskOffset;
+                            sStrile.nSize = static_cast<size_t>(nMaskSize);
+                            asMaskStriles.push_back(sStrile);
+
+                            anOffsets[nAdviseReadRanges] = sStrile.nOffset;
+                            anSizes[nAdviseReadRanges] = sStrile.nSize;
+                            ++nAdviseReadRanges;
+                        }
+                    }
+                }
+
                 ++iJob;
             }
         }
@@ -1388,6 +1697,8 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
         // implementation
         if (nAdviseReadRanges > 0)
         {
+            // This cancels ranges advised by PrefetchNeighbourBlocks()
+            m_oMapPrefetchedStriles.clear();
             sContext.poHandle->AdviseRead(nAdviseReadRanges, anOffsets.data(),
                                           anSizes.data());
         }
@@ -1411,6 +1722,58 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
         {
             CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
         }
+
+        // Decode the mask striles into the block cache of the mask band,
+        // from the data that has been fetched by AdviseRead(), to avoid
+        // issuing new requests when the mask is read afterwards.
+        if (sContext.bSuccess && !asMaskStriles.empty())
+        {
+            size_t nTotalSize = 0;
+            for (const auto &sStrile : asMaskStriles)
+                nTotalSize += sStrile.nSize;
+            GByte *pabyMaskData =
+                static_cast<GByte *>(VSI_MALLOC_VERBOSE(nTotalSize));
+            if (pabyMaskData)
+            {
+                std::vector<void *> apData;
+                std::vector<vsi_l_offset> anMaskOffsets;
+                std::vector<size_t> anMaskSizes;
+                size_t nAccOffset = 0;
+                for (const auto &sStrile : asMaskStriles)
+                {
+                    GByte *pabyDst = pabyMaskData + nAccOffset;
+                    if (sContext.poHandle->PRead(pabyDst, sStrile.nSize,
+                                                 sStrile.nOffset) !=
+                        sStrile.nSize)
+                    {
+                        break;
+                    }
+                    apData.push_back(pabyDst);
+                    anMaskOffsets.push_back(sStrile.nOffset);
+                    anMaskSizes.push_back(sStrile.nSize);
+                    m_poMaskDS->m_oCacheStrileToOffsetByteCount.insert(
+                        sStrile.nBlockId,
+                        std::pair(sStrile.nOffset, sStrile.nSize));
+                    nAccOffset += sStrile.nSize;
+                }
+
+                thandle_t th = TIFFClientdata(m_hTIFF);
+                VSI_TIFFSetCachedRanges(th, static_cast<int>(apData.size()),
+                                        apData.data(), anMaskOffsets.data(),
+                                        anMaskSizes.data());
+                ++m_poMaskDS->m_nDisableMultiThreadedRead;
+                for (size_t i = 0; i < apData.size(); ++i)
+                {
+                    GDALRasterBlock *poBlock = poMaskBand->GetLockedBlockRef(
+                        asMaskStriles[i].nXBlock, asMaskStriles[i].nYBlock);
+                    if (poBlock)
+                        poBlock->DropLock();
+                }
+                --m_poMaskDS->m_nDisableMultiThreadedRead;
+                VSI_TIFFSetCachedRanges(th, 0, nullptr, nullptr, nullptr);
+                VSIFree(pabyMaskData);
+            }
+        }
     }
 
     return sContext.bSuccess ? CE_None : CE_Failure;
@@ -3129,6 +3492,152 @@ int GTiffDataset::DirectIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize,
     return eErr;
 }
 
+/************************************************************************/
+/*                      PrefetchNeighbourBlocks()                       */
+/************************************************************************/
+
+// Called after a successful read of the [nXOff, nXOff + nXSize[ x
+// [nYOff, nYOff + nYSize[ window. If that window has been translated
+// with respect to the one of the previous read (typical panning at a given
+// zoom level), the blocks that the window would cover after a further
+// translation of the same amount are requested asynchronously through
+// AdviseRead(), up to GTIFF_PREFETCH_BLOCKS blocks. ReadStrile() then reads
+// them with PRead(), which is served from the data fetched by AdviseRead().
+void GTiffDataset::PrefetchNeighbourBlocks(int nXOff, int nYOff, int nXSize,
+                                           int nYSize)
+{
+    if (m_nPrefetchBlocks < 0)
+    {
+        m_nPrefetchBlocks = 0;
+        VSILFILE *fp = VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF));
+        // Mask datasets share the file handle of their imagery dataset,
+        // and would cancel the ranges advised for it.
+        if (eAccess == GA_ReadOnly && !m_bStreamingIn && nBands > 0 &&
+            m_poImageryDS == nullptr &&
+            TIFFIsTiled(m_hTIFF) &&
+            (nBands == 1 || m_nPlanarConfig == PLANARCONFIG_CONTIG) &&
+#if TIFFLIB_VERSION <= 20220520 && !defined(INTERNAL_LIBTIFF)
+            // See comment in ReadStrile() about TIFFReadFromUserBuffer()
+            m_nCompression != COMPRESSION_JPEG &&
+#endif
+            fp->HasPRead())
+        {
+            m_nPrefetchBlocks = std::max(
+                0, atoi(CPLGetConfigOption("GTIFF_PREFETCH_BLOCKS", "0")));
+        }
+    }
+    if (m_nPrefetchBlocks == 0 || nXSize <= 0 || nYSize <= 0)
+        return;
+
+    const int nBlockX1 = nXOff / m_nBlockXSize;
+    const int nBlockY1 = nYOff / m_nBlockYSize;
+    const int nBlockX2 = (nXOff + nXSize - 1) / m_nBlockXSize;
+    const int nBlockY2 = (nYOff + nYSize - 1) / m_nBlockYSize;
+    const int nDX = nBlockX1 - m_anLastReadBlockWindow[0];
+    const int nDY = nBlockY1 - m_anLastReadBlockWindow[1];
+    const bool bTranslated =
+        m_anLastReadBlockWindow[0] >= 0 && (nDX != 0 || nDY != 0) &&
+        nBlockX2 - nBlockX1 ==
+            m_anLastReadBlockWindow[2] - m_anLastReadBlockWindow[0] &&
+        nBlockY2 - nBlockY1 ==
+            m_anLastReadBlockWindow[3] - m_anLastReadBlockWindow[1] &&
+        std::abs(nDX) <= nBlockX2 - nBlockX1 + 1 &&
+        std::abs(nDY) <= nBlockY2 - nBlockY1 + 1;
+    m_anLastReadBlockWindow[0] = nBlockX1;
+    m_anLastReadBlockWindow[1] = nBlockY1;
+    m_anLastReadBlockWindow[2] = nBlockX2;
+    m_anLastReadBlockWindow[3] = nBlockY2;
+    if (!bTranslated)
+        return;
+
+    // Predicted window, clamped to the raster extent
+    const int nNextX1 = std::max(0, nBlockX1 + nDX);
+    const int nNextY1 = std::max(0, nBlockY1 + nDY);
+    const int nNextX2 = std::min(m_nBlocksPerRow - 1, nBlockX2 + nDX);
+    const int nNextY2 = std::min(m_nBlocksPerColumn - 1, nBlockY2 + nDY);
+
+    auto poFirstBand = cpl::down_cast<GTiffRasterBand *>(papoBands[0]);
+    std::map<int, std::pair<vsi_l_offset, vsi_l_offset>> oMapStriles;
+    for (int iY = nNextY1;
+         iY <= nNextY2 &&
+         static_cast<int>(oMapStriles.size()) < m_nPrefetchBlocks;
+         ++iY)
+    {
+        for (int iX = nNextX1;
+             iX <= nNextX2 &&
+             static_cast<int>(oMapStriles.size()) < m_nPrefetchBlocks;
+             ++iX)
+        {
+            // Skip blocks of the window that has just been read
+            if (iX >= nBlockX1 && iX <= nBlockX2 && iY >= nBlockY1 &&
+                iY <= nBlockY2)
+                continue;
+
+            GDALRasterBlock *poBlock =
+                poFirstBand->TryGetLockedBlockRef(iX, iY);
+            if (poBlock != nullptr)
+            {
+                poBlock->DropLock();
+                continue;
+            }
+
+            const int nBlockId = poFirstBand->ComputeBlockId(iX, iY);
+            const auto oIter = m_oMapPrefetchedStriles.find(nBlockId);
+            if (oIter != m_oMapPrefetchedStriles.end())
+            {
+                oMapStriles[nBlockId] = oIter->second;
+                continue;
+            }
+
+            vsi_l_offset nOffset = 0;
+            vsi_l_offset nSize = 0;
+            if (IsBlockAvailable(nBlockId, &nOffset, &nSize) && nSize > 0 &&
+                nSize < 100U * 1024 * 1024)
+            {
+                oMapStriles[nBlockId] = std::pair(nOffset, nSize);
+            }
+        }
+    }
+
+    // Nothing new to fetch: keep the ranges currently being fetched.
+    bool bNew = false;
+    for (const auto &oIter : oMapStriles)
+    {
+        if (m_oMapPrefetchedStriles.find(oIter.first) ==
+            m_oMapPrefetchedStriles.end())
+        {
+            bNew = true;
+            break;
+        }
+    }
+    if (!bNew)
+        return;
+
+    std::vector<std::pair<vsi_l_offset, size_t>> aOffsetSize;
+    for (const auto &oIter : oMapStriles)
+    {
+        aOffsetSize.emplace_back(oIter.second.first,
+                                 static_cast<size_t>(oIter.second.second));
+    }
+    std::sort(aOffsetSize.begin(), aOffsetSize.end());
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    for (const auto &oOffsetSize : aOffsetSize)
+    {
+        anOffsets.push_back(oOffsetSize.first);
+        anSizes.push_back(oOffsetSize.second);
+    }
+
+    // AdviseRead() cancels previously advised ranges, hence the ranges
+    // still wanted are part of the new request.
+    CPLDebugOnly("GTiff", "Prefetching %d block(s)",
+                 static_cast<int>(oMapStriles.size()));
+    m_oMapPrefetchedStriles = std::move(oMapStriles);
+    VSILFILE *fp = VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF));
+    fp->AdviseRead(static_cast<int>(anOffsets.size()), anOffsets.data(),
+                   anSizes.data());
+}
+
 /************************************************************************/
 /*                             ReadStrile()                             */
 /************************************************************************/
@@ -3157,12 +3666,18 @@ bool GTiffDataset::ReadStrile(int nBlockId, void *pOutputBuffer,
                                      : m_hTIFF);
         void *pInputBuffer = VSI_TIFFGetCachedRange(
             th, oPair.first, static_cast<size_t>(oPair.second));
-        if (pInputBuffer &&
-            TIFFReadFromUserBuffer(m_hTIFF, nBlockId, pInputBuffer,
-                                   static_cast<size_t>(oPair.second),
-                                   pOutputBuffer, nBlockReqSize))
-        {
-            return true;
+        if (pInputBuffer)
+        {
+            GDALCodecStatisticsRecorder oRecorder(
+                this, GDALCodecStatisticsRecorder::Operation::DECODE);
+            oRecorder.SetEncodedSize(static_cast<GIntBig>(oPair.second));
+            oRecorder.SetDecodedSize(nBlockReqSize);
+            if (TIFFReadFromUserBuffer(m_hTIFF, nBlockId, pInputBuffer,
+                                       static_cast<size_t>(oPair.second),
+                                       pOutputBuffer, nBlockReqSize))
+            {
+                return true;
+            }
         }
     }
 
@@ -3185,6 +3700,92 @@ bool GTiffDataset::ReadStrile(int nBlockId, void *pOutputBuffer,
         return false;
     }
 #else
+    // When GDAL reads the strile arrays by pages, fetch the strile ourselves,
+    // so that libtiff does not load its own copy of those arrays.
+    // Same for striles prefetched by PrefetchNeighbourBlocks(), which are
+    // read with PRead() to benefit from the data fetched by AdviseRead().
+    bool bPrefetched = false;
+    vsi_l_offset nOffset = 0;
+    vsi_l_offset nSize = 0;
+    if (!m_oMapPrefetchedStriles.empty())
+    {
+        const auto oIter = m_oMapPrefetchedStriles.find(nBlockId);
+        if (oIter != m_oMapPrefetchedStriles.end())
+        {
+            bPrefetched = true;
+            nOffset = oIter->second.first;
+            nSize = oIter->second.second;
+            m_oMapPrefetchedStriles.erase(oIter);
+        }
+    }
+    if (bPrefetched || (m_nPagedStrileArraysState > 0
+#if TIFFLIB_VERSION <= 20220520 && !defined(INTERNAL_LIBTIFF)
+                        && m_nCompression != COMPRESSION_JPEG
+#endif
+                        ))
+    {
+        if ((bPrefetched ||
+             GetStrileFromPagedArrays(nBlockId, nOffset, nSize)) &&
+            nSize > 0 &&
+            nSize <= static_cast<vsi_l_offset>(
+                         std::numeric_limits<tmsize_t>::max()) &&
+            nSize < 100U * 1024 * 1024)
+        {
+            std::vector<GByte> abyInput;
+            try
+            {
+                abyInput.resize(static_cast<size_t>(nSize));
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate working buffer of size "
+                         CPL_FRMT_GUIB,
+                         static_cast<GUIntBig>(nSize));
+                return false;
+            }
+            VSILFILE *fp = VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF));
+            if (bPrefetched
+                    ? fp->PRead(abyInput.data(), abyInput.size(), nOffset) !=
+                          abyInput.size()
+                    : (VSIFSeekL(fp, nOffset, SEEK_SET) != 0 ||
+                       VSIFReadL(abyInput.data(), abyInput.size(), 1, fp) != 1))
+            {
+                CPLError(CE_Failure, CPLE_FileIO,
+                         "Cannot read " CPL_FRMT_GUIB
+                         " bytes at offset " CPL_FRMT_GUIB,
+                         static_cast<GUIntBig>(nSize),
+                         static_cast<GUIntBig>(nOffset));
+                return false;
+            }
+            GDALCodecStatisticsRecorder oRecorder(
+                this, GDALCodecStatisticsRecorder::Operation::DECODE);
+            oRecorder.SetEncodedSize(static_cast<GIntBig>(nSize));
+            oRecorder.SetDecodedSize(nBlockReqSize);
+            GTIFFGetThreadLocalLibtiffError() = 1;
+            const bool bRet =
+                TIFFReadFromUserBuffer(m_hTIFF, nBlockId, abyInput.data(),
+                                       static_cast<tmsize_t>(nSize),
+                                       pOutputBuffer, nBlockReqSize) != 0 ||
+                m_bIgnoreReadErrors;
+            GTIFFGetThreadLocalLibtiffError() = 0;
+            if (!bRet)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "TIFFReadFromUserBuffer() failed.");
+            }
+            return bRet;
+        }
+    }
+
+    // libtiff fetches the strile itself, so the decoding time includes the
+    // fetching time.
+    GDALCodecStatisticsRecorder oRecorder(
+        this, GDALCodecStatisticsRecorder::Operation::DECODE);
+    oRecorder.SetEncodedSize(
+        static_cast<GIntBig>(TIFFGetStrileByteCount(m_hTIFF, nBlockId)));
+    oRecorder.SetDecodedSize(nBlockReqSize);
+
     // Set to 1 to allow GTiffErrorHandler to implement limitation on error
     // messages
     GTIFFGetThreadLocalLibtiffError() = 1;
@@ -4024,6 +4625,153 @@ void GTiffDataset::LookForProjection()
     }
 }
 
+/************************************************************************/
+/*                             SRS cache                                */
+/*                                                                      */
+/*      Building a SRS from GeoTIFF keys involves many lookups in the   */
+/*      PROJ database. As many files share the same keys, the result   */
+/*      is cached process-wide, keyed by the content of the GeoTIFF    */
+/*      tags and the configuration options affecting their decoding.   */
+/************************************************************************/
+
+namespace
+{
+struct GTiffCachedSRS
+{
+    OGRSpatialReference oSRS{};
+    bool bGotSRS = false;
+    std::string osVertUnit{};
+    bool bHasVertUnit = false;
+};
+}  // namespace
+
+static std::mutex goSRSCacheMutex;
+static lru11::Cache<std::string, std::shared_ptr<GTiffCachedSRS>>
+    *gpoSRSCache = nullptr;
+
+/************************************************************************/
+/*                         GetSRSCacheKey()                             */
+/************************************************************************/
+
+static std::string GetSRSCacheKey(TIFF *hTIFF)
+{
+    uint16_t nKeyCount = 0;
+    uint16_t *panKeys = nullptr;
+    if (!TIFFGetField(hTIFF, TIFFTAG_GEOKEYDIRECTORY, &nKeyCount, &panKeys) ||
+        panKeys == nullptr)
+    {
+        return std::string();
+    }
+
+    const auto AppendBytes = [](std::string &osKey, const void *pData,
+                                size_t nSize)
+    {
+        osKey += std::to_string(nSize);
+        osKey += ':';
+        if (nSize)
+            osKey.append(static_cast<const char *>(pData), nSize);
+    };
+
+    std::string osKey;
+    AppendBytes(osKey, panKeys, nKeyCount * sizeof(uint16_t));
+
+    uint16_t nDoubleCount = 0;
+    double *padfDoubles = nullptr;
+    if (!TIFFGetField(hTIFF, TIFFTAG_GEODOUBLEPARAMS, &nDoubleCount,
+                      &padfDoubles) ||
+        padfDoubles == nullptr)
+    {
+        nDoubleCount = 0;
+    }
+    AppendBytes(osKey, padfDoubles, nDoubleCount * sizeof(double));
+
+    char *pszAscii = nullptr;
+    if (!TIFFGetField(hTIFF, TIFFTAG_GEOASCIIPARAMS, &pszAscii) ||
+        pszAscii == nullptr)
+    {
+        pszAscii = const_cast<char *>("");
+    }
+    AppendBytes(osKey, pszAscii, strlen(pszAscii));
+
+    for (const char *pszOption :
+         {"GTIFF_LINEAR_UNITS", "GTIFF_SRS_SOURCE", "GTIFF_IMPORT_FROM_EPSG",
+          "OSR_STRIP_TOWGS84", "GTIFF_REPORT_COMPD_CS"})
+    {
+        const char *pszValue = CPLGetConfigOption(pszOption, "");
+        AppendBytes(osKey, pszValue, strlen(pszValue));
+    }
+
+    const CPLStringList aosSearchPaths(OSRGetPROJSearchPaths());
+    for (const char *pszPath : aosSearchPaths)
+        AppendBytes(osKey, pszPath, strlen(pszPath));
+
+    return osKey;
+}
+
+/************************************************************************/
+/*                   LookForProjectionFromSRSCache()                    */
+/************************************************************************/
+
+bool GTiffDataset::LookForProjectionFromSRSCache(const std::string &osCacheKey)
+{
+    std::lock_guard<std::mutex> oLock(goSRSCacheMutex);
+    std::shared_ptr<GTiffCachedSRS> poEntry;
+    if (gpoSRSCache == nullptr || !gpoSRSCache->tryGet(osCacheKey, poEntry))
+        return false;
+
+    if (poEntry->bGotSRS)
+    {
+        CPLFree(m_pszXMLFilename);
+        m_pszXMLFilename = nullptr;
+        m_oSRS = poEntry->oSRS;
+    }
+    if (poEntry->bHasVertUnit)
+    {
+        CPLFree(m_pszVertUnit);
+        m_pszVertUnit = CPLStrdup(poEntry->osVertUnit.c_str());
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                        InsertIntoSRSCache()                          */
+/************************************************************************/
+
+void GTiffDataset::InsertIntoSRSCache(const std::string &osCacheKey,
+                                      bool bGotSRS) const
+{
+    auto poEntry = std::make_shared<GTiffCachedSRS>();
+    poEntry->bGotSRS = bGotSRS;
+    if (m_pszVertUnit)
+    {
+        poEntry->bHasVertUnit = true;
+        poEntry->osVertUnit = m_pszVertUnit;
+    }
+
+    std::lock_guard<std::mutex> oLock(goSRSCacheMutex);
+    // Copy under the lock, as the PROJ object of cached SRS may be read
+    // concurrently.
+    poEntry->oSRS = m_oSRS;
+    if (gpoSRSCache == nullptr)
+    {
+        gpoSRSCache =
+            new lru11::Cache<std::string, std::shared_ptr<GTiffCachedSRS>>(
+                256);
+    }
+    gpoSRSCache->insert(osCacheKey, poEntry);
+}
+
+/************************************************************************/
+/*                           ClearSRSCache()                            */
+/************************************************************************/
+
+/* static */ void GTiffDataset::ClearSRSCache()
+{
+    std::lock_guard<std::mutex> oLock(goSRSCacheMutex);
+    delete gpoSRSCache;
+    gpoSRSCache = nullptr;
+}
+
 /************************************************************************/
 /*                      LookForProjectionFromGeoTIFF()                  */
 /************************************************************************/
@@ -4036,13 +4784,26 @@ void GTiffDataset::LookForProjectionFromGeoTIFF()
 
     GTIF *hGTIF = GTiffDataset::GTIFNew(m_hTIFF);
 
+    const std::string osSRSCacheKey =
+        hGTIF && CPLTestBool(CPLGetConfigOption("GTIFF_SRS_CACHE", "YES"))
+            ? GetSRSCacheKey(m_hTIFF)
+            : std::string();
+
     if (!hGTIF)
     {
         ReportError(CE_Warning, CPLE_AppDefined,
                     "GeoTIFF tags apparently corrupt, they are being ignored.");
     }
+    else if (!osSRSCacheKey.empty() &&
+             LookForProjectionFromSRSCache(osSRSCacheKey))
+    {
+        GTiffDatasetSetAreaOrPointMD(hGTIF, m_oGTiffMDMD);
+
+        GTIFFree(hGTIF);
+    }
     else
     {
+        bool bGotSRS = false;
         GTIFDefn *psGTIFDefn = GTIFAllocDefn();
 
         bool bHasErrorBefore = CPLGetLastErrorType() != 0;
@@ -4078,6 +4839,7 @@ void GTiffDataset::LookForProjectionFromGeoTIFF()
 
                 m_oSRS = *(OGRSpatialReference::FromHandle(hSRS));
                 OSRDestroySpatialReference(hSRS);
+                bGotSRS = true;
             }
         }
 
@@ -4136,6 +4898,11 @@ void GTiffDataset::LookForProjectionFromGeoTIFF()
 
         GTIFFreeDefn(psGTIFDefn);
 
+        // Do not cache results that came with warnings, so that they are
+        // emitted each time.
+        if (!osSRSCacheKey.empty() && aoErrors.empty())
+            InsertIntoSRSCache(osSRSCacheKey, bGotSRS);
+
         GTiffDatasetSetAreaOrPointMD(hGTIF, m_oGTiffMDMD);
 
         GTIFFree(hGTIF);
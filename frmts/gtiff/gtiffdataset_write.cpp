@@ -656,16 +656,15 @@ bool GTiffDataset::WriteEncodedTile(uint32_t tile, GByte *pabyData,
         }
     }
 
-    if (m_panMaskOffsetLsb)
-    {
-        const int iBand = m_nPlanarConfig == PLANARCONFIG_SEPARATE
-                              ? static_cast<int>(tile) / m_nBlocksPerBand
-                              : -1;
-        DiscardLsb(pabyData, cc, iBand);
-    }
+    const int iBandForDiscardLsb =
+        m_nPlanarConfig == PLANARCONFIG_SEPARATE
+            ? static_cast<int>(tile) / m_nBlocksPerBand
+            : -1;
 
     if (m_bStreamingOut)
     {
+        if (m_panMaskOffsetLsb)
+            DiscardLsb(pabyData, cc, iBandForDiscardLsb);
         if (tile != static_cast<uint32_t>(m_nLastWrittenBlockId + 1))
         {
             ReportError(CE_Failure, CPLE_NotSupported,
@@ -687,11 +686,24 @@ bool GTiffDataset::WriteEncodedTile(uint32_t tile, GByte *pabyData,
 
     /* -------------------------------------------------------------------- */
     /*      Should we do compression in a worker thread ?                   */
+    /*      (it takes care of DISCARD_LSB itself)                           */
     /* -------------------------------------------------------------------- */
     if (SubmitCompressionJob(tile, pabyData, cc, m_nBlockYSize))
         return true;
 
-    return TIFFWriteEncodedTile(m_hTIFF, tile, pabyData, cc) == cc;
+    if (m_panMaskOffsetLsb)
+        DiscardLsb(pabyData, cc, iBandForDiscardLsb);
+
+    GDALCodecStatisticsRecorder oRecorder(
+        this, GDALCodecStatisticsRecorder::Operation::ENCODE);
+    oRecorder.SetDecodedSize(cc);
+    const bool bRet = TIFFWriteEncodedTile(m_hTIFF, tile, pabyData, cc) == cc;
+    if (bRet)
+    {
+        oRecorder.SetEncodedSize(
+            static_cast<GIntBig>(TIFFGetStrileByteCount(m_hTIFF, tile)));
+    }
+    return bRet;
 }
 
 /************************************************************************/
@@ -757,16 +769,15 @@ bool GTiffDataset::WriteEncodedStrip(uint32_t strip, GByte *pabyData,
         pabyData = static_cast<GByte *>(m_pabyTempWriteBuffer);
     }
 
-    if (m_panMaskOffsetLsb)
-    {
-        int iBand = m_nPlanarConfig == PLANARCONFIG_SEPARATE
-                        ? static_cast<int>(strip) / m_nBlocksPerBand
-                        : -1;
-        DiscardLsb(pabyData, cc, iBand);
-    }
+    const int iBandForDiscardLsb =
+        m_nPlanarConfig == PLANARCONFIG_SEPARATE
+            ? static_cast<int>(strip) / m_nBlocksPerBand
+            : -1;
 
     if (m_bStreamingOut)
     {
+        if (m_panMaskOffsetLsb)
+            DiscardLsb(pabyData, cc, iBandForDiscardLsb);
         if (strip != static_cast<uint32_t>(m_nLastWrittenBlockId + 1))
         {
             ReportError(CE_Failure, CPLE_NotSupported,
@@ -788,11 +799,24 @@ bool GTiffDataset::WriteEncodedStrip(uint32_t strip, GByte *pabyData,
 
     /* -------------------------------------------------------------------- */
     /*      Should we do compression in a worker thread ?                   */
+    /*      (it takes care of DISCARD_LSB itself)                           */
     /* -------------------------------------------------------------------- */
     if (SubmitCompressionJob(strip, pabyData, cc, nStripHeight))
         return true;
 
-    return TIFFWriteEncodedStrip(m_hTIFF, strip, pabyData, cc) == cc;
+    if (m_panMaskOffsetLsb)
+        DiscardLsb(pabyData, cc, iBandForDiscardLsb);
+
+    GDALCodecStatisticsRecorder oRecorder(
+        this, GDALCodecStatisticsRecorder::Operation::ENCODE);
+    oRecorder.SetDecodedSize(cc);
+    const bool bRet = TIFFWriteEncodedStrip(m_hTIFF, strip, pabyData, cc) == cc;
+    if (bRet)
+    {
+        oRecorder.SetEncodedSize(
+            static_cast<GIntBig>(TIFFGetStrileByteCount(m_hTIFF, strip)));
+    }
+    return bRet;
 }
 
 /************************************************************************/
@@ -828,6 +852,17 @@ void GTiffDataset::InitCompressionThreads(bool bUpdateMode,
                 if (bUpdateMode && m_poThreadPool)
                     m_poCompressQueue = m_poThreadPool->CreateJobQueue();
 
+                // Number of blocks decoded by anticipation in the thread pool
+                // when IReadBlock() detects a sequential access pattern.
+                if (!bUpdateMode && m_poThreadPool && nBands >= 1 &&
+                    IsMultiThreadedReadCompatible())
+                {
+                    m_nReadAheadBlocks = std::max(
+                        0, atoi(CPLGetConfigOption(
+                               "GTIFF_READ_AHEAD_BLOCKS",
+                               CPLSPrintf("%d", nThreads))));
+                }
+
                 if (m_poCompressQueue != nullptr)
                 {
                     // Add a margin of an extra job w.r.t thread number
@@ -907,6 +942,19 @@ void GTiffDataset::ThreadCompressionFunc(void *pData)
 
     poDS->RestoreVolatileParameters(hTIFFTmp);
 
+    // Done here rather than in the main thread, as this can be as costly
+    // as the compression itself.
+    if (poDS->m_panMaskOffsetLsb)
+    {
+        const int iBand = poDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE
+                              ? psJob->nStripOrTile / poDS->m_nBlocksPerBand
+                              : -1;
+        poDS->DiscardLsb(psJob->pabyBuffer, psJob->nBufferSize, iBand);
+    }
+
+    GDALCodecStatisticsRecorder oRecorder(
+        poDS, GDALCodecStatisticsRecorder::Operation::ENCODE);
+    oRecorder.SetDecodedSize(psJob->nBufferSize);
     bool bOK = TIFFWriteEncodedStrip(hTIFFTmp, 0, psJob->pabyBuffer,
                                      psJob->nBufferSize) == psJob->nBufferSize;
 
@@ -921,6 +969,7 @@ void GTiffDataset::ThreadCompressionFunc(void *pData)
         nOffset = panOffsets[0];
         psJob->nCompressedBufferSize =
             static_cast<GPtrDiff_t>(panByteCounts[0]);
+        oRecorder.SetEncodedSize(psJob->nCompressedBufferSize);
     }
     else
     {
@@ -977,6 +1026,68 @@ void GTiffDataset::WriteRawStripOrTile(int nStripOrTile,
     CPLDebug("GTIFF", "Writing raw strip/tile %d, size " CPL_FRMT_GUIB,
              nStripOrTile, static_cast<GUIntBig>(nCompressedBufferSize));
 #endif
+    // Pad the strile with STRILE_RESERVE percent of extra room, or up to
+    // the size of its current location, so that libtiff rewrites it in place
+    // and that the location keeps its capacity for later updates.
+    std::vector<GByte> abyPaddedBuffer;
+    if (HasStrileReserve())
+    {
+        const GTiffDataset *poRootDS = m_poBaseDS ? m_poBaseDS : this;
+        GUIntBig nPaddedSize =
+            static_cast<GUIntBig>(nCompressedBufferSize) +
+            static_cast<GUIntBig>(nCompressedBufferSize) *
+                poRootDS->m_nStrileReservePct / 100;
+        toff_t *panCurOffsets = nullptr;
+        toff_t *panCurByteCounts = nullptr;
+        if (TIFFGetField(m_hTIFF,
+                         TIFFIsTiled(m_hTIFF) ? TIFFTAG_TILEOFFSETS
+                                              : TIFFTAG_STRIPOFFSETS,
+                         &panCurOffsets) &&
+            panCurOffsets != nullptr && panCurOffsets[nStripOrTile] != 0 &&
+            TIFFGetField(m_hTIFF,
+                         TIFFIsTiled(m_hTIFF) ? TIFFTAG_TILEBYTECOUNTS
+                                              : TIFFTAG_STRIPBYTECOUNTS,
+                         &panCurByteCounts) &&
+            panCurByteCounts != nullptr &&
+            panCurByteCounts[nStripOrTile] >=
+                static_cast<GUIntBig>(nCompressedBufferSize))
+        {
+            nPaddedSize = panCurByteCounts[nStripOrTile];
+        }
+        if (nPaddedSize > static_cast<GUIntBig>(nCompressedBufferSize) &&
+            nPaddedSize - nCompressedBufferSize <= 0xFFFFFFFFU &&
+            nPaddedSize < static_cast<GUIntBig>(
+                              std::numeric_limits<GPtrDiff_t>::max()))
+        {
+            try
+            {
+                abyPaddedBuffer.resize(static_cast<size_t>(nPaddedSize));
+            }
+            catch (const std::exception &)
+            {
+            }
+        }
+        if (!abyPaddedBuffer.empty())
+        {
+            memcpy(abyPaddedBuffer.data(), pabyCompressedBuffer,
+                   nCompressedBufferSize);
+            const uint32_t nPaddingSize =
+                static_cast<uint32_t>(nPaddedSize - nCompressedBufferSize);
+            // For ZSTD, make the padding a skippable frame, so that decoders
+            // that process the whole input do not choke on it.
+            if (m_nCompression == COMPRESSION_ZSTD && nPaddingSize >= 8)
+            {
+                uint32_t anFrameHeader[2] = {0x184D2A50U, nPaddingSize - 8};
+                CPL_LSBPTR32(&anFrameHeader[0]);
+                CPL_LSBPTR32(&anFrameHeader[1]);
+                memcpy(abyPaddedBuffer.data() + nCompressedBufferSize,
+                       anFrameHeader, sizeof(anFrameHeader));
+            }
+            pabyCompressedBuffer = abyPaddedBuffer.data();
+            nCompressedBufferSize = static_cast<GPtrDiff_t>(nPaddedSize);
+        }
+    }
+
     toff_t *panOffsets = nullptr;
     toff_t *panByteCounts = nullptr;
     bool bWriteAtEnd = true;
@@ -1119,6 +1230,26 @@ void GTiffDataset::WriteRawStripOrTile(int nStripOrTile,
     }
 }
 
+/************************************************************************/
+/*                          HasStrileReserve()                          */
+/************************************************************************/
+
+// Whether compressed striles must be padded with the STRILE_RESERVE room.
+// This is only done for codecs whose decoders ignore data after the end of
+// the compressed stream, and when the strile layout is not constrained by
+// the COG optimizations.
+bool GTiffDataset::HasStrileReserve() const
+{
+    const GTiffDataset *poRootDS = m_poBaseDS ? m_poBaseDS : this;
+    return poRootDS->m_nStrileReservePct > 0 && !m_bBlockOrderRowMajor &&
+           !m_bLeaderSizeAsUInt4 && !m_bTrailerRepeatedLast4BytesRepeated &&
+           (m_nCompression == COMPRESSION_ADOBE_DEFLATE ||
+            m_nCompression == COMPRESSION_LZW ||
+            m_nCompression == COMPRESSION_PACKBITS ||
+            m_nCompression == COMPRESSION_LZMA ||
+            m_nCompression == COMPRESSION_ZSTD);
+}
+
 /************************************************************************/
 /*                        WaitCompletionForJobIdx()                     */
 /************************************************************************/
@@ -1170,7 +1301,9 @@ void GTiffDataset::WaitCompletionForJobIdx(int i)
     asJobs[i].nBufferSize = 0;
     asJobs[i].bReady = false;
     asJobs[i].nStripOrTile = -1;
-    oQueue.pop();
+    const auto oIter = std::find(oQueue.begin(), oQueue.end(), i);
+    CPLAssert(oIter != oQueue.end());
+    oQueue.erase(oIter);
 }
 
 /************************************************************************/
@@ -1268,7 +1401,7 @@ bool GTiffDataset::SubmitCompressionJob(int nStripOrTile, GByte *pabyData,
                                 m_nCompression == COMPRESSION_JPEG))
     {
         if (m_bBlockOrderRowMajor || m_bLeaderSizeAsUInt4 ||
-            m_bTrailerRepeatedLast4BytesRepeated)
+            m_bTrailerRepeatedLast4BytesRepeated || HasStrileReserve())
         {
             GTiffCompressionJob sJob;
             memset(&sJob, 0, sizeof(sJob));
@@ -1304,6 +1437,40 @@ bool GTiffDataset::SubmitCompressionJob(int nStripOrTile, GByte *pabyData,
     {
         CPLAssert(!oQueue.empty());
         nNextCompressionJobAvail = oQueue.front();
+
+        // Do not necessarily wait for the oldest job to be completed, but
+        // write the first one that is ready, provided that the layout of
+        // striles in the file does not matter for its dataset: libtiff
+        // records the offset of each strile as it is appended, whatever the
+        // order.
+        auto mutex = m_poBaseDS ? m_poBaseDS->m_hCompressThreadPoolMutex
+                                : m_hCompressThreadPoolMutex;
+        while (true)
+        {
+            int nReadyJob = -1;
+            CPLAcquireMutex(mutex, 1000.0);
+            for (const int iJob : oQueue)
+            {
+                const GTiffDataset *poJobDS = asJobs[iJob].poDS;
+                if (asJobs[iJob].bReady &&
+                    (iJob == oQueue.front() ||
+                     (!poJobDS->m_bBlockOrderRowMajor &&
+                      !poJobDS->m_bLeaderSizeAsUInt4 &&
+                      !poJobDS->m_bTrailerRepeatedLast4BytesRepeated)))
+                {
+                    nReadyJob = iJob;
+                    break;
+                }
+            }
+            CPLReleaseMutex(mutex);
+            if (nReadyJob >= 0)
+            {
+                nNextCompressionJobAvail = nReadyJob;
+                break;
+            }
+            poQueue->GetPool()->WaitEvent();
+        }
+
         WaitCompletionForJobIdx(nNextCompressionJobAvail);
     }
     else
@@ -1323,7 +1490,7 @@ bool GTiffDataset::SubmitCompressionJob(int nStripOrTile, GByte *pabyData,
     GTiffCompressionJob *psJob = &asJobs[nNextCompressionJobAvail];
     SetupJob(*psJob);
     poQueue->SubmitJob(ThreadCompressionFunc, psJob);
-    oQueue.push(nNextCompressionJobAvail);
+    oQueue.push_back(nNextCompressionJobAvail);
 
     return true;
 }
@@ -1861,6 +2028,8 @@ CPLErr GTiffDataset::WriteEncodedTileOrStrip(uint32_t tile_or_strip, void *data,
 {
     CPLErr eErr = CE_None;
 
+    UpdateBlockStatistics(tile_or_strip, data);
+
     if (TIFFIsTiled(m_hTIFF))
     {
         if (!(WriteEncodedTile(tile_or_strip, static_cast<GByte *>(data),
@@ -1905,6 +2074,666 @@ CPLErr GTiffDataset::FlushBlockBuf()
     return eErr;
 }
 
+/************************************************************************/
+/*                         Block statistics                             */
+/*                                                                      */
+/*      With the BLOCK_STATISTICS creation or open option, a summary    */
+/*      (count, minimum, maximum, mean and sum of squared differences   */
+/*      to the mean) of the valid values of each block of each band is  */
+/*      updated as blocks are written, and saved in a .blockstats side  */
+/*      car file, so that band statistics can be derived from the       */
+/*      summaries of the blocks without reading pixels.                 */
+/************************************************************************/
+
+/************************************************************************/
+/*                    GetBlockStatisticsFilename()                      */
+/************************************************************************/
+
+std::string GTiffDataset::GetBlockStatisticsFilename() const
+{
+    return std::string(m_pszFilename).append(".blockstats");
+}
+
+/************************************************************************/
+/*                      HasBlockStatisticsFile()                        */
+/************************************************************************/
+
+bool GTiffDataset::HasBlockStatisticsFile()
+{
+    if (!GDALCanFileAcceptSidecarFile(m_pszFilename))
+        return false;
+    const std::string osFilename = GetBlockStatisticsFilename();
+    char **papszSiblingFiles = GetSiblingFiles();
+    if (papszSiblingFiles && eAccess == GA_ReadOnly)
+    {
+        return CSLFindString(papszSiblingFiles,
+                             CPLGetFilename(osFilename.c_str())) >= 0;
+    }
+    VSIStatBufL sStat;
+    return VSIStatL(osFilename.c_str(), &sStat) == 0;
+}
+
+/************************************************************************/
+/*                    IsBlockStatisticsCompatible()                     */
+/************************************************************************/
+
+// Whether the values that are written are the values that will be read
+// back, in a layout that SummarizeBlock() understands.
+bool GTiffDataset::IsBlockStatisticsCompatible()
+{
+    if (nBands == 0 || m_bStreamingOut || m_bTreatAsSplit ||
+        m_bTreatAsSplitBitmap || m_panMaskOffsetLsb ||
+        m_eVirtualMemIOUsage != VirtualMemIOEnum::NO)
+    {
+        return false;
+    }
+
+    const GDALDataType eDT = GetRasterBand(1)->GetRasterDataType();
+    if (GDALDataTypeIsComplex(eDT) ||
+        m_nBitsPerSample != GDALGetDataTypeSizeBits(eDT))
+    {
+        return false;
+    }
+
+    // Lossy compression methods.
+    if (m_nCompression == COMPRESSION_JPEG ||
+        (m_nCompression == COMPRESSION_WEBP && !m_bWebPLossless) ||
+        (m_nCompression == COMPRESSION_LERC && m_dfMaxZError > 0))
+    {
+        return false;
+    }
+#if HAVE_JXL
+    if (m_nCompression == COMPRESSION_JXL && !m_bJXLLossless)
+        return false;
+#endif
+
+    for (int i = 1; i <= nBands; ++i)
+    {
+        auto poBand = cpl::down_cast<GTiffRasterBand *>(GetRasterBand(i));
+        if (!poBand->IsBaseGTiffClass())
+            return false;
+    }
+
+    if (eDT == GDT_Byte)
+    {
+        const char *pszPixelType =
+            m_oGTiffMDMD.GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+        if (pszPixelType && EQUAL(pszPixelType, "SIGNEDBYTE"))
+            return false;
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                       InitBlockStatistics()                          */
+/************************************************************************/
+
+// Returns whether block statistics are maintained for this dataset. They are
+// if the BLOCK_STATISTICS option is set, or if a .blockstats file exists, so
+// that it is kept in sync with updates.
+bool GTiffDataset::InitBlockStatistics()
+{
+    if (m_bBlockStatisticsInitialized)
+        return !m_aoBlockStatistics.empty();
+    m_bBlockStatisticsInitialized = true;
+
+    // Only the full resolution imagery is summarized.
+    if (m_poBaseDS != nullptr || m_poImageryDS != nullptr)
+        return false;
+
+    const bool bHasFile = HasBlockStatisticsFile();
+    if (!m_bBlockStatisticsRequested && !bHasFile)
+        return false;
+
+    if (!IsBlockStatisticsCompatible())
+    {
+        if (m_bBlockStatisticsRequested)
+        {
+            CPLDebug("GTiff", "BLOCK_STATISTICS ignored: not supported for "
+                              "this data type, compression or layout");
+        }
+        // A file that would no longer be maintained must not survive
+        // updates.
+        if (bHasFile && eAccess == GA_Update)
+            VSIUnlink(GetBlockStatisticsFilename().c_str());
+        return false;
+    }
+
+    m_aoBlockStatistics.resize(nBands);
+    for (int i = 0; i < nBands; ++i)
+    {
+        auto &oBandStats = m_aoBlockStatistics[i];
+        oBandStats.asBlocks.resize(m_nBlocksPerBand);
+        auto poBand = GetRasterBand(i + 1);
+        int bNoDataSet = FALSE;
+        oBandStats.dfNoDataValue = poBand->GetNoDataValue(&bNoDataSet);
+        oBandStats.bNoDataSet = CPL_TO_BOOL(bNoDataSet);
+    }
+
+    if (bHasFile && !ReadBlockStatistics())
+    {
+        CPLDebug("GTiff", "Ignoring content of %s",
+                 GetBlockStatisticsFilename().c_str());
+        for (auto &oBandStats : m_aoBlockStatistics)
+        {
+            std::fill(oBandStats.asBlocks.begin(), oBandStats.asBlocks.end(),
+                      BlockStatistics());
+        }
+        m_bBlockStatisticsDirty = true;
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                      DisableBlockStatistics()                        */
+/************************************************************************/
+
+// Called when pixels may be modified without going through
+// WriteEncodedTileOrStrip().
+void GTiffDataset::DisableBlockStatistics()
+{
+    if (InitBlockStatistics())
+    {
+        m_aoBlockStatistics.clear();
+        m_bBlockStatisticsDirty = false;
+        if (eAccess == GA_Update)
+            VSIUnlink(GetBlockStatisticsFilename().c_str());
+    }
+}
+
+/************************************************************************/
+/*                      GetBandBlockStatistics()                        */
+/************************************************************************/
+
+// Returns the block statistics of the band of index iBand (0-based), having
+// discarded them if the nodata value has changed since they were computed.
+GTiffDataset::BandBlockStatistics *
+GTiffDataset::GetBandBlockStatistics(int iBand)
+{
+    if (!InitBlockStatistics())
+        return nullptr;
+
+    auto &oBandStats = m_aoBlockStatistics[iBand];
+    int bNoDataSet = FALSE;
+    const double dfNoDataValue =
+        GetRasterBand(iBand + 1)->GetNoDataValue(&bNoDataSet);
+    if (CPL_TO_BOOL(bNoDataSet) != oBandStats.bNoDataSet ||
+        (bNoDataSet && !(dfNoDataValue == oBandStats.dfNoDataValue ||
+                         (std::isnan(dfNoDataValue) &&
+                          std::isnan(oBandStats.dfNoDataValue)))))
+    {
+        oBandStats.bNoDataSet = CPL_TO_BOOL(bNoDataSet);
+        oBandStats.dfNoDataValue = dfNoDataValue;
+        std::fill(oBandStats.asBlocks.begin(), oBandStats.asBlocks.end(),
+                  BlockStatistics());
+        oBandStats.bChanged = true;
+        m_bBlockStatisticsDirty = true;
+    }
+    return &oBandStats;
+}
+
+/************************************************************************/
+/*                          SummarizeBlock()                            */
+/************************************************************************/
+
+template <class T>
+static void SummarizeBlockTyped(const T *pData, int nPixelStride,
+                                int nLineStride, int nXSize, int nYSize,
+                                bool bNoDataSet, double dfNoDataValue,
+                                GTiffDataset::BlockStatistics &sStats)
+{
+    // Same definition of valid values as GDALRasterBand::ComputeStatistics()
+    bool bFloatNoDataSet = false;
+    float fNoDataValue = 0.0f;
+    if constexpr (std::is_same<T, float>::value)
+    {
+        if (bNoDataSet)
+        {
+            dfNoDataValue = GDALAdjustNoDataCloseToFloatMax(dfNoDataValue);
+            bNoDataSet = false;
+            if (GDALIsValueInRange<float>(dfNoDataValue))
+            {
+                fNoDataValue = static_cast<float>(dfNoDataValue);
+                bFloatNoDataSet = true;
+            }
+        }
+    }
+    const auto IsValid = [bNoDataSet, dfNoDataValue, bFloatNoDataSet,
+                          fNoDataValue](T v)
+    {
+        if constexpr (std::is_same<T, float>::value)
+        {
+            if (CPLIsNan(v) ||
+                (bFloatNoDataSet && ARE_REAL_EQUAL(v, fNoDataValue)))
+                return false;
+        }
+        else if constexpr (std::is_same<T, double>::value)
+        {
+            if (CPLIsNan(v))
+                return false;
+        }
+        return !(bNoDataSet &&
+                 ARE_REAL_EQUAL(static_cast<double>(v), dfNoDataValue));
+    };
+
+    // Two passes, for the mean and then the sum of squared differences.
+    uint64_t nValidCount = 0;
+    double dfMin = std::numeric_limits<double>::max();
+    double dfMax = -std::numeric_limits<double>::max();
+    double dfSum = 0;
+    for (int iY = 0; iY < nYSize; ++iY)
+    {
+        const T *pLine = pData + static_cast<GPtrDiff_t>(iY) * nLineStride;
+        for (int iX = 0; iX < nXSize; ++iX)
+        {
+            const T v = pLine[static_cast<GPtrDiff_t>(iX) * nPixelStride];
+            if (!IsValid(v))
+                continue;
+            const double dfValue = static_cast<double>(v);
+            dfMin = std::min(dfMin, dfValue);
+            dfMax = std::max(dfMax, dfValue);
+            dfSum += dfValue;
+            ++nValidCount;
+        }
+    }
+
+    sStats = GTiffDataset::BlockStatistics();
+    sStats.nSampleCount = static_cast<uint64_t>(nXSize) * nYSize;
+    sStats.nValidCount = nValidCount;
+    if (nValidCount == 0)
+        return;
+
+    const double dfMean = dfSum / static_cast<double>(nValidCount);
+    double dfM2 = 0;
+    for (int iY = 0; iY < nYSize; ++iY)
+    {
+        const T *pLine = pData + static_cast<GPtrDiff_t>(iY) * nLineStride;
+        for (int iX = 0; iX < nXSize; ++iX)
+        {
+            const T v = pLine[static_cast<GPtrDiff_t>(iX) * nPixelStride];
+            if (!IsValid(v))
+                continue;
+            const double dfDelta = static_cast<double>(v) - dfMean;
+            dfM2 += dfDelta * dfDelta;
+        }
+    }
+
+    sStats.dfMin = dfMin;
+    sStats.dfMax = dfMax;
+    sStats.dfMean = dfMean;
+    sStats.dfM2 = dfM2;
+}
+
+// Computes the summary of the block iBlock (within the band) of the band of
+// index iBand (0-based), from pData, whose pixel and line strides are
+// expressed in number of values.
+void GTiffDataset::SummarizeBlock(int iBand, int iBlock, const void *pData,
+                                  int nPixelStride, int nLineStride)
+{
+    BandBlockStatistics *poBandStats = GetBandBlockStatistics(iBand);
+    if (poBandStats == nullptr)
+        return;
+
+    const int iXBlock = iBlock % m_nBlocksPerRow;
+    const int iYBlock = iBlock / m_nBlocksPerRow;
+    const int nXSize = std::min(m_nBlockXSize,
+                                nRasterXSize - iXBlock * m_nBlockXSize);
+    const int nYSize = std::min(m_nBlockYSize,
+                                nRasterYSize - iYBlock * m_nBlockYSize);
+
+    const bool bNoDataSet = poBandStats->bNoDataSet;
+    const double dfNoDataValue = poBandStats->dfNoDataValue;
+    BlockStatistics &sStats = poBandStats->asBlocks[iBlock];
+    switch (GetRasterBand(iBand + 1)->GetRasterDataType())
+    {
+#define SUMMARIZE_BLOCK(eDT, T)                                               \
+    case eDT:                                                                 \
+        SummarizeBlockTyped(static_cast<const T *>(pData), nPixelStride,      \
+                            nLineStride, nXSize, nYSize, bNoDataSet,          \
+                            dfNoDataValue, sStats);                           \
+        break;
+        SUMMARIZE_BLOCK(GDT_Byte, GByte)
+        SUMMARIZE_BLOCK(GDT_Int8, GInt8)
+        SUMMARIZE_BLOCK(GDT_UInt16, GUInt16)
+        SUMMARIZE_BLOCK(GDT_Int16, GInt16)
+        SUMMARIZE_BLOCK(GDT_UInt32, GUInt32)
+        SUMMARIZE_BLOCK(GDT_Int32, GInt32)
+        SUMMARIZE_BLOCK(GDT_UInt64, std::uint64_t)
+        SUMMARIZE_BLOCK(GDT_Int64, std::int64_t)
+        SUMMARIZE_BLOCK(GDT_Float32, float)
+        SUMMARIZE_BLOCK(GDT_Float64, double)
+#undef SUMMARIZE_BLOCK
+        default:
+            CPLAssert(false);
+            return;
+    }
+
+    poBandStats->bChanged = true;
+    m_bBlockStatisticsDirty = true;
+}
+
+/************************************************************************/
+/*                       UpdateBlockStatistics()                        */
+/************************************************************************/
+
+// Updates the block statistics from the content of a tile or strip that is
+// going to be written.
+void GTiffDataset::UpdateBlockStatistics(uint32_t nBlockId, const void *pData)
+{
+    if (!InitBlockStatistics())
+        return;
+
+    const int iBlock = static_cast<int>(nBlockId % m_nBlocksPerBand);
+    const int nWordBytes = m_nBitsPerSample / 8;
+    if (m_nPlanarConfig == PLANARCONFIG_CONTIG)
+    {
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            SummarizeBlock(iBand, iBlock,
+                           static_cast<const GByte *>(pData) +
+                               iBand * nWordBytes,
+                           nBands, m_nBlockXSize * nBands);
+        }
+    }
+    else
+    {
+        SummarizeBlock(static_cast<int>(nBlockId / m_nBlocksPerBand), iBlock,
+                       pData, 1, m_nBlockXSize);
+    }
+}
+
+/************************************************************************/
+/*                      DeriveBandStatistics()                          */
+/************************************************************************/
+
+// Merges the statistics of all blocks of the band of index iBand (0-based)
+// into sStats, with the pairwise formula of Chan et al. Returns false if
+// some blocks have no summary.
+bool GTiffDataset::DeriveBandStatistics(int iBand, BlockStatistics &sStats)
+{
+    BandBlockStatistics *poBandStats = GetBandBlockStatistics(iBand);
+    if (poBandStats == nullptr)
+        return false;
+
+    sStats = BlockStatistics();
+    sStats.dfMin = std::numeric_limits<double>::max();
+    sStats.dfMax = -std::numeric_limits<double>::max();
+    for (const auto &sBlock : poBandStats->asBlocks)
+    {
+        if (sBlock.nSampleCount == 0)
+            return false;
+        sStats.nSampleCount += sBlock.nSampleCount;
+        if (sBlock.nValidCount == 0)
+            continue;
+        sStats.dfMin = std::min(sStats.dfMin, sBlock.dfMin);
+        sStats.dfMax = std::max(sStats.dfMax, sBlock.dfMax);
+        const uint64_t nNewValidCount = sStats.nValidCount + sBlock.nValidCount;
+        const double dfDelta = sBlock.dfMean - sStats.dfMean;
+        const double dfBlockRatio =
+            static_cast<double>(sBlock.nValidCount) / nNewValidCount;
+        sStats.dfMean += dfDelta * dfBlockRatio;
+        sStats.dfM2 += sBlock.dfM2 + dfDelta * dfDelta * dfBlockRatio *
+                                         static_cast<double>(
+                                             sStats.nValidCount);
+        sStats.nValidCount = nNewValidCount;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                  SetStatisticsFromBlockStatistics()                  */
+/************************************************************************/
+
+// Sets the statistics of the band of index iBand (0-based) from the result
+// of DeriveBandStatistics(), which must have valid values.
+void GTiffDataset::SetStatisticsFromBlockStatistics(
+    int iBand, const BlockStatistics &sStats)
+{
+    auto poBand = cpl::down_cast<GTiffRasterBand *>(GetRasterBand(iBand + 1));
+    if (poBand->GetMetadataItem("STATISTICS_APPROXIMATE"))
+        poBand->SetMetadataItem("STATISTICS_APPROXIMATE", nullptr);
+    poBand->SetStatistics(
+        sStats.dfMin, sStats.dfMax, sStats.dfMean,
+        sqrt(sStats.dfM2 / static_cast<double>(sStats.nValidCount)));
+    poBand->SetValidPercent(sStats.nSampleCount, sStats.nValidCount);
+}
+
+/************************************************************************/
+/*                RefreshStatisticsFromBlockStatistics()                */
+/************************************************************************/
+
+// Bands whose blocks have been modified and that have statistics get them
+// re-derived from the block statistics, or removed if some blocks have no
+// summary.
+void GTiffDataset::RefreshStatisticsFromBlockStatistics()
+{
+    for (int iBand = 0; iBand < static_cast<int>(m_aoBlockStatistics.size());
+         ++iBand)
+    {
+        if (!m_aoBlockStatistics[iBand].bChanged)
+            continue;
+        m_aoBlockStatistics[iBand].bChanged = false;
+
+        auto poBand =
+            cpl::down_cast<GTiffRasterBand *>(GetRasterBand(iBand + 1));
+        if (poBand->GetMetadataItem("STATISTICS_MINIMUM") == nullptr)
+            continue;
+
+        BlockStatistics sStats;
+        if (DeriveBandStatistics(iBand, sStats) && sStats.nValidCount > 0)
+        {
+            SetStatisticsFromBlockStatistics(iBand, sStats);
+        }
+        else
+        {
+            for (const char *pszItem :
+                 {"STATISTICS_MINIMUM", "STATISTICS_MAXIMUM", "STATISTICS_MEAN",
+                  "STATISTICS_STDDEV", "STATISTICS_APPROXIMATE",
+                  "STATISTICS_VALID_PERCENT"})
+            {
+                if (poBand->GetMetadataItem(pszItem))
+                    poBand->SetMetadataItem(pszItem, nullptr);
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                        ReadBlockStatistics()                         */
+/************************************************************************/
+
+// Layout of the .blockstats file, all values being little-endian:
+// - the 16 bytes "GDAL_BLOCK_STATS" signature
+// - uint32 version (1), number of bands, blocks per band, block width,
+//   block height and data type
+// - for each band: uint32 whether the nodata value is set, uint32 padding,
+//   float64 nodata value
+// - for each band and block: uint64 number of pixels and of valid pixels,
+//   float64 minimum, maximum, mean and sum of squared differences to the
+//   mean. A number of pixels of 0 means that the block has no summary.
+
+constexpr const char BLOCK_STATISTICS_SIGNATURE[] = "GDAL_BLOCK_STATS";
+constexpr int BLOCK_STATISTICS_SIGNATURE_SIZE = 16;
+constexpr int BLOCK_STATISTICS_HEADER_SIZE =
+    BLOCK_STATISTICS_SIGNATURE_SIZE + 6 * 4;
+constexpr int BLOCK_STATISTICS_BAND_HEADER_SIZE = 16;
+constexpr int BLOCK_STATISTICS_RECORD_SIZE = 2 * 8 + 4 * 8;
+
+bool GTiffDataset::ReadBlockStatistics()
+{
+    const std::string osFilename = GetBlockStatisticsFilename();
+    const GUIntBig nExpectedSize =
+        BLOCK_STATISTICS_HEADER_SIZE +
+        static_cast<GUIntBig>(nBands) * BLOCK_STATISTICS_BAND_HEADER_SIZE +
+        static_cast<GUIntBig>(nBands) * m_nBlocksPerBand *
+            BLOCK_STATISTICS_RECORD_SIZE;
+    GByte *pabyData = nullptr;
+    vsi_l_offset nSize = 0;
+    if (!VSIIngestFile(nullptr, osFilename.c_str(), &pabyData, &nSize,
+                       static_cast<GIntBig>(nExpectedSize)))
+    {
+        return false;
+    }
+    std::unique_ptr<GByte, CPLFreeReleaser> oHolder(pabyData);
+    if (nSize != nExpectedSize ||
+        memcmp(pabyData, BLOCK_STATISTICS_SIGNATURE,
+               BLOCK_STATISTICS_SIGNATURE_SIZE) != 0)
+    {
+        return false;
+    }
+
+    size_t nOffset = BLOCK_STATISTICS_SIGNATURE_SIZE;
+    const auto ReadUInt32 = [pabyData, &nOffset]()
+    {
+        uint32_t nVal = 0;
+        memcpy(&nVal, pabyData + nOffset, sizeof(nVal));
+        CPL_LSBPTR32(&nVal);
+        nOffset += sizeof(nVal);
+        return nVal;
+    };
+    const auto ReadUInt64 = [pabyData, &nOffset]()
+    {
+        uint64_t nVal = 0;
+        memcpy(&nVal, pabyData + nOffset, sizeof(nVal));
+        CPL_LSBPTR64(&nVal);
+        nOffset += sizeof(nVal);
+        return nVal;
+    };
+    const auto ReadDouble = [pabyData, &nOffset]()
+    {
+        double dfVal = 0;
+        memcpy(&dfVal, pabyData + nOffset, sizeof(dfVal));
+        CPL_LSBPTR64(&dfVal);
+        nOffset += sizeof(dfVal);
+        return dfVal;
+    };
+
+    if (ReadUInt32() != 1 || ReadUInt32() != static_cast<uint32_t>(nBands) ||
+        ReadUInt32() != static_cast<uint32_t>(m_nBlocksPerBand) ||
+        ReadUInt32() != static_cast<uint32_t>(m_nBlockXSize) ||
+        ReadUInt32() != static_cast<uint32_t>(m_nBlockYSize) ||
+        ReadUInt32() !=
+            static_cast<uint32_t>(GetRasterBand(1)->GetRasterDataType()))
+    {
+        return false;
+    }
+
+    // The summaries are discarded by GetBandBlockStatistics() if the nodata
+    // value has changed since they were written.
+    for (auto &oBandStats : m_aoBlockStatistics)
+    {
+        oBandStats.bNoDataSet = ReadUInt32() != 0;
+        ReadUInt32();
+        oBandStats.dfNoDataValue = ReadDouble();
+    }
+
+    for (auto &oBandStats : m_aoBlockStatistics)
+    {
+        for (auto &sBlock : oBandStats.asBlocks)
+        {
+            sBlock.nSampleCount = ReadUInt64();
+            sBlock.nValidCount = ReadUInt64();
+            sBlock.dfMin = ReadDouble();
+            sBlock.dfMax = ReadDouble();
+            sBlock.dfMean = ReadDouble();
+            sBlock.dfM2 = ReadDouble();
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                        WriteBlockStatistics()                        */
+/************************************************************************/
+
+bool GTiffDataset::WriteBlockStatistics()
+{
+    if (!m_bBlockStatisticsDirty || m_aoBlockStatistics.empty())
+        return true;
+    m_bBlockStatisticsDirty = false;
+
+    std::vector<GByte> abyData;
+    const auto WriteUInt32 = [&abyData](uint32_t nVal)
+    {
+        CPL_LSBPTR32(&nVal);
+        const GByte *pabyVal = reinterpret_cast<const GByte *>(&nVal);
+        abyData.insert(abyData.end(), pabyVal, pabyVal + sizeof(nVal));
+    };
+    const auto WriteUInt64 = [&abyData](uint64_t nVal)
+    {
+        CPL_LSBPTR64(&nVal);
+        const GByte *pabyVal = reinterpret_cast<const GByte *>(&nVal);
+        abyData.insert(abyData.end(), pabyVal, pabyVal + sizeof(nVal));
+    };
+    const auto WriteDouble = [&abyData](double dfVal)
+    {
+        CPL_LSBPTR64(&dfVal);
+        const GByte *pabyVal = reinterpret_cast<const GByte *>(&dfVal);
+        abyData.insert(abyData.end(), pabyVal, pabyVal + sizeof(dfVal));
+    };
+
+    try
+    {
+        abyData.reserve(BLOCK_STATISTICS_HEADER_SIZE +
+                        static_cast<size_t>(nBands) *
+                            BLOCK_STATISTICS_BAND_HEADER_SIZE +
+                        static_cast<size_t>(nBands) * m_nBlocksPerBand *
+                            BLOCK_STATISTICS_RECORD_SIZE);
+        abyData.insert(abyData.end(), BLOCK_STATISTICS_SIGNATURE,
+                       BLOCK_STATISTICS_SIGNATURE +
+                           BLOCK_STATISTICS_SIGNATURE_SIZE);
+        WriteUInt32(1);
+        WriteUInt32(nBands);
+        WriteUInt32(m_nBlocksPerBand);
+        WriteUInt32(m_nBlockXSize);
+        WriteUInt32(m_nBlockYSize);
+        WriteUInt32(GetRasterBand(1)->GetRasterDataType());
+        for (const auto &oBandStats : m_aoBlockStatistics)
+        {
+            WriteUInt32(oBandStats.bNoDataSet ? 1 : 0);
+            WriteUInt32(0);
+            WriteDouble(oBandStats.dfNoDataValue);
+        }
+        for (const auto &oBandStats : m_aoBlockStatistics)
+        {
+            for (const auto &sBlock : oBandStats.asBlocks)
+            {
+                WriteUInt64(sBlock.nSampleCount);
+                WriteUInt64(sBlock.nValidCount);
+                WriteDouble(sBlock.dfMin);
+                WriteDouble(sBlock.dfMax);
+                WriteDouble(sBlock.dfMean);
+                WriteDouble(sBlock.dfM2);
+            }
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        ReportError(CE_Failure, CPLE_OutOfMemory,
+                    "Out of memory in WriteBlockStatistics()");
+        return false;
+    }
+
+    const std::string osFilename = GetBlockStatisticsFilename();
+    VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "wb");
+    bool bOK = fp != nullptr &&
+               VSIFWriteL(abyData.data(), 1, abyData.size(), fp) ==
+                   abyData.size();
+    if (fp && VSIFCloseL(fp) != 0)
+        bOK = false;
+    if (!bOK)
+    {
+        ReportError(CE_Warning, CPLE_FileIO, "Cannot write %s",
+                    osFilename.c_str());
+        // Do not leave a partial or outdated file.
+        VSIUnlink(osFilename.c_str());
+    }
+    return bOK;
+}
+
 /************************************************************************/
 /*                   GTiffFillStreamableOffsetAndCount()                */
 /************************************************************************/
@@ -2093,6 +2922,12 @@ CPLErr GTiffDataset::FlushCacheInternal(bool bAtClosing, bool bFlushDirectory)
         }
     }
 
+    if (!m_aoBlockStatistics.empty())
+    {
+        RefreshStatisticsFromBlockStatistics();
+        WriteBlockStatistics();
+    }
+
     if (bFlushDirectory && GetAccess() == GA_Update)
     {
         if (FlushDirectory() != CE_None)
@@ -6297,6 +7132,28 @@ CPLErr GTiffDataset::CopyImageryAndMask(GTiffDataset *poDstDS,
         CPLAssert(poDstDS->m_poMaskDS->m_nBlockYSize == poDstDS->m_nBlockYSize);
     }
 
+    // When compression is multi-threaded, read a whole row of blocks at once,
+    // so that sources able to decode several blocks in parallel (e.g. GTiff
+    // with NUM_THREADS) can do so, while the compression jobs of the previous
+    // row of blocks are still running.
+    const GSpacing nPixelSpace =
+        static_cast<GSpacing>(nDataTypeSize) * l_nBands;
+    const GSpacing nRowLineSpace = nPixelSpace * nXSize;
+    GByte *pabyRowBuffer = nullptr;
+    if (pBlockBuffer && !bIsOddBand && poDstDS->m_poCompressQueue &&
+        nXSize > poDstDS->m_nBlockXSize)
+    {
+        const GIntBig nRowBufferSize =
+            static_cast<GIntBig>(nRowLineSpace) * poDstDS->m_nBlockYSize;
+        if (nRowBufferSize <= GDALGetCacheMax64() / 4 &&
+            static_cast<uint64_t>(nRowBufferSize) <
+                std::numeric_limits<size_t>::max())
+        {
+            pabyRowBuffer = static_cast<GByte *>(
+                VSIMalloc(static_cast<size_t>(nRowBufferSize)));
+        }
+    }
+
     int iBlock = 0;
     for (int iY = 0, nYBlock = 0; iY < nYSize && eErr == CE_None;
          iY = ((nYSize - iY < poDstDS->m_nBlockYSize)
@@ -6305,6 +7162,13 @@ CPLErr GTiffDataset::CopyImageryAndMask(GTiffDataset *poDstDS,
              nYBlock++)
     {
         const int nReqYSize = std::min(nYSize - iY, poDstDS->m_nBlockYSize);
+        if (pabyRowBuffer)
+        {
+            eErr = poSrcDS->RasterIO(GF_Read, 0, iY, nXSize, nReqYSize,
+                                     pabyRowBuffer, nXSize, nReqYSize, eType,
+                                     l_nBands, nullptr, nPixelSpace,
+                                     nRowLineSpace, nDataTypeSize, nullptr);
+        }
         for (int iX = 0, nXBlock = 0; iX < nXSize && eErr == CE_None;
              iX = ((nXSize - iX < poDstDS->m_nBlockXSize)
                        ? nXSize
@@ -6320,7 +7184,21 @@ CPLErr GTiffDataset::CopyImageryAndMask(GTiffDataset *poDstDS,
                            poDstDS->m_nBlockYSize * l_nBands * nDataTypeSize);
             }
 
-            if (!bIsOddBand)
+            if (pabyRowBuffer)
+            {
+                for (int iLine = 0; iLine < nReqYSize; ++iLine)
+                {
+                    memcpy(static_cast<GByte *>(pBlockBuffer) +
+                               static_cast<size_t>(iLine) *
+                                   poDstDS->m_nBlockXSize * nPixelSpace,
+                           pabyRowBuffer + iLine * nRowLineSpace +
+                               iX * nPixelSpace,
+                           static_cast<size_t>(nReqXSize * nPixelSpace));
+                }
+                eErr = poDstDS->WriteEncodedTileOrStrip(iBlock, pBlockBuffer,
+                                                        false);
+            }
+            else if (!bIsOddBand)
             {
                 eErr = poSrcDS->RasterIO(
                     GF_Read, iX, iY, nReqXSize, nReqYSize, pBlockBuffer,
@@ -6421,6 +7299,7 @@ CPLErr GTiffDataset::CopyImageryAndMask(GTiffDataset *poDstDS,
         }
     }
     poDstDS->FlushCache(false);  // mostly to wait for thread completion
+    VSIFree(pabyRowBuffer);
     VSIFree(pBlockBuffer);
 
     return eErr;
@@ -6567,7 +7446,15 @@ GDALDataset *GTiffDataset::CreateCopy(const char *pszFilename,
             // to ignore source overviews.
             if (!EQUAL(pszOvrDS, ""))
             {
-                poOvrDS.reset(GDALDataset::Open(pszOvrDS));
+                // Enable multi-threaded decoding of the overview dataset
+                // when reading it for the copy.
+                CPLStringList aosOpenOptions;
+                aosOpenOptions.SetNameValue(
+                    "NUM_THREADS",
+                    CSLFetchNameValue(papszCreateOptions, "NUM_THREADS"));
+                poOvrDS.reset(GDALDataset::Open(pszOvrDS, GDAL_OF_RASTER,
+                                                nullptr,
+                                                aosOpenOptions.List()));
                 if (!poOvrDS)
                 {
                     CSLDestroy(papszCreateOptions);
@@ -7639,7 +8526,11 @@ GDALDataset *GTiffDataset::CreateCopy(const char *pszFilename,
             CSLFetchNameValue(papszOptions, "@MASK_OVERVIEW_DATASET");
         if (pszMaskOvrDS)
         {
-            poMaskOvrDS.reset(GDALDataset::Open(pszMaskOvrDS));
+            CPLStringList aosOpenOptions;
+            aosOpenOptions.SetNameValue(
+                "NUM_THREADS", CSLFetchNameValue(papszOptions, "NUM_THREADS"));
+            poMaskOvrDS.reset(GDALDataset::Open(
+                pszMaskOvrDS, GDAL_OF_RASTER, nullptr, aosOpenOptions.List()));
             if (!poMaskOvrDS)
             {
                 delete poDS;
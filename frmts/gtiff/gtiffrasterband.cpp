@@ -327,9 +327,12 @@ CPLErr GTiffRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
 
         if (bCanUseMultiThreadedRead)
         {
-            return m_poGDS->MultiThreadedRead(nXOff, nYOff, nXSize, nYSize,
-                                              pData, eBufType, 1, &nBand,
-                                              nPixelSpace, nLineSpace, 0);
+            const CPLErr eErr = m_poGDS->MultiThreadedRead(
+                nXOff, nYOff, nXSize, nYSize, pData, eBufType, 1, &nBand,
+                nPixelSpace, nLineSpace, 0);
+            if (eErr == CE_None)
+                m_poGDS->PrefetchNeighbourBlocks(nXOff, nYOff, nXSize, nYSize);
+            return eErr;
         }
         else if (m_poGDS->nBands != 1 &&
                  m_poGDS->m_nPlanarConfig == PLANARCONFIG_CONTIG)
@@ -463,6 +466,9 @@ CPLErr GTiffRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                                 nullptr, nullptr);
     }
 
+    if (eRWFlag == GF_Read && eErr == CE_None)
+        m_poGDS->PrefetchNeighbourBlocks(nXOff, nYOff, nXSize, nYSize);
+
     return eErr;
 }
 
@@ -482,3 +488,116 @@ int GTiffRasterBand::ComputeBlockId(int nBlockXOff, int nBlockYOff) const
     }
     return nBlockId;
 }
+
+/************************************************************************/
+/*                         ComputeStatistics()                          */
+/************************************************************************/
+
+CPLErr GTiffRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
+                                          double *pdfMax, double *pdfMean,
+                                          double *pdfStdDev,
+                                          GDALProgressFunc pfnProgress,
+                                          void *pProgressData)
+{
+    // Block statistics only take into account the nodata value, which is
+    // enough when GDALRasterBand::ComputeStatistics() would not use the mask
+    // band.
+    int bHasNoData = FALSE;
+    const double dfNoDataValue = GetNoDataValue(&bHasNoData);
+    const int nMaskFlags =
+        bHasNoData && !std::isnan(dfNoDataValue) ? GMF_NODATA : GetMaskFlags();
+    if ((nMaskFlags != GMF_ALL_VALID && nMaskFlags != GMF_NODATA &&
+         GetColorInterpretation() != GCI_AlphaBand) ||
+        !m_poGDS->InitBlockStatistics())
+    {
+        return GDALPamRasterBand::ComputeStatistics(bApproxOK, pdfMin, pdfMax,
+                                                    pdfMean, pdfStdDev,
+                                                    pfnProgress, pProgressData);
+    }
+
+    // Write pending blocks, so that their statistics are up to date.
+    if (eAccess == GA_Update &&
+        m_poGDS->FlushCacheInternal(false, false) != CE_None)
+    {
+        return CE_Failure;
+    }
+
+    GTiffDataset::BandBlockStatistics *poBandStats =
+        m_poGDS->GetBandBlockStatistics(nBand - 1);
+    if (poBandStats == nullptr)
+        return CE_Failure;
+    const int nMissingBlocks = static_cast<int>(std::count_if(
+        poBandStats->asBlocks.begin(), poBandStats->asBlocks.end(),
+        [](const GTiffDataset::BlockStatistics &sBlock)
+        { return sBlock.nSampleCount == 0; }));
+
+    // Reading blocks without a summary would be slower than approximate
+    // statistics.
+    if (nMissingBlocks > 0 && bApproxOK)
+    {
+        return GDALPamRasterBand::ComputeStatistics(bApproxOK, pdfMin, pdfMax,
+                                                    pdfMean, pdfStdDev,
+                                                    pfnProgress, pProgressData);
+    }
+
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+    if (!pfnProgress(0.0, "Compute Statistics", pProgressData))
+    {
+        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    int iMissingBlock = 0;
+    for (int iBlock = 0; iBlock < m_poGDS->m_nBlocksPerBand; ++iBlock)
+    {
+        if (poBandStats->asBlocks[iBlock].nSampleCount != 0)
+            continue;
+
+        GDALRasterBlock *poBlock =
+            GetLockedBlockRef(iBlock % m_poGDS->m_nBlocksPerRow,
+                              iBlock / m_poGDS->m_nBlocksPerRow);
+        if (poBlock == nullptr)
+            return CE_Failure;
+        m_poGDS->SummarizeBlock(nBand - 1, iBlock, poBlock->GetDataRef(), 1,
+                                nBlockXSize);
+        poBlock->DropLock();
+
+        ++iMissingBlock;
+        if (!pfnProgress(static_cast<double>(iMissingBlock) / nMissingBlocks,
+                         "Compute Statistics", pProgressData))
+        {
+            ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+
+    GTiffDataset::BlockStatistics sStats;
+    if (!m_poGDS->DeriveBandStatistics(nBand - 1, sStats))
+        return CE_Failure;
+    pfnProgress(1.0, "Compute Statistics", pProgressData);
+
+    if (sStats.nValidCount == 0)
+    {
+        SetValidPercent(sStats.nSampleCount, 0);
+        ReportError(
+            CE_Failure, CPLE_AppDefined,
+            "Failed to compute statistics, no valid pixels found in sampling.");
+        return CE_Failure;
+    }
+
+    m_poGDS->SetStatisticsFromBlockStatistics(nBand - 1, sStats);
+    // The statistics have been set with the current summaries.
+    poBandStats->bChanged = false;
+
+    if (pdfMin)
+        *pdfMin = sStats.dfMin;
+    if (pdfMax)
+        *pdfMax = sStats.dfMax;
+    if (pdfMean)
+        *pdfMean = sStats.dfMean;
+    if (pdfStdDev)
+        *pdfStdDev =
+            sqrt(sStats.dfM2 / static_cast<double>(sStats.nValidCount));
+    return CE_None;
+}
@@ -57,6 +57,7 @@ class GTiffRasterBand CPL_NON_FINAL : public GDALPamRasterBand
     GDALColorInterp m_eBandInterp = GCI_Undefined;
     std::set<GTiffRasterBand **> m_aSetPSelf{};
     bool m_bHaveOffsetScale = false;
+    int m_nNextReadAheadBlockId = -1;  // Used to detect sequential reads
 
     int DirectIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize,
                  int nYSize, void *pData, int nBufXSize, int nBufYSize,
@@ -73,6 +74,8 @@ class GTiffRasterBand CPL_NON_FINAL : public GDALPamRasterBand
                           int nBufXSize, int nBufYSize,
                           GDALRasterIOExtraArg *psExtraArg);
 
+    void ReadAhead(int nBlockXOff, int nBlockYOff);
+
   protected:
     GTiffDataset *m_poGDS = nullptr;
     GDALMultiDomainMetadata m_oGTiffMDMD{};
@@ -157,6 +160,11 @@ class GTiffRasterBand CPL_NON_FINAL : public GDALPamRasterBand
 
     virtual GDALRasterBand *GetMaskBand() override final;
     virtual int GetMaskFlags() override final;
+
+    CPLErr ComputeStatistics(int bApproxOK, double *pdfMin, double *pdfMax,
+                             double *pdfMean, double *pdfStdDev,
+                             GDALProgressFunc pfnProgress,
+                             void *pProgressData) override;
     virtual CPLErr CreateMaskBand(int nFlags) override final;
     virtual bool IsMaskBand() const override final;
     virtual GDALMaskValueRange GetMaskValueRange() const override final;
@@ -333,6 +333,9 @@ CPLVirtualMem *GTiffRasterBand::GetVirtualMemAuto(GDALRWFlag eRWFlag,
     if (psRet != nullptr)
     {
         CPLDebug("GTiff", "GetVirtualMemAuto(): Using memory file mapping");
+        // Writes through the mapping cannot be tracked.
+        if (eRWFlag == GF_Write)
+            m_poGDS->DisableBlockStatistics();
         return psRet;
     }
 
@@ -947,6 +950,10 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
                 int nBlockId = iX + iY * nBlocksPerRow;
                 if (m_poGDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE)
                     nBlockId += (nBand - 1) * m_poGDS->m_nBlocksPerBand;
+                // Already being fetched by PrefetchNeighbourBlocks()
+                if (m_poGDS->m_oMapPrefetchedStriles.find(nBlockId) !=
+                    m_poGDS->m_oMapPrefetchedStriles.end())
+                    continue;
                 vsi_l_offset nOffset = 0;
                 vsi_l_offset nSize = 0;
 
@@ -1170,6 +1177,84 @@ int GTiffRasterBand::IGetDataCoverageStatus(int nXOff, int nYOff, int nXSize,
     return nStatus;
 }
 
+/************************************************************************/
+/*                             ReadAhead()                              */
+/************************************************************************/
+
+// Called by IReadBlock() before decoding a block. If this block immediately
+// follows the previously decoded one (or the last block decoded by
+// anticipation), the next m_nReadAheadBlocks blocks of the same tile row
+// (or the next strips) are decoded in the thread pool and stored in the
+// block cache, so that subsequent ReadBlock() calls are cache hits.
+void GTiffRasterBand::ReadAhead(int nBlockXOff, int nBlockYOff)
+{
+    const int nBlockIdInBand = nBlockXOff + nBlockYOff * nBlocksPerRow;
+    const bool bSequential = nBlockIdInBand == m_nNextReadAheadBlockId;
+    m_nNextReadAheadBlockId = nBlockIdInBand + 1;
+    if (!bSequential ||
+        m_nNextReadAheadBlockId >= nBlocksPerRow * nBlocksPerColumn)
+        return;
+
+    const int nXBlock = m_nNextReadAheadBlockId % nBlocksPerRow;
+    const int nYBlock = m_nNextReadAheadBlockId / nBlocksPerRow;
+    int nXBlocks = 1;
+    int nYBlocks = 1;
+    if (nBlocksPerRow == 1)
+        nYBlocks =
+            std::min(m_poGDS->m_nReadAheadBlocks, nBlocksPerColumn - nYBlock);
+    else
+        nXBlocks =
+            std::min(m_poGDS->m_nReadAheadBlocks, nBlocksPerRow - nXBlock);
+
+    const int nXOff = nXBlock * nBlockXSize;
+    const int nYOff = nYBlock * nBlockYSize;
+    const int nXSize = std::min(nXBlocks * nBlockXSize, nRasterXSize - nXOff);
+    const int nYSize = std::min(nYBlocks * nBlockYSize, nRasterYSize - nYOff);
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+
+    // The decoded blocks are only of interest for the block cache, so
+    // make sure they fit in it.
+    const GIntBig nRequiredMem =
+        static_cast<GIntBig>(nXBlocks) * nYBlocks * nBlockXSize * nBlockYSize *
+        nDTSize;
+    if (nRequiredMem > GDALGetCacheMax64() / 4)
+        return;
+
+    std::vector<GByte> abyBuffer;
+    try
+    {
+        abyBuffer.resize(static_cast<size_t>(nXSize) * nYSize * nDTSize);
+    }
+    catch (const std::exception &)
+    {
+        return;
+    }
+
+    // Errors are silenced: they will be reported when the application
+    // actually requests the faulty blocks.
+    CPLErr eErr;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        eErr = m_poGDS->MultiThreadedRead(
+            nXOff, nYOff, nXSize, nYSize, abyBuffer.data(), eDataType, 1,
+            &nBand, nDTSize, static_cast<GSpacing>(nXSize) * nDTSize, 0);
+        CPLPopErrorHandler();
+    }
+    if (eErr != CE_None)
+    {
+        // Do not leave partially decoded blocks in the cache.
+        for (int y = 0; y < nYBlocks; ++y)
+        {
+            for (int x = 0; x < nXBlocks; ++x)
+                FlushBlock(nXBlock + x, nYBlock + y, FALSE);
+        }
+    }
+
+    m_nNextReadAheadBlockId =
+        nXBlock + nXBlocks - 1 + (nYBlock + nYBlocks - 1) * nBlocksPerRow + 1;
+}
+
 /************************************************************************/
 /*                             IReadBlock()                             */
 /************************************************************************/
@@ -1249,6 +1334,14 @@ CPLErr GTiffRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff, void *pImage)
     if (m_poGDS->nBands == 1 ||
         m_poGDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE)
     {
+        if (m_poGDS->m_nReadAheadBlocks > 0 &&
+            m_poGDS->m_nDisableMultiThreadedRead == 0 &&
+            m_poGDS->eAccess == GA_ReadOnly && !m_poGDS->m_bDirectIO &&
+            IsBaseGTiffClass() && m_poGDS->IsMultiThreadedReadCompatible())
+        {
+            ReadAhead(nBlockXOff, nBlockYOff);
+        }
+
         if (nBlockReqSize < nBlockBufSize)
             memset(pImage, 0, nBlockBufSize);
 
@@ -151,46 +151,72 @@ CPLErr GTiffRasterBand::IWriteBlock(int nBlockXOff, int nBlockYOff,
     /* -------------------------------------------------------------------- */
     const int nWordBytes = m_poGDS->m_nBitsPerSample / 8;
 
-    for (int iBand = 0; iBand < nBands; ++iBand)
+    if (bAllBlocksDirty)
     {
-        const GByte *pabyThisImage = nullptr;
-        GDALRasterBlock *poBlock = nullptr;
-
-        if (iBand + 1 == nBand)
+        // All blocks are available: interleave them at once.
+        const void *apSrcBuffers[MAX_BANDS_FOR_DIRTY_CHECK] = {};
+        for (int iBand = 0; iBand < nBands; ++iBand)
         {
-            pabyThisImage = static_cast<GByte *>(pImage);
+            apSrcBuffers[iBand] = iBand + 1 == nBand
+                                      ? pImage
+                                      : apoBlocks[iBand]->GetDataRef();
         }
-        else
+        GDALInterleave(apSrcBuffers, eDataType, nBands,
+                       m_poGDS->m_pabyBlockBuf, eDataType,
+                       static_cast<size_t>(nBlockXSize) * nBlockYSize);
+        for (int iBand = 0; iBand < nBands; ++iBand)
         {
-            if (nBands <= MAX_BANDS_FOR_DIRTY_CHECK)
-                poBlock = apoBlocks[iBand];
-            else
-                poBlock = cpl::down_cast<GTiffRasterBand *>(
-                              m_poGDS->GetRasterBand(iBand + 1))
-                              ->TryGetLockedBlockRef(nBlockXOff, nBlockYOff);
-
-            if (poBlock == nullptr)
-                continue;
+            if (apoBlocks[iBand] != nullptr)
+            {
+                apoBlocks[iBand]->MarkClean();
+                apoBlocks[iBand]->DropLock();
+            }
+        }
+    }
+    else
+    {
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            const GByte *pabyThisImage = nullptr;
+            GDALRasterBlock *poBlock = nullptr;
 
-            if (!poBlock->GetDirty())
+            if (iBand + 1 == nBand)
             {
-                poBlock->DropLock();
-                continue;
+                pabyThisImage = static_cast<GByte *>(pImage);
             }
+            else
+            {
+                if (nBands <= MAX_BANDS_FOR_DIRTY_CHECK)
+                    poBlock = apoBlocks[iBand];
+                else
+                    poBlock =
+                        cpl::down_cast<GTiffRasterBand *>(
+                            m_poGDS->GetRasterBand(iBand + 1))
+                            ->TryGetLockedBlockRef(nBlockXOff, nBlockYOff);
 
-            pabyThisImage = static_cast<GByte *>(poBlock->GetDataRef());
-        }
+                if (poBlock == nullptr)
+                    continue;
 
-        GByte *pabyOut = m_poGDS->m_pabyBlockBuf + iBand * nWordBytes;
+                if (!poBlock->GetDirty())
+                {
+                    poBlock->DropLock();
+                    continue;
+                }
 
-        GDALCopyWords64(pabyThisImage, eDataType, nWordBytes, pabyOut,
-                        eDataType, nWordBytes * nBands,
-                        static_cast<GPtrDiff_t>(nBlockXSize) * nBlockYSize);
+                pabyThisImage = static_cast<GByte *>(poBlock->GetDataRef());
+            }
 
-        if (poBlock != nullptr)
-        {
-            poBlock->MarkClean();
-            poBlock->DropLock();
+            GByte *pabyOut = m_poGDS->m_pabyBlockBuf + iBand * nWordBytes;
+
+            GDALCopyWords64(pabyThisImage, eDataType, nWordBytes, pabyOut,
+                            eDataType, nWordBytes * nBands,
+                            static_cast<GPtrDiff_t>(nBlockXSize) * nBlockYSize);
+
+            if (poBlock != nullptr)
+            {
+                poBlock->MarkClean();
+                poBlock->DropLock();
+            }
         }
     }
 
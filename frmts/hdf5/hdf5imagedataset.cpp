@@ -29,10 +29,13 @@
 
 #include "hdf5_api.h"
 
+#include "cpl_compressor.h"
 #include "cpl_string.h"
+#include "cpl_vsi_virtual.h"
 #include "gdal_frmts.h"
 #include "gdal_pam.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "gh5_convenience.h"
 #include "hdf5dataset.h"
 #include "hdf5drivercore.h"
@@ -40,6 +43,10 @@
 #include "../mem/memdataset.h"
 
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
 
 class HDF5ImageDataset final : public HDF5Dataset
 {
@@ -84,8 +91,30 @@ class HDF5ImageDataset final : public HDF5Dataset
     int m_nYIndex = -1;
     int m_nOtherDimIndex = -1;
 
+    // Direct chunk reading, bypassing the libhdf5 filter pipeline.
+    bool m_bDirectChunkRead = false;
+    bool m_bChunkShuffle = false;
+    bool m_bChunkDeflate = false;
+    int m_nChunkXSize = 0;  // 0 if not chunked, or unhandled layout
+    int m_nChunkYSize = 0;
+    vsi_l_offset m_nBaseAddress = 0;
+    int m_nDirectChunkReadThreads = 1;
+    VSIVirtualHandleUniquePtr m_fpRaw{};
+
     CPLErr CreateODIMH5Projection();
 
+    void InitDirectChunkRead();
+    bool GetChunkLocation(int nBand, int nChunkX, int nChunkY,
+                          unsigned &nFilterMask, vsi_l_offset &nOffset,
+                          size_t &nSize) const;
+    bool DecodeChunk(const GByte *pabySrc, size_t nSrcSize, int nChunkX,
+                     int nChunkY, int nXOff, int nYOff, int nXSize, int nYSize,
+                     GByte *pabyData, GSpacing nPixelSpace,
+                     GSpacing nLineSpace) const;
+    bool ReadChunksDirectly(int nBand, int nXOff, int nYOff, int nXSize,
+                            int nYSize, GByte *pabyData, GSpacing nPixelSpace,
+                            GSpacing nLineSpace);
+
   public:
     HDF5ImageDataset();
     virtual ~HDF5ImageDataset();
@@ -238,6 +267,8 @@ class HDF5ImageRasterBand final : public GDALPamRasterBand
 
     virtual CPLErr IReadBlock(int, int, void *) override;
     virtual double GetNoDataValue(int *) override;
+    virtual const char *GetMetadataItem(const char *pszName,
+                                        const char *pszDomain = "") override;
     // virtual CPLErr IWriteBlock( int, int, void * );
 
     CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize,
@@ -317,8 +348,6 @@ double HDF5ImageRasterBand::GetNoDataValue(int *pbSuccess)
 CPLErr HDF5ImageRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff,
                                        void *pImage)
 {
-    HDF5_GLOBAL_LOCK();
-
     HDF5ImageDataset *poGDS = static_cast<HDF5ImageDataset *>(poDS);
 
     memset(pImage, 0,
@@ -330,6 +359,26 @@ CPLErr HDF5ImageRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff,
         return CE_None;
     }
 
+    // Blocks match chunks in that mode, and the decompression is done
+    // without holding the HDF5 global lock.
+    if (poGDS->m_bDirectChunkRead)
+    {
+        const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+        const int nXOff = nBlockXOff * nBlockXSize;
+        const int nYOff = nBlockYOff * nBlockYSize;
+        const int nXSize = std::min(nBlockXSize, nRasterXSize - nXOff);
+        const int nYSize = std::min(nBlockYSize, nRasterYSize - nYOff);
+        if (poGDS->ReadChunksDirectly(
+                nBand, nXOff, nYOff, nXSize, nYSize,
+                static_cast<GByte *>(pImage), nDTSize,
+                static_cast<GSpacing>(nDTSize) * nBlockXSize))
+        {
+            return CE_None;
+        }
+    }
+
+    HDF5_GLOBAL_LOCK();
+
     hsize_t count[3] = {0, 0, 0};
     H5OFFSET_TYPE offset[3] = {0, 0, 0};
     hsize_t col_dims[3] = {0, 0, 0};
@@ -419,6 +468,15 @@ CPLErr HDF5ImageRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
 
     const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
 
+    if (eRWFlag == GF_Read && poGDS->m_bDirectChunkRead &&
+        nXSize == nBufXSize && nYSize == nBufYSize && eBufType == eDataType &&
+        poGDS->ReadChunksDirectly(nBand, nXOff, nYOff, nXSize, nYSize,
+                                  static_cast<GByte *>(pData), nPixelSpace,
+                                  nLineSpace))
+    {
+        return CE_None;
+    }
+
     if (eRWFlag == GF_Read && bIsExpectedLayout && nXSize == nBufXSize &&
         nYSize == nBufYSize && eBufType == eDataType &&
         nPixelSpace == nDTSize && nLineSpace == nXSize * nPixelSpace)
@@ -502,6 +560,443 @@ CPLErr HDF5ImageRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                                         nPixelSpace, nLineSpace, psExtraArg);
 }
 
+/************************************************************************/
+/*                          GetMetadataItem()                           */
+/************************************************************************/
+
+const char *HDF5ImageRasterBand::GetMetadataItem(const char *pszName,
+                                                 const char *pszDomain)
+{
+    HDF5ImageDataset *poGDS = static_cast<HDF5ImageDataset *>(poDS);
+
+    // Expose the location of chunks, e.g. for external tools issuing
+    // their own (range) requests.
+    if (pszName && pszDomain && EQUAL(pszDomain, "HDF5") &&
+        poGDS->m_nChunkXSize > 0)
+    {
+        int nBlockXOff = 0;
+        int nBlockYOff = 0;
+        const bool bOffset = STARTS_WITH_CI(pszName, "BLOCK_OFFSET_");
+        const bool bSize = STARTS_WITH_CI(pszName, "BLOCK_SIZE_");
+        if ((bOffset || bSize) &&
+            sscanf(pszName + (bOffset ? strlen("BLOCK_OFFSET_")
+                                      : strlen("BLOCK_SIZE_")),
+                   "%d_%d", &nBlockXOff, &nBlockYOff) == 2)
+        {
+            if (nBlockXOff < 0 || nBlockYOff < 0 ||
+                nBlockXOff >= DIV_ROUND_UP(nRasterXSize, nBlockXSize) ||
+                nBlockYOff >= DIV_ROUND_UP(nRasterYSize, nBlockYSize))
+            {
+                return nullptr;
+            }
+            unsigned nFilterMask = 0;
+            vsi_l_offset nOffset = 0;
+            size_t nSize = 0;
+            if (!poGDS->GetChunkLocation(nBand, nBlockXOff, nBlockYOff,
+                                         nFilterMask, nOffset, nSize))
+            {
+                return nullptr;
+            }
+            return bOffset ? CPLSPrintf(CPL_FRMT_GUIB,
+                                        static_cast<GUIntBig>(nOffset))
+                           : CPLSPrintf(CPL_FRMT_GUIB,
+                                        static_cast<GUIntBig>(nSize));
+        }
+    }
+
+    return GDALPamRasterBand::GetMetadataItem(pszName, pszDomain);
+}
+
+/************************************************************************/
+/*                        InitDirectChunkRead()                         */
+/*                                                                      */
+/*      For chunked datasets only using the deflate and shuffle         */
+/*      filters, chunks can be read and decompressed by GDAL itself,    */
+/*      out of the HDF5 global lock, with several threads, and with     */
+/*      coalesced range requests on network file systems.               */
+/************************************************************************/
+
+void HDF5ImageDataset::InitDirectChunkRead()
+{
+#if defined(H5_VERSION_GE) && H5_VERSION_GE(1, 10, 5)
+    const bool bIsExpectedLayout =
+        ((ndims == 3 && m_nOtherDimIndex == 0 && GetYIndex() == 1 &&
+          GetXIndex() == 2) ||
+         (ndims == 2 && GetYIndex() == 0 && GetXIndex() == 1));
+    if (!bIsExpectedLayout)
+        return;
+
+    const hid_t listid = H5Dget_create_plist(dataset_id);
+    if (listid < 0)
+        return;
+    hsize_t anChunkDims[3] = {0, 0, 0};
+    if (H5Pget_layout(listid) != H5D_CHUNKED ||
+        H5Pget_chunk(listid, 3, anChunkDims) != ndims ||
+        (ndims == 3 && anChunkDims[0] != 1))
+    {
+        H5Pclose(listid);
+        return;
+    }
+    m_nChunkYSize = static_cast<int>(anChunkDims[ndims - 2]);
+    m_nChunkXSize = static_cast<int>(anChunkDims[ndims - 1]);
+
+    // Only accept shuffle and/or deflate, in the order the libhdf5
+    // applies them when writing.
+    bool bFiltersOK = true;
+    const int nFilters = H5Pget_nfilters(listid);
+    for (int i = 0; bFiltersOK && i < nFilters; ++i)
+    {
+        unsigned int nFlags = 0;
+        size_t nCDValues = 0;
+        const H5Z_filter_t nFilter = H5Pget_filter2(
+            listid, static_cast<unsigned>(i), &nFlags, &nCDValues, nullptr, 0,
+            nullptr, nullptr);
+        if (nFilter == H5Z_FILTER_SHUFFLE && !m_bChunkShuffle &&
+            !m_bChunkDeflate)
+            m_bChunkShuffle = true;
+        else if (nFilter == H5Z_FILTER_DEFLATE && !m_bChunkDeflate)
+            m_bChunkDeflate = true;
+        else
+            bFiltersOK = false;
+    }
+    H5Pclose(listid);
+
+    // Chunk addresses are relative to the end of the user block.
+    const hid_t fcplid = H5Fget_create_plist(m_hHDF5);
+    if (fcplid >= 0)
+    {
+        hsize_t nUserBlockSize = 0;
+        if (H5Pget_userblock(fcplid, &nUserBlockSize) >= 0)
+            m_nBaseAddress = static_cast<vsi_l_offset>(nUserBlockSize);
+        H5Pclose(fcplid);
+    }
+
+    const H5T_class_t eClass = H5Tget_class(datatype);
+    if (!bFiltersOK || (eClass != H5T_INTEGER && eClass != H5T_FLOAT) ||
+        H5Tequal(datatype, native) <= 0 ||
+        (m_bChunkDeflate && CPLGetDecompressor("zlib") == nullptr) ||
+        !CPLTestBool(
+            CPLGetConfigOption("GDAL_HDF5_DIRECT_CHUNK_READ", "YES")))
+    {
+        return;
+    }
+    m_bDirectChunkRead = true;
+
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    m_nDirectChunkReadThreads =
+        pszNumThreads == nullptr ? std::min(4, CPLGetNumCPUs())
+        : EQUAL(pszNumThreads, "ALL_CPUS")
+            ? CPLGetNumCPUs()
+            : std::max(1, std::min(128, atoi(pszNumThreads)));
+#endif
+}
+
+/************************************************************************/
+/*                          GetChunkLocation()                          */
+/************************************************************************/
+
+bool HDF5ImageDataset::GetChunkLocation(int nBand, int nChunkX, int nChunkY,
+                                        unsigned &nFilterMask,
+                                        vsi_l_offset &nOffset,
+                                        size_t &nSize) const
+{
+#if defined(H5_VERSION_GE) && H5_VERSION_GE(1, 10, 5)
+    HDF5_GLOBAL_LOCK();
+
+    hsize_t anOffset[3] = {0, 0, 0};
+    int iDim = 0;
+    if (ndims == 3)
+        anOffset[iDim++] = static_cast<hsize_t>(nBand - 1);
+    anOffset[iDim++] = static_cast<hsize_t>(nChunkY) * m_nChunkYSize;
+    anOffset[iDim] = static_cast<hsize_t>(nChunkX) * m_nChunkXSize;
+
+    haddr_t nAddr = HADDR_UNDEF;
+    hsize_t nStorageSize = 0;
+    // Not allocated chunks (only fill value) have an undefined address.
+    if (H5Dget_chunk_info_by_coord(dataset_id, anOffset, &nFilterMask, &nAddr,
+                                   &nStorageSize) < 0 ||
+        nAddr == HADDR_UNDEF || nStorageSize == 0 ||
+        nStorageSize > std::numeric_limits<size_t>::max())
+    {
+        return false;
+    }
+    nOffset = m_nBaseAddress + static_cast<vsi_l_offset>(nAddr);
+    nSize = static_cast<size_t>(nStorageSize);
+    return true;
+#else
+    CPL_IGNORE_RET_VAL(nBand);
+    CPL_IGNORE_RET_VAL(nChunkX);
+    CPL_IGNORE_RET_VAL(nChunkY);
+    CPL_IGNORE_RET_VAL(nFilterMask);
+    CPL_IGNORE_RET_VAL(nOffset);
+    CPL_IGNORE_RET_VAL(nSize);
+    return false;
+#endif
+}
+
+/************************************************************************/
+/*                            DecodeChunk()                             */
+/*                                                                      */
+/*      Decompress and unshuffle a raw chunk, and copy its intersection */
+/*      with the requested window into the user buffer. May be called   */
+/*      from worker threads.                                            */
+/************************************************************************/
+
+bool HDF5ImageDataset::DecodeChunk(const GByte *pabySrc, size_t nSrcSize,
+                                   int nChunkX, int nChunkY, int nXOff,
+                                   int nYOff, int nXSize, int nYSize,
+                                   GByte *pabyData, GSpacing nPixelSpace,
+                                   GSpacing nLineSpace) const
+{
+    const size_t nDTSize = static_cast<size_t>(size);
+    const size_t nElts = static_cast<size_t>(m_nChunkXSize) * m_nChunkYSize;
+    const size_t nChunkBytes = nElts * nDTSize;
+
+    std::vector<GByte> abyInflated;
+    if (m_bChunkDeflate)
+    {
+        try
+        {
+            abyInflated.resize(nChunkBytes);
+        }
+        catch (const std::exception &)
+        {
+            return false;
+        }
+        const CPLCompressor *psDecompressor = CPLGetDecompressor("zlib");
+        void *pOut = abyInflated.data();
+        size_t nOutSize = nChunkBytes;
+        if (!psDecompressor->pfnFunc(pabySrc, nSrcSize, &pOut, &nOutSize,
+                                     nullptr, psDecompressor->user_data) ||
+            nOutSize != nChunkBytes)
+        {
+            return false;
+        }
+        pabySrc = abyInflated.data();
+    }
+    else if (nSrcSize != nChunkBytes)
+    {
+        return false;
+    }
+
+    std::vector<GByte> abyUnshuffled;
+    if (m_bChunkShuffle && nDTSize > 1)
+    {
+        try
+        {
+            abyUnshuffled.resize(nChunkBytes);
+        }
+        catch (const std::exception &)
+        {
+            return false;
+        }
+        // The shuffle filter groups the i-th byte of all elements together.
+        for (size_t iByte = 0; iByte < nDTSize; ++iByte)
+        {
+            const GByte *pabyIn = pabySrc + iByte * nElts;
+            GByte *pabyOut = abyUnshuffled.data() + iByte;
+            for (size_t i = 0; i < nElts; ++i)
+                pabyOut[i * nDTSize] = pabyIn[i];
+        }
+        pabySrc = abyUnshuffled.data();
+    }
+
+    const int nChunkXOff = nChunkX * m_nChunkXSize;
+    const int nChunkYOff = nChunkY * m_nChunkYSize;
+    const int nX0 = std::max(nXOff, nChunkXOff);
+    const int nX1 = std::min(nXOff + nXSize, nChunkXOff + m_nChunkXSize);
+    const int nY0 = std::max(nYOff, nChunkYOff);
+    const int nY1 = std::min(nYOff + nYSize, nChunkYOff + m_nChunkYSize);
+    for (int iY = nY0; iY < nY1; ++iY)
+    {
+        const GByte *pabySrcLine =
+            pabySrc + (static_cast<size_t>(iY - nChunkYOff) * m_nChunkXSize +
+                       (nX0 - nChunkXOff)) *
+                          nDTSize;
+        GByte *pabyDstLine = pabyData + (iY - nYOff) * nLineSpace +
+                             (nX0 - nXOff) * nPixelSpace;
+        if (nPixelSpace == static_cast<GSpacing>(nDTSize))
+        {
+            memcpy(pabyDstLine, pabySrcLine, (nX1 - nX0) * nDTSize);
+        }
+        else
+        {
+            for (int iX = nX0; iX < nX1; ++iX)
+            {
+                memcpy(pabyDstLine, pabySrcLine, nDTSize);
+                pabySrcLine += nDTSize;
+                pabyDstLine += nPixelSpace;
+            }
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         ReadChunksDirectly()                         */
+/*                                                                      */
+/*      Returns false if the request must be served through libhdf5,    */
+/*      e.g. if a chunk is not allocated or skips a filter.             */
+/************************************************************************/
+
+bool HDF5ImageDataset::ReadChunksDirectly(int nBand, int nXOff, int nYOff,
+                                          int nXSize, int nYSize,
+                                          GByte *pabyData, GSpacing nPixelSpace,
+                                          GSpacing nLineSpace)
+{
+    struct Chunk
+    {
+        int nX;
+        int nY;
+        vsi_l_offset nOffset;
+        size_t nSize;
+    };
+
+    std::vector<Chunk> asChunks;
+    const int nChunkX0 = nXOff / m_nChunkXSize;
+    const int nChunkX1 = (nXOff + nXSize - 1) / m_nChunkXSize;
+    const int nChunkY0 = nYOff / m_nChunkYSize;
+    const int nChunkY1 = (nYOff + nYSize - 1) / m_nChunkYSize;
+    for (int nY = nChunkY0; nY <= nChunkY1; ++nY)
+    {
+        for (int nX = nChunkX0; nX <= nChunkX1; ++nX)
+        {
+            unsigned nFilterMask = 0;
+            Chunk sChunk{nX, nY, 0, 0};
+            if (!GetChunkLocation(nBand, nX, nY, nFilterMask, sChunk.nOffset,
+                                  sChunk.nSize) ||
+                nFilterMask != 0)
+            {
+                return false;
+            }
+            asChunks.push_back(sChunk);
+        }
+    }
+
+    if (!m_fpRaw)
+    {
+        m_fpRaw.reset(VSIFOpenL(GetPhysicalFilename(), "rb"));
+        if (!m_fpRaw)
+        {
+            m_bDirectChunkRead = false;
+            return false;
+        }
+    }
+
+    std::unique_ptr<CPLJobQueue> poQueue;
+    if (m_nDirectChunkReadThreads > 1 && asChunks.size() > 1)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(m_nDirectChunkReadThreads);
+        if (poThreadPool)
+            poQueue = poThreadPool->CreateJobQueue();
+    }
+
+    struct Job
+    {
+        const HDF5ImageDataset *poDS;
+        const Chunk *psChunk;
+        const GByte *pabySrc;
+        int nXOff;
+        int nYOff;
+        int nXSize;
+        int nYSize;
+        GByte *pabyData;
+        GSpacing nPixelSpace;
+        GSpacing nLineSpace;
+        std::atomic<bool> *pbSuccess;
+    };
+
+    const auto DecodeJob = [](void *pData)
+    {
+        const Job *psJob = static_cast<const Job *>(pData);
+        if (!psJob->poDS->DecodeChunk(
+                psJob->pabySrc, psJob->psChunk->nSize, psJob->psChunk->nX,
+                psJob->psChunk->nY, psJob->nXOff, psJob->nYOff, psJob->nXSize,
+                psJob->nYSize, psJob->pabyData, psJob->nPixelSpace,
+                psJob->nLineSpace))
+        {
+            *(psJob->pbSuccess) = false;
+        }
+    };
+
+    // Read and decode by batches, to bound the memory used by raw chunks.
+    constexpr size_t MAX_BATCH_SIZE = 64 * 1024 * 1024;
+    std::atomic<bool> bSuccess(true);
+    for (size_t iStart = 0; iStart < asChunks.size() && bSuccess;)
+    {
+        size_t nBatchSize = 0;
+        size_t iEnd = iStart;
+        while (iEnd < asChunks.size() &&
+               (iEnd == iStart ||
+                nBatchSize + asChunks[iEnd].nSize <= MAX_BATCH_SIZE))
+        {
+            nBatchSize += asChunks[iEnd].nSize;
+            ++iEnd;
+        }
+
+        std::vector<GByte> abyRaw;
+        try
+        {
+            abyRaw.resize(nBatchSize);
+        }
+        catch (const std::exception &)
+        {
+            return false;
+        }
+        const int nRanges = static_cast<int>(iEnd - iStart);
+        std::vector<void *> apData(nRanges);
+        std::vector<vsi_l_offset> anOffsets(nRanges);
+        std::vector<size_t> anSizes(nRanges);
+        size_t nPos = 0;
+        for (int i = 0; i < nRanges; ++i)
+        {
+            apData[i] = abyRaw.data() + nPos;
+            anOffsets[i] = asChunks[iStart + i].nOffset;
+            anSizes[i] = asChunks[iStart + i].nSize;
+            nPos += anSizes[i];
+        }
+        // On network file systems, this coalesces requests of
+        // neighbouring chunks.
+        if (VSIFReadMultiRangeL(nRanges, apData.data(), anOffsets.data(),
+                                anSizes.data(), m_fpRaw.get()) != 0)
+        {
+            return false;
+        }
+
+        std::vector<Job> asJobs(nRanges);
+        for (int i = 0; i < nRanges; ++i)
+        {
+            Job &sJob = asJobs[i];
+            sJob.poDS = this;
+            sJob.psChunk = &asChunks[iStart + i];
+            sJob.pabySrc = static_cast<const GByte *>(apData[i]);
+            sJob.nXOff = nXOff;
+            sJob.nYOff = nYOff;
+            sJob.nXSize = nXSize;
+            sJob.nYSize = nYSize;
+            sJob.pabyData = pabyData;
+            sJob.nPixelSpace = nPixelSpace;
+            sJob.nLineSpace = nLineSpace;
+            sJob.pbSuccess = &bSuccess;
+            if (poQueue)
+                poQueue->SubmitJob(DecodeJob, &sJob);
+            else
+                DecodeJob(&sJob);
+        }
+        if (poQueue)
+            poQueue->WaitCompletion();
+
+        iStart = iEnd;
+    }
+
+    if (!bSuccess)
+    {
+        CPLDebug("HDF5", "Direct chunk decoding failed. "
+                         "Falling back to the libhdf5 read path");
+    }
+    return bSuccess;
+}
+
 /************************************************************************/
 /*                             IRasterIO()                              */
 /************************************************************************/
@@ -528,6 +1023,21 @@ CPLErr HDF5ImageDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
     const auto eDT = GetRasterBand(1)->GetRasterDataType();
     const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
 
+    if (eRWFlag == GF_Read && m_bDirectChunkRead && nXSize == nBufXSize &&
+        nYSize == nBufYSize && eBufType == eDT)
+    {
+        bool bOK = true;
+        for (int i = 0; bOK && i < nBandCount; ++i)
+        {
+            bOK = ReadChunksDirectly(
+                panBandMap[i], nXOff, nYOff, nXSize, nYSize,
+                static_cast<GByte *>(pData) + i * nBandSpace, nPixelSpace,
+                nLineSpace);
+        }
+        if (bOK)
+            return CE_None;
+    }
+
     // Band-interleaved data and request
     const bool bIsBandInterleavedData = ndims == 3 && m_nOtherDimIndex == 0 &&
                                         GetYIndex() == 1 && GetXIndex() == 2;
@@ -938,6 +1448,8 @@ GDALDataset *HDF5ImageDataset::Open(GDALOpenInfo *poOpenInfo)
         }
     }
 
+    poDS->InitDirectChunkRead();
+
     for (int i = 0; i < nBands; i++)
     {
         HDF5ImageRasterBand *const poBand = new HDF5ImageRasterBand(
@@ -316,6 +316,11 @@ class HDF5Array final : public GDALMDArray
                const GDALExtendedDataType &bufferDataType,
                void *pDstBuffer) const override;
 
+    bool CanUseChunkCache() const override
+    {
+        return true;
+    }
+
   public:
     ~HDF5Array();
 
@@ -359,6 +364,8 @@ class HDF5Array final : public GDALMDArray
         return m_dt;
     }
 
+    std::vector<GUInt64> GetBlockSize() const override;
+
     std::shared_ptr<GDALAttribute>
     GetAttribute(const std::string &osName) const override;
 
@@ -1346,6 +1353,40 @@ void HDF5Array::InstantiateDimensions(const std::string &osParentName,
     }
 }
 
+/************************************************************************/
+/*                            GetBlockSize()                            */
+/************************************************************************/
+
+std::vector<GUInt64> HDF5Array::GetBlockSize() const
+{
+    const auto nDimCount = GetDimensionCount();
+    std::vector<GUInt64> res(nDimCount);
+    if (res.empty())
+        return res;
+
+    HDF5_GLOBAL_LOCK();
+
+    const hid_t listid = H5Dget_create_plist(m_hArray);
+    if (listid > 0)
+    {
+        if (H5Pget_layout(listid) == H5D_CHUNKED)
+        {
+            std::vector<hsize_t> anChunkDims(nDimCount);
+            const int nDimSize = H5Pget_chunk(
+                listid, static_cast<int>(nDimCount), &anChunkDims[0]);
+            if (static_cast<size_t>(nDimSize) == nDimCount)
+            {
+                for (size_t i = 0; i < nDimCount; ++i)
+                    res[i] = anChunkDims[i];
+            }
+        }
+
+        H5Pclose(listid);
+    }
+
+    return res;
+}
+
 /************************************************************************/
 /*                      GetCoordinateVariables()                        */
 /************************************************************************/
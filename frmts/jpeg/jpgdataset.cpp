@@ -2190,6 +2190,11 @@ CPLErr JPGDataset::LoadScanline(int iLine, GByte *outBuffer)
             return CE_Failure;
     }
 
+    // No RAII GDALCodecStatisticsRecorder due to setjmp()
+    const auto oStart = std::chrono::steady_clock::now();
+    const vsi_l_offset nStartPos = VSIFTellL(m_fpImage);
+    const int nFirstLine = nLoadedScanline;
+
     while (nLoadedScanline < iLine)
     {
         GDAL_JSAMPLE *ppSamples = reinterpret_cast<GDAL_JSAMPLE *>(
@@ -2204,6 +2209,14 @@ CPLErr JPGDataset::LoadScanline(int iLine, GByte *outBuffer)
         nLoadedScanline++;
     }
 
+    GDALCodecStatisticsRecorder::Account(
+        this, GDALCodecStatisticsRecorder::Operation::DECODE,
+        std::chrono::steady_clock::now() - oStart,
+        static_cast<GIntBig>(VSIFTellL(m_fpImage) - nStartPos),
+        static_cast<GIntBig>(nLoadedScanline - nFirstLine) *
+            sDInfo.output_width * sDInfo.output_components *
+            static_cast<int>(sizeof(GDAL_JSAMPLE)));
+
     return CE_None;
 }
 
@@ -36,6 +36,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <limits>
+#include <memory>
 
 #include "jxl_headers.h"
 
@@ -53,6 +54,42 @@ struct VSILFileReleaser
 };
 }  // namespace
 
+/************************************************************************/
+/*                          RescaleToNBits()                            */
+/************************************************************************/
+
+// Rescale samples decoded by libjxl on the full range of 8-bits/16-bits
+// data types to their nBits original range.
+static void RescaleToNBits(void *pBuffer, size_t nSamples, GDALDataType eDT,
+                           int nBits)
+{
+    const int nMaxVal = (1 << nBits) - 1;
+    if (eDT == GDT_Byte)
+    {
+        const int nHalfMaxWidth = 127;
+        GByte *panData = static_cast<GByte *>(pBuffer);
+        for (size_t i = 0; i < nSamples; ++i)
+        {
+            panData[i] = static_cast<GByte>(
+                (panData[i] * nMaxVal + nHalfMaxWidth) / 255);
+        }
+    }
+    else if (eDT == GDT_UInt16)
+    {
+        const int nHalfMaxWidth = 32767;
+        uint16_t *panData = static_cast<uint16_t *>(pBuffer);
+        for (size_t i = 0; i < nSamples; ++i)
+        {
+            panData[i] = static_cast<uint16_t>(
+                (panData[i] * nMaxVal + nHalfMaxWidth) / 65535);
+        }
+    }
+}
+
+#ifdef HAVE_JxlDecoderSetProgressiveDetail
+class JPEGXLDCOverviewDataset;
+#endif
+
 /************************************************************************/
 /*                        JPEGXLDataset                                 */
 /************************************************************************/
@@ -60,6 +97,9 @@ struct VSILFileReleaser
 class JPEGXLDataset final : public GDALJP2AbstractDataset
 {
     friend class JPEGXLRasterBand;
+#ifdef HAVE_JxlDecoderSetProgressiveDetail
+    friend class JPEGXLDCOverviewDataset;
+#endif
 
     VSILFILE *m_fp = nullptr;
     JxlDecoderPtr m_decoder{};
@@ -72,6 +112,10 @@ class JPEGXLDataset final : public GDALJP2AbstractDataset
     std::vector<GByte> m_abyInputData{};
     int m_nBits = 0;
     int m_nNonAlphaExtraChannels = 0;
+#ifdef HAVE_JxlDecoderSetProgressiveDetail
+    bool m_bHasDCOverview = false;
+    std::unique_ptr<JPEGXLDCOverviewDataset> m_poDCOverviewDS{};
+#endif
 #ifdef HAVE_JXL_BOX_API
     std::string m_osXMP{};
     char *m_apszXMP[2] = {nullptr, nullptr};
@@ -85,6 +129,10 @@ class JPEGXLDataset final : public GDALJP2AbstractDataset
 
     void GetDecodedImage(void *pabyOutputData, size_t nOutputDataSize);
 
+#ifdef HAVE_JxlDecoderSetProgressiveDetail
+    JPEGXLDCOverviewDataset *GetDCOverview();
+#endif
+
   protected:
     CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
                      GDALDataType, int, int *, GSpacing, GSpacing, GSpacing,
@@ -136,8 +184,53 @@ class JPEGXLRasterBand final : public GDALPamRasterBand
     JPEGXLRasterBand(JPEGXLDataset *poDSIn, int nBandIn,
                      GDALDataType eDataTypeIn, int nBitsPerSample,
                      GDALColorInterp eInterp);
+
+#ifdef HAVE_JxlDecoderSetProgressiveDetail
+    int GetOverviewCount() override;
+    GDALRasterBand *GetOverview(int iOvr) override;
+#endif
 };
 
+#ifdef HAVE_JxlDecoderSetProgressiveDetail
+
+/************************************************************************/
+/*                      JPEGXLDCOverviewDataset                         */
+/************************************************************************/
+
+// Exposes the DC image of a lossy (VarDCT) codestream, that is the 1:8 scale
+// image decoded before the AC coefficients, as an overview of the full
+// resolution dataset. Only the beginning of each frame needs to be read and
+// decoded to get it.
+class JPEGXLDCOverviewDataset final : public GDALDataset
+{
+    friend class JPEGXLDCOverviewBand;
+
+    JPEGXLDataset *m_poParentDS = nullptr;
+    bool m_bDecodingFailed = false;
+    std::vector<GByte> m_abyImage{};
+
+    const std::vector<GByte> &GetDecodedImage();
+
+  public:
+    explicit JPEGXLDCOverviewDataset(JPEGXLDataset *poParentDS);
+};
+
+/************************************************************************/
+/*                        JPEGXLDCOverviewBand                          */
+/************************************************************************/
+
+class JPEGXLDCOverviewBand final : public GDALRasterBand
+{
+  protected:
+    CPLErr IReadBlock(int nBlockXOff, int nBlockYOff, void *pData) override;
+
+  public:
+    JPEGXLDCOverviewBand(JPEGXLDCOverviewDataset *poDSIn, int nBandIn,
+                         GDALDataType eDataTypeIn);
+};
+
+#endif
+
 /************************************************************************/
 /*                         ~JPEGXLDataset()                             */
 /************************************************************************/
@@ -210,6 +303,306 @@ CPLErr JPEGXLRasterBand::IReadBlock(int /*nBlockXOff*/, int nBlockYOff,
     return CE_None;
 }
 
+#ifdef HAVE_JxlDecoderSetProgressiveDetail
+
+/************************************************************************/
+/*                          GetOverviewCount()                          */
+/************************************************************************/
+
+int JPEGXLRasterBand::GetOverviewCount()
+{
+    // External overviews take precedence over the DC image
+    const int nExternalOverviews = GDALPamRasterBand::GetOverviewCount();
+    if (nExternalOverviews > 0)
+        return nExternalOverviews;
+
+    auto poGDS = cpl::down_cast<JPEGXLDataset *>(poDS);
+    return poGDS->GetDCOverview() ? 1 : 0;
+}
+
+/************************************************************************/
+/*                            GetOverview()                             */
+/************************************************************************/
+
+GDALRasterBand *JPEGXLRasterBand::GetOverview(int iOvr)
+{
+    if (GDALPamRasterBand::GetOverviewCount() > 0)
+        return GDALPamRasterBand::GetOverview(iOvr);
+
+    auto poGDS = cpl::down_cast<JPEGXLDataset *>(poDS);
+    auto poOvrDS = poGDS->GetDCOverview();
+    if (iOvr != 0 || poOvrDS == nullptr)
+        return nullptr;
+    return poOvrDS->GetRasterBand(nBand);
+}
+
+/************************************************************************/
+/*                           GetDCOverview()                            */
+/************************************************************************/
+
+JPEGXLDCOverviewDataset *JPEGXLDataset::GetDCOverview()
+{
+    if (!m_bHasDCOverview)
+        return nullptr;
+    if (!m_poDCOverviewDS)
+        m_poDCOverviewDS = std::make_unique<JPEGXLDCOverviewDataset>(this);
+    return m_poDCOverviewDS.get();
+}
+
+/************************************************************************/
+/*                      JPEGXLDCOverviewDataset()                       */
+/************************************************************************/
+
+JPEGXLDCOverviewDataset::JPEGXLDCOverviewDataset(JPEGXLDataset *poParentDS)
+    : m_poParentDS(poParentDS)
+{
+    nRasterXSize = DIV_ROUND_UP(poParentDS->GetRasterXSize(), 8);
+    nRasterYSize = DIV_ROUND_UP(poParentDS->GetRasterYSize(), 8);
+    const auto eDT = poParentDS->GetRasterBand(1)->GetRasterDataType();
+    for (int i = 1; i <= poParentDS->GetRasterCount(); ++i)
+        SetBand(i, new JPEGXLDCOverviewBand(this, i, eDT));
+}
+
+/************************************************************************/
+/*                         GetDecodedImage()                            */
+/************************************************************************/
+
+const std::vector<GByte> &JPEGXLDCOverviewDataset::GetDecodedImage()
+{
+    if (m_bDecodingFailed || !m_abyImage.empty())
+        return m_abyImage;
+
+    const auto eDT = GetRasterBand(1)->GetRasterDataType();
+    const auto nDataSize = GDALGetDataTypeSizeBytes(eDT);
+    const int nParentXSize = m_poParentDS->GetRasterXSize();
+    const int nParentYSize = m_poParentDS->GetRasterYSize();
+    const size_t nPixelSize = static_cast<size_t>(nBands) * nDataSize;
+    if (static_cast<size_t>(nParentXSize) >
+        std::numeric_limits<size_t>::max() / nParentYSize / nPixelSize)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Image too big for architecture");
+        m_bDecodingFailed = true;
+        return m_abyImage;
+    }
+
+    // libjxl flushes the DC image upsampled to the full resolution
+    std::vector<GByte> abyFullImage;
+    try
+    {
+        abyFullImage.resize(static_cast<size_t>(nParentXSize) * nParentYSize *
+                            nPixelSize);
+        m_abyImage.resize(static_cast<size_t>(nRasterXSize) * nRasterYSize *
+                          nPixelSize);
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate image buffer: %s", e.what());
+        m_abyImage.clear();
+        m_bDecodingFailed = true;
+        return m_abyImage;
+    }
+
+    // Use a dedicated decoder, so that the settings of the one of the
+    // parent dataset are not altered.
+    auto decoder = JxlDecoderMake(nullptr);
+    if (!decoder)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "JxlDecoderMake() failed");
+        m_abyImage.clear();
+        m_bDecodingFailed = true;
+        return m_abyImage;
+    }
+#ifdef HAVE_JXL_THREADS
+    if (JxlDecoderSetParallelRunner(decoder.get(), JxlResizableParallelRunner,
+                                    m_poParentDS->m_parallelRunner.get()) !=
+        JXL_DEC_SUCCESS)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "JxlDecoderSetParallelRunner() failed");
+        m_abyImage.clear();
+        m_bDecodingFailed = true;
+        return m_abyImage;
+    }
+#endif
+    if (JxlDecoderSubscribeEvents(decoder.get(), JXL_DEC_FRAME_PROGRESSION |
+                                                     JXL_DEC_FULL_IMAGE) !=
+            JXL_DEC_SUCCESS ||
+        JxlDecoderSetProgressiveDetail(decoder.get(), kDC) != JXL_DEC_SUCCESS)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "JxlDecoderSubscribeEvents() failed");
+        m_abyImage.clear();
+        m_bDecodingFailed = true;
+        return m_abyImage;
+    }
+
+    VSILFILE *fp = m_poParentDS->m_fp;
+    VSIFSeekL(fp, 0, SEEK_SET);
+    std::vector<GByte> abyInputData(m_poParentDS->m_abyInputData.size());
+    bool bGotImage = false;
+    while (!bGotImage && !m_bDecodingFailed)
+    {
+        const JxlDecoderStatus status = JxlDecoderProcessInput(decoder.get());
+        if (status == JXL_DEC_ERROR)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Decoding error");
+            m_bDecodingFailed = true;
+        }
+        else if (status == JXL_DEC_NEED_MORE_INPUT)
+        {
+            JxlDecoderReleaseInput(decoder.get());
+
+            const size_t nRead =
+                VSIFReadL(abyInputData.data(), 1, abyInputData.size(), fp);
+            if (nRead == 0)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Decoder expected more input, but no more available");
+                m_bDecodingFailed = true;
+            }
+            else if (JxlDecoderSetInput(decoder.get(), abyInputData.data(),
+                                        nRead) != JXL_DEC_SUCCESS)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "JxlDecoderSetInput() failed");
+                m_bDecodingFailed = true;
+            }
+        }
+        else if (status == JXL_DEC_NEED_IMAGE_OUT_BUFFER)
+        {
+            JxlPixelFormat format = {
+                static_cast<uint32_t>(nBands),
+                eDT == GDT_Byte     ? JXL_TYPE_UINT8
+                : eDT == GDT_UInt16 ? JXL_TYPE_UINT16
+                                    : JXL_TYPE_FLOAT,
+                JXL_NATIVE_ENDIAN, 0 /* alignment */
+            };
+
+            size_t buffer_size;
+            if (JxlDecoderImageOutBufferSize(decoder.get(), &format,
+                                             &buffer_size) != JXL_DEC_SUCCESS ||
+                buffer_size != abyFullImage.size() ||
+                JxlDecoderSetImageOutBuffer(decoder.get(), &format,
+                                            abyFullImage.data(),
+                                            abyFullImage.size()) !=
+                    JXL_DEC_SUCCESS)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "JxlDecoderSetImageOutBuffer failed()");
+                m_bDecodingFailed = true;
+            }
+        }
+        else if (status == JXL_DEC_FRAME_PROGRESSION)
+        {
+            // The rest of the frame (AC coefficients) is not needed.
+            if (JxlDecoderGetIntendedDownsamplingRatio(decoder.get()) <= 8 &&
+                JxlDecoderFlushImage(decoder.get()) == JXL_DEC_SUCCESS)
+            {
+                bGotImage = true;
+            }
+        }
+        else if (status == JXL_DEC_FULL_IMAGE)
+        {
+            // No progression event, for example for a frame without
+            // VarDCT encoding: downsample the full resolution image.
+            bGotImage = true;
+        }
+        else if (status == JXL_DEC_SUCCESS)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "End of codestream reached before getting an image");
+            m_bDecodingFailed = true;
+        }
+        else
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Unexpected decoder state: %d", status);
+        }
+    }
+    JxlDecoderReleaseInput(decoder.get());
+
+    if (m_bDecodingFailed)
+    {
+        m_abyImage.clear();
+        return m_abyImage;
+    }
+
+    // Pick the center pixel of each 8x8 cell of the upsampled DC image
+    GByte *pabyDst = m_abyImage.data();
+    for (int iY = 0; iY < nRasterYSize; ++iY)
+    {
+        const int iSrcY = std::min(iY * 8 + 4, nParentYSize - 1);
+        for (int iX = 0; iX < nRasterXSize; ++iX)
+        {
+            const int iSrcX = std::min(iX * 8 + 4, nParentXSize - 1);
+            memcpy(pabyDst,
+                   abyFullImage.data() +
+                       (static_cast<size_t>(iSrcY) * nParentXSize + iSrcX) *
+                           nPixelSize,
+                   nPixelSize);
+            pabyDst += nPixelSize;
+        }
+    }
+
+    if (m_poParentDS->m_nBits < GDALGetDataTypeSize(eDT))
+    {
+        RescaleToNBits(m_abyImage.data(),
+                       static_cast<size_t>(nRasterXSize) * nRasterYSize *
+                           nBands,
+                       eDT, m_poParentDS->m_nBits);
+    }
+
+    return m_abyImage;
+}
+
+/************************************************************************/
+/*                        JPEGXLDCOverviewBand()                        */
+/************************************************************************/
+
+JPEGXLDCOverviewBand::JPEGXLDCOverviewBand(JPEGXLDCOverviewDataset *poDSIn,
+                                           int nBandIn,
+                                           GDALDataType eDataTypeIn)
+{
+    poDS = poDSIn;
+    nBand = nBandIn;
+    eDataType = eDataTypeIn;
+    nRasterXSize = poDS->GetRasterXSize();
+    nRasterYSize = poDS->GetRasterYSize();
+    nBlockXSize = poDS->GetRasterXSize();
+    nBlockYSize = 1;
+}
+
+/************************************************************************/
+/*                             IReadBlock()                             */
+/************************************************************************/
+
+CPLErr JPEGXLDCOverviewBand::IReadBlock(int /*nBlockXOff*/, int nBlockYOff,
+                                        void *pData)
+{
+    auto poGDS = cpl::down_cast<JPEGXLDCOverviewDataset *>(poDS);
+
+    const auto &abyDecodedImage = poGDS->GetDecodedImage();
+    if (abyDecodedImage.empty())
+    {
+        return CE_Failure;
+    }
+
+    const auto nDataSize = GDALGetDataTypeSizeBytes(eDataType);
+    const int nBands = poGDS->GetRasterCount();
+    GDALCopyWords(abyDecodedImage.data() +
+                      ((nBand - 1) + static_cast<size_t>(nBlockYOff) *
+                                         nRasterXSize * nBands) *
+                          nDataSize,
+                  eDataType, nDataSize * nBands, pData, eDataType, nDataSize,
+                  nRasterXSize);
+
+    return CE_None;
+}
+
+#endif  // HAVE_JxlDecoderSetProgressiveDetail
+
 /************************************************************************/
 /*                         Identify()                                   */
 /************************************************************************/
@@ -907,6 +1300,15 @@ bool JPEGXLDataset::Open(GDALOpenInfo *poOpenInfo)
         SetMetadataItem("INTERLEAVE", "PIXEL", "IMAGE_STRUCTURE");
     }
 
+#ifdef HAVE_JxlDecoderSetProgressiveDetail
+    // Expose the DC image of lossy codestreams as an overview, when decoding
+    // the full resolution image is significantly more expensive.
+    m_bHasDCOverview =
+        !info.uses_original_profile && m_nNonAlphaExtraChannels == 0 &&
+        std::max(nRasterXSize, nRasterYSize) >= 512 &&
+        CPLTestBool(CPLGetConfigOption("GDAL_JPEGXL_DC_OVERVIEW", "YES"));
+#endif
+
     // Initialize any PAM information.
     SetDescription(poOpenInfo->pszFilename);
     TryLoadXML(poOpenInfo->GetSiblingFiles());
@@ -1498,37 +1900,14 @@ void JPEGXLDataset::GetDecodedImage(void *pabyOutputData,
     // Rescale from 8-bits/16-bits
     if (m_nBits < GDALGetDataTypeSize(eDT))
     {
-        const auto Rescale = [this, eDT](void *pBuffer, int nChannels)
-        {
-            const size_t nSamples =
-                static_cast<size_t>(nRasterXSize) * nRasterYSize * nChannels;
-            const int nMaxVal = (1 << m_nBits) - 1;
-            if (eDT == GDT_Byte)
-            {
-                const int nHalfMaxWidth = 127;
-                GByte *panData = static_cast<GByte *>(pBuffer);
-                for (size_t i = 0; i < nSamples; ++i)
-                {
-                    panData[i] = static_cast<GByte>(
-                        (panData[i] * nMaxVal + nHalfMaxWidth) / 255);
-                }
-            }
-            else if (eDT == GDT_UInt16)
-            {
-                const int nHalfMaxWidth = 32767;
-                uint16_t *panData = static_cast<uint16_t *>(pBuffer);
-                for (size_t i = 0; i < nSamples; ++i)
-                {
-                    panData[i] = static_cast<uint16_t>(
-                        (panData[i] * nMaxVal + nHalfMaxWidth) / 65535);
-                }
-            }
-        };
-
-        Rescale(pabyOutputData, nBands - m_nNonAlphaExtraChannels);
+        const size_t nPixels = static_cast<size_t>(nRasterXSize) * nRasterYSize;
+        RescaleToNBits(pabyOutputData,
+                       nPixels * (nBands - m_nNonAlphaExtraChannels), eDT,
+                       m_nBits);
         for (int i = 0; i < m_nNonAlphaExtraChannels; ++i)
         {
-            Rescale(m_abyExtraChannels[i].data(), 1);
+            RescaleToNBits(m_abyExtraChannels[i].data(), nPixels, eDT,
+                           m_nBits);
         }
     }
 }
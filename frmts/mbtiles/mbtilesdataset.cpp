@@ -1310,6 +1310,7 @@ bool MBTilesDataset::InitRaster(MBTilesDataset *poParentDS, int nZoomLevel,
         m_nQuality = poParentDS->m_nQuality;
         m_nZLevel = poParentDS->m_nZLevel;
         m_bDither = poParentDS->m_bDither;
+        m_nNumThreads = poParentDS->m_nNumThreads;
         m_osWHERE = poParentDS->m_osWHERE;
         SetDescription(CPLSPrintf("%s - zoom_level=%d",
                                   poParentDS->GetDescription(), m_nZoomLevel));
@@ -3490,6 +3491,8 @@ void MBTilesDataset::ParseCompressionOptions(char **papszOptions)
     const char *pszDither = CSLFetchNameValue(papszOptions, "DITHER");
     if (pszDither)
         m_bDither = CPLTestBool(pszDither);
+
+    SetNumThreads(CSLFetchNameValue(papszOptions, "NUM_THREADS"));
 }
 
 /************************************************************************/
@@ -3725,7 +3728,10 @@ void GDALRegister_MBTiles()
     "description='DEFLATE compression level for PNG tiles' default='6'/>"      \
     "  <Option name='DITHER' scope='raster' type='boolean' "                   \
     "description='Whether to apply Floyd-Steinberg dithering (for "            \
-    "TILE_FORMAT=PNG8)' default='NO'/>"
+    "TILE_FORMAT=PNG8)' default='NO'/>"                                        \
+    "  <Option name='NUM_THREADS' type='string' scope='raster' "               \
+    "description='Number of worker threads for tile encoding. "                \
+    "Can be set to ALL_CPUS' default='1'/>"
 
     poDriver->SetMetadataItem(
         GDAL_DMD_OPENOPTIONLIST,
@@ -44,15 +44,97 @@
 #include "cpl_minixml.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_virtualmem.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_frmts.h"
 
+/************************************************************************/
+/*                       Shared memory datasets                         */
+/*                                                                      */
+/*      With the SHARED_MEMORY_FILE creation option, the pixel buffer   */
+/*      is a memory mapping of a file (typically in /dev/shm), that     */
+/*      another process can open with                                  */
+/*      "MEM:::SHARED_MEMORY_FILE=filename" without copying the data.   */
+/*      The file starts with a header of MEM_SHM_HEADER_SIZE bytes      */
+/*      describing the dataset, followed by the pixel data.            */
+/************************************************************************/
+
+constexpr size_t MEM_SHM_HEADER_SIZE = 65536;
+constexpr const char *MEM_SHM_SIGNATURE = "GDAL_MEM_SHM_1";
+
+namespace
+{
+struct MEMSharedMemoryHeader
+{
+    char szSignature[16];
+    GInt32 nXSize;
+    GInt32 nYSize;
+    GInt32 nBands;
+    GInt32 nDataType;
+    GInt32 bPixelInterleaved;
+    GInt32 bGeoTransformSet;
+    double adfGeoTransform[6];
+    // Size of the WKT string, including its nul terminating byte,
+    // that immediately follows this structure.
+    GUInt32 nSRSSize;
+};
+}  // namespace
+
 struct MEMDataset::Private
 {
     std::shared_ptr<GDALGroup> m_poRootGroup{};
+
+    VSILFILE *m_fpSharedMemory = nullptr;
+    CPLVirtualMem *m_psSharedMemory = nullptr;
+
+    Private() = default;
+    Private(const Private &) = delete;
+    Private &operator=(const Private &) = delete;
+
+    ~Private()
+    {
+        if (m_psSharedMemory)
+            CPLVirtualMemFree(m_psSharedMemory);
+        if (m_fpSharedMemory)
+            VSIFCloseL(m_fpSharedMemory);
+    }
+
+    MEMSharedMemoryHeader *GetSharedMemoryHeader() const
+    {
+        return m_psSharedMemory && CPLVirtualMemGetAccessMode(
+                                       m_psSharedMemory) == VIRTUALMEM_READWRITE
+                   ? static_cast<MEMSharedMemoryHeader *>(
+                         CPLVirtualMemGetAddr(m_psSharedMemory))
+                   : nullptr;
+    }
 };
 
+/************************************************************************/
+/*                      MEMMapSharedMemoryFile()                        */
+/************************************************************************/
+
+static CPLVirtualMem *MEMMapSharedMemoryFile(VSILFILE *fp, size_t nSize,
+                                             bool bUpdate,
+                                             const char *pszFilename)
+{
+    if (!CPLIsVirtualMemFileMapAvailable())
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Memory mapping of files is not available on this platform");
+        return nullptr;
+    }
+    CPLVirtualMem *psVirtualMem = CPLVirtualMemFileMapNew(
+        fp, 0, nSize, bUpdate ? VIRTUALMEM_READWRITE : VIRTUALMEM_READONLY,
+        nullptr, nullptr);
+    if (!psVirtualMem)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot map %s in memory",
+                 pszFilename);
+    }
+    return psVirtualMem;
+}
+
 /************************************************************************/
 /*                        MEMCreateRasterBand()                         */
 /************************************************************************/
@@ -617,6 +699,33 @@ CPLErr MEMDataset::SetSpatialRef(const OGRSpatialReference *poSRS)
     if (poSRS)
         m_oSRS = *poSRS;
 
+    if (auto psHeader = m_poPrivate->GetSharedMemoryHeader())
+    {
+        std::string osWKT;
+        if (!m_oSRS.IsEmpty())
+        {
+            const char *const apszOptions[] = {"FORMAT=WKT2_2019", nullptr};
+            char *pszWKT = nullptr;
+            m_oSRS.exportToWkt(&pszWKT, apszOptions);
+            if (pszWKT)
+                osWKT = pszWKT;
+            CPLFree(pszWKT);
+        }
+        char *pszDest = reinterpret_cast<char *>(psHeader + 1);
+        if (osWKT.size() + 1 >
+            MEM_SHM_HEADER_SIZE - sizeof(MEMSharedMemoryHeader))
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "SRS too large to be stored in shared memory header");
+            psHeader->nSRSSize = 0;
+        }
+        else
+        {
+            memcpy(pszDest, osWKT.c_str(), osWKT.size() + 1);
+            psHeader->nSRSSize = static_cast<GUInt32>(osWKT.size() + 1);
+        }
+    }
+
     return CE_None;
 }
 
@@ -644,6 +753,13 @@ CPLErr MEMDataset::SetGeoTransform(double *padfGeoTransform)
     memcpy(adfGeoTransform, padfGeoTransform, sizeof(double) * 6);
     bGeoTransformSet = TRUE;
 
+    if (auto psHeader = m_poPrivate->GetSharedMemoryHeader())
+    {
+        memcpy(psHeader->adfGeoTransform, adfGeoTransform,
+               sizeof(adfGeoTransform));
+        psHeader->bGeoTransformSet = TRUE;
+    }
+
     return CE_None;
 }
 
@@ -1063,6 +1179,113 @@ CPLErr MEMDataset::CreateMaskBand(int nFlagsIn)
     return poFirstBand->CreateMaskBand(nFlagsIn | GMF_PER_DATASET);
 }
 
+/************************************************************************/
+/*                            CanBeCloned()                             */
+/************************************************************************/
+
+bool MEMDataset::CanBeCloned() const
+{
+    if (nBands == 0)
+        return false;
+    for (int i = 0; i < nBands; ++i)
+    {
+        if (dynamic_cast<MEMRasterBand *>(papoBands[i]) == nullptr)
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                               Clone()                                */
+/*                                                                      */
+/*      The clone is a read-only dataset referencing the pixel buffers  */
+/*      of this dataset, of its masks and overviews, which must thus    */
+/*      outlive it.                                                     */
+/************************************************************************/
+
+std::unique_ptr<GDALDataset> MEMDataset::Clone() const
+{
+    if (!CanBeCloned())
+        return nullptr;
+
+    auto poThis = const_cast<MEMDataset *>(this);
+    auto poCloneDS = std::make_unique<MEMDataset>();
+    poCloneDS->nRasterXSize = nRasterXSize;
+    poCloneDS->nRasterYSize = nRasterYSize;
+    poCloneDS->eAccess = GA_ReadOnly;
+    poCloneDS->SetDescription(GetDescription());
+    poCloneDS->bGeoTransformSet = bGeoTransformSet;
+    memcpy(poCloneDS->adfGeoTransform, adfGeoTransform,
+           sizeof(adfGeoTransform));
+    poCloneDS->m_oSRS = m_oSRS;
+    if (m_nGCPCount > 0)
+        poCloneDS->SetGCPs(m_nGCPCount, m_pasGCPs, &m_oGCPSRS);
+    char **papszDomains = poThis->oMDMD.GetDomainList();
+    for (int i = 0; papszDomains && papszDomains[i]; ++i)
+    {
+        poCloneDS->oMDMD.SetMetadata(
+            poThis->oMDMD.GetMetadata(papszDomains[i]), papszDomains[i]);
+    }
+
+    for (int i = 0; i < nBands; ++i)
+    {
+        auto poSrcBand = cpl::down_cast<MEMRasterBand *>(papoBands[i]);
+        auto poBand = new MEMRasterBand(
+            poCloneDS.get(), i + 1, poSrcBand->pabyData,
+            poSrcBand->GetRasterDataType(), poSrcBand->nPixelOffset,
+            poSrcBand->nLineOffset, FALSE);
+        poCloneDS->SetBand(i + 1, poBand);
+        poBand->CloneInfo(poSrcBand, GCIF_NODATA | GCIF_CATEGORYNAMES |
+                                         GCIF_SCALEOFFSET | GCIF_UNITTYPE |
+                                         GCIF_COLORTABLE | GCIF_COLORINTERP |
+                                         GCIF_BAND_METADATA | GCIF_RAT |
+                                         GCIF_BAND_DESCRIPTION);
+
+        // Share the mask buffer, and the per-dataset mask between bands.
+        if (poSrcBand->poMask && poSrcBand->bOwnMask)
+        {
+            auto poSrcMask = dynamic_cast<MEMRasterBand *>(poSrcBand->poMask);
+            if (poSrcMask && poSrcMask->m_bIsMask)
+            {
+                auto poMask = new MEMRasterBand(
+                    poSrcMask->pabyData, GDT_Byte, nRasterXSize, nRasterYSize);
+                poMask->bOwnData = false;
+                poMask->m_bIsMask = true;
+                poMask->eAccess = GA_ReadOnly;
+                poBand->poMask = poMask;
+                poBand->bOwnMask = true;
+                poBand->nMaskFlags = poSrcBand->nMaskFlags;
+            }
+        }
+        else if (i > 0 && poSrcBand->poMask &&
+                 poSrcBand->poMask ==
+                     cpl::down_cast<MEMRasterBand *>(papoBands[0])->poMask)
+        {
+            auto poFirstBand =
+                cpl::down_cast<MEMRasterBand *>(poCloneDS->papoBands[0]);
+            poBand->poMask = poFirstBand->poMask;
+            poBand->bOwnMask = false;
+            poBand->nMaskFlags = poSrcBand->nMaskFlags;
+        }
+    }
+
+    for (int i = 0; i < m_nOverviewDSCount; ++i)
+    {
+        auto poSrcOvrDS = dynamic_cast<MEMDataset *>(m_papoOverviewDS[i]);
+        auto poOvrDS = poSrcOvrDS ? poSrcOvrDS->Clone() : nullptr;
+        if (!poOvrDS)
+            return nullptr;
+        poCloneDS->m_papoOverviewDS =
+            static_cast<GDALDataset **>(CPLRealloc(
+                poCloneDS->m_papoOverviewDS,
+                sizeof(GDALDataset *) * (poCloneDS->m_nOverviewDSCount + 1)));
+        poCloneDS->m_papoOverviewDS[poCloneDS->m_nOverviewDSCount++] =
+            poOvrDS.release();
+    }
+
+    return poCloneDS;
+}
+
 /************************************************************************/
 /*                                Open()                                */
 /************************************************************************/
@@ -1081,6 +1304,15 @@ GDALDataset *MEMDataset::Open(GDALOpenInfo *poOpenInfo)
     char **papszOptions =
         CSLTokenizeStringComplex(poOpenInfo->pszFilename + 6, ",", TRUE, FALSE);
 
+    if (const char *pszSharedMemoryFile =
+            CSLFetchNameValue(papszOptions, "SHARED_MEMORY_FILE"))
+    {
+        GDALDataset *poDS =
+            OpenSharedMemory(pszSharedMemoryFile, poOpenInfo->eAccess);
+        CSLDestroy(papszOptions);
+        return poDS;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Verify we have all required fields                              */
     /* -------------------------------------------------------------------- */
@@ -1234,6 +1466,123 @@ GDALDataset *MEMDataset::Open(GDALOpenInfo *poOpenInfo)
     return poDS;
 }
 
+/************************************************************************/
+/*                         OpenSharedMemory()                           */
+/************************************************************************/
+
+GDALDataset *MEMDataset::OpenSharedMemory(const char *pszSharedMemoryFile,
+                                          GDALAccess eAccess)
+{
+    VSILFILE *fp =
+        VSIFOpenL(pszSharedMemoryFile, eAccess == GA_Update ? "rb+" : "rb");
+    if (!fp)
+    {
+        CPLError(CE_Failure, CPLE_OpenFailed, "Cannot open %s",
+                 pszSharedMemoryFile);
+        return nullptr;
+    }
+
+    MEMSharedMemoryHeader sHeader;
+    if (VSIFReadL(&sHeader, sizeof(sHeader), 1, fp) != 1 ||
+        memcmp(sHeader.szSignature, MEM_SHM_SIGNATURE,
+               strlen(MEM_SHM_SIGNATURE) + 1) != 0)
+    {
+        CPLError(CE_Failure, CPLE_OpenFailed,
+                 "%s is not a MEM shared memory file", pszSharedMemoryFile);
+        VSIFCloseL(fp);
+        return nullptr;
+    }
+
+    const GDALDataType eType = static_cast<GDALDataType>(sHeader.nDataType);
+    if (!GDALCheckDatasetDimensions(sHeader.nXSize, sHeader.nYSize) ||
+        !GDALCheckBandCount(sHeader.nBands, FALSE) ||
+        sHeader.nDataType <= GDT_Unknown || sHeader.nDataType >= GDT_TypeCount)
+    {
+        VSIFCloseL(fp);
+        return nullptr;
+    }
+
+    const int nWordSize = GDALGetDataTypeSizeBytes(eType);
+    const GUIntBig nDataSize = static_cast<GUIntBig>(nWordSize) *
+                               sHeader.nBands * sHeader.nXSize *
+                               sHeader.nYSize;
+    VSIFSeekL(fp, 0, SEEK_END);
+    const GUIntBig nFileSize = VSIFTellL(fp);
+    if (nFileSize < MEM_SHM_HEADER_SIZE + nDataSize ||
+        MEM_SHM_HEADER_SIZE + nDataSize >
+            static_cast<GUIntBig>(std::numeric_limits<size_t>::max()))
+    {
+        CPLError(CE_Failure, CPLE_OpenFailed, "%s is truncated",
+                 pszSharedMemoryFile);
+        VSIFCloseL(fp);
+        return nullptr;
+    }
+
+    CPLVirtualMem *psVirtualMem = MEMMapSharedMemoryFile(
+        fp, static_cast<size_t>(MEM_SHM_HEADER_SIZE + nDataSize),
+        eAccess == GA_Update, pszSharedMemoryFile);
+    if (!psVirtualMem)
+    {
+        VSIFCloseL(fp);
+        return nullptr;
+    }
+
+    auto poDS = std::make_unique<MEMDataset>();
+    poDS->m_poPrivate->m_fpSharedMemory = fp;
+    poDS->m_poPrivate->m_psSharedMemory = psVirtualMem;
+    poDS->nRasterXSize = sHeader.nXSize;
+    poDS->nRasterYSize = sHeader.nYSize;
+    poDS->eAccess = eAccess;
+
+    GByte *pabyData =
+        static_cast<GByte *>(CPLVirtualMemGetAddr(psVirtualMem)) +
+        MEM_SHM_HEADER_SIZE;
+    const size_t nBandSize =
+        static_cast<size_t>(nWordSize) * sHeader.nXSize * sHeader.nYSize;
+    for (int iBand = 0; iBand < sHeader.nBands; iBand++)
+    {
+        if (sHeader.bPixelInterleaved)
+        {
+            poDS->SetBand(iBand + 1,
+                          new MEMRasterBand(poDS.get(), iBand + 1,
+                                            pabyData + iBand * nWordSize, eType,
+                                            nWordSize * sHeader.nBands, 0,
+                                            FALSE));
+        }
+        else
+        {
+            poDS->SetBand(iBand + 1, new MEMRasterBand(poDS.get(), iBand + 1,
+                                                       pabyData +
+                                                           iBand * nBandSize,
+                                                       eType, 0, 0, FALSE));
+        }
+    }
+    if (sHeader.bPixelInterleaved)
+        poDS->SetMetadataItem("INTERLEAVE", "PIXEL", "IMAGE_STRUCTURE");
+
+    if (sHeader.bGeoTransformSet)
+    {
+        memcpy(poDS->adfGeoTransform, sHeader.adfGeoTransform,
+               sizeof(poDS->adfGeoTransform));
+        poDS->bGeoTransformSet = TRUE;
+    }
+
+    const char *pszWKT =
+        reinterpret_cast<const char *>(
+            static_cast<const GByte *>(CPLVirtualMemGetAddr(psVirtualMem))) +
+        sizeof(MEMSharedMemoryHeader);
+    if (sHeader.nSRSSize > 1 &&
+        sHeader.nSRSSize <=
+            MEM_SHM_HEADER_SIZE - sizeof(MEMSharedMemoryHeader) &&
+        pszWKT[sHeader.nSRSSize - 1] == '\0')
+    {
+        poDS->m_oSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+        poDS->m_oSRS.importFromWkt(pszWKT);
+    }
+
+    return poDS.release();
+}
+
 /************************************************************************/
 /*                               Create()                               */
 /************************************************************************/
@@ -1254,6 +1603,9 @@ MEMDataset *MEMDataset::Create(const char * /* pszFilename */, int nXSize,
     if (pszOption && EQUAL(pszOption, "PIXEL"))
         bPixelInterleaved = true;
 
+    const char *pszSharedMemoryFile =
+        CSLFetchNameValue(papszOptions, "SHARED_MEMORY_FILE");
+
     /* -------------------------------------------------------------------- */
     /*      First allocate band data, verifying that we can get enough      */
     /*      memory.                                                         */
@@ -1280,11 +1632,54 @@ MEMDataset *MEMDataset::Create(const char * /* pszFilename */, int nXSize,
     }
 #endif
 
+    VSILFILE *fpSharedMemory = nullptr;
+    CPLVirtualMem *psSharedMemory = nullptr;
+    if (pszSharedMemoryFile)
+    {
+        if (nGlobalSize > std::numeric_limits<size_t>::max() -
+                              MEM_SHM_HEADER_SIZE)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory, "Too large dataset");
+            return nullptr;
+        }
+        fpSharedMemory = VSIFOpenL(pszSharedMemoryFile, "wb+");
+        if (!fpSharedMemory)
+        {
+            CPLError(CE_Failure, CPLE_OpenFailed, "Cannot create %s",
+                     pszSharedMemoryFile);
+            return nullptr;
+        }
+        // Zero-filled
+        if (VSIFTruncateL(fpSharedMemory, MEM_SHM_HEADER_SIZE + nGlobalSize) !=
+                0 ||
+            (psSharedMemory = MEMMapSharedMemoryFile(
+                 fpSharedMemory, MEM_SHM_HEADER_SIZE + nGlobalSize, true,
+                 pszSharedMemoryFile)) == nullptr)
+        {
+            VSIFCloseL(fpSharedMemory);
+            VSIUnlink(pszSharedMemoryFile);
+            return nullptr;
+        }
+
+        auto psHeader = static_cast<MEMSharedMemoryHeader *>(
+            CPLVirtualMemGetAddr(psSharedMemory));
+        memcpy(psHeader->szSignature, MEM_SHM_SIGNATURE,
+               strlen(MEM_SHM_SIGNATURE) + 1);
+        psHeader->nXSize = nXSize;
+        psHeader->nYSize = nYSize;
+        psHeader->nBands = nBandsIn;
+        psHeader->nDataType = static_cast<GInt32>(eType);
+        psHeader->bPixelInterleaved = bPixelInterleaved;
+    }
+
     std::vector<GByte *> apbyBandData;
     if (nBandsIn > 0)
     {
         GByte *pabyData =
-            static_cast<GByte *>(VSI_CALLOC_VERBOSE(1, nGlobalSize));
+            psSharedMemory
+                ? static_cast<GByte *>(CPLVirtualMemGetAddr(psSharedMemory)) +
+                      MEM_SHM_HEADER_SIZE
+                : static_cast<GByte *>(VSI_CALLOC_VERBOSE(1, nGlobalSize));
         if (!pabyData)
         {
             return nullptr;
@@ -1316,6 +1711,9 @@ MEMDataset *MEMDataset::Create(const char * /* pszFilename */, int nXSize,
     poDS->nRasterXSize = nXSize;
     poDS->nRasterYSize = nYSize;
     poDS->eAccess = GA_Update;
+    poDS->m_poPrivate->m_fpSharedMemory = fpSharedMemory;
+    poDS->m_poPrivate->m_psSharedMemory = psSharedMemory;
+    const bool bOwnData = psSharedMemory == nullptr;
 
     const char *pszPixelType = CSLFetchNameValue(papszOptions, "PIXELTYPE");
     if (pszPixelType && EQUAL(pszPixelType, "SIGNEDBYTE"))
@@ -1332,12 +1730,12 @@ MEMDataset *MEMDataset::Create(const char * /* pszFilename */, int nXSize,
         MEMRasterBand *poNewBand = nullptr;
 
         if (bPixelInterleaved)
-            poNewBand =
-                new MEMRasterBand(poDS, iBand + 1, apbyBandData[iBand], eType,
-                                  nWordSize * nBandsIn, 0, iBand == 0);
+            poNewBand = new MEMRasterBand(poDS, iBand + 1, apbyBandData[iBand],
+                                          eType, nWordSize * nBandsIn, 0,
+                                          bOwnData && iBand == 0);
         else
             poNewBand = new MEMRasterBand(poDS, iBand + 1, apbyBandData[iBand],
-                                          eType, 0, 0, iBand == 0);
+                                          eType, 0, 0, bOwnData && iBand == 0);
 
         poDS->SetBand(iBand + 1, poNewBand);
     }
@@ -3162,6 +3560,9 @@ void GDALRegister_MEM()
         "       <Value>BAND</Value>"
         "       <Value>PIXEL</Value>"
         "   </Option>"
+        "   <Option name='SHARED_MEMORY_FILE' type='string' "
+        "description='Filename (typically in /dev/shm) whose memory mapping "
+        "holds the pixel buffer, to share it with other processes'/>"
         "</CreationOptionList>");
 
     // Define GDAL_NO_OPEN_FOR_MEM_DRIVER macro to undefine Open() method for
@@ -86,6 +86,9 @@ class CPL_DLL MEMDataset CPL_NON_FINAL : public GDALDataset
                                    int nYSize, int nBands, GDALDataType eType,
                                    char **papszParamList);
 
+    static GDALDataset *OpenSharedMemory(const char *pszSharedMemoryFile,
+                                         GDALAccess eAccess);
+
   public:
     MEMDataset();
     virtual ~MEMDataset();
@@ -121,6 +124,9 @@ class CPL_DLL MEMDataset CPL_NON_FINAL : public GDALDataset
 
     virtual CPLErr CreateMaskBand(int nFlagsIn) override;
 
+    bool CanBeCloned() const override;
+    std::unique_ptr<GDALDataset> Clone() const override;
+
     std::shared_ptr<GDALGroup> GetRootGroup() const override;
 
     void AddMEMBand(GDALRasterBandH hMEMBand);
@@ -315,6 +315,11 @@ class CPL_DLL MEMMDArray CPL_NON_FINAL : public MEMAbstractMDArray,
         return m_bWritable;
     }
 
+    bool IsReadThreadSafe() const override
+    {
+        return true;
+    }
+
     const std::string &GetFilename() const override
     {
         return m_osFilename;
@@ -61,8 +61,13 @@
 #include "gdal_pam.h"
 #include "ogr_srs_api.h"
 #include "ogr_spatialref.h"
+#include "cpl_error_internal.h"
+#include "cpl_worker_thread_pool.h"
 
 #include <limits>
+#include <map>
+#include <memory>
+#include <vector>
 // For printing values
 #include <ostream>
 #include <iostream>
@@ -353,6 +358,25 @@ enum
 MRFRasterBand *newMRFRasterBand(MRFDataset *, const ILImage &, int,
                                 int level = 0);
 
+// A separate band page, encoded by a worker thread when NUM_THREADS is set
+// The encoded pages are written in submission order, by FlushEncodeJobs()
+struct MRFEncodeJob
+{
+    MRFRasterBand *band = nullptr;
+    GUIntBig infooffset = 0;
+    // NoData value, for detecting empty pages
+    double ndv = 0.0;
+    // The raw page, followed by space for the encoded one
+    std::vector<char> buffer{};
+    // The encoded page, within buffer, nullptr on error
+    void *usebuff = nullptr;
+    size_t size = 0;
+    // Page is all nodata, nothing to encode
+    bool empty = false;
+    std::chrono::nanoseconds timer{};
+    std::vector<CPLErrorHandlerAccumulatorStruct> errors{};
+};
+
 class MRFDataset final : public GDALPamDataset
 {
     friend class MRFRasterBand;
@@ -447,6 +471,8 @@ class MRFDataset final : public GDALPamDataset
         return pbsize;
     }
 
+    virtual CPLErr FlushCache(bool bAtClosing) override;
+
   protected:
     // False if it failed
     int Crystalize();
@@ -506,6 +532,18 @@ class MRFDataset final : public GDALPamDataset
     // For versioned MRFs, add a version
     CPLErr AddVersion();
 
+    // Parse NUM_THREADS, defaulting to GDAL_NUM_THREADS
+    void SetNumThreads(const char *pszValue);
+
+    // Queue a page for encoding, or encode it if there are no worker threads
+    CPLErr SubmitEncodeJob(std::unique_ptr<MRFEncodeJob> job);
+
+    // Wait for the queued pages and write them
+    CPLErr FlushEncodeJobs();
+
+    // Write the buffered index records
+    CPLErr FlushIdx();
+
     // Read the index record itself
     CPLErr ReadTileIdx(ILIdx &tinfo, const ILSize &pos, const ILImage &img,
                        const GIntBig bias = 0);
@@ -618,6 +656,14 @@ class MRFDataset final : public GDALPamDataset
 #endif
     // Time duration spend for decompression and compression
     std::chrono::nanoseconds read_timer, write_timer;
+
+    // Worker threads used to encode and decode pages
+    int m_nNumThreads = 1;
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+    std::vector<std::unique_ptr<MRFEncodeJob>> m_apoEncodeJobs{};
+
+    // Index records not yet written, by offset in the index file
+    std::map<GUIntBig, ILIdx> m_oPendingIdx{};
 };
 
 class MRFRasterBand CPL_NON_FINAL : public GDALPamRasterBand
@@ -629,6 +675,9 @@ class MRFRasterBand CPL_NON_FINAL : public GDALPamRasterBand
     virtual ~MRFRasterBand();
     virtual CPLErr IReadBlock(int xblk, int yblk, void *buffer) override;
     virtual CPLErr IWriteBlock(int xblk, int yblk, void *buffer) override;
+    virtual CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
+                             GDALDataType, GSpacing, GSpacing,
+                             GDALRasterIOExtraArg *) override;
 
     // Check that the respective block has data, without reading it
     virtual bool TestBlock(int xblk, int yblk);
@@ -732,6 +781,24 @@ class MRFRasterBand CPL_NON_FINAL : public GDALPamRasterBand
     virtual CPLErr Compress(buf_mgr &dst, buf_mgr &src) = 0;
     virtual CPLErr Decompress(buf_mgr &dst, buf_mgr &src) = 0;
 
+    // True if Compress and Decompress can be called from multiple threads
+    virtual bool IsCodecReentrant() const
+    {
+        return false;
+    }
+
+    // Decode a page read from the data file, including the deflate or zstd
+    // stage. Takes ownership of src.buffer. zctx is a ZSTD_DCtx
+    CPLErr DecodePage(buf_mgr &src, buf_mgr &dst, void *zctx);
+    // Encode a separate band page, including the deflate or zstd stage.
+    // Returns the encoded page, within dst, or nullptr. zctx is a ZSTD_CCtx
+    void *EncodePage(buf_mgr &src, buf_mgr &dst, void *zctx);
+
+    // Decode concurrently the blocks of a read request
+    void PrefetchBlocks(int nXOff, int nYOff, int nXSize, int nYSize);
+    static void DecodeJobFunc(void *pData);
+    static void EncodeJobFunc(void *pData);
+
     // Read the index record itself, can be overwritten
     //    virtual CPLErr ReadTileIdx(const ILSize &, ILIdx &, GIntBig bias = 0);
 
@@ -909,6 +976,10 @@ class Raw_Band final : public MRFRasterBand
     {
         return Decompress(dst, src);
     }
+    virtual bool IsCodecReentrant() const override
+    {
+        return true;
+    }
 };
 
 class TIF_Band final : public MRFRasterBand
@@ -939,6 +1010,10 @@ class LERC_Band final : public MRFRasterBand
   protected:
     virtual CPLErr Decompress(buf_mgr &dst, buf_mgr &src) override;
     virtual CPLErr Compress(buf_mgr &dst, buf_mgr &src) override;
+    virtual bool IsCodecReentrant() const override
+    {
+        return true;
+    }
     double precision;
     // L1 or L2
     int version;
@@ -975,6 +1050,10 @@ class QB3_Band final : public MRFRasterBand
   protected:
     virtual CPLErr Decompress(buf_mgr &dst, buf_mgr &src) override;
     virtual CPLErr Compress(buf_mgr &dst, buf_mgr &src) override;
+    virtual bool IsCodecReentrant() const override
+    {
+        return true;
+    }
 };
 #endif
 
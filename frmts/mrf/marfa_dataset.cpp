@@ -62,6 +62,7 @@
 #include "mrfdrivercore.h"
 #include "cpl_multiproc.h" /* for CPLSleep() */
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include <assert.h>
 
 #include <algorithm>
@@ -2082,6 +2083,7 @@ void MRFDataset::ProcessOpenOptions(char **papszOptions)
     const char *val = opt.FetchNameValue("ZSLICE");
     if (val)
         zslice = atoi(val);
+    SetNumThreads(opt.FetchNameValue("NUM_THREADS"));
 }
 
 // Apply create options to the current dataset, only valid during creation
@@ -2121,6 +2123,8 @@ void MRFDataset::ProcessCreateOptions(char **papszOptions)
 
     img.nbo = opt.FetchBoolean("NETBYTEORDER", FALSE) != FALSE;
 
+    SetNumThreads(opt.FetchNameValue("NUM_THREADS"));
+
     val = opt.FetchNameValue("CACHEDSOURCE");
     if (val)
     {
@@ -2312,6 +2316,137 @@ int MRFDataset::Crystalize()
     return TRUE;
 }
 
+// Pick the number of worker threads used to encode and decode pages
+void MRFDataset::SetNumThreads(const char *pszValue)
+{
+    if (pszValue == nullptr)
+        pszValue = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszValue == nullptr)
+        return;
+    int nThreads =
+        EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue);
+    if (nThreads > 1024)
+        nThreads = 1024;  // to please Coverity
+    if (nThreads < 0 || (nThreads <= 1 && !EQUAL(pszValue, "0") &&
+                         !EQUAL(pszValue, "1") && !EQUAL(pszValue, "ALL_CPUS")))
+    {
+        CPLError(CE_Warning, CPLE_AppDefined,
+                 "Invalid value for NUM_THREADS: %s", pszValue);
+        return;
+    }
+    m_nNumThreads = std::max(1, nThreads);
+}
+
+//
+// Queue a separate band page for encoding by a worker thread
+// The pages are written by FlushEncodeJobs(), in the order they were queued,
+// so the data file layout doesn't depend on the number of threads
+//
+CPLErr MRFDataset::SubmitEncodeJob(std::unique_ptr<MRFEncodeJob> job)
+{
+    if (!m_poJobQueue)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(m_nNumThreads);
+        if (poThreadPool)
+            m_poJobQueue = poThreadPool->CreateJobQueue();
+    }
+
+    MRFEncodeJob *poJob = job.get();
+    m_apoEncodeJobs.push_back(std::move(job));
+    if (!m_poJobQueue ||
+        !m_poJobQueue->SubmitJob(MRFRasterBand::EncodeJobFunc, poJob))
+        MRFRasterBand::EncodeJobFunc(poJob);
+
+    // Bound the memory used by the pending pages
+    if (m_apoEncodeJobs.size() >= static_cast<size_t>(4 * m_nNumThreads))
+        return FlushEncodeJobs();
+    return CE_None;
+}
+
+CPLErr MRFDataset::FlushEncodeJobs()
+{
+    if (m_apoEncodeJobs.empty())
+        return CE_None;
+
+    // WriteTile() calls this function, take the jobs out first
+    auto apoJobs = std::move(m_apoEncodeJobs);
+    m_apoEncodeJobs.clear();
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+
+    CPLErr ret = CE_None;
+    for (const auto &job : apoJobs)
+    {
+        for (const auto &oError : job->errors)
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        write_timer += job->timer;
+
+        CPLErr err = CE_Failure;
+        if (job->empty)
+            err = WriteTile(nullptr, job->infooffset, 0);
+        else if (job->usebuff)
+            err = WriteTile(job->usebuff, job->infooffset, job->size);
+        if (err != CE_None)
+            ret = err;
+    }
+    return ret;
+}
+
+//
+// Write the index records buffered by WriteTile(), in offset order, merging
+// the contiguous ones in a single write
+//
+CPLErr MRFDataset::FlushIdx()
+{
+    if (m_oPendingIdx.empty())
+        return CE_None;
+
+    VSILFILE *l_ifp = IdxFP();
+    if (l_ifp == nullptr)
+    {
+        m_oPendingIdx.clear();
+        return CE_Failure;
+    }
+
+    CPLErr ret = CE_None;
+    std::vector<ILIdx> run;
+    GUIntBig runoffset = 0;
+    auto write_run = [&]()
+    {
+        VSIFSeekL(l_ifp, runoffset, SEEK_SET);
+        if (run.size() != VSIFWriteL(run.data(), sizeof(ILIdx), run.size(),
+                                     l_ifp))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "MRF: Index write failed");
+            ret = CE_Failure;
+        }
+        run.clear();
+    };
+
+    for (const auto &kv : m_oPendingIdx)
+    {
+        if (!run.empty() && kv.first != runoffset + run.size() * sizeof(ILIdx))
+            write_run();
+        if (run.empty())
+            runoffset = kv.first;
+        run.push_back(kv.second);
+    }
+    write_run();
+
+    m_oPendingIdx.clear();
+    return ret;
+}
+
+CPLErr MRFDataset::FlushCache(bool bAtClosing)
+{
+    CPLErr eErr = GDALPamDataset::FlushCache(bAtClosing);
+    if (FlushEncodeJobs() != CE_None)
+        eErr = CE_Failure;
+    if (FlushIdx() != CE_None)
+        eErr = CE_Failure;
+    return eErr;
+}
+
 // Copy the first index at the end of the file and bump the version count
 CPLErr MRFDataset::AddVersion()
 {
@@ -2338,7 +2473,11 @@ CPLErr MRFDataset::AddVersion()
 //
 CPLErr MRFDataset::WriteTile(void *buff, GUIntBig infooffset, GUIntBig size)
 {
-    CPLErr ret = CE_None;
+    // Keep the tiles in the order they were written
+    CPLErr ret = FlushEncodeJobs();
+    if (CE_None != ret)
+        return ret;
+
     ILIdx tinfo = {0, 0};
 
     VSILFILE *l_dfp = DataFP();
@@ -2463,8 +2602,14 @@ CPLErr MRFDataset::WriteTile(void *buff, GUIntBig infooffset, GUIntBig size)
     // Do nothing if the tile is empty and the file record is also empty
     if (!new_tile && 0 == size && nullptr == buff)
     {
-        VSIFSeekL(l_ifp, infooffset, SEEK_SET);
-        VSIFReadL(&tinfo, 1, sizeof(ILIdx), l_ifp);
+        auto oIter = m_oPendingIdx.find(infooffset);
+        if (oIter != m_oPendingIdx.end())
+            tinfo = oIter->second;
+        else
+        {
+            VSIFSeekL(l_ifp, infooffset, SEEK_SET);
+            VSIFReadL(&tinfo, 1, sizeof(ILIdx), l_ifp);
+        }
         if (0 == tinfo.offset && 0 == tinfo.size)
             return ret;
     }
@@ -2473,6 +2618,16 @@ CPLErr MRFDataset::WriteTile(void *buff, GUIntBig infooffset, GUIntBig size)
     if (nullptr != buff && 0 == size)
         tinfo.offset = ~GUIntBig(0);
 
+    // Batch the index updates, unless other processes or versions need them
+    if (!mp_safe && !hasVersions && source.empty())
+    {
+        m_oPendingIdx[infooffset] = tinfo;
+        // Up to 1MB of index records
+        if (m_oPendingIdx.size() >= 65536)
+            return FlushIdx();
+        return ret;
+    }
+
     VSIFSeekL(l_ifp, infooffset, SEEK_SET);
     if (sizeof(tinfo) != VSIFWriteL(&tinfo, 1, sizeof(tinfo), l_ifp))
     {
@@ -2527,6 +2682,10 @@ CPLErr MRFDataset::GetGeoTransform(double *gt)
 CPLErr MRFDataset::ReadTileIdx(ILIdx &tinfo, const ILSize &pos,
                                const ILImage &img, const GIntBig bias)
 {
+    // Pages being encoded are not in the index yet
+    if (CE_None != FlushEncodeJobs())
+        return CE_Failure;
+
     VSILFILE *l_ifp = IdxFP();
 
     // Initialize the tinfo structure, in case the files are missing
@@ -2559,6 +2718,15 @@ CPLErr MRFDataset::ReadTileIdx(ILIdx &tinfo, const ILSize &pos,
         return CE_Failure;
     }
 
+    // Might be a record not yet written
+    auto oIter = m_oPendingIdx.find(static_cast<GUIntBig>(offset));
+    if (oIter != m_oPendingIdx.end())
+    {
+        tinfo.offset = net64(oIter->second.offset);
+        tinfo.size = net64(oIter->second.size);
+        return CE_None;
+    }
+
     VSIFSeekL(l_ifp, offset, SEEK_SET);
     if (1 != VSIFReadL(&tinfo, sizeof(ILIdx), 1, l_ifp))
         return CE_Failure;
@@ -56,7 +56,9 @@
 #include "gdal_priv.h"
 #include "ogr_srs_api.h"
 #include "ogr_spatialref.h"
+#include "gdal_thread_pool.h"
 
+#include <algorithm>
 #include <vector>
 #include <cassert>
 #include <zlib.h>
@@ -961,6 +963,406 @@ CPLErr MRFRasterBand::FetchClonedBlock(int xblk, int yblk, void *buffer)
     return IReadBlock(xblk, yblk, buffer);
 }
 
+/**
+ *\brief Decode a page read from the data file
+ *
+ * Undoes the deflate or zstd stage, if any, then decompresses the page in dst,
+ * which holds pageSizeBytes. Takes ownership of src.buffer, which is padded.
+ * It doesn't use the dataset page buffer, so for reentrant codecs it can be
+ * called from worker threads, each with its own zstd context
+ *
+ */
+
+CPLErr MRFRasterBand::DecodePage(buf_mgr &src, buf_mgr &dst, void *zctx)
+{
+    // Freed by this function, even on error
+    buf_mgr packed = src;
+    src.buffer = nullptr;
+    src.size = 0;
+    char *data = packed.buffer;
+    size_t size = packed.size;
+
+    // We got the data, do we need to decompress it before decoding?
+    if (dodeflate)
+    {
+        if (img.pageSizeBytes > INT_MAX - 1440)
+        {
+            CPLFree(data);
+            CPLError(CE_Failure, CPLE_AppDefined, "Page size is too big at %d",
+                     img.pageSizeBytes);
+            return CE_Failure;
+        }
+        buf_mgr unpacked;
+        unpacked.size =
+            img.pageSizeBytes +
+            1440;  // in case the packed page is a bit larger than the raw one
+        unpacked.buffer = static_cast<char *>(VSIMalloc(unpacked.size));
+        if (nullptr == unpacked.buffer)
+        {
+            CPLFree(data);
+            CPLError(CE_Failure, CPLE_OutOfMemory, "Cannot allocate %d bytes",
+                     static_cast<int>(unpacked.size));
+            return CE_Failure;
+        }
+
+        if (ZUnPack(packed, unpacked, deflate_flags))
+        {  // Got it unpacked, update the pointers
+            CPLFree(data);
+            data = unpacked.buffer;
+            size = unpacked.size;
+        }
+        else
+        {  // assume the page was not gzipped, warn only
+            CPLFree(unpacked.buffer);
+            if (!poMRFDS->no_errors)
+                CPLError(CE_Warning, CPLE_AppDefined, "Can't inflate page!");
+        }
+    }
+
+#if defined(ZSTD_SUPPORT)
+    // undo ZSTD
+    else if (dozstd)
+    {
+        auto ctx = static_cast<ZSTD_DCtx *>(zctx);
+        if (!ctx)
+        {
+            CPLFree(data);
+            CPLError(CE_Failure, CPLE_AppDefined, "Can't acquire ZSTD context");
+            return CE_Failure;
+        }
+        if (img.pageSizeBytes > INT_MAX - 1440)
+        {
+            CPLFree(data);
+            CPLError(CE_Failure, CPLE_AppDefined, "Page is too large at %d",
+                     img.pageSizeBytes);
+            return CE_Failure;
+        }
+        buf_mgr unpacked;
+        unpacked.size =
+            img.pageSizeBytes +
+            1440;  // Allow for a slight increase from previous compressions
+        unpacked.buffer = static_cast<char *>(VSIMalloc(unpacked.size));
+        if (nullptr == unpacked.buffer)
+        {
+            CPLFree(data);
+            CPLError(CE_Failure, CPLE_OutOfMemory, "Cannot allocate %d bytes",
+                     static_cast<int>(unpacked.size));
+            return CE_Failure;
+        }
+
+        auto raw_size = ZSTD_decompressDCtx(ctx, unpacked.buffer, unpacked.size,
+                                            packed.buffer, packed.size);
+        if (ZSTD_isError(raw_size))
+        {  // assume page was not packed, warn only
+            CPLFree(unpacked.buffer);
+            if (!poMRFDS->no_errors)
+                CPLError(CE_Warning, CPLE_AppDefined,
+                         "Can't unpack ZSTD page!");
+        }
+        else
+        {
+            CPLFree(data);  // The compressed data
+            data = unpacked.buffer;
+            size = raw_size;
+            // Might need to undo the rank sort
+            size_t ranks = 0;
+            if (img.comp == IL_NONE || img.comp == IL_ZSTD)
+                ranks = static_cast<size_t>(GDALGetDataTypeSizeBytes(img.dt)) *
+                        img.pagesize.c;
+            if (ranks)
+            {
+                buf_mgr ranked = {data, size};
+                derank(ranked, ranks);
+            }
+        }
+    }
+#else
+    (void)zctx;
+#endif
+
+    src.buffer = data;
+    src.size = size;
+
+    if (poMRFDS->no_errors)
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+    CPLErr ret = Decompress(dst, src);
+    if (poMRFDS->no_errors)
+        CPLPopErrorHandler();
+
+    dst.size =
+        img.pageSizeBytes;  // In case the decompress failed, force it back
+
+    // Swap whatever we decompressed if we need to
+    if (is_Endianess_Dependent(img.dt, img.comp) && (img.nbo != NET_ORDER))
+        swab_buff(dst, img);
+
+    CPLFree(data);
+    src.buffer = nullptr;
+    src.size = 0;
+    return ret;
+}
+
+/**
+ *\brief Encode a separate band page
+ *
+ * Compresses src, which may be modified, in dst, then applies the deflate or
+ * zstd stage using the rest of dst. Returns the encoded page, with the size in
+ * dst.size, or nullptr on error. Like DecodePage(), it doesn't use the dataset
+ * page buffer
+ *
+ */
+
+void *MRFRasterBand::EncodePage(buf_mgr &src, buf_mgr &dst, void *zctx)
+{
+    const size_t capacity = dst.size;
+
+    // Swab the source before encoding if we need to
+    if (is_Endianess_Dependent(img.dt, img.comp) && (img.nbo != NET_ORDER))
+        swab_buff(src, img);
+
+    // Compress functions need to return the compressed size in
+    // the bytes in buffer field
+    Compress(dst, src);
+    void *usebuff = dst.buffer;
+    if (dodeflate)
+    {
+        usebuff = DeflateBlock(dst, capacity - dst.size, deflate_flags);
+        if (!usebuff)
+            CPLError(CE_Failure, CPLE_AppDefined, "MRF: Deflate error");
+    }
+
+#if defined(ZSTD_SUPPORT)
+    else if (dozstd)
+    {
+        size_t ranks = 0;  // Assume no need for byte rank sort
+        if (img.comp == IL_NONE || img.comp == IL_ZSTD)
+            ranks = static_cast<size_t>(GDALGetDataTypeSizeBytes(img.dt));
+        usebuff = ZstdCompBlock(dst, capacity - dst.size, zstd_level,
+                                static_cast<ZSTD_CCtx *>(zctx), ranks);
+        if (!usebuff)
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "MRF: Zstd Compression error");
+    }
+#else
+    (void)zctx;
+#endif
+    return usebuff;
+}
+
+// A page decoded by a worker thread, see PrefetchBlocks()
+struct MRFDecodeJob
+{
+    MRFRasterBand *band = nullptr;
+    int x = 0;
+    int y = 0;
+    vsi_l_offset offset = 0;
+    // The page as read from the data file
+    buf_mgr src{nullptr, 0};
+    // The locked cache block receiving the decoded page
+    GDALRasterBlock *block = nullptr;
+    CPLErr ret = CE_Failure;
+    nanoseconds timer{};
+
+    MRFDecodeJob() = default;
+    MRFDecodeJob(const MRFDecodeJob &) = delete;
+    MRFDecodeJob &operator=(const MRFDecodeJob &) = delete;
+
+    ~MRFDecodeJob()
+    {
+        CPLFree(src.buffer);
+    }
+};
+
+void MRFRasterBand::DecodeJobFunc(void *pData)
+{
+    auto job = static_cast<MRFDecodeJob *>(pData);
+    MRFRasterBand *band = job->band;
+    auto start_time = steady_clock::now();
+
+    // Failed pages are read again by IReadBlock(), which reports the errors
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    void *zctx = nullptr;
+#if defined(ZSTD_SUPPORT)
+    if (band->dozstd)
+        zctx = ZSTD_createDCtx();
+#endif
+    buf_mgr dst = {static_cast<char *>(job->block->GetDataRef()),
+                   static_cast<size_t>(band->img.pageSizeBytes)};
+    job->ret = band->DecodePage(job->src, dst, zctx);
+#if defined(ZSTD_SUPPORT)
+    ZSTD_freeDCtx(static_cast<ZSTD_DCtx *>(zctx));
+#endif
+    CPLPopErrorHandler();
+
+    job->timer = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+}
+
+void MRFRasterBand::EncodeJobFunc(void *pData)
+{
+    auto job = static_cast<MRFEncodeJob *>(pData);
+    MRFRasterBand *band = job->band;
+    const size_t pageSizeBytes = static_cast<size_t>(band->img.pageSizeBytes);
+
+    job->empty = isAllVal(band->eDataType, job->buffer.data(), pageSizeBytes,
+                          job->ndv) != FALSE;
+    if (job->empty)
+        return;
+
+    auto start_time = steady_clock::now();
+
+    // Errors are emitted by FlushEncodeJobs(), from the main thread
+    CPLInstallErrorHandlerAccumulator(job->errors);
+    void *zctx = nullptr;
+#if defined(ZSTD_SUPPORT)
+    if (band->dozstd)
+        zctx = ZSTD_createCCtx();
+#endif
+    buf_mgr src = {job->buffer.data(), pageSizeBytes};
+    buf_mgr dst = {job->buffer.data() + pageSizeBytes,
+                   job->buffer.size() - pageSizeBytes};
+    job->usebuff = band->EncodePage(src, dst, zctx);
+    job->size = dst.size;
+#if defined(ZSTD_SUPPORT)
+    ZSTD_freeCCtx(static_cast<ZSTD_CCtx *>(zctx));
+#endif
+    CPLUninstallErrorHandlerAccumulator();
+
+    job->timer = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+}
+
+/**
+ *\brief Decode concurrently the blocks of a read request
+ *
+ * With NUM_THREADS, the pages covering the request that are not in the block
+ * cache are fetched with a single multi-range read, then decoded by worker
+ * threads directly in the block cache. The pages that can't be handled this
+ * way are left to IReadBlock(), which deals with all the special cases
+ *
+ */
+
+void MRFRasterBand::PrefetchBlocks(int nXOff, int nYOff, int nXSize,
+                                   int nYSize)
+{
+    // Only for local MRFs, with separate band pages
+    if (poMRFDS->m_nNumThreads <= 1 || img.pagesize.c != 1 ||
+        !IsCodecReentrant() || poMRFDS->GetAccess() != GA_ReadOnly ||
+        !poMRFDS->source.empty() || poMRFDS->missing)
+        return;
+
+    const int nXBlock0 = nXOff / nBlockXSize;
+    const int nXBlock1 = (nXOff + nXSize - 1) / nBlockXSize;
+    const int nYBlock0 = nYOff / nBlockYSize;
+    const int nYBlock1 = (nYOff + nYSize - 1) / nBlockYSize;
+    if (nXBlock0 == nXBlock1 && nYBlock0 == nYBlock1)
+        return;
+
+    VSILFILE *l_dfp = DataFP();
+    if (l_dfp == nullptr)
+        return;
+
+    // Keep at most half of the block cache locked
+    const size_t nMaxJobs = static_cast<size_t>(std::max(
+        GIntBig(1), GDALGetCacheMax64() / 2 / std::max(1, img.pageSizeBytes)));
+
+    std::vector<std::unique_ptr<MRFDecodeJob>> jobs;
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    for (int y = nYBlock0; y <= nYBlock1 && jobs.size() < nMaxJobs; y++)
+    {
+        for (int x = nXBlock0; x <= nXBlock1 && jobs.size() < nMaxJobs; x++)
+        {
+            GDALRasterBlock *poBlock = TryGetLockedBlockRef(x, y);
+            if (poBlock != nullptr)
+            {
+                poBlock->DropLock();
+                continue;
+            }
+
+            ILIdx tinfo = {0, 0};
+            ILSize req(x, y, 0, nBand - 1, m_l);
+            if (CE_None != poMRFDS->ReadTileIdx(tinfo, req, img) ||
+                tinfo.size <= 0 || tinfo.size > poMRFDS->pbsize * 2)
+                continue;
+
+            auto job = std::make_unique<MRFDecodeJob>();
+            job->band = this;
+            job->x = x;
+            job->y = y;
+            job->offset = static_cast<vsi_l_offset>(tinfo.offset);
+            job->src.size = static_cast<size_t>(tinfo.size);
+            job->src.buffer = static_cast<char *>(
+                VSI_MALLOC_VERBOSE(job->src.size + PADDING_BYTES));
+            if (job->src.buffer == nullptr)
+                break;
+            /* initialize padding bytes */
+            memset(job->src.buffer + job->src.size, 0, PADDING_BYTES);
+            jobs.push_back(std::move(job));
+        }
+    }
+    CPLPopErrorHandler();
+    if (jobs.size() < 2)
+        return;
+
+    auto poThreadPool = GDALGetGlobalThreadPool(poMRFDS->m_nNumThreads);
+    auto poQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if (!poQueue)
+        return;
+
+    // In file order, which allows merging the ranges for remote files
+    std::sort(jobs.begin(), jobs.end(),
+              [](const std::unique_ptr<MRFDecodeJob> &a,
+                 const std::unique_ptr<MRFDecodeJob> &b)
+              { return a->offset < b->offset; });
+
+    std::vector<void *> apData;
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    for (const auto &job : jobs)
+    {
+        apData.push_back(job->src.buffer);
+        anOffsets.push_back(job->offset);
+        anSizes.push_back(job->src.size);
+    }
+    if (0 != VSIFReadMultiRangeL(static_cast<int>(jobs.size()), apData.data(),
+                                 anOffsets.data(), anSizes.data(), l_dfp))
+        return;
+
+    for (const auto &job : jobs)
+    {
+        job->block = GetLockedBlockRef(job->x, job->y, TRUE);
+        if (job->block == nullptr)
+            continue;
+        if (!poQueue->SubmitJob(DecodeJobFunc, job.get()))
+            DecodeJobFunc(job.get());
+    }
+    poQueue->WaitCompletion();
+
+    for (const auto &job : jobs)
+    {
+        if (job->block == nullptr)
+            continue;
+        poMRFDS->read_timer += job->timer;
+        job->block->DropLock();
+        // Drop it from the cache, IReadBlock() will try again
+        if (job->ret != CE_None)
+            FlushBlock(job->x, job->y, FALSE);
+    }
+}
+
+CPLErr MRFRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
+                                int nXSize, int nYSize, void *pData,
+                                int nBufXSize, int nBufYSize,
+                                GDALDataType eBufType, GSpacing nPixelSpace,
+                                GSpacing nLineSpace,
+                                GDALRasterIOExtraArg *psExtraArg)
+{
+    if (eRWFlag == GF_Read && nXSize == nBufXSize && nYSize == nBufYSize)
+        PrefetchBlocks(nXOff, nYOff, nXSize, nYSize);
+
+    return GDALPamRasterBand::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
+                                        pData, nBufXSize, nBufYSize, eBufType,
+                                        nPixelSpace, nLineSpace, psExtraArg);
+}
+
 /**
  *\brief read a block in the provided buffer
  *
@@ -1068,137 +1470,30 @@ CPLErr MRFRasterBand::IReadBlock(int xblk, int yblk, void *buffer)
     /* initialize padding bytes */
     memset(((char *)data) + static_cast<size_t>(tinfo.size), 0, PADDING_BYTES);
     buf_mgr src = {(char *)data, static_cast<size_t>(tinfo.size)};
-    buf_mgr dst;
 
-    auto start_time = steady_clock::now();
-
-    // We got the data, do we need to decompress it before decoding?
-    if (dodeflate)
-    {
-        if (img.pageSizeBytes > INT_MAX - 1440)
-        {
-            CPLFree(data);
-            CPLError(CE_Failure, CPLE_AppDefined, "Page size is too big at %d",
-                     img.pageSizeBytes);
-            return CE_Failure;
-        }
-        dst.size =
-            img.pageSizeBytes +
-            1440;  // in case the packed page is a bit larger than the raw one
-        dst.buffer = static_cast<char *>(VSIMalloc(dst.size));
-        if (nullptr == dst.buffer)
-        {
-            CPLFree(data);
-            CPLError(CE_Failure, CPLE_OutOfMemory, "Cannot allocate %d bytes",
-                     static_cast<int>(dst.size));
-            return CE_Failure;
-        }
+    // After unpacking, the size has to be pageSizeBytes
+    // If pages are interleaved, use the dataset page buffer instead
+    buf_mgr dst = {reinterpret_cast<char *>((1 == cstride)
+                                                ? buffer
+                                                : poMRFDS->GetPBuffer()),
+                   static_cast<size_t>(img.pageSizeBytes)};
 
-        if (ZUnPack(src, dst, deflate_flags))
-        {  // Got it unpacked, update the pointers
-            CPLFree(data);
-            data = dst.buffer;
-            tinfo.size = dst.size;
-        }
-        else
-        {  // assume the page was not gzipped, warn only
-            CPLFree(dst.buffer);
-            if (!poMRFDS->no_errors)
-                CPLError(CE_Warning, CPLE_AppDefined, "Can't inflate page!");
-        }
-    }
+    auto start_time = steady_clock::now();
 
+    void *zctx = nullptr;
 #if defined(ZSTD_SUPPORT)
-    // undo ZSTD
-    else if (dozstd)
-    {
-        auto ctx = poMRFDS->getzsd();
-        if (!ctx)
-        {
-            CPLFree(data);
-            CPLError(CE_Failure, CPLE_AppDefined, "Can't acquire ZSTD context");
-            return CE_Failure;
-        }
-        if (img.pageSizeBytes > INT_MAX - 1440)
-        {
-            CPLFree(data);
-            CPLError(CE_Failure, CPLE_AppDefined, "Page is too large at %d",
-                     img.pageSizeBytes);
-            return CE_Failure;
-        }
-        dst.size =
-            img.pageSizeBytes +
-            1440;  // Allow for a slight increase from previous compressions
-        dst.buffer = static_cast<char *>(VSIMalloc(dst.size));
-        if (nullptr == dst.buffer)
-        {
-            CPLFree(data);
-            CPLError(CE_Failure, CPLE_OutOfMemory, "Cannot allocate %d bytes",
-                     static_cast<int>(dst.size));
-            return CE_Failure;
-        }
-
-        auto raw_size = ZSTD_decompressDCtx(ctx, dst.buffer, dst.size,
-                                            src.buffer, src.size);
-        if (ZSTD_isError(raw_size))
-        {  // assume page was not packed, warn only
-            CPLFree(dst.buffer);
-            if (!poMRFDS->no_errors)
-                CPLError(CE_Warning, CPLE_AppDefined,
-                         "Can't unpack ZSTD page!");
-        }
-        else
-        {
-            CPLFree(data);  // The compressed data
-            data = dst.buffer;
-            tinfo.size = raw_size;
-            // Might need to undo the rank sort
-            size_t ranks = 0;
-            if (img.comp == IL_NONE || img.comp == IL_ZSTD)
-                ranks = static_cast<size_t>(GDALGetDataTypeSizeBytes(img.dt)) *
-                        img.pagesize.c;
-            if (ranks)
-            {
-                src.buffer = static_cast<char *>(data);
-                src.size = static_cast<size_t>(tinfo.size);
-                derank(src, ranks);
-            }
-        }
-    }
+    if (dozstd)
+        zctx = poMRFDS->getzsd();
 #endif
-
-    src.buffer = static_cast<char *>(data);
-    src.size = static_cast<size_t>(tinfo.size);
-
-    // After unpacking, the size has to be pageSizeBytes
-    // If pages are interleaved, use the dataset page buffer instead
-    dst.buffer = reinterpret_cast<char *>(
-        (1 == cstride) ? buffer : poMRFDS->GetPBuffer());
-    dst.size = img.pageSizeBytes;
-
-    if (poMRFDS->no_errors)
-        CPLPushErrorHandler(CPLQuietErrorHandler);
-    CPLErr ret = Decompress(dst, src);
+    CPLErr ret = DecodePage(src, dst, zctx);
 
     poMRFDS->read_timer +=
         duration_cast<nanoseconds>(steady_clock::now() - start_time);
 
-    dst.size =
-        img.pageSizeBytes;  // In case the decompress failed, force it back
-
-    // Swap whatever we decompressed if we need to
-    if (is_Endianess_Dependent(img.dt, img.comp) && (img.nbo != NET_ORDER))
-        swab_buff(dst, img);
-
-    CPLFree(data);
-    if (poMRFDS->no_errors)
-    {
-        CPLPopErrorHandler();
-        if (ret != CE_None)  // Set each page buffer to the correct no data
-                             // value, then proceed
-            return (1 == cstride) ? FillBlock(buffer)
-                                  : FillBlock(xblk, yblk, buffer);
-    }
+    // Set each page buffer to the correct no data value, then proceed
+    if (poMRFDS->no_errors && ret != CE_None)
+        return (1 == cstride) ? FillBlock(buffer)
+                              : FillBlock(xblk, yblk, buffer);
 
     // If pages are separate or we had errors, we're done
     if (1 == cstride || CE_None != ret)
@@ -1236,11 +1531,34 @@ CPLErr MRFRasterBand::IWriteBlock(int xblk, int yblk, void *buffer)
 
     if (1 == cstride)
     {  // Separate bands, we can write it as is
-        // Empty page skip
         int success;
         double val = GetNoDataValue(&success);
         if (!success)
             val = 0.0;
+
+        // Encode in a worker thread, which also checks for empty pages
+        if (poMRFDS->m_nNumThreads > 1 && IsCodecReentrant())
+        {
+            auto job = std::make_unique<MRFEncodeJob>();
+            job->band = this;
+            job->infooffset = infooffset;
+            job->ndv = val;
+            try
+            {
+                job->buffer.resize(static_cast<size_t>(img.pageSizeBytes) +
+                                   poMRFDS->pbsize);
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "MRF: Can't allocate write buffer");
+                return CE_Failure;
+            }
+            memcpy(job->buffer.data(), buffer, img.pageSizeBytes);
+            return poMRFDS->SubmitEncodeJob(std::move(job));
+        }
+
+        // Empty page skip
         if (isAllVal(eDataType, buffer, img.pageSizeBytes, val))
             return poMRFDS->WriteTile(nullptr, infooffset, 0);
 
@@ -1253,43 +1571,17 @@ CPLErr MRFRasterBand::IWriteBlock(int xblk, int yblk, void *buffer)
         buf_mgr dst = {(char *)poMRFDS->GetPBuffer(),
                        poMRFDS->GetPBufferSize()};
 
-        // Swab the source before encoding if we need to
-        if (is_Endianess_Dependent(img.dt, img.comp) && (img.nbo != NET_ORDER))
-            swab_buff(src, img);
-
         auto start_time = steady_clock::now();
 
-        // Compress functions need to return the compressed size in
-        // the bytes in buffer field
-        Compress(dst, src);
-        void *usebuff = dst.buffer;
-        if (dodeflate)
-        {
-            usebuff =
-                DeflateBlock(dst, poMRFDS->pbsize - dst.size, deflate_flags);
-            if (!usebuff)
-            {
-                CPLError(CE_Failure, CPLE_AppDefined, "MRF: Deflate error");
-                return CE_Failure;
-            }
-        }
-
+        void *zctx = nullptr;
 #if defined(ZSTD_SUPPORT)
-        else if (dozstd)
-        {
-            size_t ranks = 0;  // Assume no need for byte rank sort
-            if (img.comp == IL_NONE || img.comp == IL_ZSTD)
-                ranks = static_cast<size_t>(GDALGetDataTypeSizeBytes(img.dt));
-            usebuff = ZstdCompBlock(dst, poMRFDS->pbsize - dst.size, zstd_level,
-                                    poMRFDS->getzsc(), ranks);
-            if (!usebuff)
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "MRF: Zstd Compression error");
-                return CE_Failure;
-            }
-        }
+        if (dozstd)
+            zctx = poMRFDS->getzsc();
 #endif
+        void *usebuff = EncodePage(src, dst, zctx);
+        if (!usebuff)
+            return CE_Failure;
+
         poMRFDS->write_timer +=
             duration_cast<nanoseconds>(steady_clock::now() - start_time);
         return poMRFDS->WriteTile(usebuff, infooffset, dst.size);
@@ -657,6 +657,8 @@ void GDALRegister_mrf()
         "       <Value>RGB</Value>"
         "       <Value>YCC</Value>"
         "   </Option>\n"
+        "   <Option name='NUM_THREADS' type='string' description='Number of "
+        "worker threads for page encoding, or ALL_CPUS'/>\n"
         "   <Option name='OPTIONS' type='string' description='\n"
         "     Compression dependent parameters, space separated:\n"
 #if defined(ZSTD_SUPPORT)
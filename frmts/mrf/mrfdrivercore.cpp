@@ -119,6 +119,8 @@ void MRFDriverSetCommonMetadata(GDALDriver *poDriver)
         "decompression errors' default='FALSE'/>"
         "    <Option name='ZSLICE' type='int' description='For a third "
         "dimension MRF, pick a slice' default='0'/>"
+        "    <Option name='NUM_THREADS' type='string' description='Number of "
+        "worker threads for page decoding and encoding, or ALL_CPUS'/>"
         "</OpenOptionList>");
 
     // These will need to be revisited, do we support complex data types too?
@@ -244,6 +244,7 @@ class netCDFRasterBand final : public GDALPamRasterBand
     void CheckDataCpx(void *pImage, void *pImageNC, size_t nTmpBlockXSize,
                       size_t nTmpBlockYSize, bool bCheckIsNan = false);
     void SetBlockSize();
+    void SetChunkCacheSize(const size_t *panChunkSize);
 
     bool FetchNetcdfChunk(size_t xstart, size_t ystart, void *pImage);
 
@@ -867,6 +868,9 @@ void netCDFRasterBand::SetBlockSize()
                 nBlockYSize = (int)chunksize[nZDim - 2];
             else
                 nBlockYSize = 1;
+
+            if (poDS->GetAccess() == GA_ReadOnly)
+                SetChunkCacheSize(chunksize);
         }
     }
 
@@ -900,6 +904,69 @@ void netCDFRasterBand::SetBlockSize()
     }
 }
 
+/************************************************************************/
+/*                         SetChunkCacheSize()                          */
+/************************************************************************/
+
+// When chunks span several bands (e.g. a (time, lat, lon) variable chunked
+// along time), each chunk is decompressed once per band read from it, unless
+// it is still in the libnetcdf chunk cache. The default cache (a few MB) is
+// generally too small to hold all the chunks of a 2D slice, so enlarge it
+// to that size, within a fraction of GDAL_CACHEMAX.
+void netCDFRasterBand::SetChunkCacheSize(const size_t *panChunkSize)
+{
+    if (nZDim < 3)
+        return;
+    size_t nChunkDepth = 1;
+    for (int i = 0; i < nZDim - 2; ++i)
+        nChunkDepth *= panChunkSize[i];
+    if (nChunkDepth <= 1)
+        return;
+
+    size_t nCurSize = 0;
+    size_t nCurNElems = 0;
+    float fCurPreemption = 0;
+    if (nc_get_var_chunk_cache(cdfid, nZId, &nCurSize, &nCurNElems,
+                               &fCurPreemption) != NC_NOERR)
+    {
+        return;
+    }
+
+    const size_t nChunkBytes = nChunkDepth * nBlockXSize * nBlockYSize *
+                               GDALGetDataTypeSizeBytes(eDataType);
+    const size_t nChunksPerSlice =
+        static_cast<size_t>(DIV_ROUND_UP(nRasterXSize, nBlockXSize)) *
+        DIV_ROUND_UP(nRasterYSize, nBlockYSize);
+    const char *pszCacheSize =
+        CPLGetConfigOption("GDAL_NETCDF_CHUNK_CACHE_SIZE", nullptr);
+    uint64_t nWishedSize;
+    if (pszCacheSize)
+    {
+        nWishedSize = std::strtoull(pszCacheSize, nullptr, 10);
+    }
+    else
+    {
+        // Decompressed chunks are cached in addition to GDAL blocks.
+        const uint64_t nMaxSize =
+            static_cast<uint64_t>(GDALGetCacheMax64()) / 4;
+        nWishedSize = std::min(
+            static_cast<uint64_t>(nChunksPerSlice) * nChunkBytes, nMaxSize);
+        if (nWishedSize <= nCurSize)
+            return;
+    }
+    nWishedSize = std::min<uint64_t>(nWishedSize,
+                                     std::numeric_limits<size_t>::max());
+    const size_t nNewSize = static_cast<size_t>(nWishedSize);
+    // HDF5 recommends about 10 hash slots per cached chunk.
+    const size_t nNewNElems = std::max(
+        nCurNElems, std::min(nNewSize / std::max<size_t>(1, nChunkBytes),
+                             nChunksPerSlice) *
+                            10);
+    CPLDebug("GDAL_netCDF", "Setting chunk cache of variable %d to %u MB",
+             nZId, static_cast<unsigned>(nNewSize / (1024 * 1024)));
+    nc_set_var_chunk_cache(cdfid, nZId, nNewSize, nNewNElems, fCurPreemption);
+}
+
 // Constructor in create mode.
 // If nZId and following variables are not passed, the band will have 2
 // dimensions.
@@ -2380,6 +2447,14 @@ bool netCDFRasterBand::FetchNetcdfChunk(size_t xstart, size_t ystart,
              (GDALGetDataTypeSize(eDataType) / 8));
     }
 
+    // libnetcdf fetches and decompresses the data itself, so the number
+    // of fetched bytes is not known, and the decoding time includes the
+    // fetching time.
+    GDALCodecStatisticsRecorder oRecorder(
+        poDS, GDALCodecStatisticsRecorder::Operation::DECODE);
+    oRecorder.SetDecodedSize(static_cast<GIntBig>(edge[nBandXPos]) *
+                             nYChunkSize * GDALGetDataTypeSizeBytes(eDataType));
+
     // Read data according to type.
     int status;
     if (eDataType == GDT_Byte)
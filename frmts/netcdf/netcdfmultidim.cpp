@@ -576,6 +576,11 @@ class netCDFVariable final : public GDALPamMDArray, public netCDFAttributeHolder
     bool IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
                      CSLConstList papszOptions) const override;
 
+    bool CanUseChunkCache() const override
+    {
+        return true;
+    }
+
     void NotifyChildrenOfRenaming() override;
 
     bool SetStatistics(bool bApproxStats, double dfMin, double dfMax,
@@ -91,6 +91,7 @@ void OPENJPEGDriverSetCommonMetadata(GDALDriver *poDriver)
                               "Byte Int16 UInt16 Int32 UInt32");
 
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
+    poDriver->SetMetadataItem(GDAL_DCAP_PARALLEL_CLONE_READ, "YES");
 
     poDriver->SetMetadataItem(
         GDAL_DMD_OPENOPTIONLIST,
@@ -37,6 +37,7 @@
 #include "cpl_string.h"
 #include "cpl_worker_thread_pool.h"
 #include "gdal_frmts.h"
+#include "gdal_thread_pool.h"
 #include "gdaljp2abstractdataset.h"
 #include "gdaljp2metadata.h"
 #include "vrt/vrtdataset.h"
@@ -319,18 +320,20 @@ int JP2OPJLikeDataset<CODEC, BASE>::PreloadBlocks(
             return -1;
         }
 
+        // Decode tiles with the global thread pool, rather than creating
+        // threads at each request.
+        CPLWorkerThreadPool *poThreadPool = nullptr;
         if (this->m_nBlocksToLoad > 1)
         {
-            const int l_nThreads = std::min(this->m_nBlocksToLoad, nMaxThreads);
-            CPLJoinableThread **pahThreads =
-                (CPLJoinableThread **)VSI_CALLOC_VERBOSE(
-                    sizeof(CPLJoinableThread *), l_nThreads);
-            if (pahThreads == nullptr)
-            {
+            poThreadPool = GDALGetGlobalThreadPool(nMaxThreads);
+            if (poThreadPool == nullptr)
                 this->m_nBlocksToLoad = 0;
-                return -1;
-            }
-            int i;
+        }
+
+        if (this->m_nBlocksToLoad > 1)
+        {
+            const int l_nThreads = std::min(this->m_nBlocksToLoad, nMaxThreads);
+            auto poQueue = poThreadPool->CreateJobQueue();
 
             CPLDebug(CODEC::debugId(), "%d blocks to load (%d threads)",
                      this->m_nBlocksToLoad, l_nThreads);
@@ -366,18 +369,16 @@ int JP2OPJLikeDataset<CODEC, BASE>::PreloadBlocks(
             /* This is a workaround to a design defect of the block cache */
             GDALRasterBlock::FlushDirtyBlocks();
 
-            for (i = 0; i < l_nThreads; i++)
+            // Each job processes blocks until none remain, with its own
+            // file handle.
+            for (int i = 0; i < l_nThreads; i++)
             {
-                pahThreads[i] =
-                    CPLCreateJoinableThread(ReadBlockInThread, &oJob);
-                if (pahThreads[i] == nullptr)
+                if (!poQueue->SubmitJob(ReadBlockInThread, &oJob))
                     oJob.bSuccess = false;
             }
             TemporarilyDropReadWriteLock();
-            for (i = 0; i < l_nThreads; i++)
-                CPLJoinThread(pahThreads[i]);
+            poQueue->WaitCompletion();
             ReacquireReadWriteLock();
-            CPLFree(pahThreads);
             if (!oJob.bSuccess)
             {
                 this->m_nBlocksToLoad = 0;
@@ -516,9 +517,17 @@ CPLErr JP2OPJLikeDataset<CODEC, BASE>::ReadBlock(int nBand, VSILFILE *fpIn,
     const int nHeightToRead =
         std::min(nBlockYSize, nRasterYSize - nBlockYOff * nBlockYSize);
 
-    eErr = this->readBlockInit(fpIn, &localctx, nBlockXOff, nBlockYOff,
-                               this->nRasterXSize, this->nRasterYSize,
-                               nBlockXSize, nBlockYSize, nTileNumber);
+    {
+        // The codec fetches the encoded bytes itself, so their number is
+        // not known, and the decoding time includes the fetching time.
+        GDALCodecStatisticsRecorder oRecorder(
+            this, GDALCodecStatisticsRecorder::Operation::DECODE);
+        oRecorder.SetDecodedSize(static_cast<GIntBig>(nWidthToRead) *
+                                 nHeightToRead * nBands * nDataTypeSize);
+        eErr = this->readBlockInit(fpIn, &localctx, nBlockXOff, nBlockYOff,
+                                   this->nRasterXSize, this->nRasterYSize,
+                                   nBlockXSize, nBlockYSize, nTileNumber);
+    }
     if (eErr != CE_None)
         goto end;
 
@@ -45,7 +45,9 @@
 #include "cpl_string.h"
 #include "gdal_frmts.h"
 #include "gdal_pam.h"
+#include "gdal_thread_pool.h"
 #include "png.h"
+#include "zlib.h"
 
 #include <csetjmp>
 
@@ -528,6 +530,12 @@ CPLErr PNGDataset::LoadWholeImage(void *pSingleBuffer, GSpacing nPixelSpace,
     if (bError)
         return CE_Failure;
 
+    GDALCodecStatisticsRecorder oRecorder(
+        this, GDALCodecStatisticsRecorder::Operation::DECODE);
+    oRecorder.SetEncodedSize(static_cast<GIntBig>(nCompressedDataSize));
+    oRecorder.SetDecodedSize(static_cast<GIntBig>(nRasterXSize) *
+                             nRasterYSize * nBands);
+
     const int nSamplesPerLine = nRasterXSize * nBands;
     size_t nOutBytes;
     constexpr int FILTER_TYPE_BYTE = 1;
@@ -1418,7 +1426,17 @@ CPLErr PNGDataset::LoadInterlacedChunk(int iLine)
             png_rows[i] = dummy_row;
     }
 
-    bool bRet = safe_png_read_image(hPNG, png_rows, sSetJmpContext);
+    bool bRet;
+    {
+        GDALCodecStatisticsRecorder oRecorder(
+            this, GDALCodecStatisticsRecorder::Operation::DECODE);
+        const vsi_l_offset nStartPos = VSIFTellL(fpImage);
+        bRet = safe_png_read_image(hPNG, png_rows, sSetJmpContext);
+        oRecorder.SetEncodedSize(
+            static_cast<GIntBig>(VSIFTellL(fpImage) - nStartPos));
+        oRecorder.SetDecodedSize(static_cast<GIntBig>(nPixelOffset) *
+                                 GetRasterXSize() * nBufferLines);
+    }
 
     CPLFree(png_rows);
     CPLFree(dummy_row);
@@ -1476,6 +1494,9 @@ CPLErr PNGDataset::LoadScanline(int nLine)
     }
 
     // Read till we get the desired row.
+    GDALCodecStatisticsRecorder oRecorder(
+        this, GDALCodecStatisticsRecorder::Operation::DECODE);
+    const vsi_l_offset nStartPos = VSIFTellL(fpImage);
     png_bytep row = pabyBuffer;
     const GUInt32 nErrorCounter = CPLGetErrorCounter();
     while (nLine > nLastLineRead)
@@ -1491,6 +1512,10 @@ CPLErr PNGDataset::LoadScanline(int nLine)
         }
         nLastLineRead++;
     }
+    oRecorder.SetEncodedSize(
+        static_cast<GIntBig>(VSIFTellL(fpImage) - nStartPos));
+    oRecorder.SetDecodedSize(static_cast<GIntBig>(nPixelOffset) *
+                             GetRasterXSize());
 
     nBufferStartLine = nLine;
     nBufferLines = 1;
@@ -2168,6 +2193,380 @@ static bool safe_png_write_end(jmp_buf sSetJmpContext, png_structp png_ptr,
     return true;
 }
 
+static bool safe_png_write_chunk(jmp_buf sSetJmpContext, png_structp png_ptr,
+                                 const char *pszChunkName,
+                                 png_const_bytep data, size_t length)
+{
+    if (setjmp(sSetJmpContext) != 0)
+    {
+        return false;
+    }
+    png_write_chunk(png_ptr, reinterpret_cast<png_const_bytep>(pszChunkName),
+                    data, length);
+    return true;
+}
+
+/************************************************************************/
+/*                          PNGApplyFilter()                            */
+/************************************************************************/
+
+static inline int PNGPaethPredictor(int a, int b, int c)
+{
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc)
+        return a;
+    if (pb <= pc)
+        return b;
+    return c;
+}
+
+// Applies PNG filter type FILTER to pabyRow, and returns the sum of the
+// absolute values of the filtered bytes taken as signed ones.
+template <int FILTER>
+static size_t PNGApplyFilter(const GByte *pabyRow, const GByte *pabyPrevRow,
+                             size_t nRowBytes, size_t nBpp, GByte *pabyOut)
+{
+    size_t nSum = 0;
+    for (size_t i = 0; i < nRowBytes; ++i)
+    {
+        const int x = pabyRow[i];
+        const int a = i >= nBpp ? pabyRow[i - nBpp] : 0;
+        const int b = pabyPrevRow ? pabyPrevRow[i] : 0;
+        const int c = (pabyPrevRow && i >= nBpp) ? pabyPrevRow[i - nBpp] : 0;
+        int nPred = 0;
+        if (FILTER == PNG_FILTER_VALUE_SUB)
+            nPred = a;
+        else if (FILTER == PNG_FILTER_VALUE_UP)
+            nPred = b;
+        else if (FILTER == PNG_FILTER_VALUE_AVG)
+            nPred = (a + b) / 2;
+        else if (FILTER == PNG_FILTER_VALUE_PAETH)
+            nPred = PNGPaethPredictor(a, b, c);
+        const GByte byVal = static_cast<GByte>(x - nPred);
+        pabyOut[i] = byVal;
+        nSum += byVal < 128 ? byVal : 256 - byVal;
+    }
+    return nSum;
+}
+
+/************************************************************************/
+/*                           PNGFilterRow()                             */
+/************************************************************************/
+
+// Writes the filter type byte followed by the filtered row to pabyOut.
+// In adaptive mode, the filter minimizing the sum of absolute differences
+// is selected, as libpng does by default. pabyTmp must be nRowBytes large.
+static void PNGFilterRow(const GByte *pabyRow, const GByte *pabyPrevRow,
+                         size_t nRowBytes, size_t nBpp, bool bAdaptive,
+                         GByte *pabyOut, GByte *pabyTmp)
+{
+    if (!bAdaptive)
+    {
+        pabyOut[0] = PNG_FILTER_VALUE_NONE;
+        memcpy(pabyOut + 1, pabyRow, nRowBytes);
+        return;
+    }
+
+    const auto TryFilter = [&](int nFilter, size_t nSum, size_t &nBestSum)
+    {
+        if (nSum < nBestSum)
+        {
+            nBestSum = nSum;
+            pabyOut[0] = static_cast<GByte>(nFilter);
+            memcpy(pabyOut + 1, pabyTmp, nRowBytes);
+        }
+    };
+
+    pabyOut[0] = PNG_FILTER_VALUE_NONE;
+    size_t nBestSum = PNGApplyFilter<PNG_FILTER_VALUE_NONE>(
+        pabyRow, pabyPrevRow, nRowBytes, nBpp, pabyOut + 1);
+    TryFilter(PNG_FILTER_VALUE_SUB,
+              PNGApplyFilter<PNG_FILTER_VALUE_SUB>(pabyRow, pabyPrevRow,
+                                                   nRowBytes, nBpp, pabyTmp),
+              nBestSum);
+    TryFilter(PNG_FILTER_VALUE_UP,
+              PNGApplyFilter<PNG_FILTER_VALUE_UP>(pabyRow, pabyPrevRow,
+                                                  nRowBytes, nBpp, pabyTmp),
+              nBestSum);
+    TryFilter(PNG_FILTER_VALUE_AVG,
+              PNGApplyFilter<PNG_FILTER_VALUE_AVG>(pabyRow, pabyPrevRow,
+                                                   nRowBytes, nBpp, pabyTmp),
+              nBestSum);
+    TryFilter(PNG_FILTER_VALUE_PAETH,
+              PNGApplyFilter<PNG_FILTER_VALUE_PAETH>(pabyRow, pabyPrevRow,
+                                                     nRowBytes, nBpp, pabyTmp),
+              nBestSum);
+}
+
+/************************************************************************/
+/*                          PNGDeflateJob                               */
+/************************************************************************/
+
+namespace
+{
+// Band of rows filtered and compressed by a worker thread, as a part of
+// a raw DEFLATE stream ending on a byte boundary (Z_SYNC_FLUSH), so that
+// parts can be concatenated.
+struct PNGDeflateJob
+{
+    const GByte *pabyRows = nullptr;
+    // Unfiltered row preceding pabyRows, or nullptr for the first row
+    const GByte *pabyPrevRow = nullptr;
+    int nRows = 0;
+    size_t nRowBytes = 0;
+    size_t nBpp = 0;
+    bool bAdaptiveFilter = false;
+    int nLevel = Z_DEFAULT_COMPRESSION;
+    bool bLastPart = false;
+
+    std::vector<GByte> abyCompressed{};
+    size_t nCompressedSize = 0;
+    uLong nAdler = 0;
+    bool bSuccess = false;
+};
+}  // namespace
+
+static void PNGDeflateJobFunc(void *pData)
+{
+    PNGDeflateJob *psJob = static_cast<PNGDeflateJob *>(pData);
+    psJob->bSuccess = false;
+    psJob->nCompressedSize = 0;
+    psJob->nAdler = adler32(0, nullptr, 0);
+
+    const size_t nFilteredRowBytes = psJob->nRowBytes + 1;
+    std::vector<GByte> abyFilteredRow;
+    std::vector<GByte> abyTmp;
+
+    z_stream sStream;
+    memset(&sStream, 0, sizeof(sStream));
+    // Same strategy as libpng
+    if (deflateInit2(&sStream, psJob->nLevel, Z_DEFLATED, -MAX_WBITS, 8,
+                     psJob->bAdaptiveFilter ? Z_FILTERED
+                                            : Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        return;
+    }
+
+    try
+    {
+        abyFilteredRow.resize(nFilteredRowBytes);
+        abyTmp.resize(psJob->nRowBytes);
+        psJob->abyCompressed.resize(
+            deflateBound(&sStream, static_cast<uLong>(nFilteredRowBytes *
+                                                      psJob->nRows)) +
+            64);
+    }
+    catch (const std::exception &)
+    {
+        deflateEnd(&sStream);
+        return;
+    }
+    sStream.next_out = psJob->abyCompressed.data();
+    sStream.avail_out = static_cast<uInt>(std::min<size_t>(
+        psJob->abyCompressed.size(), std::numeric_limits<uInt>::max()));
+
+    bool bOK = true;
+    const GByte *pabyPrevRow = psJob->pabyPrevRow;
+    for (int iRow = 0; bOK && iRow < psJob->nRows; ++iRow)
+    {
+        const GByte *pabyRow = psJob->pabyRows + iRow * psJob->nRowBytes;
+        PNGFilterRow(pabyRow, pabyPrevRow, psJob->nRowBytes, psJob->nBpp,
+                     psJob->bAdaptiveFilter, abyFilteredRow.data(),
+                     abyTmp.data());
+        pabyPrevRow = pabyRow;
+        psJob->nAdler =
+            adler32(psJob->nAdler, abyFilteredRow.data(),
+                    static_cast<uInt>(nFilteredRowBytes));
+
+        sStream.next_in = abyFilteredRow.data();
+        sStream.avail_in = static_cast<uInt>(nFilteredRowBytes);
+        const int nFlush = iRow + 1 < psJob->nRows ? Z_NO_FLUSH
+                           : psJob->bLastPart      ? Z_FINISH
+                                                   : Z_SYNC_FLUSH;
+        int nRet = Z_OK;
+        do
+        {
+            if (sStream.avail_out == 0)
+            {
+                const size_t nOffset = static_cast<size_t>(sStream.total_out);
+                try
+                {
+                    psJob->abyCompressed.resize(2 *
+                                                psJob->abyCompressed.size());
+                }
+                catch (const std::exception &)
+                {
+                    bOK = false;
+                    break;
+                }
+                sStream.next_out = psJob->abyCompressed.data() + nOffset;
+                sStream.avail_out = static_cast<uInt>(
+                    std::min<size_t>(psJob->abyCompressed.size() - nOffset,
+                                     std::numeric_limits<uInt>::max()));
+            }
+            nRet = deflate(&sStream, nFlush);
+            if (nRet == Z_STREAM_ERROR)
+                bOK = false;
+        } while (bOK && sStream.avail_out == 0 && nRet != Z_STREAM_END);
+        if (bOK && nFlush == Z_FINISH && nRet != Z_STREAM_END)
+            bOK = false;
+    }
+
+    psJob->nCompressedSize = static_cast<size_t>(sStream.total_out);
+    deflateEnd(&sStream);
+    psJob->bSuccess = bOK;
+}
+
+/************************************************************************/
+/*                     PNGWriteImageMultiThreaded()                     */
+/************************************************************************/
+
+// Writes the IDAT chunks of the image, compressed by bands of rows in
+// parallel, in the way of pigz. This only handles bit depths of 8 and 16.
+static CPLErr PNGWriteImageMultiThreaded(
+    jmp_buf sSetJmpContext, png_structp hPNG, GDALDataset *poSrcDS,
+    GDALDataType eType, int nBitDepth, bool bPalette, int nLevel,
+    int nThreads, int nRowsPerJob, GDALProgressFunc pfnProgress,
+    void *pProgressData)
+{
+    const int nXSize = poSrcDS->GetRasterXSize();
+    const int nYSize = poSrcDS->GetRasterYSize();
+    const int nBands = poSrcDS->GetRasterCount();
+    const int nWordSize = GDALGetDataTypeSizeBytes(eType);
+    const size_t nRowBytes = static_cast<size_t>(nXSize) * nBands * nWordSize;
+    const int nRowsPerBatch = static_cast<int>(std::min<GIntBig>(
+        static_cast<GIntBig>(nRowsPerJob) * nThreads, nYSize));
+
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    auto poQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if (!poQueue)
+        return CE_Failure;
+
+    // The first row is the last one of the previous batch
+    std::vector<GByte> abyRows;
+    std::vector<PNGDeflateJob> asJobs(nThreads);
+    try
+    {
+        abyRows.resize(nRowBytes * (1 + nRowsPerBatch));
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for PNG compression");
+        return CE_Failure;
+    }
+    GByte *pabyBatch = abyRows.data() + nRowBytes;
+
+    // zlib header
+    std::vector<GByte> abyIDAT;
+    const int nCMF = 0x78;  // DEFLATE with a 32 KB window
+    const int nEffectiveLevel = nLevel < 0 ? 6 : nLevel;
+    const int nLevelFlags = nEffectiveLevel < 2    ? 0
+                            : nEffectiveLevel < 6  ? 1
+                            : nEffectiveLevel == 6 ? 2
+                                                   : 3;
+    int nHeader = (nCMF << 8) | (nLevelFlags << 6);
+    nHeader += 31 - nHeader % 31;
+    abyIDAT.push_back(static_cast<GByte>(nHeader >> 8));
+    abyIDAT.push_back(static_cast<GByte>(nHeader & 0xFF));
+    uLong nAdler = adler32(0, nullptr, 0);
+
+    CPLErr eErr = CE_None;
+    for (int iLine = 0; iLine < nYSize && eErr == CE_None;
+         iLine += nRowsPerBatch)
+    {
+        const int nBatchRows = std::min(nRowsPerBatch, nYSize - iLine);
+        eErr = poSrcDS->RasterIO(
+            GF_Read, 0, iLine, nXSize, nBatchRows, pabyBatch, nXSize,
+            nBatchRows, eType, nBands, nullptr,
+            static_cast<GSpacing>(nBands) * nWordSize, nRowBytes, nWordSize,
+            nullptr);
+        if (eErr != CE_None)
+            break;
+#ifdef CPL_LSB
+        if (nBitDepth == 16)
+            GDALSwapWords(pabyBatch, 2,
+                          static_cast<size_t>(nXSize) * nBands * nBatchRows, 2);
+#else
+        CPL_IGNORE_RET_VAL(nBitDepth);
+#endif
+
+        int nJobs = 0;
+        for (int iRow = 0; iRow < nBatchRows; iRow += nRowsPerJob, ++nJobs)
+        {
+            PNGDeflateJob &sJob = asJobs[nJobs];
+            sJob.pabyRows = pabyBatch + iRow * nRowBytes;
+            sJob.pabyPrevRow =
+                (iLine + iRow == 0) ? nullptr : sJob.pabyRows - nRowBytes;
+            sJob.nRows = std::min(nRowsPerJob, nBatchRows - iRow);
+            sJob.nRowBytes = nRowBytes;
+            sJob.nBpp = static_cast<size_t>(nBands) * nWordSize;
+            sJob.bAdaptiveFilter = !bPalette;
+            sJob.nLevel = nLevel;
+            sJob.bLastPart = iLine + iRow + sJob.nRows == nYSize;
+            if (!poQueue->SubmitJob(PNGDeflateJobFunc, &sJob))
+            {
+                eErr = CE_Failure;
+                break;
+            }
+        }
+        poQueue->WaitCompletion();
+        if (eErr != CE_None)
+            break;
+
+        for (int iJob = 0; iJob < nJobs; ++iJob)
+        {
+            const PNGDeflateJob &sJob = asJobs[iJob];
+            if (!sJob.bSuccess)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "DEFLATE compression failed");
+                eErr = CE_Failure;
+                break;
+            }
+            nAdler = adler32_combine(
+                nAdler, sJob.nAdler,
+                static_cast<z_off_t>((nRowBytes + 1) * sJob.nRows));
+            abyIDAT.insert(abyIDAT.end(), sJob.abyCompressed.begin(),
+                           sJob.abyCompressed.begin() + sJob.nCompressedSize);
+        }
+        if (eErr != CE_None)
+            break;
+
+        if (iLine + nBatchRows == nYSize)
+        {
+            // zlib trailer
+            abyIDAT.push_back(static_cast<GByte>(nAdler >> 24));
+            abyIDAT.push_back(static_cast<GByte>((nAdler >> 16) & 0xFF));
+            abyIDAT.push_back(static_cast<GByte>((nAdler >> 8) & 0xFF));
+            abyIDAT.push_back(static_cast<GByte>(nAdler & 0xFF));
+        }
+        if (!safe_png_write_chunk(sSetJmpContext, hPNG, "IDAT", abyIDAT.data(),
+                                  abyIDAT.size()))
+        {
+            eErr = CE_Failure;
+            break;
+        }
+        abyIDAT.clear();
+
+        memcpy(abyRows.data(), pabyBatch + (nBatchRows - 1) * nRowBytes,
+               nRowBytes);
+
+        if (!pfnProgress((iLine + nBatchRows) / static_cast<double>(nYSize),
+                         nullptr, pProgressData))
+        {
+            eErr = CE_Failure;
+            CPLError(CE_Failure, CPLE_UserInterrupt,
+                     "User terminated CreateCopy()");
+        }
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                             CreateCopy()                             */
 /************************************************************************/
@@ -2291,10 +2690,11 @@ GDALDataset *PNGDataset::CreateCopy(const char *pszFilename,
 
     // Do we want to control the compression level?
     const char *pszLevel = CSLFetchNameValue(papszOptions, "ZLEVEL");
+    int nLevel = Z_DEFAULT_COMPRESSION;
 
     if (pszLevel)
     {
-        const int nLevel = atoi(pszLevel);
+        nLevel = atoi(pszLevel);
         if (nLevel < 1 || nLevel > 9)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -2676,10 +3076,39 @@ GDALDataset *PNGDataset::CreateCopy(const char *pszFilename,
     CPLErr eErr = CE_None;
     const int nWordSize = GDALGetDataTypeSize(eType) / 8;
 
+    // Multi-threaded compression by bands of rows of about 1 MB.
+    // GDAL_NUM_THREADS is not used as a default, since this driver is also
+    // run from the global thread pool, e.g. for GPKG and MBTiles tiles.
+    int nThreads = 1;
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads)
+    {
+        nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+        nThreads = std::max(1, std::min(nThreads, 1024));
+    }
+    const int nRowsPerJob = static_cast<int>(std::min<size_t>(
+        std::max<size_t>(1, 1024 * 1024 / (static_cast<size_t>(nBands) *
+                                           nXSize * nWordSize)),
+        nYSize));
+    const bool bMultiThreaded =
+        nThreads > 1 && nBitDepth >= 8 && nYSize >= 2 * nRowsPerJob;
+
     GByte *pabyScanline =
-        reinterpret_cast<GByte *>(CPLMalloc(nBands * nXSize * nWordSize));
+        bMultiThreaded ? nullptr
+                       : reinterpret_cast<GByte *>(
+                             CPLMalloc(nBands * nXSize * nWordSize));
+
+    if (bMultiThreaded)
+    {
+        eErr = PNGWriteImageMultiThreaded(
+            sSetJmpContext, hPNG, poSrcDS, eType, nBitDepth,
+            nColorType == PNG_COLOR_TYPE_PALETTE, nLevel, nThreads,
+            nRowsPerJob, pfnProgress, pProgressData);
+    }
 
-    for (int iLine = 0; iLine < nYSize && eErr == CE_None; iLine++)
+    for (int iLine = 0; !bMultiThreaded && iLine < nYSize && eErr == CE_None;
+         iLine++)
     {
         png_bytep row = pabyScanline;
 
@@ -2712,7 +3141,17 @@ GDALDataset *PNGDataset::CreateCopy(const char *pszFilename,
 
     CPLFree(pabyScanline);
 
-    if (!safe_png_write_end(sSetJmpContext, hPNG, psPNGInfo))
+    if (bMultiThreaded)
+    {
+        // png_write_end() requires the IDAT chunks to have been written by
+        // libpng. All other chunks have been written by png_write_info().
+        if (eErr == CE_None &&
+            !safe_png_write_chunk(sSetJmpContext, hPNG, "IEND", nullptr, 0))
+        {
+            eErr = CE_Failure;
+        }
+    }
+    else if (!safe_png_write_end(sSetJmpContext, hPNG, psPNGInfo))
     {
         eErr = CE_Failure;
     }
@@ -92,6 +92,9 @@ void PNGDriverSetCommonMetadata(GDALDriver *poDriver)
         "default='FALSE'/>\n"
         "   <Option name='NBITS' type='int' description='Force output bit "
         "depth: 1, 2 or 4'/>\n"
+        "   <Option name='NUM_THREADS' type='string' description='Number of "
+        "worker threads for compression. Can be set to ALL_CPUS' "
+        "default='1'/>\n"
         "</CreationOptionList>\n");
 
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
@@ -30,8 +30,11 @@
 #include <cmath>
 #include "gdal.h"
 #include "vrtdataset.h"
+#include "vrtexpression.h"
 
+#include <cstdint>
 #include <limits>
+#include <vector>
 
 template <typename T>
 inline double GetSrcVal(const void *pSource, GDALDataType eSrcType, T ii)
@@ -109,6 +112,101 @@ static CPLErr FetchDoubleArg(CSLConstList papszArgs, const char *pszName,
     return CE_None;
 }
 
+/************************************************************************/
+/*                          ApplyOnRealLines()                          */
+/************************************************************************/
+
+template <class T, class LineFunc>
+static CPLErr ApplyOnRealLines(void **papoSources, int nSources, void *pData,
+                               int nXSize, int nYSize, GDALDataType eBufType,
+                               int nPixelSpace, int nLineSpace,
+                               LineFunc &&oLineFunc)
+{
+    std::vector<double> adfLine;
+    std::vector<const T *> apSrcLine;
+    try
+    {
+        adfLine.resize(nXSize);
+        apSrcLine.resize(nSources);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in pixel function");
+        return CE_Failure;
+    }
+
+    for (int iLine = 0; iLine < nYSize; ++iLine)
+    {
+        const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+        for (int iSrc = 0; iSrc < nSources; ++iSrc)
+            apSrcLine[iSrc] =
+                static_cast<const T *>(papoSources[iSrc]) + nOffset;
+
+        oLineFunc(apSrcLine.data(), adfLine.data(), nXSize);
+
+        GByte *pabyDst = static_cast<GByte *>(pData) +
+                         static_cast<GSpacing>(nLineSpace) * iLine;
+        GDALCopyWords64(adfLine.data(), GDT_Float64,
+                        static_cast<int>(sizeof(double)), pabyDst, eBufType,
+                        nPixelSpace, nXSize);
+    }
+    return CE_None;
+}
+
+// Evaluate a pixel function on sources of a real data type, one line at a
+// time. oLineFunc(papSrc, padfLine, nXSize) is a generic callable whose
+// papSrc[i] points to the values of the line in the i-th source, with their
+// actual data type, and which must compute the nXSize double values of
+// padfLine. Specializing the loops on the source data type, instead of
+// converting each value with GetSrcVal(), lets the compiler vectorize them.
+// The results are converted to the output data type once per line.
+template <class LineFunc>
+static CPLErr ApplyOnRealLines(void **papoSources, int nSources, void *pData,
+                               int nXSize, int nYSize, GDALDataType eSrcType,
+                               GDALDataType eBufType, int nPixelSpace,
+                               int nLineSpace, LineFunc &&oLineFunc)
+{
+#define APPLY_ON_REAL_LINES(T)                                                 \
+    return ApplyOnRealLines<T>(papoSources, nSources, pData, nXSize, nYSize,   \
+                               eBufType, nPixelSpace, nLineSpace, oLineFunc)
+
+    switch (eSrcType)
+    {
+        case GDT_Byte:
+            APPLY_ON_REAL_LINES(GByte);
+        case GDT_Int8:
+            APPLY_ON_REAL_LINES(GInt8);
+        case GDT_UInt16:
+            APPLY_ON_REAL_LINES(GUInt16);
+        case GDT_Int16:
+            APPLY_ON_REAL_LINES(GInt16);
+        case GDT_UInt32:
+            APPLY_ON_REAL_LINES(GUInt32);
+        case GDT_Int32:
+            APPLY_ON_REAL_LINES(GInt32);
+        case GDT_UInt64:
+            APPLY_ON_REAL_LINES(std::uint64_t);
+        case GDT_Int64:
+            APPLY_ON_REAL_LINES(std::int64_t);
+        case GDT_Float32:
+            APPLY_ON_REAL_LINES(float);
+        case GDT_Float64:
+            APPLY_ON_REAL_LINES(double);
+        case GDT_Unknown:
+        case GDT_CInt16:
+        case GDT_CInt32:
+        case GDT_CFloat32:
+        case GDT_CFloat64:
+        case GDT_TypeCount:
+            break;
+    }
+#undef APPLY_ON_REAL_LINES
+
+    CPLAssert(false);
+    return CE_Failure;
+}
+
 static CPLErr RealPixelFunc(void **papoSources, int nSources, void *pData,
                             int nXSize, int nYSize, GDALDataType eSrcType,
                             GDALDataType eBufType, int nPixelSpace,
@@ -346,22 +444,14 @@ static CPLErr ModulePixelFunc(void **papoSources, int nSources, void *pData,
     else
     {
         /* ---- Set pixels ---- */
-        size_t ii = 0;
-        for (int iLine = 0; iLine < nYSize; ++iLine)
-        {
-            for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+        return ApplyOnRealLines(
+            papoSources, nSources, pData, nXSize, nYSize, eSrcType, eBufType,
+            nPixelSpace, nLineSpace,
+            [](const auto *const *papSrc, double *padfLine, int nCount)
             {
-                // Source raster pixels may be obtained with GetSrcVal macro.
-                const double dfPixVal =
-                    fabs(GetSrcVal(papoSources[0], eSrcType, ii));
-
-                GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                              static_cast<GByte *>(pData) +
-                                  static_cast<GSpacing>(nLineSpace) * iLine +
-                                  iCol * nPixelSpace,
-                              eBufType, nPixelSpace, 1);
-            }
-        }
+                for (int i = 0; i < nCount; ++i)
+                    padfLine[i] = std::fabs(static_cast<double>(papSrc[0][i]));
+            });
     }
 
     /* ---- Return success ---- */
@@ -543,27 +633,20 @@ static CPLErr SumPixelFunc(void **papoSources, int nSources, void *pData,
     else
     {
         /* ---- Set pixels ---- */
-        size_t ii = 0;
-        for (int iLine = 0; iLine < nYSize; ++iLine)
-        {
-            for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+        return ApplyOnRealLines(
+            papoSources, nSources, pData, nXSize, nYSize, eSrcType, eBufType,
+            nPixelSpace, nLineSpace,
+            [dfK, nSources](const auto *const *papSrc, double *padfLine,
+                            int nCount)
             {
-                double dfSum = dfK;  // Not complex.
-
+                std::fill_n(padfLine, nCount, dfK);  // Not complex.
                 for (int iSrc = 0; iSrc < nSources; ++iSrc)
                 {
-                    // Source raster pixels may be obtained with GetSrcVal
-                    // macro.
-                    dfSum += GetSrcVal(papoSources[iSrc], eSrcType, ii);
+                    const auto *const pSrc = papSrc[iSrc];
+                    for (int i = 0; i < nCount; ++i)
+                        padfLine[i] += static_cast<double>(pSrc[i]);
                 }
-
-                GDALCopyWords(&dfSum, GDT_Float64, 0,
-                              static_cast<GByte *>(pData) +
-                                  static_cast<GSpacing>(nLineSpace) * iLine +
-                                  iCol * nPixelSpace,
-                              eBufType, nPixelSpace, 1);
-            }
-        }
+            });
     }
 
     /* ---- Return success ---- */
@@ -697,27 +780,20 @@ static CPLErr MulPixelFunc(void **papoSources, int nSources, void *pData,
     else
     {
         /* ---- Set pixels ---- */
-        size_t ii = 0;
-        for (int iLine = 0; iLine < nYSize; ++iLine)
-        {
-            for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+        return ApplyOnRealLines(
+            papoSources, nSources, pData, nXSize, nYSize, eSrcType, eBufType,
+            nPixelSpace, nLineSpace,
+            [dfK, nSources](const auto *const *papSrc, double *padfLine,
+                            int nCount)
             {
-                double dfPixVal = dfK;  // Not complex.
-
+                std::fill_n(padfLine, nCount, dfK);  // Not complex.
                 for (int iSrc = 0; iSrc < nSources; ++iSrc)
                 {
-                    // Source raster pixels may be obtained with GetSrcVal
-                    // macro.
-                    dfPixVal *= GetSrcVal(papoSources[iSrc], eSrcType, ii);
+                    const auto *const pSrc = papSrc[iSrc];
+                    for (int i = 0; i < nCount; ++i)
+                        padfLine[i] *= static_cast<double>(pSrc[i]);
                 }
-
-                GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                              static_cast<GByte *>(pData) +
-                                  static_cast<GSpacing>(nLineSpace) * iLine +
-                                  iCol * nPixelSpace,
-                              eBufType, nPixelSpace, 1);
-            }
-        }
+            });
     }
 
     /* ---- Return success ---- */
@@ -1088,22 +1164,17 @@ static CPLErr Log10PixelFuncHelper(void **papoSources, int nSources,
     else
     {
         /* ---- Set pixels ---- */
-        size_t ii = 0;
-        for (int iLine = 0; iLine < nYSize; ++iLine)
-        {
-            for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+        return ApplyOnRealLines(
+            papoSources, nSources, pData, nXSize, nYSize, eSrcType, eBufType,
+            nPixelSpace, nLineSpace,
+            [fact](const auto *const *papSrc, double *padfLine, int nCount)
             {
-                // Source raster pixels may be obtained with GetSrcVal macro.
-                const double dfPixVal =
-                    fact * log10(fabs(GetSrcVal(papoSources[0], eSrcType, ii)));
-
-                GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                              static_cast<GByte *>(pData) +
-                                  static_cast<GSpacing>(nLineSpace) * iLine +
-                                  iCol * nPixelSpace,
-                              eBufType, nPixelSpace, 1);
-            }
-        }
+                for (int i = 0; i < nCount; ++i)
+                {
+                    const double dfVal = static_cast<double>(papSrc[0][i]);
+                    padfLine[i] = fact * std::log10(std::fabs(dfVal));
+                }
+            });
     }
 
     /* ---- Return success ---- */
@@ -1241,24 +1312,15 @@ static CPLErr PowPixelFunc(void **papoSources, int nSources, void *pData,
         return CE_Failure;
 
     /* ---- Set pixels ---- */
-    size_t ii = 0;
-    for (int iLine = 0; iLine < nYSize; ++iLine)
-    {
-        for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+    return ApplyOnRealLines(
+        papoSources, nSources, pData, nXSize, nYSize, eSrcType, eBufType,
+        nPixelSpace, nLineSpace,
+        [power](const auto *const *papSrc, double *padfLine, int nCount)
         {
-            const double dfPixVal =
-                std::pow(GetSrcVal(papoSources[0], eSrcType, ii), power);
-
-            GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                          static_cast<GByte *>(pData) +
-                              static_cast<GSpacing>(nLineSpace) * iLine +
-                              iCol * nPixelSpace,
-                          eBufType, nPixelSpace, 1);
-        }
-    }
-
-    /* ---- Return success ---- */
-    return CE_None;
+            for (int i = 0; i < nCount; ++i)
+                padfLine[i] =
+                    std::pow(static_cast<double>(papSrc[0][i]), power);
+        });
 }
 
 // Given nt intervals spaced by dt and beginning at t0, return the index of
@@ -1342,27 +1404,21 @@ CPLErr InterpolatePixelFunc(void **papoSources, int nSources, void *pData,
     double dfX1 = dfT0 + dfDt;
 
     /* ---- Set pixels ---- */
-    size_t ii = 0;
-    for (int iLine = 0; iLine < nYSize; ++iLine)
-    {
-        for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+    return ApplyOnRealLines(
+        papoSources, nSources, pData, nXSize, nYSize, eSrcType, eBufType,
+        nPixelSpace, nLineSpace,
+        [i0, i1, dfT0, dfX1, dfT](const auto *const *papSrc, double *padfLine,
+                                  int nCount)
         {
-            const double dfY0 = GetSrcVal(papoSources[i0], eSrcType, ii);
-            const double dfY1 = GetSrcVal(papoSources[i1], eSrcType, ii);
-
-            const double dfPixVal =
-                InterpolationFunction(dfT0, dfX1, dfY0, dfY1, dfT);
-
-            GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                          static_cast<GByte *>(pData) +
-                              static_cast<GSpacing>(nLineSpace) * iLine +
-                              iCol * nPixelSpace,
-                          eBufType, nPixelSpace, 1);
-        }
-    }
-
-    /* ---- Return success ---- */
-    return CE_None;
+            const auto *const pY0 = papSrc[i0];
+            const auto *const pY1 = papSrc[i1];
+            for (int i = 0; i < nCount; ++i)
+            {
+                padfLine[i] = InterpolationFunction(
+                    dfT0, dfX1, static_cast<double>(pY0[i]),
+                    static_cast<double>(pY1[i]), dfT);
+            }
+        });
 }
 
 static const char pszReplaceNoDataPixelFuncMetadata[] =
@@ -1451,24 +1507,16 @@ static CPLErr ScalePixelFunc(void **papoSources, int nSources, void *pData,
         return CE_Failure;
 
     /* ---- Set pixels ---- */
-    size_t ii = 0;
-    for (int iLine = 0; iLine < nYSize; ++iLine)
-    {
-        for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+    return ApplyOnRealLines(
+        papoSources, nSources, pData, nXSize, nYSize, eSrcType, eBufType,
+        nPixelSpace, nLineSpace,
+        [dfScale, dfOffset](const auto *const *papSrc, double *padfLine,
+                            int nCount)
         {
-            const double dfPixVal =
-                GetSrcVal(papoSources[0], eSrcType, ii) * dfScale + dfOffset;
-
-            GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                          static_cast<GByte *>(pData) +
-                              static_cast<GSpacing>(nLineSpace) * iLine +
-                              iCol * nPixelSpace,
-                          eBufType, nPixelSpace, 1);
-        }
-    }
-
-    /* ---- Return success ---- */
-    return CE_None;
+            for (int i = 0; i < nCount; ++i)
+                padfLine[i] =
+                    static_cast<double>(papSrc[0][i]) * dfScale + dfOffset;
+        });
 }
 
 static CPLErr NormDiffPixelFunc(void **papoSources, int nSources, void *pData,
@@ -1696,6 +1744,9 @@ static CPLErr MaxPixelFunc(void **papoSources, int nSources, void *pData,
  *                      exponential interpolation
  * - "scale": Apply the RasterBand metadata values of "offset" and "scale"
  * - "nan": Convert incoming NoData values to IEEE 754 nan
+ * - "expression": evaluate the arithmetic expression given in the
+ *                 "expression" argument, where B1, B2, ... are the values
+ *                 of the sources
  *
  * @see GDALAddDerivedBandPixelFunc
  *
@@ -1703,6 +1754,9 @@ static CPLErr MaxPixelFunc(void **papoSources, int nSources, void *pData,
  */
 CPLErr GDALRegisterDefaultPixelFunc()
 {
+    // All the functions below only depend on their inputs and arguments.
+    VRTSetRegisteringThreadSafePixelFunc(true);
+
     GDALAddDerivedBandPixelFunc("real", RealPixelFunc);
     GDALAddDerivedBandPixelFunc("imag", ImagPixelFunc);
     GDALAddDerivedBandPixelFunc("complex", ComplexPixelFunc);
@@ -1749,5 +1803,9 @@ CPLErr GDALRegisterDefaultPixelFunc()
                                         pszMinMaxFuncMetadataNodata);
     GDALAddDerivedBandPixelFuncWithArgs("max", MaxPixelFunc,
                                         pszMinMaxFuncMetadataNodata);
+    GDALAddDerivedBandPixelFuncWithArgs("expression", VRTExpressionPixelFunc,
+                                        pszVRTExpressionPixelFuncMetadata);
+
+    VRTSetRegisteringThreadSafePixelFunc(false);
     return CE_None;
 }
@@ -175,6 +175,13 @@ CPLErr VRTFlushCacheStruct<T>::FlushCache(T &obj, bool bAtClosing)
     if (!CPLSerializeXMLTreeToFile(psDSTree, obj.GetDescription()))
         eErr = CE_Failure;
     CPLDestroyXMLNode(psDSTree);
+
+    // A source index sidecar no longer matches the file.
+    const std::string osSourceIndex(
+        VRTSourceIndex::GetFilename(obj.GetDescription()));
+    VSIStatBufL sStat;
+    if (VSIStatExL(osSourceIndex.c_str(), &sStat, VSI_STAT_EXISTS_FLAG) == 0)
+        VSIUnlink(osSourceIndex.c_str());
     return eErr;
 }
 
@@ -768,24 +775,38 @@ GDALDataset *VRTDataset::Open(GDALOpenInfo *poOpenInfo)
         return OpenVRTProtocol(poOpenInfo->pszFilename);
 
     /* -------------------------------------------------------------------- */
-    /*      Try to read the whole file into memory.                         */
+    /*      Try to read the whole file into memory, or only its part that   */
+    /*      is not in a source index sidecar.                               */
     /* -------------------------------------------------------------------- */
     char *pszXML = nullptr;
     VSILFILE *fp = poOpenInfo->fpL;
+    const bool bIsFile = fp != nullptr;
+    const char *pszSourceIndex =
+        CPLGetConfigOption("VRT_SOURCE_INDEX", "AUTO");
+    std::shared_ptr<VRTSourceIndex> poSourceIndex;
 
     char *pszVRTPath = nullptr;
     if (fp != nullptr)
     {
         poOpenInfo->fpL = nullptr;
 
-        GByte *pabyOut = nullptr;
-        if (!VSIIngestFile(fp, poOpenInfo->pszFilename, &pabyOut, nullptr,
-                           INT_MAX - 1))
+        if (!EQUAL(pszSourceIndex, "NO"))
+            poSourceIndex = VRTSourceIndex::Open(poOpenInfo->pszFilename);
+        if (poSourceIndex)
         {
-            CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
-            return nullptr;
+            pszXML = CPLStrdup(poSourceIndex->GetHeaderXML().c_str());
+        }
+        else
+        {
+            GByte *pabyOut = nullptr;
+            if (!VSIIngestFile(fp, poOpenInfo->pszFilename, &pabyOut, nullptr,
+                               INT_MAX - 1))
+            {
+                CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
+                return nullptr;
+            }
+            pszXML = reinterpret_cast<char *>(pabyOut);
         }
-        pszXML = reinterpret_cast<char *>(pabyOut);
 
         char *pszCurDir = CPLGetCurrentDir();
         const char *currentVrtFilename =
@@ -874,6 +895,32 @@ GDALDataset *VRTDataset::Open(GDALOpenInfo *poOpenInfo)
     VRTDataset *poDS = static_cast<VRTDataset *>(
         OpenXML(pszXML, pszVRTPath, poOpenInfo->eAccess));
 
+    if (poDS != nullptr && poSourceIndex != nullptr &&
+        !poSourceIndex->AttachSources(poDS, pszVRTPath))
+    {
+        CPLDebug("VRT", "Ignoring %s which does not match %s",
+                 poSourceIndex->GetFilename().c_str(),
+                 poOpenInfo->pszFilename);
+        delete poDS;
+        poDS = nullptr;
+        poSourceIndex.reset();
+        CPLFree(pszXML);
+        GByte *pabyOut = nullptr;
+        pszXML = nullptr;
+        if (VSIIngestFile(nullptr, poOpenInfo->pszFilename, &pabyOut, nullptr,
+                          INT_MAX - 1))
+        {
+            pszXML = reinterpret_cast<char *>(pabyOut);
+            poDS = static_cast<VRTDataset *>(
+                OpenXML(pszXML, pszVRTPath, poOpenInfo->eAccess));
+        }
+    }
+    else if (poDS != nullptr && poSourceIndex == nullptr && bIsFile &&
+             EQUAL(pszSourceIndex, "YES"))
+    {
+        VRTSourceIndex::Write(poOpenInfo->pszFilename, pszXML);
+    }
+
     if (poDS != nullptr)
         poDS->m_bNeedsFlush = false;
 
@@ -1972,6 +2019,12 @@ char **VRTDataset::GetFileList()
 
     CPLHashSetDestroy(hSetFiles);
 
+    if (m_poSourceIndex)
+    {
+        papszFileList = CSLAddString(papszFileList,
+                                     m_poSourceIndex->GetFilename().c_str());
+    }
+
     return papszFileList;
 }
 
@@ -1997,9 +2050,58 @@ CPLErr VRTDataset::Delete(const char *pszFilename)
         return CE_Failure;
     }
 
+    if (strstr(pszFilename, "<VRTDataset") == nullptr)
+    {
+        const std::string osSourceIndex(
+            VRTSourceIndex::GetFilename(pszFilename));
+        VSIStatBufL sStat;
+        if (VSIStatExL(osSourceIndex.c_str(), &sStat, VSI_STAT_EXISTS_FLAG) ==
+            0)
+            VSIUnlink(osSourceIndex.c_str());
+    }
+
     return CE_None;
 }
 
+/************************************************************************/
+/*                            CanBeCloned()                             */
+/************************************************************************/
+
+bool VRTDataset::CanBeCloned() const
+{
+    return nBands > 0 && m_poRootGroup == nullptr;
+}
+
+/************************************************************************/
+/*                               Clone()                                */
+/*                                                                      */
+/*      Instantiate a new read-only dataset from the XML serialization  */
+/*      of this one, so that it has its own sources.                    */
+/************************************************************************/
+
+std::unique_ptr<GDALDataset> VRTDataset::Clone() const
+{
+    if (!CanBeCloned())
+        return nullptr;
+
+    const char *pszDescription = GetDescription();
+    const std::string osVRTPath(
+        pszDescription[0] && !STARTS_WITH(pszDescription, "<VRTDataset")
+            ? CPLGetPath(pszDescription)
+            : "");
+    CPLXMLTreeCloser psDSTree(
+        const_cast<VRTDataset *>(this)->SerializeToXML(osVRTPath.c_str()));
+    if (!psDSTree)
+        return nullptr;
+    char *pszXML = CPLSerializeXMLTree(psDSTree.get());
+    std::unique_ptr<GDALDataset> poCloneDS(
+        OpenXML(pszXML, osVRTPath.c_str(), GA_ReadOnly));
+    CPLFree(pszXML);
+    if (poCloneDS)
+        poCloneDS->SetDescription(pszDescription);
+    return poCloneDS;
+}
+
 /************************************************************************/
 /*                          CreateMaskBand()                            */
 /************************************************************************/
@@ -2352,17 +2454,39 @@ CPLErr VRTDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         // they don't necessary instantiate all underlying rasterbands.
         VRTSourcedRasterBand *poBand =
             static_cast<VRTSourcedRasterBand *>(papoBands[nBands - 1]);
-        for (int iSource = 0; eErr == CE_None && iSource < poBand->nSources;
-             iSource++)
+        std::vector<int> anSources;
+        if (psExtraArg->bFloatingPointWindowValidity)
+        {
+            poBand->GetSourcesInWindow(psExtraArg->dfXOff, psExtraArg->dfYOff,
+                                       psExtraArg->dfXSize,
+                                       psExtraArg->dfYSize, anSources);
+        }
+        else
+        {
+            poBand->GetSourcesInWindow(nXOff, nYOff, nXSize, nYSize,
+                                       anSources);
+        }
+        if (psExtraArg->bFloatingPointWindowValidity)
+        {
+            poBand->PrefetchSourceHeaders(
+                anSources, psExtraArg->dfXOff, psExtraArg->dfYOff,
+                psExtraArg->dfXSize, psExtraArg->dfYSize);
+        }
+        else
+        {
+            poBand->PrefetchSourceHeaders(anSources, nXOff, nYOff, nXSize,
+                                          nYSize);
+        }
+        const int nCandidates = static_cast<int>(anSources.size());
+        for (int i = 0; eErr == CE_None && i < nCandidates; i++)
         {
             psExtraArg->pfnProgress = GDALScaledProgress;
             psExtraArg->pProgressData = GDALCreateScaledProgress(
-                1.0 * iSource / poBand->nSources,
-                1.0 * (iSource + 1) / poBand->nSources, pfnProgressGlobal,
-                pProgressDataGlobal);
+                1.0 * i / nCandidates, 1.0 * (i + 1) / nCandidates,
+                pfnProgressGlobal, pProgressDataGlobal);
 
-            VRTSimpleSource *poSource =
-                static_cast<VRTSimpleSource *>(poBand->papoSources[iSource]);
+            VRTSimpleSource *poSource = static_cast<VRTSimpleSource *>(
+                poBand->papoSources[anSources[i]]);
 
             eErr = poSource->DatasetRasterIO(
                 poBand->GetRasterDataType(), nXOff, nYOff, nXSize, nYSize,
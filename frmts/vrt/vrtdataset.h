@@ -35,6 +35,7 @@
 
 #include "cpl_hash_set.h"
 #include "cpl_minixml.h"
+#include "cpl_quad_tree.h"
 #include "gdal_pam.h"
 #include "gdal_priv.h"
 #include "gdal_rat.h"
@@ -44,11 +45,13 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 int VRTApplyMetadata(CPLXMLNode *, GDALMajorObject *);
 CPLXMLNode *VRTSerializeMetadata(GDALMajorObject *);
 CPLErr GDALRegisterDefaultPixelFunc();
+void VRTSetRegisteringThreadSafePixelFunc(bool bThreadSafe);
 CPLString VRTSerializeNoData(double dfVal, GDALDataType eDataType,
                              int nPrecision);
 #if 0
@@ -170,11 +173,13 @@ template <class T> struct VRTFlushCacheStruct
 class VRTWarpedDataset;
 class VRTPansharpenedDataset;
 class VRTGroup;
+class VRTSourceIndex;
 
 class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
 {
     friend class VRTRasterBand;
     friend struct VRTFlushCacheStruct<VRTDataset>;
+    friend class VRTSourceIndex;
     friend struct VRTFlushCacheStruct<VRTWarpedDataset>;
     friend struct VRTFlushCacheStruct<VRTPansharpenedDataset>;
     friend class VRTSourcedRasterBand;
@@ -213,6 +218,9 @@ class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
     std::map<CPLString, GDALDataset *> m_oMapSharedSources{};
     std::shared_ptr<VRTGroup> m_poRootGroup{};
 
+    // Source index sidecar the sources of the bands were attached from.
+    std::shared_ptr<VRTSourceIndex> m_poSourceIndex{};
+
     VRTRasterBand *InitBand(const char *pszSubclass, int nBand,
                             bool bAllowPansharpened);
     static GDALDataset *OpenVRTProtocol(const char *pszSpec);
@@ -250,6 +258,9 @@ class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
     virtual CPLErr CreateMaskBand(int nFlags) override;
     void SetMaskBand(VRTRasterBand *poMaskBand);
 
+    bool CanBeCloned() const override;
+    std::unique_ptr<GDALDataset> Clone() const override;
+
     const OGRSpatialReference *GetSpatialRef() const override
     {
         return m_poSRS;
@@ -361,8 +372,11 @@ class CPL_DLL VRTWarpedDataset final : public VRTDataset
     int m_nOverviewCount;
     VRTWarpedDataset **m_papoOverviews;
     int m_nSrcOvrLevel;
+    bool m_bProcessingMissingBlocks = false;
 
     void CreateImplicitOverviews();
+    CPLErr ProcessBlocks(int iBlockX, int iBlockY, int nBlocksX,
+                         int nBlocksY);
 
     friend class VRTWarpedRasterBand;
 
@@ -395,7 +409,16 @@ class CPL_DLL VRTWarpedDataset final : public VRTDataset
 
     virtual char **GetFileList() override;
 
+    virtual CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
+                             int nXSize, int nYSize, void *pData, int nBufXSize,
+                             int nBufYSize, GDALDataType eBufType,
+                             int nBandCount, int *panBandMap,
+                             GSpacing nPixelSpace, GSpacing nLineSpace,
+                             GSpacing nBandSpace,
+                             GDALRasterIOExtraArg *psExtraArg) override;
+
     CPLErr ProcessBlock(int iBlockX, int iBlockY);
+    CPLErr ProcessMissingBlocks(int nXOff, int nYOff, int nXSize, int nYSize);
 
     void GetBlockSize(int *, int *) const;
 };
@@ -640,6 +663,27 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
     bool IsMosaicOfNonOverlappingSimpleSourcesOfFullRasterNoResAndTypeChange(
         bool bAllowMaxValAdjustment) const;
 
+    // Spatial index of the destination windows of the sources, for bands
+    // with many sources. Rebuilt when papoSources or nSources change.
+    CPLQuadTree *m_hSourceQuadTree = nullptr;
+    VRTSource **m_papoIndexedSources = nullptr;
+    int m_nIndexedSources = 0;
+    std::vector<int> m_anUnboundedSources{};
+
+    // Number of sources still to be read from a source index sidecar.
+    int m_nLazySources = 0;
+
+    void InvalidateSourceIndex();
+    void MaterializeLazySources(const std::vector<int> &anSources);
+
+    bool ParallelSourcesRasterIO(const std::vector<int> &anSources, int nXOff,
+                                 int nYOff, int nXSize, int nYSize, void *pData,
+                                 int nBufXSize, int nBufYSize,
+                                 GDALDataType eBufType, GSpacing nPixelSpace,
+                                 GSpacing nLineSpace,
+                                 GDALRasterIOExtraArg *psExtraArg,
+                                 CPLErr &eErr);
+
     CPL_DISALLOW_COPY_ASSIGN(VRTSourcedRasterBand)
 
   protected:
@@ -649,6 +693,12 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
     int nSources = 0;
     VRTSource **papoSources = nullptr;
 
+    void GetSourcesInWindow(double dfXOff, double dfYOff, double dfXSize,
+                            double dfYSize, std::vector<int> &anSources);
+    void PrefetchSourceHeaders(const std::vector<int> &anSources,
+                               double dfXOff, double dfYOff, double dfXSize,
+                               double dfYSize);
+
     VRTSourcedRasterBand(GDALDataset *poDS, int nBand);
     VRTSourcedRasterBand(GDALDataType eType, int nXSize, int nYSize);
     VRTSourcedRasterBand(GDALDataset *poDS, int nBand, GDALDataType eType,
@@ -782,6 +832,12 @@ class CPL_DLL VRTWarpedRasterBand final : public VRTRasterBand
     virtual CPLErr IReadBlock(int, int, void *) override;
     virtual CPLErr IWriteBlock(int, int, void *) override;
 
+    virtual CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
+                             int nXSize, int nYSize, void *pData, int nBufXSize,
+                             int nBufYSize, GDALDataType eBufType,
+                             GSpacing nPixelSpace, GSpacing nLineSpace,
+                             GDALRasterIOExtraArg *psExtraArg) override;
+
     virtual int GetOverviewCount() override;
     virtual GDALRasterBand *GetOverview(int) override;
 };
@@ -860,6 +916,8 @@ class CPL_DLL VRTDerivedRasterBand CPL_NON_FINAL : public VRTSourcedRasterBand
                              GSpacing nLineSpace,
                              GDALRasterIOExtraArg *psExtraArg) override;
 
+    virtual CPLErr IReadBlock(int, int, void *) override;
+
     virtual int IGetDataCoverageStatus(int nXOff, int nYOff, int nXSize,
                                        int nYSize, int nMaskFlagStop,
                                        double *pdfDataPct) override;
@@ -1022,8 +1080,20 @@ class CPL_DLL VRTSimpleSource CPL_NON_FINAL : public VRTSource
 
     bool m_bDropRefOnSrcBand = true;
 
+    // Whether the beginning of the source file has already been read ahead
+    // of its opening. See VRTSourcedRasterBand::PrefetchSourceHeaders()
+    bool m_bHeaderPrefetched = false;
+
+    // Footprint of the valid data of the source, in source pixel/line
+    // coordinates. Requests that do not intersect it are skipped without
+    // opening the source.
+    std::shared_ptr<OGRGeometry> m_poFootprint{};
+
     int NeedMaxValAdjustment() const;
 
+    bool FootprintIntersects(double dfReqXOff, double dfReqYOff,
+                             double dfReqXSize, double dfReqYSize) const;
+
     GDALRasterBand *GetRasterBandNoOpen() const
     {
         return m_poRasterBand;
@@ -1062,6 +1132,12 @@ class CPL_DLL VRTSimpleSource CPL_NON_FINAL : public VRTSource
     }
     void SetResampling(const char *pszResampling);
 
+    void SetFootprint(std::unique_ptr<OGRGeometry> poFootprint);
+    const OGRGeometry *GetFootprint() const
+    {
+        return m_poFootprint.get();
+    }
+
     int GetSrcDstWindow(double, double, double, double, int, int,
                         double *pdfReqXOff, double *pdfReqYOff,
                         double *pdfReqXSize, double *pdfReqYSize, int *, int *,
@@ -1235,6 +1311,28 @@ class CPL_DLL VRTComplexSource CPL_NON_FINAL : public VRTSimpleSource
                                  GSpacing nLineSpace,
                                  GDALRasterIOExtraArg *psExtraArg);
 
+    // Return values of ProcessRealValue(), also used as status of the
+    // entries of the tables of RasterIOProcessTable().
+    static constexpr int PROCESS_VALUE_VALID = 0;
+    static constexpr int PROCESS_VALUE_NODATA = 1;
+    static constexpr int PROCESS_VALUE_NO_COLOR_ENTRY = 2;
+    static constexpr int PROCESS_VALUE_ERROR = 3;
+
+    template <class WorkingDT>
+    int ProcessRealValue(GDALRasterBand *poSourceBand,
+                         const GDALColorTable *poColorTable,
+                         WorkingDT &fResult);
+
+    template <class SourceDT, GDALDataType eSourceType, class WorkingDT>
+    CPLErr RasterIOProcessTable(GDALRasterBand *poSourceBand,
+                                GDALDataType eVRTBandDataType, int nReqXOff,
+                                int nReqYOff, int nReqXSize, int nReqYSize,
+                                void *pData, int nOutXSize, int nOutYSize,
+                                GDALDataType eBufType, GSpacing nPixelSpace,
+                                GSpacing nLineSpace,
+                                GDALRasterIOExtraArg *psExtraArg,
+                                GDALDataType eWrkDataType);
+
   public:
     VRTComplexSource() = default;
     VRTComplexSource(const VRTComplexSource *poSrcSource, double dfXDstRatio,
@@ -1404,6 +1502,120 @@ class VRTFuncSource final : public VRTSource
     float fNoDataValue;
 };
 
+/************************************************************************/
+/*                            VRTSourceIndex                            */
+/************************************************************************/
+
+/** Sidecar file storing the sources of the bands of a VRT file, so that
+ * they can be instantiated on demand rather than parsed at opening time. */
+class VRTSourceIndex final : public std::enable_shared_from_this<VRTSourceIndex>
+{
+    CPL_DISALLOW_COPY_ASSIGN(VRTSourceIndex)
+
+  public:
+    struct Entry
+    {
+        double dfDstXOff = -1;
+        double dfDstYOff = -1;
+        double dfDstXSize = -1;
+        double dfDstYSize = -1;
+        GUInt64 nOffset = 0;
+        GUInt32 nSize = 0;
+    };
+
+  private:
+    VSILFILE *m_fp = nullptr;
+    std::string m_osFilename{};
+    std::mutex m_oMutex{};
+    std::string m_osVRTPath{};
+    std::string m_osHeaderXML{};
+    std::vector<std::vector<Entry>> m_aaoEntries{};
+
+    VRTSourceIndex() = default;
+
+  public:
+    ~VRTSourceIndex();
+
+    static std::string GetFilename(const char *pszVRTFilename);
+    static std::shared_ptr<VRTSourceIndex> Open(const char *pszVRTFilename);
+    static bool Write(const char *pszVRTFilename, const char *pszXML);
+
+    const std::string &GetFilename() const
+    {
+        return m_osFilename;
+    }
+    const std::string &GetHeaderXML() const
+    {
+        return m_osHeaderXML;
+    }
+    const char *GetVRTPath() const
+    {
+        return m_osVRTPath.c_str();
+    }
+
+    bool AttachSources(VRTDataset *poDS, const char *pszVRTPath);
+    bool ReadFragment(GUInt64 nOffset, GUInt32 nSize, std::string &osXML);
+};
+
+/************************************************************************/
+/*                            VRTLazySource                             */
+/************************************************************************/
+
+/** Source whose XML definition is read from a source index sidecar and
+ * parsed the first time it is needed. */
+class VRTLazySource final : public VRTSource
+{
+    CPL_DISALLOW_COPY_ASSIGN(VRTLazySource)
+
+    std::shared_ptr<VRTSourceIndex> m_poIndex;
+    GUInt64 m_nOffset;
+    GUInt32 m_nSize;
+    std::map<CPLString, GDALDataset *> &m_oMapSharedSources;
+    std::unique_ptr<VRTSource> m_poSource{};
+    bool m_bTriedToMaterialize = false;
+
+  public:
+    VRTLazySource(const std::shared_ptr<VRTSourceIndex> &poIndex,
+                  const VRTSourceIndex::Entry &oEntry,
+                  std::map<CPLString, GDALDataset *> &oMapSharedSources);
+
+    double m_dfDstXOff;
+    double m_dfDstYOff;
+    double m_dfDstXSize;
+    double m_dfDstYSize;
+
+    // Maximum value to set on the source, from the NBITS of the band.
+    int m_nMaxValue = 0;
+
+    VRTSource *GetSource();
+    VRTSource *StealSource();
+
+    virtual CPLErr RasterIO(GDALDataType eVRTBandDataType, int nXOff, int nYOff,
+                            int nXSize, int nYSize, void *pData, int nBufXSize,
+                            int nBufYSize, GDALDataType eBufType,
+                            GSpacing nPixelSpace, GSpacing nLineSpace,
+                            GDALRasterIOExtraArg *psExtraArg) override;
+
+    virtual double GetMinimum(int nXSize, int nYSize, int *pbSuccess) override;
+    virtual double GetMaximum(int nXSize, int nYSize, int *pbSuccess) override;
+    virtual CPLErr GetHistogram(int nXSize, int nYSize, double dfMin,
+                                double dfMax, int nBuckets,
+                                GUIntBig *panHistogram, int bIncludeOutOfRange,
+                                int bApproxOK, GDALProgressFunc pfnProgress,
+                                void *pProgressData) override;
+
+    virtual CPLErr XMLInit(CPLXMLNode *, const char *,
+                           std::map<CPLString, GDALDataset *> &) override
+    {
+        return CE_Failure;
+    }
+    virtual CPLXMLNode *SerializeToXML(const char *pszVRTPath) override;
+
+    virtual void GetFileList(char ***ppapszFileList, int *pnSize,
+                             int *pnMaxSize, CPLHashSet *hSetFiles) override;
+    virtual CPLErr FlushCache(bool bAtClosing) override;
+};
+
 /************************************************************************/
 /*                              VRTGroup                                */
 /************************************************************************/
@@ -32,10 +32,13 @@
 #include "cpl_string.h"
 #include "vrtdataset.h"
 #include "cpl_multiproc.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "gdalpython.h"
 
 #include <algorithm>
 #include <map>
+#include <set>
 #include <vector>
 #include <utility>
 
@@ -54,6 +57,15 @@ static std::map<CPLString,
                 std::pair<VRTDerivedRasterBand::PixelFunc, CPLString>>
     osMapPixelFunction;
 
+// Names of the pixel functions that only depend on their inputs and
+// arguments, and can thus be evaluated concurrently on different lines of a
+// request.
+static std::set<CPLString> gosSetThreadSafePixelFunction;
+static bool gbRegisteringThreadSafePixelFunc = false;
+
+// Number of derived bands of this thread currently reading their sources.
+static thread_local int tls_nDerivedBandsReadingSources = 0;
+
 /* Flags for getting buffers */
 #define PyBUF_WRITABLE 0x0001
 #define PyBUF_FORMAT 0x0004
@@ -159,6 +171,7 @@ class VRTDerivedRasterBandPrivateData
     std::vector<std::pair<CPLString, CPLString>> m_oFunctionArgs{};
     bool m_bSkipNonContributingSourcesSpecified = false;
     bool m_bSkipNonContributingSources = false;
+    bool m_bInIReadBlock = false;
 
     VRTDerivedRasterBandPrivateData() = default;
 
@@ -221,6 +234,33 @@ void VRTDerivedRasterBand::Cleanup()
 {
 }
 
+/************************************************************************/
+/*                 VRTSetRegisteringThreadSafePixelFunc()               */
+/************************************************************************/
+
+/** Set whether the next pixel functions registered are thread-safe.
+ *
+ * This is used by GDALRegisterDefaultPixelFunc(). Functions registered while
+ * this is not set, including user functions replacing a built-in one, are
+ * always evaluated in a single call.
+ */
+void VRTSetRegisteringThreadSafePixelFunc(bool bThreadSafe)
+{
+    gbRegisteringThreadSafePixelFunc = bThreadSafe;
+}
+
+/************************************************************************/
+/*                          SetPixelFuncThreadSafe()                    */
+/************************************************************************/
+
+static void SetPixelFuncThreadSafe(const char *pszName)
+{
+    if (gbRegisteringThreadSafePixelFunc)
+        gosSetThreadSafePixelFunction.insert(pszName);
+    else
+        gosSetThreadSafePixelFunction.erase(pszName);
+}
+
 /************************************************************************/
 /*                           AddPixelFunction()                         */
 /************************************************************************/
@@ -263,6 +303,7 @@ CPLErr CPL_STDCALL GDALAddDerivedBandPixelFunc(
                                   nLineSpace);
         },
         ""};
+    SetPixelFuncThreadSafe(pszName);
 
     return CE_None;
 }
@@ -296,6 +337,7 @@ CPLErr CPL_STDCALL GDALAddDerivedBandPixelFuncWithArgs(
 
     osMapPixelFunction[pszName] = {pfnNewFunction,
                                    pszMetadata != nullptr ? pszMetadata : ""};
+    SetPixelFuncThreadSafe(pszName);
 
     return CE_None;
 }
@@ -372,6 +414,8 @@ VRTDerivedRasterBand::GetPixelFunction(const char *pszFuncNameIn)
  */
 void VRTDerivedRasterBand::SetPixelFunctionName(const char *pszFuncNameIn)
 {
+    if (HasBlockCache())
+        FlushCache(false);
     CPLFree(pszFuncName);
     pszFuncName = CPLStrdup(pszFuncNameIn);
 }
@@ -389,6 +433,8 @@ void VRTDerivedRasterBand::SetPixelFunctionName(const char *pszFuncNameIn)
  */
 void VRTDerivedRasterBand::SetPixelFunctionLanguage(const char *pszLanguage)
 {
+    if (HasBlockCache())
+        FlushCache(false);
     m_poPrivate->m_osLanguage = pszLanguage;
 }
 
@@ -409,6 +455,8 @@ void VRTDerivedRasterBand::SetPixelFunctionLanguage(const char *pszLanguage)
  */
 void VRTDerivedRasterBand::SetSourceTransferType(GDALDataType eDataTypeIn)
 {
+    if (HasBlockCache())
+        FlushCache(false);
     eSourceTransferType = eDataTypeIn;
 }
 
@@ -819,6 +867,115 @@ CPLErr VRTDerivedRasterBand::GetPixelFunctionArguments(
     return CE_None;
 }
 
+/************************************************************************/
+/*                        ParallelPixelFuncCall()                       */
+/************************************************************************/
+
+/* Evaluate a thread-safe pixel function on groups of lines of the request,
+ * concurrently in the global thread pool, when the GDAL_NUM_THREADS
+ * configuration option is set and the request is large enough.
+ *
+ * Returns false, without calling the function, if it should rather be
+ * evaluated in a single call.
+ */
+static bool ParallelPixelFuncCall(const VRTDerivedRasterBand::PixelFunc &oFunc,
+                                  void **papoBuffers, int nBuffers,
+                                  void *pData, int nBufXSize, int nBufYSize,
+                                  GDALDataType eSrcType, GDALDataType eBufType,
+                                  int nPixelSpace, int nLineSpace,
+                                  CSLConstList papszArgs, CPLErr &eErr)
+{
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszNumThreads == nullptr)
+        return false;
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+    nThreads = std::min(nThreads, 1024);
+
+    constexpr int MIN_PIXELS_PER_JOB = 64 * 1024;
+    const int nJobs = static_cast<int>(std::min<int64_t>(
+        {nThreads, nBufYSize,
+         static_cast<int64_t>(nBufXSize) * nBufYSize / MIN_PIXELS_PER_JOB}));
+    if (nJobs <= 1)
+        return false;
+
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nJobs);
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    if (poQueue == nullptr)
+        return false;
+
+    struct Job
+    {
+        const VRTDerivedRasterBand::PixelFunc *poFunc = nullptr;
+        std::vector<void *> apBuffers{};
+        void *pData = nullptr;
+        int nBufXSize = 0;
+        int nBufYSize = 0;
+        GDALDataType eSrcType = GDT_Unknown;
+        GDALDataType eBufType = GDT_Unknown;
+        int nPixelSpace = 0;
+        int nLineSpace = 0;
+        CSLConstList papszArgs = nullptr;
+        CPLErr eErr = CE_None;
+    };
+
+    const int nSrcTypeSize = GDALGetDataTypeSizeBytes(eSrcType);
+    std::vector<Job> asJobs(nJobs);
+    for (int i = 0; i < nJobs; ++i)
+    {
+        const int iYStart =
+            static_cast<int>(static_cast<int64_t>(nBufYSize) * i / nJobs);
+        const int iYEnd =
+            static_cast<int>(static_cast<int64_t>(nBufYSize) * (i + 1) / nJobs);
+        auto &sJob = asJobs[i];
+        sJob.poFunc = &oFunc;
+        for (int iBuffer = 0; iBuffer < nBuffers; ++iBuffer)
+        {
+            sJob.apBuffers.push_back(
+                static_cast<GByte *>(papoBuffers[iBuffer]) +
+                static_cast<size_t>(iYStart) * nBufXSize * nSrcTypeSize);
+        }
+        sJob.pData = static_cast<GByte *>(pData) +
+                     static_cast<GSpacing>(iYStart) * nLineSpace;
+        sJob.nBufXSize = nBufXSize;
+        sJob.nBufYSize = iYEnd - iYStart;
+        sJob.eSrcType = eSrcType;
+        sJob.eBufType = eBufType;
+        sJob.nPixelSpace = nPixelSpace;
+        sJob.nLineSpace = nLineSpace;
+        sJob.papszArgs = papszArgs;
+    }
+
+    for (auto &sJob : asJobs)
+    {
+        poQueue->SubmitJob(
+            [](void *pJob)
+            {
+                auto psJob = static_cast<Job *>(pJob);
+                // The function must not wait for the global thread pool
+                // from one of its workers.
+                CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", "1", false);
+                psJob->eErr = (*psJob->poFunc)(
+                    psJob->apBuffers.data(),
+                    static_cast<int>(psJob->apBuffers.size()), psJob->pData,
+                    psJob->nBufXSize, psJob->nBufYSize, psJob->eSrcType,
+                    psJob->eBufType, psJob->nPixelSpace, psJob->nLineSpace,
+                    psJob->papszArgs);
+            },
+            &sJob);
+    }
+    poQueue->WaitCompletion();
+
+    eErr = CE_None;
+    for (const auto &sJob : asJobs)
+    {
+        if (sJob.eErr != CE_None)
+            eErr = sJob.eErr;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                             IRasterIO()                              */
 /************************************************************************/
@@ -888,6 +1045,20 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
         return CE_Failure;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      When this band is read by another derived band, serve the       */
+    /*      request from the block cache, so that a band used by several    */
+    /*      nodes of a derivation graph is only evaluated once per block.   */
+    /* -------------------------------------------------------------------- */
+    if (tls_nDerivedBandsReadingSources > 0 && !m_poPrivate->m_bInIReadBlock &&
+        nXSize == nBufXSize && nYSize == nBufYSize &&
+        CPLTestBool(CPLGetConfigOption("VRT_DERIVED_BAND_BLOCK_CACHE", "YES")))
+    {
+        return GDALRasterBand::IRasterIO(
+            eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+            eBufType, nPixelSpace, nLineSpace, psExtraArg);
+    }
+
     const int nBufTypeSize = GDALGetDataTypeSizeBytes(eBufType);
     GDALDataType eSrcType = eSourceTransferType;
     if (eSrcType == GDT_Unknown || eSrcType >= GDT_TypeCount)
@@ -1125,6 +1296,7 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
 
     // Load values for sources into packed buffers.
     CPLErr eErr = CE_None;
+    ++tls_nDerivedBandsReadingSources;
     for (int iBuffer = 0; iBuffer < nBufferCount && eErr == CE_None; iBuffer++)
     {
         const int iSource = anMapBufferIdxToSourceIdx[iBuffer];
@@ -1186,6 +1358,8 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
         }
     }
 
+    --tls_nDerivedBandsReadingSources;
+
     // Apply pixel function.
     if (eErr == CE_None && EQUAL(m_poPrivate->m_osLanguage, "Python"))
     {
@@ -1346,10 +1520,21 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
             papszArgs = CSLSetNameValue(papszArgs, pszKey, pszValue);
         }
 
-        eErr = (poPixelFunc->first)(
-            static_cast<void **>(pBuffers), nBufferCount, pData, nBufXSize,
-            nBufYSize, eSrcType, eBufType, static_cast<int>(nPixelSpace),
-            static_cast<int>(nLineSpace), papszArgs);
+        // Only split the request when the source buffers have the lines of
+        // the output buffer.
+        if (nBufferRadius != 0 ||
+            gosSetThreadSafePixelFunction.find(pszFuncName) ==
+                gosSetThreadSafePixelFunction.end() ||
+            !ParallelPixelFuncCall(
+                poPixelFunc->first, pBuffers, nBufferCount, pData, nBufXSize,
+                nBufYSize, eSrcType, eBufType, static_cast<int>(nPixelSpace),
+                static_cast<int>(nLineSpace), papszArgs, eErr))
+        {
+            eErr = (poPixelFunc->first)(
+                static_cast<void **>(pBuffers), nBufferCount, pData, nBufXSize,
+                nBufYSize, eSrcType, eBufType, static_cast<int>(nPixelSpace),
+                static_cast<int>(nLineSpace), papszArgs);
+        }
 
         CSLDestroy(papszArgs);
     }
@@ -1364,6 +1549,23 @@ end:
     return eErr;
 }
 
+/************************************************************************/
+/*                             IReadBlock()                             */
+/************************************************************************/
+
+CPLErr VRTDerivedRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff,
+                                        void *pImage)
+{
+    // Compute the block, instead of looking for it in the block cache from
+    // IRasterIO().
+    const bool bInIReadBlockBackup = m_poPrivate->m_bInIReadBlock;
+    m_poPrivate->m_bInIReadBlock = true;
+    const CPLErr eErr =
+        VRTSourcedRasterBand::IReadBlock(nBlockXOff, nBlockYOff, pImage);
+    m_poPrivate->m_bInIReadBlock = bInIReadBlockBackup;
+    return eErr;
+}
+
 /************************************************************************/
 /*                         IGetDataCoverageStatus()                     */
 /************************************************************************/
@@ -0,0 +1,836 @@
+/******************************************************************************
+ *
+ * Project:  Virtual GDAL Datasets
+ * Purpose:  Built-in expression evaluator for VRT derived bands
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, Even Rouault <even dot rouault at spatialys dot org>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "vrtexpression.h"
+
+#include "cpl_conv.h"
+#include "cpl_mem_cache.h"
+#include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_priv.h"
+#include "gdal_thread_pool.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+/*! @cond Doxygen_Suppress */
+
+namespace
+{
+
+/************************************************************************/
+/*                          Function table                              */
+/************************************************************************/
+
+struct VRTExpressionFunc
+{
+    const char *pszName;
+    int nArgs;  // -1 for variadic functions with at least 2 arguments
+    double (*pfn1)(double);
+    double (*pfn2)(double, double);
+};
+
+const VRTExpressionFunc asFuncs[] = {
+    {"abs", 1, [](double x) { return std::fabs(x); }, nullptr},
+    {"sqrt", 1, [](double x) { return std::sqrt(x); }, nullptr},
+    {"exp", 1, [](double x) { return std::exp(x); }, nullptr},
+    {"log", 1, [](double x) { return std::log(x); }, nullptr},
+    {"log10", 1, [](double x) { return std::log10(x); }, nullptr},
+    {"sin", 1, [](double x) { return std::sin(x); }, nullptr},
+    {"cos", 1, [](double x) { return std::cos(x); }, nullptr},
+    {"tan", 1, [](double x) { return std::tan(x); }, nullptr},
+    {"asin", 1, [](double x) { return std::asin(x); }, nullptr},
+    {"acos", 1, [](double x) { return std::acos(x); }, nullptr},
+    {"atan", 1, [](double x) { return std::atan(x); }, nullptr},
+    {"floor", 1, [](double x) { return std::floor(x); }, nullptr},
+    {"ceil", 1, [](double x) { return std::ceil(x); }, nullptr},
+    {"round", 1, [](double x) { return std::round(x); }, nullptr},
+    {"isnan", 1, [](double x) { return std::isnan(x) ? 1.0 : 0.0; }, nullptr},
+    {"atan2", 2, nullptr, [](double y, double x) { return std::atan2(y, x); }},
+    {"pow", 2, nullptr, [](double x, double y) { return std::pow(x, y); }},
+    {"hypot", 2, nullptr, [](double x, double y) { return std::hypot(x, y); }},
+    {"min", -1, nullptr, [](double x, double y) { return std::fmin(x, y); }},
+    {"max", -1, nullptr, [](double x, double y) { return std::fmax(x, y); }},
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                          ApplyInstr()                                */
+/************************************************************************/
+
+// Apply a non-leaf instruction on the top items of a stack whose slots are
+// nCount-value arrays, nDepth being the number of items before the call.
+static void ApplyInstr(const VRTExpression::Instr &oInstr, double *padfStack,
+                       int nDepth, int nCount)
+{
+    using Op = VRTExpression::Op;
+    double *const a = padfStack + static_cast<size_t>(nDepth - 1) * nCount;
+
+    switch (oInstr.eOp)
+    {
+        case Op::CONST:
+        case Op::VAR:
+            CPLAssert(false);
+            break;
+
+        case Op::NEG:
+            for (int i = 0; i < nCount; ++i)
+                a[i] = -a[i];
+            return;
+
+        case Op::NOT:
+            for (int i = 0; i < nCount; ++i)
+                a[i] = a[i] == 0 ? 1.0 : 0.0;
+            return;
+
+        case Op::FUNC1:
+        {
+            const auto pfn = asFuncs[oInstr.nArg].pfn1;
+            for (int i = 0; i < nCount; ++i)
+                a[i] = pfn(a[i]);
+            return;
+        }
+
+        default:
+            break;
+    }
+
+    // Binary operators: x is the left operand and receives the result.
+    double *const x = a - nCount;
+    const double *const y = a;
+    switch (oInstr.eOp)
+    {
+        case Op::ADD:
+            for (int i = 0; i < nCount; ++i)
+                x[i] += y[i];
+            break;
+        case Op::SUB:
+            for (int i = 0; i < nCount; ++i)
+                x[i] -= y[i];
+            break;
+        case Op::MUL:
+            for (int i = 0; i < nCount; ++i)
+                x[i] *= y[i];
+            break;
+        case Op::DIV:
+            for (int i = 0; i < nCount; ++i)
+                x[i] /= y[i];
+            break;
+        case Op::MOD:
+            for (int i = 0; i < nCount; ++i)
+                x[i] = std::fmod(x[i], y[i]);
+            break;
+        case Op::POW:
+            for (int i = 0; i < nCount; ++i)
+                x[i] = std::pow(x[i], y[i]);
+            break;
+        case Op::LT:
+            for (int i = 0; i < nCount; ++i)
+                x[i] = x[i] < y[i] ? 1.0 : 0.0;
+            break;
+        case Op::LE:
+            for (int i = 0; i < nCount; ++i)
+                x[i] = x[i] <= y[i] ? 1.0 : 0.0;
+            break;
+        case Op::GT:
+            for (int i = 0; i < nCount; ++i)
+                x[i] = x[i] > y[i] ? 1.0 : 0.0;
+            break;
+        case Op::GE:
+            for (int i = 0; i < nCount; ++i)
+                x[i] = x[i] >= y[i] ? 1.0 : 0.0;
+            break;
+        case Op::EQ:
+            for (int i = 0; i < nCount; ++i)
+                x[i] = x[i] == y[i] ? 1.0 : 0.0;
+            break;
+        case Op::NE:
+            for (int i = 0; i < nCount; ++i)
+                x[i] = x[i] != y[i] ? 1.0 : 0.0;
+            break;
+        case Op::AND:
+            for (int i = 0; i < nCount; ++i)
+                x[i] = (x[i] != 0 && y[i] != 0) ? 1.0 : 0.0;
+            break;
+        case Op::OR:
+            for (int i = 0; i < nCount; ++i)
+                x[i] = (x[i] != 0 || y[i] != 0) ? 1.0 : 0.0;
+            break;
+        case Op::FUNC2:
+        {
+            const auto pfn = asFuncs[oInstr.nArg].pfn2;
+            for (int i = 0; i < nCount; ++i)
+                x[i] = pfn(x[i], y[i]);
+            break;
+        }
+        case Op::COND:
+        {
+            // c ? x : y
+            double *const c = x - nCount;
+            for (int i = 0; i < nCount; ++i)
+                c[i] = c[i] != 0 ? x[i] : y[i];
+            break;
+        }
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+/************************************************************************/
+/*                        VRTExpressionParser                           */
+/************************************************************************/
+
+// Recursive descent parser emitting the instructions in postfix order.
+// Operators, by increasing precedence:
+//   ?:   ||   &&   == !=   < <= > >=   + -   * / %   unary - + !   ^
+class VRTExpressionParser
+{
+    const char *const m_pszStart;
+    const char *m_p;
+    std::vector<VRTExpression::Instr> &m_aoInstrs;
+    std::string m_osError{};
+    int m_nMaxSourceIndex = -1;
+    int m_nNesting = 0;
+
+    CPL_DISALLOW_COPY_ASSIGN(VRTExpressionParser)
+
+    bool Error(const char *pszMsg)
+    {
+        if (m_osError.empty())
+        {
+            m_osError = CPLSPrintf("%s at offset %d", pszMsg,
+                                   static_cast<int>(m_p - m_pszStart));
+        }
+        return false;
+    }
+
+    void SkipSpaces()
+    {
+        while (isspace(static_cast<unsigned char>(*m_p)))
+            ++m_p;
+    }
+
+    bool Accept(const char *pszToken)
+    {
+        SkipSpaces();
+        const size_t nLen = strlen(pszToken);
+        if (strncmp(m_p, pszToken, nLen) != 0)
+            return false;
+        // Do not take "<" from "<=", "!" from "!=", etc.
+        if (nLen == 1 && m_p[1] == '=' && strchr("<>!=", pszToken[0]))
+            return false;
+        m_p += nLen;
+        return true;
+    }
+
+    void Emit(VRTExpression::Op eOp, int nArg = 0);
+
+    bool ParseTernary();
+    bool ParseBinary(int nLevel);
+    bool ParseUnary();
+    bool ParseUnaryInternal();
+    bool ParsePower();
+    bool ParsePrimary();
+
+  public:
+    VRTExpressionParser(const char *pszExpr,
+                        std::vector<VRTExpression::Instr> &aoInstrs)
+        : m_pszStart(pszExpr), m_p(pszExpr), m_aoInstrs(aoInstrs)
+    {
+    }
+
+    bool Parse()
+    {
+        if (!ParseTernary())
+            return false;
+        SkipSpaces();
+        if (*m_p != '\0')
+            return Error("Unexpected character");
+        return true;
+    }
+
+    const std::string &GetError() const
+    {
+        return m_osError;
+    }
+
+    int GetMaxSourceIndex() const
+    {
+        return m_nMaxSourceIndex;
+    }
+};
+
+/************************************************************************/
+/*                               Emit()                                 */
+/************************************************************************/
+
+// Append an instruction, folding it with its operands when they are all
+// constants.
+void VRTExpressionParser::Emit(VRTExpression::Op eOp, int nArg)
+{
+    using Op = VRTExpression::Op;
+    int nOperands = 2;
+    if (eOp == Op::NEG || eOp == Op::NOT || eOp == Op::FUNC1)
+        nOperands = 1;
+    else if (eOp == Op::COND)
+        nOperands = 3;
+
+    VRTExpression::Instr oInstr;
+    oInstr.eOp = eOp;
+    oInstr.nArg = nArg;
+
+    const int nSize = static_cast<int>(m_aoInstrs.size());
+    bool bAllConst = nSize >= nOperands;
+    for (int i = nSize - nOperands; bAllConst && i < nSize; ++i)
+        bAllConst = m_aoInstrs[i].eOp == Op::CONST;
+    if (!bAllConst)
+    {
+        m_aoInstrs.push_back(oInstr);
+        return;
+    }
+
+    double adfStack[3];
+    for (int i = 0; i < nOperands; ++i)
+        adfStack[i] = m_aoInstrs[nSize - nOperands + i].dfValue;
+    ApplyInstr(oInstr, adfStack, nOperands, 1);
+    m_aoInstrs.resize(nSize - nOperands + 1);
+    m_aoInstrs.back().dfValue = adfStack[0];
+}
+
+/************************************************************************/
+/*                           ParseTernary()                             */
+/************************************************************************/
+
+bool VRTExpressionParser::ParseTernary()
+{
+    if (!ParseBinary(0))
+        return false;
+    if (Accept("?"))
+    {
+        if (!ParseTernary())
+            return false;
+        if (!Accept(":"))
+            return Error("Expected ':'");
+        if (!ParseTernary())
+            return false;
+        Emit(VRTExpression::Op::COND);
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                            ParseBinary()                             */
+/************************************************************************/
+
+bool VRTExpressionParser::ParseBinary(int nLevel)
+{
+    using Op = VRTExpression::Op;
+    struct Operator
+    {
+        const char *pszToken;
+        Op eOp;
+    };
+
+    static const std::vector<std::vector<Operator>> aaoLevels = {
+        {{"||", Op::OR}},
+        {{"&&", Op::AND}},
+        {{"==", Op::EQ}, {"!=", Op::NE}},
+        {{"<=", Op::LE}, {">=", Op::GE}, {"<", Op::LT}, {">", Op::GT}},
+        {{"+", Op::ADD}, {"-", Op::SUB}},
+        {{"*", Op::MUL}, {"/", Op::DIV}, {"%", Op::MOD}},
+    };
+
+    if (nLevel == static_cast<int>(aaoLevels.size()))
+        return ParseUnary();
+
+    if (!ParseBinary(nLevel + 1))
+        return false;
+    while (true)
+    {
+        const Operator *poOperator = nullptr;
+        for (const auto &oOperator : aaoLevels[nLevel])
+        {
+            if (Accept(oOperator.pszToken))
+            {
+                poOperator = &oOperator;
+                break;
+            }
+        }
+        if (!poOperator)
+            return true;
+        if (!ParseBinary(nLevel + 1))
+            return false;
+        Emit(poOperator->eOp);
+    }
+}
+
+/************************************************************************/
+/*                            ParseUnary()                              */
+/************************************************************************/
+
+// All recursions of the parser go through this method, which is where
+// pathological nesting is rejected before it overflows the stack.
+bool VRTExpressionParser::ParseUnary()
+{
+    if (++m_nNesting > 256)
+        return Error("Expression too deeply nested");
+    const bool bRet = ParseUnaryInternal();
+    --m_nNesting;
+    return bRet;
+}
+
+bool VRTExpressionParser::ParseUnaryInternal()
+{
+    if (Accept("-"))
+    {
+        if (!ParseUnary())
+            return false;
+        Emit(VRTExpression::Op::NEG);
+        return true;
+    }
+    if (Accept("+"))
+        return ParseUnary();
+    if (Accept("!"))
+    {
+        if (!ParseUnary())
+            return false;
+        Emit(VRTExpression::Op::NOT);
+        return true;
+    }
+    return ParsePower();
+}
+
+/************************************************************************/
+/*                            ParsePower()                              */
+/************************************************************************/
+
+// ^ is right associative and binds tighter than unary minus on its left:
+// -2^2 is -4, and 2^-1 is 0.5.
+bool VRTExpressionParser::ParsePower()
+{
+    if (!ParsePrimary())
+        return false;
+    if (Accept("^"))
+    {
+        if (!ParseUnary())
+            return false;
+        Emit(VRTExpression::Op::POW);
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                           ParsePrimary()                             */
+/************************************************************************/
+
+bool VRTExpressionParser::ParsePrimary()
+{
+    SkipSpaces();
+    if (Accept("("))
+    {
+        if (!ParseTernary())
+            return false;
+        if (!Accept(")"))
+            return Error("Expected ')'");
+        return true;
+    }
+
+    if (isdigit(static_cast<unsigned char>(*m_p)) ||
+        (*m_p == '.' && isdigit(static_cast<unsigned char>(m_p[1]))))
+    {
+        char *pszEnd = nullptr;
+        VRTExpression::Instr oInstr;
+        oInstr.dfValue = CPLStrtod(m_p, &pszEnd);
+        m_p = pszEnd;
+        m_aoInstrs.push_back(oInstr);
+        return true;
+    }
+
+    if (!isalpha(static_cast<unsigned char>(*m_p)) && *m_p != '_')
+        return Error(*m_p ? "Unexpected character" : "Unexpected end");
+
+    const char *pszIdentStart = m_p;
+    while (isalnum(static_cast<unsigned char>(*m_p)) || *m_p == '_')
+        ++m_p;
+    const std::string osIdent(pszIdentStart, m_p - pszIdentStart);
+
+    // Band variables: B1, B2, ...
+    if (osIdent.size() >= 2 && osIdent[0] == 'B' &&
+        std::all_of(osIdent.begin() + 1, osIdent.end(),
+                    [](char ch)
+                    { return isdigit(static_cast<unsigned char>(ch)); }))
+    {
+        const int nBand = atoi(osIdent.c_str() + 1);
+        if (nBand < 1 || osIdent.size() > 6)
+        {
+            m_p = pszIdentStart;
+            return Error("Invalid band variable");
+        }
+        VRTExpression::Instr oInstr;
+        oInstr.eOp = VRTExpression::Op::VAR;
+        oInstr.nArg = nBand - 1;
+        m_nMaxSourceIndex = std::max(m_nMaxSourceIndex, oInstr.nArg);
+        m_aoInstrs.push_back(oInstr);
+        return true;
+    }
+
+    if (osIdent == "pi" || osIdent == "nan")
+    {
+        VRTExpression::Instr oInstr;
+        oInstr.dfValue = osIdent == "pi"
+                             ? M_PI
+                             : std::numeric_limits<double>::quiet_NaN();
+        m_aoInstrs.push_back(oInstr);
+        return true;
+    }
+
+    int iFunc = 0;
+    for (const auto &sFunc : asFuncs)
+    {
+        if (osIdent == sFunc.pszName)
+            break;
+        ++iFunc;
+    }
+    if (iFunc == static_cast<int>(CPL_ARRAYSIZE(asFuncs)))
+    {
+        m_p = pszIdentStart;
+        return Error("Unknown identifier");
+    }
+
+    if (!Accept("("))
+        return Error("Expected '('");
+    const auto &sFunc = asFuncs[iFunc];
+    int nArgs = 0;
+    if (!Accept(")"))
+    {
+        do
+        {
+            if (!ParseTernary())
+                return false;
+            ++nArgs;
+            // Variadic functions are applied as a chain of binary ones.
+            if (sFunc.nArgs < 0 && nArgs >= 2)
+                Emit(VRTExpression::Op::FUNC2, iFunc);
+        } while (Accept(","));
+        if (!Accept(")"))
+            return Error("Expected ')'");
+    }
+    if ((sFunc.nArgs >= 0 && nArgs != sFunc.nArgs) ||
+        (sFunc.nArgs < 0 && nArgs < 2))
+    {
+        return Error(
+            (std::string("Wrong number of arguments for ") + sFunc.pszName +
+             "()")
+                .c_str());
+    }
+    if (sFunc.nArgs == 1)
+        Emit(VRTExpression::Op::FUNC1, iFunc);
+    else if (sFunc.nArgs == 2)
+        Emit(VRTExpression::Op::FUNC2, iFunc);
+    return true;
+}
+
+/************************************************************************/
+/*                       VRTExpression::Compile()                       */
+/************************************************************************/
+
+/** Compile an expression.
+ *
+ * @return the compiled expression, or nullptr in case of syntax error, in
+ * which case osError is set.
+ */
+std::shared_ptr<const VRTExpression>
+VRTExpression::Compile(const char *pszExpr, std::string &osError)
+{
+    auto poExpr = std::make_shared<VRTExpression>();
+    VRTExpressionParser oParser(pszExpr, poExpr->m_aoInstrs);
+    if (!oParser.Parse())
+    {
+        osError = oParser.GetError();
+        return nullptr;
+    }
+    poExpr->m_nMaxSourceIndex = oParser.GetMaxSourceIndex();
+
+    int nDepth = 0;
+    for (const auto &oInstr : poExpr->m_aoInstrs)
+    {
+        switch (oInstr.eOp)
+        {
+            case Op::CONST:
+            case Op::VAR:
+                ++nDepth;
+                break;
+            case Op::NEG:
+            case Op::NOT:
+            case Op::FUNC1:
+                break;
+            case Op::COND:
+                nDepth -= 2;
+                break;
+            default:
+                --nDepth;
+                break;
+        }
+        poExpr->m_nMaxStackDepth = std::max(poExpr->m_nMaxStackDepth, nDepth);
+    }
+    CPLAssert(nDepth == 1);
+    return poExpr;
+}
+
+/************************************************************************/
+/*                      VRTExpression::Evaluate()                       */
+/************************************************************************/
+
+void VRTExpression::Evaluate(const void *const *papoSources,
+                             GDALDataType eSrcType, size_t nSrcOffset,
+                             int nCount, double *padfWork) const
+{
+    const int nDTSize = GDALGetDataTypeSizeBytes(eSrcType);
+    int nDepth = 0;
+    for (const auto &oInstr : m_aoInstrs)
+    {
+        double *const padfSlot =
+            padfWork + static_cast<size_t>(nDepth) * nCount;
+        if (oInstr.eOp == Op::CONST)
+        {
+            std::fill_n(padfSlot, nCount, oInstr.dfValue);
+            ++nDepth;
+        }
+        else if (oInstr.eOp == Op::VAR)
+        {
+            GDALCopyWords64(static_cast<const GByte *>(
+                                papoSources[oInstr.nArg]) +
+                                nSrcOffset * nDTSize,
+                            eSrcType, nDTSize, padfSlot, GDT_Float64,
+                            static_cast<int>(sizeof(double)), nCount);
+            ++nDepth;
+        }
+        else
+        {
+            ApplyInstr(oInstr, padfWork, nDepth, nCount);
+            if (oInstr.eOp == Op::COND)
+                nDepth -= 2;
+            else if (oInstr.eOp != Op::NEG && oInstr.eOp != Op::NOT &&
+                     oInstr.eOp != Op::FUNC1)
+                --nDepth;
+        }
+    }
+}
+
+/************************************************************************/
+/*                       VRTExpressionPixelFunc()                       */
+/************************************************************************/
+
+const char pszVRTExpressionPixelFuncMetadata[] =
+    "<PixelFunctionArgumentsList>"
+    "   <Argument name='expression' description='Expression to evaluate, "
+    "where B1, B2, ... are the values of the sources' type='string' "
+    "mandatory='1' />"
+    "</PixelFunctionArgumentsList>";
+
+namespace
+{
+struct VRTExpressionJob
+{
+    const VRTExpression *poExpr = nullptr;
+    const void *const *papoSources = nullptr;
+    GDALDataType eSrcType = GDT_Unknown;
+    GByte *pabyData = nullptr;
+    GDALDataType eBufType = GDT_Unknown;
+    int nPixelSpace = 0;
+    int nLineSpace = 0;
+    int nXSize = 0;
+    int iYStart = 0;
+    int iYEnd = 0;
+    int nChunkSize = 0;
+    std::vector<double> adfWork{};
+};
+}  // namespace
+
+static void EvaluateLines(void *pData)
+{
+    auto psJob = static_cast<VRTExpressionJob *>(pData);
+    for (int iLine = psJob->iYStart; iLine < psJob->iYEnd; ++iLine)
+    {
+        for (int iCol = 0; iCol < psJob->nXSize; iCol += psJob->nChunkSize)
+        {
+            const int nCount =
+                std::min(psJob->nChunkSize, psJob->nXSize - iCol);
+            psJob->poExpr->Evaluate(
+                psJob->papoSources, psJob->eSrcType,
+                static_cast<size_t>(iLine) * psJob->nXSize + iCol, nCount,
+                psJob->adfWork.data());
+            GDALCopyWords64(psJob->adfWork.data(), GDT_Float64,
+                            static_cast<int>(sizeof(double)),
+                            psJob->pabyData +
+                                static_cast<GSpacing>(psJob->nLineSpace) *
+                                    iLine +
+                                static_cast<GSpacing>(iCol) *
+                                    psJob->nPixelSpace,
+                            psJob->eBufType, psJob->nPixelSpace, nCount);
+        }
+    }
+}
+
+/** Pixel function evaluating the "expression" argument, where B1, B2, ...
+ * are the values of the sources.
+ *
+ * Expressions are compiled once and kept in a cache, and evaluated on
+ * arrays of pixels. Large requests are split in bands of lines evaluated in
+ * the global thread pool when the GDAL_NUM_THREADS configuration option is
+ * set.
+ */
+CPLErr VRTExpressionPixelFunc(void **papoSources, int nSources, void *pData,
+                              int nXSize, int nYSize, GDALDataType eSrcType,
+                              GDALDataType eBufType, int nPixelSpace,
+                              int nLineSpace, CSLConstList papszArgs)
+{
+    if (GDALDataTypeIsComplex(eSrcType))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "expression cannot by applied to complex data types");
+        return CE_Failure;
+    }
+
+    const char *pszExpr = CSLFetchNameValue(papszArgs, "expression");
+    if (pszExpr == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Missing pixel function argument: expression");
+        return CE_Failure;
+    }
+
+    static lru11::Cache<std::string, std::shared_ptr<const VRTExpression>,
+                        std::mutex>
+        goCache(64);
+    std::shared_ptr<const VRTExpression> poExpr;
+    if (!goCache.tryGet(pszExpr, poExpr))
+    {
+        std::string osError;
+        poExpr = VRTExpression::Compile(pszExpr, osError);
+        if (!poExpr)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Invalid expression '%s': %s",
+                     pszExpr, osError.c_str());
+            return CE_Failure;
+        }
+        goCache.insert(pszExpr, poExpr);
+    }
+
+    if (poExpr->GetMaxSourceIndex() >= nSources)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Expression '%s' references B%d, but there are only %d "
+                 "sources",
+                 pszExpr, poExpr->GetMaxSourceIndex() + 1, nSources);
+        return CE_Failure;
+    }
+    if (nXSize <= 0 || nYSize <= 0)
+        return CE_None;
+
+    constexpr int CHUNK_SIZE = 256;
+    constexpr int MIN_PIXELS_PER_JOB = 64 * 1024;
+
+    int nJobs = 1;
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszNumThreads)
+    {
+        int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                        : atoi(pszNumThreads);
+        nThreads = std::min(nThreads, 1024);
+        const int64_t nMaxJobs =
+            static_cast<int64_t>(nXSize) * nYSize / MIN_PIXELS_PER_JOB;
+        nJobs = static_cast<int>(std::max<int64_t>(
+            1, std::min<int64_t>({nThreads, nMaxJobs, nYSize})));
+    }
+
+    std::vector<VRTExpressionJob> asJobs;
+    try
+    {
+        asJobs.resize(nJobs);
+        for (int i = 0; i < nJobs; ++i)
+        {
+            auto &sJob = asJobs[i];
+            sJob.poExpr = poExpr.get();
+            sJob.papoSources = papoSources;
+            sJob.eSrcType = eSrcType;
+            sJob.pabyData = static_cast<GByte *>(pData);
+            sJob.eBufType = eBufType;
+            sJob.nPixelSpace = nPixelSpace;
+            sJob.nLineSpace = nLineSpace;
+            sJob.nXSize = nXSize;
+            sJob.iYStart = static_cast<int>(static_cast<int64_t>(nYSize) * i /
+                                            nJobs);
+            sJob.iYEnd = static_cast<int>(static_cast<int64_t>(nYSize) *
+                                          (i + 1) / nJobs);
+            sJob.nChunkSize = std::min(nXSize, CHUNK_SIZE);
+            sJob.adfWork.resize(poExpr->GetWorkBufferSize(sJob.nChunkSize));
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in expression pixel function");
+        return CE_Failure;
+    }
+
+    std::unique_ptr<CPLJobQueue> poQueue;
+    if (nJobs > 1)
+    {
+        CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nJobs);
+        if (poPool)
+            poQueue = poPool->CreateJobQueue();
+    }
+    if (poQueue)
+    {
+        for (auto &sJob : asJobs)
+        {
+            if (!poQueue->SubmitJob(EvaluateLines, &sJob))
+            {
+                // Evaluate in this thread what could not be submitted.
+                EvaluateLines(&sJob);
+            }
+        }
+        poQueue->WaitCompletion();
+    }
+    else
+    {
+        for (auto &sJob : asJobs)
+            EvaluateLines(&sJob);
+    }
+
+    return CE_None;
+}
+
+/*! @endcond */
@@ -0,0 +1,123 @@
+/******************************************************************************
+ *
+ * Project:  Virtual GDAL Datasets
+ * Purpose:  Built-in expression evaluator for VRT derived bands
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, Even Rouault <even dot rouault at spatialys dot org>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef VRTEXPRESSION_H_INCLUDED
+#define VRTEXPRESSION_H_INCLUDED
+
+#ifndef DOXYGEN_SKIP
+
+#include "gdal.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/************************************************************************/
+/*                            VRTExpression                             */
+/************************************************************************/
+
+/** Arithmetic expression compiled to a stack program, evaluated over
+ * arrays of pixels.
+ *
+ * Instances are immutable once compiled, so a single one can be evaluated
+ * concurrently from several threads.
+ */
+class VRTExpression
+{
+  public:
+    enum class Op
+    {
+        CONST,
+        VAR,
+        NEG,
+        NOT,
+        ADD,
+        SUB,
+        MUL,
+        DIV,
+        MOD,
+        POW,
+        LT,
+        LE,
+        GT,
+        GE,
+        EQ,
+        NE,
+        AND,
+        OR,
+        COND,
+        FUNC1,
+        FUNC2,
+    };
+
+    struct Instr
+    {
+        Op eOp = Op::CONST;
+        int nArg = 0;  // source index for VAR, function index for FUNC1/2
+        double dfValue = 0;
+    };
+
+    static std::shared_ptr<const VRTExpression> Compile(const char *pszExpr,
+                                                        std::string &osError);
+
+    /** Maximum 0-based source index referenced, or -1 */
+    int GetMaxSourceIndex() const
+    {
+        return m_nMaxSourceIndex;
+    }
+
+    /** Evaluate the expression on nCount pixels starting at nSrcOffset in
+     * each source. The result is in the first nCount values of padfWork,
+     * which must hold GetWorkBufferSize(nCount) values. */
+    void Evaluate(const void *const *papoSources, GDALDataType eSrcType,
+                  size_t nSrcOffset, int nCount, double *padfWork) const;
+
+    /** Number of doubles of the work buffer needed to evaluate nCount
+     * pixels at a time */
+    size_t GetWorkBufferSize(int nCount) const
+    {
+        return static_cast<size_t>(m_nMaxStackDepth) * nCount;
+    }
+
+  private:
+    friend class VRTExpressionParser;
+
+    std::vector<Instr> m_aoInstrs{};
+    int m_nMaxStackDepth = 0;
+    int m_nMaxSourceIndex = -1;
+};
+
+CPLErr VRTExpressionPixelFunc(void **papoSources, int nSources, void *pData,
+                              int nXSize, int nYSize, GDALDataType eSrcType,
+                              GDALDataType eBufType, int nPixelSpace,
+                              int nLineSpace, CSLConstList papszArgs);
+
+extern const char pszVRTExpressionPixelFuncMetadata[];
+
+#endif /* #ifndef DOXYGEN_SKIP */
+
+#endif /* VRTEXPRESSION_H_INCLUDED */
@@ -1472,9 +1472,8 @@ CPLErr VRTPansharpenedDataset::IRasterIO(
     }
 
     const int nDataTypeSize = GDALGetDataTypeSizeBytes(eBufType);
-    if (nXSize == nBufXSize && nYSize == nBufYSize &&
-        nDataTypeSize == nPixelSpace && nLineSpace == nPixelSpace * nBufXSize &&
-        nBandSpace == nLineSpace * nBufYSize && nBandCount == nBands)
+    if (nXSize == nBufXSize && nYSize == nBufYSize && nDataTypeSize > 0 &&
+        nBandCount == nBands)
     {
         for (int i = 0; i < nBands; i++)
         {
@@ -1486,9 +1485,51 @@ CPLErr VRTPansharpenedDataset::IRasterIO(
             }
         }
 
-        //{static int bDone = 0; if (!bDone) printf("(2)\n"); bDone = 1; }
-        return m_poPansharpener->ProcessRegion(nXOff, nYOff, nXSize, nYSize,
-                                               pData, eBufType);
+        if (nDataTypeSize == nPixelSpace &&
+            nLineSpace == nPixelSpace * nBufXSize &&
+            nBandSpace == nLineSpace * nBufYSize)
+        {
+            //{static int bDone = 0; if (!bDone) printf("(2)\n"); bDone = 1; }
+            return m_poPansharpener->ProcessRegion(nXOff, nYOff, nXSize,
+                                                   nYSize, pData, eBufType);
+        }
+
+        // Other buffer layouts, typically pixel-interleaved: process the
+        // whole region at once in a temporary buffer, so that the
+        // pansharpening operation can split it among its threads, instead of
+        // going through the per-band and per-block default path.
+        const size_t nValuesPerBand = static_cast<size_t>(nXSize) * nYSize;
+        if (static_cast<double>(nValuesPerBand) * nBands * nDataTypeSize >
+            static_cast<double>(GDALGetCacheMax64()))
+        {
+            goto default_path;
+        }
+        GByte *pabyTemp = static_cast<GByte *>(
+            VSI_MALLOC3_VERBOSE(nValuesPerBand, nBands, nDataTypeSize));
+        if (pabyTemp == nullptr)
+            return CE_Failure;
+        const CPLErr eErr = m_poPansharpener->ProcessRegion(
+            nXOff, nYOff, nXSize, nYSize, pabyTemp, eBufType);
+        if (eErr == CE_None)
+        {
+            for (int i = 0; i < nBands; i++)
+            {
+                const GByte *pabySrcBand =
+                    pabyTemp + i * nValuesPerBand * nDataTypeSize;
+                GByte *pabyDstBand =
+                    static_cast<GByte *>(pData) + i * nBandSpace;
+                for (int iY = 0; iY < nYSize; iY++)
+                {
+                    GDALCopyWords(pabySrcBand + static_cast<size_t>(iY) *
+                                                    nXSize * nDataTypeSize,
+                                  eBufType, nDataTypeSize,
+                                  pabyDstBand + iY * nLineSpace, eBufType,
+                                  static_cast<int>(nPixelSpace), nXSize);
+                }
+            }
+        }
+        VSIFree(pabyTemp);
+        return eErr;
     }
 
 default_path:
@@ -32,6 +32,7 @@
 #include "vrtdataset.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -39,9 +40,11 @@
 #include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <map>
 #include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -351,23 +354,53 @@ CPLErr VRTSourcedRasterBand::IRasterIO(
         }
     }
 
+    std::vector<int> anSources;
+    if (psExtraArg->bFloatingPointWindowValidity)
+    {
+        GetSourcesInWindow(psExtraArg->dfXOff, psExtraArg->dfYOff,
+                           psExtraArg->dfXSize, psExtraArg->dfYSize, anSources);
+    }
+    else
+    {
+        GetSourcesInWindow(nXOff, nYOff, nXSize, nYSize, anSources);
+    }
+
+    if (psExtraArg->bFloatingPointWindowValidity)
+    {
+        PrefetchSourceHeaders(anSources, psExtraArg->dfXOff,
+                              psExtraArg->dfYOff, psExtraArg->dfXSize,
+                              psExtraArg->dfYSize);
+    }
+    else
+    {
+        PrefetchSourceHeaders(anSources, nXOff, nYOff, nXSize, nYSize);
+    }
+
+    CPLErr eErr = CE_None;
+    if (ParallelSourcesRasterIO(anSources, nXOff, nYOff, nXSize, nYSize, pData,
+                                nBufXSize, nBufYSize, eBufType, nPixelSpace,
+                                nLineSpace, psExtraArg, eErr))
+    {
+        return eErr;
+    }
+
     GDALProgressFunc const pfnProgressGlobal = psExtraArg->pfnProgress;
     void *const pProgressDataGlobal = psExtraArg->pProgressData;
 
     /* -------------------------------------------------------------------- */
     /*      Overlay each source in turn over top this.                      */
     /* -------------------------------------------------------------------- */
-    CPLErr eErr = CE_None;
-    for (int iSource = 0; eErr == CE_None && iSource < nSources; iSource++)
+    const int nCandidates = static_cast<int>(anSources.size());
+    for (int i = 0; eErr == CE_None && i < nCandidates; i++)
     {
         psExtraArg->pfnProgress = GDALScaledProgress;
         psExtraArg->pProgressData = GDALCreateScaledProgress(
-            1.0 * iSource / nSources, 1.0 * (iSource + 1) / nSources,
+            1.0 * i / nCandidates, 1.0 * (i + 1) / nCandidates,
             pfnProgressGlobal, pProgressDataGlobal);
         if (psExtraArg->pProgressData == nullptr)
             psExtraArg->pfnProgress = nullptr;
 
-        eErr = papoSources[iSource]->RasterIO(
+        eErr = papoSources[anSources[i]]->RasterIO(
             eDataType, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize,
             nBufYSize, eBufType, nPixelSpace, nLineSpace, psExtraArg);
 
@@ -380,6 +413,544 @@ CPLErr VRTSourcedRasterBand::IRasterIO(
     return eErr;
 }
 
+/************************************************************************/
+/*                       InvalidateSourceIndex()                        */
+/************************************************************************/
+
+void VRTSourcedRasterBand::InvalidateSourceIndex()
+{
+    if (m_hSourceQuadTree)
+        CPLQuadTreeDestroy(m_hSourceQuadTree);
+    m_hSourceQuadTree = nullptr;
+    m_papoIndexedSources = nullptr;
+    m_nIndexedSources = 0;
+    m_anUnboundedSources.clear();
+}
+
+/************************************************************************/
+/*                        GetSourcesInWindow()                          */
+/************************************************************************/
+
+/** Return the indices, in increasing order, of the sources whose destination
+ * window may intersect the specified window of the band.
+ *
+ * For bands with many sources, the sources are looked up in a quad tree of
+ * their destination windows, built at first use. The returned list may
+ * contain sources that do not actually contribute to the window.
+ *
+ * The returned sources that were attached from a source index sidecar are
+ * instantiated.
+ */
+void VRTSourcedRasterBand::GetSourcesInWindow(double dfXOff, double dfYOff,
+                                              double dfXSize, double dfYSize,
+                                              std::vector<int> &anSources)
+{
+    anSources.clear();
+
+    // Below that, testing each source is cheap enough.
+    constexpr int MIN_SOURCES_FOR_INDEX = 128;
+    if (nSources < MIN_SOURCES_FOR_INDEX)
+    {
+        anSources.reserve(nSources);
+        for (int i = 0; i < nSources; ++i)
+            anSources.push_back(i);
+        MaterializeLazySources(anSources);
+        return;
+    }
+
+    if (m_hSourceQuadTree == nullptr || m_papoIndexedSources != papoSources ||
+        m_nIndexedSources != nSources)
+    {
+        InvalidateSourceIndex();
+
+        CPLRectObj sGlobalBounds;
+        sGlobalBounds.minx = 0;
+        sGlobalBounds.miny = 0;
+        sGlobalBounds.maxx = nRasterXSize;
+        sGlobalBounds.maxy = nRasterYSize;
+        m_hSourceQuadTree = CPLQuadTreeCreate(&sGlobalBounds, nullptr);
+        for (int i = 0; i < nSources; ++i)
+        {
+            double dfDstXOff = -1;
+            double dfDstYOff = -1;
+            double dfDstXSize = -1;
+            double dfDstYSize = -1;
+            if (papoSources[i]->IsSimpleSource())
+            {
+                const auto poSS =
+                    cpl::down_cast<VRTSimpleSource *>(papoSources[i]);
+                dfDstXOff = poSS->m_dfDstXOff;
+                dfDstYOff = poSS->m_dfDstYOff;
+                dfDstXSize = poSS->m_dfDstXSize;
+                dfDstYSize = poSS->m_dfDstYSize;
+            }
+            else if (m_nLazySources > 0)
+            {
+                // Not yet materialized sources know their destination window.
+                const auto poLazy =
+                    dynamic_cast<VRTLazySource *>(papoSources[i]);
+                if (poLazy)
+                {
+                    dfDstXOff = poLazy->m_dfDstXOff;
+                    dfDstYOff = poLazy->m_dfDstYOff;
+                    dfDstXSize = poLazy->m_dfDstXSize;
+                    dfDstYSize = poLazy->m_dfDstYSize;
+                }
+            }
+            // Sources without a destination window cover the whole band.
+            if (dfDstXOff == -1 || dfDstYOff == -1 || dfDstXSize == -1 ||
+                dfDstYSize == -1)
+            {
+                m_anUnboundedSources.push_back(i);
+                continue;
+            }
+            CPLRectObj sRect;
+            sRect.minx = dfDstXOff;
+            sRect.miny = dfDstYOff;
+            sRect.maxx = dfDstXOff + dfDstXSize;
+            sRect.maxy = dfDstYOff + dfDstYSize;
+            CPLQuadTreeInsertWithBounds(
+                m_hSourceQuadTree,
+                reinterpret_cast<void *>(static_cast<uintptr_t>(i)), &sRect);
+        }
+        m_papoIndexedSources = papoSources;
+        m_nIndexedSources = nSources;
+    }
+
+    CPLRectObj sRect;
+    sRect.minx = dfXOff;
+    sRect.miny = dfYOff;
+    sRect.maxx = dfXOff + dfXSize;
+    sRect.maxy = dfYOff + dfYSize;
+    int nFeatureCount = 0;
+    void **pahRet =
+        CPLQuadTreeSearch(m_hSourceQuadTree, &sRect, &nFeatureCount);
+    anSources = m_anUnboundedSources;
+    for (int i = 0; i < nFeatureCount; ++i)
+    {
+        anSources.push_back(
+            static_cast<int>(reinterpret_cast<uintptr_t>(pahRet[i])));
+    }
+    CPLFree(pahRet);
+    std::sort(anSources.begin(), anSources.end());
+    MaterializeLazySources(anSources);
+}
+
+/************************************************************************/
+/*                       MaterializeLazySources()                       */
+/************************************************************************/
+
+/** Replace the specified sources that were attached from a source index
+ * sidecar by the actual sources, parsed from their XML definition.
+ *
+ * The indices of the sources are unchanged, so the quad tree of the
+ * destination windows remains valid.
+ */
+void VRTSourcedRasterBand::MaterializeLazySources(
+    const std::vector<int> &anSources)
+{
+    for (const int iSource : anSources)
+    {
+        if (m_nLazySources == 0)
+            break;
+        auto poLazy = dynamic_cast<VRTLazySource *>(papoSources[iSource]);
+        if (poLazy == nullptr)
+            continue;
+        // On failure, the lazy source is kept and will report the error.
+        VRTSource *poSource = poLazy->StealSource();
+        if (poSource == nullptr)
+            continue;
+        papoSources[iSource] = poSource;
+        delete poLazy;
+        --m_nLazySources;
+    }
+}
+
+/************************************************************************/
+/*                       PrefetchSourceHeaders()                        */
+/************************************************************************/
+
+/** Read the beginning of the files of the sources that intersect the
+ * specified window and are not opened yet, when they are on network file
+ * systems.
+ *
+ * The sources are then opened one after the other, as the dataset pool
+ * serializes the opening of datasets. Reading ahead their first bytes
+ * concurrently, in the global thread pool when the GDAL_NUM_THREADS
+ * configuration option is set, fills the caches of the network file systems
+ * with the properties and headers of the files, so that their opening does
+ * not accumulate network latencies.
+ */
+void VRTSourcedRasterBand::PrefetchSourceHeaders(
+    const std::vector<int> &anSources, double dfXOff, double dfYOff,
+    double dfXSize, double dfYSize)
+{
+    if (anSources.size() < 2)
+        return;
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszNumThreads == nullptr)
+        return;
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+    nThreads = std::min(nThreads, 1024);
+    if (nThreads <= 1)
+        return;
+
+    std::vector<std::string> aosFilenames;
+    std::set<std::string> oSetFilenames;
+    for (int iSource : anSources)
+    {
+        if (!papoSources[iSource]->IsSimpleSource())
+            continue;
+        auto poSS = cpl::down_cast<VRTSimpleSource *>(papoSources[iSource]);
+        if (poSS->m_bHeaderPrefetched || poSS->GetRasterBandNoOpen() ||
+            poSS->m_osSrcDSName.empty())
+        {
+            continue;
+        }
+        // Skip sources that do not intersect the window.
+        if (poSS->m_dfDstXOff != -1 && poSS->m_dfDstYOff != -1 &&
+            poSS->m_dfDstXSize != -1 && poSS->m_dfDstYSize != -1 &&
+            !(poSS->m_dfDstXOff < dfXOff + dfXSize &&
+              dfXOff < poSS->m_dfDstXOff + poSS->m_dfDstXSize &&
+              poSS->m_dfDstYOff < dfYOff + dfYSize &&
+              dfYOff < poSS->m_dfDstYOff + poSS->m_dfDstYSize))
+        {
+            continue;
+        }
+        // Skip sources whose valid data footprint does not intersect the
+        // window.
+        if (poSS->m_poFootprint)
+        {
+            double dfSrcMinX = 0;
+            double dfSrcMinY = 0;
+            double dfSrcMaxX = 0;
+            double dfSrcMaxY = 0;
+            poSS->DstToSrc(dfXOff, dfYOff, dfSrcMinX, dfSrcMinY);
+            poSS->DstToSrc(dfXOff + dfXSize, dfYOff + dfYSize, dfSrcMaxX,
+                           dfSrcMaxY);
+            if (!poSS->FootprintIntersects(dfSrcMinX, dfSrcMinY,
+                                           dfSrcMaxX - dfSrcMinX,
+                                           dfSrcMaxY - dfSrcMinY))
+            {
+                continue;
+            }
+        }
+        poSS->m_bHeaderPrefetched = true;
+        if (VSIIsLocal(poSS->m_osSrcDSName.c_str()))
+            continue;
+        if (oSetFilenames.insert(poSS->m_osSrcDSName).second)
+            aosFilenames.push_back(poSS->m_osSrcDSName);
+    }
+    if (aosFilenames.size() < 2)
+        return;
+
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nThreads);
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    if (poQueue == nullptr)
+        return;
+
+    CPLDebugOnly("VRT", "Prefetching the headers of %d sources",
+                 static_cast<int>(aosFilenames.size()));
+
+    const auto JobRunner = [](void *pData)
+    {
+        const auto posFilename = static_cast<const std::string *>(pData);
+        CPLErrorHandlerPusher oPusher(CPLQuietErrorHandler);
+        CPLErrorStateBackuper oErrorStateBackuper;
+        VSILFILE *fp = VSIFOpenL(posFilename->c_str(), "rb");
+        if (fp == nullptr)
+            return;
+        // Same amount of bytes as read by GDALOpenInfo.
+        const int nBufSize = std::max(
+            1024, std::min(10 * 1024 * 1024,
+                           atoi(CPLGetConfigOption(
+                               "GDAL_INGESTED_BYTES_AT_OPEN", "1024"))));
+        std::vector<GByte> abyHeader(nBufSize);
+        CPL_IGNORE_RET_VAL(VSIFReadL(abyHeader.data(), 1, nBufSize, fp));
+        VSIFCloseL(fp);
+    };
+
+    for (auto &osFilename : aosFilenames)
+    {
+        if (!poQueue->SubmitJob(JobRunner, &osFilename))
+            break;
+    }
+    poQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                      ParallelSourcesRasterIO()                       */
+/************************************************************************/
+
+// Read the sources contributing to the request concurrently in the global
+// thread pool, when the GDAL_NUM_THREADS configuration option is set.
+// Sources whose windows overlap in the output buffer, or that come from the
+// same dataset, are read by the same job in their order of declaration, so
+// that the result is the same as sequential compositing and that jobs write
+// into disjoint regions of the output buffer.
+// Returns false if the request must be processed sequentially.
+bool VRTSourcedRasterBand::ParallelSourcesRasterIO(
+    const std::vector<int> &anSources, int nXOff, int nYOff, int nXSize,
+    int nYSize, void *pData, int nBufXSize, int nBufYSize,
+    GDALDataType eBufType, GSpacing nPixelSpace, GSpacing nLineSpace,
+    GDALRasterIOExtraArg *psExtraArg, CPLErr &eErr)
+{
+    if (anSources.size() < 2)
+        return false;
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszNumThreads == nullptr)
+        return false;
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+    nThreads = std::min(nThreads, 1024);
+    if (nThreads <= 1)
+        return false;
+
+    double dfXOff = nXOff;
+    double dfYOff = nYOff;
+    double dfXSize = nXSize;
+    double dfYSize = nYSize;
+    if (psExtraArg->bFloatingPointWindowValidity)
+    {
+        dfXOff = psExtraArg->dfXOff;
+        dfYOff = psExtraArg->dfYOff;
+        dfXSize = psExtraArg->dfXSize;
+        dfYSize = psExtraArg->dfYSize;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Group the contributing sources, with a union-find structure.    */
+    /* -------------------------------------------------------------------- */
+    struct SourceWindow
+    {
+        int iSource;
+        int nOutXOff;
+        int nOutYOff;
+        int nOutXSize;
+        int nOutYSize;
+    };
+
+    std::vector<SourceWindow> asWindows;
+    std::vector<int> anParent;
+    std::map<GDALDataset *, int> oMapDatasetToWindow;
+    std::map<std::string, int> oMapNameToWindow;
+
+    const auto Find = [&anParent](int i)
+    {
+        while (anParent[i] != i)
+        {
+            anParent[i] = anParent[anParent[i]];
+            i = anParent[i];
+        }
+        return i;
+    };
+    const auto Union = [&anParent, &Find](int i, int j)
+    {
+        i = Find(i);
+        j = Find(j);
+        if (i != j)
+            anParent[std::max(i, j)] = std::min(i, j);
+    };
+
+    for (int iSource : anSources)
+    {
+        if (!papoSources[iSource]->IsSimpleSource())
+            return false;
+        auto poSource = cpl::down_cast<VRTSimpleSource *>(papoSources[iSource]);
+
+        double dfReqXOff = 0.0;
+        double dfReqYOff = 0.0;
+        double dfReqXSize = 0.0;
+        double dfReqYSize = 0.0;
+        int nReqXOff = 0;
+        int nReqYOff = 0;
+        int nReqXSize = 0;
+        int nReqYSize = 0;
+        int nOutXOff = 0;
+        int nOutYOff = 0;
+        int nOutXSize = 0;
+        int nOutYSize = 0;
+        bool bError = false;
+        if (!poSource->GetSrcDstWindow(
+                dfXOff, dfYOff, dfXSize, dfYSize, nBufXSize, nBufYSize,
+                &dfReqXOff, &dfReqYOff, &dfReqXSize, &dfReqYSize, &nReqXOff,
+                &nReqYOff, &nReqXSize, &nReqYSize, &nOutXOff, &nOutYOff,
+                &nOutXSize, &nOutYSize, bError))
+        {
+            if (bError)
+                return false;
+            continue;
+        }
+
+        auto poSrcBand = poSource->GetRasterBand();
+        auto poSrcDS = poSrcBand ? poSrcBand->GetDataset() : nullptr;
+        if (poSrcDS == nullptr)
+            return false;
+        // Nested VRTs may share their own sources through the dataset pool.
+        auto poDriver = poSrcDS->GetDriver();
+        if (poDriver && EQUAL(poDriver->GetDescription(), "VRT"))
+            return false;
+
+        const int iWindow = static_cast<int>(asWindows.size());
+        asWindows.push_back(
+            {iSource, nOutXOff, nOutYOff, nOutXSize, nOutYSize});
+        anParent.push_back(iWindow);
+
+        for (int j = 0; j < iWindow; ++j)
+        {
+            const auto &sOther = asWindows[j];
+            if (nOutXOff < sOther.nOutXOff + sOther.nOutXSize &&
+                sOther.nOutXOff < nOutXOff + nOutXSize &&
+                nOutYOff < sOther.nOutYOff + sOther.nOutYSize &&
+                sOther.nOutYOff < nOutYOff + nOutYSize)
+            {
+                Union(iWindow, j);
+            }
+        }
+
+        auto oIterDS = oMapDatasetToWindow.find(poSrcDS);
+        if (oIterDS != oMapDatasetToWindow.end())
+            Union(iWindow, oIterDS->second);
+        else
+            oMapDatasetToWindow[poSrcDS] = iWindow;
+
+        const std::string osName(poSrcDS->GetDescription());
+        if (!osName.empty())
+        {
+            auto oIterName = oMapNameToWindow.find(osName);
+            if (oIterName != oMapNameToWindow.end())
+                Union(iWindow, oIterName->second);
+            else
+                oMapNameToWindow[osName] = iWindow;
+        }
+    }
+
+    struct Context
+    {
+        VRTSource **papoSources = nullptr;
+        GDALDataType eVRTDataType = GDT_Unknown;
+        int nXOff = 0;
+        int nYOff = 0;
+        int nXSize = 0;
+        int nYSize = 0;
+        void *pData = nullptr;
+        int nBufXSize = 0;
+        int nBufYSize = 0;
+        GDALDataType eBufType = GDT_Unknown;
+        GSpacing nPixelSpace = 0;
+        GSpacing nLineSpace = 0;
+        GDALRasterIOExtraArg sExtraArg{};
+        std::atomic<bool> bSuccess{true};
+    };
+
+    struct Job
+    {
+        Context *psContext = nullptr;
+        std::vector<int> anSources{};
+    };
+
+    std::vector<Job> asJobs;
+    std::map<int, size_t> oMapRootToJob;
+    for (int i = 0; i < static_cast<int>(asWindows.size()); ++i)
+    {
+        const int iRoot = Find(i);
+        auto oIter = oMapRootToJob.find(iRoot);
+        if (oIter == oMapRootToJob.end())
+        {
+            oIter = oMapRootToJob.insert({iRoot, asJobs.size()}).first;
+            asJobs.emplace_back();
+        }
+        asJobs[oIter->second].anSources.push_back(asWindows[i].iSource);
+    }
+    const int nJobs = static_cast<int>(asJobs.size());
+    if (nJobs < 2)
+        return false;
+
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nThreads);
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    if (poQueue == nullptr)
+        return false;
+
+    CPLDebugOnly("VRT",
+                 "IRasterIO(): reading %d groups of sources with %d threads",
+                 nJobs, std::min(nThreads, nJobs));
+
+    Context sContext;
+    sContext.papoSources = papoSources;
+    sContext.eVRTDataType = eDataType;
+    sContext.nXOff = nXOff;
+    sContext.nYOff = nYOff;
+    sContext.nXSize = nXSize;
+    sContext.nYSize = nYSize;
+    sContext.pData = pData;
+    sContext.nBufXSize = nBufXSize;
+    sContext.nBufYSize = nBufYSize;
+    sContext.eBufType = eBufType;
+    sContext.nPixelSpace = nPixelSpace;
+    sContext.nLineSpace = nLineSpace;
+    sContext.sExtraArg = *psExtraArg;
+    sContext.sExtraArg.pfnProgress = nullptr;
+    sContext.sExtraArg.pProgressData = nullptr;
+
+    const auto JobRunner = [](void *pJobData)
+    {
+        auto psJob = static_cast<Job *>(pJobData);
+        auto psContext = psJob->psContext;
+        // Do not let sources use the thread pool from a worker thread.
+        CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", "1", false);
+        for (int iSource : psJob->anSources)
+        {
+            if (!psContext->bSuccess)
+                return;
+            GDALRasterIOExtraArg sExtraArg(psContext->sExtraArg);
+            if (psContext->papoSources[iSource]->RasterIO(
+                    psContext->eVRTDataType, psContext->nXOff,
+                    psContext->nYOff, psContext->nXSize, psContext->nYSize,
+                    psContext->pData, psContext->nBufXSize,
+                    psContext->nBufYSize, psContext->eBufType,
+                    psContext->nPixelSpace, psContext->nLineSpace,
+                    &sExtraArg) != CE_None)
+            {
+                psContext->bSuccess = false;
+            }
+        }
+    };
+
+    for (auto &sJob : asJobs)
+    {
+        sJob.psContext = &sContext;
+        if (!poQueue->SubmitJob(JobRunner, &sJob))
+        {
+            sContext.bSuccess = false;
+            break;
+        }
+    }
+
+    // Report progress as jobs complete.
+    bool bInterrupted = false;
+    for (int nRemaining = nJobs - 1; nRemaining >= 0; --nRemaining)
+    {
+        poQueue->WaitCompletion(nRemaining);
+        if (psExtraArg->pfnProgress &&
+            !psExtraArg->pfnProgress(1.0 * (nJobs - nRemaining) / nJobs, "",
+                                     psExtraArg->pProgressData))
+        {
+            bInterrupted = true;
+            sContext.bSuccess = false;
+            poQueue->WaitCompletion();
+            break;
+        }
+    }
+
+    if (bInterrupted)
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+    eErr = sContext.bSuccess ? CE_None : CE_Failure;
+    return true;
+}
+
 /************************************************************************/
 /*                         IGetDataCoverageStatus()                     */
 /************************************************************************/
@@ -424,6 +995,24 @@ int VRTSourcedRasterBand::IGetDataCoverageStatus(int nXOff, int nYOff,
         }
         VRTSimpleSource *poSS =
             static_cast<VRTSimpleSource *>(papoSources[iSource]);
+        // Skip sources whose valid data footprint does not intersect the AOI
+        if (poSS->m_poFootprint && poSS->m_dfDstXSize != -1 &&
+            poSS->m_dfDstYSize != -1)
+        {
+            double dfSrcMinX = 0;
+            double dfSrcMinY = 0;
+            double dfSrcMaxX = 0;
+            double dfSrcMaxY = 0;
+            poSS->DstToSrc(nXOff, nYOff, dfSrcMinX, dfSrcMinY);
+            poSS->DstToSrc(nXOff + nXSize, nYOff + nYSize, dfSrcMaxX,
+                           dfSrcMaxY);
+            if (!poSS->FootprintIntersects(dfSrcMinX, dfSrcMinY,
+                                           dfSrcMaxX - dfSrcMinX,
+                                           dfSrcMaxY - dfSrcMinY))
+            {
+                continue;
+            }
+        }
         // Check if the AOI is fully inside the source
         double dfDstXOff = std::max(0.0, poSS->m_dfDstXOff);
         double dfDstYOff = std::max(0.0, poSS->m_dfDstYOff);
@@ -1761,6 +2350,10 @@ CPLErr VRTSourcedRasterBand::GetHistogram(double dfMin, double dfMax,
 CPLErr VRTSourcedRasterBand::AddSource(VRTSource *poNewSource)
 
 {
+    InvalidateSourceIndex();
+    // Blocks read with the previous sources are stale.
+    if (HasBlockCache())
+        FlushCache(false);
     nSources++;
 
     papoSources = static_cast<VRTSource **>(
@@ -1781,6 +2374,18 @@ CPLErr VRTSourcedRasterBand::AddSource(VRTSource *poNewSource)
             }
         }
     }
+    else if (auto poLazy = dynamic_cast<VRTLazySource *>(poNewSource))
+    {
+        m_nLazySources++;
+        if (GetMetadataItem("NBITS", "IMAGE_STRUCTURE") != nullptr)
+        {
+            int nBits = atoi(GetMetadataItem("NBITS", "IMAGE_STRUCTURE"));
+            if (nBits >= 1 && nBits <= 31)
+            {
+                poLazy->m_nMaxValue = static_cast<int>((1U << nBits) - 1);
+            }
+        }
+    }
 
     return CE_None;
 }
@@ -2577,11 +3182,13 @@ CPLErr VRTSourcedRasterBand::SetMetadata(char **papszNewMD,
 
         if (EQUAL(pszDomain, "vrt_sources"))
         {
+            InvalidateSourceIndex();
             for (int i = 0; i < nSources; i++)
                 delete papoSources[i];
             CPLFree(papoSources);
             papoSources = nullptr;
             nSources = 0;
+            m_nLazySources = 0;
         }
 
         for (int i = 0; i < CSLCount(papszNewMD); i++)
@@ -2642,6 +3249,7 @@ int VRTSourcedRasterBand::CloseDependentDatasets()
 {
     int ret = VRTRasterBand::CloseDependentDatasets();
 
+    InvalidateSourceIndex();
     if (nSources == 0)
         return ret;
 
@@ -2651,6 +3259,7 @@ int VRTSourcedRasterBand::CloseDependentDatasets()
     CPLFree(papoSources);
     papoSources = nullptr;
     nSources = 0;
+    m_nLazySources = 0;
 
     return TRUE;
 }
@@ -2845,6 +3454,7 @@ void VRTSourcedRasterBand::RemoveCoveredSources(CSLConstList papszOptions)
             papoSources[iDst++] = papoSources[iSrc];
     }
     nSources = iDst;
+    InvalidateSourceIndex();
 
     CPLQuadTreeDestroy(hTree);
 #endif
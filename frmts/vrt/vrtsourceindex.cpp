@@ -0,0 +1,725 @@
+/******************************************************************************
+ *
+ * Project:  Virtual GDAL Datasets
+ * Purpose:  Sidecar index of the sources of a VRT file, for fast opening
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, Even Rouault <even dot rouault at spatialys dot org>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "vrtdataset.h"
+
+#include "cpl_conv.h"
+#include "cpl_minixml.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+
+#include <cstring>
+#include <limits>
+
+/*! @cond Doxygen_Suppress */
+
+/*
+ * Layout of the sidecar file, with all values in little-endian order:
+ *
+ *   char[8]  "VRTSRCIX"
+ *   uint32   version (1)
+ *   uint32   size of the header XML
+ *   uint64   offset of the header XML
+ *   uint64   offset of the source tables
+ *   uint64   size of the .vrt file the sidecar was built from
+ *   int64    modification time of the .vrt file
+ *   ...      XML fragments of the sources, one after the other
+ *   ...      header XML: the .vrt file without the indexed sources
+ *   uint32   number of VRTRasterBand elements of the header XML
+ *            then, for each of them:
+ *   uint32     number of indexed sources
+ *              then, for each of them:
+ *   double[4]    DstRect xOff, yOff, xSize, ySize (-1 when unset)
+ *   uint64       offset of the XML fragment
+ *   uint32       size of the XML fragment
+ *
+ * The magic is written last, so that an interrupted write leaves an
+ * invalid file.
+ */
+
+constexpr char SOURCE_INDEX_MAGIC[] = "VRTSRCIX";
+constexpr int SOURCE_INDEX_MAGIC_SIZE = 8;
+constexpr GUInt32 SOURCE_INDEX_VERSION = 1;
+constexpr int SOURCE_INDEX_HEADER_SIZE = 48;
+constexpr int SOURCE_INDEX_ENTRY_SIZE = 4 * 8 + 8 + 4;
+
+// Bands with less sources are not indexed: they open fast anyway, and keeping
+// their sources inline preserves the optimizations of single source VRTs,
+// like implicit overviews.
+constexpr int MIN_SOURCES_FOR_SOURCE_INDEX = 128;
+
+/************************************************************************/
+/*                       Little-endian helpers                          */
+/************************************************************************/
+
+static void PutUInt32(GByte *pabyDst, GUInt32 nVal)
+{
+    CPL_LSBPTR32(&nVal);
+    memcpy(pabyDst, &nVal, sizeof(nVal));
+}
+
+static void PutUInt64(GByte *pabyDst, GUInt64 nVal)
+{
+    CPL_LSBPTR64(&nVal);
+    memcpy(pabyDst, &nVal, sizeof(nVal));
+}
+
+static void PutDouble(GByte *pabyDst, double dfVal)
+{
+    CPL_LSBPTR64(&dfVal);
+    memcpy(pabyDst, &dfVal, sizeof(dfVal));
+}
+
+static GUInt32 GetUInt32(const GByte *pabySrc)
+{
+    GUInt32 nVal;
+    memcpy(&nVal, pabySrc, sizeof(nVal));
+    CPL_LSBPTR32(&nVal);
+    return nVal;
+}
+
+static GUInt64 GetUInt64(const GByte *pabySrc)
+{
+    GUInt64 nVal;
+    memcpy(&nVal, pabySrc, sizeof(nVal));
+    CPL_LSBPTR64(&nVal);
+    return nVal;
+}
+
+static double GetDouble(const GByte *pabySrc)
+{
+    double dfVal;
+    memcpy(&dfVal, pabySrc, sizeof(dfVal));
+    CPL_LSBPTR64(&dfVal);
+    return dfVal;
+}
+
+/************************************************************************/
+/*                          ~VRTSourceIndex()                           */
+/************************************************************************/
+
+VRTSourceIndex::~VRTSourceIndex()
+{
+    if (m_fp)
+        CPL_IGNORE_RET_VAL(VSIFCloseL(m_fp));
+}
+
+/************************************************************************/
+/*                            GetFilename()                             */
+/************************************************************************/
+
+std::string VRTSourceIndex::GetFilename(const char *pszVRTFilename)
+{
+    return std::string(pszVRTFilename) + ".srcidx";
+}
+
+/************************************************************************/
+/*                         IsIndexableSource()                          */
+/************************************************************************/
+
+static bool IsIndexableSource(const CPLXMLNode *psNode)
+{
+    return psNode->eType == CXT_Element &&
+           (EQUAL(psNode->pszValue, "SimpleSource") ||
+            EQUAL(psNode->pszValue, "ComplexSource") ||
+            EQUAL(psNode->pszValue, "AveragedSource") ||
+            EQUAL(psNode->pszValue, "KernelFilteredSource"));
+}
+
+/************************************************************************/
+/*                          IsIndexableBand()                           */
+/************************************************************************/
+
+// Only the sources of plain sourced bands are indexed, and only if the band
+// has no other kind of source, since the order of the sources matters.
+static bool IsIndexableBand(const CPLXMLNode *psBand)
+{
+    if (!EQUAL(CPLGetXMLValue(psBand, "subclass", "VRTSourcedRasterBand"),
+               "VRTSourcedRasterBand"))
+        return false;
+
+    int nSources = 0;
+    for (const CPLXMLNode *psChild = psBand->psChild; psChild != nullptr;
+         psChild = psChild->psNext)
+    {
+        if (IsIndexableSource(psChild))
+            ++nSources;
+        else if (psChild->eType == CXT_Element &&
+                 strlen(psChild->pszValue) >= strlen("Source") &&
+                 EQUAL(psChild->pszValue + strlen(psChild->pszValue) -
+                           strlen("Source"),
+                       "Source"))
+            return false;
+    }
+    return nSources >= MIN_SOURCES_FOR_SOURCE_INDEX;
+}
+
+/************************************************************************/
+/*                                Open()                                */
+/************************************************************************/
+
+/** Open the source index sidecar of a VRT file.
+ *
+ * Returns nullptr if there is no sidecar, or if it is invalid or older than
+ * the VRT file.
+ */
+std::shared_ptr<VRTSourceIndex> VRTSourceIndex::Open(const char *pszVRTFilename)
+{
+    VSIStatBufL sStatVRT;
+    if (VSIStatL(pszVRTFilename, &sStatVRT) != 0)
+        return nullptr;
+
+    const std::string osFilename(GetFilename(pszVRTFilename));
+    VSIStatBufL sStat;
+    if (VSIStatExL(osFilename.c_str(), &sStat, VSI_STAT_EXISTS_FLAG) != 0)
+        return nullptr;
+
+    VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "rb");
+    if (fp == nullptr)
+        return nullptr;
+
+    std::shared_ptr<VRTSourceIndex> poIndex(new VRTSourceIndex());
+    poIndex->m_fp = fp;
+    poIndex->m_osFilename = osFilename;
+
+    GByte abyHeader[SOURCE_INDEX_HEADER_SIZE];
+    if (VSIFReadL(abyHeader, sizeof(abyHeader), 1, fp) != 1 ||
+        memcmp(abyHeader, SOURCE_INDEX_MAGIC, SOURCE_INDEX_MAGIC_SIZE) != 0 ||
+        GetUInt32(abyHeader + 8) != SOURCE_INDEX_VERSION)
+    {
+        CPLDebug("VRT", "%s is not a valid source index", osFilename.c_str());
+        return nullptr;
+    }
+    const GUInt32 nHeaderXMLSize = GetUInt32(abyHeader + 12);
+    const GUInt64 nHeaderXMLOffset = GetUInt64(abyHeader + 16);
+    const GUInt64 nTablesOffset = GetUInt64(abyHeader + 24);
+    if (GetUInt64(abyHeader + 32) != static_cast<GUInt64>(sStatVRT.st_size) ||
+        static_cast<GIntBig>(GetUInt64(abyHeader + 40)) !=
+            static_cast<GIntBig>(sStatVRT.st_mtime))
+    {
+        CPLDebug("VRT", "%s is out of date", osFilename.c_str());
+        return nullptr;
+    }
+
+    CPL_IGNORE_RET_VAL(VSIFSeekL(fp, 0, SEEK_END));
+    const GUInt64 nFileSize = VSIFTellL(fp);
+    if (nHeaderXMLOffset < SOURCE_INDEX_HEADER_SIZE ||
+        nHeaderXMLOffset + nHeaderXMLSize > nTablesOffset ||
+        nTablesOffset + 4 > nFileSize)
+    {
+        CPLDebug("VRT", "%s is corrupted", osFilename.c_str());
+        return nullptr;
+    }
+
+    try
+    {
+        poIndex->m_osHeaderXML.resize(nHeaderXMLSize);
+    }
+    catch (const std::exception &)
+    {
+        return nullptr;
+    }
+    if (VSIFSeekL(fp, nHeaderXMLOffset, SEEK_SET) != 0 ||
+        VSIFReadL(&poIndex->m_osHeaderXML[0], 1, nHeaderXMLSize, fp) !=
+            nHeaderXMLSize)
+    {
+        return nullptr;
+    }
+
+    GByte abyCount[4];
+    if (VSIFSeekL(fp, nTablesOffset, SEEK_SET) != 0 ||
+        VSIFReadL(abyCount, sizeof(abyCount), 1, fp) != 1)
+    {
+        return nullptr;
+    }
+    const GUInt32 nBands = GetUInt32(abyCount);
+    GUInt64 nRemaining = nFileSize - nTablesOffset - 4;
+    if (nBands > nRemaining / 4)
+    {
+        CPLDebug("VRT", "%s is corrupted", osFilename.c_str());
+        return nullptr;
+    }
+
+    std::vector<GByte> abyEntries;
+    poIndex->m_aaoEntries.resize(nBands);
+    for (auto &aoEntries : poIndex->m_aaoEntries)
+    {
+        if (VSIFReadL(abyCount, sizeof(abyCount), 1, fp) != 1)
+            return nullptr;
+        nRemaining -= 4;
+        const GUInt32 nSources = GetUInt32(abyCount);
+        if (nSources > nRemaining / SOURCE_INDEX_ENTRY_SIZE)
+        {
+            CPLDebug("VRT", "%s is corrupted", osFilename.c_str());
+            return nullptr;
+        }
+        nRemaining -= static_cast<GUInt64>(nSources) * SOURCE_INDEX_ENTRY_SIZE;
+
+        try
+        {
+            abyEntries.resize(static_cast<size_t>(nSources) *
+                              SOURCE_INDEX_ENTRY_SIZE);
+            aoEntries.resize(nSources);
+        }
+        catch (const std::exception &)
+        {
+            return nullptr;
+        }
+        if (VSIFReadL(abyEntries.data(), 1, abyEntries.size(), fp) !=
+            abyEntries.size())
+        {
+            return nullptr;
+        }
+        for (GUInt32 i = 0; i < nSources; ++i)
+        {
+            const GByte *pabyEntry =
+                abyEntries.data() +
+                static_cast<size_t>(i) * SOURCE_INDEX_ENTRY_SIZE;
+            Entry &oEntry = aoEntries[i];
+            oEntry.dfDstXOff = GetDouble(pabyEntry);
+            oEntry.dfDstYOff = GetDouble(pabyEntry + 8);
+            oEntry.dfDstXSize = GetDouble(pabyEntry + 16);
+            oEntry.dfDstYSize = GetDouble(pabyEntry + 24);
+            oEntry.nOffset = GetUInt64(pabyEntry + 32);
+            oEntry.nSize = GetUInt32(pabyEntry + 40);
+            if (oEntry.nOffset < SOURCE_INDEX_HEADER_SIZE ||
+                oEntry.nOffset + oEntry.nSize > nHeaderXMLOffset)
+            {
+                CPLDebug("VRT", "%s is corrupted", osFilename.c_str());
+                return nullptr;
+            }
+        }
+    }
+
+    return poIndex;
+}
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+/** Write the source index sidecar of a VRT file, from its XML content.
+ *
+ * Returns false if the VRT has no band with enough sources to be worth
+ * indexing, or on error.
+ */
+bool VRTSourceIndex::Write(const char *pszVRTFilename, const char *pszXML)
+{
+    VSIStatBufL sStatVRT;
+    if (VSIStatL(pszVRTFilename, &sStatVRT) != 0)
+        return false;
+
+    CPLXMLTreeCloser psTree(CPLParseXMLString(pszXML));
+    CPLXMLNode *psRoot =
+        psTree ? CPLGetXMLNode(psTree.get(), "=VRTDataset") : nullptr;
+    if (psRoot == nullptr ||
+        CPLGetXMLValue(psRoot, "subClass", nullptr) != nullptr)
+        return false;
+
+    bool bHasIndexableBand = false;
+    for (const CPLXMLNode *psChild = psRoot->psChild; psChild != nullptr;
+         psChild = psChild->psNext)
+    {
+        if (psChild->eType == CXT_Element &&
+            EQUAL(psChild->pszValue, "VRTRasterBand") &&
+            IsIndexableBand(psChild))
+        {
+            bHasIndexableBand = true;
+            break;
+        }
+    }
+    if (!bHasIndexableBand)
+        return false;
+
+    const std::string osFilename(GetFilename(pszVRTFilename));
+    VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "wb");
+    if (fp == nullptr)
+    {
+        CPLError(CE_Warning, CPLE_FileIO, "Cannot create %s",
+                 osFilename.c_str());
+        return false;
+    }
+
+    GByte abyHeader[SOURCE_INDEX_HEADER_SIZE] = {};
+    bool bOK = VSIFWriteL(abyHeader, sizeof(abyHeader), 1, fp) == 1;
+    GUInt64 nOffset = SOURCE_INDEX_HEADER_SIZE;
+
+    // Move the sources of the indexable bands from the tree to the file.
+    std::vector<std::vector<Entry>> aaoEntries;
+    for (CPLXMLNode *psBand = psRoot->psChild; bOK && psBand != nullptr;
+         psBand = psBand->psNext)
+    {
+        if (psBand->eType != CXT_Element ||
+            !EQUAL(psBand->pszValue, "VRTRasterBand"))
+            continue;
+        aaoEntries.emplace_back();
+        if (!IsIndexableBand(psBand))
+            continue;
+
+        auto &aoEntries = aaoEntries.back();
+        CPLXMLNode *psPrev = nullptr;
+        CPLXMLNode *psChild = psBand->psChild;
+        while (bOK && psChild != nullptr)
+        {
+            CPLXMLNode *psNext = psChild->psNext;
+            if (!IsIndexableSource(psChild))
+            {
+                psPrev = psChild;
+                psChild = psNext;
+                continue;
+            }
+
+            if (psPrev)
+                psPrev->psNext = psNext;
+            else
+                psBand->psChild = psNext;
+            psChild->psNext = nullptr;
+
+            Entry oEntry;
+            const CPLXMLNode *psDstRect = CPLGetXMLNode(psChild, "DstRect");
+            if (psDstRect)
+            {
+                oEntry.dfDstXOff =
+                    CPLAtof(CPLGetXMLValue(psDstRect, "xOff", "-1"));
+                oEntry.dfDstYOff =
+                    CPLAtof(CPLGetXMLValue(psDstRect, "yOff", "-1"));
+                oEntry.dfDstXSize =
+                    CPLAtof(CPLGetXMLValue(psDstRect, "xSize", "-1"));
+                oEntry.dfDstYSize =
+                    CPLAtof(CPLGetXMLValue(psDstRect, "ySize", "-1"));
+            }
+            char *pszFragment = CPLSerializeXMLTree(psChild);
+            CPLDestroyXMLNode(psChild);
+            const size_t nLen = strlen(pszFragment);
+            oEntry.nOffset = nOffset;
+            oEntry.nSize = static_cast<GUInt32>(nLen);
+            bOK = nLen <= std::numeric_limits<GUInt32>::max() &&
+                  VSIFWriteL(pszFragment, 1, nLen, fp) == nLen;
+            CPLFree(pszFragment);
+            nOffset += nLen;
+            aoEntries.push_back(oEntry);
+
+            psChild = psNext;
+        }
+    }
+
+    // Header XML.
+    const GUInt64 nHeaderXMLOffset = nOffset;
+    char *pszHeaderXML = CPLSerializeXMLTree(psRoot);
+    const size_t nHeaderXMLSize = strlen(pszHeaderXML);
+    bOK = bOK && nHeaderXMLSize <= std::numeric_limits<GUInt32>::max() &&
+          VSIFWriteL(pszHeaderXML, 1, nHeaderXMLSize, fp) == nHeaderXMLSize;
+    CPLFree(pszHeaderXML);
+    const GUInt64 nTablesOffset = nHeaderXMLOffset + nHeaderXMLSize;
+
+    // Source tables.
+    std::vector<GByte> abyTable;
+    abyTable.resize(4);
+    PutUInt32(abyTable.data(), static_cast<GUInt32>(aaoEntries.size()));
+    bOK = bOK && VSIFWriteL(abyTable.data(), 1, 4, fp) == 4;
+    for (const auto &aoEntries : aaoEntries)
+    {
+        if (!bOK)
+            break;
+        abyTable.resize(4 + aoEntries.size() * SOURCE_INDEX_ENTRY_SIZE);
+        PutUInt32(abyTable.data(), static_cast<GUInt32>(aoEntries.size()));
+        GByte *pabyEntry = abyTable.data() + 4;
+        for (const auto &oEntry : aoEntries)
+        {
+            PutDouble(pabyEntry, oEntry.dfDstXOff);
+            PutDouble(pabyEntry + 8, oEntry.dfDstYOff);
+            PutDouble(pabyEntry + 16, oEntry.dfDstXSize);
+            PutDouble(pabyEntry + 24, oEntry.dfDstYSize);
+            PutUInt64(pabyEntry + 32, oEntry.nOffset);
+            PutUInt32(pabyEntry + 40, oEntry.nSize);
+            pabyEntry += SOURCE_INDEX_ENTRY_SIZE;
+        }
+        bOK = VSIFWriteL(abyTable.data(), 1, abyTable.size(), fp) ==
+              abyTable.size();
+    }
+
+    // Header, with the magic.
+    memcpy(abyHeader, SOURCE_INDEX_MAGIC, SOURCE_INDEX_MAGIC_SIZE);
+    PutUInt32(abyHeader + 8, SOURCE_INDEX_VERSION);
+    PutUInt32(abyHeader + 12, static_cast<GUInt32>(nHeaderXMLSize));
+    PutUInt64(abyHeader + 16, nHeaderXMLOffset);
+    PutUInt64(abyHeader + 24, nTablesOffset);
+    PutUInt64(abyHeader + 32, static_cast<GUInt64>(sStatVRT.st_size));
+    PutUInt64(abyHeader + 40, static_cast<GUInt64>(sStatVRT.st_mtime));
+    bOK = bOK && VSIFSeekL(fp, 0, SEEK_SET) == 0 &&
+          VSIFWriteL(abyHeader, sizeof(abyHeader), 1, fp) == 1;
+
+    if (VSIFCloseL(fp) != 0)
+        bOK = false;
+    if (!bOK)
+    {
+        CPLError(CE_Warning, CPLE_FileIO, "Cannot write %s",
+                 osFilename.c_str());
+        VSIUnlink(osFilename.c_str());
+    }
+    return bOK;
+}
+
+/************************************************************************/
+/*                           AttachSources()                            */
+/************************************************************************/
+
+/** Add the indexed sources, as lazy sources, to the bands of a dataset
+ * opened from the header XML of the index.
+ */
+bool VRTSourceIndex::AttachSources(VRTDataset *poDS, const char *pszVRTPath)
+{
+    if (m_aaoEntries.size() != static_cast<size_t>(poDS->GetRasterCount()))
+        return false;
+
+    // Check everything before modifying the dataset.
+    for (int iBand = 0; iBand < poDS->GetRasterCount(); ++iBand)
+    {
+        if (m_aaoEntries[iBand].empty())
+            continue;
+        auto poBand =
+            cpl::down_cast<VRTRasterBand *>(poDS->GetRasterBand(iBand + 1));
+        if (!poBand->IsSourcedRasterBand() ||
+            dynamic_cast<VRTDerivedRasterBand *>(poBand) != nullptr ||
+            cpl::down_cast<VRTSourcedRasterBand *>(poBand)->nSources != 0)
+        {
+            return false;
+        }
+    }
+
+    m_osVRTPath = pszVRTPath ? pszVRTPath : "";
+    const auto poThis = shared_from_this();
+    for (int iBand = 0; iBand < poDS->GetRasterCount(); ++iBand)
+    {
+        auto poBand = cpl::down_cast<VRTSourcedRasterBand *>(
+            poDS->GetRasterBand(iBand + 1));
+        for (const auto &oEntry : m_aaoEntries[iBand])
+        {
+            poBand->AddSource(
+                new VRTLazySource(poThis, oEntry, poDS->m_oMapSharedSources));
+        }
+    }
+    m_aaoEntries.clear();
+    poDS->m_poSourceIndex = poThis;
+    return true;
+}
+
+/************************************************************************/
+/*                            ReadFragment()                            */
+/************************************************************************/
+
+bool VRTSourceIndex::ReadFragment(GUInt64 nOffset, GUInt32 nSize,
+                                  std::string &osXML)
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    try
+    {
+        osXML.resize(nSize);
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+    if (VSIFSeekL(m_fp, nOffset, SEEK_SET) != 0 ||
+        VSIFReadL(&osXML[0], 1, nSize, m_fp) != nSize)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot read source from %s",
+                 m_osFilename.c_str());
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                            VRTLazySource                             */
+/* ==================================================================== */
+/************************************************************************/
+
+VRTLazySource::VRTLazySource(
+    const std::shared_ptr<VRTSourceIndex> &poIndex,
+    const VRTSourceIndex::Entry &oEntry,
+    std::map<CPLString, GDALDataset *> &oMapSharedSources)
+    : m_poIndex(poIndex), m_nOffset(oEntry.nOffset), m_nSize(oEntry.nSize),
+      m_oMapSharedSources(oMapSharedSources), m_dfDstXOff(oEntry.dfDstXOff),
+      m_dfDstYOff(oEntry.dfDstYOff), m_dfDstXSize(oEntry.dfDstXSize),
+      m_dfDstYSize(oEntry.dfDstYSize)
+{
+}
+
+/************************************************************************/
+/*                             GetSource()                              */
+/************************************************************************/
+
+/** Return the source, parsing it from the index at the first call.
+ *
+ * Returns nullptr if it cannot be read.
+ */
+VRTSource *VRTLazySource::GetSource()
+{
+    if (m_poSource || m_bTriedToMaterialize)
+        return m_poSource.get();
+    m_bTriedToMaterialize = true;
+
+    std::string osXML;
+    if (!m_poIndex->ReadFragment(m_nOffset, m_nSize, osXML))
+        return nullptr;
+    CPLXMLTreeCloser psTree(CPLParseXMLString(osXML.c_str()));
+    VRTDriver *const poDriver =
+        static_cast<VRTDriver *>(GDALGetDriverByName("VRT"));
+    if (psTree == nullptr || poDriver == nullptr)
+        return nullptr;
+    m_poSource.reset(poDriver->ParseSource(
+        psTree.get(), m_poIndex->GetVRTPath(), m_oMapSharedSources));
+    if (m_poSource && m_nMaxValue > 0 && m_poSource->IsSimpleSource())
+    {
+        cpl::down_cast<VRTSimpleSource *>(m_poSource.get())
+            ->SetMaxValue(m_nMaxValue);
+    }
+    return m_poSource.get();
+}
+
+/************************************************************************/
+/*                            StealSource()                             */
+/************************************************************************/
+
+/** Return the source, transferring its ownership to the caller.
+ *
+ * Returns nullptr if it cannot be read.
+ */
+VRTSource *VRTLazySource::StealSource()
+{
+    GetSource();
+    return m_poSource.release();
+}
+
+/************************************************************************/
+/*                              RasterIO()                              */
+/************************************************************************/
+
+CPLErr VRTLazySource::RasterIO(GDALDataType eVRTBandDataType, int nXOff,
+                               int nYOff, int nXSize, int nYSize, void *pData,
+                               int nBufXSize, int nBufYSize,
+                               GDALDataType eBufType, GSpacing nPixelSpace,
+                               GSpacing nLineSpace,
+                               GDALRasterIOExtraArg *psExtraArg)
+{
+    VRTSource *poSource = GetSource();
+    if (poSource == nullptr)
+        return CE_Failure;
+    return poSource->RasterIO(eVRTBandDataType, nXOff, nYOff, nXSize, nYSize,
+                              pData, nBufXSize, nBufYSize, eBufType,
+                              nPixelSpace, nLineSpace, psExtraArg);
+}
+
+/************************************************************************/
+/*                             GetMinimum()                             */
+/************************************************************************/
+
+double VRTLazySource::GetMinimum(int nXSize, int nYSize, int *pbSuccess)
+{
+    VRTSource *poSource = GetSource();
+    if (poSource == nullptr)
+    {
+        *pbSuccess = FALSE;
+        return 0;
+    }
+    return poSource->GetMinimum(nXSize, nYSize, pbSuccess);
+}
+
+/************************************************************************/
+/*                             GetMaximum()                             */
+/************************************************************************/
+
+double VRTLazySource::GetMaximum(int nXSize, int nYSize, int *pbSuccess)
+{
+    VRTSource *poSource = GetSource();
+    if (poSource == nullptr)
+    {
+        *pbSuccess = FALSE;
+        return 0;
+    }
+    return poSource->GetMaximum(nXSize, nYSize, pbSuccess);
+}
+
+/************************************************************************/
+/*                            GetHistogram()                            */
+/************************************************************************/
+
+CPLErr VRTLazySource::GetHistogram(int nXSize, int nYSize, double dfMin,
+                                   double dfMax, int nBuckets,
+                                   GUIntBig *panHistogram,
+                                   int bIncludeOutOfRange, int bApproxOK,
+                                   GDALProgressFunc pfnProgress,
+                                   void *pProgressData)
+{
+    VRTSource *poSource = GetSource();
+    if (poSource == nullptr)
+        return CE_Failure;
+    return poSource->GetHistogram(nXSize, nYSize, dfMin, dfMax, nBuckets,
+                                  panHistogram, bIncludeOutOfRange, bApproxOK,
+                                  pfnProgress, pProgressData);
+}
+
+/************************************************************************/
+/*                           SerializeToXML()                           */
+/************************************************************************/
+
+CPLXMLNode *VRTLazySource::SerializeToXML(const char *pszVRTPath)
+{
+    VRTSource *poSource = GetSource();
+    if (poSource == nullptr)
+        return nullptr;
+    return poSource->SerializeToXML(pszVRTPath);
+}
+
+/************************************************************************/
+/*                            GetFileList()                             */
+/************************************************************************/
+
+void VRTLazySource::GetFileList(char ***ppapszFileList, int *pnSize,
+                                int *pnMaxSize, CPLHashSet *hSetFiles)
+{
+    VRTSource *poSource = GetSource();
+    if (poSource)
+        poSource->GetFileList(ppapszFileList, pnSize, pnMaxSize, hSetFiles);
+}
+
+/************************************************************************/
+/*                             FlushCache()                             */
+/************************************************************************/
+
+CPLErr VRTLazySource::FlushCache(bool bAtClosing)
+{
+    // Nothing to flush if the source has not been instantiated.
+    if (m_poSource)
+        return m_poSource->FlushCache(bAtClosing);
+    return CE_None;
+}
+
+/*! @endcond */
@@ -53,6 +53,7 @@
 #include "gdal_priv.h"
 #include "gdal_proxy.h"
 #include "gdal_priv_templates.hpp"
+#include "ogr_geometry.h"
 
 /*! @cond Doxygen_Suppress */
 
@@ -121,7 +122,8 @@ VRTSimpleSource::VRTSimpleSource(const VRTSimpleSource *poSrcSource,
       m_nMaxValue(poSrcSource->m_nMaxValue), m_bRelativeToVRTOri(-1),
       m_nExplicitSharedStatus(poSrcSource->m_nExplicitSharedStatus),
       m_osSrcDSName(poSrcSource->m_osSrcDSName),
-      m_bDropRefOnSrcBand(poSrcSource->m_bDropRefOnSrcBand)
+      m_bDropRefOnSrcBand(poSrcSource->m_bDropRefOnSrcBand),
+      m_poFootprint(poSrcSource->m_poFootprint)
 {
 }
 
@@ -281,6 +283,61 @@ void VRTSimpleSource::GetDstWindow(double &dfDstXOff, double &dfDstYOff,
     dfDstYSize = m_dfDstYSize;
 }
 
+/************************************************************************/
+/*                            SetFootprint()                            */
+/************************************************************************/
+
+/** Set the footprint of the valid data of the source.
+ *
+ * The footprint is expressed in pixel/line coordinates of the source band.
+ * Requests whose source window does not intersect it are skipped without
+ * opening the source, so it must cover all pixels that are not masked out
+ * (by nodata or the mask band) when the source is composited.
+ */
+void VRTSimpleSource::SetFootprint(std::unique_ptr<OGRGeometry> poFootprint)
+{
+    if (poFootprint && poFootprint->IsEmpty())
+        poFootprint.reset();
+    m_poFootprint = std::move(poFootprint);
+}
+
+/************************************************************************/
+/*                        FootprintIntersects()                         */
+/************************************************************************/
+
+bool VRTSimpleSource::FootprintIntersects(double dfReqXOff, double dfReqYOff,
+                                          double dfReqXSize,
+                                          double dfReqYSize) const
+{
+    if (!m_poFootprint)
+        return true;
+
+    OGREnvelope sEnvelope;
+    m_poFootprint->getEnvelope(&sEnvelope);
+    if (sEnvelope.MaxX < dfReqXOff || sEnvelope.MaxY < dfReqYOff ||
+        sEnvelope.MinX > dfReqXOff + dfReqXSize ||
+        sEnvelope.MinY > dfReqYOff + dfReqYSize)
+    {
+        return false;
+    }
+    if (sEnvelope.MinX >= dfReqXOff && sEnvelope.MinY >= dfReqYOff &&
+        sEnvelope.MaxX <= dfReqXOff + dfReqXSize &&
+        sEnvelope.MaxY <= dfReqYOff + dfReqYSize)
+    {
+        return true;
+    }
+
+    OGRPolygon oWindow;
+    auto poLR = std::make_unique<OGRLinearRing>();
+    poLR->addPoint(dfReqXOff, dfReqYOff);
+    poLR->addPoint(dfReqXOff, dfReqYOff + dfReqYSize);
+    poLR->addPoint(dfReqXOff + dfReqXSize, dfReqYOff + dfReqYSize);
+    poLR->addPoint(dfReqXOff + dfReqXSize, dfReqYOff);
+    poLR->addPoint(dfReqXOff, dfReqYOff);
+    oWindow.addRingDirectly(poLR.release());
+    return CPL_TO_BOOL(m_poFootprint->Intersects(&oWindow));
+}
+
 /************************************************************************/
 /*                           SerializeToXML()                           */
 /************************************************************************/
@@ -504,6 +561,18 @@ CPLXMLNode *VRTSimpleSource::SerializeToXML(const char *pszVRTPath)
                        CPLSPrintf("%.15g", m_dfDstYSize));
     }
 
+    if (m_poFootprint)
+    {
+        OGRWktOptions oWktOptions;
+        oWktOptions.format = OGRWktFormat::F;
+        oWktOptions.precision = 3;
+        OGRErr eErr = OGRERR_NONE;
+        const std::string osWKT =
+            m_poFootprint->exportToWkt(oWktOptions, &eErr);
+        if (eErr == OGRERR_NONE)
+            CPLSetXMLValue(psSrc, "Footprint", osWKT.c_str());
+    }
+
     return psSrc;
 }
 
@@ -657,6 +726,23 @@ VRTSimpleSource::XMLInit(CPLXMLNode *psSrc, const char *pszVRTPath,
     if (strstr(m_osSrcDSName.c_str(), "<VRTDataset") != nullptr)
         m_aosOpenOptions.SetNameValue("ROOT_PATH", pszVRTPath);
 
+    const char *pszFootprint = CPLGetXMLValue(psSrc, "Footprint", nullptr);
+    if (pszFootprint)
+    {
+        OGRGeometry *poFootprint = nullptr;
+        OGRGeometryFactory::createFromWkt(pszFootprint, nullptr,
+                                          &poFootprint);
+        if (poFootprint)
+        {
+            SetFootprint(std::unique_ptr<OGRGeometry>(poFootprint));
+        }
+        else
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Invalid <Footprint> element in source. Ignoring it.");
+        }
+    }
+
     return ParseSrcRectAndDstRect(psSrc);
 }
 
@@ -1031,6 +1117,27 @@ int VRTSimpleSource::GetSrcDstWindow(
         return FALSE;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Skip the request, before opening the source, if it does not     */
+    /*      intersect the footprint of the valid data of the source. The    */
+    /*      window is enlarged by the radius of the widest resampling       */
+    /*      kernel, in source pixels.                                       */
+    /* -------------------------------------------------------------------- */
+    if (m_poFootprint)
+    {
+        const double dfMarginX =
+            3 * std::max(1.0, dfXSize * dfScaleX / std::max(1, nBufXSize));
+        const double dfMarginY =
+            3 * std::max(1.0, dfYSize * dfScaleY / std::max(1, nBufYSize));
+        if (!FootprintIntersects(*pdfReqXOff - dfMarginX,
+                                 *pdfReqYOff - dfMarginY,
+                                 *pdfReqXSize + 2 * dfMarginX,
+                                 *pdfReqYSize + 2 * dfMarginY))
+        {
+            return FALSE;
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Clamp within the bounds of the available source data.           */
     /* -------------------------------------------------------------------- */
@@ -2496,11 +2603,61 @@ CPLErr VRTComplexSource::RasterIO(GDALDataType eVRTBandDataType, int nXOff,
 
     const bool bIsComplex =
         CPL_TO_BOOL(GDALDataTypeIsComplex(eVRTBandDataType));
-    CPLErr eErr;
     // For Int32, float32 isn't sufficiently precise as working data type
-    if (eVRTBandDataType == GDT_CInt32 || eVRTBandDataType == GDT_CFloat64 ||
+    const bool bDoubleWorkingDataType =
+        eVRTBandDataType == GDT_CInt32 || eVRTBandDataType == GDT_CFloat64 ||
         eVRTBandDataType == GDT_Int32 || eVRTBandDataType == GDT_UInt32 ||
-        eVRTBandDataType == GDT_Float64)
+        eVRTBandDataType == GDT_Float64;
+
+    // Optimization for Byte and UInt16 sources, processed with a table of
+    // the output values of all possible source values. This is only valid
+    // if reading them with their data type gives the same values as reading
+    // them with the working data type, that is without interpolation.
+    const auto eSourceType = poSourceBand->GetRasterDataType();
+    const size_t nOutPixelCount = static_cast<size_t>(nOutXSize) * nOutYSize;
+    if (!bIsComplex && !GDALDataTypeIsComplex(eBufType) &&
+        (m_nProcessingFlags & PROCESSING_FLAG_USE_MASK_BAND) == 0 &&
+        !((m_nProcessingFlags & PROCESSING_FLAG_SCALING_LINEAR) != 0 &&
+          m_dfScaleRatio == 0 &&
+          (m_nProcessingFlags & PROCESSING_FLAG_NODATA) == 0) &&
+        ((nReqXSize == nOutXSize && nReqYSize == nOutYSize) ||
+         psExtraArg->eResampleAlg == GRIORA_NearestNeighbour) &&
+        (eSourceType == GDT_Byte ||
+         // Only worth computing a 65536 entry table for large requests
+         (eSourceType == GDT_UInt16 && nOutPixelCount >= 65536)))
+    {
+        if (eSourceType == GDT_Byte && bDoubleWorkingDataType)
+        {
+            return RasterIOProcessTable<GByte, GDT_Byte, double>(
+                poSourceBand, eVRTBandDataType, nReqXOff, nReqYOff, nReqXSize,
+                nReqYSize, pabyOut, nOutXSize, nOutYSize, eBufType, nPixelSpace,
+                nLineSpace, psExtraArg, GDT_Float64);
+        }
+        else if (eSourceType == GDT_Byte)
+        {
+            return RasterIOProcessTable<GByte, GDT_Byte, float>(
+                poSourceBand, eVRTBandDataType, nReqXOff, nReqYOff, nReqXSize,
+                nReqYSize, pabyOut, nOutXSize, nOutYSize, eBufType, nPixelSpace,
+                nLineSpace, psExtraArg, GDT_Float32);
+        }
+        else if (bDoubleWorkingDataType)
+        {
+            return RasterIOProcessTable<uint16_t, GDT_UInt16, double>(
+                poSourceBand, eVRTBandDataType, nReqXOff, nReqYOff, nReqXSize,
+                nReqYSize, pabyOut, nOutXSize, nOutYSize, eBufType, nPixelSpace,
+                nLineSpace, psExtraArg, GDT_Float64);
+        }
+        else
+        {
+            return RasterIOProcessTable<uint16_t, GDT_UInt16, float>(
+                poSourceBand, eVRTBandDataType, nReqXOff, nReqYOff, nReqXSize,
+                nReqYSize, pabyOut, nOutXSize, nOutYSize, eBufType, nPixelSpace,
+                nLineSpace, psExtraArg, GDT_Float32);
+        }
+    }
+
+    CPLErr eErr;
+    if (bDoubleWorkingDataType)
     {
         eErr = RasterIOInternal<double>(
             poSourceBand, eVRTBandDataType, nReqXOff, nReqYOff, nReqXSize,
@@ -2714,6 +2871,292 @@ CPLErr VRTComplexSource::RasterIOProcessNoData(
     return CE_None;
 }
 
+/************************************************************************/
+/*                          WarnNoColorEntry()                          */
+/************************************************************************/
+
+static void WarnNoColorEntry(int nValue)
+{
+    static bool bHasWarned = false;
+    if (!bHasWarned)
+    {
+        bHasWarned = true;
+        CPLError(CE_Failure, CPLE_AppDefined, "No entry %d.", nValue);
+    }
+}
+
+/************************************************************************/
+/*                        WriteProcessedValue()                         */
+/************************************************************************/
+
+// Write a value of the working data type to the output buffer, with the
+// clamping of the VRT band data type.
+template <class WorkingDT>
+static inline void WriteProcessedValue(const WorkingDT *afResult,
+                                       GDALDataType eWrkDataType,
+                                       GDALDataType eVRTBandDataType,
+                                       GDALDataType eBufType,
+                                       GByte *pDstLocation)
+{
+    if (eBufType == GDT_Byte && eVRTBandDataType == GDT_Byte)
+    {
+        *pDstLocation = static_cast<GByte>(std::min(
+            255.0f, std::max(0.0f, static_cast<float>(afResult[0]) + 0.5f)));
+    }
+    else if (eBufType == eVRTBandDataType)
+    {
+        GDALCopyWords(afResult, eWrkDataType, 0, pDstLocation, eBufType, 0, 1);
+    }
+    else
+    {
+        GByte abyTemp[2 * sizeof(double)];
+        // Convert first to the VRTRasterBand data type
+        // to get its clamping, before outputting to buffer data type
+        GDALCopyWords(afResult, eWrkDataType, 0, abyTemp, eVRTBandDataType, 0,
+                      1);
+        GDALCopyWords(abyTemp, eVRTBandDataType, 0, pDstLocation, eBufType, 0,
+                      1);
+    }
+}
+
+/************************************************************************/
+/*                          ProcessRealValue()                          */
+/************************************************************************/
+
+// Apply the color table expansion, scaling, LUT and maximum value to a
+// valid (not nodata) real source value.
+template <class WorkingDT>
+int VRTComplexSource::ProcessRealValue(GDALRasterBand *poSourceBand,
+                                       const GDALColorTable *poColorTable,
+                                       WorkingDT &fResult)
+{
+    if (poColorTable)
+    {
+        const GDALColorEntry *poEntry =
+            poColorTable->GetColorEntry(static_cast<int>(fResult));
+        if (poEntry == nullptr)
+            return PROCESS_VALUE_NO_COLOR_ENTRY;
+        if (m_nColorTableComponent == 1)
+            fResult = poEntry->c1;
+        else if (m_nColorTableComponent == 2)
+            fResult = poEntry->c2;
+        else if (m_nColorTableComponent == 3)
+            fResult = poEntry->c3;
+        else if (m_nColorTableComponent == 4)
+            fResult = poEntry->c4;
+    }
+
+    if ((m_nProcessingFlags & PROCESSING_FLAG_SCALING_LINEAR) != 0)
+    {
+        fResult = static_cast<WorkingDT>(fResult * m_dfScaleRatio +
+                                         m_dfScaleOff);
+    }
+    else if ((m_nProcessingFlags & PROCESSING_FLAG_SCALING_EXPONENTIAL) != 0)
+    {
+        if (!m_bSrcMinMaxDefined)
+        {
+            int bSuccessMin = FALSE;
+            int bSuccessMax = FALSE;
+            double adfMinMax[2] = {poSourceBand->GetMinimum(&bSuccessMin),
+                                   poSourceBand->GetMaximum(&bSuccessMax)};
+            if ((bSuccessMin && bSuccessMax) ||
+                poSourceBand->ComputeRasterMinMax(TRUE, adfMinMax) == CE_None)
+            {
+                m_dfSrcMin = adfMinMax[0];
+                m_dfSrcMax = adfMinMax[1];
+                m_bSrcMinMaxDefined = true;
+            }
+            else
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Cannot determine source min/max value");
+                return PROCESS_VALUE_ERROR;
+            }
+        }
+
+        double dfPowVal = (fResult - m_dfSrcMin) / (m_dfSrcMax - m_dfSrcMin);
+        if (dfPowVal < 0.0)
+            dfPowVal = 0.0;
+        else if (dfPowVal > 1.0)
+            dfPowVal = 1.0;
+        fResult = static_cast<WorkingDT>(
+            (m_dfDstMax - m_dfDstMin) * pow(dfPowVal, m_dfExponent) +
+            m_dfDstMin);
+    }
+
+    if (!m_adfLUTInputs.empty())
+        fResult = static_cast<WorkingDT>(LookupValue(fResult));
+
+    if (m_nMaxValue != 0 && fResult > m_nMaxValue)
+        fResult = static_cast<WorkingDT>(m_nMaxValue);
+
+    return PROCESS_VALUE_VALID;
+}
+
+/************************************************************************/
+/*                        RasterIOProcessTable()                        */
+/************************************************************************/
+
+// This method is an optimization of the generic RasterIOInternal() for
+// sources of a data type with few possible values, without mask band
+// processing: the output value of each possible source value is computed
+// once into a table, and pixels are then processed with a table lookup,
+// without conversion to the working data type.
+
+// nReqXOff, nReqYOff, nReqXSize, nReqYSize are expressed in source band
+// referential.
+template <class SourceDT, GDALDataType eSourceType, class WorkingDT>
+CPLErr VRTComplexSource::RasterIOProcessTable(
+    GDALRasterBand *poSourceBand, GDALDataType eVRTBandDataType, int nReqXOff,
+    int nReqYOff, int nReqXSize, int nReqYSize, void *pData, int nOutXSize,
+    int nOutYSize, GDALDataType eBufType, GSpacing nPixelSpace,
+    GSpacing nLineSpace, GDALRasterIOExtraArg *psExtraArg,
+    GDALDataType eWrkDataType)
+{
+    CPLAssert((m_nProcessingFlags & PROCESSING_FLAG_USE_MASK_BAND) == 0);
+    constexpr int TABLE_SIZE = 1 << (8 * sizeof(SourceDT));
+    static_assert(std::is_unsigned<SourceDT>::value,
+                  "SourceDT should be unsigned");
+
+    /* -------------------------------------------------------------------- */
+    /*      Read into a temporary buffer.                                   */
+    /* -------------------------------------------------------------------- */
+    const size_t nPixelCount = static_cast<size_t>(nOutXSize) * nOutYSize;
+    try
+    {
+        // Cannot overflow since pData should at least have that number of
+        // elements
+        if (nPixelCount > std::numeric_limits<size_t>::max() / sizeof(SourceDT))
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Too large temporary buffer");
+            return CE_Failure;
+        }
+        m_abyWrkBuffer.resize(sizeof(SourceDT) * nPixelCount);
+    }
+    catch (const std::bad_alloc &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return CE_Failure;
+    }
+    const auto paSrcData =
+        reinterpret_cast<const SourceDT *>(m_abyWrkBuffer.data());
+
+    const GDALRIOResampleAlg eResampleAlgBack = psExtraArg->eResampleAlg;
+    if (!m_osResampling.empty())
+    {
+        psExtraArg->eResampleAlg = GDALRasterIOGetResampleAlg(m_osResampling);
+    }
+
+    const CPLErr eErr = poSourceBand->RasterIO(
+        GF_Read, nReqXOff, nReqYOff, nReqXSize, nReqYSize,
+        m_abyWrkBuffer.data(), nOutXSize, nOutYSize, eSourceType,
+        sizeof(SourceDT), sizeof(SourceDT) * static_cast<GSpacing>(nOutXSize),
+        psExtraArg);
+    if (!m_osResampling.empty())
+        psExtraArg->eResampleAlg = eResampleAlgBack;
+
+    if (eErr != CE_None)
+    {
+        return eErr;
+    }
+
+    const GDALColorTable *poColorTable = nullptr;
+    if (m_nColorTableComponent != 0)
+    {
+        poColorTable = poSourceBand->GetColorTable();
+        if (poColorTable == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Source band has no color table.");
+            return CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Compute the output value of each possible source value.         */
+    /* -------------------------------------------------------------------- */
+    const bool bNoDataSet = (m_nProcessingFlags & PROCESSING_FLAG_NODATA) != 0;
+    const double dfNoDataValue = GetAdjustedNoDataValue();
+    const bool bNoDataSetAndNotNan =
+        bNoDataSet && !CPLIsNan(dfNoDataValue) &&
+        GDALIsValueInRange<WorkingDT>(dfNoDataValue);
+    const auto fWorkingDataTypeNoData = static_cast<WorkingDT>(dfNoDataValue);
+
+    const int nBufTypeSize = GDALGetDataTypeSizeBytes(eBufType);
+    std::vector<GByte> abyTable;
+    std::vector<GByte> abyStatus;
+    try
+    {
+        abyTable.resize(static_cast<size_t>(TABLE_SIZE) * nBufTypeSize);
+        abyStatus.resize(TABLE_SIZE);
+    }
+    catch (const std::bad_alloc &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return CE_Failure;
+    }
+    for (int i = 0; i < TABLE_SIZE; ++i)
+    {
+        WorkingDT afResult[2] = {static_cast<WorkingDT>(i), 0};
+        if (bNoDataSetAndNotNan &&
+            ARE_REAL_EQUAL(afResult[0], fWorkingDataTypeNoData))
+        {
+            abyStatus[i] = PROCESS_VALUE_NODATA;
+            continue;
+        }
+        const int nStatus =
+            ProcessRealValue(poSourceBand, poColorTable, afResult[0]);
+        if (nStatus == PROCESS_VALUE_ERROR)
+            return CE_Failure;
+        abyStatus[i] = static_cast<GByte>(nStatus);
+        if (nStatus == PROCESS_VALUE_VALID)
+        {
+            WriteProcessedValue(afResult, eWrkDataType, eVRTBandDataType,
+                                eBufType, &abyTable[i * nBufTypeSize]);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Apply the table.                                                */
+    /* -------------------------------------------------------------------- */
+    size_t idxBuffer = 0;
+    for (int iY = 0; iY < nOutYSize; iY++)
+    {
+        GByte *pDstLocation = static_cast<GByte *>(pData) +
+                              static_cast<GPtrDiff_t>(nLineSpace) * iY;
+        if (nBufTypeSize == 1)
+        {
+            for (int iX = 0; iX < nOutXSize;
+                 iX++, pDstLocation += nPixelSpace, idxBuffer++)
+            {
+                const SourceDT nVal = paSrcData[idxBuffer];
+                if (abyStatus[nVal] == PROCESS_VALUE_VALID)
+                    *pDstLocation = abyTable[nVal];
+                else if (abyStatus[nVal] == PROCESS_VALUE_NO_COLOR_ENTRY)
+                    WarnNoColorEntry(nVal);
+            }
+        }
+        else
+        {
+            for (int iX = 0; iX < nOutXSize;
+                 iX++, pDstLocation += nPixelSpace, idxBuffer++)
+            {
+                const SourceDT nVal = paSrcData[idxBuffer];
+                if (abyStatus[nVal] == PROCESS_VALUE_VALID)
+                {
+                    memcpy(pDstLocation, &abyTable[nVal * nBufTypeSize],
+                           nBufTypeSize);
+                }
+                else if (abyStatus[nVal] == PROCESS_VALUE_NO_COLOR_ENTRY)
+                    WarnNoColorEntry(nVal);
+            }
+        }
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                          RasterIOInternal()                          */
 /************************************************************************/
@@ -2879,83 +3322,16 @@ CPLErr VRTComplexSource::RasterIOInternal(
                 if (pabyMask && pabyMask[idxBuffer] == 0)
                     continue;
 
-                if (poColorTable)
+                const int nStatus =
+                    ProcessRealValue(poSourceBand, poColorTable, fResult);
+                if (nStatus == PROCESS_VALUE_ERROR)
+                    return CE_Failure;
+                if (nStatus == PROCESS_VALUE_NO_COLOR_ENTRY)
                 {
-                    const GDALColorEntry *poEntry =
-                        poColorTable->GetColorEntry(static_cast<int>(fResult));
-                    if (poEntry)
-                    {
-                        if (m_nColorTableComponent == 1)
-                            fResult = poEntry->c1;
-                        else if (m_nColorTableComponent == 2)
-                            fResult = poEntry->c2;
-                        else if (m_nColorTableComponent == 3)
-                            fResult = poEntry->c3;
-                        else if (m_nColorTableComponent == 4)
-                            fResult = poEntry->c4;
-                    }
-                    else
-                    {
-                        static bool bHasWarned = false;
-                        if (!bHasWarned)
-                        {
-                            bHasWarned = true;
-                            CPLError(CE_Failure, CPLE_AppDefined,
-                                     "No entry %d.", static_cast<int>(fResult));
-                        }
-                        continue;
-                    }
-                }
-
-                if ((m_nProcessingFlags & PROCESSING_FLAG_SCALING_LINEAR) != 0)
-                {
-                    fResult = static_cast<WorkingDT>(fResult * m_dfScaleRatio +
-                                                     m_dfScaleOff);
-                }
-                else if ((m_nProcessingFlags &
-                          PROCESSING_FLAG_SCALING_EXPONENTIAL) != 0)
-                {
-                    if (!m_bSrcMinMaxDefined)
-                    {
-                        int bSuccessMin = FALSE;
-                        int bSuccessMax = FALSE;
-                        double adfMinMax[2] = {
-                            poSourceBand->GetMinimum(&bSuccessMin),
-                            poSourceBand->GetMaximum(&bSuccessMax)};
-                        if ((bSuccessMin && bSuccessMax) ||
-                            poSourceBand->ComputeRasterMinMax(
-                                TRUE, adfMinMax) == CE_None)
-                        {
-                            m_dfSrcMin = adfMinMax[0];
-                            m_dfSrcMax = adfMinMax[1];
-                            m_bSrcMinMaxDefined = true;
-                        }
-                        else
-                        {
-                            CPLError(CE_Failure, CPLE_AppDefined,
-                                     "Cannot determine source min/max value");
-                            return CE_Failure;
-                        }
-                    }
-
-                    double dfPowVal =
-                        (fResult - m_dfSrcMin) / (m_dfSrcMax - m_dfSrcMin);
-                    if (dfPowVal < 0.0)
-                        dfPowVal = 0.0;
-                    else if (dfPowVal > 1.0)
-                        dfPowVal = 1.0;
-                    fResult =
-                        static_cast<WorkingDT>((m_dfDstMax - m_dfDstMin) *
-                                                   pow(dfPowVal, m_dfExponent) +
-                                               m_dfDstMin);
+                    WarnNoColorEntry(static_cast<int>(pafData[idxBuffer]));
+                    continue;
                 }
 
-                if (!m_adfLUTInputs.empty())
-                    fResult = static_cast<WorkingDT>(LookupValue(fResult));
-
-                if (m_nMaxValue != 0 && fResult > m_nMaxValue)
-                    fResult = static_cast<WorkingDT>(m_nMaxValue);
-
                 afResult[0] = fResult;
                 afResult[1] = 0;
             }
@@ -2988,27 +3364,8 @@ CPLErr VRTComplexSource::RasterIOInternal(
                     afResult[0] = static_cast<WorkingDT>(m_nMaxValue);
             }
 
-            if (eBufType == GDT_Byte && eVRTBandDataType == GDT_Byte)
-            {
-                *pDstLocation = static_cast<GByte>(std::min(
-                    255.0f,
-                    std::max(0.0f, static_cast<float>(afResult[0]) + 0.5f)));
-            }
-            else if (eBufType == eVRTBandDataType)
-            {
-                GDALCopyWords(afResult, eWrkDataType, 0, pDstLocation, eBufType,
-                              0, 1);
-            }
-            else
-            {
-                GByte abyTemp[2 * sizeof(double)];
-                // Convert first to the VRTRasterBand data type
-                // to get its clamping, before outputting to buffer data type
-                GDALCopyWords(afResult, eWrkDataType, 0, abyTemp,
-                              eVRTBandDataType, 0, 1);
-                GDALCopyWords(abyTemp, eVRTBandDataType, 0, pDstLocation,
-                              eBufType, 0, 1);
-            }
+            WriteProcessedValue(afResult, eWrkDataType, eVRTBandDataType,
+                                eBufType, pDstLocation);
         }
     }
 
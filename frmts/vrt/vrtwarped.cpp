@@ -1702,6 +1702,108 @@ void VRTWarpedDataset::GetBlockSize(int *pnBlockXSize, int *pnBlockYSize) const
     *pnBlockYSize = m_nBlockYSize;
 }
 
+/************************************************************************/
+/*                              IRasterIO()                             */
+/************************************************************************/
+
+CPLErr VRTWarpedDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
+                                   int nXSize, int nYSize, void *pData,
+                                   int nBufXSize, int nBufYSize,
+                                   GDALDataType eBufType, int nBandCount,
+                                   int *panBandMap, GSpacing nPixelSpace,
+                                   GSpacing nLineSpace, GSpacing nBandSpace,
+                                   GDALRasterIOExtraArg *psExtraArg)
+{
+    if (eRWFlag == GF_Read && nXSize == nBufXSize && nYSize == nBufYSize)
+    {
+        if (ProcessMissingBlocks(nXOff, nYOff, nXSize, nYSize) != CE_None)
+            return CE_Failure;
+    }
+
+    return VRTDataset::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize, pData,
+                                 nBufXSize, nBufYSize, eBufType, nBandCount,
+                                 panBandMap, nPixelSpace, nLineSpace,
+                                 nBandSpace, psExtraArg);
+}
+
+/************************************************************************/
+/*                        ProcessMissingBlocks()                        */
+/*                                                                      */
+/*      When the warp kernel is multi-threaded, warp all the blocks     */
+/*      intersecting a read request in a few large regions rather       */
+/*      than block per block, so that the kernel threads and the        */
+/*      approximate transformer work on bigger chunks. This is only     */
+/*      done if none of those blocks is already in the block cache.     */
+/************************************************************************/
+
+CPLErr VRTWarpedDataset::ProcessMissingBlocks(int nXOff, int nYOff, int nXSize,
+                                              int nYSize)
+{
+    if (m_poWarper == nullptr || m_bProcessingMissingBlocks ||
+        nXSize <= 0 || nYSize <= 0)
+        return CE_None;
+
+    const GDALWarpOptions *psWO = m_poWarper->GetOptions();
+    if (psWO->nBandCount == 0 || psWO->panDstBands[0] > nBands)
+        return CE_None;
+
+    const int nBlockX0 = nXOff / m_nBlockXSize;
+    const int nBlockY0 = nYOff / m_nBlockYSize;
+    const int nBlocksX = (nXOff + nXSize - 1) / m_nBlockXSize - nBlockX0 + 1;
+    const int nBlocksY = (nYOff + nYSize - 1) / m_nBlockYSize - nBlockY0 + 1;
+    if (nBlocksX == 1 && nBlocksY == 1)
+        return CE_None;
+
+    // Same logic as GWKThreadsCreate()
+    const char *pszWarpThreads =
+        CSLFetchNameValue(psWO->papszWarpOptions, "NUM_THREADS");
+    if (pszWarpThreads == nullptr)
+        pszWarpThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = EQUAL(pszWarpThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszWarpThreads);
+    if (nThreads <= 1)
+        return CE_None;
+
+    GDALRasterBand *poBand = GetRasterBand(psWO->panDstBands[0]);
+    for (int iBlockY = nBlockY0; iBlockY < nBlockY0 + nBlocksY; iBlockY++)
+    {
+        for (int iBlockX = nBlockX0; iBlockX < nBlockX0 + nBlocksX; iBlockX++)
+        {
+            GDALRasterBlock *poBlock =
+                poBand->TryGetLockedBlockRef(iBlockX, iBlockY);
+            if (poBlock != nullptr)
+            {
+                poBlock->DropLock();
+                return CE_None;
+            }
+        }
+    }
+
+    // Bound the size of the destination buffer of each warped region
+    // to half of the warp memory limit.
+    const double dfBytesPerBlockRow =
+        static_cast<double>(nBlocksX) * m_nBlockXSize * m_nBlockYSize *
+        GDALGetDataTypeSizeBytes(psWO->eWorkingDataType) * psWO->nBandCount;
+    const int nBlockRowsPerRegion = static_cast<int>(std::max(
+        1.0, std::min(static_cast<double>(nBlocksY),
+                      psWO->dfWarpMemoryLimit / 2 / dfBytesPerBlockRow)));
+
+    m_bProcessingMissingBlocks = true;
+    CPLErr eErr = CE_None;
+    for (int iBlockY = nBlockY0;
+         eErr == CE_None && iBlockY < nBlockY0 + nBlocksY;
+         iBlockY += nBlockRowsPerRegion)
+    {
+        eErr = ProcessBlocks(
+            nBlockX0, iBlockY, nBlocksX,
+            std::min(nBlockRowsPerRegion, nBlockY0 + nBlocksY - iBlockY));
+    }
+    m_bProcessingMissingBlocks = false;
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                            ProcessBlock()                            */
 /*                                                                      */
@@ -1711,16 +1813,32 @@ void VRTWarpedDataset::GetBlockSize(int *pnBlockXSize, int *pnBlockYSize) const
 
 CPLErr VRTWarpedDataset::ProcessBlock(int iBlockX, int iBlockY)
 
+{
+    return ProcessBlocks(iBlockX, iBlockY, 1, 1);
+}
+
+/************************************************************************/
+/*                           ProcessBlocks()                            */
+/*                                                                      */
+/*      Warp a rectangle of nBlocksX x nBlocksY blocks at once, and     */
+/*      then push each band of the result into the block cache.         */
+/************************************************************************/
+
+CPLErr VRTWarpedDataset::ProcessBlocks(int iBlockX, int iBlockY, int nBlocksX,
+                                       int nBlocksY)
+
 {
     if (m_poWarper == nullptr)
         return CE_Failure;
 
-    int nReqXSize = m_nBlockXSize;
-    if (iBlockX * m_nBlockXSize + nReqXSize > nRasterXSize)
-        nReqXSize = nRasterXSize - iBlockX * m_nBlockXSize;
-    int nReqYSize = m_nBlockYSize;
-    if (iBlockY * m_nBlockYSize + nReqYSize > nRasterYSize)
-        nReqYSize = nRasterYSize - iBlockY * m_nBlockYSize;
+    const int nReqXOff = iBlockX * m_nBlockXSize;
+    const int nReqYOff = iBlockY * m_nBlockYSize;
+    int nReqXSize = nBlocksX * m_nBlockXSize;
+    if (nReqXOff + nReqXSize > nRasterXSize)
+        nReqXSize = nRasterXSize - nReqXOff;
+    int nReqYSize = nBlocksY * m_nBlockYSize;
+    if (nReqYOff + nReqYSize > nRasterYSize)
+        nReqYSize = nRasterYSize - nReqYOff;
 
     GByte *pabyDstBuffer = static_cast<GByte *>(
         m_poWarper->CreateDestinationBuffer(nReqXSize, nReqYSize));
@@ -1735,9 +1853,9 @@ CPLErr VRTWarpedDataset::ProcessBlock(int iBlockX, int iBlockY)
     /* -------------------------------------------------------------------- */
 
     const GDALWarpOptions *psWO = m_poWarper->GetOptions();
-    const CPLErr eErr = m_poWarper->WarpRegionToBuffer(
-        iBlockX * m_nBlockXSize, iBlockY * m_nBlockYSize, nReqXSize, nReqYSize,
-        pabyDstBuffer, psWO->eWorkingDataType);
+    const CPLErr eErr =
+        m_poWarper->WarpRegionToBuffer(nReqXOff, nReqYOff, nReqXSize, nReqYSize,
+                                       pabyDstBuffer, psWO->eWorkingDataType);
 
     if (eErr != CE_None)
     {
@@ -1758,45 +1876,64 @@ CPLErr VRTWarpedDataset::ProcessBlock(int iBlockX, int iBlockY)
         }
 
         GDALRasterBand *poBand = GetRasterBand(nDstBand);
-        GDALRasterBlock *poBlock =
-            poBand->GetLockedBlockRef(iBlockX, iBlockY, TRUE);
-
         const GByte *pabyDstBandBuffer =
             pabyDstBuffer +
             static_cast<GPtrDiff_t>(i) * nReqXSize * nReqYSize * nWordSize;
 
-        if (poBlock != nullptr)
+        for (int iY = 0; iY < nBlocksY; iY++)
         {
-            if (poBlock->GetDataRef() != nullptr)
+            const int nBlockYOff = iY * m_nBlockYSize;
+            const int nBlockReqYSize =
+                std::min(m_nBlockYSize, nReqYSize - nBlockYOff);
+            for (int iX = 0; iX < nBlocksX; iX++)
             {
-                if (nReqXSize == m_nBlockXSize && nReqYSize == m_nBlockYSize)
-                {
-                    GDALCopyWords64(
-                        pabyDstBandBuffer, psWO->eWorkingDataType, nWordSize,
-                        poBlock->GetDataRef(), poBlock->GetDataType(),
-                        GDALGetDataTypeSizeBytes(poBlock->GetDataType()),
-                        static_cast<GPtrDiff_t>(m_nBlockXSize) * m_nBlockYSize);
-                }
-                else
+                const int nBlockXOff = iX * m_nBlockXSize;
+                const int nBlockReqXSize =
+                    std::min(m_nBlockXSize, nReqXSize - nBlockXOff);
+
+                GDALRasterBlock *poBlock =
+                    poBand->GetLockedBlockRef(iBlockX + iX, iBlockY + iY, TRUE);
+                if (poBlock == nullptr)
+                    continue;
+
+                if (poBlock->GetDataRef() != nullptr)
                 {
+                    const GByte *pabySrc =
+                        pabyDstBandBuffer +
+                        (static_cast<GPtrDiff_t>(nBlockYOff) * nReqXSize +
+                         nBlockXOff) *
+                            nWordSize;
                     GByte *pabyBlock =
                         static_cast<GByte *>(poBlock->GetDataRef());
                     const int nDTSize =
                         GDALGetDataTypeSizeBytes(poBlock->GetDataType());
-                    for (int iY = 0; iY < nReqYSize; iY++)
+                    if (nReqXSize == m_nBlockXSize &&
+                        nBlockReqYSize == m_nBlockYSize)
+                    {
+                        GDALCopyWords64(
+                            pabySrc, psWO->eWorkingDataType, nWordSize,
+                            pabyBlock, poBlock->GetDataType(), nDTSize,
+                            static_cast<GPtrDiff_t>(m_nBlockXSize) *
+                                m_nBlockYSize);
+                    }
+                    else
                     {
-                        GDALCopyWords(
-                            pabyDstBandBuffer + static_cast<GPtrDiff_t>(iY) *
-                                                    nReqXSize * nWordSize,
-                            psWO->eWorkingDataType, nWordSize,
-                            pabyBlock + static_cast<GPtrDiff_t>(iY) *
-                                            m_nBlockXSize * nDTSize,
-                            poBlock->GetDataType(), nDTSize, nReqXSize);
+                        for (int iLine = 0; iLine < nBlockReqYSize; iLine++)
+                        {
+                            GDALCopyWords(
+                                pabySrc + static_cast<GPtrDiff_t>(iLine) *
+                                              nReqXSize * nWordSize,
+                                psWO->eWorkingDataType, nWordSize,
+                                pabyBlock + static_cast<GPtrDiff_t>(iLine) *
+                                                m_nBlockXSize * nDTSize,
+                                poBlock->GetDataType(), nDTSize,
+                                nBlockReqXSize);
+                        }
                     }
                 }
-            }
 
-            poBlock->DropLock();
+                poBlock->DropLock();
+            }
         }
     }
 
@@ -1900,6 +2037,30 @@ CPLErr VRTWarpedRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff,
     return eErr;
 }
 
+/************************************************************************/
+/*                             IRasterIO()                              */
+/************************************************************************/
+
+CPLErr VRTWarpedRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
+                                      int nXSize, int nYSize, void *pData,
+                                      int nBufXSize, int nBufYSize,
+                                      GDALDataType eBufType,
+                                      GSpacing nPixelSpace, GSpacing nLineSpace,
+                                      GDALRasterIOExtraArg *psExtraArg)
+{
+    if (eRWFlag == GF_Read && nXSize == nBufXSize && nYSize == nBufYSize)
+    {
+        VRTWarpedDataset *poWDS = static_cast<VRTWarpedDataset *>(poDS);
+        if (poWDS->ProcessMissingBlocks(nXOff, nYOff, nXSize, nYSize) !=
+            CE_None)
+            return CE_Failure;
+    }
+
+    return VRTRasterBand::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
+                                    pData, nBufXSize, nBufYSize, eBufType,
+                                    nPixelSpace, nLineSpace, psExtraArg);
+}
+
 /************************************************************************/
 /*                            IWriteBlock()                             */
 /************************************************************************/
@@ -909,6 +909,15 @@ GDALDataset *WEBPDataset::CreateCopy(const char *pszFilename,
 #if WEBP_ENCODER_ABI_VERSION >= 0x0209
     FETCH_AND_SET_OPTION_INT("EXACT", exact, 0, 1);
 #endif
+#if WEBP_ENCODER_ABI_VERSION >= 0x0201
+    // libwebp uses its own threads, with a fixed number of them
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads &&
+        (EQUAL(pszNumThreads, "ALL_CPUS") || atoi(pszNumThreads) > 1))
+    {
+        sConfig.thread_level = 1;
+    }
+#endif
 
     if (!WebPValidateConfig(&sConfig))
     {
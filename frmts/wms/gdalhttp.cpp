@@ -212,8 +212,27 @@ CPLErr WMSHTTPFetchMulti(WMSHTTPRequest *pasRequest, int nRequestCount)
                  "CPLHTTPFetchMulti(): Unable to create CURL multi-handle.");
     }
 
-    // add at most max_conn requests
-    int torun = std::min(nRequestCount, max_conn);
+    // Number of requests simultaneously handed to curl
+    int max_in_flight = max_conn;
+#ifdef CURLPIPE_MULTIPLEX
+    // With HTTP/2 servers, several requests can share a single connection.
+    // Connections per host stay limited to max_conn, so HTTP/1.1 servers see
+    // the same load as without multiplexing, the extra transfers being queued
+    // by curl.
+    if (CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES")))
+    {
+        curl_multi_setopt(curl_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        curl_multi_setopt(curl_multi, CURLMOPT_MAX_HOST_CONNECTIONS,
+                          static_cast<long>(max_conn));
+        const int nStreams = std::max(
+            1, std::min(100, atoi(CPLGetConfigOption(
+                                 "GDAL_WMS_STREAMS_PER_CONNECTION", "8"))));
+        max_in_flight = max_conn * nStreams;
+    }
+#endif
+
+    // add at most max_in_flight requests
+    int torun = std::min(nRequestCount, max_in_flight);
     for (conn_i = 0; conn_i < torun; ++conn_i)
     {
         WMSHTTPRequest *const psRequest = &pasRequest[conn_i];
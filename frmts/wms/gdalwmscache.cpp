@@ -32,6 +32,9 @@
 #include "cpl_md5.h"
 #include "wmsdriver.h"
 
+#include <algorithm>
+#include <utility>
+
 static void CleanCacheThread(void *pData)
 {
     GDALWMSCache *pCache = static_cast<GDALWMSCache *>(pData);
@@ -101,6 +104,19 @@ class GDALWMSFileCache : public GDALWMSCacheImpl
         return CE_None;
     }
 
+    // Missing tiles are recorded as empty files
+    virtual CPLErr InsertEmpty(const char *pszKey) override
+    {
+        CPLString soFilePath = GetFilePath(pszKey);
+        MakeDirs(CPLGetDirname(soFilePath));
+        VSILFILE *fp = VSIFOpenL(soFilePath, "wb");
+        if (fp != nullptr && VSIFCloseL(fp) == 0)
+            return CE_None;
+        CPLError(CE_Warning, CPLE_FileIO, "Error writing to WMS cache %s",
+                 m_soPath.c_str());
+        return CE_None;
+    }
+
     virtual enum GDALWMSCacheItemStatus
     GetItemStatus(const char *pszKey) const override
     {
@@ -108,7 +124,9 @@ class GDALWMSFileCache : public GDALWMSCacheImpl
         if (VSIStatL(GetFilePath(pszKey), &sStatBuf) == 0)
         {
             long seconds = static_cast<long>(time(nullptr) - sStatBuf.st_mtime);
-            return seconds < m_nExpires ? CACHE_ITEM_OK : CACHE_ITEM_EXPIRED;
+            if (seconds >= m_nExpires)
+                return CACHE_ITEM_EXPIRED;
+            return sStatBuf.st_size == 0 ? CACHE_ITEM_EMPTY : CACHE_ITEM_OK;
         }
         return CACHE_ITEM_NOT_FOUND;
     }
@@ -132,6 +150,8 @@ class GDALWMSFileCache : public GDALWMSCacheImpl
 
         int counter = 0;
         std::vector<int> toDelete;
+        // (modification time, size, index in papszList) of not expired files
+        std::vector<std::pair<time_t, std::pair<long, int>>> aoValidFiles;
         long nSize = 0;
         time_t nTime = time(nullptr);
         while (papszList[counter] != nullptr)
@@ -148,6 +168,13 @@ class GDALWMSFileCache : public GDALWMSCacheImpl
                     {
                         toDelete.push_back(counter);
                     }
+                    else
+                    {
+                        aoValidFiles.push_back(std::make_pair(
+                            sStatBuf.st_mtime,
+                            std::make_pair(static_cast<long>(sStatBuf.st_size),
+                                           counter)));
+                    }
 
                     nSize += static_cast<long>(sStatBuf.st_size);
                 }
@@ -157,6 +184,30 @@ class GDALWMSFileCache : public GDALWMSCacheImpl
 
         if (nSize > m_nMaxSize)
         {
+            // If removing expired files is not enough, also remove the
+            // oldest valid ones.
+            long nRemainingSize = nSize;
+            for (int i : toDelete)
+            {
+                VSIStatBufL sStatBuf;
+                if (VSIStatL(CPLFormFilename(m_soPath, papszList[i], nullptr),
+                             &sStatBuf) == 0)
+                {
+                    nRemainingSize -= static_cast<long>(sStatBuf.st_size);
+                }
+            }
+            if (nRemainingSize > m_nMaxSize)
+            {
+                std::sort(aoValidFiles.begin(), aoValidFiles.end());
+                for (const auto &oFile : aoValidFiles)
+                {
+                    if (nRemainingSize <= m_nMaxSize)
+                        break;
+                    toDelete.push_back(oFile.second.second);
+                    nRemainingSize -= oFile.second.first;
+                }
+            }
+
             CPLDebug("WMS", "Delete %u items from cache",
                      static_cast<unsigned int>(toDelete.size()));
             for (size_t i = 0; i < toDelete.size(); ++i)
@@ -256,6 +307,9 @@ CPLErr GDALWMSCache::Initialize(const char *pszUrl, CPLXMLNode *pConfig)
             CPLFormFilename(m_osCachePath, CPLMD5String(pszUrl), nullptr);
     }
 
+    m_bNegativeCache =
+        CPLTestBool(CPLGetXMLValue(pConfig, "NegativeCache", "true"));
+
     // TODO: Add sqlite db cache type
     const char *pszType = CPLGetXMLValue(pConfig, "Type", "file");
     if (EQUAL(pszType, "file"))
@@ -292,6 +346,13 @@ CPLErr GDALWMSCache::Insert(const char *pszKey, const CPLString &soFileName)
     return CE_Failure;
 }
 
+CPLErr GDALWMSCache::InsertEmpty(const char *pszKey)
+{
+    if (m_poCache != nullptr && pszKey != nullptr && m_bNegativeCache)
+        return m_poCache->InsertEmpty(pszKey);
+    return CE_Failure;
+}
+
 enum GDALWMSCacheItemStatus
 GDALWMSCache::GetItemStatus(const char *pszKey) const
 {
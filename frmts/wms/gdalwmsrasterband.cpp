@@ -152,7 +152,22 @@ CPLErr GDALWMSRasterBand::ReadBlocks(int x, int y, void *buffer, int bx0,
                 }
                 if (ret == CE_None && cache != nullptr)
                 {
-                    if (cache->GetItemStatus(request.URL) == CACHE_ITEM_OK)
+                    const auto eStatus = cache->GetItemStatus(request.URL);
+                    if (eStatus == CACHE_ITEM_EMPTY)
+                    {
+                        // Tile known to be missing from a previous request
+                        if (!advise_read)
+                        {
+                            if (EmptyBlock(ix, iy, nBand, p) != CE_None)
+                            {
+                                CPLError(CE_Failure, CPLE_AppDefined,
+                                         "GDALWMS: EmptyBlock failed.");
+                                ret = CE_Failure;
+                            }
+                        }
+                        need_this_block = false;
+                    }
+                    else if (eStatus == CACHE_ITEM_OK)
                     {
                         if (advise_read)
                         {
@@ -292,6 +307,8 @@ CPLErr GDALWMSRasterBand::ReadBlocks(int x, int y, void *buffer, int bx0,
                             request.nStatus) !=
                         m_parent_dataset->m_http_zeroblock_codes.end())
                     {
+                        if (m_parent_dataset->m_cache != nullptr)
+                            m_parent_dataset->m_cache->InsertEmpty(request.URL);
                         if (!advise_read)
                         {
                             ret = EmptyBlock(request.x, request.y, nBand, p);
@@ -254,7 +254,8 @@ enum GDALWMSCacheItemStatus
 {
     CACHE_ITEM_NOT_FOUND,
     CACHE_ITEM_OK,
-    CACHE_ITEM_EXPIRED
+    CACHE_ITEM_EXPIRED,
+    CACHE_ITEM_EMPTY  // not expired negative cache entry, for a missing tile
 };
 
 class GDALWMSCacheImpl
@@ -268,6 +269,7 @@ class GDALWMSCacheImpl
     {
     }
     virtual CPLErr Insert(const char *pszKey, const CPLString &osFileName) = 0;
+    virtual CPLErr InsertEmpty(const char *pszKey) = 0;
     virtual enum GDALWMSCacheItemStatus
     GetItemStatus(const char *pszKey) const = 0;
     virtual GDALDataset *GetDataset(const char *pszKey,
@@ -290,6 +292,7 @@ class GDALWMSCache
   public:
     CPLErr Initialize(const char *pszUrl, CPLXMLNode *pConfig);
     CPLErr Insert(const char *pszKey, const CPLString &osFileName);
+    CPLErr InsertEmpty(const char *pszKey);
     enum GDALWMSCacheItemStatus GetItemStatus(const char *pszKey) const;
     GDALDataset *GetDataset(const char *pszKey, char **papszOpenOptions) const;
     void Clean();
@@ -304,6 +307,7 @@ class GDALWMSCache
     CPLString m_osCachePath;
     bool m_bIsCleanThreadRunning;
     time_t m_nCleanThreadLastRunTime;
+    bool m_bNegativeCache = true;
 
   private:
     GDALWMSCacheImpl *m_poCache;
@@ -31,6 +31,7 @@
 
 #include "cpl_compressor.h"
 #include "cpl_json.h"
+#include "cpl_mem_cache.h"
 #include "gdal_priv.h"
 #include "gdal_pam.h"
 #include "memmultidim.h"
@@ -1377,6 +1378,73 @@ class ZarrV3CodecTranspose final : public ZarrV3Codec
                 ZarrByteVectorQuickResize &abyDst) const override;
 };
 
+/************************************************************************/
+/*                      ZarrV3CodecShardingIndexed                      */
+/************************************************************************/
+
+class ZarrV3CodecSequence;
+
+// Implements https://zarr-specs.readthedocs.io/en/latest/v3/codecs/sharding-indexed/v1.0.html
+// Shards are not decoded as a whole: ZarrV3Array exposes the inner chunks
+// as its blocks, and reads them individually from the shard.
+class ZarrV3CodecShardingIndexed final : public ZarrV3Codec
+{
+    std::vector<size_t> m_anInnerBlockSize{};
+    std::unique_ptr<ZarrV3CodecSequence> m_poInnerCodecs{};
+    bool m_bIndexLocationAtEnd = true;
+    bool m_bIndexHasChecksum = false;
+
+  public:
+    static constexpr const char *NAME = "sharding_indexed";
+
+    ZarrV3CodecShardingIndexed();
+    ~ZarrV3CodecShardingIndexed() override;
+
+    IOType GetInputType() const override
+    {
+        return IOType::ARRAY;
+    }
+    IOType GetOutputType() const override
+    {
+        return IOType::BYTES;
+    }
+
+    bool
+    InitFromConfiguration(const CPLJSONObject &configuration,
+                          const ZarrArrayMetadata &oInputArrayMetadata,
+                          ZarrArrayMetadata &oOutputArrayMetadata) override;
+
+    std::unique_ptr<ZarrV3Codec> Clone() const override;
+
+    bool Encode(const ZarrByteVectorQuickResize &abySrc,
+                ZarrByteVectorQuickResize &abyDst) const override;
+    bool Decode(const ZarrByteVectorQuickResize &abySrc,
+                ZarrByteVectorQuickResize &abyDst) const override;
+
+    const std::vector<size_t> &GetInnerBlockSize() const
+    {
+        return m_anInnerBlockSize;
+    }
+
+    const ZarrV3CodecSequence *GetInnerCodecs() const
+    {
+        return m_poInnerCodecs.get();
+    }
+
+    bool IsIndexLocationAtEnd() const
+    {
+        return m_bIndexLocationAtEnd;
+    }
+
+    bool IndexHasChecksum() const
+    {
+        return m_bIndexHasChecksum;
+    }
+
+    static bool VerifyIndexChecksum(const GByte *pabyIndex,
+                                    size_t nIndexSize);
+};
+
 /************************************************************************/
 /*                          ZarrV3CodecSequence                         */
 /************************************************************************/
@@ -1406,6 +1474,9 @@ class ZarrV3CodecSequence
         return m_oCodecArray;
     }
 
+    // Returns the sharding codec, if it is the codec of the sequence
+    const ZarrV3CodecShardingIndexed *GetShardingCodec() const;
+
     bool Encode(ZarrByteVectorQuickResize &abyBuffer);
     bool Decode(ZarrByteVectorQuickResize &abyBuffer);
 };
@@ -1419,6 +1490,17 @@ class ZarrV3Array final : public ZarrArray
     bool m_bV2ChunkKeyEncoding = false;
     std::unique_ptr<ZarrV3CodecSequence> m_poCodecs{};
 
+    // Sharding: when m_anShardSize is not empty, m_anBlockSize is the shape
+    // of the inner chunks, and m_poCodecs their codecs.
+    std::vector<GUInt64> m_anShardSize{};
+    bool m_bShardIndexAtEnd = true;
+    bool m_bShardIndexHasChecksum = false;
+    CPLJSONObject m_oShardingCodecs{};
+    // Key is the shard filename. A null value means a missing shard.
+    mutable lru11::Cache<std::string, std::shared_ptr<std::vector<uint64_t>>,
+                         std::mutex>
+        m_oShardIndexCache{};
+
     ZarrV3Array(const std::shared_ptr<ZarrSharedResource> &poSharedResource,
                 const std::string &osParentName, const std::string &osName,
                 const std::vector<std::shared_ptr<GDALDimension>> &aoDims,
@@ -1440,6 +1522,27 @@ class ZarrV3Array final : public ZarrArray
                       ZarrByteVectorQuickResize &abyDecodedTileData,
                       bool &bMissingTileOut) const;
 
+    void GetShardIndices(const uint64_t *tileIndices,
+                         std::vector<uint64_t> &anShardIndices,
+                         size_t &nIdxInShard) const;
+
+    bool GetShardIndex(const std::string &osShardFilename,
+                       std::shared_ptr<std::vector<uint64_t>> &panIndex) const;
+
+    bool DecodeShardTile(const std::string &osName,
+                         ZarrV3CodecSequence *poCodecs,
+                         ZarrByteVectorQuickResize &abyRawTileData,
+                         ZarrByteVectorQuickResize &abyDecodedTileData) const;
+
+    bool LoadTileDataFromShard(const uint64_t *tileIndices,
+                               ZarrV3CodecSequence *poCodecs,
+                               ZarrByteVectorQuickResize &abyRawTileData,
+                               ZarrByteVectorQuickResize &abyDecodedTileData,
+                               bool &bMissingTileOut) const;
+
+    bool AdviseReadSharded(const std::vector<uint64_t> &anReqTilesIndices,
+                           size_t nReqTiles, int nThreadsMax) const;
+
   public:
     ~ZarrV3Array() override;
 
@@ -1461,6 +1564,15 @@ class ZarrV3Array final : public ZarrArray
         m_poCodecs = std::move(poCodecs);
     }
 
+    bool IsSharded() const
+    {
+        return !m_anShardSize.empty();
+    }
+
+    void SetSharding(const std::vector<GUInt64> &anShardSize,
+                     const ZarrV3CodecShardingIndexed *poShardingCodec,
+                     const CPLJSONObject &oShardingCodecs);
+
     void Flush() override;
 
   protected:
@@ -1478,6 +1590,11 @@ class ZarrV3Array final : public ZarrArray
     bool LoadTileData(const uint64_t *tileIndices,
                       bool &bMissingTileOut) const override;
 
+    bool IWrite(const GUInt64 *arrayStartIdx, const size_t *count,
+                const GInt64 *arrayStep, const GPtrDiff_t *bufferStride,
+                const GDALExtendedDataType &bufferDataType,
+                const void *pSrcBuffer) override;
+
     bool IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
                      CSLConstList papszOptions) const override;
 };
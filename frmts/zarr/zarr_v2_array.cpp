@@ -529,7 +529,10 @@ bool ZarrV2Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
         }
         else
         {
-            ZarrByteVectorQuickResize abyCompressedData;
+            // Use the temporary buffer to hold the compressed data, so that
+            // its allocation is reused from one tile to another. Filters and
+            // transposition only need it after decompression.
+            ZarrByteVectorQuickResize &abyCompressedData = abyTmpRawTileData;
             try
             {
                 abyCompressedData.resize(static_cast<size_t>(nSize));
@@ -555,6 +558,13 @@ bool ZarrV2Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
             else
             {
                 void *out_buffer = &abyRawTileData[0];
+                // The array does not know the dataset: use the default one
+                // of the thread (set by GDALDatasetFromArray).
+                GDALCodecStatisticsRecorder oRecorder(
+                    nullptr, GDALCodecStatisticsRecorder::Operation::DECODE);
+                oRecorder.SetEncodedSize(
+                    static_cast<GIntBig>(abyCompressedData.size()));
+                oRecorder.SetDecodedSize(static_cast<GIntBig>(nRawDataSize));
                 if (!psDecompressor->pfnFunc(
                         abyCompressedData.data(), abyCompressedData.size(),
                         &out_buffer, &nRawDataSize, nullptr,
@@ -572,6 +582,13 @@ bool ZarrV2Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
     if (!bRet)
         return false;
 
+    if (psDecompressor && (m_bFortranOrder || m_oFiltersArray.Size() != 0))
+    {
+        // Restore the size set by AllocateWorkingBuffers(). Capacity is
+        // at least the tile size, so this does not reallocate.
+        abyTmpRawTileData.resize(m_nTileSize);
+    }
+
     for (int i = m_oFiltersArray.Size(); i > 0;)
     {
         --i;
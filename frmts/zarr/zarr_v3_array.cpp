@@ -159,7 +159,8 @@ void ZarrV3Array::Serialize(const CPLJSONObject &oAttrs)
         CPLJSONObject oConfiguration;
         oChunkGrid.Add("configuration", oConfiguration);
         CPLJSONArray oChunks;
-        for (const auto nBlockSize : m_anBlockSize)
+        for (const auto nBlockSize :
+             IsSharded() ? m_anShardSize : m_anBlockSize)
         {
             oChunks.Add(static_cast<GInt64>(nBlockSize));
         }
@@ -217,7 +218,11 @@ void ZarrV3Array::Serialize(const CPLJSONObject &oAttrs)
         }
     }
 
-    if (m_poCodecs)
+    if (IsSharded())
+    {
+        oRoot.Add("codecs", m_oShardingCodecs);
+    }
+    else if (m_poCodecs)
     {
         oRoot.Add("codecs", m_poCodecs->GetJSon());
     }
@@ -394,6 +399,12 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
 
     bMissingTileOut = false;
 
+    if (IsSharded())
+    {
+        return LoadTileDataFromShard(tileIndices, poCodecs, abyRawTileData,
+                                     abyDecodedTileData, bMissingTileOut);
+    }
+
     std::string osFilename = BuildTileFilename(tileIndices);
 
     // For network file systems, get the streaming version of the filename,
@@ -509,6 +520,12 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
             }
             else
             {
+                // The array does not know the dataset: use the default one
+                // of the thread (set by GDALDatasetFromArray).
+                GDALCodecStatisticsRecorder oRecorder(
+                    nullptr, GDALCodecStatisticsRecorder::Operation::DECODE);
+                oRecorder.SetEncodedSize(
+                    static_cast<GIntBig>(abyRawTileData.size()));
                 if (!poCodecs->Decode(abyRawTileData))
                 {
                     CPLError(CE_Failure, CPLE_AppDefined,
@@ -516,6 +533,8 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
                              osFilename.c_str());
                     bRet = false;
                 }
+                oRecorder.SetDecodedSize(
+                    static_cast<GIntBig>(abyRawTileData.size()));
             }
         }
     }
@@ -557,6 +576,289 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
 #undef m_poCodecs
 }
 
+/************************************************************************/
+/*                      ZarrV3Array::SetSharding()                      */
+/************************************************************************/
+
+void ZarrV3Array::SetSharding(const std::vector<GUInt64> &anShardSize,
+                              const ZarrV3CodecShardingIndexed *poShardingCodec,
+                              const CPLJSONObject &oShardingCodecs)
+{
+    m_anShardSize = anShardSize;
+    m_bShardIndexAtEnd = poShardingCodec->IsIndexLocationAtEnd();
+    m_bShardIndexHasChecksum = poShardingCodec->IndexHasChecksum();
+    m_oShardingCodecs = oShardingCodecs.Clone();
+    m_poCodecs = poShardingCodec->GetInnerCodecs()->Clone();
+}
+
+/************************************************************************/
+/*                    ZarrV3Array::GetShardIndices()                    */
+/************************************************************************/
+
+// Compute the indices of the shard containing the inner chunk of indices
+// tileIndices, and the rank of that inner chunk in the shard index.
+void ZarrV3Array::GetShardIndices(const uint64_t *tileIndices,
+                                  std::vector<uint64_t> &anShardIndices,
+                                  size_t &nIdxInShard) const
+{
+    const size_t nDims = m_aoDims.size();
+    anShardIndices.resize(nDims);
+    nIdxInShard = 0;
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        const uint64_t nTilesPerShard = m_anShardSize[i] / m_anBlockSize[i];
+        anShardIndices[i] = tileIndices[i] / nTilesPerShard;
+        nIdxInShard = static_cast<size_t>(nIdxInShard * nTilesPerShard +
+                                          tileIndices[i] % nTilesPerShard);
+    }
+}
+
+/************************************************************************/
+/*                     ZarrV3Array::GetShardIndex()                     */
+/************************************************************************/
+
+// Return the (offset, size) pairs of the inner chunks of a shard, reading
+// them from the shard the first time. panIndex is set to null if the shard
+// does not exist.
+bool ZarrV3Array::GetShardIndex(
+    const std::string &osShardFilename,
+    std::shared_ptr<std::vector<uint64_t>> &panIndex) const
+{
+    // This method may be called concurrently from several threads.
+    if (m_oShardIndexCache.tryGet(osShardFilename, panIndex))
+        return true;
+
+    size_t nEntries = 1;
+    for (size_t i = 0; i < m_anShardSize.size(); ++i)
+    {
+        nEntries *= static_cast<size_t>(m_anShardSize[i] / m_anBlockSize[i]);
+    }
+    constexpr size_t ENTRY_SIZE = 2 * sizeof(uint64_t);
+    const size_t nChecksumSize =
+        m_bShardIndexHasChecksum ? sizeof(uint32_t) : 0;
+    if (nEntries > (std::numeric_limits<size_t>::max() - nChecksumSize) /
+                       ENTRY_SIZE / 2)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Too large shard index");
+        return false;
+    }
+    const size_t nIndexSize = nEntries * ENTRY_SIZE + nChecksumSize;
+
+    const char *const apszOpenOptions[] = {"IGNORE_FILENAME_RESTRICTIONS=YES",
+                                           nullptr};
+    VSILFILE *fp =
+        VSIFOpenEx2L(osShardFilename.c_str(), "rb", 0, apszOpenOptions);
+    if (fp == nullptr)
+    {
+        // Missing files are OK and indicate nodata_value
+        CPLDebugOnly(ZARR_DEBUG_KEY, "Shard %s missing (=nodata)",
+                     osShardFilename.c_str());
+        panIndex.reset();
+        m_oShardIndexCache.insert(osShardFilename, panIndex);
+        return true;
+    }
+
+    vsi_l_offset nIndexOffset = 0;
+    if (m_bShardIndexAtEnd)
+    {
+        VSIFSeekL(fp, 0, SEEK_END);
+        const auto nFileSize = VSIFTellL(fp);
+        if (nFileSize < nIndexSize)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Shard %s is too small to contain its index",
+                     osShardFilename.c_str());
+            VSIFCloseL(fp);
+            return false;
+        }
+        nIndexOffset = nFileSize - nIndexSize;
+    }
+
+    std::vector<GByte> abyIndex;
+    try
+    {
+        abyIndex.resize(nIndexSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for index of shard %s",
+                 osShardFilename.c_str());
+        VSIFCloseL(fp);
+        return false;
+    }
+    const bool bReadOK = VSIFSeekL(fp, nIndexOffset, SEEK_SET) == 0 &&
+                         VSIFReadL(abyIndex.data(), 1, nIndexSize, fp) ==
+                             nIndexSize;
+    VSIFCloseL(fp);
+    if (!bReadOK)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Could not read index of shard %s correctly",
+                 osShardFilename.c_str());
+        return false;
+    }
+    if (m_bShardIndexHasChecksum &&
+        !ZarrV3CodecShardingIndexed::VerifyIndexChecksum(abyIndex.data(),
+                                                         nIndexSize))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Checksum of index of shard %s does not match",
+                 osShardFilename.c_str());
+        return false;
+    }
+
+    panIndex = std::make_shared<std::vector<uint64_t>>(2 * nEntries);
+    memcpy(panIndex->data(), abyIndex.data(), nEntries * ENTRY_SIZE);
+#if !CPL_IS_LSB
+    for (auto &nVal : *panIndex)
+        CPL_LSBPTR64(&nVal);
+#endif
+    m_oShardIndexCache.insert(osShardFilename, panIndex);
+    return true;
+}
+
+/************************************************************************/
+/*                    ZarrV3Array::DecodeShardTile()                    */
+/************************************************************************/
+
+// Decode an inner chunk, whose encoded content is in abyRawTileData.
+bool ZarrV3Array::DecodeShardTile(
+    const std::string &osName, ZarrV3CodecSequence *poCodecs,
+    ZarrByteVectorQuickResize &abyRawTileData,
+    ZarrByteVectorQuickResize &abyDecodedTileData) const
+{
+    // This method should NOT modify any ZarrArray member, as it is going to
+    // be called concurrently from several threads.
+
+    // Set those #define to avoid accidental use of some global variables
+#define m_abyRawTileData cannot_use_here
+#define m_abyDecodedTileData cannot_use_here
+#define m_poCodecs cannot_use_here
+
+    if (poCodecs)
+    {
+        GDALCodecStatisticsRecorder oRecorder(
+            nullptr, GDALCodecStatisticsRecorder::Operation::DECODE);
+        oRecorder.SetEncodedSize(static_cast<GIntBig>(abyRawTileData.size()));
+        if (!poCodecs->Decode(abyRawTileData))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Decompression of tile %s failed", osName.c_str());
+            return false;
+        }
+        oRecorder.SetDecodedSize(static_cast<GIntBig>(abyRawTileData.size()));
+    }
+
+    if (abyRawTileData.size() != m_nTileSize)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Decompressed tile %s has not expected size. "
+                 "Got %u instead of %u",
+                 osName.c_str(), static_cast<unsigned>(abyRawTileData.size()),
+                 static_cast<unsigned>(m_nTileSize));
+        return false;
+    }
+
+    if (!abyDecodedTileData.empty())
+    {
+        const size_t nSourceSize =
+            m_aoDtypeElts.back().nativeOffset + m_aoDtypeElts.back().nativeSize;
+        const auto nDTSize = m_oType.GetSize();
+        const size_t nValues = abyDecodedTileData.size() / nDTSize;
+        CPLAssert(nValues == m_nTileSize / nSourceSize);
+        const GByte *pSrc = abyRawTileData.data();
+        GByte *pDst = &abyDecodedTileData[0];
+        for (size_t i = 0; i < nValues;
+             i++, pSrc += nSourceSize, pDst += nDTSize)
+        {
+            DecodeSourceElt(m_aoDtypeElts, pSrc, pDst);
+        }
+    }
+
+    return true;
+
+#undef m_abyRawTileData
+#undef m_abyDecodedTileData
+#undef m_poCodecs
+}
+
+/************************************************************************/
+/*                 ZarrV3Array::LoadTileDataFromShard()                 */
+/************************************************************************/
+
+bool ZarrV3Array::LoadTileDataFromShard(
+    const uint64_t *tileIndices, ZarrV3CodecSequence *poCodecs,
+    ZarrByteVectorQuickResize &abyRawTileData,
+    ZarrByteVectorQuickResize &abyDecodedTileData, bool &bMissingTileOut) const
+{
+    // This method should NOT modify any ZarrArray member, as it is going to
+    // be called concurrently from several threads.
+
+    bMissingTileOut = false;
+
+    std::vector<uint64_t> anShardIndices;
+    size_t nIdxInShard = 0;
+    GetShardIndices(tileIndices, anShardIndices, nIdxInShard);
+    const std::string osShardFilename =
+        BuildTileFilename(anShardIndices.data());
+
+    std::shared_ptr<std::vector<uint64_t>> panIndex;
+    if (!GetShardIndex(osShardFilename, panIndex))
+        return false;
+    constexpr uint64_t MISSING = std::numeric_limits<uint64_t>::max();
+    const uint64_t nOffset = panIndex ? (*panIndex)[2 * nIdxInShard] : MISSING;
+    const uint64_t nSize =
+        panIndex ? (*panIndex)[2 * nIdxInShard + 1] : MISSING;
+    const std::string osName = osShardFilename + " (inner chunk " +
+                               std::to_string(nIdxInShard) + ")";
+    if (nOffset == MISSING && nSize == MISSING)
+    {
+        CPLDebugOnly(ZARR_DEBUG_KEY, "Tile %s missing (=nodata)",
+                     osName.c_str());
+        bMissingTileOut = true;
+        return true;
+    }
+    if (nSize > static_cast<uint64_t>(std::numeric_limits<int>::max()))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Too large tile %s",
+                 osName.c_str());
+        return false;
+    }
+
+    try
+    {
+        abyRawTileData.resize(static_cast<size_t>(nSize));
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for tile %s", osName.c_str());
+        return false;
+    }
+
+    const char *const apszOpenOptions[] = {"IGNORE_FILENAME_RESTRICTIONS=YES",
+                                           nullptr};
+    VSILFILE *fp =
+        VSIFOpenEx2L(osShardFilename.c_str(), "rb", 0, apszOpenOptions);
+    const bool bReadOK =
+        fp != nullptr && !abyRawTileData.empty() &&
+        VSIFSeekL(fp, static_cast<vsi_l_offset>(nOffset), SEEK_SET) == 0 &&
+        VSIFReadL(&abyRawTileData[0], 1, abyRawTileData.size(), fp) ==
+            abyRawTileData.size();
+    if (fp)
+        VSIFCloseL(fp);
+    if (!bReadOK)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Could not read tile %s correctly", osName.c_str());
+        return false;
+    }
+
+    return DecodeShardTile(osName, poCodecs, abyRawTileData,
+                           abyDecodedTileData);
+}
+
 /************************************************************************/
 /*                      ZarrV3Array::IAdviseRead()                      */
 /************************************************************************/
@@ -578,6 +880,11 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
         return true;
     }
 
+    if (IsSharded())
+    {
+        return AdviseReadSharded(anReqTilesIndices, nReqTiles, nThreadsMax);
+    }
+
     const int nThreads =
         static_cast<int>(std::min(static_cast<size_t>(nThreadsMax), nReqTiles));
 
@@ -725,6 +1032,260 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
     return bGlobalStatus;
 }
 
+/************************************************************************/
+/*                   ZarrV3Array::AdviseReadSharded()                   */
+/************************************************************************/
+
+// Load the requested inner chunks, with one job per shard that reads
+// all the needed inner chunks of the shard with a single multi-range
+// request.
+bool ZarrV3Array::AdviseReadSharded(
+    const std::vector<uint64_t> &anReqTilesIndices, size_t nReqTiles,
+    int nThreadsMax) const
+{
+    const size_t nDims = m_aoDims.size();
+
+    // Group requested inner chunks by shard
+    std::map<std::string, std::vector<size_t>> oMapShardToReqs;
+    std::vector<uint64_t> anShardIndices;
+    for (size_t iReq = 0; iReq < nReqTiles; ++iReq)
+    {
+        size_t nIdxInShard = 0;
+        GetShardIndices(anReqTilesIndices.data() + iReq * nDims,
+                        anShardIndices, nIdxInShard);
+        oMapShardToReqs[BuildTileFilename(anShardIndices.data())].push_back(
+            iReq);
+    }
+
+    CPLWorkerThreadPool *wtp = GDALGetGlobalThreadPool(nThreadsMax);
+    if (wtp == nullptr)
+        return false;
+    auto poQueue = wtp->CreateJobQueue();
+
+    struct JobStruct
+    {
+        const ZarrV3Array *poArray = nullptr;
+        const std::string *posShardFilename = nullptr;
+        const std::vector<size_t> *panReqs = nullptr;
+        const std::vector<uint64_t> *panReqTilesIndices = nullptr;
+        bool *pbGlobalStatus = nullptr;
+    };
+    std::vector<JobStruct> asJobStructs;
+    bool bGlobalStatus = true;
+    for (const auto &oIter : oMapShardToReqs)
+    {
+        JobStruct jobStruct;
+        jobStruct.poArray = this;
+        jobStruct.posShardFilename = &oIter.first;
+        jobStruct.panReqs = &oIter.second;
+        jobStruct.panReqTilesIndices = &anReqTilesIndices;
+        jobStruct.pbGlobalStatus = &bGlobalStatus;
+        asJobStructs.push_back(jobStruct);
+    }
+
+    const auto JobFunc = [](void *pThreadData)
+    {
+        const JobStruct *jobStruct =
+            static_cast<const JobStruct *>(pThreadData);
+        const auto poArray = jobStruct->poArray;
+        const auto &aoDims = poArray->GetDimensions();
+        const size_t l_nDims = poArray->GetDimensionCount();
+        const std::string &osShardFilename = *(jobStruct->posShardFilename);
+
+        const auto SetError = [poArray, jobStruct]()
+        {
+            std::lock_guard<std::mutex> oLock(poArray->m_oMutex);
+            *jobStruct->pbGlobalStatus = false;
+        };
+
+        std::unique_ptr<ZarrV3CodecSequence> poCodecs;
+        {
+            std::lock_guard<std::mutex> oLock(poArray->m_oMutex);
+            if (!(*jobStruct->pbGlobalStatus))
+                return;
+            if (poArray->m_poCodecs)
+                poCodecs = poArray->m_poCodecs->Clone();
+        }
+
+        std::shared_ptr<std::vector<uint64_t>> panIndex;
+        if (!poArray->GetShardIndex(osShardFilename, panIndex))
+        {
+            SetError();
+            return;
+        }
+
+        // Collect the ranges of the inner chunks that are present
+        constexpr uint64_t MISSING = std::numeric_limits<uint64_t>::max();
+        struct Range
+        {
+            uint64_t nTileIdx = 0;
+            vsi_l_offset nOffset = 0;
+            size_t nSize = 0;
+            ZarrByteVectorQuickResize abyData{};
+        };
+        std::vector<Range> asRanges;
+        std::vector<uint64_t> anEmptyTiles;
+        std::vector<uint64_t> anShardIndicesTmp;
+        for (const size_t iReq : *(jobStruct->panReqs))
+        {
+            const uint64_t *tileIndices =
+                jobStruct->panReqTilesIndices->data() + iReq * l_nDims;
+
+            uint64_t nTileIdx = 0;
+            for (size_t j = 0; j < l_nDims; ++j)
+            {
+                if (j > 0)
+                    nTileIdx *= aoDims[j - 1]->GetSize();
+                nTileIdx += tileIndices[j];
+            }
+
+            size_t nIdxInShard = 0;
+            poArray->GetShardIndices(tileIndices, anShardIndicesTmp,
+                                     nIdxInShard);
+            const uint64_t nOffset =
+                panIndex ? (*panIndex)[2 * nIdxInShard] : MISSING;
+            const uint64_t nSize =
+                panIndex ? (*panIndex)[2 * nIdxInShard + 1] : MISSING;
+            if (nOffset == MISSING && nSize == MISSING)
+            {
+                anEmptyTiles.push_back(nTileIdx);
+                continue;
+            }
+            if (nSize == 0 ||
+                nSize > static_cast<uint64_t>(std::numeric_limits<int>::max()))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Invalid size for inner chunk %u of shard %s",
+                         static_cast<unsigned>(nIdxInShard),
+                         osShardFilename.c_str());
+                SetError();
+                return;
+            }
+            Range sRange;
+            sRange.nTileIdx = nTileIdx;
+            sRange.nOffset = static_cast<vsi_l_offset>(nOffset);
+            sRange.nSize = static_cast<size_t>(nSize);
+            asRanges.emplace_back(std::move(sRange));
+        }
+
+        if (!asRanges.empty())
+        {
+            // Sorting by offset lets the network file systems merge
+            // consecutive ranges.
+            std::sort(asRanges.begin(), asRanges.end(),
+                      [](const Range &a, const Range &b)
+                      { return a.nOffset < b.nOffset; });
+            std::vector<void *> apData;
+            std::vector<vsi_l_offset> anOffsets;
+            std::vector<size_t> anSizes;
+            try
+            {
+                for (auto &sRange : asRanges)
+                {
+                    sRange.abyData.resize(sRange.nSize);
+                    apData.push_back(&sRange.abyData[0]);
+                    anOffsets.push_back(sRange.nOffset);
+                    anSizes.push_back(sRange.nSize);
+                }
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate memory for tiles of shard %s",
+                         osShardFilename.c_str());
+                SetError();
+                return;
+            }
+
+            const char *const apszOpenOptions[] = {
+                "IGNORE_FILENAME_RESTRICTIONS=YES", nullptr};
+            VSILFILE *fp = VSIFOpenEx2L(osShardFilename.c_str(), "rb", 0,
+                                        apszOpenOptions);
+            const bool bReadOK =
+                fp != nullptr &&
+                VSIFReadMultiRangeL(static_cast<int>(asRanges.size()),
+                                    apData.data(), anOffsets.data(),
+                                    anSizes.data(), fp) == 0;
+            if (fp)
+                VSIFCloseL(fp);
+            if (!bReadOK)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Could not read tiles of shard %s correctly",
+                         osShardFilename.c_str());
+                SetError();
+                return;
+            }
+        }
+
+        ZarrByteVectorQuickResize abyRawTileData;
+        ZarrByteVectorQuickResize abyDecodedTileData;
+        for (auto &sRange : asRanges)
+        {
+            if (!poArray->AllocateWorkingBuffers(abyRawTileData,
+                                                 abyDecodedTileData))
+            {
+                SetError();
+                return;
+            }
+            std::swap(abyRawTileData, sRange.abyData);
+            if (!poArray->DecodeShardTile(osShardFilename, poCodecs.get(),
+                                          abyRawTileData, abyDecodedTileData))
+            {
+                SetError();
+                return;
+            }
+
+            CachedTile cachedTile;
+            if (!abyDecodedTileData.empty())
+                std::swap(cachedTile.abyDecoded, abyDecodedTileData);
+            else
+                std::swap(cachedTile.abyDecoded, abyRawTileData);
+
+            std::lock_guard<std::mutex> oLock(poArray->m_oMutex);
+            poArray->m_oMapTileIndexToCachedTile[sRange.nTileIdx] =
+                std::move(cachedTile);
+        }
+
+        std::lock_guard<std::mutex> oLock(poArray->m_oMutex);
+        for (const uint64_t nTileIdx : anEmptyTiles)
+            poArray->m_oMapTileIndexToCachedTile[nTileIdx] = CachedTile();
+    };
+
+    CPLDebug(ZARR_DEBUG_KEY, "AdviseRead(): reading %u shards",
+             static_cast<unsigned>(asJobStructs.size()));
+    for (auto &jobStruct : asJobStructs)
+    {
+        if (!poQueue->SubmitJob(JobFunc, &jobStruct))
+        {
+            JobFunc(&jobStruct);
+        }
+    }
+    poQueue->WaitCompletion();
+
+    return bGlobalStatus;
+}
+
+/************************************************************************/
+/*                        ZarrV3Array::IWrite()                         */
+/************************************************************************/
+
+bool ZarrV3Array::IWrite(const GUInt64 *arrayStartIdx, const size_t *count,
+                         const GInt64 *arrayStep,
+                         const GPtrDiff_t *bufferStride,
+                         const GDALExtendedDataType &bufferDataType,
+                         const void *pSrcBuffer)
+{
+    if (IsSharded())
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Writing to sharded arrays is not supported");
+        return false;
+    }
+    return ZarrArray::IWrite(arrayStartIdx, count, arrayStep, bufferStride,
+                             bufferDataType, pSrcBuffer);
+}
+
 /************************************************************************/
 /*                    ZarrV3Array::FlushDirtyTile()                     */
 /************************************************************************/
@@ -1601,6 +2162,18 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
             return nullptr;
     }
 
+    // With sharding, the blocks of the array are the inner chunks
+    std::vector<GUInt64> anShardSize;
+    const ZarrV3CodecShardingIndexed *poShardingCodec =
+        poCodecs ? poCodecs->GetShardingCodec() : nullptr;
+    if (poShardingCodec)
+    {
+        anShardSize = anBlockSize;
+        anBlockSize.clear();
+        for (const size_t nSize : poShardingCodec->GetInnerBlockSize())
+            anBlockSize.push_back(nSize);
+    }
+
     auto poArray =
         ZarrV3Array::Create(m_poSharedResource, GetFullName(), osArrayName,
                             aoDims, oType, aoDtypeElts, anBlockSize);
@@ -1617,7 +2190,9 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
     poArray->ParseSpecialAttributes(oAttributes);
     poArray->SetAttributes(oAttributes);
     poArray->SetDtype(oDtype);
-    if (poCodecs)
+    if (poShardingCodec)
+        poArray->SetSharding(anShardSize, poShardingCodec, oCodecs);
+    else if (poCodecs)
         poArray->SetCodecs(std::move(poCodecs));
     RegisterArray(poArray);
 
@@ -1634,7 +2209,18 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
     if (CPLTestBool(m_poSharedResource->GetOpenOptions().FetchNameValueDef(
             "CACHE_TILE_PRESENCE", "NO")))
     {
-        poArray->CacheTilePresence();
+        // Files are shards, not chunks
+        if (poArray->IsSharded())
+        {
+            CPLError(CE_Warning, CPLE_NotSupported,
+                     "CACHE_TILE_PRESENCE is not supported on sharded "
+                     "array %s",
+                     poArray->GetName().c_str());
+        }
+        else
+        {
+            poArray->CacheTilePresence();
+        }
     }
 
     return poArray;
@@ -916,6 +916,236 @@ bool ZarrV3CodecTranspose::Decode(const ZarrByteVectorQuickResize &abySrc,
     return Transpose(abySrc, abyDst, false);
 }
 
+/************************************************************************/
+/*                     ZarrV3CodecShardingIndexed()                     */
+/************************************************************************/
+
+ZarrV3CodecShardingIndexed::ZarrV3CodecShardingIndexed() : ZarrV3Codec(NAME)
+{
+}
+
+/************************************************************************/
+/*                    ~ZarrV3CodecShardingIndexed()                     */
+/************************************************************************/
+
+ZarrV3CodecShardingIndexed::~ZarrV3CodecShardingIndexed() = default;
+
+/************************************************************************/
+/*           ZarrV3CodecShardingIndexed::InitFromConfiguration()        */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::InitFromConfiguration(
+    const CPLJSONObject &configuration,
+    const ZarrArrayMetadata &oInputArrayMetadata,
+    ZarrArrayMetadata &oOutputArrayMetadata)
+{
+    m_oConfiguration = configuration.Clone();
+    m_oInputArrayMetadata = oInputArrayMetadata;
+    oOutputArrayMetadata = oInputArrayMetadata;
+
+    if (!configuration.IsValid() ||
+        configuration.GetType() != CPLJSONObject::Type::Object)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: configuration missing or not an "
+                 "object");
+        return false;
+    }
+
+    for (const auto &oChild : configuration.GetChildren())
+    {
+        const auto osName = oChild.GetName();
+        if (osName != "chunk_shape" && osName != "codecs" &&
+            osName != "index_codecs" && osName != "index_location")
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec sharding_indexed: configuration contains a "
+                     "unhandled member: %s",
+                     osName.c_str());
+            return false;
+        }
+    }
+
+    // Inner chunk shape
+    const auto oChunkShape = configuration.GetObj("chunk_shape");
+    const size_t nDims = oInputArrayMetadata.anBlockSizes.size();
+    if (oChunkShape.GetType() != CPLJSONObject::Type::Array ||
+        static_cast<size_t>(oChunkShape.ToArray().Size()) != nDims)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: chunk_shape missing, not an array "
+                 "or with a wrong number of elements");
+        return false;
+    }
+    m_anInnerBlockSize.clear();
+    size_t i = 0;
+    for (const auto &oVal : oChunkShape.ToArray())
+    {
+        const auto nVal = oVal.ToLong();
+        if (nVal <= 0 ||
+            static_cast<uint64_t>(nVal) > oInputArrayMetadata.anBlockSizes[i] ||
+            (oInputArrayMetadata.anBlockSizes[i] % nVal) != 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec sharding_indexed: chunk_shape[%d] is not a "
+                     "divisor of the shard shape",
+                     static_cast<int>(i));
+            return false;
+        }
+        m_anInnerBlockSize.push_back(static_cast<size_t>(nVal));
+        ++i;
+    }
+
+    // Codecs of inner chunks
+    ZarrArrayMetadata oInnerArrayMetadata;
+    oInnerArrayMetadata.oElt = oInputArrayMetadata.oElt;
+    oInnerArrayMetadata.anBlockSizes = m_anInnerBlockSize;
+    m_poInnerCodecs =
+        std::make_unique<ZarrV3CodecSequence>(oInnerArrayMetadata);
+    if (!m_poInnerCodecs->InitFromJson(configuration["codecs"]))
+        return false;
+
+    // Codecs of the index. Only the ones that can be produced by the
+    // reference implementation are supported.
+    const auto oIndexCodecs = configuration.GetObj("index_codecs");
+    if (oIndexCodecs.GetType() != CPLJSONObject::Type::Array)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: index_codecs missing or not an "
+                 "array");
+        return false;
+    }
+    m_bIndexHasChecksum = false;
+    bool bGotBytesCodec = false;
+    for (const auto &oCodec : oIndexCodecs.ToArray())
+    {
+        const auto osName = oCodec["name"].ToString();
+        if (!bGotBytesCodec && (osName == "bytes" || osName == "endian"))
+        {
+            const auto osEndian =
+                oCodec.GetString("configuration/endian", "little");
+            if (osEndian != "little")
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "Codec sharding_indexed: only little endian index "
+                         "is supported");
+                return false;
+            }
+            bGotBytesCodec = true;
+        }
+        else if (bGotBytesCodec && !m_bIndexHasChecksum && osName == "crc32c")
+        {
+            m_bIndexHasChecksum = true;
+        }
+        else
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Codec sharding_indexed: unsupported index_codecs[]");
+            return false;
+        }
+    }
+    if (!bGotBytesCodec)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: index_codecs[] should contain a "
+                 "bytes codec");
+        return false;
+    }
+
+    const auto osIndexLocation =
+        configuration.GetString("index_location", "end");
+    if (osIndexLocation == "end")
+        m_bIndexLocationAtEnd = true;
+    else if (osIndexLocation == "start")
+        m_bIndexLocationAtEnd = false;
+    else
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: invalid value for index_location");
+        return false;
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                 ZarrV3CodecShardingIndexed::Clone()                  */
+/************************************************************************/
+
+std::unique_ptr<ZarrV3Codec> ZarrV3CodecShardingIndexed::Clone() const
+{
+    auto psClone = std::make_unique<ZarrV3CodecShardingIndexed>();
+    ZarrArrayMetadata oOutputArrayMetadata;
+    psClone->InitFromConfiguration(m_oConfiguration, m_oInputArrayMetadata,
+                                   oOutputArrayMetadata);
+    return psClone;
+}
+
+/************************************************************************/
+/*                 ZarrV3CodecShardingIndexed::Encode()                 */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::Encode(const ZarrByteVectorQuickResize &,
+                                        ZarrByteVectorQuickResize &) const
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "Codec sharding_indexed: writing is not supported");
+    return false;
+}
+
+/************************************************************************/
+/*                 ZarrV3CodecShardingIndexed::Decode()                 */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::Decode(const ZarrByteVectorQuickResize &,
+                                        ZarrByteVectorQuickResize &) const
+{
+    // Shards are read inner chunk by inner chunk by ZarrV3Array
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "Codec sharding_indexed: decoding a whole shard is not "
+             "supported");
+    return false;
+}
+
+/************************************************************************/
+/*           ZarrV3CodecShardingIndexed::VerifyIndexChecksum()          */
+/************************************************************************/
+
+/** Verify the CRC32C checksum stored in the last 4 bytes of pabyIndex */
+/* static */
+bool ZarrV3CodecShardingIndexed::VerifyIndexChecksum(const GByte *pabyIndex,
+                                                     size_t nIndexSize)
+{
+    if (nIndexSize < sizeof(uint32_t))
+        return false;
+
+    // Castagnoli polynomial, reversed
+    constexpr uint32_t POLY = 0x82F63B78U;
+    static const std::array<uint32_t, 256> anTable = []()
+    {
+        std::array<uint32_t, 256> anRet;
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t nCRC = i;
+            for (int j = 0; j < 8; ++j)
+                nCRC = (nCRC & 1) ? (nCRC >> 1) ^ POLY : (nCRC >> 1);
+            anRet[i] = nCRC;
+        }
+        return anRet;
+    }();
+
+    const size_t nDataSize = nIndexSize - sizeof(uint32_t);
+    uint32_t nCRC = 0xFFFFFFFFU;
+    for (size_t i = 0; i < nDataSize; ++i)
+        nCRC = anTable[(nCRC ^ pabyIndex[i]) & 0xFF] ^ (nCRC >> 8);
+    nCRC ^= 0xFFFFFFFFU;
+
+    uint32_t nExpectedCRC;
+    memcpy(&nExpectedCRC, pabyIndex + nDataSize, sizeof(nExpectedCRC));
+    CPL_LSBPTR32(&nExpectedCRC);
+    return nCRC == nExpectedCRC;
+}
+
 /************************************************************************/
 /*                    ZarrV3CodecSequence::Clone()                      */
 /************************************************************************/
@@ -980,10 +1210,23 @@ bool ZarrV3CodecSequence::InitFromJson(const CPLJSONObject &oCodecs)
             poCodec = std::make_unique<ZarrV3CodecGZip>();
         else if (osName == "blosc")
             poCodec = std::make_unique<ZarrV3CodecBlosc>();
-        else if (osName == "endian")
+        // "bytes" is the name of the endian codec in the final version
+        // of the specification
+        else if (osName == "endian" || osName == "bytes")
             poCodec = std::make_unique<ZarrV3CodecEndian>();
         else if (osName == "transpose")
             poCodec = std::make_unique<ZarrV3CodecTranspose>();
+        else if (osName == ZarrV3CodecShardingIndexed::NAME)
+        {
+            if (oCodecsArray.Size() != 1)
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "Codec sharding_indexed is only supported as the "
+                         "single codec of an array");
+                return false;
+            }
+            poCodec = std::make_unique<ZarrV3CodecShardingIndexed>();
+        }
         else
         {
             CPLError(CE_Failure, CPLE_NotSupported, "Unsupported codec: %s",
@@ -1031,6 +1274,21 @@ bool ZarrV3CodecSequence::InitFromJson(const CPLJSONObject &oCodecs)
     return true;
 }
 
+/************************************************************************/
+/*                ZarrV3CodecSequence::GetShardingCodec()               */
+/************************************************************************/
+
+const ZarrV3CodecShardingIndexed *ZarrV3CodecSequence::GetShardingCodec() const
+{
+    if (m_apoCodecs.size() == 1 &&
+        m_apoCodecs[0]->GetName() == ZarrV3CodecShardingIndexed::NAME)
+    {
+        return cpl::down_cast<const ZarrV3CodecShardingIndexed *>(
+            m_apoCodecs[0].get());
+    }
+    return nullptr;
+}
+
 /************************************************************************/
 /*                  ZarrV3CodecEndian::AllocateBuffer()                 */
 /************************************************************************/
@@ -203,10 +203,16 @@ typedef struct
     /*! Height in pixels of the area of interest. Only valid if
      * bFloatingPointWindowValidity = TRUE */
     double dfYSize;
+
+    /*! Indicate that the blocks read are unlikely to be accessed again, so
+        that they should not evict blocks already in the block cache.
+        Only used for reading. Only valid if nVersion >= 2.
+        @since GDAL 3.9 */
+    int bStreaming;
 } GDALRasterIOExtraArg;
 
 #ifndef DOXYGEN_SKIP
-#define RASTERIO_EXTRA_ARG_CURRENT_VERSION 1
+#define RASTERIO_EXTRA_ARG_CURRENT_VERSION 2
 #endif
 
 /** Macro to initialize an instance of GDALRasterIOExtraArg structure.
@@ -220,6 +226,7 @@ typedef struct
         (s).pfnProgress = CPL_NULLPTR;                                         \
         (s).pProgressData = CPL_NULLPTR;                                       \
         (s).bFloatingPointWindowValidity = FALSE;                              \
+        (s).bStreaming = FALSE;                                                \
     } while (0)
 
 /*! Types of color interpretation for raster bands. */
@@ -744,6 +751,16 @@ typedef struct GDALDimensionHS *GDALDimensionH;
  */
 #define GDAL_DCAP_FLUSHCACHE_CONSISTENT_STATE "DCAP_FLUSHCACHE_CONSISTENT_STATE"
 
+/** Capability set by raster drivers whose datasets, opened in read-only mode,
+ * can be opened several times on the same file and read concurrently from
+ * different threads, each dataset being used by a single thread at a time.
+ *
+ * This allows GDALDataset::RasterIO() to decode the blocks of a large request
+ * in parallel when the GDAL_NUM_THREADS configuration option is set.
+ * @since GDAL 3.9
+ */
+#define GDAL_DCAP_PARALLEL_CLONE_READ "DCAP_PARALLEL_CLONE_READ"
+
 /** List of (space separated) flags indicating the features of relationships are
  * supported by the driver.
  *
@@ -1013,11 +1030,28 @@ GDALDatasetH CPL_DLL CPL_STDCALL GDALOpenShared(const char *, GDALAccess)
 #define GDAL_OF_BLOCK_ACCESS_MASK 0x300
 #endif
 
+/** Return a dataset on which the raster read API can be used concurrently
+ * from several threads.
+ *
+ * Must be combined with GDAL_OF_RASTER, and is incompatible with
+ * GDAL_OF_UPDATE, GDAL_OF_VECTOR, GDAL_OF_MULTIDIM_RASTER and GDAL_OF_SHARED.
+ * Supported for datasets of the GTiff, VRT and MEM drivers, and of drivers
+ * declaring GDAL_DCAP_PARALLEL_CLONE_READ (see GDALGetThreadSafeDataset()).
+ *
+ * Used by GDALOpenEx().
+ * @since GDAL 3.9
+ */
+#define GDAL_OF_THREAD_SAFE 0x800
+
 GDALDatasetH CPL_DLL CPL_STDCALL GDALOpenEx(
     const char *pszFilename, unsigned int nOpenFlags,
     const char *const *papszAllowedDrivers, const char *const *papszOpenOptions,
     const char *const *papszSiblingFiles) CPL_WARN_UNUSED_RESULT;
 
+int CPL_DLL GDALDatasetIsThreadSafe(GDALDatasetH hDS);
+GDALDatasetH CPL_DLL GDALGetThreadSafeDataset(GDALDatasetH hDS)
+    CPL_WARN_UNUSED_RESULT;
+
 int CPL_DLL CPL_STDCALL GDALDumpOpenDatasets(FILE *);
 
 GDALDriverH CPL_DLL CPL_STDCALL GDALGetDriverByName(const char *);
@@ -1151,6 +1185,35 @@ CPLErr CPL_DLL CPL_STDCALL GDALDatasetAdviseRead(
     int nBXSize, int nBYSize, GDALDataType eBDataType, int nBandCount,
     int *panBandCount, CSLConstList papszOptions);
 
+/** Window of a GDALDatasetMultiRasterIO() request.
+ * @since GDAL 3.9
+ */
+typedef struct
+{
+    /** Pixel offset to the top left corner of the region to read */
+    int nXOff;
+    /** Line offset to the top left corner of the region to read */
+    int nYOff;
+    /** Width in pixels of the region to read */
+    int nXSize;
+    /** Height in pixels of the region to read */
+    int nYSize;
+    /** Buffer into which the region is read */
+    void *pData;
+    /** Width of the buffer image */
+    int nBufXSize;
+    /** Height of the buffer image */
+    int nBufYSize;
+    /** Set on output to the status of the read of this window */
+    CPLErr eErr;
+} GDALRasterIOWindow;
+
+CPLErr CPL_DLL GDALDatasetMultiRasterIO(
+    GDALDatasetH hDS, int nWindowCount, GDALRasterIOWindow *pasWindows,
+    GDALDataType eBufType, int nBandCount, int *panBandMap,
+    GSpacing nPixelSpace, GSpacing nLineSpace, GSpacing nBandSpace,
+    CSLConstList papszOptions) CPL_WARN_UNUSED_RESULT;
+
 char CPL_DLL **
 GDALDatasetGetCompressionFormats(GDALDatasetH hDS, int nXOff, int nYOff,
                                  int nXSize, int nYSize, int nBandCount,
@@ -1479,6 +1542,10 @@ CPLErr CPL_DLL CPL_STDCALL GDALRasterIOEx(
     int nDSXSize, int nDSYSize, void *pBuffer, int nBXSize, int nBYSize,
     GDALDataType eBDataType, GSpacing nPixelSpace, GSpacing nLineSpace,
     GDALRasterIOExtraArg *psExtraArg) CPL_WARN_UNUSED_RESULT;
+CPLErr CPL_DLL GDALRasterInterpolateAtPoints(
+    GDALRasterBandH hBand, int nPointCount, const double *padfPixel,
+    const double *padfLine, GDALRIOResampleAlg eResampleAlg,
+    double *padfValues, int *pabSuccess) CPL_WARN_UNUSED_RESULT;
 CPLErr CPL_DLL CPL_STDCALL GDALReadBlock(GDALRasterBandH, int, int,
                                          void *) CPL_WARN_UNUSED_RESULT;
 CPLErr CPL_DLL CPL_STDCALL GDALWriteBlock(GDALRasterBandH, int, int,
@@ -1524,6 +1591,13 @@ CPLErr CPL_DLL CPL_STDCALL
 GDALComputeRasterStatistics(GDALRasterBandH, int bApproxOK, double *pdfMin,
                             double *pdfMax, double *pdfMean, double *pdfStdDev,
                             GDALProgressFunc pfnProgress, void *pProgressData);
+CPLErr CPL_DLL CPL_STDCALL GDALComputeRasterStatisticsAndHistogram(
+    GDALRasterBandH hBand, int bApproxOK, double *pdfMin, double *pdfMax,
+    double *pdfMean, double *pdfStdDev, GUIntBig *pnValidCount,
+    double *pdfHistMin, double *pdfHistMax, int *pnBuckets,
+    GUIntBig **ppanHistogram, int nQuantiles, const double *padfQuantiles,
+    double *padfQuantileValues, GDALProgressFunc pfnProgress,
+    void *pProgressData);
 CPLErr CPL_DLL CPL_STDCALL GDALSetRasterStatistics(GDALRasterBandH hBand,
                                                    double dfMin, double dfMax,
                                                    double dfMean,
@@ -1693,6 +1767,11 @@ void CPL_DLL GDALDeinterleave(const void *pSourceBuffer, GDALDataType eSourceDT,
                               int nComponents, void **ppDestBuffer,
                               GDALDataType eDestDT, size_t nIters);
 
+void CPL_DLL GDALInterleave(const void *const *ppSourceBuffer,
+                            GDALDataType eSourceDT, int nComponents,
+                            void *pDestBuffer, GDALDataType eDestDT,
+                            size_t nIters);
+
 int CPL_DLL CPL_STDCALL GDALLoadWorldFile(const char *, double *);
 int CPL_DLL CPL_STDCALL GDALReadWorldFile(const char *, const char *, double *);
 int CPL_DLL CPL_STDCALL GDALWriteWorldFile(const char *, const char *,
@@ -1959,6 +2038,10 @@ void CPL_DLL *CPL_STDCALL GDALRATSerializeJSON(GDALRasterAttributeTableH)
     CPL_WARN_UNUSED_RESULT;
 
 int CPL_DLL CPL_STDCALL GDALRATGetRowOfValue(GDALRasterAttributeTableH, double);
+CPLErr CPL_DLL GDALRATGetRowsOfValues(GDALRasterAttributeTableH hRAT,
+                                     const void *pValues,
+                                     GDALDataType eValueType, size_t nCount,
+                                     int *panRows);
 void CPL_DLL CPL_STDCALL GDALRATRemoveStatistics(GDALRasterAttributeTableH);
 
 /* -------------------------------------------------------------------- */
@@ -2044,6 +2127,86 @@ GIntBig CPL_DLL CPL_STDCALL GDALGetCacheUsed64(void);
 
 int CPL_DLL CPL_STDCALL GDALFlushCacheBlock(void);
 
+/** Priority class of the blocks of a dataset in the global raster block cache
+ * @since GDAL 3.9
+ */
+typedef enum
+{
+    /*! Regular least-recently-used eviction */ GBCP_Normal = 0,
+    /*! Only evicted when no block of normal priority can be evicted */
+    GBCP_High = 1
+} GDALBlockCachePriority;
+
+void CPL_DLL GDALDatasetSetBlockCachePriority(GDALDatasetH hDS,
+                                              GDALBlockCachePriority ePriority);
+GDALBlockCachePriority CPL_DLL GDALDatasetGetBlockCachePriority(GDALDatasetH hDS);
+void CPL_DLL GDALDatasetSetBlockCacheBudget(GDALDatasetH hDS, GIntBig nBytes);
+GIntBig CPL_DLL GDALDatasetGetBlockCacheBudget(GDALDatasetH hDS);
+GIntBig CPL_DLL GDALDatasetGetBlockCacheUsed(GDALDatasetH hDS);
+
+/** Statistics of the raster block cache.
+ *
+ * nHits, nMisses and dfLockWaitTime are only collected when the
+ * GDAL_BLOCK_CACHE_STATISTICS configuration option is set to YES.
+ *
+ * @since GDAL 3.9
+ */
+typedef struct
+{
+    /*! Number of requested blocks found in the block cache */
+    GIntBig nHits;
+    /*! Number of requested blocks not found in the block cache */
+    GIntBig nMisses;
+    /*! Number of blocks evicted to make room for other blocks */
+    GIntBig nEvictions;
+    /*! Number of evicted dirty blocks that had to be written */
+    GIntBig nDirtyBlockFlushes;
+    /*! Cumulated time, in seconds, spent waiting for the locks of the
+     * global block cache (only for the global statistics) */
+    double dfLockWaitTime;
+    /*! Memory currently used by the cached blocks, in bytes */
+    GIntBig nCacheUsed;
+} GDALBlockCacheStatistics;
+
+void CPL_DLL GDALGetBlockCacheStatistics(GDALBlockCacheStatistics *psStats);
+void CPL_DLL GDALResetBlockCacheStatistics(void);
+void CPL_DLL GDALGetRasterBandBlockCacheStatistics(
+    GDALRasterBandH hBand, GDALBlockCacheStatistics *psStats);
+void CPL_DLL GDALDatasetGetBlockCacheStatistics(
+    GDALDatasetH hDS, GDALBlockCacheStatistics *psStats);
+
+/** Statistics of the decoding and encoding of blocks (tiles, strips,
+ * chunks, or whole images) by the codecs of drivers.
+ *
+ * @since GDAL 3.9
+ */
+typedef struct
+{
+    /*! Number of decoded blocks */
+    GIntBig nBlocksDecoded;
+    /*! Number of encoded bytes fetched to decode the blocks */
+    GIntBig nBytesFetched;
+    /*! Number of bytes produced by the decoding of the blocks */
+    GIntBig nBytesDecoded;
+    /*! Cumulated time, in seconds, spent decoding the blocks. For some
+     * drivers, this includes the time spent fetching the encoded bytes. */
+    double dfDecodeTime;
+    /*! Number of encoded blocks */
+    GIntBig nBlocksEncoded;
+    /*! Number of bytes given to the encoder */
+    GIntBig nBytesToEncode;
+    /*! Number of bytes produced by the encoding of the blocks */
+    GIntBig nBytesEncoded;
+    /*! Cumulated time, in seconds, spent encoding the blocks */
+    double dfEncodeTime;
+} GDALCodecStatistics;
+
+void CPL_DLL GDALDatasetGetCodecStatistics(GDALDatasetH hDS,
+                                           GDALCodecStatistics *psStats);
+void CPL_DLL GDALDatasetResetCodecStatistics(GDALDatasetH hDS);
+void CPL_DLL GDALGetThreadCodecStatistics(GDALCodecStatistics *psStats);
+void CPL_DLL GDALResetThreadCodecStatistics(void);
+
 /* ==================================================================== */
 /*      GDAL virtual memory                                             */
 /* ==================================================================== */
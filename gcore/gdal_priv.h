@@ -70,6 +70,8 @@ class GDALRelationship;
 
 #include <stdarg.h>
 
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <iterator>
@@ -332,6 +334,8 @@ class OGRStyleTable;
 class swq_select;
 class swq_select_parse_options;
 class GDALGroup;
+struct GDALBlockCacheSettings;
+struct GDALCodecStatisticsCounters;
 
 //! @cond Doxygen_Suppress
 typedef struct GDALSQLParseInfo GDALSQLParseInfo;
@@ -364,6 +368,8 @@ class CPL_DLL GDALDataset : public GDALMajorObject
 
     CPL_INTERNAL void UnregisterFromSharedDataset();
 
+    CPL_INTERNAL GDALBlockCacheSettings *GetOrCreateBlockCacheSettings();
+
     CPL_INTERNAL static void ReportErrorV(const char *pszDSName,
                                           CPLErr eErrClass, CPLErrorNum err_no,
                                           const char *fmt, va_list args);
@@ -574,6 +580,13 @@ class CPL_DLL GDALDataset : public GDALMajorObject
                               int nBandCount, int *panBandList,
                               char **papszOptions);
 
+    CPLErr MultiRasterIO(int nWindowCount, GDALRasterIOWindow *pasWindows,
+                         GDALDataType eBufType, int nBandCount,
+                         int *panBandMap, GSpacing nPixelSpace,
+                         GSpacing nLineSpace, GSpacing nBandSpace,
+                         CSLConstList papszOptions = nullptr)
+        CPL_WARN_UNUSED_RESULT;
+
     virtual CPLErr CreateMaskBand(int nFlagsIn);
 
     virtual GDALAsyncReader *
@@ -682,6 +695,26 @@ class CPL_DLL GDALDataset : public GDALMajorObject
 
     virtual void ClearStatistics();
 
+    void SetBlockCachePriority(GDALBlockCachePriority ePriority);
+    GDALBlockCachePriority GetBlockCachePriority() const;
+    void SetBlockCacheBudget(GIntBig nBytes);
+    GIntBig GetBlockCacheBudget() const;
+    GIntBig GetBlockCacheUsed() const;
+    void GetBlockCacheStatistics(GDALBlockCacheStatistics *psStats) const;
+    void GetCodecStatistics(GDALCodecStatistics *psStats) const;
+    void ResetCodecStatistics();
+
+    virtual bool IsThreadSafe() const;
+    virtual bool CanBeCloned() const;
+    virtual std::unique_ptr<GDALDataset> Clone() const;
+
+    //! @cond Doxygen_Suppress
+    GDALBlockCacheSettings *GetBlockCacheSettings() const;
+    GDALCodecStatisticsCounters *GetCodecStatisticsCounters();
+    GDALDataset *AcquireParallelReadClone();
+    void ReleaseParallelReadClone(GDALDataset *poClone);
+    //! @endcond
+
     /** Convert a GDALDataset* to a GDALDatasetH.
      * @since GDAL 2.3
      */
@@ -963,6 +996,115 @@ struct CPL_DLL GDALDatasetUniquePtrDeleter
 using GDALDatasetUniquePtr =
     std::unique_ptr<GDALDataset, GDALDatasetUniquePtrDeleter>;
 
+//! @cond Doxygen_Suppress
+
+/* ******************************************************************** */
+/*                        GDALBlockCacheSettings                        */
+/* ******************************************************************** */
+
+/** Block cache settings of a dataset, shared with its overview and mask
+ * datasets. Blocks internalized while the settings are set are accounted
+ * in nUsed.
+ */
+struct GDALBlockCacheSettings
+{
+    std::atomic<int> nPriority{GBCP_Normal};
+    /** Amount of cache, in bytes, whose blocks are protected from eviction */
+    std::atomic<GIntBig> nBudget{0};
+    /** Amount of cache, in bytes, currently used by the blocks */
+    std::atomic<GIntBig> nUsed{0};
+};
+
+/* ******************************************************************** */
+/*                     GDALCodecStatisticsCounters                      */
+/* ******************************************************************** */
+
+/** Accumulator of GDALCodecStatistics, that may be updated concurrently */
+struct CPL_DLL GDALCodecStatisticsCounters
+{
+    std::atomic<GIntBig> nBlocksDecoded{0};
+    std::atomic<GIntBig> nBytesFetched{0};
+    std::atomic<GIntBig> nBytesDecoded{0};
+    /** Decoding time, in nanoseconds */
+    std::atomic<GIntBig> nDecodeTime{0};
+    std::atomic<GIntBig> nBlocksEncoded{0};
+    std::atomic<GIntBig> nBytesToEncode{0};
+    std::atomic<GIntBig> nBytesEncoded{0};
+    /** Encoding time, in nanoseconds */
+    std::atomic<GIntBig> nEncodeTime{0};
+
+    void AddTo(GDALCodecStatistics *psStats) const;
+    void Reset();
+};
+
+/* ******************************************************************** */
+/*                     GDALCodecStatisticsRecorder                      */
+/* ******************************************************************** */
+
+/** Times the decoding or encoding of a block from its construction to its
+ * destruction, and accounts it in the codec statistics of a dataset and of
+ * the current thread.
+ */
+class CPL_DLL GDALCodecStatisticsRecorder
+{
+  public:
+    enum class Operation
+    {
+        DECODE,
+        ENCODE
+    };
+
+    GDALCodecStatisticsRecorder(GDALDataset *poDS, Operation eOperation);
+    ~GDALCodecStatisticsRecorder();
+
+    /** Set the size of the encoded data: fetched bytes when decoding, or
+     * produced bytes when encoding. */
+    void SetEncodedSize(GIntBig nBytes)
+    {
+        m_nEncodedSize = nBytes;
+    }
+
+    /** Set the size of the decoded data: produced bytes when decoding, or
+     * bytes given to the encoder when encoding. */
+    void SetDecodedSize(GIntBig nBytes)
+    {
+        m_nDecodedSize = nBytes;
+    }
+
+    /** Account an operation whose duration has been measured by the caller,
+     * when a RAII object cannot be used (for example with setjmp/longjmp
+     * based error handling). */
+    static void Account(GDALDataset *poDS, Operation eOperation,
+                        std::chrono::steady_clock::duration oElapsed,
+                        GIntBig nEncodedSize, GIntBig nDecodedSize);
+
+    /** Set, during its lifetime, the dataset to which the operations of the
+     * current thread recorded with a null dataset are accounted. This is
+     * used by datasets wrapping multidimensional arrays, whose codecs do not
+     * know the dataset. */
+    class CPL_DLL DefaultDatasetSetter
+    {
+        GDALDataset *m_poPrevDS;
+
+        CPL_DISALLOW_COPY_ASSIGN(DefaultDatasetSetter)
+
+      public:
+        explicit DefaultDatasetSetter(GDALDataset *poDS);
+        ~DefaultDatasetSetter();
+    };
+
+  private:
+    GDALDataset *m_poDS;
+    Operation m_eOperation;
+    std::chrono::steady_clock::time_point m_oStart;
+    GIntBig m_nEncodedSize = 0;
+    GIntBig m_nDecodedSize = 0;
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALCodecStatisticsRecorder)
+};
+
+//! @endcond
+
 /* ******************************************************************** */
 /*                           GDALRasterBlock                            */
 /* ******************************************************************** */
@@ -995,8 +1137,27 @@ class CPL_DLL GDALRasterBlock
 
     bool bMustDetach;
 
+    // Index of the shard of the global block cache this block belongs to
+    int nShard;
+
+    // Settings of the dataset this block is accounted to, or null
+    GDALBlockCacheSettings *poCacheSettings;
+
+    // Whether the block is in the hot segment of the SLRU policy
+    bool bHot;
+    // Whether the block has been loaded by a streaming read
+    bool bStreaming;
+    // Value of the insertion counter of the shard when the block was added
+    unsigned nInsertEpoch;
+    // Value of the head counter of the shard when the block was last moved
+    // to the head of its list, or 0 if it has been moved elsewhere since.
+    std::atomic<unsigned> nHeadEpoch;
+
     CPL_INTERNAL void Detach_unlocked(void);
     CPL_INTERNAL void Touch_unlocked(void);
+    CPL_INTERNAL void Unlink_unlocked(void);
+    CPL_INTERNAL void InsertBefore_unlocked(GDALRasterBlock *poOlder);
+    CPL_INTERNAL static void DemoteHotBlocks_unlocked(int nShardIdx);
 
     CPL_INTERNAL void RecycleFor(int nXOffIn, int nYOffIn);
 
@@ -1098,6 +1259,9 @@ class CPL_DLL GDALRasterBlock
     static void EnterDisableDirtyBlockFlush();
     static void LeaveDisableDirtyBlockFlush();
 
+    static void EnterStreamingRead();
+    static void LeaveStreamingRead();
+
 #ifdef notdef
     static void CheckNonOrphanedBlocks(GDALRasterBand *poBand);
     void DumpBlock();
@@ -1113,6 +1277,76 @@ class CPL_DLL GDALRasterBlock
     CPL_DISALLOW_COPY_ASSIGN(GDALRasterBlock)
 };
 
+/* ******************************************************************** */
+/*                          GDALRasterBlockView                         */
+/* ******************************************************************** */
+
+/** Read-only view on the data of a block of the raster block cache, as
+ * returned by GDALRasterBand::GetBlockView().
+ *
+ * The block is locked, and thus kept in the block cache, as long as a view
+ * on it exists. Copies of a view share the lock on the block.
+ * Views must be destroyed before the block cache of the band is flushed, and
+ * before its dataset is closed.
+ *
+ * @since GDAL 3.9
+ */
+class CPL_DLL GDALRasterBlockView
+{
+    GDALRasterBlock *m_poBlock = nullptr;
+
+  public:
+    /** Construct an empty view */
+    GDALRasterBlockView() = default;
+    explicit GDALRasterBlockView(GDALRasterBlock *poLockedBlock);
+    GDALRasterBlockView(const GDALRasterBlockView &other);
+    GDALRasterBlockView(GDALRasterBlockView &&other) noexcept;
+    ~GDALRasterBlockView();
+
+    GDALRasterBlockView &operator=(const GDALRasterBlockView &other);
+    GDALRasterBlockView &operator=(GDALRasterBlockView &&other) noexcept;
+
+    /** Return whether the view is valid */
+    explicit operator bool() const
+    {
+        return m_poBlock != nullptr;
+    }
+
+    /** Return the block data, in the band data type, line by line with
+     * GetXSize() pixels per line, or nullptr for an empty view.
+     */
+    const void *data() const
+    {
+        return m_poBlock ? m_poBlock->GetDataRef() : nullptr;
+    }
+
+    /** Return the size of the block data in bytes */
+    size_t size() const
+    {
+        return m_poBlock ? static_cast<size_t>(m_poBlock->GetBlockSize()) : 0;
+    }
+
+    /** Return the data type of the block */
+    GDALDataType GetDataType() const
+    {
+        return m_poBlock ? m_poBlock->GetDataType() : GDT_Unknown;
+    }
+
+    /** Return the width of the block, including padding of partial blocks */
+    int GetXSize() const
+    {
+        return m_poBlock ? m_poBlock->GetXSize() : 0;
+    }
+
+    /** Return the height of the block, including padding of partial blocks */
+    int GetYSize() const
+    {
+        return m_poBlock ? m_poBlock->GetYSize() : 0;
+    }
+
+    void reset();
+};
+
 /* ******************************************************************** */
 /*                             GDALColorTable                           */
 /* ******************************************************************** */
@@ -1181,6 +1415,13 @@ class GDALAbstractBandBlockCache
 
     volatile int m_nDirtyBlocks = 0;
 
+    // Statistics
+    std::atomic<GIntBig> m_nHits{0};
+    std::atomic<GIntBig> m_nMisses{0};
+    std::atomic<GIntBig> m_nEvictions{0};
+    std::atomic<GIntBig> m_nDirtyBlockFlushes{0};
+    std::atomic<GIntBig> m_nCacheUsed{0};
+
     CPL_DISALLOW_COPY_ASSIGN(GDALAbstractBandBlockCache)
 
   protected:
@@ -1214,6 +1455,24 @@ class GDALAbstractBandBlockCache
         return m_nDirtyBlocks > 0;
     }
 
+    void IncHits()
+    {
+        m_nHits.fetch_add(1, std::memory_order_relaxed);
+    }
+    void IncMisses()
+    {
+        m_nMisses.fetch_add(1, std::memory_order_relaxed);
+    }
+    void IncDirtyBlockFlushes()
+    {
+        m_nDirtyBlockFlushes.fetch_add(1, std::memory_order_relaxed);
+    }
+    void AddCacheUsed(GIntBig nBytes)
+    {
+        m_nCacheUsed.fetch_add(nBytes, std::memory_order_relaxed);
+    }
+    void GetStatistics(GDALBlockCacheStatistics *psStats) const;
+
     virtual bool Init() = 0;
     virtual bool IsInitOK() = 0;
     virtual CPLErr FlushCache() = 0;
@@ -1322,11 +1581,14 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
     int EnterReadWrite(GDALRWFlag eRWFlag);
     void LeaveReadWrite();
     void InitRWLock();
-    void SetValidPercent(GUIntBig nSampleCount, GUIntBig nValidCount);
 
     //! @endcond
 
   protected:
+    //! @cond Doxygen_Suppress
+    void SetValidPercent(GUIntBig nSampleCount, GUIntBig nValidCount);
+    //! @endcond
+
     virtual CPLErr IReadBlock(int nBlockXOff, int nBlockYOff, void *pData) = 0;
     virtual CPLErr IWriteBlock(int nBlockXOff, int nBlockYOff, void *pData);
 
@@ -1402,6 +1664,8 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
                       int bJustInitialize = FALSE) CPL_WARN_UNUSED_RESULT;
     GDALRasterBlock *TryGetLockedBlockRef(int nXBlockOff, int nYBlockYOff)
         CPL_WARN_UNUSED_RESULT;
+    GDALRasterBlockView GetBlockView(int nXBlockOff,
+                                     int nYBlockOff) CPL_WARN_UNUSED_RESULT;
     CPLErr FlushBlock(int, int, int bWriteDirtyBlock = TRUE);
 
     unsigned char *
@@ -1412,6 +1676,7 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
     // New OpengIS CV_SampleDimension stuff.
 
     virtual CPLErr FlushCache(bool bAtClosing = false);
+    void GetBlockCacheStatistics(GDALBlockCacheStatistics *psStats) const;
     virtual char **GetCategoryNames();
     virtual double GetNoDataValue(int *pbSuccess = nullptr);
     virtual int64_t GetNoDataValueAsInt64(int *pbSuccess = nullptr);
@@ -1446,6 +1711,12 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
     virtual CPLErr SetStatistics(double dfMin, double dfMax, double dfMean,
                                  double dfStdDev);
     virtual CPLErr ComputeRasterMinMax(int, double *);
+    CPLErr ComputeStatisticsAndHistogram(
+        int bApproxOK, double *pdfMin, double *pdfMax, double *pdfMean,
+        double *pdfStdDev, GUIntBig *pnValidCount, double *pdfHistMin,
+        double *pdfHistMax, int *pnBuckets, GUIntBig **ppanHistogram,
+        int nQuantiles, const double *padfQuantiles, double *padfQuantileValues,
+        GDALProgressFunc pfnProgress, void *pProgressData);
 
 // Only defined when Doxygen enabled
 #ifdef DOXYGEN_SKIP
@@ -1470,6 +1741,12 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
                               int nBufXSize, int nBufYSize,
                               GDALDataType eBufType, char **papszOptions);
 
+    CPLErr InterpolateAtPoints(int nPointCount, const double *padfPixel,
+                               const double *padfLine,
+                               GDALRIOResampleAlg eResampleAlg,
+                               double *padfValues, int *pabSuccess = nullptr)
+        CPL_WARN_UNUSED_RESULT;
+
     virtual CPLErr GetHistogram(double dfMin, double dfMax, int nBuckets,
                                 GUIntBig *panHistogram, int bIncludeOutOfRange,
                                 int bApproxOK, GDALProgressFunc,
@@ -2046,6 +2323,11 @@ class CPL_DLL GDALDriverManager : public GDALMajorObject
     std::map<std::string, std::unique_ptr<GDALDriver>> m_oMapRealDrivers{};
     std::vector<std::unique_ptr<GDALDriver>> m_aoHiddenDrivers{};
 
+    // Lower-case extension to drivers declaring it, in registration order
+    std::map<std::string, std::vector<GDALDriver *>>
+        m_oMapExtensionToDrivers{};
+    bool m_bExtensionMapDirty = true;
+
     GDALDriver *GetDriver_unlocked(int iDriver)
     {
         return (iDriver >= 0 && iDriver < nDrivers) ? papoDrivers[iDriver]
@@ -2078,6 +2360,7 @@ class CPL_DLL GDALDriverManager : public GDALMajorObject
     static char **GetSearchPaths(const char *pszGDAL_DRIVER_PATH);
     int GetDriverCount(bool bIncludeHidden) const;
     GDALDriver *GetDriver(int iDriver, bool bIncludeHidden);
+    std::vector<GDALDriver *> GetDriversForExtension(const char *pszFilename);
     //! @endcond
 
   public:
@@ -2100,6 +2383,10 @@ class CPL_DLL GDALDriverManager : public GDALMajorObject
     static void AutoLoadPythonDrivers();
 
     void DeclareDeferredPluginDriver(GDALPluginDriverProxy *poProxyDriver);
+
+    //! @cond Doxygen_Suppress
+    static void InvalidateExtensionMap();
+    //! @endcond
 };
 
 CPL_C_START
@@ -2789,6 +3076,11 @@ class CPL_DLL GDALAbstractMDArray
                                  FuncProcessPerChunkType pfnFunc,
                                  void *pUserData);
 
+    bool ProcessPerChunk(const GUInt64 *arrayStartIdx, const GUInt64 *count,
+                         const size_t *chunkSize,
+                         FuncProcessPerChunkType pfnFunc, void *pUserData,
+                         int nThreads);
+
     virtual bool
     Read(const GUInt64 *arrayStartIdx,    // array of size GetDimensionCount()
          const size_t *count,             // array of size GetDimensionCount()
@@ -3032,6 +3324,9 @@ class CPL_DLL GDALMDArray : virtual public GDALAbstractMDArray,
     mutable bool m_bHasTriedCachedArray = false;
     mutable std::shared_ptr<GDALMDArray> m_poCachedArray{};
 
+    // Identifier of the array in the chunk cache, assigned on first use
+    mutable uint64_t m_nChunkCacheId = 0;
+
   protected:
     //! @cond Doxygen_Suppress
     GDALMDArray(const std::string &osParentName, const std::string &osName,
@@ -3045,6 +3340,18 @@ class CPL_DLL GDALMDArray : virtual public GDALAbstractMDArray,
         return true;
     }
 
+    /** Return whether decoded chunks of this array may be kept in the
+     * chunk cache shared by all arrays, so that Read() requests touching
+     * the same chunks do not decode them again. This requires
+     * GetBlockSize() to return a non-zero size for all dimensions.
+     *
+     * The default implementation returns false.
+     */
+    virtual bool CanUseChunkCache() const
+    {
+        return false;
+    }
+
     virtual bool SetStatistics(bool bApproxStats, double dfMin, double dfMax,
                                double dfMean, double dfStdDev,
                                GUInt64 nValidCount, CSLConstList papszOptions);
@@ -3078,6 +3385,19 @@ class CPL_DLL GDALMDArray : virtual public GDALAbstractMDArray,
                                   const GDALExtendedDataType &bufferDataType,
                                   void *pDstBuffer) const;
 
+    // Returns false if the request must not go through the chunk cache
+    bool ReadUsingChunkCache(const GUInt64 *arrayStartIdx, const size_t *count,
+                             const GInt64 *arrayStep,
+                             const GPtrDiff_t *bufferStride,
+                             const GDALExtendedDataType &bufferDataType,
+                             void *pDstBuffer, bool &bRet) const;
+
+    // Returns false if the request must be processed sequentially
+    bool ReadInParallel(const GUInt64 *arrayStartIdx, const size_t *count,
+                        const GInt64 *arrayStep, const GPtrDiff_t *bufferStride,
+                        const GDALExtendedDataType &bufferDataType,
+                        void *pDstBuffer, bool &bRet) const;
+
     static std::shared_ptr<GDALMDArray>
     CreateGLTOrthorectified(const std::shared_ptr<GDALMDArray> &poParent,
                             const std::shared_ptr<GDALMDArray> &poGLTX,
@@ -3088,6 +3408,8 @@ class CPL_DLL GDALMDArray : virtual public GDALAbstractMDArray,
     //! @endcond
 
   public:
+    ~GDALMDArray() override;
+
     GUInt64 GetTotalCopyCost() const;
 
     virtual bool CopyFrom(GDALDataset *poSrcDS, const GDALMDArray *poSrcArray,
@@ -3098,6 +3420,24 @@ class CPL_DLL GDALMDArray : virtual public GDALAbstractMDArray,
     /** Return whether an array is writable. */
     virtual bool IsWritable() const = 0;
 
+    /** Return whether IRead() can be called concurrently from several
+     * threads on this array, provided that it is not modified meanwhile.
+     *
+     * When this returns true and the GDAL_NUM_THREADS configuration option
+     * is set, Read() splits large requests along the chunk grid returned
+     * by GetBlockSize(), and reads the pieces in the global thread pool.
+     *
+     * Drivers whose reads are serialized by a global lock gain nothing
+     * from that and should keep the default implementation, which returns
+     * false.
+     *
+     * @since GDAL 3.9
+     */
+    virtual bool IsReadThreadSafe() const
+    {
+        return false;
+    }
+
     /** Return the filename that contains that array.
      *
      * This is used in particular for caching.
@@ -3237,6 +3577,8 @@ class CPL_DLL GDALMDArray : virtual public GDALAbstractMDArray,
 
     bool Cache(CSLConstList papszOptions = nullptr) const;
 
+    void ClearChunkCache() const;
+
     bool
     Read(const GUInt64 *arrayStartIdx,    // array of size GetDimensionCount()
          const size_t *count,             // array of size GetDimensionCount()
@@ -3938,6 +4280,21 @@ void GDALNullifyProxyPoolSingleton();
 void GDALSetResponsiblePIDForCurrentThread(GIntBig responsiblePID);
 GIntBig GDALGetResponsiblePIDForCurrentThread();
 
+void GDALCompressedBlockCacheStore(GDALRasterBlock *poBlock);
+bool GDALCompressedBlockCacheFetch(GDALRasterBand *poBand, int nXBlockOff,
+                                   int nYBlockOff, void *pData, size_t nSize);
+void GDALCompressedBlockCacheDropBand(GDALRasterBand *poBand);
+
+bool GDALDiskBlockCacheFetch(GDALRasterBand *poBand, int nXBlockOff,
+                             int nYBlockOff, void *pData, size_t nSize);
+void GDALDiskBlockCacheStore(GDALRasterBand *poBand, int nXBlockOff,
+                             int nYBlockOff, const void *pData, size_t nSize);
+void GDALDiskBlockCacheDropBand(GDALRasterBand *poBand);
+
+void *GDALRasterBlockPoolAlloc(size_t nSize);
+void GDALRasterBlockPoolFree(void *pData);
+void GDALRasterBlockPoolCleanup();
+
 CPLString GDALFindAssociatedFile(const char *pszBasename, const char *pszExt,
                                  CSLConstList papszSiblingFiles, int nFlags);
 
@@ -3963,6 +4320,8 @@ void GDALRasterIOExtraArgSetResampleAlg(GDALRasterIOExtraArg *psExtraArg,
 GDALDataset *GDALCreateOverviewDataset(GDALDataset *poDS, int nOvrLevel,
                                        bool bThisLevelOnly);
 
+GDALDataset *GDALCreateThreadSafeDataset(GDALDataset *poPrototypeDS);
+
 // Should cover particular cases of #3573, #4183, #4506, #6578
 // Behavior is undefined if fVal1 or fVal2 are NaN (should be tested before
 // calling this function)
@@ -37,6 +37,8 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <limits>
+#include <unordered_map>
 #include <vector>
 
 #include "cpl_conv.h"
@@ -414,6 +416,101 @@ int GDALRasterAttributeTable::GetRowOfValue(int nValue) const
     return GetRowOfValue(static_cast<double>(nValue));
 }
 
+/************************************************************************/
+/*                          GetRowsOfValues()                           */
+/************************************************************************/
+
+/**
+ * \brief Get rows for an array of pixel values.
+ *
+ * This is the same as calling GetRowOfValue() on each value, but more
+ * efficient to classify whole buffers of pixel values, such as the ones
+ * returned by GDALRasterBand::RasterIO().
+ *
+ * This method is the same as the C function GDALRATGetRowsOfValues().
+ *
+ * @param pValues array of nCount pixel values.
+ * @param eValueType data type of the values. Must not be a complex type.
+ * @param nCount number of values.
+ * @param panRows array of nCount integers, set to the row index of each
+ * value, or -1 if no row is appropriate.
+ *
+ * @return CE_None on success.
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALRasterAttributeTable::GetRowsOfValues(const void *pValues,
+                                                 GDALDataType eValueType,
+                                                 size_t nCount,
+                                                 int *panRows) const
+
+{
+    if (eValueType == GDT_Unknown || GDALDataTypeIsComplex(eValueType))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "GetRowsOfValues(): unsupported data type");
+        return CE_Failure;
+    }
+
+    const int nValueSize = GDALGetDataTypeSizeBytes(eValueType);
+    constexpr size_t CHUNK_SIZE = 4096;
+    double adfValues[CHUNK_SIZE];
+
+    // Pixel values are often repeated, so remember the last looked up one.
+    bool bHasLastValue = false;
+    double dfLastValue = 0;
+    int nLastRow = -1;
+
+    for (size_t nStart = 0; nStart < nCount; nStart += CHUNK_SIZE)
+    {
+        const size_t nChunkCount = std::min(CHUNK_SIZE, nCount - nStart);
+        GDALCopyWords64(static_cast<const GByte *>(pValues) +
+                            nStart * nValueSize,
+                        eValueType, nValueSize, adfValues, GDT_Float64,
+                        sizeof(double), nChunkCount);
+        for (size_t i = 0; i < nChunkCount; ++i)
+        {
+            if (!bHasLastValue || adfValues[i] != dfLastValue)
+            {
+                bHasLastValue = true;
+                dfLastValue = adfValues[i];
+                nLastRow = GetRowOfValue(dfLastValue);
+            }
+            panRows[nStart + i] = nLastRow;
+        }
+    }
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                       GDALRATGetRowsOfValues()                       */
+/************************************************************************/
+
+/**
+ * \brief Get rows for an array of pixel values.
+ *
+ * This function is the same as the C++ method
+ * GDALRasterAttributeTable::GetRowsOfValues()
+ *
+ * @since GDAL 3.9
+ */
+CPLErr GDALRATGetRowsOfValues(GDALRasterAttributeTableH hRAT,
+                              const void *pValues, GDALDataType eValueType,
+                              size_t nCount, int *panRows)
+
+{
+    VALIDATE_POINTER1(hRAT, "GDALRATGetRowsOfValues", CE_Failure);
+    if (nCount > 0)
+    {
+        VALIDATE_POINTER1(pValues, "GDALRATGetRowsOfValues", CE_Failure);
+        VALIDATE_POINTER1(panRows, "GDALRATGetRowsOfValues", CE_Failure);
+    }
+
+    return GDALRasterAttributeTable::FromHandle(hRAT)->GetRowsOfValues(
+        pValues, eValueType, nCount, panRows);
+}
+
 /************************************************************************/
 /*                            CreateColumn()                            */
 /************************************************************************/
@@ -1055,10 +1152,17 @@ GDALColorTable *GDALRasterAttributeTable::TranslateToColorTable(int nEntryCount)
     /* -------------------------------------------------------------------- */
     GDALColorTable *poCT = new GDALColorTable();
 
+    std::vector<int> anEntries(nEntryCount);
+    std::vector<int> anRows(nEntryCount);
+    for (int iEntry = 0; iEntry < nEntryCount; iEntry++)
+        anEntries[iEntry] = iEntry;
+    GetRowsOfValues(anEntries.data(), GDT_Int32, anEntries.size(),
+                    anRows.data());
+
     for (int iEntry = 0; iEntry < nEntryCount; iEntry++)
     {
         GDALColorEntry sColor = {0, 0, 0, 0};
-        const int iRow = GetRowOfValue(iEntry);
+        const int iRow = anRows[iEntry];
 
         if (iRow != -1)
         {
@@ -1661,6 +1765,7 @@ void GDALDefaultRasterAttributeTable::SetRowCount(int nNewCount)
     }
 
     nRowCount = nNewCount;
+    InvalidateRowOfValueIndex();
 }
 
 /************************************************************************/
@@ -1694,6 +1799,8 @@ void GDALDefaultRasterAttributeTable::SetValue(int iRow, int iField,
         return;
     }
 
+    InvalidateRowOfValueIndex();
+
     switch (aoFields[iField].eType)
     {
         case GFT_Integer:
@@ -1760,6 +1867,8 @@ void GDALDefaultRasterAttributeTable::SetValue(int iRow, int iField, int nValue)
         return;
     }
 
+    InvalidateRowOfValueIndex();
+
     switch (aoFields[iField].eType)
     {
         case GFT_Integer:
@@ -1826,6 +1935,8 @@ void GDALDefaultRasterAttributeTable::SetValue(int iRow, int iField,
         return;
     }
 
+    InvalidateRowOfValueIndex();
+
     switch (aoFields[iField].eType)
     {
         case GFT_Integer:
@@ -1896,6 +2007,166 @@ int CPL_STDCALL GDALRATChangesAreWrittenToFile(GDALRasterAttributeTableH hRAT)
         ->ChangesAreWrittenToFile();
 }
 
+/************************************************************************/
+/*                           RowOfValueIndex                            */
+/************************************************************************/
+
+// A row matches a value if it is not lower than the min column value and
+// not greater than the max column value (NaN values in those columns match
+// any value), and GetRowOfValue() returns the first matching row.
+struct GDALDefaultRasterAttributeTable::RowOfValueIndex
+{
+    // When the same column holds the min and max values, the matching rows
+    // are looked up by exact value.
+    bool bExactValues = false;
+    std::unordered_map<double, int> oMapValueToRow{};
+    int nFirstRowOfAnyValue = -1;
+
+    // Otherwise, sorted distinct min and max values, that split the real line
+    // into slots: slot 2 * i + 1 is adfBounds[i] and slot 2 * i is the open
+    // interval between adfBounds[i - 1] and adfBounds[i]. anSlotRows is the
+    // first row matching the values of each slot.
+    std::vector<double> adfBounds{};
+    std::vector<int> anSlotRows{};
+
+    int GetSlot(double dfValue) const
+    {
+        const size_t i = static_cast<size_t>(
+            std::lower_bound(adfBounds.begin(), adfBounds.end(), dfValue) -
+            adfBounds.begin());
+        if (i < adfBounds.size() && adfBounds[i] == dfValue)
+            return static_cast<int>(2 * i + 1);
+        return static_cast<int>(2 * i);
+    }
+
+    int Lookup(double dfValue) const
+    {
+        if (!bExactValues)
+            return anSlotRows[GetSlot(dfValue)];
+
+        const auto oIter = oMapValueToRow.find(dfValue);
+        const int iRow = oIter == oMapValueToRow.end() ? -1 : oIter->second;
+        if (nFirstRowOfAnyValue >= 0 &&
+            (iRow < 0 || nFirstRowOfAnyValue < iRow))
+            return nFirstRowOfAnyValue;
+        return iRow;
+    }
+};
+
+/************************************************************************/
+/*                        BuildRowOfValueIndex()                        */
+/************************************************************************/
+
+void GDALDefaultRasterAttributeTable::BuildRowOfValueIndex()
+
+{
+    auto poIndex = std::make_shared<RowOfValueIndex>();
+
+    const GDALRasterAttributeField *poMin =
+        nMinCol != -1 ? &(aoFields[nMinCol]) : nullptr;
+    const GDALRasterAttributeField *poMax =
+        nMaxCol != -1 ? &(aoFields[nMaxCol]) : nullptr;
+
+    // Bound of a row, with NaN for no constraint (string columns are
+    // ignored).
+    const auto GetBound = [](const GDALRasterAttributeField *poField,
+                             int iRow)
+    {
+        if (poField != nullptr)
+        {
+            if (poField->eType == GFT_Integer)
+                return static_cast<double>(poField->anValues[iRow]);
+            if (poField->eType == GFT_Real)
+                return poField->adfValues[iRow];
+        }
+        return std::numeric_limits<double>::quiet_NaN();
+    };
+
+    if (poMin == poMax && poMin->eType != GFT_String)
+    {
+        poIndex->bExactValues = true;
+        poIndex->oMapValueToRow.reserve(nRowCount);
+        for (int iRow = nRowCount - 1; iRow >= 0; --iRow)
+        {
+            const double dfValue = GetBound(poMin, iRow);
+            if (std::isnan(dfValue))
+                poIndex->nFirstRowOfAnyValue = iRow;
+            else
+                poIndex->oMapValueToRow[dfValue] = iRow;
+        }
+    }
+    else
+    {
+        constexpr double dfInf = std::numeric_limits<double>::infinity();
+        std::vector<double> adfMin(nRowCount);
+        std::vector<double> adfMax(nRowCount);
+        for (int iRow = 0; iRow < nRowCount; iRow++)
+        {
+            adfMin[iRow] = GetBound(poMin, iRow);
+            if (std::isnan(adfMin[iRow]))
+                adfMin[iRow] = -dfInf;
+            adfMax[iRow] = GetBound(poMax, iRow);
+            if (std::isnan(adfMax[iRow]))
+                adfMax[iRow] = dfInf;
+            if (adfMin[iRow] <= adfMax[iRow])
+            {
+                poIndex->adfBounds.push_back(adfMin[iRow]);
+                poIndex->adfBounds.push_back(adfMax[iRow]);
+            }
+        }
+        std::sort(poIndex->adfBounds.begin(), poIndex->adfBounds.end());
+        poIndex->adfBounds.erase(std::unique(poIndex->adfBounds.begin(),
+                                             poIndex->adfBounds.end()),
+                                 poIndex->adfBounds.end());
+
+        // Assign each row to the slots of its range that are not assigned to
+        // a previous row yet. anNextSlot is used to skip the assigned slots.
+        const int nSlotCount =
+            static_cast<int>(2 * poIndex->adfBounds.size() + 1);
+        poIndex->anSlotRows.resize(nSlotCount, -1);
+        std::vector<int> anNextSlot(nSlotCount + 1);
+        for (int i = 0; i <= nSlotCount; ++i)
+            anNextSlot[i] = i;
+        const auto FindUnassignedSlot = [&anNextSlot](int iSlot)
+        {
+            int iRoot = iSlot;
+            while (anNextSlot[iRoot] != iRoot)
+                iRoot = anNextSlot[iRoot];
+            while (anNextSlot[iSlot] != iRoot)
+            {
+                const int iNext = anNextSlot[iSlot];
+                anNextSlot[iSlot] = iRoot;
+                iSlot = iNext;
+            }
+            return iRoot;
+        };
+        for (int iRow = 0; iRow < nRowCount; iRow++)
+        {
+            if (!(adfMin[iRow] <= adfMax[iRow]))
+                continue;
+            const int iLastSlot = poIndex->GetSlot(adfMax[iRow]);
+            for (int iSlot = FindUnassignedSlot(poIndex->GetSlot(adfMin[iRow]));
+                 iSlot <= iLastSlot; iSlot = FindUnassignedSlot(iSlot + 1))
+            {
+                poIndex->anSlotRows[iSlot] = iRow;
+                anNextSlot[iSlot] = iSlot + 1;
+            }
+        }
+    }
+
+    poRowOfValueIndex = std::move(poIndex);
+}
+
+/************************************************************************/
+/*                      InvalidateRowOfValueIndex()                     */
+/************************************************************************/
+
+void GDALDefaultRasterAttributeTable::InvalidateRowOfValueIndex()
+
+{
+    poRowOfValueIndex.reset();
+}
+
 /************************************************************************/
 /*                           GetRowOfValue()                            */
 /************************************************************************/
@@ -1925,52 +2196,20 @@ int GDALDefaultRasterAttributeTable::GetRowOfValue(double dfValue) const
     if (nMinCol == -1 && nMaxCol == -1)
         return -1;
 
-    const GDALRasterAttributeField *poMin = nullptr;
-    if (nMinCol != -1)
-        poMin = &(aoFields[nMinCol]);
-    else
-        poMin = nullptr;
-
-    const GDALRasterAttributeField *poMax = nullptr;
-    if (nMaxCol != -1)
-        poMax = &(aoFields[nMaxCol]);
-    else
-        poMax = nullptr;
+    // NaN compares false with any min or max, so matches the first row.
+    if (std::isnan(dfValue))
+        return nRowCount > 0 ? 0 : -1;
 
     /* -------------------------------------------------------------------- */
-    /*      Search through rows for match.                                  */
+    /*      Search through the index.                                       */
     /* -------------------------------------------------------------------- */
-    for (int iRow = 0; iRow < nRowCount; iRow++)
+    if (!poRowOfValueIndex)
     {
-        if (poMin != nullptr)
-        {
-            if (poMin->eType == GFT_Integer)
-            {
-                while (iRow < nRowCount && dfValue < poMin->anValues[iRow])
-                    iRow++;
-            }
-            else if (poMin->eType == GFT_Real)
-            {
-                while (iRow < nRowCount && dfValue < poMin->adfValues[iRow])
-                    iRow++;
-            }
-
-            if (iRow == nRowCount)
-                break;
-        }
-
-        if (poMax != nullptr)
-        {
-            if ((poMax->eType == GFT_Integer &&
-                 dfValue > poMax->anValues[iRow]) ||
-                (poMax->eType == GFT_Real && dfValue > poMax->adfValues[iRow]))
-                continue;
-        }
-
-        return iRow;
+        const_cast<GDALDefaultRasterAttributeTable *>(this)
+            ->BuildRowOfValueIndex();
     }
 
-    return -1;
+    return poRowOfValueIndex->Lookup(dfValue);
 }
 
 /************************************************************************/
@@ -2096,6 +2335,9 @@ GDALDefaultRasterAttributeTable::CreateColumn(const char *pszFieldName,
     else if (eFieldType == GFT_String)
         aoFields[iNewField].aosValues.resize(nRowCount);
 
+    bColumnsAnalysed = false;
+    InvalidateRowOfValueIndex();
+
     return CE_None;
 }
 
@@ -2148,6 +2390,9 @@ void GDALDefaultRasterAttributeTable::RemoveStatistics()
         }
     }
     aoFields = aoNewFields;
+
+    bColumnsAnalysed = false;
+    InvalidateRowOfValueIndex();
 }
 
 /************************************************************************/
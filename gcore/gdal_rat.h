@@ -266,6 +266,9 @@ class CPL_DLL GDALRasterAttributeTable
     virtual void SetRowCount(int iCount);
     virtual int GetRowOfValue(double dfValue) const;
     virtual int GetRowOfValue(int nValue) const;
+    virtual CPLErr GetRowsOfValues(const void *pValues,
+                                   GDALDataType eValueType, size_t nCount,
+                                   int *panRows) const;
 
     virtual CPLErr CreateColumn(const char *pszFieldName,
                                 GDALRATFieldType eFieldType,
@@ -359,6 +362,12 @@ class CPL_DLL GDALDefaultRasterAttributeTable : public GDALRasterAttributeTable
 
     int nRowCount = 0;
 
+    // Value to row lookup structure, built by GetRowOfValue().
+    struct RowOfValueIndex;
+    std::shared_ptr<const RowOfValueIndex> poRowOfValueIndex{};
+    void BuildRowOfValueIndex();
+    void InvalidateRowOfValueIndex();
+
     CPLString osWorkingResult{};
 
   public:
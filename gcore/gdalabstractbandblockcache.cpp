@@ -86,6 +86,7 @@ GDALAbstractBandBlockCache::~GDALAbstractBandBlockCache()
 void GDALAbstractBandBlockCache::UnreferenceBlockBase()
 {
     CPLAtomicInc(&nKeepAliveCounter);
+    m_nEvictions.fetch_add(1, std::memory_order_relaxed);
 }
 
 /************************************************************************/
@@ -198,6 +199,21 @@ GDALRasterBlock *GDALAbstractBandBlockCache::CreateBlock(int nXBlockOff,
     return poBlock;
 }
 
+/************************************************************************/
+/*                           GetStatistics()                            */
+/************************************************************************/
+
+void GDALAbstractBandBlockCache::GetStatistics(
+    GDALBlockCacheStatistics *psStats) const
+{
+    psStats->nHits += m_nHits.load(std::memory_order_relaxed);
+    psStats->nMisses += m_nMisses.load(std::memory_order_relaxed);
+    psStats->nEvictions += m_nEvictions.load(std::memory_order_relaxed);
+    psStats->nDirtyBlockFlushes +=
+        m_nDirtyBlockFlushes.load(std::memory_order_relaxed);
+    psStats->nCacheUsed += m_nCacheUsed.load(std::memory_order_relaxed);
+}
+
 /************************************************************************/
 /*                         IncDirtyBlocks()                             */
 /************************************************************************/
@@ -0,0 +1,323 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Second tier of the raster block cache, keeping evicted blocks
+ *           compressed in memory.
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, Even Rouault <even dot rouault at spatialys dot org>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_priv.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "cpl_compressor.h"
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_string.h"
+
+//! @cond Doxygen_Suppress
+
+/* ******************************************************************** */
+/*                      GDALCompressedBlockCache                        */
+/* ******************************************************************** */
+
+// Blocks evicted from the main block cache, for read-only datasets, are
+// compressed and kept in memory, up to GDAL_BLOCK_CACHE_COMPRESSED_SIZE bytes.
+// A block that is fetched back from this tier is removed from it, since it
+// is then again in the main block cache.
+
+namespace
+{
+struct BlockKey
+{
+    const GDALRasterBand *poBand;
+    int nYBlockOff;
+    int nXBlockOff;
+
+    bool operator<(const BlockKey &other) const
+    {
+        return std::tie(poBand, nYBlockOff, nXBlockOff) <
+               std::tie(other.poBand, other.nYBlockOff, other.nXBlockOff);
+    }
+};
+
+struct BlockEntry;
+typedef std::map<BlockKey, std::list<BlockEntry>::iterator> BlockMap;
+
+struct BlockEntry
+{
+    BlockMap::iterator oIterMap{};
+    const char *pszCompressorId = nullptr;
+    size_t nUncompressedSize = 0;
+    std::vector<GByte> abyCompressed{};
+};
+
+struct CompressedBlockCache
+{
+    std::mutex oMutex{};
+    BlockMap oMap{};
+    std::list<BlockEntry> oLRU{};  // Most recently stored first.
+    size_t nUsed = 0;
+    std::atomic<bool> bNonEmpty{false};
+};
+}  // namespace
+
+static CompressedBlockCache &GetCompressedBlockCache()
+{
+    static CompressedBlockCache oCache;
+    return oCache;
+}
+
+/************************************************************************/
+/*                      GetCompressedBlockCacheMax()                    */
+/************************************************************************/
+
+static size_t GetCompressedBlockCacheMax()
+{
+    const char *pszSize =
+        CPLGetConfigOption("GDAL_BLOCK_CACHE_COMPRESSED_SIZE", nullptr);
+    if (pszSize == nullptr)
+        return 0;
+    double dfSize = CPLAtof(pszSize);
+    if (strstr(pszSize, "MB"))
+        dfSize *= 1024 * 1024;
+    else if (strstr(pszSize, "GB"))
+        dfSize *= 1024 * 1024 * 1024;
+    if (!(dfSize > 0))
+        return 0;
+    if (dfSize >= static_cast<double>(std::numeric_limits<size_t>::max()))
+        return std::numeric_limits<size_t>::max();
+    return static_cast<size_t>(dfSize);
+}
+
+/************************************************************************/
+/*                         GetCompressorName()                          */
+/************************************************************************/
+
+static const char *GetCompressorName()
+{
+    const char *pszMethod =
+        CPLGetConfigOption("GDAL_BLOCK_CACHE_COMPRESSION", nullptr);
+    if (pszMethod)
+        return pszMethod;
+    // Prefer the fastest available compressor.
+    for (const char *pszCandidate : {"lz4", "zstd", "zlib"})
+    {
+        if (CPLGetCompressor(pszCandidate))
+            return pszCandidate;
+    }
+    return "zlib";
+}
+
+/************************************************************************/
+/*                          RemoveEntryLocked()                         */
+/************************************************************************/
+
+static void RemoveEntryLocked(CompressedBlockCache &oCache,
+                              std::list<BlockEntry>::iterator oIter)
+{
+    oCache.nUsed -= oIter->abyCompressed.size();
+    oCache.oMap.erase(oIter->oIterMap);
+    oCache.oLRU.erase(oIter);
+    oCache.bNonEmpty = !oCache.oLRU.empty();
+}
+
+/************************************************************************/
+/*                    GDALCompressedBlockCacheStore()                   */
+/************************************************************************/
+
+/** Compress the data of a clean block that is evicted from the main block
+ * cache, and store it in the compressed tier, if
+ * GDAL_BLOCK_CACHE_COMPRESSED_SIZE is set and the dataset of the block is
+ * opened in read-only mode.
+ *
+ * Must be called before the block data is released or recycled.
+ */
+void GDALCompressedBlockCacheStore(GDALRasterBlock *poBlock)
+{
+    const void *pData = poBlock->GetDataRef();
+    GDALRasterBand *poBand = poBlock->GetBand();
+    if (pData == nullptr || poBand == nullptr || poBlock->GetDirty())
+        return;
+    GDALDataset *poDS = poBand->GetDataset();
+    if (poDS == nullptr || poDS->GetAccess() != GA_ReadOnly)
+        return;
+
+    const size_t nMax = GetCompressedBlockCacheMax();
+    if (nMax == 0)
+        return;
+
+    const char *pszCompressor = GetCompressorName();
+    const CPLCompressor *psCompressor = CPLGetCompressor(pszCompressor);
+    if (psCompressor == nullptr)
+    {
+        static bool bWarned = false;
+        if (!bWarned)
+        {
+            bWarned = true;
+            CPLError(CE_Warning, CPLE_NotSupported,
+                     "GDAL_BLOCK_CACHE_COMPRESSION=%s: compressor not "
+                     "available",
+                     pszCompressor);
+        }
+        return;
+    }
+
+    const size_t nSize = static_cast<size_t>(poBlock->GetBlockSize());
+    CPLStringList aosOptions;
+    if (!EQUAL(pszCompressor, "lz4"))
+        aosOptions.SetNameValue("LEVEL", "1");
+
+    std::vector<GByte> abyCompressed;
+    size_t nCompressedSize = 0;
+    // Query the maximum compressed size, if the compressor knows it.
+    if (psCompressor->pfnFunc(pData, nSize, nullptr, &nCompressedSize,
+                              aosOptions.List(), psCompressor->user_data) &&
+        nCompressedSize > 0)
+    {
+        abyCompressed.resize(nCompressedSize);
+    }
+    else
+    {
+        abyCompressed.resize(nSize + nSize / 16 + 1024);
+        nCompressedSize = abyCompressed.size();
+    }
+    void *pOutput = abyCompressed.data();
+    if (!psCompressor->pfnFunc(pData, nSize, &pOutput, &nCompressedSize,
+                               aosOptions.List(), psCompressor->user_data))
+    {
+        return;
+    }
+    // Not worth keeping incompressible blocks.
+    if (nCompressedSize >= nSize || nCompressedSize > nMax)
+        return;
+    abyCompressed.resize(nCompressedSize);
+    abyCompressed.shrink_to_fit();
+
+    auto &oCache = GetCompressedBlockCache();
+    std::lock_guard<std::mutex> oLock(oCache.oMutex);
+
+    const BlockKey sKey{poBand, poBlock->GetYOff(), poBlock->GetXOff()};
+    auto oIterMap = oCache.oMap.find(sKey);
+    if (oIterMap != oCache.oMap.end())
+        RemoveEntryLocked(oCache, oIterMap->second);
+
+    while (oCache.nUsed + nCompressedSize > nMax && !oCache.oLRU.empty())
+        RemoveEntryLocked(oCache, std::prev(oCache.oLRU.end()));
+
+    oCache.oLRU.emplace_front();
+    auto oIter = oCache.oLRU.begin();
+    oIter->pszCompressorId = psCompressor->pszId;
+    oIter->nUncompressedSize = nSize;
+    oIter->abyCompressed = std::move(abyCompressed);
+    oIter->oIterMap = oCache.oMap.emplace(sKey, oIter).first;
+    oCache.nUsed += nCompressedSize;
+    oCache.bNonEmpty = true;
+}
+
+/************************************************************************/
+/*                    GDALCompressedBlockCacheFetch()                   */
+/************************************************************************/
+
+/** Decompress into pData the block of the compressed tier at the specified
+ * offsets, and remove it from the tier.
+ *
+ * @return true if the block was found and successfully decompressed.
+ */
+bool GDALCompressedBlockCacheFetch(GDALRasterBand *poBand, int nXBlockOff,
+                                   int nYBlockOff, void *pData, size_t nSize)
+{
+    auto &oCache = GetCompressedBlockCache();
+    if (!oCache.bNonEmpty)
+        return false;
+
+    BlockEntry oEntry;
+    {
+        std::lock_guard<std::mutex> oLock(oCache.oMutex);
+        auto oIterMap =
+            oCache.oMap.find(BlockKey{poBand, nYBlockOff, nXBlockOff});
+        if (oIterMap == oCache.oMap.end())
+            return false;
+        auto oIter = oIterMap->second;
+        oEntry.pszCompressorId = oIter->pszCompressorId;
+        oEntry.nUncompressedSize = oIter->nUncompressedSize;
+        oEntry.abyCompressed = std::move(oIter->abyCompressed);
+        oCache.nUsed -= oEntry.abyCompressed.size();
+        oIter->abyCompressed.clear();
+        RemoveEntryLocked(oCache, oIter);
+    }
+    if (oEntry.nUncompressedSize != nSize)
+        return false;
+
+    // GDAL_BLOCK_CACHE_COMPRESSION may have changed since the block was
+    // stored.
+    const CPLCompressor *psDecompressor =
+        CPLGetDecompressor(oEntry.pszCompressorId);
+    if (psDecompressor == nullptr)
+        return false;
+    size_t nOutSize = nSize;
+    if (!psDecompressor->pfnFunc(oEntry.abyCompressed.data(),
+                                 oEntry.abyCompressed.size(), &pData,
+                                 &nOutSize, nullptr,
+                                 psDecompressor->user_data) ||
+        nOutSize != nSize)
+    {
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                  GDALCompressedBlockCacheDropBand()                  */
+/************************************************************************/
+
+/** Remove all the blocks of a band from the compressed tier. */
+void GDALCompressedBlockCacheDropBand(GDALRasterBand *poBand)
+{
+    auto &oCache = GetCompressedBlockCache();
+    if (!oCache.bNonEmpty)
+        return;
+
+    std::lock_guard<std::mutex> oLock(oCache.oMutex);
+    auto oIterMap = oCache.oMap.lower_bound(
+        BlockKey{poBand, std::numeric_limits<int>::min(),
+                 std::numeric_limits<int>::min()});
+    while (oIterMap != oCache.oMap.end() && oIterMap->first.poBand == poBand)
+    {
+        auto oIter = oIterMap->second;
+        ++oIterMap;
+        RemoveEntryLocked(oCache, oIter);
+    }
+}
+
+//! @endcond
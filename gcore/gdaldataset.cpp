@@ -38,10 +38,12 @@
 #include <cstring>
 #include <algorithm>
 #include <map>
+#include <mutex>
 #include <new>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -49,6 +51,7 @@
 #include "cpl_multiproc.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_error.h"
 #include "ogr_api.h"
@@ -123,6 +126,15 @@ class GDALDataset::Private
 
     bool m_bOverviewsEnabled = true;
 
+    // Shared with the overview and mask datasets
+    std::shared_ptr<GDALBlockCacheSettings> m_poBlockCacheSettings{};
+
+    GDALCodecStatisticsCounters m_oCodecStatistics{};
+
+    // Idle clones of this dataset, for parallel reads
+    std::mutex m_oMutexParallelReadClones{};
+    std::vector<std::unique_ptr<GDALDataset>> m_apoParallelReadClones{};
+
     Private() = default;
 };
 
@@ -2598,12 +2610,19 @@ CPLErr GDALDataset::RasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
 
         psExtraArg = &sExtraArg;
     }
-    else if (psExtraArg->nVersion != RASTERIO_EXTRA_ARG_CURRENT_VERSION)
+    else if (psExtraArg->nVersion < 1 ||
+             psExtraArg->nVersion > RASTERIO_EXTRA_ARG_CURRENT_VERSION)
     {
         ReportError(CE_Failure, CPLE_AppDefined,
                     "Unhandled version of GDALRasterIOExtraArg");
         return CE_Failure;
     }
+    else if (psExtraArg->nVersion < RASTERIO_EXTRA_ARG_CURRENT_VERSION)
+    {
+        // Upgrade to the current version of the structure
+        GDALCopyRasterIOExtraArg(&sExtraArg, psExtraArg);
+        psExtraArg = &sExtraArg;
+    }
 
     GDALRasterIOExtraArgSetResampleAlg(psExtraArg, nXSize, nYSize, nBufXSize,
                                        nBufYSize);
@@ -2689,7 +2708,26 @@ CPLErr GDALDataset::RasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         }
     }
 
+    CPLTraceSpan oTraceSpan("GDALDataset::RasterIO");
+    if (oTraceSpan.IsEnabled())
+    {
+        oTraceSpan.SetAttribute("dataset", GetDescription());
+        oTraceSpan.SetAttribute("rw", eRWFlag == GF_Read ? "read" : "write");
+        oTraceSpan.SetAttribute("x", nXOff);
+        oTraceSpan.SetAttribute("y", nYOff);
+        oTraceSpan.SetAttribute("width", nXSize);
+        oTraceSpan.SetAttribute("height", nYSize);
+        oTraceSpan.SetAttribute("bands", nBandCount);
+        oTraceSpan.SetAttribute("bytes",
+                                static_cast<GIntBig>(nBufXSize) * nBufYSize *
+                                    nBandCount *
+                                    GDALGetDataTypeSizeBytes(eBufType));
+    }
+
     int bCallLeaveReadWrite = EnterReadWrite(eRWFlag);
+    const bool bStreaming = eRWFlag == GF_Read && psExtraArg->bStreaming;
+    if (bStreaming)
+        GDALRasterBlock::EnterStreamingRead();
 
     /* -------------------------------------------------------------------- */
     /*      We are being forced to use cached IO instead of a driver        */
@@ -2713,6 +2751,8 @@ CPLErr GDALDataset::RasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                          nPixelSpace, nLineSpace, nBandSpace, psExtraArg);
     }
 
+    if (bStreaming)
+        GDALRasterBlock::LeaveStreamingRead();
     if (bCallLeaveReadWrite)
         LeaveReadWrite();
 
@@ -3372,6 +3412,59 @@ static GDALDataset *GetSharedDS(const char *pszFilename,
     return nullptr;
 }
 
+/************************************************************************/
+/*                     IsDriverSpecificOpenOption()                     */
+/************************************************************************/
+
+// Open options that are handled by GDALOpenEx() for all drivers, unless a
+// driver declares an open option with the same name.
+static const char *const apszGenericOpenOptions[] = {
+    "OVERVIEW_LEVEL", "BLOCK_CACHE_PRIORITY", "BLOCK_CACHE_BUDGET"};
+
+static bool IsDriverSpecificOpenOption(GDALDriver *poDriver,
+                                       const char *pszOption)
+{
+    const char *pszOptionList =
+        poDriver->GetMetadataItem(GDAL_DMD_OPENOPTIONLIST);
+    return pszOptionList != nullptr &&
+           CPLString(pszOptionList).ifind(pszOption) != std::string::npos;
+}
+
+/************************************************************************/
+/*                     ApplyBlockCacheOpenOptions()                     */
+/************************************************************************/
+
+static void ApplyBlockCacheOpenOptions(GDALDataset *poDS, GDALDriver *poDriver,
+                                       CSLConstList papszOpenOptions)
+{
+    const char *pszPriority =
+        CSLFetchNameValue(papszOpenOptions, "BLOCK_CACHE_PRIORITY");
+    if (pszPriority &&
+        !IsDriverSpecificOpenOption(poDriver, "BLOCK_CACHE_PRIORITY"))
+    {
+        if (EQUAL(pszPriority, "HIGH"))
+            poDS->SetBlockCachePriority(GBCP_High);
+        else if (EQUAL(pszPriority, "NORMAL"))
+            poDS->SetBlockCachePriority(GBCP_Normal);
+        else
+            CPLError(CE_Warning, CPLE_NotSupported,
+                     "Invalid value for BLOCK_CACHE_PRIORITY: %s", pszPriority);
+    }
+
+    const char *pszBudget =
+        CSLFetchNameValue(papszOpenOptions, "BLOCK_CACHE_BUDGET");
+    if (pszBudget &&
+        !IsDriverSpecificOpenOption(poDriver, "BLOCK_CACHE_BUDGET"))
+    {
+        GIntBig nBudget = std::strtoll(pszBudget, nullptr, 10);
+        if (strstr(pszBudget, "MB"))
+            nBudget *= 1024 * 1024;
+        else if (strstr(pszBudget, "GB"))
+            nBudget *= 1024 * 1024 * 1024;
+        poDS->SetBlockCacheBudget(nBudget);
+    }
+}
+
 /************************************************************************/
 /*                             GDALOpenEx()                             */
 /************************************************************************/
@@ -3436,6 +3529,10 @@ static GDALDataset *GetSharedDS(const char *pszFilename,
  * from the same thread.</li> <li>Verbose error: GDAL_OF_VERBOSE_ERROR. If set,
  * a failed attempt to open the file will lead to an error message to be
  * reported.</li>
+ * <li>Thread-safe mode: GDAL_OF_THREAD_SAFE (since GDAL 3.9). If set, together
+ * with GDAL_OF_RASTER and without GDAL_OF_UPDATE, the returned dataset can be
+ * read concurrently from several threads (see GDALGetThreadSafeDataset()).
+ * </li>
  * </ul>
  *
  * @param papszAllowedDrivers NULL to consider all candidate drivers, or a NULL
@@ -3455,6 +3552,11 @@ static GDALDataset *GetSharedDS(const char *pszFilename,
  * that it may not cause a warning if the driver doesn't declare this option.
  * Starting with GDAL 3.3, OVERVIEW_LEVEL=NONE is supported to indicate that
  * no overviews should be exposed.
+ * Starting with GDAL 3.9, the BLOCK_CACHE_PRIORITY=NORMAL/HIGH and
+ * BLOCK_CACHE_BUDGET=bytes[MB|GB] options, also available for all drivers,
+ * can be used to set the priority and reserved budget of the dataset in the
+ * global raster block cache (see GDALDataset::SetBlockCachePriority() and
+ * GDALDataset::SetBlockCacheBudget()).
  *
  * @param papszSiblingFiles NULL, or a NULL terminated list of strings that are
  * filenames that are auxiliary to the main filename. If NULL is passed, a
@@ -3474,6 +3576,30 @@ GDALDatasetH CPL_STDCALL GDALOpenEx(const char *pszFilename,
 {
     VALIDATE_POINTER1(pszFilename, "GDALOpen", nullptr);
 
+    CPLTraceSpan oTraceSpan("GDALOpenEx");
+    oTraceSpan.SetAttribute("filename", pszFilename);
+
+    if (nOpenFlags & GDAL_OF_THREAD_SAFE)
+    {
+        if ((nOpenFlags & GDAL_OF_KIND_MASK) != GDAL_OF_RASTER ||
+            (nOpenFlags & (GDAL_OF_UPDATE | GDAL_OF_SHARED)) != 0)
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "GDAL_OF_THREAD_SAFE must be used with GDAL_OF_RASTER, "
+                     "and is incompatible with GDAL_OF_VECTOR, "
+                     "GDAL_OF_MULTIDIM_RASTER, GDAL_OF_UPDATE and "
+                     "GDAL_OF_SHARED");
+            return nullptr;
+        }
+        GDALDatasetH hDS = GDALOpenEx(
+            pszFilename, nOpenFlags & ~GDAL_OF_THREAD_SAFE, papszAllowedDrivers,
+            papszOpenOptions, papszSiblingFiles);
+        if (hDS == nullptr)
+            return nullptr;
+        return GDALDataset::ToHandle(
+            GDALCreateThreadSafeDataset(GDALDataset::FromHandle(hDS)));
+    }
+
     // If no driver kind is specified, assume all are to be probed.
     if ((nOpenFlags & GDAL_OF_KIND_MASK) == 0)
         nOpenFlags |= GDAL_OF_KIND_MASK & ~GDAL_OF_MULTIDIM_RASTER;
@@ -3576,16 +3702,36 @@ GDALDatasetH CPL_STDCALL GDALOpenEx(const char *pszFilename,
     //   to the first pass except it runs only on apoSecondPassDrivers drivers.
     //   And the Open() method of such drivers is used, causing them to be
     //   loaded for real.
-    int iPass = 1;
+    // When GDAL_OPEN_EXTENSION_FAST_PATH is enabled, a preliminary pass (0)
+    // probes the drivers that declare the extension of the file, and only
+    // opens with those whose Identify() method returns TRUE. Drivers whose
+    // Open() method has been tried in that pass are skipped in the first pass.
+    std::vector<GDALDriver *> apoExtensionDrivers;
+    std::vector<GDALDriver *> apoTriedDrivers;
+    if (oOpenInfo.bStatOK &&
+        CPLTestBool(CPLGetConfigOption("GDAL_OPEN_EXTENSION_FAST_PATH", "NO")))
+    {
+        apoExtensionDrivers = poDM->GetDriversForExtension(pszFilename);
+    }
+    int iPass = apoExtensionDrivers.empty() ? 1 : 0;
 retry:
     for (int iDriver = 0;
-         iDriver < (iPass == 1 ? nDriverCount
-                               : static_cast<int>(apoSecondPassDrivers.size()));
+         iDriver < (iPass == 0 ? static_cast<int>(apoExtensionDrivers.size())
+                    : iPass == 1
+                        ? nDriverCount
+                        : static_cast<int>(apoSecondPassDrivers.size()));
          ++iDriver)
     {
         GDALDriver *poDriver =
-            iPass == 1 ? poDM->GetDriver(iDriver, /*bIncludeHidden=*/true)
-                       : apoSecondPassDrivers[iDriver];
+            iPass == 0   ? apoExtensionDrivers[iDriver]
+            : iPass == 1 ? poDM->GetDriver(iDriver, /*bIncludeHidden=*/true)
+                         : apoSecondPassDrivers[iDriver];
+        if (iPass == 1 && !apoTriedDrivers.empty() &&
+            std::find(apoTriedDrivers.begin(), apoTriedDrivers.end(),
+                      poDriver) != apoTriedDrivers.end())
+        {
+            continue;
+        }
         if (papszAllowedDrivers != nullptr &&
             CSLFindString(papszAllowedDrivers,
                           GDALGetDriverShortName(poDriver)) == -1)
@@ -3609,26 +3755,32 @@ retry:
             poDriver->GetMetadataItem(GDAL_DCAP_MULTIDIM_RASTER) == nullptr)
             continue;
 
-        // Remove general OVERVIEW_LEVEL open options from list before passing
-        // it to the driver, if it isn't a driver specific option already.
+        // Remove general OVERVIEW_LEVEL, BLOCK_CACHE_PRIORITY and
+        // BLOCK_CACHE_BUDGET open options from list before passing it to the
+        // driver, if they aren't driver specific options already.
         char **papszTmpOpenOptions = nullptr;
         char **papszTmpOpenOptionsToValidate = nullptr;
         char **papszOptionsToValidate = const_cast<char **>(papszOpenOptions);
-        if (CSLFetchNameValue(papszOpenOptionsCleaned, "OVERVIEW_LEVEL") !=
-                nullptr &&
-            (poDriver->GetMetadataItem(GDAL_DMD_OPENOPTIONLIST) == nullptr ||
-             CPLString(poDriver->GetMetadataItem(GDAL_DMD_OPENOPTIONLIST))
-                     .ifind("OVERVIEW_LEVEL") == std::string::npos))
+        for (const char *pszGenericOption : apszGenericOpenOptions)
         {
-            papszTmpOpenOptions = CSLDuplicate(papszOpenOptionsCleaned);
-            papszTmpOpenOptions =
-                CSLSetNameValue(papszTmpOpenOptions, "OVERVIEW_LEVEL", nullptr);
-            oOpenInfo.papszOpenOptions = papszTmpOpenOptions;
-
-            papszOptionsToValidate = CSLDuplicate(papszOptionsToValidate);
-            papszOptionsToValidate = CSLSetNameValue(papszOptionsToValidate,
-                                                     "OVERVIEW_LEVEL", nullptr);
-            papszTmpOpenOptionsToValidate = papszOptionsToValidate;
+            if (CSLFetchNameValue(papszOpenOptionsCleaned, pszGenericOption) !=
+                    nullptr &&
+                !IsDriverSpecificOpenOption(poDriver, pszGenericOption))
+            {
+                if (papszTmpOpenOptions == nullptr)
+                {
+                    papszTmpOpenOptions = CSLDuplicate(papszOpenOptionsCleaned);
+                    papszOptionsToValidate =
+                        CSLDuplicate(papszOptionsToValidate);
+                }
+                papszTmpOpenOptions = CSLSetNameValue(
+                    papszTmpOpenOptions, pszGenericOption, nullptr);
+                oOpenInfo.papszOpenOptions = papszTmpOpenOptions;
+
+                papszOptionsToValidate = CSLSetNameValue(
+                    papszOptionsToValidate, pszGenericOption, nullptr);
+                papszTmpOpenOptionsToValidate = papszOptionsToValidate;
+            }
         }
 
         const int nIdentifyRes =
@@ -3643,6 +3795,14 @@ retry:
             oOpenInfo.papszOpenOptions = papszOpenOptionsCleaned;
             continue;
         }
+        else if (iPass == 0 && nIdentifyRes != GDAL_IDENTIFY_TRUE)
+        {
+            // Leave it to the first pass, in the normal driver order
+            CSLDestroy(papszTmpOpenOptions);
+            CSLDestroy(papszTmpOpenOptionsToValidate);
+            oOpenInfo.papszOpenOptions = papszOpenOptionsCleaned;
+            continue;
+        }
         else if (iPass == 1 && nIdentifyRes < 0 &&
                  poDriver->pfnOpen == nullptr &&
                  poDriver->GetMetadataItem("IS_NON_LOADED_PLUGIN"))
@@ -3661,6 +3821,9 @@ retry:
             GDALValidateOpenOptions(poDriver, papszOptionsToValidate);
         }
 
+        if (iPass == 0)
+            apoTriedDrivers.push_back(poDriver);
+
 #ifdef FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
         const bool bFpAvailableBefore = oOpenInfo.fpL != nullptr;
         CPLErrorReset();
@@ -3718,14 +3881,17 @@ retry:
                 papszOpenOptionsCleaned = nullptr;
             }
 
+            // Deal with generic BLOCK_CACHE_PRIORITY and BLOCK_CACHE_BUDGET
+            // open options, unless they are driver specific. This must be
+            // done before OVERVIEW_LEVEL, so that the settings are applied
+            // to the dataset that owns the cached blocks.
+            ApplyBlockCacheOpenOptions(poDS, poDriver, papszOpenOptions);
+
             // Deal with generic OVERVIEW_LEVEL open option, unless it is
             // driver specific.
             if (CSLFetchNameValue(papszOpenOptions, "OVERVIEW_LEVEL") !=
                     nullptr &&
-                (poDriver->GetMetadataItem(GDAL_DMD_OPENOPTIONLIST) ==
-                     nullptr ||
-                 CPLString(poDriver->GetMetadataItem(GDAL_DMD_OPENOPTIONLIST))
-                         .ifind("OVERVIEW_LEVEL") == std::string::npos))
+                !IsDriverSpecificOpenOption(poDriver, "OVERVIEW_LEVEL"))
             {
                 CPLString osVal(
                     CSLFetchNameValue(papszOpenOptions, "OVERVIEW_LEVEL"));
@@ -3808,6 +3974,7 @@ retry:
             }
 #endif
 
+            oTraceSpan.SetAttribute("driver", poDriver->GetDescription());
             return poDS;
         }
 
@@ -3836,6 +4003,12 @@ retry:
 #endif
     }
 
+    if (iPass == 0)
+    {
+        iPass = 1;
+        goto retry;
+    }
+
     // cppcheck-suppress knownConditionTrueFalse
     if (iPass == 1 && !apoSecondPassDrivers.empty())
     {
@@ -8697,6 +8870,808 @@ void GDALDatasetClearStatistics(GDALDatasetH hDS)
     GDALDataset::FromHandle(hDS)->ClearStatistics();
 }
 
+/************************************************************************/
+/*                      GetBlockCacheSettings()                         */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+GDALBlockCacheSettings *GDALDataset::GetBlockCacheSettings() const
+{
+    return m_poPrivate ? m_poPrivate->m_poBlockCacheSettings.get() : nullptr;
+}
+
+/************************************************************************/
+/*                            IsThreadSafe()                            */
+/************************************************************************/
+
+/** Return whether the raster read API (RasterIO(), and the getters of
+ * metadata, bands, overviews and masks) of this dataset can be used
+ * concurrently from several threads.
+ *
+ * The default implementation returns false. Datasets returned by
+ * GDALOpenEx() with GDAL_OF_THREAD_SAFE, or by GDALGetThreadSafeDataset(),
+ * return true.
+ *
+ * This is the same as the C function GDALDatasetIsThreadSafe().
+ *
+ * @since GDAL 3.9
+ */
+bool GDALDataset::IsThreadSafe() const
+{
+    return false;
+}
+
+/************************************************************************/
+/*                      GDALDatasetIsThreadSafe()                       */
+/************************************************************************/
+
+/** Return whether the raster read API of this dataset can be used
+ * concurrently from several threads.
+ *
+ * This is the same as the C++ method GDALDataset::IsThreadSafe().
+ *
+ * @since GDAL 3.9
+ */
+int GDALDatasetIsThreadSafe(GDALDatasetH hDS)
+{
+    VALIDATE_POINTER1(hDS, __func__, FALSE);
+    return GDALDataset::FromHandle(hDS)->IsThreadSafe();
+}
+
+/************************************************************************/
+/*                            CanBeCloned()                             */
+/************************************************************************/
+
+/** Return whether Clone() can be used on this dataset.
+ *
+ * The default implementation returns true for datasets opened in read-only
+ * mode, by a driver declaring GDAL_DCAP_PARALLEL_CLONE_READ.
+ *
+ * @since GDAL 3.9
+ */
+bool GDALDataset::CanBeCloned() const
+{
+    return poDriver != nullptr && eAccess == GA_ReadOnly &&
+           GetDescription()[0] != '\0' &&
+           CPLTestBool(CSLFetchNameValueDef(poDriver->GetMetadata(),
+                                            GDAL_DCAP_PARALLEL_CLONE_READ,
+                                            "NO"));
+}
+
+/************************************************************************/
+/*                               Clone()                                */
+/************************************************************************/
+
+/** Return a new read-only dataset giving access to the same raster data as
+ * this one, and that can be used independently from it (typically in
+ * another thread). Clones do not see later modifications of this dataset.
+ *
+ * The default implementation re-opens the dataset from its description and
+ * open options, with the same driver.
+ *
+ * @return a clone, or nullptr.
+ * @since GDAL 3.9
+ */
+std::unique_ptr<GDALDataset> GDALDataset::Clone() const
+{
+    if (poDriver == nullptr)
+        return nullptr;
+    const char *const apszAllowedDrivers[] = {poDriver->GetDescription(),
+                                              nullptr};
+    std::unique_ptr<GDALDataset> poClone;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        poClone.reset(GDALDataset::Open(GetDescription(), GDAL_OF_RASTER,
+                                        apszAllowedDrivers, papszOpenOptions,
+                                        nullptr));
+    }
+    if (poClone == nullptr || poClone->GetRasterXSize() != nRasterXSize ||
+        poClone->GetRasterYSize() != nRasterYSize ||
+        poClone->GetRasterCount() != nBands)
+    {
+        CPLDebug("GDAL", "Cannot open a clone of %s", GetDescription());
+        return nullptr;
+    }
+    return poClone;
+}
+
+/************************************************************************/
+/*                      AcquireParallelReadClone()                      */
+/************************************************************************/
+
+/** Return a dataset opened on the same file as this one, for the exclusive
+ * use of the caller, which must give it back with ReleaseParallelReadClone().
+ *
+ * Only available for datasets opened in read-only mode by a driver declaring
+ * GDAL_DCAP_PARALLEL_CLONE_READ.
+ *
+ * @return a clone, or nullptr.
+ */
+GDALDataset *GDALDataset::AcquireParallelReadClone()
+{
+    if (m_poPrivate == nullptr || poDriver == nullptr ||
+        eAccess != GA_ReadOnly ||
+        !CPLTestBool(CSLFetchNameValueDef(poDriver->GetMetadata(),
+                                          GDAL_DCAP_PARALLEL_CLONE_READ, "NO")))
+    {
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(
+            m_poPrivate->m_oMutexParallelReadClones);
+        auto &apoClones = m_poPrivate->m_apoParallelReadClones;
+        if (!apoClones.empty())
+        {
+            GDALDataset *poClone = apoClones.back().release();
+            apoClones.pop_back();
+            return poClone;
+        }
+    }
+
+    std::unique_ptr<GDALDataset> poClone;
+    {
+        // Clones are used from worker threads of the global thread pool, so
+        // they must not submit jobs to it themselves.
+        CPLConfigOptionSetter oNumThreadsSetter("GDAL_NUM_THREADS", "1",
+                                                false);
+        poClone = Clone();
+    }
+    return poClone.release();
+}
+
+/************************************************************************/
+/*                      ReleaseParallelReadClone()                      */
+/************************************************************************/
+
+/** Give back a clone returned by AcquireParallelReadClone(). It is kept
+ * opened for later parallel reads, until this dataset is closed.
+ */
+void GDALDataset::ReleaseParallelReadClone(GDALDataset *poClone)
+{
+    if (poClone == nullptr)
+        return;
+    std::lock_guard<std::mutex> oLock(m_poPrivate->m_oMutexParallelReadClones);
+    m_poPrivate->m_apoParallelReadClones.emplace_back(poClone);
+}
+
+/************************************************************************/
+/*                   GetOrCreateBlockCacheSettings()                    */
+/************************************************************************/
+
+GDALBlockCacheSettings *GDALDataset::GetOrCreateBlockCacheSettings()
+{
+    if (m_poPrivate == nullptr)
+        return nullptr;
+    if (m_poPrivate->m_poBlockCacheSettings)
+        return m_poPrivate->m_poBlockCacheSettings.get();
+
+    m_poPrivate->m_poBlockCacheSettings =
+        std::make_shared<GDALBlockCacheSettings>();
+
+    // Make overview and mask datasets share the same settings, so that the
+    // priority and the budget apply to all the blocks of this dataset.
+    const auto ShareWith = [this](GDALRasterBand *poOtherBand)
+    {
+        GDALDataset *poOtherDS = poOtherBand ? poOtherBand->GetDataset() : nullptr;
+        if (poOtherDS && poOtherDS != this && poOtherDS->m_poPrivate &&
+            !poOtherDS->m_poPrivate->m_poBlockCacheSettings)
+        {
+            poOtherDS->m_poPrivate->m_poBlockCacheSettings =
+                m_poPrivate->m_poBlockCacheSettings;
+        }
+    };
+    for (int iBand = 0; iBand < nBands; ++iBand)
+    {
+        GDALRasterBand *poBand = papoBands[iBand];
+        const int nOverviewCount = poBand->GetOverviewCount();
+        for (int iOvr = 0; iOvr < nOverviewCount; ++iOvr)
+        {
+            GDALRasterBand *poOvrBand = poBand->GetOverview(iOvr);
+            ShareWith(poOvrBand);
+            if (poOvrBand && (poOvrBand->GetMaskFlags() & GMF_PER_DATASET))
+                ShareWith(poOvrBand->GetMaskBand());
+        }
+        if (poBand->GetMaskFlags() & GMF_PER_DATASET)
+            ShareWith(poBand->GetMaskBand());
+    }
+
+    return m_poPrivate->m_poBlockCacheSettings.get();
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                       SetBlockCachePriority()                        */
+/************************************************************************/
+
+/**
+ \brief Set the priority class of the blocks of this dataset in the global
+ raster block cache.
+
+ Blocks of datasets with the GBCP_High priority are only evicted from the
+ block cache when no block of normal priority can be evicted. This is
+ useful to keep the working set of a latency-critical dataset resident when
+ other datasets are processed at the same time. The global
+ GDAL_CACHEMAX limit is still honored.
+
+ The setting also applies to the overview and mask datasets of the dataset,
+ and to blocks loaded in the cache after this call.
+
+ The priority can also be set with the BLOCK_CACHE_PRIORITY=NORMAL/HIGH open
+ option of GDALOpenEx().
+
+ This is the same as the C function GDALDatasetSetBlockCachePriority().
+
+ @param ePriority Priority class.
+ @since GDAL 3.9
+*/
+
+void GDALDataset::SetBlockCachePriority(GDALBlockCachePriority ePriority)
+{
+    GDALBlockCacheSettings *poSettings = GetOrCreateBlockCacheSettings();
+    if (poSettings)
+        poSettings->nPriority = ePriority;
+}
+
+/************************************************************************/
+/*                       GetBlockCachePriority()                        */
+/************************************************************************/
+
+/**
+ \brief Return the priority class of the blocks of this dataset in the global
+ raster block cache.
+
+ This is the same as the C function GDALDatasetGetBlockCachePriority().
+
+ @return priority class (GBCP_Normal by default)
+ @since GDAL 3.9
+*/
+
+GDALBlockCachePriority GDALDataset::GetBlockCachePriority() const
+{
+    const GDALBlockCacheSettings *poSettings = GetBlockCacheSettings();
+    return poSettings ? static_cast<GDALBlockCachePriority>(
+                            poSettings->nPriority.load())
+                      : GBCP_Normal;
+}
+
+/************************************************************************/
+/*                        SetBlockCacheBudget()                         */
+/************************************************************************/
+
+/**
+ \brief Set the amount of the global raster block cache reserved for this
+ dataset.
+
+ As long as the blocks of this dataset occupy less than nBytes in the block
+ cache, they are only evicted when no other block can be evicted. Beyond
+ that amount, they are evicted with the regular least-recently-used policy.
+ The global GDAL_CACHEMAX limit is still honored.
+
+ The budget is shared by the dataset with its overview and mask datasets,
+ and accounts for blocks loaded in the cache after this call.
+
+ The budget can also be set with the BLOCK_CACHE_BUDGET open option of
+ GDALOpenEx(), as a number of bytes, possibly suffixed with MB or GB.
+
+ This is the same as the C function GDALDatasetSetBlockCacheBudget().
+
+ @param nBytes Reserved amount, in bytes. 0 to disable the reservation.
+ @since GDAL 3.9
+*/
+
+void GDALDataset::SetBlockCacheBudget(GIntBig nBytes)
+{
+    GDALBlockCacheSettings *poSettings = GetOrCreateBlockCacheSettings();
+    if (poSettings)
+        poSettings->nBudget = std::max<GIntBig>(0, nBytes);
+}
+
+/************************************************************************/
+/*                        GetBlockCacheBudget()                         */
+/************************************************************************/
+
+/**
+ \brief Return the amount of the global raster block cache reserved for this
+ dataset.
+
+ This is the same as the C function GDALDatasetGetBlockCacheBudget().
+
+ @return reserved amount in bytes (0 by default)
+ @since GDAL 3.9
+*/
+
+GIntBig GDALDataset::GetBlockCacheBudget() const
+{
+    const GDALBlockCacheSettings *poSettings = GetBlockCacheSettings();
+    return poSettings ? poSettings->nBudget.load() : 0;
+}
+
+/************************************************************************/
+/*                         GetBlockCacheUsed()                          */
+/************************************************************************/
+
+/**
+ \brief Return the amount of the global raster block cache used by the
+ blocks of this dataset (and its overview and mask datasets).
+
+ Only blocks loaded in the cache after a call to SetBlockCachePriority() or
+ SetBlockCacheBudget() are accounted.
+
+ This is the same as the C function GDALDatasetGetBlockCacheUsed().
+
+ @return amount in bytes.
+ @since GDAL 3.9
+*/
+
+GIntBig GDALDataset::GetBlockCacheUsed() const
+{
+    const GDALBlockCacheSettings *poSettings = GetBlockCacheSettings();
+    return poSettings ? poSettings->nUsed.load() : 0;
+}
+
+/************************************************************************/
+/*                      GetBlockCacheStatistics()                       */
+/************************************************************************/
+
+/**
+ \brief Return the statistics of the raster block cache for the bands of this
+ dataset.
+
+ The statistics are the sum of the ones of each band of the dataset, as
+ returned by GDALRasterBand::GetBlockCacheStatistics(). Overview and mask
+ bands are not included.
+
+ This is the same as the C function GDALDatasetGetBlockCacheStatistics().
+
+ @param psStats Structure to fill. Must not be NULL.
+ @since GDAL 3.9
+*/
+
+void GDALDataset::GetBlockCacheStatistics(
+    GDALBlockCacheStatistics *psStats) const
+{
+    memset(psStats, 0, sizeof(*psStats));
+    for (int i = 0; i < nBands; ++i)
+    {
+        GDALBlockCacheStatistics sBandStats;
+        papoBands[i]->GetBlockCacheStatistics(&sBandStats);
+        psStats->nHits += sBandStats.nHits;
+        psStats->nMisses += sBandStats.nMisses;
+        psStats->nEvictions += sBandStats.nEvictions;
+        psStats->nDirtyBlockFlushes += sBandStats.nDirtyBlockFlushes;
+        psStats->nCacheUsed += sBandStats.nCacheUsed;
+    }
+}
+
+/************************************************************************/
+/*                     GetCodecStatisticsCounters()                     */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+GDALCodecStatisticsCounters *GDALDataset::GetCodecStatisticsCounters()
+{
+    return m_poPrivate ? &(m_poPrivate->m_oCodecStatistics) : nullptr;
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                  GetDatasetAndAuxiliaryDatasets()                    */
+/************************************************************************/
+
+// Return poDS, and its overview and mask datasets
+static std::set<GDALDataset *>
+GetDatasetAndAuxiliaryDatasets(GDALDataset *poDS)
+{
+    std::set<GDALDataset *> oSet{poDS};
+    const auto Add = [&oSet](GDALRasterBand *poBand)
+    {
+        GDALDataset *poOtherDS = poBand ? poBand->GetDataset() : nullptr;
+        if (poOtherDS)
+            oSet.insert(poOtherDS);
+    };
+    const int nBands = poDS->GetRasterCount();
+    for (int iBand = 1; iBand <= nBands; ++iBand)
+    {
+        GDALRasterBand *poBand = poDS->GetRasterBand(iBand);
+        const int nOverviewCount = poBand->GetOverviewCount();
+        for (int iOvr = 0; iOvr < nOverviewCount; ++iOvr)
+        {
+            GDALRasterBand *poOvrBand = poBand->GetOverview(iOvr);
+            Add(poOvrBand);
+            if (poOvrBand && (poOvrBand->GetMaskFlags() & GMF_PER_DATASET))
+                Add(poOvrBand->GetMaskBand());
+        }
+        if (poBand->GetMaskFlags() & GMF_PER_DATASET)
+            Add(poBand->GetMaskBand());
+    }
+    return oSet;
+}
+
+/************************************************************************/
+/*                         GetCodecStatistics()                         */
+/************************************************************************/
+
+/**
+ \brief Return the statistics of the decoding and encoding of the blocks of
+ this dataset by the codec of its driver.
+
+ The statistics include the ones of the overview and mask datasets. They are
+ accumulated since the opening of the dataset, or the last call to
+ ResetCodecStatistics().
+
+ Drivers which report codec statistics are GTiff (and thus COG), JPEG, PNG,
+ JP2OpenJPEG, Zarr and netCDF. The counters of other drivers are zero.
+
+ This is the same as the C function GDALDatasetGetCodecStatistics().
+
+ @param psStats Structure to fill. Must not be NULL.
+ @since GDAL 3.9
+*/
+
+void GDALDataset::GetCodecStatistics(GDALCodecStatistics *psStats) const
+{
+    memset(psStats, 0, sizeof(*psStats));
+    for (GDALDataset *poDS :
+         GetDatasetAndAuxiliaryDatasets(const_cast<GDALDataset *>(this)))
+    {
+        const auto poCounters = poDS->GetCodecStatisticsCounters();
+        if (poCounters)
+            poCounters->AddTo(psStats);
+    }
+}
+
+/************************************************************************/
+/*                        ResetCodecStatistics()                        */
+/************************************************************************/
+
+/**
+ \brief Reset the statistics of the decoding and encoding of the blocks of
+ this dataset, and of its overview and mask datasets.
+
+ This is the same as the C function GDALDatasetResetCodecStatistics().
+
+ @since GDAL 3.9
+*/
+
+void GDALDataset::ResetCodecStatistics()
+{
+    for (GDALDataset *poDS : GetDatasetAndAuxiliaryDatasets(this))
+    {
+        const auto poCounters = poDS->GetCodecStatisticsCounters();
+        if (poCounters)
+            poCounters->Reset();
+    }
+}
+
+//! @cond Doxygen_Suppress
+
+/************************************************************************/
+/*                 GDALCodecStatisticsCounters::AddTo()                 */
+/************************************************************************/
+
+void GDALCodecStatisticsCounters::AddTo(GDALCodecStatistics *psStats) const
+{
+    psStats->nBlocksDecoded += nBlocksDecoded.load(std::memory_order_relaxed);
+    psStats->nBytesFetched += nBytesFetched.load(std::memory_order_relaxed);
+    psStats->nBytesDecoded += nBytesDecoded.load(std::memory_order_relaxed);
+    psStats->dfDecodeTime +=
+        static_cast<double>(nDecodeTime.load(std::memory_order_relaxed)) * 1e-9;
+    psStats->nBlocksEncoded += nBlocksEncoded.load(std::memory_order_relaxed);
+    psStats->nBytesToEncode += nBytesToEncode.load(std::memory_order_relaxed);
+    psStats->nBytesEncoded += nBytesEncoded.load(std::memory_order_relaxed);
+    psStats->dfEncodeTime +=
+        static_cast<double>(nEncodeTime.load(std::memory_order_relaxed)) * 1e-9;
+}
+
+/************************************************************************/
+/*                 GDALCodecStatisticsCounters::Reset()                 */
+/************************************************************************/
+
+void GDALCodecStatisticsCounters::Reset()
+{
+    nBlocksDecoded = 0;
+    nBytesFetched = 0;
+    nBytesDecoded = 0;
+    nDecodeTime = 0;
+    nBlocksEncoded = 0;
+    nBytesToEncode = 0;
+    nBytesEncoded = 0;
+    nEncodeTime = 0;
+}
+
+/************************************************************************/
+/*                     GetThreadCodecStatistics()                       */
+/************************************************************************/
+
+static GDALCodecStatisticsCounters &GetThreadCodecStatistics()
+{
+    static thread_local GDALCodecStatisticsCounters oCounters;
+    return oCounters;
+}
+
+/************************************************************************/
+/*               GetThreadCodecStatisticsDefaultDataset()               */
+/************************************************************************/
+
+static GDALDataset *&GetThreadCodecStatisticsDefaultDataset()
+{
+    static thread_local GDALDataset *poDS = nullptr;
+    return poDS;
+}
+
+/************************************************************************/
+/*                     GDALCodecStatisticsRecorder                      */
+/************************************************************************/
+
+GDALCodecStatisticsRecorder::GDALCodecStatisticsRecorder(
+    GDALDataset *poDS, Operation eOperation)
+    : m_poDS(poDS), m_eOperation(eOperation),
+      m_oStart(std::chrono::steady_clock::now())
+{
+}
+
+GDALCodecStatisticsRecorder::~GDALCodecStatisticsRecorder()
+{
+    Account(m_poDS, m_eOperation, std::chrono::steady_clock::now() - m_oStart,
+            m_nEncodedSize, m_nDecodedSize);
+}
+
+void GDALCodecStatisticsRecorder::Account(
+    GDALDataset *poDS, Operation eOperation,
+    std::chrono::steady_clock::duration oElapsed, GIntBig nEncodedSize,
+    GIntBig nDecodedSize)
+{
+    const GIntBig nElapsed = static_cast<GIntBig>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(oElapsed)
+            .count());
+    const auto AccountIn = [=](GDALCodecStatisticsCounters &oCounters)
+    {
+        constexpr auto relaxed = std::memory_order_relaxed;
+        if (eOperation == Operation::DECODE)
+        {
+            oCounters.nBlocksDecoded.fetch_add(1, relaxed);
+            oCounters.nBytesFetched.fetch_add(nEncodedSize, relaxed);
+            oCounters.nBytesDecoded.fetch_add(nDecodedSize, relaxed);
+            oCounters.nDecodeTime.fetch_add(nElapsed, relaxed);
+        }
+        else
+        {
+            oCounters.nBlocksEncoded.fetch_add(1, relaxed);
+            oCounters.nBytesToEncode.fetch_add(nDecodedSize, relaxed);
+            oCounters.nBytesEncoded.fetch_add(nEncodedSize, relaxed);
+            oCounters.nEncodeTime.fetch_add(nElapsed, relaxed);
+        }
+    };
+    if (poDS == nullptr)
+        poDS = GetThreadCodecStatisticsDefaultDataset();
+    if (poDS)
+    {
+        const auto poCounters = poDS->GetCodecStatisticsCounters();
+        if (poCounters)
+            AccountIn(*poCounters);
+    }
+    AccountIn(GetThreadCodecStatistics());
+}
+
+GDALCodecStatisticsRecorder::DefaultDatasetSetter::DefaultDatasetSetter(
+    GDALDataset *poDS)
+    : m_poPrevDS(GetThreadCodecStatisticsDefaultDataset())
+{
+    GetThreadCodecStatisticsDefaultDataset() = poDS;
+}
+
+GDALCodecStatisticsRecorder::DefaultDatasetSetter::~DefaultDatasetSetter()
+{
+    GetThreadCodecStatisticsDefaultDataset() = m_poPrevDS;
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                  GDALDatasetSetBlockCachePriority()                  */
+/************************************************************************/
+
+/**
+ \brief Set the priority class of the blocks of this dataset in the global
+ raster block cache.
+
+ This is the same as the C++ method GDALDataset::SetBlockCachePriority().
+
+ @since GDAL 3.9
+*/
+
+void GDALDatasetSetBlockCachePriority(GDALDatasetH hDS,
+                                      GDALBlockCachePriority ePriority)
+{
+    VALIDATE_POINTER0(hDS, __func__);
+    GDALDataset::FromHandle(hDS)->SetBlockCachePriority(ePriority);
+}
+
+/************************************************************************/
+/*                  GDALDatasetGetBlockCachePriority()                  */
+/************************************************************************/
+
+/**
+ \brief Return the priority class of the blocks of this dataset in the global
+ raster block cache.
+
+ This is the same as the C++ method GDALDataset::GetBlockCachePriority().
+
+ @since GDAL 3.9
+*/
+
+GDALBlockCachePriority GDALDatasetGetBlockCachePriority(GDALDatasetH hDS)
+{
+    VALIDATE_POINTER1(hDS, __func__, GBCP_Normal);
+    return GDALDataset::FromHandle(hDS)->GetBlockCachePriority();
+}
+
+/************************************************************************/
+/*                   GDALDatasetSetBlockCacheBudget()                   */
+/************************************************************************/
+
+/**
+ \brief Set the amount of the global raster block cache reserved for this
+ dataset.
+
+ This is the same as the C++ method GDALDataset::SetBlockCacheBudget().
+
+ @since GDAL 3.9
+*/
+
+void GDALDatasetSetBlockCacheBudget(GDALDatasetH hDS, GIntBig nBytes)
+{
+    VALIDATE_POINTER0(hDS, __func__);
+    GDALDataset::FromHandle(hDS)->SetBlockCacheBudget(nBytes);
+}
+
+/************************************************************************/
+/*                   GDALDatasetGetBlockCacheBudget()                   */
+/************************************************************************/
+
+/**
+ \brief Return the amount of the global raster block cache reserved for this
+ dataset.
+
+ This is the same as the C++ method GDALDataset::GetBlockCacheBudget().
+
+ @since GDAL 3.9
+*/
+
+GIntBig GDALDatasetGetBlockCacheBudget(GDALDatasetH hDS)
+{
+    VALIDATE_POINTER1(hDS, __func__, 0);
+    return GDALDataset::FromHandle(hDS)->GetBlockCacheBudget();
+}
+
+/************************************************************************/
+/*                    GDALDatasetGetBlockCacheUsed()                    */
+/************************************************************************/
+
+/**
+ \brief Return the amount of the global raster block cache used by the
+ blocks of this dataset.
+
+ This is the same as the C++ method GDALDataset::GetBlockCacheUsed().
+
+ @since GDAL 3.9
+*/
+
+GIntBig GDALDatasetGetBlockCacheUsed(GDALDatasetH hDS)
+{
+    VALIDATE_POINTER1(hDS, __func__, 0);
+    return GDALDataset::FromHandle(hDS)->GetBlockCacheUsed();
+}
+
+/************************************************************************/
+/*                 GDALDatasetGetBlockCacheStatistics()                 */
+/************************************************************************/
+
+/**
+ \brief Return the statistics of the raster block cache for the bands of this
+ dataset.
+
+ This is the same as the C++ method GDALDataset::GetBlockCacheStatistics().
+
+ @since GDAL 3.9
+*/
+
+void GDALDatasetGetBlockCacheStatistics(GDALDatasetH hDS,
+                                        GDALBlockCacheStatistics *psStats)
+{
+    VALIDATE_POINTER0(hDS, __func__);
+    VALIDATE_POINTER0(psStats, __func__);
+    GDALDataset::FromHandle(hDS)->GetBlockCacheStatistics(psStats);
+}
+
+/************************************************************************/
+/*                   GDALDatasetGetCodecStatistics()                    */
+/************************************************************************/
+
+/**
+ \brief Return the statistics of the decoding and encoding of the blocks of
+ this dataset by the codec of its driver.
+
+ This is the same as the C++ method GDALDataset::GetCodecStatistics().
+
+ @since GDAL 3.9
+*/
+
+void GDALDatasetGetCodecStatistics(GDALDatasetH hDS,
+                                   GDALCodecStatistics *psStats)
+{
+    VALIDATE_POINTER0(hDS, __func__);
+    VALIDATE_POINTER0(psStats, __func__);
+    GDALDataset::FromHandle(hDS)->GetCodecStatistics(psStats);
+}
+
+/************************************************************************/
+/*                  GDALDatasetResetCodecStatistics()                   */
+/************************************************************************/
+
+/**
+ \brief Reset the statistics of the decoding and encoding of the blocks of
+ this dataset.
+
+ This is the same as the C++ method GDALDataset::ResetCodecStatistics().
+
+ @since GDAL 3.9
+*/
+
+void GDALDatasetResetCodecStatistics(GDALDatasetH hDS)
+{
+    VALIDATE_POINTER0(hDS, __func__);
+    GDALDataset::FromHandle(hDS)->ResetCodecStatistics();
+}
+
+/************************************************************************/
+/*                    GDALGetThreadCodecStatistics()                    */
+/************************************************************************/
+
+/**
+ \brief Return the statistics of the decoding and encoding of blocks, by
+ the codecs of all drivers, done in the current thread.
+
+ Blocks decoded or encoded by worker threads (for example with the
+ NUM_THREADS open option of the GTiff driver) are accounted in the
+ statistics of the worker threads, and not of the thread that issued the
+ request. They are accounted in the statistics of the dataset though.
+
+ This is for example useful to report the time spent in codecs by a request
+ of a server, by resetting the statistics with
+ GDALResetThreadCodecStatistics() at the beginning of the request.
+
+ @param psStats Structure to fill. Must not be NULL.
+ @since GDAL 3.9
+*/
+
+void GDALGetThreadCodecStatistics(GDALCodecStatistics *psStats)
+{
+    VALIDATE_POINTER0(psStats, __func__);
+    memset(psStats, 0, sizeof(*psStats));
+    GetThreadCodecStatistics().AddTo(psStats);
+}
+
+/************************************************************************/
+/*                   GDALResetThreadCodecStatistics()                   */
+/************************************************************************/
+
+/**
+ \brief Reset the statistics of the decoding and encoding of blocks done in
+ the current thread.
+
+ @since GDAL 3.9
+*/
+
+void GDALResetThreadCodecStatistics()
+{
+    GetThreadCodecStatistics().Reset();
+}
+
 /************************************************************************/
 /*                        GetFieldDomainNames()                         */
 /************************************************************************/
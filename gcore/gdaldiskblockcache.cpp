@@ -0,0 +1,393 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Persistent on-disk tier of the raster block cache, that can be
+ *           shared by several processes.
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, Even Rouault <even dot rouault at spatialys dot org>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_priv.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_sha256.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+
+//! @cond Doxygen_Suppress
+
+/* ******************************************************************** */
+/*                          GDALDiskBlockCache                          */
+/* ******************************************************************** */
+
+// When GDAL_BLOCK_CACHE_DISK_DIR is set, the blocks of read-only datasets
+// are written, once read with IReadBlock(), into that directory, one file per
+// block, so that other processes (or later runs) opening the same file can
+// reuse them instead of fetching and decoding them again.
+//
+// A block is identified by the dataset name, its open options and driver, a
+// validator of the file content
+// (its size, its modification time and its ETag for network file systems),
+// the band number, the raster dimensions (so that overview levels are
+// distinguished), the data type, the block size and the block offsets.
+// The SHA256 of that key gives the file name. The key is also written at the
+// beginning of the file, to detect collisions.
+//
+// Files are written to a temporary name and renamed, so that concurrent
+// processes never see partially written blocks. The size of the directory is
+// bounded by GDAL_BLOCK_CACHE_DISK_SIZE: once the bytes written by the
+// current process would make it exceed that size, the oldest files are
+// removed.
+
+constexpr const char DISK_BLOCK_MAGIC[] = "GDALBLK1";
+constexpr size_t DISK_BLOCK_MAGIC_SIZE = sizeof(DISK_BLOCK_MAGIC) - 1;
+
+namespace
+{
+struct DiskBlockCache
+{
+    std::mutex oMutex{};
+    // Key prefix of each band. Empty string if the band cannot be cached.
+    std::map<const GDALRasterBand *, std::string> oMapBandPrefix{};
+    std::atomic<bool> bHasBandPrefix{false};
+    // Estimated size of the cache directory. -1 if not known yet.
+    GIntBig nEstimatedSize = -1;
+};
+}  // namespace
+
+static DiskBlockCache &GetDiskBlockCache()
+{
+    static DiskBlockCache oCache;
+    return oCache;
+}
+
+/************************************************************************/
+/*                        GetDiskBlockCacheMax()                        */
+/************************************************************************/
+
+static GIntBig GetDiskBlockCacheMax()
+{
+    const char *pszSize =
+        CPLGetConfigOption("GDAL_BLOCK_CACHE_DISK_SIZE", "1GB");
+    double dfSize = CPLAtof(pszSize);
+    if (strstr(pszSize, "MB"))
+        dfSize *= 1024 * 1024;
+    else if (strstr(pszSize, "GB"))
+        dfSize *= 1024 * 1024 * 1024;
+    if (!(dfSize > 0))
+        return 0;
+    if (dfSize >= static_cast<double>(std::numeric_limits<GIntBig>::max()))
+        return std::numeric_limits<GIntBig>::max();
+    return static_cast<GIntBig>(dfSize);
+}
+
+/************************************************************************/
+/*                          ComputeBandPrefix()                         */
+/************************************************************************/
+
+static std::string ComputeBandPrefix(GDALRasterBand *poBand)
+{
+    GDALDataset *poDS = poBand->GetDataset();
+    if (poDS == nullptr || poDS->GetAccess() != GA_ReadOnly ||
+        poBand->IsMaskBand())
+        return std::string();
+    const int nBand = poBand->GetBand();
+    if (nBand <= 0 || poDS->GetRasterBand(nBand) != poBand)
+        return std::string();
+    const char *pszFilename = poDS->GetDescription();
+    if (pszFilename[0] == '\0')
+        return std::string();
+
+    VSIStatBufL sStat;
+    if (VSIStatL(pszFilename, &sStat) != 0 || VSI_ISDIR(sStat.st_mode))
+        return std::string();
+
+    std::string osPrefix(pszFilename);
+    // Open options might change the pixel values.
+    for (CSLConstList papszIter = poDS->GetOpenOptions();
+         papszIter && *papszIter; ++papszIter)
+    {
+        osPrefix += '|';
+        osPrefix += *papszIter;
+    }
+    if (poDS->GetDriver())
+    {
+        osPrefix += '|';
+        osPrefix += poDS->GetDriver()->GetDescription();
+    }
+    osPrefix += CPLSPrintf("|" CPL_FRMT_GUIB "|" CPL_FRMT_GIB,
+                           static_cast<GUIntBig>(sStat.st_size),
+                           static_cast<GIntBig>(sStat.st_mtime));
+    if (STARTS_WITH(pszFilename, "/vsi"))
+    {
+        char **papszHeaders =
+            VSIGetFileMetadata(pszFilename, "HEADERS", nullptr);
+        const char *pszETag = CSLFetchNameValue(papszHeaders, "ETag");
+        if (pszETag)
+        {
+            osPrefix += '|';
+            osPrefix += pszETag;
+        }
+        CSLDestroy(papszHeaders);
+    }
+
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    osPrefix += CPLSPrintf("|%d|%dx%d|%s|%dx%d", nBand, poBand->GetXSize(),
+                           poBand->GetYSize(),
+                           GDALGetDataTypeName(poBand->GetRasterDataType()),
+                           nBlockXSize, nBlockYSize);
+    return osPrefix;
+}
+
+/************************************************************************/
+/*                              GetBlockKey()                           */
+/************************************************************************/
+
+// Return the key of the block, or an empty string if it cannot be cached.
+static std::string GetBlockKey(GDALRasterBand *poBand, int nXBlockOff,
+                               int nYBlockOff)
+{
+    auto &oCache = GetDiskBlockCache();
+    std::string osPrefix;
+    bool bFound = false;
+    {
+        std::lock_guard<std::mutex> oLock(oCache.oMutex);
+        auto oIter = oCache.oMapBandPrefix.find(poBand);
+        if (oIter != oCache.oMapBandPrefix.end())
+        {
+            bFound = true;
+            osPrefix = oIter->second;
+        }
+    }
+    if (!bFound)
+    {
+        osPrefix = ComputeBandPrefix(poBand);
+        std::lock_guard<std::mutex> oLock(oCache.oMutex);
+        oCache.oMapBandPrefix[poBand] = osPrefix;
+        oCache.bHasBandPrefix = true;
+    }
+    if (osPrefix.empty())
+        return std::string();
+    return osPrefix + CPLSPrintf("|%d,%d", nXBlockOff, nYBlockOff);
+}
+
+/************************************************************************/
+/*                           GetBlockFilename()                         */
+/************************************************************************/
+
+static std::string GetBlockFilename(const char *pszDir,
+                                    const std::string &osKey)
+{
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256(osKey.data(), osKey.size(), abyHash);
+    char *pszHex = CPLBinaryToHex(CPL_SHA256_HASH_SIZE, abyHash);
+    const std::string osHex(pszHex);
+    CPLFree(pszHex);
+    const std::string osSubDir =
+        CPLFormFilename(pszDir, osHex.substr(0, 2).c_str(), nullptr);
+    return CPLFormFilename(osSubDir.c_str(), osHex.c_str(), "blk");
+}
+
+/************************************************************************/
+/*                         PruneDiskBlockCache()                        */
+/************************************************************************/
+
+// Remove the oldest files of the cache directory until its size is below
+// 80% of nMax. Must be called with the mutex held.
+static void PruneDiskBlockCache(DiskBlockCache &oCache, const char *pszDir,
+                                GIntBig nMax)
+{
+    std::vector<std::pair<GIntBig, std::pair<GIntBig, std::string>>> aoFiles;
+    GIntBig nTotalSize = 0;
+    const CPLStringList aosFiles(VSIReadDirRecursive(pszDir));
+    for (const char *pszFile : aosFiles)
+    {
+        if (!EQUAL(CPLGetExtension(pszFile), "blk"))
+            continue;
+        const std::string osFilename =
+            CPLFormFilename(pszDir, pszFile, nullptr);
+        VSIStatBufL sStat;
+        if (VSIStatL(osFilename.c_str(), &sStat) == 0 &&
+            !VSI_ISDIR(sStat.st_mode))
+        {
+            nTotalSize += static_cast<GIntBig>(sStat.st_size);
+            aoFiles.emplace_back(
+                static_cast<GIntBig>(sStat.st_mtime),
+                std::make_pair(static_cast<GIntBig>(sStat.st_size),
+                               osFilename));
+        }
+    }
+
+    if (nTotalSize > nMax / 10 * 8)
+    {
+        std::sort(aoFiles.begin(), aoFiles.end());
+        for (const auto &oFile : aoFiles)
+        {
+            if (nTotalSize <= nMax / 10 * 8)
+                break;
+            // Another process may have removed it already.
+            if (VSIUnlink(oFile.second.second.c_str()) == 0)
+                nTotalSize -= oFile.second.first;
+        }
+    }
+    oCache.nEstimatedSize = nTotalSize;
+}
+
+/************************************************************************/
+/*                      GDALDiskBlockCacheFetch()                       */
+/************************************************************************/
+
+/** Read into pData the block at the specified offsets from the on-disk
+ * tier of the block cache.
+ *
+ * @return true if the block was found.
+ */
+bool GDALDiskBlockCacheFetch(GDALRasterBand *poBand, int nXBlockOff,
+                             int nYBlockOff, void *pData, size_t nSize)
+{
+    const char *pszDir = CPLGetConfigOption("GDAL_BLOCK_CACHE_DISK_DIR", nullptr);
+    if (pszDir == nullptr || pszDir[0] == '\0')
+        return false;
+
+    const std::string osKey = GetBlockKey(poBand, nXBlockOff, nYBlockOff);
+    if (osKey.empty())
+        return false;
+
+    VSILFILE *fp =
+        VSIFOpenL(GetBlockFilename(pszDir, osKey).c_str(), "rb");
+    if (fp == nullptr)
+        return false;
+
+    bool bOK = false;
+    char szMagic[DISK_BLOCK_MAGIC_SIZE] = {0};
+    GUInt32 nKeySize = 0;
+    GUInt64 nDataSize = 0;
+    if (VSIFReadL(szMagic, DISK_BLOCK_MAGIC_SIZE, 1, fp) == 1 &&
+        memcmp(szMagic, DISK_BLOCK_MAGIC, DISK_BLOCK_MAGIC_SIZE) == 0 &&
+        VSIFReadL(&nKeySize, sizeof(nKeySize), 1, fp) == 1 &&
+        nKeySize == osKey.size())
+    {
+        std::string osFileKey;
+        osFileKey.resize(nKeySize);
+        if (VSIFReadL(&osFileKey[0], nKeySize, 1, fp) == 1 &&
+            osFileKey == osKey &&
+            VSIFReadL(&nDataSize, sizeof(nDataSize), 1, fp) == 1 &&
+            nDataSize == nSize && VSIFReadL(pData, nSize, 1, fp) == 1)
+        {
+            bOK = true;
+        }
+    }
+    VSIFCloseL(fp);
+    return bOK;
+}
+
+/************************************************************************/
+/*                      GDALDiskBlockCacheStore()                       */
+/************************************************************************/
+
+/** Write a block that has just been read with IReadBlock() into the on-disk
+ * tier of the block cache.
+ */
+void GDALDiskBlockCacheStore(GDALRasterBand *poBand, int nXBlockOff,
+                             int nYBlockOff, const void *pData, size_t nSize)
+{
+    const char *pszDir = CPLGetConfigOption("GDAL_BLOCK_CACHE_DISK_DIR", nullptr);
+    if (pszDir == nullptr || pszDir[0] == '\0')
+        return;
+    const GIntBig nMax = GetDiskBlockCacheMax();
+    if (nMax == 0)
+        return;
+
+    const std::string osKey = GetBlockKey(poBand, nXBlockOff, nYBlockOff);
+    if (osKey.empty())
+        return;
+
+    const std::string osFilename = GetBlockFilename(pszDir, osKey);
+    const GIntBig nFileSize = static_cast<GIntBig>(
+        DISK_BLOCK_MAGIC_SIZE + sizeof(GUInt32) + osKey.size() +
+        sizeof(GUInt64) + nSize);
+    if (nFileSize > nMax)
+        return;
+
+    auto &oCache = GetDiskBlockCache();
+    {
+        std::lock_guard<std::mutex> oLock(oCache.oMutex);
+        if (oCache.nEstimatedSize < 0 ||
+            oCache.nEstimatedSize + nFileSize > nMax)
+        {
+            PruneDiskBlockCache(oCache, pszDir, nMax);
+        }
+        oCache.nEstimatedSize += nFileSize;
+    }
+
+    VSIMkdirRecursive(CPLGetPath(osFilename.c_str()), 0755);
+
+    // Write into a temporary file first, so that other processes never read
+    // a partially written block.
+    const std::string osTmpFilename =
+        osFilename + CPLSPrintf("." CPL_FRMT_GIB ".tmp", CPLGetPID());
+    VSILFILE *fp = VSIFOpenL(osTmpFilename.c_str(), "wb");
+    if (fp == nullptr)
+        return;
+    const GUInt32 nKeySize = static_cast<GUInt32>(osKey.size());
+    const GUInt64 nDataSize = static_cast<GUInt64>(nSize);
+    bool bOK =
+        VSIFWriteL(DISK_BLOCK_MAGIC, DISK_BLOCK_MAGIC_SIZE, 1, fp) == 1 &&
+        VSIFWriteL(&nKeySize, sizeof(nKeySize), 1, fp) == 1 &&
+        VSIFWriteL(osKey.data(), osKey.size(), 1, fp) == 1 &&
+        VSIFWriteL(&nDataSize, sizeof(nDataSize), 1, fp) == 1 &&
+        VSIFWriteL(pData, nSize, 1, fp) == 1;
+    bOK = VSIFCloseL(fp) == 0 && bOK;
+    if (!bOK || VSIRename(osTmpFilename.c_str(), osFilename.c_str()) != 0)
+        VSIUnlink(osTmpFilename.c_str());
+}
+
+/************************************************************************/
+/*                     GDALDiskBlockCacheDropBand()                     */
+/************************************************************************/
+
+/** Forget the key prefix computed for a band. */
+void GDALDiskBlockCacheDropBand(GDALRasterBand *poBand)
+{
+    auto &oCache = GetDiskBlockCache();
+    if (!oCache.bHasBandPrefix)
+        return;
+    std::lock_guard<std::mutex> oLock(oCache.oMutex);
+    oCache.oMapBandPrefix.erase(poBand);
+    oCache.bHasBandPrefix = !oCache.oMapBandPrefix.empty();
+}
+
+//! @endcond
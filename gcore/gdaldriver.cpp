@@ -2807,6 +2807,12 @@ CPLErr GDALDriver::SetMetadataItem(const char *pszName, const char *pszValue,
         {
             GDALMajorObject::SetMetadataItem(GDAL_DMD_EXTENSION, pszValue);
         }
+
+        if (EQUAL(pszName, GDAL_DMD_EXTENSION) ||
+            EQUAL(pszName, GDAL_DMD_EXTENSIONS))
+        {
+            GDALDriverManager::InvalidateExtensionMap();
+        }
     }
     return GDALMajorObject::SetMetadataItem(pszName, pszValue, pszDomain);
 }
@@ -560,6 +560,7 @@ int GDALDriverManager::RegisterDriver(GDALDriver *poDriver, bool bHidden)
 
     papoDrivers[nDrivers] = poDriver;
     ++nDrivers;
+    m_bExtensionMapDirty = true;
 
     oMapNameToDrivers[CPLString(poDriver->GetDescription()).toupper()] =
         poDriver;
@@ -619,6 +620,7 @@ void GDALDriverManager::DeregisterDriver(GDALDriver *poDriver)
 
     oMapNameToDrivers.erase(CPLString(poDriver->GetDescription()).toupper());
     --nDrivers;
+    m_bExtensionMapDirty = true;
     // Move all following drivers down by one to pack the list.
     while (i < nDrivers)
     {
@@ -1216,9 +1218,85 @@ void GDALDriverManager::ReorderDrivers()
         CPLAssert(oIter != oMapNameToDrivers.end());
         papoDrivers[i] = oIter->second;
     }
+    m_bExtensionMapDirty = true;
 #endif
 }
 
+/************************************************************************/
+/*                       GetDriversForExtension()                       */
+/************************************************************************/
+
+/** Return the registered drivers declaring the extension of pszFilename in
+ * their GDAL_DMD_EXTENSIONS metadata item, in registration order.
+ *
+ * A double extension (e.g. "gpkg.zip") declared by a driver is also matched.
+ */
+std::vector<GDALDriver *>
+GDALDriverManager::GetDriversForExtension(const char *pszFilename)
+{
+    CPLMutexHolderD(&hDMMutex);
+
+    if (m_bExtensionMapDirty)
+    {
+        m_oMapExtensionToDrivers.clear();
+        for (int i = 0; i < nDrivers; ++i)
+        {
+            GDALDriver *poDriver = papoDrivers[i];
+            const CPLStringList aosExtensions(CSLTokenizeString(
+                poDriver->GetMetadataItem(GDAL_DMD_EXTENSIONS)));
+            for (const char *pszExt : aosExtensions)
+            {
+                auto &apoDrivers =
+                    m_oMapExtensionToDrivers[CPLString(pszExt).tolower()];
+                if (apoDrivers.empty() || apoDrivers.back() != poDriver)
+                    apoDrivers.push_back(poDriver);
+            }
+        }
+        m_bExtensionMapDirty = false;
+    }
+
+    std::vector<GDALDriver *> apoDrivers;
+    const auto AddDriversForExtension = [this, &apoDrivers](const char *pszExt)
+    {
+        const auto oIter =
+            m_oMapExtensionToDrivers.find(CPLString(pszExt).tolower());
+        if (oIter == m_oMapExtensionToDrivers.end())
+            return;
+        for (GDALDriver *poDriver : oIter->second)
+        {
+            if (std::find(apoDrivers.begin(), apoDrivers.end(), poDriver) ==
+                apoDrivers.end())
+            {
+                apoDrivers.push_back(poDriver);
+            }
+        }
+    };
+
+    const std::string osExt = CPLGetExtension(pszFilename);
+    if (osExt.empty())
+        return apoDrivers;
+    const std::string osPrevExt = CPLGetExtension(CPLGetBasename(pszFilename));
+    if (!osPrevExt.empty())
+        AddDriversForExtension((osPrevExt + '.' + osExt).c_str());
+    AddDriversForExtension(osExt.c_str());
+
+    return apoDrivers;
+}
+
+/************************************************************************/
+/*                       InvalidateExtensionMap()                       */
+/************************************************************************/
+
+/** Force the map from extensions to drivers to be rebuilt on next use. */
+void GDALDriverManager::InvalidateExtensionMap()
+{
+    if (poDM != nullptr)
+    {
+        CPLMutexHolderD(&hDMMutex);
+        const_cast<GDALDriverManager *>(poDM)->m_bExtensionMapDirty = true;
+    }
+}
+
 /************************************************************************/
 /*                       GDALPluginDriverProxy                          */
 /************************************************************************/
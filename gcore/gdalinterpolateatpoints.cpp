@@ -0,0 +1,417 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Implementation of GDALRasterBand::InterpolateAtPoints()
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, Even Rouault <even dot rouault at spatialys dot org>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_priv.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "cpl_error.h"
+
+namespace
+{
+/************************************************************************/
+/*                           BlockValuesCache                           */
+/************************************************************************/
+
+// Small cache of the most recently used blocks of a band, converted to
+// double. As points are processed in block order, a few blocks are
+// enough for the kernels overlapping block boundaries.
+class BlockValuesCache
+{
+    struct CachedBlock
+    {
+        int nXBlock = -1;
+        int nYBlock = -1;
+        std::vector<double> adfValues{};
+    };
+
+    static constexpr size_t MAX_BLOCKS = 4;
+
+    GDALRasterBand *m_poBand = nullptr;
+    int m_nXSize = 0;
+    int m_nYSize = 0;
+    int m_nBlockXSize = 0;
+    int m_nBlockYSize = 0;
+    bool m_bHasNoData = false;
+    double m_dfNoData = 0;
+    std::vector<CachedBlock> m_aoBlocks{};  // most recently used first
+    bool m_bError = false;
+
+    const double *GetBlock(int nXBlock, int nYBlock);
+
+  public:
+    explicit BlockValuesCache(GDALRasterBand *poBand) : m_poBand(poBand)
+    {
+        m_nXSize = poBand->GetXSize();
+        m_nYSize = poBand->GetYSize();
+        poBand->GetBlockSize(&m_nBlockXSize, &m_nBlockYSize);
+        int bHasNoData = FALSE;
+        m_dfNoData = poBand->GetNoDataValue(&bHasNoData);
+        m_bHasNoData = CPL_TO_BOOL(bHasNoData);
+    }
+
+    bool HasError() const
+    {
+        return m_bError;
+    }
+
+    int GetBlockXSize() const
+    {
+        return m_nBlockXSize;
+    }
+
+    int GetBlockYSize() const
+    {
+        return m_nBlockYSize;
+    }
+
+    // Fetch the value of the pixel at (nX, nY), clamped to the raster
+    // extent. Returns false if the value is nodata or in case of error.
+    bool GetValue(int nX, int nY, double &dfValue)
+    {
+        nX = std::clamp(nX, 0, m_nXSize - 1);
+        nY = std::clamp(nY, 0, m_nYSize - 1);
+        const double *padfBlock =
+            GetBlock(nX / m_nBlockXSize, nY / m_nBlockYSize);
+        if (padfBlock == nullptr)
+            return false;
+        dfValue = padfBlock[static_cast<size_t>(nY % m_nBlockYSize) *
+                                m_nBlockXSize +
+                            nX % m_nBlockXSize];
+        if (std::isnan(dfValue))
+            return false;
+        return !(m_bHasNoData && dfValue == m_dfNoData);
+    }
+};
+
+/************************************************************************/
+/*                              GetBlock()                              */
+/************************************************************************/
+
+const double *BlockValuesCache::GetBlock(int nXBlock, int nYBlock)
+{
+    for (size_t i = 0; i < m_aoBlocks.size(); ++i)
+    {
+        if (m_aoBlocks[i].nXBlock == nXBlock &&
+            m_aoBlocks[i].nYBlock == nYBlock)
+        {
+            if (i > 0)
+                std::rotate(m_aoBlocks.begin(), m_aoBlocks.begin() + i,
+                            m_aoBlocks.begin() + i + 1);
+            return m_aoBlocks[0].adfValues.data();
+        }
+    }
+    if (m_bError)
+        return nullptr;
+
+    GDALRasterBlock *poBlock = m_poBand->GetLockedBlockRef(nXBlock, nYBlock);
+    if (poBlock == nullptr)
+    {
+        m_bError = true;
+        return nullptr;
+    }
+
+    if (m_aoBlocks.size() < MAX_BLOCKS)
+        m_aoBlocks.emplace_back();
+    std::rotate(m_aoBlocks.begin(), m_aoBlocks.end() - 1, m_aoBlocks.end());
+    CachedBlock &oBlock = m_aoBlocks[0];
+    oBlock.nXBlock = nXBlock;
+    oBlock.nYBlock = nYBlock;
+    const size_t nPixels = static_cast<size_t>(m_nBlockXSize) * m_nBlockYSize;
+    oBlock.adfValues.resize(nPixels);
+    // The real part is taken for complex data types.
+    GDALCopyWords64(poBlock->GetDataRef(), poBlock->GetDataType(),
+                    GDALGetDataTypeSizeBytes(poBlock->GetDataType()),
+                    oBlock.adfValues.data(), GDT_Float64, sizeof(double),
+                    nPixels);
+    poBlock->DropLock();
+    return oBlock.adfValues.data();
+}
+
+/************************************************************************/
+/*                           CubicKernel()                              */
+/************************************************************************/
+
+// Keys cubic convolution kernel, with a = -0.5
+static inline double CubicKernel(double dfX)
+{
+    constexpr double A = -0.5;
+    dfX = std::fabs(dfX);
+    if (dfX <= 1)
+        return ((A + 2) * dfX - (A + 3)) * dfX * dfX + 1;
+    if (dfX < 2)
+        return ((A * dfX - 5 * A) * dfX + 8 * A) * dfX - 4 * A;
+    return 0;
+}
+
+/************************************************************************/
+/*                          InterpolateBilinear()                       */
+/************************************************************************/
+
+static bool InterpolateBilinear(BlockValuesCache &oCache, double dfPixel,
+                                double dfLine, double &dfValue)
+{
+    const double dfX = dfPixel - 0.5;
+    const double dfY = dfLine - 0.5;
+    const int nX0 = static_cast<int>(std::floor(dfX));
+    const int nY0 = static_cast<int>(std::floor(dfY));
+    const double dfDX = dfX - nX0;
+    const double dfDY = dfY - nY0;
+    const double adfWX[2] = {1 - dfDX, dfDX};
+    const double adfWY[2] = {1 - dfDY, dfDY};
+
+    double dfSum = 0;
+    double dfWeightSum = 0;
+    for (int j = 0; j < 2; ++j)
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            const double dfWeight = adfWX[i] * adfWY[j];
+            double dfVal = 0;
+            if (dfWeight > 0 && oCache.GetValue(nX0 + i, nY0 + j, dfVal))
+            {
+                dfSum += dfWeight * dfVal;
+                dfWeightSum += dfWeight;
+            }
+        }
+    }
+    // Renormalize when some of the neighbours are nodata
+    if (dfWeightSum < 1e-5)
+        return false;
+    dfValue = dfSum / dfWeightSum;
+    return true;
+}
+
+/************************************************************************/
+/*                           InterpolateCubic()                         */
+/************************************************************************/
+
+static bool InterpolateCubic(BlockValuesCache &oCache, double dfPixel,
+                             double dfLine, double &dfValue)
+{
+    const double dfX = dfPixel - 0.5;
+    const double dfY = dfLine - 0.5;
+    const int nX0 = static_cast<int>(std::floor(dfX));
+    const int nY0 = static_cast<int>(std::floor(dfY));
+    const double dfDX = dfX - nX0;
+    const double dfDY = dfY - nY0;
+    const double adfWX[4] = {CubicKernel(dfDX + 1), CubicKernel(dfDX),
+                             CubicKernel(1 - dfDX), CubicKernel(2 - dfDX)};
+    const double adfWY[4] = {CubicKernel(dfDY + 1), CubicKernel(dfDY),
+                             CubicKernel(1 - dfDY), CubicKernel(2 - dfDY)};
+
+    double dfSum = 0;
+    for (int j = 0; j < 4; ++j)
+    {
+        double dfRowSum = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            double dfVal = 0;
+            if (!oCache.GetValue(nX0 - 1 + i, nY0 - 1 + j, dfVal))
+            {
+                // Fallback to bilinear when a neighbour is nodata
+                return !oCache.HasError() &&
+                       InterpolateBilinear(oCache, dfPixel, dfLine, dfValue);
+            }
+            dfRowSum += adfWX[i] * dfVal;
+        }
+        dfSum += adfWY[j] * dfRowSum;
+    }
+    dfValue = dfSum;
+    return true;
+}
+}  // namespace
+
+/************************************************************************/
+/*                        InterpolateAtPoints()                         */
+/************************************************************************/
+
+/**
+ * \brief Evaluate the values of the band at a batch of points.
+ *
+ * This is much faster than a RasterIO() call per point: the points are
+ * processed in the order of the blocks they fall into, and each block is
+ * fetched from the block cache and converted to double once per run of
+ * points inside it.
+ *
+ * Coordinates are expressed in pixel/line space, with (0, 0) being the top
+ * left corner of the top left pixel, and (0.5, 0.5) its center.
+ * Pixels whose value is the nodata value of the band, or NaN, are ignored
+ * by the bilinear kernel, which renormalizes the weights of the other
+ * pixels. The cubic kernel falls back to bilinear interpolation when one of
+ * its 16 pixels is invalid. Pixels outside the raster are replaced by the
+ * nearest edge pixel. For complex data types, the real part is interpolated.
+ *
+ * This method is the same as the C function GDALRasterInterpolateAtPoints().
+ *
+ * @param nPointCount number of points.
+ * @param padfPixel array of nPointCount pixel (column) coordinates.
+ * @param padfLine array of nPointCount line (row) coordinates.
+ * @param eResampleAlg GRIORA_NearestNeighbour, GRIORA_Bilinear or
+ * GRIORA_Cubic.
+ * @param padfValues array of nPointCount values, set on output. Points that
+ * cannot be evaluated, because they are outside of the raster or only
+ * surrounded by nodata pixels, are set to the nodata value of the band if
+ * there is one, NaN otherwise.
+ * @param pabSuccess array of nPointCount flags, set on output to whether the
+ * corresponding point has been evaluated, or nullptr.
+ *
+ * @return CE_None on success, CE_Failure in case of invalid arguments or of
+ * failure when reading blocks.
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALRasterBand::InterpolateAtPoints(int nPointCount,
+                                           const double *padfPixel,
+                                           const double *padfLine,
+                                           GDALRIOResampleAlg eResampleAlg,
+                                           double *padfValues, int *pabSuccess)
+{
+    if (nPointCount < 0 || (nPointCount > 0 && (padfPixel == nullptr ||
+                                                padfLine == nullptr ||
+                                                padfValues == nullptr)))
+    {
+        ReportError(CE_Failure, CPLE_IllegalArg,
+                    "InterpolateAtPoints(): invalid arguments");
+        return CE_Failure;
+    }
+    if (eResampleAlg != GRIORA_NearestNeighbour &&
+        eResampleAlg != GRIORA_Bilinear && eResampleAlg != GRIORA_Cubic)
+    {
+        ReportError(CE_Failure, CPLE_NotSupported,
+                    "InterpolateAtPoints(): only nearest, bilinear and cubic "
+                    "resampling methods are supported");
+        return CE_Failure;
+    }
+
+    int bHasNoData = FALSE;
+    const double dfNoData = GetNoDataValue(&bHasNoData);
+    const double dfInvalid =
+        bHasNoData ? dfNoData : std::numeric_limits<double>::quiet_NaN();
+    std::fill(padfValues, padfValues + nPointCount, dfInvalid);
+    if (pabSuccess)
+        std::fill(pabSuccess, pabSuccess + nPointCount, FALSE);
+
+    BlockValuesCache oCache(this);
+    const int nBlockXSize = oCache.GetBlockXSize();
+    const int nBlockYSize = oCache.GetBlockYSize();
+    const double dfXSize = nRasterXSize;
+    const double dfYSize = nRasterYSize;
+
+    /* -------------------------------------------------------------------- */
+    /*      Sort the points inside the raster by block.                     */
+    /* -------------------------------------------------------------------- */
+    std::vector<int> anOrder;
+    anOrder.reserve(nPointCount);
+    for (int i = 0; i < nPointCount; ++i)
+    {
+        // Also rejects NaN
+        if (padfPixel[i] >= 0 && padfPixel[i] <= dfXSize &&
+            padfLine[i] >= 0 && padfLine[i] <= dfYSize)
+        {
+            anOrder.push_back(i);
+        }
+    }
+    const int nBlocksX = DIV_ROUND_UP(nRasterXSize, nBlockXSize);
+    const auto BlockIndex = [padfPixel, padfLine, nBlockXSize, nBlockYSize,
+                             nBlocksX, this](int i)
+    {
+        const int nX = std::min(static_cast<int>(padfPixel[i]),
+                                nRasterXSize - 1);
+        const int nY =
+            std::min(static_cast<int>(padfLine[i]), nRasterYSize - 1);
+        return static_cast<GIntBig>(nY / nBlockYSize) * nBlocksX +
+               nX / nBlockXSize;
+    };
+    std::vector<GIntBig> anBlockIndex(nPointCount);
+    for (const int i : anOrder)
+        anBlockIndex[i] = BlockIndex(i);
+    std::stable_sort(anOrder.begin(), anOrder.end(),
+                     [&anBlockIndex](int a, int b)
+                     { return anBlockIndex[a] < anBlockIndex[b]; });
+
+    /* -------------------------------------------------------------------- */
+    /*      Evaluate them.                                                  */
+    /* -------------------------------------------------------------------- */
+    for (const int i : anOrder)
+    {
+        double dfValue = 0;
+        bool bOK;
+        if (eResampleAlg == GRIORA_NearestNeighbour)
+        {
+            bOK = oCache.GetValue(static_cast<int>(padfPixel[i]),
+                                  static_cast<int>(padfLine[i]), dfValue);
+        }
+        else if (eResampleAlg == GRIORA_Bilinear)
+        {
+            bOK = InterpolateBilinear(oCache, padfPixel[i], padfLine[i],
+                                      dfValue);
+        }
+        else
+        {
+            bOK = InterpolateCubic(oCache, padfPixel[i], padfLine[i], dfValue);
+        }
+        if (oCache.HasError())
+            return CE_Failure;
+        if (bOK)
+        {
+            padfValues[i] = dfValue;
+            if (pabSuccess)
+                pabSuccess[i] = TRUE;
+        }
+    }
+    return CE_None;
+}
+
+/************************************************************************/
+/*                   GDALRasterInterpolateAtPoints()                    */
+/************************************************************************/
+
+/**
+ * \brief Evaluate the values of a band at a batch of points.
+ *
+ * @see GDALRasterBand::InterpolateAtPoints()
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALRasterInterpolateAtPoints(GDALRasterBandH hBand, int nPointCount,
+                                     const double *padfPixel,
+                                     const double *padfLine,
+                                     GDALRIOResampleAlg eResampleAlg,
+                                     double *padfValues, int *pabSuccess)
+{
+    VALIDATE_POINTER1(hBand, "GDALRasterInterpolateAtPoints", CE_Failure);
+
+    return GDALRasterBand::FromHandle(hBand)->InterpolateAtPoints(
+        nPointCount, padfPixel, padfLine, eResampleAlg, padfValues,
+        pabSuccess);
+}
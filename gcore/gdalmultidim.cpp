@@ -30,7 +30,15 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
 #include <limits>
+#include <list>
+#include <map>
+#include <mutex>
 #include <queue>
 #include <set>
 #include <utility>
@@ -41,6 +49,7 @@
 #include "cpl_error_internal.h"
 #include "gdal_priv.h"
 #include "gdal_pam.h"
+#include "gdal_thread_pool.h"
 #include "gdal_utils.h"
 #include "cpl_safemaths.hpp"
 #include "memmultidim.h"
@@ -65,6 +74,11 @@ class GDALMDArrayUnscaled final : public GDALPamMDArray
     const double m_dfOffset;
     std::vector<GByte> m_abyRawNoData{};
 
+    bool ReadInPlace(const GUInt64 *arrayStartIdx, const size_t *count,
+                     const GInt64 *arrayStep, const GPtrDiff_t *bufferStride,
+                     const GDALExtendedDataType &bufferDataType,
+                     void *pDstBuffer) const;
+
   protected:
     explicit GDALMDArrayUnscaled(const std::shared_ptr<GDALMDArray> &poParent,
                                  double dfScale, double dfOffset,
@@ -2258,8 +2272,14 @@ bool GDALAbstractMDArray::Write(const GUInt64 *arrayStartIdx,
         return false;
     }
 
-    return IWrite(arrayStartIdx, count, arrayStep, bufferStride, bufferDataType,
-                  pSrcBuffer);
+    const bool bRet = IWrite(arrayStartIdx, count, arrayStep, bufferStride,
+                             bufferDataType, pSrcBuffer);
+
+    // Chunks of the array kept in the chunk cache might be stale now.
+    if (auto poArray = dynamic_cast<const GDALMDArray *>(this))
+        poArray->ClearChunkCache();
+
+    return bRet;
 }
 
 /************************************************************************/
@@ -2963,6 +2983,25 @@ enum class Caller
 };
 }
 
+// Set in the worker threads of the jobs of ProcessPerChunk() and
+// GDALMDArray::ReadInParallel(), so that they do not submit and wait for
+// jobs of the thread pool they run in.
+static thread_local bool tls_bInMDArrayJob = false;
+
+// Returns the value of the GDAL_NUM_THREADS configuration option, or 1 if
+// it is not set.
+static int GDALMDArrayGetNumThreads()
+{
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszNumThreads == nullptr)
+        return 1;
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads);
+    return std::max(1, std::min(nThreads, 1024));
+}
+
 /** \brief Call a user-provided function to operate on an array chunk by chunk.
  *
  * This method is to be used when doing operations on an array, or a subset of
@@ -3113,6 +3152,160 @@ end:
     return true;
 }
 
+namespace
+{
+struct GDALProcessPerChunkJob
+{
+    GDALAbstractMDArray *poArray = nullptr;
+    const GUInt64 *arrayStartIdx = nullptr;
+    const GUInt64 *count = nullptr;
+    const size_t *chunkSize = nullptr;
+    // Index of the first chunk in each dimension, and number of chunks
+    const std::vector<GUInt64> *panFirstChunk = nullptr;
+    const std::vector<GUInt64> *panChunks = nullptr;
+    GDALAbstractMDArray::FuncProcessPerChunkType pfnFunc = nullptr;
+    void *pUserData = nullptr;
+    GUInt64 nChunkCount = 0;
+    std::atomic<GUInt64> *pnNextChunk = nullptr;
+    std::atomic<bool> *pbSuccess = nullptr;
+};
+}  // namespace
+
+static void GDALProcessPerChunkJobFunc(void *pData)
+{
+    const auto psJob = static_cast<const GDALProcessPerChunkJob *>(pData);
+    const size_t nDims = psJob->panChunks->size();
+    std::vector<GUInt64> chunkArrayStartIdx(nDims);
+    std::vector<size_t> chunkCount(nDims);
+
+    const bool bWasInJob = tls_bInMDArrayJob;
+    tls_bInMDArrayJob = true;
+    while (*(psJob->pbSuccess))
+    {
+        const GUInt64 iChunk = (*(psJob->pnNextChunk))++;
+        if (iChunk >= psJob->nChunkCount)
+            break;
+
+        // Chunks are numbered in row-major order.
+        GUInt64 nRemainder = iChunk;
+        for (size_t i = nDims; i-- > 0;)
+        {
+            const GUInt64 nChunksThisDim = (*(psJob->panChunks))[i];
+            const GUInt64 iChunkThisDim =
+                (*(psJob->panFirstChunk))[i] + nRemainder % nChunksThisDim;
+            nRemainder /= nChunksThisDim;
+            const GUInt64 nStart =
+                std::max(psJob->arrayStartIdx[i],
+                         iChunkThisDim * psJob->chunkSize[i]);
+            const GUInt64 nEnd =
+                std::min(psJob->arrayStartIdx[i] + psJob->count[i],
+                         (iChunkThisDim + 1) * psJob->chunkSize[i]);
+            chunkArrayStartIdx[i] = nStart;
+            chunkCount[i] = static_cast<size_t>(nEnd - nStart);
+        }
+
+        if (!psJob->pfnFunc(psJob->poArray, chunkArrayStartIdx.data(),
+                            chunkCount.data(), iChunk + 1,
+                            psJob->nChunkCount, psJob->pUserData))
+        {
+            *(psJob->pbSuccess) = false;
+        }
+    }
+    tls_bInMDArrayJob = bWasInJob;
+}
+
+/** \brief Call a user-provided function to operate on an array chunk by
+ * chunk, possibly from several threads.
+ *
+ * This is the same as the other ProcessPerChunk() method, except that when
+ * nThreads is greater than 1, chunks are distributed among up to nThreads
+ * jobs of the global thread pool.
+ *
+ * In that case, pfnFunc may be called concurrently from different threads,
+ * and chunks are processed in no particular order: iCurChunk identifies the
+ * chunk but no longer its rank in the processing. pfnFunc must thus protect
+ * any state shared through pUserData, including the reporting of progress,
+ * and read arrays whose IsReadThreadSafe() method returns false under a
+ * lock. When it returns false, no new chunk is started.
+ *
+ * @since GDAL 3.9
+ */
+bool GDALAbstractMDArray::ProcessPerChunk(const GUInt64 *arrayStartIdx,
+                                          const GUInt64 *count,
+                                          const size_t *chunkSize,
+                                          FuncProcessPerChunkType pfnFunc,
+                                          void *pUserData, int nThreads)
+{
+    const size_t nDims = GetDimensionCount();
+    if (nThreads <= 1 || nDims == 0 || tls_bInMDArrayJob)
+    {
+        return ProcessPerChunk(arrayStartIdx, count, chunkSize, pfnFunc,
+                               pUserData);
+    }
+
+    const auto &dims = GetDimensions();
+    std::vector<GUInt64> anFirstChunk(nDims);
+    std::vector<GUInt64> anChunks(nDims);
+    GUInt64 nChunkCount = 1;
+    for (size_t i = 0; i < nDims; i++)
+    {
+        const auto nSizeThisDim(dims[i]->GetSize());
+        if (count[i] == 0 || count[i] > nSizeThisDim ||
+            arrayStartIdx[i] > nSizeThisDim - count[i] || chunkSize[i] == 0)
+        {
+            // Let the sequential implementation report the error
+            return ProcessPerChunk(arrayStartIdx, count, chunkSize, pfnFunc,
+                                   pUserData);
+        }
+        anFirstChunk[i] = arrayStartIdx[i] / chunkSize[i];
+        anChunks[i] =
+            (arrayStartIdx[i] + count[i] - 1) / chunkSize[i] - anFirstChunk[i] +
+            1;
+        nChunkCount *= anChunks[i];
+    }
+
+    const int nJobs =
+        static_cast<int>(std::min<GUInt64>(nThreads, nChunkCount));
+    CPLWorkerThreadPool *poPool =
+        nJobs > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    if (poQueue == nullptr)
+    {
+        return ProcessPerChunk(arrayStartIdx, count, chunkSize, pfnFunc,
+                               pUserData);
+    }
+
+    std::atomic<GUInt64> nNextChunk{0};
+    std::atomic<bool> bSuccess{true};
+    GDALProcessPerChunkJob sJob;
+    sJob.poArray = this;
+    sJob.arrayStartIdx = arrayStartIdx;
+    sJob.count = count;
+    sJob.chunkSize = chunkSize;
+    sJob.panFirstChunk = &anFirstChunk;
+    sJob.panChunks = &anChunks;
+    sJob.pfnFunc = pfnFunc;
+    sJob.pUserData = pUserData;
+    sJob.nChunkCount = nChunkCount;
+    sJob.pnNextChunk = &nNextChunk;
+    sJob.pbSuccess = &bSuccess;
+
+    // All jobs share the same description, and pick the next chunk to
+    // process until there are none left.
+    for (int i = 0; i < nJobs; ++i)
+    {
+        if (!poQueue->SubmitJob(GDALProcessPerChunkJobFunc, &sJob))
+        {
+            // Process remaining chunks in this thread
+            GDALProcessPerChunkJobFunc(&sJob);
+            break;
+        }
+    }
+    poQueue->WaitCompletion();
+
+    return bSuccess;
+}
+
 /************************************************************************/
 /*                          GDALAttribute()                             */
 /************************************************************************/
@@ -3646,6 +3839,15 @@ GDALMDArray::GDALMDArray(CPL_UNUSED const std::string &osParentName,
 }
 //! @endcond
 
+/************************************************************************/
+/*                           ~GDALMDArray()                             */
+/************************************************************************/
+
+GDALMDArray::~GDALMDArray()
+{
+    ClearChunkCache();
+}
+
 /************************************************************************/
 /*                           GetTotalCopyCost()                         */
 /************************************************************************/
@@ -4238,6 +4440,531 @@ bool GDALMDArray::Cache(CSLConstList papszOptions) const
                                    nCost, GetTotalCopyCost(), nullptr, nullptr);
 }
 
+/************************************************************************/
+/*                        GDALMDArrayChunkCache                         */
+/************************************************************************/
+
+namespace
+{
+// Process-wide cache of decoded chunks of arrays whose CanUseChunkCache()
+// returns true, with least-recently-used eviction. Its budget is set by the
+// GDAL_MDARRAY_CHUNK_CACHE_SIZE configuration option.
+class GDALMDArrayChunkCache
+{
+  public:
+    typedef std::shared_ptr<const std::vector<GByte>> ChunkPtr;
+
+    static GDALMDArrayChunkCache &Get()
+    {
+        // Never destroyed, as arrays may be destroyed after static objects.
+        static GDALMDArrayChunkCache *poCache = new GDALMDArrayChunkCache();
+        return *poCache;
+    }
+
+    static uint64_t GetNewArrayId()
+    {
+        static std::atomic<uint64_t> nLastId{0};
+        return ++nLastId;
+    }
+
+    static GIntBig GetMaxSize();
+
+    ChunkPtr Lookup(uint64_t nArrayId, const std::vector<GUInt64> &anChunkIdx,
+                    size_t nExpectedSize);
+    void Insert(uint64_t nArrayId, const std::vector<GUInt64> &anChunkIdx,
+                const ChunkPtr &poChunk, GIntBig nMaxSize);
+    void Invalidate(uint64_t nArrayId);
+
+  private:
+    typedef std::pair<uint64_t, std::vector<GUInt64>> Key;
+
+    struct Entry
+    {
+        Key oKey{};
+        ChunkPtr poChunk{};
+    };
+
+    std::mutex m_oMutex{};
+    std::list<Entry> m_aoEntries{};  // Most recently used first
+    std::map<Key, std::list<Entry>::iterator> m_oMapEntries{};
+    GIntBig m_nUsed = 0;
+
+    void Remove(std::list<Entry>::iterator oIter);
+};
+
+// Returns the budget of the cache in bytes, from the
+// GDAL_MDARRAY_CHUNK_CACHE_SIZE configuration option, expressed in MB or as
+// a percentage of GDAL_CACHEMAX.
+GIntBig GDALMDArrayChunkCache::GetMaxSize()
+{
+    const char *pszSize =
+        CPLGetConfigOption("GDAL_MDARRAY_CHUNK_CACHE_SIZE", "25%");
+    if (strchr(pszSize, '%') != nullptr)
+    {
+        return static_cast<GIntBig>(CPLAtof(pszSize) / 100 *
+                                    static_cast<double>(GDALGetCacheMax64()));
+    }
+    return CPLAtoGIntBig(pszSize) * 1024 * 1024;
+}
+
+GDALMDArrayChunkCache::ChunkPtr
+GDALMDArrayChunkCache::Lookup(uint64_t nArrayId,
+                              const std::vector<GUInt64> &anChunkIdx,
+                              size_t nExpectedSize)
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    auto oIter = m_oMapEntries.find(Key(nArrayId, anChunkIdx));
+    if (oIter == m_oMapEntries.end())
+        return nullptr;
+    // The dimensions of the array might have been resized.
+    if (oIter->second->poChunk->size() != nExpectedSize)
+    {
+        Remove(oIter->second);
+        return nullptr;
+    }
+    m_aoEntries.splice(m_aoEntries.begin(), m_aoEntries, oIter->second);
+    return oIter->second->poChunk;
+}
+
+void GDALMDArrayChunkCache::Insert(uint64_t nArrayId,
+                                   const std::vector<GUInt64> &anChunkIdx,
+                                   const ChunkPtr &poChunk, GIntBig nMaxSize)
+{
+    const GIntBig nSize = static_cast<GIntBig>(poChunk->size());
+    if (nSize > nMaxSize)
+        return;
+
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    Key oKey(nArrayId, anChunkIdx);
+    auto oIter = m_oMapEntries.find(oKey);
+    if (oIter != m_oMapEntries.end())
+        Remove(oIter->second);
+    while (!m_aoEntries.empty() && m_nUsed + nSize > nMaxSize)
+        Remove(std::prev(m_aoEntries.end()));
+
+    Entry oEntry;
+    oEntry.oKey = oKey;
+    oEntry.poChunk = poChunk;
+    m_aoEntries.push_front(std::move(oEntry));
+    m_oMapEntries[std::move(oKey)] = m_aoEntries.begin();
+    m_nUsed += nSize;
+}
+
+void GDALMDArrayChunkCache::Invalidate(uint64_t nArrayId)
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    auto oIter = m_oMapEntries.lower_bound(Key(nArrayId, {}));
+    while (oIter != m_oMapEntries.end() && oIter->first.first == nArrayId)
+    {
+        auto oEntryIter = oIter->second;
+        ++oIter;
+        Remove(oEntryIter);
+    }
+}
+
+// Must be called with m_oMutex held.
+void GDALMDArrayChunkCache::Remove(std::list<Entry>::iterator oIter)
+{
+    m_nUsed -= static_cast<GIntBig>(oIter->poChunk->size());
+    m_oMapEntries.erase(oIter->oKey);
+    m_aoEntries.erase(oIter);
+}
+
+// Computes the range [nFirstK, nFirstK + nCountK[ of the values of k in
+// [0, nCount[ such that nStart + k * nStep is in [nLow, nHigh[.
+// Returns false if that range is empty.
+static bool GetRequestRangeInChunk(GUInt64 nStart, size_t nCount,
+                                   GInt64 nStep, GUInt64 nLow, GUInt64 nHigh,
+                                   size_t &nFirstK, size_t &nCountK)
+{
+    GUInt64 nMinK = 0;
+    GUInt64 nMaxK = nCount - 1;
+    if (nStep == 0)
+    {
+        if (nStart < nLow || nStart >= nHigh)
+            return false;
+    }
+    else if (nStep > 0)
+    {
+        const GUInt64 nAbsStep = static_cast<GUInt64>(nStep);
+        if (nStart >= nHigh)
+            return false;
+        if (nStart < nLow)
+            nMinK = (nLow - nStart + nAbsStep - 1) / nAbsStep;
+        nMaxK = std::min(nMaxK, (nHigh - 1 - nStart) / nAbsStep);
+    }
+    else
+    {
+        const GUInt64 nAbsStep = static_cast<GUInt64>(-nStep);
+        if (nStart < nLow)
+            return false;
+        if (nStart >= nHigh)
+            nMinK = (nStart - (nHigh - 1) + nAbsStep - 1) / nAbsStep;
+        nMaxK = std::min(nMaxK, (nStart - nLow) / nAbsStep);
+    }
+    if (nMinK > nMaxK)
+        return false;
+    nFirstK = static_cast<size_t>(nMinK);
+    nCountK = static_cast<size_t>(nMaxK - nMinK + 1);
+    return true;
+}
+}  // namespace
+
+/************************************************************************/
+/*                        ReadUsingChunkCache()                         */
+/************************************************************************/
+
+// Serve a read request from whole chunks kept in the chunk cache, reading
+// the missing ones with IRead().
+// Returns false if the request must not go through the chunk cache.
+// Otherwise bRet is set to the success of the read.
+bool GDALMDArray::ReadUsingChunkCache(
+    const GUInt64 *arrayStartIdx, const size_t *count, const GInt64 *arrayStep,
+    const GPtrDiff_t *bufferStride, const GDALExtendedDataType &bufferDataType,
+    void *pDstBuffer, bool &bRet) const
+{
+    const size_t nDims = GetDimensionCount();
+    const auto &oDT = GetDataType();
+    if (nDims == 0 || oDT.GetClass() != GEDTC_NUMERIC ||
+        bufferDataType.GetClass() != GEDTC_NUMERIC || !CanUseChunkCache())
+    {
+        return false;
+    }
+    const GIntBig nMaxSize = GDALMDArrayChunkCache::GetMaxSize();
+    const auto anBlockSize = GetBlockSize();
+    if (nMaxSize <= 0 || anBlockSize.size() != nDims)
+        return false;
+
+    const size_t nDTSize = oDT.GetSize();
+    const size_t nBufferDTSize = bufferDataType.GetSize();
+    const auto &apoDims = GetDimensions();
+    std::vector<GUInt64> anFirstChunk(nDims);
+    std::vector<GUInt64> anLastChunk(nDims);
+    double dfChunksBytes = static_cast<double>(nDTSize);
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        if (anBlockSize[i] == 0)
+            return false;
+        const GUInt64 nEndIdx =
+            arrayStartIdx[i] + static_cast<GUInt64>(
+                                   static_cast<GInt64>(count[i] - 1) *
+                                   arrayStep[i]);
+        anFirstChunk[i] = std::min(arrayStartIdx[i], nEndIdx) / anBlockSize[i];
+        anLastChunk[i] = std::max(arrayStartIdx[i], nEndIdx) / anBlockSize[i];
+        dfChunksBytes *= static_cast<double>(
+            (anLastChunk[i] - anFirstChunk[i] + 1) * anBlockSize[i]);
+    }
+    // Requests that would evict a large part of the cache are better served
+    // directly by the driver.
+    if (dfChunksBytes > static_cast<double>(nMaxSize) / 4)
+        return false;
+    // GDALCopyWords64() takes int strides.
+    const GInt64 nLastStep = arrayStep[nDims - 1];
+    if (std::abs(bufferStride[nDims - 1]) >
+            static_cast<GPtrDiff_t>(INT_MAX / nBufferDTSize) ||
+        static_cast<double>(std::abs(nLastStep)) * nDTSize > INT_MAX)
+    {
+        return false;
+    }
+
+    if (m_nChunkCacheId == 0)
+        m_nChunkCacheId = GDALMDArrayChunkCache::GetNewArrayId();
+    auto &oCache = GDALMDArrayChunkCache::Get();
+
+    const GDALDataType eSrcDT = oDT.GetNumericDataType();
+    const GDALDataType eDstDT = bufferDataType.GetNumericDataType();
+    const std::vector<GInt64> anOneStep(nDims, 1);
+    std::vector<GUInt64> anChunkIdx(anFirstChunk);
+    std::vector<GUInt64> anChunkStart(nDims);
+    std::vector<size_t> anChunkCount(nDims);
+    std::vector<GPtrDiff_t> anChunkStride(nDims);
+    std::vector<size_t> anFirstK(nDims);
+    std::vector<size_t> anCountK(nDims);
+    std::vector<size_t> anIterK(nDims);
+    while (true)
+    {
+        // Geometry of the chunk, and part of the request it contains.
+        bool bIntersects = true;
+        size_t nChunkElts = 1;
+        for (size_t i = nDims; i-- > 0;)
+        {
+            anChunkStart[i] = anChunkIdx[i] * anBlockSize[i];
+            anChunkCount[i] = static_cast<size_t>(std::min(
+                anBlockSize[i], apoDims[i]->GetSize() - anChunkStart[i]));
+            anChunkStride[i] = static_cast<GPtrDiff_t>(nChunkElts);
+            nChunkElts *= anChunkCount[i];
+            bIntersects =
+                bIntersects &&
+                GetRequestRangeInChunk(arrayStartIdx[i], count[i],
+                                       arrayStep[i], anChunkStart[i],
+                                       anChunkStart[i] + anChunkCount[i],
+                                       anFirstK[i], anCountK[i]);
+        }
+
+        if (bIntersects)
+        {
+            auto poChunk = oCache.Lookup(m_nChunkCacheId, anChunkIdx,
+                                         nChunkElts * nDTSize);
+            if (poChunk == nullptr)
+            {
+                auto poNewChunk = std::make_shared<std::vector<GByte>>();
+                try
+                {
+                    poNewChunk->resize(nChunkElts * nDTSize);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                             "Cannot allocate chunk of " CPL_FRMT_GUIB
+                             " bytes",
+                             static_cast<GUIntBig>(nChunkElts * nDTSize));
+                    bRet = false;
+                    return true;
+                }
+                if (!IRead(anChunkStart.data(), anChunkCount.data(),
+                           anOneStep.data(), anChunkStride.data(), oDT,
+                           poNewChunk->data()))
+                {
+                    bRet = false;
+                    return true;
+                }
+                poChunk = poNewChunk;
+                oCache.Insert(m_nChunkCacheId, anChunkIdx, poChunk, nMaxSize);
+            }
+
+            // Copy the part of the request in the chunk, looping over all
+            // but the last dimension.
+            const GByte *pabySrcBase = poChunk->data();
+            GByte *pabyDstBase = static_cast<GByte *>(pDstBuffer);
+            for (size_t i = 0; i < nDims; ++i)
+            {
+                const GUInt64 nIdx =
+                    arrayStartIdx[i] +
+                    static_cast<GUInt64>(static_cast<GInt64>(anFirstK[i]) *
+                                         arrayStep[i]);
+                pabySrcBase += static_cast<size_t>(nIdx - anChunkStart[i]) *
+                               anChunkStride[i] * nDTSize;
+                pabyDstBase += static_cast<GPtrDiff_t>(anFirstK[i]) *
+                               bufferStride[i] *
+                               static_cast<GPtrDiff_t>(nBufferDTSize);
+            }
+            const int nSrcInc =
+                static_cast<int>(nLastStep * static_cast<GInt64>(nDTSize));
+            const int nDstInc = static_cast<int>(
+                bufferStride[nDims - 1] *
+                static_cast<GPtrDiff_t>(nBufferDTSize));
+            std::fill(anIterK.begin(), anIterK.end(), 0);
+            while (true)
+            {
+                const GByte *pabySrc = pabySrcBase;
+                GByte *pabyDst = pabyDstBase;
+                for (size_t i = 0; i + 1 < nDims; ++i)
+                {
+                    pabySrc += static_cast<GPtrDiff_t>(anIterK[i]) *
+                               arrayStep[i] * anChunkStride[i] *
+                               static_cast<GPtrDiff_t>(nDTSize);
+                    pabyDst += static_cast<GPtrDiff_t>(anIterK[i]) *
+                               bufferStride[i] *
+                               static_cast<GPtrDiff_t>(nBufferDTSize);
+                }
+                GDALCopyWords64(pabySrc, eSrcDT, nSrcInc, pabyDst, eDstDT,
+                                nDstInc, anCountK[nDims - 1]);
+
+                bool bDone = true;
+                for (size_t i = nDims - 1; i > 0;)
+                {
+                    --i;
+                    if (++anIterK[i] < anCountK[i])
+                    {
+                        bDone = false;
+                        break;
+                    }
+                    anIterK[i] = 0;
+                }
+                if (bDone)
+                    break;
+            }
+        }
+
+        // Next chunk
+        size_t i = nDims;
+        while (i > 0)
+        {
+            --i;
+            if (anChunkIdx[i] < anLastChunk[i])
+            {
+                ++anChunkIdx[i];
+                break;
+            }
+            anChunkIdx[i] = anFirstChunk[i];
+            if (i == 0)
+            {
+                bRet = true;
+                return true;
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                          ClearChunkCache()                           */
+/************************************************************************/
+
+/** Discard the chunks of this array kept in the chunk cache.
+ *
+ * Chunks are kept in that cache by Read() when CanUseChunkCache() returns
+ * true, up to a budget set by the GDAL_MDARRAY_CHUNK_CACHE_SIZE
+ * configuration option. This is done automatically by Write(), but must be
+ * done by the caller if the array is modified by other means.
+ *
+ * @since GDAL 3.9
+ */
+void GDALMDArray::ClearChunkCache() const
+{
+    if (m_nChunkCacheId != 0)
+        GDALMDArrayChunkCache::Get().Invalidate(m_nChunkCacheId);
+}
+
+/************************************************************************/
+/*                           ReadInParallel()                           */
+/************************************************************************/
+
+namespace
+{
+struct GDALMDArrayReadJob
+{
+    const std::function<bool(size_t, size_t)> *pfnRead = nullptr;
+    std::atomic<bool> *pbSuccess = nullptr;
+    // Range of indices in the request along the split dimension.
+    size_t nStart = 0;
+    size_t nEnd = 0;
+};
+}  // namespace
+
+static void GDALMDArrayReadJobFunc(void *pData)
+{
+    const auto psJob = static_cast<const GDALMDArrayReadJob *>(pData);
+    if (!*(psJob->pbSuccess))
+        return;
+    tls_bInMDArrayJob = true;
+    if (!(*psJob->pfnRead)(psJob->nStart, psJob->nEnd))
+        *(psJob->pbSuccess) = false;
+    tls_bInMDArrayJob = false;
+}
+
+// Split a read request along its outermost dimension with several elements
+// into jobs executed in the global thread pool, when the GDAL_NUM_THREADS
+// configuration option is set and IsReadThreadSafe() returns true. Job
+// boundaries are aligned on the chunks of GetBlockSize() when possible, so
+// that a chunk is not decoded by several jobs.
+// Returns false if the request must be processed sequentially. Otherwise
+// bRet is set to the success of the read.
+bool GDALMDArray::ReadInParallel(const GUInt64 *arrayStartIdx,
+                                 const size_t *count, const GInt64 *arrayStep,
+                                 const GPtrDiff_t *bufferStride,
+                                 const GDALExtendedDataType &bufferDataType,
+                                 void *pDstBuffer, bool &bRet) const
+{
+    const size_t nDims = GetDimensionCount();
+    if (tls_bInMDArrayJob || nDims == 0 || !IsReadThreadSafe())
+        return false;
+
+    const int nThreads = GDALMDArrayGetNumThreads();
+
+    // Jobs smaller than that are not worth their overhead.
+    constexpr double MIN_BYTES_PER_JOB = 256 * 1024;
+    double dfTotalBytes = static_cast<double>(bufferDataType.GetSize());
+    for (size_t i = 0; i < nDims; ++i)
+        dfTotalBytes *= static_cast<double>(count[i]);
+    const int nMaxJobs = static_cast<int>(
+        std::min(static_cast<double>(nThreads),
+                 std::floor(dfTotalBytes / MIN_BYTES_PER_JOB)));
+    if (nMaxJobs <= 1)
+        return false;
+
+    size_t iDim = 0;
+    while (iDim < nDims && count[iDim] == 1)
+        ++iDim;
+    if (iDim == nDims)
+        return false;
+
+    const size_t nCount = count[iDim];
+    const GUInt64 nStartIdx = arrayStartIdx[iDim];
+    const GInt64 nStep = arrayStep[iDim];
+    const auto anBlockSize = GetBlockSize();
+    const GUInt64 nBlockSize =
+        iDim < anBlockSize.size() && nStep > 0 ? anBlockSize[iDim] : 0;
+
+    std::vector<size_t> anBoundaries{0};
+    const int nJobs =
+        static_cast<int>(std::min(static_cast<size_t>(nMaxJobs), nCount));
+    for (int i = 1; i < nJobs; ++i)
+    {
+        size_t k =
+            static_cast<size_t>(static_cast<GUInt64>(nCount) * i / nJobs);
+        if (nBlockSize > 0)
+        {
+            // Move back to the first requested element of the chunk of k
+            const GUInt64 nIdx = nStartIdx + k * static_cast<GUInt64>(nStep);
+            const GUInt64 nChunkStart = nIdx / nBlockSize * nBlockSize;
+            k = nChunkStart <= nStartIdx
+                    ? 0
+                    : static_cast<size_t>(
+                          (nChunkStart - nStartIdx + nStep - 1) / nStep);
+        }
+        if (k > anBoundaries.back())
+            anBoundaries.push_back(k);
+    }
+    anBoundaries.push_back(nCount);
+    if (anBoundaries.size() <= 2)
+        return false;
+
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nThreads);
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    if (poQueue == nullptr)
+        return false;
+
+    CPLDebug("GDAL", "Reading %s with %d jobs", GetFullName().c_str(),
+             static_cast<int>(anBoundaries.size()) - 1);
+
+    const size_t nBufferDTSize = bufferDataType.GetSize();
+    const std::function<bool(size_t, size_t)> oRead =
+        [this, arrayStartIdx, count, arrayStep, bufferStride, &bufferDataType,
+         pDstBuffer, nDims, iDim, nBufferDTSize](size_t nStart, size_t nEnd)
+    {
+        std::vector<GUInt64> anStartIdx(arrayStartIdx, arrayStartIdx + nDims);
+        std::vector<size_t> anCount(count, count + nDims);
+        anStartIdx[iDim] +=
+            static_cast<GUInt64>(static_cast<GInt64>(nStart) * arrayStep[iDim]);
+        anCount[iDim] = nEnd - nStart;
+        GByte *pabyDst = static_cast<GByte *>(pDstBuffer) +
+                         static_cast<GPtrDiff_t>(nStart) * bufferStride[iDim] *
+                             static_cast<GPtrDiff_t>(nBufferDTSize);
+        return IRead(anStartIdx.data(), anCount.data(), arrayStep,
+                     bufferStride, bufferDataType, pabyDst);
+    };
+
+    std::atomic<bool> bSuccess{true};
+    std::vector<GDALMDArrayReadJob> asJobs(anBoundaries.size() - 1);
+    for (size_t i = 0; i < asJobs.size(); ++i)
+    {
+        auto &sJob = asJobs[i];
+        sJob.pfnRead = &oRead;
+        sJob.pbSuccess = &bSuccess;
+        sJob.nStart = anBoundaries[i];
+        sJob.nEnd = anBoundaries[i + 1];
+        if (!poQueue->SubmitJob(GDALMDArrayReadJobFunc, &sJob))
+        {
+            // Process it in this thread
+            GDALMDArrayReadJobFunc(&sJob);
+        }
+    }
+    poQueue->WaitCompletion();
+
+    bRet = bSuccess;
+    return true;
+}
+
 /************************************************************************/
 /*                               Read()                                 */
 /************************************************************************/
@@ -4317,6 +5044,16 @@ bool GDALMDArray::Read(const GUInt64 *arrayStartIdx, const size_t *count,
         return false;
     }
 
+    bool bRet = false;
+    if (array->ReadUsingChunkCache(arrayStartIdx, count, arrayStep,
+                                   bufferStride, bufferDataType, pDstBuffer,
+                                   bRet) ||
+        array->ReadInParallel(arrayStartIdx, count, arrayStep, bufferStride,
+                              bufferDataType, pDstBuffer, bRet))
+    {
+        return bRet;
+    }
+
     return array->IRead(arrayStartIdx, count, arrayStep, bufferStride,
                         bufferDataType, pDstBuffer);
 }
@@ -6031,6 +6768,35 @@ GDALMDArray::Transpose(const std::vector<int> &anMapNewAxisToOldAxis) const
     return GDALMDArrayTransposed::Create(self, anMapNewAxisToOldAxis);
 }
 
+/************************************************************************/
+/*                      AreBufferElementsDistinct()                     */
+/************************************************************************/
+
+// Returns whether no two elements of a request map to the same location of
+// the buffer.
+static bool AreBufferElementsDistinct(size_t nDims, const size_t *count,
+                                      const GPtrDiff_t *bufferStride)
+{
+    std::vector<std::pair<GUIntBig, size_t>> aoStrideCount;
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        if (count[i] > 1)
+        {
+            aoStrideCount.emplace_back(
+                static_cast<GUIntBig>(std::abs(bufferStride[i])), count[i]);
+        }
+    }
+    std::sort(aoStrideCount.begin(), aoStrideCount.end());
+    GUIntBig nMinStride = 1;
+    for (const auto &oStrideCount : aoStrideCount)
+    {
+        if (oStrideCount.first < nMinStride)
+            return false;
+        nMinStride = oStrideCount.first * oStrideCount.second;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                             IRead()                                  */
 /************************************************************************/
@@ -6084,6 +6850,20 @@ bool GDALMDArrayUnscaled::IRead(const GUInt64 *arrayStartIdx,
         return true;
     }
 
+    // When raw values fit in the slots of the output buffer, avoid the
+    // temporary Float64 buffer of the whole request.
+    const auto &oParentDT = m_poParent->GetDataType();
+    if (bTempBufferNeeded && !bDTIsComplex &&
+        oParentDT.GetClass() == GEDTC_NUMERIC &&
+        bufferDataType.GetClass() == GEDTC_NUMERIC &&
+        !GDALDataTypeIsComplex(bufferDataType.GetNumericDataType()) &&
+        bufferDataType.GetSize() % oParentDT.GetSize() == 0 &&
+        AreBufferElementsDistinct(nDims, count, bufferStride))
+    {
+        return ReadInPlace(arrayStartIdx, count, arrayStep, bufferStride,
+                           bufferDataType, pDstBuffer);
+    }
+
     std::vector<GPtrDiff_t> actualBufferStrideVector;
     const GPtrDiff_t *actualBufferStridePtr = bufferStride;
     void *pTempBuffer = pDstBuffer;
@@ -6197,6 +6977,110 @@ lbl_next_depth:
     return true;
 }
 
+/************************************************************************/
+/*                            ReadInPlace()                             */
+/************************************************************************/
+
+// Reads the raw values of the parent array in the first bytes of the slots
+// of the output buffer, and unscales them in place, one line at a time.
+// Requires non-complex numeric types, the size of the output data type to
+// be a multiple of the one of the parent data type, and
+// AreBufferElementsDistinct() to be true.
+bool GDALMDArrayUnscaled::ReadInPlace(
+    const GUInt64 *arrayStartIdx, const size_t *count, const GInt64 *arrayStep,
+    const GPtrDiff_t *bufferStride, const GDALExtendedDataType &bufferDataType,
+    void *pDstBuffer) const
+{
+    const auto &oParentDT = m_poParent->GetDataType();
+    const size_t nParentDTSize = oParentDT.GetSize();
+    const size_t nBufferDTSize = bufferDataType.GetSize();
+    const GPtrDiff_t nRatio =
+        static_cast<GPtrDiff_t>(nBufferDTSize / nParentDTSize);
+    const size_t nDims = GetDimensionCount();
+    const size_t nLineCount = count[nDims - 1];
+    const int nLineStride =
+        static_cast<int>(bufferStride[nDims - 1] *
+                         static_cast<GPtrDiff_t>(nBufferDTSize));
+    if (bufferStride[nDims - 1] * static_cast<GPtrDiff_t>(nBufferDTSize) !=
+        nLineStride)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported, "Too large buffer stride");
+        return false;
+    }
+
+    std::vector<GPtrDiff_t> anParentStride(nDims);
+    for (size_t i = 0; i < nDims; ++i)
+        anParentStride[i] = bufferStride[i] * nRatio;
+    if (!m_poParent->Read(arrayStartIdx, count, arrayStep,
+                          anParentStride.data(), oParentDT, pDstBuffer))
+    {
+        return false;
+    }
+
+    double dfSrcNoData = 0;
+    if (m_bHasNoData)
+    {
+        GDALExtendedDataType::CopyValue(
+            m_poParent->GetRawNoDataValue(), oParentDT, &dfSrcNoData,
+            GDALExtendedDataType::Create(GDT_Float64));
+    }
+    double dfDstNoData = 0;
+    GDALCopyWords(m_abyRawNoData.data(), m_dt.GetNumericDataType(), 0,
+                  &dfDstNoData, GDT_Float64, 0, 1);
+
+    const GDALDataType eParentDT = oParentDT.GetNumericDataType();
+    const GDALDataType eBufferDT = bufferDataType.GetNumericDataType();
+    std::vector<double> adfLine;
+    try
+    {
+        adfLine.resize(nLineCount);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Out of memory");
+        return false;
+    }
+
+    // Iterate over the lines, that is all but the last dimension.
+    std::vector<size_t> anIdx(nDims);
+    while (true)
+    {
+        GByte *pabyLine = static_cast<GByte *>(pDstBuffer);
+        for (size_t i = 0; i + 1 < nDims; ++i)
+        {
+            pabyLine += static_cast<GPtrDiff_t>(anIdx[i]) * bufferStride[i] *
+                        static_cast<GPtrDiff_t>(nBufferDTSize);
+        }
+        // The whole line is read before being overwritten.
+        GDALCopyWords64(pabyLine, eParentDT, nLineStride, adfLine.data(),
+                        GDT_Float64, static_cast<int>(sizeof(double)),
+                        static_cast<GPtrDiff_t>(nLineCount));
+        for (double &dfVal : adfLine)
+        {
+            if (!m_bHasNoData || dfVal != dfSrcNoData)
+                dfVal = dfVal * m_dfScale + m_dfOffset;
+            else
+                dfVal = dfDstNoData;
+        }
+        GDALCopyWords64(adfLine.data(), GDT_Float64,
+                        static_cast<int>(sizeof(double)), pabyLine, eBufferDT,
+                        nLineStride, static_cast<GPtrDiff_t>(nLineCount));
+
+        size_t i = nDims - 1;
+        while (i > 0)
+        {
+            --i;
+            if (++anIdx[i] < count[i])
+                break;
+            anIdx[i] = 0;
+            if (i == 0)
+                return true;
+        }
+        if (nDims == 1)
+            return true;
+    }
+}
+
 /************************************************************************/
 /*                             IWrite()                                 */
 /************************************************************************/
@@ -6540,6 +7424,11 @@ class GDALMDArrayMask final : public GDALPamMDArray
     {
         return m_poParent->GetBlockSize();
     }
+
+    bool IsReadThreadSafe() const override
+    {
+        return m_poParent->IsReadThreadSafe();
+    }
 };
 
 /************************************************************************/
@@ -8811,6 +9700,7 @@ CPLErr GDALRasterBandFromArray::IRasterIO(GDALRWFlag eRWFlag, int nXOff,
 {
     auto l_poDS(cpl::down_cast<GDALDatasetFromArray *>(poDS));
     const auto &poArray(l_poDS->m_poArray);
+    GDALCodecStatisticsRecorder::DefaultDatasetSetter oCodecStatsSetter(poDS);
     const int nBufferDTSize(GDALGetDataTypeSizeBytes(eBufType));
     if (nXSize == nBufXSize && nYSize == nBufYSize && nBufferDTSize > 0 &&
         (nPixelSpaceBuf % nBufferDTSize) == 0 &&
@@ -9484,6 +10374,9 @@ CPLErr GDALMDArray::GetStatistics(bool bApproxOK, bool bForce, double *pdfMin,
  *                     approximate mode, and the dataset is opened in update
  *                     mode.
  *
+ * Since GDAL 3.9, the chunks of the array are processed by as many threads
+ * as specified by the GDAL_NUM_THREADS configuration option.
+ *
  * @return true on success
  *
  * @since GDAL 3.2
@@ -9505,16 +10398,17 @@ bool GDALMDArray::ComputeStatistics(bool bApproxOK, double *pdfMin,
         double dfMean = 0.0;
         double dfM2 = 0.0;
         GUInt64 nValidCount = 0;
-        std::vector<GByte> abyData{};
-        std::vector<double> adfData{};
-        std::vector<GByte> abyMaskData{};
+        GUInt64 nChunksDone = 0;
         GDALProgressFunc pfnProgress = nullptr;
         void *pProgressData = nullptr;
+        // Chunks may be processed concurrently. hMutex protects the above
+        // members, and the reads of arrays that are not thread-safe.
+        std::mutex hMutex{};
     };
 
     const auto PerChunkFunc = [](GDALAbstractMDArray *,
                                  const GUInt64 *chunkArrayStartIdx,
-                                 const size_t *chunkCount, GUInt64 iCurChunk,
+                                 const size_t *chunkCount, GUInt64,
                                  GUInt64 nChunkCount, void *pUserData)
     {
         StatsPerChunkType *data = static_cast<StatsPerChunkType *>(pUserData);
@@ -9525,55 +10419,91 @@ bool GDALMDArray::ComputeStatistics(bool bApproxOK, double *pdfMin,
         for (size_t i = 0; i < nDims; i++)
             nVals *= chunkCount[i];
 
+        const auto ReadChunk = [data, chunkArrayStartIdx,
+                                chunkCount](const GDALMDArray *poArray,
+                                            const GDALExtendedDataType &oDT,
+                                            void *pDstBuffer)
+        {
+            if (poArray->IsReadThreadSafe())
+            {
+                return poArray->Read(chunkArrayStartIdx, chunkCount, nullptr,
+                                     nullptr, oDT, pDstBuffer);
+            }
+            std::lock_guard<std::mutex> oLock(data->hMutex);
+            return poArray->Read(chunkArrayStartIdx, chunkCount, nullptr,
+                                 nullptr, oDT, pDstBuffer);
+        };
+
         // Get mask
-        data->abyMaskData.resize(nVals);
-        if (!(poMask->Read(chunkArrayStartIdx, chunkCount, nullptr, nullptr,
-                           poMask->GetDataType(), &data->abyMaskData[0])))
+        std::vector<GByte> abyMaskData(nVals);
+        if (!ReadChunk(poMask, poMask->GetDataType(), &abyMaskData[0]))
         {
             return false;
         }
 
         // Get data
+        std::vector<double> adfData(nVals);
         const auto &oType = array->GetDataType();
         if (oType.GetNumericDataType() == GDT_Float64)
         {
-            data->adfData.resize(nVals);
-            if (!array->Read(chunkArrayStartIdx, chunkCount, nullptr, nullptr,
-                             oType, &data->adfData[0]))
+            if (!ReadChunk(array, oType, &adfData[0]))
             {
                 return false;
             }
         }
         else
         {
-            data->abyData.resize(nVals * oType.GetSize());
-            if (!array->Read(chunkArrayStartIdx, chunkCount, nullptr, nullptr,
-                             oType, &data->abyData[0]))
+            std::vector<GByte> abyData(nVals * oType.GetSize());
+            if (!ReadChunk(array, oType, &abyData[0]))
             {
                 return false;
             }
-            data->adfData.resize(nVals);
-            GDALCopyWords64(&data->abyData[0], oType.GetNumericDataType(),
-                            static_cast<int>(oType.GetSize()),
-                            &data->adfData[0], GDT_Float64,
-                            static_cast<int>(sizeof(double)),
+            GDALCopyWords64(&abyData[0], oType.GetNumericDataType(),
+                            static_cast<int>(oType.GetSize()), &adfData[0],
+                            GDT_Float64, static_cast<int>(sizeof(double)),
                             static_cast<GPtrDiff_t>(nVals));
         }
+
+        double dfMin = std::numeric_limits<double>::max();
+        double dfMax = -std::numeric_limits<double>::max();
+        double dfMean = 0.0;
+        double dfM2 = 0.0;
+        GUInt64 nValidCount = 0;
         for (size_t i = 0; i < nVals; i++)
         {
-            if (data->abyMaskData[i])
+            if (abyMaskData[i])
             {
-                const double dfValue = data->adfData[i];
-                data->dfMin = std::min(data->dfMin, dfValue);
-                data->dfMax = std::max(data->dfMax, dfValue);
-                data->nValidCount++;
-                const double dfDelta = dfValue - data->dfMean;
-                data->dfMean += dfDelta / data->nValidCount;
-                data->dfM2 += dfDelta * (dfValue - data->dfMean);
+                const double dfValue = adfData[i];
+                dfMin = std::min(dfMin, dfValue);
+                dfMax = std::max(dfMax, dfValue);
+                nValidCount++;
+                const double dfDelta = dfValue - dfMean;
+                dfMean += dfDelta / nValidCount;
+                dfM2 += dfDelta * (dfValue - dfMean);
             }
         }
+
+        std::lock_guard<std::mutex> oLock(data->hMutex);
+        if (nValidCount > 0)
+        {
+            // Merge the statistics of the chunk with the ones of the
+            // previous chunks (Chan et al. parallel algorithm)
+            data->dfMin = std::min(data->dfMin, dfMin);
+            data->dfMax = std::max(data->dfMax, dfMax);
+            const GUInt64 nNewValidCount = data->nValidCount + nValidCount;
+            const double dfDelta = dfMean - data->dfMean;
+            data->dfMean +=
+                dfDelta * static_cast<double>(nValidCount) / nNewValidCount;
+            data->dfM2 += dfM2 + dfDelta * dfDelta *
+                                     static_cast<double>(data->nValidCount) *
+                                     static_cast<double>(nValidCount) /
+                                     nNewValidCount;
+            data->nValidCount = nNewValidCount;
+        }
+        data->nChunksDone++;
         if (data->pfnProgress &&
-            !data->pfnProgress(static_cast<double>(iCurChunk + 1) / nChunkCount,
+            !data->pfnProgress(static_cast<double>(data->nChunksDone) /
+                                   nChunkCount,
                                "", data->pProgressData))
         {
             return false;
@@ -9619,7 +10549,7 @@ bool GDALMDArray::ComputeStatistics(bool bApproxOK, double *pdfMin,
     sData.pProgressData = pProgressData;
     if (!ProcessPerChunk(arrayStartIdx.data(), count.data(),
                          GetProcessingChunkSize(nMaxChunkSize).data(),
-                         PerChunkFunc, &sData))
+                         PerChunkFunc, &sData, GDALMDArrayGetNumThreads()))
     {
         return false;
     }
@@ -0,0 +1,403 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Implementation of GDALDataset::MultiRasterIO()
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, Even Rouault <even dot rouault at spatialys dot org>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_priv.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <numeric>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_multiproc.h"
+#include "cpl_string.h"
+#include "gdal_thread_pool.h"
+
+namespace
+{
+// Consecutive windows, in block order, worth being announced together to
+// AdviseRead().
+struct WindowGroup
+{
+    std::vector<int> anWindows{};
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    int nYSize = 0;
+    bool bAdviseRead = false;
+};
+
+struct MultiRasterIOContext
+{
+    GDALRasterIOWindow *pasWindows = nullptr;
+    GDALDataType eBufType = GDT_Unknown;
+    int nBandCount = 0;
+    int *panBandMap = nullptr;
+    GSpacing nPixelSpace = 0;
+    GSpacing nLineSpace = 0;
+    GSpacing nBandSpace = 0;
+    const std::vector<WindowGroup> *paoGroups = nullptr;
+};
+
+struct MultiRasterIOJob
+{
+    const MultiRasterIOContext *psContext = nullptr;
+    GDALDataset *poDS = nullptr;
+    size_t nFirstGroup = 0;
+    size_t nLastGroup = 0;  // exclusive
+};
+}  // namespace
+
+/************************************************************************/
+/*                         ProcessWindowGroups()                        */
+/************************************************************************/
+
+static void ProcessWindowGroups(const MultiRasterIOContext &sContext,
+                                GDALDataset *poDS, size_t nFirstGroup,
+                                size_t nLastGroup)
+{
+    for (size_t iGroup = nFirstGroup; iGroup < nLastGroup; ++iGroup)
+    {
+        const WindowGroup &oGroup = (*sContext.paoGroups)[iGroup];
+        if (oGroup.bAdviseRead)
+        {
+            CPL_IGNORE_RET_VAL(poDS->AdviseRead(
+                oGroup.nXOff, oGroup.nYOff, oGroup.nXSize, oGroup.nYSize,
+                oGroup.nXSize, oGroup.nYSize, sContext.eBufType,
+                sContext.nBandCount, sContext.panBandMap, nullptr));
+        }
+        for (const int iWindow : oGroup.anWindows)
+        {
+            GDALRasterIOWindow &sWindow = sContext.pasWindows[iWindow];
+            sWindow.eErr = poDS->RasterIO(
+                GF_Read, sWindow.nXOff, sWindow.nYOff, sWindow.nXSize,
+                sWindow.nYSize, sWindow.pData, sWindow.nBufXSize,
+                sWindow.nBufYSize, sContext.eBufType, sContext.nBandCount,
+                sContext.panBandMap, sContext.nPixelSpace, sContext.nLineSpace,
+                sContext.nBandSpace, nullptr);
+        }
+    }
+}
+
+/************************************************************************/
+/*                         MultiRasterIOJobFunc()                       */
+/************************************************************************/
+
+static void MultiRasterIOJobFunc(void *pData)
+{
+    const auto psJob = static_cast<const MultiRasterIOJob *>(pData);
+    // The jobs already use the threads of the global pool
+    CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", "1", false);
+    ProcessWindowGroups(*(psJob->psContext), psJob->poDS, psJob->nFirstGroup,
+                        psJob->nLastGroup);
+}
+
+/************************************************************************/
+/*                            MultiRasterIO()                           */
+/************************************************************************/
+
+/**
+ * \brief Read a batch of windows of this dataset.
+ *
+ * This method is equivalent to calling RasterIO() in GF_Read mode for each
+ * window, with the same buffer data type, band map and spacings, but is more
+ * efficient for a large number of small windows, such as for point sampling
+ * or chip extraction. The windows are processed in the order of the blocks
+ * they intersect, so that each block is read once as long as it fits in the
+ * block cache. Nearby full resolution windows are announced together to
+ * AdviseRead(), so that drivers able to fetch several blocks at once, for
+ * instance from network, can do so.
+ *
+ * The windows may be read in parallel, when the NUM_THREADS option or the
+ * GDAL_NUM_THREADS configuration option is set, for datasets opened in
+ * read-only mode by a driver declaring GDAL_DCAP_PARALLEL_CLONE_READ.
+ *
+ * This method is the same as the C function GDALDatasetMultiRasterIO().
+ *
+ * @param nWindowCount the number of windows.
+ *
+ * @param pasWindows array of nWindowCount windows, each with its own buffer.
+ * The eErr member of each window is set to the status of its read.
+ *
+ * @param eBufType the type of the pixel values in the buffers.
+ *
+ * @param nBandCount the number of bands being read.
+ *
+ * @param panBandMap the list of nBandCount band numbers being read.
+ * Note band numbers are 1 based. This may be NULL to select the first
+ * nBandCount bands.
+ *
+ * @param nPixelSpace, nLineSpace, nBandSpace spacings in the buffers, with
+ * the same meaning as in RasterIO(). If 0, the default values for a packed
+ * buffer of each window are used.
+ *
+ * @param papszOptions NULL terminated list of options, or NULL.
+ * Currently supported options are:
+ * <ul>
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS: maximum number of threads.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option.</li>
+ * </ul>
+ *
+ * @return CE_None if all windows have been successfully read, CE_Failure
+ * otherwise.
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALDataset::MultiRasterIO(int nWindowCount,
+                                  GDALRasterIOWindow *pasWindows,
+                                  GDALDataType eBufType, int nBandCount,
+                                  int *panBandMap, GSpacing nPixelSpace,
+                                  GSpacing nLineSpace, GSpacing nBandSpace,
+                                  CSLConstList papszOptions)
+{
+    if (nWindowCount == 0)
+        return CE_None;
+    if (nWindowCount < 0 || pasWindows == nullptr)
+    {
+        ReportError(CE_Failure, CPLE_IllegalArg,
+                    "MultiRasterIO(): invalid window list");
+        return CE_Failure;
+    }
+
+    GDALRasterBand *poFirstBand =
+        nBandCount > 0 ? GetRasterBand(panBandMap ? panBandMap[0] : 1)
+                       : nullptr;
+    if (poFirstBand == nullptr)
+    {
+        ReportError(CE_Failure, CPLE_IllegalArg,
+                    "MultiRasterIO(): invalid band list");
+        for (int i = 0; i < nWindowCount; ++i)
+            pasWindows[i].eErr = CE_Failure;
+        return CE_Failure;
+    }
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poFirstBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    nBlockXSize = std::max(1, nBlockXSize);
+    nBlockYSize = std::max(1, nBlockYSize);
+
+    /* -------------------------------------------------------------------- */
+    /*      Sort the windows by the block of their top left corner.         */
+    /* -------------------------------------------------------------------- */
+    const auto IsRegular = [this, pasWindows](int i)
+    {
+        const GDALRasterIOWindow &sWindow = pasWindows[i];
+        return sWindow.nXOff >= 0 && sWindow.nYOff >= 0 &&
+               sWindow.nXSize > 0 && sWindow.nYSize > 0 &&
+               sWindow.nXSize <= nRasterXSize - sWindow.nXOff &&
+               sWindow.nYSize <= nRasterYSize - sWindow.nYOff &&
+               sWindow.nBufXSize == sWindow.nXSize &&
+               sWindow.nBufYSize == sWindow.nYSize;
+    };
+    std::vector<int> anOrder(nWindowCount);
+    std::iota(anOrder.begin(), anOrder.end(), 0);
+    std::stable_sort(
+        anOrder.begin(), anOrder.end(),
+        [pasWindows, nBlockXSize, nBlockYSize](int a, int b)
+        {
+            const GDALRasterIOWindow &sA = pasWindows[a];
+            const GDALRasterIOWindow &sB = pasWindows[b];
+            return std::make_pair(sA.nYOff / nBlockYSize,
+                                  sA.nXOff / nBlockXSize) <
+                   std::make_pair(sB.nYOff / nBlockYSize,
+                                  sB.nXOff / nBlockXSize);
+        });
+
+    /* -------------------------------------------------------------------- */
+    /*      Group consecutive full resolution windows starting in the same  */
+    /*      row of blocks, as long as the blocks they intersect cover at    */
+    /*      least half of the blocks of the bounding box of the group.      */
+    /* -------------------------------------------------------------------- */
+    std::vector<WindowGroup> aoGroups;
+    std::set<std::pair<int, int>> oSetBlocks;
+    const auto BlockCount = [nBlockXSize, nBlockYSize](int nXOff, int nYOff,
+                                                       int nXSize, int nYSize)
+    {
+        return static_cast<GIntBig>((nXOff + nXSize - 1) / nBlockXSize -
+                                    nXOff / nBlockXSize + 1) *
+               ((nYOff + nYSize - 1) / nBlockYSize - nYOff / nBlockYSize + 1);
+    };
+    for (const int iWindow : anOrder)
+    {
+        const GDALRasterIOWindow &sWindow = pasWindows[iWindow];
+        const bool bRegular = IsRegular(iWindow);
+        bool bAppend = false;
+        int nNewXOff = 0;
+        int nNewYOff = 0;
+        int nNewXEnd = 0;
+        int nNewYEnd = 0;
+        if (bRegular && !aoGroups.empty() && !oSetBlocks.empty())
+        {
+            const WindowGroup &oGroup = aoGroups.back();
+            nNewXOff = std::min(oGroup.nXOff, sWindow.nXOff);
+            nNewYOff = std::min(oGroup.nYOff, sWindow.nYOff);
+            nNewXEnd = std::max(oGroup.nXOff + oGroup.nXSize,
+                                sWindow.nXOff + sWindow.nXSize);
+            nNewYEnd = std::max(oGroup.nYOff + oGroup.nYSize,
+                                sWindow.nYOff + sWindow.nYSize);
+            if (oGroup.nYOff / nBlockYSize == sWindow.nYOff / nBlockYSize &&
+                BlockCount(nNewXOff, nNewYOff, nNewXEnd - nNewXOff,
+                           nNewYEnd - nNewYOff) <=
+                    2 * static_cast<GIntBig>(
+                            oSetBlocks.size() +
+                            BlockCount(sWindow.nXOff, sWindow.nYOff,
+                                       sWindow.nXSize, sWindow.nYSize)))
+            {
+                bAppend = true;
+            }
+        }
+        if (bAppend)
+        {
+            WindowGroup &oGroup = aoGroups.back();
+            oGroup.anWindows.push_back(iWindow);
+            oGroup.nXOff = nNewXOff;
+            oGroup.nYOff = nNewYOff;
+            oGroup.nXSize = nNewXEnd - nNewXOff;
+            oGroup.nYSize = nNewYEnd - nNewYOff;
+            oGroup.bAdviseRead = true;
+        }
+        else
+        {
+            aoGroups.emplace_back();
+            WindowGroup &oGroup = aoGroups.back();
+            oGroup.anWindows.push_back(iWindow);
+            oGroup.nXOff = sWindow.nXOff;
+            oGroup.nYOff = sWindow.nYOff;
+            oGroup.nXSize = sWindow.nXSize;
+            oGroup.nYSize = sWindow.nYSize;
+            oSetBlocks.clear();
+        }
+        if (bRegular)
+        {
+            for (int iY = sWindow.nYOff / nBlockYSize;
+                 iY <= (sWindow.nYOff + sWindow.nYSize - 1) / nBlockYSize; ++iY)
+            {
+                for (int iX = sWindow.nXOff / nBlockXSize;
+                     iX <= (sWindow.nXOff + sWindow.nXSize - 1) / nBlockXSize;
+                     ++iX)
+                {
+                    oSetBlocks.insert(std::make_pair(iY, iX));
+                }
+            }
+        }
+    }
+
+    MultiRasterIOContext sContext;
+    sContext.pasWindows = pasWindows;
+    sContext.eBufType = eBufType;
+    sContext.nBandCount = nBandCount;
+    sContext.panBandMap = panBandMap;
+    sContext.nPixelSpace = nPixelSpace;
+    sContext.nLineSpace = nLineSpace;
+    sContext.nBandSpace = nBandSpace;
+    sContext.paoGroups = &aoGroups;
+
+    /* -------------------------------------------------------------------- */
+    /*      Distribute the groups among clones of the dataset, if allowed.  */
+    /* -------------------------------------------------------------------- */
+    const char *pszNumThreads = CSLFetchNameValueDef(
+        papszOptions, "NUM_THREADS",
+        CPLGetConfigOption("GDAL_NUM_THREADS", nullptr));
+    int nThreads = 0;
+    if (pszNumThreads)
+    {
+        nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+        nThreads = std::min(
+            std::min(nThreads, 1024),
+            static_cast<int>(std::min<size_t>(aoGroups.size(), 1024)));
+    }
+    std::vector<GDALDataset *> apoClones;
+    for (int i = 0; nThreads > 1 && i < nThreads; ++i)
+    {
+        GDALDataset *poClone = AcquireParallelReadClone();
+        if (poClone == nullptr)
+            break;
+        apoClones.push_back(poClone);
+    }
+    CPLWorkerThreadPool *poPool =
+        apoClones.size() >= 2 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    if (poQueue)
+    {
+        const size_t nJobCount = apoClones.size();
+        std::vector<MultiRasterIOJob> asJobs(nJobCount);
+        for (size_t i = 0; i < nJobCount; ++i)
+        {
+            asJobs[i].psContext = &sContext;
+            asJobs[i].poDS = apoClones[i];
+            asJobs[i].nFirstGroup = aoGroups.size() * i / nJobCount;
+            asJobs[i].nLastGroup = aoGroups.size() * (i + 1) / nJobCount;
+            if (!poQueue->SubmitJob(MultiRasterIOJobFunc, &asJobs[i]))
+                MultiRasterIOJobFunc(&asJobs[i]);
+        }
+        poQueue->WaitCompletion();
+    }
+    else
+    {
+        ProcessWindowGroups(sContext, this, 0, aoGroups.size());
+    }
+    for (GDALDataset *poClone : apoClones)
+        ReleaseParallelReadClone(poClone);
+
+    for (int i = 0; i < nWindowCount; ++i)
+    {
+        if (pasWindows[i].eErr != CE_None)
+            return CE_Failure;
+    }
+    return CE_None;
+}
+
+/************************************************************************/
+/*                      GDALDatasetMultiRasterIO()                      */
+/************************************************************************/
+
+/**
+ * \brief Read a batch of windows of a dataset.
+ *
+ * @see GDALDataset::MultiRasterIO()
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALDatasetMultiRasterIO(GDALDatasetH hDS, int nWindowCount,
+                                GDALRasterIOWindow *pasWindows,
+                                GDALDataType eBufType, int nBandCount,
+                                int *panBandMap, GSpacing nPixelSpace,
+                                GSpacing nLineSpace, GSpacing nBandSpace,
+                                CSLConstList papszOptions)
+{
+    VALIDATE_POINTER1(hDS, "GDALDatasetMultiRasterIO", CE_Failure);
+
+    return GDALDataset::FromHandle(hDS)->MultiRasterIO(
+        nWindowCount, pasWindows, eBufType, nBandCount, panBandMap,
+        nPixelSpace, nLineSpace, nBandSpace, papszOptions);
+}
@@ -39,20 +39,26 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <new>
 #include <type_traits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_trace.h"
 #include "cpl_virtualmem.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_rat.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALRasterBand()                           */
@@ -308,12 +314,19 @@ CPLErr GDALRasterBand::RasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         INIT_RASTERIO_EXTRA_ARG(sExtraArg);
         psExtraArg = &sExtraArg;
     }
-    else if (psExtraArg->nVersion != RASTERIO_EXTRA_ARG_CURRENT_VERSION)
+    else if (psExtraArg->nVersion < 1 ||
+             psExtraArg->nVersion > RASTERIO_EXTRA_ARG_CURRENT_VERSION)
     {
         ReportError(CE_Failure, CPLE_AppDefined,
                     "Unhandled version of GDALRasterIOExtraArg");
         return CE_Failure;
     }
+    else if (psExtraArg->nVersion < RASTERIO_EXTRA_ARG_CURRENT_VERSION)
+    {
+        // Upgrade to the current version of the structure
+        GDALCopyRasterIOExtraArg(&sExtraArg, psExtraArg);
+        psExtraArg = &sExtraArg;
+    }
 
     GDALRasterIOExtraArgSetResampleAlg(psExtraArg, nXSize, nYSize, nBufXSize,
                                        nBufYSize);
@@ -401,7 +414,26 @@ CPLErr GDALRasterBand::RasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
     /*      Call the format specific function.                              */
     /* -------------------------------------------------------------------- */
 
+    CPLTraceSpan oTraceSpan("GDALRasterBand::RasterIO");
+    if (oTraceSpan.IsEnabled())
+    {
+        if (poDS)
+            oTraceSpan.SetAttribute("dataset", poDS->GetDescription());
+        oTraceSpan.SetAttribute("band", static_cast<GIntBig>(nBand));
+        oTraceSpan.SetAttribute("rw", eRWFlag == GF_Read ? "read" : "write");
+        oTraceSpan.SetAttribute("x", static_cast<GIntBig>(nXOff));
+        oTraceSpan.SetAttribute("y", static_cast<GIntBig>(nYOff));
+        oTraceSpan.SetAttribute("width", static_cast<GIntBig>(nXSize));
+        oTraceSpan.SetAttribute("height", static_cast<GIntBig>(nYSize));
+        oTraceSpan.SetAttribute(
+            "bytes", static_cast<GIntBig>(nBufXSize) * nBufYSize *
+                         GDALGetDataTypeSizeBytes(eBufType));
+    }
+
     const bool bCallLeaveReadWrite = CPL_TO_BOOL(EnterReadWrite(eRWFlag));
+    const bool bStreaming = eRWFlag == GF_Read && psExtraArg->bStreaming;
+    if (bStreaming)
+        GDALRasterBlock::EnterStreamingRead();
 
     CPLErr eErr;
     if (bForceCachedIO)
@@ -413,6 +445,8 @@ CPLErr GDALRasterBand::RasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize,
                       nBufYSize, eBufType, nPixelSpace, nLineSpace, psExtraArg);
 
+    if (bStreaming)
+        GDALRasterBlock::LeaveStreamingRead();
     if (bCallLeaveReadWrite)
         LeaveReadWrite();
 
@@ -585,6 +619,16 @@ CPLErr GDALRasterBand::ReadBlock(int nXBlockOff, int nYBlockOff, void *pImage)
     /*      Invoke underlying implementation method.                        */
     /* -------------------------------------------------------------------- */
 
+    CPLTraceSpan oTraceSpan("GDALRasterBand::ReadBlock");
+    if (oTraceSpan.IsEnabled())
+    {
+        if (poDS && poDS->GetDriver())
+            oTraceSpan.SetAttribute("driver",
+                                    poDS->GetDriver()->GetDescription());
+        oTraceSpan.SetAttribute("block_x", static_cast<GIntBig>(nXBlockOff));
+        oTraceSpan.SetAttribute("block_y", static_cast<GIntBig>(nYBlockOff));
+    }
+
     int bCallLeaveReadWrite = EnterReadWrite(GF_Read);
     CPLErr eErr = IReadBlock(nXBlockOff, nYBlockOff, pImage);
     if (bCallLeaveReadWrite)
@@ -1119,7 +1163,57 @@ CPLErr GDALRasterBand::FlushCache(bool bAtClosing)
     if (poBandBlockCache == nullptr || !poBandBlockCache->IsInitOK())
         return eGlobalErr;
 
-    return poBandBlockCache->FlushCache();
+    const CPLErr eErr = poBandBlockCache->FlushCache();
+    // Done after FlushCache() has waited for the blocks being evicted by
+    // other threads, which might still be added to the compressed tier.
+    GDALCompressedBlockCacheDropBand(this);
+    GDALDiskBlockCacheDropBand(this);
+    return eErr;
+}
+
+/************************************************************************/
+/*                      GetBlockCacheStatistics()                       */
+/************************************************************************/
+
+/**
+ * \brief Return the statistics of the raster block cache for this band.
+ *
+ * nHits and nMisses are only collected when the GDAL_BLOCK_CACHE_STATISTICS
+ * configuration option is set to YES. dfLockWaitTime is always 0, as it is
+ * only available globally, with GDALGetBlockCacheStatistics().
+ *
+ * This method is the same as the C function
+ * GDALGetRasterBandBlockCacheStatistics().
+ *
+ * @param psStats Structure to fill. Must not be NULL.
+ * @since GDAL 3.9
+ */
+
+void GDALRasterBand::GetBlockCacheStatistics(
+    GDALBlockCacheStatistics *psStats) const
+{
+    memset(psStats, 0, sizeof(*psStats));
+    if (poBandBlockCache)
+        poBandBlockCache->GetStatistics(psStats);
+}
+
+/************************************************************************/
+/*               GDALGetRasterBandBlockCacheStatistics()                */
+/************************************************************************/
+
+/**
+ * \brief Return the statistics of the raster block cache for this band.
+ *
+ * @see GDALRasterBand::GetBlockCacheStatistics()
+ * @since GDAL 3.9
+ */
+
+void GDALGetRasterBandBlockCacheStatistics(GDALRasterBandH hBand,
+                                           GDALBlockCacheStatistics *psStats)
+{
+    VALIDATE_POINTER0(hBand, __func__);
+    VALIDATE_POINTER0(psStats, __func__);
+    GDALRasterBand::FromHandle(hBand)->GetBlockCacheStatistics(psStats);
 }
 
 /************************************************************************/
@@ -1413,10 +1507,27 @@ GDALRasterBlock *GDALRasterBand::GetLockedBlockRef(int nXBlockOff,
         if (!bJustInitialize)
         {
             const GUInt32 nErrorCounter = CPLGetErrorCounter();
-            int bCallLeaveReadWrite = EnterReadWrite(GF_Read);
-            eErr = IReadBlock(nXBlockOff, nYBlockOff, poBlock->GetDataRef());
-            if (bCallLeaveReadWrite)
-                LeaveReadWrite();
+            const size_t nBlockSize =
+                static_cast<size_t>(poBlock->GetBlockSize());
+            if (GDALCompressedBlockCacheFetch(this, nXBlockOff, nYBlockOff,
+                                              poBlock->GetDataRef(),
+                                              nBlockSize) ||
+                GDALDiskBlockCacheFetch(this, nXBlockOff, nYBlockOff,
+                                        poBlock->GetDataRef(), nBlockSize))
+            {
+                eErr = CE_None;
+            }
+            else
+            {
+                int bCallLeaveReadWrite = EnterReadWrite(GF_Read);
+                eErr = IReadBlock(nXBlockOff, nYBlockOff,
+                                  poBlock->GetDataRef());
+                if (bCallLeaveReadWrite)
+                    LeaveReadWrite();
+                if (eErr == CE_None)
+                    GDALDiskBlockCacheStore(this, nXBlockOff, nYBlockOff,
+                                            poBlock->GetDataRef(), nBlockSize);
+            }
             if (eErr != CE_None)
             {
                 poBlock->DropLock();
@@ -1445,6 +1556,39 @@ GDALRasterBlock *GDALRasterBand::GetLockedBlockRef(int nXBlockOff,
     return poBlock;
 }
 
+/************************************************************************/
+/*                            GetBlockView()                            */
+/************************************************************************/
+
+/**
+ * \brief Return a read-only view on the data of a block, kept in the block
+ * cache while the view exists.
+ *
+ * This avoids the copy done by RasterIO() or ReadBlock() when the caller can
+ * directly consume the block data in the band data type, for instance to
+ * encode it.
+ *
+ * The block data must not be modified through the view. Writes to the
+ * block done through this band while the view exists are visible in it.
+ * The view must be destroyed before the block cache of this band is
+ * flushed, and before its dataset is closed.
+ *
+ * @param nXBlockOff the horizontal block offset, with zero indicating
+ * the left most block, 1 the next block and so forth.
+ *
+ * @param nYBlockOff the vertical block offset, with zero indicating
+ * the top most block, 1 the next block and so forth.
+ *
+ * @return a view, empty (evaluating to false) on failure.
+ * @since GDAL 3.9
+ */
+
+GDALRasterBlockView GDALRasterBand::GetBlockView(int nXBlockOff,
+                                                 int nYBlockOff)
+{
+    return GDALRasterBlockView(GetLockedBlockRef(nXBlockOff, nYBlockOff));
+}
+
 /************************************************************************/
 /*                               Fill()                                 */
 /************************************************************************/
@@ -3296,6 +3440,191 @@ static inline void ComputeFloatNoDataValue(GDALDataType eDataType,
     }
 }
 
+/************************************************************************/
+/*                       GDALSampledBlocksInJobs                        */
+/************************************************************************/
+
+namespace
+{
+// Processes the sampled blocks of a band in jobs of the global thread pool,
+// each of them reading from its own clone of the dataset of the band, when
+// the GDAL_NUM_THREADS configuration option is set and the driver declares
+// GDAL_DCAP_PARALLEL_CLONE_READ. Used by ComputeStatistics(),
+// ComputeRasterMinMax() and GetHistogram(), which merge per-job accumulators
+// once Run() has returned.
+class GDALSampledBlocksInJobs
+{
+  public:
+    //! Processes a block with a band of the clone. Must return false on error
+    typedef std::function<bool(int iJob, GDALRasterBand *poBand,
+                               int iSampleBlock)>
+        ProcessBlockFunc;
+
+    GDALSampledBlocksInJobs(GDALRasterBand *poBand, int nTotalBlocks,
+                            int nSampleRate);
+
+    //! Number of jobs, or 0 if the blocks must be processed sequentially.
+    int GetJobCount() const
+    {
+        return static_cast<int>(m_asJobs.size());
+    }
+
+    bool Run(const ProcessBlockFunc &pfnProcessBlock,
+             GDALProgressFunc pfnProgress, void *pProgressData,
+             const char *pszMessage);
+
+  private:
+    struct Job
+    {
+        GDALSampledBlocksInJobs *poParent = nullptr;
+        int iJob = 0;
+        int iFirstBlock = 0;
+        int iEndBlock = 0;
+    };
+
+    GDALDataset *m_poDS = nullptr;
+    int m_nBand = 0;
+    int m_nSampleRate = 1;
+    int m_nThreads = 0;
+    std::vector<Job> m_asJobs{};
+    const ProcessBlockFunc *m_pfnProcessBlock = nullptr;
+    std::atomic<bool> m_bSuccess{true};
+
+    static void JobFunc(void *pData);
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALSampledBlocksInJobs)
+};
+}  // namespace
+
+// Set in the worker threads, so that the jobs do not wait for jobs of their
+// own thread pool.
+static thread_local bool tls_bInSampledBlocksJob = false;
+
+GDALSampledBlocksInJobs::GDALSampledBlocksInJobs(GDALRasterBand *poBand,
+                                                 int nTotalBlocks,
+                                                 int nSampleRate)
+    : m_poDS(poBand->GetDataset()), m_nBand(poBand->GetBand()),
+      m_nSampleRate(nSampleRate)
+{
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszNumThreads == nullptr || tls_bInSampledBlocksJob ||
+        m_poDS == nullptr || m_nBand < 1 ||
+        m_nBand > m_poDS->GetRasterCount() ||
+        m_poDS->GetRasterBand(m_nBand) != poBand)
+    {
+        return;
+    }
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+    nThreads = std::min(nThreads, 1024);
+    const int nSampledBlocks = static_cast<int>(
+        (static_cast<GIntBig>(nTotalBlocks) + nSampleRate - 1) / nSampleRate);
+    // A few jobs per thread, to balance the load when the cost of blocks
+    // varies, for example with sparse files.
+    const int nJobs = static_cast<int>(
+        std::min<GIntBig>(nSampledBlocks, static_cast<GIntBig>(nThreads) * 4));
+    if (nThreads <= 1 || nJobs <= 1)
+        return;
+
+    // Check that the dataset can be cloned, before committing to jobs.
+    GDALDataset *poClone = m_poDS->AcquireParallelReadClone();
+    if (poClone == nullptr)
+        return;
+    m_poDS->ReleaseParallelReadClone(poClone);
+
+    m_nThreads = nThreads;
+    m_asJobs.resize(nJobs);
+    for (int i = 0; i < nJobs; ++i)
+    {
+        auto &sJob = m_asJobs[i];
+        sJob.poParent = this;
+        sJob.iJob = i;
+        sJob.iFirstBlock = static_cast<int>(
+            static_cast<GIntBig>(nSampledBlocks) * i / nJobs * nSampleRate);
+        sJob.iEndBlock = static_cast<int>(std::min<GIntBig>(
+            nTotalBlocks,
+            static_cast<GIntBig>(nSampledBlocks) * (i + 1) / nJobs *
+                nSampleRate));
+    }
+}
+
+void GDALSampledBlocksInJobs::JobFunc(void *pData)
+{
+    const auto psJob = static_cast<const Job *>(pData);
+    auto poParent = psJob->poParent;
+    if (!poParent->m_bSuccess)
+        return;
+
+    tls_bInSampledBlocksJob = true;
+    GDALDataset *poClone = poParent->m_poDS->AcquireParallelReadClone();
+    GDALRasterBand *poBand =
+        poClone ? poClone->GetRasterBand(poParent->m_nBand) : nullptr;
+    if (poBand == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot open a clone of %s for parallel reads",
+                 poParent->m_poDS->GetDescription());
+        poParent->m_bSuccess = false;
+    }
+    else
+    {
+        for (int iSampleBlock = psJob->iFirstBlock;
+             iSampleBlock < psJob->iEndBlock && poParent->m_bSuccess;
+             iSampleBlock += poParent->m_nSampleRate)
+        {
+            if (!(*poParent->m_pfnProcessBlock)(psJob->iJob, poBand,
+                                                iSampleBlock))
+            {
+                poParent->m_bSuccess = false;
+            }
+        }
+    }
+    poParent->m_poDS->ReleaseParallelReadClone(poClone);
+    tls_bInSampledBlocksJob = false;
+}
+
+bool GDALSampledBlocksInJobs::Run(const ProcessBlockFunc &pfnProcessBlock,
+                                  GDALProgressFunc pfnProgress,
+                                  void *pProgressData, const char *pszMessage)
+{
+    CPLDebug("GDAL", "Processing blocks of band %d of %s with %d jobs",
+             m_nBand, m_poDS->GetDescription(), GetJobCount());
+
+    m_pfnProcessBlock = &pfnProcessBlock;
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(m_nThreads);
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    for (auto &sJob : m_asJobs)
+    {
+        if (poQueue == nullptr || !poQueue->SubmitJob(JobFunc, &sJob))
+        {
+            // Process it in this thread
+            JobFunc(&sJob);
+        }
+    }
+
+    // Report progress as jobs complete.
+    bool bInterrupted = false;
+    const int nJobs = GetJobCount();
+    for (int nRemaining = nJobs - 1; poQueue && nRemaining > 0; --nRemaining)
+    {
+        poQueue->WaitCompletion(nRemaining);
+        if (!bInterrupted &&
+            !pfnProgress(static_cast<double>(nJobs - nRemaining) / nJobs,
+                         pszMessage, pProgressData))
+        {
+            bInterrupted = true;
+            m_bSuccess = false;
+        }
+    }
+    if (poQueue)
+        poQueue->WaitCompletion();
+
+    if (bInterrupted)
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+    return m_bSuccess;
+}
+
 /************************************************************************/
 /*                            GetHistogram()                            */
 /************************************************************************/
@@ -3652,59 +3981,39 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                 nSampleRate += 1;
         }
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
-        {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
-            {
-                return CE_Failure;
-            }
-        }
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Read the blocks, and add to histogram. */
-        /* --------------------------------------------------------------------
-         */
-        for (int iSampleBlock = 0;
-             iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
-        {
-            if (!pfnProgress(
-                    iSampleBlock /
-                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
-                    "Compute Histogram", pProgressData))
-            {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
+        const int nTotalBlocks = nBlocksPerRow * nBlocksPerColumn;
 
+        // Add the values of a block to panHistogramOut.
+        const auto ProcessBlock =
+            [this, dfMin, nBuckets, bIncludeOutOfRange, dfScale,
+             bGotNoDataValue, dfNoDataValue, bGotFloatNoDataValue,
+             fNoDataValue, bSignedByte](
+                GDALRasterBand *poBlockBand, GDALRasterBand *poBlockMaskBand,
+                int iSampleBlock, GByte *pabyMaskData,
+                GUIntBig *panHistogramOut)
+        {
             const int iYBlock = iSampleBlock / nBlocksPerRow;
             const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
 
-            GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
+            GDALRasterBlock *poBlock =
+                poBlockBand->GetLockedBlockRef(iXBlock, iYBlock);
             if (poBlock == nullptr)
-            {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
+                return false;
 
             void *pData = poBlock->GetDataRef();
 
             int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
+            poBlockBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck,
+                                            &nYCheck);
+
+            if (poBlockMaskBand &&
+                poBlockMaskBand->RasterIO(
+                    GF_Read, iXBlock * nBlockXSize, iYBlock * nBlockYSize,
+                    nXCheck, nYCheck, pabyMaskData, nXCheck, nYCheck, GDT_Byte,
+                    0, nBlockXSize, nullptr) != CE_None)
             {
-                CPLFree(pabyMaskData);
                 poBlock->DropLock();
-                return CE_Failure;
+                return false;
             }
 
             // this is a special case for a common situation.
@@ -3723,12 +4032,12 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                     if (!(bGotNoDataValue &&
                           (pabyData[i] == static_cast<GByte>(dfNoDataValue))))
                     {
-                        panHistogram[pabyData[i]]++;
+                        panHistogramOut[pabyData[i]]++;
                     }
                 }
 
                 poBlock->DropLock();
-                continue;  // To next sample block.
+                return true;
             }
 
             // This isn't the fastest way to do this, but is easier for now.
@@ -3837,8 +4146,8 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                         case GDT_Unknown:
                         case GDT_TypeCount:
                             CPLAssert(false);
-                            CPLFree(pabyMaskData);
-                            return CE_Failure;
+                            poBlock->DropLock();
+                            return false;
                     }
 
                     if (eDataType != GDT_Float32 && bGotNoDataValue &&
@@ -3853,24 +4162,112 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                     if (dfIndex < 0)
                     {
                         if (bIncludeOutOfRange)
-                            panHistogram[0]++;
+                            panHistogramOut[0]++;
                     }
                     else if (dfIndex >= nBuckets)
                     {
                         if (bIncludeOutOfRange)
-                            ++panHistogram[nBuckets - 1];
+                            ++panHistogramOut[nBuckets - 1];
                     }
                     else
                     {
-                        ++panHistogram[static_cast<int>(dfIndex)];
+                        ++panHistogramOut[static_cast<int>(dfIndex)];
                     }
                 }
             }
 
             poBlock->DropLock();
+            return true;
+        };
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Read the blocks, and add to histogram. */
+        /* --------------------------------------------------------------------
+         */
+        GDALSampledBlocksInJobs oJobs(this, nTotalBlocks, nSampleRate);
+        const int nJobs = oJobs.GetJobCount();
+        if (nJobs > 0)
+        {
+            // Each job has its own histogram and mask buffer.
+            std::vector<std::vector<GUIntBig>> aanJobHistogram;
+            std::vector<std::vector<GByte>> aabyJobMaskData;
+            try
+            {
+                aanJobHistogram.resize(nJobs, std::vector<GUIntBig>(nBuckets));
+                if (poMaskBand)
+                {
+                    aabyJobMaskData.resize(
+                        nJobs, std::vector<GByte>(
+                                   static_cast<size_t>(nBlockXSize) *
+                                   nBlockYSize));
+                }
+            }
+            catch (const std::bad_alloc &)
+            {
+                ReportError(CE_Failure, CPLE_OutOfMemory,
+                            "Out of memory in GetHistogram()");
+                return CE_Failure;
+            }
+
+            if (!oJobs.Run(
+                    [&ProcessBlock, &aanJobHistogram, &aabyJobMaskData,
+                     poMaskBand](int iJob, GDALRasterBand *poJobBand,
+                                 int iSampleBlock)
+                    {
+                        return ProcessBlock(
+                            poJobBand,
+                            poMaskBand ? poJobBand->GetMaskBand() : nullptr,
+                            iSampleBlock,
+                            poMaskBand ? aabyJobMaskData[iJob].data()
+                                       : nullptr,
+                            aanJobHistogram[iJob].data());
+                    },
+                    pfnProgress, pProgressData, "Compute Histogram"))
+            {
+                return CE_Failure;
+            }
+
+            for (const auto &anJobHistogram : aanJobHistogram)
+            {
+                for (int i = 0; i < nBuckets; ++i)
+                    panHistogram[i] += anJobHistogram[i];
+            }
         }
+        else
+        {
+            GByte *pabyMaskData = nullptr;
+            if (poMaskBand)
+            {
+                pabyMaskData = static_cast<GByte *>(
+                    VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
+                if (!pabyMaskData)
+                {
+                    return CE_Failure;
+                }
+            }
 
-        CPLFree(pabyMaskData);
+            for (int iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+                 iSampleBlock += nSampleRate)
+            {
+                if (!pfnProgress(iSampleBlock /
+                                     static_cast<double>(nTotalBlocks),
+                                 "Compute Histogram", pProgressData))
+                {
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
+
+                if (!ProcessBlock(this, poMaskBand, iSampleBlock,
+                                  pabyMaskData, panHistogram))
+                {
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
+            }
+
+            CPLFree(pabyMaskData);
+        }
     }
 
     pfnProgress(1.0, "Compute Histogram", pProgressData);
@@ -5426,60 +5823,675 @@ struct ComputeStatisticsInternal<GUInt16, COMPUTE_OTHER_STATS>
 #endif  // CPL_HAS_GINT64
 
 /************************************************************************/
-/*                          GetPixelValue()                             */
+/*                            WelfordStats                              */
 /************************************************************************/
 
-static inline double GetPixelValue(GDALDataType eDataType, bool bSignedByte,
-                                   const void *pData, GPtrDiff_t iOffset,
-                                   bool bGotNoDataValue, double dfNoDataValue,
-                                   bool bGotFloatNoDataValue,
-                                   float fNoDataValue, bool &bValid)
+namespace
 {
-    bValid = true;
-    double dfValue = 0;
-    switch (eDataType)
+// Count, mean, sum of squared differences to the mean (M2), minimum and
+// maximum of a set of values.
+struct WelfordStats
+{
+    double dfMin = std::numeric_limits<double>::max();
+    double dfMax = -std::numeric_limits<double>::max();
+    double dfMean = 0.0;
+    double dfM2 = 0.0;
+    GUIntBig nSampleCount = 0;
+    GUIntBig nValidCount = 0;
+
+    // Merge with the statistics of another set, with the pairwise formula
+    // of Chan et al.
+    void Merge(const WelfordStats &other)
+    {
+        dfMin = std::min(dfMin, other.dfMin);
+        dfMax = std::max(dfMax, other.dfMax);
+        nSampleCount += other.nSampleCount;
+        if (other.nValidCount == 0)
+            return;
+        const GUIntBig nNewValidCount = nValidCount + other.nValidCount;
+        const double dfDelta = other.dfMean - dfMean;
+        const double dfOtherRatio =
+            static_cast<double>(other.nValidCount) / nNewValidCount;
+        dfMean += dfDelta * dfOtherRatio;
+        dfM2 += other.dfM2 + dfDelta * dfDelta * dfOtherRatio *
+                                 static_cast<double>(nValidCount);
+        nValidCount = nNewValidCount;
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*                  ComputeBlockStatisticsInternal()                    */
+/************************************************************************/
+
+// Statistics of the valid values of a block, for signed and floating-point
+// types, merged into sStats. The mean and M2 of the block are computed with
+// two passes, which is more accurate than a running update and has no
+// dependency between consecutive values.
+// If COMPUTE_OTHER_STATS is false, only the minimum and maximum are updated.
+
+template <class T> static inline bool IsValidStatsValue(T v, bool bHasNoData,
+                                                        T noDataValue)
+{
+    if constexpr (std::is_floating_point<T>::value)
     {
-        case GDT_Byte:
+        if (std::isnan(v))
+            return false;
+        return !(bHasNoData && ARE_REAL_EQUAL(v, noDataValue));
+    }
+    else
+    {
+        return !(bHasNoData && v == noDataValue);
+    }
+}
+
+template <class T, bool COMPUTE_OTHER_STATS>
+struct ComputeBlockStatisticsInternal
+{
+    static void f(const T *pData, int nXCheck, int nBlockXSize, int nYCheck,
+                  bool bHasNoData, T noDataValue, WelfordStats &sStats)
+    {
+        WelfordStats sBlockStats;
+        double dfSum = 0;
+        for (int iY = 0; iY < nYCheck; iY++)
         {
-            if (bSignedByte)
-                dfValue = static_cast<const signed char *>(pData)[iOffset];
-            else
-                dfValue = static_cast<const GByte *>(pData)[iOffset];
-            break;
+            const T *pLine = pData + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+            for (int iX = 0; iX < nXCheck; iX++)
+            {
+                const T v = pLine[iX];
+                if (!IsValidStatsValue(v, bHasNoData, noDataValue))
+                    continue;
+                const double dfValue = static_cast<double>(v);
+                sBlockStats.dfMin = std::min(sBlockStats.dfMin, dfValue);
+                sBlockStats.dfMax = std::max(sBlockStats.dfMax, dfValue);
+                if (COMPUTE_OTHER_STATS)
+                {
+                    dfSum += dfValue;
+                    sBlockStats.nValidCount++;
+                }
+            }
         }
-        case GDT_Int8:
-            dfValue = static_cast<const GInt8 *>(pData)[iOffset];
-            break;
-        case GDT_UInt16:
-            dfValue = static_cast<const GUInt16 *>(pData)[iOffset];
-            break;
-        case GDT_Int16:
-            dfValue = static_cast<const GInt16 *>(pData)[iOffset];
-            break;
-        case GDT_UInt32:
-            dfValue = static_cast<const GUInt32 *>(pData)[iOffset];
-            break;
-        case GDT_Int32:
-            dfValue = static_cast<const GInt32 *>(pData)[iOffset];
-            break;
-        case GDT_UInt64:
-            dfValue = static_cast<double>(
-                static_cast<const std::uint64_t *>(pData)[iOffset]);
-            break;
-        case GDT_Int64:
-            dfValue = static_cast<double>(
-                static_cast<const std::int64_t *>(pData)[iOffset]);
-            break;
-        case GDT_Float32:
+
+        if (COMPUTE_OTHER_STATS && sBlockStats.nValidCount > 0)
         {
-            const float fValue = static_cast<const float *>(pData)[iOffset];
-            if (CPLIsNan(fValue) ||
-                (bGotFloatNoDataValue && ARE_REAL_EQUAL(fValue, fNoDataValue)))
+            sBlockStats.dfMean = dfSum / sBlockStats.nValidCount;
+            for (int iY = 0; iY < nYCheck; iY++)
             {
-                bValid = false;
-                return 0.0;
+                const T *pLine =
+                    pData + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+                for (int iX = 0; iX < nXCheck; iX++)
+                {
+                    const T v = pLine[iX];
+                    if (!IsValidStatsValue(v, bHasNoData, noDataValue))
+                        continue;
+                    const double dfDelta =
+                        static_cast<double>(v) - sBlockStats.dfMean;
+                    sBlockStats.dfM2 += dfDelta * dfDelta;
+                }
             }
-            dfValue = fValue;
+        }
+        if (COMPUTE_OTHER_STATS)
+            sBlockStats.nSampleCount =
+                static_cast<GUIntBig>(nXCheck) * nYCheck;
+
+        sStats.Merge(sBlockStats);
+    }
+};
+
+#if defined(CPL_HAS_GINT64) &&                                                 \
+    (defined(__x86_64__) || defined(_M_X64)) &&                                \
+    (defined(__GNUC__) || defined(_MSC_VER))
+
+#include <emmintrin.h>
+
+template <bool COMPUTE_OTHER_STATS>
+struct ComputeBlockStatisticsInternal<float, COMPUTE_OTHER_STATS>
+{
+    static void f(const float *pData, int nXCheck, int nBlockXSize,
+                  int nYCheck, bool bHasNoData, float fNoDataValue,
+                  WelfordStats &sStats)
+    {
+        const __m128 noData = _mm_set1_ps(fNoDataValue);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        const __m128 epsilon =
+            _mm_set1_ps(std::numeric_limits<float>::epsilon());
+        const __m128 two = _mm_set1_ps(2.0f);
+        // All ones in the lanes that are neither NaN nor nodata, with the
+        // same tolerance as ARE_REAL_EQUAL()
+        const auto GetValidMask =
+            [bHasNoData, noData, absMask, epsilon, two](__m128 x)
+        {
+            __m128 valid = _mm_cmpord_ps(x, x);
+            if (bHasNoData)
+            {
+                const __m128 diff =
+                    _mm_and_ps(_mm_sub_ps(x, noData), absMask);
+                const __m128 tolerance = _mm_mul_ps(
+                    _mm_mul_ps(epsilon,
+                               _mm_and_ps(_mm_add_ps(x, noData), absMask)),
+                    two);
+                const __m128 equal = _mm_or_ps(_mm_cmpeq_ps(x, noData),
+                                               _mm_cmplt_ps(diff, tolerance));
+                valid = _mm_andnot_ps(equal, valid);
+            }
+            return valid;
+        };
+
+        const float fInf = std::numeric_limits<float>::infinity();
+        const __m128 posInf = _mm_set1_ps(fInf);
+        const __m128 negInf = _mm_set1_ps(-fInf);
+        __m128 minV = posInf;
+        __m128 maxV = negInf;
+        __m128d sum0 = _mm_setzero_pd();
+        __m128d sum1 = _mm_setzero_pd();
+        __m128i count = _mm_setzero_si128();
+        float fMin = fInf;
+        float fMax = -fInf;
+        double dfSum = 0;
+        GUIntBig nValidCount = 0;
+
+        for (int iY = 0; iY < nYCheck; iY++)
+        {
+            const float *pLine =
+                pData + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+            int iX = 0;
+            for (; iX + 4 <= nXCheck; iX += 4)
+            {
+                const __m128 x = _mm_loadu_ps(pLine + iX);
+                const __m128 valid = GetValidMask(x);
+                const __m128 xValid = _mm_and_ps(valid, x);
+                minV = _mm_min_ps(
+                    minV, _mm_or_ps(xValid, _mm_andnot_ps(valid, posInf)));
+                maxV = _mm_max_ps(
+                    maxV, _mm_or_ps(xValid, _mm_andnot_ps(valid, negInf)));
+                if (COMPUTE_OTHER_STATS)
+                {
+                    sum0 = _mm_add_pd(sum0, _mm_cvtps_pd(xValid));
+                    sum1 = _mm_add_pd(
+                        sum1, _mm_cvtps_pd(_mm_movehl_ps(xValid, xValid)));
+                    count = _mm_sub_epi32(count, _mm_castps_si128(valid));
+                }
+            }
+            for (; iX < nXCheck; iX++)
+            {
+                const float v = pLine[iX];
+                if (!IsValidStatsValue(v, bHasNoData, fNoDataValue))
+                    continue;
+                fMin = std::min(fMin, v);
+                fMax = std::max(fMax, v);
+                if (COMPUTE_OTHER_STATS)
+                {
+                    dfSum += v;
+                    nValidCount++;
+                }
+            }
+        }
+
+        float afMin[4], afMax[4];
+        _mm_storeu_ps(afMin, minV);
+        _mm_storeu_ps(afMax, maxV);
+        for (int i = 0; i < 4; ++i)
+        {
+            fMin = std::min(fMin, afMin[i]);
+            fMax = std::max(fMax, afMax[i]);
+        }
+
+        WelfordStats sBlockStats;
+        if (COMPUTE_OTHER_STATS)
+        {
+            double adfSum[2];
+            _mm_storeu_pd(adfSum, _mm_add_pd(sum0, sum1));
+            dfSum += adfSum[0] + adfSum[1];
+            int anCount[4];
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(anCount), count);
+            for (int i = 0; i < 4; ++i)
+                nValidCount += static_cast<GUInt32>(anCount[i]);
+            sBlockStats.nSampleCount =
+                static_cast<GUIntBig>(nXCheck) * nYCheck;
+            sBlockStats.nValidCount = nValidCount;
+        }
+        if (fMin <= fMax)
+        {
+            sBlockStats.dfMin = fMin;
+            sBlockStats.dfMax = fMax;
+        }
+
+        if (COMPUTE_OTHER_STATS && nValidCount > 0)
+        {
+            const double dfMean = dfSum / nValidCount;
+            const __m128d mean = _mm_set1_pd(dfMean);
+            __m128d m2_0 = _mm_setzero_pd();
+            __m128d m2_1 = _mm_setzero_pd();
+            double dfM2 = 0;
+            for (int iY = 0; iY < nYCheck; iY++)
+            {
+                const float *pLine =
+                    pData + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+                int iX = 0;
+                for (; iX + 4 <= nXCheck; iX += 4)
+                {
+                    const __m128 x = _mm_loadu_ps(pLine + iX);
+                    const __m128 valid = GetValidMask(x);
+                    // Widen the 32-bit masks to the 2 double lanes
+                    const __m128d valid0 =
+                        _mm_castps_pd(_mm_unpacklo_ps(valid, valid));
+                    const __m128d valid1 =
+                        _mm_castps_pd(_mm_unpackhi_ps(valid, valid));
+                    const __m128d d0 = _mm_and_pd(
+                        valid0, _mm_sub_pd(_mm_cvtps_pd(x), mean));
+                    const __m128d d1 = _mm_and_pd(
+                        valid1,
+                        _mm_sub_pd(_mm_cvtps_pd(_mm_movehl_ps(x, x)), mean));
+                    m2_0 = _mm_add_pd(m2_0, _mm_mul_pd(d0, d0));
+                    m2_1 = _mm_add_pd(m2_1, _mm_mul_pd(d1, d1));
+                }
+                for (; iX < nXCheck; iX++)
+                {
+                    const float v = pLine[iX];
+                    if (!IsValidStatsValue(v, bHasNoData, fNoDataValue))
+                        continue;
+                    const double dfDelta = v - dfMean;
+                    dfM2 += dfDelta * dfDelta;
+                }
+            }
+            double adfM2[2];
+            _mm_storeu_pd(adfM2, _mm_add_pd(m2_0, m2_1));
+            sBlockStats.dfMean = dfMean;
+            sBlockStats.dfM2 = dfM2 + adfM2[0] + adfM2[1];
+        }
+
+        sStats.Merge(sBlockStats);
+    }
+};
+
+template <bool COMPUTE_OTHER_STATS>
+struct ComputeBlockStatisticsInternal<double, COMPUTE_OTHER_STATS>
+{
+    static void f(const double *pData, int nXCheck, int nBlockXSize,
+                  int nYCheck, bool bHasNoData, double dfNoDataValue,
+                  WelfordStats &sStats)
+    {
+        const __m128d noData = _mm_set1_pd(dfNoDataValue);
+        const __m128d absMask =
+            _mm_castsi128_pd(_mm_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+        const __m128d epsilon = _mm_set1_pd(
+            static_cast<double>(std::numeric_limits<float>::epsilon()));
+        const __m128d two = _mm_set1_pd(2.0);
+        // All ones in the lanes that are neither NaN nor nodata, with the
+        // same tolerance as ARE_REAL_EQUAL()
+        const auto GetValidMask =
+            [bHasNoData, noData, absMask, epsilon, two](__m128d x)
+        {
+            __m128d valid = _mm_cmpord_pd(x, x);
+            if (bHasNoData)
+            {
+                const __m128d diff =
+                    _mm_and_pd(_mm_sub_pd(x, noData), absMask);
+                const __m128d tolerance = _mm_mul_pd(
+                    _mm_mul_pd(epsilon,
+                               _mm_and_pd(_mm_add_pd(x, noData), absMask)),
+                    two);
+                const __m128d equal = _mm_or_pd(_mm_cmpeq_pd(x, noData),
+                                                _mm_cmplt_pd(diff, tolerance));
+                valid = _mm_andnot_pd(equal, valid);
+            }
+            return valid;
+        };
+
+        const double dfInf = std::numeric_limits<double>::infinity();
+        const __m128d posInf = _mm_set1_pd(dfInf);
+        const __m128d negInf = _mm_set1_pd(-dfInf);
+        __m128d minV = posInf;
+        __m128d maxV = negInf;
+        __m128d sum = _mm_setzero_pd();
+        __m128i count = _mm_setzero_si128();
+        double dfMin = dfInf;
+        double dfMax = -dfInf;
+        double dfSum = 0;
+        GUIntBig nValidCount = 0;
+
+        for (int iY = 0; iY < nYCheck; iY++)
+        {
+            const double *pLine =
+                pData + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+            int iX = 0;
+            for (; iX + 2 <= nXCheck; iX += 2)
+            {
+                const __m128d x = _mm_loadu_pd(pLine + iX);
+                const __m128d valid = GetValidMask(x);
+                const __m128d xValid = _mm_and_pd(valid, x);
+                minV = _mm_min_pd(
+                    minV, _mm_or_pd(xValid, _mm_andnot_pd(valid, posInf)));
+                maxV = _mm_max_pd(
+                    maxV, _mm_or_pd(xValid, _mm_andnot_pd(valid, negInf)));
+                if (COMPUTE_OTHER_STATS)
+                {
+                    sum = _mm_add_pd(sum, xValid);
+                    count = _mm_sub_epi64(count, _mm_castpd_si128(valid));
+                }
+            }
+            for (; iX < nXCheck; iX++)
+            {
+                const double v = pLine[iX];
+                if (!IsValidStatsValue(v, bHasNoData, dfNoDataValue))
+                    continue;
+                dfMin = std::min(dfMin, v);
+                dfMax = std::max(dfMax, v);
+                if (COMPUTE_OTHER_STATS)
+                {
+                    dfSum += v;
+                    nValidCount++;
+                }
+            }
+        }
+
+        double adfMin[2], adfMax[2];
+        _mm_storeu_pd(adfMin, minV);
+        _mm_storeu_pd(adfMax, maxV);
+        dfMin = std::min(dfMin, std::min(adfMin[0], adfMin[1]));
+        dfMax = std::max(dfMax, std::max(adfMax[0], adfMax[1]));
+
+        WelfordStats sBlockStats;
+        if (COMPUTE_OTHER_STATS)
+        {
+            double adfSum[2];
+            _mm_storeu_pd(adfSum, sum);
+            dfSum += adfSum[0] + adfSum[1];
+            GInt64 anCount[2];
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(anCount), count);
+            nValidCount += static_cast<GUIntBig>(anCount[0] + anCount[1]);
+            sBlockStats.nSampleCount =
+                static_cast<GUIntBig>(nXCheck) * nYCheck;
+            sBlockStats.nValidCount = nValidCount;
+        }
+        if (dfMin <= dfMax)
+        {
+            sBlockStats.dfMin = dfMin;
+            sBlockStats.dfMax = dfMax;
+        }
+
+        if (COMPUTE_OTHER_STATS && nValidCount > 0)
+        {
+            const double dfMean = dfSum / nValidCount;
+            const __m128d mean = _mm_set1_pd(dfMean);
+            __m128d m2 = _mm_setzero_pd();
+            double dfM2 = 0;
+            for (int iY = 0; iY < nYCheck; iY++)
+            {
+                const double *pLine =
+                    pData + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+                int iX = 0;
+                for (; iX + 2 <= nXCheck; iX += 2)
+                {
+                    const __m128d x = _mm_loadu_pd(pLine + iX);
+                    const __m128d d =
+                        _mm_and_pd(GetValidMask(x), _mm_sub_pd(x, mean));
+                    m2 = _mm_add_pd(m2, _mm_mul_pd(d, d));
+                }
+                for (; iX < nXCheck; iX++)
+                {
+                    const double v = pLine[iX];
+                    if (!IsValidStatsValue(v, bHasNoData, dfNoDataValue))
+                        continue;
+                    const double dfDelta = v - dfMean;
+                    dfM2 += dfDelta * dfDelta;
+                }
+            }
+            double adfM2[2];
+            _mm_storeu_pd(adfM2, m2);
+            sBlockStats.dfMean = dfMean;
+            sBlockStats.dfM2 = dfM2 + adfM2[0] + adfM2[1];
+        }
+
+        sStats.Merge(sBlockStats);
+    }
+};
+
+template <bool COMPUTE_OTHER_STATS>
+struct ComputeBlockStatisticsInternal<GInt16, COMPUTE_OTHER_STATS>
+{
+    static void f(const GInt16 *pData, int nXCheck, int nBlockXSize,
+                  int nYCheck, bool bHasNoData, GInt16 nNoDataValue,
+                  WelfordStats &sStats)
+    {
+        const __m128i noData = _mm_set1_epi16(nNoDataValue);
+        const __m128i allOnes = _mm_set1_epi32(-1);
+        const __m128i ones = _mm_set1_epi16(1);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i maxInt16 =
+            _mm_set1_epi16(std::numeric_limits<GInt16>::max());
+        const __m128i minInt16 =
+            _mm_set1_epi16(std::numeric_limits<GInt16>::min());
+        __m128i minV = maxInt16;
+        __m128i maxV = minInt16;
+        int nMin = std::numeric_limits<GInt16>::max();
+        int nMax = std::numeric_limits<GInt16>::min();
+        // Exact integer sums, from which the mean and M2 are derived.
+        GInt64 nSum = 0;
+        GUIntBig nSumSquare = 0;
+        GUIntBig nValidCount = 0;
+
+        for (int iY = 0; iY < nYCheck; iY++)
+        {
+            const GInt16 *pLine =
+                pData + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+            int iX = 0;
+            while (iX + 8 <= nXCheck)
+            {
+                // Flush the 16 and 32-bit accumulators before they can
+                // overflow.
+                const int nIters = std::min((nXCheck - iX) / 8, 16384);
+                __m128i sum = zero;
+                __m128i sumSquare = zero;
+                __m128i count = zero;
+                for (int k = 0; k < nIters; ++k, iX += 8)
+                {
+                    const __m128i x = _mm_loadu_si128(
+                        reinterpret_cast<const __m128i *>(pLine + iX));
+                    const __m128i valid =
+                        bHasNoData
+                            ? _mm_xor_si128(_mm_cmpeq_epi16(x, noData), allOnes)
+                            : allOnes;
+                    const __m128i xValid = _mm_and_si128(x, valid);
+                    minV = _mm_min_epi16(
+                        minV, _mm_or_si128(xValid,
+                                          _mm_andnot_si128(valid, maxInt16)));
+                    maxV = _mm_max_epi16(
+                        maxV, _mm_or_si128(xValid,
+                                          _mm_andnot_si128(valid, minInt16)));
+                    if (COMPUTE_OTHER_STATS)
+                    {
+                        sum = _mm_add_epi32(sum, _mm_madd_epi16(xValid, ones));
+                        // Sums of 2 squares are at most 2^31: unsigned.
+                        const __m128i square = _mm_madd_epi16(xValid, xValid);
+                        sumSquare = _mm_add_epi64(
+                            sumSquare, _mm_unpacklo_epi32(square, zero));
+                        sumSquare = _mm_add_epi64(
+                            sumSquare, _mm_unpackhi_epi32(square, zero));
+                        count = _mm_sub_epi16(count, valid);
+                    }
+                }
+                if (COMPUTE_OTHER_STATS)
+                {
+                    int anSum[4], anCount[4];
+                    GUIntBig anSumSquare[2];
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(anSum), sum);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(anCount),
+                                     _mm_madd_epi16(count, ones));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(anSumSquare),
+                                     sumSquare);
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        nSum += anSum[i];
+                        nValidCount += anCount[i];
+                    }
+                    nSumSquare += anSumSquare[0] + anSumSquare[1];
+                }
+            }
+            for (; iX < nXCheck; iX++)
+            {
+                const GInt16 v = pLine[iX];
+                if (bHasNoData && v == nNoDataValue)
+                    continue;
+                nMin = std::min(nMin, static_cast<int>(v));
+                nMax = std::max(nMax, static_cast<int>(v));
+                if (COMPUTE_OTHER_STATS)
+                {
+                    nSum += v;
+                    nSumSquare += static_cast<GUIntBig>(v * v);
+                    nValidCount++;
+                }
+            }
+        }
+
+        GInt16 anMin[8], anMax[8];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(anMin), minV);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(anMax), maxV);
+        for (int i = 0; i < 8; ++i)
+        {
+            nMin = std::min(nMin, static_cast<int>(anMin[i]));
+            nMax = std::max(nMax, static_cast<int>(anMax[i]));
+        }
+
+        WelfordStats sBlockStats;
+        if (COMPUTE_OTHER_STATS)
+        {
+            sBlockStats.nSampleCount =
+                static_cast<GUIntBig>(nXCheck) * nYCheck;
+            sBlockStats.nValidCount = nValidCount;
+            if (nValidCount > 0)
+            {
+                sBlockStats.dfMean = static_cast<double>(nSum) / nValidCount;
+                // M2 = (n * sum(x^2) - sum(x)^2) / n, with an exact
+                // numerator.
+                const GUIntBig nAbsSum = static_cast<GUIntBig>(
+                    nSum >= 0 ? nSum : -nSum);
+                sBlockStats.dfM2 =
+                    static_cast<double>(
+                        GDALUInt128::Mul(nSumSquare, nValidCount) -
+                        GDALUInt128::Mul(nAbsSum, nAbsSum)) /
+                    nValidCount;
+            }
+        }
+        // The tail may have no valid value even if the vector part has some,
+        // and conversely: use the sentinels only if they were updated.
+        if (nMin <= nMax)
+        {
+            sBlockStats.dfMin = nMin;
+            sBlockStats.dfMax = nMax;
+        }
+
+        sStats.Merge(sBlockStats);
+    }
+};
+
+#endif
+// defined(CPL_HAS_GINT64) && (defined(__x86_64__) || defined(_M_X64)) &&
+// (defined(__GNUC__) || defined(_MSC_VER))
+
+/************************************************************************/
+/*                       ComputeBlockStatistics()                       */
+/************************************************************************/
+
+// Merge the statistics of the non-masked values of a block into sStats, with
+// the vectorized kernels for the types that have one.
+// Returns false, without doing anything, for the other types.
+template <bool COMPUTE_OTHER_STATS>
+static bool
+ComputeBlockStatistics(GDALDataType eDataType, const void *pData, int nXCheck,
+                       int nBlockXSize, int nYCheck, bool bGotNoDataValue,
+                       double dfNoDataValue, bool bGotFloatNoDataValue,
+                       float fNoDataValue, WelfordStats &sStats)
+{
+    switch (eDataType)
+    {
+        case GDT_Int16:
+        {
+            // At most one integer is equal to the nodata value within the
+            // tolerance of ARE_REAL_EQUAL().
+            const double dfRounded = std::round(dfNoDataValue);
+            const bool bHasNoData =
+                bGotNoDataValue && GDALIsValueInRange<GInt16>(dfRounded) &&
+                ARE_REAL_EQUAL(dfRounded, dfNoDataValue);
+            ComputeBlockStatisticsInternal<GInt16, COMPUTE_OTHER_STATS>::f(
+                static_cast<const GInt16 *>(pData), nXCheck, nBlockXSize,
+                nYCheck, bHasNoData,
+                bHasNoData ? static_cast<GInt16>(dfRounded) : 0, sStats);
+            return true;
+        }
+        case GDT_Float32:
+            // As in GetPixelValue(), only a nodata value that fits on a float
+            // is taken into account.
+            ComputeBlockStatisticsInternal<float, COMPUTE_OTHER_STATS>::f(
+                static_cast<const float *>(pData), nXCheck, nBlockXSize,
+                nYCheck, bGotFloatNoDataValue, fNoDataValue, sStats);
+            return true;
+        case GDT_Float64:
+            ComputeBlockStatisticsInternal<double, COMPUTE_OTHER_STATS>::f(
+                static_cast<const double *>(pData), nXCheck, nBlockXSize,
+                nYCheck, bGotNoDataValue, dfNoDataValue, sStats);
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                          GetPixelValue()                             */
+/************************************************************************/
+
+static inline double GetPixelValue(GDALDataType eDataType, bool bSignedByte,
+                                   const void *pData, GPtrDiff_t iOffset,
+                                   bool bGotNoDataValue, double dfNoDataValue,
+                                   bool bGotFloatNoDataValue,
+                                   float fNoDataValue, bool &bValid)
+{
+    bValid = true;
+    double dfValue = 0;
+    switch (eDataType)
+    {
+        case GDT_Byte:
+        {
+            if (bSignedByte)
+                dfValue = static_cast<const signed char *>(pData)[iOffset];
+            else
+                dfValue = static_cast<const GByte *>(pData)[iOffset];
+            break;
+        }
+        case GDT_Int8:
+            dfValue = static_cast<const GInt8 *>(pData)[iOffset];
+            break;
+        case GDT_UInt16:
+            dfValue = static_cast<const GUInt16 *>(pData)[iOffset];
+            break;
+        case GDT_Int16:
+            dfValue = static_cast<const GInt16 *>(pData)[iOffset];
+            break;
+        case GDT_UInt32:
+            dfValue = static_cast<const GUInt32 *>(pData)[iOffset];
+            break;
+        case GDT_Int32:
+            dfValue = static_cast<const GInt32 *>(pData)[iOffset];
+            break;
+        case GDT_UInt64:
+            dfValue = static_cast<double>(
+                static_cast<const std::uint64_t *>(pData)[iOffset]);
+            break;
+        case GDT_Int64:
+            dfValue = static_cast<double>(
+                static_cast<const std::int64_t *>(pData)[iOffset]);
+            break;
+        case GDT_Float32:
+        {
+            const float fValue = static_cast<const float *>(pData)[iOffset];
+            if (CPLIsNan(fValue) ||
+                (bGotFloatNoDataValue && ARE_REAL_EQUAL(fValue, fNoDataValue)))
+            {
+                bValid = false;
+                return 0.0;
+            }
+            dfValue = fValue;
             return dfValue;
         }
         case GDT_Float64:
@@ -5852,10 +6864,6 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                       static_cast<GUInt64>(nBlockYSize))))
         {
             const GUInt32 nMaxValueType = (eDataType == GDT_Byte) ? 255 : 65535;
-            GUInt32 nMin = nMaxValueType;
-            GUInt32 nMax = 0;
-            GUIntBig nSum = 0;
-            GUIntBig nSumSquare = 0;
             // If no valid nodata, map to invalid value (256 for Byte)
             const GUInt32 nNoDataValue =
                 (bGotNoDataValue && dfNoDataValue >= 0 &&
@@ -5865,22 +6873,34 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                     ? static_cast<GUInt32>(dfNoDataValue + 1e-10)
                     : nMaxValueType + 1;
 
-            for (int iSampleBlock = 0;
-                 iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
+            struct IntegerStats
+            {
+                GUInt32 nMin = 0;
+                GUInt32 nMax = 0;
+                GUIntBig nSum = 0;
+                GUIntBig nSumSquare = 0;
+                GUIntBig nSampleCount = 0;
+                GUIntBig nValidCount = 0;
+            };
+
+            const auto ProcessBlock =
+                [this, nMaxValueType, nNoDataValue](GDALRasterBand *poBlockBand,
+                                                    int iSampleBlock,
+                                                    IntegerStats &sStats)
             {
                 const int iYBlock = iSampleBlock / nBlocksPerRow;
                 const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
 
                 GDALRasterBlock *const poBlock =
-                    GetLockedBlockRef(iXBlock, iYBlock);
+                    poBlockBand->GetLockedBlockRef(iXBlock, iYBlock);
                 if (poBlock == nullptr)
-                    return CE_Failure;
+                    return false;
 
                 void *const pData = poBlock->GetDataRef();
 
                 int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+                poBlockBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck,
+                                                &nYCheck);
 
                 if (eDataType == GDT_Byte)
                 {
@@ -5888,8 +6908,10 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                         GByte, /* COMPUTE_OTHER_STATS = */ true>::
                         f(nXCheck, nBlockXSize, nYCheck,
                           static_cast<const GByte *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                          nNoDataValue <= nMaxValueType, nNoDataValue,
+                          sStats.nMin, sStats.nMax, sStats.nSum,
+                          sStats.nSumSquare, sStats.nSampleCount,
+                          sStats.nValidCount);
                 }
                 else
                 {
@@ -5897,23 +6919,75 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                         GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
                         f(nXCheck, nBlockXSize, nYCheck,
                           static_cast<const GUInt16 *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                          nNoDataValue <= nMaxValueType, nNoDataValue,
+                          sStats.nMin, sStats.nMax, sStats.nSum,
+                          sStats.nSumSquare, sStats.nSampleCount,
+                          sStats.nValidCount);
                 }
 
                 poBlock->DropLock();
+                return true;
+            };
 
-                if (!pfnProgress(iSampleBlock /
-                                     static_cast<double>(nBlocksPerRow *
-                                                         nBlocksPerColumn),
-                                 "Compute Statistics", pProgressData))
+            const int nTotalBlocks = nBlocksPerRow * nBlocksPerColumn;
+            IntegerStats sStats;
+            sStats.nMin = nMaxValueType;
+
+            GDALSampledBlocksInJobs oJobs(this, nTotalBlocks, nSampleRate);
+            if (oJobs.GetJobCount() > 0)
+            {
+                std::vector<IntegerStats> asJobStats(oJobs.GetJobCount(),
+                                                     sStats);
+                if (!oJobs.Run(
+                        [&ProcessBlock, &asJobStats](int iJob,
+                                                     GDALRasterBand *poJobBand,
+                                                     int iSampleBlock)
+                        {
+                            return ProcessBlock(poJobBand, iSampleBlock,
+                                                asJobStats[iJob]);
+                        },
+                        pfnProgress, pProgressData, "Compute Statistics"))
                 {
-                    ReportError(CE_Failure, CPLE_UserInterrupt,
-                                "User terminated");
                     return CE_Failure;
                 }
+
+                // Integer sums, so the merge is exact.
+                for (const auto &sJobStats : asJobStats)
+                {
+                    sStats.nMin = std::min(sStats.nMin, sJobStats.nMin);
+                    sStats.nMax = std::max(sStats.nMax, sJobStats.nMax);
+                    sStats.nSum += sJobStats.nSum;
+                    sStats.nSumSquare += sJobStats.nSumSquare;
+                    sStats.nSampleCount += sJobStats.nSampleCount;
+                    sStats.nValidCount += sJobStats.nValidCount;
+                }
+            }
+            else
+            {
+                for (int iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+                     iSampleBlock += nSampleRate)
+                {
+                    if (!ProcessBlock(this, iSampleBlock, sStats))
+                        return CE_Failure;
+
+                    if (!pfnProgress(iSampleBlock /
+                                         static_cast<double>(nTotalBlocks),
+                                     "Compute Statistics", pProgressData))
+                    {
+                        ReportError(CE_Failure, CPLE_UserInterrupt,
+                                    "User terminated");
+                        return CE_Failure;
+                    }
+                }
             }
 
+            const GUInt32 nMin = sStats.nMin;
+            const GUInt32 nMax = sStats.nMax;
+            const GUIntBig nSum = sStats.nSum;
+            const GUIntBig nSumSquare = sStats.nSumSquare;
+            nSampleCount = sStats.nSampleCount;
+            nValidCount = sStats.nValidCount;
+
             if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
             {
                 ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
@@ -5980,93 +7054,1047 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
         }
 #endif
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
+        const auto ProcessBlock =
+            [this, bSignedByte, bGotNoDataValue, dfNoDataValue,
+             bGotFloatNoDataValue,
+             fNoDataValue](GDALRasterBand *poBlockBand,
+                           GDALRasterBand *poBlockMaskBand, int iSampleBlock,
+                           GByte *pabyMaskData, WelfordStats &sStats)
         {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
+            const int iYBlock = iSampleBlock / nBlocksPerRow;
+            const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
+
+            GDALRasterBlock *const poBlock =
+                poBlockBand->GetLockedBlockRef(iXBlock, iYBlock);
+            if (poBlock == nullptr)
+                return false;
+
+            void *const pData = poBlock->GetDataRef();
+
+            int nXCheck = 0, nYCheck = 0;
+            poBlockBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck,
+                                            &nYCheck);
+
+            if (!poBlockMaskBand &&
+                ComputeBlockStatistics</* COMPUTE_OTHER_STATS = */ true>(
+                    eDataType, pData, nXCheck, nBlockXSize, nYCheck,
+                    CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
+                    bGotFloatNoDataValue, fNoDataValue, sStats))
+            {
+                poBlock->DropLock();
+                return true;
+            }
+
+            if (poBlockMaskBand &&
+                poBlockMaskBand->RasterIO(
+                    GF_Read, iXBlock * nBlockXSize, iYBlock * nBlockYSize,
+                    nXCheck, nYCheck, pabyMaskData, nXCheck, nYCheck, GDT_Byte,
+                    0, nBlockXSize, nullptr) != CE_None)
+            {
+                poBlock->DropLock();
+                return false;
+            }
+
+            // This isn't the fastest way to do this, but is easier for now.
+            for (int iY = 0; iY < nYCheck; iY++)
+            {
+                for (int iX = 0; iX < nXCheck; iX++)
+                {
+                    const GPtrDiff_t iOffset =
+                        iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+                    if (pabyMaskData && pabyMaskData[iOffset] == 0)
+                        continue;
+
+                    bool bValid = true;
+                    double dfValue = GetPixelValue(
+                        eDataType, bSignedByte, pData, iOffset,
+                        CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
+                        bGotFloatNoDataValue, fNoDataValue, bValid);
+
+                    if (!bValid)
+                        continue;
+
+                    sStats.dfMin = std::min(sStats.dfMin, dfValue);
+                    sStats.dfMax = std::max(sStats.dfMax, dfValue);
+
+                    sStats.nValidCount++;
+                    const double dfDelta = dfValue - sStats.dfMean;
+                    sStats.dfMean += dfDelta / sStats.nValidCount;
+                    sStats.dfM2 += dfDelta * (dfValue - sStats.dfMean);
+                }
+            }
+
+            sStats.nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+
+            poBlock->DropLock();
+            return true;
+        };
+
+        const int nTotalBlocks = nBlocksPerRow * nBlocksPerColumn;
+        WelfordStats sStats;
+
+        GDALSampledBlocksInJobs oJobs(this, nTotalBlocks, nSampleRate);
+        const int nJobs = oJobs.GetJobCount();
+        if (nJobs > 0)
+        {
+            std::vector<WelfordStats> asJobStats(nJobs);
+            std::vector<std::vector<GByte>> aabyJobMaskData;
+            if (poMaskBand)
+            {
+                try
+                {
+                    aabyJobMaskData.resize(
+                        nJobs, std::vector<GByte>(
+                                   static_cast<size_t>(nBlockXSize) *
+                                   nBlockYSize));
+                }
+                catch (const std::bad_alloc &)
+                {
+                    ReportError(CE_Failure, CPLE_OutOfMemory,
+                                "Out of memory in ComputeStatistics()");
+                    return CE_Failure;
+                }
+            }
+
+            if (!oJobs.Run(
+                    [&ProcessBlock, &asJobStats, &aabyJobMaskData,
+                     poMaskBand](int iJob, GDALRasterBand *poJobBand,
+                                 int iSampleBlock)
+                    {
+                        return ProcessBlock(
+                            poJobBand,
+                            poMaskBand ? poJobBand->GetMaskBand() : nullptr,
+                            iSampleBlock,
+                            poMaskBand ? aabyJobMaskData[iJob].data()
+                                       : nullptr,
+                            asJobStats[iJob]);
+                    },
+                    pfnProgress, pProgressData, "Compute Statistics"))
+            {
+                return CE_Failure;
+            }
+
+            // Merge the per-job accumulators in job order, so that the
+            // result does not depend on the scheduling.
+            for (const auto &sJobStats : asJobStats)
+                sStats.Merge(sJobStats);
+        }
+        else
+        {
+            GByte *pabyMaskData = nullptr;
+            if (poMaskBand)
+            {
+                pabyMaskData = static_cast<GByte *>(
+                    VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
+                if (!pabyMaskData)
+                {
+                    return CE_Failure;
+                }
+            }
+
+            for (int iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+                 iSampleBlock += nSampleRate)
+            {
+                if (!ProcessBlock(this, poMaskBand, iSampleBlock,
+                                  pabyMaskData, sStats))
+                {
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
+
+                if (!pfnProgress(iSampleBlock /
+                                     static_cast<double>(nTotalBlocks),
+                                 "Compute Statistics", pProgressData))
+                {
+                    ReportError(CE_Failure, CPLE_UserInterrupt,
+                                "User terminated");
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
+            }
+
+            CPLFree(pabyMaskData);
+        }
+
+        dfMin = sStats.dfMin;
+        dfMax = sStats.dfMax;
+        dfMean = sStats.dfMean;
+        dfM2 = sStats.dfM2;
+        nSampleCount = sStats.nSampleCount;
+        nValidCount = sStats.nValidCount;
+    }
+
+    if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
+    {
+        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Save computed information.                                      */
+    /* -------------------------------------------------------------------- */
+    const double dfStdDev = nValidCount > 0 ? sqrt(dfM2 / nValidCount) : 0.0;
+
+    if (nValidCount > 0)
+    {
+        if (bApproxOK)
+        {
+            SetMetadataItem("STATISTICS_APPROXIMATE", "YES");
+        }
+        else if (GetMetadataItem("STATISTICS_APPROXIMATE"))
+        {
+            SetMetadataItem("STATISTICS_APPROXIMATE", nullptr);
+        }
+        SetStatistics(dfMin, dfMax, dfMean, dfStdDev);
+    }
+    else
+    {
+        dfMin = 0.0;
+        dfMax = 0.0;
+    }
+
+    SetValidPercent(nSampleCount, nValidCount);
+
+    /* -------------------------------------------------------------------- */
+    /*      Record results.                                                 */
+    /* -------------------------------------------------------------------- */
+    if (pdfMin != nullptr)
+        *pdfMin = dfMin;
+    if (pdfMax != nullptr)
+        *pdfMax = dfMax;
+
+    if (pdfMean != nullptr)
+        *pdfMean = dfMean;
+
+    if (pdfStdDev != nullptr)
+        *pdfStdDev = dfStdDev;
+
+    if (nValidCount > 0)
+        return CE_None;
+
+    ReportError(
+        CE_Failure, CPLE_AppDefined,
+        "Failed to compute statistics, no valid pixels found in sampling.");
+    return CE_Failure;
+}
+
+/************************************************************************/
+/*                    GDALComputeRasterStatistics()                     */
+/************************************************************************/
+
+/**
+ * \brief Compute image statistics.
+ *
+ * @see GDALRasterBand::ComputeStatistics()
+ */
+
+CPLErr CPL_STDCALL GDALComputeRasterStatistics(GDALRasterBandH hBand,
+                                               int bApproxOK, double *pdfMin,
+                                               double *pdfMax, double *pdfMean,
+                                               double *pdfStdDev,
+                                               GDALProgressFunc pfnProgress,
+                                               void *pProgressData)
+
+{
+    VALIDATE_POINTER1(hBand, "GDALComputeRasterStatistics", CE_Failure);
+
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+
+    return poBand->ComputeStatistics(bApproxOK, pdfMin, pdfMax, pdfMean,
+                                     pdfStdDev, pfnProgress, pProgressData);
+}
+
+/************************************************************************/
+/*                             GDALTDigest                              */
+/************************************************************************/
+
+namespace
+{
+// Merging t-digest (Dunning & Ertl, "Computing extremely accurate quantiles
+// using t-digests", 2019) with the k1 scale function. It summarizes a stream
+// of values with a number of centroids of the order of the compression
+// factor, the centroids being smaller close to the tails so that extreme
+// quantiles are more accurate than central ones.
+class GDALTDigest
+{
+  public:
+    explicit GDALTDigest(double dfCompression = 200.0)
+        : m_dfCompression(dfCompression)
+    {
+    }
+
+    void Add(double dfValue)
+    {
+        m_dfMin = std::min(m_dfMin, dfValue);
+        m_dfMax = std::max(m_dfMax, dfValue);
+        m_asBuffer.push_back(Centroid{dfValue, 1.0});
+        if (m_asBuffer.size() >= BUFFER_SIZE)
+            Compress();
+    }
+
+    void Merge(const GDALTDigest &other);
+
+    //! Value below which a fraction dfQ of the values lies.
+    double Quantile(double dfQ);
+
+    //! Fraction of the values below dfValue.
+    double CDF(double dfValue);
+
+  private:
+    struct Centroid
+    {
+        double dfMean;
+        double dfWeight;
+
+        bool operator<(const Centroid &other) const
+        {
+            return dfMean < other.dfMean;
+        }
+    };
+
+    static constexpr size_t BUFFER_SIZE = 4096;
+
+    double m_dfCompression;
+    double m_dfTotalWeight = 0.0;
+    double m_dfMin = std::numeric_limits<double>::infinity();
+    double m_dfMax = -std::numeric_limits<double>::infinity();
+    std::vector<Centroid> m_asCentroids{};
+    std::vector<Centroid> m_asBuffer{};
+
+    void Compress();
+    double NextQLimit(double dfQ) const;
+};
+}  // namespace
+
+// Returns the quantile at which the k1 scale function has increased by one
+// from dfQ, that is the upper limit of a centroid starting at dfQ.
+double GDALTDigest::NextQLimit(double dfQ) const
+{
+    const double dfAngle = asin(std::min(1.0, 2 * dfQ - 1)) +
+                           2 * M_PI / m_dfCompression;
+    if (dfAngle >= M_PI / 2)
+        return 1.0;
+    return (sin(dfAngle) + 1) / 2;
+}
+
+// Merges the buffered values with the centroids.
+void GDALTDigest::Compress()
+{
+    if (m_asBuffer.empty())
+        return;
+
+    for (const auto &sCentroid : m_asBuffer)
+        m_dfTotalWeight += sCentroid.dfWeight;
+    m_asBuffer.insert(m_asBuffer.end(), m_asCentroids.begin(),
+                      m_asCentroids.end());
+    std::sort(m_asBuffer.begin(), m_asBuffer.end());
+
+    m_asCentroids.clear();
+    m_asCentroids.push_back(m_asBuffer[0]);
+    double dfWeightSoFar = 0.0;
+    double dfWeightLimit = m_dfTotalWeight * NextQLimit(0.0);
+    for (size_t i = 1; i < m_asBuffer.size(); ++i)
+    {
+        const Centroid &sNext = m_asBuffer[i];
+        Centroid &sLast = m_asCentroids.back();
+        if (dfWeightSoFar + sLast.dfWeight + sNext.dfWeight <= dfWeightLimit)
+        {
+            sLast.dfWeight += sNext.dfWeight;
+            sLast.dfMean += (sNext.dfMean - sLast.dfMean) * sNext.dfWeight /
+                            sLast.dfWeight;
+        }
+        else
+        {
+            dfWeightSoFar += sLast.dfWeight;
+            dfWeightLimit = m_dfTotalWeight *
+                            NextQLimit(dfWeightSoFar / m_dfTotalWeight);
+            m_asCentroids.push_back(sNext);
+        }
+    }
+    m_asBuffer.clear();
+}
+
+void GDALTDigest::Merge(const GDALTDigest &other)
+{
+    m_dfMin = std::min(m_dfMin, other.m_dfMin);
+    m_dfMax = std::max(m_dfMax, other.m_dfMax);
+    m_asBuffer.insert(m_asBuffer.end(), other.m_asCentroids.begin(),
+                      other.m_asCentroids.end());
+    m_asBuffer.insert(m_asBuffer.end(), other.m_asBuffer.begin(),
+                      other.m_asBuffer.end());
+    Compress();
+}
+
+// Each centroid is considered to be located at the middle of its cumulated
+// weight, and values are linearly interpolated between the centers of
+// consecutive centroids, and between the extreme centroids and the minimum
+// and maximum.
+
+double GDALTDigest::Quantile(double dfQ)
+{
+    Compress();
+    if (m_asCentroids.empty())
+        return std::numeric_limits<double>::quiet_NaN();
+    if (dfQ <= 0)
+        return m_dfMin;
+    if (dfQ >= 1)
+        return m_dfMax;
+    if (m_asCentroids.size() == 1)
+        return m_asCentroids[0].dfMean;
+
+    const double dfIndex = dfQ * m_dfTotalWeight;
+    const Centroid &sFirst = m_asCentroids.front();
+    if (dfIndex < sFirst.dfWeight / 2)
+    {
+        return m_dfMin +
+               (sFirst.dfMean - m_dfMin) * dfIndex / (sFirst.dfWeight / 2);
+    }
+    double dfWeightSoFar = sFirst.dfWeight / 2;
+    for (size_t i = 0; i + 1 < m_asCentroids.size(); ++i)
+    {
+        const Centroid &sCur = m_asCentroids[i];
+        const Centroid &sNext = m_asCentroids[i + 1];
+        const double dfDist = (sCur.dfWeight + sNext.dfWeight) / 2;
+        if (dfIndex < dfWeightSoFar + dfDist)
+        {
+            return sCur.dfMean + (sNext.dfMean - sCur.dfMean) *
+                                     (dfIndex - dfWeightSoFar) / dfDist;
+        }
+        dfWeightSoFar += dfDist;
+    }
+    const Centroid &sLast = m_asCentroids.back();
+    return std::min(m_dfMax, sLast.dfMean + (m_dfMax - sLast.dfMean) *
+                                                (dfIndex - dfWeightSoFar) /
+                                                (sLast.dfWeight / 2));
+}
+
+double GDALTDigest::CDF(double dfValue)
+{
+    Compress();
+    if (m_asCentroids.empty())
+        return std::numeric_limits<double>::quiet_NaN();
+    if (dfValue < m_dfMin)
+        return 0.0;
+    if (dfValue >= m_dfMax)
+        return 1.0;
+
+    const Centroid &sFirst = m_asCentroids.front();
+    if (dfValue < sFirst.dfMean)
+    {
+        return sFirst.dfWeight / 2 * (dfValue - m_dfMin) /
+               (sFirst.dfMean - m_dfMin) / m_dfTotalWeight;
+    }
+    double dfWeightSoFar = sFirst.dfWeight / 2;
+    for (size_t i = 0; i + 1 < m_asCentroids.size(); ++i)
+    {
+        const Centroid &sCur = m_asCentroids[i];
+        const Centroid &sNext = m_asCentroids[i + 1];
+        const double dfDist = (sCur.dfWeight + sNext.dfWeight) / 2;
+        if (dfValue < sNext.dfMean)
+        {
+            return (dfWeightSoFar + dfDist * (dfValue - sCur.dfMean) /
+                                        (sNext.dfMean - sCur.dfMean)) /
+                   m_dfTotalWeight;
+        }
+        dfWeightSoFar += dfDist;
+    }
+    const Centroid &sLast = m_asCentroids.back();
+    return (dfWeightSoFar + sLast.dfWeight / 2 * (dfValue - sLast.dfMean) /
+                                (m_dfMax - sLast.dfMean)) /
+           m_dfTotalWeight;
+}
+
+/************************************************************************/
+/*                 ComputeStatisticsAndHistogram()                      */
+/************************************************************************/
+
+namespace
+{
+// Accumulators of ComputeStatisticsAndHistogram(), one per job when the
+// blocks are processed in parallel.
+struct StatisticsAndHistogramAccumulator
+{
+    WelfordStats sStats{};
+    // Number of occurrences of each value, for 8 and 16 bit integer types,
+    // indexed by the value minus the smallest value of the data type.
+    std::vector<GUIntBig> anValueCounts{};
+    // Histogram on the bounds requested by the caller, if any.
+    std::vector<GUIntBig> anHistogram{};
+    // Quantile sketch, for the other data types.
+    GDALTDigest oDigest{};
+    // Valid values of the current block.
+    std::vector<double> adfValues{};
+
+    void Merge(const StatisticsAndHistogramAccumulator &other)
+    {
+        sStats.Merge(other.sStats);
+        for (size_t i = 0; i < anValueCounts.size(); ++i)
+            anValueCounts[i] += other.anValueCounts[i];
+        for (size_t i = 0; i < anHistogram.size(); ++i)
+            anHistogram[i] += other.anHistogram[i];
+        if (anValueCounts.empty())
+            oDigest.Merge(other.oDigest);
+    }
+};
+}  // namespace
+
+/**
+ * \brief Compute image statistics, histogram and quantiles in a single pass.
+ *
+ * This method computes in a single read of the pixel values what would
+ * otherwise require calling ComputeStatistics(), GetHistogram() and
+ * sorting all values: the minimum, maximum, mean and standard deviation,
+ * the number of valid pixels, a histogram and a set of quantiles.
+ *
+ * If *pnBuckets is strictly positive and *pdfHistMin is lower than
+ * *pdfHistMax, the histogram is computed on those bounds, with out of range
+ * values counted in the first and last buckets. Otherwise it is computed on
+ * the same 256 buckets as GetDefaultHistogram(), and the bounds are
+ * returned into *pdfHistMin and *pdfHistMax.
+ *
+ * For the GDT_Byte, GDT_Int8, GDT_UInt16 and GDT_Int16 data types, the
+ * number of occurrences of each value is collected, which makes the default
+ * histogram and the quantiles exact. Quantiles are then the smallest value
+ * whose rank is at least ceil(q * count). For the other data types, the
+ * quantiles and the default histogram are estimated from a t-digest, whose
+ * error is the highest for central quantiles and is typically lower than
+ * 0.1% of the count in rank.
+ *
+ * The results are set back on the raster band with SetStatistics(),
+ * SetDefaultHistogram() and STATISTICS_VALID_PERCENT and
+ * STATISTICS_QUANTILE_{q} metadata items, so that they are saved in the
+ * .aux.xml side car file for formats relying on GDALPamRasterBand.
+ *
+ * This method is the same as the C function
+ * GDALComputeRasterStatisticsAndHistogram().
+ *
+ * @param bApproxOK If TRUE, the computation may be based on overviews
+ * or a subset of all tiles.
+ * @param pdfMin Location into which to load image minimum (may be NULL).
+ * @param pdfMax Location into which to load image maximum (may be NULL).
+ * @param pdfMean Location into which to load image mean (may be NULL).
+ * @param pdfStdDev Location into which to load image standard deviation
+ * (may be NULL).
+ * @param pnValidCount Location into which to load the number of valid pixels
+ * that have been processed (may be NULL).
+ * @param pdfHistMin Lower bound of the histogram (may be NULL).
+ * @param pdfHistMax Upper bound of the histogram (may be NULL).
+ * @param pnBuckets Number of buckets of the histogram (may be NULL).
+ * @param ppanHistogram Location into which to load the histogram, to free with
+ * VSIFree() (may be NULL).
+ * @param nQuantiles Number of quantiles to compute.
+ * @param padfQuantiles Quantiles to compute, in the [0, 1] range.
+ * @param padfQuantileValues Array of nQuantiles values into which to load the
+ * values of the quantiles.
+ * @param pfnProgress a function to call to report progress, or NULL.
+ * @param pProgressData application data to pass to the progress function.
+ *
+ * @return CE_None on success, or CE_Failure if an error occurs or processing
+ * is terminated by the user.
+ *
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALRasterBand::ComputeStatisticsAndHistogram(
+    int bApproxOK, double *pdfMin, double *pdfMax, double *pdfMean,
+    double *pdfStdDev, GUIntBig *pnValidCount, double *pdfHistMin,
+    double *pdfHistMax, int *pnBuckets, GUIntBig **ppanHistogram,
+    int nQuantiles, const double *padfQuantiles, double *padfQuantileValues,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+
+{
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+    if (ppanHistogram)
+        *ppanHistogram = nullptr;
+
+    for (int i = 0; i < nQuantiles; ++i)
+    {
+        if (!(padfQuantiles[i] >= 0 && padfQuantiles[i] <= 1))
+        {
+            ReportError(CE_Failure, CPLE_IllegalArg,
+                        "Quantile %g is not in the [0, 1] range",
+                        padfQuantiles[i]);
+            return CE_Failure;
+        }
+    }
+
+    const bool bFixedHistogramBounds =
+        pnBuckets && *pnBuckets > 0 && pdfHistMin && pdfHistMax &&
+        *pdfHistMin < *pdfHistMax &&
+        std::isfinite(*pnBuckets / (*pdfHistMax - *pdfHistMin));
+    const int nBuckets = bFixedHistogramBounds ? *pnBuckets : 256;
+    double dfHistMin = bFixedHistogramBounds ? *pdfHistMin : 0.0;
+    double dfHistMax = bFixedHistogramBounds ? *pdfHistMax : 0.0;
+
+    double dfMin = 0.0;
+    double dfMax = 0.0;
+    double dfMean = 0.0;
+    double dfStdDev = 0.0;
+    GUIntBig nValidCount = 0;
+    GUIntBig *panHistogram = nullptr;
+    std::vector<double> adfQuantileValues(nQuantiles);
+
+    // Sets the results on the band and returns them.
+    const auto StoreResults = [&](bool bApproximate)
+    {
+        if (bApproximate)
+        {
+            SetMetadataItem("STATISTICS_APPROXIMATE", "YES");
+        }
+        else if (GetMetadataItem("STATISTICS_APPROXIMATE"))
+        {
+            SetMetadataItem("STATISTICS_APPROXIMATE", nullptr);
+        }
+        SetStatistics(dfMin, dfMax, dfMean, dfStdDev);
+
+        char szValue[128] = {0};
+        for (int i = 0; i < nQuantiles; ++i)
+        {
+            CPLsnprintf(szValue, sizeof(szValue), "%.14g",
+                        adfQuantileValues[i]);
+            SetMetadataItem(
+                CPLSPrintf("STATISTICS_QUANTILE_%g", padfQuantiles[i]),
+                szValue);
+        }
+
+        // Not all drivers can store a default histogram: that must not
+        // prevent the other results from being returned.
+        const int nSavedMOFlags = GetMOFlags();
+        SetMOFlags(nSavedMOFlags | GMO_IGNORE_UNIMPLEMENTED);
+        SetDefaultHistogram(dfHistMin, dfHistMax, nBuckets, panHistogram);
+        SetMOFlags(nSavedMOFlags);
+
+        if (pdfMin)
+            *pdfMin = dfMin;
+        if (pdfMax)
+            *pdfMax = dfMax;
+        if (pdfMean)
+            *pdfMean = dfMean;
+        if (pdfStdDev)
+            *pdfStdDev = dfStdDev;
+        if (pnValidCount)
+            *pnValidCount = nValidCount;
+        if (pdfHistMin)
+            *pdfHistMin = dfHistMin;
+        if (pdfHistMax)
+            *pdfHistMax = dfHistMax;
+        if (pnBuckets)
+            *pnBuckets = nBuckets;
+        if (ppanHistogram)
+            *ppanHistogram = panHistogram;
+        else
+            VSIFree(panHistogram);
+        for (int i = 0; i < nQuantiles; ++i)
+            padfQuantileValues[i] = adfQuantileValues[i];
+    };
+
+    /* -------------------------------------------------------------------- */
+    /*      If we have overview bands, use them.                            */
+    /* -------------------------------------------------------------------- */
+    if (bApproxOK && GetOverviewCount() > 0 && !HasArbitraryOverviews())
+    {
+        GDALRasterBand *poBand =
+            GetRasterSampleOverview(GDALSTAT_APPROX_NUMSAMPLES);
+
+        if (poBand != this)
+        {
+            int nOvrBuckets = bFixedHistogramBounds ? nBuckets : 0;
+            const CPLErr eErr = poBand->ComputeStatisticsAndHistogram(
+                FALSE, &dfMin, &dfMax, &dfMean, &dfStdDev, &nValidCount,
+                &dfHistMin, &dfHistMax, &nOvrBuckets, &panHistogram,
+                nQuantiles, padfQuantiles, adfQuantileValues.data(),
+                pfnProgress, pProgressData);
+            if (eErr == CE_None)
+            {
+                StoreResults(true);
+
+                /* transfer metadata from overview band to this */
+                const char *pszPercentValid =
+                    poBand->GetMetadataItem("STATISTICS_VALID_PERCENT");
+
+                if (pszPercentValid != nullptr)
+                {
+                    SetMetadataItem("STATISTICS_VALID_PERCENT",
+                                    pszPercentValid);
+                }
+            }
+            return eErr;
+        }
+    }
+
+    if (!pfnProgress(0.0, "Compute Statistics", pProgressData))
+    {
+        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    int bGotNoDataValue = FALSE;
+    const double dfNoDataValue = GetNoDataValue(&bGotNoDataValue);
+    bGotNoDataValue = bGotNoDataValue && !CPLIsNan(dfNoDataValue);
+    bool bGotFloatNoDataValue = false;
+    float fNoDataValue = 0.0f;
+    ComputeFloatNoDataValue(eDataType, dfNoDataValue, bGotNoDataValue,
+                            fNoDataValue, bGotFloatNoDataValue);
+
+    GDALRasterBand *poMaskBand = nullptr;
+    if (!bGotNoDataValue)
+    {
+        const int l_nMaskFlags = GetMaskFlags();
+        if (l_nMaskFlags != GMF_ALL_VALID && l_nMaskFlags != GMF_NODATA &&
+            GetColorInterpretation() != GCI_AlphaBand)
+        {
+            poMaskBand = GetMaskBand();
+        }
+    }
+
+    bool bSignedByte = false;
+    if (eDataType == GDT_Byte)
+    {
+        EnablePixelTypeSignedByteWarning(false);
+        const char *pszPixelType =
+            GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+        EnablePixelTypeSignedByteWarning(true);
+        bSignedByte =
+            pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+    }
+
+    // Range of the values of the data types for which the number of
+    // occurrences of each value is collected.
+    int nCountedValueMin = 0;
+    int nCountedValues = 0;
+    switch (eDataType)
+    {
+        case GDT_Byte:
+            nCountedValueMin = bSignedByte ? -128 : 0;
+            nCountedValues = 256;
+            break;
+        case GDT_Int8:
+            nCountedValueMin = -128;
+            nCountedValues = 256;
+            break;
+        case GDT_UInt16:
+            nCountedValues = 65536;
+            break;
+        case GDT_Int16:
+            nCountedValueMin = -32768;
+            nCountedValues = 65536;
+            break;
+        default:
+            break;
+    }
+
+    const double dfScale =
+        bFixedHistogramBounds ? nBuckets / (dfHistMax - dfHistMin) : 0.0;
+
+    const auto InitAccumulator =
+        [nCountedValues, bFixedHistogramBounds,
+         nBuckets](StatisticsAndHistogramAccumulator &sAcc)
+    {
+        sAcc.anValueCounts.resize(nCountedValues);
+        if (bFixedHistogramBounds)
+            sAcc.anHistogram.resize(nBuckets);
+    };
+
+    // Add the values of a buffer to sAcc.
+    const auto AddValues =
+        [this, bSignedByte, bGotNoDataValue, dfNoDataValue,
+         bGotFloatNoDataValue, fNoDataValue, nCountedValueMin, dfHistMin,
+         dfScale, nBuckets](const void *pData, const GByte *pabyMaskData,
+                            int nXCheck, int nYCheck, int nLineStride,
+                            StatisticsAndHistogramAccumulator &sAcc)
+    {
+        auto &adfValues = sAcc.adfValues;
+        adfValues.clear();
+        for (int iY = 0; iY < nYCheck; iY++)
+        {
+            for (int iX = 0; iX < nXCheck; iX++)
+            {
+                const GPtrDiff_t iOffset =
+                    iX + static_cast<GPtrDiff_t>(iY) * nLineStride;
+                if (pabyMaskData && pabyMaskData[iOffset] == 0)
+                    continue;
+
+                bool bValid = true;
+                const double dfValue = GetPixelValue(
+                    eDataType, bSignedByte, pData, iOffset,
+                    CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
+                    bGotFloatNoDataValue, fNoDataValue, bValid);
+                if (bValid)
+                    adfValues.push_back(dfValue);
+            }
+        }
+
+        sAcc.sStats.nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+        if (adfValues.empty())
+            return;
+
+        // Two-pass statistics of the buffer, merged into the accumulator.
+        WelfordStats sBufferStats;
+        double dfSum = 0.0;
+        for (const double dfValue : adfValues)
+        {
+            sBufferStats.dfMin = std::min(sBufferStats.dfMin, dfValue);
+            sBufferStats.dfMax = std::max(sBufferStats.dfMax, dfValue);
+            dfSum += dfValue;
+        }
+        sBufferStats.nValidCount = adfValues.size();
+        sBufferStats.dfMean = dfSum / adfValues.size();
+        for (const double dfValue : adfValues)
+        {
+            const double dfDelta = dfValue - sBufferStats.dfMean;
+            sBufferStats.dfM2 += dfDelta * dfDelta;
+        }
+        sAcc.sStats.Merge(sBufferStats);
+
+        if (!sAcc.anValueCounts.empty())
+        {
+            for (const double dfValue : adfValues)
+            {
+                ++sAcc.anValueCounts[static_cast<int>(dfValue) -
+                                     nCountedValueMin];
+            }
+        }
+        else
+        {
+            for (const double dfValue : adfValues)
+                sAcc.oDigest.Add(dfValue);
+        }
+
+        if (!sAcc.anHistogram.empty())
+        {
+            for (const double dfValue : adfValues)
+            {
+                const double dfIndex = floor((dfValue - dfHistMin) * dfScale);
+                if (dfIndex < 0)
+                    ++sAcc.anHistogram[0];
+                else if (dfIndex >= nBuckets)
+                    ++sAcc.anHistogram[nBuckets - 1];
+                else
+                    ++sAcc.anHistogram[static_cast<int>(dfIndex)];
+            }
+        }
+    };
+
+    StatisticsAndHistogramAccumulator sAcc;
+    try
+    {
+        InitAccumulator(sAcc);
+    }
+    catch (const std::bad_alloc &)
+    {
+        ReportError(CE_Failure, CPLE_OutOfMemory,
+                    "Out of memory in ComputeStatisticsAndHistogram()");
+        return CE_Failure;
+    }
+
+    if (bApproxOK && HasArbitraryOverviews())
+    {
+        /* --------------------------------------------------------------------
+         */
+        /*      Figure out how much the image should be reduced to get an */
+        /*      approximate value. */
+        /* --------------------------------------------------------------------
+         */
+        double dfReduction = sqrt(static_cast<double>(nRasterXSize) *
+                                  nRasterYSize / GDALSTAT_APPROX_NUMSAMPLES);
+
+        int nXReduced = nRasterXSize;
+        int nYReduced = nRasterYSize;
+        if (dfReduction > 1.0)
+        {
+            nXReduced =
+                std::max(1, static_cast<int>(nRasterXSize / dfReduction));
+            nYReduced =
+                std::max(1, static_cast<int>(nRasterYSize / dfReduction));
+        }
+
+        void *pData = VSI_MALLOC3_VERBOSE(GDALGetDataTypeSizeBytes(eDataType),
+                                          nXReduced, nYReduced);
+        if (!pData)
+            return CE_Failure;
+
+        GDALRasterIOExtraArg sExtraArg;
+        INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+        const CPLErr eErr =
+            IRasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize, pData,
+                      nXReduced, nYReduced, eDataType, 0, 0, &sExtraArg);
+        if (eErr != CE_None)
+        {
+            CPLFree(pData);
+            return eErr;
+        }
+
+        GByte *pabyMaskData = nullptr;
+        if (poMaskBand)
+        {
+            pabyMaskData =
+                static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXReduced, nYReduced));
+            if (!pabyMaskData ||
+                poMaskBand->RasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize,
+                                     pabyMaskData, nXReduced, nYReduced,
+                                     GDT_Byte, 0, 0, nullptr) != CE_None)
             {
+                CPLFree(pData);
+                CPLFree(pabyMaskData);
                 return CE_Failure;
             }
         }
 
-        for (int iSampleBlock = 0;
-             iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
+        AddValues(pData, pabyMaskData, nXReduced, nYReduced, nXReduced, sAcc);
+
+        CPLFree(pData);
+        CPLFree(pabyMaskData);
+    }
+    else  // No arbitrary overviews.
+    {
+        if (!InitBlockInfo())
+            return CE_Failure;
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Figure out the ratio of blocks we will read to get an */
+        /*      approximate value. */
+        /* --------------------------------------------------------------------
+         */
+        int nSampleRate = 1;
+        if (bApproxOK)
+        {
+            nSampleRate = static_cast<int>(std::max(
+                1.0,
+                sqrt(static_cast<double>(nBlocksPerRow) * nBlocksPerColumn)));
+            // We want to avoid probing only the first column of blocks for
+            // a square shaped raster, because it is not unlikely that it may
+            // be padding only (#6378)
+            if (nSampleRate == nBlocksPerRow && nBlocksPerRow > 1)
+                nSampleRate += 1;
+        }
+        if (nSampleRate == 1)
+            bApproxOK = false;
+
+        const auto ProcessBlock =
+            [this, &AddValues](GDALRasterBand *poBlockBand,
+                               GDALRasterBand *poBlockMaskBand,
+                               int iSampleBlock, GByte *pabyMaskData,
+                               StatisticsAndHistogramAccumulator &sBlockAcc)
         {
             const int iYBlock = iSampleBlock / nBlocksPerRow;
             const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
 
             GDALRasterBlock *const poBlock =
-                GetLockedBlockRef(iXBlock, iYBlock);
+                poBlockBand->GetLockedBlockRef(iXBlock, iYBlock);
             if (poBlock == nullptr)
-            {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
-
-            void *const pData = poBlock->GetDataRef();
+                return false;
 
             int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
+            poBlockBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck,
+                                            &nYCheck);
+
+            if (poBlockMaskBand &&
+                poBlockMaskBand->RasterIO(
+                    GF_Read, iXBlock * nBlockXSize, iYBlock * nBlockYSize,
+                    nXCheck, nYCheck, pabyMaskData, nXCheck, nYCheck, GDT_Byte,
+                    0, nBlockXSize, nullptr) != CE_None)
             {
-                CPLFree(pabyMaskData);
                 poBlock->DropLock();
-                return CE_Failure;
+                return false;
             }
 
-            // This isn't the fastest way to do this, but is easier for now.
-            for (int iY = 0; iY < nYCheck; iY++)
-            {
-                for (int iX = 0; iX < nXCheck; iX++)
-                {
-                    const GPtrDiff_t iOffset =
-                        iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
-                    if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                        continue;
-
-                    bool bValid = true;
-                    double dfValue = GetPixelValue(
-                        eDataType, bSignedByte, pData, iOffset,
-                        CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
-                        bGotFloatNoDataValue, fNoDataValue, bValid);
+            AddValues(poBlock->GetDataRef(),
+                      poBlockMaskBand ? pabyMaskData : nullptr, nXCheck,
+                      nYCheck, nBlockXSize, sBlockAcc);
 
-                    if (!bValid)
-                        continue;
+            poBlock->DropLock();
+            return true;
+        };
 
-                    dfMin = std::min(dfMin, dfValue);
-                    dfMax = std::max(dfMax, dfValue);
+        const int nTotalBlocks = nBlocksPerRow * nBlocksPerColumn;
 
-                    nValidCount++;
-                    const double dfDelta = dfValue - dfMean;
-                    dfMean += dfDelta / nValidCount;
-                    dfM2 += dfDelta * (dfValue - dfMean);
+        GDALSampledBlocksInJobs oJobs(this, nTotalBlocks, nSampleRate);
+        const int nJobs = oJobs.GetJobCount();
+        if (nJobs > 0)
+        {
+            std::vector<StatisticsAndHistogramAccumulator> asJobAcc;
+            std::vector<std::vector<GByte>> aabyJobMaskData;
+            try
+            {
+                asJobAcc.resize(nJobs);
+                for (auto &sJobAcc : asJobAcc)
+                    InitAccumulator(sJobAcc);
+                if (poMaskBand)
+                {
+                    aabyJobMaskData.resize(
+                        nJobs, std::vector<GByte>(
+                                   static_cast<size_t>(nBlockXSize) *
+                                   nBlockYSize));
                 }
             }
+            catch (const std::bad_alloc &)
+            {
+                ReportError(CE_Failure, CPLE_OutOfMemory,
+                            "Out of memory in ComputeStatisticsAndHistogram()");
+                return CE_Failure;
+            }
 
-            nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
-
-            poBlock->DropLock();
-
-            if (!pfnProgress(
-                    iSampleBlock /
-                        static_cast<double>(nBlocksPerRow * nBlocksPerColumn),
-                    "Compute Statistics", pProgressData))
+            if (!oJobs.Run(
+                    [&ProcessBlock, &asJobAcc, &aabyJobMaskData,
+                     poMaskBand](int iJob, GDALRasterBand *poJobBand,
+                                 int iSampleBlock)
+                    {
+                        return ProcessBlock(
+                            poJobBand,
+                            poMaskBand ? poJobBand->GetMaskBand() : nullptr,
+                            iSampleBlock,
+                            poMaskBand ? aabyJobMaskData[iJob].data()
+                                       : nullptr,
+                            asJobAcc[iJob]);
+                    },
+                    pfnProgress, pProgressData, "Compute Statistics"))
             {
-                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                CPLFree(pabyMaskData);
                 return CE_Failure;
             }
+
+            // Merge the per-job accumulators in job order, so that the
+            // result does not depend on the scheduling.
+            for (const auto &sJobAcc : asJobAcc)
+                sAcc.Merge(sJobAcc);
         }
+        else
+        {
+            GByte *pabyMaskData = nullptr;
+            if (poMaskBand)
+            {
+                pabyMaskData = static_cast<GByte *>(
+                    VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
+                if (!pabyMaskData)
+                {
+                    return CE_Failure;
+                }
+            }
 
-        CPLFree(pabyMaskData);
+            for (int iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+                 iSampleBlock += nSampleRate)
+            {
+                if (!ProcessBlock(this, poMaskBand, iSampleBlock,
+                                  pabyMaskData, sAcc))
+                {
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
+
+                if (!pfnProgress(iSampleBlock /
+                                     static_cast<double>(nTotalBlocks),
+                                 "Compute Statistics", pProgressData))
+                {
+                    ReportError(CE_Failure, CPLE_UserInterrupt,
+                                "User terminated");
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
+            }
+
+            CPLFree(pabyMaskData);
+        }
     }
 
     if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
@@ -6075,78 +8103,152 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
         return CE_Failure;
     }
 
+    nValidCount = sAcc.sStats.nValidCount;
+    SetValidPercent(sAcc.sStats.nSampleCount, nValidCount);
+    if (nValidCount == 0)
+    {
+        if (pnValidCount)
+            *pnValidCount = 0;
+        ReportError(
+            CE_Failure, CPLE_AppDefined,
+            "Failed to compute statistics, no valid pixels found in sampling.");
+        return CE_Failure;
+    }
+
+    dfMin = sAcc.sStats.dfMin;
+    dfMax = sAcc.sStats.dfMax;
+    dfMean = sAcc.sStats.dfMean;
+    dfStdDev = sqrt(sAcc.sStats.dfM2 / nValidCount);
+
     /* -------------------------------------------------------------------- */
-    /*      Save computed information.                                      */
+    /*      Quantiles.                                                      */
     /* -------------------------------------------------------------------- */
-    const double dfStdDev = nValidCount > 0 ? sqrt(dfM2 / nValidCount) : 0.0;
-
-    if (nValidCount > 0)
+    const auto &anValueCounts = sAcc.anValueCounts;
+    for (int i = 0; i < nQuantiles; ++i)
     {
-        if (bApproxOK)
+        if (!anValueCounts.empty())
         {
-            SetMetadataItem("STATISTICS_APPROXIMATE", "YES");
+            // Nearest rank method.
+            const GUIntBig nRank =
+                std::max<GUIntBig>(1, static_cast<GUIntBig>(ceil(
+                                          padfQuantiles[i] *
+                                          static_cast<double>(nValidCount))));
+            GUIntBig nCount = 0;
+            int iValue = 0;
+            while (iValue + 1 < nCountedValues &&
+                   (nCount += anValueCounts[iValue]) < nRank)
+            {
+                ++iValue;
+            }
+            adfQuantileValues[i] = iValue + nCountedValueMin;
         }
-        else if (GetMetadataItem("STATISTICS_APPROXIMATE"))
+        else
         {
-            SetMetadataItem("STATISTICS_APPROXIMATE", nullptr);
+            adfQuantileValues[i] = sAcc.oDigest.Quantile(padfQuantiles[i]);
         }
-        SetStatistics(dfMin, dfMax, dfMean, dfStdDev);
-    }
-    else
-    {
-        dfMin = 0.0;
-        dfMax = 0.0;
     }
 
-    SetValidPercent(nSampleCount, nValidCount);
-
     /* -------------------------------------------------------------------- */
-    /*      Record results.                                                 */
+    /*      Histogram.                                                      */
     /* -------------------------------------------------------------------- */
-    if (pdfMin != nullptr)
-        *pdfMin = dfMin;
-    if (pdfMax != nullptr)
-        *pdfMax = dfMax;
-
-    if (pdfMean != nullptr)
-        *pdfMean = dfMean;
+    if (!bFixedHistogramBounds)
+    {
+        // Same bounds as GetDefaultHistogram().
+        if (eDataType == GDT_Byte && !bSignedByte)
+        {
+            dfHistMin = -0.5;
+            dfHistMax = 255.5;
+        }
+        else
+        {
+            const double dfHalfBucket = dfMax > dfMin
+                                            ? (dfMax - dfMin) /
+                                                  (2 * (nBuckets - 1))
+                                            : 0.5;
+            dfHistMin = dfMin - dfHalfBucket;
+            dfHistMax = dfMax + dfHalfBucket;
+        }
+    }
 
-    if (pdfStdDev != nullptr)
-        *pdfStdDev = dfStdDev;
+    panHistogram =
+        static_cast<GUIntBig *>(VSI_CALLOC_VERBOSE(sizeof(GUIntBig), nBuckets));
+    if (panHistogram == nullptr)
+        return CE_Failure;
 
-    if (nValidCount > 0)
-        return CE_None;
+    if (bFixedHistogramBounds)
+    {
+        std::copy(sAcc.anHistogram.begin(), sAcc.anHistogram.end(),
+                  panHistogram);
+    }
+    else if (!anValueCounts.empty())
+    {
+        const double dfHistScale = nBuckets / (dfHistMax - dfHistMin);
+        for (int iValue = 0; iValue < nCountedValues; ++iValue)
+        {
+            if (anValueCounts[iValue] == 0)
+                continue;
+            const double dfIndex =
+                floor((iValue + nCountedValueMin - dfHistMin) * dfHistScale);
+            const int nIndex = static_cast<int>(
+                std::min<double>(nBuckets - 1, std::max(0.0, dfIndex)));
+            panHistogram[nIndex] += anValueCounts[iValue];
+        }
+    }
+    else
+    {
+        // Distribute the count according to the quantile sketch, so that
+        // the buckets sum to the number of valid values.
+        GUIntBig nCountBelow = 0;
+        for (int i = 0; i < nBuckets; ++i)
+        {
+            const GUIntBig nCountBelowNext =
+                i + 1 == nBuckets
+                    ? nValidCount
+                    : static_cast<GUIntBig>(
+                          sAcc.oDigest.CDF(dfHistMin + (i + 1) *
+                                                           (dfHistMax -
+                                                            dfHistMin) /
+                                                           nBuckets) *
+                              static_cast<double>(nValidCount) +
+                          0.5);
+            panHistogram[i] = nCountBelowNext - nCountBelow;
+            nCountBelow = nCountBelowNext;
+        }
+    }
 
-    ReportError(
-        CE_Failure, CPLE_AppDefined,
-        "Failed to compute statistics, no valid pixels found in sampling.");
-    return CE_Failure;
+    StoreResults(CPL_TO_BOOL(bApproxOK));
+    return CE_None;
 }
 
 /************************************************************************/
-/*                    GDALComputeRasterStatistics()                     */
+/*               GDALComputeRasterStatisticsAndHistogram()              */
 /************************************************************************/
 
 /**
- * \brief Compute image statistics.
+ * \brief Compute image statistics, histogram and quantiles in a single pass.
  *
- * @see GDALRasterBand::ComputeStatistics()
+ * @see GDALRasterBand::ComputeStatisticsAndHistogram()
+ * @since GDAL 3.9
  */
 
-CPLErr CPL_STDCALL GDALComputeRasterStatistics(GDALRasterBandH hBand,
-                                               int bApproxOK, double *pdfMin,
-                                               double *pdfMax, double *pdfMean,
-                                               double *pdfStdDev,
-                                               GDALProgressFunc pfnProgress,
-                                               void *pProgressData)
+CPLErr CPL_STDCALL GDALComputeRasterStatisticsAndHistogram(
+    GDALRasterBandH hBand, int bApproxOK, double *pdfMin, double *pdfMax,
+    double *pdfMean, double *pdfStdDev, GUIntBig *pnValidCount,
+    double *pdfHistMin, double *pdfHistMax, int *pnBuckets,
+    GUIntBig **ppanHistogram, int nQuantiles, const double *padfQuantiles,
+    double *padfQuantileValues, GDALProgressFunc pfnProgress,
+    void *pProgressData)
 
 {
-    VALIDATE_POINTER1(hBand, "GDALComputeRasterStatistics", CE_Failure);
+    VALIDATE_POINTER1(hBand, "GDALComputeRasterStatisticsAndHistogram",
+                      CE_Failure);
 
     GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
 
-    return poBand->ComputeStatistics(bApproxOK, pdfMin, pdfMax, pdfMean,
-                                     pdfStdDev, pfnProgress, pProgressData);
+    return poBand->ComputeStatisticsAndHistogram(
+        bApproxOK, pdfMin, pdfMax, pdfMean, pdfStdDev, pnValidCount,
+        pdfHistMin, pdfHistMax, pnBuckets, ppanHistogram, nQuantiles,
+        padfQuantiles, padfQuantileValues, pfnProgress, pProgressData);
 }
 
 /************************************************************************/
@@ -6302,6 +8404,22 @@ static void ComputeMinMaxGeneric(const void *pData, GDALDataType eDataType,
                                  const GByte *pabyMaskData, double &dfMin,
                                  double &dfMax)
 {
+    if (!pabyMaskData)
+    {
+        WelfordStats sStats;
+        sStats.dfMin = dfMin;
+        sStats.dfMax = dfMax;
+        if (ComputeBlockStatistics</* COMPUTE_OTHER_STATS = */ false>(
+                eDataType, pData, nXCheck, nBlockXSize, nYCheck,
+                bGotNoDataValue, dfNoDataValue, bGotFloatNoDataValue,
+                fNoDataValue, sStats))
+        {
+            dfMin = sStats.dfMin;
+            dfMax = sStats.dfMax;
+            return;
+        }
+    }
+
     switch (eDataType)
     {
         case GDT_Unknown:
@@ -6392,6 +8510,48 @@ static void ComputeMinMaxGeneric(const void *pData, GDALDataType eDataType,
     }
 }
 
+static bool ComputeMinMaxGenericForBlock(
+    GDALRasterBand *poBand, GDALDataType eDataType, bool bSignedByte,
+    int iSampleBlock, int nBlocksPerRow, bool bGotNoDataValue,
+    double dfNoDataValue, bool bGotFloatNoDataValue, float fNoDataValue,
+    GDALRasterBand *poMaskBand, GByte *pabyMaskData, double &dfMin,
+    double &dfMax)
+
+{
+    int nBlockXSize, nBlockYSize;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+
+    const int iYBlock = iSampleBlock / nBlocksPerRow;
+    const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
+
+    GDALRasterBlock *poBlock = poBand->GetLockedBlockRef(iXBlock, iYBlock);
+    if (poBlock == nullptr)
+        return false;
+
+    void *const pData = poBlock->GetDataRef();
+
+    int nXCheck = 0, nYCheck = 0;
+    poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+    if (poMaskBand &&
+        poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
+                             iYBlock * nBlockYSize, nXCheck, nYCheck,
+                             pabyMaskData, nXCheck, nYCheck, GDT_Byte, 0,
+                             nBlockXSize, nullptr) != CE_None)
+    {
+        poBlock->DropLock();
+        return false;
+    }
+
+    ComputeMinMaxGeneric(pData, eDataType, bSignedByte, nXCheck, nYCheck,
+                         nBlockXSize, CPL_TO_BOOL(bGotNoDataValue),
+                         dfNoDataValue, bGotFloatNoDataValue, fNoDataValue,
+                         pabyMaskData, dfMin, dfMax);
+
+    poBlock->DropLock();
+    return true;
+}
+
 static bool ComputeMinMaxGenericIterBlocks(
     GDALRasterBand *poBand, GDALDataType eDataType, bool bSignedByte,
     int nTotalBlocks, int nSampleRate, int nBlocksPerRow, bool bGotNoDataValue,
@@ -6416,38 +8576,14 @@ static bool ComputeMinMaxGenericIterBlocks(
     for (int iSampleBlock = 0; iSampleBlock < nTotalBlocks;
          iSampleBlock += nSampleRate)
     {
-        const int iYBlock = iSampleBlock / nBlocksPerRow;
-        const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-        GDALRasterBlock *poBlock = poBand->GetLockedBlockRef(iXBlock, iYBlock);
-        if (poBlock == nullptr)
+        if (!ComputeMinMaxGenericForBlock(
+                poBand, eDataType, bSignedByte, iSampleBlock, nBlocksPerRow,
+                bGotNoDataValue, dfNoDataValue, bGotFloatNoDataValue,
+                fNoDataValue, poMaskBand, pabyMaskData, dfMin, dfMax))
         {
             CPLFree(pabyMaskData);
             return false;
         }
-
-        void *const pData = poBlock->GetDataRef();
-
-        int nXCheck = 0, nYCheck = 0;
-        poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-        if (poMaskBand &&
-            poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                 iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                 pabyMaskData, nXCheck, nYCheck, GDT_Byte, 0,
-                                 nBlockXSize, nullptr) != CE_None)
-        {
-            poBlock->DropLock();
-            CPLFree(pabyMaskData);
-            return false;
-        }
-
-        ComputeMinMaxGeneric(pData, eDataType, bSignedByte, nXCheck, nYCheck,
-                             nBlockXSize, CPL_TO_BOOL(bGotNoDataValue),
-                             dfNoDataValue, bGotFloatNoDataValue, fNoDataValue,
-                             pabyMaskData, dfMin, dfMax);
-
-        poBlock->DropLock();
     }
 
     CPLFree(pabyMaskData);
@@ -6562,9 +8698,10 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                         eDataType == GDT_Int16 || eDataType == GDT_UInt16);
 
     const auto ComputeMinMaxForBlock =
-        [this, bSignedByte, bGotNoDataValue, dfNoDataValue, &nMin, &nMax,
-         &nMinInt16, &nMaxInt16](const void *pData, int nXCheck,
-                                 int nBufferWidth, int nYCheck)
+        [this, bSignedByte, bGotNoDataValue,
+         dfNoDataValue](const void *pData, int nXCheck, int nBufferWidth,
+                        int nYCheck, GUInt32 &nMin, GUInt32 &nMax,
+                        GInt16 &nMinInt16, GInt16 &nMaxInt16)
     {
         if (eDataType == GDT_Byte && !bSignedByte)
         {
@@ -6684,7 +8821,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
 
         if (bUseOptimizedPath)
         {
-            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced);
+            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced, nMin,
+                                  nMax, nMinInt16, nMaxInt16);
         }
         else
         {
@@ -6723,10 +8861,120 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 nSampleRate += 1;
         }
 
-        if (bUseOptimizedPath)
+        const int nTotalBlocks = nBlocksPerRow * nBlocksPerColumn;
+        GDALSampledBlocksInJobs oJobs(this, nTotalBlocks, nSampleRate);
+        const int nJobs = oJobs.GetJobCount();
+
+        if (nJobs > 0)
+        {
+            struct MinMaxStats
+            {
+                GUInt32 nMin = 0;
+                GUInt32 nMax = 0;
+                GInt16 nMinInt16 = 0;
+                GInt16 nMaxInt16 = 0;
+                double dfMin = 0;
+                double dfMax = 0;
+                std::vector<GByte> abyMaskData{};
+            };
+
+            std::vector<MinMaxStats> asJobStats(nJobs);
+            try
+            {
+                for (auto &sJobStats : asJobStats)
+                {
+                    sJobStats.nMin = nMin;
+                    sJobStats.nMax = nMax;
+                    sJobStats.nMinInt16 = nMinInt16;
+                    sJobStats.nMaxInt16 = nMaxInt16;
+                    sJobStats.dfMin = dfMin;
+                    sJobStats.dfMax = dfMax;
+                    if (poMaskBand)
+                    {
+                        sJobStats.abyMaskData.resize(
+                            static_cast<size_t>(nBlockXSize) * nBlockYSize);
+                    }
+                }
+            }
+            catch (const std::bad_alloc &)
+            {
+                ReportError(CE_Failure, CPLE_OutOfMemory,
+                            "Out of memory in ComputeRasterMinMax()");
+                return CE_Failure;
+            }
+
+            // Set once a Byte job has found the full 0-255 range.
+            std::atomic<bool> bFullRange{false};
+
+            if (!oJobs.Run(
+                    [this, &ComputeMinMaxForBlock, &asJobStats, &bFullRange,
+                     bUseOptimizedPath, bSignedByte, bGotNoDataValue,
+                     dfNoDataValue, bGotFloatNoDataValue, fNoDataValue,
+                     poMaskBand](int iJob, GDALRasterBand *poJobBand,
+                                 int iSampleBlock)
+                    {
+                        auto &sJobStats = asJobStats[iJob];
+                        if (!bUseOptimizedPath)
+                        {
+                            return ComputeMinMaxGenericForBlock(
+                                poJobBand, eDataType, bSignedByte,
+                                iSampleBlock, nBlocksPerRow,
+                                CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
+                                bGotFloatNoDataValue, fNoDataValue,
+                                poMaskBand ? poJobBand->GetMaskBand()
+                                           : nullptr,
+                                poMaskBand ? sJobStats.abyMaskData.data()
+                                           : nullptr,
+                                sJobStats.dfMin, sJobStats.dfMax);
+                        }
+                        if (bFullRange)
+                            return true;
+
+                        const int iYBlock = iSampleBlock / nBlocksPerRow;
+                        const int iXBlock =
+                            iSampleBlock - nBlocksPerRow * iYBlock;
+
+                        GDALRasterBlock *poBlock =
+                            poJobBand->GetLockedBlockRef(iXBlock, iYBlock);
+                        if (poBlock == nullptr)
+                            return false;
+
+                        int nXCheck = 0, nYCheck = 0;
+                        poJobBand->GetActualBlockSize(iXBlock, iYBlock,
+                                                      &nXCheck, &nYCheck);
+
+                        ComputeMinMaxForBlock(
+                            poBlock->GetDataRef(), nXCheck, nBlockXSize,
+                            nYCheck, sJobStats.nMin, sJobStats.nMax,
+                            sJobStats.nMinInt16, sJobStats.nMaxInt16);
+
+                        poBlock->DropLock();
+
+                        if (eDataType == GDT_Byte && !bSignedByte &&
+                            sJobStats.nMin == 0 && sJobStats.nMax == 255)
+                        {
+                            bFullRange = true;
+                        }
+                        return true;
+                    },
+                    GDALDummyProgress, nullptr, ""))
+            {
+                return CE_Failure;
+            }
+
+            for (const auto &sJobStats : asJobStats)
+            {
+                nMin = std::min(nMin, sJobStats.nMin);
+                nMax = std::max(nMax, sJobStats.nMax);
+                nMinInt16 = std::min(nMinInt16, sJobStats.nMinInt16);
+                nMaxInt16 = std::max(nMaxInt16, sJobStats.nMaxInt16);
+                dfMin = std::min(dfMin, sJobStats.dfMin);
+                dfMax = std::max(dfMax, sJobStats.dfMax);
+            }
+        }
+        else if (bUseOptimizedPath)
         {
-            for (int iSampleBlock = 0;
-                 iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
+            for (int iSampleBlock = 0; iSampleBlock < nTotalBlocks;
                  iSampleBlock += nSampleRate)
             {
                 const int iYBlock = iSampleBlock / nBlocksPerRow;
@@ -6741,7 +8989,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 int nXCheck = 0, nYCheck = 0;
                 GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
 
-                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck);
+                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck,
+                                      nMin, nMax, nMinInt16, nMaxInt16);
 
                 poBlock->DropLock();
 
@@ -6752,7 +9001,6 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
         }
         else
         {
-            const int nTotalBlocks = nBlocksPerRow * nBlocksPerColumn;
             if (!ComputeMinMaxGenericIterBlocks(
                     this, eDataType, bSignedByte, nTotalBlocks, nSampleRate,
                     nBlocksPerRow, CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
@@ -33,8 +33,14 @@
 #include "gdal_priv.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <climits>
+#include <condition_variable>
+#include <cstdint>
 #include <cstring>
+#include <mutex>
+#include <thread>
 
 #include "cpl_atomic_ops.h"
 #include "cpl_conv.h"
@@ -43,24 +49,427 @@
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 static bool bCacheMaxInitialized = false;
 // Will later be overridden by the default 5% if GDAL_CACHEMAX not defined.
 static GIntBig nCacheMax = 40 * 1024 * 1024;
-static GIntBig nCacheUsed = 0;
-
-static GDALRasterBlock *poOldest = nullptr;  // Tail.
-static GDALRasterBlock *poNewest = nullptr;  // Head.
 
 static int nDisableDirtyBlockFlushCounter = 0;
 
-#if 0
-static CPLMutex *hRBLock = nullptr;
-#define INITIALIZE_LOCK CPLMutexHolderD(&hRBLock)
-#define TAKE_LOCK CPLMutexHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyMutex(hRBLock)
+/************************************************************************/
+/*                      GDALRasterBlockCacheShard                       */
+/************************************************************************/
+
+// The global block cache is made of one or several independent shards.
+// Each shard has its own LRU list, its own lock and its own share of the
+// GDAL_CACHEMAX budget. A block is assigned to a shard by hashing its band
+// and block coordinates (see GetShardIndex()). With the default of a single
+// shard, the behavior is the one of the historical global LRU.
+
+namespace
+{
+struct alignas(64) GDALRasterBlockCacheShard
+{
+    CPLLock *hLock = nullptr;
+    GDALRasterBlock *poOldest = nullptr;  // Tail.
+    GDALRasterBlock *poNewest = nullptr;  // Head.
+    GIntBig nCacheUsed = 0;
+
+    // Only used by the SLRU policy. The list is made of the hot segment,
+    // from poNewest, followed by the probation segment, from poMidpoint
+    // to poOldest.
+    GDALRasterBlock *poMidpoint = nullptr;  // Newest probation block.
+    GIntBig nHotUsed = 0;
+    int nProbationCount = 0;
+    unsigned nInsertEpoch = 0;  // Incremented at each block insertion.
+
+    // Read without the lock by GDALRasterBlock::Touch().
+    std::atomic<int> nBlockCount{0};
+    // Incremented (skipping 0) each time a block is moved to the head.
+    std::atomic<unsigned> nHeadEpoch{0};
+
+    // Statistics. nMisses and nEvictions are updated with the lock held.
+    GIntBig nMisses = 0;
+    GIntBig nEvictions = 0;
+    std::atomic<GIntBig> nHits{0};
+    std::atomic<GIntBig> nDirtyBlockFlushes{0};
+    std::atomic<GIntBig> nLockWaitNanoSec{0};
+};
+}  // namespace
+
+constexpr int MAX_BLOCK_CACHE_SHARDS = 256;
+static GDALRasterBlockCacheShard asShards[MAX_BLOCK_CACHE_SHARDS];
+
+/************************************************************************/
+/*                          GetNUMANodeCount()                          */
+/************************************************************************/
+
+// Number of NUMA nodes over which the block cache shards are partitioned,
+// or 1 if the partitioning is disabled. Read only once, from the
+// GDAL_BLOCK_CACHE_NUMA configuration option. Only supported on Linux.
+static int GetNUMANodeCount()
+{
+    static const int nNodeCount = []()
+    {
+        if (!CPLTestBool(CPLGetConfigOption("GDAL_BLOCK_CACHE_NUMA", "NO")))
+            return 1;
+        int nNodes = 1;
+#if defined(__linux__) && defined(SYS_getcpu)
+        // Content is a list of node ranges, like "0-1" or "0,2-3".
+        VSILFILE *fp = VSIFOpenL("/sys/devices/system/node/online", "rb");
+        if (fp)
+        {
+            const char *pszLine = CPLReadLineL(fp);
+            if (pszLine)
+            {
+                const CPLStringList aosRanges(
+                    CSLTokenizeString2(pszLine, ",", 0));
+                for (int i = 0; i < aosRanges.size(); ++i)
+                {
+                    const char *pszDash = strchr(aosRanges[i], '-');
+                    const int nLast =
+                        atoi(pszDash ? pszDash + 1 : aosRanges[i]);
+                    nNodes = std::max(nNodes,
+                                      std::min(nLast + 1,
+                                               MAX_BLOCK_CACHE_SHARDS));
+                }
+            }
+            VSIFCloseL(fp);
+        }
 #else
+        CPLError(CE_Warning, CPLE_NotSupported,
+                 "GDAL_BLOCK_CACHE_NUMA not supported on this platform");
+#endif
+        if (nNodes > 1)
+            CPLDebug("GDAL", "Partitioning block cache over %d NUMA nodes",
+                     nNodes);
+        return nNodes;
+    }();
+    return nNodeCount;
+}
+
+/************************************************************************/
+/*                         GetCurrentNUMANode()                         */
+/************************************************************************/
+
+// NUMA node of the CPU the current thread is running on.
+static int GetCurrentNUMANode()
+{
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned nCPU = 0;
+    unsigned nNode = 0;
+    if (syscall(SYS_getcpu, &nCPU, &nNode, nullptr) == 0)
+        return static_cast<int>(nNode % static_cast<unsigned>(
+                                            GetNUMANodeCount()));
+#endif
+    return 0;
+}
+
+/************************************************************************/
+/*                           GetShardCount()                            */
+/************************************************************************/
+
+// Number of shards of the global block cache. Read only once, from the
+// GDAL_BLOCK_CACHE_SHARDS configuration option, as it cannot be changed
+// once blocks have been allocated. When the cache is partitioned over
+// NUMA nodes, this is a multiple of the number of nodes.
+static int GetShardCount()
+{
+    static const int nShardCount = []()
+    {
+        const char *pszShards =
+            CPLGetConfigOption("GDAL_BLOCK_CACHE_SHARDS", "1");
+        int nVal = EQUAL(pszShards, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                 : atoi(pszShards);
+        if (nVal > MAX_BLOCK_CACHE_SHARDS)
+        {
+            CPLError(CE_Warning, CPLE_NotSupported,
+                     "GDAL_BLOCK_CACHE_SHARDS=%s is greater than the maximum "
+                     "supported. Using %d",
+                     pszShards, MAX_BLOCK_CACHE_SHARDS);
+            nVal = MAX_BLOCK_CACHE_SHARDS;
+        }
+        else if (nVal < 1)
+        {
+            nVal = 1;
+        }
+        const int nNodes = GetNUMANodeCount();
+        if (nNodes > 1)
+            nVal = std::max(1, nVal / nNodes) * nNodes;
+        if (nVal > 1)
+            CPLDebug("GDAL", "Using %d block cache shards", nVal);
+        return nVal;
+    }();
+    return nShardCount;
+}
+
+/************************************************************************/
+/*                           GetShardIndex()                            */
+/************************************************************************/
+
+static int GetShardIndex(const GDALRasterBand *poBand, int nXOff, int nYOff)
+{
+    const int nShardCount = GetShardCount();
+    if (nShardCount == 1)
+        return 0;
+    // Mix the band address with the block coordinates, so that blocks of
+    // a same band are spread over all shards.
+    constexpr GUIntBig MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+    GUIntBig nHash =
+        static_cast<GUIntBig>(reinterpret_cast<uintptr_t>(poBand) >> 4);
+    nHash = nHash * MULTIPLIER + static_cast<unsigned>(nXOff);
+    nHash = nHash * MULTIPLIER + static_cast<unsigned>(nYOff);
+    nHash ^= nHash >> 29;
+    // When partitioned over NUMA nodes, a block goes to one of the shards
+    // of the node of the thread that loads it. As eviction in Internalize()
+    // only recycles blocks of its own shard, the memory of a block, first
+    // touched by the thread that reads it, stays local to that node.
+    const int nNodes = GetNUMANodeCount();
+    if (nNodes > 1)
+    {
+        const unsigned nShardsPerNode =
+            static_cast<unsigned>(nShardCount / nNodes);
+        return GetCurrentNUMANode() * static_cast<int>(nShardsPerNode) +
+               static_cast<int>(nHash % nShardsPerNode);
+    }
+    return static_cast<int>(nHash % static_cast<unsigned>(nShardCount));
+}
+
+/************************************************************************/
+/*                             IsSLRUPolicy()                           */
+/************************************************************************/
+
+// Whether the block cache uses the scan-resistant segmented LRU policy
+// instead of the plain LRU one. Read only once, from the
+// GDAL_BLOCK_CACHE_POLICY configuration option.
+//
+// With the SLRU policy, newly loaded blocks are inserted in a probation
+// segment, at the middle of the LRU list, and are only promoted to the hot
+// segment at its head if they are accessed again after enough other blocks
+// have been inserted (so that the repeated accesses to a block by a single
+// sequential pass over a raster do not promote it). The hot segment is
+// limited to 3/4 of the cache, and blocks overflowing from it are demoted
+// to the probation segment. Eviction always starts from the oldest block of
+// the probation segment. This is a simplified form of the 2Q policy.
+static bool IsSLRUPolicy()
+{
+    static const bool bSLRU = []()
+    {
+        const char *pszPolicy =
+            CPLGetConfigOption("GDAL_BLOCK_CACHE_POLICY", "LRU");
+        if (EQUAL(pszPolicy, "SLRU"))
+        {
+            CPLDebug("GDAL", "Using SLRU block cache policy");
+            return true;
+        }
+        if (!EQUAL(pszPolicy, "LRU"))
+        {
+            CPLError(CE_Warning, CPLE_NotSupported,
+                     "GDAL_BLOCK_CACHE_POLICY=%s not supported. Falling back "
+                     "to LRU",
+                     pszPolicy);
+        }
+        return false;
+    }();
+    return bSLRU;
+}
+
+// Number of nested GDALRasterBlock::EnterStreamingRead() calls in the
+// current thread.
+static thread_local int tls_nStreamingReadCounter = 0;
+
+/************************************************************************/
+/*                       IsStatisticsEnabled()                          */
+/************************************************************************/
+
+// Whether the statistics that have a cost on the block cache hit path (hits,
+// misses and lock wait time) are collected. Read only once, from the
+// GDAL_BLOCK_CACHE_STATISTICS configuration option.
+static bool IsStatisticsEnabled()
+{
+    static const bool bEnabled =
+        CPLTestBool(CPLGetConfigOption("GDAL_BLOCK_CACHE_STATISTICS", "NO"));
+    return bEnabled;
+}
+
+namespace
+{
+// Accumulates the time spent in the scope between its construction and
+// the call to Stop() into the lock wait time of a shard.
+class LockWaitTimer
+{
+    GDALRasterBlockCacheShard *m_psShard = nullptr;
+    std::chrono::steady_clock::time_point m_oStart{};
+
+    CPL_DISALLOW_COPY_ASSIGN(LockWaitTimer)
+
+  public:
+    explicit LockWaitTimer(GDALRasterBlockCacheShard *psShard)
+    {
+        if (IsStatisticsEnabled())
+        {
+            m_psShard = psShard;
+            m_oStart = std::chrono::steady_clock::now();
+        }
+    }
+
+    void Stop()
+    {
+        if (m_psShard)
+        {
+            m_psShard->nLockWaitNanoSec.fetch_add(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - m_oStart)
+                    .count(),
+                std::memory_order_relaxed);
+        }
+    }
+};
+}  // namespace
+
+// Number of dirty blocks, in all datasets.
+static std::atomic<int> gnDirtyBlocks{0};
+
+/************************************************************************/
+/*                        GetWriteBackHighWater()                       */
+/************************************************************************/
+
+// Percentage of GDAL_CACHEMAX above which the background write-back thread
+// flushes dirty blocks, or 0 if the write-back thread is disabled. Read only
+// once, from the GDAL_BLOCK_CACHE_WRITE_BACK configuration option.
+static int GetWriteBackHighWater()
+{
+    static const int nHighWater = []()
+    {
+        const char *pszWriteBack =
+            CPLGetConfigOption("GDAL_BLOCK_CACHE_WRITE_BACK", "NO");
+        if (EQUAL(pszWriteBack, "YES") || EQUAL(pszWriteBack, "ON") ||
+            EQUAL(pszWriteBack, "TRUE"))
+            return 80;
+        const int nVal = atoi(pszWriteBack);
+        if (nVal > 0 && nVal <= 100)
+            return nVal;
+        if (!EQUAL(pszWriteBack, "NO") && !EQUAL(pszWriteBack, "OFF") &&
+            !EQUAL(pszWriteBack, "FALSE") && !EQUAL(pszWriteBack, "0"))
+        {
+            CPLError(CE_Warning, CPLE_IllegalArg,
+                     "Invalid value for GDAL_BLOCK_CACHE_WRITE_BACK: %s",
+                     pszWriteBack);
+        }
+        return 0;
+    }();
+    return nHighWater;
+}
+
+namespace
+{
+// Background thread writing and evicting the oldest dirty blocks when the
+// cache usage is above the high-water mark, until it goes 10% below it, so
+// that the threads producing dirty blocks do not have to do it, synchronously,
+// in GDALRasterBlock::Internalize().
+// Writing dirty blocks from another thread than the one that owns their
+// dataset relies on the same read-write mutex of the dataset as when
+// Internalize() evicts dirty blocks of other datasets.
+struct WriteBackThread
+{
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+    std::thread oThread{};
+    bool bStarted = false;
+    bool bStop = false;
+    bool bWakeUp = false;
+};
+}  // namespace
+
+static WriteBackThread &GetWriteBackThread()
+{
+    static WriteBackThread oWriteBack;
+    return oWriteBack;
+}
+
+/************************************************************************/
+/*                          WriteBackThreadMain()                       */
+/************************************************************************/
+
+static void WriteBackThreadMain()
+{
+    auto &oWriteBack = GetWriteBackThread();
+    std::unique_lock<std::mutex> oLock(oWriteBack.oMutex);
+    while (true)
+    {
+        oWriteBack.oCV.wait(
+            oLock, [&oWriteBack]
+            { return oWriteBack.bStop || oWriteBack.bWakeUp; });
+        if (oWriteBack.bStop)
+            break;
+        oWriteBack.bWakeUp = false;
+        oLock.unlock();
+
+        const GIntBig nLowWater =
+            GDALGetCacheMax64() / 100 * std::max(0, GetWriteBackHighWater() - 10);
+        while (gnDirtyBlocks > 0 && GDALGetCacheUsed64() > nLowWater &&
+               GDALRasterBlock::FlushCacheBlock(TRUE))
+        {
+            // Stop early at process termination.
+            std::lock_guard<std::mutex> oStopLock(oWriteBack.oMutex);
+            if (oWriteBack.bStop)
+                break;
+        }
+
+        oLock.lock();
+    }
+}
+
+/************************************************************************/
+/*                          WakeUpWriteBackThread()                     */
+/************************************************************************/
+
+// Start or wake up the write-back thread if there are dirty blocks and the
+// cache usage is above the high-water mark.
+static void WakeUpWriteBackThread(GIntBig nCacheMax)
+{
+    const int nHighWater = GetWriteBackHighWater();
+    if (nHighWater == 0 || gnDirtyBlocks == 0 ||
+        GDALGetCacheUsed64() <= nCacheMax / 100 * nHighWater)
+        return;
+
+    auto &oWriteBack = GetWriteBackThread();
+    std::lock_guard<std::mutex> oLock(oWriteBack.oMutex);
+    if (oWriteBack.bStop)
+        return;
+    if (!oWriteBack.bStarted)
+    {
+        oWriteBack.bStarted = true;
+        oWriteBack.oThread = std::thread(WriteBackThreadMain);
+    }
+    oWriteBack.bWakeUp = true;
+    oWriteBack.oCV.notify_one();
+}
+
+/************************************************************************/
+/*                          StopWriteBackThread()                       */
+/************************************************************************/
+
+static void StopWriteBackThread()
+{
+    auto &oWriteBack = GetWriteBackThread();
+    {
+        std::lock_guard<std::mutex> oLock(oWriteBack.oMutex);
+        if (!oWriteBack.bStarted)
+            return;
+        oWriteBack.bStop = true;
+        oWriteBack.oCV.notify_one();
+    }
+    oWriteBack.oThread.join();
+    std::lock_guard<std::mutex> oLock(oWriteBack.oMutex);
+    oWriteBack.bStarted = false;
+    oWriteBack.bStop = false;
+}
 
-static CPLLock *hRBLock = nullptr;
 static bool bDebugContention = false;
 static bool bSleepsForBockCacheDebug = false;
 static CPLLockType GetLockType()
@@ -90,13 +499,30 @@ static CPLLockType GetLockType()
     return static_cast<CPLLockType>(nLockType);
 }
 
-#define INITIALIZE_LOCK                                                        \
-    CPLLockHolderD(&hRBLock, GetLockType());                                   \
-    CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK CPLLockHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyLock(hRBLock)
+#define INITIALIZE_LOCK(psShard)                                               \
+    LockWaitTimer oLockWaitTimer(psShard);                                     \
+    CPLLockHolder oHolder(&((psShard)->hLock), GetLockType(), __FILE__,        \
+                          __LINE__);                                           \
+    oLockWaitTimer.Stop();                                                     \
+    CPLLockSetDebugPerf((psShard)->hLock, bDebugContention)
+#define TAKE_LOCK(psShard)                                                     \
+    LockWaitTimer oLockWaitTimer(psShard);                                     \
+    CPLLockHolder oHolder((psShard)->hLock, __FILE__, __LINE__);               \
+    oLockWaitTimer.Stop()
+#define DESTROY_LOCK(psShard) CPLDestroyLock((psShard)->hLock)
 
-#endif
+/************************************************************************/
+/*                          InitializeLocks()                           */
+/************************************************************************/
+
+static void InitializeLocks()
+{
+    const int nShardCount = GetShardCount();
+    for (int i = 0; i < nShardCount; ++i)
+    {
+        INITIALIZE_LOCK(&asShards[i]);
+    }
+}
 
 // #define ENABLE_DEBUG
 
@@ -153,9 +579,7 @@ void CPL_STDCALL GDALSetCacheMax64(GIntBig nNewSizeInBytes)
     }
 #endif
 
-    {
-        INITIALIZE_LOCK;
-    }
+    InitializeLocks();
     bCacheMaxInitialized = true;
     nCacheMax = nNewSizeInBytes;
 
@@ -163,14 +587,15 @@ void CPL_STDCALL GDALSetCacheMax64(GIntBig nNewSizeInBytes)
     /*      Flush blocks till we are under the new limit or till we         */
     /*      can't seem to flush anymore.                                    */
     /* -------------------------------------------------------------------- */
+    GIntBig nCacheUsed = GDALGetCacheUsed64();
     while (nCacheUsed > nCacheMax)
     {
-        const GIntBig nOldCacheUsed = nCacheUsed;
-
         GDALFlushCacheBlock();
 
-        if (nCacheUsed == nOldCacheUsed)
+        const GIntBig nNewCacheUsed = GDALGetCacheUsed64();
+        if (nNewCacheUsed == nCacheUsed)
             break;
+        nCacheUsed = nNewCacheUsed;
     }
 }
 
@@ -239,9 +664,7 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
 {
     if (!bCacheMaxInitialized)
     {
-        {
-            INITIALIZE_LOCK;
-        }
+        InitializeLocks();
         bSleepsForBockCacheDebug =
             CPLTestBool(CPLGetConfigOption("GDAL_DEBUG_BLOCK_CACHE", "NO"));
 
@@ -321,6 +744,7 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
 
 int CPL_STDCALL GDALGetCacheUsed()
 {
+    const GIntBig nCacheUsed = GDALGetCacheUsed64();
     if (nCacheUsed > INT_MAX)
     {
         static bool bHasWarned = false;
@@ -351,9 +775,86 @@ int CPL_STDCALL GDALGetCacheUsed()
 
 GIntBig CPL_STDCALL GDALGetCacheUsed64()
 {
+    const int nShardCount = GetShardCount();
+    GIntBig nCacheUsed = 0;
+    for (int i = 0; i < nShardCount; ++i)
+        nCacheUsed += asShards[i].nCacheUsed;
     return nCacheUsed;
 }
 
+/************************************************************************/
+/*                     GDALGetBlockCacheStatistics()                    */
+/************************************************************************/
+
+/**
+ * \brief Get statistics of the global raster block cache.
+ *
+ * The counters are cumulated since the start of the process, or the last
+ * call to GDALResetBlockCacheStatistics(). nHits, nMisses and dfLockWaitTime
+ * are only collected when the GDAL_BLOCK_CACHE_STATISTICS configuration
+ * option is set to YES (it must be set before the block cache is first used).
+ *
+ * GDALGetRasterBandBlockCacheStatistics() and
+ * GDALDatasetGetBlockCacheStatistics() give the statistics of a single band
+ * or dataset.
+ *
+ * @param psStats Structure to fill. Must not be NULL.
+ * @since GDAL 3.9
+ */
+
+void GDALGetBlockCacheStatistics(GDALBlockCacheStatistics *psStats)
+{
+    VALIDATE_POINTER0(psStats, "GDALGetBlockCacheStatistics");
+
+    memset(psStats, 0, sizeof(*psStats));
+    GIntBig nLockWaitNanoSec = 0;
+    const int nShardCount = GetShardCount();
+    for (int i = 0; i < nShardCount; ++i)
+    {
+        const GDALRasterBlockCacheShard &oShard = asShards[i];
+        psStats->nHits += oShard.nHits.load(std::memory_order_relaxed);
+        psStats->nMisses += oShard.nMisses;
+        psStats->nEvictions += oShard.nEvictions;
+        psStats->nDirtyBlockFlushes +=
+            oShard.nDirtyBlockFlushes.load(std::memory_order_relaxed);
+        nLockWaitNanoSec +=
+            oShard.nLockWaitNanoSec.load(std::memory_order_relaxed);
+        psStats->nCacheUsed += oShard.nCacheUsed;
+    }
+    psStats->dfLockWaitTime = static_cast<double>(nLockWaitNanoSec) * 1e-9;
+}
+
+/************************************************************************/
+/*                    GDALResetBlockCacheStatistics()                   */
+/************************************************************************/
+
+/**
+ * \brief Reset the counters of the statistics of the global raster block
+ * cache.
+ *
+ * The counters of the bands are not modified.
+ *
+ * @since GDAL 3.9
+ */
+
+void GDALResetBlockCacheStatistics()
+{
+    const int nShardCount = GetShardCount();
+    for (int i = 0; i < nShardCount; ++i)
+    {
+        GDALRasterBlockCacheShard &oShard = asShards[i];
+        if (oShard.hLock)
+        {
+            TAKE_LOCK(&oShard);
+            oShard.nMisses = 0;
+            oShard.nEvictions = 0;
+        }
+        oShard.nHits = 0;
+        oShard.nDirtyBlockFlushes = 0;
+        oShard.nLockWaitNanoSec = 0;
+    }
+}
+
 /************************************************************************/
 /*                        GDALFlushCacheBlock()                         */
 /*                                                                      */
@@ -431,11 +932,21 @@ int CPL_STDCALL GDALFlushCacheBlock()
 int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
 
 {
-    GDALRasterBlock *poTarget;
+    GDALRasterBlock *poTarget = nullptr;
+
+    // Start from a different shard at each call, so that repeated calls
+    // (e.g from GDALSetCacheMax64()) evenly drain all shards.
+    static std::atomic<unsigned> nNextShard{0};
+    const int nShardCount = GetShardCount();
+    const int nFirstShard = static_cast<int>(
+        nNextShard.fetch_add(1) % static_cast<unsigned>(nShardCount));
 
+    for (int iShard = 0; poTarget == nullptr && iShard < nShardCount; ++iShard)
     {
-        INITIALIZE_LOCK;
-        poTarget = poOldest;
+        GDALRasterBlockCacheShard *psShard =
+            &asShards[(nFirstShard + iShard) % nShardCount];
+        INITIALIZE_LOCK(psShard);
+        poTarget = psShard->poOldest;
 
         while (poTarget != nullptr)
         {
@@ -449,7 +960,7 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         }
 
         if (poTarget == nullptr)
-            return FALSE;
+            continue;
         if (bSleepsForBockCacheDebug)
         {
             // coverity[tainted_data]
@@ -461,8 +972,12 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
 
         poTarget->Detach_unlocked();
         poTarget->GetBand()->UnreferenceBlock(poTarget);
+        psShard->nEvictions++;
     }
 
+    if (poTarget == nullptr)
+        return FALSE;
+
     if (bSleepsForBockCacheDebug)
     {
         // coverity[tainted_data]
@@ -472,8 +987,14 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
             CPLSleep(dfDelay);
     }
 
-    if (poTarget->GetDirty())
+    if (!poTarget->GetDirty())
     {
+        GDALCompressedBlockCacheStore(poTarget);
+    }
+    else
+    {
+        asShards[poTarget->nShard].nDirtyBlockFlushes++;
+        poTarget->poBand->poBandBlockCache->IncDirtyBlockFlushes();
         const CPLErr eErr = poTarget->Write();
         if (eErr != CE_None)
         {
@@ -482,7 +1003,7 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         }
     }
 
-    VSIFreeAligned(poTarget->pData);
+    GDALRasterBlockPoolFree(poTarget->pData);
     poTarget->pData = nullptr;
     poTarget->GetBand()->AddBlockToFreeList(poTarget);
 
@@ -559,6 +1080,52 @@ void GDALRasterBlock::LeaveDisableDirtyBlockFlush()
     CPLAtomicDec(&nDisableDirtyBlockFlushCounter);
 }
 
+/************************************************************************/
+/*                         EnterStreamingRead()                         */
+/************************************************************************/
+
+/**
+ * \brief Starts marking blocks loaded by the current thread as streaming.
+ *
+ * Such blocks are assumed to be read only once, for example by a sequential
+ * scan over a raster. With the default LRU policy of the block cache, they
+ * are inserted at the tail of the LRU list, so that they are evicted before
+ * any other block. With the SLRU policy, they are never promoted to the
+ * hot segment. In both cases, the blocks already in the cache are preserved.
+ *
+ * This is normally called by GDALRasterBand::RasterIO() and
+ * GDALDataset::RasterIO() when GDALRasterIOExtraArg::bStreaming is set.
+ * If a streaming read accesses a block several times (for example when
+ * reading a tiled raster line by line), this might cause the block to be
+ * read several times from storage.
+ *
+ * This call must be paired with a corresponding LeaveStreamingRead().
+ *
+ * @since GDAL 3.9
+ */
+
+void GDALRasterBlock::EnterStreamingRead()
+{
+    ++tls_nStreamingReadCounter;
+}
+
+/************************************************************************/
+/*                         LeaveStreamingRead()                         */
+/************************************************************************/
+
+/**
+ * \brief Ends marking blocks loaded by the current thread as streaming.
+ *
+ * Undoes the effect of EnterStreamingRead().
+ *
+ * @since GDAL 3.9
+ */
+
+void GDALRasterBlock::LeaveStreamingRead()
+{
+    --tls_nStreamingReadCounter;
+}
+
 /************************************************************************/
 /*                          GDALRasterBlock()                           */
 /************************************************************************/
@@ -582,7 +1149,10 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
                                  int nYOffIn)
     : eType(poBandIn->GetRasterDataType()), bDirty(false), nLockCount(0),
       nXOff(nXOffIn), nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr),
-      poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true)
+      poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true),
+      nShard(GetShardIndex(poBandIn, nXOffIn, nYOffIn)),
+      poCacheSettings(nullptr), bHot(false), bStreaming(false), nInsertEpoch(0),
+      nHeadEpoch(0)
 {
     CPLAssert(poBandIn != nullptr);
     poBand->GetBlockSize(&nXSize, &nYSize);
@@ -609,7 +1179,9 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
 GDALRasterBlock::GDALRasterBlock(int nXOffIn, int nYOffIn)
     : eType(GDT_Unknown), bDirty(false), nLockCount(0), nXOff(nXOffIn),
       nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr), poBand(nullptr),
-      poNext(nullptr), poPrevious(nullptr), bMustDetach(false)
+      poNext(nullptr), poPrevious(nullptr), bMustDetach(false), nShard(0),
+      poCacheSettings(nullptr), bHot(false), bStreaming(false), nInsertEpoch(0),
+      nHeadEpoch(0)
 {
 }
 
@@ -627,6 +1199,8 @@ void GDALRasterBlock::RecycleFor(int nXOffIn, int nYOffIn)
 {
     CPLAssert(pData == nullptr);
     pData = nullptr;
+    if (bDirty)
+        gnDirtyBlocks--;
     bDirty = false;
     nLockCount = 0;
 
@@ -636,6 +1210,12 @@ void GDALRasterBlock::RecycleFor(int nXOffIn, int nYOffIn)
     nXOff = nXOffIn;
     nYOff = nYOffIn;
     bMustDetach = true;
+    nShard = GetShardIndex(poBand, nXOffIn, nYOffIn);
+    poCacheSettings = nullptr;
+    bHot = false;
+    bStreaming = false;
+    nInsertEpoch = 0;
+    nHeadEpoch.store(0, std::memory_order_relaxed);
 }
 
 /************************************************************************/
@@ -655,9 +1235,12 @@ GDALRasterBlock::~GDALRasterBlock()
 
     if (pData != nullptr)
     {
-        VSIFreeAligned(pData);
+        GDALRasterBlockPoolFree(pData);
     }
 
+    if (bDirty)
+        gnDirtyBlocks--;
+
     CPLAssert(nLockCount <= 0);
 
 #ifdef ENABLE_DEBUG
@@ -680,6 +1263,23 @@ static size_t GetEffectiveBlockSize(GPtrDiff_t nBlockSize)
                      2 * sizeof(GDALRasterBlock)));
 }
 
+/************************************************************************/
+/*                      IsProtectedFromEviction()                       */
+/************************************************************************/
+
+// Whether a block should only be evicted when no other block can be, because
+// of the priority class or the cache budget of its dataset.
+static bool IsProtectedFromEviction(const GDALBlockCacheSettings *poSettings)
+{
+    if (poSettings == nullptr)
+        return false;
+    if (poSettings->nPriority.load(std::memory_order_relaxed) == GBCP_High)
+        return true;
+    const GIntBig nBudget = poSettings->nBudget.load(std::memory_order_relaxed);
+    return nBudget > 0 &&
+           poSettings->nUsed.load(std::memory_order_relaxed) <= nBudget;
+}
+
 /************************************************************************/
 /*                               Detach()                               */
 /************************************************************************/
@@ -698,21 +1298,63 @@ void GDALRasterBlock::Detach()
 {
     if (bMustDetach)
     {
-        TAKE_LOCK;
+        TAKE_LOCK(&asShards[nShard]);
         Detach_unlocked();
     }
 }
 
 void GDALRasterBlock::Detach_unlocked()
 {
-    if (poOldest == this)
-        poOldest = poPrevious;
+    GDALRasterBlockCacheShard &oShard = asShards[nShard];
+
+    Unlink_unlocked();
+    bMustDetach = false;
 
-    if (poNewest == this)
+    if (pData)
+    {
+        oShard.nCacheUsed -= GetEffectiveBlockSize(GetBlockSize());
+        poBand->poBandBlockCache->AddCacheUsed(
+            -GetEffectiveBlockSize(GetBlockSize()));
+    }
+
+    if (bHot)
     {
-        poNewest = poNext;
+        oShard.nHotUsed -= GetEffectiveBlockSize(GetBlockSize());
+        bHot = false;
     }
 
+    if (poCacheSettings)
+    {
+        poCacheSettings->nUsed -= GetEffectiveBlockSize(GetBlockSize());
+        poCacheSettings = nullptr;
+    }
+
+#ifdef ENABLE_DEBUG
+    Verify();
+#endif
+}
+
+/************************************************************************/
+/*                           Unlink_unlocked()                          */
+/************************************************************************/
+
+// Remove the block from the LRU list of its shard, if it is in it.
+void GDALRasterBlock::Unlink_unlocked()
+{
+    GDALRasterBlockCacheShard &oShard = asShards[nShard];
+
+    if (poPrevious == nullptr && poNext == nullptr && oShard.poNewest != this)
+        return;
+
+    if (oShard.poOldest == this)
+        oShard.poOldest = poPrevious;
+
+    if (oShard.poNewest == this)
+        oShard.poNewest = poNext;
+
+    if (oShard.poMidpoint == this)
+        oShard.poMidpoint = poNext;
+
     if (poPrevious != nullptr)
         poPrevious->poNext = poNext;
 
@@ -721,14 +1363,55 @@ void GDALRasterBlock::Detach_unlocked()
 
     poPrevious = nullptr;
     poNext = nullptr;
-    bMustDetach = false;
+    nHeadEpoch.store(0, std::memory_order_relaxed);
+    oShard.nBlockCount.fetch_sub(1, std::memory_order_relaxed);
 
-    if (pData)
-        nCacheUsed -= GetEffectiveBlockSize(GetBlockSize());
+    if (!bHot)
+        oShard.nProbationCount--;
+}
 
-#ifdef ENABLE_DEBUG
-    Verify();
-#endif
+/************************************************************************/
+/*                        InsertBefore_unlocked()                       */
+/************************************************************************/
+
+// Insert the block in the LRU list of its shard, just before (that is as
+// more recently used than) poOlder, or at the tail of the list if poOlder is
+// null.
+void GDALRasterBlock::InsertBefore_unlocked(GDALRasterBlock *poOlder)
+{
+    GDALRasterBlockCacheShard &oShard = asShards[nShard];
+
+    CPLAssert(poPrevious == nullptr && poNext == nullptr);
+    CPLAssert(oShard.poNewest != this);
+
+    poNext = poOlder;
+    poPrevious = poOlder ? poOlder->poPrevious : oShard.poOldest;
+
+    if (poPrevious != nullptr)
+        poPrevious->poNext = this;
+    else
+        oShard.poNewest = this;
+
+    if (poNext != nullptr)
+        poNext->poPrevious = this;
+    else
+        oShard.poOldest = this;
+
+    oShard.nBlockCount.fetch_add(1, std::memory_order_relaxed);
+    // Only blocks that do not need any specific processing when hit again
+    // are eligible to the lazy promotion of Touch().
+    if (poPrevious == nullptr && (bHot || (!IsSLRUPolicy() && !bStreaming)))
+    {
+        unsigned nEpoch =
+            oShard.nHeadEpoch.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (nEpoch == 0)
+            nEpoch = oShard.nHeadEpoch.fetch_add(1, std::memory_order_relaxed) +
+                     1;
+        nHeadEpoch.store(nEpoch, std::memory_order_relaxed);
+    }
+
+    if (!bHot)
+        oShard.nProbationCount++;
 }
 
 /************************************************************************/
@@ -744,26 +1427,42 @@ void GDALRasterBlock::Detach_unlocked()
 void GDALRasterBlock::Verify()
 
 {
-    TAKE_LOCK;
+    const int nShardCount = GetShardCount();
+    for (int iShard = 0; iShard < nShardCount; ++iShard)
+    {
+        GDALRasterBlockCacheShard *psShard = &asShards[iShard];
+        TAKE_LOCK(psShard);
 
-    CPLAssert((poNewest == nullptr && poOldest == nullptr) ||
-              (poNewest != nullptr && poOldest != nullptr));
+        GDALRasterBlock *poNewest = psShard->poNewest;
+        GDALRasterBlock *poOldest = psShard->poOldest;
 
-    if (poNewest != nullptr)
-    {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        CPLAssert(poOldest->poNext == nullptr);
+        CPLAssert((poNewest == nullptr && poOldest == nullptr) ||
+                  (poNewest != nullptr && poOldest != nullptr));
 
-        GDALRasterBlock *poLast = nullptr;
-        for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-             poBlock = poBlock->poNext)
+        if (poNewest != nullptr)
         {
-            CPLAssert(poBlock->poPrevious == poLast);
+            CPLAssert(poNewest->poPrevious == nullptr);
+            CPLAssert(poOldest->poNext == nullptr);
+
+            GDALRasterBlock *poLast = nullptr;
+            bool bInProbation = false;
+            int nCount = 0;
+            for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
+                 poBlock = poBlock->poNext)
+            {
+                CPLAssert(poBlock->poPrevious == poLast);
+                CPLAssert(poBlock->nShard == iShard);
+                if (poBlock == psShard->poMidpoint)
+                    bInProbation = true;
+                CPLAssert(!bInProbation || !poBlock->bHot);
+
+                poLast = poBlock;
+                ++nCount;
+            }
 
-            poLast = poBlock;
+            CPLAssert(poOldest == poLast);
+            CPLAssert(nCount == psShard->nBlockCount.load());
         }
-
-        CPLAssert(poOldest == poLast);
     }
 }
 
@@ -776,24 +1475,28 @@ void GDALRasterBlock::Verify()
 #ifdef notdef
 void GDALRasterBlock::CheckNonOrphanedBlocks(GDALRasterBand *poBand)
 {
-    TAKE_LOCK;
-    for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-         poBlock = poBlock->poNext)
+    const int nShardCount = GetShardCount();
+    for (int iShard = 0; iShard < nShardCount; ++iShard)
     {
-        if (poBlock->GetBand() == poBand)
+        TAKE_LOCK(&asShards[iShard]);
+        for (GDALRasterBlock *poBlock = asShards[iShard].poNewest;
+             poBlock != nullptr; poBlock = poBlock->poNext)
         {
-            printf("Cache has still blocks of band %p\n", poBand); /*ok*/
-            printf("Band : %d\n", poBand->GetBand());              /*ok*/
-            printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
-            printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
-            int nBlockXSize, nBlockYSize;
-            poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
-            printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
-            printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
-            printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
-            if (poBand->GetDataset())
-                printf("Dataset : %s\n", /*ok*/
-                       poBand->GetDataset()->GetDescription());
+            if (poBlock->GetBand() == poBand)
+            {
+                printf("Cache has still blocks of band %p\n", poBand); /*ok*/
+                printf("Band : %d\n", poBand->GetBand());          /*ok*/
+                printf("nRasterXSize = %d\n", poBand->GetXSize()); /*ok*/
+                printf("nRasterYSize = %d\n", poBand->GetYSize()); /*ok*/
+                int nBlockXSize, nBlockYSize;
+                poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+                printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
+                printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
+                printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
+                if (poBand->GetDataset())
+                    printf("Dataset : %s\n", /*ok*/
+                           poBand->GetDataset()->GetDescription());
+            }
         }
     }
 }
@@ -850,59 +1553,127 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
+    GDALRasterBlockCacheShard *psShard = &asShards[nShard];
+
     // Can be safely tested outside the lock
-    if (poNewest == this)
+    if (psShard->poNewest == this && (bHot || !IsSLRUPolicy()))
+        return;
+
+    // Lazy promotion: a block that has been moved to the head of the list
+    // since less than a quarter of the blocks of the shard have been, is
+    // recent enough to be left at its place. This avoids taking the lock of
+    // the shard for most cache hits of read-mostly workloads. nHeadEpoch is
+    // reset to 0 when the block is unlinked, inserted elsewhere than at the
+    // head or demoted from the hot segment.
+    const unsigned nBlockHeadEpoch = nHeadEpoch.load(std::memory_order_relaxed);
+    if (nBlockHeadEpoch != 0 &&
+        psShard->nHeadEpoch.load(std::memory_order_relaxed) - nBlockHeadEpoch <
+            static_cast<unsigned>(
+                psShard->nBlockCount.load(std::memory_order_relaxed)) /
+                4)
+    {
         return;
+    }
 
-    TAKE_LOCK;
+    TAKE_LOCK(psShard);
     Touch_unlocked();
 }
 
 void GDALRasterBlock::Touch_unlocked()
 
 {
+    GDALRasterBlockCacheShard &oShard = asShards[nShard];
+    const bool bSLRU = IsSLRUPolicy();
+
     // Could happen even if tested in Touch() before taking the lock
     // Scenario would be :
     // 0. this is the second block (the one pointed by poNewest->poNext)
     // 1. Thread 1 calls Touch() and poNewest != this at that point
     // 2. Thread 2 detaches poNewest
     // 3. Thread 1 arrives here
-    if (poNewest == this)
+    if (oShard.poNewest == this && (bHot || !bSLRU))
         return;
 
     // We should not try to touch a block that has been detached.
     // If that happen, corruption has already occurred.
     CPLAssert(bMustDetach);
 
-    if (poOldest == this)
-        poOldest = this->poPrevious;
-
-    if (poPrevious != nullptr)
-        poPrevious->poNext = poNext;
-
-    if (poNext != nullptr)
-        poNext->poPrevious = poPrevious;
-
-    poPrevious = nullptr;
-    poNext = poNewest;
-
-    if (poNewest != nullptr)
+    const bool bStreamingRead = tls_nStreamingReadCounter > 0;
+    const bool bIsInList =
+        poPrevious != nullptr || poNext != nullptr || oShard.poNewest == this;
+    if (bIsInList)
+    {
+        // A streaming block re-used by a regular read is no longer
+        // considered as such.
+        if (bStreaming && !bStreamingRead)
+            bStreaming = false;
+        Unlink_unlocked();
+    }
+    else
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        poNewest->poPrevious = this;
+        bStreaming = bStreamingRead;
+        nInsertEpoch = ++oShard.nInsertEpoch;
     }
-    poNewest = this;
 
-    if (poOldest == nullptr)
+    if (bSLRU)
     {
-        CPLAssert(poPrevious == nullptr && poNext == nullptr);
-        poOldest = this;
+        // Promote a probation block to the hot segment only if it is accessed
+        // again after at least half of the probation segment has been
+        // renewed since its insertion.
+        if (!bHot && bIsInList && !bStreaming &&
+            oShard.nInsertEpoch - nInsertEpoch >
+                static_cast<unsigned>(oShard.nProbationCount) / 2)
+        {
+            bHot = true;
+            oShard.nHotUsed += GetEffectiveBlockSize(GetBlockSize());
+        }
+
+        if (bHot)
+        {
+            InsertBefore_unlocked(oShard.poNewest);
+            DemoteHotBlocks_unlocked(nShard);
+        }
+        else
+        {
+            InsertBefore_unlocked(oShard.poMidpoint);
+            oShard.poMidpoint = this;
+        }
+    }
+    else
+    {
+        InsertBefore_unlocked(bStreaming ? nullptr : oShard.poNewest);
     }
+
 #ifdef ENABLE_DEBUG
     Verify();
 #endif
 }
 
+/************************************************************************/
+/*                      DemoteHotBlocks_unlocked()                      */
+/************************************************************************/
+
+// Move the oldest blocks of the hot segment to the probation segment, until
+// the hot segment fits into 3/4 of the cache share of the shard.
+void GDALRasterBlock::DemoteHotBlocks_unlocked(int nShardIdx)
+{
+    GDALRasterBlockCacheShard &oShard = asShards[nShardIdx];
+    const GIntBig nHotMax = nCacheMax / GetShardCount() / 4 * 3;
+    while (oShard.nHotUsed > nHotMax)
+    {
+        GDALRasterBlock *poHotTail = oShard.poMidpoint
+                                         ? oShard.poMidpoint->poPrevious
+                                         : oShard.poOldest;
+        if (poHotTail == nullptr || !poHotTail->bHot)
+            break;
+        poHotTail->bHot = false;
+        poHotTail->nHeadEpoch.store(0, std::memory_order_relaxed);
+        oShard.nHotUsed -= GetEffectiveBlockSize(poHotTail->GetBlockSize());
+        oShard.nProbationCount++;
+        oShard.poMidpoint = poHotTail;
+    }
+}
+
 /************************************************************************/
 /*                            Internalize()                             */
 /************************************************************************/
@@ -925,9 +1696,11 @@ CPLErr GDALRasterBlock::Internalize()
 
     void *pNewData = nullptr;
 
-    // This call will initialize the hRBLock mutex. Other call places can
+    // This call will initialize the block cache locks. Other call places can
     // only be called if we have go through there.
-    const GIntBig nCurCacheMax = GDALGetCacheMax64();
+    // Each shard is only allowed its share of the total cache size.
+    const GIntBig nCurCacheMax = GDALGetCacheMax64() / GetShardCount();
+    GDALRasterBlockCacheShard &oShard = asShards[nShard];
 
     // No risk of overflow as it is checked in GDALRasterBand::InitBlockInfo().
     const auto nSizeInBytes = GetBlockSize();
@@ -944,16 +1717,28 @@ CPLErr GDALRasterBlock::Internalize()
         GDALRasterBlock *apoBlocksToFree[64] = {nullptr};
         int nBlocksToFree = 0;
         {
-            TAKE_LOCK;
+            TAKE_LOCK(&oShard);
 
             if (bFirstIter)
-                nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
-            GDALRasterBlock *poTarget = poOldest;
-            while (nCacheUsed > nCurCacheMax)
+            {
+                oShard.nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
+                poBand->poBandBlockCache->AddCacheUsed(
+                    GetEffectiveBlockSize(nSizeInBytes));
+                if (IsStatisticsEnabled())
+                {
+                    oShard.nMisses++;
+                    poBand->poBandBlockCache->IncMisses();
+                }
+            }
+            GDALRasterBlock *poTarget = oShard.poOldest;
+            while (oShard.nCacheUsed > nCurCacheMax)
             {
                 GDALRasterBlock *poDirtyBlockOtherDataset = nullptr;
+                bool bHasSkippedProtectedBlocks = false;
                 // In this first pass, only discard dirty blocks of this
-                // dataset. We do this to decrease significantly the likelihood
+                // dataset, and skip blocks protected by the priority class
+                // or cache budget of their dataset.
+                // We do this to decrease significantly the likelihood
                 // of the following weakness of the block cache design:
                 // 1. Thread 1 fills block B with ones
                 // 2. Thread 2 evicts this dirty block, while thread 1 almost
@@ -963,7 +1748,11 @@ CPLErr GDALRasterBlock::Internalize()
                 //    so gets the old value.
                 while (poTarget != nullptr)
                 {
-                    if (!poTarget->GetDirty())
+                    if (IsProtectedFromEviction(poTarget->poCacheSettings))
+                    {
+                        bHasSkippedProtectedBlocks = true;
+                    }
+                    else if (!poTarget->GetDirty())
                     {
                         if (CPLAtomicCompareAndExchange(&(poTarget->nLockCount),
                                                         0, -1))
@@ -995,7 +1784,7 @@ CPLErr GDALRasterBlock::Internalize()
                     }
                     else
                     {
-                        poTarget = poOldest;
+                        poTarget = oShard.poOldest;
                         while (poTarget != nullptr)
                         {
                             if (CPLAtomicCompareAndExchange(
@@ -1010,6 +1799,25 @@ CPLErr GDALRasterBlock::Internalize()
                         }
                     }
                 }
+                if (poTarget == nullptr && bHasSkippedProtectedBlocks)
+                {
+                    // Only protected blocks can be evicted. Evict them in
+                    // LRU order, so that the global cache limit is honored.
+                    poTarget = oShard.poOldest;
+                    while (poTarget != nullptr)
+                    {
+                        if (!poTarget->GetDirty() ||
+                            nDisableDirtyBlockFlushCounter == 0)
+                        {
+                            if (CPLAtomicCompareAndExchange(
+                                    &(poTarget->nLockCount), 0, -1))
+                            {
+                                break;
+                            }
+                        }
+                        poTarget = poTarget->poPrevious;
+                    }
+                }
 
                 if (poTarget != nullptr)
                 {
@@ -1026,6 +1834,7 @@ CPLErr GDALRasterBlock::Internalize()
 
                     poTarget->Detach_unlocked();
                     poTarget->GetBand()->UnreferenceBlock(poTarget);
+                    oShard.nEvictions++;
 
                     apoBlocksToFree[nBlocksToFree++] = poTarget;
                     if (poTarget->GetDirty())
@@ -1033,12 +1842,12 @@ CPLErr GDALRasterBlock::Internalize()
                         // Only free one dirty block at a time so that
                         // other dirty blocks of other bands with the same
                         // coordinates can be found with TryGetLockedBlock()
-                        bLoopAgain = nCacheUsed > nCurCacheMax;
+                        bLoopAgain = oShard.nCacheUsed > nCurCacheMax;
                         break;
                     }
                     if (nBlocksToFree == 64)
                     {
-                        bLoopAgain = (nCacheUsed > nCurCacheMax);
+                        bLoopAgain = (oShard.nCacheUsed > nCurCacheMax);
                         break;
                     }
 
@@ -1056,7 +1865,17 @@ CPLErr GDALRasterBlock::Internalize()
             /* ------------------------------------------------------------------
              */
             if (!bLoopAgain)
+            {
                 Touch_unlocked();
+
+                // Account the block to the cache settings of its dataset.
+                CPLAssert(poCacheSettings == nullptr);
+                poCacheSettings =
+                    poThisDS ? poThisDS->GetBlockCacheSettings() : nullptr;
+                if (poCacheSettings)
+                    poCacheSettings->nUsed +=
+                        GetEffectiveBlockSize(nSizeInBytes);
+            }
         }
 
         bFirstIter = false;
@@ -1066,7 +1885,11 @@ CPLErr GDALRasterBlock::Internalize()
         {
             GDALRasterBlock *const poBlock = apoBlocksToFree[i];
 
-            if (poBlock->GetDirty())
+            if (!poBlock->GetDirty())
+            {
+                GDALCompressedBlockCacheStore(poBlock);
+            }
+            else
             {
                 if (bSleepsForBockCacheDebug)
                 {
@@ -1078,6 +1901,8 @@ CPLErr GDALRasterBlock::Internalize()
                         CPLSleep(dfDelay);
                 }
 
+                oShard.nDirtyBlockFlushes++;
+                poBlock->poBand->poBandBlockCache->IncDirtyBlockFlushes();
                 CPLErr eErr = poBlock->Write();
                 if (eErr != CE_None)
                 {
@@ -1095,7 +1920,7 @@ CPLErr GDALRasterBlock::Internalize()
             }
             else
             {
-                VSIFreeAligned(poBlock->pData);
+                GDALRasterBlockPoolFree(poBlock->pData);
             }
             poBlock->pData = nullptr;
 
@@ -1105,7 +1930,7 @@ CPLErr GDALRasterBlock::Internalize()
 
     if (pNewData == nullptr)
     {
-        pNewData = VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nSizeInBytes);
+        pNewData = GDALRasterBlockPoolAlloc(nSizeInBytes);
         if (pNewData == nullptr)
         {
             return (CE_Failure);
@@ -1114,6 +1939,8 @@ CPLErr GDALRasterBlock::Internalize()
 
     pData = pNewData;
 
+    WakeUpWriteBackThread(nCurCacheMax * GetShardCount());
+
     return CE_None;
 }
 
@@ -1136,6 +1963,8 @@ void GDALRasterBlock::MarkDirty()
         if (!bDirty)
             poBand->IncDirtyBlocks(1);
     }
+    if (!bDirty)
+        gnDirtyBlocks++;
     bDirty = true;
 }
 
@@ -1154,6 +1983,8 @@ void GDALRasterBlock::MarkClean()
 {
     if (bDirty && poBand)
         poBand->IncDirtyBlocks(-1);
+    if (bDirty)
+        gnDirtyBlocks--;
     bDirty = false;
 }
 
@@ -1164,9 +1995,14 @@ void GDALRasterBlock::MarkClean()
 /*! @cond Doxygen_Suppress */
 void GDALRasterBlock::DestroyRBMutex()
 {
-    if (hRBLock != nullptr)
-        DESTROY_LOCK;
-    hRBLock = nullptr;
+    StopWriteBackThread();
+    GDALRasterBlockPoolCleanup();
+    for (auto &oShard : asShards)
+    {
+        if (oShard.hLock != nullptr)
+            DESTROY_LOCK(&oShard);
+        oShard.hLock = nullptr;
+    }
 }
 /*! @endcond */
 
@@ -1213,6 +2049,11 @@ int GDALRasterBlock::TakeLock()
 
         return FALSE;
     }
+    if (IsStatisticsEnabled())
+    {
+        asShards[nShard].nHits.fetch_add(1, std::memory_order_relaxed);
+        poBand->poBandBlockCache->IncHits();
+    }
     Touch();
     return TRUE;
 }
@@ -1244,23 +2085,98 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 #endif
 
     // Wait for the block for having been unreferenced.
-    TAKE_LOCK;
+    TAKE_LOCK(&asShards[nShard]);
 
     return FALSE;
 }
 
+/************************************************************************/
+/*                         GDALRasterBlockView                          */
+/************************************************************************/
+
+/** Construct a view on a block, taking over a lock already acquired on it,
+ * for instance by GDALRasterBand::GetLockedBlockRef().
+ *
+ * @param poLockedBlock locked block, or nullptr for an empty view.
+ */
+GDALRasterBlockView::GDALRasterBlockView(GDALRasterBlock *poLockedBlock)
+    : m_poBlock(poLockedBlock)
+{
+}
+
+/** Copy constructor. Takes an additional lock on the block. */
+GDALRasterBlockView::GDALRasterBlockView(const GDALRasterBlockView &other)
+    : m_poBlock(other.m_poBlock)
+{
+    if (m_poBlock)
+        m_poBlock->AddLock();
+}
+
+/** Move constructor. */
+GDALRasterBlockView::GDALRasterBlockView(GDALRasterBlockView &&other) noexcept
+    : m_poBlock(other.m_poBlock)
+{
+    other.m_poBlock = nullptr;
+}
+
+/** Destructor. Drops the lock on the block. */
+GDALRasterBlockView::~GDALRasterBlockView()
+{
+    reset();
+}
+
+/** Copy assignment operator. */
+GDALRasterBlockView &
+GDALRasterBlockView::operator=(const GDALRasterBlockView &other)
+{
+    if (this != &other)
+    {
+        if (other.m_poBlock)
+            other.m_poBlock->AddLock();
+        reset();
+        m_poBlock = other.m_poBlock;
+    }
+    return *this;
+}
+
+/** Move assignment operator. */
+GDALRasterBlockView &
+GDALRasterBlockView::operator=(GDALRasterBlockView &&other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+        m_poBlock = other.m_poBlock;
+        other.m_poBlock = nullptr;
+    }
+    return *this;
+}
+
+/** Drop the lock on the block, and make the view empty. */
+void GDALRasterBlockView::reset()
+{
+    if (m_poBlock)
+    {
+        m_poBlock->DropLock();
+        m_poBlock = nullptr;
+    }
+}
+
 #if 0
 void GDALRasterBlock::DumpAll()
 {
     int iBlock = 0;
-    for( GDALRasterBlock *poBlock = poNewest;
-         poBlock != nullptr;
-         poBlock = poBlock->poNext )
+    for( int iShard = 0; iShard < GetShardCount(); ++iShard )
     {
-        printf("Block %d\n", iBlock);/*ok*/
-        poBlock->DumpBlock();
-        printf("\n");/*ok*/
-        iBlock++;
+        for( GDALRasterBlock *poBlock = asShards[iShard].poNewest;
+             poBlock != nullptr;
+             poBlock = poBlock->poNext )
+        {
+            printf("Block %d (shard %d)\n", iBlock, iShard);/*ok*/
+            poBlock->DumpBlock();
+            printf("\n");/*ok*/
+            iBlock++;
+        }
     }
 }
 
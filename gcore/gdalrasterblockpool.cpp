@@ -0,0 +1,305 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Pooled allocator for the data of raster blocks.
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, Even Rouault <even dot rouault at spatialys dot org>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_priv.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_vsi.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+//! @cond Doxygen_Suppress
+
+/* ******************************************************************** */
+/*                        GDALRasterBlockPool                           */
+/* ******************************************************************** */
+
+// When GDAL_BLOCK_CACHE_POOL is enabled, the data of raster blocks is
+// allocated from slabs of at least 2 MB, each holding slots of a single size
+// class (the block size rounded up to 64 bytes). Freed slots are reused by
+// later allocations of the same size class, so that steady-state use of the
+// block cache does not call malloc() / free(). Each size class keeps at most
+// one empty slab, further empty slabs being released to the system.
+// With GDAL_BLOCK_CACHE_POOL=HUGEPAGES, slabs are advised to be backed by
+// transparent huge pages, on Linux.
+
+namespace
+{
+constexpr size_t SLOT_ALIGNMENT = 64;
+constexpr size_t SLAB_ALIGNMENT = 2 * 1024 * 1024;
+constexpr size_t MIN_SLOTS_PER_SLAB = 8;
+// Larger blocks are directly allocated.
+constexpr size_t MAX_POOLED_SIZE = 16 * 1024 * 1024;
+
+struct Slab
+{
+    GByte *pabyBase = nullptr;
+    size_t nBytes = 0;
+    size_t nSlotSize = 0;
+    std::vector<int> anFreeSlots{};
+    int nUsed = 0;
+    bool bAvailable = false;  // Whether in SizeClass::apoAvailable.
+};
+
+struct SizeClass
+{
+    // Slabs that may have free slots.
+    std::vector<Slab *> apoAvailable{};
+    int nEmptySlabs = 0;
+};
+
+struct BlockPool
+{
+    std::mutex oMutex{};
+    // Indexed by the slab base address.
+    std::map<const GByte *, std::unique_ptr<Slab>> oSlabs{};
+    std::map<size_t, SizeClass> oClasses{};
+};
+}  // namespace
+
+static BlockPool &GetBlockPool()
+{
+    static BlockPool oPool;
+    return oPool;
+}
+
+/************************************************************************/
+/*                            GetPoolMode()                             */
+/************************************************************************/
+
+// 0 = disabled, 1 = enabled, 2 = enabled with transparent huge pages.
+// Read only once, as memory allocated from the pool must be freed to it.
+static int GetPoolMode()
+{
+    static const int nMode = []()
+    {
+        const char *pszPool =
+            CPLGetConfigOption("GDAL_BLOCK_CACHE_POOL", "NO");
+        if (EQUAL(pszPool, "HUGEPAGES"))
+        {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            return 2;
+#else
+            CPLDebug("GDAL", "GDAL_BLOCK_CACHE_POOL=HUGEPAGES not supported "
+                             "on this platform. Using YES");
+            return 1;
+#endif
+        }
+        return CPLTestBool(pszPool) ? 1 : 0;
+    }();
+    return nMode;
+}
+
+/************************************************************************/
+/*                             ReleaseSlab()                            */
+/************************************************************************/
+
+static void ReleaseSlab(BlockPool &oPool, SizeClass &oClass, Slab *poSlab)
+{
+    if (poSlab->bAvailable)
+    {
+        oClass.apoAvailable.erase(std::find(oClass.apoAvailable.begin(),
+                                            oClass.apoAvailable.end(), poSlab));
+    }
+    GByte *pabyBase = poSlab->pabyBase;
+    oPool.oSlabs.erase(pabyBase);
+    VSIFreeAligned(pabyBase);
+}
+
+/************************************************************************/
+/*                       GDALRasterBlockPoolAlloc()                     */
+/************************************************************************/
+
+/** Allocate the data of a raster block, from the pool if it is enabled, or
+ * with VSIMallocAlignedAuto() otherwise.
+ *
+ * Emits a CPLError() and returns nullptr in case of failure. The returned
+ * pointer must be freed with GDALRasterBlockPoolFree().
+ */
+void *GDALRasterBlockPoolAlloc(size_t nSize)
+{
+    if (GetPoolMode() == 0 || nSize == 0 || nSize > MAX_POOLED_SIZE)
+        return VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nSize);
+
+    const size_t nSlotSize = DIV_ROUND_UP(nSize, SLOT_ALIGNMENT) *
+                             SLOT_ALIGNMENT;
+
+    auto &oPool = GetBlockPool();
+    std::lock_guard<std::mutex> oLock(oPool.oMutex);
+    try
+    {
+        auto &oClass = oPool.oClasses[nSlotSize];
+        while (!oClass.apoAvailable.empty() &&
+               oClass.apoAvailable.back()->anFreeSlots.empty())
+        {
+            oClass.apoAvailable.back()->bAvailable = false;
+            oClass.apoAvailable.pop_back();
+        }
+
+        Slab *poSlab = nullptr;
+        if (!oClass.apoAvailable.empty())
+        {
+            poSlab = oClass.apoAvailable.back();
+        }
+        else
+        {
+            const size_t nBytes =
+                DIV_ROUND_UP(std::max(nSlotSize * MIN_SLOTS_PER_SLAB,
+                                      SLAB_ALIGNMENT),
+                             SLAB_ALIGNMENT) *
+                SLAB_ALIGNMENT;
+            GByte *pabyBase =
+                static_cast<GByte *>(VSIMallocAligned(SLAB_ALIGNMENT, nBytes));
+            if (pabyBase == nullptr)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate " CPL_FRMT_GUIB
+                         " bytes for block cache pool",
+                         static_cast<GUIntBig>(nBytes));
+                return nullptr;
+            }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            if (GetPoolMode() == 2)
+                madvise(pabyBase, nBytes, MADV_HUGEPAGE);
+#endif
+            auto poNewSlab = std::make_unique<Slab>();
+            poNewSlab->pabyBase = pabyBase;
+            poNewSlab->nBytes = nBytes;
+            poNewSlab->nSlotSize = nSlotSize;
+            const int nSlots = static_cast<int>(nBytes / nSlotSize);
+            poNewSlab->anFreeSlots.reserve(nSlots);
+            // Hand out slots in increasing address order.
+            for (int i = nSlots - 1; i >= 0; --i)
+                poNewSlab->anFreeSlots.push_back(i);
+            poSlab = poNewSlab.get();
+            oPool.oSlabs[pabyBase] = std::move(poNewSlab);
+            poSlab->bAvailable = true;
+            oClass.apoAvailable.push_back(poSlab);
+            oClass.nEmptySlabs++;
+        }
+
+        if (poSlab->nUsed == 0)
+            oClass.nEmptySlabs--;
+        const int iSlot = poSlab->anFreeSlots.back();
+        poSlab->anFreeSlots.pop_back();
+        poSlab->nUsed++;
+        return poSlab->pabyBase + static_cast<size_t>(iSlot) * nSlotSize;
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in block cache pool");
+        return nullptr;
+    }
+}
+
+/************************************************************************/
+/*                       GDALRasterBlockPoolFree()                      */
+/************************************************************************/
+
+/** Free data allocated with GDALRasterBlockPoolAlloc(). */
+void GDALRasterBlockPoolFree(void *pData)
+{
+    if (pData == nullptr)
+        return;
+    if (GetPoolMode() == 0)
+    {
+        VSIFreeAligned(pData);
+        return;
+    }
+
+    const GByte *pabyData = static_cast<const GByte *>(pData);
+    auto &oPool = GetBlockPool();
+    std::lock_guard<std::mutex> oLock(oPool.oMutex);
+    auto oIter = oPool.oSlabs.upper_bound(pabyData);
+    if (oIter != oPool.oSlabs.begin())
+        --oIter;
+    Slab *poSlab = oIter != oPool.oSlabs.end() ? oIter->second.get() : nullptr;
+    if (poSlab == nullptr || pabyData < poSlab->pabyBase ||
+        pabyData >= poSlab->pabyBase + poSlab->nBytes)
+    {
+        // Not pooled, because too large.
+        VSIFreeAligned(pData);
+        return;
+    }
+
+    auto &oClass = oPool.oClasses[poSlab->nSlotSize];
+    poSlab->anFreeSlots.push_back(
+        static_cast<int>((pabyData - poSlab->pabyBase) / poSlab->nSlotSize));
+    poSlab->nUsed--;
+    if (poSlab->nUsed == 0)
+    {
+        if (oClass.nEmptySlabs > 0)
+        {
+            ReleaseSlab(oPool, oClass, poSlab);
+            return;
+        }
+        oClass.nEmptySlabs++;
+    }
+    if (!poSlab->bAvailable)
+    {
+        poSlab->bAvailable = true;
+        oClass.apoAvailable.push_back(poSlab);
+    }
+}
+
+/************************************************************************/
+/*                      GDALRasterBlockPoolCleanup()                    */
+/************************************************************************/
+
+/** Release the empty slabs of the pool. */
+void GDALRasterBlockPoolCleanup()
+{
+    if (GetPoolMode() == 0)
+        return;
+
+    auto &oPool = GetBlockPool();
+    std::lock_guard<std::mutex> oLock(oPool.oMutex);
+    for (auto oIter = oPool.oSlabs.begin(); oIter != oPool.oSlabs.end();)
+    {
+        Slab *poSlab = oIter->second.get();
+        ++oIter;
+        if (poSlab->nUsed == 0)
+        {
+            auto &oClass = oPool.oClasses[poSlab->nSlotSize];
+            oClass.nEmptySlabs--;
+            ReleaseSlab(oPool, oClass, poSlab);
+        }
+    }
+}
+
+//! @endcond
@@ -0,0 +1,356 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Dataset that can be read concurrently from several threads
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, Even Rouault <even dot rouault at spatialys dot org>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_priv.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cpl_error.h"
+#include "gdal.h"
+#include "gdal_proxy.h"
+
+/** GDALThreadSafeDataset wraps a prototype dataset, and forwards each call
+    to a clone of it (see GDALDataset::Clone()) that is specific to the
+    calling thread, and lazily instantiated at its first call. Clones share
+    the process-wide caches (block cache of the file system handlers, such as
+    /vsicurl/ ones, GDAL_CACHEMAX), so that the cost of fetching the data is
+    only paid once, but each of them has its own driver state (libtiff
+    handles, codec state, etc.), which makes concurrent reads possible
+    without locking.
+*/
+
+class GDALThreadSafeRasterBand;
+
+/* ******************************************************************** */
+/*                        GDALThreadSafeDataset                         */
+/* ******************************************************************** */
+
+class GDALThreadSafeDataset final : public GDALProxyDataset
+{
+    friend class GDALThreadSafeRasterBand;
+
+    GDALDataset *m_poPrototypeDS = nullptr;
+
+    mutable std::mutex m_oMutex{};
+    mutable std::map<std::thread::id, std::unique_ptr<GDALDataset>>
+        m_oMapThreadToClone{};
+
+  protected:
+    GDALDataset *RefUnderlyingDataset() const override;
+
+    void UnrefUnderlyingDataset(GDALDataset *) const override
+    {
+    }
+
+  public:
+    GDALThreadSafeDataset(GDALDataset *poPrototypeDS,
+                          std::unique_ptr<GDALDataset> poFirstClone);
+    ~GDALThreadSafeDataset() override;
+
+    bool IsThreadSafe() const override
+    {
+        return true;
+    }
+
+  private:
+    CPL_DISALLOW_COPY_ASSIGN(GDALThreadSafeDataset)
+};
+
+/* ******************************************************************** */
+/*                       GDALThreadSafeRasterBand                       */
+/* ******************************************************************** */
+
+class GDALThreadSafeRasterBand final : public GDALProxyRasterBand
+{
+    GDALThreadSafeDataset *m_poTSDS = nullptr;
+
+    // Set for overview and mask bands, which are identified by their index
+    // (m_iOverview >= 0) or by m_bIsMask from their parent band.
+    GDALThreadSafeRasterBand *m_poParent = nullptr;
+    int m_iOverview = -1;
+    bool m_bIsMask = false;
+
+    std::vector<std::unique_ptr<GDALThreadSafeRasterBand>> m_apoOverviews{};
+    std::unique_ptr<GDALThreadSafeRasterBand> m_poMaskBand{};
+
+  protected:
+    GDALRasterBand *RefUnderlyingRasterBand(bool bForceOpen) const override;
+
+    void UnrefUnderlyingRasterBand(GDALRasterBand *) const override
+    {
+    }
+
+  public:
+    GDALThreadSafeRasterBand(GDALThreadSafeDataset *poTSDS,
+                             GDALDataset *poParentDS, int nBandIn,
+                             GDALRasterBand *poPrototypeBand,
+                             GDALThreadSafeRasterBand *poParent, int iOverview,
+                             bool bIsMask);
+
+    int GetOverviewCount() override;
+    GDALRasterBand *GetOverview(int) override;
+    GDALRasterBand *GetRasterSampleOverview(GUIntBig) override;
+    GDALRasterBand *GetMaskBand() override;
+
+  private:
+    CPL_DISALLOW_COPY_ASSIGN(GDALThreadSafeRasterBand)
+};
+
+/************************************************************************/
+/*                       GDALThreadSafeDataset()                        */
+/************************************************************************/
+
+GDALThreadSafeDataset::GDALThreadSafeDataset(
+    GDALDataset *poPrototypeDS, std::unique_ptr<GDALDataset> poFirstClone)
+    : m_poPrototypeDS(poPrototypeDS)
+{
+    nRasterXSize = poPrototypeDS->GetRasterXSize();
+    nRasterYSize = poPrototypeDS->GetRasterYSize();
+    eAccess = GA_ReadOnly;
+    SetDescription(poPrototypeDS->GetDescription());
+
+    for (int i = 1; i <= poPrototypeDS->GetRasterCount(); ++i)
+    {
+        SetBand(i, new GDALThreadSafeRasterBand(
+                       this, this, i, poPrototypeDS->GetRasterBand(i),
+                       nullptr, -1, false));
+    }
+
+    m_oMapThreadToClone[std::this_thread::get_id()] = std::move(poFirstClone);
+}
+
+/************************************************************************/
+/*                       ~GDALThreadSafeDataset()                       */
+/************************************************************************/
+
+GDALThreadSafeDataset::~GDALThreadSafeDataset()
+{
+    // Clones might share state with the prototype (e.g. MEM buffers), so
+    // they must be destroyed first.
+    m_oMapThreadToClone.clear();
+    m_poPrototypeDS->ReleaseRef();
+}
+
+/************************************************************************/
+/*                        RefUnderlyingDataset()                        */
+/************************************************************************/
+
+GDALDataset *GDALThreadSafeDataset::RefUnderlyingDataset() const
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    auto &poClone = m_oMapThreadToClone[std::this_thread::get_id()];
+    if (poClone == nullptr)
+    {
+        poClone = m_poPrototypeDS->Clone();
+        if (poClone == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot create a clone of %s for the current thread",
+                     GetDescription());
+            m_oMapThreadToClone.erase(std::this_thread::get_id());
+            return nullptr;
+        }
+    }
+    return poClone.get();
+}
+
+/************************************************************************/
+/*                      GDALThreadSafeRasterBand()                      */
+/************************************************************************/
+
+GDALThreadSafeRasterBand::GDALThreadSafeRasterBand(
+    GDALThreadSafeDataset *poTSDS, GDALDataset *poParentDS, int nBandIn,
+    GDALRasterBand *poPrototypeBand, GDALThreadSafeRasterBand *poParent,
+    int iOverview, bool bIsMask)
+    : m_poTSDS(poTSDS), m_poParent(poParent), m_iOverview(iOverview),
+      m_bIsMask(bIsMask)
+{
+    poDS = poParentDS;
+    nBand = nBandIn;
+    eAccess = GA_ReadOnly;
+    eDataType = poPrototypeBand->GetRasterDataType();
+    nRasterXSize = poPrototypeBand->GetXSize();
+    nRasterYSize = poPrototypeBand->GetYSize();
+    poPrototypeBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+
+    if (bIsMask)
+        return;
+
+    if (poParent == nullptr)
+    {
+        const int nOvrCount = poPrototypeBand->GetOverviewCount();
+        for (int i = 0; i < nOvrCount; ++i)
+        {
+            auto poOvrBand = poPrototypeBand->GetOverview(i);
+            if (poOvrBand == nullptr)
+                break;
+            m_apoOverviews.emplace_back(
+                std::make_unique<GDALThreadSafeRasterBand>(
+                    poTSDS, nullptr, nBandIn, poOvrBand, this, i, false));
+        }
+    }
+
+    auto poMaskBand = poPrototypeBand->GetMaskBand();
+    if (poMaskBand)
+    {
+        m_poMaskBand = std::make_unique<GDALThreadSafeRasterBand>(
+            poTSDS, nullptr, 0, poMaskBand, this, -1, true);
+    }
+}
+
+/************************************************************************/
+/*                      RefUnderlyingRasterBand()                       */
+/************************************************************************/
+
+GDALRasterBand *
+GDALThreadSafeRasterBand::RefUnderlyingRasterBand(bool /*bForceOpen*/) const
+{
+    if (m_poParent)
+    {
+        GDALRasterBand *poParentBand =
+            m_poParent->RefUnderlyingRasterBand(true);
+        if (poParentBand == nullptr)
+            return nullptr;
+        if (m_bIsMask)
+            return poParentBand->GetMaskBand();
+        return poParentBand->GetOverview(m_iOverview);
+    }
+    GDALDataset *poClone = m_poTSDS->RefUnderlyingDataset();
+    return poClone ? poClone->GetRasterBand(nBand) : nullptr;
+}
+
+/************************************************************************/
+/*                          GetOverviewCount()                          */
+/************************************************************************/
+
+int GDALThreadSafeRasterBand::GetOverviewCount()
+{
+    return static_cast<int>(m_apoOverviews.size());
+}
+
+/************************************************************************/
+/*                            GetOverview()                             */
+/************************************************************************/
+
+GDALRasterBand *GDALThreadSafeRasterBand::GetOverview(int iOvr)
+{
+    if (iOvr < 0 || iOvr >= static_cast<int>(m_apoOverviews.size()))
+        return nullptr;
+    return m_apoOverviews[iOvr].get();
+}
+
+/************************************************************************/
+/*                      GetRasterSampleOverview()                       */
+/************************************************************************/
+
+GDALRasterBand *
+GDALThreadSafeRasterBand::GetRasterSampleOverview(GUIntBig nDesiredSamples)
+{
+    // Use the generic implementation, which relies on GetOverview(), so as
+    // not to expose bands of the per-thread clones.
+    return GDALRasterBand::GetRasterSampleOverview(nDesiredSamples);
+}
+
+/************************************************************************/
+/*                            GetMaskBand()                             */
+/************************************************************************/
+
+GDALRasterBand *GDALThreadSafeRasterBand::GetMaskBand()
+{
+    if (m_poMaskBand)
+        return m_poMaskBand.get();
+    return GDALProxyRasterBand::GetMaskBand();
+}
+
+/************************************************************************/
+/*                    GDALCreateThreadSafeDataset()                     */
+/************************************************************************/
+
+/** Return a thread-safe dataset wrapping poPrototypeDS, and taking ownership
+ * of one reference of it. On failure, that reference is released, an error
+ * is emitted and nullptr is returned.
+ */
+GDALDataset *GDALCreateThreadSafeDataset(GDALDataset *poPrototypeDS)
+{
+    if (poPrototypeDS->IsThreadSafe())
+        return poPrototypeDS;
+
+    std::unique_ptr<GDALDataset> poFirstClone;
+    if (poPrototypeDS->GetRasterCount() > 0 && poPrototypeDS->CanBeCloned())
+    {
+        poPrototypeDS->FlushCache(false);
+        poFirstClone = poPrototypeDS->Clone();
+    }
+    if (poFirstClone == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "%s cannot be opened in thread-safe mode",
+                 poPrototypeDS->GetDescription());
+        poPrototypeDS->ReleaseRef();
+        return nullptr;
+    }
+    return new GDALThreadSafeDataset(poPrototypeDS, std::move(poFirstClone));
+}
+
+/************************************************************************/
+/*                      GDALGetThreadSafeDataset()                      */
+/************************************************************************/
+
+/** Return a dataset whose raster read API can be used concurrently from
+ * several threads, and that gives access to the same raster data as hDS.
+ *
+ * Each thread calling the returned dataset transparently uses its own clone
+ * of hDS (see GDALDataset::Clone()), created at its first call. This is
+ * supported for datasets of the GTiff, VRT and MEM drivers, and of drivers
+ * declaring GDAL_DCAP_PARALLEL_CLONE_READ, in read-only mode. The returned
+ * dataset is read-only, and hDS must not be modified while it is in use.
+ *
+ * If hDS is already thread-safe (see GDALDatasetIsThreadSafe()), a new
+ * reference to it is returned.
+ *
+ * The returned dataset must be closed with GDALClose(). It holds a
+ * reference on hDS, so hDS may be closed before it.
+ *
+ * GDALOpenEx() with GDAL_OF_THREAD_SAFE is a shortcut for GDALOpenEx()
+ * followed by GDALGetThreadSafeDataset().
+ *
+ * @param hDS Source dataset.
+ * @return a thread-safe dataset, or NULL in case of error.
+ * @since GDAL 3.9
+ */
+GDALDatasetH GDALGetThreadSafeDataset(GDALDatasetH hDS)
+{
+    VALIDATE_POINTER1(hDS, __func__, nullptr);
+    auto poDS = GDALDataset::FromHandle(hDS);
+    poDS->Reference();
+    return GDALDataset::ToHandle(GDALCreateThreadSafeDataset(poDS));
+}
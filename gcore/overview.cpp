@@ -51,6 +51,7 @@
 #include "gdal.h"
 #include "gdal_thread_pool.h"
 #include "gdalwarper.h"
+#include "memdataset.h"
 
 // Restrict to 64bit processors because they are guaranteed to have SSE2,
 // or if __AVX2__ is defined.
@@ -1973,6 +1974,63 @@ static CPLErr GDALResampleChunk_Gauss(
     const int nChunkBottomYOff = nChunkYOff + nChunkYSize;
     const int nDstXWidth = nDstXOff2 - nDstXOff;
 
+    /* -------------------------------------------------------------------- */
+    /*      The source columns of a destination pixel do not depend on      */
+    /*      the line, so compute them once.                                 */
+    /* -------------------------------------------------------------------- */
+    std::vector<int> anSrcXOff(nDstXWidth);
+    std::vector<int> anSrcXOff2(nDstXWidth);
+    std::vector<int> anXShiftGaussMatrix(nDstXWidth);
+    for (int iDstPixel = nDstXOff; iDstPixel < nDstXOff2; ++iDstPixel)
+    {
+        int nSrcXOff = static_cast<int>(0.5 + iDstPixel * dfXRatioDstToSrc);
+        int nSrcXOff2 =
+            static_cast<int>(0.5 + (iDstPixel + 1) * dfXRatioDstToSrc) + 1;
+
+        if (nSrcXOff < nChunkXOff)
+        {
+            nSrcXOff = nChunkXOff;
+            nSrcXOff2++;
+        }
+
+        const int iSizeX = nSrcXOff2 - nSrcXOff;
+        nSrcXOff = nSrcXOff + iSizeX / 2 - nGaussMatrixDim / 2;
+        nSrcXOff2 = nSrcXOff + nGaussMatrixDim;
+
+        if (nSrcXOff2 > nChunkRightXOff ||
+            (dfXRatioDstToSrc > 1 && iDstPixel == nOXSize - 1))
+        {
+            nSrcXOff2 = std::min(nChunkRightXOff, nSrcXOff + nGaussMatrixDim);
+        }
+
+        int nXShiftGaussMatrix = 0;
+        if (nSrcXOff < nChunkXOff)
+        {
+            nXShiftGaussMatrix = -(nSrcXOff - nChunkXOff);
+            nSrcXOff = nChunkXOff;
+        }
+
+        anSrcXOff[iDstPixel - nDstXOff] = nSrcXOff;
+        anSrcXOff2[iDstPixel - nDstXOff] = nSrcXOff2;
+        anXShiftGaussMatrix[iDstPixel - nDstXOff] = nXShiftGaussMatrix;
+    }
+
+#ifdef USE_SSE2
+    GInt64 nTotalGaussWeight = 0;
+    for (int i = 0; i < nGaussMatrixDim * nGaussMatrixDim; ++i)
+        nTotalGaussWeight += panGaussMatrix[i];
+
+    // Whether the whole filter kernel applies to a destination pixel.
+    const auto IsFullKernelColumn =
+        [&anSrcXOff, &anSrcXOff2, &anXShiftGaussMatrix,
+         nGaussMatrixDim](int iDstPixelIdx)
+    {
+        return anXShiftGaussMatrix[iDstPixelIdx] == 0 &&
+               anSrcXOff2[iDstPixelIdx] - anSrcXOff[iDstPixelIdx] ==
+                   nGaussMatrixDim;
+    };
+#endif
+
     /* ==================================================================== */
     /*      Loop over destination scanlines.                                */
     /* ==================================================================== */
@@ -2019,35 +2077,54 @@ static CPLErr GDALResampleChunk_Gauss(
          */
         double *const padfDstScanline =
             padfDstBuffer + (iDstLine - nDstYOff) * nDstXWidth;
+#ifdef USE_SSE2
+        const bool bFullKernelLine =
+            poColorTable == nullptr && pabySrcScanlineNodataMask == nullptr &&
+            nYShiftGaussMatrix == 0 && nSrcYOff2 - nSrcYOff == nGaussMatrixDim;
+#endif
         for (int iDstPixel = nDstXOff; iDstPixel < nDstXOff2; ++iDstPixel)
         {
-            int nSrcXOff = static_cast<int>(0.5 + iDstPixel * dfXRatioDstToSrc);
-            int nSrcXOff2 =
-                static_cast<int>(0.5 + (iDstPixel + 1) * dfXRatioDstToSrc) + 1;
-
-            if (nSrcXOff < nChunkXOff)
-            {
-                nSrcXOff = nChunkXOff;
-                nSrcXOff2++;
-            }
-
-            const int iSizeX = nSrcXOff2 - nSrcXOff;
-            nSrcXOff = nSrcXOff + iSizeX / 2 - nGaussMatrixDim / 2;
-            nSrcXOff2 = nSrcXOff + nGaussMatrixDim;
+            const int nSrcXOff = anSrcXOff[iDstPixel - nDstXOff];
+            const int nSrcXOff2 = anSrcXOff2[iDstPixel - nDstXOff];
+            const int nXShiftGaussMatrix =
+                anXShiftGaussMatrix[iDstPixel - nDstXOff];
 
-            if (nSrcXOff2 > nChunkRightXOff ||
-                (dfXRatioDstToSrc > 1 && iDstPixel == nOXSize - 1))
-            {
-                nSrcXOff2 =
-                    std::min(nChunkRightXOff, nSrcXOff + nGaussMatrixDim);
-            }
-
-            int nXShiftGaussMatrix = 0;
-            if (nSrcXOff < nChunkXOff)
+#ifdef USE_SSE2
+            // Process two destination pixels at once, each lane doing the
+            // same sequence of operations as the generic code below.
+            if (bFullKernelLine && iDstPixel + 1 < nDstXOff2 &&
+                IsFullKernelColumn(iDstPixel - nDstXOff) &&
+                IsFullKernelColumn(iDstPixel + 1 - nDstXOff))
             {
-                nXShiftGaussMatrix = -(nSrcXOff - nChunkXOff);
-                nSrcXOff = nChunkXOff;
+                const double *padfSrc0 =
+                    padfSrcScanline + (nSrcXOff - nChunkXOff);
+                const double *padfSrc1 =
+                    padfSrcScanline +
+                    (anSrcXOff[iDstPixel + 1 - nDstXOff] - nChunkXOff);
+                const int *panLineWeight = panGaussMatrix;
+                __m128d total = _mm_setzero_pd();
+                for (int j = 0; j < nGaussMatrixDim; ++j)
+                {
+                    for (int i = 0; i < nGaussMatrixDim; ++i)
+                    {
+                        const __m128d val = _mm_loadh_pd(
+                            _mm_load_sd(padfSrc0 + i), padfSrc1 + i);
+                        const __m128d weight =
+                            _mm_set1_pd(static_cast<double>(panLineWeight[i]));
+                        total = _mm_add_pd(total, _mm_mul_pd(val, weight));
+                    }
+                    panLineWeight += nGaussMatrixDim;
+                    padfSrc0 += nChunkXSize;
+                    padfSrc1 += nChunkXSize;
+                }
+                _mm_storeu_pd(padfDstScanline + (iDstPixel - nDstXOff),
+                              _mm_div_pd(total,
+                                         _mm_set1_pd(static_cast<double>(
+                                             nTotalGaussWeight))));
+                ++iDstPixel;
+                continue;
             }
+#endif
 
             if (poColorTable == nullptr)
             {
@@ -2158,6 +2235,148 @@ static CPLErr GDALResampleChunk_Gauss(
     return CE_None;
 }
 
+/************************************************************************/
+/*                          ModeIndexHistogram()                        */
+/************************************************************************/
+
+// Returns the index of the value of paVals[0..nCount-1] that is the first one
+// to reach the highest number of occurrences. panHistogram must have one
+// zero-initialized entry per possible value, and is zeroed again on return.
+template <class T>
+static inline int ModeIndexHistogram(const T *paVals, int nCount,
+                                     int *panHistogram)
+{
+    int nMaxCount = 0;
+    int iMaxIdx = 0;
+    for (int i = 0; i < nCount; ++i)
+    {
+        const int nValCount = ++panHistogram[paVals[i]];
+        if (nValCount > nMaxCount)
+        {
+            nMaxCount = nValCount;
+            iMaxIdx = i;
+        }
+    }
+    for (int i = 0; i < nCount; ++i)
+        panHistogram[paVals[i]] = 0;
+    return iMaxIdx;
+}
+
+#ifdef USE_SSE2
+
+// Lane i of a 16-byte load at abyLaneGE + 16 - j is set iff i >= j, and
+// lane i of a load at abyLaneLT + 16 - n is set iff i < n.
+static const GByte abyLaneGE[] = {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+static const GByte abyLaneLT[] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0};
+static const GUInt16 anLaneGE[] = {
+    0,      0,      0,      0,      0,      0,      0,      0,
+    0,      0,      0,      0,      0,      0,      0,      0,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF};
+
+/************************************************************************/
+/*                       ModeIndexFromRanksSSE2()                       */
+/************************************************************************/
+
+// ranks contains, for each of the 16 lanes, the number of occurrences of the
+// value of the lane in the lanes up to it (or 0 for unused lanes). The first
+// lane that reaches the maximum rank holds the mode.
+static inline int ModeIndexFromRanksSSE2(__m128i ranks)
+{
+    __m128i maxRank = _mm_max_epu8(ranks, _mm_srli_si128(ranks, 8));
+    maxRank = _mm_max_epu8(maxRank, _mm_srli_si128(maxRank, 4));
+    maxRank = _mm_max_epu8(maxRank, _mm_srli_si128(maxRank, 2));
+    maxRank = _mm_max_epu8(maxRank, _mm_srli_si128(maxRank, 1));
+    maxRank = _mm_set1_epi8(static_cast<char>(_mm_cvtsi128_si32(maxRank)));
+    int nMask = _mm_movemask_epi8(_mm_cmpeq_epi8(ranks, maxRank));
+    int iIdx = 0;
+    while ((nMask & 1) == 0)
+    {
+        nMask >>= 1;
+        ++iIdx;
+    }
+    return iIdx;
+}
+
+/************************************************************************/
+/*                         ModeIndexUpTo16SSE2()                        */
+/************************************************************************/
+
+// Same as ModeIndexHistogram() for 1 <= nCount <= 16. pabyVals must have
+// room for 16 values.
+static inline int ModeIndexUpTo16SSE2(const GByte *pabyVals, int nCount)
+{
+    const __m128i vals =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(pabyVals));
+    __m128i ranks = _mm_setzero_si128();
+    for (int j = 0; j < nCount; ++j)
+    {
+        const __m128i eq =
+            _mm_cmpeq_epi8(vals, _mm_set1_epi8(static_cast<char>(pabyVals[j])));
+        const __m128i laneGE = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(abyLaneGE + 16 - j));
+        // -1 in lanes >= j that have the same value as lane j
+        ranks = _mm_sub_epi8(ranks, _mm_and_si128(eq, laneGE));
+    }
+    ranks = _mm_and_si128(ranks,
+                          _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                              abyLaneLT + 16 - nCount)));
+    return ModeIndexFromRanksSSE2(ranks);
+}
+
+// Same as ModeIndexHistogram() for 1 <= nCount <= 16. panVals must have
+// room for 16 values.
+static inline int ModeIndexUpTo16SSE2(const GUInt16 *panVals, int nCount)
+{
+    const __m128i vals0 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(panVals));
+    const __m128i vals1 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(panVals + 8));
+    __m128i ranks0 = _mm_setzero_si128();
+    __m128i ranks1 = _mm_setzero_si128();
+    for (int j = 0; j < nCount; ++j)
+    {
+        const __m128i val = _mm_set1_epi16(static_cast<short>(panVals[j]));
+        const __m128i laneGE0 = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(anLaneGE + 16 - j));
+        const __m128i laneGE1 = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(anLaneGE + 24 - j));
+        ranks0 = _mm_sub_epi16(
+            ranks0, _mm_and_si128(_mm_cmpeq_epi16(vals0, val), laneGE0));
+        ranks1 = _mm_sub_epi16(
+            ranks1, _mm_and_si128(_mm_cmpeq_epi16(vals1, val), laneGE1));
+    }
+    // Ranks are at most 16, so they can be packed to bytes.
+    __m128i ranks = _mm_packs_epi16(ranks0, ranks1);
+    ranks = _mm_and_si128(ranks,
+                          _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                              abyLaneLT + 16 - nCount)));
+    return ModeIndexFromRanksSSE2(ranks);
+}
+
+#endif  // USE_SSE2
+
+/************************************************************************/
+/*                              ModeIndex()                             */
+/************************************************************************/
+
+template <class T>
+static inline int ModeIndex(const T *paVals, int nCount, int *panHistogram)
+{
+#ifdef USE_SSE2
+    // Covers in particular 2x2 and 4x4 windows
+    if (nCount <= 16)
+        return ModeIndexUpTo16SSE2(paVals, nCount);
+#endif
+    return ModeIndexHistogram(paVals, nCount, panHistogram);
+}
+
 /************************************************************************/
 /*                      GDALResampleChunk_Mode()                        */
 /************************************************************************/
@@ -2187,6 +2406,13 @@ static CPLErr GDALResampleChunk_Mode_T(
     const int nChunkRightXOff = nChunkXOff + nChunkXSize;
     const int nChunkBottomYOff = nChunkYOff + nChunkYSize;
     std::vector<int> anVals(256, 0);
+    std::vector<GByte> abyVals;
+    // Histogram for the values of integer types, in the generic case.
+    std::vector<int> anHistogram;
+
+    const bool bByteValues =
+        eSrcDataType == GDT_Byte &&
+        !(poColorTable && poColorTable->GetColorEntryCount() > 256);
 
     /* ==================================================================== */
     /*      Loop over destination scanlines.                                */
@@ -2264,29 +2490,31 @@ static CPLErr GDALResampleChunk_Mode_T(
             if (nSrcXOff2 > nChunkRightXOff)
                 nSrcXOff2 = nChunkRightXOff;
 
-            if (eSrcDataType != GDT_Byte ||
-                (poColorTable && poColorTable->GetColorEntryCount() > 256))
+            if (nSrcYOff2 - nSrcYOff <= 0 || nSrcXOff2 - nSrcXOff <= 0 ||
+                nSrcYOff2 - nSrcYOff > INT_MAX / (nSrcXOff2 - nSrcXOff) ||
+                static_cast<size_t>(nSrcYOff2 - nSrcYOff) *
+                        static_cast<size_t>(nSrcXOff2 - nSrcXOff) >
+                    std::numeric_limits<size_t>::max() / sizeof(float))
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "Too big downsampling factor");
+                CPLFree(padfVals);
+                CPLFree(panSums);
+                return CE_Failure;
+            }
+            // Make room for at least 16 values for ModeIndex()
+            const size_t nNumPx =
+                std::max(static_cast<size_t>(16),
+                         static_cast<size_t>(nSrcYOff2 - nSrcYOff) *
+                             static_cast<size_t>(nSrcXOff2 - nSrcXOff));
+
+            if (!bByteValues)
             {
                 // Not sure how much sense it makes to run a majority
                 // filter on floating point data, but here it is for the sake
                 // of compatibility. It won't look right on RGB images by the
                 // nature of the filter.
 
-                if (nSrcYOff2 - nSrcYOff <= 0 || nSrcXOff2 - nSrcXOff <= 0 ||
-                    nSrcYOff2 - nSrcYOff > INT_MAX / (nSrcXOff2 - nSrcXOff) ||
-                    static_cast<size_t>(nSrcYOff2 - nSrcYOff) *
-                            static_cast<size_t>(nSrcXOff2 - nSrcXOff) >
-                        std::numeric_limits<size_t>::max() / sizeof(float))
-                {
-                    CPLError(CE_Failure, CPLE_NotSupported,
-                             "Too big downsampling factor");
-                    CPLFree(padfVals);
-                    CPLFree(panSums);
-                    return CE_Failure;
-                }
-                const size_t nNumPx =
-                    static_cast<size_t>(nSrcYOff2 - nSrcYOff) *
-                    static_cast<size_t>(nSrcXOff2 - nSrcXOff);
                 size_t iMaxInd = 0;
                 size_t iMaxVal = 0;
                 bool biMaxValdValid = false;
@@ -2310,6 +2538,47 @@ static CPLErr GDALResampleChunk_Mode_T(
                     nMaxNumPx = nNumPx;
                 }
 
+                if constexpr (std::numeric_limits<T>::is_integer)
+                {
+                    // Collect the valid values, and find the most frequent
+                    // one with an histogram or a SIMD kernel.
+                    int nCount = 0;
+                    for (int iY = nSrcYOff; iY < nSrcYOff2; ++iY)
+                    {
+                        const GPtrDiff_t iTotYOff =
+                            static_cast<GPtrDiff_t>(iY - nSrcYOff) *
+                                nChunkXSize -
+                            nChunkXOff;
+                        for (int iX = nSrcXOff; iX < nSrcXOff2; ++iX)
+                        {
+                            if (pabySrcScanlineNodataMask == nullptr ||
+                                pabySrcScanlineNodataMask[iX + iTotYOff])
+                            {
+                                padfVals[nCount++] =
+                                    paSrcScanline[iX + iTotYOff];
+                            }
+                        }
+                    }
+
+                    if (nCount == 0)
+                    {
+                        paDstScanline[iDstPixel - nDstXOff] = tNoDataValue;
+                    }
+                    else
+                    {
+                        if (anHistogram.empty())
+                        {
+                            anHistogram.resize(
+                                static_cast<size_t>(
+                                    std::numeric_limits<T>::max()) +
+                                1);
+                        }
+                        paDstScanline[iDstPixel - nDstXOff] = padfVals
+                            [ModeIndex(padfVals, nCount, anHistogram.data())];
+                    }
+                    continue;
+                }
+
                 for (int iY = nSrcYOff; iY < nSrcYOff2; ++iY)
                 {
                     const GPtrDiff_t iTotYOff =
@@ -2325,13 +2594,17 @@ static CPLErr GDALResampleChunk_Mode_T(
 
                             // Check array for existing entry.
                             for (; i < iMaxInd; ++i)
-                                if (padfVals[i] == dfVal &&
-                                    ++panSums[i] > panSums[iMaxVal])
+                            {
+                                if (padfVals[i] == dfVal)
                                 {
-                                    iMaxVal = i;
-                                    biMaxValdValid = true;
+                                    if (++panSums[i] > panSums[iMaxVal])
+                                    {
+                                        iMaxVal = i;
+                                        biMaxValdValid = true;
+                                    }
                                     break;
                                 }
+                            }
 
                             // Add to arr if entry not already there.
                             if (i == iMaxInd)
@@ -2360,13 +2633,9 @@ static CPLErr GDALResampleChunk_Mode_T(
             {
                 // So we go here for a paletted or non-paletted byte band.
                 // The input values are then between 0 and 255.
-                int nMaxVal = 0;
-                int iMaxInd = -1;
-
-                // The cost of this zeroing might be high. Perhaps we should
-                // just use the above generic case, and go to this one if the
-                // number of source pixels is large enough
-                std::fill(anVals.begin(), anVals.end(), 0);
+                if (abyVals.size() < nNumPx)
+                    abyVals.resize(nNumPx);
+                int nCount = 0;
 
                 for (int iY = nSrcYOff; iY < nSrcYOff2; ++iY)
                 {
@@ -2378,23 +2647,17 @@ static CPLErr GDALResampleChunk_Mode_T(
                         const T val = paSrcScanline[iX + iTotYOff];
                         if (!bHasNoData || val != tNoDataValue)
                         {
-                            int nVal = static_cast<int>(val);
-                            if (++anVals[nVal] > nMaxVal)
-                            {
-                                // Sum the density.
-                                // Is it the most common value so far?
-                                iMaxInd = nVal;
-                                nMaxVal = anVals[nVal];
-                            }
+                            abyVals[nCount++] = static_cast<GByte>(val);
                         }
                     }
                 }
 
-                if (iMaxInd == -1)
+                if (nCount == 0)
                     paDstScanline[iDstPixel - nDstXOff] = tNoDataValue;
                 else
-                    paDstScanline[iDstPixel - nDstXOff] =
-                        static_cast<T>(iMaxInd);
+                    paDstScanline[iDstPixel - nDstXOff] = static_cast<T>(
+                        abyVals[ModeIndex(abyVals.data(), nCount,
+                                          anVals.data())]);
             }
         }
     }
@@ -3217,8 +3480,159 @@ static CPLErr GDALResampleChunk_ConvolutionT(
 #ifdef USE_SSE2
     bool bSrcPixelCountLess8 = dfXScaledRadius < 4;
 #endif
+
+    // Compute the convolution coefficients of the source pixels
+    // [nSrcPixelStart, nSrcPixelStop[ and return their sum.
+    const auto ComputeHorizontalWeights =
+        [padfWeights, dfXScaleWeight, pfnFilterFunc,
+         pfnFilterFunc4Values](double dfSrcPixel, int nSrcPixelStart,
+                               int nSrcPixelStop)
+    {
+        double dfWeightSum = 0.0;
+        int nSrcPixel = nSrcPixelStart;
+        double dfX = dfXScaleWeight * (nSrcPixel - dfSrcPixel + 0.5);
+        for (; nSrcPixel + 3 < nSrcPixelStop; nSrcPixel += 4)
+        {
+            padfWeights[nSrcPixel - nSrcPixelStart] = dfX;
+            dfX += dfXScaleWeight;
+            padfWeights[nSrcPixel + 1 - nSrcPixelStart] = dfX;
+            dfX += dfXScaleWeight;
+            padfWeights[nSrcPixel + 2 - nSrcPixelStart] = dfX;
+            dfX += dfXScaleWeight;
+            padfWeights[nSrcPixel + 3 - nSrcPixelStart] = dfX;
+            dfX += dfXScaleWeight;
+            dfWeightSum +=
+                pfnFilterFunc4Values(padfWeights + nSrcPixel - nSrcPixelStart);
+        }
+        for (; nSrcPixel < nSrcPixelStop; ++nSrcPixel, dfX += dfXScaleWeight)
+        {
+            const double dfWeight = pfnFilterFunc(dfX);
+            padfWeights[nSrcPixel - nSrcPixelStart] = dfWeight;
+            dfWeightSum += dfWeight;
+        }
+        return dfWeightSum;
+    };
+
+    // Fast path for power-of-two downsampling factors, which is the most
+    // common case: all the destination pixels whose source window is not
+    // truncated by the chunk use the same convolution coefficients, which are
+    // computed only once, and the rows of the chunk are processed in
+    // sequence. As all the computations of source offsets are exact with
+    // such factors, this gives the same results as the generic code below.
+    int nFastDstXOff = nDstXOff;
+    int nFastDstXOff2 = nDstXOff;
+    const int nXFactor = dfXRatioDstToSrc >= 2 && dfXRatioDstToSrc < nChunkXSize
+                             ? static_cast<int>(dfXRatioDstToSrc)
+                             : 0;
+    if (pabyChunkNodataMask == nullptr && dfSrcXDelta == 0 && nXFactor > 0 &&
+        dfXRatioDstToSrc == nXFactor && (nXFactor & (nXFactor - 1)) == 0)
+    {
+        for (int iDstPixel = nDstXOff; iDstPixel < nDstXOff2; ++iDstPixel)
+        {
+            const double dfSrcPixel = (iDstPixel + 0.5) * dfXRatioDstToSrc;
+            const int nSrcPixelStart =
+                static_cast<int>(floor(dfSrcPixel - dfXScaledRadius + 0.5));
+            const int nSrcPixelStop =
+                static_cast<int>(dfSrcPixel + dfXScaledRadius + 0.5);
+            if (nSrcPixelStart >= nChunkXOff &&
+                nSrcPixelStop <= nChunkRightXOff)
+            {
+                if (nFastDstXOff == nFastDstXOff2)
+                    nFastDstXOff = iDstPixel;
+                nFastDstXOff2 = iDstPixel + 1;
+            }
+        }
+    }
+    if (nFastDstXOff < nFastDstXOff2)
+    {
+        const double dfSrcPixel = (nFastDstXOff + 0.5) * dfXRatioDstToSrc;
+        const int nSrcPixelStart =
+            static_cast<int>(floor(dfSrcPixel - dfXScaledRadius + 0.5));
+        const int nSrcPixelStop =
+            static_cast<int>(dfSrcPixel + dfXScaledRadius + 0.5);
+        const int nSrcPixelCount = nSrcPixelStop - nSrcPixelStart;
+        const double dfWeightSum =
+            ComputeHorizontalWeights(dfSrcPixel, nSrcPixelStart, nSrcPixelStop);
+        if (dfWeightSum != 0)
+        {
+            const double dfInvWeightSum = 1.0 / dfWeightSum;
+            for (int i = 0; i < nSrcPixelCount; ++i)
+                padfWeights[i] *= dfInvWeightSum;
+        }
+
+        const int nFastDstXCount = nFastDstXOff2 - nFastDstXOff;
+        const int nTotalLines = nChunkYSize * nBands;
+        int iSrcLineOff = 0;
+        for (; iSrcLineOff + 2 < nTotalLines; iSrcLineOff += 3)
+        {
+            const T *pChunkRow =
+                pChunk + static_cast<GPtrDiff_t>(iSrcLineOff) * nChunkXSize +
+                (nSrcPixelStart - nChunkXOff);
+            double *const padfDstRow =
+                padfHorizontalFiltered +
+                static_cast<size_t>(iSrcLineOff) * nDstXSize +
+                (nFastDstXOff - nDstXOff);
+            for (int i = 0; i < nFastDstXCount;
+                 ++i, pChunkRow += nXFactor)
+            {
+                double dfVal1 = 0.0;
+                double dfVal2 = 0.0;
+                double dfVal3 = 0.0;
+#ifdef USE_SSE2
+                if (nSrcPixelCount == 4)
+                {
+                    GDALResampleConvolutionHorizontalPixelCount4_3rows(
+                        pChunkRow, pChunkRow + nChunkXSize,
+                        pChunkRow + 2 * nChunkXSize, padfWeights, dfVal1,
+                        dfVal2, dfVal3);
+                }
+                else if (bSrcPixelCountLess8)
+                {
+                    GDALResampleConvolutionHorizontalPixelCountLess8_3rows(
+                        pChunkRow, pChunkRow + nChunkXSize,
+                        pChunkRow + 2 * nChunkXSize, padfWeights,
+                        nSrcPixelCount, dfVal1, dfVal2, dfVal3);
+                }
+                else
+#endif
+                {
+                    GDALResampleConvolutionHorizontal_3rows(
+                        pChunkRow, pChunkRow + nChunkXSize,
+                        pChunkRow + 2 * nChunkXSize, padfWeights,
+                        nSrcPixelCount, dfVal1, dfVal2, dfVal3);
+                }
+                padfDstRow[i] = dfVal1;
+                padfDstRow[i + nDstXSize] = dfVal2;
+                padfDstRow[i + 2 * static_cast<size_t>(nDstXSize)] = dfVal3;
+            }
+        }
+        for (; iSrcLineOff < nTotalLines; ++iSrcLineOff)
+        {
+            const T *pChunkRow =
+                pChunk + static_cast<GPtrDiff_t>(iSrcLineOff) * nChunkXSize +
+                (nSrcPixelStart - nChunkXOff);
+            double *const padfDstRow =
+                padfHorizontalFiltered +
+                static_cast<size_t>(iSrcLineOff) * nDstXSize +
+                (nFastDstXOff - nDstXOff);
+            for (int i = 0; i < nFastDstXCount;
+                 ++i, pChunkRow += nXFactor)
+            {
+                padfDstRow[i] = GDALResampleConvolutionHorizontal(
+                    pChunkRow, padfWeights, nSrcPixelCount);
+            }
+        }
+    }
+
     for (int iDstPixel = nDstXOff; iDstPixel < nDstXOff2; ++iDstPixel)
     {
+        if (iDstPixel == nFastDstXOff && nFastDstXOff < nFastDstXOff2)
+        {
+            // Already done by the fast path
+            iDstPixel = nFastDstXOff2 - 1;
+            continue;
+        }
+
         const double dfSrcPixel =
             (iDstPixel + 0.5) * dfXRatioDstToSrc + dfSrcXDelta;
         int nSrcPixelStart =
@@ -3240,30 +3654,10 @@ static CPLErr GDALResampleChunk_ConvolutionT(
         }
 #endif
         const int nSrcPixelCount = nSrcPixelStop - nSrcPixelStart;
-        double dfWeightSum = 0.0;
 
         // Compute convolution coefficients.
-        int nSrcPixel = nSrcPixelStart;
-        double dfX = dfXScaleWeight * (nSrcPixel - dfSrcPixel + 0.5);
-        for (; nSrcPixel + 3 < nSrcPixelStop; nSrcPixel += 4)
-        {
-            padfWeights[nSrcPixel - nSrcPixelStart] = dfX;
-            dfX += dfXScaleWeight;
-            padfWeights[nSrcPixel + 1 - nSrcPixelStart] = dfX;
-            dfX += dfXScaleWeight;
-            padfWeights[nSrcPixel + 2 - nSrcPixelStart] = dfX;
-            dfX += dfXScaleWeight;
-            padfWeights[nSrcPixel + 3 - nSrcPixelStart] = dfX;
-            dfX += dfXScaleWeight;
-            dfWeightSum +=
-                pfnFilterFunc4Values(padfWeights + nSrcPixel - nSrcPixelStart);
-        }
-        for (; nSrcPixel < nSrcPixelStop; ++nSrcPixel, dfX += dfXScaleWeight)
-        {
-            const double dfWeight = pfnFilterFunc(dfX);
-            padfWeights[nSrcPixel - nSrcPixelStart] = dfWeight;
-            dfWeightSum += dfWeight;
-        }
+        double dfWeightSum =
+            ComputeHorizontalWeights(dfSrcPixel, nSrcPixelStart, nSrcPixelStop);
 
         const int nHeight = nChunkYSize * nBands;
         if (pabyChunkNodataMask == nullptr)
@@ -4981,6 +5375,89 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
     return eErr;
 }
 
+/************************************************************************/
+/*                    CreateOverviewCascadeDataset()                    */
+/************************************************************************/
+
+// Create a MEM dataset that receives a copy of the pixels written into the
+// bands of an overview level, so that the next level can be computed from it
+// rather than by reading back the level. Returns nullptr when the pixels read
+// back could differ from the ones written, or when the level is too large.
+static std::unique_ptr<GDALDataset>
+CreateOverviewCascadeDataset(const std::vector<GDALRasterBand *> &apoOvrBands)
+{
+    GDALRasterBand *poFirstBand = apoOvrBands[0];
+    const int nXSize = poFirstBand->GetXSize();
+    const int nYSize = poFirstBand->GetYSize();
+    const GDALDataType eDT = poFirstBand->GetRasterDataType();
+
+    // Only configurable for debug / testing
+    const double dfMaxSize =
+        CPLAtof(CPLGetConfigOption("GDAL_OVR_CASCADE_MAX_SIZE", "104857600"));
+    if (static_cast<double>(nXSize) * nYSize * apoOvrBands.size() *
+            GDALGetDataTypeSizeBytes(eDT) >
+        dfMaxSize)
+    {
+        return nullptr;
+    }
+
+    GDALDataset *poOvrDS = poFirstBand->GetDataset();
+    const char *pszCompress =
+        poOvrDS ? poOvrDS->GetMetadataItem("COMPRESSION", "IMAGE_STRUCTURE")
+                : nullptr;
+    if (pszCompress &&
+        (strstr(pszCompress, "JPEG") || strstr(pszCompress, "WEBP") ||
+         strstr(pszCompress, "LERC") || strstr(pszCompress, "JXL")))
+    {
+        // Potentially lossy compression
+        return nullptr;
+    }
+
+    for (auto *poOvrBand : apoOvrBands)
+    {
+        const int nMaskFlags = poOvrBand->GetMaskFlags();
+        if ((nMaskFlags != GMF_ALL_VALID && nMaskFlags != GMF_NODATA) ||
+            poOvrBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE") != nullptr)
+        {
+            return nullptr;
+        }
+    }
+
+    std::unique_ptr<GDALDataset> poMemDS;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        poMemDS.reset(MEMDataset::Create("", nXSize, nYSize,
+                                         static_cast<int>(apoOvrBands.size()),
+                                         eDT, nullptr));
+    }
+    if (!poMemDS)
+        return nullptr;
+
+    for (int iBand = 0; iBand < static_cast<int>(apoOvrBands.size()); ++iBand)
+    {
+        GDALRasterBand *poOvrBand = apoOvrBands[iBand];
+        if (poOvrBand->GetMaskFlags() != GMF_NODATA)
+            continue;
+        GDALRasterBand *poMemBand = poMemDS->GetRasterBand(iBand + 1);
+        if (eDT == GDT_Int64)
+        {
+            poMemBand->SetNoDataValueAsInt64(
+                poOvrBand->GetNoDataValueAsInt64());
+        }
+        else if (eDT == GDT_UInt64)
+        {
+            poMemBand->SetNoDataValueAsUInt64(
+                poOvrBand->GetNoDataValueAsUInt64());
+        }
+        else
+        {
+            poMemBand->SetNoDataValue(poOvrBand->GetNoDataValue());
+        }
+    }
+    return poMemDS;
+}
+
 /************************************************************************/
 /*            GDALRegenerateOverviewsMultiBand()                        */
 /************************************************************************/
@@ -5193,6 +5670,8 @@ CPLErr GDALRegenerateOverviewsMultiBand(
     // Second pass to do the real job.
     double dfCurPixelCount = 0;
     CPLErr eErr = CE_None;
+    // In-memory copy of the previous overview level, if any.
+    std::unique_ptr<GDALDataset> poPrevCascadeDS;
     for (int iOverview = 0; iOverview < nOverviews && eErr == CE_None;
          ++iOverview)
     {
@@ -5243,6 +5722,54 @@ CPLErr GDALRegenerateOverviewsMultiBand(
             iSrcOverview = iOverview - 1;
         }
 
+        std::vector<GDALRasterBand *> apoSrcBands(nBands);
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            if (iSrcOverview == -1)
+                apoSrcBands[iBand] = papoSrcBands[iBand];
+            else if (poPrevCascadeDS)
+                apoSrcBands[iBand] = poPrevCascadeDS->GetRasterBand(iBand + 1);
+            else
+                apoSrcBands[iBand] = papapoOverviewBands[iBand][iSrcOverview];
+        }
+
+        // If this level is fully regenerated and is the source of the next
+        // one, keep a copy of it in memory to avoid reading it back.
+        std::unique_ptr<GDALDataset> poCascadeDS;
+        if (!bIsMask && iOverview + 1 < nOverviews &&
+            papapoOverviewBands[0][iOverview + 1]->GetXSize() <
+                nDstTotalWidth &&
+            nDstXOffStart == 0 && nDstXOffEnd == nDstTotalWidth &&
+            nDstYOffStart == 0 && nDstYOffEnd == nDstTotalHeight)
+        {
+            std::vector<GDALRasterBand *> apoOvrBands(nBands);
+            for (int iBand = 0; iBand < nBands; ++iBand)
+                apoOvrBands[iBand] = papapoOverviewBands[iBand][iOverview];
+            poCascadeDS = CreateOverviewCascadeDataset(apoOvrBands);
+        }
+
+        // Source chunks can be read by a worker thread, while the main thread
+        // writes the previous chunks, only if the source bands belong to a
+        // dataset that is not written to.
+        bool bAsyncRead = poJobQueue != nullptr;
+        if (bAsyncRead && iSrcOverview >= 0)
+        {
+            bAsyncRead = poPrevCascadeDS != nullptr;
+        }
+        else if (bAsyncRead)
+        {
+            GDALDataset *poSrcDS = papoSrcBands[0]->GetDataset();
+            bAsyncRead =
+                poSrcDS != nullptr && poSrcDS->GetAccess() == GA_ReadOnly;
+            for (int iBand = 0; iBand < nBands && bAsyncRead; ++iBand)
+            {
+                bAsyncRead =
+                    papoSrcBands[iBand]->GetDataset() == poSrcDS &&
+                    papapoOverviewBands[iBand][iOverview]->GetDataset() !=
+                        poSrcDS;
+            }
+        }
+
         const double dfXRatioDstToSrc =
             static_cast<double>(nSrcWidth) / nDstTotalWidth;
         const double dfYRatioDstToSrc =
@@ -5309,6 +5836,7 @@ CPLErr GDALRegenerateOverviewsMultiBand(
             int nDstYOff = 0;
             int nDstYOff2 = 0;
             GDALRasterBand *poOverview = nullptr;
+            GDALRasterBand *poCascadeBand = nullptr;
             const char *pszResampling = nullptr;
             bool bHasNoData = false;
             double dfNoDataValue = 0.0;
@@ -5353,13 +5881,24 @@ CPLErr GDALRegenerateOverviewsMultiBand(
         // Function to write resample data to target band
         const auto WriteJobData = [](const OvrJob *poJob)
         {
-            return poJob->poOverview->RasterIO(
+            CPLErr l_eErr = poJob->poOverview->RasterIO(
                 GF_Write, poJob->nDstXOff, poJob->nDstYOff,
                 poJob->nDstXOff2 - poJob->nDstXOff,
                 poJob->nDstYOff2 - poJob->nDstYOff, poJob->pDstBuffer,
                 poJob->nDstXOff2 - poJob->nDstXOff,
                 poJob->nDstYOff2 - poJob->nDstYOff, poJob->eDstBufferDataType,
                 0, 0, nullptr);
+            if (l_eErr == CE_None && poJob->poCascadeBand)
+            {
+                l_eErr = poJob->poCascadeBand->RasterIO(
+                    GF_Write, poJob->nDstXOff, poJob->nDstYOff,
+                    poJob->nDstXOff2 - poJob->nDstXOff,
+                    poJob->nDstYOff2 - poJob->nDstYOff, poJob->pDstBuffer,
+                    poJob->nDstXOff2 - poJob->nDstXOff,
+                    poJob->nDstYOff2 - poJob->nDstYOff,
+                    poJob->eDstBufferDataType, 0, 0, nullptr);
+            }
+            return l_eErr;
         };
 
         // Wait for completion of oldest job and serialize it
@@ -5387,12 +5926,22 @@ CPLErr GDALRegenerateOverviewsMultiBand(
         // Queue of jobs
         std::list<std::unique_ptr<OvrJob>> jobList;
 
-        std::vector<void *> apaChunk(nBands);
-        std::vector<GByte *> apabyChunkNoDataMask(nBands);
+        // Destination window of a chunk, and source window to read for it
+        struct ChunkWindow
+        {
+            int nDstXOff = 0;
+            int nDstXCount = 0;
+            int nDstYOff = 0;
+            int nDstYCount = 0;
+            int nChunkXOffQueried = 0;
+            int nChunkXSizeQueried = 0;
+            int nChunkYOffQueried = 0;
+            int nChunkYSizeQueried = 0;
+        };
 
         // Iterate on destination overview, block by block.
-        for (int nDstYOff = nDstYOffStart;
-             nDstYOff < nDstYOffEnd && eErr == CE_None;
+        std::vector<ChunkWindow> asChunks;
+        for (int nDstYOff = nDstYOffStart; nDstYOff < nDstYOffEnd;
              nDstYOff += nDstChunkYSize)
         {
             int nDstYCount;
@@ -5421,16 +5970,8 @@ CPLErr GDALRegenerateOverviewsMultiBand(
                 nChunkYSizeQueried = nSrcHeight - nChunkYOffQueried;
             CPLAssert(nChunkYSizeQueried <= nFullResYChunkQueried);
 
-            if (!pfnProgress(dfCurPixelCount / dfTotalPixelCount, nullptr,
-                             pProgressData))
-            {
-                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                eErr = CE_Failure;
-            }
-
             // Iterate on destination overview, block by block.
-            for (int nDstXOff = nDstXOffStart;
-                 nDstXOff < nDstXOffEnd && eErr == CE_None;
+            for (int nDstXOff = nDstXOffStart; nDstXOff < nDstXOffEnd;
                  nDstXOff += nDstChunkXSize)
             {
                 int nDstXCount = 0;
@@ -5439,8 +5980,6 @@ CPLErr GDALRegenerateOverviewsMultiBand(
                 else
                     nDstXCount = nDstXOffEnd - nDstXOff;
 
-                dfCurPixelCount += static_cast<double>(nDstXCount) * nDstYCount;
-
                 int nChunkXOff = static_cast<int>(nDstXOff * dfXRatioDstToSrc);
                 int nChunkXOff2 = static_cast<int>(
                     ceil((nDstXOff + nDstXCount) * dfXRatioDstToSrc));
@@ -5461,148 +6000,320 @@ CPLErr GDALRegenerateOverviewsMultiBand(
                 if (nChunkXSizeQueried + nChunkXOffQueried > nSrcWidth)
                     nChunkXSizeQueried = nSrcWidth - nChunkXOffQueried;
                 CPLAssert(nChunkXSizeQueried <= nFullResXChunkQueried);
-#if DEBUG_VERBOSE
-                CPLDebug("GDAL",
-                         "Reading (%dx%d -> %dx%d) for output (%dx%d -> %dx%d)",
-                         nChunkXOffQueried, nChunkYOffQueried,
-                         nChunkXSizeQueried, nChunkYSizeQueried, nDstXOff,
-                         nDstYOff, nDstXCount, nDstYCount);
-#endif
 
-                // Avoid accumulating too many tasks and exhaust RAM
+                ChunkWindow sChunk;
+                sChunk.nDstXOff = nDstXOff;
+                sChunk.nDstXCount = nDstXCount;
+                sChunk.nDstYOff = nDstYOff;
+                sChunk.nDstYCount = nDstYCount;
+                sChunk.nChunkXOffQueried = nChunkXOffQueried;
+                sChunk.nChunkXSizeQueried = nChunkXSizeQueried;
+                sChunk.nChunkYOffQueried = nChunkYOffQueried;
+                sChunk.nChunkYSizeQueried = nChunkYSizeQueried;
+                asChunks.push_back(sChunk);
+            }
+        }
 
-                // Try to complete already finished jobs
-                while (eErr == CE_None && !jobList.empty())
-                {
-                    auto poOldestJob = jobList.front().get();
-                    {
-                        std::lock_guard<std::mutex> oGuard(poOldestJob->mutex);
-                        if (!poOldestJob->bFinished)
-                        {
-                            break;
-                        }
-                    }
-                    eErr = poOldestJob->eErr;
-                    if (eErr == CE_None)
-                    {
-                        eErr = WriteJobData(poOldestJob);
-                    }
+        // Structure describing the reading of the source buffers of a chunk
+        struct ReadJob
+        {
+            const std::vector<GDALRasterBand *> *papoSrcBands = nullptr;
+            bool bUseNoDataMask = false;
+            GDALDataType eWrkDataType = GDT_Unknown;
+            ChunkWindow sWindow{};
 
-                    jobList.pop_front();
-                }
+            // Buffers owned by the job until they are taken by OvrJob
+            std::vector<void *> apaChunk{};
+            std::vector<GByte *> apabyChunkNoDataMask{};
+
+            CPLErr eErr = CE_Failure;
 
-                // And in case we have saturated the number of threads,
-                // wait for completion of tasks to go below the threshold.
-                while (eErr == CE_None &&
-                       jobList.size() >= static_cast<size_t>(nThreads))
+            // Synchronization
+            bool bFinished = false;
+            std::mutex mutex{};
+            std::condition_variable cv{};
+
+            ReadJob() = default;
+            ReadJob(const ReadJob &) = delete;
+            ReadJob &operator=(const ReadJob &) = delete;
+
+            ~ReadJob()
+            {
+                for (void *pChunk : apaChunk)
+                    CPLFree(pChunk);
+                for (GByte *pabyMask : apabyChunkNoDataMask)
+                    CPLFree(pabyMask);
+            }
+        };
+
+        // Thread function to read the source buffers for all the bands.
+        const auto JobReadFunc = [](void *pData)
+        {
+            ReadJob *poJob = static_cast<ReadJob *>(pData);
+            const ChunkWindow &sW = poJob->sWindow;
+
+            CPLErr l_eErr = CE_None;
+            for (size_t iBand = 0;
+                 iBand < poJob->papoSrcBands->size() && l_eErr == CE_None;
+                 ++iBand)
+            {
+                GDALRasterBand *poSrcBand = (*poJob->papoSrcBands)[iBand];
+                l_eErr = poSrcBand->RasterIO(
+                    GF_Read, sW.nChunkXOffQueried, sW.nChunkYOffQueried,
+                    sW.nChunkXSizeQueried, sW.nChunkYSizeQueried,
+                    poJob->apaChunk[iBand], sW.nChunkXSizeQueried,
+                    sW.nChunkYSizeQueried, poJob->eWrkDataType, 0, 0, nullptr);
+
+                if (poJob->bUseNoDataMask && l_eErr == CE_None)
                 {
-                    eErr = WaitAndFinalizeOldestJob(jobList);
+                    auto poMaskBand = poSrcBand->IsMaskBand()
+                                          ? poSrcBand
+                                          : poSrcBand->GetMaskBand();
+                    l_eErr = poMaskBand->RasterIO(
+                        GF_Read, sW.nChunkXOffQueried, sW.nChunkYOffQueried,
+                        sW.nChunkXSizeQueried, sW.nChunkYSizeQueried,
+                        poJob->apabyChunkNoDataMask[iBand],
+                        sW.nChunkXSizeQueried, sW.nChunkYSizeQueried, GDT_Byte,
+                        0, 0, nullptr);
                 }
+            }
+            poJob->eErr = l_eErr;
 
-                // (Re)allocate buffers if needed
-                for (int iBand = 0; iBand < nBands; ++iBand)
+            {
+                std::lock_guard<std::mutex> guard(poJob->mutex);
+                poJob->bFinished = true;
+                poJob->cv.notify_one();
+            }
+        };
+
+        // (Re)allocate buffers of a read job if needed
+        const auto AllocateReadBuffers =
+            [nBands, nFullResXChunkQueried, nFullResYChunkQueried,
+             eWrkDataType, bUseNoDataMask](ReadJob *poJob)
+        {
+            poJob->apaChunk.resize(nBands);
+            poJob->apabyChunkNoDataMask.resize(nBands);
+            for (int iBand = 0; iBand < nBands; ++iBand)
+            {
+                if (poJob->apaChunk[iBand] == nullptr)
                 {
-                    if (apaChunk[iBand] == nullptr)
+                    poJob->apaChunk[iBand] = VSI_MALLOC3_VERBOSE(
+                        nFullResXChunkQueried, nFullResYChunkQueried,
+                        GDALGetDataTypeSizeBytes(eWrkDataType));
+                    if (poJob->apaChunk[iBand] == nullptr)
                     {
-                        apaChunk[iBand] = VSI_MALLOC3_VERBOSE(
-                            nFullResXChunkQueried, nFullResYChunkQueried,
-                            GDALGetDataTypeSizeBytes(eWrkDataType));
-                        if (apaChunk[iBand] == nullptr)
-                        {
-                            eErr = CE_Failure;
-                        }
+                        return false;
                     }
-                    if (bUseNoDataMask &&
-                        apabyChunkNoDataMask[iBand] == nullptr)
+                }
+                if (bUseNoDataMask &&
+                    poJob->apabyChunkNoDataMask[iBand] == nullptr)
+                {
+                    poJob->apabyChunkNoDataMask[iBand] =
+                        static_cast<GByte *>(VSI_MALLOC2_VERBOSE(
+                            nFullResXChunkQueried, nFullResYChunkQueried));
+                    if (poJob->apabyChunkNoDataMask[iBand] == nullptr)
                     {
-                        apabyChunkNoDataMask[iBand] =
-                            static_cast<GByte *>(VSI_MALLOC2_VERBOSE(
-                                nFullResXChunkQueried, nFullResYChunkQueried));
-                        if (apabyChunkNoDataMask[iBand] == nullptr)
-                        {
-                            eErr = CE_Failure;
-                        }
+                        return false;
                     }
                 }
+            }
+            return true;
+        };
 
-                // Read the source buffers for all the bands.
-                for (int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand)
+        // Wait for completion of a read job
+        const auto WaitReadJob = [](ReadJob *poJob)
+        {
+            std::unique_lock<std::mutex> oGuard(poJob->mutex);
+            while (!poJob->bFinished)
+            {
+                poJob->cv.wait(oGuard);
+            }
+        };
+
+        // Submit the reading of a chunk to the thread pool
+        const auto SubmitReadJob =
+            [&apoSrcBands, bUseNoDataMask, eWrkDataType, &poJobQueue,
+             &AllocateReadBuffers, &JobReadFunc](const ChunkWindow &sWindow)
+        {
+            auto poJob = std::unique_ptr<ReadJob>(new ReadJob());
+            poJob->papoSrcBands = &apoSrcBands;
+            poJob->bUseNoDataMask = bUseNoDataMask;
+            poJob->eWrkDataType = eWrkDataType;
+            poJob->sWindow = sWindow;
+            if (!AllocateReadBuffers(poJob.get()))
+                return std::unique_ptr<ReadJob>(nullptr);
+            poJobQueue->SubmitJob(JobReadFunc, poJob.get());
+            return poJob;
+        };
+
+        // Used when reading chunks synchronously
+        ReadJob oSyncReadJob;
+        oSyncReadJob.papoSrcBands = &apoSrcBands;
+        oSyncReadJob.bUseNoDataMask = bUseNoDataMask;
+        oSyncReadJob.eWrkDataType = eWrkDataType;
+
+        // When reading asynchronously, reading of the next chunk is done
+        // while the current one is resampled and the previous ones written.
+        std::unique_ptr<ReadJob> poNextReadJob;
+        if (bAsyncRead && !asChunks.empty())
+        {
+            poNextReadJob = SubmitReadJob(asChunks[0]);
+        }
+
+        for (size_t iChunk = 0; iChunk < asChunks.size() && eErr == CE_None;
+             ++iChunk)
+        {
+            const ChunkWindow &sChunk = asChunks[iChunk];
+            const int nDstXOff = sChunk.nDstXOff;
+            const int nDstXCount = sChunk.nDstXCount;
+            const int nDstYOff = sChunk.nDstYOff;
+            const int nDstYCount = sChunk.nDstYCount;
+
+            if (nDstXOff == nDstXOffStart &&
+                !pfnProgress(dfCurPixelCount / dfTotalPixelCount, nullptr,
+                             pProgressData))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                eErr = CE_Failure;
+                break;
+            }
+
+            dfCurPixelCount += static_cast<double>(nDstXCount) * nDstYCount;
+
+#if DEBUG_VERBOSE
+            CPLDebug("GDAL",
+                     "Reading (%dx%d -> %dx%d) for output (%dx%d -> %dx%d)",
+                     sChunk.nChunkXOffQueried, sChunk.nChunkYOffQueried,
+                     sChunk.nChunkXSizeQueried, sChunk.nChunkYSizeQueried,
+                     nDstXOff, nDstYOff, nDstXCount, nDstYCount);
+#endif
+
+            // Avoid accumulating too many tasks and exhaust RAM
+
+            // Try to complete already finished jobs
+            while (eErr == CE_None && !jobList.empty())
+            {
+                auto poOldestJob = jobList.front().get();
                 {
-                    GDALRasterBand *poSrcBand = nullptr;
-                    if (iSrcOverview == -1)
-                        poSrcBand = papoSrcBands[iBand];
-                    else
-                        poSrcBand = papapoOverviewBands[iBand][iSrcOverview];
-                    eErr = poSrcBand->RasterIO(
-                        GF_Read, nChunkXOffQueried, nChunkYOffQueried,
-                        nChunkXSizeQueried, nChunkYSizeQueried, apaChunk[iBand],
-                        nChunkXSizeQueried, nChunkYSizeQueried, eWrkDataType, 0,
-                        0, nullptr);
-
-                    if (bUseNoDataMask && eErr == CE_None)
+                    std::lock_guard<std::mutex> oGuard(poOldestJob->mutex);
+                    if (!poOldestJob->bFinished)
                     {
-                        auto poMaskBand = poSrcBand->IsMaskBand()
-                                              ? poSrcBand
-                                              : poSrcBand->GetMaskBand();
-                        eErr = poMaskBand->RasterIO(
-                            GF_Read, nChunkXOffQueried, nChunkYOffQueried,
-                            nChunkXSizeQueried, nChunkYSizeQueried,
-                            apabyChunkNoDataMask[iBand], nChunkXSizeQueried,
-                            nChunkYSizeQueried, GDT_Byte, 0, 0, nullptr);
+                        break;
                     }
                 }
+                eErr = poOldestJob->eErr;
+                if (eErr == CE_None)
+                {
+                    eErr = WriteJobData(poOldestJob);
+                }
 
-                // Compute the resulting overview block.
-                for (int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand)
+                jobList.pop_front();
+            }
+
+            // And in case we have saturated the number of threads,
+            // wait for completion of tasks to go below the threshold.
+            while (eErr == CE_None &&
+                   jobList.size() >= static_cast<size_t>(nThreads))
+            {
+                eErr = WaitAndFinalizeOldestJob(jobList);
+            }
+            if (eErr != CE_None)
+                break;
+
+            // Get the source buffers for all the bands.
+            std::unique_ptr<ReadJob> poCurReadJob;
+            ReadJob *poReadJob = &oSyncReadJob;
+            if (bAsyncRead)
+            {
+                poCurReadJob = std::move(poNextReadJob);
+                if (!poCurReadJob)
                 {
-                    auto poJob = std::unique_ptr<OvrJob>(new OvrJob());
-                    poJob->pfnResampleFn = pfnResampleFn;
-                    poJob->dfXRatioDstToSrc = dfXRatioDstToSrc;
-                    poJob->dfYRatioDstToSrc = dfYRatioDstToSrc;
-                    poJob->eWrkDataType = eWrkDataType;
-                    poJob->pChunk = apaChunk[iBand];
-                    poJob->pabyChunkNodataMask = apabyChunkNoDataMask[iBand];
-                    poJob->nChunkXOff = nChunkXOffQueried;
-                    poJob->nChunkXSize = nChunkXSizeQueried;
-                    poJob->nChunkYOff = nChunkYOffQueried;
-                    poJob->nChunkYSize = nChunkYSizeQueried;
-                    poJob->nDstXOff = nDstXOff;
-                    poJob->nDstXOff2 = nDstXOff + nDstXCount;
-                    poJob->nDstYOff = nDstYOff;
-                    poJob->nDstYOff2 = nDstYOff + nDstYCount;
-                    poJob->poOverview = papapoOverviewBands[iBand][iOverview];
-                    poJob->pszResampling = pszResampling;
-                    poJob->bHasNoData = pabHasNoData[iBand];
-                    poJob->dfNoDataValue = padfNoDataValue[iBand];
-                    poJob->eSrcDataType = eDataType;
-                    poJob->bPropagateNoData = bPropagateNoData;
-
-                    if (poJobQueue)
-                    {
-                        poJob->oSrcMaskBufferHolder.reset(
-                            new PointerHolder(apabyChunkNoDataMask[iBand]));
-                        apabyChunkNoDataMask[iBand] = nullptr;
+                    eErr = CE_Failure;
+                    break;
+                }
+                WaitReadJob(poCurReadJob.get());
+                eErr = poCurReadJob->eErr;
+                if (eErr == CE_None && iChunk + 1 < asChunks.size())
+                {
+                    poNextReadJob = SubmitReadJob(asChunks[iChunk + 1]);
+                }
+                poReadJob = poCurReadJob.get();
+            }
+            else
+            {
+                oSyncReadJob.sWindow = sChunk;
+                if (!AllocateReadBuffers(&oSyncReadJob))
+                {
+                    eErr = CE_Failure;
+                }
+                else
+                {
+                    JobReadFunc(&oSyncReadJob);
+                    eErr = oSyncReadJob.eErr;
+                }
+            }
 
-                        poJob->oSrcBufferHolder.reset(
-                            new PointerHolder(apaChunk[iBand]));
-                        apaChunk[iBand] = nullptr;
+            // Compute the resulting overview block.
+            for (int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand)
+            {
+                auto poJob = std::unique_ptr<OvrJob>(new OvrJob());
+                poJob->pfnResampleFn = pfnResampleFn;
+                poJob->dfXRatioDstToSrc = dfXRatioDstToSrc;
+                poJob->dfYRatioDstToSrc = dfYRatioDstToSrc;
+                poJob->eWrkDataType = eWrkDataType;
+                poJob->pChunk = poReadJob->apaChunk[iBand];
+                poJob->pabyChunkNodataMask =
+                    poReadJob->apabyChunkNoDataMask[iBand];
+                poJob->nChunkXOff = sChunk.nChunkXOffQueried;
+                poJob->nChunkXSize = sChunk.nChunkXSizeQueried;
+                poJob->nChunkYOff = sChunk.nChunkYOffQueried;
+                poJob->nChunkYSize = sChunk.nChunkYSizeQueried;
+                poJob->nDstXOff = nDstXOff;
+                poJob->nDstXOff2 = nDstXOff + nDstXCount;
+                poJob->nDstYOff = nDstYOff;
+                poJob->nDstYOff2 = nDstYOff + nDstYCount;
+                poJob->poOverview = papapoOverviewBands[iBand][iOverview];
+                poJob->poCascadeBand =
+                    poCascadeDS ? poCascadeDS->GetRasterBand(iBand + 1)
+                                : nullptr;
+                poJob->pszResampling = pszResampling;
+                poJob->bHasNoData = pabHasNoData[iBand];
+                poJob->dfNoDataValue = padfNoDataValue[iBand];
+                poJob->eSrcDataType = eDataType;
+                poJob->bPropagateNoData = bPropagateNoData;
+
+                if (poJobQueue)
+                {
+                    poJob->oSrcMaskBufferHolder.reset(new PointerHolder(
+                        poReadJob->apabyChunkNoDataMask[iBand]));
+                    poReadJob->apabyChunkNoDataMask[iBand] = nullptr;
 
-                        poJobQueue->SubmitJob(JobResampleFunc, poJob.get());
-                        jobList.emplace_back(std::move(poJob));
-                    }
-                    else
+                    poJob->oSrcBufferHolder.reset(
+                        new PointerHolder(poReadJob->apaChunk[iBand]));
+                    poReadJob->apaChunk[iBand] = nullptr;
+
+                    poJobQueue->SubmitJob(JobResampleFunc, poJob.get());
+                    jobList.emplace_back(std::move(poJob));
+                }
+                else
+                {
+                    JobResampleFunc(poJob.get());
+                    eErr = poJob->eErr;
+                    if (eErr == CE_None)
                     {
-                        JobResampleFunc(poJob.get());
-                        eErr = poJob->eErr;
-                        if (eErr == CE_None)
-                        {
-                            eErr = WriteJobData(poJob.get());
-                        }
+                        eErr = WriteJobData(poJob.get());
                     }
                 }
             }
         }
 
+        // Wait for the read job that might still be pending after an error
+        if (poNextReadJob)
+        {
+            WaitReadJob(poNextReadJob.get());
+            poNextReadJob.reset();
+        }
+
         // Wait for all pending jobs to complete
         while (!jobList.empty())
         {
@@ -5614,11 +6325,10 @@ CPLErr GDALRegenerateOverviewsMultiBand(
         // Flush the data to overviews.
         for (int iBand = 0; iBand < nBands; ++iBand)
         {
-            CPLFree(apaChunk[iBand]);
             papapoOverviewBands[iBand][iOverview]->FlushCache(false);
-
-            CPLFree(apabyChunkNoDataMask[iBand]);
         }
+
+        poPrevCascadeDS = std::move(poCascadeDS);
     }
 
     CPLFree(pabHasNoData);
@@ -41,22 +41,37 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
 #include <stdexcept>
 #include <type_traits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_cpu_features.h"
 #include "cpl_error.h"
+#include "cpl_multiproc.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "gdal_vrt.h"
 #include "gdalwarper.h"
 #include "memdataset.h"
 #include "vrtdataset.h"
 
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+#include "rasterio_avx2.h"
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 static void GDALFastCopyByte(const GByte *CPL_RESTRICT pSrcData,
                              int nSrcPixelStride, GByte *CPL_RESTRICT pDstData,
                              int nDstPixelStride, GPtrDiff_t nWordCount);
@@ -999,6 +1014,32 @@ static int GDALRasterIOTransformer(void *pTransformerArg, int bDstToSrc,
 /************************************************************************/
 
 //! @cond Doxygen_Suppress
+
+namespace
+{
+// Stand-in for the destination band given to the overview resampling
+// functions, which only query its dimensions, data type and NBITS. The
+// resampled chunks are copied by the caller directly into its buffer.
+class GDALResampledBufferBand final : public GDALRasterBand
+{
+  public:
+    GDALResampledBufferBand(int nXSize, int nYSize, GDALDataType eDT)
+    {
+        nRasterXSize = nXSize;
+        nRasterYSize = nYSize;
+        eDataType = eDT;
+        nBlockXSize = nXSize;
+        nBlockYSize = 1;
+    }
+
+  protected:
+    CPLErr IReadBlock(int, int, void *) override
+    {
+        return CE_Failure;
+    }
+};
+}  // namespace
+
 CPLErr GDALRasterBand::RasterIOResampled(
     GDALRWFlag /* eRWFlag */, int nXOff, int nYOff, int nXSize, int nYSize,
     void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
@@ -1048,44 +1089,44 @@ CPLErr GDALRasterBand::RasterIOResampled(
         nDestYOffVirtual = static_cast<int>(dfDestYOff + 0.5);
     }
 
-    // Create a MEM dataset that wraps the output buffer.
-    GDALDataset *poMEMDS;
-    void *pTempBuffer = nullptr;
-    GSpacing nPSMem = nPixelSpace;
-    GSpacing nLSMem = nLineSpace;
-    void *pDataMem = pData;
-    GDALDataType eDTMem = eBufType;
-    if (eBufType != eDataType)
-    {
-        nPSMem = GDALGetDataTypeSizeBytes(eDataType);
-        nLSMem = nPSMem * nBufXSize;
-        pTempBuffer =
-            VSI_MALLOC2_VERBOSE(nBufYSize, static_cast<size_t>(nLSMem));
-        if (pTempBuffer == nullptr)
-            return CE_Failure;
-        pDataMem = pTempBuffer;
-        eDTMem = eDataType;
-    }
-
-    poMEMDS =
-        MEMDataset::Create("", nDestXOffVirtual + nBufXSize,
-                           nDestYOffVirtual + nBufYSize, 0, eDTMem, nullptr);
-    GByte *pabyData = static_cast<GByte *>(pDataMem) -
-                      nPSMem * nDestXOffVirtual - nLSMem * nDestYOffVirtual;
-    GDALRasterBandH hMEMBand = MEMCreateRasterBandEx(
-        poMEMDS, 1, pabyData, eDTMem, nPSMem, nLSMem, false);
-    poMEMDS->SetBand(1, GDALRasterBand::FromHandle(hMEMBand));
-
-    const char *pszNBITS = GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
-    if (pszNBITS)
-        reinterpret_cast<GDALRasterBand *>(hMEMBand)->SetMetadataItem(
-            "NBITS", pszNBITS, "IMAGE_STRUCTURE");
-
     CPLErr eErr = CE_None;
 
     // Do the resampling.
     if (bUseWarp)
     {
+        // Create a MEM dataset that wraps the output buffer.
+        GDALDataset *poMEMDS;
+        void *pTempBuffer = nullptr;
+        GSpacing nPSMem = nPixelSpace;
+        GSpacing nLSMem = nLineSpace;
+        void *pDataMem = pData;
+        GDALDataType eDTMem = eBufType;
+        if (eBufType != eDataType)
+        {
+            nPSMem = GDALGetDataTypeSizeBytes(eDataType);
+            nLSMem = nPSMem * nBufXSize;
+            pTempBuffer =
+                VSI_MALLOC2_VERBOSE(nBufYSize, static_cast<size_t>(nLSMem));
+            if (pTempBuffer == nullptr)
+                return CE_Failure;
+            pDataMem = pTempBuffer;
+            eDTMem = eDataType;
+        }
+
+        poMEMDS = MEMDataset::Create("", nDestXOffVirtual + nBufXSize,
+                                     nDestYOffVirtual + nBufYSize, 0, eDTMem,
+                                     nullptr);
+        GByte *pabyData = static_cast<GByte *>(pDataMem) -
+                          nPSMem * nDestXOffVirtual - nLSMem * nDestYOffVirtual;
+        GDALRasterBandH hMEMBand = MEMCreateRasterBandEx(
+            poMEMDS, 1, pabyData, eDTMem, nPSMem, nLSMem, false);
+        poMEMDS->SetBand(1, GDALRasterBand::FromHandle(hMEMBand));
+
+        const char *pszNBITS = GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
+        if (pszNBITS)
+            reinterpret_cast<GDALRasterBand *>(hMEMBand)->SetMetadataItem(
+                "NBITS", pszNBITS, "IMAGE_STRUCTURE");
+
         int bHasNoData = FALSE;
         double dfNoDataValue = GetNoDataValue(&bHasNoData);
 
@@ -1197,6 +1238,16 @@ CPLErr GDALRasterBand::RasterIOResampled(
 
         if (hVRTDS)
             GDALClose(hVRTDS);
+
+        if (eBufType != eDataType)
+        {
+            CPL_IGNORE_RET_VAL(poMEMDS->GetRasterBand(1)->RasterIO(
+                GF_Read, nDestXOffVirtual, nDestYOffVirtual, nBufXSize,
+                nBufYSize, pData, nBufXSize, nBufYSize, eBufType, nPixelSpace,
+                nLineSpace, nullptr));
+        }
+        GDALClose(poMEMDS);
+        VSIFree(pTempBuffer);
     }
     else
     {
@@ -1241,10 +1292,11 @@ CPLErr GDALRasterBand::RasterIOResampled(
                 (static_cast<GIntBig>(nFullResXChunk) * nFullResYChunk <=
                  1024 * 1024))
                 break;
-            // When operating on the full width of a raster whose block width is
-            // the raster width, prefer doing chunks in height.
-            if (nFullResXChunk >= nXSize && nXSize == nBlockXSize &&
-                nDstBlockYSize > 1)
+            // When operating on the full width, prefer doing chunks in
+            // height, as long as they span at least a row of source blocks,
+            // so that each source block is read only once.
+            if (nFullResXChunk >= nXSize && nDstBlockYSize > 1 &&
+                (nXSize == nBlockXSize || nFullResYChunk / 2 >= nBlockYSize))
                 nDstBlockYSize /= 2;
             /* Otherwise cut the maximal dimension */
             else if (nDstBlockXSize > 1 &&
@@ -1287,13 +1339,60 @@ CPLErr GDALRasterBand::RasterIOResampled(
         if (pChunk == nullptr ||
             (bUseNoDataMask && pabyChunkNoDataMask == nullptr))
         {
-            GDALClose(poMEMDS);
             CPLFree(pChunk);
             CPLFree(pabyChunkNoDataMask);
-            VSIFree(pTempBuffer);
             return CE_Failure;
         }
 
+        // The resampled chunks are directly copied into the output buffer,
+        // instead of going through a temporary buffer of the whole output
+        // window. When the buffer data type is not the band one, the values
+        // are first converted to the band data type, so that rounding and
+        // clamping are the ones of a read at full resolution.
+        GDALResampledBufferBand oDstBand(nDestXOffVirtual + nBufXSize,
+                                         nDestYOffVirtual + nBufYSize,
+                                         eDataType);
+        const char *pszNBITS = GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
+        if (pszNBITS)
+            oDstBand.SetMetadataItem("NBITS", pszNBITS, "IMAGE_STRUCTURE");
+
+        const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+        std::vector<GByte> abyLine;
+        if (eBufType != eDataType)
+            abyLine.resize(static_cast<size_t>(nDTSize) * nDstBlockXSize);
+        const auto CopyToBuffer =
+            [&](const void *pSrc, GDALDataType eSrcDT, int nSrcPixelSpace,
+                size_t nSrcLineSpace, int nDstXOff, int nDstYOff,
+                int nDstXCount, int nDstYCount)
+        {
+            const bool bViaBandType =
+                eSrcDT != eDataType && eBufType != eDataType;
+            for (int j = 0; j < nDstYCount; j++)
+            {
+                const GByte *pabySrc =
+                    static_cast<const GByte *>(pSrc) + j * nSrcLineSpace;
+                GByte *pabyDst = static_cast<GByte *>(pData) +
+                                 nLineSpace * (j + nDstYOff) +
+                                 nPixelSpace * nDstXOff;
+                if (bViaBandType)
+                {
+                    GDALCopyWords64(pabySrc, eSrcDT, nSrcPixelSpace,
+                                    abyLine.data(), eDataType, nDTSize,
+                                    nDstXCount);
+                    pabySrc = abyLine.data();
+                    GDALCopyWords64(pabySrc, eDataType, nDTSize, pabyDst,
+                                    eBufType, static_cast<int>(nPixelSpace),
+                                    nDstXCount);
+                }
+                else
+                {
+                    GDALCopyWords64(pabySrc, eSrcDT, nSrcPixelSpace, pabyDst,
+                                    eBufType, static_cast<int>(nPixelSpace),
+                                    nDstXCount);
+                }
+            }
+        };
+
         int nTotalBlocks = ((nBufXSize + nDstBlockXSize - 1) / nDstBlockXSize) *
                            ((nBufYSize + nDstBlockYSize - 1) / nDstBlockYSize);
         int nBlocksDone = 0;
@@ -1392,15 +1491,9 @@ CPLErr GDALRasterBand::RasterIOResampled(
                     {
                         if (bVal == 0)
                         {
-                            for (int j = 0; j < nDstYCount; j++)
-                            {
-                                GDALCopyWords(&dfNoDataValue, GDT_Float64, 0,
-                                              static_cast<GByte *>(pDataMem) +
-                                                  nLSMem * (j + nDstYOff) +
-                                                  nDstXOff * nPSMem,
-                                              eDTMem, static_cast<int>(nPSMem),
-                                              nDstXCount);
-                            }
+                            CopyToBuffer(&dfNoDataValue, GDT_Float64, 0, 0,
+                                         nDstXOff, nDstYOff, nDstXCount,
+                                         nDstYCount);
                             bSkipResample = true;
                         }
                         else
@@ -1415,8 +1508,6 @@ CPLErr GDALRasterBand::RasterIOResampled(
                     const bool bPropagateNoData = false;
                     void *pDstBuffer = nullptr;
                     GDALDataType eDstBufferDataType = GDT_Unknown;
-                    GDALRasterBand *poMEMBand =
-                        GDALRasterBand::FromHandle(hMEMBand);
                     eErr = pfnResampleFunc(
                         dfXRatioDstToSrc, dfYRatioDstToSrc,
                         dfXOff - nXOff, /* == 0 if bHasXOffVirtual */
@@ -1429,17 +1520,20 @@ CPLErr GDALRasterBand::RasterIOResampled(
                         nChunkYSizeQueried, nDstXOff + nDestXOffVirtual,
                         nDstXOff + nDestXOffVirtual + nDstXCount,
                         nDstYOff + nDestYOffVirtual,
-                        nDstYOff + nDestYOffVirtual + nDstYCount, poMEMBand,
+                        nDstYOff + nDestYOffVirtual + nDstYCount, &oDstBand,
                         &pDstBuffer, &eDstBufferDataType, pszResampling,
                         bHasNoData, dfNoDataValue, GetColorTable(), eDataType,
                         bPropagateNoData);
                     if (eErr == CE_None)
                     {
-                        eErr = poMEMBand->RasterIO(
-                            GF_Write, nDstXOff + nDestXOffVirtual,
-                            nDstYOff + nDestYOffVirtual, nDstXCount, nDstYCount,
-                            pDstBuffer, nDstXCount, nDstYCount,
-                            eDstBufferDataType, 0, 0, nullptr);
+                        const int nDstBufferDTSize =
+                            GDALGetDataTypeSizeBytes(eDstBufferDataType);
+                        CopyToBuffer(pDstBuffer, eDstBufferDataType,
+                                     nDstBufferDTSize,
+                                     static_cast<size_t>(nDstBufferDTSize) *
+                                         nDstXCount,
+                                     nDstXOff, nDstYOff, nDstXCount,
+                                     nDstYCount);
                     }
                     CPLFree(pDstBuffer);
                 }
@@ -1458,16 +1552,6 @@ CPLErr GDALRasterBand::RasterIOResampled(
         CPLFree(pabyChunkNoDataMask);
     }
 
-    if (eBufType != eDataType)
-    {
-        CPL_IGNORE_RET_VAL(poMEMDS->GetRasterBand(1)->RasterIO(
-            GF_Read, nDestXOffVirtual, nDestYOffVirtual, nBufXSize, nBufYSize,
-            pData, nBufXSize, nBufYSize, eBufType, nPixelSpace, nLineSpace,
-            nullptr));
-    }
-    GDALClose(poMEMDS);
-    VSIFree(pTempBuffer);
-
     return eErr;
 }
 
@@ -2516,6 +2600,13 @@ void GDALCopyWordsT(const GUInt16 *const CPL_RESTRICT pSrcData,
     if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
         nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
     {
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+        if (CPLHaveRuntimeAVX2())
+        {
+            GDALCopyUInt16ToFloat32_AVX2(pSrcData, pDstData, nWordCount);
+            return;
+        }
+#endif
         decltype(nWordCount) n = 0;
         const __m128i xmm_zero = _mm_setzero_si128();
         GByte *CPL_RESTRICT pabyDstDataPtr =
@@ -2553,6 +2644,13 @@ void GDALCopyWordsT(const GUInt16 *const CPL_RESTRICT pSrcData,
     if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
         nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
     {
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+        if (CPLHaveRuntimeAVX2())
+        {
+            GDALCopyUInt16ToFloat64_AVX2(pSrcData, pDstData, nWordCount);
+            return;
+        }
+#endif
         decltype(nWordCount) n = 0;
         const __m128i xmm_zero = _mm_setzero_si128();
         GByte *CPL_RESTRICT pabyDstDataPtr =
@@ -2595,6 +2693,86 @@ void GDALCopyWordsT(const GUInt16 *const CPL_RESTRICT pSrcData,
     }
 }
 
+template <>
+void GDALCopyWordsT(const GInt16 *const CPL_RESTRICT pSrcData,
+                    int nSrcPixelStride, float *const CPL_RESTRICT pDstData,
+                    int nDstPixelStride, GPtrDiff_t nWordCount)
+{
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
+    {
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+        if (CPLHaveRuntimeAVX2())
+        {
+            GDALCopyInt16ToFloat32_AVX2(pSrcData, pDstData, nWordCount);
+            return;
+        }
+#endif
+        decltype(nWordCount) n = 0;
+        for (; n < nWordCount - 7; n += 8)
+        {
+            __m128i xmm = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(pSrcData + n));
+            // Sign-extend int16 to int32
+            __m128i xmm0 = _mm_srai_epi32(_mm_unpacklo_epi16(xmm, xmm), 16);
+            __m128i xmm1 = _mm_srai_epi32(_mm_unpackhi_epi16(xmm, xmm), 16);
+            _mm_storeu_ps(pDstData + n, _mm_cvtepi32_ps(xmm0));
+            _mm_storeu_ps(pDstData + n + 4, _mm_cvtepi32_ps(xmm1));
+        }
+        for (; n < nWordCount; n++)
+        {
+            pDstData[n] = pSrcData[n];
+        }
+    }
+    else
+    {
+        GDALCopyWordsGenericT(pSrcData, nSrcPixelStride, pDstData,
+                              nDstPixelStride, nWordCount);
+    }
+}
+
+template <>
+void GDALCopyWordsT(const GInt16 *const CPL_RESTRICT pSrcData,
+                    int nSrcPixelStride, double *const CPL_RESTRICT pDstData,
+                    int nDstPixelStride, GPtrDiff_t nWordCount)
+{
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
+    {
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+        if (CPLHaveRuntimeAVX2())
+        {
+            GDALCopyInt16ToFloat64_AVX2(pSrcData, pDstData, nWordCount);
+            return;
+        }
+#endif
+        decltype(nWordCount) n = 0;
+        for (; n < nWordCount - 7; n += 8)
+        {
+            __m128i xmm = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(pSrcData + n));
+            // Sign-extend int16 to int32
+            __m128i xmm0 = _mm_srai_epi32(_mm_unpacklo_epi16(xmm, xmm), 16);
+            __m128i xmm1 = _mm_srai_epi32(_mm_unpackhi_epi16(xmm, xmm), 16);
+            _mm_storeu_pd(pDstData + n, _mm_cvtepi32_pd(xmm0));
+            _mm_storeu_pd(pDstData + n + 2,
+                          _mm_cvtepi32_pd(_mm_srli_si128(xmm0, 8)));
+            _mm_storeu_pd(pDstData + n + 4, _mm_cvtepi32_pd(xmm1));
+            _mm_storeu_pd(pDstData + n + 6,
+                          _mm_cvtepi32_pd(_mm_srli_si128(xmm1, 8)));
+        }
+        for (; n < nWordCount; n++)
+        {
+            pDstData[n] = pSrcData[n];
+        }
+    }
+    else
+    {
+        GDALCopyWordsGenericT(pSrcData, nSrcPixelStride, pDstData,
+                              nDstPixelStride, nWordCount);
+    }
+}
+
 template <>
 void GDALCopyWordsT(const double *const CPL_RESTRICT pSrcData,
                     int nSrcPixelStride, GUInt16 *const CPL_RESTRICT pDstData,
@@ -2604,6 +2782,64 @@ void GDALCopyWordsT(const double *const CPL_RESTRICT pSrcData,
                             nDstPixelStride, nWordCount);
 }
 
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+template <>
+void GDALCopyWordsT(const GInt16 *const CPL_RESTRICT pSrcData,
+                    int nSrcPixelStride, float *const CPL_RESTRICT pDstData,
+                    int nDstPixelStride, GPtrDiff_t nWordCount)
+{
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
+    {
+        decltype(nWordCount) n = 0;
+        for (; n < nWordCount - 7; n += 8)
+        {
+            const int16x8_t v = vld1q_s16(pSrcData + n);
+            vst1q_f32(pDstData + n, vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))));
+            vst1q_f32(pDstData + n + 4,
+                      vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))));
+        }
+        for (; n < nWordCount; n++)
+        {
+            pDstData[n] = pSrcData[n];
+        }
+    }
+    else
+    {
+        GDALCopyWordsGenericT(pSrcData, nSrcPixelStride, pDstData,
+                              nDstPixelStride, nWordCount);
+    }
+}
+
+template <>
+void GDALCopyWordsT(const GUInt16 *const CPL_RESTRICT pSrcData,
+                    int nSrcPixelStride, float *const CPL_RESTRICT pDstData,
+                    int nDstPixelStride, GPtrDiff_t nWordCount)
+{
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
+    {
+        decltype(nWordCount) n = 0;
+        for (; n < nWordCount - 7; n += 8)
+        {
+            const uint16x8_t v = vld1q_u16(pSrcData + n);
+            vst1q_f32(pDstData + n, vcvtq_f32_u32(vmovl_u16(vget_low_u16(v))));
+            vst1q_f32(pDstData + n + 4,
+                      vcvtq_f32_u32(vmovl_u16(vget_high_u16(v))));
+        }
+        for (; n < nWordCount; n++)
+        {
+            pDstData[n] = pSrcData[n];
+        }
+    }
+    else
+    {
+        GDALCopyWordsGenericT(pSrcData, nSrcPixelStride, pDstData,
+                              nDstPixelStride, nWordCount);
+    }
+}
+
 #endif  // defined(__x86_64) || defined(_M_X64)
 
 template <>
@@ -2611,6 +2847,40 @@ void GDALCopyWordsT(const float *const CPL_RESTRICT pSrcData,
                     int nSrcPixelStride, GByte *const CPL_RESTRICT pDstData,
                     int nDstPixelStride, GPtrDiff_t nWordCount)
 {
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)) &&
+        CPLHaveRuntimeAVX2())
+    {
+        GDALCopyFloat32ToByte_AVX2(pSrcData, pDstData, nWordCount);
+        return;
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
+    {
+        decltype(nWordCount) n = 0;
+        const float32x4_t p0d5 = vdupq_n_f32(0.5f);
+        const float32x4_t vmax = vdupq_n_f32(255.0f);
+        for (; n < nWordCount - 7; n += 8)
+        {
+            // vmaxnmq_f32() maps NaN to 0.5, hence 0 after truncation
+            float32x4_t v0 = vld1q_f32(pSrcData + n);
+            float32x4_t v1 = vld1q_f32(pSrcData + n + 4);
+            v0 = vminq_f32(vmaxnmq_f32(vaddq_f32(v0, p0d5), p0d5), vmax);
+            v1 = vminq_f32(vmaxnmq_f32(vaddq_f32(v1, p0d5), p0d5), vmax);
+            const uint16x8_t v16 = vcombine_u16(vmovn_u32(vcvtq_u32_f32(v0)),
+                                                vmovn_u32(vcvtq_u32_f32(v1)));
+            vst1_u8(pDstData + n, vmovn_u16(v16));
+        }
+        for (; n < nWordCount; n++)
+        {
+            GDALCopyWord(pSrcData[n], pDstData[n]);
+        }
+        return;
+    }
+#endif
     GDALCopyWordsT_8atatime(pSrcData, nSrcPixelStride, pDstData,
                             nDstPixelStride, nWordCount);
 }
@@ -2620,6 +2890,16 @@ void GDALCopyWordsT(const float *const CPL_RESTRICT pSrcData,
                     int nSrcPixelStride, GInt16 *const CPL_RESTRICT pDstData,
                     int nDstPixelStride, GPtrDiff_t nWordCount)
 {
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)) &&
+        CPLHaveRuntimeAVX2())
+    {
+        GDALCopyFloat32ToInt16_AVX2(pSrcData, pDstData, nWordCount);
+        return;
+    }
+#endif
     GDALCopyWordsT_8atatime(pSrcData, nSrcPixelStride, pDstData,
                             nDstPixelStride, nWordCount);
 }
@@ -2629,6 +2909,40 @@ void GDALCopyWordsT(const float *const CPL_RESTRICT pSrcData,
                     int nSrcPixelStride, GUInt16 *const CPL_RESTRICT pDstData,
                     int nDstPixelStride, GPtrDiff_t nWordCount)
 {
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)) &&
+        CPLHaveRuntimeAVX2())
+    {
+        GDALCopyFloat32ToUInt16_AVX2(pSrcData, pDstData, nWordCount);
+        return;
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
+    {
+        decltype(nWordCount) n = 0;
+        const float32x4_t p0d5 = vdupq_n_f32(0.5f);
+        const float32x4_t vmax = vdupq_n_f32(65535.0f);
+        for (; n < nWordCount - 7; n += 8)
+        {
+            // vmaxnmq_f32() maps NaN to 0.5, hence 0 after truncation
+            float32x4_t v0 = vld1q_f32(pSrcData + n);
+            float32x4_t v1 = vld1q_f32(pSrcData + n + 4);
+            v0 = vminq_f32(vmaxnmq_f32(vaddq_f32(v0, p0d5), p0d5), vmax);
+            v1 = vminq_f32(vmaxnmq_f32(vaddq_f32(v1, p0d5), p0d5), vmax);
+            vst1q_u16(pDstData + n,
+                      vcombine_u16(vmovn_u32(vcvtq_u32_f32(v0)),
+                                   vmovn_u32(vcvtq_u32_f32(v1))));
+        }
+        for (; n < nWordCount; n++)
+        {
+            GDALCopyWord(pSrcData[n], pDstData[n]);
+        }
+        return;
+    }
+#endif
     GDALCopyWordsT_8atatime(pSrcData, nSrcPixelStride, pDstData,
                             nDstPixelStride, nWordCount);
 }
@@ -3889,6 +4203,147 @@ static int GDALDatasetGetBestOverviewLevel(GDALDataset *poDS, int &nXOff,
                                          psExtraArg);
 }
 
+/************************************************************************/
+/*                   GDALParallelBlockBasedRasterIO()                   */
+/************************************************************************/
+
+namespace
+{
+struct GDALParallelReadJob
+{
+    GDALDataset *poCloneDS = nullptr;
+    int nYOff = 0;
+    int nYSize = 0;
+    GByte *pabyData = nullptr;
+    std::atomic<bool> *pbSuccess = nullptr;
+
+    // Shared by all jobs
+    int nXOff = 0;
+    int nXSize = 0;
+    GDALDataType eBufType = GDT_Unknown;
+    int nBandCount = 0;
+    int *panBandMap = nullptr;
+    GSpacing nPixelSpace = 0;
+    GSpacing nLineSpace = 0;
+    GSpacing nBandSpace = 0;
+};
+}  // namespace
+
+// Set in the worker threads, so that reads of clones are not themselves
+// split into jobs.
+static thread_local bool tls_bInParallelRead = false;
+
+static void GDALParallelReadJobFunc(void *pData)
+{
+    auto psJob = static_cast<GDALParallelReadJob *>(pData);
+    tls_bInParallelRead = true;
+    if (psJob->poCloneDS->RasterIO(
+            GF_Read, psJob->nXOff, psJob->nYOff, psJob->nXSize, psJob->nYSize,
+            psJob->pabyData, psJob->nXSize, psJob->nYSize, psJob->eBufType,
+            psJob->nBandCount, psJob->panBandMap, psJob->nPixelSpace,
+            psJob->nLineSpace, psJob->nBandSpace, nullptr) != CE_None)
+    {
+        *(psJob->pbSuccess) = false;
+    }
+    tls_bInParallelRead = false;
+}
+
+// Split a full resolution read spanning several rows of blocks into jobs
+// reading from clones of the dataset in the global thread pool, when the
+// GDAL_NUM_THREADS configuration option is set and the driver declares
+// GDAL_DCAP_PARALLEL_CLONE_READ.
+// Returns false if the request must be processed sequentially.
+static bool GDALParallelBlockBasedRasterIO(
+    GDALDataset *poDS, int nXOff, int nYOff, int nXSize, int nYSize,
+    void *pData, GDALDataType eBufType, int nBandCount, int *panBandMap,
+    GSpacing nPixelSpace, GSpacing nLineSpace, GSpacing nBandSpace,
+    int nBlockYSize, CPLErr &eErr)
+{
+    if (tls_bInParallelRead)
+        return false;
+
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszNumThreads == nullptr)
+        return false;
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+    nThreads = std::min(nThreads, 1024);
+
+    const int nFirstBlockRow = nYOff / nBlockYSize;
+    const int nBlockRows =
+        (nYOff + nYSize - 1) / nBlockYSize - nFirstBlockRow + 1;
+    const int nJobs = std::min(nThreads, nBlockRows);
+    if (nJobs <= 1)
+        return false;
+
+    std::vector<GDALDataset *> apoClones;
+    for (int i = 0; i < nJobs; ++i)
+    {
+        GDALDataset *poClone = poDS->AcquireParallelReadClone();
+        if (poClone == nullptr)
+            break;
+        apoClones.push_back(poClone);
+    }
+    CPLWorkerThreadPool *poPool =
+        apoClones.size() >= 2 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    if (poQueue == nullptr)
+    {
+        for (GDALDataset *poClone : apoClones)
+            poDS->ReleaseParallelReadClone(poClone);
+        return false;
+    }
+
+    CPLDebug("GDAL", "Reading %d rows of blocks of %s with %d jobs",
+             nBlockRows, poDS->GetDescription(),
+             static_cast<int>(apoClones.size()));
+
+    // Distribute whole rows of blocks evenly among the jobs.
+    const int nJobCount = static_cast<int>(apoClones.size());
+    std::atomic<bool> bSuccess{true};
+    std::vector<GDALParallelReadJob> asJobs(nJobCount);
+    for (int i = 0; i < nJobCount; ++i)
+    {
+        auto &sJob = asJobs[i];
+        const int nJobFirstRow =
+            nFirstBlockRow +
+            static_cast<int>(static_cast<GIntBig>(nBlockRows) * i / nJobCount);
+        const int nJobLastRow =
+            nFirstBlockRow + static_cast<int>(static_cast<GIntBig>(nBlockRows) *
+                                              (i + 1) / nJobCount);
+        const int nJobYOff = std::max(nYOff, nJobFirstRow * nBlockYSize);
+        const int nJobYEnd =
+            std::min(nYOff + nYSize, nJobLastRow * nBlockYSize);
+        sJob.poCloneDS = apoClones[i];
+        sJob.nYOff = nJobYOff;
+        sJob.nYSize = nJobYEnd - nJobYOff;
+        sJob.pabyData = static_cast<GByte *>(pData) +
+                        static_cast<GPtrDiff_t>(nJobYOff - nYOff) * nLineSpace;
+        sJob.pbSuccess = &bSuccess;
+        sJob.nXOff = nXOff;
+        sJob.nXSize = nXSize;
+        sJob.eBufType = eBufType;
+        sJob.nBandCount = nBandCount;
+        sJob.panBandMap = panBandMap;
+        sJob.nPixelSpace = nPixelSpace;
+        sJob.nLineSpace = nLineSpace;
+        sJob.nBandSpace = nBandSpace;
+        if (!poQueue->SubmitJob(GDALParallelReadJobFunc, &sJob))
+        {
+            // Process it in this thread
+            GDALParallelReadJobFunc(&sJob);
+        }
+    }
+    poQueue->WaitCompletion();
+
+    for (GDALDataset *poClone : apoClones)
+        poDS->ReleaseParallelReadClone(poClone);
+
+    eErr = bSuccess ? CE_None : CE_Failure;
+    return true;
+}
+
 /************************************************************************/
 /*                         BlockBasedRasterIO()                         */
 /*                                                                      */
@@ -3994,6 +4449,15 @@ CPLErr GDALDataset::BlockBasedRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
 
     if (nXSize == nBufXSize && nYSize == nBufYSize && bUseIntegerRequestCoords)
     {
+        if (eRWFlag == GF_Read && psExtraArg->pfnProgress == nullptr &&
+            GDALParallelBlockBasedRasterIO(
+                this, nXOff, nYOff, nXSize, nYSize, pData, eBufType,
+                nBandCount, panBandMap, nPixelSpace, nLineSpace, nBandSpace,
+                nBlockYSize, eErr))
+        {
+            return eErr;
+        }
+
         GDALRasterIOExtraArg sDummyExtraArg;
         INIT_RASTERIO_EXTRA_ARG(sDummyExtraArg);
 
@@ -4279,12 +4743,12 @@ CleanupAndReturn:
 /*                  GDALCopyWholeRasterGetSwathSize()                   */
 /************************************************************************/
 
-static void GDALCopyWholeRasterGetSwathSize(GDALRasterBand *poSrcPrototypeBand,
-                                            GDALRasterBand *poDstPrototypeBand,
-                                            int nBandCount,
-                                            int bDstIsCompressed,
-                                            int bInterleave, int *pnSwathCols,
-                                            int *pnSwathLines)
+// nMaxParallelSwaths is the number of swath buffers that may be used at the
+// same time, among which the target swath size is divided.
+static void GDALCopyWholeRasterGetSwathSize(
+    GDALRasterBand *poSrcPrototypeBand, GDALRasterBand *poDstPrototypeBand,
+    int nBandCount, int bDstIsCompressed, int bInterleave,
+    int nMaxParallelSwaths, int *pnSwathCols, int *pnSwathLines)
 {
     GDALDataType eDT = poDstPrototypeBand->GetRasterDataType();
     int nSrcBlockXSize = 0;
@@ -4329,12 +4793,13 @@ static void GDALCopyWholeRasterGetSwathSize(GDALRasterBand *poSrcPrototypeBand,
     int nTargetSwathSize;
     if (pszSwathSize != nullptr)
         nTargetSwathSize = static_cast<int>(
-            std::min(GIntBig(INT_MAX), CPLAtoGIntBig(pszSwathSize)));
+            std::min(GIntBig(INT_MAX),
+                     CPLAtoGIntBig(pszSwathSize) / nMaxParallelSwaths));
     else
     {
         // As a default, take one 1/4 of the cache size.
-        nTargetSwathSize = static_cast<int>(
-            std::min(GIntBig(INT_MAX), GDALGetCacheMax64() / 4));
+        nTargetSwathSize = static_cast<int>(std::min(
+            GIntBig(INT_MAX), GDALGetCacheMax64() / 4 / nMaxParallelSwaths));
 
         // but if the minimum idal swath buf size is less, then go for it to
         // avoid unnecessarily abusing RAM usage.
@@ -4521,6 +4986,254 @@ static void GDALCopyWholeRasterGetSwathSize(GDALRasterBand *poSrcPrototypeBand,
     *pnSwathLines = nSwathLines;
 }
 
+/************************************************************************/
+/*                 GDALDatasetCopyWholeRasterParallel()                 */
+/************************************************************************/
+
+namespace
+{
+struct GDALCopyWholeRasterSwath
+{
+    int nBand = 0;  // 0 means all bands (pixel interleaved case)
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    int nYSize = 0;
+};
+
+struct GDALCopyWholeRasterReadJob
+{
+    GDALDataset *poCloneDS = nullptr;
+    const GDALCopyWholeRasterSwath *psSwath = nullptr;
+    void *pBuffer = nullptr;
+    GDALDataType eDT = GDT_Unknown;
+    int nBandCount = 0;
+    bool bCheckHoles = false;
+    std::mutex *poMutex = nullptr;
+    std::condition_variable *poCond = nullptr;
+
+    // Protected by *poMutex
+    bool bDone = false;
+    bool bHasData = true;
+    bool bSuccess = true;
+};
+}  // namespace
+
+static void GDALCopyWholeRasterReadJobFunc(void *pData)
+{
+    auto psJob = static_cast<GDALCopyWholeRasterReadJob *>(pData);
+    const auto psSwath = psJob->psSwath;
+
+    // We run in a worker thread of the global thread pool: the driver of the
+    // clone must not submit jobs to it.
+    CPLConfigOptionSetter oNumThreadsSetter("GDAL_NUM_THREADS", "1", false);
+    tls_bInParallelRead = true;
+
+    int nBand = psSwath->nBand;
+    bool bHasData = true;
+    if (psJob->bCheckHoles && nBand > 0)
+    {
+        auto poSrcBand = psJob->poCloneDS->GetRasterBand(nBand);
+        bHasData = (poSrcBand->GetDataCoverageStatus(
+                        psSwath->nXOff, psSwath->nYOff, psSwath->nXSize,
+                        psSwath->nYSize, GDAL_DATA_COVERAGE_STATUS_DATA) &
+                    GDAL_DATA_COVERAGE_STATUS_DATA) != 0;
+    }
+    bool bSuccess = true;
+    if (bHasData)
+    {
+        bSuccess =
+            psJob->poCloneDS->RasterIO(
+                GF_Read, psSwath->nXOff, psSwath->nYOff, psSwath->nXSize,
+                psSwath->nYSize, psJob->pBuffer, psSwath->nXSize,
+                psSwath->nYSize, psJob->eDT, nBand > 0 ? 1 : psJob->nBandCount,
+                nBand > 0 ? &nBand : nullptr, 0, 0, 0, nullptr) == CE_None;
+    }
+    tls_bInParallelRead = false;
+
+    {
+        std::lock_guard<std::mutex> oLock(*(psJob->poMutex));
+        psJob->bHasData = bHasData;
+        psJob->bSuccess = bSuccess;
+        psJob->bDone = true;
+    }
+    psJob->poCond->notify_all();
+}
+
+// Return the number of swaths that may be read at the same time from poSrcDS,
+// that is the value of the GDAL_NUM_THREADS configuration option if poSrcDS
+// can provide clones (see GDALDataset::AcquireParallelReadClone()), or 1.
+static int GDALCopyWholeRasterGetMaxParallelSwaths(GDALDataset *poSrcDS)
+{
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszNumThreads == nullptr)
+        return 1;
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                          : atoi(pszNumThreads);
+    GDALDriver *poDriver = poSrcDS->GetDriver();
+    if (nThreads <= 1 || poDriver == nullptr ||
+        poSrcDS->GetAccess() != GA_ReadOnly ||
+        !CPLTestBool(CSLFetchNameValueDef(poDriver->GetMetadata(),
+                                          GDAL_DCAP_PARALLEL_CLONE_READ, "NO")))
+    {
+        return 1;
+    }
+    return std::min(nThreads, 1024);
+}
+
+// Read up to nThreads swaths ahead, concurrently, from clones of the source
+// dataset in the global thread pool, while the current swath is written to
+// the destination, in the same order as the sequential code path. The swath
+// buffers are limited in total to the GDAL_SWATH_SIZE configuration option,
+// or 1/4 of the block cache size.
+// Returns false if the copy must be done sequentially.
+static bool GDALDatasetCopyWholeRasterParallel(
+    GDALDataset *poSrcDS, GDALDataset *poDstDS, GDALDataType eDT,
+    bool bInterleave, bool bCheckHoles, int nThreads, int nSwathCols,
+    int nSwathLines, void *pSwathBuf, size_t nSwathBufSize,
+    GDALProgressFunc pfnProgress, void *pProgressData, CPLErr &eErr)
+{
+    const char *pszSwathSize = CPLGetConfigOption("GDAL_SWATH_SIZE", nullptr);
+    const GIntBig nMaxMemory = pszSwathSize ? CPLAtoGIntBig(pszSwathSize)
+                                            : GDALGetCacheMax64() / 4;
+
+    const int nXSize = poDstDS->GetRasterXSize();
+    const int nYSize = poDstDS->GetRasterYSize();
+    const int nBandCount = poDstDS->GetRasterCount();
+    std::vector<GDALCopyWholeRasterSwath> asSwaths;
+    for (int iBand = 0; iBand < (bInterleave ? 1 : nBandCount); iBand++)
+    {
+        for (int iY = 0; iY < nYSize; iY += nSwathLines)
+        {
+            for (int iX = 0; iX < nXSize; iX += nSwathCols)
+            {
+                GDALCopyWholeRasterSwath sSwath;
+                sSwath.nBand = bInterleave ? 0 : iBand + 1;
+                sSwath.nXOff = iX;
+                sSwath.nYOff = iY;
+                sSwath.nXSize = std::min(nSwathCols, nXSize - iX);
+                sSwath.nYSize = std::min(nSwathLines, nYSize - iY);
+                asSwaths.push_back(sSwath);
+            }
+        }
+    }
+
+    const int nBuffers = static_cast<int>(
+        std::min(std::min(static_cast<GIntBig>(nThreads),
+                          nMaxMemory / static_cast<GIntBig>(nSwathBufSize)),
+                 static_cast<GIntBig>(asSwaths.size())));
+    if (nBuffers <= 1)
+        return false;
+
+    std::vector<GDALDataset *> apoClones;
+    for (int i = 0; i < nBuffers; ++i)
+    {
+        GDALDataset *poClone = poSrcDS->AcquireParallelReadClone();
+        if (poClone == nullptr)
+            break;
+        apoClones.push_back(poClone);
+    }
+    std::vector<void *> apBuffers{pSwathBuf};
+    while (apBuffers.size() < apoClones.size())
+    {
+        void *pBuffer = VSI_MALLOC_VERBOSE(nSwathBufSize);
+        if (pBuffer == nullptr)
+            break;
+        apBuffers.push_back(pBuffer);
+    }
+    const auto ReleaseResources = [poSrcDS, &apoClones, &apBuffers]()
+    {
+        for (GDALDataset *poClone : apoClones)
+            poSrcDS->ReleaseParallelReadClone(poClone);
+        for (size_t i = 1; i < apBuffers.size(); ++i)
+            VSIFree(apBuffers[i]);
+    };
+
+    const int nJobCount = static_cast<int>(
+        std::min(apoClones.size(), apBuffers.size()));
+    CPLWorkerThreadPool *poPool =
+        nJobCount >= 2 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    if (poQueue == nullptr)
+    {
+        ReleaseResources();
+        return false;
+    }
+
+    CPLDebug("GDAL",
+             "GDALDatasetCopyWholeRaster(): reading up to %d swaths ahead",
+             nJobCount);
+
+    std::mutex oMutex;
+    std::condition_variable oCond;
+    std::vector<GDALCopyWholeRasterReadJob> asJobs(nJobCount);
+    const auto SubmitSwath = [&](size_t iSwath)
+    {
+        auto &sJob = asJobs[iSwath % nJobCount];
+        sJob.poCloneDS = apoClones[iSwath % nJobCount];
+        sJob.psSwath = &asSwaths[iSwath];
+        sJob.pBuffer = apBuffers[iSwath % nJobCount];
+        sJob.eDT = eDT;
+        sJob.nBandCount = nBandCount;
+        sJob.bCheckHoles = bCheckHoles;
+        sJob.poMutex = &oMutex;
+        sJob.poCond = &oCond;
+        sJob.bDone = false;
+        if (!poQueue->SubmitJob(GDALCopyWholeRasterReadJobFunc, &sJob))
+        {
+            // Process it in this thread
+            GDALCopyWholeRasterReadJobFunc(&sJob);
+        }
+    };
+
+    for (int i = 0; i < nJobCount; ++i)
+        SubmitSwath(i);
+
+    eErr = CE_None;
+    for (size_t iSwath = 0; iSwath < asSwaths.size(); ++iSwath)
+    {
+        auto &sJob = asJobs[iSwath % nJobCount];
+        bool bHasData;
+        {
+            std::unique_lock<std::mutex> oLock(oMutex);
+            oCond.wait(oLock, [&sJob] { return sJob.bDone; });
+            bHasData = sJob.bHasData;
+            if (!sJob.bSuccess)
+                eErr = CE_Failure;
+        }
+
+        const auto &sSwath = asSwaths[iSwath];
+        int nBand = sSwath.nBand;
+        if (eErr == CE_None && bHasData)
+        {
+            eErr = poDstDS->RasterIO(
+                GF_Write, sSwath.nXOff, sSwath.nYOff, sSwath.nXSize,
+                sSwath.nYSize, sJob.pBuffer, sSwath.nXSize, sSwath.nYSize, eDT,
+                nBand > 0 ? 1 : nBandCount, nBand > 0 ? &nBand : nullptr, 0,
+                0, 0, nullptr);
+        }
+
+        if (eErr == CE_None &&
+            !pfnProgress(static_cast<double>(iSwath + 1) / asSwaths.size(),
+                         nullptr, pProgressData))
+        {
+            eErr = CE_Failure;
+            CPLError(CE_Failure, CPLE_UserInterrupt,
+                     "User terminated CreateCopy()");
+        }
+        if (eErr != CE_None)
+            break;
+
+        if (iSwath + nJobCount < asSwaths.size())
+            SubmitSwath(iSwath + nJobCount);
+    }
+    poQueue->WaitCompletion();
+
+    ReleaseResources();
+    return true;
+}
+
 /************************************************************************/
 /*                     GDALDatasetCopyWholeRaster()                     */
 /************************************************************************/
@@ -4549,6 +5262,13 @@ static void GDALCopyWholeRasterGetSwathSize(GDALRasterBand *poSrcPrototypeBand,
  * </ul>
  * More options may be supported in the future.
  *
+ * Starting with GDAL 3.9, when the GDAL_NUM_THREADS configuration option is
+ * set and the source dataset is opened in read-only mode by a driver declaring
+ * GDAL_DCAP_PARALLEL_CLONE_READ, several swaths are read concurrently from
+ * clones of the source dataset while they are written in order to the
+ * destination dataset. The total size of the swath buffers is then limited by
+ * the GDAL_SWATH_SIZE configuration option (or 1/4 of the block cache size).
+ *
  * @param hSrcDS the source dataset
  * @param hDstDS the destination dataset
  * @param papszOptions transfer hints in "StringList" Name=Value format.
@@ -4657,9 +5377,12 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
 
     int nSwathCols = 0;
     int nSwathLines = 0;
+    const int nMaxParallelSwaths =
+        GDALCopyWholeRasterGetMaxParallelSwaths(poSrcDS);
     GDALCopyWholeRasterGetSwathSize(poSrcPrototypeBand, poDstPrototypeBand,
                                     nBandCount, bDstIsCompressed, bInterleave,
-                                    &nSwathCols, &nSwathLines);
+                                    nMaxParallelSwaths, &nSwathCols,
+                                    &nSwathLines);
 
     int nPixelSize = GDALGetDataTypeSizeBytes(eDT);
     if (bInterleave)
@@ -4688,6 +5411,17 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
     const bool bCheckHoles =
         CPLTestBool(CSLFetchNameValueDef(papszOptions, "SKIP_HOLES", "NO"));
 
+    if (nMaxParallelSwaths > 1 &&
+        GDALDatasetCopyWholeRasterParallel(
+            poSrcDS, poDstDS, eDT, bInterleave, bCheckHoles, nMaxParallelSwaths,
+            nSwathCols, nSwathLines, pSwathBuf,
+            static_cast<size_t>(nSwathCols) * nSwathLines * nPixelSize,
+            pfnProgress, pProgressData, eErr))
+    {
+        CPLFree(pSwathBuf);
+        return eErr;
+    }
+
     if (!bInterleave)
     {
         GDALRasterIOExtraArg sExtraArg;
@@ -4943,7 +5677,7 @@ CPLErr CPL_STDCALL GDALRasterBandCopyWholeRaster(
     int nSwathCols = 0;
     int nSwathLines = 0;
     GDALCopyWholeRasterGetSwathSize(poSrcBand, poDstBand, 1, bDstIsCompressed,
-                                    FALSE, &nSwathCols, &nSwathLines);
+                                    FALSE, 1, &nSwathCols, &nSwathLines);
 
     const int nPixelSize = GDALGetDataTypeSizeBytes(eDT);
 
@@ -5040,6 +5774,8 @@ void GDALCopyRasterIOExtraArg(GDALRasterIOExtraArg *psDestArg,
             psDestArg->dfXSize = psSrcArg->dfXSize;
             psDestArg->dfYSize = psSrcArg->dfYSize;
         }
+        if (psSrcArg->nVersion >= 2)
+            psDestArg->bStreaming = psSrcArg->bStreaming;
     }
 }
 
@@ -5478,6 +6214,272 @@ static void GDALDeinterleave4Byte(const GByte *CPL_RESTRICT pabySrc,
 
 #endif
 
+/************************************************************************/
+/*                          GDALTransposeTile()                         */
+/************************************************************************/
+
+// Transpose a TILE x TILE tile of words of type T: apSrc[i] points to the
+// TILE consecutive words of row i, and apDst[j] to where the TILE words of
+// column j must be written.
+template <class T, int TILE> struct GDALTransposeTile
+{
+    static inline void Transpose(const T *const *apSrc, T *const *apDst)
+    {
+        for (int j = 0; j < TILE; ++j)
+        {
+            for (int i = 0; i < TILE; ++i)
+                memcpy(apDst[j] + i, apSrc[i] + j, sizeof(T));
+        }
+    }
+};
+
+#if defined(__x86_64) || defined(_M_X64)
+
+template <> struct GDALTransposeTile<GByte, 8>
+{
+    static inline void Transpose(const GByte *const *apSrc,
+                                 GByte *const *apDst)
+    {
+        const __m128i r0 =
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(apSrc[0]));
+        const __m128i r1 =
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(apSrc[1]));
+        const __m128i r2 =
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(apSrc[2]));
+        const __m128i r3 =
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(apSrc[3]));
+        const __m128i r4 =
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(apSrc[4]));
+        const __m128i r5 =
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(apSrc[5]));
+        const __m128i r6 =
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(apSrc[6]));
+        const __m128i r7 =
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(apSrc[7]));
+        // Pairs of rows, interleaved word by word
+        const __m128i a0 = _mm_unpacklo_epi8(r0, r1);
+        const __m128i a1 = _mm_unpacklo_epi8(r2, r3);
+        const __m128i a2 = _mm_unpacklo_epi8(r4, r5);
+        const __m128i a3 = _mm_unpacklo_epi8(r6, r7);
+        // Columns 0-3 and 4-7 of rows 0-3, and of rows 4-7
+        const __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+        const __m128i b1 = _mm_unpackhi_epi16(a0, a1);
+        const __m128i b2 = _mm_unpacklo_epi16(a2, a3);
+        const __m128i b3 = _mm_unpackhi_epi16(a2, a3);
+        // Each 64-bit half is a column
+        const __m128i c0 = _mm_unpacklo_epi32(b0, b2);
+        const __m128i c1 = _mm_unpackhi_epi32(b0, b2);
+        const __m128i c2 = _mm_unpacklo_epi32(b1, b3);
+        const __m128i c3 = _mm_unpackhi_epi32(b1, b3);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(apDst[0]), c0);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(apDst[1]),
+                         _mm_unpackhi_epi64(c0, c0));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(apDst[2]), c1);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(apDst[3]),
+                         _mm_unpackhi_epi64(c1, c1));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(apDst[4]), c2);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(apDst[5]),
+                         _mm_unpackhi_epi64(c2, c2));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(apDst[6]), c3);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(apDst[7]),
+                         _mm_unpackhi_epi64(c3, c3));
+    }
+};
+
+template <> struct GDALTransposeTile<GUInt16, 8>
+{
+    static inline void Transpose(const GUInt16 *const *apSrc,
+                                 GUInt16 *const *apDst)
+    {
+        __m128i r[8];
+        for (int i = 0; i < 8; ++i)
+            r[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(apSrc[i]));
+        // Pairs of rows, interleaved word by word: columns 0-3 and 4-7
+        const __m128i a0 = _mm_unpacklo_epi16(r[0], r[1]);
+        const __m128i a1 = _mm_unpackhi_epi16(r[0], r[1]);
+        const __m128i a2 = _mm_unpacklo_epi16(r[2], r[3]);
+        const __m128i a3 = _mm_unpackhi_epi16(r[2], r[3]);
+        const __m128i a4 = _mm_unpacklo_epi16(r[4], r[5]);
+        const __m128i a5 = _mm_unpackhi_epi16(r[4], r[5]);
+        const __m128i a6 = _mm_unpacklo_epi16(r[6], r[7]);
+        const __m128i a7 = _mm_unpackhi_epi16(r[6], r[7]);
+        // Columns 2k and 2k+1 of rows 0-3, and of rows 4-7
+        const __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+        const __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+        const __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+        const __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+        const __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+        const __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+        const __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+        const __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(apDst[0]),
+                         _mm_unpacklo_epi64(b0, b4));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(apDst[1]),
+                         _mm_unpackhi_epi64(b0, b4));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(apDst[2]),
+                         _mm_unpacklo_epi64(b1, b5));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(apDst[3]),
+                         _mm_unpackhi_epi64(b1, b5));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(apDst[4]),
+                         _mm_unpacklo_epi64(b2, b6));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(apDst[5]),
+                         _mm_unpackhi_epi64(b2, b6));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(apDst[6]),
+                         _mm_unpacklo_epi64(b3, b7));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(apDst[7]),
+                         _mm_unpackhi_epi64(b3, b7));
+    }
+};
+
+template <> struct GDALTransposeTile<GUInt32, 4>
+{
+    static inline void Transpose(const GUInt32 *const *apSrc,
+                                 GUInt32 *const *apDst)
+    {
+        // Done on float registers, but this is just a move of 32-bit words.
+        const __m128 r0 =
+            _mm_loadu_ps(reinterpret_cast<const float *>(apSrc[0]));
+        const __m128 r1 =
+            _mm_loadu_ps(reinterpret_cast<const float *>(apSrc[1]));
+        const __m128 r2 =
+            _mm_loadu_ps(reinterpret_cast<const float *>(apSrc[2]));
+        const __m128 r3 =
+            _mm_loadu_ps(reinterpret_cast<const float *>(apSrc[3]));
+        const __m128 t0 = _mm_unpacklo_ps(r0, r1);
+        const __m128 t1 = _mm_unpacklo_ps(r2, r3);
+        const __m128 t2 = _mm_unpackhi_ps(r0, r1);
+        const __m128 t3 = _mm_unpackhi_ps(r2, r3);
+        _mm_storeu_ps(reinterpret_cast<float *>(apDst[0]),
+                      _mm_movelh_ps(t0, t1));
+        _mm_storeu_ps(reinterpret_cast<float *>(apDst[1]),
+                      _mm_movehl_ps(t1, t0));
+        _mm_storeu_ps(reinterpret_cast<float *>(apDst[2]),
+                      _mm_movelh_ps(t2, t3));
+        _mm_storeu_ps(reinterpret_cast<float *>(apDst[3]),
+                      _mm_movehl_ps(t3, t2));
+    }
+};
+
+#endif  // defined(__x86_64) || defined(_M_X64)
+
+/************************************************************************/
+/*                     GDALDeinterleaveBlocked()                        */
+/************************************************************************/
+
+// De-interleave (or interleave when bInterleave is true) nIters pixels of
+// nComponents words of type T, in tiles of TILE pixels x TILE components, so
+// that the source and destination of a tile stay in the L1 cache whatever
+// the number of components. T is only used as a word of the right size: the
+// values are moved with memcpy() or SIMD loads and stores, so this is valid
+// for any data type of that size.
+template <class T, int TILE>
+static void GDALDeinterleaveBlocked(T *CPL_RESTRICT pInterleaved,
+                                    int nComponents,
+                                    T *CPL_RESTRICT const *ppComponents,
+                                    size_t nIters, bool bInterleave)
+{
+    // Pixels are processed by chunks of 64 bytes per component, so that the
+    // writes to each component buffer cover full cache lines.
+    constexpr int CHUNK = std::max(TILE, static_cast<int>(64 / sizeof(T)));
+    const T *apSrc[TILE];
+    T *apDst[TILE];
+    const size_t nComps = static_cast<size_t>(nComponents);
+    size_t i = 0;
+    for (; i + CHUNK <= nIters; i += CHUNK)
+    {
+        int iComp = 0;
+        for (; iComp + TILE <= nComponents; iComp += TILE)
+        {
+            for (size_t j = i; j < i + CHUNK; j += TILE)
+            {
+                for (int k = 0; k < TILE; ++k)
+                {
+                    T *pPixel = pInterleaved + (j + k) * nComps + iComp;
+                    T *pComp = ppComponents[iComp + k] + j;
+                    if (bInterleave)
+                    {
+                        apSrc[k] = pComp;
+                        apDst[k] = pPixel;
+                    }
+                    else
+                    {
+                        apSrc[k] = pPixel;
+                        apDst[k] = pComp;
+                    }
+                }
+                GDALTransposeTile<T, TILE>::Transpose(apSrc, apDst);
+            }
+        }
+        for (; iComp < nComponents; ++iComp)
+        {
+            T *pComp = ppComponents[iComp] + i;
+            for (int k = 0; k < CHUNK; ++k)
+            {
+                T *pPixel = pInterleaved + (i + k) * nComps + iComp;
+                if (bInterleave)
+                    memcpy(pPixel, pComp + k, sizeof(T));
+                else
+                    memcpy(pComp + k, pPixel, sizeof(T));
+            }
+        }
+    }
+    for (; i < nIters; ++i)
+    {
+        for (int iComp = 0; iComp < nComponents; ++iComp)
+        {
+            T *pPixel = pInterleaved + i * nComps + iComp;
+            if (bInterleave)
+                memcpy(pPixel, ppComponents[iComp] + i, sizeof(T));
+            else
+                memcpy(ppComponents[iComp] + i, pPixel, sizeof(T));
+        }
+    }
+}
+
+/************************************************************************/
+/*                    GDALDeinterleaveSameType()                        */
+/************************************************************************/
+
+// Returns false if the data type size is not handled, or if there are too
+// few components for the tiled approach to be worth it.
+static bool GDALDeinterleaveSameType(void *pInterleaved, GDALDataType eDT,
+                                     int nComponents, void **ppComponents,
+                                     size_t nIters, bool bInterleave)
+{
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+    if (nComponents < (nDTSize <= 2 ? 8 : 4))
+        return false;
+    switch (nDTSize)
+    {
+        case 1:
+            GDALDeinterleaveBlocked<GByte, 8>(
+                static_cast<GByte *>(pInterleaved), nComponents,
+                reinterpret_cast<GByte **>(ppComponents), nIters, bInterleave);
+            return true;
+        case 2:
+            GDALDeinterleaveBlocked<GUInt16, 8>(
+                static_cast<GUInt16 *>(pInterleaved), nComponents,
+                reinterpret_cast<GUInt16 **>(ppComponents), nIters,
+                bInterleave);
+            return true;
+        case 4:
+            GDALDeinterleaveBlocked<GUInt32, 4>(
+                static_cast<GUInt32 *>(pInterleaved), nComponents,
+                reinterpret_cast<GUInt32 **>(ppComponents), nIters,
+                bInterleave);
+            return true;
+        case 8:
+            GDALDeinterleaveBlocked<GUInt64, 4>(
+                static_cast<GUInt64 *>(pInterleaved), nComponents,
+                reinterpret_cast<GUInt64 **>(ppComponents), nIters,
+                bInterleave);
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
+
 /************************************************************************/
 /*                      GDALDeinterleave()                              */
 /************************************************************************/
@@ -5493,7 +6495,8 @@ static void GDALDeinterleave4Byte(const GByte *CPL_RESTRICT pabySrc,
     \endverbatim
 
     The implementation is optimized for a few cases, like de-interleaving
-    of 3 or 4-components Byte buffers.
+    of 3 or 4-components Byte buffers, and for buffers with many components
+    when the source and destination data types are the same.
 
     \since GDAL 3.6
  */
@@ -5579,6 +6582,12 @@ void GDALDeinterleave(const void *pSourceBuffer, GDALDataType eSourceDT,
 #endif
         }
 #endif
+        if (GDALDeinterleaveSameType(const_cast<void *>(pSourceBuffer),
+                                     eSourceDT, nComponents, ppDestBuffer,
+                                     nIters, /* bInterleave = */ false))
+        {
+            return;
+        }
     }
 
     const int nSourceDTSize = GDALGetDataTypeSizeBytes(eSourceDT);
@@ -5591,3 +6600,45 @@ void GDALDeinterleave(const void *pSourceBuffer, GDALDataType eSourceDT,
                         ppDestBuffer[iComp], eDestDT, nDestDTSize, nIters);
     }
 }
+
+/************************************************************************/
+/*                        GDALInterleave()                              */
+/************************************************************************/
+
+/*! Copy values from multiple per-component buffers to a pixel-interleave
+    buffer.
+
+    This is the reverse operation of GDALDeinterleave(). In pseudo-code
+    \verbatim
+    for(size_t i = 0; i < nIters; ++i)
+        for(int iComp = 0; iComp < nComponents; iComp++ )
+            pDestBuffer[nComponents * i + iComp] = ppSourceBuffer[iComp][i]
+    \endverbatim
+
+    The implementation is optimized for buffers with many components when
+    the source and destination data types are the same.
+
+    \since GDAL 3.9
+ */
+void GDALInterleave(const void *const *ppSourceBuffer, GDALDataType eSourceDT,
+                    int nComponents, void *pDestBuffer, GDALDataType eDestDT,
+                    size_t nIters)
+{
+    if (eSourceDT == eDestDT &&
+        GDALDeinterleaveSameType(pDestBuffer, eSourceDT, nComponents,
+                                 const_cast<void **>(ppSourceBuffer), nIters,
+                                 /* bInterleave = */ true))
+    {
+        return;
+    }
+
+    const int nSourceDTSize = GDALGetDataTypeSizeBytes(eSourceDT);
+    const int nDestDTSize = GDALGetDataTypeSizeBytes(eDestDT);
+    for (int iComp = 0; iComp < nComponents; iComp++)
+    {
+        GDALCopyWords64(ppSourceBuffer[iComp], eSourceDT, nSourceDTSize,
+                        static_cast<GByte *>(pDestBuffer) +
+                            iComp * nDestDTSize,
+                        eDestDT, nComponents * nDestDTSize, nIters);
+    }
+}
@@ -0,0 +1,255 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations
+ * Author:   Even Rouault <even dot rouault at spatialys dot com>
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, Even Rouault <even dot rouault at spatialys dot com>
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+
+#include "rasterio_avx2.h"
+
+#include <immintrin.h>
+#include "gdal_priv_templates.hpp"
+
+/************************************************************************/
+/*                      GDALCopyFloat32ToByte_AVX2()                    */
+/************************************************************************/
+
+void GDALCopyFloat32ToByte_AVX2(const float *CPL_RESTRICT pSrc,
+                                GByte *CPL_RESTRICT pDst, size_t nIters)
+{
+    const __m256 p0d5 = _mm256_set1_ps(0.5f);
+    const __m256 ymm_max = _mm256_set1_ps(255);
+    // Restore the order of the 32-bit groups after the lane-wise packing
+    const __m256i ymm_permute = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    size_t i = 0;
+    for (; i + 31 < nIters; i += 32)
+    {
+        __m256 ymm0 = _mm256_loadu_ps(pSrc + i + 0);
+        __m256 ymm1 = _mm256_loadu_ps(pSrc + i + 8);
+        __m256 ymm2 = _mm256_loadu_ps(pSrc + i + 16);
+        __m256 ymm3 = _mm256_loadu_ps(pSrc + i + 24);
+
+        // Same rounding and clamping as GDALCopy4Words(float*, GByte*),
+        // including NaN mapped to 0.
+        ymm0 = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(ymm0, p0d5), p0d5),
+                             ymm_max);
+        ymm1 = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(ymm1, p0d5), p0d5),
+                             ymm_max);
+        ymm2 = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(ymm2, p0d5), p0d5),
+                             ymm_max);
+        ymm3 = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(ymm3, p0d5), p0d5),
+                             ymm_max);
+
+        __m256i ymm01 = _mm256_packus_epi32(_mm256_cvttps_epi32(ymm0),
+                                            _mm256_cvttps_epi32(ymm1));
+        __m256i ymm23 = _mm256_packus_epi32(_mm256_cvttps_epi32(ymm2),
+                                            _mm256_cvttps_epi32(ymm3));
+        __m256i ymm = _mm256_packus_epi16(ymm01, ymm23);
+        ymm = _mm256_permutevar8x32_epi32(ymm, ymm_permute);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pDst + i), ymm);
+    }
+    for (; i < nIters; ++i)
+    {
+        GDALCopyWord(pSrc[i], pDst[i]);
+    }
+}
+
+/************************************************************************/
+/*                     GDALCopyFloat32ToInt16_AVX2()                    */
+/************************************************************************/
+
+void GDALCopyFloat32ToInt16_AVX2(const float *CPL_RESTRICT pSrc,
+                                 GInt16 *CPL_RESTRICT pDst, size_t nIters)
+{
+    const __m256 ymm_min = _mm256_set1_ps(-32768);
+    const __m256 ymm_max = _mm256_set1_ps(32767);
+    const __m256 p0d5 = _mm256_set1_ps(0.5f);
+    const __m256 m0d5 = _mm256_set1_ps(-0.5f);
+    size_t i = 0;
+    for (; i + 15 < nIters; i += 16)
+    {
+        __m256 ymm0 = _mm256_loadu_ps(pSrc + i + 0);
+        __m256 ymm1 = _mm256_loadu_ps(pSrc + i + 8);
+
+        // Same rounding and clamping as GDALCopyWord(float, GInt16&), with
+        // NaN mapped to 0.
+        ymm0 = _mm256_and_ps(ymm0, _mm256_cmp_ps(ymm0, ymm0, _CMP_ORD_Q));
+        ymm1 = _mm256_and_ps(ymm1, _mm256_cmp_ps(ymm1, ymm1, _CMP_ORD_Q));
+        ymm0 = _mm256_min_ps(_mm256_max_ps(ymm0, ymm_min), ymm_max);
+        ymm1 = _mm256_min_ps(_mm256_max_ps(ymm1, ymm_min), ymm_max);
+        // f >= 0.5f ? f + 0.5f : f - 0.5f
+        ymm0 = _mm256_add_ps(
+            ymm0, _mm256_blendv_ps(m0d5, p0d5,
+                                   _mm256_cmp_ps(ymm0, p0d5, _CMP_GE_OQ)));
+        ymm1 = _mm256_add_ps(
+            ymm1, _mm256_blendv_ps(m0d5, p0d5,
+                                   _mm256_cmp_ps(ymm1, p0d5, _CMP_GE_OQ)));
+
+        __m256i ymm = _mm256_packs_epi32(_mm256_cvttps_epi32(ymm0),
+                                         _mm256_cvttps_epi32(ymm1));
+        ymm = _mm256_permute4x64_epi64(ymm, 0 | (2 << 2) | (1 << 4) | (3 << 6));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pDst + i), ymm);
+    }
+    for (; i < nIters; ++i)
+    {
+        GDALCopyWord(pSrc[i], pDst[i]);
+    }
+}
+
+/************************************************************************/
+/*                    GDALCopyFloat32ToUInt16_AVX2()                    */
+/************************************************************************/
+
+void GDALCopyFloat32ToUInt16_AVX2(const float *CPL_RESTRICT pSrc,
+                                  GUInt16 *CPL_RESTRICT pDst, size_t nIters)
+{
+    const __m256 p0d5 = _mm256_set1_ps(0.5f);
+    const __m256 ymm_max = _mm256_set1_ps(65535);
+    size_t i = 0;
+    for (; i + 15 < nIters; i += 16)
+    {
+        __m256 ymm0 = _mm256_loadu_ps(pSrc + i + 0);
+        __m256 ymm1 = _mm256_loadu_ps(pSrc + i + 8);
+
+        ymm0 = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(ymm0, p0d5), p0d5),
+                             ymm_max);
+        ymm1 = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(ymm1, p0d5), p0d5),
+                             ymm_max);
+
+        __m256i ymm = _mm256_packus_epi32(_mm256_cvttps_epi32(ymm0),
+                                          _mm256_cvttps_epi32(ymm1));
+        ymm = _mm256_permute4x64_epi64(ymm, 0 | (2 << 2) | (1 << 4) | (3 << 6));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pDst + i), ymm);
+    }
+    for (; i < nIters; ++i)
+    {
+        GDALCopyWord(pSrc[i], pDst[i]);
+    }
+}
+
+/************************************************************************/
+/*                     GDALCopyInt16ToFloat32_AVX2()                    */
+/************************************************************************/
+
+void GDALCopyInt16ToFloat32_AVX2(const GInt16 *CPL_RESTRICT pSrc,
+                                 float *CPL_RESTRICT pDst, size_t nIters)
+{
+    size_t i = 0;
+    for (; i + 15 < nIters; i += 16)
+    {
+        __m128i xmm0 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i + 0));
+        __m128i xmm1 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i + 8));
+        _mm256_storeu_ps(pDst + i + 0,
+                         _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(xmm0)));
+        _mm256_storeu_ps(pDst + i + 8,
+                         _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(xmm1)));
+    }
+    for (; i < nIters; ++i)
+    {
+        pDst[i] = pSrc[i];
+    }
+}
+
+/************************************************************************/
+/*                    GDALCopyUInt16ToFloat32_AVX2()                    */
+/************************************************************************/
+
+void GDALCopyUInt16ToFloat32_AVX2(const GUInt16 *CPL_RESTRICT pSrc,
+                                  float *CPL_RESTRICT pDst, size_t nIters)
+{
+    size_t i = 0;
+    for (; i + 15 < nIters; i += 16)
+    {
+        __m128i xmm0 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i + 0));
+        __m128i xmm1 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i + 8));
+        _mm256_storeu_ps(pDst + i + 0,
+                         _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(xmm0)));
+        _mm256_storeu_ps(pDst + i + 8,
+                         _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(xmm1)));
+    }
+    for (; i < nIters; ++i)
+    {
+        pDst[i] = pSrc[i];
+    }
+}
+
+/************************************************************************/
+/*                     GDALCopyInt16ToFloat64_AVX2()                    */
+/************************************************************************/
+
+void GDALCopyInt16ToFloat64_AVX2(const GInt16 *CPL_RESTRICT pSrc,
+                                 double *CPL_RESTRICT pDst, size_t nIters)
+{
+    size_t i = 0;
+    for (; i + 7 < nIters; i += 8)
+    {
+        __m128i xmm =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i));
+        __m256i ymm = _mm256_cvtepi16_epi32(xmm);
+        _mm256_storeu_pd(pDst + i + 0,
+                         _mm256_cvtepi32_pd(_mm256_castsi256_si128(ymm)));
+        _mm256_storeu_pd(pDst + i + 4,
+                         _mm256_cvtepi32_pd(_mm256_extracti128_si256(ymm, 1)));
+    }
+    for (; i < nIters; ++i)
+    {
+        pDst[i] = pSrc[i];
+    }
+}
+
+/************************************************************************/
+/*                    GDALCopyUInt16ToFloat64_AVX2()                    */
+/************************************************************************/
+
+void GDALCopyUInt16ToFloat64_AVX2(const GUInt16 *CPL_RESTRICT pSrc,
+                                  double *CPL_RESTRICT pDst, size_t nIters)
+{
+    size_t i = 0;
+    for (; i + 7 < nIters; i += 8)
+    {
+        __m128i xmm =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i));
+        __m256i ymm = _mm256_cvtepu16_epi32(xmm);
+        _mm256_storeu_pd(pDst + i + 0,
+                         _mm256_cvtepi32_pd(_mm256_castsi256_si128(ymm)));
+        _mm256_storeu_pd(pDst + i + 4,
+                         _mm256_cvtepi32_pd(_mm256_extracti128_si256(ymm, 1)));
+    }
+    for (; i < nIters; ++i)
+    {
+        pDst[i] = pSrc[i];
+    }
+}
+
+#endif
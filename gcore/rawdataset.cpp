@@ -50,6 +50,7 @@
 #include "cpl_string.h"
 #include "cpl_virtualmem.h"
 #include "cpl_vsi.h"
+#include "cpl_vsi_virtual.h"
 #include "cpl_safemaths.hpp"
 #include "gdal.h"
 #include "gdal_priv.h"
@@ -1141,10 +1142,37 @@ CPLErr RawRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             const size_t nBytesToRW =
                 static_cast<size_t>(nPixelOffset) * (nXSize - 1) +
                 GDALGetDataTypeSizeBytes(eDataType);
-            GByte *pabyData =
-                static_cast<GByte *>(VSI_MALLOC_VERBOSE(nBytesToRW));
-            if (pabyData == nullptr)
-                return CE_Failure;
+
+            // If allowed, read from a read-only memory mapping of the
+            // region of the file covered by the request, which saves a
+            // read() and a copy per line.
+            std::shared_ptr<const GByte> pabyMapped;
+            vsi_l_offset nMapOffset = 0;
+            if (nLineOffset > 0 && nPixelOffset > 0 &&
+                !NeedsByteOrderChange() &&
+                CPLTestBool(CPLGetConfigOption("GDAL_RAW_USE_MMAP", "NO")))
+            {
+                const vsi_l_offset nLastLineDelta = static_cast<vsi_l_offset>(
+                    (nBufYSize - 1) * dfSrcYInc + EPS);
+                nMapOffset = nImgOffset +
+                             nYOff * static_cast<vsi_l_offset>(nLineOffset) +
+                             nXOff * static_cast<vsi_l_offset>(nPixelOffset);
+                const vsi_l_offset nMapSize =
+                    nLastLineDelta * nLineOffset + nBytesToRW;
+                if (nMapSize <= std::numeric_limits<size_t>::max())
+                {
+                    pabyMapped = fpRawL->MapRegion(
+                        nMapOffset, static_cast<size_t>(nMapSize));
+                }
+            }
+
+            GByte *pabyData = nullptr;
+            if (!pabyMapped)
+            {
+                pabyData = static_cast<GByte *>(VSI_MALLOC_VERBOSE(nBytesToRW));
+                if (pabyData == nullptr)
+                    return CE_Failure;
+            }
 
             for (int iLine = 0; iLine < nBufYSize; iLine++)
             {
@@ -1160,13 +1188,23 @@ CPLErr RawRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                     nOffset += nXOff * static_cast<vsi_l_offset>(nPixelOffset);
                 else
                     nOffset -= nXOff * static_cast<vsi_l_offset>(-nPixelOffset);
-                AccessBlock(nOffset, nBytesToRW, pabyData, nXSize);
+                const GByte *pabySrc;
+                if (pabyMapped)
+                {
+                    pabySrc = pabyMapped.get() +
+                              static_cast<size_t>(nOffset - nMapOffset);
+                }
+                else
+                {
+                    AccessBlock(nOffset, nBytesToRW, pabyData, nXSize);
+                    pabySrc = pabyData;
+                }
                 // Copy data from disk buffer to user block buffer and
                 // subsample, if needed.
                 if (nXSize == nBufXSize && nYSize == nBufYSize)
                 {
                     GDALCopyWords(
-                        pabyData, eDataType, nPixelOffset,
+                        pabySrc, eDataType, nPixelOffset,
                         static_cast<GByte *>(pData) + iLine * nLineSpace,
                         eBufType, static_cast<int>(nPixelSpace), nXSize);
                 }
@@ -1175,9 +1213,9 @@ CPLErr RawRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                     for (int iPixel = 0; iPixel < nBufXSize; iPixel++)
                     {
                         GDALCopyWords(
-                            pabyData + static_cast<vsi_l_offset>(
-                                           iPixel * dfSrcXInc + EPS) *
-                                           nPixelOffset,
+                            pabySrc + static_cast<vsi_l_offset>(
+                                          iPixel * dfSrcXInc + EPS) *
+                                          nPixelOffset,
                             eDataType, nPixelOffset,
                             static_cast<GByte *>(pData) + iLine * nLineSpace +
                                 iPixel * nPixelSpace,
@@ -52,6 +52,7 @@ typedef int GNMDirection;  // We use int values in order to save them to the
 #define GNM_MD_FETCHVERTEX "fetch_vertex"
 #define GNM_MD_NUM_PATHS "num_paths"
 #define GNM_MD_EMITTER "emitter"
+#define GNM_MD_PATH_SEARCH "path_search"
 
 // TODO: Constants for capabilities.
 // #define GNMCanChangeConnections "CanChangeConnections"
@@ -432,6 +433,7 @@ class CPL_DLL GNMGenericNetwork : public GNMNetwork
     virtual CPLErr LoadMetadataLayer(GDALDataset *const pDS);
     virtual CPLErr LoadGraphLayer(GDALDataset *const pDS);
     virtual CPLErr LoadGraph();
+    virtual CPLErr LoadVertexCoordinates();
     virtual CPLErr LoadFeaturesLayer(GDALDataset *const pDS);
     virtual CPLErr DeleteMetadataLayer() = 0;
     virtual CPLErr DeleteGraphLayer() = 0;
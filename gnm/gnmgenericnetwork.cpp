@@ -811,7 +811,31 @@ OGRLayer *GNMGenericNetwork::GetPath(GNMGFID nStartFID, GNMGFID nEndFID,
     {
         case GATDijkstraShortestPath:
         {
-            GNMPATH path = m_oGraph.DijkstraShortestPath(nStartFID, nEndFID);
+            const char *pszSearch = CSLFetchNameValueDef(
+                papszOptions, GNM_MD_PATH_SEARCH, "DIJKSTRA");
+            GNMPATH path;
+            if (EQUAL(pszSearch, "BIDIRECTIONAL"))
+            {
+                path = m_oGraph.BidirectionalDijkstraShortestPath(nStartFID,
+                                                                  nEndFID);
+            }
+            else if (EQUAL(pszSearch, "ASTAR"))
+            {
+                if (!m_oGraph.HasVertexCoordinates())
+                    LoadVertexCoordinates();
+                path = m_oGraph.AStarShortestPath(nStartFID, nEndFID);
+            }
+            else
+            {
+                if (!EQUAL(pszSearch, "DIJKSTRA"))
+                {
+                    CPLError(CE_Warning, CPLE_NotSupported,
+                             "Unsupported value for %s: %s. "
+                             "Using DIJKSTRA",
+                             GNM_MD_PATH_SEARCH, pszSearch);
+                }
+                path = m_oGraph.DijkstraShortestPath(nStartFID, nEndFID);
+            }
 
             // fill features in result layer
             FillResultLayer(poResLayer, path, 1, bReturnVertices, bReturnEdges);
@@ -1367,6 +1391,38 @@ CPLErr GNMGenericNetwork::LoadGraph()
     return CE_None;
 }
 
+CPLErr GNMGenericNetwork::LoadVertexCoordinates()
+{
+    // Point features of the network layers are the vertices of the graph.
+    for (size_t i = 0; i < m_apoLayers.size(); ++i)
+    {
+        OGRLayer *poLayer = m_apoLayers[i];
+        if (nullptr == poLayer)
+            continue;
+        const OGRwkbGeometryType eType = wkbFlatten(poLayer->GetGeomType());
+        if (eType != wkbPoint && eType != wkbUnknown)
+            continue;
+
+        poLayer->ResetReading();
+        for (auto &&poFeature : poLayer)
+        {
+            const OGRGeometry *poGeom = poFeature->GetGeometryRef();
+            if (poGeom == nullptr ||
+                wkbFlatten(poGeom->getGeometryType()) != wkbPoint)
+                continue;
+            const OGRPoint *poPoint = poGeom->toPoint();
+            if (!poPoint->IsEmpty())
+            {
+                m_oGraph.SetVertexCoordinates(poFeature->GetFID(),
+                                              poPoint->getX(),
+                                              poPoint->getY());
+            }
+        }
+    }
+
+    return CE_None;
+}
+
 CPLErr GNMGenericNetwork::LoadFeaturesLayer(GDALDataset *const pDS)
 {
     m_poFeaturesLayer = pDS->GetLayerByName(GNM_SYSLAYER_FEATURES);
@@ -30,11 +30,104 @@
 
 #include "gnmgraph.h"
 #include "gnm_priv.h"
+#include "gdal_thread_pool.h"
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <set>
 
 //! @cond Doxygen_Suppress
+/************************************************************************/
+/*                           GNMGraph::Index                            */
+/************************************************************************/
+
+// Compressed sparse row representation of the graph. Vertices and edges are
+// referenced by their rank in the sorted arrays of identificators, and the
+// outcome (resp. income) edges of the i-th vertex are stored at
+// [anOutOffsets[i], anOutOffsets[i+1]) (resp. anInOffsets) in the adjacency
+// arrays.
+struct GNMGraph::Index
+{
+    std::vector<GNMGFID> anVertexFIDs{};
+    std::vector<char> abVertexBlocked{};
+
+    std::vector<GNMGFID> anEdgeFIDs{};
+    std::vector<double> adfEdgeCosts{};
+    std::vector<char> abEdgeBlocked{};
+
+    std::vector<size_t> anOutOffsets{};
+    std::vector<int> anOutEdges{};
+    std::vector<int> anOutTargets{};
+
+    std::vector<size_t> anInOffsets{};
+    std::vector<int> anInEdges{};
+    std::vector<int> anInSources{};
+
+    bool bHasCoordinates = false;
+    std::vector<double> adfX{};
+    std::vector<double> adfY{};
+    // Lowest edge cost per distance unit, used to scale the A* heuristic.
+    double dfCostPerDistance = 0.0;
+
+    static int Find(const std::vector<GNMGFID> &anFIDs, GNMGFID nFID)
+    {
+        const auto it = std::lower_bound(anFIDs.begin(), anFIDs.end(), nFID);
+        if (it == anFIDs.end() || *it != nFID)
+            return -1;
+        return static_cast<int>(it - anFIDs.begin());
+    }
+
+    int FindVertex(GNMGFID nFID) const
+    {
+        return Find(anVertexFIDs, nFID);
+    }
+
+    int FindEdge(GNMGFID nFID) const
+    {
+        return Find(anEdgeFIDs, nFID);
+    }
+
+    double Heuristic(int iVertex, int iEnd) const
+    {
+        if (dfCostPerDistance == 0.0)
+            return 0.0;
+        const double dfDX = adfX[iVertex] - adfX[iEnd];
+        const double dfDY = adfY[iVertex] - adfY[iEnd];
+        return dfCostPerDistance * std::sqrt(dfDX * dfDX + dfDY * dfDY);
+    }
+    void SearchPathTree(int iStart, int iEnd,
+                        const std::vector<double> &adfCosts,
+                        const std::vector<char> &abEdgeBlocked, bool bAStar,
+                        std::vector<double> &adfMarks,
+                        std::vector<int> &anPredEdges,
+                        std::vector<int> &anPredVertices) const;
+    GNMPATH GetTreePath(int iStart, int iEnd,
+                        const std::vector<int> &anPredEdges,
+                        const std::vector<int> &anPredVertices) const;
+    GNMPATH GetPath(GNMGFID nStartFID, GNMGFID nEndFID,
+                    const std::vector<double> &adfCosts,
+                    const std::vector<char> &abEdgeBlocked, bool bAStar) const;
+    GNMPATH GetBidirectionalPath(GNMGFID nStartFID, GNMGFID nEndFID) const;
+    void GetEdgeStates(const std::map<GNMGFID, GNMStdEdge> &mstEdges,
+                       std::vector<double> &adfCosts,
+                       std::vector<char> &abBlocked) const;
+    void ExpandVertices(const int *panVertices, size_t nCount,
+                        GNMPATH &aoConnected,
+                        std::vector<int> &anTargets) const;
+
+    // Job of the parallel breadth-first search.
+    struct ExpandJob
+    {
+        const Index *poIndex = nullptr;
+        const int *panVertices = nullptr;
+        size_t nCount = 0;
+        GNMPATH aoConnected{};
+        std::vector<int> anTargets{};
+
+        static void Run(void *pData);
+    };
+};
+
 GNMGraph::GNMGraph()
 {
 }
@@ -51,6 +144,7 @@ void GNMGraph::AddVertex(GNMGFID nFID)
     GNMStdVertex stVertex;
     stVertex.bIsBlocked = false;
     m_mstVertices[nFID] = stVertex;
+    InvalidateIndex();
 }
 
 void GNMGraph::DeleteVertex(GNMGFID nFID)
@@ -68,6 +162,8 @@ void GNMGraph::DeleteVertex(GNMGFID nFID)
     }
     for (size_t i = 0; i < aoIdsToErase.size(); i++)
         m_mstEdges.erase(aoIdsToErase[i]);
+
+    InvalidateIndex();
 }
 
 void GNMGraph::AddEdge(GNMGFID nConFID, GNMGFID nSrcFID, GNMGFID nTgtFID,
@@ -113,6 +209,8 @@ void GNMGraph::AddEdge(GNMGFID nConFID, GNMGFID nSrcFID, GNMGFID nTgtFID,
     {
         itSrs->second.anOutEdgeFIDs.push_back(nConFID);
     }
+
+    InvalidateIndex();
 }
 
 void GNMGraph::DeleteEdge(GNMGFID nConFID)
@@ -127,6 +225,8 @@ void GNMGraph::DeleteEdge(GNMGFID nConFID)
                         it.second.anOutEdgeFIDs.end(), nConFID),
             it.second.anOutEdgeFIDs.end());
     }
+
+    InvalidateIndex();
 }
 
 void GNMGraph::ChangeEdge(GNMGFID nFID, double dfCost, double dfInvCost)
@@ -136,6 +236,7 @@ void GNMGraph::ChangeEdge(GNMGFID nFID, double dfCost, double dfInvCost)
     {
         it->second.dfDirCost = dfCost;
         it->second.dfInvCost = dfInvCost;
+        InvalidateIndex();
     }
 }
 
@@ -146,6 +247,13 @@ void GNMGraph::ChangeBlockState(GNMGFID nFID, bool bBlock)
     if (itv != m_mstVertices.end())
     {
         itv->second.bIsBlocked = bBlock;
+        // The block state is updated in place in the index, if any.
+        if (m_poIndex)
+        {
+            const int iVertex = m_poIndex->FindVertex(nFID);
+            if (iVertex >= 0)
+                m_poIndex->abVertexBlocked[iVertex] = bBlock;
+        }
         return;
     }
 
@@ -154,6 +262,12 @@ void GNMGraph::ChangeBlockState(GNMGFID nFID, bool bBlock)
     if (ite != m_mstEdges.end())
     {
         ite->second.bIsBlocked = bBlock;
+        if (m_poIndex)
+        {
+            const int iEdge = m_poIndex->FindEdge(nFID);
+            if (iEdge >= 0)
+                m_poIndex->abEdgeBlocked[iEdge] = bBlock;
+        }
     }
 }
 
@@ -179,69 +293,558 @@ void GNMGraph::ChangeAllBlockState(bool bBlock)
     {
         ite->second.bIsBlocked = bBlock;
     }
+
+    if (m_poIndex)
+    {
+        std::fill(m_poIndex->abVertexBlocked.begin(),
+                  m_poIndex->abVertexBlocked.end(), bBlock);
+        std::fill(m_poIndex->abEdgeBlocked.begin(),
+                  m_poIndex->abEdgeBlocked.end(), bBlock);
+    }
 }
 
-GNMPATH
-GNMGraph::DijkstraShortestPath(GNMGFID nStartFID, GNMGFID nEndFID,
-                               const std::map<GNMGFID, GNMStdEdge> &mstEdges)
+/************************************************************************/
+/*                         GNMGraph::GetIndex()                         */
+/************************************************************************/
+
+// Returns the CSR index of the graph, building it if needed.
+const GNMGraph::Index &GNMGraph::GetIndex()
 {
-    std::map<GNMGFID, GNMGFID> mnShortestTree;
-    DijkstraShortestPathTree(nStartFID, mstEdges, mnShortestTree);
+    if (m_poIndex)
+        return *m_poIndex;
 
-    // We search for a path in the resulting tree, starting from end point to
-    // start point.
+    auto poIndex = std::make_unique<Index>();
 
-    GNMPATH aoShortestPath;
-    GNMGFID nNextVertexId = nEndFID;
-    std::map<GNMGFID, GNMGFID>::iterator it;
-    EDGEVERTEXPAIR buf;
+    poIndex->anVertexFIDs.reserve(m_mstVertices.size());
+    poIndex->abVertexBlocked.reserve(m_mstVertices.size());
+    for (const auto &oIter : m_mstVertices)
+    {
+        poIndex->anVertexFIDs.push_back(oIter.first);
+        poIndex->abVertexBlocked.push_back(oIter.second.bIsBlocked);
+    }
 
-    while (true)
+    // Edges end vertices, as vertex ranks.
+    std::vector<int> anEdgeSrc;
+    std::vector<int> anEdgeTgt;
+    anEdgeSrc.reserve(m_mstEdges.size());
+    anEdgeTgt.reserve(m_mstEdges.size());
+    poIndex->anEdgeFIDs.reserve(m_mstEdges.size());
+    poIndex->adfEdgeCosts.reserve(m_mstEdges.size());
+    poIndex->abEdgeBlocked.reserve(m_mstEdges.size());
+    for (const auto &oIter : m_mstEdges)
+    {
+        poIndex->anEdgeFIDs.push_back(oIter.first);
+        // We go in any edge from source to target so we take only
+        // direct cost (even if an edge is bi-directed).
+        poIndex->adfEdgeCosts.push_back(oIter.second.dfDirCost);
+        poIndex->abEdgeBlocked.push_back(oIter.second.bIsBlocked);
+        anEdgeSrc.push_back(poIndex->FindVertex(oIter.second.nSrcVertexFID));
+        anEdgeTgt.push_back(poIndex->FindVertex(oIter.second.nTgtVertexFID));
+    }
+
+    // Outcome edges, in the order of the anOutEdgeFIDs arrays.
+    const size_t nVertexCount = poIndex->anVertexFIDs.size();
+    poIndex->anOutOffsets.reserve(nVertexCount + 1);
+    poIndex->anOutOffsets.push_back(0);
+    int iVertex = 0;
+    for (const auto &oIter : m_mstVertices)
+    {
+        for (const GNMGFID nEdgeFID : oIter.second.anOutEdgeFIDs)
+        {
+            const int iEdge = poIndex->FindEdge(nEdgeFID);
+            if (iEdge < 0)
+                continue;
+            int iTarget;
+            if (anEdgeSrc[iEdge] == iVertex)
+                iTarget = anEdgeTgt[iEdge];
+            else if (anEdgeTgt[iEdge] == iVertex)
+                iTarget = anEdgeSrc[iEdge];
+            else
+                continue;
+            if (iTarget < 0)
+                continue;
+            poIndex->anOutEdges.push_back(iEdge);
+            poIndex->anOutTargets.push_back(iTarget);
+        }
+        poIndex->anOutOffsets.push_back(poIndex->anOutEdges.size());
+        ++iVertex;
+    }
+
+    // Income edges, i.e. the transposed adjacency, used by the backward
+    // search of the bidirectional Dijkstra algorithm.
+    poIndex->anInOffsets.assign(nVertexCount + 1, 0);
+    for (const int iTarget : poIndex->anOutTargets)
+        poIndex->anInOffsets[iTarget + 1]++;
+    for (size_t i = 0; i < nVertexCount; ++i)
+        poIndex->anInOffsets[i + 1] += poIndex->anInOffsets[i];
+    poIndex->anInEdges.resize(poIndex->anOutEdges.size());
+    poIndex->anInSources.resize(poIndex->anOutEdges.size());
+    std::vector<size_t> anInCursors(poIndex->anInOffsets.begin(),
+                                    poIndex->anInOffsets.end() - 1);
+    for (size_t i = 0; i < nVertexCount; ++i)
     {
-        it = mnShortestTree.find(nNextVertexId);
+        for (size_t k = poIndex->anOutOffsets[i];
+             k < poIndex->anOutOffsets[i + 1]; ++k)
+        {
+            const size_t nPos = anInCursors[poIndex->anOutTargets[k]]++;
+            poIndex->anInEdges[nPos] = poIndex->anOutEdges[k];
+            poIndex->anInSources[nPos] = static_cast<int>(i);
+        }
+    }
 
-        if (it == mnShortestTree.end())
+    // Vertex coordinates for the A* heuristic. The euclidean distance is
+    // scaled by the lowest cost per distance unit of the edges, so that the
+    // heuristic never overestimates the cost to the end vertex.
+    if (!m_moVertexCoordinates.empty())
+    {
+        poIndex->bHasCoordinates = true;
+        poIndex->adfX.resize(nVertexCount);
+        poIndex->adfY.resize(nVertexCount);
+        for (size_t i = 0; i < nVertexCount; ++i)
+        {
+            const auto oIter =
+                m_moVertexCoordinates.find(poIndex->anVertexFIDs[i]);
+            if (oIter == m_moVertexCoordinates.end())
+            {
+                CPLDebug("GNM",
+                         "No coordinates for vertex " CPL_FRMT_GIB
+                         ". A* heuristic disabled",
+                         poIndex->anVertexFIDs[i]);
+                poIndex->bHasCoordinates = false;
+                break;
+            }
+            poIndex->adfX[i] = oIter->second.first;
+            poIndex->adfY[i] = oIter->second.second;
+        }
+
+        if (poIndex->bHasCoordinates)
+        {
+            double dfCostPerDistance = std::numeric_limits<double>::infinity();
+            for (size_t i = 0; i < nVertexCount; ++i)
+            {
+                for (size_t k = poIndex->anOutOffsets[i];
+                     k < poIndex->anOutOffsets[i + 1]; ++k)
+                {
+                    const int iTarget = poIndex->anOutTargets[k];
+                    const double dfDX =
+                        poIndex->adfX[i] - poIndex->adfX[iTarget];
+                    const double dfDY =
+                        poIndex->adfY[i] - poIndex->adfY[iTarget];
+                    const double dfDist = std::sqrt(dfDX * dfDX + dfDY * dfDY);
+                    if (dfDist > 0)
+                    {
+                        dfCostPerDistance = std::min(
+                            dfCostPerDistance,
+                            poIndex->adfEdgeCosts[poIndex->anOutEdges[k]] /
+                                dfDist);
+                    }
+                }
+            }
+            if (std::isfinite(dfCostPerDistance) && dfCostPerDistance > 0)
+                poIndex->dfCostPerDistance = dfCostPerDistance;
+        }
+        else
         {
-            // We haven't found the start vertex - there is no path between
-            // to given vertices in a shortest-path tree.
+            poIndex->adfX.clear();
+            poIndex->adfY.clear();
+        }
+    }
+
+    m_poIndex = std::move(poIndex);
+    return *m_poIndex;
+}
+
+/************************************************************************/
+/*                      GNMGraph::InvalidateIndex()                     */
+/************************************************************************/
+
+// Must be called after each change of the graph structure or edge costs.
+void GNMGraph::InvalidateIndex()
+{
+    m_poIndex.reset();
+}
+
+/************************************************************************/
+/*                    GNMGraph::Index::SearchPathTree()                 */
+/************************************************************************/
+
+namespace
+{
+struct GNMQueueItem
+{
+    double dfKey;
+    size_t nOrder;
+    int iVertex;
+};
+
+// Orders the items by ascending key, and by insertion order for equal keys.
+struct GNMQueueItemGreater
+{
+    bool operator()(const GNMQueueItem &a, const GNMQueueItem &b) const
+    {
+        if (a.dfKey != b.dfKey)
+            return a.dfKey > b.dfKey;
+        return a.nOrder > b.nOrder;
+    }
+};
+
+typedef std::priority_queue<GNMQueueItem, std::vector<GNMQueueItem>,
+                            GNMQueueItemGreater>
+    GNMQueue;
+}  // namespace
+
+// Calculates the best path tree from iStart with the Dijkstra algorithm (or
+// A* if bAStar is set and vertex coordinates are available). The search
+// stops as soon as iEnd, if not negative, is reached. adfMarks is set to the
+// cost of the best path to each vertex (infinity if not reached), anPredEdges
+// and anPredVertices to the edge and vertex leading to it.
+void GNMGraph::Index::SearchPathTree(int iStart, int iEnd,
+                                     const std::vector<double> &adfCosts,
+                                     const std::vector<char> &abEdgeBlocked,
+                                     bool bAStar, std::vector<double> &adfMarks,
+                                     std::vector<int> &anPredEdges,
+                                     std::vector<int> &anPredVertices) const
+{
+    const size_t nVertexCount = anVertexFIDs.size();
+    adfMarks.assign(nVertexCount, std::numeric_limits<double>::infinity());
+    anPredEdges.assign(nVertexCount, -1);
+    anPredVertices.assign(nVertexCount, -1);
+    std::vector<char> abSeen(nVertexCount, false);
+    const bool bUseHeuristic = bAStar && bHasCoordinates && iEnd >= 0;
+
+    // The queue may hold outdated items for already seen vertices: they are
+    // skipped, which is cheaper than updating the queue.
+    GNMQueue oToSee;
+    size_t nOrder = 0;
+    adfMarks[iStart] = 0.0;
+    oToSee.push(
+        {bUseHeuristic ? Heuristic(iStart, iEnd) : 0.0, nOrder++, iStart});
+
+    while (!oToSee.empty())
+    {
+        const int iCurrent = oToSee.top().iVertex;
+        oToSee.pop();
+        if (abSeen[iCurrent])
+            continue;
+        abSeen[iCurrent] = true;
+        if (iCurrent == iEnd)
             break;
+
+        const double dfCurrentMark = adfMarks[iCurrent];
+        for (size_t k = anOutOffsets[iCurrent]; k < anOutOffsets[iCurrent + 1];
+             ++k)
+        {
+            const int iEdge = anOutEdges[k];
+            if (abEdgeBlocked[iEdge])
+                continue;
+
+            const int iTarget = anOutTargets[k];
+            const double dfNewMark = dfCurrentMark + adfCosts[iEdge];
+            if (!abSeen[iTarget] && dfNewMark < adfMarks[iTarget] &&
+                !abVertexBlocked[iTarget])
+            {
+                adfMarks[iTarget] = dfNewMark;
+                anPredEdges[iTarget] = iEdge;
+                anPredVertices[iTarget] = iCurrent;
+                oToSee.push(
+                    {bUseHeuristic ? dfNewMark + Heuristic(iTarget, iEnd)
+                                   : dfNewMark,
+                     nOrder++, iTarget});
+            }
         }
-        else if (it->first == nStartFID)
+    }
+}
+
+/************************************************************************/
+/*                     GNMGraph::Index::GetTreePath()                   */
+/************************************************************************/
+
+// Returns the path from iStart to iEnd in a best path tree.
+GNMPATH
+GNMGraph::Index::GetTreePath(int iStart, int iEnd,
+                             const std::vector<int> &anPredEdges,
+                             const std::vector<int> &anPredVertices) const
+{
+    GNMPATH aoPath;
+    for (int iVertex = iEnd; iVertex != iStart;
+         iVertex = anPredVertices[iVertex])
+    {
+        aoPath.push_back(std::make_pair(anVertexFIDs[iVertex],
+                                        anEdgeFIDs[anPredEdges[iVertex]]));
+    }
+    aoPath.push_back(std::make_pair(anVertexFIDs[iStart], -1));
+
+    // Revert array because the first vertex is now the last in path.
+    std::reverse(aoPath.begin(), aoPath.end());
+    return aoPath;
+}
+
+/************************************************************************/
+/*                       GNMGraph::Index::GetPath()                     */
+/************************************************************************/
+
+GNMPATH GNMGraph::Index::GetPath(GNMGFID nStartFID, GNMGFID nEndFID,
+                                 const std::vector<double> &adfCosts,
+                                 const std::vector<char> &abEdgeBlocked,
+                                 bool bAStar) const
+{
+    const int iStart = FindVertex(nStartFID);
+    if (iStart < 0)
+    {
+        GNMPATH aoPath;
+        if (nStartFID == nEndFID)
+            aoPath.push_back(std::make_pair(nStartFID, -1));
+        return aoPath;
+    }
+    const int iEnd = FindVertex(nEndFID);
+    if (iEnd < 0)
+        return GNMPATH();
+
+    std::vector<double> adfMarks;
+    std::vector<int> anPredEdges;
+    std::vector<int> anPredVertices;
+    SearchPathTree(iStart, iEnd, adfCosts, abEdgeBlocked, bAStar, adfMarks,
+                   anPredEdges, anPredVertices);
+    if (adfMarks[iEnd] == std::numeric_limits<double>::infinity())
+        return GNMPATH();
+    return GetTreePath(iStart, iEnd, anPredEdges, anPredVertices);
+}
+
+/************************************************************************/
+/*               GNMGraph::Index::GetBidirectionalPath()                */
+/************************************************************************/
+
+GNMPATH GNMGraph::Index::GetBidirectionalPath(GNMGFID nStartFID,
+                                              GNMGFID nEndFID) const
+{
+    const int iStart = FindVertex(nStartFID);
+    const int iEnd = FindVertex(nEndFID);
+    if (iStart < 0 || iEnd < 0 || iStart == iEnd)
+        return GetPath(nStartFID, nEndFID, adfEdgeCosts, abEdgeBlocked, false);
+    if (abVertexBlocked[iEnd])
+        return GNMPATH();
+
+    const double dfInfinity = std::numeric_limits<double>::infinity();
+    const size_t nVertexCount = anVertexFIDs.size();
+
+    // Forward search from the start vertex on the outcome edges.
+    std::vector<double> adfFwdMarks(nVertexCount, dfInfinity);
+    std::vector<int> anPredEdges(nVertexCount, -1);
+    std::vector<int> anPredVertices(nVertexCount, -1);
+    std::vector<char> abFwdSeen(nVertexCount, false);
+    GNMQueue oFwdToSee;
+
+    // Backward search from the end vertex on the income edges.
+    std::vector<double> adfBwdMarks(nVertexCount, dfInfinity);
+    std::vector<int> anSuccEdges(nVertexCount, -1);
+    std::vector<int> anSuccVertices(nVertexCount, -1);
+    std::vector<char> abBwdSeen(nVertexCount, false);
+    GNMQueue oBwdToSee;
+
+    size_t nOrder = 0;
+    adfFwdMarks[iStart] = 0.0;
+    oFwdToSee.push({0.0, nOrder++, iStart});
+    adfBwdMarks[iEnd] = 0.0;
+    oBwdToSee.push({0.0, nOrder++, iEnd});
+
+    // Cost of the best path found so far, through iMeeting.
+    double dfBestCost = dfInfinity;
+    int iMeeting = -1;
+    const auto UpdateBestPath = [&](int iVertex)
+    {
+        const double dfCost = adfFwdMarks[iVertex] + adfBwdMarks[iVertex];
+        if (dfCost < dfBestCost)
         {
-            // We've reached the start vertex and return an array.
-            aoShortestPath.push_back(std::make_pair(nNextVertexId, -1));
+            dfBestCost = dfCost;
+            iMeeting = iVertex;
+        }
+    };
 
-            // Revert array because the first vertex is now the last in path.
-            int size = static_cast<int>(aoShortestPath.size());
-            for (int i = 0; i < size / 2; ++i)
+    while (true)
+    {
+        while (!oFwdToSee.empty() && abFwdSeen[oFwdToSee.top().iVertex])
+            oFwdToSee.pop();
+        while (!oBwdToSee.empty() && abBwdSeen[oBwdToSee.top().iVertex])
+            oBwdToSee.pop();
+        if (oFwdToSee.empty() || oBwdToSee.empty())
+            break;
+
+        // No better path can be found once the sum of the lowest marks of
+        // both searches reaches the cost of the best path.
+        if (oFwdToSee.top().dfKey + oBwdToSee.top().dfKey >= dfBestCost)
+            break;
+
+        if (oFwdToSee.size() <= oBwdToSee.size())
+        {
+            const int iCurrent = oFwdToSee.top().iVertex;
+            oFwdToSee.pop();
+            abFwdSeen[iCurrent] = true;
+            const double dfCurrentMark = adfFwdMarks[iCurrent];
+            for (size_t k = anOutOffsets[iCurrent];
+                 k < anOutOffsets[iCurrent + 1]; ++k)
             {
-                buf = aoShortestPath[i];
-                aoShortestPath[i] = aoShortestPath[size - i - 1];
-                aoShortestPath[size - i - 1] = buf;
+                const int iEdge = anOutEdges[k];
+                const int iTarget = anOutTargets[k];
+                if (abEdgeBlocked[iEdge] || abFwdSeen[iTarget] ||
+                    abVertexBlocked[iTarget])
+                    continue;
+                const double dfNewMark = dfCurrentMark + adfEdgeCosts[iEdge];
+                if (dfNewMark < adfFwdMarks[iTarget])
+                {
+                    adfFwdMarks[iTarget] = dfNewMark;
+                    anPredEdges[iTarget] = iEdge;
+                    anPredVertices[iTarget] = iCurrent;
+                    oFwdToSee.push({dfNewMark, nOrder++, iTarget});
+                    UpdateBestPath(iTarget);
+                }
             }
-            return aoShortestPath;
         }
         else
         {
-            // There is only one edge which leads to this vertex, because we
-            // analyse a tree. We add this edge with its target vertex into
-            // final array.
-            aoShortestPath.push_back(std::make_pair(nNextVertexId, it->second));
-
-            // An edge has only two vertices, so we get the opposite one to the
-            // current vertex in order to continue search backwards.
-            nNextVertexId = GetOppositVertex(it->second, it->first);
+            const int iCurrent = oBwdToSee.top().iVertex;
+            oBwdToSee.pop();
+            abBwdSeen[iCurrent] = true;
+            const double dfCurrentMark = adfBwdMarks[iCurrent];
+            for (size_t k = anInOffsets[iCurrent];
+                 k < anInOffsets[iCurrent + 1]; ++k)
+            {
+                const int iEdge = anInEdges[k];
+                const int iSource = anInSources[k];
+                // The start vertex may be left even if it is blocked.
+                if (abEdgeBlocked[iEdge] || abBwdSeen[iSource] ||
+                    (abVertexBlocked[iSource] && iSource != iStart))
+                    continue;
+                const double dfNewMark = dfCurrentMark + adfEdgeCosts[iEdge];
+                if (dfNewMark < adfBwdMarks[iSource])
+                {
+                    adfBwdMarks[iSource] = dfNewMark;
+                    anSuccEdges[iSource] = iEdge;
+                    anSuccVertices[iSource] = iCurrent;
+                    oBwdToSee.push({dfNewMark, nOrder++, iSource});
+                    UpdateBestPath(iSource);
+                }
+            }
+        }
+    }
+
+    if (iMeeting < 0)
+        return GNMPATH();
+
+    GNMPATH aoPath = GetTreePath(iStart, iMeeting, anPredEdges, anPredVertices);
+    for (int iVertex = iMeeting; iVertex != iEnd;
+         iVertex = anSuccVertices[iVertex])
+    {
+        aoPath.push_back(std::make_pair(anVertexFIDs[anSuccVertices[iVertex]],
+                                        anEdgeFIDs[anSuccEdges[iVertex]]));
+    }
+    return aoPath;
+}
+
+/************************************************************************/
+/*                  GNMGraph::Index::GetEdgeStates()                    */
+/************************************************************************/
+
+// Gets the costs and block states of the indexed edges from mstEdges. The
+// edges missing from mstEdges are considered as blocked.
+void GNMGraph::Index::GetEdgeStates(
+    const std::map<GNMGFID, GNMStdEdge> &mstEdges,
+    std::vector<double> &adfCosts, std::vector<char> &abBlocked) const
+{
+    adfCosts.resize(anEdgeFIDs.size());
+    abBlocked.resize(anEdgeFIDs.size());
+    for (size_t i = 0; i < anEdgeFIDs.size(); ++i)
+    {
+        const auto oIter = mstEdges.find(anEdgeFIDs[i]);
+        if (oIter == mstEdges.end())
+        {
+            adfCosts[i] = std::numeric_limits<double>::infinity();
+            abBlocked[i] = true;
+        }
+        else
+        {
+            adfCosts[i] = oIter->second.dfDirCost;
+            abBlocked[i] = oIter->second.bIsBlocked;
+        }
+    }
+}
+
+/************************************************************************/
+/*                  GNMGraph::Index::ExpandVertices()                   */
+/************************************************************************/
+
+// Appends the outcome edges of the given vertices to aoConnected and their
+// non blocked target vertices to anTargets.
+void GNMGraph::Index::ExpandVertices(const int *panVertices, size_t nCount,
+                                     GNMPATH &aoConnected,
+                                     std::vector<int> &anTargets) const
+{
+    for (size_t i = 0; i < nCount; ++i)
+    {
+        const int iVertex = panVertices[i];
+        for (size_t k = anOutOffsets[iVertex]; k < anOutOffsets[iVertex + 1];
+             ++k)
+        {
+            // ISSUE: think about to return a sequence of vertices and
+            // edges (which is more universal), as now we are going to
+            // return only sequence of edges.
+            aoConnected.push_back(std::make_pair(anVertexFIDs[iVertex],
+                                                 anEdgeFIDs[anOutEdges[k]]));
+            const int iTarget = anOutTargets[k];
+            if (!abVertexBlocked[iTarget])
+                anTargets.push_back(iTarget);
         }
     }
+}
+
+void GNMGraph::Index::ExpandJob::Run(void *pData)
+{
+    auto psJob = static_cast<ExpandJob *>(pData);
+    psJob->poIndex->ExpandVertices(psJob->panVertices, psJob->nCount,
+                                   psJob->aoConnected, psJob->anTargets);
+}
 
-    // return empty array
-    GNMPATH oRet;
-    return oRet;
+GNMPATH
+GNMGraph::DijkstraShortestPath(GNMGFID nStartFID, GNMGFID nEndFID,
+                               const std::map<GNMGFID, GNMStdEdge> &mstEdges)
+{
+    const Index &oIndex = GetIndex();
+    std::vector<double> adfCosts;
+    std::vector<char> abEdgeBlocked;
+    oIndex.GetEdgeStates(mstEdges, adfCosts, abEdgeBlocked);
+    return oIndex.GetPath(nStartFID, nEndFID, adfCosts, abEdgeBlocked, false);
 }
 
 GNMPATH GNMGraph::DijkstraShortestPath(GNMGFID nStartFID, GNMGFID nEndFID)
 {
-    return DijkstraShortestPath(nStartFID, nEndFID, m_mstEdges);
+    const Index &oIndex = GetIndex();
+    return oIndex.GetPath(nStartFID, nEndFID, oIndex.adfEdgeCosts,
+                          oIndex.abEdgeBlocked, false);
+}
+
+GNMPATH GNMGraph::BidirectionalDijkstraShortestPath(GNMGFID nStartFID,
+                                                    GNMGFID nEndFID)
+{
+    return GetIndex().GetBidirectionalPath(nStartFID, nEndFID);
+}
+
+GNMPATH GNMGraph::AStarShortestPath(GNMGFID nStartFID, GNMGFID nEndFID)
+{
+    const Index &oIndex = GetIndex();
+    if (!oIndex.bHasCoordinates)
+        CPLDebug("GNM", "No vertex coordinates. A* behaves as Dijkstra");
+    return oIndex.GetPath(nStartFID, nEndFID, oIndex.adfEdgeCosts,
+                          oIndex.abEdgeBlocked, true);
+}
+
+void GNMGraph::SetVertexCoordinates(GNMGFID nFID, double dfX, double dfY)
+{
+    m_moVertexCoordinates[nFID] = std::make_pair(dfX, dfY);
+    InvalidateIndex();
+}
+
+bool GNMGraph::HasVertexCoordinates() const
+{
+    return !m_moVertexCoordinates.empty();
 }
 
 std::vector<GNMPATH> GNMGraph::KShortestPaths(GNMGFID nStartFID,
@@ -273,17 +876,17 @@ std::vector<GNMPATH> GNMGraph::KShortestPaths(GNMGFID nStartFID,
     size_t i, k, l;
     GNMPATH::iterator itAk, tempIt, itR;
     std::vector<GNMPATH>::iterator itA;
-    std::map<GNMGFID, double>::iterator itDel;
     GNMPATH aoRootPath, aoRootPathOther, aoSpurPath;
-    GNMGFID nSpurNode, nVertexToDel, nEdgeToDel;
+    GNMGFID nSpurNode;
     double dfSumCost;
 
-    std::map<GNMGFID, GNMStdEdge> mstEdges = m_mstEdges;
+    const Index &oIndex = GetIndex();
+    std::vector<double> adfCosts = oIndex.adfEdgeCosts;
+    const double dfInfinity = std::numeric_limits<double>::infinity();
 
     for (k = 0; k < nK - 1; ++k)  // -1 because we have already found one
     {
-        std::map<GNMGFID, double>
-            mDeletedEdges;  // for infinity costs assignment
+        std::vector<int> anDeletedEdges;  // for infinity costs assignment
         itAk = A[k].begin();
 
         for (i = 0; i < A[k].size() - 1; ++i)  // avoid end node
@@ -331,10 +934,12 @@ std::vector<GNMPATH> GNMGraph::KShortestPaths(GNMGFID nStartFID,
                     (i < aoRootPathOther.size()))
                 {
                     tempIt = itA->begin() + i + 1;
-                    mDeletedEdges.insert(std::make_pair(
-                        tempIt->second, mstEdges[tempIt->second].dfDirCost));
-                    mstEdges[tempIt->second].dfDirCost =
-                        std::numeric_limits<double>::infinity();
+                    const int iEdge = oIndex.FindEdge(tempIt->second);
+                    if (iEdge >= 0)
+                    {
+                        anDeletedEdges.push_back(iEdge);
+                        adfCosts[iEdge] = dfInfinity;
+                    }
                 }
             }
 
@@ -347,33 +952,33 @@ std::vector<GNMPATH> GNMGraph::KShortestPaths(GNMGFID nStartFID,
             // end()-1, because we should not remove the spur node
             for (itR = aoRootPath.begin(); itR != aoRootPath.end() - 1; ++itR)
             {
-                nVertexToDel = itR->first;
-                for (l = 0;
-                     l < m_mstVertices[nVertexToDel].anOutEdgeFIDs.size(); ++l)
+                const int iVertexToDel = oIndex.FindVertex(itR->first);
+                if (iVertexToDel < 0)
+                    continue;
+                for (l = oIndex.anOutOffsets[iVertexToDel];
+                     l < oIndex.anOutOffsets[iVertexToDel + 1]; ++l)
                 {
-                    nEdgeToDel = m_mstVertices[nVertexToDel].anOutEdgeFIDs[l];
-                    mDeletedEdges.insert(std::make_pair(
-                        nEdgeToDel, mstEdges[nEdgeToDel].dfDirCost));
-                    mstEdges[nEdgeToDel].dfDirCost =
-                        std::numeric_limits<double>::infinity();
+                    const int iEdgeToDel = oIndex.anOutEdges[l];
+                    anDeletedEdges.push_back(iEdgeToDel);
+                    adfCosts[iEdgeToDel] = dfInfinity;
                 }
             }
 
             // Find the new best path in the modified graph.
-            aoSpurPath = DijkstraShortestPath(nSpurNode, nEndFID, mstEdges);
+            aoSpurPath = oIndex.GetPath(nSpurNode, nEndFID, adfCosts,
+                                        oIndex.abEdgeBlocked, false);
 
             // Firstly, restore deleted edges in order to calculate the summary
             // cost of the path correctly later, because the costs will be
             // gathered from the initial graph.
             // We must do it here, after each edge removing, because the later
             // Dijkstra searches must consider these edges.
-            for (itDel = mDeletedEdges.begin(); itDel != mDeletedEdges.end();
-                 ++itDel)
+            for (const int iEdge : anDeletedEdges)
             {
-                mstEdges[itDel->first].dfDirCost = itDel->second;
+                adfCosts[iEdge] = oIndex.adfEdgeCosts[iEdge];
             }
 
-            mDeletedEdges.clear();
+            anDeletedEdges.clear();
 
             // If the part of a new best path has been found we form a full one
             // and add it to the candidates array.
@@ -392,7 +997,9 @@ std::vector<GNMPATH> GNMGraph::KShortestPaths(GNMGFID nStartFID,
                     // infinity, because every time we assign infinity costs for
                     // edges of old paths, we anyway have the alternative edges
                     // with non-infinity costs.
-                    dfSumCost += mstEdges[itR->second].dfDirCost;
+                    const int iEdge = oIndex.FindEdge(itR->second);
+                    if (iEdge >= 0)
+                        dfSumCost += adfCosts[iEdge];
                 }
 
                 B.insert(std::make_pair(dfSumCost, aoRootPath));
@@ -424,6 +1031,14 @@ std::vector<GNMPATH> GNMGraph::KShortestPaths(GNMGFID nStartFID,
     return A;
 }
 
+static int GNMGetNumThreads()
+{
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    if (EQUAL(pszNumThreads, "ALL_CPUS"))
+        return CPLGetNumCPUs();
+    return std::max(1, atoi(pszNumThreads));
+}
+
 GNMPATH GNMGraph::ConnectedComponents(const GNMVECTOR &anEmittersIDs)
 {
     GNMPATH anConnectedIDs;
@@ -433,17 +1048,87 @@ GNMPATH GNMGraph::ConnectedComponents(const GNMVECTOR &anEmittersIDs)
         CPLError(CE_Failure, CPLE_IllegalArg, "Emitters list is empty.");
         return anConnectedIDs;
     }
-    std::set<GNMGFID> anMarkedVertIDs;
 
-    std::queue<GNMGFID> anStartQueue;
-    GNMVECTOR::const_iterator it;
-    for (it = anEmittersIDs.begin(); it != anEmittersIDs.end(); ++it)
+    const Index &oIndex = GetIndex();
+    std::vector<char> abMarked(oIndex.anVertexFIDs.size(), false);
+
+    std::vector<int> anQueue;
+    for (const GNMGFID nEmitterID : anEmittersIDs)
     {
-        anStartQueue.push(*it);
+        const int iVertex = oIndex.FindVertex(nEmitterID);
+        if (iVertex >= 0)
+            anQueue.push_back(iVertex);
     }
 
-    // Begin the iterations of the Breadth-first search.
-    TraceTargets(anStartQueue, anMarkedVertIDs, anConnectedIDs);
+    // Breadth-first search, one level at a time. The outcome edges of the
+    // vertices of large levels are gathered in parallel, and concatenated in
+    // the order of the vertices, so that the result does not depend on the
+    // number of threads.
+    constexpr size_t MIN_VERTICES_PER_JOB = 10000;
+    const int nThreads = GNMGetNumThreads();
+    std::vector<int> anLevel;
+    std::vector<int> anTargets;
+    while (!anQueue.empty())
+    {
+        // There may be duplicate unmarked vertices in a current queue. Check
+        // it.
+        anLevel.clear();
+        for (const int iVertex : anQueue)
+        {
+            if (!abMarked[iVertex])
+            {
+                abMarked[iVertex] = true;
+                anLevel.push_back(iVertex);
+            }
+        }
+
+        const size_t nJobs = std::min(static_cast<size_t>(nThreads),
+                                      anLevel.size() / MIN_VERTICES_PER_JOB);
+        CPLWorkerThreadPool *poThreadPool =
+            nJobs > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+        auto poQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+        anQueue.clear();
+        if (poQueue)
+        {
+            std::vector<Index::ExpandJob> asJobs(nJobs);
+            const size_t nChunkSize = (anLevel.size() + nJobs - 1) / nJobs;
+            for (size_t i = 0; i < nJobs; ++i)
+            {
+                const size_t nStart = i * nChunkSize;
+                asJobs[i].poIndex = &oIndex;
+                asJobs[i].panVertices = anLevel.data() + nStart;
+                asJobs[i].nCount =
+                    std::min(nChunkSize, anLevel.size() - nStart);
+                poQueue->SubmitJob(Index::ExpandJob::Run, &asJobs[i]);
+            }
+            poQueue->WaitCompletion();
+
+            for (auto &sJob : asJobs)
+            {
+                anConnectedIDs.insert(anConnectedIDs.end(),
+                                      sJob.aoConnected.begin(),
+                                      sJob.aoConnected.end());
+                for (const int iTarget : sJob.anTargets)
+                {
+                    // Avoid marked vertices.
+                    if (!abMarked[iTarget])
+                        anQueue.push_back(iTarget);
+                }
+            }
+        }
+        else
+        {
+            anTargets.clear();
+            oIndex.ExpandVertices(anLevel.data(), anLevel.size(),
+                                  anConnectedIDs, anTargets);
+            for (const int iTarget : anTargets)
+            {
+                // Avoid marked vertices.
+                if (!abMarked[iTarget])
+                    anQueue.push_back(iTarget);
+            }
+        }
+    }
 
     return anConnectedIDs;
 }
@@ -452,90 +1137,36 @@ void GNMGraph::Clear()
 {
     m_mstVertices.clear();
     m_mstEdges.clear();
+    m_moVertexCoordinates.clear();
+    InvalidateIndex();
 }
 
 void GNMGraph::DijkstraShortestPathTree(
     GNMGFID nFID, const std::map<GNMGFID, GNMStdEdge> &mstEdges,
     std::map<GNMGFID, GNMGFID> &mnPathTree)
 {
-    // Initialize all vertices in graph with infinity mark.
-    double dfInfinity = std::numeric_limits<double>::infinity();
-
-    std::map<GNMGFID, double> mMarks;
-    std::map<GNMGFID, GNMStdVertex>::iterator itv;
-    for (itv = m_mstVertices.begin(); itv != m_mstVertices.end(); ++itv)
-    {
-        mMarks[itv->first] = dfInfinity;
-    }
-
-    mMarks[nFID] = 0.0;
     mnPathTree[nFID] = -1;
 
-    // Initialize all vertices as unseen (there are no seen vertices).
-    std::set<GNMGFID> snSeen;
-
-    // We use multimap to maintain the ascending order of costs and because
-    // there can be different vertices with the equal cost.
-    std::multimap<double, GNMGFID> to_see;
-    std::multimap<double, GNMGFID>::iterator it;
-    to_see.insert(std::pair<double, GNMGFID>(0.0, nFID));
-    LPGNMCONSTVECTOR panOutcomeEdgeId;
+    const Index &oIndex = GetIndex();
+    const int iStart = oIndex.FindVertex(nFID);
+    if (iStart < 0)
+        return;
 
-    size_t i;
-    GNMGFID nCurrentVertId, nCurrentEdgeId, nTargetVertId;
-    double dfCurrentEdgeCost, dfCurrentVertMark, dfNewVertexMark;
-    std::map<GNMGFID, GNMStdEdge>::const_iterator ite;
+    std::vector<double> adfCosts;
+    std::vector<char> abEdgeBlocked;
+    oIndex.GetEdgeStates(mstEdges, adfCosts, abEdgeBlocked);
 
-    // Continue iterations while there are some vertices to see.
-    while (!to_see.empty())
+    std::vector<double> adfMarks;
+    std::vector<int> anPredEdges;
+    std::vector<int> anPredVertices;
+    oIndex.SearchPathTree(iStart, -1, adfCosts, abEdgeBlocked, false, adfMarks,
+                          anPredEdges, anPredVertices);
+    for (size_t i = 0; i < adfMarks.size(); ++i)
     {
-        // We must see vertices with minimal costs at first.
-        // In multimap the first cost is the minimal.
-        it = to_see.begin();
-
-        nCurrentVertId = it->second;
-        dfCurrentVertMark = it->first;
-        snSeen.insert(it->second);
-        to_see.erase(it);
-
-        // For all neighbours for the current vertex.
-        panOutcomeEdgeId = GetOutEdges(nCurrentVertId);
-        if (nullptr == panOutcomeEdgeId)
-            continue;
-
-        for (i = 0; i < panOutcomeEdgeId->size(); ++i)
+        if (anPredEdges[i] >= 0)
         {
-            nCurrentEdgeId = panOutcomeEdgeId->operator[](i);
-
-            ite = mstEdges.find(nCurrentEdgeId);
-            if (ite == mstEdges.end() || ite->second.bIsBlocked)
-                continue;
-
-            // We go in any edge from source to target so we take only
-            // direct cost (even if an edge is bi-directed).
-            dfCurrentEdgeCost = ite->second.dfDirCost;
-
-            // While we see outcome edges of current vertex id we definitely
-            // know that target vertex id will be target for current edge id.
-            nTargetVertId = GetOppositVertex(nCurrentEdgeId, nCurrentVertId);
-
-            // Calculate a new mark assuming the full path cost (mark of the
-            // current vertex) to this vertex.
-            dfNewVertexMark = dfCurrentVertMark + dfCurrentEdgeCost;
-
-            // Update mark of the vertex if needed.
-            if (snSeen.find(nTargetVertId) == snSeen.end() &&
-                dfNewVertexMark < mMarks[nTargetVertId] &&
-                !CheckVertexBlocked(nTargetVertId))
-            {
-                mMarks[nTargetVertId] = dfNewVertexMark;
-                mnPathTree[nTargetVertId] = nCurrentEdgeId;
-
-                // The vertex with minimal cost will be inserted to the
-                // beginning.
-                to_see.insert(
-                    std::pair<double, GNMGFID>(dfNewVertexMark, nTargetVertId));
-            }
+            mnPathTree[oIndex.anVertexFIDs[i]] =
+                oIndex.anEdgeFIDs[anPredEdges[i]];
         }
     }
 }
@@ -566,73 +1197,4 @@ GNMGFID GNMGraph::GetOppositVertex(GNMGFID nEdgeFID, GNMGFID nVertexFID) const
     }
     return -1;
 }
-
-void GNMGraph::TraceTargets(std::queue<GNMGFID> &vertexQueue,
-                            std::set<GNMGFID> &markedVertIds,
-                            GNMPATH &connectedIds)
-{
-    GNMCONSTVECTOR::const_iterator it;
-    std::queue<GNMGFID> neighbours_queue;
-
-    // See all given vertices except thouse that have been already seen.
-    while (!vertexQueue.empty())
-    {
-        GNMGFID nCurVertID = vertexQueue.front();
-
-        // There may be duplicate unmarked vertices in a current queue. Check
-        // it.
-        if (markedVertIds.find(nCurVertID) == markedVertIds.end())
-        {
-            markedVertIds.insert(nCurVertID);
-
-            // See all outcome edges, add them to connected and than see the
-            // target vertex of each edge. Add it to the queue, which will be
-            // recursively seen the same way on the next iteration.
-            LPGNMCONSTVECTOR panOutcomeEdgeIDs = GetOutEdges(nCurVertID);
-            if (nullptr != panOutcomeEdgeIDs)
-            {
-                for (it = panOutcomeEdgeIDs->begin();
-                     it != panOutcomeEdgeIDs->end(); ++it)
-                {
-                    GNMGFID nCurEdgeID = *it;
-
-                    // ISSUE: think about to return a sequence of vertices and
-                    // edges (which is more universal), as now we are going to
-                    // return only sequence of edges.
-                    connectedIds.push_back(
-                        std::make_pair(nCurVertID, nCurEdgeID));
-
-                    // Get the only target vertex of this edge. If edge is
-                    // bidirected get not that vertex that with nCurVertID.
-                    GNMGFID nTargetVertID;
-                    /*
-                    std::vector<GNMGFID> target_vert_ids =
-                    _getTgtVert(cur_edge_id); std::vector<GNMGFID>::iterator
-                    itt; for (itt = target_vert_ids.begin(); itt !=
-                    target_vert_ids.end(); ++itt)
-                    {
-                        if ((*itt) != cur_vert_id)
-                        {
-                            target_vert_id = *itt;
-                            break;
-                        }
-                    }
-                    */
-                    nTargetVertID = GetOppositVertex(nCurEdgeID, nCurVertID);
-
-                    // Avoid marked or blocked vertices.
-                    if ((markedVertIds.find(nTargetVertID) ==
-                         markedVertIds.end()) &&
-                        (!CheckVertexBlocked(nTargetVertID)))
-                        neighbours_queue.push(nTargetVertID);
-                }
-            }
-        }
-
-        vertexQueue.pop();
-    }
-
-    if (!neighbours_queue.empty())
-        TraceTargets(neighbours_queue, markedVertIds, connectedIds);
-}
 //! @endcond
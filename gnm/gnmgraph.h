@@ -35,8 +35,10 @@
 #include "cpl_port.h"
 #if defined(__cplusplus) && !defined(CPL_SUPRESS_CPLUSPLUS)
 #include <map>
+#include <memory>
 #include <queue>
 #include <set>
+#include <utility>
 #include <vector>
 #endif
 
@@ -83,6 +85,10 @@ struct GNMStdVertex
  * NOTE: GNMGraph holds the whole graph in memory, so it can consume
  * a lot of memory if operating huge networks.
  *
+ * Starting with GDAL 3.9, the analysis methods run on a compressed sparse row
+ * (CSR) index of the graph, made of contiguous arrays, which is built on the
+ * first analysis after the graph structure has been changed.
+ *
  * @since GDAL 2.1
  */
 
@@ -173,6 +179,58 @@ class CPL_DLL GNMGraph
      */
     virtual GNMPATH DijkstraShortestPath(GNMGFID nStartFID, GNMGFID nEndFID);
 
+    /**
+     * @brief Bidirectional variant of the Dijkstra shortest path algorithm.
+     *
+     * Searches simultaneously forward from nStartFID and backward from
+     * nEndFID, and stops as soon as both searches have met on the best path.
+     * This usually visits much fewer vertices than DijkstraShortestPath().
+     * If several paths have the same cost, the returned one may differ from
+     * the one returned by DijkstraShortestPath().
+     *
+     * @param nStartFID Start identificator
+     * @param nEndFID End identificator
+     * @return an array of best path included identificator of vertices and
+     * edges
+     * @since GDAL 3.9
+     */
+    virtual GNMPATH BidirectionalDijkstraShortestPath(GNMGFID nStartFID,
+                                                      GNMGFID nEndFID);
+
+    /**
+     * @brief An implementation of A* shortest path algorithm.
+     *
+     * The search is guided by the euclidean distance to nEndFID, scaled by
+     * the lowest cost per distance unit of the graph edges, so that the
+     * returned path is a best path. The vertex coordinates must have been set
+     * with SetVertexCoordinates(), otherwise the method behaves as
+     * DijkstraShortestPath().
+     *
+     * @param nStartFID Start identificator
+     * @param nEndFID End identificator
+     * @return an array of best path included identificator of vertices and
+     * edges
+     * @since GDAL 3.9
+     */
+    virtual GNMPATH AStarShortestPath(GNMGFID nStartFID, GNMGFID nEndFID);
+
+    /**
+     * @brief Set the coordinates of a vertex, used by AStarShortestPath().
+     * @param nFID Vertex identificator
+     * @param dfX X coordinate
+     * @param dfY Y coordinate
+     * @since GDAL 3.9
+     */
+    virtual void SetVertexCoordinates(GNMGFID nFID, double dfX, double dfY);
+
+    /**
+     * @brief Check if the coordinates of vertices have been set.
+     * @return true if SetVertexCoordinates() has been called since the last
+     * Clear().
+     * @since GDAL 3.9
+     */
+    virtual bool HasVertexCoordinates() const;
+
     /**
      * @brief An implementation of KShortest paths algorithm.
      *
@@ -200,12 +258,16 @@ class CPL_DLL GNMGraph
      * @brief Search connected components of the network
      *
      * Returns the resource distribution in the network. Method search starting
-     * from the features identificators from input array. Uses the recursive
+     * from the features identificators from input array. Uses the
      * Breadth-first search algorithm to find the connected to the given vector
      * of GFIDs components. Method takes in account the blocking state of
      * features, i.e. the blocked features are the barriers during the routing
      * process.
      *
+     * Starting with GDAL 3.9, the vertices of large levels of the search are
+     * expanded in parallel when the GDAL_NUM_THREADS configuration option is
+     * set to a value greater than 1 or ALL_CPUS.
+     *
      * @param anEmittersIDs - array of emitters identificators
      * @return an array of connected identificators
      */
@@ -243,13 +305,17 @@ class CPL_DLL GNMGraph
     virtual LPGNMCONSTVECTOR GetOutEdges(GNMGFID nFID) const;
     virtual GNMGFID GetOppositVertex(GNMGFID nEdgeFID,
                                      GNMGFID nVertexFID) const;
-    virtual void TraceTargets(std::queue<GNMGFID> &vertexQueue,
-                              std::set<GNMGFID> &markedVertIds,
-                              GNMPATH &connectedIds);
+    struct Index;
+    const Index &GetIndex();
+    void InvalidateIndex();
 
   protected:
     std::map<GNMGFID, GNMStdVertex> m_mstVertices;
     std::map<GNMGFID, GNMStdEdge> m_mstEdges;
+    std::map<GNMGFID, std::pair<double, double>> m_moVertexCoordinates;
+
+  private:
+    std::unique_ptr<Index> m_poIndex;
     //! @endcond
 };
 
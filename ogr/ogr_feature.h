@@ -1392,6 +1392,9 @@ class CPL_DLL OGRFeature
     OGRErr SetFieldsFrom(const OGRFeature *, const int *panMap,
                          int bForgiving = TRUE,
                          bool bUseISO8601ForDateTimeAsString = false);
+    OGRErr SetFromStealing(OGRFeature *, const int *panMap,
+                           int bForgiving = TRUE,
+                           bool bUseISO8601ForDateTimeAsString = false);
 
     //! @cond Doxygen_Suppress
     OGRErr RemapFields(OGRFeatureDefn *poNewDefn, const int *panRemapSource);
@@ -1843,6 +1846,7 @@ class OGRLayer;
 class swq_expr_node;
 class swq_custom_func_registrar;
 struct swq_evaluation_context;
+class OGRFeatureQueryProgram;
 
 class CPL_DLL OGRFeatureQuery
 {
@@ -1850,6 +1854,7 @@ class CPL_DLL OGRFeatureQuery
     OGRFeatureDefn *poTargetDefn;
     void *pSWQExpr;
     swq_evaluation_context *m_psContext = nullptr;
+    std::unique_ptr<OGRFeatureQueryProgram> m_poProgram{};
 
     char **FieldCollector(void *, char **);
 
@@ -1883,6 +1888,12 @@ class CPL_DLL OGRFeatureQuery
     {
         return pSWQExpr;
     }
+
+    // Null if the expression cannot be compiled as a program
+    const OGRFeatureQueryProgram *GetProgram() const
+    {
+        return m_poProgram.get();
+    }
 };
 //! @endcond
 
@@ -0,0 +1,137 @@
+/******************************************************************************
+ *
+ * Project:  OGR
+ * Purpose:  Flat representation of simple attribute filters
+ * Author:   Even Rouault <even dot rouault at spatialys.com>
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, Even Rouault <even dot rouault at spatialys.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef OGR_FEATUREQUERY_PROGRAM_H_INCLUDED
+#define OGR_FEATUREQUERY_PROGRAM_H_INCLUDED
+
+#include "cpl_port.h"
+#include "ogr_core.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+//! @cond Doxygen_Suppress
+
+class OGRFeature;
+class OGRFeatureDefn;
+class swq_expr_node;
+
+/************************************************************************/
+/*                        OGRFeatureQueryProgram                        */
+/************************************************************************/
+
+/** Flat form of the attribute filters that are made only of comparisons
+ * of a field with constants (=, <>, <, <=, >, >=, BETWEEN, IN, IS NULL),
+ * combined with AND, OR and NOT.
+ *
+ * It evaluates to the same result as swq_expr_node::Evaluate(), but without
+ * allocating intermediate values, and its comparisons can also be applied
+ * column-wise on arrays of values.
+ */
+class OGRFeatureQueryProgram
+{
+  public:
+    enum class Op
+    {
+        COMPARE,
+        AND,
+        OR,
+        NOT
+    };
+
+    enum class Comparison
+    {
+        EQ,
+        NE,
+        LT,
+        LE,
+        GT,
+        GE,
+        BETWEEN,
+        IN,
+        ISNULL
+    };
+
+    // Type in which field values and constants are compared, following
+    // the rules of SWQGeneralEvaluator().
+    enum class ValueType
+    {
+        INTEGER,
+        FLOAT,
+        STRING
+    };
+
+    // Instructions are in postfix order.
+    struct Instruction
+    {
+        Op eOp = Op::COMPARE;
+        // Number of operands popped by AND and OR
+        int nOperands = 0;
+
+        // For COMPARE
+        int iField = -1;  // -1 for the FID
+        OGRFieldType eFieldType = OFTInteger;
+        Comparison eComparison = Comparison::EQ;
+        ValueType eValueType = ValueType::INTEGER;
+        std::vector<GIntBig> anValues{};
+        std::vector<double> adfValues{};
+        std::vector<std::string> aosValues{};
+    };
+
+    static std::unique_ptr<OGRFeatureQueryProgram>
+    Compile(const swq_expr_node *poExpr, const OGRFeatureDefn *poDefn);
+
+    bool Evaluate(const OGRFeature *poFeature) const;
+
+    const std::vector<Instruction> &GetInstructions() const
+    {
+        return m_aoInstructions;
+    }
+
+    // Comparisons of a non-null field value, depending on eValueType.
+    static bool CompareInteger(const Instruction &sInstr, GIntBig nValue);
+    static bool CompareFloat(const Instruction &sInstr, double dfValue);
+    static bool CompareString(const Instruction &sInstr, const char *pszValue,
+                              size_t nLen);
+
+    // Maximum depth of the evaluation stack.
+    static constexpr int MAX_STACK_DEPTH = 64;
+
+  private:
+    std::vector<Instruction> m_aoInstructions{};
+
+    bool CompileNode(const swq_expr_node *poNode,
+                     const OGRFeatureDefn *poDefn);
+    bool CompileComparison(const swq_expr_node *poNode,
+                           const OGRFeatureDefn *poDefn);
+};
+
+//! @endcond
+
+#endif /* OGR_FEATUREQUERY_PROGRAM_H_INCLUDED */
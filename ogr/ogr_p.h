@@ -223,6 +223,11 @@ OGRErr CPL_DLL OGRReadWKBGeometryType(const unsigned char *pabyData,
                                       OGRwkbVariant wkbVariant,
                                       OGRwkbGeometryType *eGeometryType);
 
+void CPL_DLL OGRUpdateEnvelopeXY(OGREnvelope &sEnvelope, const void *pXY,
+                                 size_t nPoints, size_t nStride);
+
+void CPL_DLL OGRSwapDoubleArray(void *pData, size_t nCount);
+
 /************************************************************************/
 /*                        WKT Type Handling encoding                    */
 /************************************************************************/
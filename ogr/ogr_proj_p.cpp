@@ -338,6 +338,8 @@ void OSRProjTLSCache::clear()
 {
     m_oCacheEPSG.clear();
     m_oCacheWKT.clear();
+    m_oCacheUserInput.clear();
+    m_oCacheIsSame.clear();
     m_tlsContext = nullptr;
 }
 
@@ -382,6 +384,32 @@ void OSRProjTLSCache::CachePJForWKT(const std::string &wkt, PJ *pj)
     m_oCacheWKT.insert(wkt, UniquePtrPJ(proj_clone(GetPJContext(), pj)));
 }
 
+PJ *OSRProjTLSCache::GetPJForUserInput(const std::string &osInput)
+{
+    auto cached = m_oCacheUserInput.getPtr(osInput);
+    if (cached)
+    {
+        return proj_clone(GetPJContext(), cached->get());
+    }
+    return nullptr;
+}
+
+void OSRProjTLSCache::CachePJForUserInput(const std::string &osInput, PJ *pj)
+{
+    m_oCacheUserInput.insert(osInput,
+                             UniquePtrPJ(proj_clone(GetPJContext(), pj)));
+}
+
+bool OSRProjTLSCache::GetIsSameResult(const std::string &osKey, bool &bIsSame)
+{
+    return m_oCacheIsSame.tryGet(osKey, bIsSame);
+}
+
+void OSRProjTLSCache::CacheIsSameResult(const std::string &osKey, bool bIsSame)
+{
+    m_oCacheIsSame.insert(osKey, bIsSame);
+}
+
 /************************************************************************/
 /*                         OSRCleanupTLSContext()                       */
 /************************************************************************/
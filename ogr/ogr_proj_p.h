@@ -90,6 +90,8 @@ class OSRProjTLSCache
                                     EPSGCacheKeyHasher>>
         m_oCacheEPSG{};
     lru11::Cache<std::string, UniquePtrPJ> m_oCacheWKT{};
+    lru11::Cache<std::string, UniquePtrPJ> m_oCacheUserInput{};
+    lru11::Cache<std::string, bool> m_oCacheIsSame{};
 
     PJ_CONTEXT *GetPJContext();
 
@@ -109,6 +111,12 @@ class OSRProjTLSCache
 
     PJ *GetPJForWKT(const std::string &wkt);
     void CachePJForWKT(const std::string &wkt, PJ *pj);
+
+    PJ *GetPJForUserInput(const std::string &osInput);
+    void CachePJForUserInput(const std::string &osInput, PJ *pj);
+
+    bool GetIsSameResult(const std::string &osKey, bool &bIsSame);
+    void CacheIsSameResult(const std::string &osKey, bool bIsSame);
 };
 
 OSRProjTLSCache *OSRGetProjTLSCache();
@@ -304,6 +304,7 @@ const char CPL_UNSTABLE_API *SWQFieldTypeToString(swq_field_type field_type);
 #define SWQM_SUMMARY_RECORD 1
 #define SWQM_RECORDSET 2
 #define SWQM_DISTINCT_LIST 3
+#define SWQM_GROUP_BY 4
 
 typedef enum
 {
@@ -370,6 +371,14 @@ typedef struct
     int ascending_flag;
 } swq_order_def;
 
+typedef struct
+{
+    char *table_name;
+    char *field_name;
+    int table_index;
+    int field_index;
+} swq_group_by_def;
+
 typedef struct
 {
     int secondary_table;
@@ -440,6 +449,10 @@ class CPL_UNSTABLE_API swq_select
     int order_specs = 0;
     swq_order_def *order_defs = nullptr;
 
+    void PushGroupBy(const char *pszTableName, const char *pszFieldName);
+    int group_by_specs = 0;
+    swq_group_by_def *group_by_defs = nullptr;
+
     void SetLimit(GIntBig nLimit);
     GIntBig limit = -1;
 
@@ -474,6 +487,10 @@ const char CPL_UNSTABLE_API *swq_select_summarize(swq_select *select_info,
                                                   int dest_column,
                                                   const char *value);
 
+const char CPL_UNSTABLE_API *swq_summary_accumulate(const swq_col_def *def,
+                                                    swq_summary &summary,
+                                                    const char *value);
+
 int CPL_UNSTABLE_API swq_is_reserved_keyword(const char *pszStr);
 
 char CPL_UNSTABLE_API *OGRHStoreGetValue(const char *pszHStore,
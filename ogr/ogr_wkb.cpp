@@ -31,11 +31,15 @@
 #include "ogr_core.h"
 #include "ogr_geometry.h"
 #include "ogr_p.h"
+#include "ogr_spatialref.h"
 
 #include <algorithm>
 #include <cmath>
 #include <climits>
+#include <cstring>
 #include <limits>
+#include <new>
+#include <vector>
 
 #include <algorithm>
 #include <limits>
@@ -312,6 +316,13 @@ static bool ReadWKBPointSequence(const uint8_t *data, size_t size,
         OGRWKBReadUInt32AtOffset(data, eByteOrder, iOffset);
     if (nPoints > (size - iOffset) / (nDim * sizeof(double)))
         return false;
+    if (!OGR_SWAP(eByteOrder))
+    {
+        OGRUpdateEnvelopeXY(sEnvelope, data + iOffset, nPoints,
+                            nDim * sizeof(double));
+        iOffset += static_cast<size_t>(nPoints) * nDim * sizeof(double);
+        return true;
+    }
     double dfX = 0;
     double dfY = 0;
     for (uint32_t j = 0; j < nPoints; j++)
@@ -319,11 +330,8 @@ static bool ReadWKBPointSequence(const uint8_t *data, size_t size,
         memcpy(&dfX, data + iOffset, sizeof(double));
         memcpy(&dfY, data + iOffset + sizeof(double), sizeof(double));
         iOffset += nDim * sizeof(double);
-        if (OGR_SWAP(eByteOrder))
-        {
-            CPL_SWAP64PTR(&dfX);
-            CPL_SWAP64PTR(&dfY);
-        }
+        CPL_SWAP64PTR(&dfX);
+        CPL_SWAP64PTR(&dfY);
         sEnvelope.MinX = std::min(sEnvelope.MinX, dfX);
         sEnvelope.MinY = std::min(sEnvelope.MinY, dfY);
         sEnvelope.MaxX = std::max(sEnvelope.MaxX, dfX);
@@ -1025,6 +1033,825 @@ void OGRWKBFixupCounterClockWiseExternalRing(GByte *pabyWkb, size_t nWKBSize)
         pabyWkb, nWKBSize, iOffsetInOut, /* nRec = */ 0);
 }
 
+/************************************************************************/
+/*                        OGRWKBPointSequence                           */
+/************************************************************************/
+
+namespace
+{
+/** Sequence of coordinate tuples, as stored in a WKB blob */
+struct OGRWKBPointSequence
+{
+    const GByte *pabyData = nullptr;
+    uint32_t nPoints = 0;
+    int nDim = 2;
+    bool bHasZ = false;
+    bool bNeedSwap = false;
+
+    inline double GetX(uint32_t i) const
+    {
+        return OGRWKBReadFloat64(
+            pabyData + static_cast<size_t>(i) * nDim * sizeof(double),
+            bNeedSwap);
+    }
+
+    inline double GetY(uint32_t i) const
+    {
+        return OGRWKBReadFloat64(
+            pabyData + (static_cast<size_t>(i) * nDim + 1) * sizeof(double),
+            bNeedSwap);
+    }
+};
+
+/** Base of the visitors of OGRWKBVisitLinearGeometry() */
+struct OGRWKBLinearGeometryVisitor
+{
+    /** Set to true by visitors to stop the visit early */
+    bool bStop = false;
+
+    void Point(const OGRWKBPointSequence &)
+    {
+    }
+
+    void LineString(const OGRWKBPointSequence &)
+    {
+    }
+
+    void PolygonBegin()
+    {
+    }
+
+    void Ring(const OGRWKBPointSequence &, uint32_t /* iRing */)
+    {
+    }
+
+    void PolygonEnd()
+    {
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*                      OGRWKBReadPointSequence()                       */
+/************************************************************************/
+
+static bool OGRWKBReadPointSequence(const GByte *data, size_t size,
+                                    size_t &iOffset, OGRWKBPointSequence &oSeq)
+{
+    if (size - iOffset < sizeof(uint32_t))
+        return false;
+    oSeq.nPoints = OGRWKBReadUInt32(data + iOffset, oSeq.bNeedSwap);
+    iOffset += sizeof(uint32_t);
+    const size_t nTupleSize = oSeq.nDim * sizeof(double);
+    if (oSeq.nPoints > (size - iOffset) / nTupleSize)
+        return false;
+    oSeq.pabyData = data + iOffset;
+    iOffset += oSeq.nPoints * nTupleSize;
+    return true;
+}
+
+/************************************************************************/
+/*                      OGRWKBVisitLinearGeometry()                     */
+/************************************************************************/
+
+/* Walk through a geometry made of (Multi)Point, (Multi)LineString,
+ * (Multi)Polygon and GeometryCollection, and call the methods of oVisitor
+ * on its point sequences.
+ * Returns false if the WKB is corrupted or contains a curve geometry.
+ */
+template <class Visitor>
+static bool OGRWKBVisitLinearGeometry(const GByte *data, size_t size,
+                                      size_t &iOffset, Visitor &oVisitor,
+                                      int nRec)
+{
+    if (size - iOffset < MIN_WKB_SIZE)
+        return false;
+    const int nByteOrder = DB2_V72_FIX_BYTE_ORDER(data[iOffset]);
+    if (!(nByteOrder == wkbXDR || nByteOrder == wkbNDR))
+        return false;
+    OGRwkbGeometryType eGeometryType = wkbUnknown;
+    if (OGRReadWKBGeometryType(data + iOffset, wkbVariantIso,
+                               &eGeometryType) != OGRERR_NONE)
+        return false;
+    iOffset += WKB_PREFIX_SIZE;
+
+    OGRWKBPointSequence oSeq;
+    oSeq.bNeedSwap = OGR_SWAP(static_cast<OGRwkbByteOrder>(nByteOrder));
+    oSeq.bHasZ = CPL_TO_BOOL(OGR_GT_HasZ(eGeometryType));
+    oSeq.nDim = 2 + (oSeq.bHasZ ? 1 : 0) +
+                (OGR_GT_HasM(eGeometryType) ? 1 : 0);
+
+    switch (wkbFlatten(eGeometryType))
+    {
+        case wkbPoint:
+        {
+            const size_t nTupleSize = oSeq.nDim * sizeof(double);
+            if (size - iOffset < nTupleSize)
+                return false;
+            oSeq.pabyData = data + iOffset;
+            iOffset += nTupleSize;
+            // POINT EMPTY is encoded with NaN coordinates
+            oSeq.nPoints =
+                std::isnan(oSeq.GetX(0)) && std::isnan(oSeq.GetY(0)) ? 0 : 1;
+            oVisitor.Point(oSeq);
+            return true;
+        }
+
+        case wkbLineString:
+        {
+            if (!OGRWKBReadPointSequence(data, size, iOffset, oSeq))
+                return false;
+            oVisitor.LineString(oSeq);
+            return true;
+        }
+
+        case wkbPolygon:
+        {
+            if (size - iOffset < sizeof(uint32_t))
+                return false;
+            const uint32_t nRings =
+                OGRWKBReadUInt32(data + iOffset, oSeq.bNeedSwap);
+            iOffset += sizeof(uint32_t);
+            if (nRings > (size - iOffset) / sizeof(uint32_t))
+                return false;
+            oVisitor.PolygonBegin();
+            for (uint32_t i = 0; i < nRings; ++i)
+            {
+                if (!OGRWKBReadPointSequence(data, size, iOffset, oSeq))
+                    return false;
+                oVisitor.Ring(oSeq, i);
+                if (oVisitor.bStop)
+                    return true;
+            }
+            oVisitor.PolygonEnd();
+            return true;
+        }
+
+        case wkbMultiPoint:
+        case wkbMultiLineString:
+        case wkbMultiPolygon:
+        case wkbGeometryCollection:
+        {
+            if (nRec == 128)
+                return false;
+            const uint32_t nParts =
+                OGRWKBReadUInt32(data + iOffset, oSeq.bNeedSwap);
+            iOffset += sizeof(uint32_t);
+            if (nParts > (size - iOffset) / MIN_WKB_SIZE)
+                return false;
+            for (uint32_t i = 0; i < nParts; ++i)
+            {
+                if (!OGRWKBVisitLinearGeometry(data, size, iOffset, oVisitor,
+                                               nRec + 1))
+                    return false;
+                if (oVisitor.bStop)
+                    return true;
+            }
+            return true;
+        }
+
+        default:
+            break;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                  OGRWKBSegmentIntersectsEnvelope()                   */
+/************************************************************************/
+
+static inline bool OGRWKBSegmentIntersectsEnvelope(double x0, double y0,
+                                                   double x1, double y1,
+                                                   const OGREnvelope &sEnv)
+{
+    if (std::max(x0, x1) < sEnv.MinX || std::min(x0, x1) > sEnv.MaxX ||
+        std::max(y0, y1) < sEnv.MinY || std::min(y0, y1) > sEnv.MaxY)
+    {
+        return false;
+    }
+    // The bounding boxes intersect: the segment intersects the envelope
+    // unless the 4 corners of the envelope are strictly on the same side of
+    // the line supporting the segment (separating axis theorem).
+    const double dx = x1 - x0;
+    const double dy = y1 - y0;
+    const double s1 = dx * (sEnv.MinY - y0) - dy * (sEnv.MinX - x0);
+    const double s2 = dx * (sEnv.MaxY - y0) - dy * (sEnv.MinX - x0);
+    const double s3 = dx * (sEnv.MinY - y0) - dy * (sEnv.MaxX - x0);
+    const double s4 = dx * (sEnv.MaxY - y0) - dy * (sEnv.MaxX - x0);
+    return !((s1 > 0 && s2 > 0 && s3 > 0 && s4 > 0) ||
+             (s1 < 0 && s2 < 0 && s3 < 0 && s4 < 0));
+}
+
+/************************************************************************/
+/*                      OGRWKBIsPointInRing()                           */
+/************************************************************************/
+
+// Crossing number test. Cf OGRLinearRing::isPointInRing()
+static bool OGRWKBIsPointInRing(const OGRWKBPointSequence &oSeq, double dfX,
+                                double dfY)
+{
+    if (oSeq.nPoints < 4)
+        return false;
+    int nCrossings = 0;
+    double prev_diff_x = oSeq.GetX(0) - dfX;
+    double prev_diff_y = oSeq.GetY(0) - dfY;
+    for (uint32_t i = 1; i < oSeq.nPoints; ++i)
+    {
+        const double x1 = oSeq.GetX(i) - dfX;
+        const double y1 = oSeq.GetY(i) - dfY;
+        const double x2 = prev_diff_x;
+        const double y2 = prev_diff_y;
+        if (((y1 > 0) && (y2 <= 0)) || ((y2 > 0) && (y1 <= 0)))
+        {
+            const double dfIntersection = (x1 * y2 - x2 * y1) / (y2 - y1);
+            if (0.0 < dfIntersection)
+                nCrossings++;
+        }
+        prev_diff_x = x1;
+        prev_diff_y = y1;
+    }
+    return (nCrossings % 2) != 0;
+}
+
+/************************************************************************/
+/*                    OGRWKBIntersectsEnvelope()                        */
+/************************************************************************/
+
+namespace
+{
+struct OGRWKBIntersectsEnvelopeVisitor : public OGRWKBLinearGeometryVisitor
+{
+    const OGREnvelope &m_sEnv;
+    bool m_bIntersects = false;
+    bool m_bInExteriorRing = false;
+    bool m_bInInteriorRing = false;
+
+    explicit OGRWKBIntersectsEnvelopeVisitor(const OGREnvelope &sEnv)
+        : m_sEnv(sEnv)
+    {
+    }
+
+    void Found()
+    {
+        m_bIntersects = true;
+        bStop = true;
+    }
+
+    bool SegmentsIntersect(const OGRWKBPointSequence &oSeq)
+    {
+        double x0 = oSeq.GetX(0);
+        double y0 = oSeq.GetY(0);
+        if (oSeq.nPoints == 1)
+            return OGRWKBSegmentIntersectsEnvelope(x0, y0, x0, y0, m_sEnv);
+        for (uint32_t i = 1; i < oSeq.nPoints; ++i)
+        {
+            const double x1 = oSeq.GetX(i);
+            const double y1 = oSeq.GetY(i);
+            if (OGRWKBSegmentIntersectsEnvelope(x0, y0, x1, y1, m_sEnv))
+                return true;
+            x0 = x1;
+            y0 = y1;
+        }
+        return false;
+    }
+
+    void Point(const OGRWKBPointSequence &oSeq)
+    {
+        if (oSeq.nPoints && SegmentsIntersect(oSeq))
+            Found();
+    }
+
+    void LineString(const OGRWKBPointSequence &oSeq)
+    {
+        if (oSeq.nPoints && SegmentsIntersect(oSeq))
+            Found();
+    }
+
+    void PolygonBegin()
+    {
+        m_bInExteriorRing = false;
+        m_bInInteriorRing = false;
+    }
+
+    void Ring(const OGRWKBPointSequence &oSeq, uint32_t iRing)
+    {
+        if (oSeq.nPoints == 0)
+            return;
+        if (SegmentsIntersect(oSeq))
+        {
+            Found();
+            return;
+        }
+        // No ring crosses the envelope, so the envelope is either fully
+        // inside or outside each ring: testing one corner is enough.
+        if (OGRWKBIsPointInRing(oSeq, m_sEnv.MinX, m_sEnv.MinY))
+        {
+            if (iRing == 0)
+                m_bInExteriorRing = true;
+            else
+                m_bInInteriorRing = true;
+        }
+    }
+
+    void PolygonEnd()
+    {
+        if (m_bInExteriorRing && !m_bInInteriorRing)
+            Found();
+    }
+};
+}  // namespace
+
+/** Returns whether the geometry (pabyWkb, nWKBSize) intersects the
+ * passed envelope, in the sense of OGRGeometry::Intersects().
+ *
+ * Only (Multi)Point, (Multi)LineString, (Multi)Polygon and
+ * GeometryCollection of them are handled. The function returns false if the
+ * WKB is corrupted or contains curve geometries, in which case bIntersects
+ * is not meaningful.
+ */
+bool OGRWKBIntersectsEnvelope(const GByte *pabyWkb, size_t nWKBSize,
+                              const OGREnvelope &sEnvelope, bool &bIntersects)
+{
+    OGRWKBIntersectsEnvelopeVisitor oVisitor(sEnvelope);
+    size_t iOffset = 0;
+    if (!OGRWKBVisitLinearGeometry(pabyWkb, nWKBSize, iOffset, oVisitor, 0))
+        return false;
+    bIntersects = oVisitor.m_bIntersects;
+    return true;
+}
+
+/************************************************************************/
+/*                        OGRWKBGetLength()                             */
+/************************************************************************/
+
+namespace
+{
+struct OGRWKBLengthVisitor : public OGRWKBLinearGeometryVisitor
+{
+    double m_dfLength = 0;
+
+    void LineString(const OGRWKBPointSequence &oSeq)
+    {
+        if (oSeq.nPoints == 0)
+            return;
+        double x0 = oSeq.GetX(0);
+        double y0 = oSeq.GetY(0);
+        for (uint32_t i = 1; i < oSeq.nPoints; ++i)
+        {
+            const double x1 = oSeq.GetX(i);
+            const double y1 = oSeq.GetY(i);
+            m_dfLength += sqrt((x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0));
+            x0 = x1;
+            y0 = y1;
+        }
+    }
+};
+}  // namespace
+
+/** Computes the 2D length of the linear parts of the geometry
+ * (pabyWkb, nWKBSize), in the sense of OGR_G_Length(): points and polygons
+ * have a zero length.
+ *
+ * Returns false if the WKB is corrupted or contains curve geometries.
+ */
+bool OGRWKBGetLength(const GByte *pabyWkb, size_t nWKBSize, double &dfLength)
+{
+    OGRWKBLengthVisitor oVisitor;
+    size_t iOffset = 0;
+    if (!OGRWKBVisitLinearGeometry(pabyWkb, nWKBSize, iOffset, oVisitor, 0))
+        return false;
+    dfLength = oVisitor.m_dfLength;
+    return true;
+}
+
+/************************************************************************/
+/*                           OGRWKBGetArea()                            */
+/************************************************************************/
+
+namespace
+{
+struct OGRWKBAreaVisitor : public OGRWKBLinearGeometryVisitor
+{
+    double m_dfArea = 0;
+
+    void Ring(const OGRWKBPointSequence &oSeq, uint32_t iRing)
+    {
+        if (oSeq.nPoints < 2)
+            return;
+        // Computation according to Green's Theorem
+        // Cf OGRSimpleCurve::get_LinearArea()
+        double x_m1 = oSeq.GetX(0);
+        double y_m1 = oSeq.GetY(0);
+        double y_m2 = y_m1;
+        double dfSum = 0;
+        for (uint32_t i = 1; i < oSeq.nPoints; ++i)
+        {
+            const double x = oSeq.GetX(i);
+            const double y = oSeq.GetY(i);
+            dfSum += x_m1 * (y - y_m2);
+            y_m2 = y_m1;
+            x_m1 = x;
+            y_m1 = y;
+        }
+        dfSum += x_m1 * (y_m1 - y_m2);
+        const double dfRingArea = 0.5 * std::fabs(dfSum);
+        if (iRing == 0)
+            m_dfArea += dfRingArea;
+        else
+            m_dfArea -= dfRingArea;
+    }
+};
+}  // namespace
+
+/** Computes the area of the geometry (pabyWkb, nWKBSize), in the sense of
+ * OGR_G_Area(): points and lines have a zero area.
+ *
+ * Returns false if the WKB is corrupted or contains curve geometries.
+ */
+bool OGRWKBGetArea(const GByte *pabyWkb, size_t nWKBSize, double &dfArea)
+{
+    OGRWKBAreaVisitor oVisitor;
+    size_t iOffset = 0;
+    if (!OGRWKBVisitLinearGeometry(pabyWkb, nWKBSize, iOffset, oVisitor, 0))
+        return false;
+    dfArea = oVisitor.m_dfArea;
+    return true;
+}
+
+/************************************************************************/
+/*                          OGRWKBGetCentroid()                         */
+/************************************************************************/
+
+namespace
+{
+// Follows the algorithm of GEOS' geos::algorithm::Centroid, so that results
+// are consistent with OGRGeometry::Centroid()
+struct OGRWKBCentroidVisitor : public OGRWKBLinearGeometryVisitor
+{
+    double m_dfAreaBaseX = 0;
+    double m_dfAreaBaseY = 0;
+    bool m_bAreaBaseSet = false;
+    double m_dfAreaSum2 = 0;
+    double m_dfCG3X = 0;
+    double m_dfCG3Y = 0;
+    double m_dfTotalLength = 0;
+    double m_dfLineCentSumX = 0;
+    double m_dfLineCentSumY = 0;
+    size_t m_nPtCount = 0;
+    double m_dfPtCentSumX = 0;
+    double m_dfPtCentSumY = 0;
+
+    void AddPoint(double dfX, double dfY)
+    {
+        m_nPtCount++;
+        m_dfPtCentSumX += dfX;
+        m_dfPtCentSumY += dfY;
+    }
+
+    void AddLineSegments(const OGRWKBPointSequence &oSeq)
+    {
+        double dfLineLen = 0;
+        for (uint32_t i = 0; i + 1 < oSeq.nPoints; ++i)
+        {
+            const double x0 = oSeq.GetX(i);
+            const double y0 = oSeq.GetY(i);
+            const double x1 = oSeq.GetX(i + 1);
+            const double y1 = oSeq.GetY(i + 1);
+            const double dfSegLen =
+                sqrt((x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0));
+            if (dfSegLen == 0)
+                continue;
+            dfLineLen += dfSegLen;
+            m_dfLineCentSumX += dfSegLen * (x0 + x1) / 2;
+            m_dfLineCentSumY += dfSegLen * (y0 + y1) / 2;
+        }
+        m_dfTotalLength += dfLineLen;
+        if (dfLineLen == 0 && oSeq.nPoints > 0)
+            AddPoint(oSeq.GetX(0), oSeq.GetY(0));
+    }
+
+    void Point(const OGRWKBPointSequence &oSeq)
+    {
+        if (oSeq.nPoints)
+            AddPoint(oSeq.GetX(0), oSeq.GetY(0));
+    }
+
+    void LineString(const OGRWKBPointSequence &oSeq)
+    {
+        AddLineSegments(oSeq);
+    }
+
+    void Ring(const OGRWKBPointSequence &oSeq, uint32_t iRing)
+    {
+        if (oSeq.nPoints == 0)
+            return;
+        if (!m_bAreaBaseSet)
+        {
+            m_dfAreaBaseX = oSeq.GetX(0);
+            m_dfAreaBaseY = oSeq.GetY(0);
+            m_bAreaBaseSet = true;
+        }
+        // Exterior rings are counted positively when clockwise, and
+        // interior rings when counter-clockwise.
+        const bool bIsCCW = IsCCW(oSeq);
+        const double dfSign = (iRing == 0) != bIsCCW ? 1.0 : -1.0;
+        const double x0 = m_dfAreaBaseX;
+        const double y0 = m_dfAreaBaseY;
+        for (uint32_t i = 0; i + 1 < oSeq.nPoints; ++i)
+        {
+            const double x1 = oSeq.GetX(i);
+            const double y1 = oSeq.GetY(i);
+            const double x2 = oSeq.GetX(i + 1);
+            const double y2 = oSeq.GetY(i + 1);
+            const double dfArea2 =
+                (x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0);
+            m_dfCG3X += dfSign * dfArea2 * (x0 + x1 + x2);
+            m_dfCG3Y += dfSign * dfArea2 * (y0 + y1 + y2);
+            m_dfAreaSum2 += dfSign * dfArea2;
+        }
+        AddLineSegments(oSeq);
+    }
+
+    static bool IsCCW(const OGRWKBPointSequence &oSeq)
+    {
+        // Shoelace formula
+        double dfSum = 0;
+        for (uint32_t i = 0; i + 1 < oSeq.nPoints; ++i)
+        {
+            dfSum += oSeq.GetX(i) * oSeq.GetY(i + 1) -
+                     oSeq.GetX(i + 1) * oSeq.GetY(i);
+        }
+        return dfSum > 0;
+    }
+
+    bool GetCentroid(double &dfX, double &dfY) const
+    {
+        if (m_dfAreaSum2 != 0)
+        {
+            dfX = m_dfCG3X / 3 / m_dfAreaSum2;
+            dfY = m_dfCG3Y / 3 / m_dfAreaSum2;
+        }
+        else if (m_dfTotalLength != 0)
+        {
+            dfX = m_dfLineCentSumX / m_dfTotalLength;
+            dfY = m_dfLineCentSumY / m_dfTotalLength;
+        }
+        else if (m_nPtCount != 0)
+        {
+            dfX = m_dfPtCentSumX / static_cast<double>(m_nPtCount);
+            dfY = m_dfPtCentSumY / static_cast<double>(m_nPtCount);
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+};
+}  // namespace
+
+/** Computes the centroid of the geometry (pabyWkb, nWKBSize), in the sense
+ * of OGRGeometry::Centroid(), without requiring GEOS.
+ *
+ * Returns false if the WKB is corrupted, contains curve geometries, or
+ * is empty.
+ */
+bool OGRWKBGetCentroid(const GByte *pabyWkb, size_t nWKBSize, double &dfX,
+                       double &dfY)
+{
+    OGRWKBCentroidVisitor oVisitor;
+    size_t iOffset = 0;
+    if (!OGRWKBVisitLinearGeometry(pabyWkb, nWKBSize, iOffset, oVisitor, 0))
+        return false;
+    return oVisitor.GetCentroid(dfX, dfY);
+}
+
+/************************************************************************/
+/*                        OGRWKBTransformBatch()                        */
+/************************************************************************/
+
+namespace
+{
+struct OGRWKBGatherVisitor : public OGRWKBLinearGeometryVisitor
+{
+    std::vector<OGRWKBPointSequence> &m_aoSeqs;
+    std::vector<double> &m_adfX;
+    std::vector<double> &m_adfY;
+    std::vector<double> &m_adfZ;
+    bool m_bHasZ = false;
+
+    OGRWKBGatherVisitor(std::vector<OGRWKBPointSequence> &aoSeqs,
+                        std::vector<double> &adfX, std::vector<double> &adfY,
+                        std::vector<double> &adfZ)
+        : m_aoSeqs(aoSeqs), m_adfX(adfX), m_adfY(adfY), m_adfZ(adfZ)
+    {
+    }
+
+    void Gather(const OGRWKBPointSequence &oSeq)
+    {
+        if (oSeq.nPoints == 0)
+            return;
+        m_aoSeqs.push_back(oSeq);
+        if (oSeq.bHasZ)
+            m_bHasZ = true;
+        for (uint32_t i = 0; i < oSeq.nPoints; ++i)
+        {
+            m_adfX.push_back(oSeq.GetX(i));
+            m_adfY.push_back(oSeq.GetY(i));
+            m_adfZ.push_back(
+                oSeq.bHasZ
+                    ? OGRWKBReadFloat64(
+                          oSeq.pabyData + (static_cast<size_t>(i) * oSeq.nDim +
+                                           2) * sizeof(double),
+                          oSeq.bNeedSwap)
+                    : 0.0);
+        }
+    }
+
+    void Point(const OGRWKBPointSequence &oSeq)
+    {
+        Gather(oSeq);
+    }
+
+    void LineString(const OGRWKBPointSequence &oSeq)
+    {
+        Gather(oSeq);
+    }
+
+    void Ring(const OGRWKBPointSequence &oSeq, uint32_t /* iRing */)
+    {
+        Gather(oSeq);
+    }
+};
+}  // namespace
+
+/** Transforms in place the coordinates of nCount WKB geometries with poCT.
+ *
+ * The coordinates of all geometries are gathered into a single array, so
+ * that OGRCoordinateTransformation::Transform() is called once for the whole
+ * batch, which amortizes its per-call overhead when transforming many small
+ * geometries. Contrary to OGRGeometry::transform(), geometries are not
+ * materialized.
+ *
+ * papabyWkb[i] may be NULL (with panWKBSize[i] == 0) for null geometries,
+ * which are ignored.
+ *
+ * If pabSuccess is not NULL, pabSuccess[i] is set to TRUE if the i-th
+ * geometry has been successfully transformed, or FALSE if it is corrupted,
+ * contains curve geometries or the transformation of one of its points
+ * failed. Such geometries are left unmodified.
+ *
+ * Returns false in case of memory allocation failure, or if pabSuccess is
+ * NULL and one of the geometries could not be transformed.
+ */
+bool OGRWKBTransformBatch(GByte *const *papabyWkb, const size_t *panWKBSize,
+                          size_t nCount, OGRCoordinateTransformation *poCT,
+                          int *pabSuccess)
+{
+    std::vector<OGRWKBPointSequence> aoSeqs;
+    // Index in aoSeqs of the first sequence of each geometry
+    std::vector<size_t> anFirstSeq;
+    std::vector<bool> abValid;
+    std::vector<double> adfX;
+    std::vector<double> adfY;
+    std::vector<double> adfZ;
+    bool bHasZ = false;
+    try
+    {
+        anFirstSeq.resize(nCount + 1);
+        abValid.resize(nCount);
+        OGRWKBGatherVisitor oVisitor(aoSeqs, adfX, adfY, adfZ);
+        for (size_t i = 0; i < nCount; ++i)
+        {
+            anFirstSeq[i] = aoSeqs.size();
+            if (papabyWkb[i] == nullptr)
+                continue;
+            const size_t nPointsBefore = adfX.size();
+            size_t iOffset = 0;
+            if (OGRWKBVisitLinearGeometry(papabyWkb[i], panWKBSize[i], iOffset,
+                                          oVisitor, 0))
+            {
+                abValid[i] = true;
+            }
+            else
+            {
+                aoSeqs.resize(anFirstSeq[i]);
+                adfX.resize(nPointsBefore);
+                adfY.resize(nPointsBefore);
+                adfZ.resize(nPointsBefore);
+            }
+        }
+        anFirstSeq[nCount] = aoSeqs.size();
+        bHasZ = oVisitor.m_bHasZ;
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in OGRWKBTransformBatch()");
+        return false;
+    }
+
+    std::vector<int> abPointSuccess;
+    try
+    {
+        abPointSuccess.resize(adfX.size());
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in OGRWKBTransformBatch()");
+        return false;
+    }
+
+    // Transform() takes an int count, so only split the batch when it is
+    // really huge.
+    constexpr size_t MAX_POINTS_PER_CALL = std::numeric_limits<int>::max();
+    for (size_t iStart = 0; iStart < adfX.size();
+         iStart += MAX_POINTS_PER_CALL)
+    {
+        const int nPoints = static_cast<int>(
+            std::min(adfX.size() - iStart, MAX_POINTS_PER_CALL));
+        // Per-point success is checked below
+        CPL_IGNORE_RET_VAL(poCT->Transform(
+            nPoints, adfX.data() + iStart, adfY.data() + iStart,
+            bHasZ ? adfZ.data() + iStart : nullptr, nullptr,
+            abPointSuccess.data() + iStart));
+    }
+
+    bool bRet = true;
+    size_t iPoint = 0;
+    for (size_t i = 0; i < nCount; ++i)
+    {
+        const size_t iFirstPoint = iPoint;
+        bool bOK = abValid[i];
+        for (size_t iSeq = anFirstSeq[i]; iSeq < anFirstSeq[i + 1]; ++iSeq)
+        {
+            for (uint32_t j = 0; j < aoSeqs[iSeq].nPoints; ++j, ++iPoint)
+            {
+                if (!abPointSuccess[iPoint])
+                    bOK = false;
+            }
+        }
+        if (bOK)
+        {
+            iPoint = iFirstPoint;
+            for (size_t iSeq = anFirstSeq[i]; iSeq < anFirstSeq[i + 1]; ++iSeq)
+            {
+                const auto &oSeq = aoSeqs[iSeq];
+                // The sequence points into papabyWkb[i], which is not const.
+                GByte *pabyData =
+                    papabyWkb[i] + (oSeq.pabyData -
+                                    static_cast<const GByte *>(papabyWkb[i]));
+                const int nValues = oSeq.bHasZ ? 3 : 2;
+                for (uint32_t j = 0; j < oSeq.nPoints; ++j, ++iPoint)
+                {
+                    const double adfVal[] = {adfX[iPoint], adfY[iPoint],
+                                             adfZ[iPoint]};
+                    for (int k = 0; k < nValues; ++k)
+                    {
+                        GByte *pabyVal =
+                            pabyData +
+                            (static_cast<size_t>(j) * oSeq.nDim + k) *
+                                sizeof(double);
+                        memcpy(pabyVal, &adfVal[k], sizeof(double));
+                        if (oSeq.bNeedSwap)
+                            CPL_SWAP64PTR(pabyVal);
+                    }
+                }
+            }
+        }
+        else if (papabyWkb[i] != nullptr)
+        {
+            bRet = false;
+        }
+        if (pabSuccess)
+            pabSuccess[i] = bOK || papabyWkb[i] == nullptr;
+    }
+
+    return bRet || pabSuccess != nullptr;
+}
+
+/************************************************************************/
+/*                          OGRWKBTransform()                           */
+/************************************************************************/
+
+/** Transforms in place the coordinates of the geometry (pabyWkb, nWKBSize)
+ * with poCT.
+ *
+ * Contrary to OGRGeometry::transform(), the geometry is not materialized.
+ *
+ * Returns false if the WKB is corrupted, contains curve geometries, or if
+ * the transformation of one of its points failed, in which case the WKB is
+ * left unmodified.
+ *
+ * @see OGRWKBTransformBatch()
+ */
+bool OGRWKBTransform(GByte *pabyWkb, size_t nWKBSize,
+                     OGRCoordinateTransformation *poCT)
+{
+    return OGRWKBTransformBatch(&pabyWkb, &nWKBSize, 1, poCT, nullptr);
+}
+
 /************************************************************************/
 /*                         OGRAppendBuffer()                            */
 /************************************************************************/
@@ -1272,3 +2099,400 @@ size_t OGRWKTToWKBTranslator::TranslateWKT(void *pabyWKTStart, size_t nLength,
     delete poGeometry;
     return nWKBSize;
 }
+
+/************************************************************************/
+/*                    OGRWKBPolygonColumnarBuffer()                     */
+/************************************************************************/
+
+/** Constructor.
+ *
+ * @param bHasZ whether coordinates are stored with a Z component.
+ * @param bFloat32 whether coordinates are stored as float32 values instead
+ *                 of float64 ones.
+ */
+OGRWKBPolygonColumnarBuffer::OGRWKBPolygonColumnarBuffer(bool bHasZ,
+                                                         bool bFloat32)
+    : m_nDim(bHasZ ? 3 : 2), m_bFloat32(bFloat32)
+{
+}
+
+/************************************************************************/
+/*                               Clear()                                */
+/************************************************************************/
+
+/** Remove all geometries, but keep the allocated capacity. */
+void OGRWKBPolygonColumnarBuffer::Clear()
+{
+    m_anGeomOffsets.resize(1);
+    m_anPolygonOffsets.resize(1);
+    m_anRingOffsets.resize(1);
+    m_adfCoords.clear();
+    m_afCoords.clear();
+    m_abIsMulti.clear();
+}
+
+/************************************************************************/
+/*                     OGRWKBCopyCoordinates()                          */
+/************************************************************************/
+
+template <class T>
+static void OGRWKBCopyCoordinates(const GByte *pabyIn, uint32_t nPoints,
+                                  bool bNeedSwap, int nWKBDim, bool bInputHasZ,
+                                  int nOutDim, T *pOut)
+{
+    for (uint32_t i = 0; i < nPoints; ++i)
+    {
+        pOut[0] = static_cast<T>(OGRWKBReadFloat64(pabyIn, bNeedSwap));
+        pOut[1] = static_cast<T>(
+            OGRWKBReadFloat64(pabyIn + sizeof(double), bNeedSwap));
+        if (nOutDim == 3)
+        {
+            pOut[2] = bInputHasZ ? static_cast<T>(OGRWKBReadFloat64(
+                                       pabyIn + 2 * sizeof(double), bNeedSwap))
+                                 : 0;
+        }
+        pabyIn += nWKBDim * sizeof(double);
+        pOut += nOutDim;
+    }
+}
+
+/************************************************************************/
+/*                             AppendRing()                             */
+/************************************************************************/
+
+bool OGRWKBPolygonColumnarBuffer::AppendRing(const GByte *pabyWkb,
+                                             size_t nWKBSize, size_t &iOffset,
+                                             bool bNeedSwap, int nWKBDim,
+                                             bool bInputHasZ)
+{
+    if (nWKBSize - iOffset < sizeof(uint32_t))
+        return false;
+    const uint32_t nPoints = OGRWKBReadUInt32(pabyWkb + iOffset, bNeedSwap);
+    iOffset += sizeof(uint32_t);
+    const size_t nTupleSize = nWKBDim * sizeof(double);
+    if (nPoints > (nWKBSize - iOffset) / nTupleSize)
+        return false;
+    const size_t nPointsBefore = static_cast<size_t>(m_anRingOffsets.back());
+    if (nPoints > static_cast<size_t>(INT_MAX) - nPointsBefore)
+        return false;
+    const GByte *pabyIn = pabyWkb + iOffset;
+    iOffset += nPoints * nTupleSize;
+
+    const size_t nOldSize = nPointsBefore * m_nDim;
+    const size_t nNewSize = nOldSize + static_cast<size_t>(nPoints) * m_nDim;
+    if (m_bFloat32)
+    {
+        m_afCoords.resize(nNewSize);
+        OGRWKBCopyCoordinates(pabyIn, nPoints, bNeedSwap, nWKBDim, bInputHasZ,
+                              m_nDim, m_afCoords.data() + nOldSize);
+    }
+    else
+    {
+        m_adfCoords.resize(nNewSize);
+        if (!bNeedSwap && nWKBDim == m_nDim && (m_nDim == 2 || bInputHasZ))
+        {
+            // Same layout: the ring is a single block copy.
+            if (nPoints)
+                memcpy(m_adfCoords.data() + nOldSize, pabyIn,
+                       nPoints * nTupleSize);
+        }
+        else
+        {
+            OGRWKBCopyCoordinates(pabyIn, nPoints, bNeedSwap, nWKBDim,
+                                  bInputHasZ, m_nDim,
+                                  m_adfCoords.data() + nOldSize);
+        }
+    }
+    m_anRingOffsets.push_back(static_cast<int32_t>(nPointsBefore + nPoints));
+    return true;
+}
+
+/************************************************************************/
+/*                            AppendPolygon()                           */
+/************************************************************************/
+
+bool OGRWKBPolygonColumnarBuffer::AppendPolygon(const GByte *pabyWkb,
+                                                size_t nWKBSize,
+                                                size_t &iOffset)
+{
+    OGRwkbGeometryType eType = wkbUnknown;
+    if (nWKBSize - iOffset < MIN_WKB_SIZE ||
+        OGRReadWKBGeometryType(pabyWkb + iOffset, wkbVariantIso, &eType) !=
+            OGRERR_NONE ||
+        wkbFlatten(eType) != wkbPolygon)
+    {
+        return false;
+    }
+    const bool bNeedSwap = OGRWKBNeedSwap(
+        static_cast<GByte>(DB2_V72_FIX_BYTE_ORDER(pabyWkb[iOffset])));
+    const bool bInputHasZ = CPL_TO_BOOL(wkbHasZ(eType));
+    const int nWKBDim = 2 + (bInputHasZ ? 1 : 0) + (wkbHasM(eType) ? 1 : 0);
+    const uint32_t nRings =
+        OGRWKBReadUInt32(pabyWkb + iOffset + WKB_PREFIX_SIZE, bNeedSwap);
+    iOffset += MIN_WKB_SIZE;
+    if (nRings > (nWKBSize - iOffset) / sizeof(uint32_t))
+        return false;
+    for (uint32_t i = 0; i < nRings; ++i)
+    {
+        if (!AppendRing(pabyWkb, nWKBSize, iOffset, bNeedSwap, nWKBDim,
+                        bInputHasZ))
+            return false;
+    }
+    if (m_anRingOffsets.size() - 1 > static_cast<size_t>(INT_MAX))
+        return false;
+    m_anPolygonOffsets.push_back(
+        static_cast<int32_t>(m_anRingOffsets.size() - 1));
+    return true;
+}
+
+/************************************************************************/
+/*                              AppendWKB()                             */
+/************************************************************************/
+
+/** Append a Polygon or MultiPolygon geometry, in ISO WKB or OGC 1.1 WKB
+ * (with Z / 25D bit) encoding.
+ *
+ * @return true in case of success. In case of error (corrupted WKB, or other
+ * geometry type), the content of the buffer is unchanged.
+ */
+bool OGRWKBPolygonColumnarBuffer::AppendWKB(const GByte *pabyWkb,
+                                            size_t nWKBSize)
+{
+    const size_t nGeomsBefore = m_anGeomOffsets.size();
+    const size_t nPolygonsBefore = m_anPolygonOffsets.size();
+    const size_t nRingsBefore = m_anRingOffsets.size();
+    const size_t nCoordsBefore =
+        m_bFloat32 ? m_afCoords.size() : m_adfCoords.size();
+    const size_t nIsMultiBefore = m_abIsMulti.size();
+    bool bOK = false;
+    try
+    {
+        OGRwkbGeometryType eType = wkbUnknown;
+        if (nWKBSize >= MIN_WKB_SIZE &&
+            OGRReadWKBGeometryType(pabyWkb, wkbVariantIso, &eType) ==
+                OGRERR_NONE)
+        {
+            size_t iOffset = 0;
+            bool bIsMulti = false;
+            if (wkbFlatten(eType) == wkbPolygon)
+            {
+                bOK = AppendPolygon(pabyWkb, nWKBSize, iOffset);
+            }
+            else if (wkbFlatten(eType) == wkbMultiPolygon)
+            {
+                bIsMulti = true;
+                const bool bNeedSwap = OGRWKBNeedSwap(
+                    static_cast<GByte>(DB2_V72_FIX_BYTE_ORDER(pabyWkb[0])));
+                const uint32_t nParts =
+                    OGRWKBReadUInt32(pabyWkb + WKB_PREFIX_SIZE, bNeedSwap);
+                iOffset = MIN_WKB_SIZE;
+                bOK = nParts <= (nWKBSize - iOffset) / MIN_WKB_SIZE;
+                for (uint32_t i = 0; bOK && i < nParts; ++i)
+                    bOK = AppendPolygon(pabyWkb, nWKBSize, iOffset);
+            }
+            if (bOK && m_anPolygonOffsets.size() - 1 >
+                           static_cast<size_t>(INT_MAX))
+            {
+                bOK = false;
+            }
+            if (bOK)
+            {
+                m_anGeomOffsets.push_back(
+                    static_cast<int32_t>(m_anPolygonOffsets.size() - 1));
+                m_abIsMulti.push_back(bIsMulti);
+            }
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in OGRWKBPolygonColumnarBuffer::AppendWKB()");
+        bOK = false;
+    }
+    if (!bOK)
+    {
+        m_anGeomOffsets.resize(nGeomsBefore);
+        m_anPolygonOffsets.resize(nPolygonsBefore);
+        m_anRingOffsets.resize(nRingsBefore);
+        if (m_bFloat32)
+            m_afCoords.resize(nCoordsBefore);
+        else
+            m_adfCoords.resize(nCoordsBefore);
+        m_abIsMulti.resize(nIsMultiBefore);
+    }
+    return bOK;
+}
+
+/************************************************************************/
+/*                          GetX() / GetY() / GetZ()                    */
+/************************************************************************/
+
+inline double OGRWKBPolygonColumnarBuffer::GetX(size_t iPoint) const
+{
+    return m_bFloat32 ? m_afCoords[iPoint * m_nDim]
+                      : m_adfCoords[iPoint * m_nDim];
+}
+
+inline double OGRWKBPolygonColumnarBuffer::GetY(size_t iPoint) const
+{
+    return m_bFloat32 ? m_afCoords[iPoint * m_nDim + 1]
+                      : m_adfCoords[iPoint * m_nDim + 1];
+}
+
+inline double OGRWKBPolygonColumnarBuffer::GetZ(size_t iPoint) const
+{
+    return m_bFloat32 ? m_afCoords[iPoint * m_nDim + 2]
+                      : m_adfCoords[iPoint * m_nDim + 2];
+}
+
+/************************************************************************/
+/*                            GetEnvelope()                             */
+/************************************************************************/
+
+/** Compute the 2D envelope of a geometry, without materializing it.
+ *
+ * @return false if iGeom is out of range or the geometry is empty.
+ */
+bool OGRWKBPolygonColumnarBuffer::GetEnvelope(size_t iGeom,
+                                              OGREnvelope &sEnvelope) const
+{
+    if (iGeom >= GetGeometryCount())
+        return false;
+    sEnvelope = OGREnvelope();
+    bool bEmpty = true;
+    for (int32_t iPoly = m_anGeomOffsets[iGeom];
+         iPoly < m_anGeomOffsets[iGeom + 1]; ++iPoly)
+    {
+        // Holes are within the exterior ring, so only look at the latter
+        const int32_t iRing = m_anPolygonOffsets[iPoly];
+        if (iRing == m_anPolygonOffsets[iPoly + 1] ||
+            m_anRingOffsets[iRing] == m_anRingOffsets[iRing + 1])
+            continue;
+        bEmpty = false;
+        if (!m_bFloat32)
+        {
+            OGRUpdateEnvelopeXY(
+                sEnvelope, m_adfCoords.data() + m_anRingOffsets[iRing] * m_nDim,
+                m_anRingOffsets[iRing + 1] - m_anRingOffsets[iRing],
+                m_nDim * sizeof(double));
+            continue;
+        }
+        for (int32_t iPoint = m_anRingOffsets[iRing];
+             iPoint < m_anRingOffsets[iRing + 1]; ++iPoint)
+        {
+            const double dfX = GetX(iPoint);
+            const double dfY = GetY(iPoint);
+            sEnvelope.MinX = std::min(sEnvelope.MinX, dfX);
+            sEnvelope.MinY = std::min(sEnvelope.MinY, dfY);
+            sEnvelope.MaxX = std::max(sEnvelope.MaxX, dfX);
+            sEnvelope.MaxY = std::max(sEnvelope.MaxY, dfY);
+        }
+    }
+    return !bEmpty;
+}
+
+/************************************************************************/
+/*                            GetRingArea()                             */
+/************************************************************************/
+
+double OGRWKBPolygonColumnarBuffer::GetRingArea(size_t iRing) const
+{
+    const size_t iStart = static_cast<size_t>(m_anRingOffsets[iRing]);
+    const size_t iEnd = static_cast<size_t>(m_anRingOffsets[iRing + 1]);
+    if (iEnd - iStart < 2)
+        return 0;
+    // Computation according to Green's Theorem
+    // Cf OGRSimpleCurve::get_LinearArea()
+    double x_m1 = GetX(iStart);
+    double y_m1 = GetY(iStart);
+    double y_m2 = y_m1;
+    double dfArea = 0;
+    for (size_t i = iStart + 1; i < iEnd; ++i)
+    {
+        const double x = GetX(i);
+        const double y = GetY(i);
+        dfArea += x_m1 * (y - y_m2);
+        y_m2 = y_m1;
+        x_m1 = x;
+        y_m1 = y;
+    }
+    dfArea += x_m1 * (y_m1 - y_m2);
+    return 0.5 * std::fabs(dfArea);
+}
+
+/************************************************************************/
+/*                              GetArea()                               */
+/************************************************************************/
+
+/** Compute the area of a geometry, without materializing it.
+ *
+ * @return the area, or 0 if iGeom is out of range.
+ */
+double OGRWKBPolygonColumnarBuffer::GetArea(size_t iGeom) const
+{
+    if (iGeom >= GetGeometryCount())
+        return 0;
+    double dfArea = 0;
+    for (int32_t iPoly = m_anGeomOffsets[iGeom];
+         iPoly < m_anGeomOffsets[iGeom + 1]; ++iPoly)
+    {
+        for (int32_t iRing = m_anPolygonOffsets[iPoly];
+             iRing < m_anPolygonOffsets[iPoly + 1]; ++iRing)
+        {
+            if (iRing == m_anPolygonOffsets[iPoly])
+                dfArea += GetRingArea(iRing);
+            else
+                dfArea -= GetRingArea(iRing);
+        }
+    }
+    return dfArea;
+}
+
+/************************************************************************/
+/*                             GetGeometry()                            */
+/************************************************************************/
+
+/** Materialize a geometry as a OGRPolygon or OGRMultiPolygon, depending
+ * on the type of the appended geometry.
+ *
+ * @return a new geometry to be freed by the caller, or nullptr if iGeom is
+ * out of range.
+ */
+OGRGeometry *OGRWKBPolygonColumnarBuffer::GetGeometry(size_t iGeom) const
+{
+    if (iGeom >= GetGeometryCount())
+        return nullptr;
+    OGRMultiPolygon *poMP =
+        m_abIsMulti[iGeom] ? new OGRMultiPolygon() : nullptr;
+    OGRPolygon *poPoly = nullptr;
+    for (int32_t iPoly = m_anGeomOffsets[iGeom];
+         iPoly < m_anGeomOffsets[iGeom + 1]; ++iPoly)
+    {
+        poPoly = new OGRPolygon();
+        for (int32_t iRing = m_anPolygonOffsets[iPoly];
+             iRing < m_anPolygonOffsets[iPoly + 1]; ++iRing)
+        {
+            const int32_t iStart = m_anRingOffsets[iRing];
+            const int32_t nPoints = m_anRingOffsets[iRing + 1] - iStart;
+            auto poRing = new OGRLinearRing();
+            if (m_nDim == 3)
+                poRing->set3D(TRUE);
+            poRing->setNumPoints(nPoints, FALSE);
+            for (int32_t i = 0; i < nPoints; ++i)
+            {
+                if (m_nDim == 3)
+                    poRing->setPoint(i, GetX(iStart + i), GetY(iStart + i),
+                                     GetZ(iStart + i));
+                else
+                    poRing->setPoint(i, GetX(iStart + i), GetY(iStart + i));
+            }
+            poPoly->addRingDirectly(poRing);
+        }
+        if (poMP)
+            poMP->addGeometryDirectly(poPoly);
+    }
+    OGRGeometry *poRet = poMP ? static_cast<OGRGeometry *>(poMP) : poPoly;
+    if (m_nDim == 3)
+        poRet->set3D(TRUE);
+    return poRet;
+}
@@ -32,6 +32,11 @@
 #include "cpl_port.h"
 #include "ogr_core.h"
 
+#include <vector>
+
+class OGRCoordinateTransformation;
+class OGRGeometry;
+
 bool CPL_DLL OGRWKBGetGeomType(const GByte *pabyWkb, size_t nWKBSize,
                                bool &bNeedSwap, uint32_t &nType);
 bool OGRWKBPolygonGetArea(const GByte *&pabyWkb, size_t &nWKBSize,
@@ -48,6 +53,27 @@ bool CPL_DLL OGRWKBIntersectsPessimistic(const GByte *pabyWkb, size_t nWKBSize,
 void CPL_DLL OGRWKBFixupCounterClockWiseExternalRing(GByte *pabyWkb,
                                                      size_t nWKBSize);
 
+bool CPL_DLL OGRWKBIntersectsEnvelope(const GByte *pabyWkb, size_t nWKBSize,
+                                      const OGREnvelope &sEnvelope,
+                                      bool &bIntersects);
+
+bool CPL_DLL OGRWKBGetLength(const GByte *pabyWkb, size_t nWKBSize,
+                             double &dfLength);
+
+bool CPL_DLL OGRWKBGetArea(const GByte *pabyWkb, size_t nWKBSize,
+                           double &dfArea);
+
+bool CPL_DLL OGRWKBGetCentroid(const GByte *pabyWkb, size_t nWKBSize,
+                               double &dfX, double &dfY);
+
+bool CPL_DLL OGRWKBTransform(GByte *pabyWkb, size_t nWKBSize,
+                             OGRCoordinateTransformation *poCT);
+
+bool CPL_DLL OGRWKBTransformBatch(GByte *const *papabyWkb,
+                                  const size_t *panWKBSize, size_t nCount,
+                                  OGRCoordinateTransformation *poCT,
+                                  int *pabSuccess);
+
 /** Modifies a PostGIS-style Extended WKB geometry to a regular WKB one.
  * pabyEWKB will be modified in place.
  * The return value will be either at the beginning of pabyEWKB or 4 bytes
@@ -139,4 +165,122 @@ class CPL_DLL OGRWKTToWKBTranslator
                         bool bCanAlterByteAfter);
 };
 
+/************************************************************************/
+/*                    OGRWKBPolygonColumnarBuffer                       */
+/************************************************************************/
+
+/** Columnar storage of a sequence of Polygon / MultiPolygon geometries.
+ *
+ * The coordinates of all geometries are stored in a single contiguous
+ * array of interleaved values (XY or XYZ), and the geometry, polygon and
+ * ring boundaries are expressed as offset arrays, following the GeoArrow
+ * native "multipolygon" encoding. Appending a geometry from WKB thus does not
+ * involve any per-ring or per-part allocation once the arrays have reached
+ * their steady state size, and Clear() keeps the allocated capacity so that
+ * a same instance can be reused from one batch of features to the next.
+ *
+ * Coordinates can optionally be stored as float32 values, to halve the
+ * memory usage, at the expense of precision.
+ *
+ * M values are ignored. A Z buffer will get Z=0 for 2D input geometries,
+ * and Z values of 3D input geometries are dropped by a 2D buffer.
+ */
+class CPL_DLL OGRWKBPolygonColumnarBuffer
+{
+  public:
+    /** Constructor */
+    explicit OGRWKBPolygonColumnarBuffer(bool bHasZ = false,
+                                         bool bFloat32 = false);
+
+    void Clear();
+
+    bool AppendWKB(const GByte *pabyWkb, size_t nWKBSize);
+
+    /** Return the number of geometries. */
+    inline size_t GetGeometryCount() const
+    {
+        return m_anGeomOffsets.size() - 1;
+    }
+
+    /** Return whether coordinates have a Z component. */
+    inline bool HasZ() const
+    {
+        return m_nDim == 3;
+    }
+
+    /** Return whether coordinates are stored as float32. */
+    inline bool IsFloat32() const
+    {
+        return m_bFloat32;
+    }
+
+    /** Return the number of values per coordinate tuple (2 or 3). */
+    inline int GetDimension() const
+    {
+        return m_nDim;
+    }
+
+    /** Return the total number of coordinate tuples. */
+    inline size_t GetPointCount() const
+    {
+        return static_cast<size_t>(m_anRingOffsets.back());
+    }
+
+    /** Return the GetGeometryCount() + 1 offsets of geometries in the
+     * polygon offset array. */
+    inline const std::vector<int32_t> &GetGeometryOffsets() const
+    {
+        return m_anGeomOffsets;
+    }
+
+    /** Return the offsets of polygons in the ring offset array. */
+    inline const std::vector<int32_t> &GetPolygonOffsets() const
+    {
+        return m_anPolygonOffsets;
+    }
+
+    /** Return the offsets of rings in the coordinate tuple array. */
+    inline const std::vector<int32_t> &GetRingOffsets() const
+    {
+        return m_anRingOffsets;
+    }
+
+    /** Return the coordinate array when !IsFloat32(), or nullptr. */
+    inline const double *GetCoordinatesFloat64() const
+    {
+        return m_bFloat32 ? nullptr : m_adfCoords.data();
+    }
+
+    /** Return the coordinate array when IsFloat32(), or nullptr. */
+    inline const float *GetCoordinatesFloat32() const
+    {
+        return m_bFloat32 ? m_afCoords.data() : nullptr;
+    }
+
+    bool GetEnvelope(size_t iGeom, OGREnvelope &sEnvelope) const;
+
+    double GetArea(size_t iGeom) const;
+
+    OGRGeometry *GetGeometry(size_t iGeom) const;
+
+  private:
+    const int m_nDim;
+    const bool m_bFloat32;
+    std::vector<int32_t> m_anGeomOffsets{0};
+    std::vector<int32_t> m_anPolygonOffsets{0};
+    std::vector<int32_t> m_anRingOffsets{0};
+    std::vector<double> m_adfCoords{};
+    std::vector<float> m_afCoords{};
+    std::vector<bool> m_abIsMulti{};
+
+    bool AppendPolygon(const GByte *pabyWkb, size_t nWKBSize,
+                       size_t &iOffset);
+    bool AppendRing(const GByte *pabyWkb, size_t nWKBSize, size_t &iOffset,
+                    bool bNeedSwap, int nWKBDim, bool bInputHasZ);
+    inline double GetX(size_t iPoint) const;
+    inline double GetY(size_t iPoint) const;
+    inline double GetZ(size_t iPoint) const;
+    double GetRingArea(size_t iRing) const;
+};
+
 #endif  // OGR_WKB_H_INCLUDED
@@ -6293,6 +6293,109 @@ OGRErr OGR_F_SetFromWithMap(OGRFeatureH hFeat, OGRFeatureH hOtherFeat,
         OGRFeature::FromHandle(hOtherFeat), panMap, bForgiving);
 }
 
+/************************************************************************/
+/*                          SetFromStealing()                           */
+/************************************************************************/
+
+/**
+ * \brief Set one feature from another, transferring values rather than
+ * copying them when possible.
+ *
+ * This method does the same as SetFrom(), except that geometries, as well as
+ * the values of string, binary and list fields whose type is the same in
+ * both features, are moved from poSrcFeature to this feature instead of
+ * being duplicated. This saves a memory allocation, copy and deallocation
+ * per value, which is significant when translating many features whose
+ * source is discarded afterwards.
+ *
+ * On return, the transferred geometries and field values are unset in
+ * poSrcFeature.
+ *
+ * @param poSrcFeature the feature from which geometry, and field values will
+ * be transferred or copied.
+ *
+ * @param panMap Array of the indices of the feature's fields
+ * stored at the corresponding index of the source feature's fields. A value of
+ * -1 should be used to ignore the source's field. The array should not be NULL
+ * and be as long as the number of fields in the source feature.
+ *
+ * @param bForgiving TRUE if the operation should continue despite lacking
+ * output fields matching some of the source fields.
+ *
+ * @param bUseISO8601ForDateTimeAsString true if datetime fields
+ * converted to string should use ISO8601 formatting rather than OGR own format.
+ *
+ * @return OGRERR_NONE if the operation succeeds, even if some values are
+ * not transferred, otherwise an error code.
+ *
+ * @since GDAL 3.9
+ */
+
+OGRErr OGRFeature::SetFromStealing(OGRFeature *poSrcFeature, const int *panMap,
+                                   int bForgiving,
+                                   bool bUseISO8601ForDateTimeAsString)
+
+{
+    if (poSrcFeature == this)
+        return OGRERR_FAILURE;
+
+    SetFID(OGRNullFID);
+
+    /* -------------------------------------------------------------------- */
+    /*      Transfer the geometries, with the same matching rules as        */
+    /*      SetFrom().                                                      */
+    /* -------------------------------------------------------------------- */
+    const int nGeomFieldCount = GetGeomFieldCount();
+    for (int i = 0; i < nGeomFieldCount; i++)
+    {
+        int iSrc = poSrcFeature->GetGeomFieldIndex(
+            GetGeomFieldDefnRef(i)->GetNameRef());
+        if (iSrc < 0 && nGeomFieldCount == 1)
+            iSrc = 0;
+        SetGeomFieldDirectly(
+            i, iSrc >= 0 ? poSrcFeature->StealGeometry(iSrc) : nullptr);
+    }
+
+    SetStyleString(poSrcFeature->GetStyleString());
+    SetNativeData(poSrcFeature->GetNativeData());
+    SetNativeMediaType(poSrcFeature->GetNativeMediaType());
+
+    /* -------------------------------------------------------------------- */
+    /*      Transfer the values of fields that own memory, when no          */
+    /*      conversion is needed, and let SetFieldsFrom() deal with the     */
+    /*      others.                                                         */
+    /* -------------------------------------------------------------------- */
+    const int nSrcFieldCount = poSrcFeature->poDefn->GetFieldCountUnsafe();
+    const int nFieldCount = poDefn->GetFieldCountUnsafe();
+    std::vector<int> anRemainingMap(panMap, panMap + nSrcFieldCount);
+    for (int iField = 0; iField < nSrcFieldCount; iField++)
+    {
+        const int iDstField = panMap[iField];
+        if (iDstField < 0 || iDstField >= nFieldCount ||
+            !poSrcFeature->IsFieldSetAndNotNullUnsafe(iField))
+        {
+            continue;
+        }
+
+        const auto eSrcType =
+            poSrcFeature->poDefn->GetFieldDefnUnsafe(iField)->GetType();
+        if (eSrcType != poDefn->GetFieldDefnUnsafe(iDstField)->GetType())
+            continue;
+        if (eSrcType == OFTString || eSrcType == OFTBinary ||
+            eSrcType == OFTStringList || eSrcType == OFTIntegerList ||
+            eSrcType == OFTInteger64List || eSrcType == OFTRealList)
+        {
+            UnsetField(iDstField);
+            pauFields[iDstField] = poSrcFeature->pauFields[iField];
+            OGR_RawField_SetUnset(&poSrcFeature->pauFields[iField]);
+            anRemainingMap[iField] = -1;
+        }
+    }
+
+    return SetFieldsFrom(poSrcFeature, anRemainingMap.data(), bForgiving,
+                         bUseISO8601ForDateTimeAsString);
+}
+
 /************************************************************************/
 /*                           SetFieldsFrom()                            */
 /************************************************************************/
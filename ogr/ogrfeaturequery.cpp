@@ -32,6 +32,7 @@
 #include "ogr_feature.h"
 #include "ogr_swq.h"
 
+#include <cctype>
 #include <cstddef>
 #include <cstdlib>
 #include <algorithm>
@@ -41,6 +42,7 @@
 #include "cpl_string.h"
 #include "ogr_attrind.h"
 #include "ogr_core.h"
+#include "ogr_featurequery_program.h"
 #include "ogr_p.h"
 #include "ogrsf_frmts.h"
 
@@ -77,6 +79,496 @@ OGRFeatureQuery::~OGRFeatureQuery()
     delete static_cast<swq_expr_node *>(pSWQExpr);
 }
 
+/************************************************************************/
+/*                  OGRFeatureQueryProgram::Compile()                   */
+/************************************************************************/
+
+/** Returns a program equivalent to poExpr, or nullptr if poExpr uses
+ * constructs that are not supported. */
+std::unique_ptr<OGRFeatureQueryProgram>
+OGRFeatureQueryProgram::Compile(const swq_expr_node *poExpr,
+                                const OGRFeatureDefn *poDefn)
+{
+    auto poProgram = std::make_unique<OGRFeatureQueryProgram>();
+    if (!poProgram->CompileNode(poExpr, poDefn))
+        return nullptr;
+
+    int nStackDepth = 0;
+    for (const auto &sInstr : poProgram->m_aoInstructions)
+    {
+        if (sInstr.eOp == Op::COMPARE)
+        {
+            if (++nStackDepth > MAX_STACK_DEPTH)
+                return nullptr;
+        }
+        else if (sInstr.eOp != Op::NOT)
+        {
+            nStackDepth -= sInstr.nOperands - 1;
+        }
+    }
+    CPLAssert(nStackDepth == 1);
+
+    return poProgram;
+}
+
+/************************************************************************/
+/*                OGRFeatureQueryProgram::CompileNode()                 */
+/************************************************************************/
+
+bool OGRFeatureQueryProgram::CompileNode(const swq_expr_node *poNode,
+                                         const OGRFeatureDefn *poDefn)
+{
+    // Boolean results are never null, which is what makes the program
+    // simpler than the general evaluator.
+    if (poNode->eNodeType != SNT_OPERATION ||
+        poNode->field_type != SWQ_BOOLEAN)
+        return false;
+
+    if (poNode->nOperation == SWQ_AND || poNode->nOperation == SWQ_OR)
+    {
+        if (poNode->nSubExprCount < 2)
+            return false;
+        for (int i = 0; i < poNode->nSubExprCount; ++i)
+        {
+            if (!CompileNode(poNode->papoSubExpr[i], poDefn))
+                return false;
+        }
+        Instruction sInstr;
+        sInstr.eOp = poNode->nOperation == SWQ_AND ? Op::AND : Op::OR;
+        sInstr.nOperands = poNode->nSubExprCount;
+        m_aoInstructions.push_back(std::move(sInstr));
+        return true;
+    }
+
+    if (poNode->nOperation == SWQ_NOT)
+    {
+        if (poNode->nSubExprCount != 1 ||
+            !CompileNode(poNode->papoSubExpr[0], poDefn))
+            return false;
+        Instruction sInstr;
+        sInstr.eOp = Op::NOT;
+        m_aoInstructions.push_back(std::move(sInstr));
+        return true;
+    }
+
+    return CompileComparison(poNode, poDefn);
+}
+
+/************************************************************************/
+/*             OGRFeatureQueryProgram::CompileComparison()              */
+/************************************************************************/
+
+bool OGRFeatureQueryProgram::CompileComparison(const swq_expr_node *poNode,
+                                               const OGRFeatureDefn *poDefn)
+{
+    Instruction sInstr;
+    const int nSubExprCount = poNode->nSubExprCount;
+    switch (poNode->nOperation)
+    {
+        case SWQ_EQ:
+            sInstr.eComparison = Comparison::EQ;
+            break;
+        case SWQ_NE:
+            sInstr.eComparison = Comparison::NE;
+            break;
+        case SWQ_LT:
+            sInstr.eComparison = Comparison::LT;
+            break;
+        case SWQ_LE:
+            sInstr.eComparison = Comparison::LE;
+            break;
+        case SWQ_GT:
+            sInstr.eComparison = Comparison::GT;
+            break;
+        case SWQ_GE:
+            sInstr.eComparison = Comparison::GE;
+            break;
+        case SWQ_BETWEEN:
+            sInstr.eComparison = Comparison::BETWEEN;
+            break;
+        case SWQ_IN:
+            sInstr.eComparison = Comparison::IN;
+            break;
+        case SWQ_ISNULL:
+            sInstr.eComparison = Comparison::ISNULL;
+            break;
+        default:
+            return false;
+    }
+
+    const int nExpectedSubExprCount =
+        sInstr.eComparison == Comparison::ISNULL    ? 1
+        : sInstr.eComparison == Comparison::BETWEEN ? 3
+        : sInstr.eComparison == Comparison::IN      ? nSubExprCount
+                                                    : 2;
+    if (nSubExprCount < 1 || nSubExprCount != nExpectedSubExprCount)
+        return false;
+
+    // "constant <op> column" is evaluated as "column <reversed op> constant"
+    int iColumn = 0;
+    if (nSubExprCount == 2 && sInstr.eComparison != Comparison::IN &&
+        poNode->papoSubExpr[0]->eNodeType == SNT_CONSTANT)
+    {
+        iColumn = 1;
+    }
+    const swq_expr_node *poColumn = poNode->papoSubExpr[iColumn];
+    if (poColumn->eNodeType != SNT_COLUMN || poColumn->table_index != 0)
+        return false;
+
+    const int nFieldCount = poDefn->GetFieldCount();
+    const int iField = poColumn->field_index;
+    if (iField >= 0 && iField < nFieldCount)
+    {
+        sInstr.iField = iField;
+        sInstr.eFieldType = poDefn->GetFieldDefn(iField)->GetType();
+        // Check that field values are fetched as in OGRFeatureFetcher()
+        if (sInstr.eComparison != Comparison::ISNULL &&
+            !(sInstr.eFieldType == OFTInteger &&
+              poColumn->field_type == SWQ_INTEGER) &&
+            !(sInstr.eFieldType == OFTInteger64 &&
+              poColumn->field_type == SWQ_INTEGER64) &&
+            !(sInstr.eFieldType == OFTReal &&
+              poColumn->field_type == SWQ_FLOAT) &&
+            !(sInstr.eFieldType == OFTString &&
+              poColumn->field_type == SWQ_STRING))
+        {
+            return false;
+        }
+    }
+    else if ((iField == nFieldCount + SPF_FID ||
+              iField == nFieldCount + SPECIAL_FIELD_COUNT +
+                            poDefn->GetGeomFieldCount()) &&
+             poColumn->field_type == SWQ_INTEGER64)
+    {
+        sInstr.iField = -1;
+        sInstr.eFieldType = OFTInteger64;
+    }
+    else
+    {
+        return false;
+    }
+
+    if (sInstr.eComparison == Comparison::ISNULL)
+    {
+        m_aoInstructions.push_back(std::move(sInstr));
+        return true;
+    }
+
+    // Same selection of the comparison type as in SWQGeneralEvaluator()
+    const swq_field_type eType0 = poNode->papoSubExpr[0]->field_type;
+    const swq_field_type eType1 = poNode->papoSubExpr[1]->field_type;
+    if (eType0 == SWQ_FLOAT || eType1 == SWQ_FLOAT)
+        sInstr.eValueType = ValueType::FLOAT;
+    else if (SWQ_IS_INTEGER(eType0))
+        sInstr.eValueType = ValueType::INTEGER;
+    else if (eType0 == SWQ_STRING)
+        sInstr.eValueType = ValueType::STRING;
+    else
+        return false;
+
+    const bool bNumericColumn = SWQ_IS_INTEGER(poColumn->field_type) ||
+                                poColumn->field_type == SWQ_FLOAT;
+    if ((sInstr.eValueType == ValueType::STRING) == bNumericColumn)
+        return false;
+
+    for (int i = 0; i < nSubExprCount; ++i)
+    {
+        if (i == iColumn)
+            continue;
+        const swq_expr_node *poConstant = poNode->papoSubExpr[i];
+        if (poConstant->eNodeType != SNT_CONSTANT || poConstant->is_null)
+            return false;
+        const swq_field_type eType = poConstant->field_type;
+        switch (sInstr.eValueType)
+        {
+            case ValueType::INTEGER:
+                if (!SWQ_IS_INTEGER(eType))
+                    return false;
+                sInstr.anValues.push_back(poConstant->int_value);
+                break;
+
+            case ValueType::FLOAT:
+                // Only the first two operands are converted from integer
+                if (eType == SWQ_FLOAT || (SWQ_IS_INTEGER(eType) && i >= 2))
+                    sInstr.adfValues.push_back(poConstant->float_value);
+                else if (SWQ_IS_INTEGER(eType))
+                    sInstr.adfValues.push_back(
+                        static_cast<double>(poConstant->int_value));
+                else
+                    return false;
+                break;
+
+            case ValueType::STRING:
+            {
+                if (eType != SWQ_STRING || poConstant->string_value == nullptr)
+                    return false;
+                // The = operator has special rules for values that look
+                // like timestamps.
+                const size_t nLen = strlen(poConstant->string_value);
+                if (sInstr.eComparison == Comparison::EQ && nLen > 3 &&
+                    (strcmp(poConstant->string_value + nLen - 3, "+00") == 0 ||
+                     poConstant->string_value[nLen - 3] == ':'))
+                    return false;
+                sInstr.aosValues.push_back(poConstant->string_value);
+                break;
+            }
+        }
+    }
+
+    if (iColumn == 1)
+    {
+        switch (sInstr.eComparison)
+        {
+            case Comparison::LT:
+                sInstr.eComparison = Comparison::GT;
+                break;
+            case Comparison::LE:
+                sInstr.eComparison = Comparison::GE;
+                break;
+            case Comparison::GT:
+                sInstr.eComparison = Comparison::LT;
+                break;
+            case Comparison::GE:
+                sInstr.eComparison = Comparison::LE;
+                break;
+            default:
+                break;
+        }
+    }
+
+    m_aoInstructions.push_back(std::move(sInstr));
+    return true;
+}
+
+/************************************************************************/
+/*             OGRFeatureQueryProgram::CompareInteger()                 */
+/************************************************************************/
+
+bool OGRFeatureQueryProgram::CompareInteger(const Instruction &sInstr,
+                                            GIntBig nValue)
+{
+    const auto &anValues = sInstr.anValues;
+    switch (sInstr.eComparison)
+    {
+        case Comparison::EQ:
+            return nValue == anValues[0];
+        case Comparison::NE:
+            return nValue != anValues[0];
+        case Comparison::LT:
+            return nValue < anValues[0];
+        case Comparison::LE:
+            return nValue <= anValues[0];
+        case Comparison::GT:
+            return nValue > anValues[0];
+        case Comparison::GE:
+            return nValue >= anValues[0];
+        case Comparison::BETWEEN:
+            return nValue >= anValues[0] && nValue <= anValues[1];
+        case Comparison::IN:
+            return std::find(anValues.begin(), anValues.end(), nValue) !=
+                   anValues.end();
+        case Comparison::ISNULL:
+            break;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*              OGRFeatureQueryProgram::CompareFloat()                  */
+/************************************************************************/
+
+bool OGRFeatureQueryProgram::CompareFloat(const Instruction &sInstr,
+                                          double dfValue)
+{
+    const auto &adfValues = sInstr.adfValues;
+    switch (sInstr.eComparison)
+    {
+        case Comparison::EQ:
+            return dfValue == adfValues[0];
+        case Comparison::NE:
+            return dfValue != adfValues[0];
+        case Comparison::LT:
+            return dfValue < adfValues[0];
+        case Comparison::LE:
+            return dfValue <= adfValues[0];
+        case Comparison::GT:
+            return dfValue > adfValues[0];
+        case Comparison::GE:
+            return dfValue >= adfValues[0];
+        case Comparison::BETWEEN:
+            return dfValue >= adfValues[0] && dfValue <= adfValues[1];
+        case Comparison::IN:
+            return std::find(adfValues.begin(), adfValues.end(), dfValue) !=
+                   adfValues.end();
+        case Comparison::ISNULL:
+            break;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                         CaseInsensitiveCompare()                     */
+/************************************************************************/
+
+// Same as strcasecmp(pszA, osB), except that pszA is also terminated after
+// nLenA bytes.
+static int CaseInsensitiveCompare(const char *pszA, size_t nLenA,
+                                  const std::string &osB)
+{
+    const unsigned char *pabyA = reinterpret_cast<const unsigned char *>(pszA);
+    const unsigned char *pabyB =
+        reinterpret_cast<const unsigned char *>(osB.c_str());
+    for (size_t i = 0;; ++i)
+    {
+        const int chA = i < nLenA ? tolower(pabyA[i]) : 0;
+        const int chB = tolower(pabyB[i]);
+        if (chA != chB)
+            return chA - chB;
+        if (chA == 0)
+            return 0;
+    }
+}
+
+/************************************************************************/
+/*              OGRFeatureQueryProgram::CompareString()                 */
+/************************************************************************/
+
+/** nLen may be std::string::npos if pszValue is nul-terminated. */
+bool OGRFeatureQueryProgram::CompareString(const Instruction &sInstr,
+                                           const char *pszValue, size_t nLen)
+{
+    const auto &aosValues = sInstr.aosValues;
+    switch (sInstr.eComparison)
+    {
+        case Comparison::EQ:
+            return CaseInsensitiveCompare(pszValue, nLen, aosValues[0]) == 0;
+        case Comparison::NE:
+            return CaseInsensitiveCompare(pszValue, nLen, aosValues[0]) != 0;
+        case Comparison::LT:
+            return CaseInsensitiveCompare(pszValue, nLen, aosValues[0]) < 0;
+        case Comparison::LE:
+            return CaseInsensitiveCompare(pszValue, nLen, aosValues[0]) <= 0;
+        case Comparison::GT:
+            return CaseInsensitiveCompare(pszValue, nLen, aosValues[0]) > 0;
+        case Comparison::GE:
+            return CaseInsensitiveCompare(pszValue, nLen, aosValues[0]) >= 0;
+        case Comparison::BETWEEN:
+            return CaseInsensitiveCompare(pszValue, nLen, aosValues[0]) >= 0 &&
+                   CaseInsensitiveCompare(pszValue, nLen, aosValues[1]) <= 0;
+        case Comparison::IN:
+            for (const auto &osValue : aosValues)
+            {
+                if (CaseInsensitiveCompare(pszValue, nLen, osValue) == 0)
+                    return true;
+            }
+            return false;
+        case Comparison::ISNULL:
+            break;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                        EvaluateComparison()                          */
+/************************************************************************/
+
+static bool
+EvaluateComparison(const OGRFeatureQueryProgram::Instruction &sInstr,
+                   const OGRFeature *poFeature)
+{
+    using Comparison = OGRFeatureQueryProgram::Comparison;
+    using ValueType = OGRFeatureQueryProgram::ValueType;
+
+    if (sInstr.iField < 0)
+    {
+        const GIntBig nFID = poFeature->GetFID();
+        if (nFID == OGRNullFID)
+            return sInstr.eComparison == Comparison::ISNULL;
+        if (sInstr.eComparison == Comparison::ISNULL)
+            return false;
+        return sInstr.eValueType == ValueType::FLOAT
+                   ? OGRFeatureQueryProgram::CompareFloat(
+                         sInstr, static_cast<double>(nFID))
+                   : OGRFeatureQueryProgram::CompareInteger(sInstr, nFID);
+    }
+
+    if (!poFeature->IsFieldSetAndNotNullUnsafe(sInstr.iField))
+        return sInstr.eComparison == Comparison::ISNULL;
+    if (sInstr.eComparison == Comparison::ISNULL)
+        return false;
+
+    const OGRField *psField = poFeature->GetRawFieldRef(sInstr.iField);
+    switch (sInstr.eFieldType)
+    {
+        case OFTInteger:
+            return sInstr.eValueType == ValueType::FLOAT
+                       ? OGRFeatureQueryProgram::CompareFloat(
+                             sInstr, static_cast<double>(psField->Integer))
+                       : OGRFeatureQueryProgram::CompareInteger(
+                             sInstr, psField->Integer);
+        case OFTInteger64:
+            return sInstr.eValueType == ValueType::FLOAT
+                       ? OGRFeatureQueryProgram::CompareFloat(
+                             sInstr, static_cast<double>(psField->Integer64))
+                       : OGRFeatureQueryProgram::CompareInteger(
+                             sInstr, psField->Integer64);
+        case OFTReal:
+            return OGRFeatureQueryProgram::CompareFloat(sInstr, psField->Real);
+        case OFTString:
+            return OGRFeatureQueryProgram::CompareString(
+                sInstr, psField->String, std::string::npos);
+        default:
+            break;
+    }
+    CPLAssert(false);
+    return false;
+}
+
+/************************************************************************/
+/*                OGRFeatureQueryProgram::Evaluate()                    */
+/************************************************************************/
+
+bool OGRFeatureQueryProgram::Evaluate(const OGRFeature *poFeature) const
+{
+    bool abStack[MAX_STACK_DEPTH];
+    int nStackSize = 0;
+    for (const auto &sInstr : m_aoInstructions)
+    {
+        switch (sInstr.eOp)
+        {
+            case Op::COMPARE:
+                abStack[nStackSize++] = EvaluateComparison(sInstr, poFeature);
+                break;
+
+            case Op::AND:
+            {
+                nStackSize -= sInstr.nOperands;
+                bool bRes = true;
+                for (int i = 0; i < sInstr.nOperands; ++i)
+                    bRes = bRes && abStack[nStackSize + i];
+                abStack[nStackSize++] = bRes;
+                break;
+            }
+
+            case Op::OR:
+            {
+                nStackSize -= sInstr.nOperands;
+                bool bRes = false;
+                for (int i = 0; i < sInstr.nOperands; ++i)
+                    bRes = bRes || abStack[nStackSize + i];
+                abStack[nStackSize++] = bRes;
+                break;
+            }
+
+            case Op::NOT:
+                abStack[nStackSize - 1] = !abStack[nStackSize - 1];
+                break;
+        }
+    }
+    CPLAssert(nStackSize == 1);
+    return abStack[0];
+}
+
 /************************************************************************/
 /*                             Compile()                                */
 /************************************************************************/
@@ -247,6 +739,14 @@ OGRFeatureQuery::Compile(OGRLayer *poLayer, OGRFeatureDefn *poDefn,
     CPLFree(papszFieldNames);
     CPLFree(paeFieldTypes);
 
+    m_poProgram.reset();
+    if (pSWQExpr != nullptr &&
+        CPLTestBool(CPLGetConfigOption("OGR_FEATURE_QUERY_COMPILE", "YES")))
+    {
+        m_poProgram = OGRFeatureQueryProgram::Compile(
+            static_cast<swq_expr_node *>(pSWQExpr), poDefn);
+    }
+
     return eErr;
 }
 
@@ -328,6 +828,9 @@ int OGRFeatureQuery::Evaluate(OGRFeature *poFeature)
     if (pSWQExpr == nullptr)
         return FALSE;
 
+    if (m_poProgram)
+        return m_poProgram->Evaluate(poFeature);
+
     swq_expr_node *poResult = static_cast<swq_expr_node *>(pSWQExpr)->Evaluate(
         OGRFeatureFetcher, poFeature, *m_psContext);
 
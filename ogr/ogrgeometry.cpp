@@ -38,6 +38,7 @@
 #include <cstring>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -6269,12 +6270,145 @@ void OGR_G_SwapXY(OGRGeometryH hGeom)
 /************************************************************************/
 
 #if defined(HAVE_GEOS)
+namespace
+{
+/* Node of the quadtree subdivision of a complex polygonal geometry. Leaves
+ * hold the part of the geometry clipped to their envelope, so that testing
+ * a small geometry against it only involves a small prepared geometry. */
+struct OGRPreparedGeometryTile
+{
+    GEOSContextHandle_t hGEOSCtxt = nullptr;
+    OGREnvelope sEnvelope{};
+    // Only set for leaves
+    GEOSGeom hGEOSGeom = nullptr;
+    const GEOSPreparedGeometry *poPreparedGEOSGeom = nullptr;
+    std::vector<std::unique_ptr<OGRPreparedGeometryTile>> apoChildren{};
+
+    explicit OGRPreparedGeometryTile(GEOSContextHandle_t hGEOSCtxtIn)
+        : hGEOSCtxt(hGEOSCtxtIn)
+    {
+    }
+
+    ~OGRPreparedGeometryTile()
+    {
+        if (poPreparedGEOSGeom)
+            GEOSPreparedGeom_destroy_r(hGEOSCtxt, poPreparedGEOSGeom);
+        if (hGEOSGeom)
+            GEOSGeom_destroy_r(hGEOSCtxt, hGEOSGeom);
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRPreparedGeometryTile)
+};
+
+// Polygonal geometries with more coordinates than that are subdivided
+constexpr int PREPARED_GEOM_SUBDIVIDE_THRESHOLD = 1024;
+constexpr int PREPARED_GEOM_MAX_COORDS_PER_TILE = 256;
+constexpr int PREPARED_GEOM_MAX_DEPTH = 12;
+// Geometries whose envelope intersects more tiles than that are tested
+// against the whole prepared geometry.
+constexpr int PREPARED_GEOM_MAX_TILES_PER_QUERY = 16;
+}  // namespace
+
 struct _OGRPreparedGeometry
 {
     GEOSContextHandle_t hGEOSCtxt;
     GEOSGeom hGEOSGeom;
     const GEOSPreparedGeometry *poPreparedGEOSGeom;
+    std::unique_ptr<OGRPreparedGeometryTile> poRootTile{};
 };
+
+/************************************************************************/
+/*                     OGRBuildPreparedGeometryTile()                   */
+/************************************************************************/
+
+/* Takes ownership of hGEOSGeom. Returns nullptr in case of error. */
+static std::unique_ptr<OGRPreparedGeometryTile>
+OGRBuildPreparedGeometryTile(GEOSContextHandle_t hGEOSCtxt, GEOSGeom hGEOSGeom,
+                             const OGREnvelope &sEnvelope, int nDepth)
+{
+    auto poTile = std::make_unique<OGRPreparedGeometryTile>(hGEOSCtxt);
+    poTile->sEnvelope = sEnvelope;
+    if (nDepth == PREPARED_GEOM_MAX_DEPTH ||
+        GEOSGetNumCoordinates_r(hGEOSCtxt, hGEOSGeom) <=
+            PREPARED_GEOM_MAX_COORDS_PER_TILE)
+    {
+        poTile->hGEOSGeom = hGEOSGeom;
+        poTile->poPreparedGEOSGeom = GEOSPrepare_r(hGEOSCtxt, hGEOSGeom);
+        if (poTile->poPreparedGEOSGeom == nullptr)
+            return nullptr;
+        return poTile;
+    }
+
+    const double dfMidX = (sEnvelope.MinX + sEnvelope.MaxX) / 2;
+    const double dfMidY = (sEnvelope.MinY + sEnvelope.MaxY) / 2;
+    OGREnvelope asQuadrants[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        asQuadrants[i].MinX = (i % 2) == 0 ? sEnvelope.MinX : dfMidX;
+        asQuadrants[i].MaxX = (i % 2) == 0 ? dfMidX : sEnvelope.MaxX;
+        asQuadrants[i].MinY = (i / 2) == 0 ? sEnvelope.MinY : dfMidY;
+        asQuadrants[i].MaxY = (i / 2) == 0 ? dfMidY : sEnvelope.MaxY;
+    }
+    bool bError = false;
+    for (const auto &sQuadrant : asQuadrants)
+    {
+        GEOSGeom hPiece =
+            GEOSClipByRect_r(hGEOSCtxt, hGEOSGeom, sQuadrant.MinX,
+                             sQuadrant.MinY, sQuadrant.MaxX, sQuadrant.MaxY);
+        if (hPiece == nullptr)
+        {
+            bError = true;
+            break;
+        }
+        if (GEOSisEmpty_r(hGEOSCtxt, hPiece) == 1)
+        {
+            GEOSGeom_destroy_r(hGEOSCtxt, hPiece);
+            continue;
+        }
+        auto poChild = OGRBuildPreparedGeometryTile(hGEOSCtxt, hPiece,
+                                                    sQuadrant, nDepth + 1);
+        if (poChild == nullptr)
+        {
+            bError = true;
+            break;
+        }
+        poTile->apoChildren.push_back(std::move(poChild));
+    }
+    GEOSGeom_destroy_r(hGEOSCtxt, hGEOSGeom);
+    if (bError)
+        return nullptr;
+    return poTile;
+}
+
+/************************************************************************/
+/*                    OGRPreparedGeometryTileIntersects()               */
+/************************************************************************/
+
+/* Returns 1 if intersecting, 0 if not, and -1 if the whole prepared
+ * geometry must be used instead. */
+static int OGRPreparedGeometryTileIntersects(
+    const OGRPreparedGeometryTile &oTile, const GEOSGeom hGEOSOtherGeom,
+    const OGREnvelope &sOtherEnvelope, int &nVisitedLeaves)
+{
+    if (!oTile.sEnvelope.Intersects(sOtherEnvelope))
+        return 0;
+    if (oTile.poPreparedGEOSGeom)
+    {
+        if (++nVisitedLeaves > PREPARED_GEOM_MAX_TILES_PER_QUERY)
+            return -1;
+        const char ret = GEOSPreparedIntersects_r(
+            oTile.hGEOSCtxt, oTile.poPreparedGEOSGeom, hGEOSOtherGeom);
+        return ret == 0 || ret == 1 ? ret : -1;
+    }
+    for (const auto &poChild : oTile.apoChildren)
+    {
+        const int ret = OGRPreparedGeometryTileIntersects(
+            *poChild, hGEOSOtherGeom, sOtherEnvelope, nVisitedLeaves);
+        if (ret != 0)
+            return ret;
+    }
+    return 0;
+}
 #endif
 
 /************************************************************************/
@@ -6331,6 +6465,24 @@ OGRCreatePreparedGeometry(UNUSED_IF_NO_GEOS OGRGeometryH hGeom)
     poPreparedGeom->hGEOSGeom = hGEOSGeom;
     poPreparedGeom->poPreparedGEOSGeom = poPreparedGEOSGeom;
 
+    // Subdivide complex polygonal geometries (e.g. country boundaries), so
+    // that OGRPreparedGeometryIntersects() only has to deal with the
+    // vertices in the neighbourhood of the tested geometry.
+    const int nGEOSType = GEOSGeomTypeId_r(hGEOSCtxt, hGEOSGeom);
+    if ((nGEOSType == GEOS_POLYGON || nGEOSType == GEOS_MULTIPOLYGON) &&
+        GEOSGetNumCoordinates_r(hGEOSCtxt, hGEOSGeom) >
+            PREPARED_GEOM_SUBDIVIDE_THRESHOLD)
+    {
+        GEOSGeom hGEOSGeomClone = GEOSGeom_clone_r(hGEOSCtxt, hGEOSGeom);
+        if (hGEOSGeomClone)
+        {
+            OGREnvelope sEnvelope;
+            poGeom->getEnvelope(&sEnvelope);
+            poPreparedGeom->poRootTile = OGRBuildPreparedGeometryTile(
+                hGEOSCtxt, hGEOSGeomClone, sEnvelope, 0);
+        }
+    }
+
     return poPreparedGeom;
 #else
     return nullptr;
@@ -6351,6 +6503,7 @@ void OGRDestroyPreparedGeometry(
 #if defined(HAVE_GEOS)
     if (hPreparedGeom != nullptr)
     {
+        hPreparedGeom->poRootTile.reset();
         GEOSPreparedGeom_destroy_r(hPreparedGeom->hGEOSCtxt,
                                    hPreparedGeom->poPreparedGEOSGeom);
         GEOSGeom_destroy_r(hPreparedGeom->hGEOSCtxt, hPreparedGeom->hGEOSGeom);
@@ -6385,14 +6538,32 @@ int OGRPreparedGeometryIntersects(
         return FALSE;
     }
 
+    OGREnvelope sOtherEnvelope;
+    if (hPreparedGeom->poRootTile)
+    {
+        poOtherGeom->getEnvelope(&sOtherEnvelope);
+        if (!hPreparedGeom->poRootTile->sEnvelope.Intersects(sOtherEnvelope))
+            return FALSE;
+    }
+
     GEOSGeom hGEOSOtherGeom =
         poOtherGeom->exportToGEOS(hPreparedGeom->hGEOSCtxt);
     if (hGEOSOtherGeom == nullptr)
         return FALSE;
 
-    const bool bRet = CPL_TO_BOOL(GEOSPreparedIntersects_r(
-        hPreparedGeom->hGEOSCtxt, hPreparedGeom->poPreparedGEOSGeom,
-        hGEOSOtherGeom));
+    int nRet = -1;
+    if (hPreparedGeom->poRootTile)
+    {
+        int nVisitedLeaves = 0;
+        nRet = OGRPreparedGeometryTileIntersects(
+            *(hPreparedGeom->poRootTile), hGEOSOtherGeom, sOtherEnvelope,
+            nVisitedLeaves);
+    }
+    const bool bRet =
+        nRet >= 0 ? nRet == 1
+                  : CPL_TO_BOOL(GEOSPreparedIntersects_r(
+                        hPreparedGeom->hGEOSCtxt,
+                        hPreparedGeom->poPreparedGEOSGeom, hGEOSOtherGeom));
     GEOSGeom_destroy_r(hPreparedGeom->hGEOSCtxt, hGEOSOtherGeom);
 
     return bRet;
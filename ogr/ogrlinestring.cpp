@@ -1600,26 +1600,16 @@ OGRErr OGRSimpleCurve::importFromWkb(const unsigned char *pabyData,
     /* -------------------------------------------------------------------- */
     if (OGR_SWAP(eByteOrder))
     {
-        for (size_t i = 0; i < static_cast<size_t>(nPointCount); i++)
-        {
-            CPL_SWAPDOUBLE(&(paoPoints[i].x));
-            CPL_SWAPDOUBLE(&(paoPoints[i].y));
-        }
+        OGRSwapDoubleArray(paoPoints, 2 * static_cast<size_t>(nPointCount));
 
         if (flags & OGR_G_3D)
         {
-            for (size_t i = 0; i < static_cast<size_t>(nPointCount); i++)
-            {
-                CPL_SWAPDOUBLE(padfZ + i);
-            }
+            OGRSwapDoubleArray(padfZ, nPointCount);
         }
 
         if (flags & OGR_G_MEASURED)
         {
-            for (size_t i = 0; i < static_cast<size_t>(nPointCount); i++)
-            {
-                CPL_SWAPDOUBLE(padfM + i);
-            }
+            OGRSwapDoubleArray(padfM, nPointCount);
         }
     }
 
@@ -1716,12 +1706,8 @@ OGRErr OGRSimpleCurve::exportToWkb(OGRwkbByteOrder eByteOrder,
         const int nCount = CPL_SWAP32(nPointCount);
         memcpy(pabyData + 5, &nCount, 4);
 
-        const size_t nCoords =
-            CoordinateDimension() * static_cast<size_t>(nPointCount);
-        for (size_t i = 0; i < nCoords; i++)
-        {
-            CPL_SWAP64PTR(pabyData + 9 + 8 * i);
-        }
+        OGRSwapDoubleArray(pabyData + 9, CoordinateDimension() *
+                                             static_cast<size_t>(nPointCount));
     }
 
     return OGRERR_NONE;
@@ -2257,27 +2243,12 @@ void OGRSimpleCurve::getEnvelope(OGREnvelope *psEnvelope) const
         return;
     }
 
-    double dfMinX = paoPoints[0].x;
-    double dfMaxX = paoPoints[0].x;
-    double dfMinY = paoPoints[0].y;
-    double dfMaxY = paoPoints[0].y;
-
-    for (int iPoint = 1; iPoint < nPointCount; iPoint++)
-    {
-        if (dfMaxX < paoPoints[iPoint].x)
-            dfMaxX = paoPoints[iPoint].x;
-        if (dfMaxY < paoPoints[iPoint].y)
-            dfMaxY = paoPoints[iPoint].y;
-        if (dfMinX > paoPoints[iPoint].x)
-            dfMinX = paoPoints[iPoint].x;
-        if (dfMinY > paoPoints[iPoint].y)
-            dfMinY = paoPoints[iPoint].y;
-    }
-
-    psEnvelope->MinX = dfMinX;
-    psEnvelope->MaxX = dfMaxX;
-    psEnvelope->MinY = dfMinY;
-    psEnvelope->MaxY = dfMaxY;
+    psEnvelope->MinX = paoPoints[0].x;
+    psEnvelope->MaxX = paoPoints[0].x;
+    psEnvelope->MinY = paoPoints[0].y;
+    psEnvelope->MaxY = paoPoints[0].y;
+    OGRUpdateEnvelopeXY(*psEnvelope, paoPoints + 1, nPointCount - 1,
+                        sizeof(OGRRawPoint));
 }
 
 /************************************************************************/
@@ -36,6 +36,9 @@
 #include "arrow/io/file.h"
 #include "arrow/io/interfaces.h"
 
+#include <mutex>
+#include <vector>
+
 /************************************************************************/
 /*                        OGRArrowRandomAccessFile                      */
 /************************************************************************/
@@ -45,6 +48,9 @@ class OGRArrowRandomAccessFile final : public arrow::io::RandomAccessFile
     int64_t m_nSize = -1;
     VSILFILE *m_fp;
     bool m_bOwnFP;
+    // Serializes ReadAt() and AdviseRead(), which may be called from
+    // different threads
+    std::mutex m_oMutex{};
 
     OGRArrowRandomAccessFile(const OGRArrowRandomAccessFile &) = delete;
     OGRArrowRandomAccessFile &
@@ -116,6 +122,36 @@ class OGRArrowRandomAccessFile final : public arrow::io::RandomAccessFile
         return buffer;
     }
 
+    arrow::Result<int64_t> ReadAt(int64_t position, int64_t nbytes,
+                                  void *out) override
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        auto status = Seek(position);
+        if (!status.ok())
+            return status;
+        return Read(nbytes, out);
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>>
+    ReadAt(int64_t position, int64_t nbytes) override
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        auto status = Seek(position);
+        if (!status.ok())
+            return status;
+        return Read(nbytes);
+    }
+
+    // Hint that the specified ranges will be read soon. Network file systems
+    // can then fetch them in parallel.
+    void AdviseRead(const std::vector<vsi_l_offset> &anOffsets,
+                    const std::vector<size_t> &anSizes)
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_fp->AdviseRead(static_cast<int>(anOffsets.size()), anOffsets.data(),
+                         anSizes.data());
+    }
+
     arrow::Result<int64_t> GetSize() override
     {
         if (m_nSize < 0)
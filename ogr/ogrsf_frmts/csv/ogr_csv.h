@@ -34,6 +34,7 @@
 #include "ogrsf_frmts.h"
 
 #include <set>
+#include <string>
 
 typedef enum
 {
@@ -151,6 +152,13 @@ class OGRCSVLayer final : public IOGRCSVLayer, public OGRLayer
 
     static bool Matches(const char *pszFieldName, char **papszPossibleNames);
 
+    // Bytes read ahead by GetNextArrowArray(), starting at file offset
+    // m_nArrowReadBufferOffset.
+    std::string m_osArrowReadBuffer{};
+    vsi_l_offset m_nArrowReadBufferOffset = 0;
+
+    bool CanUseNativeArrowStream();
+
   public:
     OGRCSVLayer(const char *pszName, VSILFILE *fp, int nMaxLineSize,
                 const char *pszFilename, int bNew, int bInWriteMode,
@@ -217,6 +225,8 @@ class OGRCSVLayer final : public IOGRCSVLayer, public OGRLayer
     void ResetReading() override;
     OGRFeature *GetNextFeature() override;
     virtual OGRFeature *GetFeature(GIntBig nFID) override;
+    int GetNextArrowArray(struct ArrowArrayStream *,
+                          struct ArrowArray *out_array) override;
 
     OGRFeatureDefn *GetLayerDefn() override
     {
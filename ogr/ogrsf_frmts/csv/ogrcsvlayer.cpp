@@ -40,7 +40,9 @@
 #include <fcntl.h>
 #endif
 #include <algorithm>
+#include <deque>
 #include <limits>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -49,12 +51,14 @@
 #include "cpl_error.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
 #include "ogr_geometry.h"
 #include "ogr_p.h"
 #include "ogr_spatialref.h"
+#include "ograrrowarrayhelper.h"
 #include "ogrsf_frmts.h"
 
 #define DIGIT_ZERO '0'
@@ -1290,6 +1294,8 @@ void OGRCSVLayer::ResetReading()
     bNeedRewindBeforeRead = false;
 
     nNextFID = 1;
+
+    m_osArrowReadBuffer.clear();
 }
 
 /************************************************************************/
@@ -1338,6 +1344,42 @@ OGRFeature *OGRCSVLayer::GetFeature(GIntBig nFID)
     return GetNextUnfilteredFeature();
 }
 
+/************************************************************************/
+/*                   OGRCSVCreateGeometryFromString()                   */
+/*                                                                      */
+/*      Parse the value of a geometry column, which may be WKT,         */
+/*      GeoJSON or HexEWKB. poSRS is only assigned to WKT geometries.   */
+/************************************************************************/
+
+static OGRGeometry *
+OGRCSVCreateGeometryFromString(const char *pszStr,
+                               const OGRSpatialReference *poSRS)
+{
+    while (*pszStr == ' ')
+        pszStr++;
+    OGRGeometry *poGeom = nullptr;
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    if (OGRGeometryFactory::createFromWkt(pszStr, nullptr, &poGeom) ==
+        OGRERR_NONE)
+    {
+        poGeom->assignSpatialReference(poSRS);
+    }
+    else if (*pszStr == '{')
+    {
+        poGeom =
+            OGRGeometry::FromHandle(OGR_G_CreateGeometryFromJson(pszStr));
+    }
+    else if ((*pszStr >= '0' && *pszStr <= '9') ||
+             (*pszStr >= 'a' && *pszStr <= 'z') ||
+             (*pszStr >= 'A' && *pszStr <= 'Z'))
+    {
+        poGeom = OGRGeometryFromHexEWKB(pszStr, nullptr, FALSE);
+    }
+    CPLPopErrorHandler();
+    return poGeom;
+}
+
 /************************************************************************/
 /*                      GetNextUnfilteredFeature()                      */
 /************************************************************************/
@@ -1384,35 +1426,11 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
             if (papszTokens[iAttr][0] != '\0' &&
                 !(poFeatureDefn->GetGeomFieldDefn(iGeom)->IsIgnored()))
             {
-                const char *pszStr = papszTokens[iAttr];
-                while (*pszStr == ' ')
-                    pszStr++;
-                OGRGeometry *poGeom = nullptr;
-
-                CPLPushErrorHandler(CPLQuietErrorHandler);
-                if (OGRGeometryFactory::createFromWkt(pszStr, nullptr,
-                                                      &poGeom) == OGRERR_NONE)
-                {
-                    poGeom->assignSpatialReference(
-                        poFeatureDefn->GetGeomFieldDefn(iGeom)
-                            ->GetSpatialRef());
-                    poFeature->SetGeomFieldDirectly(iGeom, poGeom);
-                }
-                else if (*pszStr == '{' &&
-                         (poGeom = OGRGeometry::FromHandle(
-                              OGR_G_CreateGeometryFromJson(pszStr))) != nullptr)
-                {
-                    poFeature->SetGeomFieldDirectly(iGeom, poGeom);
-                }
-                else if (((*pszStr >= '0' && *pszStr <= '9') ||
-                          (*pszStr >= 'a' && *pszStr <= 'z') ||
-                          (*pszStr >= 'A' && *pszStr <= 'Z')) &&
-                         (poGeom = OGRGeometryFromHexEWKB(pszStr, nullptr,
-                                                          FALSE)) != nullptr)
-                {
+                OGRGeometry *poGeom = OGRCSVCreateGeometryFromString(
+                    papszTokens[iAttr],
+                    poFeatureDefn->GetGeomFieldDefn(iGeom)->GetSpatialRef());
+                if (poGeom)
                     poFeature->SetGeomFieldDirectly(iGeom, poGeom);
-                }
-                CPLPopErrorHandler();
             }
             if (!bKeepGeomColumns || (iAttr == 0 && bHiddenWKTColumn))
                 continue;
@@ -1717,6 +1735,1072 @@ OGRFeature *OGRCSVLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                      CanUseNativeArrowStream()                       */
+/*                                                                      */
+/*      Whether GetNextArrowArray() can decode records directly into    */
+/*      Arrow buffers. Particular datasources (NFDC, GNIS, Eurostat),   */
+/*      KEEP_SOURCE_FIELDS and field types needing more elaborate       */
+/*      parsing than numbers and strings use the generic                */
+/*      implementation.                                                 */
+/************************************************************************/
+
+bool OGRCSVLayer::CanUseNativeArrowStream()
+{
+    if (m_poAttrQuery != nullptr || bInWriteMode || bIsEurostatTSV ||
+        !bHonourStrings || iNfdcLatitudeS != -1 || iNfdcLongitudeS != -1 ||
+        m_bIsGNIS || bKeepSourceColumns ||
+        CPLTestBool(CPLGetConfigOption("OGR_CSV_STREAM_BASE_IMPL", "NO")))
+    {
+        return false;
+    }
+    for (int i = 0; i < poFeatureDefn->GetFieldCount(); ++i)
+    {
+        const auto poFieldDefn = poFeatureDefn->GetFieldDefn(i);
+        const auto eType = poFieldDefn->GetType();
+        if (poFieldDefn->GetSubType() != OFSTNone ||
+            !poFieldDefn->IsNullable() ||
+            (eType != OFTString && eType != OFTInteger &&
+             eType != OFTInteger64 && eType != OFTReal))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace
+{
+
+/************************************************************************/
+/*                         OGRCSVRecordReader                           */
+/*                                                                      */
+/*      Splits the content of a CSV file into records, with the same    */
+/*      logic as CSVReadParseLine3L(): lines are terminated by \n, \r,  */
+/*      \r\n or \n\r, are truncated at the first nul character, and     */
+/*      are joined (with \n) as long as the number of double quotes     */
+/*      is odd.                                                         */
+/************************************************************************/
+
+struct OGRCSVRecord
+{
+    size_t nStartPos = 0;  // position of the first line in the buffer
+    size_t nOffset = 0;    // position of the content in the buffer
+    size_t nLen = 0;
+    int iJoined = -1;  // index in aosJoined if spanning several lines
+};
+
+struct OGRCSVRecordReader
+{
+    VSILFILE *fp = nullptr;
+    std::string &osBuffer;
+    size_t nMaxLineSize = 0;  // 0 = unlimited
+    bool bEOF = false;
+
+    OGRCSVRecordReader(VSILFILE *fpIn, std::string &osBufferIn,
+                       int nMaxLineSizeIn)
+        : fp(fpIn), osBuffer(osBufferIn),
+          nMaxLineSize(nMaxLineSizeIn > 0 ? nMaxLineSizeIn : 0)
+    {
+    }
+
+    bool ReadMore()
+    {
+        constexpr size_t CHUNK_SIZE = 1024 * 1024;
+        if (bEOF)
+            return false;
+        const size_t nOldSize = osBuffer.size();
+        try
+        {
+            osBuffer.resize(nOldSize + CHUNK_SIZE);
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory, "Out of memory");
+            bEOF = true;
+            return false;
+        }
+        const size_t nRead = VSIFReadL(&osBuffer[nOldSize], 1, CHUNK_SIZE, fp);
+        osBuffer.resize(nOldSize + nRead);
+        if (nRead < CHUNK_SIZE)
+            bEOF = true;
+        return nRead > 0;
+    }
+
+    // Returns 1 if a line has been read, 0 at end of file and -1 on error.
+    int ReadLine(size_t &nPos, size_t &nLineOffset, size_t &nLineLen)
+    {
+        size_t i = nPos;
+        while (true)
+        {
+            const char *pszBuffer = osBuffer.data();
+            const size_t nSize = osBuffer.size();
+            while (i < nSize && pszBuffer[i] != '\n' && pszBuffer[i] != '\r')
+                ++i;
+            if (nMaxLineSize > 0 && i - nPos >= nMaxLineSize)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Maximum number of characters allowed reached.");
+                return -1;
+            }
+            // We need the character following the end of line to detect
+            // \r\n and \n\r sequences.
+            if (i < nSize && (i + 1 < nSize || bEOF))
+                break;
+            if (!ReadMore() && i == osBuffer.size())
+                break;
+        }
+
+        const char *pszBuffer = osBuffer.data();
+        const size_t nSize = osBuffer.size();
+        if (i == nPos && i == nSize)
+            return 0;
+
+        nLineOffset = nPos;
+        const void *pNulChar = memchr(pszBuffer + nPos, 0, i - nPos);
+        nLineLen = pNulChar ? static_cast<const char *>(pNulChar) -
+                                  (pszBuffer + nPos)
+                            : i - nPos;
+        if (i + 1 < nSize &&
+            ((pszBuffer[i] == '\r' && pszBuffer[i + 1] == '\n') ||
+             (pszBuffer[i] == '\n' && pszBuffer[i + 1] == '\r')))
+            nPos = i + 2;
+        else
+            nPos = std::min(i + 1, nSize);
+        return 1;
+    }
+
+    // Returns 1 if a non-empty record has been read, 0 at end of file and
+    // -1 on error.
+    int ReadRecord(size_t &nPos, OGRCSVRecord &sRecord,
+                   std::deque<std::string> &aosJoined)
+    {
+        while (true)
+        {
+            sRecord.nStartPos = nPos;
+            size_t nOffset = 0;
+            size_t nLen = 0;
+            const int nRet = ReadLine(nPos, nOffset, nLen);
+            if (nRet <= 0)
+                return nRet;
+
+            const char *pszLine = osBuffer.data() + nOffset;
+            if (nLen >= 3 && static_cast<GByte>(pszLine[0]) == 0xEF &&
+                static_cast<GByte>(pszLine[1]) == 0xBB &&
+                static_cast<GByte>(pszLine[2]) == 0xBF)
+            {
+                nOffset += 3;
+                nLen -= 3;
+                pszLine += 3;
+            }
+            // Empty lines are skipped, as in GetNextLineTokens()
+            if (nLen == 0)
+                continue;
+
+            sRecord.nOffset = nOffset;
+            sRecord.nLen = nLen;
+            sRecord.iJoined = -1;
+
+            size_t nQuotes = static_cast<size_t>(
+                std::count(pszLine, pszLine + nLen, '\"'));
+            if ((nQuotes % 2) == 0)
+                return 1;
+
+            std::string osRecord(pszLine, nLen);
+            while ((nQuotes % 2) != 0)
+            {
+                const int nRetNext = ReadLine(nPos, nOffset, nLen);
+                if (nRetNext < 0)
+                    return -1;
+                if (nRetNext == 0)
+                    break;
+                pszLine = osBuffer.data() + nOffset;
+                osRecord += '\n';
+                osRecord.append(pszLine, nLen);
+                nQuotes += static_cast<size_t>(
+                    std::count(pszLine, pszLine + nLen, '\"'));
+            }
+            sRecord.iJoined = static_cast<int>(aosJoined.size());
+            sRecord.nLen = osRecord.size();
+            aosJoined.emplace_back(std::move(osRecord));
+            return 1;
+        }
+    }
+};
+
+/************************************************************************/
+/*                         OGRCSVSplitRecord()                          */
+/*                                                                      */
+/*      Same as CSVSplitLine() (with bKeepLeadingAndClosingQuotes =     */
+/*      false), but with tokens stored as consecutive nul-terminated    */
+/*      strings in osTokens.                                            */
+/************************************************************************/
+
+static void OGRCSVSplitRecord(const char *pszRecord, size_t nLen,
+                              char chDelimiter, bool bMergeDelimiter,
+                              std::string &osTokens,
+                              std::vector<size_t> &anTokenOffsets)
+{
+    osTokens.clear();
+    anTokenOffsets.clear();
+    size_t i = 0;
+    while (i < nLen)
+    {
+        bool bInString = false;
+        size_t nTokenLen = 0;
+        anTokenOffsets.push_back(osTokens.size());
+        do
+        {
+            const char ch = pszRecord[i];
+            if (!bInString && ch == chDelimiter)
+            {
+                ++i;
+                if (bMergeDelimiter)
+                {
+                    while (i < nLen && pszRecord[i] == chDelimiter)
+                        ++i;
+                }
+                break;
+            }
+
+            if (ch == '"')
+            {
+                if (!bInString && nTokenLen > 0)
+                {
+                    // do not treat in a special way double quotes that
+                    // appear in the middle of a field
+                }
+                else if (!bInString || i + 1 == nLen ||
+                         pszRecord[i + 1] != '"')
+                {
+                    bInString = !bInString;
+                    continue;
+                }
+                else  // Doubled quotes in string resolve to one quote.
+                {
+                    ++i;
+                }
+            }
+
+            osTokens += pszRecord[i];
+            ++nTokenLen;
+        } while (++i < nLen);
+        osTokens += '\0';
+
+        // If the last token is an empty token, then we have to catch
+        // it now, otherwise we won't reenter the loop and it will be lost.
+        if (i == nLen && pszRecord[nLen - 1] == chDelimiter)
+        {
+            anTokenOffsets.push_back(osTokens.size());
+            osTokens += '\0';
+        }
+    }
+}
+
+/************************************************************************/
+/*                         OGRCSVArrowContext                           */
+/************************************************************************/
+
+struct OGRCSVArrowWarning
+{
+    int iRow = 0;
+    // Whether this is a warning subject to bWarningBadTypeOrWidth
+    bool bOnce = false;
+    std::string osMsg{};
+};
+
+struct OGRCSVArrowContext
+{
+    OGRFeatureDefn *poFeatureDefn = nullptr;
+    struct ArrowArray *psArray = nullptr;
+    const std::vector<int> *panFieldToArrowField = nullptr;
+    const std::vector<int> *panGeomFieldToArrowField = nullptr;
+
+    // For each CSV column, index of the geometry field it holds, or -1
+    std::vector<int> anColumnGeomField{};
+    // For each CSV column, index of the attribute field it holds, or -1
+    std::vector<int> anColumnField{};
+
+    std::vector<std::pair<const char *, size_t>> asRecords{};
+
+    char chDelimiter = ',';
+    bool bMergeDelimiter = false;
+    bool bEmptyStringNull = false;
+    bool bNumericWarning = true;
+    int iLongitudeField = -1;
+    int iLatitudeField = -1;
+    int iZField = -1;
+    GIntBig nFirstFID = 0;
+    uint32_t nMemLimit = 0;
+};
+
+/************************************************************************/
+/*                           OGRCSVArrowJob                             */
+/*                                                                      */
+/*      Decodes the records [iRowStart, iRowEnd[ of a batch. Values of  */
+/*      fixed-size types, validity bits and string offsets (relative to */
+/*      the start of the job) are written directly into the Arrow       */
+/*      buffers: jobs cover a multiple of 8 rows, so they never write   */
+/*      into the same byte. Variable-size content is accumulated in     */
+/*      aosVarData and assembled by the caller.                         */
+/************************************************************************/
+
+struct OGRCSVArrowJob
+{
+    const OGRCSVArrowContext *psCtxt = nullptr;
+    int iRowStart = 0;
+    int iRowEnd = 0;
+    int nRowsDone = 0;
+    std::vector<std::string> aosVarData{};  // indexed by Arrow field
+    std::vector<OGRCSVArrowWarning> asWarnings{};
+
+    void Run();
+
+  private:
+    bool bHasOnceWarning = false;
+
+    void AddWarning(int iRow, bool bOnce, const char *pszMsg)
+    {
+        if (bOnce)
+        {
+            if (bHasOnceWarning)
+                return;
+            bHasOnceWarning = true;
+        }
+        OGRCSVArrowWarning sWarning;
+        sWarning.iRow = iRow;
+        sWarning.bOnce = bOnce;
+        sWarning.osMsg = pszMsg;
+        asWarnings.emplace_back(std::move(sWarning));
+    }
+
+    void SetNull(int iArrowField, int iRow)
+    {
+        auto psChild = psCtxt->psArray->children[iArrowField];
+        uint8_t *pabyValidity =
+            static_cast<uint8_t *>(const_cast<void *>(psChild->buffers[0]));
+        pabyValidity[iRow / 8] &= static_cast<uint8_t>(~(1 << (iRow % 8)));
+        if (psChild->n_buffers == 3)
+            SetVarSizeEnd(iArrowField, iRow);
+    }
+
+    void SetVarSizeEnd(int iArrowField, int iRow)
+    {
+        auto psChild = psCtxt->psArray->children[iArrowField];
+        static_cast<int32_t *>(const_cast<void *>(psChild->buffers[1]))
+            [iRow + 1] = static_cast<int32_t>(aosVarData[iArrowField].size());
+    }
+
+    void SetField(int iField, int iArrowField, int iRow, char *pszToken);
+
+    static void AppendPointWKB(std::string &osWKB, double dfX, double dfY,
+                               const double *pdfZ);
+};
+
+/************************************************************************/
+/*                      OGRCSVArrowJob::SetField()                      */
+/*                                                                      */
+/*      Same logic as GetNextUnfilteredFeature() followed by            */
+/*      OGRFeature::SetField(int, const char*), except that warnings    */
+/*      are deferred.                                                   */
+/************************************************************************/
+
+void OGRCSVArrowJob::SetField(int iField, int iArrowField, int iRow,
+                              char *pszToken)
+{
+    const auto &sCtxt = *psCtxt;
+    const auto poFieldDefn = sCtxt.poFeatureDefn->GetFieldDefn(iField);
+    const auto eFieldType = poFieldDefn->GetType();
+    const int nRecord = static_cast<int>(sCtxt.nFirstFID + iRow);
+    auto psChild = sCtxt.psArray->children[iArrowField];
+
+    if (eFieldType == OFTString)
+    {
+        if (pszToken == nullptr ||
+            (sCtxt.bEmptyStringNull && pszToken[0] == '\0'))
+        {
+            SetNull(iArrowField, iRow);
+            return;
+        }
+        const size_t nLen = strlen(pszToken);
+        aosVarData[iArrowField].append(pszToken, nLen);
+        SetVarSizeEnd(iArrowField, iRow);
+        if (poFieldDefn->GetWidth() > 0 &&
+            static_cast<int>(nLen) > poFieldDefn->GetWidth())
+        {
+            AddWarning(iRow, true,
+                       CPLSPrintf("Value with a width greater than field width "
+                                  "found in record %d for field %s. "
+                                  "This warning will no longer be emitted",
+                                  nRecord, poFieldDefn->GetNameRef()));
+        }
+        return;
+    }
+
+    if (pszToken == nullptr || pszToken[0] == '\0')
+    {
+        SetNull(iArrowField, iRow);
+        return;
+    }
+
+    if (eFieldType == OFTReal)
+    {
+        char *chComma = strchr(pszToken, ',');
+        if (chComma)
+            *chComma = '.';
+    }
+    const CPLValueType eType = CPLGetValueType(pszToken);
+    if (eType != CPL_VALUE_INTEGER && eType != CPL_VALUE_REAL)
+    {
+        SetNull(iArrowField, iRow);
+        AddWarning(iRow, true,
+                   CPLSPrintf("Invalid value type found in record %d for field "
+                              "%s. This warning will no longer be emitted.",
+                              nRecord, poFieldDefn->GetNameRef()));
+        return;
+    }
+
+    char *pszLast = nullptr;
+    if (eFieldType == OFTInteger)
+    {
+        errno = 0;
+        const long long nVal64 = std::strtoll(pszToken, &pszLast, 10);
+        const int nVal32 = nVal64 > INT_MAX   ? INT_MAX
+                           : nVal64 < INT_MIN ? INT_MIN
+                                              : static_cast<int>(nVal64);
+        OGRArrowArrayHelper::SetInt32(psChild, iRow, nVal32);
+        if (sCtxt.bNumericWarning &&
+            (errno == ERANGE || nVal32 != nVal64 || *pszLast))
+        {
+            AddWarning(iRow, false,
+                       CPLSPrintf("Value '%s' of field %s.%s parsed "
+                                  "incompletely to integer %d.",
+                                  pszToken, sCtxt.poFeatureDefn->GetName(),
+                                  poFieldDefn->GetNameRef(), nVal32));
+        }
+    }
+    else if (eFieldType == OFTInteger64)
+    {
+        int bOverflow = FALSE;
+        OGRArrowArrayHelper::SetInt64(
+            psChild, iRow, CPLAtoGIntBigEx(pszToken, FALSE, &bOverflow));
+        if (sCtxt.bNumericWarning && bOverflow)
+        {
+            AddWarning(iRow, false,
+                       CPLSPrintf("64 bit integer overflow when converting %s",
+                                  pszToken));
+        }
+    }
+    else
+    {
+        const double dfVal = CPLStrtod(pszToken, &pszLast);
+        OGRArrowArrayHelper::SetDouble(psChild, iRow, dfVal);
+        if (sCtxt.bNumericWarning && *pszLast)
+        {
+            AddWarning(iRow, false,
+                       CPLSPrintf("Value '%s' of field %s.%s parsed "
+                                  "incompletely to real %.16g.",
+                                  pszToken, sCtxt.poFeatureDefn->GetName(),
+                                  poFieldDefn->GetNameRef(), dfVal));
+        }
+    }
+
+    if ((eFieldType == OFTInteger || eFieldType == OFTInteger64) &&
+        eType == CPL_VALUE_REAL)
+    {
+        AddWarning(iRow, true,
+                   CPLSPrintf("Invalid value type found in record %d for "
+                              "field %s. "
+                              "This warning will no longer be emitted",
+                              nRecord, poFieldDefn->GetNameRef()));
+    }
+    else if (poFieldDefn->GetWidth() > 0 &&
+             static_cast<int>(strlen(pszToken)) > poFieldDefn->GetWidth())
+    {
+        AddWarning(iRow, true,
+                   CPLSPrintf("Value with a width greater than field width "
+                              "found in record %d for field %s. "
+                              "This warning will no longer be emitted",
+                              nRecord, poFieldDefn->GetNameRef()));
+    }
+    else if (eType == CPL_VALUE_REAL && poFieldDefn->GetWidth() > 0)
+    {
+        const char *pszDot = strchr(pszToken, '.');
+        const int nPrecision =
+            pszDot != nullptr ? static_cast<int>(strlen(pszDot + 1)) : 0;
+        if (nPrecision > poFieldDefn->GetPrecision())
+        {
+            AddWarning(iRow, true,
+                       CPLSPrintf("Value with a precision greater than "
+                                  "field precision found in record %d for "
+                                  "field %s. "
+                                  "This warning will no longer be emitted",
+                                  nRecord, poFieldDefn->GetNameRef()));
+        }
+    }
+}
+
+/************************************************************************/
+/*                   OGRCSVArrowJob::AppendPointWKB()                   */
+/************************************************************************/
+
+void OGRCSVArrowJob::AppendPointWKB(std::string &osWKB, double dfX,
+                                    double dfY, const double *pdfZ)
+{
+    GByte abyWKB[1 + sizeof(uint32_t) + 3 * sizeof(double)];
+    abyWKB[0] = static_cast<GByte>(wkbNDR);
+    uint32_t nType = pdfZ ? wkbPoint + 1000 : wkbPoint;
+    CPL_LSBPTR32(&nType);
+    memcpy(abyWKB + 1, &nType, sizeof(nType));
+    size_t nOffset = 1 + sizeof(uint32_t);
+    for (double dfVal : {dfX, dfY, pdfZ ? *pdfZ : 0.0})
+    {
+        CPL_LSBPTR64(&dfVal);
+        memcpy(abyWKB + nOffset, &dfVal, sizeof(dfVal));
+        nOffset += sizeof(dfVal);
+    }
+    osWKB.append(reinterpret_cast<const char *>(abyWKB),
+                 pdfZ ? nOffset : nOffset - sizeof(double));
+}
+
+/************************************************************************/
+/*                        OGRCSVArrowJob::Run()                         */
+/************************************************************************/
+
+void OGRCSVArrowJob::Run()
+{
+    const auto &sCtxt = *psCtxt;
+    const int nColumns = static_cast<int>(sCtxt.anColumnField.size());
+    const int nGeomFields = sCtxt.poFeatureDefn->GetGeomFieldCount();
+    const int iPointArrowField =
+        sCtxt.iLongitudeField >= 0 && sCtxt.iLatitudeField >= 0
+            ? (*sCtxt.panGeomFieldToArrowField)[0]
+            : -1;
+
+    // Is it a numeric value parsable by local-aware CPLAtofM()
+    const auto IsCPLAtofMParsable = [](char *pszVal)
+    {
+        auto l_eType = CPLGetValueType(pszVal);
+        if (l_eType == CPL_VALUE_INTEGER || l_eType == CPL_VALUE_REAL)
+            return true;
+        char *pszComma = strchr(pszVal, ',');
+        if (pszComma)
+        {
+            *pszComma = '.';
+            l_eType = CPLGetValueType(pszVal);
+            *pszComma = ',';
+        }
+        return l_eType == CPL_VALUE_REAL;
+    };
+
+    std::string osTokens;
+    std::vector<size_t> anTokenOffsets;
+    std::vector<char *> apszTokens;
+    std::vector<std::unique_ptr<OGRGeometry>> apoGeoms(nGeomFields);
+
+    for (int iRow = iRowStart; iRow < iRowEnd; ++iRow)
+    {
+        const auto &sRecord = sCtxt.asRecords[iRow];
+        OGRCSVSplitRecord(sRecord.first, sRecord.second, sCtxt.chDelimiter,
+                          sCtxt.bMergeDelimiter, osTokens, anTokenOffsets);
+        apszTokens.clear();
+        for (size_t nOffset : anTokenOffsets)
+            apszTokens.push_back(&osTokens[nOffset]);
+        const int nAttrCount =
+            std::min(static_cast<int>(apszTokens.size()), nColumns);
+
+        for (int iAttr = 0; iAttr < nColumns; ++iAttr)
+        {
+            char *pszToken = iAttr < nAttrCount ? apszTokens[iAttr] : nullptr;
+            const int iGeom = sCtxt.anColumnGeomField[iAttr];
+            if (iGeom >= 0 && pszToken != nullptr && pszToken[0] != '\0' &&
+                (*sCtxt.panGeomFieldToArrowField)[iGeom] >= 0)
+            {
+                apoGeoms[iGeom].reset(
+                    OGRCSVCreateGeometryFromString(pszToken, nullptr));
+            }
+
+            const int iField = sCtxt.anColumnField[iAttr];
+            if (iField >= 0)
+            {
+                const int iArrowField = (*sCtxt.panFieldToArrowField)[iField];
+                if (iArrowField >= 0)
+                    SetField(iField, iArrowField, iRow, pszToken);
+            }
+        }
+
+        bool bPointSet = false;
+        if (iPointArrowField >= 0 && nAttrCount > sCtxt.iLatitudeField &&
+            nAttrCount > sCtxt.iLongitudeField &&
+            apszTokens[sCtxt.iLongitudeField][0] != 0 &&
+            apszTokens[sCtxt.iLatitudeField][0] != 0 &&
+            IsCPLAtofMParsable(apszTokens[sCtxt.iLongitudeField]) &&
+            IsCPLAtofMParsable(apszTokens[sCtxt.iLatitudeField]))
+        {
+            const double dfLon = CPLAtofM(apszTokens[sCtxt.iLongitudeField]);
+            const double dfLat = CPLAtofM(apszTokens[sCtxt.iLatitudeField]);
+            if (sCtxt.iZField != -1 && nAttrCount > sCtxt.iZField &&
+                apszTokens[sCtxt.iZField][0] != 0 &&
+                IsCPLAtofMParsable(apszTokens[sCtxt.iZField]))
+            {
+                const double dfZ = CPLAtofM(apszTokens[sCtxt.iZField]);
+                AppendPointWKB(aosVarData[iPointArrowField], dfLon, dfLat,
+                               &dfZ);
+            }
+            else
+            {
+                AppendPointWKB(aosVarData[iPointArrowField], dfLon, dfLat,
+                               nullptr);
+            }
+            SetVarSizeEnd(iPointArrowField, iRow);
+            bPointSet = true;
+        }
+
+        for (int iGeom = 0; iGeom < nGeomFields; ++iGeom)
+        {
+            const int iArrowField = (*sCtxt.panGeomFieldToArrowField)[iGeom];
+            if (iArrowField < 0 ||
+                (bPointSet && iArrowField == iPointArrowField))
+                continue;
+            if (apoGeoms[iGeom])
+            {
+                auto &osWKB = aosVarData[iArrowField];
+                const size_t nOldSize = osWKB.size();
+                osWKB.resize(nOldSize + apoGeoms[iGeom]->WkbSize());
+                apoGeoms[iGeom]->exportToWkb(
+                    wkbNDR, reinterpret_cast<GByte *>(&osWKB[nOldSize]),
+                    wkbVariantIso);
+                SetVarSizeEnd(iArrowField, iRow);
+                apoGeoms[iGeom].reset();
+            }
+            else
+            {
+                SetNull(iArrowField, iRow);
+            }
+        }
+
+        // Stop before exceeding the memory limit. The caller will cut the
+        // batch at this row.
+        for (const auto &osData : aosVarData)
+        {
+            if (osData.size() > sCtxt.nMemLimit)
+                return;
+        }
+        nRowsDone = iRow + 1 - iRowStart;
+    }
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                         GetNextArrowArray()                          */
+/*                                                                      */
+/*      Split the file into records in the calling thread, and decode   */
+/*      them directly into the Arrow buffers, in several threads for    */
+/*      large enough batches.                                           */
+/************************************************************************/
+
+int OGRCSVLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
+                                   struct ArrowArray *out_array)
+{
+    if (!CanUseNativeArrowStream())
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+
+    // Check that each attribute field is read from one single column.
+    OGRCSVArrowContext sCtxt;
+    const int nColumns = nCSVFieldCount + (bHiddenWKTColumn ? 1 : 0);
+    {
+        std::vector<int> anFieldColumnCount(poFeatureDefn->GetFieldCount());
+        int iOGRField = 0;
+        for (int iAttr = 0; iAttr < nColumns; ++iAttr)
+        {
+            sCtxt.anColumnGeomField.push_back(-1);
+            sCtxt.anColumnField.push_back(-1);
+            if ((iAttr == iLongitudeField || iAttr == iLatitudeField ||
+                 iAttr == iZField) &&
+                !bKeepGeomColumns)
+            {
+                continue;
+            }
+            int iGeom = 0;
+            if (bHiddenWKTColumn)
+            {
+                if (iAttr != 0)
+                    iGeom = panGeomFieldIndex[iAttr - 1];
+            }
+            else
+            {
+                iGeom = panGeomFieldIndex[iAttr];
+            }
+            if (iGeom >= 0)
+            {
+                sCtxt.anColumnGeomField.back() = iGeom;
+                if (!bKeepGeomColumns || (iAttr == 0 && bHiddenWKTColumn))
+                    continue;
+            }
+            if (iOGRField >= poFeatureDefn->GetFieldCount())
+                return OGRLayer::GetNextArrowArray(stream, out_array);
+            sCtxt.anColumnField.back() = iOGRField;
+            anFieldColumnCount[iOGRField]++;
+            iOGRField++;
+        }
+        for (int nCount : anFieldColumnCount)
+        {
+            if (nCount != 1)
+                return OGRLayer::GetNextArrowArray(stream, out_array);
+        }
+    }
+
+    struct ArrowSchema schema;
+    memset(&schema, 0, sizeof(schema));
+    if (m_poFilterGeom != nullptr)
+    {
+        if (poFeatureDefn->GetGeomFieldDefn(m_iGeomFieldFilter)->IsIgnored() ||
+            stream->get_schema(stream, &schema) != 0)
+        {
+            return OGRLayer::GetNextArrowArray(stream, out_array);
+        }
+        if (!CanPostFilterArrowArray(&schema))
+        {
+            schema.release(&schema);
+            return OGRLayer::GetNextArrowArray(stream, out_array);
+        }
+    }
+
+    if (bNeedRewindBeforeRead)
+        ResetReading();
+
+    const uint32_t nMemLimit = OGRArrowArrayHelper::GetMemLimit();
+    const bool bNumericWarning = CPLTestBool(
+        CPLGetConfigOption("OGR_SETFIELD_NUMERIC_WARNING", "YES"));
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    const int nThreads =
+        pszNumThreads == nullptr ? std::min(4, CPLGetNumCPUs())
+        : EQUAL(pszNumThreads, "ALL_CPUS")
+            ? CPLGetNumCPUs()
+            : std::max(1, std::min(128, atoi(pszNumThreads)));
+    // Below that number of records per job, multithreading is not worth it
+    constexpr int MIN_RECORDS_PER_JOB = 1024;
+
+    const auto ReleaseSchema = [&schema]()
+    {
+        if (schema.release)
+            schema.release(&schema);
+    };
+
+    while (true)
+    {
+        memset(out_array, 0, sizeof(*out_array));
+        if (fpCSV == nullptr)
+            break;
+
+        OGRArrowArrayHelper sHelper(GetDataset(), poFeatureDefn,
+                                    m_aosArrowArrayStreamOptions, out_array);
+        if (out_array->release == nullptr)
+        {
+            ReleaseSchema();
+            return ENOMEM;
+        }
+
+        /* ------------------------------------------------------------ */
+        /*      Collect the records of the batch.                       */
+        /* ------------------------------------------------------------ */
+        const vsi_l_offset nStartOffset = VSIFTellL(fpCSV);
+        if (nStartOffset != m_nArrowReadBufferOffset)
+            m_osArrowReadBuffer.clear();
+        VSIFSeekL(fpCSV, nStartOffset + m_osArrowReadBuffer.size(), SEEK_SET);
+
+        OGRCSVRecordReader oReader(fpCSV, m_osArrowReadBuffer, m_nMaxLineSize);
+        std::vector<OGRCSVRecord> asRecords;
+        std::deque<std::string> aosJoined;
+        size_t nPos = 0;
+        bool bError = false;
+        while (static_cast<int>(asRecords.size()) < sHelper.m_nMaxBatchSize &&
+               nPos <= nMemLimit)
+        {
+            OGRCSVRecord sRecord;
+            const int nRet = oReader.ReadRecord(nPos, sRecord, aosJoined);
+            if (nRet < 0)
+                bError = true;
+            if (nRet <= 0)
+                break;
+            asRecords.push_back(sRecord);
+        }
+        const int nRecords = static_cast<int>(asRecords.size());
+        if (nRecords == 0)
+        {
+            sHelper.ClearArray();
+            if (bError)
+                VSIFSeekL(fpCSV, 0, SEEK_END);
+            m_osArrowReadBuffer.clear();
+            break;
+        }
+
+        sCtxt.poFeatureDefn = poFeatureDefn;
+        sCtxt.psArray = out_array;
+        sCtxt.panFieldToArrowField = &sHelper.m_mapOGRFieldToArrowField;
+        sCtxt.panGeomFieldToArrowField = &sHelper.m_mapOGRGeomFieldToArrowField;
+        sCtxt.chDelimiter = szDelimiter[0];
+        sCtxt.bMergeDelimiter = bMergeDelimiter;
+        sCtxt.bEmptyStringNull = bEmptyStringNull;
+        sCtxt.bNumericWarning = bNumericWarning;
+        sCtxt.iLongitudeField = iLongitudeField;
+        sCtxt.iLatitudeField = iLatitudeField;
+        sCtxt.iZField = iZField;
+        sCtxt.nFirstFID = nNextFID;
+        sCtxt.nMemLimit = nMemLimit;
+        sCtxt.asRecords.clear();
+        for (const auto &sRecord : asRecords)
+        {
+            if (sRecord.iJoined >= 0)
+                sCtxt.asRecords.emplace_back(
+                    aosJoined[sRecord.iJoined].data(), sRecord.nLen);
+            else
+                sCtxt.asRecords.emplace_back(
+                    m_osArrowReadBuffer.data() + sRecord.nOffset,
+                    sRecord.nLen);
+        }
+
+        // All values may be null
+        const int iFirstField = sHelper.m_bIncludeFID ? 1 : 0;
+        for (int i = iFirstField; i < sHelper.m_nChildren; ++i)
+        {
+            auto psChild = out_array->children[i];
+            const size_t nSize = (sHelper.m_nMaxBatchSize + 7) / 8;
+            void *pabyValidity = VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nSize);
+            if (pabyValidity == nullptr)
+            {
+                sHelper.ClearArray();
+                ReleaseSchema();
+                return ENOMEM;
+            }
+            memset(pabyValidity, 0xFF, nSize);
+            psChild->buffers[0] = pabyValidity;
+        }
+
+        /* ------------------------------------------------------------ */
+        /*      Decode the records.                                     */
+        /* ------------------------------------------------------------ */
+        const int nJobs = std::max(
+            1, std::min(nThreads, nRecords / MIN_RECORDS_PER_JOB));
+        const int nRecordsPerJob =
+            ((nRecords + nJobs - 1) / nJobs + 7) / 8 * 8;
+        std::vector<OGRCSVArrowJob> asJobs;
+        try
+        {
+            for (int iRow = 0; iRow < nRecords; iRow += nRecordsPerJob)
+            {
+                OGRCSVArrowJob sJob;
+                sJob.psCtxt = &sCtxt;
+                sJob.iRowStart = iRow;
+                sJob.iRowEnd = std::min(nRecords, iRow + nRecordsPerJob);
+                sJob.aosVarData.resize(sHelper.m_nChildren);
+                asJobs.emplace_back(std::move(sJob));
+            }
+
+            auto poPool = asJobs.size() > 1
+                              ? GDALGetGlobalThreadPool(
+                                    static_cast<int>(asJobs.size()))
+                              : nullptr;
+            auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+            const auto JobFunc = [](void *pData)
+            { static_cast<OGRCSVArrowJob *>(pData)->Run(); };
+            for (auto &sJob : asJobs)
+            {
+                if (!poQueue || !poQueue->SubmitJob(JobFunc, &sJob))
+                    sJob.Run();
+            }
+            if (poQueue)
+                poQueue->WaitCompletion();
+        }
+        catch (const std::exception &e)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+            sHelper.ClearArray();
+            ReleaseSchema();
+            return ENOMEM;
+        }
+
+        /* ------------------------------------------------------------ */
+        /*      Determine how many rows fit in the memory limit, and    */
+        /*      assemble variable-size content.                         */
+        /* ------------------------------------------------------------ */
+        std::vector<int> anVarFields;
+        for (int i = iFirstField; i < sHelper.m_nChildren; ++i)
+        {
+            if (out_array->children[i]->n_buffers == 3)
+                anVarFields.push_back(i);
+        }
+        const auto GetJobVarSize = [out_array](const OGRCSVArrowJob &sJob,
+                                               int iArrowField, int nRows)
+        {
+            return nRows == 0
+                       ? 0
+                       : static_cast<size_t>(static_cast<const int32_t *>(
+                             out_array->children[iArrowField]
+                                 ->buffers[1])[sJob.iRowStart + nRows]);
+        };
+
+        std::vector<size_t> anVarSize(sHelper.m_nChildren);
+        std::vector<int> anJobRows;
+        int nRows = 0;
+        for (const auto &sJob : asJobs)
+        {
+            int nJobRows = sJob.nRowsDone;
+            for (int iArrowField : anVarFields)
+            {
+                while (nJobRows > 0 &&
+                       anVarSize[iArrowField] +
+                               GetJobVarSize(sJob, iArrowField, nJobRows) >
+                           nMemLimit)
+                {
+                    --nJobRows;
+                }
+            }
+            for (int iArrowField : anVarFields)
+                anVarSize[iArrowField] +=
+                    GetJobVarSize(sJob, iArrowField, nJobRows);
+            anJobRows.push_back(nJobRows);
+            nRows += nJobRows;
+            if (nJobRows < sJob.iRowEnd - sJob.iRowStart)
+                break;
+        }
+
+        if (nRows == 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Too large feature: not even a single feature can be "
+                     "returned");
+            sHelper.ClearArray();
+            ReleaseSchema();
+            VSIFSeekL(fpCSV, 0, SEEK_END);
+            m_osArrowReadBuffer.clear();
+            return ENOMEM;
+        }
+
+        for (int iArrowField : anVarFields)
+        {
+            auto psChild = out_array->children[iArrowField];
+            const size_t nSize = anVarSize[iArrowField];
+            if (nSize > sHelper.m_anArrowFieldMaxAlloc[iArrowField])
+            {
+                void *pNewBuffer = VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nSize);
+                if (pNewBuffer == nullptr)
+                {
+                    sHelper.ClearArray();
+                    ReleaseSchema();
+                    return ENOMEM;
+                }
+                VSIFreeAligned(const_cast<void *>(psChild->buffers[2]));
+                psChild->buffers[2] = pNewBuffer;
+                sHelper.m_anArrowFieldMaxAlloc[iArrowField] =
+                    static_cast<uint32_t>(nSize);
+            }
+            GByte *pabyData =
+                static_cast<GByte *>(const_cast<void *>(psChild->buffers[2]));
+            int32_t *panOffsets =
+                static_cast<int32_t *>(const_cast<void *>(psChild->buffers[1]));
+            size_t nBase = 0;
+            for (size_t iJob = 0; iJob < anJobRows.size(); ++iJob)
+            {
+                const auto &sJob = asJobs[iJob];
+                const int nJobRows = anJobRows[iJob];
+                const size_t nJobSize =
+                    GetJobVarSize(sJob, iArrowField, nJobRows);
+                if (nJobSize)
+                    memcpy(pabyData + nBase,
+                           sJob.aosVarData[iArrowField].data(), nJobSize);
+                for (int i = 1; i <= nJobRows; ++i)
+                    panOffsets[sJob.iRowStart + i] +=
+                        static_cast<int32_t>(nBase);
+                nBase += nJobSize;
+            }
+        }
+
+        for (int i = iFirstField; i < sHelper.m_nChildren; ++i)
+        {
+            auto psChild = out_array->children[i];
+            const GByte *pabyValidity =
+                static_cast<const GByte *>(psChild->buffers[0]);
+            int64_t nNullCount = 0;
+            for (int iRow = 0; iRow < nRows; ++iRow)
+            {
+                if ((pabyValidity[iRow / 8] & (1 << (iRow % 8))) == 0)
+                    ++nNullCount;
+            }
+            psChild->null_count = nNullCount;
+            if (nNullCount == 0)
+            {
+                VSIFreeAligned(const_cast<void *>(psChild->buffers[0]));
+                psChild->buffers[0] = nullptr;
+            }
+        }
+
+        if (sHelper.m_panFIDValues)
+        {
+            for (int iRow = 0; iRow < nRows; ++iRow)
+                sHelper.m_panFIDValues[iRow] = nNextFID + iRow;
+        }
+
+        for (size_t iJob = 0; iJob < anJobRows.size(); ++iJob)
+        {
+            const auto &sJob = asJobs[iJob];
+            for (const auto &sWarning : sJob.asWarnings)
+            {
+                if (sWarning.iRow >= sJob.iRowStart + anJobRows[iJob])
+                    break;
+                if (sWarning.bOnce)
+                {
+                    if (bWarningBadTypeOrWidth)
+                        continue;
+                    bWarningBadTypeOrWidth = true;
+                }
+                CPLError(CE_Warning, CPLE_AppDefined, "%s",
+                         sWarning.osMsg.c_str());
+            }
+        }
+
+        sHelper.Shrink(nRows);
+        nNextFID += nRows;
+        m_nFeaturesRead += nRows;
+
+        // Position the file just after the last returned record, and keep
+        // what has been read beyond for the next batch.
+        if (bError && nRows == nRecords)
+        {
+            VSIFSeekL(fpCSV, 0, SEEK_END);
+            m_osArrowReadBuffer.clear();
+        }
+        else
+        {
+            const size_t nConsumed =
+                nRows == nRecords ? nPos : asRecords[nRows].nStartPos;
+            m_osArrowReadBuffer.erase(0, nConsumed);
+            m_nArrowReadBufferOffset = nStartOffset + nConsumed;
+            VSIFSeekL(fpCSV, m_nArrowReadBufferOffset, SEEK_SET);
+        }
+
+        if (m_poFilterGeom != nullptr)
+        {
+            PostFilterArrowArray(&schema, out_array, nullptr);
+            if (out_array->release == nullptr)
+            {
+                ReleaseSchema();
+                return ENOMEM;
+            }
+        }
+
+        if (out_array->length != 0)
+            break;
+
+        // Everything has been filtered out: try with the next records
+        out_array->release(out_array);
+    }
+
+    ReleaseSchema();
+    return 0;
+}
+
 /************************************************************************/
 /*                           TestCapability()                           */
 /************************************************************************/
@@ -1739,6 +2823,8 @@ int OGRCSVLayer::TestCapability(const char *pszCap)
         return TRUE;
     else if (EQUAL(pszCap, OLCZGeometries))
         return TRUE;
+    else if (EQUAL(pszCap, OLCFastGetArrowStream))
+        return CanUseNativeArrowStream();
     else
         return FALSE;
 }
@@ -29,6 +29,7 @@
 #ifndef OGR_FLATGEOBUF_H_INCLUDED
 #define OGR_FLATGEOBUF_H_INCLUDED
 
+#include "cpl_error_internal.h"
 #include "ogrsf_frmts.h"
 #include "ogr_p.h"
 #include "ogreditablelayer.h"
@@ -39,6 +40,8 @@
 
 #include <deque>
 #include <limits>
+#include <memory>
+#include <vector>
 
 class OGRFlatGeobufDataset;
 
@@ -120,15 +123,55 @@ class OGRFlatGeobufLayer final : public OGRLayer,
         m_osTempFile;  // holds generated temp file name for two pass writing
     uint32_t m_maxFeatureSize = 0;
     std::vector<uint8_t> m_writeProperties{};
+    // feature items beyond that count are spilled to a temporary file, and
+    // sorted with an external merge sort at close
+    size_t m_nMaxItemsInMemory = 0;
+    std::string m_osItemsTempFile{};
+    VSILFILE *m_poFpItems = nullptr;
+    uint64_t m_nSpilledItems = 0;
+    FlatGeobuf::NodeItem m_spilledItemsExtent =
+        FlatGeobuf::NodeItem::create(0);
 
     // shared
     GByte *m_featureBuf = nullptr;  // reusable/resizable feature data buffer
     uint32_t m_featureBufSize = 0;  // current feature buffer size
 
+    // prefetching: buffers of consecutive features are read with coalesced
+    // reads, and their verification and geometry decoding is done by
+    // worker threads
+    struct PrefetchedFeature
+    {
+        GIntBig fid = 0;
+        size_t bufOffset = 0;     // in m_prefetchBuf, after the size prefix
+        uint32_t size = 0;        // size of the feature buffer
+        uint64_t nextOffset = 0;  // value of m_offset after that feature
+        bool processed = false;   // whether processFeatureBuf() has been run
+        bool verifyFailed = false;
+        bool geometryRead = false;
+        bool geometryFailed = false;
+        std::unique_ptr<OGRGeometry> geometry{};
+        std::vector<CPLErrorHandlerAccumulatorStruct> errors{};
+    };
+    bool m_prefetch = false;
+    int m_prefetchThreads = 1;
+    std::vector<GByte> m_prefetchBuf{};
+    std::vector<PrefetchedFeature> m_prefetched{};
+    size_t m_prefetchedStartPos = 0;  // m_featuresPos of m_prefetched[0]
+
     // deserialize
     void ensurePadfBuffers(size_t count);
     OGRErr ensureFeatureBuf(uint32_t featureSize);
-    OGRErr parseFeature(OGRFeature *poFeature);
+    OGRErr checkFeatureSize(uint32_t featureSize, uint64_t offset);
+    OGRErr prefetchFeatures();
+    void processFeatureBuf(PrefetchedFeature &item, bool readGeometry) const;
+    OGRErr readFeatureBuf(GIntBig &fid, const GByte *&featureBuf,
+                          uint32_t &featureSize,
+                          PrefetchedFeature *&prefetched, bool &eof);
+    bool verifyFeatureBuf(const GByte *featureBuf, uint32_t featureSize,
+                          PrefetchedFeature *prefetched);
+    OGRGeometry *readGeometry(const FlatGeobuf::Feature *feature,
+                              PrefetchedFeature *prefetched, bool &error);
+    OGRErr parseFeature(OGRFeature *poFeature, bool &eof);
     const std::vector<flatbuffers::Offset<FlatGeobuf::Column>>
     writeColumns(flatbuffers::FlatBufferBuilder &fbb);
     void readColumns();
@@ -137,6 +180,8 @@ class OGRFlatGeobufLayer final : public OGRLayer,
 
     // serialize
     bool CreateFinalFile();
+    bool CreateFinalFileFromSpilledItems(uint64_t nTempFileSize);
+    bool spillFeatureItems();
     void writeHeader(VSILFILE *poFp, uint64_t featuresCount,
                      std::vector<double> *extentVector);
 
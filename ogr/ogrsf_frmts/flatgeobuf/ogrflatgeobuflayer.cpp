@@ -32,6 +32,7 @@
 #include "cpl_json.h"
 #include "cpl_http.h"
 #include "cpl_time.h"
+#include "gdal_thread_pool.h"
 #include "ogr_p.h"
 #include "ograrrowarrayhelper.h"
 #include "ogr_recordbatch.h"
@@ -42,8 +43,11 @@
 #include "geometrywriter.h"
 
 #include <algorithm>
+#include <functional>
+#include <future>
 #include <limits>
 #include <new>
+#include <queue>
 #include <stdexcept>
 
 using namespace flatbuffers;
@@ -64,6 +68,42 @@ static OGRErr CPLErrorIO(const char *message)
     return OGRERR_FAILURE;
 }
 
+namespace
+{
+struct ThreadJob
+{
+    std::function<void()> run{};
+};
+}  // namespace
+
+// Runs the jobs in the global thread pool, or in the current thread if it
+// is not available
+static void RunJobs(std::vector<ThreadJob> &jobs)
+{
+    auto poPool = jobs.size() > 1
+                      ? GDALGetGlobalThreadPool(static_cast<int>(jobs.size()))
+                      : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+    const auto JobFunc = [](void *pData)
+    { static_cast<ThreadJob *>(pData)->run(); };
+    for (auto &job : jobs)
+    {
+        if (!poQueue || !poQueue->SubmitJob(JobFunc, &job))
+            job.run();
+    }
+    if (poQueue)
+        poQueue->WaitCompletion();
+}
+
+static int GetNumThreads()
+{
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    return pszNumThreads == nullptr ? std::min(4, CPLGetNumCPUs())
+           : EQUAL(pszNumThreads, "ALL_CPUS")
+               ? CPLGetNumCPUs()
+               : std::max(1, std::min(128, atoi(pszNumThreads)));
+}
+
 OGRFlatGeobufLayer::OGRFlatGeobufLayer(const Header *poHeader, GByte *headerBuf,
                                        const char *pszFilename, VSILFILE *poFp,
                                        uint64_t offset)
@@ -79,6 +119,10 @@ OGRFlatGeobufLayer::OGRFlatGeobufLayer(const Header *poHeader, GByte *headerBuf,
     m_offset = offset;
     m_create = false;
 
+    m_prefetchThreads = GetNumThreads();
+    // Coalescing reads is also worth it for network file systems
+    m_prefetch = m_prefetchThreads > 1 || !VSIIsLocal(m_osFilename.c_str());
+
     m_featuresCount = m_poHeader->features_count();
     m_geometryType = m_poHeader->geometry_type();
     m_indexNodeSize = m_poHeader->index_node_size();
@@ -224,6 +268,20 @@ OGRFlatGeobufLayer::OGRFlatGeobufLayer(
     SetDescription(m_poFeatureDefn->GetName());
     m_poFeatureDefn->SetGeomType(eGType);
     m_poFeatureDefn->Reference();
+
+    // Default to 10% of the RAM for the feature items used to build the
+    // spatial index
+    const char *pszSortMaxRAM =
+        CPLGetConfigOption("OGR_FLATGEOBUF_SORT_MAX_RAM", nullptr);
+    const double dfMaxRAM =
+        pszSortMaxRAM
+            ? CPLAtof(pszSortMaxRAM) * 1024 * 1024
+            : std::max(static_cast<double>(CPLGetUsablePhysicalRAM()) / 10,
+                       64.0 * 1024 * 1024);
+    m_nMaxItemsInMemory = static_cast<size_t>(std::max(
+        1.0, std::min(dfMaxRAM / sizeof(FeatureItem),
+                      static_cast<double>(
+                          std::numeric_limits<size_t>::max() / 8))));
 }
 
 OGRwkbGeometryType OGRFlatGeobufLayer::getOGRwkbGeometryType()
@@ -597,6 +655,9 @@ bool OGRFlatGeobufLayer::CreateFinalFile()
     m_writeOffset = 0;
     m_indexNodeSize = 16;
 
+    if (m_poFpItems)
+        return CreateFinalFileFromSpilledItems(nTempFileSize);
+
     size_t c;
 
     if (m_featuresCount >= std::numeric_limits<size_t>::max() / 8)
@@ -786,6 +847,651 @@ bool OGRFlatGeobufLayer::CreateFinalFile()
     return true;
 }
 
+/************************************************************************/
+/*                         spillFeatureItems()                          */
+/************************************************************************/
+
+namespace
+{
+// Number of items read or written at once in the temporary files
+constexpr size_t SORT_CHUNK_SIZE = 4096;
+
+// Feature item, as stored in the temporary files of the external sort
+struct SortItem
+{
+    double minX;
+    double minY;
+    double maxX;
+    double maxY;
+    uint64_t offset;  // offset of the feature in the temporary file
+    uint32_t size;
+    uint32_t hilbertValue;
+};
+
+// Same order as hilbertSort(), with ties broken by offset so that the
+// result does not depend on how items are split in runs
+bool SortItemLess(const SortItem &a, const SortItem &b)
+{
+    if (a.hilbertValue != b.hilbertValue)
+        return a.hilbertValue > b.hilbertValue;
+    return a.offset < b.offset;
+}
+
+// Temporary file removed when going out of scope
+struct TempFile
+{
+    std::string osFilename{};
+    VSILFILE *fp = nullptr;
+
+    TempFile() = default;
+    TempFile(const TempFile &) = delete;
+    TempFile &operator=(const TempFile &) = delete;
+
+    ~TempFile()
+    {
+        if (fp)
+            VSIFCloseL(fp);
+    }
+
+    bool Create(const std::string &osFilenameIn)
+    {
+        osFilename = osFilenameIn;
+        fp = VSIFOpenL(osFilename.c_str(), "w+b");
+        if (fp == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_OpenFailed, "Cannot create %s",
+                     osFilename.c_str());
+            return false;
+        }
+        // Unlink it now to avoid stale temporary file if killing the process
+        // (only works on Unix)
+        VSIUnlink(osFilename.c_str());
+        return true;
+    }
+};
+}  // namespace
+
+// Appends m_featureItems to the temporary items file, and clears it
+bool OGRFlatGeobufLayer::spillFeatureItems()
+{
+    if (m_poFpItems == nullptr)
+    {
+        CPLDebug("FlatGeobuf", "Spilling feature items to temporary file");
+        m_osItemsTempFile = m_osTempFile + "_items.tmp";
+        m_poFpItems = VSIFOpenL(m_osItemsTempFile.c_str(), "w+b");
+        if (m_poFpItems == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_OpenFailed, "Cannot create %s",
+                     m_osItemsTempFile.c_str());
+            return false;
+        }
+        // Unlink it now to avoid stale temporary file if killing the process
+        // (only works on Unix)
+        VSIUnlink(m_osItemsTempFile.c_str());
+    }
+
+    std::vector<SortItem> items;
+    items.reserve(SORT_CHUNK_SIZE);
+    const auto flush = [this, &items]()
+    {
+        const bool ok = VSIFWriteL(items.data(), sizeof(SortItem),
+                                   items.size(), m_poFpItems) == items.size();
+        items.clear();
+        return ok;
+    };
+    for (const auto &featureItem : m_featureItems)
+    {
+        SortItem item;
+        item.minX = featureItem.nodeItem.minX;
+        item.minY = featureItem.nodeItem.minY;
+        item.maxX = featureItem.nodeItem.maxX;
+        item.maxY = featureItem.nodeItem.maxY;
+        item.offset = featureItem.offset;
+        item.size = featureItem.size;
+        item.hilbertValue = 0;
+        m_spilledItemsExtent.expand(featureItem.nodeItem);
+        items.push_back(item);
+        if (items.size() == SORT_CHUNK_SIZE && !flush())
+        {
+            CPLErrorIO("writing feature items");
+            return false;
+        }
+    }
+    if (!items.empty() && !flush())
+    {
+        CPLErrorIO("writing feature items");
+        return false;
+    }
+    m_nSpilledItems += m_featureItems.size();
+    std::deque<FeatureItem>().swap(m_featureItems);
+    return true;
+}
+
+/************************************************************************/
+/*                  CreateFinalFileFromSpilledItems()                   */
+/************************************************************************/
+
+// Second pass of the creation of a file with a spatial index, when the
+// feature items did not fit in m_nMaxItemsInMemory. Items are sorted with an
+// external merge sort: runs of at most m_nMaxItemsInMemory items are sorted
+// by worker threads, and then merged. The upper levels of the packed R-tree
+// are computed while merging, so that neither the items nor the tree have
+// to be held in memory.
+bool OGRFlatGeobufLayer::CreateFinalFileFromSpilledItems(
+    uint64_t nTempFileSize)
+{
+    if (!m_featureItems.empty() && !spillFeatureItems())
+        return false;
+    if (m_nSpilledItems != m_featuresCount)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Inconsistent number of feature items");
+        return false;
+    }
+
+    auto extent = m_spilledItemsExtent;
+    auto extentVector = extent.toVector();
+    writeHeader(m_poFp, m_featuresCount, &extentVector);
+
+    const int nThreads = GetNumThreads();
+
+    try
+    {
+        const auto levelBounds =
+            PackedRTree::generateLevelBounds(m_featuresCount, m_indexNodeSize);
+
+        // Create sorted runs
+        CPLDebugOnly("FlatGeobuf", "Sorting items for Packed R-tree");
+        TempFile oRunsFile;
+        if (!oRunsFile.Create(m_osTempFile + "_runs.tmp"))
+            return false;
+        struct Run
+        {
+            uint64_t start;  // index of the first item in oRunsFile
+            uint64_t count;
+        };
+        std::vector<Run> runs;
+        {
+            const double minX = extent.minX;
+            const double minY = extent.minY;
+            const double width = extent.width();
+            const double height = extent.height();
+            std::vector<SortItem> items(static_cast<size_t>(
+                std::min<uint64_t>(m_nMaxItemsInMemory, m_nSpilledItems)));
+            if (VSIFSeekL(m_poFpItems, 0, SEEK_SET) != 0)
+            {
+                CPLErrorIO("seeking in feature items");
+                return false;
+            }
+            for (uint64_t start = 0; start < m_nSpilledItems;)
+            {
+                const size_t count = static_cast<size_t>(std::min<uint64_t>(
+                    items.size(), m_nSpilledItems - start));
+                if (VSIFReadL(items.data(), sizeof(SortItem), count,
+                              m_poFpItems) != count)
+                {
+                    CPLErrorIO("reading feature items");
+                    return false;
+                }
+
+                // Each slice is sorted by a worker thread and is a run
+                const size_t nMaxSlices = std::max<size_t>(1, count / 1024);
+                const size_t nSlices =
+                    std::min(static_cast<size_t>(nThreads), nMaxSlices);
+                const size_t sliceSize = (count + nSlices - 1) / nSlices;
+                std::vector<ThreadJob> jobs;
+                for (size_t sliceStart = 0; sliceStart < count;
+                     sliceStart += sliceSize)
+                {
+                    const size_t sliceEnd =
+                        std::min(count, sliceStart + sliceSize);
+                    ThreadJob job;
+                    job.run = [&items, sliceStart, sliceEnd, minX, minY, width,
+                               height]()
+                    {
+                        for (size_t i = sliceStart; i < sliceEnd; ++i)
+                        {
+                            auto &item = items[i];
+                            const NodeItem node{item.minX, item.minY,
+                                                item.maxX, item.maxY, 0};
+                            item.hilbertValue = hilbert(
+                                node, HILBERT_MAX, minX, minY, width, height);
+                        }
+                        std::sort(items.begin() + sliceStart,
+                                  items.begin() + sliceEnd, SortItemLess);
+                    };
+                    jobs.emplace_back(std::move(job));
+                    runs.push_back(
+                        Run{start + sliceStart, sliceEnd - sliceStart});
+                }
+                RunJobs(jobs);
+
+                if (VSIFWriteL(items.data(), sizeof(SortItem), count,
+                               oRunsFile.fp) != count)
+                {
+                    CPLErrorIO("writing sorted feature items");
+                    return false;
+                }
+                start += count;
+            }
+        }
+
+        // Merge the runs into oSortedFile, and compute the nodes of the
+        // upper levels of the tree into oTreeFile
+        CPLDebugOnly("FlatGeobuf", "Merging %d sorted runs",
+                     static_cast<int>(runs.size()));
+        TempFile oSortedFile;
+        TempFile oTreeFile;
+        if (!oSortedFile.Create(m_osTempFile + "_sorted.tmp") ||
+            !oTreeFile.Create(m_osTempFile + "_tree.tmp"))
+        {
+            return false;
+        }
+        {
+            struct RunReader
+            {
+                uint64_t next = 0;  // index in oRunsFile of the next item
+                uint64_t end = 0;
+                std::vector<SortItem> buffer{};
+                size_t pos = 0;
+            };
+            const size_t nItemsPerReader =
+                std::max<size_t>(256, m_nMaxItemsInMemory / runs.size());
+            std::vector<RunReader> readers(runs.size());
+            const auto refill = [&oRunsFile, nItemsPerReader](RunReader &reader)
+            {
+                const size_t count = static_cast<size_t>(std::min<uint64_t>(
+                    nItemsPerReader, reader.end - reader.next));
+                reader.buffer.resize(count);
+                reader.pos = 0;
+                if (count == 0)
+                    return true;
+                if (VSIFSeekL(oRunsFile.fp, reader.next * sizeof(SortItem),
+                              SEEK_SET) != 0 ||
+                    VSIFReadL(reader.buffer.data(), sizeof(SortItem), count,
+                              oRunsFile.fp) != count)
+                {
+                    return false;
+                }
+                reader.next += count;
+                return true;
+            };
+            // std::priority_queue gives first the greatest element
+            const auto cmpReaders = [&readers](size_t a, size_t b)
+            {
+                return SortItemLess(readers[b].buffer[readers[b].pos],
+                                    readers[a].buffer[readers[a].pos]);
+            };
+            std::priority_queue<size_t, std::vector<size_t>,
+                                decltype(cmpReaders)>
+                heap(cmpReaders);
+            for (size_t i = 0; i < runs.size(); ++i)
+            {
+                readers[i].next = runs[i].start;
+                readers[i].end = runs[i].start + runs[i].count;
+                if (!refill(readers[i]))
+                {
+                    CPLErrorIO("reading sorted feature items");
+                    return false;
+                }
+                if (!readers[i].buffer.empty())
+                    heap.push(i);
+            }
+
+            // Node being built and nodes not yet written, for each upper
+            // level of the tree
+            struct LevelBuilder
+            {
+                NodeItem node = NodeItem::create(0);
+                uint16_t nChildren = 0;
+                uint64_t nNodes = 0;  // number of completed nodes
+                uint64_t nWrittenNodes = 0;
+                std::vector<NodeItem> buffer{};
+            };
+            std::vector<LevelBuilder> levels(levelBounds.size());
+            const auto writeLevel = [&levels, &levelBounds,
+                                     &oTreeFile](size_t iLevel)
+            {
+                auto &level = levels[iLevel];
+                if (level.buffer.empty())
+                    return true;
+#if !CPL_IS_LSB
+                for (auto &node : level.buffer)
+                {
+                    CPL_LSBPTR64(&node.minX);
+                    CPL_LSBPTR64(&node.minY);
+                    CPL_LSBPTR64(&node.maxX);
+                    CPL_LSBPTR64(&node.maxY);
+                    CPL_LSBPTR64(&node.offset);
+                }
+#endif
+                const uint64_t pos =
+                    (levelBounds[iLevel].first + level.nWrittenNodes) *
+                    sizeof(NodeItem);
+                const bool ok =
+                    VSIFSeekL(oTreeFile.fp, pos, SEEK_SET) == 0 &&
+                    VSIFWriteL(level.buffer.data(), sizeof(NodeItem),
+                               level.buffer.size(),
+                               oTreeFile.fp) == level.buffer.size();
+                level.nWrittenNodes += level.buffer.size();
+                level.buffer.clear();
+                return ok;
+            };
+            // Completes the node being built at iLevel, and adds it to its
+            // parent, up to the root
+            const auto completeNode = [this, &levels, &levelBounds,
+                                       &writeLevel](size_t iLevel)
+            {
+                for (; iLevel < levels.size(); ++iLevel)
+                {
+                    auto &level = levels[iLevel];
+                    const NodeItem node = level.node;
+                    const uint64_t nodeIdx =
+                        levelBounds[iLevel].first + level.nNodes;
+                    ++level.nNodes;
+                    level.nChildren = 0;
+                    level.buffer.push_back(node);
+                    if (level.buffer.size() == SORT_CHUNK_SIZE &&
+                        !writeLevel(iLevel))
+                        return false;
+                    if (iLevel + 1 == levels.size())
+                        break;
+                    auto &parent = levels[iLevel + 1];
+                    if (parent.nChildren == 0)
+                        parent.node = NodeItem::create(nodeIdx);
+                    parent.node.expand(node);
+                    if (++parent.nChildren < m_indexNodeSize)
+                        break;
+                }
+                return true;
+            };
+
+            std::vector<SortItem> sortedItems;
+            sortedItems.reserve(SORT_CHUNK_SIZE);
+            uint64_t leafIdx = levelBounds[0].first;
+            while (!heap.empty())
+            {
+                const size_t i = heap.top();
+                heap.pop();
+                auto &reader = readers[i];
+                const SortItem item = reader.buffer[reader.pos];
+
+                // Add the leaf node to its parent
+                auto &parent = levels[1];
+                if (parent.nChildren == 0)
+                    parent.node = NodeItem::create(leafIdx);
+                parent.node.expand(
+                    NodeItem{item.minX, item.minY, item.maxX, item.maxY, 0});
+                ++leafIdx;
+                if (++parent.nChildren == m_indexNodeSize && !completeNode(1))
+                {
+                    CPLErrorIO("writing tree nodes");
+                    return false;
+                }
+
+                sortedItems.push_back(item);
+                if (sortedItems.size() == SORT_CHUNK_SIZE)
+                {
+                    if (VSIFWriteL(sortedItems.data(), sizeof(SortItem),
+                                   sortedItems.size(),
+                                   oSortedFile.fp) != sortedItems.size())
+                    {
+                        CPLErrorIO("writing sorted feature items");
+                        return false;
+                    }
+                    sortedItems.clear();
+                }
+
+                if (++reader.pos == reader.buffer.size() && !refill(reader))
+                {
+                    CPLErrorIO("reading sorted feature items");
+                    return false;
+                }
+                if (reader.pos < reader.buffer.size())
+                    heap.push(i);
+            }
+            if (VSIFWriteL(sortedItems.data(), sizeof(SortItem),
+                           sortedItems.size(),
+                           oSortedFile.fp) != sortedItems.size())
+            {
+                CPLErrorIO("writing sorted feature items");
+                return false;
+            }
+
+            // Complete the last node of each level
+            for (size_t iLevel = 1; iLevel < levels.size(); ++iLevel)
+            {
+                if ((levels[iLevel].nChildren > 0 && !completeNode(iLevel)) ||
+                    !writeLevel(iLevel))
+                {
+                    CPLErrorIO("writing tree nodes");
+                    return false;
+                }
+            }
+        }
+
+        // Write the upper levels of the tree, and then its leaves
+        CPLDebugOnly("FlatGeobuf", "Writing Packed R-tree");
+        {
+            std::vector<GByte> abyBuffer(SORT_CHUNK_SIZE * sizeof(NodeItem));
+            uint64_t nRemaining = levelBounds[0].first * sizeof(NodeItem);
+            if (VSIFSeekL(oTreeFile.fp, 0, SEEK_SET) != 0)
+            {
+                CPLErrorIO("seeking in tree nodes");
+                return false;
+            }
+            while (nRemaining > 0)
+            {
+                const size_t nToCopy = static_cast<size_t>(
+                    std::min<uint64_t>(abyBuffer.size(), nRemaining));
+                if (VSIFReadL(abyBuffer.data(), 1, nToCopy, oTreeFile.fp) !=
+                    nToCopy)
+                {
+                    CPLErrorIO("reading tree nodes");
+                    return false;
+                }
+                if (VSIFWriteL(abyBuffer.data(), 1, nToCopy, m_poFp) != nToCopy)
+                {
+                    CPLErrorIO("writing tree nodes");
+                    return false;
+                }
+                nRemaining -= nToCopy;
+            }
+
+            std::vector<SortItem> items(SORT_CHUNK_SIZE);
+            std::vector<NodeItem> nodes;
+            nodes.reserve(SORT_CHUNK_SIZE);
+            uint64_t featureOffset = 0;
+            if (VSIFSeekL(oSortedFile.fp, 0, SEEK_SET) != 0)
+            {
+                CPLErrorIO("seeking in sorted feature items");
+                return false;
+            }
+            for (uint64_t i = 0; i < m_featuresCount;)
+            {
+                const size_t count = static_cast<size_t>(
+                    std::min<uint64_t>(SORT_CHUNK_SIZE, m_featuresCount - i));
+                if (VSIFReadL(items.data(), sizeof(SortItem), count,
+                              oSortedFile.fp) != count)
+                {
+                    CPLErrorIO("reading sorted feature items");
+                    return false;
+                }
+                nodes.clear();
+                for (size_t j = 0; j < count; ++j)
+                {
+                    const auto &item = items[j];
+                    nodes.push_back(NodeItem{item.minX, item.minY, item.maxX,
+                                             item.maxY, featureOffset});
+                    featureOffset += item.size;
+#if !CPL_IS_LSB
+                    auto &node = nodes.back();
+                    CPL_LSBPTR64(&node.minX);
+                    CPL_LSBPTR64(&node.minY);
+                    CPL_LSBPTR64(&node.maxX);
+                    CPL_LSBPTR64(&node.maxY);
+                    CPL_LSBPTR64(&node.offset);
+#endif
+                }
+                if (VSIFWriteL(nodes.data(), sizeof(NodeItem), count, m_poFp) !=
+                    count)
+                {
+                    CPLErrorIO("writing tree nodes");
+                    return false;
+                }
+                i += count;
+            }
+        }
+        const uint64_t nTreeSize =
+            PackedRTree::size(m_featuresCount, m_indexNodeSize);
+        CPLDebugOnly("FlatGeobuf", "Wrote tree (%lu bytes)",
+                     static_cast<long unsigned int>(nTreeSize));
+        m_writeOffset += nTreeSize;
+
+        // Copy the features in sorted order, with the same batch strategy
+        // as CreateFinalFile(). When several threads are allowed, a batch is
+        // written to the final file while the next one is read from the
+        // temporary file.
+        CPLDebugOnly("FlatGeobuf", "Writing feature buffers at offset %lu",
+                     static_cast<long unsigned int>(m_writeOffset));
+        {
+            const bool bWriteInThread = nThreads > 1;
+            const size_t nMaxBufferSize = std::max(
+                static_cast<size_t>(m_maxFeatureSize),
+                static_cast<size_t>(std::min(
+                    static_cast<uint64_t>(
+                        (bWriteInThread ? 50 : 100) * 1024 * 1024),
+                    nTempFileSize)));
+            std::vector<GByte> abyBuffers[2];
+            abyBuffers[0].resize(nMaxBufferSize);
+            if (bWriteInThread)
+                abyBuffers[1].resize(nMaxBufferSize);
+            int iBuffer = 0;
+            std::future<bool> pendingWrite;
+
+            struct BatchItem
+            {
+                uint64_t offset;  // offset in the temporary file
+                uint32_t size;
+                size_t offsetInBuffer;
+            };
+            std::vector<BatchItem> batch;
+            size_t offsetInBuffer = 0;
+
+            const auto flushBatch = [this, &batch, &offsetInBuffer,
+                                     &abyBuffers, &iBuffer, &pendingWrite,
+                                     bWriteInThread]()
+            {
+                // Sort by increasing source offset
+                std::sort(batch.begin(), batch.end(),
+                          [](const BatchItem &a, const BatchItem &b)
+                          { return a.offset < b.offset; });
+
+                // Read source features
+                GByte *pabyBuffer = abyBuffers[iBuffer].data();
+                for (const auto &batchItem : batch)
+                {
+                    if (VSIFSeekL(m_poFpWrite, batchItem.offset, SEEK_SET) ==
+                        -1)
+                    {
+                        CPLErrorIO("seeking to temp feature location");
+                        return false;
+                    }
+                    if (VSIFReadL(pabyBuffer + batchItem.offsetInBuffer, 1,
+                                  batchItem.size,
+                                  m_poFpWrite) != batchItem.size)
+                    {
+                        CPLErrorIO("reading temp feature");
+                        return false;
+                    }
+                }
+
+                // Write target features, once the previous batch has been
+                // written
+                if (pendingWrite.valid() && !pendingWrite.get())
+                {
+                    CPLErrorIO("writing feature");
+                    return false;
+                }
+                const size_t nToWrite = offsetInBuffer;
+                const auto write = [this, pabyBuffer, nToWrite]()
+                {
+                    return VSIFWriteL(pabyBuffer, 1, nToWrite, m_poFp) ==
+                           nToWrite;
+                };
+                if (bWriteInThread)
+                {
+                    pendingWrite = std::async(std::launch::async, write);
+                    iBuffer = 1 - iBuffer;
+                }
+                else if (!write())
+                {
+                    CPLErrorIO("writing feature");
+                    return false;
+                }
+
+                batch.clear();
+                offsetInBuffer = 0;
+                return true;
+            };
+
+            std::vector<SortItem> items(SORT_CHUNK_SIZE);
+            uint64_t nFeaturesSize = 0;
+            if (VSIFSeekL(oSortedFile.fp, 0, SEEK_SET) != 0)
+            {
+                CPLErrorIO("seeking in sorted feature items");
+                return false;
+            }
+            for (uint64_t i = 0; i < m_featuresCount;)
+            {
+                const size_t count = static_cast<size_t>(
+                    std::min<uint64_t>(SORT_CHUNK_SIZE, m_featuresCount - i));
+                if (VSIFReadL(items.data(), sizeof(SortItem), count,
+                              oSortedFile.fp) != count)
+                {
+                    CPLErrorIO("reading sorted feature items");
+                    return false;
+                }
+                for (size_t j = 0; j < count; ++j)
+                {
+                    const auto &item = items[j];
+                    if (offsetInBuffer + item.size > nMaxBufferSize &&
+                        !flushBatch())
+                    {
+                        return false;
+                    }
+                    batch.push_back(
+                        BatchItem{item.offset, item.size, offsetInBuffer});
+                    offsetInBuffer += item.size;
+                    nFeaturesSize += item.size;
+                }
+                i += count;
+            }
+            if (!flushBatch())
+                return false;
+            if (pendingWrite.valid() && !pendingWrite.get())
+            {
+                CPLErrorIO("writing feature");
+                return false;
+            }
+
+            CPLDebugOnly("FlatGeobuf", "Wrote feature buffers (%lu bytes)",
+                         static_cast<long unsigned int>(nFeaturesSize));
+            m_writeOffset += nFeaturesSize;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Create: %s", e.what());
+        return false;
+    }
+
+    CPLDebugOnly("FlatGeobuf", "Now at offset %lu",
+                 static_cast<long unsigned int>(m_writeOffset));
+
+    return true;
+}
+
 OGRFlatGeobufLayer::~OGRFlatGeobufLayer()
 {
     OGRFlatGeobufLayer::Close();
@@ -828,6 +1534,18 @@ CPLErr OGRFlatGeobufLayer::Close()
         m_poFpWrite = nullptr;
     }
 
+    if (m_poFpItems)
+    {
+        VSIFCloseL(m_poFpItems);
+        m_poFpItems = nullptr;
+    }
+
+    if (!m_osItemsTempFile.empty())
+    {
+        VSIUnlink(m_osItemsTempFile.c_str());
+        m_osItemsTempFile.clear();
+    }
+
     if (!m_osTempFile.empty())
     {
         VSIUnlink(m_osTempFile.c_str());
@@ -894,7 +1612,11 @@ OGRFeature *OGRFlatGeobufLayer::GetFeature(GIntBig nFeatureId)
             return nullptr;
         }
         m_offset = m_offsetFeatures + featureOffset;
+        // Reading a batch of features would be a waste for random access
+        const bool prefetchBackup = m_prefetch;
+        m_prefetch = false;
         OGRFeature *poFeature = GetNextFeature();
+        m_prefetch = prefetchBackup;
         if (poFeature != nullptr)
             poFeature->SetFID(nFeatureId);
         ResetReading();
@@ -1015,14 +1737,15 @@ OGRFeature *OGRFlatGeobufLayer::GetNextFeature()
         }
 
         auto poFeature = std::make_unique<OGRFeature>(m_poFeatureDefn);
-        if (parseFeature(poFeature.get()) != OGRERR_NONE)
+        bool eof = false;
+        if (parseFeature(poFeature.get(), eof) != OGRERR_NONE)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
                      "Fatal error parsing feature");
             return nullptr;
         }
 
-        if (VSIFEofL(m_poFp))
+        if (eof)
         {
             CPLDebug("FlatGeobuf", "GetNextFeature: iteration end due to EOF");
             return nullptr;
@@ -1067,9 +1790,317 @@ OGRErr OGRFlatGeobufLayer::ensureFeatureBuf(uint32_t featureSize)
     return OGRERR_NONE;
 }
 
-OGRErr OGRFlatGeobufLayer::parseFeature(OGRFeature *poFeature)
+/************************************************************************/
+/*                         checkFeatureSize()                           */
+/************************************************************************/
+
+// Sanity check to avoid allocated huge amount of memory on corrupted
+// feature
+OGRErr OGRFlatGeobufLayer::checkFeatureSize(uint32_t featureSize,
+                                            uint64_t offset)
+{
+    if (featureSize > 100 * 1024 * 1024)
+    {
+        if (featureSize > feature_max_buffer_size)
+            return CPLErrorInvalidSize("feature");
+
+        if (m_nFileSize == 0)
+        {
+            VSIStatBufL sStatBuf;
+            if (VSIStatL(m_osFilename.c_str(), &sStatBuf) == 0)
+            {
+                m_nFileSize = sStatBuf.st_size;
+            }
+        }
+        if (offset + featureSize > m_nFileSize)
+        {
+            return CPLErrorIO("reading feature size");
+        }
+    }
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                         prefetchFeatures()                           */
+/************************************************************************/
+
+// Reads the buffers of the features starting at m_featuresPos, and when
+// several threads are allowed, verifies them and decodes their geometry
+// concurrently. Consecutive features, or features selected by the spatial
+// index that are close to each other, are read with a single request.
+OGRErr OGRFlatGeobufLayer::prefetchFeatures()
+{
+    // Maximum number of features and of bytes of a batch
+    constexpr size_t MAX_FEATURES = 1000;
+    constexpr size_t MAX_BYTES = 1024 * 1024;
+    // Maximum gap between two features selected by the spatial index for
+    // them to be read with a single request
+    constexpr uint64_t MAX_GAP = 32 * 1024;
+
+    m_prefetched.clear();
+    m_prefetchBuf.clear();
+    m_prefetchedStartPos = m_featuresPos;
+
+    // Appends to m_prefetchBuf the content of the file at [start, start+size[
+    // and returns the number of bytes actually read
+    const auto readRange = [this](uint64_t start, size_t size)
+    {
+        const size_t bufStart = m_prefetchBuf.size();
+        m_prefetchBuf.resize(bufStart + size);
+        size_t nRead = 0;
+        if (VSIFSeekL(m_poFp, start, SEEK_SET) == 0)
+            nRead = VSIFReadL(m_prefetchBuf.data() + bufStart, 1, size, m_poFp);
+        m_prefetchBuf.resize(bufStart + nRead);
+        return nRead;
+    };
+    const auto getFeatureSize = [this](size_t bufOffset)
+    {
+        uint32_t featureSize;
+        memcpy(&featureSize, m_prefetchBuf.data() + bufOffset,
+               sizeof(featureSize));
+        CPL_LSBPTR32(&featureSize);
+        return featureSize;
+    };
+
+    try
+    {
+        size_t pos = m_featuresPos;
+        if (m_queriedSpatialIndex && !m_ignoreSpatialFilter)
+        {
+            while (pos < m_featuresCount &&
+                   m_prefetched.size() < MAX_FEATURES &&
+                   m_prefetchBuf.size() < MAX_BYTES)
+            {
+                // Group features whose size prefix can be read with a single
+                // request
+                const uint64_t rangeStart =
+                    m_offsetFeatures + m_foundItems[pos].offset;
+                uint64_t rangeEnd = rangeStart + sizeof(uint32_t);
+                size_t count = 1;
+                while (pos + count < m_featuresCount &&
+                       m_prefetched.size() + count < MAX_FEATURES)
+                {
+                    const uint64_t nextOffset =
+                        m_offsetFeatures + m_foundItems[pos + count].offset;
+                    if (nextOffset < rangeEnd ||
+                        nextOffset - rangeEnd > MAX_GAP ||
+                        nextOffset - rangeStart > MAX_BYTES)
+                        break;
+                    rangeEnd = nextOffset + sizeof(uint32_t);
+                    ++count;
+                }
+
+                const size_t bufStart = m_prefetchBuf.size();
+                const size_t rangeSize =
+                    static_cast<size_t>(rangeEnd - rangeStart);
+                if (readRange(rangeStart, rangeSize) != rangeSize)
+                {
+                    if (m_prefetched.empty())
+                        return OGRERR_NONE;  // EOF
+                    break;
+                }
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const auto &foundItem = m_foundItems[pos + i];
+                    const uint64_t featureOffset =
+                        m_offsetFeatures + foundItem.offset;
+                    const size_t relOffset =
+                        static_cast<size_t>(featureOffset - rangeStart);
+                    const uint32_t featureSize =
+                        getFeatureSize(bufStart + relOffset);
+                    const auto err =
+                        checkFeatureSize(featureSize, featureOffset);
+                    if (err != OGRERR_NONE)
+                        return err;
+                    const size_t featureEnd =
+                        relOffset + sizeof(uint32_t) + featureSize;
+                    if (i + 1 < count)
+                    {
+                        if (featureEnd >
+                            static_cast<size_t>(m_offsetFeatures +
+                                                m_foundItems[pos + i + 1]
+                                                    .offset -
+                                                rangeStart))
+                        {
+                            return CPLErrorInvalidSize("feature");
+                        }
+                    }
+                    else if (readRange(rangeEnd, featureEnd - rangeSize) !=
+                             featureEnd - rangeSize)
+                    {
+                        return CPLErrorIO("reading feature");
+                    }
+
+                    PrefetchedFeature item;
+                    item.fid = foundItem.index;
+                    item.bufOffset = bufStart + relOffset + sizeof(uint32_t);
+                    item.size = featureSize;
+                    item.nextOffset =
+                        featureOffset + sizeof(uint32_t) + featureSize;
+                    m_prefetched.emplace_back(std::move(item));
+                }
+                pos += count;
+            }
+        }
+        else
+        {
+            // Sequential read of consecutive features
+            const uint64_t rangeStart = m_offset;
+            size_t nRead = readRange(rangeStart, MAX_BYTES);
+            size_t relOffset = 0;
+            while ((m_featuresCount == 0 || pos < m_featuresCount) &&
+                   m_prefetched.size() < MAX_FEATURES &&
+                   relOffset + sizeof(uint32_t) <= nRead)
+            {
+                const uint32_t featureSize = getFeatureSize(relOffset);
+                const auto err =
+                    checkFeatureSize(featureSize, rangeStart + relOffset);
+                if (err != OGRERR_NONE)
+                    return err;
+                const size_t featureEnd =
+                    relOffset + sizeof(uint32_t) + featureSize;
+                if (featureEnd > nRead)
+                {
+                    // Will be read by next prefetchFeatures() call
+                    if (!m_prefetched.empty())
+                        break;
+                    // Feature larger than MAX_BYTES
+                    if (readRange(rangeStart + nRead, featureEnd - nRead) !=
+                        featureEnd - nRead)
+                    {
+                        return CPLErrorIO("reading feature");
+                    }
+                    nRead = featureEnd;
+                }
+
+                PrefetchedFeature item;
+                item.fid = static_cast<GIntBig>(pos);
+                item.bufOffset = relOffset + sizeof(uint32_t);
+                item.size = featureSize;
+                item.nextOffset = rangeStart + featureEnd;
+                m_prefetched.emplace_back(std::move(item));
+
+                relOffset = featureEnd;
+                ++pos;
+            }
+            m_prefetchBuf.resize(relOffset);
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        m_prefetched.clear();
+        m_prefetchBuf.clear();
+        return CPLErrorMemoryAllocation("prefetch buffer");
+    }
+
+    const int nJobs = std::min(m_prefetchThreads,
+                               static_cast<int>(m_prefetched.size()));
+    if (nJobs > 1)
+    {
+        const bool readGeometry = !m_poFeatureDefn->IsGeometryIgnored();
+        const size_t featuresPerJob =
+            (m_prefetched.size() + nJobs - 1) / nJobs;
+        std::vector<ThreadJob> jobs(nJobs);
+        for (int i = 0; i < nJobs; ++i)
+        {
+            const size_t start = i * featuresPerJob;
+            const size_t end =
+                std::min(m_prefetched.size(), start + featuresPerJob);
+            jobs[i].run = [this, start, end, readGeometry]()
+            {
+                for (size_t j = start; j < end; ++j)
+                    processFeatureBuf(m_prefetched[j], readGeometry);
+            };
+        }
+        RunJobs(jobs);
+    }
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                        processFeatureBuf()                           */
+/************************************************************************/
+
+// Verifies the buffer of a prefetched feature and decodes its geometry.
+// May be called from a worker thread: errors are stored in the item, and
+// emitted when it is consumed.
+void OGRFlatGeobufLayer::processFeatureBuf(PrefetchedFeature &item,
+                                           bool readGeometry) const
+{
+    CPLInstallErrorHandlerAccumulator(item.errors);
+
+    const GByte *featureBuf = m_prefetchBuf.data() + item.bufOffset;
+    if (m_bVerifyBuffers)
+    {
+        Verifier v(featureBuf, item.size);
+        item.verifyFailed = !VerifyFeatureBuffer(v);
+    }
+    item.processed = true;
+
+    if (!item.verifyFailed && readGeometry)
+    {
+        const auto geometry = GetRoot<Feature>(featureBuf)->geometry();
+        if (geometry != nullptr)
+        {
+            auto geometryType = m_geometryType;
+            if (geometryType == GeometryType::Unknown)
+                geometryType = geometry->type();
+            item.geometry.reset(
+                GeometryReader(geometry, geometryType, m_hasZ, m_hasM).read());
+            item.geometryFailed = item.geometry == nullptr;
+        }
+        item.geometryRead = true;
+    }
+
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+/************************************************************************/
+/*                          readFeatureBuf()                            */
+/************************************************************************/
+
+// Reads the buffer of the feature at m_featuresPos, and advances m_offset
+// after it. featureBuf is set to nullptr if the end of file is reached
+// before it. eof is set if the end of file has been reached.
+OGRErr OGRFlatGeobufLayer::readFeatureBuf(GIntBig &fid,
+                                          const GByte *&featureBuf,
+                                          uint32_t &featureSize,
+                                          PrefetchedFeature *&prefetched,
+                                          bool &eof)
 {
-    GIntBig fid;
+    featureBuf = nullptr;
+    featureSize = 0;
+    prefetched = nullptr;
+    eof = false;
+
+    if (m_prefetch)
+    {
+        if (m_featuresPos < m_prefetchedStartPos ||
+            m_featuresPos >= m_prefetchedStartPos + m_prefetched.size())
+        {
+            const auto err = prefetchFeatures();
+            if (err != OGRERR_NONE)
+                return err;
+            if (m_prefetched.empty())
+            {
+                eof = true;
+                return OGRERR_NONE;
+            }
+        }
+        auto &item = m_prefetched[m_featuresPos - m_prefetchedStartPos];
+        for (const auto &error : item.errors)
+            CPLError(error.type, error.no, "%s", error.msg.c_str());
+        item.errors.clear();
+        fid = item.fid;
+        featureBuf = m_prefetchBuf.data() + item.bufOffset;
+        featureSize = item.size;
+        m_offset = item.nextOffset;
+        prefetched = &item;
+        return OGRERR_NONE;
+    }
+
     auto seek = false;
     if (m_queriedSpatialIndex && !m_ignoreSpatialFilter)
     {
@@ -1082,96 +2113,148 @@ OGRErr OGRFlatGeobufLayer::parseFeature(OGRFeature *poFeature)
     {
         fid = m_featuresPos;
     }
-    poFeature->SetFID(fid);
 
     // CPLDebugOnly("FlatGeobuf", "m_featuresPos: %lu", static_cast<long
     // unsigned int>(m_featuresPos));
 
-    if (m_featuresPos == 0)
+    // The file position is not m_offset if features have been prefetched
+    if (m_featuresPos == 0 || VSIFTellL(m_poFp) != m_offset)
         seek = true;
 
     if (seek && VSIFSeekL(m_poFp, m_offset, SEEK_SET) == -1)
     {
-        if (VSIFEofL(m_poFp))
+        eof = CPL_TO_BOOL(VSIFEofL(m_poFp));
+        if (eof)
             return OGRERR_NONE;
         return CPLErrorIO("seeking to feature location");
     }
-    uint32_t featureSize;
     if (VSIFReadL(&featureSize, sizeof(featureSize), 1, m_poFp) != 1)
     {
-        if (VSIFEofL(m_poFp))
+        eof = CPL_TO_BOOL(VSIFEofL(m_poFp));
+        if (eof)
             return OGRERR_NONE;
         return CPLErrorIO("reading feature size");
     }
     CPL_LSBPTR32(&featureSize);
 
-    // Sanity check to avoid allocated huge amount of memory on corrupted
-    // feature
-    if (featureSize > 100 * 1024 * 1024)
-    {
-        if (featureSize > feature_max_buffer_size)
-            return CPLErrorInvalidSize("feature");
-
-        if (m_nFileSize == 0)
-        {
-            VSIStatBufL sStatBuf;
-            if (VSIStatL(m_osFilename.c_str(), &sStatBuf) == 0)
-            {
-                m_nFileSize = sStatBuf.st_size;
-            }
-        }
-        if (m_offset + featureSize > m_nFileSize)
-        {
-            return CPLErrorIO("reading feature size");
-        }
-    }
+    auto err = checkFeatureSize(featureSize, m_offset);
+    if (err != OGRERR_NONE)
+        return err;
 
-    const auto err = ensureFeatureBuf(featureSize);
+    err = ensureFeatureBuf(featureSize);
     if (err != OGRERR_NONE)
         return err;
     if (VSIFReadL(m_featureBuf, 1, featureSize, m_poFp) != featureSize)
         return CPLErrorIO("reading feature");
     m_offset += featureSize + sizeof(featureSize);
 
-    if (m_bVerifyBuffers)
+    featureBuf = m_featureBuf;
+    eof = CPL_TO_BOOL(VSIFEofL(m_poFp));
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                         verifyFeatureBuf()                           */
+/************************************************************************/
+
+bool OGRFlatGeobufLayer::verifyFeatureBuf(const GByte *featureBuf,
+                                          uint32_t featureSize,
+                                          PrefetchedFeature *prefetched)
+{
+    if (!m_bVerifyBuffers)
+        return true;
+
+    bool ok;
+    if (prefetched && prefetched->processed)
     {
-        Verifier v(m_featureBuf, featureSize);
-        const auto ok = VerifyFeatureBuffer(v);
-        if (!ok)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined, "Buffer verification failed");
-            CPLDebugOnly("FlatGeobuf", "m_offset: %lu",
-                         static_cast<long unsigned int>(m_offset));
-            CPLDebugOnly("FlatGeobuf", "m_featuresPos: %lu",
-                         static_cast<long unsigned int>(m_featuresPos));
-            CPLDebugOnly("FlatGeobuf", "featureSize: %d", featureSize);
-            return OGRERR_CORRUPT_DATA;
-        }
+        ok = !prefetched->verifyFailed;
+    }
+    else
+    {
+        Verifier v(featureBuf, featureSize);
+        ok = VerifyFeatureBuffer(v);
+    }
+    if (!ok)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Buffer verification failed");
+        CPLDebugOnly("FlatGeobuf", "m_offset: %lu",
+                     static_cast<long unsigned int>(m_offset));
+        CPLDebugOnly("FlatGeobuf", "m_featuresPos: %lu",
+                     static_cast<long unsigned int>(m_featuresPos));
+        CPLDebugOnly("FlatGeobuf", "featureSize: %d", featureSize);
+    }
+    return ok;
+}
+
+/************************************************************************/
+/*                           readGeometry()                             */
+/************************************************************************/
+
+// Returns the geometry of the feature, possibly already decoded by
+// prefetchFeatures(), or nullptr if it has none or in case of error.
+OGRGeometry *OGRFlatGeobufLayer::readGeometry(const Feature *feature,
+                                              PrefetchedFeature *prefetched,
+                                              bool &error)
+{
+    error = false;
+    if (prefetched && prefetched->geometryRead)
+    {
+        error = prefetched->geometryFailed;
+        // The feature may be read again, e.g. by GetNextArrowArray() if
+        // it did not fit in the batch
+        prefetched->geometryRead = false;
+        return prefetched->geometry.release();
     }
 
-    const auto feature = GetRoot<Feature>(m_featureBuf);
     const auto geometry = feature->geometry();
-    if (!m_poFeatureDefn->IsGeometryIgnored() && geometry != nullptr)
+    if (geometry == nullptr)
+        return nullptr;
+    auto geometryType = m_geometryType;
+    if (geometryType == GeometryType::Unknown)
+        geometryType = geometry->type();
+    OGRGeometry *poOGRGeometry =
+        GeometryReader(geometry, geometryType, m_hasZ, m_hasM).read();
+    error = poOGRGeometry == nullptr;
+    return poOGRGeometry;
+}
+
+/************************************************************************/
+/*                           parseFeature()                             */
+/************************************************************************/
+
+OGRErr OGRFlatGeobufLayer::parseFeature(OGRFeature *poFeature, bool &eof)
+{
+    GIntBig fid = 0;
+    const GByte *featureBuf = nullptr;
+    uint32_t featureSize = 0;
+    PrefetchedFeature *prefetched = nullptr;
+    const auto err =
+        readFeatureBuf(fid, featureBuf, featureSize, prefetched, eof);
+    if (err != OGRERR_NONE)
+        return err;
+    if (featureBuf == nullptr)
+        return OGRERR_NONE;
+    poFeature->SetFID(fid);
+
+    if (!verifyFeatureBuf(featureBuf, featureSize, prefetched))
+        return OGRERR_CORRUPT_DATA;
+
+    const auto feature = GetRoot<Feature>(featureBuf);
+    if (!m_poFeatureDefn->IsGeometryIgnored())
     {
-        auto geometryType = m_geometryType;
-        if (geometryType == GeometryType::Unknown)
-            geometryType = geometry->type();
-        OGRGeometry *poOGRGeometry =
-            GeometryReader(geometry, geometryType, m_hasZ, m_hasM).read();
-        if (poOGRGeometry == nullptr)
+        bool error = false;
+        OGRGeometry *poOGRGeometry = readGeometry(feature, prefetched, error);
+        if (error)
         {
             CPLError(CE_Failure, CPLE_AppDefined, "Failed to read geometry");
             return OGRERR_CORRUPT_DATA;
         }
-        // #ifdef DEBUG
-        //             char *wkt;
-        //             poOGRGeometry->exportToWkt(&wkt);
-        //             CPLDebugOnly("FlatGeobuf", "readGeometry as wkt: %s",
-        //             wkt);
-        // #endif
-        if (m_poSRS != nullptr)
-            poOGRGeometry->assignSpatialReference(m_poSRS);
-        poFeature->SetGeometryDirectly(poOGRGeometry);
+        if (poOGRGeometry)
+        {
+            if (m_poSRS != nullptr)
+                poOGRGeometry->assignSpatialReference(m_poSRS);
+            poFeature->SetGeometryDirectly(poOGRGeometry);
+        }
     }
 
     const auto properties = feature->properties();
@@ -1508,109 +2591,39 @@ begin:
             break;
         }
 
-        GIntBig fid;
-        auto seek = false;
-        if (m_queriedSpatialIndex && !m_ignoreSpatialFilter)
-        {
-            const auto item = m_foundItems[m_featuresPos];
-            m_offset = m_offsetFeatures + item.offset;
-            fid = item.index;
-            seek = true;
-        }
-        else
+        GIntBig fid = 0;
+        const GByte *featureBuf = nullptr;
+        uint32_t featureSize = 0;
+        PrefetchedFeature *prefetched = nullptr;
+        bool eof = false;
+        if (readFeatureBuf(fid, featureBuf, featureSize, prefetched, eof) !=
+            OGRERR_NONE)
         {
-            fid = m_featuresPos;
+            goto error;
         }
+        if (featureBuf == nullptr)
+            break;
 
         if (sHelper.m_panFIDValues)
             sHelper.m_panFIDValues[iFeat] = fid;
 
-        if (m_featuresPos == 0)
-            seek = true;
-
-        if (seek && VSIFSeekL(m_poFp, m_offset, SEEK_SET) == -1)
-        {
-            break;
-        }
-        uint32_t featureSize;
-        if (VSIFReadL(&featureSize, sizeof(featureSize), 1, m_poFp) != 1)
-        {
-            if (VSIFEofL(m_poFp))
-                break;
-            CPLErrorIO("reading feature size");
+        if (!verifyFeatureBuf(featureBuf, featureSize, prefetched))
             goto error;
-        }
-        CPL_LSBPTR32(&featureSize);
-
-        // Sanity check to avoid allocated huge amount of memory on corrupted
-        // feature
-        if (featureSize > 100 * 1024 * 1024)
-        {
-            if (featureSize > feature_max_buffer_size)
-            {
-                CPLErrorInvalidSize("feature");
-                goto error;
-            }
-
-            if (m_nFileSize == 0)
-            {
-                VSIStatBufL sStatBuf;
-                if (VSIStatL(m_osFilename.c_str(), &sStatBuf) == 0)
-                {
-                    m_nFileSize = sStatBuf.st_size;
-                }
-            }
-            if (m_offset + featureSize > m_nFileSize)
-            {
-                CPLErrorIO("reading feature size");
-                goto error;
-            }
-        }
 
-        const auto err = ensureFeatureBuf(featureSize);
-        if (err != OGRERR_NONE)
-            goto error;
-        if (VSIFReadL(m_featureBuf, 1, featureSize, m_poFp) != featureSize)
+        const auto feature = GetRoot<Feature>(featureBuf);
+        const auto properties = feature->properties();
+        bool geometryError = false;
+        std::unique_ptr<OGRGeometry> poOGRGeometry;
+        if (!m_poFeatureDefn->IsGeometryIgnored())
+            poOGRGeometry.reset(
+                readGeometry(feature, prefetched, geometryError));
+        if (geometryError)
         {
-            CPLErrorIO("reading feature");
+            CPLError(CE_Failure, CPLE_AppDefined, "Failed to read geometry");
             goto error;
         }
-        m_offset += featureSize + sizeof(featureSize);
-
-        if (m_bVerifyBuffers)
-        {
-            Verifier v(m_featureBuf, featureSize);
-            const auto ok = VerifyFeatureBuffer(v);
-            if (!ok)
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "Buffer verification failed");
-                CPLDebugOnly("FlatGeobuf", "m_offset: %lu",
-                             static_cast<long unsigned int>(m_offset));
-                CPLDebugOnly("FlatGeobuf", "m_featuresPos: %lu",
-                             static_cast<long unsigned int>(m_featuresPos));
-                CPLDebugOnly("FlatGeobuf", "featureSize: %d", featureSize);
-                goto error;
-            }
-        }
-
-        const auto feature = GetRoot<Feature>(m_featureBuf);
-        const auto geometry = feature->geometry();
-        const auto properties = feature->properties();
-        if (!m_poFeatureDefn->IsGeometryIgnored() && geometry != nullptr)
+        if (poOGRGeometry)
         {
-            auto geometryType = m_geometryType;
-            if (geometryType == GeometryType::Unknown)
-                geometryType = geometry->type();
-            auto poOGRGeometry = std::unique_ptr<OGRGeometry>(
-                GeometryReader(geometry, geometryType, m_hasZ, m_hasM).read());
-            if (poOGRGeometry == nullptr)
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "Failed to read geometry");
-                goto error;
-            }
-
             if (!FilterGeometry(poOGRGeometry.get()))
                 goto end_of_loop;
 
@@ -1976,7 +2989,7 @@ begin:
 
     end_of_loop:
 
-        if (VSIFEofL(m_poFp))
+        if (eof)
         {
             CPLDebug("FlatGeobuf", "GetNextFeature: iteration end due to EOF");
             break;
@@ -2366,6 +3379,12 @@ OGRErr OGRFlatGeobufLayer::ICreateFeature(OGRFeature *poNewFeature)
 
         m_featuresCount++;
 
+        if (m_featureItems.size() >= m_nMaxItemsInMemory &&
+            !spillFeatureItems())
+        {
+            return OGRERR_FAILURE;
+        }
+
         return OGRERR_NONE;
     }
     catch (const std::bad_alloc &)
@@ -2428,6 +3447,9 @@ void OGRFlatGeobufLayer::ResetReading()
     m_queriedSpatialIndex = false;
     m_ignoreSpatialFilter = false;
     m_ignoreAttributeFilter = false;
+    m_prefetched.clear();
+    m_prefetchBuf.clear();
+    m_prefetchedStartPos = 0;
     return;
 }
 
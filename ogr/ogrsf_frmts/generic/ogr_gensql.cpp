@@ -35,6 +35,8 @@
 #include "cpl_time.h"
 #include <algorithm>
 #include <limits>
+#include <memory>
+#include <utility>
 #include <vector>
 
 //! @cond Doxygen_Suppress
@@ -502,11 +504,14 @@ OGRGenSQLResultsLayer::~OGRGenSQLResultsLayer()
     /* -------------------------------------------------------------------- */
     /*      Free various datastructures.                                    */
     /* -------------------------------------------------------------------- */
+    m_apoJoinHashTables.clear();
+
     CPLFree(papoTableLayers);
     papoTableLayers = nullptr;
 
     CPLFree(panFIDIndex);
     CPLFree(panGeomFieldToSrcGeomField);
+    ClearSortedSourceFeatures();
 
     delete poSummaryFeature;
     delete static_cast<swq_select *>(pSelectInfo);
@@ -635,6 +640,11 @@ void OGRGenSQLResultsLayer::ResetReading()
     nNextIndexFID = psSelectInfo->offset;
     nIteratedFeatures = -1;
     m_bEOF = false;
+
+    // Joined layers might have been modified since the hash tables were
+    // built.
+    m_apoJoinHashTables.clear();
+    m_bJoinHashTablesBuilt = false;
 }
 
 /************************************************************************/
@@ -670,7 +680,8 @@ OGRErr OGRGenSQLResultsLayer::SetNextByIndex(GIntBig nIndex)
     }
     if (psSelectInfo->query_mode == SWQM_SUMMARY_RECORD ||
         psSelectInfo->query_mode == SWQM_DISTINCT_LIST ||
-        panFIDIndex != nullptr)
+        psSelectInfo->query_mode == SWQM_GROUP_BY || panFIDIndex != nullptr ||
+        m_bOrderBySortedFeatures)
     {
         nNextIndexFID = nIndex + psSelectInfo->offset;
         return OGRERR_NONE;
@@ -741,6 +752,13 @@ GIntBig OGRGenSQLResultsLayer::GetFeatureCount(int bForce)
 
         nRet = psSelectInfo->column_summary[0].count;
     }
+    else if (psSelectInfo->query_mode == SWQM_GROUP_BY)
+    {
+        if (!PrepareSummary())
+            return 0;
+
+        nRet = static_cast<GIntBig>(m_apoGroupByFeatures.size());
+    }
     else if (psSelectInfo->query_mode != SWQM_RECORDSET)
         return 1;
     else if (m_poAttrQuery == nullptr && !MustEvaluateSpatialFilterOnGenSQL())
@@ -773,7 +791,9 @@ int OGRGenSQLResultsLayer::TestCapability(const char *pszCap)
     {
         if (psSelectInfo->query_mode == SWQM_SUMMARY_RECORD ||
             psSelectInfo->query_mode == SWQM_DISTINCT_LIST ||
-            panFIDIndex != nullptr)
+            psSelectInfo->query_mode == SWQM_GROUP_BY ||
+            panFIDIndex != nullptr ||
+            (m_bOrderBySortedFeatures && m_apoOrderByRuns.empty()))
             return TRUE;
         else
             return poSrcLayer->TestCapability(pszCap);
@@ -826,6 +846,364 @@ int OGRGenSQLResultsLayer::ContainGeomSpecialField(swq_expr_node *expr)
     return FALSE;
 }
 
+/************************************************************************/
+/*                          GetSummaryValue()                           */
+/*                                                                      */
+/*      Return whether a source feature contributes to the summary of   */
+/*      a column, and in that case the value to accumulate.             */
+/************************************************************************/
+
+static bool GetSummaryValue(OGRFeature *poSrcFeature,
+                            const swq_col_def *psColDef, const char *&pszVal)
+{
+    pszVal = nullptr;
+    if (psColDef->col_func == SWQCF_COUNT)
+    {
+        /* psColDef->field_index can be -1 in the case of a COUNT(*) */
+        if (psColDef->field_index < 0)
+            pszVal = "";
+        else if (IS_GEOM_FIELD_INDEX(poSrcFeature->GetDefnRef(),
+                                     psColDef->field_index))
+        {
+            int iSrcGeomField = ALL_FIELD_INDEX_TO_GEOM_FIELD_INDEX(
+                poSrcFeature->GetDefnRef(), psColDef->field_index);
+            if (poSrcFeature->GetGeomFieldRef(iSrcGeomField) == nullptr)
+                return false;
+            pszVal = "";
+        }
+        else if (poSrcFeature->IsFieldSetAndNotNull(psColDef->field_index))
+            pszVal = poSrcFeature->GetFieldAsString(psColDef->field_index);
+        else
+            return false;
+    }
+    else if (poSrcFeature->IsFieldSetAndNotNull(psColDef->field_index))
+    {
+        pszVal = poSrcFeature->GetFieldAsString(psColDef->field_index);
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                        SetFieldFromSummary()                         */
+/************************************************************************/
+
+static void SetFieldFromSummary(OGRFeature *poFeature, int iField,
+                                const swq_col_def *psColDef,
+                                const swq_summary &oSummary)
+{
+    if (psColDef->col_func == SWQCF_AVG && oSummary.count > 0)
+    {
+        if (psColDef->field_type == SWQ_DATE ||
+            psColDef->field_type == SWQ_TIME ||
+            psColDef->field_type == SWQ_TIMESTAMP)
+        {
+            struct tm brokendowntime;
+            double dfAvg = oSummary.sum / oSummary.count;
+            CPLUnixTimeToYMDHMS(static_cast<GIntBig>(dfAvg), &brokendowntime);
+            poFeature->SetField(
+                iField, brokendowntime.tm_year + 1900,
+                brokendowntime.tm_mon + 1, brokendowntime.tm_mday,
+                brokendowntime.tm_hour, brokendowntime.tm_min,
+                static_cast<float>(brokendowntime.tm_sec + fmod(dfAvg, 1)), 0);
+        }
+        else
+            poFeature->SetField(iField, oSummary.sum / oSummary.count);
+    }
+    else if (psColDef->col_func == SWQCF_MIN && oSummary.count > 0)
+    {
+        if (psColDef->field_type == SWQ_DATE ||
+            psColDef->field_type == SWQ_TIME ||
+            psColDef->field_type == SWQ_TIMESTAMP ||
+            psColDef->field_type == SWQ_STRING)
+            poFeature->SetField(iField, oSummary.osMin.c_str());
+        else
+            poFeature->SetField(iField, oSummary.min);
+    }
+    else if (psColDef->col_func == SWQCF_MAX && oSummary.count > 0)
+    {
+        if (psColDef->field_type == SWQ_DATE ||
+            psColDef->field_type == SWQ_TIME ||
+            psColDef->field_type == SWQ_TIMESTAMP ||
+            psColDef->field_type == SWQ_STRING)
+            poFeature->SetField(iField, oSummary.osMax.c_str());
+        else
+            poFeature->SetField(iField, oSummary.max);
+    }
+    else if (psColDef->col_func == SWQCF_COUNT)
+        poFeature->SetField(iField, oSummary.count);
+    else if (psColDef->col_func == SWQCF_SUM && oSummary.count > 0)
+        poFeature->SetField(iField, oSummary.sum);
+}
+
+/************************************************************************/
+/*                          BuildGroupByKey()                           */
+/*                                                                      */
+/*      Build the key identifying the group of a source feature, from   */
+/*      the values of the GROUP BY fields.                              */
+/************************************************************************/
+
+static void BuildGroupByKey(const swq_select *psSelectInfo,
+                            OGRFeature *poSrcFeature, std::string &osKey)
+{
+    osKey.clear();
+    const int nFieldCount = poSrcFeature->GetFieldCount();
+    for (int iKey = 0; iKey < psSelectInfo->group_by_specs; iKey++)
+    {
+        const int iSrcField = psSelectInfo->group_by_defs[iKey].field_index;
+        if (iSrcField >= nFieldCount)
+        {
+            // Special field
+            osKey += poSrcFeature->GetFieldAsString(iSrcField);
+            osKey += '\0';
+            continue;
+        }
+
+        if (!poSrcFeature->IsFieldSetAndNotNull(iSrcField))
+        {
+            osKey += '\0';
+            continue;
+        }
+        osKey += '\1';
+
+        const OGRField *psField = poSrcFeature->GetRawFieldRef(iSrcField);
+        switch (poSrcFeature->GetFieldDefnRef(iSrcField)->GetType())
+        {
+            case OFTInteger:
+                osKey.append(reinterpret_cast<const char *>(&psField->Integer),
+                             sizeof(psField->Integer));
+                break;
+
+            case OFTInteger64:
+                osKey.append(
+                    reinterpret_cast<const char *>(&psField->Integer64),
+                    sizeof(psField->Integer64));
+                break;
+
+            case OFTReal:
+            {
+                // 0.0 and -0.0 belong to the same group
+                const double dfVal = psField->Real == 0 ? 0.0 : psField->Real;
+                osKey.append(reinterpret_cast<const char *>(&dfVal),
+                             sizeof(dfVal));
+                break;
+            }
+
+            case OFTString:
+                osKey += psField->String;
+                osKey += '\0';
+                break;
+
+            default:
+                osKey += poSrcFeature->GetFieldAsString(iSrcField);
+                osKey += '\0';
+                break;
+        }
+    }
+}
+
+/************************************************************************/
+/*                           PrepareGroupBy()                           */
+/*                                                                      */
+/*      Aggregate the source features in a hash table keyed on the      */
+/*      values of the GROUP BY fields, and build one result feature     */
+/*      per group, ordered according to the ORDER BY clause if there    */
+/*      is one, or in the order in which groups were first met.         */
+/************************************************************************/
+
+int OGRGenSQLResultsLayer::PrepareGroupBy()
+
+{
+    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
+    const int nColumns = psSelectInfo->result_columns();
+    const int nOrderItems = psSelectInfo->order_specs;
+
+    m_apoGroupByFeatures.clear();
+
+    struct Group
+    {
+        std::unique_ptr<OGRFeature> poFeature{};
+        std::vector<swq_summary> aoSummaries{};
+    };
+
+    std::vector<Group> aoGroups;
+    std::unordered_map<std::string, size_t> oMapKeyToGroup;
+    // nOrderItems values of the ORDER BY fields per group
+    std::vector<OGRField> asOrderFields;
+    std::string osKey;
+    const char *pszError = nullptr;
+
+    try
+    {
+        while (pszError == nullptr)
+        {
+            std::unique_ptr<OGRFeature> poSrcFeature(
+                poSrcLayer->GetNextFeature());
+            if (poSrcFeature == nullptr)
+                break;
+
+            BuildGroupByKey(psSelectInfo, poSrcFeature.get(), osKey);
+
+            size_t iGroup;
+            const auto oIter = oMapKeyToGroup.find(osKey);
+            if (oIter != oMapKeyToGroup.end())
+            {
+                iGroup = oIter->second;
+            }
+            else
+            {
+                iGroup = aoGroups.size();
+                oMapKeyToGroup[osKey] = iGroup;
+
+                Group oGroup;
+                oGroup.poFeature = std::make_unique<OGRFeature>(poDefn);
+                oGroup.aoSummaries.resize(nColumns);
+
+                // Columns without aggregate function are GROUP BY fields,
+                // whose value is the same for all features of the group.
+                for (int iField = 0; iField < nColumns; iField++)
+                {
+                    const swq_col_def *psColDef =
+                        &psSelectInfo->column_defs[iField];
+                    if (psColDef->col_func != SWQCF_NONE)
+                        continue;
+
+                    const int iSrcField = psColDef->field_index;
+                    if (iSrcField >= iFIDFieldIndex)
+                    {
+                        switch (SpecialFieldTypes[iSrcField - iFIDFieldIndex])
+                        {
+                            case SWQ_INTEGER:
+                            case SWQ_INTEGER64:
+                                oGroup.poFeature->SetField(
+                                    iField, poSrcFeature->GetFieldAsInteger64(
+                                                iSrcField));
+                                break;
+
+                            case SWQ_FLOAT:
+                                oGroup.poFeature->SetField(
+                                    iField,
+                                    poSrcFeature->GetFieldAsDouble(iSrcField));
+                                break;
+
+                            default:
+                                oGroup.poFeature->SetField(
+                                    iField,
+                                    poSrcFeature->GetFieldAsString(iSrcField));
+                                break;
+                        }
+                    }
+                    else if (poSrcFeature->IsFieldNull(iSrcField))
+                    {
+                        oGroup.poFeature->SetFieldNull(iField);
+                    }
+                    else if (poSrcFeature->IsFieldSet(iSrcField))
+                    {
+                        oGroup.poFeature->SetField(
+                            iField, poSrcFeature->GetRawFieldRef(iSrcField));
+                    }
+                }
+                aoGroups.push_back(std::move(oGroup));
+
+                if (nOrderItems > 0)
+                {
+                    asOrderFields.resize(asOrderFields.size() + nOrderItems);
+                    OGRField *pasFields =
+                        asOrderFields.data() + iGroup * nOrderItems;
+                    for (int iKey = 0; iKey < nOrderItems; iKey++)
+                        OGR_RawField_SetUnset(&pasFields[iKey]);
+                    ReadIndexFields(poSrcFeature.get(), nOrderItems,
+                                    pasFields);
+                }
+            }
+
+            Group &oGroup = aoGroups[iGroup];
+            for (int iField = 0; pszError == nullptr && iField < nColumns;
+                 iField++)
+            {
+                const swq_col_def *psColDef =
+                    &psSelectInfo->column_defs[iField];
+                const char *pszVal = nullptr;
+                if (psColDef->col_func != SWQCF_NONE &&
+                    GetSummaryValue(poSrcFeature.get(), psColDef, pszVal))
+                {
+                    pszError = swq_summary_accumulate(
+                        psColDef, oGroup.aoSummaries[iField], pszVal);
+                }
+            }
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        pszError = "Out of memory";
+    }
+
+    if (pszError != nullptr)
+    {
+        if (nOrderItems > 0)
+            FreeIndexFields(asOrderFields.data(),
+                            asOrderFields.size() / nOrderItems, false);
+        CPLError(CE_Failure, CPLE_AppDefined, "%s", pszError);
+        return FALSE;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      As in summary mode, COUNT() columns are reported as Integer     */
+    /*      when all their values fit on it.                                */
+    /* -------------------------------------------------------------------- */
+    for (int iField = 0; iField < nColumns; iField++)
+    {
+        if (psSelectInfo->column_defs[iField].col_func != SWQCF_COUNT)
+            continue;
+        bool bFitsOnInt32 = true;
+        for (const auto &oGroup : aoGroups)
+        {
+            if (!CPL_INT64_FITS_ON_INT32(oGroup.aoSummaries[iField].count))
+            {
+                bFitsOnInt32 = false;
+                break;
+            }
+        }
+        if (bFitsOnInt32)
+            poDefn->GetFieldDefn(iField)->SetType(OFTInteger);
+    }
+
+    for (auto &oGroup : aoGroups)
+    {
+        for (int iField = 0; iField < nColumns; iField++)
+        {
+            const swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
+            if (psColDef->col_func != SWQCF_NONE)
+                SetFieldFromSummary(oGroup.poFeature.get(), iField, psColDef,
+                                    oGroup.aoSummaries[iField]);
+        }
+    }
+
+    std::vector<size_t> anOrder(aoGroups.size());
+    for (size_t i = 0; i < anOrder.size(); i++)
+        anOrder[i] = i;
+    if (nOrderItems > 0)
+    {
+        std::stable_sort(
+            anOrder.begin(), anOrder.end(),
+            [this, &asOrderFields, nOrderItems](size_t a, size_t b)
+            {
+                return Compare(asOrderFields.data() + a * nOrderItems,
+                               asOrderFields.data() + b * nOrderItems) < 0;
+            });
+        FreeIndexFields(asOrderFields.data(), aoGroups.size(), false);
+    }
+
+    m_apoGroupByFeatures.reserve(aoGroups.size());
+    for (size_t i = 0; i < anOrder.size(); i++)
+    {
+        auto poFeature = std::move(aoGroups[anOrder[i]].poFeature);
+        poFeature->SetFID(static_cast<GIntBig>(i));
+        m_apoGroupByFeatures.push_back(std::move(poFeature));
+    }
+
+    return TRUE;
+}
+
 /************************************************************************/
 /*                           PrepareSummary()                           */
 /************************************************************************/
@@ -897,7 +1275,8 @@ int OGRGenSQLResultsLayer::PrepareSummary()
     /*      GetFeatureCount().                                            */
     /* -------------------------------------------------------------------- */
 
-    if (psSelectInfo->result_columns() == 1 &&
+    if (psSelectInfo->query_mode == SWQM_SUMMARY_RECORD &&
+        psSelectInfo->result_columns() == 1 &&
         psSelectInfo->column_defs[0].col_func == SWQCF_COUNT &&
         psSelectInfo->column_defs[0].field_index < 0)
     {
@@ -917,6 +1296,24 @@ int OGRGenSQLResultsLayer::PrepareSummary()
         return TRUE;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      With GROUP BY, aggregate the source features per group.         */
+    /* -------------------------------------------------------------------- */
+    if (psSelectInfo->query_mode == SWQM_GROUP_BY)
+    {
+        const int bRet = PrepareGroupBy();
+
+        poSrcLayer->GetLayerDefn()->SetGeometryIgnored(bSaveIsGeomIgnored);
+        ClearFilters();
+
+        if (!bRet)
+        {
+            delete poSummaryFeature;
+            poSummaryFeature = nullptr;
+        }
+        return bRet;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Otherwise, process all source feature through the summary       */
     /*      building facilities of SWQ.                                     */
@@ -930,40 +1327,11 @@ int OGRGenSQLResultsLayer::PrepareSummary()
         {
             swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
 
-            if (psColDef->col_func == SWQCF_COUNT)
-            {
-                /* psColDef->field_index can be -1 in the case of a COUNT(*) */
-                if (psColDef->field_index < 0)
-                    pszError = swq_select_summarize(psSelectInfo, iField, "");
-                else if (IS_GEOM_FIELD_INDEX(poSrcLayer->GetLayerDefn(),
-                                             psColDef->field_index))
-                {
-                    int iSrcGeomField = ALL_FIELD_INDEX_TO_GEOM_FIELD_INDEX(
-                        poSrcLayer->GetLayerDefn(), psColDef->field_index);
-                    OGRGeometry *poGeom =
-                        poSrcFeature->GetGeomFieldRef(iSrcGeomField);
-                    if (poGeom != nullptr)
-                        pszError =
-                            swq_select_summarize(psSelectInfo, iField, "");
-                    else
-                        pszError = nullptr;
-                }
-                else if (poSrcFeature->IsFieldSetAndNotNull(
-                             psColDef->field_index))
-                    pszError = swq_select_summarize(
-                        psSelectInfo, iField,
-                        poSrcFeature->GetFieldAsString(psColDef->field_index));
-                else
-                    pszError = nullptr;
-            }
-            else
-            {
-                const char *pszVal = nullptr;
-                if (poSrcFeature->IsFieldSetAndNotNull(psColDef->field_index))
-                    pszVal =
-                        poSrcFeature->GetFieldAsString(psColDef->field_index);
+            const char *pszVal = nullptr;
+            if (GetSummaryValue(poSrcFeature, psColDef, pszVal))
                 pszError = swq_select_summarize(psSelectInfo, iField, pszVal);
-            }
+            else
+                pszError = nullptr;
 
             if (pszError != nullptr)
             {
@@ -1025,56 +1393,8 @@ int OGRGenSQLResultsLayer::PrepareSummary()
             swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
             if (!psSelectInfo->column_summary.empty())
             {
-                swq_summary &oSummary = psSelectInfo->column_summary[iField];
-
-                if (psColDef->col_func == SWQCF_AVG && oSummary.count > 0)
-                {
-                    if (psColDef->field_type == SWQ_DATE ||
-                        psColDef->field_type == SWQ_TIME ||
-                        psColDef->field_type == SWQ_TIMESTAMP)
-                    {
-                        struct tm brokendowntime;
-                        double dfAvg = oSummary.sum / oSummary.count;
-                        CPLUnixTimeToYMDHMS(static_cast<GIntBig>(dfAvg),
-                                            &brokendowntime);
-                        poSummaryFeature->SetField(
-                            iField, brokendowntime.tm_year + 1900,
-                            brokendowntime.tm_mon + 1, brokendowntime.tm_mday,
-                            brokendowntime.tm_hour, brokendowntime.tm_min,
-                            static_cast<float>(brokendowntime.tm_sec +
-                                               fmod(dfAvg, 1)),
-                            0);
-                    }
-                    else
-                        poSummaryFeature->SetField(iField, oSummary.sum /
-                                                               oSummary.count);
-                }
-                else if (psColDef->col_func == SWQCF_MIN && oSummary.count > 0)
-                {
-                    if (psColDef->field_type == SWQ_DATE ||
-                        psColDef->field_type == SWQ_TIME ||
-                        psColDef->field_type == SWQ_TIMESTAMP ||
-                        psColDef->field_type == SWQ_STRING)
-                        poSummaryFeature->SetField(iField,
-                                                   oSummary.osMin.c_str());
-                    else
-                        poSummaryFeature->SetField(iField, oSummary.min);
-                }
-                else if (psColDef->col_func == SWQCF_MAX && oSummary.count > 0)
-                {
-                    if (psColDef->field_type == SWQ_DATE ||
-                        psColDef->field_type == SWQ_TIME ||
-                        psColDef->field_type == SWQ_TIMESTAMP ||
-                        psColDef->field_type == SWQ_STRING)
-                        poSummaryFeature->SetField(iField,
-                                                   oSummary.osMax.c_str());
-                    else
-                        poSummaryFeature->SetField(iField, oSummary.max);
-                }
-                else if (psColDef->col_func == SWQCF_COUNT)
-                    poSummaryFeature->SetField(iField, oSummary.count);
-                else if (psColDef->col_func == SWQCF_SUM && oSummary.count > 0)
-                    poSummaryFeature->SetField(iField, oSummary.sum);
+                SetFieldFromSummary(poSummaryFeature, iField, psColDef,
+                                    psSelectInfo->column_summary[iField]);
             }
             else if (psColDef->col_func == SWQCF_COUNT)
                 poSummaryFeature->SetField(iField, 0);
@@ -1300,64 +1620,322 @@ static CPLString GetFilterForJoin(swq_expr_node *poExpr, OGRFeature *poSrcFeat,
 }
 
 /************************************************************************/
-/*                          TranslateFeature()                          */
+/*                       EstimateFeatureMemory()                        */
 /************************************************************************/
 
-OGRFeature *OGRGenSQLResultsLayer::TranslateFeature(OGRFeature *poSrcFeat)
-
+static size_t EstimateFeatureMemory(const OGRFeature *poFeature)
 {
-    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
-    std::vector<OGRFeature *> apoFeatures;
+    const OGRFeatureDefn *poFDefn = poFeature->GetDefnRef();
+    size_t nSize = sizeof(OGRFeature) +
+                   poFDefn->GetFieldCount() * sizeof(OGRField) +
+                   poFDefn->GetGeomFieldCount() * sizeof(OGRGeometry *);
+    for (int iField = 0; iField < poFDefn->GetFieldCount(); iField++)
+    {
+        if (!poFeature->IsFieldSetAndNotNull(iField))
+            continue;
+        const OGRField *psField = poFeature->GetRawFieldRef(iField);
+        switch (poFDefn->GetFieldDefn(iField)->GetType())
+        {
+            case OFTString:
+                nSize += strlen(psField->String) + 1;
+                break;
+            case OFTIntegerList:
+                nSize += psField->IntegerList.nCount * sizeof(int);
+                break;
+            case OFTInteger64List:
+                nSize += psField->Integer64List.nCount * sizeof(GIntBig);
+                break;
+            case OFTRealList:
+                nSize += psField->RealList.nCount * sizeof(double);
+                break;
+            case OFTStringList:
+                for (int i = 0; i < psField->StringList.nCount; i++)
+                {
+                    nSize += sizeof(char *) +
+                             strlen(psField->StringList.paList[i]) + 1;
+                }
+                break;
+            case OFTBinary:
+                nSize += psField->Binary.nCount;
+                break;
+            default:
+                break;
+        }
+    }
+    for (int iGeomField = 0; iGeomField < poFDefn->GetGeomFieldCount();
+         iGeomField++)
+    {
+        const OGRGeometry *poGeom = poFeature->GetGeomFieldRef(iGeomField);
+        if (poGeom)
+            nSize += poGeom->WkbSize();
+    }
+    return nSize;
+}
 
-    if (poSrcFeat == nullptr)
-        return nullptr;
+/************************************************************************/
+/*                        BuildJoinHashTables()                         */
+/*                                                                      */
+/*      For joins of the form primary.field = secondary.field on        */
+/*      integer or string fields, load the joined layer once in         */
+/*      memory, indexed on its join field, instead of installing an     */
+/*      attribute filter on it for each primary feature. Falls back     */
+/*      to attribute filters if that would exceed the memory budget.    */
+/************************************************************************/
 
-    m_nFeaturesRead++;
+void OGRGenSQLResultsLayer::BuildJoinHashTables()
+{
+    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
 
-    apoFeatures.push_back(poSrcFeat);
+    m_bJoinHashTablesBuilt = true;
+    m_apoJoinHashTables.clear();
+    m_apoJoinHashTables.resize(psSelectInfo->join_count);
 
-    /* -------------------------------------------------------------------- */
-    /*      Fetch the corresponding features from any jointed tables.       */
-    /* -------------------------------------------------------------------- */
-    for (int iJoin = 0; iJoin < psSelectInfo->join_count; iJoin++)
+    GIntBig nMaxMemory = 0;
+    const char *pszMaxMemory =
+        CPLGetConfigOption("OGR_SQL_JOIN_HASH_MAX_MEMORY", nullptr);
+    if (pszMaxMemory)
     {
-        CPLString osFilter;
+        nMaxMemory = CPLAtoGIntBig(pszMaxMemory);
+    }
+    else
+    {
+        nMaxMemory = CPLGetUsablePhysicalRAM() / 4;
+        if (nMaxMemory <= 0)
+            nMaxMemory = 256 * 1024 * 1024;
+    }
+    GIntBig nUsedMemory = 0;
 
+    OGRFeatureDefn *poPrimaryDefn = poSrcLayer->GetLayerDefn();
+    for (int iJoin = 0; iJoin < psSelectInfo->join_count && nMaxMemory > 0;
+         iJoin++)
+    {
         swq_join_def *psJoinInfo = psSelectInfo->join_defs + iJoin;
-
-        /* OGRMultiFeatureFetcher assumes that the features are pushed in */
-        /* apoFeatures with increasing secondary_table, so make sure */
-        /* we have taken care of this */
-        CPLAssert(psJoinInfo->secondary_table == iJoin + 1);
-
+        const swq_expr_node *poExpr = psJoinInfo->poExpr;
         OGRLayer *poJoinLayer = papoTableLayers[psJoinInfo->secondary_table];
 
-        osFilter = GetFilterForJoin(psJoinInfo->poExpr, poSrcFeat, poJoinLayer,
-                                    psJoinInfo->secondary_table);
-        // CPLDebug("OGR", "Filter = %s\n", osFilter.c_str());
+        // Reading the primary layer while scanning it as a joined layer is
+        // not possible.
+        if (poJoinLayer == poSrcLayer)
+            continue;
 
-        // if source key is null, we can't do join.
-        if (osFilter.empty())
-        {
-            apoFeatures.push_back(nullptr);
+        if (poExpr->eNodeType != SNT_OPERATION ||
+            poExpr->nOperation != SWQ_EQ || poExpr->nSubExprCount != 2 ||
+            poExpr->papoSubExpr[0]->eNodeType != SNT_COLUMN ||
+            poExpr->papoSubExpr[1]->eNodeType != SNT_COLUMN)
             continue;
-        }
 
-        OGRFeature *poJoinFeature = nullptr;
+        const swq_expr_node *poPrimaryCol = poExpr->papoSubExpr[0];
+        const swq_expr_node *poSecondaryCol = poExpr->papoSubExpr[1];
+        if (poPrimaryCol->table_index != 0)
+            std::swap(poPrimaryCol, poSecondaryCol);
+        if (poPrimaryCol->table_index != 0 ||
+            poSecondaryCol->table_index != psJoinInfo->secondary_table)
+            continue;
 
-        poJoinLayer->ResetReading();
-        if (poJoinLayer->SetAttributeFilter(osFilter.c_str()) == OGRERR_NONE)
-            poJoinFeature = poJoinLayer->GetNextFeature();
+        // Exclude special fields (FID, OGR_GEOMETRY, etc.)
+        OGRFeatureDefn *poJoinDefn = poJoinLayer->GetLayerDefn();
+        if (poPrimaryCol->field_index < 0 ||
+            poPrimaryCol->field_index >= poPrimaryDefn->GetFieldCount() ||
+            poSecondaryCol->field_index < 0 ||
+            poSecondaryCol->field_index >= poJoinDefn->GetFieldCount())
+            continue;
 
-        apoFeatures.push_back(poJoinFeature);
-    }
+        // Only types for which the = operator is a simple equality test of
+        // the key values.
+        const auto IsIntegerType = [](OGRFieldType eType)
+        { return eType == OFTInteger || eType == OFTInteger64; };
+        const OGRFieldType ePrimaryType =
+            poPrimaryDefn->GetFieldDefn(poPrimaryCol->field_index)->GetType();
+        const OGRFieldType eSecondaryType =
+            poJoinDefn->GetFieldDefn(poSecondaryCol->field_index)->GetType();
+        const bool bIntegerKey =
+            IsIntegerType(ePrimaryType) && IsIntegerType(eSecondaryType);
+        if (!bIntegerKey &&
+            !(ePrimaryType == OFTString && eSecondaryType == OFTString))
+            continue;
 
-    /* -------------------------------------------------------------------- */
-    /*      Create destination feature.                                     */
-    /* -------------------------------------------------------------------- */
-    OGRFeature *poDstFeat = new OGRFeature(poDefn);
+        auto poTable = std::make_unique<JoinHashTable>();
+        poTable->iPrimaryField = poPrimaryCol->field_index;
+        poTable->iSecondaryField = poSecondaryCol->field_index;
+        poTable->bIntegerKey = bIntegerKey;
 
-    poDstFeat->SetFID(poSrcFeat->GetFID());
+        GIntBig nTableMemory = 0;
+        bool bOK = true;
+        poJoinLayer->SetAttributeFilter(nullptr);
+        poJoinLayer->ResetReading();
+        while (true)
+        {
+            std::unique_ptr<OGRFeature> poFeature(
+                poJoinLayer->GetNextFeature());
+            if (!poFeature)
+                break;
+            if (!poFeature->IsFieldSetAndNotNull(poTable->iSecondaryField))
+                continue;
+
+            const size_t nFeatureMemory =
+                EstimateFeatureMemory(poFeature.get());
+            // Only the first matching feature is used by joins.
+            bool bInserted;
+            if (bIntegerKey)
+            {
+                const GIntBig nKey =
+                    poFeature->GetFieldAsInteger64(poTable->iSecondaryField);
+                bInserted = poTable->oMapInteger
+                                .emplace(nKey, std::move(poFeature))
+                                .second;
+            }
+            else
+            {
+                CPLString osKey(
+                    poFeature->GetFieldAsString(poTable->iSecondaryField));
+                osKey.toupper();
+                bInserted = poTable->oMapString
+                                .emplace(std::move(osKey), std::move(poFeature))
+                                .second;
+            }
+            if (bInserted)
+            {
+                // Add a rough estimate of the hash table node overhead.
+                nTableMemory += nFeatureMemory + 64;
+                if (nUsedMemory + nTableMemory > nMaxMemory)
+                {
+                    CPLDebug("GenSQL",
+                             "Joined layer %s does not fit in "
+                             "OGR_SQL_JOIN_HASH_MAX_MEMORY=" CPL_FRMT_GIB
+                             " bytes. Using attribute filters instead",
+                             poJoinLayer->GetName(), nMaxMemory);
+                    bOK = false;
+                    break;
+                }
+            }
+        }
+        poJoinLayer->ResetReading();
+
+        if (bOK)
+        {
+            nUsedMemory += nTableMemory;
+            m_apoJoinHashTables[iJoin] = std::move(poTable);
+        }
+    }
+}
+
+/************************************************************************/
+/*                        LookupJoinHashTable()                         */
+/*                                                                      */
+/*      Returns false if the join of poSrcFeat cannot be resolved with  */
+/*      the hash table, and an attribute filter must be used instead.   */
+/*      Otherwise, poJoinFeature is set to the matching feature (owned  */
+/*      by the hash table), or nullptr if there is none.                */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::LookupJoinHashTable(int iJoin,
+                                                OGRFeature *poSrcFeat,
+                                                OGRFeature *&poJoinFeature)
+{
+    const JoinHashTable *poTable = m_apoJoinHashTables[iJoin].get();
+    if (poTable == nullptr)
+        return false;
+
+    poJoinFeature = nullptr;
+    if (!poSrcFeat->IsFieldSetAndNotNull(poTable->iPrimaryField))
+        return true;
+
+    if (poTable->bIntegerKey)
+    {
+        const auto oIter = poTable->oMapInteger.find(
+            poSrcFeat->GetFieldAsInteger64(poTable->iPrimaryField));
+        if (oIter != poTable->oMapInteger.end())
+            poJoinFeature = oIter->second.get();
+        return true;
+    }
+
+    const char *pszKey = poSrcFeat->GetFieldAsString(poTable->iPrimaryField);
+    // The = operator has special rules for values that look like
+    // timestamps, to be able to ignore the +00 timezone suffix.
+    const size_t nKeyLen = strlen(pszKey);
+    if (nKeyLen > 3 &&
+        (strcmp(pszKey + nKeyLen - 3, "+00") == 0 ||
+         pszKey[nKeyLen - 3] == ':'))
+        return false;
+
+    CPLString osKey(pszKey);
+    osKey.toupper();
+    const auto oIter = poTable->oMapString.find(osKey);
+    if (oIter != poTable->oMapString.end())
+        poJoinFeature = oIter->second.get();
+    return true;
+}
+
+/************************************************************************/
+/*                          TranslateFeature()                          */
+/************************************************************************/
+
+OGRFeature *OGRGenSQLResultsLayer::TranslateFeature(OGRFeature *poSrcFeat)
+
+{
+    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
+    std::vector<OGRFeature *> apoFeatures;
+    // Joined features not owned by a join hash table.
+    std::vector<std::unique_ptr<OGRFeature>> apoOwnedJoinFeatures;
+
+    if (poSrcFeat == nullptr)
+        return nullptr;
+
+    m_nFeaturesRead++;
+
+    apoFeatures.push_back(poSrcFeat);
+
+    if (psSelectInfo->join_count > 0 && !m_bJoinHashTablesBuilt)
+        BuildJoinHashTables();
+
+    /* -------------------------------------------------------------------- */
+    /*      Fetch the corresponding features from any jointed tables.       */
+    /* -------------------------------------------------------------------- */
+    for (int iJoin = 0; iJoin < psSelectInfo->join_count; iJoin++)
+    {
+        CPLString osFilter;
+
+        swq_join_def *psJoinInfo = psSelectInfo->join_defs + iJoin;
+
+        /* OGRMultiFeatureFetcher assumes that the features are pushed in */
+        /* apoFeatures with increasing secondary_table, so make sure */
+        /* we have taken care of this */
+        CPLAssert(psJoinInfo->secondary_table == iJoin + 1);
+
+        OGRFeature *poJoinFeature = nullptr;
+        if (LookupJoinHashTable(iJoin, poSrcFeat, poJoinFeature))
+        {
+            apoFeatures.push_back(poJoinFeature);
+            continue;
+        }
+
+        OGRLayer *poJoinLayer = papoTableLayers[psJoinInfo->secondary_table];
+
+        osFilter = GetFilterForJoin(psJoinInfo->poExpr, poSrcFeat, poJoinLayer,
+                                    psJoinInfo->secondary_table);
+        // CPLDebug("OGR", "Filter = %s\n", osFilter.c_str());
+
+        // if source key is null, we can't do join.
+        if (osFilter.empty())
+        {
+            apoFeatures.push_back(nullptr);
+            continue;
+        }
+
+        poJoinLayer->ResetReading();
+        if (poJoinLayer->SetAttributeFilter(osFilter.c_str()) == OGRERR_NONE)
+            poJoinFeature = poJoinLayer->GetNextFeature();
+
+        apoFeatures.push_back(poJoinFeature);
+        apoOwnedJoinFeatures.emplace_back(poJoinFeature);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Create destination feature.                                     */
+    /* -------------------------------------------------------------------- */
+    OGRFeature *poDstFeat = new OGRFeature(poDefn);
+
+    poDstFeat->SetFID(poSrcFeat->GetFID());
 
     poDstFeat->SetStyleString(poSrcFeat->GetStyleString());
     poDstFeat->SetNativeData(poSrcFeat->GetNativeData());
@@ -1591,8 +2169,6 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature(OGRFeature *poSrcFeat)
 
             iRegularField++;
         }
-
-        delete poJoinFeature;
     }
 
     return poDstFeat;
@@ -1614,8 +2190,9 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
         return nullptr;
 
     CreateOrderByIndex();
-    if (panFIDIndex == nullptr && nIteratedFeatures < 0 &&
-        psSelectInfo->offset > 0 && psSelectInfo->query_mode == SWQM_RECORDSET)
+    if (panFIDIndex == nullptr && !m_bOrderBySortedFeatures &&
+        nIteratedFeatures < 0 && psSelectInfo->offset > 0 &&
+        psSelectInfo->query_mode == SWQM_RECORDSET)
     {
         poSrcLayer->SetNextByIndex(psSelectInfo->offset);
     }
@@ -1626,7 +2203,8 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
     /*      Handle summary sets.                                            */
     /* -------------------------------------------------------------------- */
     if (psSelectInfo->query_mode == SWQM_SUMMARY_RECORD ||
-        psSelectInfo->query_mode == SWQM_DISTINCT_LIST)
+        psSelectInfo->query_mode == SWQM_DISTINCT_LIST ||
+        psSelectInfo->query_mode == SWQM_GROUP_BY)
     {
         nIteratedFeatures++;
         return GetFeature(nNextIndexFID++);
@@ -1640,7 +2218,12 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
     while (true)
     {
         std::unique_ptr<OGRFeature> poSrcFeat;
-        if (panFIDIndex != nullptr)
+        if (m_bOrderBySortedFeatures)
+        {
+            poSrcFeat = GetSortedSourceFeature(nNextIndexFID);
+            nNextIndexFID++;
+        }
+        else if (panFIDIndex != nullptr)
         {
             /* --------------------------------------------------------------------
              */
@@ -1771,6 +2354,18 @@ OGRFeature *OGRGenSQLResultsLayer::GetFeature(GIntBig nFID)
         return poSummaryFeature->Clone();
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Handle request for a GROUP BY record.                           */
+    /* -------------------------------------------------------------------- */
+    if (psSelectInfo->query_mode == SWQM_GROUP_BY)
+    {
+        if (!PrepareSummary() || nFID < 0 ||
+            nFID >= static_cast<GIntBig>(m_apoGroupByFeatures.size()))
+            return nullptr;
+
+        return m_apoGroupByFeatures[static_cast<size_t>(nFID)]->Clone();
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Handle request for random record.                               */
     /* -------------------------------------------------------------------- */
@@ -1800,7 +2395,8 @@ OGRFeatureDefn *OGRGenSQLResultsLayer::GetLayerDefn()
 
 {
     swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
-    if (psSelectInfo->query_mode == SWQM_SUMMARY_RECORD &&
+    if ((psSelectInfo->query_mode == SWQM_SUMMARY_RECORD ||
+         psSelectInfo->query_mode == SWQM_GROUP_BY) &&
         poSummaryFeature == nullptr)
     {
         // Run PrepareSummary() is we have a COUNT column so as to be
@@ -1971,6 +2567,17 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
 
     ResetReading();
 
+    /* -------------------------------------------------------------------- */
+    /*      Fetching features by FID would be slow: sort the features       */
+    /*      themselves.                                                     */
+    /* -------------------------------------------------------------------- */
+    if (!poSrcLayer->TestCapability(OLCRandomRead))
+    {
+        SortSourceFeatures();
+        ResetReading();
+        return;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Optimize (memory-wise) ORDER BY ... LIMIT 1 [OFFSET 0] case.    */
     /* -------------------------------------------------------------------- */
@@ -2334,6 +2941,766 @@ int OGRGenSQLResultsLayer::Compare(const OGRField *pasFirstTuple,
     return nResult;
 }
 
+/************************************************************************/
+/*                     Feature (de)serialization                        */
+/*                                                                      */
+/*      Used to keep, or spill to a temporary file, the source          */
+/*      features of an ORDER BY evaluated by sorting whole features.    */
+/*      The encoding is only meant to be read back by the same          */
+/*      process.                                                        */
+/************************************************************************/
+
+namespace
+{
+class FeatureSerializer
+{
+    std::vector<GByte> &m_abyBuffer;
+
+    CPL_DISALLOW_COPY_ASSIGN(FeatureSerializer)
+
+  public:
+    explicit FeatureSerializer(std::vector<GByte> &abyBuffer)
+        : m_abyBuffer(abyBuffer)
+    {
+    }
+
+    void Append(const void *pData, size_t nSize)
+    {
+        const GByte *pabyData = static_cast<const GByte *>(pData);
+        m_abyBuffer.insert(m_abyBuffer.end(), pabyData, pabyData + nSize);
+    }
+
+    template <class T> void Append(T nValue)
+    {
+        Append(&nValue, sizeof(nValue));
+    }
+
+    void AppendString(const char *pszStr)
+    {
+        const size_t nLen = strlen(pszStr);
+        Append(nLen);
+        Append(pszStr, nLen + 1);
+    }
+};
+
+class FeatureDeserializer
+{
+    const GByte *m_pabyData;
+    const GByte *const m_pabyEnd;
+
+    CPL_DISALLOW_COPY_ASSIGN(FeatureDeserializer)
+
+  public:
+    FeatureDeserializer(const GByte *pabyData, size_t nSize)
+        : m_pabyData(pabyData), m_pabyEnd(pabyData + nSize)
+    {
+    }
+
+    const GByte *ReadBytes(size_t nSize)
+    {
+        if (nSize > static_cast<size_t>(m_pabyEnd - m_pabyData))
+            return nullptr;
+        const GByte *pabyRet = m_pabyData;
+        m_pabyData += nSize;
+        return pabyRet;
+    }
+
+    template <class T> bool Read(T &nValue)
+    {
+        const GByte *pabyData = ReadBytes(sizeof(nValue));
+        if (pabyData == nullptr)
+            return false;
+        memcpy(&nValue, pabyData, sizeof(nValue));
+        return true;
+    }
+
+    const char *ReadString()
+    {
+        size_t nLen = 0;
+        if (!Read(nLen) || nLen == std::numeric_limits<size_t>::max())
+            return nullptr;
+        const char *pszStr =
+            reinterpret_cast<const char *>(ReadBytes(nLen + 1));
+        if (pszStr == nullptr || pszStr[nLen] != '\0')
+            return nullptr;
+        return pszStr;
+    }
+
+    template <class T> bool ReadArray(std::vector<T> &anValues)
+    {
+        int nCount = 0;
+        if (!Read(nCount) || nCount < 0)
+            return false;
+        const GByte *pabyData = ReadBytes(sizeof(T) * nCount);
+        if (pabyData == nullptr)
+            return false;
+        anValues.resize(nCount);
+        if (nCount)
+            memcpy(anValues.data(), pabyData, sizeof(T) * nCount);
+        return true;
+    }
+};
+}  // namespace
+
+constexpr GByte ORDER_BY_FIELD_UNSET = 0;
+constexpr GByte ORDER_BY_FIELD_NULL = 1;
+constexpr GByte ORDER_BY_FIELD_SET = 2;
+
+static void SerializeFeature(OGRFeature *poFeature,
+                             std::vector<GByte> &abyBuffer)
+{
+    abyBuffer.clear();
+    FeatureSerializer oSerializer(abyBuffer);
+    oSerializer.Append(poFeature->GetFID());
+
+    const OGRFeatureDefn *poDefn = poFeature->GetDefnRef();
+    const int nFieldCount = poDefn->GetFieldCount();
+    for (int iField = 0; iField < nFieldCount; iField++)
+    {
+        if (!poFeature->IsFieldSet(iField))
+        {
+            oSerializer.Append(ORDER_BY_FIELD_UNSET);
+            continue;
+        }
+        if (poFeature->IsFieldNull(iField))
+        {
+            oSerializer.Append(ORDER_BY_FIELD_NULL);
+            continue;
+        }
+        oSerializer.Append(ORDER_BY_FIELD_SET);
+
+        const OGRField *psField = poFeature->GetRawFieldRef(iField);
+        switch (poDefn->GetFieldDefn(iField)->GetType())
+        {
+            case OFTInteger:
+                oSerializer.Append(psField->Integer);
+                break;
+            case OFTInteger64:
+                oSerializer.Append(psField->Integer64);
+                break;
+            case OFTReal:
+                oSerializer.Append(psField->Real);
+                break;
+            case OFTDate:
+            case OFTTime:
+            case OFTDateTime:
+                oSerializer.Append(&psField->Date, sizeof(psField->Date));
+                break;
+            case OFTIntegerList:
+                oSerializer.Append(psField->IntegerList.nCount);
+                oSerializer.Append(psField->IntegerList.paList,
+                                   sizeof(int) * psField->IntegerList.nCount);
+                break;
+            case OFTInteger64List:
+                oSerializer.Append(psField->Integer64List.nCount);
+                oSerializer.Append(psField->Integer64List.paList,
+                                   sizeof(GIntBig) *
+                                       psField->Integer64List.nCount);
+                break;
+            case OFTRealList:
+                oSerializer.Append(psField->RealList.nCount);
+                oSerializer.Append(psField->RealList.paList,
+                                   sizeof(double) * psField->RealList.nCount);
+                break;
+            case OFTStringList:
+                oSerializer.Append(psField->StringList.nCount);
+                for (int i = 0; i < psField->StringList.nCount; i++)
+                    oSerializer.AppendString(psField->StringList.paList[i]);
+                break;
+            case OFTBinary:
+                oSerializer.Append(psField->Binary.nCount);
+                oSerializer.Append(psField->Binary.paData,
+                                   psField->Binary.nCount);
+                break;
+            default:
+                oSerializer.AppendString(poFeature->GetFieldAsString(iField));
+                break;
+        }
+    }
+
+    const int nGeomFieldCount = poDefn->GetGeomFieldCount();
+    std::vector<GByte> abyWKB;
+    for (int iGeomField = 0; iGeomField < nGeomFieldCount; iGeomField++)
+    {
+        const OGRGeometry *poGeom = poFeature->GetGeomFieldRef(iGeomField);
+        const size_t nWKBSize = poGeom ? poGeom->WkbSize() : 0;
+        oSerializer.Append(nWKBSize);
+        if (nWKBSize)
+        {
+            abyWKB.resize(nWKBSize);
+            poGeom->exportToWkb(wkbNDR, abyWKB.data(), wkbVariantIso);
+            oSerializer.Append(abyWKB.data(), nWKBSize);
+        }
+    }
+
+    const char *const apszStrings[] = {poFeature->GetStyleString(),
+                                       poFeature->GetNativeData(),
+                                       poFeature->GetNativeMediaType()};
+    for (const char *pszStr : apszStrings)
+    {
+        oSerializer.Append(static_cast<GByte>(pszStr != nullptr));
+        if (pszStr)
+            oSerializer.AppendString(pszStr);
+    }
+}
+
+static std::unique_ptr<OGRFeature> DeserializeFeature(const GByte *pabyData,
+                                                      size_t nSize,
+                                                      OGRFeatureDefn *poDefn)
+{
+    FeatureDeserializer oDeserializer(pabyData, nSize);
+    auto poFeature = std::make_unique<OGRFeature>(poDefn);
+
+    GIntBig nFID = 0;
+    if (!oDeserializer.Read(nFID))
+        return nullptr;
+    poFeature->SetFID(nFID);
+
+    const int nFieldCount = poDefn->GetFieldCount();
+    for (int iField = 0; iField < nFieldCount; iField++)
+    {
+        GByte nState = 0;
+        if (!oDeserializer.Read(nState))
+            return nullptr;
+        if (nState == ORDER_BY_FIELD_UNSET)
+            continue;
+        if (nState == ORDER_BY_FIELD_NULL)
+        {
+            poFeature->SetFieldNull(iField);
+            continue;
+        }
+
+        bool bOK = true;
+        switch (poDefn->GetFieldDefn(iField)->GetType())
+        {
+            case OFTInteger:
+            {
+                int nValue = 0;
+                bOK = oDeserializer.Read(nValue);
+                poFeature->SetField(iField, nValue);
+                break;
+            }
+            case OFTInteger64:
+            {
+                GIntBig nValue = 0;
+                bOK = oDeserializer.Read(nValue);
+                poFeature->SetField(iField, nValue);
+                break;
+            }
+            case OFTReal:
+            {
+                double dfValue = 0;
+                bOK = oDeserializer.Read(dfValue);
+                poFeature->SetField(iField, dfValue);
+                break;
+            }
+            case OFTDate:
+            case OFTTime:
+            case OFTDateTime:
+            {
+                OGRField sField;
+                bOK = oDeserializer.Read(sField.Date);
+                if (bOK)
+                    poFeature->SetField(iField, &sField);
+                break;
+            }
+            case OFTIntegerList:
+            {
+                std::vector<int> anValues;
+                bOK = oDeserializer.ReadArray(anValues);
+                poFeature->SetField(iField, static_cast<int>(anValues.size()),
+                                    anValues.data());
+                break;
+            }
+            case OFTInteger64List:
+            {
+                std::vector<GIntBig> anValues;
+                bOK = oDeserializer.ReadArray(anValues);
+                poFeature->SetField(iField, static_cast<int>(anValues.size()),
+                                    anValues.data());
+                break;
+            }
+            case OFTRealList:
+            {
+                std::vector<double> adfValues;
+                bOK = oDeserializer.ReadArray(adfValues);
+                poFeature->SetField(iField,
+                                    static_cast<int>(adfValues.size()),
+                                    adfValues.data());
+                break;
+            }
+            case OFTStringList:
+            {
+                int nCount = 0;
+                bOK = oDeserializer.Read(nCount) && nCount >= 0;
+                CPLStringList aosValues;
+                for (int i = 0; bOK && i < nCount; i++)
+                {
+                    const char *pszStr = oDeserializer.ReadString();
+                    bOK = pszStr != nullptr;
+                    if (bOK)
+                        aosValues.AddString(pszStr);
+                }
+                if (bOK)
+                    poFeature->SetField(iField, aosValues.List());
+                break;
+            }
+            case OFTBinary:
+            {
+                std::vector<GByte> abyValue;
+                bOK = oDeserializer.ReadArray(abyValue);
+                poFeature->SetField(iField, static_cast<int>(abyValue.size()),
+                                    abyValue.data());
+                break;
+            }
+            default:
+            {
+                const char *pszStr = oDeserializer.ReadString();
+                bOK = pszStr != nullptr;
+                if (bOK)
+                    poFeature->SetField(iField, pszStr);
+                break;
+            }
+        }
+        if (!bOK)
+            return nullptr;
+    }
+
+    const int nGeomFieldCount = poDefn->GetGeomFieldCount();
+    for (int iGeomField = 0; iGeomField < nGeomFieldCount; iGeomField++)
+    {
+        size_t nWKBSize = 0;
+        if (!oDeserializer.Read(nWKBSize))
+            return nullptr;
+        if (nWKBSize == 0)
+            continue;
+        const GByte *pabyWKB = oDeserializer.ReadBytes(nWKBSize);
+        OGRGeometry *poGeom = nullptr;
+        if (pabyWKB == nullptr ||
+            OGRGeometryFactory::createFromWkb(pabyWKB, nullptr, &poGeom,
+                                              nWKBSize, wkbVariantIso) !=
+                OGRERR_NONE)
+        {
+            return nullptr;
+        }
+        poGeom->assignSpatialReference(
+            poDefn->GetGeomFieldDefn(iGeomField)->GetSpatialRef());
+        poFeature->SetGeomFieldDirectly(iGeomField, poGeom);
+    }
+
+    const char *apszStrings[] = {nullptr, nullptr, nullptr};
+    for (const char *&pszStr : apszStrings)
+    {
+        GByte bHasString = 0;
+        if (!oDeserializer.Read(bHasString))
+            return nullptr;
+        if (bHasString)
+        {
+            pszStr = oDeserializer.ReadString();
+            if (pszStr == nullptr)
+                return nullptr;
+        }
+    }
+    if (apszStrings[0])
+        poFeature->SetStyleString(apszStrings[0]);
+    poFeature->SetNativeData(apszStrings[1]);
+    poFeature->SetNativeMediaType(apszStrings[2]);
+
+    return poFeature;
+}
+
+/************************************************************************/
+/*                             OrderByRun                               */
+/************************************************************************/
+
+// Sorted run of serialized features in the temporary file, and the
+// feature at its head while merging.
+struct OGRGenSQLResultsLayer::OrderByRun
+{
+    vsi_l_offset nStartOffset = 0;
+    vsi_l_offset nEndOffset = 0;
+
+    vsi_l_offset nCurOffset = 0;
+    std::unique_ptr<OGRFeature> poFeature{};
+    std::vector<OGRField> asKeys{};
+};
+
+/************************************************************************/
+/*                        SortSourceFeatures()                          */
+/*                                                                      */
+/*      Evaluate ORDER BY by sorting the source features themselves,    */
+/*      read in a single sequential pass, instead of sorting their      */
+/*      FIDs and fetching them afterwards with GetFeature().            */
+/*                                                                      */
+/*      Features are serialized and kept in memory while they fit in    */
+/*      OGR_SQL_ORDER_BY_MAX_MEMORY. Beyond that, each in-memory batch  */
+/*      is sorted and appended as a run to a temporary file, and runs   */
+/*      are merged when iterating over the result.                      */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::SortSourceFeatures()
+{
+    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
+    const int nOrderItems = psSelectInfo->order_specs;
+
+    m_bOrderBySortedFeatures = true;
+
+    GIntBig nMaxMemory = 0;
+    const char *pszMaxMemory =
+        CPLGetConfigOption("OGR_SQL_ORDER_BY_MAX_MEMORY", nullptr);
+    if (pszMaxMemory)
+    {
+        nMaxMemory = CPLAtoGIntBig(pszMaxMemory);
+    }
+    else
+    {
+        nMaxMemory = CPLGetUsablePhysicalRAM() / 10;
+        if (nMaxMemory <= 0)
+            nMaxMemory = 100 * 1024 * 1024;
+    }
+
+    // ORDER BY ... LIMIT 1 [OFFSET 0]: only keep the best feature.
+    const bool bOnlyBest =
+        psSelectInfo->offset == 0 && psSelectInfo->limit == 1;
+
+    std::vector<std::vector<GByte>> aabyFeatures;
+    std::vector<OGRField> asKeys;
+    GIntBig nUsedMemory = 0;
+    bool bOK = true;
+
+    while (bOK)
+    {
+        auto poSrcFeat =
+            std::unique_ptr<OGRFeature>(poSrcLayer->GetNextFeature());
+        if (poSrcFeat == nullptr)
+            break;
+
+        try
+        {
+            const size_t nFeatureIdx = aabyFeatures.size();
+            asKeys.resize(asKeys.size() + nOrderItems);
+            ReadIndexFields(poSrcFeat.get(), nOrderItems,
+                            asKeys.data() + nFeatureIdx * nOrderItems);
+            if (bOnlyBest && nFeatureIdx == 1)
+            {
+                if (Compare(asKeys.data() + nOrderItems, asKeys.data()) < 0)
+                {
+                    FreeIndexFields(asKeys.data(), 1, false);
+                    memcpy(asKeys.data(), asKeys.data() + nOrderItems,
+                           sizeof(OGRField) * nOrderItems);
+                    SerializeFeature(poSrcFeat.get(), aabyFeatures[0]);
+                }
+                else
+                {
+                    FreeIndexFields(asKeys.data() + nOrderItems, 1, false);
+                }
+                asKeys.resize(nOrderItems);
+                continue;
+            }
+
+            aabyFeatures.emplace_back();
+            SerializeFeature(poSrcFeat.get(), aabyFeatures.back());
+            nUsedMemory += static_cast<GIntBig>(
+                aabyFeatures.back().size() + sizeof(std::vector<GByte>) +
+                sizeof(OGRField) * nOrderItems);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate memory for ORDER BY");
+            bOK = false;
+            break;
+        }
+
+        if (nUsedMemory > nMaxMemory && !bOnlyBest)
+        {
+            bOK = FlushOrderByRun(aabyFeatures, asKeys);
+            nUsedMemory = 0;
+        }
+    }
+
+    if (bOK && !m_apoOrderByRuns.empty() && !aabyFeatures.empty())
+        bOK = FlushOrderByRun(aabyFeatures, asKeys);
+
+    if (!bOK)
+    {
+        FreeIndexFields(asKeys.data(), asKeys.size() / nOrderItems, false);
+        ClearSortedSourceFeatures();
+        // Keep returning an empty result set.
+        m_bOrderBySortedFeatures = true;
+        return;
+    }
+
+    if (m_apoOrderByRuns.empty())
+    {
+        // Everything fits in memory: sort the features themselves.
+        const size_t nFeatures = aabyFeatures.size();
+        std::vector<size_t> anOrder(nFeatures);
+        for (size_t i = 0; i < nFeatures; ++i)
+            anOrder[i] = i;
+        std::stable_sort(anOrder.begin(), anOrder.end(),
+                         [this, &asKeys, nOrderItems](size_t a, size_t b)
+                         {
+                             return Compare(asKeys.data() + a * nOrderItems,
+                                            asKeys.data() + b * nOrderItems) <
+                                    0;
+                         });
+        FreeIndexFields(asKeys.data(), nFeatures, false);
+
+        m_aabyOrderByFeatures.resize(nFeatures);
+        for (size_t i = 0; i < nFeatures; ++i)
+            m_aabyOrderByFeatures[i] = std::move(aabyFeatures[anOrder[i]]);
+    }
+    else
+    {
+        CPLDebug("GenSQL", "ORDER BY: %d sorted runs written in %s",
+                 static_cast<int>(m_apoOrderByRuns.size()),
+                 m_osOrderByTmpFilename.c_str());
+    }
+}
+
+/************************************************************************/
+/*                          FlushOrderByRun()                           */
+/*                                                                      */
+/*      Sort the features accumulated in memory and append them as a    */
+/*      new run to the temporary file.                                  */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::FlushOrderByRun(
+    std::vector<std::vector<GByte>> &aabyFeatures,
+    std::vector<OGRField> &asKeys)
+{
+    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
+    const int nOrderItems = psSelectInfo->order_specs;
+    const size_t nFeatures = aabyFeatures.size();
+
+    std::vector<size_t> anOrder(nFeatures);
+    for (size_t i = 0; i < nFeatures; ++i)
+        anOrder[i] = i;
+    std::stable_sort(anOrder.begin(), anOrder.end(),
+                     [this, &asKeys, nOrderItems](size_t a, size_t b)
+                     {
+                         return Compare(asKeys.data() + a * nOrderItems,
+                                        asKeys.data() + b * nOrderItems) < 0;
+                     });
+    FreeIndexFields(asKeys.data(), nFeatures, false);
+    asKeys.clear();
+
+    if (m_fpOrderByTmp == nullptr)
+    {
+        m_osOrderByTmpFilename = CPLGenerateTempFilename("ogr_sql_order_by");
+        m_fpOrderByTmp = VSIFOpenL(m_osOrderByTmpFilename.c_str(), "wb+");
+        if (m_fpOrderByTmp == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_FileIO,
+                     "Cannot create temporary file %s for ORDER BY",
+                     m_osOrderByTmpFilename.c_str());
+            aabyFeatures.clear();
+            return false;
+        }
+        // On Unix filesystems, a file can be removed while it is opened.
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        m_bMustUnlinkOrderByTmp =
+            VSIUnlink(m_osOrderByTmpFilename.c_str()) != 0;
+        CPLPopErrorHandler();
+    }
+
+    auto poRun = std::make_unique<OrderByRun>();
+    VSIFSeekL(m_fpOrderByTmp, 0, SEEK_END);
+    poRun->nStartOffset = VSIFTellL(m_fpOrderByTmp);
+    bool bOK = true;
+    for (size_t i = 0; bOK && i < nFeatures; ++i)
+    {
+        const auto &abyFeature = aabyFeatures[anOrder[i]];
+        const size_t nSize = abyFeature.size();
+        bOK = VSIFWriteL(&nSize, sizeof(nSize), 1, m_fpOrderByTmp) == 1 &&
+              VSIFWriteL(abyFeature.data(), nSize, 1, m_fpOrderByTmp) == 1;
+    }
+    aabyFeatures.clear();
+    if (!bOK)
+    {
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "Cannot write temporary file %s for ORDER BY",
+                 m_osOrderByTmpFilename.c_str());
+        return false;
+    }
+    poRun->nEndOffset = VSIFTellL(m_fpOrderByTmp);
+    m_apoOrderByRuns.push_back(std::move(poRun));
+    return true;
+}
+
+/************************************************************************/
+/*                     ReadNextOrderByRunFeature()                      */
+/*                                                                      */
+/*      Load the next feature of a run, and its sort keys, as the       */
+/*      head of the run. Returns false at the end of the run.           */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::ReadNextOrderByRunFeature(OrderByRun *poRun)
+{
+    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
+    const int nOrderItems = psSelectInfo->order_specs;
+
+    if (!poRun->asKeys.empty())
+        FreeIndexFields(poRun->asKeys.data(), 1, false);
+    poRun->poFeature.reset();
+    poRun->asKeys.assign(nOrderItems, OGRField());
+
+    if (poRun->nCurOffset >= poRun->nEndOffset)
+        return false;
+
+    size_t nSize = 0;
+    std::vector<GByte> abyFeature;
+    if (VSIFSeekL(m_fpOrderByTmp, poRun->nCurOffset, SEEK_SET) != 0 ||
+        VSIFReadL(&nSize, sizeof(nSize), 1, m_fpOrderByTmp) != 1 ||
+        nSize > poRun->nEndOffset - poRun->nCurOffset)
+    {
+        poRun->nCurOffset = poRun->nEndOffset;
+        return false;
+    }
+    try
+    {
+        abyFeature.resize(nSize);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for ORDER BY");
+        poRun->nCurOffset = poRun->nEndOffset;
+        return false;
+    }
+    if (VSIFReadL(abyFeature.data(), nSize, 1, m_fpOrderByTmp) != 1)
+    {
+        poRun->nCurOffset = poRun->nEndOffset;
+        return false;
+    }
+    poRun->nCurOffset += sizeof(nSize) + nSize;
+
+    poRun->poFeature = DeserializeFeature(abyFeature.data(), nSize,
+                                          poSrcLayer->GetLayerDefn());
+    if (poRun->poFeature == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Corrupted temporary file %s for ORDER BY",
+                 m_osOrderByTmpFilename.c_str());
+        poRun->nCurOffset = poRun->nEndOffset;
+        return false;
+    }
+    ReadIndexFields(poRun->poFeature.get(), nOrderItems,
+                    poRun->asKeys.data());
+    return true;
+}
+
+/************************************************************************/
+/*                         StartOrderByMerge()                          */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::StartOrderByMerge()
+{
+    m_anOrderByMergeHeap.clear();
+    for (int iRun = 0; iRun < static_cast<int>(m_apoOrderByRuns.size());
+         ++iRun)
+    {
+        auto poRun = m_apoOrderByRuns[iRun].get();
+        poRun->nCurOffset = poRun->nStartOffset;
+        if (ReadNextOrderByRunFeature(poRun))
+            m_anOrderByMergeHeap.push_back(iRun);
+    }
+    m_nOrderByMergePos = 0;
+}
+
+/************************************************************************/
+/*                       GetSortedSourceFeature()                       */
+/*                                                                      */
+/*      Return the source feature at index nIndex in the sort order.    */
+/************************************************************************/
+
+std::unique_ptr<OGRFeature>
+OGRGenSQLResultsLayer::GetSortedSourceFeature(GIntBig nIndex)
+{
+    if (m_apoOrderByRuns.empty())
+    {
+        if (nIndex < 0 ||
+            nIndex >= static_cast<GIntBig>(m_aabyOrderByFeatures.size()))
+            return nullptr;
+        const auto &abyFeature =
+            m_aabyOrderByFeatures[static_cast<size_t>(nIndex)];
+        return DeserializeFeature(abyFeature.data(), abyFeature.size(),
+                                  poSrcLayer->GetLayerDefn());
+    }
+
+    if (nIndex < 0)
+        return nullptr;
+    if (m_nOrderByMergePos < 0 || nIndex < m_nOrderByMergePos)
+        StartOrderByMerge();
+
+    // Min-heap on the head of the runs. On ties, the feature of the
+    // earliest run comes first, so that the sort is stable.
+    const auto IsAfter = [this](int iRunA, int iRunB)
+    {
+        const int nCmp = Compare(m_apoOrderByRuns[iRunA]->asKeys.data(),
+                                 m_apoOrderByRuns[iRunB]->asKeys.data());
+        return nCmp > 0 || (nCmp == 0 && iRunA > iRunB);
+    };
+    if (m_nOrderByMergePos == 0)
+    {
+        std::make_heap(m_anOrderByMergeHeap.begin(),
+                       m_anOrderByMergeHeap.end(), IsAfter);
+    }
+
+    while (!m_anOrderByMergeHeap.empty())
+    {
+        std::pop_heap(m_anOrderByMergeHeap.begin(), m_anOrderByMergeHeap.end(),
+                      IsAfter);
+        const int iRun = m_anOrderByMergeHeap.back();
+        auto poRun = m_apoOrderByRuns[iRun].get();
+        std::unique_ptr<OGRFeature> poFeature;
+        if (m_nOrderByMergePos == nIndex)
+            poFeature = std::move(poRun->poFeature);
+        if (ReadNextOrderByRunFeature(poRun))
+        {
+            std::push_heap(m_anOrderByMergeHeap.begin(),
+                           m_anOrderByMergeHeap.end(), IsAfter);
+        }
+        else
+        {
+            m_anOrderByMergeHeap.pop_back();
+        }
+        ++m_nOrderByMergePos;
+        if (poFeature)
+            return poFeature;
+    }
+
+    return nullptr;
+}
+
+/************************************************************************/
+/*                     ClearSortedSourceFeatures()                      */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::ClearSortedSourceFeatures()
+{
+    for (auto &poRun : m_apoOrderByRuns)
+    {
+        if (!poRun->asKeys.empty())
+            FreeIndexFields(poRun->asKeys.data(), 1, false);
+    }
+    m_apoOrderByRuns.clear();
+    m_anOrderByMergeHeap.clear();
+    m_nOrderByMergePos = -1;
+    m_aabyOrderByFeatures.clear();
+    m_bOrderBySortedFeatures = false;
+
+    if (m_fpOrderByTmp)
+    {
+        VSIFCloseL(m_fpOrderByTmp);
+        m_fpOrderByTmp = nullptr;
+        if (m_bMustUnlinkOrderByTmp)
+            VSIUnlink(m_osOrderByTmpFilename.c_str());
+        m_bMustUnlinkOrderByTmp = false;
+    }
+}
+
 /************************************************************************/
 /*                         AddFieldDefnToSet()                          */
 /************************************************************************/
@@ -2409,6 +3776,13 @@ void OGRGenSQLResultsLayer::FindAndSetIgnoredFields()
                           hSet);
     }
 
+    for (int iGroup = 0; iGroup < psSelectInfo->group_by_specs; iGroup++)
+    {
+        swq_group_by_def *psGroupByDef = psSelectInfo->group_by_defs + iGroup;
+        AddFieldDefnToSet(psGroupByDef->table_index, psGroupByDef->field_index,
+                          hSet);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      2nd phase : now, we can exclude the unused fields               */
     /* -------------------------------------------------------------------- */
@@ -2449,6 +3823,8 @@ void OGRGenSQLResultsLayer::InvalidateOrderByIndex()
 
     nIndexSize = 0;
     bOrderByValid = FALSE;
+
+    ClearSortedSourceFeatures();
 }
 
 /************************************************************************/
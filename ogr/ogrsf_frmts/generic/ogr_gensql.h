@@ -36,6 +36,9 @@
 #include "cpl_hash_set.h"
 #include "cpl_string.h"
 
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 /*! @cond Doxygen_Suppress */
@@ -76,9 +79,27 @@ class OGRGenSQLResultsLayer final : public OGRLayer
     GIntBig *panFIDIndex;
     int bOrderByValid;
 
+    // ORDER BY on source layers without efficient random read is done by
+    // sorting the (serialized) source features themselves. They are kept in
+    // memory, in sorted order, if they fit within the memory budget.
+    // Otherwise sorted runs are written to a temporary file, and merged
+    // when iterating.
+    struct OrderByRun;
+    bool m_bOrderBySortedFeatures = false;
+    std::vector<std::vector<GByte>> m_aabyOrderByFeatures{};
+    std::string m_osOrderByTmpFilename{};
+    VSILFILE *m_fpOrderByTmp = nullptr;
+    bool m_bMustUnlinkOrderByTmp = false;
+    std::vector<std::unique_ptr<OrderByRun>> m_apoOrderByRuns{};
+    std::vector<int> m_anOrderByMergeHeap{};
+    GIntBig m_nOrderByMergePos = -1;
+
     GIntBig nNextIndexFID;
     OGRFeature *poSummaryFeature;
 
+    // Result features of a GROUP BY, in output order.
+    std::vector<std::unique_ptr<OGRFeature>> m_apoGroupByFeatures{};
+
     int iFIDFieldIndex;
 
     int nExtraDSCount;
@@ -87,7 +108,33 @@ class OGRGenSQLResultsLayer final : public OGRLayer
     GIntBig nIteratedFeatures;
     std::vector<CPLString> m_oDistinctList;
 
+    // In-memory index of the features of a joined layer, keyed on the
+    // value of its join field, for joins of the form
+    // primary.field = secondary.field.
+    struct JoinHashTable
+    {
+        int iPrimaryField = -1;
+        int iSecondaryField = -1;
+        bool bIntegerKey = false;
+        std::unordered_map<GIntBig, std::unique_ptr<OGRFeature>>
+            oMapInteger{};
+        // Keys are upper-cased, as OGR SQL string comparison is
+        // case-insensitive.
+        std::unordered_map<std::string, std::unique_ptr<OGRFeature>>
+            oMapString{};
+    };
+
+    // One entry per join, null if the join must be resolved by setting an
+    // attribute filter on the joined layer for each primary feature.
+    std::vector<std::unique_ptr<JoinHashTable>> m_apoJoinHashTables{};
+    bool m_bJoinHashTablesBuilt = false;
+
+    void BuildJoinHashTables();
+    bool LookupJoinHashTable(int iJoin, OGRFeature *poSrcFeat,
+                             OGRFeature *&poJoinFeature);
+
     int PrepareSummary();
+    int PrepareGroupBy();
 
     OGRFeature *TranslateFeature(OGRFeature *);
     void CreateOrderByIndex();
@@ -99,6 +146,14 @@ class OGRGenSQLResultsLayer final : public OGRLayer
                          bool bFreeArray = true);
     int Compare(const OGRField *pasFirst, const OGRField *pasSecond);
 
+    void SortSourceFeatures();
+    bool FlushOrderByRun(std::vector<std::vector<GByte>> &aabyFeatures,
+                         std::vector<OGRField> &asKeys);
+    bool ReadNextOrderByRunFeature(OrderByRun *poRun);
+    void StartOrderByMerge();
+    std::unique_ptr<OGRFeature> GetSortedSourceFeature(GIntBig nIndex);
+    void ClearSortedSourceFeatures();
+
     void ClearFilters();
     void ApplyFiltersToSource();
 
@@ -1798,6 +1798,16 @@ bool OGRLayer::FilterWKBGeometry(const GByte *pabyWKB, size_t nWKBSize,
             }
             else if (OGRGeometryFactory::haveGEOS())
             {
+                // For an envelope filter, get the same answer as GEOS without
+                // materializing the geometry, unless it has curves.
+                bool bIntersects = false;
+                if (m_bFilterIsEnvelope &&
+                    OGRWKBIntersectsEnvelope(pabyWKB, nWKBSize,
+                                             m_sFilterEnvelope, bIntersects))
+                {
+                    return bIntersects;
+                }
+
                 OGRGeometry *poGeom = nullptr;
                 int ret = FALSE;
                 if (OGRGeometryFactory::createFromWkb(pabyWKB, nullptr, &poGeom,
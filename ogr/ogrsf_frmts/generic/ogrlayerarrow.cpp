@@ -28,6 +28,7 @@
 
 #include "ogrsf_frmts.h"
 #include "ogr_api.h"
+#include "ogr_featurequery_program.h"
 #include "ogr_recordbatch.h"
 #include "ograrrowarrayhelper.h"
 #include "ogrlayerarrow.h"
@@ -1593,8 +1594,11 @@ static bool FillDateArray(struct ArrowArray *psChild,
             brokenDown.tm_year = psRawField->Date.Year - 1900;
             brokenDown.tm_mon = psRawField->Date.Month - 1;
             brokenDown.tm_mday = psRawField->Date.Day;
+            // Round down, so that dates before 1970 are not shifted by one
+            // day
+            const GIntBig nUnixTime = CPLYMDHMSToUnixTime(&brokenDown) + 36200;
             panValues[iFeat] = static_cast<int>(
-                (CPLYMDHMSToUnixTime(&brokenDown) + 36200) / 86400);
+                (nUnixTime >= 0 ? nUnixTime : nUnixTime - 86399) / 86400);
         }
         else if (bIsNullable)
         {
@@ -4638,6 +4642,253 @@ static bool SetFieldForOtherFormats(OGRFeature &oFeature,
     return true;
 }
 
+/************************************************************************/
+/*                   IsCompatibleWithProgramComparison()                */
+/************************************************************************/
+
+// Whether the values of an Arrow column of that format are stored without
+// loss in a OGR field of that type by FillValidityArrayFromAttrQuery().
+static bool IsCompatibleWithProgramComparison(OGRFieldType eFieldType,
+                                              const char *format)
+{
+    const bool bSmallInt = IsInt8(format) || IsUInt8(format) ||
+                           IsInt16(format) || IsUInt16(format) ||
+                           IsInt32(format);
+    switch (eFieldType)
+    {
+        case OFTInteger:
+            return bSmallInt;
+        case OFTInteger64:
+            return bSmallInt || IsUInt32(format) || IsInt64(format);
+        case OFTReal:
+            return bSmallInt || IsUInt32(format) || IsInt64(format) ||
+                   IsFloat32(format) || IsFloat64(format);
+        case OFTString:
+            return IsString(format) || IsLargeString(format);
+        default:
+            break;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                    EvaluateProgramComparison()                       */
+/************************************************************************/
+
+template <class T>
+static void EvaluateProgramComparison(
+    const OGRFeatureQueryProgram::Instruction &sInstr,
+    const struct ArrowArray *psArray, std::vector<uint8_t> &abyRes)
+{
+    const uint8_t *pabyValidity =
+        psArray->null_count == 0
+            ? nullptr
+            : static_cast<const uint8_t *>(psArray->buffers[0]);
+    const T *panValues = static_cast<const T *>(psArray->buffers[1]);
+    const size_t nOffset = static_cast<size_t>(psArray->offset);
+    const bool bFloat =
+        sInstr.eValueType == OGRFeatureQueryProgram::ValueType::FLOAT;
+    for (size_t i = 0; i < abyRes.size(); ++i)
+    {
+        if (pabyValidity && !TestBit(pabyValidity, i + nOffset))
+            abyRes[i] = false;
+        else if (bFloat)
+            abyRes[i] = OGRFeatureQueryProgram::CompareFloat(
+                sInstr, static_cast<double>(panValues[i + nOffset]));
+        else
+            abyRes[i] = OGRFeatureQueryProgram::CompareInteger(
+                sInstr, static_cast<GIntBig>(panValues[i + nOffset]));
+    }
+}
+
+template <class OffsetType>
+static void EvaluateProgramStringComparison(
+    const OGRFeatureQueryProgram::Instruction &sInstr,
+    const struct ArrowArray *psArray, std::vector<uint8_t> &abyRes)
+{
+    const uint8_t *pabyValidity =
+        psArray->null_count == 0
+            ? nullptr
+            : static_cast<const uint8_t *>(psArray->buffers[0]);
+    const OffsetType *panOffsets =
+        static_cast<const OffsetType *>(psArray->buffers[1]);
+    const char *pabyData = static_cast<const char *>(psArray->buffers[2]);
+    const size_t nOffset = static_cast<size_t>(psArray->offset);
+    for (size_t i = 0; i < abyRes.size(); ++i)
+    {
+        if (pabyValidity && !TestBit(pabyValidity, i + nOffset))
+        {
+            abyRes[i] = false;
+        }
+        else
+        {
+            const auto nStart = panOffsets[i + nOffset];
+            abyRes[i] = OGRFeatureQueryProgram::CompareString(
+                sInstr, pabyData + static_cast<size_t>(nStart),
+                static_cast<size_t>(panOffsets[i + nOffset + 1] - nStart));
+        }
+    }
+}
+
+/************************************************************************/
+/*                   FillValidityArrayFromProgram()                     */
+/************************************************************************/
+
+// Column-wise evaluation of an attribute filter compiled as a
+// OGRFeatureQueryProgram, when all the fields it uses are top-level columns.
+// Returns false if that is not possible.
+static bool FillValidityArrayFromProgram(
+    const OGRFeatureQueryProgram &oProgram, OGRFeatureDefn *poFeatureDefn,
+    const struct ArrowSchema *schema, const struct ArrowArray *array,
+    std::vector<bool> &abyValidityFromFilters, size_t &nCountIntersecting)
+{
+    using Op = OGRFeatureQueryProgram::Op;
+    const auto &aoInstructions = oProgram.GetInstructions();
+
+    std::vector<int> anArrowColumns;
+    for (const auto &sInstr : aoInstructions)
+    {
+        int iArrowColumn = -1;
+        if (sInstr.eOp == Op::COMPARE)
+        {
+            if (sInstr.iField < 0)
+                return false;
+            const char *pszFieldName =
+                poFeatureDefn->GetFieldDefn(sInstr.iField)->GetNameRef();
+            for (int64_t i = 0; i < schema->n_children; ++i)
+            {
+                if (strcmp(schema->children[i]->name, pszFieldName) == 0)
+                {
+                    iArrowColumn = static_cast<int>(i);
+                    break;
+                }
+            }
+            if (iArrowColumn < 0 ||
+                schema->children[iArrowColumn]->dictionary != nullptr ||
+                !IsCompatibleWithProgramComparison(
+                    sInstr.eFieldType, schema->children[iArrowColumn]->format))
+            {
+                return false;
+            }
+        }
+        anArrowColumns.push_back(iArrowColumn);
+    }
+
+    const size_t nLength = abyValidityFromFilters.size();
+    std::vector<std::vector<uint8_t>> aabyStack;
+    for (size_t iInstr = 0; iInstr < aoInstructions.size(); ++iInstr)
+    {
+        const auto &sInstr = aoInstructions[iInstr];
+        switch (sInstr.eOp)
+        {
+            case Op::COMPARE:
+            {
+                aabyStack.emplace_back(nLength);
+                auto &abyRes = aabyStack.back();
+                const auto psArray = array->children[anArrowColumns[iInstr]];
+                const char *format =
+                    schema->children[anArrowColumns[iInstr]]->format;
+                if (sInstr.eComparison ==
+                    OGRFeatureQueryProgram::Comparison::ISNULL)
+                {
+                    const uint8_t *pabyValidity =
+                        psArray->null_count == 0
+                            ? nullptr
+                            : static_cast<const uint8_t *>(
+                                  psArray->buffers[0]);
+                    const size_t nOffset =
+                        static_cast<size_t>(psArray->offset);
+                    for (size_t i = 0; i < nLength; ++i)
+                    {
+                        abyRes[i] =
+                            pabyValidity && !TestBit(pabyValidity, i + nOffset);
+                    }
+                }
+                else if (IsInt8(format))
+                    EvaluateProgramComparison<int8_t>(sInstr, psArray, abyRes);
+                else if (IsUInt8(format))
+                    EvaluateProgramComparison<uint8_t>(sInstr, psArray,
+                                                       abyRes);
+                else if (IsInt16(format))
+                    EvaluateProgramComparison<int16_t>(sInstr, psArray,
+                                                       abyRes);
+                else if (IsUInt16(format))
+                    EvaluateProgramComparison<uint16_t>(sInstr, psArray,
+                                                        abyRes);
+                else if (IsInt32(format))
+                    EvaluateProgramComparison<int32_t>(sInstr, psArray,
+                                                       abyRes);
+                else if (IsUInt32(format))
+                    EvaluateProgramComparison<uint32_t>(sInstr, psArray,
+                                                        abyRes);
+                else if (IsInt64(format))
+                    EvaluateProgramComparison<int64_t>(sInstr, psArray,
+                                                       abyRes);
+                else if (IsFloat32(format))
+                    EvaluateProgramComparison<float>(sInstr, psArray, abyRes);
+                else if (IsFloat64(format))
+                    EvaluateProgramComparison<double>(sInstr, psArray, abyRes);
+                else if (IsString(format))
+                    EvaluateProgramStringComparison<uint32_t>(sInstr, psArray,
+                                                              abyRes);
+                else
+                {
+                    CPLAssert(IsLargeString(format));
+                    EvaluateProgramStringComparison<uint64_t>(sInstr, psArray,
+                                                              abyRes);
+                }
+                break;
+            }
+
+            case Op::AND:
+            case Op::OR:
+            {
+                const size_t nFirst = aabyStack.size() - sInstr.nOperands;
+                auto &abyRes = aabyStack[nFirst];
+                for (size_t iOperand = nFirst + 1; iOperand < aabyStack.size();
+                     ++iOperand)
+                {
+                    const auto &abyOperand = aabyStack[iOperand];
+                    if (sInstr.eOp == Op::AND)
+                    {
+                        for (size_t i = 0; i < nLength; ++i)
+                            abyRes[i] &= abyOperand[i];
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < nLength; ++i)
+                            abyRes[i] |= abyOperand[i];
+                    }
+                }
+                aabyStack.resize(nFirst + 1);
+                break;
+            }
+
+            case Op::NOT:
+            {
+                auto &abyRes = aabyStack.back();
+                for (size_t i = 0; i < nLength; ++i)
+                    abyRes[i] = !abyRes[i];
+                break;
+            }
+        }
+    }
+    CPLAssert(aabyStack.size() == 1);
+
+    nCountIntersecting = 0;
+    const auto &abyRes = aabyStack[0];
+    for (size_t i = 0; i < nLength; ++i)
+    {
+        if (!abyValidityFromFilters[i])
+            continue;
+        if (abyRes[i])
+            nCountIntersecting++;
+        else
+            abyValidityFromFilters[i] = false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                 FillValidityArrayFromAttrQuery()                     */
 /************************************************************************/
@@ -4649,6 +4900,15 @@ static size_t FillValidityArrayFromAttrQuery(
 {
     size_t nCountIntersecting = 0;
     auto poFeatureDefn = const_cast<OGRLayer *>(poLayer)->GetLayerDefn();
+
+    const auto poProgram = poAttrQuery->GetProgram();
+    if (poProgram &&
+        FillValidityArrayFromProgram(*poProgram, poFeatureDefn, schema, array,
+                                     abyValidityFromFilters,
+                                     nCountIntersecting))
+    {
+        return nCountIntersecting;
+    }
     OGRFeature oFeature(poFeatureDefn);
 
     std::map<std::string, std::vector<int>> oMapFieldNameToArrowPath;
@@ -5421,6 +5681,157 @@ bool OGRCloneArrowArray(const struct ArrowSchema *schema,
     return OGRCloneArrowArray(schema, src_array, out_array, 0);
 }
 
+/************************************************************************/
+/*                     OGRTransformArrowWKBArray()                      */
+/************************************************************************/
+
+/** Transforms the WKB geometries of a binary or large binary array with
+ * poCT.
+ *
+ * The coordinates of all the geometries of the array are transformed with a
+ * single call to OGRCoordinateTransformation::Transform() (cf
+ * OGRWKBTransformBatch()), except curve geometries which go through
+ * OGRGeometry::transform().
+ *
+ * As the buffers of an array coming from GetArrowStream() may be read-only,
+ * the array is transformed into a copy, which replaces its content: the
+ * original array is released, and array->release() must be called as usual
+ * by the caller (which is normally done by the release callback of its parent
+ * array). array may be a child of a struct array with a non-zero offset.
+ *
+ * @param schema Schema of the array. Must *NOT* be NULL.
+ * @param array Array to transform. Must *NOT* be NULL.
+ * @param poCT Coordinate transformation. Must *NOT* be NULL.
+ * @param bSetNullOnFailure If true, geometries that cannot be transformed are
+ * set to null (which requires the array to be nullable). Otherwise, an error
+ * is emitted and the array is left untouched.
+ * @return true if success.
+ */
+bool OGRTransformArrowWKBArray(const struct ArrowSchema *schema,
+                               struct ArrowArray *array,
+                               OGRCoordinateTransformation *poCT,
+                               bool bSetNullOnFailure)
+{
+    const bool bIsLargeBinary = IsLargeBinary(schema->format);
+    if (!bIsLargeBinary && !IsBinary(schema->format))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "OGRTransformArrowWKBArray(): unhandled format '%s'",
+                 schema->format);
+        return false;
+    }
+
+    struct ArrowArray sClone;
+    if (!OGRCloneArrowArray(schema, array, &sClone, 0))
+        return false;
+
+    const size_t nLength = static_cast<size_t>(sClone.length);
+    uint8_t *pabyValidity =
+        static_cast<uint8_t *>(const_cast<void *>(sClone.buffers[0]));
+    GByte *pabyData =
+        static_cast<GByte *>(const_cast<void *>(sClone.buffers[2]));
+    std::vector<GByte *> apabyWkb;
+    std::vector<size_t> anWKBSize;
+    std::vector<int> abSuccess;
+    try
+    {
+        apabyWkb.resize(nLength);
+        anWKBSize.resize(nLength);
+        abSuccess.resize(nLength);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in OGRTransformArrowWKBArray()");
+        sClone.release(&sClone);
+        return false;
+    }
+    for (size_t i = 0; i < nLength; ++i)
+    {
+        if (pabyValidity && !TestBit(pabyValidity, i))
+            continue;
+        size_t nStart;
+        size_t nEnd;
+        if (bIsLargeBinary)
+        {
+            const auto panOffsets =
+                static_cast<const uint64_t *>(sClone.buffers[1]);
+            nStart = static_cast<size_t>(panOffsets[i]);
+            nEnd = static_cast<size_t>(panOffsets[i + 1]);
+        }
+        else
+        {
+            const auto panOffsets =
+                static_cast<const uint32_t *>(sClone.buffers[1]);
+            nStart = panOffsets[i];
+            nEnd = panOffsets[i + 1];
+        }
+        if (nEnd > nStart)
+        {
+            apabyWkb[i] = pabyData + nStart;
+            anWKBSize[i] = nEnd - nStart;
+        }
+    }
+
+    if (!OGRWKBTransformBatch(apabyWkb.data(), anWKBSize.data(), nLength, poCT,
+                              abSuccess.data()))
+    {
+        sClone.release(&sClone);
+        return false;
+    }
+
+    for (size_t i = 0; i < nLength; ++i)
+    {
+        if (abSuccess[i])
+            continue;
+
+        // Curve geometries are not handled by OGRWKBTransformBatch()
+        OGRGeometry *poGeom = nullptr;
+        size_t nBytesConsumed = 0;
+        if (OGRGeometryFactory::createFromWkb(apabyWkb[i], nullptr, &poGeom,
+                                              anWKBSize[i], wkbVariantIso,
+                                              nBytesConsumed) == OGRERR_NONE)
+        {
+            std::unique_ptr<OGRGeometry> poGeomHolder(poGeom);
+            if (nBytesConsumed == anWKBSize[i] &&
+                poGeom->WkbSize() == anWKBSize[i] &&
+                poGeom->transform(poCT) == OGRERR_NONE &&
+                poGeom->exportToWkb(
+                    static_cast<OGRwkbByteOrder>(
+                        DB2_V72_FIX_BYTE_ORDER(apabyWkb[i][0])),
+                    apabyWkb[i], wkbVariantIso) == OGRERR_NONE)
+            {
+                continue;
+            }
+        }
+
+        if (!bSetNullOnFailure || !(schema->flags & ARROW_FLAG_NULLABLE))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Failed to reproject geometry at row %" PRIu64 " of %s",
+                     static_cast<uint64_t>(i), schema->name);
+            sClone.release(&sClone);
+            return false;
+        }
+        if (!pabyValidity)
+        {
+            pabyValidity = AllocValidityBitmap(nLength);
+            if (!pabyValidity)
+            {
+                sClone.release(&sClone);
+                return false;
+            }
+            sClone.buffers[0] = pabyValidity;
+        }
+        UnsetBit(pabyValidity, i);
+        sClone.null_count++;
+    }
+
+    array->release(array);
+    memcpy(array, &sClone, sizeof(sClone));
+    return true;
+}
+
 /************************************************************************/
 /*                  OGRLayer::IsArrowSchemaSupported()                  */
 /************************************************************************/
@@ -46,4 +46,11 @@ bool CPL_DLL OGRCloneArrowArray(const struct ArrowSchema *schema,
                                 const struct ArrowArray *array,
                                 struct ArrowArray *out_array);
 
+class OGRCoordinateTransformation;
+
+bool CPL_DLL OGRTransformArrowWKBArray(const struct ArrowSchema *schema,
+                                       struct ArrowArray *array,
+                                       OGRCoordinateTransformation *poCT,
+                                       bool bSetNullOnFailure);
+
 #endif  // OGRLAYERARROW_H_DEFINED
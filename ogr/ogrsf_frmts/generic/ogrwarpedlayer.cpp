@@ -29,6 +29,10 @@
 #ifndef DOXYGEN_SKIP
 
 #include "ogrwarpedlayer.h"
+#include "ogr_recordbatch.h"
+#include "ogrlayerarrow.h"
+
+#include <string>
 
 /************************************************************************/
 /*                          OGRWarpedLayer()                            */
@@ -598,7 +602,8 @@ int OGRWarpedLayer::TestCapability(const char *pszCapability)
         if (bVal)
             bVal = m_poReversedCT != nullptr;
     }
-    else if (EQUAL(pszCapability, OLCFastFeatureCount))
+    else if (EQUAL(pszCapability, OLCFastFeatureCount) ||
+             EQUAL(pszCapability, OLCFastGetArrowStream))
     {
         if (bVal)
             bVal = m_poFilterGeom == nullptr;
@@ -621,3 +626,148 @@ void OGRWarpedLayer::SetExtent(double dfXMin, double dfYMin, double dfXMax,
 }
 
 #endif /* #ifndef DOXYGEN_SKIP */
+
+/************************************************************************/
+/*                           GetArrowStream()                           */
+/************************************************************************/
+
+namespace
+{
+struct OGRWarpedLayerArrowStreamPrivate
+{
+    struct ArrowArrayStream m_sSrcStream;
+    struct ArrowSchema m_sSrcSchema;
+    int m_iGeomChild = -1;
+    OGRCoordinateTransformation *m_poCT = nullptr;
+    std::string m_osLastError{};
+
+    static int GetSchema(struct ArrowArrayStream *stream,
+                         struct ArrowSchema *out_schema)
+    {
+        auto psPrivate = static_cast<OGRWarpedLayerArrowStreamPrivate *>(
+            stream->private_data);
+        return psPrivate->m_sSrcStream.get_schema(&psPrivate->m_sSrcStream,
+                                                  out_schema);
+    }
+
+    static int GetNext(struct ArrowArrayStream *stream,
+                       struct ArrowArray *out_array)
+    {
+        auto psPrivate = static_cast<OGRWarpedLayerArrowStreamPrivate *>(
+            stream->private_data);
+        psPrivate->m_osLastError.clear();
+        const int nRet = psPrivate->m_sSrcStream.get_next(
+            &psPrivate->m_sSrcStream, out_array);
+        if (nRet != 0 || out_array->release == nullptr)
+            return nRet;
+        CPLErrorReset();
+        if (!OGRTransformArrowWKBArray(
+                psPrivate->m_sSrcSchema.children[psPrivate->m_iGeomChild],
+                out_array->children[psPrivate->m_iGeomChild],
+                psPrivate->m_poCT, /* bSetNullOnFailure = */ true))
+        {
+            psPrivate->m_osLastError = CPLGetLastErrorMsg();
+            out_array->release(out_array);
+            memset(out_array, 0, sizeof(*out_array));
+            return EIO;
+        }
+        return 0;
+    }
+
+    static const char *GetLastError(struct ArrowArrayStream *stream)
+    {
+        auto psPrivate = static_cast<OGRWarpedLayerArrowStreamPrivate *>(
+            stream->private_data);
+        if (!psPrivate->m_osLastError.empty())
+            return psPrivate->m_osLastError.c_str();
+        return psPrivate->m_sSrcStream.get_last_error(&psPrivate->m_sSrcStream);
+    }
+
+    static void Release(struct ArrowArrayStream *stream)
+    {
+        auto psPrivate = static_cast<OGRWarpedLayerArrowStreamPrivate *>(
+            stream->private_data);
+        psPrivate->m_sSrcSchema.release(&psPrivate->m_sSrcSchema);
+        psPrivate->m_sSrcStream.release(&psPrivate->m_sSrcStream);
+        delete psPrivate;
+        stream->release = nullptr;
+    }
+};
+}  // namespace
+
+/** Returns a stream of batches whose geometries are transformed with a single
+ * coordinate transformation call per batch.
+ *
+ * This works on the WKB geometry column of the stream of the decorated layer,
+ * and falls back to the generic implementation, on top of GetNextFeature(),
+ * when a spatial filter is set, or when the requested geometry encoding or
+ * metadata would need to carry the target SRS.
+ */
+bool OGRWarpedLayer::GetArrowStream(struct ArrowArrayStream *out_stream,
+                                    CSLConstList papszOptions)
+{
+    const char *pszGeomFieldName =
+        GetLayerDefn()->GetGeomFieldDefn(m_iGeomField)->GetNameRef();
+    if (pszGeomFieldName[0] == '\0')
+        pszGeomFieldName = DEFAULT_ARROW_GEOMETRY_NAME;
+    if (m_poFilterGeom != nullptr ||
+        !EQUAL(CSLFetchNameValueDef(papszOptions, "GEOMETRY_ENCODING", "WKB"),
+               "WKB") ||
+        !EQUAL(CSLFetchNameValueDef(papszOptions, "GEOMETRY_METADATA_ENCODING",
+                                    "OGC"),
+               "OGC"))
+    {
+        return OGRLayer::GetArrowStream(out_stream, papszOptions);
+    }
+
+    CPLStringList aosOptions(papszOptions);
+    aosOptions.SetNameValue("GEOMETRY_ENCODING", "WKB");
+    auto psPrivate = new OGRWarpedLayerArrowStreamPrivate();
+    psPrivate->m_poCT = m_poCT;
+    if (!m_poDecoratedLayer->GetArrowStream(&psPrivate->m_sSrcStream,
+                                            aosOptions.List()))
+    {
+        delete psPrivate;
+        return OGRLayer::GetArrowStream(out_stream, papszOptions);
+    }
+    if (psPrivate->m_sSrcStream.get_schema(&psPrivate->m_sSrcStream,
+                                           &psPrivate->m_sSrcSchema) != 0)
+    {
+        psPrivate->m_sSrcStream.release(&psPrivate->m_sSrcStream);
+        delete psPrivate;
+        return OGRLayer::GetArrowStream(out_stream, papszOptions);
+    }
+    for (int i = 0; i < static_cast<int>(psPrivate->m_sSrcSchema.n_children);
+         ++i)
+    {
+        const auto psChild = psPrivate->m_sSrcSchema.children[i];
+        if (strcmp(psChild->name, pszGeomFieldName) == 0)
+        {
+            // Only WKB columns whose metadata does not embed the source SRS
+            if ((strcmp(psChild->format, "z") == 0 ||
+                 strcmp(psChild->format, "Z") == 0) &&
+                (psChild->metadata == nullptr ||
+                 OGRParseArrowMetadata(psChild->metadata)
+                         .count(ARROW_EXTENSION_METADATA_KEY) == 0))
+            {
+                psPrivate->m_iGeomChild = i;
+            }
+            break;
+        }
+    }
+    if (psPrivate->m_iGeomChild < 0)
+    {
+        psPrivate->m_sSrcSchema.release(&psPrivate->m_sSrcSchema);
+        psPrivate->m_sSrcStream.release(&psPrivate->m_sSrcStream);
+        delete psPrivate;
+        return OGRLayer::GetArrowStream(out_stream, papszOptions);
+    }
+
+    memset(out_stream, 0, sizeof(*out_stream));
+    out_stream->get_schema = OGRWarpedLayerArrowStreamPrivate::GetSchema;
+    out_stream->get_next = OGRWarpedLayerArrowStreamPrivate::GetNext;
+    out_stream->get_last_error = OGRWarpedLayerArrowStreamPrivate::GetLastError;
+    out_stream->release = OGRWarpedLayerArrowStreamPrivate::Release;
+    out_stream->private_data = psPrivate;
+    return true;
+}
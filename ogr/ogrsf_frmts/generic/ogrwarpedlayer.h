@@ -98,6 +98,9 @@ class OGRWarpedLayer : public OGRLayerDecorator
     virtual OGRErr GetExtent(OGREnvelope *psExtent, int bForce = TRUE) override;
 
     virtual int TestCapability(const char *) override;
+
+    virtual bool GetArrowStream(struct ArrowArrayStream *out_stream,
+                                CSLConstList papszOptions = nullptr) override;
 };
 
 #endif /* #ifndef DOXYGEN_SKIP */
@@ -27,9 +27,11 @@
  ****************************************************************************/
 
 #include "cpl_port.h"
+#include "cpl_error_internal.h"
 #include "cpl_vsi_virtual.h"
 #include "cpl_http.h"
 #include "cpl_vsi_error.h"
+#include "gdal_thread_pool.h"
 
 #include "ogr_geojson.h"
 #include "ogrgeojsonreader.h"
@@ -37,6 +39,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 
 constexpr char RS = '\x1e';
 
@@ -44,6 +48,8 @@ constexpr char RS = '\x1e';
 /*                        OGRGeoJSONSeqDataSource                       */
 /************************************************************************/
 
+class OGRGeoJSONSeqLayer;
+
 class OGRGeoJSONSeqDataSource final : public GDALDataset
 {
     friend class OGRGeoJSONSeqLayer;
@@ -55,6 +61,12 @@ class OGRGeoJSONSeqDataSource final : public GDALDataset
     bool m_bAtEOF = false;
     bool m_bIsRSSeparated = false;
 
+    // Layer whose features have been accepted by ICreateFeature() but not
+    // yet written to m_fp.
+    OGRGeoJSONSeqLayer *m_poLayerWithPendingFeatures = nullptr;
+
+    OGRErr FlushPendingFeatures();
+
   public:
     OGRGeoJSONSeqDataSource();
     ~OGRGeoJSONSeqDataSource();
@@ -104,7 +116,12 @@ class OGRGeoJSONSeqLayer final : public OGRLayer
     OGRGeometryFactory::TransformWithOptionsCache m_oTransformCache;
     OGRGeoJSONWriteOptions m_oWriteOptions;
 
+    // Serialization of features by worker threads (write-only layers)
+    int m_nWriterThreads = 1;
+    std::vector<std::unique_ptr<OGRFeature>> m_apoPendingFeatures{};
+
     json_object *GetNextObject(bool bLooseIdentification);
+    OGRErr WriteJSon(const char *pszJson, size_t nLen);
 
   public:
     OGRGeoJSONSeqLayer(OGRGeoJSONSeqDataSource *poDS, const char *pszName);
@@ -133,6 +150,8 @@ class OGRGeoJSONSeqLayer final : public OGRLayer
     int TestCapability(const char *) override;
     OGRErr ICreateFeature(OGRFeature *poFeature) override;
     OGRErr CreateField(const OGRFieldDefn *, int) override;
+
+    OGRErr FlushPendingFeatures();
 };
 
 /************************************************************************/
@@ -149,6 +168,7 @@ OGRGeoJSONSeqDataSource::OGRGeoJSONSeqDataSource()
 
 OGRGeoJSONSeqDataSource::~OGRGeoJSONSeqDataSource()
 {
+    FlushPendingFeatures();
     if (m_fp)
     {
         VSIFCloseL(m_fp);
@@ -159,6 +179,17 @@ OGRGeoJSONSeqDataSource::~OGRGeoJSONSeqDataSource()
     }
 }
 
+/************************************************************************/
+/*                        FlushPendingFeatures()                        */
+/************************************************************************/
+
+OGRErr OGRGeoJSONSeqDataSource::FlushPendingFeatures()
+{
+    if (m_poLayerWithPendingFeatures == nullptr)
+        return OGRERR_NONE;
+    return m_poLayerWithPendingFeatures->FlushPendingFeatures();
+}
+
 /************************************************************************/
 /*                               GetLayer()                             */
 /************************************************************************/
@@ -286,6 +317,18 @@ OGRGeoJSONSeqLayer::OGRGeoJSONSeqLayer(
         CSLFetchNameValueDef(papszOptions, "WRITE_NON_FINITE_VALUES", "FALSE"));
     m_oWriteOptions.bAutodetectJsonStrings = CPLTestBool(
         CSLFetchNameValueDef(papszOptions, "AUTODETECT_JSON_STRINGS", "TRUE"));
+
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    m_nWriterThreads = pszNumThreads == nullptr
+                           ? std::min(4, CPLGetNumCPUs())
+                       : EQUAL(pszNumThreads, "ALL_CPUS")
+                           ? CPLGetNumCPUs()
+                           : std::max(1, std::min(128, atoi(pszNumThreads)));
+    if (m_nWriterThreads > 1 &&
+        GDALGetGlobalThreadPool(m_nWriterThreads) == nullptr)
+    {
+        m_nWriterThreads = 1;
+    }
 }
 
 /************************************************************************/
@@ -384,6 +427,8 @@ bool OGRGeoJSONSeqLayer::Init(bool bLooseIdentification,
 
 void OGRGeoJSONSeqLayer::ResetReading()
 {
+    m_poDS->FlushPendingFeatures();
+
     if (!m_poDS->m_bSupportsRead ||
         (m_bWriteOnlyLayer && m_poDS->m_apoLayers.size() > 1))
     {
@@ -512,6 +557,8 @@ json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
 
 OGRFeature *OGRGeoJSONSeqLayer::GetNextFeature()
 {
+    m_poDS->FlushPendingFeatures();
+
     if (!m_poDS->m_bSupportsRead)
     {
         return nullptr;
@@ -615,6 +662,12 @@ OGRErr OGRGeoJSONSeqLayer::ICreateFeature(OGRFeature *poFeature)
     if (m_poDS->GetAccess() != GA_Update)
         return OGRERR_FAILURE;
 
+    if (m_poDS->m_poLayerWithPendingFeatures != this &&
+        m_poDS->FlushPendingFeatures() != OGRERR_NONE)
+    {
+        return OGRERR_FAILURE;
+    }
+
     if (!m_poDS->m_bAtEOF)
     {
         m_poDS->m_bAtEOF = true;
@@ -656,25 +709,119 @@ OGRErr OGRGeoJSONSeqLayer::ICreateFeature(OGRFeature *poFeature)
 
     ++m_nTotalFeatures;
 
+    if (m_bWriteOnlyLayer && m_nWriterThreads > 1)
+    {
+        // Defer serialization to FlushPendingFeatures()
+        if (!poFeatureToWrite)
+            poFeatureToWrite.reset(poFeature->Clone());
+        m_apoPendingFeatures.push_back(std::move(poFeatureToWrite));
+        m_poDS->m_poLayerWithPendingFeatures = this;
+        constexpr size_t FEATURES_PER_JOB = 256;
+        if (m_apoPendingFeatures.size() >=
+            FEATURES_PER_JOB * static_cast<size_t>(m_nWriterThreads))
+        {
+            return FlushPendingFeatures();
+        }
+        return OGRERR_NONE;
+    }
+
     json_object *poObj = OGRGeoJSONWriteFeature(
         poFeatureToWrite.get() ? poFeatureToWrite.get() : poFeature,
         m_oWriteOptions);
     CPLAssert(nullptr != poObj);
 
     const char *pszJson = json_object_to_json_string(poObj);
+    const OGRErr eErr = WriteJSon(pszJson, strlen(pszJson));
+    json_object_put(poObj);
 
+    return eErr;
+}
+
+/************************************************************************/
+/*                             WriteJSon()                              */
+/************************************************************************/
+
+OGRErr OGRGeoJSONSeqLayer::WriteJSon(const char *pszJson, size_t nLen)
+{
     char chEOL = '\n';
-    OGRErr eErr = OGRERR_NONE;
     if ((m_poDS->m_bIsRSSeparated &&
          VSIFWriteL(&RS, 1, 1, m_poDS->m_fp) != 1) ||
-        VSIFWriteL(pszJson, strlen(pszJson), 1, m_poDS->m_fp) != 1 ||
+        VSIFWriteL(pszJson, nLen, 1, m_poDS->m_fp) != 1 ||
         VSIFWriteL(&chEOL, 1, 1, m_poDS->m_fp) != 1)
     {
         CPLError(CE_Failure, CPLE_FileIO, "Cannot write feature");
-        eErr = OGRERR_FAILURE;
+        return OGRERR_FAILURE;
     }
+    return OGRERR_NONE;
+}
 
-    json_object_put(poObj);
+/************************************************************************/
+/*                       FlushPendingFeatures()                         */
+/************************************************************************/
+
+// Serializes the features queued by ICreateFeature() with the global thread
+// pool, and writes them in order.
+OGRErr OGRGeoJSONSeqLayer::FlushPendingFeatures()
+{
+    if (m_poDS->m_poLayerWithPendingFeatures == this)
+        m_poDS->m_poLayerWithPendingFeatures = nullptr;
+    if (m_apoPendingFeatures.empty())
+        return OGRERR_NONE;
+
+    struct JobData
+    {
+        const OGRGeoJSONWriteOptions *poOptions = nullptr;
+        const std::unique_ptr<OGRFeature> *papoFeatures = nullptr;
+        size_t nFeatures = 0;
+        std::vector<std::string> aosJSon{};
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    };
+
+    const auto SerializeJob = [](void *pData)
+    {
+        JobData *psJob = static_cast<JobData *>(pData);
+        CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+        psJob->aosJSon.reserve(psJob->nFeatures);
+        for (size_t i = 0; i < psJob->nFeatures; ++i)
+        {
+            json_object *poObj = OGRGeoJSONWriteFeature(
+                psJob->papoFeatures[i].get(), *(psJob->poOptions));
+            psJob->aosJSon.emplace_back(json_object_to_json_string(poObj));
+            json_object_put(poObj);
+        }
+        CPLUninstallErrorHandlerAccumulator();
+    };
+
+    const size_t nJobs = std::min(static_cast<size_t>(m_nWriterThreads),
+                                  m_apoPendingFeatures.size());
+    const size_t nFeaturesPerJob =
+        (m_apoPendingFeatures.size() + nJobs - 1) / nJobs;
+    std::vector<JobData> asJobs(nJobs);
+    auto poQueue = GDALGetGlobalThreadPool(m_nWriterThreads)->CreateJobQueue();
+    for (size_t i = 0; i < nJobs; ++i)
+    {
+        const size_t nStart = std::min(i * nFeaturesPerJob,
+                                       m_apoPendingFeatures.size());
+        asJobs[i].poOptions = &m_oWriteOptions;
+        asJobs[i].papoFeatures = m_apoPendingFeatures.data() + nStart;
+        asJobs[i].nFeatures = std::min(
+            nFeaturesPerJob, m_apoPendingFeatures.size() - nStart);
+        poQueue->SubmitJob(SerializeJob, &asJobs[i]);
+    }
+    poQueue->WaitCompletion();
+    m_apoPendingFeatures.clear();
+
+    OGRErr eErr = OGRERR_NONE;
+    for (const auto &sJob : asJobs)
+    {
+        for (const auto &oError : sJob.aoErrors)
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        for (const auto &osJSon : sJob.aosJSon)
+        {
+            if (eErr == OGRERR_NONE)
+                eErr = WriteJSon(osJSon.c_str(), osJSon.size());
+        }
+    }
 
     return eErr;
 }
@@ -688,6 +835,8 @@ OGRErr OGRGeoJSONSeqLayer::CreateField(const OGRFieldDefn *poField,
 {
     if (m_poDS->GetAccess() != GA_Update)
         return OGRERR_FAILURE;
+    // Pending features must be serialized with the current layer definition
+    FlushPendingFeatures();
     m_poFeatureDefn->AddFieldDefn(poField);
     return OGRERR_NONE;
 }
@@ -44,6 +44,7 @@
 #include "ogr_p.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <limits>
 
@@ -926,10 +927,11 @@ json_object *OGRGeoJSONWriteAttributes(OGRFeature *poFeature,
             {
                 if (!oOptions.bAllowNonFiniteValues)
                 {
-                    static bool bHasWarned = false;
-                    if (!bHasWarned)
+                    // May be called from several threads by the GeoJSONSeq
+                    // writer.
+                    static std::atomic<bool> bHasWarned{false};
+                    if (!bHasWarned.exchange(true))
                     {
-                        bHasWarned = true;
                         CPLError(CE_Warning, CPLE_AppDefined,
                                  "NaN of Infinity value found. Skipped");
                     }
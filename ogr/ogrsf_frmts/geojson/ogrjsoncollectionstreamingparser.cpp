@@ -39,6 +39,7 @@
 #include <json_object_private.h>  // just for sizeof(struct json_object)
 #endif
 
+#include <climits>
 #include <limits>
 
 #if (!defined(JSON_C_VERSION_NUM)) || (JSON_C_VERSION_NUM < JSON_C_VER_013)
@@ -272,8 +273,8 @@ void OGRJSONCollectionStreamingParser::StartObjectMember(const char *pszKey,
             if (!m_abFirstMember.back())
                 m_osJson += ",";
             m_abFirstMember.back() = false;
-            m_osJson +=
-                CPLJSonStreamingParser::GetSerializedString(pszKey) + ":";
+            m_osJson += CPLJSonStreamingParser::GetSerializedString(pszKey);
+            m_osJson += ':';
         }
 
         m_nCurObjMemEstimate += ESTIMATE_OBJECT_ELT_SIZE;
@@ -394,7 +395,11 @@ void OGRJSONCollectionStreamingParser::String(const char *pszValue, size_t nLen)
         {
             m_osJson += CPLJSonStreamingParser::GetSerializedString(pszValue);
         }
-        AppendObject(json_object_new_string(pszValue));
+        // Avoid a strlen() on the value, whose length is already known
+        AppendObject(nLen <= static_cast<size_t>(INT_MAX)
+                         ? json_object_new_string_len(pszValue,
+                                                      static_cast<int>(nLen))
+                         : json_object_new_string(pszValue));
     }
 }
 
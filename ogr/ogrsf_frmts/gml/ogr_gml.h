@@ -36,7 +36,10 @@
 #include "gmlreader.h"
 #include "gmlutils.h"
 
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 class OGRGMLDataSource;
@@ -73,6 +76,24 @@ class OGRGMLLayer final : public OGRLayer
 
     bool bFaceHoleNegative;
 
+    // Features read ahead from the reader, whose geometries are built by
+    // worker threads.
+    struct PrefetchedFeature;
+    std::deque<std::unique_ptr<PrefetchedFeature>> m_apoPrefetchedFeatures{};
+    int m_nGeomBuildingThreads = -1;
+
+    // Pool of SRS caches, since hCacheSRS must not be shared between threads.
+    std::mutex m_oMutexWorkerCacheSRS{};
+    std::vector<void *> m_ahWorkerCacheSRS{};
+
+    bool BuildGeometries(const GMLFeature *poGMLFeature,
+                         const char *pszSRSName, void *hCacheSRSIn,
+                         std::vector<OGRGeometry *> &apoGeometries,
+                         std::string &osErrorMsg) const;
+    bool CanPrefetchFeatures();
+    void PrefetchFeatures();
+    void ClearPrefetchedFeatures();
+
   public:
     OGRGMLLayer(const char *pszName, bool bWriter, OGRGMLDataSource *poDS);
 
@@ -30,11 +30,45 @@
 #include "ogr_gml.h"
 #include "gmlutils.h"
 #include "cpl_conv.h"
+#include "cpl_error_internal.h"
 #include "cpl_port.h"
 #include "cpl_string.h"
+#include "gdal_thread_pool.h"
 #include "ogr_p.h"
 #include "ogr_api.h"
 
+#include <algorithm>
+
+/************************************************************************/
+/*                   OGRGMLLayer::PrefetchedFeature                     */
+/************************************************************************/
+
+struct OGRGMLLayer::PrefetchedFeature
+{
+    GMLFeature *poGMLFeature = nullptr;
+
+    // Value of OGRGMLDataSource::GetGlobalSRSName() when the feature was read
+    bool bHasSRSName = false;
+    std::string osSRSName{};
+
+    // Output of BuildGeometries(), run by a worker thread.
+    bool bGeomOK = true;
+    std::vector<OGRGeometry *> apoGeometries{};
+    std::string osGeomErrorMsg{};
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+
+    PrefetchedFeature() = default;
+
+    ~PrefetchedFeature()
+    {
+        delete poGMLFeature;
+        for (auto *poGeom : apoGeometries)
+            delete poGeom;
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(PrefetchedFeature)
+};
+
 /************************************************************************/
 /*                           OGRGMLLayer()                              */
 /************************************************************************/
@@ -69,12 +103,16 @@ OGRGMLLayer::OGRGMLLayer(const char *pszName, bool bWriterIn,
 OGRGMLLayer::~OGRGMLLayer()
 
 {
+    ClearPrefetchedFeatures();
+
     CPLFree(pszFIDPrefix);
 
     if (poFeatureDefn)
         poFeatureDefn->Release();
 
     GML_BuildOGRGeometryFromList_DestroyCache(hCacheSRS);
+    for (void *hCacheSRSWorker : m_ahWorkerCacheSRS)
+        GML_BuildOGRGeometryFromList_DestroyCache(hCacheSRSWorker);
 }
 
 /************************************************************************/
@@ -100,6 +138,7 @@ void OGRGMLLayer::ResetReading()
         poDS->SetStoredGMLFeature(nullptr);
     }
 
+    ClearPrefetchedFeatures();
     iNextGMLId = 0;
     poDS->GetReader()->ResetReading();
     CPLDebug("GML", "ResetReading()");
@@ -113,6 +152,250 @@ void OGRGMLLayer::ResetReading()
     }
 }
 
+/************************************************************************/
+/*                      ClearPrefetchedFeatures()                       */
+/************************************************************************/
+
+void OGRGMLLayer::ClearPrefetchedFeatures()
+{
+    m_apoPrefetchedFeatures.clear();
+}
+
+/************************************************************************/
+/*                         BuildGeometries()                            */
+/************************************************************************/
+
+// Builds the geometries of poGMLFeature: one per geometry field if there
+// are several of them, or a single one otherwise.
+// This only reads state that is immutable during reading, and may thus be
+// called from worker threads, provided each one uses its own hCacheSRSIn.
+bool OGRGMLLayer::BuildGeometries(const GMLFeature *poGMLFeature,
+                                  const char *pszSRSName, void *hCacheSRSIn,
+                                  std::vector<OGRGeometry *> &apoGeometries,
+                                  std::string &osErrorMsg) const
+{
+    const int nGeomFieldCount = poFeatureDefn->GetGeomFieldCount();
+    if (nGeomFieldCount > 1)
+    {
+        apoGeometries.resize(nGeomFieldCount, nullptr);
+        for (int i = 0; i < nGeomFieldCount; i++)
+        {
+            const CPLXMLNode *psGeom = poGMLFeature->GetGeometryRef(i);
+            if (psGeom == nullptr)
+                continue;
+
+            const CPLXMLNode *myGeometryList[2] = {psGeom, nullptr};
+            OGRGeometry *poGeom = GML_BuildOGRGeometryFromList(
+                myGeometryList, true, poDS->GetInvertAxisOrderIfLatLong(),
+                pszSRSName, poDS->GetConsiderEPSGAsURN(),
+                poDS->GetSwapCoordinates(), poDS->GetSecondaryGeometryOption(),
+                hCacheSRSIn, bFaceHoleNegative);
+            if (poGeom == nullptr)
+            {
+                // We assume the createFromGML() function would have
+                // already reported the error.
+                for (auto &poOtherGeom : apoGeometries)
+                {
+                    delete poOtherGeom;
+                    poOtherGeom = nullptr;
+                }
+                return false;
+            }
+
+            // Do geometry type changes if needed to match layer
+            // geometry type.
+            apoGeometries[i] = OGRGeometryFactory::forceTo(
+                poGeom, poFeatureDefn->GetGeomFieldDefn(i)->GetType());
+        }
+        return true;
+    }
+
+    apoGeometries.resize(1, nullptr);
+
+    const CPLXMLNode *const *papsGeometry = poGMLFeature->GetGeometryList();
+    const CPLXMLNode *apsGeometries[2] = {nullptr, nullptr};
+    const CPLXMLNode *psBoundedByGeometry =
+        poGMLFeature->GetBoundedByGeometry();
+    if (psBoundedByGeometry && !(papsGeometry && papsGeometry[0]))
+    {
+        apsGeometries[0] = psBoundedByGeometry;
+        papsGeometry = apsGeometries;
+    }
+
+    if (papsGeometry[0] == nullptr ||
+        strcmp(papsGeometry[0]->pszValue, "null") == 0)
+    {
+        return true;
+    }
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    OGRGeometry *poGeom = GML_BuildOGRGeometryFromList(
+        papsGeometry, true, poDS->GetInvertAxisOrderIfLatLong(), pszSRSName,
+        poDS->GetConsiderEPSGAsURN(), poDS->GetSwapCoordinates(),
+        poDS->GetSecondaryGeometryOption(), hCacheSRSIn, bFaceHoleNegative);
+    CPLPopErrorHandler();
+
+    if (poGeom == nullptr)
+    {
+        osErrorMsg = CPLGetLastErrorMsg();
+        return false;
+    }
+
+    // Do geometry type changes if needed to match layer geometry type.
+    apoGeometries[0] =
+        OGRGeometryFactory::forceTo(poGeom, poFeatureDefn->GetGeomType());
+    return true;
+}
+
+/************************************************************************/
+/*                        CanPrefetchFeatures()                         */
+/************************************************************************/
+
+// Whether geometries can be built by worker threads. This is not done in
+// the INTERLEAVED_LAYERS read mode, where reading ahead would consume
+// features of other layers.
+bool OGRGMLLayer::CanPrefetchFeatures()
+{
+    if (poDS->GetReadMode() == INTERLEAVED_LAYERS ||
+        poFeatureDefn->GetGeomFieldCount() == 0)
+    {
+        return false;
+    }
+
+    if (m_nGeomBuildingThreads < 0)
+    {
+        const char *pszNumThreads =
+            CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+        m_nGeomBuildingThreads =
+            pszNumThreads == nullptr ? std::min(4, CPLGetNumCPUs())
+            : EQUAL(pszNumThreads, "ALL_CPUS")
+                ? CPLGetNumCPUs()
+                : std::max(1, std::min(128, atoi(pszNumThreads)));
+        if (m_nGeomBuildingThreads > 1 &&
+            GDALGetGlobalThreadPool(m_nGeomBuildingThreads) == nullptr)
+        {
+            m_nGeomBuildingThreads = 1;
+        }
+    }
+
+    return m_nGeomBuildingThreads > 1;
+}
+
+/************************************************************************/
+/*                         PrefetchFeatures()                           */
+/************************************************************************/
+
+// Reads a batch of features of this layer from the reader, and builds their
+// geometries with the global thread pool. The reader keeps parsing in the
+// calling thread while jobs for the already read features are running.
+// Features are queued in m_apoPrefetchedFeatures in file order.
+void OGRGMLLayer::PrefetchFeatures()
+{
+    constexpr size_t FEATURES_PER_JOB = 32;
+    const size_t nMaxFeatures =
+        FEATURES_PER_JOB * 4 * static_cast<size_t>(m_nGeomBuildingThreads);
+
+    struct JobData
+    {
+        OGRGMLLayer *poLayer = nullptr;
+        std::vector<PrefetchedFeature *> apoFeatures{};
+    };
+
+    const auto BuildGeometriesJob = [](void *pData)
+    {
+        JobData *psJob = static_cast<JobData *>(pData);
+        OGRGMLLayer *poLayer = psJob->poLayer;
+
+        void *hCacheSRSWorker = nullptr;
+        {
+            std::lock_guard<std::mutex> oLock(poLayer->m_oMutexWorkerCacheSRS);
+            if (!poLayer->m_ahWorkerCacheSRS.empty())
+            {
+                hCacheSRSWorker = poLayer->m_ahWorkerCacheSRS.back();
+                poLayer->m_ahWorkerCacheSRS.pop_back();
+            }
+        }
+        if (hCacheSRSWorker == nullptr)
+            hCacheSRSWorker = GML_BuildOGRGeometryFromList_CreateCache();
+
+        for (PrefetchedFeature *poFeature : psJob->apoFeatures)
+        {
+            // Errors are replayed in the thread calling GetNextFeature()
+            CPLInstallErrorHandlerAccumulator(poFeature->aoErrors);
+            poFeature->bGeomOK = poLayer->BuildGeometries(
+                poFeature->poGMLFeature,
+                poFeature->bHasSRSName ? poFeature->osSRSName.c_str()
+                                       : nullptr,
+                hCacheSRSWorker, poFeature->apoGeometries,
+                poFeature->osGeomErrorMsg);
+            CPLUninstallErrorHandlerAccumulator();
+        }
+
+        std::lock_guard<std::mutex> oLock(poLayer->m_oMutexWorkerCacheSRS);
+        poLayer->m_ahWorkerCacheSRS.push_back(hCacheSRSWorker);
+    };
+
+    auto poQueue =
+        GDALGetGlobalThreadPool(m_nGeomBuildingThreads)->CreateJobQueue();
+    std::vector<std::unique_ptr<JobData>> apoJobs;
+    std::unique_ptr<JobData> poCurJob;
+    size_t nFeatures = 0;
+    IGMLReader *poReader = poDS->GetReader();
+    while (nFeatures < nMaxFeatures)
+    {
+        GMLFeature *poGMLFeature = poReader->NextFeature();
+        if (poGMLFeature == nullptr)
+            break;
+        m_nFeaturesRead++;
+
+        if (poGMLFeature->GetClass() != poFClass)
+        {
+            // Same logic as in GetNextFeature(): in SEQUENTIAL_LAYERS mode,
+            // once features of this layer have been read, a feature of
+            // another layer marks the end of this one.
+            if (poDS->GetReadMode() == SEQUENTIAL_LAYERS &&
+                (iNextGMLId != 0 || !m_apoPrefetchedFeatures.empty()))
+            {
+                CPLAssert(poDS->PeekStoredGMLFeature() == nullptr);
+                poDS->SetStoredGMLFeature(poGMLFeature);
+                break;
+            }
+            delete poGMLFeature;
+            continue;
+        }
+
+        auto poFeature = std::make_unique<PrefetchedFeature>();
+        poFeature->poGMLFeature = poGMLFeature;
+        const char *pszSRSName = poDS->GetGlobalSRSName();
+        if (pszSRSName)
+        {
+            poFeature->bHasSRSName = true;
+            poFeature->osSRSName = pszSRSName;
+        }
+
+        if (!poCurJob)
+        {
+            poCurJob = std::make_unique<JobData>();
+            poCurJob->poLayer = this;
+        }
+        poCurJob->apoFeatures.push_back(poFeature.get());
+        m_apoPrefetchedFeatures.push_back(std::move(poFeature));
+        ++nFeatures;
+
+        if (poCurJob->apoFeatures.size() == FEATURES_PER_JOB)
+        {
+            poQueue->SubmitJob(BuildGeometriesJob, poCurJob.get());
+            apoJobs.push_back(std::move(poCurJob));
+        }
+    }
+    if (poCurJob)
+    {
+        poQueue->SubmitJob(BuildGeometriesJob, poCurJob.get());
+        apoJobs.push_back(std::move(poCurJob));
+    }
+    poQueue->WaitCompletion();
+}
+
 /************************************************************************/
 /*                              Increment()                             */
 /************************************************************************/
@@ -151,11 +434,25 @@ OGRFeature *OGRGMLLayer::GetNextFeature()
     /* ==================================================================== */
     while (true)
     {
+        std::unique_ptr<PrefetchedFeature> poPrefetchedFeature;
         GMLFeature *poGMLFeature = poDS->PeekStoredGMLFeature();
         if (poGMLFeature != nullptr)
         {
             poDS->SetStoredGMLFeature(nullptr);
         }
+        else if (CanPrefetchFeatures())
+        {
+            if (m_apoPrefetchedFeatures.empty())
+            {
+                PrefetchFeatures();
+                if (m_apoPrefetchedFeatures.empty())
+                    return nullptr;
+            }
+            poPrefetchedFeature = std::move(m_apoPrefetchedFeatures.front());
+            m_apoPrefetchedFeatures.pop_front();
+            poGMLFeature = poPrefetchedFeature->poGMLFeature;
+            poPrefetchedFeature->poGMLFeature = nullptr;
+        }
         else
         {
             poGMLFeature = poDS->GetReader()->NextFeature();
@@ -276,128 +573,68 @@ OGRFeature *OGRGMLLayer::GetNextFeature()
         /* --------------------------------------------------------------------
          */
 
-        OGRGeometry **papoGeometries = nullptr;
-        const CPLXMLNode *const *papsGeometry = poGMLFeature->GetGeometryList();
-
-        const CPLXMLNode *apsGeometries[2] = {nullptr, nullptr};
-        const CPLXMLNode *psBoundedByGeometry =
-            poGMLFeature->GetBoundedByGeometry();
-        if (psBoundedByGeometry && !(papsGeometry && papsGeometry[0]))
+        std::vector<OGRGeometry *> apoGeometries;
+        std::string osGeomErrorMsg;
+        bool bGeomOK;
+        if (poPrefetchedFeature)
         {
-            apsGeometries[0] = psBoundedByGeometry;
-            papsGeometry = apsGeometries;
+            for (const auto &oError : poPrefetchedFeature->aoErrors)
+                CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+            bGeomOK = poPrefetchedFeature->bGeomOK;
+            std::swap(apoGeometries, poPrefetchedFeature->apoGeometries);
+            std::swap(osGeomErrorMsg, poPrefetchedFeature->osGeomErrorMsg);
+            poPrefetchedFeature.reset();
+        }
+        else
+        {
+            bGeomOK = BuildGeometries(poGMLFeature, poDS->GetGlobalSRSName(),
+                                      hCacheSRS, apoGeometries, osGeomErrorMsg);
         }
-
-        OGRGeometry *poGeom = nullptr;
 
         if (poFeatureDefn->GetGeomFieldCount() > 1)
         {
-            papoGeometries = static_cast<OGRGeometry **>(CPLCalloc(
-                poFeatureDefn->GetGeomFieldCount(), sizeof(OGRGeometry *)));
-            const char *pszSRSName = poDS->GetGlobalSRSName();
-            for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++)
+            if (!bGeomOK)
             {
-                const CPLXMLNode *psGeom = poGMLFeature->GetGeometryRef(i);
-                if (psGeom != nullptr)
-                {
-                    const CPLXMLNode *myGeometryList[2] = {psGeom, nullptr};
-                    poGeom = GML_BuildOGRGeometryFromList(
-                        myGeometryList, true,
-                        poDS->GetInvertAxisOrderIfLatLong(), pszSRSName,
-                        poDS->GetConsiderEPSGAsURN(),
-                        poDS->GetSwapCoordinates(),
-                        poDS->GetSecondaryGeometryOption(), hCacheSRS,
-                        bFaceHoleNegative);
-
-                    // Do geometry type changes if needed to match layer
-                    // geometry type.
-                    if (poGeom != nullptr)
-                    {
-                        papoGeometries[i] = OGRGeometryFactory::forceTo(
-                            poGeom,
-                            poFeatureDefn->GetGeomFieldDefn(i)->GetType());
-                        poGeom = nullptr;
-                    }
-                    else
-                    {
-                        // We assume the createFromGML() function would have
-                        // already reported the error.
-                        for (int j = 0; j < poFeatureDefn->GetGeomFieldCount();
-                             j++)
-                        {
-                            delete papoGeometries[j];
-                        }
-                        CPLFree(papoGeometries);
-                        delete poGMLFeature;
-                        return nullptr;
-                    }
-                }
+                delete poGMLFeature;
+                return nullptr;
             }
 
             if (m_poFilterGeom != nullptr && m_iGeomFieldFilter >= 0 &&
                 m_iGeomFieldFilter < poFeatureDefn->GetGeomFieldCount() &&
-                papoGeometries[m_iGeomFieldFilter] &&
-                !FilterGeometry(papoGeometries[m_iGeomFieldFilter]))
+                apoGeometries[m_iGeomFieldFilter] &&
+                !FilterGeometry(apoGeometries[m_iGeomFieldFilter]))
             {
-                for (int j = 0; j < poFeatureDefn->GetGeomFieldCount(); j++)
-                {
-                    delete papoGeometries[j];
-                }
-                CPLFree(papoGeometries);
+                for (auto *poGeom : apoGeometries)
+                    delete poGeom;
                 delete poGMLFeature;
                 continue;
             }
         }
-        else if (papsGeometry[0] &&
-                 strcmp(papsGeometry[0]->pszValue, "null") == 0)
+        else if (!bGeomOK)
         {
-            // do nothing
+            const bool bGoOn = CPLTestBool(
+                CPLGetConfigOption("GML_SKIP_CORRUPTED_FEATURES", "NO"));
+
+            CPLError(bGoOn ? CE_Warning : CE_Failure, CPLE_AppDefined,
+                     "Geometry of feature " CPL_FRMT_GIB
+                     " %scannot be parsed: %s%s",
+                     nFID, pszGML_FID ? CPLSPrintf("%s ", pszGML_FID) : "",
+                     osGeomErrorMsg.c_str(),
+                     bGoOn ? ". Skipping to next feature."
+                           : ". You may set the GML_SKIP_CORRUPTED_FEATURES "
+                             "configuration option to YES to skip to the next "
+                             "feature");
+            delete poGMLFeature;
+            if (bGoOn)
+                continue;
+            return nullptr;
         }
-        else if (papsGeometry[0] != nullptr)
+        else if (apoGeometries[0] != nullptr && m_poFilterGeom != nullptr &&
+                 !FilterGeometry(apoGeometries[0]))
         {
-            const char *pszSRSName = poDS->GetGlobalSRSName();
-            CPLPushErrorHandler(CPLQuietErrorHandler);
-            poGeom = GML_BuildOGRGeometryFromList(
-                papsGeometry, true, poDS->GetInvertAxisOrderIfLatLong(),
-                pszSRSName, poDS->GetConsiderEPSGAsURN(),
-                poDS->GetSwapCoordinates(), poDS->GetSecondaryGeometryOption(),
-                hCacheSRS, bFaceHoleNegative);
-            CPLPopErrorHandler();
-
-            // Do geometry type changes if needed to match layer geometry type.
-            if (poGeom != nullptr)
-            {
-                poGeom = OGRGeometryFactory::forceTo(poGeom, GetGeomType());
-            }
-            else
-            {
-                const CPLString osLastErrorMsg(CPLGetLastErrorMsg());
-
-                const bool bGoOn = CPLTestBool(
-                    CPLGetConfigOption("GML_SKIP_CORRUPTED_FEATURES", "NO"));
-
-                CPLError(
-                    bGoOn ? CE_Warning : CE_Failure, CPLE_AppDefined,
-                    "Geometry of feature " CPL_FRMT_GIB
-                    " %scannot be parsed: %s%s",
-                    nFID, pszGML_FID ? CPLSPrintf("%s ", pszGML_FID) : "",
-                    osLastErrorMsg.c_str(),
-                    bGoOn ? ". Skipping to next feature."
-                          : ". You may set the GML_SKIP_CORRUPTED_FEATURES "
-                            "configuration option to YES to skip to the next "
-                            "feature");
-                delete poGMLFeature;
-                if (bGoOn)
-                    continue;
-                return nullptr;
-            }
-
-            if (m_poFilterGeom != nullptr && !FilterGeometry(poGeom))
-            {
-                delete poGMLFeature;
-                delete poGeom;
-                continue;
-            }
+            delete poGMLFeature;
+            delete apoGeometries[0];
+            continue;
         }
 
         /* --------------------------------------------------------------------
@@ -548,24 +785,22 @@ OGRFeature *OGRGMLLayer::GetNextFeature()
 
         // Assign the geometry before the attribute filter because
         // the attribute filter may use a special field like OGR_GEOMETRY.
-        if (papoGeometries != nullptr)
+        if (poFeatureDefn->GetGeomFieldCount() > 1)
         {
             for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++)
             {
-                poOGRFeature->SetGeomFieldDirectly(i, papoGeometries[i]);
+                poOGRFeature->SetGeomFieldDirectly(i, apoGeometries[i]);
             }
-            CPLFree(papoGeometries);
-            papoGeometries = nullptr;
         }
         else
         {
-            poOGRFeature->SetGeometryDirectly(poGeom);
+            poOGRFeature->SetGeometryDirectly(apoGeometries[0]);
         }
 
         // Assign SRS.
         for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++)
         {
-            poGeom = poOGRFeature->GetGeomFieldRef(i);
+            OGRGeometry *poGeom = poOGRFeature->GetGeomFieldRef(i);
             if (poGeom != nullptr)
             {
                 const OGRSpatialReference *poSRS =
@@ -31,14 +31,49 @@
 #include "gdal_alg_priv.h"
 #include "ogrsqlitevfs.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 
 #include <algorithm>
 #include <limits>
+#include <string>
+#include <vector>
 
 #if !defined(DEBUG_VERBOSE) && defined(DEBUG_VERBOSE_GPKG)
 #define DEBUG_VERBOSE
 #endif
 
+/************************************************************************/
+/*                         GPKGTileEncodingJob                          */
+/************************************************************************/
+
+// Tile submitted to a worker thread for encoding. The result is inserted
+// in the database by FlushTileEncodingJobs(), from the main thread.
+struct GPKGTileEncodingJob
+{
+    int nRow = 0;
+    int nCol = 0;
+    GDALDriver *poDriver = nullptr;
+    CPLStringList aosDriverOptions{};
+    std::string osMemFileName{};
+    // Must be declared before poTileDS, whose bands point to it
+    std::vector<GByte> abyTileData{};
+    std::unique_ptr<GDALDataset> poTileDS{};
+    bool bSuccess = false;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+
+    GPKGTileEncodingJob() = default;
+    GPKGTileEncodingJob(const GPKGTileEncodingJob &) = delete;
+    GPKGTileEncodingJob &operator=(const GPKGTileEncodingJob &) = delete;
+
+    ~GPKGTileEncodingJob()
+    {
+        if (!osMemFileName.empty())
+            VSIUnlink(osMemFileName.c_str());
+    }
+};
+
 /************************************************************************/
 /*                    GDALGPKGMBTilesLikePseudoDataset()                */
 /************************************************************************/
@@ -65,6 +100,12 @@ GDALGPKGMBTilesLikePseudoDataset::GDALGPKGMBTilesLikePseudoDataset()
 
 GDALGPKGMBTilesLikePseudoDataset::~GDALGPKGMBTilesLikePseudoDataset()
 {
+    // Normally already flushed by FlushTiles(). Otherwise encoded tiles can
+    // no longer be inserted, since the database is owned by the subclass.
+    if (m_poTileEncodingQueue)
+        m_poTileEncodingQueue->WaitCompletion();
+    m_apoTileEncodingJobs.clear();
+
     if (m_poParentDS == nullptr && m_hTempDB != nullptr)
     {
         sqlite3_close(m_hTempDB);
@@ -82,6 +123,30 @@ GDALGPKGMBTilesLikePseudoDataset::~GDALGPKGMBTilesLikePseudoDataset()
     CPLFree(m_pabyHugeColorArray);
 }
 
+/************************************************************************/
+/*                           SetNumThreads()                            */
+/************************************************************************/
+
+void GDALGPKGMBTilesLikePseudoDataset::SetNumThreads(const char *pszValue)
+{
+    if (pszValue == nullptr)
+        pszValue = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszValue == nullptr)
+        return;
+    int nThreads =
+        EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue);
+    if (nThreads > 1024)
+        nThreads = 1024;  // to please Coverity
+    if (nThreads < 0 || (nThreads <= 1 && !EQUAL(pszValue, "0") &&
+                         !EQUAL(pszValue, "1") && !EQUAL(pszValue, "ALL_CPUS")))
+    {
+        CPLError(CE_Warning, CPLE_AppDefined,
+                 "Invalid value for NUM_THREADS: %s", pszValue);
+        return;
+    }
+    m_nNumThreads = std::max(1, nThreads);
+}
+
 /************************************************************************/
 /*                            SetDataType()                             */
 /************************************************************************/
@@ -168,6 +233,9 @@ CPLErr GDALGPKGMBTilesLikePseudoDataset::FlushTiles()
         }
     }
 
+    if (FlushTileEncodingJobs() != CE_None)
+        eErr = CE_Failure;
+
     if (poMainDS->m_nTileInsertionCount > 0)
     {
         if (poMainDS->ICommitTransaction() != OGRERR_NONE)
@@ -875,6 +943,9 @@ GByte *GDALGPKGMBTilesLikePseudoDataset::ReadTile(int nRow, int nCol,
     CPLDebug("GPKG", "ReadTile(row=%d, col=%d)", nRow, nCol);
 #endif
 
+    // Make sure that tiles being encoded are visible in the database
+    FlushTileEncodingJobs();
+
     char *pszSQL = sqlite3_mprintf(
         "SELECT tile_data%s FROM \"%w\" "
         "WHERE zoom_level = %d AND tile_row = %d AND tile_column = %d%s",
@@ -1258,6 +1329,8 @@ static bool WEBPSupports4Bands()
 
 GIntBig GDALGPKGMBTilesLikePseudoDataset::GetTileId(int nRow, int nCol)
 {
+    FlushTileEncodingJobs();
+
     char *pszSQL =
         sqlite3_mprintf("SELECT id FROM \"%w\" WHERE zoom_level = %d AND "
                         "tile_row = %d AND tile_column = %d",
@@ -1274,6 +1347,9 @@ GIntBig GDALGPKGMBTilesLikePseudoDataset::GetTileId(int nRow, int nCol)
 
 bool GDALGPKGMBTilesLikePseudoDataset::DeleteTile(int nRow, int nCol)
 {
+    // Pending insertions of that tile must not happen after its deletion
+    FlushTileEncodingJobs();
+
     char *pszSQL =
         sqlite3_mprintf("DELETE FROM \"%w\" "
                         "WHERE zoom_level = %d AND tile_row = %d AND "
@@ -2212,6 +2288,19 @@ CPLErr GDALGPKGMBTilesLikePseudoDataset::WriteTileInternal()
                                     CPLSPrintf("%d", nBlockYSize));
             }
         }
+        // Byte tiles are encoded by worker threads if NUM_THREADS > 1.
+        // Elevation tiles need their tile id for the ancillary table, and
+        // are thus still encoded and inserted synchronously.
+        if (m_nNumThreads > 1 && m_eDT == GDT_Byte)
+        {
+            eErr = SubmitTileEncodingJob(nRow, nCol, l_poDriver, poMEMDS,
+                                         papszDriverOptions);
+            CSLDestroy(papszDriverOptions);
+            CPLFree(pTempTileBuffer);
+            delete poMEMDS;
+            return eErr;
+        }
+
 #ifdef DEBUG
         VSIStatBufL sStat;
         CPLAssert(VSIStatL(osMemFileName, &sStat) != 0);
@@ -2229,64 +2318,15 @@ CPLErr GDALGPKGMBTilesLikePseudoDataset::WriteTileInternal()
             GByte *pabyBlob =
                 VSIGetMemFileBuffer(osMemFileName, &nBlobSize, TRUE);
 
-            /* Create or commit and recreate transaction */
+            eErr = InsertTile(nRow, nCol, pabyBlob, nBlobSize);
             GDALGPKGMBTilesLikePseudoDataset *poMainDS =
                 m_poParentDS ? m_poParentDS : this;
-            if (poMainDS->m_nTileInsertionCount == 0)
-            {
-                poMainDS->IStartTransaction();
-            }
-            else if (poMainDS->m_nTileInsertionCount == 1000)
-            {
-                if (poMainDS->ICommitTransaction() != OGRERR_NONE)
-                {
-                    poMainDS->m_nTileInsertionCount = -1;
-                    CPLFree(pabyBlob);
-                    VSIUnlink(osMemFileName);
-                    delete poMEMDS;
-                    return CE_Failure;
-                }
-                poMainDS->IStartTransaction();
-                poMainDS->m_nTileInsertionCount = 0;
-            }
-            poMainDS->m_nTileInsertionCount++;
-
-            char *pszSQL =
-                sqlite3_mprintf("INSERT OR REPLACE INTO \"%w\" "
-                                "(zoom_level, tile_row, tile_column, "
-                                "tile_data) VALUES (%d, %d, %d, ?)",
-                                m_osRasterTable.c_str(), m_nZoomLevel,
-                                GetRowFromIntoTopConvention(nRow), nCol);
-#ifdef DEBUG_VERBOSE
-            CPLDebug("GPKG", "%s", pszSQL);
-#endif
-            sqlite3_stmt *hStmt = nullptr;
-            int rc = sqlite3_prepare_v2(IGetDB(), pszSQL, -1, &hStmt, nullptr);
-            if (rc != SQLITE_OK)
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "failed to prepare SQL %s: %s", pszSQL,
-                         sqlite3_errmsg(IGetDB()));
-                CPLFree(pabyBlob);
-            }
-            else
+            if (poMainDS->m_nTileInsertionCount < 0)
             {
-                sqlite3_bind_blob(hStmt, 1, pabyBlob,
-                                  static_cast<int>(nBlobSize), CPLFree);
-                rc = sqlite3_step(hStmt);
-                if (rc == SQLITE_DONE)
-                    eErr = CE_None;
-                else
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "Failure when inserting tile (row=%d,col=%d) at "
-                             "zoom_level=%d : %s",
-                             GetRowFromIntoTopConvention(nRow), nCol,
-                             m_nZoomLevel, sqlite3_errmsg(IGetDB()));
-                }
+                VSIUnlink(osMemFileName);
+                delete poMEMDS;
+                return CE_Failure;
             }
-            sqlite3_finalize(hStmt);
-            sqlite3_free(pszSQL);
 
             if (m_eTF == GPKG_TF_PNG_16BIT || m_eTF == GPKG_TF_TIFF_32BIT_FLOAT)
             {
@@ -2297,7 +2337,7 @@ CPLErr GDALGPKGMBTilesLikePseudoDataset::WriteTileInternal()
                 {
                     DeleteFromGriddedTileAncillary(nTileId);
 
-                    pszSQL = sqlite3_mprintf(
+                    char *pszSQL = sqlite3_mprintf(
                         "INSERT INTO gpkg_2d_gridded_tile_ancillary "
                         "(tpudt_name, tpudt_id, scale, offset, min, max, "
                         "mean, std_dev) VALUES "
@@ -2306,9 +2346,9 @@ CPLErr GDALGPKGMBTilesLikePseudoDataset::WriteTileInternal()
 #ifdef DEBUG_VERBOSE
                     CPLDebug("GPKG", "%s", pszSQL);
 #endif
-                    hStmt = nullptr;
-                    rc = sqlite3_prepare_v2(IGetDB(), pszSQL, -1, &hStmt,
-                                            nullptr);
+                    sqlite3_stmt *hStmt = nullptr;
+                    int rc = sqlite3_prepare_v2(IGetDB(), pszSQL, -1, &hStmt,
+                                                nullptr);
                     if (rc != SQLITE_OK)
                     {
                         eErr = CE_Failure;
@@ -2354,6 +2394,207 @@ CPLErr GDALGPKGMBTilesLikePseudoDataset::WriteTileInternal()
     return eErr;
 }
 
+/************************************************************************/
+/*                            InsertTile()                              */
+/************************************************************************/
+
+// Inserts an encoded tile in the database, and takes ownership of pabyBlob.
+CPLErr GDALGPKGMBTilesLikePseudoDataset::InsertTile(int nRow, int nCol,
+                                                    GByte *pabyBlob,
+                                                    vsi_l_offset nBlobSize)
+{
+    /* Create or commit and recreate transaction */
+    GDALGPKGMBTilesLikePseudoDataset *poMainDS =
+        m_poParentDS ? m_poParentDS : this;
+    if (poMainDS->m_nTileInsertionCount == 0)
+    {
+        poMainDS->IStartTransaction();
+    }
+    else if (poMainDS->m_nTileInsertionCount == 1000)
+    {
+        if (poMainDS->ICommitTransaction() != OGRERR_NONE)
+        {
+            poMainDS->m_nTileInsertionCount = -1;
+            CPLFree(pabyBlob);
+            return CE_Failure;
+        }
+        poMainDS->IStartTransaction();
+        poMainDS->m_nTileInsertionCount = 0;
+    }
+    poMainDS->m_nTileInsertionCount++;
+
+    char *pszSQL = sqlite3_mprintf("INSERT OR REPLACE INTO \"%w\" "
+                                   "(zoom_level, tile_row, tile_column, "
+                                   "tile_data) VALUES (%d, %d, %d, ?)",
+                                   m_osRasterTable.c_str(), m_nZoomLevel,
+                                   GetRowFromIntoTopConvention(nRow), nCol);
+#ifdef DEBUG_VERBOSE
+    CPLDebug("GPKG", "%s", pszSQL);
+#endif
+    CPLErr eErr = CE_Failure;
+    sqlite3_stmt *hStmt = nullptr;
+    int rc = sqlite3_prepare_v2(IGetDB(), pszSQL, -1, &hStmt, nullptr);
+    if (rc != SQLITE_OK)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "failed to prepare SQL %s: %s",
+                 pszSQL, sqlite3_errmsg(IGetDB()));
+        CPLFree(pabyBlob);
+    }
+    else
+    {
+        sqlite3_bind_blob(hStmt, 1, pabyBlob, static_cast<int>(nBlobSize),
+                          CPLFree);
+        rc = sqlite3_step(hStmt);
+        if (rc == SQLITE_DONE)
+            eErr = CE_None;
+        else
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Failure when inserting tile (row=%d,col=%d) at "
+                     "zoom_level=%d : %s",
+                     GetRowFromIntoTopConvention(nRow), nCol, m_nZoomLevel,
+                     sqlite3_errmsg(IGetDB()));
+        }
+    }
+    sqlite3_finalize(hStmt);
+    sqlite3_free(pszSQL);
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                      SubmitTileEncodingJob()                         */
+/************************************************************************/
+
+// Queues the encoding of poTileDS, whose bands may point to the tile
+// cache, and thus copies its content.
+CPLErr GDALGPKGMBTilesLikePseudoDataset::SubmitTileEncodingJob(
+    int nRow, int nCol, GDALDriver *poDriver, GDALDataset *poTileDS,
+    CSLConstList papszDriverOptions)
+{
+    if (!m_poTileEncodingQueue)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(m_nNumThreads);
+        if (poThreadPool)
+            m_poTileEncodingQueue = poThreadPool->CreateJobQueue();
+        if (!m_poTileEncodingQueue)
+            return CE_Failure;
+    }
+
+    // Bound memory usage by inserting the pending tiles as a batch
+    if (static_cast<int>(m_apoTileEncodingJobs.size()) >= 4 * m_nNumThreads)
+    {
+        if (FlushTileEncodingJobs() != CE_None)
+            return CE_Failure;
+    }
+
+    const int nXSize = poTileDS->GetRasterXSize();
+    const int nYSize = poTileDS->GetRasterYSize();
+    const int nTileBands = poTileDS->GetRasterCount();
+    const GDALDataType eDT = poTileDS->GetRasterBand(1)->GetRasterDataType();
+    const size_t nBandSize = static_cast<size_t>(nXSize) * nYSize *
+                             GDALGetDataTypeSizeBytes(eDT);
+
+    auto poJob = std::make_unique<GPKGTileEncodingJob>();
+    poJob->nRow = nRow;
+    poJob->nCol = nCol;
+    poJob->poDriver = poDriver;
+    poJob->aosDriverOptions = CPLStringList(papszDriverOptions);
+    poJob->osMemFileName =
+        CPLSPrintf("/vsimem/gpkg_write_tile_job_%p", poJob.get());
+    try
+    {
+        poJob->abyTileData.resize(nBandSize * nTileBands);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for tile encoding");
+        return CE_Failure;
+    }
+    if (poTileDS->RasterIO(GF_Read, 0, 0, nXSize, nYSize,
+                           poJob->abyTileData.data(), nXSize, nYSize, eDT,
+                           nTileBands, nullptr, 0, 0, 0, nullptr) != CE_None)
+    {
+        return CE_Failure;
+    }
+
+    auto poMEMDS = MEMDataset::Create("", nXSize, nYSize, 0, eDT, nullptr);
+    poJob->poTileDS.reset(poMEMDS);
+    for (int i = 0; i < nTileBands; i++)
+    {
+        auto hBand = MEMCreateRasterBandEx(
+            poMEMDS, i + 1, poJob->abyTileData.data() + i * nBandSize, eDT, 0,
+            0, false);
+        poMEMDS->AddMEMBand(hBand);
+    }
+    if (const auto poCT = poTileDS->GetRasterBand(1)->GetColorTable())
+        poJob->poTileDS->GetRasterBand(1)->SetColorTable(poCT);
+
+    if (!m_poTileEncodingQueue->SubmitJob(TileEncodingJobFunc, poJob.get()))
+        return CE_Failure;
+    m_apoTileEncodingJobs.push_back(std::move(poJob));
+    return CE_None;
+}
+
+/************************************************************************/
+/*                       TileEncodingJobFunc()                          */
+/************************************************************************/
+
+void GDALGPKGMBTilesLikePseudoDataset::TileEncodingJobFunc(void *pData)
+{
+    auto psJob = static_cast<GPKGTileEncodingJob *>(pData);
+
+    // Errors are emitted by FlushTileEncodingJobs() in the main thread
+    CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+    GDALDataset *poOutDS = psJob->poDriver->CreateCopy(
+        psJob->osMemFileName.c_str(), psJob->poTileDS.get(), FALSE,
+        psJob->aosDriverOptions.List(), nullptr, nullptr);
+    psJob->bSuccess = poOutDS != nullptr && GDALClose(poOutDS) == CE_None;
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+/************************************************************************/
+/*                       FlushTileEncodingJobs()                        */
+/************************************************************************/
+
+// Waits for the tiles being encoded by worker threads and inserts them in
+// the database, in the order they were submitted.
+CPLErr GDALGPKGMBTilesLikePseudoDataset::FlushTileEncodingJobs()
+{
+    if (m_apoTileEncodingJobs.empty())
+        return CE_None;
+
+    m_poTileEncodingQueue->WaitCompletion();
+
+    GDALGPKGMBTilesLikePseudoDataset *poMainDS =
+        m_poParentDS ? m_poParentDS : this;
+    CPLErr eErr = CE_None;
+    for (const auto &poJob : m_apoTileEncodingJobs)
+    {
+        for (const auto &oError : poJob->aoErrors)
+        {
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        }
+        if (!poJob->bSuccess || poMainDS->m_nTileInsertionCount < 0)
+        {
+            eErr = CE_Failure;
+            continue;
+        }
+
+        vsi_l_offset nBlobSize = 0;
+        GByte *pabyBlob = VSIGetMemFileBuffer(poJob->osMemFileName.c_str(),
+                                              &nBlobSize, TRUE);
+        if (InsertTile(poJob->nRow, poJob->nCol, pabyBlob, nBlobSize) !=
+            CE_None)
+        {
+            eErr = CE_Failure;
+        }
+    }
+    m_apoTileEncodingJobs.clear();
+    return eErr;
+}
+
 /************************************************************************/
 /*                     FlushRemainingShiftedTiles()                     */
 /************************************************************************/
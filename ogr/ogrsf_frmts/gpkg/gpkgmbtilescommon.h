@@ -34,6 +34,12 @@
 #include "gdal_pam.h"
 #include <sqlite3.h>
 
+#include <deque>
+#include <memory>
+
+class CPLJobQueue;
+struct GPKGTileEncodingJob;
+
 typedef struct
 {
     int nRow;
@@ -110,11 +116,26 @@ class GDALGPKGMBTilesLikePseudoDataset
 
     int m_nTileInsertionCount = 0;
 
+    // Number of threads used to encode tiles (NUM_THREADS option)
+    int m_nNumThreads = 1;
+
     GDALGPKGMBTilesLikePseudoDataset *m_poParentDS = nullptr;
 
+    void SetNumThreads(const char *pszValue);
+
   private:
     bool m_bInWriteTile = false;
     CPLErr WriteTileInternal(); /* should only be called by WriteTile() */
+    CPLErr InsertTile(int nRow, int nCol, GByte *pabyBlob,
+                      vsi_l_offset nBlobSize);
+
+    // Tiles being encoded by worker threads, in submission order
+    std::unique_ptr<CPLJobQueue> m_poTileEncodingQueue{};
+    std::deque<std::unique_ptr<GPKGTileEncodingJob>> m_apoTileEncodingJobs{};
+    CPLErr SubmitTileEncodingJob(int nRow, int nCol, GDALDriver *poDriver,
+                                 GDALDataset *poTileDS,
+                                 CSLConstList papszDriverOptions);
+    static void TileEncodingJobFunc(void *pData);
     GIntBig GetTileId(int nRow, int nCol);
     bool DeleteTile(int nRow, int nCol);
     bool DeleteFromGriddedTileAncillary(GIntBig nTileId);
@@ -139,6 +160,7 @@ class GDALGPKGMBTilesLikePseudoDataset
                     bool *pbIsLossyFormat = nullptr);
 
     CPLErr WriteTile();
+    CPLErr FlushTileEncodingJobs();
 
     CPLErr FlushTiles();
     CPLErr FlushRemainingShiftedTiles(bool bPartialFlush);
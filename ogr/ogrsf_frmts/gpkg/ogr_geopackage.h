@@ -603,6 +603,7 @@ class OGRGeoPackageLayer CPL_NON_FINAL : public OGRLayer,
 /************************************************************************/
 
 struct OGRGPKGTableLayerFillArrowArray;
+struct OGRGPKGTableLayerFeaturePrefetcher;
 struct sqlite_rtree_bl;
 
 class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
@@ -642,6 +643,8 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
     // m_bHasSpatialIndex cannot be bool.  -1 is unset.
     int m_bHasSpatialIndex = -1;
     bool m_bDropRTreeTable = false;
+    // -1: unset, i.e. use the OGR_GPKG_SPATIAL_INDEX_PACKED config option
+    int m_nPackedSpatialIndex = -1;
     bool m_abHasGeometryExtension[wkbTriangle + 1];
     bool m_bPreservePrecision = true;
     bool m_bTruncateFields = false;
@@ -719,6 +722,7 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
 #endif
 
     void CheckGeometryType(OGRFeature *poFeature);
+    void CheckGeometryType(OGRwkbGeometryType eGeomType);
 
     OGRErr ReadTableDefinition();
     void InitView();
@@ -734,6 +738,7 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
                                         const char *pszNewName);
 
     OGRErr CreateOrUpsertFeature(OGRFeature *poFeature, bool bUpsert);
+    bool AddRTreeEntry(GIntBig nFID, const OGREnvelope &oEnv);
 
     GIntBig GetTotalFeatureCount();
 
@@ -773,6 +778,17 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
     void GetNextArrowArrayAsynchronousWorker();
     void CancelAsyncNextArrowArray();
 
+    // Used by GetNextFeature() when OGR_GPKG_PREFETCH_FEATURES=YES
+    std::unique_ptr<OGRGPKGTableLayerFeaturePrefetcher>
+        m_poFeaturePrefetcher{};
+    // Set on the layer used by the worker thread, so that it does not prefetch
+    bool m_bIsFeaturePrefetchingWorker = false;
+
+    bool StartFeaturePrefetching();
+    void FeaturePrefetchingWorker();
+    OGRFeature *GetNextPrefetchedFeature();
+    void StopFeaturePrefetching(bool bResumeReading);
+
   protected:
     friend void OGR_GPKG_Intersects_Spatial_Filter(sqlite3_context *pContext,
                                                    int /*argc*/,
@@ -846,6 +862,10 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
                                              GDALProgressFunc pfnProgress,
                                              void *pProgressData) override;
 
+    bool WriteArrowBatch(const struct ArrowSchema *schema,
+                         struct ArrowArray *array,
+                         CSLConstList papszOptions = nullptr) override;
+
     void RecomputeExtent();
 
     void SetOpeningParameters(const char *pszTableName,
@@ -869,6 +889,10 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
     {
         m_sDateTimeFormat.ePrecision = ePrecision;
     }
+    void SetPackedSpatialIndex(bool bFlag)
+    {
+        m_nPackedSpatialIndex = bFlag;
+    }
 
     void CreateSpatialIndexIfNecessary();
     void FinishOrDisableThreadedRTree();
@@ -2512,6 +2512,7 @@ bool GDALGeoPackageDataset::InitRaster(
         m_nQuality = poParentDS->m_nQuality;
         m_nZLevel = poParentDS->m_nZLevel;
         m_bDither = poParentDS->m_bDither;
+        m_nNumThreads = poParentDS->m_nNumThreads;
         /*m_nSRID = poParentDS->m_nSRID;*/
         m_osWHERE = poParentDS->m_osWHERE;
         SetDescription(CPLSPrintf("%s - zoom_level=%d",
@@ -6393,6 +6394,8 @@ void GDALGeoPackageDataset::ParseCompressionOptions(char **papszOptions)
     const char *pszDither = CSLFetchNameValue(papszOptions, "DITHER");
     if (pszDither)
         m_bDither = CPLTestBool(pszDither);
+
+    SetNumThreads(CSLFetchNameValue(papszOptions, "NUM_THREADS"));
 }
 
 /************************************************************************/
@@ -6628,6 +6631,10 @@ OGRLayer *GDALGeoPackageDataset::ICreateLayer(
     {
         poLayer->SetDeferredSpatialIndexCreation(true);
     }
+    const char *pszSIPacked =
+        CSLFetchNameValue(papszOptions, "SPATIAL_INDEX_PACKED");
+    if (pszSIPacked)
+        poLayer->SetPackedSpatialIndex(CPLTestBool(pszSIPacked));
 
     poLayer->SetPrecisionFlag(CPLFetchBool(papszOptions, "PRECISION", true));
     poLayer->SetTruncateFieldsFlag(
@@ -457,7 +457,10 @@ class GDALGPKGDriver final : public GDALDriver
     "description='DEFLATE compression level for PNG tiles' default='6'/>"      \
     "  <Option name='DITHER' type='boolean' scope='raster' "                   \
     "description='Whether to apply Floyd-Steinberg dithering (for "            \
-    "TILE_FORMAT=PNG8)' default='NO'/>"
+    "TILE_FORMAT=PNG8)' default='NO'/>"                                        \
+    "  <Option name='NUM_THREADS' type='string' scope='raster' "               \
+    "description='Number of worker threads for tile encoding. "                \
+    "Can be set to ALL_CPUS' default='1'/>"
 
 void GDALGPKGDriver::InitializeCreationOptionList()
 {
@@ -585,6 +588,7 @@ void RegisterOGRGeoPackage()
 
     poDriver->SetDescription("GPKG");
     poDriver->SetMetadataItem(GDAL_DCAP_RASTER, "YES");
+    poDriver->SetMetadataItem(GDAL_DCAP_PARALLEL_CLONE_READ, "YES");
     poDriver->SetMetadataItem(GDAL_DCAP_VECTOR, "YES");
     poDriver->SetMetadataItem(GDAL_DCAP_CREATE_LAYER, "YES");
     poDriver->SetMetadataItem(GDAL_DCAP_DELETE_LAYER, "YES");
@@ -669,6 +673,9 @@ void RegisterOGRGeoPackage()
         "to truncate text content that exceeds maximum width' default='NO'/>"
         "  <Option name='SPATIAL_INDEX' type='boolean' description='Whether to "
         "create a spatial index' default='YES'/>"
+        "  <Option name='SPATIAL_INDEX_PACKED' type='boolean' "
+        "description='Whether the spatial index should be built as a packed "
+        "tree, sorted along a Hilbert curve' default='NO'/>"
         "  <Option name='IDENTIFIER' type='string' description='Identifier of "
         "the layer, as put in the contents table'/>"
         "  <Option name='DESCRIPTION' type='string' description='Description "
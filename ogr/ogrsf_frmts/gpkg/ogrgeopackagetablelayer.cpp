@@ -30,12 +30,14 @@
 #include "ogr_geopackage.h"
 #include "ogrgeopackageutility.h"
 #include "ogrsqliteutility.h"
+#include "cpl_error_internal.h"
 #include "cpl_md5.h"
 #include "cpl_time.h"
 #include "ogr_p.h"
 #include "sqlite_rtree_bulk_load/wrapper.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <limits>
@@ -48,6 +50,42 @@
 static const char UNSUPPORTED_OP_READ_ONLY[] =
     "%s : unsupported operation on a read-only datasource.";
 
+/************************************************************************/
+/*                 OGRGPKGTableLayerFeaturePrefetcher                   */
+/************************************************************************/
+
+// State of the worker thread that reads and decodes features ahead of
+// GetNextFeature(), through a layer of its own connection to the database.
+struct OGRGPKGTableLayerFeaturePrefetcher
+{
+    static constexpr size_t BATCH_SIZE = 1000;
+
+    struct PrefetchedFeature
+    {
+        std::unique_ptr<OGRFeature> poFeature{};
+        // Value of m_iNextShapeId after reading the feature
+        GIntBig nNextShapeId = 0;
+    };
+
+    std::unique_ptr<GDALGeoPackageDataset> poDS{};
+    OGRGeoPackageTableLayer *poLayer = nullptr;  // belongs to poDS
+    std::thread oThread{};
+    std::atomic<bool> bStop{false};
+
+    // Members protected by oMutex
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+    bool bBatchReady = false;
+    bool bBatchIsLast = false;
+    std::vector<PrefetchedFeature> aoBatch{};
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoBatchErrors{};
+
+    // Members only accessed by the thread calling GetNextFeature()
+    std::vector<PrefetchedFeature> aoCurBatch{};
+    size_t nCurIdx = 0;
+    bool bCurBatchIsLast = false;
+};
+
 //----------------------------------------------------------------------
 // SaveExtent()
 //
@@ -1477,6 +1515,8 @@ OGRGeoPackageTableLayer::~OGRGeoPackageTableLayer()
         sqlite3_finalize(m_poGetFeatureStatement);
 
     CancelAsyncNextArrowArray();
+
+    StopFeaturePrefetching(/* bResumeReading = */ false);
 }
 
 /************************************************************************/
@@ -2037,33 +2077,35 @@ void OGRGeoPackageTableLayer::DisableFeatureCountTriggers(
 /************************************************************************/
 
 void OGRGeoPackageTableLayer::CheckGeometryType(OGRFeature *poFeature)
+{
+    const OGRGeometry *poGeom = poFeature->GetGeometryRef();
+    if (poGeom != nullptr)
+        CheckGeometryType(poGeom->getGeometryType());
+}
+
+void OGRGeoPackageTableLayer::CheckGeometryType(OGRwkbGeometryType eGeomType)
 {
     OGRwkbGeometryType eLayerGeomType = wkbFlatten(GetGeomType());
     if (eLayerGeomType != wkbNone && eLayerGeomType != wkbUnknown)
     {
-        OGRGeometry *poGeom = poFeature->GetGeometryRef();
-        if (poGeom != nullptr)
+        const OGRwkbGeometryType eFlatGeomType = wkbFlatten(eGeomType);
+        if (!OGR_GT_IsSubClassOf(eFlatGeomType, eLayerGeomType) &&
+            m_eSetBadGeomTypeWarned.find(eFlatGeomType) ==
+                m_eSetBadGeomTypeWarned.end())
         {
-            OGRwkbGeometryType eGeomType =
-                wkbFlatten(poGeom->getGeometryType());
-            if (!OGR_GT_IsSubClassOf(eGeomType, eLayerGeomType) &&
-                m_eSetBadGeomTypeWarned.find(eGeomType) ==
-                    m_eSetBadGeomTypeWarned.end())
-            {
-                CPLError(CE_Warning, CPLE_AppDefined,
-                         "A geometry of type %s is inserted into layer %s "
-                         "of geometry type %s, which is not normally allowed "
-                         "by the GeoPackage specification, but the driver will "
-                         "however do it. "
-                         "To create a conformant GeoPackage, if using ogr2ogr, "
-                         "the -nlt option can be used to override the layer "
-                         "geometry type. "
-                         "This warning will no longer be emitted for this "
-                         "combination of layer and feature geometry type.",
-                         OGRToOGCGeomType(eGeomType), GetName(),
-                         OGRToOGCGeomType(eLayerGeomType));
-                m_eSetBadGeomTypeWarned.insert(eGeomType);
-            }
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "A geometry of type %s is inserted into layer %s "
+                     "of geometry type %s, which is not normally allowed "
+                     "by the GeoPackage specification, but the driver will "
+                     "however do it. "
+                     "To create a conformant GeoPackage, if using ogr2ogr, "
+                     "the -nlt option can be used to override the layer "
+                     "geometry type. "
+                     "This warning will no longer be emitted for this "
+                     "combination of layer and feature geometry type.",
+                     OGRToOGCGeomType(eFlatGeomType), GetName(),
+                     OGRToOGCGeomType(eLayerGeomType));
+            m_eSetBadGeomTypeWarned.insert(eFlatGeomType);
         }
     }
 
@@ -2072,31 +2114,26 @@ void OGRGeoPackageTableLayer::CheckGeometryType(OGRFeature *poFeature)
     // with Z and M components
     if (GetGeomType() == wkbUnknown && (m_nZFlag == 0 || m_nMFlag == 0))
     {
-        OGRGeometry *poGeom = poFeature->GetGeometryRef();
-        if (poGeom != nullptr)
+        bool bUpdateGpkgGeometryColumnsTable = false;
+        if (m_nZFlag == 0 && wkbHasZ(eGeomType))
         {
-            bool bUpdateGpkgGeometryColumnsTable = false;
-            OGRwkbGeometryType eGeomType = poGeom->getGeometryType();
-            if (m_nZFlag == 0 && wkbHasZ(eGeomType))
-            {
-                m_nZFlag = 2;
-                bUpdateGpkgGeometryColumnsTable = true;
-            }
-            if (m_nMFlag == 0 && wkbHasM(eGeomType))
-            {
-                m_nMFlag = 2;
-                bUpdateGpkgGeometryColumnsTable = true;
-            }
-            if (bUpdateGpkgGeometryColumnsTable)
-            {
-                /* Update gpkg_geometry_columns */
-                char *pszSQL = sqlite3_mprintf(
-                    "UPDATE gpkg_geometry_columns SET z = %d, m = %d WHERE "
-                    "table_name = '%q' AND column_name = '%q'",
-                    m_nZFlag, m_nMFlag, GetName(), GetGeometryColumn());
-                CPL_IGNORE_RET_VAL(SQLCommand(m_poDS->GetDB(), pszSQL));
-                sqlite3_free(pszSQL);
-            }
+            m_nZFlag = 2;
+            bUpdateGpkgGeometryColumnsTable = true;
+        }
+        if (m_nMFlag == 0 && wkbHasM(eGeomType))
+        {
+            m_nMFlag = 2;
+            bUpdateGpkgGeometryColumnsTable = true;
+        }
+        if (bUpdateGpkgGeometryColumnsTable)
+        {
+            /* Update gpkg_geometry_columns */
+            char *pszSQL = sqlite3_mprintf(
+                "UPDATE gpkg_geometry_columns SET z = %d, m = %d WHERE "
+                "table_name = '%q' AND column_name = '%q'",
+                m_nZFlag, m_nMFlag, GetName(), GetGeometryColumn());
+            CPL_IGNORE_RET_VAL(SQLCommand(m_poDS->GetDB(), pszSQL));
+            sqlite3_free(pszSQL);
         }
     }
 }
@@ -2180,6 +2217,89 @@ static float rtreeValueUp(double d)
     return f;
 }
 
+/************************************************************************/
+/*                           AddRTreeEntry()                            */
+/************************************************************************/
+
+/** Registers the bounding box of a newly inserted feature for the RTree,
+ * either by accumulating it for a deferred spatial index update, or by
+ * queueing it for the background RTree building thread.
+ * Returns false only in case of error while flushing pending entries.
+ */
+bool OGRGeoPackageTableLayer::AddRTreeEntry(GIntBig nFID,
+                                            const OGREnvelope &oEnv)
+{
+    if (!m_bDeferredSpatialIndexCreation && HasSpatialIndex() &&
+        m_poDS->IsInTransaction())
+    {
+        m_nCountInsertInTransaction++;
+        if (m_nCountInsertInTransactionThreshold < 0)
+        {
+            m_nCountInsertInTransactionThreshold = atoi(CPLGetConfigOption(
+                "OGR_GPKG_DEFERRED_SPI_UPDATE_THRESHOLD", "100"));
+        }
+        if (m_nCountInsertInTransaction == m_nCountInsertInTransactionThreshold)
+        {
+            StartDeferredSpatialIndexUpdate();
+        }
+        else if (!m_aoRTreeTriggersSQL.empty())
+        {
+            if (m_aoRTreeEntries.size() == 1000 * 1000)
+            {
+                if (!FlushPendingSpatialIndexUpdate())
+                    return false;
+            }
+            GPKGRTreeEntry sEntry;
+            sEntry.nId = nFID;
+            sEntry.fMinX = rtreeValueDown(oEnv.MinX);
+            sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
+            sEntry.fMinY = rtreeValueDown(oEnv.MinY);
+            sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
+            m_aoRTreeEntries.push_back(sEntry);
+        }
+    }
+    else if (m_bAllowedRTreeThread && !m_bErrorDuringRTreeThread)
+    {
+        GPKGRTreeEntry sEntry;
+#ifdef DEBUG_VERBOSE
+        if (m_aoRTreeEntries.empty())
+            CPLDebug("GPKG",
+                     "Starting to fill m_aoRTreeEntries at "
+                     "FID " CPL_FRMT_GIB,
+                     nFID);
+#endif
+        sEntry.nId = nFID;
+        sEntry.fMinX = rtreeValueDown(oEnv.MinX);
+        sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
+        sEntry.fMinY = rtreeValueDown(oEnv.MinY);
+        sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
+        try
+        {
+            m_aoRTreeEntries.push_back(sEntry);
+            if (m_aoRTreeEntries.size() == m_nRTreeBatchSize)
+            {
+                m_oQueueRTreeEntries.push(std::move(m_aoRTreeEntries));
+                m_aoRTreeEntries = std::vector<GPKGRTreeEntry>();
+            }
+            if (!m_bThreadRTreeStarted &&
+                m_oQueueRTreeEntries.size() == m_nRTreeBatchesBeforeStart)
+            {
+                StartAsyncRTree();
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLDebug("GPKG", "Memory allocation error regarding RTree "
+                             "structures. Falling back to slower method");
+            if (m_bThreadRTreeStarted)
+                CancelAsyncRTree();
+            else
+                m_bAllowedRTreeThread = false;
+        }
+    }
+    return true;
+}
+
 OGRErr OGRGeoPackageTableLayer::CreateOrUpsertFeature(OGRFeature *poFeature,
                                                       bool bUpsert)
 {
@@ -2442,79 +2562,8 @@ OGRErr OGRGeoPackageTableLayer::CreateOrUpsertFeature(OGRFeature *poFeature,
             poGeom->getEnvelope(&oEnv);
             UpdateExtent(&oEnv);
 
-            if (!bUpsert && !m_bDeferredSpatialIndexCreation &&
-                HasSpatialIndex() && m_poDS->IsInTransaction())
-            {
-                m_nCountInsertInTransaction++;
-                if (m_nCountInsertInTransactionThreshold < 0)
-                {
-                    m_nCountInsertInTransactionThreshold =
-                        atoi(CPLGetConfigOption(
-                            "OGR_GPKG_DEFERRED_SPI_UPDATE_THRESHOLD", "100"));
-                }
-                if (m_nCountInsertInTransaction ==
-                    m_nCountInsertInTransactionThreshold)
-                {
-                    StartDeferredSpatialIndexUpdate();
-                }
-                else if (!m_aoRTreeTriggersSQL.empty())
-                {
-                    if (m_aoRTreeEntries.size() == 1000 * 1000)
-                    {
-                        if (!FlushPendingSpatialIndexUpdate())
-                            return OGRERR_FAILURE;
-                    }
-                    GPKGRTreeEntry sEntry;
-                    sEntry.nId = nFID;
-                    sEntry.fMinX = rtreeValueDown(oEnv.MinX);
-                    sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
-                    sEntry.fMinY = rtreeValueDown(oEnv.MinY);
-                    sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
-                    m_aoRTreeEntries.push_back(sEntry);
-                }
-            }
-            else if (!bUpsert && m_bAllowedRTreeThread &&
-                     !m_bErrorDuringRTreeThread)
-            {
-                GPKGRTreeEntry sEntry;
-#ifdef DEBUG_VERBOSE
-                if (m_aoRTreeEntries.empty())
-                    CPLDebug("GPKG",
-                             "Starting to fill m_aoRTreeEntries at "
-                             "FID " CPL_FRMT_GIB,
-                             nFID);
-#endif
-                sEntry.nId = nFID;
-                sEntry.fMinX = rtreeValueDown(oEnv.MinX);
-                sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
-                sEntry.fMinY = rtreeValueDown(oEnv.MinY);
-                sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
-                try
-                {
-                    m_aoRTreeEntries.push_back(sEntry);
-                    if (m_aoRTreeEntries.size() == m_nRTreeBatchSize)
-                    {
-                        m_oQueueRTreeEntries.push(std::move(m_aoRTreeEntries));
-                        m_aoRTreeEntries = std::vector<GPKGRTreeEntry>();
-                    }
-                    if (!m_bThreadRTreeStarted &&
-                        m_oQueueRTreeEntries.size() ==
-                            m_nRTreeBatchesBeforeStart)
-                    {
-                        StartAsyncRTree();
-                    }
-                }
-                catch (const std::bad_alloc &)
-                {
-                    CPLDebug("GPKG",
-                             "Memory allocation error regarding RTree "
-                             "structures. Falling back to slower method");
-                    if (m_bThreadRTreeStarted)
-                        CancelAsyncRTree();
-                    else
-                        m_bAllowedRTreeThread = false;
-                }
-            }
+            if (!bUpsert && !AddRTreeEntry(nFID, oEnv))
+                return OGRERR_FAILURE;
         }
     }
 
@@ -3312,6 +3361,8 @@ void OGRGeoPackageTableLayer::ResetReading()
     if (m_bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE)
         return;
 
+    StopFeaturePrefetching(/* bResumeReading = */ false);
+
     OGRGeoPackageLayer::ResetReading();
 
     if (m_poInsertStatement)
@@ -3348,6 +3399,7 @@ OGRErr OGRGeoPackageTableLayer::SetNextByIndex(GIntBig nIndex)
 {
     if (nIndex < 0)
         return OGRERR_FAILURE;
+    StopFeaturePrefetching(/* bResumeReading = */ false);
     if (m_soColumns.empty())
         BuildColumns();
     return ResetStatementInternal(nIndex);
@@ -3465,6 +3517,14 @@ OGRFeature *OGRGeoPackageTableLayer::GetNextFeature()
             return nullptr;
     }
 
+    if (m_poFeaturePrefetcher == nullptr && m_poQueryStatement == nullptr &&
+        !m_bEOF && m_iNextShapeId == 0)
+    {
+        StartFeaturePrefetching();
+    }
+    if (m_poFeaturePrefetcher)
+        return GetNextPrefetchedFeature();
+
     OGRFeature *poFeature = OGRGeoPackageLayer::GetNextFeature();
     if (poFeature && m_iFIDAsRegularColumnIndex >= 0)
     {
@@ -3473,6 +3533,244 @@ OGRFeature *OGRGeoPackageTableLayer::GetNextFeature()
     return poFeature;
 }
 
+/************************************************************************/
+/*                      StartFeaturePrefetching()                       */
+/************************************************************************/
+
+// When OGR_GPKG_PREFETCH_FEATURES=YES and the dataset is opened in read-only
+// mode, a sequential read started by GetNextFeature() is delegated to a
+// worker thread. It opens its own connection to the database, and steps the
+// SELECT statement and builds OGRFeature objects (including the decoding of
+// geometries and the evaluation of filters) for the next batch of features,
+// while the caller consumes the current one.
+bool OGRGeoPackageTableLayer::StartFeaturePrefetching()
+{
+    if (!CPLTestBool(CPLGetConfigOption("OGR_GPKG_PREFETCH_FEATURES", "NO")) ||
+        m_bIsFeaturePrefetchingWorker || m_poDS->GetAccess() != GA_ReadOnly ||
+        sqlite3_threadsafe() == 0)
+    {
+        return false;
+    }
+
+    auto poPrefetcher = std::make_unique<OGRGPKGTableLayerFeaturePrefetcher>();
+    GDALOpenInfo oOpenInfo(m_poDS->GetDescription(), GA_ReadOnly);
+    oOpenInfo.papszOpenOptions = m_poDS->GetOpenOptions();
+    oOpenInfo.nOpenFlags = GDAL_OF_VECTOR;
+    poPrefetcher->poDS = std::make_unique<GDALGeoPackageDataset>();
+    if (!poPrefetcher->poDS->Open(&oOpenInfo, m_poDS->m_osFilenameInZip))
+    {
+        CPLDebug("GPKG", "Cannot open %s for feature prefetching",
+                 m_poDS->GetDescription());
+        return false;
+    }
+    auto poOtherLayer = dynamic_cast<OGRGeoPackageTableLayer *>(
+        poPrefetcher->poDS->GetLayerByName(GetName()));
+    if (poOtherLayer == nullptr)
+        return false;
+
+    // Check that the other layer has the same schema, so that its features
+    // can be re-attached to our layer definition.
+    const auto poOtherFDefn = poOtherLayer->GetLayerDefn();
+    if (poOtherFDefn->GetFieldCount() != m_poFeatureDefn->GetFieldCount() ||
+        poOtherFDefn->GetGeomFieldCount() !=
+            m_poFeatureDefn->GetGeomFieldCount())
+    {
+        return false;
+    }
+    for (int i = 0; i < m_poFeatureDefn->GetFieldCount(); ++i)
+    {
+        const auto poFieldDefn = m_poFeatureDefn->GetFieldDefn(i);
+        const auto poOtherFieldDefn = poOtherFDefn->GetFieldDefn(i);
+        if (poFieldDefn->GetType() != poOtherFieldDefn->GetType() ||
+            poFieldDefn->GetSubType() != poOtherFieldDefn->GetSubType() ||
+            strcmp(poFieldDefn->GetNameRef(),
+                   poOtherFieldDefn->GetNameRef()) != 0)
+        {
+            return false;
+        }
+        poOtherFieldDefn->SetIgnored(poFieldDefn->IsIgnored());
+    }
+    for (int i = 0; i < m_poFeatureDefn->GetGeomFieldCount(); ++i)
+    {
+        poOtherFDefn->GetGeomFieldDefn(i)->SetIgnored(
+            m_poFeatureDefn->GetGeomFieldDefn(i)->IsIgnored());
+    }
+    // Rebuild the list of columns to take into account ignored fields
+    poOtherLayer->ResetReading();
+
+    if (m_pszAttrQueryString &&
+        poOtherLayer->SetAttributeFilter(m_pszAttrQueryString) != OGRERR_NONE)
+    {
+        return false;
+    }
+    if (m_poFilterGeom)
+        poOtherLayer->SetSpatialFilter(m_iGeomFieldFilter, m_poFilterGeom);
+
+    // Install query logging callback
+    if (m_poDS->pfnQueryLoggerFunc)
+    {
+        poPrefetcher->poDS->SetQueryLoggerFunc(m_poDS->pfnQueryLoggerFunc,
+                                               m_poDS->poQueryLoggerArg);
+    }
+
+    poOtherLayer->m_bIsFeaturePrefetchingWorker = true;
+    poPrefetcher->poLayer = poOtherLayer;
+    m_poFeaturePrefetcher = std::move(poPrefetcher);
+    try
+    {
+        m_poFeaturePrefetcher->oThread =
+            std::thread([this]() { FeaturePrefetchingWorker(); });
+    }
+    catch (const std::exception &e)
+    {
+        m_poFeaturePrefetcher.reset();
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot start worker thread: %s",
+                 e.what());
+        return false;
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                     FeaturePrefetchingWorker()                       */
+/************************************************************************/
+
+void OGRGeoPackageTableLayer::FeaturePrefetchingWorker()
+{
+    auto poPrefetcher = m_poFeaturePrefetcher.get();
+    auto poOtherLayer = poPrefetcher->poLayer;
+    const int nGeomFieldCount = m_poFeatureDefn->GetGeomFieldCount();
+    bool bIsLast = false;
+    while (!bIsLast)
+    {
+        std::vector<OGRGPKGTableLayerFeaturePrefetcher::PrefetchedFeature>
+            aoBatch;
+        aoBatch.reserve(OGRGPKGTableLayerFeaturePrefetcher::BATCH_SIZE);
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+
+        // Errors are emitted in the caller thread when the batch is consumed
+        CPLInstallErrorHandlerAccumulator(aoErrors);
+        while (aoBatch.size() < OGRGPKGTableLayerFeaturePrefetcher::BATCH_SIZE)
+        {
+            if (poPrefetcher->bStop)
+                break;
+            OGRFeature *poFeature = poOtherLayer->GetNextFeature();
+            if (poFeature == nullptr)
+            {
+                bIsLast = true;
+                break;
+            }
+            poFeature->SetFDefnUnsafe(m_poFeatureDefn);
+            for (int i = 0; i < nGeomFieldCount; ++i)
+            {
+                OGRGeometry *poGeom = poFeature->GetGeomFieldRef(i);
+                if (poGeom)
+                {
+                    poGeom->assignSpatialReference(
+                        m_poFeatureDefn->GetGeomFieldDefn(i)->GetSpatialRef());
+                }
+            }
+            OGRGPKGTableLayerFeaturePrefetcher::PrefetchedFeature oEntry;
+            oEntry.poFeature.reset(poFeature);
+            oEntry.nNextShapeId = poOtherLayer->m_iNextShapeId;
+            aoBatch.push_back(std::move(oEntry));
+        }
+        CPLUninstallErrorHandlerAccumulator();
+
+        std::unique_lock<std::mutex> oLock(poPrefetcher->oMutex);
+        while (poPrefetcher->bBatchReady && !poPrefetcher->bStop)
+        {
+            poPrefetcher->oCV.wait(oLock);
+        }
+        if (poPrefetcher->bStop)
+            break;
+        poPrefetcher->aoBatch = std::move(aoBatch);
+        poPrefetcher->aoBatchErrors = std::move(aoErrors);
+        poPrefetcher->bBatchIsLast = bIsLast;
+        poPrefetcher->bBatchReady = true;
+        poPrefetcher->oCV.notify_one();
+    }
+}
+
+/************************************************************************/
+/*                     GetNextPrefetchedFeature()                       */
+/************************************************************************/
+
+OGRFeature *OGRGeoPackageTableLayer::GetNextPrefetchedFeature()
+{
+    auto poPrefetcher = m_poFeaturePrefetcher.get();
+    if (poPrefetcher->nCurIdx == poPrefetcher->aoCurBatch.size())
+    {
+        if (poPrefetcher->bCurBatchIsLast)
+        {
+            StopFeaturePrefetching(/* bResumeReading = */ false);
+            m_bEOF = true;
+            return nullptr;
+        }
+
+        // Wait for the worker thread to have a new batch ready, and let
+        // it start the next one.
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+        {
+            std::unique_lock<std::mutex> oLock(poPrefetcher->oMutex);
+            while (!poPrefetcher->bBatchReady)
+            {
+                poPrefetcher->oCV.wait(oLock);
+            }
+            poPrefetcher->aoCurBatch = std::move(poPrefetcher->aoBatch);
+            poPrefetcher->aoBatch.clear();
+            aoErrors = std::move(poPrefetcher->aoBatchErrors);
+            poPrefetcher->aoBatchErrors.clear();
+            poPrefetcher->bCurBatchIsLast = poPrefetcher->bBatchIsLast;
+            poPrefetcher->nCurIdx = 0;
+            poPrefetcher->bBatchReady = false;
+            poPrefetcher->oCV.notify_one();
+        }
+        for (const auto &oError : aoErrors)
+        {
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        }
+
+        if (poPrefetcher->aoCurBatch.empty())
+        {
+            StopFeaturePrefetching(/* bResumeReading = */ false);
+            m_bEOF = true;
+            return nullptr;
+        }
+    }
+
+    auto &oEntry = poPrefetcher->aoCurBatch[poPrefetcher->nCurIdx++];
+    m_nFeaturesRead += oEntry.nNextShapeId - m_iNextShapeId;
+    m_iNextShapeId = oEntry.nNextShapeId;
+    return oEntry.poFeature.release();
+}
+
+/************************************************************************/
+/*                      StopFeaturePrefetching()                        */
+/************************************************************************/
+
+// If bResumeReading is true, the SELECT statement of this layer is set up so
+// that a subsequent GetNextFeature() continues after the last feature that
+// has been returned.
+void OGRGeoPackageTableLayer::StopFeaturePrefetching(bool bResumeReading)
+{
+    if (!m_poFeaturePrefetcher)
+        return;
+
+    {
+        std::lock_guard<std::mutex> oLock(m_poFeaturePrefetcher->oMutex);
+        m_poFeaturePrefetcher->bStop = true;
+        m_poFeaturePrefetcher->oCV.notify_one();
+    }
+    if (m_poFeaturePrefetcher->oThread.joinable())
+        m_poFeaturePrefetcher->oThread.join();
+    m_poFeaturePrefetcher.reset();
+
+    if (bResumeReading && !m_bEOF)
+        ResetStatementInternal(m_iNextShapeId);
+}
+
 /************************************************************************/
 /*                        GetFeature()                                  */
 /************************************************************************/
@@ -4262,6 +4560,8 @@ int OGRGeoPackageTableLayer::TestCapability(const char *pszCap)
         return TRUE;
     if (EQUAL(pszCap, OLCFastGetExtent3D))
         return TRUE;
+    else if (EQUAL(pszCap, OLCFastWriteArrowBatch))
+        return m_poDS->GetUpdate();
     else
     {
         return OGRGeoPackageLayer::TestCapability(pszCap);
@@ -4336,6 +4636,16 @@ bool OGRGeoPackageTableLayer::CreateSpatialIndex(const char *pszTableName)
     m_osRTreeName += pszC;
     m_osFIDForRTree = m_pszFidColumn;
 
+    // A packed RTree is built from the in-memory RTree, sorted along a
+    // Hilbert curve, which results in faster spatial queries. This is not
+    // possible when the in-memory RTree had to be flushed to a temporary
+    // database because of the RAM usage limit.
+    const bool bPackedRTree =
+        m_nPackedSpatialIndex >= 0
+            ? m_nPackedSpatialIndex != 0
+            : CPLTestBool(
+                  CPLGetConfigOption("OGR_GPKG_SPATIAL_INDEX_PACKED", "NO"));
+
     bool bPopulateFromThreadRTree = false;
     if (m_bThreadRTreeStarted)
     {
@@ -4369,6 +4679,10 @@ bool OGRGeoPackageTableLayer::CreateSpatialIndex(const char *pszTableName)
 
     if (m_hRTree)
     {
+        if (bPackedRTree && !gdal_sqlite_rtree_bl_pack(m_hRTree))
+        {
+            CPLDebug("GPKG", "Not enough memory to pack the RTree");
+        }
         if (!FlushInMemoryRTree(m_poDS->GetDB(), m_osRTreeName.c_str()))
         {
             m_poDS->SoftRollbackTransaction();
@@ -4377,6 +4691,13 @@ bool OGRGeoPackageTableLayer::CreateSpatialIndex(const char *pszTableName)
     }
     else if (bPopulateFromThreadRTree)
     {
+        if (bPackedRTree)
+        {
+            CPLDebug("GPKG", "RTree of %s could not be packed, as it was too "
+                             "large to fit in RAM",
+                     pszT);
+        }
+
         /* Create virtual table */
         char *pszSQL = sqlite3_mprintf("CREATE VIRTUAL TABLE \"%w\" USING "
                                        "rtree(id, minx, maxx, miny, maxy)",
@@ -4423,10 +4744,13 @@ bool OGRGeoPackageTableLayer::CreateSpatialIndex(const char *pszTableName)
             }
         };
 
-        if (!gdal_sqlite_rtree_bl_from_feature_table(
-                m_poDS->GetDB(), pszT, pszI, pszC, m_osRTreeName.c_str(), "id",
-                "minx", "miny", "maxx", "maxy", nMaxRAMUsageAllowed, &pszErrMsg,
-                ProgressCbk::progressCbk, nullptr))
+        const auto pfnFromFeatureTable =
+            bPackedRTree ? gdal_sqlite_rtree_bl_from_feature_table_packed
+                         : gdal_sqlite_rtree_bl_from_feature_table;
+        if (!pfnFromFeatureTable(m_poDS->GetDB(), pszT, pszI, pszC,
+                                 m_osRTreeName.c_str(), "id", "minx", "miny",
+                                 "maxx", "maxy", nMaxRAMUsageAllowed,
+                                 &pszErrMsg, ProgressCbk::progressCbk, nullptr))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
                      "gdal_sqlite_rtree_bl_from_feature_table() failed "
@@ -8252,6 +8576,7 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
 {
     if (!m_bFeatureDefnCompleted)
         GetLayerDefn();
+    StopFeaturePrefetching(/* bResumeReading = */ true);
     if (m_bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE)
     {
         memset(out_array, 0, sizeof(*out_array));
@@ -8821,3 +9146,753 @@ OGRErr OGRGeoPackageTableLayer::GetExtent3D(int iGeomField,
 
     return OGRERR_NONE;
 }
+
+/************************************************************************/
+/*                    OGRGPKGSimpleWKBEnvelopeReader                    */
+/************************************************************************/
+
+namespace
+{
+/** Computes the 2D envelope of a non-empty Point, LineString, Polygon,
+ * MultiPoint, MultiLineString or MultiPolygon WKB geometry, without Z/M,
+ * whose parts are all in the native byte order, and that has no trailing
+ * bytes. Such a WKB geometry can be directly appended to a GeoPackage
+ * geometry header without going through OGRGeometry.
+ */
+class OGRGPKGSimpleWKBEnvelopeReader
+{
+    const GByte *m_pabyCur;
+    const GByte *const m_pabyEnd;
+    OGREnvelope &m_sEnvelope;
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRGPKGSimpleWKBEnvelopeReader)
+
+    bool ReadUInt32(uint32_t &nVal)
+    {
+        if (m_pabyEnd - m_pabyCur < 4)
+            return false;
+        memcpy(&nVal, m_pabyCur, sizeof(nVal));
+        m_pabyCur += sizeof(nVal);
+        return true;
+    }
+
+    bool ReadHeader(uint32_t &nType)
+    {
+        if (m_pabyEnd - m_pabyCur < 5 ||
+            m_pabyCur[0] != static_cast<GByte>(CPL_IS_LSB))
+            return false;
+        ++m_pabyCur;
+        return ReadUInt32(nType);
+    }
+
+    bool ReadPoints(uint32_t nPoints)
+    {
+        if (nPoints == 0 ||
+            nPoints > static_cast<size_t>(m_pabyEnd - m_pabyCur) /
+                          (2 * sizeof(double)))
+            return false;
+        for (uint32_t i = 0; i < nPoints; ++i)
+        {
+            double dfX, dfY;
+            memcpy(&dfX, m_pabyCur, sizeof(double));
+            memcpy(&dfY, m_pabyCur + sizeof(double), sizeof(double));
+            m_pabyCur += 2 * sizeof(double);
+            if (std::isnan(dfX) || std::isnan(dfY))
+                return false;
+            m_sEnvelope.MinX = std::min(m_sEnvelope.MinX, dfX);
+            m_sEnvelope.MinY = std::min(m_sEnvelope.MinY, dfY);
+            m_sEnvelope.MaxX = std::max(m_sEnvelope.MaxX, dfX);
+            m_sEnvelope.MaxY = std::max(m_sEnvelope.MaxY, dfY);
+        }
+        return true;
+    }
+
+    bool ReadLineString()
+    {
+        uint32_t nPoints = 0;
+        return ReadUInt32(nPoints) && ReadPoints(nPoints);
+    }
+
+    bool ReadPolygon()
+    {
+        uint32_t nRings = 0;
+        if (!ReadUInt32(nRings) || nRings == 0)
+            return false;
+        for (uint32_t i = 0; i < nRings; ++i)
+        {
+            if (!ReadLineString())
+                return false;
+        }
+        return true;
+    }
+
+    bool ReadSingle(uint32_t nType)
+    {
+        switch (nType)
+        {
+            case wkbPoint:
+                return ReadPoints(1);
+            case wkbLineString:
+                return ReadLineString();
+            case wkbPolygon:
+                return ReadPolygon();
+            default:
+                break;
+        }
+        return false;
+    }
+
+  public:
+    OGRGPKGSimpleWKBEnvelopeReader(const GByte *pabyWkb, size_t nWkbSize,
+                                   OGREnvelope &sEnvelope)
+        : m_pabyCur(pabyWkb), m_pabyEnd(pabyWkb + nWkbSize),
+          m_sEnvelope(sEnvelope)
+    {
+    }
+
+    bool Read(OGRwkbGeometryType &eGeomType)
+    {
+        m_sEnvelope = OGREnvelope();
+        uint32_t nType = 0;
+        if (!ReadHeader(nType))
+            return false;
+        if (nType >= wkbMultiPoint && nType <= wkbMultiPolygon)
+        {
+            const uint32_t nPartType = nType - (wkbMultiPoint - wkbPoint);
+            uint32_t nParts = 0;
+            if (!ReadUInt32(nParts) || nParts == 0)
+                return false;
+            for (uint32_t i = 0; i < nParts; ++i)
+            {
+                uint32_t nSubType = 0;
+                if (!ReadHeader(nSubType) || nSubType != nPartType ||
+                    !ReadSingle(nSubType))
+                {
+                    return false;
+                }
+            }
+        }
+        else if (!ReadSingle(nType))
+        {
+            return false;
+        }
+        eGeomType = static_cast<OGRwkbGeometryType>(nType);
+        return m_pabyCur == m_pabyEnd;
+    }
+};
+
+/************************************************************************/
+/*                        OGRGPKGArrowColumn                            */
+/************************************************************************/
+
+/** Describes how a child of the Arrow struct array maps to the table. */
+struct OGRGPKGArrowColumn
+{
+    const struct ArrowSchema *schema = nullptr;
+    const struct ArrowArray *array = nullptr;
+    // Index of the OGR field, or one of the below special values
+    int iField = -1;
+    OGRFieldType eType = OFTString;
+
+    static constexpr int FID = -1;
+    static constexpr int GEOMETRY = -2;
+
+    bool IsNull(size_t iRow) const
+    {
+        if (array->null_count == 0)
+            return false;
+        const auto pabyValidity = static_cast<const GByte *>(array->buffers[0]);
+        const size_t iBit = iRow + static_cast<size_t>(array->offset);
+        return pabyValidity &&
+               (pabyValidity[iBit / 8] & (1 << (iBit % 8))) == 0;
+    }
+
+    template <class T> T GetValue(size_t iRow) const
+    {
+        return static_cast<const T *>(
+            array->buffers[1])[iRow + static_cast<size_t>(array->offset)];
+    }
+
+    const GByte *GetBinary(size_t iRow, size_t &nLen) const
+    {
+        const size_t iIdx = iRow + static_cast<size_t>(array->offset);
+        size_t nStart, nEnd;
+        // 'z'/'u' use 32-bit offsets, 'Z'/'U' 64-bit ones
+        if (schema->format[0] == 'z' || schema->format[0] == 'u')
+        {
+            const auto panOffsets =
+                static_cast<const uint32_t *>(array->buffers[1]);
+            nStart = panOffsets[iIdx];
+            nEnd = panOffsets[iIdx + 1];
+        }
+        else
+        {
+            const auto panOffsets =
+                static_cast<const uint64_t *>(array->buffers[1]);
+            nStart = static_cast<size_t>(panOffsets[iIdx]);
+            nEnd = static_cast<size_t>(panOffsets[iIdx + 1]);
+        }
+        nLen = nEnd - nStart;
+        return static_cast<const GByte *>(array->buffers[2]) + nStart;
+    }
+};
+
+/************************************************************************/
+/*                      GetOGRFieldTypeForArrowFormat()                 */
+/************************************************************************/
+
+/** Returns the OGR field type into which values of the specified Arrow
+ * format are directly bound by OGRGeoPackageTableLayer::WriteArrowBatch(),
+ * or OFTMaxType if such values must go through the generic implementation.
+ */
+static OGRFieldType GetOGRFieldTypeForArrowFormat(const char *format)
+{
+    if (format[0] != 0 && format[1] == 0)
+    {
+        switch (format[0])
+        {
+            case 'b':
+            case 'c':
+            case 'C':
+            case 's':
+            case 'S':
+            case 'i':
+                return OFTInteger;
+            case 'I':
+            case 'l':
+                return OFTInteger64;
+            case 'f':
+            case 'g':
+                return OFTReal;
+            case 'u':
+            case 'U':
+                return OFTString;
+            case 'z':
+            case 'Z':
+                return OFTBinary;
+            default:
+                break;
+        }
+    }
+    else if (strcmp(format, "tdD") == 0)
+    {
+        return OFTDate;
+    }
+    return OFTMaxType;
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                          WriteArrowBatch()                           */
+/************************************************************************/
+
+/** Specialized implementation of OGRLayer::WriteArrowBatch() that binds
+ * values of the Arrow arrays directly into a prepared INSERT statement,
+ * without going through OGRFeature.
+ *
+ * Simple 2D WKB geometries are converted to GeoPackage geometry blobs by
+ * just prepending the GeoPackage header, and their bounding box is fed into
+ * the same RTree update mechanisms as CreateFeature() (deferred spatial index
+ * update, or background RTree bulk loading).
+ *
+ * Schemas that cannot be handled here (nested structures, dictionaries,
+ * lists, date-times, fields with a width, a default value or that are
+ * generated, FID exposed as a regular column, etc.) are delegated to the
+ * generic implementation.
+ */
+bool OGRGeoPackageTableLayer::WriteArrowBatch(const struct ArrowSchema *schema,
+                                              struct ArrowArray *array,
+                                              CSLConstList papszOptions)
+{
+    if (!m_bFeatureDefnCompleted)
+        GetLayerDefn();
+
+    const auto Fallback = [this, schema, array, papszOptions]()
+    { return OGRLayer::WriteArrowBatch(schema, array, papszOptions); };
+
+    if (CPLTestBool(
+            CPLGetConfigOption("OGR_GPKG_WRITE_ARROW_BATCH_BASE_IMPL", "NO")) ||
+        !m_poDS->GetUpdate() || m_iFIDAsRegularColumnIndex >= 0 ||
+        strcmp(schema->format, "+s") != 0 ||
+        schema->n_children != array->n_children)
+    {
+        return Fallback();
+    }
+
+    const char *pszFIDName =
+        CSLFetchNameValueDef(papszOptions, "FID", GetFIDColumn());
+    if (!pszFIDName || pszFIDName[0] == 0)
+        pszFIDName = DEFAULT_ARROW_FID_NAME;
+    const char *pszGeomFieldName = CSLFetchNameValueDef(
+        papszOptions, "GEOMETRY_NAME", GetGeometryColumn());
+    if (!pszGeomFieldName || pszGeomFieldName[0] == 0)
+        pszGeomFieldName = DEFAULT_ARROW_GEOMETRY_NAME;
+
+    // Map Arrow children to table columns
+    std::vector<OGRGPKGArrowColumn> asColumns;
+    std::vector<bool> abFieldMapped(m_poFeatureDefn->GetFieldCount(), false);
+    int iFIDColumn = -1;
+    bool bHasGeomColumn = false;
+    for (int64_t i = 0; i < schema->n_children; ++i)
+    {
+        const auto psChildSchema = schema->children[i];
+        if (psChildSchema->dictionary || array->children[i]->dictionary)
+            return Fallback();
+        OGRGPKGArrowColumn sColumn;
+        sColumn.schema = psChildSchema;
+        sColumn.array = array->children[i];
+        const char *format = psChildSchema->format;
+        const int iField = m_poFeatureDefn->GetFieldIndex(psChildSchema->name);
+        if (strcmp(psChildSchema->name, pszFIDName) == 0)
+        {
+            if (iFIDColumn >= 0 ||
+                (strcmp(format, "i") != 0 && strcmp(format, "l") != 0))
+                return Fallback();
+            sColumn.iField = OGRGPKGArrowColumn::FID;
+            iFIDColumn = static_cast<int>(asColumns.size());
+        }
+        else if (iField >= 0)
+        {
+            const auto poFieldDefn = m_poFeatureDefn->GetFieldDefn(iField);
+            sColumn.eType = GetOGRFieldTypeForArrowFormat(format);
+            if (abFieldMapped[iField] || m_abGeneratedColumns[iField] ||
+                sColumn.eType != poFieldDefn->GetType() ||
+                (sColumn.eType == OFTString && poFieldDefn->GetWidth() > 0))
+            {
+                // Also covers Arrow integer types that are not the nominal
+                // ones of the OGR field type, and need conversions.
+                return Fallback();
+            }
+            abFieldMapped[iField] = true;
+            sColumn.iField = iField;
+        }
+        else if (m_poFeatureDefn->GetGeomFieldCount() == 1 &&
+                 (EQUAL(psChildSchema->name, GetGeometryColumn()) ||
+                  strcmp(psChildSchema->name, pszGeomFieldName) == 0))
+        {
+            if (bHasGeomColumn ||
+                (strcmp(format, "z") != 0 && strcmp(format, "Z") != 0))
+                return Fallback();
+            sColumn.iField = OGRGPKGArrowColumn::GEOMETRY;
+            bHasGeomColumn = true;
+        }
+        else
+        {
+            // Unknown column, struct, geometry identified through its
+            // ARROW:extension:name, or renamed field: let the generic
+            // implementation deal with it (or error out)
+            return Fallback();
+        }
+        asColumns.push_back(sColumn);
+    }
+    const OGRGPKGArrowColumn *psFIDColumn =
+        iFIDColumn >= 0 ? &asColumns[iFIDColumn] : nullptr;
+
+    // Unset fields with a default value must get it, which requires
+    // OGRFeature::FillUnsetWithDefault() logic.
+    for (int iField = 0; iField < m_poFeatureDefn->GetFieldCount(); ++iField)
+    {
+        if (!abFieldMapped[iField] &&
+            m_poFeatureDefn->GetFieldDefn(iField)->GetDefault() != nullptr)
+        {
+            return Fallback();
+        }
+    }
+
+    if (m_bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE)
+        return false;
+
+    CancelAsyncNextArrowArray();
+
+#ifdef ENABLE_GPKG_OGR_CONTENTS
+    // To maximize performance of insertion, disable feature count triggers
+    if (m_bOGRFeatureCountTriggersEnabled)
+    {
+        DisableFeatureCountTriggers();
+    }
+#endif
+
+    // Build the INSERT statement
+    std::string osSQL;
+    if (asColumns.empty())
+    {
+        osSQL = CPLSPrintf("INSERT INTO \"%s\" DEFAULT VALUES",
+                           SQLEscapeName(m_pszTableName).c_str());
+    }
+    else
+    {
+        std::string osValues;
+        osSQL = CPLSPrintf("INSERT INTO \"%s\" (",
+                           SQLEscapeName(m_pszTableName).c_str());
+        for (const auto &sColumn : asColumns)
+        {
+            if (!osValues.empty())
+            {
+                osSQL += ", ";
+                osValues += ", ";
+            }
+            const char *pszColName =
+                sColumn.iField == OGRGPKGArrowColumn::FID ? GetFIDColumn()
+                : sColumn.iField == OGRGPKGArrowColumn::GEOMETRY
+                    ? GetGeometryColumn()
+                    : m_poFeatureDefn->GetFieldDefn(sColumn.iField)
+                          ->GetNameRef();
+            osSQL += '"';
+            osSQL += SQLEscapeName(pszColName);
+            osSQL += '"';
+            osValues += '?';
+        }
+        osSQL += ") VALUES (";
+        osSQL += osValues;
+        osSQL += ')';
+    }
+
+    sqlite3 *hDB = m_poDS->GetDB();
+    sqlite3_stmt *hInsertStmt = nullptr;
+    if (sqlite3_prepare_v2(hDB, osSQL.c_str(), -1, &hInsertStmt, nullptr) !=
+        SQLITE_OK)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "failed to prepare SQL: %s - %s",
+                 osSQL.c_str(), sqlite3_errmsg(hDB));
+        return false;
+    }
+
+    bool bTransactionOK;
+    {
+        CPLErrorHandlerPusher oHandler(CPLQuietErrorHandler);
+        CPLErrorStateBackuper oBackuper;
+        bTransactionOK = StartTransaction() == OGRERR_NONE;
+    }
+
+    const auto Error = [this, hInsertStmt, bTransactionOK]()
+    {
+        sqlite3_finalize(hInsertStmt);
+        if (bTransactionOK)
+            RollbackTransaction();
+        return false;
+    };
+
+    const int nSrsId = m_iSrs;
+    std::vector<GByte> abyGeomBlob;
+    char szDate[16];
+    int64_t nFIDNullCount = 0;
+    const size_t nLength = static_cast<size_t>(array->length);
+    for (size_t iRow = 0; iRow < nLength; ++iRow)
+    {
+        bool bHasEnvelope = false;
+        OGREnvelope sEnvelope;
+        std::unique_ptr<OGRGeometry> poGeom;
+
+        int iBind = 1;
+        int err = SQLITE_OK;
+        for (const auto &sColumn : asColumns)
+        {
+            if (err != SQLITE_OK)
+                break;
+            if (sColumn.IsNull(iRow))
+            {
+                err = sqlite3_bind_null(hInsertStmt, iBind++);
+                continue;
+            }
+
+            if (sColumn.iField == OGRGPKGArrowColumn::FID)
+            {
+                err = sqlite3_bind_int64(
+                    hInsertStmt, iBind++,
+                    sColumn.schema->format[0] == 'i'
+                        ? sColumn.GetValue<int32_t>(iRow)
+                        : sColumn.GetValue<int64_t>(iRow));
+                continue;
+            }
+
+            if (sColumn.iField == OGRGPKGArrowColumn::GEOMETRY)
+            {
+                size_t nWkbLen = 0;
+                const GByte *pabyWkb = sColumn.GetBinary(iRow, nWkbLen);
+                OGRwkbGeometryType eGeomType = wkbUnknown;
+                constexpr size_t MAX_HEADER_SIZE = 8 + 4 * sizeof(double);
+                if (nWkbLen < static_cast<size_t>(INT_MAX) - MAX_HEADER_SIZE &&
+                    OGRGPKGSimpleWKBEnvelopeReader(pabyWkb, nWkbLen, sEnvelope)
+                        .Read(eGeomType))
+                {
+                    // Fast path: the GeoPackage blob is a header followed by
+                    // the input WKB. No envelope is written for points.
+                    const bool bPoint = eGeomType == wkbPoint;
+                    const size_t nHeaderLen =
+                        bPoint ? 8 : 8 + 4 * sizeof(double);
+                    abyGeomBlob.resize(nHeaderLen + nWkbLen);
+                    GByte *pabyBlob = abyGeomBlob.data();
+                    pabyBlob[0] = 0x47;  // 'G'
+                    pabyBlob[1] = 0x50;  // 'P'
+                    pabyBlob[2] = 0;     // version
+                    pabyBlob[3] = static_cast<GByte>(
+                        ((bPoint ? 0 : 1) << 1) | CPL_IS_LSB);
+                    memcpy(pabyBlob + 4, &nSrsId, 4);
+                    if (!bPoint)
+                    {
+                        const double adfEnv[] = {
+                            sEnvelope.MinX, sEnvelope.MaxX, sEnvelope.MinY,
+                            sEnvelope.MaxY};
+                        memcpy(pabyBlob + 8, adfEnv, sizeof(adfEnv));
+                    }
+                    memcpy(pabyBlob + nHeaderLen, pabyWkb, nWkbLen);
+                    CheckGeometryType(eGeomType);
+                    bHasEnvelope = true;
+                    err = sqlite3_bind_blob(
+                        hInsertStmt, iBind++, pabyBlob,
+                        static_cast<int>(abyGeomBlob.size()), SQLITE_STATIC);
+                    continue;
+                }
+
+                // Slow path: curves, Z/M, empty geometries, foreign byte
+                // order, etc.
+                OGRGeometry *poGeomRaw = nullptr;
+                size_t nBytesConsumed = 0;
+                OGRGeometryFactory::createFromWkb(pabyWkb, nullptr, &poGeomRaw,
+                                                  nWkbLen, wkbVariantIso,
+                                                  nBytesConsumed);
+                poGeom.reset(poGeomRaw);
+                if (!poGeom)
+                {
+                    err = sqlite3_bind_null(hInsertStmt, iBind++);
+                    continue;
+                }
+                size_t nBlobLen = 0;
+                GByte *pabyBlob =
+                    GPkgGeometryFromOGR(poGeom.get(), nSrsId, &nBlobLen);
+                if (!pabyBlob)
+                    return Error();
+                CheckGeometryType(poGeom->getGeometryType());
+                CreateGeometryExtensionIfNecessary(poGeom.get());
+                if (!poGeom->IsEmpty())
+                {
+                    poGeom->getEnvelope(&sEnvelope);
+                    bHasEnvelope = true;
+                }
+                // SQLite takes ownership of pabyBlob, even on failure
+                err = sqlite3_bind_blob(hInsertStmt, iBind++, pabyBlob,
+                                        static_cast<int>(nBlobLen), CPLFree);
+                continue;
+            }
+
+            const char *format = sColumn.schema->format;
+            switch (sColumn.eType)
+            {
+                case OFTInteger:
+                {
+                    int nVal = 0;
+                    switch (format[0])
+                    {
+                        case 'b':
+                        {
+                            const size_t iBit =
+                                iRow +
+                                static_cast<size_t>(sColumn.array->offset);
+                            nVal = (static_cast<const GByte *>(
+                                        sColumn.array->buffers[1])[iBit / 8] >>
+                                    (iBit % 8)) &
+                                   1;
+                            break;
+                        }
+                        case 'c':
+                            nVal = sColumn.GetValue<int8_t>(iRow);
+                            break;
+                        case 'C':
+                            nVal = sColumn.GetValue<uint8_t>(iRow);
+                            break;
+                        case 's':
+                            nVal = sColumn.GetValue<int16_t>(iRow);
+                            break;
+                        case 'S':
+                            nVal = sColumn.GetValue<uint16_t>(iRow);
+                            break;
+                        default:
+                            nVal = sColumn.GetValue<int32_t>(iRow);
+                            break;
+                    }
+                    err = sqlite3_bind_int(hInsertStmt, iBind++, nVal);
+                    break;
+                }
+
+                case OFTInteger64:
+                {
+                    err = sqlite3_bind_int64(
+                        hInsertStmt, iBind++,
+                        format[0] == 'I' ? sColumn.GetValue<uint32_t>(iRow)
+                                         : sColumn.GetValue<int64_t>(iRow));
+                    break;
+                }
+
+                case OFTReal:
+                {
+                    err = sqlite3_bind_double(
+                        hInsertStmt, iBind++,
+                        format[0] == 'f' ? sColumn.GetValue<float>(iRow)
+                                         : sColumn.GetValue<double>(iRow));
+                    break;
+                }
+
+                case OFTString:
+                {
+                    size_t nLen = 0;
+                    const char *pszVal = reinterpret_cast<const char *>(
+                        sColumn.GetBinary(iRow, nLen));
+                    // Strings go through OGRFeature as nul-terminated ones
+                    // in the generic implementation.
+                    const void *pNul = memchr(pszVal, 0, nLen);
+                    if (pNul)
+                        nLen = static_cast<const char *>(pNul) - pszVal;
+                    if (nLen > static_cast<size_t>(INT_MAX))
+                    {
+                        CPLError(CE_Failure, CPLE_NotSupported,
+                                 "Too large string");
+                        return Error();
+                    }
+                    err = sqlite3_bind_text(hInsertStmt, iBind++, pszVal,
+                                            static_cast<int>(nLen),
+                                            SQLITE_STATIC);
+                    break;
+                }
+
+                case OFTBinary:
+                {
+                    size_t nLen = 0;
+                    const GByte *pabyVal = sColumn.GetBinary(iRow, nLen);
+                    if (nLen > static_cast<size_t>(INT_MAX))
+                    {
+                        CPLError(CE_Failure, CPLE_NotSupported,
+                                 "Too large binary");
+                        return Error();
+                    }
+                    err = sqlite3_bind_blob(hInsertStmt, iBind++, pabyVal,
+                                            static_cast<int>(nLen),
+                                            SQLITE_STATIC);
+                    break;
+                }
+
+                case OFTDate:
+                {
+                    // date32: number of days since Epoch
+                    struct tm brokendowntime;
+                    CPLUnixTimeToYMDHMS(
+                        static_cast<GIntBig>(sColumn.GetValue<int32_t>(iRow)) *
+                            86400,
+                        &brokendowntime);
+                    const int nYear = brokendowntime.tm_year + 1900;
+                    int nLen = 0;
+                    if (nYear < 0 || nYear >= 10000)
+                    {
+                        CPLError(
+                            CE_Failure, CPLE_AppDefined,
+                            "OGRGetISO8601DateTime(): year %d unsupported ",
+                            nYear);
+                    }
+                    else
+                    {
+                        nLen = snprintf(szDate, sizeof(szDate),
+                                        "%04d-%02d-%02d", nYear,
+                                        brokendowntime.tm_mon + 1,
+                                        brokendowntime.tm_mday);
+                    }
+                    err = sqlite3_bind_text(hInsertStmt, iBind++, szDate, nLen,
+                                            SQLITE_TRANSIENT);
+                    break;
+                }
+
+                default:
+                {
+                    CPLAssert(false);
+                    break;
+                }
+            }
+        }
+
+        if (err != SQLITE_OK)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "sqlite3_bind_xxx() failed");
+            return Error();
+        }
+
+        err = sqlite3_step(hInsertStmt);
+        if (err != SQLITE_DONE)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "failed to execute insert : %s",
+                     sqlite3_errmsg(hDB) ? sqlite3_errmsg(hDB) : "");
+            return Error();
+        }
+        sqlite3_reset(hInsertStmt);
+        sqlite3_clear_bindings(hInsertStmt);
+
+        const GIntBig nFID = sqlite3_last_insert_rowid(hDB);
+
+        if (bHasEnvelope)
+        {
+            UpdateExtent(&sEnvelope);
+            if (!AddRTreeEntry(nFID, sEnvelope))
+                return Error();
+        }
+
+#ifdef ENABLE_GPKG_OGR_CONTENTS
+        if (m_nTotalFeatureCount >= 0)
+            m_nTotalFeatureCount++;
+#endif
+
+        // Write back the FID of the created feature, as the generic
+        // implementation does (with CreateFeature() semantics for rowid 0)
+        if (psFIDColumn)
+        {
+            const GIntBig nOutFID = nFID != 0 ? nFID : OGRNullFID;
+            auto psFIDArray =
+                const_cast<struct ArrowArray *>(psFIDColumn->array);
+            const size_t iIdx =
+                iRow + static_cast<size_t>(psFIDArray->offset);
+            auto pabyValidity = static_cast<GByte *>(
+                const_cast<void *>(psFIDArray->buffers[0]));
+            if (psFIDColumn->schema->format[0] == 'i' &&
+                nOutFID > std::numeric_limits<int32_t>::max())
+            {
+                if (pabyValidity)
+                {
+                    ++nFIDNullCount;
+                    pabyValidity[iIdx / 8] &=
+                        static_cast<GByte>(~(1 << (iIdx % 8)));
+                }
+                CPLError(CE_Warning, CPLE_AppDefined,
+                         "FID " CPL_FRMT_GIB
+                         " cannot be stored in FID array of type int32",
+                         nOutFID);
+            }
+            else
+            {
+                if (pabyValidity)
+                    pabyValidity[iIdx / 8] |=
+                        static_cast<GByte>(1 << (iIdx % 8));
+                void *pValues = const_cast<void *>(psFIDArray->buffers[1]);
+                if (psFIDColumn->schema->format[0] == 'i')
+                    static_cast<int32_t *>(pValues)[iIdx] =
+                        static_cast<int32_t>(nOutFID);
+                else
+                    static_cast<int64_t *>(pValues)[iIdx] = nOutFID;
+            }
+        }
+    }
+
+    sqlite3_finalize(hInsertStmt);
+
+    if (psFIDColumn && psFIDColumn->array->buffers[0])
+    {
+        const_cast<struct ArrowArray *>(psFIDColumn->array)->null_count =
+            nFIDNullCount;
+    }
+
+    if (nLength > 0)
+        m_bContentChanged = true;
+
+    bool bRet = true;
+    if (bTransactionOK)
+        bRet = CommitTransaction() == OGRERR_NONE;
+
+    return bRet;
+}
@@ -32,6 +32,9 @@
 #include "cpl_json.h"
 #include "ogrsf_frmts.h"
 
+#include <memory>
+#include <string>
+
 #define MVT_LCO                                                                \
     "<LayerCreationOptionList>"                                                \
     "  <Option name='MINZOOM' type='int' min='0' max='22' "                    \
@@ -65,7 +68,13 @@
     "description='Maximum size of a tile in bytes'/>"                          \
     "  <Option name='MAX_FEATURES' scope='vector' type='unsigned int' "        \
     "min='1' default='200000' "                                                \
-    "description='Maximum number of features per tile'/>"
+    "description='Maximum number of features per tile'/>"                      \
+    "  <Option name='TEMPORARY_STORAGE' scope='vector' type='string-select' "  \
+    "description='Storage of features before tiles are assembled' "            \
+    "default='SQLITE'>"                                                        \
+    "    <Value>SQLITE</Value>"                                                \
+    "    <Value>FILES</Value>"                                                 \
+    "  </Option>"
 
 #define MVT_MBTILES_COMMON_DSCO                                                \
     MVT_MBTILES_PMTILES_COMMON_DSCO                                            \
@@ -94,6 +103,32 @@ OGRFeature *OGRMVTCreateFeatureFrom(OGRFeature *poSrcFeature,
 GDALDataset *OGRMVTWriterDatasetCreate(const char *pszFilename, int nXSize,
                                        int nYSize, int nBandsIn,
                                        GDALDataType eDT, char **papszOptions);
+
+/** Receives the tiles generated by the MVT writer, instead of them being
+ * written in a directory or a MBTiles file. */
+class OGRMVTTileWriter
+{
+  public:
+    virtual ~OGRMVTTileWriter();
+
+    /** Key by which tiles are sorted before being passed to WriteTile().
+     * Must be thread-safe. */
+    virtual uint64_t GetTileOrderKey(int nZ, int nX, int nY) const = 0;
+
+    /** Called for each tile, by increasing GetTileOrderKey().
+     * nY = 0 is the top-most row. */
+    virtual bool WriteTile(int nZ, int nX, int nY,
+                           const std::string &osTileData) = 0;
+
+    /** Called once all tiles have been written, with the same metadata
+     * items as the ones of a MBTiles file, and the content of its 'json'
+     * item expanded. */
+    virtual bool Finalize(const CPLJSONObject &oMetadata) = 0;
+};
+
+GDALDataset *
+OGRMVTWriterDatasetCreate(const char *pszFilename, char **papszOptions,
+                          std::unique_ptr<OGRMVTTileWriter> poTileWriter);
 // #endif
 
 #endif  // MVTUTILS_H
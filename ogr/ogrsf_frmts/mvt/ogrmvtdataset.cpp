@@ -45,7 +45,14 @@
 #include "gpb.h"
 
 #include <algorithm>
+#include <deque>
+#include <functional>
+#include <future>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <queue>
+#include <tuple>
 #include <vector>
 #include <set>
 
@@ -3236,255 +3243,910 @@ struct OGRMVTFeatureContent
     GIntBig nFID;
 };
 
-class OGRMVTWriterDataset final : public GDALDataset
+/************************************************************************/
+/*                          MVTTempFeatureStore                         */
+/************************************************************************/
+
+// Feature of a tile, as staged before the tiles are assembled
+struct MVTTempFeature
 {
-    class MVTFieldProperties
-    {
-      public:
-        CPLString m_osName;
-        std::set<MVTTileLayerValue> m_oSetValues;
-        std::set<MVTTileLayerValue> m_oSetAllValues;
-        double m_dfMinVal = 0;
-        double m_dfMaxVal = 0;
-        bool m_bAllInt = false;
-        MVTTileLayerValue::ValueType m_eType =
-            MVTTileLayerValue::ValueType::NONE;
+    GUIntBig nTileKey = 0;  // see OGRMVTTileWriter::GetTileOrderKey()
+    int nZ = 0;
+    int nX = 0;
+    int nY = 0;
+    std::string osLayerName{};
+    GIntBig nSerial = 0;
+    GUIntBig nSeq = 0;  // insertion order, to break ties
+    double dfAreaOrLength = 0;
+    std::string osBlob{};  // compressed MVT layer with this single feature
+};
+
+// Order in which features of tiles are read back: by tile, layer name and
+// serial number. Same order as the indexed temporary SQLite database.
+static bool MVTTempFeatureLess(const MVTTempFeature &a, const MVTTempFeature &b)
+{
+    return std::tie(a.nTileKey, a.nZ, a.nX, a.nY, a.osLayerName, a.nSerial,
+                    a.nSeq) < std::tie(b.nTileKey, b.nZ, b.nX, b.nY,
+                                       b.osLayerName, b.nSerial, b.nSeq);
+}
+
+// Staging area of the features of the tiles, used instead of the temporary
+// SQLite database with TEMPORARY_STORAGE=FILES. Features are accumulated in
+// RAM. When their size exceeds a threshold, they are sorted and appended as a
+// sorted run to a temporary file. Runs are merged when reading them back.
+class MVTTempFeatureStore
+{
+    // Fixed-size part of a feature in the temporary file
+    struct Header
+    {
+        GUIntBig nTileKey;
+        GInt32 nZ;
+        GInt32 nX;
+        GInt32 nY;
+        GUInt32 nLayerNameSize;
+        GIntBig nSerial;
+        GUIntBig nSeq;
+        double dfAreaOrLength;
+        GUInt32 nBlobSize;
+        GUInt32 nPadding;
     };
 
-    class MVTLayerProperties
+    // Sequential reader of a run of the temporary file
+    class RunReader
     {
-      public:
-        int m_nMinZoom = 0;
-        int m_nMaxZoom = 0;
-        std::map<MVTTileLayerFeature::GeomType, GIntBig> m_oCountGeomType;
-        std::map<CPLString, size_t> m_oMapFieldNameToIdx;
-        std::vector<MVTFieldProperties> m_aoFields;
-        std::set<CPLString> m_oSetFields;
-    };
+        VSILFILE *m_fp = nullptr;
+        vsi_l_offset m_nOffset = 0;
+        vsi_l_offset m_nEndOffset = 0;
+        std::vector<GByte> m_abyBuffer{};
+        size_t m_nBufferPos = 0;
 
-    std::vector<std::unique_ptr<OGRMVTWriterLayer>> m_apoLayers;
-    CPLString m_osTempDB;
-    mutable std::mutex m_oDBMutex;
-    mutable bool m_bWriteFeatureError = false;
-    sqlite3_vfs *m_pMyVFS = nullptr;
-    sqlite3 *m_hDB = nullptr;
-    sqlite3_stmt *m_hInsertStmt = nullptr;
-    int m_nMinZoom = 0;
-    int m_nMaxZoom = 5;
-    double m_dfSimplification = 0.0;
-    double m_dfSimplificationMaxZoom = 0.0;
-    CPLJSONDocument m_oConf;
-    unsigned m_nExtent = knDEFAULT_EXTENT;
-    int m_nMetadataVersion = 2;
-    int m_nMVTVersion = 2;
-    int m_nBuffer = 5 * knDEFAULT_EXTENT / 256;
-    bool m_bGZip = true;
-    mutable CPLWorkerThreadPool m_oThreadPool;
-    bool m_bThreadPoolOK = false;
-    mutable GIntBig m_nTempTiles = 0;
-    CPLString m_osName;
-    CPLString m_osDescription;
-    CPLString m_osType{"overlay"};
-    sqlite3 *m_hDBMBTILES = nullptr;
-    OGREnvelope m_oEnvelope;
-    unsigned m_nMaxTileSize = 500000;
-    unsigned m_nMaxFeatures = 200000;
-    std::map<std::string, std::string> m_oMapLayerNameToDesc;
-    std::map<std::string, GIntBig> m_oMapLayerNameToFeatureCount;
-    CPLString m_osBounds;
-    CPLString m_osCenter;
-    CPLString m_osExtension{"pbf"};
-    OGRSpatialReference *m_poSRS = nullptr;
-    double m_dfTopX = 0.0;
-    double m_dfTopY = 0.0;
-    double m_dfTileDim0 = 0.0;
-    bool m_bReuseTempFile = false;  // debug only
+        bool Read(void *pDst, size_t nSize);
 
-    OGRErr PreGenerateForTile(
-        int nZ, int nX, int nY, const CPLString &osTargetName,
-        bool bIsMaxZoomForLayer,
-        const std::shared_ptr<OGRMVTFeatureContent> &poFeatureContent,
-        GIntBig nSerial, const std::shared_ptr<OGRGeometry> &poGeom,
-        const OGREnvelope &sEnvelope) const;
+      public:
+        RunReader(VSILFILE *fp, vsi_l_offset nStart, vsi_l_offset nEnd)
+            : m_fp(fp), m_nOffset(nStart), m_nEndOffset(nEnd)
+        {
+        }
 
-    static void WriterTaskFunc(void *pParam);
+        bool IsEOF() const
+        {
+            return m_nBufferPos == m_abyBuffer.size() &&
+                   m_nOffset == m_nEndOffset;
+        }
 
-    OGRErr PreGenerateForTileReal(int nZ, int nX, int nY,
-                                  const CPLString &osTargetName,
-                                  bool bIsMaxZoomForLayer,
-                                  const OGRMVTFeatureContent *poFeatureContent,
-                                  GIntBig nSerial, const OGRGeometry *poGeom,
-                                  const OGREnvelope &sEnvelope) const;
+        bool Next(MVTTempFeature &oFeature);
+    };
 
-    void ConvertToTileCoords(double dfX, double dfY, int &nX, int &nY,
-                             double dfTopX, double dfTopY,
-                             double dfTileDim) const;
-    bool EncodeLineString(MVTTileLayerFeature *poGPBFeature,
-                          const OGRLineString *poLS, OGRLineString *poOutLS,
-                          bool bWriteLastPoint, bool bReverseOrder,
-                          GUInt32 nMinLineTo, double dfTopX, double dfTopY,
-                          double dfTileDim, int &nLastX, int &nLastY) const;
-    bool EncodePolygon(MVTTileLayerFeature *poGPBFeature,
-                       const OGRPolygon *poPoly, OGRPolygon *poOutPoly,
-                       double dfTopX, double dfTopY, double dfTileDim,
-                       int &nLastX, int &nLastY, double &dfArea) const;
-#ifdef notdef
-    bool EncodeRepairedOuterRing(MVTTileLayerFeature *poGPBFeature,
-                                 OGRPolygon &oOutPoly, int &nLastX,
-                                 int &nLastY) const;
-#endif
+    struct MergeItem
+    {
+        std::shared_ptr<MVTTempFeature> poFeature{};
+        size_t iRun = 0;
 
-    static void UpdateLayerProperties(MVTLayerProperties *poLayerProperties,
-                                      const std::string &osKey,
-                                      const MVTTileLayerValue &oValue);
+        bool operator<(const MergeItem &other) const
+        {
+            // Reversed, so that std::priority_queue returns the smallest one
+            return MVTTempFeatureLess(*(other.poFeature), *poFeature);
+        }
+    };
 
-    void EncodeFeature(const void *pabyBlob, int nBlobSize,
-                       std::shared_ptr<MVTTileLayer> poTargetLayer,
-                       std::map<CPLString, GUInt32> &oMapKeyToIdx,
-                       std::map<MVTTileLayerValue, GUInt32> &oMapValueToIdx,
-                       MVTLayerProperties *poLayerProperties, GUInt32 nExtent,
-                       unsigned &nFeaturesInTile);
+    std::string m_osFilename{};
+    size_t m_nMaxRAM = 0;
 
-    std::string
-    EncodeTile(int nZ, int nX, int nY, sqlite3_stmt *hStmtLayer,
-               sqlite3_stmt *hStmtRows,
-               std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
-               std::set<CPLString> &oSetLayers, GIntBig &nTempTilesRead);
+    std::mutex m_oMutex{};
+    std::vector<MVTTempFeature> m_aoFeatures{};
+    size_t m_nFeaturesSize = 0;
+    GUIntBig m_nSeq = 0;
+    bool m_bError = false;
 
-    std::string RecodeTileLowerResolution(int nZ, int nX, int nY, int nExtent,
-                                          sqlite3_stmt *hStmtLayer,
-                                          sqlite3_stmt *hStmtRows);
+    std::mutex m_oFileMutex{};
+    VSILFILE *m_fp = nullptr;
+    std::vector<std::pair<vsi_l_offset, vsi_l_offset>> m_anRuns{};
 
-    bool CreateOutput();
+    // Reading state
+    size_t m_iNextInMemory = 0;
+    std::vector<std::unique_ptr<RunReader>> m_apoReaders{};
+    std::priority_queue<MergeItem> m_oMergeQueue{};
 
-    bool GenerateMetadata(size_t nLayers,
-                          const std::map<CPLString, MVTLayerProperties> &oMap);
+    bool WriteRun(std::vector<MVTTempFeature> &aoFeatures);
+
+    CPL_DISALLOW_COPY_ASSIGN(MVTTempFeatureStore)
 
   public:
-    OGRMVTWriterDataset();
-    ~OGRMVTWriterDataset();
+    MVTTempFeatureStore(const std::string &osFilename, size_t nMaxRAM)
+        : m_osFilename(osFilename), m_nMaxRAM(nMaxRAM)
+    {
+    }
 
-    CPLErr Close() override;
+    ~MVTTempFeatureStore();
 
-    OGRLayer *ICreateLayer(const char *, const OGRSpatialReference * = nullptr,
-                           OGRwkbGeometryType = wkbUnknown,
-                           char ** = nullptr) override;
+    GUIntBig GetFeatureCount() const
+    {
+        return m_nSeq;
+    }
 
-    int TestCapability(const char *) override;
+    bool Add(MVTTempFeature &&oFeature);
 
-    OGRErr WriteFeature(OGRMVTWriterLayer *poLayer, OGRFeature *poFeature,
-                        GIntBig nSerial, OGRGeometry *poGeom);
+    bool StartReading();
 
-    static GDALDataset *Create(const char *pszFilename, int nXSize, int nYSize,
-                               int nBandsIn, GDALDataType eDT,
-                               char **papszOptions);
+    std::shared_ptr<MVTTempFeature> GetNext();
 
-    OGRSpatialReference *GetSRS()
+    bool HasError() const
     {
-        return m_poSRS;
+        return m_bError;
     }
 };
 
 /************************************************************************/
-/*                           OGRMVTWriterLayer                          */
+/*                       ~MVTTempFeatureStore()                         */
 /************************************************************************/
 
-class OGRMVTWriterLayer final : public OGRLayer
+MVTTempFeatureStore::~MVTTempFeatureStore()
 {
-    friend class OGRMVTWriterDataset;
-
-    OGRMVTWriterDataset *m_poDS = nullptr;
-    OGRFeatureDefn *m_poFeatureDefn = nullptr;
-    OGRCoordinateTransformation *m_poCT = nullptr;
-    GIntBig m_nSerial = 0;
-    int m_nMinZoom = 0;
-    int m_nMaxZoom = 5;
-    CPLString m_osTargetName;
-
-  public:
-    OGRMVTWriterLayer(OGRMVTWriterDataset *poDS, const char *pszLayerName,
-                      OGRSpatialReference *poSRS);
-    ~OGRMVTWriterLayer();
-
-    void ResetReading() override
+    if (m_fp)
     {
+        VSIFCloseL(m_fp);
+        if (CPLTestBool(
+                CPLGetConfigOption("OGR_MVT_REMOVE_TEMP_FILE", "YES")))
+        {
+            VSIUnlink(m_osFilename.c_str());
+        }
     }
-    OGRFeature *GetNextFeature() override
+}
+
+/************************************************************************/
+/*                                Add()                                 */
+/************************************************************************/
+
+// Thread-safe
+bool MVTTempFeatureStore::Add(MVTTempFeature &&oFeature)
+{
+    std::vector<MVTTempFeature> aoFeaturesToWrite;
     {
-        return nullptr;
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        if (m_bError)
+            return false;
+        oFeature.nSeq = m_nSeq++;
+        m_nFeaturesSize += sizeof(MVTTempFeature) +
+                           oFeature.osLayerName.size() + oFeature.osBlob.size();
+        m_aoFeatures.emplace_back(std::move(oFeature));
+        if (m_nFeaturesSize < m_nMaxRAM)
+            return true;
+        std::swap(aoFeaturesToWrite, m_aoFeatures);
+        m_nFeaturesSize = 0;
     }
-    OGRFeatureDefn *GetLayerDefn() override
+
+    // Sort outside of the lock, so that other threads can go on
+    // generating features
+    if (!WriteRun(aoFeaturesToWrite))
     {
-        return m_poFeatureDefn;
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_bError = true;
+        return false;
     }
-    int TestCapability(const char *) override;
-    OGRErr ICreateFeature(OGRFeature *) override;
-    OGRErr CreateField(const OGRFieldDefn *, int) override;
-};
+    return true;
+}
 
 /************************************************************************/
-/*                          OGRMVTWriterLayer()                         */
+/*                              WriteRun()                              */
 /************************************************************************/
 
-OGRMVTWriterLayer::OGRMVTWriterLayer(OGRMVTWriterDataset *poDS,
-                                     const char *pszLayerName,
-                                     OGRSpatialReference *poSRSIn)
+bool MVTTempFeatureStore::WriteRun(std::vector<MVTTempFeature> &aoFeatures)
 {
-    m_poDS = poDS;
-    m_poFeatureDefn = new OGRFeatureDefn(pszLayerName);
-    SetDescription(m_poFeatureDefn->GetName());
-    m_poFeatureDefn->Reference();
-
-    m_poFeatureDefn->GetGeomFieldDefn(0)->SetSpatialRef(poDS->GetSRS());
+    std::sort(aoFeatures.begin(), aoFeatures.end(), MVTTempFeatureLess);
 
-    if (poSRSIn != nullptr && !poDS->GetSRS()->IsSame(poSRSIn))
+    std::lock_guard<std::mutex> oLock(m_oFileMutex);
+    if (m_fp == nullptr)
     {
-        m_poCT = OGRCreateCoordinateTransformation(poSRSIn, poDS->GetSRS());
-        if (m_poCT == nullptr)
+        CPLDebug("MVT", "Spilling features to temporary file %s",
+                 m_osFilename.c_str());
+        m_fp = VSIFOpenL(m_osFilename.c_str(), "w+b");
+        if (m_fp == nullptr)
         {
-            // If we can't create a transformation, issue a warning - but
-            // continue the transformation.
-            CPLError(CE_Warning, CPLE_AppDefined,
-                     "Failed to create coordinate transformation between the "
-                     "input and target coordinate systems.");
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                     m_osFilename.c_str());
+            return false;
+        }
+        // For Unix
+        if (CPLTestBool(
+                CPLGetConfigOption("OGR_MVT_REMOVE_TEMP_FILE", "YES")))
+        {
+            VSIUnlink(m_osFilename.c_str());
         }
     }
-}
-
-/************************************************************************/
-/*                          ~OGRMVTWriterLayer()                        */
-/************************************************************************/
 
-OGRMVTWriterLayer::~OGRMVTWriterLayer()
-{
-    m_poFeatureDefn->Release();
-    delete m_poCT;
+    if (VSIFSeekL(m_fp, 0, SEEK_END) != 0)
+        return false;
+    const vsi_l_offset nStart = VSIFTellL(m_fp);
+
+    constexpr size_t BUFFER_SIZE = 1024 * 1024;
+    std::string osBuffer;
+    osBuffer.reserve(BUFFER_SIZE);
+    for (auto &oFeature : aoFeatures)
+    {
+        Header sHeader;
+        sHeader.nTileKey = oFeature.nTileKey;
+        sHeader.nZ = oFeature.nZ;
+        sHeader.nX = oFeature.nX;
+        sHeader.nY = oFeature.nY;
+        sHeader.nLayerNameSize =
+            static_cast<GUInt32>(oFeature.osLayerName.size());
+        sHeader.nSerial = oFeature.nSerial;
+        sHeader.nSeq = oFeature.nSeq;
+        sHeader.dfAreaOrLength = oFeature.dfAreaOrLength;
+        sHeader.nBlobSize = static_cast<GUInt32>(oFeature.osBlob.size());
+        sHeader.nPadding = 0;
+        osBuffer.append(reinterpret_cast<const char *>(&sHeader),
+                        sizeof(sHeader));
+        osBuffer.append(oFeature.osLayerName);
+        osBuffer.append(oFeature.osBlob);
+        // Release memory as we go
+        std::string().swap(oFeature.osBlob);
+        if (osBuffer.size() >= BUFFER_SIZE)
+        {
+            if (VSIFWriteL(osBuffer.data(), 1, osBuffer.size(), m_fp) !=
+                osBuffer.size())
+            {
+                CPLError(CE_Failure, CPLE_FileIO,
+                         "Cannot write in temporary file %s",
+                         m_osFilename.c_str());
+                return false;
+            }
+            osBuffer.clear();
+        }
+    }
+    if (VSIFWriteL(osBuffer.data(), 1, osBuffer.size(), m_fp) !=
+        osBuffer.size())
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot write in temporary file %s",
+                 m_osFilename.c_str());
+        return false;
+    }
+    m_anRuns.emplace_back(nStart, VSIFTellL(m_fp));
+    aoFeatures.clear();
+    return true;
 }
 
 /************************************************************************/
-/*                            TestCapability()                          */
+/*                            StartReading()                            */
 /************************************************************************/
 
-int OGRMVTWriterLayer::TestCapability(const char *pszCap)
+// Must be called once all features have been added
+bool MVTTempFeatureStore::StartReading()
 {
+    if (m_bError)
+        return false;
 
-    if (EQUAL(pszCap, OLCSequentialWrite) || EQUAL(pszCap, OLCCreateField))
+    if (m_anRuns.empty())
+    {
+        // Everything fits in RAM
+        std::sort(m_aoFeatures.begin(), m_aoFeatures.end(),
+                  MVTTempFeatureLess);
         return true;
-    return false;
+    }
+
+    if (!m_aoFeatures.empty() && !WriteRun(m_aoFeatures))
+    {
+        m_bError = true;
+        return false;
+    }
+    std::vector<MVTTempFeature>().swap(m_aoFeatures);
+
+    CPLDebug("MVT", "Merging %d sorted runs of features",
+             static_cast<int>(m_anRuns.size()));
+    for (const auto &anRun : m_anRuns)
+    {
+        m_apoReaders.emplace_back(
+            std::make_unique<RunReader>(m_fp, anRun.first, anRun.second));
+        MergeItem oItem;
+        oItem.poFeature = std::make_shared<MVTTempFeature>();
+        oItem.iRun = m_apoReaders.size() - 1;
+        if (!m_apoReaders.back()->Next(*(oItem.poFeature)))
+        {
+            m_bError = true;
+            return false;
+        }
+        m_oMergeQueue.push(std::move(oItem));
+    }
+    return true;
 }
 
 /************************************************************************/
-/*                            CreateField()                             */
+/*                              GetNext()                               */
 /************************************************************************/
 
-OGRErr OGRMVTWriterLayer::CreateField(const OGRFieldDefn *poFieldDefn, int)
+// Returns features sorted with MVTTempFeatureLess(), or nullptr when all
+// have been read (or in case of error)
+std::shared_ptr<MVTTempFeature> MVTTempFeatureStore::GetNext()
 {
-    m_poFeatureDefn->AddFieldDefn(poFieldDefn);
-    return OGRERR_NONE;
+    if (m_bError)
+        return nullptr;
+
+    if (m_apoReaders.empty())
+    {
+        if (m_iNextInMemory == m_aoFeatures.size())
+            return nullptr;
+        return std::make_shared<MVTTempFeature>(
+            std::move(m_aoFeatures[m_iNextInMemory++]));
+    }
+
+    if (m_oMergeQueue.empty())
+        return nullptr;
+    auto oItem = m_oMergeQueue.top();
+    m_oMergeQueue.pop();
+    auto &poReader = m_apoReaders[oItem.iRun];
+    if (!poReader->IsEOF())
+    {
+        MergeItem oNextItem;
+        oNextItem.poFeature = std::make_shared<MVTTempFeature>();
+        oNextItem.iRun = oItem.iRun;
+        if (!poReader->Next(*(oNextItem.poFeature)))
+        {
+            m_bError = true;
+            return nullptr;
+        }
+        m_oMergeQueue.push(std::move(oNextItem));
+    }
+    return oItem.poFeature;
 }
 
 /************************************************************************/
-/*                            ICreateFeature()                          */
+/*                         RunReader::Read()                            */
+/************************************************************************/
+
+bool MVTTempFeatureStore::RunReader::Read(void *pDst, size_t nSize)
+{
+    GByte *pabyDst = static_cast<GByte *>(pDst);
+    while (nSize > 0)
+    {
+        if (m_nBufferPos == m_abyBuffer.size())
+        {
+            constexpr vsi_l_offset CHUNK_SIZE = 1024 * 1024;
+            const size_t nToRead = static_cast<size_t>(
+                std::min(CHUNK_SIZE, m_nEndOffset - m_nOffset));
+            if (nToRead == 0)
+                return false;
+            m_abyBuffer.resize(nToRead);
+            m_nBufferPos = 0;
+            if (VSIFSeekL(m_fp, m_nOffset, SEEK_SET) != 0 ||
+                VSIFReadL(m_abyBuffer.data(), 1, nToRead, m_fp) != nToRead)
+            {
+                CPLError(CE_Failure, CPLE_FileIO,
+                         "Cannot read temporary file");
+                return false;
+            }
+            m_nOffset += nToRead;
+        }
+        const size_t nAvailable =
+            std::min(nSize, m_abyBuffer.size() - m_nBufferPos);
+        memcpy(pabyDst, m_abyBuffer.data() + m_nBufferPos, nAvailable);
+        m_nBufferPos += nAvailable;
+        pabyDst += nAvailable;
+        nSize -= nAvailable;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         RunReader::Next()                            */
+/************************************************************************/
+
+bool MVTTempFeatureStore::RunReader::Next(MVTTempFeature &oFeature)
+{
+    Header sHeader;
+    if (!Read(&sHeader, sizeof(sHeader)))
+        return false;
+    oFeature.nTileKey = sHeader.nTileKey;
+    oFeature.nZ = sHeader.nZ;
+    oFeature.nX = sHeader.nX;
+    oFeature.nY = sHeader.nY;
+    oFeature.nSerial = sHeader.nSerial;
+    oFeature.nSeq = sHeader.nSeq;
+    oFeature.dfAreaOrLength = sHeader.dfAreaOrLength;
+    oFeature.osLayerName.resize(sHeader.nLayerNameSize);
+    oFeature.osBlob.resize(sHeader.nBlobSize);
+    return Read(&oFeature.osLayerName[0], oFeature.osLayerName.size()) &&
+           Read(&oFeature.osBlob[0], oFeature.osBlob.size());
+}
+
+/************************************************************************/
+/*                            MVTTileFeatures                           */
+/************************************************************************/
+
+// Staged features of a tile, from which the tile is assembled
+class MVTTileFeatures
+{
+  public:
+    // Receives the target layer name and the compressed feature. Returns
+    // false to stop the iteration.
+    using FeatureFunc = std::function<bool(
+        const char *pszLayerName, const void *pabyBlob, int nBlobSize)>;
+
+    virtual ~MVTTileFeatures() = default;
+
+    // Iterates over features, ordered by layer name and serial number
+    virtual bool ForEachFeature(const FeatureFunc &pfnFunc) = 0;
+
+    // Iterates over at most nMaxCount features, ordered by decreasing area
+    // or length
+    virtual bool
+    ForEachFeatureByDecreasingAreaOrLength(unsigned nMaxCount,
+                                           const FeatureFunc &pfnFunc) = 0;
+};
+
+/************************************************************************/
+/*                        MVTTempDBTileFeatures                         */
+/************************************************************************/
+
+// Features of a tile in the temporary SQLite database
+class MVTTempDBTileFeatures final : public MVTTileFeatures
+{
+    sqlite3 *m_hDB;
+    sqlite3_stmt *m_hStmtLayer;
+    sqlite3_stmt *m_hStmtRows;
+    int m_nZ;
+    int m_nX;
+    int m_nY;
+
+    CPL_DISALLOW_COPY_ASSIGN(MVTTempDBTileFeatures)
+
+  public:
+    MVTTempDBTileFeatures(sqlite3 *hDB, sqlite3_stmt *hStmtLayer,
+                          sqlite3_stmt *hStmtRows, int nZ, int nX, int nY)
+        : m_hDB(hDB), m_hStmtLayer(hStmtLayer), m_hStmtRows(hStmtRows),
+          m_nZ(nZ), m_nX(nX), m_nY(nY)
+    {
+    }
+
+    bool ForEachFeature(const FeatureFunc &pfnFunc) override;
+
+    bool
+    ForEachFeatureByDecreasingAreaOrLength(unsigned nMaxCount,
+                                           const FeatureFunc &pfnFunc) override;
+};
+
+bool MVTTempDBTileFeatures::ForEachFeature(const FeatureFunc &pfnFunc)
+{
+    sqlite3_bind_int(m_hStmtLayer, 1, m_nZ);
+    sqlite3_bind_int(m_hStmtLayer, 2, m_nX);
+    sqlite3_bind_int(m_hStmtLayer, 3, m_nY);
+
+    bool bContinue = true;
+    while (bContinue && sqlite3_step(m_hStmtLayer) == SQLITE_ROW)
+    {
+        const char *pszLayerName = reinterpret_cast<const char *>(
+            sqlite3_column_text(m_hStmtLayer, 0));
+        sqlite3_bind_int(m_hStmtRows, 1, m_nZ);
+        sqlite3_bind_int(m_hStmtRows, 2, m_nX);
+        sqlite3_bind_int(m_hStmtRows, 3, m_nY);
+        sqlite3_bind_text(m_hStmtRows, 4, pszLayerName, -1, SQLITE_STATIC);
+
+        while (bContinue && sqlite3_step(m_hStmtRows) == SQLITE_ROW)
+        {
+            int nBlobSize = sqlite3_column_bytes(m_hStmtRows, 0);
+            const void *pabyBlob = sqlite3_column_blob(m_hStmtRows, 0);
+            bContinue = pfnFunc(pszLayerName, pabyBlob, nBlobSize);
+        }
+        sqlite3_reset(m_hStmtRows);
+    }
+
+    sqlite3_reset(m_hStmtLayer);
+    return true;
+}
+
+bool MVTTempDBTileFeatures::ForEachFeatureByDecreasingAreaOrLength(
+    unsigned nMaxCount, const FeatureFunc &pfnFunc)
+{
+    char *pszSQL =
+        sqlite3_mprintf("SELECT layer, feature FROM temp "
+                        "WHERE z = %d AND x = %d AND y = %d ORDER BY "
+                        "area_or_length DESC LIMIT %d",
+                        m_nZ, m_nX, m_nY, nMaxCount);
+    sqlite3_stmt *hTmpStmt = nullptr;
+    CPL_IGNORE_RET_VAL(
+        sqlite3_prepare_v2(m_hDB, pszSQL, -1, &hTmpStmt, nullptr));
+    sqlite3_free(pszSQL);
+    if (!hTmpStmt)
+        return false;
+
+    while (sqlite3_step(hTmpStmt) == SQLITE_ROW)
+    {
+        const char *pszLayerName =
+            reinterpret_cast<const char *>(sqlite3_column_text(hTmpStmt, 0));
+        int nBlobSize = sqlite3_column_bytes(hTmpStmt, 1);
+        const void *pabyBlob = sqlite3_column_blob(hTmpStmt, 1);
+        if (!pfnFunc(pszLayerName, pabyBlob, nBlobSize))
+            break;
+    }
+
+    sqlite3_finalize(hTmpStmt);
+    return true;
+}
+
+/************************************************************************/
+/*                      MVTTempFilesTileFeatures                        */
+/************************************************************************/
+
+// Features of a tile read from a MVTTempFeatureStore. As at most nMaxFeatures
+// are encoded in a tile, only the first nMaxFeatures ones, and the
+// nMaxFeatures ones with the largest area or length are retained.
+class MVTTempFilesTileFeatures final : public MVTTileFeatures
+{
+    struct AreaItem
+    {
+        double dfAreaOrLength;
+        size_t nIdx;  // index of the feature in the tile
+        std::shared_ptr<MVTTempFeature> poFeature;
+
+        // Larger area first, and then in the order of ForEachFeature()
+        bool operator<(const AreaItem &other) const
+        {
+            if (dfAreaOrLength != other.dfAreaOrLength)
+                return dfAreaOrLength > other.dfAreaOrLength;
+            return nIdx < other.nIdx;
+        }
+    };
+
+    size_t m_nMaxFeatures;
+    size_t m_nFeatures = 0;
+    std::vector<std::shared_ptr<MVTTempFeature>> m_apoFeatures{};
+    std::vector<AreaItem> m_aoLargestFeatures{};  // heap
+
+  public:
+    explicit MVTTempFilesTileFeatures(unsigned nMaxFeatures)
+        : m_nMaxFeatures(nMaxFeatures)
+    {
+    }
+
+    void Add(const std::shared_ptr<MVTTempFeature> &poFeature);
+
+    bool ForEachFeature(const FeatureFunc &pfnFunc) override;
+
+    bool
+    ForEachFeatureByDecreasingAreaOrLength(unsigned nMaxCount,
+                                           const FeatureFunc &pfnFunc) override;
+};
+
+// Features must be added in the order of MVTTempFeatureLess()
+void MVTTempFilesTileFeatures::Add(
+    const std::shared_ptr<MVTTempFeature> &poFeature)
+{
+    if (m_apoFeatures.size() < m_nMaxFeatures)
+        m_apoFeatures.push_back(poFeature);
+
+    // The top of the heap is the feature with the smallest area
+    AreaItem oItem{poFeature->dfAreaOrLength, m_nFeatures++, poFeature};
+    if (m_aoLargestFeatures.size() < m_nMaxFeatures)
+    {
+        m_aoLargestFeatures.push_back(std::move(oItem));
+        std::push_heap(m_aoLargestFeatures.begin(), m_aoLargestFeatures.end());
+    }
+    else if (oItem < m_aoLargestFeatures.front())
+    {
+        std::pop_heap(m_aoLargestFeatures.begin(), m_aoLargestFeatures.end());
+        m_aoLargestFeatures.back() = std::move(oItem);
+        std::push_heap(m_aoLargestFeatures.begin(), m_aoLargestFeatures.end());
+    }
+}
+
+bool MVTTempFilesTileFeatures::ForEachFeature(const FeatureFunc &pfnFunc)
+{
+    for (const auto &poFeature : m_apoFeatures)
+    {
+        if (!pfnFunc(poFeature->osLayerName.c_str(), poFeature->osBlob.data(),
+                     static_cast<int>(poFeature->osBlob.size())))
+        {
+            break;
+        }
+    }
+    return true;
+}
+
+bool MVTTempFilesTileFeatures::ForEachFeatureByDecreasingAreaOrLength(
+    unsigned nMaxCount, const FeatureFunc &pfnFunc)
+{
+    auto aoSorted = m_aoLargestFeatures;
+    std::sort(aoSorted.begin(), aoSorted.end());
+    if (aoSorted.size() > nMaxCount)
+        aoSorted.resize(nMaxCount);
+    for (const auto &oItem : aoSorted)
+    {
+        const auto &poFeature = oItem.poFeature;
+        if (!pfnFunc(poFeature->osLayerName.c_str(), poFeature->osBlob.data(),
+                     static_cast<int>(poFeature->osBlob.size())))
+        {
+            break;
+        }
+    }
+    return true;
+}
+
+class OGRMVTWriterDataset final : public GDALDataset
+{
+    class MVTFieldProperties
+    {
+      public:
+        CPLString m_osName;
+        std::set<MVTTileLayerValue> m_oSetValues;
+        std::set<MVTTileLayerValue> m_oSetAllValues;
+        double m_dfMinVal = 0;
+        double m_dfMaxVal = 0;
+        bool m_bAllInt = false;
+        MVTTileLayerValue::ValueType m_eType =
+            MVTTileLayerValue::ValueType::NONE;
+    };
+
+    class MVTLayerProperties
+    {
+      public:
+        int m_nMinZoom = 0;
+        int m_nMaxZoom = 0;
+        std::map<MVTTileLayerFeature::GeomType, GIntBig> m_oCountGeomType;
+        std::map<CPLString, size_t> m_oMapFieldNameToIdx;
+        std::vector<MVTFieldProperties> m_aoFields;
+        std::set<CPLString> m_oSetFields;
+    };
+
+    // What EncodeTile() gathered on the features of a layer of a tile, to
+    // update the MVTLayerProperties once tiles are encoded
+    struct MVTTileLayerStats
+    {
+        std::string osLayerName{};
+        std::vector<MVTTileLayerFeature::GeomType> aeGeomTypes{};
+        std::vector<std::pair<std::string, MVTTileLayerValue>> aoKeyValues{};
+    };
+
+    std::vector<std::unique_ptr<OGRMVTWriterLayer>> m_apoLayers;
+    CPLString m_osTempDB;
+    std::unique_ptr<MVTTempFeatureStore> m_poTempFeatureStore{};
+    mutable std::mutex m_oDBMutex;
+    mutable bool m_bWriteFeatureError = false;
+    sqlite3_vfs *m_pMyVFS = nullptr;
+    sqlite3 *m_hDB = nullptr;
+    sqlite3_stmt *m_hInsertStmt = nullptr;
+    int m_nMinZoom = 0;
+    int m_nMaxZoom = 5;
+    double m_dfSimplification = 0.0;
+    double m_dfSimplificationMaxZoom = 0.0;
+    CPLJSONDocument m_oConf;
+    unsigned m_nExtent = knDEFAULT_EXTENT;
+    int m_nMetadataVersion = 2;
+    int m_nMVTVersion = 2;
+    int m_nBuffer = 5 * knDEFAULT_EXTENT / 256;
+    bool m_bGZip = true;
+    mutable CPLWorkerThreadPool m_oThreadPool;
+    bool m_bThreadPoolOK = false;
+    mutable GIntBig m_nTempTiles = 0;
+    CPLString m_osName;
+    CPLString m_osDescription;
+    CPLString m_osType{"overlay"};
+    sqlite3 *m_hDBMBTILES = nullptr;
+    OGREnvelope m_oEnvelope;
+    unsigned m_nMaxTileSize = 500000;
+    unsigned m_nMaxFeatures = 200000;
+    std::map<std::string, std::string> m_oMapLayerNameToDesc;
+    std::map<std::string, GIntBig> m_oMapLayerNameToFeatureCount;
+    CPLString m_osBounds;
+    CPLString m_osCenter;
+    CPLString m_osExtension{"pbf"};
+    OGRSpatialReference *m_poSRS = nullptr;
+    double m_dfTopX = 0.0;
+    double m_dfTopY = 0.0;
+    double m_dfTileDim0 = 0.0;
+    bool m_bReuseTempFile = false;  // debug only
+    std::unique_ptr<OGRMVTTileWriter> m_poTileWriter{};
+
+    OGRErr PreGenerateForTile(
+        int nZ, int nX, int nY, const CPLString &osTargetName,
+        bool bIsMaxZoomForLayer,
+        const std::shared_ptr<OGRMVTFeatureContent> &poFeatureContent,
+        GIntBig nSerial, const std::shared_ptr<OGRGeometry> &poGeom,
+        const OGREnvelope &sEnvelope) const;
+
+    static void WriterTaskFunc(void *pParam);
+
+    OGRErr PreGenerateForTileReal(int nZ, int nX, int nY,
+                                  const CPLString &osTargetName,
+                                  bool bIsMaxZoomForLayer,
+                                  const OGRMVTFeatureContent *poFeatureContent,
+                                  GIntBig nSerial, const OGRGeometry *poGeom,
+                                  const OGREnvelope &sEnvelope) const;
+
+    void ConvertToTileCoords(double dfX, double dfY, int &nX, int &nY,
+                             double dfTopX, double dfTopY,
+                             double dfTileDim) const;
+    bool EncodeLineString(MVTTileLayerFeature *poGPBFeature,
+                          const OGRLineString *poLS, OGRLineString *poOutLS,
+                          bool bWriteLastPoint, bool bReverseOrder,
+                          GUInt32 nMinLineTo, double dfTopX, double dfTopY,
+                          double dfTileDim, int &nLastX, int &nLastY) const;
+    bool EncodePolygon(MVTTileLayerFeature *poGPBFeature,
+                       const OGRPolygon *poPoly, OGRPolygon *poOutPoly,
+                       double dfTopX, double dfTopY, double dfTileDim,
+                       int &nLastX, int &nLastY, double &dfArea) const;
+#ifdef notdef
+    bool EncodeRepairedOuterRing(MVTTileLayerFeature *poGPBFeature,
+                                 OGRPolygon &oOutPoly, int &nLastX,
+                                 int &nLastY) const;
+#endif
+
+    static void UpdateLayerProperties(MVTLayerProperties *poLayerProperties,
+                                      const std::string &osKey,
+                                      const MVTTileLayerValue &oValue);
+
+    static void
+    ApplyTileLayerStats(int nZ,
+                        const std::vector<MVTTileLayerStats> &aoLayerStats,
+                        std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
+                        std::set<CPLString> &oSetLayers);
+
+    void EncodeFeature(const void *pabyBlob, int nBlobSize,
+                       std::shared_ptr<MVTTileLayer> poTargetLayer,
+                       std::map<CPLString, GUInt32> &oMapKeyToIdx,
+                       std::map<MVTTileLayerValue, GUInt32> &oMapValueToIdx,
+                       MVTTileLayerStats *poLayerStats, GUInt32 nExtent,
+                       unsigned &nFeaturesInTile) const;
+
+    std::string EncodeTile(int nZ, int nX, int nY,
+                           MVTTileFeatures &oTileFeatures,
+                           std::vector<MVTTileLayerStats> &aoLayerStats,
+                           unsigned &nFeaturesRead) const;
+
+    std::string RecodeTileLowerResolution(int nZ, int nX, int nY, int nExtent,
+                                          MVTTileFeatures &oTileFeatures) const;
+
+    struct MVTTileEncodingTask;
+
+    static void EncodeTileTaskFunc(void *pParam);
+
+    void ReportProgress(GIntBig &nTempTilesRead, unsigned nFeaturesRead) const;
+
+    bool WriteTile(int nZ, int nX, int nY, const std::string &oTileBuffer,
+                   sqlite3_stmt *hInsertStmt, int &nLastZ, int &nLastX);
+
+    bool WriteTilesFromTempDB(
+        sqlite3_stmt *hInsertStmt,
+        std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
+        std::set<CPLString> &oSetLayers);
+
+    bool WriteTilesFromTempFiles(
+        sqlite3_stmt *hInsertStmt,
+        std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
+        std::set<CPLString> &oSetLayers);
+
+    bool CreateOutput();
+
+    bool GenerateMetadata(size_t nLayers,
+                          const std::map<CPLString, MVTLayerProperties> &oMap);
+
+  public:
+    OGRMVTWriterDataset();
+    ~OGRMVTWriterDataset();
+
+    CPLErr Close() override;
+
+    OGRLayer *ICreateLayer(const char *, const OGRSpatialReference * = nullptr,
+                           OGRwkbGeometryType = wkbUnknown,
+                           char ** = nullptr) override;
+
+    int TestCapability(const char *) override;
+
+    OGRErr WriteFeature(OGRMVTWriterLayer *poLayer, OGRFeature *poFeature,
+                        GIntBig nSerial, OGRGeometry *poGeom);
+
+    static GDALDataset *Create(const char *pszFilename, int nXSize, int nYSize,
+                               int nBandsIn, GDALDataType eDT,
+                               char **papszOptions);
+
+    static GDALDataset *
+    Create(const char *pszFilename, char **papszOptions,
+           std::unique_ptr<OGRMVTTileWriter> poTileWriter);
+
+    OGRSpatialReference *GetSRS()
+    {
+        return m_poSRS;
+    }
+};
+
+/************************************************************************/
+/*                           OGRMVTWriterLayer                          */
+/************************************************************************/
+
+class OGRMVTWriterLayer final : public OGRLayer
+{
+    friend class OGRMVTWriterDataset;
+
+    OGRMVTWriterDataset *m_poDS = nullptr;
+    OGRFeatureDefn *m_poFeatureDefn = nullptr;
+    OGRCoordinateTransformation *m_poCT = nullptr;
+    GIntBig m_nSerial = 0;
+    int m_nMinZoom = 0;
+    int m_nMaxZoom = 5;
+    CPLString m_osTargetName;
+
+  public:
+    OGRMVTWriterLayer(OGRMVTWriterDataset *poDS, const char *pszLayerName,
+                      OGRSpatialReference *poSRS);
+    ~OGRMVTWriterLayer();
+
+    void ResetReading() override
+    {
+    }
+    OGRFeature *GetNextFeature() override
+    {
+        return nullptr;
+    }
+    OGRFeatureDefn *GetLayerDefn() override
+    {
+        return m_poFeatureDefn;
+    }
+    int TestCapability(const char *) override;
+    OGRErr ICreateFeature(OGRFeature *) override;
+    OGRErr CreateField(const OGRFieldDefn *, int) override;
+};
+
+/************************************************************************/
+/*                          OGRMVTWriterLayer()                         */
+/************************************************************************/
+
+OGRMVTWriterLayer::OGRMVTWriterLayer(OGRMVTWriterDataset *poDS,
+                                     const char *pszLayerName,
+                                     OGRSpatialReference *poSRSIn)
+{
+    m_poDS = poDS;
+    m_poFeatureDefn = new OGRFeatureDefn(pszLayerName);
+    SetDescription(m_poFeatureDefn->GetName());
+    m_poFeatureDefn->Reference();
+
+    m_poFeatureDefn->GetGeomFieldDefn(0)->SetSpatialRef(poDS->GetSRS());
+
+    if (poSRSIn != nullptr && !poDS->GetSRS()->IsSame(poSRSIn))
+    {
+        m_poCT = OGRCreateCoordinateTransformation(poSRSIn, poDS->GetSRS());
+        if (m_poCT == nullptr)
+        {
+            // If we can't create a transformation, issue a warning - but
+            // continue the transformation.
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Failed to create coordinate transformation between the "
+                     "input and target coordinate systems.");
+        }
+    }
+}
+
+/************************************************************************/
+/*                          ~OGRMVTWriterLayer()                        */
+/************************************************************************/
+
+OGRMVTWriterLayer::~OGRMVTWriterLayer()
+{
+    m_poFeatureDefn->Release();
+    delete m_poCT;
+}
+
+/************************************************************************/
+/*                            TestCapability()                          */
+/************************************************************************/
+
+int OGRMVTWriterLayer::TestCapability(const char *pszCap)
+{
+
+    if (EQUAL(pszCap, OLCSequentialWrite) || EQUAL(pszCap, OLCCreateField))
+        return true;
+    return false;
+}
+
+/************************************************************************/
+/*                            CreateField()                             */
+/************************************************************************/
+
+OGRErr OGRMVTWriterLayer::CreateField(const OGRFieldDefn *poFieldDefn, int)
+{
+    m_poFeatureDefn->AddFieldDefn(poFieldDefn);
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                            ICreateFeature()                          */
 /************************************************************************/
 
 OGRErr OGRMVTWriterLayer::ICreateFeature(OGRFeature *poFeature)
@@ -4230,6 +4892,24 @@ OGRErr OGRMVTWriterDataset::PreGenerateForTileReal(
     oBuffer.assign(static_cast<char *>(pCompressed), nCompressedSize);
     CPLFree(pCompressed);
 
+    if (m_poTempFeatureStore)
+    {
+        MVTTempFeature oTempFeature;
+        if (m_poTileWriter)
+            oTempFeature.nTileKey =
+                m_poTileWriter->GetTileOrderKey(nZ, nTileX, nTileY);
+        oTempFeature.nZ = nZ;
+        oTempFeature.nX = nTileX;
+        oTempFeature.nY = nTileY;
+        oTempFeature.osLayerName = osTargetName;
+        oTempFeature.nSerial = nSerial;
+        oTempFeature.dfAreaOrLength = dfAreaOrLength;
+        oTempFeature.osBlob = std::move(oBuffer);
+        return m_poTempFeatureStore->Add(std::move(oTempFeature))
+                   ? OGRERR_NONE
+                   : OGRERR_FAILURE;
+    }
+
     if (m_bThreadPoolOK)
         m_oDBMutex.lock();
 
@@ -4722,8 +5402,8 @@ void OGRMVTWriterDataset::EncodeFeature(
     std::shared_ptr<MVTTileLayer> poTargetLayer,
     std::map<CPLString, GUInt32> &oMapKeyToIdx,
     std::map<MVTTileLayerValue, GUInt32> &oMapValueToIdx,
-    MVTLayerProperties *poLayerProperties, GUInt32 nExtent,
-    unsigned &nFeaturesInTile)
+    MVTTileLayerStats *poLayerStats, GUInt32 nExtent,
+    unsigned &nFeaturesInTile) const
 {
     size_t nUncompressedSize = 0;
     void *pCompressed =
@@ -4745,9 +5425,9 @@ void OGRMVTWriterDataset::EncodeFeature(
             if (poSrcFeature->hasId())
                 poFeature->setId(poSrcFeature->getId());
             poFeature->setType(poSrcFeature->getType());
-            if (poLayerProperties)
+            if (poLayerStats)
             {
-                poLayerProperties->m_oCountGeomType[poSrcFeature->getType()]++;
+                poLayerStats->aeGeomTypes.push_back(poSrcFeature->getType());
             }
             bool bOK = true;
             if (nExtent < m_nExtent)
@@ -4821,10 +5501,10 @@ void OGRMVTWriterDataset::EncodeFeature(
                         auto &osKey = srcKeys[nSrcIdxKey];
                         auto &oValue = srcValues[nSrcIdxValue];
 
-                        if (poLayerProperties)
+                        if (poLayerStats)
                         {
-                            UpdateLayerProperties(poLayerProperties, osKey,
-                                                  oValue);
+                            poLayerStats->aoKeyValues.emplace_back(osKey,
+                                                                   oValue);
                         }
 
                         poFeature->addTag(oMapKeyToIdx[osKey]);
@@ -4847,34 +5527,17 @@ void OGRMVTWriterDataset::EncodeFeature(
 }
 
 /************************************************************************/
-/*                            EncodeTile()                              */
+/*                        ApplyTileLayerStats()                         */
 /************************************************************************/
 
-std::string OGRMVTWriterDataset::EncodeTile(
-    int nZ, int nX, int nY, sqlite3_stmt *hStmtLayer, sqlite3_stmt *hStmtRows,
+void OGRMVTWriterDataset::ApplyTileLayerStats(
+    int nZ, const std::vector<MVTTileLayerStats> &aoLayerStats,
     std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
-    std::set<CPLString> &oSetLayers, GIntBig &nTempTilesRead)
+    std::set<CPLString> &oSetLayers)
 {
-    MVTTile oTargetTile;
-
-    sqlite3_bind_int(hStmtLayer, 1, nZ);
-    sqlite3_bind_int(hStmtLayer, 2, nX);
-    sqlite3_bind_int(hStmtLayer, 3, nY);
-
-    unsigned nFeaturesInTile = 0;
-    const GIntBig nProgressStep =
-        std::max(static_cast<GIntBig>(1), m_nTempTiles / 10);
-
-    while (nFeaturesInTile < m_nMaxFeatures &&
-           sqlite3_step(hStmtLayer) == SQLITE_ROW)
+    for (const auto &oLayerStats : aoLayerStats)
     {
-        const char *pszLayerName =
-            reinterpret_cast<const char *>(sqlite3_column_text(hStmtLayer, 0));
-        sqlite3_bind_int(hStmtRows, 1, nZ);
-        sqlite3_bind_int(hStmtRows, 2, nX);
-        sqlite3_bind_int(hStmtRows, 3, nY);
-        sqlite3_bind_text(hStmtRows, 4, pszLayerName, -1, SQLITE_STATIC);
-
+        const char *pszLayerName = oLayerStats.osLayerName.c_str();
         auto oIterMapLayerProps = oMapLayerProps.find(pszLayerName);
         MVTLayerProperties *poLayerProperties = nullptr;
         if (oIterMapLayerProps == oMapLayerProps.end())
@@ -4902,40 +5565,67 @@ std::string OGRMVTWriterDataset::EncodeTile(
                 std::min(nZ, poLayerProperties->m_nMinZoom);
             poLayerProperties->m_nMaxZoom =
                 std::max(nZ, poLayerProperties->m_nMaxZoom);
+
+            for (const auto eGeomType : oLayerStats.aeGeomTypes)
+                poLayerProperties->m_oCountGeomType[eGeomType]++;
+            for (const auto &oKeyValue : oLayerStats.aoKeyValues)
+            {
+                UpdateLayerProperties(poLayerProperties, oKeyValue.first,
+                                      oKeyValue.second);
+            }
         }
+    }
+}
 
-        std::shared_ptr<MVTTileLayer> poTargetLayer(new MVTTileLayer());
-        oTargetTile.addLayer(poTargetLayer);
-        poTargetLayer->setName(pszLayerName);
-        poTargetLayer->setVersion(m_nMVTVersion);
-        poTargetLayer->setExtent(m_nExtent);
+/************************************************************************/
+/*                            EncodeTile()                              */
+/************************************************************************/
 
-        std::map<CPLString, GUInt32> oMapKeyToIdx;
-        std::map<MVTTileLayerValue, GUInt32> oMapValueToIdx;
+// Thread-safe. The layer properties are not updated directly, but through
+// aoLayerStats, so that they do not depend on the order in which tiles are
+// encoded.
+std::string
+OGRMVTWriterDataset::EncodeTile(int nZ, int nX, int nY,
+                                MVTTileFeatures &oTileFeatures,
+                                std::vector<MVTTileLayerStats> &aoLayerStats,
+                                unsigned &nFeaturesRead) const
+{
+    MVTTile oTargetTile;
 
-        while (nFeaturesInTile < m_nMaxFeatures &&
-               sqlite3_step(hStmtRows) == SQLITE_ROW)
-        {
-            int nBlobSize = sqlite3_column_bytes(hStmtRows, 0);
-            const void *pabyBlob = sqlite3_column_blob(hStmtRows, 0);
+    unsigned nFeaturesInTile = 0;
+    nFeaturesRead = 0;
 
-            EncodeFeature(pabyBlob, nBlobSize, poTargetLayer, oMapKeyToIdx,
-                          oMapValueToIdx, poLayerProperties, m_nExtent,
-                          nFeaturesInTile);
+    std::shared_ptr<MVTTileLayer> poTargetLayer;
+    std::map<CPLString, GUInt32> oMapKeyToIdx;
+    std::map<MVTTileLayerValue, GUInt32> oMapValueToIdx;
 
-            nTempTilesRead++;
-            if (nTempTilesRead == m_nTempTiles ||
-                (nTempTilesRead % nProgressStep) == 0)
+    oTileFeatures.ForEachFeature(
+        [&](const char *pszLayerName, const void *pabyBlob, int nBlobSize)
+        {
+            if (!poTargetLayer ||
+                aoLayerStats.back().osLayerName != pszLayerName)
             {
-                const int nPct =
-                    static_cast<int>((100 * nTempTilesRead) / m_nTempTiles);
-                CPLDebug("MVT", "%d%%...", nPct);
+                MVTTileLayerStats oLayerStats;
+                oLayerStats.osLayerName = pszLayerName;
+                aoLayerStats.push_back(std::move(oLayerStats));
+
+                poTargetLayer = std::make_shared<MVTTileLayer>();
+                oTargetTile.addLayer(poTargetLayer);
+                poTargetLayer->setName(pszLayerName);
+                poTargetLayer->setVersion(m_nMVTVersion);
+                poTargetLayer->setExtent(m_nExtent);
+
+                oMapKeyToIdx.clear();
+                oMapValueToIdx.clear();
             }
-        }
-        sqlite3_reset(hStmtRows);
-    }
 
-    sqlite3_reset(hStmtLayer);
+            EncodeFeature(pabyBlob, nBlobSize, poTargetLayer, oMapKeyToIdx,
+                          oMapValueToIdx, &aoLayerStats.back(), m_nExtent,
+                          nFeaturesInTile);
+            nFeaturesRead++;
+
+            return nFeaturesInTile < m_nMaxFeatures;
+        });
 
     std::string oTileBuffer(oTargetTile.write());
     size_t nSizeBefore = oTileBuffer.size();
@@ -4956,8 +5646,8 @@ std::string OGRMVTWriterDataset::EncodeTile(
     {
         nExtent /= 2;
         nSizeBefore = oTileBuffer.size();
-        oTileBuffer = RecodeTileLowerResolution(nZ, nX, nY, nExtent, hStmtLayer,
-                                                hStmtRows);
+        oTileBuffer =
+            RecodeTileLowerResolution(nZ, nX, nY, nExtent, oTileFeatures);
         bTooBigTile = oTileBuffer.size() > m_nMaxTileSize;
         CPLDebug("MVT",
                  "Recoding tile %d/%d/%d with extent = %u. "
@@ -4985,17 +5675,6 @@ std::string OGRMVTWriterDataset::EncodeTile(
 
         const unsigned nTotalFeaturesInTile =
             std::min(m_nMaxFeatures, nFeaturesInTile);
-        char *pszSQL =
-            sqlite3_mprintf("SELECT layer, feature FROM temp "
-                            "WHERE z = %d AND x = %d AND y = %d ORDER BY "
-                            "area_or_length DESC LIMIT %d",
-                            nZ, nX, nY, nTotalFeaturesInTile);
-        sqlite3_stmt *hTmpStmt = nullptr;
-        CPL_IGNORE_RET_VAL(
-            sqlite3_prepare_v2(m_hDB, pszSQL, -1, &hTmpStmt, nullptr));
-        sqlite3_free(pszSQL);
-        if (!hTmpStmt)
-            return std::string();
 
         class TargetTileLayerProps
         {
@@ -5009,51 +5688,57 @@ std::string OGRMVTWriterDataset::EncodeTile(
 
         nFeaturesInTile = 0;
         const unsigned nCheckStep = std::max(1U, nTotalFeaturesInTile / 100);
-        while (sqlite3_step(hTmpStmt) == SQLITE_ROW)
-        {
-            const char *pszLayerName = reinterpret_cast<const char *>(
-                sqlite3_column_text(hTmpStmt, 0));
-            int nBlobSize = sqlite3_column_bytes(hTmpStmt, 1);
-            const void *pabyBlob = sqlite3_column_blob(hTmpStmt, 1);
-
-            std::shared_ptr<MVTTileLayer> poTargetLayer;
-            std::map<CPLString, GUInt32> *poMapKeyToIdx;
-            std::map<MVTTileLayerValue, GUInt32> *poMapValueToIdx;
-            auto oIter = oMapLayerNameToTargetLayer.find(pszLayerName);
-            if (oIter == oMapLayerNameToTargetLayer.end())
-            {
-                poTargetLayer =
-                    std::shared_ptr<MVTTileLayer>(new MVTTileLayer());
-                TargetTileLayerProps props;
-                props.m_poLayer = poTargetLayer;
-                oTargetTile.addLayer(poTargetLayer);
-                poTargetLayer->setName(pszLayerName);
-                poTargetLayer->setVersion(m_nMVTVersion);
-                poTargetLayer->setExtent(nExtent);
-                oMapLayerNameToTargetLayer[pszLayerName] = props;
-                poMapKeyToIdx =
-                    &oMapLayerNameToTargetLayer[pszLayerName].m_oMapKeyToIdx;
-                poMapValueToIdx =
-                    &oMapLayerNameToTargetLayer[pszLayerName].m_oMapValueToIdx;
-            }
-            else
-            {
-                poTargetLayer = oIter->second.m_poLayer;
-                poMapKeyToIdx = &oIter->second.m_oMapKeyToIdx;
-                poMapValueToIdx = &oIter->second.m_oMapValueToIdx;
-            }
+        if (!oTileFeatures.ForEachFeatureByDecreasingAreaOrLength(
+                nTotalFeaturesInTile,
+                [&](const char *pszLayerName, const void *pabyBlob,
+                    int nBlobSize)
+                {
+                    std::shared_ptr<MVTTileLayer> poTargetLayerByArea;
+                    std::map<CPLString, GUInt32> *poMapKeyToIdx;
+                    std::map<MVTTileLayerValue, GUInt32> *poMapValueToIdx;
+                    auto oIter = oMapLayerNameToTargetLayer.find(pszLayerName);
+                    if (oIter == oMapLayerNameToTargetLayer.end())
+                    {
+                        poTargetLayerByArea =
+                            std::shared_ptr<MVTTileLayer>(new MVTTileLayer());
+                        TargetTileLayerProps props;
+                        props.m_poLayer = poTargetLayerByArea;
+                        oTargetTile.addLayer(poTargetLayerByArea);
+                        poTargetLayerByArea->setName(pszLayerName);
+                        poTargetLayerByArea->setVersion(m_nMVTVersion);
+                        poTargetLayerByArea->setExtent(nExtent);
+                        oMapLayerNameToTargetLayer[pszLayerName] = props;
+                        poMapKeyToIdx =
+                            &oMapLayerNameToTargetLayer[pszLayerName]
+                                 .m_oMapKeyToIdx;
+                        poMapValueToIdx =
+                            &oMapLayerNameToTargetLayer[pszLayerName]
+                                 .m_oMapValueToIdx;
+                    }
+                    else
+                    {
+                        poTargetLayerByArea = oIter->second.m_poLayer;
+                        poMapKeyToIdx = &oIter->second.m_oMapKeyToIdx;
+                        poMapValueToIdx = &oIter->second.m_oMapValueToIdx;
+                    }
 
-            EncodeFeature(pabyBlob, nBlobSize, poTargetLayer, *poMapKeyToIdx,
-                          *poMapValueToIdx, nullptr, nExtent, nFeaturesInTile);
+                    EncodeFeature(pabyBlob, nBlobSize, poTargetLayerByArea,
+                                  *poMapKeyToIdx, *poMapValueToIdx, nullptr,
+                                  nExtent, nFeaturesInTile);
 
-            if (nFeaturesInTile == nTotalFeaturesInTile ||
-                (bTooBigTile && (nFeaturesInTile % nCheckStep == 0)))
-            {
-                if (oTargetTile.getSize() * dfCompressionRatio > m_nMaxTileSize)
-                {
-                    break;
-                }
-            }
+                    if (nFeaturesInTile == nTotalFeaturesInTile ||
+                        (bTooBigTile && (nFeaturesInTile % nCheckStep == 0)))
+                    {
+                        if (oTargetTile.getSize() * dfCompressionRatio >
+                            m_nMaxTileSize)
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }))
+        {
+            return std::string();
         }
 
         oTileBuffer = oTargetTile.write();
@@ -5065,8 +5750,6 @@ std::string OGRMVTWriterDataset::EncodeTile(
             CPLDebug("MVT", "For tile %d/%d/%d, final tile size is %u", nZ, nX,
                      nY, static_cast<unsigned>(oTileBuffer.size()));
         }
-
-        sqlite3_finalize(hTmpStmt);
     }
 
     return oTileBuffer;
@@ -5077,48 +5760,38 @@ std::string OGRMVTWriterDataset::EncodeTile(
 /************************************************************************/
 
 std::string OGRMVTWriterDataset::RecodeTileLowerResolution(
-    int nZ, int nX, int nY, int nExtent, sqlite3_stmt *hStmtLayer,
-    sqlite3_stmt *hStmtRows)
+    int /* nZ */, int /* nX */, int /* nY */, int nExtent,
+    MVTTileFeatures &oTileFeatures) const
 {
     MVTTile oTargetTile;
 
-    sqlite3_bind_int(hStmtLayer, 1, nZ);
-    sqlite3_bind_int(hStmtLayer, 2, nX);
-    sqlite3_bind_int(hStmtLayer, 3, nY);
-
     unsigned nFeaturesInTile = 0;
-    while (nFeaturesInTile < m_nMaxFeatures &&
-           sqlite3_step(hStmtLayer) == SQLITE_ROW)
-    {
-        const char *pszLayerName =
-            reinterpret_cast<const char *>(sqlite3_column_text(hStmtLayer, 0));
-        sqlite3_bind_int(hStmtRows, 1, nZ);
-        sqlite3_bind_int(hStmtRows, 2, nX);
-        sqlite3_bind_int(hStmtRows, 3, nY);
-        sqlite3_bind_text(hStmtRows, 4, pszLayerName, -1, SQLITE_STATIC);
+    std::string osCurLayerName;
+    std::shared_ptr<MVTTileLayer> poTargetLayer;
+    std::map<CPLString, GUInt32> oMapKeyToIdx;
+    std::map<MVTTileLayerValue, GUInt32> oMapValueToIdx;
 
-        std::shared_ptr<MVTTileLayer> poTargetLayer(new MVTTileLayer());
-        oTargetTile.addLayer(poTargetLayer);
-        poTargetLayer->setName(pszLayerName);
-        poTargetLayer->setVersion(m_nMVTVersion);
-        poTargetLayer->setExtent(nExtent);
-
-        std::map<CPLString, GUInt32> oMapKeyToIdx;
-        std::map<MVTTileLayerValue, GUInt32> oMapValueToIdx;
-
-        while (nFeaturesInTile < m_nMaxFeatures &&
-               sqlite3_step(hStmtRows) == SQLITE_ROW)
+    oTileFeatures.ForEachFeature(
+        [&](const char *pszLayerName, const void *pabyBlob, int nBlobSize)
         {
-            int nBlobSize = sqlite3_column_bytes(hStmtRows, 0);
-            const void *pabyBlob = sqlite3_column_blob(hStmtRows, 0);
+            if (!poTargetLayer || osCurLayerName != pszLayerName)
+            {
+                osCurLayerName = pszLayerName;
+                poTargetLayer = std::make_shared<MVTTileLayer>();
+                oTargetTile.addLayer(poTargetLayer);
+                poTargetLayer->setName(pszLayerName);
+                poTargetLayer->setVersion(m_nMVTVersion);
+                poTargetLayer->setExtent(nExtent);
+
+                oMapKeyToIdx.clear();
+                oMapValueToIdx.clear();
+            }
 
             EncodeFeature(pabyBlob, nBlobSize, poTargetLayer, oMapKeyToIdx,
                           oMapValueToIdx, nullptr, nExtent, nFeaturesInTile);
-        }
-        sqlite3_reset(hStmtRows);
-    }
 
-    sqlite3_reset(hStmtLayer);
+            return nFeaturesInTile < m_nMaxFeatures;
+        });
 
     std::string oTileBuffer(oTargetTile.write());
     if (m_bGZip)
@@ -5128,22 +5801,104 @@ std::string OGRMVTWriterDataset::RecodeTileLowerResolution(
 }
 
 /************************************************************************/
-/*                            CreateOutput()                            */
+/*                          ReportProgress()                            */
 /************************************************************************/
 
-bool OGRMVTWriterDataset::CreateOutput()
+void OGRMVTWriterDataset::ReportProgress(GIntBig &nTempTilesRead,
+                                         unsigned nFeaturesRead) const
 {
-    if (m_bThreadPoolOK)
-        m_oThreadPool.WaitCompletion();
+    const GIntBig nProgressStep =
+        std::max(static_cast<GIntBig>(1), m_nTempTiles / 10);
+    const GIntBig nTempTilesReadBefore = nTempTilesRead;
+    nTempTilesRead += nFeaturesRead;
+    if (nTempTilesRead == m_nTempTiles ||
+        nTempTilesRead / nProgressStep != nTempTilesReadBefore / nProgressStep)
+    {
+        const int nPct =
+            static_cast<int>((100 * nTempTilesRead) / m_nTempTiles);
+        CPLDebug("MVT", "%d%%...", nPct);
+    }
+}
 
-    std::map<CPLString, MVTLayerProperties> oMapLayerProps;
-    std::set<CPLString> oSetLayers;
+/************************************************************************/
+/*                             WriteTile()                              */
+/************************************************************************/
 
-    if (!m_oEnvelope.IsInit())
+bool OGRMVTWriterDataset::WriteTile(int nZ, int nX, int nY,
+                                    const std::string &oTileBuffer,
+                                    sqlite3_stmt *hInsertStmt, int &nLastZ,
+                                    int &nLastX)
+{
+    bool bRet = true;
+    if (oTileBuffer.empty())
     {
-        return GenerateMetadata(0, oMapLayerProps);
+        bRet = false;
+    }
+    else if (m_poTileWriter)
+    {
+        bRet = m_poTileWriter->WriteTile(nZ, nX, nY, oTileBuffer);
+    }
+    else if (hInsertStmt)
+    {
+        sqlite3_bind_int(hInsertStmt, 1, nZ);
+        sqlite3_bind_int(hInsertStmt, 2, nX);
+        sqlite3_bind_int(hInsertStmt, 3, (1 << nZ) - 1 - nY);
+        sqlite3_bind_blob(hInsertStmt, 4, oTileBuffer.data(),
+                          static_cast<int>(oTileBuffer.size()), SQLITE_STATIC);
+        const int rc = sqlite3_step(hInsertStmt);
+        bRet = (rc == SQLITE_OK || rc == SQLITE_DONE);
+        sqlite3_reset(hInsertStmt);
+    }
+    else
+    {
+        CPLString osZDirname(CPLFormFilename(
+            GetDescription(), CPLSPrintf("%d", nZ), nullptr));
+        CPLString osXDirname(
+            CPLFormFilename(osZDirname, CPLSPrintf("%d", nX), nullptr));
+        if (nZ != nLastZ)
+        {
+            VSIMkdir(osZDirname, 0755);
+            nLastZ = nZ;
+            nLastX = -1;
+        }
+        if (nX != nLastX)
+        {
+            VSIMkdir(osXDirname, 0755);
+            nLastX = nX;
+        }
+        CPLString osTileFilename(CPLFormFilename(
+            osXDirname, CPLSPrintf("%d", nY), m_osExtension.c_str()));
+        VSILFILE *fpOut = VSIFOpenL(osTileFilename, "wb");
+        if (fpOut)
+        {
+            const size_t nRet =
+                VSIFWriteL(oTileBuffer.data(), 1, oTileBuffer.size(), fpOut);
+            bRet = (nRet == oTileBuffer.size());
+            VSIFCloseL(fpOut);
+        }
+        else
+        {
+            bRet = false;
+        }
+    }
+
+    if (!bRet)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Error while writing tile %d/%d/%d", nZ, nX, nY);
     }
+    return bRet;
+}
+
+/************************************************************************/
+/*                        WriteTilesFromTempDB()                        */
+/************************************************************************/
 
+bool OGRMVTWriterDataset::WriteTilesFromTempDB(
+    sqlite3_stmt *hInsertStmt,
+    std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
+    std::set<CPLString> &oSetLayers)
+{
     CPLDebug("MVT", "Building output file from temporary database...");
 
     sqlite3_stmt *hStmtZXY = nullptr;
@@ -5182,98 +5937,256 @@ bool OGRMVTWriterDataset::CreateOutput()
         return false;
     }
 
-    sqlite3_stmt *hInsertStmt = nullptr;
-    if (m_hDBMBTILES)
+    int nLastZ = -1;
+    int nLastX = -1;
+    GIntBig nTempTilesRead = 0;
+
+    const auto ProcessTile = [&](int nZ, int nX, int nY)
     {
-        CPL_IGNORE_RET_VAL(sqlite3_prepare_v2(
-            m_hDBMBTILES,
-            "INSERT INTO tiles(zoom_level, tile_column, tile_row, "
-            "tile_data) VALUES (?,?,?,?)",
-            -1, &hInsertStmt, nullptr));
-        if (hInsertStmt == nullptr)
+        MVTTempDBTileFeatures oTileFeatures(m_hDB, hStmtLayer, hStmtRows, nZ,
+                                            nX, nY);
+        std::vector<MVTTileLayerStats> aoLayerStats;
+        unsigned nFeaturesRead = 0;
+        std::string oTileBuffer(EncodeTile(nZ, nX, nY, oTileFeatures,
+                                           aoLayerStats, nFeaturesRead));
+        ApplyTileLayerStats(nZ, aoLayerStats, oMapLayerProps, oSetLayers);
+        ReportProgress(nTempTilesRead, nFeaturesRead);
+
+        return WriteTile(nZ, nX, nY, oTileBuffer, hInsertStmt, nLastZ, nLastX);
+    };
+
+    bool bRet = true;
+    if (m_poTileWriter)
+    {
+        // Tiles must be processed in the order requested by the tile writer
+        struct TileCoords
         {
-            CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
-            sqlite3_finalize(hStmtZXY);
-            sqlite3_finalize(hStmtLayer);
-            sqlite3_finalize(hStmtRows);
-            return false;
+            GUIntBig nKey;
+            int nZ;
+            int nX;
+            int nY;
+        };
+        std::vector<TileCoords> asTiles;
+        while (sqlite3_step(hStmtZXY) == SQLITE_ROW)
+        {
+            TileCoords sTile;
+            sTile.nZ = sqlite3_column_int(hStmtZXY, 0);
+            sTile.nX = sqlite3_column_int(hStmtZXY, 1);
+            sTile.nY = sqlite3_column_int(hStmtZXY, 2);
+            sTile.nKey =
+                m_poTileWriter->GetTileOrderKey(sTile.nZ, sTile.nX, sTile.nY);
+            asTiles.push_back(sTile);
+        }
+        std::sort(asTiles.begin(), asTiles.end(),
+                  [](const TileCoords &a, const TileCoords &b)
+                  {
+                      return std::tie(a.nKey, a.nZ, a.nX, a.nY) <
+                             std::tie(b.nKey, b.nZ, b.nX, b.nY);
+                  });
+        for (const auto &sTile : asTiles)
+        {
+            bRet = ProcessTile(sTile.nZ, sTile.nX, sTile.nY);
+            if (!bRet)
+                break;
         }
     }
+    else
+    {
+        while (sqlite3_step(hStmtZXY) == SQLITE_ROW)
+        {
+            bRet = ProcessTile(sqlite3_column_int(hStmtZXY, 0),
+                               sqlite3_column_int(hStmtZXY, 1),
+                               sqlite3_column_int(hStmtZXY, 2));
+            if (!bRet)
+                break;
+        }
+    }
+    sqlite3_finalize(hStmtZXY);
+    sqlite3_finalize(hStmtLayer);
+    sqlite3_finalize(hStmtRows);
+
+    return bRet;
+}
+
+/************************************************************************/
+/*                         EncodeTileTaskFunc()                         */
+/************************************************************************/
+
+struct OGRMVTWriterDataset::MVTTileEncodingTask
+{
+    int nZ = 0;
+    int nX = 0;
+    int nY = 0;
+    std::unique_ptr<MVTTempFilesTileFeatures> poTileFeatures{};
+    std::string osTileBuffer{};
+    std::vector<MVTTileLayerStats> aoLayerStats{};
+    unsigned nFeaturesRead = 0;
+    const OGRMVTWriterDataset *poDS = nullptr;
+    std::promise<void> oDone{};
+};
+
+void OGRMVTWriterDataset::EncodeTileTaskFunc(void *pParam)
+{
+    auto poTask = static_cast<MVTTileEncodingTask *>(pParam);
+    poTask->osTileBuffer = poTask->poDS->EncodeTile(
+        poTask->nZ, poTask->nX, poTask->nY, *(poTask->poTileFeatures),
+        poTask->aoLayerStats, poTask->nFeaturesRead);
+    // Free the features as soon as possible
+    poTask->poTileFeatures.reset();
+    poTask->oDone.set_value();
+}
+
+/************************************************************************/
+/*                       WriteTilesFromTempFiles()                      */
+/************************************************************************/
+
+// Tiles are assembled from the features merged from the sorted runs of
+// m_poTempFeatureStore. When the thread pool is available, tiles are encoded
+// by worker threads, and written in order by the current thread.
+bool OGRMVTWriterDataset::WriteTilesFromTempFiles(
+    sqlite3_stmt *hInsertStmt,
+    std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
+    std::set<CPLString> &oSetLayers)
+{
+    CPLDebug("MVT", "Building output file from temporary files...");
+
+    if (!m_poTempFeatureStore->StartReading())
+        return false;
 
     int nLastZ = -1;
     int nLastX = -1;
     bool bRet = true;
     GIntBig nTempTilesRead = 0;
 
-    while (sqlite3_step(hStmtZXY) == SQLITE_ROW)
-    {
-        int nZ = sqlite3_column_int(hStmtZXY, 0);
-        int nX = sqlite3_column_int(hStmtZXY, 1);
-        int nY = sqlite3_column_int(hStmtZXY, 2);
+    // Tasks being processed, in tile order
+    std::deque<std::unique_ptr<MVTTileEncodingTask>> apoTasks;
+    const size_t nMaxTasks =
+        m_bThreadPoolOK
+            ? 2 * static_cast<size_t>(m_oThreadPool.GetThreadCount())
+            : 0;
+
+    const auto WriteNextTile = [&]()
+    {
+        auto poTask = std::move(apoTasks.front());
+        apoTasks.pop_front();
+        if (m_bThreadPoolOK)
+            poTask->oDone.get_future().wait();
+        ApplyTileLayerStats(poTask->nZ, poTask->aoLayerStats, oMapLayerProps,
+                            oSetLayers);
+        ReportProgress(nTempTilesRead, poTask->nFeaturesRead);
+        return WriteTile(poTask->nZ, poTask->nX, poTask->nY,
+                         poTask->osTileBuffer, hInsertStmt, nLastZ, nLastX);
+    };
 
-        std::string oTileBuffer(EncodeTile(nZ, nX, nY, hStmtLayer, hStmtRows,
-                                           oMapLayerProps, oSetLayers,
-                                           nTempTilesRead));
+    const auto SubmitTile = [&](std::unique_ptr<MVTTileEncodingTask> poTask)
+    {
+        if (m_bThreadPoolOK)
+        {
+            if (!m_oThreadPool.SubmitJob(EncodeTileTaskFunc, poTask.get()))
+                EncodeTileTaskFunc(poTask.get());
+            apoTasks.push_back(std::move(poTask));
+            if (apoTasks.size() <= nMaxTasks)
+                return true;
+        }
+        else
+        {
+            EncodeTileTaskFunc(poTask.get());
+            apoTasks.push_back(std::move(poTask));
+        }
+        return WriteNextTile();
+    };
 
-        if (oTileBuffer.empty())
+    std::unique_ptr<MVTTileEncodingTask> poTask;
+    while (bRet)
+    {
+        auto poFeature = m_poTempFeatureStore->GetNext();
+        if (poTask && (!poFeature || poFeature->nZ != poTask->nZ ||
+                       poFeature->nX != poTask->nX ||
+                       poFeature->nY != poTask->nY))
         {
-            bRet = false;
+            bRet = SubmitTile(std::move(poTask));
         }
-        else if (hInsertStmt)
+        if (!poFeature)
+            break;
+        if (!poTask)
         {
-            sqlite3_bind_int(hInsertStmt, 1, nZ);
-            sqlite3_bind_int(hInsertStmt, 2, nX);
-            sqlite3_bind_int(hInsertStmt, 3, (1 << nZ) - 1 - nY);
-            sqlite3_bind_blob(hInsertStmt, 4, oTileBuffer.data(),
-                              static_cast<int>(oTileBuffer.size()),
-                              SQLITE_STATIC);
-            const int rc = sqlite3_step(hInsertStmt);
-            bRet = (rc == SQLITE_OK || rc == SQLITE_DONE);
-            sqlite3_reset(hInsertStmt);
+            poTask = std::make_unique<MVTTileEncodingTask>();
+            poTask->nZ = poFeature->nZ;
+            poTask->nX = poFeature->nX;
+            poTask->nY = poFeature->nY;
+            poTask->poTileFeatures =
+                std::make_unique<MVTTempFilesTileFeatures>(m_nMaxFeatures);
+            poTask->poDS = this;
         }
+        poTask->poTileFeatures->Add(poFeature);
+    }
+
+    // Wait for pending tasks, even in case of error, as they reference
+    // objects of this function
+    while (!apoTasks.empty())
+    {
+        if (bRet)
+            bRet = WriteNextTile();
         else
         {
-            CPLString osZDirname(CPLFormFilename(
-                GetDescription(), CPLSPrintf("%d", nZ), nullptr));
-            CPLString osXDirname(
-                CPLFormFilename(osZDirname, CPLSPrintf("%d", nX), nullptr));
-            if (nZ != nLastZ)
-            {
-                VSIMkdir(osZDirname, 0755);
-                nLastZ = nZ;
-                nLastX = -1;
-            }
-            if (nX != nLastX)
-            {
-                VSIMkdir(osXDirname, 0755);
-                nLastX = nX;
-            }
-            CPLString osTileFilename(CPLFormFilename(
-                osXDirname, CPLSPrintf("%d", nY), m_osExtension.c_str()));
-            VSILFILE *fpOut = VSIFOpenL(osTileFilename, "wb");
-            if (fpOut)
-            {
-                const size_t nRet = VSIFWriteL(oTileBuffer.data(), 1,
-                                               oTileBuffer.size(), fpOut);
-                bRet = (nRet == oTileBuffer.size());
-                VSIFCloseL(fpOut);
-            }
-            else
-            {
-                bRet = false;
-            }
+            apoTasks.front()->oDone.get_future().wait();
+            apoTasks.pop_front();
         }
+    }
+
+    if (m_poTempFeatureStore->HasError())
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Error while reading features from temporary file");
+        bRet = false;
+    }
+
+    return bRet;
+}
+
+/************************************************************************/
+/*                            CreateOutput()                            */
+/************************************************************************/
+
+bool OGRMVTWriterDataset::CreateOutput()
+{
+    if (m_bThreadPoolOK)
+        m_oThreadPool.WaitCompletion();
+
+    std::map<CPLString, MVTLayerProperties> oMapLayerProps;
+    std::set<CPLString> oSetLayers;
+
+    if (!m_oEnvelope.IsInit())
+    {
+        return GenerateMetadata(0, oMapLayerProps);
+    }
+
+    if (m_poTempFeatureStore)
+    {
+        m_nTempTiles =
+            static_cast<GIntBig>(m_poTempFeatureStore->GetFeatureCount());
+    }
 
-        if (!bRet)
+    sqlite3_stmt *hInsertStmt = nullptr;
+    if (m_hDBMBTILES)
+    {
+        CPL_IGNORE_RET_VAL(sqlite3_prepare_v2(
+            m_hDBMBTILES,
+            "INSERT INTO tiles(zoom_level, tile_column, tile_row, "
+            "tile_data) VALUES (?,?,?,?)",
+            -1, &hInsertStmt, nullptr));
+        if (hInsertStmt == nullptr)
         {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Error while writing tile %d/%d/%d", nZ, nX, nY);
-            break;
+            CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
+            return false;
         }
     }
-    sqlite3_finalize(hStmtZXY);
-    sqlite3_finalize(hStmtLayer);
-    sqlite3_finalize(hStmtRows);
+
+    bool bRet =
+        m_poTempFeatureStore
+            ? WriteTilesFromTempFiles(hInsertStmt, oMapLayerProps, oSetLayers)
+            : WriteTilesFromTempDB(hInsertStmt, oMapLayerProps, oSetLayers);
+
     if (hInsertStmt)
         sqlite3_finalize(hInsertStmt);
 
@@ -5636,6 +6549,26 @@ bool OGRMVTWriterDataset::GenerateMetadata(
     WriteMetadataItem("json", oJsonDoc.SaveAsString().c_str(), m_hDBMBTILES,
                       oRoot);
 
+    if (m_poTileWriter)
+    {
+        // Same items as in the MBTiles metadata table, but with the content
+        // of the 'json' item expanded
+        CPLJSONObject oMetadata;
+        for (const auto &oChild : oRoot.GetChildren())
+        {
+            if (oChild.GetName() == "json")
+            {
+                for (const auto &oJsonChild : oJsonRoot.GetChildren())
+                    oMetadata.Add(oJsonChild.GetName(), oJsonChild);
+            }
+            else
+            {
+                oMetadata.Add(oChild.GetName(), oChild.ToString());
+            }
+        }
+        return m_poTileWriter->Finalize(oMetadata);
+    }
+
     if (m_hDBMBTILES)
     {
         return true;
@@ -5906,13 +6839,21 @@ GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename, int nXSize,
         return nullptr;
     }
 
+    return Create(pszFilename, papszOptions, nullptr);
+}
+
+GDALDataset *
+OGRMVTWriterDataset::Create(const char *pszFilename, char **papszOptions,
+                            std::unique_ptr<OGRMVTTileWriter> poTileWriter)
+{
     const char *pszFormat = CSLFetchNameValue(papszOptions, "FORMAT");
     const bool bMBTILESExt = EQUAL(CPLGetExtension(pszFilename), "mbtiles");
     if (pszFormat == nullptr && bMBTILESExt)
     {
         pszFormat = "MBTILES";
     }
-    const bool bMBTILES = pszFormat != nullptr && EQUAL(pszFormat, "MBTILES");
+    const bool bMBTILES = poTileWriter == nullptr && pszFormat != nullptr &&
+                          EQUAL(pszFormat, "MBTILES");
 
     // For debug only
     bool bReuseTempFile =
@@ -5929,7 +6870,7 @@ GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename, int nXSize,
 
         VSIUnlink(pszFilename);
     }
-    else
+    else if (poTileWriter == nullptr)
     {
         VSIStatBufL sStat;
         if (VSIStatL(pszFilename, &sStat) == 0)
@@ -5947,6 +6888,7 @@ GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename, int nXSize,
     }
 
     OGRMVTWriterDataset *poDS = new OGRMVTWriterDataset();
+    poDS->m_poTileWriter = std::move(poTileWriter);
     poDS->m_pMyVFS = OGRSQLiteCreateVFS(nullptr, poDS);
     sqlite3_vfs_register(poDS->m_pMyVFS, 0);
 
@@ -5958,64 +6900,98 @@ GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename, int nXSize,
     }
     CPLString osTempDB = CSLFetchNameValueDef(papszOptions, "TEMPORARY_DB",
                                               osTempDBDefault.c_str());
-    if (!bReuseTempFile)
-        VSIUnlink(osTempDB);
-
-    sqlite3 *hDB = nullptr;
-    if (sqlite3_open_v2(osTempDB, &hDB,
-                        SQLITE_OPEN_READWRITE |
-                            (bReuseTempFile ? 0 : SQLITE_OPEN_CREATE) |
-                            SQLITE_OPEN_NOMUTEX,
-                        poDS->m_pMyVFS->zName) != SQLITE_OK ||
-        hDB == nullptr)
-    {
-        CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s", osTempDB.c_str());
-        delete poDS;
-        sqlite3_close(hDB);
-        return nullptr;
-    }
-    poDS->m_osTempDB = osTempDB;
-    poDS->m_hDB = hDB;
-    poDS->m_bReuseTempFile = bReuseTempFile;
-
-    // For Unix
-    if (!poDS->m_bReuseTempFile &&
-        CPLTestBool(CPLGetConfigOption("OGR_MVT_REMOVE_TEMP_FILE", "YES")))
+    const char *pszTempStorage =
+        CSLFetchNameValueDef(papszOptions, "TEMPORARY_STORAGE", "SQLITE");
+    if (EQUAL(pszTempStorage, "FILES"))
     {
-        VSIUnlink(osTempDB);
-    }
+        if (bReuseTempFile)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "OGR_MVT_REUSE_TEMP_FILE=YES is not compatible with "
+                     "TEMPORARY_STORAGE=FILES");
+            delete poDS;
+            return nullptr;
+        }
 
-    if (poDS->m_bReuseTempFile)
-    {
-        poDS->m_nTempTiles =
-            SQLGetInteger64(hDB, "SELECT COUNT(*) FROM temp", nullptr);
+        // Default to 10% of the RAM for the features accumulated before
+        // being spilled as a sorted run
+        const char *pszSortMaxRAM =
+            CPLGetConfigOption("OGR_MVT_SORT_MAX_RAM", nullptr);
+        const double dfMaxRAM =
+            pszSortMaxRAM
+                ? CPLAtof(pszSortMaxRAM) * 1024 * 1024
+                : std::max(static_cast<double>(CPLGetUsablePhysicalRAM()) / 10,
+                           64.0 * 1024 * 1024);
+        poDS->m_poTempFeatureStore = std::make_unique<MVTTempFeatureStore>(
+            osTempDB,
+            static_cast<size_t>(std::max(
+                0.0, std::min(dfMaxRAM,
+                              static_cast<double>(
+                                  std::numeric_limits<size_t>::max() / 2)))));
     }
     else
     {
-        CPL_IGNORE_RET_VAL(SQLCommand(
-            hDB,
-            "PRAGMA page_size = 4096;"  // 4096: default since sqlite 3.12
-            "PRAGMA synchronous = OFF;"
-            "PRAGMA journal_mode = OFF;"
-            "PRAGMA temp_store = MEMORY;"
-            "CREATE TABLE temp(z INTEGER, x INTEGER, y INTEGER, layer TEXT, "
-            "idx INTEGER, feature BLOB, geomtype INTEGER, area_or_length "
-            "DOUBLE);"
-            "CREATE INDEX temp_index ON temp (z, x, y, layer, idx);"));
-    }
+        if (!bReuseTempFile)
+            VSIUnlink(osTempDB);
 
-    sqlite3_stmt *hInsertStmt = nullptr;
-    CPL_IGNORE_RET_VAL(sqlite3_prepare_v2(
-        hDB,
-        "INSERT INTO temp (z,x,y,layer,idx,feature,geomtype,area_or_length) "
-        "VALUES (?,?,?,?,?,?,?,?)",
-        -1, &hInsertStmt, nullptr));
-    if (hInsertStmt == nullptr)
-    {
-        delete poDS;
-        return nullptr;
+        sqlite3 *hDB = nullptr;
+        if (sqlite3_open_v2(osTempDB, &hDB,
+                            SQLITE_OPEN_READWRITE |
+                                (bReuseTempFile ? 0 : SQLITE_OPEN_CREATE) |
+                                SQLITE_OPEN_NOMUTEX,
+                            poDS->m_pMyVFS->zName) != SQLITE_OK ||
+            hDB == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                     osTempDB.c_str());
+            delete poDS;
+            sqlite3_close(hDB);
+            return nullptr;
+        }
+        poDS->m_osTempDB = osTempDB;
+        poDS->m_hDB = hDB;
+        poDS->m_bReuseTempFile = bReuseTempFile;
+
+        // For Unix
+        if (!poDS->m_bReuseTempFile &&
+            CPLTestBool(CPLGetConfigOption("OGR_MVT_REMOVE_TEMP_FILE", "YES")))
+        {
+            VSIUnlink(osTempDB);
+        }
+
+        if (poDS->m_bReuseTempFile)
+        {
+            poDS->m_nTempTiles =
+                SQLGetInteger64(hDB, "SELECT COUNT(*) FROM temp", nullptr);
+        }
+        else
+        {
+            CPL_IGNORE_RET_VAL(SQLCommand(
+                hDB,
+                "PRAGMA page_size = 4096;"  // 4096: default since sqlite 3.12
+                "PRAGMA synchronous = OFF;"
+                "PRAGMA journal_mode = OFF;"
+                "PRAGMA temp_store = MEMORY;"
+                "CREATE TABLE temp(z INTEGER, x INTEGER, y INTEGER, "
+                "layer TEXT, idx INTEGER, feature BLOB, geomtype INTEGER, "
+                "area_or_length DOUBLE);"
+                "CREATE INDEX temp_index ON temp (z, x, y, layer, idx);"));
+        }
+
+        sqlite3_stmt *hInsertStmt = nullptr;
+        CPL_IGNORE_RET_VAL(sqlite3_prepare_v2(
+            hDB,
+            "INSERT INTO temp "
+            "(z,x,y,layer,idx,feature,geomtype,area_or_length) "
+            "VALUES (?,?,?,?,?,?,?,?)",
+            -1, &hInsertStmt, nullptr));
+        if (hInsertStmt == nullptr)
+        {
+            delete poDS;
+            return nullptr;
+        }
+        poDS->m_hInsertStmt = hInsertStmt;
     }
-    poDS->m_hInsertStmt = hInsertStmt;
 
     poDS->m_nMinZoom = atoi(CSLFetchNameValueDef(
         papszOptions, "MINZOOM", CPLSPrintf("%d", poDS->m_nMinZoom)));
@@ -6082,10 +7058,11 @@ GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename, int nXSize,
         CSLFetchNameValue(papszOptions, "TILING_SCHEME");
     if (pszTilingScheme)
     {
-        if (bMBTILES)
+        if (bMBTILES || poDS->m_poTileWriter)
         {
             CPLError(CE_Failure, CPLE_NotSupported,
-                     "Custom TILING_SCHEME not supported with MBTILES output");
+                     "Custom TILING_SCHEME not supported with %s output",
+                     bMBTILES ? "MBTILES" : "this");
             delete poDS;
             return nullptr;
         }
@@ -6162,6 +7139,20 @@ GDALDataset *OGRMVTWriterDatasetCreate(const char *pszFilename, int nXSize,
                                        eDT, papszOptions);
 }
 
+GDALDataset *
+OGRMVTWriterDatasetCreate(const char *pszFilename, char **papszOptions,
+                          std::unique_ptr<OGRMVTTileWriter> poTileWriter)
+{
+    return OGRMVTWriterDataset::Create(pszFilename, papszOptions,
+                                       std::move(poTileWriter));
+}
+
+/************************************************************************/
+/*                          OGRMVTTileWriter                            */
+/************************************************************************/
+
+OGRMVTTileWriter::~OGRMVTTileWriter() = default;
+
 #endif  // HAVE_MVT_WRITE_SUPPORT
 
 /************************************************************************/
@@ -186,6 +186,35 @@ class FileGDBAndIterator final : public FileGDBIterator
     virtual int GetNextRowSortedByFID() override;
 };
 
+/************************************************************************/
+/*                      FileGDBBitmapAndIterator                        */
+/************************************************************************/
+
+class FileGDBBitmapAndIterator final : public FileGDBIterator
+{
+    FileGDBIterator *poIter = nullptr;
+    FileGDBIterator *poIterInBitmap = nullptr;
+    bool bBitmapBuilt = false;
+    std::vector<GByte> abyBitmap{};
+
+    FileGDBBitmapAndIterator(const FileGDBBitmapAndIterator &) = delete;
+    FileGDBBitmapAndIterator &
+    operator=(const FileGDBBitmapAndIterator &) = delete;
+
+    bool BuildBitmap();
+
+  public:
+    FileGDBBitmapAndIterator(FileGDBIterator *poIter,
+                             FileGDBIterator *poIterInBitmap);
+
+    virtual FileGDBTable *GetTable() override
+    {
+        return poIter->GetTable();
+    }
+    virtual void Reset() override;
+    virtual int GetNextRowSortedByFID() override;
+};
+
 /************************************************************************/
 /*                        FileGDBOrIterator                             */
 /************************************************************************/
@@ -379,6 +408,15 @@ int FileGDBIterator::GetNextRowSortedByValue()
     return -1;
 }
 
+/************************************************************************/
+/*                        GetNextRowUnsorted()                          */
+/************************************************************************/
+
+int FileGDBIterator::GetNextRowUnsorted()
+{
+    return GetNextRowSortedByFID();
+}
+
 /************************************************************************/
 /*                        GetMinMaxSumCount()                           */
 /************************************************************************/
@@ -449,6 +487,17 @@ FileGDBIterator *FileGDBIterator::BuildAnd(FileGDBIterator *poIter1,
     return new FileGDBAndIterator(poIter1, poIter2, bTakeOwnershipOfIterators);
 }
 
+/************************************************************************/
+/*                         BuildAndWithBitmap()                         */
+/************************************************************************/
+
+FileGDBIterator *
+FileGDBIterator::BuildAndWithBitmap(FileGDBIterator *poIter,
+                                    FileGDBIterator *poIterInBitmap)
+{
+    return new FileGDBBitmapAndIterator(poIter, poIterInBitmap);
+}
+
 /************************************************************************/
 /*                               BuildOr()                              */
 /************************************************************************/
@@ -646,6 +695,86 @@ int FileGDBAndIterator::GetNextRowSortedByFID()
     }
 }
 
+/************************************************************************/
+/*                      FileGDBBitmapAndIterator()                      */
+/************************************************************************/
+
+FileGDBBitmapAndIterator::FileGDBBitmapAndIterator(
+    FileGDBIterator *poIterIn, FileGDBIterator *poIterInBitmapIn)
+    : poIter(poIterIn), poIterInBitmap(poIterInBitmapIn)
+{
+    CPLAssert(poIter->GetTable() == poIterInBitmap->GetTable());
+}
+
+/************************************************************************/
+/*                             Reset()                                  */
+/************************************************************************/
+
+void FileGDBBitmapAndIterator::Reset()
+{
+    // The bitmap remains valid, as the filter of poIterInBitmap cannot
+    // change during the lifetime of this object.
+    poIter->Reset();
+}
+
+/************************************************************************/
+/*                           BuildBitmap()                              */
+/************************************************************************/
+
+bool FileGDBBitmapAndIterator::BuildBitmap()
+{
+    const int nTotalRecordCount = GetTable()->GetTotalRecordCount();
+    try
+    {
+        abyBitmap.resize((static_cast<size_t>(nTotalRecordCount) + 7) / 8);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate bitmap of selected rows");
+        return false;
+    }
+
+    // Rows of a spatial index iterator are not naturally sorted by FID, but
+    // they do not need to be for the bitmap.
+    poIterInBitmap->Reset();
+    while (true)
+    {
+        const int iRow = poIterInBitmap->GetNextRowUnsorted();
+        if (iRow < 0)
+            break;
+        if (iRow < nTotalRecordCount)
+            abyBitmap[iRow / 8] |= static_cast<GByte>(1 << (iRow % 8));
+    }
+    poIterInBitmap->Reset();
+    return true;
+}
+
+/************************************************************************/
+/*                        GetNextRowSortedByFID()                       */
+/************************************************************************/
+
+int FileGDBBitmapAndIterator::GetNextRowSortedByFID()
+{
+    if (!bBitmapBuilt)
+    {
+        bBitmapBuilt = true;
+        if (!BuildBitmap())
+            abyBitmap.clear();
+    }
+
+    const int nRowCountInBitmap = static_cast<int>(
+        std::min<size_t>(abyBitmap.size() * 8, INT_MAX));
+    while (true)
+    {
+        const int iRow = poIter->GetNextRowSortedByFID();
+        if (iRow < 0)
+            return -1;
+        if (iRow < nRowCountInBitmap && TEST_BIT(abyBitmap.data(), iRow))
+            return iRow;
+    }
+}
+
 /************************************************************************/
 /*                          FileGDBOrIterator()                         */
 /************************************************************************/
@@ -2243,6 +2372,11 @@ class FileGDBSpatialIndexIteratorImpl final : public FileGDBIndexIteratorBase,
     virtual int GetNextRowSortedByFID() override;
     virtual void Reset() override;
 
+    virtual int GetNextRowUnsorted() override
+    {
+        return GetNextRow();
+    }
+
     virtual bool SetEnvelope(const OGREnvelope &sFilterEnvelope) override;
 };
 
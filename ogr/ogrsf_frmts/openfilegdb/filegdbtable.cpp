@@ -45,6 +45,7 @@
 #include "cpl_string.h"
 #include "cpl_time.h"
 #include "cpl_vsi.h"
+#include "cpl_vsi_virtual.h"
 #include "filegdbtable_priv.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
@@ -1439,6 +1440,85 @@ FileGDBTable::GetOffsetInTableForRow(int iRow, vsi_l_offset *pnOffsetInTableX)
     return nOffset;
 }
 
+/************************************************************************/
+/*                           AdviseReadRows()                           */
+/*                                                                      */
+/*      Hint the virtual file system about the byte ranges of the rows  */
+/*      that are going to be read, so that network file systems can     */
+/*      fetch them with a few (parallel) range requests rather than     */
+/*      one request per row.                                            */
+/************************************************************************/
+
+void FileGDBTable::AdviseReadRows(const int *panRows, size_t nRows)
+{
+    if (nRows == 0)
+        return;
+
+    // GetOffsetInTableForRow() alters the deleted state of the current row
+    const int bIsDeletedBackup = m_bIsDeleted;
+    std::vector<vsi_l_offset> anOffsets;
+    anOffsets.reserve(nRows);
+    for (size_t i = 0; i < nRows; ++i)
+    {
+        const vsi_l_offset nOffset = GetOffsetInTableForRow(panRows[i]);
+        if (m_bError)
+            break;
+        if (nOffset != 0)
+            anOffsets.push_back(nOffset);
+    }
+    m_bIsDeleted = bIsDeletedBackup;
+    if (anOffsets.empty())
+        return;
+    std::sort(anOffsets.begin(), anOffsets.end());
+
+    if (m_nFileSize == 0)
+    {
+        VSIFSeekL(m_fpTable, 0, SEEK_END);
+        m_nFileSize = VSIFTellL(m_fpTable);
+    }
+
+    // The size of a row is only known once its header has been read, so
+    // assume it is at most the size of the largest row of the table.
+    constexpr vsi_l_offset MAX_GAP = 64 * 1024;
+    constexpr vsi_l_offset MAX_RANGE_SIZE = 16 * 1024 * 1024;
+    const vsi_l_offset nMaxRowSize =
+        sizeof(uint32_t) +
+        std::min<vsi_l_offset>(m_nRowBufferMaxSize, 1024 * 1024);
+    const auto GetRowEnd = [this, nMaxRowSize](vsi_l_offset nOffset)
+    { return std::min(m_nFileSize, nOffset + nMaxRowSize); };
+
+    std::vector<vsi_l_offset> anRangeOffsets;
+    std::vector<size_t> anRangeSizes;
+    vsi_l_offset nRangeStart = anOffsets[0];
+    vsi_l_offset nRangeEnd = GetRowEnd(nRangeStart);
+    for (size_t i = 1; i <= anOffsets.size(); ++i)
+    {
+        if (i < anOffsets.size() && anOffsets[i] <= nRangeEnd + MAX_GAP &&
+            GetRowEnd(anOffsets[i]) - nRangeStart <= MAX_RANGE_SIZE)
+        {
+            nRangeEnd = std::max(nRangeEnd, GetRowEnd(anOffsets[i]));
+            continue;
+        }
+        if (nRangeEnd > nRangeStart)
+        {
+            anRangeOffsets.push_back(nRangeStart);
+            anRangeSizes.push_back(
+                static_cast<size_t>(nRangeEnd - nRangeStart));
+        }
+        if (i < anOffsets.size())
+        {
+            nRangeStart = anOffsets[i];
+            nRangeEnd = GetRowEnd(nRangeStart);
+        }
+    }
+
+    if (!anRangeOffsets.empty())
+    {
+        m_fpTable->AdviseRead(static_cast<int>(anRangeOffsets.size()),
+                              anRangeOffsets.data(), anRangeSizes.data());
+    }
+}
+
 /************************************************************************/
 /*                        ReadFeatureOffset()                           */
 /************************************************************************/
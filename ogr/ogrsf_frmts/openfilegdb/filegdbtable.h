@@ -637,6 +637,7 @@ class FileGDBTable
 
     vsi_l_offset
     GetOffsetInTableForRow(int iRow, vsi_l_offset *pnOffsetInTableX = nullptr);
+    void AdviseReadRows(const int *panRows, size_t nRows);
 
     int HasDeletedFeaturesListed() const
     {
@@ -733,6 +734,10 @@ class FileGDBIterator
     /* Only available on a BuildIsNotNull() or Build() iterator */
     virtual int GetNextRowSortedByValue();
 
+    /* Rows may be returned in any order, and possibly several times.
+     * Defaults to GetNextRowSortedByFID() */
+    virtual int GetNextRowUnsorted();
+
     static FileGDBIterator *Build(FileGDBTable *poParent, int nFieldIdx,
                                   int bAscending, FileGDBSQLOp op,
                                   OGRFieldType eOGRFieldType,
@@ -746,6 +751,11 @@ class FileGDBIterator
     static FileGDBIterator *BuildOr(FileGDBIterator *poIter1,
                                     FileGDBIterator *poIter2,
                                     int bIteratorAreExclusive = FALSE);
+    /* Same result as BuildAnd(), but the rows of poIterInBitmap are first
+     * collected, in any order, into a bitmap against which the rows of
+     * poIter are tested. Does not take ownership of the iterators */
+    static FileGDBIterator *BuildAndWithBitmap(FileGDBIterator *poIter,
+                                               FileGDBIterator *poIterInBitmap);
 };
 
 /************************************************************************/
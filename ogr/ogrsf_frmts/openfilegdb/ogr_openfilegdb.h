@@ -39,6 +39,8 @@
 #include "gdal_rat.h"
 
 #include <array>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <map>
 
@@ -97,6 +99,7 @@ constexpr const char *pszDatasetsRelatedThroughUUID =
 /*                      OGROpenFileGDBLayer                             */
 /************************************************************************/
 
+class OGRArrowArrayHelper;
 class OGROpenFileGDBDataSource;
 class OGROpenFileGDBGeomFieldDefn;
 class OGROpenFileGDBFeatureDefn;
@@ -177,6 +180,31 @@ class OGROpenFileGDBLayer final : public OGRLayer
     std::string GetLaunderedFieldName(const std::string &osNameOri) const;
     std::string GetLaunderedLayerName(const std::string &osNameOri) const;
 
+    // Used by GetNextArrowArray()
+    struct ArrowBatchTask;
+    std::deque<std::unique_ptr<ArrowBatchTask>> m_apoArrowBatchTasks{};
+    int m_nArrowBatchTasksSubmitted = 0;
+    std::vector<int> m_anArrowLeftoverRows{};
+    // Extra readers of the table used by worker threads
+    std::vector<std::unique_ptr<FileGDBTable>> m_apoArrowReaderTables{};
+    std::vector<std::unique_ptr<FileGDBOGRGeometryConverter>>
+        m_apoArrowReaderGeomConverters{};
+
+    bool CanUseNativeArrowStream();
+    bool OpenArrowReaderTables(int nCount);
+    void CollectArrowBatchRows(FileGDBIterator *poIterator, int nMaxRows,
+                               std::vector<int> &anRows);
+    std::unique_ptr<ArrowBatchTask>
+    CreateArrowBatchTask(std::vector<int> &&anRows, FileGDBTable *poTable,
+                         FileGDBOGRGeometryConverter *poGeomConverter);
+    void SubmitArrowBatchTasks(FileGDBIterator *poIterator, int nMaxRows,
+                               int nMaxTasks);
+    void CancelArrowBatchTasks();
+    int FillArrowArray(FileGDBTable *poTable,
+                       FileGDBOGRGeometryConverter *poGeomConverter,
+                       const std::vector<int> &anRows, size_t &nRowsConsumed,
+                       OGRArrowArrayHelper &sHelper) const;
+
     mutable std::vector<std::string> m_aosTempStrings{};
     bool PrepareFileGDBFeature(OGRFeature *poFeature,
                                std::vector<OGRField> &fields,
@@ -277,6 +305,9 @@ class OGROpenFileGDBLayer final : public OGRLayer
     }
     virtual OGRErr SetAttributeFilter(const char *pszFilter) override;
 
+    virtual int GetNextArrowArray(struct ArrowArrayStream *,
+                                  struct ArrowArray *out_array) override;
+
     virtual int TestCapability(const char *) override;
 
     virtual OGRErr Rename(const char *pszNewName) override;
@@ -36,6 +36,8 @@
 #include <cstring>
 #include <cwchar>
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 
 #include "cpl_conv.h"
@@ -43,6 +45,8 @@
 #include "cpl_minixml.h"
 #include "cpl_quad_tree.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -52,6 +56,59 @@
 #include "ogrsf_frmts.h"
 #include "filegdbtable.h"
 #include "ogr_swq.h"
+#include "ograrrowarrayhelper.h"
+
+/************************************************************************/
+/*                 OGROpenFileGDBLayer::ArrowBatchTask                  */
+/************************************************************************/
+
+// Decoding of a batch of rows into an ArrowArray, possibly run by a worker
+// thread with its own reader of the table.
+struct OGROpenFileGDBLayer::ArrowBatchTask
+{
+    const OGROpenFileGDBLayer *poLayer = nullptr;
+    FileGDBTable *poTable = nullptr;
+    FileGDBOGRGeometryConverter *poGeomConverter = nullptr;
+    std::vector<int> anRows{};
+    struct ArrowArray sArray;
+    std::unique_ptr<OGRArrowArrayHelper> poHelper{};
+    size_t nRowsConsumed = 0;
+    int nRet = 0;
+
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+    bool bDone = false;
+
+    ArrowBatchTask()
+    {
+        memset(&sArray, 0, sizeof(sArray));
+    }
+
+    ~ArrowBatchTask()
+    {
+        if (sArray.release)
+            sArray.release(&sArray);
+    }
+
+    void Run()
+    {
+        poTable->AdviseReadRows(anRows.data(), anRows.size());
+        nRet = poLayer->FillArrowArray(poTable, poGeomConverter, anRows,
+                                       nRowsConsumed, *poHelper);
+        std::lock_guard<std::mutex> oLock(oMutex);
+        bDone = true;
+        oCV.notify_one();
+    }
+
+    void Wait()
+    {
+        std::unique_lock<std::mutex> oLock(oMutex);
+        while (!bDone)
+            oCV.wait(oLock);
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(ArrowBatchTask)
+};
 
 /************************************************************************/
 /*                      OGROpenFileGDBLayer()                           */
@@ -109,6 +166,8 @@ OGROpenFileGDBLayer::OGROpenFileGDBLayer(OGROpenFileGDBDataSource *poDS,
 
 OGROpenFileGDBLayer::~OGROpenFileGDBLayer()
 {
+    CancelArrowBatchTasks();
+
     OGROpenFileGDBLayer::SyncToDisk();
 
     if (m_poFeatureDefn)
@@ -134,6 +193,9 @@ OGROpenFileGDBLayer::~OGROpenFileGDBLayer()
 
 void OGROpenFileGDBLayer::Close()
 {
+    CancelArrowBatchTasks();
+    m_apoArrowReaderGeomConverters.clear();
+    m_apoArrowReaderTables.clear();
     delete m_poLyrTable;
     m_poLyrTable = nullptr;
     m_bValidLayerDefn = FALSE;
@@ -903,6 +965,7 @@ void OGROpenFileGDBLayer::ResetReading()
     }
     m_bEOF = FALSE;
     m_iCurFeat = 0;
+    CancelArrowBatchTasks();
     if (m_poAttributeIterator)
         m_poAttributeIterator->Reset();
     if (m_poSpatialIndexIterator)
@@ -1673,8 +1736,10 @@ void OGROpenFileGDBLayer::BuildCombinedIterator()
     delete m_poCombinedIterator;
     if (m_poAttributeIterator && m_poSpatialIndexIterator)
     {
-        m_poCombinedIterator = FileGDBIterator::BuildAnd(
-            m_poAttributeIterator, m_poSpatialIndexIterator, false);
+        // The rows selected by the spatial index are collected in a bitmap,
+        // which avoids sorting them by FID.
+        m_poCombinedIterator = FileGDBIterator::BuildAndWithBitmap(
+            m_poAttributeIterator, m_poSpatialIndexIterator);
     }
     else
     {
@@ -1682,6 +1747,34 @@ void OGROpenFileGDBLayer::BuildCombinedIterator()
     }
 }
 
+/***********************************************************************/
+/*                        PromoteToMultiGeometry()                     */
+/***********************************************************************/
+
+/* Feature classes are advertized with multi geometry types, but may hold */
+/* single part geometries. */
+static OGRGeometry *PromoteToMultiGeometry(OGRGeometry *poGeom)
+{
+    OGRwkbGeometryType eFlattenType = wkbFlatten(poGeom->getGeometryType());
+    if (eFlattenType == wkbPolygon)
+        poGeom = OGRGeometryFactory::forceToMultiPolygon(poGeom);
+    else if (eFlattenType == wkbCurvePolygon)
+    {
+        OGRMultiSurface *poMS = new OGRMultiSurface();
+        poMS->addGeometryDirectly(poGeom);
+        poGeom = poMS;
+    }
+    else if (eFlattenType == wkbLineString)
+        poGeom = OGRGeometryFactory::forceToMultiLineString(poGeom);
+    else if (eFlattenType == wkbCompoundCurve)
+    {
+        OGRMultiCurve *poMC = new OGRMultiCurve();
+        poMC->addGeometryDirectly(poGeom);
+        poGeom = poMC;
+    }
+    return poGeom;
+}
+
 /***********************************************************************/
 /*                         GetCurrentFeature()                         */
 /***********************************************************************/
@@ -1739,26 +1832,7 @@ OGRFeature *OGROpenFileGDBLayer::GetCurrentFeature()
                 OGRGeometry *poGeom = m_poGeomConverter->GetAsGeometry(psField);
                 if (poGeom != nullptr)
                 {
-                    OGRwkbGeometryType eFlattenType =
-                        wkbFlatten(poGeom->getGeometryType());
-                    if (eFlattenType == wkbPolygon)
-                        poGeom =
-                            OGRGeometryFactory::forceToMultiPolygon(poGeom);
-                    else if (eFlattenType == wkbCurvePolygon)
-                    {
-                        OGRMultiSurface *poMS = new OGRMultiSurface();
-                        poMS->addGeometryDirectly(poGeom);
-                        poGeom = poMS;
-                    }
-                    else if (eFlattenType == wkbLineString)
-                        poGeom =
-                            OGRGeometryFactory::forceToMultiLineString(poGeom);
-                    else if (eFlattenType == wkbCompoundCurve)
-                    {
-                        OGRMultiCurve *poMC = new OGRMultiCurve();
-                        poMC->addGeometryDirectly(poGeom);
-                        poGeom = poMC;
-                    }
+                    poGeom = PromoteToMultiGeometry(poGeom);
 
                     poGeom->assignSpatialReference(
                         m_poFeatureDefn->GetGeomFieldDefn(0)->GetSpatialRef());
@@ -1930,6 +2004,574 @@ OGRFeature *OGROpenFileGDBLayer::GetNextFeature()
     }
 }
 
+/***********************************************************************/
+/*                      CanUseNativeArrowStream()                      */
+/***********************************************************************/
+
+bool OGROpenFileGDBLayer::CanUseNativeArrowStream()
+{
+    // Attribute filters that cannot be fully evaluated with indices, and
+    // configurations where GetCurrentFeature() alters the content of the
+    // features, are dealt by the generic implementation.
+    if ((m_poAttrQuery != nullptr &&
+         !(m_poAttributeIterator != nullptr &&
+           m_bIteratorSufficientToEvaluateFilter)) ||
+        m_nFilteredFeatureCount >= 0 || m_iFieldToReadAsBinary >= 0 ||
+        m_iFIDAsRegularColumnIndex >= 0 ||
+        m_poLyrTable->HasDeletedFeaturesListed() ||
+        (m_poFilterGeom != nullptr &&
+         (m_iGeomFieldIdx < 0 ||
+          m_poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored())) ||
+        CPLTestBool(
+            CPLGetConfigOption("OGR_OPENFILEGDB_STREAM_BASE_IMPL", "NO")))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < m_poFeatureDefn->GetFieldCount(); ++i)
+    {
+        const auto poFieldDefn = m_poFeatureDefn->GetFieldDefn(i);
+        const auto eSubType = poFieldDefn->GetSubType();
+        switch (poFieldDefn->GetType())
+        {
+            case OFTInteger:
+                if (eSubType != OFSTNone && eSubType != OFSTInt16)
+                    return false;
+                break;
+            case OFTReal:
+                if (eSubType != OFSTNone && eSubType != OFSTFloat32)
+                    return false;
+                break;
+            case OFTInteger64:
+            case OFTString:
+            case OFTBinary:
+            case OFTDate:
+            case OFTTime:
+            case OFTDateTime:
+                if (eSubType != OFSTNone)
+                    return false;
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+/***********************************************************************/
+/*                            FillArrowArray()                         */
+/*                                                                     */
+/*      Decode rows directly into the Arrow buffers, without creating  */
+/*      OGRFeature objects. Must be consistent with                    */
+/*      GetCurrentFeature(). Only uses the passed table and geometry   */
+/*      converter, so that it can be run concurrently on different     */
+/*      readers of the table.                                          */
+/***********************************************************************/
+
+int OGROpenFileGDBLayer::FillArrowArray(
+    FileGDBTable *poTable, FileGDBOGRGeometryConverter *poGeomConverter,
+    const std::vector<int> &anRows, size_t &nRowsConsumed,
+    OGRArrowArrayHelper &sHelper) const
+{
+    struct ArrowArray *out_array = sHelper.m_out_array;
+    const uint64_t nMemLimit = OGRArrowArrayHelper::GetMemLimit();
+    const int iGeomArrowField =
+        m_iGeomFieldIdx >= 0 ? sHelper.m_mapOGRGeomFieldToArrowField[0] : -1;
+    struct tm brokenDown;
+    memset(&brokenDown, 0, sizeof(brokenDown));
+
+    int iFeat = 0;
+    // Whether writing nLen more bytes in the variable-size buffer of the
+    // iArrowField field would make it exceed the memory limit.
+    const auto IsMemLimitReached =
+        [out_array, &iFeat, nMemLimit](int iArrowField, size_t nLen)
+    {
+        const auto panOffsets = static_cast<const int32_t *>(
+            out_array->children[iArrowField]->buffers[1]);
+        return iFeat > 0 && static_cast<uint32_t>(panOffsets[iFeat]) +
+                                    static_cast<uint64_t>(nLen) >
+                                nMemLimit;
+    };
+
+    nRowsConsumed = 0;
+    for (; nRowsConsumed < anRows.size(); ++nRowsConsumed)
+    {
+        const int iRow = anRows[nRowsConsumed];
+        if (!poTable->SelectRow(iRow))
+        {
+            if (poTable->HasGotError())
+            {
+                sHelper.ClearArray();
+                return EIO;
+            }
+            continue;
+        }
+
+        std::unique_ptr<OGRGeometry> poGeom;
+        size_t nWKBSize = 0;
+        if (iGeomArrowField >= 0)
+        {
+            const OGRField *psField = poTable->GetFieldValue(m_iGeomFieldIdx);
+            if (psField != nullptr)
+            {
+                if (m_poFilterGeom != nullptr &&
+                    !poTable->DoesGeometryIntersectsFilterEnvelope(psField))
+                {
+                    continue;
+                }
+                poGeom.reset(poGeomConverter->GetAsGeometry(psField));
+                if (poGeom)
+                {
+                    poGeom.reset(PromoteToMultiGeometry(poGeom.release()));
+                    nWKBSize = poGeom->WkbSize();
+                }
+            }
+            else if (poTable->HasGotError())
+            {
+                sHelper.ClearArray();
+                return EIO;
+            }
+        }
+
+        // As all values of the row are written at index iFeat, stopping the
+        // batch in the middle of a row just requires not counting it.
+        if (nWKBSize > 0 && IsMemLimitReached(iGeomArrowField, nWKBSize))
+            break;
+
+        if (sHelper.m_panFIDValues)
+            sHelper.m_panFIDValues[iFeat] = static_cast<int64_t>(iRow) + 1;
+
+        if (iGeomArrowField >= 0)
+        {
+            if (nWKBSize == 0)
+            {
+                sHelper.SetNull(iGeomArrowField, iFeat);
+            }
+            else
+            {
+                GByte *pabyWKB = sHelper.GetPtrForStringOrBinary(
+                    iGeomArrowField, iFeat, nWKBSize);
+                if (pabyWKB == nullptr)
+                {
+                    sHelper.ClearArray();
+                    return ENOMEM;
+                }
+                poGeom->exportToWkb(wkbNDR, pabyWKB, wkbVariantIso);
+            }
+        }
+
+        bool bMemLimitReached = false;
+        int iOGRIdx = 0;
+        for (int iGDBIdx = 0; iGDBIdx < poTable->GetFieldCount(); iGDBIdx++)
+        {
+            if (iGDBIdx == m_iGeomFieldIdx ||
+                iGDBIdx == poTable->GetObjectIdFieldIdx())
+            {
+                continue;
+            }
+            const int iArrowField = sHelper.m_mapOGRFieldToArrowField[iOGRIdx];
+            const int iField = iOGRIdx;
+            iOGRIdx++;
+            if (iArrowField < 0)
+                continue;
+
+            const OGRField *psField = poTable->GetFieldValue(iGDBIdx);
+            if (psField == nullptr)
+            {
+                if (poTable->HasGotError())
+                {
+                    sHelper.ClearArray();
+                    return EIO;
+                }
+                sHelper.SetNull(iArrowField, iFeat);
+                continue;
+            }
+
+            auto psArray = out_array->children[iArrowField];
+            const auto poFieldDefn = m_poFeatureDefn->GetFieldDefn(iField);
+            switch (poFieldDefn->GetType())
+            {
+                case OFTInteger:
+                    if (poFieldDefn->GetSubType() == OFSTInt16)
+                        sHelper.SetInt16(
+                            psArray, iFeat,
+                            static_cast<int16_t>(psField->Integer));
+                    else
+                        sHelper.SetInt32(psArray, iFeat, psField->Integer);
+                    break;
+
+                case OFTInteger64:
+                    sHelper.SetInt64(psArray, iFeat, psField->Integer64);
+                    break;
+
+                case OFTReal:
+                    if (poFieldDefn->GetSubType() == OFSTFloat32)
+                        sHelper.SetFloat(psArray, iFeat,
+                                         static_cast<float>(psField->Real));
+                    else
+                        sHelper.SetDouble(psArray, iFeat, psField->Real);
+                    break;
+
+                case OFTString:
+                case OFTBinary:
+                {
+                    const bool bIsString =
+                        poFieldDefn->GetType() == OFTString;
+                    const size_t nLen =
+                        bIsString ? strlen(psField->String)
+                                  : static_cast<size_t>(psField->Binary.nCount);
+                    if (IsMemLimitReached(iArrowField, nLen))
+                    {
+                        bMemLimitReached = true;
+                        break;
+                    }
+                    GByte *pabyData = sHelper.GetPtrForStringOrBinary(
+                        iArrowField, iFeat, nLen);
+                    if (pabyData == nullptr)
+                    {
+                        sHelper.ClearArray();
+                        return ENOMEM;
+                    }
+                    if (nLen)
+                        memcpy(pabyData,
+                               bIsString ? static_cast<const void *>(
+                                               psField->String)
+                                         : psField->Binary.paData,
+                               nLen);
+                    break;
+                }
+
+                case OFTDate:
+                    sHelper.SetDate(psArray, iFeat, brokenDown, *psField);
+                    break;
+
+                case OFTTime:
+                    sHelper.SetInt32(
+                        psArray, iFeat,
+                        psField->Date.Hour * 3600000 +
+                            psField->Date.Minute * 60000 +
+                            static_cast<int>(psField->Date.Second * 1000 +
+                                             0.5));
+                    break;
+
+                case OFTDateTime:
+                {
+                    OGRField sField = *psField;
+                    if (poTable->GetField(iGDBIdx)->GetType() == FGFT_DATETIME)
+                    {
+                        sField.Date.TZFlag = m_bTimeInUTC ? 100 : 0;
+                    }
+                    sHelper.SetDateTime(psArray, iFeat, brokenDown,
+                                        sHelper.m_anTZFlags[iField], sField);
+                    break;
+                }
+
+                default:
+                    CPLAssert(false);
+                    break;
+            }
+            if (bMemLimitReached)
+                break;
+        }
+        if (bMemLimitReached)
+            break;
+
+        ++iFeat;
+    }
+
+    sHelper.Shrink(iFeat);
+    return 0;
+}
+
+/***********************************************************************/
+/*                        OpenArrowReaderTables()                      */
+/***********************************************************************/
+
+bool OGROpenFileGDBLayer::OpenArrowReaderTables(int nCount)
+{
+    if (!m_apoArrowReaderTables.empty())
+        return true;
+
+    for (int i = 0; i < nCount; ++i)
+    {
+        auto poTable = std::make_unique<FileGDBTable>();
+        if (!poTable->Open(m_osGDBFilename, false, GetDescription()) ||
+            poTable->GetFieldCount() != m_poLyrTable->GetFieldCount() ||
+            poTable->GetGeomFieldIdx() != m_iGeomFieldIdx)
+        {
+            m_apoArrowReaderGeomConverters.clear();
+            m_apoArrowReaderTables.clear();
+            return false;
+        }
+        std::unique_ptr<FileGDBOGRGeometryConverter> poGeomConverter;
+        if (m_iGeomFieldIdx >= 0)
+        {
+            poGeomConverter.reset(FileGDBOGRGeometryConverter::BuildConverter(
+                poTable->GetGeomField()));
+        }
+        m_apoArrowReaderTables.push_back(std::move(poTable));
+        m_apoArrowReaderGeomConverters.push_back(std::move(poGeomConverter));
+    }
+    return true;
+}
+
+/***********************************************************************/
+/*                        CollectArrowBatchRows()                      */
+/***********************************************************************/
+
+void OGROpenFileGDBLayer::CollectArrowBatchRows(FileGDBIterator *poIterator,
+                                                int nMaxRows,
+                                                std::vector<int> &anRows)
+{
+    anRows.clear();
+    if (m_bEOF)
+        return;
+
+    if (poIterator != nullptr)
+    {
+        while (static_cast<int>(anRows.size()) < nMaxRows)
+        {
+            const int iRow = poIterator->GetNextRowSortedByFID();
+            if (iRow < 0)
+            {
+                m_bEOF = TRUE;
+                break;
+            }
+            anRows.push_back(iRow);
+        }
+    }
+    else
+    {
+        // Holes in the table are skipped when decoding the rows
+        const int nTotalRecordCount = m_poLyrTable->GetTotalRecordCount();
+        while (static_cast<int>(anRows.size()) < nMaxRows &&
+               m_iCurFeat < nTotalRecordCount)
+        {
+            anRows.push_back(m_iCurFeat);
+            ++m_iCurFeat;
+        }
+        if (m_iCurFeat == nTotalRecordCount)
+            m_bEOF = TRUE;
+    }
+}
+
+/***********************************************************************/
+/*                        CreateArrowBatchTask()                       */
+/***********************************************************************/
+
+std::unique_ptr<OGROpenFileGDBLayer::ArrowBatchTask>
+OGROpenFileGDBLayer::CreateArrowBatchTask(
+    std::vector<int> &&anRows, FileGDBTable *poTable,
+    FileGDBOGRGeometryConverter *poGeomConverter)
+{
+    auto poTask = std::make_unique<ArrowBatchTask>();
+    poTask->poLayer = this;
+    poTask->poTable = poTable;
+    poTask->poGeomConverter = poGeomConverter;
+    poTask->anRows = std::move(anRows);
+    if (poTable != m_poLyrTable)
+    {
+        poTable->InstallFilterEnvelope(
+            m_poFilterGeom != nullptr ? &m_sFilterEnvelope : nullptr);
+    }
+    // Must be done in the main thread, as it may query the dataset for
+    // field domains
+    poTask->poHelper = std::make_unique<OGRArrowArrayHelper>(
+        m_poDS, m_poFeatureDefn, m_aosArrowArrayStreamOptions,
+        &poTask->sArray);
+    if (poTask->sArray.release == nullptr)
+    {
+        poTask->nRet = ENOMEM;
+        poTask->bDone = true;
+    }
+    return poTask;
+}
+
+/***********************************************************************/
+/*                        SubmitArrowBatchTasks()                      */
+/***********************************************************************/
+
+void OGROpenFileGDBLayer::SubmitArrowBatchTasks(FileGDBIterator *poIterator,
+                                                int nMaxRows, int nMaxTasks)
+{
+    CPLWorkerThreadPool *poPool = nullptr;
+    if (nMaxTasks >= 2 && !m_bEditable &&
+        m_poLyrTable->GetTotalRecordCount() > nMaxRows &&
+        OpenArrowReaderTables(nMaxTasks))
+    {
+        nMaxTasks = static_cast<int>(m_apoArrowReaderTables.size());
+        poPool = GDALGetGlobalThreadPool(nMaxTasks);
+    }
+    if (poPool == nullptr)
+        nMaxTasks = 1;
+
+    while (static_cast<int>(m_apoArrowBatchTasks.size()) < nMaxTasks)
+    {
+        std::vector<int> anRows;
+        CollectArrowBatchRows(poIterator, nMaxRows, anRows);
+        if (anRows.empty())
+            break;
+
+        // At most nMaxTasks tasks are in flight, and they are consumed in
+        // submission order, so the reader used by the task submitted
+        // nMaxTasks before this one is available.
+        FileGDBTable *poTable = m_poLyrTable;
+        FileGDBOGRGeometryConverter *poGeomConverter = m_poGeomConverter.get();
+        if (poPool)
+        {
+            const int iReader = m_nArrowBatchTasksSubmitted % nMaxTasks;
+            poTable = m_apoArrowReaderTables[iReader].get();
+            poGeomConverter = m_apoArrowReaderGeomConverters[iReader].get();
+        }
+        ++m_nArrowBatchTasksSubmitted;
+
+        auto poTask =
+            CreateArrowBatchTask(std::move(anRows), poTable, poGeomConverter);
+        if (!poTask->bDone)
+        {
+            const auto JobFunc = [](void *pData)
+            { static_cast<ArrowBatchTask *>(pData)->Run(); };
+            if (!poPool || !poPool->SubmitJob(JobFunc, poTask.get()))
+                poTask->Run();
+        }
+        m_apoArrowBatchTasks.push_back(std::move(poTask));
+    }
+}
+
+/***********************************************************************/
+/*                        CancelArrowBatchTasks()                      */
+/***********************************************************************/
+
+void OGROpenFileGDBLayer::CancelArrowBatchTasks()
+{
+    for (auto &poTask : m_apoArrowBatchTasks)
+        poTask->Wait();
+    m_apoArrowBatchTasks.clear();
+    m_anArrowLeftoverRows.clear();
+}
+
+/***********************************************************************/
+/*                          GetNextArrowArray()                        */
+/*                                                                     */
+/*      Batches of rows, selected by a sequential scan or by the       */
+/*      attribute and spatial indices, are decoded in worker threads,  */
+/*      each one using its own reader of the .gdbtable/.gdbtablx.      */
+/***********************************************************************/
+
+int OGROpenFileGDBLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
+                                           struct ArrowArray *out_array)
+{
+    if (!BuildLayerDefinition())
+    {
+        memset(out_array, 0, sizeof(*out_array));
+        return EIO;
+    }
+
+    bool bUseBaseImpl =
+        !m_poSharedArrowArrayStreamPrivateData->m_anQueriedFIDs.empty() ||
+        !CanUseNativeArrowStream();
+    struct ArrowSchema schema;
+    memset(&schema, 0, sizeof(schema));
+    if (!bUseBaseImpl && m_poFilterGeom != nullptr)
+    {
+        bUseBaseImpl = stream->get_schema(stream, &schema) != 0 ||
+                       !CanPostFilterArrowArray(&schema);
+        if (bUseBaseImpl && schema.release)
+            schema.release(&schema);
+    }
+    if (bUseBaseImpl)
+    {
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+    }
+
+    // Features are not fetched through GetCurrentFeature()
+    if (m_eSpatialIndexState == SPI_IN_BUILDING)
+        m_eSpatialIndexState = SPI_INVALID;
+
+    FileGDBIterator *poIterator = m_poCombinedIterator ? m_poCombinedIterator
+                                  : m_poSpatialIndexIterator
+                                      ? m_poSpatialIndexIterator
+                                      : m_poAttributeIterator;
+
+    const int nMaxBatchSize = OGRArrowArrayHelper::GetMaxFeaturesInBatch(
+        m_aosArrowArrayStreamOptions);
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    const int nThreads =
+        pszNumThreads == nullptr ? std::min(4, CPLGetNumCPUs())
+        : EQUAL(pszNumThreads, "ALL_CPUS")
+            ? CPLGetNumCPUs()
+            : std::max(1, std::min(128, atoi(pszNumThreads)));
+
+    while (true)
+    {
+        memset(out_array, 0, sizeof(*out_array));
+
+        std::unique_ptr<ArrowBatchTask> poTask;
+        if (!m_anArrowLeftoverRows.empty())
+        {
+            // Rows that did not fit in the previous batch because of the
+            // memory limit. They come before the rows of queued tasks.
+            std::vector<int> anRows = std::move(m_anArrowLeftoverRows);
+            m_anArrowLeftoverRows.clear();
+            poTask = CreateArrowBatchTask(std::move(anRows), m_poLyrTable,
+                                          m_poGeomConverter.get());
+            if (!poTask->bDone)
+                poTask->Run();
+        }
+        else
+        {
+            SubmitArrowBatchTasks(poIterator, nMaxBatchSize, nThreads);
+            if (m_apoArrowBatchTasks.empty())
+                break;
+            poTask = std::move(m_apoArrowBatchTasks.front());
+            m_apoArrowBatchTasks.pop_front();
+            poTask->Wait();
+        }
+
+        if (poTask->nRet != 0)
+        {
+            CancelArrowBatchTasks();
+            m_bEOF = TRUE;
+            if (schema.release)
+                schema.release(&schema);
+            return poTask->nRet;
+        }
+        // The memory limit is never applied to the first row of a batch,
+        // so leftover rows always come after a non-empty batch.
+        if (poTask->nRowsConsumed < poTask->anRows.size())
+        {
+            m_anArrowLeftoverRows.assign(poTask->anRows.begin() +
+                                             poTask->nRowsConsumed,
+                                         poTask->anRows.end());
+        }
+
+        // Transfer the task ArrowArray to the client array
+        memcpy(out_array, &poTask->sArray, sizeof(*out_array));
+        memset(&poTask->sArray, 0, sizeof(poTask->sArray));
+        m_nFeaturesRead += out_array->length;
+
+        if (out_array->length != 0 && m_poFilterGeom != nullptr)
+        {
+            PostFilterArrowArray(&schema, out_array, nullptr);
+            if (out_array->release == nullptr)
+            {
+                schema.release(&schema);
+                return ENOMEM;
+            }
+        }
+
+        if (out_array->length != 0)
+            break;
+
+        // Everything has been filtered out: try with the next rows
+        out_array->release(out_array);
+    }
+
+    if (schema.release)
+        schema.release(&schema);
+    return 0;
+}
+
 /***********************************************************************/
 /*                          GetFeature()                               */
 /***********************************************************************/
@@ -2233,6 +2875,12 @@ int OGROpenFileGDBLayer::TestCapability(const char *pszCap)
                m_poLyrTable->HasSpatialIndex();
     }
 
+    else if (EQUAL(pszCap, OLCFastGetArrowStream))
+    {
+        // Consistent with the conditions of GetNextArrowArray()
+        return CanUseNativeArrowStream();
+    }
+
     return FALSE;
 }
 
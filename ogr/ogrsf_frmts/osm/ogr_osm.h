@@ -35,8 +35,11 @@
 
 #include "ogrsf_frmts.h"
 #include "cpl_string.h"
+#include "cpl_virtualmem.h"
+#include "cpl_worker_thread_pool.h"
 
 #include <array>
+#include <memory>
 #include <set>
 #include <unordered_set>
 #include <map>
@@ -490,6 +493,28 @@ class OGROSMDataSource final : public OGRDataSource
     GIntBig m_nNodesFileSize = 0;
     VSILFILE *m_fpNodes = nullptr;
 
+    // Direct view on the content of the (uncompressed) nodes file, either
+    // the buffer of the in-memory file, or a memory mapping of the on-disk
+    // file
+    bool m_bMapNodesFile = true;
+    GIntBig m_nMaxNodesFileMappingSize = 0;
+    CPLVirtualMem *m_psNodesFileMapping = nullptr;
+    const GByte *m_pabyNodesFileView = nullptr;
+    GIntBig m_nNodesFileViewSize = 0;
+
+    // Used for node lookup and way geometry building
+    int m_nWorkerThreads = 1;
+    std::unique_ptr<CPLWorkerThreadPool> m_poWorkerThreadPool{};
+
+    // Result of the node resolution of a WayFeaturePair
+    struct ResolvedWay
+    {
+        std::vector<LonLat> asLonLat{};
+        std::vector<GByte> abyCompressedWay{};
+        OGRLineString *poLS = nullptr;
+    };
+    std::vector<ResolvedWay> m_asResolvedWays{};
+
     GIntBig m_nPrevNodeId = -INT_MAX;
     int m_nBucketOld = -1;
     int m_nOffInBucketReducedOld = -1;
@@ -503,9 +528,10 @@ class OGROSMDataSource final : public OGRDataSource
     static const GIntBig FILESIZE_INVALID = -1;
     GIntBig m_nFileSize = FILESIZE_NOT_INIT;
 
-    void CompressWay(bool bIsArea, unsigned int nTags, IndexedKVP *pasTags,
-                     int nPoints, LonLat *pasLonLatPairs, OSMInfo *psInfo,
-                     std::vector<GByte> &abyCompressedWay);
+    void CompressWay(bool bIsArea, unsigned int nTags,
+                     const IndexedKVP *pasTags, int nPoints,
+                     const LonLat *pasLonLatPairs, const OSMInfo *psInfo,
+                     std::vector<GByte> &abyCompressedWay) const;
     void UncompressWay(int nBytes, const GByte *pabyCompressedWay,
                        bool *pbIsArea, std::vector<LonLat> &asCoords,
                        unsigned int *pnTags, OSMTag *pasTags, OSMInfo *psInfo);
@@ -527,11 +553,16 @@ class OGROSMDataSource final : public OGRDataSource
     void IndexWay(GIntBig nWayID, bool bIsArea, unsigned int nTags,
                   IndexedKVP *pasTags, LonLat *pasLonLatPairs, int nPairs,
                   OSMInfo *psInfo);
+    void InsertCompressedWay(GIntBig nWayID,
+                             const std::vector<GByte> &abyCompressedWay);
 
     bool StartTransactionCacheDB();
     bool CommitTransactionCacheDB();
 
-    int FindNode(GIntBig nID);
+    int FindNode(GIntBig nID) const;
+    void ResolveWayNodes(const WayFeaturePair *psWayFeaturePairs,
+                         std::vector<LonLat> &asLonLat) const;
+    void ResolveWays(int iStart, int iEnd);
     void ProcessWaysBatch();
 
     void ProcessPolygonsStandalone();
@@ -541,6 +572,11 @@ class OGROSMDataSource final : public OGRDataSource
     void LookupNodesCustom();
     void LookupNodesCustomCompressedCase();
     void LookupNodesCustomNonCompressedCase();
+    bool UpdateNodesFileView();
+    void ReleaseNodesFileView();
+    unsigned int LookupNodesFromNodesFileView(unsigned int nStart,
+                                              unsigned int nEnd) const;
+    CPLWorkerThreadPool *GetWorkerThreadPool();
 
     unsigned int
     LookupWays(std::map<GIntBig, std::pair<int, void *>> &aoMapWays,
@@ -311,6 +311,7 @@ OGROSMDataSource::~OGROSMDataSource()
         }
     }
 
+    ReleaseNodesFileView();
     if (m_fpNodes)
         VSIFCloseL(m_fpNodes);
     if (!m_osNodesFilename.empty() && m_bMustUnlinkNodesFile)
@@ -1190,12 +1191,232 @@ void OGROSMDataSource::LookupNodesCustomCompressedCase()
     m_nReqIds = j;
 }
 
+/************************************************************************/
+/*                        UpdateNodesFileView()                         */
+/************************************************************************/
+
+// Make m_pabyNodesFileView point to the current content of the nodes file,
+// so that node lookups can be done by direct memory access, instead of
+// seeking and reading the nodes file.
+bool OGROSMDataSource::UpdateNodesFileView()
+{
+    if (!m_bMapNodesFile || m_bCompressNodes)
+        return false;
+
+    if (m_bInMemoryNodesFile)
+    {
+        // The buffer may be reallocated when the file grows, so fetch it
+        // each time.
+        vsi_l_offset nDataLength = 0;
+        m_pabyNodesFileView =
+            VSIGetMemFileBuffer(m_osNodesFilename, &nDataLength, FALSE);
+        m_nNodesFileViewSize = static_cast<GIntBig>(nDataLength);
+        return m_pabyNodesFileView != nullptr;
+    }
+
+    if (m_psNodesFileMapping && m_nNodesFileViewSize >= m_nNodesFileSize)
+        return true;
+
+    ReleaseNodesFileView();
+
+    if (m_nNodesFileSize == 0 ||
+        m_nNodesFileSize > m_nMaxNodesFileMappingSize ||
+        static_cast<GUIntBig>(m_nNodesFileSize) >
+            std::numeric_limits<size_t>::max() ||
+        !CPLIsVirtualMemFileMapAvailable())
+    {
+        return false;
+    }
+
+    // Make sure that what has been written is visible to the mapping
+    if (VSIFFlushL(m_fpNodes) != 0)
+        return false;
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    m_psNodesFileMapping =
+        CPLVirtualMemFileMapNew(m_fpNodes, 0, m_nNodesFileSize,
+                                VIRTUALMEM_READONLY, nullptr, nullptr);
+    CPLPopErrorHandler();
+    if (m_psNodesFileMapping == nullptr)
+    {
+        CPLDebug("OSM", "Cannot map nodes file. Using regular file I/O");
+        m_bMapNodesFile = false;
+        return false;
+    }
+    m_pabyNodesFileView =
+        static_cast<const GByte *>(CPLVirtualMemGetAddr(m_psNodesFileMapping));
+    m_nNodesFileViewSize = m_nNodesFileSize;
+    return true;
+}
+
+/************************************************************************/
+/*                        ReleaseNodesFileView()                        */
+/************************************************************************/
+
+void OGROSMDataSource::ReleaseNodesFileView()
+{
+    if (m_psNodesFileMapping)
+        CPLVirtualMemFree(m_psNodesFileMapping);
+    m_psNodesFileMapping = nullptr;
+    m_pabyNodesFileView = nullptr;
+    m_nNodesFileViewSize = 0;
+}
+
+/************************************************************************/
+/*                    LookupNodesFromNodesFileView()                    */
+/************************************************************************/
+
+// Fetch the coordinates of the nodes of index [nStart, nEnd[ in
+// m_panReqIds from m_pabyNodesFileView, into the same index of
+// m_pasLonLatArray. Nodes that cannot be found are set to (0,0).
+// This may be run concurrently on distinct ranges.
+// Returns the number of nodes that could not be found.
+unsigned int
+OGROSMDataSource::LookupNodesFromNodesFileView(unsigned int nStart,
+                                               unsigned int nEnd) const
+{
+    unsigned int nErrors = 0;
+    int l_nBucketOld = -1;
+    const Bucket *psBucket = nullptr;
+    int k = 0;
+    int nSectorBase = 0;
+    for (unsigned int i = nStart; i < nEnd; i++)
+    {
+        const GIntBig id = m_panReqIds[i];
+        const int nBucket = static_cast<int>(id / NODE_PER_BUCKET);
+        const int nOffInBucket = static_cast<int>(id % NODE_PER_BUCKET);
+        const int nOffInBucketReduced = nOffInBucket >> NODE_PER_SECTOR_SHIFT;
+        const int nOffInBucketReducedRemainder =
+            nOffInBucket & ((1 << NODE_PER_SECTOR_SHIFT) - 1);
+
+        const int nBitmapIndex = nOffInBucketReduced / 8;
+        const int nBitmapRemainder = nOffInBucketReduced % 8;
+
+        m_pasLonLatArray[i].nLon = 0;
+        m_pasLonLatArray[i].nLat = 0;
+
+        if (psBucket == nullptr || nBucket != l_nBucketOld)
+        {
+            const auto oIter = m_oMapBuckets.find(nBucket);
+            if (oIter == m_oMapBuckets.end() ||
+                oIter->second.u.pabyBitmap == nullptr)
+            {
+                psBucket = nullptr;
+                nErrors++;
+                continue;
+            }
+            psBucket = &(oIter->second);
+            l_nBucketOld = nBucket;
+            k = 0;
+            nSectorBase = 0;
+        }
+
+        /* If we stay in the same bucket, we can reuse the previously */
+        /* computed offset, instead of starting from bucket start */
+        for (; k < nBitmapIndex; k++)
+        {
+            nSectorBase += abyBitsCount[psBucket->u.pabyBitmap[k]];
+        }
+        int nSector = nSectorBase;
+        if (nBitmapRemainder)
+        {
+            nSector += abyBitsCount[psBucket->u.pabyBitmap[nBitmapIndex] &
+                                    ((1 << nBitmapRemainder) - 1)];
+        }
+
+        const GIntBig nOffset = psBucket->nOff +
+                                static_cast<GIntBig>(nSector) * SECTOR_SIZE +
+                                nOffInBucketReducedRemainder * sizeof(LonLat);
+        if (nOffset < 0 ||
+            nOffset + static_cast<GIntBig>(sizeof(LonLat)) >
+                m_nNodesFileViewSize)
+        {
+            nErrors++;
+            continue;
+        }
+        memcpy(&m_pasLonLatArray[i], m_pabyNodesFileView + nOffset,
+               sizeof(LonLat));
+    }
+    return nErrors;
+}
+
 /************************************************************************/
 /*                    LookupNodesCustomNonCompressedCase()              */
 /************************************************************************/
 
+// Minimum number of node ids to look up them in parallel
+constexpr unsigned int MIN_NODES_FOR_MULTITHREADING = 100000;
+
 void OGROSMDataSource::LookupNodesCustomNonCompressedCase()
 {
+    if (UpdateNodesFileView())
+    {
+        unsigned int nErrors = 0;
+        auto poPool = m_nReqIds >= MIN_NODES_FOR_MULTITHREADING
+                          ? GetWorkerThreadPool()
+                          : nullptr;
+        if (poPool)
+        {
+            struct JobDesc
+            {
+                const OGROSMDataSource *poDS;
+                unsigned int nStart;
+                unsigned int nEnd;
+                unsigned int nErrors;
+            };
+
+            const unsigned int nJobs = poPool->GetThreadCount();
+            const unsigned int nIdsPerJob = (m_nReqIds + nJobs - 1) / nJobs;
+            std::vector<JobDesc> asJobs;
+            for (unsigned int nStart = 0; nStart < m_nReqIds;
+                 nStart += nIdsPerJob)
+            {
+                asJobs.push_back(
+                    {this, nStart, std::min(nStart + nIdsPerJob, m_nReqIds),
+                     0});
+            }
+            for (auto &sJob : asJobs)
+            {
+                poPool->SubmitJob(
+                    [](void *pData)
+                    {
+                        const auto psJob = static_cast<JobDesc *>(pData);
+                        psJob->nErrors =
+                            psJob->poDS->LookupNodesFromNodesFileView(
+                                psJob->nStart, psJob->nEnd);
+                    },
+                    &sJob);
+            }
+            poPool->WaitCompletion();
+            for (const auto &sJob : asJobs)
+                nErrors += sJob.nErrors;
+        }
+        else
+        {
+            nErrors = LookupNodesFromNodesFileView(0, m_nReqIds);
+        }
+
+        if (nErrors)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Cannot read %u node(s)",
+                     nErrors);
+        }
+
+        // Compact the arrays to only keep found nodes
+        unsigned int j = 0;
+        for (unsigned int i = 0; i < m_nReqIds; i++)
+        {
+            if (m_pasLonLatArray[i].nLon || m_pasLonLatArray[i].nLat)
+            {
+                m_panReqIds[j] = m_panReqIds[i];
+                m_pasLonLatArray[j] = m_pasLonLatArray[i];
+                j++;
+            }
+        }
+        m_nReqIds = j;
+        return;
+    }
+
     unsigned int j = 0;  // Used after for.
 
     int l_nBucketOld = -1;
@@ -1384,9 +1605,10 @@ static void WriteVarSInt64(GIntBig nSVal, GByte **ppabyData)
 /************************************************************************/
 
 void OGROSMDataSource::CompressWay(bool bIsArea, unsigned int nTags,
-                                   IndexedKVP *pasTags, int nPoints,
-                                   LonLat *pasLonLatPairs, OSMInfo *psInfo,
-                                   std::vector<GByte> &abyCompressedWay)
+                                   const IndexedKVP *pasTags, int nPoints,
+                                   const LonLat *pasLonLatPairs,
+                                   const OSMInfo *psInfo,
+                                   std::vector<GByte> &abyCompressedWay) const
 {
     abyCompressedWay.clear();
     abyCompressedWay.push_back((bIsArea) ? 1 : 0);
@@ -1566,8 +1788,6 @@ void OGROSMDataSource::IndexWay(GIntBig nWayID, bool bIsArea,
     if (!m_bIndexWays)
         return;
 
-    sqlite3_bind_int64(m_hInsertWayStmt, 1, nWayID);
-
     const unsigned nTagsClamped = std::min(nTags, MAX_COUNT_FOR_TAGS_IN_WAY);
     if (nTagsClamped < nTags)
     {
@@ -1578,8 +1798,19 @@ void OGROSMDataSource::IndexWay(GIntBig nWayID, bool bIsArea,
     }
     CompressWay(bIsArea, nTagsClamped, pasTags, nPairs, pasLonLatPairs, psInfo,
                 m_abyWayBuffer);
-    sqlite3_bind_blob(m_hInsertWayStmt, 2, m_abyWayBuffer.data(),
-                      static_cast<int>(m_abyWayBuffer.size()), SQLITE_STATIC);
+    InsertCompressedWay(nWayID, m_abyWayBuffer);
+}
+
+/************************************************************************/
+/*                        InsertCompressedWay()                         */
+/************************************************************************/
+
+void OGROSMDataSource::InsertCompressedWay(
+    GIntBig nWayID, const std::vector<GByte> &abyCompressedWay)
+{
+    sqlite3_bind_int64(m_hInsertWayStmt, 1, nWayID);
+    sqlite3_bind_blob(m_hInsertWayStmt, 2, abyCompressedWay.data(),
+                      static_cast<int>(abyCompressedWay.size()), SQLITE_STATIC);
 
     int rc = sqlite3_step(m_hInsertWayStmt);
     sqlite3_reset(m_hInsertWayStmt);
@@ -1595,7 +1826,7 @@ void OGROSMDataSource::IndexWay(GIntBig nWayID, bool bIsArea,
 /*                              FindNode()                              */
 /************************************************************************/
 
-int OGROSMDataSource::FindNode(GIntBig nID)
+int OGROSMDataSource::FindNode(GIntBig nID) const
 {
     if (m_nReqIds == 0)
         return -1;
@@ -1615,135 +1846,261 @@ int OGROSMDataSource::FindNode(GIntBig nID)
 }
 
 /************************************************************************/
-/*                         ProcessWaysBatch()                           */
+/*                          ResolveWayNodes()                           */
 /************************************************************************/
 
-void OGROSMDataSource::ProcessWaysBatch()
+// Fill asLonLat with the coordinates of the nodes of a way, as found by
+// the last LookupNodes() call.
+void OGROSMDataSource::ResolveWayNodes(const WayFeaturePair *psWayFeaturePairs,
+                                       std::vector<LonLat> &asLonLat) const
 {
-    if (m_nWayFeaturePairs == 0)
-        return;
-
-    // printf("nodes = %d, features = %d\n", nUnsortedReqIds, nWayFeaturePairs);
-    LookupNodes();
-
-    for (int iPair = 0; iPair < m_nWayFeaturePairs; iPair++)
-    {
-        WayFeaturePair *psWayFeaturePairs = &m_pasWayFeaturePairs[iPair];
-
-        const bool bIsArea = psWayFeaturePairs->bIsArea;
-        m_asLonLatCache.clear();
+    asLonLat.clear();
 
 #ifdef ENABLE_NODE_LOOKUP_BY_HASHING
-        if (m_bHashedIndexValid)
+    if (m_bHashedIndexValid)
+    {
+        for (unsigned int i = 0; i < psWayFeaturePairs->nRefs; i++)
         {
-            for (unsigned int i = 0; i < psWayFeaturePairs->nRefs; i++)
+            int nIndInHashArray = static_cast<int>(
+                HASH_ID_FUNC(psWayFeaturePairs->panNodeRefs[i]) %
+                HASHED_INDEXES_ARRAY_SIZE);
+            int nIdx = m_panHashedIndexes[nIndInHashArray];
+            if (nIdx < -1)
             {
-                int nIndInHashArray = static_cast<int>(
-                    HASH_ID_FUNC(psWayFeaturePairs->panNodeRefs[i]) %
-                    HASHED_INDEXES_ARRAY_SIZE);
-                int nIdx = m_panHashedIndexes[nIndInHashArray];
-                if (nIdx < -1)
+                int iBucket = -nIdx - 2;
+                while (true)
                 {
-                    int iBucket = -nIdx - 2;
-                    while (true)
+                    nIdx = m_psCollisionBuckets[iBucket].nInd;
+                    if (m_panReqIds[nIdx] == psWayFeaturePairs->panNodeRefs[i])
+                        break;
+                    iBucket = m_psCollisionBuckets[iBucket].nNext;
+                    if (iBucket < 0)
                     {
-                        nIdx = m_psCollisionBuckets[iBucket].nInd;
-                        if (m_panReqIds[nIdx] ==
-                            psWayFeaturePairs->panNodeRefs[i])
-                            break;
-                        iBucket = m_psCollisionBuckets[iBucket].nNext;
-                        if (iBucket < 0)
-                        {
-                            nIdx = -1;
-                            break;
-                        }
+                        nIdx = -1;
+                        break;
                     }
                 }
-                else if (nIdx >= 0 &&
-                         m_panReqIds[nIdx] != psWayFeaturePairs->panNodeRefs[i])
-                    nIdx = -1;
+            }
+            else if (nIdx >= 0 &&
+                     m_panReqIds[nIdx] != psWayFeaturePairs->panNodeRefs[i])
+                nIdx = -1;
 
-                if (nIdx >= 0)
-                {
-                    m_asLonLatCache.push_back(m_pasLonLatArray[nIdx]);
-                }
+            if (nIdx >= 0)
+            {
+                asLonLat.push_back(m_pasLonLatArray[nIdx]);
             }
         }
-        else
+    }
+    else
 #endif  // ENABLE_NODE_LOOKUP_BY_HASHING
+    {
+        int nIdx = -1;
+        for (unsigned int i = 0; i < psWayFeaturePairs->nRefs; i++)
         {
-            int nIdx = -1;
-            for (unsigned int i = 0; i < psWayFeaturePairs->nRefs; i++)
+            if (nIdx >= 0 && psWayFeaturePairs->panNodeRefs[i] ==
+                                 psWayFeaturePairs->panNodeRefs[i - 1] + 1)
             {
-                if (nIdx >= 0 && psWayFeaturePairs->panNodeRefs[i] ==
-                                     psWayFeaturePairs->panNodeRefs[i - 1] + 1)
-                {
-                    if (nIdx + 1 < (int)m_nReqIds &&
-                        m_panReqIds[nIdx + 1] ==
-                            psWayFeaturePairs->panNodeRefs[i])
-                        nIdx++;
-                    else
-                        nIdx = -1;
-                }
+                if (nIdx + 1 < (int)m_nReqIds &&
+                    m_panReqIds[nIdx + 1] == psWayFeaturePairs->panNodeRefs[i])
+                    nIdx++;
                 else
-                    nIdx = FindNode(psWayFeaturePairs->panNodeRefs[i]);
-                if (nIdx >= 0)
-                {
-                    m_asLonLatCache.push_back(m_pasLonLatArray[nIdx]);
-                }
+                    nIdx = -1;
+            }
+            else
+                nIdx = FindNode(psWayFeaturePairs->panNodeRefs[i]);
+            if (nIdx >= 0)
+            {
+                asLonLat.push_back(m_pasLonLatArray[nIdx]);
             }
         }
+    }
+
+    if (!asLonLat.empty() && psWayFeaturePairs->bIsArea)
+    {
+        asLonLat.push_back(asLonLat[0]);
+    }
+}
+
+/************************************************************************/
+/*                            ResolveWays()                             */
+/************************************************************************/
+
+// Resolve node coordinates, compress the way for the ways table, and build
+// the line geometry of the ways of index [iStart, iEnd[ of
+// m_pasWayFeaturePairs. Results go to m_asResolvedWays.
+// This may be run concurrently on distinct ranges, and must thus only
+// read shared state.
+void OGROSMDataSource::ResolveWays(int iStart, int iEnd)
+{
+    const bool bMultiPolygonsInterested =
+        m_papoLayers[IDX_LYR_MULTIPOLYGONS]->IsUserInterested();
+
+    for (int iPair = iStart; iPair < iEnd; iPair++)
+    {
+        const WayFeaturePair *psWayFeaturePairs = &m_pasWayFeaturePairs[iPair];
+        ResolvedWay &oResolvedWay = m_asResolvedWays[iPair];
+        oResolvedWay.abyCompressedWay.clear();
+        oResolvedWay.poLS = nullptr;
+
+        ResolveWayNodes(psWayFeaturePairs, oResolvedWay.asLonLat);
+        const auto &asLonLat = oResolvedWay.asLonLat;
+        if (asLonLat.size() < 2)
+            continue;
 
-        if (!m_asLonLatCache.empty() && bIsArea)
+        const int nPoints = static_cast<int>(asLonLat.size());
+        if (m_bIndexWays)
         {
-            m_asLonLatCache.push_back(m_asLonLatCache[0]);
+            if (psWayFeaturePairs->bIsArea && bMultiPolygonsInterested)
+            {
+                CompressWay(/* bIsArea = */ true,
+                            std::min(psWayFeaturePairs->nTags,
+                                     MAX_COUNT_FOR_TAGS_IN_WAY),
+                            psWayFeaturePairs->pasTags, nPoints,
+                            asLonLat.data(), &psWayFeaturePairs->sInfo,
+                            oResolvedWay.abyCompressedWay);
+            }
+            else
+            {
+                CompressWay(psWayFeaturePairs->bIsArea, 0, nullptr, nPoints,
+                            asLonLat.data(), nullptr,
+                            oResolvedWay.abyCompressedWay);
+            }
         }
 
-        if (m_asLonLatCache.size() < 2)
+        if (psWayFeaturePairs->poFeature == nullptr)
+            continue;
+
+        OGRLineString *poLS = new OGRLineString();
+        poLS->setNumPoints(nPoints);
+        for (int i = 0; i < nPoints; i++)
+        {
+            poLS->setPoint(i, INT_TO_DBL(asLonLat[i].nLon),
+                           INT_TO_DBL(asLonLat[i].nLat));
+        }
+        oResolvedWay.poLS = poLS;
+    }
+}
+
+/************************************************************************/
+/*                        GetWorkerThreadPool()                         */
+/************************************************************************/
+
+CPLWorkerThreadPool *OGROSMDataSource::GetWorkerThreadPool()
+{
+    if (!m_poWorkerThreadPool && m_nWorkerThreads > 1)
+    {
+        m_poWorkerThreadPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!m_poWorkerThreadPool->Setup(m_nWorkerThreads, nullptr, nullptr))
+        {
+            m_poWorkerThreadPool.reset();
+            m_nWorkerThreads = 1;
+        }
+    }
+    return m_poWorkerThreadPool.get();
+}
+
+/************************************************************************/
+/*                         ProcessWaysBatch()                           */
+/************************************************************************/
+
+// Minimum number of ways in a batch to resolve them in parallel
+constexpr int MIN_WAYS_FOR_MULTITHREADING = 1000;
+
+void OGROSMDataSource::ProcessWaysBatch()
+{
+    if (m_nWayFeaturePairs == 0)
+        return;
+
+    // printf("nodes = %d, features = %d\n", nUnsortedReqIds, nWayFeaturePairs);
+    LookupNodes();
+
+    // Resolve node coordinates and build geometries, possibly in parallel,
+    // and then insert ways and emit features sequentially, in the order
+    // they were read.
+    if (m_asResolvedWays.size() < static_cast<size_t>(m_nWayFeaturePairs))
+        m_asResolvedWays.resize(m_nWayFeaturePairs);
+    auto poPool = m_nWayFeaturePairs >= MIN_WAYS_FOR_MULTITHREADING
+                      ? GetWorkerThreadPool()
+                      : nullptr;
+    if (poPool)
+    {
+        struct JobDesc
+        {
+            OGROSMDataSource *poDS;
+            int iStart;
+            int iEnd;
+        };
+
+        const int nJobs = 4 * poPool->GetThreadCount();
+        std::vector<JobDesc> asJobs;
+        const int nWaysPerJob = (m_nWayFeaturePairs + nJobs - 1) / nJobs;
+        for (int iStart = 0; iStart < m_nWayFeaturePairs;
+             iStart += nWaysPerJob)
+        {
+            asJobs.push_back(
+                {this, iStart,
+                 std::min(iStart + nWaysPerJob, m_nWayFeaturePairs)});
+        }
+        for (auto &sJob : asJobs)
+        {
+            poPool->SubmitJob(
+                [](void *pData)
+                {
+                    const auto psJob = static_cast<JobDesc *>(pData);
+                    psJob->poDS->ResolveWays(psJob->iStart, psJob->iEnd);
+                },
+                &sJob);
+        }
+        poPool->WaitCompletion();
+    }
+    else
+    {
+        ResolveWays(0, m_nWayFeaturePairs);
+    }
+
+    for (int iPair = 0; iPair < m_nWayFeaturePairs; iPair++)
+    {
+        WayFeaturePair *psWayFeaturePairs = &m_pasWayFeaturePairs[iPair];
+        ResolvedWay &oResolvedWay = m_asResolvedWays[iPair];
+        const int nPoints = static_cast<int>(oResolvedWay.asLonLat.size());
+
+        if (nPoints < 2)
         {
             CPLDebug("OSM",
                      "Way " CPL_FRMT_GIB
                      " with %d nodes that could be found. Discarding it",
-                     psWayFeaturePairs->nWayID,
-                     static_cast<int>(m_asLonLatCache.size()));
+                     psWayFeaturePairs->nWayID, nPoints);
             delete psWayFeaturePairs->poFeature;
             psWayFeaturePairs->poFeature = nullptr;
             psWayFeaturePairs->bIsArea = false;
             continue;
         }
 
-        if (bIsArea && m_papoLayers[IDX_LYR_MULTIPOLYGONS]->IsUserInterested())
+        if (m_bIndexWays)
         {
-            IndexWay(psWayFeaturePairs->nWayID, /*bIsArea = */ true,
-                     psWayFeaturePairs->nTags, psWayFeaturePairs->pasTags,
-                     m_asLonLatCache.data(),
-                     static_cast<int>(m_asLonLatCache.size()),
-                     &psWayFeaturePairs->sInfo);
+            if (psWayFeaturePairs->bIsArea &&
+                psWayFeaturePairs->nTags > MAX_COUNT_FOR_TAGS_IN_WAY &&
+                m_papoLayers[IDX_LYR_MULTIPOLYGONS]->IsUserInterested())
+            {
+                CPLDebug("OSM",
+                         "Too many tags for way " CPL_FRMT_GIB ": %u. "
+                         "Clamping to %u",
+                         psWayFeaturePairs->nWayID, psWayFeaturePairs->nTags,
+                         MAX_COUNT_FOR_TAGS_IN_WAY);
+            }
+            InsertCompressedWay(psWayFeaturePairs->nWayID,
+                                oResolvedWay.abyCompressedWay);
         }
-        else
-            IndexWay(psWayFeaturePairs->nWayID, bIsArea, 0, nullptr,
-                     m_asLonLatCache.data(),
-                     static_cast<int>(m_asLonLatCache.size()), nullptr);
 
         if (psWayFeaturePairs->poFeature == nullptr)
         {
             continue;
         }
 
-        OGRLineString *poLS = new OGRLineString();
-        OGRGeometry *poGeom = poLS;
-
-        const int nPoints = static_cast<int>(m_asLonLatCache.size());
-        poLS->setNumPoints(nPoints);
-        for (int i = 0; i < nPoints; i++)
-        {
-            poLS->setPoint(i, INT_TO_DBL(m_asLonLatCache[i].nLon),
-                           INT_TO_DBL(m_asLonLatCache[i].nLat));
-        }
-
-        psWayFeaturePairs->poFeature->SetGeometryDirectly(poGeom);
+        psWayFeaturePairs->poFeature->SetGeometryDirectly(oResolvedWay.poLS);
+        oResolvedWay.poLS = nullptr;
 
-        if (m_asLonLatCache.size() != psWayFeaturePairs->nRefs)
+        if (static_cast<unsigned>(nPoints) != psWayFeaturePairs->nRefs)
             CPLDebug(
                 "OSM",
                 "For way " CPL_FRMT_GIB ", got only %d nodes instead of %d",
@@ -2773,6 +3130,21 @@ int OGROSMDataSource::Open(const char *pszFilename, char **papszOpenOptionsIn)
     if (m_bCompressNodes)
         CPLDebug("OSM", "Using compression for nodes DB");
 
+    // Whether the (uncompressed) nodes file can be accessed through a memory
+    // mapping when it is on disk, provided it fits in RAM
+    m_bMapNodesFile =
+        CPLTestBool(CPLGetConfigOption("OSM_MAP_NODES_FILE", "YES"));
+    m_nMaxNodesFileMappingSize = CPLGetUsablePhysicalRAM();
+    if (m_nMaxNodesFileMappingSize <= 0)
+        m_nMaxNodesFileMappingSize = std::numeric_limits<GIntBig>::max();
+
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+    m_nWorkerThreads = CPLGetNumCPUs();
+    if (pszNumThreads && !EQUAL(pszNumThreads, "ALL_CPUS"))
+        m_nWorkerThreads = std::max(
+            1, std::min(2 * m_nWorkerThreads, atoi(pszNumThreads)));
+
     m_nLayers = 5;
     m_papoLayers = static_cast<OGROSMLayer **>(
         CPLMalloc(m_nLayers * sizeof(OGROSMLayer *)));
@@ -3848,6 +4220,7 @@ int OGROSMDataSource::MyResetReading()
         m_nBucketOld = -1;
         m_nOffInBucketReducedOld = -1;
 
+        ReleaseNodesFileView();
         VSIFSeekL(m_fpNodes, 0, SEEK_SET);
         VSIFTruncateL(m_fpNodes, 0);
         m_nNodesFileSize = 0;
@@ -4063,6 +4436,7 @@ bool OGROSMDataSource::TransferToDiskIfNecesserary()
         {
             m_bInMemoryNodesFile = false;
 
+            ReleaseNodesFileView();
             VSIFCloseL(m_fpNodes);
             m_fpNodes = nullptr;
 
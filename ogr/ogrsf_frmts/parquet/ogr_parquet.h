@@ -32,6 +32,7 @@
 #include "ogrsf_frmts.h"
 
 #include <functional>
+#include <future>
 #include <map>
 
 #include "../arrow_common/ogr_arrow.h"
@@ -42,6 +43,7 @@
 /************************************************************************/
 
 class OGRParquetDataset;
+class OGRArrowRandomAccessFile;
 
 class OGRParquetLayerBase CPL_NON_FINAL : public OGRArrowLayer
 {
@@ -87,6 +89,15 @@ class OGRParquetLayer final : public OGRParquetLayerBase
     std::vector<int64_t> m_anSelectedGroupsStartFeatureIdx{};
     std::vector<int> m_anRequestedParquetColumns{};  // only valid when
                                                      // m_bIgnoredFields is set
+
+    // Only set when reading through the GDAL virtual file system
+    std::shared_ptr<OGRArrowRandomAccessFile> m_poInputFile{};
+    // Row groups iterated over by m_poRecordBatchReader
+    std::vector<int> m_anRowGroupsOfRecordBatchReader{};
+    int64_t m_nRowsReadFromRecordBatchReader = 0;
+    // Index in m_anRowGroupsOfRecordBatchReader of the last row group
+    // for which AdviseRead() has been called
+    int m_iLastAdvisedRowGroup = -1;
 #ifdef DEBUG
     int m_nExpectedBatchColumns =
         0;  // Should be equal to m_poBatch->num_columns() (when
@@ -97,6 +108,7 @@ class OGRParquetLayer final : public OGRParquetLayerBase
     void EstablishFeatureDefn();
     bool CreateRecordBatchReader(int iStartingRowGroup);
     bool CreateRecordBatchReader(const std::vector<int> &anRowGroups);
+    void AdviseReadRowGroups();
     bool ReadNextBatch() override;
 
     void InvalidateCachedBatches() override;
@@ -135,6 +147,11 @@ class OGRParquetLayer final : public OGRParquetLayerBase
     char **GetMetadata(const char *pszDomain = "") override;
     OGRErr SetNextByIndex(GIntBig nIndex) override;
 
+    void SetInputFile(const std::shared_ptr<OGRArrowRandomAccessFile> &poFile)
+    {
+        m_poInputFile = poFile;
+    }
+
     GDALDataset *GetDataset() override;
     bool GetArrowStream(struct ArrowArrayStream *out_stream,
                         CSLConstList papszOptions = nullptr) override;
@@ -250,6 +267,34 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
     bool m_bEdgesSpherical = false;
     parquet::WriterProperties::Builder m_oWriterPropertiesBuilder{};
 
+    // Whether row groups are encoded, compressed and written by a background
+    // thread, while the next one is being filled.
+    bool m_bWriteRowGroupsInThread = false;
+    // Result of the row group being written in the background thread.
+    // Holds an error message, empty in case of success.
+    std::future<std::string> m_oPendingRowGroupWrite{};
+
+    // SORT_BY_BBOX=YES: features are first stored in a temporary GeoPackage,
+    // and written in the order of a Hilbert curve of the center of their
+    // bounding box when the layer is finalized.
+    struct SortItem
+    {
+        double dfX;  // NaN if no geometry
+        double dfY;
+        GIntBig nTmpFID;
+        GIntBig nFID;
+    };
+
+    bool m_bSortByBBOX = false;
+    std::string m_osTmpGPKGFilename{};
+    std::unique_ptr<GDALDataset> m_poTmpGPKG{};
+    OGRLayer *m_poTmpGPKGLayer = nullptr;
+    std::vector<SortItem> m_asSortItems{};
+
+    bool WaitForPendingRowGroupWrite();
+    bool CreateTmpGPKG();
+    bool WriteSortedFeatures();
+
     virtual bool IsFileWriterCreated() const override
     {
         return m_poFileWriter != nullptr;
@@ -296,6 +341,11 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
                            int bApproxOK = TRUE) override;
 
     int TestCapability(const char *pszCap) override;
+
+  protected:
+    OGRErr ICreateFeature(OGRFeature *poFeature) override;
+
+  public:
 #if PARQUET_VERSION_MAJOR <= 10
     // Parquet <= 10 doesn't support the WriteRecordBatch() API
     bool IsArrowSchemaSupported(const struct ArrowSchema *schema,
@@ -321,6 +371,9 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
     bool IsArrowSchemaSupported(const struct ArrowSchema *schema,
                                 CSLConstList papszOptions,
                                 std::string &osErrorMsg) const override;
+    bool
+    CreateFieldFromArrowSchema(const struct ArrowSchema *schema,
+                               CSLConstList papszOptions = nullptr) override;
     bool WriteArrowBatch(const struct ArrowSchema *schema,
                          struct ArrowArray *array,
                          CSLConstList papszOptions = nullptr) override;
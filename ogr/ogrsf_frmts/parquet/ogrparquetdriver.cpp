@@ -497,6 +497,7 @@ static GDALDataset *OGRParquetDriverOpen(GDALOpenInfo *poOpenInfo)
     try
     {
         std::shared_ptr<arrow::io::RandomAccessFile> infile;
+        std::shared_ptr<OGRArrowRandomAccessFile> poVSIFile;
         if (STARTS_WITH(osFilename.c_str(), "/vsi") ||
             CPLTestBool(CPLGetConfigOption("OGR_PARQUET_USE_VSI", "NO")))
         {
@@ -508,7 +509,9 @@ static GDALDataset *OGRParquetDriverOpen(GDALOpenInfo *poOpenInfo)
                 if (fp == nullptr)
                     return nullptr;
             }
-            infile = std::make_shared<OGRArrowRandomAccessFile>(std::move(fp));
+            poVSIFile =
+                std::make_shared<OGRArrowRandomAccessFile>(std::move(fp));
+            infile = poVSIFile;
         }
         else
         {
@@ -533,6 +536,8 @@ static GDALDataset *OGRParquetDriverOpen(GDALOpenInfo *poOpenInfo)
         auto poLayer = std::make_unique<OGRParquetLayer>(
             poDS.get(), CPLGetBasename(osFilename.c_str()),
             std::move(arrow_reader), poOpenInfo->papszOpenOptions);
+        if (poVSIFile)
+            poLayer->SetInputFile(poVSIFile);
         poDS->SetLayer(std::move(poLayer));
         return poDS.release();
     }
@@ -738,6 +743,16 @@ void OGRParquetDriver::InitMetadata()
                                    "Name of creating application");
     }
 
+    {
+        auto psOption = CPLCreateXMLNode(oTree.get(), CXT_Element, "Option");
+        CPLAddXMLAttributeAndValue(psOption, "name", "SORT_BY_BBOX");
+        CPLAddXMLAttributeAndValue(psOption, "type", "boolean");
+        CPLAddXMLAttributeAndValue(psOption, "description",
+                                   "Whether features should be sorted along "
+                                   "a Hilbert curve of their bounding box");
+        CPLAddXMLAttributeAndValue(psOption, "default", "NO");
+    }
+
     char *pszXML = CPLSerializeXMLTree(oTree.get());
     GDALDriver::SetMetadataItem(GDAL_DS_LAYER_CREATIONOPTIONLIST, pszXML);
     CPLFree(pszXML);
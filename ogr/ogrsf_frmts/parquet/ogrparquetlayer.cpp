@@ -44,6 +44,7 @@
 
 #include "../arrow_common/ograrrowlayer.hpp"
 #include "../arrow_common/ograrrowdataset.hpp"
+#include "../arrow_common/ograrrowrandomaccessfile.h"
 
 /************************************************************************/
 /*                    OGRParquetLayerBase()                             */
@@ -91,7 +92,7 @@ void OGRParquetLayerBase::LoadGeoMetadata(
                 if (osVersion != "0.1.0" && osVersion != "0.2.0" &&
                     osVersion != "0.3.0" && osVersion != "0.4.0" &&
                     osVersion != "1.0.0-beta.1" && osVersion != "1.0.0-rc.1" &&
-                    osVersion != "1.0.0")
+                    osVersion != "1.0.0" && osVersion != "1.1.0")
                 {
                     CPLDebug(
                         "PARQUET",
@@ -520,6 +521,59 @@ void OGRParquetLayer::EstablishFeatureDefn()
     CPLAssert(static_cast<int>(m_anMapGeomFieldIndexToParquetColumn.size()) ==
               m_poFeatureDefn->GetGeomFieldCount());
 
+    // GeoParquet 1.1 "covering" of the geometry column by a bounding box
+    // struct column, whose sub-fields are exposed as "bbox.xmin", etc.
+    // fields. They are then used like the Overture Maps bbox.minx, etc. fields.
+    if (m_poFeatureDefn->GetGeomFieldCount() == 1)
+    {
+        const auto oIter = m_oMapGeometryColumns.find(
+            fields[m_anMapGeomFieldIndexToArrowColumn[0]]->name());
+        const auto oBBOX = oIter != m_oMapGeometryColumns.end()
+                               ? oIter->second.GetObj("covering/bbox")
+                               : CPLJSONObject();
+        const auto GetCoveringField = [this, &oBBOX](const char *pszKey)
+        {
+            const auto oPath = oBBOX.GetArray(pszKey);
+            if (!oPath.IsValid() || oPath.Size() == 0)
+                return -1;
+            std::string osFieldName;
+            for (const auto &oPart : oPath)
+            {
+                if (!osFieldName.empty())
+                    osFieldName += '.';
+                osFieldName += oPart.ToString();
+            }
+            const int iField =
+                m_poFeatureDefn->GetFieldIndex(osFieldName.c_str());
+            if (iField < 0)
+                return -1;
+            // The bbox fields are expected to be of type Float64
+            const auto poFieldDefn = m_poFeatureDefn->GetFieldDefn(iField);
+            if (poFieldDefn->GetType() != OFTReal ||
+                poFieldDefn->GetSubType() != OFSTNone)
+            {
+                CPLDebug("PARQUET",
+                         "Covering field %s is not of type Float64. Ignoring",
+                         osFieldName.c_str());
+                return -1;
+            }
+            return iField;
+        };
+        const int iMinXField = GetCoveringField("xmin");
+        const int iMinYField = GetCoveringField("ymin");
+        const int iMaxXField = GetCoveringField("xmax");
+        const int iMaxYField = GetCoveringField("ymax");
+        if (iMinXField >= 0 && iMinYField >= 0 && iMaxXField >= 0 &&
+            iMaxYField >= 0)
+        {
+            CPLDebug("PARQUET", "Using bounding box covering columns");
+            m_iBBOXMinXField = iMinXField;
+            m_iBBOXMinYField = iMinYField;
+            m_iBBOXMaxXField = iMaxXField;
+            m_iBBOXMaxYField = iMaxYField;
+        }
+    }
+
     if (!fields.empty())
     {
         try
@@ -958,9 +1012,90 @@ bool OGRParquetLayer::CreateRecordBatchReader(
                  "GetRecordBatchReader() failed: %s", status.message().c_str());
         return false;
     }
+    m_anRowGroupsOfRecordBatchReader = anRowGroups;
+    m_nRowsReadFromRecordBatchReader = 0;
+    m_iLastAdvisedRowGroup = -1;
     return true;
 }
 
+/************************************************************************/
+/*                        AdviseReadRowGroups()                         */
+/************************************************************************/
+
+// Hint the virtual file system about the byte ranges of the column chunks
+// of the row groups that are going to be read by the next ReadNext() call
+// of m_poRecordBatchReader, so that network file systems (/vsis3/, etc.)
+// can fetch them in parallel, instead of the Parquet reader issuing one
+// request per column chunk. Only row groups that have been selected by
+// ReadNextBatch() are considered.
+void OGRParquetLayer::AdviseReadRowGroups()
+{
+    if (!m_poInputFile)
+        return;
+
+    const auto metadata = m_poArrowReader->parquet_reader()->metadata();
+    const auto nBatchSize = m_poArrowReader->properties().batch_size();
+    std::vector<std::pair<vsi_l_offset, size_t>> aoRanges;
+    int64_t nAccRows = 0;
+    for (int i = 0;
+         i < static_cast<int>(m_anRowGroupsOfRecordBatchReader.size()) &&
+         nAccRows < m_nRowsReadFromRecordBatchReader + nBatchSize;
+         ++i)
+    {
+        const auto poRowGroup =
+            metadata->RowGroup(m_anRowGroupsOfRecordBatchReader[i]);
+        nAccRows += poRowGroup->num_rows();
+        if (i <= m_iLastAdvisedRowGroup ||
+            nAccRows <= m_nRowsReadFromRecordBatchReader)
+        {
+            continue;
+        }
+        m_iLastAdvisedRowGroup = i;
+
+        const auto AddColumnChunk = [&poRowGroup, &aoRanges](int iCol)
+        {
+            const auto poColumn = poRowGroup->ColumnChunk(iCol);
+            int64_t nStart = poColumn->data_page_offset();
+            if (poColumn->has_dictionary_page() &&
+                poColumn->dictionary_page_offset() > 0 &&
+                poColumn->dictionary_page_offset() < nStart)
+            {
+                nStart = poColumn->dictionary_page_offset();
+            }
+            const int64_t nSize = poColumn->total_compressed_size();
+            if (nStart >= 0 && nSize > 0 &&
+                static_cast<uint64_t>(nSize) <
+                    std::numeric_limits<size_t>::max())
+            {
+                aoRanges.emplace_back(static_cast<vsi_l_offset>(nStart),
+                                      static_cast<size_t>(nSize));
+            }
+        };
+        if (m_bIgnoredFields)
+        {
+            for (int iCol : m_anRequestedParquetColumns)
+                AddColumnChunk(iCol);
+        }
+        else
+        {
+            for (int iCol = 0; iCol < poRowGroup->num_columns(); ++iCol)
+                AddColumnChunk(iCol);
+        }
+    }
+    if (aoRanges.empty())
+        return;
+
+    std::sort(aoRanges.begin(), aoRanges.end());
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    for (const auto &oRange : aoRanges)
+    {
+        anOffsets.push_back(oRange.first);
+        anSizes.push_back(oRange.second);
+    }
+    m_poInputFile->AdviseRead(anOffsets, anSizes);
+}
+
 /************************************************************************/
 /*                       IsConstraintPossible()                         */
 /************************************************************************/
@@ -1053,7 +1188,8 @@ bool OGRParquetLayer::ReadNextBatch()
         bool bIterateEverything = false;
         std::vector<int> anSelectedGroups;
         const bool bUSEBBOXFields =
-            (m_poFilterGeom && m_iBBOXMinXField >= 0 && m_iBBOXMinYField >= 0 &&
+            (m_poFilterGeom && m_iGeomFieldFilter == 0 &&
+             m_iBBOXMinXField >= 0 && m_iBBOXMinYField >= 0 &&
              m_iBBOXMaxXField >= 0 && m_iBBOXMaxYField >= 0 &&
              CPLTestBool(CPLGetConfigOption(
                  ("OGR_" + GetDriverUCName() + "_USE_BBOX").c_str(), "YES")));
@@ -1344,6 +1480,7 @@ bool OGRParquetLayer::ReadNextBatch()
     {
         ++m_iRecordBatch;
         poNextBatch.reset();
+        AdviseReadRowGroups();
         auto status = m_poRecordBatchReader->ReadNext(&poNextBatch);
         if (!status.ok())
         {
@@ -1362,6 +1499,7 @@ bool OGRParquetLayer::ReadNextBatch()
                 m_poBatch.reset();
             return false;
         }
+        m_nRowsReadFromRecordBatchReader += poNextBatch->num_rows();
         if (!m_anSelectedGroupsStartFeatureIdx.empty())
         {
             CPLAssert(
@@ -1847,6 +1985,7 @@ OGRErr OGRParquetLayer::SetNextByIndex(GIntBig nIndex)
             std::shared_ptr<arrow::RecordBatch> poBatch;
             while (true)
             {
+                AdviseReadRowGroups();
                 auto status = m_poRecordBatchReader->ReadNext(&poBatch);
                 if (!status.ok())
                 {
@@ -1862,6 +2001,7 @@ OGRErr OGRParquetLayer::SetNextByIndex(GIntBig nIndex)
                     ResetReading();
                     return OGRERR_FAILURE;
                 }
+                m_nRowsReadFromRecordBatchReader += poBatch->num_rows();
                 if (nIndex < nAccRows + poBatch->num_rows())
                 {
                     break;
@@ -35,6 +35,10 @@
 
 #include "ogr_wkb.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 /************************************************************************/
 /*                      OGRParquetWriterLayer()                         */
 /************************************************************************/
@@ -56,7 +60,18 @@ OGRParquetWriterLayer::OGRParquetWriterLayer(
 OGRParquetWriterLayer::~OGRParquetWriterLayer()
 {
     if (m_bInitializationOK)
+    {
+        if (m_poTmpGPKGLayer)
+            WriteSortedFeatures();
         FinalizeWriting();
+    }
+    WaitForPendingRowGroupWrite();
+
+    if (m_poTmpGPKG)
+    {
+        m_poTmpGPKG.reset();
+        VSIUnlink(m_osTmpGPKGFilename.c_str());
+    }
 }
 
 /************************************************************************/
@@ -221,6 +236,18 @@ bool OGRParquetWriterLayer::SetOptions(CSLConstList papszOptions,
     m_bEdgesSpherical = EQUAL(
         CSLFetchNameValueDef(papszOptions, "EDGES", "PLANAR"), "SPHERICAL");
 
+    m_bSortByBBOX =
+        CPLTestBool(CSLFetchNameValueDef(papszOptions, "SORT_BY_BBOX", "NO"));
+
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    int nNumThreads = 0;
+    if (pszNumThreads == nullptr)
+        nNumThreads = std::min(4, CPLGetNumCPUs());
+    else
+        nNumThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszNumThreads);
+    m_bWriteRowGroupsInThread = nNumThreads > 1;
+
     m_bInitializationOK = true;
     return true;
 }
@@ -231,6 +258,8 @@ bool OGRParquetWriterLayer::SetOptions(CSLConstList papszOptions,
 
 void OGRParquetWriterLayer::CloseFileWriter()
 {
+    WaitForPendingRowGroupWrite();
+
     auto status = m_poFileWriter->Close();
     if (!status.ok())
     {
@@ -530,6 +559,9 @@ std::string OGRParquetWriterLayer::GetGeoMetadata() const
 
 void OGRParquetWriterLayer::PerformStepsBeforeFinalFlushGroup()
 {
+    // m_poKeyValueMetadata is owned by the file writer
+    WaitForPendingRowGroupWrite();
+
     if (m_poKeyValueMetadata)
     {
         const std::string osGeoMetadata = GetGeoMetadata();
@@ -661,38 +693,400 @@ void OGRParquetWriterLayer::CreateWriter()
                             &m_poKeyValueMetadata));
 }
 
+/************************************************************************/
+/*                     WaitForPendingRowGroupWrite()                    */
+/************************************************************************/
+
+bool OGRParquetWriterLayer::WaitForPendingRowGroupWrite()
+{
+    if (!m_oPendingRowGroupWrite.valid())
+        return true;
+    const std::string osErrorMsg = m_oPendingRowGroupWrite.get();
+    if (!osErrorMsg.empty())
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "%s", osErrorMsg.c_str());
+        return false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                            FlushGroup()                              */
 /************************************************************************/
 
 bool OGRParquetWriterLayer::FlushGroup()
 {
-    auto status = m_poFileWriter->NewRowGroup(m_apoBuilders[0]->length());
-    if (!status.ok())
+    const int64_t nRows = m_apoBuilders[0]->length();
+
+    // Finishing the builders is done in the calling thread, as they are
+    // going to be recreated for the next row group.
+    std::vector<std::shared_ptr<arrow::Field>> apoFields;
+    std::vector<std::shared_ptr<arrow::Array>> apoArrays;
+    const bool bRet = WriteArrays(
+        [&apoFields, &apoArrays](const std::shared_ptr<arrow::Field> &field,
+                                 const std::shared_ptr<arrow::Array> &array)
+        {
+            apoFields.push_back(field);
+            apoArrays.push_back(array);
+            return true;
+        });
+    m_apoBuilders.clear();
+    if (!bRet)
+        return false;
+
+    // Only one row group can be written at a time
+    if (!WaitForPendingRowGroupWrite())
+        return false;
+
+    // Encoding, compression and writing of the column chunks. Must not
+    // emit CPLError(), as it may be run in another thread.
+    auto writeRowGroup = [this, nRows, apoFields = std::move(apoFields),
+                          apoArrays = std::move(apoArrays)]() -> std::string
     {
-        CPLError(CE_Failure, CPLE_AppDefined, "NewRowGroup() failed with %s",
-                 status.message().c_str());
-        m_apoBuilders.clear();
+        auto status = m_poFileWriter->NewRowGroup(nRows);
+        if (!status.ok())
+        {
+            return std::string("NewRowGroup() failed with ")
+                .append(status.message());
+        }
+
+        for (size_t i = 0; i < apoArrays.size(); ++i)
+        {
+            status = m_poFileWriter->WriteColumnChunk(*apoArrays[i]);
+            if (!status.ok())
+            {
+                return std::string("WriteColumnChunk() failed for field ")
+                    .append(apoFields[i]->name())
+                    .append(": ")
+                    .append(status.message());
+            }
+        }
+        return std::string();
+    };
+
+    if (m_bWriteRowGroupsInThread)
+    {
+        m_oPendingRowGroupWrite =
+            std::async(std::launch::async, std::move(writeRowGroup));
+        return true;
+    }
+
+    const std::string osErrorMsg = writeRowGroup();
+    if (!osErrorMsg.empty())
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "%s", osErrorMsg.c_str());
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                           CreateTmpGPKG()                            */
+/************************************************************************/
+
+// Creates the temporary GeoPackage used to store features when
+// SORT_BY_BBOX=YES. Its layer has one field per OGR field, and one binary
+// field per geometry field to store geometries as ISO WKB. Date/time and
+// list fields are stored as strings, so that they round-trip exactly.
+bool OGRParquetWriterLayer::CreateTmpGPKG()
+{
+    auto poGPKGDrv = GetGDALDriverManager()->GetDriverByName("GPKG");
+    if (poGPKGDrv == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "SORT_BY_BBOX=YES requires the GPKG driver");
+        return false;
+    }
+
+    m_osTmpGPKGFilename =
+        std::string(CPLGenerateTempFilename("ogr_parquet_sort")) + ".gpkg";
+    m_poTmpGPKG.reset(poGPKGDrv->Create(m_osTmpGPKGFilename.c_str(), 0, 0, 0,
+                                        GDT_Unknown, nullptr));
+    if (m_poTmpGPKG == nullptr)
         return false;
+
+    auto poLayer = m_poTmpGPKG->CreateLayer("tmp", nullptr, wkbNone);
+    if (poLayer == nullptr)
+        return false;
+
+    const int nFieldCount = m_poFeatureDefn->GetFieldCount();
+    for (int i = 0; i < nFieldCount; ++i)
+    {
+        const auto poSrcFieldDefn = m_poFeatureDefn->GetFieldDefn(i);
+        const auto eType = poSrcFieldDefn->GetType();
+        const bool bAsString =
+            eType == OFTDate || eType == OFTTime || eType == OFTDateTime ||
+            eType == OFTIntegerList || eType == OFTInteger64List ||
+            eType == OFTRealList || eType == OFTStringList;
+        OGRFieldDefn oFieldDefn(CPLSPrintf("f%d", i),
+                                bAsString ? OFTString : eType);
+        if (!bAsString)
+            oFieldDefn.SetSubType(poSrcFieldDefn->GetSubType());
+        if (poLayer->CreateField(&oFieldDefn) != OGRERR_NONE)
+            return false;
     }
 
-    auto ret = WriteArrays(
-        [this](const std::shared_ptr<arrow::Field> &field,
-               const std::shared_ptr<arrow::Array> &array)
+    const int nGeomFieldCount = m_poFeatureDefn->GetGeomFieldCount();
+    for (int i = 0; i < nGeomFieldCount; ++i)
+    {
+        OGRFieldDefn oFieldDefn(CPLSPrintf("g%d", i), OFTBinary);
+        if (poLayer->CreateField(&oFieldDefn) != OGRERR_NONE)
+            return false;
+    }
+
+    if (m_poTmpGPKG->StartTransaction() != OGRERR_NONE)
+        return false;
+    m_poTmpGPKGLayer = poLayer;
+    return true;
+}
+
+/************************************************************************/
+/*                          ICreateFeature()                            */
+/************************************************************************/
+
+OGRErr OGRParquetWriterLayer::ICreateFeature(OGRFeature *poFeature)
+{
+    if (!m_bSortByBBOX)
+        return OGRArrowWriterLayer::ICreateFeature(poFeature);
+
+    if (m_poTmpGPKGLayer == nullptr)
+    {
+        if (m_poTmpGPKG)
+            return OGRERR_FAILURE;  // previous CreateTmpGPKG() failed
+
+        // Freeze the schema, as for the non-sorted case
+        if (m_poSchema == nullptr)
+            CreateSchema();
+        if (!CreateTmpGPKG())
+            return OGRERR_FAILURE;
+    }
+
+    const int nFieldCount = m_poFeatureDefn->GetFieldCount();
+    const int nGeomFieldCount = m_poFeatureDefn->GetGeomFieldCount();
+    for (int i = 0; i < nFieldCount; ++i)
+    {
+        const auto poFieldDefn = m_poFeatureDefn->GetFieldDefn(i);
+        if (!poFieldDefn->IsNullable() &&
+            !poFeature->IsFieldSetAndNotNullUnsafe(i))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Null value found in non-nullable field %s",
+                     poFieldDefn->GetNameRef());
+            return OGRERR_FAILURE;
+        }
+    }
+    for (int i = 0; i < nGeomFieldCount; ++i)
+    {
+        const auto poGeomFieldDefn = m_poFeatureDefn->GetGeomFieldDefn(i);
+        if (!poGeomFieldDefn->IsNullable() &&
+            poFeature->GetGeomFieldRef(i) == nullptr)
         {
-            auto l_status = m_poFileWriter->WriteColumnChunk(*array);
-            if (!l_status.ok())
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Null value found in non-nullable geometry field %s",
+                     poGeomFieldDefn->GetNameRef());
+            return OGRERR_FAILURE;
+        }
+    }
+
+    OGRFeature oTmpFeature(m_poTmpGPKGLayer->GetLayerDefn());
+    for (int i = 0; i < nFieldCount; ++i)
+    {
+        if (!poFeature->IsFieldSetAndNotNullUnsafe(i))
+            continue;
+        switch (m_poFeatureDefn->GetFieldDefn(i)->GetType())
+        {
+            case OFTIntegerList:
+            case OFTInteger64List:
+            case OFTRealList:
+            case OFTStringList:
             {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "WriteColumnChunk() failed for field %s: %s",
-                         field->name().c_str(), l_status.message().c_str());
-                return false;
+                char *pszJSON = poFeature->GetFieldAsSerializedJSon(i);
+                oTmpFeature.SetField(i, pszJSON);
+                CPLFree(pszJSON);
+                break;
             }
-            return true;
-        });
+            case OFTDate:
+            case OFTTime:
+            case OFTDateTime:
+                oTmpFeature.SetField(i, poFeature->GetFieldAsString(i));
+                break;
+            default:
+                oTmpFeature.SetField(i, poFeature->GetRawFieldRef(i));
+                break;
+        }
+    }
 
-    m_apoBuilders.clear();
-    return ret;
+    std::vector<GByte> abyWKB;
+    for (int i = 0; i < nGeomFieldCount; ++i)
+    {
+        const OGRGeometry *poGeom = poFeature->GetGeomFieldRef(i);
+        if (poGeom == nullptr)
+            continue;
+        abyWKB.resize(poGeom->WkbSize());
+        if (poGeom->exportToWkb(wkbNDR, abyWKB.data(), wkbVariantIso) !=
+            OGRERR_NONE)
+        {
+            return OGRERR_FAILURE;
+        }
+        oTmpFeature.SetField(nFieldCount + i, static_cast<int>(abyWKB.size()),
+                             abyWKB.data());
+    }
+
+    if (m_poTmpGPKGLayer->CreateFeature(&oTmpFeature) != OGRERR_NONE)
+        return OGRERR_FAILURE;
+
+    SortItem sItem;
+    sItem.dfX = std::numeric_limits<double>::quiet_NaN();
+    sItem.dfY = std::numeric_limits<double>::quiet_NaN();
+    const OGRGeometry *poGeom =
+        nGeomFieldCount > 0 ? poFeature->GetGeomFieldRef(0) : nullptr;
+    if (poGeom && !poGeom->IsEmpty())
+    {
+        OGREnvelope sEnvelope;
+        poGeom->getEnvelope(&sEnvelope);
+        sItem.dfX = (sEnvelope.MinX + sEnvelope.MaxX) / 2;
+        sItem.dfY = (sEnvelope.MinY + sEnvelope.MaxY) / 2;
+    }
+    sItem.nTmpFID = oTmpFeature.GetFID();
+    sItem.nFID = poFeature->GetFID();
+    if (sItem.nFID == OGRNullFID && !m_osFIDColumn.empty())
+    {
+        sItem.nFID = m_nFeatureCount;
+        poFeature->SetFID(sItem.nFID);
+    }
+    m_asSortItems.push_back(sItem);
+
+    m_nFeatureCount++;
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                             Hilbert()                                */
+/************************************************************************/
+
+// Returns the index along a Hilbert curve of order 16 of (nX, nY), both
+// in the [0, 65535] range.
+static uint32_t Hilbert(uint32_t nX, uint32_t nY)
+{
+    constexpr uint32_t N = 1U << 16;
+    uint32_t nIdx = 0;
+    for (uint32_t s = N / 2; s > 0; s /= 2)
+    {
+        const uint32_t rx = (nX & s) ? 1 : 0;
+        const uint32_t ry = (nY & s) ? 1 : 0;
+        nIdx += s * s * ((3 * rx) ^ ry);
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                nX = N - 1 - nX;
+                nY = N - 1 - nY;
+            }
+            std::swap(nX, nY);
+        }
+    }
+    return nIdx;
+}
+
+/************************************************************************/
+/*                        WriteSortedFeatures()                         */
+/************************************************************************/
+
+// Writes the features of the temporary GeoPackage in the order of a
+// Hilbert curve of the center of their bounding box, so that row groups
+// are spatially clustered and can be efficiently skipped by readers.
+// Features without geometry are written last.
+bool OGRParquetWriterLayer::WriteSortedFeatures()
+{
+    if (m_poTmpGPKG->CommitTransaction() != OGRERR_NONE)
+        return false;
+
+    OGREnvelope sExtent;
+    for (const auto &sItem : m_asSortItems)
+    {
+        if (!std::isnan(sItem.dfX))
+            sExtent.Merge(sItem.dfX, sItem.dfY);
+    }
+    const double dfWidth = sExtent.MaxX - sExtent.MinX;
+    const double dfHeight = sExtent.MaxY - sExtent.MinY;
+    constexpr double HILBERT_MAX = (1U << 16) - 1;
+
+    std::vector<std::pair<uint64_t, size_t>> anKeys;
+    anKeys.reserve(m_asSortItems.size());
+    for (size_t i = 0; i < m_asSortItems.size(); ++i)
+    {
+        const auto &sItem = m_asSortItems[i];
+        uint64_t nKey = std::numeric_limits<uint64_t>::max();
+        if (!std::isnan(sItem.dfX))
+        {
+            const double dfX =
+                dfWidth > 0 ? (sItem.dfX - sExtent.MinX) / dfWidth : 0;
+            const double dfY =
+                dfHeight > 0 ? (sItem.dfY - sExtent.MinY) / dfHeight : 0;
+            nKey = Hilbert(static_cast<uint32_t>(dfX * HILBERT_MAX + 0.5),
+                           static_cast<uint32_t>(dfY * HILBERT_MAX + 0.5));
+        }
+        anKeys.emplace_back(nKey, i);
+    }
+    // Sorting on the pair makes ties follow the insertion order
+    std::sort(anKeys.begin(), anKeys.end());
+
+    // Features are going to be counted again by
+    // OGRArrowWriterLayer::ICreateFeature()
+    m_nFeatureCount = 0;
+
+    const int nFieldCount = m_poFeatureDefn->GetFieldCount();
+    const int nGeomFieldCount = m_poFeatureDefn->GetGeomFieldCount();
+    for (const auto &oKey : anKeys)
+    {
+        const auto &sItem = m_asSortItems[oKey.second];
+        std::unique_ptr<OGRFeature> poTmpFeature(
+            m_poTmpGPKGLayer->GetFeature(sItem.nTmpFID));
+        if (!poTmpFeature)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot read back feature " CPL_FRMT_GIB
+                     " from temporary file",
+                     sItem.nTmpFID);
+            return false;
+        }
+
+        OGRFeature oFeature(m_poFeatureDefn);
+        oFeature.SetFID(sItem.nFID);
+        for (int i = 0; i < nFieldCount; ++i)
+        {
+            if (!poTmpFeature->IsFieldSetAndNotNull(i))
+                continue;
+            if (poTmpFeature->GetFieldDefnRef(i)->GetType() !=
+                m_poFeatureDefn->GetFieldDefn(i)->GetType())
+            {
+                oFeature.SetField(i, poTmpFeature->GetFieldAsString(i));
+            }
+            else
+            {
+                oFeature.SetField(i, poTmpFeature->GetRawFieldRef(i));
+            }
+        }
+        for (int i = 0; i < nGeomFieldCount; ++i)
+        {
+            if (!poTmpFeature->IsFieldSetAndNotNull(nFieldCount + i))
+                continue;
+            int nWKBSize = 0;
+            const GByte *pabyWKB =
+                poTmpFeature->GetFieldAsBinary(nFieldCount + i, &nWKBSize);
+            OGRGeometry *poGeom = nullptr;
+            OGRGeometryFactory::createFromWkb(
+                pabyWKB,
+                m_poFeatureDefn->GetGeomFieldDefn(i)->GetSpatialRef(),
+                &poGeom, nWKBSize);
+            oFeature.SetGeomFieldDirectly(i, poGeom);
+        }
+
+        if (OGRArrowWriterLayer::ICreateFeature(&oFeature) != OGRERR_NONE)
+            return false;
+    }
+
+    return true;
 }
 
 /************************************************************************/
@@ -753,10 +1147,17 @@ OGRParquetWriterLayer::WriteArrowBatch(const struct ArrowSchema *schema,
                                        struct ArrowArray *array,
                                        CSLConstList papszOptions)
 {
+    // Go through ICreateFeature() to store features in the temporary file
+    if (m_bSortByBBOX)
+        return OGRLayer::WriteArrowBatch(schema, array, papszOptions);
+
     return WriteArrowBatchInternal(
         schema, array, papszOptions,
         [this](const std::shared_ptr<arrow::RecordBatch> &poBatch)
         {
+            if (!WaitForPendingRowGroupWrite())
+                return false;
+
             auto status = m_poFileWriter->NewBufferedRowGroup();
             if (!status.ok())
             {
@@ -790,6 +1191,8 @@ inline int OGRParquetWriterLayer::TestCapability(const char *pszCap)
     if (EQUAL(pszCap, OLCFastWriteArrowBatch))
         return false;
 #endif
+    if (m_bSortByBBOX && EQUAL(pszCap, OLCFastWriteArrowBatch))
+        return false;
     return OGRArrowWriterLayer::TestCapability(pszCap);
 }
 
@@ -818,3 +1221,19 @@ bool OGRParquetWriterLayer::IsArrowSchemaSupported(
     return true;
 }
 #endif
+
+/************************************************************************/
+/*                     CreateFieldFromArrowSchema()                     */
+/************************************************************************/
+
+#if PARQUET_VERSION_MAJOR > 10
+bool OGRParquetWriterLayer::CreateFieldFromArrowSchema(
+    const struct ArrowSchema *schema, CSLConstList papszOptions)
+{
+    // Fields must be OGR fields to be stored in the temporary file
+    if (m_bSortByBBOX)
+        return OGRLayer::CreateFieldFromArrowSchema(schema, papszOptions);
+    return OGRArrowWriterLayer::CreateFieldFromArrowSchema(schema,
+                                                           papszOptions);
+}
+#endif
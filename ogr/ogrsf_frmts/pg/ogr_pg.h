@@ -213,6 +213,16 @@ class OGRPGLayer CPL_NON_FINAL : public OGRLayer
     char *pszFIDColumn = nullptr;
 
     int bCanUseBinaryCursor = true;
+
+    // Whether the cursor is fetched in binary format, in which case
+    // geometry and bytea columns are received as raw bytes.
+    bool m_bBinaryFetch = false;
+
+    // Whether the next page of the cursor is requested while the current
+    // one is consumed.
+    bool m_bPipelinedFetch = true;
+    bool m_bNextPageRequested = false;
+    PGresult *m_hNextCursorResult = nullptr;
     int *m_panMapFieldNameToIndex = nullptr;
     int *m_panMapFieldNameToGeomIndex = nullptr;
 
@@ -220,6 +230,9 @@ class OGRPGLayer CPL_NON_FINAL : public OGRLayer
 
     void SetInitialQueryCursor();
     void CloseCursor();
+    void RequestNextPage();
+    PGresult *FetchNextPage();
+    void DiscardNextPage();
 
     virtual CPLString GetFromClauseForGetExtent() = 0;
     OGRErr RunGetExtentRequest(OGREnvelope *psExtent, int bForce,
@@ -265,6 +278,8 @@ class OGRPGLayer CPL_NON_FINAL : public OGRLayer
 
     virtual OGRErr SetNextByIndex(GIntBig nIndex) override;
 
+    void CompletePendingFetch();
+
     OGRPGDataSource *GetDS()
     {
         return poDS;
@@ -321,6 +336,14 @@ class OGRPGTableLayer final : public OGRPGLayer
     OGRErr CreateFeatureViaInsert(OGRFeature *poFeature);
     CPLString BuildCopyFields();
 
+    // Binary COPY: encoding of each copied column, in COPY field order.
+    bool m_bBinaryCopy = false;
+    std::vector<int> m_anBinaryCopyTypes{};
+    std::string m_osBinaryCopyRow{};
+    bool PrepareBinaryCopy();
+    OGRErr CreateFeatureViaBinaryCopy(OGRFeature *poFeature);
+    OGRErr PutCopyData(const char *pabyData, size_t nSize);
+
     int bHasWarnedIncompatibleGeom = false;
     void CheckGeomTypeCompatibility(int iGeomField, OGRGeometry *poGeom);
 
@@ -589,6 +612,9 @@ class OGRPGDataSource final : public OGRDataSource
 
     OGRPGTableLayer *poLayerInCopyMode = nullptr;
 
+    // Layer whose next cursor page has been requested but not yet received.
+    OGRPGLayer *m_poLayerWithPendingFetch = nullptr;
+
     static void OGRPGDecodeVersionString(PGver *psVersion, const char *pszVer);
 
     CPLString osCurrentSchema{};
@@ -636,11 +662,26 @@ class OGRPGDataSource final : public OGRDataSource
     OGRPGDataSource();
     virtual ~OGRPGDataSource();
 
+    // Returns the connection, ready to send a command: any cursor page
+    // requested in the background is received first.
     PGconn *GetPGConn()
+    {
+        CompletePendingFetch();
+        return hPGConn;
+    }
+
+    // Returns the connection without touching a pending cursor fetch.
+    PGconn *GetPGConnKeepingPendingFetch()
     {
         return hPGConn;
     }
 
+    void SetLayerWithPendingFetch(OGRPGLayer *poLayer)
+    {
+        m_poLayerWithPendingFetch = poLayer;
+    }
+    void CompletePendingFetch();
+
     int FetchSRSId(const OGRSpatialReference *poSRS);
     OGRSpatialReference *FetchSRS(int nSRSId);
     static OGRErr InitializeMetadataTables();
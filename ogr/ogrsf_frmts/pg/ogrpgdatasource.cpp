@@ -65,6 +65,8 @@ OGRPGDataSource::~OGRPGDataSource()
 
     if (hPGConn != nullptr)
     {
+        CompletePendingFetch();
+
         // If there are prelude statements, don't mess with transactions.
         if (CSLFetchNameValue(papszOpenOptions, "PRELUDE_STATEMENTS") ==
             nullptr)
@@ -128,6 +130,8 @@ CPLErr OGRPGDataSource::FlushCache(bool bAtClosing)
 
 CPLString OGRPGDataSource::GetCurrentSchema()
 {
+    CompletePendingFetch();
+
     /* -------------------------------------------- */
     /*          Get the current schema              */
     /* -------------------------------------------- */
@@ -345,10 +349,7 @@ int OGRPGDataSource::Open(const char *pszNewName, int bUpdate, int bTestOpen,
     /* -------------------------------------------------------------------- */
     if (STARTS_WITH_CI(pszNewName, "PGB:"))
     {
-#if defined(BINARY_CURSOR_ENABLED)
         bUseBinaryCursor = TRUE;
-        CPLDebug("PG", "BINARY cursor is used for geometry fetching");
-#endif
     }
     else if (!STARTS_WITH_CI(pszNewName, "PG:") &&
              !STARTS_WITH(pszNewName, "postgresql://"))
@@ -984,6 +985,21 @@ int OGRPGDataSource::Open(const char *pszNewName, int bUpdate, int bTestOpen,
     else
         nUndefinedSRID = -1;
 
+    /* -------------------------------------------------------------------- */
+    /*      Fetch geometries of tables as raw EWKB through binary cursors,  */
+    /*      unless PostGIS < 2 where the binary format differs.             */
+    /* -------------------------------------------------------------------- */
+    if (!bUseBinaryCursor)
+        bUseBinaryCursor =
+            CPLTestBool(CPLGetConfigOption("PG_USE_BINARY_CURSOR", "YES"));
+    if (bUseBinaryCursor && bHavePostGIS && sPostGISVersion.nMajor < 2)
+    {
+        CPLDebug("PG", "BINARY cursor will NOT be used because PostGIS < 2");
+        bUseBinaryCursor = FALSE;
+    }
+    if (bUseBinaryCursor)
+        CPLDebug("PG", "BINARY cursor is used for geometry fetching");
+
     GetCurrentSchema();
 
     bListAllTables = CPLTestBool(
@@ -1007,6 +1023,8 @@ void OGRPGDataSource::LoadTables()
         return;
     bHasLoadTables = TRUE;
 
+    CompletePendingFetch();
+
     PGTableEntry **papsTables = nullptr;
     int nTableCount = 0;
     CPLHashSet *hSetTables = nullptr;
@@ -1647,6 +1665,7 @@ OGRErr OGRPGDataSource::DeleteLayer(int iLayer)
         return OGRERR_FAILURE;
 
     EndCopy();
+    CompletePendingFetch();
 
     /* -------------------------------------------------------------------- */
     /*      Blow away our OGR structures related to the layer.  This is     */
@@ -1717,6 +1736,8 @@ OGRLayer *OGRPGDataSource::ICreateLayer(const char *pszLayerName,
     if (pszLayerName == nullptr)
         return nullptr;
 
+    CompletePendingFetch();
+
     EndCopy();
 
     const bool bLaunder = CPLFetchBool(papszOptions, "LAUNDER", true);
@@ -2503,6 +2524,8 @@ OGRSpatialReference *OGRPGDataSource::FetchSRS(int nId)
             return papoSRS[i];
     }
 
+    CompletePendingFetch();
+
     EndCopy();
 
     /* -------------------------------------------------------------------- */
@@ -2576,6 +2599,8 @@ int OGRPGDataSource::FetchSRSId(const OGRSpatialReference *poSRS)
     if (poSRS == nullptr || !m_bHasSpatialRefSys)
         return nUndefinedSRID;
 
+    CompletePendingFetch();
+
     OGRSpatialReference oSRS(*poSRS);
     // cppcheck-suppress uselessAssignmentPtrArg
     poSRS = nullptr;
@@ -3179,6 +3204,7 @@ OGRLayer *OGRPGDataSource::ExecuteSQL(const char *pszSQLCommand,
         pszSQLCommand++;
 
     FlushCache(false);
+    CompletePendingFetch();
 
     /* -------------------------------------------------------------------- */
     /*      Use generic implementation for recognized dialects              */
@@ -3340,6 +3366,16 @@ void OGRPGDataSource::StartCopy(OGRPGTableLayer *poPGLayer)
     poLayerInCopyMode->StartCopy();
 }
 
+/************************************************************************/
+/*                        CompletePendingFetch()                        */
+/************************************************************************/
+
+void OGRPGDataSource::CompletePendingFetch()
+{
+    if (m_poLayerWithPendingFetch != nullptr)
+        m_poLayerWithPendingFetch->CompletePendingFetch();
+}
+
 /************************************************************************/
 /*                              EndCopy()                               */
 /************************************************************************/
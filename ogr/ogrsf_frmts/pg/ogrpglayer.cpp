@@ -78,7 +78,9 @@ PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 /************************************************************************/
 
 OGRPGLayer::OGRPGLayer()
-    : nCursorPage(atoi(CPLGetConfigOption("OGR_PG_CURSOR_PAGE", "500")))
+    : nCursorPage(atoi(CPLGetConfigOption("OGR_PG_CURSOR_PAGE", "500"))),
+      m_bPipelinedFetch(
+          CPLTestBool(CPLGetConfigOption("OGR_PG_CURSOR_PREFETCH", "YES")))
 {
     pszCursorName = CPLStrdup(CPLSPrintf("OGRPGLayerReader%p", this));
 }
@@ -119,6 +121,8 @@ void OGRPGLayer::CloseCursor()
 {
     PGconn *hPGConn = poDS->GetPGConn();
 
+    DiscardNextPage();
+
     if (hCursorResult != nullptr)
     {
         OGRPGClearResult(hCursorResult);
@@ -138,6 +142,91 @@ void OGRPGLayer::CloseCursor()
     }
 }
 
+/************************************************************************/
+/*                          RequestNextPage()                           */
+/*                                                                      */
+/*      Send the FETCH of the next cursor page without waiting for      */
+/*      its result, so that the server produces it while the current    */
+/*      page is turned into features.                                   */
+/************************************************************************/
+
+void OGRPGLayer::RequestNextPage()
+{
+    if (!m_bPipelinedFetch || m_bNextPageRequested ||
+        m_hNextCursorResult != nullptr)
+        return;
+
+    PGconn *hPGConn = poDS->GetPGConn();
+
+    CPLString osCommand;
+    osCommand.Printf("FETCH %d in %s", nCursorPage, pszCursorName);
+    if (OGRPG_PQsendQuery(hPGConn, osCommand, m_bBinaryFetch ? 1 : 0))
+    {
+        m_bNextPageRequested = true;
+        poDS->SetLayerWithPendingFetch(this);
+    }
+}
+
+/************************************************************************/
+/*                        CompletePendingFetch()                        */
+/*                                                                      */
+/*      Receive the page requested by RequestNextPage(), if any. This   */
+/*      is called by the datasource before any other command is sent    */
+/*      on the connection.                                              */
+/************************************************************************/
+
+void OGRPGLayer::CompletePendingFetch()
+{
+    if (!m_bNextPageRequested)
+        return;
+
+    m_bNextPageRequested = false;
+    poDS->SetLayerWithPendingFetch(nullptr);
+
+    CPLString osCommand;
+    osCommand.Printf("FETCH %d in %s", nCursorPage, pszCursorName);
+    CPLAssert(m_hNextCursorResult == nullptr);
+    m_hNextCursorResult = OGRPG_PQgetPendingResult(
+        poDS->GetPGConnKeepingPendingFetch(), osCommand);
+}
+
+/************************************************************************/
+/*                           FetchNextPage()                            */
+/************************************************************************/
+
+PGresult *OGRPGLayer::FetchNextPage()
+{
+    CompletePendingFetch();
+
+    PGresult *hResult = m_hNextCursorResult;
+    m_hNextCursorResult = nullptr;
+    if (hResult == nullptr)
+    {
+        CPLString osCommand;
+        osCommand.Printf("FETCH %d in %s", nCursorPage, pszCursorName);
+        hResult = OGRPG_PQexec(poDS->GetPGConn(), osCommand, FALSE, FALSE,
+                               m_bBinaryFetch ? 1 : 0);
+    }
+
+    if (hResult && PQresultStatus(hResult) == PGRES_TUPLES_OK &&
+        PQntuples(hResult) == nCursorPage)
+    {
+        RequestNextPage();
+    }
+
+    return hResult;
+}
+
+/************************************************************************/
+/*                          DiscardNextPage()                           */
+/************************************************************************/
+
+void OGRPGLayer::DiscardNextPage()
+{
+    CompletePendingFetch();
+    OGRPGClearResult(m_hNextCursorResult);
+}
+
 /************************************************************************/
 /*                       InvalidateCursor()                             */
 /************************************************************************/
@@ -629,6 +718,9 @@ OGRFeature *OGRPGLayer::RecordToFeature(PGresult *hResult,
             (poGeomFieldDefn->ePostgisType == GEOM_TYPE_GEOMETRY ||
              poGeomFieldDefn->ePostgisType == GEOM_TYPE_GEOGRAPHY))
         {
+            // Binary format results hold the raw (E)WKB bytes.
+            const bool bBinaryValue = PQfformat(hResult, iField) == 1;
+
             if (STARTS_WITH_CI(pszFieldName, "ST_AsBinary") ||
                 STARTS_WITH_CI(pszFieldName, "AsBinary"))
             {
@@ -641,7 +733,7 @@ OGRFeature *OGRPGLayer::RecordToFeature(PGresult *hResult,
                     continue;
 
                 OGRGeometry *poGeom = nullptr;
-                if (!poDS->bUseBinaryCursor && nLength >= 4 &&
+                if (!bBinaryValue && nLength >= 4 &&
                     /* escaped byea data */
                     (STARTS_WITH(pszVal, "\\000") ||
                      STARTS_WITH(pszVal, "\\001") ||
@@ -671,7 +763,7 @@ OGRFeature *OGRPGLayer::RecordToFeature(PGresult *hResult,
 
                 continue;
             }
-            else if (!poDS->bUseBinaryCursor &&
+            else if (!bBinaryValue &&
                      STARTS_WITH_CI(pszFieldName, "EWKBBase64"))
             {
                 const GByte *pabyData = reinterpret_cast<const GByte *>(
@@ -698,8 +790,7 @@ OGRFeature *OGRPGLayer::RecordToFeature(PGresult *hResult,
 
                 continue;
             }
-            else if (poDS->bUseBinaryCursor ||
-                     EQUAL(pszFieldName, "ST_AsEWKB") ||
+            else if (bBinaryValue || EQUAL(pszFieldName, "ST_AsEWKB") ||
                      EQUAL(pszFieldName, "AsEWKB"))
             {
                 /* Handle HEX result or EWKB binary cursor result */
@@ -713,11 +804,19 @@ OGRFeature *OGRPGLayer::RecordToFeature(PGresult *hResult,
 
                 OGRGeometry *poGeom = nullptr;
 
-                if (!poDS->bUseBinaryCursor &&
-                    (STARTS_WITH(pabyData, "\\x00") ||
-                     STARTS_WITH(pabyData, "\\x01") ||
-                     STARTS_WITH(pabyData, "\\000") ||
-                     STARTS_WITH(pabyData, "\\001")))
+                if (bBinaryValue)
+                {
+                    // Potentially dangerous to modify the result of
+                    // PQgetvalue...
+                    poGeom = OGRGeometryFromEWKB(
+                        const_cast<GByte *>(
+                            reinterpret_cast<const GByte *>(pabyData)),
+                        nLength, nullptr, poDS->sPostGISVersion.nMajor < 2);
+                }
+                else if (STARTS_WITH(pabyData, "\\x00") ||
+                         STARTS_WITH(pabyData, "\\x01") ||
+                         STARTS_WITH(pabyData, "\\000") ||
+                         STARTS_WITH(pabyData, "\\001"))
                 {
                     GByte *pabyEWKB = BYTEAToGByteArray(pabyData, &nLength);
                     poGeom =
@@ -807,18 +906,15 @@ OGRFeature *OGRPGLayer::RecordToFeature(PGresult *hResult,
             }
             else
             {
-#if defined(BINARY_CURSOR_ENABLED)
-                if (poDS->bUseBinaryCursor && PQfformat(hResult, iField) == 1)
+                if (PQfformat(hResult, iField) == 1)
                 {
-                    int nLength = PQgetlength(hResult, iRecord, iField);
-                    const GByte *pabyData =
-                        reinterpret_cast<const GByte *>(pszData);
-                    poGeometry =
-                        OGRGeometryFromEWKB(pabyData, nLength, NULL,
-                                            poDS->sPostGISVersion.nMajor < 2);
+                    const int nLength = PQgetlength(hResult, iRecord, iField);
+                    OGRGeometryFactory::createFromWkb(
+                        pszData, nullptr, &poGeometry, nLength,
+                        (poDS->sPostGISVersion.nMajor < 2) ? wkbVariantPostGIS1
+                                                           : wkbVariantOldOgc);
                 }
-                if (poGeometry == nullptr)
-#endif
+                else
                 {
                     poGeometry = BYTEAToGeometry(
                         pszData, (poDS->sPostGISVersion.nMajor < 2));
@@ -1252,16 +1348,14 @@ OGRFeature *OGRPGLayer::RecordToFeature(PGresult *hResult,
         }
         else if (eOGRType == OFTBinary)
         {
-#if defined(BINARY_CURSOR_ENABLED)
             if (PQfformat(hResult, iField) == 1)
             {
-                int nLength = PQgetlength(hResult, iRecord, iField);
-                GByte *pabyData = reinterpret_cast<GByte *>(
+                const int nLength = PQgetlength(hResult, iRecord, iField);
+                const GByte *pabyData = reinterpret_cast<const GByte *>(
                     PQgetvalue(hResult, iRecord, iField));
                 poFeature->SetField(iOGRField, nLength, pabyData);
             }
             else
-#endif /* defined(BINARY_CURSOR_ENABLED) */
             {
                 int nLength = PQgetlength(hResult, iRecord, iField);
                 const char *pszBytea = PQgetvalue(hResult, iRecord, iField);
@@ -1497,12 +1591,14 @@ void OGRPGLayer::SetInitialQueryCursor()
 
     poDS->SoftStartTransaction();
 
-#if defined(BINARY_CURSOR_ENABLED)
-    if (poDS->bUseBinaryCursor && bCanUseBinaryCursor)
+    // Note that with the extended query protocol used by OGRPG_PQexec(), the
+    // result format requested by each FETCH takes precedence over the one
+    // of the cursor declaration.
+    m_bBinaryFetch = poDS->bUseBinaryCursor && bCanUseBinaryCursor;
+    if (m_bBinaryFetch)
         osCommand.Printf("DECLARE %s BINARY CURSOR for %s", pszCursorName,
                          pszQueryStatement);
     else
-#endif
         osCommand.Printf("DECLARE %s CURSOR for %s", pszCursorName,
                          pszQueryStatement);
 
@@ -1514,8 +1610,7 @@ void OGRPGLayer::SetInitialQueryCursor()
     }
     OGRPGClearResult(hCursorResult);
 
-    osCommand.Printf("FETCH %d in %s", nCursorPage, pszCursorName);
-    hCursorResult = OGRPG_PQexec(hPGConn, osCommand);
+    hCursorResult = FetchNextPage();
 
     CreateMapFromFieldNameToIndex(hCursorResult, poFeatureDefn,
                                   m_panMapFieldNameToIndex,
@@ -1531,9 +1626,6 @@ void OGRPGLayer::SetInitialQueryCursor()
 OGRFeature *OGRPGLayer::GetNextRawFeature()
 
 {
-    PGconn *hPGConn = poDS->GetPGConn();
-    CPLString osCommand;
-
     if (bInvalidated)
     {
         CPLError(CE_Failure, CPLE_AppDefined,
@@ -1576,8 +1668,7 @@ OGRFeature *OGRPGLayer::GetNextRawFeature()
     {
         OGRPGClearResult(hCursorResult);
 
-        osCommand.Printf("FETCH %d in %s", nCursorPage, pszCursorName);
-        hCursorResult = OGRPG_PQexec(hPGConn, osCommand);
+        hCursorResult = FetchNextPage();
 
         nResultOffset = 0;
     }
@@ -1646,10 +1737,13 @@ OGRErr OGRPGLayer::SetNextByIndex(GIntBig nIndex)
     }
 
     OGRPGClearResult(hCursorResult);
+    // The page fetched in advance, if any, is no longer the next one.
+    DiscardNextPage();
 
     osCommand.Printf("FETCH ABSOLUTE " CPL_FRMT_GIB " in %s", nIndex + 1,
                      pszCursorName);
-    hCursorResult = OGRPG_PQexec(hPGConn, osCommand);
+    hCursorResult =
+        OGRPG_PQexec(hPGConn, osCommand, FALSE, FALSE, m_bBinaryFetch ? 1 : 0);
 
     if (PQresultStatus(hCursorResult) != PGRES_TUPLES_OK ||
         PQntuples(hCursorResult) != 1)
@@ -46,6 +46,10 @@ OGRPGResultLayer::OGRPGResultLayer(OGRPGDataSource *poDSIn,
 
     iNextShapeId = 0;
 
+    // The columns of an arbitrary SQL request are of any type, so only the
+    // text representation can be decoded.
+    bCanUseBinaryCursor = FALSE;
+
     BuildFullQueryStatement();
 
     ReadResultDefinition(hInitialResultIn);
@@ -35,7 +35,10 @@
 #include "ogr_p.h"
 
 #include <chrono>
+#include <climits>
 #include <condition_variable>
+#include <limits>
+#include <map>
 #include <mutex>
 #include <thread>
 
@@ -1041,10 +1044,26 @@ CPLString OGRPGTableLayer::BuildFields()
 
     poFeatureDefn->GetFieldCount();
 
+    // With a binary cursor, only geometry and bytea columns are fetched in
+    // their binary representation. Other columns are cast to text, whose
+    // binary representation is the same as the text one, so that they are
+    // decoded as with a regular cursor.
+    const auto AppendColumn = [this, &osFieldList](const char *pszName,
+                                                   bool bCastToText)
+    {
+        if (poDS->bUseBinaryCursor && bCastToText)
+        {
+            osFieldList += "CAST(";
+            osFieldList += OGRPGEscapeColumnName(pszName);
+            osFieldList += " AS text) AS ";
+        }
+        osFieldList += OGRPGEscapeColumnName(pszName);
+    };
+
     if (pszFIDColumn != nullptr &&
         poFeatureDefn->GetFieldIndex(pszFIDColumn) == -1)
     {
-        osFieldList += OGRPGEscapeColumnName(pszFIDColumn);
+        AppendColumn(pszFIDColumn, true);
     }
 
     for (i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++)
@@ -1102,18 +1121,15 @@ CPLString OGRPGTableLayer::BuildFields()
         }
         else if (poGeomFieldDefn->ePostgisType == GEOM_TYPE_GEOGRAPHY)
         {
-#if defined(BINARY_CURSOR_ENABLED)
             if (poDS->bUseBinaryCursor)
             {
                 osFieldList += "ST_AsBinary(";
                 osFieldList += osEscapedGeom;
-                osFieldList += ") AS";
+                osFieldList += ") AS ";
                 osFieldList += OGRPGEscapeColumnName(
                     CPLSPrintf("AsBinary_%s", poGeomFieldDefn->GetNameRef()));
             }
-            else
-#endif
-                if (CPLTestBool(CPLGetConfigOption("PG_USE_BASE64", "NO")))
+            else if (CPLTestBool(CPLGetConfigOption("PG_USE_BASE64", "NO")))
             {
                 osFieldList += "encode(ST_AsEWKB(";
                 osFieldList += osEscapedGeom;
@@ -1139,21 +1155,8 @@ CPLString OGRPGTableLayer::BuildFields()
         if (!osFieldList.empty())
             osFieldList += ", ";
 
-#if defined(BINARY_CURSOR_ENABLED)
-        /* With a binary cursor, it is not possible to get the time zone */
-        /* of a timestamptz column. So we fallback to asking it in text mode */
-        if (poDS->bUseBinaryCursor &&
-            poFeatureDefn->GetFieldDefn(i)->GetType() == OFTDateTime)
-        {
-            osFieldList += "CAST (";
-            osFieldList += OGRPGEscapeColumnName(pszName);
-            osFieldList += " AS text)";
-        }
-        else
-#endif
-        {
-            osFieldList += OGRPGEscapeColumnName(pszName);
-        }
+        AppendColumn(pszName,
+                     poFeatureDefn->GetFieldDefn(i)->GetType() != OFTBinary);
     }
 
     return osFieldList;
@@ -1980,6 +1983,9 @@ OGRErr OGRPGTableLayer::CreateFeatureViaCopy(OGRFeature *poFeature)
     /* Tell the datasource we are now planning to copy data */
     poDS->StartCopy(this);
 
+    if (m_bBinaryCopy)
+        return CreateFeatureViaBinaryCopy(poFeature);
+
     /* First process geometry */
     for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++)
     {
@@ -2053,14 +2059,467 @@ OGRErr OGRPGTableLayer::CreateFeatureViaCopy(OGRFeature *poFeature)
     /*      Execute the copy.                                       */
     /* ------------------------------------------------------------ */
 
-    OGRErr result = OGRERR_NONE;
-
-    int copyResult = PQputCopyData(hPGConn, osCommand.c_str(),
-                                   static_cast<int>(osCommand.size()));
 #ifdef DEBUG_VERBOSE
     CPLDebug("PG", "PQputCopyData(%s)", osCommand.c_str());
 #endif
 
+    return PutCopyData(osCommand.c_str(), osCommand.size());
+}
+
+/************************************************************************/
+/*                     Binary COPY encoding helpers                     */
+/************************************************************************/
+
+namespace
+{
+// Encoding of a column in a binary COPY, derived from its PostgreSQL type.
+enum PGBinaryCopyType
+{
+    PG_BINARY_COPY_BOOL,
+    PG_BINARY_COPY_INT2,
+    PG_BINARY_COPY_INT4,
+    PG_BINARY_COPY_INT8,
+    PG_BINARY_COPY_FLOAT4,
+    PG_BINARY_COPY_FLOAT8,
+    PG_BINARY_COPY_TEXT,
+    PG_BINARY_COPY_JSONB,
+    PG_BINARY_COPY_BYTEA,
+    PG_BINARY_COPY_DATE,
+    PG_BINARY_COPY_GEOMETRY,
+};
+}  // namespace
+
+static void AppendInt16BE(std::string &osBuf, GInt16 nVal)
+{
+    CPL_MSBPTR16(&nVal);
+    osBuf.append(reinterpret_cast<const char *>(&nVal), sizeof(nVal));
+}
+
+static void AppendInt32BE(std::string &osBuf, GInt32 nVal)
+{
+    CPL_MSBPTR32(&nVal);
+    osBuf.append(reinterpret_cast<const char *>(&nVal), sizeof(nVal));
+}
+
+static void AppendInt64BE(std::string &osBuf, GInt64 nVal)
+{
+    CPL_MSBPTR64(&nVal);
+    osBuf.append(reinterpret_cast<const char *>(&nVal), sizeof(nVal));
+}
+
+/************************************************************************/
+/*                         PrepareBinaryCopy()                          */
+/*                                                                      */
+/*      Determine how each copied column is encoded in a binary COPY.   */
+/*      As the server does not cast values received in binary format,   */
+/*      this is only possible if all columns are of a type whose binary */
+/*      representation we know how to produce from the OGR value.       */
+/************************************************************************/
+
+bool OGRPGTableLayer::PrepareBinaryCopy()
+{
+    m_anBinaryCopyTypes.clear();
+
+    if (!CPLTestBool(CPLGetConfigOption("PG_USE_BINARY_COPY", "YES")) ||
+        poDS->sPostgreSQLVersion.nMajor < 9)
+    {
+        return false;
+    }
+
+    PGconn *hPGConn = poDS->GetPGConn();
+    CPLString osCommand;
+    osCommand.Printf("SELECT a.attname, t.typname FROM pg_attribute a "
+                     "JOIN pg_type t ON t.oid = a.atttypid "
+                     "WHERE a.attrelid = %s::regclass AND a.attnum > 0 "
+                     "AND NOT a.attisdropped",
+                     OGRPGEscapeString(hPGConn, pszSqlTableName).c_str());
+    PGresult *hResult = OGRPG_PQexec(hPGConn, osCommand.c_str());
+    if (!hResult || PQresultStatus(hResult) != PGRES_TUPLES_OK)
+    {
+        OGRPGClearResult(hResult);
+        return false;
+    }
+    std::map<std::string, std::string> oMapColumnToType;
+    for (int i = 0; i < PQntuples(hResult); i++)
+    {
+        oMapColumnToType[PQgetvalue(hResult, i, 0)] = PQgetvalue(hResult, i, 1);
+    }
+    OGRPGClearResult(hResult);
+
+    const auto GetColumnType = [&oMapColumnToType](const char *pszName)
+    {
+        const auto oIter = oMapColumnToType.find(pszName);
+        return oIter == oMapColumnToType.end() ? std::string()
+                                               : oIter->second;
+    };
+
+    for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++)
+    {
+        const OGRPGGeomFieldDefn *poGeomFieldDefn =
+            poFeatureDefn->GetGeomFieldDefn(i);
+        const std::string osType =
+            GetColumnType(poGeomFieldDefn->GetNameRef());
+        if (poDS->sPostGISVersion.nMajor < 2 ||
+            !((poGeomFieldDefn->ePostgisType == GEOM_TYPE_GEOMETRY &&
+               osType == "geometry") ||
+              (poGeomFieldDefn->ePostgisType == GEOM_TYPE_GEOGRAPHY &&
+               osType == "geography")))
+        {
+            CPLDebug("PG", "Cannot use binary COPY for column %s of type %s",
+                     poGeomFieldDefn->GetNameRef(), osType.c_str());
+            return false;
+        }
+        m_anBinaryCopyTypes.push_back(PG_BINARY_COPY_GEOMETRY);
+    }
+
+    int nFIDIndex = -1;
+    if (bFIDColumnInCopyFields)
+    {
+        nFIDIndex = poFeatureDefn->GetFieldIndex(pszFIDColumn);
+        const std::string osType = GetColumnType(pszFIDColumn);
+        if (osType == "int4")
+            m_anBinaryCopyTypes.push_back(PG_BINARY_COPY_INT4);
+        else if (osType == "int8")
+            m_anBinaryCopyTypes.push_back(PG_BINARY_COPY_INT8);
+        else
+        {
+            CPLDebug("PG", "Cannot use binary COPY for column %s of type %s",
+                     pszFIDColumn, osType.c_str());
+            return false;
+        }
+    }
+
+    for (int i = 0; i < poFeatureDefn->GetFieldCount(); i++)
+    {
+        if (i == nFIDIndex || m_abGeneratedColumns[i])
+            continue;
+
+        const OGRFieldDefn *poFieldDefn = poFeatureDefn->GetFieldDefn(i);
+        const OGRFieldType eType = poFieldDefn->GetType();
+        const std::string osType = GetColumnType(poFieldDefn->GetNameRef());
+        const bool bIsInteger = eType == OFTInteger || eType == OFTInteger64;
+
+        int nBinaryCopyType = -1;
+        if (osType == "bool" && eType == OFTInteger &&
+            poFieldDefn->GetSubType() == OFSTBoolean)
+            nBinaryCopyType = PG_BINARY_COPY_BOOL;
+        else if (osType == "int2" && bIsInteger)
+            nBinaryCopyType = PG_BINARY_COPY_INT2;
+        else if (osType == "int4" && bIsInteger)
+            nBinaryCopyType = PG_BINARY_COPY_INT4;
+        else if (osType == "int8" && bIsInteger)
+            nBinaryCopyType = PG_BINARY_COPY_INT8;
+        else if (osType == "float4" && (bIsInteger || eType == OFTReal))
+            nBinaryCopyType = PG_BINARY_COPY_FLOAT4;
+        else if (osType == "float8" && (bIsInteger || eType == OFTReal))
+            nBinaryCopyType = PG_BINARY_COPY_FLOAT8;
+        else if ((osType == "text" || osType == "varchar" ||
+                  osType == "bpchar" || osType == "json") &&
+                 eType == OFTString)
+            nBinaryCopyType = PG_BINARY_COPY_TEXT;
+        else if (osType == "jsonb" && eType == OFTString)
+            nBinaryCopyType = PG_BINARY_COPY_JSONB;
+        else if (osType == "bytea" && eType == OFTBinary)
+            nBinaryCopyType = PG_BINARY_COPY_BYTEA;
+        else if (osType == "date" && eType == OFTDate)
+            nBinaryCopyType = PG_BINARY_COPY_DATE;
+
+        if (nBinaryCopyType < 0)
+        {
+            CPLDebug("PG", "Cannot use binary COPY for column %s of type %s",
+                     poFieldDefn->GetNameRef(), osType.c_str());
+            return false;
+        }
+        m_anBinaryCopyTypes.push_back(nBinaryCopyType);
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                     CreateFeatureViaBinaryCopy()                     */
+/************************************************************************/
+
+OGRErr OGRPGTableLayer::CreateFeatureViaBinaryCopy(OGRFeature *poFeature)
+{
+    std::string &osRow = m_osBinaryCopyRow;
+    osRow.clear();
+    AppendInt16BE(osRow, static_cast<GInt16>(m_anBinaryCopyTypes.size()));
+
+    size_t iCopyField = 0;
+
+    /* First process geometry */
+    for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++, iCopyField++)
+    {
+        OGRPGGeomFieldDefn *poGeomFieldDefn =
+            poFeatureDefn->GetGeomFieldDefn(i);
+        OGRGeometry *poGeom = poFeature->GetGeomFieldRef(i);
+        if (poGeom == nullptr)
+        {
+            AppendInt32BE(osRow, -1);
+            continue;
+        }
+
+        CheckGeomTypeCompatibility(i, poGeom);
+
+        poGeom->closeRings();
+        poGeom->set3D(poGeomFieldDefn->GeometryTypeFlags &
+                      OGRGeometry::OGR_G_3D);
+        poGeom->setMeasured(poGeomFieldDefn->GeometryTypeFlags &
+                            OGRGeometry::OGR_G_MEASURED);
+
+        // Same EWKB as OGRGeometryToHexEWKB(), without the hex encoding.
+        const size_t nWkbSize = poGeom->WkbSize();
+        const int nSRSId = poGeomFieldDefn->nSRSId;
+        const size_t nEWKBSize = nWkbSize + (nSRSId > 0 ? 4 : 0);
+        if (nEWKBSize > static_cast<size_t>(std::numeric_limits<int>::max()))
+        {
+            CPLError(CE_Failure, CPLE_NotSupported, "Too large geometry");
+            return OGRERR_FAILURE;
+        }
+        std::vector<GByte> abyWKB(nWkbSize);
+        const bool bEmptyPoint =
+            (poDS->sPostGISVersion.nMajor > 2 ||
+             (poDS->sPostGISVersion.nMajor == 2 &&
+              poDS->sPostGISVersion.nMinor >= 2)) &&
+            wkbFlatten(poGeom->getGeometryType()) == wkbPoint &&
+            poGeom->IsEmpty();
+        if (poGeom->exportToWkb(wkbNDR, abyWKB.data(),
+                                bEmptyPoint ? wkbVariantIso
+                                            : wkbVariantOldOgc) != OGRERR_NONE)
+        {
+            return OGRERR_FAILURE;
+        }
+
+        AppendInt32BE(osRow, static_cast<GInt32>(nEWKBSize));
+        osRow.append(reinterpret_cast<const char *>(abyWKB.data()), 1);
+        GUInt32 nGeomType;
+        memcpy(&nGeomType, abyWKB.data() + 1, 4);
+        if (nSRSId > 0)
+        {
+            constexpr GUInt32 WKBSRIDFLAG = 0x20000000;
+            nGeomType |= CPL_LSBWORD32(WKBSRIDFLAG);
+        }
+        osRow.append(reinterpret_cast<const char *>(&nGeomType), 4);
+        if (nSRSId > 0)
+        {
+            const GUInt32 nGSRSId = CPL_LSBWORD32(nSRSId);
+            osRow.append(reinterpret_cast<const char *>(&nGSRSId), 4);
+        }
+        osRow.append(reinterpret_cast<const char *>(abyWKB.data()) + 5,
+                     nWkbSize - 5);
+    }
+
+    int nFIDIndex = -1;
+    if (bFIDColumnInCopyFields)
+    {
+        nFIDIndex = poFeatureDefn->GetFieldIndex(pszFIDColumn);
+        const GIntBig nFID = poFeature->GetFID();
+        if (nFID == OGRNullFID)
+            AppendInt32BE(osRow, -1);
+        else if (m_anBinaryCopyTypes[iCopyField] == PG_BINARY_COPY_INT8)
+        {
+            AppendInt32BE(osRow, 8);
+            AppendInt64BE(osRow, nFID);
+        }
+        else if (nFID < INT_MIN || nFID > INT_MAX)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "FID " CPL_FRMT_GIB " out of range of column %s", nFID,
+                     pszFIDColumn);
+            return OGRERR_FAILURE;
+        }
+        else
+        {
+            AppendInt32BE(osRow, 4);
+            AppendInt32BE(osRow, static_cast<GInt32>(nFID));
+        }
+        iCopyField++;
+    }
+
+    for (int i = 0; i < poFeatureDefn->GetFieldCount(); i++)
+    {
+        if (i == nFIDIndex || m_abGeneratedColumns[i])
+            continue;
+
+        const int nBinaryCopyType = m_anBinaryCopyTypes[iCopyField++];
+        if (!poFeature->IsFieldSetAndNotNull(i))
+        {
+            AppendInt32BE(osRow, -1);
+            continue;
+        }
+
+        const auto CheckIntegerRange =
+            [poFeature, this, i](GIntBig nVal, GIntBig nMin, GIntBig nMax)
+        {
+            if (nVal >= nMin && nVal <= nMax)
+                return true;
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Value " CPL_FRMT_GIB " of field %s of feature " CPL_FRMT_GIB
+                     " out of range",
+                     nVal, poFeatureDefn->GetFieldDefn(i)->GetNameRef(),
+                     poFeature->GetFID());
+            return false;
+        };
+
+        switch (nBinaryCopyType)
+        {
+            case PG_BINARY_COPY_BOOL:
+            {
+                AppendInt32BE(osRow, 1);
+                osRow += poFeature->GetFieldAsInteger(i) ? '\1' : '\0';
+                break;
+            }
+
+            case PG_BINARY_COPY_INT2:
+            {
+                const GIntBig nVal = poFeature->GetFieldAsInteger64(i);
+                if (!CheckIntegerRange(nVal, SHRT_MIN, SHRT_MAX))
+                    return OGRERR_FAILURE;
+                AppendInt32BE(osRow, 2);
+                AppendInt16BE(osRow, static_cast<GInt16>(nVal));
+                break;
+            }
+
+            case PG_BINARY_COPY_INT4:
+            {
+                const GIntBig nVal = poFeature->GetFieldAsInteger64(i);
+                if (!CheckIntegerRange(nVal, INT_MIN, INT_MAX))
+                    return OGRERR_FAILURE;
+                AppendInt32BE(osRow, 4);
+                AppendInt32BE(osRow, static_cast<GInt32>(nVal));
+                break;
+            }
+
+            case PG_BINARY_COPY_INT8:
+            {
+                AppendInt32BE(osRow, 8);
+                AppendInt64BE(osRow, poFeature->GetFieldAsInteger64(i));
+                break;
+            }
+
+            case PG_BINARY_COPY_FLOAT4:
+            {
+                float fVal = static_cast<float>(poFeature->GetFieldAsDouble(i));
+                CPL_MSBPTR32(&fVal);
+                AppendInt32BE(osRow, 4);
+                osRow.append(reinterpret_cast<const char *>(&fVal), 4);
+                break;
+            }
+
+            case PG_BINARY_COPY_FLOAT8:
+            {
+                double dfVal = poFeature->GetFieldAsDouble(i);
+                CPL_MSBPTR64(&dfVal);
+                AppendInt32BE(osRow, 8);
+                osRow.append(reinterpret_cast<const char *>(&dfVal), 8);
+                break;
+            }
+
+            case PG_BINARY_COPY_TEXT:
+            case PG_BINARY_COPY_JSONB:
+            {
+                const char *pszStrValue = poFeature->GetFieldAsString(i);
+
+                // PostgreSQL doesn't provide very helpful reporting of
+                // invalid UTF-8 content in COPY mode.
+                if (poDS->IsUTF8ClientEncoding() && !CPLIsUTF8(pszStrValue, -1))
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "Non UTF-8 content found when writing feature "
+                             CPL_FRMT_GIB " of layer %s: %s",
+                             poFeature->GetFID(), poFeatureDefn->GetName(),
+                             pszStrValue);
+                    return OGRERR_FAILURE;
+                }
+
+                // Truncate to the field width as the text COPY does.
+                size_t nLen = 0;
+                const int nMaxWidth =
+                    poFeatureDefn->GetFieldDefn(i)->GetWidth();
+                for (int iUTFChar = 0; pszStrValue[nLen] != '\0'; nLen++)
+                {
+                    if ((pszStrValue[nLen] & 0xc0) != 0x80)
+                    {
+                        if (nMaxWidth > 0 && iUTFChar == nMaxWidth)
+                        {
+                            CPLDebug(
+                                "PG",
+                                "Truncated %s field value, it was too long.",
+                                poFeatureDefn->GetFieldDefn(i)->GetNameRef());
+                            break;
+                        }
+                        iUTFChar++;
+                    }
+                }
+
+                if (nBinaryCopyType == PG_BINARY_COPY_JSONB)
+                {
+                    // jsonb binary format is a version number followed by
+                    // the JSON text.
+                    AppendInt32BE(osRow, static_cast<GInt32>(nLen + 1));
+                    osRow += '\1';
+                }
+                else
+                {
+                    AppendInt32BE(osRow, static_cast<GInt32>(nLen));
+                }
+                osRow.append(pszStrValue, nLen);
+                break;
+            }
+
+            case PG_BINARY_COPY_BYTEA:
+            {
+                int nLen = 0;
+                const GByte *pabyData = poFeature->GetFieldAsBinary(i, &nLen);
+                AppendInt32BE(osRow, nLen);
+                osRow.append(reinterpret_cast<const char *>(pabyData), nLen);
+                break;
+            }
+
+            case PG_BINARY_COPY_DATE:
+            {
+                // Number of days since 2000-01-01, computed from the
+                // proleptic Gregorian calendar.
+                const OGRField *psField = poFeature->GetRawFieldRef(i);
+                int nYear = psField->Date.Year;
+                const int nMonth = psField->Date.Month;
+                const int nDay = psField->Date.Day;
+                nYear -= nMonth <= 2 ? 1 : 0;
+                const int nEra = (nYear >= 0 ? nYear : nYear - 399) / 400;
+                const int nYearOfEra = nYear - nEra * 400;
+                const int nDayOfYear =
+                    (153 * (nMonth + (nMonth > 2 ? -3 : 9)) + 2) / 5 + nDay - 1;
+                const int nDayOfEra = nYearOfEra * 365 + nYearOfEra / 4 -
+                                      nYearOfEra / 100 + nDayOfYear;
+                // 730425 is the number of days from 0000-03-01 to 2000-01-01
+                const GInt32 nDaysSince2000 =
+                    nEra * 146097 + nDayOfEra - 730425;
+                AppendInt32BE(osRow, 4);
+                AppendInt32BE(osRow, nDaysSince2000);
+                break;
+            }
+
+            default:
+                CPLAssert(false);
+                return OGRERR_FAILURE;
+        }
+    }
+
+    return PutCopyData(osRow.data(), osRow.size());
+}
+
+/************************************************************************/
+/*                            PutCopyData()                             */
+/************************************************************************/
+
+OGRErr OGRPGTableLayer::PutCopyData(const char *pabyData, size_t nSize)
+{
+    PGconn *hPGConn = poDS->GetPGConn();
+    OGRErr result = OGRERR_NONE;
+
+    int copyResult = PQputCopyData(hPGConn, pabyData, static_cast<int>(nSize));
+
     switch (copyResult)
     {
         case 0:
@@ -3106,7 +3565,8 @@ OGRFeature *OGRPGTableLayer::GetFeature(GIntBig nFeatureId)
     {
         OGRPGClearResult(hResult);
 
-        hResult = OGRPG_PQexec(hPGConn, "FETCH ALL in getfeaturecursor");
+        hResult = OGRPG_PQexec(hPGConn, "FETCH ALL in getfeaturecursor", FALSE,
+                               FALSE, poDS->bUseBinaryCursor ? 1 : 0);
 
         if (hResult && PQresultStatus(hResult) == PGRES_TUPLES_OK)
         {
@@ -3283,12 +3743,15 @@ OGRErr OGRPGTableLayer::StartCopy()
     /*CPLDebug("PG", "OGRPGDataSource(%p)::StartCopy(%p)", poDS, this);*/
 
     CPLString osFields = BuildCopyFields();
+    m_bBinaryCopy = PrepareBinaryCopy();
 
     size_t size = osFields.size() + strlen(pszSqlTableName) + 100;
     char *pszCommand = static_cast<char *>(CPLMalloc(size));
 
-    snprintf(pszCommand, size, "COPY %s (%s) FROM STDIN;", pszSqlTableName,
-             osFields.c_str());
+    snprintf(pszCommand, size,
+             m_bBinaryCopy ? "COPY %s (%s) FROM STDIN WITH (FORMAT binary);"
+                           : "COPY %s (%s) FROM STDIN;",
+             pszSqlTableName, osFields.c_str());
 
     PGconn *hPGConn = poDS->GetPGConn();
     PGresult *hResult = OGRPG_PQexec(hPGConn, pszCommand);
@@ -3298,8 +3761,19 @@ OGRErr OGRPGTableLayer::StartCopy()
         CPLError(CE_Failure, CPLE_AppDefined, "%s", PQerrorMessage(hPGConn));
     }
     else
+    {
         bCopyActive = TRUE;
 
+        if (m_bBinaryCopy)
+        {
+            // Signature, flags and header extension length.
+            std::string osHeader("PGCOPY\n\377\r\n\0", 11);
+            AppendInt32BE(osHeader, 0);
+            AppendInt32BE(osHeader, 0);
+            PutCopyData(osHeader.data(), osHeader.size());
+        }
+    }
+
     OGRPGClearResult(hResult);
     CPLFree(pszCommand);
 
@@ -3326,6 +3800,14 @@ OGRErr OGRPGTableLayer::EndCopy()
 
     bCopyActive = FALSE;
 
+    if (m_bBinaryCopy)
+    {
+        // File trailer
+        std::string osTrailer;
+        AppendInt16BE(osTrailer, -1);
+        result = PutCopyData(osTrailer.data(), osTrailer.size());
+    }
+
     int copyResult = PQputCopyEnd(hPGConn, nullptr);
 
     switch (copyResult)
@@ -34,12 +34,13 @@
 /************************************************************************/
 
 PGresult *OGRPG_PQexec(PGconn *conn, const char *query,
-                       int bMultipleCommandAllowed, int bErrorAsDebug)
+                       int bMultipleCommandAllowed, int bErrorAsDebug,
+                       int nResultFormat)
 {
     PGresult *hResult = bMultipleCommandAllowed
                             ? PQexec(conn, query)
                             : PQexecParams(conn, query, 0, nullptr, nullptr,
-                                           nullptr, nullptr, 0);
+                                           nullptr, nullptr, nResultFormat);
 
 #ifdef DEBUG
     const char *pszRetCode = "UNKNOWN";
@@ -87,6 +88,59 @@ PGresult *OGRPG_PQexec(PGconn *conn, const char *query,
     return hResult;
 }
 
+/************************************************************************/
+/*                         OGRPG_PQsendQuery()                          */
+/*                                                                      */
+/*      Dispatch a single command without waiting for its result,       */
+/*      which must then be collected with OGRPG_PQgetPendingResult()    */
+/*      before anything else is sent on the connection.                 */
+/************************************************************************/
+
+bool OGRPG_PQsendQuery(PGconn *conn, const char *query, int nResultFormat)
+{
+    const bool bRet = PQsendQueryParams(conn, query, 0, nullptr, nullptr,
+                                        nullptr, nullptr, nResultFormat) == 1;
+    if (!bRet)
+        CPLDebug("PG", "PQsendQueryParams(%s) failed: %s", query,
+                 PQerrorMessage(conn));
+    return bRet;
+}
+
+/************************************************************************/
+/*                      OGRPG_PQgetPendingResult()                      */
+/*                                                                      */
+/*      Collect the result of a command dispatched with                 */
+/*      OGRPG_PQsendQuery().                                            */
+/************************************************************************/
+
+PGresult *OGRPG_PQgetPendingResult(PGconn *conn, const char *query)
+{
+    PGresult *hResult = PQgetResult(conn);
+    // Drain the terminating NULL (and anything unexpected) so that the
+    // connection is ready for the next command.
+    while (PGresult *hExtra = PQgetResult(conn))
+        PQclear(hExtra);
+
+#ifdef DEBUG
+    if (hResult && PQresultStatus(hResult) == PGRES_TUPLES_OK)
+        CPLDebug("PG", "PQgetResult(%s) = PGRES_TUPLES_OK, ntuples = %d",
+                 query, PQntuples(hResult));
+    else
+        CPLDebug("PG", "PQgetResult(%s) = %s", query,
+                 hResult ? PQresStatus(PQresultStatus(hResult)) : "NULL");
+#else
+    CPL_IGNORE_RET_VAL(query);
+#endif
+
+    if (!hResult || (PQresultStatus(hResult) == PGRES_NONFATAL_ERROR ||
+                     PQresultStatus(hResult) == PGRES_FATAL_ERROR))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "%s", PQerrorMessage(conn));
+    }
+
+    return hResult;
+}
+
 /************************************************************************/
 /*                       OGRPG_Check_Table_Exists()                     */
 /************************************************************************/
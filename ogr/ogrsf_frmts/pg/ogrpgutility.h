@@ -34,7 +34,10 @@
 
 PGresult *OGRPG_PQexec(PGconn *conn, const char *query,
                        int bMultipleCommandAllowed = FALSE,
-                       int bErrorAsDebug = FALSE);
+                       int bErrorAsDebug = FALSE, int nResultFormat = 0);
+
+bool OGRPG_PQsendQuery(PGconn *conn, const char *query, int nResultFormat = 0);
+PGresult *OGRPG_PQgetPendingResult(PGconn *conn, const char *query);
 
 /************************************************************************/
 /*                            OGRPGClearResult                          */
@@ -93,6 +93,19 @@ static bool ProcessMetadata(GDALDataset *poSQLiteDS, pmtiles::headerv3 &sHeader,
         }
     }
 
+    return OGRPMTilesProcessMetadata(oObj, sHeader, osMetadata);
+}
+
+/************************************************************************/
+/*                     OGRPMTilesProcessMetadata()                      */
+/************************************************************************/
+
+// Validates the metadata items (as found in a MBTiles metadata table, with
+// the content of the 'json' item expanded), and initializes the header from
+// them
+bool OGRPMTilesProcessMetadata(CPLJSONObject &oObj, pmtiles::headerv3 &sHeader,
+                               std::string &osMetadata)
+{
     // MBTiles advertises scheme=tms. Override this
     oObj.Set("scheme", "xyz");
 
@@ -191,27 +204,63 @@ static bool ProcessMetadata(GDALDataset *poSQLiteDS, pmtiles::headerv3 &sHeader,
 }
 
 /************************************************************************/
-/*                               HashArray()                            */
+/*                     OGRPMTilesBuildDirectories()                     */
 /************************************************************************/
 
-// From https://codereview.stackexchange.com/questions/171999/specializing-stdhash-for-stdarray
-// We do not use std::hash<std::array<T, N>> as the name of the struct
-// because with gcc 5.4 we get the following error:
-// https://stackoverflow.com/questions/25594644/warning-specialization-of-template-in-different-namespace
-template <class T, size_t N> struct HashArray
+// Compresses the metadata, and builds the root and leaf directories from
+// entries sorted by tile_id
+bool OGRPMTilesBuildDirectories(const std::string &osMetadata,
+                                const std::vector<pmtiles::entryv3> &asEntries,
+                                std::string &osCompressedMetadata,
+                                std::string &osRootBytes,
+                                std::string &osLeaveBytes)
 {
-    CPL_NOSANITIZE_UNSIGNED_INT_OVERFLOW
-    size_t operator()(const std::array<T, N> &key) const
+    const CPLCompressor *psCompressor = CPLGetCompressor("gzip");
+    assert(psCompressor);
+    std::string osCompressed;
+    struct compression_exception : std::exception
+    {
+        const char *what() const noexcept override
+        {
+            return "Compression failed";
+        }
+    };
+
+    const auto oCompressFunc =
+        [psCompressor, &osCompressed](const std::string &osBytes, uint8_t)
     {
-        std::hash<T> hasher;
-        size_t result = 0;
-        for (size_t i = 0; i < N; ++i)
+        osCompressed.resize(32 + osBytes.size() * 2);
+        size_t nOutputSize = osCompressed.size();
+        void *pOutputData = &osCompressed[0];
+        if (!psCompressor->pfnFunc(osBytes.data(), osBytes.size(), &pOutputData,
+                                   &nOutputSize, nullptr,
+                                   psCompressor->user_data))
         {
-            result = result * 31 + hasher(key[i]);
+            throw compression_exception();
         }
-        return result;
+        osCompressed.resize(nOutputSize);
+        return osCompressed;
+    };
+
+    int nNumLeaves;
+    try
+    {
+        osCompressedMetadata =
+            oCompressFunc(osMetadata, pmtiles::COMPRESSION_GZIP);
+
+        // Build the root and leave directories (one depth max)
+        std::tie(osRootBytes, osLeaveBytes, nNumLeaves) =
+            pmtiles::make_root_leaves(oCompressFunc, pmtiles::COMPRESSION_GZIP,
+                                      asEntries);
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot build directories: %s",
+                 e.what());
+        return false;
     }
-};
+    return true;
+}
 
 /************************************************************************/
 /*                    OGRPMTilesConvertFromMBTiles()                    */
@@ -464,52 +513,13 @@ bool OGRPMTilesConvertFromMBTiles(const char *pszDestName,
         }
     }
 
-    const CPLCompressor *psCompressor = CPLGetCompressor("gzip");
-    assert(psCompressor);
-    std::string osCompressed;
-    struct compression_exception : std::exception
-    {
-        const char *what() const noexcept override
-        {
-            return "Compression failed";
-        }
-    };
-
-    const auto oCompressFunc =
-        [psCompressor, &osCompressed](const std::string &osBytes, uint8_t)
-    {
-        osCompressed.resize(32 + osBytes.size() * 2);
-        size_t nOutputSize = osCompressed.size();
-        void *pOutputData = &osCompressed[0];
-        if (!psCompressor->pfnFunc(osBytes.data(), osBytes.size(), &pOutputData,
-                                   &nOutputSize, nullptr,
-                                   psCompressor->user_data))
-        {
-            throw compression_exception();
-        }
-        osCompressed.resize(nOutputSize);
-        return osCompressed;
-    };
-
     std::string osCompressedMetadata;
-
     std::string osRootBytes;
     std::string osLeaveBytes;
-    int nNumLeaves;
-    try
+    if (!OGRPMTilesBuildDirectories(osMetadata, asPMTilesEntries,
+                                    osCompressedMetadata, osRootBytes,
+                                    osLeaveBytes))
     {
-        osCompressedMetadata =
-            oCompressFunc(osMetadata, pmtiles::COMPRESSION_GZIP);
-
-        // Build the root and leave directories (one depth max)
-        std::tie(osRootBytes, osLeaveBytes, nNumLeaves) =
-            pmtiles::make_root_leaves(oCompressFunc, pmtiles::COMPRESSION_GZIP,
-                                      asPMTilesEntries);
-    }
-    catch (const std::exception &e)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Cannot build directories: %s",
-                 e.what());
         return false;
     }
 
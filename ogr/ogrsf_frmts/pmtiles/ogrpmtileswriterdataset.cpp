@@ -33,6 +33,356 @@
 #include "mvtutils.h"
 #include "ogrpmtilesfrommbtiles.h"
 
+#include "cpl_md5.h"
+
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+
+/************************************************************************/
+/*                         OGRPMTilesTileWriter                         */
+/************************************************************************/
+
+// Receives tiles from the MVT writer by increasing tile_id, and writes them
+// directly in the "clustered" mode, that is "offsets are either contiguous
+// with the previous offset+length, or refer to a lesser offset, when writing
+// with deduplication."
+// When the output file supports random writes, tile data is written at its
+// final place, after room reserved for the header and the root directory,
+// and metadata and leaf directories are written after it. Otherwise tile
+// data is written to a temporary file, which is copied at the end of the
+// output file.
+class OGRPMTilesTileWriter final : public OGRMVTTileWriter
+{
+    // Root directory must fit in the first 16 KB
+    static constexpr uint64_t ROOT_AREA_SIZE = 16384;
+
+    std::string m_osFilename{};
+    std::string m_osTmpFilename{};
+    VSIVirtualHandleUniquePtr m_poFile{};  // output or temporary file
+    bool m_bInPlace = false;
+    uint64_t m_nTileDataSize = 0;
+
+    std::vector<pmtiles::entryv3> m_asEntries{};
+    uint64_t m_nAddressedTiles = 0;
+    bool m_bClustered = true;
+    uint64_t m_nLastTileId = 0;
+    std::array<unsigned char, 16> m_abyLastMD5{};
+    std::unordered_map<std::array<unsigned char, 16>,
+                       std::pair<uint64_t, uint32_t>,
+                       HashArray<unsigned char, 16>>
+        m_oMapMD5ToOffsetLen{};
+
+    bool WriteSequentially(const std::string &osHeader,
+                           const std::string &osRootBytes,
+                           const std::string &osCompressedMetadata,
+                           const std::string &osLeaveBytes);
+
+  public:
+    OGRPMTilesTileWriter() = default;
+    ~OGRPMTilesTileWriter() override;
+
+    bool Open(const char *pszFilename);
+
+    uint64_t GetTileOrderKey(int nZ, int nX, int nY) const override;
+
+    bool WriteTile(int nZ, int nX, int nY,
+                   const std::string &osTileData) override;
+
+    bool Finalize(const CPLJSONObject &oMetadata) override;
+};
+
+OGRPMTilesTileWriter::~OGRPMTilesTileWriter()
+{
+    m_poFile.reset();
+    if (!m_osTmpFilename.empty())
+        VSIUnlink(m_osTmpFilename.c_str());
+}
+
+/************************************************************************/
+/*                                Open()                                */
+/************************************************************************/
+
+bool OGRPMTilesTileWriter::Open(const char *pszFilename)
+{
+    m_osFilename = pszFilename;
+    m_bInPlace = VSISupportsRandomWrite(pszFilename, false);
+    if (m_bInPlace)
+    {
+        m_poFile.reset(VSIFOpenL(pszFilename, "wb+"));
+        if (!m_poFile)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot open %s for write",
+                     pszFilename);
+            return false;
+        }
+        // Reserve room for the header and the root directory
+        const std::string osZeroes(static_cast<size_t>(ROOT_AREA_SIZE), '\0');
+        if (m_poFile->Write(osZeroes.data(), osZeroes.size(), 1) != 1)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Failed writing");
+            return false;
+        }
+    }
+    else
+    {
+        m_osTmpFilename = CPLGenerateTempFilename(CPLGetFilename(pszFilename));
+        m_poFile.reset(VSIFOpenL(m_osTmpFilename.c_str(), "wb+"));
+        if (!m_poFile)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot open %s for write",
+                     m_osTmpFilename.c_str());
+            m_osTmpFilename.clear();
+            return false;
+        }
+        // For Unix
+        if (VSIUnlink(m_osTmpFilename.c_str()) == 0)
+            m_osTmpFilename.clear();
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          GetTileOrderKey()                           */
+/************************************************************************/
+
+uint64_t OGRPMTilesTileWriter::GetTileOrderKey(int nZ, int nX, int nY) const
+{
+    try
+    {
+        return pmtiles::zxy_to_tileid(static_cast<uint8_t>(nZ), nX, nY);
+    }
+    catch (const std::exception &)
+    {
+        // Shouldn't happen for valid tile coordinates. WriteTile() will
+        // report the error.
+        return 0;
+    }
+}
+
+/************************************************************************/
+/*                             WriteTile()                              */
+/************************************************************************/
+
+bool OGRPMTilesTileWriter::WriteTile(int nZ, int nX, int nY,
+                                     const std::string &osTileData)
+{
+    uint64_t nTileId;
+    try
+    {
+        nTileId = pmtiles::zxy_to_tileid(static_cast<uint8_t>(nZ), nX, nY);
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot compute tile id: %s",
+                 e.what());
+        return false;
+    }
+
+    std::array<unsigned char, 16> abyMD5;
+    CPLMD5Context md5context;
+    CPLMD5Init(&md5context);
+    CPLMD5Update(&md5context, osTileData.data(), osTileData.size());
+    CPLMD5Final(&abyMD5[0], &md5context);
+
+    if (!m_asEntries.empty() && nTileId <= m_nLastTileId)
+    {
+        // Should not happen given GetTileOrderKey()
+        m_bClustered = false;
+    }
+
+    ++m_nAddressedTiles;
+    if (!m_asEntries.empty() && nTileId == m_nLastTileId + 1 &&
+        abyMD5 == m_abyLastMD5)
+    {
+        // If the tile id immediately follows the previous one and
+        // has the same tile data, increase the run_length
+        m_asEntries.back().run_length++;
+    }
+    else
+    {
+        pmtiles::entryv3 sPMTilesEntry;
+        sPMTilesEntry.tile_id = nTileId;
+        sPMTilesEntry.run_length = 1;
+
+        auto oIter = m_oMapMD5ToOffsetLen.find(abyMD5);
+        if (oIter != m_oMapMD5ToOffsetLen.end())
+        {
+            // Point to previously written tile data if this content
+            // has already been written
+            sPMTilesEntry.offset = oIter->second.first;
+            sPMTilesEntry.length = oIter->second.second;
+        }
+        else
+        {
+            const uint32_t nLength = static_cast<uint32_t>(osTileData.size());
+            sPMTilesEntry.offset = m_nTileDataSize;
+            sPMTilesEntry.length = nLength;
+            m_oMapMD5ToOffsetLen[abyMD5] =
+                std::pair<uint64_t, uint32_t>(m_nTileDataSize, nLength);
+            m_nTileDataSize += nLength;
+
+            if (m_poFile->Write(osTileData.data(), osTileData.size(), 1) != 1)
+            {
+                CPLError(CE_Failure, CPLE_FileIO, "Failed writing");
+                return false;
+            }
+        }
+
+        m_asEntries.push_back(sPMTilesEntry);
+    }
+    m_nLastTileId = nTileId;
+    m_abyLastMD5 = abyMD5;
+
+    return true;
+}
+
+/************************************************************************/
+/*                              Finalize()                              */
+/************************************************************************/
+
+bool OGRPMTilesTileWriter::Finalize(const CPLJSONObject &oMetadataIn)
+{
+    pmtiles::headerv3 sHeader;
+    std::string osMetadata;
+    CPLJSONObject oMetadata(oMetadataIn);
+    if (!OGRPMTilesProcessMetadata(oMetadata, sHeader, osMetadata))
+        return false;
+
+    if (!m_bClustered)
+    {
+        std::sort(m_asEntries.begin(), m_asEntries.end(),
+                  [](const pmtiles::entryv3 &a, const pmtiles::entryv3 &b)
+                  { return a.tile_id < b.tile_id; });
+    }
+
+    std::string osCompressedMetadata;
+    std::string osRootBytes;
+    std::string osLeaveBytes;
+    if (!OGRPMTilesBuildDirectories(osMetadata, m_asEntries,
+                                    osCompressedMetadata, osRootBytes,
+                                    osLeaveBytes))
+    {
+        return false;
+    }
+
+    sHeader.clustered = m_bClustered;
+
+    // Number of tiles that are addressable in the PMTiles archive, that is
+    // the number of tiles we would have if not deduplicating them
+    sHeader.addressed_tiles_count = m_nAddressedTiles;
+
+    // Number of tile entries in root and leave directories
+    // ie entries whose run_length >= 1
+    sHeader.tile_entries_count = m_asEntries.size();
+
+    // Number of distinct tile blobs
+    sHeader.tile_contents_count = m_oMapMD5ToOffsetLen.size();
+
+    sHeader.root_dir_bytes = osRootBytes.size();
+    sHeader.tile_data_bytes = m_nTileDataSize;
+
+    if (!m_bInPlace)
+    {
+        sHeader.json_metadata_offset =
+            sHeader.root_dir_offset + sHeader.root_dir_bytes;
+        sHeader.json_metadata_bytes = osCompressedMetadata.size();
+        sHeader.leaf_dirs_offset =
+            sHeader.json_metadata_offset + sHeader.json_metadata_bytes;
+        sHeader.leaf_dirs_bytes = osLeaveBytes.size();
+        sHeader.tile_data_offset =
+            sHeader.leaf_dirs_offset + sHeader.leaf_dirs_bytes;
+        return WriteSequentially(sHeader.serialize(), osRootBytes,
+                                 osCompressedMetadata, osLeaveBytes);
+    }
+
+    // Layout: header, root directory, padding up to ROOT_AREA_SIZE, tile
+    // data, metadata, leaf directories
+    sHeader.tile_data_offset = ROOT_AREA_SIZE;
+    sHeader.json_metadata_offset = ROOT_AREA_SIZE + m_nTileDataSize;
+    sHeader.json_metadata_bytes = osCompressedMetadata.size();
+    sHeader.leaf_dirs_offset =
+        sHeader.json_metadata_offset + sHeader.json_metadata_bytes;
+    sHeader.leaf_dirs_bytes = osLeaveBytes.size();
+
+    const auto osHeader = sHeader.serialize();
+    if (osHeader.size() + osRootBytes.size() > ROOT_AREA_SIZE)
+    {
+        // Shouldn't happen given how make_root_leaves() works
+        CPLError(CE_Failure, CPLE_AppDefined, "Root directory is too large");
+        return false;
+    }
+
+    if (m_poFile->Write(osCompressedMetadata.data(),
+                        osCompressedMetadata.size(), 1) != 1 ||
+        (!osLeaveBytes.empty() &&
+         m_poFile->Write(osLeaveBytes.data(), osLeaveBytes.size(), 1) != 1) ||
+        m_poFile->Seek(0, SEEK_SET) != 0 ||
+        m_poFile->Write(osHeader.data(), osHeader.size(), 1) != 1 ||
+        m_poFile->Write(osRootBytes.data(), osRootBytes.size(), 1) != 1)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Failed writing");
+        return false;
+    }
+
+    return m_poFile->Close() == 0;
+}
+
+/************************************************************************/
+/*                         WriteSequentially()                          */
+/************************************************************************/
+
+bool OGRPMTilesTileWriter::WriteSequentially(
+    const std::string &osHeader, const std::string &osRootBytes,
+    const std::string &osCompressedMetadata, const std::string &osLeaveBytes)
+{
+    auto poFile =
+        VSIVirtualHandleUniquePtr(VSIFOpenL(m_osFilename.c_str(), "wb"));
+    if (!poFile)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot open %s for write",
+                 m_osFilename.c_str());
+        return false;
+    }
+
+    if (m_poFile->Seek(0, SEEK_SET) != 0 ||
+        poFile->Write(osHeader.data(), osHeader.size(), 1) != 1 ||
+        poFile->Write(osRootBytes.data(), osRootBytes.size(), 1) != 1 ||
+        poFile->Write(osCompressedMetadata.data(), osCompressedMetadata.size(),
+                      1) != 1 ||
+        (!osLeaveBytes.empty() &&
+         poFile->Write(osLeaveBytes.data(), osLeaveBytes.size(), 1) != 1))
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Failed writing");
+        return false;
+    }
+
+    // Copy content of the temporary file at end of the output file.
+    std::string oCopyBuffer;
+    oCopyBuffer.resize(1024 * 1024);
+    uint64_t nFileOffset = 0;
+    while (nFileOffset < m_nTileDataSize)
+    {
+        const size_t nToRead = static_cast<size_t>(std::min<uint64_t>(
+            m_nTileDataSize - nFileOffset, oCopyBuffer.size()));
+        if (m_poFile->Read(&oCopyBuffer[0], nToRead, 1) != 1 ||
+            poFile->Write(&oCopyBuffer[0], nToRead, 1) != 1)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Failed writing");
+            return false;
+        }
+        nFileOffset += nToRead;
+    }
+
+    return poFile->Close() == 0;
+}
+
+}  // namespace
+
 /************************************************************************/
 /*                     ~OGRPMTilesWriterDataset()                       */
 /************************************************************************/
@@ -51,24 +401,11 @@ CPLErr OGRPMTilesWriterDataset::Close()
     CPLErr eErr = CE_None;
     if (nOpenFlags != OPEN_FLAGS_CLOSED)
     {
-        if (m_poMBTilesWriterDataset)
+        if (m_poMVTWriterDataset)
         {
-            if (m_poMBTilesWriterDataset->Close() != CE_None)
-            {
+            if (m_poMVTWriterDataset->Close() != CE_None)
                 eErr = CE_Failure;
-            }
-            else
-            {
-                if (!OGRPMTilesConvertFromMBTiles(
-                        GetDescription(),
-                        m_poMBTilesWriterDataset->GetDescription()))
-                {
-                    eErr = CE_Failure;
-                }
-            }
-
-            VSIUnlink(m_poMBTilesWriterDataset->GetDescription());
-            m_poMBTilesWriterDataset.reset();
+            m_poMVTWriterDataset.reset();
         }
 
         if (GDALDataset::Close() != CE_None)
@@ -86,26 +423,30 @@ bool OGRPMTilesWriterDataset::Create(const char *pszFilename,
 {
     SetDescription(pszFilename);
     CPLStringList aosOptions(papszOptions);
-    aosOptions.SetNameValue("FORMAT", "MBTILES");
-
-    // Let's build a temporary file that contains the tile data in
-    // a way that corresponds to the "clustered" mode, that is
-    // "offsets are either contiguous with the previous offset+length, or
-    // refer to a lesser offset, when writing with deduplication."
-    std::string osTmpFile(pszFilename);
-    if (!VSIIsLocal(pszFilename))
-    {
-        osTmpFile = CPLGenerateTempFilename(CPLGetFilename(pszFilename));
-    }
-    osTmpFile += ".tmp.mbtiles";
 
     if (!aosOptions.FetchNameValue("NAME"))
         aosOptions.SetNameValue("NAME", CPLGetBasename(pszFilename));
 
-    m_poMBTilesWriterDataset.reset(OGRMVTWriterDatasetCreate(
-        osTmpFile.c_str(), 0, 0, 0, GDT_Unknown, aosOptions.List()));
+    // The MVT writer passes tiles by increasing tile_id to the tile writer,
+    // which writes the PMTiles file directly
+    auto poTileWriter = std::make_unique<OGRPMTilesTileWriter>();
+    if (!poTileWriter->Open(pszFilename))
+        return false;
+
+    // Keep the temporary feature storage local
+    if (!VSIIsLocal(pszFilename) && !aosOptions.FetchNameValue("TEMPORARY_DB"))
+    {
+        aosOptions.SetNameValue(
+            "TEMPORARY_DB",
+            (std::string(CPLGenerateTempFilename(CPLGetFilename(pszFilename))) +
+             ".temp.db")
+                .c_str());
+    }
+
+    m_poMVTWriterDataset.reset(OGRMVTWriterDatasetCreate(
+        pszFilename, aosOptions.List(), std::move(poTileWriter)));
 
-    return m_poMBTilesWriterDataset != nullptr;
+    return m_poMVTWriterDataset != nullptr;
 }
 
 /************************************************************************/
@@ -116,7 +457,7 @@ OGRLayer *OGRPMTilesWriterDataset::ICreateLayer(
     const char *pszLayerName, const OGRSpatialReference *poSRS,
     OGRwkbGeometryType eGeomType, char **papszOptions)
 {
-    return m_poMBTilesWriterDataset->CreateLayer(pszLayerName, poSRS, eGeomType,
+    return m_poMVTWriterDataset->CreateLayer(pszLayerName, poSRS, eGeomType,
                                                  papszOptions);
 }
 
@@ -126,7 +467,7 @@ OGRLayer *OGRPMTilesWriterDataset::ICreateLayer(
 
 int OGRPMTilesWriterDataset::TestCapability(const char *pszCap)
 {
-    return m_poMBTilesWriterDataset->TestCapability(pszCap);
+    return m_poMVTWriterDataset->TestCapability(pszCap);
 }
 
 #endif  // HAVE_MVT_WRITE_SUPPORT
@@ -41,6 +41,7 @@
 #include "shp_vsi.h"
 #include "ogrlayerpool.h"
 #include <set>
+#include <string>
 #include <vector>
 
 /* Was limited to 255 until OGR 1.10, but 254 seems to be a more */
@@ -58,6 +59,8 @@ OGRFeature *SHPReadOGRFeature(SHPHandle hSHP, DBFHandle hDBF,
                               bool &bHasWarnedWrongWindingOrder);
 OGRGeometry *SHPReadOGRObject(SHPHandle hSHP, int iShape, SHPObject *psShape,
                               bool &bHasWarnedWrongWindingOrder);
+void SHPForceOGRGeometryDimension(OGRGeometry *poGeometry,
+                                  OGRwkbGeometryType eLayerGeomType);
 OGRFeatureDefn *SHPReadOGRFeatureDefn(const char *pszName, SHPHandle hSHP,
                                       DBFHandle hDBF,
                                       const char *pszSHPEncoding,
@@ -156,6 +159,18 @@ class OGRShapeLayer final : public OGRAbstractProxiedLayer
     SBNSearchHandle hSBN;
     bool CheckForSBN();
 
+    // /vsimem/ copies of the .qix and .sbn files, when ingested in one read.
+    std::string m_osQIXMemFilename{};
+    std::string m_osSBNMemFilename{};
+    std::string GetSpatialIndexFilenameToOpen(const char *pszFilename,
+                                              std::string &osMemFilename);
+    void ReleaseIngestedSpatialIndexFiles();
+
+    // Index in panMatchingFIDs up to which AdviseRead() has been issued.
+    int m_iMatchingFIDAdvisedEnd = 0;
+    int m_nAdviseReadMatchingFIDs = -1;  // -1 = not yet determined
+    void AdviseReadMatchingFIDs();
+
     bool bSbnSbxDeleted;
 
     CPLString ConvertCodePage(const char *);
@@ -243,6 +258,8 @@ class OGRShapeLayer final : public OGRAbstractProxiedLayer
     OGRErr SetNextByIndex(GIntBig nIndex) override;
 
     OGRFeature *GetFeature(GIntBig nFeatureId) override;
+    int GetNextArrowArray(struct ArrowArrayStream *,
+                          struct ArrowArray *out_array) override;
     OGRErr ISetFeature(OGRFeature *poFeature) override;
     OGRErr DeleteFeature(GIntBig nFID) override;
     OGRErr ICreateFeature(OGRFeature *poFeature) override;
@@ -30,6 +30,7 @@
 #include "ogrshape.h"
 
 #include <cerrno>
+#include <climits>
 #include <limits>
 #include <cstddef>
 #include <cstdio>
@@ -37,6 +38,7 @@
 #include <cstring>
 #include <ctime>
 #include <algorithm>
+#include <memory>
 #include <string>
 
 #include "cpl_conv.h"
@@ -46,12 +48,14 @@
 #include "cpl_string.h"
 #include "cpl_time.h"
 #include "cpl_vsi.h"
+#include "cpl_vsi_virtual.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
 #include "ogr_geometry.h"
 #include "ogr_p.h"
 #include "ogr_spatialref.h"
 #include "ogr_srs_api.h"
+#include "ograrrowarrayhelper.h"
 #include "ogrlayerpool.h"
 #include "ogrsf_frmts.h"
 #include "shapefil.h"
@@ -279,6 +283,8 @@ OGRShapeLayer::~OGRShapeLayer()
 
     if (hSBN != nullptr)
         SBNCloseDiskTree(hSBN);
+
+    ReleaseIngestedSpatialIndexFiles();
 }
 
 /************************************************************************/
@@ -603,9 +609,10 @@ bool OGRShapeLayer::CheckForQIX()
     if (bCheckedForQIX)
         return hQIX != nullptr;
 
-    const char *pszQIXFilename = CPLResetExtension(pszFullName, "qix");
+    const std::string osQIXFilename = GetSpatialIndexFilenameToOpen(
+        CPLResetExtension(pszFullName, "qix"), m_osQIXMemFilename);
 
-    hQIX = SHPOpenDiskTree(pszQIXFilename, nullptr);
+    hQIX = SHPOpenDiskTree(osQIXFilename.c_str(), nullptr);
 
     bCheckedForQIX = true;
 
@@ -622,15 +629,82 @@ bool OGRShapeLayer::CheckForSBN()
     if (bCheckedForSBN)
         return hSBN != nullptr;
 
-    const char *pszSBNFilename = CPLResetExtension(pszFullName, "sbn");
+    const std::string osSBNFilename = GetSpatialIndexFilenameToOpen(
+        CPLResetExtension(pszFullName, "sbn"), m_osSBNMemFilename);
 
-    hSBN = SBNOpenDiskTree(pszSBNFilename, nullptr);
+    hSBN = SBNOpenDiskTree(osSBNFilename.c_str(), nullptr);
 
     bCheckedForSBN = true;
 
     return hSBN != nullptr;
 }
 
+/************************************************************************/
+/*                   GetSpatialIndexFilenameToOpen()                    */
+/*                                                                      */
+/*      The .qix and .sbn search code does many small seeks and        */
+/*      reads, which are costly on network file systems. In that case,  */
+/*      ingest the whole file in a single read into a /vsimem/ file,    */
+/*      whose name is returned, and also stored in osMemFilename.       */
+/************************************************************************/
+
+std::string
+OGRShapeLayer::GetSpatialIndexFilenameToOpen(const char *pszFilename,
+                                             std::string &osMemFilename)
+{
+    // Take a copy, since pszFilename may be a CPLResetExtension() result.
+    const std::string osFilename(pszFilename);
+
+    const char *pszInMemory =
+        CPLGetConfigOption("SHAPE_SPATIAL_INDEX_IN_MEMORY", "AUTO");
+    const bool bIngest = EQUAL(pszInMemory, "AUTO")
+                             ? !VSIIsLocal(osFilename.c_str())
+                             : CPLTestBool(pszInMemory);
+    if (!bIngest)
+        return osFilename;
+
+    constexpr vsi_l_offset MAX_INGESTED_SIZE = 100 * 1024 * 1024;
+    VSIStatBufL sStat;
+    if (VSIStatL(osFilename.c_str(), &sStat) != 0 ||
+        static_cast<vsi_l_offset>(sStat.st_size) > MAX_INGESTED_SIZE)
+    {
+        return osFilename;
+    }
+
+    GByte *pabyData = nullptr;
+    vsi_l_offset nSize = 0;
+    if (!VSIIngestFile(nullptr, osFilename.c_str(), &pabyData, &nSize,
+                       MAX_INGESTED_SIZE))
+    {
+        return osFilename;
+    }
+
+    osMemFilename = CPLSPrintf("/vsimem/shape_%p/%s", this,
+                               CPLGetFilename(osFilename.c_str()));
+    VSIFCloseL(VSIFileFromMemBuffer(osMemFilename.c_str(), pabyData, nSize,
+                                    /* bTakeOwnership = */ TRUE));
+    CPLDebug("SHAPE", "Ingested %s in memory", osFilename.c_str());
+    return osMemFilename;
+}
+
+/************************************************************************/
+/*                  ReleaseIngestedSpatialIndexFiles()                  */
+/************************************************************************/
+
+void OGRShapeLayer::ReleaseIngestedSpatialIndexFiles()
+{
+    if (!m_osQIXMemFilename.empty())
+    {
+        VSIUnlink(m_osQIXMemFilename.c_str());
+        m_osQIXMemFilename.clear();
+    }
+    if (!m_osSBNMemFilename.empty())
+    {
+        VSIUnlink(m_osSBNMemFilename.c_str());
+        m_osSBNMemFilename.clear();
+    }
+}
+
 /************************************************************************/
 /*                            ScanIndices()                             */
 /*                                                                      */
@@ -642,6 +716,7 @@ bool OGRShapeLayer::ScanIndices()
 
 {
     iMatchingFID = 0;
+    m_iMatchingFIDAdvisedEnd = 0;
 
     /* -------------------------------------------------------------------- */
     /*      Utilize attribute index if appropriate.                         */
@@ -782,6 +857,7 @@ void OGRShapeLayer::ResetReading()
         return;
 
     iMatchingFID = 0;
+    m_iMatchingFIDAdvisedEnd = 0;
 
     iNextShapeId = 0;
 
@@ -800,6 +876,7 @@ void OGRShapeLayer::ClearMatchingFIDs()
     /* -------------------------------------------------------------------- */
     CPLFree(panMatchingFIDs);
     panMatchingFIDs = nullptr;
+    m_iMatchingFIDAdvisedEnd = 0;
 }
 
 /************************************************************************/
@@ -888,6 +965,98 @@ OGRErr OGRShapeLayer::SetNextByIndex(GIntBig nIndex)
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                       AdviseReadMatchingFIDs()                       */
+/*                                                                      */
+/*      Tell the .shp and .dbf file handles which byte ranges the      */
+/*      next matching features will be read from, with nearby records   */
+/*      coalesced, so that network file systems can fetch them with a   */
+/*      few requests instead of one or more per feature. This is done   */
+/*      by windows of features, to bound the amount of prefetched data. */
+/************************************************************************/
+
+void OGRShapeLayer::AdviseReadMatchingFIDs()
+{
+    if (m_nAdviseReadMatchingFIDs < 0)
+        m_nAdviseReadMatchingFIDs = VSIIsLocal(pszFullName) ? 0 : 1;
+    if (m_nAdviseReadMatchingFIDs == 0)
+    {
+        // Avoid being called again.
+        m_iMatchingFIDAdvisedEnd = INT_MAX;
+        return;
+    }
+
+    constexpr int MAX_FEATURES_PER_WINDOW = 1000;
+    constexpr size_t MAX_BYTES_PER_WINDOW = 16 * 1024 * 1024;
+    constexpr vsi_l_offset MAX_GAP = 64 * 1024;
+
+    struct Ranges
+    {
+        std::vector<vsi_l_offset> anOffsets{};
+        std::vector<size_t> anSizes{};
+
+        void Add(vsi_l_offset nOffset, size_t nSize)
+        {
+            if (!anOffsets.empty() && nOffset >= anOffsets.back() &&
+                nOffset <= anOffsets.back() + anSizes.back() + MAX_GAP)
+            {
+                anSizes.back() = std::max(
+                    anSizes.back(),
+                    static_cast<size_t>(nOffset + nSize - anOffsets.back()));
+            }
+            else
+            {
+                anOffsets.push_back(nOffset);
+                anSizes.push_back(nSize);
+            }
+        }
+    };
+    Ranges oSHPRanges;
+    Ranges oDBFRanges;
+
+    size_t nTotalSize = 0;
+    int i = iMatchingFID;
+    for (; panMatchingFIDs[i] != OGRNullFID &&
+           i - iMatchingFID < MAX_FEATURES_PER_WINDOW &&
+           nTotalSize < MAX_BYTES_PER_WINDOW;
+         ++i)
+    {
+        const GIntBig nFID = panMatchingFIDs[i];
+        // Offset 0 is the lazy .shx loading case.
+        if (hSHP != nullptr && nFID < hSHP->nRecords &&
+            hSHP->panRecOffset[nFID] != 0)
+        {
+            // 8 bytes of record header
+            const size_t nSize = 8 + hSHP->panRecSize[nFID];
+            oSHPRanges.Add(hSHP->panRecOffset[nFID], nSize);
+            nTotalSize += nSize;
+        }
+        if (hDBF != nullptr && nFID < hDBF->nRecords)
+        {
+            oDBFRanges.Add(static_cast<vsi_l_offset>(hDBF->nHeaderLength) +
+                               static_cast<vsi_l_offset>(nFID) *
+                                   hDBF->nRecordLength,
+                           hDBF->nRecordLength);
+            nTotalSize += hDBF->nRecordLength;
+        }
+    }
+    m_iMatchingFIDAdvisedEnd = i;
+
+    if (!oSHPRanges.anOffsets.empty())
+    {
+        VSI_SHP_GetVSIL(hSHP->fpSHP)
+            ->AdviseRead(static_cast<int>(oSHPRanges.anOffsets.size()),
+                         oSHPRanges.anOffsets.data(),
+                         oSHPRanges.anSizes.data());
+    }
+    if (!oDBFRanges.anOffsets.empty())
+    {
+        VSI_SHP_GetVSIL(hDBF->fp)->AdviseRead(
+            static_cast<int>(oDBFRanges.anOffsets.size()),
+            oDBFRanges.anOffsets.data(), oDBFRanges.anSizes.data());
+    }
+}
+
 /************************************************************************/
 /*                             FetchShape()                             */
 /*                                                                      */
@@ -978,6 +1147,9 @@ OGRFeature *OGRShapeLayer::GetNextFeature()
                 return nullptr;
             }
 
+            if (iMatchingFID >= m_iMatchingFIDAdvisedEnd)
+                AdviseReadMatchingFIDs();
+
             // Check the shape object's geometry, and if it matches
             // any spatial filter, return it.
             poFeature =
@@ -1059,6 +1231,624 @@ OGRFeature *OGRShapeLayer::GetFeature(GIntBig nFeatureId)
     return poFeature;
 }
 
+/************************************************************************/
+/*                    GetWKBTypeAndSizeOfSHPObject()                    */
+/*                                                                      */
+/*      Compute the geometry type and ISO WKB size of the geometry      */
+/*      SHPReadOGRObject() would return, for the shapes that can be     */
+/*      directly encoded as WKB (points, multipoints, lines and         */
+/*      single-part polygons). Returns false if the shape must go       */
+/*      through SHPReadOGRObject(). nWKBSize is set to 0 for null       */
+/*      geometries.                                                     */
+/************************************************************************/
+
+static bool GetWKBTypeAndSizeOfSHPObject(const SHPObject *psShape,
+                                         OGRwkbGeometryType eLayerGeomType,
+                                         OGRwkbGeometryType &eWKBType,
+                                         size_t &nWKBSize)
+{
+    eWKBType = wkbUnknown;
+    nWKBSize = 0;
+    if (eLayerGeomType == wkbUnknown || psShape->nVertices < 0 ||
+        psShape->nParts < 0)
+    {
+        return false;
+    }
+
+    constexpr size_t HEADER_SIZE = 1 + sizeof(uint32_t);
+    const size_t nPointSize =
+        sizeof(double) * (2 + (wkbHasZ(eLayerGeomType) ? 1 : 0) +
+                          (wkbHasM(eLayerGeomType) ? 1 : 0));
+    const size_t nVertices = static_cast<size_t>(psShape->nVertices);
+
+    switch (psShape->nSHPType)
+    {
+        case SHPT_NULL:
+            return true;
+
+        case SHPT_POINT:
+        case SHPT_POINTZ:
+        case SHPT_POINTM:
+            if (psShape->nVertices == 0)
+                return false;
+            eWKBType = wkbPoint;
+            nWKBSize = HEADER_SIZE + nPointSize;
+            return true;
+
+        case SHPT_MULTIPOINT:
+        case SHPT_MULTIPOINTZ:
+        case SHPT_MULTIPOINTM:
+            if (psShape->nVertices == 0)
+                return true;
+            eWKBType = wkbMultiPoint;
+            nWKBSize = HEADER_SIZE + sizeof(uint32_t) +
+                       nVertices * (HEADER_SIZE + nPointSize);
+            return true;
+
+        case SHPT_ARC:
+        case SHPT_ARCZ:
+        case SHPT_ARCM:
+        {
+            if (psShape->nParts == 0)
+                return true;
+            if (psShape->nParts == 1)
+            {
+                eWKBType = wkbLineString;
+                nWKBSize =
+                    HEADER_SIZE + sizeof(uint32_t) + nVertices * nPointSize;
+                return true;
+            }
+            if (psShape->panPartStart == nullptr)
+                return false;
+            size_t nTotalPoints = 0;
+            for (int iPart = 0; iPart < psShape->nParts; ++iPart)
+            {
+                const int nStart = psShape->panPartStart[iPart];
+                const int nEnd = iPart == psShape->nParts - 1
+                                     ? psShape->nVertices
+                                     : psShape->panPartStart[iPart + 1];
+                if (nStart < 0 || nEnd < nStart || nEnd > psShape->nVertices)
+                    return false;
+                nTotalPoints += static_cast<size_t>(nEnd - nStart);
+            }
+            eWKBType = wkbMultiLineString;
+            nWKBSize = HEADER_SIZE + sizeof(uint32_t) +
+                       static_cast<size_t>(psShape->nParts) *
+                           (HEADER_SIZE + sizeof(uint32_t)) +
+                       nTotalPoints * nPointSize;
+            return true;
+        }
+
+        case SHPT_POLYGON:
+        case SHPT_POLYGONZ:
+        case SHPT_POLYGONM:
+        {
+            if (psShape->nParts == 0)
+                return true;
+            // Multi-part polygons need OGRGeometryFactory::organizePolygons()
+            if (psShape->nParts > 1 ||
+                (psShape->panPartStart && psShape->panPartStart[0] != 0) ||
+                psShape->nVertices == 0)
+            {
+                return false;
+            }
+            eWKBType = wkbPolygon;
+            nWKBSize = HEADER_SIZE + 2 * sizeof(uint32_t) +
+                       nVertices * nPointSize;
+            return true;
+        }
+
+        default:
+            break;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                        WriteWKBFromSHPObject()                       */
+/************************************************************************/
+
+static GByte *WriteWKBUInt32(GByte *pabyOut, uint32_t nVal)
+{
+    CPL_LSBPTR32(&nVal);
+    memcpy(pabyOut, &nVal, sizeof(nVal));
+    return pabyOut + sizeof(nVal);
+}
+
+static GByte *WriteWKBHeader(GByte *pabyOut, uint32_t nISOType)
+{
+    *pabyOut = static_cast<GByte>(wkbNDR);
+    return WriteWKBUInt32(pabyOut + 1, nISOType);
+}
+
+/* Writes the ISO WKB encoding of a shape accepted by
+ * GetWKBTypeAndSizeOfSHPObject(), with the dimension of the layer. */
+static void WriteWKBFromSHPObject(const SHPObject *psShape,
+                                  OGRwkbGeometryType eLayerGeomType,
+                                  OGRwkbGeometryType eWKBType, GByte *pabyOut)
+{
+    const bool bHasZ = CPL_TO_BOOL(wkbHasZ(eLayerGeomType));
+    const bool bHasM = CPL_TO_BOOL(wkbHasM(eLayerGeomType));
+    const uint32_t nDimOffset = (bHasZ ? 1000 : 0) + (bHasM ? 2000 : 0);
+
+    // Same logic as in SHPReadOGRObject() to decide which source
+    // dimensions are available. Missing ones are set to 0.
+    const int nSHPType = psShape->nSHPType;
+    const bool bSrcHasZ =
+        psShape->padfZ != nullptr &&
+        (nSHPType == SHPT_POINTZ || nSHPType == SHPT_MULTIPOINTZ ||
+         nSHPType == SHPT_ARCZ || nSHPType == SHPT_POLYGONZ);
+    const bool bSrcHasM =
+        psShape->padfM != nullptr &&
+        (bSrcHasZ || nSHPType == SHPT_POINTM || nSHPType == SHPT_MULTIPOINTM ||
+         nSHPType == SHPT_ARCM || nSHPType == SHPT_POLYGONM);
+
+    const auto WritePoints = [psShape, bHasZ, bHasM, bSrcHasZ,
+                              bSrcHasM](GByte *pabyPtr, int nStart, int nEnd)
+    {
+        for (int i = nStart; i < nEnd; ++i)
+        {
+            double adfXYZM[4];
+            int nValues = 0;
+            adfXYZM[nValues++] = psShape->padfX[i];
+            adfXYZM[nValues++] = psShape->padfY[i];
+            if (bHasZ)
+                adfXYZM[nValues++] = bSrcHasZ ? psShape->padfZ[i] : 0.0;
+            if (bHasM)
+                adfXYZM[nValues++] = bSrcHasM ? psShape->padfM[i] : 0.0;
+            for (int j = 0; j < nValues; ++j)
+                CPL_LSBPTR64(&adfXYZM[j]);
+            memcpy(pabyPtr, adfXYZM, nValues * sizeof(double));
+            pabyPtr += nValues * sizeof(double);
+        }
+        return pabyPtr;
+    };
+
+    pabyOut = WriteWKBHeader(pabyOut, eWKBType + nDimOffset);
+    switch (eWKBType)
+    {
+        case wkbPoint:
+            WritePoints(pabyOut, 0, 1);
+            break;
+
+        case wkbMultiPoint:
+            pabyOut = WriteWKBUInt32(pabyOut, psShape->nVertices);
+            for (int i = 0; i < psShape->nVertices; ++i)
+            {
+                pabyOut = WriteWKBHeader(pabyOut, wkbPoint + nDimOffset);
+                pabyOut = WritePoints(pabyOut, i, i + 1);
+            }
+            break;
+
+        case wkbLineString:
+            pabyOut = WriteWKBUInt32(pabyOut, psShape->nVertices);
+            WritePoints(pabyOut, 0, psShape->nVertices);
+            break;
+
+        case wkbMultiLineString:
+            pabyOut = WriteWKBUInt32(pabyOut, psShape->nParts);
+            for (int iPart = 0; iPart < psShape->nParts; ++iPart)
+            {
+                const int nStart = psShape->panPartStart[iPart];
+                const int nEnd = iPart == psShape->nParts - 1
+                                     ? psShape->nVertices
+                                     : psShape->panPartStart[iPart + 1];
+                pabyOut = WriteWKBHeader(pabyOut, wkbLineString + nDimOffset);
+                pabyOut = WriteWKBUInt32(pabyOut, nEnd - nStart);
+                pabyOut = WritePoints(pabyOut, nStart, nEnd);
+            }
+            break;
+
+        case wkbPolygon:
+            pabyOut = WriteWKBUInt32(pabyOut, 1);
+            pabyOut = WriteWKBUInt32(pabyOut, psShape->nVertices);
+            WritePoints(pabyOut, 0, psShape->nVertices);
+            break;
+
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+/************************************************************************/
+/*                          IsDBFValueNull()                            */
+/*                                                                      */
+/*      Same as DBFIsValueNULL() from dbfopen.c, on an already trimmed  */
+/*      value.                                                          */
+/************************************************************************/
+
+static bool IsDBFValueNull(char chType, const char *pszValue, size_t nLen)
+{
+    switch (chType)
+    {
+        case 'N':
+        case 'F':
+            return nLen == 0 || pszValue[0] == '*';
+
+        case 'D':
+            return (nLen >= 8 && memcmp(pszValue, "00000000", 8) == 0) ||
+                   (nLen == 1 && pszValue[0] == '0');
+
+        case 'L':
+            return nLen > 0 && pszValue[0] == '?';
+
+        default:
+            return nLen == 0;
+    }
+}
+
+/************************************************************************/
+/*                         GetNextArrowArray()                          */
+/*                                                                      */
+/*      Decode DBF records directly into the Arrow buffers, and SHP     */
+/*      shapes into WKB, without creating OGRFeature objects.           */
+/************************************************************************/
+
+int OGRShapeLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
+                                     struct ArrowArray *out_array)
+{
+    if (!TouchLayer())
+    {
+        memset(out_array, 0, sizeof(*out_array));
+        return EIO;
+    }
+
+    // Attribute filters (which may use the .ind/.cdx indices) and spatial
+    // filters when a spatial index is available are better dealt by
+    // GetNextFeature().
+    bool bUseBaseImpl =
+        m_poAttrQuery != nullptr ||
+        !m_poSharedArrowArrayStreamPrivateData->m_anQueriedFIDs.empty() ||
+        CPLTestBool(CPLGetConfigOption("OGR_SHAPE_STREAM_BASE_IMPL", "NO"));
+    for (int i = 0; !bUseBaseImpl && i < poFeatureDefn->GetFieldCount(); ++i)
+    {
+        const auto poFieldDefn = poFeatureDefn->GetFieldDefn(i);
+        const auto eType = poFieldDefn->GetType();
+        bUseBaseImpl = poFieldDefn->GetSubType() != OFSTNone ||
+                       (eType != OFTString && eType != OFTInteger &&
+                        eType != OFTInteger64 && eType != OFTReal &&
+                        eType != OFTDate);
+    }
+    struct ArrowSchema schema;
+    memset(&schema, 0, sizeof(schema));
+    if (!bUseBaseImpl && m_poFilterGeom != nullptr)
+    {
+        bUseBaseImpl = poFeatureDefn->IsGeometryIgnored() || CheckForQIX() ||
+                       CheckForSBN() || stream->get_schema(stream, &schema) != 0;
+        if (!bUseBaseImpl && !CanPostFilterArrowArray(&schema))
+        {
+            bUseBaseImpl = true;
+        }
+        if (bUseBaseImpl && schema.release)
+            schema.release(&schema);
+    }
+    if (bUseBaseImpl)
+    {
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+    }
+
+    const OGRwkbGeometryType eLayerGeomType = poFeatureDefn->GetGeomType();
+    const uint32_t nMemLimit = OGRArrowArrayHelper::GetMemLimit();
+    const size_t nMaxRecodeFactor = osEncoding.empty() ? 1 : 4;
+    std::string osValue;
+    struct tm brokenDown;
+    memset(&brokenDown, 0, sizeof(brokenDown));
+
+    while (true)
+    {
+        memset(out_array, 0, sizeof(*out_array));
+        if (iNextShapeId >= nTotalShapeCount)
+            break;
+
+        OGRArrowArrayHelper sHelper(poDS, poFeatureDefn,
+                                    m_aosArrowArrayStreamOptions, out_array);
+        if (out_array->release == nullptr)
+        {
+            if (schema.release)
+                schema.release(&schema);
+            return ENOMEM;
+        }
+        const int iGeomArrowField =
+            hSHP != nullptr ? sHelper.m_mapOGRGeomFieldToArrowField[0] : -1;
+
+        int iFeat = 0;
+        while (iFeat < sHelper.m_nMaxBatchSize &&
+               iNextShapeId < nTotalShapeCount)
+        {
+            const int iShape = iNextShapeId;
+            if ((hSHP != nullptr && iShape >= hSHP->nRecords) ||
+                (hDBF != nullptr && iShape >= hDBF->nRecords))
+            {
+                ++iNextShapeId;
+                continue;
+            }
+
+            const char *pszRecord = nullptr;
+            if (hDBF != nullptr)
+            {
+                pszRecord = DBFReadTuple(hDBF, iShape);
+                if (pszRecord == nullptr)
+                {
+                    sHelper.ClearArray();
+                    if (schema.release)
+                        schema.release(&schema);
+                    return EIO;
+                }
+                // Deleted record
+                if (pszRecord[0] == '*')
+                {
+                    ++iNextShapeId;
+                    continue;
+                }
+            }
+
+            SHPObject *psShape = nullptr;
+            std::unique_ptr<OGRGeometry> poGeom;
+            OGRwkbGeometryType eWKBType = wkbUnknown;
+            size_t nWKBSize = 0;
+            if (iGeomArrowField >= 0)
+            {
+                psShape = SHPReadObject(hSHP, iShape);
+
+                // Same logic as in FetchShape(): do not trust degenerate
+                // bounds on non-point geometries or bounds on null shapes.
+                if (m_poFilterGeom != nullptr && psShape != nullptr &&
+                    psShape->nSHPType != SHPT_NULL &&
+                    (psShape->nSHPType == SHPT_POINT ||
+                     psShape->nSHPType == SHPT_POINTZ ||
+                     psShape->nSHPType == SHPT_POINTM ||
+                     (psShape->dfXMin != psShape->dfXMax &&
+                      psShape->dfYMin != psShape->dfYMax)) &&
+                    (m_sFilterEnvelope.MaxX < psShape->dfXMin ||
+                     m_sFilterEnvelope.MaxY < psShape->dfYMin ||
+                     psShape->dfXMax < m_sFilterEnvelope.MinX ||
+                     psShape->dfYMax < m_sFilterEnvelope.MinY))
+                {
+                    SHPDestroyObject(psShape);
+                    ++iNextShapeId;
+                    continue;
+                }
+
+                if (psShape != nullptr &&
+                    !GetWKBTypeAndSizeOfSHPObject(psShape, eLayerGeomType,
+                                                  eWKBType, nWKBSize))
+                {
+                    // Takes ownership of psShape
+                    poGeom.reset(SHPReadOGRObject(
+                        hSHP, iShape, psShape, m_bHasWarnedWrongWindingOrder));
+                    psShape = nullptr;
+                    if (poGeom)
+                    {
+                        SHPForceOGRGeometryDimension(poGeom.get(),
+                                                     eLayerGeomType);
+                        nWKBSize = poGeom->WkbSize();
+                    }
+                }
+            }
+
+            // Stop the batch before this feature if it would make one of
+            // the variable-size buffers exceed the memory limit.
+            bool bMemLimitReached = false;
+            if (iFeat > 0)
+            {
+                const auto IsMemLimitReached =
+                    [out_array, iFeat, nMemLimit](int iArrowField, size_t nLen)
+                {
+                    const auto panOffsets =
+                        static_cast<const int32_t *>(
+                            out_array->children[iArrowField]->buffers[1]);
+                    const uint32_t nCurLength =
+                        static_cast<uint32_t>(panOffsets[iFeat]);
+                    return nLen <= nMemLimit && nLen > nMemLimit - nCurLength;
+                };
+                if (nWKBSize > 0)
+                    bMemLimitReached =
+                        IsMemLimitReached(iGeomArrowField, nWKBSize);
+                for (int i = 0; !bMemLimitReached && hDBF != nullptr &&
+                                i < sHelper.m_nFieldCount;
+                     ++i)
+                {
+                    const int iArrowField = sHelper.m_mapOGRFieldToArrowField[i];
+                    if (iArrowField >= 0 &&
+                        poFeatureDefn->GetFieldDefn(i)->GetType() == OFTString)
+                    {
+                        bMemLimitReached = IsMemLimitReached(
+                            iArrowField,
+                            nMaxRecodeFactor *
+                                static_cast<size_t>(hDBF->panFieldSize[i]));
+                    }
+                }
+            }
+            if (bMemLimitReached)
+            {
+                if (psShape)
+                    SHPDestroyObject(psShape);
+                break;
+            }
+
+            if (sHelper.m_panFIDValues)
+                sHelper.m_panFIDValues[iFeat] = iShape;
+
+            if (iGeomArrowField >= 0)
+            {
+                if (nWKBSize == 0)
+                {
+                    sHelper.SetNull(iGeomArrowField, iFeat);
+                }
+                else
+                {
+                    GByte *pabyWKB = sHelper.GetPtrForStringOrBinary(
+                        iGeomArrowField, iFeat, nWKBSize);
+                    if (pabyWKB == nullptr)
+                    {
+                        if (psShape)
+                            SHPDestroyObject(psShape);
+                        sHelper.ClearArray();
+                        if (schema.release)
+                            schema.release(&schema);
+                        return ENOMEM;
+                    }
+                    if (poGeom)
+                        poGeom->exportToWkb(wkbNDR, pabyWKB, wkbVariantIso);
+                    else
+                        WriteWKBFromSHPObject(psShape, eLayerGeomType,
+                                              eWKBType, pabyWKB);
+                }
+                if (psShape)
+                    SHPDestroyObject(psShape);
+            }
+
+            for (int i = 0; hDBF != nullptr && i < sHelper.m_nFieldCount; ++i)
+            {
+                const int iArrowField = sHelper.m_mapOGRFieldToArrowField[i];
+                if (iArrowField < 0)
+                    continue;
+
+                // Extract the value and trim it, as DBFReadStringAttribute()
+                const char *pszValue = pszRecord + hDBF->panFieldOffset[i];
+                const void *pNulChar =
+                    memchr(pszValue, 0, hDBF->panFieldSize[i]);
+                size_t nLen =
+                    pNulChar ? static_cast<const char *>(pNulChar) - pszValue
+                             : static_cast<size_t>(hDBF->panFieldSize[i]);
+                while (nLen > 0 && *pszValue == ' ')
+                {
+                    ++pszValue;
+                    --nLen;
+                }
+                while (nLen > 0 && pszValue[nLen - 1] == ' ')
+                    --nLen;
+
+                auto psArray = out_array->children[iArrowField];
+                const auto eType = poFeatureDefn->GetFieldDefn(i)->GetType();
+                if (eType == OFTString)
+                {
+                    if (nLen == 0)
+                    {
+                        sHelper.SetNull(iArrowField, iFeat);
+                        continue;
+                    }
+                    char *pszRecoded = nullptr;
+                    if (!osEncoding.empty())
+                    {
+                        osValue.assign(pszValue, nLen);
+                        pszRecoded =
+                            CPLRecode(osValue.c_str(), osEncoding, CPL_ENC_UTF8);
+                        pszValue = pszRecoded;
+                        nLen = strlen(pszRecoded);
+                    }
+                    GByte *pabyStr =
+                        sHelper.GetPtrForStringOrBinary(iArrowField, iFeat, nLen);
+                    if (pabyStr == nullptr)
+                    {
+                        CPLFree(pszRecoded);
+                        sHelper.ClearArray();
+                        if (schema.release)
+                            schema.release(&schema);
+                        return ENOMEM;
+                    }
+                    memcpy(pabyStr, pszValue, nLen);
+                    CPLFree(pszRecoded);
+                    continue;
+                }
+
+                if (IsDBFValueNull(hDBF->pachFieldType[i], pszValue, nLen))
+                {
+                    sHelper.SetNull(iArrowField, iFeat);
+                    continue;
+                }
+                osValue.assign(pszValue, nLen);
+
+                // Same parsing as OGRFeature::SetField(int, const char*)
+                // and SHPReadOGRFeature()
+                switch (eType)
+                {
+                    case OFTInteger:
+                    {
+                        const long long nVal64 =
+                            std::strtoll(osValue.c_str(), nullptr, 10);
+                        sHelper.SetInt32(
+                            psArray, iFeat,
+                            nVal64 > INT_MAX   ? INT_MAX
+                            : nVal64 < INT_MIN ? INT_MIN
+                                               : static_cast<int>(nVal64));
+                        break;
+                    }
+
+                    case OFTInteger64:
+                        sHelper.SetInt64(
+                            psArray, iFeat,
+                            CPLAtoGIntBigEx(osValue.c_str(), FALSE, nullptr));
+                        break;
+
+                    case OFTReal:
+                        sHelper.SetDouble(psArray, iFeat,
+                                          CPLStrtod(osValue.c_str(), nullptr));
+                        break;
+
+                    case OFTDate:
+                    {
+                        const char *pszDate = osValue.c_str();
+                        OGRField sFld;
+                        memset(&sFld, 0, sizeof(sFld));
+                        if (nLen >= 10 && pszDate[2] == '/' &&
+                            pszDate[5] == '/')
+                        {
+                            sFld.Date.Month =
+                                static_cast<GByte>(atoi(pszDate + 0));
+                            sFld.Date.Day = static_cast<GByte>(atoi(pszDate + 3));
+                            sFld.Date.Year =
+                                static_cast<GInt16>(atoi(pszDate + 6));
+                        }
+                        else
+                        {
+                            const int nFullDate = atoi(pszDate);
+                            sFld.Date.Year =
+                                static_cast<GInt16>(nFullDate / 10000);
+                            sFld.Date.Month =
+                                static_cast<GByte>((nFullDate / 100) % 100);
+                            sFld.Date.Day = static_cast<GByte>(nFullDate % 100);
+                        }
+                        sHelper.SetDate(psArray, iFeat, brokenDown, sFld);
+                        break;
+                    }
+
+                    default:
+                        CPLAssert(false);
+                        break;
+                }
+            }
+
+            m_nFeaturesRead++;
+            ++iFeat;
+            ++iNextShapeId;
+        }
+
+        sHelper.Shrink(iFeat);
+
+        if (out_array->length != 0 && m_poFilterGeom != nullptr)
+        {
+            PostFilterArrowArray(&schema, out_array, nullptr);
+            if (out_array->release == nullptr)
+            {
+                schema.release(&schema);
+                return ENOMEM;
+            }
+        }
+
+        if (out_array->length != 0)
+            break;
+
+        // Everything has been filtered out: try with the next records
+        out_array->release(out_array);
+    }
+
+    if (schema.release)
+        schema.release(&schema);
+    return 0;
+}
+
 /************************************************************************/
 /*                             StartUpdate()                            */
 /************************************************************************/
@@ -1860,6 +2650,13 @@ int OGRShapeLayer::TestCapability(const char *pszCap)
         return TRUE;
     }
 
+    if (EQUAL(pszCap, OLCFastGetArrowStream))
+    {
+        // Consistent with the conditions of GetNextArrowArray()
+        return m_poAttrQuery == nullptr &&
+               (m_poFilterGeom == nullptr || !(CheckForQIX() || CheckForSBN()));
+    }
+
     if (EQUAL(pszCap, OLCMeasuredGeometries))
         return TRUE;
 
@@ -2638,6 +3435,8 @@ OGRErr OGRShapeLayer::DropSpatialIndex()
     hSBN = nullptr;
     bCheckedForSBN = false;
 
+    ReleaseIngestedSpatialIndexFiles();
+
     if (bHadQIX)
     {
         const char *pszQIXFilename = CPLResetExtension(pszFullName, "qix");
@@ -3675,6 +4474,8 @@ void OGRShapeLayer::CloseUnderlyingLayer()
     hSBN = nullptr;
     bCheckedForSBN = false;
 
+    ReleaseIngestedSpatialIndexFiles();
+
     eFileDescriptorsState = FD_CLOSED;
 }
 
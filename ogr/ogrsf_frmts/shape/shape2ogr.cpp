@@ -1298,6 +1298,38 @@ OGRFeatureDefn *SHPReadOGRFeatureDefn(const char *pszName, SHPHandle hSHP,
     return poDefn;
 }
 
+/************************************************************************/
+/*                    SHPForceOGRGeometryDimension()                    */
+/*                                                                      */
+/*      Set/unset the Z and M flags of a geometry read from a           */
+/*      shapefile so that they match the ones of the layer.             */
+/************************************************************************/
+
+void SHPForceOGRGeometryDimension(OGRGeometry *poGeometry,
+                                  OGRwkbGeometryType eLayerGeomType)
+{
+    if (eLayerGeomType == wkbUnknown)
+        return;
+
+    const OGRwkbGeometryType eGeomInType = poGeometry->getGeometryType();
+    if (wkbHasZ(eLayerGeomType) && !wkbHasZ(eGeomInType))
+    {
+        poGeometry->set3D(TRUE);
+    }
+    else if (!wkbHasZ(eLayerGeomType) && wkbHasZ(eGeomInType))
+    {
+        poGeometry->set3D(FALSE);
+    }
+    if (wkbHasM(eLayerGeomType) && !wkbHasM(eGeomInType))
+    {
+        poGeometry->setMeasured(TRUE);
+    }
+    else if (!wkbHasM(eLayerGeomType) && wkbHasM(eGeomInType))
+    {
+        poGeometry->setMeasured(FALSE);
+    }
+}
+
 /************************************************************************/
 /*                         SHPReadOGRFeature()                          */
 /************************************************************************/
@@ -1351,31 +1383,9 @@ OGRFeature *SHPReadOGRFeature(SHPHandle hSHP, DBFHandle hDBF,
 
             if (poGeometry)
             {
-                // Set/unset flags.
-                const OGRwkbGeometryType eMyGeomType =
-                    poFeature->GetDefnRef()->GetGeomFieldDefn(0)->GetType();
-
-                if (eMyGeomType != wkbUnknown)
-                {
-                    OGRwkbGeometryType eGeomInType =
-                        poGeometry->getGeometryType();
-                    if (wkbHasZ(eMyGeomType) && !wkbHasZ(eGeomInType))
-                    {
-                        poGeometry->set3D(TRUE);
-                    }
-                    else if (!wkbHasZ(eMyGeomType) && wkbHasZ(eGeomInType))
-                    {
-                        poGeometry->set3D(FALSE);
-                    }
-                    if (wkbHasM(eMyGeomType) && !wkbHasM(eGeomInType))
-                    {
-                        poGeometry->setMeasured(TRUE);
-                    }
-                    else if (!wkbHasM(eMyGeomType) && wkbHasM(eGeomInType))
-                    {
-                        poGeometry->setMeasured(FALSE);
-                    }
-                }
+                SHPForceOGRGeometryDimension(
+                    poGeometry,
+                    poFeature->GetDefnRef()->GetGeomFieldDefn(0)->GetType());
             }
 
             poFeature->SetGeometryDirectly(poGeometry);
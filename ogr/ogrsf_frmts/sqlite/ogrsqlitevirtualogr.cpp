@@ -31,12 +31,14 @@
 #include "cpl_port.h"
 #include "ogrsqlitevirtualogr.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <limits>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -45,6 +47,7 @@
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_string.h"
+#include "cpl_time.h"
 
 /************************************************************************/
 /*                  OGR2SQLITE_GetNameForGeometryColumn()               */
@@ -128,6 +131,7 @@ void OGR2SQLITE_Register()
 #include "ogr_feature.h"
 #include "ogr_geometry.h"
 #include "ogr_p.h"
+#include "ogr_recordbatch.h"
 #include "ogr_spatialref.h"
 #include "ogrsf_frmts.h"
 #include "ogrsqlitesqlfunctions.h"
@@ -389,6 +393,95 @@ typedef struct
     bool bHasFIDColumn;
 } OGR2SQLITE_vtab;
 
+/************************************************************************/
+/*                        OGR2SQLITEArrowReader                         */
+/************************************************************************/
+
+/* Reads a layer by batches through its ArrowArrayStream, and serves the */
+/* values of the virtual table columns directly from the Arrow buffers, */
+/* without instantiating OGRFeature objects. */
+
+class OGR2SQLITEArrowReader
+{
+    enum class ColType
+    {
+        Boolean,
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Int64,
+        Float32,
+        Float64,
+        String,
+        LargeString,
+        Binary,
+        LargeBinary,
+        FixedSizeBinary,
+        Date32,
+        Time32Milli,
+        TimestampMilliUTC,
+    };
+
+    struct ColumnDesc
+    {
+        int iChild = -1; /* -1 for an ignored field */
+        ColType eType = ColType::Int32;
+        int nWidth = 0; /* for FixedSizeBinary */
+    };
+
+    struct ArrowArrayStream m_sStream;
+    struct ArrowSchema m_sSchema;
+    struct ArrowArray m_sBatch;
+    int64_t m_nRow = -1;
+    bool m_bEOF = false;
+    int m_iFIDChild = -1;
+    std::vector<ColumnDesc> m_aoFields{};
+    std::vector<int> m_anGeomChild{};
+    std::vector<bool> m_abGeomLargeBinary{};
+    std::vector<int> m_anGeomSRSId{};
+
+    static bool GetColType(const OGRFieldDefn *poFieldDefn,
+                           const char *pszFormat, ColumnDesc &oDesc);
+
+    size_t GetIndex(const struct ArrowArray *psArray) const
+    {
+        return static_cast<size_t>(m_sBatch.offset + m_nRow + psArray->offset);
+    }
+
+    static bool IsNull(const struct ArrowArray *psArray, size_t nIdx)
+    {
+        return psArray->null_count != 0 && psArray->buffers[0] != nullptr &&
+               (static_cast<const GByte *>(psArray->buffers[0])[nIdx / 8] &
+                (1 << (nIdx % 8))) == 0;
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(OGR2SQLITEArrowReader)
+
+  public:
+    OGR2SQLITEArrowReader();
+    ~OGR2SQLITEArrowReader();
+
+    bool Init(OGRLayer *poLayer, OGR2SQLITEModule *poModule);
+    bool Next();
+
+    bool IsEOF() const
+    {
+        return m_bEOF;
+    }
+
+    GIntBig GetFID() const;
+    void ResultField(sqlite3_context *pContext, int iField) const;
+    const GByte *GetWKB(int iGeomField, size_t &nWKBSize) const;
+
+    int GetGeomSRSId(int iGeomField) const
+    {
+        return m_anGeomSRSId[iGeomField];
+    }
+};
+
 /************************************************************************/
 /*                          OGR2SQLITE_vtab_cursor                      */
 /************************************************************************/
@@ -413,8 +506,530 @@ typedef struct
 
     GByte *pabyGeomBLOB;
     int nGeomBLOBLen;
+
+    /* Non-NULL when the layer is read through its ArrowArrayStream, in */
+    /* which case poFeature is not used. */
+    OGR2SQLITEArrowReader *poArrowReader;
 } OGR2SQLITE_vtab_cursor;
 
+/* Set in sqlite3_index_info::idxNum by OGR2SQLITE_BestIndex() when the */
+/* statement does not use the OGR_STYLE column, that OGR2SQLITEArrowReader */
+/* cannot serve. */
+#define OGR2SQLITE_IDXNUM_ARROW_STREAM_COMPATIBLE 1
+
+/************************************************************************/
+/*                       OGR2SQLITEArrowReader()                        */
+/************************************************************************/
+
+OGR2SQLITEArrowReader::OGR2SQLITEArrowReader()
+{
+    memset(&m_sStream, 0, sizeof(m_sStream));
+    memset(&m_sSchema, 0, sizeof(m_sSchema));
+    memset(&m_sBatch, 0, sizeof(m_sBatch));
+}
+
+/************************************************************************/
+/*                      ~OGR2SQLITEArrowReader()                        */
+/************************************************************************/
+
+OGR2SQLITEArrowReader::~OGR2SQLITEArrowReader()
+{
+    if (m_sBatch.release)
+        m_sBatch.release(&m_sBatch);
+    if (m_sSchema.release)
+        m_sSchema.release(&m_sSchema);
+    if (m_sStream.release)
+        m_sStream.release(&m_sStream);
+}
+
+/************************************************************************/
+/*                            GetColType()                              */
+/************************************************************************/
+
+/* Only accept the Arrow types for which the value served to SQLite is */
+/* exactly the one that OGR2SQLITE_Column() would get from an OGRFeature. */
+
+bool OGR2SQLITEArrowReader::GetColType(const OGRFieldDefn *poFieldDefn,
+                                       const char *pszFormat,
+                                       ColumnDesc &oDesc)
+{
+    switch (poFieldDefn->GetType())
+    {
+        case OFTInteger:
+        {
+            if (strcmp(pszFormat, "b") == 0)
+                oDesc.eType = ColType::Boolean;
+            else if (strcmp(pszFormat, "c") == 0)
+                oDesc.eType = ColType::Int8;
+            else if (strcmp(pszFormat, "C") == 0)
+                oDesc.eType = ColType::UInt8;
+            else if (strcmp(pszFormat, "s") == 0)
+                oDesc.eType = ColType::Int16;
+            else if (strcmp(pszFormat, "S") == 0)
+                oDesc.eType = ColType::UInt16;
+            else if (strcmp(pszFormat, "i") == 0)
+                oDesc.eType = ColType::Int32;
+            else
+                return false;
+            return true;
+        }
+
+        case OFTInteger64:
+        {
+            if (strcmp(pszFormat, "I") == 0)
+                oDesc.eType = ColType::UInt32;
+            else if (strcmp(pszFormat, "l") == 0)
+                oDesc.eType = ColType::Int64;
+            else
+                return false;
+            return true;
+        }
+
+        case OFTReal:
+        {
+            if (strcmp(pszFormat, "f") == 0)
+                oDesc.eType = ColType::Float32;
+            else if (strcmp(pszFormat, "g") == 0)
+                oDesc.eType = ColType::Float64;
+            else
+                return false;
+            return true;
+        }
+
+        case OFTString:
+        {
+            if (strcmp(pszFormat, "u") == 0)
+                oDesc.eType = ColType::String;
+            else if (strcmp(pszFormat, "U") == 0)
+                oDesc.eType = ColType::LargeString;
+            else
+                return false;
+            return true;
+        }
+
+        case OFTBinary:
+        {
+            if (strcmp(pszFormat, "z") == 0)
+                oDesc.eType = ColType::Binary;
+            else if (strcmp(pszFormat, "Z") == 0)
+                oDesc.eType = ColType::LargeBinary;
+            else if (strncmp(pszFormat, "w:", 2) == 0)
+            {
+                oDesc.eType = ColType::FixedSizeBinary;
+                oDesc.nWidth = atoi(pszFormat + 2);
+                if (oDesc.nWidth <= 0)
+                    return false;
+            }
+            else
+                return false;
+            return true;
+        }
+
+        case OFTDate:
+        {
+            if (strcmp(pszFormat, "tdD") != 0)
+                return false;
+            oDesc.eType = ColType::Date32;
+            return true;
+        }
+
+        case OFTTime:
+        {
+            if (strcmp(pszFormat, "ttm") != 0)
+                return false;
+            oDesc.eType = ColType::Time32Milli;
+            return true;
+        }
+
+        case OFTDateTime:
+        {
+            // Timestamps without a UTC time zone in the Arrow stream may
+            // have lost the per-feature time zone of the OGR values.
+            if (strcmp(pszFormat, "tsm:UTC") != 0 ||
+                poFieldDefn->GetTZFlag() != OGR_TZFLAG_UTC)
+            {
+                return false;
+            }
+            oDesc.eType = ColType::TimestampMilliUTC;
+            return true;
+        }
+
+        default:
+            break;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                                Init()                                */
+/************************************************************************/
+
+/* Returns false if the layer cannot be served through its */
+/* ArrowArrayStream, in which case OGRFeature based reading must be used. */
+
+bool OGR2SQLITEArrowReader::Init(OGRLayer *poLayer, OGR2SQLITEModule *poModule)
+{
+    const char *const apszOptions[] = {"INCLUDE_FID=YES",
+                                       "GEOMETRY_ENCODING=WKB", nullptr};
+    if (!poLayer->GetArrowStream(&m_sStream, apszOptions))
+        return false;
+    if (m_sStream.get_schema(&m_sStream, &m_sSchema) != 0 ||
+        strcmp(m_sSchema.format, "+s") != 0)
+    {
+        return false;
+    }
+
+    std::map<std::string, int> oMapNameToChild;
+    for (int64_t i = 0; i < m_sSchema.n_children; ++i)
+    {
+        if (!oMapNameToChild
+                 .insert(std::pair<std::string, int>(
+                     m_sSchema.children[i]->name, static_cast<int>(i)))
+                 .second)
+        {
+            return false;
+        }
+    }
+
+    const char *pszFIDName = poLayer->GetFIDColumn();
+    const auto oIterFID = oMapNameToChild.find(
+        (pszFIDName && pszFIDName[0]) ? pszFIDName
+                                      : OGRLayer::DEFAULT_ARROW_FID_NAME);
+    if (oIterFID == oMapNameToChild.end() ||
+        strcmp(m_sSchema.children[oIterFID->second]->format, "l") != 0)
+    {
+        return false;
+    }
+    m_iFIDChild = oIterFID->second;
+
+    const OGRFeatureDefn *poFDefn = poLayer->GetLayerDefn();
+    const int nFieldCount = poFDefn->GetFieldCount();
+    m_aoFields.resize(nFieldCount);
+    for (int i = 0; i < nFieldCount; ++i)
+    {
+        const OGRFieldDefn *poFieldDefn = poFDefn->GetFieldDefn(i);
+        if (poFieldDefn->IsIgnored())
+            continue;
+        const auto oIter = oMapNameToChild.find(poFieldDefn->GetNameRef());
+        if (oIter == oMapNameToChild.end())
+            return false;
+        const struct ArrowSchema *psChild = m_sSchema.children[oIter->second];
+        if (psChild->dictionary != nullptr ||
+            !GetColType(poFieldDefn, psChild->format, m_aoFields[i]))
+        {
+            return false;
+        }
+        m_aoFields[i].iChild = oIter->second;
+    }
+
+    const int nGeomFieldCount = poFDefn->GetGeomFieldCount();
+    m_anGeomChild.resize(nGeomFieldCount, -1);
+    m_abGeomLargeBinary.resize(nGeomFieldCount, false);
+    m_anGeomSRSId.resize(nGeomFieldCount, -1);
+    for (int i = 0; i < nGeomFieldCount; ++i)
+    {
+        const OGRGeomFieldDefn *poGeomFieldDefn = poFDefn->GetGeomFieldDefn(i);
+        if (poGeomFieldDefn->IsIgnored())
+            continue;
+        const char *pszGeomFieldName = poGeomFieldDefn->GetNameRef();
+        const auto oIter = oMapNameToChild.find(
+            pszGeomFieldName[0] ? pszGeomFieldName
+                                : OGRLayer::DEFAULT_ARROW_GEOMETRY_NAME);
+        if (oIter == oMapNameToChild.end())
+            return false;
+        const char *pszFormat = m_sSchema.children[oIter->second]->format;
+        if (strcmp(pszFormat, "z") != 0 && strcmp(pszFormat, "Z") != 0)
+            return false;
+        m_anGeomChild[i] = oIter->second;
+        m_abGeomLargeBinary[i] = pszFormat[0] == 'Z';
+        m_anGeomSRSId[i] =
+            poModule->FetchSRSId(poGeomFieldDefn->GetSpatialRef());
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                                Next()                                */
+/************************************************************************/
+
+bool OGR2SQLITEArrowReader::Next()
+{
+    if (m_bEOF)
+        return false;
+    ++m_nRow;
+    while (m_sBatch.release == nullptr || m_nRow >= m_sBatch.length)
+    {
+        if (m_sBatch.release)
+            m_sBatch.release(&m_sBatch);
+        memset(&m_sBatch, 0, sizeof(m_sBatch));
+        m_nRow = 0;
+        if (m_sStream.get_next(&m_sStream, &m_sBatch) != 0 ||
+            m_sBatch.release == nullptr)
+        {
+            m_bEOF = true;
+            return false;
+        }
+        if (m_sBatch.n_children != m_sSchema.n_children)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "OGR2SQLITEArrowReader: unexpected number of children "
+                     "in batch");
+            m_bEOF = true;
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                               GetFID()                               */
+/************************************************************************/
+
+GIntBig OGR2SQLITEArrowReader::GetFID() const
+{
+    const struct ArrowArray *psArray = m_sBatch.children[m_iFIDChild];
+    const size_t nIdx = GetIndex(psArray);
+    if (IsNull(psArray, nIdx))
+        return OGRNullFID;
+    return static_cast<const int64_t *>(psArray->buffers[1])[nIdx];
+}
+
+/************************************************************************/
+/*                       OGR2SQLITE_ResultDate()                        */
+/************************************************************************/
+
+static void OGR2SQLITE_ResultDate(sqlite3_context *pContext, int nYear,
+                                  int nMonth, int nDay)
+{
+    char szBuffer[64];
+    snprintf(szBuffer, sizeof(szBuffer), "%04d-%02d-%02d", nYear, nMonth,
+             nDay);
+    sqlite3_result_text(pContext, szBuffer, -1, SQLITE_TRANSIENT);
+}
+
+/************************************************************************/
+/*                       OGR2SQLITE_ResultTime()                        */
+/************************************************************************/
+
+static void OGR2SQLITE_ResultTime(sqlite3_context *pContext, int nHour,
+                                  int nMinute, float fSecond)
+{
+    char szBuffer[64];
+    if (OGR_GET_MS(fSecond) != 0)
+        snprintf(szBuffer, sizeof(szBuffer), "%02d:%02d:%06.3f", nHour,
+                 nMinute, fSecond);
+    else
+        snprintf(szBuffer, sizeof(szBuffer), "%02d:%02d:%02d", nHour, nMinute,
+                 (int)fSecond);
+    sqlite3_result_text(pContext, szBuffer, -1, SQLITE_TRANSIENT);
+}
+
+/************************************************************************/
+/*                       OGR2SQLITE_ResultBytes()                       */
+/************************************************************************/
+
+static void OGR2SQLITE_ResultBytes(sqlite3_context *pContext, bool bText,
+                                   const char *pData, int64_t nLen)
+{
+    if (nLen > std::numeric_limits<int>::max())
+        sqlite3_result_error_toobig(pContext);
+    else if (bText)
+        sqlite3_result_text(pContext, pData, static_cast<int>(nLen),
+                            SQLITE_TRANSIENT);
+    else
+        sqlite3_result_blob(pContext, pData, static_cast<int>(nLen),
+                            SQLITE_TRANSIENT);
+}
+
+/************************************************************************/
+/*                            ResultField()                             */
+/************************************************************************/
+
+void OGR2SQLITEArrowReader::ResultField(sqlite3_context *pContext,
+                                        int iField) const
+{
+    const ColumnDesc &oDesc = m_aoFields[iField];
+    if (oDesc.iChild < 0)
+    {
+        sqlite3_result_null(pContext);
+        return;
+    }
+
+    const struct ArrowArray *psArray = m_sBatch.children[oDesc.iChild];
+    const size_t nIdx = GetIndex(psArray);
+    if (IsNull(psArray, nIdx))
+    {
+        sqlite3_result_null(pContext);
+        return;
+    }
+
+    const void *pData = psArray->buffers[1];
+    switch (oDesc.eType)
+    {
+        case ColType::Boolean:
+            sqlite3_result_int(
+                pContext,
+                (static_cast<const GByte *>(pData)[nIdx / 8] >> (nIdx % 8)) &
+                    1);
+            break;
+
+        case ColType::Int8:
+            sqlite3_result_int(pContext,
+                               static_cast<const int8_t *>(pData)[nIdx]);
+            break;
+
+        case ColType::UInt8:
+            sqlite3_result_int(pContext,
+                               static_cast<const uint8_t *>(pData)[nIdx]);
+            break;
+
+        case ColType::Int16:
+            sqlite3_result_int(pContext,
+                               static_cast<const int16_t *>(pData)[nIdx]);
+            break;
+
+        case ColType::UInt16:
+            sqlite3_result_int(pContext,
+                               static_cast<const uint16_t *>(pData)[nIdx]);
+            break;
+
+        case ColType::Int32:
+            sqlite3_result_int(pContext,
+                               static_cast<const int32_t *>(pData)[nIdx]);
+            break;
+
+        case ColType::UInt32:
+            sqlite3_result_int64(pContext,
+                                 static_cast<const uint32_t *>(pData)[nIdx]);
+            break;
+
+        case ColType::Int64:
+            sqlite3_result_int64(pContext,
+                                 static_cast<const int64_t *>(pData)[nIdx]);
+            break;
+
+        case ColType::Float32:
+            sqlite3_result_double(pContext,
+                                  static_cast<const float *>(pData)[nIdx]);
+            break;
+
+        case ColType::Float64:
+            sqlite3_result_double(pContext,
+                                  static_cast<const double *>(pData)[nIdx]);
+            break;
+
+        case ColType::String:
+        case ColType::Binary:
+        {
+            const auto panOffsets = static_cast<const int32_t *>(pData);
+            OGR2SQLITE_ResultBytes(
+                pContext, oDesc.eType == ColType::String,
+                static_cast<const char *>(psArray->buffers[2]) +
+                    panOffsets[nIdx],
+                panOffsets[nIdx + 1] - panOffsets[nIdx]);
+            break;
+        }
+
+        case ColType::LargeString:
+        case ColType::LargeBinary:
+        {
+            const auto panOffsets = static_cast<const int64_t *>(pData);
+            OGR2SQLITE_ResultBytes(
+                pContext, oDesc.eType == ColType::LargeString,
+                static_cast<const char *>(psArray->buffers[2]) +
+                    panOffsets[nIdx],
+                panOffsets[nIdx + 1] - panOffsets[nIdx]);
+            break;
+        }
+
+        case ColType::FixedSizeBinary:
+        {
+            OGR2SQLITE_ResultBytes(pContext, false,
+                                   static_cast<const char *>(pData) +
+                                       nIdx * oDesc.nWidth,
+                                   oDesc.nWidth);
+            break;
+        }
+
+        case ColType::Date32:
+        {
+            const GIntBig nDays = static_cast<const int32_t *>(pData)[nIdx];
+            struct tm brokenDown;
+            CPLUnixTimeToYMDHMS(nDays * 86400, &brokenDown);
+            OGR2SQLITE_ResultDate(pContext, brokenDown.tm_year + 1900,
+                                  brokenDown.tm_mon + 1, brokenDown.tm_mday);
+            break;
+        }
+
+        case ColType::Time32Milli:
+        {
+            const int nMS = static_cast<const int32_t *>(pData)[nIdx];
+            OGR2SQLITE_ResultTime(
+                pContext, nMS / 3600000, (nMS / 60000) % 60,
+                static_cast<float>((nMS % 60000) / 1000.0));
+            break;
+        }
+
+        case ColType::TimestampMilliUTC:
+        {
+            const int64_t nVal = static_cast<const int64_t *>(pData)[nIdx];
+            GIntBig nSec = nVal / 1000;
+            int nMS = static_cast<int>(nVal % 1000);
+            if (nMS < 0)
+            {
+                nMS += 1000;
+                nSec--;
+            }
+            struct tm brokenDown;
+            CPLUnixTimeToYMDHMS(nSec, &brokenDown);
+            OGRField sField;
+            sField.Date.Year = static_cast<GInt16>(brokenDown.tm_year + 1900);
+            sField.Date.Month = static_cast<GByte>(brokenDown.tm_mon + 1);
+            sField.Date.Day = static_cast<GByte>(brokenDown.tm_mday);
+            sField.Date.Hour = static_cast<GByte>(brokenDown.tm_hour);
+            sField.Date.Minute = static_cast<GByte>(brokenDown.tm_min);
+            sField.Date.Second =
+                static_cast<float>(brokenDown.tm_sec + nMS / 1000.0);
+            sField.Date.TZFlag = OGR_TZFLAG_UTC;
+            char *pszStr = OGRGetXMLDateTime(&sField);
+            sqlite3_result_text(pContext, pszStr, -1, SQLITE_TRANSIENT);
+            CPLFree(pszStr);
+            break;
+        }
+    }
+}
+
+/************************************************************************/
+/*                               GetWKB()                               */
+/************************************************************************/
+
+/* Returns nullptr for a null or ignored geometry. */
+
+const GByte *OGR2SQLITEArrowReader::GetWKB(int iGeomField,
+                                           size_t &nWKBSize) const
+{
+    nWKBSize = 0;
+    const int iChild = m_anGeomChild[iGeomField];
+    if (iChild < 0)
+        return nullptr;
+    const struct ArrowArray *psArray = m_sBatch.children[iChild];
+    const size_t nIdx = GetIndex(psArray);
+    if (IsNull(psArray, nIdx))
+        return nullptr;
+    const GByte *pabyData = static_cast<const GByte *>(psArray->buffers[2]);
+    if (m_abGeomLargeBinary[iGeomField])
+    {
+        const auto panOffsets =
+            static_cast<const int64_t *>(psArray->buffers[1]);
+        nWKBSize = static_cast<size_t>(panOffsets[nIdx + 1] - panOffsets[nIdx]);
+        return pabyData + panOffsets[nIdx];
+    }
+    const auto panOffsets = static_cast<const int32_t *>(psArray->buffers[1]);
+    nWKBSize = static_cast<size_t>(panOffsets[nIdx + 1] - panOffsets[nIdx]);
+    return pabyData + panOffsets[nIdx];
+}
+
 #ifdef VIRTUAL_OGR_DYNAMIC_EXTENSION_ENABLED
 
 /************************************************************************/
@@ -1001,6 +1616,25 @@ static int OGR2SQLITE_BestIndex(sqlite3_vtab *pVTab, sqlite3_index_info *pIndex)
     pIndex->orderByConsumed = false;
     pIndex->idxNum = 0;
 
+#if SQLITE_VERSION_NUMBER >= 3010000L
+    /* The OGR_STYLE column is not available from the ArrowArrayStream of */
+    /* the layer. OGR_NATIVE_DATA and OGR_NATIVE_MEDIA_TYPE are not either, */
+    /* but they are always exposed by OGRSQLiteExecuteSQL(), and drivers */
+    /* with a fast GetArrowStream() implementation do not set them. */
+    /* colUsed is only set by SQLite >= 3.10 */
+    if (sqlite3_libversion_number() >= 3010000)
+    {
+        const int nStyleCol =
+            (pMyVTab->bHasFIDColumn ? 1 : 0) + poFDefn->GetFieldCount();
+        // Bit 63 is set if any column beyond the 63th one is used
+        if ((pIndex->colUsed & (static_cast<sqlite3_uint64>(1)
+                                << std::min(nStyleCol, 63))) == 0)
+        {
+            pIndex->idxNum = OGR2SQLITE_IDXNUM_ARROW_STREAM_COMPATIBLE;
+        }
+    }
+#endif
+
     if (nConstraints != 0)
     {
         pIndex->idxStr = (char *)panConstraints;
@@ -1110,6 +1744,7 @@ static int OGR2SQLITE_Close(sqlite3_vtab_cursor *pCursor)
     pMyVTab->nMyRef--;
 
     delete pMyCursor->poFeature;
+    delete pMyCursor->poArrowReader;
     delete pMyCursor->poDupDataSource;
 
     CPLFree(pMyCursor->pabyGeomBLOB);
@@ -1123,8 +1758,8 @@ static int OGR2SQLITE_Close(sqlite3_vtab_cursor *pCursor)
 /*                          OGR2SQLITE_Filter()                         */
 /************************************************************************/
 
-static int OGR2SQLITE_Filter(sqlite3_vtab_cursor *pCursor,
-                             CPL_UNUSED int idxNum, const char *idxStr,
+static int OGR2SQLITE_Filter(sqlite3_vtab_cursor *pCursor, int idxNum,
+                             const char *idxStr,
                              int argc, sqlite3_value **argv)
 {
     OGR2SQLITE_vtab_cursor *pMyCursor = (OGR2SQLITE_vtab_cursor *)pCursor;
@@ -1138,6 +1773,14 @@ static int OGR2SQLITE_Filter(sqlite3_vtab_cursor *pCursor,
     if (nConstraints != argc)
         return SQLITE_ERROR;
 
+    delete pMyCursor->poFeature;
+    pMyCursor->poFeature = nullptr;
+    delete pMyCursor->poArrowReader;
+    pMyCursor->poArrowReader = nullptr;
+    CPLFree(pMyCursor->pabyGeomBLOB);
+    pMyCursor->pabyGeomBLOB = nullptr;
+    pMyCursor->nGeomBLOBLen = -1;
+
     CPLString osAttributeFilter;
 
     OGRFeatureDefn *poFDefn = pMyCursor->poLayer->GetLayerDefn();
@@ -1306,13 +1949,41 @@ static int OGR2SQLITE_Filter(sqlite3_vtab_cursor *pCursor,
         pMyCursor->nFeatureCount = -1;
     pMyCursor->poLayer->ResetReading();
 
+    /* Read layers with a fast Arrow implementation by batches, and serve */
+    /* the columns from the Arrow buffers. */
+    if ((idxNum & OGR2SQLITE_IDXNUM_ARROW_STREAM_COMPATIBLE) != 0 &&
+        pMyCursor->poLayer->TestCapability(OLCFastGetArrowStream) &&
+        CPLTestBool(
+            CPLGetConfigOption("OGR_SQLITE_DIALECT_USE_ARROW_STREAM", "YES")))
+    {
+        auto poArrowReader = std::make_unique<OGR2SQLITEArrowReader>();
+        if (poArrowReader->Init(pMyCursor->poLayer,
+                                pMyCursor->pVTab->poModule))
+        {
+            pMyCursor->poArrowReader = poArrowReader.release();
+        }
+        else
+        {
+            poArrowReader.reset();
+            pMyCursor->poLayer->ResetReading();
+        }
+    }
+
     if (pMyCursor->nFeatureCount < 0)
     {
-        pMyCursor->poFeature = pMyCursor->poLayer->GetNextFeature();
+        if (pMyCursor->poArrowReader)
+        {
+            pMyCursor->poArrowReader->Next();
+        }
+        else
+        {
+            pMyCursor->poFeature = pMyCursor->poLayer->GetNextFeature();
 #ifdef DEBUG_OGR2SQLITE
-        CPLDebug("OGR2SQLITE", "GetNextFeature() --> " CPL_FRMT_GIB,
-                 pMyCursor->poFeature ? pMyCursor->poFeature->GetFID() : -1);
+            CPLDebug("OGR2SQLITE", "GetNextFeature() --> " CPL_FRMT_GIB,
+                     pMyCursor->poFeature ? pMyCursor->poFeature->GetFID()
+                                          : -1);
 #endif
+        }
     }
 
     pMyCursor->nNextWishedIndex = 0;
@@ -1333,7 +2004,15 @@ static int OGR2SQLITE_Next(sqlite3_vtab_cursor *pCursor)
 #endif
 
     pMyCursor->nNextWishedIndex++;
-    if (pMyCursor->nFeatureCount < 0)
+    if (pMyCursor->nFeatureCount < 0 && pMyCursor->poArrowReader)
+    {
+        pMyCursor->poArrowReader->Next();
+
+        CPLFree(pMyCursor->pabyGeomBLOB);
+        pMyCursor->pabyGeomBLOB = nullptr;
+        pMyCursor->nGeomBLOBLen = -1;
+    }
+    else if (pMyCursor->nFeatureCount < 0)
     {
         delete pMyCursor->poFeature;
         pMyCursor->poFeature = pMyCursor->poLayer->GetNextFeature();
@@ -1363,6 +2042,8 @@ static int OGR2SQLITE_Eof(sqlite3_vtab_cursor *pCursor)
 
     if (pMyCursor->nFeatureCount < 0)
     {
+        if (pMyCursor->poArrowReader)
+            return pMyCursor->poArrowReader->IsEOF();
         return pMyCursor->poFeature == nullptr;
     }
     else
@@ -1385,6 +2066,12 @@ static void OGR2SQLITE_GoToWishedIndex(OGR2SQLITE_vtab_cursor *pMyCursor)
             {
                 pMyCursor->nCurFeatureIndex++;
 
+                if (pMyCursor->poArrowReader)
+                {
+                    pMyCursor->poArrowReader->Next();
+                    continue;
+                }
+
                 delete pMyCursor->poFeature;
                 pMyCursor->poFeature = pMyCursor->poLayer->GetNextFeature();
 #ifdef DEBUG_OGR2SQLITE
@@ -1436,6 +2123,106 @@ static void OGR2SQLITE_ExportGeometry(OGRGeometry *poGeom, int nSRSId,
     }
 }
 
+/************************************************************************/
+/*                       OGR2SQLITE_ArrowColumn()                       */
+/************************************************************************/
+
+static int OGR2SQLITE_ArrowColumn(OGR2SQLITE_vtab_cursor *pMyCursor,
+                                  sqlite3_context *pContext, int nCol)
+{
+    const OGR2SQLITEArrowReader *poReader = pMyCursor->poArrowReader;
+    if (poReader->IsEOF())
+        return SQLITE_ERROR;
+
+    if (pMyCursor->pVTab->bHasFIDColumn)
+    {
+        if (nCol == 0)
+        {
+            sqlite3_result_int64(pContext, poReader->GetFID());
+            return SQLITE_OK;
+        }
+        --nCol;
+    }
+
+    OGRFeatureDefn *poFDefn = pMyCursor->poLayer->GetLayerDefn();
+    const int nFieldCount = poFDefn->GetFieldCount();
+    const int nGeomFieldCount = poFDefn->GetGeomFieldCount();
+
+    if (nCol >= 0 && nCol < nFieldCount)
+    {
+        poReader->ResultField(pContext, nCol);
+        return SQLITE_OK;
+    }
+
+    const int iGeomField = nCol - (nFieldCount + 1);
+    if (iGeomField >= 0 && iGeomField < nGeomFieldCount)
+    {
+        /* The BLOB of the first geometry field is cached in the cursor */
+        /* as in OGR2SQLITE_Column() */
+        if (iGeomField != 0 || pMyCursor->nGeomBLOBLen < 0)
+        {
+            GByte *pabyGeomBLOB = nullptr;
+            int nGeomBLOBLen = 0;
+            size_t nWKBSize = 0;
+            const GByte *pabyWKB = poReader->GetWKB(iGeomField, nWKBSize);
+            OGRGeometry *poGeom = nullptr;
+            if (pabyWKB != nullptr &&
+                OGRGeometryFactory::createFromWkb(pabyWKB, nullptr, &poGeom,
+                                                  nWKBSize) == OGRERR_NONE)
+            {
+                OGR2SQLITE_ExportGeometry(poGeom,
+                                          poReader->GetGeomSRSId(iGeomField),
+                                          pabyGeomBLOB, nGeomBLOBLen);
+                delete poGeom;
+            }
+
+            if (iGeomField != 0)
+            {
+                if (nGeomBLOBLen == 0)
+                {
+                    CPLFree(pabyGeomBLOB);
+                    sqlite3_result_null(pContext);
+                }
+                else
+                {
+                    sqlite3_result_blob(pContext, pabyGeomBLOB, nGeomBLOBLen,
+                                        CPLFree);
+                }
+                return SQLITE_OK;
+            }
+
+            CPLAssert(pMyCursor->pabyGeomBLOB == nullptr);
+            pMyCursor->pabyGeomBLOB = pabyGeomBLOB;
+            pMyCursor->nGeomBLOBLen = nGeomBLOBLen;
+        }
+
+        if (pMyCursor->nGeomBLOBLen == 0)
+        {
+            sqlite3_result_null(pContext);
+        }
+        else
+        {
+            GByte *pabyGeomBLOBDup =
+                (GByte *)CPLMalloc(pMyCursor->nGeomBLOBLen);
+            memcpy(pabyGeomBLOBDup, pMyCursor->pabyGeomBLOB,
+                   pMyCursor->nGeomBLOBLen);
+            sqlite3_result_blob(pContext, pabyGeomBLOBDup,
+                                pMyCursor->nGeomBLOBLen, CPLFree);
+        }
+        return SQLITE_OK;
+    }
+
+    /* OGR_STYLE (OGR2SQLITE_BestIndex() prevents it from being requested), */
+    /* OGR_NATIVE_DATA and OGR_NATIVE_MEDIA_TYPE */
+    if (nCol >= nFieldCount && nCol < nFieldCount + 1 + nGeomFieldCount + 2)
+    {
+        sqlite3_result_null(pContext);
+        return SQLITE_OK;
+    }
+
+    return SQLITE_ERROR;
+}
+
 /************************************************************************/
 /*                         OGR2SQLITE_Column()                          */
 /************************************************************************/
@@ -1451,6 +2238,9 @@ static int OGR2SQLITE_Column(sqlite3_vtab_cursor *pCursor,
 
     OGR2SQLITE_GoToWishedIndex(pMyCursor);
 
+    if (pMyCursor->poArrowReader)
+        return OGR2SQLITE_ArrowColumn(pMyCursor, pContext, nCol);
+
     OGRFeature *poFeature = pMyCursor->poFeature;
     if (poFeature == nullptr)
         return SQLITE_ERROR;
@@ -1603,10 +2393,7 @@ static int OGR2SQLITE_Column(sqlite3_vtab_cursor *pCursor,
             int nYear, nMonth, nDay, nHour, nMinute, nSecond, nTZ;
             poFeature->GetFieldAsDateTime(nCol, &nYear, &nMonth, &nDay, &nHour,
                                           &nMinute, &nSecond, &nTZ);
-            char szBuffer[64];
-            snprintf(szBuffer, sizeof(szBuffer), "%04d-%02d-%02d", nYear,
-                     nMonth, nDay);
-            sqlite3_result_text(pContext, szBuffer, -1, SQLITE_TRANSIENT);
+            OGR2SQLITE_ResultDate(pContext, nYear, nMonth, nDay);
             break;
         }
 
@@ -1621,14 +2408,7 @@ static int OGR2SQLITE_Column(sqlite3_vtab_cursor *pCursor,
             float fSecond = 0.0f;
             poFeature->GetFieldAsDateTime(nCol, &nYear, &nMonth, &nDay, &nHour,
                                           &nMinute, &fSecond, &nTZ);
-            char szBuffer[64];
-            if (OGR_GET_MS(fSecond) != 0)
-                snprintf(szBuffer, sizeof(szBuffer), "%02d:%02d:%06.3f", nHour,
-                         nMinute, fSecond);
-            else
-                snprintf(szBuffer, sizeof(szBuffer), "%02d:%02d:%02d", nHour,
-                         nMinute, (int)fSecond);
-            sqlite3_result_text(pContext, szBuffer, -1, SQLITE_TRANSIENT);
+            OGR2SQLITE_ResultTime(pContext, nHour, nMinute, fSecond);
             break;
         }
 
@@ -1654,6 +2434,14 @@ static int OGR2SQLITE_Rowid(sqlite3_vtab_cursor *pCursor, sqlite3_int64 *pRowid)
 
     OGR2SQLITE_GoToWishedIndex(pMyCursor);
 
+    if (pMyCursor->poArrowReader)
+    {
+        if (pMyCursor->poArrowReader->IsEOF())
+            return SQLITE_ERROR;
+        *pRowid = pMyCursor->poArrowReader->GetFID();
+        return SQLITE_OK;
+    }
+
     if (pMyCursor->poFeature == nullptr)
         return SQLITE_ERROR;
 
@@ -628,6 +628,8 @@ bool SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_insert)(struct sqlite_rtree_bl *tr,
     tr->root = new_root;
     tr->root->count = 2;
     tr->height++;
+    rect_expand(&tr->rect, &rect);
+    tr->count++;
 
     return true;
 }
@@ -645,6 +647,199 @@ void SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_free)(struct sqlite_rtree_bl *tr) {
     }
 }
 
+// Hilbert curve index of (x,y), with x and y in [0, 65535].
+// Cf https://github.com/rawrunprotected/hilbert_curves (public domain)
+static uint32_t hilbert_xy2d(uint32_t x, uint32_t y) {
+    uint32_t a = x ^ y;
+    uint32_t b = 0xFFFF ^ a;
+    uint32_t c = 0xFFFF ^ (x | y);
+    uint32_t d = x & (y ^ 0xFFFF);
+
+    uint32_t A = a | (b >> 1);
+    uint32_t B = (a >> 1) ^ a;
+    uint32_t C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+    uint32_t D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+    a = A; b = B; c = C; d = D;
+    A = ((a & (a >> 2)) ^ (b & (b >> 2)));
+    B = ((a & (b >> 2)) ^ (b & ((a ^ b) >> 2)));
+    C ^= ((a & (c >> 2)) ^ (b & (d >> 2)));
+    D ^= ((b & (c >> 2)) ^ ((a ^ b) & (d >> 2)));
+
+    a = A; b = B; c = C; d = D;
+    A = ((a & (a >> 4)) ^ (b & (b >> 4)));
+    B = ((a & (b >> 4)) ^ (b & ((a ^ b) >> 4)));
+    C ^= ((a & (c >> 4)) ^ (b & (d >> 4)));
+    D ^= ((b & (c >> 4)) ^ ((a ^ b) & (d >> 4)));
+
+    a = A; b = B; c = C; d = D;
+    C ^= ((a & (c >> 8)) ^ (b & (d >> 8)));
+    D ^= ((b & (c >> 8)) ^ ((a ^ b) & (d >> 8)));
+
+    a = C ^ (C >> 1);
+    b = D ^ (D >> 1);
+
+    uint32_t i0 = x ^ y;
+    uint32_t i1 = b | (0xFFFF ^ (i0 | a));
+
+    i0 = (i0 | (i0 << 8)) & 0x00FF00FF;
+    i0 = (i0 | (i0 << 4)) & 0x0F0F0F0F;
+    i0 = (i0 | (i0 << 2)) & 0x33333333;
+    i0 = (i0 | (i0 << 1)) & 0x55555555;
+
+    i1 = (i1 | (i1 << 8)) & 0x00FF00FF;
+    i1 = (i1 | (i1 << 4)) & 0x0F0F0F0F;
+    i1 = (i1 | (i1 << 2)) & 0x33333333;
+    i1 = (i1 | (i1 << 1)) & 0x55555555;
+
+    return (i1 << 1) | i0;
+}
+
+typedef struct packed_entry {
+    uint32_t hilbert;
+    struct rect rect;
+    struct node *node;   // NULL for leaf level entries
+    struct item item;
+} packed_entry;
+
+#ifndef USE_CPLUSPLUS
+static int CompareHilbert(const void *a, const void *b)
+{
+    const packed_entry* ea = STATIC_CAST(const packed_entry*, a);
+    const packed_entry* eb = STATIC_CAST(const packed_entry*, b);
+    if (ea->hilbert < eb->hilbert)
+        return -1;
+    if (ea->hilbert > eb->hilbert)
+        return 1;
+    return (ea->item.data < eb->item.data) ? -1 :
+           (ea->item.data > eb->item.data) ? 1 : 0;
+}
+#endif
+
+static void collect_leaf_entries(const struct node *node,
+                                 packed_entry *entries, size_t *p_count) {
+    if (node->kind == BRANCH) {
+        for (int i = 0; i < node->count; i++) {
+            collect_leaf_entries(node->nodes[i], entries, p_count);
+        }
+    } else {
+        for (int i = 0; i < node->count; i++) {
+            packed_entry *entry = &entries[*p_count];
+            entry->rect = node->rects[i];
+            entry->node = NULL;
+            entry->item = node->datas[i];
+            ++(*p_count);
+        }
+    }
+}
+
+// Groups the count entries into ceil(count / node_capacity) nodes of kind
+// "kind", spreading the entries evenly so that all nodes are nearly full.
+// On success, entries[0:*p_count] are the entries pointing to the new nodes.
+static bool pack_level(struct sqlite_rtree_bl *tr, enum kind kind,
+                       packed_entry *entries, size_t *p_count) {
+    const size_t count = *p_count;
+    const size_t capacity = STATIC_CAST(size_t, tr->node_capacity);
+    const size_t node_count = (count + capacity - 1) / capacity;
+    size_t src = 0;
+    for (size_t i = 0; i < node_count; i++) {
+        const size_t n = count / node_count + (i < count % node_count ? 1 : 0);
+        struct node *node = node_new(tr, kind);
+        if (!node) {
+            // Free the nodes of this level already created, and those of
+            // the entries not yet consumed.
+            for (size_t j = 0; j < i; j++) {
+                node_free(tr, entries[j].node);
+            }
+            for (size_t j = src; j < count; j++) {
+                if (entries[j].node) {
+                    node_free(tr, entries[j].node);
+                }
+            }
+            return false;
+        }
+        for (size_t j = 0; j < n; j++, src++) {
+            node->rects[j] = entries[src].rect;
+            if (kind == LEAF) {
+                node->datas[j] = entries[src].item;
+            } else {
+                node->nodes[j] = entries[src].node;
+            }
+        }
+        node->count = STATIC_CAST(int, n);
+        // src >= i + 1 at that point, so we never overwrite an entry not
+        // yet consumed.
+        entries[i].rect = node_rect_calc(node);
+        entries[i].node = node;
+    }
+    *p_count = node_count;
+    return true;
+}
+
+bool SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_pack)(struct sqlite_rtree_bl *tr) {
+    if (!tr->root || tr->root->kind == LEAF) {
+        return true;
+    }
+
+    packed_entry *entries = STATIC_CAST(packed_entry *,
+        tr->malloc(tr->count * sizeof(packed_entry)));
+    if (!entries) {
+        return false;
+    }
+    size_t count = 0;
+    collect_leaf_entries(tr->root, entries, &count);
+    assert(count == tr->count);
+
+    // Sort entries along a Hilbert curve of the center of their bounding box
+    const double minx = tr->rect.min[0];
+    const double miny = tr->rect.min[1];
+    const double width = STATIC_CAST(double, tr->rect.max[0]) - minx;
+    const double height = STATIC_CAST(double, tr->rect.max[1]) - miny;
+    const double xscale = width > 0 ? 65535.0 / width : 0;
+    const double yscale = height > 0 ? 65535.0 / height : 0;
+    for (size_t i = 0; i < count; i++) {
+        packed_entry *entry = &entries[i];
+        const double cx = (STATIC_CAST(double, entry->rect.min[0]) +
+                           entry->rect.max[0]) / 2;
+        const double cy = (STATIC_CAST(double, entry->rect.min[1]) +
+                           entry->rect.max[1]) / 2;
+        const double x = floor((cx - minx) * xscale);
+        const double y = floor((cy - miny) * yscale);
+        entry->hilbert = hilbert_xy2d(
+            STATIC_CAST(uint32_t, x < 0 ? 0 : x > 65535 ? 65535 : x),
+            STATIC_CAST(uint32_t, y < 0 ? 0 : y > 65535 ? 65535 : y));
+    }
+#ifndef USE_CPLUSPLUS
+    qsort(entries, count, sizeof(packed_entry), CompareHilbert);
+#else
+    std::sort(entries, entries + count, [](const packed_entry& a, const packed_entry& b) {
+        return a.hilbert < b.hilbert ||
+               (a.hilbert == b.hilbert && a.item.data < b.item.data);
+    });
+#endif
+
+    // Build the new tree bottom-up, while the old one is still alive, so
+    // that it is left untouched in case of memory allocation failure.
+    const size_t old_mem_usage = tr->mem_usage;
+    int tree_height = 0;
+    enum kind kind = LEAF;
+    do {
+        if (!pack_level(tr, kind, entries, &count)) {
+            tr->free(entries);
+            assert(tr->mem_usage == old_mem_usage);
+            return false;
+        }
+        kind = BRANCH;
+        ++tree_height;
+    } while (count > 1);
+
+    node_free(tr, tr->root);
+    tr->root = entries[0].node;
+    tr->height = tree_height;
+    tr->free(entries);
+    return true;
+}
+
 static void write_be_uint16(uint8_t* dest, uint16_t n) {
     dest[0] = STATIC_CAST(uint8_t, n >> 8);
     dest[1] = STATIC_CAST(uint8_t, n);
@@ -904,8 +1099,7 @@ bool SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_serialize)(
 
 #define NOTIFICATION_INTERVAL (500 * 1000)
 
-bool SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_from_feature_table)(
-                               sqlite3* hDB,
+static bool from_feature_table(sqlite3* hDB,
                                const char* feature_table_name,
                                const char* feature_table_fid_colname,
                                const char* feature_table_geom_colname,
@@ -918,7 +1112,8 @@ bool SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_from_feature_table)(
                                size_t max_ram_usage,
                                char** p_error_msg,
                                sqlite_rtree_progress_callback progress_cbk,
-                               void* progress_cbk_user_data)
+                               void* progress_cbk_user_data,
+                               bool pack)
 {
     char** papszResult = NULL;
     sqlite3_get_table(hDB, "PRAGMA page_size", &papszResult, NULL, NULL, NULL);
@@ -986,6 +1181,14 @@ bool SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_from_feature_table)(
         }
     }
 
+    if (pack && !SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_pack)(t)) {
+        if (progress_cbk) {
+            CPL_IGNORE_RET_VAL_INT(progress_cbk(
+                "Not enough memory to pack the RTree. Using it as is",
+                progress_cbk_user_data));
+        }
+    }
+
     bool bOK = SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_serialize)(
                                t, hDB,
                                rtree_name,
@@ -1063,3 +1266,53 @@ bool SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_from_feature_table)(
     sqlite3_finalize(hStmt);
     return bOK;
 }
+
+bool SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_from_feature_table)(
+                               sqlite3* hDB,
+                               const char* feature_table_name,
+                               const char* feature_table_fid_colname,
+                               const char* feature_table_geom_colname,
+                               const char* rtree_name,
+                               const char* rowid_colname,
+                               const char* minx_colname,
+                               const char* miny_colname,
+                               const char* maxx_colname,
+                               const char* maxy_colname,
+                               size_t max_ram_usage,
+                               char** p_error_msg,
+                               sqlite_rtree_progress_callback progress_cbk,
+                               void* progress_cbk_user_data)
+{
+    return from_feature_table(hDB, feature_table_name,
+                              feature_table_fid_colname,
+                              feature_table_geom_colname, rtree_name,
+                              rowid_colname, minx_colname, miny_colname,
+                              maxx_colname, maxy_colname, max_ram_usage,
+                              p_error_msg, progress_cbk,
+                              progress_cbk_user_data, false);
+}
+
+bool SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_from_feature_table_packed)(
+                               sqlite3* hDB,
+                               const char* feature_table_name,
+                               const char* feature_table_fid_colname,
+                               const char* feature_table_geom_colname,
+                               const char* rtree_name,
+                               const char* rowid_colname,
+                               const char* minx_colname,
+                               const char* miny_colname,
+                               const char* maxx_colname,
+                               const char* maxy_colname,
+                               size_t max_ram_usage,
+                               char** p_error_msg,
+                               sqlite_rtree_progress_callback progress_cbk,
+                               void* progress_cbk_user_data)
+{
+    return from_feature_table(hDB, feature_table_name,
+                              feature_table_fid_colname,
+                              feature_table_geom_colname, rtree_name,
+                              rowid_colname, minx_colname, miny_colname,
+                              maxx_colname, maxy_colname, max_ram_usage,
+                              p_error_msg, progress_cbk,
+                              progress_cbk_user_data, true);
+}
@@ -69,6 +69,18 @@ bool SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_insert)(
                             int64_t fid,
                             double minx, double miny, double maxx, double maxy);
 
+/** Rebuild the RTree as a packed tree.
+ *
+ * Entries are sorted along a Hilbert curve of the center of their bounding
+ * box, and grouped into nearly full nodes. Compared to a tree built by
+ * successive insertions, this results in less overlap between nodes, and
+ * faster spatial queries. Rows may still be inserted afterwards.
+ *
+ * @return true in case of success, false in case of memory allocation failure
+ *         (the RTree is then left unchanged)
+ */
+bool SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_pack)(sqlite_rtree_bl *tr);
+
 /** Serialize the RTree into the database.
  *
  * This method issues a
@@ -164,6 +176,25 @@ bool SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_from_feature_table)(
                                sqlite_rtree_progress_callback progress_cbk,
                                void* progress_cbk_user_data);
 
+/** Same as sqlite_rtree_bl_from_feature_table(), except that the in-memory
+ * RTree is packed with sqlite_rtree_bl_pack() before being serialized.
+ */
+bool SQLITE_RTREE_BL_SYMBOL(sqlite_rtree_bl_from_feature_table_packed)(
+                               sqlite3* hDB,
+                               const char* feature_table_name,
+                               const char* feature_table_fid_colname,
+                               const char* feature_table_geom_colname,
+                               const char* rtree_name,
+                               const char* rowid_colname,
+                               const char* minx_colname,
+                               const char* miny_colname,
+                               const char* maxx_colname,
+                               const char* maxy_colname,
+                               size_t max_ram_usage,
+                               char** p_error_msg,
+                               sqlite_rtree_progress_callback progress_cbk,
+                               void* progress_cbk_user_data);
+
 #ifdef __cplusplus
 }
 #endif
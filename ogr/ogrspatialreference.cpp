@@ -139,6 +139,11 @@ struct OGRSpatialReference::Private
 
     double m_coordinateEpoch = 0;  // as decimal year
 
+    // Identifies the definition (e.g. "EPSG:4326:1:0" or "WKT:...") m_pj_crs
+    // was built from, as long as it has not been modified since. Used to
+    // speed up IsSame().
+    std::string m_osDefinitionKey{};
+
     explicit Private(OGRSpatialReference *poSelf);
     ~Private();
     Private(const Private &) = delete;
@@ -260,6 +265,8 @@ void OGRSpatialReference::Private::clear()
     m_bHasCenterLong = false;
 
     m_coordinateEpoch = 0.0;
+
+    m_osDefinitionKey.clear();
 }
 
 void OGRSpatialReference::Private::setRoot(OGR_SRSNode *poRoot)
@@ -295,6 +302,7 @@ void OGRSpatialReference::Private::setPjCRS(PJ *pj_crsIn,
     proj_assign_context(m_pj_crs, ctxt);
     proj_destroy(m_pj_crs);
     m_pj_crs = pj_crsIn;
+    m_osDefinitionKey.clear();
     if (m_pj_crs)
     {
         m_pjType = proj_get_type(m_pj_crs);
@@ -383,10 +391,13 @@ void OGRSpatialReference::Private::refreshRootFromProjObj()
         }
         if (pszWKT)
         {
+            // Nodes reflect m_pj_crs: this is not a modification
+            const std::string osDefinitionKey = std::move(m_osDefinitionKey);
             auto root = new OGR_SRSNode();
             setRoot(root);
             root->importFromWkt(&pszWKT);
             m_bNodesChanged = false;
+            m_osDefinitionKey = osDefinitionKey;
         }
     }
 }
@@ -522,6 +533,7 @@ void OGRSpatialReference::Private::refreshAxisMapping()
 void OGRSpatialReference::Private::nodesChanged()
 {
     m_bNodesChanged = true;
+    m_osDefinitionKey.clear();
 }
 
 void OGRSpatialReference::Private::invalidateNodes()
@@ -958,6 +970,7 @@ OGRSpatialReference::operator=(const OGRSpatialReference &oSource)
         oSource.d->refreshProjObj();
         if (oSource.d->m_pj_crs)
             d->setPjCRS(proj_clone(d->getPROJContext(), oSource.d->m_pj_crs));
+        d->m_osDefinitionKey = oSource.d->m_osDefinitionKey;
         if (oSource.d->m_axisMappingStrategy == OAMS_TRADITIONAL_GIS_ORDER)
             SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
         else if (oSource.d->m_axisMappingStrategy == OAMS_CUSTOM)
@@ -1385,6 +1398,10 @@ OGRSpatialReference *OGRSpatialReference::Clone() const
     {
         poNewRef->d->setRoot(d->m_poRoot->Clone());
     }
+    else
+    {
+        poNewRef->d->m_osDefinitionKey = d->m_osDefinitionKey;
+    }
     poNewRef->d->m_axisMapping = d->m_axisMapping;
     poNewRef->d->m_axisMappingStrategy = d->m_axisMappingStrategy;
     poNewRef->d->m_coordinateEpoch = d->m_coordinateEpoch;
@@ -2010,6 +2027,10 @@ OGRErr OGRSpatialReference::importFromWkt(const char **ppszInput,
         poRoot->importFromWkt(&pszTmp);
         d->m_bHasCenterLong = true;
     }
+    else if (papszOptions == nullptr && d->m_wktImportErrors.empty())
+    {
+        d->m_osDefinitionKey = "WKT:" + osWkt;
+    }
 
     // TODO? we don't really update correctly since we assume that the
     // passed string is only WKT.
@@ -3756,13 +3777,20 @@ OGRErr OGRSpatialReference::SetFromUserInput(const char *pszDefinition,
             // Use proj_create() as it allows things like EPSG:3157+4617
             // that are not normally supported by the below code that
             // builds manually a compound CRS
-            PJ *pj = proj_create(d->getPROJContext(), pszDefinition);
+            auto tlsCache = OSRGetProjTLSCache();
+            PJ *pj = tlsCache->GetPJForUserInput(pszDefinition);
             if (!pj)
             {
-                return OGRERR_FAILURE;
+                pj = proj_create(d->getPROJContext(), pszDefinition);
+                if (!pj)
+                {
+                    return OGRERR_FAILURE;
+                }
+                tlsCache->CachePJForUserInput(pszDefinition, pj);
             }
             Clear();
             d->setPjCRS(pj);
+            d->m_osDefinitionKey = std::string("INPUT:") + pszDefinition;
             return OGRERR_NONE;
         }
         else
@@ -9361,6 +9389,30 @@ int OGRSpatialReference::IsSame(const OGRSpatialReference *poOtherSRS,
             return false;
     }
 
+    // Objects built from the same definition are identical whatever the
+    // criterion, and the result of comparing two given definitions can be
+    // reused.
+    const bool bHasDefinitionKeys = !d->m_osDefinitionKey.empty() &&
+                                    !poOtherSRS->d->m_osDefinitionKey.empty();
+    if (bHasDefinitionKeys &&
+        d->m_osDefinitionKey == poOtherSRS->d->m_osDefinitionKey)
+    {
+        return true;
+    }
+    std::string osIsSameCacheKey;
+    auto tlsCache = OSRGetProjTLSCache();
+    if (bHasDefinitionKeys)
+    {
+        osIsSameCacheKey = CSLFetchNameValueDef(papszOptions, "CRITERION", "");
+        osIsSameCacheKey += '\n';
+        osIsSameCacheKey += d->m_osDefinitionKey;
+        osIsSameCacheKey += '\n';
+        osIsSameCacheKey += poOtherSRS->d->m_osDefinitionKey;
+        bool bIsSame = false;
+        if (tlsCache->GetIsSameResult(osIsSameCacheKey, bIsSame))
+            return bIsSame;
+    }
+
     bool reboundSelf = false;
     bool reboundOther = false;
     if (d->m_pjType == PJ_TYPE_BOUND_CRS &&
@@ -9396,6 +9448,9 @@ int OGRSpatialReference::IsSame(const OGRSpatialReference *poOtherSRS,
     if (reboundOther)
         poOtherSRS->d->undoDemoteFromBoundCRS();
 
+    if (!osIsSameCacheKey.empty())
+        tlsCache->CacheIsSameResult(osIsSameCacheKey, ret != 0);
+
     return ret;
 }
 
@@ -11328,6 +11383,9 @@ OGRErr OGRSpatialReference::importFromEPSGA(int nCode)
         if (cachedObj)
         {
             d->setPjCRS(cachedObj);
+            d->m_osDefinitionKey =
+                CPLSPrintf("EPSG:%d:%d:%d", nCode, bUseNonDeprecated ? 1 : 0,
+                           bAddTOWGS84 ? 1 : 0);
             return OGRERR_NONE;
         }
     }
@@ -11390,6 +11448,9 @@ OGRErr OGRSpatialReference::importFromEPSGA(int nCode)
     }
 
     d->setPjCRS(obj);
+    d->m_osDefinitionKey = CPLSPrintf("EPSG:%d:%d:%d", nCode,
+                                      bUseNonDeprecated ? 1 : 0,
+                                      bAddTOWGS84 ? 1 : 0);
 
     if (tlsCache)
     {
@@ -32,6 +32,7 @@
 #include "ogr_geometry.h"
 #include "ogr_p.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -43,6 +44,10 @@
 #include <sstream>
 #include <iomanip>
 
+#if defined(__x86_64) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_string.h"
@@ -237,22 +242,48 @@ std::string OGRFormatDouble(double val, const OGRWktOptions &opts)
     if (std::isnan(val))
         return "nan";
 
-    std::ostringstream oss;
-    oss.imbue(std::locale::classic());  // Make sure we output decimal points.
     bool l_round(opts.round);
-    if (opts.format == OGRWktFormat::F ||
-        (opts.format == OGRWktFormat::Default && fabs(val) < 1))
-        oss << std::fixed;
+    const bool bFixed = opts.format == OGRWktFormat::F ||
+                        (opts.format == OGRWktFormat::Default && fabs(val) < 1);
+    if (!bFixed)
+        l_round = false;
+
+    std::string sval;
+    // std::ostream formatting of floating-point values is defined in terms
+    // of printf() conversions, so use CPLsnprintf() directly, which is much
+    // faster, when the result is known to fit in the buffer: at most 309
+    // digits before the decimal point with the %f conversion.
+    if (opts.precision >= 0 && opts.precision <= 100)
+    {
+        char szBuffer[512];
+        int nLen;
+        if (bFixed)
+        {
+            nLen = CPLsnprintf(szBuffer, sizeof(szBuffer), "%.*f",
+                               opts.precision, val);
+        }
+        else
+        {
+            // Uppercase because OGC spec says capital 'E'.
+            char szFormat[16];
+            snprintf(szFormat, sizeof(szFormat), "%%.%dG", opts.precision);
+            nLen = CPLsnprintf(szBuffer, sizeof(szBuffer), szFormat, val);
+        }
+        sval.assign(szBuffer, nLen);
+    }
     else
     {
-        // Uppercase because OGC spec says capital 'E'.
-        oss << std::uppercase;
-        l_round = false;
+        std::ostringstream oss;
+        // Make sure we output decimal points.
+        oss.imbue(std::locale::classic());
+        if (bFixed)
+            oss << std::fixed;
+        else
+            oss << std::uppercase;
+        oss << std::setprecision(opts.precision);
+        oss << val;
+        sval = oss.str();
     }
-    oss << std::setprecision(opts.precision);
-    oss << val;
-
-    std::string sval = oss.str();
 
     if (l_round)
         sval = intelliround(sval);
@@ -2206,6 +2237,106 @@ OGRErr OGRReadWKBGeometryType(const unsigned char *pabyData,
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                        OGRUpdateEnvelopeXY()                         */
+/************************************************************************/
+
+/** Extend sEnvelope with the X and Y values of nPoints coordinate tuples,
+ * in native byte order, starting at pXY and spaced by nStride bytes.
+ *
+ * pXY does not need to be aligned. NaN coordinate values are ignored.
+ */
+void OGRUpdateEnvelopeXY(OGREnvelope &sEnvelope, const void *pXY,
+                         size_t nPoints, size_t nStride)
+{
+    const GByte *pabyXY = static_cast<const GByte *>(pXY);
+#if defined(__x86_64) || defined(_M_X64)
+    // X and Y are processed together in the 2 lanes of a SSE2 register,
+    // with 2 independent accumulators to break the dependency chain.
+    // _mm_min_pd(a, b) / _mm_max_pd(a, b) return b if one of the values is
+    // NaN, hence the order of arguments.
+    __m128d minXY0 = _mm_set_pd(sEnvelope.MinY, sEnvelope.MinX);
+    __m128d maxXY0 = _mm_set_pd(sEnvelope.MaxY, sEnvelope.MaxX);
+    __m128d minXY1 = minXY0;
+    __m128d maxXY1 = maxXY0;
+    size_t i = 0;
+    for (; i + 1 < nPoints; i += 2)
+    {
+        const __m128d xy0 =
+            _mm_loadu_pd(reinterpret_cast<const double *>(pabyXY));
+        const __m128d xy1 =
+            _mm_loadu_pd(reinterpret_cast<const double *>(pabyXY + nStride));
+        pabyXY += 2 * nStride;
+        minXY0 = _mm_min_pd(xy0, minXY0);
+        maxXY0 = _mm_max_pd(xy0, maxXY0);
+        minXY1 = _mm_min_pd(xy1, minXY1);
+        maxXY1 = _mm_max_pd(xy1, maxXY1);
+    }
+    if (i < nPoints)
+    {
+        const __m128d xy0 =
+            _mm_loadu_pd(reinterpret_cast<const double *>(pabyXY));
+        minXY0 = _mm_min_pd(xy0, minXY0);
+        maxXY0 = _mm_max_pd(xy0, maxXY0);
+    }
+    minXY0 = _mm_min_pd(minXY1, minXY0);
+    maxXY0 = _mm_max_pd(maxXY1, maxXY0);
+    double adfMin[2];
+    double adfMax[2];
+    _mm_storeu_pd(adfMin, minXY0);
+    _mm_storeu_pd(adfMax, maxXY0);
+    sEnvelope.MinX = adfMin[0];
+    sEnvelope.MinY = adfMin[1];
+    sEnvelope.MaxX = adfMax[0];
+    sEnvelope.MaxY = adfMax[1];
+#else
+    for (size_t i = 0; i < nPoints; ++i)
+    {
+        double dfX;
+        double dfY;
+        memcpy(&dfX, pabyXY, sizeof(double));
+        memcpy(&dfY, pabyXY + sizeof(double), sizeof(double));
+        pabyXY += nStride;
+        sEnvelope.MinX = std::min(sEnvelope.MinX, dfX);
+        sEnvelope.MinY = std::min(sEnvelope.MinY, dfY);
+        sEnvelope.MaxX = std::max(sEnvelope.MaxX, dfX);
+        sEnvelope.MaxY = std::max(sEnvelope.MaxY, dfY);
+    }
+#endif
+}
+
+/************************************************************************/
+/*                        OGRSwapDoubleArray()                          */
+/************************************************************************/
+
+/** Byte swap in place nCount contiguous 8-byte values, that do not need to
+ * be aligned.
+ */
+void OGRSwapDoubleArray(void *pData, size_t nCount)
+{
+    GByte *pabyData = static_cast<GByte *>(pData);
+    size_t i = 0;
+#if defined(__x86_64) || defined(_M_X64)
+    // SSE2 has no byte shuffle: swap the bytes of each 16-bit word, and then
+    // reverse the order of the 4 words of each 64-bit lane.
+    for (; i + 1 < nCount; i += 2)
+    {
+        __m128i v =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pabyData));
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pabyData), v);
+        pabyData += 2 * sizeof(double);
+    }
+#endif
+    for (; i < nCount; ++i)
+    {
+        CPL_SWAP64PTR(pabyData);
+        pabyData += sizeof(double);
+    }
+}
+
 /************************************************************************/
 /*                      OGRReadWKTGeometryType()                        */
 /************************************************************************/
@@ -267,6 +267,8 @@ int swqlex(YYSTYPE *ppNode, swq_parse_context *context)
             nReturn = SWQT_ON;
         else if (EQUAL(osToken, "ORDER"))
             nReturn = SWQT_ORDER;
+        else if (EQUAL(osToken, "GROUP"))
+            nReturn = SWQT_GROUP;
         else if (EQUAL(osToken, "BY"))
             nReturn = SWQT_BY;
         else if (EQUAL(osToken, "FROM"))
@@ -425,6 +427,37 @@ const char *swq_select_summarize(swq_select *select_info, int dest_column,
     /* -------------------------------------------------------------------- */
     /*      Process various options.                                        */
     /* -------------------------------------------------------------------- */
+    return swq_summary_accumulate(def, summary, value);
+}
+
+/************************************************************************/
+/*                       swq_summary_accumulate()                       */
+/*                                                                      */
+/*      Accumulate a value of a column into a summary, according to     */
+/*      the column function. For COUNT(DISTINCT ...), the distinct      */
+/*      values are only collected in oSetDistinctValues.                */
+/************************************************************************/
+
+const char *swq_summary_accumulate(const swq_col_def *def,
+                                   swq_summary &summary, const char *value)
+
+{
+    if (def->distinct_flag)
+    {
+        if (value == nullptr)
+            value = SZ_OGR_NULL;
+        try
+        {
+            if (summary.oSetDistinctValues.insert(value).second)
+                summary.count++;
+        }
+        catch (std::bad_alloc &)
+        {
+            return "Out of memory";
+        }
+
+        return nullptr;
+    }
 
     switch (def->col_func)
     {
@@ -444,7 +477,7 @@ const char *swq_select_summarize(swq_select *select_info, int dest_column,
                 else
                 {
                     double df_val = CPLAtof(value);
-                    if (df_val < summary.min)
+                    if (summary.count == 0 || df_val < summary.min)
                         summary.min = df_val;
                 }
                 summary.count++;
@@ -466,7 +499,7 @@ const char *swq_select_summarize(swq_select *select_info, int dest_column,
                 else
                 {
                     double df_val = CPLAtof(value);
-                    if (df_val > summary.max)
+                    if (summary.count == 0 || df_val > summary.max)
                         summary.max = df_val;
                 }
                 summary.count++;
@@ -514,10 +547,10 @@ const char *swq_select_summarize(swq_select *select_info, int dest_column,
             break;
 
         case SWQCF_CUSTOM:
-            return "swq_select_summarize() called on custom field function.";
+            return "swq_summary_accumulate() called on custom field function.";
 
         default:
-            return "swq_select_summarize() - unexpected col_func";
+            return "swq_summary_accumulate() - unexpected col_func";
     }
 
     return nullptr;
@@ -936,7 +969,8 @@ CPLErr swq_expr_compile2(const char *where_clause, swq_field_list *field_list,
 static const char *const apszSQLReservedKeywords[] = {
     "OR",    "AND",      "NOT",    "LIKE",   "IS",   "NULL", "IN",    "BETWEEN",
     "CAST",  "DISTINCT", "ESCAPE", "SELECT", "LEFT", "JOIN", "WHERE", "ON",
-    "ORDER", "BY",       "FROM",   "AS",     "ASC",  "DESC", "UNION", "ALL"};
+    "ORDER", "BY",       "FROM",   "AS",     "ASC",  "DESC", "UNION", "ALL",
+    "GROUP"};
 
 int swq_is_reserved_keyword(const char *pszStr)
 {
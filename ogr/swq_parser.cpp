@@ -182,51 +182,55 @@ enum yysymbol_kind_t
     YYSYMBOL_SWQT_OFFSET = 30,            /* "OFFSET"  */
     YYSYMBOL_SWQT_EXCEPT = 31,            /* "EXCEPT"  */
     YYSYMBOL_SWQT_EXCLUDE = 32,           /* "EXCLUDE"  */
-    YYSYMBOL_SWQT_VALUE_START = 33,       /* SWQT_VALUE_START  */
-    YYSYMBOL_SWQT_SELECT_START = 34,      /* SWQT_SELECT_START  */
-    YYSYMBOL_SWQT_NOT = 35,               /* "NOT"  */
-    YYSYMBOL_SWQT_OR = 36,                /* "OR"  */
-    YYSYMBOL_SWQT_AND = 37,               /* "AND"  */
-    YYSYMBOL_38_ = 38,                    /* '='  */
-    YYSYMBOL_39_ = 39,                    /* '<'  */
-    YYSYMBOL_40_ = 40,                    /* '>'  */
-    YYSYMBOL_41_ = 41,                    /* '!'  */
-    YYSYMBOL_42_ = 42,                    /* '+'  */
-    YYSYMBOL_43_ = 43,                    /* '-'  */
-    YYSYMBOL_44_ = 44,                    /* '*'  */
-    YYSYMBOL_45_ = 45,                    /* '/'  */
-    YYSYMBOL_46_ = 46,                    /* '%'  */
-    YYSYMBOL_SWQT_UMINUS = 47,            /* SWQT_UMINUS  */
-    YYSYMBOL_SWQT_RESERVED_KEYWORD = 48,  /* "reserved keyword"  */
-    YYSYMBOL_49_ = 49,                    /* '('  */
-    YYSYMBOL_50_ = 50,                    /* ')'  */
-    YYSYMBOL_51_ = 51,                    /* ','  */
-    YYSYMBOL_52_ = 52,                    /* '.'  */
-    YYSYMBOL_YYACCEPT = 53,               /* $accept  */
-    YYSYMBOL_input = 54,                  /* input  */
-    YYSYMBOL_value_expr = 55,             /* value_expr  */
-    YYSYMBOL_value_expr_list = 56,        /* value_expr_list  */
-    YYSYMBOL_field_value = 57,            /* field_value  */
-    YYSYMBOL_value_expr_non_logical = 58, /* value_expr_non_logical  */
-    YYSYMBOL_type_def = 59,               /* type_def  */
-    YYSYMBOL_select_statement = 60,       /* select_statement  */
-    YYSYMBOL_select_core = 61,            /* select_core  */
-    YYSYMBOL_opt_union_all = 62,          /* opt_union_all  */
-    YYSYMBOL_union_all = 63,              /* union_all  */
-    YYSYMBOL_select_field_list = 64,      /* select_field_list  */
-    YYSYMBOL_exclude_field = 65,          /* exclude_field  */
-    YYSYMBOL_exclude_field_list = 66,     /* exclude_field_list  */
-    YYSYMBOL_except_or_exclude = 67,      /* except_or_exclude  */
-    YYSYMBOL_column_spec = 68,            /* column_spec  */
-    YYSYMBOL_as_clause = 69,              /* as_clause  */
-    YYSYMBOL_opt_where = 70,              /* opt_where  */
-    YYSYMBOL_opt_joins = 71,              /* opt_joins  */
-    YYSYMBOL_opt_order_by = 72,           /* opt_order_by  */
-    YYSYMBOL_sort_spec_list = 73,         /* sort_spec_list  */
-    YYSYMBOL_sort_spec = 74,              /* sort_spec  */
-    YYSYMBOL_opt_limit = 75,              /* opt_limit  */
-    YYSYMBOL_opt_offset = 76,             /* opt_offset  */
-    YYSYMBOL_table_def = 77               /* table_def  */
+    YYSYMBOL_SWQT_GROUP = 33,             /* "GROUP"  */
+    YYSYMBOL_SWQT_VALUE_START = 34,       /* SWQT_VALUE_START  */
+    YYSYMBOL_SWQT_SELECT_START = 35,      /* SWQT_SELECT_START  */
+    YYSYMBOL_SWQT_NOT = 36,               /* "NOT"  */
+    YYSYMBOL_SWQT_OR = 37,                /* "OR"  */
+    YYSYMBOL_SWQT_AND = 38,               /* "AND"  */
+    YYSYMBOL_39_ = 39,                    /* '='  */
+    YYSYMBOL_40_ = 40,                    /* '<'  */
+    YYSYMBOL_41_ = 41,                    /* '>'  */
+    YYSYMBOL_42_ = 42,                    /* '!'  */
+    YYSYMBOL_43_ = 43,                    /* '+'  */
+    YYSYMBOL_44_ = 44,                    /* '-'  */
+    YYSYMBOL_45_ = 45,                    /* '*'  */
+    YYSYMBOL_46_ = 46,                    /* '/'  */
+    YYSYMBOL_47_ = 47,                    /* '%'  */
+    YYSYMBOL_SWQT_UMINUS = 48,            /* SWQT_UMINUS  */
+    YYSYMBOL_SWQT_RESERVED_KEYWORD = 49,  /* "reserved keyword"  */
+    YYSYMBOL_50_ = 50,                    /* '('  */
+    YYSYMBOL_51_ = 51,                    /* ')'  */
+    YYSYMBOL_52_ = 52,                    /* ','  */
+    YYSYMBOL_53_ = 53,                    /* '.'  */
+    YYSYMBOL_YYACCEPT = 54,               /* $accept  */
+    YYSYMBOL_input = 55,                  /* input  */
+    YYSYMBOL_value_expr = 56,             /* value_expr  */
+    YYSYMBOL_value_expr_list = 57,        /* value_expr_list  */
+    YYSYMBOL_field_value = 58,            /* field_value  */
+    YYSYMBOL_value_expr_non_logical = 59, /* value_expr_non_logical  */
+    YYSYMBOL_type_def = 60,               /* type_def  */
+    YYSYMBOL_select_statement = 61,       /* select_statement  */
+    YYSYMBOL_select_core = 62,            /* select_core  */
+    YYSYMBOL_opt_union_all = 63,          /* opt_union_all  */
+    YYSYMBOL_union_all = 64,              /* union_all  */
+    YYSYMBOL_select_field_list = 65,      /* select_field_list  */
+    YYSYMBOL_exclude_field = 66,          /* exclude_field  */
+    YYSYMBOL_exclude_field_list = 67,     /* exclude_field_list  */
+    YYSYMBOL_except_or_exclude = 68,      /* except_or_exclude  */
+    YYSYMBOL_column_spec = 69,            /* column_spec  */
+    YYSYMBOL_as_clause = 70,              /* as_clause  */
+    YYSYMBOL_opt_where = 71,              /* opt_where  */
+    YYSYMBOL_opt_joins = 72,              /* opt_joins  */
+    YYSYMBOL_opt_group_by = 73,           /* opt_group_by  */
+    YYSYMBOL_group_by_list = 74,          /* group_by_list  */
+    YYSYMBOL_group_by_spec = 75,          /* group_by_spec  */
+    YYSYMBOL_opt_order_by = 76,           /* opt_order_by  */
+    YYSYMBOL_sort_spec_list = 77,         /* sort_spec_list  */
+    YYSYMBOL_sort_spec = 78,              /* sort_spec  */
+    YYSYMBOL_opt_limit = 79,              /* opt_limit  */
+    YYSYMBOL_opt_offset = 80,             /* opt_offset  */
+    YYSYMBOL_table_def = 81               /* table_def  */
 };
 typedef enum yysymbol_kind_t yysymbol_kind_t;
 
@@ -546,19 +550,19 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL 20
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST 409
+#define YYLAST 416
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS 53
+#define YYNTOKENS 54
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS 25
+#define YYNNTS 28
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES 101
+#define YYNRULES 106
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES 211
+#define YYNSTATES 220
 
 /* YYMAXUTOK -- Last valid token kind.  */
-#define YYMAXUTOK 294
+#define YYMAXUTOK 295
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex, with out-of-bounds checking.  */
@@ -571,9 +575,9 @@ union yyalloc
    as returned by yylex.  */
 static const yytype_int8 yytranslate[] = {
     0,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
-    2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  41, 2,  2,  2,  46,
-    2,  2,  49, 50, 44, 42, 51, 43, 52, 45, 2,  2,  2,  2,  2,  2,  2,  2,  2,
-    2,  2,  2,  39, 38, 40, 2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
+    2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  42, 2,  2,  2,  47,
+    2,  2,  50, 51, 45, 43, 52, 44, 53, 46, 2,  2,  2,  2,  2,  2,  2,  2,  2,
+    2,  2,  2,  40, 39, 41, 2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
     2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
     2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
     2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
@@ -585,18 +589,19 @@ static const yytype_int8 yytranslate[] = {
     2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
     2,  2,  2,  2,  2,  2,  2,  2,  2,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10,
     11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29,
-    30, 31, 32, 33, 34, 35, 36, 37, 47, 48};
+    30, 31, 32, 33, 34, 35, 36, 37, 38, 48, 49};
 
 #if YYDEBUG
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] = {
-    0,   124, 124, 125, 131, 138, 143, 148, 153, 160, 168, 176, 184, 192, 200,
-    208, 216, 224, 232, 240, 252, 261, 274, 282, 294, 303, 316, 325, 338, 347,
-    360, 367, 379, 385, 392, 400, 413, 418, 423, 427, 432, 437, 442, 477, 484,
-    491, 498, 505, 512, 548, 556, 562, 569, 578, 596, 616, 617, 620, 625, 631,
-    632, 634, 642, 643, 646, 656, 657, 660, 661, 664, 673, 684, 699, 714, 735,
-    766, 801, 826, 855, 861, 863, 864, 869, 870, 876, 883, 884, 887, 888, 891,
-    897, 903, 910, 911, 918, 919, 927, 937, 948, 959, 972, 983};
+    0,   125, 125, 126, 132, 139, 144, 149, 154, 161, 169, 177, 185, 193,
+    201, 209, 217, 225, 233, 241, 253, 262, 275, 283, 295, 304, 317, 326,
+    339, 348, 361, 368, 380, 386, 393, 401, 414, 419, 424, 428, 433, 438,
+    443, 478, 485, 492, 499, 506, 513, 549, 557, 563, 570, 579, 597, 617,
+    618, 621, 626, 632, 633, 635, 643, 644, 647, 657, 658, 661, 662, 665,
+    674, 685, 700, 715, 736, 767, 802, 827, 856, 862, 864, 865, 870, 871,
+    877, 884, 885, 888, 889, 892, 899, 900, 903, 904, 907, 913, 919, 926,
+    927, 934, 935, 943, 953, 964, 975, 988, 999};
 #endif
 
 /** Accessing symbol of state STATE.  */
@@ -638,6 +643,7 @@ static const char *const yytname[] = {"\"end of string\"",
                                       "\"OFFSET\"",
                                       "\"EXCEPT\"",
                                       "\"EXCLUDE\"",
+                                      "\"GROUP\"",
                                       "SWQT_VALUE_START",
                                       "SWQT_SELECT_START",
                                       "\"NOT\"",
@@ -677,6 +683,9 @@ static const char *const yytname[] = {"\"end of string\"",
                                       "as_clause",
                                       "opt_where",
                                       "opt_joins",
+                                      "opt_group_by",
+                                      "group_by_list",
+                                      "group_by_spec",
                                       "opt_order_by",
                                       "sort_spec_list",
                                       "sort_spec",
@@ -697,145 +706,148 @@ static const char *const yytname[] = {"\"end of string\"",
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
 static const yytype_int16 yypact[] = {
-    34,   206,  -10,  16,   -137, -137, -137, -35,  -137, -37,  206,  211,
-    206,  326,  -137, 298,  79,   11,   -137, 4,    -137, 206,  23,   206,
-    368,  -137, 254,  -11,  206,  206,  211,  -5,   12,   206,  206,  94,
-    104,  155,  5,    211,  211,  211,  211,  211,  8,    196,  93,   274,
-    48,   26,   30,   65,   -137, -10,  235,  45,   -137, 310,  -137, 206,
-    91,   101,  44,   -137, 103,  68,   206,  206,  211,  345,  361,  206,
-    206,  -137, 206,  206,  -137, 206,  -137, 206,  18,   18,   -137, -137,
-    -137, 145,  -3,   100,  -137, -137, 89,   -137, 140,  -137, 121,  196,
-    4,    -137, -137, 206,  -137, 146,  114,  206,  206,  211,  -137, 206,
-    144,  158,  182,  -137, -137, -137, -137, -137, -137, 159,  119,  -137,
-    121,  159,  -137, 120,  2,    116,  -137, -137, -137, 124,  125,  -137,
-    -137, -137, 298,  127,  206,  206,  211,  122,  128,  20,   116,  -137,
-    131,  129,  177,  178,  -137, 170,  121,  174,  53,   -137, -137, -137,
-    -137, 298,  20,   -137, 174,  159,  -137, 20,   20,   121,  169,  206,
-    173,  90,   105,  -137, 173,  -137, -137, -137, 179,  206,  326,  175,
-    167,  -137, 200,  -137, 202,  167,  206,  290,  159,  203,  183,  157,
-    171,  183,  290,  -137, 139,  -137, 184,  -137, 217,  -137, -137, -137,
-    -137, -137, -137, -137, 159,  -137, -137};
+    -4,   198,  6,    4,    -137, -137, -137, -34,  -137, -42,  198,  211,
+    198,  343,  -137, 95,   81,   -2,   -137, -10,  -137, 198,  33,   198,
+    364,  -137, 245,  -7,   198,  198,  211,  2,    102,  198,  198,  93,
+    118,  169,  18,   211,  211,  211,  211,  211,  -29,  194,  28,   286,
+    48,   25,   40,   67,   -137, 6,    238,  41,   -137, 307,  -137, 198,
+    90,   94,   219,  -137, 96,   66,   198,  198,  211,  350,  357,  198,
+    198,  -137, 198,  198,  -137, 198,  -137, 198,  17,   17,   -137, -137,
+    -137, 144,  -3,   97,   -137, -137, 70,   -137, 121,  -137, 62,   194,
+    -10,  -137, -137, 198,  -137, 122,  100,  198,  198,  211,  -137, 198,
+    136,  142,  369,  -137, -137, -137, -137, -137, -137, 126,  104,  -137,
+    62,   126,  -137, 105,  1,    64,   -137, -137, -137, 103,  109,  -137,
+    -137, -137, 95,   110,  198,  198,  211,  111,  112,  19,   64,   -137,
+    113,  116,  165,  171,  -137, 162,  62,   166,  23,   -137, -137, -137,
+    -137, 95,   19,   -137, 166,  126,  -137, 19,   19,   62,   161,  198,
+    149,  30,   37,   -137, 149,  -137, -137, -137, 168,  198,  343,  164,
+    172,  -137, 184,  -137, 187,  172,  198,  294,  126,  173,  167,  156,
+    160,  167,  294,  -137, -137, -137, 170,  126,  209,  188,  -137, -137,
+    188,  -137, 126,  91,   -137, 175,  -137, 218,  -137, -137, -137, -137,
+    -137, 126,  -137, -137};
 
 /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
    Performed when YYTABLE does not specify something else to do.  Zero
    means the default is an error.  */
 static const yytype_int8 yydefact[] = {
-    2,  0,  0,   0,  36, 37, 38, 34, 41, 0,  0,  0,  0,  3,   39, 5,  0,  0,
-    4,  59, 1,   0,  0,  0,  8,  42, 0,  0,  0,  0,  0,  0,   0,  0,  0,  0,
-    0,  0,  0,   0,  0,  0,  0,  0,  34, 0,  72, 69, 0,  62,  0,  0,  55, 0,
-    33, 0,  35,  0,  40, 0,  18, 22, 0,  30, 0,  0,  0,  0,   0,  7,  6,  0,
-    0,  9,  0,   0,  12, 0,  13, 0,  43, 44, 45, 46, 47, 0,   0,  0,  67, 68,
-    0,  79, 0,   70, 0,  0,  59, 61, 60, 0,  48, 0,  0,  0,   0,  0,  31, 0,
-    19, 23, 0,   15, 16, 14, 10, 17, 11, 0,  0,  73, 0,  0,   78, 0,  96, 82,
-    63, 56, 32,  50, 0,  26, 20, 24, 28, 0,  0,  0,  0,  34,  0,  74, 82, 64,
-    65, 0,  0,   0,  97, 0,  0,  80, 0,  49, 27, 21, 25, 29,  76, 75, 80, 0,
-    71, 98, 100, 0,  0,  0,  85, 0,  0,  77, 85, 66, 99, 101, 0,  0,  81, 0,
-    92, 51, 0,   53, 0,  92, 0,  82, 0,  0,  94, 0,  0,  94,  82, 83, 89, 86,
-    88, 93, 0,   57, 52, 54, 58, 84, 90, 91, 0,  95, 87};
+    2,  0,  0,  0,  36,  37,  38, 34, 41, 0,  0,   0,   0,   3,  39,  5,  0,
+    0,  4,  59, 1,  0,   0,   0,  8,  42, 0,  0,   0,   0,   0,  0,   0,  0,
+    0,  0,  0,  0,  0,   0,   0,  0,  0,  0,  34,  0,   72,  69, 0,   62, 0,
+    0,  55, 0,  33, 0,   35,  0,  40, 0,  18, 22,  0,   30,  0,  0,   0,  0,
+    0,  7,  6,  0,  0,   9,   0,  0,  12, 0,  13,  0,   43,  44, 45,  46, 47,
+    0,  0,  0,  67, 68,  0,   79, 0,  70, 0,  0,   59,  61,  60, 0,   48, 0,
+    0,  0,  0,  0,  31,  0,   19, 23, 0,  15, 16,  14,  10,  17, 11,  0,  0,
+    73, 0,  0,  78, 0,   101, 82, 63, 56, 32, 50,  0,   26,  20, 24,  28, 0,
+    0,  0,  0,  34, 0,   74,  82, 64, 65, 0,  0,   0,   102, 0,  0,   80, 0,
+    49, 27, 21, 25, 29,  76,  75, 80, 0,  71, 103, 105, 0,   0,  0,   85, 0,
+    0,  77, 85, 66, 104, 106, 0,  0,  81, 0,  90,  51,  0,   53, 0,   90, 0,
+    82, 0,  0,  97, 0,   0,   97, 82, 83, 89, 86,  88,  0,   0,  99,  52, 54,
+    99, 84, 0,  94, 91,  93,  98, 0,  57, 58, 87,  95,  96,  0,  100, 92};
 
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] = {
-    -137, -137, -1,   -46, -116, 7,    -137, 176, 213,  137, -137, -43, -137,
-    73,   -137, -137, -45, 76,   -136, 66,   39,  -137, 67,  57,   -110};
+    -137, -137, -1, -46, -116, 7,  -137, 176,  208, 132, -137, -43, -137, 72,
+    -137, -137, 68, 75,  -136, 69, 34,   -137, 51,  26,  -137, 57,  55,   -110};
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_uint8 yydefgoto[] = {
-    0,   3,  54, 55, 14,  15,  130, 18,  19,  52,  53,  48, 144,
-    145, 90, 49, 93, 168, 151, 180, 197, 198, 190, 201, 125};
+    0,  3,  54, 55,  14,  15,  130, 18,  19,  52,  53,  48,  144, 145,
+    90, 49, 93, 168, 151, 180, 197, 198, 190, 208, 209, 201, 212, 125};
 
 /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
    positive, shift that token.  If negative, reduce the rule whose
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_uint8 yytable[] = {
-    13,  140, 87,  56,  16,  143, 160, 63,  91,  24,  142, 26,  23,  102, 21,
-    47,  20,  22,  25,  65,  66,  67,  57,  68,  92,  16,  91,  60,  61,  56,
-    64,  51,  69,  70,  73,  76,  78,  62,  59,  17,  166, 119, 92,  79,  47,
-    143, 80,  81,  82,  83,  84,  195, 126, 128, 147, 176, 169, 85,  205, 170,
-    86,  135, 41,  42,  43,  108, 109, 1,   2,   94,  111, 112, 196, 113, 114,
-    110, 115, 95,  116, 148, 96,  105, 4,   5,   6,   44,  39,  40,  41,  42,
-    43,  8,   196, 97,  47,  100, 159, 4,   5,   6,   7,   103, 132, 133, 45,
-    9,   8,   4,   5,   6,   7,   104, 134, 171, 10,  106, 8,   107, 174, 175,
-    9,   120, 11,  46,  88,  89,  123, 124, 12,  10,  9,   149, 150, 71,  72,
-    155, 156, 11,  121, 10,  181, 182, 74,  12,  75,  157, 122, 11,  4,   5,
-    6,   7,   129, 12,  136, 183, 184, 8,   4,   5,   6,   7,   206, 207, 131,
-    139, 178, 8,   137, 141, 117, 9,   146, 152, 22,  153, 187, 154, 158, 162,
-    10,  9,   161, 163, 164, 194, 165, 177, 11,  118, 10,  167, 179, 77,  12,
-    188, 189, 186, 11,  4,   5,   6,   44,  191, 12,  192, 199, 202, 8,   4,
-    5,   6,   7,   200, 4,   5,   6,   7,   8,   138, 209, 203, 9,   8,   39,
-    40,  41,  42,  43,  98,  50,  10,  9,   127, 173, 208, 172, 9,   185, 11,
-    46,  10,  27,  28,  29,  12,  30,  210, 31,  11,  204, 0,   193, 0,   11,
-    12,  0,   0,   0,   0,   12,  27,  28,  29,  0,   30,  0,   31,  0,   0,
-    32,  33,  34,  35,  36,  37,  38,  0,   0,   0,   91,  27,  28,  29,  0,
-    30,  99,  31,  0,   32,  33,  34,  35,  36,  37,  38,  92,  27,  28,  29,
-    0,   30,  0,   31,  58,  149, 150, 0,   0,   32,  33,  34,  35,  36,  37,
-    38,  0,   27,  28,  29,  0,   30,  0,   31,  0,   32,  33,  34,  35,  36,
-    37,  38,  101, 27,  28,  29,  0,   30,  0,   31,  39,  40,  41,  42,  43,
-    32,  33,  34,  35,  36,  37,  38,  27,  28,  29,  0,   30,  0,   31,  0,
-    0,   32,  33,  34,  35,  36,  37,  38,  27,  28,  29,  0,   30,  0,   31,
-    27,  28,  29,  0,   30,  32,  31,  34,  35,  36,  37,  38,  0,   0,   0,
-    0,   0,   0,   0,   0,   0,   32,  0,   0,   35,  36,  37,  38,  0,   0,
-    0,   35,  36,  37,  38};
+    13,  140, 87,  56,  20,  143, 160, 91,  23,  24,  142, 26,  16,  102, 63,
+    47,  21,  51,  25,  22,  16,  85,  57,  92,  86,  91,  169, 60,  61,  170,
+    1,   2,   69,  70,  73,  76,  78,  62,  64,  56,  166, 92,  119, 59,  47,
+    143, 80,  81,  82,  83,  84,  195, 126, 128, 147, 176, 17,  79,  205, 88,
+    89,  135, 41,  42,  43,  108, 109, 123, 124, 94,  111, 112, 196, 113, 114,
+    110, 115, 95,  116, 149, 150, 181, 182, 207, 4,   5,   6,   44,  183, 184,
+    196, 96,  100, 8,   47,  97,  4,   5,   6,   7,   103, 207, 132, 133, 104,
+    8,   45,  9,   106, 65,  66,  67,  134, 68,  215, 216, 107, 10,  120, 9,
+    121, 4,   5,   6,   7,   11,  46,  122, 129, 10,  8,   12,  139, 71,  72,
+    155, 156, 11,  39,  40,  41,  42,  43,  12,  9,   157, 136, 4,   5,   6,
+    7,   131, 137, 152, 10,  141, 8,   74,  146, 75,  153, 154, 11,  158, 22,
+    161, 178, 162, 12,  117, 9,   163, 4,   5,   6,   7,   187, 164, 165, 177,
+    10,  8,   179, 167, 188, 194, 186, 191, 11,  118, 192, 189, 148, 199, 12,
+    9,   200, 4,   5,   6,   44,  4,   5,   6,   7,   10,  8,   202, 77,  159,
+    8,   203, 210, 11,  4,   5,   6,   7,   211, 12,  9,   218, 206, 8,   9,
+    50,  171, 217, 127, 98,  10,  174, 175, 173, 10,  172, 193, 9,   11,  46,
+    214, 185, 11,  219, 12,  27,  28,  29,  12,  30,  204, 31,  27,  28,  29,
+    11,  30,  105, 31,  213, 0,   12,  39,  40,  41,  42,  43,  0,   0,   0,
+    0,   0,   0,   0,   32,  33,  34,  35,  36,  37,  38,  32,  33,  34,  35,
+    36,  37,  38,  0,   0,   99,  0,   91,  27,  28,  29,  58,  30,  0,   31,
+    0,   27,  28,  29,  0,   30,  0,   31,  92,  149, 150, 0,   0,   0,   27,
+    28,  29,  0,   30,  0,   31,  0,   32,  33,  34,  35,  36,  37,  38,  101,
+    32,  33,  34,  35,  36,  37,  38,  0,   0,   0,   0,   0,   0,   32,  33,
+    34,  35,  36,  37,  38,  27,  28,  29,  0,   30,  0,   31,  27,  28,  29,
+    0,   30,  0,   31,  27,  28,  29,  0,   30,  0,   31,  27,  28,  29,  0,
+    30,  0,   31,  0,   32,  33,  34,  35,  36,  37,  38,  32,  0,   34,  35,
+    36,  37,  38,  32,  0,   0,   35,  36,  37,  38,  0,   0,   0,   35,  36,
+    37,  38,  138, 0,   0,   0,   0,   39,  40,  41,  42,  43};
 
 static const yytype_int16 yycheck[] = {
-    1,   117, 45, 6,   14, 121, 142, 12,  6,   10,  120, 12, 49,  59,  49,  16,
-    0,   52,  11, 7,   8,  9,   23,  11,  22,  14,  6,   28, 29,  6,   35,  27,
-    33,  34,  35, 36,  37, 30,  49,  49,  150, 44,  22,  38, 45,  161, 39,  40,
-    41,  42,  43, 187, 95, 99,  52,  165, 3,   49,  194, 6,  52,  107, 44,  45,
-    46,  66,  67, 33,  34, 21,  71,  72,  188, 74,  75,  68, 77,  51,  79,  124,
-    50,  37,  3,  4,   5,  6,   42,  43,  44,  45,  46,  12, 208, 28,  95,  50,
-    141, 3,   4,  5,   6,  10,  103, 104, 25,  26,  12,  3,  4,   5,   6,   10,
-    105, 158, 35, 12,  12, 49,  163, 164, 26,  21,  43,  44, 31,  32,  5,   6,
-    49,  35,  26, 15,  16, 39,  40,  136, 137, 43,  49,  35, 50,  51,  38,  49,
-    40,  138, 6,  43,  3,  4,   5,   6,   6,   49,  10,  50, 51,  12,  3,   4,
-    5,   6,   23, 24,  50, 6,   167, 12,  10,  50,  25,  26, 52,  49,  52,  50,
-    177, 50,  50, 50,  35, 26,  51,  6,   6,   186, 16,  18, 43,  44,  35,  17,
-    19,  38,  49, 20,  29, 18,  43,  3,   4,   5,   6,   3,  49,  3,   3,   50,
-    12,  3,   4,  5,   6,  30,  3,   4,   5,   6,   12,  37, 3,   50,  26,  12,
-    42,  43,  44, 45,  46, 53,  17,  35,  26,  96,  161, 51, 160, 26,  172, 43,
-    44,  35,  7,  8,   9,  49,  11,  208, 13,  43,  193, -1, 185, -1,  43,  49,
-    -1,  -1,  -1, -1,  49, 7,   8,   9,   -1,  11,  -1,  13, -1,  -1,  35,  36,
-    37,  38,  39, 40,  41, -1,  -1,  -1,  6,   7,   8,   9,  -1,  11,  51,  13,
-    -1,  35,  36, 37,  38, 39,  40,  41,  22,  7,   8,   9,  -1,  11,  -1,  13,
-    50,  15,  16, -1,  -1, 35,  36,  37,  38,  39,  40,  41, -1,  7,   8,   9,
-    -1,  11,  -1, 13,  -1, 35,  36,  37,  38,  39,  40,  41, 22,  7,   8,   9,
-    -1,  11,  -1, 13,  42, 43,  44,  45,  46,  35,  36,  37, 38,  39,  40,  41,
-    7,   8,   9,  -1,  11, -1,  13,  -1,  -1,  35,  36,  37, 38,  39,  40,  41,
-    7,   8,   9,  -1,  11, -1,  13,  7,   8,   9,   -1,  11, 35,  13,  37,  38,
-    39,  40,  41, -1,  -1, -1,  -1,  -1,  -1,  -1,  -1,  -1, 35,  -1,  -1,  38,
-    39,  40,  41, -1,  -1, -1,  38,  39,  40,  41};
+    1,   117, 45,  6,   0,  121, 142, 6,   50,  10,  120, 12,  14,  59,  12, 16,
+    50,  27,  11,  53,  14, 50,  23,  22,  53,  6,   3,   28,  29,  6,   34, 35,
+    33,  34,  35,  36,  37, 30,  36,  6,   150, 22,  45,  50,  45,  161, 39, 40,
+    41,  42,  43,  187, 95, 99,  53,  165, 50,  39,  194, 31,  32,  107, 45, 46,
+    47,  66,  67,  5,   6,  21,  71,  72,  188, 74,  75,  68,  77,  52,  79, 15,
+    16,  51,  52,  199, 3,  4,   5,   6,   51,  52,  206, 51,  51,  12,  95, 28,
+    3,   4,   5,   6,   10, 217, 103, 104, 10,  12,  25,  26,  12,  7,   8,  9,
+    105, 11,  23,  24,  50, 36,  21,  26,  50,  3,   4,   5,   6,   44,  45, 6,
+    6,   36,  12,  50,  6,  40,  41,  136, 137, 44,  43,  44,  45,  46,  47, 50,
+    26,  138, 10,  3,   4,  5,   6,   51,  10,  50,  36,  51,  12,  39,  53, 41,
+    51,  51,  44,  51,  53, 52,  167, 51,  50,  25,  26,  6,   3,   4,   5,  6,
+    177, 6,   16,  18,  36, 12,  33,  17,  20,  186, 18,  3,   44,  45,  3,  19,
+    124, 20,  50,  26,  29, 3,   4,   5,   6,   3,   4,   5,   6,   36,  12, 51,
+    39,  141, 12,  51,  3,  44,  3,   4,   5,   6,   30,  50,  26,  3,   52, 12,
+    26,  17,  158, 52,  96, 53,  36,  163, 164, 161, 36,  160, 185, 26,  44, 45,
+    206, 172, 44,  217, 50, 7,   8,   9,   50,  11,  193, 13,  7,   8,   9,  44,
+    11,  38,  13,  204, -1, 50,  43,  44,  45,  46,  47,  -1,  -1,  -1,  -1, -1,
+    -1,  -1,  36,  37,  38, 39,  40,  41,  42,  36,  37,  38,  39,  40,  41, 42,
+    -1,  -1,  52,  -1,  6,  7,   8,   9,   51,  11,  -1,  13,  -1,  7,   8,  9,
+    -1,  11,  -1,  13,  22, 15,  16,  -1,  -1,  -1,  7,   8,   9,   -1,  11, -1,
+    13,  -1,  36,  37,  38, 39,  40,  41,  42,  22,  36,  37,  38,  39,  40, 41,
+    42,  -1,  -1,  -1,  -1, -1,  -1,  36,  37,  38,  39,  40,  41,  42,  7,  8,
+    9,   -1,  11,  -1,  13, 7,   8,   9,   -1,  11,  -1,  13,  7,   8,   9,  -1,
+    11,  -1,  13,  7,   8,  9,   -1,  11,  -1,  13,  -1,  36,  37,  38,  39, 40,
+    41,  42,  36,  -1,  38, 39,  40,  41,  42,  36,  -1,  -1,  39,  40,  41, 42,
+    -1,  -1,  -1,  39,  40, 41,  42,  38,  -1,  -1,  -1,  -1,  43,  44,  45, 46,
+    47};
 
 /* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
    state STATE-NUM.  */
 static const yytype_int8 yystos[] = {
-    0,  33, 34, 54, 3,  4,  5,  6,  12, 26, 35, 43, 49, 55, 57, 58, 14, 49,
-    60, 61, 0,  49, 52, 49, 55, 58, 55, 7,  8,  9,  11, 13, 35, 36, 37, 38,
-    39, 40, 41, 42, 43, 44, 45, 46, 6,  25, 44, 55, 64, 68, 61, 27, 62, 63,
-    55, 56, 6,  55, 50, 49, 55, 55, 58, 12, 35, 7,  8,  9,  11, 55, 55, 39,
-    40, 55, 38, 40, 55, 38, 55, 38, 58, 58, 58, 58, 58, 49, 52, 64, 31, 32,
-    67, 6,  22, 69, 21, 51, 50, 28, 60, 51, 50, 22, 56, 10, 10, 37, 12, 49,
-    55, 55, 58, 55, 55, 55, 55, 55, 55, 25, 44, 44, 21, 49, 6,  5,  6,  77,
-    64, 62, 56, 6,  59, 50, 55, 55, 58, 56, 10, 10, 37, 6,  57, 50, 77, 57,
-    65, 66, 52, 52, 69, 15, 16, 71, 49, 50, 50, 55, 55, 58, 50, 69, 71, 51,
-    50, 6,  6,  16, 77, 17, 70, 3,  6,  69, 70, 66, 69, 69, 77, 18, 55, 19,
-    72, 50, 51, 50, 51, 72, 18, 55, 20, 29, 75, 3,  3,  75, 55, 71, 57, 73,
-    74, 3,  30, 76, 50, 50, 76, 71, 23, 24, 51, 3,  73};
+    0,  34, 35, 55, 3,  4,  5,  6,  12, 26, 36, 44, 50, 56, 58, 59, 14, 50, 61,
+    62, 0,  50, 53, 50, 56, 59, 56, 7,  8,  9,  11, 13, 36, 37, 38, 39, 40, 41,
+    42, 43, 44, 45, 46, 47, 6,  25, 45, 56, 65, 69, 62, 27, 63, 64, 56, 57, 6,
+    56, 51, 50, 56, 56, 59, 12, 36, 7,  8,  9,  11, 56, 56, 40, 41, 56, 39, 41,
+    56, 39, 56, 39, 59, 59, 59, 59, 59, 50, 53, 65, 31, 32, 68, 6,  22, 70, 21,
+    52, 51, 28, 61, 52, 51, 22, 57, 10, 10, 38, 12, 50, 56, 56, 59, 56, 56, 56,
+    56, 56, 56, 25, 45, 45, 21, 50, 6,  5,  6,  81, 65, 63, 57, 6,  60, 51, 56,
+    56, 59, 57, 10, 10, 38, 6,  58, 51, 81, 58, 66, 67, 53, 53, 70, 15, 16, 72,
+    50, 51, 51, 56, 56, 59, 51, 70, 72, 52, 51, 6,  6,  16, 81, 17, 71, 3,  6,
+    70, 71, 67, 70, 70, 81, 18, 56, 33, 73, 51, 52, 51, 52, 73, 18, 56, 20, 19,
+    76, 3,  3,  76, 56, 72, 58, 74, 75, 20, 29, 79, 51, 51, 79, 72, 52, 58, 77,
+    78, 3,  30, 80, 80, 74, 23, 24, 52, 3,  77};
 
 /* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] = {
-    0,  53, 54, 54, 54, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55,
-    55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 56, 56,
-    57, 57, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 59,
-    59, 59, 59, 59, 60, 60, 61, 61, 62, 62, 63, 64, 64, 65, 66, 66, 67,
-    67, 68, 68, 68, 68, 68, 68, 68, 68, 68, 69, 69, 70, 70, 71, 71, 71,
-    72, 72, 73, 73, 74, 74, 74, 75, 75, 76, 76, 77, 77, 77, 77, 77, 77};
+    0,  54, 55, 55, 55, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56,
+    56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 57, 57, 58, 58,
+    59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 60, 60, 60, 60,
+    60, 61, 61, 62, 62, 63, 63, 64, 65, 65, 66, 67, 67, 68, 68, 69, 69, 69,
+    69, 69, 69, 69, 69, 69, 70, 70, 71, 71, 72, 72, 72, 73, 73, 74, 74, 75,
+    76, 76, 77, 77, 78, 78, 78, 79, 79, 80, 80, 81, 81, 81, 81, 81, 81};
 
 /* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] = {
-    0, 2, 0, 2, 2, 1, 3, 3, 2, 3, 4, 4, 3, 3, 4, 4, 4,  4, 3, 4, 5,
-    6, 3, 4, 5, 6, 5, 6, 5, 6, 3, 4, 3, 1, 1, 3, 1, 1,  1, 1, 3, 1,
-    2, 3, 3, 3, 3, 3, 4, 6, 1, 4, 6, 4, 6, 2, 4, 9, 10, 0, 2, 2, 1,
-    3, 1, 1, 3, 1, 1, 1, 2, 5, 1, 3, 4, 5, 5, 6, 2, 1,  0, 2, 0, 5,
-    6, 0, 3, 3, 1, 1, 2, 2, 0, 2, 0, 2, 1, 2, 3, 4, 3,  4};
+    0, 2, 0, 2, 2, 1, 3, 3, 2, 3, 4, 4, 3, 3,  4,  4, 4, 4, 3, 4, 5, 6,
+    3, 4, 5, 6, 5, 6, 5, 6, 3, 4, 3, 1, 1, 3,  1,  1, 1, 1, 3, 1, 2, 3,
+    3, 3, 3, 3, 4, 6, 1, 4, 6, 4, 6, 2, 4, 10, 11, 0, 2, 2, 1, 3, 1, 1,
+    3, 1, 1, 1, 2, 5, 1, 3, 4, 5, 5, 6, 2, 1,  0,  2, 0, 5, 6, 0, 3, 3,
+    1, 1, 0, 3, 3, 1, 1, 2, 2, 0, 2, 0, 2, 1,  2,  3, 4, 3, 4};
 
 enum
 {
@@ -2148,16 +2160,16 @@ yyreduce:
         }
         break;
 
-        case 57: /* select_core: "SELECT" select_field_list "FROM" table_def opt_joins opt_where opt_order_by opt_limit opt_offset  */
+        case 57: /* select_core: "SELECT" select_field_list "FROM" table_def opt_joins opt_where opt_group_by opt_order_by opt_limit opt_offset  */
         {
-            delete yyvsp[-5];
+            delete yyvsp[-6];
         }
         break;
 
-        case 58: /* select_core: "SELECT" "DISTINCT" select_field_list "FROM" table_def opt_joins opt_where opt_order_by opt_limit opt_offset  */
+        case 58: /* select_core: "SELECT" "DISTINCT" select_field_list "FROM" table_def opt_joins opt_where opt_group_by opt_order_by opt_limit opt_offset  */
         {
             context->poCurSelect->query_mode = SWQM_DISTINCT_LIST;
-            delete yyvsp[-5];
+            delete yyvsp[-6];
         }
         break;
 
@@ -2408,7 +2420,16 @@ yyreduce:
         }
         break;
 
-        case 89: /* sort_spec: field_value  */
+        case 89: /* group_by_spec: field_value  */
+        {
+            context->poCurSelect->PushGroupBy(yyvsp[0]->table_name,
+                                              yyvsp[0]->string_value);
+            delete yyvsp[0];
+            yyvsp[0] = nullptr;
+        }
+        break;
+
+        case 94: /* sort_spec: field_value  */
         {
             context->poCurSelect->PushOrderBy(yyvsp[0]->table_name,
                                               yyvsp[0]->string_value, TRUE);
@@ -2417,7 +2438,7 @@ yyreduce:
         }
         break;
 
-        case 90: /* sort_spec: field_value "ASC"  */
+        case 95: /* sort_spec: field_value "ASC"  */
         {
             context->poCurSelect->PushOrderBy(yyvsp[-1]->table_name,
                                               yyvsp[-1]->string_value, TRUE);
@@ -2426,7 +2447,7 @@ yyreduce:
         }
         break;
 
-        case 91: /* sort_spec: field_value "DESC"  */
+        case 96: /* sort_spec: field_value "DESC"  */
         {
             context->poCurSelect->PushOrderBy(yyvsp[-1]->table_name,
                                               yyvsp[-1]->string_value, FALSE);
@@ -2435,7 +2456,7 @@ yyreduce:
         }
         break;
 
-        case 93: /* opt_limit: "LIMIT" "integer number"  */
+        case 98: /* opt_limit: "LIMIT" "integer number"  */
         {
             context->poCurSelect->SetLimit(yyvsp[0]->int_value);
             delete yyvsp[0];
@@ -2443,7 +2464,7 @@ yyreduce:
         }
         break;
 
-        case 95: /* opt_offset: "OFFSET" "integer number"  */
+        case 100: /* opt_offset: "OFFSET" "integer number"  */
         {
             context->poCurSelect->SetOffset(yyvsp[0]->int_value);
             delete yyvsp[0];
@@ -2451,7 +2472,7 @@ yyreduce:
         }
         break;
 
-        case 96: /* table_def: "identifier"  */
+        case 101: /* table_def: "identifier"  */
         {
             const int iTable = context->poCurSelect->PushTableDef(
                 nullptr, yyvsp[0]->string_value, nullptr);
@@ -2461,7 +2482,7 @@ yyreduce:
         }
         break;
 
-        case 97: /* table_def: "identifier" as_clause  */
+        case 102: /* table_def: "identifier" as_clause  */
         {
             const int iTable = context->poCurSelect->PushTableDef(
                 nullptr, yyvsp[-1]->string_value, yyvsp[0]->string_value);
@@ -2472,7 +2493,7 @@ yyreduce:
         }
         break;
 
-        case 98: /* table_def: "string" '.' "identifier"  */
+        case 103: /* table_def: "string" '.' "identifier"  */
         {
             const int iTable = context->poCurSelect->PushTableDef(
                 yyvsp[-2]->string_value, yyvsp[0]->string_value, nullptr);
@@ -2483,7 +2504,7 @@ yyreduce:
         }
         break;
 
-        case 99: /* table_def: "string" '.' "identifier" as_clause  */
+        case 104: /* table_def: "string" '.' "identifier" as_clause  */
         {
             const int iTable = context->poCurSelect->PushTableDef(
                 yyvsp[-3]->string_value, yyvsp[-1]->string_value,
@@ -2496,7 +2517,7 @@ yyreduce:
         }
         break;
 
-        case 100: /* table_def: "identifier" '.' "identifier"  */
+        case 105: /* table_def: "identifier" '.' "identifier"  */
         {
             const int iTable = context->poCurSelect->PushTableDef(
                 yyvsp[-2]->string_value, yyvsp[0]->string_value, nullptr);
@@ -2507,7 +2528,7 @@ yyreduce:
         }
         break;
 
-        case 101: /* table_def: "identifier" '.' "identifier" as_clause  */
+        case 106: /* table_def: "identifier" '.' "identifier" as_clause  */
         {
             const int iTable = context->poCurSelect->PushTableDef(
                 yyvsp[-3]->string_value, yyvsp[-1]->string_value,
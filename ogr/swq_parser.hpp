@@ -84,13 +84,14 @@ enum yytokentype
     SWQT_OFFSET = 285,          /* "OFFSET"  */
     SWQT_EXCEPT = 286,          /* "EXCEPT"  */
     SWQT_EXCLUDE = 287,         /* "EXCLUDE"  */
-    SWQT_VALUE_START = 288,     /* SWQT_VALUE_START  */
-    SWQT_SELECT_START = 289,    /* SWQT_SELECT_START  */
-    SWQT_NOT = 290,             /* "NOT"  */
-    SWQT_OR = 291,              /* "OR"  */
-    SWQT_AND = 292,             /* "AND"  */
-    SWQT_UMINUS = 293,          /* SWQT_UMINUS  */
-    SWQT_RESERVED_KEYWORD = 294 /* "reserved keyword"  */
+    SWQT_GROUP = 288,           /* "GROUP"  */
+    SWQT_VALUE_START = 289,     /* SWQT_VALUE_START  */
+    SWQT_SELECT_START = 290,    /* SWQT_SELECT_START  */
+    SWQT_NOT = 291,             /* "NOT"  */
+    SWQT_OR = 292,              /* "OR"  */
+    SWQT_AND = 293,             /* "AND"  */
+    SWQT_UMINUS = 294,          /* SWQT_UMINUS  */
+    SWQT_RESERVED_KEYWORD = 295 /* "reserved keyword"  */
 };
 typedef enum yytokentype yytoken_kind_t;
 #endif
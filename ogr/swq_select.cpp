@@ -98,6 +98,14 @@ swq_select::~swq_select()
 
     CPLFree(order_defs);
 
+    for (int i = 0; i < group_by_specs; i++)
+    {
+        CPLFree(group_by_defs[i].table_name);
+        CPLFree(group_by_defs[i].field_name);
+    }
+
+    CPLFree(group_by_defs);
+
     for (int i = 0; i < join_count; i++)
     {
         delete join_defs[i].poExpr;
@@ -284,6 +292,18 @@ char *swq_select::Unparse()
         CPLFree(pszTmp);
     }
 
+    if (group_by_specs > 0)
+    {
+        osSelect += " GROUP BY ";
+        for (int i = 0; i < group_by_specs; i++)
+        {
+            if (i > 0)
+                osSelect += ", ";
+            osSelect += swq_expr_node::QuoteIfNecessary(
+                group_by_defs[i].field_name, '"');
+        }
+    }
+
     if (order_specs > 0)
     {
         osSelect += " ORDER BY ";
@@ -691,6 +711,24 @@ void swq_select::PushOrderBy(const char *pszTableName, const char *pszFieldName,
     order_defs[order_specs - 1].ascending_flag = bAscending;
 }
 
+/************************************************************************/
+/*                            PushGroupBy()                             */
+/************************************************************************/
+
+void swq_select::PushGroupBy(const char *pszTableName, const char *pszFieldName)
+
+{
+    group_by_specs++;
+    group_by_defs = static_cast<swq_group_by_def *>(
+        CPLRealloc(group_by_defs, sizeof(swq_group_by_def) * group_by_specs));
+
+    group_by_defs[group_by_specs - 1].table_name =
+        CPLStrdup(pszTableName ? pszTableName : "");
+    group_by_defs[group_by_specs - 1].field_name = CPLStrdup(pszFieldName);
+    group_by_defs[group_by_specs - 1].table_index = -1;
+    group_by_defs[group_by_specs - 1].field_index = -1;
+}
+
 /************************************************************************/
 /*                              PushJoin()                              */
 /************************************************************************/
@@ -1023,6 +1061,53 @@ CPLErr swq_select::parse(swq_field_list *field_list,
         return CE_Failure;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Process column names in GROUP BY specs.                         */
+    /* -------------------------------------------------------------------- */
+    if (group_by_specs > 0 && query_mode == SWQM_DISTINCT_LIST)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "SELECT DISTINCT not supported together with GROUP BY.");
+        return CE_Failure;
+    }
+
+    for (int i = 0; i < group_by_specs; i++)
+    {
+        swq_group_by_def *def = group_by_defs + i;
+
+        // Identify field.
+        swq_field_type field_type;
+        def->field_index =
+            swq_identify_field(def->table_name, def->field_name, field_list,
+                               &field_type, &(def->table_index));
+        if (def->field_index == -1)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Unrecognized field name %s in GROUP BY.",
+                     def->table_name[0]
+                         ? CPLSPrintf("%s.%s", def->table_name, def->field_name)
+                         : def->field_name);
+            return CE_Failure;
+        }
+
+        if (def->table_index != 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot use field '%s' of a secondary table in "
+                     "a GROUP BY clause",
+                     def->field_name);
+            return CE_Failure;
+        }
+
+        if (field_type == SWQ_GEOMETRY)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot use geometry field '%s' in a GROUP BY clause",
+                     def->field_name);
+            return CE_Failure;
+        }
+    }
+
     for (int i = 0; i < result_columns(); i++)
     {
         swq_col_def *def = &column_defs[i];
@@ -1044,7 +1129,8 @@ CPLErr swq_select::parse(swq_field_list *field_list,
             def->col_func == SWQCF_AVG || def->col_func == SWQCF_SUM ||
             def->col_func == SWQCF_COUNT)
         {
-            this_indicator = SWQM_SUMMARY_RECORD;
+            this_indicator =
+                group_by_specs > 0 ? SWQM_GROUP_BY : SWQM_SUMMARY_RECORD;
             if (def->col_func == SWQCF_COUNT && def->distinct_flag &&
                 def->field_type == SWQ_GEOMETRY)
             {
@@ -1053,6 +1139,37 @@ CPLErr swq_select::parse(swq_field_list *field_list,
                 return CE_Failure;
             }
         }
+        else if (def->col_func == SWQCF_NONE && group_by_specs > 0)
+        {
+            // Only the grouping fields can be selected without an
+            // aggregate function.
+            bool bIsGroupByField = false;
+            if (def->expr == nullptr || def->expr->eNodeType == SNT_COLUMN)
+            {
+                for (int j = 0; j < group_by_specs; j++)
+                {
+                    if (group_by_defs[j].table_index == def->table_index &&
+                        group_by_defs[j].field_index == def->field_index)
+                    {
+                        bIsGroupByField = true;
+                        break;
+                    }
+                }
+            }
+            if (!bIsGroupByField)
+            {
+                char *pszColumn = def->expr && def->field_name[0] == '\0'
+                                      ? def->expr->Unparse(nullptr, '"')
+                                      : CPLStrdup(def->field_name);
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Column '%s' must appear in the GROUP BY clause or "
+                         "be used in an aggregate function.",
+                         pszColumn);
+                CPLFree(pszColumn);
+                return CE_Failure;
+            }
+            this_indicator = SWQM_GROUP_BY;
+        }
         else if (def->col_func == SWQCF_NONE)
         {
             if (query_mode == SWQM_DISTINCT_LIST)
@@ -1134,6 +1251,24 @@ CPLErr swq_select::parse(swq_field_list *field_list,
                      def->field_name);
             return CE_Failure;
         }
+
+        if (group_by_specs > 0)
+        {
+            int j = 0;
+            for (; j < group_by_specs; j++)
+            {
+                if (group_by_defs[j].field_index == def->field_index)
+                    break;
+            }
+            if (j == group_by_specs)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Field '%s' in ORDER BY must appear in the "
+                         "GROUP BY clause",
+                         def->field_name);
+                return CE_Failure;
+            }
+        }
     }
 
     /* -------------------------------------------------------------------- */
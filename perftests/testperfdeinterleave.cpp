@@ -33,6 +33,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <vector>
 
 int main(int /* argc */, char * /* argv */[])
 {
@@ -97,6 +98,46 @@ int main(int /* argc */, char * /* argv */[])
     }
     CPLSetConfigOption("GDAL_USE_SSSE3", nullptr);
 
+    // Many components, as in hyperspectral imagery. The total size of the
+    // interleaved buffer is the same whatever the number of components.
+    for (const GDALDataType eDT : {GDT_Byte, GDT_Int16, GDT_UInt16,
+                                   GDT_Float32})
+    {
+        const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+        for (const int nComponents : {8, 32, 200})
+        {
+            const size_t nIters =
+                static_cast<size_t>(SIZE) * SIZE * 4 / nDTSize / nComponents;
+            std::vector<std::vector<GByte>> aabyComps(
+                nComponents, std::vector<GByte>(nIters * nDTSize));
+            std::vector<void *> apComps;
+            for (auto &abyComp : aabyComps)
+                apComps.push_back(abyComp.data());
+
+            {
+                const auto start = clock();
+                for (int i = 0; i < 200; ++i)
+                    GDALDeinterleave(src, eDT, nComponents, apComps.data(),
+                                     eDT, nIters);
+                const auto end = clock();
+                printf("GDALDeinterleave %s %d : %.2f\n",
+                       GDALGetDataTypeName(eDT), nComponents,
+                       (end - start) * 1.0 / CLOCKS_PER_SEC);
+            }
+
+            {
+                const auto start = clock();
+                for (int i = 0; i < 200; ++i)
+                    GDALInterleave(apComps.data(), eDT, nComponents, src, eDT,
+                                   nIters);
+                const auto end = clock();
+                printf("GDALInterleave %s %d : %.2f\n",
+                       GDALGetDataTypeName(eDT), nComponents,
+                       (end - start) * 1.0 / CLOCKS_PER_SEC);
+            }
+        }
+    }
+
     VSIFree(src);
     VSIFree(dst0);
     VSIFree(dst1);
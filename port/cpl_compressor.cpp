@@ -61,6 +61,7 @@
 #endif
 
 #include <limits>
+#include <memory>
 #include <mutex>
 #include <type_traits>
 #include <vector>
@@ -381,6 +382,40 @@ static bool CPLLZMADecompressor(const void *input_data, size_t input_size,
 #endif  // HAVE_LZMA
 
 #ifdef HAVE_ZSTD
+
+namespace
+{
+struct ZSTDContextDeleter
+{
+    void operator()(ZSTD_CCtx *ctx) const
+    {
+        ZSTD_freeCCtx(ctx);
+    }
+    void operator()(ZSTD_DCtx *ctx) const
+    {
+        ZSTD_freeDCtx(ctx);
+    }
+};
+}  // namespace
+
+// Contexts are reused by the successive calls made by a thread, as
+// creating them dominates the cost of (de)compressing small buffers.
+static ZSTD_CCtx *CPLZSTDGetThreadCCtx()
+{
+    static thread_local std::unique_ptr<ZSTD_CCtx, ZSTDContextDeleter> ctx;
+    if (!ctx)
+        ctx.reset(ZSTD_createCCtx());
+    return ctx.get();
+}
+
+static ZSTD_DCtx *CPLZSTDGetThreadDCtx()
+{
+    static thread_local std::unique_ptr<ZSTD_DCtx, ZSTDContextDeleter> ctx;
+    if (!ctx)
+        ctx.reset(ZSTD_createDCtx());
+    return ctx.get();
+}
+
 static bool CPLZSTDCompressor(const void *input_data, size_t input_size,
                               void **output_data, size_t *output_size,
                               CSLConstList options,
@@ -390,7 +425,7 @@ static bool CPLZSTDCompressor(const void *input_data, size_t input_size,
         output_size != nullptr && *output_size != 0)
     {
         const int level = atoi(CSLFetchNameValueDef(options, "LEVEL", "13"));
-        ZSTD_CCtx *ctx = ZSTD_createCCtx();
+        ZSTD_CCtx *ctx = CPLZSTDGetThreadCCtx();
         if (ctx == nullptr)
         {
             *output_size = 0;
@@ -399,7 +434,6 @@ static bool CPLZSTDCompressor(const void *input_data, size_t input_size,
 
         size_t ret = ZSTD_compressCCtx(ctx, *output_data, *output_size,
                                        input_data, input_size, level);
-        ZSTD_freeCCtx(ctx);
         if (ZSTD_isError(ret))
         {
             *output_size = 0;
@@ -485,11 +519,22 @@ static bool CPLZSTDDecompressor(const void *input_data, size_t input_size,
                                 CSLConstList /* options */,
                                 void * /* compressor_user_data */)
 {
+    ZSTD_DCtx *ctx = nullptr;
+    if (output_data != nullptr && output_size != nullptr)
+    {
+        ctx = CPLZSTDGetThreadDCtx();
+        if (ctx == nullptr)
+        {
+            *output_size = 0;
+            return false;
+        }
+    }
+
     if (output_data != nullptr && *output_data != nullptr &&
         output_size != nullptr && *output_size != 0)
     {
-        size_t ret =
-            ZSTD_decompress(*output_data, *output_size, input_data, input_size);
+        size_t ret = ZSTD_decompressDCtx(ctx, *output_data, *output_size,
+                                         input_data, input_size);
         if (ZSTD_isError(ret))
         {
             *output_size = CPLZSTDGetDecompressedSize(input_data, input_size);
@@ -517,8 +562,8 @@ static bool CPLZSTDDecompressor(const void *input_data, size_t input_size,
             return false;
         }
 
-        size_t ret =
-            ZSTD_decompress(*output_data, nOutSize, input_data, input_size);
+        size_t ret = ZSTD_decompressDCtx(ctx, *output_data, nOutSize,
+                                         input_data, input_size);
         if (ZSTD_isError(ret))
         {
             *output_size = 0;
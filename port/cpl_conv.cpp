@@ -81,6 +81,9 @@
 #ifdef DEBUG_CONFIG_OPTIONS
 #include <set>
 #endif
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
 
 #include "cpl_config.h"
@@ -111,6 +114,31 @@ static bool gbIgnoreEnvVariables =
 static std::vector<std::pair<CPLSetConfigOptionSubscriber, void *>>
     gSetConfigOptionSubscribers{};
 
+namespace
+{
+/** Immutable view of g_papszConfigOptions, used by CPLGetGlobalConfigOption()
+ * so that readers do not need to take hConfigMutex. Keys are owned by the
+ * snapshot. Values point into g_papszConfigOptions, and are thus subject to
+ * the same lifetime rules as strings returned by CPLGetConfigOption().
+ */
+struct CPLConfigOptionsSnapshot
+{
+    std::vector<std::pair<std::string, const char *>> aoKeyValues{};
+};
+
+/** Per-thread reference to the last snapshot seen by that thread. */
+struct CPLConfigOptionsSnapshotTLS
+{
+    uint64_t nGeneration = 0;
+    std::shared_ptr<const CPLConfigOptionsSnapshot> poSnapshot{};
+};
+}  // namespace
+
+// Protected by hConfigMutex.
+static std::shared_ptr<const CPLConfigOptionsSnapshot> gpoConfigSnapshot{};
+// Incremented each time gpoConfigSnapshot is replaced.
+static std::atomic<uint64_t> gnConfigSnapshotGeneration{0};
+
 // Used by CPLOpenShared() and friends.
 static CPLMutex *hSharedFileMutex = nullptr;
 static int nSharedFileCount = 0;
@@ -1720,6 +1748,44 @@ const char *CPL_STDCALL CPLGetConfigOption(const char *pszKey,
     return pszResult;
 }
 
+/************************************************************************/
+/*                   CPLConfigOptionsSnapshotUpdate()                   */
+/************************************************************************/
+
+/* Must be called with hConfigMutex held, after g_papszConfigOptions has been
+ * modified. */
+static void CPLConfigOptionsSnapshotUpdate()
+{
+    std::shared_ptr<CPLConfigOptionsSnapshot> poSnapshot;
+    if (g_papszConfigOptions)
+    {
+        poSnapshot = std::make_shared<CPLConfigOptionsSnapshot>();
+        for (const char *const *papszIter =
+                 const_cast<const char *const *>(g_papszConfigOptions);
+             *papszIter; ++papszIter)
+        {
+            // Same splitting rule as CSLFetchNameValue()
+            const char *pszSep = strpbrk(*papszIter, "=:");
+            if (pszSep)
+            {
+                poSnapshot->aoKeyValues.emplace_back(
+                    std::string(*papszIter, pszSep - *papszIter), pszSep + 1);
+            }
+        }
+    }
+    gpoConfigSnapshot = std::move(poSnapshot);
+    gnConfigSnapshotGeneration.fetch_add(1, std::memory_order_release);
+}
+
+/************************************************************************/
+/*                   CPLConfigOptionsSnapshotTLSFree()                  */
+/************************************************************************/
+
+static void CPLConfigOptionsSnapshotTLSFree(void *pData)
+{
+    delete static_cast<CPLConfigOptionsSnapshotTLS *>(pData);
+}
+
 /************************************************************************/
 /*                         CPLGetConfigOptions()                        */
 /************************************************************************/
@@ -1767,6 +1833,7 @@ void CPLSetConfigOptions(const char *const *papszConfigOptions)
     CSLDestroy(const_cast<char **>(g_papszConfigOptions));
     g_papszConfigOptions = const_cast<volatile char **>(
         CSLDuplicate(const_cast<char **>(papszConfigOptions)));
+    CPLConfigOptionsSnapshotUpdate();
 }
 
 /************************************************************************/
@@ -1813,15 +1880,43 @@ const char *CPL_STDCALL CPLGetGlobalConfigOption(const char *pszKey,
     CPLAccessConfigOption(pszKey, TRUE);
 #endif
 
-    CPLMutexHolderD(&hConfigMutex);
-
-    const char *pszResult =
-        CSLFetchNameValue(const_cast<char **>(g_papszConfigOptions), pszKey);
+    const uint64_t nGeneration =
+        gnConfigSnapshotGeneration.load(std::memory_order_acquire);
+    // Fast path: no global configuration option has ever been set.
+    if (nGeneration == 0 || pszKey == nullptr)
+        return pszDefault;
 
-    if (pszResult == nullptr)
+    // Each thread keeps a reference to the last snapshot it has seen, so that
+    // the mutex is only taken when the global options have changed since.
+    int bMemoryError = FALSE;
+    auto psTLS = static_cast<CPLConfigOptionsSnapshotTLS *>(
+        CPLGetTLSEx(CTLS_CONFIGOPTIONSSNAPSHOT, &bMemoryError));
+    if (bMemoryError)
         return pszDefault;
+    if (psTLS == nullptr)
+    {
+        psTLS = new CPLConfigOptionsSnapshotTLS();
+        CPLSetTLSWithFreeFunc(CTLS_CONFIGOPTIONSSNAPSHOT, psTLS,
+                              CPLConfigOptionsSnapshotTLSFree);
+    }
+    if (psTLS->nGeneration != nGeneration)
+    {
+        CPLMutexHolderD(&hConfigMutex);
+        psTLS->poSnapshot = gpoConfigSnapshot;
+        psTLS->nGeneration =
+            gnConfigSnapshotGeneration.load(std::memory_order_relaxed);
+    }
 
-    return pszResult;
+    if (psTLS->poSnapshot)
+    {
+        for (const auto &oKeyValue : psTLS->poSnapshot->aoKeyValues)
+        {
+            if (EQUAL(oKeyValue.first.c_str(), pszKey))
+                return oKeyValue.second;
+        }
+    }
+
+    return pszDefault;
 }
 
 /************************************************************************/
@@ -1951,6 +2046,7 @@ void CPL_STDCALL CPLSetConfigOption(const char *pszKey, const char *pszValue)
 
     g_papszConfigOptions = const_cast<volatile char **>(CSLSetNameValue(
         const_cast<char **>(g_papszConfigOptions), pszKey, pszValue));
+    CPLConfigOptionsSnapshotUpdate();
 
     NotifyOtherComponentsConfigOptionChanged(pszKey, pszValue,
                                              /*bTheadLocal=*/false);
@@ -2088,6 +2184,7 @@ void CPL_STDCALL CPLFreeConfig()
 
         CSLDestroy(const_cast<char **>(g_papszConfigOptions));
         g_papszConfigOptions = nullptr;
+        CPLConfigOptionsSnapshotUpdate();
 
         int bMemoryError = FALSE;
         char **papszTLConfigOptions = reinterpret_cast<char **>(
@@ -43,6 +43,10 @@
 #include "gdal_csv.h"
 
 #include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 
 /* ==================================================================== */
 /*      The CSVTable is a persistent set of info about an open CSV      */
@@ -67,6 +71,8 @@ typedef struct ctb
     char **papszLines;
     int *panLineIndex;
     char *pszRawData;
+    /* Whether the 3 above arrays belong to the process-wide cache */
+    bool bSharedIngest;
 } CSVTable;
 
 static void CSVDeaccessInternal(CSVTable **ppsCSVTableList, bool bCanUseTLS,
@@ -243,9 +249,12 @@ static void CSVDeaccessInternal(CSVTable **ppsCSVTableList, bool bCanUseTLS,
     CPLFree(psTable->panFieldNamesLength);
     CSLDestroy(psTable->papszRecFields);
     CPLFree(psTable->pszFilename);
-    CPLFree(psTable->panLineIndex);
-    CPLFree(psTable->pszRawData);
-    CPLFree(psTable->papszLines);
+    if (!psTable->bSharedIngest)
+    {
+        CPLFree(psTable->panLineIndex);
+        CPLFree(psTable->pszRawData);
+        CPLFree(psTable->papszLines);
+    }
 
     CPLFree(psTable);
 
@@ -398,54 +407,85 @@ static char *CSVFindNextLine(char *pszThisLine)
 }
 
 /************************************************************************/
-/*                             CSVIngest()                              */
+/*                          CSVIngestedData                             */
+/*                                                                      */
+/*      Whole content of a CSV file, split into lines, with its index.  */
+/************************************************************************/
+
+namespace
+{
+struct CSVIngestedData
+{
+    vsi_l_offset nFileSize = 0;
+    GIntBig nMTime = 0;
+    int nLineCount = 0;
+    char **papszLines = nullptr;
+    int *panLineIndex = nullptr;
+    char *pszRawData = nullptr;
+
+    CSVIngestedData() = default;
+    CSVIngestedData(const CSVIngestedData &) = delete;
+    CSVIngestedData &operator=(const CSVIngestedData &) = delete;
+
+    ~CSVIngestedData()
+    {
+        CPLFree(panLineIndex);
+        CPLFree(pszRawData);
+        CPLFree(papszLines);
+    }
+};
+
+/* Process-wide cache of ingested tables. Entries are immutable once */
+/* inserted, and never removed before process termination, so that  */
+/* the per-thread CSVTable can point to them without locking. When   */
+/* filled before fork(), its pages are shared by the child processes.*/
+std::mutex goSharedIngestedMutex;
+std::map<std::string, std::unique_ptr<CSVIngestedData>> goSharedIngested;
+}  // namespace
+
+/************************************************************************/
+/*                          CSVIngestData()                             */
 /*                                                                      */
 /*      Load entire file into memory and setup index if possible.       */
 /************************************************************************/
 
-// TODO(schwehr): Clean up all the casting in CSVIngest.
-static void CSVIngest(CSVTable *psTable)
+static bool CSVIngestData(VSILFILE *fp, const char *pszFilename,
+                          CSVIngestedData &oData)
 
 {
-    if (psTable->pszRawData != nullptr)
-        return;
-
     /* -------------------------------------------------------------------- */
     /*      Ingest whole file.                                              */
     /* -------------------------------------------------------------------- */
-    if (VSIFSeekL(psTable->fp, 0, SEEK_END) != 0)
+    if (VSIFSeekL(fp, 0, SEEK_END) != 0)
     {
         CPLError(CE_Failure, CPLE_FileIO,
                  "Failed using seek end and tell to get file length: %s",
-                 psTable->pszFilename);
-        return;
+                 pszFilename);
+        return false;
     }
-    const vsi_l_offset nFileLen = VSIFTellL(psTable->fp);
+    const vsi_l_offset nFileLen = VSIFTellL(fp);
     if (static_cast<long>(nFileLen) == -1)
     {
         CPLError(CE_Failure, CPLE_FileIO,
                  "Failed using seek end and tell to get file length: %s",
-                 psTable->pszFilename);
-        return;
+                 pszFilename);
+        return false;
     }
-    VSIRewindL(psTable->fp);
+    VSIRewindL(fp);
 
-    psTable->pszRawData = static_cast<char *>(
+    oData.pszRawData = static_cast<char *>(
         VSI_MALLOC_VERBOSE(static_cast<size_t>(nFileLen) + 1));
-    if (psTable->pszRawData == nullptr)
-        return;
-    if (VSIFReadL(psTable->pszRawData, 1, static_cast<size_t>(nFileLen),
-                  psTable->fp) != static_cast<size_t>(nFileLen))
+    if (oData.pszRawData == nullptr)
+        return false;
+    if (VSIFReadL(oData.pszRawData, 1, static_cast<size_t>(nFileLen), fp) !=
+        static_cast<size_t>(nFileLen))
     {
-        CPLFree(psTable->pszRawData);
-        psTable->pszRawData = nullptr;
-
         CPLError(CE_Failure, CPLE_FileIO, "Read of file %s failed.",
-                 psTable->pszFilename);
-        return;
+                 pszFilename);
+        return false;
     }
 
-    psTable->pszRawData[nFileLen] = '\0';
+    oData.pszRawData[nFileLen] = '\0';
 
     /* -------------------------------------------------------------------- */
     /*      Get count of newlines so we can allocate line array.            */
@@ -453,14 +493,14 @@ static void CSVIngest(CSVTable *psTable)
     int nMaxLineCount = 0;
     for (int i = 0; i < static_cast<int>(nFileLen); i++)
     {
-        if (psTable->pszRawData[i] == 10)
+        if (oData.pszRawData[i] == 10)
             nMaxLineCount++;
     }
 
-    psTable->papszLines =
+    oData.papszLines =
         static_cast<char **>(VSI_CALLOC_VERBOSE(sizeof(char *), nMaxLineCount));
-    if (psTable->papszLines == nullptr)
-        return;
+    if (oData.papszLines == nullptr)
+        return false;
 
     /* -------------------------------------------------------------------- */
     /*      Build a list of record pointers into the raw data buffer        */
@@ -468,40 +508,119 @@ static void CSVIngest(CSVTable *psTable)
     /*      strings.                                                        */
     /* -------------------------------------------------------------------- */
     /* skip header line */
-    char *pszThisLine = CSVFindNextLine(psTable->pszRawData);
+    char *pszThisLine = CSVFindNextLine(oData.pszRawData);
 
     int iLine = 0;
     while (pszThisLine != nullptr && iLine < nMaxLineCount)
     {
         if (pszThisLine[0] != '#')
-            psTable->papszLines[iLine++] = pszThisLine;
+            oData.papszLines[iLine++] = pszThisLine;
         pszThisLine = CSVFindNextLine(pszThisLine);
     }
 
-    psTable->nLineCount = iLine;
+    oData.nLineCount = iLine;
 
     /* -------------------------------------------------------------------- */
     /*      Allocate and populate index array.  Ensure they are in          */
     /*      ascending order so that binary searches can be done on the      */
     /*      array.                                                          */
     /* -------------------------------------------------------------------- */
-    psTable->panLineIndex = static_cast<int *>(
-        VSI_MALLOC_VERBOSE(sizeof(int) * psTable->nLineCount));
-    if (psTable->panLineIndex == nullptr)
-        return;
+    oData.panLineIndex =
+        static_cast<int *>(VSI_MALLOC_VERBOSE(sizeof(int) * oData.nLineCount));
+    if (oData.panLineIndex == nullptr)
+        return false;
 
-    for (int i = 0; i < psTable->nLineCount; i++)
+    for (int i = 0; i < oData.nLineCount; i++)
     {
-        psTable->panLineIndex[i] = atoi(psTable->papszLines[i]);
+        oData.panLineIndex[i] = atoi(oData.papszLines[i]);
 
-        if (i > 0 && psTable->panLineIndex[i] < psTable->panLineIndex[i - 1])
+        if (i > 0 && oData.panLineIndex[i] < oData.panLineIndex[i - 1])
         {
-            CPLFree(psTable->panLineIndex);
-            psTable->panLineIndex = nullptr;
+            CPLFree(oData.panLineIndex);
+            oData.panLineIndex = nullptr;
             break;
         }
     }
 
+    return true;
+}
+
+/************************************************************************/
+/*                       CSVIngestSharedData()                          */
+/*                                                                      */
+/*      Return the entry of the process-wide cache for pszFilename,     */
+/*      ingesting it from fp if needed. Return nullptr if the cache     */
+/*      is disabled, or if the file changed since it was cached.        */
+/************************************************************************/
+
+static const CSVIngestedData *CSVIngestSharedData(VSILFILE *fp,
+                                                  const char *pszFilename)
+
+{
+    if (!CPLTestBool(CPLGetConfigOption("CPL_CSV_SHARED_CACHE", "YES")))
+        return nullptr;
+
+    VSIStatBufL sStat;
+    if (VSIStatL(pszFilename, &sStat) != 0)
+        return nullptr;
+
+    std::lock_guard<std::mutex> oLock(goSharedIngestedMutex);
+    auto oIter = goSharedIngested.find(pszFilename);
+    if (oIter != goSharedIngested.end())
+    {
+        const CSVIngestedData *poData = oIter->second.get();
+        if (poData->nFileSize != static_cast<vsi_l_offset>(sStat.st_size) ||
+            poData->nMTime != static_cast<GIntBig>(sStat.st_mtime))
+        {
+            return nullptr;
+        }
+        return poData;
+    }
+
+    auto poData = std::make_unique<CSVIngestedData>();
+    poData->nFileSize = static_cast<vsi_l_offset>(sStat.st_size);
+    poData->nMTime = static_cast<GIntBig>(sStat.st_mtime);
+    if (!CSVIngestData(fp, pszFilename, *poData))
+        return nullptr;
+    const CSVIngestedData *poRet = poData.get();
+    goSharedIngested[pszFilename] = std::move(poData);
+    return poRet;
+}
+
+/************************************************************************/
+/*                             CSVIngest()                              */
+/*                                                                      */
+/*      Load entire file into memory and setup index if possible.       */
+/************************************************************************/
+
+static void CSVIngest(CSVTable *psTable)
+
+{
+    if (psTable->pszRawData != nullptr)
+        return;
+
+    const CSVIngestedData *poSharedData =
+        CSVIngestSharedData(psTable->fp, psTable->pszFilename);
+    if (poSharedData)
+    {
+        psTable->nLineCount = poSharedData->nLineCount;
+        psTable->papszLines = poSharedData->papszLines;
+        psTable->panLineIndex = poSharedData->panLineIndex;
+        psTable->pszRawData = poSharedData->pszRawData;
+        psTable->bSharedIngest = true;
+    }
+    else
+    {
+        CSVIngestedData oData;
+        if (!CSVIngestData(psTable->fp, psTable->pszFilename, oData))
+            return;
+
+        psTable->nLineCount = oData.nLineCount;
+        std::swap(psTable->papszLines, oData.papszLines);
+        std::swap(psTable->panLineIndex, oData.panLineIndex);
+        std::swap(psTable->pszRawData, oData.pszRawData);
+    }
+
     psTable->iLastLine = -1;
 
     /* -------------------------------------------------------------------- */
@@ -524,6 +643,37 @@ static void CSVIngest(const char *pszFilename)
     CSVIngest(psTable);
 }
 
+/************************************************************************/
+/*                             CSVPreload()                             */
+/************************************************************************/
+
+/** Ingest a CSV file into the process-wide cache of CSV tables.
+ *
+ * The CSV lookup functions (CSVGetField(), CSVScanFileByName(), ...) ingest
+ * each table they access once per process into read-only memory, that is
+ * shared by all threads. Calling this function in a parent process, before
+ * fork(), makes the child processes share the pages of those tables, instead
+ * of each of them reading and indexing its own copy on first use.
+ *
+ * This function does nothing and returns FALSE if the
+ * CPL_CSV_SHARED_CACHE configuration option is set to NO.
+ *
+ * @param pszFilename Filename of the CSV file, typically returned by
+ *                    CSVFilename().
+ * @return TRUE if the table is (or already was) in the cache.
+ * @since GDAL 3.9
+ */
+int CSVPreload(const char *pszFilename)
+
+{
+    VSILFILE *fp = VSIFOpenL(pszFilename, "rb");
+    if (fp == nullptr)
+        return FALSE;
+    const bool bRet = CSVIngestSharedData(fp, pszFilename) != nullptr;
+    VSIFCloseL(fp);
+    return bRet;
+}
+
 /************************************************************************/
 /*                        CSVDetectSeperator()                          */
 /************************************************************************/
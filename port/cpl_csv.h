@@ -74,6 +74,7 @@ int CPL_DLL CSVGetFieldIdL(VSILFILE *, const char *);
 int CPL_DLL CSVGetFileFieldId(const char *, const char *);
 
 void CPL_DLL CSVDeaccess(const char *);
+int CPL_DLL CSVPreload(const char *);
 
 const char CPL_DLL *CSVGetField(const char *, const char *, const char *,
                                 CSVCompareCriteria, const char *);
@@ -43,6 +43,7 @@
 #include "cpl_http.h"
 #include "cpl_error.h"
 #include "cpl_multiproc.h"
+#include "cpl_trace.h"
 
 // gcc or clang complains about C-style cast in #define like
 // CURL_ZERO_TERMINATED
@@ -1064,10 +1065,40 @@ CPLHTTPResult *CPLHTTPFetch(const char *pszURL, CSLConstList papszOptions)
  * @return              A CPLHTTPResult* structure that must be freed by
  * CPLHTTPDestroyResult(), or NULL if libcurl support is disabled.
  */
+static CPLHTTPResult *
+CPLHTTPFetchExInternal(const char *pszURL, CSLConstList papszOptions,
+                       GDALProgressFunc pfnProgress, void *pProgressArg,
+                       CPLHTTPFetchWriteFunc pfnWrite, void *pWriteArg);
+
 CPLHTTPResult *CPLHTTPFetchEx(const char *pszURL, CSLConstList papszOptions,
                               GDALProgressFunc pfnProgress, void *pProgressArg,
                               CPLHTTPFetchWriteFunc pfnWrite, void *pWriteArg)
 
+{
+    CPLTraceSpan oTraceSpan("CPLHTTPFetchEx");
+    oTraceSpan.SetAttribute("url", pszURL);
+    CPLHTTPResult *psResult =
+        CPLHTTPFetchExInternal(pszURL, papszOptions, pfnProgress, pProgressArg,
+                               pfnWrite, pWriteArg);
+    if (psResult && oTraceSpan.IsEnabled())
+    {
+        oTraceSpan.SetAttribute("status",
+                                static_cast<GIntBig>(psResult->nStatus));
+        oTraceSpan.SetAttribute("bytes",
+                                static_cast<GIntBig>(psResult->nDataLen));
+    }
+    return psResult;
+}
+
+/************************************************************************/
+/*                      CPLHTTPFetchExInternal()                        */
+/************************************************************************/
+
+static CPLHTTPResult *
+CPLHTTPFetchExInternal(const char *pszURL, CSLConstList papszOptions,
+                       GDALProgressFunc pfnProgress, void *pProgressArg,
+                       CPLHTTPFetchWriteFunc pfnWrite, void *pWriteArg)
+
 {
     if (STARTS_WITH(pszURL, "/vsimem/") &&
         // Disabled by default for potential security issues.
@@ -1907,6 +1938,61 @@ static int CPLHTTPCurlDebugFunction(CURL *handle, curl_infotype type,
     return 0;
 }
 
+/************************************************************************/
+/*                       CPLHTTPGetShareHandle()                        */
+/************************************************************************/
+
+// Process-wide share handle, so that all curl easy handles, whatever the
+// thread using them, share the DNS cache and the TLS session cache. New
+// connections to an already contacted server can thus resume the TLS
+// session instead of doing a full handshake.
+// Connections themselves are not shared, as libcurl does not support sharing
+// them among concurrent threads: each thread keeps its own connection cache
+// through its multi handle.
+
+static CURLSH *ghShareHandle = nullptr;
+static bool gbShareHandleInitialized = false;
+
+static std::mutex &CPLHTTPGetShareMutex(curl_lock_data data)
+{
+    static std::array<std::mutex, CURL_LOCK_DATA_LAST> aoMutexes;
+    return aoMutexes[static_cast<size_t>(data) % aoMutexes.size()];
+}
+
+static void CPLHTTPShareLock(CURL * /*handle*/, curl_lock_data data,
+                             curl_lock_access /*access*/, void * /*userptr*/)
+{
+    CPLHTTPGetShareMutex(data).lock();
+}
+
+static void CPLHTTPShareUnlock(CURL * /*handle*/, curl_lock_data data,
+                               void * /*userptr*/)
+{
+    CPLHTTPGetShareMutex(data).unlock();
+}
+
+static CURLSH *CPLHTTPGetShareHandle()
+{
+    CPLMutexHolder oHolder(&hSessionMapMutex);
+    if (!gbShareHandleInitialized)
+    {
+        gbShareHandleInitialized = true;
+        ghShareHandle = curl_share_init();
+        if (ghShareHandle)
+        {
+            curl_share_setopt(ghShareHandle, CURLSHOPT_LOCKFUNC,
+                              CPLHTTPShareLock);
+            curl_share_setopt(ghShareHandle, CURLSHOPT_UNLOCKFUNC,
+                              CPLHTTPShareUnlock);
+            curl_share_setopt(ghShareHandle, CURLSHOPT_SHARE,
+                              CURL_LOCK_DATA_DNS);
+            curl_share_setopt(ghShareHandle, CURLSHOPT_SHARE,
+                              CURL_LOCK_DATA_SSL_SESSION);
+        }
+    }
+    return ghShareHandle;
+}
+
 /************************************************************************/
 /*                         CPLHTTPSetOptions()                          */
 /************************************************************************/
@@ -1996,6 +2082,14 @@ void *CPLHTTPSetOptions(void *pcurl, const char *pszURL,
     unchecked_curl_easy_setopt(http_handle, CURLOPT_TCP_NODELAY,
                                atoi(pszTCPNoDelay));
 
+    if (CPLTestBool(CPLGetConfigOption("GDAL_HTTP_SHARE_CACHES", "YES")))
+    {
+        CURLSH *hShareHandle = CPLHTTPGetShareHandle();
+        if (hShareHandle)
+            unchecked_curl_easy_setopt(http_handle, CURLOPT_SHARE,
+                                       hShareHandle);
+    }
+
     /* Support control over HTTPAUTH */
     const char *pszHttpAuth = CSLFetchNameValue(papszOptions, "HTTPAUTH");
     if (pszHttpAuth == nullptr)
@@ -2560,6 +2654,12 @@ void CPLHTTPCleanup()
             delete poSessionMultiMap;
             poSessionMultiMap = nullptr;
         }
+        // This fails if easy handles still use the share handle, in which
+        // case it is better to leak it.
+        if (ghShareHandle)
+            curl_share_cleanup(ghShareHandle);
+        ghShareHandle = nullptr;
+        gbShareHandleInitialized = false;
     }
 
     // Not quite a safe sequence.
@@ -32,6 +32,7 @@
 #include <ctype.h>   // isdigit...
 #include <stdio.h>   // snprintf
 #include <string.h>  // strlen
+#include <algorithm>
 #include <vector>
 #include <string>
 
@@ -117,6 +118,20 @@ void CPLJSonStreamingParser::AdvanceChar(const char *&pStr, size_t &nLength)
     m_nCharCounter++;
 }
 
+/************************************************************************/
+/*                            AdvanceChars()                            */
+/************************************************************************/
+
+/* Advance by nCount characters, none of them being a new line character */
+void CPLJSonStreamingParser::AdvanceChars(const char *&pStr, size_t &nLength,
+                                          size_t nCount)
+{
+    m_nLastChar = pStr[nCount - 1];
+    pStr += nCount;
+    nLength -= nCount;
+    m_nCharCounter += static_cast<int>(nCount);
+}
+
 /************************************************************************/
 /*                               SkipSpace()                            */
 /************************************************************************/
@@ -174,6 +189,26 @@ static bool IsValidNewToken(char ch)
            ch == 'I' || ch == 'N';
 }
 
+/************************************************************************/
+/*                          IsSimpleStringChar()                        */
+/************************************************************************/
+
+/* Whether the character can be copied as such in a string token */
+static inline bool IsSimpleStringChar(char ch)
+{
+    return ch != '"' && ch != '\\' && ch != 10 && ch != 13;
+}
+
+/************************************************************************/
+/*                          IsSimpleNumberChar()                        */
+/************************************************************************/
+
+static inline bool IsSimpleNumberChar(char ch)
+{
+    return (ch >= '0' && ch <= '9') || ch == '.' || ch == '-' || ch == '+' ||
+           ch == 'e' || ch == 'E';
+}
+
 /************************************************************************/
 /*                             StartNewToken()                          */
 /************************************************************************/
@@ -456,6 +491,22 @@ bool CPLJSonStreamingParser::Parse(const char *pStr, size_t nLength,
         {
             while (nLength)
             {
+                // Fast path: append in one go the run of characters that can
+                // be part of a regular number.
+                {
+                    const size_t nMaxRun =
+                        std::min(nLength, 1024 - m_osToken.size());
+                    size_t nRun = 0;
+                    while (nRun < nMaxRun && IsSimpleNumberChar(pStr[nRun]))
+                        ++nRun;
+                    if (nRun > 0)
+                    {
+                        m_osToken.append(pStr, nRun);
+                        AdvanceChars(pStr, nLength, nRun);
+                        continue;
+                    }
+                }
+
                 char ch = *pStr;
                 if (ch == '+' || ch == '-' || isdigit(ch) || ch == '.' ||
                     ch == 'e' || ch == 'E')
@@ -546,6 +597,23 @@ bool CPLJSonStreamingParser::Parse(const char *pStr, size_t nLength,
                     return EmitException("Too many characters in number");
                 }
 
+                // Fast path: append in one go the run of characters that need
+                // no special processing.
+                if (!m_bInUnicode && !m_bInStringEscape)
+                {
+                    const size_t nMaxRun =
+                        std::min(nLength, m_nMaxStringSize - m_osToken.size());
+                    size_t nRun = 0;
+                    while (nRun < nMaxRun && IsSimpleStringChar(pStr[nRun]))
+                        ++nRun;
+                    if (nRun > 0)
+                    {
+                        m_osToken.append(pStr, nRun);
+                        AdvanceChars(pStr, nLength, nRun);
+                        continue;
+                    }
+                }
+
                 char ch = *pStr;
                 if (m_bInUnicode)
                 {
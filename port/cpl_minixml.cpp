@@ -47,6 +47,8 @@
 #include <cstring>
 
 #include <algorithm>
+#include <new>
+#include <string>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -185,6 +187,54 @@ static CPL_INLINE bool _AddToToken(ParseContext *psContext, char chNewChar)
     if (!_AddToToken(psContext, chNewChar))                                    \
         goto fail;
 
+/************************************************************************/
+/*                          AddRunToToken()                             */
+/************************************************************************/
+
+/* Append to the token, in one go, the next nLen input characters. */
+static bool AddRunToToken(ParseContext *psContext, size_t nLen)
+
+{
+    const char *pszStart = psContext->pszInput + psContext->nInputOffset;
+    if (nLen == 0)
+        return true;
+
+    while (psContext->nTokenSize + nLen + 1 > psContext->nTokenMaxSize)
+    {
+        if (!ReallocToken(psContext))
+            return false;
+    }
+    memcpy(psContext->pszToken + psContext->nTokenSize, pszStart, nLen);
+    psContext->nTokenSize += nLen;
+    psContext->pszToken[psContext->nTokenSize] = '\0';
+
+    psContext->nInputLine +=
+        static_cast<int>(std::count(pszStart, pszStart + nLen, '\n'));
+    psContext->nInputOffset += static_cast<int>(nLen);
+    return true;
+}
+
+/* Append to the token the input characters up to (but excluding) the first
+ * one that is in pszStopChars, or the end of input. */
+static bool AddRunToToken(ParseContext *psContext, const char *pszStopChars)
+
+{
+    return AddRunToToken(
+        psContext,
+        strcspn(psContext->pszInput + psContext->nInputOffset, pszStopChars));
+}
+
+/************************************************************************/
+/*                            IsNameChar()                              */
+/************************************************************************/
+
+static CPL_INLINE bool IsNameChar(char ch)
+{
+    return (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') ||
+           ch == '-' || ch == '_' || ch == '.' || ch == ':' ||
+           (ch >= '0' && ch <= '9');
+}
+
 /************************************************************************/
 /*                             ReadToken()                              */
 /************************************************************************/
@@ -384,8 +434,9 @@ static XMLTokenType ReadToken(ParseContext *psContext, CPLErr &eLastErrorType)
     {
         psContext->eTokenType = TString;
 
-        while ((chNext = ReadChar(psContext)) != '"' && chNext != '\0')
-            AddToToken(psContext, chNext);
+        if (!AddRunToToken(psContext, "\""))
+            goto fail;
+        chNext = ReadChar(psContext);
 
         if (chNext != '"')
         {
@@ -412,8 +463,9 @@ static XMLTokenType ReadToken(ParseContext *psContext, CPLErr &eLastErrorType)
     {
         psContext->eTokenType = TString;
 
-        while ((chNext = ReadChar(psContext)) != '\'' && chNext != '\0')
-            AddToToken(psContext, chNext);
+        if (!AddRunToToken(psContext, "'"))
+            goto fail;
+        chNext = ReadChar(psContext);
 
         if (chNext != '\'')
         {
@@ -445,9 +497,8 @@ static XMLTokenType ReadToken(ParseContext *psContext, CPLErr &eLastErrorType)
         psContext->eTokenType = TString;
 
         AddToToken(psContext, chNext);
-        while ((chNext = ReadChar(psContext)) != '<' && chNext != '\0')
-            AddToToken(psContext, chNext);
-        UnreadChar(psContext, chNext);
+        if (!AddRunToToken(psContext, "<"))
+            goto fail;
 
         // Do we need to unescape it?
         if (strchr(psContext->pszToken, '&') != nullptr)
@@ -472,17 +523,12 @@ static XMLTokenType ReadToken(ParseContext *psContext, CPLErr &eLastErrorType)
         // Add the first character to the token regardless of what it is.
         AddToToken(psContext, chNext);
 
-        for (chNext = ReadChar(psContext);
-             (chNext >= 'A' && chNext <= 'Z') ||
-             (chNext >= 'a' && chNext <= 'z') || chNext == '-' ||
-             chNext == '_' || chNext == '.' || chNext == ':' ||
-             (chNext >= '0' && chNext <= '9');
-             chNext = ReadChar(psContext))
-        {
-            AddToToken(psContext, chNext);
-        }
-
-        UnreadChar(psContext, chNext);
+        const char *pszStart = psContext->pszInput + psContext->nInputOffset;
+        size_t nLen = 0;
+        while (IsNameChar(pszStart[nLen]))
+            ++nLen;
+        if (!AddRunToToken(psContext, nLen))
+            goto fail;
     }
 
     return psContext->eTokenType;
@@ -1014,66 +1060,57 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
 }
 
 /************************************************************************/
-/*                            _GrowBuffer()                             */
+/*                        AppendXMLEscaped()                            */
 /************************************************************************/
 
-static bool _GrowBuffer(size_t nNeeded, char **ppszText, size_t *pnMaxLength)
-
+/* Append pszValue escaped with CPLEscapeString(nScheme) to osText, but
+ * without going through a temporary allocation in the common case where
+ * no character needs to be escaped. */
+static void AppendXMLEscaped(std::string &osText, const char *pszValue,
+                             int nScheme)
 {
-    if (nNeeded + 1 >= *pnMaxLength)
+    const char *pszIter = pszValue;
+    for (; *pszIter; ++pszIter)
     {
-        *pnMaxLength = std::max(*pnMaxLength * 2, nNeeded + 1);
-        char *pszTextNew =
-            static_cast<char *>(VSIRealloc(*ppszText, *pnMaxLength));
-        if (pszTextNew == nullptr)
-            return false;
-        *ppszText = pszTextNew;
+        const unsigned char ch = static_cast<unsigned char>(*pszIter);
+        if (ch == '<' || ch == '>' || ch == '&' ||
+            (ch == '"' && nScheme != CPLES_XML_BUT_QUOTES) || ch == 0xEF ||
+            (ch < 0x20 && ch != 0x9 && ch != 0xA && ch != 0xD))
+        {
+            break;
+        }
+    }
+    if (*pszIter == '\0')
+    {
+        osText.append(pszValue, pszIter - pszValue);
+    }
+    else
+    {
+        char *pszEscaped = CPLEscapeString(pszValue, -1, nScheme);
+        osText += pszEscaped;
+        CPLFree(pszEscaped);
     }
-    return true;
 }
 
 /************************************************************************/
 /*                        CPLSerializeXMLNode()                         */
 /************************************************************************/
 
-// TODO(schwehr): Rewrite this whole thing using C++ string.
-// CPLSerializeXMLNode has buffer overflows.
-static bool CPLSerializeXMLNode(const CPLXMLNode *psNode, int nIndent,
-                                char **ppszText, size_t *pnLength,
-                                size_t *pnMaxLength)
+static void CPLSerializeXMLNode(const CPLXMLNode *psNode, int nIndent,
+                                std::string &osText)
 
 {
     if (psNode == nullptr)
-        return true;
-
-    /* -------------------------------------------------------------------- */
-    /*      Ensure the buffer is plenty large to hold this additional       */
-    /*      string.                                                         */
-    /* -------------------------------------------------------------------- */
-    *pnLength += strlen(*ppszText + *pnLength);
-    if (!_GrowBuffer(strlen(psNode->pszValue) + *pnLength + 40 + nIndent,
-                     ppszText, pnMaxLength))
-        return false;
+        return;
 
     /* -------------------------------------------------------------------- */
     /*      Text is just directly emitted.                                  */
     /* -------------------------------------------------------------------- */
     if (psNode->eType == CXT_Text)
     {
-        char *pszEscaped =
-            CPLEscapeString(psNode->pszValue, -1, CPLES_XML_BUT_QUOTES);
-
         CPLAssert(psNode->psChild == nullptr);
 
-        // Escaped text might be bigger than expected.
-        if (!_GrowBuffer(strlen(pszEscaped) + *pnLength, ppszText, pnMaxLength))
-        {
-            CPLFree(pszEscaped);
-            return false;
-        }
-        strcat(*ppszText + *pnLength, pszEscaped);
-
-        CPLFree(pszEscaped);
+        AppendXMLEscaped(osText, psNode->pszValue, CPLES_XML_BUT_QUOTES);
     }
 
     /* -------------------------------------------------------------------- */
@@ -1084,26 +1121,11 @@ static bool CPLSerializeXMLNode(const CPLXMLNode *psNode, int nIndent,
         CPLAssert(psNode->psChild != nullptr &&
                   psNode->psChild->eType == CXT_Text);
 
-        snprintf(*ppszText + *pnLength, *pnMaxLength - *pnLength, " %s=\"",
-                 psNode->pszValue);
-        *pnLength += strlen(*ppszText + *pnLength);
-
-        char *pszEscaped =
-            CPLEscapeString(psNode->psChild->pszValue, -1, CPLES_XML);
-
-        if (!_GrowBuffer(strlen(pszEscaped) + *pnLength, ppszText, pnMaxLength))
-        {
-            CPLFree(pszEscaped);
-            return false;
-        }
-        strcat(*ppszText + *pnLength, pszEscaped);
-
-        CPLFree(pszEscaped);
-
-        *pnLength += strlen(*ppszText + *pnLength);
-        if (!_GrowBuffer(3 + *pnLength, ppszText, pnMaxLength))
-            return false;
-        strcat(*ppszText + *pnLength, "\"");
+        osText += ' ';
+        osText += psNode->pszValue;
+        osText += "=\"";
+        AppendXMLEscaped(osText, psNode->psChild->pszValue, CPLES_XML);
+        osText += '"';
     }
 
     /* -------------------------------------------------------------------- */
@@ -1113,11 +1135,10 @@ static bool CPLSerializeXMLNode(const CPLXMLNode *psNode, int nIndent,
     {
         CPLAssert(psNode->psChild == nullptr);
 
-        for (int i = 0; i < nIndent; i++)
-            (*ppszText)[(*pnLength)++] = ' ';
-
-        snprintf(*ppszText + *pnLength, *pnMaxLength - *pnLength, "<!--%s-->\n",
-                 psNode->pszValue);
+        osText.append(nIndent, ' ');
+        osText += "<!--";
+        osText += psNode->pszValue;
+        osText += "-->\n";
     }
 
     /* -------------------------------------------------------------------- */
@@ -1127,11 +1148,9 @@ static bool CPLSerializeXMLNode(const CPLXMLNode *psNode, int nIndent,
     {
         CPLAssert(psNode->psChild == nullptr);
 
-        for (int i = 0; i < nIndent; i++)
-            (*ppszText)[(*pnLength)++] = ' ';
-
-        strcpy(*ppszText + *pnLength, psNode->pszValue);
-        strcat(*ppszText + *pnLength, "\n");
+        osText.append(nIndent, ' ');
+        osText += psNode->pszValue;
+        osText += '\n';
     }
 
     /* -------------------------------------------------------------------- */
@@ -1140,13 +1159,9 @@ static bool CPLSerializeXMLNode(const CPLXMLNode *psNode, int nIndent,
     /* -------------------------------------------------------------------- */
     else if (psNode->eType == CXT_Element)
     {
-        if (nIndent)
-            memset(*ppszText + *pnLength, ' ', nIndent);
-        *pnLength += nIndent;
-        (*ppszText)[*pnLength] = '\0';
-
-        snprintf(*ppszText + *pnLength, *pnMaxLength - *pnLength, "<%s",
-                 psNode->pszValue);
+        osText.append(nIndent, ' ');
+        osText += '<';
+        osText += psNode->pszValue;
 
         if (psNode->pszValue[0] == '?')
         {
@@ -1154,23 +1169,11 @@ static bool CPLSerializeXMLNode(const CPLXMLNode *psNode, int nIndent,
                  psChild != nullptr; psChild = psChild->psNext)
             {
                 if (psChild->eType == CXT_Text)
-                {
-                    *pnLength += strlen(*ppszText + *pnLength);
-                    if (!_GrowBuffer(1 + *pnLength, ppszText, pnMaxLength))
-                        return false;
-                    strcat(*ppszText + *pnLength, " ");
-                }
+                    osText += ' ';
 
-                if (!CPLSerializeXMLNode(psChild, 0, ppszText, pnLength,
-                                         pnMaxLength))
-                {
-                    return false;
-                }
+                CPLSerializeXMLNode(psChild, 0, osText);
             }
-            if (!_GrowBuffer(*pnLength + 40, ppszText, pnMaxLength))
-                return false;
-
-            strcat(*ppszText + *pnLength, "?>\n");
+            osText += "?>\n";
         }
         else
         {
@@ -1180,27 +1183,20 @@ static bool CPLSerializeXMLNode(const CPLXMLNode *psNode, int nIndent,
                  psChild != nullptr; psChild = psChild->psNext)
             {
                 if (psChild->eType == CXT_Attribute)
-                {
-                    if (!CPLSerializeXMLNode(psChild, 0, ppszText, pnLength,
-                                             pnMaxLength))
-                        return false;
-                }
+                    CPLSerializeXMLNode(psChild, 0, osText);
                 else
                     bHasNonAttributeChildren = true;
             }
 
             if (!bHasNonAttributeChildren)
             {
-                if (!_GrowBuffer(*pnLength + 40, ppszText, pnMaxLength))
-                    return false;
-
-                strcat(*ppszText + *pnLength, " />\n");
+                osText += " />\n";
             }
             else
             {
                 bool bJustText = true;
 
-                strcat(*ppszText + *pnLength, ">");
+                osText += '>';
 
                 for (const CPLXMLNode *psChild = psNode->psChild;
                      psChild != nullptr; psChild = psChild->psNext)
@@ -1211,39 +1207,21 @@ static bool CPLSerializeXMLNode(const CPLXMLNode *psNode, int nIndent,
                     if (psChild->eType != CXT_Text && bJustText)
                     {
                         bJustText = false;
-                        *pnLength += strlen(*ppszText + *pnLength);
-                        if (!_GrowBuffer(1 + *pnLength, ppszText, pnMaxLength))
-                            return false;
-                        strcat(*ppszText + *pnLength, "\n");
+                        osText += '\n';
                     }
 
-                    if (!CPLSerializeXMLNode(psChild, nIndent + 2, ppszText,
-                                             pnLength, pnMaxLength))
-                        return false;
+                    CPLSerializeXMLNode(psChild, nIndent + 2, osText);
                 }
 
-                *pnLength += strlen(*ppszText + *pnLength);
-                if (!_GrowBuffer(strlen(psNode->pszValue) + *pnLength + 40 +
-                                     nIndent,
-                                 ppszText, pnMaxLength))
-                    return false;
-
                 if (!bJustText)
-                {
-                    if (nIndent)
-                        memset(*ppszText + *pnLength, ' ', nIndent);
-                    *pnLength += nIndent;
-                    (*ppszText)[*pnLength] = '\0';
-                }
+                    osText.append(nIndent, ' ');
 
-                *pnLength += strlen(*ppszText + *pnLength);
-                snprintf(*ppszText + *pnLength, *pnMaxLength - *pnLength,
-                         "</%s>\n", psNode->pszValue);
+                osText += "</";
+                osText += psNode->pszValue;
+                osText += ">\n";
             }
         }
     }
-
-    return true;
 }
 
 /************************************************************************/
@@ -1267,23 +1245,23 @@ static bool CPLSerializeXMLNode(const CPLXMLNode *psNode, int nIndent,
 char *CPLSerializeXMLTree(const CPLXMLNode *psNode)
 
 {
-    size_t nMaxLength = 100;
-    char *pszText = static_cast<char *>(CPLCalloc(nMaxLength, sizeof(char)));
-    if (pszText == nullptr)
-        return nullptr;
-
-    size_t nLength = 0;
-    for (const CPLXMLNode *psThis = psNode; psThis != nullptr;
-         psThis = psThis->psNext)
+    std::string osText;
+    try
     {
-        if (!CPLSerializeXMLNode(psThis, 0, &pszText, &nLength, &nMaxLength))
+        for (const CPLXMLNode *psThis = psNode; psThis != nullptr;
+             psThis = psThis->psNext)
         {
-            VSIFree(pszText);
-            return nullptr;
+            CPLSerializeXMLNode(psThis, 0, osText);
         }
     }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in CPLSerializeXMLTree()");
+        return nullptr;
+    }
 
-    return pszText;
+    return VSI_STRDUP_VERBOSE(osText.c_str());
 }
 
 /************************************************************************/
@@ -113,6 +113,9 @@ const char CPL_DLL *CPLGetThreadingModel(void);
 
 int CPL_DLL CPLGetNumCPUs(void);
 
+void CPL_DLL CPLSetMaxConcurrentJobs(int nMaxJobs);
+int CPL_DLL CPLGetMaxConcurrentJobs(void);
+
 typedef struct _CPLLock CPLLock;
 
 /* Currently LOCK_ADAPTIVE_MUTEX is Linux-only and LOCK_SPIN only available */
@@ -238,6 +241,7 @@ class CPL_DLL CPLLockHolder
 #define CTLS_PROJCONTEXTHOLDER 18      /* ogr_proj_p.cpp */
 #define CTLS_GDALDEFAULTOVR_ANTIREC 19 /* gdaldefaultoverviews.cpp */
 #define CTLS_HTTPFETCHCALLBACK 20      /* cpl_http.cpp */
+#define CTLS_CONFIGOPTIONSSNAPSHOT 21  /* cpl_conv.cpp */
 
 #define CTLS_MAX 32
 
@@ -0,0 +1,134 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Hooks to report tracing spans to an external tracer.
+ * Author:   Even Rouault <even dot rouault at spatialys.com>
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, Even Rouault <even dot rouault at spatialys.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_trace.h"
+#include "cpl_multiproc.h"
+
+#include <atomic>
+#include <mutex>
+
+static std::atomic<bool> gbTraceSpanEnabled{false};
+static std::mutex goTraceSpanMutex;
+static CPLTraceSpanBeginFunc gpfnTraceSpanBegin = nullptr;
+static CPLTraceSpanEndFunc gpfnTraceSpanEnd = nullptr;
+static void *gpTraceSpanUserData = nullptr;
+
+/************************************************************************/
+/*                        CPLSetTraceSpanHooks()                        */
+/************************************************************************/
+
+/**
+ * \brief Install the callbacks called when tracing spans begin and end.
+ *
+ * The callbacks may be called concurrently from several threads. The spans
+ * which began before the callbacks are changed end with the previous end
+ * callback.
+ *
+ * @param pfnBegin callback called when a span begins, or NULL to disable
+ * tracing.
+ * @param pfnEnd callback called when a span ends, or NULL to disable
+ * tracing.
+ * @param pUserData user data passed to the callbacks.
+ * @since GDAL 3.9
+ */
+void CPLSetTraceSpanHooks(CPLTraceSpanBeginFunc pfnBegin,
+                          CPLTraceSpanEndFunc pfnEnd, void *pUserData)
+{
+    std::lock_guard<std::mutex> oLock(goTraceSpanMutex);
+    gpfnTraceSpanBegin = pfnBegin;
+    gpfnTraceSpanEnd = pfnEnd;
+    gpTraceSpanUserData = pUserData;
+    gbTraceSpanEnabled = pfnBegin != nullptr && pfnEnd != nullptr;
+}
+
+/************************************************************************/
+/*                       CPLIsTraceSpanEnabled()                        */
+/************************************************************************/
+
+/**
+ * \brief Return whether tracing hooks are installed.
+ *
+ * @since GDAL 3.9
+ */
+int CPLIsTraceSpanEnabled(void)
+{
+    return gbTraceSpanEnabled.load(std::memory_order_relaxed);
+}
+
+/************************************************************************/
+/*                        CPLTraceSpan::Begin()                         */
+/************************************************************************/
+
+void CPLTraceSpan::Begin(const char *pszName)
+{
+    CPLTraceSpanBeginFunc pfnBegin;
+    {
+        std::lock_guard<std::mutex> oLock(goTraceSpanMutex);
+        pfnBegin = gpfnTraceSpanBegin;
+        m_pfnEnd = gpfnTraceSpanEnd;
+        m_pUserData = gpTraceSpanUserData;
+    }
+    if (pfnBegin == nullptr || m_pfnEnd == nullptr)
+        return;
+
+    m_bEnabled = true;
+    m_pSpan = pfnBegin(m_pUserData, pszName, CPLGetPID());
+}
+
+/************************************************************************/
+/*                         CPLTraceSpan::End()                          */
+/************************************************************************/
+
+void CPLTraceSpan::End()
+{
+    m_pfnEnd(m_pUserData, m_pSpan, m_aosAttributes.List());
+}
+
+/************************************************************************/
+/*                     CPLTraceSpan::SetAttribute()                     */
+/************************************************************************/
+
+/** Set a string attribute of the span.
+ * @param pszName attribute name.
+ * @param pszValue attribute value.
+ */
+void CPLTraceSpan::SetAttribute(const char *pszName, const char *pszValue)
+{
+    if (m_bEnabled && pszValue != nullptr)
+        m_aosAttributes.SetNameValue(pszName, pszValue);
+}
+
+/** Set an integer attribute of the span.
+ * @param pszName attribute name.
+ * @param nValue attribute value.
+ */
+void CPLTraceSpan::SetAttribute(const char *pszName, GIntBig nValue)
+{
+    if (m_bEnabled)
+        m_aosAttributes.SetNameValue(pszName, CPLSPrintf(CPL_FRMT_GIB, nValue));
+}
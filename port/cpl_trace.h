@@ -0,0 +1,138 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Hooks to report tracing spans to an external tracer.
+ * Author:   Even Rouault <even dot rouault at spatialys.com>
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, Even Rouault <even dot rouault at spatialys.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef CPL_TRACE_H_INCLUDED
+#define CPL_TRACE_H_INCLUDED
+
+#include "cpl_port.h"
+
+/**
+ * \file cpl_trace.h
+ *
+ * Hooks to report the time spent in operations of GDAL (dataset opening,
+ * RasterIO() requests, block reading, HTTP requests, warping, ...) as spans
+ * to an external tracer, for example an OpenTelemetry one.
+ *
+ * A span begins and ends in the same thread, and the spans of a thread are
+ * properly nested, so a tracer may consider that a span is the child of the
+ * last span that began and has not ended yet in the same thread.
+ *
+ * When no hooks are installed, the cost of tracing is a check of a global
+ * flag per operation.
+ *
+ * @since GDAL 3.9
+ */
+
+CPL_C_START
+
+/** Callback called when a span begins.
+ *
+ * @param pUserData user data passed to CPLSetTraceSpanHooks().
+ * @param pszName name of the operation, such as "GDALOpenEx" or
+ * "GDALRasterBand::ReadBlock".
+ * @param nThreadId identifier of the calling thread, as returned by
+ * CPLGetPID().
+ * @return an opaque span handle, passed to the CPLTraceSpanEndFunc callback.
+ * @since GDAL 3.9
+ */
+typedef void *(*CPLTraceSpanBeginFunc)(void *pUserData, const char *pszName,
+                                       GIntBig nThreadId);
+
+/** Callback called when a span ends.
+ *
+ * @param pUserData user data passed to CPLSetTraceSpanHooks().
+ * @param pSpan the span handle returned by the CPLTraceSpanBeginFunc
+ * callback.
+ * @param papszAttributes attributes of the span, as a NULL terminated list
+ * of NAME=VALUE strings (may be NULL). For example "filename", "driver",
+ * "bytes" or "http_code".
+ * @since GDAL 3.9
+ */
+typedef void (*CPLTraceSpanEndFunc)(void *pUserData, void *pSpan,
+                                    CSLConstList papszAttributes);
+
+void CPL_DLL CPLSetTraceSpanHooks(CPLTraceSpanBeginFunc pfnBegin,
+                                  CPLTraceSpanEndFunc pfnEnd,
+                                  void *pUserData);
+int CPL_DLL CPLIsTraceSpanEnabled(void);
+
+CPL_C_END
+
+#if defined(__cplusplus) && !defined(CPL_SUPRESS_CPLUSPLUS)
+
+#include "cpl_string.h"
+
+/** RAII helper reporting a span from its construction to its destruction.
+ *
+ * Attributes are only formatted if a tracer is installed.
+ *
+ * @since GDAL 3.9
+ */
+class CPL_DLL CPLTraceSpan
+{
+    bool m_bEnabled = false;
+    void *m_pSpan = nullptr;
+    CPLTraceSpanEndFunc m_pfnEnd = nullptr;
+    void *m_pUserData = nullptr;
+    CPLStringList m_aosAttributes{};
+
+    void Begin(const char *pszName);
+    void End();
+
+    CPL_DISALLOW_COPY_ASSIGN(CPLTraceSpan)
+
+  public:
+    /** Begin a span, if a tracer is installed.
+     * @param pszName name of the operation.
+     */
+    explicit CPLTraceSpan(const char *pszName)
+    {
+        if (CPLIsTraceSpanEnabled())
+            Begin(pszName);
+    }
+
+    /** End the span. */
+    ~CPLTraceSpan()
+    {
+        if (m_bEnabled)
+            End();
+    }
+
+    /** Return whether the span is reported to a tracer. */
+    inline bool IsEnabled() const
+    {
+        return m_bEnabled;
+    }
+
+    void SetAttribute(const char *pszName, const char *pszValue);
+    void SetAttribute(const char *pszName, GIntBig nValue);
+};
+
+#endif /* __cplusplus */
+
+#endif /* ndef CPL_TRACE_H_INCLUDED */
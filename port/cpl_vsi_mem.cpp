@@ -77,7 +77,11 @@
 ** access and update of the oFileList array which has all the "files" in
 ** the memory filesystem area.  It is expected that multiple threads would
 ** want to create and read different files at the same time and so might
-** collide access oFileList without the mutex.
+** collide access oFileList without the mutex. The mutex is a shared one:
+** lookups (Open() of an existing file, Stat(), ReadDir()) take it in shared
+** mode and can run concurrently, while operations that modify oFileList
+** take it in exclusive mode. It is not recursive, so it must not be held
+** while calling back into the VSI layer (e.g. VSIMkdirRecursive()).
 **
 ** VSIMemFile: A mutex protects accesses to the file
 **
@@ -156,6 +160,9 @@ class VSIMemHandle final : public VSIVirtualHandle
     }
     size_t PRead(void * /*pBuffer*/, size_t /* nSize */,
                  vsi_l_offset /*nOffset*/) const override;
+
+    std::shared_ptr<const GByte> MapRegion(vsi_l_offset nOffset,
+                                           size_t nSize) override;
 };
 
 /************************************************************************/
@@ -171,7 +178,7 @@ class VSIMemFilesystemHandler final : public VSIFilesystemHandler
 
   public:
     std::map<CPLString, std::shared_ptr<VSIMemFile>> oFileList{};
-    CPLMutex *hMutex = nullptr;
+    CPL_SHARED_MUTEX_TYPE m_oMutex{};
 
     explicit VSIMemFilesystemHandler(const char *pszPrefix)
         : m_osPrefix(pszPrefix)
@@ -446,6 +453,25 @@ size_t VSIMemHandle::PRead(void *pBuffer, size_t nSize,
     return 0;
 }
 
+/************************************************************************/
+/*                             MapRegion()                              */
+/************************************************************************/
+
+std::shared_ptr<const GByte> VSIMemHandle::MapRegion(vsi_l_offset nOffset,
+                                                     size_t nSize)
+{
+    CPL_SHARED_LOCK oLock(poFile->m_oMutex);
+
+    // A write could reallocate the buffer
+    if (bUpdate || nOffset > poFile->nLength ||
+        nSize > poFile->nLength - nOffset)
+        return nullptr;
+
+    // The returned object keeps the file, and thus its buffer, alive
+    return std::shared_ptr<const GByte>(
+        poFile, poFile->pabyData + static_cast<size_t>(nOffset));
+}
+
 /************************************************************************/
 /*                               Write()                                */
 /************************************************************************/
@@ -541,10 +567,6 @@ VSIMemFilesystemHandler::~VSIMemFilesystemHandler()
 
 {
     oFileList.clear();
-
-    if (hMutex != nullptr)
-        CPLDestroyMutex(hMutex);
-    hMutex = nullptr;
 }
 
 /************************************************************************/
@@ -557,7 +579,6 @@ VSIVirtualHandle *VSIMemFilesystemHandler::Open(const char *pszFilename,
                                                 CSLConstList /* papszOptions */)
 
 {
-    CPLMutexHolder oHolder(&hMutex);
     const CPLString osFilename = NormalizePath(pszFilename);
     if (osFilename.empty())
         return nullptr;
@@ -574,9 +595,11 @@ VSIVirtualHandle *VSIMemFilesystemHandler::Open(const char *pszFilename,
     /*      Get the filename we are opening, create if needed.              */
     /* -------------------------------------------------------------------- */
     std::shared_ptr<VSIMemFile> poFile = nullptr;
-    if (oFileList.find(osFilename) != oFileList.end())
     {
-        poFile = oFileList[osFilename];
+        CPL_SHARED_LOCK oLock(m_oMutex);
+        const auto oIter = oFileList.find(osFilename);
+        if (oIter != oFileList.end())
+            poFile = oIter->second;
     }
 
     // If no file and opening in read, error out.
@@ -592,8 +615,11 @@ VSIVirtualHandle *VSIMemFilesystemHandler::Open(const char *pszFilename,
     }
 
     // Create.
+    bool bCreated = false;
     if (poFile == nullptr)
     {
+        // Must be done without holding m_oMutex, as this calls back Stat()
+        // and Mkdir()
         const char *pszFileDir = CPLGetPath(osFilename.c_str());
         if (VSIMkdirRecursive(pszFileDir, 0755) == -1)
         {
@@ -607,17 +633,24 @@ VSIVirtualHandle *VSIMemFilesystemHandler::Open(const char *pszFilename,
             return nullptr;
         }
 
-        poFile = std::make_shared<VSIMemFile>();
-        poFile->osFilename = osFilename;
-        oFileList[poFile->osFilename] = poFile;
+        CPL_EXCLUSIVE_LOCK oLock(m_oMutex);
+        // The file might have been created by another thread in the meantime
+        auto &poFileInList = oFileList[osFilename];
+        if (poFileInList == nullptr)
+        {
+            poFileInList = std::make_shared<VSIMemFile>();
+            poFileInList->osFilename = osFilename;
+            poFileInList->nMaxLength = nMaxLength;
+            bCreated = true;
+        }
+        poFile = poFileInList;
 #ifdef DEBUG_VERBOSE
         CPLDebug("VSIMEM", "Creating file %s: ref_count=%d", pszFilename,
                  static_cast<int>(poFile.use_count()));
 #endif
-        poFile->nMaxLength = nMaxLength;
     }
     // Overwrite
-    else if (strstr(pszAccess, "w"))
+    if (!bCreated && strstr(pszAccess, "w"))
     {
         CPL_EXCLUSIVE_LOCK oLock(poFile->m_oMutex);
         poFile->SetLength(0);
@@ -662,8 +695,6 @@ int VSIMemFilesystemHandler::Stat(const char *pszFilename,
                                   VSIStatBufL *pStatBuf, int /* nFlags */)
 
 {
-    CPLMutexHolder oHolder(&hMutex);
-
     const CPLString osFilename = NormalizePath(pszFilename);
 
     memset(pStatBuf, 0, sizeof(VSIStatBufL));
@@ -675,17 +706,18 @@ int VSIMemFilesystemHandler::Stat(const char *pszFilename,
         return 0;
     }
 
-    auto oIter = oFileList.find(osFilename);
-    if (oIter == oFileList.end())
+    std::shared_ptr<VSIMemFile> poFile;
     {
-        errno = ENOENT;
-        return -1;
+        CPL_SHARED_LOCK oLock(m_oMutex);
+        const auto oIter = oFileList.find(osFilename);
+        if (oIter == oFileList.end())
+        {
+            errno = ENOENT;
+            return -1;
+        }
+        poFile = oIter->second;
     }
 
-    std::shared_ptr<VSIMemFile> poFile = oIter->second;
-
-    memset(pStatBuf, 0, sizeof(VSIStatBufL));
-
     CPL_SHARED_LOCK oLock(poFile->m_oMutex);
     if (poFile->bIsDirectory)
     {
@@ -709,7 +741,7 @@ int VSIMemFilesystemHandler::Stat(const char *pszFilename,
 int VSIMemFilesystemHandler::Unlink(const char *pszFilename)
 
 {
-    CPLMutexHolder oHolder(&hMutex);
+    CPL_EXCLUSIVE_LOCK oLock(m_oMutex);
     return Unlink_unlocked(pszFilename);
 }
 
@@ -746,10 +778,10 @@ int VSIMemFilesystemHandler::Unlink_unlocked(const char *pszFilename)
 int VSIMemFilesystemHandler::Mkdir(const char *pszPathname, long /* nMode */)
 
 {
-    CPLMutexHolder oHolder(&hMutex);
-
     const CPLString osPathname = NormalizePath(pszPathname);
 
+    CPL_EXCLUSIVE_LOCK oLock(m_oMutex);
+
     if (oFileList.find(osPathname) != oFileList.end())
     {
         errno = EEXIST;
@@ -784,10 +816,10 @@ int VSIMemFilesystemHandler::Rmdir(const char *pszPathname)
 char **VSIMemFilesystemHandler::ReadDirEx(const char *pszPath, int nMaxFiles)
 
 {
-    CPLMutexHolder oHolder(&hMutex);
-
     const CPLString osPath = NormalizePath(pszPath);
 
+    CPL_SHARED_LOCK oLock(m_oMutex);
+
     char **papszDir = nullptr;
     size_t nPathLen = osPath.size();
 
@@ -838,13 +870,13 @@ int VSIMemFilesystemHandler::Rename(const char *pszOldPath,
                                     const char *pszNewPath)
 
 {
-    CPLMutexHolder oHolder(&hMutex);
-
     const CPLString osOldPath = NormalizePath(pszOldPath);
     const CPLString osNewPath = NormalizePath(pszNewPath);
     if (!STARTS_WITH(pszNewPath, m_osPrefix.c_str()))
         return -1;
 
+    CPL_EXCLUSIVE_LOCK oLock(m_oMutex);
+
     if (osOldPath.compare(osNewPath) == 0)
         return 0;
 
@@ -1041,7 +1073,7 @@ VSILFILE *VSIFileFromMemBuffer(const char *pszFilename, GByte *pabyData,
 
     if (!osFilename.empty())
     {
-        CPLMutexHolder oHolder(&poHandler->hMutex);
+        CPL_EXCLUSIVE_LOCK oLock(poHandler->m_oMutex);
         poHandler->Unlink_unlocked(osFilename);
         poHandler->oFileList[poFile->osFilename] = poFile;
 #ifdef DEBUG_VERBOSE
@@ -1093,12 +1125,13 @@ GByte *VSIGetMemFileBuffer(const char *pszFilename, vsi_l_offset *pnDataLength,
     const CPLString osFilename =
         VSIMemFilesystemHandler::NormalizePath(pszFilename);
 
-    CPLMutexHolder oHolder(&poHandler->hMutex);
+    CPL_EXCLUSIVE_LOCK oLock(poHandler->m_oMutex);
 
-    if (poHandler->oFileList.find(osFilename) == poHandler->oFileList.end())
+    const auto oIter = poHandler->oFileList.find(osFilename);
+    if (oIter == poHandler->oFileList.end())
         return nullptr;
 
-    std::shared_ptr<VSIMemFile> poFile = poHandler->oFileList[osFilename];
+    std::shared_ptr<VSIMemFile> poFile = oIter->second;
     GByte *pabyData = poFile->pabyData;
     if (pnDataLength != nullptr)
         *pnDataLength = poFile->nLength;
@@ -1111,7 +1144,7 @@ GByte *VSIGetMemFileBuffer(const char *pszFilename, vsi_l_offset *pnDataLength,
         else
             poFile->bOwnData = false;
 
-        poHandler->oFileList.erase(poHandler->oFileList.find(osFilename));
+        poHandler->oFileList.erase(oIter);
 #ifdef DEBUG_VERBOSE
         CPLDebug("VSIMEM", "VSIGetMemFileBuffer() %s: ref_count=%d (before)",
                  poFile->osFilename.c_str(),
@@ -39,8 +39,10 @@
 #include "cpl_string.h"
 #include "cpl_multiproc.h"
 
+#include <future>
 #include <map>
 #include <memory>
+#include <set>
 #include <vector>
 #include <string>
 
@@ -112,6 +114,10 @@ struct CPL_DLL VSIVirtualHandle
     virtual bool HasPRead() const;
     virtual size_t PRead(void *pBuffer, size_t nSize,
                          vsi_l_offset nOffset) const;
+    virtual std::future<size_t> ReadAsync(void *pBuffer, size_t nSize,
+                                          vsi_l_offset nOffset);
+    virtual std::shared_ptr<const GByte> MapRegion(vsi_l_offset nOffset,
+                                                   size_t nSize);
 
     // NOTE: when adding new methods, besides the "actual" implementations,
     // also consider the VSICachedFile one.
@@ -402,6 +408,10 @@ class VSIArchiveFilesystemHandler : public VSIFilesystemHandler
     virtual std::vector<CPLString> GetExtensions() = 0;
     virtual VSIArchiveReader *CreateReader(const char *pszArchiveFileName) = 0;
 
+    static void AddEntryToContent(VSIArchiveContent *content,
+                                  std::set<CPLString> &oSet,
+                                  VSIArchiveReader *poReader);
+
   public:
     VSIArchiveFilesystemHandler();
     virtual ~VSIArchiveFilesystemHandler();
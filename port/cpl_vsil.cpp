@@ -56,6 +56,7 @@
 #include "cpl_string.h"
 #include "cpl_vsi_virtual.h"
 #include "cpl_vsil_curl_class.h"
+#include "cpl_worker_thread_pool.h"
 
 // To avoid aliasing to GetDiskFreeSpace to GetDiskFreeSpaceA on Windows
 #ifdef GetDiskFreeSpace
@@ -3294,6 +3295,40 @@ void VSIFileManager::RemoveHandler(const std::string &osPrefix)
         Get()->oHandlers.erase(osPrefix);
 }
 
+/************************************************************************/
+/*                     VSIGetAsyncReadThreadPool()                      */
+/************************************************************************/
+
+// Pool of threads used by the default implementation of
+// VSIVirtualHandle::ReadAsync()
+static std::mutex goAsyncReadThreadPoolMutex;
+static std::unique_ptr<CPLWorkerThreadPool> gpoAsyncReadThreadPool;
+
+static CPLWorkerThreadPool *VSIGetAsyncReadThreadPool()
+{
+    std::lock_guard<std::mutex> oLock(goAsyncReadThreadPoolMutex);
+    if (!gpoAsyncReadThreadPool)
+    {
+        const int nThreads = std::max(
+            1, atoi(CPLGetConfigOption("VSI_ASYNC_READ_NUM_THREADS", "8")));
+        auto poPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!poPool->Setup(nThreads, nullptr, nullptr))
+            return nullptr;
+        gpoAsyncReadThreadPool = std::move(poPool);
+    }
+    return gpoAsyncReadThreadPool.get();
+}
+
+/************************************************************************/
+/*                   VSIDestroyAsyncReadThreadPool()                    */
+/************************************************************************/
+
+static void VSIDestroyAsyncReadThreadPool()
+{
+    std::lock_guard<std::mutex> oLock(goAsyncReadThreadPoolMutex);
+    gpoAsyncReadThreadPool.reset();
+}
+
 /************************************************************************/
 /*                       VSICleanupFileManager()                        */
 /************************************************************************/
@@ -3301,6 +3336,8 @@ void VSIFileManager::RemoveHandler(const std::string &osPrefix)
 void VSICleanupFileManager()
 
 {
+    VSIDestroyAsyncReadThreadPool();
+
     if (poManager)
     {
         delete poManager;
@@ -3424,3 +3461,107 @@ size_t VSIVirtualHandle::PRead(CPL_UNUSED void *pBuffer,
 {
     return 0;
 }
+
+/************************************************************************/
+/*                             ReadAsync()                              */
+/************************************************************************/
+
+/** Start an asynchronous read operation.
+ *
+ * This methods reads into pBuffer up to nSize bytes starting at offset nOffset
+ * in the file, and returns a future that holds the number of bytes read
+ * once the read is completed. The current file offset is not affected by
+ * this method. This allows the caller to overlap I/O with processing, or to
+ * have several reads in flight.
+ *
+ * The default implementation runs PRead() in a pool of worker threads, whose
+ * size is set by the VSI_ASYNC_READ_NUM_THREADS configuration option (8 by
+ * default), when HasPRead() returns true, which is the case for local files,
+ * /vsimem/ and /vsicurl/ related file systems. Otherwise the read is done
+ * synchronously, before this method returns.
+ *
+ * pBuffer must remain valid, and the file handle must not be closed, until
+ * the future is ready.
+ *
+ * @param pBuffer output buffer (must be at least nSize bytes large).
+ * @param nSize   number of bytes to read in the file.
+ * @param nOffset file offset from which to read.
+ * @return a future holding the number of bytes read.
+ * @since GDAL 3.9
+ */
+std::future<size_t> VSIVirtualHandle::ReadAsync(void *pBuffer, size_t nSize,
+                                                vsi_l_offset nOffset)
+{
+    std::promise<size_t> oPromise;
+    auto oFuture = oPromise.get_future();
+
+    if (HasPRead())
+    {
+        if (auto poPool = VSIGetAsyncReadThreadPool())
+        {
+            struct AsyncReadJob
+            {
+                const VSIVirtualHandle *poHandle;
+                void *pBuffer;
+                size_t nSize;
+                vsi_l_offset nOffset;
+                std::promise<size_t> oPromise;
+            };
+
+            auto psJob = new AsyncReadJob{this, pBuffer, nSize, nOffset,
+                                          std::move(oPromise)};
+            const auto JobFunc = [](void *pData)
+            {
+                std::unique_ptr<AsyncReadJob> psJobToRun(
+                    static_cast<AsyncReadJob *>(pData));
+                psJobToRun->oPromise.set_value(psJobToRun->poHandle->PRead(
+                    psJobToRun->pBuffer, psJobToRun->nSize,
+                    psJobToRun->nOffset));
+            };
+            if (poPool->SubmitJob(JobFunc, psJob))
+                return oFuture;
+            oPromise = std::move(psJob->oPromise);
+            delete psJob;
+        }
+        oPromise.set_value(PRead(pBuffer, nSize, nOffset));
+        return oFuture;
+    }
+
+    // Seek() and Read() are not thread-safe, so read synchronously.
+    const vsi_l_offset nCurOffset = Tell();
+    size_t nRet = 0;
+    if (Seek(nOffset, SEEK_SET) == 0)
+        nRet = Read(pBuffer, 1, nSize);
+    Seek(nCurOffset, SEEK_SET);
+    oPromise.set_value(nRet);
+    return oFuture;
+}
+
+/************************************************************************/
+/*                             MapRegion()                              */
+/************************************************************************/
+
+/** Return a read-only view in memory of a region of the file.
+ *
+ * This allows reading the content of the file without a read() call and
+ * a copy in a user buffer. It is implemented for local files opened in
+ * read-only mode (using a memory mapping), /vsimem/ files opened in
+ * read-only mode, and /vsisubfile/ files on top of them.
+ *
+ * The region must be entirely inside the file. The returned pointer remains
+ * valid as long as the returned object, or a copy of it, is alive, even if
+ * the file handle is closed. The content of the view is undefined if the
+ * file is modified or truncated in the meantime.
+ *
+ * @param nOffset file offset of the start of the region.
+ * @param nSize   size in bytes of the region.
+ * @return a pointer to the first byte of the region, or nullptr if the
+ * operation is not supported by the file system or failed.
+ * @since GDAL 3.9
+ */
+std::shared_ptr<const GByte>
+VSIVirtualHandle::MapRegion(CPL_UNUSED vsi_l_offset nOffset,
+                            CPL_UNUSED size_t nSize)
+{
+    return nullptr;
+}
@@ -146,6 +146,91 @@ static CPLString GetStrippedFilename(const CPLString &osFileName, bool &bIsDir)
     return osRet;
 }
 
+/************************************************************************/
+/*                         AddEntryToContent()                          */
+/************************************************************************/
+
+/* Add to content the entry on which poReader is currently positioned, as */
+/* well as its intermediate directories, unless already in oSet. */
+void VSIArchiveFilesystemHandler::AddEntryToContent(
+    VSIArchiveContent *content, std::set<CPLString> &oSet,
+    VSIArchiveReader *poReader)
+{
+    const CPLString osFileName = poReader->GetFileName();
+    bool bIsDir = false;
+    const CPLString osStrippedFilename =
+        GetStrippedFilename(osFileName, bIsDir);
+    if (osStrippedFilename.empty() || osStrippedFilename[0] == '/' ||
+        osStrippedFilename.find("//") != std::string::npos)
+    {
+        return;
+    }
+
+    if (oSet.find(osStrippedFilename) == oSet.end())
+    {
+        oSet.insert(osStrippedFilename);
+
+        // Add intermediate directory structure.
+        const char *pszBegin = osStrippedFilename.c_str();
+        for (const char *pszIter = pszBegin; *pszIter; pszIter++)
+        {
+            if (*pszIter == '/')
+            {
+                char *pszStrippedFileName2 = CPLStrdup(osStrippedFilename);
+                pszStrippedFileName2[pszIter - pszBegin] = 0;
+                if (oSet.find(pszStrippedFileName2) == oSet.end())
+                {
+                    oSet.insert(pszStrippedFileName2);
+
+                    content->entries =
+                        static_cast<VSIArchiveEntry *>(CPLRealloc(
+                            content->entries, sizeof(VSIArchiveEntry) *
+                                                  (content->nEntries + 1)));
+                    content->entries[content->nEntries].fileName =
+                        pszStrippedFileName2;
+                    content->entries[content->nEntries].nModifiedTime =
+                        poReader->GetModifiedTime();
+                    content->entries[content->nEntries].uncompressed_size = 0;
+                    content->entries[content->nEntries].bIsDir = TRUE;
+                    content->entries[content->nEntries].file_pos = nullptr;
+#ifdef DEBUG_VERBOSE
+                    const int nEntries = content->nEntries;
+                    CPLDebug("VSIArchive", "[%d] %s : " CPL_FRMT_GUIB " bytes",
+                             content->nEntries + 1,
+                             content->entries[nEntries].fileName,
+                             content->entries[nEntries].uncompressed_size);
+#endif
+                    content->nEntries++;
+                }
+                else
+                {
+                    CPLFree(pszStrippedFileName2);
+                }
+            }
+        }
+
+        content->entries = static_cast<VSIArchiveEntry *>(
+            CPLRealloc(content->entries,
+                       sizeof(VSIArchiveEntry) * (content->nEntries + 1)));
+        content->entries[content->nEntries].fileName =
+            CPLStrdup(osStrippedFilename);
+        content->entries[content->nEntries].nModifiedTime =
+            poReader->GetModifiedTime();
+        content->entries[content->nEntries].uncompressed_size =
+            poReader->GetFileSize();
+        content->entries[content->nEntries].bIsDir = bIsDir;
+        content->entries[content->nEntries].file_pos =
+            poReader->GetFileOffset();
+#ifdef DEBUG_VERBOSE
+        CPLDebug("VSIArchive", "[%d] %s : " CPL_FRMT_GUIB " bytes",
+                 content->nEntries + 1,
+                 content->entries[content->nEntries].fileName,
+                 content->entries[content->nEntries].uncompressed_size);
+#endif
+        content->nEntries++;
+    }
+}
+
 /************************************************************************/
 /*                       GetContentOfArchive()                          */
 /************************************************************************/
@@ -204,82 +289,7 @@ VSIArchiveFilesystemHandler::GetContentOfArchive(const char *archiveFilename,
 
     do
     {
-        const CPLString osFileName = poReader->GetFileName();
-        bool bIsDir = false;
-        const CPLString osStrippedFilename =
-            GetStrippedFilename(osFileName, bIsDir);
-        if (osStrippedFilename.empty() || osStrippedFilename[0] == '/' ||
-            osStrippedFilename.find("//") != std::string::npos)
-        {
-            continue;
-        }
-
-        if (oSet.find(osStrippedFilename) == oSet.end())
-        {
-            oSet.insert(osStrippedFilename);
-
-            // Add intermediate directory structure.
-            const char *pszBegin = osStrippedFilename.c_str();
-            for (const char *pszIter = pszBegin; *pszIter; pszIter++)
-            {
-                if (*pszIter == '/')
-                {
-                    char *pszStrippedFileName2 = CPLStrdup(osStrippedFilename);
-                    pszStrippedFileName2[pszIter - pszBegin] = 0;
-                    if (oSet.find(pszStrippedFileName2) == oSet.end())
-                    {
-                        oSet.insert(pszStrippedFileName2);
-
-                        content->entries =
-                            static_cast<VSIArchiveEntry *>(CPLRealloc(
-                                content->entries, sizeof(VSIArchiveEntry) *
-                                                      (content->nEntries + 1)));
-                        content->entries[content->nEntries].fileName =
-                            pszStrippedFileName2;
-                        content->entries[content->nEntries].nModifiedTime =
-                            poReader->GetModifiedTime();
-                        content->entries[content->nEntries].uncompressed_size =
-                            0;
-                        content->entries[content->nEntries].bIsDir = TRUE;
-                        content->entries[content->nEntries].file_pos = nullptr;
-#ifdef DEBUG_VERBOSE
-                        const int nEntries = content->nEntries;
-                        CPLDebug("VSIArchive",
-                                 "[%d] %s : " CPL_FRMT_GUIB " bytes",
-                                 content->nEntries + 1,
-                                 content->entries[nEntries].fileName,
-                                 content->entries[nEntries].uncompressed_size);
-#endif
-                        content->nEntries++;
-                    }
-                    else
-                    {
-                        CPLFree(pszStrippedFileName2);
-                    }
-                }
-            }
-
-            content->entries = static_cast<VSIArchiveEntry *>(
-                CPLRealloc(content->entries,
-                           sizeof(VSIArchiveEntry) * (content->nEntries + 1)));
-            content->entries[content->nEntries].fileName =
-                CPLStrdup(osStrippedFilename);
-            content->entries[content->nEntries].nModifiedTime =
-                poReader->GetModifiedTime();
-            content->entries[content->nEntries].uncompressed_size =
-                poReader->GetFileSize();
-            content->entries[content->nEntries].bIsDir = bIsDir;
-            content->entries[content->nEntries].file_pos =
-                poReader->GetFileOffset();
-#ifdef DEBUG_VERBOSE
-            CPLDebug("VSIArchive", "[%d] %s : " CPL_FRMT_GUIB " bytes",
-                     content->nEntries + 1,
-                     content->entries[content->nEntries].fileName,
-                     content->entries[content->nEntries].uncompressed_size);
-#endif
-            content->nEntries++;
-        }
-
+        AddEntryToContent(content, oSet, poReader);
     } while (poReader->GotoNextFile());
 
     if (bMustClose)
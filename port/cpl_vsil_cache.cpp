@@ -114,6 +114,12 @@ class VSICachedFile final : public VSIVirtualHandle
     {
         return m_poBase->PRead(pBuffer, nSize, nOffset);
     }
+
+    std::shared_ptr<const GByte> MapRegion(vsi_l_offset nOffset,
+                                           size_t nSize) override
+    {
+        return m_poBase->MapRegion(nOffset, nSize);
+    }
 };
 
 /************************************************************************/
@@ -31,9 +31,12 @@
 
 #include <cstddef>
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 #include "cpl_error.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 
 CPL_C_START
 void CPL_DLL VSIInstallCryptFileHandler();
@@ -776,8 +779,30 @@ class VSICryptFileHandle final : public VSIVirtualHandle
 
     bool bLastSectorWasModified = false;
 
-    void EncryptBlock(GByte *pabyData, vsi_l_offset nOffset);
-    bool DecryptBlock(GByte *pabyData, vsi_l_offset nOffset);
+    // Key actually used, to set up the ciphers of the worker threads.
+    std::string osKeyBytes{};
+    int nThreads = 1;
+    std::unique_ptr<CPLWorkerThreadPool> poPool{};
+    std::vector<GByte> abyBulkBuffer{};
+
+    struct SectorsJob
+    {
+        const VSICryptFileHandle *poHandle = nullptr;
+        GByte *pabyData = nullptr;
+        vsi_l_offset nOffset = 0;
+        size_t nSectors = 0;
+        bool bEncrypt = false;
+        bool bOK = false;
+    };
+
+    void EncryptBlock(GByte *pabyData, vsi_l_offset nOffset,
+                      CryptoPP::BlockCipher *poEncCipherIn = nullptr) const;
+    bool DecryptBlock(GByte *pabyData, vsi_l_offset nOffset,
+                      CryptoPP::BlockCipher *poEncCipherIn = nullptr,
+                      CryptoPP::BlockCipher *poDecCipherIn = nullptr) const;
+    bool ProcessSectors(GByte *pabyData, vsi_l_offset nOffset,
+                        size_t nSectors, bool bEncrypt);
+    static void ProcessSectorsJob(void *pData);
     bool FlushDirty();
 
   public:
@@ -822,6 +847,7 @@ VSICryptFileHandle::~VSICryptFileHandle()
     delete poEncCipher;
     delete poDecCipher;
     CPLFree(pabyWB);
+    std::fill(osKeyBytes.begin(), osKeyBytes.end(), '\0');
 }
 
 /************************************************************************/
@@ -861,12 +887,15 @@ int VSICryptFileHandle::Init(const CPLString &osKey, bool bWriteHeader)
             poDecCipher->SetKey(
                 reinterpret_cast<const cryptopp_byte *>(osKey.c_str()),
                 nKeySize);
+            osKeyBytes.assign(osKey.c_str(), nKeySize);
         }
         else if (pabyGlobalKey)
         {
             const int nKeySize = std::min(nMaxKeySize, nGlobalKeySize);
             poEncCipher->SetKey(pabyGlobalKey, nKeySize);
             poDecCipher->SetKey(pabyGlobalKey, nKeySize);
+            osKeyBytes.assign(reinterpret_cast<const char *>(pabyGlobalKey),
+                              nKeySize);
         }
         else
             return FALSE;
@@ -902,6 +931,16 @@ int VSICryptFileHandle::Init(const CPLString &osKey, bool bWriteHeader)
         return FALSE;
     }
 
+    // Sectors being independent, large reads and writes can be
+    // processed by several threads.
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszThreads)
+    {
+        nThreads = EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                 : atoi(pszThreads);
+        nThreads = std::max(1, std::min(128, nThreads));
+    }
+
     return TRUE;
 }
 
@@ -909,34 +948,40 @@ int VSICryptFileHandle::Init(const CPLString &osKey, bool bWriteHeader)
 /*                          EncryptBlock()                              */
 /************************************************************************/
 
-void VSICryptFileHandle::EncryptBlock(GByte *pabyData, vsi_l_offset nOffset)
+// poEncCipherIn, if not null, is used instead of poEncCipher. This is for
+// worker threads, that cannot share cipher objects.
+void VSICryptFileHandle::EncryptBlock(
+    GByte *pabyData, vsi_l_offset nOffset,
+    CryptoPP::BlockCipher *poEncCipherIn) const
 {
     std::string osRes;
     std::string osIV(VSICryptGenerateSectorIV(poHeader->osIV, nOffset));
     CPLAssert(static_cast<int>(osIV.size()) == nBlockSize);
+    CryptoPP::BlockCipher &oEncCipher =
+        poEncCipherIn ? *poEncCipherIn : *poEncCipher;
 
     CryptoPP::StreamTransformation *poMode;
     try
     {
         if (poHeader->eMode == MODE_CBC)
             poMode = new CryptoPP::CBC_Mode_ExternalCipher::Encryption(
-                *poEncCipher,
+                oEncCipher,
                 reinterpret_cast<const cryptopp_byte *>(osIV.c_str()));
         else if (poHeader->eMode == MODE_CFB)
             poMode = new CryptoPP::CFB_Mode_ExternalCipher::Encryption(
-                *poEncCipher,
+                oEncCipher,
                 reinterpret_cast<const cryptopp_byte *>(osIV.c_str()));
         else if (poHeader->eMode == MODE_OFB)
             poMode = new CryptoPP::OFB_Mode_ExternalCipher::Encryption(
-                *poEncCipher,
+                oEncCipher,
                 reinterpret_cast<const cryptopp_byte *>(osIV.c_str()));
         else if (poHeader->eMode == MODE_CTR)
             poMode = new CryptoPP::CTR_Mode_ExternalCipher::Encryption(
-                *poEncCipher,
+                oEncCipher,
                 reinterpret_cast<const cryptopp_byte *>(osIV.c_str()));
         else
             poMode = new CryptoPP::CBC_CTS_Mode_ExternalCipher::Encryption(
-                *poEncCipher,
+                oEncCipher,
                 reinterpret_cast<const cryptopp_byte *>(osIV.c_str()));
     }
     catch (const std::exception &e)
@@ -963,11 +1008,17 @@ void VSICryptFileHandle::EncryptBlock(GByte *pabyData, vsi_l_offset nOffset)
 /*                          DecryptBlock()                              */
 /************************************************************************/
 
-bool VSICryptFileHandle::DecryptBlock(GByte *pabyData, vsi_l_offset nOffset)
+bool VSICryptFileHandle::DecryptBlock(
+    GByte *pabyData, vsi_l_offset nOffset, CryptoPP::BlockCipher *poEncCipherIn,
+    CryptoPP::BlockCipher *poDecCipherIn) const
 {
     std::string osRes;
     std::string osIV(VSICryptGenerateSectorIV(poHeader->osIV, nOffset));
     CPLAssert(static_cast<int>(osIV.size()) == nBlockSize);
+    CryptoPP::BlockCipher &oEncCipher =
+        poEncCipherIn ? *poEncCipherIn : *poEncCipher;
+    CryptoPP::BlockCipher &oDecCipher =
+        poDecCipherIn ? *poDecCipherIn : *poDecCipher;
     CryptoPP::StringSink *poSink = new CryptoPP::StringSink(osRes);
     CryptoPP::StreamTransformation *poMode = nullptr;
     CryptoPP::StreamTransformationFilter *poDec = nullptr;
@@ -977,23 +1028,23 @@ bool VSICryptFileHandle::DecryptBlock(GByte *pabyData, vsi_l_offset nOffset)
         // Yes, some modes need the encryption cipher.
         if (poHeader->eMode == MODE_CBC)
             poMode = new CryptoPP::CBC_Mode_ExternalCipher::Decryption(
-                *poDecCipher,
+                oDecCipher,
                 reinterpret_cast<const cryptopp_byte *>(osIV.c_str()));
         else if (poHeader->eMode == MODE_CFB)
             poMode = new CryptoPP::CFB_Mode_ExternalCipher::Decryption(
-                *poEncCipher,
+                oEncCipher,
                 reinterpret_cast<const cryptopp_byte *>(osIV.c_str()));
         else if (poHeader->eMode == MODE_OFB)
             poMode = new CryptoPP::OFB_Mode_ExternalCipher::Decryption(
-                *poEncCipher,
+                oEncCipher,
                 reinterpret_cast<const cryptopp_byte *>(osIV.c_str()));
         else if (poHeader->eMode == MODE_CTR)
             poMode = new CryptoPP::CTR_Mode_ExternalCipher::Decryption(
-                *poEncCipher,
+                oEncCipher,
                 reinterpret_cast<const cryptopp_byte *>(osIV.c_str()));
         else
             poMode = new CryptoPP::CBC_CTS_Mode_ExternalCipher::Decryption(
-                *poDecCipher,
+                oDecCipher,
                 reinterpret_cast<const cryptopp_byte *>(osIV.c_str()));
         poDec = new CryptoPP::StreamTransformationFilter(
             *poMode, poSink, CryptoPP::StreamTransformationFilter::NO_PADDING);
@@ -1019,6 +1070,119 @@ bool VSICryptFileHandle::DecryptBlock(GByte *pabyData, vsi_l_offset nOffset)
     return true;
 }
 
+/************************************************************************/
+/*                         ProcessSectorsJob()                          */
+/************************************************************************/
+
+void VSICryptFileHandle::ProcessSectorsJob(void *pData)
+{
+    SectorsJob *psJob = static_cast<SectorsJob *>(pData);
+    const VSICryptFileHandle *poThis = psJob->poHandle;
+    const VSICryptFileHeader *poHeader = poThis->poHeader;
+
+    // Crypto++ objects must not be shared between threads.
+    std::unique_ptr<CryptoPP::BlockCipher> poEnc(
+        GetEncBlockCipher(poHeader->eAlg));
+    std::unique_ptr<CryptoPP::BlockCipher> poDec(
+        GetDecBlockCipher(poHeader->eAlg));
+    if (!poEnc || !poDec)
+        return;
+    try
+    {
+        const cryptopp_byte *pabyKey =
+            reinterpret_cast<const cryptopp_byte *>(poThis->osKeyBytes.data());
+        poEnc->SetKey(pabyKey, poThis->osKeyBytes.size());
+        poDec->SetKey(pabyKey, poThis->osKeyBytes.size());
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "CryptoPP exception: %s",
+                 e.what());
+        return;
+    }
+
+    for (size_t i = 0; i < psJob->nSectors; ++i)
+    {
+        GByte *pabySector = psJob->pabyData + i * poHeader->nSectorSize;
+        const vsi_l_offset nSectorOffset =
+            psJob->nOffset +
+            static_cast<vsi_l_offset>(i) * poHeader->nSectorSize;
+        if (psJob->bEncrypt)
+            poThis->EncryptBlock(pabySector, nSectorOffset, poEnc.get());
+        else if (!poThis->DecryptBlock(pabySector, nSectorOffset, poEnc.get(),
+                                       poDec.get()))
+            return;
+    }
+    psJob->bOK = true;
+}
+
+/************************************************************************/
+/*                          ProcessSectors()                            */
+/************************************************************************/
+
+// Encrypt or decrypt in place nSectors consecutive sectors, the first one
+// being at nOffset in the plain text file, using several threads if
+// GDAL_NUM_THREADS allows it.
+bool VSICryptFileHandle::ProcessSectors(GByte *pabyData, vsi_l_offset nOffset,
+                                        size_t nSectors, bool bEncrypt)
+{
+    // Not worth dispatching smaller chunks to worker threads.
+    constexpr size_t MIN_SECTORS_PER_JOB = 16;
+    const size_t nJobs = std::min(static_cast<size_t>(nThreads),
+                                  nSectors / MIN_SECTORS_PER_JOB);
+    if (nJobs >= 2 && !poPool)
+    {
+        poPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!poPool->Setup(nThreads, nullptr, nullptr, false))
+        {
+            poPool.reset();
+            nThreads = 1;
+        }
+    }
+
+    if (nJobs < 2 || !poPool)
+    {
+        for (size_t i = 0; i < nSectors; ++i)
+        {
+            GByte *pabySector = pabyData + i * poHeader->nSectorSize;
+            const vsi_l_offset nSectorOffset =
+                nOffset + static_cast<vsi_l_offset>(i) * poHeader->nSectorSize;
+            if (bEncrypt)
+                EncryptBlock(pabySector, nSectorOffset);
+            else if (!DecryptBlock(pabySector, nSectorOffset))
+                return false;
+        }
+        return true;
+    }
+
+    std::vector<SectorsJob> asJobs(nJobs);
+    size_t nStart = 0;
+    for (size_t i = 0; i < nJobs; ++i)
+    {
+        const size_t nCount = nSectors / nJobs + (i < nSectors % nJobs ? 1 : 0);
+        asJobs[i].poHandle = this;
+        asJobs[i].pabyData = pabyData + nStart * poHeader->nSectorSize;
+        asJobs[i].nOffset =
+            nOffset + static_cast<vsi_l_offset>(nStart) * poHeader->nSectorSize;
+        asJobs[i].nSectors = nCount;
+        asJobs[i].bEncrypt = bEncrypt;
+        nStart += nCount;
+    }
+    for (auto &sJob : asJobs)
+    {
+        if (!poPool->SubmitJob(ProcessSectorsJob, &sJob))
+            ProcessSectorsJob(&sJob);
+    }
+    poPool->WaitCompletion();
+
+    for (const auto &sJob : asJobs)
+    {
+        if (!sJob.bOK)
+            return false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                             FlushDirty()                             */
 /************************************************************************/
@@ -1124,6 +1288,34 @@ size_t VSICryptFileHandle::Read(void *pBuffer, size_t nSize, size_t nMemb)
             CPLAssert((nCurPos % poHeader->nSectorSize) == 0);
         }
 
+        // Decrypt runs of whole sectors directly in the user buffer, so that
+        // they can be processed by several threads.
+        const size_t nWholeSectors =
+            (nCurPos % poHeader->nSectorSize) != 0
+                ? 0
+                : static_cast<size_t>(
+                      std::min(static_cast<vsi_l_offset>(nToRead),
+                               poHeader->nPayloadFileSize - nCurPos) /
+                      poHeader->nSectorSize);
+        if (nWholeSectors >= 2)
+        {
+            const size_t nBytes = nWholeSectors * poHeader->nSectorSize;
+            poBaseHandle->Seek(poHeader->nHeaderSize + nCurPos, SEEK_SET);
+            if (poBaseHandle->Read(pabyBuffer, nBytes, 1) != 1)
+            {
+                bEOF = true;
+                break;
+            }
+            if (!ProcessSectors(pabyBuffer, nCurPos, nWholeSectors, false))
+                break;
+            pabyBuffer += nBytes;
+            nToRead -= nBytes;
+            nCurPos += nBytes;
+            if (nToRead == 0)
+                break;
+            continue;
+        }
+
         vsi_l_offset nSectorOffset =
             (nCurPos / poHeader->nSectorSize) * poHeader->nSectorSize;
         poBaseHandle->Seek(poHeader->nHeaderSize + nSectorOffset, SEEK_SET);
@@ -1230,6 +1422,53 @@ size_t VSICryptFileHandle::Write(const void *pBuffer, size_t nSize,
                 break;
             CPLAssert((nCurPos % poHeader->nSectorSize) == 0);
         }
+        else if ((nCurPos % poHeader->nSectorSize) == 0 &&
+                 nToWrite >= 2 * static_cast<size_t>(poHeader->nSectorSize))
+        {
+            // Encrypt runs of whole sectors in a temporary buffer, so that
+            // they can be processed by several threads, and write them at
+            // once.
+            if (!FlushDirty())
+                break;
+
+            constexpr size_t MAX_BULK_SIZE = 4 * 1024 * 1024;
+            const size_t nWholeSectors =
+                std::max(static_cast<size_t>(2),
+                         std::min(nToWrite, MAX_BULK_SIZE) /
+                             poHeader->nSectorSize);
+            const size_t nBytes = nWholeSectors * poHeader->nSectorSize;
+            try
+            {
+                abyBulkBuffer.resize(nBytes);
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate temporary buffer");
+                break;
+            }
+            memcpy(abyBulkBuffer.data(), pabyBuffer, nBytes);
+            if (!ProcessSectors(abyBulkBuffer.data(), nCurPos, nWholeSectors,
+                                true))
+                break;
+            poBaseHandle->Seek(poHeader->nHeaderSize + nCurPos, SEEK_SET);
+            if (poBaseHandle->Write(abyBulkBuffer.data(), nBytes, 1) != 1)
+                break;
+
+            // The write buffer may hold the previous content of one of
+            // those sectors.
+            nWBOffset = 0;
+            nWBSize = 0;
+
+            pabyBuffer += nBytes;
+            nToWrite -= nBytes;
+            nCurPos += nBytes;
+            if (nCurPos > poHeader->nPayloadFileSize)
+            {
+                bUpdateHeader = true;
+                poHeader->nPayloadFileSize = nCurPos;
+            }
+        }
         else if ((nCurPos % poHeader->nSectorSize) == 0 &&
                  nToWrite >= static_cast<size_t>(poHeader->nSectorSize))
         {
@@ -1994,6 +2233,11 @@ static GDALDataset *VSICryptOpen(GDALOpenInfo *poOpenInfo)
  * handlers, such as /vsizip. For example,
  * /vsicrypt//vsicurl/path/to/remote/encrypted/file.tif
  *
+ * Sectors being encrypted independently of each other, reads and writes
+ * spanning many sectors can be processed by several threads. Starting with
+ * GDAL 3.9, this is enabled by setting the GDAL_NUM_THREADS configuration
+ * option to an integer or ALL_CPUS. Defaults to 1.
+ *
  * Implementation details:
  *
  * The structure of encrypted files is the following: a header, immediately
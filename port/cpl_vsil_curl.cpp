@@ -32,6 +32,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <set>
 #include <map>
 #include <memory>
@@ -41,8 +42,10 @@
 #include "cpl_json_header.h"
 #include "cpl_minixml.h"
 #include "cpl_multiproc.h"
+#include "cpl_sha256.h"
 #include "cpl_string.h"
 #include "cpl_time.h"
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_virtual.h"
 #include "cpl_http.h"
@@ -1739,6 +1742,10 @@ std::string VSICurlHandle::DownloadRegion(const vsi_l_offset startOffset,
     if (!osAlreadyDownloadedData.empty())
         return osAlreadyDownloadedData;
 
+    CPLTraceSpan oTraceSpan("VSICurlHandle::DownloadRegion");
+    oTraceSpan.SetAttribute("url", m_pszURL);
+    oTraceSpan.SetAttribute("offset", static_cast<GIntBig>(startOffset));
+
 begin:
     CURLM *hCurlMultiHandle = poFS->GetCurlMultiHandleFor(m_pszURL);
 
@@ -1833,6 +1840,9 @@ retry:
 
     long response_code = 0;
     curl_easy_getinfo(hCurlHandle, CURLINFO_HTTP_CODE, &response_code);
+    oTraceSpan.SetAttribute("http_code", static_cast<GIntBig>(response_code));
+    oTraceSpan.SetAttribute("bytes",
+                            static_cast<GIntBig>(sWriteFuncData.nSize));
 
     if (ENABLE_DEBUG && szCurlErrBuf[0] != '\0')
     {
@@ -2120,6 +2130,151 @@ void VSICurlHandle::DownloadRegionPostProcess(const vsi_l_offset startOffset,
     }
 }
 
+/************************************************************************/
+/*                      DownloadRegionsInParallel()                     */
+/************************************************************************/
+
+// Download nRequests consecutive regions of nBlocks blocks each, starting at
+// startOffset, with concurrent range requests, and add them to the region
+// cache. The file size must be known. Returns false if any request fails, in
+// which case the caller falls back to DownloadRegion(), which deals with
+// retries and redirections.
+bool VSICurlHandle::DownloadRegionsInParallel(const vsi_l_offset startOffset,
+                                              const int nBlocks,
+                                              const int nRequests)
+{
+    if (bInterrupted && bStopOnInterruptUntilUninstall)
+        return false;
+
+    ManagePlanetaryComputerSigning();
+
+    bool bHasExpired = false;
+    const std::string osURL(GetRedirectURLIfValid(bHasExpired));
+    if (bHasExpired)
+        return false;
+
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    const vsi_l_offset nRequestSize =
+        static_cast<vsi_l_offset>(nBlocks) * knDOWNLOAD_CHUNK_SIZE;
+
+    CURLM *hMultiHandle = poFS->GetCurlMultiHandleFor(osURL);
+#ifdef CURLPIPE_MULTIPLEX
+    if (CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES")))
+    {
+        curl_multi_setopt(hMultiHandle, CURLMOPT_PIPELINING,
+                          CURLPIPE_MULTIPLEX);
+    }
+#endif
+
+    std::vector<CURL *> aHandles;
+    std::vector<WriteFuncStruct> asWriteFuncData(nRequests);
+    std::vector<WriteFuncStruct> asWriteFuncHeaderData(nRequests);
+    std::vector<std::string> aosRanges(nRequests);
+    std::vector<struct curl_slist *> aHeaders;
+    for (int i = 0; i < nRequests; ++i)
+    {
+        const vsi_l_offset nStartOffset = startOffset + i * nRequestSize;
+        if (nStartOffset >= oFileProp.fileSize)
+            break;
+        const vsi_l_offset nEndOffset =
+            std::min(nStartOffset + nRequestSize, oFileProp.fileSize) - 1;
+
+        CURL *hCurlHandle = curl_easy_init();
+        aHandles.push_back(hCurlHandle);
+
+        struct curl_slist *headers =
+            VSICurlSetOptions(hCurlHandle, osURL.c_str(), m_papszHTTPOptions);
+
+        VSICURLInitWriteFuncStruct(&asWriteFuncData[i], this, pfnReadCbk,
+                                   pReadCbkUserData);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_WRITEDATA,
+                                   &asWriteFuncData[i]);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_WRITEFUNCTION,
+                                   VSICurlHandleWriteFunc);
+
+        VSICURLInitWriteFuncStruct(&asWriteFuncHeaderData[i], nullptr, nullptr,
+                                   nullptr);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HEADERDATA,
+                                   &asWriteFuncHeaderData[i]);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HEADERFUNCTION,
+                                   VSICurlHandleWriteFunc);
+        asWriteFuncHeaderData[i].bIsHTTP = STARTS_WITH(m_pszURL, "http");
+        asWriteFuncHeaderData[i].nStartOffset = nStartOffset;
+        asWriteFuncHeaderData[i].nEndOffset = nEndOffset;
+
+        char rangeStr[512] = {};
+        snprintf(rangeStr, sizeof(rangeStr), CPL_FRMT_GUIB "-" CPL_FRMT_GUIB,
+                 nStartOffset, nEndOffset);
+
+        if (ENABLE_DEBUG)
+            CPLDebug(poFS->GetDebugKey(), "Downloading %s (%s)...", rangeStr,
+                     osURL.c_str());
+
+        if (asWriteFuncHeaderData[i].bIsHTTP)
+        {
+            // So it gets included in Azure signature
+            aosRanges[i] = std::string("Range: bytes=").append(rangeStr);
+            headers = curl_slist_append(headers, aosRanges[i].c_str());
+            unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_RANGE, nullptr);
+        }
+        else
+        {
+            unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_RANGE, rangeStr);
+        }
+
+        headers = VSICurlMergeHeaders(headers, GetCurlHeaders("GET", headers));
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
+        aHeaders.push_back(headers);
+        curl_multi_add_handle(hMultiHandle, hCurlHandle);
+    }
+
+    if (!aHandles.empty())
+    {
+        MultiPerform(hMultiHandle);
+    }
+
+    bool bRet = !aHandles.empty();
+    size_t nTotalDownloaded = 0;
+    for (size_t i = 0; i < aHandles.size(); ++i)
+    {
+        long response_code = 0;
+        curl_easy_getinfo(aHandles[i], CURLINFO_HTTP_CODE, &response_code);
+        nTotalDownloaded += asWriteFuncData[i].nSize;
+        if ((response_code != 206 && response_code != 225) ||
+            asWriteFuncHeaderData[i].nEndOffset + 1 !=
+                asWriteFuncHeaderData[i].nStartOffset +
+                    asWriteFuncData[i].nSize)
+        {
+            CPLDebug(poFS->GetDebugKey(),
+                     "Request for " CPL_FRMT_GUIB "-" CPL_FRMT_GUIB
+                     " failed with response_code=%ld",
+                     asWriteFuncHeaderData[i].nStartOffset,
+                     asWriteFuncHeaderData[i].nEndOffset, response_code);
+            bRet = false;
+        }
+    }
+
+    for (size_t i = 0; i < aHandles.size(); ++i)
+    {
+        if (bRet)
+        {
+            DownloadRegionPostProcess(asWriteFuncHeaderData[i].nStartOffset,
+                                      nBlocks, asWriteFuncData[i].pBuffer,
+                                      asWriteFuncData[i].nSize);
+        }
+        curl_multi_remove_handle(hMultiHandle, aHandles[i]);
+        VSICURLResetHeaderAndWriterFunctions(aHandles[i]);
+        curl_easy_cleanup(aHandles[i]);
+        CPLFree(asWriteFuncData[i].pBuffer);
+        CPLFree(asWriteFuncHeaderData[i].pBuffer);
+        curl_slist_free_all(aHeaders[i]);
+    }
+
+    NetworkStatisticsLogger::LogGET(nTotalDownloaded);
+
+    return bRet;
+}
+
 /************************************************************************/
 /*                                Read()                                */
 /************************************************************************/
@@ -2172,13 +2327,14 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
         }
         else
         {
-            if (nOffsetToDownload == lastDownloadedOffset)
+            constexpr int MAX_CHUNK_SIZE_INCREASE_FACTOR = 128;
+            const bool bSequential = nOffsetToDownload == lastDownloadedOffset;
+            if (bSequential)
             {
                 // In case of consecutive reads (of small size), we use a
                 // heuristic that we will read the file sequentially, so
                 // we double the requested size to decrease the number of
                 // client/server roundtrips.
-                constexpr int MAX_CHUNK_SIZE_INCREASE_FACTOR = 128;
                 if (nBlocksToDownload < MAX_CHUNK_SIZE_INCREASE_FACTOR)
                     nBlocksToDownload *= 2;
             }
@@ -2220,7 +2376,34 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
             if (nBlocksToDownload > knMAX_REGIONS)
                 nBlocksToDownload = knMAX_REGIONS;
 
-            osRegion = DownloadRegion(nOffsetToDownload, nBlocksToDownload);
+            // Once sequential reading has reached the maximum request size,
+            // download the next regions with several concurrent requests if
+            // asked to, as a single connection might not be able to use the
+            // whole bandwidth. All the regions must fit in the region cache.
+            if (bSequential &&
+                nBlocksToDownload == MAX_CHUNK_SIZE_INCREASE_FACTOR &&
+                oFileProp.bHasComputedFileSize &&
+                poFS->HasOptimizedReadMultiRange(m_osFilename.c_str()))
+            {
+                const int nParallelRequests = std::min(
+                    knMAX_REGIONS / nBlocksToDownload,
+                    atoi(VSIGetPathSpecificOption(
+                        m_osFilename.c_str(),
+                        "CPL_VSIL_CURL_SEQUENTIAL_READ_PARALLEL_REQUESTS",
+                        "1")));
+                if (nParallelRequests > 1 &&
+                    DownloadRegionsInParallel(nOffsetToDownload,
+                                              nBlocksToDownload,
+                                              nParallelRequests))
+                {
+                    psRegion = poFS->GetRegion(m_pszURL, nOffsetToDownload);
+                    if (psRegion != nullptr)
+                        osRegion = *psRegion;
+                }
+            }
+
+            if (osRegion.empty())
+                osRegion = DownloadRegion(nOffsetToDownload, nBlocksToDownload);
             if (osRegion.empty())
             {
                 if (!bInterrupted)
@@ -2337,25 +2520,62 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
 
     const bool bMergeConsecutiveRanges = CPLTestBool(
         CPLGetConfigOption("GDAL_HTTP_MERGE_CONSECUTIVE_RANGES", "TRUE"));
-
-    for (int i = 0, iRequest = 0; i < nRanges;)
-    {
-        size_t nSize = 0;
+    const size_t nMaxGap = bMergeConsecutiveRanges ? GetMergeRangesMaxGap() : 0;
+
+    // Group ranges into requests. A range is merged with the previous one
+    // if it is located after it, and the gap between them is not larger than
+    // nMaxGap, that is when downloading the gap is estimated to be cheaper
+    // than issuing another request.
+    struct MergedRange
+    {
+        int iFirst;
+        int iLast;
+        vsi_l_offset nStartOffset;
+        vsi_l_offset nEndOffset;  // exclusive
+    };
+    std::vector<MergedRange> aoMergedRanges;
+    vsi_l_offset nGapBytes = 0;
+    for (int i = 0; i < nRanges;)
+    {
+        MergedRange oMergedRange;
+        oMergedRange.iFirst = i;
+        oMergedRange.nStartOffset = panOffsets[i];
+        oMergedRange.nEndOffset = panOffsets[i] + panSizes[i];
         int iNext = i;
-        // Identify consecutive ranges
+        vsi_l_offset nGapBytesThisRequest = 0;
         while (bMergeConsecutiveRanges && iNext + 1 < nRanges &&
-               panOffsets[iNext] + panSizes[iNext] == panOffsets[iNext + 1])
+               panOffsets[iNext + 1] >= oMergedRange.nEndOffset &&
+               panOffsets[iNext + 1] - oMergedRange.nEndOffset <= nMaxGap)
         {
-            nSize += panSizes[iNext];
             iNext++;
+            nGapBytesThisRequest +=
+                panOffsets[iNext] - oMergedRange.nEndOffset;
+            oMergedRange.nEndOffset = panOffsets[iNext] + panSizes[iNext];
         }
-        nSize += panSizes[iNext];
+        oMergedRange.iLast = iNext;
+        i = iNext + 1;
 
-        if (nSize == 0)
+        // Skip requests made only of empty ranges
+        if (oMergedRange.nEndOffset - nGapBytesThisRequest >
+            oMergedRange.nStartOffset)
         {
-            i = iNext + 1;
-            continue;
+            nGapBytes += nGapBytesThisRequest;
+            aoMergedRanges.push_back(oMergedRange);
         }
+    }
+
+    if (ENABLE_DEBUG && nMaxGap > 0)
+        CPLDebug(poFS->GetDebugKey(),
+                 "ReadMultiRange(): %d ranges merged into %d requests "
+                 "(max gap = " CPL_FRMT_GUIB " bytes, gaps = " CPL_FRMT_GUIB
+                 " bytes)",
+                 nRanges, static_cast<int>(aoMergedRanges.size()),
+                 static_cast<GUIntBig>(nMaxGap),
+                 static_cast<GUIntBig>(nGapBytes));
+
+    for (size_t iRequest = 0; iRequest < aoMergedRanges.size(); ++iRequest)
+    {
+        const auto &oMergedRange = aoMergedRanges[iRequest];
 
         CURL *hCurlHandle = curl_easy_init();
         aHandles.push_back(hCurlHandle);
@@ -2381,9 +2601,10 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
         unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HEADERFUNCTION,
                                    VSICurlHandleWriteFunc);
         asWriteFuncHeaderData[iRequest].bIsHTTP = STARTS_WITH(m_pszURL, "http");
-        asWriteFuncHeaderData[iRequest].nStartOffset = panOffsets[i];
-
-        asWriteFuncHeaderData[iRequest].nEndOffset = panOffsets[i] + nSize - 1;
+        asWriteFuncHeaderData[iRequest].nStartOffset =
+            oMergedRange.nStartOffset;
+        asWriteFuncHeaderData[iRequest].nEndOffset =
+            oMergedRange.nEndOffset - 1;
 
         char rangeStr[512] = {};
         snprintf(rangeStr, sizeof(rangeStr), CPL_FRMT_GUIB "-" CPL_FRMT_GUIB,
@@ -2418,9 +2639,6 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
         unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
         aHeaders.push_back(headers);
         curl_multi_add_handle(hMultiHandle, hCurlHandle);
-
-        i = iNext + 1;
-        iRequest++;
     }
 
     if (!aHandles.empty())
@@ -2429,22 +2647,15 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
     }
 
     int nRet = 0;
-    size_t iReq = 0;
-    int iRange = 0;
     size_t nTotalDownloaded = 0;
-    for (; iReq < aHandles.size(); iReq++, iRange++)
+    for (size_t iReq = 0; iReq < aHandles.size(); iReq++)
     {
-        while (iRange < nRanges && panSizes[iRange] == 0)
-        {
-            iRange++;
-        }
-        if (iRange == nRanges)
-            break;
+        const auto &oMergedRange = aoMergedRanges[iReq];
 
         long response_code = 0;
         curl_easy_getinfo(aHandles[iReq], CURLINFO_HTTP_CODE, &response_code);
 
-        if (ENABLE_DEBUG && asCurlErrors[iRange].szCurlErrBuf[0] != '\0')
+        if (ENABLE_DEBUG && asCurlErrors[iReq].szCurlErrBuf[0] != '\0')
         {
             char rangeStr[512] = {};
             snprintf(rangeStr, sizeof(rangeStr),
@@ -2452,7 +2663,7 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
                      asWriteFuncHeaderData[iReq].nStartOffset,
                      asWriteFuncHeaderData[iReq].nEndOffset);
 
-            const char *pszErrorMsg = &asCurlErrors[iRange].szCurlErrBuf[0];
+            const char *pszErrorMsg = &asCurlErrors[iReq].szCurlErrBuf[0];
             CPLDebug(poFS->GetDebugKey(),
                      "ReadMultiRange(%s), %s: response_code=%d, msg=%s",
                      osURL.c_str(), rangeStr, static_cast<int>(response_code),
@@ -2477,38 +2688,21 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
         }
         else if (nRet == 0)
         {
-            size_t nOffset = 0;
-            size_t nRemainingSize = asWriteFuncData[iReq].nSize;
-            nTotalDownloaded += nRemainingSize;
-            CPLAssert(iRange < nRanges);
-            while (true)
+            nTotalDownloaded += asWriteFuncData[iReq].nSize;
+            for (int iRange = oMergedRange.iFirst; iRange <= oMergedRange.iLast;
+                 ++iRange)
             {
-                if (nRemainingSize < panSizes[iRange])
-                {
-                    nRet = -1;
-                    break;
-                }
-
                 if (panSizes[iRange] > 0)
                 {
                     memcpy(ppData[iRange],
-                           asWriteFuncData[iReq].pBuffer + nOffset,
+                           asWriteFuncData[iReq].pBuffer +
+                               static_cast<size_t>(panOffsets[iRange] -
+                                                   oMergedRange.nStartOffset),
                            panSizes[iRange]);
                 }
-
-                if (bMergeConsecutiveRanges && iRange + 1 < nRanges &&
-                    panOffsets[iRange] + panSizes[iRange] ==
-                        panOffsets[iRange + 1])
-                {
-                    nOffset += panSizes[iRange];
-                    nRemainingSize -= panSizes[iRange];
-                    iRange++;
-                }
-                else
-                {
-                    break;
-                }
             }
+            UpdateTransferEstimates(aHandles[iReq],
+                                    asWriteFuncData[iReq].nSize);
         }
 
         curl_multi_remove_handle(hMultiHandle, aHandles[iReq]);
@@ -2528,6 +2722,70 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
     return nRet;
 }
 
+/************************************************************************/
+/*                        GetMergeRangesMaxGap()                        */
+/************************************************************************/
+
+// Returns the maximum number of bytes between two ranges of a
+// ReadMultiRange() or AdviseRead() request for them to be fetched by a
+// single request.
+size_t VSICurlHandle::GetMergeRangesMaxGap() const
+{
+    const char *pszMaxGap =
+        CPLGetConfigOption("GDAL_HTTP_MERGE_RANGES_MAX_GAP", "0");
+    if (EQUAL(pszMaxGap, "AUTO"))
+    {
+        // Downloading the gap costs its size divided by the throughput,
+        // whereas an extra request costs about the latency.
+        constexpr double MAX_AUTO_GAP = 4 * 1024 * 1024;
+        return static_cast<size_t>(std::min(
+            MAX_AUTO_GAP, m_dfRequestLatency * m_dfDownloadThroughput));
+    }
+    return static_cast<size_t>(std::min<GIntBig>(
+        std::max<GIntBig>(0, CPLAtoGIntBig(pszMaxGap)),
+        std::numeric_limits<int>::max()));
+}
+
+/************************************************************************/
+/*                       UpdateTransferEstimates()                      */
+/************************************************************************/
+
+// Updates the running estimates of the latency and throughput of requests,
+// used by GetMergeRangesMaxGap() in AUTO mode, from a completed request.
+void VSICurlHandle::UpdateTransferEstimates(CURL *hCurlHandle,
+                                            size_t nDownloaded)
+{
+    double dfPreTransferTime = 0;
+    double dfStartTransferTime = 0;
+    double dfTotalTime = 0;
+    if (curl_easy_getinfo(hCurlHandle, CURLINFO_PRETRANSFER_TIME,
+                          &dfPreTransferTime) != CURLE_OK ||
+        curl_easy_getinfo(hCurlHandle, CURLINFO_STARTTRANSFER_TIME,
+                          &dfStartTransferTime) != CURLE_OK ||
+        curl_easy_getinfo(hCurlHandle, CURLINFO_TOTAL_TIME, &dfTotalTime) !=
+            CURLE_OK)
+    {
+        return;
+    }
+
+    constexpr double WEIGHT_NEW_VALUE = 0.2;
+    const double dfLatency = dfStartTransferTime - dfPreTransferTime;
+    if (dfLatency > 0)
+    {
+        m_dfRequestLatency = (1 - WEIGHT_NEW_VALUE) * m_dfRequestLatency +
+                             WEIGHT_NEW_VALUE * dfLatency;
+    }
+    // Small transfers do not give a meaningful throughput
+    const double dfTransferTime = dfTotalTime - dfStartTransferTime;
+    if (nDownloaded >= 65536 && dfTransferTime > 1e-3)
+    {
+        m_dfDownloadThroughput =
+            (1 - WEIGHT_NEW_VALUE) * m_dfDownloadThroughput +
+            WEIGHT_NEW_VALUE * static_cast<double>(nDownloaded) /
+                dfTransferTime;
+    }
+}
+
 /************************************************************************/
 /*                       ReadMultiRangeSingleGet()                      */
 /************************************************************************/
@@ -3120,6 +3378,8 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
 
     const bool bMergeConsecutiveRanges = CPLTestBool(
         CPLGetConfigOption("GDAL_HTTP_MERGE_CONSECUTIVE_RANGES", "TRUE"));
+    constexpr size_t SIZE_COG_MARKERS = 2 * sizeof(uint32_t);
+    const size_t nMaxGap = std::max(SIZE_COG_MARKERS, GetMergeRangesMaxGap());
 
     try
     {
@@ -3129,11 +3389,10 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
         {
             int iNext = i;
             // Identify consecutive ranges
-            constexpr size_t SIZE_COG_MARKERS = 2 * sizeof(uint32_t);
             auto nEndOffset = panOffsets[iNext] + panSizes[iNext];
             while (bMergeConsecutiveRanges && iNext + 1 < nRanges &&
                    panOffsets[iNext + 1] > panOffsets[iNext] &&
-                   panOffsets[iNext] + panSizes[iNext] + SIZE_COG_MARKERS >=
+                   panOffsets[iNext] + panSizes[iNext] + nMaxGap >=
                        panOffsets[iNext + 1] &&
                    panOffsets[iNext + 1] + panSizes[iNext + 1] > nEndOffset)
             {
@@ -3576,6 +3835,186 @@ VSICurlFilesystemHandlerBase::GetCurlMultiHandleFor(const CPLString & /*osURL*/)
     return conn.hCurlMultiHandle;
 }
 
+/************************************************************************/
+/*                        Persistent disk cache                         */
+/************************************************************************/
+
+// When CPL_VSIL_CURL_DISK_CACHE_DIR is set, downloaded regions and file
+// properties are also stored in that directory, so that they can be reused
+// by other processes. Regions are keyed by the URL and the ETag (or last
+// modification time) of the file, so a modified remote file does not match
+// them anymore. Files are written under a temporary name and renamed, so
+// that a concurrent reader never sees a partial file.
+
+static std::string VSICurlGetDiskCacheDir()
+{
+    return CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_DIR", "");
+}
+
+static std::string VSICurlDiskCacheFilename(const std::string &osDir,
+                                            const std::string &osKey,
+                                            const char *pszExt)
+{
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256(osKey.data(), osKey.size(), abyHash);
+    char *pszHex = CPLBinaryToHex(CPL_SHA256_HASH_SIZE, abyHash);
+    std::string osFilename(CPLFormFilename(osDir.c_str(), pszHex, pszExt));
+    CPLFree(pszHex);
+    return osFilename;
+}
+
+// Returns an empty string if the file properties do not allow to detect
+// a change of the remote file, in which case nothing is cached on disk.
+static std::string VSICurlDiskCacheValidator(const FileProp &oFileProp)
+{
+    if (oFileProp.eExists != EXIST_YES || !oFileProp.bHasComputedFileSize ||
+        oFileProp.bIsDirectory)
+        return std::string();
+    std::string osValidator;
+    if (!oFileProp.ETag.empty())
+        osValidator = "etag:" + oFileProp.ETag;
+    else if (oFileProp.mTime > 0)
+        osValidator = CPLSPrintf("mtime:" CPL_FRMT_GIB,
+                                 static_cast<GIntBig>(oFileProp.mTime));
+    else
+        return std::string();
+    osValidator += CPLSPrintf(",size:" CPL_FRMT_GUIB,
+                              static_cast<GUIntBig>(oFileProp.fileSize));
+    return osValidator;
+}
+
+static std::string VSICurlDiskCacheRegionKey(const char *pszURL,
+                                             const std::string &osValidator,
+                                             vsi_l_offset nFileOffsetStart)
+{
+    return std::string("region\n")
+        .append(pszURL)
+        .append("\n")
+        .append(osValidator)
+        .append(CPLSPrintf("\n%d\n" CPL_FRMT_GUIB,
+                           VSICURLGetDownloadChunkSize(),
+                           static_cast<GUIntBig>(nFileOffsetStart)));
+}
+
+/************************************************************************/
+/*                        VSICurlDiskCacheTrim()                        */
+/************************************************************************/
+
+// Removes the oldest files of the cache directory until its size is below
+// 90% of nMaxSize. Leftover temporary files of crashed processes are also
+// removed.
+static void VSICurlDiskCacheTrim(const std::string &osDir, GIntBig nMaxSize)
+{
+    struct Entry
+    {
+        std::string osFilename{};
+        GIntBig nSize = 0;
+        time_t nMTime = 0;
+    };
+
+    std::vector<Entry> aoEntries;
+    GIntBig nTotalSize = 0;
+    const time_t nNow = time(nullptr);
+    const CPLStringList aosFiles(VSIReadDir(osDir.c_str()));
+    for (const char *pszFile : aosFiles)
+    {
+        const bool bIsTmp = strstr(pszFile, ".tmp.") != nullptr;
+        if (!bIsTmp && !EQUAL(CPLGetExtension(pszFile), "region") &&
+            !EQUAL(CPLGetExtension(pszFile), "prop"))
+            continue;
+        Entry oEntry;
+        oEntry.osFilename = CPLFormFilename(osDir.c_str(), pszFile, nullptr);
+        VSIStatBufL sStat;
+        if (VSIStatL(oEntry.osFilename.c_str(), &sStat) != 0)
+            continue;
+        if (bIsTmp)
+        {
+            if (sStat.st_mtime + 3600 < nNow)
+                VSIUnlink(oEntry.osFilename.c_str());
+            continue;
+        }
+        oEntry.nSize = static_cast<GIntBig>(sStat.st_size);
+        oEntry.nMTime = sStat.st_mtime;
+        nTotalSize += oEntry.nSize;
+        aoEntries.emplace_back(std::move(oEntry));
+    }
+    if (nTotalSize <= nMaxSize)
+        return;
+
+    std::sort(aoEntries.begin(), aoEntries.end(),
+              [](const Entry &a, const Entry &b)
+              { return a.nMTime < b.nMTime; });
+    const GIntBig nTargetSize = nMaxSize / 10 * 9;
+    for (const auto &oEntry : aoEntries)
+    {
+        if (nTotalSize <= nTargetSize)
+            break;
+        // Another process may have removed it already
+        VSIUnlink(oEntry.osFilename.c_str());
+        nTotalSize -= oEntry.nSize;
+    }
+}
+
+/************************************************************************/
+/*                       VSICurlDiskCacheWrite()                        */
+/************************************************************************/
+
+static void VSICurlDiskCacheWrite(const std::string &osDir,
+                                  const std::string &osFilename,
+                                  const void *pData, size_t nSize)
+{
+    static std::atomic<int> nCounter{0};
+    const std::string osTmpFilename =
+        osFilename + CPLSPrintf(".tmp.%d." CPL_FRMT_GIB ".%d",
+                                CPLGetCurrentProcessID(), CPLGetPID(),
+                                ++nCounter);
+    VSILFILE *fp = VSIFOpenL(osTmpFilename.c_str(), "wb");
+    if (fp == nullptr)
+    {
+        VSIMkdirRecursive(osDir.c_str(), 0755);
+        fp = VSIFOpenL(osTmpFilename.c_str(), "wb");
+        if (fp == nullptr)
+        {
+            CPLDebug("VSICURL", "Cannot write in disk cache %s",
+                         osDir.c_str());
+            return;
+        }
+    }
+    bool bOK = VSIFWriteL(pData, 1, nSize, fp) == nSize;
+    bOK = VSIFCloseL(fp) == 0 && bOK;
+    // On Windows, rename() fails if the target already exists, that is if
+    // another process has cached the same data in the meantime.
+    if (!bOK || VSIRename(osTmpFilename.c_str(), osFilename.c_str()) != 0)
+    {
+        VSIUnlink(osTmpFilename.c_str());
+        return;
+    }
+
+    // Check the size of the cache each time about 10% of its maximum size
+    // has been written by this process, and at the first write.
+    const GIntBig nMaxSize = std::max<GIntBig>(
+        0, CPLAtoGIntBig(CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_SIZE",
+                                            "1073741824")));
+    static std::mutex oMutex;
+    static GIntBig nWrittenSinceTrim = -1;
+    bool bTrim = false;
+    {
+        std::lock_guard<std::mutex> oLock(oMutex);
+        if (nWrittenSinceTrim < 0 ||
+            nWrittenSinceTrim + static_cast<GIntBig>(nSize) > nMaxSize / 10)
+        {
+            nWrittenSinceTrim = 0;
+            bTrim = true;
+        }
+        else
+        {
+            nWrittenSinceTrim += static_cast<GIntBig>(nSize);
+        }
+    }
+    if (bTrim)
+        VSICurlDiskCacheTrim(osDir, nMaxSize);
+}
+
 /************************************************************************/
 /*                          GetRegionCache()                            */
 /************************************************************************/
@@ -3600,20 +4039,55 @@ std::shared_ptr<std::string>
 VSICurlFilesystemHandlerBase::GetRegion(const char *pszURL,
                                         vsi_l_offset nFileOffsetStart)
 {
-    CPLMutexHolder oHolder(&hMutex);
-
     const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
     nFileOffsetStart =
         (nFileOffsetStart / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
 
     std::shared_ptr<std::string> out;
-    if (GetRegionCache()->tryGet(
-            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out))
     {
-        return out;
+        CPLMutexHolder oHolder(&hMutex);
+        if (GetRegionCache()->tryGet(
+                FilenameOffsetPair(std::string(pszURL), nFileOffsetStart),
+                out))
+        {
+            return out;
+        }
     }
 
-    return nullptr;
+    const std::string osDiskCacheDir = VSICurlGetDiskCacheDir();
+    if (osDiskCacheDir.empty())
+        return nullptr;
+
+    FileProp oFileProp;
+    if (!GetCachedFileProp(pszURL, oFileProp))
+        return nullptr;
+    const std::string osValidator = VSICurlDiskCacheValidator(oFileProp);
+    if (osValidator.empty() || nFileOffsetStart >= oFileProp.fileSize)
+        return nullptr;
+
+    const std::string osFilename = VSICurlDiskCacheFilename(
+        osDiskCacheDir,
+        VSICurlDiskCacheRegionKey(pszURL, osValidator, nFileOffsetStart),
+        "region");
+    VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "rb");
+    if (fp == nullptr)
+        return nullptr;
+    // Only the last region of the file may be shorter than a chunk
+    const size_t nExpectedSize = static_cast<size_t>(
+        std::min(static_cast<vsi_l_offset>(knDOWNLOAD_CHUNK_SIZE),
+                 oFileProp.fileSize - nFileOffsetStart));
+    out = std::make_shared<std::string>();
+    out->resize(nExpectedSize + 1);
+    const size_t nRead = VSIFReadL(&(*out)[0], 1, out->size(), fp);
+    VSIFCloseL(fp);
+    if (nRead != nExpectedSize)
+        return nullptr;
+    out->resize(nExpectedSize);
+
+    CPLMutexHolder oHolder(&hMutex);
+    GetRegionCache()->insert(
+        FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out);
+    return out;
 }
 
 /************************************************************************/
@@ -3624,12 +4098,37 @@ void VSICurlFilesystemHandlerBase::AddRegion(const char *pszURL,
                                              vsi_l_offset nFileOffsetStart,
                                              size_t nSize, const char *pData)
 {
-    CPLMutexHolder oHolder(&hMutex);
+    {
+        CPLMutexHolder oHolder(&hMutex);
 
-    std::shared_ptr<std::string> value(new std::string());
-    value->assign(pData, nSize);
-    GetRegionCache()->insert(
-        FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), value);
+        std::shared_ptr<std::string> value(new std::string());
+        value->assign(pData, nSize);
+        GetRegionCache()->insert(
+            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), value);
+    }
+
+    const std::string osDiskCacheDir = VSICurlGetDiskCacheDir();
+    if (osDiskCacheDir.empty())
+        return;
+
+    FileProp oFileProp;
+    if (!GetCachedFileProp(pszURL, oFileProp))
+        return;
+    const std::string osValidator = VSICurlDiskCacheValidator(oFileProp);
+    if (osValidator.empty() || nFileOffsetStart >= oFileProp.fileSize ||
+        nSize != std::min(static_cast<vsi_l_offset>(
+                              VSICURLGetDownloadChunkSize()),
+                          oFileProp.fileSize - nFileOffsetStart))
+    {
+        return;
+    }
+    VSICurlDiskCacheWrite(
+        osDiskCacheDir,
+        VSICurlDiskCacheFilename(
+            osDiskCacheDir,
+            VSICurlDiskCacheRegionKey(pszURL, osValidator, nFileOffsetStart),
+            "region"),
+        pData, nSize);
 }
 
 /************************************************************************/
@@ -3649,7 +4148,49 @@ bool VSICurlFilesystemHandlerBase::GetCachedFileProp(const char *pszURL,
         }
         oCacheFileProp.remove(std::string(pszURL));
     }
-    return false;
+
+    // Properties persisted by another process are only trusted for
+    // CPL_VSIL_CURL_DISK_CACHE_FILE_PROP_TTL seconds. By default, they are
+    // not used, and a HEAD request validates the cached regions.
+    const std::string osDiskCacheDir = VSICurlGetDiskCacheDir();
+    const int nTTL = atoi(
+        CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_FILE_PROP_TTL", "0"));
+    if (osDiskCacheDir.empty() || nTTL <= 0)
+        return false;
+
+    const char *const apszOptions[] = {"EMIT_ERROR_IF_CANNOT_OPEN_FILE=NO",
+                                       nullptr};
+    const CPLStringList aosProps(CSLLoad2(
+        VSICurlDiskCacheFilename(osDiskCacheDir,
+                                 std::string("prop\n").append(pszURL), "prop")
+            .c_str(),
+        100, 1000, apszOptions));
+    const char *pszCachedURL = aosProps.FetchNameValue("URL");
+    if (pszCachedURL == nullptr || strcmp(pszCachedURL, pszURL) != 0 ||
+        CPLAtoGIntBig(aosProps.FetchNameValueDef("TIMESTAMP", "0")) + nTTL <
+            static_cast<GIntBig>(time(nullptr)))
+    {
+        return false;
+    }
+
+    FileProp oDiskFileProp;
+    oDiskFileProp.eExists = EXIST_YES;
+    oDiskFileProp.bHasComputedFileSize = true;
+    oDiskFileProp.fileSize = static_cast<vsi_l_offset>(
+        CPLAtoGIntBig(aosProps.FetchNameValueDef("SIZE", "0")));
+    oDiskFileProp.mTime = static_cast<time_t>(
+        CPLAtoGIntBig(aosProps.FetchNameValueDef("MTIME", "0")));
+    oDiskFileProp.ETag = aosProps.FetchNameValueDef("ETAG", "");
+    oDiskFileProp.nMode = atoi(aosProps.FetchNameValueDef("MODE", "0"));
+    if (VSICurlDiskCacheValidator(oDiskFileProp).empty())
+        return false;
+
+    // Do not go through SetCachedFileProp(), that would refresh the
+    // timestamp of the properties on disk.
+    oCacheFileProp.insert(std::string(pszURL), true);
+    VSICURLSetCachedFileProp(pszURL, oDiskFileProp);
+    oFileProp = std::move(oDiskFileProp);
+    return true;
 }
 
 /************************************************************************/
@@ -3659,9 +4200,48 @@ bool VSICurlFilesystemHandlerBase::GetCachedFileProp(const char *pszURL,
 void VSICurlFilesystemHandlerBase::SetCachedFileProp(const char *pszURL,
                                                      FileProp &oFileProp)
 {
-    CPLMutexHolder oHolder(&hMutex);
-    oCacheFileProp.insert(std::string(pszURL), true);
-    VSICURLSetCachedFileProp(pszURL, oFileProp);
+    const std::string osDiskCacheDir = VSICurlGetDiskCacheDir();
+    std::string osOldValidator;
+    {
+        CPLMutexHolder oHolder(&hMutex);
+
+        if (!osDiskCacheDir.empty())
+        {
+            FileProp oOldFileProp;
+            if (VSICURLGetCachedFileProp(pszURL, oOldFileProp))
+                osOldValidator = VSICurlDiskCacheValidator(oOldFileProp);
+        }
+
+        oCacheFileProp.insert(std::string(pszURL), true);
+        VSICURLSetCachedFileProp(pszURL, oFileProp);
+    }
+
+    // Only persist properties that come from a server response, not updates
+    // of other members of already known properties.
+    const std::string osValidator = VSICurlDiskCacheValidator(oFileProp);
+    if (osValidator.empty() || osValidator == osOldValidator)
+        return;
+    CPLStringList aosProps;
+    aosProps.SetNameValue("URL", pszURL);
+    aosProps.SetNameValue("TIMESTAMP",
+                          CPLSPrintf(CPL_FRMT_GIB,
+                                     static_cast<GIntBig>(time(nullptr))));
+    aosProps.SetNameValue(
+        "SIZE",
+        CPLSPrintf(CPL_FRMT_GUIB, static_cast<GUIntBig>(oFileProp.fileSize)));
+    aosProps.SetNameValue(
+        "MTIME",
+        CPLSPrintf(CPL_FRMT_GIB, static_cast<GIntBig>(oFileProp.mTime)));
+    aosProps.SetNameValue("ETAG", oFileProp.ETag.c_str());
+    aosProps.SetNameValue("MODE", CPLSPrintf("%d", oFileProp.nMode));
+    std::string osContent;
+    for (const char *pszLine : aosProps)
+        osContent.append(pszLine).append("\n");
+    VSICurlDiskCacheWrite(
+        osDiskCacheDir,
+        VSICurlDiskCacheFilename(osDiskCacheDir,
+                                 std::string("prop\n").append(pszURL), "prop"),
+        osContent.data(), osContent.size());
 }
 
 /************************************************************************/
@@ -3893,6 +4473,9 @@ const char *VSICurlFilesystemHandlerBase::GetActualURL(const char *pszFilename)
     "  <Option name='GDAL_HTTP_MERGE_CONSECUTIVE_RANGES' type='boolean' "      \
     "description='Whether to merge consecutive ranges in multirange "          \
     "requests' default='YES'/>"                                                \
+    "  <Option name='GDAL_HTTP_MERGE_RANGES_MAX_GAP' type='string' "           \
+    "description='Maximum number of bytes between two ranges in "              \
+    "multirange requests to merge them, or AUTO' default='0'/>"                \
     "  <Option name='CPL_VSIL_CURL_NON_CACHED' type='string' "                 \
     "description='Colon-separated list of filenames whose content"             \
     "must not be cached across open attempts'/>"                               \
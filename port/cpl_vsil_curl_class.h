@@ -38,6 +38,7 @@
 #include "cpl_string.h"
 #include "cpl_vsil_curl_priv.h"
 #include "cpl_mem_cache.h"
+#include "cpl_worker_thread_pool.h"
 
 #include "cpl_curl_priv.h"
 
@@ -401,6 +402,8 @@ class VSICurlHandle : public VSIVirtualHandle
     bool bEOF = false;
 
     virtual std::string DownloadRegion(vsi_l_offset startOffset, int nBlocks);
+    bool DownloadRegionsInParallel(vsi_l_offset startOffset, int nBlocks,
+                                   int nRequests);
 
     bool m_bUseHead = false;
     bool m_bUseRedirectURLIfNoQueryStringParams = false;
@@ -414,6 +417,12 @@ class VSICurlHandle : public VSIVirtualHandle
     int ReadMultiRangeSingleGet(int nRanges, void **ppData,
                                 const vsi_l_offset *panOffsets,
                                 const size_t *panSizes);
+
+    // Running estimates used to decide if ranges should be merged
+    double m_dfRequestLatency = 0.05;     // in seconds
+    double m_dfDownloadThroughput = 5e6;  // in bytes per second
+    size_t GetMergeRangesMaxGap() const;
+    void UpdateTransferEstimates(CURL *hCurlHandle, size_t nDownloaded);
     CPLString GetRedirectURLIfValid(bool &bHasExpired) const;
 
     void UpdateRedirectInfo(CURL *hCurlHandle,
@@ -563,6 +572,8 @@ class IVSIS3LikeFSHandler : public VSICurlFilesystemHandlerBaseWritable
 {
     CPL_DISALLOW_COPY_ASSIGN(IVSIS3LikeFSHandler)
 
+    friend class VSIS3WriteHandle;
+
     virtual int MkdirInternal(const char *pszDirname, long nMode,
                               bool bDoStatCheck);
 
@@ -712,7 +723,26 @@ class VSIS3WriteHandle final : public VSIVirtualHandle
     double m_dfRetryDelay = 0.0;
     WriteFuncStruct m_sWriteFuncHeaderData{};
 
+    // Background upload of parts, when VSI<KEY>_UPLOAD_NUM_THREADS > 1
+    // (VSIS3_UPLOAD_NUM_THREADS, VSIGS_UPLOAD_NUM_THREADS).
+    int m_nUploadThreads = 1;
+    std::unique_ptr<CPLWorkerThreadPool> m_poUploadPool{};
+    std::mutex m_oUploadMutex{};
+    std::vector<GByte *> m_apabyFreeBuffers{};  // protected by m_oUploadMutex
+    bool m_bUploadError = false;                // protected by m_oUploadMutex
+
+    struct UploadPartJob
+    {
+        VSIS3WriteHandle *poHandle = nullptr;
+        int nPartNumber = 0;
+        GByte *pabyBuffer = nullptr;
+        int nBufferSize = 0;
+    };
+
     bool UploadPart();
+    bool UploadPartInBackground();
+    static void UploadPartJobFunc(void *pData);
+    bool WaitBackgroundUploads();
     bool DoSinglePartPUT();
 
     static size_t ReadCallBackBufferChunked(char *buffer, size_t size,
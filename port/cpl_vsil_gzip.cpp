@@ -67,7 +67,9 @@
 
    For .gz files, an effort is done to cache the size of the uncompressed data
    in a .gz.properties file, so that we don't need to seek at the end of the
-   file each time a Stat() is done.
+   file each time a Stat() is done. Handles of recently closed .gz files, with
+   their snapshots, are also kept in a process-wide cache, so that re-opening
+   one of them does not need to uncompress it again from the start.
 
    For .zip and .gz, both reading and writing are supported, but just one mode
    at a time (read-only or write-only).
@@ -109,6 +111,8 @@
 #include <vector>
 
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
+#include "cpl_mem_cache.h"
 #include "cpl_minizip_ioapi.h"
 #include "cpl_minizip_unzip.h"
 #include "cpl_multiproc.h"
@@ -346,9 +350,23 @@ class VSIGZipFilesystemHandler final : public VSIFilesystemHandler
     CPL_DISALLOW_COPY_ASSIGN(VSIGZipFilesystemHandler)
 
     CPLMutex *hMutex = nullptr;
-    VSIGZipHandle *poHandleLastGZipFile = nullptr;
     bool m_bInSaveInfo = false;
 
+    // Cache of handles of recently closed files, with their snapshots,
+    // keyed by base filename.
+    struct CachedHandle
+    {
+        std::shared_ptr<VSIGZipHandle> poHandle{};
+        vsi_l_offset nFileSize = 0;
+        GIntBig nMTime = 0;
+    };
+
+    std::unique_ptr<lru11::Cache<std::string, CachedHandle>> m_poHandleCache{};
+
+    lru11::Cache<std::string, CachedHandle> &GetHandleCache();
+    std::shared_ptr<VSIGZipHandle>
+    GetCachedHandle_unlocked(const char *pszBaseFileName);
+
   public:
     VSIGZipFilesystemHandler() = default;
     ~VSIGZipFilesystemHandler() override;
@@ -410,6 +428,18 @@ VSIGZipHandle *VSIGZipHandle::Duplicate()
 
     poHandle->m_nLastReadOffset = m_nLastReadOffset;
 
+    if (poHandle->snapshot_byte_interval != snapshot_byte_interval)
+    {
+        // CPL_VSIL_GZIP_SNAPSHOT_COUNT has changed since this handle was
+        // created: use its layout of snapshots.
+        CPLFree(poHandle->snapshots);
+        poHandle->snapshot_byte_interval = snapshot_byte_interval;
+        poHandle->snapshots = static_cast<GZipSnapshot *>(CPLCalloc(
+            sizeof(GZipSnapshot),
+            static_cast<size_t>(m_compressed_size / snapshot_byte_interval +
+                                1)));
+    }
+
     // Most important: duplicate the snapshots!
 
     for (unsigned int i = 0; i < m_compressed_size / snapshot_byte_interval + 1;
@@ -513,8 +543,12 @@ VSIGZipHandle::VSIGZipHandle(VSIVirtualHandle *poBaseHandle,
 
     if (transparent == 0)
     {
+        // Each snapshot holds a copy of the inflate state, that is about
+        // 40 KB.
+        const int nSnapshotCount = std::max(
+            1, atoi(CPLGetConfigOption("CPL_VSIL_GZIP_SNAPSHOT_COUNT", "100")));
         snapshot_byte_interval = std::max(static_cast<vsi_l_offset>(Z_BUFSIZE),
-                                          compressed_size / 100);
+                                          compressed_size / nSnapshotCount);
         snapshots = static_cast<GZipSnapshot *>(CPLCalloc(
             sizeof(GZipSnapshot),
             static_cast<size_t>(compressed_size / snapshot_byte_interval + 1)));
@@ -2885,6 +2919,247 @@ vsi_l_offset VSIGZipWriteHandle::Tell()
     return nCurOffset;
 }
 
+/************************************************************************/
+/*                   VSIGZipGetDecompressionThreads()                   */
+/************************************************************************/
+
+// Number of threads that may be used for decompression, according to
+// GDAL_NUM_THREADS. Contrary to compression, defaults to 1.
+static int VSIGZipGetDecompressionThreads()
+{
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszThreads == nullptr)
+        return 1;
+    const int nThreads =
+        EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads);
+    return std::max(1, std::min(128, nThreads));
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                        VSIGZipReadAheadHandle                        */
+/* ==================================================================== */
+/************************************************************************/
+
+// Wraps a handle on a deflate stream, and uncompresses in a worker thread
+// the buffer following the one being consumed by the caller, so that
+// decompression overlaps with the processing done by the caller.
+
+class VSIGZipReadAheadHandle final : public VSIVirtualHandle
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIGZipReadAheadHandle)
+
+    static constexpr size_t BUFFER_SIZE = 1024 * 1024;
+
+    std::unique_ptr<VSIVirtualHandle> m_poBaseHandle;
+    std::unique_ptr<CPLWorkerThreadPool> m_poPool{};
+
+    // Buffer being consumed, starting at offset m_nCurBufferOffset
+    std::vector<GByte> m_abyCurBuffer{};
+    vsi_l_offset m_nCurBufferOffset = 0;
+    size_t m_nPosInCurBuffer = 0;
+
+    // Buffer following the current one, filled by the worker thread
+    std::vector<GByte> m_abyNextBuffer{};
+    std::vector<CPLErrorHandlerAccumulatorStruct> m_aoNextBufferErrors{};
+    bool m_bNextBufferPending = false;
+
+    bool m_bBaseEOF = false;
+    bool m_bEOF = false;
+
+    static void ReadNextBufferJob(void *pData);
+    void WaitNextBuffer();
+
+  public:
+    explicit VSIGZipReadAheadHandle(VSIVirtualHandle *poBaseHandle)
+        : m_poBaseHandle(poBaseHandle)
+    {
+    }
+
+    ~VSIGZipReadAheadHandle() override;
+
+    int Seek(vsi_l_offset nOffset, int nWhence) override;
+
+    vsi_l_offset Tell() override
+    {
+        return m_nCurBufferOffset + m_nPosInCurBuffer;
+    }
+
+    size_t Read(void *pBuffer, size_t nSize, size_t nCount) override;
+
+    size_t Write(const void *, size_t, size_t) override
+    {
+        return 0;
+    }
+
+    int Eof() override
+    {
+        return m_bEOF;
+    }
+
+    int Close() override;
+};
+
+/************************************************************************/
+/*                      ~VSIGZipReadAheadHandle()                       */
+/************************************************************************/
+
+VSIGZipReadAheadHandle::~VSIGZipReadAheadHandle()
+{
+    VSIGZipReadAheadHandle::Close();
+}
+
+/************************************************************************/
+/*                               Close()                                */
+/************************************************************************/
+
+int VSIGZipReadAheadHandle::Close()
+{
+    if (!m_poBaseHandle)
+        return 0;
+    WaitNextBuffer();
+    const int nRet = m_poBaseHandle->Close();
+    m_poBaseHandle.reset();
+    return nRet;
+}
+
+/************************************************************************/
+/*                         ReadNextBufferJob()                          */
+/************************************************************************/
+
+void VSIGZipReadAheadHandle::ReadNextBufferJob(void *pData)
+{
+    auto poThis = static_cast<VSIGZipReadAheadHandle *>(pData);
+    // Errors are emitted in the caller thread when the buffer is consumed
+    CPLInstallErrorHandlerAccumulator(poThis->m_aoNextBufferErrors);
+    poThis->m_abyNextBuffer.resize(BUFFER_SIZE);
+    poThis->m_abyNextBuffer.resize(poThis->m_poBaseHandle->Read(
+        poThis->m_abyNextBuffer.data(), 1, BUFFER_SIZE));
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+/************************************************************************/
+/*                           WaitNextBuffer()                           */
+/************************************************************************/
+
+void VSIGZipReadAheadHandle::WaitNextBuffer()
+{
+    if (m_bNextBufferPending)
+    {
+        m_poPool->WaitCompletion();
+        m_bNextBufferPending = false;
+    }
+}
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+int VSIGZipReadAheadHandle::Seek(vsi_l_offset nOffset, int nWhence)
+{
+    m_bEOF = false;
+    if (nWhence == SEEK_CUR)
+        nOffset += Tell();
+    else if (nWhence == SEEK_END)
+    {
+        WaitNextBuffer();
+        m_aoNextBufferErrors.clear();
+        if (m_poBaseHandle->Seek(0, SEEK_END) != 0)
+            return -1;
+        m_abyCurBuffer.clear();
+        m_nCurBufferOffset = m_poBaseHandle->Tell();
+        m_nPosInCurBuffer = 0;
+        m_bBaseEOF = false;
+        return 0;
+    }
+
+    // Seeking within the current buffer does not interrupt read-ahead
+    if (nOffset >= m_nCurBufferOffset &&
+        nOffset - m_nCurBufferOffset <= m_abyCurBuffer.size())
+    {
+        m_nPosInCurBuffer = static_cast<size_t>(nOffset - m_nCurBufferOffset);
+        return 0;
+    }
+
+    WaitNextBuffer();
+    m_aoNextBufferErrors.clear();
+    if (m_poBaseHandle->Seek(nOffset, SEEK_SET) != 0)
+        return -1;
+    m_abyCurBuffer.clear();
+    m_nCurBufferOffset = nOffset;
+    m_nPosInCurBuffer = 0;
+    m_bBaseEOF = false;
+    return 0;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+size_t VSIGZipReadAheadHandle::Read(void *pBuffer, size_t nSize, size_t nCount)
+{
+    const size_t nToRead = nSize * nCount;
+    size_t nRead = 0;
+    while (nRead < nToRead)
+    {
+        if (m_nPosInCurBuffer == m_abyCurBuffer.size())
+        {
+            // Switch to the next buffer
+            m_nCurBufferOffset += m_abyCurBuffer.size();
+            m_nPosInCurBuffer = 0;
+            if (m_bNextBufferPending)
+            {
+                WaitNextBuffer();
+                std::swap(m_abyCurBuffer, m_abyNextBuffer);
+                for (const auto &oError : m_aoNextBufferErrors)
+                    CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+                m_aoNextBufferErrors.clear();
+            }
+            else if (!m_bBaseEOF)
+            {
+                m_abyCurBuffer.resize(BUFFER_SIZE);
+                m_abyCurBuffer.resize(m_poBaseHandle->Read(
+                    m_abyCurBuffer.data(), 1, BUFFER_SIZE));
+            }
+            else
+            {
+                m_abyCurBuffer.clear();
+            }
+            m_bBaseEOF = m_abyCurBuffer.size() < BUFFER_SIZE;
+            if (m_abyCurBuffer.empty())
+            {
+                m_bEOF = true;
+                break;
+            }
+
+            // Start uncompressing the next buffer while the caller
+            // processes this one.
+            if (!m_bBaseEOF)
+            {
+                if (!m_poPool)
+                {
+                    m_poPool = std::make_unique<CPLWorkerThreadPool>();
+                    if (!m_poPool->Setup(1, nullptr, nullptr, false))
+                        m_poPool.reset();
+                }
+                if (m_poPool &&
+                    m_poPool->SubmitJob(ReadNextBufferJob, this))
+                {
+                    m_bNextBufferPending = true;
+                }
+            }
+        }
+
+        const size_t nToCopy = std::min(
+            nToRead - nRead, m_abyCurBuffer.size() - m_nPosInCurBuffer);
+        memcpy(static_cast<GByte *>(pBuffer) + nRead,
+               m_abyCurBuffer.data() + m_nPosInCurBuffer, nToCopy);
+        nRead += nToCopy;
+        m_nPosInCurBuffer += nToCopy;
+    }
+    return nSize ? nRead / nSize : 0;
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                       VSIGZipFilesystemHandler                       */
@@ -2897,11 +3172,7 @@ vsi_l_offset VSIGZipWriteHandle::Tell()
 
 VSIGZipFilesystemHandler::~VSIGZipFilesystemHandler()
 {
-    if (poHandleLastGZipFile)
-    {
-        poHandleLastGZipFile->UnsetCanSaveInfo();
-        delete poHandleLastGZipFile;
-    }
+    m_poHandleCache.reset();
 
     if (hMutex != nullptr)
         CPLDestroyMutex(hMutex);
@@ -2924,30 +3195,76 @@ void VSIGZipFilesystemHandler::SaveInfo_unlocked(VSIGZipHandle *poHandle)
         return;
     m_bInSaveInfo = true;
 
-    CPLAssert(poHandle != poHandleLastGZipFile);
     CPLAssert(poHandle->GetBaseFileName() != nullptr);
 
-    if (poHandleLastGZipFile == nullptr ||
-        strcmp(poHandleLastGZipFile->GetBaseFileName(),
-               poHandle->GetBaseFileName()) != 0 ||
-        poHandle->GetLastReadOffset() >
-            poHandleLastGZipFile->GetLastReadOffset())
+    auto poCachedHandle = GetCachedHandle_unlocked(poHandle->GetBaseFileName());
+    if (poCachedHandle == nullptr ||
+        poHandle->GetLastReadOffset() > poCachedHandle->GetLastReadOffset())
     {
-        VSIGZipHandle *poTmp = poHandleLastGZipFile;
-        poHandleLastGZipFile = nullptr;
-        if (poTmp)
+        VSIStatBufL sStat;
+        VSIGZipHandle *poNewCachedHandle = nullptr;
+        if (VSIStatL(poHandle->GetBaseFileName(), &sStat) == 0)
+            poNewCachedHandle = poHandle->Duplicate();
+        if (poNewCachedHandle)
         {
-            poTmp->UnsetCanSaveInfo();
-            delete poTmp;
+            poNewCachedHandle->CloseBaseHandle();
+            CachedHandle oEntry;
+            oEntry.poHandle.reset(poNewCachedHandle,
+                                  [](VSIGZipHandle *poHandleToDelete)
+                                  {
+                                      poHandleToDelete->UnsetCanSaveInfo();
+                                      delete poHandleToDelete;
+                                  });
+            oEntry.nFileSize = static_cast<vsi_l_offset>(sStat.st_size);
+            oEntry.nMTime = static_cast<GIntBig>(sStat.st_mtime);
+            GetHandleCache().insert(poHandle->GetBaseFileName(), oEntry);
         }
-        CPLAssert(poHandleLastGZipFile == nullptr);
-        poHandleLastGZipFile = poHandle->Duplicate();
-        if (poHandleLastGZipFile)
-            poHandleLastGZipFile->CloseBaseHandle();
     }
     m_bInSaveInfo = false;
 }
 
+/************************************************************************/
+/*                           GetHandleCache()                           */
+/************************************************************************/
+
+lru11::Cache<std::string, VSIGZipFilesystemHandler::CachedHandle> &
+VSIGZipFilesystemHandler::GetHandleCache()
+{
+    if (!m_poHandleCache)
+    {
+        const int nCacheSize = std::max(
+            1, atoi(CPLGetConfigOption("CPL_VSIL_GZIP_CACHE_SIZE", "4")));
+        m_poHandleCache =
+            std::make_unique<lru11::Cache<std::string, CachedHandle>>(
+                nCacheSize, 0);
+    }
+    return *m_poHandleCache;
+}
+
+/************************************************************************/
+/*                       GetCachedHandle_unlocked()                     */
+/************************************************************************/
+
+/** Return the cached handle of a .gz file, provided that its size and
+ * modification time have not changed since it was cached. */
+std::shared_ptr<VSIGZipHandle>
+VSIGZipFilesystemHandler::GetCachedHandle_unlocked(const char *pszBaseFileName)
+{
+    CachedHandle oEntry;
+    if (!GetHandleCache().tryGet(pszBaseFileName, oEntry))
+        return nullptr;
+
+    VSIStatBufL sStat;
+    if (VSIStatL(pszBaseFileName, &sStat) != 0 ||
+        static_cast<vsi_l_offset>(sStat.st_size) != oEntry.nFileSize ||
+        static_cast<GIntBig>(sStat.st_mtime) != oEntry.nMTime)
+    {
+        GetHandleCache().remove(pszBaseFileName);
+        return nullptr;
+    }
+    return oEntry.poHandle;
+}
+
 /************************************************************************/
 /*                                Open()                                */
 /************************************************************************/
@@ -2994,10 +3311,15 @@ VSIGZipFilesystemHandler::Open(const char *pszFilename, const char *pszAccess,
 
     VSIGZipHandle *poGZIPHandle = OpenGZipReadOnly(pszFilename, pszAccess);
     if (poGZIPHandle)
+    {
+        VSIVirtualHandle *poHandle = poGZIPHandle;
+        if (VSIGZipGetDecompressionThreads() > 1)
+            poHandle = new VSIGZipReadAheadHandle(poHandle);
         // Wrap the VSIGZipHandle inside a buffered reader that will
         // improve dramatically performance when doing small backward
         // seeks.
-        return VSICreateBufferedReaderHandle(poGZIPHandle);
+        return VSICreateBufferedReaderHandle(poHandle);
+    }
 
     return nullptr;
 }
@@ -3033,16 +3355,16 @@ VSIGZipFilesystemHandler::OpenGZipReadOnly(const char *pszFilename,
 #ifndef FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
     // Disable caching in fuzzing mode as the /vsigzip/ file is likely to
     // change very often
-    // TODO: filename-based logic isn't enough. We should probably check
-    // timestamp and/or file size.
-    if (poHandleLastGZipFile != nullptr &&
-        strcmp(pszFilename + strlen("/vsigzip/"),
-               poHandleLastGZipFile->GetBaseFileName()) == 0 &&
-        EQUAL(pszAccess, "rb"))
-    {
-        VSIGZipHandle *poHandle = poHandleLastGZipFile->Duplicate();
-        if (poHandle)
-            return poHandle;
+    if (EQUAL(pszAccess, "rb"))
+    {
+        auto poCachedHandle =
+            GetCachedHandle_unlocked(pszFilename + strlen("/vsigzip/"));
+        if (poCachedHandle)
+        {
+            VSIGZipHandle *poHandle = poCachedHandle->Duplicate();
+            if (poHandle)
+                return poHandle;
+        }
     }
 #else
     CPL_IGNORE_RET_VAL(pszAccess);
@@ -3063,13 +3385,6 @@ VSIGZipFilesystemHandler::OpenGZipReadOnly(const char *pszFilename,
         return nullptr;
     }
 
-    if (poHandleLastGZipFile)
-    {
-        poHandleLastGZipFile->UnsetCanSaveInfo();
-        delete poHandleLastGZipFile;
-        poHandleLastGZipFile = nullptr;
-    }
-
     VSIGZipHandle *poHandle =
         new VSIGZipHandle(poVirtualHandle, pszFilename + strlen("/vsigzip/"));
     if (!(poHandle->IsInitOK()))
@@ -3094,16 +3409,13 @@ int VSIGZipFilesystemHandler::Stat(const char *pszFilename,
 
     memset(pStatBuf, 0, sizeof(VSIStatBufL));
 
-    if (poHandleLastGZipFile != nullptr &&
-        strcmp(pszFilename + strlen("/vsigzip/"),
-               poHandleLastGZipFile->GetBaseFileName()) == 0)
+    auto poCachedHandle =
+        GetCachedHandle_unlocked(pszFilename + strlen("/vsigzip/"));
+    if (poCachedHandle && poCachedHandle->GetUncompressedSize() != 0)
     {
-        if (poHandleLastGZipFile->GetUncompressedSize() != 0)
-        {
-            pStatBuf->st_mode = S_IFREG;
-            pStatBuf->st_size = poHandleLastGZipFile->GetUncompressedSize();
-            return 0;
-        }
+        pStatBuf->st_mode = S_IFREG;
+        pStatBuf->st_size = poCachedHandle->GetUncompressedSize();
+        return 0;
     }
 
     // Begin by doing a stat on the real file.
@@ -3239,8 +3551,8 @@ const char *VSIGZipFilesystemHandler::GetOptions()
 {
     return "<Options>"
            "  <Option name='GDAL_NUM_THREADS' type='string' "
-           "description='Number of threads for compression. Either a integer "
-           "or ALL_CPUS'/>"
+           "description='Number of threads for compression and "
+           "decompression. Either a integer or ALL_CPUS'/>"
            "  <Option name='CPL_VSIL_DEFLATE_CHUNK_SIZE' type='string' "
            "description='Chunk of uncompressed data for parallelization. "
            "Use K(ilobytes) or M(egabytes) suffix' default='1M'/>"
@@ -3663,6 +3975,27 @@ class VSISOZipHandle final : public VSIVirtualHandle
     z_stream sStream_{};
 #endif
 
+    // Multi-threaded decompression, enabled with GDAL_NUM_THREADS
+    int nThreads_ = 1;
+    std::unique_ptr<CPLWorkerThreadPool> poPool_{};
+    // End of the last read, to detect sequential reads
+    vsi_l_offset nLastReadEnd_ = 0;
+    // Chunks uncompressed ahead during a sequential read
+    std::map<uint64_t, std::vector<GByte>> oMapChunksReadAhead_{};
+
+    struct DecompressJobData
+    {
+        GByte *pabyCompressed = nullptr;
+        size_t nCompressedSize = 0;
+        GByte *pabyOut = nullptr;
+        size_t nOutSize = 0;
+        uint64_t nPos = 0;
+        bool bOK = false;
+        std::string osErrorMsg{};
+    };
+
+    static void DecompressJob(void *pData);
+
     VSISOZipHandle(const VSISOZipHandle &) = delete;
     VSISOZipHandle &operator=(const VSISOZipHandle &) = delete;
 
@@ -3708,7 +4041,8 @@ VSISOZipHandle::VSISOZipHandle(VSIVirtualHandle *poVirtualHandle,
     : poBaseHandle_(poVirtualHandle),
       nPosCompressedStream_(nPosCompressedStream),
       compressed_size_(compressed_size), uncompressed_size_(uncompressed_size),
-      indexPos_(indexPos), nToSkip_(nToSkip), nChunkSize_(nChunkSize)
+      indexPos_(indexPos), nToSkip_(nToSkip), nChunkSize_(nChunkSize),
+      nThreads_(VSIGZipGetDecompressionThreads())
 {
 #ifdef HAVE_LIBDEFLATE
     pDecompressor_ = libdeflate_alloc_decompressor();
@@ -3766,6 +4100,116 @@ int VSISOZipHandle::Seek(vsi_l_offset nOffset, int nWhence)
     return 0;
 }
 
+/************************************************************************/
+/*                      VSISOZipDecompressChunk()                       */
+/************************************************************************/
+
+// Uncompress a SOZip chunk of nCompressedSize bytes, that is modified in
+// place, into exactly nOutSize bytes. Safe to call from a worker thread:
+// errors are returned in osErrorMsg.
+#ifdef HAVE_LIBDEFLATE
+static bool
+VSISOZipDecompressChunk(struct libdeflate_decompressor *pDecompressor,
+#else
+static bool VSISOZipDecompressChunk(z_stream *psStream,
+#endif
+                        GByte *pabyCompressed, size_t nCompressedSize,
+                        GByte *pabyOut, size_t nOutSize, uint64_t nPos,
+                        std::string &osErrorMsg)
+{
+    if (nCompressedSize >= 5 && pabyCompressed[nCompressedSize - 5] == 0x00 &&
+        memcmp(&pabyCompressed[nCompressedSize - 4], "\x00\x00\xFF\xFF", 4) ==
+            0)
+    {
+        // Tag this flush block as the last one.
+        pabyCompressed[nCompressedSize - 5] = 0x01;
+    }
+
+#ifdef HAVE_LIBDEFLATE
+    size_t nOut = 0;
+    if (libdeflate_deflate_decompress(pDecompressor, pabyCompressed,
+                                      nCompressedSize, pabyOut, nOutSize,
+                                      &nOut) != LIBDEFLATE_SUCCESS)
+    {
+        osErrorMsg = CPLSPrintf(
+            "libdeflate_deflate_decompress() failed at pos " CPL_FRMT_GUIB,
+            static_cast<GUIntBig>(nPos));
+        return false;
+    }
+    if (nOut != nOutSize)
+    {
+        osErrorMsg =
+            CPLSPrintf("Only %u bytes decompressed at pos " CPL_FRMT_GUIB
+                       " whereas %u where expected",
+                       static_cast<unsigned>(nOut), static_cast<GUIntBig>(nPos),
+                       static_cast<unsigned>(nOutSize));
+        return false;
+    }
+#else
+    psStream->avail_in = static_cast<uInt>(nCompressedSize);
+    psStream->next_in = pabyCompressed;
+    psStream->avail_out = static_cast<uInt>(nOutSize);
+    psStream->next_out = pabyOut;
+
+    int err = inflate(psStream, Z_FINISH);
+    if ((err != Z_OK && err != Z_STREAM_END))
+    {
+        osErrorMsg = CPLSPrintf("inflate() failed at pos " CPL_FRMT_GUIB,
+                                static_cast<GUIntBig>(nPos));
+        inflateReset(psStream);
+        return false;
+    }
+    if (psStream->avail_in != 0)
+        CPLDebug("VSIZIP", "avail_in = %d", psStream->avail_in);
+    if (psStream->avail_out != 0)
+    {
+        osErrorMsg = CPLSPrintf(
+            "Only %u bytes decompressed at pos " CPL_FRMT_GUIB
+            " whereas %u where expected",
+            static_cast<unsigned>(nOutSize - psStream->avail_out),
+            static_cast<GUIntBig>(nPos), static_cast<unsigned>(nOutSize));
+        inflateReset(psStream);
+        return false;
+    }
+    inflateReset(psStream);
+#endif
+    return true;
+}
+
+/************************************************************************/
+/*                           DecompressJob()                            */
+/************************************************************************/
+
+void VSISOZipHandle::DecompressJob(void *pData)
+{
+    auto psJob = static_cast<DecompressJobData *>(pData);
+#ifdef HAVE_LIBDEFLATE
+    struct libdeflate_decompressor *pDecompressor =
+        libdeflate_alloc_decompressor();
+    if (!pDecompressor)
+    {
+        psJob->osErrorMsg = "libdeflate_alloc_decompressor() failed";
+        return;
+    }
+    psJob->bOK = VSISOZipDecompressChunk(
+        pDecompressor, psJob->pabyCompressed, psJob->nCompressedSize,
+        psJob->pabyOut, psJob->nOutSize, psJob->nPos, psJob->osErrorMsg);
+    libdeflate_free_decompressor(pDecompressor);
+#else
+    z_stream sStream;
+    memset(&sStream, 0, sizeof(sStream));
+    if (inflateInit2(&sStream, -MAX_WBITS) != Z_OK)
+    {
+        psJob->osErrorMsg = "inflateInit2() failed";
+        return;
+    }
+    psJob->bOK = VSISOZipDecompressChunk(
+        &sStream, psJob->pabyCompressed, psJob->nCompressedSize,
+        psJob->pabyOut, psJob->nOutSize, psJob->nPos, psJob->osErrorMsg);
+    inflateEnd(&sStream);
+#endif
+}
+
 /************************************************************************/
 /*                              Read()                                  */
 /************************************************************************/
@@ -3822,131 +4266,188 @@ size_t VSISOZipHandle::Read(void *pBuffer, size_t nSize, size_t nCount)
         return nOffset;
     };
 
-    size_t nOffsetInOutputBuffer = 0;
-    while (true)
+    GByte *pabyOut = static_cast<GByte *>(pBuffer);
+    uint64_t nChunkIdx = nCurPos_ / nChunkSize_;
+    const bool bSequential = nCurPos_ == nLastReadEnd_;
+
+    // Use chunks uncompressed by a previous sequential read, if any.
+    if (bSequential)
     {
-        uint64_t nOffsetInCompressedStream =
-            ReadOffsetInCompressedStream(nCurPos_ / nChunkSize_);
-        if (nOffsetInCompressedStream == static_cast<uint64_t>(-1))
+        while (nToRead > 0)
         {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Cannot read nOffsetInCompressedStream");
-            return 0;
+            auto oIter = oMapChunksReadAhead_.find(nChunkIdx);
+            if (oIter == oMapChunksReadAhead_.end())
+                break;
+            const size_t nThisChunkSize = oIter->second.size();
+            if (nThisChunkSize > nToRead)
+                break;
+            memcpy(pabyOut, oIter->second.data(), nThisChunkSize);
+            oMapChunksReadAhead_.erase(oIter);
+            pabyOut += nThisChunkSize;
+            nCurPos_ += nThisChunkSize;
+            nToRead -= nThisChunkSize;
+            ++nChunkIdx;
         }
-        uint64_t nNextOffsetInCompressedStream =
-            ReadOffsetInCompressedStream(1 + nCurPos_ / nChunkSize_);
-        if (nNextOffsetInCompressedStream == static_cast<uint64_t>(-1))
+    }
+    oMapChunksReadAhead_.clear();
+    if (nToRead == 0)
+    {
+        nLastReadEnd_ = nCurPos_;
+        return nCount;
+    }
+
+    // Number of chunks requested by the caller, and number of following
+    // chunks to uncompress ahead when reading sequentially with several
+    // threads.
+    const uint64_t nTotalChunkCount =
+        1 + (uncompressed_size_ - 1) / nChunkSize_;
+    const size_t nChunkCount = (nToRead + nChunkSize_ - 1) / nChunkSize_;
+    size_t nChunkCountAhead = 0;
+    if (bSequential && nThreads_ > 1 &&
+        nChunkCount < static_cast<size_t>(nThreads_))
+    {
+        nChunkCountAhead = static_cast<size_t>(
+            std::min(static_cast<uint64_t>(nThreads_ - nChunkCount),
+                     nTotalChunkCount - nChunkIdx - nChunkCount));
+    }
+    const size_t nChunksToUncompress = nChunkCount + nChunkCountAhead;
+
+    std::vector<uint64_t> anOffsetInCompressedStream(nChunksToUncompress + 1);
+    for (size_t i = 0; i <= nChunksToUncompress; ++i)
+    {
+        anOffsetInCompressedStream[i] =
+            ReadOffsetInCompressedStream(nChunkIdx + i);
+        if (anOffsetInCompressedStream[i] == static_cast<uint64_t>(-1))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
-                     "Cannot read nNextOffsetInCompressedStream");
+                     "Cannot read nOffsetInCompressedStream");
             return 0;
         }
-
-        if (nNextOffsetInCompressedStream <= nOffsetInCompressedStream ||
-            nNextOffsetInCompressedStream - nOffsetInCompressedStream >
-                13 + 2 * nChunkSize_ ||
-            nNextOffsetInCompressedStream > compressed_size_)
+        if (i > 0)
         {
-            CPLError(
-                CE_Failure, CPLE_AppDefined,
-                "Invalid values for nOffsetInCompressedStream (" CPL_FRMT_GUIB
-                ") / "
-                "nNextOffsetInCompressedStream(" CPL_FRMT_GUIB ")",
-                static_cast<GUIntBig>(nOffsetInCompressedStream),
-                static_cast<GUIntBig>(nNextOffsetInCompressedStream));
-            return 0;
+            const uint64_t nOffsetInCompressedStream =
+                anOffsetInCompressedStream[i - 1];
+            const uint64_t nNextOffsetInCompressedStream =
+                anOffsetInCompressedStream[i];
+            if (nNextOffsetInCompressedStream <= nOffsetInCompressedStream ||
+                nNextOffsetInCompressedStream - nOffsetInCompressedStream >
+                    13 + 2 * nChunkSize_ ||
+                nNextOffsetInCompressedStream > compressed_size_)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Invalid values for nOffsetInCompressedStream "
+                         "(" CPL_FRMT_GUIB ") / "
+                         "nNextOffsetInCompressedStream(" CPL_FRMT_GUIB ")",
+                         static_cast<GUIntBig>(nOffsetInCompressedStream),
+                         static_cast<GUIntBig>(nNextOffsetInCompressedStream));
+                return 0;
+            }
         }
+    }
 
-        // CPLDebug("VSIZIP", "Seek to compressed data at offset "
-        // CPL_FRMT_GUIB, static_cast<GUIntBig>(nPosCompressedStream_ +
-        // nOffsetInCompressedStream));
-        if (poBaseHandle_->Seek(
-                nPosCompressedStream_ + nOffsetInCompressedStream, SEEK_SET) !=
-            0)
-            return 0;
-
-        const int nCompressedToRead = static_cast<int>(
-            nNextOffsetInCompressedStream - nOffsetInCompressedStream);
-        // CPLDebug("VSIZIP", "nCompressedToRead = %d", nCompressedToRead);
-        std::vector<GByte> abyCompressedData(nCompressedToRead);
-        if (poBaseHandle_->Read(&abyCompressedData[0], nCompressedToRead, 1) !=
+    // Read the compressed data of all chunks at once, as they are
+    // contiguous.
+    const size_t nCompressedToRead =
+        static_cast<size_t>(anOffsetInCompressedStream[nChunksToUncompress] -
+                            anOffsetInCompressedStream[0]);
+    std::vector<GByte> abyCompressedData;
+    try
+    {
+        abyCompressedData.resize(nCompressedToRead);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for compressed data");
+        return 0;
+    }
+    if (poBaseHandle_->Seek(nPosCompressedStream_ +
+                                anOffsetInCompressedStream[0],
+                            SEEK_SET) != 0 ||
+        poBaseHandle_->Read(abyCompressedData.data(), nCompressedToRead, 1) !=
             1)
-            return 0;
-
-        size_t nToReadThisIter =
-            std::min(nToRead, static_cast<size_t>(nChunkSize_));
+        return 0;
 
-        if (nCompressedToRead >= 5 &&
-            abyCompressedData[nCompressedToRead - 5] == 0x00 &&
-            memcmp(&abyCompressedData[nCompressedToRead - 4],
-                   "\x00\x00\xFF\xFF", 4) == 0)
+    std::vector<std::vector<GByte>> aabyChunksAhead(nChunkCountAhead);
+    std::vector<DecompressJobData> asJobs(nChunksToUncompress);
+    for (size_t i = 0; i < nChunksToUncompress; ++i)
+    {
+        auto &sJob = asJobs[i];
+        sJob.pabyCompressed =
+            abyCompressedData.data() +
+            static_cast<size_t>(anOffsetInCompressedStream[i] -
+                                anOffsetInCompressedStream[0]);
+        sJob.nCompressedSize =
+            static_cast<size_t>(anOffsetInCompressedStream[i + 1] -
+                                anOffsetInCompressedStream[i]);
+        sJob.nPos = (nChunkIdx + i) * nChunkSize_;
+        sJob.nOutSize = static_cast<size_t>(
+            std::min(static_cast<uint64_t>(nChunkSize_),
+                     uncompressed_size_ - sJob.nPos));
+        if (i < nChunkCount)
         {
-            // Tag this flush block as the last one.
-            abyCompressedData[nCompressedToRead - 5] = 0x01;
+            sJob.pabyOut = pabyOut + i * nChunkSize_;
         }
-
-#ifdef HAVE_LIBDEFLATE
-        size_t nOut = 0;
-        if (libdeflate_deflate_decompress(
-                pDecompressor_, &abyCompressedData[0], nCompressedToRead,
-                static_cast<Bytef *>(pBuffer) + nOffsetInOutputBuffer,
-                nToReadThisIter, &nOut) != LIBDEFLATE_SUCCESS)
+        else
         {
-            CPLError(
-                CE_Failure, CPLE_AppDefined,
-                "libdeflate_deflate_decompress() failed at pos " CPL_FRMT_GUIB,
-                static_cast<GUIntBig>(nCurPos_));
-            return 0;
+            auto &abyChunk = aabyChunksAhead[i - nChunkCount];
+            abyChunk.resize(sJob.nOutSize);
+            sJob.pabyOut = abyChunk.data();
         }
-        if (nOut != nToReadThisIter)
+    }
+
+    if (nChunksToUncompress > 1 && nThreads_ > 1 && !poPool_)
+    {
+        poPool_ = std::make_unique<CPLWorkerThreadPool>();
+        if (!poPool_->Setup(nThreads_, nullptr, nullptr, false))
+            poPool_.reset();
+    }
+    if (nChunksToUncompress > 1 && poPool_)
+    {
+        std::vector<void *> apData;
+        for (auto &sJob : asJobs)
+            apData.push_back(&sJob);
+        poPool_->SubmitJobs(DecompressJob, apData);
+        poPool_->WaitCompletion();
+    }
+    else
+    {
+        for (auto &sJob : asJobs)
         {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Only %u bytes decompressed at pos " CPL_FRMT_GUIB
-                     " whereas %u where expected",
-                     static_cast<unsigned>(nOut),
-                     static_cast<GUIntBig>(nCurPos_),
-                     static_cast<unsigned>(nToReadThisIter));
-            return 0;
-        }
+            sJob.bOK = VSISOZipDecompressChunk(
+#ifdef HAVE_LIBDEFLATE
+                pDecompressor_,
 #else
-        sStream_.avail_in = nCompressedToRead;
-        sStream_.next_in = &abyCompressedData[0];
-        sStream_.avail_out = static_cast<int>(nToReadThisIter);
-        sStream_.next_out =
-            static_cast<Bytef *>(pBuffer) + nOffsetInOutputBuffer;
-
-        int err = inflate(&sStream_, Z_FINISH);
-        if ((err != Z_OK && err != Z_STREAM_END))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "inflate() failed at pos " CPL_FRMT_GUIB,
-                     static_cast<GUIntBig>(nCurPos_));
-            inflateReset(&sStream_);
-            return 0;
+                &sStream_,
+#endif
+                sJob.pabyCompressed, sJob.nCompressedSize, sJob.pabyOut,
+                sJob.nOutSize, sJob.nPos, sJob.osErrorMsg);
+            if (!sJob.bOK)
+                break;
         }
-        if (sStream_.avail_in != 0)
-            CPLDebug("VSIZIP", "avail_in = %d", sStream_.avail_in);
-        if (sStream_.avail_out != 0)
+    }
+
+    for (size_t i = 0; i < nChunkCount; ++i)
+    {
+        if (!asJobs[i].bOK)
         {
-            CPLError(
-                CE_Failure, CPLE_AppDefined,
-                "Only %u bytes decompressed at pos " CPL_FRMT_GUIB
-                " whereas %u where expected",
-                static_cast<unsigned>(nToReadThisIter - sStream_.avail_out),
-                static_cast<GUIntBig>(nCurPos_),
-                static_cast<unsigned>(nToReadThisIter));
-            inflateReset(&sStream_);
+            CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                     asJobs[i].osErrorMsg.c_str());
             return 0;
         }
-        inflateReset(&sStream_);
-#endif
-        nOffsetInOutputBuffer += nToReadThisIter;
-        nCurPos_ += nToReadThisIter;
-        nToRead -= nToReadThisIter;
-        if (nToRead == 0)
+    }
+    // Chunks uncompressed ahead that failed will be uncompressed again,
+    // and the error reported, when actually requested.
+    for (size_t i = 0; i < nChunkCountAhead; ++i)
+    {
+        if (!asJobs[nChunkCount + i].bOK)
             break;
+        oMapChunksReadAhead_[nChunkIdx + nChunkCount + i] =
+            std::move(aabyChunksAhead[i]);
     }
 
+    nCurPos_ += nToRead;
+    nLastReadEnd_ = nCurPos_;
     return nCount;
 }
 
@@ -4240,10 +4741,13 @@ VSIVirtualHandle *VSIZipFilesystemHandler::Open(const char *pszFilename,
             return nullptr;
         }
 
+        VSIVirtualHandle *poHandle = poGZIPHandle;
+        if (VSIGZipGetDecompressionThreads() > 1)
+            poHandle = new VSIGZipReadAheadHandle(poHandle);
         // Wrap the VSIGZipHandle inside a buffered reader that will
         // improve dramatically performance when doing small backward
         // seeks.
-        return VSICreateBufferedReaderHandle(poGZIPHandle);
+        return VSICreateBufferedReaderHandle(poHandle);
     }
     else
 #endif
@@ -4272,10 +4776,13 @@ VSIVirtualHandle *VSIZipFilesystemHandler::Open(const char *pszFilename,
             return nullptr;
         }
 
+        VSIVirtualHandle *poHandle = poGZIPHandle;
+        if (VSIGZipGetDecompressionThreads() > 1)
+            poHandle = new VSIGZipReadAheadHandle(poHandle);
         // Wrap the VSIGZipHandle inside a buffered reader that will
         // improve dramatically performance when doing small backward
         // seeks.
-        return VSICreateBufferedReaderHandle(poGZIPHandle);
+        return VSICreateBufferedReaderHandle(poHandle);
     }
 }
 
@@ -4570,8 +5077,8 @@ const char *VSIZipFilesystemHandler::GetOptions()
 {
     return "<Options>"
            "  <Option name='GDAL_NUM_THREADS' type='string' "
-           "description='Number of threads for compression. Either a integer "
-           "or ALL_CPUS'/>"
+           "description='Number of threads for compression and "
+           "decompression. Either a integer or ALL_CPUS'/>"
            "  <Option name='CPL_VSIL_DEFLATE_CHUNK_SIZE' type='string' "
            "description='Chunk of uncompressed data for parallelization. "
            "Use K(ilobytes) or M(egabytes) suffix' default='1M'/>"
@@ -4978,6 +5485,19 @@ void *CPLZLibDeflate(const void *ptr, size_t nBytes, int nLevel, void *outptr,
  * @since GDAL 1.10.0
  */
 
+#ifdef HAVE_LIBDEFLATE
+namespace
+{
+struct LibdeflateDecompressorDeleter
+{
+    void operator()(struct libdeflate_decompressor *dec) const
+    {
+        libdeflate_free_decompressor(dec);
+    }
+};
+}  // namespace
+#endif
+
 void *CPLZLibInflate(const void *ptr, size_t nBytes, void *outptr,
                      size_t nOutAvailableBytes, size_t *pnOutBytes)
 {
@@ -4987,7 +5507,14 @@ void *CPLZLibInflate(const void *ptr, size_t nBytes, void *outptr,
 #ifdef HAVE_LIBDEFLATE
     if (outptr)
     {
-        struct libdeflate_decompressor *dec = libdeflate_alloc_decompressor();
+        // The decompressor is reused by the successive calls made by a
+        // thread, as allocating it is costly for small buffers.
+        static thread_local std::unique_ptr<struct libdeflate_decompressor,
+                                            LibdeflateDecompressorDeleter>
+            tlsDec;
+        if (!tlsDec)
+            tlsDec.reset(libdeflate_alloc_decompressor());
+        struct libdeflate_decompressor *dec = tlsDec.get();
         if (dec == nullptr)
         {
             return nullptr;
@@ -5004,7 +5531,6 @@ void *CPLZLibInflate(const void *ptr, size_t nBytes, void *outptr,
             res = libdeflate_zlib_decompress(dec, ptr, nBytes, outptr,
                                              nOutAvailableBytes, pnOutBytes);
         }
-        libdeflate_free_decompressor(dec);
         if (res != LIBDEFLATE_SUCCESS)
         {
             return nullptr;
@@ -775,6 +775,18 @@ VSIS3WriteHandle::VSIS3WriteHandle(IVSIS3LikeFSHandler *poFS,
                      "Cannot allocate working buffer for %s",
                      m_poFS->GetFSPrefix().c_str());
         }
+
+        // Number of parts that can be uploaded concurrently, while the
+        // next part is being filled.
+        if (poFS->SupportsParallelMultipartUpload())
+        {
+            const std::string osOptionName(std::string("VSI") +
+                                           poFS->GetDebugKey() +
+                                           "_UPLOAD_NUM_THREADS");
+            m_nUploadThreads = std::max(
+                1, std::min(64, atoi(VSIGetPathSpecificOption(
+                                    pszFilename, osOptionName.c_str(), "1"))));
+        }
     }
 }
 
@@ -787,6 +799,8 @@ VSIS3WriteHandle::~VSIS3WriteHandle()
     VSIS3WriteHandle::Close();
     delete m_poS3HandleHelper;
     CPLFree(m_pabyBuffer);
+    for (GByte *pabyBuffer : m_apabyFreeBuffers)
+        CPLFree(pabyBuffer);
     if (m_hCurlMulti)
     {
         if (m_hCurl)
@@ -979,6 +993,127 @@ bool VSIS3WriteHandle::UploadPart()
     return !osEtag.empty();
 }
 
+/************************************************************************/
+/*                       UploadPartInBackground()                       */
+/************************************************************************/
+
+// Submit the upload of the current buffer to the upload thread pool, and
+// continue with another buffer. At most m_nUploadThreads parts are uploaded
+// at the same time, which bounds the memory usage.
+bool VSIS3WriteHandle::UploadPartInBackground()
+{
+    ++m_nPartNumber;
+    if (m_nPartNumber > knMAX_PART_NUMBER)
+    {
+        m_bError = true;
+        CPLError(
+            CE_Failure, CPLE_AppDefined,
+            "%d parts have been uploaded for %s failed. "
+            "This is the maximum. "
+            "Increase VSIS3_CHUNK_SIZE to a higher value (e.g. 500 for 500 MB)",
+            knMAX_PART_NUMBER, m_osFilename.c_str());
+        return false;
+    }
+
+    if (m_poUploadPool == nullptr)
+    {
+        m_poUploadPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!m_poUploadPool->Setup(m_nUploadThreads, nullptr, nullptr, false))
+        {
+            m_poUploadPool.reset();
+            return false;
+        }
+    }
+
+    auto psJob = new UploadPartJob();
+    psJob->poHandle = this;
+    psJob->nPartNumber = m_nPartNumber;
+    psJob->pabyBuffer = m_pabyBuffer;
+    psJob->nBufferSize = m_nBufferOff;
+    m_pabyBuffer = nullptr;
+    m_nBufferOff = 0;
+    if (!m_poUploadPool->SubmitJob(UploadPartJobFunc, psJob))
+    {
+        m_pabyBuffer = psJob->pabyBuffer;
+        delete psJob;
+        return false;
+    }
+
+    // Wait for a part upload slot to be available.
+    m_poUploadPool->WaitCompletion(m_nUploadThreads - 1);
+
+    std::lock_guard<std::mutex> oLock(m_oUploadMutex);
+    if (m_bUploadError)
+        return false;
+    if (!m_apabyFreeBuffers.empty())
+    {
+        m_pabyBuffer = m_apabyFreeBuffers.back();
+        m_apabyFreeBuffers.pop_back();
+    }
+    else
+    {
+        m_pabyBuffer = static_cast<GByte *>(VSI_MALLOC_VERBOSE(m_nBufferSize));
+    }
+    return m_pabyBuffer != nullptr;
+}
+
+/************************************************************************/
+/*                         UploadPartJobFunc()                          */
+/************************************************************************/
+
+void VSIS3WriteHandle::UploadPartJobFunc(void *pData)
+{
+    auto psJob = static_cast<UploadPartJob *>(pData);
+    VSIS3WriteHandle *poHandle = psJob->poHandle;
+
+    // The handle helper is modified by requests, so each job needs its own.
+    std::unique_ptr<IVSIS3LikeHandleHelper> poS3HandleHelper(
+        poHandle->m_poFS->CreateHandleHelper(
+            poHandle->m_osFilename.c_str() +
+                poHandle->m_poFS->GetFSPrefix().size(),
+            false));
+    CPLString osEtag;
+    if (poS3HandleHelper)
+    {
+        osEtag = poHandle->m_poFS->UploadPart(
+            poHandle->m_osFilename, psJob->nPartNumber, poHandle->m_osUploadID,
+            static_cast<vsi_l_offset>(poHandle->m_nBufferSize) *
+                (psJob->nPartNumber - 1),
+            psJob->pabyBuffer, psJob->nBufferSize, poS3HandleHelper.get(),
+            poHandle->m_nMaxRetry, poHandle->m_dfRetryDelay, nullptr);
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(poHandle->m_oUploadMutex);
+        if (osEtag.empty())
+        {
+            poHandle->m_bUploadError = true;
+        }
+        else
+        {
+            if (poHandle->m_aosEtags.size() <
+                static_cast<size_t>(psJob->nPartNumber))
+                poHandle->m_aosEtags.resize(psJob->nPartNumber);
+            poHandle->m_aosEtags[psJob->nPartNumber - 1] = osEtag;
+        }
+        poHandle->m_apabyFreeBuffers.push_back(psJob->pabyBuffer);
+    }
+    delete psJob;
+}
+
+/************************************************************************/
+/*                       WaitBackgroundUploads()                        */
+/************************************************************************/
+
+bool VSIS3WriteHandle::WaitBackgroundUploads()
+{
+    if (m_poUploadPool == nullptr)
+        return true;
+    m_poUploadPool->WaitCompletion();
+    std::lock_guard<std::mutex> oLock(m_oUploadMutex);
+    return !m_bUploadError;
+}
+
 CPLString IVSIS3LikeFSHandler::UploadPart(
     const CPLString &osFilename, int nPartNumber, const std::string &osUploadID,
     vsi_l_offset /* nPosition */, const void *pabyBuffer, size_t nBufferSize,
@@ -1427,7 +1562,8 @@ size_t VSIS3WriteHandle::Write(const void *pBuffer, size_t nSize, size_t nMemb)
                     return 0;
                 }
             }
-            if (!UploadPart())
+            if (m_nUploadThreads > 1 ? !UploadPartInBackground()
+                                     : !UploadPart())
             {
                 m_bError = true;
                 return 0;
@@ -2005,6 +2141,8 @@ int VSIS3WriteHandle::Close()
         }
         else
         {
+            if (!WaitBackgroundUploads())
+                m_bError = true;
             if (m_bError)
             {
                 if (!m_poFS->AbortMultipart(m_osFilename, m_osUploadID,
@@ -68,6 +68,9 @@ class VSISubFileHandle final : public VSIVirtualHandle
     size_t Write(const void *pBuffer, size_t nSize, size_t nMemb) override;
     int Eof() override;
     int Close() override;
+
+    std::shared_ptr<const GByte> MapRegion(vsi_l_offset nOffset,
+                                           size_t nSize) override;
 };
 
 /************************************************************************/
@@ -263,6 +266,20 @@ int VSISubFileHandle::Eof()
     return bAtEOF;
 }
 
+/************************************************************************/
+/*                             MapRegion()                              */
+/************************************************************************/
+
+std::shared_ptr<const GByte> VSISubFileHandle::MapRegion(vsi_l_offset nOffset,
+                                                         size_t nSize)
+{
+    if (nSubregionSize != 0 &&
+        (nOffset > nSubregionSize || nSize > nSubregionSize - nOffset))
+        return nullptr;
+    return reinterpret_cast<VSIVirtualHandle *>(fp)->MapRegion(
+        nSubregionOffset + nOffset, nSize);
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                       VSISubFileFilesystemHandler                    */
@@ -37,11 +37,15 @@
 #include <fcntl.h>
 #endif
 
+#include <map>
+#include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_sha256.h"
 #include "cpl_string.h"
 #include "cpl_vsi_virtual.h"
 
@@ -119,6 +123,15 @@ class VSITarReader final : public VSIArchiveReader
         return fp != nullptr;
     }
 
+    bool IsFuzzerFriendly() const
+    {
+#ifdef HAVE_FUZZER_FRIENDLY_ARCHIVE
+        return m_bIsFuzzerFriendly;
+#else
+        return false;
+#endif
+    }
+
     int GotoFirstFile() override;
     int GotoNextFile() override;
     VSIArchiveEntryFileOffset *GetFileOffset() override;
@@ -527,6 +540,21 @@ int VSITarReader::GotoFileOffset(VSIArchiveEntryFileOffset *pOffset)
 
 class VSITarFilesystemHandler final : public VSIArchiveFilesystemHandler
 {
+    // Listing of an archive of which only the first entries have been read
+    // so far, because only some of its members have been looked up.
+    struct PartialContent
+    {
+        std::unique_ptr<VSIArchiveContent> poContent{};
+        std::set<CPLString> oSet{};
+        GUIntBig nLastOffset = 0;
+    };
+
+    std::map<CPLString, PartialContent> m_oMapPartialContent{};
+
+    bool LoadIndex(const char *pszArchiveFilename);
+    static void SaveIndex(const char *pszArchiveFilename,
+                          const VSIArchiveContent *content);
+
   public:
     const char *GetPrefix() override
     {
@@ -535,6 +563,13 @@ class VSITarFilesystemHandler final : public VSIArchiveFilesystemHandler
     std::vector<CPLString> GetExtensions() override;
     VSIArchiveReader *CreateReader(const char *pszTarFileName) override;
 
+    const VSIArchiveContent *
+    GetContentOfArchive(const char *archiveFilename,
+                        VSIArchiveReader *poReader = nullptr) override;
+    int FindFileInArchive(const char *archiveFilename,
+                          const char *fileInArchiveName,
+                          const VSIArchiveEntry **archiveEntry) override;
+
     VSIVirtualHandle *Open(const char *pszFilename, const char *pszAccess,
                            bool bSetError,
                            CSLConstList /* papszOptions */) override;
@@ -587,6 +622,334 @@ VSITarFilesystemHandler::CreateReader(const char *pszTarFileName)
     return poReader;
 }
 
+/************************************************************************/
+/*                          GetIndexFilename()                          */
+/************************************************************************/
+
+/* Return the name of the persisted index of an archive, in the directory */
+/* pointed by CPL_VSIL_TAR_INDEX_DIR, or an empty string if not enabled. */
+static std::string GetIndexFilename(const char *pszArchiveFilename)
+{
+    const char *pszDir = CPLGetConfigOption("CPL_VSIL_TAR_INDEX_DIR", nullptr);
+    if (pszDir == nullptr || pszDir[0] == '\0')
+        return std::string();
+
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256(pszArchiveFilename, strlen(pszArchiveFilename), abyHash);
+    char *pszHex = CPLBinaryToHex(CPL_SHA256_HASH_SIZE, abyHash);
+    const std::string osFilename =
+        CPLFormFilename(pszDir, pszHex, "gdal_tar_index");
+    CPLFree(pszHex);
+    return osFilename;
+}
+
+constexpr const char *TAR_INDEX_SIGNATURE = "GDAL_TAR_INDEX 1";
+
+/************************************************************************/
+/*                             LoadIndex()                              */
+/************************************************************************/
+
+/* Must be called with hMutex held. */
+bool VSITarFilesystemHandler::LoadIndex(const char *pszArchiveFilename)
+{
+    const std::string osIndexFilename = GetIndexFilename(pszArchiveFilename);
+    if (osIndexFilename.empty())
+        return false;
+
+    VSIStatBufL sStat;
+    if (VSIStatL(pszArchiveFilename, &sStat) != 0)
+        return false;
+
+    VSILFILE *fp = VSIFOpenL(osIndexFilename.c_str(), "rb");
+    if (fp == nullptr)
+        return false;
+
+    auto content = std::make_unique<VSIArchiveContent>();
+    bool bOK = false;
+    const char *pszLine = CPLReadLineL(fp);
+    if (pszLine && strcmp(pszLine, TAR_INDEX_SIGNATURE) == 0 &&
+        (pszLine = CPLReadLineL(fp)) != nullptr &&
+        strcmp(pszLine, pszArchiveFilename) == 0 &&
+        (pszLine = CPLReadLineL(fp)) != nullptr)
+    {
+        const CPLStringList aosTokens(CSLTokenizeString2(pszLine, " ", 0));
+        bOK = aosTokens.size() == 2 &&
+              CPLScanUIntBig(aosTokens[0], 20) ==
+                  static_cast<GUIntBig>(sStat.st_size) &&
+              CPLAtoGIntBig(aosTokens[1]) ==
+                  static_cast<GIntBig>(sStat.st_mtime);
+        content->mTime = sStat.st_mtime;
+        content->nFileSize = static_cast<vsi_l_offset>(sStat.st_size);
+    }
+
+    // Each entry is "offset size mtime is_dir name", offset being -1 for
+    // intermediate directories that have no header in the archive.
+    std::vector<VSIArchiveEntry> aoEntries;
+    while (bOK && (pszLine = CPLReadLineL(fp)) != nullptr)
+    {
+        GIntBig nOffset = 0;
+        GUIntBig nSize = 0;
+        GIntBig nMTime = 0;
+        int bIsDir = FALSE;
+        int nNameStart = 0;
+        if (sscanf(pszLine,
+                   CPL_FRMT_GIB " " CPL_FRMT_GUIB " " CPL_FRMT_GIB " %d %n",
+                   &nOffset, &nSize, &nMTime, &bIsDir, &nNameStart) != 4 ||
+            nNameStart == 0 || pszLine[nNameStart] == '\0' || nOffset < -1)
+        {
+            bOK = false;
+            break;
+        }
+        VSIArchiveEntry sEntry;
+        sEntry.fileName = CPLStrdup(pszLine + nNameStart);
+        sEntry.uncompressed_size = nSize;
+        sEntry.file_pos =
+            nOffset < 0
+                ? nullptr
+                : new VSITarEntryFileOffset(static_cast<GUIntBig>(nOffset));
+        sEntry.bIsDir = bIsDir;
+        sEntry.nModifiedTime = nMTime;
+        aoEntries.push_back(sEntry);
+    }
+    VSIFCloseL(fp);
+
+    if (!aoEntries.empty())
+    {
+        content->entries = static_cast<VSIArchiveEntry *>(
+            CPLMalloc(sizeof(VSIArchiveEntry) * aoEntries.size()));
+        memcpy(content->entries, aoEntries.data(),
+               sizeof(VSIArchiveEntry) * aoEntries.size());
+        content->nEntries = static_cast<int>(aoEntries.size());
+    }
+    if (!bOK)
+    {
+        CPLDebug("VSITAR", "Ignoring index %s of %s", osIndexFilename.c_str(),
+                 pszArchiveFilename);
+        return false;
+    }
+
+    CPLDebug("VSITAR", "Using index %s of %s", osIndexFilename.c_str(),
+             pszArchiveFilename);
+    delete oFileList[pszArchiveFilename];
+    oFileList[pszArchiveFilename] = content.release();
+    return true;
+}
+
+/************************************************************************/
+/*                             SaveIndex()                              */
+/************************************************************************/
+
+void VSITarFilesystemHandler::SaveIndex(const char *pszArchiveFilename,
+                                        const VSIArchiveContent *content)
+{
+    const std::string osIndexFilename = GetIndexFilename(pszArchiveFilename);
+    if (osIndexFilename.empty() || strchr(pszArchiveFilename, '\n'))
+        return;
+
+    for (int i = 0; i < content->nEntries; i++)
+    {
+        const VSIArchiveEntry &sEntry = content->entries[i];
+        if (strchr(sEntry.fileName, '\n'))
+            return;
+#ifdef HAVE_FUZZER_FRIENDLY_ARCHIVE
+        // Offsets in fuzzer friendly archives cannot be described by their
+        // offset only.
+        if (sEntry.file_pos &&
+            !static_cast<const VSITarEntryFileOffset *>(sEntry.file_pos)
+                 ->m_osFileName.empty())
+            return;
+#endif
+    }
+
+    // Write to a temporary file that is renamed afterwards, so that
+    // concurrent processes never see a partially written index.
+    const std::string osTmpFilename =
+        osIndexFilename + CPLSPrintf(".%p.tmp", content);
+    VSILFILE *fp = VSIFOpenL(osTmpFilename.c_str(), "wb");
+    if (fp == nullptr)
+    {
+        CPLDebug("VSITAR", "Cannot create %s", osTmpFilename.c_str());
+        return;
+    }
+    bool bOK =
+        VSIFPrintfL(fp, "%s\n%s\n" CPL_FRMT_GUIB " " CPL_FRMT_GIB "\n",
+                    TAR_INDEX_SIGNATURE, pszArchiveFilename,
+                    static_cast<GUIntBig>(content->nFileSize),
+                    static_cast<GIntBig>(content->mTime)) > 0;
+    for (int i = 0; bOK && i < content->nEntries; i++)
+    {
+        const VSIArchiveEntry &sEntry = content->entries[i];
+        const GIntBig nOffset =
+            sEntry.file_pos
+                ? static_cast<GIntBig>(
+                      static_cast<const VSITarEntryFileOffset *>(
+                          sEntry.file_pos)
+                          ->m_nOffset)
+                : -1;
+        bOK = VSIFPrintfL(fp,
+                          CPL_FRMT_GIB " " CPL_FRMT_GUIB " " CPL_FRMT_GIB
+                                       " %d %s\n",
+                          nOffset,
+                          static_cast<GUIntBig>(sEntry.uncompressed_size),
+                          sEntry.nModifiedTime, sEntry.bIsDir ? 1 : 0,
+                          sEntry.fileName) > 0;
+    }
+    if (VSIFCloseL(fp) != 0)
+        bOK = false;
+    if (!bOK || VSIRename(osTmpFilename.c_str(), osIndexFilename.c_str()) != 0)
+    {
+        CPLDebug("VSITAR", "Cannot write %s", osIndexFilename.c_str());
+        VSIUnlink(osTmpFilename.c_str());
+    }
+}
+
+/************************************************************************/
+/*                        GetContentOfArchive()                         */
+/************************************************************************/
+
+const VSIArchiveContent *
+VSITarFilesystemHandler::GetContentOfArchive(const char *archiveFilename,
+                                             VSIArchiveReader *poReader)
+{
+    CPLMutexHolder oHolder(&hMutex);
+
+    if (oFileList.find(archiveFilename) == oFileList.end())
+    {
+        // A full scan supersedes any partial one.
+        m_oMapPartialContent.erase(archiveFilename);
+
+        if (!LoadIndex(archiveFilename))
+        {
+            const VSIArchiveContent *content =
+                VSIArchiveFilesystemHandler::GetContentOfArchive(
+                    archiveFilename, poReader);
+            if (content)
+                SaveIndex(archiveFilename, content);
+            return content;
+        }
+    }
+
+    return VSIArchiveFilesystemHandler::GetContentOfArchive(archiveFilename,
+                                                            poReader);
+}
+
+/************************************************************************/
+/*                         FindFileInArchive()                          */
+/************************************************************************/
+
+/* When the listing of the archive is not known yet, only read its headers */
+/* up to the requested member, so that accessing a member near the */
+/* beginning of a huge archive does not require reading all the headers. */
+/* The scan is resumed from where it stopped by later lookups. */
+int VSITarFilesystemHandler::FindFileInArchive(
+    const char *archiveFilename, const char *fileInArchiveName,
+    const VSIArchiveEntry **archiveEntry)
+{
+    if (fileInArchiveName == nullptr)
+        return FALSE;
+
+    CPLMutexHolder oHolder(&hMutex);
+
+    // Gzip streams cannot be efficiently resumed from an offset
+    if (oFileList.find(archiveFilename) != oFileList.end() ||
+        VSIIsTGZ(archiveFilename) ||
+        STARTS_WITH_CI(archiveFilename, "/vsigzip/") ||
+        LoadIndex(archiveFilename))
+    {
+        return VSIArchiveFilesystemHandler::FindFileInArchive(
+            archiveFilename, fileInArchiveName, archiveEntry);
+    }
+
+    VSIStatBufL sStat;
+    if (VSIStatL(archiveFilename, &sStat) != 0)
+        return FALSE;
+
+    auto oIter = m_oMapPartialContent.find(archiveFilename);
+    if (oIter != m_oMapPartialContent.end())
+    {
+        const VSIArchiveContent *content = oIter->second.poContent.get();
+        if (static_cast<time_t>(sStat.st_mtime) > content->mTime ||
+            static_cast<vsi_l_offset>(sStat.st_size) != content->nFileSize)
+        {
+            m_oMapPartialContent.erase(oIter);
+            oIter = m_oMapPartialContent.end();
+        }
+        else
+        {
+            for (int i = 0; i < content->nEntries; i++)
+            {
+                if (strcmp(fileInArchiveName, content->entries[i].fileName) ==
+                    0)
+                {
+                    if (archiveEntry)
+                        *archiveEntry = &content->entries[i];
+                    return TRUE;
+                }
+            }
+        }
+    }
+
+    auto poReader = std::make_unique<VSITarReader>(archiveFilename);
+    if (!poReader->IsValid())
+        return FALSE;
+    if (oIter == m_oMapPartialContent.end())
+    {
+        if (!poReader->GotoFirstFile())
+            return FALSE;
+        if (poReader->IsFuzzerFriendly())
+        {
+            poReader.reset();
+            return VSIArchiveFilesystemHandler::FindFileInArchive(
+                archiveFilename, fileInArchiveName, archiveEntry);
+        }
+        PartialContent &oPartial = m_oMapPartialContent[archiveFilename];
+        oPartial.poContent = std::make_unique<VSIArchiveContent>();
+        oPartial.poContent->mTime = sStat.st_mtime;
+        oPartial.poContent->nFileSize =
+            static_cast<vsi_l_offset>(sStat.st_size);
+        oIter = m_oMapPartialContent.find(archiveFilename);
+    }
+    else
+    {
+        // Re-read the header of the last entry seen, and skip to the next.
+        VSITarEntryFileOffset oOffset(oIter->second.nLastOffset);
+        if (!poReader->GotoFileOffset(&oOffset) || !poReader->GotoNextFile())
+            poReader.reset();
+    }
+
+    PartialContent &oPartial = oIter->second;
+    VSIArchiveContent *content = oPartial.poContent.get();
+    while (poReader)
+    {
+        const int nFirstNewEntry = content->nEntries;
+        AddEntryToContent(content, oPartial.oSet, poReader.get());
+        {
+            std::unique_ptr<VSIArchiveEntryFileOffset> poOffset(
+                poReader->GetFileOffset());
+            oPartial.nLastOffset =
+                static_cast<VSITarEntryFileOffset *>(poOffset.get())
+                    ->m_nOffset;
+        }
+        for (int i = nFirstNewEntry; i < content->nEntries; i++)
+        {
+            if (strcmp(fileInArchiveName, content->entries[i].fileName) == 0)
+            {
+                if (archiveEntry)
+                    *archiveEntry = &content->entries[i];
+                return TRUE;
+            }
+        }
+        if (!poReader->GotoNextFile())
+            break;
+    }
+
+    // The whole archive has been read: this is now a regular full listing.
+    SaveIndex(archiveFilename, content);
+    oFileList[archiveFilename] = oPartial.poContent.release();
+    m_oMapPartialContent.erase(oIter);
+    return FALSE;
+}
+
 /************************************************************************/
 /*                                 Open()                               */
 /************************************************************************/
@@ -81,6 +81,9 @@
 #ifdef HAVE_PREAD_BSD
 #include <sys/uio.h>
 #endif
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
 
 #if defined(__MACH__) && defined(__APPLE__)
 #define HAS_CASE_INSENSITIVE_FILE_SYSTEM
@@ -89,14 +92,19 @@
 #include <limits.h>
 #endif
 
+#include <chrono>
 #include <limits>
+#include <mutex>
 #include <new>
+#include <string>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_mem_cache.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
+#include "cpl_virtualmem.h"
 #include "cpl_vsi_error.h"
 
 #if defined(UNIX_STDIO_64)
@@ -170,6 +178,31 @@ class VSIUnixStdioFilesystemHandler final : public VSIFilesystemHandler
     CPLMutex *hMutex = nullptr;
 #endif
 
+    // Optional cache of Stat() and ReadDirEx() results, enabled with the
+    // CPL_VSIL_LOCAL_CACHE_TTL configuration option.
+    struct CachedStat
+    {
+        std::chrono::steady_clock::time_point oTime{};
+        int nRet = 0;
+        int nErrno = 0;
+        VSIStatBufL sStat{};
+    };
+
+    struct CachedDirList
+    {
+        std::chrono::steady_clock::time_point oTime{};
+        bool bExists = false;
+        CPLStringList aosList{};
+    };
+
+    std::mutex m_oCacheMutex{};
+    lru11::Cache<std::string, CachedStat> m_oCacheStat{16384};
+    lru11::Cache<std::string, CachedDirList> m_oCacheDirList{1024};
+
+    static double GetCacheTTL();
+    static bool IsExpired(const std::chrono::steady_clock::time_point &oTime,
+                          double dfTTL);
+
   public:
     VSIUnixStdioFilesystemHandler() = default;
 #ifdef VSI_COUNT_BYTES_READ
@@ -206,6 +239,8 @@ class VSIUnixStdioFilesystemHandler final : public VSIFilesystemHandler
 #ifdef VSI_COUNT_BYTES_READ
     void AddToTotal(vsi_l_offset nBytes);
 #endif
+
+    void InvalidateCache();
 };
 
 /************************************************************************/
@@ -229,9 +264,9 @@ class VSIUnixStdioHandle final : public VSIVirtualHandle
     // file and thus a call to our Seek(0, SEEK_SET) before a read will be a
     // no-op.
     bool bModeAppendReadWrite = false;
+    VSIUnixStdioFilesystemHandler *poFS = nullptr;
 #ifdef VSI_COUNT_BYTES_READ
     vsi_l_offset nTotalBytesRead = 0;
-    VSIUnixStdioFilesystemHandler *poFS = nullptr;
 #endif
   public:
     VSIUnixStdioHandle(VSIUnixStdioFilesystemHandler *poFSIn, FILE *fpIn,
@@ -255,6 +290,17 @@ class VSIUnixStdioHandle final : public VSIVirtualHandle
     bool HasPRead() const override;
     size_t PRead(void * /*pBuffer*/, size_t /* nSize */,
                  vsi_l_offset /*nOffset*/) const override;
+    int ReadMultiRange(int nRanges, void **ppData,
+                       const vsi_l_offset *panOffsets,
+                       const size_t *panSizes) override;
+#endif
+#ifdef HAVE_POSIX_FADVISE
+    void AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
+                    const size_t *panSizes) override;
+#endif
+#ifdef HAVE_MMAP
+    std::shared_ptr<const GByte> MapRegion(vsi_l_offset nOffset,
+                                           size_t nSize) override;
 #endif
 };
 
@@ -262,18 +308,11 @@ class VSIUnixStdioHandle final : public VSIVirtualHandle
 /*                       VSIUnixStdioHandle()                           */
 /************************************************************************/
 
-VSIUnixStdioHandle::VSIUnixStdioHandle(
-#ifndef VSI_COUNT_BYTES_READ
-    CPL_UNUSED
-#endif
-        VSIUnixStdioFilesystemHandler *poFSIn,
-    FILE *fpIn, bool bReadOnlyIn, bool bModeAppendReadWriteIn)
+VSIUnixStdioHandle::VSIUnixStdioHandle(VSIUnixStdioFilesystemHandler *poFSIn,
+                                       FILE *fpIn, bool bReadOnlyIn,
+                                       bool bModeAppendReadWriteIn)
     : fp(fpIn), bReadOnly(bReadOnlyIn),
-      bModeAppendReadWrite(bModeAppendReadWriteIn)
-#ifdef VSI_COUNT_BYTES_READ
-      ,
-      poFS(poFSIn)
-#endif
+      bModeAppendReadWrite(bModeAppendReadWriteIn), poFS(poFSIn)
 {
 }
 
@@ -295,6 +334,11 @@ int VSIUnixStdioHandle::Close()
 
     int ret = fclose(fp);
     fp = nullptr;
+
+    // The size and modification time of the file have likely changed.
+    if (!bReadOnly)
+        poFS->InvalidateCache();
+
     return ret;
 }
 
@@ -661,6 +705,122 @@ size_t VSIUnixStdioHandle::PRead(void *pBuffer, size_t nSize,
     return pread(fileno(fp), pBuffer, nSize, static_cast<off_t>(nOffset));
 #endif
 }
+
+/************************************************************************/
+/*                          ReadMultiRange()                            */
+/************************************************************************/
+
+// Reads each range with pread() directly in the output buffer, instead of
+// the Seek() + Read() sequence of the base implementation that goes through
+// the stdio buffer.
+int VSIUnixStdioHandle::ReadMultiRange(int nRanges, void **ppData,
+                                       const vsi_l_offset *panOffsets,
+                                       const size_t *panSizes)
+{
+    // pread() bypasses the stdio buffer
+    if (!bReadOnly)
+        fflush(fp);
+
+#ifdef HAVE_POSIX_FADVISE
+    // Let the kernel issue the reads of all ranges concurrently
+    if (nRanges > 1)
+        AdviseRead(nRanges, panOffsets, panSizes);
+#endif
+
+    for (int i = 0; i < nRanges; i++)
+    {
+        GByte *pabyData = static_cast<GByte *>(ppData[i]);
+        size_t nRemaining = panSizes[i];
+        vsi_l_offset nOffset = panOffsets[i];
+        while (nRemaining > 0)
+        {
+#ifdef HAVE_PREAD64
+            const auto nRead =
+                pread64(fileno(fp), pabyData, nRemaining, nOffset);
+#else
+            const auto nRead = pread(fileno(fp), pabyData, nRemaining,
+                                     static_cast<off_t>(nOffset));
+#endif
+            if (nRead < 0 && errno == EINTR)
+                continue;
+            if (nRead <= 0)
+                return -1;
+            pabyData += nRead;
+            nRemaining -= static_cast<size_t>(nRead);
+            nOffset += static_cast<vsi_l_offset>(nRead);
+        }
+#ifdef VSI_COUNT_BYTES_READ
+        nTotalBytesRead += panSizes[i];
+#endif
+    }
+    return 0;
+}
+#endif
+
+#ifdef HAVE_MMAP
+/************************************************************************/
+/*                             MapRegion()                              */
+/************************************************************************/
+
+std::shared_ptr<const GByte> VSIUnixStdioHandle::MapRegion(vsi_l_offset nOffset,
+                                                           size_t nSize)
+{
+    // Pending writes of the stdio buffer would not be visible in the mapping
+    if (!bReadOnly || nSize == 0)
+        return nullptr;
+
+    // Accessing pages of a mapping beyond the end of file raises SIGBUS
+    const int fd = fileno(fp);
+    struct stat sStat;
+    if (fstat(fd, &sStat) != 0 ||
+        nOffset > static_cast<vsi_l_offset>(sStat.st_size) ||
+        nSize > static_cast<vsi_l_offset>(sStat.st_size) - nOffset)
+    {
+        return nullptr;
+    }
+
+    const size_t nPageSize = CPLGetPageSize();
+    if (nPageSize == 0)
+        return nullptr;
+    const vsi_l_offset nAlignedOffset = nOffset / nPageSize * nPageSize;
+    const size_t nDelta = static_cast<size_t>(nOffset - nAlignedOffset);
+    if (nSize > std::numeric_limits<size_t>::max() - nDelta)
+        return nullptr;
+    const size_t nMappingSize = nSize + nDelta;
+    void *pAddr = mmap(nullptr, nMappingSize, PROT_READ, MAP_SHARED, fd,
+                       static_cast<off_t>(nAlignedOffset));
+    if (pAddr == MAP_FAILED)
+        return nullptr;
+
+    // The mapping remains valid after the file descriptor is closed
+    return std::shared_ptr<const GByte>(
+        static_cast<const GByte *>(pAddr) + nDelta,
+        [pAddr, nMappingSize](const GByte *) { munmap(pAddr, nMappingSize); });
+}
+#endif
+
+#ifdef HAVE_POSIX_FADVISE
+/************************************************************************/
+/*                            AdviseRead()                              */
+/************************************************************************/
+
+void VSIUnixStdioHandle::AdviseRead(int nRanges,
+                                    const vsi_l_offset *panOffsets,
+                                    const size_t *panSizes)
+{
+    const int fd = fileno(fp);
+    for (int i = 0; i < nRanges; i++)
+    {
+        if (panSizes[i] > 0 &&
+            panOffsets[i] <=
+                static_cast<vsi_l_offset>(std::numeric_limits<off_t>::max()))
+        {
+            posix_fadvise(fd, static_cast<off_t>(panOffsets[i]),
+                          static_cast<off_t>(panSizes[i]),
+                          POSIX_FADV_WILLNEED);
+        }
+    }
+}
 #endif
 
 /************************************************************************/
@@ -715,6 +875,8 @@ VSIUnixStdioFilesystemHandler::Open(const char *pszFilename,
 
     const bool bReadOnly =
         strcmp(pszAccess, "rb") == 0 || strcmp(pszAccess, "r") == 0;
+    if (!bReadOnly)
+        InvalidateCache();
     const bool bModeAppendReadWrite =
         strcmp(pszAccess, "a+b") == 0 || strcmp(pszAccess, "a+") == 0;
     VSIUnixStdioHandle *poHandle = new (std::nothrow)
@@ -746,7 +908,33 @@ VSIUnixStdioFilesystemHandler::Open(const char *pszFilename,
 int VSIUnixStdioFilesystemHandler::Stat(const char *pszFilename,
                                         VSIStatBufL *pStatBuf, int /* nFlags */)
 {
-    return (VSI_STAT64(pszFilename, pStatBuf));
+    const double dfTTL = GetCacheTTL();
+    if (dfTTL <= 0)
+        return (VSI_STAT64(pszFilename, pStatBuf));
+
+    const std::string osFilename(pszFilename);
+    CachedStat oCachedStat;
+    {
+        std::lock_guard<std::mutex> oLock(m_oCacheMutex);
+        if (m_oCacheStat.tryGet(osFilename, oCachedStat) &&
+            !IsExpired(oCachedStat.oTime, dfTTL))
+        {
+            *pStatBuf = oCachedStat.sStat;
+            errno = oCachedStat.nErrno;
+            return oCachedStat.nRet;
+        }
+    }
+
+    oCachedStat.oTime = std::chrono::steady_clock::now();
+    oCachedStat.nRet = VSI_STAT64(pszFilename, &oCachedStat.sStat);
+    oCachedStat.nErrno = errno;
+    {
+        std::lock_guard<std::mutex> oLock(m_oCacheMutex);
+        m_oCacheStat.insert(osFilename, oCachedStat);
+    }
+    *pStatBuf = oCachedStat.sStat;
+    errno = oCachedStat.nErrno;
+    return oCachedStat.nRet;
 }
 
 /************************************************************************/
@@ -756,6 +944,7 @@ int VSIUnixStdioFilesystemHandler::Stat(const char *pszFilename,
 int VSIUnixStdioFilesystemHandler::Unlink(const char *pszFilename)
 
 {
+    InvalidateCache();
     return unlink(pszFilename);
 }
 
@@ -767,6 +956,7 @@ int VSIUnixStdioFilesystemHandler::Rename(const char *oldpath,
                                           const char *newpath)
 
 {
+    InvalidateCache();
     return rename(oldpath, newpath);
 }
 
@@ -777,6 +967,7 @@ int VSIUnixStdioFilesystemHandler::Rename(const char *oldpath,
 int VSIUnixStdioFilesystemHandler::Mkdir(const char *pszPathname, long nMode)
 
 {
+    InvalidateCache();
     return mkdir(pszPathname, static_cast<int>(nMode));
 }
 
@@ -787,6 +978,7 @@ int VSIUnixStdioFilesystemHandler::Mkdir(const char *pszPathname, long nMode)
 int VSIUnixStdioFilesystemHandler::Rmdir(const char *pszPathname)
 
 {
+    InvalidateCache();
     return rmdir(pszPathname);
 }
 
@@ -801,6 +993,29 @@ char **VSIUnixStdioFilesystemHandler::ReadDirEx(const char *pszPath,
     if (strlen(pszPath) == 0)
         pszPath = ".";
 
+    const double dfTTL = GetCacheTTL();
+    if (dfTTL > 0)
+    {
+        std::lock_guard<std::mutex> oLock(m_oCacheMutex);
+        CachedDirList oCachedDirList;
+        if (m_oCacheDirList.tryGet(pszPath, oCachedDirList) &&
+            !IsExpired(oCachedDirList.oTime, dfTTL))
+        {
+            if (!oCachedDirList.bExists)
+                return nullptr;
+            CPLStringList oDir;
+            oDir.Assign(static_cast<char **>(CPLCalloc(2, sizeof(char *))));
+            for (const char *pszEntry : oCachedDirList.aosList)
+            {
+                oDir.AddString(pszEntry);
+                if (nMaxFiles > 0 && oDir.Count() > nMaxFiles)
+                    break;
+            }
+            return oDir.StealList();
+        }
+    }
+    const auto oTime = std::chrono::steady_clock::now();
+
     CPLStringList oDir;
     DIR *hDir = opendir(pszPath);
     if (hDir != nullptr)
@@ -808,20 +1023,41 @@ char **VSIUnixStdioFilesystemHandler::ReadDirEx(const char *pszPath,
         // We want to avoid returning NULL for an empty list.
         oDir.Assign(static_cast<char **>(CPLCalloc(2, sizeof(char *))));
 
+        bool bComplete = true;
         struct dirent *psDirEntry = nullptr;
         while ((psDirEntry = readdir(hDir)) != nullptr)
         {
             oDir.AddString(psDirEntry->d_name);
             if (nMaxFiles > 0 && oDir.Count() > nMaxFiles)
+            {
+                bComplete = false;
                 break;
+            }
         }
 
         closedir(hDir);
+
+        if (dfTTL > 0 && bComplete)
+        {
+            CachedDirList oCachedDirList;
+            oCachedDirList.oTime = oTime;
+            oCachedDirList.bExists = true;
+            oCachedDirList.aosList = oDir;
+            std::lock_guard<std::mutex> oLock(m_oCacheMutex);
+            m_oCacheDirList.insert(pszPath, oCachedDirList);
+        }
     }
     else
     {
         // Should we generate an error?
         // For now we'll just return NULL (at the end of the function).
+        if (dfTTL > 0)
+        {
+            CachedDirList oCachedDirList;
+            oCachedDirList.oTime = oTime;
+            std::lock_guard<std::mutex> oLock(m_oCacheMutex);
+            m_oCacheDirList.insert(pszPath, oCachedDirList);
+        }
     }
 
     return oDir.StealList();
@@ -1203,6 +1439,42 @@ begin:
     return &(entry);
 }
 
+/************************************************************************/
+/*                            GetCacheTTL()                             */
+/************************************************************************/
+
+double VSIUnixStdioFilesystemHandler::GetCacheTTL()
+{
+    return CPLAtof(CPLGetConfigOption("CPL_VSIL_LOCAL_CACHE_TTL", "0"));
+}
+
+/************************************************************************/
+/*                             IsExpired()                              */
+/************************************************************************/
+
+bool VSIUnixStdioFilesystemHandler::IsExpired(
+    const std::chrono::steady_clock::time_point &oTime, double dfTTL)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         oTime)
+               .count() > dfTTL;
+}
+
+/************************************************************************/
+/*                          InvalidateCache()                           */
+/************************************************************************/
+
+// Any modification done through this handler discards all cached entries,
+// since renaming or removing a directory affects the stat of its whole
+// subtree. Modifications done by other processes are only seen once the
+// TTL has elapsed.
+void VSIUnixStdioFilesystemHandler::InvalidateCache()
+{
+    std::lock_guard<std::mutex> oLock(m_oCacheMutex);
+    m_oCacheStat.clear();
+    m_oCacheDirList.clear();
+}
+
 #ifdef VSI_COUNT_BYTES_READ
 /************************************************************************/
 /*                            AddToTotal()                              */
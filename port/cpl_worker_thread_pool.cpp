@@ -29,7 +29,9 @@
 #include "cpl_port.h"
 #include "cpl_worker_thread_pool.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdlib>
 #include <memory>
 
 #include "cpl_conv.h"
@@ -42,8 +44,143 @@ struct CPLWorkerThreadJob
     void *pData;
 };
 
+struct JobQueueJob
+{
+    CPLJobQueue *poQueue = nullptr;
+    CPLThreadFunc pfnFunc = nullptr;
+    void *pData = nullptr;
+};
+
 static thread_local CPLWorkerThreadPool *threadLocalCurrentThreadPool = nullptr;
 
+/************************************************************************/
+/*                          CPLJobTokens                                */
+/************************************************************************/
+
+// Process-wide budget of jobs that may run at the same time in all
+// CPLWorkerThreadPool instances. A worker thread holds a token while it
+// runs a job, and releases it while the job is blocked waiting for other
+// jobs.
+namespace
+{
+struct CPLJobTokens
+{
+    std::mutex m_mutex{};
+    std::condition_variable m_cv{};
+    bool m_bInit = false;
+    int m_nMaxJobs = 0;  // 0 = unlimited
+    int m_nActiveJobs = 0;
+
+    void InitIfNeeded()
+    {
+        if (!m_bInit)
+        {
+            m_bInit = true;
+            m_nMaxJobs = std::max(
+                0, atoi(CPLGetConfigOption("GDAL_MAX_CONCURRENT_JOBS", "0")));
+        }
+    }
+};
+}  // namespace
+
+static CPLJobTokens &GetJobTokens()
+{
+    // Never destroyed, as worker threads of static pools may still use it
+    // during the destruction of static objects.
+    static CPLJobTokens *poTokens = new CPLJobTokens();
+    return *poTokens;
+}
+
+static thread_local bool threadLocalHoldsJobToken = false;
+
+static void CPLAcquireJobToken()
+{
+    auto &oTokens = GetJobTokens();
+    std::unique_lock<std::mutex> oGuard(oTokens.m_mutex);
+    oTokens.InitIfNeeded();
+    while (oTokens.m_nMaxJobs > 0 &&
+           oTokens.m_nActiveJobs >= oTokens.m_nMaxJobs)
+    {
+        oTokens.m_cv.wait(oGuard);
+    }
+    oTokens.m_nActiveJobs++;
+    threadLocalHoldsJobToken = true;
+}
+
+static void CPLReleaseJobToken()
+{
+    auto &oTokens = GetJobTokens();
+    std::lock_guard<std::mutex> oGuard(oTokens.m_mutex);
+    oTokens.m_nActiveJobs--;
+    threadLocalHoldsJobToken = false;
+    oTokens.m_cv.notify_one();
+}
+
+// Releases the token of the calling thread, if any, while blocking.
+class CPLJobTokenReleaser
+{
+    const bool m_bHeldToken;
+
+    CPL_DISALLOW_COPY_ASSIGN(CPLJobTokenReleaser)
+
+  public:
+    CPLJobTokenReleaser() : m_bHeldToken(threadLocalHoldsJobToken)
+    {
+        if (m_bHeldToken)
+            CPLReleaseJobToken();
+    }
+
+    ~CPLJobTokenReleaser()
+    {
+        if (m_bHeldToken)
+            CPLAcquireJobToken();
+    }
+};
+
+/************************************************************************/
+/*                      CPLSetMaxConcurrentJobs()                       */
+/************************************************************************/
+
+/** Set the maximum number of jobs that may run at the same time in all the
+ * pools of worker threads of the process (CPLWorkerThreadPool).
+ *
+ * This caps the total CPU usage of GDAL multi-threaded operations, that
+ * otherwise each use up to GDAL_NUM_THREADS threads. Worker threads
+ * exceeding the budget wait until a job completes.
+ *
+ * The default value is the one of the GDAL_MAX_CONCURRENT_JOBS configuration
+ * option, read at the first job run, or 0 (unlimited).
+ *
+ * @param nMaxJobs Maximum number of concurrent jobs, or 0 for unlimited.
+ * @since GDAL 3.9
+ */
+void CPLSetMaxConcurrentJobs(int nMaxJobs)
+{
+    auto &oTokens = GetJobTokens();
+    std::lock_guard<std::mutex> oGuard(oTokens.m_mutex);
+    oTokens.m_bInit = true;
+    oTokens.m_nMaxJobs = std::max(0, nMaxJobs);
+    oTokens.m_cv.notify_all();
+}
+
+/************************************************************************/
+/*                      CPLGetMaxConcurrentJobs()                       */
+/************************************************************************/
+
+/** Return the maximum number of jobs that may run at the same time in all
+ * the pools of worker threads of the process.
+ *
+ * @return the value set with CPLSetMaxConcurrentJobs(), or 0 for unlimited.
+ * @since GDAL 3.9
+ */
+int CPLGetMaxConcurrentJobs()
+{
+    auto &oTokens = GetJobTokens();
+    std::lock_guard<std::mutex> oGuard(oTokens.m_mutex);
+    oTokens.InitIfNeeded();
+    return oTokens.m_nMaxJobs;
+}
+
 /************************************************************************/
 /*                         CPLWorkerThreadPool()                        */
 /************************************************************************/
@@ -108,7 +245,9 @@ void CPLWorkerThreadPool::WorkerThreadFunction(void *user_data)
 
         if (psJob->pfnFunc)
         {
+            CPLAcquireJobToken();
             psJob->pfnFunc(psJob->pData);
+            CPLReleaseJobToken();
         }
         CPLFree(psJob);
 #if DEBUG_VERBOSE
@@ -133,7 +272,11 @@ bool CPLWorkerThreadPool::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
     CPLAssert(m_nMaxThreads > 0);
 
     bool bMustIncrementWaitingWorkerThreadsAfterSubmission = false;
-    if (threadLocalCurrentThreadPool == this)
+    // Jobs of a CPLJobQueue submitted from a worker thread can always be
+    // queued, as CPLJobQueue::WaitCompletion() runs them if no other worker
+    // thread is available.
+    if (threadLocalCurrentThreadPool == this &&
+        pfnFunc != CPLJobQueue::JobQueueFunction)
     {
         // If there are waiting threads or we have not started all allowed
         // threads, we can submit this job asynchronously
@@ -391,6 +534,7 @@ void CPLWorkerThreadPool::WaitCompletion(int nMaxRemainingJobs)
 {
     if (nMaxRemainingJobs < 0)
         nMaxRemainingJobs = 0;
+    CPLJobTokenReleaser oTokenReleaser;
     std::unique_lock<std::mutex> oGuard(m_mutex);
     while (nPendingJobs > nMaxRemainingJobs)
     {
@@ -406,6 +550,7 @@ void CPLWorkerThreadPool::WaitCompletion(int nMaxRemainingJobs)
  */
 void CPLWorkerThreadPool::WaitEvent()
 {
+    CPLJobTokenReleaser oTokenReleaser;
     std::unique_lock<std::mutex> oGuard(m_mutex);
     while (true)
     {
@@ -580,6 +725,45 @@ CPLWorkerThreadPool::GetNextJob(CPLWorkerThread *psWorkerThread)
     }
 }
 
+/************************************************************************/
+/*                        RunPendingJobOfQueue()                        */
+/************************************************************************/
+
+// Remove from the list of pending jobs one that belongs to poQueue, and run
+// it in the calling thread. Returns false if there is no such job.
+bool CPLWorkerThreadPool::RunPendingJobOfQueue(CPLJobQueue *poQueue)
+{
+    CPLWorkerThreadJob *psJob = nullptr;
+    {
+        std::lock_guard<std::mutex> oGuard(m_mutex);
+        CPLList *psPrev = nullptr;
+        for (CPLList *psIter = psJobQueue; psIter; psIter = psIter->psNext)
+        {
+            auto psCandidate = static_cast<CPLWorkerThreadJob *>(psIter->pData);
+            if (psCandidate->pfnFunc == CPLJobQueue::JobQueueFunction &&
+                static_cast<JobQueueJob *>(psCandidate->pData)->poQueue ==
+                    poQueue)
+            {
+                if (psPrev)
+                    psPrev->psNext = psIter->psNext;
+                else
+                    psJobQueue = psIter->psNext;
+                CPLFree(psIter);
+                psJob = psCandidate;
+                break;
+            }
+            psPrev = psIter;
+        }
+    }
+    if (psJob == nullptr)
+        return false;
+
+    psJob->pfnFunc(psJob->pData);
+    CPLFree(psJob);
+    DeclareJobFinished();
+    return true;
+}
+
 /************************************************************************/
 /*                         CreateJobQueue()                             */
 /************************************************************************/
@@ -619,12 +803,6 @@ CPLJobQueue::~CPLJobQueue()
 /*                           JobQueueJob                                */
 /************************************************************************/
 
-struct JobQueueJob
-{
-    CPLJobQueue *poQueue = nullptr;
-    CPLThreadFunc pfnFunc = nullptr;
-    void *pData = nullptr;
-};
 
 /************************************************************************/
 /*                          JobQueueFunction()                          */
@@ -682,6 +860,10 @@ bool CPLJobQueue::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
 /************************************************************************/
 
 /** Wait for completion of part or whole jobs.
+ *
+ * When called from a worker thread of the pool, pending jobs of this queue
+ * are run by the calling thread while waiting, so that a job may submit
+ * jobs to the same pool and wait for them without risking a deadlock.
  *
  * @param nMaxRemainingJobs Maximum number of pendings jobs that are allowed
  *                          in the queue after this method has completed. Might
@@ -689,9 +871,21 @@ bool CPLJobQueue::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
  */
 void CPLJobQueue::WaitCompletion(int nMaxRemainingJobs)
 {
-    std::unique_lock<std::mutex> oGuard(m_mutex);
-    while (m_nPendingJobs > nMaxRemainingJobs)
+    const bool bHelp = threadLocalCurrentThreadPool == m_poPool;
+    while (true)
     {
-        m_cv.wait(oGuard);
+        {
+            std::lock_guard<std::mutex> oGuard(m_mutex);
+            if (m_nPendingJobs <= nMaxRemainingJobs)
+                return;
+        }
+        if (!bHelp || !m_poPool->RunPendingJobOfQueue(this))
+        {
+            // Remaining jobs are being run by other threads
+            CPLJobTokenReleaser oTokenReleaser;
+            std::unique_lock<std::mutex> oGuard(m_mutex);
+            if (m_nPendingJobs > nMaxRemainingJobs)
+                m_cv.wait(oGuard);
+        }
     }
 }
@@ -96,6 +96,9 @@ class CPL_DLL CPLWorkerThreadPool
     void DeclareJobFinished();
     CPLWorkerThreadJob *GetNextJob(CPLWorkerThread *psWorkerThread);
 
+    friend class CPLJobQueue;
+    bool RunPendingJobOfQueue(CPLJobQueue *poQueue);
+
   public:
     CPLWorkerThreadPool();
     ~CPLWorkerThreadPool();
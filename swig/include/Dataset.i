@@ -813,6 +813,10 @@ CPLErr AdviseRead(  int xoff, int yoff, int xsize, int ysize,
     return GDALDatasetIsLayerPrivate(self, index);
   }
 
+  bool IsThreadSafe() {
+    return GDALDatasetIsThreadSafe(self);
+  }
+
 #ifdef SWIGJAVA
   OGRLayerShadow *GetLayerByIndex( int index ) {
 #else
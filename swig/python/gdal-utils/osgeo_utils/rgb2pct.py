@@ -48,6 +48,7 @@ def rgb2pct(
     dst_filename: Optional[PathLikeOrStr] = None,
     color_count: int = 256,
     driver_name: Optional[str] = None,
+    overview_level: Optional[int] = None,
 ):
     # Open source file
     src_ds = open_ds(src_filename)
@@ -67,13 +68,21 @@ def rgb2pct(
     if dst_driver is None:
         raise Exception(f'"{driver_name}" driver not registered.')
 
-    # Generate palette
+    # Generate palette, possibly from an overview to speed up the histogram
+    # computation on large images
     if pct_filename is None:
+        src_bands = [src_ds.GetRasterBand(i + 1) for i in range(3)]
+        if overview_level is not None:
+            if overview_level >= src_bands[0].GetOverviewCount():
+                raise Exception(
+                    f"{src_filename} has no overview of level {overview_level}"
+                )
+            src_bands = [band.GetOverview(overview_level) for band in src_bands]
         ct = gdal.ColorTable()
         err = gdal.ComputeMedianCutPCT(
-            src_ds.GetRasterBand(1),
-            src_ds.GetRasterBand(2),
-            src_ds.GetRasterBand(3),
+            src_bands[0],
+            src_bands[1],
+            src_bands[2],
             color_count,
             ct,
             callback=gdal.TermProgress_nocb,
@@ -187,6 +196,16 @@ class RGB2PCT(GDALScript):
             "palette or a color file in a supported format (txt, qml, qlr).",
         )
 
+        parser.add_argument(
+            "-ovr",
+            dest="overview_level",
+            type=int,
+            metavar="level",
+            help="Compute the color table from the specified overview level "
+            "of the source file (0 being the first overview), instead of its "
+            "full resolution. The full resolution is still used for the output.",
+        )
+
         parser.add_argument("src_filename", type=str, help="The input RGB file.")
 
         parser.add_argument(